@@ -50,6 +50,11 @@ macro(mitkMacroConfigureItkPixelTypes)
                    MITK_ACCESSBYITK_VECTOR_PIXEL_TYPES_SEQ
                    MITK_ACCESSBYITK_VECTOR_TYPES_DIMN_SEQ)
 
+  # separate processing of the HOT list, it is a subset of the global list
+  _create_type_seq("${MITK_ACCESSBYITK_HOT_PIXEL_TYPES}"
+                   MITK_ACCESSBYITK_HOT_PIXEL_TYPES_SEQ
+                   MITK_ACCESSBYITK_HOT_TYPES_DIMN_SEQ)
+
   set(MITK_ACCESSBYITK_DIMENSIONS_SEQ )
   string(REPLACE "," ";" _dimensions "${MITK_ACCESSBYITK_DIMENSIONS}")
   foreach(_dimension ${_dimensions})
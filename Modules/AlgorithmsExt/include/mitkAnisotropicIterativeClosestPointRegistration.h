@@ -28,10 +28,10 @@ found in the LICENSE file.
 
 // forward declarations
 class vtkPoints;
-class vtkKdTreePointLocator;
 
 namespace mitk
 {
+  class PointLocator;
   class Surface;
   class WeightedPointTransform;
 
@@ -56,7 +56,13 @@ namespace mitk
     * vertices. In addition vtkCleanPolyData can be used to ensure a correct
     * Surface representation.
     *
-    * \note The correspondence search is accelerated when OpenMP is enabled.
+    * The correspondence search runs in parallel on the mitk::ThreadPool. The
+    * search tree of the fixed surface is kept between calls of Update() as
+    * long as the fixed surface is not modified. With
+    * SetNumberOfResolutionLevels() the registration starts on subsampled
+    * versions of the moving surface and refines the result on the next
+    * finer level, which reduces the number of iterations on the full
+    * point set.
     *
     * \b Example:
     *
@@ -156,6 +162,9 @@ namespace mitk
     /** Amount of iterations used by the algorithm.*/
     unsigned int m_NumberOfIterations;
 
+    /** Number of resolution levels of the moving point set. Default is 1.*/
+    unsigned int m_NumberOfResolutionLevels;
+
     /** Moving surface that is transformed on the fixed surface.*/
     itk::SmartPointer<Surface> m_MovingSurface;
     /** The fixed / target surface.*/
@@ -164,6 +173,9 @@ namespace mitk
     /** The weighted point based registration algorithm.*/
     itk::SmartPointer<WeightedPointTransform> m_WeightedPointTransform;
 
+    /** The search tree of the fixed surface, reused by subsequent runs.*/
+    itk::SmartPointer<PointLocator> m_FixedSurfaceLocator;
+
     /** The covariance matrices belonging to the moving surface (X).*/
     CovarianceMatrixList m_CovarianceMatricesMovingSurface;
 
@@ -199,7 +211,7 @@ namespace mitk
       */
     void ComputeCorrespondences(vtkPoints *X,
                                 vtkPoints *Z,
-                                vtkKdTreePointLocator *Y,
+                                const PointLocator *Y,
                                 const CovarianceMatrixList &sigma_X,
                                 const CovarianceMatrixList &sigma_Y,
                                 CovarianceMatrixList &sigma_Z,
@@ -245,6 +257,17 @@ namespace mitk
       /** Get the number of iterations used by the algorithm.*/
       itkGetMacro(NumberOfIterations, unsigned int);
 
+      /**
+        * Set the number of resolution levels. Level l of the moving point set
+        * uses every 2^l-th point, the registration runs from the coarsest
+        * to the finest level and each level starts with the transformation
+        * of the previous one. Levels with less than 3 points are skipped.
+        * The maximum number of iterations applies to every level. The
+        * default value is 1, which registers the full point set only.
+        */
+      itkSetClampMacro(NumberOfResolutionLevels, unsigned int, 1, 16);
+      itkGetMacro(NumberOfResolutionLevels, unsigned int);
+
       /**
         * Factor that trimms the point set in percent for
         * partial overlapping surfaces. E.g. 0.4 will use 40 precent
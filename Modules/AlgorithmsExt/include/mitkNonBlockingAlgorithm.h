@@ -25,11 +25,13 @@ found in the LICENSE file.
 #include "mitkProperties.h"
 #include "mitkPropertyList.h"
 #include "mitkSmartPointerProperty.h"
+#include "mitkThreadPool.h"
 #include "mitkWeakPointer.h"
 
 #include "mitkImage.h"
 #include "mitkSurface.h"
 
+#include <future>
 #include <stdexcept>
 #include <string>
 
@@ -204,6 +206,10 @@ namespace mitk
     void StartBlockingAlgorithm(); // for those who want to trigger calculations on their own
     void StopAlgorithm();
 
+    /// Priority of the ThreadedUpdateFunction() calls in the shared mitk::ThreadPool, Visible by default
+    void SetThreadPoolPriority(ThreadPool::Priority priority);
+    ThreadPool::Priority GetThreadPoolPriority() const;
+
     void TriggerParameterModified(const itk::EventObject &);
 
     void ThreadedUpdateSuccessful(const itk::EventObject &);
@@ -228,7 +234,7 @@ namespace mitk
     WeakPointer<DataStorage> m_DataStorage;
 
   private:
-    static ITK_THREAD_RETURN_TYPE StaticNonBlockingAlgorithmThread(void *param);
+    static void StaticNonBlockingAlgorithmThread(ThreadParameters *parameters);
 
     typedef std::map<std::string, unsigned long> MapTypeStringUInt;
 
@@ -236,10 +242,11 @@ namespace mitk
 
     itk::FastMutexLock::Pointer m_ParameterListMutex;
 
-    int m_ThreadID;
+    bool m_ThreadRunning;
     int m_UpdateRequests;
     ThreadParameters m_ThreadParameters;
-    itk::MultiThreader::Pointer m_MultiThreader;
+    std::future<void> m_Thread;
+    ThreadPool::Priority m_ThreadPoolPriority;
 
     bool m_KillRequest;
   };
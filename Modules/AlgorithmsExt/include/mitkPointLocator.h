@@ -20,17 +20,22 @@ found in the LICENSE file.
 
 #include <vtkPoints.h>
 
+#include <cstdint>
+#include <vector>
+
 // forward declarations
 class vtkPointSet;
-class ANNkd_tree;
 
 namespace mitk
 {
   /**
-   * Convenience wrapper around ANN to provide fast nearest neighbour searches.
+   * Fast nearest neighbour searches in a k-d tree.
    * Usage: set your points via SetPoints( vtkPointSet* Points ) or SetPoints(mitk::PointSet*).
-   * Then, you may query the closest point to an arbitrary coordinate by FindClosestPoint().
+   * Then, you may query the closest point to an arbitrary coordinate by FindClosestPoint(),
+   * the closest points of many coordinates at once by FindClosestPoints(), or all points
+   * within a radius by FindPointsWithinRadius().
    * There is no further call to update etc. needed.
+   * The queries do not modify the locator, so they may be called from several threads at once.
    * Currently only calls for 1 nearest neighbour are supported. Feel free to add functions
    * for K nearest neighbours.
    * NOTE: At least 1 point must be contained in the point set.
@@ -83,7 +88,7 @@ namespace mitk
      * @returns the id of the nearest neighbour of the given point. The id corresponds to the id
      * which is given in the original point set.
      */
-    IdType FindClosestPoint(const double point[3]);
+    IdType FindClosestPoint(const double point[3]) const;
 
     /**
      * Finds the nearest neighbour in the point set previously defined by SetPoints().
@@ -96,7 +101,7 @@ namespace mitk
      * @returns the id of the nearest neighbour of the given point. The id corresponds to the id
      * which is given in the original point set.
      */
-    IdType FindClosestPoint(double x, double y, double z);
+    IdType FindClosestPoint(double x, double y, double z) const;
 
     /**
      * Finds the nearest neighbour in the point set previously defined by SetPoints().
@@ -107,7 +112,7 @@ namespace mitk
      * @returns the id of the nearest neighbour of the given point. The id corresponds to the id
      * which is given in the original point set.
      */
-    IdType FindClosestPoint(mitk::PointSet::PointType point);
+    IdType FindClosestPoint(mitk::PointSet::PointType point) const;
 
     /**
      * Finds the nearest neighbour in the point set previously defined by SetPoints().
@@ -118,7 +123,7 @@ namespace mitk
      * @param point the query point, for whom the minimal distance will be determined
      * @returns the distance in world coordinates between the nearest point in point set and the given point
      */
-    DistanceType GetMinimalDistance(mitk::PointSet::PointType point);
+    DistanceType GetMinimalDistance(mitk::PointSet::PointType point) const;
 
     /**
     * Finds the nearest neighbour in the point set previously defined by SetPoints().
@@ -127,10 +132,30 @@ namespace mitk
     * no point is found, since as a precondition at least one point has to be contained
     * in the point set.
     * @param point the query point, for whom the minimal distance will be determined
-    * @returns the index of and distance (in world coordinates) between the nearest point in point set and the given
-    * point
+    * @returns the index of and squared distance (in world coordinates) between the nearest point in point set and the
+    * given point
+    */
+    bool FindClosestPointAndDistance(mitk::PointSet::PointType point, IdType *id, DistanceType *dist) const;
+
+    /**
+    * Finds the nearest neighbours of many query points at once. The queries are distributed
+    * over the threads of the shared mitk::ThreadPool.
+    * @param points the query points, given as x, y, z triples
+    * @param numberOfPoints the number of query points
+    * @param ids returns the id of the nearest neighbour of each query point
+    * @param distances optionally returns the squared distance between each query point and its nearest neighbour
+    */
+    void FindClosestPoints(const double *points,
+                           std::size_t numberOfPoints,
+                           IdType *ids,
+                           DistanceType *distances = nullptr) const;
+
+    /**
+    * Finds all points in the point set previously defined by SetPoints() whose distance to the
+    * given point is at most radius.
+    * @param ids returns the ids of the points found, in no particular order
     */
-    bool FindClosestPointAndDistance(mitk::PointSet::PointType point, IdType *id, DistanceType *dist);
+    void FindPointsWithinRadius(const double point[3], DistanceType radius, std::vector<IdType> &ids) const;
 
   protected:
     //
@@ -138,19 +163,6 @@ namespace mitk
     //
     typedef std::vector<IdType> IdVectorType;
 
-    //
-    // ANN related typedefs, to prevent ANN from being in the global include path.
-    // Please note, that these line are prone to failure, if the point type in
-    // ANN changes. Please note also, that these typedefs are only used in the header
-    // file. The implementation always refers to the original types
-    //
-    typedef double *MyANNpoint;
-    typedef int MyANNidx;
-    typedef double MyANNdist;
-    typedef MyANNpoint *MyANNpointArray;
-    typedef MyANNidx *MyANNidxArray;
-    typedef MyANNdist *MyANNdistArray;
-
     /**
      * constructor
      */
@@ -162,56 +174,42 @@ namespace mitk
     ~PointLocator() override;
 
     /**
-     * Initializes the ann search tree using previously defined points
-     */
-    void InitANN();
-
-    /**
-     * releases all memory occupied by the ann search tree and internal point set arrays
+     * Builds the search tree from the points in m_Points and their ids in m_IndexToPointIdContainer
      */
-    void DestroyANN();
+    void BuildTree();
 
     /**
-     * Finds the nearest neighbour in the point set previously defined by SetPoints().
-     * The Id of the point is returned. Please note, that there is no case, in which
-     * no point is found, since as a precondition at least one point has to be contained
-     * in the point set.
-     * @param point the query point, for whom the nearest neighbour will be determined
-     * @returns the id of the nearest neighbour of the given point. The id corresponds to the id
-     * which is given in the original point set.
+     * Finds the nearest neighbour of the given point and its squared distance. Returns the position
+     * of the nearest neighbour in the reordered point arrays.
      */
-    IdType FindClosestANNPoint(const MyANNpoint &point);
+    std::size_t FindClosestTreePoint(const double point[3], DistanceType *squaredDistance) const;
 
     /**
-     * Finds the minimal distance between the given point and a point in the previously defined point set.
-     * The distance is returned. Please note, that there is no case, in which
-     * no distance is found, since as a precondition at least one point has to be contained
-     * in the point set.
-     * @param point the query point, for whom the minimal distance to a point in the previously defined point set will
-     * be determined
-     * @returns the squared distance in world coordinates between the given point and the nearest neighbour.
+     * Node of the k-d tree. The points of a node are the range [Begin, End) of the point arrays;
+     * inner nodes have their two children at Children and Children + 1.
      */
-    DistanceType GetMinimalDistance(const MyANNpoint &point);
+    struct Node
+    {
+      double Lower[3];
+      double Upper[3];
+      unsigned int Begin;
+      unsigned int End;
+      unsigned int Children;
+    };
 
     bool m_SearchTreeInitialized;
 
     IdVectorType m_IndexToPointIdContainer;
 
-    vtkPoints *m_VtkPoints;
-    mitk::PointSet *m_MitkPoints;
-    ITKPointSet *m_ItkPoints;
+    // The source of the current points, to detect if the search tree is up to date
+    const void *m_PointsSource;
+    std::uint64_t m_PointsSourceMTime;
 
-    //
-    // ANN related variables
-    //
-    unsigned int m_ANNK;
-    unsigned int m_ANNDimension;
-    double m_ANNEpsilon;
-    MyANNpointArray m_ANNDataPoints;
-    MyANNpoint m_ANNQueryPoint;
-    MyANNidxArray m_ANNPointIndexes;
-    MyANNdistArray m_ANNDistances;
-    ANNkd_tree *m_ANNTree;
+    // Coordinates stored per dimension, so that the distances to the points of a leaf can be
+    // computed with vector instructions
+    std::vector<double> m_Points[3];
+
+    std::vector<Node> m_Nodes;
   };
 }
 
@@ -17,6 +17,8 @@ found in the LICENSE file.
 
 #include <mitkCommon.h>
 
+#include <mitkPointLocator.h>
+
 #include <mitkUnstructuredGrid.h>
 #include <mitkUnstructuredGridToUnstructuredGridFilter.h>
 #include <vtkIdList.h>
@@ -34,6 +36,9 @@ namespace mitk
   * range in which the neighbours are searched. If "Meshing" is set the
   * clusteres UnstructuredGrid is meshed and visible in 2D renderwindows.
   *
+  * The neighbourhoods of all points are searched in parallel in a mitk::PointLocator
+  * before the clusters are expanded.
+  *
   * DBSCAN algorithm:
   *
   *     DBSCAN(D, eps, MinPts)
@@ -97,8 +102,15 @@ namespace mitk
     void GenerateData() override;
 
   private:
-    /** Used for the DBSCAN algorithm to expand a cluster and add more points to it */
-    void ExpandCluster(int id, vtkIdList *pointIDs, vtkPoints *cluster, vtkPoints *inpPoints);
+    /**
+     * Used for the DBSCAN algorithm to expand the cluster of the kernel point id.
+     * @param neighbours the ids of the points within eps of each point
+     * @returns the ids of the points of the cluster
+     */
+    std::vector<int> ExpandCluster(int id,
+                                   const std::vector<std::vector<PointLocator::IdType>> &neighbours,
+                                   std::vector<bool> &visited,
+                                   std::vector<bool> &clusterMember);
 
     /** The result main Cluster */
     mitk::UnstructuredGrid::Pointer m_UnstructGrid;
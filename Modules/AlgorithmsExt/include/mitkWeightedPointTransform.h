@@ -168,6 +168,19 @@ namespace mitk
     /** 3x3 rotation matrix.*/
     Rotation m_Rotation;
 
+    /** Weight matrices, reused by subsequent runs.*/
+    WeightMatrixList m_WeightMatrices;
+
+    /** The transformed moving point sets of the previous and the current
+      * iteration, reused by subsequent runs.
+      */
+    vtkSmartPointer<vtkPoints> m_TransformedMovingPointSet;
+    vtkSmartPointer<vtkPoints> m_TransformedMovingPointSetNew;
+
+    /** The matrix C and vector e of the linear problem Cq = e, reused by subsequent runs.*/
+    itk::VariableSizeMatrix<double> m_C;
+    vnl_vector<double> m_E;
+
     /**
      *  original matlab-function:
      *
@@ -200,6 +213,13 @@ namespace mitk
      */
     void E_maker(vtkPoints *X, vtkPoints *Y, const WeightMatrixList &W, vnl_vector<double> &returnValue);
 
+    /**
+      * Computes the least squares solution q of Cq = e. Instead of the
+      * pseudo inverse of the 3N x 6 matrix C the 6 x 6 normal equations
+      * C^T C q = C^T e are solved, which yields the same solution.
+      */
+    vnl_vector<double> SolveLinearProblem(const itk::VariableSizeMatrix<double> &C, const vnl_vector<double> &e);
+
     /**
       * This method computes the change in a root mean squared
       * sense between the previous and the actual iteration.
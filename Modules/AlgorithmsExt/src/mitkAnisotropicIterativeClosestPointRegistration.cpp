@@ -14,18 +14,24 @@ found in the LICENSE file.
 #include "mitkAnisotropicIterativeClosestPointRegistration.h"
 #include "mitkAnisotropicRegistrationCommon.h"
 #include "mitkWeightedPointTransform.h"
+#include <mitkPointLocator.h>
 #include <mitkProgressBar.h>
 #include <mitkSurface.h>
+#include <mitkThreadPool.h>
 // VTK
-#include <vtkIdList.h>
-#include <vtkKdTree.h>
-#include <vtkKdTreePointLocator.h>
 #include <vtkPoints.h>
 #include <vtkPolyData.h>
-// STL pair
+// STL
+#include <algorithm>
 #include <utility>
 
-/** \brief Comperator implementation used to sort the CorrespondenceList in the
+namespace
+{
+  // Points searched by one task of the parallel correspondence search
+  const std::size_t PointsPerTask = 64;
+}
+
+/** \brief Comperator implementation used to select the closest correspondences in the
   *        trimmed version of the AnisotropicIterativeClosestPointRegistration.
   */
 struct AICPComperator
@@ -44,6 +50,7 @@ mitk::AnisotropicIterativeClosestPointRegistration::AnisotropicIterativeClosestP
     m_FRE(0.0),
     m_TrimmFactor(0.0),
     m_NumberOfIterations(0),
+    m_NumberOfResolutionLevels(1),
     m_MovingSurface(nullptr),
     m_FixedSurface(nullptr),
     m_WeightedPointTransform(mitk::WeightedPointTransform::New())
@@ -56,7 +63,7 @@ mitk::AnisotropicIterativeClosestPointRegistration::~AnisotropicIterativeClosest
 
 void mitk::AnisotropicIterativeClosestPointRegistration::ComputeCorrespondences(vtkPoints *X,
                                                                                 vtkPoints *Z,
-                                                                                vtkKdTreePointLocator *Y,
+                                                                                const PointLocator *Y,
                                                                                 const CovarianceMatrixList &sigma_X,
                                                                                 const CovarianceMatrixList &sigma_Y,
                                                                                 CovarianceMatrixList &sigma_Z,
@@ -65,67 +72,71 @@ void mitk::AnisotropicIterativeClosestPointRegistration::ComputeCorrespondences(
 {
   typedef itk::Matrix<double, 3, 3> WeightMatrix;
 
-#pragma omp parallel for
-  for (int i = 0; i < X->GetNumberOfPoints(); ++i)
-  {
-    vtkIdType bestIdx = 0;
-    mitk::Vector3D x;
-    mitk::Vector3D y;
-    double bestDist = std::numeric_limits<double>::max();
-    vtkIdList *ids = vtkIdList::New();
-    double r = radius;
-    double p[3];
-    // get point
-    X->GetPoint(i, p);
-    // fill vector
-    x[0] = p[0];
-    x[1] = p[1];
-    x[2] = p[2];
-
-    // double the radius till we find at least one point
-    while (ids->GetNumberOfIds() <= 0)
-    {
-      Y->FindPointsWithinRadius(r, p, ids);
-      r *= 2.0;
-    }
+  vtkPoints *fixedPoints = m_FixedSurface->GetVtkPolyData()->GetPoints();
+
+  auto computeCorrespondences = [&](std::size_t begin, std::size_t end) {
+    // ids of the points within the radius, reused for all points of the sub-range
+    std::vector<PointLocator::IdType> ids;
 
-    // loop over the points in the sphere and find the point with the
-    // minimal weighted squared distance
-    for (vtkIdType j = 0; j < ids->GetNumberOfIds(); ++j)
+    for (auto i = begin; i < end; ++i)
     {
-      // get id
-      const vtkIdType id = ids->GetId(j);
-      // compute weightmatrix
-      WeightMatrix m = mitk::AnisotropicRegistrationCommon::CalculateWeightMatrix(sigma_X[i], sigma_Y[id]);
-      // point of the fixed data set
-      Y->GetDataSet()->GetPoint(id, p);
+      vtkIdType bestIdx = 0;
+      mitk::Vector3D x;
+      mitk::Vector3D y;
+      double bestDist = std::numeric_limits<double>::max();
+      double r = radius;
+      double p[3];
+      // get point
+      X->GetPoint(i, p);
+      // fill vector
+      x[0] = p[0];
+      x[1] = p[1];
+      x[2] = p[2];
+
+      // double the radius till we find at least one point
+      ids.clear();
+      while (ids.empty())
+      {
+        Y->FindPointsWithinRadius(p, r, ids);
+        r *= 2.0;
+      }
+
+      // loop over the points in the sphere and find the point with the
+      // minimal weighted squared distance
+      for (const auto id : ids)
+      {
+        // compute weightmatrix
+        WeightMatrix m = mitk::AnisotropicRegistrationCommon::CalculateWeightMatrix(sigma_X[i], sigma_Y[id]);
+        // point of the fixed data set
+        fixedPoints->GetPoint(id, p);
 
-      // fill mitk vector
-      y[0] = p[0];
-      y[1] = p[1];
-      y[2] = p[2];
+        // fill mitk vector
+        y[0] = p[0];
+        y[1] = p[1];
+        y[2] = p[2];
 
-      const mitk::Vector3D res = m * (x - y);
+        const mitk::Vector3D res = m * (x - y);
 
-      const double dist = res[0] * res[0] + res[1] * res[1] + res[2] * res[2];
+        const double dist = res[0] * res[0] + res[1] * res[1] + res[2] * res[2];
 
-      if (dist < bestDist)
-      {
-        bestDist = dist;
-        bestIdx = id;
+        if (dist < bestDist)
+        {
+          bestDist = dist;
+          bestIdx = id;
+        }
       }
-    }
 
-    // save correspondences of the fixed point set
-    Y->GetDataSet()->GetPoint(bestIdx, p);
-    Z->SetPoint(i, p);
-    sigma_Z[i] = sigma_Y[bestIdx];
+      // save correspondences of the fixed point set
+      fixedPoints->GetPoint(bestIdx, p);
+      Z->SetPoint(i, p);
+      sigma_Z[i] = sigma_Y[bestIdx];
 
-    Correspondence _pair(i, bestDist);
-    correspondences[i] = _pair;
+      Correspondence _pair(i, bestDist);
+      correspondences[i] = _pair;
+    }
+  };
 
-    ids->Delete();
-  }
+  ThreadPool::GetInstance().ParallelFor(0, X->GetNumberOfPoints(), computeCorrespondences, PointsPerTask);
 }
 
 void mitk::AnisotropicIterativeClosestPointRegistration::Update()
@@ -139,7 +150,7 @@ void mitk::AnisotropicIterativeClosestPointRegistration::Update()
   // Correspondences
   vtkPoints *Z = vtkPoints::New();
   // Covariance matrices of the pointset X
-  CovarianceMatrixList &Sigma_X = m_CovarianceMatricesMovingSurface;
+  CovarianceMatrixList Sigma_X;
   // Covariance matrices of the pointset Y
   CovarianceMatrixList &Sigma_Y = m_CovarianceMatricesFixedSurface;
   // Covariance matrices of the correspondences
@@ -155,19 +166,17 @@ void mitk::AnisotropicIterativeClosestPointRegistration::Update()
   CovarianceMatrixList Sigma_X_sorted;
   CovarianceMatrixList Sigma_Z_sorted;
 
-  // create kdtree for correspondence search
-  vtkKdTreePointLocator *Y = vtkKdTreePointLocator::New();
-  Y->SetDataSet(m_FixedSurface->GetVtkPolyData());
-  Y->BuildLocator();
-
-  // initialize local variables
-  // copy the moving pointset to prevent to modify it
-  X->DeepCopy(m_MovingSurface->GetVtkPolyData()->GetPoints());
-  // initialize size of the correspondences
-  Z->SetNumberOfPoints(X->GetNumberOfPoints());
-  // size of the corresponding matrices
-  Sigma_Z.resize(X->GetNumberOfPoints());
-  distanceList.resize(X->GetNumberOfPoints());
+  // create kdtree for correspondence search, the locator only
+  // rebuilds the tree if the fixed surface was modified
+  if (m_FixedSurfaceLocator.IsNull())
+    m_FixedSurfaceLocator = PointLocator::New();
+
+  m_FixedSurfaceLocator->SetPoints(m_FixedSurface->GetVtkPolyData());
+  const PointLocator *Y = m_FixedSurfaceLocator;
+
+  vtkPoints *movingPoints = m_MovingSurface->GetVtkPolyData()->GetPoints();
+  const vtkIdType numberOfMovingPoints = movingPoints->GetNumberOfPoints();
+
   RotationNew.SetIdentity();
   TranslationNew.Fill(0.0);
 
@@ -175,130 +184,173 @@ void mitk::AnisotropicIterativeClosestPointRegistration::Update()
   m_FRE = std::numeric_limits<double>::max();
   m_Rotation.SetIdentity();
   m_Translation.Fill(0.0);
+  m_NumberOfIterations = 0;
 
-  // compute number of correspondences based
-  // on the trimmfactor
-  if (m_TrimmFactor > 0.0)
+  for (int level = m_NumberOfResolutionLevels - 1; level >= 0; --level)
   {
-    numberOfTrimmedPoints = X->GetNumberOfPoints() * m_TrimmFactor;
-  }
+    const vtkIdType stride = vtkIdType(1) << level;
+    const vtkIdType numberOfPoints = (numberOfMovingPoints + stride - 1) / stride;
 
-  // initialize the sizes of the sorted datasets
-  // used in the trimmed version of the algorithm
-  Sigma_Z_sorted.resize(numberOfTrimmedPoints);
-  Sigma_X_sorted.resize(numberOfTrimmedPoints);
-  X_sorted->SetNumberOfPoints(numberOfTrimmedPoints);
-  Z_sorted->SetNumberOfPoints(numberOfTrimmedPoints);
+    // coarse levels with too few points for a registration are skipped
+    if (level > 0 && numberOfPoints < 3)
+      continue;
 
-  // initialize the progress bar
-  unsigned int steps = m_MaxIterations;
-  unsigned int stepSize = m_MaxIterations / 10;
-  mitk::ProgressBar::GetInstance()->AddStepsToDo(steps);
+    // initialize local variables
+    // copy every stride-th point of the moving pointset to prevent to modify it
+    // and apply the transformation of the previous levels
+    X->SetNumberOfPoints(numberOfPoints);
+    Sigma_X.resize(numberOfPoints);
 
-  do
-  {
-    // reset innerloop
-    double currSearchRadius = m_SearchRadius;
-    unsigned int radiusDoubled = 0;
+    for (vtkIdType i = 0; i < numberOfPoints; ++i)
+    {
+      X->SetPoint(i, movingPoints->GetPoint(i * stride));
+      Sigma_X[i] = m_CovarianceMatricesMovingSurface[i * stride];
+    }
+
+    mitk::AnisotropicRegistrationCommon::TransformPoints(X, X, m_Rotation, m_Translation);
+    mitk::AnisotropicRegistrationCommon::PropagateMatrices(Sigma_X, Sigma_X, m_Rotation);
+
+    // initialize size of the correspondences
+    Z->SetNumberOfPoints(numberOfPoints);
+    // size of the corresponding matrices
+    Sigma_Z.resize(numberOfPoints);
+    distanceList.resize(numberOfPoints);
+
+    // the FRE of different levels is not comparable
+    m_FRE = std::numeric_limits<double>::max();
+
+    // compute number of correspondences based
+    // on the trimmfactor
+    if (m_TrimmFactor > 0.0)
+    {
+      numberOfTrimmedPoints = numberOfPoints * m_TrimmFactor;
+    }
 
-    k = k + 1;
+    // initialize the sizes of the sorted datasets
+    // used in the trimmed version of the algorithm
+    Sigma_Z_sorted.resize(numberOfTrimmedPoints);
+    Sigma_X_sorted.resize(numberOfTrimmedPoints);
+    X_sorted->SetNumberOfPoints(numberOfTrimmedPoints);
+    Z_sorted->SetNumberOfPoints(numberOfTrimmedPoints);
 
-    MITK_DEBUG << "iteration: " << k;
+    // initialize the progress bar
+    unsigned int steps = m_MaxIterations;
+    unsigned int stepSize = m_MaxIterations / 10;
+    mitk::ProgressBar::GetInstance()->AddStepsToDo(steps);
+
+    k = 0;
 
     do
     {
-      // search correspondences
-      ComputeCorrespondences(X, Z, Y, Sigma_X, Sigma_Y, Sigma_Z, distanceList, currSearchRadius);
-
-      // tmp pointers
-      vtkPoints *X_k = X;
-      vtkPoints *Z_k = Z;
-      CovarianceMatrixList *Sigma_Z_k = &Sigma_Z;
-      CovarianceMatrixList *Sigma_X_k = &Sigma_X;
-
-      // sort the correspondences depending on their
-      // distance, if trimming is enabled
-      if (m_TrimmFactor > 0.0)
+      // reset innerloop
+      double currSearchRadius = m_SearchRadius;
+      unsigned int radiusDoubled = 0;
+
+      k = k + 1;
+
+      MITK_DEBUG << "level: " << level << ", iteration: " << k;
+
+      do
       {
-        std::sort(distanceList.begin(), distanceList.end(), AICPComp);
-        // map correspondences to the data arrays
-        for (unsigned int i = 0; i < numberOfTrimmedPoints; ++i)
+        // search correspondences
+        ComputeCorrespondences(X, Z, Y, Sigma_X, Sigma_Y, Sigma_Z, distanceList, currSearchRadius);
+
+        // tmp pointers
+        vtkPoints *X_k = X;
+        vtkPoints *Z_k = Z;
+        CovarianceMatrixList *Sigma_Z_k = &Sigma_Z;
+        CovarianceMatrixList *Sigma_X_k = &Sigma_X;
+
+        // select the correspondences with the smallest
+        // distances, if trimming is enabled
+        if (m_TrimmFactor > 0.0)
         {
-          const int idx = distanceList[i].first;
-          Sigma_Z_sorted[i] = Sigma_Z[idx];
-          Sigma_X_sorted[i] = Sigma_X[idx];
-          Z_sorted->SetPoint(i, Z->GetPoint(idx));
-          X_sorted->SetPoint(i, X->GetPoint(idx));
+          std::nth_element(distanceList.begin(),
+                           distanceList.begin() + numberOfTrimmedPoints,
+                           distanceList.end(),
+                           AICPComp);
+          // map correspondences to the data arrays
+          for (unsigned int i = 0; i < numberOfTrimmedPoints; ++i)
+          {
+            const int idx = distanceList[i].first;
+            Sigma_Z_sorted[i] = Sigma_Z[idx];
+            Sigma_X_sorted[i] = Sigma_X[idx];
+            Z_sorted->SetPoint(i, Z->GetPoint(idx));
+            X_sorted->SetPoint(i, X->GetPoint(idx));
+          }
+          // assign pointers
+          X_k = X_sorted;
+          Z_k = Z_sorted;
+          Sigma_X_k = &Sigma_X_sorted;
+          Sigma_Z_k = &Sigma_Z_sorted;
         }
-        // assign pointers
-        X_k = X_sorted;
-        Z_k = Z_sorted;
-        Sigma_X_k = &Sigma_X_sorted;
-        Sigma_Z_k = &Sigma_Z_sorted;
-      }
 
-      // compute weighted transformation
-      // set parameters
-      m_WeightedPointTransform->SetMovingPointSet(X_k);
-      m_WeightedPointTransform->SetFixedPointSet(Z_k);
-      m_WeightedPointTransform->SetCovarianceMatricesMoving(*Sigma_X_k);
-      m_WeightedPointTransform->SetCovarianceMatricesFixed(*Sigma_Z_k);
-      m_WeightedPointTransform->SetMaxIterations(m_MaxIterationsInWeightedPointTransform);
-      m_WeightedPointTransform->SetFRENormalizationFactor(m_FRENormalizationFactor);
-
-      // run computation
-      m_WeightedPointTransform->ComputeTransformation();
-      // retrieve result
-      RotationNew = m_WeightedPointTransform->GetTransformR();
-      TranslationNew = m_WeightedPointTransform->GetTransformT();
-      FRE_new = m_WeightedPointTransform->GetFRE();
-
-      // double the radius
-      radiusDoubled += 1;
-      currSearchRadius *= 2.0;
-
-      // sanity check to prevent endless loop
-      if (radiusDoubled >= 20)
-      {
-        mitkThrow() << "Radius doubled 20 times, preventing endless loop, check input and search radius";
-      }
+        // compute weighted transformation
+        // set parameters
+        m_WeightedPointTransform->SetMovingPointSet(X_k);
+        m_WeightedPointTransform->SetFixedPointSet(Z_k);
+        m_WeightedPointTransform->SetCovarianceMatricesMoving(*Sigma_X_k);
+        m_WeightedPointTransform->SetCovarianceMatricesFixed(*Sigma_Z_k);
+        m_WeightedPointTransform->SetMaxIterations(m_MaxIterationsInWeightedPointTransform);
+        m_WeightedPointTransform->SetFRENormalizationFactor(m_FRENormalizationFactor);
+
+        // run computation
+        m_WeightedPointTransform->ComputeTransformation();
+        // retrieve result
+        RotationNew = m_WeightedPointTransform->GetTransformR();
+        TranslationNew = m_WeightedPointTransform->GetTransformT();
+        FRE_new = m_WeightedPointTransform->GetFRE();
+
+        // double the radius
+        radiusDoubled += 1;
+        currSearchRadius *= 2.0;
+
+        // sanity check to prevent endless loop
+        if (radiusDoubled >= 20)
+        {
+          X->Delete();
+          Z->Delete();
+          X_sorted->Delete();
+          Z_sorted->Delete();
+          mitkThrow() << "Radius doubled 20 times, preventing endless loop, check input and search radius";
+        }
 
-      // termination constraint
-      diff = m_FRE - FRE_new;
+        // termination constraint
+        diff = m_FRE - FRE_new;
 
-    } while (diff < -1.0e-3); // increase radius as long as the FRE grows
+      } while (diff < -1.0e-3); // increase radius as long as the FRE grows
 
-    MITK_DEBUG << "FRE:" << m_FRE << ", FRE_new: " << FRE_new;
-    // transform points and propagate matrices
-    mitk::AnisotropicRegistrationCommon::TransformPoints(X, X, RotationNew, TranslationNew);
-    mitk::AnisotropicRegistrationCommon::PropagateMatrices(Sigma_X, Sigma_X, RotationNew);
+      MITK_DEBUG << "FRE:" << m_FRE << ", FRE_new: " << FRE_new;
+      // transform points and propagate matrices
+      mitk::AnisotropicRegistrationCommon::TransformPoints(X, X, RotationNew, TranslationNew);
+      mitk::AnisotropicRegistrationCommon::PropagateMatrices(Sigma_X, Sigma_X, RotationNew);
 
-    // update global transformation
-    m_Rotation = RotationNew * m_Rotation;
-    m_Translation = RotationNew * m_Translation + TranslationNew;
+      // update global transformation
+      m_Rotation = RotationNew * m_Rotation;
+      m_Translation = RotationNew * m_Translation + TranslationNew;
 
-    MITK_DEBUG << "diff:" << diff;
-    // update FRE
-    m_FRE = FRE_new;
+      MITK_DEBUG << "diff:" << diff;
+      // update FRE
+      m_FRE = FRE_new;
 
-    // update the progressbar. Just use the half every 2nd iteration
-    // to use a simulated endless progress bar since we don't have
-    // a fixed amount of iterations
-    stepSize = (k % 2 == 0) ? stepSize / 2 : stepSize;
-    stepSize = (stepSize == 0) ? 1 : stepSize;
-    mitk::ProgressBar::GetInstance()->Progress(stepSize);
+      // update the progressbar. Just use the half every 2nd iteration
+      // to use a simulated endless progress bar since we don't have
+      // a fixed amount of iterations
+      stepSize = (k % 2 == 0) ? stepSize / 2 : stepSize;
+      stepSize = (stepSize == 0) ? 1 : stepSize;
+      mitk::ProgressBar::GetInstance()->Progress(stepSize);
 
-  } while (diff > m_Threshold && k < m_MaxIterations);
+    } while (diff > m_Threshold && k < m_MaxIterations);
 
-  m_NumberOfIterations = k;
+    m_NumberOfIterations += k;
 
-  // finish the progress bar if there are more steps
-  // left than iterations used
-  if (k < steps)
-    mitk::ProgressBar::GetInstance()->Progress(steps);
+    // finish the progress bar if there are more steps
+    // left than iterations used
+    if (k < steps)
+      mitk::ProgressBar::GetInstance()->Progress(steps);
+  }
 
   // free memory
-  Y->Delete();
   Z->Delete();
   X->Delete();
   X_sorted->Delete();
@@ -17,11 +17,11 @@ found in the LICENSE file.
 
 namespace mitk
 {
-  NonBlockingAlgorithm::NonBlockingAlgorithm() : m_ThreadID(-1), m_UpdateRequests(0), m_KillRequest(false)
+  NonBlockingAlgorithm::NonBlockingAlgorithm()
+    : m_ThreadRunning(false), m_UpdateRequests(0), m_ThreadPoolPriority(ThreadPool::Priority::Visible), m_KillRequest(false)
   {
     m_ParameterListMutex = itk::FastMutexLock::New();
     m_Parameters = PropertyList::New();
-    m_MultiThreader = itk::MultiThreader::New();
   }
 
   NonBlockingAlgorithm::~NonBlockingAlgorithm() {}
@@ -93,39 +93,46 @@ namespace mitk
     m_ParameterListMutex->Lock();
     m_ThreadParameters.m_Algorithm = this;
     ++m_UpdateRequests;
-    m_ParameterListMutex->Unlock();
-    if (m_ThreadID != -1) // thread already running. But something obviously wants us to recalculate the output
+    if (m_ThreadRunning) // thread already running. But something obviously wants us to recalculate the output
     {
+      m_ParameterListMutex->Unlock();
       return; // thread already running
     }
+    m_ThreadRunning = true;
+    m_ParameterListMutex->Unlock();
 
-    // spawn a thread that calls ThreadedUpdateFunction(), and ThreadedUpdateFinished() on us
-    itk::ThreadFunctionType fpointer = &StaticNonBlockingAlgorithmThread;
-    m_ThreadID = m_MultiThreader->SpawnThread(fpointer, &m_ThreadParameters);
+    // let the shared thread pool call ThreadedUpdateFunction(), and ThreadedUpdateFinished() on us
+    auto parameters = &m_ThreadParameters;
+    m_Thread = ThreadPool::GetInstance().Submit([parameters]() { StaticNonBlockingAlgorithmThread(parameters); },
+                                                m_ThreadPoolPriority);
   }
 
   void NonBlockingAlgorithm::StopAlgorithm()
   {
-    if (m_ThreadID == -1)
+    if (!m_Thread.valid())
       return; // thread not running
 
-    m_MultiThreader->TerminateThread(m_ThreadID); // waits for the thread to terminate on its own
+    ThreadPool::GetInstance().Wait(m_Thread); // waits for the thread to terminate on its own
   }
 
-  // a static function to call a member of NonBlockingAlgorithm from inside an ITK thread
-  ITK_THREAD_RETURN_TYPE NonBlockingAlgorithm::StaticNonBlockingAlgorithmThread(void *param)
+  void NonBlockingAlgorithm::SetThreadPoolPriority(ThreadPool::Priority priority)
   {
-    // itk::MultiThreader provides an itk::MultiThreader::ThreadInfoStruct as parameter
-    auto *itkmttis = static_cast<itk::MultiThreader::ThreadInfoStruct *>(param);
+    m_ThreadPoolPriority = priority;
+  }
 
-    // we need the UserData part of that structure
-    auto *flsp = static_cast<ThreadParameters *>(itkmttis->UserData);
+  ThreadPool::Priority NonBlockingAlgorithm::GetThreadPoolPriority() const
+  {
+    return m_ThreadPoolPriority;
+  }
 
+  // a static function to call a member of NonBlockingAlgorithm from inside a thread pool task
+  void NonBlockingAlgorithm::StaticNonBlockingAlgorithmThread(ThreadParameters *flsp)
+  {
     NonBlockingAlgorithm::Pointer algorithm = flsp->m_Algorithm;
     // this UserData tells us, which BubbleTool's method to call
     if (!algorithm)
     {
-      return ITK_THREAD_RETURN_VALUE;
+      return;
     }
 
     algorithm->m_ParameterListMutex->Lock();
@@ -155,8 +162,6 @@ namespace mitk
       algorithm->m_ParameterListMutex->Lock();
     }
     algorithm->m_ParameterListMutex->Unlock();
-
-    return ITK_THREAD_RETURN_VALUE;
   }
 
   void NonBlockingAlgorithm::TriggerParameterModified(const itk::EventObject &) { StartAlgorithm(); }
@@ -172,7 +177,7 @@ namespace mitk
     ThreadedUpdateSuccessful();
 
     m_ParameterListMutex->Lock();
-    m_ThreadID = -1; // tested before starting
+    m_ThreadRunning = false; // tested before starting
     m_ParameterListMutex->Unlock();
     m_ThreadParameters.m_Algorithm = nullptr;
   }
@@ -189,7 +194,7 @@ namespace mitk
     ThreadedUpdateFailed();
 
     m_ParameterListMutex->Lock();
-    m_ThreadID = -1; // tested before starting
+    m_ThreadRunning = false; // tested before starting
     m_ParameterListMutex->Unlock();
     m_ThreadParameters.m_Algorithm = nullptr; // delete
   }
@@ -11,29 +11,51 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkPointLocator.h"
-#include <ANN/ANN.h>
+#include <mitkThreadPool.h>
 #include <vtkPointSet.h>
 
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace
+{
+  // Maximum number of points in a leaf of the search tree
+  const unsigned int LeafSize = 16;
+
+  // Sufficient for the depth of a balanced tree of 2^32 points
+  const unsigned int MaximumStackSize = 128;
+
+  // Number of queries of FindClosestPoints() processed by a task
+  const std::size_t QueriesPerTask = 256;
+
+  double GetSquaredDistanceToBox(const double lower[3], const double upper[3], const double point[3])
+  {
+    double distance = 0.0;
+
+    for (int i = 0; i < 3; ++i)
+    {
+      double d = 0.0;
+
+      if (point[i] < lower[i])
+        d = lower[i] - point[i];
+      else if (point[i] > upper[i])
+        d = point[i] - upper[i];
+
+      distance += d * d;
+    }
+
+    return distance;
+  }
+}
+
 mitk::PointLocator::PointLocator()
-  : m_SearchTreeInitialized(false),
-    m_VtkPoints(nullptr),
-    m_MitkPoints(nullptr),
-    m_ItkPoints(nullptr),
-    m_ANNK(1),
-    m_ANNDimension(3),
-    m_ANNEpsilon(0),
-    m_ANNDataPoints(nullptr),
-    m_ANNQueryPoint(nullptr),
-    m_ANNPointIndexes(nullptr),
-    m_ANNDistances(nullptr),
-    m_ANNTree(nullptr)
+  : m_SearchTreeInitialized(false), m_PointsSource(nullptr), m_PointsSourceMTime(0)
 {
 }
 
 mitk::PointLocator::~PointLocator()
 {
-  if (m_SearchTreeInitialized)
-    DestroyANN();
 }
 
 void mitk::PointLocator::SetPoints(vtkPointSet *pointSet)
@@ -44,31 +66,35 @@ void mitk::PointLocator::SetPoints(vtkPointSet *pointSet)
     return;
   }
   vtkPoints *points = pointSet->GetPoints();
+  if (points == nullptr)
+  {
+    itkWarningMacro("Points are nullptr!");
+    return;
+  }
 
-  if (m_VtkPoints)
+  if ((m_PointsSource == points) && (m_PointsSourceMTime == points->GetMTime()))
   {
-    if ((m_VtkPoints == points) && (m_VtkPoints->GetMTime() == points->GetMTime()))
-    {
-      return; // no need to recalculate search tree
-    }
+    return; // no need to recalculate search tree
   }
-  m_VtkPoints = points;
+  m_PointsSource = points;
+  m_PointsSourceMTime = points->GetMTime();
 
   size_t size = points->GetNumberOfPoints();
-  if (m_ANNDataPoints != nullptr)
-    delete[] m_ANNDataPoints;
-  m_ANNDataPoints = annAllocPts(size, m_ANNDimension);
   m_IndexToPointIdContainer.clear();
   m_IndexToPointIdContainer.resize(size);
+  for (auto &coordinates : m_Points)
+    coordinates.resize(size);
+
   for (vtkIdType i = 0; (unsigned)i < size; ++i)
   {
-    double *currentPoint = points->GetPoint(i);
-    (m_ANNDataPoints[i])[0] = currentPoint[0];
-    (m_ANNDataPoints[i])[1] = currentPoint[1];
-    (m_ANNDataPoints[i])[2] = currentPoint[2];
+    double currentPoint[3];
+    points->GetPoint(i, currentPoint);
+    m_Points[0][i] = currentPoint[0];
+    m_Points[1][i] = currentPoint[1];
+    m_Points[2][i] = currentPoint[2];
     m_IndexToPointIdContainer[i] = i;
   }
-  InitANN();
+  BuildTree();
 }
 
 void mitk::PointLocator::SetPoints(mitk::PointSet *points)
@@ -79,21 +105,19 @@ void mitk::PointLocator::SetPoints(mitk::PointSet *points)
     return;
   }
 
-  if (m_MitkPoints)
+  if ((m_PointsSource == points) && (m_PointsSourceMTime == points->GetMTime()))
   {
-    if ((m_MitkPoints == points) && (m_MitkPoints->GetMTime() == points->GetMTime()))
-    {
-      return; // no need to recalculate search tree
-    }
+    return; // no need to recalculate search tree
   }
-  m_MitkPoints = points;
+  m_PointsSource = points;
+  m_PointsSourceMTime = points->GetMTime();
 
   size_t size = points->GetSize();
-  if (m_ANNDataPoints != nullptr)
-    delete[] m_ANNDataPoints;
-  m_ANNDataPoints = annAllocPts(size, m_ANNDimension);
   m_IndexToPointIdContainer.clear();
   m_IndexToPointIdContainer.resize(size);
+  for (auto &coordinates : m_Points)
+    coordinates.resize(size);
+
   size_t counter = 0;
   mitk::PointSet::PointsContainer *pointsContainer = points->GetPointSet()->GetPoints();
   mitk::PointSet::PointsContainer::Iterator it;
@@ -103,12 +127,12 @@ void mitk::PointLocator::SetPoints(mitk::PointSet *points)
   {
     currentPoint = it->Value();
     currentId = it->Index();
-    (m_ANNDataPoints[counter])[0] = currentPoint[0];
-    (m_ANNDataPoints[counter])[1] = currentPoint[1];
-    (m_ANNDataPoints[counter])[2] = currentPoint[2];
+    m_Points[0][counter] = currentPoint[0];
+    m_Points[1][counter] = currentPoint[1];
+    m_Points[2][counter] = currentPoint[2];
     m_IndexToPointIdContainer[counter] = currentId;
   }
-  InitANN();
+  BuildTree();
 }
 
 void mitk::PointLocator::SetPoints(ITKPointSet *pointSet)
@@ -119,21 +143,19 @@ void mitk::PointLocator::SetPoints(ITKPointSet *pointSet)
     return;
   }
 
-  if (m_ItkPoints)
+  if ((m_PointsSource == pointSet) && (m_PointsSourceMTime == pointSet->GetMTime()))
   {
-    if ((m_ItkPoints == pointSet) && (m_ItkPoints->GetMTime() == pointSet->GetMTime()))
-    {
-      return; // no need to recalculate search tree
-    }
+    return; // no need to recalculate search tree
   }
-  m_ItkPoints = pointSet;
+  m_PointsSource = pointSet;
+  m_PointsSourceMTime = pointSet->GetMTime();
 
   size_t size = pointSet->GetNumberOfPoints();
-  if (m_ANNDataPoints != nullptr)
-    delete[] m_ANNDataPoints;
-  m_ANNDataPoints = annAllocPts(size, m_ANNDimension);
   m_IndexToPointIdContainer.clear();
   m_IndexToPointIdContainer.resize(size);
+  for (auto &coordinates : m_Points)
+    coordinates.resize(size);
+
   size_t counter = 0;
   ITKPointSet::PointsContainerConstPointer pointsContainer = pointSet->GetPoints();
   ITKPointSet::PointsContainer::ConstIterator it;
@@ -143,99 +165,296 @@ void mitk::PointLocator::SetPoints(ITKPointSet *pointSet)
   {
     currentPoint = it->Value();
     currentId = it->Index();
-    (m_ANNDataPoints[counter])[0] = currentPoint[0];
-    (m_ANNDataPoints[counter])[1] = currentPoint[1];
-    (m_ANNDataPoints[counter])[2] = currentPoint[2];
+    m_Points[0][counter] = currentPoint[0];
+    m_Points[1][counter] = currentPoint[1];
+    m_Points[2][counter] = currentPoint[2];
     m_IndexToPointIdContainer[counter] = currentId;
   }
-  InitANN();
+  BuildTree();
 }
 
-mitk::PointLocator::IdType mitk::PointLocator::FindClosestPoint(const double point[3])
+mitk::PointLocator::IdType mitk::PointLocator::FindClosestPoint(const double point[3]) const
 {
-  m_ANNQueryPoint[0] = point[0];
-  m_ANNQueryPoint[1] = point[1];
-  m_ANNQueryPoint[2] = point[2];
-  return FindClosestANNPoint(m_ANNQueryPoint);
+  if (!m_SearchTreeInitialized)
+    return -1;
+
+  DistanceType distance;
+  return m_IndexToPointIdContainer[FindClosestTreePoint(point, &distance)];
 }
 
-mitk::PointLocator::IdType mitk::PointLocator::FindClosestPoint(double x, double y, double z)
+mitk::PointLocator::IdType mitk::PointLocator::FindClosestPoint(double x, double y, double z) const
 {
-  m_ANNQueryPoint[0] = x;
-  m_ANNQueryPoint[1] = y;
-  m_ANNQueryPoint[2] = z;
-  return FindClosestANNPoint(m_ANNQueryPoint);
+  const double point[3] = {x, y, z};
+  return FindClosestPoint(point);
 }
 
-mitk::PointLocator::IdType mitk::PointLocator::FindClosestPoint(mitk::PointSet::PointType point)
+mitk::PointLocator::IdType mitk::PointLocator::FindClosestPoint(mitk::PointSet::PointType point) const
 {
-  m_ANNQueryPoint[0] = point[0];
-  m_ANNQueryPoint[1] = point[1];
-  m_ANNQueryPoint[2] = point[2];
-  return FindClosestANNPoint(m_ANNQueryPoint);
+  const double queryPoint[3] = {point[0], point[1], point[2]};
+  return FindClosestPoint(queryPoint);
 }
 
-mitk::PointLocator::IdType mitk::PointLocator::FindClosestANNPoint(const ANNpoint &point)
+mitk::PointLocator::DistanceType mitk::PointLocator::GetMinimalDistance(mitk::PointSet::PointType point) const
 {
   if (!m_SearchTreeInitialized)
     return -1;
-  m_ANNTree->annkSearch(point, m_ANNK, m_ANNPointIndexes, m_ANNDistances);
-  return m_IndexToPointIdContainer[m_ANNPointIndexes[0]];
+
+  const double queryPoint[3] = {point[0], point[1], point[2]};
+  DistanceType distance;
+  FindClosestTreePoint(queryPoint, &distance);
+  return distance;
 }
 
-mitk::PointLocator::DistanceType mitk::PointLocator::GetMinimalDistance(mitk::PointSet::PointType point)
+bool mitk::PointLocator::FindClosestPointAndDistance(mitk::PointSet::PointType point,
+                                                     IdType *id,
+                                                     DistanceType *dist) const
 {
-  m_ANNQueryPoint[0] = point[0];
-  m_ANNQueryPoint[1] = point[1];
-  m_ANNQueryPoint[2] = point[2];
-  return GetMinimalDistance(m_ANNQueryPoint);
+  if (!m_SearchTreeInitialized)
+    return false;
+
+  const double queryPoint[3] = {point[0], point[1], point[2]};
+  *id = m_IndexToPointIdContainer[FindClosestTreePoint(queryPoint, dist)];
+  return true;
 }
 
-mitk::PointLocator::DistanceType mitk::PointLocator::GetMinimalDistance(const MyANNpoint &point)
+void mitk::PointLocator::FindClosestPoints(const double *points,
+                                           std::size_t numberOfPoints,
+                                           IdType *ids,
+                                           DistanceType *distances) const
 {
   if (!m_SearchTreeInitialized)
-    return -1;
-  m_ANNTree->annkSearch(point, m_ANNK, m_ANNPointIndexes, m_ANNDistances);
-  return m_ANNDistances[0];
+  {
+    std::fill(ids, ids + numberOfPoints, -1);
+    return;
+  }
+
+  ThreadPool::GetInstance().ParallelFor(
+    0,
+    numberOfPoints,
+    [this, points, ids, distances](std::size_t begin, std::size_t end) {
+      for (auto i = begin; i < end; ++i)
+      {
+        DistanceType distance;
+        ids[i] = m_IndexToPointIdContainer[FindClosestTreePoint(points + 3 * i, &distance)];
+
+        if (distances != nullptr)
+          distances[i] = distance;
+      }
+    },
+    QueriesPerTask);
 }
 
-void mitk::PointLocator::InitANN()
+void mitk::PointLocator::FindPointsWithinRadius(const double point[3],
+                                                DistanceType radius,
+                                                std::vector<IdType> &ids) const
 {
-  if (m_SearchTreeInitialized)
-    DestroyANN();
+  ids.clear();
+
+  if (!m_SearchTreeInitialized)
+    return;
 
-  m_ANNQueryPoint = annAllocPt(m_ANNDimension);
-  m_ANNPointIndexes = new ANNidx[m_ANNK];
-  m_ANNDistances = new ANNdist[m_ANNK];
-  m_ANNTree = new ANNkd_tree(m_ANNDataPoints, m_IndexToPointIdContainer.size(), m_ANNDimension);
+  const double squaredRadius = radius * radius;
 
-  m_SearchTreeInitialized = true;
+  unsigned int stack[MaximumStackSize];
+  unsigned int stackSize = 0;
+  stack[stackSize++] = 0;
+
+  while (stackSize > 0)
+  {
+    const Node &node = m_Nodes[stack[--stackSize]];
+
+    if (GetSquaredDistanceToBox(node.Lower, node.Upper, point) > squaredRadius)
+      continue;
+
+    if (node.Children != 0)
+    {
+      stack[stackSize++] = node.Children;
+      stack[stackSize++] = node.Children + 1;
+      continue;
+    }
+
+    for (auto i = node.Begin; i < node.End; ++i)
+    {
+      const double dx = m_Points[0][i] - point[0];
+      const double dy = m_Points[1][i] - point[1];
+      const double dz = m_Points[2][i] - point[2];
+
+      if (dx * dx + dy * dy + dz * dz <= squaredRadius)
+        ids.push_back(m_IndexToPointIdContainer[i]);
+    }
+  }
 }
 
-void mitk::PointLocator::DestroyANN()
+std::size_t mitk::PointLocator::FindClosestTreePoint(const double point[3], DistanceType *squaredDistance) const
 {
-  m_SearchTreeInitialized = false;
-  if (m_ANNQueryPoint != nullptr)
-    annDeallocPt(m_ANNQueryPoint);
-  if (m_ANNDataPoints != nullptr)
-    annDeallocPts(m_ANNDataPoints);
-  if (m_ANNPointIndexes != nullptr)
-    delete[] m_ANNPointIndexes;
-  if (m_ANNDistances != nullptr)
-    delete[] m_ANNDistances;
-  if (m_ANNTree != nullptr)
-    delete m_ANNTree;
+  std::size_t bestIndex = 0;
+  double bestDistance = std::numeric_limits<double>::max();
+
+  // Pending nodes and the squared distance of their bounding boxes to the point
+  unsigned int stack[MaximumStackSize];
+  double stackDistances[MaximumStackSize];
+  unsigned int stackSize = 0;
+
+  stack[stackSize] = 0;
+  stackDistances[stackSize++] = 0.0;
+
+  const double *x = m_Points[0].data();
+  const double *y = m_Points[1].data();
+  const double *z = m_Points[2].data();
+
+  while (stackSize > 0)
+  {
+    --stackSize;
+
+    if (stackDistances[stackSize] >= bestDistance)
+      continue;
+
+    const Node &node = m_Nodes[stack[stackSize]];
+
+    if (node.Children == 0)
+    {
+      // Independent iterations without branches, so that the compiler vectorizes the distances
+      double distances[LeafSize];
+      const auto count = node.End - node.Begin;
+
+      for (unsigned int i = 0; i < count; ++i)
+      {
+        const double dx = x[node.Begin + i] - point[0];
+        const double dy = y[node.Begin + i] - point[1];
+        const double dz = z[node.Begin + i] - point[2];
+        distances[i] = dx * dx + dy * dy + dz * dz;
+      }
+
+      for (unsigned int i = 0; i < count; ++i)
+      {
+        if (distances[i] < bestDistance)
+        {
+          bestDistance = distances[i];
+          bestIndex = node.Begin + i;
+        }
+      }
+
+      continue;
+    }
+
+    const Node &first = m_Nodes[node.Children];
+    const Node &second = m_Nodes[node.Children + 1];
+    const double firstDistance = GetSquaredDistanceToBox(first.Lower, first.Upper, point);
+    const double secondDistance = GetSquaredDistanceToBox(second.Lower, second.Upper, point);
+
+    // Visit the nearer child first by pushing it last
+    if (firstDistance <= secondDistance)
+    {
+      stack[stackSize] = node.Children + 1;
+      stackDistances[stackSize++] = secondDistance;
+      stack[stackSize] = node.Children;
+      stackDistances[stackSize++] = firstDistance;
+    }
+    else
+    {
+      stack[stackSize] = node.Children;
+      stackDistances[stackSize++] = firstDistance;
+      stack[stackSize] = node.Children + 1;
+      stackDistances[stackSize++] = secondDistance;
+    }
+  }
+
+  *squaredDistance = bestDistance;
+  return bestIndex;
 }
 
-bool mitk::PointLocator::FindClosestPointAndDistance(mitk::PointSet::PointType point, IdType *id, DistanceType *dist)
+void mitk::PointLocator::BuildTree()
 {
-  m_ANNQueryPoint[0] = point[0];
-  m_ANNQueryPoint[1] = point[1];
-  m_ANNQueryPoint[2] = point[2];
+  m_SearchTreeInitialized = false;
+  m_Nodes.clear();
 
-  m_ANNTree->annkSearch(m_ANNQueryPoint, m_ANNK, m_ANNPointIndexes, m_ANNDistances);
+  const auto numberOfPoints = static_cast<unsigned int>(m_IndexToPointIdContainer.size());
 
-  *id = m_IndexToPointIdContainer[m_ANNPointIndexes[0]];
-  *dist = m_ANNDistances[0];
-  return true;
+  if (numberOfPoints == 0)
+    return;
+
+  // Split the nodes at the median of their longest side, so that the tree is balanced. The
+  // points are reordered by a permutation and stored in that order afterwards.
+  std::vector<unsigned int> order(numberOfPoints);
+  std::iota(order.begin(), order.end(), 0u);
+
+  m_Nodes.reserve(2 * (numberOfPoints / LeafSize + 1));
+  m_Nodes.push_back(Node());
+  m_Nodes[0].Begin = 0;
+  m_Nodes[0].End = numberOfPoints;
+
+  for (std::size_t n = 0; n < m_Nodes.size(); ++n)
+  {
+    // Copy, since adding the children may reallocate m_Nodes
+    Node node = m_Nodes[n];
+
+    for (int i = 0; i < 3; ++i)
+    {
+      node.Lower[i] = std::numeric_limits<double>::max();
+      node.Upper[i] = std::numeric_limits<double>::lowest();
+    }
+
+    for (auto p = node.Begin; p < node.End; ++p)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        node.Lower[i] = std::min(node.Lower[i], m_Points[i][order[p]]);
+        node.Upper[i] = std::max(node.Upper[i], m_Points[i][order[p]]);
+      }
+    }
+
+    node.Children = 0;
+
+    if (node.End - node.Begin > LeafSize)
+    {
+      int axis = 0;
+
+      for (int i = 1; i < 3; ++i)
+      {
+        if (node.Upper[i] - node.Lower[i] > node.Upper[axis] - node.Lower[axis])
+          axis = i;
+      }
+
+      const auto middle = node.Begin + (node.End - node.Begin) / 2;
+      const auto &coordinates = m_Points[axis];
+
+      std::nth_element(order.begin() + node.Begin,
+                       order.begin() + middle,
+                       order.begin() + node.End,
+                       [&coordinates](unsigned int a, unsigned int b) { return coordinates[a] < coordinates[b]; });
+
+      node.Children = static_cast<unsigned int>(m_Nodes.size());
+
+      Node first;
+      first.Begin = node.Begin;
+      first.End = middle;
+      m_Nodes.push_back(first);
+
+      Node second;
+      second.Begin = middle;
+      second.End = node.End;
+      m_Nodes.push_back(second);
+    }
+
+    m_Nodes[n] = node;
+  }
+
+  for (auto &coordinates : m_Points)
+  {
+    std::vector<double> reordered(numberOfPoints);
+
+    for (unsigned int p = 0; p < numberOfPoints; ++p)
+      reordered[p] = coordinates[order[p]];
+
+    coordinates.swap(reordered);
+  }
+
+  IdVectorType reorderedIds(numberOfPoints);
+
+  for (unsigned int p = 0; p < numberOfPoints; ++p)
+    reorderedIds[p] = m_IndexToPointIdContainer[order[p]];
+
+  m_IndexToPointIdContainer.swap(reorderedIds);
+
+  m_SearchTreeInitialized = true;
 }
@@ -12,13 +12,15 @@ found in the LICENSE file.
 
 #include <mitkUnstructuredGridClusteringFilter.h>
 
+#include <mitkThreadPool.h>
+
+#include <algorithm>
 #include <vector>
 
 #include <vtkDataArray.h>
 #include <vtkDelaunay3D.h>
 #include <vtkDoubleArray.h>
 #include <vtkPointData.h>
-#include <vtkPointLocator.h>
 #include <vtkPoints.h>
 #include <vtkPolyVertex.h>
 #include <vtkSmartPointer.h>
@@ -35,14 +37,6 @@ mitk::UnstructuredGridClusteringFilter::~UnstructuredGridClusteringFilter()
 {
 }
 
-std::map<int, bool> visited;
-std::map<int, bool> isNoise;
-std::map<int, bool> clusterMember;
-vtkSmartPointer<vtkPointLocator> pLocator;
-std::vector<vtkSmartPointer<vtkPoints>> clusterVector;
-
-std::vector<std::vector<int>> clustersPointsIDs;
-
 void mitk::UnstructuredGridClusteringFilter::GenerateOutputInformation()
 {
   m_UnstructGrid = this->GetOutput();
@@ -56,8 +50,9 @@ void mitk::UnstructuredGridClusteringFilter::GenerateData()
 
   vtkSmartPointer<vtkUnstructuredGrid> vtkInpGrid = inputGrid->GetVtkUnstructuredGrid();
   vtkSmartPointer<vtkPoints> inpPoints = vtkInpGrid->GetPoints();
-  pLocator = vtkSmartPointer<vtkPointLocator>::New();
+  const int numberOfPoints = inpPoints->GetNumberOfPoints();
 
+  m_DistanceArrays.clear();
   vtkSmartPointer<vtkDoubleArray> distances = vtkSmartPointer<vtkDoubleArray>::New();
   if (inputGrid->GetVtkUnstructuredGrid()->GetPointData()->GetNumberOfArrays() > 0)
   {
@@ -65,70 +60,72 @@ void mitk::UnstructuredGridClusteringFilter::GenerateData()
     distances = dynamic_cast<vtkDoubleArray *>(vtkInpGrid->GetPointData()->GetArray(0));
   }
 
-  pLocator->SetDataSet(vtkInpGrid);
-  pLocator->AutomaticOn();
-  pLocator->SetNumberOfPointsPerBucket(2);
-  pLocator->BuildLocator();
+  // DBSCAN queries the neighbourhood of every point exactly once, so all region queries are done up front
+  // on a k-d tree which is built once and can be queried by several threads at once
+  auto locator = mitk::PointLocator::New();
+  locator->SetPoints(vtkInpGrid);
+
+  std::vector<std::vector<PointLocator::IdType>> neighbours(numberOfPoints);
+  mitk::ThreadPool::GetInstance().ParallelFor(
+    0,
+    numberOfPoints,
+    [&](std::size_t begin, std::size_t end) {
+      double point[3];
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        inpPoints->GetPoint(i, point);
+        locator->FindPointsWithinRadius(point, m_eps, neighbours[i]); // N = D.regionQuery(P, eps)
+        // the locator returns the points in no particular order, keep the clusters independent of it
+        std::sort(neighbours[i].begin(), neighbours[i].end());
+      }
+    },
+    256);
 
-  // fill the visited map with false for checking
-  for (int i = 0; i < inpPoints->GetNumberOfPoints(); i++)
-  {
-    visited[i] = false;
-    isNoise[i] = false;
-    clusterMember[i] = false;
-  }
+  std::vector<bool> visited(numberOfPoints, false);
+  std::vector<bool> clusterMember(numberOfPoints, false);
+  std::vector<std::vector<int>> clustersPointsIDs;
 
-  for (int i = 0; i < inpPoints->GetNumberOfPoints(); i++)
+  for (int i = 0; i < numberOfPoints; i++)
   {
     if (!visited[i])
     {
-      visited[i] = true;                                                       // mark P as visited
-      vtkSmartPointer<vtkIdList> idList = vtkSmartPointer<vtkIdList>::New();   // represent N
-      pLocator->FindPointsWithinRadius(m_eps, inpPoints->GetPoint(i), idList); // N = D.regionQuery(P, eps)
-      if (idList->GetNumberOfIds() < m_MinPts)                                 // if sizeof(N) < MinPts
-      {
-        isNoise[i] = true; // mark P as NOISE
-      }
-      else
+      visited[i] = true; // mark P as visited
+
+      // if sizeof(N) < MinPts, P is NOISE, which may still be added to a cluster later
+      if (static_cast<int>(neighbours[i].size()) >= m_MinPts)
       {
-        vtkSmartPointer<vtkPoints> cluster = vtkSmartPointer<vtkPoints>::New(); // represent a cluster
-        clusterVector.push_back(cluster);                                       // C = next cluster
-        this->ExpandCluster(
-          i, idList, cluster, inpPoints); // expandCluster(P, N, C, eps, MinPts) mod. the parameter list
+        // C = next cluster, expandCluster(P, N, C, eps, MinPts)
+        clustersPointsIDs.push_back(this->ExpandCluster(i, neighbours, visited, clusterMember));
       }
     }
   }
 
   // OUTPUT LOGIC
-  m_Clusters = clusterVector;
+  m_Clusters.clear();
   int numberOfClusterPoints = 0;
   int IdOfBiggestCluster = 0;
 
-  for (unsigned int i = 0; i < m_Clusters.size(); i++)
+  for (unsigned int i = 0; i < clustersPointsIDs.size(); i++)
   {
-    vtkSmartPointer<vtkDoubleArray> array = vtkSmartPointer<vtkDoubleArray>::New();
-    vtkSmartPointer<vtkPoints> points = m_Clusters.at(i);
+    const std::vector<int> &pointIDs = clustersPointsIDs.at(i);
+
+    vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+    points->SetNumberOfPoints(pointIDs.size());
+    for (unsigned int j = 0; j < pointIDs.size(); j++)
+    {
+      points->SetPoint(j, inpPoints->GetPoint(pointIDs.at(j)));
+    }
+    m_Clusters.push_back(points);
+
     if (m_DistCalc)
     {
+      vtkSmartPointer<vtkDoubleArray> array = vtkSmartPointer<vtkDoubleArray>::New();
       array->SetNumberOfComponents(1);
-      array->SetNumberOfTuples(points->GetNumberOfPoints());
-      for (int j = 0; j < points->GetNumberOfPoints(); j++)
+      array->SetNumberOfTuples(pointIDs.size());
+      for (unsigned int j = 0; j < pointIDs.size(); j++)
       {
-        double point[3];
-        points->GetPoint(j, point);
-        if (clustersPointsIDs.at(i).at(j) < inpPoints->GetNumberOfPoints())
-        {
-          if (distances->GetValue(clustersPointsIDs.at(i).at(j)) > 0.001)
-          {
-            double dist[1] = {distances->GetValue(clustersPointsIDs.at(i).at(j))};
-            array->SetTuple(j, dist);
-          }
-          else
-          {
-            double dist[1] = {0.0};
-            array->SetTuple(j, dist);
-          }
-        }
+        double dist[1] = {distances->GetValue(pointIDs.at(j)) > 0.001 ? distances->GetValue(pointIDs.at(j)) : 0.0};
+        array->SetTuple(j, dist);
       }
       m_DistanceArrays.push_back(array);
     }
@@ -169,56 +166,45 @@ void mitk::UnstructuredGridClusteringFilter::GenerateData()
   {
     m_UnstructGrid->SetVtkUnstructuredGrid(biggestCluster);
   }
-
-  clusterVector.clear();
-  clustersPointsIDs.clear();
 }
 
-void mitk::UnstructuredGridClusteringFilter::ExpandCluster(int id,
-                                                           vtkIdList *pointIDs,
-                                                           vtkPoints *cluster,
-                                                           vtkPoints *inpPoints)
+std::vector<int> mitk::UnstructuredGridClusteringFilter::ExpandCluster(
+  int id,
+  const std::vector<std::vector<PointLocator::IdType>> &neighbours,
+  std::vector<bool> &visited,
+  std::vector<bool> &clusterMember)
 {
-  std::vector<int> x;
-  x.push_back(id);
-  cluster->InsertNextPoint(inpPoints->GetPoint(id)); // add P to cluster C
+  std::vector<int> clusterPointIDs;
+  clusterPointIDs.push_back(id); // add P to cluster C
   clusterMember[id] = true;
 
-  vtkSmartPointer<vtkPoints> neighbours = vtkSmartPointer<vtkPoints>::New(); // same N as in other function
-  inpPoints->GetPoints(pointIDs, neighbours);
+  std::vector<int> pointIDs(neighbours[id].begin(), neighbours[id].end()); // same N as in other function
 
-  for (int i = 0; i < pointIDs->GetNumberOfIds(); i++) // for each point P' in N
+  for (std::size_t i = 0; i < pointIDs.size(); i++) // for each point P' in N
   {
-    if (!visited[pointIDs->GetId(i)]) // if P' is not visited
+    const int neighbourID = pointIDs[i];
+    if (!visited[neighbourID]) // if P' is not visited
     {
-      visited[pointIDs->GetId(i)] = true;                                    // mark P' as visited
-      vtkSmartPointer<vtkIdList> idList = vtkSmartPointer<vtkIdList>::New(); // represent N'
-      pLocator->FindPointsWithinRadius(
-        m_eps, inpPoints->GetPoint(pointIDs->GetId(i)), idList); // N' = D.regionQuery(P', eps)
+      visited[neighbourID] = true; // mark P' as visited
 
-      if (idList->GetNumberOfIds() >= m_MinPts) // if sizeof(N') >= MinPts
+      if (static_cast<int>(neighbours[neighbourID].size()) >= m_MinPts) // if sizeof(N') >= MinPts
       {
-        for (int j = 0; j < idList->GetNumberOfIds(); j++) // N = N joined with N'
+        for (auto j : neighbours[neighbourID]) // N = N joined with N'
         {
-          if (idList->GetId(j) < inpPoints->GetNumberOfPoints()) // a litte bit hacked ?!
-          {
-            pointIDs->InsertNextId(idList->GetId(j));
-          }
+          // members are visited already and would be skipped below anyway
+          if (!clusterMember[j])
+            pointIDs.push_back(j);
         }
       }
     }
-    if (!clusterMember[pointIDs->GetId(i)]) // if P' is not yet member of any cluster
+    if (!clusterMember[neighbourID]) // if P' is not yet member of any cluster
     {
-      if (pointIDs->GetId(i) < inpPoints->GetNumberOfPoints())
-      {
-        clusterMember[pointIDs->GetId(i)] = true;
-        x.push_back(pointIDs->GetId(i));
-        cluster->InsertNextPoint(inpPoints->GetPoint(pointIDs->GetId(i))); // add P' to cluster C
-      }
+      clusterMember[neighbourID] = true;
+      clusterPointIDs.push_back(neighbourID); // add P' to cluster C
     }
   }
 
-  clustersPointsIDs.push_back(x);
+  return clusterPointIDs;
 }
 
 std::vector<mitk::UnstructuredGrid::Pointer> mitk::UnstructuredGridClusteringFilter::GetAllClusters()
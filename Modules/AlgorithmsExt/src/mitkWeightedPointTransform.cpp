@@ -50,7 +50,9 @@ mitk::WeightedPointTransform::WeightedPointTransform()
     m_Iterations(-1),
     m_FRE(-1.0),
     m_FRENormalizationFactor(1.0),
-    m_LandmarkTransform(vtkSmartPointer<vtkLandmarkTransform>::New())
+    m_LandmarkTransform(vtkSmartPointer<vtkLandmarkTransform>::New()),
+    m_TransformedMovingPointSet(vtkSmartPointer<vtkPoints>::New()),
+    m_TransformedMovingPointSetNew(vtkSmartPointer<vtkPoints>::New())
 {
 }
 
@@ -59,6 +61,8 @@ mitk::WeightedPointTransform::~WeightedPointTransform()
   m_FixedPointSet = nullptr;
   m_MovingPointSet = nullptr;
   m_LandmarkTransform = nullptr;
+  m_TransformedMovingPointSet = nullptr;
+  m_TransformedMovingPointSetNew = nullptr;
 }
 
 void mitk::WeightedPointTransform::ComputeTransformation()
@@ -106,7 +110,7 @@ double ComputeWeightedFRE(vtkPoints *X,
   // compute weighting matrices
   calculateWeightMatrices(CovarianceMatricesMoving, CovarianceMatricesFixed, WeightMatrices, rotation);
 
-#pragma omp parallel for
+#pragma omp parallel for reduction(+ : FRE)
   for (int i = 0; i < static_cast<int>(WeightMatrices.size()); ++i)
   {
     // convert to itk data types (nessecary since itk 4 migration)
@@ -127,7 +131,6 @@ double ComputeWeightedFRE(vtkPoints *X,
 
     // do calculation
     const itk::Vector<double, 3> D = WeightMatrices.at(i) * p;
-#pragma omp critical
     FRE += (D[0] * D[0] + D[1] * D[1] + D[2] * D[2]);
   }
 
@@ -239,14 +242,14 @@ void mitk::WeightedPointTransform::WeightedPointRegister(vtkPoints *X,
   Translation initial_TransformationT;
   initial_TransformationT.Fill(0.0);
   // Weightmatrices
-  Matrix3x3List W;
-  vtkPoints *X_transformed = vtkPoints::New();
-  vtkPoints *X_transformedNew = vtkPoints::New();
+  Matrix3x3List &W = m_WeightMatrices;
+  vtkPoints *X_transformed = m_TransformedMovingPointSet;
+  vtkPoints *X_transformedNew = m_TransformedMovingPointSetNew;
   vnl_vector<double> oldq;
-  itk::VariableSizeMatrix<double> iA;
-  vnl_vector<double> iB;
+  itk::VariableSizeMatrix<double> &iA = m_C;
+  vnl_vector<double> &iB = m_E;
 
-  // initialize memory
+  // initialize memory, the buffers only grow if the point set grows
   W.resize(X->GetNumberOfPoints());
   X_transformed->SetNumberOfPoints(X->GetNumberOfPoints());
   X_transformedNew->SetNumberOfPoints(X->GetNumberOfPoints());
@@ -311,8 +314,7 @@ void mitk::WeightedPointTransform::WeightedPointRegister(vtkPoints *X,
     C_maker(X_transformed, W, iA);
     E_maker(X_transformed, Y, W, iB);
 
-    vnl_matrix_inverse<double> myInverse(iA.GetVnlMatrix());
-    vnl_vector<double> q = myInverse.pinverse(iB.size()) * iB;
+    vnl_vector<double> q = SolveLinearProblem(iA, iB);
     //'''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''
 
     if (n > 1)
@@ -386,9 +388,34 @@ void mitk::WeightedPointTransform::WeightedPointRegister(vtkPoints *X,
   }
 
   MITK_DEBUG << "FRE final: " << FRE;
+}
+
+vnl_vector<double> mitk::WeightedPointTransform::SolveLinearProblem(const itk::VariableSizeMatrix<double> &C,
+                                                                     const vnl_vector<double> &e)
+{
+  vnl_matrix<double> CtC(6, 6, 0.0);
+  vnl_vector<double> Cte(6, 0.0);
+
+  // the rows are accumulated directly to avoid the 6 x 3N transpose of C
+  for (unsigned int row = 0; row < C.Rows(); ++row)
+  {
+    const double *c = C.GetVnlMatrix()[row];
+
+    for (unsigned int i = 0; i < 6; ++i)
+    {
+      for (unsigned int j = i; j < 6; ++j)
+        CtC[i][j] += c[i] * c[j];
+
+      Cte[i] += c[i] * e[row];
+    }
+  }
+
+  for (unsigned int i = 0; i < 6; ++i)
+    for (unsigned int j = 0; j < i; ++j)
+      CtC[i][j] = CtC[j][i];
 
-  X_transformed->Delete();
-  X_transformedNew->Delete();
+  vnl_svd<double> svd(CtC);
+  return svd.pinverse() * Cte;
 }
 
 void mitk::WeightedPointTransform::SetMovingPointSet(vtkSmartPointer<vtkPoints> p)
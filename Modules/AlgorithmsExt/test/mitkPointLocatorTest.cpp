@@ -0,0 +1,158 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkPointLocator.h>
+#include <mitkTestingMacros.h>
+
+#include <mitkTestFixture.h>
+
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+
+/** Test class to test the k-d tree of the point locator against
+  * a brute force search.
+  */
+class mitkPointLocatorTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkPointLocatorTestSuite);
+  MITK_TEST(testFindClosestPoint);
+  MITK_TEST(testFindClosestPoints);
+  MITK_TEST(testFindPointsWithinRadius);
+  MITK_TEST(testEmptyPointSet);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  std::vector<double> m_Points;
+  std::vector<double> m_Queries;
+  mitk::PointLocator::Pointer m_Locator;
+
+  double GetSquaredDistance(const double *a, const double *b)
+  {
+    double squaredDistance = 0.0;
+
+    for (int i = 0; i < 3; ++i)
+      squaredDistance += (a[i] - b[i]) * (a[i] - b[i]);
+
+    return squaredDistance;
+  }
+
+  double GetMinimalSquaredDistance(const double *query)
+  {
+    double minimalSquaredDistance = std::numeric_limits<double>::max();
+
+    for (std::size_t i = 0; i < m_Points.size(); i += 3)
+      minimalSquaredDistance = std::min(minimalSquaredDistance, GetSquaredDistance(query, &m_Points[i]));
+
+    return minimalSquaredDistance;
+  }
+
+public:
+  void setUp() override
+  {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> distribution(-100.0, 100.0);
+
+    auto points = vtkSmartPointer<vtkPoints>::New();
+
+    for (int i = 0; i < 5000; ++i)
+    {
+      double point[3] = { distribution(generator), distribution(generator), distribution(generator) };
+      points->InsertNextPoint(point);
+      m_Points.insert(m_Points.end(), point, point + 3);
+    }
+
+    for (int i = 0; i < 3 * 500; ++i)
+      m_Queries.push_back(1.2 * distribution(generator));
+
+    auto polyData = vtkSmartPointer<vtkPolyData>::New();
+    polyData->SetPoints(points);
+
+    m_Locator = mitk::PointLocator::New();
+    m_Locator->SetPoints(polyData);
+  }
+
+  void tearDown() override
+  {
+    m_Points.clear();
+    m_Queries.clear();
+    m_Locator = nullptr;
+  }
+
+  void testFindClosestPoint()
+  {
+    for (std::size_t i = 0; i < m_Queries.size(); i += 3)
+    {
+      const double *query = &m_Queries[i];
+      auto id = m_Locator->FindClosestPoint(query);
+
+      CPPUNIT_ASSERT(0 <= id && static_cast<std::size_t>(3 * id) < m_Points.size());
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(GetMinimalSquaredDistance(query), GetSquaredDistance(query, &m_Points[3 * id]), 1e-6);
+    }
+  }
+
+  void testFindClosestPoints()
+  {
+    const auto numberOfQueries = m_Queries.size() / 3;
+    std::vector<mitk::PointLocator::IdType> ids(numberOfQueries);
+    std::vector<mitk::PointLocator::DistanceType> distances(numberOfQueries);
+
+    m_Locator->FindClosestPoints(m_Queries.data(), numberOfQueries, ids.data(), distances.data());
+
+    for (std::size_t i = 0; i < numberOfQueries; ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL(m_Locator->FindClosestPoint(&m_Queries[3 * i]), ids[i]);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(GetMinimalSquaredDistance(&m_Queries[3 * i]), distances[i], 1e-6);
+    }
+  }
+
+  void testFindPointsWithinRadius()
+  {
+    const double radius = 15.0;
+    std::vector<mitk::PointLocator::IdType> ids;
+
+    for (std::size_t i = 0; i < m_Queries.size(); i += 3)
+    {
+      const double *query = &m_Queries[i];
+      m_Locator->FindPointsWithinRadius(query, radius, ids);
+
+      std::vector<mitk::PointLocator::IdType> expectedIds;
+
+      for (std::size_t j = 0; j < m_Points.size(); j += 3)
+      {
+        if (GetSquaredDistance(query, &m_Points[j]) <= radius * radius)
+          expectedIds.push_back(static_cast<mitk::PointLocator::IdType>(j / 3));
+      }
+
+      std::sort(ids.begin(), ids.end());
+      CPPUNIT_ASSERT(expectedIds == ids);
+    }
+  }
+
+  void testEmptyPointSet()
+  {
+    auto locator = mitk::PointLocator::New();
+    const double query[3] = { 0.0, 0.0, 0.0 };
+
+    CPPUNIT_ASSERT_EQUAL(-1, locator->FindClosestPoint(query));
+
+    std::vector<mitk::PointLocator::IdType> ids(1, 0);
+    locator->FindPointsWithinRadius(query, 1.0, ids);
+    CPPUNIT_ASSERT(ids.empty());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkPointLocator)
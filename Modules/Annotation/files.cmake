@@ -6,6 +6,7 @@ set(CPP_FILES
   mitkLabelAnnotation3D.cpp
   mitkLogoAnnotation.cpp
   mitkLayoutAnnotationRenderer.cpp
+  mitkRenderingProfileAnnotation.cpp
   mitkScaleLegendAnnotation.cpp
   mitkTextAnnotation2D.cpp
   mitkTextAnnotation3D.cpp
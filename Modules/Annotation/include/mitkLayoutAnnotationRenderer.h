@@ -89,11 +89,25 @@ namespace mitk
     void PrepareLeftLayout(int *displaySize);
     void PrepareRightLayout(int *displaySize);
 
-    static double GetHeight(AnnotationRankedMap &annotations, BaseRenderer *renderer);
+    double GetHeight(AnnotationRankedMap &annotations);
+
+    /** \brief Returns the bounds of the annotation on the current renderer.
+     *
+     * Measuring the bounds of text annotations is costly, so the bounds are cached and only measured again
+     * if the annotation or its properties were modified since the last measurement.
+     */
+    Annotation::Bounds GetBoundsOnDisplay(Annotation *annotation);
 
     void OnAnnotationRenderersChanged() override;
     static const std::string ANNOTATIONRENDERER_ID;
     AnnotationLayouterContainerMap m_AnnotationContainerMap;
+
+    struct CachedBounds
+    {
+      itk::ModifiedTimeType MTime;
+      Annotation::Bounds Bounds;
+    };
+    std::map<Annotation *, CachedBounds> m_CachedBounds;
     static void SetMargin2D(Annotation *annotation, const Point2D &OffsetVector);
     static Point2D GetMargin2D(Annotation *annotation);
   };
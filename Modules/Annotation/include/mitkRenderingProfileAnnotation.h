@@ -0,0 +1,64 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef RENDERINGPROFILEANNOTATION_H
+#define RENDERINGPROFILEANNOTATION_H
+
+#include "MitkAnnotationExports.h"
+#include <mitkRenderingProfiler.h>
+#include <mitkTextAnnotation2D.h>
+
+#include <map>
+
+namespace mitk
+{
+  /** \brief Displays the times recorded by the RenderingProfiler of the render window
+
+    Adding the annotation to a renderer enables its profiler, removing it disables the profiler
+    again. The text shows the last frame when the next frame is rendered, so that the annotation
+    does not request any rendering itself.
+    */
+  class MITKANNOTATION_EXPORT RenderingProfileAnnotation : public mitk::TextAnnotation2D
+  {
+  public:
+    mitkClassMacro(RenderingProfileAnnotation, mitk::TextAnnotation2D);
+    itkFactorylessNewMacro(Self);
+
+    /** \brief Number of the slowest mappers listed in the text */
+    void SetNumberOfMappers(unsigned int numberOfMappers);
+    unsigned int GetNumberOfMappers() const;
+
+    void AddToBaseRenderer(BaseRenderer *renderer) override;
+    void RemoveFromBaseRenderer(BaseRenderer *renderer) override;
+
+  protected:
+    /** \brief explicit constructor which disallows implicit conversions */
+    explicit RenderingProfileAnnotation();
+
+    /** \brief virtual destructor in order to derive from this class */
+    ~RenderingProfileAnnotation() override;
+
+  private:
+    void OnFrameEnded(const itk::Object *caller, const itk::EventObject &event);
+
+    /** \brief Observed profilers and the tags of the observers */
+    std::map<BaseRenderer *, std::pair<RenderingProfiler::Pointer, unsigned long>> m_Profilers;
+
+    /** \brief copy constructor */
+    RenderingProfileAnnotation(const RenderingProfileAnnotation &);
+
+    /** \brief assignment operator */
+    RenderingProfileAnnotation &operator=(const RenderingProfileAnnotation &);
+  };
+
+} // namespace mitk
+#endif // RENDERINGPROFILEANNOTATION_H
@@ -17,6 +17,8 @@ found in the LICENSE file.
 #include "mitkEnumerationProperty.h"
 #include <mitkVtkLayerController.h>
 
+#include <algorithm>
+
 namespace mitk
 {
   const std::string LayoutAnnotationRenderer::ANNOTATIONRENDERER_ID = "LayoutAnnotationRenderer";
@@ -70,7 +72,18 @@ namespace mitk
     if (!this->GetCurrentBaseRenderer())
       return;
     m_AnnotationContainerMap.clear();
-    for (Annotation *annotation : this->GetServices())
+    auto annotations = this->GetServices();
+
+    // forget the bounds of removed annotations
+    for (auto it = m_CachedBounds.begin(); it != m_CachedBounds.end();)
+    {
+      if (std::find(annotations.begin(), annotations.end(), it->first) == annotations.end())
+        it = m_CachedBounds.erase(it);
+      else
+        ++it;
+    }
+
+    for (Annotation *annotation : annotations)
     {
       if (!annotation)
         continue;
@@ -120,7 +133,13 @@ namespace mitk
     return result;
   }
 
-  void LayoutAnnotationRenderer::OnRenderWindowModified() { PrepareLayout(); }
+  void LayoutAnnotationRenderer::OnRenderWindowModified()
+  {
+    // the bounds on display may depend on the render window, e.g. its DPI
+    m_CachedBounds.clear();
+    PrepareLayout();
+  }
+
   void LayoutAnnotationRenderer::AddAnnotation(Annotation *Annotation,
                                                const std::string &rendererID,
                                                Alignment alignment,
@@ -171,7 +190,7 @@ namespace mitk
     {
       Annotation *Annotation = it->second;
       margin = GetMargin2D(Annotation);
-      bounds = Annotation->GetBoundsOnDisplay(this->GetCurrentBaseRenderer());
+      bounds = this->GetBoundsOnDisplay(Annotation);
 
       posY -= bounds.Size[1] + margin[1];
       bounds.Position[0] = posX + margin[0];
@@ -191,7 +210,7 @@ namespace mitk
     {
       Annotation *Annotation = it->second;
       margin = GetMargin2D(Annotation);
-      bounds = Annotation->GetBoundsOnDisplay(this->GetCurrentBaseRenderer());
+      bounds = this->GetBoundsOnDisplay(Annotation);
 
       posX = displaySize[0] / 2 - bounds.Size[0] / 2;
       posY -= bounds.Size[1] + margin[1];
@@ -212,7 +231,7 @@ namespace mitk
     {
       Annotation *Annotation = it->second;
       margin = GetMargin2D(Annotation);
-      bounds = Annotation->GetBoundsOnDisplay(this->GetCurrentBaseRenderer());
+      bounds = this->GetBoundsOnDisplay(Annotation);
 
       posX = displaySize[0] - (bounds.Size[0] + margin[0]);
       posY -= bounds.Size[1] + margin[1];
@@ -226,7 +245,7 @@ namespace mitk
   {
     double posY;
     Point2D margin;
-    double height = GetHeight(m_AnnotationContainerMap[Right], GetCurrentBaseRenderer());
+    double height = GetHeight(m_AnnotationContainerMap[Right]);
     posY = (height / 2.0 + displaySize[1]) / 2.0;
     mitk::Annotation::Bounds bounds;
     AnnotationRankedMap &AnnotationMap = m_AnnotationContainerMap[Right];
@@ -234,7 +253,7 @@ namespace mitk
     {
       Annotation *Annotation = it->second;
       margin = GetMargin2D(Annotation);
-      bounds = Annotation->GetBoundsOnDisplay(this->GetCurrentBaseRenderer());
+      bounds = this->GetBoundsOnDisplay(Annotation);
 
       posY -= bounds.Size[1] + margin[1];
       bounds.Position[0] = displaySize[0] - (bounds.Size[0] + margin[0]);
@@ -247,7 +266,7 @@ namespace mitk
   {
     double posY;
     Point2D margin;
-    double height = GetHeight(m_AnnotationContainerMap[Left], GetCurrentBaseRenderer());
+    double height = GetHeight(m_AnnotationContainerMap[Left]);
     posY = (height / 2.0 + displaySize[1]) / 2.0;
     mitk::Annotation::Bounds bounds;
     AnnotationRankedMap &AnnotationMap = m_AnnotationContainerMap[Left];
@@ -255,7 +274,7 @@ namespace mitk
     {
       Annotation *Annotation = it->second;
       margin = GetMargin2D(Annotation);
-      bounds = Annotation->GetBoundsOnDisplay(this->GetCurrentBaseRenderer());
+      bounds = this->GetBoundsOnDisplay(Annotation);
 
       posY -= bounds.Size[1] + margin[1];
       bounds.Position[0] = margin[0];
@@ -276,7 +295,7 @@ namespace mitk
     {
       Annotation *Annotation = it->second;
       margin = GetMargin2D(Annotation);
-      bounds = Annotation->GetBoundsOnDisplay(this->GetCurrentBaseRenderer());
+      bounds = this->GetBoundsOnDisplay(Annotation);
 
       bounds.Position[0] = posX + margin[0];
       bounds.Position[1] = posY + margin[1];
@@ -296,7 +315,7 @@ namespace mitk
     {
       Annotation *Annotation = it->second;
       margin = GetMargin2D(Annotation);
-      bounds = Annotation->GetBoundsOnDisplay(this->GetCurrentBaseRenderer());
+      bounds = this->GetBoundsOnDisplay(Annotation);
 
       posX = displaySize[0] / 2 - bounds.Size[0] / 2;
       bounds.Position[0] = posX;
@@ -317,7 +336,7 @@ namespace mitk
     {
       Annotation *Annotation = it->second;
       margin = GetMargin2D(Annotation);
-      bounds = Annotation->GetBoundsOnDisplay(this->GetCurrentBaseRenderer());
+      bounds = this->GetBoundsOnDisplay(Annotation);
 
       posX = displaySize[0] - (bounds.Size[0] + margin[0]);
       bounds.Position[0] = posX;
@@ -327,16 +346,35 @@ namespace mitk
     }
   }
 
-  double LayoutAnnotationRenderer::GetHeight(AnnotationRankedMap &annotations, BaseRenderer *renderer)
+  double LayoutAnnotationRenderer::GetHeight(AnnotationRankedMap &annotations)
   {
     double height = 0;
     for (auto it = annotations.cbegin(); it != annotations.cend(); ++it)
     {
       Annotation *annotation = it->second;
-      Annotation::Bounds bounds = annotation->GetBoundsOnDisplay(renderer);
+      Annotation::Bounds bounds = this->GetBoundsOnDisplay(annotation);
       height += bounds.Size[0];
       height += GetMargin2D(annotation)[0];
     }
     return height;
   }
+
+  Annotation::Bounds LayoutAnnotationRenderer::GetBoundsOnDisplay(Annotation *annotation)
+  {
+    BaseRenderer *renderer = this->GetCurrentBaseRenderer();
+
+    // bring the annotation up to date first, so that the measured bounds belong to its current state
+    annotation->Update(renderer);
+
+    const itk::ModifiedTimeType mTime =
+      std::max(annotation->GetMTime(), annotation->GetPropertyList()->GetMTime());
+
+    auto cached = m_CachedBounds.find(annotation);
+    if (cached != m_CachedBounds.end() && cached->second.MTime == mTime)
+      return cached->second.Bounds;
+
+    Annotation::Bounds bounds = annotation->GetBoundsOnDisplay(renderer);
+    m_CachedBounds[annotation] = {mTime, bounds};
+    return bounds;
+  }
 }
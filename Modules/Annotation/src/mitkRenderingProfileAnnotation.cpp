@@ -0,0 +1,79 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkRenderingProfileAnnotation.h"
+#include <mitkBaseRenderer.h>
+
+#include <itkCommand.h>
+
+#include <algorithm>
+
+mitk::RenderingProfileAnnotation::RenderingProfileAnnotation()
+{
+  this->SetFontSize(12);
+  this->SetBoolProperty("drawShadow", true);
+  this->SetNumberOfMappers(5);
+}
+
+mitk::RenderingProfileAnnotation::~RenderingProfileAnnotation()
+{
+  for (const auto &profiler : m_Profilers)
+  {
+    profiler.second.first->RemoveObserver(profiler.second.second);
+    profiler.second.first->EnabledOff();
+  }
+}
+
+void mitk::RenderingProfileAnnotation::SetNumberOfMappers(unsigned int numberOfMappers)
+{
+  this->SetIntProperty("profile.numberOfMappers", static_cast<int>(numberOfMappers));
+}
+
+unsigned int mitk::RenderingProfileAnnotation::GetNumberOfMappers() const
+{
+  int numberOfMappers = 5;
+  this->GetIntProperty("profile.numberOfMappers", numberOfMappers);
+  return static_cast<unsigned int>(std::max(0, numberOfMappers));
+}
+
+void mitk::RenderingProfileAnnotation::AddToBaseRenderer(mitk::BaseRenderer *renderer)
+{
+  Superclass::AddToBaseRenderer(renderer);
+  if (!renderer || m_Profilers.find(renderer) != m_Profilers.end())
+    return;
+
+  RenderingProfiler::Pointer profiler = renderer->GetRenderingProfiler();
+  auto command = itk::MemberCommand<RenderingProfileAnnotation>::New();
+  command->SetCallbackFunction(this, &RenderingProfileAnnotation::OnFrameEnded);
+  const unsigned long tag = profiler->AddObserver(itk::EndEvent(), command);
+  profiler->EnabledOn();
+  m_Profilers[renderer] = std::make_pair(profiler, tag);
+}
+
+void mitk::RenderingProfileAnnotation::RemoveFromBaseRenderer(mitk::BaseRenderer *renderer)
+{
+  auto it = m_Profilers.find(renderer);
+  if (it != m_Profilers.end())
+  {
+    it->second.first->RemoveObserver(it->second.second);
+    it->second.first->EnabledOff();
+    m_Profilers.erase(it);
+  }
+  Superclass::RemoveFromBaseRenderer(renderer);
+}
+
+void mitk::RenderingProfileAnnotation::OnFrameEnded(const itk::Object *caller, const itk::EventObject &)
+{
+  const auto *profiler = dynamic_cast<const RenderingProfiler *>(caller);
+  if (profiler)
+    this->SetText(profiler->GetSummary(this->GetNumberOfMappers()));
+}
@@ -3,6 +3,7 @@ file(GLOB_RECURSE H_FILES RELATIVE "${CMAKE_CURRENT_SOURCE_DIR}" "${CMAKE_CURREN
 set(CPP_FILES
   mitkBaseApplication.cpp
   mitkProvisioningInfo.cpp
+  mitkStartupTrace.cpp
   QmitkSafeApplication.cpp
   QmitkSingleApplication.cpp
 )
@@ -49,6 +49,12 @@ namespace mitk
    *  - Set a custom provisioning file to start a specific set of CTK
    *    plug-ins during application start-up.
    *  - Set and get CTK plugin framework properties
+   *  - Record a start-up trace (see StartupTrace) by providing a file
+   *    path with the BlueBerry.startupTrace command line option or the
+   *    MITK_STARTUP_TRACE environment variable. It contains the
+   *    initialization steps, the loading and activation of each
+   *    CppMicroServices module, the time until the workbench window is
+   *    shown and the first render.
    *
    * The behavior can further be customized by deriving from BaseApplication
    * and overriding specific methods, such as:
@@ -93,6 +99,7 @@ namespace mitk
     static const QString ARG_PROVISIONING;
     static const QString ARG_REGISTRY_MULTI_LANGUAGE;
     static const QString ARG_SPLASH_IMAGE;
+    static const QString ARG_STARTUP_TRACE;
     static const QString ARG_STORAGE_DIR;
     static const QString ARG_XARGS;
 
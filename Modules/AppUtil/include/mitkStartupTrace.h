@@ -0,0 +1,94 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkStartupTrace_h
+#define mitkStartupTrace_h
+
+#include <MitkAppUtilExports.h>
+
+#include <string>
+
+namespace mitk
+{
+  /**
+   * Records timed events of the application start-up and writes them as
+   * a Chrome trace (JSON object format), which can be inspected with
+   * chrome://tracing or https://ui.perfetto.dev.
+   *
+   * Recording is disabled until Enable() is called. BaseApplication enables
+   * it if the BlueBerry.startupTrace command line option or the
+   * MITK_STARTUP_TRACE environment variable provides a file path. While it is
+   * disabled, all recording methods return immediately.
+   *
+   * All methods are thread-safe. Time stamps are given in microseconds since
+   * tracing was enabled.
+   */
+  class MITKAPPUTIL_EXPORT StartupTrace
+  {
+  public:
+    /**
+     * Records a complete event covering the lifetime of this object.
+     */
+    class MITKAPPUTIL_EXPORT Scope
+    {
+    public:
+      Scope(const std::string &name, const std::string &category);
+      ~Scope();
+
+    private:
+      Scope(const Scope &) = delete;
+      Scope &operator=(const Scope &) = delete;
+
+      std::string m_Name;
+      std::string m_Category;
+      double m_Begin;
+    };
+
+    /**
+     * Enables recording and sets the file the trace is written to.
+     * Events recorded before are discarded.
+     */
+    static void Enable(const std::string &filePath);
+
+    static bool IsEnabled();
+
+    static std::string GetFilePath();
+
+    /**
+     * Microseconds since tracing was enabled.
+     */
+    static double Now();
+
+    /**
+     * Records an event which began at \c begin and ended now.
+     *
+     * \param args Optional JSON object members, e.g. <code>"\"size\": 3"</code>.
+     */
+    static void AddCompleteEvent(const std::string &name, const std::string &category, double begin, const std::string &args = "");
+    static void AddCompleteEvent(const std::string &name, const std::string &category, double begin, double end, const std::string &args = "");
+
+    static void AddInstantEvent(const std::string &name, const std::string &category, const std::string &args = "");
+
+    /**
+     * Writes all events recorded so far to the trace file, replacing an
+     * existing file.
+     *
+     * \return \c false if tracing is disabled or the file could not be written.
+     */
+    static bool Write();
+
+  private:
+    StartupTrace() = delete;
+  };
+}
+
+#endif
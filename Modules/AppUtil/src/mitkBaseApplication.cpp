@@ -15,6 +15,7 @@ found in the LICENSE file.
 #include <mitkExceptionMacro.h>
 #include <mitkLogMacros.h>
 #include <mitkProvisioningInfo.h>
+#include <mitkStartupTrace.h>
 
 #include <QmitkSafeApplication.h>
 #include <QmitkSingleApplication.h>
@@ -25,18 +26,30 @@ found in the LICENSE file.
 #include <ctkPluginFramework_global.h>
 #include <ctkPluginFrameworkLauncher.h>
 
+#include <usAny.h>
+#include <usGetModuleContext.h>
+#include <usModule.h>
+#include <usModuleContext.h>
+#include <usModuleEvent.h>
 #include <usModuleSettings.h>
 
+#include <vtkMitkLevelWindowShaderMapper.h>
 #include <vtkOpenGLRenderWindow.h>
 #include <QVTKOpenGLWidget.h>
 
 #include <QCoreApplication>
 #include <QDir>
 #include <QFileInfo>
+#include <QMainWindow>
 #include <QRunnable>
 #include <QSplashScreen>
 #include <QStandardPaths>
 #include <QTime>
+#include <QTimer>
+
+#include <map>
+#include <mutex>
+#include <sstream>
 
 namespace
 {
@@ -71,6 +84,54 @@ namespace
         break;
     }
   }
+
+  // Records when the workbench window is shown and when the first render
+  // window is painted. It removes itself afterwards.
+  class StartupTraceEventFilter : public QObject
+  {
+  public:
+    explicit StartupTraceEventFilter(double begin)
+      : m_Begin(begin),
+        m_WindowShown(false),
+        m_Rendered(false)
+    {
+    }
+
+    bool eventFilter(QObject *object, QEvent *event) override
+    {
+      if (!m_WindowShown && QEvent::Show == event->type() && nullptr != qobject_cast<QMainWindow *>(object))
+      {
+        m_WindowShown = true;
+        mitk::StartupTrace::AddCompleteEvent("Starting plug-ins and creating the workbench window", "application", m_Begin);
+      }
+      else if (!m_Rendered && QEvent::Paint == event->type() && nullptr != qobject_cast<QVTKOpenGLWidget *>(object))
+      {
+        m_Rendered = true;
+
+        // The widget is painted after this filter returned, so the event
+        // is completed by the next event loop iteration.
+        auto begin = mitk::StartupTrace::Now();
+        auto args = "\"widget\": \"" + object->objectName().toStdString() + '"';
+
+        QTimer::singleShot(0, [begin, args]() {
+          mitk::StartupTrace::AddCompleteEvent("First render", "ui", begin, args);
+
+          if (mitk::StartupTrace::Write())
+            MITK_INFO << "Wrote start-up trace to " << mitk::StartupTrace::GetFilePath();
+        });
+      }
+
+      if (m_WindowShown && m_Rendered)
+        qApp->removeEventFilter(this);
+
+      return false;
+    }
+
+  private:
+    double m_Begin;
+    bool m_WindowShown;
+    bool m_Rendered;
+  };
 }
 
 namespace mitk
@@ -91,6 +152,7 @@ namespace mitk
   const QString BaseApplication::ARG_PROVISIONING = "BlueBerry.provisioning";
   const QString BaseApplication::ARG_REGISTRY_MULTI_LANGUAGE = "BlueBerry.registryMultiLanguage";
   const QString BaseApplication::ARG_SPLASH_IMAGE = "BlueBerry.splashscreen";
+  const QString BaseApplication::ARG_STARTUP_TRACE = "BlueBerry.startupTrace";
   const QString BaseApplication::ARG_STORAGE_DIR = "BlueBerry.storageDir";
   const QString BaseApplication::ARG_XARGS = "xargs";
 
@@ -145,6 +207,11 @@ namespace mitk
     QStringList m_PreloadLibs;
     QString m_ProvFile;
 
+    StartupTraceEventFilter *m_StartupTraceEventFilter;
+    bool m_ModuleListenerAdded;
+    std::mutex m_ModuleLoadingMutex;
+    std::map<long, double> m_ModuleLoadingBegin;
+
     Impl(int argc, char **argv)
       : m_Argc(argc),
         m_Argv(argv),
@@ -154,7 +221,9 @@ namespace mitk
         m_SingleMode(false),
         m_SafeMode(true),
         m_Splashscreen(nullptr),
-        m_SplashscreenClosingCallback(nullptr)
+        m_SplashscreenClosingCallback(nullptr),
+        m_StartupTraceEventFilter(nullptr),
+        m_ModuleListenerAdded(false)
     {
 #ifdef Q_OS_MAC
       /* On macOS the process serial number is passed as an command line argument (-psn_<NUMBER>)
@@ -179,6 +248,10 @@ namespace mitk
 
     ~Impl()
     {
+      if (m_ModuleListenerAdded)
+        us::GetModuleContext()->RemoveModuleListener(this, &Impl::moduleChanged);
+
+      delete m_StartupTraceEventFilter;
       delete m_SplashscreenClosingCallback;
       delete m_Splashscreen;
       delete m_QApp;
@@ -211,6 +284,61 @@ namespace mitk
       m_PreloadLibs.push_back(QString::fromStdString(value));
     }
 
+    void handleStartupTraceOption(const std::string &, const std::string &value)
+    {
+      this->enableStartupTrace(value);
+    }
+
+    void enableStartupTrace(const std::string &filePath)
+    {
+      StartupTrace::Enable(filePath);
+
+      if (!m_ModuleListenerAdded)
+      {
+        us::GetModuleContext()->AddModuleListener(this, &Impl::moduleChanged);
+        m_ModuleListenerAdded = true;
+      }
+    }
+
+    // Records the loading of a library and the activation of its module,
+    // which may happen in any thread.
+    void moduleChanged(const us::ModuleEvent event)
+    {
+      auto module = event.GetModule();
+
+      if (us::ModuleEvent::LOADING == event.GetType())
+      {
+        auto begin = StartupTrace::Now();
+        std::lock_guard<std::mutex> lock(m_ModuleLoadingMutex);
+        m_ModuleLoadingBegin[module->GetModuleId()] = begin;
+      }
+      else if (us::ModuleEvent::LOADED == event.GetType())
+      {
+        double begin = 0.0;
+
+        {
+          std::lock_guard<std::mutex> lock(m_ModuleLoadingMutex);
+          auto iter = m_ModuleLoadingBegin.find(module->GetModuleId());
+
+          if (m_ModuleLoadingBegin.end() == iter)
+            return;
+
+          begin = iter->second;
+          m_ModuleLoadingBegin.erase(iter);
+        }
+
+        std::ostringstream args;
+        args << "\"location\": \"" << QString::fromStdString(module->GetLocation()).replace('\\', '/').toStdString() << '"';
+
+        auto activationTime = module->GetProperty(us::Module::PROP_ACTIVATION_TIME());
+
+        if (activationTime.Type() == typeid(double))
+          args << ", \"activation_ms\": " << us::any_cast<double>(activationTime);
+
+        StartupTrace::AddCompleteEvent(module->GetName(), "module", begin, args.str());
+      }
+    }
+
     void handleClean(const std::string &, const std::string &)
     {
       m_FWProps[ctkPluginConstants::FRAMEWORK_STORAGE_CLEAN] = ctkPluginConstants::FRAMEWORK_STORAGE_CLEAN_ONFIRSTINIT;
@@ -327,6 +455,10 @@ namespace mitk
     : Application(),
       d(new Impl(argc, argv))
   {
+    auto traceFilePath = qgetenv("MITK_STARTUP_TRACE");
+
+    if (!traceFilePath.isEmpty())
+      d->enableStartupTrace(traceFilePath.toStdString());
   }
 
   BaseApplication::~BaseApplication()
@@ -512,11 +644,16 @@ namespace mitk
 
   void BaseApplication::initialize(Poco::Util::Application &self)
   {
+    StartupTrace::Scope initializeScope("Initializing the application", "application");
+
     // 1. Call the super-class method
     Poco::Util::Application::initialize(self);
 
     // 2. Initialize the Qt framework (by creating a QCoreApplication)
-    this->initializeQt();
+    {
+      StartupTrace::Scope scope("Initializing Qt", "application");
+      this->initializeQt();
+    }
 
     // 3. Seed the random number generator, once at startup.
     QTime time = QTime::currentTime();
@@ -525,16 +662,22 @@ namespace mitk
     // 4. Load the "default" configuration, which involves parsing
     //    an optional <executable-name>.ini file and parsing any
     //    command line arguments
-    this->loadConfiguration();
+    {
+      StartupTrace::Scope scope("Loading the configuration", "application");
+      this->loadConfiguration();
 
-    // 5. Add configuration data from the command line and the
-    //    optional <executable-name>.ini file as CTK plugin
-    //    framework properties.
-    d->initializeCTKPluginFrameworkProperties(this->config());
+      // 5. Add configuration data from the command line and the
+      //    optional <executable-name>.ini file as CTK plugin
+      //    framework properties.
+      d->initializeCTKPluginFrameworkProperties(this->config());
+    }
 
     // 6. Initialize splash screen if an image path is provided
     //    in the .ini file
-    this->initializeSplashScreen(qApp);
+    {
+      StartupTrace::Scope scope("Showing the splash screen", "application");
+      this->initializeSplashScreen(qApp);
+    }
 
     // 7. Set the custom CTK Plugin Framework storage directory
     QString storageDir = this->getCTKFrameworkStorageDir();
@@ -558,7 +701,10 @@ namespace mitk
 
     // 10. Parse the (optional) provisioning file and set the
     //     correct framework properties.
-    d->parseProvisioningFile(this->getProvisioningFilePath());
+    {
+      StartupTrace::Scope scope("Parsing the provisioning file", "application");
+      d->parseProvisioningFile(this->getProvisioningFilePath());
+    }
 
     // 11. Set the CTK Plugin Framework properties
     ctkPluginFrameworkLauncher::setFrameworkProperties(d->m_FWProps);
@@ -566,6 +712,9 @@ namespace mitk
 
   void BaseApplication::uninitialize()
   {
+    if (StartupTrace::IsEnabled() && StartupTrace::Write())
+      MITK_INFO << "Wrote start-up trace to " << StartupTrace::GetFilePath();
+
     auto pfw = this->getFramework();
 
     if (pfw)
@@ -642,6 +791,8 @@ namespace mitk
 #endif
 
       QCoreApplication::setAttribute(Qt::AA_ShareOpenGLContexts);
+      // render windows showing the same image slice can use one uploaded texture
+      vtkMitkLevelWindowShaderMapper::SetShareSliceTextures(true);
 
       d->m_QApp = this->getSingleMode()
         ? static_cast<QCoreApplication*>(new QmitkSingleApplication(d->m_Argc, d->m_Argv, this->getSafeMode()))
@@ -696,6 +847,12 @@ namespace mitk
       d->m_SplashscreenClosingCallback = new SplashCloserCallback(d->m_Splashscreen);
     }
 
+    if (StartupTrace::IsEnabled() && nullptr == d->m_StartupTraceEventFilter)
+    {
+      d->m_StartupTraceEventFilter = new StartupTraceEventFilter(StartupTrace::Now());
+      qApp->installEventFilter(d->m_StartupTraceEventFilter);
+    }
+
     return ctkPluginFrameworkLauncher::run(d->m_SplashscreenClosingCallback, QVariant::fromValue(arguments)).toInt();
   }
 
@@ -763,6 +920,10 @@ namespace mitk
   splashScreenOption.argument("<filename>").binding(ARG_SPLASH_IMAGE.toStdString());
   options.addOption(splashScreenOption);
 
+    Poco::Util::Option startupTraceOption(ARG_STARTUP_TRACE.toStdString(), "", "record the start-up in a Chrome trace file");
+    startupTraceOption.argument("<filename>").callback(Poco::Util::OptionCallback<Impl>(d, &Impl::handleStartupTraceOption));
+    options.addOption(startupTraceOption);
+
     Poco::Util::Option xargsOption(ARG_XARGS.toStdString(), "", "Extended argument list");
     xargsOption.argument("<args>").binding(ARG_XARGS.toStdString());
     options.addOption(xargsOption);
@@ -0,0 +1,250 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkStartupTrace.h>
+
+#include <mitkLogMacros.h>
+
+#include <QCoreApplication>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  struct TraceEvent
+  {
+    std::string Name;
+    std::string Category;
+    char Phase;
+    double Timestamp;
+    double Duration;
+    unsigned int ThreadIndex;
+    std::string Args;
+  };
+
+  struct TraceState
+  {
+    std::atomic<bool> Enabled;
+    std::mutex Mutex;
+    std::chrono::steady_clock::time_point Origin;
+    std::string FilePath;
+    std::vector<TraceEvent> Events;
+    std::map<std::thread::id, unsigned int> ThreadIndices;
+
+    TraceState()
+      : Enabled(false)
+    {
+    }
+
+    // Must be called with the mutex locked
+    unsigned int getThreadIndex()
+    {
+      auto result = ThreadIndices.insert(std::make_pair(std::this_thread::get_id(), static_cast<unsigned int>(ThreadIndices.size())));
+      return result.first->second;
+    }
+
+    void add(const std::string &name, const std::string &category, char phase, double timestamp, double duration, const std::string &args)
+    {
+      std::lock_guard<std::mutex> lock(Mutex);
+      Events.push_back({ name, category, phase, timestamp, duration, this->getThreadIndex(), args });
+    }
+  };
+
+  TraceState &GetTraceState()
+  {
+    static TraceState state;
+    return state;
+  }
+
+  std::string EscapeJson(const std::string &str)
+  {
+    std::string result;
+    result.reserve(str.size());
+
+    for (const auto c : str)
+    {
+      switch (c)
+      {
+        case '"':
+          result += "\\\"";
+          break;
+
+        case '\\':
+          result += "\\\\";
+          break;
+
+        case '\n':
+          result += "\\n";
+          break;
+
+        case '\t':
+          result += "\\t";
+          break;
+
+        default:
+          if (static_cast<unsigned char>(c) < 0x20)
+          {
+            result += ' ';
+          }
+          else
+          {
+            result += c;
+          }
+          break;
+      }
+    }
+
+    return result;
+  }
+}
+
+mitk::StartupTrace::Scope::Scope(const std::string &name, const std::string &category)
+  : m_Name(name),
+    m_Category(category),
+    m_Begin(StartupTrace::Now())
+{
+}
+
+mitk::StartupTrace::Scope::~Scope()
+{
+  StartupTrace::AddCompleteEvent(m_Name, m_Category, m_Begin);
+}
+
+void mitk::StartupTrace::Enable(const std::string &filePath)
+{
+  auto &state = GetTraceState();
+
+  {
+    std::lock_guard<std::mutex> lock(state.Mutex);
+    state.Origin = std::chrono::steady_clock::now();
+    state.FilePath = filePath;
+    state.Events.clear();
+    state.ThreadIndices.clear();
+    state.getThreadIndex(); // The enabling thread is the main thread
+  }
+
+  state.Enabled = true;
+}
+
+bool mitk::StartupTrace::IsEnabled()
+{
+  return GetTraceState().Enabled;
+}
+
+std::string mitk::StartupTrace::GetFilePath()
+{
+  auto &state = GetTraceState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  return state.FilePath;
+}
+
+double mitk::StartupTrace::Now()
+{
+  auto &state = GetTraceState();
+
+  if (!state.Enabled)
+    return 0.0;
+
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - state.Origin).count();
+}
+
+void mitk::StartupTrace::AddCompleteEvent(const std::string &name, const std::string &category, double begin, const std::string &args)
+{
+  AddCompleteEvent(name, category, begin, Now(), args);
+}
+
+void mitk::StartupTrace::AddCompleteEvent(const std::string &name, const std::string &category, double begin, double end, const std::string &args)
+{
+  auto &state = GetTraceState();
+
+  if (!state.Enabled)
+    return;
+
+  state.add(name, category, 'X', begin, std::max(0.0, end - begin), args);
+}
+
+void mitk::StartupTrace::AddInstantEvent(const std::string &name, const std::string &category, const std::string &args)
+{
+  auto &state = GetTraceState();
+
+  if (!state.Enabled)
+    return;
+
+  state.add(name, category, 'i', Now(), 0.0, args);
+}
+
+bool mitk::StartupTrace::Write()
+{
+  auto &state = GetTraceState();
+
+  if (!state.Enabled)
+    return false;
+
+  const auto pid = QCoreApplication::applicationPid();
+
+  std::ostringstream json;
+  json.precision(15);
+  json << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+
+  std::string filePath;
+
+  {
+    std::lock_guard<std::mutex> lock(state.Mutex);
+    filePath = state.FilePath;
+
+    for (const auto &threadIndex : state.ThreadIndices)
+    {
+      json << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": " << pid << ", \"tid\": " << threadIndex.second
+           << ", \"args\": {\"name\": \"" << (0 == threadIndex.second ? "main" : "worker " + std::to_string(threadIndex.second)) << "\"}},\n";
+    }
+
+    for (const auto &event : state.Events)
+    {
+      json << "{\"name\": \"" << EscapeJson(event.Name) << "\", \"cat\": \"" << EscapeJson(event.Category)
+           << "\", \"ph\": \"" << event.Phase << "\", \"ts\": " << event.Timestamp;
+
+      if ('X' == event.Phase)
+        json << ", \"dur\": " << event.Duration;
+      else
+        json << ", \"s\": \"p\"";
+
+      json << ", \"pid\": " << pid << ", \"tid\": " << event.ThreadIndex;
+
+      if (!event.Args.empty())
+        json << ", \"args\": {" << event.Args << '}';
+
+      json << "},\n";
+    }
+  }
+
+  json << "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": " << pid << ", \"tid\": 0, \"args\": {\"name\": \""
+       << EscapeJson(QCoreApplication::applicationName().toStdString()) << "\"}}\n]}\n";
+
+  std::ofstream file(filePath.c_str(), std::ios::out | std::ios::trunc);
+
+  if (!file)
+  {
+    MITK_WARN << "Cannot write the start-up trace to \"" << filePath << "\".";
+    return false;
+  }
+
+  file << json.str();
+  return static_cast<bool>(file);
+}
@@ -15,7 +15,7 @@ found in the LICENSE file.
 #include "mitkCommandLineParser.h"
 #include "mitkIOUtil.h"
 
-#include <mitkArithmeticOperation.h>
+#include <mitkArithmeticExpression.h>
 
 static bool ConvertToBool(std::map<std::string, us::Any> &data, std::string name)
 {
@@ -90,55 +90,60 @@ int main(int argc, char* argv[])
   bool resultAsDouble = ConvertToBool(parsedArgs, "as-double");
   MITK_INFO << "Output image as double: " << resultAsDouble;
 
-  mitk::Image::Pointer tmpImage = image->Clone();
+  // all operations are evaluated in one pass, only the final result is cast to the input type
+  mitk::ArithmeticExpression expression(image.GetPointer());
+  if (!resultAsDouble)
+  {
+    expression.SetOutputComponentType(image->GetPixelType().GetComponentType());
+  }
   if (ConvertToBool(parsedArgs, "image-right"))
   {
     if (ConvertToBool(parsedArgs, "add"))
     {
       MITK_INFO << " Start Doing Operation: ADD()";
-      tmpImage = mitk::ArithmeticOperation::Add(value, tmpImage, resultAsDouble);
+      expression.Add(value);
     }
     if (ConvertToBool(parsedArgs, "subtract"))
     {
       MITK_INFO << " Start Doing Operation: SUB()";
-      tmpImage = mitk::ArithmeticOperation::Subtract(value, tmpImage, resultAsDouble);
+      expression.SubtractFrom(value);
     }
     if (ConvertToBool(parsedArgs, "multiply"))
     {
       MITK_INFO << " Start Doing Operation: MULT()";
-      tmpImage = mitk::ArithmeticOperation::Multiply(value, tmpImage, resultAsDouble);
+      expression.Multiply(value);
     }
     if (ConvertToBool(parsedArgs, "divide"))
     {
       MITK_INFO << " Start Doing Operation: DIV()";
-      tmpImage = mitk::ArithmeticOperation::Divide(value, tmpImage, resultAsDouble);
+      expression.DivideInto(value);
     }
   }
   else {
     if (ConvertToBool(parsedArgs, "add"))
     {
       MITK_INFO << " Start Doing Operation: ADD()";
-      tmpImage = mitk::ArithmeticOperation::Add(tmpImage, value, resultAsDouble);
+      expression.Add(value);
     }
     if (ConvertToBool(parsedArgs, "subtract"))
     {
       MITK_INFO << " Start Doing Operation: SUB()";
-      tmpImage = mitk::ArithmeticOperation::Subtract(tmpImage, value, resultAsDouble);
+      expression.Subtract(value);
     }
     if (ConvertToBool(parsedArgs, "multiply"))
     {
       MITK_INFO << " Start Doing Operation: MULT()";
-      tmpImage = mitk::ArithmeticOperation::Multiply(tmpImage, value, resultAsDouble);
+      expression.Multiply(value);
     }
     if (ConvertToBool(parsedArgs, "divide"))
     {
       MITK_INFO << " Start Doing Operation: DIV()";
-      tmpImage = mitk::ArithmeticOperation::Divide(tmpImage, value, resultAsDouble);
+      expression.Divide(value);
     }
 
   }
 
-  mitk::IOUtil::Save(tmpImage, outputFilename);
+  mitk::IOUtil::Save(expression.Evaluate(), outputFilename);
 
   return EXIT_SUCCESS;
 }
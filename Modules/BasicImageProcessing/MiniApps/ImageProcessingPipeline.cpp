@@ -0,0 +1,211 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkCommandLineParser.h"
+#include "mitkCommandLinePipeline.h"
+
+#include <mitkArithmeticExpression.h>
+#include <mitkException.h>
+
+#include <fstream>
+
+static bool ConvertToBool(const mitk::CommandLinePipeline::Arguments &data, const std::string &name)
+{
+  auto it = data.find(name);
+  if (it == data.end())
+  {
+    return false;
+  }
+  try {
+    return us::any_cast<bool>(it->second);
+  }
+  catch ( const us::BadAnyCastException & )
+  {
+    return false;
+  }
+}
+
+static mitk::ArithmeticExpression CreateExpression(const mitk::Image::Pointer &image, const mitk::CommandLinePipeline::Arguments &arguments)
+{
+  // all operations of a step are evaluated in one pass, only the final result is cast to the input type
+  mitk::ArithmeticExpression expression(image.GetPointer());
+  if (!ConvertToBool(arguments, "as-double"))
+  {
+    expression.SetOutputComponentType(image->GetPixelType().GetComponentType());
+  }
+  return expression;
+}
+
+// The operations have the arguments of the MiniApps of the same name, except for the input and output files.
+static void RegisterOperations()
+{
+  mitk::CommandLinePipeline::RegisterOperation("SingleImageArithmetic", 1,
+    [](mitkCommandLineParser &parser) {
+      parser.addArgument("as-double", "double", mitkCommandLineParser::Bool, "Result as double", "Result as double image type", false, true);
+      parser.addArgument("tan", "tan", mitkCommandLineParser::Bool, "Calculate tan operation", "Calculate tan operation", us::Any(false), true);
+      parser.addArgument("atan", "atan", mitkCommandLineParser::Bool, "Calculate atan operation", "Calculate atan operation", us::Any(false), true);
+      parser.addArgument("cos", "cos", mitkCommandLineParser::Bool, "Calculate cos operation", "Calculate cos operation", us::Any(false), true);
+      parser.addArgument("acos", "acos", mitkCommandLineParser::Bool, "Calculate acos operation", "Calculate acos operation", us::Any(false), true);
+      parser.addArgument("sin", "sin", mitkCommandLineParser::Bool, "Calculate sin operation", "Calculate sin operation", us::Any(false), true);
+      parser.addArgument("asin", "asin", mitkCommandLineParser::Bool, "Calculate asin operation", "Calculate asin operation", us::Any(false), true);
+      parser.addArgument("square", "square", mitkCommandLineParser::Bool, "Calculate square operation", "Calculate square operation", us::Any(false), true);
+      parser.addArgument("sqrt", "sqrt", mitkCommandLineParser::Bool, "Calculate sqrt operation", "Calculate sqrt operation", us::Any(false), true);
+      parser.addArgument("abs", "abs", mitkCommandLineParser::Bool, "Calculate abs operation", "Calculate abs operation", us::Any(false), true);
+      parser.addArgument("exp", "exp", mitkCommandLineParser::Bool, "Calculate exp operation", "Calculate exp operation", us::Any(false), true);
+      parser.addArgument("expneg", "expneg", mitkCommandLineParser::Bool, "Calculate expneg operation", "Calculate expneg operation", us::Any(false), true);
+      parser.addArgument("log10", "log10", mitkCommandLineParser::Bool, "Calculate log10 operation", "Calculate log10 operation", us::Any(false), true);
+    },
+    [](const std::vector<mitk::Image::Pointer> &inputs, const mitk::CommandLinePipeline::Arguments &arguments) {
+      auto expression = CreateExpression(inputs[0], arguments);
+      if (ConvertToBool(arguments, "tan"))
+        expression.Tan();
+      if (ConvertToBool(arguments, "atan"))
+        expression.Atan();
+      if (ConvertToBool(arguments, "cos"))
+        expression.Cos();
+      if (ConvertToBool(arguments, "acos"))
+        expression.Acos();
+      if (ConvertToBool(arguments, "sin"))
+        expression.Sin();
+      if (ConvertToBool(arguments, "asin"))
+        expression.Asin();
+      if (ConvertToBool(arguments, "square"))
+        expression.Square();
+      if (ConvertToBool(arguments, "sqrt"))
+        expression.Sqrt();
+      if (ConvertToBool(arguments, "abs"))
+        expression.Abs();
+      if (ConvertToBool(arguments, "exp"))
+        expression.Exp();
+      if (ConvertToBool(arguments, "expneg"))
+        expression.ExpNeg();
+      if (ConvertToBool(arguments, "log10"))
+        expression.Log10();
+      return expression.Evaluate();
+    });
+
+  mitk::CommandLinePipeline::RegisterOperation("TwoImageArithmetic", 2,
+    [](mitkCommandLineParser &parser) {
+      parser.addArgument("as-double", "double", mitkCommandLineParser::Bool, "Result as double", "Result as double image type", false, true);
+      parser.addArgument("add", "add", mitkCommandLineParser::Bool, "Add Left Image and Right Image", "Add Left Image and Right Image", us::Any(false), true);
+      parser.addArgument("subtract", "sub", mitkCommandLineParser::Bool, "Subtract right image from left image", "Subtract right image from left image", us::Any(false), true);
+      parser.addArgument("multiply", "multi", mitkCommandLineParser::Bool, "Multiply Left Image and Right Image", "Multiply Left Image and Right Image", us::Any(false), true);
+      parser.addArgument("divide", "div", mitkCommandLineParser::Bool, "Divide Left Image by Right Image", "Divide Left Image by Right Image", us::Any(false), true);
+    },
+    [](const std::vector<mitk::Image::Pointer> &inputs, const mitk::CommandLinePipeline::Arguments &arguments) {
+      auto expression = CreateExpression(inputs[0], arguments);
+      if (ConvertToBool(arguments, "add"))
+        expression.Add(inputs[1].GetPointer());
+      if (ConvertToBool(arguments, "subtract"))
+        expression.Subtract(inputs[1].GetPointer());
+      if (ConvertToBool(arguments, "multiply"))
+        expression.Multiply(inputs[1].GetPointer());
+      if (ConvertToBool(arguments, "divide"))
+        expression.Divide(inputs[1].GetPointer());
+      return expression.Evaluate();
+    });
+
+  mitk::CommandLinePipeline::RegisterOperation("ImageAndValueArithmetic", 1,
+    [](mitkCommandLineParser &parser) {
+      parser.addArgument("value", "v", mitkCommandLineParser::Float, "Input Value:", "Input Value", us::Any(), false);
+      parser.addArgument("as-double", "double", mitkCommandLineParser::Bool, "Result as double", "Result as double image type", false, true);
+      parser.addArgument("image-right", "right", mitkCommandLineParser::Bool, "Image right (for example Value - Image)", "Image right (for example Value - Image)", false, true);
+      parser.addArgument("add", "add", mitkCommandLineParser::Bool, "Add Left Image and Right Image", "Add Left Image and Right Image", us::Any(false), true);
+      parser.addArgument("subtract", "sub", mitkCommandLineParser::Bool, "Subtract right image from left image", "Subtract right image from left image", us::Any(false), true);
+      parser.addArgument("multiply", "multi", mitkCommandLineParser::Bool, "Multiply Left Image and Right Image", "Multiply Left Image and Right Image", us::Any(false), true);
+      parser.addArgument("divide", "div", mitkCommandLineParser::Bool, "Divide Left Image by Right Image", "Divide Left Image by Right Image", us::Any(false), true);
+    },
+    [](const std::vector<mitk::Image::Pointer> &inputs, const mitk::CommandLinePipeline::Arguments &arguments) {
+      auto valueArgument = arguments.find("value");
+      if (valueArgument == arguments.end())
+      {
+        mitkThrow() << "ImageAndValueArithmetic requires the argument --value.";
+      }
+      const double value = us::any_cast<float>(valueArgument->second);
+      const bool imageRight = ConvertToBool(arguments, "image-right");
+
+      auto expression = CreateExpression(inputs[0], arguments);
+      if (ConvertToBool(arguments, "add"))
+        expression.Add(value);
+      if (ConvertToBool(arguments, "subtract"))
+        imageRight ? expression.SubtractFrom(value) : expression.Subtract(value);
+      if (ConvertToBool(arguments, "multiply"))
+        expression.Multiply(value);
+      if (ConvertToBool(arguments, "divide"))
+        imageRight ? expression.DivideInto(value) : expression.Divide(value);
+      return expression.Evaluate();
+    });
+}
+
+int main(int argc, char* argv[])
+{
+  RegisterOperations();
+
+  mitkCommandLineParser parser;
+
+  parser.setTitle("Image Processing Pipeline");
+  parser.setCategory("Basic Image Processing");
+  parser.setDescription("Runs several Basic Image Processing operations in one process. Intermediate images are passed in memory and independent steps run in parallel. See mitk::CommandLinePipeline for the format of the pipeline file.");
+  parser.setContributor("German Cancer Research Center (DKFZ)");
+
+  parser.setArgumentPrefix("--","-");
+  // Add command line argument names
+  parser.addArgument("help", "h",mitkCommandLineParser::Bool, "Help:", "Show this help text");
+  parser.addArgument("pipeline", "p", mitkCommandLineParser::File, "Pipeline file:", "Description of the pipeline", us::Any(), false, false, false, mitkCommandLineParser::Input);
+  parser.addArgument("operations", "ops", mitkCommandLineParser::Bool, "List operations", "Show the available operations and their arguments", us::Any(false), true);
+
+  std::map<std::string, us::Any> parsedArgs = parser.parseArguments(argc, argv);
+
+  // Show a help message
+  if ( parsedArgs.count("help") || parsedArgs.count("h"))
+  {
+    std::cout << parser.helpText();
+    return EXIT_SUCCESS;
+  }
+
+  if (ConvertToBool(parsedArgs, "operations"))
+  {
+    for (const auto &operation : mitk::CommandLinePipeline::GetRegisteredOperations())
+    {
+      std::cout << operation << std::endl << mitk::CommandLinePipeline::GetOperationHelpText(operation) << std::endl;
+    }
+    return EXIT_SUCCESS;
+  }
+
+  if (parsedArgs.count("pipeline") == 0)
+  {
+    std::cout << parser.helpText();
+    return EXIT_FAILURE;
+  }
+
+  std::string pipelineFilename = us::any_cast<std::string>(parsedArgs["pipeline"]);
+  std::ifstream pipelineFile(pipelineFilename);
+  if (!pipelineFile)
+  {
+    MITK_ERROR << "Cannot open pipeline file " << pipelineFilename;
+    return EXIT_FAILURE;
+  }
+
+  try
+  {
+    mitk::CommandLinePipeline pipeline;
+    pipeline.Parse(pipelineFile);
+    pipeline.Execute();
+  }
+  catch (const std::exception &e)
+  {
+    MITK_ERROR << e.what();
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
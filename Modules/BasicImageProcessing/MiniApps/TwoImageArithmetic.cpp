@@ -15,7 +15,7 @@ found in the LICENSE file.
 #include "mitkCommandLineParser.h"
 #include "mitkIOUtil.h"
 
-#include <mitkArithmeticOperation.h>
+#include <mitkArithmeticExpression.h>
 
 static bool ConvertToBool(std::map<std::string, us::Any> &data, std::string name)
 {
@@ -101,30 +101,35 @@ int main(int argc, char* argv[])
   bool resultAsDouble = ConvertToBool(parsedArgs, "as-double");
   MITK_INFO << "Output image as double: " << resultAsDouble;
 
-  mitk::Image::Pointer tmpImage = image1->Clone();
+  // all operations are evaluated in one pass, only the final result is cast to the input type
+  mitk::ArithmeticExpression expression(image1.GetPointer());
+  if (!resultAsDouble)
+  {
+    expression.SetOutputComponentType(image1->GetPixelType().GetComponentType());
+  }
 
   if (ConvertToBool(parsedArgs, "add"))
   {
     MITK_INFO << " Start Doing Operation: ADD()";
-    tmpImage = mitk::ArithmeticOperation::Add(tmpImage, image2, resultAsDouble);
+    expression.Add(image2.GetPointer());
   }
   if (ConvertToBool(parsedArgs, "subtract"))
   {
     MITK_INFO << " Start Doing Operation: SUB()";
-    tmpImage = mitk::ArithmeticOperation::Subtract(tmpImage, image2, resultAsDouble);
+    expression.Subtract(image2.GetPointer());
   }
   if (ConvertToBool(parsedArgs, "multiply"))
   {
     MITK_INFO << " Start Doing Operation: MULT()";
-    tmpImage = mitk::ArithmeticOperation::Multiply(tmpImage, image2, resultAsDouble);
+    expression.Multiply(image2.GetPointer());
   }
   if (ConvertToBool(parsedArgs, "divide"))
   {
     MITK_INFO << " Start Doing Operation: DIV()";
-    tmpImage = mitk::ArithmeticOperation::Divide(tmpImage, image2, resultAsDouble);
+    expression.Divide(image2.GetPointer());
   }
 
-  mitk::IOUtil::Save(tmpImage, outputFilename);
+  mitk::IOUtil::Save(expression.Evaluate(), outputFilename);
 
   return EXIT_SUCCESS;
 }
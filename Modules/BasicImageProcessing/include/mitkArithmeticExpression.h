@@ -0,0 +1,160 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkArithmeticExpression_h
+#define mitkArithmeticExpression_h
+
+#include <mitkImage.h>
+#include <MitkBasicImageProcessingExports.h>
+
+#include <vector>
+
+namespace mitk
+{
+  /** \brief Evaluates a chain of voxel-wise operations on an image in a single pass
+  *
+  * In contrast to ArithmeticOperation, which creates an image per operation, the operations are
+  * recorded first and evaluated together by Evaluate(): every block of voxels is read from the
+  * input, passed through all operations in double precision and written to the output, so no
+  * intermediate images are created. The blocks are processed in parallel by mitk::ThreadPool.
+  *
+  * The images are processed volume by volume (time step by time step). Input volumes that are
+  * produced on demand by an ImageVolumeProvider are therefore only requested when they are
+  * processed, and with SetOutputStorageMode(ImageDataItem::MappedFileStorage) the output is
+  * backed by a temporary file, so images larger than the memory can be processed.
+  *
+  * Only scalar images are supported. All images used as operands must have the same dimensions
+  * and number of time steps as the input; their geometry is not checked.
+  *
+  * \code
+  * auto result = mitk::ArithmeticExpression(image).Subtract(mean).Divide(stdDev).Clamp(-3, 3).Evaluate();
+  * \endcode
+  */
+  class MITKBASICIMAGEPROCESSING_EXPORT ArithmeticExpression
+  {
+  public:
+    explicit ArithmeticExpression(Image::ConstPointer input);
+
+    ArithmeticExpression &Add(double value);
+    ArithmeticExpression &Subtract(double value);
+    ArithmeticExpression &Multiply(double value);
+    ArithmeticExpression &Divide(double value);
+    ArithmeticExpression &Pow(double exponent);
+
+    /** \brief Operations with the value as left operand, i.e. value - x, value / x and value ^ x. */
+    ArithmeticExpression &SubtractFrom(double value);
+    ArithmeticExpression &DivideInto(double value);
+    ArithmeticExpression &PowOf(double base);
+
+    /** \brief Voxel-wise operations with a second image, which is read while evaluating. */
+    ArithmeticExpression &Add(Image::ConstPointer image);
+    ArithmeticExpression &Subtract(Image::ConstPointer image);
+    ArithmeticExpression &Multiply(Image::ConstPointer image);
+    ArithmeticExpression &Divide(Image::ConstPointer image);
+
+    ArithmeticExpression &Tan();
+    ArithmeticExpression &Atan();
+    ArithmeticExpression &Cos();
+    ArithmeticExpression &Acos();
+    ArithmeticExpression &Sin();
+    ArithmeticExpression &Asin();
+    ArithmeticExpression &Square();
+    ArithmeticExpression &Sqrt();
+    ArithmeticExpression &Abs();
+    ArithmeticExpression &Exp();
+    ArithmeticExpression &ExpNeg();
+    ArithmeticExpression &Log10();
+    ArithmeticExpression &Round();
+
+    /** \brief Replaces values inside of [lower, upper] by insideValue and all other values by outsideValue. */
+    ArithmeticExpression &Threshold(double lower, double upper, double insideValue = 1.0, double outsideValue = 0.0);
+
+    /** \brief Limits the values to [lower, upper]. */
+    ArithmeticExpression &Clamp(double lower, double upper);
+
+    /** \brief Sets the pixel type of the result, an itk::ImageIOBase::IOComponentType.
+    *
+    * Values are clamped to the range of the type; integral types are rounded. Only the final
+    * value is cast, all operations are evaluated in double precision. Default is double.
+    */
+    void SetOutputComponentType(int componentType);
+    int GetOutputComponentType() const;
+
+    /** \brief Sets the storage mode of the result volumes. Default is ImageDataItem::HeapStorage. */
+    void SetOutputStorageMode(ImageDataItem::StorageMode storageMode);
+    ImageDataItem::StorageMode GetOutputStorageMode() const;
+
+    /** \brief Number of voxels that are processed together by one task (default 32768). */
+    void SetBlockSize(std::size_t blockSize);
+    std::size_t GetBlockSize() const;
+
+    /** \brief Evaluates all operations and returns the result.
+    *
+    * \throws mitk::Exception if an image is not a scalar image or has other dimensions than the input.
+    */
+    Image::Pointer Evaluate() const;
+
+  private:
+    enum class OperationType
+    {
+      AddValue,
+      SubtractValue,
+      SubtractFromValue,
+      MultiplyValue,
+      DivideValue,
+      DivideIntoValue,
+      PowValue,
+      PowOfValue,
+      AddImage,
+      SubtractImage,
+      MultiplyImage,
+      DivideImage,
+      Tan,
+      Atan,
+      Cos,
+      Acos,
+      Sin,
+      Asin,
+      Square,
+      Sqrt,
+      Abs,
+      Exp,
+      ExpNeg,
+      Log10,
+      Round,
+      Threshold,
+      Clamp
+    };
+
+    struct Operation
+    {
+      OperationType Type;
+      double Values[4];
+      /** Index into m_Operands for the image operations */
+      std::size_t Operand;
+    };
+
+    ArithmeticExpression &AddOperation(OperationType type, double value0 = 0.0, double value1 = 0.0,
+                                       double value2 = 0.0, double value3 = 0.0);
+    ArithmeticExpression &AddImageOperation(OperationType type, Image::ConstPointer image);
+
+    static void ApplyOperation(const Operation &operation, double *values, const double *operand, std::size_t count);
+
+    Image::ConstPointer m_Input;
+    std::vector<Image::ConstPointer> m_Operands;
+    std::vector<Operation> m_Operations;
+    int m_OutputComponentType;
+    ImageDataItem::StorageMode m_OutputStorageMode;
+    std::size_t m_BlockSize;
+  };
+}
+#endif // mitkArithmeticExpression_h
@@ -0,0 +1,571 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkArithmeticExpression.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkThreadPool.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+
+namespace
+{
+  typedef void (*ReadBlockFunction)(const void *data, std::size_t offset, std::size_t count, double *values);
+  typedef void (*WriteBlockFunction)(const double *values, std::size_t count, void *data, std::size_t offset);
+
+  template <typename TPixel>
+  void ReadBlock(const void *data, std::size_t offset, std::size_t count, double *values)
+  {
+    const auto *pixels = static_cast<const TPixel *>(data) + offset;
+    for (std::size_t i = 0; i < count; ++i)
+      values[i] = static_cast<double>(pixels[i]);
+  }
+
+  template <typename TPixel>
+  void WriteBlock(const double *values, std::size_t count, void *data, std::size_t offset)
+  {
+    auto *pixels = static_cast<TPixel *>(data) + offset;
+    if (std::numeric_limits<TPixel>::is_integer)
+    {
+      const double lowest = static_cast<double>(std::numeric_limits<TPixel>::lowest());
+      const double highest = static_cast<double>(std::numeric_limits<TPixel>::max());
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        // NaN is mapped to 0, everything else is rounded and clamped to the range of the type
+        const double value = std::isnan(values[i]) ? 0.0 : std::round(values[i]);
+        pixels[i] = static_cast<TPixel>(std::min(std::max(value, lowest), highest));
+      }
+    }
+    else
+    {
+      const double lowest = static_cast<double>(std::numeric_limits<TPixel>::lowest());
+      const double highest = static_cast<double>(std::numeric_limits<TPixel>::max());
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        const double value = values[i];
+        pixels[i] = std::isfinite(value) ? static_cast<TPixel>(std::min(std::max(value, lowest), highest))
+                                         : static_cast<TPixel>(value);
+      }
+    }
+  }
+
+  struct PixelAccess
+  {
+    ReadBlockFunction Read = nullptr;
+    WriteBlockFunction Write = nullptr;
+  };
+
+  template <typename TPixel>
+  PixelAccess MakePixelAccess()
+  {
+    PixelAccess access;
+    access.Read = &ReadBlock<TPixel>;
+    access.Write = &WriteBlock<TPixel>;
+    return access;
+  }
+
+  PixelAccess GetPixelAccess(int componentType)
+  {
+    switch (componentType)
+    {
+      case itk::ImageIOBase::UCHAR:
+        return MakePixelAccess<unsigned char>();
+      case itk::ImageIOBase::CHAR:
+        return MakePixelAccess<char>();
+      case itk::ImageIOBase::USHORT:
+        return MakePixelAccess<unsigned short>();
+      case itk::ImageIOBase::SHORT:
+        return MakePixelAccess<short>();
+      case itk::ImageIOBase::UINT:
+        return MakePixelAccess<unsigned int>();
+      case itk::ImageIOBase::INT:
+        return MakePixelAccess<int>();
+      case itk::ImageIOBase::ULONG:
+        return MakePixelAccess<unsigned long>();
+      case itk::ImageIOBase::LONG:
+        return MakePixelAccess<long>();
+      case itk::ImageIOBase::FLOAT:
+        return MakePixelAccess<float>();
+      case itk::ImageIOBase::DOUBLE:
+        return MakePixelAccess<double>();
+      default:
+        return PixelAccess();
+    }
+  }
+
+  mitk::PixelType MakeOutputPixelType(int componentType)
+  {
+    switch (componentType)
+    {
+      case itk::ImageIOBase::UCHAR:
+        return mitk::MakeScalarPixelType<unsigned char>();
+      case itk::ImageIOBase::CHAR:
+        return mitk::MakeScalarPixelType<char>();
+      case itk::ImageIOBase::USHORT:
+        return mitk::MakeScalarPixelType<unsigned short>();
+      case itk::ImageIOBase::SHORT:
+        return mitk::MakeScalarPixelType<short>();
+      case itk::ImageIOBase::UINT:
+        return mitk::MakeScalarPixelType<unsigned int>();
+      case itk::ImageIOBase::INT:
+        return mitk::MakeScalarPixelType<int>();
+      case itk::ImageIOBase::ULONG:
+        return mitk::MakeScalarPixelType<unsigned long>();
+      case itk::ImageIOBase::LONG:
+        return mitk::MakeScalarPixelType<long>();
+      case itk::ImageIOBase::FLOAT:
+        return mitk::MakeScalarPixelType<float>();
+      case itk::ImageIOBase::DOUBLE:
+        return mitk::MakeScalarPixelType<double>();
+      default:
+        mitkThrow() << "Unsupported output component type " << componentType << ".";
+    }
+  }
+
+  /** Returns the reader of the scalar image, throws if the image cannot be read or does not match the input */
+  ReadBlockFunction GetReader(const mitk::Image *image, const mitk::Image *input)
+  {
+    if (nullptr == image || !image->IsInitialized())
+      mitkThrow() << "Image is not initialized.";
+
+    if (image->GetPixelType().GetNumberOfComponents() != 1)
+      mitkThrow() << "Only scalar images are supported, image has pixel type "
+                  << image->GetPixelType().GetPixelTypeAsString() << ".";
+
+    if (image->GetDimension() > 4)
+      mitkThrow() << "Only images with up to four dimensions are supported.";
+
+    if (image != input)
+    {
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        const unsigned int imageSize = i < image->GetDimension() ? image->GetDimension(i) : 1;
+        const unsigned int inputSize = i < input->GetDimension() ? input->GetDimension(i) : 1;
+        if (imageSize != inputSize)
+          mitkThrow() << "Operand image does not have the dimensions of the input image.";
+      }
+      if (image->GetTimeSteps() < input->GetTimeSteps())
+        mitkThrow() << "Operand image has less time steps than the input image.";
+    }
+
+    auto reader = GetPixelAccess(image->GetPixelType().GetComponentType()).Read;
+    if (nullptr == reader)
+      mitkThrow() << "Unsupported pixel type " << image->GetPixelType().GetComponentTypeAsString() << ".";
+    return reader;
+  }
+}
+
+mitk::ArithmeticExpression::ArithmeticExpression(Image::ConstPointer input)
+  : m_Input(input),
+    m_OutputComponentType(itk::ImageIOBase::DOUBLE),
+    m_OutputStorageMode(ImageDataItem::HeapStorage),
+    m_BlockSize(32768)
+{
+}
+
+mitk::ArithmeticExpression &mitk::ArithmeticExpression::AddOperation(
+  OperationType type, double value0, double value1, double value2, double value3)
+{
+  Operation operation;
+  operation.Type = type;
+  operation.Values[0] = value0;
+  operation.Values[1] = value1;
+  operation.Values[2] = value2;
+  operation.Values[3] = value3;
+  operation.Operand = 0;
+  m_Operations.push_back(operation);
+  return *this;
+}
+
+mitk::ArithmeticExpression &mitk::ArithmeticExpression::AddImageOperation(OperationType type,
+                                                                          Image::ConstPointer image)
+{
+  this->AddOperation(type);
+  m_Operations.back().Operand = m_Operands.size();
+  m_Operands.push_back(image);
+  return *this;
+}
+
+mitk::ArithmeticExpression &mitk::ArithmeticExpression::Add(double value)
+{
+  return this->AddOperation(OperationType::AddValue, value);
+}
+
+mitk::ArithmeticExpression &mitk::ArithmeticExpression::Subtract(double value)
+{
+  return this->AddOperation(OperationType::SubtractValue, value);
+}
+
+mitk::ArithmeticExpression &mitk::ArithmeticExpression::Multiply(double value)
+{
+  return this->AddOperation(OperationType::MultiplyValue, value);
+}
+
+mitk::ArithmeticExpression &mitk::ArithmeticExpression::Divide(double value)
+{
+  return this->AddOperation(OperationType::DivideValue, value);
+}
+
+mitk::ArithmeticExpression &mitk::ArithmeticExpression::Pow(double exponent)
+{
+  return this->AddOperation(OperationType::PowValue, exponent);
+}
+
+mitk::ArithmeticExpression &mitk::ArithmeticExpression::SubtractFrom(double value)
+{
+  return this->AddOperation(OperationType::SubtractFromValue, value);
+}
+
+mitk::ArithmeticExpression &mitk::ArithmeticExpression::DivideInto(double value)
+{
+  return this->AddOperation(OperationType::DivideIntoValue, value);
+}
+
+mitk::ArithmeticExpression &mitk::ArithmeticExpression::PowOf(double base)
+{
+  return this->AddOperation(OperationType::PowOfValue, base);
+}
+
+mitk::ArithmeticExpression &mitk::ArithmeticExpression::Add(Image::ConstPointer image)
+{
+  return this->AddImageOperation(OperationType::AddImage, image);
+}
+
+mitk::ArithmeticExpression &mitk::ArithmeticExpression::Subtract(Image::ConstPointer image)
+{
+  return this->AddImageOperation(OperationType::SubtractImage, image);
+}
+
+mitk::ArithmeticExpression &mitk::ArithmeticExpression::Multiply(Image::ConstPointer image)
+{
+  return this->AddImageOperation(OperationType::MultiplyImage, image);
+}
+
+mitk::ArithmeticExpression &mitk::ArithmeticExpression::Divide(Image::ConstPointer image)
+{
+  return this->AddImageOperation(OperationType::DivideImage, image);
+}
+
+mitk::ArithmeticExpression &mitk::ArithmeticExpression::Tan()
+{
+  return this->AddOperation(OperationType::Tan);
+}
+
+mitk::ArithmeticExpression &mitk::ArithmeticExpression::Atan()
+{
+  return this->AddOperation(OperationType::Atan);
+}
+
+mitk::ArithmeticExpression &mitk::ArithmeticExpression::Cos()
+{
+  return this->AddOperation(OperationType::Cos);
+}
+
+mitk::ArithmeticExpression &mitk::ArithmeticExpression::Acos()
+{
+  return this->AddOperation(OperationType::Acos);
+}
+
+mitk::ArithmeticExpression &mitk::ArithmeticExpression::Sin()
+{
+  return this->AddOperation(OperationType::Sin);
+}
+
+mitk::ArithmeticExpression &mitk::ArithmeticExpression::Asin()
+{
+  return this->AddOperation(OperationType::Asin);
+}
+
+mitk::ArithmeticExpression &mitk::ArithmeticExpression::Square()
+{
+  return this->AddOperation(OperationType::Square);
+}
+
+mitk::ArithmeticExpression &mitk::ArithmeticExpression::Sqrt()
+{
+  return this->AddOperation(OperationType::Sqrt);
+}
+
+mitk::ArithmeticExpression &mitk::ArithmeticExpression::Abs()
+{
+  return this->AddOperation(OperationType::Abs);
+}
+
+mitk::ArithmeticExpression &mitk::ArithmeticExpression::Exp()
+{
+  return this->AddOperation(OperationType::Exp);
+}
+
+mitk::ArithmeticExpression &mitk::ArithmeticExpression::ExpNeg()
+{
+  return this->AddOperation(OperationType::ExpNeg);
+}
+
+mitk::ArithmeticExpression &mitk::ArithmeticExpression::Log10()
+{
+  return this->AddOperation(OperationType::Log10);
+}
+
+mitk::ArithmeticExpression &mitk::ArithmeticExpression::Round()
+{
+  return this->AddOperation(OperationType::Round);
+}
+
+mitk::ArithmeticExpression &mitk::ArithmeticExpression::Threshold(double lower,
+                                                                  double upper,
+                                                                  double insideValue,
+                                                                  double outsideValue)
+{
+  return this->AddOperation(OperationType::Threshold, lower, upper, insideValue, outsideValue);
+}
+
+mitk::ArithmeticExpression &mitk::ArithmeticExpression::Clamp(double lower, double upper)
+{
+  return this->AddOperation(OperationType::Clamp, lower, upper);
+}
+
+void mitk::ArithmeticExpression::SetOutputComponentType(int componentType)
+{
+  if (nullptr == GetPixelAccess(componentType).Write)
+    mitkThrow() << "Unsupported output component type " << componentType << ".";
+
+  m_OutputComponentType = componentType;
+}
+
+int mitk::ArithmeticExpression::GetOutputComponentType() const
+{
+  return m_OutputComponentType;
+}
+
+void mitk::ArithmeticExpression::SetOutputStorageMode(ImageDataItem::StorageMode storageMode)
+{
+  m_OutputStorageMode = storageMode;
+}
+
+mitk::ImageDataItem::StorageMode mitk::ArithmeticExpression::GetOutputStorageMode() const
+{
+  return m_OutputStorageMode;
+}
+
+void mitk::ArithmeticExpression::SetBlockSize(std::size_t blockSize)
+{
+  m_BlockSize = std::max<std::size_t>(blockSize, 1);
+}
+
+std::size_t mitk::ArithmeticExpression::GetBlockSize() const
+{
+  return m_BlockSize;
+}
+
+void mitk::ArithmeticExpression::ApplyOperation(const Operation &operation,
+                                                double *values,
+                                                const double *operand,
+                                                std::size_t count)
+{
+  const double value = operation.Values[0];
+
+  switch (operation.Type)
+  {
+    case OperationType::AddValue:
+      for (std::size_t i = 0; i < count; ++i)
+        values[i] += value;
+      break;
+    case OperationType::SubtractValue:
+      for (std::size_t i = 0; i < count; ++i)
+        values[i] -= value;
+      break;
+    case OperationType::SubtractFromValue:
+      for (std::size_t i = 0; i < count; ++i)
+        values[i] = value - values[i];
+      break;
+    case OperationType::MultiplyValue:
+      for (std::size_t i = 0; i < count; ++i)
+        values[i] *= value;
+      break;
+    case OperationType::DivideValue:
+      for (std::size_t i = 0; i < count; ++i)
+        values[i] /= value;
+      break;
+    case OperationType::DivideIntoValue:
+      for (std::size_t i = 0; i < count; ++i)
+        values[i] = value / values[i];
+      break;
+    case OperationType::PowValue:
+      for (std::size_t i = 0; i < count; ++i)
+        values[i] = std::pow(values[i], value);
+      break;
+    case OperationType::PowOfValue:
+      for (std::size_t i = 0; i < count; ++i)
+        values[i] = std::pow(value, values[i]);
+      break;
+    case OperationType::AddImage:
+      for (std::size_t i = 0; i < count; ++i)
+        values[i] += operand[i];
+      break;
+    case OperationType::SubtractImage:
+      for (std::size_t i = 0; i < count; ++i)
+        values[i] -= operand[i];
+      break;
+    case OperationType::MultiplyImage:
+      for (std::size_t i = 0; i < count; ++i)
+        values[i] *= operand[i];
+      break;
+    case OperationType::DivideImage:
+      for (std::size_t i = 0; i < count; ++i)
+        values[i] /= operand[i];
+      break;
+    case OperationType::Tan:
+      for (std::size_t i = 0; i < count; ++i)
+        values[i] = std::tan(values[i]);
+      break;
+    case OperationType::Atan:
+      for (std::size_t i = 0; i < count; ++i)
+        values[i] = std::atan(values[i]);
+      break;
+    case OperationType::Cos:
+      for (std::size_t i = 0; i < count; ++i)
+        values[i] = std::cos(values[i]);
+      break;
+    case OperationType::Acos:
+      for (std::size_t i = 0; i < count; ++i)
+        values[i] = std::acos(values[i]);
+      break;
+    case OperationType::Sin:
+      for (std::size_t i = 0; i < count; ++i)
+        values[i] = std::sin(values[i]);
+      break;
+    case OperationType::Asin:
+      for (std::size_t i = 0; i < count; ++i)
+        values[i] = std::asin(values[i]);
+      break;
+    case OperationType::Square:
+      for (std::size_t i = 0; i < count; ++i)
+        values[i] *= values[i];
+      break;
+    case OperationType::Sqrt:
+      for (std::size_t i = 0; i < count; ++i)
+        values[i] = std::sqrt(values[i]);
+      break;
+    case OperationType::Abs:
+      for (std::size_t i = 0; i < count; ++i)
+        values[i] = std::abs(values[i]);
+      break;
+    case OperationType::Exp:
+      for (std::size_t i = 0; i < count; ++i)
+        values[i] = std::exp(values[i]);
+      break;
+    case OperationType::ExpNeg:
+      for (std::size_t i = 0; i < count; ++i)
+        values[i] = std::exp(-values[i]);
+      break;
+    case OperationType::Log10:
+      for (std::size_t i = 0; i < count; ++i)
+        values[i] = std::log10(values[i]);
+      break;
+    case OperationType::Round:
+      for (std::size_t i = 0; i < count; ++i)
+        values[i] = std::round(values[i]);
+      break;
+    case OperationType::Threshold:
+    {
+      const double upper = operation.Values[1];
+      const double insideValue = operation.Values[2];
+      const double outsideValue = operation.Values[3];
+      for (std::size_t i = 0; i < count; ++i)
+        values[i] = (values[i] >= value && values[i] <= upper) ? insideValue : outsideValue;
+      break;
+    }
+    case OperationType::Clamp:
+    {
+      const double upper = operation.Values[1];
+      for (std::size_t i = 0; i < count; ++i)
+        values[i] = std::min(std::max(values[i], value), upper);
+      break;
+    }
+  }
+}
+
+mitk::Image::Pointer mitk::ArithmeticExpression::Evaluate() const
+{
+  if (m_Input.IsNull())
+    mitkThrow() << "Input image is not set.";
+
+  const auto inputReader = GetReader(m_Input, m_Input);
+  std::vector<ReadBlockFunction> operandReaders;
+  for (const auto &operand : m_Operands)
+  {
+    operandReaders.push_back(GetReader(operand, m_Input));
+  }
+  const auto writer = GetPixelAccess(m_OutputComponentType).Write;
+
+  auto output = Image::New();
+  output->SetStorageMode(m_OutputStorageMode);
+  output->Initialize(MakeOutputPixelType(m_OutputComponentType), m_Input->GetDimension(), m_Input->GetDimensions());
+  output->SetTimeGeometry(m_Input->GetTimeGeometry()->Clone());
+
+  std::size_t numberOfVoxels = 1;
+  for (unsigned int i = 0; i < std::min(m_Input->GetDimension(), 3u); ++i)
+  {
+    numberOfVoxels *= m_Input->GetDimension(i);
+  }
+  const std::size_t blockSize = m_BlockSize;
+  const std::size_t numberOfBlocks = (numberOfVoxels + blockSize - 1) / blockSize;
+
+  for (unsigned int t = 0; t < m_Input->GetTimeSteps(); ++t)
+  {
+    // accessors are requested per time step, so that only the volumes of one time step are needed at once
+    ImageReadAccessor inputAccessor(m_Input, m_Input->GetVolumeData(t));
+    std::vector<std::unique_ptr<ImageReadAccessor>> operandAccessors;
+    std::vector<const void *> operandData;
+    for (const auto &operand : m_Operands)
+    {
+      operandAccessors.push_back(std::make_unique<ImageReadAccessor>(operand, operand->GetVolumeData(t)));
+      operandData.push_back(operandAccessors.back()->GetData());
+    }
+    ImageWriteAccessor outputAccessor(output, output->GetVolumeData(t));
+
+    const void *inputData = inputAccessor.GetData();
+    void *outputData = outputAccessor.GetData();
+
+    ThreadPool::GetInstance().ParallelFor(0, numberOfBlocks, [&](std::size_t beginBlock, std::size_t endBlock) {
+      std::vector<double> values(blockSize);
+      std::vector<double> operandValues(m_Operands.empty() ? 0 : blockSize);
+
+      for (std::size_t block = beginBlock; block < endBlock; ++block)
+      {
+        const std::size_t offset = block * blockSize;
+        const std::size_t count = std::min(blockSize, numberOfVoxels - offset);
+
+        inputReader(inputData, offset, count, values.data());
+        for (const auto &operation : m_Operations)
+        {
+          const double *operand = nullptr;
+          if (operation.Type == OperationType::AddImage || operation.Type == OperationType::SubtractImage ||
+              operation.Type == OperationType::MultiplyImage || operation.Type == OperationType::DivideImage)
+          {
+            operandReaders[operation.Operand](operandData[operation.Operand], offset, count, operandValues.data());
+            operand = operandValues.data();
+          }
+          ApplyOperation(operation, values.data(), operand, count);
+        }
+        writer(values.data(), count, outputData, offset);
+      }
+    });
+  }
+
+  return output;
+}
@@ -31,6 +31,14 @@ namespace mitk
    * dividing by a linear interpolation between the two.
    * The M0 images themselves will be removed from the result.
    * The output image will have the same 3D geometry as the input image, a time geometry only consisting of non M0 images and a double pixel type.
+   *
+   * If ComputeAsymmetry is on, the filter additionally computes the MTR asymmetry map
+   * Z(-offset) - Z(+offset) of the normalized spectrum for every positive offset which has a negative counterpart.
+   * It is provided as second output (GetAsymmetryOutput()) with one timestep per positive offset; its offsets property
+   * lists these offsets. The asymmetry is computed in the same pass as the normalization.
+   *
+   * The voxels are processed block-wise in parallel by mitk::ThreadPool. Each block reads all offsets of its voxels
+   * once and writes the normalized spectra and asymmetries of these voxels.
    */
   class MITKCEST_EXPORT CESTImageNormalizationFilter : public ImageToImageFilter
   {
@@ -39,6 +47,14 @@ namespace mitk
     itkFactorylessNewMacro(Self);
     itkCloneMacro(Self);
 
+    /** \brief Enables the computation of the MTR asymmetry map (second output). Default is false. */
+    itkSetMacro(ComputeAsymmetry, bool);
+    itkGetConstMacro(ComputeAsymmetry, bool);
+    itkBooleanMacro(ComputeAsymmetry);
+
+    /** \brief Returns the MTR asymmetry map, which is only generated if ComputeAsymmetry is on. */
+    Image *GetAsymmetryOutput();
+
   protected:
     /*!
     \brief standard constructor
@@ -70,6 +86,14 @@ namespace mitk
     /// non M0 indices
     std::vector< unsigned int > m_NonM0Indices;
 
+    /// Offsets of the asymmetry map
+    std::string m_AsymmetryOffsets;
+
+    /// indices of the positive offsets of the asymmetry map
+    std::vector< unsigned int > m_AsymmetryIndices;
+
+    bool m_ComputeAsymmetry;
+
   };
 
   /** This helper function can be used to check if an image was already normalized.
@@ -16,17 +16,57 @@ found in the LICENSE file.
 #include <mitkImage.h>
 #include <mitkImageAccessByItk.h>
 #include <mitkImageCast.h>
+#include <mitkThreadPool.h>
 
 #include <boost/algorithm/string.hpp>
 
-mitk::CESTImageNormalizationFilter::CESTImageNormalizationFilter()
+#include <algorithm>
+#include <cmath>
+
+mitk::CESTImageNormalizationFilter::CESTImageNormalizationFilter() : m_ComputeAsymmetry(false)
 {
+  this->SetNumberOfIndexedOutputs(2);
+  this->SetNthOutput(1, this->MakeOutput(1));
 }
 
 mitk::CESTImageNormalizationFilter::~CESTImageNormalizationFilter()
 {
 }
 
+mitk::Image *mitk::CESTImageNormalizationFilter::GetAsymmetryOutput()
+{
+  return this->GetOutput(1);
+}
+
+namespace
+{
+  /** Sets the geometries of the selected input timesteps and the input properties with the given offsets */
+  void TransferTimeStepsAndProperties(const mitk::Image *input,
+                                      mitk::Image *result,
+                                      const std::vector<unsigned int> &timesteps,
+                                      const std::string &offsets)
+  {
+    auto originalTimeGeometry = input->GetTimeGeometry();
+    auto resultTimeGeometry = mitk::ProportionalTimeGeometry::New();
+
+    unsigned int numberOfTimesteps = timesteps.size();
+    resultTimeGeometry->Expand(numberOfTimesteps);
+
+    for (unsigned int index = 0; index < numberOfTimesteps; ++index)
+    {
+      resultTimeGeometry->SetTimeStepGeometry(originalTimeGeometry->GetGeometryCloneForTimeStep(timesteps.at(index)), index);
+    }
+    result->SetTimeGeometry(resultTimeGeometry);
+
+    result->SetPropertyList(input->GetPropertyList()->Clone());
+    result->GetPropertyList()->SetStringProperty(mitk::CustomTagParser::m_OffsetsPropertyName.c_str(), offsets.c_str());
+    // remove uids
+    result->GetPropertyList()->DeleteProperty("DICOM.0008.0018");
+    result->GetPropertyList()->DeleteProperty("DICOM.0020.000D");
+    result->GetPropertyList()->DeleteProperty("DICOM.0020.000E");
+  }
+}
+
 void mitk::CESTImageNormalizationFilter::GenerateData()
 {
   mitk::Image::ConstPointer inputImage = this->GetInput(0);
@@ -36,28 +76,14 @@ void mitk::CESTImageNormalizationFilter::GenerateData()
     return;
   }
 
-  auto resultMitkImage = this->GetOutput();
   AccessFixedDimensionByItk(inputImage, NormalizeTimeSteps, 4);
 
-  auto originalTimeGeometry = this->GetInput()->GetTimeGeometry();
-  auto resultTimeGeometry = mitk::ProportionalTimeGeometry::New();
-
-  unsigned int numberOfNonM0s = m_NonM0Indices.size();
-  resultTimeGeometry->Expand(numberOfNonM0s);
+  TransferTimeStepsAndProperties(inputImage, this->GetOutput(), m_NonM0Indices, m_RealOffsets);
 
-  for (unsigned int index = 0; index < numberOfNonM0s; ++index)
+  if (m_ComputeAsymmetry && !m_AsymmetryIndices.empty())
   {
-    resultTimeGeometry->SetTimeStepGeometry(originalTimeGeometry->GetGeometryCloneForTimeStep(m_NonM0Indices.at(index)), index);
+    TransferTimeStepsAndProperties(inputImage, this->GetAsymmetryOutput(), m_AsymmetryIndices, m_AsymmetryOffsets);
   }
-  resultMitkImage->SetTimeGeometry(resultTimeGeometry);
-
-  resultMitkImage->SetPropertyList(this->GetInput()->GetPropertyList()->Clone());
-  resultMitkImage->GetPropertyList()->SetStringProperty(mitk::CustomTagParser::m_OffsetsPropertyName.c_str(), m_RealOffsets.c_str());
-  // remove uids
-  resultMitkImage->GetPropertyList()->DeleteProperty("DICOM.0008.0018");
-  resultMitkImage->GetPropertyList()->DeleteProperty("DICOM.0020.000D");
-  resultMitkImage->GetPropertyList()->DeleteProperty("DICOM.0020.000E");
-
 }
 
 std::vector<double> ExtractOffsets(const mitk::Image* image)
@@ -91,7 +117,6 @@ std::vector<double> ExtractOffsets(const mitk::Image* image)
 template <typename TPixel, unsigned int VImageDimension>
 void mitk::CESTImageNormalizationFilter::NormalizeTimeSteps(const itk::Image<TPixel, VImageDimension>* image)
 {
-  typedef itk::Image<TPixel, VImageDimension> ImageType;
   typedef itk::Image<double, VImageDimension> OutputImageType;
 
   auto offsets = ExtractOffsets(this->GetInput());
@@ -114,24 +139,23 @@ void mitk::CESTImageNormalizationFilter::NormalizeTimeSteps(const itk::Image<TPi
     }
   }
 
-  auto resultImage = OutputImageType::New();
-  typename ImageType::RegionType targetEntireRegion = image->GetLargestPossibleRegion();
-  targetEntireRegion.SetSize(3, m_NonM0Indices.size());
-  resultImage->SetRegions(targetEntireRegion);
-  resultImage->Allocate();
-  resultImage->FillBuffer(0);
-
   unsigned int numberOfTimesteps = image->GetLargestPossibleRegion().GetSize(3);
+  if (mZeroIndices.empty() || offsets.size() != numberOfTimesteps)
+  {
+    mitkThrow() << "mitk::CESTImageNormalizationFilter: The offsets of the image do not match its timesteps or "
+                   "contain no normalization (M0) image.";
+  }
+
+  // determine the normalization images and their weights of every non M0 timestep
+  struct Normalization
+  {
+    unsigned int source;
+    unsigned int lowerMZero;
+    unsigned int upperMZero;
+    double weight;
+  };
+  std::vector<Normalization> normalizations;
 
-  typename ImageType::RegionType lowerMZeroRegion = image->GetLargestPossibleRegion();
-  lowerMZeroRegion.SetSize(3, 1);
-  typename ImageType::RegionType upperMZeroRegion = image->GetLargestPossibleRegion();
-  upperMZeroRegion.SetSize(3, 1);
-  typename ImageType::RegionType sourceRegion = image->GetLargestPossibleRegion();
-  sourceRegion.SetSize(3, 1);
-  typename OutputImageType::RegionType targetRegion = resultImage->GetLargestPossibleRegion();
-  targetRegion.SetSize(3, 1);
-  unsigned int targetTimestep = 0;
   for (unsigned int sourceTimestep = 0; sourceTimestep < numberOfTimesteps; ++sourceTimestep)
   {
     unsigned int lowerMZeroIndex = mZeroIndices[0];
@@ -160,50 +184,120 @@ void mitk::CESTImageNormalizationFilter::NormalizeTimeSteps(const itk::Image<TPi
       weight = 1.0 - double(sourceTimestep - lowerMZeroIndex) / double(upperMZeroIndex - lowerMZeroIndex);
     }
 
+    if (!isMZero)
+    {
+      normalizations.push_back({ sourceTimestep, lowerMZeroIndex, upperMZeroIndex, weight });
+    }
+  }
 
-    if (isMZero)
+  // pair the normalized timesteps of the positive offsets with the ones of the negative offsets
+  std::vector<std::pair<unsigned int, unsigned int>> asymmetryPairs;
+  std::stringstream asymmetryOffsets;
+  asymmetryOffsets.imbue(std::locale("C"));
+  m_AsymmetryIndices.clear();
+  if (m_ComputeAsymmetry)
+  {
+    for (unsigned int positive = 0; positive < m_NonM0Indices.size(); ++positive)
     {
-      //do nothing
+      double offset = offsets.at(m_NonM0Indices[positive]);
+      if (offset <= 0)
+        continue;
+
+      for (unsigned int negative = 0; negative < m_NonM0Indices.size(); ++negative)
+      {
+        if (mitk::Equal(offsets.at(m_NonM0Indices[negative]), -offset))
+        {
+          asymmetryPairs.push_back(std::make_pair(positive, negative));
+          asymmetryOffsets << offset << " ";
+          m_AsymmetryIndices.push_back(m_NonM0Indices[positive]);
+          break;
+        }
+      }
     }
-    else
+
+    if (asymmetryPairs.empty())
     {
-      lowerMZeroRegion.SetIndex(3, lowerMZeroIndex);
-      upperMZeroRegion.SetIndex(3, upperMZeroIndex);
-      sourceRegion.SetIndex(3, sourceTimestep);
-      targetRegion.SetIndex(3, targetTimestep);
+      MITK_WARN << "mitk::CESTImageNormalizationFilter: No pair of positive and negative offsets found, the asymmetry "
+                   "map is not computed.";
+    }
+  }
+
+  auto resultImage = OutputImageType::New();
+  typename OutputImageType::RegionType targetEntireRegion = image->GetLargestPossibleRegion();
+  targetEntireRegion.SetSize(3, normalizations.size());
+  resultImage->SetRegions(targetEntireRegion);
+  resultImage->Allocate();
+
+  typename OutputImageType::Pointer asymmetryImage;
+  if (!asymmetryPairs.empty())
+  {
+    asymmetryImage = OutputImageType::New();
+    typename OutputImageType::RegionType asymmetryRegion = image->GetLargestPossibleRegion();
+    asymmetryRegion.SetSize(3, asymmetryPairs.size());
+    asymmetryImage->SetRegions(asymmetryRegion);
+    asymmetryImage->Allocate();
+  }
 
-      itk::ImageRegionConstIterator<ImageType> lowerMZeroIterator(image, lowerMZeroRegion);
-      itk::ImageRegionConstIterator<ImageType> upperMZeroIterator(image, upperMZeroRegion);
-      itk::ImageRegionConstIterator<ImageType> sourceIterator(image, sourceRegion);
-      itk::ImageRegionIterator<OutputImageType> targetIterator(resultImage.GetPointer(), targetRegion);
+  // The timesteps are stored one after another, so each block reads the values of all offsets of its voxels
+  // from contiguous memory and the inner loops can be vectorized by the compiler
+  const std::size_t numberOfVoxels = image->GetLargestPossibleRegion().GetNumberOfPixels() / numberOfTimesteps;
+  const std::size_t blockSize = 1024;
+  const std::size_t numberOfBlocks = (numberOfVoxels + blockSize - 1) / blockSize;
 
-      while (!sourceIterator.IsAtEnd())
+  const TPixel *input = image->GetBufferPointer();
+  double *normalized = resultImage->GetBufferPointer();
+  double *asymmetry = asymmetryImage.IsNotNull() ? asymmetryImage->GetBufferPointer() : nullptr;
+
+  ThreadPool::GetInstance().ParallelFor(0, numberOfBlocks, [&](std::size_t beginBlock, std::size_t endBlock) {
+    for (std::size_t block = beginBlock; block < endBlock; ++block)
+    {
+      const std::size_t begin = block * blockSize;
+      const std::size_t count = std::min(blockSize, numberOfVoxels - begin);
+
+      for (std::size_t target = 0; target < normalizations.size(); ++target)
       {
-        double normalizationFactor = weight * lowerMZeroIterator.Get() + (1.0 - weight) * upperMZeroIterator.Get();
-        if (mitk::Equal(normalizationFactor, 0))
+        const Normalization &normalization = normalizations[target];
+        const TPixel *source = input + normalization.source * numberOfVoxels + begin;
+        const TPixel *lowerMZero = input + normalization.lowerMZero * numberOfVoxels + begin;
+        const TPixel *upperMZero = input + normalization.upperMZero * numberOfVoxels + begin;
+        double *result = normalized + target * numberOfVoxels + begin;
+        const double weight = normalization.weight;
+
+        for (std::size_t i = 0; i < count; ++i)
         {
-          targetIterator.Set(0);
+          double normalizationFactor = weight * lowerMZero[i] + (1.0 - weight) * upperMZero[i];
+          result[i] = std::abs(normalizationFactor) > mitk::eps ? double(source[i]) / normalizationFactor : 0.0;
         }
-        else
+      }
+
+      // the normalized values of the block are still cached
+      for (std::size_t pair = 0; pair < asymmetryPairs.size(); ++pair)
+      {
+        const double *positive = normalized + asymmetryPairs[pair].first * numberOfVoxels + begin;
+        const double *negative = normalized + asymmetryPairs[pair].second * numberOfVoxels + begin;
+        double *result = asymmetry + pair * numberOfVoxels + begin;
+
+        for (std::size_t i = 0; i < count; ++i)
         {
-          targetIterator.Set(double(sourceIterator.Get()) / normalizationFactor);
+          result[i] = negative[i] - positive[i];
         }
-
-        ++lowerMZeroIterator;
-        ++upperMZeroIterator;
-        ++sourceIterator;
-        ++targetIterator;
       }
-      ++targetTimestep;
     }
-  }
+  });
 
   // get  Pointer to output image
   mitk::Image::Pointer resultMitkImage = this->GetOutput();
   // write into output image
   mitk::CastToMitkImage<OutputImageType>(resultImage, resultMitkImage);
 
+  if (asymmetryImage.IsNotNull())
+  {
+    mitk::Image::Pointer asymmetryMitkImage = this->GetAsymmetryOutput();
+    mitk::CastToMitkImage<OutputImageType>(asymmetryImage, asymmetryMitkImage);
+  }
+
   m_RealOffsets = offsetsWithoutM0.str();
+  m_AsymmetryOffsets = asymmetryOffsets.str();
 }
 
 void mitk::CESTImageNormalizationFilter::GenerateOutputInformation()
@@ -0,0 +1,160 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+// MITK includes
+#include "mitkCESTImageNormalizationFilter.h"
+#include "mitkCustomTagParser.h"
+#include <mitkITKImageImport.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImagePixelWriteAccessor.h>
+
+// ITK includes
+#include <itkImage.h>
+
+class mitkCESTImageNormalizationFilterTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkCESTImageNormalizationFilterTestSuite);
+
+  MITK_TEST(Normalize_M0sRemovedAndInterpolated);
+  MITK_TEST(Normalize_ZeroM0_Zero);
+  MITK_TEST(ComputeAsymmetry_Success);
+  MITK_TEST(ComputeAsymmetryOff_NoAsymmetryOutput);
+  MITK_TEST(NoM0_Exception);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef itk::Image<short, 4> ImageType;
+
+  static const unsigned int m_NumberOfVoxels = 3 * 2 * 2;
+
+  /** Five timesteps with the offsets "-300 -3.5 0 3.5 300"; the M0 values are 100 and 200 (multiplied with the voxel
+   * number + 1) and the CEST values 50, 100 and 150 (also multiplied) */
+  mitk::Image::Pointer CreateCESTImage(bool withM0 = true)
+  {
+    ImageType::Pointer itkImage = ImageType::New();
+    ImageType::RegionType region;
+    ImageType::SizeType size = {{3, 2, 2, 5}};
+    region.SetSize(size);
+    itkImage->SetRegions(region);
+    itkImage->Allocate();
+
+    const short values[5] = {100, 50, 100, 150, 200};
+    short *buffer = itkImage->GetBufferPointer();
+    for (unsigned int timestep = 0; timestep < 5; ++timestep)
+    {
+      for (unsigned int voxel = 0; voxel < m_NumberOfVoxels; ++voxel)
+      {
+        buffer[timestep * m_NumberOfVoxels + voxel] = values[timestep] * (voxel + 1);
+      }
+    }
+
+    mitk::Image::Pointer image = mitk::GrabItkImageMemory(itkImage);
+    image->GetPropertyList()->SetStringProperty(mitk::CustomTagParser::m_OffsetsPropertyName.c_str(),
+                                                withM0 ? "-300 -3.5 0 3.5 300" : "-4 -3.5 0 3.5 4");
+    return image;
+  }
+
+  double GetValue(mitk::Image *image, unsigned int voxel, unsigned int timestep)
+  {
+    mitk::ImagePixelReadAccessor<double, 4> accessor(image);
+    itk::Index<4> index;
+    index[0] = voxel % 3;
+    index[1] = (voxel / 3) % 2;
+    index[2] = voxel / 6;
+    index[3] = timestep;
+    return accessor.GetPixelByIndex(index);
+  }
+
+public:
+  void Normalize_M0sRemovedAndInterpolated()
+  {
+    auto filter = mitk::CESTImageNormalizationFilter::New();
+    filter->SetInput(this->CreateCESTImage());
+    filter->Update();
+
+    auto result = filter->GetOutput();
+    CPPUNIT_ASSERT_EQUAL(3u, result->GetDimension(3));
+
+    std::string offsets;
+    result->GetPropertyList()->GetStringProperty(mitk::CustomTagParser::m_OffsetsPropertyName.c_str(), offsets);
+    CPPUNIT_ASSERT_EQUAL(std::string("-3.5 0 3.5 "), offsets);
+
+    for (unsigned int voxel = 0; voxel < m_NumberOfVoxels; ++voxel)
+    {
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(50.0 / 125.0, this->GetValue(result, voxel, 0), mitk::eps);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(100.0 / 150.0, this->GetValue(result, voxel, 1), mitk::eps);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(150.0 / 175.0, this->GetValue(result, voxel, 2), mitk::eps);
+    }
+  }
+
+  void Normalize_ZeroM0_Zero()
+  {
+    auto image = this->CreateCESTImage();
+    {
+      mitk::ImagePixelWriteAccessor<short, 4> accessor(image);
+      itk::Index<4> index = {{0, 0, 0, 0}};
+      accessor.SetPixelByIndex(index, 0);
+      index[3] = 4;
+      accessor.SetPixelByIndex(index, 0);
+    }
+
+    auto filter = mitk::CESTImageNormalizationFilter::New();
+    filter->SetInput(image);
+    filter->Update();
+
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, this->GetValue(filter->GetOutput(), 0, 1), mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(100.0 / 150.0, this->GetValue(filter->GetOutput(), 1, 1), mitk::eps);
+  }
+
+  void ComputeAsymmetry_Success()
+  {
+    auto filter = mitk::CESTImageNormalizationFilter::New();
+    filter->SetInput(this->CreateCESTImage());
+    filter->ComputeAsymmetryOn();
+    filter->Update();
+
+    auto asymmetry = filter->GetAsymmetryOutput();
+    CPPUNIT_ASSERT(asymmetry->IsInitialized());
+    CPPUNIT_ASSERT_EQUAL(1u, asymmetry->GetDimension(3));
+
+    std::string offsets;
+    asymmetry->GetPropertyList()->GetStringProperty(mitk::CustomTagParser::m_OffsetsPropertyName.c_str(), offsets);
+    CPPUNIT_ASSERT_EQUAL(std::string("3.5 "), offsets);
+
+    for (unsigned int voxel = 0; voxel < m_NumberOfVoxels; ++voxel)
+    {
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(50.0 / 125.0 - 150.0 / 175.0, this->GetValue(asymmetry, voxel, 0), mitk::eps);
+    }
+  }
+
+  void ComputeAsymmetryOff_NoAsymmetryOutput()
+  {
+    auto filter = mitk::CESTImageNormalizationFilter::New();
+    filter->SetInput(this->CreateCESTImage());
+    filter->Update();
+
+    CPPUNIT_ASSERT(!filter->GetAsymmetryOutput()->IsInitialized());
+  }
+
+  void NoM0_Exception()
+  {
+    auto filter = mitk::CESTImageNormalizationFilter::New();
+    filter->SetInput(this->CreateCESTImage(false));
+    CPPUNIT_ASSERT_THROW(filter->Update(), mitk::Exception);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkCESTImageNormalizationFilter)
@@ -154,6 +154,15 @@ public:
    */
   void UpdateData2D(const std::vector< std::pair<double, double> > &data2D, const std::string &label);
 
+  /*!
+   * \brief Appends data points to an existing label
+   * \details Only the appended points are transferred to the chart, unless the data of the label is decimated.
+   * \param data2D the 2D data to append, \sa AddData2D
+   * \param label the (existing) label
+   * \note if the label does not exist, nothing happens
+   */
+  void AppendData2D(const std::vector< std::pair<double, double> > &data2D, const std::string &label);
+
   void UpdateChartExampleData(const std::vector< std::pair<double, double> >& data2D,
                               const std::string& label,
                               const std::string& type,
@@ -338,6 +347,13 @@ public:
 
   void SavePlotAsImage();
 
+  /*!
+   * \brief Enables or disables the decimation of large data series to the width of the widget (default: enabled)
+   * \details If enabled, only the points with the minimum and maximum value of every pixel column are transferred
+   * for series with ascending x values and without error bars, \sa QmitkChartxyData::SetDecimationWidth
+   */
+  void SetDataDecimation(bool decimate);
+
 public slots:
   void OnLoadFinished(bool isLoadSuccessful);
   void OnPageSuccessfullyLoaded();
@@ -345,6 +361,9 @@ public slots:
 signals:
   void PageSuccessfullyLoaded();
 
+protected:
+  void resizeEvent(QResizeEvent *event) override;
+
 private:
   /*! source: https://stackoverflow.com/questions/29383/converting-bool-to-text-in-c*/
   std::string convertBooleanValue(bool value) const;
@@ -18,14 +18,19 @@ found in the LICENSE file.
 /** /brief This class holds the actual data for the chart generation with C3.
  * data can be loaded in constructor directly or with SetData
  * It is derived from QObject, because we need Q_PROPERTIES to send Data via QWebChannel to JavaScript.
+ *
+ * The x and y values are not sent as JSON lists, but as base64 encoded arrays of doubles (m_XDataBinary,
+ * m_YDataBinary). If a decimation width is set, series with more than two points per pixel column are
+ * reduced to the minimum and maximum value per column before they are sent (see SetDecimationWidth).
+ * GetXData() and GetYData() always return the complete data.
  */
 class QmitkChartxyData : public QObject
 {
   Q_OBJECT
 
   Q_PROPERTY(QVariant m_LabelCount READ GetLabelCount CONSTANT);
-  Q_PROPERTY(QList<QVariant> m_YData READ GetYData WRITE SetYData NOTIFY SignalDataChanged);
-  Q_PROPERTY(QList<QVariant> m_XData READ GetXData WRITE SetXData NOTIFY SignalDataChanged);
+  Q_PROPERTY(QString m_XDataBinary READ GetXDataBinary NOTIFY SignalDataChanged);
+  Q_PROPERTY(QString m_YDataBinary READ GetYDataBinary NOTIFY SignalDataChanged);
   Q_PROPERTY(
     QList<QVariant> m_XErrorDataPlus READ GetXErrorDataPlus WRITE SetXErrorDataPlus NOTIFY SignalErrorDataChanged);
   Q_PROPERTY(
@@ -50,20 +55,43 @@ public:
 
   void SetData(const std::vector< std::pair<double, double> > &data);
 
+  /**
+   * \brief Appends data points to the data.
+   *
+   * Only the appended points are sent to the chart, unless the data has to be decimated.
+   */
+  void AppendData(const std::vector< std::pair<double, double> > &data);
+
+  /**
+   * \brief Sets the number of pixel columns the data is decimated to (0: no decimation, the default).
+   *
+   * Decimation only takes place for x values in ascending order, without error bars and not for pie charts.
+   */
+  void SetDecimationWidth(int width);
+  int GetDecimationWidth() const { return m_DecimationWidth; }
+
+  /** \brief True if the data sent to the chart is decimated. */
+  bool IsDecimated() const { return m_IsDecimated; }
+
+  Q_INVOKABLE QString GetXDataBinary() const { return m_XDataBinary; }
+  Q_INVOKABLE QString GetYDataBinary() const { return m_YDataBinary; }
+
   Q_INVOKABLE QVariant GetLabelCount() const { return m_LabelCount; }
 
   Q_INVOKABLE QList<QVariant> GetYData() const { return m_YData; };
   Q_INVOKABLE void SetYData(const QList<QVariant> &yData)
   {
     m_YData = yData;
-    emit SignalDataChanged(yData);
+    this->UpdateTransferredData();
+    emit SignalDataChanged();
   };
 
   Q_INVOKABLE QList<QVariant> GetXData() const { return m_XData; };
   Q_INVOKABLE void SetXData(const QList<QVariant> &xData)
   {
     m_XData = xData;
-    emit SignalDataChanged(xData);
+    this->UpdateTransferredData();
+    emit SignalDataChanged();
   };
 
   Q_INVOKABLE QList<QVariant> GetXErrorDataPlus() const { return m_XErrorDataPlus; };
@@ -71,6 +99,7 @@ public:
   {
     m_XErrorDataPlus = errorData;
     emit SignalErrorDataChanged(errorData);
+    this->OnDecimationConditionChanged();
   };
 
   Q_INVOKABLE QList<QVariant> GetXErrorDataMinus() const { return m_XErrorDataMinus; };
@@ -78,6 +107,7 @@ public:
   {
     m_XErrorDataMinus = errorData;
     emit SignalErrorDataChanged(errorData);
+    this->OnDecimationConditionChanged();
   };
 
   Q_INVOKABLE QList<QVariant> GetYErrorDataPlus() const { return m_YErrorDataPlus; };
@@ -85,6 +115,7 @@ public:
   {
     m_YErrorDataPlus = errorData;
     emit SignalErrorDataChanged(errorData);
+    this->OnDecimationConditionChanged();
   };
 
   Q_INVOKABLE QList<QVariant> GetYErrorDataMinus() const { return m_YErrorDataMinus; };
@@ -92,6 +123,7 @@ public:
   {
     m_YErrorDataMinus = errorData;
     emit SignalErrorDataChanged(errorData);
+    this->OnDecimationConditionChanged();
   };
 
   Q_INVOKABLE QVariant GetChartType() const { return m_ChartType; };
@@ -99,6 +131,7 @@ public:
   {
     m_ChartType = chartType;
     emit SignalDiagramTypeChanged(chartType);
+    this->OnDecimationConditionChanged();
   };
 
   Q_INVOKABLE QVariant GetLabel() const { return m_Label; };
@@ -139,10 +172,12 @@ public:
    */
   void ClearData();
 
-  QmitkChartxyData() {}
+  QmitkChartxyData() : m_DecimationWidth(0), m_IsDecimated(false) {}
 
 signals:
-  void SignalDataChanged(const QList<QVariant> data);
+  void SignalDataChanged();
+  /** \brief Emitted instead of SignalDataChanged() if only points were appended, with the appended points. */
+  void SignalDataAppended(const QString xDataBinary, const QString yDataBinary);
   void SignalErrorDataChanged(const QList<QVariant> errorData);
   void SignalDiagramTypeChanged(const QVariant diagramType);
   void SignalColorChanged(const QVariant color);
@@ -152,6 +187,15 @@ signals:
   void SignalMarkerSymbolChanged(const QVariant lineStyle);
 
 private:
+  /** \brief True if the data is long enough to be decimated and nothing prevents decimation. */
+  bool IsDecimationNeeded() const;
+
+  /** \brief Encodes the (decimated) data into m_XDataBinary and m_YDataBinary. */
+  void UpdateTransferredData();
+
+  /** \brief Resends the data if the chart type or error bars changed whether it is decimated. */
+  void OnDecimationConditionChanged();
+
   /** js needs to know which label position in the list QmitkChartWidget::Impl::m_C3xyData it has for updating the values*/
   const QVariant m_LabelCount;
   QList<QVariant> m_YData;
@@ -166,6 +210,10 @@ private:
   QVariant m_Color;
   QVariant m_LineStyleName;
   QVariant m_MarkerSymbolName;
+  QString m_XDataBinary;
+  QString m_YDataBinary;
+  int m_DecimationWidth;
+  bool m_IsDecimated;
 };
 
 #endif // QmitkC3xyData_h
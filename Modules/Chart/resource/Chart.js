@@ -75,9 +75,9 @@ window.onload = function()
       Plotly.restyle('chart', updateColor, position);
     });
 
-    registeredChannelObject.SignalDataChanged.connect(function(newValue){
-      let xDataTemp = registeredChannelObject.m_XData;
-      let yDataTemp = registeredChannelObject.m_YData;
+    registeredChannelObject.SignalDataChanged.connect(function(){
+      let xDataTemp = decodeDoubles(registeredChannelObject.m_XDataBinary);
+      let yDataTemp = decodeDoubles(registeredChannelObject.m_YDataBinary);
 
       let trace = generateTraceByChartType(registeredChannelObject.m_ChartType);
 
@@ -92,6 +92,18 @@ window.onload = function()
       Plotly.restyle('chart', trace, position);
     });
 
+    registeredChannelObject.SignalDataAppended.connect(function(xDataBinary, yDataBinary){
+      let trace = document.getElementById('chart').data[position];
+
+      // remove the null values appended when the chart was generated, they would split the line
+      while (trace.x.length > 0 && trace.x[trace.x.length - 1] === null){
+        trace.x.pop();
+        trace.y.pop();
+      }
+
+      Plotly.extendTraces('chart', {x: [decodeDoubles(xDataBinary)], y: [decodeDoubles(yDataBinary)]}, [position]);
+    });
+
     registeredChannelObject.SignalLabelChanged.connect(function(newValue){
       let trace = {
         name: newValue
@@ -195,8 +207,8 @@ window.onload = function()
         let chartXYData = channel.objects[propertyName];
         handleDataChangeEvents(chartXYData);
 
-        let xDataTemp = chartXYData.m_XData;
-        let yDataTemp = chartXYData.m_YData;
+        let xDataTemp = decodeDoubles(chartXYData.m_XDataBinary);
+        let yDataTemp = decodeDoubles(chartXYData.m_YDataBinary);
         let xErrorsTempPlus = chartXYData.m_XErrorDataPlus;
         let pieDataLabelsTemp = chartXYData.m_PieLabels;
         let xErrorsTempMinus = chartXYData.m_XErrorDataMinus;
@@ -256,6 +268,21 @@ window.onload = function()
   });
 }
 
+/**
+ * Decodes the values of a data series, which QmitkChartxyData transfers as base64 encoded doubles.
+ *
+ * @param {string} base64 - the encoded values
+ * @returns {Array} the values
+ */
+function decodeDoubles(base64) {
+  let binary = atob(base64);
+  let bytes = new Uint8Array(binary.length);
+  for (let i = 0; i < binary.length; i++){
+    bytes[i] = binary.charCodeAt(i);
+  }
+  return Array.from(new Float64Array(bytes.buffer));
+}
+
 /**
  * Inits the height of the chart element to 90% of the full window height.
  */
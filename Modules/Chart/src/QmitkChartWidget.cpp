@@ -10,9 +10,11 @@ found in the LICENSE file.
 
 ============================================================================*/
 
+#include <algorithm>
 #include <regex>
 
 #include <QGridLayout>
+#include <QResizeEvent>
 #include <QWebChannel>
 #include <QWebEngineSettings>
 #include <QWebEngineView>
@@ -58,6 +60,7 @@ public:
 
   void UpdateData1D(const std::vector<double> &data1D, const std::string &label);
   void UpdateData2D(const std::vector< std::pair<double, double> > &data2D, const std::string &label);
+  void AppendData2D(const std::vector< std::pair<double, double> > &data2D, const std::string &label);
   void UpdateChartExampleData(const std::vector< std::pair<double, double> >& data2D,
                               const std::string& label,
                               const std::string& type,
@@ -116,6 +119,9 @@ public:
   void SetMinMaxValueXView(double minValueX, double maxValueX);
   void SetMinMaxValueYView(double minValueY, double maxValueY);
 
+  void SetDataDecimation(bool decimate);
+  void UpdateDecimationWidth();
+
   QList<QVariant> ConvertErrorVectorToQList(const std::vector<double> &error);
   QList<QVariant> ConvertVectorToQList(const std::vector<std::string> &vec);
 
@@ -133,6 +139,7 @@ private:
   using ChartxyDataVector = std::vector<std::unique_ptr<QmitkChartxyData>>;
   std::string GetUniqueLabelName(const QList<QVariant> &labelList, const std::string &label) const;
   QList<QVariant> GetDataLabels(const ChartxyDataVector &c3xyData) const;
+  int GetDecimationWidth() const;
 
   QWebChannel *m_WebChannel;
   QWebEngineView *m_WebEngineView;
@@ -146,10 +153,11 @@ private:
   std::map<QmitkChartWidget::LineStyle, std::string> m_LineStyleToName;
   std::map<QmitkChartWidget::MarkerSymbol, std::string> m_MarkerSymbolToName;
   std::map<QmitkChartWidget::AxisScale, std::string> m_AxisScaleToName;
+  bool m_DataDecimation;
 };
 
 QmitkChartWidget::Impl::Impl(QWidget *parent)
-  : m_WebChannel(new QWebChannel(parent)), m_WebEngineView(new QWebEngineView(parent))
+  : m_WebChannel(new QWebChannel(parent)), m_WebEngineView(new QWebEngineView(parent)), m_DataDecimation(true)
 {
   // disable context menu for QWebEngineView
   m_WebEngineView->setContextMenuPolicy(Qt::NoContextMenu);
@@ -289,6 +297,7 @@ void QmitkChartWidget::Impl::AddData2D(const std::vector< std::pair<double, doub
                                                           QVariant(QString::fromStdString(uniqueLabel)),
                                                           QVariant(QString::fromStdString(chartTypeName)),
                                                           QVariant(sizeOfC3xyData)));
+  m_C3xyData.back()->SetDecimationWidth(GetDecimationWidth());
 }
 
 void QmitkChartWidget::Impl::AddChartExampleData(const std::vector< std::pair<double, double> >& data2D,
@@ -340,6 +349,7 @@ void QmitkChartWidget::Impl::AddChartExampleData(const std::vector< std::pair<do
     chartData->SetPieLabels(pieLabelsDataList);
   }
 
+  chartData->SetDecimationWidth(GetDecimationWidth());
   m_C3xyData.push_back(std::move(chartData));
 }
 
@@ -364,6 +374,13 @@ void QmitkChartWidget::Impl::UpdateData2D(const std::vector< std::pair<double, d
     element->SetData(data2D);
 }
 
+void QmitkChartWidget::Impl::AppendData2D(const std::vector< std::pair<double, double> > &data2D, const std::string &label)
+{
+  auto element = GetDataElementByLabel(label);
+  if (element)
+    element->AppendData(data2D);
+}
+
 void QmitkChartWidget::Impl::UpdateChartExampleData(const std::vector< std::pair<double, double> >& data2D,
                                                     const std::string& label,
                                                     const std::string& type,
@@ -673,6 +690,29 @@ QSize QmitkChartWidget::Impl::sizeHint() const
   return QSize(400, 300);
 }
 
+void QmitkChartWidget::Impl::SetDataDecimation(bool decimate)
+{
+  m_DataDecimation = decimate;
+  UpdateDecimationWidth();
+}
+
+void QmitkChartWidget::Impl::UpdateDecimationWidth()
+{
+  const int width = GetDecimationWidth();
+  for (auto &xyData : m_C3xyData)
+    xyData->SetDecimationWidth(width);
+}
+
+int QmitkChartWidget::Impl::GetDecimationWidth() const
+{
+  if (!m_DataDecimation)
+    return 0;
+
+  // rounded up to steps of 100 pixels, so that resizing the widget does not resend the data continuously
+  const int stepSize = 100;
+  return (std::max(m_WebEngineView->width(), 1) + stepSize - 1) / stepSize * stepSize;
+}
+
 void QmitkChartWidget::Impl::CallJavaScriptFuntion(const QString &command)
 {
   m_WebEngineView->page()->runJavaScript(command);
@@ -776,6 +816,11 @@ void QmitkChartWidget::UpdateData2D(const std::vector< std::pair<double, double>
   m_Impl->UpdateData2D(data2D, label);
 }
 
+void QmitkChartWidget::AppendData2D(const std::vector< std::pair<double, double> > &data2D, const std::string &label)
+{
+  m_Impl->AppendData2D(data2D, label);
+}
+
 void QmitkChartWidget::UpdateChartExampleData(const std::vector< std::pair<double, double> >& data2D,
                                               const std::string& label,
                                               const std::string& type,
@@ -930,6 +975,17 @@ QSize QmitkChartWidget::sizeHint() const
   return m_Impl->sizeHint();
 }
 
+void QmitkChartWidget::SetDataDecimation(bool decimate)
+{
+  m_Impl->SetDataDecimation(decimate);
+}
+
+void QmitkChartWidget::resizeEvent(QResizeEvent *event)
+{
+  QWidget::resizeEvent(event);
+  m_Impl->UpdateDecimationWidth();
+}
+
 void QmitkChartWidget::SavePlotAsImage()
 {
   m_Impl->GetImageUrl();
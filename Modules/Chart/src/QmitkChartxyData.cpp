@@ -12,11 +12,94 @@ found in the LICENSE file.
 
 #include <QmitkChartxyData.h>
 
+#include <QByteArray>
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+  QString EncodeValues(const std::vector<double> &values)
+  {
+    // decoded by a Float64Array in Chart.js, both sides use the byte order of the machine
+    const QByteArray bytes(reinterpret_cast<const char *>(values.data()),
+                           static_cast<int>(values.size() * sizeof(double)));
+    return QString::fromLatin1(bytes.toBase64());
+  }
+
+  std::vector<double> ToDoubles(const QList<QVariant> &list, int begin = 0)
+  {
+    std::vector<double> values;
+    values.reserve(std::max(0, list.size() - begin));
+    for (int i = begin; i < list.size(); ++i)
+      values.push_back(list[i].toDouble());
+    return values;
+  }
+
+  /**
+   * Reduces x and y to the points with the minimum and maximum y value of every pixel column,
+   * keeping the first and the last point. Returns false if the x values are not ascending.
+   */
+  bool DecimateMinMax(std::vector<double> &x, std::vector<double> &y, int width)
+  {
+    const std::size_t numberOfPoints = x.size();
+    if (!std::is_sorted(x.begin(), x.end()) || !(x.back() > x.front()))
+      return false;
+
+    const double scale = width / (x.back() - x.front());
+    std::vector<std::size_t> indices;
+    indices.reserve(2 * width + 2);
+    indices.push_back(0);
+
+    auto addColumn = [&indices](std::size_t minIndex, std::size_t maxIndex) {
+      for (std::size_t index : {std::min(minIndex, maxIndex), std::max(minIndex, maxIndex)})
+      {
+        if (index > indices.back())
+          indices.push_back(index);
+      }
+    };
+
+    int column = 0;
+    std::size_t minIndex = 0;
+    std::size_t maxIndex = 0;
+    for (std::size_t i = 1; i < numberOfPoints; ++i)
+    {
+      const int pointColumn = std::min(width - 1, static_cast<int>((x[i] - x.front()) * scale));
+      if (pointColumn != column)
+      {
+        addColumn(minIndex, maxIndex);
+        column = pointColumn;
+        minIndex = maxIndex = i;
+      }
+      else if (y[i] < y[minIndex])
+      {
+        minIndex = i;
+      }
+      else if (y[i] > y[maxIndex])
+      {
+        maxIndex = i;
+      }
+    }
+    addColumn(minIndex, maxIndex);
+    if (indices.back() != numberOfPoints - 1)
+      indices.push_back(numberOfPoints - 1);
+
+    for (std::size_t i = 0; i < indices.size(); ++i)
+    {
+      x[i] = x[indices[i]];
+      y[i] = y[indices[i]];
+    }
+    x.resize(indices.size());
+    y.resize(indices.size());
+    return true;
+  }
+}
+
 QmitkChartxyData::QmitkChartxyData(const std::vector< std::pair<double, double> > &data,
                                    const QVariant &label,
                                    const QVariant &chartType,
                                    const QVariant &position)
-  : m_LabelCount(position), m_Label(label), m_ChartType(chartType)
+  : m_LabelCount(position), m_Label(label), m_ChartType(chartType), m_DecimationWidth(0), m_IsDecimated(false)
 {
   SetData(data);
 }
@@ -29,7 +112,71 @@ void QmitkChartxyData::SetData(const std::vector< std::pair<double, double> > &d
     m_XData.push_back(entry.first);
     m_YData.push_back(entry.second);
   }
-  emit SignalDataChanged(m_YData);
+  this->UpdateTransferredData();
+  emit SignalDataChanged();
+}
+
+void QmitkChartxyData::AppendData(const std::vector< std::pair<double, double> > &data)
+{
+  const int numberOfPreviousPoints = m_XData.size();
+  for (const auto &entry : data)
+  {
+    m_XData.push_back(entry.first);
+    m_YData.push_back(entry.second);
+  }
+
+  const bool wasDecimated = m_IsDecimated;
+  this->UpdateTransferredData();
+
+  if (wasDecimated || m_IsDecimated)
+  {
+    emit SignalDataChanged();
+  }
+  else
+  {
+    emit SignalDataAppended(EncodeValues(ToDoubles(m_XData, numberOfPreviousPoints)),
+                            EncodeValues(ToDoubles(m_YData, numberOfPreviousPoints)));
+  }
+}
+
+void QmitkChartxyData::SetDecimationWidth(int width)
+{
+  width = std::max(0, width);
+  if (width == m_DecimationWidth)
+    return;
+
+  m_DecimationWidth = width;
+  if (m_IsDecimated || this->IsDecimationNeeded())
+  {
+    this->UpdateTransferredData();
+    emit SignalDataChanged();
+  }
+}
+
+bool QmitkChartxyData::IsDecimationNeeded() const
+{
+  return m_DecimationWidth > 0 && m_XData.size() > 2 * m_DecimationWidth && m_XData.size() == m_YData.size() &&
+         m_ChartType.toString() != "pie" && m_XErrorDataPlus.isEmpty() && m_XErrorDataMinus.isEmpty() &&
+         m_YErrorDataPlus.isEmpty() && m_YErrorDataMinus.isEmpty();
+}
+
+void QmitkChartxyData::UpdateTransferredData()
+{
+  std::vector<double> x = ToDoubles(m_XData);
+  std::vector<double> y = ToDoubles(m_YData);
+  m_IsDecimated = this->IsDecimationNeeded() && DecimateMinMax(x, y, m_DecimationWidth);
+
+  m_XDataBinary = EncodeValues(x);
+  m_YDataBinary = EncodeValues(y);
+}
+
+void QmitkChartxyData::OnDecimationConditionChanged()
+{
+  if (m_IsDecimated != this->IsDecimationNeeded())
+  {
+    this->UpdateTransferredData();
+    emit SignalDataChanged();
+  }
 }
 
 void QmitkChartxyData::ClearData()
@@ -40,4 +187,7 @@ void QmitkChartxyData::ClearData()
   this->m_XErrorDataMinus.clear();
   this->m_YErrorDataPlus.clear();
   this->m_YErrorDataMinus.clear();
+  this->m_XDataBinary.clear();
+  this->m_YDataBinary.clear();
+  this->m_IsDecimated = false;
 }
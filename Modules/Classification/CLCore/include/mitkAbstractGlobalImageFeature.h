@@ -22,6 +22,7 @@ found in the LICENSE file.
 #include <mitkCommandLineParser.h>
 
 #include <mitkIntensityQuantifier.h>
+#include <mitkGlobalImageFeatureCache.h>
 
 // STD Includes
 
@@ -119,6 +120,8 @@ namespace mitk
   * sould contain the line <b>InitializeQuantifier(image, mask);</b>. These function
   * calls ensure that the necessary options are given to the configuration file, and that the initialization
   * of the quantifier is done correctly. This ensures an consistend behavior over all FeatureGeneration Classes.
+  * If several feature classes are calculated for the same image / mask, they should share a
+  * GlobalImageFeatureCache (see SetFeatureCache()) so that the quantifier is only initialized once.
   *
   */
 class MITKCLCORE_EXPORT AbstractGlobalImageFeature : public BaseData
@@ -188,6 +191,13 @@ public:
   itkSetMacro(Quantifier, IntensityQuantifier::Pointer);
   itkGetMacro(Quantifier, IntensityQuantifier::Pointer);
 
+  /**
+  * \brief Cache that is shared between feature classes that are calculated for the same image / mask.
+  * If set, the intensity ranges and quantifiers are taken from the cache (see GlobalImageFeatureCache).
+  */
+  itkSetMacro(FeatureCache, GlobalImageFeatureCache::Pointer);
+  itkGetMacro(FeatureCache, GlobalImageFeatureCache::Pointer);
+
   itkGetConstMacro(Direction, int);
 
   itkSetMacro(MinimumIntensity, double);
@@ -265,6 +275,7 @@ private:
 
   bool m_UseQuantifier = false;
   IntensityQuantifier::Pointer m_Quantifier;
+  GlobalImageFeatureCache::Pointer m_FeatureCache;
 
   double m_MinimumIntensity = 0;
   bool m_UseMinimumIntensity = false;
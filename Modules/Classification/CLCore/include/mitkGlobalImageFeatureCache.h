@@ -0,0 +1,93 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+
+#ifndef mitkGlobalImageFeatureCache_h
+#define mitkGlobalImageFeatureCache_h
+
+#include <MitkCLCoreExports.h>
+
+#include <mitkImage.h>
+#include <mitkIntensityQuantifier.h>
+
+#include <itkObject.h>
+
+// STD Includes
+#include <map>
+#include <string>
+#include <utility>
+
+namespace mitk
+{
+  /**
+  * \brief Holds intermediate results that are shared between the feature classes which are calculated for the same
+  * image / mask combination.
+  *
+  * Most feature classes (see AbstractGlobalImageFeature) derive their histogram (IntensityQuantifier) from the
+  * intensity range of the whole image or of the masked region. Without a cache, every feature class determines
+  * this range again, usually even twice (once in CalculateFeaturesUsingParameters() and once in CalculateFeatures()).
+  * If the same cache is passed to all feature classes (see AbstractGlobalImageFeature::SetFeatureCache()), each
+  * intensity range is only calculated once and a quantifier is only initialized once per parameter set.
+  *
+  * The entries are identified by the image and the mask together with their modification times, so a modified
+  * image is not mixed up with its previous state. The cache does not keep the images alive; use Clear() if the
+  * images of previous calculations are no longer used (e.g. after each slice of a slice-wise calculation).
+  */
+  class MITKCLCORE_EXPORT GlobalImageFeatureCache : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(GlobalImageFeatureCache, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    /**
+    * \brief Returns the minimum and maximum intensity of all voxels of the image.
+    */
+    void GetImageMinMax(const Image::Pointer &image, double &minimum, double &maximum);
+
+    /**
+    * \brief Returns the minimum and maximum intensity of all voxels of the image that lie inside of the mask.
+    */
+    void GetImageRegionMinMax(const Image::Pointer &image, const Image::Pointer &mask, double &minimum, double &maximum);
+
+    /**
+    * \brief Returns the quantifier that was stored for the image / mask combination and the given parameter set,
+    * or nullptr if there is none.
+    */
+    IntensityQuantifier::Pointer GetQuantifier(const Image::Pointer &image, const Image::Pointer &mask,
+      const std::string &parameterKey) const;
+
+    void SetQuantifier(const Image::Pointer &image, const Image::Pointer &mask, const std::string &parameterKey,
+      IntensityQuantifier::Pointer quantifier);
+
+    /**
+    * \brief Removes all cached entries.
+    */
+    void Clear();
+
+  protected:
+    GlobalImageFeatureCache() = default;
+    ~GlobalImageFeatureCache() override = default;
+
+  private:
+    typedef std::pair<const Image *, itk::ModifiedTimeType> ImageKeyType;
+    typedef std::pair<ImageKeyType, ImageKeyType> ImageMaskKeyType;
+    typedef std::pair<double, double> RangeType;
+
+    static ImageKeyType GetImageKey(const Image::Pointer &image);
+
+    std::map<ImageKeyType, RangeType> m_ImageRanges;
+    std::map<ImageMaskKeyType, RangeType> m_ImageRegionRanges;
+    std::map<std::pair<ImageMaskKeyType, std::string>, IntensityQuantifier::Pointer> m_Quantifiers;
+  };
+}
+
+#endif //mitkGlobalImageFeatureCache_h
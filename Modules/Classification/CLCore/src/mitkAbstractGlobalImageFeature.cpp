@@ -227,6 +227,22 @@ void  mitk::AbstractGlobalImageFeature::InitializeQuantifierFromParameters(const
 
 void  mitk::AbstractGlobalImageFeature::InitializeQuantifier(const Image::Pointer & feature, const Image::Pointer &mask, unsigned int defaultBins)
 {
+  // Without a shared cache, a local one avoids that the intensity range is calculated more than once.
+  GlobalImageFeatureCache::Pointer cache = m_FeatureCache;
+  if (cache.IsNull())
+    cache = GlobalImageFeatureCache::New();
+
+  std::stringstream parameterKey;
+  parameterKey << QuantifierParameterString() << "_Default-" << defaultBins << "_IgnoreMask-" << GetIgnoreMask();
+  m_Quantifier = cache->GetQuantifier(feature, mask, parameterKey.str());
+  if (m_Quantifier.IsNotNull())
+    return;
+
+  double imageMinimum = 0;
+  double imageMaximum = 0;
+  auto imageRange = [&]() { cache->GetImageMinMax(feature, imageMinimum, imageMaximum); };
+  auto regionRange = [&]() { cache->GetImageRegionMinMax(feature, mask, imageMinimum, imageMaximum); };
+
   m_Quantifier = IntensityQuantifier::New();
   if (GetUseMinimumIntensity() && GetUseMaximumIntensity() && GetUseBinsize())
     m_Quantifier->InitializeByBinsizeAndMaximum(GetMinimumIntensity(), GetMaximumIntensity(), GetBinsize());
@@ -236,37 +252,81 @@ void  mitk::AbstractGlobalImageFeature::InitializeQuantifier(const Image::Pointe
     m_Quantifier->InitializeByMinimumMaximum(GetMinimumIntensity(), GetMaximumIntensity(), GetBins());
   // Intialize from Image and Binsize
   else if (GetUseBinsize() && GetIgnoreMask() && GetUseMinimumIntensity())
-    m_Quantifier->InitializeByImageAndBinsizeAndMinimum(feature, GetMinimumIntensity(), GetBinsize());
+  {
+    imageRange();
+    m_Quantifier->InitializeByBinsizeAndMaximum(GetMinimumIntensity(), imageMaximum, GetBinsize());
+  }
   else if (GetUseBinsize() && GetIgnoreMask() && GetUseMaximumIntensity())
-    m_Quantifier->InitializeByImageAndBinsizeAndMaximum(feature, GetMaximumIntensity(), GetBinsize());
+  {
+    imageRange();
+    m_Quantifier->InitializeByBinsizeAndMaximum(imageMinimum, GetMaximumIntensity(), GetBinsize());
+  }
   else if (GetUseBinsize() && GetIgnoreMask())
-    m_Quantifier->InitializeByImageAndBinsize(feature, GetBinsize());
+  {
+    imageRange();
+    m_Quantifier->InitializeByBinsizeAndMaximum(imageMinimum, imageMaximum, GetBinsize());
+  }
   // Initialize form Image, Mask and Binsize
   else if (GetUseBinsize() && GetUseMinimumIntensity())
-    m_Quantifier->InitializeByImageRegionAndBinsizeAndMinimum(feature, mask, GetMinimumIntensity(), GetBinsize());
+  {
+    regionRange();
+    m_Quantifier->InitializeByBinsizeAndMaximum(GetMinimumIntensity(), imageMaximum, GetBinsize());
+  }
   else if (GetUseBinsize() && GetUseMaximumIntensity())
-    m_Quantifier->InitializeByImageRegionAndBinsizeAndMaximum(feature, mask, GetMaximumIntensity(), GetBinsize());
+  {
+    regionRange();
+    m_Quantifier->InitializeByBinsizeAndMaximum(imageMinimum, GetMaximumIntensity(), GetBinsize());
+  }
   else if (GetUseBinsize())
-    m_Quantifier->InitializeByImageRegionAndBinsize(feature, mask, GetBinsize());
+  {
+    regionRange();
+    m_Quantifier->InitializeByBinsizeAndMaximum(imageMinimum, imageMaximum, GetBinsize());
+  }
   // Intialize from Image and Bins
   else if (GetUseBins() && GetIgnoreMask() && GetUseMinimumIntensity())
-    m_Quantifier->InitializeByImageAndMinimum(feature, GetMinimumIntensity(), GetBins());
+  {
+    imageRange();
+    m_Quantifier->InitializeByMinimumMaximum(GetMinimumIntensity(), imageMaximum, GetBins());
+  }
   else if (GetUseBins() && GetIgnoreMask() && GetUseMaximumIntensity())
-    m_Quantifier->InitializeByImageAndMaximum(feature, GetMaximumIntensity(), GetBins());
+  {
+    imageRange();
+    m_Quantifier->InitializeByMinimumMaximum(imageMinimum, GetMaximumIntensity(), GetBins());
+  }
   else if (GetUseBins())
-    m_Quantifier->InitializeByImage(feature, GetBins());
+  {
+    imageRange();
+    m_Quantifier->InitializeByMinimumMaximum(imageMinimum, imageMaximum, GetBins());
+  }
   // Intialize from Image, Mask and Bins
   else if (GetUseBins() && GetUseMinimumIntensity())
-    m_Quantifier->InitializeByImageRegionAndMinimum(feature, mask, GetMinimumIntensity(), GetBins());
+  {
+    regionRange();
+    m_Quantifier->InitializeByMinimumMaximum(GetMinimumIntensity(), imageMaximum, GetBins());
+  }
   else if (GetUseBins() && GetUseMaximumIntensity())
-    m_Quantifier->InitializeByImageRegionAndMaximum(feature, mask, GetMaximumIntensity(), GetBins());
+  {
+    regionRange();
+    m_Quantifier->InitializeByMinimumMaximum(imageMinimum, GetMaximumIntensity(), GetBins());
+  }
   else if (GetUseBins())
-    m_Quantifier->InitializeByImageRegion(feature, mask, GetBins());
+  {
+    regionRange();
+    m_Quantifier->InitializeByMinimumMaximum(imageMinimum, imageMaximum, GetBins());
+  }
   // Default
   else if (GetIgnoreMask())
-    m_Quantifier->InitializeByImage(feature, GetBins());
+  {
+    imageRange();
+    m_Quantifier->InitializeByMinimumMaximum(imageMinimum, imageMaximum, GetBins());
+  }
   else
-    m_Quantifier->InitializeByImageRegion(feature, mask, defaultBins);
+  {
+    regionRange();
+    m_Quantifier->InitializeByMinimumMaximum(imageMinimum, imageMaximum, defaultBins);
+  }
+
+  cache->SetQuantifier(feature, mask, parameterKey.str(), m_Quantifier);
 }
 
 std::string mitk::AbstractGlobalImageFeature::GetCurrentFeatureEncoding()
@@ -0,0 +1,72 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkGlobalImageFeatureCache.h>
+
+mitk::GlobalImageFeatureCache::ImageKeyType mitk::GlobalImageFeatureCache::GetImageKey(const Image::Pointer &image)
+{
+  if (image.IsNull())
+    return ImageKeyType(nullptr, 0);
+  return ImageKeyType(image.GetPointer(), image->GetMTime());
+}
+
+void mitk::GlobalImageFeatureCache::GetImageMinMax(const Image::Pointer &image, double &minimum, double &maximum)
+{
+  auto key = GetImageKey(image);
+  auto iter = m_ImageRanges.find(key);
+  if (iter == m_ImageRanges.end())
+  {
+    // The quantifier determines the range exactly like the feature classes would do.
+    auto quantifier = IntensityQuantifier::New();
+    quantifier->InitializeByImage(image, 1);
+    iter = m_ImageRanges.emplace(key, RangeType(quantifier->GetMinimum(), quantifier->GetMaximum())).first;
+  }
+  minimum = iter->second.first;
+  maximum = iter->second.second;
+}
+
+void mitk::GlobalImageFeatureCache::GetImageRegionMinMax(const Image::Pointer &image, const Image::Pointer &mask,
+  double &minimum, double &maximum)
+{
+  auto key = ImageMaskKeyType(GetImageKey(image), GetImageKey(mask));
+  auto iter = m_ImageRegionRanges.find(key);
+  if (iter == m_ImageRegionRanges.end())
+  {
+    auto quantifier = IntensityQuantifier::New();
+    quantifier->InitializeByImageRegion(image, mask, 1);
+    iter = m_ImageRegionRanges.emplace(key, RangeType(quantifier->GetMinimum(), quantifier->GetMaximum())).first;
+  }
+  minimum = iter->second.first;
+  maximum = iter->second.second;
+}
+
+mitk::IntensityQuantifier::Pointer mitk::GlobalImageFeatureCache::GetQuantifier(const Image::Pointer &image,
+  const Image::Pointer &mask, const std::string &parameterKey) const
+{
+  auto iter = m_Quantifiers.find(std::make_pair(ImageMaskKeyType(GetImageKey(image), GetImageKey(mask)), parameterKey));
+  if (iter == m_Quantifiers.end())
+    return nullptr;
+  return iter->second;
+}
+
+void mitk::GlobalImageFeatureCache::SetQuantifier(const Image::Pointer &image, const Image::Pointer &mask,
+  const std::string &parameterKey, IntensityQuantifier::Pointer quantifier)
+{
+  m_Quantifiers[std::make_pair(ImageMaskKeyType(GetImageKey(image), GetImageKey(mask)), parameterKey)] = quantifier;
+}
+
+void mitk::GlobalImageFeatureCache::Clear()
+{
+  m_ImageRanges.clear();
+  m_ImageRegionRanges.clear();
+  m_Quantifiers.clear();
+}
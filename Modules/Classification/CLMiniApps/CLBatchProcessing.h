@@ -0,0 +1,155 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef CLBatchProcessing_h
+#define CLBatchProcessing_h
+
+#include "mitkCommandLineParser.h"
+#include <mitkLogMacros.h>
+#include <mitkThreadPool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Batch mode shared by the preprocessing mini apps.
+ *
+ * A manifest lists one job per line as whitespace separated file names, the output file comes last.
+ * Empty lines and lines starting with '#' are skipped. The jobs run concurrently on the mitk::ThreadPool;
+ * the thread budget is split evenly between the concurrent jobs, which pass their share to the
+ * multi-threaded ITK filters they run.
+ */
+namespace CLBatchProcessing
+{
+  struct Settings
+  {
+    unsigned int NumberOfConcurrentJobs = 1;
+    unsigned int NumberOfThreadsPerJob = 1;
+  };
+
+  inline void AddArguments(mitkCommandLineParser &parser)
+  {
+    parser.addArgument("batch", "b", mitkCommandLineParser::File, "Batch manifest:", "Text file with one job per line (file names separated by whitespace, output last). Replaces the single image arguments.", us::Any(), true, false, false, mitkCommandLineParser::Input);
+    parser.addArgument("jobs", "j", mitkCommandLineParser::Int, "Concurrent jobs:", "Number of jobs processed at the same time in batch mode (default: half the thread budget)", us::Any(), true);
+    parser.addArgument("threads", "t", mitkCommandLineParser::Int, "Thread budget:", "Number of threads shared by all jobs (default: number of cores)", us::Any(), true);
+  }
+
+  /** \brief Reads the jobs of a manifest; lines with a wrong number of columns are reported and skipped. */
+  inline std::vector<std::vector<std::string>> ReadManifest(const std::string &fileName,
+                                                            std::size_t minimumNumberOfColumns,
+                                                            std::size_t maximumNumberOfColumns)
+  {
+    std::vector<std::vector<std::string>> jobs;
+    std::ifstream file(fileName);
+    if (!file)
+    {
+      MITK_ERROR << "Cannot read batch manifest " << fileName;
+      return jobs;
+    }
+
+    std::string line;
+    for (unsigned int lineNumber = 1; std::getline(file, line); ++lineNumber)
+    {
+      std::istringstream stream(line);
+      std::vector<std::string> columns;
+      std::string column;
+      while (stream >> column)
+        columns.push_back(column);
+
+      if (columns.empty() || columns.front()[0] == '#')
+        continue;
+
+      if (columns.size() < minimumNumberOfColumns || columns.size() > maximumNumberOfColumns)
+      {
+        MITK_ERROR << fileName << ":" << lineNumber << ": expected " << minimumNumberOfColumns
+                   << (minimumNumberOfColumns != maximumNumberOfColumns ? " to " + std::to_string(maximumNumberOfColumns) : "")
+                   << " file names, skipped";
+        continue;
+      }
+      jobs.push_back(columns);
+    }
+    return jobs;
+  }
+
+  inline Settings GetSettings(std::map<std::string, us::Any> &parsedArgs, std::size_t numberOfJobs)
+  {
+    unsigned int budget = mitk::ThreadPool::GetInstance().GetNumberOfThreads();
+    if (parsedArgs.count("threads"))
+      budget = static_cast<unsigned int>(std::max(1, us::any_cast<int>(parsedArgs["threads"])));
+
+    Settings settings;
+    settings.NumberOfConcurrentJobs = std::max(1u, budget / 2);
+    if (parsedArgs.count("jobs"))
+      settings.NumberOfConcurrentJobs = static_cast<unsigned int>(std::max(1, us::any_cast<int>(parsedArgs["jobs"])));
+    settings.NumberOfConcurrentJobs =
+      static_cast<unsigned int>(std::max<std::size_t>(1, std::min<std::size_t>(settings.NumberOfConcurrentJobs, numberOfJobs)));
+    settings.NumberOfThreadsPerJob = std::max(1u, budget / settings.NumberOfConcurrentJobs);
+    return settings;
+  }
+
+  /** \brief Serializes loading and saving, which is not safe to run concurrently. */
+  inline std::mutex &GetIOMutex()
+  {
+    static std::mutex mutex;
+    return mutex;
+  }
+
+  /**
+   * \brief Calls \a process for every job, at most Settings::NumberOfConcurrentJobs at the same time.
+   *
+   * \return The number of jobs that threw an exception
+   */
+  inline std::size_t Run(const std::vector<std::vector<std::string>> &jobs,
+                         const Settings &settings,
+                         const std::function<void(const std::vector<std::string> &job)> &process)
+  {
+    MITK_INFO << "Processing " << jobs.size() << " jobs, " << settings.NumberOfConcurrentJobs
+              << " at a time with " << settings.NumberOfThreadsPerJob << " threads each";
+
+    std::atomic<std::size_t> nextJob(0);
+    std::atomic<std::size_t> numberOfFailedJobs(0);
+
+    mitk::ThreadPool::GetInstance().ParallelFor(
+      0,
+      settings.NumberOfConcurrentJobs,
+      [&](std::size_t begin, std::size_t end) {
+        for (auto slot = begin; slot < end; ++slot)
+        {
+          for (auto jobIndex = nextJob++; jobIndex < jobs.size(); jobIndex = nextJob++)
+          {
+            const auto &job = jobs[jobIndex];
+            try
+            {
+              process(job);
+              MITK_INFO << "Finished " << job.back();
+            }
+            catch (const std::exception &e)
+            {
+              MITK_ERROR << "Failed to create " << job.back() << ": " << e.what();
+              ++numberOfFailedJobs;
+            }
+          }
+        }
+      });
+
+    return numberOfFailedJobs;
+  }
+}
+
+#endif
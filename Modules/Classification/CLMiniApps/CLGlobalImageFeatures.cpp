@@ -46,11 +46,14 @@ found in the LICENSE file.
 #include <mitkCLResultWritter.h>
 #include <mitkVersion.h>
 
+#include <algorithm>
 #include <iostream>
 #include <locale>
 
 #include <itkImageDuplicator.h>
 #include <itkImageRegionIterator.h>
+#include <itkImageRegionConstIteratorWithIndex.h>
+#include <itkRegionOfInterestImageFilter.h>
 
 
 #include "itkNearestNeighborInterpolateImageFunction.h"
@@ -175,6 +178,66 @@ ResampleMask(itk::Image<TPixel, VImageDimension>* itkMoving, mitk::Image::Pointe
   mitk::GrabItkImageMemory(resampler->GetOutput(), newMask);
 }
 
+template<typename TPixel, unsigned int VImageDimension>
+static void
+CropImage(itk::Image<TPixel, VImageDimension>* itkImage, itk::ImageRegion<VImageDimension> region, mitk::Image::Pointer& newImage)
+{
+  typedef itk::Image<TPixel, VImageDimension> ImageType;
+  typedef itk::RegionOfInterestImageFilter<ImageType, ImageType> RoiFilterType;
+
+  typename RoiFilterType::Pointer roiFilter = RoiFilterType::New();
+  roiFilter->SetInput(itkImage);
+  roiFilter->SetRegionOfInterest(region);
+  roiFilter->Update();
+
+  newImage = mitk::Image::New();
+  newImage->InitializeByItk(roiFilter->GetOutput());
+  mitk::GrabItkImageMemory(roiFilter->GetOutput(), newImage);
+}
+
+// Determines the bounding box of the mask, extended by margin voxels in each direction.
+static bool
+CalculateMaskBoundingRegion(mitk::Image::Pointer mask, unsigned int margin, MaskImageType::RegionType& region)
+{
+  MaskImageType::Pointer itkMask = MaskImageType::New();
+  mitk::CastToItkImage(mask, itkMask);
+
+  MaskImageType::IndexType minIndex;
+  MaskImageType::IndexType maxIndex;
+  minIndex.Fill(itk::NumericTraits<MaskImageType::IndexValueType>::max());
+  maxIndex.Fill(itk::NumericTraits<MaskImageType::IndexValueType>::NonpositiveMin());
+  bool maskIsEmpty = true;
+
+  itk::ImageRegionConstIteratorWithIndex<MaskImageType> iter(itkMask, itkMask->GetLargestPossibleRegion());
+  while (!iter.IsAtEnd())
+  {
+    if (iter.Get() > 0)
+    {
+      auto index = iter.GetIndex();
+      for (unsigned int i = 0; i < MaskImageType::ImageDimension; ++i)
+      {
+        minIndex[i] = std::min(minIndex[i], index[i]);
+        maxIndex[i] = std::max(maxIndex[i], index[i]);
+      }
+      maskIsEmpty = false;
+    }
+    ++iter;
+  }
+  if (maskIsEmpty)
+    return false;
+
+  MaskImageType::SizeType size;
+  for (unsigned int i = 0; i < MaskImageType::ImageDimension; ++i)
+  {
+    size[i] = maxIndex[i] - minIndex[i] + 1;
+  }
+  region.SetIndex(minIndex);
+  region.SetSize(size);
+  region.PadByRadius(margin);
+  region.Crop(itkMask->GetLargestPossibleRegion());
+  return true;
+}
+
 static void
 ExtractSlicesFromImages(mitk::Image::Pointer image, mitk::Image::Pointer mask,
                         mitk::Image::Pointer maskNoNaN, mitk::Image::Pointer morphMask,
@@ -414,6 +477,7 @@ int main(int argc, char* argv[])
   parser.addArgument("direction", "dir", mitkCommandLineParser::String, "Int", "Allows to specify the direction for Cooc and RL. 0: All directions, 1: Only single direction (Test purpose), 2,3,4... Without dimension 0,1,2... ", us::Any());
   parser.addArgument("slice-wise", "slice", mitkCommandLineParser::String, "Int", "Allows to specify if the image is processed slice-wise (number giving direction) ", us::Any());
   parser.addArgument("output-mode", "omode", mitkCommandLineParser::Int, "Int", "Defines if the results of an image / slice are written in a single row (0 , default) or column (1).");
+  parser.addArgument("crop-to-mask", "crop", mitkCommandLineParser::Int, "Int", "Crops the image and the masks to the bounding box of the mask, extended by the given number of voxels, before the features are calculated. Features that use the whole image (e.g. ignore-mask-for-histogram) then refer to the cropped image.", us::Any());
 
   // Miniapp Infos
   parser.setCategory("Classification Tools");
@@ -556,6 +620,44 @@ int main(int argc, char* argv[])
   AccessByItk_2(image, CreateNoNaNMask,  mask, maskNoNaN);
   //CreateNoNaNMask(mask, image, maskNoNaN);
 
+  if (parsedArgs.count("crop-to-mask"))
+  {
+    log << " Crop to mask -";
+    int margin = us::any_cast<int>(parsedArgs["crop-to-mask"]);
+    MaskImageType::RegionType cropRegion;
+    if (image->GetDimension() != 3)
+    {
+      MITK_WARN << "Cropping is only supported for 3D images. The image is not cropped.";
+    }
+    else if (!CalculateMaskBoundingRegion(mask, std::max(margin, 0), cropRegion))
+    {
+      MITK_WARN << "The mask is empty. The image is not cropped.";
+    }
+    else
+    {
+      mitk::Image::Pointer croppedImage;
+      mitk::Image::Pointer croppedMask;
+      mitk::Image::Pointer croppedMaskNoNaN;
+      mitk::Image::Pointer croppedMorphMask;
+      AccessFixedDimensionByItk_2(image, CropImage, 3, cropRegion, croppedImage);
+      AccessFixedDimensionByItk_2(mask, CropImage, 3, cropRegion, croppedMask);
+      AccessFixedDimensionByItk_2(maskNoNaN, CropImage, 3, cropRegion, croppedMaskNoNaN);
+      if (morphMask == mask)
+      {
+        croppedMorphMask = croppedMask;
+      }
+      else
+      {
+        AccessFixedDimensionByItk_2(morphMask, CropImage, 3, cropRegion, croppedMorphMask);
+      }
+      image = croppedImage;
+      mask = croppedMask;
+      maskNoNaN = croppedMaskNoNaN;
+      morphMask = croppedMorphMask;
+      MITK_INFO << "Cropped to region " << cropRegion;
+    }
+  }
+
 
   bool sliceWise = false;
   int sliceDirection = 0;
@@ -577,9 +679,13 @@ int main(int argc, char* argv[])
     MITK_INFO << "Slice";
   }
 
+  // The features share the quantifiers and intensity ranges that are calculated for the current image / mask.
+  mitk::GlobalImageFeatureCache::Pointer featureCache = mitk::GlobalImageFeatureCache::New();
+
   log << " Configure features -";
   for (auto cFeature : features)
   {
+    cFeature->SetFeatureCache(featureCache);
     if (param.defineGlobalMinimumIntensity)
     {
       cFeature->SetMinimumIntensity(param.globalMinimumIntensity);
@@ -666,6 +772,7 @@ int main(int argc, char* argv[])
 
     mitk::AbstractGlobalImageFeature::FeatureListType stats;
 
+    featureCache->Clear();
     for (auto cFeature : features)
     {
       log << " Calculating " << cFeature->GetFeatureClassName() << " -";
@@ -29,6 +29,8 @@ found in the LICENSE file.
 
 // ----------------------- Forest Handling ----------------------
 #include <mitkVigraRandomForestClassifier.h>
+#include <mitkFlatRandomForest.h>
+#include <itksys/SystemTools.hxx>
 
 
 int main(int argc, char* argv[])
@@ -105,6 +107,8 @@ int main(int argc, char* argv[])
     int testSingleDataset = allConfig.IntValue("Data", "Test Single Dataset",0);
     std::string singleDatasetName = allConfig.Value("Data", "Single Dataset Name", "none");
     std::vector<std::string> forestVector = allConfig.Vector("Forests", 0);
+    // Stores a flat copy (.flatforest) next to every loaded forest, which is loaded much faster next time
+    int writeFlatForests = allConfig.IntValue("Forest", "Write Flat Forests", 0);
 
     //////////////////////////////////////////////////////////////////////////////
     // Read Statistic Parameter
@@ -164,7 +168,24 @@ int main(int argc, char* argv[])
 
     for (std::size_t i = 0; i < forestVector.size(); ++i)
     {
-      forest = mitk::IOUtil::Load<mitk::VigraRandomForestClassifier>(forestVector[i]);
+      // Flat forests are memory mapped and evaluated directly, other forests are loaded as vigra forests
+      mitk::FlatRandomForest::Pointer flatForest;
+      if (itksys::SystemTools::GetFilenameLastExtension(forestVector[i]) == ".flatforest")
+      {
+        flatForest = mitk::FlatRandomForest::New();
+        flatForest->Load(forestVector[i]);
+      }
+      else
+      {
+        forest = mitk::IOUtil::Load<mitk::VigraRandomForestClassifier>(forestVector[i]);
+        if (writeFlatForests > 0)
+        {
+          flatForest = mitk::FlatRandomForest::New();
+          flatForest->SetRandomForest(forest);
+          std::string flatForestPath = forestVector[i].substr(0, forestVector[i].find_last_of('.')) + ".flatforest";
+          flatForest->Write(flatForestPath);
+        }
+      }
 
       time(&now);
       seconds = std::difftime(now, lastTimePoint);
@@ -173,8 +194,17 @@ int main(int argc, char* argv[])
       time(&lastTimePoint);
 
       MITK_INFO << "Predict Test Data";
-      auto testDataNewY = forest->Predict(testDataX);
-      auto testDataNewProb = forest->GetPointWiseProbabilities();
+      Eigen::MatrixXi testDataNewY;
+      Eigen::MatrixXd testDataNewProb;
+      if (flatForest.IsNotNull())
+      {
+        testDataNewY = flatForest->Predict(testDataX, testDataNewProb);
+      }
+      else
+      {
+        testDataNewY = forest->Predict(testDataX);
+        testDataNewProb = forest->GetPointWiseProbabilities();
+      }
 
       auto maxClassValue = testDataNewProb.cols();
       std::vector<std::string> names;
@@ -10,20 +10,144 @@ found in the LICENSE file.
 
 ============================================================================*/
 
+#include "CLBatchProcessing.h"
 #include "mitkCommandLineParser.h"
 #include "mitkIOUtil.h"
 #include <mitkImageCast.h>
-#include "mitkCommandLineParser.h"
+#include <itkBSplineControlPointImageFilter.h>
+#include <itkDivideImageFilter.h>
+#include <itkExpImageFilter.h>
 #include <itkN4BiasFieldCorrectionImageFilter.h>
+#include <itkShrinkImageFilter.h>
+#include <itkVectorIndexSelectionCastImageFilter.h>
 
-#include <itkSTAPLEImageFilter.h>
+typedef itk::Image<unsigned char, 3> MaskImageType;
+typedef itk::Image<float, 3> ImageType;
+typedef itk::N4BiasFieldCorrectionImageFilter < ImageType, MaskImageType, ImageType > FilterType;
 
-int main(int argc, char* argv[])
+struct Parameters
+{
+  int NumberOfControlPoints = -1;
+  int NumberOfFittingLevels = 4;
+  int NumberOfHistogramBins = -1;
+  int SplineOrder = -1;
+  float WienerFilterNoise = -1;
+  int NumberOfMaximumIterations = 50;
+  int ShrinkFactor = 4;
+};
+
+// The bias field is estimated on a shrunk image and evaluated at full resolution afterwards
+ImageType::Pointer CorrectBiasField(ImageType *image, MaskImageType *mask, const Parameters &parameters, unsigned int numberOfThreads)
+{
+  // keep at least 16 voxels along every axis for the estimation
+  itk::FixedArray<unsigned int, 3> shrinkFactors;
+  for (unsigned int d = 0; d < 3; ++d)
+  {
+    shrinkFactors[d] = static_cast<unsigned int>(std::max(1, std::min<int>(parameters.ShrinkFactor,
+      static_cast<int>(image->GetLargestPossibleRegion().GetSize(d) / 16))));
+  }
+
+  typedef itk::ShrinkImageFilter<ImageType, ImageType> ShrinkerType;
+  ShrinkerType::Pointer shrinker = ShrinkerType::New();
+  shrinker->SetInput(image);
+  shrinker->SetShrinkFactors(shrinkFactors);
+  shrinker->SetNumberOfThreads(numberOfThreads);
+
+  typedef itk::ShrinkImageFilter<MaskImageType, MaskImageType> MaskShrinkerType;
+  MaskShrinkerType::Pointer maskShrinker = MaskShrinkerType::New();
+  maskShrinker->SetInput(mask);
+  maskShrinker->SetShrinkFactors(shrinkFactors);
+  maskShrinker->SetNumberOfThreads(numberOfThreads);
+
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(shrinker->GetOutput());
+  filter->SetMaskImage(maskShrinker->GetOutput());
+  filter->SetNumberOfThreads(numberOfThreads);
+
+  if (parameters.NumberOfControlPoints > 0)
+    filter->SetNumberOfControlPoints(parameters.NumberOfControlPoints);
+  if (parameters.NumberOfHistogramBins > 0)
+    filter->SetNumberOfHistogramBins(parameters.NumberOfHistogramBins);
+  if (parameters.SplineOrder > 0)
+    filter->SetSplineOrder(parameters.SplineOrder);
+  if (parameters.WienerFilterNoise > 0)
+    filter->SetWienerFilterNoise(parameters.WienerFilterNoise);
+
+  filter->SetNumberOfFittingLevels(parameters.NumberOfFittingLevels);
+  FilterType::VariableSizeArrayType maximumNumberOfIterations(parameters.NumberOfFittingLevels);
+  maximumNumberOfIterations.Fill(parameters.NumberOfMaximumIterations);
+  filter->SetMaximumNumberOfIterations(maximumNumberOfIterations);
+
+  filter->Update();
+
+  bool shrunk = false;
+  for (unsigned int d = 0; d < 3; ++d)
+    shrunk = shrunk || shrinkFactors[d] > 1;
+  if (!shrunk)
+  {
+    ImageType::Pointer corrected = filter->GetOutput();
+    corrected->DisconnectPipeline();
+    return corrected;
+  }
+
+  typedef itk::BSplineControlPointImageFilter<FilterType::BiasFieldControlPointLatticeType, FilterType::ScalarImageType> BSplinerType;
+  BSplinerType::Pointer bspliner = BSplinerType::New();
+  bspliner->SetInput(filter->GetLogBiasFieldControlPointLattice());
+  bspliner->SetSplineOrder(filter->GetSplineOrder());
+  bspliner->SetSize(image->GetLargestPossibleRegion().GetSize());
+  bspliner->SetOrigin(image->GetOrigin());
+  bspliner->SetDirection(image->GetDirection());
+  bspliner->SetSpacing(image->GetSpacing());
+  bspliner->SetNumberOfThreads(numberOfThreads);
+
+  typedef itk::VectorIndexSelectionCastImageFilter<FilterType::ScalarImageType, ImageType> SelectorType;
+  SelectorType::Pointer logBiasField = SelectorType::New();
+  logBiasField->SetInput(bspliner->GetOutput());
+  logBiasField->SetIndex(0);
+  logBiasField->SetNumberOfThreads(numberOfThreads);
+
+  typedef itk::ExpImageFilter<ImageType, ImageType> ExpType;
+  ExpType::Pointer biasField = ExpType::New();
+  biasField->SetInput(logBiasField->GetOutput());
+  biasField->SetNumberOfThreads(numberOfThreads);
+
+  typedef itk::DivideImageFilter<ImageType, ImageType, ImageType> DividerType;
+  DividerType::Pointer divider = DividerType::New();
+  divider->SetInput1(image);
+  divider->SetInput2(biasField->GetOutput());
+  divider->SetNumberOfThreads(numberOfThreads);
+  divider->Update();
+
+  ImageType::Pointer corrected = divider->GetOutput();
+  corrected->DisconnectPipeline();
+  return corrected;
+}
+
+void ProcessImage(const std::string &inputFile, const std::string &maskFile, const std::string &outputFile,
+                  const Parameters &parameters, unsigned int numberOfThreads)
 {
-  typedef itk::Image<unsigned char, 3> MaskImageType;
-  typedef itk::Image<float, 3> ImageType;
-  typedef itk::N4BiasFieldCorrectionImageFilter < ImageType, MaskImageType, ImageType > FilterType;
+  MaskImageType::Pointer itkMsk = MaskImageType::New();
+  ImageType::Pointer itkImage = ImageType::New();
+  {
+    std::lock_guard<std::mutex> lock(CLBatchProcessing::GetIOMutex());
+    mitk::Image::Pointer img = mitk::IOUtil::Load<mitk::Image>(maskFile);
+    mitk::CastToItkImage(img, itkMsk);
+
+    mitk::Image::Pointer img2 = mitk::IOUtil::Load<mitk::Image>(inputFile);
+    mitk::CastToItkImage(img2, itkImage);
+  }
+
+  ImageType::Pointer out = CorrectBiasField(itkImage, itkMsk, parameters, numberOfThreads);
+
+  mitk::Image::Pointer outImg = mitk::Image::New();
+  mitk::CastToMitkImage(out, outImg);
+
+  std::lock_guard<std::mutex> lock(CLBatchProcessing::GetIOMutex());
+  mitk::IOUtil::Save(outImg, outputFile);
+}
 
+int main(int argc, char* argv[])
+{
   mitkCommandLineParser parser;
   parser.setTitle("N4 Bias Field Correction");
   parser.setCategory("Classification Command Tools");
@@ -33,17 +157,18 @@ int main(int argc, char* argv[])
   parser.setArgumentPrefix("--", "-");
   // Add command line argument names
   parser.addArgument("help", "h", mitkCommandLineParser::Bool, "Help:", "Show this help text");
-  parser.addArgument("input", "i", mitkCommandLineParser::Directory, "Input file:", "Input file", us::Any(), false, false, false, mitkCommandLineParser::Input);
-  parser.addArgument("mask", "m", mitkCommandLineParser::File, "Output file:", "Mask file", us::Any(), false, false, false, mitkCommandLineParser::Output);
-  parser.addArgument("output", "o", mitkCommandLineParser::File, "Output file:", "Output file", us::Any(), false, false, false, mitkCommandLineParser::Output);
+  parser.addArgument("input", "i", mitkCommandLineParser::Directory, "Input file:", "Input file", us::Any(), true, false, false, mitkCommandLineParser::Input);
+  parser.addArgument("mask", "m", mitkCommandLineParser::File, "Output file:", "Mask file", us::Any(), true, false, false, mitkCommandLineParser::Output);
+  parser.addArgument("output", "o", mitkCommandLineParser::File, "Output file:", "Output file", us::Any(), true, false, false, mitkCommandLineParser::Output);
+  CLBatchProcessing::AddArguments(parser);
 
   parser.addArgument("number-of-controllpoints", "noc", mitkCommandLineParser::Int, "Parameter", "The noc for the point grid size defining the B-spline estimate (default 4)", us::Any(), true);
-  parser.addArgument("number-of-fitting-levels", "nofl", mitkCommandLineParser::Int, "Parameter", "Number of fitting levels for the multi-scale approach (default 1)", us::Any(), true);
-  parser.addArgument("number-of-histogram-bins", "nofl", mitkCommandLineParser::Int, "Parameter", "number of bins defining the log input intensity histogram (default 200)", us::Any(), true);
+  parser.addArgument("number-of-fitting-levels", "nofl", mitkCommandLineParser::Int, "Parameter", "Number of fitting levels for the multi-scale approach (default 4)", us::Any(), true);
+  parser.addArgument("number-of-histogram-bins", "nohb", mitkCommandLineParser::Int, "Parameter", "number of bins defining the log input intensity histogram (default 200)", us::Any(), true);
   parser.addArgument("spline-order", "so", mitkCommandLineParser::Int, "Parameter", "Define the spline order (default 3)", us::Any(), true);
   parser.addArgument("winer-filter-noise", "wfn", mitkCommandLineParser::Float, "Parameter", "Noise estimate defining the Wiener filter (default 0.01)", us::Any(), true);
-  parser.addArgument("number-of-maximum-iterations", "nomi", mitkCommandLineParser::Int, "Parameter", "Spezifies the maximum number of iterations per run", us::Any(), true);
-  // ToDo: Number Of Maximum Iterations durchschleifen
+  parser.addArgument("number-of-maximum-iterations", "nomi", mitkCommandLineParser::Int, "Parameter", "Spezifies the maximum number of iterations per fitting level (default 50)", us::Any(), true);
+  parser.addArgument("shrink-factor", "sf", mitkCommandLineParser::Int, "Parameter", "The bias field is estimated on the image shrunk by this factor (default 4, 1 disables shrinking)", us::Any(), true);
 
   std::map<std::string, us::Any> parsedArgs = parser.parseArguments(argc, argv);
 
@@ -54,64 +179,63 @@ int main(int argc, char* argv[])
     return EXIT_SUCCESS;
   }
 
-  MaskImageType::Pointer itkMsk = MaskImageType::New();
-  mitk::Image::Pointer img = mitk::IOUtil::Load<mitk::Image>(parsedArgs["mask"].ToString());
-  mitk::CastToItkImage(img, itkMsk);
-
-  ImageType::Pointer itkImage = ImageType::New();
-  mitk::Image::Pointer img2 = mitk::IOUtil::Load<mitk::Image>(parsedArgs["input"].ToString());
-  mitk::CastToItkImage(img2, itkImage);
-
-  FilterType::Pointer filter = FilterType::New();
-  filter->SetInput(itkImage);
-  filter->SetMaskImage(itkMsk);
-
-
-
+  Parameters parameters;
   if (parsedArgs.count("number-of-controllpoints") > 0)
   {
-    int variable = us::any_cast<int>(parsedArgs["maximum-iterations"]);
-    MITK_INFO << "Number of controll points: " << variable;
-    filter->SetNumberOfControlPoints(variable);
+    parameters.NumberOfControlPoints = us::any_cast<int>(parsedArgs["number-of-controllpoints"]);
+    MITK_INFO << "Number of controll points: " << parameters.NumberOfControlPoints;
   }
   if (parsedArgs.count("number-of-fitting-levels") > 0)
   {
-    int variable = us::any_cast<int>(parsedArgs["number-of-fitting-levels"]);
-    MITK_INFO << "Number of fitting levels: " << variable;
-    filter->SetNumberOfFittingLevels(variable);
+    parameters.NumberOfFittingLevels = std::max(1, us::any_cast<int>(parsedArgs["number-of-fitting-levels"]));
   }
+  MITK_INFO << "Number of fitting levels: " << parameters.NumberOfFittingLevels;
   if (parsedArgs.count("number-of-histogram-bins") > 0)
   {
-    int variable = us::any_cast<int>(parsedArgs["number-of-histogram-bins"]);
-    MITK_INFO << "Number of histogram bins: " << variable;
-    filter->SetNumberOfHistogramBins(variable);
+    parameters.NumberOfHistogramBins = us::any_cast<int>(parsedArgs["number-of-histogram-bins"]);
+    MITK_INFO << "Number of histogram bins: " << parameters.NumberOfHistogramBins;
   }
   if (parsedArgs.count("spline-order") > 0)
   {
-    int variable = us::any_cast<int>(parsedArgs["spline-order"]);
-    MITK_INFO << "Spline Order " << variable;
-    filter->SetSplineOrder(variable);
+    parameters.SplineOrder = us::any_cast<int>(parsedArgs["spline-order"]);
+    MITK_INFO << "Spline Order " << parameters.SplineOrder;
   }
   if (parsedArgs.count("winer-filter-noise") > 0)
   {
-    float variable = us::any_cast<float>(parsedArgs["winer-filter-noise"]);
-    MITK_INFO << "Number of histogram bins: " << variable;
-    filter->SetWienerFilterNoise(variable);
+    parameters.WienerFilterNoise = us::any_cast<float>(parsedArgs["winer-filter-noise"]);
+    MITK_INFO << "Wiener filter noise: " << parameters.WienerFilterNoise;
   }
   if (parsedArgs.count("number-of-maximum-iterations") > 0)
   {
-    int variable = us::any_cast<int>(parsedArgs["number-of-maximum-iterations"]);
-    MITK_INFO << "Number of Maximum Iterations: " << variable;
-    auto list = filter->GetMaximumNumberOfIterations();
-    list.Fill(variable);
-    filter->SetMaximumNumberOfIterations(list);
+    parameters.NumberOfMaximumIterations = us::any_cast<int>(parsedArgs["number-of-maximum-iterations"]);
   }
+  MITK_INFO << "Number of Maximum Iterations: " << parameters.NumberOfMaximumIterations;
+  if (parsedArgs.count("shrink-factor") > 0)
+  {
+    parameters.ShrinkFactor = std::max(1, us::any_cast<int>(parsedArgs["shrink-factor"]));
+  }
+  MITK_INFO << "Shrink factor: " << parameters.ShrinkFactor;
 
-  filter->Update();
-  auto out = filter->GetOutput();
-  mitk::Image::Pointer outImg = mitk::Image::New();
-  mitk::CastToMitkImage(out, outImg);
-  mitk::IOUtil::Save(outImg, parsedArgs["output"].ToString());
+  std::vector<std::vector<std::string>> jobs;
+  if (parsedArgs.count("batch"))
+  {
+    // input mask output
+    jobs = CLBatchProcessing::ReadManifest(parsedArgs["batch"].ToString(), 3, 3);
+  }
+  else if (parsedArgs.count("input") && parsedArgs.count("mask") && parsedArgs.count("output"))
+  {
+    jobs.push_back({parsedArgs["input"].ToString(), parsedArgs["mask"].ToString(), parsedArgs["output"].ToString()});
+  }
+  else
+  {
+    std::cout << parser.helpText();
+    return EXIT_FAILURE;
+  }
+
+  const CLBatchProcessing::Settings settings = CLBatchProcessing::GetSettings(parsedArgs, jobs.size());
+  const std::size_t numberOfFailedJobs = CLBatchProcessing::Run(jobs, settings, [&](const std::vector<std::string> &job) {
+    ProcessImage(job[0], job[1], job[2], parameters, settings.NumberOfThreadsPerJob);
+  });
 
-  return EXIT_SUCCESS;
+  return numberOfFailedJobs == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -12,6 +12,7 @@ found in the LICENSE file.
 #ifndef mitkCLResampleImageToReference_cpp
 #define mitkCLResampleImageToReference_cpp
 
+#include "CLBatchProcessing.h"
 #include "mitkCommandLineParser.h"
 #include <mitkImageAccessByItk.h>
 #include <mitkIOUtil.h>
@@ -21,71 +22,124 @@ found in the LICENSE file.
 #include <mitkImageTimeSelector.h>
 
 // ITK
+#include "itkImageAlgorithm.h"
 #include "itkLinearInterpolateImageFunction.h"
-#include "itkWindowedSincInterpolateImageFunction.h"
-#include "itkNearestNeighborInterpolateImageFunction.h"
 #include "itkIdentityTransform.h"
 #include "itkResampleImageFilter.h"
 
 
 template<typename TPixel, unsigned int VImageDimension>
 void
-ResampleImageToReferenceFunction(itk::Image<TPixel, VImageDimension>* itkReference, mitk::Image::Pointer moving, std::string ergPath)
+ResampleImageToReferenceFunction(itk::Image<TPixel, VImageDimension>* itkReference, mitk::Image::Pointer moving, mitk::Image::Pointer &result, unsigned int numberOfTiles, unsigned int numberOfThreads)
 {
   typedef itk::Image<TPixel, VImageDimension> InputImageType;
-
-  // Identify Transform
   typedef itk::IdentityTransform<double, VImageDimension> T_Transform;
-  typename T_Transform::Pointer _pTransform = T_Transform::New();
-  _pTransform->SetIdentity();
-
-  typedef itk::WindowedSincInterpolateImageFunction< InputImageType, VImageDimension> WindowedSincInterpolatorType;
-  typename WindowedSincInterpolatorType::Pointer sinc_interpolator = WindowedSincInterpolatorType::New();
-
   typedef itk::LinearInterpolateImageFunction< InputImageType> LinearInterpolateImageFunctionType;
-  typename LinearInterpolateImageFunctionType::Pointer lin_interpolator = LinearInterpolateImageFunctionType::New();
-
-  typedef itk::NearestNeighborInterpolateImageFunction< InputImageType> NearestNeighborInterpolateImageFunctionType;
-  typename NearestNeighborInterpolateImageFunctionType::Pointer nn_interpolator = NearestNeighborInterpolateImageFunctionType::New();
+  typedef itk::ResampleImageFilter<InputImageType, InputImageType>  ResampleFilterType;
 
   typename InputImageType::Pointer itkMoving = InputImageType::New();
   mitk::CastToItkImage(moving,itkMoving);
-  typedef itk::ResampleImageFilter<InputImageType, InputImageType>  ResampleFilterType;
 
-  typename ResampleFilterType::Pointer resampler = ResampleFilterType::New();
-  resampler->SetInput(itkMoving);
-  resampler->SetReferenceImage( itkReference );
-  resampler->UseReferenceImageOn();
-  resampler->SetTransform(_pTransform);
-  //if ( sincInterpol)
-  //  resampler->SetInterpolator(sinc_interpolator);
-  //else
-    resampler->SetInterpolator(lin_interpolator);
-
-  resampler->Update();
-
-  // Convert back to mitk
-  mitk::Image::Pointer result = mitk::Image::New();
-  result->InitializeByItk(resampler->GetOutput());
-  GrabItkImageMemory(resampler->GetOutput(), result);
-  MITK_INFO << "writing result to: " << ergPath;
-  mitk::IOUtil::Save(result, ergPath);
-  //return result;
+  const typename InputImageType::RegionType region = itkReference->GetLargestPossibleRegion();
+  const unsigned int slabAxis = VImageDimension - 1;
+  numberOfTiles = std::max(1u, std::min<unsigned int>(numberOfTiles, region.GetSize(slabAxis)));
+
+  if (numberOfTiles == 1)
+  {
+    typename T_Transform::Pointer _pTransform = T_Transform::New();
+    _pTransform->SetIdentity();
+
+    typename ResampleFilterType::Pointer resampler = ResampleFilterType::New();
+    resampler->SetInput(itkMoving);
+    resampler->SetReferenceImage( itkReference );
+    resampler->UseReferenceImageOn();
+    resampler->SetTransform(_pTransform);
+    resampler->SetInterpolator(LinearInterpolateImageFunctionType::New());
+    resampler->SetNumberOfThreads(numberOfThreads);
+    resampler->Update();
+
+    result = mitk::GrabItkImageMemory(resampler->GetOutput());
+    return;
+  }
+
+  // Very large images are resampled in slabs along the last axis. Every slab has its own resampler and
+  // interpolator, so the slabs run on the thread pool in parallel and each resampler only holds its slab.
+  typename InputImageType::Pointer itkResult = InputImageType::New();
+  itkResult->CopyInformation(itkReference);
+  itkResult->SetRegions(region);
+  itkResult->Allocate();
+
+  mitk::ThreadPool::GetInstance().ParallelFor(0, numberOfTiles, [&](std::size_t begin, std::size_t end) {
+    for (auto tile = begin; tile < end; ++tile)
+    {
+      typename InputImageType::RegionType slab = region;
+      const auto slabBegin = region.GetSize(slabAxis) * tile / numberOfTiles;
+      const auto slabEnd = region.GetSize(slabAxis) * (tile + 1) / numberOfTiles;
+      slab.SetIndex(slabAxis, region.GetIndex(slabAxis) + slabBegin);
+      slab.SetSize(slabAxis, slabEnd - slabBegin);
+
+      // every resampler propagates its own requested region, so it gets a view of the shared moving image
+      typename InputImageType::Pointer movingView = InputImageType::New();
+      movingView->CopyInformation(itkMoving);
+      movingView->SetRegions(itkMoving->GetLargestPossibleRegion());
+      movingView->SetPixelContainer(itkMoving->GetPixelContainer());
+
+      typename T_Transform::Pointer _pTransform = T_Transform::New();
+      _pTransform->SetIdentity();
+
+      typename ResampleFilterType::Pointer resampler = ResampleFilterType::New();
+      resampler->SetInput(movingView);
+      resampler->SetTransform(_pTransform);
+      resampler->SetInterpolator(LinearInterpolateImageFunctionType::New());
+      resampler->SetOutputOrigin(itkReference->GetOrigin());
+      resampler->SetOutputSpacing(itkReference->GetSpacing());
+      resampler->SetOutputDirection(itkReference->GetDirection());
+      resampler->SetOutputStartIndex(slab.GetIndex());
+      resampler->SetSize(slab.GetSize());
+      resampler->SetNumberOfThreads(1);
+      resampler->Update();
+
+      itk::ImageAlgorithm::Copy(resampler->GetOutput(), itkResult.GetPointer(), slab, slab);
+    }
+  });
+
+  result = mitk::GrabItkImageMemory(itkResult);
+}
+
+void ProcessImage(const std::string &fixFile, const std::string &movingFile, const std::string &outputFile,
+                  unsigned int numberOfTiles, unsigned int numberOfThreads)
+{
+  mitk::Image::Pointer fix;
+  mitk::Image::Pointer moving;
+  {
+    std::lock_guard<std::mutex> lock(CLBatchProcessing::GetIOMutex());
+    fix = mitk::IOUtil::Load<mitk::Image>(fixFile);
+    moving = mitk::IOUtil::Load<mitk::Image>(movingFile);
+  }
+
+  mitk::Image::Pointer result;
+  AccessByItk_n(fix, ResampleImageToReferenceFunction, (moving, result, numberOfTiles, numberOfThreads));
+
+  std::lock_guard<std::mutex> lock(CLBatchProcessing::GetIOMutex());
+  MITK_INFO << "writing result to: " << outputFile;
+  mitk::IOUtil::Save(result, outputFile);
 }
 
 int main(int argc, char* argv[])
 {
   mitkCommandLineParser parser;
   parser.setArgumentPrefix("--", "-");
-  // required params
-  parser.addArgument("fix", "f", mitkCommandLineParser::Image, "Input Image", "Path to the input VTK polydata", us::Any(), false, false, false, mitkCommandLineParser::Input);
-  parser.addArgument("moving", "m", mitkCommandLineParser::File, "Output text file", "Target file. The output statistic is appended to this file.", us::Any(), false, false, false, mitkCommandLineParser::Output);
-  parser.addArgument("output", "o", mitkCommandLineParser::File, "Extension", "File extension. Default is .nii.gz", us::Any(), false, false, false, mitkCommandLineParser::Output);
+  // required params, unless a batch manifest is given
+  parser.addArgument("fix", "f", mitkCommandLineParser::Image, "Input Image", "Path to the input VTK polydata", us::Any(), true, false, false, mitkCommandLineParser::Input);
+  parser.addArgument("moving", "m", mitkCommandLineParser::File, "Output text file", "Target file. The output statistic is appended to this file.", us::Any(), true, false, false, mitkCommandLineParser::Output);
+  parser.addArgument("output", "o", mitkCommandLineParser::File, "Extension", "File extension. Default is .nii.gz", us::Any(), true, false, false, mitkCommandLineParser::Output);
+  parser.addArgument("tiles", "tiles", mitkCommandLineParser::Int, "Tiles", "Resample the image in this many slabs in parallel, for very large images (default 1)", us::Any(), true);
+  CLBatchProcessing::AddArguments(parser);
 
   // Miniapp Infos
   parser.setCategory("Classification Tools");
   parser.setTitle("Resample Image To Reference");
-  parser.setDescription("Resamples an image (moving) to an given image (fix) without additional registration.");
+  parser.setDescription("Resamples an image (moving) to an given image (fix) without additional registration. A batch manifest lists fix, moving and output file per line.");
   parser.setContributor("German Cancer Research Center (DKFZ)");
 
   std::map<std::string, us::Any> parsedArgs = parser.parseArguments(argc, argv);
@@ -99,12 +153,34 @@ int main(int argc, char* argv[])
     return EXIT_SUCCESS;
   }
 
-  mitk::Image::Pointer fix = mitk::IOUtil::Load<mitk::Image>(parsedArgs["fix"].ToString());
-  mitk::Image::Pointer moving = mitk::IOUtil::Load<mitk::Image>(parsedArgs["moving"].ToString());
-  mitk::Image::Pointer erg = mitk::Image::New();
+  unsigned int numberOfTiles = 1;
+  if (parsedArgs.count("tiles"))
+  {
+    numberOfTiles = static_cast<unsigned int>(std::max(1, us::any_cast<int>(parsedArgs["tiles"])));
+  }
+
+  std::vector<std::vector<std::string>> jobs;
+  if (parsedArgs.count("batch"))
+  {
+    // fix moving output
+    jobs = CLBatchProcessing::ReadManifest(parsedArgs["batch"].ToString(), 3, 3);
+  }
+  else if (parsedArgs.count("fix") && parsedArgs.count("moving") && parsedArgs.count("output"))
+  {
+    jobs.push_back({parsedArgs["fix"].ToString(), parsedArgs["moving"].ToString(), parsedArgs["output"].ToString()});
+  }
+  else
+  {
+    std::cout << parser.helpText();
+    return EXIT_FAILURE;
+  }
 
-  AccessByItk_2(fix, ResampleImageToReferenceFunction, moving, parsedArgs["output"].ToString());
+  const CLBatchProcessing::Settings settings = CLBatchProcessing::GetSettings(parsedArgs, jobs.size());
+  const std::size_t numberOfFailedJobs = CLBatchProcessing::Run(jobs, settings, [&](const std::vector<std::string> &job) {
+    ProcessImage(job[0], job[1], job[2], numberOfTiles, settings.NumberOfThreadsPerJob);
+  });
 
+  return numberOfFailedJobs == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 
 
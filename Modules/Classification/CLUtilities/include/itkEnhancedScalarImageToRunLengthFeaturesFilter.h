@@ -170,6 +170,10 @@ namespace itk
       itkGetConstReferenceObjectMacro(FeatureMeans, FeatureValueVector);
       itkGetConstReferenceObjectMacro(FeatureStandardDeviations, FeatureValueVector);
 
+      /** Return the features of the run length matrix of all offsets combined. They are
+      determined by every full computation, also without CombinedFeatureCalculation. */
+      itkGetConstReferenceObjectMacro(CombinedFeatures, FeatureValueVector);
+
       /** Set the desired feature set. Optional, for default value see above. */
       itkSetConstObjectMacro(RequestedFeatures, FeatureNameVector);
       itkGetConstObjectMacro(RequestedFeatures, FeatureNameVector);
@@ -230,6 +234,7 @@ namespace itk
 
       FeatureValueVectorPointer     m_FeatureMeans;
       FeatureValueVectorPointer     m_FeatureStandardDeviations;
+      FeatureValueVectorPointer     m_CombinedFeatures;
       FeatureNameVectorConstPointer m_RequestedFeatures;
       OffsetVectorConstPointer      m_Offsets;
       bool                          m_FastCalculations;
@@ -35,6 +35,8 @@ found in the LICENSE file.
 #include <itkImageRegionConstIterator.h>
 #include "vnl/vnl_math.h"
 
+#include <algorithm>
+
 namespace itk
 {
   namespace Statistics
@@ -55,6 +57,7 @@ namespace itk
       this->m_RunLengthMatrixGenerator = RunLengthMatrixFilterType::New();
       this->m_FeatureMeans = FeatureValueVector::New();
       this->m_FeatureStandardDeviations = FeatureValueVector::New();
+      this->m_CombinedFeatures = FeatureValueVector::New();
 
       // Set the requested features to the default value:
       // {Energy, Entropy, InverseDifferenceMoment, Inertia, ClusterShade,
@@ -158,29 +161,21 @@ namespace itk
       typedef typename RunLengthFeaturesFilterType::RunLengthFeatureName
         InternalRunLengthFeatureName;
 
+      // The matrices of all offsets are calculated by a single update of the
+      // matrix generator; its output is the matrix of all offsets combined.
       OffsetVectorPointer offsets = OffsetVector::New();
-      if (m_CombinedFeatureCalculation)
+      for (unsigned int i = 0; i < this->m_Offsets->Size(); ++i)
       {
-        for (int i = 0; i < this->m_Offsets->Size(); ++i)
-        {
-          offsets->push_back(m_Offsets->ElementAt(i));
-        }
+        offsets->push_back(m_Offsets->ElementAt(i));
       }
+      this->m_RunLengthMatrixGenerator->SetOffsets(offsets);
+      this->m_RunLengthMatrixGenerator->Update();
 
-
-      for( offsetIt = this->m_Offsets->Begin(), offsetNum = 0;
-        offsetIt != this->m_Offsets->End(); offsetIt++, offsetNum++ )
+      auto calculateFeatures = [&](const HistogramType *histogram, double *histogramFeatures)
       {
-        this->m_RunLengthMatrixGenerator->SetOffset(offsetIt.Value());
-        if (m_CombinedFeatureCalculation)
-        {
-          this->m_RunLengthMatrixGenerator->SetOffsets(offsets);
-        }
-        this->m_RunLengthMatrixGenerator->Update();
         typename RunLengthFeaturesFilterType::Pointer runLengthMatrixCalculator =
           RunLengthFeaturesFilterType::New();
-        runLengthMatrixCalculator->SetInput(
-          this->m_RunLengthMatrixGenerator->GetOutput() );
+        runLengthMatrixCalculator->SetInput(histogram);
         runLengthMatrixCalculator->SetNumberOfVoxels(numberOfVoxels);
         runLengthMatrixCalculator->Update();
 
@@ -188,14 +183,32 @@ namespace itk
         for( fnameIt = this->m_RequestedFeatures->Begin(), featureNum = 0;
           fnameIt != this->m_RequestedFeatures->End(); fnameIt++, featureNum++ )
         {
-          features[offsetNum][featureNum] = runLengthMatrixCalculator->GetFeature(
+          histogramFeatures[featureNum] = runLengthMatrixCalculator->GetFeature(
             ( InternalRunLengthFeatureName )fnameIt.Value() );
         }
-        if (m_CombinedFeatureCalculation)
+      };
+
+      double *combinedFeatures = new double[numFeatures];
+      calculateFeatures(this->m_RunLengthMatrixGenerator->GetOutput(), combinedFeatures);
+      this->m_CombinedFeatures->clear();
+      for( featureNum = 0; featureNum < numFeatures; featureNum++ )
+      {
+        this->m_CombinedFeatures->push_back( combinedFeatures[featureNum] );
+      }
+
+      if (m_CombinedFeatureCalculation)
+      {
+        std::copy(combinedFeatures, combinedFeatures + numFeatures, features[0]);
+      }
+      else
+      {
+        for( offsetIt = this->m_Offsets->Begin(), offsetNum = 0;
+          offsetIt != this->m_Offsets->End(); offsetIt++, offsetNum++ )
         {
-          break;
+          calculateFeatures(this->m_RunLengthMatrixGenerator->GetOffsetOutput(offsetNum), features[offsetNum]);
         }
       }
+      delete[] combinedFeatures;
 
       // Now get the mean and deviaton of each feature across the offsets.
       this->m_FeatureMeans->clear();
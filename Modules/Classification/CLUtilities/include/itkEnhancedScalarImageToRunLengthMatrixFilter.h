@@ -34,6 +34,9 @@ found in the LICENSE file.
 #include "itkHistogram.h"
 #include "itkNumericTraits.h"
 #include "itkVectorContainer.h"
+#include "itkMultiThreader.h"
+
+#include <vector>
 
 namespace itk
 {
@@ -234,6 +237,12 @@ namespace itk
       /** method to get the Histogram */
       const HistogramType * GetOutput() const;
 
+      /**
+      * Returns the run length matrix of a single offset (in the order of GetOffsets())
+      * of the last update. The output is the sum of the matrices of all offsets.
+      */
+      const HistogramType * GetOffsetOutput( unsigned int offsetNumber ) const;
+
       /**
       * Set the pixel value of the mask that should be considered "inside" the
       * object. Defaults to 1.
@@ -265,6 +274,16 @@ namespace itk
       * */
       void NormalizeOffsetDirection(OffsetType &offset);
 
+      /**
+      * Calculates the run length matrix of a single (normalized) offset. The
+      * offsets are distributed over the threads, all offsets of a thread are
+      * processed with the same precomputed intensity bins.
+      */
+      void ComputeOffsetOutput( const OffsetType &offset, HistogramType *histogram,
+        std::vector<char> &alreadyVisited ) const;
+
+      static ITK_THREAD_RETURN_TYPE ThreaderCallback( void *arg );
+
     private:
 
       unsigned int             m_NumberOfBinsPerAxis;
@@ -277,6 +296,12 @@ namespace itk
       MeasurementVectorType    m_LowerBound;
       MeasurementVectorType    m_UpperBound;
       OffsetVectorPointer      m_Offsets;
+
+      /** Run length matrices of the single offsets of the last update */
+      std::vector<HistogramPointer> m_OffsetOutputs;
+      std::vector<OffsetType>       m_NormalizedOffsets;
+      /** Intensity bin of every pixel of the requested region, -1 if the pixel is not considered */
+      std::vector<int>              m_PixelBins;
     };
   } // end of namespace Statistics
 } // end of namespace itk
@@ -32,11 +32,13 @@ found in the LICENSE file.
 
 #include "itkEnhancedScalarImageToRunLengthMatrixFilter.h"
 
-#include "itkConstNeighborhoodIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkNeighborhood.h"
 #include "vnl/vnl_math.h"
 #include "itkMacro.h"
 
+#include <algorithm>
+
 namespace itk
 {
   namespace Statistics
@@ -141,6 +143,20 @@ namespace itk
       return HistogramType::New().GetPointer();
     }
 
+    template<typename TImageType, typename THistogramFrequencyContainer>
+    const typename EnhancedScalarImageToRunLengthMatrixFilter<TImageType,
+      THistogramFrequencyContainer >::HistogramType *
+      EnhancedScalarImageToRunLengthMatrixFilter<TImageType, THistogramFrequencyContainer>
+      ::GetOffsetOutput( unsigned int offsetNumber ) const
+    {
+      if ( offsetNumber >= this->m_OffsetOutputs.size() )
+      {
+        itkExceptionMacro( "No run length matrix available for offset number " << offsetNumber
+          << ". The filter has " << this->m_OffsetOutputs.size() << " offset outputs." );
+      }
+      return this->m_OffsetOutputs[offsetNumber];
+    }
+
     template<typename TImageType, typename THistogramFrequencyContainer>
     void
       EnhancedScalarImageToRunLengthMatrixFilter<TImageType, THistogramFrequencyContainer>
@@ -150,6 +166,7 @@ namespace itk
         static_cast<HistogramType *>( this->ProcessObject::GetOutput( 0 ) );
 
       const ImageType * inputImage = this->GetInput();
+      const ImageType * maskImage = this->GetMaskImage();
 
       // First, create an appropriate histogram with the right number of bins
       // and mins and maxes correct for the image type.
@@ -162,190 +179,199 @@ namespace itk
       this->m_UpperBound[1] = this->m_MaxDistance;
       output->Initialize( size, this->m_LowerBound, this->m_UpperBound );
 
-      MeasurementVectorType run( output->GetMeasurementVectorSize() );
-      typename HistogramType::IndexType hIndex;
+      // The intensity bin of every pixel is determined only once for all offsets.
+      // Pixels with invalid values, with values outside of the histogram range or
+      // outside of the mask are never part of a run.
+      const RegionType region = inputImage->GetRequestedRegion();
+      this->m_PixelBins.assign( region.GetNumberOfPixels(), -1 );
 
-      // Iterate over all of those pixels and offsets, adding each
-      // distance/intensity pair to the histogram
-
-      typedef ConstNeighborhoodIterator<ImageType> NeighborhoodIteratorType;
-      typename NeighborhoodIteratorType::RadiusType radius;
-      radius.Fill( 1 );
-      NeighborhoodIteratorType neighborIt( radius,
-        inputImage, inputImage->GetRequestedRegion() );
+      MeasurementVectorType measurement( output->GetMeasurementVectorSize() );
+      measurement[1] = this->m_MinDistance;
+      typename HistogramType::IndexType hIndex;
 
-      // this temp image has the same dimension for each offset
-      // moving the allocation out of loop of offsets
-      // while keeping FillBuffer with boolean false in each loop
-      typedef Image<bool, ImageDimension> BoolImageType;
-      typename BoolImageType::Pointer alreadyVisitedImage = BoolImageType::New();
-      alreadyVisitedImage->CopyInformation( inputImage );
-      alreadyVisitedImage->SetRegions( inputImage->GetRequestedRegion() );
-      alreadyVisitedImage->Allocate();
+      ImageRegionConstIteratorWithIndex<ImageType> pixelIt( inputImage, region );
+      for ( SizeValueType pixel = 0; !pixelIt.IsAtEnd(); ++pixelIt, ++pixel )
+      {
+        const PixelType pixelIntensity = pixelIt.Get();
+        if ( pixelIntensity != pixelIntensity || // Check for invalid values
+          pixelIntensity < this->m_Min ||
+          pixelIntensity > this->m_Max ||
+          ( maskImage && maskImage->GetPixel( pixelIt.GetIndex() ) != this->m_InsidePixelValue ) )
+        {
+          continue;
+        }
+        measurement[0] = pixelIntensity;
+        if ( output->GetIndex( measurement, hIndex ) )
+        {
+          this->m_PixelBins[pixel] = hIndex[0];
+        }
+      }
 
+      this->m_NormalizedOffsets.clear();
+      this->m_OffsetOutputs.clear();
       typename OffsetVector::ConstIterator offsets;
       for( offsets = this->GetOffsets()->Begin();
         offsets != this->GetOffsets()->End(); offsets++ )
       {
-        alreadyVisitedImage->FillBuffer( false );
-
-        neighborIt.GoToBegin();
         OffsetType offset = offsets.Value();
+        this->NormalizeOffsetDirection( offset );
+        this->m_NormalizedOffsets.push_back( offset );
+
+        HistogramPointer offsetOutput = HistogramType::New();
+        offsetOutput->SetMeasurementVectorSize( output->GetMeasurementVectorSize() );
+        offsetOutput->Initialize( size, this->m_LowerBound, this->m_UpperBound );
+        this->m_OffsetOutputs.push_back( offsetOutput );
+      }
 
-        this->NormalizeOffsetDirection(offset);
+      // Every offset is independent of the others, so the offsets are
+      // distributed over the threads and each thread fills the matrices of its offsets.
+      const ThreadIdType numberOfThreads = std::min<ThreadIdType>( this->GetNumberOfThreads(),
+        static_cast<ThreadIdType>( this->m_NormalizedOffsets.size() ) );
+      if ( numberOfThreads > 0 )
+      {
+        this->GetMultiThreader()->SetNumberOfThreads( numberOfThreads );
+        this->GetMultiThreader()->SetSingleMethod( this->ThreaderCallback, this );
+        this->GetMultiThreader()->SingleMethodExecute();
+      }
 
-        for( neighborIt.GoToBegin(); !neighborIt.IsAtEnd(); ++neighborIt )
+      for ( std::size_t offsetNum = 0; offsetNum < this->m_OffsetOutputs.size(); ++offsetNum )
+      {
+        const HistogramType *offsetOutput = this->m_OffsetOutputs[offsetNum];
+        for ( typename HistogramType::InstanceIdentifier id = 0; id < offsetOutput->Size(); ++id )
         {
-          const PixelType centerPixelIntensity = neighborIt.GetCenterPixel();
-          if (centerPixelIntensity != centerPixelIntensity) // Check for invalid values
-          {
-            continue;
-          }
-          IndexType centerIndex = neighborIt.GetIndex();
-          if( centerPixelIntensity < this->m_Min ||
-            centerPixelIntensity > this->m_Max ||
-            alreadyVisitedImage->GetPixel( centerIndex ) || ( this->GetMaskImage() &&
-            this->GetMaskImage()->GetPixel( centerIndex ) !=
-            this->m_InsidePixelValue ) )
+          const typename HistogramType::AbsoluteFrequencyType frequency = offsetOutput->GetFrequency( id );
+          if ( frequency > 0 )
           {
-            continue; // don't put a pixel in the histogram if the value
-            // is out-of-bounds or is outside the mask.
+            output->IncreaseFrequency( id, frequency );
           }
+        }
+      }
 
-          itkDebugMacro("===> offset = " << offset << std::endl);
-
-          MeasurementType centerBinMin = this->GetOutput()->
-            GetBinMinFromValue( 0, centerPixelIntensity );
-          MeasurementType centerBinMax = this->GetOutput()->
-            GetBinMaxFromValue( 0, centerPixelIntensity );
-          MeasurementType lastBinMax = this->GetOutput()->
-            GetDimensionMaxs( 0 )[ this->GetOutput()->GetSize( 0 ) - 1 ];
-
-          PixelType pixelIntensity( NumericTraits<PixelType>::ZeroValue() );
-          IndexType index;
+      std::vector<int>().swap( this->m_PixelBins );
+    }
 
-          int steps = 0;
-          index = centerIndex + offset;
-          IndexType lastGoodIndex = centerIndex;
-          bool runLengthSegmentAlreadyVisited = false;
+    template<typename TImageType, typename THistogramFrequencyContainer>
+    ITK_THREAD_RETURN_TYPE
+      EnhancedScalarImageToRunLengthMatrixFilter<TImageType, THistogramFrequencyContainer>
+      ::ThreaderCallback( void *arg )
+    {
+      MultiThreader::ThreadInfoStruct *threadInfo = static_cast<MultiThreader::ThreadInfoStruct *>( arg );
+      const Self *filter = static_cast<const Self *>( threadInfo->UserData );
 
-          // Scan from the current pixel at index, following
-          // the direction of offset. Run length is computed as the
-          // length of continuous pixels whose pixel values are
-          // in the same bin.
+      std::vector<char> alreadyVisited( filter->m_PixelBins.size() );
+      for ( std::size_t offsetNum = threadInfo->ThreadID; offsetNum < filter->m_NormalizedOffsets.size();
+        offsetNum += threadInfo->NumberOfThreads )
+      {
+        filter->ComputeOffsetOutput( filter->m_NormalizedOffsets[offsetNum],
+          filter->m_OffsetOutputs[offsetNum].GetPointer(), alreadyVisited );
+      }
+      return ITK_THREAD_RETURN_VALUE;
+    }
 
-          while ( inputImage->GetRequestedRegion().IsInside(index) )
-          {
-            pixelIntensity = inputImage->GetPixel(index);
-            // For the same offset, each run length segment can
-            // only be visited once
-            if (alreadyVisitedImage->GetPixel( index ) )
-            {
-              runLengthSegmentAlreadyVisited = true;
-              break;
-            }
-            if (pixelIntensity != pixelIntensity)
-            {
-              break;
-            }
+    template<typename TImageType, typename THistogramFrequencyContainer>
+    void
+      EnhancedScalarImageToRunLengthMatrixFilter<TImageType, THistogramFrequencyContainer>
+      ::ComputeOffsetOutput( const OffsetType &offset, HistogramType *histogram,
+        std::vector<char> &alreadyVisited ) const
+    {
+      const ImageType * inputImage = this->GetInput();
+      const RegionType region = inputImage->GetRequestedRegion();
+      const IndexType regionIndex = region.GetIndex();
 
+      OffsetValueType strides[ImageDimension];
+      strides[0] = 1;
+      for ( unsigned int i = 1; i < ImageDimension; ++i )
+      {
+        strides[i] = strides[i - 1] * region.GetSize( i - 1 );
+      }
+      auto pixelNumber = [&]( const IndexType &index )
+      {
+        OffsetValueType number = 0;
+        for ( unsigned int i = 0; i < ImageDimension; ++i )
+        {
+          number += ( index[i] - regionIndex[i] ) * strides[i];
+        }
+        return number;
+      };
 
-            // Special attention paid to boundaries of bins.
-            // For the last bin,
-            // it is left close and right close (following the previous
-            // gerrit patch).
-            // For all
-            // other bins,
-            // the bin is left close and right open.
+      std::fill( alreadyVisited.begin(), alreadyVisited.end(), 0 );
 
-            if ( pixelIntensity >= centerBinMin
-              && ( pixelIntensity < centerBinMax || ( pixelIntensity == centerBinMax && centerBinMax == lastBinMax ) )
-              && (!this->GetMaskImage() || this->GetMaskImage()->GetPixel(index) == this->m_InsidePixelValue))
-            {
-              alreadyVisitedImage->SetPixel( index, true );
-              lastGoodIndex = index;
-              index += offset;
-              steps++;
-            }
-            else
-            {
-              break;
-            }
-          }
+      MeasurementVectorType run( histogram->GetMeasurementVectorSize() );
+      typename HistogramType::IndexType hIndex;
 
-          if ( runLengthSegmentAlreadyVisited )
+      ImageRegionConstIteratorWithIndex<ImageType> centerIt( inputImage, region );
+      for ( SizeValueType centerPixel = 0; !centerIt.IsAtEnd(); ++centerIt, ++centerPixel )
+      {
+        const int centerBin = this->m_PixelBins[centerPixel];
+        if ( centerBin < 0 || alreadyVisited[centerPixel] )
+        {
+          continue; // don't put a pixel in the histogram if the value
+          // is out-of-bounds or is outside the mask.
+        }
+        const IndexType centerIndex = centerIt.GetIndex();
+
+        // Scan from the current pixel at index, following
+        // the direction of offset. Run length is computed as the
+        // length of continuous pixels whose pixel values are
+        // in the same bin.
+        int steps = 0;
+        bool runLengthSegmentAlreadyVisited = false;
+        IndexType index = centerIndex + offset;
+        while ( region.IsInside( index ) )
+        {
+          const OffsetValueType pixel = pixelNumber( index );
+          // For the same offset, each run length segment can
+          // only be visited once
+          if ( alreadyVisited[pixel] )
           {
-            MITK_INFO << "Already visited 1 " << index;
-            continue;
+            runLengthSegmentAlreadyVisited = true;
+            break;
           }
-          IndexType lastGoodIndex2 = lastGoodIndex;
-          index = centerIndex - offset;
-          lastGoodIndex = centerIndex;
-          while ( inputImage->GetRequestedRegion().IsInside(index) )
+          if ( this->m_PixelBins[pixel] != centerBin )
           {
-            pixelIntensity = inputImage->GetPixel(index);
-            if (pixelIntensity != pixelIntensity)
-            {
-              break;
-            }
-            if (alreadyVisitedImage->GetPixel( index ) )
-            {
-              if (pixelIntensity >= centerBinMin
-                && (pixelIntensity < centerBinMax || (pixelIntensity == centerBinMax && centerBinMax == lastBinMax)))
-              {
-                runLengthSegmentAlreadyVisited = true;
-              }
-              break;
-            }
+            break;
+          }
+          alreadyVisited[pixel] = 1;
+          index += offset;
+          steps++;
+        }
+        if ( runLengthSegmentAlreadyVisited )
+        {
+          continue;
+        }
 
-            if ( pixelIntensity >= centerBinMin
-              && ( pixelIntensity < centerBinMax || ( pixelIntensity == centerBinMax && centerBinMax == lastBinMax ) )
-              && (!this->GetMaskImage() || this->GetMaskImage()->GetPixel(index) == this->m_InsidePixelValue))
+        index = centerIndex - offset;
+        while ( region.IsInside( index ) )
+        {
+          const OffsetValueType pixel = pixelNumber( index );
+          if ( alreadyVisited[pixel] )
+          {
+            if ( this->m_PixelBins[pixel] == centerBin )
             {
-              alreadyVisitedImage->SetPixel( index, true );
-              lastGoodIndex = index;
-              steps++;
-              index -= offset;
+              runLengthSegmentAlreadyVisited = true;
             }
-            else
-              break;
+            break;
           }
-          if (runLengthSegmentAlreadyVisited)
+          if ( this->m_PixelBins[pixel] != centerBin )
           {
-            MITK_INFO << "Already visited 2 " << index;
-            continue;
-          }
-          PointType centerPoint;
-          inputImage->TransformIndexToPhysicalPoint(
-            centerIndex, centerPoint );
-          PointType point;
-          inputImage->TransformIndexToPhysicalPoint( lastGoodIndex, point );
-          PointType point2;
-          inputImage->TransformIndexToPhysicalPoint( lastGoodIndex2, point2 );
-
-          run[0] = centerPixelIntensity;
-          run[1] = steps;
-          //run[1] = point.EuclideanDistanceTo( point2 );
-
-          if( run[1] >= this->m_MinDistance && run[1] <= this->m_MaxDistance )
-          {
-            output->GetIndex( run, hIndex );
-            output->IncreaseFrequencyOfIndex( hIndex, 1 );
-
-            itkDebugStatement(typename HistogramType::IndexType tempMeasurementIndex;)
-              itkDebugStatement(output->GetIndex(run,tempMeasurementIndex);)
-              itkDebugMacro( "centerIndex<->index: "
-              << static_cast<int>( centerPixelIntensity )
-              << "@"<< centerIndex
-              << "<->" << static_cast<int>( pixelIntensity ) << "@" << index
-              <<", Bin# " << tempMeasurementIndex
-              << ", Measurement: (" << run[0] << ", " << run[1] << ")"
-              << ", Center bin [" << this->GetOutput()->GetBinMinFromValue( 0, run[0] )
-              << "," << this->GetOutput()->GetBinMaxFromValue( 0, run[0] ) << "]"
-              << "~[" << this->GetOutput()->GetBinMinFromValue( 1, run[1] )
-              << "," << this->GetOutput()->GetBinMaxFromValue( 1, run[1] ) << "]"
-              << std::endl );
+            break;
           }
+          alreadyVisited[pixel] = 1;
+          index -= offset;
+          steps++;
+        }
+        if ( runLengthSegmentAlreadyVisited )
+        {
+          continue;
+        }
+
+        run[0] = centerIt.Get();
+        run[1] = steps;
+
+        if( run[1] >= this->m_MinDistance && run[1] <= this->m_MaxDistance &&
+          histogram->GetIndex( run, hIndex ) )
+        {
+          histogram->IncreaseFrequencyOfIndex( hIndex, 1 );
         }
       }
     }
@@ -5,10 +5,13 @@
 
 #include <itkNeighborhoodIterator.h>
 #include <itkImageRegionIterator.h>
+#include <itkImageRegionConstIteratorWithIndex.h>
 #include <itkImageIterator.h>
 #include "itkMinimumMaximumImageCalculator.h"
 
+#include <algorithm>
 #include <limits>
+#include <vector>
 
 template< class TInputImageType, class TOuputImageType>
 itk::LocalStatisticFilter<TInputImageType, TOuputImageType>::LocalStatisticFilter():
@@ -38,8 +41,11 @@ template< class TInputImageType, class TOuputImageType>
 void
 itk::LocalStatisticFilter<TInputImageType, TOuputImageType>::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread, ThreadIdType /*threadId*/)
 {
-  typedef itk::ImageRegionIterator<TInputImageType> IteratorType;
-  typedef itk::ConstNeighborhoodIterator<TInputImageType> ConstIteratorType;
+  typedef itk::ImageRegionIterator<TOuputImageType> IteratorType;
+  typedef itk::ImageRegionConstIteratorWithIndex<TOuputImageType> LineIteratorType;
+  typedef typename TInputImageType::IndexType IndexType;
+  typedef typename TInputImageType::OffsetType OffsetType;
+  const unsigned int dimension = TInputImageType::ImageDimension;
 
   typename TInputImageType::SizeType size; size.Fill(m_Size);
   InputImagePointer input = this->GetInput(0);
@@ -49,7 +55,53 @@ itk::LocalStatisticFilter<TInputImageType, TOuputImageType>::ThreadedGenerateDat
     size[2] = 0;
   }
 
-//  MITK_INFO << "Creating output iterator";
+  // Pixels outside of the image are replaced by the closest pixel inside of the image
+  // (same as the zero flux Neumann boundary condition of the neighborhood iterators).
+  const auto bufferedRegion = input->GetBufferedRegion();
+  const IndexType bufferedStart = bufferedRegion.GetIndex();
+  const IndexType bufferedEnd = bufferedRegion.GetUpperIndex();
+  auto clamp = [&](itk::IndexValueType value, unsigned int d) {
+    return std::max(bufferedStart[d], std::min(bufferedEnd[d], value));
+  };
+
+  // The neighbourhood is split into columns along the first dimension. Moving from one voxel of a line
+  // to the next only one column enters the neighbourhood, so the statistics of each column are calculated
+  // once per line and the neighbourhood statistics are combined from the column statistics.
+  std::vector<OffsetType> columnOffsets;
+  OffsetType offset;
+  offset.Fill(0);
+  for (unsigned int d = 1; d < dimension; ++d)
+  {
+    offset[d] = -static_cast<itk::OffsetValueType>(size[d]);
+  }
+  bool allOffsetsVisited = false;
+  while (!allOffsetsVisited)
+  {
+    columnOffsets.push_back(offset);
+    allOffsetsVisited = true;
+    for (unsigned int d = 1; d < dimension; ++d)
+    {
+      if (offset[d] < static_cast<itk::OffsetValueType>(size[d]))
+      {
+        ++offset[d];
+        allOffsetsVisited = false;
+        break;
+      }
+      offset[d] = -static_cast<itk::OffsetValueType>(size[d]);
+    }
+  }
+
+  const auto radius = static_cast<itk::IndexValueType>(size[0]);
+  const double neighbourhoodSize = columnOffsets.size() * (2 * radius + 1);
+
+  struct ColumnStatistics
+  {
+    double min;
+    double max;
+    double sum;
+    double sumOfSquares;
+  };
+
   std::vector<IteratorType> iterVector;
   for (int i = 0; i < m_Bins; ++i)
   {
@@ -57,39 +109,70 @@ itk::LocalStatisticFilter<TInputImageType, TOuputImageType>::ThreadedGenerateDat
     iterVector.push_back(iter);
   }
 
-  ConstIteratorType inputIter(size, input, outputRegionForThread);
-  while (!inputIter.IsAtEnd())
-  {
-    for (int i = 0; i < m_Bins; ++i)
-    {
-      iterVector[i].Set(0);
-    }
-
-    double min = std::numeric_limits<double>::max();
-    double max = std::numeric_limits<double>::lowest();
-    double mean = 0;
-    double std = 0;
+  const itk::IndexValueType lineStart = outputRegionForThread.GetIndex(0);
+  const itk::IndexValueType lineEnd = lineStart + outputRegionForThread.GetSize(0) - 1;
+  const itk::IndexValueType columnStart = clamp(lineStart - radius, 0);
+  const itk::IndexValueType columnEnd = clamp(lineEnd + radius, 0);
+  std::vector<ColumnStatistics> columns(columnEnd - columnStart + 1);
 
-    for (unsigned int i = 0; i < inputIter.Size(); ++i)
+  OutputImageRegionType lineRegion = outputRegionForThread;
+  lineRegion.SetSize(0, 1);
+  LineIteratorType lineIter(this->GetOutput(0), lineRegion);
+  while (!lineIter.IsAtEnd())
+  {
+    IndexType index = lineIter.GetIndex();
+    for (itk::IndexValueType x = columnStart; x <= columnEnd; ++x)
     {
-      double value = inputIter.GetPixel(i);
-      min = std::min<double>(min, value);
-      max = std::max<double>(max, value);
-      mean += value / inputIter.Size();
-      std += (value*value) / inputIter.Size();
+      ColumnStatistics &column = columns[x - columnStart];
+      column.min = std::numeric_limits<double>::max();
+      column.max = std::numeric_limits<double>::lowest();
+      column.sum = 0;
+      column.sumOfSquares = 0;
+      for (const auto &neighbourOffset : columnOffsets)
+      {
+        IndexType pixelIndex;
+        pixelIndex[0] = x;
+        for (unsigned int d = 1; d < dimension; ++d)
+        {
+          pixelIndex[d] = clamp(index[d] + neighbourOffset[d], d);
+        }
+        double value = input->GetPixel(pixelIndex);
+        column.min = std::min<double>(column.min, value);
+        column.max = std::max<double>(column.max, value);
+        column.sum += value;
+        column.sumOfSquares += value * value;
+      }
     }
 
-    iterVector[0].Value() = min;
-    iterVector[1].Value() = max;
-    iterVector[2].Value() = mean;
-    iterVector[3].Value() = std::sqrt(std - mean*mean);
-    iterVector[4].Value() = max-min;
-
-    for (int i = 0; i < m_Bins; ++i)
+    for (itk::IndexValueType x = lineStart; x <= lineEnd; ++x)
     {
-      ++(iterVector[i]);
+      double min = std::numeric_limits<double>::max();
+      double max = std::numeric_limits<double>::lowest();
+      double sum = 0;
+      double sumOfSquares = 0;
+      for (itk::IndexValueType k = -radius; k <= radius; ++k)
+      {
+        const ColumnStatistics &column = columns[clamp(x + k, 0) - columnStart];
+        min = std::min<double>(min, column.min);
+        max = std::max<double>(max, column.max);
+        sum += column.sum;
+        sumOfSquares += column.sumOfSquares;
+      }
+      double mean = sum / neighbourhoodSize;
+      double std = sumOfSquares / neighbourhoodSize;
+
+      iterVector[0].Value() = min;
+      iterVector[1].Value() = max;
+      iterVector[2].Value() = mean;
+      iterVector[3].Value() = std::sqrt(std - mean*mean);
+      iterVector[4].Value() = max-min;
+
+      for (int i = 0; i < m_Bins; ++i)
+      {
+        ++(iterVector[i]);
+      }
     }
-    ++inputIter;
+    ++lineIter;
   }
 }
 
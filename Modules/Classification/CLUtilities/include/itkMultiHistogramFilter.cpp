@@ -17,9 +17,13 @@ found in the LICENSE file.
 
 #include <itkNeighborhoodIterator.h>
 #include <itkImageRegionIterator.h>
+#include <itkImageRegionConstIteratorWithIndex.h>
 #include <itkImageIterator.h>
 #include "itkMinimumMaximumImageCalculator.h"
 
+#include <algorithm>
+#include <vector>
+
 template< class TInputImageType, class TOuputImageType>
 itk::MultiHistogramFilter<TInputImageType, TOuputImageType>::MultiHistogramFilter():
 m_Delta(0.6), m_Offset(-3.0), m_Bins(11), m_Size(5), m_UseImageIntensityRange(false)
@@ -64,12 +68,53 @@ itk::MultiHistogramFilter<TInputImageType, TOuputImageType>::ThreadedGenerateDat
   double offset = m_Offset;// -3.0;
   double delta = m_Delta;// 0.6;
 
-  typedef itk::ImageRegionIterator<TInputImageType> IteratorType;
-  typedef itk::ConstNeighborhoodIterator<TInputImageType> ConstIteratorType;
+  typedef itk::ImageRegionIterator<TOuputImageType> IteratorType;
+  typedef itk::ImageRegionConstIteratorWithIndex<TOuputImageType> LineIteratorType;
+  typedef typename TInputImageType::IndexType IndexType;
+  typedef typename TInputImageType::OffsetType OffsetType;
+  const unsigned int dimension = TInputImageType::ImageDimension;
 
   typename TInputImageType::SizeType size; size.Fill(m_Size);
   InputImagePointer input = this->GetInput(0);
 
+  // Pixels outside of the image are replaced by the closest pixel inside of the image
+  // (same as the zero flux Neumann boundary condition of the neighborhood iterators).
+  const auto bufferedRegion = input->GetBufferedRegion();
+  const IndexType bufferedStart = bufferedRegion.GetIndex();
+  const IndexType bufferedEnd = bufferedRegion.GetUpperIndex();
+  auto clamp = [&](itk::IndexValueType value, unsigned int d) {
+    return std::max(bufferedStart[d], std::min(bufferedEnd[d], value));
+  };
+
+  // The neighbourhood is split into columns along the first dimension. Moving from one voxel of a line
+  // to the next, the histogram is updated by adding the bins of the entering column and removing the
+  // bins of the leaving column instead of binning the whole neighbourhood again.
+  std::vector<OffsetType> columnOffsets;
+  OffsetType columnOffset;
+  columnOffset.Fill(0);
+  for (unsigned int d = 1; d < dimension; ++d)
+  {
+    columnOffset[d] = -static_cast<itk::OffsetValueType>(size[d]);
+  }
+  bool allOffsetsVisited = false;
+  while (!allOffsetsVisited)
+  {
+    columnOffsets.push_back(columnOffset);
+    allOffsetsVisited = true;
+    for (unsigned int d = 1; d < dimension; ++d)
+    {
+      if (columnOffset[d] < static_cast<itk::OffsetValueType>(size[d]))
+      {
+        ++columnOffset[d];
+        allOffsetsVisited = false;
+        break;
+      }
+      columnOffset[d] = -static_cast<itk::OffsetValueType>(size[d]);
+    }
+  }
+
+  const auto radius = static_cast<itk::IndexValueType>(size[0]);
+
 //  MITK_INFO << "Creating output iterator";
   std::vector<IteratorType> iterVector;
   for (int i = 0; i < m_Bins; ++i)
@@ -78,29 +123,68 @@ itk::MultiHistogramFilter<TInputImageType, TOuputImageType>::ThreadedGenerateDat
     iterVector.push_back(iter);
   }
 
-  ConstIteratorType inputIter(size, input, outputRegionForThread);
-  while (!inputIter.IsAtEnd())
+  const itk::IndexValueType lineStart = outputRegionForThread.GetIndex(0);
+  const itk::IndexValueType lineEnd = lineStart + outputRegionForThread.GetSize(0) - 1;
+  const itk::IndexValueType columnStart = clamp(lineStart - radius, 0);
+  const itk::IndexValueType columnEnd = clamp(lineEnd + radius, 0);
+  // bin of every pixel of every column of the current line
+  std::vector<int> columnBins((columnEnd - columnStart + 1) * columnOffsets.size());
+  std::vector<int> histogram(m_Bins);
+
+  auto addColumn = [&](itk::IndexValueType x, int weight) {
+    auto bin = columnBins.begin() + (clamp(x, 0) - columnStart) * columnOffsets.size();
+    for (std::size_t i = 0; i < columnOffsets.size(); ++i, ++bin)
+    {
+      histogram[*bin] += weight;
+    }
+  };
+
+  OutputImageRegionType lineRegion = outputRegionForThread;
+  lineRegion.SetSize(0, 1);
+  LineIteratorType lineIter(this->GetOutput(0), lineRegion);
+  while (!lineIter.IsAtEnd())
   {
-    for (int i = 0; i < m_Bins; ++i)
+    IndexType index = lineIter.GetIndex();
+    auto bin = columnBins.begin();
+    for (itk::IndexValueType x = columnStart; x <= columnEnd; ++x)
     {
-      iterVector[i].Set(0);
+      for (const auto &neighbourOffset : columnOffsets)
+      {
+        IndexType pixelIndex;
+        pixelIndex[0] = x;
+        for (unsigned int d = 1; d < dimension; ++d)
+        {
+          pixelIndex[d] = clamp(index[d] + neighbourOffset[d], d);
+        }
+        double value = input->GetPixel(pixelIndex);
+        value -=  offset;
+        value /= delta;
+        auto pos = (int)(value);
+        *bin = std::max(0, std::min(m_Bins-1, pos));
+        ++bin;
+      }
     }
 
-    for (unsigned int i = 0; i < inputIter.Size(); ++i)
+    std::fill(histogram.begin(), histogram.end(), 0);
+    for (itk::IndexValueType k = -radius; k <= radius; ++k)
     {
-      double value = inputIter.GetPixel(i);
-      value -=  offset;
-      value /= delta;
-      auto pos = (int)(value);
-      pos = std::max(0, std::min(m_Bins-1, pos));
-      iterVector[pos].Value() += 1;// (iterVector[pos].GetCenterPixel() + 1);
+      addColumn(lineStart + k, 1);
     }
 
-    for (int i = 0; i < m_Bins; ++i)
+    for (itk::IndexValueType x = lineStart; x <= lineEnd; ++x)
     {
-      ++(iterVector[i]);
+      if (x > lineStart)
+      {
+        addColumn(x - radius - 1, -1);
+        addColumn(x + radius, 1);
+      }
+      for (int i = 0; i < m_Bins; ++i)
+      {
+        iterVector[i].Set(histogram[i]);
+        ++(iterVector[i]);
+      }
     }
-    ++inputIter;
+    ++lineIter;
   }
 }
 
@@ -20,8 +20,8 @@ found in the LICENSE file.
 #include "itkImageIterator.h"
 #include "itkImageConstIterator.h"
 
-#include <cstdlib>     /* srand, rand */
 #include <ctime>       /* time */
+#include <random>
 
 namespace itk
 {
@@ -30,47 +30,49 @@ template< class TImage>
 void LabelSampler< TImage>
 ::GenerateData()
 {
-
-
-  srand (time(nullptr));
+  std::mt19937 generator(static_cast<std::mt19937::result_type>(time(nullptr)));
+  std::uniform_real_distribution<double> distribution(0.0, 1.0);
   this->AllocateOutputs();
 
   typename TImage::ConstPointer input = this->GetInput();
   TImage * output = this->GetOutput();
 
   m_NumberOfSampledVoxels = 0;
+  m_LabelVoxelCountMap.clear();
+
+  // Label images mostly consist of large connected areas, so the counter of the last seen
+  // label is kept instead of searching the map for every voxel.
+  int lastLabel = 0;
+  int * lastLabelCount = nullptr;
 
   ImageRegionConstIterator<TImage> inputIter(input, input->GetLargestPossibleRegion());
   ImageRegionIterator<TImage> outputIter(output, output->GetLargestPossibleRegion());
   while (!inputIter.IsAtEnd())
   {
-    if (inputIter.Get() > 0)
+    const auto value = inputIter.Get();
+    outputIter.Set(0);
+    if (value > 0)
     {
-
-      if(m_LabelVoxelCountMap.find(inputIter.Get()) == m_LabelVoxelCountMap.end())
-        m_LabelVoxelCountMap[inputIter.Get()] = 0;
-      m_LabelVoxelCountMap[inputIter.Get()]++;
-
-      double r;
-      if(inputIter.Get() == m_Label || m_Label == -1 ){
-        r = (double)(rand()) / RAND_MAX;
-        if (r < m_AcceptRate)
+      const int label = static_cast<int>(value);
+      if (lastLabelCount == nullptr || label != lastLabel)
+      {
+        lastLabel = label;
+        lastLabelCount = &m_LabelVoxelCountMap[label];
+      }
+      ++(*lastLabelCount);
+
+      if (label == m_Label || m_Label == -1)
+      {
+        if (distribution(generator) < m_AcceptRate)
         {
-          outputIter.Set(inputIter.Get());
+          outputIter.Set(value);
           m_NumberOfSampledVoxels++;
         }
-      }else
-        outputIter.Set(0);
-
-    }
-    else
-    {
-      outputIter.Set(0);
+      }
     }
     ++inputIter;
     ++outputIter;
   }
-
 }
 
 }// end namespace
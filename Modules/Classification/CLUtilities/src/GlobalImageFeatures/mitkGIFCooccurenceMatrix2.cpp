@@ -19,12 +19,15 @@ found in the LICENSE file.
 
 // ITK
 #include <itkEnhancedScalarImageToTextureFeaturesFilter.h>
-#include <itkShapedNeighborhoodIterator.h>
 #include <itkImageRegionConstIterator.h>
+#include <itkMultiThreader.h>
 
 // STL
 #include <sstream>
 #include <cmath>
+#include <algorithm>
+#include <thread>
+#include <vector>
 
 namespace mitk
 {
@@ -165,54 +168,126 @@ double mitk::CoocurenceMatrixHolder::IndexToMaxIntensity(int index)
 
 template<typename TPixel, unsigned int VImageDimension>
 void
-CalculateCoOcMatrix(itk::Image<TPixel, VImageDimension>* itkImage,
-                    itk::Image<unsigned short, VImageDimension>* mask,
-                    itk::Offset<VImageDimension> offset,
-                    int range,
-                    mitk::CoocurenceMatrixHolder &holder)
+CalculateCoOcMatrices(itk::Image<TPixel, VImageDimension>* itkImage,
+                      itk::Image<unsigned short, VImageDimension>* mask,
+                      const std::vector<itk::Offset<VImageDimension> > &offsets,
+                      std::vector<mitk::CoocurenceMatrixHolder> &holders)
 {
   typedef itk::Image<TPixel, VImageDimension> ImageType;
   typedef itk::Image<unsigned short, VImageDimension> MaskImageType;
-  typedef itk::ShapedNeighborhoodIterator<ImageType> ShapeIterType;
-  typedef itk::ShapedNeighborhoodIterator<MaskImageType> ShapeMaskIterType;
   typedef itk::ImageRegionConstIterator<ImageType> ConstIterType;
   typedef itk::ImageRegionConstIterator<MaskImageType> ConstMaskIterType;
 
+  if (offsets.empty())
+    return;
 
-  itk::Size<VImageDimension> radius;
-  radius.Fill(range+1);
-  ShapeIterType imageOffsetIter(radius, itkImage, itkImage->GetLargestPossibleRegion());
-  ShapeMaskIterType maskOffsetIter(radius, mask, mask->GetLargestPossibleRegion());
-  imageOffsetIter.ActivateOffset(offset);
-  maskOffsetIter.ActivateOffset(offset);
-  ConstIterType imageIter(itkImage, itkImage->GetLargestPossibleRegion());
-  ConstMaskIterType maskIter(mask, mask->GetLargestPossibleRegion());
-  //  iterator.GetIndex() + ci.GetNeighborhoodOffset()
   auto region = mask->GetLargestPossibleRegion();
+  auto size = region.GetSize();
+
+  // Bin of every voxel, -1 for voxels outside of the mask or with invalid values
+  std::vector<int> voxelBins(region.GetNumberOfPixels(), -1);
+  ConstIterType imageIter(itkImage, itkImage->GetLargestPossibleRegion());
+  ConstMaskIterType maskIter(mask, region);
+  for (std::size_t voxel = 0; !maskIter.IsAtEnd(); ++voxel, ++imageIter, ++maskIter)
+  {
+    if (maskIter.Value() > 0 && imageIter.Get() == imageIter.Get())
+    {
+      voxelBins[voxel] = holders[0].IntensityToIndex(imageIter.Get());
+    }
+  }
+
+  itk::OffsetValueType strides[VImageDimension];
+  strides[0] = 1;
+  for (unsigned int i = 1; i < VImageDimension; ++i)
+  {
+    strides[i] = strides[i - 1] * size[i - 1];
+  }
+  std::vector<itk::OffsetValueType> voxelOffsets;
+  for (auto offset : offsets)
+  {
+    itk::OffsetValueType voxelOffset = 0;
+    for (unsigned int i = 0; i < VImageDimension; ++i)
+    {
+      voxelOffset += offset[i] * strides[i];
+    }
+    voxelOffsets.push_back(voxelOffset);
+  }
+
+  // The image is traversed once for all offsets. Every thread counts the
+  // co-occurrences of a slab of the image in its own matrices, which are merged afterwards.
+  const itk::SizeValueType numberOfSlices = size[VImageDimension - 1];
+  const unsigned int numberOfThreads = std::max<itk::SizeValueType>(1,
+    std::min<itk::SizeValueType>(itk::MultiThreader::GetGlobalDefaultNumberOfThreads(), numberOfSlices));
+  const int numberOfBins = holders[0].m_NumberOfBins;
+  std::vector<std::vector<Eigen::MatrixXd> > threadMatrices(numberOfThreads,
+    std::vector<Eigen::MatrixXd>(offsets.size(), Eigen::MatrixXd::Zero(numberOfBins, numberOfBins)));
+
+  auto countCoOccurrences = [&](unsigned int threadId)
+  {
+    const itk::SizeValueType firstSlice = numberOfSlices * threadId / numberOfThreads;
+    const itk::SizeValueType endSlice = numberOfSlices * (threadId + 1) / numberOfThreads;
+    auto &matrices = threadMatrices[threadId];
+
+    // index of the voxel relative to the start of the region
+    itk::Index<VImageDimension> index;
+    index.Fill(0);
+    index[VImageDimension - 1] = firstSlice;
+    const std::size_t endVoxel = endSlice * strides[VImageDimension - 1];
+    for (std::size_t voxel = firstSlice * strides[VImageDimension - 1]; voxel < endVoxel; ++voxel)
+    {
+      const int i = voxelBins[voxel];
+      if (i >= 0)
+      {
+        for (std::size_t offsetNumber = 0; offsetNumber < offsets.size(); ++offsetNumber)
+        {
+          bool isInside = true;
+          for (unsigned int d = 0; d < VImageDimension && isInside; ++d)
+          {
+            const itk::IndexValueType neighbour = index[d] + offsets[offsetNumber][d];
+            isInside = neighbour >= 0 && neighbour < static_cast<itk::IndexValueType>(size[d]);
+          }
+          if (!isInside)
+            continue;
+
+          const int j = voxelBins[static_cast<itk::OffsetValueType>(voxel) + voxelOffsets[offsetNumber]];
+          if (j >= 0)
+          {
+            matrices[offsetNumber](i, j) += 1;
+            matrices[offsetNumber](j, i) += 1;
+          }
+        }
+      }
 
+      for (unsigned int d = 0; d < VImageDimension; ++d)
+      {
+        if (++index[d] < static_cast<itk::IndexValueType>(size[d]))
+          break;
+        index[d] = 0;
+      }
+    }
+  };
 
-  while (!maskIter.IsAtEnd())
+  std::vector<std::thread> threads;
+  for (unsigned int threadId = 1; threadId < numberOfThreads; ++threadId)
   {
-    auto ciMask = maskOffsetIter.Begin();
-    auto ciValue = imageOffsetIter.Begin();
-    if (maskIter.Value() > 0 &&
-      ciMask.Get() > 0 &&
-      imageIter.Get() == imageIter.Get() &&
-      ciValue.Get() == ciValue.Get() &&
-      region.IsInside(maskOffsetIter.GetIndex() + ciMask.GetNeighborhoodOffset()))
+    threads.emplace_back(countCoOccurrences, threadId);
+  }
+  countCoOccurrences(0);
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  for (std::size_t offsetNumber = 0; offsetNumber < offsets.size(); ++offsetNumber)
+  {
+    for (unsigned int threadId = 0; threadId < numberOfThreads; ++threadId)
     {
-      int i = holder.IntensityToIndex(imageIter.Get());
-      int j = holder.IntensityToIndex(ciValue.Get());
-      holder.m_Matrix(i, j) += 1;
-      holder.m_Matrix(j, i) += 1;
+      holders[offsetNumber].m_Matrix += threadMatrices[threadId][offsetNumber];
     }
-    ++imageOffsetIter;
-    ++maskOffsetIter;
-    ++imageIter;
-    ++maskIter;
   }
 }
 
+
 void CalculateFeatures(
   mitk::CoocurenceMatrixHolder &holder,
   mitk::CoocurenceMatrixFeatures & results
@@ -423,6 +498,7 @@ CalculateCoocurenceFeatures(itk::Image<TPixel, VImageDimension>* itkImage, mitk:
   std::vector<mitk::CoocurenceMatrixFeatures> resultVector;
   mitk::CoocurenceMatrixHolder holderOverall(rangeMin, rangeMax, numberOfBins);
   mitk::CoocurenceMatrixFeatures overallFeature;
+  std::vector < itk::Offset<VImageDimension> > usedOffsets;
   for (std::size_t i = 0; i < offsetVector.size(); ++i)
   {
     if (config.direction > 1)
@@ -432,12 +508,15 @@ CalculateCoocurenceFeatures(itk::Image<TPixel, VImageDimension>* itkImage, mitk:
         continue;
       }
     }
+    usedOffsets.push_back(offsetVector[i]);
+  }
 
-
-    offset = offsetVector[i];
-    mitk::CoocurenceMatrixHolder holder(rangeMin, rangeMax, numberOfBins);
+  std::vector<mitk::CoocurenceMatrixHolder> holders(usedOffsets.size(),
+    mitk::CoocurenceMatrixHolder(rangeMin, rangeMax, numberOfBins));
+  CalculateCoOcMatrices<TPixel, VImageDimension>(itkImage, maskImage, usedOffsets, holders);
+  for (auto &holder : holders)
+  {
     mitk::CoocurenceMatrixFeatures coocResults;
-    CalculateCoOcMatrix<TPixel, VImageDimension>(itkImage, maskImage, offset, config.range, holder);
     holderOverall.m_Matrix += holder.m_Matrix;
     CalculateFeatures(holder, coocResults);
     resultVector.push_back(coocResults);
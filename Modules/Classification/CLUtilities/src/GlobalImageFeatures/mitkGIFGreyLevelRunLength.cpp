@@ -36,7 +36,6 @@ void
   mitk::CastToItkImage(mask, maskImage);
 
   typename FilterType::Pointer filter = FilterType::New();
-  typename FilterType::Pointer filter2 = FilterType::New();
 
   typename FilterType::OffsetVector::Pointer newOffset = FilterType::OffsetVector::New();
   auto oldOffsets = filter->GetOffsets();
@@ -67,7 +66,6 @@ void
     newOffset->push_back(offset);
   }
   filter->SetOffsets(newOffset);
-  filter2->SetOffsets(newOffset);
 
 
   // All features are required
@@ -93,9 +91,6 @@ void
   filter->SetInput(itkImage);
   filter->SetMaskImage(maskImage);
   filter->SetRequestedFeatures(requestedFeatures);
-  filter2->SetInput(itkImage);
-  filter2->SetMaskImage(maskImage);
-  filter2->SetRequestedFeatures(requestedFeatures);
   int numberOfBins = params.Bins;
   if (numberOfBins < 2)
     numberOfBins = 256;
@@ -105,20 +100,15 @@ void
 
   filter->SetPixelValueMinMax(minRange, maxRange);
   filter->SetNumberOfBinsPerAxis(numberOfBins);
-  filter2->SetPixelValueMinMax(minRange, maxRange);
-  filter2->SetNumberOfBinsPerAxis(numberOfBins);
 
   filter->SetDistanceValueMinMax(0, numberOfBins);
-  filter2->SetDistanceValueMinMax(0, numberOfBins);
-
-  filter2->CombinedFeatureCalculationOn();
 
+  // The combined features are calculated from the matrices of the same update
   filter->Update();
-  filter2->Update();
 
   auto featureMeans = filter->GetFeatureMeans ();
   auto featureStd = filter->GetFeatureStandardDeviations();
-  auto featureCombined = filter2->GetFeatureMeans();
+  auto featureCombined = filter->GetCombinedFeatures();
 
   for (std::size_t i = 0; i < featureMeans->size(); ++i)
   {
@@ -0,0 +1,92 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestingMacros.h>
+#include <mitkTestFixture.h>
+#include "mitkIOUtil.h"
+#include <cmath>
+
+#include <mitkGIFFirstOrderStatistics.h>
+#include <mitkGIFFirstOrderHistogramStatistics.h>
+#include <mitkGlobalImageFeatureCache.h>
+
+class mitkGlobalImageFeatureCacheTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkGlobalImageFeatureCacheTestSuite);
+
+  MITK_TEST(SharedCache_SameResults);
+  MITK_TEST(SharedCache_ImageRange);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_IBSI_Phantom_Image_Large;
+  mitk::Image::Pointer m_IBSI_Phantom_Mask_Large;
+
+public:
+
+  void setUp(void) override
+  {
+    m_IBSI_Phantom_Image_Large = mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("Radiomics/IBSI_Phantom_Image_Large.nrrd"));
+    m_IBSI_Phantom_Mask_Large = mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("Radiomics/IBSI_Phantom_Mask_Large.nrrd"));
+  }
+
+  void SharedCache_SameResults()
+  {
+    mitk::GIFFirstOrderStatistics::Pointer referenceCalculator = mitk::GIFFirstOrderStatistics::New();
+    auto referenceList = referenceCalculator->CalculateFeatures(m_IBSI_Phantom_Image_Large, m_IBSI_Phantom_Mask_Large);
+
+    mitk::GlobalImageFeatureCache::Pointer cache = mitk::GlobalImageFeatureCache::New();
+    mitk::GIFFirstOrderStatistics::Pointer firstOrderCalculator = mitk::GIFFirstOrderStatistics::New();
+    mitk::GIFFirstOrderHistogramStatistics::Pointer histogramCalculator = mitk::GIFFirstOrderHistogramStatistics::New();
+    firstOrderCalculator->SetFeatureCache(cache);
+    histogramCalculator->SetFeatureCache(cache);
+
+    auto featureList = firstOrderCalculator->CalculateFeatures(m_IBSI_Phantom_Image_Large, m_IBSI_Phantom_Mask_Large);
+    histogramCalculator->CalculateFeatures(m_IBSI_Phantom_Image_Large, m_IBSI_Phantom_Mask_Large);
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Feature classes with the same histogram parameters should share the quantifier",
+      firstOrderCalculator->GetQuantifier().GetPointer(), histogramCalculator->GetQuantifier().GetPointer());
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("The cache should not change the number of features", referenceList.size(), featureList.size());
+    for (std::size_t i = 0; i < featureList.size(); ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("The cache should not change the feature names", referenceList[i].first, featureList[i].first);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(featureList[i].first, referenceList[i].second, featureList[i].second, 1e-10);
+    }
+
+    histogramCalculator->SetBins(32);
+    histogramCalculator->CalculateFeatures(m_IBSI_Phantom_Image_Large, m_IBSI_Phantom_Mask_Large);
+    CPPUNIT_ASSERT_MESSAGE("Different histogram parameters should lead to different quantifiers",
+      firstOrderCalculator->GetQuantifier().GetPointer() != histogramCalculator->GetQuantifier().GetPointer());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("The quantifier should use the changed number of bins", 32u, histogramCalculator->GetQuantifier()->GetBins());
+  }
+
+  void SharedCache_ImageRange()
+  {
+    mitk::GlobalImageFeatureCache::Pointer cache = mitk::GlobalImageFeatureCache::New();
+    double cachedMinimum, cachedMaximum;
+    cache->GetImageRegionMinMax(m_IBSI_Phantom_Image_Large, m_IBSI_Phantom_Mask_Large, cachedMinimum, cachedMaximum);
+
+    mitk::IntensityQuantifier::Pointer quantifier = mitk::IntensityQuantifier::New();
+    quantifier->InitializeByImageRegion(m_IBSI_Phantom_Image_Large, m_IBSI_Phantom_Mask_Large, 10);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Minimum of the masked region", quantifier->GetMinimum(), cachedMinimum, 1e-10);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Maximum of the masked region", quantifier->GetMaximum(), cachedMaximum, 1e-10);
+
+    cache->GetImageMinMax(m_IBSI_Phantom_Image_Large, cachedMinimum, cachedMaximum);
+    quantifier->InitializeByImage(m_IBSI_Phantom_Image_Large, 10);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Minimum of the image", quantifier->GetMinimum(), cachedMinimum, 1e-10);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Maximum of the image", quantifier->GetMaximum(), cachedMaximum, 1e-10);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkGlobalImageFeatureCache )
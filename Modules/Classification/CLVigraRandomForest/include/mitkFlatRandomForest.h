@@ -0,0 +1,111 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkFlatRandomForest_h
+#define mitkFlatRandomForest_h
+
+#include <MitkCLVigraRandomForestExports.h>
+
+#include <mitkCommon.h>
+#include <itkObject.h>
+#include <itkObjectFactory.h>
+
+#include <Eigen/Dense>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mitk
+{
+  class VigraRandomForestClassifier;
+
+  /**
+  * \brief Compact, read-only representation of a trained random forest that is evaluated directly.
+  *
+  * The nodes of all trees are stored in a single array. Each tree is stored in breadth-first order and the two
+  * children of a node are stored next to each other, so that a node only needs the index of its first child and
+  * the top levels of all trees lie close together in memory. The class probabilities of the leaves are stored in a
+  * second array.
+  *
+  * The forest can be written to a ".flatforest" file, which contains these arrays unchanged (native byte order).
+  * Load() maps the file into memory and predicts directly from the mapped arrays, so loading only checks the indices
+  * of the nodes instead of building the trees. Prediction gives the same labels and probabilities as VigraRandomForestClassifier::Predict().
+  *
+  * Only forests with threshold splits and constant probability leaves are supported, which is what
+  * VigraRandomForestClassifier learns.
+  */
+  class MITKCLVIGRARANDOMFOREST_EXPORT FlatRandomForest : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(FlatRandomForest, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    /** Node of a tree. Inner nodes send a sample to Child if its feature value is smaller than the threshold and to
+    * Child + 1 otherwise. For leaves, Feature is negative and Child is the index of the leaf probabilities.*/
+    struct Node
+    {
+      double Threshold;
+      std::int32_t Feature;
+      std::uint32_t Child;
+    };
+
+    /** Creates the flat representation of the forest of the classifier.*/
+    void SetRandomForest(const VigraRandomForestClassifier *classifier);
+
+    /** Writes the forest to a file, which can be memory mapped by Load().*/
+    void Write(const std::string &fileName) const;
+
+    /** Maps a file written by Write() into memory.*/
+    void Load(const std::string &fileName);
+
+    /** Predicts the labels of all rows of the feature matrix (one sample per row). The rows are distributed over
+    * multiple threads.
+    * @param probabilities is set to the class probabilities of each row (one column per class).*/
+    Eigen::MatrixXi Predict(const Eigen::MatrixXd &X, Eigen::MatrixXd &probabilities) const;
+
+    unsigned int GetNumberOfTrees() const { return m_NumberOfTrees; }
+    unsigned int GetNumberOfClasses() const { return m_NumberOfClasses; }
+    unsigned int GetNumberOfFeatures() const { return m_NumberOfFeatures; }
+
+  protected:
+    FlatRandomForest();
+    ~FlatRandomForest() override;
+
+  private:
+    void ReleaseMapping();
+    void PredictRows(const Eigen::MatrixXd &X, Eigen::Index firstRow, Eigen::Index endRow,
+      Eigen::MatrixXi &labels, Eigen::MatrixXd &probabilities) const;
+
+    unsigned int m_NumberOfTrees;
+    unsigned int m_NumberOfClasses;
+    unsigned int m_NumberOfFeatures;
+    std::size_t m_NumberOfNodes;
+    std::size_t m_NumberOfLeaves;
+
+    // Arrays used for prediction, either pointing to the own storage or into the mapped file.
+    const std::int32_t *m_ClassLabels;
+    const std::uint32_t *m_TreeRoots;
+    const Node *m_Nodes;
+    const double *m_LeafProbabilities;
+
+    std::vector<std::int32_t> m_ClassLabelStorage;
+    std::vector<std::uint32_t> m_TreeRootStorage;
+    std::vector<Node> m_NodeStorage;
+    std::vector<double> m_LeafProbabilityStorage;
+
+    void *m_MappedMemory;
+    std::size_t m_MappedSize;
+  };
+}
+
+#endif //mitkFlatRandomForest_h
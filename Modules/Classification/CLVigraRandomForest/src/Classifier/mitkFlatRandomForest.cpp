@@ -0,0 +1,408 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// MITK includes
+#include <mitkFlatRandomForest.h>
+#include <mitkExceptionMacro.h>
+#include <mitkVigraRandomForestClassifier.h>
+
+// Vigra includes
+#include <vigra/random_forest.hxx>
+
+// ITK includes
+#include <itkMultiThreader.h>
+
+// STD includes
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+#if _MSC_VER
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+  const char FlatForestMagic[8] = { 'M', 'I', 'T', 'K', 'F', 'R', 'F', '\0' };
+  const std::uint32_t FlatForestVersion = 1;
+
+  /** Header of a flat forest file. It is followed by the class labels, the tree roots, the nodes and the leaf
+  * probabilities, each array starting at a multiple of 8 bytes.*/
+  struct FlatForestHeader
+  {
+    char Magic[8];
+    std::uint32_t Version;
+    std::uint32_t NodeSize;
+    std::uint32_t NumberOfClasses;
+    std::uint32_t NumberOfFeatures;
+    std::uint32_t NumberOfTrees;
+    std::uint32_t Reserved;
+    std::uint64_t NumberOfNodes;
+    std::uint64_t NumberOfLeaves;
+  };
+
+  std::size_t AlignedSize(std::size_t size)
+  {
+    return (size + 7) / 8 * 8;
+  }
+
+  /** Offsets of the arrays within a flat forest file.*/
+  struct FlatForestLayout
+  {
+    explicit FlatForestLayout(const FlatForestHeader &header)
+    {
+      ClassLabels = AlignedSize(sizeof(FlatForestHeader));
+      TreeRoots = ClassLabels + AlignedSize(header.NumberOfClasses * sizeof(std::int32_t));
+      Nodes = TreeRoots + AlignedSize(header.NumberOfTrees * sizeof(std::uint32_t));
+      LeafProbabilities = Nodes + header.NumberOfNodes * sizeof(mitk::FlatRandomForest::Node);
+      FileSize = LeafProbabilities + header.NumberOfLeaves * header.NumberOfClasses * sizeof(double);
+    }
+
+    std::size_t ClassLabels;
+    std::size_t TreeRoots;
+    std::size_t Nodes;
+    std::size_t LeafProbabilities;
+    std::size_t FileSize;
+  };
+
+  // Number of rows that are passed through all trees together, so that a tree stays in the cache for a while.
+  const Eigen::Index RowBlockSize = 64;
+}
+
+mitk::FlatRandomForest::FlatRandomForest()
+  : m_NumberOfTrees(0),
+    m_NumberOfClasses(0),
+    m_NumberOfFeatures(0),
+    m_NumberOfNodes(0),
+    m_NumberOfLeaves(0),
+    m_ClassLabels(nullptr),
+    m_TreeRoots(nullptr),
+    m_Nodes(nullptr),
+    m_LeafProbabilities(nullptr),
+    m_MappedMemory(nullptr),
+    m_MappedSize(0)
+{
+  static_assert(sizeof(Node) == 16, "The flat forest file format requires nodes of 16 bytes.");
+}
+
+mitk::FlatRandomForest::~FlatRandomForest()
+{
+  this->ReleaseMapping();
+}
+
+void mitk::FlatRandomForest::ReleaseMapping()
+{
+  if (m_MappedMemory == nullptr)
+    return;
+#if _MSC_VER
+  UnmapViewOfFile(m_MappedMemory);
+#else
+  munmap(m_MappedMemory, m_MappedSize);
+#endif
+  m_MappedMemory = nullptr;
+  m_MappedSize = 0;
+}
+
+void mitk::FlatRandomForest::SetRandomForest(const VigraRandomForestClassifier *classifier)
+{
+  if (classifier == nullptr)
+    mitkThrow() << "Cannot create a flat forest without a classifier.";
+
+  const vigra::RandomForest<int> &rf = classifier->GetRandomForest();
+  const unsigned int numberOfClasses = rf.class_count();
+  // The leaf probabilities are weighted in the same way vigra does it in predictProbabilities()
+  const int isSampleWeighted = rf.options_.predict_weighted_;
+
+  std::vector<std::int32_t> classLabels(numberOfClasses);
+  for (unsigned int i = 0; i < numberOfClasses; ++i)
+  {
+    int label;
+    rf.ext_param_.to_classlabel(i, label);
+    classLabels[i] = label;
+  }
+
+  std::vector<std::uint32_t> treeRoots;
+  std::vector<Node> nodes;
+  std::vector<double> leafProbabilities;
+  for (const auto &tree : rf.trees_)
+  {
+    const std::size_t treeRoot = nodes.size();
+    treeRoots.push_back(static_cast<std::uint32_t>(treeRoot));
+
+    // The vigra nodes in breadth-first order, the flat index of a node is treeRoot + its position.
+    // The root node of a vigra tree is placed behind the two header entries of the topology.
+    std::vector<std::int32_t> queue(1, 2);
+    for (std::size_t position = 0; position < queue.size(); ++position)
+    {
+      const auto index = queue[position];
+      vigra::NodeBase vigraNode(tree.topology_, tree.parameters_, index);
+      Node node;
+      if (vigraNode.typeID() == vigra::i_ThresholdNode)
+      {
+        vigra::Node<vigra::i_ThresholdNode> thresholdNode(tree.topology_, tree.parameters_, index);
+        node.Threshold = thresholdNode.threshold();
+        node.Feature = static_cast<std::int32_t>(thresholdNode.column());
+        node.Child = static_cast<std::uint32_t>(treeRoot + queue.size());
+        queue.push_back(thresholdNode.child(0));
+        queue.push_back(thresholdNode.child(1));
+      }
+      else if (vigraNode.typeID() == vigra::e_ConstProbNode)
+      {
+        vigra::Node<vigra::e_ConstProbNode> leafNode(tree.topology_, tree.parameters_, index);
+        const double weight = leafNode.weights() * isSampleWeighted + (1 - isSampleWeighted);
+        node.Threshold = 0;
+        node.Feature = -1;
+        node.Child = static_cast<std::uint32_t>(leafProbabilities.size() / std::max(1u, numberOfClasses));
+        for (unsigned int l = 0; l < numberOfClasses; ++l)
+        {
+          leafProbabilities.push_back(leafNode.prob_begin()[l] * weight);
+        }
+      }
+      else
+      {
+        mitkThrow() << "The forest contains a node of type " << vigraNode.typeID()
+                    << ", only threshold nodes and constant probability leaves are supported.";
+      }
+      nodes.push_back(node);
+    }
+  }
+
+  this->ReleaseMapping();
+  m_ClassLabelStorage.swap(classLabels);
+  m_TreeRootStorage.swap(treeRoots);
+  m_NodeStorage.swap(nodes);
+  m_LeafProbabilityStorage.swap(leafProbabilities);
+
+  m_NumberOfTrees = static_cast<unsigned int>(m_TreeRootStorage.size());
+  m_NumberOfClasses = numberOfClasses;
+  m_NumberOfFeatures = rf.column_count();
+  m_NumberOfNodes = m_NodeStorage.size();
+  m_NumberOfLeaves = numberOfClasses > 0 ? m_LeafProbabilityStorage.size() / numberOfClasses : 0;
+  m_ClassLabels = m_ClassLabelStorage.data();
+  m_TreeRoots = m_TreeRootStorage.data();
+  m_Nodes = m_NodeStorage.data();
+  m_LeafProbabilities = m_LeafProbabilityStorage.data();
+  this->Modified();
+}
+
+void mitk::FlatRandomForest::Write(const std::string &fileName) const
+{
+  FlatForestHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.Magic, FlatForestMagic, sizeof(FlatForestMagic));
+  header.Version = FlatForestVersion;
+  header.NodeSize = sizeof(Node);
+  header.NumberOfClasses = m_NumberOfClasses;
+  header.NumberOfFeatures = m_NumberOfFeatures;
+  header.NumberOfTrees = m_NumberOfTrees;
+  header.NumberOfNodes = m_NumberOfNodes;
+  header.NumberOfLeaves = m_NumberOfLeaves;
+  FlatForestLayout layout(header);
+
+  std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+  if (!file.is_open())
+    mitkThrow() << "Could not open " << fileName << " for writing.";
+
+  auto writeArray = [&file](std::size_t offset, const void *data, std::size_t size) {
+    const char padding[8] = {0};
+    const auto position = static_cast<std::size_t>(file.tellp());
+    file.write(padding, offset - position);
+    file.write(static_cast<const char *>(data), size);
+  };
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  writeArray(layout.ClassLabels, m_ClassLabels, m_NumberOfClasses * sizeof(std::int32_t));
+  writeArray(layout.TreeRoots, m_TreeRoots, m_NumberOfTrees * sizeof(std::uint32_t));
+  writeArray(layout.Nodes, m_Nodes, m_NumberOfNodes * sizeof(Node));
+  writeArray(layout.LeafProbabilities, m_LeafProbabilities, m_NumberOfLeaves * m_NumberOfClasses * sizeof(double));
+
+  if (!file.good())
+    mitkThrow() << "Could not write the flat forest to " << fileName << ".";
+}
+
+void mitk::FlatRandomForest::Load(const std::string &fileName)
+{
+  void *memory = nullptr;
+  std::size_t size = 0;
+#if _MSC_VER
+  HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+    FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file != INVALID_HANDLE_VALUE)
+  {
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+    {
+      size = static_cast<std::size_t>(fileSize.QuadPart);
+      HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      if (mapping != nullptr)
+      {
+        memory = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        // the view keeps the mapping and the file alive
+        CloseHandle(mapping);
+      }
+    }
+    CloseHandle(file);
+  }
+#else
+  int fd = open(fileName.c_str(), O_RDONLY);
+  if (fd != -1)
+  {
+    struct stat fileStatus;
+    if (fstat(fd, &fileStatus) == 0 && fileStatus.st_size > 0)
+    {
+      size = static_cast<std::size_t>(fileStatus.st_size);
+      memory = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+      if (memory == MAP_FAILED)
+        memory = nullptr;
+    }
+    close(fd);
+  }
+#endif
+  if (memory == nullptr)
+    mitkThrow() << "Could not map the flat forest file " << fileName << ".";
+
+  // Validate the file before it is used, the mapping is released again on failure.
+  const auto *data = static_cast<const char *>(memory);
+  FlatForestHeader header;
+  bool isValid = size >= sizeof(header);
+  if (isValid)
+  {
+    std::memcpy(&header, data, sizeof(header));
+    isValid = std::memcmp(header.Magic, FlatForestMagic, sizeof(FlatForestMagic)) == 0 &&
+              header.Version == FlatForestVersion && header.NodeSize == sizeof(Node) &&
+              FlatForestLayout(header).FileSize <= size;
+  }
+  if (isValid)
+  {
+    // Corrupt indices would let the prediction read outside of the mapping
+    FlatForestLayout layout(header);
+    const auto *treeRoots = reinterpret_cast<const std::uint32_t *>(data + layout.TreeRoots);
+    const auto *nodes = reinterpret_cast<const Node *>(data + layout.Nodes);
+    for (std::uint32_t i = 0; isValid && i < header.NumberOfTrees; ++i)
+    {
+      isValid = treeRoots[i] < header.NumberOfNodes;
+    }
+    for (std::uint64_t i = 0; isValid && i < header.NumberOfNodes; ++i)
+    {
+      isValid = nodes[i].Feature < 0 ? nodes[i].Child < header.NumberOfLeaves
+                                     : std::uint64_t(nodes[i].Feature) < header.NumberOfFeatures &&
+                                         std::uint64_t(nodes[i].Child) + 1 < header.NumberOfNodes;
+    }
+  }
+  if (!isValid)
+  {
+#if _MSC_VER
+    UnmapViewOfFile(memory);
+#else
+    munmap(memory, size);
+#endif
+    mitkThrow() << fileName << " is not a valid flat forest file.";
+  }
+
+  this->ReleaseMapping();
+  m_ClassLabelStorage.clear();
+  m_TreeRootStorage.clear();
+  m_NodeStorage.clear();
+  m_LeafProbabilityStorage.clear();
+  m_MappedMemory = memory;
+  m_MappedSize = size;
+
+  FlatForestLayout layout(header);
+  m_NumberOfTrees = header.NumberOfTrees;
+  m_NumberOfClasses = header.NumberOfClasses;
+  m_NumberOfFeatures = header.NumberOfFeatures;
+  m_NumberOfNodes = header.NumberOfNodes;
+  m_NumberOfLeaves = header.NumberOfLeaves;
+  m_ClassLabels = reinterpret_cast<const std::int32_t *>(data + layout.ClassLabels);
+  m_TreeRoots = reinterpret_cast<const std::uint32_t *>(data + layout.TreeRoots);
+  m_Nodes = reinterpret_cast<const Node *>(data + layout.Nodes);
+  m_LeafProbabilities = reinterpret_cast<const double *>(data + layout.LeafProbabilities);
+  this->Modified();
+}
+
+Eigen::MatrixXi mitk::FlatRandomForest::Predict(const Eigen::MatrixXd &X, Eigen::MatrixXd &probabilities) const
+{
+  if (m_NumberOfTrees == 0)
+    mitkThrow() << "Cannot predict with an empty forest.";
+  if (X.cols() < static_cast<Eigen::Index>(m_NumberOfFeatures))
+    mitkThrow() << "The forest requires " << m_NumberOfFeatures << " features, but only " << X.cols()
+                << " are given.";
+
+  Eigen::MatrixXi labels(X.rows(), 1);
+  probabilities = Eigen::MatrixXd::Zero(X.rows(), m_NumberOfClasses);
+
+  // Every thread processes a contiguous range of rows, the ranges are aligned to the row blocks.
+  const Eigen::Index numberOfBlocks = (X.rows() + RowBlockSize - 1) / RowBlockSize;
+  const Eigen::Index numberOfThreads = std::max<Eigen::Index>(1,
+    std::min<Eigen::Index>(itk::MultiThreader::GetGlobalDefaultNumberOfThreads(), numberOfBlocks));
+  const Eigen::Index blocksPerThread = (numberOfBlocks + numberOfThreads - 1) / numberOfThreads;
+
+  std::vector<std::thread> threads;
+  for (Eigen::Index threadId = 0; threadId < numberOfThreads; ++threadId)
+  {
+    const Eigen::Index firstRow = std::min(X.rows(), threadId * blocksPerThread * RowBlockSize);
+    const Eigen::Index endRow = std::min(X.rows(), (threadId + 1) * blocksPerThread * RowBlockSize);
+    threads.emplace_back([&, firstRow, endRow]() { this->PredictRows(X, firstRow, endRow, labels, probabilities); });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+  return labels;
+}
+
+void mitk::FlatRandomForest::PredictRows(const Eigen::MatrixXd &X, Eigen::Index firstRow, Eigen::Index endRow,
+  Eigen::MatrixXi &labels, Eigen::MatrixXd &probabilities) const
+{
+  for (Eigen::Index blockStart = firstRow; blockStart < endRow; blockStart += RowBlockSize)
+  {
+    const Eigen::Index blockEnd = std::min(endRow, blockStart + RowBlockSize);
+    for (unsigned int tree = 0; tree < m_NumberOfTrees; ++tree)
+    {
+      for (Eigen::Index row = blockStart; row < blockEnd; ++row)
+      {
+        const Node *node = m_Nodes + m_TreeRoots[tree];
+        while (node->Feature >= 0)
+        {
+          node = m_Nodes + node->Child + (X(row, node->Feature) < node->Threshold ? 0 : 1);
+        }
+        const double *leafProbabilities = m_LeafProbabilities + std::size_t(node->Child) * m_NumberOfClasses;
+        for (unsigned int l = 0; l < m_NumberOfClasses; ++l)
+        {
+          probabilities(row, l) += leafProbabilities[l];
+        }
+      }
+    }
+
+    for (Eigen::Index row = blockStart; row < blockEnd; ++row)
+    {
+      // Normalise by the total vote count and take the first class with maximal probability, same as vigra
+      const double totalWeight = probabilities.row(row).sum();
+      unsigned int maxClass = 0;
+      for (unsigned int l = 0; l < m_NumberOfClasses; ++l)
+      {
+        probabilities(row, l) /= totalWeight;
+        if (probabilities(row, l) > probabilities(row, maxClass))
+          maxClass = l;
+      }
+      labels(row, 0) = m_ClassLabels[maxClass];
+    }
+  }
+}
@@ -26,6 +26,8 @@ found in the LICENSE file.
 #include <itkMultiThreader.h>
 #include <itkCommand.h>
 
+#include <algorithm>
+
 typedef mitk::ThresholdSplit<mitk::LinearSplitting< mitk::ImpurityLoss<> >,int,vigra::ClassificationTag> DefaultSplitType;
 
 struct mitk::VigraRandomForestClassifier::Parameter
@@ -62,6 +64,7 @@ struct mitk::VigraRandomForestClassifier::TrainingData
   }
   vigra::ArrayVector<vigra::RandomForest<int>::DecisionTree_t>  trees_;
 
+  vigra::ProblemSpec<int> m_ProblemSpec;
   int m_ClassCount;
   unsigned int m_NumberOfTrees;
   const vigra::RandomForest<int> & m_RandomForest;
@@ -145,23 +148,23 @@ void mitk::VigraRandomForestClassifier::Train(const Eigen::MatrixXd & X_in, cons
   vigra::MultiArrayView<2, double> X(vigra::Shape2(X_in.rows(),X_in.cols()),X_in.data());
   vigra::MultiArrayView<2, int> Y(vigra::Shape2(Y_in.rows(),Y_in.cols()),Y_in.data());
 
-  m_RandomForest.set_options().tree_count(1); // Number of trees that are calculated;
-
   m_RandomForest.set_options().use_stratification(m_Parameter->Stratification);
   m_RandomForest.set_options().sample_with_replacement(m_Parameter->SampleWithReplacement);
   m_RandomForest.set_options().samples_per_tree(m_Parameter->SamplesPerTree);
   m_RandomForest.set_options().min_split_node_size(m_Parameter->MinimumSplitNodeSize);
 
-  m_RandomForest.learn(X, Y,vigra::rf::visitors::VisitorBase(),splitter);
-
+  // All trees are learned by the threads, the problem specification (class labels, ...) is
+  // taken from their forests, so no tree has to be learned in advance.
   std::unique_ptr<TrainingData> data(new TrainingData(m_Parameter->TreeCount,m_RandomForest,splitter,X,Y, *m_Parameter));
 
   itk::MultiThreader::Pointer threader = itk::MultiThreader::New();
+  threader->SetNumberOfThreads(std::max(1, std::min<int>(threader->GetNumberOfThreads(), m_Parameter->TreeCount)));
   threader->SetSingleMethod(this->TrainTreesCallback,data.get());
   threader->SingleMethodExecute();
 
   // set result trees
   m_RandomForest.set_options().tree_count(m_Parameter->TreeCount);
+  m_RandomForest.ext_param_ = data->m_ProblemSpec;
   m_RandomForest.ext_param_.class_count_ = data->m_ClassCount;
   m_RandomForest.trees_ = data->trees_;
 
@@ -286,6 +289,7 @@ ITK_THREAD_RETURN_TYPE mitk::VigraRandomForestClassifier::TrainTreesCallback(voi
       data->trees_.push_back(tree);
 
     data->m_ClassCount = rf.class_count();
+    data->m_ProblemSpec = rf.ext_param_;
     data->m_mutex->Unlock();
   }
 
@@ -338,8 +342,21 @@ ITK_THREAD_RETURN_TYPE mitk::VigraRandomForestClassifier::PredictCallback(void *
     split_probability = data->m_Probabilities.subarray(lowerBound,upperBound);
   }
 
-  data->m_RandomForest.predictLabels(split_features,split_labels);
+  // predictLabels() would let every tree classify each row a second time, so the labels
+  // are derived from the probabilities in the same way vigra does it (first maximal class).
   data->m_RandomForest.predictProbabilities(split_features, split_probability);
+  for (int row = 0; row < vigra::rowCount(split_probability); ++row)
+  {
+    int maxCol = 0;
+    for (int col = 1; col < vigra::columnCount(split_probability); ++col)
+    {
+      if (split_probability(row, col) > split_probability(row, maxCol))
+        maxCol = col;
+    }
+    int label;
+    data->m_RandomForest.ext_param_.to_classlabel(maxCol, label);
+    split_labels(row, 0) = label;
+  }
 
 
   return ITK_THREAD_RETURN_VALUE;
@@ -439,7 +456,7 @@ void mitk::VigraRandomForestClassifier::VigraPredictWeighted(PredictionData * da
     int maxCol = 0;
     for (int col=0;col<data->m_RandomForest.class_count();++col)
     {
-      if (data->m_Probabilities(row,col) > data->m_Probabilities(row, maxCol))
+      if (P(row,col) > P(row, maxCol))
         maxCol = col;
     }
     data->m_RandomForest.ext_param_.to_classlabel(maxCol, erg);
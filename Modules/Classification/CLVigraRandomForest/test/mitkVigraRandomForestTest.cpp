@@ -18,11 +18,14 @@ found in the LICENSE file.
 #include <itkCSVArray2DFileReader.h>
 #include <itkCSVArray2DDataObject.h>
 #include <mitkVigraRandomForestClassifier.h>
+#include <mitkFlatRandomForest.h>
 #include <itkLabelSampler.h>
 #include <itkAddImageFilter.h>
 #include <mitkImageCast.h>
 #include <mitkStandaloneDataStorage.h>
 
+#include <cstdio>
+
 class mitkVigraRandomForestTestSuite : public mitk::TestFixture
 {
   CPPUNIT_TEST_SUITE(mitkVigraRandomForestTestSuite  );
@@ -35,6 +38,7 @@ class mitkVigraRandomForestTestSuite : public mitk::TestFixture
   MITK_TEST(TrainThreadedDecisionForest_MatlabDataSet_shouldReturnTrue);
   MITK_TEST(PredictWeightedDecisionForest_SetWeightsToZero_shouldReturnTrue);
   MITK_TEST(TrainThreadedDecisionForest_BreastCancerDataSet_shouldReturnTrue);
+  MITK_TEST(PredictFlatRandomForest_BreastCancerDataSet_shouldEqualVigraPrediction);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -136,6 +140,39 @@ public:
     MITK_TEST_CONDITION(isIntervall<int>(Labels_Testing,classes,98,99),"Testvalue of cancer data set is in range.");
   }
 
+  // ------------------------------------------------------------------------------------------------------
+  // ------------------------------------------------------------------------------------------------------
+  /*
+  Flatten the trained forest, write it to a file and map it again. The prediction
+  of the mapped forest has to be the same as the prediction of the vigra forest.
+  */
+  void PredictFlatRandomForest_BreastCancerDataSet_shouldEqualVigraPrediction()
+  {
+    auto & Features_Training = FeatureData_Cancer.first;
+    auto & Features_Testing = FeatureData_Cancer.second;
+    auto & Labels_Training = LabelData_Cancer.first;
+
+    classifier->Train(Features_Training,Labels_Training);
+    Eigen::MatrixXi classes = classifier->Predict(Features_Testing);
+    Eigen::MatrixXd probabilities = classifier->GetPointWiseProbabilities();
+
+    mitk::FlatRandomForest::Pointer flatForest = mitk::FlatRandomForest::New();
+    flatForest->SetRandomForest(classifier);
+    std::string fileName = mitk::IOUtil::CreateTemporaryFile("flatforest_XXXXXX.flatforest");
+    flatForest->Write(fileName);
+
+    mitk::FlatRandomForest::Pointer mappedForest = mitk::FlatRandomForest::New();
+    mappedForest->Load(fileName);
+    Eigen::MatrixXd flatProbabilities;
+    Eigen::MatrixXi flatClasses = mappedForest->Predict(Features_Testing, flatProbabilities);
+    mappedForest = nullptr;
+    std::remove(fileName.c_str());
+
+    CPPUNIT_ASSERT_EQUAL(flatForest->GetNumberOfTrees(), static_cast<unsigned int>(classifier->GetRandomForest().tree_count()));
+    MITK_TEST_CONDITION(flatClasses == classes, "Flat forest predicts the same labels");
+    MITK_TEST_CONDITION(flatProbabilities.isApprox(probabilities, 1e-10), "Flat forest predicts the same probabilities");
+  }
+
   // ------------------------------------------------------------------------------------------------------
   // ------------------------------------------------------------------------------------------------------
 
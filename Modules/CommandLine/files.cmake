@@ -2,4 +2,5 @@ file(GLOB_RECURSE H_FILES RELATIVE "${CMAKE_CURRENT_SOURCE_DIR}" "${CMAKE_CURREN
 
 set(CPP_FILES
   mitkCommandLineParser.cpp
+  mitkCommandLinePipeline.cpp
 )
@@ -0,0 +1,164 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkCommandLinePipeline_h
+#define mitkCommandLinePipeline_h
+
+#include <MitkCommandLineExports.h>
+#include <mitkImage.h>
+
+#include <usAny.h>
+
+#include <functional>
+#include <istream>
+#include <map>
+#include <string>
+#include <vector>
+
+class mitkCommandLineParser;
+
+namespace mitk
+{
+  /**
+   * \brief Runs a chain of MiniApp operations in one process and passes the images between them in memory.
+   *
+   * MiniApps load their inputs from files and save their result, so a chain of MiniApps spends much of its
+   * time in I/O. Operations registered with RegisterOperation() work on images instead and can be combined
+   * into a pipeline: input files are loaded once, every step computes a named image from named images of
+   * the pipeline and output files are saved as soon as their image is computed.
+   *
+   * Steps, loads and saves run on the mitk::ThreadPool as soon as the images they need are available, so
+   * independent branches of a pipeline are executed in parallel. Intermediate images are released after
+   * the last step using them has run, unless SetKeepIntermediateImages(true) is called.
+   *
+   * Pipelines can be described as text (see Parse()), one statement per line:
+   * \code
+   * # name       operation              inputs       arguments of the operation
+   * input  t1    /data/t1.nrrd
+   * input  t2    /data/t2.nrrd
+   * step   diff  TwoImageArithmetic     t1 t2        --subtract --as-double
+   * step   abs   SingleImageArithmetic  diff         --abs
+   * output abs   /results/abs-difference.nrrd
+   * \endcode
+   * The arguments of a step are parsed by a mitkCommandLineParser with the arguments defined by the
+   * operation, i.e. they are the arguments of the corresponding MiniApp without its input and output files.
+   *
+   * Names have to be defined before they are used, so a pipeline cannot contain cycles.
+   */
+  class MITKCOMMANDLINE_EXPORT CommandLinePipeline
+  {
+  public:
+    using Arguments = std::map<std::string, us::Any>;
+
+    /** \brief Computes an image from the input images of a step and the parsed arguments. */
+    using Operation = std::function<Image::Pointer(const std::vector<Image::Pointer> &inputs, const Arguments &arguments)>;
+
+    /** \brief Adds the arguments understood by an operation to the parser, see mitkCommandLineParser::addArgument. */
+    using ArgumentDefinition = std::function<void(mitkCommandLineParser &parser)>;
+
+    /**
+     * \brief Registers an operation for all pipelines, replacing an operation with the same name.
+     *
+     * \param numberOfInputs The number of input images the operation expects
+     */
+    static void RegisterOperation(const std::string &name,
+                                  unsigned int numberOfInputs,
+                                  const ArgumentDefinition &argumentDefinition,
+                                  const Operation &operation);
+
+    static std::vector<std::string> GetRegisteredOperations();
+
+    /** \brief Help text of the arguments of a registered operation. */
+    static std::string GetOperationHelpText(const std::string &operationName);
+
+    CommandLinePipeline();
+    ~CommandLinePipeline();
+
+    CommandLinePipeline(const CommandLinePipeline &) = delete;
+    CommandLinePipeline &operator=(const CommandLinePipeline &) = delete;
+
+    /** \brief Adds an image that is already in memory. */
+    void AddInput(const std::string &name, Image::Pointer image);
+
+    /** \brief Adds an image that is loaded from a file when the pipeline is executed. */
+    void AddInputFile(const std::string &name, const std::string &fileName);
+
+    /**
+     * \brief Adds a step computing the image @a name from the images @a inputs with a registered operation.
+     * \throw mitk::Exception if the name is already used, an input is unknown or the operation is not registered.
+     */
+    void AddStep(const std::string &name,
+                 const std::string &operationName,
+                 const std::vector<std::string> &inputs,
+                 const Arguments &arguments);
+
+    /** \brief Adds a step whose arguments are parsed with the arguments defined by the operation. */
+    void AddStep(const std::string &name,
+                 const std::string &operationName,
+                 const std::vector<std::string> &inputs,
+                 const std::vector<std::string> &commandLineArguments);
+
+    /** \brief Saves the image @a name to a file as soon as it is computed. */
+    void AddOutputFile(const std::string &name, const std::string &fileName);
+
+    /**
+     * \brief Adds the statements of a pipeline description, see the class documentation.
+     *
+     * Lines are split at white space, quotes are not supported. Empty lines and lines starting with '#'
+     * are ignored. The statement "output <name> <file>" saves an image.
+     */
+    void Parse(std::istream &stream);
+
+    /** \brief Keep the images of all steps after Execute(), e.g. to retrieve them with GetImage() (default: false). */
+    void SetKeepIntermediateImages(bool keep);
+
+    /**
+     * \brief Loads the input files, runs all steps and saves the output files.
+     * \throw mitk::Exception or the exception of the operation if a step fails. Steps which have not started
+     * yet are skipped then.
+     */
+    void Execute();
+
+    /** \brief The image @a name, nullptr if it is unknown, not computed yet or released. */
+    Image::Pointer GetImage(const std::string &name) const;
+
+  private:
+    /** \brief An image of the pipeline and how it is obtained. */
+    struct Node
+    {
+      std::string Name;
+      /** \brief The file of an input file, empty otherwise */
+      std::string FileName;
+      /** \brief The operation of a step, empty otherwise */
+      std::string OperationName;
+      Arguments OperationArguments;
+      std::vector<std::size_t> Inputs;
+      std::vector<std::size_t> Consumers;
+      std::vector<std::string> OutputFileNames;
+      /** \brief True for images added by AddInput(), which are never released */
+      bool IsInMemoryInput = false;
+      Image::Pointer Result;
+    };
+
+    Node &AddNode(const std::string &name);
+    std::size_t GetNodeIndex(const std::string &name) const;
+
+    /** \brief Loads or computes the image of the node and saves its output files. */
+    void ExecuteNode(Node &node);
+
+    std::vector<Node> m_Nodes;
+    std::map<std::string, std::size_t> m_NodeIndices;
+    bool m_KeepIntermediateImages;
+  };
+}
+
+#endif
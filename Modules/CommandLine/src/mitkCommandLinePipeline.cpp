@@ -0,0 +1,370 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkCommandLinePipeline.h"
+#include "mitkCommandLineParser.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkIOUtil.h>
+#include <mitkLogMacros.h>
+#include <mitkThreadPool.h>
+
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+namespace
+{
+  struct RegisteredOperation
+  {
+    unsigned int NumberOfInputs;
+    mitk::CommandLinePipeline::ArgumentDefinition DefineArguments;
+    mitk::CommandLinePipeline::Operation Function;
+  };
+
+  std::mutex &GetRegistryMutex()
+  {
+    static std::mutex mutex;
+    return mutex;
+  }
+
+  std::map<std::string, RegisteredOperation> &GetRegistry()
+  {
+    static std::map<std::string, RegisteredOperation> registry;
+    return registry;
+  }
+
+  RegisteredOperation GetRegisteredOperation(const std::string &name)
+  {
+    std::lock_guard<std::mutex> lock(GetRegistryMutex());
+    auto it = GetRegistry().find(name);
+    if (it == GetRegistry().end())
+      mitkThrow() << "Operation \"" << name << "\" is not registered.";
+
+    return it->second;
+  }
+
+  void DefineArguments(const RegisteredOperation &operation, mitkCommandLineParser &parser)
+  {
+    parser.setArgumentPrefix("--", "-");
+    parser.setStrictModeEnabled(true);
+    if (operation.DefineArguments)
+      operation.DefineArguments(parser);
+  }
+
+  /** State of one execution, shared by the tasks, which may finish after Execute() has returned. */
+  struct ExecutionState
+  {
+    std::mutex Mutex;
+    std::condition_variable Finished;
+    std::vector<std::size_t> NumberOfMissingInputs;
+    std::vector<std::size_t> NumberOfRemainingConsumers;
+    std::size_t NumberOfUnfinishedTasks = 0;
+    std::exception_ptr Error;
+  };
+}
+
+void mitk::CommandLinePipeline::RegisterOperation(const std::string &name,
+                                                  unsigned int numberOfInputs,
+                                                  const ArgumentDefinition &argumentDefinition,
+                                                  const Operation &operation)
+{
+  std::lock_guard<std::mutex> lock(GetRegistryMutex());
+  GetRegistry()[name] = RegisteredOperation{numberOfInputs, argumentDefinition, operation};
+}
+
+std::vector<std::string> mitk::CommandLinePipeline::GetRegisteredOperations()
+{
+  std::lock_guard<std::mutex> lock(GetRegistryMutex());
+
+  std::vector<std::string> names;
+  for (const auto &operation : GetRegistry())
+    names.push_back(operation.first);
+
+  return names;
+}
+
+std::string mitk::CommandLinePipeline::GetOperationHelpText(const std::string &operationName)
+{
+  const RegisteredOperation operation = GetRegisteredOperation(operationName);
+
+  mitkCommandLineParser parser;
+  DefineArguments(operation, parser);
+  return parser.helpText();
+}
+
+mitk::CommandLinePipeline::CommandLinePipeline() : m_KeepIntermediateImages(false)
+{
+}
+
+mitk::CommandLinePipeline::~CommandLinePipeline()
+{
+}
+
+mitk::CommandLinePipeline::Node &mitk::CommandLinePipeline::AddNode(const std::string &name)
+{
+  if (name.empty())
+    mitkThrow() << "The name of an image of the pipeline is empty.";
+
+  if (m_NodeIndices.count(name) != 0)
+    mitkThrow() << "The name \"" << name << "\" is used twice in the pipeline.";
+
+  m_NodeIndices[name] = m_Nodes.size();
+  m_Nodes.emplace_back();
+  m_Nodes.back().Name = name;
+  return m_Nodes.back();
+}
+
+std::size_t mitk::CommandLinePipeline::GetNodeIndex(const std::string &name) const
+{
+  auto it = m_NodeIndices.find(name);
+  if (it == m_NodeIndices.end())
+    mitkThrow() << "The image \"" << name << "\" is not defined in the pipeline before it is used.";
+
+  return it->second;
+}
+
+void mitk::CommandLinePipeline::AddInput(const std::string &name, Image::Pointer image)
+{
+  if (image.IsNull())
+    mitkThrow() << "The input image \"" << name << "\" is null.";
+
+  Node &node = this->AddNode(name);
+  node.IsInMemoryInput = true;
+  node.Result = image;
+}
+
+void mitk::CommandLinePipeline::AddInputFile(const std::string &name, const std::string &fileName)
+{
+  this->AddNode(name).FileName = fileName;
+}
+
+void mitk::CommandLinePipeline::AddStep(const std::string &name,
+                                        const std::string &operationName,
+                                        const std::vector<std::string> &inputs,
+                                        const Arguments &arguments)
+{
+  const RegisteredOperation operation = GetRegisteredOperation(operationName);
+  if (inputs.size() != operation.NumberOfInputs)
+  {
+    mitkThrow() << "Step \"" << name << "\": operation \"" << operationName << "\" expects "
+                << operation.NumberOfInputs << " input images, not " << inputs.size() << ".";
+  }
+
+  std::vector<std::size_t> inputIndices;
+  for (const auto &input : inputs)
+    inputIndices.push_back(this->GetNodeIndex(input));
+
+  const std::size_t index = m_Nodes.size();
+  Node &node = this->AddNode(name);
+  node.OperationName = operationName;
+  node.OperationArguments = arguments;
+  node.Inputs = inputIndices;
+
+  for (auto inputIndex : inputIndices)
+    m_Nodes[inputIndex].Consumers.push_back(index);
+}
+
+void mitk::CommandLinePipeline::AddStep(const std::string &name,
+                                        const std::string &operationName,
+                                        const std::vector<std::string> &inputs,
+                                        const std::vector<std::string> &commandLineArguments)
+{
+  mitkCommandLineParser parser;
+  DefineArguments(GetRegisteredOperation(operationName), parser);
+
+  // the parser skips the first argument, which is the program name on the command line
+  mitkCommandLineParser::StringContainerType arguments(1, operationName);
+  arguments.insert(arguments.end(), commandLineArguments.begin(), commandLineArguments.end());
+
+  bool ok = false;
+  Arguments parsedArguments = parser.parseArguments(arguments, &ok);
+  if (!ok)
+    mitkThrow() << "Step \"" << name << "\": " << parser.errorString();
+
+  this->AddStep(name, operationName, inputs, parsedArguments);
+}
+
+void mitk::CommandLinePipeline::AddOutputFile(const std::string &name, const std::string &fileName)
+{
+  m_Nodes[this->GetNodeIndex(name)].OutputFileNames.push_back(fileName);
+}
+
+void mitk::CommandLinePipeline::Parse(std::istream &stream)
+{
+  std::string line;
+  unsigned int lineNumber = 0;
+  while (std::getline(stream, line))
+  {
+    ++lineNumber;
+
+    std::istringstream lineStream(line);
+    std::vector<std::string> tokens;
+    std::string token;
+    while (lineStream >> token)
+      tokens.push_back(token);
+
+    if (tokens.empty() || tokens[0][0] == '#')
+      continue;
+
+    const std::string &statement = tokens[0];
+    if ((statement == "input" || statement == "output") && tokens.size() == 3)
+    {
+      if (statement == "input")
+        this->AddInputFile(tokens[1], tokens[2]);
+      else
+        this->AddOutputFile(tokens[1], tokens[2]);
+    }
+    else if (statement == "step" && tokens.size() >= 3)
+    {
+      // the inputs are followed by the arguments, which start with the argument prefix
+      auto firstArgument = tokens.begin() + 3;
+      while (firstArgument != tokens.end() && (*firstArgument)[0] != '-')
+        ++firstArgument;
+
+      this->AddStep(tokens[1],
+                    tokens[2],
+                    std::vector<std::string>(tokens.begin() + 3, firstArgument),
+                    std::vector<std::string>(firstArgument, tokens.end()));
+    }
+    else
+    {
+      mitkThrow() << "Invalid statement in line " << lineNumber << " of the pipeline: " << line;
+    }
+  }
+}
+
+void mitk::CommandLinePipeline::SetKeepIntermediateImages(bool keep)
+{
+  m_KeepIntermediateImages = keep;
+}
+
+void mitk::CommandLinePipeline::ExecuteNode(Node &node)
+{
+  if (!node.FileName.empty())
+  {
+    MITK_INFO << "Loading " << node.Name << " from " << node.FileName;
+    node.Result = IOUtil::Load<Image>(node.FileName);
+    if (node.Result.IsNull())
+      mitkThrow() << "The file " << node.FileName << " of \"" << node.Name << "\" does not contain an image.";
+  }
+  else if (!node.OperationName.empty())
+  {
+    std::vector<Image::Pointer> inputs;
+    for (auto inputIndex : node.Inputs)
+      inputs.push_back(m_Nodes[inputIndex].Result);
+
+    MITK_INFO << "Computing " << node.Name << " with " << node.OperationName;
+    node.Result = GetRegisteredOperation(node.OperationName).Function(inputs, node.OperationArguments);
+    if (node.Result.IsNull())
+      mitkThrow() << "Operation \"" << node.OperationName << "\" did not compute an image for \"" << node.Name << "\".";
+  }
+
+  for (const auto &fileName : node.OutputFileNames)
+  {
+    MITK_INFO << "Saving " << node.Name << " to " << fileName;
+    IOUtil::Save(node.Result, fileName);
+  }
+}
+
+void mitk::CommandLinePipeline::Execute()
+{
+  if (m_Nodes.empty())
+    return;
+
+  auto state = std::make_shared<ExecutionState>();
+  state->NumberOfRemainingConsumers.resize(m_Nodes.size());
+  for (std::size_t i = 0; i < m_Nodes.size(); ++i)
+  {
+    state->NumberOfMissingInputs.push_back(m_Nodes[i].Inputs.size());
+    state->NumberOfRemainingConsumers[i] = m_Nodes[i].Consumers.size();
+  }
+
+  auto &threadPool = ThreadPool::GetInstance();
+
+  // Called with the mutex of the state locked. The tasks only call it before they are counted as finished,
+  // so it is still alive then.
+  std::function<void(std::size_t)> submit;
+  submit = [this, state, &threadPool, &submit](std::size_t index) {
+    ++state->NumberOfUnfinishedTasks;
+    threadPool.Submit([this, state, index, &submit]() {
+      std::exception_ptr error;
+      bool canceled = false;
+      {
+        std::lock_guard<std::mutex> lock(state->Mutex);
+        canceled = state->Error != nullptr;
+      }
+
+      if (!canceled)
+      {
+        try
+        {
+          this->ExecuteNode(m_Nodes[index]);
+        }
+        catch (...)
+        {
+          error = std::current_exception();
+        }
+      }
+
+      std::lock_guard<std::mutex> lock(state->Mutex);
+      if (error && !state->Error)
+        state->Error = error;
+
+      // the images of the inputs are not needed anymore once all of their consumers have run
+      for (auto inputIndex : m_Nodes[index].Inputs)
+      {
+        Node &input = m_Nodes[inputIndex];
+        if (0 == --state->NumberOfRemainingConsumers[inputIndex] && !m_KeepIntermediateImages &&
+            !input.IsInMemoryInput)
+        {
+          input.Result = nullptr;
+        }
+      }
+
+      if (!state->Error)
+      {
+        for (auto consumerIndex : m_Nodes[index].Consumers)
+        {
+          if (0 == --state->NumberOfMissingInputs[consumerIndex])
+            submit(consumerIndex);
+        }
+      }
+
+      if (0 == --state->NumberOfUnfinishedTasks)
+        state->Finished.notify_all();
+    });
+  };
+
+  std::unique_lock<std::mutex> lock(state->Mutex);
+  for (std::size_t i = 0; i < m_Nodes.size(); ++i)
+  {
+    if (m_Nodes[i].Inputs.empty())
+      submit(i);
+  }
+
+  state->Finished.wait(lock, [state] { return 0 == state->NumberOfUnfinishedTasks; });
+
+  if (state->Error)
+    std::rethrow_exception(state->Error);
+}
+
+mitk::Image::Pointer mitk::CommandLinePipeline::GetImage(const std::string &name) const
+{
+  auto it = m_NodeIndices.find(name);
+  if (it == m_NodeIndices.end())
+    return nullptr;
+
+  return m_Nodes[it->second].Result;
+}
@@ -10,6 +10,7 @@ found in the LICENSE file.
 
 ============================================================================*/
 #include <algorithm>
+#include <new>
 #include <mitkContourElement.h>
 #include <vtkMath.h>
 
@@ -39,6 +40,22 @@ void mitk::ContourElement::AddVertex(VertexType &vertex)
   this->m_Vertices->push_back(&vertex);
 }
 
+void mitk::ContourElement::AddVertices(const std::vector<mitk::Point3D> &points, bool isControlPoint)
+{
+  if (points.empty())
+    return;
+
+  // Like the single vertices, the block is never released: the vertices are handed out as raw pointers and
+  // may be shared with other contours (see Concatenate()), which can outlive this element.
+  auto *block = static_cast<VertexType *>(::operator new(points.size() * sizeof(VertexType)));
+
+  for (const auto &point : points)
+  {
+    this->m_Vertices->push_back(new (block) VertexType(point, isControlPoint));
+    ++block;
+  }
+}
+
 void mitk::ContourElement::AddVertexAtFront(mitk::Point3D &vertex, bool isControlPoint)
 {
   this->m_Vertices->push_front(new VertexType(vertex, isControlPoint));
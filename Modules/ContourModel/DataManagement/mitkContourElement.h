@@ -19,6 +19,7 @@ found in the LICENSE file.
 //#include <ANN/ANN.h>
 
 #include <deque>
+#include <vector>
 
 namespace mitk
 {
@@ -46,7 +47,9 @@ namespace mitk
       */
       struct ContourModelVertex
     {
-      ContourModelVertex(mitk::Point3D &point, bool active = false) : IsControlPoint(active), Coordinates(point) {}
+      ContourModelVertex(const mitk::Point3D &point, bool active = false) : IsControlPoint(active), Coordinates(point)
+      {
+      }
       ContourModelVertex(const ContourModelVertex &other)
         : IsControlPoint(other.IsControlPoint), Coordinates(other.Coordinates)
       {
@@ -95,6 +98,14 @@ namespace mitk
     */
     virtual void AddVertex(VertexType &vertex);
 
+    /** \brief Add several vertices at the end of the contour.
+    The vertices are allocated as one contiguous block instead of one by one, which is considerably
+    faster for large contours (e.g. when reading RT structure sets).
+    \param points - coordinates in 3D space.
+    \param isControlPoint - are the vertices special control points.
+    */
+    virtual void AddVertices(const std::vector<mitk::Point3D> &points, bool isControlPoint);
+
     /** \brief Add a vertex at the front of the contour
     \param point - coordinates in 3D space.
     \param isControlPoint - is the vertex a control point.
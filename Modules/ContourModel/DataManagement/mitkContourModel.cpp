@@ -49,6 +49,17 @@ void mitk::ContourModel::AddVertex(mitk::Point3D &vertex, bool isControlPoint, i
   }
 }
 
+void mitk::ContourModel::AddVertices(const std::vector<mitk::Point3D> &points, bool isControlPoint, int timestep)
+{
+  if (!this->IsEmptyTimeStep(timestep) && !points.empty())
+  {
+    this->m_ContourSeries[timestep]->AddVertices(points, isControlPoint);
+    this->InvokeEvent(ContourModelSizeChangeEvent());
+    this->Modified();
+    this->m_UpdateBoundingBox = true;
+  }
+}
+
 void mitk::ContourModel::AddVertex(VertexType &vertex, int timestep)
 {
   if (!this->IsEmptyTimeStep(timestep))
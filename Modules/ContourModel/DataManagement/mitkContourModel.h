@@ -146,6 +146,19 @@ namespace mitk
     */
     void AddVertex(mitk::Point3D &vertex, bool isControlPoint, int timestep = 0);
 
+    /** \brief Add several vertices at the end of the contour at given timestep.
+    Use this instead of adding the vertices one by one when building large contours: the vertices are
+    allocated as one block and the contour is modified (and the size change event is sent) only once.
+
+    \param points - coordinates of the vertices
+    \param isControlPoint - specifies the vertices to be handled in a special way
+    \param timestep - the timestep at which the vertices will be added ( default 0)
+
+    @Note Adding vertices to a timestep which exceeds the timebounds of the contour
+    will not be added, the TimeGeometry will not be expanded.
+    */
+    void AddVertices(const std::vector<mitk::Point3D> &points, bool isControlPoint = false, int timestep = 0);
+
     /** \brief Add a vertex to the contour at given timestep AT THE FRONT of the contour.
     The vertex is added at the FRONT of contour.
 
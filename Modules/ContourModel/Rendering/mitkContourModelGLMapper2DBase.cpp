@@ -164,99 +164,78 @@ void mitk::ContourModelGLMapper2DBase::InternalDrawContour(mitk::ContourModel *r
     bool projectmode = false;
     dataNode->GetVisibility(projectmode, renderer, "contour.project-onto-plane");
 
-    auto pointsIt = renderingContour->IteratorBegin(timestep);
-
-    Point2D pt2d; // projected_p in display coordinates
-    Point2D lastPt2d;
-
-    int index = 0;
-
     mitk::ScalarType maxDiff = 0.25;
+    const mitk::PlaneGeometry *worldPlaneGeometry = renderer->GetCurrentWorldPlaneGeometry();
 
-    while (pointsIt != renderingContour->IteratorEnd(timestep))
-    {
-      lastPt2d = pt2d;
+    // project all vertices first, so that the segments can be drawn as polylines instead of single lines
+    const auto numberOfVertices = static_cast<std::size_t>(renderingContour->GetNumberOfVertices(timestep));
+    m_DisplayPoints.resize(numberOfVertices);
+    m_DrawVertex.resize(numberOfVertices);
 
+    std::size_t i = 0;
+    for (auto pointsIt = renderingContour->IteratorBegin(timestep); pointsIt != renderingContour->IteratorEnd(timestep);
+         ++pointsIt, ++i)
+    {
       point = (*pointsIt)->Coordinates;
 
       itk2vtk(point, vtkp);
       transform->TransformPoint(vtkp, vtkp);
       vtk2itk(vtkp, p);
 
-      renderer->WorldToView(p, pt2d);
+      renderer->WorldToView(p, m_DisplayPoints[i]);
 
-      ScalarType scalardiff = fabs(renderer->GetCurrentWorldPlaneGeometry()->SignedDistance(p));
+      // project to plane or draw the point only if it is close enough
+      m_DrawVertex[i] = projectmode || fabs(worldPlaneGeometry->SignedDistance(p)) < maxDiff;
+    }
 
-      // project to plane
-      if (projectmode)
-      {
-        drawit = true;
-      }
-      else if (scalardiff < maxDiff) // point is close enough to be drawn
-      {
-        drawit = true;
-      }
-      else
-      {
-        drawit = false;
-      }
+    drawit = numberOfVertices > 0 && m_DrawVertex.back();
 
-      // draw line
-      if (drawit)
+    if (showSegments)
+    {
+      // a segment is drawn if its end point is drawn
+      this->m_Context->GetPen()->SetWidth(lineWidth);
+      m_PolyLine.clear();
+      for (i = 1; i <= numberOfVertices; ++i)
       {
-        if (showSegments)
+        if (i < numberOfVertices && m_DrawVertex[i])
         {
-          // lastPt2d is not valid in first step
-          if (!(pointsIt == renderingContour->IteratorBegin(timestep)))
+          if (m_PolyLine.empty())
           {
-            this->m_Context->GetPen()->SetWidth(lineWidth);
-            this->m_Context->DrawLine(pt2d[0], pt2d[1], lastPt2d[0], lastPt2d[1]);
-            this->m_Context->GetPen()->SetWidth(1);
+            m_PolyLine.push_back(m_DisplayPoints[i - 1][0]);
+            m_PolyLine.push_back(m_DisplayPoints[i - 1][1]);
           }
+          m_PolyLine.push_back(m_DisplayPoints[i][0]);
+          m_PolyLine.push_back(m_DisplayPoints[i][1]);
         }
-
-        if (showControlPoints)
+        else if (!m_PolyLine.empty())
         {
-          // draw ontrol points
-          if ((*pointsIt)->IsControlPoint)
-          {
-            float pointsize = 4;
-            Point2D tmp;
-
-            Vector2D horz, vert;
-            horz[1] = 0;
-            vert[0] = 0;
-            horz[0] = pointsize;
-            vert[1] = pointsize;
-            this->m_Context->GetPen()->SetColorF(selectedcolor->GetColor().GetRed(),
-                                                 selectedcolor->GetColor().GetBlue(),
-                                                 selectedcolor->GetColor().GetGreen());
-            this->m_Context->GetPen()->SetWidth(1);
-            // a rectangle around the point with the selected color
-            auto* rectPts = new float[8];
-            tmp = pt2d - horz;
-            rectPts[0] = tmp[0];
-            rectPts[1] = tmp[1];
-            tmp = pt2d + vert;
-            rectPts[2] = tmp[0];
-            rectPts[3] = tmp[1];
-            tmp = pt2d + horz;
-            rectPts[4] = tmp[0];
-            rectPts[5] = tmp[1];
-            tmp = pt2d - vert;
-            rectPts[6] = tmp[0];
-            rectPts[7] = tmp[1];
-            this->m_Context->DrawPolygon(rectPts,4);
-            // the actual point in the specified color to see the usual color of the point
-            this->m_Context->GetPen()->SetColorF(
-              colorprop->GetColor().GetRed(), colorprop->GetColor().GetGreen(), colorprop->GetColor().GetBlue());
-            this->m_Context->DrawPoint(pt2d[0], pt2d[1]);
-          }
+          this->m_Context->DrawPoly(m_PolyLine.data(), static_cast<int>(m_PolyLine.size() / 2));
+          m_PolyLine.clear();
         }
+      }
+      this->m_Context->GetPen()->SetWidth(1);
+    }
 
-        if (showPoints)
+    Point2D pt2d; // projected_p in display coordinates
+    Point2D lastPt2d;
+
+    int index = 0;
+
+    i = 0;
+    for (auto pointsIt = renderingContour->IteratorBegin(timestep); pointsIt != renderingContour->IteratorEnd(timestep);
+         ++pointsIt, ++i)
+    {
+      if (!m_DrawVertex[i])
+        continue;
+
+      pt2d = m_DisplayPoints[i];
+
+      if (showControlPoints)
+      {
+        // draw ontrol points
+        if ((*pointsIt)->IsControlPoint)
         {
-          float pointsize = 3;
+          float pointsize = 4;
           Point2D tmp;
 
           Vector2D horz, vert;
@@ -264,10 +243,12 @@ void mitk::ContourModelGLMapper2DBase::InternalDrawContour(mitk::ContourModel *r
           vert[0] = 0;
           horz[0] = pointsize;
           vert[1] = pointsize;
-          this->m_Context->GetPen()->SetColorF(0.0, 0.0, 0.0);
+          this->m_Context->GetPen()->SetColorF(selectedcolor->GetColor().GetRed(),
+                                               selectedcolor->GetColor().GetBlue(),
+                                               selectedcolor->GetColor().GetGreen());
           this->m_Context->GetPen()->SetWidth(1);
           // a rectangle around the point with the selected color
-          auto* rectPts = new float[8];
+          float rectPts[8];
           tmp = pt2d - horz;
           rectPts[0] = tmp[0];
           rectPts[1] = tmp[1];
@@ -286,47 +267,78 @@ void mitk::ContourModelGLMapper2DBase::InternalDrawContour(mitk::ContourModel *r
             colorprop->GetColor().GetRed(), colorprop->GetColor().GetGreen(), colorprop->GetColor().GetBlue());
           this->m_Context->DrawPoint(pt2d[0], pt2d[1]);
         }
+      }
 
-        if (showPointsNumbers)
-        {
-          std::string l;
-          std::stringstream ss;
-          ss << index;
-          l.append(ss.str());
+      if (showPoints)
+      {
+        float pointsize = 3;
+        Point2D tmp;
 
-          float rgb[3];
-          rgb[0] = 0.0;
-          rgb[1] = 0.0;
-          rgb[2] = 0.0;
+        Vector2D horz, vert;
+        horz[1] = 0;
+        vert[0] = 0;
+        horz[0] = pointsize;
+        vert[1] = pointsize;
+        this->m_Context->GetPen()->SetColorF(0.0, 0.0, 0.0);
+        this->m_Context->GetPen()->SetWidth(1);
+        // a rectangle around the point with the selected color
+        float rectPts[8];
+        tmp = pt2d - horz;
+        rectPts[0] = tmp[0];
+        rectPts[1] = tmp[1];
+        tmp = pt2d + vert;
+        rectPts[2] = tmp[0];
+        rectPts[3] = tmp[1];
+        tmp = pt2d + horz;
+        rectPts[4] = tmp[0];
+        rectPts[5] = tmp[1];
+        tmp = pt2d - vert;
+        rectPts[6] = tmp[0];
+        rectPts[7] = tmp[1];
+        this->m_Context->DrawPolygon(rectPts, 4);
+        // the actual point in the specified color to see the usual color of the point
+        this->m_Context->GetPen()->SetColorF(
+          colorprop->GetColor().GetRed(), colorprop->GetColor().GetGreen(), colorprop->GetColor().GetBlue());
+        this->m_Context->DrawPoint(pt2d[0], pt2d[1]);
+      }
 
-          WriteTextWithAnnotation(m_PointNumbersAnnotation, l.c_str(), rgb, pt2d, renderer);
-        }
+      if (showPointsNumbers)
+      {
+        std::string l;
+        std::stringstream ss;
+        ss << index;
+        l.append(ss.str());
 
-        if (showControlPointsNumbers && (*pointsIt)->IsControlPoint)
-        {
-          std::string l;
-          std::stringstream ss;
-          ss << index;
-          l.append(ss.str());
+        float rgb[3];
+        rgb[0] = 0.0;
+        rgb[1] = 0.0;
+        rgb[2] = 0.0;
 
-          float rgb[3];
-          rgb[0] = 1.0;
-          rgb[1] = 1.0;
-          rgb[2] = 0.0;
+        WriteTextWithAnnotation(m_PointNumbersAnnotation, l.c_str(), rgb, pt2d, renderer);
+      }
 
-          WriteTextWithAnnotation(m_ControlPointNumbersAnnotation, l.c_str(), rgb, pt2d, renderer);
-        }
+      if (showControlPointsNumbers && (*pointsIt)->IsControlPoint)
+      {
+        std::string l;
+        std::stringstream ss;
+        ss << index;
+        l.append(ss.str());
+
+        float rgb[3];
+        rgb[0] = 1.0;
+        rgb[1] = 1.0;
+        rgb[2] = 0.0;
 
-        index++;
+        WriteTextWithAnnotation(m_ControlPointNumbersAnnotation, l.c_str(), rgb, pt2d, renderer);
       }
 
-      pointsIt++;
-    } // end while iterate over controlpoints
+      index++;
+    } // end for iterate over controlpoints
 
     // close contour if necessary
     if (renderingContour->IsClosed(timestep) && drawit && showSegments)
     {
-      lastPt2d = pt2d;
+      lastPt2d = m_DisplayPoints.back();
       point = renderingContour->GetVertexAt(0, timestep)->Coordinates;
       itk2vtk(point, vtkp);
       transform->TransformPoint(vtkp, vtkp);
@@ -361,10 +373,9 @@ void mitk::ContourModelGLMapper2DBase::InternalDrawContour(mitk::ContourModel *r
 
         this->m_Context->GetPen()->SetColorF(0.0, 1.0, 0.0);
         this->m_Context->GetPen()->SetWidth(1);
-        // a rectangle around the point with the selected color
-        auto* rectPts = new float[8];
         // a diamond around the point
         // begin from upper left corner and paint clockwise
+        float rectPts[8];
         rectPts[0] = pt2d[0] - pointsize;
         rectPts[1] = pt2d[1] + pointsize;
         rectPts[2] = pt2d[0] + pointsize;
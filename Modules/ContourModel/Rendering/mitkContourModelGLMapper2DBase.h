@@ -19,6 +19,8 @@ found in the LICENSE file.
 #include <MitkContourModelExports.h>
 #include "vtkNew.h"
 
+#include <vector>
+
 class vtkContext2D;
 class vtkPen;
 
@@ -65,6 +67,12 @@ namespace mitk
     bool m_Initialized;
 
     vtkNew<vtkContext2D> m_Context;
+
+  private:
+    /** \brief Buffers of the projected vertices, reused for every contour that is drawn. */
+    std::vector<Point2D> m_DisplayPoints;
+    std::vector<bool> m_DrawVertex;
+    std::vector<float> m_PolyLine;
   };
 
 } // namespace mitk
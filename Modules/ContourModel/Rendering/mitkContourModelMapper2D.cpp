@@ -178,35 +178,27 @@ vtkSmartPointer<vtkPolyData> mitk::ContourModelMapper2D::CreateVtkPolyDataFromCo
 
     // iterate over all control points
     auto current = renderingContour->IteratorBegin(timestep);
-    auto next = renderingContour->IteratorBegin(timestep);
-    if (next != renderingContour->IteratorEnd(timestep))
+    auto end = renderingContour->IteratorEnd(timestep);
+    if (current != end)
     {
-      next++;
+      // every vertex is inserted once and connected by a single polyline
+      const auto numberOfVertices = static_cast<vtkIdType>(renderingContour->GetNumberOfVertices(timestep));
+      const bool isClosed = renderingContour->IsClosed(timestep);
+      points->SetNumberOfPoints(numberOfVertices);
 
-      auto end = renderingContour->IteratorEnd(timestep);
-
-      while (next != end)
+      vtkIdType pointId = 0;
+      for (; current != end; ++current, ++pointId)
       {
         mitk::ContourModel::VertexType *currentControlPoint = *current;
-        mitk::ContourModel::VertexType *nextControlPoint = *next;
-
-        vtkIdType p1 = points->InsertNextPoint(currentControlPoint->Coordinates[0],
-                                               currentControlPoint->Coordinates[1],
-                                               currentControlPoint->Coordinates[2]);
-        vtkIdType p2 = points->InsertNextPoint(
-          nextControlPoint->Coordinates[0], nextControlPoint->Coordinates[1], nextControlPoint->Coordinates[2]);
-        // add the line between both contorlPoints
-        lines->InsertNextCell(2);
-        lines->InsertCellPoint(p1);
-        lines->InsertCellPoint(p2);
+
+        double coordinates[3];
+        coordinates[0] = currentControlPoint->Coordinates[0];
+        coordinates[1] = currentControlPoint->Coordinates[1];
+        coordinates[2] = currentControlPoint->Coordinates[2];
+        points->SetPoint(pointId, coordinates);
 
         if (currentControlPoint->IsControlPoint)
         {
-          double coordinates[3];
-          coordinates[0] = currentControlPoint->Coordinates[0];
-          coordinates[1] = currentControlPoint->Coordinates[1];
-          coordinates[2] = currentControlPoint->Coordinates[2];
-
           double distance = plane->DistanceToPlane(coordinates);
           if (distance < 0.1)
           {
@@ -218,49 +210,20 @@ vtkSmartPointer<vtkPolyData> mitk::ContourModelMapper2D::CreateVtkPolyDataFromCo
             appendPoly->AddInputConnection(sphere->GetOutputPort());
           }
         }
-
-        current++;
-        next++;
-      } // end while (it!=end)
-
-      // check if last control point is enabled to draw it
-      if ((*current)->IsControlPoint)
-      {
-        double coordinates[3];
-        coordinates[0] = (*current)->Coordinates[0];
-        coordinates[1] = (*current)->Coordinates[1];
-        coordinates[2] = (*current)->Coordinates[2];
-
-        double distance = plane->DistanceToPlane(coordinates);
-        if (distance < 0.1)
-        {
-          vtkSmartPointer<vtkSphereSource> sphere = vtkSmartPointer<vtkSphereSource>::New();
-
-          sphere->SetRadius(1.2);
-          sphere->SetCenter(coordinates[0], coordinates[1], coordinates[2]);
-          sphere->Update();
-          appendPoly->AddInputConnection(sphere->GetOutputPort());
-        }
       }
 
       /* If the contour is closed an additional line has to be created between the very first point
       * and the last point
       */
-      if (renderingContour->IsClosed(timestep))
+      const vtkIdType numberOfLinePoints = numberOfVertices + (isClosed ? 1 : 0);
+      if (numberOfLinePoints > 1)
       {
-        // add a line from the last to the first control point
-        mitk::ContourModel::VertexType *firstControlPoint = *(renderingContour->IteratorBegin(timestep));
-        mitk::ContourModel::VertexType *lastControlPoint = *(--(renderingContour->IteratorEnd(timestep)));
-        vtkIdType p2 = points->InsertNextPoint(
-          lastControlPoint->Coordinates[0], lastControlPoint->Coordinates[1], lastControlPoint->Coordinates[2]);
-        vtkIdType p1 = points->InsertNextPoint(
-          firstControlPoint->Coordinates[0], firstControlPoint->Coordinates[1], firstControlPoint->Coordinates[2]);
-
-        // add the line between both contorlPoints
-        lines->InsertNextCell(2);
-        lines->InsertCellPoint(p1);
-        lines->InsertCellPoint(p2);
-      } // end if(isClosed)
+        lines->InsertNextCell(numberOfLinePoints);
+        for (pointId = 0; pointId < numberOfVertices; ++pointId)
+          lines->InsertCellPoint(pointId);
+        if (isClosed)
+          lines->InsertCellPoint(0);
+      }
 
       // Add the points to the dataset
       polyDataIn3D->SetPoints(points);
@@ -48,6 +48,12 @@ void mitk::ContourModelSetGLMapper2D::MitkRender(mitk::BaseRenderer *renderer, m
 
     while (it != end)
     {
+        if ((*it)->IsEmpty())
+        {
+          ++it;
+          continue;
+        }
+
         //we have the assumption that each contour model vertex has the same z coordinate
         auto currentZValue = (*it)->GetVertexAt(0)->Coordinates[2];
         double acceptedDeviationInMM = 5.0;
@@ -25,6 +25,37 @@ static void TestAddVertex()
   MITK_TEST_CONDITION(contour->GetNumberOfVertices() > 0, "Add a Vertex, size increased");
 }
 
+// Add several vertices at once and see if they are appended in order
+static void TestAddVertices()
+{
+  mitk::ContourModel::Pointer contour = mitk::ContourModel::New();
+
+  mitk::Point3D p;
+  p[0] = p[1] = p[2] = 0;
+  contour->AddVertex(p);
+
+  std::vector<mitk::Point3D> points(100);
+  for (unsigned int i = 0; i < points.size(); ++i)
+  {
+    points[i][0] = i;
+    points[i][1] = 2 * i;
+    points[i][2] = 3;
+  }
+
+  contour->AddVertices(points, true);
+
+  MITK_TEST_CONDITION(contour->GetNumberOfVertices() == 101, "Add vertices, size increased");
+
+  bool verticesCorrect = true;
+  for (unsigned int i = 0; i < points.size(); ++i)
+  {
+    const mitk::ContourModel::VertexType *vertex = contour->GetVertexAt(i + 1);
+    verticesCorrect = verticesCorrect && vertex->Coordinates == points[i] && vertex->IsControlPoint;
+  }
+
+  MITK_TEST_CONDITION(verticesCorrect, "Added vertices are appended in order");
+}
+
 // Select a vertex by index. successful if the selected vertex member of the contour is no longer set to null
 static void TestSelectVertexAtIndex()
 {
@@ -401,6 +432,7 @@ int mitkContourModelTest(int /*argc*/, char * /*argv*/ [])
   MITK_TEST_BEGIN("mitkContourModelTest")
 
   TestAddVertex();
+  TestAddVertices();
   TestSelectVertexAtIndex();
   TestSelectVertexAtWorldposition();
   TestMoveSelectedVertex();
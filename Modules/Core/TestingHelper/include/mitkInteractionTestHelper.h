@@ -58,6 +58,12 @@ namespace mitk
      */
     InteractionTestHelper(const std::string &interactionXmlFilePath);
 
+    /**
+     * @brief Like InteractionTestHelper(const std::string &), optionally with off-screen render windows.
+     * @param offScreen render into off-screen buffers, e.g. for benchmarks on machines without display
+     */
+    InteractionTestHelper(const std::string &interactionXmlFilePath, bool offScreen);
+
     // unregisters all render windows and its renderers.
     virtual ~InteractionTestHelper();
 
@@ -76,6 +82,25 @@ namespace mitk
      */
     void PlaybackInteraction();
 
+    /** @brief Measurements of one event replayed by ReplayInteraction(), all times in milliseconds. */
+    struct ReplayedEvent
+    {
+      std::string EventClass;
+      double RecordedTimestamp; ///< time since the start of the recording, -1 if the recording has no timestamps
+      double Lag;               ///< how much later than recorded the event was dispatched (real time replay only)
+      double ProcessingTime;    ///< time the dispatcher needed to handle the event
+      double RenderingTime;     ///< time to execute the rendering requests caused by the event
+    };
+
+    /**
+     * @brief Plays back the loaded interaction like PlaybackInteraction() and measures every event.
+     *
+     * After each event the pending rendering requests are executed, so processing plus rendering time is the
+     * latency until the result would be visible. Events are dispatched as fast as possible, which makes the
+     * replay deterministic, or at their recorded timestamps if \a realTime is true.
+     */
+    std::vector<ReplayedEvent> ReplayInteraction(bool realTime = false);
+
     /**
      * @brief SetTimeStep Sets timesteps of all SliceNavigationControllers to given timestep.
      * @param newTimeStep new timestep
@@ -123,7 +148,10 @@ namespace mitk
        * @brief Initialize Internal method to initialize the renderwindow and set the datastorage.
        * @throws mitk::Exception if interaction xml file can not be loaded.
        */
-    void Initialize(const std::string &interactionXmlFilePath);
+    void Initialize(const std::string &interactionXmlFilePath, bool offScreen = false);
+
+    /** @brief Initializes the views to the data storage and renders all windows once before a playback. */
+    void PrepareRenderWindowsForPlayback();
 
     /**
      * @brief LoadInteraction loads events from xml file.
@@ -132,6 +160,7 @@ namespace mitk
     void LoadInteraction();
 
     mitk::XML2EventParser::EventContainerType m_Events; // List with loaded interaction events
+    std::vector<double> m_Timestamps;                    // Recorded time of the loaded interaction events
 
     std::string m_InteractionFilePath;
 
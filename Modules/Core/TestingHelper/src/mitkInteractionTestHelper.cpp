@@ -26,13 +26,22 @@ found in the LICENSE file.
 
 #include <tinyxml.h>
 
+#include <chrono>
+#include <thread>
+
 mitk::InteractionTestHelper::InteractionTestHelper(const std::string &interactionXmlFilePath)
   : m_InteractionFilePath(interactionXmlFilePath)
 {
   this->Initialize(interactionXmlFilePath);
 }
 
-void mitk::InteractionTestHelper::Initialize(const std::string &interactionXmlFilePath)
+mitk::InteractionTestHelper::InteractionTestHelper(const std::string &interactionXmlFilePath, bool offScreen)
+  : m_InteractionFilePath(interactionXmlFilePath)
+{
+  this->Initialize(interactionXmlFilePath, offScreen);
+}
+
+void mitk::InteractionTestHelper::Initialize(const std::string &interactionXmlFilePath, bool offScreen)
 {
   // TiXmlDocument document(interactionXmlPath.c_str());
   TiXmlDocument document(interactionXmlFilePath);
@@ -93,6 +102,9 @@ void mitk::InteractionTestHelper::Initialize(const std::string &interactionXmlFi
       // create renderWindow, renderer and dispatcher
       auto rw = RenderWindow::New(nullptr, rendererName); // VtkRenderWindow is created within constructor if nullptr
 
+      if (offScreen)
+        rw->GetVtkRenderWindow()->SetOffScreenRendering(1);
+
       if (size[0] != 0 && size[1] != 0)
       {
         rw->SetSize(size[0], size[1]);
@@ -206,7 +218,7 @@ void mitk::InteractionTestHelper::AddNodeToStorage(mitk::DataNode::Pointer node)
   this->Set3dCameraSettings();
 }
 
-void mitk::InteractionTestHelper::PlaybackInteraction()
+void mitk::InteractionTestHelper::PrepareRenderWindowsForPlayback()
 {
   mitk::RenderingManager::GetInstance()->InitializeViewsByBoundingObjects(m_DataStorage);
   // load events if not loaded yet
@@ -230,19 +242,68 @@ void mitk::InteractionTestHelper::PlaybackInteraction()
     (*it)->GetVtkRenderWindow()->Render();
     (*it)->GetVtkRenderWindow()->WaitForCompletion();
   }
+}
+
+void mitk::InteractionTestHelper::PlaybackInteraction()
+{
+  this->PrepareRenderWindowsForPlayback();
 
   // mitk::RenderingManager::GetInstance()->ForceImmediateUpdateAll();
+
   // playback all events in queue
   for (unsigned long i = 0; i < m_Events.size(); ++i)
   {
     // let dispatcher of sending renderer process the event
     m_Events.at(i)->GetSender()->GetDispatcher()->ProcessEvent(m_Events.at(i));
   }
-  if (false)
+}
+
+std::vector<mitk::InteractionTestHelper::ReplayedEvent> mitk::InteractionTestHelper::ReplayInteraction(bool realTime)
+{
+  typedef std::chrono::steady_clock Clock;
+  auto milliseconds = [](const Clock::time_point &start, const Clock::time_point &end) {
+    return std::chrono::duration<double, std::milli>(end - start).count();
+  };
+
+  this->PrepareRenderWindowsForPlayback();
+
+  auto renderingManager = mitk::RenderingManager::GetInstance();
+  renderingManager->ExecutePendingRequests();
+
+  std::vector<ReplayedEvent> replayedEvents;
+  replayedEvents.reserve(m_Events.size());
+
+  const Clock::time_point start = Clock::now();
+  for (std::size_t i = 0; i < m_Events.size(); ++i)
   {
-    it--;
-    (*it)->GetVtkRenderWindow()->GetInteractor()->Start();
+    ReplayedEvent replayedEvent;
+    replayedEvent.EventClass = m_Events[i]->GetNameOfClass();
+    replayedEvent.RecordedTimestamp = i < m_Timestamps.size() ? m_Timestamps[i] : -1.0;
+    replayedEvent.Lag = 0.0;
+
+    if (realTime && replayedEvent.RecordedTimestamp >= 0.0)
+    {
+      const auto dueTime = start + std::chrono::duration_cast<Clock::duration>(
+                                     std::chrono::duration<double, std::milli>(replayedEvent.RecordedTimestamp));
+      std::this_thread::sleep_until(dueTime);
+      replayedEvent.Lag = std::max(0.0, milliseconds(dueTime, Clock::now()));
+    }
+
+    const Clock::time_point dispatched = Clock::now();
+    m_Events[i]->GetSender()->GetDispatcher()->ProcessEvent(m_Events[i]);
+    const Clock::time_point processed = Clock::now();
+
+    renderingManager->ExecutePendingRequests();
+    for (const auto &renderWindow : m_RenderWindowList)
+      renderWindow->GetVtkRenderWindow()->WaitForCompletion();
+    const Clock::time_point rendered = Clock::now();
+
+    replayedEvent.ProcessingTime = milliseconds(dispatched, processed);
+    replayedEvent.RenderingTime = milliseconds(processed, rendered);
+    replayedEvents.push_back(replayedEvent);
   }
+
+  return replayedEvents;
 }
 
 void mitk::InteractionTestHelper::LoadInteraction()
@@ -251,6 +312,7 @@ void mitk::InteractionTestHelper::LoadInteraction()
   std::ifstream xmlStream(m_InteractionFilePath.c_str());
   mitk::XML2EventParser parser(xmlStream);
   m_Events = parser.GetInteractions();
+  m_Timestamps = parser.GetTimestamps();
   xmlStream.close();
   // Avoid VTK warning: Trying to delete object with non-zero reference count.
   parser.SetReferenceCount(0);
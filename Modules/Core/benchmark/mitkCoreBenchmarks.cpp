@@ -0,0 +1,508 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkExtractSliceFilter.h>
+#include <mitkExtractSliceFilter2.h>
+#include <mitkImageAccessByItk.h>
+#include <mitkImageGenerator.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkInteractionConst.h>
+#include <mitkNodePredicateProperty.h>
+#include <mitkPlaneGeometry.h>
+#include <mitkProperties.h>
+#include <mitkPropertyList.h>
+#include <mitkRotationOperation.h>
+#include <mitkStandaloneDataStorage.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+/*
+  Micro benchmarks of hot data management paths of MitkCore: image initialization and accessors,
+  AccessByItk dispatch, slice extraction, property lookups, data storage queries and geometry
+  conversions.
+
+  Every benchmark consists of a setup, which is not measured, and an operation, which is repeated
+  until a batch takes at least --min-time seconds. The time per operation of --repetitions batches
+  is reported as table, CSV or JSON, so that the results of two releases can be compared by scripts.
+*/
+
+namespace
+{
+  typedef std::chrono::steady_clock Clock;
+  typedef std::function<void()> Operation;
+
+  struct Benchmark
+  {
+    std::string Name;
+    std::function<Operation()> Setup;
+  };
+
+  struct Result
+  {
+    std::string Name;
+    std::size_t Iterations;
+    std::vector<double> Nanoseconds; // per operation, one entry per repetition
+  };
+
+  // Keeps the compiler from discarding the results of the measured operations
+  volatile std::size_t g_Sink = 0;
+
+  template <typename T>
+  void Consume(const T &value)
+  {
+    g_Sink = g_Sink + static_cast<std::size_t>(value);
+  }
+
+  std::vector<Benchmark> &GetBenchmarks()
+  {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+  }
+
+  void Register(const std::string &name, const std::function<Operation()> &setup)
+  {
+    GetBenchmarks().push_back(Benchmark{name, setup});
+  }
+
+  mitk::Image::Pointer CreateImage(unsigned int x, unsigned int y, unsigned int z)
+  {
+    return mitk::ImageGenerator::GenerateRandomImage<short>(x, y, z, 1, 1.0, 1.0, 2.0);
+  }
+
+  mitk::PlaneGeometry::Pointer CreatePlane(const mitk::Image *image, bool oblique)
+  {
+    mitk::PlaneGeometry::Pointer plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(image->GetGeometry(), mitk::PlaneGeometry::Axial, image->GetDimension(2) / 2);
+
+    if (oblique)
+    {
+      mitk::Vector3D axis;
+      axis[0] = 1.0;
+      axis[1] = 1.0;
+      axis[2] = 0.0;
+      mitk::RotationOperation rotation(mitk::OpROTATE, image->GetGeometry()->GetCenter(), axis, 30.0);
+      plane->ExecuteOperation(&rotation);
+    }
+
+    return plane;
+  }
+
+  template <typename TPixel, unsigned int VImageDimension>
+  void SumFirstPixel(const itk::Image<TPixel, VImageDimension> *image, std::size_t &sum)
+  {
+    sum += static_cast<std::size_t>(*image->GetBufferPointer());
+  }
+
+  void RegisterImageBenchmarks()
+  {
+    Register("Image/Initialize/256x256x128", [] {
+      return [] {
+        mitk::Image::Pointer image = mitk::Image::New();
+        unsigned int dimensions[3] = {256, 256, 128};
+        image->Initialize(mitk::MakeScalarPixelType<short>(), 3, dimensions);
+        Consume(image->GetDimension(2));
+      };
+    });
+
+    Register("Image/InitializeAndAllocate/256x256x128", [] {
+      return [] {
+        mitk::Image::Pointer image = mitk::Image::New();
+        unsigned int dimensions[3] = {256, 256, 128};
+        image->Initialize(mitk::MakeScalarPixelType<short>(), 3, dimensions);
+        mitk::ImageWriteAccessor accessor(image);
+        Consume(accessor.GetData() != nullptr);
+      };
+    });
+
+    Register("Image/ReadAccessor", [] {
+      mitk::Image::Pointer image = CreateImage(64, 64, 64);
+      return [image] {
+        mitk::ImageReadAccessor accessor(image);
+        Consume(*static_cast<const short *>(accessor.GetData()));
+      };
+    });
+
+    Register("Image/WriteAccessor", [] {
+      mitk::Image::Pointer image = CreateImage(64, 64, 64);
+      return [image] {
+        mitk::ImageWriteAccessor accessor(image);
+        Consume(*static_cast<short *>(accessor.GetData()));
+      };
+    });
+
+    Register("Image/AccessByItk", [] {
+      mitk::Image::Pointer image = CreateImage(8, 8, 8);
+      return [image] {
+        std::size_t sum = 0;
+        AccessFixedDimensionByItk_n(image, SumFirstPixel, 3, (sum));
+        Consume(sum);
+      };
+    });
+  }
+
+  void RegisterSliceBenchmarks()
+  {
+    for (bool oblique : {false, true})
+    {
+      const std::string orientation = oblique ? "Oblique" : "Axial";
+
+      Register("ExtractSliceFilter/" + orientation + "/256x256x128", [oblique] {
+        mitk::Image::Pointer image = CreateImage(256, 256, 128);
+        mitk::PlaneGeometry::Pointer plane = CreatePlane(image, oblique);
+        mitk::ExtractSliceFilter::Pointer filter = mitk::ExtractSliceFilter::New();
+        filter->SetInput(image);
+        filter->SetWorldGeometry(plane);
+        return [image, plane, filter] {
+          filter->Modified();
+          filter->Update();
+          Consume(filter->GetOutput()->GetDimension(0));
+        };
+      });
+
+      Register("ExtractSliceFilter2/" + orientation + "/256x256x128", [oblique] {
+        mitk::Image::Pointer image = CreateImage(256, 256, 128);
+        mitk::ExtractSliceFilter2::Pointer filter = mitk::ExtractSliceFilter2::New();
+        filter->SetInput(image);
+        filter->SetOutputGeometry(CreatePlane(image, oblique));
+        return [image, filter] {
+          filter->Modified();
+          filter->Update();
+          Consume(filter->GetOutput()->GetDimension(0));
+        };
+      });
+    }
+  }
+
+  void RegisterPropertyBenchmarks()
+  {
+    auto createList = [] {
+      mitk::PropertyList::Pointer list = mitk::PropertyList::New();
+      for (int i = 0; i < 100; ++i)
+        list->SetProperty("benchmark.property." + std::to_string(i), mitk::IntProperty::New(i));
+      return list;
+    };
+
+    Register("PropertyList/GetProperty/Existing", [createList] {
+      mitk::PropertyList::Pointer list = createList();
+      const std::string key = "benchmark.property.50";
+      return [list, key] { Consume(list->GetProperty(key) != nullptr); };
+    });
+
+    Register("PropertyList/GetProperty/Missing", [createList] {
+      mitk::PropertyList::Pointer list = createList();
+      const std::string key = "benchmark.property.missing";
+      return [list, key] { Consume(list->GetProperty(key) != nullptr); };
+    });
+
+    Register("PropertyList/GetIntProperty", [createList] {
+      mitk::PropertyList::Pointer list = createList();
+      const std::string key = "benchmark.property.50";
+      return [list, key] {
+        int value = 0;
+        list->GetIntProperty(key.c_str(), value);
+        Consume(value);
+      };
+    });
+  }
+
+  void RegisterDataStorageBenchmarks()
+  {
+    for (int numberOfNodes : {100, 1000, 10000})
+    {
+      Register("DataStorage/GetSubset/" + std::to_string(numberOfNodes), [numberOfNodes] {
+        mitk::StandaloneDataStorage::Pointer storage = mitk::StandaloneDataStorage::New();
+        for (int i = 0; i < numberOfNodes; ++i)
+        {
+          mitk::DataNode::Pointer node = mitk::DataNode::New();
+          node->SetName("node " + std::to_string(i));
+          node->SetBoolProperty("benchmark.selected", i % 2 == 0);
+          storage->Add(node);
+        }
+
+        mitk::NodePredicateProperty::Pointer predicate =
+          mitk::NodePredicateProperty::New("benchmark.selected", mitk::BoolProperty::New(true));
+        return [storage, predicate] { Consume(storage->GetSubset(predicate)->Size()); };
+      });
+    }
+  }
+
+  void RegisterGeometryBenchmarks()
+  {
+    Register("Geometry/WorldToIndex/1000Points", [] {
+      mitk::Image::Pointer image = CreateImage(8, 8, 8);
+      mitk::BaseGeometry::Pointer geometry = image->GetGeometry();
+      mitk::Vector3D axis;
+      axis.Fill(1.0);
+      mitk::RotationOperation rotation(mitk::OpROTATE, geometry->GetCenter(), axis, 20.0);
+      geometry->ExecuteOperation(&rotation);
+
+      std::vector<mitk::Point3D> points(1000);
+      for (std::size_t i = 0; i < points.size(); ++i)
+      {
+        points[i][0] = 0.1 * i;
+        points[i][1] = 0.2 * i;
+        points[i][2] = 0.3 * i;
+      }
+
+      return [geometry, points] {
+        mitk::Point3D index;
+        double sum = 0.0;
+        for (const auto &point : points)
+        {
+          geometry->WorldToIndex(point, index);
+          sum += index[0];
+        }
+        Consume(sum);
+      };
+    });
+
+    Register("Geometry/IsInside/1000Points", [] {
+      mitk::Image::Pointer image = CreateImage(64, 64, 64);
+      mitk::BaseGeometry::Pointer geometry = image->GetGeometry();
+
+      std::vector<mitk::Point3D> points(1000);
+      for (std::size_t i = 0; i < points.size(); ++i)
+      {
+        points[i][0] = 0.1 * i;
+        points[i][1] = 0.2 * i;
+        points[i][2] = 0.3 * i;
+      }
+
+      return [geometry, points] {
+        std::size_t inside = 0;
+        for (const auto &point : points)
+          inside += geometry->IsInside(point) ? 1 : 0;
+        Consume(inside);
+      };
+    });
+  }
+
+  double RunBatch(const Operation &operation, std::size_t iterations)
+  {
+    const Clock::time_point start = Clock::now();
+    for (std::size_t i = 0; i < iterations; ++i)
+      operation();
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+  }
+
+  Result Run(const Benchmark &benchmark, double minimumTime, unsigned int repetitions)
+  {
+    Operation operation = benchmark.Setup();
+    operation(); // warm up caches and lazy initialization
+
+    // double the batch size until a batch takes long enough to be measured reliably
+    const double minimumNanoseconds = minimumTime * 1e9;
+    std::size_t iterations = 1;
+    double nanoseconds = RunBatch(operation, iterations);
+    while (nanoseconds < minimumNanoseconds && iterations < (std::size_t(1) << 30))
+    {
+      iterations *= 2;
+      nanoseconds = RunBatch(operation, iterations);
+    }
+
+    Result result{benchmark.Name, iterations, {nanoseconds / iterations}};
+    for (unsigned int repetition = 1; repetition < repetitions; ++repetition)
+      result.Nanoseconds.push_back(RunBatch(operation, iterations) / iterations);
+
+    std::sort(result.Nanoseconds.begin(), result.Nanoseconds.end());
+    return result;
+  }
+
+  double Median(const std::vector<double> &sortedValues)
+  {
+    return sortedValues[sortedValues.size() / 2];
+  }
+
+  double Mean(const std::vector<double> &values)
+  {
+    return std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+  }
+
+  void WriteTextHeader(std::ostream &stream)
+  {
+    stream << std::left << std::setw(48) << "[ns per operation]" << std::right << std::setw(12) << "iterations"
+           << std::setw(14) << "min" << std::setw(14) << "median" << std::setw(14) << "mean" << std::setw(14) << "max"
+           << "\n";
+  }
+
+  void WriteTextRow(std::ostream &stream, const Result &result)
+  {
+    stream << std::left << std::setw(48) << result.Name << std::right << std::setw(12) << result.Iterations
+           << std::fixed << std::setprecision(1) << std::setw(14) << result.Nanoseconds.front() << std::setw(14)
+           << Median(result.Nanoseconds) << std::setw(14) << Mean(result.Nanoseconds) << std::setw(14)
+           << result.Nanoseconds.back() << "\n";
+  }
+
+  void WriteCSV(std::ostream &stream, const std::vector<Result> &results)
+  {
+    stream << "name,iterations,min_ns,median_ns,mean_ns,max_ns\n";
+    for (const auto &result : results)
+    {
+      stream << result.Name << "," << result.Iterations << "," << result.Nanoseconds.front() << ","
+             << Median(result.Nanoseconds) << "," << Mean(result.Nanoseconds) << "," << result.Nanoseconds.back()
+             << "\n";
+    }
+  }
+
+  void WriteJSON(std::ostream &stream, const std::vector<Result> &results)
+  {
+    stream << "{\n  \"benchmarks\": [";
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+      const auto &result = results[i];
+      stream << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << result.Name << "\", \"iterations\": " << result.Iterations
+             << ", \"repetitions\": " << result.Nanoseconds.size() << ", \"min_ns\": " << result.Nanoseconds.front()
+             << ", \"median_ns\": " << Median(result.Nanoseconds) << ", \"mean_ns\": " << Mean(result.Nanoseconds)
+             << ", \"max_ns\": " << result.Nanoseconds.back() << "}";
+    }
+    stream << "\n  ]\n}\n";
+  }
+
+  void PrintUsage(const char *executable)
+  {
+    std::cerr << "Usage: " << executable << " [options]\n"
+              << "  --filter <text>      run only benchmarks whose name contains the text\n"
+              << "  --min-time <s>       minimum duration of a measured batch (default 0.5)\n"
+              << "  --repetitions <n>    number of measured batches (default 3)\n"
+              << "  --format <name>      text, csv or json (default text)\n"
+              << "  --out <file>         write the results to the file instead of the console\n"
+              << "  --list               print the names of the benchmarks\n";
+  }
+}
+
+int main(int argc, char **argv)
+{
+  std::string filter;
+  double minimumTime = 0.5;
+  unsigned int repetitions = 3;
+  std::string format = "text";
+  std::string outputFile;
+  bool list = false;
+
+  try
+  {
+    for (int arg = 1; arg < argc; ++arg)
+    {
+      const std::string option = argv[arg];
+      if (option == "--list")
+      {
+        list = true;
+        continue;
+      }
+
+      if (arg + 1 >= argc)
+      {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+      }
+
+      const std::string value = argv[++arg];
+      if (option == "--filter") filter = value;
+      else if (option == "--min-time") minimumTime = std::max(0.0, std::stod(value));
+      else if (option == "--repetitions") repetitions = std::max(1ul, std::stoul(value));
+      else if (option == "--format") format = value;
+      else if (option == "--out") outputFile = value;
+      else
+      {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  catch (const std::exception &e)
+  {
+    std::cerr << "Invalid option: " << e.what() << "\n";
+    PrintUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  if (format != "text" && format != "csv" && format != "json")
+  {
+    PrintUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  RegisterImageBenchmarks();
+  RegisterSliceBenchmarks();
+  RegisterPropertyBenchmarks();
+  RegisterDataStorageBenchmarks();
+  RegisterGeometryBenchmarks();
+
+  // results on the console are printed as soon as they are available
+  const bool printProgress = !list && format == "text" && outputFile.empty();
+  if (printProgress)
+    WriteTextHeader(std::cout);
+
+  std::vector<Result> results;
+  for (const auto &benchmark : GetBenchmarks())
+  {
+    if (benchmark.Name.find(filter) == std::string::npos)
+      continue;
+
+    if (list)
+    {
+      std::cout << benchmark.Name << "\n";
+      continue;
+    }
+
+    try
+    {
+      results.push_back(Run(benchmark, minimumTime, repetitions));
+    }
+    catch (const std::exception &e)
+    {
+      std::cerr << benchmark.Name << " failed: " << e.what() << "\n";
+      return EXIT_FAILURE;
+    }
+
+    if (printProgress)
+      WriteTextRow(std::cout, results.back());
+  }
+
+  if (list || printProgress)
+    return EXIT_SUCCESS;
+
+  std::ofstream file;
+  if (!outputFile.empty())
+  {
+    file.open(outputFile);
+    if (!file)
+    {
+      std::cerr << "Cannot write " << outputFile << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+  std::ostream &stream = outputFile.empty() ? std::cout : file;
+
+  if (format == "text")
+  {
+    WriteTextHeader(stream);
+    for (const auto &result : results)
+      WriteTextRow(stream, result);
+  }
+  else if (format == "csv")
+    WriteCSV(stream, results);
+  else
+    WriteJSON(stream, results);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,106 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkAsyncSaveOperation_h
+#define mitkAsyncSaveOperation_h
+
+#include <MitkCoreExports.h>
+#include <mitkBaseData.h>
+#include <mitkFileWriterSelector.h>
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
+namespace mitk
+{
+  /**
+   * @ingroup IO
+   *
+   * @brief A save operation running on a background thread, started by IOUtil::SaveAsync().
+   *
+   * The operation writes a snapshot of the data, so the data may be modified or deleted while it is written.
+   * Since the writers do not report intermediate progress, the progress of an operation is its state.
+   *
+   * A running operation keeps itself alive until it is done, so the caller does not need to keep the returned
+   * pointer. The callback is called on the background thread after the operation is done. Callers which
+   * need to react on the GUI thread have to forward the notification, e.g. with QMetaObject::invokeMethod().
+   */
+  class MITKCORE_EXPORT AsyncSaveOperation : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(AsyncSaveOperation, itk::Object);
+
+    enum class State
+    {
+      Pending,
+      Writing,
+      Finished,
+      Failed,
+      Cancelled
+    };
+
+    typedef std::function<void(const AsyncSaveOperation *)> CallbackType;
+
+    State GetState() const;
+
+    /** Returns whether the operation is finished, failed or was cancelled.*/
+    bool IsDone() const;
+
+    /** Returns the error message of a failed operation.*/
+    std::string GetErrorMessage() const;
+
+    std::string GetPath() const;
+
+    /**
+     * @brief Cancels the operation.
+     *
+     * A write that already started cannot be interrupted. Its file is removed after it is written, so a cancelled
+     * operation never leaves a file behind.
+     */
+    void Cancel();
+
+    /** Blocks until the operation is done.*/
+    void Wait() const;
+
+  protected:
+    AsyncSaveOperation(const BaseData *snapshot,
+                       const FileWriterSelector &writerSelector,
+                       const std::string &path,
+                       const CallbackType &callback);
+    ~AsyncSaveOperation() override;
+
+  private:
+    friend class IOUtil;
+
+    static Pointer Start(const BaseData *snapshot,
+                         const FileWriterSelector &writerSelector,
+                         const std::string &path,
+                         const CallbackType &callback);
+
+    void Write();
+
+    BaseData::ConstPointer m_Snapshot;
+    FileWriterSelector m_WriterSelector;
+    std::string m_Path;
+    CallbackType m_Callback;
+
+    State m_State;
+    bool m_CancelRequested;
+    std::string m_ErrorMessage;
+
+    mutable std::mutex m_Mutex;
+    mutable std::condition_variable m_Done;
+  };
+}
+
+#endif
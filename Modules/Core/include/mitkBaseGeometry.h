@@ -28,6 +28,10 @@ found in the LICENSE file.
 #include <mitkGeometryTransformHolder.h>
 #include <vtkTransform.h>
 
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+
 class vtkMatrix4x4;
 class vtkMatrixToLinearTransform;
 class vtkLinearTransform;
@@ -314,6 +318,23 @@ namespace mitk
       IndexToWorld(pt_units, pt_mm);
     }
 
+    //##Documentation
+    //## @brief Convert world coordinates (in mm) of \a numberOfPoints \em points to (continuous!) index coordinates.
+    //## Input and output may be the same array. Cheaper than calling WorldToIndex() per point, especially
+    //## for axis-aligned geometries (see IsIndexToWorldTransformAxisAligned()).
+    void WorldToIndex(const mitk::Point3D *pts_mm, mitk::Point3D *pts_units, std::size_t numberOfPoints) const;
+
+    //##Documentation
+    //## @brief Convert (continuous or discrete) index coordinates of \a numberOfPoints \em points to world
+    //## coordinates (in mm). Input and output may be the same array.
+    void IndexToWorld(const mitk::Point3D *pts_units, mitk::Point3D *pts_mm, std::size_t numberOfPoints) const;
+
+    //##Documentation
+    //## @brief True if the index axes are parallel to the world axes, i.e. the IndexToWorldTransform
+    //## only consists of (possibly negative) spacing and origin. WorldToIndex() and IndexToWorld()
+    //## then need a single multiplication and addition per coordinate.
+    bool IsIndexToWorldTransformAxisAligned() const;
+
     //##Documentation
     //## @brief Convert (continuous or discrete) index coordinates of a \em vector
     //## \a vec_units to world coordinates (in mm)
@@ -612,6 +633,26 @@ namespace mitk
 
     mutable unsigned long m_IndexToWorldTransformLastModified;
 
+    //##Documentation
+    //## @brief IndexToWorldTransform and its inverse as plain arrays, see GetTransformCache()
+    struct TransformCache
+    {
+      bool IsAxisAligned;
+      bool IsInvertible;
+      ScalarType IndexToWorldMatrix[3][3];
+      ScalarType WorldToIndexMatrix[3][3];
+      ScalarType Offset[3];
+    };
+
+    //##Documentation
+    //## @brief Returns the cached transform, updated if the IndexToWorldTransform was modified.
+    //## Thread-safe as long as the transform is not modified concurrently.
+    const TransformCache &GetTransformCache() const;
+
+    mutable TransformCache m_TransformCache;
+    mutable std::atomic<unsigned long> m_TransformCacheMTime;
+    mutable std::mutex m_TransformCacheMutex;
+
     bool m_ImageGeometry;
 
     //##Documentation
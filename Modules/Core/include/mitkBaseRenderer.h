@@ -17,6 +17,7 @@ found in the LICENSE file.
 #include "mitkDataStorage.h"
 #include "mitkPlaneGeometry.h"
 #include "mitkPlaneGeometryData.h"
+#include "mitkRenderingProfiler.h"
 #include "mitkSliceNavigationController.h"
 #include "mitkTimeGeometry.h"
 
@@ -351,6 +352,10 @@ namespace mitk
     * rendering enabled */
     unsigned int GetNumberOfVisibleLODEnabledMappers() const;
 
+    /** Returns the profiler recording the times of mapper updates, mapper rendering
+    * and annotations of this renderer. It is disabled by default. */
+    RenderingProfiler *GetRenderingProfiler() const;
+
     //##Documentation
     //## @brief This method converts a display point to the 3D world index
     //## using the geometry of the renderWindow.
@@ -515,6 +520,8 @@ namespace mitk
     * rendering enabled */
     unsigned int m_NumberOfVisibleLODEnabledMappers;
 
+    RenderingProfiler::Pointer m_RenderingProfiler;
+
     // Local Storage Handling for mappers
 
   protected:
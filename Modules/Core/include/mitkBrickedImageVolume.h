@@ -0,0 +1,118 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITKBRICKEDIMAGEVOLUME_H
+#define MITKBRICKEDIMAGEVOLUME_H
+
+#include <MitkCoreExports.h>
+#include <mitkCommon.h>
+
+#include <itkObject.h>
+
+#include <vector>
+
+namespace mitk
+{
+  class Image;
+
+  /**
+    \brief Copy of an image volume in a tiled ("bricked") memory layout.
+
+    The volume is divided into cubic bricks with an edge length that is a power of two
+    (32 voxels by default). The voxels of a brick are stored contiguously in x-fastest order,
+    bricks are stored one after another, again in x-fastest order. Compared to the scanline
+    layout of mitk::Image, every axis-aligned section of a brick lies within a small, contiguous
+    block of memory, so extracting sagittal and coronal slices touches roughly as many memory
+    pages as extracting axial ones.
+
+    Bricks at the upper borders of the volume are padded to the full edge length.
+
+    \sa Image::SetBrickedLayoutEnabled
+    \ingroup Data
+    */
+  class MITKCORE_EXPORT BrickedImageVolume : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(BrickedImageVolume, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    static const unsigned int DefaultBrickEdgeLength = 32;
+
+    /**
+      \brief Copies the scanline ordered 3D volume @a data into the bricked layout.
+
+      @a brickEdgeLength is rounded up to the next power of two.
+      */
+    void Initialize(const void *data,
+                    const unsigned int dimensions[3],
+                    size_t pixelSize,
+                    unsigned int brickEdgeLength = DefaultBrickEdgeLength);
+
+    /**
+      \brief Copies volume @a t of channel @a n of @a image into the bricked layout.
+      \throws mitk::Exception if the image has no such volume
+      */
+    void Initialize(const Image *image, int t = 0, int n = 0, unsigned int brickEdgeLength = DefaultBrickEdgeLength);
+
+    const unsigned int *GetDimensions() const { return m_Dimensions; }
+    size_t GetPixelSize() const { return m_PixelSize; }
+    unsigned int GetBrickEdgeLength() const { return 1u << m_BrickShift; }
+
+    /** \brief Modification time of the image at the time this copy was created (0 if created from raw data). */
+    itk::ModifiedTimeType GetSourceMTime() const { return m_SourceMTime; }
+
+    /** \brief Returns the address of the voxel with the given index. The index has to be inside the volume. */
+    const void *GetPixel(unsigned int x, unsigned int y, unsigned int z) const
+    {
+      return &m_Data[this->GetPixelOffset(x, y, z) * m_PixelSize];
+    }
+
+    /**
+      \brief Extracts an axis-aligned 2D section of @a width x @a height pixels.
+
+      Pixel (i, j) of @a buffer (stored row by row) is taken from the voxel at
+      index @a origin + i * @a stepI + j * @a stepJ. Voxels outside of the volume are
+      set to @a background, which has to point to GetPixelSize() bytes. The section is
+      processed tile by tile so that every tile is read from at most four bricks.
+      */
+    void ExtractSlice(const int origin[3],
+                      const int stepI[3],
+                      const int stepJ[3],
+                      unsigned int width,
+                      unsigned int height,
+                      const void *background,
+                      void *buffer) const;
+
+  protected:
+    BrickedImageVolume();
+    ~BrickedImageVolume() override;
+
+  private:
+    size_t GetPixelOffset(unsigned int x, unsigned int y, unsigned int z) const
+    {
+      const unsigned int mask = (1u << m_BrickShift) - 1;
+      const size_t brick =
+        (x >> m_BrickShift) + m_NumberOfBricks[0] * ((y >> m_BrickShift) + m_NumberOfBricks[1] * (z >> m_BrickShift));
+      return (brick << (3 * m_BrickShift)) +
+             ((x & mask) | ((y & mask) << m_BrickShift) | ((z & mask) << (2 * m_BrickShift)));
+    }
+
+    std::vector<unsigned char> m_Data;
+    unsigned int m_Dimensions[3];
+    size_t m_NumberOfBricks[2];
+    size_t m_PixelSize;
+    unsigned int m_BrickShift;
+    itk::ModifiedTimeType m_SourceMTime;
+  };
+}
+
+#endif // MITKBRICKEDIMAGEVOLUME_H
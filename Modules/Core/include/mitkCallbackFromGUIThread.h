@@ -159,6 +159,9 @@ namespace mitk
     /// To be called by a toolkit specific CallbackFromGUIThreadImplementation.
     static void RegisterImplementation(CallbackFromGUIThreadImplementation *implementation);
 
+    /// True if a toolkit specific implementation was registered, i.e. if there is a GUI thread.
+    static bool IsImplementationRegistered();
+
     /// Change the current application cursor
     void CallThisFromGUIThread(itk::Command *, itk::EventObject *e = nullptr);
 
@@ -15,6 +15,7 @@ found in the LICENSE file.
 
 #include <mitkImage.h>
 #include <string>
+#include <vector>
 
 namespace mitk
 {
@@ -24,6 +25,11 @@ namespace mitk
   * \throws mitk::AccessByItkException for pixel types which are not part of MITK_ACCESSBYITK_COMPOSITE_PIXEL_TYPES_SEQ
   */
   std::string MITKCORE_EXPORT ConvertCompositePixelValueToString(Image::Pointer image, itk::Index<3> index);
+
+  /** \brief Converts the component values of a composite pixel (e.g. as looked up by mitk::ImagePixelValueLookup)
+  * to the same displayable string as above, without accessing the image again.
+  */
+  std::string MITKCORE_EXPORT ConvertCompositePixelValueToString(const std::vector<ScalarType> &components);
 }
 
 #endif
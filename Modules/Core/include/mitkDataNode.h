@@ -231,6 +231,17 @@ namespace mitk
      */
     mitk::BaseProperty *GetProperty(const char *propertyKey, const mitk::BaseRenderer *renderer = nullptr, bool fallBackOnDataProperties = true) const;
 
+    /**
+     * \brief Get the property by its interned key, with the same lookup order as the overload above.
+     *
+     * Intended for frequent lookups, e.g. while rendering, since it neither creates strings nor compares them
+     * (except for the name of the renderer).
+     * \sa PropertyKey
+     */
+    mitk::BaseProperty *GetProperty(const PropertyKey &propertyKey,
+                                    const mitk::BaseRenderer *renderer = nullptr,
+                                    bool fallBackOnDataProperties = true) const;
+
     /**
      * \brief Get the property of type T with key \a propertyKey from the PropertyList
      * of the \a renderer, if available there, otherwise use the BaseRenderer-independent PropertyList.
@@ -295,6 +306,9 @@ namespace mitk
      * \return \a true property was found
      */
     bool GetBoolProperty(const char *propertyKey, bool &boolValue, const mitk::BaseRenderer *renderer = nullptr) const;
+    bool GetBoolProperty(const PropertyKey &propertyKey,
+                         bool &boolValue,
+                         const mitk::BaseRenderer *renderer = nullptr) const;
 
     /**
      * \brief Convenience access method for int properties (instances of
@@ -302,6 +316,9 @@ namespace mitk
      * \return \a true property was found
      */
     bool GetIntProperty(const char *propertyKey, int &intValue, const mitk::BaseRenderer *renderer = nullptr) const;
+    bool GetIntProperty(const PropertyKey &propertyKey,
+                        int &intValue,
+                        const mitk::BaseRenderer *renderer = nullptr) const;
 
     /**
      * \brief Convenience access method for float properties (instances of
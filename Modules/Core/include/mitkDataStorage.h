@@ -21,6 +21,7 @@ found in the LICENSE file.
 #include "mitkMessage.h"
 #include <MitkCoreExports.h>
 #include <map>
+#include <vector>
 
 namespace mitk
 {
@@ -98,7 +99,8 @@ namespace mitk
     //## (see definition of NodePredicateBase for details).
     //## The method returns a set of SmartPointers to the DataNodes that fulfill the
     //## conditions. A set of all objects can be retrieved with the GetAll() method;
-    SetOfObjects::ConstPointer GetSubset(const NodePredicateBase *condition) const;
+    //## Subclasses may override this method to answer frequent conditions from an index.
+    virtual SetOfObjects::ConstPointer GetSubset(const NodePredicateBase *condition) const;
 
     //##Documentation
     //## @brief returns a set of source objects for a given node that meet the given condition(s).
@@ -265,6 +267,30 @@ namespace mitk
 
     DataStorageEvent InteractorChangedNodeEvent;
 
+    typedef Message1<const SetOfObjects*> DataStorageBatchEvent;
+    //##Documentation
+    //## @brief AddNodesEvent is emitted once at the end of a batch (see BeginBatch()) with all nodes that have been
+    //## added to the DataStorage during the batch.
+    //##
+    //## After this event, AddNodeEvent is still emitted for each of the nodes, so observers that only know
+    //## AddNodeEvent keep working. Observers that register to both events can handle all nodes at once here and
+    //## ignore the following AddNodeEvents of nodes they already know.
+    DataStorageBatchEvent AddNodesEvent;
+
+    //##Documentation
+    //## @brief Starts a batch of modifications, e.g. adding all nodes of a scene.
+    //##
+    //## Until the matching call of EndBatch(), AddNodeEvent is not emitted for added nodes. Instead, EndBatch()
+    //## emits AddNodesEvent once for all of them, followed by their AddNodeEvents. If a node is added and removed
+    //## during the same batch, neither event is emitted for it. RemoveNodeEvent is always emitted immediately,
+    //## because it must be emitted before the node is removed. Batches can be nested; the events are emitted at
+    //## the end of the outermost batch.
+    void BeginBatch();
+
+    //##Documentation
+    //## @brief Ends a batch started by BeginBatch() and emits the deferred events.
+    void EndBatch();
+
     //##Documentation
     //## @brief Compute the axis-parallel bounding geometry of the input objects
     //##
@@ -416,6 +442,12 @@ namespace mitk
     //## to suppress NodeChangedEvent to be emitted.
     bool m_BlockNodeModifiedEvents;
 
+    //##Documentation
+    //## @brief Nesting depth of BeginBatch() calls and the nodes whose AddNodeEvent is deferred until EndBatch().
+    unsigned int m_BatchDepth;
+    std::vector<DataNode::ConstPointer> m_BatchAddedNodes;
+    itk::SimpleFastMutexLock m_BatchMutex;
+
     //##Documentation
     //## @brief Standard Constructor for ::New() instantiation
     DataStorage();
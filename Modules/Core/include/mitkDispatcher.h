@@ -21,7 +21,10 @@ found in the LICENSE file.
 #include "usServiceTracker.h"
 #include <MitkCoreExports.h>
 #include <list>
+#include <map>
 #include <mitkWeakPointer.h>
+#include <string>
+#include <vector>
 
 namespace mitk
 {
@@ -38,6 +41,9 @@ namespace mitk
   * DataNode.
   * Higher layers are preferred.
   *
+  * Mouse move events posted with PostEvent() are coalesced: only the latest one is processed if several
+  * arrive before ProcessPendingEvent() is called, e.g. because rendering lags behind the mouse.
+  *
   * \ingroup Interaction
   */
 
@@ -50,6 +56,17 @@ namespace mitk
     typedef std::list<mitk::WeakPointer<DataInteractor>> ListInteractorType;
     typedef std::list<itk::SmartPointer<InteractionEvent>> ListEventsType;
 
+    /**
+     * Time spent in the event handling of one DataInteractor or InteractionEventObserver class.
+     */
+    struct EventHandlingStatistics
+    {
+      std::string Name;
+      unsigned long NumberOfEvents = 0;
+      double TotalMilliseconds = 0.0;
+      double MaximumMilliseconds = 0.0;
+    };
+
     /**
      * To post new Events which are to be handled by the Dispatcher.
      *
@@ -57,6 +74,50 @@ namespace mitk
      */
     bool ProcessEvent(InteractionEvent *event);
 
+    /**
+     * Like ProcessEvent(), except for MouseMoveEvents if move event coalescing is enabled: these become the
+     * pending event, replacing a pending event that has not been processed yet. The pending event is processed by
+     * ProcessPendingEvent() or before any other event is processed, so the order of events is kept.
+     *
+     * @return Returns true if the event has been handled by an DataInteractor, and false if it has not been handled
+     * or has become the pending event.
+     */
+    bool PostEvent(InteractionEvent *event);
+
+    /**
+     * Processes the pending mouse move event, if there is one.
+     *
+     * @return Returns true if the event has been handled by an DataInteractor, and false else.
+     */
+    bool ProcessPendingEvent();
+
+    bool HasPendingEvent() const;
+
+    /**
+     * Enables coalescing of the mouse move events passed to PostEvent(). Enabled by default.
+     */
+    void SetMoveEventCoalescingEnabled(bool enabled);
+    bool IsMoveEventCoalescingEnabled() const;
+
+    /**
+     * Number of mouse move events which were replaced by a later one without being processed.
+     */
+    unsigned long GetNumberOfCoalescedEvents() const;
+
+    /**
+     * Enables measuring the time each DataInteractor and InteractionEventObserver spends handling events.
+     * Disabled by default.
+     */
+    void SetEventHandlingStatisticsEnabled(bool enabled);
+    bool IsEventHandlingStatisticsEnabled() const;
+
+    /**
+     * The measured times per DataInteractor and InteractionEventObserver class, sorted by total time (descending).
+     */
+    std::vector<EventHandlingStatistics> GetEventHandlingStatistics() const;
+
+    void ResetEventHandlingStatistics();
+
     /**
      * Adds an Event to the Dispatchers EventQueue, these events will be processed after a a regular posted event has
      * been
@@ -95,6 +156,20 @@ namespace mitk
     ListInteractorType m_Interactors;
     ListEventsType m_QueuedEvents;
 
+    itk::SmartPointer<InteractionEvent> m_PendingEvent;
+    bool m_MoveEventCoalescingEnabled;
+    unsigned long m_NumberOfCoalescedEvents;
+
+    bool m_EventHandlingStatisticsEnabled;
+    std::map<std::string, EventHandlingStatistics> m_EventHandlingStatistics;
+
+    /**
+     * Calls DataInteractor::HandleEvent(), measuring its time if enabled.
+     */
+    bool HandleEvent(DataInteractor *dataInteractor, InteractionEvent *event);
+
+    void AddEventHandlingTime(const std::string &name, double milliseconds);
+
     /**
      * Removes all Interactors without a DataNode pointing to them, this is necessary especially when a DataNode is
      * assigned to a new Interactor
@@ -13,6 +13,7 @@ found in the LICENSE file.
 #ifndef MITKDISPLAYACTIONEVENTBROADCAST_H
 #define MITKDISPLAYACTIONEVENTBROADCAST_H
 
+#include "mitkImagePixelValueLookup.h"
 #include "mitkInteractionEventObserver.h"
 #include <MitkCoreExports.h>
 
@@ -88,6 +89,8 @@ namespace mitk
 
     void Init(StateMachineAction* stateMachineAction, InteractionEvent* interactionEvent);
 
+    void EndInteraction(StateMachineAction* stateMachineAction, InteractionEvent* interactionEvent);
+
     void Move(StateMachineAction* stateMachineAction , InteractionEvent* interactionEvent);
 
     void SetCrosshair(StateMachineAction* stateMachineAction, InteractionEvent* interactionEvent);
@@ -202,6 +205,10 @@ namespace mitk
     * @brief Determines if the angle between crosshair remains fixed when rotating.
     */
     bool m_LinkPlanes;
+    /**
+    * @brief True between Init() and EndInteraction(), see RenderingManager::StartInteraction().
+    */
+    bool m_InteractionInProgress;
 
     typedef std::vector<SliceNavigationController*> SNCVector;
     SNCVector m_RotatableSNCs;
@@ -218,6 +225,11 @@ namespace mitk
 
     Vector3D m_PreviousRotationAxis;
     ScalarType m_PreviousRotationAngle;
+
+    /**
+    * @brief Reuses the read accessors of the images under the cursor across the status bar updates.
+    */
+    ImagePixelValueLookup m_PixelValueLookup;
   };
 } // end namespace
 
@@ -13,6 +13,7 @@ found in the LICENSE file.
 #ifndef mitkDisplayInteractor_h
 #define mitkDisplayInteractor_h
 
+#include "mitkImagePixelValueLookup.h"
 #include "mitkInteractionEventObserver.h"
 #include <MitkCoreExports.h>
 
@@ -83,6 +84,10 @@ namespace mitk
      * \brief Initializes an interaction, saves the pointers start position for further reference.
      */
     virtual void Init(StateMachineAction *, InteractionEvent *);
+    /**
+     * \brief Finishes an interaction started by Init(), the render windows are updated in full quality.
+     */
+    virtual void EndInteraction(StateMachineAction *, InteractionEvent *);
     /**
      * \brief Performs panning of the data set in the render window.
      */
@@ -261,6 +266,11 @@ namespace mitk
      */
     bool m_LinkPlanes;
 
+    /**
+     * @brief True between Init() and EndInteraction(), see RenderingManager::StartInteraction()
+     */
+    bool m_InteractionInProgress;
+
     typedef std::vector<SliceNavigationController*> SNCVector;
     SNCVector m_RotatableSNCs; /// all SNCs that currently have CreatedWorldGeometries, that can be rotated.
     SNCVector m_SNCsToBeRotated; /// all SNCs that will be rotated (exceptions are the ones parallel to the one being clicked)
@@ -276,6 +286,11 @@ namespace mitk
 
     Vector3D m_PreviousRotationAxis;
     ScalarType m_PreviousRotationAngle;
+
+    /**
+    * @brief Reuses the read accessors of the images under the cursor across the status bar updates.
+    */
+    ImagePixelValueLookup m_PixelValueLookup;
   };
 }
 #endif
@@ -14,6 +14,7 @@ found in the LICENSE file.
 #define mitkEventRecorder_h
 
 #include "iostream"
+#include <chrono>
 #include "mitkInteractionEventObserver.h"
 #include <MitkCoreExports.h>
 
@@ -40,9 +41,13 @@ namespace mitk
      *     <attribute name="PositionOnScreen" value="491,388"/>
      *     <attribute name="PositionInWorld" value="128,235.771,124.816"/>
      *     <attribute name="RendererName" value="stdmulti.widget1"/>
+     *     <attribute name="Timestamp" value="1532.25"/>
      *    </event_variant>
      *   </events>
      *  </interactions>
+     *
+     * The timestamp of an event is given in milliseconds since StartRecording(), so that a replay can
+     * reproduce the pace of the recorded interaction.
      **/
   class MITKCORE_EXPORT EventRecorder : public InteractionEventObserver
   {
@@ -78,6 +83,7 @@ namespace mitk
     std::string m_FileName;
 
     std::ofstream m_FileStream;
+    std::chrono::steady_clock::time_point m_StartTime;
   };
 }
 #endif
@@ -59,6 +59,14 @@ namespace mitk
   - time step 0.
   - component 0.
   - resample by geometry false (Corresponds to input image).
+
+  If the bricked layout of the input image is enabled (see mitk::Image::SetBrickedLayoutEnabled()),
+  axis-aligned slices with nearest neighbor interpolation are copied from the bricked volume
+  instead of being resliced by vtkImageReslice. The result is identical.
+
+  Other planar slices with nearest neighbor or linear interpolation are resliced by a kernel of
+  the filter itself, whose output rows are processed in parallel by the mitk::ThreadPool. It samples
+  the input like vtkImageReslice does. Curved planes and cubic interpolation use vtkImageReslice.
   */
   class MITKCORE_EXPORT ExtractSliceFilter : public ImageToImageFilter
   {
@@ -93,6 +101,15 @@ namespace mitk
       this->m_InPlaneResampleExtentByGeometry = inPlaneResampleExtentByGeometry;
     }
 
+    /** \brief Reduce the in-plane resolution of the slice by the given factor (1, the default, is full resolution).
+    * Used for cheap previews during interaction.
+    */
+    void SetInPlaneDownsamplingFactor(unsigned int factor)
+    {
+      this->m_InPlaneDownsamplingFactor = factor > 1 ? factor : 1;
+    }
+    unsigned int GetInPlaneDownsamplingFactor() const { return this->m_InPlaneDownsamplingFactor; }
+
     /** \brief Sets the output dimension of the slice*/
     void SetOutputDimensionality(unsigned int dimension) { this->m_OutputDimension = dimension; }
     /** \brief Set the spacing in z direction manually.
@@ -184,6 +201,8 @@ namespace mitk
 
     bool m_InPlaneResampleExtentByGeometry; // Resampling grid corresponds to:  false->image    true->worldgeometry
 
+    unsigned int m_InPlaneDownsamplingFactor;
+
     mitk::ScalarType *m_OutPutSpacing;
 
     bool m_VtkOutputRequested;
@@ -193,6 +212,18 @@ namespace mitk
     unsigned int m_Component;
 
   private:
+    /** \brief Fills the reslicer output from the bricked volume of the input, if the slice is
+    * axis-aligned and all other preconditions are met. Returns false otherwise. */
+    bool GenerateDataFromBrickedVolume(vtkImageData *inputVtkImage);
+
+    /** \brief Fills the reslicer output by the parallel reslice kernel for planar slices with nearest neighbor
+    * or linear interpolation. Returns false if these preconditions are not met. */
+    bool GenerateDataWithResliceKernel(vtkImageData *inputVtkImage);
+
+    /** \brief Computes the continuous input index of the first output pixel and the steps to its neighbors
+    * in i and j direction. */
+    void ComputeInputIndexGrid(vtkImageData *inputVtkImage, double base[3], double stepI[3], double stepJ[3]);
+
     BaseGeometry::ConstPointer m_ResliceTransform;
     /* Axis vectors of the relevant geometry. Set in GenerateOutputInformation() and also used in GenerateData().*/
     Vector3D m_Right, m_Bottom;
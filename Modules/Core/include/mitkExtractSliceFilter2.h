@@ -27,10 +27,11 @@ namespace mitk
    * If a pixel of the 2-d output image isn't located within the bounds of the
    * 3-d input image, it is set to the lowest possible pixel value.
    *
-   * Cubic interpolation is considerably slow on the first update for a newly
-   * set input image. Subsequent filter updates with cubic interpolation are
-   * faster by several orders of magnitude as long as the input image was
-   * neither changed nor modified.
+   * Cubic interpolation needs B-spline coefficients of the input image. They
+   * are computed only for the bricks of the input image around the extracted
+   * slice, in parallel, and are cached for as long as the input image is
+   * neither modified nor deleted. The cache is shared by all filters with the
+   * same input image, so subsequent slices are extracted considerably faster.
    *
    * This filter is completely based on ITK compared to the VTK-based
    * mitk::ExtractSliceFilter. It is more robust, easy to use, and produces
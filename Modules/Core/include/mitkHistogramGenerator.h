@@ -38,6 +38,7 @@ namespace mitk
     itkGetConstObjectMacro(Histogram, HistogramType);
 
     // TODO: calculate if needed in GetHistogram()
+    // computes the histogram only if the image, its contents or the size changed since the last call
     void ComputeHistogram();
     float GetMaximumFrequency() const;
     static float CalculateMaximumFrequency(const HistogramType *histogram);
@@ -14,6 +14,7 @@ found in the LICENSE file.
 #define MITKIOUTIL_H
 
 #include <MitkCoreExports.h>
+#include <mitkAsyncSaveOperation.h>
 #include <mitkDataStorage.h>
 #include <mitkImage.h>
 #include <mitkPointSet.h>
@@ -313,6 +314,32 @@ namespace mitk
     static std::vector<BaseData::Pointer> Load(const std::vector<std::string> &paths,
                                                const ReaderOptionsFunctorBase *optionsCallback = nullptr);
 
+    /**
+     * @brief Loads a list of file paths into the given DataStorage, reading several files concurrently.
+     *
+     * Mime-type detection, reader selection and the options callback run on the calling thread. The selected
+     * readers then read their files on up to \c numberOfThreads worker threads, and the resulting nodes are added
+     * to \c storage on the calling thread in the order of \c paths. The result is the same as the one of
+     * Load(const std::vector<std::string>&, DataStorage&, const ReaderOptionsFunctorBase*).
+     *
+     * Since only IFileReader::Read() is called on the worker threads, readers which need the DataStorage (like
+     * the reader of MITK scene files) or report progress themselves should be used with the sequential Load().
+     *
+     * @param paths A list of absolute file names including the file extension.
+     * @param storage A DataStorage object to which the loaded data will be added.
+     * @param numberOfThreads The maximum number of concurrently read files. 0 uses one thread per hardware thread.
+     * @param optionsCallback Pointer to a callback instance. The callback is used by
+     * the load operation if more the suitable reader was found or the reader has options
+     * that can be set.
+     * @return The set of added DataNode objects.
+     * @throws mitk::Exception if an entry in \c paths could not be loaded.
+     */
+    static DataStorage::SetOfObjects::Pointer LoadConcurrently(
+      const std::vector<std::string> &paths,
+      DataStorage &storage,
+      unsigned int numberOfThreads = 0,
+      const ReaderOptionsFunctorBase *optionsCallback = nullptr);
+
     /**
      * @brief Loads the contents of a us::ModuleResource and returns the corresponding mitk::BaseData
      * @param usResource a ModuleResource, representing a BaseData object
@@ -404,12 +431,44 @@ namespace mitk
      */
     static void Save(std::vector<SaveInfo> &saveInfos, bool setPathProperty = false);
 
+    /**
+     * @brief Save a mitk::BaseData instance on a background thread.
+     *
+     * The writer is selected on the calling thread like in Save(const mitk::BaseData*, const std::string&,
+     * const IFileWriter::Options&, bool), but it writes a copy of \c data, taken via Clone() before this
+     * method returns. The data may therefore be modified while it is written. Its class has to support Clone()
+     * (see mitkCloneMacro).
+     *
+     * @param data The data to save.
+     * @param path The path to the file including file name and file extension.
+     * @param callback Called on the background thread when the operation is done.
+     * @param options The IFileWriter options to use for the selected writer.
+     * @return The running operation, which can be waited for or cancelled.
+     * @throws mitk::Exception if no writer for \c data is available.
+     */
+    static AsyncSaveOperation::Pointer SaveAsync(
+      const mitk::BaseData *data,
+      const std::string &path,
+      const AsyncSaveOperation::CallbackType &callback = AsyncSaveOperation::CallbackType(),
+      const IFileWriter::Options &options = IFileWriter::Options());
+
   protected:
     static std::string Load(std::vector<LoadInfo> &loadInfos,
                             DataStorage::SetOfObjects *nodeResult,
                             DataStorage *ds,
                             const ReaderOptionsFunctorBase *optionsCallback);
 
+    /**
+     * @brief Like the Load() above, but reads up to \c numberOfThreads files concurrently (see LoadConcurrently()).
+     *
+     * A \c numberOfThreads of 1 reads the files one after another.
+     */
+    static std::string Load(std::vector<LoadInfo> &loadInfos,
+                            DataStorage::SetOfObjects *nodeResult,
+                            DataStorage *ds,
+                            const ReaderOptionsFunctorBase *optionsCallback,
+                            unsigned int numberOfThreads);
+
     static std::string Save(const BaseData *data,
                             const std::string &mimeType,
                             const std::string &path,
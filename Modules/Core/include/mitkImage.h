@@ -14,9 +14,11 @@ found in the LICENSE file.
 #define MITKIMAGE_H_HEADER_INCLUDED_C1C2FCD2
 
 #include "mitkBaseData.h"
+#include "mitkBrickedImageVolume.h"
 #include "mitkImageAccessorBase.h"
 #include "mitkImageDataItem.h"
 #include "mitkImageDescriptor.h"
+#include "mitkImageVolumeProvider.h"
 #include "mitkImageVtkAccessor.h"
 #include "mitkLevelWindow.h"
 #include "mitkPlaneGeometry.h"
@@ -24,6 +26,11 @@ found in the LICENSE file.
 #include <MitkCoreExports.h>
 #include <mitkProportionalTimeGeometry.h>
 
+#include <atomic>
+#include <deque>
+#include <list>
+#include <map>
+
 // DEPRECATED
 #include <mitkTimeSlicedGeometry.h>
 
@@ -45,6 +52,7 @@ namespace mitk
   class ImageTimeSelector;
 
   class ImageStatisticsHolder;
+  class ImageHibernationStore;
 
   //##Documentation
   //## @brief Image class for storing images
@@ -644,6 +652,115 @@ namespace mitk
       new \a ImageStatisticsHolder object.
       */
     StatisticsHolderPointer GetStatistics() const { return m_ImageStatistics; }
+
+    /**
+      \brief Sets where memory that is allocated by the image itself (i.e. not imported via
+      SetImportVolume etc. with ManageMemory or ReferenceMemory) is placed.
+
+      Has to be called before the image data is allocated, i.e. before the first access to the
+      image data, to have an effect. Use ImageDataItem::MappedFileStorage for images that may exceed
+      the physical memory: the data is then backed by a temporary file and only the pages that are
+      touched by GetSliceData, GetVolumeData or the image accessors are actually loaded.
+      The default is ImageDataItem::HeapStorage.
+      */
+    void SetStorageMode(ImageDataItem::StorageMode storageMode) { m_StorageMode = storageMode; }
+    ImageDataItem::StorageMode GetStorageMode() const { return m_StorageMode; }
+
+    /**
+      \brief Sets a provider that produces volumes on demand.
+
+      Whenever GetVolumeData is called for a volume that is not set (see IsVolumeSet), the image
+      allocates the volume and lets @a provider fill it. Volumes set via SetImportVolume, SetVolume or
+      as part of a channel always take precedence and are never passed to the provider.
+      Set nullptr to disable on-demand provision.
+      */
+    void SetVolumeProvider(ImageVolumeProvider *provider);
+    ImageVolumeProvider *GetVolumeProvider() const { return m_VolumeProvider; }
+
+    /**
+      \brief Restricts the memory held by volumes that were produced by the volume provider to
+      @a budget bytes (0, the default, means no restriction).
+
+      If a newly provided volume exceeds the budget, the least recently accessed provided volumes are
+      released; they are reported as not set and re-provided on the next GetVolumeData call. Volumes that
+      are still referenced elsewhere (e.g. by an accessor or a vtkImageData) are not released.
+      @warning Changes written into a provided volume are lost when it is released. Provided volumes that
+      are overwritten via SetImportVolume or SetVolume are excluded from the budget and kept.
+      */
+    void SetProvidedVolumesMemoryBudget(size_t budget);
+    size_t GetProvidedVolumesMemoryBudget() const { return m_ProvidedVolumesMemoryBudget; }
+
+    /**
+      \brief Moves the volumes into @a store and releases their memory.
+
+      Meant for images that are not displayed, e.g. to keep the memory of an application within a budget
+      (see MemoryAccounting). The store becomes the volume provider of the image (see SetVolumeProvider),
+      so the image stays fully usable: a volume is restored into memory on its next access.
+      Without a store, the volumes are kept in temporary files (see MappedFileHibernationStore).
+      Volumes that are still referenced elsewhere (e.g. by an accessor or a vtkImageData) are stored but
+      not released. Hibernating an image that has a volume provider other than the store of an earlier
+      hibernation does nothing.
+      @return The number of bytes released, minus the main memory taken by the store
+      */
+    size_t Hibernate(ImageHibernationStore *store = nullptr);
+
+    /**
+      \brief Keeps an additional copy of the image volumes in a bricked memory layout (see BrickedImageVolume).
+
+      Axis-aligned reslicing with nearest neighbor interpolation (mitk::ExtractSliceFilter) then reads
+      from the bricked copy, which makes sagittal and coronal slices about as cheap as axial ones
+      on large volumes. The copy is created on the first request of a volume and costs as much memory
+      as the volume itself. Disabled by default; disabling releases all bricked copies.
+      */
+    void SetBrickedLayoutEnabled(bool enabled);
+    bool GetBrickedLayoutEnabled() const { return m_BrickedLayoutEnabled; }
+
+    /**
+      \brief Returns the bricked copy of volume @a t of channel @a n.
+
+      The copy is created on first request and recreated if the image was modified since (see
+      itk::Object::Modified()). Returns nullptr if the bricked layout is disabled, the image has less
+      than three dimensions or the volume is not set.
+      @warning Changes written through an accessor become visible only after Modified() was called.
+      */
+    BrickedImageVolume::Pointer GetBrickedVolume(int t = 0, int n = 0) const;
+
+    /**
+      \brief Marks the whole image as modified.
+
+      Consumers that support partial updates cannot restrict their update after a call of this
+      method, see GetModifiedRegion(). Prefer RegionModified() if only a part of the image was changed.
+      */
+    void Modified() const override;
+
+    /**
+      \brief Marks @a region of the image as modified.
+
+      Like Modified(), this updates the modification time and invokes an itk::ModifiedEvent,
+      but additionally records @a region, so that consumers can query which part of the image
+      changed since their last update (see GetModifiedRegion()), e.g. to re-render only if the
+      displayed slice is affected. The region is given in index coordinates; dimensions 3 and 4
+      denote the time step and the channel.
+      */
+    void RegionModified(const RegionType &region) const;
+
+    /**
+      \brief Returns the bounding box of all regions modified after @a time.
+
+      Returns false if the image was modified as a whole after @a time (by Modified(), a change
+      of the geometry, re-initialization, or because too many regions were recorded since), in
+      that case @a region is not changed. If the image was not modified at all after @a time,
+      @a region has a size of zero.
+      */
+    bool GetModifiedRegion(itk::ModifiedTimeType time, RegionType &region) const;
+
+    /**
+      \brief Returns the region of time step @a t (all channels) that contains the voxels intersected
+      by the bounding box of @a plane. The region is cropped to the image and has a size of zero if
+      the plane does not intersect the image.
+      */
+    RegionType GetRegionOfPlane(const PlaneGeometry *plane, int t = 0) const;
+
   protected:
     mitkCloneMacro(Self);
 
@@ -699,6 +816,29 @@ namespace mitk
     size_t *m_OffsetTable;
     ImageDataItemPointer m_CompleteData;
 
+    ImageDataItem::StorageMode m_StorageMode;
+
+    ImageVolumeProvider::Pointer m_VolumeProvider;
+    size_t m_ProvidedVolumesMemoryBudget;
+    /** Volume indices of the volumes created by m_VolumeProvider, most recently accessed first */
+    mutable std::list<int> m_ProvidedVolumes;
+
+    bool m_BrickedLayoutEnabled;
+    /** Bricked copies of the volumes, by volume index */
+    mutable std::map<int, BrickedImageVolume::Pointer> m_BrickedVolumes;
+    mutable itk::SimpleFastMutexLock m_BrickedVolumesLock;
+
+    struct ModifiedRegionRecord
+    {
+      itk::ModifiedTimeType m_Time;
+      RegionType m_Region;
+    };
+    /** Regions recorded by RegionModified(), oldest first */
+    mutable std::deque<ModifiedRegionRecord> m_ModifiedRegions;
+    /** Modification time of the last modification of the whole image */
+    mutable itk::ModifiedTimeType m_WholeImageModifiedTime;
+    mutable itk::SimpleFastMutexLock m_ModifiedRegionsLock;
+
     // Image statistics Holder replaces the former implementation directly inside this class
     friend class ImageStatisticsHolder;
     StatisticsHolderPointer m_ImageStatistics;
@@ -724,18 +864,56 @@ namespace mitk
                                                       void *data,
                                                       ImportMemoryManagementType importMemoryManagement) const;
 
+    ImageDataItemPointer ProvideVolumeData_unlocked(int t, int n, bool releaseVolumes) const;
+    /** \brief Releases the least recently accessed provided volumes until they hold at most @a budget bytes. */
+    void ReleaseProvidedVolumes_unlocked(size_t budget, bool keepMostRecentlyAccessed) const;
+
     bool IsSliceSet_unlocked(int s, int t, int n) const;
     bool IsVolumeSet_unlocked(int t, int n) const;
     bool IsChannelSet_unlocked(int n) const;
 
+    /** \brief Copies the memory of all shared views (see ImageDataItem::SetSharedView) into memory owned by
+     * this image, so that it can be written without changing the image that provided the memory.
+     *
+     * \return true if any memory was copied
+     */
+    bool CopySharedViews() const;
+
+    /** True if a data item of this image may be a shared view */
+    mutable std::atomic<bool> m_HasSharedViews;
+
+    /** Number of independently locked lists the ImageReadAccessors are distributed to */
+    static const unsigned int NumberOfReaderShards = 8;
+
+    /** \brief Stores the existing ImageReadAccessors of all threads that are mapped to this shard.
+     *
+     * Readers only lock the shard of their thread, so concurrent readers of different threads do not
+     * contend as long as no write access is organized. Writers lock all shards (in ascending order and
+     * while holding m_ReadWriteLock) to check for overlapping readers.
+     */
+    struct ReaderShard
+    {
+      itk::SimpleFastMutexLock m_Lock;
+      std::vector<ImageAccessorBase *> m_Readers;
+    };
+
+    /** Returns the index of the reader shard used by the calling thread */
+    static unsigned int GetReaderShardIndex();
+
     /** Stores all existing ImageReadAccessors */
-    mutable std::vector<ImageAccessorBase *> m_Readers;
+    mutable ReaderShard m_ReaderShards[NumberOfReaderShards];
     /** Stores all existing ImageWriteAccessors */
     mutable std::vector<ImageAccessorBase *> m_Writers;
+    /** Stores all ImageWriteAccessors that wait for overlapping accessors. New overlapping readers wait for them
+     * (writer preference). */
+    mutable std::vector<ImageAccessorBase *> m_PendingWriters;
+    /** Number of ImageWriteAccessors that exist, wait or currently organize their access. As long as it is zero,
+     * readers do not need to lock m_ReadWriteLock. */
+    mutable std::atomic<unsigned int> m_NumberOfWriters;
     /** Stores all existing ImageVtkAccessors */
     mutable std::vector<ImageAccessorBase *> m_VtkReaders;
 
-    /** A mutex, which needs to be locked to manage m_Readers and m_Writers */
+    /** A mutex, which needs to be locked to manage m_Writers and m_PendingWriters */
     itk::SimpleFastMutexLock m_ReadWriteLock;
     /** A mutex, which needs to be locked to manage m_VtkReaders */
     itk::SimpleFastMutexLock m_VtkReadersLock;
@@ -71,6 +71,14 @@ namespace mitk
 
 #define _msvc_expand_bug(macro, arg) BOOST_PP_EXPAND(macro arg)
 
+// Modules defining MITK_ACCESSBYITK_HOT_TYPES_ONLY restrict the default pixel types of the
+// AccessByItk and AccessFixedDimensionByItk macros to MITK_ACCESSBYITK_HOT_PIXEL_TYPES_SEQ
+#ifdef MITK_ACCESSBYITK_HOT_TYPES_ONLY
+#define _accessByItkDefaultPixelTypesSeq MITK_ACCESSBYITK_HOT_PIXEL_TYPES_SEQ
+#else
+#define _accessByItkDefaultPixelTypesSeq MITK_ACCESSBYITK_PIXEL_TYPES_SEQ
+#endif
+
 //-------------------------------- 0-Arg Versions --------------------------------------
 
 #define _accessByItk(itkImageTypeFunctionAndImageSeq, pixeltype, dimension)                                            \
@@ -187,7 +195,7 @@ namespace mitk
  */
 #define AccessByItk(mitkImage, itkImageTypeFunction)                                                                   \
   AccessFixedTypeByItk(                                                                                                \
-    mitkImage, itkImageTypeFunction, MITK_ACCESSBYITK_PIXEL_TYPES_SEQ, MITK_ACCESSBYITK_DIMENSIONS_SEQ)
+    mitkImage, itkImageTypeFunction, _accessByItkDefaultPixelTypesSeq, MITK_ACCESSBYITK_DIMENSIONS_SEQ)
 
 /**
  * \brief Access a mitk-image with known pixeltype (but unknown dimension) by an itk-image.
@@ -253,6 +261,27 @@ namespace mitk
   AccessFixedTypeByItk(                                                                                                \
     mitkImage, itkImageTypeFunction, MITK_ACCESSBYITK_VECTOR_PIXEL_TYPES_SEQ, MITK_ACCESSBYITK_DIMENSIONS_SEQ)
 
+/**
+ * \brief Access a mitk-image with one of the most frequently used pixel types by an itk-image
+ *
+ * Only the pixel types in MITK_ACCESSBYITK_HOT_PIXEL_TYPES (by default short, float and
+ * unsigned char) are instantiated, which generates considerably less code than #AccessByItk.
+ * See #AccessByItk for details.
+ *
+ * \param mitkImage The MITK input image.
+ * \param itkImageTypeFunction The templated access-function to be called.
+ *
+ * \throws mitk::AccessByItkException If mitkImage is of unsupported pixel type or dimension.
+ *
+ * \sa AccessFixedPixelTypeByItk
+ * \sa AccessByItk
+ * \sa AccessHotPixelTypeByItk_n
+ * \sa mitk::AccessByItkDispatcher
+ */
+#define AccessHotPixelTypeByItk(mitkImage, itkImageTypeFunction)                                                       \
+  AccessFixedTypeByItk(                                                                                                \
+    mitkImage, itkImageTypeFunction, MITK_ACCESSBYITK_HOT_PIXEL_TYPES_SEQ, MITK_ACCESSBYITK_DIMENSIONS_SEQ)
+
 /**
  * \brief Access a mitk-image with known dimension by an itk-image
  *
@@ -275,7 +304,7 @@ namespace mitk
  * \ingroup Adaptor
  */
 #define AccessFixedDimensionByItk(mitkImage, itkImageTypeFunction, dimension)                                          \
-  AccessFixedTypeByItk(mitkImage, itkImageTypeFunction, MITK_ACCESSBYITK_PIXEL_TYPES_SEQ, (dimension))
+  AccessFixedTypeByItk(mitkImage, itkImageTypeFunction, _accessByItkDefaultPixelTypesSeq, (dimension))
 
 #define AccessVectorFixedDimensionByItk(mitkImage, itkImageTypeFunction, dimension)                                    \
   AccessFixedTypeByItk(mitkImage, itkImageTypeFunction, MITK_ACCESSBYITK_VECTOR_PIXEL_TYPES_SEQ, (dimension))
@@ -371,7 +400,7 @@ namespace mitk
  */
 #define AccessByItk_n(mitkImage, itkImageTypeFunction, va_tuple)                                                       \
   AccessFixedTypeByItk_n(                                                                                              \
-    mitkImage, itkImageTypeFunction, MITK_ACCESSBYITK_PIXEL_TYPES_SEQ, MITK_ACCESSBYITK_DIMENSIONS_SEQ, va_tuple)
+    mitkImage, itkImageTypeFunction, _accessByItkDefaultPixelTypesSeq, MITK_ACCESSBYITK_DIMENSIONS_SEQ, va_tuple)
 
 /**
  * \brief Access a mitk-image with known pixeltype (but unknown dimension) by an itk-image
@@ -470,6 +499,29 @@ namespace mitk
                          MITK_ACCESSBYITK_DIMENSIONS_SEQ,                                                              \
                          va_tuple)
 
+/**
+ * \brief Access a mitk-image with one of the most frequently used pixel types by an itk-image
+ *        with one or more parameters.
+ *
+ * See #AccessHotPixelTypeByItk and #AccessByItk_n for details.
+ *
+ * \param va_tuple A variable length tuple containing the arguments to be passed
+ *        to the access function itkImageTypeFunction, e.g. ("first", 2, THIRD).
+ * \param mitkImage The MITK input image.
+ * \param itkImageTypeFunction The templated access-function to be called.
+ *
+ * \throws mitk::AccessByItkException If mitkImage is of unsupported pixel type or dimension.
+ *
+ * \sa AccessHotPixelTypeByItk
+ * \sa AccessByItk_n
+ */
+#define AccessHotPixelTypeByItk_n(mitkImage, itkImageTypeFunction, va_tuple)                                           \
+  AccessFixedTypeByItk_n(mitkImage,                                                                                    \
+                         itkImageTypeFunction,                                                                         \
+                         MITK_ACCESSBYITK_HOT_PIXEL_TYPES_SEQ,                                                         \
+                         MITK_ACCESSBYITK_DIMENSIONS_SEQ,                                                              \
+                         va_tuple)
+
 /**
  * \brief Access a mitk-image with known dimension by an itk-image with
  *        one or more parameters.
@@ -495,7 +547,7 @@ namespace mitk
  * \ingroup Adaptor
  */
 #define AccessFixedDimensionByItk_n(mitkImage, itkImageTypeFunction, dimension, va_tuple)                              \
-  AccessFixedTypeByItk_n(mitkImage, itkImageTypeFunction, MITK_ACCESSBYITK_PIXEL_TYPES_SEQ, (dimension), va_tuple)
+  AccessFixedTypeByItk_n(mitkImage, itkImageTypeFunction, _accessByItkDefaultPixelTypesSeq, (dimension), va_tuple)
 
 /**
  * \brief Access a vector mitk-image with known dimension by a ITK vector image with
@@ -0,0 +1,175 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITKIMAGEACCESSBYITKDISPATCH_H
+#define MITKIMAGEACCESSBYITKDISPATCH_H
+
+#include <mitkImageAccessByItk.h>
+
+#include <cstddef>
+#include <sstream>
+#include <type_traits>
+#include <utility>
+
+namespace mitk
+{
+  /**
+   * \brief Compile-time list of pixel types for AccessByItkDispatcher.
+   *
+   * \ingroup Adaptor
+   */
+  template <typename... TPixels>
+  struct AccessPixelTypes
+  {
+    static const std::size_t Size = sizeof...(TPixels);
+  };
+
+  /**
+   * \brief Compile-time list of image dimensions for AccessByItkDispatcher.
+   *
+   * \ingroup Adaptor
+   */
+  template <unsigned int... VDimensions>
+  struct AccessDimensions
+  {
+    static const std::size_t Size = sizeof...(VDimensions);
+  };
+
+  /**
+   * \brief The pixel types which cover the vast majority of images in practice
+   * (CT/MR intensities, float results and segmentations).
+   *
+   * These match the default of the MITK_ACCESSBYITK_HOT_PIXEL_TYPES CMake variable;
+   * see #AccessHotPixelTypeByItk.
+   *
+   * \ingroup Adaptor
+   */
+  typedef AccessPixelTypes<short, float, unsigned char> AccessHotPixelTypes;
+
+  /** \brief The default dimensions used by #AccessByItk. */
+  typedef AccessDimensions<2, 3> AccessDefaultDimensions;
+
+  template <typename TPixelTypes, typename TDimensions = AccessDefaultDimensions>
+  class AccessByItkDispatcher;
+
+  /**
+   * \brief Template based alternative to the #AccessByItk macros.
+   *
+   * The caller declares exactly the pixel types and dimensions it supports, so only
+   * these combinations are instantiated. The image type is resolved by a single
+   * lookup of the pixel type and dimension index, followed by an indirect call
+   * through a table of function pointers instead of a chain of comparisons.
+   *
+   * The functor is called with the itk::Image (or itk::VectorImage for
+   * itk::VariableLengthVector pixel types) referencing the MITK image memory,
+   * followed by the additional arguments passed to Dispatch(). Generic lambdas
+   * are the most convenient functors:
+   * \code
+   * typedef mitk::AccessByItkDispatcher<mitk::AccessPixelTypes<short, float>, mitk::AccessDimensions<3>> Dispatcher;
+   * Dispatcher::Dispatch(mitkImage, [&](auto itkImage, double threshold) { ... }, 42.0);
+   * \endcode
+   *
+   * As with the macros, a const MITK image is accessed by a read-only ITK image,
+   * a non-const MITK image by a writable one.
+   *
+   * \throws mitk::AccessByItkException If the image is of a pixel type or dimension not in the given lists.
+   *
+   * \sa AccessFixedTypeByItk_n
+   *
+   * \ingroup Adaptor
+   */
+  template <typename... TPixels, unsigned int... VDimensions>
+  class AccessByItkDispatcher<AccessPixelTypes<TPixels...>, AccessDimensions<VDimensions...>>
+  {
+  public:
+    template <typename TImage, typename TFunctor, typename... TArgs>
+    static void Dispatch(TImage *mitkImage, TFunctor &&functor, TArgs &&... args)
+    {
+      static_assert(std::is_same<typename std::remove_const<TImage>::type, mitk::Image>::value,
+                    "AccessByItkDispatcher requires a mitk::Image");
+
+      typedef Invoker<TImage, typename std::remove_reference<TFunctor>::type, TArgs...> InvokerType;
+
+      const int dimensionIndex = GetDimensionIndex(mitkImage->GetDimension());
+      if (dimensionIndex < 0)
+      {
+        std::stringstream msg;
+        msg << "Dimension " << mitkImage->GetDimension() << " is not in the list of " << sizeof...(VDimensions)
+            << " supported dimensions";
+        throw mitk::AccessByItkException(msg.str());
+      }
+
+      const int pixelTypeIndex = GetPixelTypeIndex(mitkImage->GetPixelType());
+      if (pixelTypeIndex < 0)
+      {
+        std::stringstream msg;
+        msg << "Pixel type " << mitkImage->GetPixelType().GetPixelTypeAsString() << " is not in the list of "
+            << sizeof...(TPixels) << " supported pixel types";
+        throw mitk::AccessByItkException(msg.str());
+      }
+
+      typedef typename InvokerType::RowFunction RowFunction;
+      static const RowFunction rows[] = {&InvokerType::template GetRow<TPixels>...};
+      rows[pixelTypeIndex](dimensionIndex)(mitkImage, functor, args...);
+    }
+
+  private:
+    template <typename TImage, typename TFunctor, typename... TArgs>
+    struct Invoker
+    {
+      typedef void (*Function)(TImage *, TFunctor &, TArgs &...);
+      typedef Function (*RowFunction)(int);
+
+      template <typename TPixel, unsigned int VDimension>
+      static void Invoke(TImage *mitkImage, TFunctor &functor, TArgs &... args)
+      {
+        functor(mitk::ImageToItkImage<TPixel, VDimension>(mitkImage).GetPointer(), args...);
+      }
+
+      template <typename TPixel>
+      static Function GetRow(int dimensionIndex)
+      {
+        static const Function row[] = {&Invoke<TPixel, VDimensions>...};
+        return row[dimensionIndex];
+      }
+    };
+
+    static int GetDimensionIndex(unsigned int dimension)
+    {
+      static const unsigned int dimensions[] = {VDimensions...};
+      for (std::size_t i = 0; i < sizeof...(VDimensions); ++i)
+      {
+        if (dimensions[i] == dimension)
+          return static_cast<int>(i);
+      }
+      return -1;
+    }
+
+    static int GetPixelTypeIndex(const mitk::PixelType &pixelType)
+    {
+      static const int ioPixelTypes[] = {MapPixelType<TPixels, isPrimitiveType<TPixels>::value>::IOPixelType...};
+      static const int ioComponentTypes[] = {
+        MapPixelType<TPixels, isPrimitiveType<TPixels>::value>::IOComponentType...};
+
+      const int ioPixelType = pixelType.GetPixelType();
+      const int ioComponentType = pixelType.GetComponentType();
+      for (std::size_t i = 0; i < sizeof...(TPixels); ++i)
+      {
+        if (ioPixelTypes[i] == ioPixelType && ioComponentTypes[i] == ioComponentType)
+          return static_cast<int>(i);
+      }
+      return -1;
+    }
+  };
+}
+
+#endif // MITKIMAGEACCESSBYITKDISPATCH_H
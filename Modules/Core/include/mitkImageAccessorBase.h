@@ -124,8 +124,9 @@ namespace mitk
     /** \brief Pointer to a WaitLock struct, that allows other ImageAccessors to wait for this ImageAccessor */
     ImageAccessorWaitLock *m_WaitLock;
 
-    /** \brief Increments m_WaiterCount. A call of this method is prohibited unless the Mutex m_ReadWriteLock in the
-     * mitk::Image class is Locked. */
+    /** \brief Increments m_WaiterCount. A call of this method is prohibited unless the Mutex that protects the
+     * registration of this accessor in the mitk::Image class is locked (m_ReadWriteLock for write accessors, the
+     * lock of the reader shard for read accessors). */
     inline void Increment() { m_WaitLock->m_WaiterCount += 1; }
     /** \brief Computes if there is an Overlap of the image part between this instantiation and another ImageAccessor
      * object
@@ -141,6 +142,10 @@ namespace mitk
     /** \brief Prevents a recursive mutex lock by comparing thread ids of competing image accessors */
     void PreventRecursiveMutexLock(ImageAccessorBase *iAB);
 
+    /** \brief Returns true if waiting for @a iAB would dead-lock, i.e. if @a iAB was created by the current thread.
+     * In contrast to PreventRecursiveMutexLock, no lock is released and no exception is thrown. */
+    bool IsRequestedRecursively(const ImageAccessorBase *iAB);
+
     virtual const Image *GetImage() const = 0;
 
   private:
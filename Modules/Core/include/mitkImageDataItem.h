@@ -64,6 +64,19 @@ namespace mitk
 
     mitkClassMacroItkParent(ImageDataItem, itk::LightObject);
 
+    //## @brief Defines where the memory of an ImageDataItem is allocated if it is not provided from outside.
+    //##
+    //## HeapStorage: a contiguous heap buffer (default). Buffers are taken from the image memory pool
+    //## (see MemoryUtilities::AllocatePooledMemory), so items of recurring sizes reuse released memory.
+    //## MappedFileStorage: a buffer backed by an anonymous temporary file (see
+    //## MemoryUtilities::AllocateMappedMemory). Pages are only loaded when they are touched and can be
+    //## written back to the file by the operating system, so images larger than the physical RAM can be held.
+    enum StorageMode
+    {
+      HeapStorage,
+      MappedFileStorage
+    };
+
     itkCloneMacro(ImageDataItem);
     itk::LightObject::Pointer InternalClone() const override;
 
@@ -77,14 +90,19 @@ namespace mitk
 
     ~ImageDataItem() override;
 
-    ImageDataItem(const mitk::ImageDescriptor::Pointer desc, int timestep, void *data, bool manageMemory);
+    ImageDataItem(const mitk::ImageDescriptor::Pointer desc,
+                  int timestep,
+                  void *data,
+                  bool manageMemory,
+                  StorageMode storageMode = HeapStorage);
 
     ImageDataItem(const mitk::PixelType &type,
                   int timestep,
                   unsigned int dimension,
                   unsigned int *dimensions,
                   void *data,
-                  bool manageMemory);
+                  bool manageMemory,
+                  StorageMode storageMode = HeapStorage);
 
     ImageDataItem(const ImageDataItem &other);
 
@@ -111,6 +129,13 @@ namespace mitk
     }
 
     ImageDataItem::ConstPointer GetParent() const { return m_Parent; }
+
+    //## @brief Marks the item as a view of the memory of its parent that belongs to another image.
+    //##
+    //## The parent is kept alive by the view. The image holding the view copies the memory before
+    //## the first write access (see ImageWriteAccessor), so the other image is never changed.
+    void SetSharedView(bool sharedView) { m_SharedView = sharedView; }
+    bool IsSharedView() const { return m_SharedView; }
     /**
      * @brief GetVtkImageAccessor Returns a vtkImageDataItem, if none is present, a new one is constructed by the
      * ConstructVtkImageData method.
@@ -125,6 +150,8 @@ namespace mitk
 
     // Returns if image data should be deleted on destruction of ImageDataItem.
     bool GetManageMemory() const { return m_ManageMemory; }
+    // Returns where the managed memory of this item was allocated. Sub-items report the mode of their parent.
+    StorageMode GetStorageMode() const { return m_StorageMode; }
     virtual void ConstructVtkImageData(ImageConstPointer) const;
 
     size_t GetSize() const { return m_Size; }
@@ -137,6 +164,11 @@ namespace mitk
 
     bool m_ManageMemory;
 
+    StorageMode m_StorageMode;
+
+    // True if m_Data was allocated from the image memory pool (see MemoryUtilities::AllocatePooledMemory).
+    bool m_PooledMemory;
+
     mutable vtkImageData *m_VtkImageData;
     mutable ImageVtkReadAccessor *m_VtkImageReadAccessor;
     ImageVtkWriteAccessor *m_VtkImageWriteAccessor;
@@ -149,6 +181,16 @@ namespace mitk
   private:
     void ComputeItemSize(const unsigned int *dimensions, unsigned int dimension);
 
+    void AllocateData();
+
+    // Replaces the memory of a shared view by a copy that is owned by this item.
+    void CopySharedMemory();
+
+    // Updates the data pointer (and the vtkImageData) if the memory of a parent was replaced.
+    void UpdateDataFromParent();
+
+    bool m_SharedView;
+
     ImageDataItem::ConstPointer m_Parent;
 
     unsigned int m_Dimension;
@@ -0,0 +1,306 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITKIMAGEEXTREMAACCUMULATOR_H
+#define MITKIMAGEEXTREMAACCUMULATOR_H
+
+#include <itkMultiThreader.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace mitk
+{
+  /**
+    \brief Single pass computation of the extrema of a pixel buffer, as needed by ImageStatisticsHolder.
+
+    Computes minimum, maximum, second smallest and second largest value and the number of
+    pixels with the minimum and the maximum value. NaN values are ignored.
+
+    The buffer is read from memory once: it is processed in blocks that fit into the L1 cache,
+    for each block the extrema are determined first and then, only if the block can change the
+    result, the counts and second extrema. Both loops work on fixed groups of lanes with branch
+    free updates, a pattern which compilers translate to SIMD instructions (SSE/AVX on x86, NEON
+    on ARM) for all primitive pixel types. Compute() additionally distributes the buffer over
+    several threads and merges the partial results.
+
+    If the buffer contains a single distinct value only, the second smallest and second largest
+    values are undefined.
+    */
+  template <typename TPixel>
+  class ImageExtremaAccumulator
+  {
+  public:
+    ImageExtremaAccumulator()
+      : m_Min(HighestValue()),
+        m_SecondMin(HighestValue()),
+        m_Max(LowestValue()),
+        m_SecondMax(LowestValue()),
+        m_MinCount(0),
+        m_MaxCount(0)
+    {
+    }
+
+    /** \brief Computes the extrema of @a count pixels at @a data using @a numberOfThreads threads
+      (0: the global default number of threads of ITK). */
+    static ImageExtremaAccumulator Compute(const TPixel *data, std::size_t count, unsigned int numberOfThreads = 0)
+    {
+      // smaller chunks are not worth the thread start-up
+      const std::size_t minimumPixelsPerThread = 1 << 18;
+
+      if (numberOfThreads == 0)
+        numberOfThreads = itk::MultiThreader::GetGlobalDefaultNumberOfThreads();
+      numberOfThreads = static_cast<unsigned int>(
+        std::min<std::size_t>(numberOfThreads, std::max<std::size_t>(1, count / minimumPixelsPerThread)));
+
+      ImageExtremaAccumulator result;
+      if (numberOfThreads <= 1)
+      {
+        result.Add(data, count);
+        return result;
+      }
+
+      ThreadData threadData;
+      threadData.m_Data = data;
+      threadData.m_Count = count;
+      threadData.m_Results.resize(numberOfThreads);
+
+      itk::MultiThreader::Pointer threader = itk::MultiThreader::New();
+      threader->SetNumberOfThreads(numberOfThreads);
+      threader->SetSingleMethod(&ImageExtremaAccumulator::ThreaderCallback, &threadData);
+      threader->SingleMethodExecute();
+
+      for (const auto &partialResult : threadData.m_Results)
+        result.Merge(partialResult);
+      return result;
+    }
+
+    /** \brief Adds @a count pixels at @a data. */
+    void Add(const TPixel *data, std::size_t count)
+    {
+      // every block is read twice, so it should fit into the L1 cache
+      const std::size_t blockSize = 8192 / sizeof(TPixel);
+      while (count > 0)
+      {
+        const std::size_t size = std::min(count, blockSize);
+        this->AddBlock(data, size);
+        data += size;
+        count -= size;
+      }
+    }
+
+    /** \brief Combines the result of another accumulator with this one. */
+    void Merge(const ImageExtremaAccumulator &other)
+    {
+      MergeMin(other.m_Min, other.m_MinCount, other.m_SecondMin);
+      MergeMax(other.m_Max, other.m_MaxCount, other.m_SecondMax);
+    }
+
+    /** \brief True if no (non-NaN) pixel was added. */
+    bool IsEmpty() const { return m_MinCount == 0; }
+
+    TPixel GetMin() const { return m_Min; }
+    TPixel GetSecondMin() const { return m_SecondMin; }
+    TPixel GetMax() const { return m_Max; }
+    TPixel GetSecondMax() const { return m_SecondMax; }
+    std::size_t GetMinCount() const { return m_MinCount; }
+    std::size_t GetMaxCount() const { return m_MaxCount; }
+
+  private:
+    static const std::size_t Lanes = 16;
+
+    struct ThreadData
+    {
+      const TPixel *m_Data;
+      std::size_t m_Count;
+      std::vector<ImageExtremaAccumulator> m_Results;
+    };
+
+    static ITK_THREAD_RETURN_TYPE ThreaderCallback(void *arg)
+    {
+      auto *info = static_cast<itk::MultiThreader::ThreadInfoStruct *>(arg);
+      auto *threadData = static_cast<ThreadData *>(info->UserData);
+
+      const std::size_t begin = threadData->m_Count * info->ThreadID / info->NumberOfThreads;
+      const std::size_t end = threadData->m_Count * (info->ThreadID + 1) / info->NumberOfThreads;
+      threadData->m_Results[info->ThreadID].Add(threadData->m_Data + begin, end - begin);
+
+      return ITK_THREAD_RETURN_VALUE;
+    }
+
+    static TPixel HighestValue()
+    {
+      return std::numeric_limits<TPixel>::has_infinity ? std::numeric_limits<TPixel>::infinity()
+                                                       : std::numeric_limits<TPixel>::max();
+    }
+
+    static TPixel LowestValue()
+    {
+      return std::numeric_limits<TPixel>::has_infinity ? -std::numeric_limits<TPixel>::infinity()
+                                                       : std::numeric_limits<TPixel>::lowest();
+    }
+
+    void AddBlock(const TPixel *data, std::size_t count)
+    {
+      // first pass: extrema of the block
+      TPixel min[Lanes], max[Lanes];
+      for (std::size_t l = 0; l < Lanes; ++l)
+      {
+        min[l] = HighestValue();
+        max[l] = LowestValue();
+      }
+      std::size_t i = 0;
+      for (; i + Lanes <= count; i += Lanes)
+      {
+        for (std::size_t l = 0; l < Lanes; ++l)
+        {
+          const TPixel value = data[i + l];
+          min[l] = value < min[l] ? value : min[l];
+          max[l] = value > max[l] ? value : max[l];
+        }
+      }
+      for (std::size_t l = 0; i < count; ++i, ++l)
+      {
+        min[l] = data[i] < min[l] ? data[i] : min[l];
+        max[l] = data[i] > max[l] ? data[i] : max[l];
+      }
+      TPixel blockMin = min[0];
+      TPixel blockMax = max[0];
+      for (std::size_t l = 1; l < Lanes; ++l)
+      {
+        blockMin = min[l] < blockMin ? min[l] : blockMin;
+        blockMax = max[l] > blockMax ? max[l] : blockMax;
+      }
+
+      // second pass over the cached block: counts and second extrema, only if they can matter
+      const bool updateMin = m_MinCount == 0 || !(blockMin > m_SecondMin);
+      const bool updateMax = m_MaxCount == 0 || !(blockMax < m_SecondMax);
+      if (!updateMin && !updateMax)
+        return;
+
+      unsigned int minCount[Lanes], maxCount[Lanes];
+      TPixel secondMin[Lanes], secondMax[Lanes];
+      for (std::size_t l = 0; l < Lanes; ++l)
+      {
+        minCount[l] = maxCount[l] = 0;
+        secondMin[l] = HighestValue();
+        secondMax[l] = LowestValue();
+      }
+      for (i = 0; i + Lanes <= count; i += Lanes)
+      {
+        for (std::size_t l = 0; l < Lanes; ++l)
+        {
+          UpdateLane(data[i + l], blockMin, blockMax, minCount[l], maxCount[l], secondMin[l], secondMax[l]);
+        }
+      }
+      for (std::size_t l = 0; i < count; ++i, ++l)
+      {
+        UpdateLane(data[i], blockMin, blockMax, minCount[l], maxCount[l], secondMin[l], secondMax[l]);
+      }
+      for (std::size_t l = 1; l < Lanes; ++l)
+      {
+        minCount[0] += minCount[l];
+        maxCount[0] += maxCount[l];
+        secondMin[0] = secondMin[l] < secondMin[0] ? secondMin[l] : secondMin[0];
+        secondMax[0] = secondMax[l] > secondMax[0] ? secondMax[l] : secondMax[0];
+      }
+
+      if (updateMin)
+        MergeMin(blockMin, minCount[0], secondMin[0]);
+      if (updateMax)
+        MergeMax(blockMax, maxCount[0], secondMax[0]);
+    }
+
+    static void UpdateLane(TPixel value,
+                           TPixel blockMin,
+                           TPixel blockMax,
+                           unsigned int &minCount,
+                           unsigned int &maxCount,
+                           TPixel &secondMin,
+                           TPixel &secondMax)
+    {
+      minCount += value == blockMin ? 1u : 0u;
+      maxCount += value == blockMax ? 1u : 0u;
+      const TPixel aboveMin = value > blockMin ? value : HighestValue();
+      const TPixel belowMax = value < blockMax ? value : LowestValue();
+      secondMin = aboveMin < secondMin ? aboveMin : secondMin;
+      secondMax = belowMax > secondMax ? belowMax : secondMax;
+    }
+
+    void MergeMin(TPixel min, std::size_t count, TPixel secondMin)
+    {
+      if (count == 0)
+        return;
+
+      if (m_MinCount == 0)
+      {
+        m_Min = min;
+        m_SecondMin = secondMin;
+        m_MinCount = count;
+      }
+      else if (min < m_Min)
+      {
+        m_SecondMin = std::min(m_Min, secondMin);
+        m_Min = min;
+        m_MinCount = count;
+      }
+      else if (min == m_Min)
+      {
+        m_SecondMin = std::min(m_SecondMin, secondMin);
+        m_MinCount += count;
+      }
+      else
+      {
+        m_SecondMin = std::min(m_SecondMin, min);
+      }
+    }
+
+    void MergeMax(TPixel max, std::size_t count, TPixel secondMax)
+    {
+      if (count == 0)
+        return;
+
+      if (m_MaxCount == 0)
+      {
+        m_Max = max;
+        m_SecondMax = secondMax;
+        m_MaxCount = count;
+      }
+      else if (max > m_Max)
+      {
+        m_SecondMax = std::max(m_Max, secondMax);
+        m_Max = max;
+        m_MaxCount = count;
+      }
+      else if (max == m_Max)
+      {
+        m_SecondMax = std::max(m_SecondMax, secondMax);
+        m_MaxCount += count;
+      }
+      else
+      {
+        m_SecondMax = std::max(m_SecondMax, max);
+      }
+    }
+
+    TPixel m_Min;
+    TPixel m_SecondMin;
+    TPixel m_Max;
+    TPixel m_SecondMax;
+    std::size_t m_MinCount;
+    std::size_t m_MaxCount;
+  };
+}
+
+#endif // MITKIMAGEEXTREMAACCUMULATOR_H
@@ -0,0 +1,86 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkImageHibernationStore_h
+#define mitkImageHibernationStore_h
+
+#include <mitkImageVolumeProvider.h>
+
+#include <cstddef>
+#include <map>
+#include <utility>
+
+namespace mitk
+{
+  /**
+  * @brief Keeps the volumes of a hibernated image (see Image::Hibernate) and provides them again on access.
+  *
+  * Image::Hibernate passes a copy of every volume to StoreVolume and then uses the store as the volume
+  * provider of the image, so released volumes are restored transparently by ProvideVolume.
+  * @ingroup Data
+  */
+  class MITKCORE_EXPORT ImageHibernationStore : public ImageVolumeProvider
+  {
+  public:
+    mitkClassMacro(ImageHibernationStore, ImageVolumeProvider);
+
+    /**
+    * @brief Stores a copy of the @a size bytes of volume @a t of channel @a n of @a image.
+    *
+    * Like ProvideVolume, this is called while the data arrays of the image are locked.
+    * @return false, if the volume could not be stored. The image is then not hibernated.
+    */
+    virtual bool StoreVolume(const Image *image, int t, int n, const void *data, std::size_t size) = 0;
+
+    /** @brief Bytes of main memory held by the store, e.g. by compressed volumes. */
+    virtual std::size_t GetMemorySize() const = 0;
+
+  protected:
+    ImageHibernationStore();
+    ~ImageHibernationStore() override;
+  };
+
+  /**
+  * @brief Stores the volumes of a hibernated image in temporary files (see MemoryUtilities::AllocateMappedMemory).
+  *
+  * Storing and restoring is a plain copy, and the operating system can move the volumes out of the main
+  * memory without swapping. This is the store used by Image::Hibernate by default.
+  * @ingroup Data
+  */
+  class MITKCORE_EXPORT MappedFileHibernationStore : public ImageHibernationStore
+  {
+  public:
+    mitkClassMacro(MappedFileHibernationStore, ImageHibernationStore);
+    itkFactorylessNewMacro(Self);
+
+    bool StoreVolume(const Image *image, int t, int n, const void *data, std::size_t size) override;
+    bool ProvideVolume(const Image *image, int t, int n, void *buffer) override;
+
+    /** @brief Always 0, the data is backed by files. */
+    std::size_t GetMemorySize() const override;
+
+  protected:
+    MappedFileHibernationStore();
+    ~MappedFileHibernationStore() override;
+
+  private:
+    struct Volume
+    {
+      void *Memory;
+      std::size_t Size;
+    };
+
+    std::map<std::pair<int, int>, Volume> m_Volumes;
+  };
+}
+
+#endif
@@ -0,0 +1,94 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkImagePixelValueLookup_h
+#define mitkImagePixelValueLookup_h
+
+#include <MitkCoreExports.h>
+#include <mitkImage.h>
+#include <mitkImageReadAccessor.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace mitk
+{
+  /**
+   * \brief Looks up the pixel values of images at world positions, e.g. for the status bar while the mouse moves.
+   *
+   * For every image the read accessor of the current time step, the image dimensions and a reader for the
+   * pixel component type are prepared once and reused by subsequent lookups as long as the image and the
+   * time step do not change. A lookup then only costs a WorldToIndex transform and a buffer read, instead of
+   * creating an accessor (or an ITK image) per call. Several images can be looked up in one call.
+   *
+   * Only the images of the most recent lookup are kept, so the lookup does not keep removed images alive.
+   * The accessors ignore the image locks, like FastSinglePixelAccess(). Not thread-safe, use one instance
+   * per caller.
+   */
+  class MITKCORE_EXPORT ImagePixelValueLookup
+  {
+  public:
+    struct Result
+    {
+      /** False if the position is outside of the image or the image has no data for the time point */
+      bool IsInside = false;
+      itk::Index<3> Index;
+      /** Value of the requested component */
+      ScalarType Value = 0.0;
+      /** Values of all components of the pixel, e.g. of RGB(A) pixels */
+      std::vector<ScalarType> Components;
+    };
+
+    ImagePixelValueLookup();
+    ~ImagePixelValueLookup();
+
+    /** \brief Looks up the value of the given component of the image at the world position and time point. */
+    Result Lookup(const Image *image, const Point3D &worldPosition, TimePointType timePoint, int component = 0);
+
+    /** \brief Looks up the values of several images at the same world position and time point. */
+    std::vector<Result> Lookup(const std::vector<const Image *> &images,
+                               const Point3D &worldPosition,
+                               TimePointType timePoint,
+                               int component = 0);
+
+    /** \brief Releases all accessors. */
+    void Clear();
+
+  private:
+    typedef ScalarType (*ReadComponentFunction)(const void *data, std::size_t offset);
+
+    struct Entry
+    {
+      itk::ModifiedTimeType ImageMTime = 0;
+      TimeStepType TimeStep = 0;
+      /** Keeps provided volumes from being released while they are looked up */
+      Image::ImageDataItemPointer Volume;
+      std::unique_ptr<ImageReadAccessor> Accessor;
+      std::size_t Dimensions[3] = {1, 1, 1};
+      std::size_t NumberOfComponents = 1;
+      ReadComponentFunction ReadComponent = nullptr;
+    };
+
+    Result LookupImage(const Image *image, const Point3D &worldPosition, TimePointType timePoint, int component);
+
+    /** \brief Returns the prepared entry of the image, nullptr if the image cannot be read at the time step */
+    Entry *GetEntry(const Image *image, TimeStepType timeStep);
+
+    ImagePixelValueLookup(const ImagePixelValueLookup &) = delete;
+    ImagePixelValueLookup &operator=(const ImagePixelValueLookup &) = delete;
+
+    std::map<const Image *, Entry> m_Entries;
+  };
+}
+
+#endif
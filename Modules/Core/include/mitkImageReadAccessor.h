@@ -63,10 +63,17 @@ namespace mitk
     /** \brief manages a consistent read access and locks the ordered image part */
     void OrganizeReadAccess();
 
+    /** \brief Checks if the current thread holds a read access that the waiting @a writer has to wait for.
+     * Must only be called while m_ReadWriteLock of the image is locked. */
+    bool HoldsReadAccessRequiredBy(ImageAccessorBase *writer);
+
     ImageReadAccessor &operator=(const ImageReadAccessor &); // Not implemented on purpose.
     ImageReadAccessor(const ImageReadAccessor &);
 
     ImageConstPointer m_Image;
+
+    /** Index of the reader shard of the image this accessor is registered in */
+    unsigned int m_ReaderShardIndex;
   };
 }
 
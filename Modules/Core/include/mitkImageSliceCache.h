@@ -0,0 +1,127 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITKIMAGESLICECACHE_H
+#define MITKIMAGESLICECACHE_H
+
+#include <MitkCoreExports.h>
+#include <mitkNumericConstants.h>
+#include <mitkTimeGeometry.h>
+
+#include <vtkImageData.h>
+#include <vtkMatrix4x4.h>
+#include <vtkSmartPointer.h>
+
+#include <array>
+#include <cstddef>
+#include <list>
+
+namespace mitk
+{
+  class PlaneGeometry;
+
+  /**
+    \brief Bounded least recently used cache of the slices resliced from one image, as used by ImageVtkMapper2D.
+
+    A slice is identified by a Key, which contains everything besides the image that determines
+    the result of the reslicing: the plane geometry, the time step and the reslice parameters.
+    All cached slices belong to one state of the image. Find() and Insert() receive the modification
+    time of the image and drop all slices as soon as it changed.
+
+    The cached slices are deep copies, i.e. the reslicer can reuse its output for the next slice.
+    */
+  class MITKCORE_EXPORT ImageSliceCache
+  {
+  public:
+    struct MITKCORE_EXPORT Key
+    {
+      Key();
+
+      /** \brief Takes index to world transform, bounds and reference geometry from @a geometry. */
+      void SetPlaneGeometry(const PlaneGeometry *geometry);
+
+      /** \brief Hash of all members, used to preselect entries before comparing the keys. */
+      std::size_t GetHash() const;
+
+      bool operator==(const Key &other) const;
+
+      /** \brief Matrix (row major) and offset of the index to world transform of the plane geometry */
+      std::array<double, 12> Transform;
+      std::array<double, 6> Bounds;
+      const void *ReferenceGeometry;
+      unsigned long ReferenceGeometryMTime;
+      TimeStepType TimeStep;
+      int InterpolationMode;
+      int ThickSlicesMode;
+      int ThickSlicesNum;
+      bool InPlaneResampleExtentByGeometry;
+    };
+
+    struct Slice
+    {
+      vtkSmartPointer<vtkImageData> Image;
+      /** \brief Spacing of the slice as returned by ExtractSliceFilter::GetOutputSpacing() */
+      ScalarType Spacing[2];
+      /** \brief Reslice axes as returned by ExtractSliceFilter::GetResliceAxes() */
+      vtkSmartPointer<vtkMatrix4x4> ResliceAxes;
+    };
+
+    explicit ImageSliceCache(std::size_t capacity = 16);
+
+    /** \brief Returns the slice for @a key or nullptr. Clears the cache if @a imageTime differs
+      from the time of the cached slices. The returned slice stays valid until the next call
+      of Insert(), Clear() or SetCapacity(). */
+    const Slice *Find(const Key &key, unsigned long imageTime);
+
+    /** \brief Stores a copy of @a image for @a key, dropping the least recently used slice if the cache is full. */
+    void Insert(const Key &key,
+                unsigned long imageTime,
+                vtkImageData *image,
+                const ScalarType spacing[2],
+                vtkMatrix4x4 *resliceAxes);
+
+    /** \brief Stores @a slice for @a key without copying it.
+      The image and the reslice axes of @a slice must not be modified anymore. */
+    void Insert(const Key &key, unsigned long imageTime, const Slice &slice);
+
+    /** \brief True if a slice for @a key is cached. Unlike Find(), this does not count as use of the slice. */
+    bool Contains(const Key &key, unsigned long imageTime) const;
+
+    void Clear();
+
+    /** \brief Maximum number of cached slices (0: caching is disabled). */
+    void SetCapacity(std::size_t capacity);
+    std::size_t GetCapacity() const { return m_Capacity; }
+
+    std::size_t GetSize() const { return m_Entries.size(); }
+
+    /** \brief Bytes held by the cached slices. */
+    std::size_t GetMemorySize() const;
+
+  private:
+    struct Entry
+    {
+      Key m_Key;
+      std::size_t m_Hash;
+      Slice m_Slice;
+    };
+
+    void CheckImageTime(unsigned long imageTime);
+
+    /** \brief Most recently used entry first */
+    std::list<Entry> m_Entries;
+    std::size_t m_Capacity;
+    unsigned long m_ImageTime;
+  };
+}
+
+#endif // MITKIMAGESLICECACHE_H
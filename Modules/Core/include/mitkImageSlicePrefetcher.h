@@ -0,0 +1,127 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITKIMAGESLICEPREFETCHER_H
+#define MITKIMAGESLICEPREFETCHER_H
+
+#include <MitkCoreExports.h>
+#include <mitkExtractSliceFilter.h>
+#include <mitkImage.h>
+#include <mitkImageSliceCache.h>
+#include <mitkPlaneGeometry.h>
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mitk
+{
+  /**
+    \brief Reslices slices of an image on a worker thread in advance, to be moved into an ImageSliceCache.
+
+    ImageVtkMapper2D uses this class to prefetch the slices following the current one in the
+    scroll direction. Prefetch() replaces all requests which are still pending, TransferSlices()
+    moves the finished slices into the cache. Both must be called from the same (GUI) thread.
+
+    The worker reslices a private image which references the memory of the requested volume, so
+    that the pipeline of the original image is never touched from the worker thread. Writers of
+    the image are blocked by a read accessor while a slice is resliced. Slices of a modified image
+    are discarded by TransferSlices().
+
+    Only 2D slices without thick slice projection are supported.
+    */
+  class MITKCORE_EXPORT ImageSlicePrefetcher
+  {
+  public:
+    struct Request
+    {
+      ImageSliceCache::Key Key;
+      PlaneGeometry::ConstPointer Geometry;
+    };
+
+    ImageSlicePrefetcher();
+    /** \brief Drops pending requests and waits for the slice being resliced. */
+    ~ImageSlicePrefetcher();
+
+    /** \brief Reslices the planes of @a requests of time step @a t of @a image in the given order.
+      Pending requests of former calls are dropped. Does nothing if @a requests is empty.
+      \param imageTime modification time of the image, passed to ImageSliceCache */
+    void Prefetch(const Image *image,
+                  TimeStepType t,
+                  unsigned long imageTime,
+                  ExtractSliceFilter::ResliceInterpolation interpolation,
+                  bool inPlaneResampleExtentByGeometry,
+                  const std::vector<Request> &requests);
+
+    /** \brief Drops all pending requests. */
+    void Cancel();
+
+    /** \brief Inserts the slices resliced since the last call into @a cache, unless the image was modified. */
+    void TransferSlices(ImageSliceCache &cache, unsigned long imageTime);
+
+    /** \brief True if requests are pending or a slice is being resliced. */
+    bool IsBusy();
+
+  private:
+    ImageSlicePrefetcher(const ImageSlicePrefetcher &) = delete;
+    ImageSlicePrefetcher &operator=(const ImageSlicePrefetcher &) = delete;
+
+    /** \brief Parameters shared by the requests of one Prefetch() call */
+    struct Batch
+    {
+      Image::ConstPointer m_Image;
+      ImageDataItem::Pointer m_Volume;
+      /** \brief Copy of the image geometry, it must not change while the worker uses it */
+      BaseGeometry::Pointer m_Geometry;
+      unsigned long m_ImageTime;
+      ExtractSliceFilter::ResliceInterpolation m_Interpolation;
+      bool m_InPlaneResampleExtentByGeometry;
+    };
+
+    struct Job
+    {
+      std::shared_ptr<Batch> m_Batch;
+      ImageSliceCache::Key m_Key;
+      PlaneGeometry::Pointer m_Geometry;
+      /** \brief Copy of the reference geometry of m_Geometry, which only stores a raw pointer */
+      BaseGeometry::Pointer m_ReferenceGeometry;
+    };
+
+    struct Result
+    {
+      ImageSliceCache::Key m_Key;
+      unsigned long m_ImageTime;
+      ImageSliceCache::Slice m_Slice;
+    };
+
+    void Run();
+
+    /** \brief Reslices the plane of @a job, false on failure */
+    static bool Reslice(const Job &job, Image *proxy, ImageSliceCache::Slice &slice);
+
+    /** \brief Creates the private image referencing the volume of @a batch, nullptr on failure */
+    static Image::Pointer CreateProxy(const Batch &batch);
+
+    std::thread m_Thread;
+    std::mutex m_Mutex;
+    std::condition_variable m_Condition;
+    std::deque<Job> m_Jobs;
+    std::vector<Result> m_Results;
+    bool m_Running;
+    bool m_Stop;
+  };
+}
+
+#endif // MITKIMAGESLICEPREFETCHER_H
@@ -14,14 +14,24 @@ found in the LICENSE file.
 
 #include "mitkImage.h"
 #include "mitkImageTimeSelector.h"
+#include "mitkMemoryAccounting.h"
 #include <MitkCoreExports.h>
 
 #ifndef __itkHistogram_h
 #include <itkHistogram.h>
 #endif
 
+#include <memory>
+#include <mutex>
+
 namespace mitk
 {
+  /**
+    @brief Invoked by an image when the statistics requested by
+    ImageStatisticsHolder::ComputeImageStatisticsAsync() are available.
+    */
+  itkEventMacro(ImageStatisticsComputedEvent, itk::AnyEvent);
+
   /**
     @brief Class holding the statistics informations about a single mitk::Image
 
@@ -32,8 +42,12 @@ namespace mitk
     GetStatistics() method in mitk::Image class.
 
     Minimum or maximum might by infinite values. 2nd minimum and maximum are guaranteed to be finite values.
+
+    The Get*() methods compute the statistics of a time step on first access, which blocks the
+    caller. Interactive code can use ComputeImageStatisticsAsync() instead, which returns an
+    estimate immediately and computes the exact values in a background thread.
     */
-  class MITKCORE_EXPORT ImageStatisticsHolder
+  class MITKCORE_EXPORT ImageStatisticsHolder : public MemoryAccounting::Cache
   {
   public:
     /** Constructor */
@@ -46,6 +60,13 @@ namespace mitk
 
     virtual const HistogramType *GetScalarHistogram(int t = 0, unsigned int = 0);
 
+    /** Bytes held by the histogram, accounted as MemoryAccounting::StatisticsHistogramType. */
+    std::size_t GetCacheSize() const override;
+
+    /** Releases the reference to the image volume the histogram was computed from, so that the image
+      can release it (see Image::Hibernate). Histograms returned by GetScalarHistogram() stay valid. */
+    void ReleaseCache() override;
+
     //##Documentation
     //## \brief Get the minimum for scalar images. Recomputation performed only when necessary.
     virtual ScalarType GetScalarValueMin(int t = 0, unsigned int component = 0);
@@ -135,6 +156,51 @@ namespace mitk
         return 0;
     }
 
+    /**
+      @brief Statistics of a time step as returned by ComputeImageStatisticsAsync().
+
+      If IsExact is false, the values were computed from a regular subsample of the voxels:
+      the extrema might be missing some voxels and the counts are extrapolated.
+      */
+    struct StatisticsEstimate
+    {
+      ScalarType Min;
+      ScalarType Max;
+      ScalarType SecondMin;
+      ScalarType SecondMax;
+      ScalarType CountOfMinValuedVoxels;
+      ScalarType CountOfMaxValuedVoxels;
+      bool IsExact;
+    };
+
+    /**
+      @brief Returns the statistics of time step @a t without blocking on their computation.
+
+      If the exact statistics are available, they are returned. Otherwise they are computed in
+      a background thread and an estimate from a subsample of the voxels is returned. When the
+      exact values are available, the image invokes an ImageStatisticsComputedEvent. If a GUI
+      toolkit is registered with mitk::CallbackFromGUIThread, the event is invoked from the GUI
+      thread as soon as the computation is finished. Otherwise, and also if the statistics are
+      accessed before, it is invoked by the next call which accesses the statistics of the
+      image, e.g. WaitForImageStatistics().
+
+      Only one time step is computed in the background at a time; a request for another time step
+      cancels the running computation. Images which are not scalar are computed synchronously.
+      */
+    StatisticsEstimate ComputeImageStatisticsAsync(int t = 0, unsigned int component = 0);
+
+    /** @brief True if the exact statistics of time step @a t are available without computation. */
+    bool IsImageStatisticsAvailable(int t = 0) const;
+
+    /** @brief True while a computation started by ComputeImageStatisticsAsync() runs. */
+    bool IsImageStatisticsComputationRunning() const;
+
+    /** @brief Cancels a computation started by ComputeImageStatisticsAsync() and waits for the thread to end. */
+    void CancelImageStatisticsComputation();
+
+    /** @brief Waits for a computation started by ComputeImageStatisticsAsync() and makes its result available. */
+    void WaitForImageStatistics();
+
     bool IsValidTimeStep(int t) const;
 
     template <typename ItkImageType>
@@ -160,6 +226,7 @@ namespace mitk
     mitk::Image *m_Image;
 
     mutable itk::Object::Pointer m_HistogramGeneratorObject;
+    mutable std::mutex m_HistogramMutex;
 
     mutable itk::Object::Pointer m_TimeSelectorForExtremaObject;
     mutable std::vector<unsigned int> m_CountOfMinValuedVoxels;
@@ -170,6 +237,16 @@ namespace mitk
     mutable std::vector<ScalarType> m_Scalar2ndMax;
 
     itk::TimeStamp m_LastRecomputeTimeStamp;
+
+  private:
+    struct AsyncComputation;
+
+    /** Takes over the result of a finished background computation and invokes the ImageStatisticsComputedEvent;
+      waits for the computation if @a wait is true. Returns false if there was no valid result. */
+    bool AdoptAsyncComputation(bool wait);
+
+    /** Shared with the worker thread and pending GUI thread callbacks */
+    std::shared_ptr<AsyncComputation> m_AsyncComputation;
   };
 
 } // end namespace
@@ -108,8 +108,11 @@ namespace mitk
    * @brief Convert a MITK image to an ITK image.
    *
    * This method creates a itk::Image representation for the given MITK
-   * image, referencing the MITK image memory. If the provided template
-   * arguments do not match the type of the MITK image, an exception is thrown.
+   * image, referencing the MITK image memory. The pixel buffer is never
+   * copied: if the provided template arguments do not match the type of the
+   * MITK image, an exception is thrown instead of converting the data (use
+   * CastToItkImage for converting copies). Pixel types without a MITK pixel
+   * type representation are rejected at compile time.
    *
    * The MITK image is locked for read/write access as long as the returned
    * itk::Image object exists. See ImageToItkImage(const mitk::Image*) for
@@ -131,6 +134,8 @@ namespace mitk
   template <typename TPixel, unsigned int VDimension>
   typename ImageTypeTrait<TPixel, VDimension>::ImageType::Pointer ImageToItkImage(mitk::Image *mitkImage)
   {
+    static_assert(MapPixelType<TPixel, isPrimitiveType<TPixel>::value>::IOPixelType != itk::ImageIOBase::UNKNOWNPIXELTYPE,
+                  "ImageToItkImage: pixel type has no MITK pixel type representation");
     typedef typename ImageTypeTrait<TPixel, VDimension>::ImageType ImageType;
     typedef mitk::ImageToItk<ImageType> ImageToItkType;
     itk::SmartPointer<ImageToItkType> imagetoitk = ImageToItkType::New();
@@ -143,8 +148,11 @@ namespace mitk
    * @brief Convert a MITK image to an ITK image.
    *
    * This method creates a itk::Image representation for the given MITK
-   * image, referencing the MITK image memory. If the provided template
-   * arguments do not match the type of the MITK image, an exception is thrown.
+   * image, referencing the MITK image memory. The pixel buffer is never
+   * copied: if the provided template arguments do not match the type of the
+   * MITK image, an exception is thrown instead of converting the data (use
+   * CastToItkImage for converting copies). Pixel types without a MITK pixel
+   * type representation are rejected at compile time.
    *
    * The MITK image is locked for read access as long as the returned
    * itk::Image object exists. See ImageToItkImage(mitk::Image*) for
@@ -166,6 +174,8 @@ namespace mitk
   template <typename TPixel, unsigned int VDimension>
   typename ImageTypeTrait<TPixel, VDimension>::ImageType::ConstPointer ImageToItkImage(const mitk::Image *mitkImage)
   {
+    static_assert(MapPixelType<TPixel, isPrimitiveType<TPixel>::value>::IOPixelType != itk::ImageIOBase::UNKNOWNPIXELTYPE,
+                  "ImageToItkImage: pixel type has no MITK pixel type representation");
     typedef typename ImageTypeTrait<TPixel, VDimension>::ImageType ImageType;
     typedef mitk::ImageToItk<ImageType> ImageToItkType;
     itk::SmartPointer<ImageToItkType> imagetoitk = ImageToItkType::New();
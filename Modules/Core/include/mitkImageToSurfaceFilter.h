@@ -23,6 +23,7 @@ found in the LICENSE file.
 #include <vtkImageData.h>
 
 #include <vtkMarchingCubes.h>
+#include <vtkSmartPointer.h>
 #include <vtkSmoothPolyDataFilter.h>
 
 namespace mitk
@@ -210,6 +211,13 @@ namespace mitk
      */
     void CreateSurface(int time, vtkImageData *vtkimage, mitk::Surface *surface, const ScalarType threshold);
 
+    /**
+     * Runs vtkMarchingCubes in index coordinates (origin (0, 0, 0), spacing of the image). Only the bounding
+     * box of the voxels above the threshold is contoured, split into slabs that are processed in parallel by
+     * the mitk::ThreadPool. The result equals contouring the whole image at once.
+     */
+    vtkSmartPointer<vtkPolyData> CreateIsoSurface(vtkImageData *vtkimage, const ScalarType threshold);
+
     /**
     * Flag whether the created surface shall be smoothed or not (default is "false"). SetSmooth (bool _arg)
     * */
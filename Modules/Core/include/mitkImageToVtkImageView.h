@@ -0,0 +1,51 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITKIMAGETOVTKIMAGEVIEW_H
+#define MITKIMAGETOVTKIMAGEVIEW_H
+
+#include <MitkCoreExports.h>
+
+#include <vtkImageData.h>
+#include <vtkSmartPointer.h>
+
+namespace mitk
+{
+  class Image;
+
+  /**
+   * @brief Create a vtkImageData view of a single volume of a MITK image.
+   *
+   * The returned vtkImageData references the memory of the requested volume;
+   * no pixel data is copied. In contrast to Image::GetVtkImageData(), the view
+   * shares ownership of the volume: it holds a read access to the MITK image
+   * and keeps the image and the volume alive as long as the vtkImageData exists,
+   * so the view stays valid even if all other references to the image are gone.
+   *
+   * The MITK image is locked for read access as long as the returned
+   * vtkImageData object exists.
+   *
+   * @param image The MITK image whose volume is to be viewed
+   * @param t The time step of the volume
+   * @param n The channel of the volume
+   * @return A vtkImageData view of the requested volume
+   * @throws mitk::Exception if the image is null or has no data for the
+   *         requested volume, or if the image is already locked for write access.
+   *
+   * @sa ImageToItkImage
+   *
+   * @ingroup Adaptor
+   */
+  MITKCORE_EXPORT vtkSmartPointer<vtkImageData> ImageToVtkImageView(const Image *image, int t = 0, int n = 0);
+}
+
+#endif // MITKIMAGETOVTKIMAGEVIEW_H
@@ -0,0 +1,58 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkImageVolumeProvider_h
+#define mitkImageVolumeProvider_h
+
+#include <MitkCoreExports.h>
+#include <mitkCommon.h>
+#include <itkObject.h>
+
+namespace mitk
+{
+  class Image;
+
+  /**
+  * @brief Base class for objects that produce the volumes of an mitk::Image on demand.
+  *
+  * If a provider is set to an image (see Image::SetVolumeProvider), a volume that is requested
+  * via Image::GetVolumeData but has not been set yet is allocated by the image and filled by
+  * ProvideVolume. Readers, decoders or generators can use this to materialize only those time
+  * steps that are actually accessed. Together with Image::SetProvidedVolumesMemoryBudget, volumes
+  * that have not been accessed for the longest time are released again and re-provided on the
+  * next access.
+  *
+  * @warning ProvideVolume is called while the data arrays of the image are locked. Implementations
+  * must therefore not access the data of the image (GetVolumeData, accessors, ...) themselves.
+  * @ingroup Data
+  */
+  class MITKCORE_EXPORT ImageVolumeProvider : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(ImageVolumeProvider, itk::Object);
+
+    /**
+    * @brief Fills @a buffer with the volume at time step @a t of channel @a n of @a image.
+    *
+    * The buffer is allocated by the image and has the size of one volume
+    * (number of voxels of one time step times the size of the pixel type of channel @a n).
+    * @return false, if the volume could not be provided. The volume is then reported as not set.
+    */
+    virtual bool ProvideVolume(const Image *image, int t, int n, void *buffer) = 0;
+
+  protected:
+    ImageVolumeProvider();
+    ~ImageVolumeProvider() override;
+  };
+}
+
+#endif
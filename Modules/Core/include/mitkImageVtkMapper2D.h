@@ -19,6 +19,9 @@ found in the LICENSE file.
 // MITK Rendering
 #include "mitkBaseRenderer.h"
 #include "mitkExtractSliceFilter.h"
+#include "mitkImageSliceCache.h"
+#include "mitkImageSlicePrefetcher.h"
+#include "mitkMemoryAccounting.h"
 #include "mitkVtkMapper.h"
 
 // VTK
@@ -38,6 +41,7 @@ class vtkMitkThickSlicesFilter;
 class vtkPolyData;
 class vtkMitkApplyLevelWindowToRGBFilter;
 class vtkMitkLevelWindowFilter;
+class vtkMitkLevelWindowShaderMapper;
 
 namespace mitk
 {
@@ -63,6 +67,17 @@ namespace mitk
    * texture are assigned to the actor (m_Actor) which is passed to the VTK rendering
    * pipeline via the method GetVtkProp().
    *
+   * If the RenderingManager property "shader-level-window-rendering" is enabled, single
+   * component slices with a linear lookup table are rendered by a vtkMitkLevelWindowShaderMapper
+   * (m_ShaderMapper) instead: the raw slice is uploaded as texture and the level window, lookup
+   * table and binary outline are applied in the fragment shader. Changes of the level window,
+   * lookup table, color or opacity then only update the shader parameters.
+   *
+   * Resliced slices are kept in a cache (m_SliceCache), so that returning to a slice does not
+   * reslice the image again. If the RenderingManager property "slice-prefetching" is set to a
+   * number of slices, the slices following the current one in the scroll direction are resliced
+   * on a worker thread in advance (m_SlicePrefetcher).
+   *
    * In order to transform the textured plane to the correct position in space, the
    * same transformation as used for reslicing is applied to both the camera and the
    * vtkActor. All important steps are explained in more detail below. The resulting
@@ -113,7 +128,7 @@ namespace mitk
 
    * \ingroup Mapper
    */
-  class MITKCORE_EXPORT ImageVtkMapper2D : public VtkMapper
+  class MITKCORE_EXPORT ImageVtkMapper2D : public VtkMapper, public MemoryAccounting::Cache
   {
   public:
     /** Standard class typedefs. */
@@ -150,6 +165,8 @@ namespace mitk
       vtkSmartPointer<vtkPropAssembly> m_Actors;
       /** \brief Mapper of a 2D render window. */
       vtkSmartPointer<vtkPolyDataMapper> m_Mapper;
+      /** \brief Mapper applying the level window on the GPU, used instead of m_Mapper if enabled. */
+      vtkSmartPointer<vtkMitkLevelWindowShaderMapper> m_ShaderMapper;
       vtkSmartPointer<vtkImageExtractComponents> m_VectorComponentExtractor;
       /** \brief Current slice of a 2D render window.*/
       vtkSmartPointer<vtkImageData> m_ReslicedImage;
@@ -183,6 +200,13 @@ namespace mitk
 
       /** \brief mmPerPixel relation between pixel and mm. (World spacing).*/
       mitk::ScalarType *m_mmPerPixel;
+      /** \brief Spacing of m_ReslicedImage, m_mmPerPixel points to it. */
+      mitk::ScalarType m_SliceSpacing[2];
+      /** \brief Reslice axes of m_ReslicedImage, used to transform the actor. */
+      vtkSmartPointer<vtkMatrix4x4> m_ResliceAxes;
+      /** \brief Slice of the renderer at the last update and direction of the last slice change (1 or -1). */
+      unsigned int m_LastSlice;
+      int m_SliceStep;
 
       /** \brief This filter is used to apply the level window to Grayvalue and RBG(A) images. */
       vtkSmartPointer<vtkMitkLevelWindowFilter> m_LevelWindowFilter;
@@ -199,6 +223,18 @@ namespace mitk
     /** \brief Get the LocalStorage corresponding to the current renderer. */
     LocalStorage *GetLocalStorage(mitk::BaseRenderer *renderer);
 
+    /** \brief Set the maximum number of resliced slices kept for revisiting them without reslicing
+     * (0: disables the cache). The cache is shared by all renderers and cleared whenever the image is modified.
+     */
+    void SetSliceCacheCapacity(std::size_t capacity);
+    std::size_t GetSliceCacheCapacity() const;
+
+    /** \brief Bytes held by the slice cache, accounted as MemoryAccounting::ResliceCacheType. */
+    std::size_t GetCacheSize() const override;
+
+    /** \brief Clears the slice cache. */
+    void ReleaseCache() override;
+
     /** \brief Set the default properties for general image rendering. */
     static void SetDefaultProperties(mitk::DataNode *node, mitk::BaseRenderer *renderer = nullptr, bool overwrite = false);
 
@@ -289,6 +325,12 @@ namespace mitk
     /** \brief Set the opacity of the actor. */
     void ApplyOpacity(mitk::BaseRenderer *renderer);
 
+    /** \brief Updates color, opacity, lookup table and level window of a slice rendered by m_ShaderMapper
+     * without reslicing, if only such properties were modified since the last update.
+     * \return false if GenerateDataForRenderer() is required
+     */
+    bool UpdateShaderLevelWindow(mitk::BaseRenderer *renderer);
+
     /**
       * \brief Calculates whether the given rendering geometry intersects the
       * given SlicedGeometry3D.
@@ -300,6 +342,19 @@ namespace mitk
       * If the distances have different sign, there is an intersection.
       **/
     bool RenderingGeometryIntersectsImage(const PlaneGeometry *renderingGeometry, SlicedGeometry3D *imageGeometry);
+
+    /** \brief Schedules the next slices in the scroll direction of @a renderer for reslicing
+     * in the background, if enabled by the RenderingManager property "slice-prefetching".
+     * \param key cache key of the current slice
+     */
+    void PrefetchNeighboringSlices(mitk::BaseRenderer *renderer,
+                                   const ImageSliceCache::Key &key,
+                                   unsigned long imageTime);
+
+    /** \brief Resliced slices of the input image, looked up before reslicing in GenerateDataForRenderer(). */
+    ImageSliceCache m_SliceCache;
+    /** \brief Fills m_SliceCache with the slices following the current one, see PrefetchNeighboringSlices(). */
+    ImageSlicePrefetcher m_SlicePrefetcher;
   };
 
 } // namespace mitk
@@ -53,6 +53,7 @@ namespace mitk
     static const std::string xmlEventPropertyRendererName();     // = "RendererName";
     static const std::string xmlEventPropertyViewDirection();    // = "ViewDirection";
     static const std::string xmlEventPropertyMapperID();         // = "MapperID";
+    static const std::string xmlEventPropertyTimestamp();        // = "Timestamp";
 
     static const std::string xmlRenderSizeX(); // = "RenderSizeX";
     static const std::string xmlRenderSizeY(); // = "RenderSizeY";
@@ -26,6 +26,10 @@ namespace mitk
    * Instantiating this class with a given itk::ImageIOBase instance
    * will register corresponding MITK reader/writer services for that
    * ITK ImageIO object.
+   *
+   * NRRD (.nrrd) and NIfTI (.nii.gz) files are compressed on several threads. The writer option
+   * "Compression threads" sets the number of threads, 0 uses one thread per hardware thread and 1 uses
+   * the single-threaded compression of ITK. Reading is not affected, the files are standard gzip streams.
    */
   class MITKCORE_EXPORT ItkImageIO : public AbstractFileIO
   {
@@ -53,8 +57,22 @@ namespace mitk
     virtual void InitializeDefaultMetaDataKeys();
 
   private:
+    enum class ParallelCompressionFormat
+    {
+      None,
+      Nrrd,
+      Nifti
+    };
+
     ItkImageIO(const ItkImageIO &other);
 
+    void InitializeDefaultWriterOptions();
+    ParallelCompressionFormat GetParallelCompressionFormat(const std::string &path) const;
+    unsigned int GetNumberOfCompressionThreads() const;
+    void CompressFile(const std::string &uncompressedFile,
+                      const std::string &path,
+                      ParallelCompressionFormat format) const;
+
     ItkImageIO *IOClone() const override;
 
     itk::ImageIOBase::Pointer m_ImageIO;
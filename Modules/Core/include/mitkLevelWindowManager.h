@@ -20,6 +20,8 @@ found in the LICENSE file.
 
 //  c++
 #include <map>
+#include <set>
+#include <string>
 #include <utility>
 
 namespace mitk
@@ -44,6 +46,10 @@ namespace mitk
     the new image becomes active or not. If an image is removed from the DataStorage and m_AutoTopMost is false,
     there is a check to proof, if the active image is still available. If not, then m_AutoTopMost becomes true.
 
+    The relevant nodes (see GetRelevantNodes()) are kept in an index ordered by their "layer" property, which is
+    updated for the node whose property changed. Visibility and layer changes therefore neither search the
+    DataStorage nor re-register the property observers of all nodes.
+
     Note that this class is not thread safe at the moment!
   */
   class MITKCORE_EXPORT LevelWindowManager : public itk::Object
@@ -125,15 +131,12 @@ namespace mitk
     bool IsSelectedImages();
     /** @brief This method is called when a node is added to the data storage.
      *         A listener on the data storage is used to call this method automatically after a node was added.
-     *  @throw mitk::Exception Throws an exception if something is wrong, e.g. if the number of observers differs from
-     *         the number of nodes.
+     *  @throw mitk::Exception Throws an exception if the data storage is not set.
      */
     void DataStorageAddedNode(const DataNode *n = nullptr);
     /** @brief This method is called when a node is removed to the data storage.
      *         A listener on the data storage is used to call this method automatically directly before a node will be
      *         removed.
-     *  @throw mitk::Exception Throws an exception if something is wrong, e.g. if the number of observers differs from
-     *         the number of nodes.
      */
     void DataStorageRemovedNode(const DataNode *removedNode = nullptr);
     /**
@@ -147,11 +150,7 @@ namespace mitk
     */
     Image *GetCurrentImage();
     /**
-     * @return Returns the current number of observers which are registered in this object.
-     * @throw mitk::Exception Throws an exception if the number of observers differs from
-     *                        the number of relevant objects
-     *                        which means that something is wrong.
-     *
+     * @return Returns the number of relevant nodes whose properties are observed by this object.
      */
     int GetNumberOfObservers();
 
@@ -171,28 +170,58 @@ namespace mitk
     /// Pointer to the LevelWindowProperty of the current image.
     LevelWindowProperty::Pointer m_LevelWindowProperty;
 
-    typedef std::pair<unsigned long, DataNode::Pointer> PropDataPair;
-    typedef std::map<PropDataPair, BaseProperty::Pointer> ObserverToPropertyValueMap;
-    /// Map to hold observer IDs to every "visible" property of DataNode's BaseProperty.
-    ObserverToPropertyValueMap m_ObserverToVisibleProperty;
-    /// Map to hold observer IDs to every "layer" property of DataNode's BaseProperty.
-    ObserverToPropertyValueMap m_ObserverToLayerProperty;
-    /// Map to hold observer IDs to every "Image Rendering.Mode" property of DataNode's BaseProperty.
-    ObserverToPropertyValueMap m_ObserverToRenderingModeProperty;
-    /// Map to hold observer IDs to every "Image.Displayed Component" property of DataNode's BaseProperty.
-    ObserverToPropertyValueMap m_ObserverToDisplayedComponentProperty;
-    /// Map to hold observer IDs to every "imageForLevelWindow" property of DataNode's BaseProperty.
-    ObserverToPropertyValueMap m_ObserverToLevelWindowImageProperty;
-    /// Map to hold observer IDs to every "selected" property of DataNode's BaseProperty.
-    ObserverToPropertyValueMap m_ObserverToSelectedProperty;
-
-    /// Updates the internal observer list.
+    /// Observed state of a relevant node.
+    struct IndexedNode
+    {
+      DataNode::Pointer Node;
+      /// Observed properties and their observer tags by property key
+      std::map<std::string, std::pair<BaseProperty::Pointer, unsigned long>> Observers;
+      /// Order in which the nodes were indexed, breaks ties between nodes in the same layer.
+      unsigned long Sequence = 0;
+      int Layer = -1;
+      bool Visible = false;
+      /// True if IgnoreNode() returns true for the node
+      bool Ignored = false;
+      bool ImageForLevelWindow = false;
+    };
+    typedef std::pair<int, unsigned long> LayerKey;
+
+    /// Relevant nodes of the data storage.
+    std::map<const DataNode *, IndexedNode> m_IndexedNodes;
+    /// Visible relevant nodes ordered by layer, the top-most node is the last one.
+    std::map<LayerKey, const DataNode *> m_VisibleNodesByLayer;
+    /// Relevant nodes whose "imageForLevelWindow" property is true.
+    std::set<const DataNode *> m_NodesForLevelWindow;
+    /// Relevant nodes by their observed properties.
+    std::multimap<const itk::Object *, const DataNode *> m_NodesByObservedProperty;
+    unsigned long m_NextSequence;
+
+    /// Adds the relevant nodes to the index and removes the nodes which are no longer relevant.
     /// Ignores nodes which are marked to be deleted in the variable m_NodeMarkedToDelete.
-    void UpdateObservers();
-    /// Internal help method to clear both lists/maps.
-    void ClearPropObserverLists();
-    /// Internal help method to create both lists/maps.
-    void CreatePropObserverLists();
+    void UpdateIndex();
+    /// Removes all nodes from the index and their property observers.
+    void ClearIndex();
+    /// Adds the node to the index or updates its observers and state if it is already indexed.
+    void IndexNode(DataNode *node);
+    void RemoveNodeFromIndex(const DataNode *node);
+    /// Observes the property of the node with the key, if it exists and is not observed yet.
+    void ObserveProperty(IndexedNode &indexedNode,
+                         const std::string &propertyKey,
+                         void (LevelWindowManager::*callback)(itk::Object *, const itk::EventObject &));
+    void RemovePropertyObserver(const DataNode *node, const std::pair<BaseProperty::Pointer, unsigned long> &observer);
+    /// Reads the layer, visibility and level window state of the indexed node from its properties.
+    void UpdateIndexedNode(IndexedNode &indexedNode);
+
+    void OnIndexedPropertyModified(itk::Object *caller, const itk::EventObject &e);
+    void OnSelectedPropertyModified(itk::Object *caller, const itk::EventObject &e);
+    void OnDisplayedComponentPropertyModified(itk::Object *caller, const itk::EventObject &e);
+
+    /// Returns the visible node in the highest layer, which is not the excluded node.
+    DataNode *GetTopMostNode(bool skipIgnoredNodes, const DataNode *excludedNode = nullptr) const;
+    /// Sets the "imageForLevelWindow" property of all nodes except the given one to false.
+    void ResetImageForLevelWindow(const DataNode *exceptNode);
+    /// Makes the level window property of the given node the current one.
+    void ActivateLevelWindowProperty(LevelWindowProperty *levelWindowProperty, DataNode *propNode);
 
     bool IgnoreNode(const DataNode* dataNode);
 
@@ -209,6 +238,9 @@ namespace mitk
     std::vector<DataNode::Pointer> m_RelevantDataNodes;
     bool m_IsPropertyModifiedTagSet;
     bool m_LevelWindowMutex;
+    /// True if the "imageForLevelWindow" property may be set for nodes which are not indexed,
+    /// e.g. for a node activated by SetLevelWindowProperty() which is not relevant.
+    bool m_ResetAllNodes;
   };
 }
 
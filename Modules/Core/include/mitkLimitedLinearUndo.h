@@ -100,6 +100,36 @@ namespace mitk
     //## @param limit the maximum number of items on the stack
     void SetUndoLimit(std::size_t limit) override;
 
+    //##Documentation
+    //## @brief Gets the limit on the memory of the undo history in bytes.
+    //## If the value is 0 that means that there is no limit.
+    std::size_t GetMemoryLimit() const;
+
+    //##Documentation
+    //## @brief Sets a limit on the memory of the undo history in bytes.
+    //## If the memory held by the undo and redo stack exceeds the limit,
+    //## the oldest undo items will be dropped from the bottom of the undo stack.
+    //## The most recent item is always kept. The 0 value means that there is no limit.
+    //## @param limit the maximum number of bytes held by the operations on the stacks
+    void SetMemoryLimit(std::size_t limit);
+
+    //##Documentation
+    //## @brief Returns the memory in bytes held by the operations on the undo and redo stack
+    //## (see Operation::GetMemorySize()).
+    std::size_t GetMemorySize() const;
+
+    //##Documentation
+    //## @brief Returns the number of undo items dropped because of the undo or memory limit.
+    std::size_t GetNumberOfEvictedItems() const;
+
+    //##Documentation
+    //## @brief Returns the memory in bytes of the undo items dropped because of the undo or memory limit.
+    std::size_t GetEvictedMemorySize() const;
+
+    //##Documentation
+    //## @brief Resets the eviction statistics.
+    void ResetEvictionStatistics();
+
     //##Documentation
     //## @brief Returns the ObjectEventId of the
     //## top element in the OperationHistory
@@ -128,6 +158,10 @@ namespace mitk
     //## elements in the list and to clear the list
     void ClearList(UndoContainer *list);
 
+    //## @brief Drops the oldest elements of the undo list until
+    //## the undo limit and the memory limit are met
+    void LimitUndoList();
+
     UndoContainer m_UndoList;
 
     UndoContainer m_RedoList;
@@ -137,6 +171,11 @@ namespace mitk
 
     std::size_t m_UndoLimit;
 
+    std::size_t m_MemoryLimit;
+
+    std::size_t m_NumberOfEvictedItems;
+
+    std::size_t m_EvictedMemorySize;
   };
 
 #pragma GCC visibility push(default)
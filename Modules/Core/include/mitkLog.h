@@ -29,8 +29,15 @@ namespace mitk
     void ProcessMessage(const mbilog::LogMessage &) override;
 
     /** \brief registers MITK logging backend at mbilog
+     *
+     *  If @a asynchronous is true, messages are formatted and written by a dedicated writer thread
+     *  (see mbilog::BackendAsync), so that logging does not stall the emitting threads.
+     */
+    static void Register(bool asynchronous = false);
+
+    /** \brief Blocks until all messages emitted so far are written, if the backend is asynchronous
      */
-    static void Register();
+    static void Flush();
 
     /** \brief Unregisters MITK logging backend at mbilog
      */
@@ -0,0 +1,204 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkMemoryAccounting_h
+#define mitkMemoryAccounting_h
+
+#include <MitkCoreExports.h>
+#include <mitkImageHibernationStore.h>
+#include <mitkWeakPointer.h>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace mitk
+{
+  class BaseData;
+  class DataNode;
+  class DataStorage;
+
+  /**
+   * \brief Accounts the memory held by data objects and by the caches derived from them, and keeps it within a budget.
+   *
+   * The memory of a data object is estimated from its content: the set volumes of an Image and the poly data
+   * of a Surface. Caches of derived data (resliced slices of ImageVtkMapper2D, the level of detail pyramid of
+   * SurfaceVtkMapper3D, the histogram of the ImageStatisticsHolder, ...) implement the Cache interface and
+   * register themselves together with the data object they were derived from.
+   *
+   * If a budget is set, EnforceBudget() releases caches, least recently used first, until the total memory
+   * fits. If that is not sufficient and hibernation is enabled, invisible images are hibernated (see
+   * Image::Hibernate), largest first. If the budget is still exceeded, a warning is logged and the
+   * budget exceeded callback is called, so that the application can warn the user before the system
+   * starts swapping. With SetDataStorage(), the budget is enforced whenever a node is added.
+   *
+   * Independent of the budget, images that stayed invisible and unmodified for a while can be hibernated
+   * (see SetIdleHibernationDelay and HibernateIdleImages). The store for hibernated volumes is created by
+   * the hibernation store factory, e.g. to keep them compressed in memory instead of in temporary files.
+   *
+   * Caches are released by the thread calling EnforceBudget(), which has to be the thread the caches are used
+   * by (i.e. the GUI thread for mapper caches).
+   */
+  class MITKCORE_EXPORT MemoryAccounting
+  {
+  public:
+    /** \brief Interface of caches of derived data that can be released at any time and rebuilt on demand. */
+    class MITKCORE_EXPORT Cache
+    {
+    public:
+      virtual ~Cache();
+
+      /** \brief Bytes currently held by the cache. */
+      virtual std::size_t GetCacheSize() const = 0;
+
+      /** \brief Releases all memory of the cache. */
+      virtual void ReleaseCache() = 0;
+    };
+
+    /** \name Cache types of the caches in MitkCore */
+    ///@{
+    static const std::string ResliceCacheType;
+    static const std::string SurfaceLevelOfDetailType;
+    static const std::string StatisticsHistogramType;
+    ///@}
+
+    /** \name Types of the memory held by data objects themselves */
+    ///@{
+    static const std::string ImageDataType;
+    static const std::string SurfaceDataType;
+    ///@}
+
+    struct Usage
+    {
+      /** \brief Bytes held by the data object itself, see GetDataSize() */
+      std::size_t DataSize = 0;
+      /** \brief Bytes held by caches derived from the data object */
+      std::size_t CacheSize = 0;
+
+      std::size_t GetTotal() const { return DataSize + CacheSize; }
+    };
+
+    /** \brief Creates the store for the volumes of an image to hibernate, see Image::Hibernate. */
+    using HibernationStoreFactory = std::function<ImageHibernationStore::Pointer()>;
+
+    /** \brief Called with the total usage and the budget if EnforceBudget() cannot meet the budget. */
+    using BudgetExceededCallback = std::function<void(std::size_t usage, std::size_t budget)>;
+
+    static MemoryAccounting &GetInstance();
+
+    MemoryAccounting();
+    ~MemoryAccounting();
+
+    MemoryAccounting(const MemoryAccounting &) = delete;
+    MemoryAccounting &operator=(const MemoryAccounting &) = delete;
+
+    /**
+     * \brief Registers @a cache as derived from @a owner (may be nullptr) or updates the owner of a registered cache.
+     *
+     * Registering counts as use of the cache (see TouchCache), so caches can simply register whenever they are used.
+     * The cache has to be unregistered before it is destroyed.
+     */
+    void RegisterCache(Cache *cache, const std::string &type, const BaseData *owner);
+    void UnregisterCache(Cache *cache);
+
+    /** \brief Marks @a cache as used, so that it is released after all caches that were used before. */
+    void TouchCache(Cache *cache);
+
+    /** \brief Estimated number of bytes held by @a data itself, 0 for data types that are not accounted.
+     * The main memory held by the store of a hibernated image is included. */
+    static std::size_t GetDataSize(const BaseData *data);
+
+    Usage GetUsage(const BaseData *data) const;
+    Usage GetUsage(const DataNode *node) const;
+
+    /** \brief Bytes per type, i.e. the data of all nodes of @a storage by data type and all registered caches by cache type. */
+    std::map<std::string, std::size_t> GetUsageByType(const DataStorage *storage) const;
+
+    /** \brief Bytes held by the data of all nodes of @a storage and by all registered caches. */
+    std::size_t GetTotalUsage(const DataStorage *storage) const;
+
+    /** \brief Maximum number of bytes, 0 (the default) means no budget. */
+    void SetBudget(std::size_t budget);
+    std::size_t GetBudget() const;
+
+    /** \brief Whether EnforceBudget() hibernates invisible images if releasing caches is not sufficient (default: false). */
+    void SetHibernateInvisibleImages(bool hibernate);
+    bool GetHibernateInvisibleImages() const;
+
+    void SetBudgetExceededCallback(const BudgetExceededCallback &callback);
+
+    /** \brief Sets the factory of the stores for hibernated images, nullptr restores the default (temporary files). */
+    void SetHibernationStoreFactory(const HibernationStoreFactory &factory);
+
+    /** \brief Time an image has to be invisible and unused before HibernateIdleImages() hibernates it,
+     * 0 (the default) disables idle hibernation. */
+    void SetIdleHibernationDelay(std::chrono::seconds delay);
+    std::chrono::seconds GetIdleHibernationDelay() const;
+
+    /**
+     * \brief Hibernates the images of the data storage set by SetDataStorage() which have been invisible for the
+     * idle hibernation delay and were neither modified nor restored from hibernation in the meantime.
+     *
+     * Meant to be called periodically from the GUI thread, e.g. by a timer of the application.
+     * \return The number of bytes released
+     */
+    std::size_t HibernateIdleImages();
+
+    /**
+     * \brief Releases caches and hibernates images until the usage of @a storage fits into the budget.
+     * \return The number of bytes released
+     */
+    std::size_t EnforceBudget(const DataStorage *storage);
+
+    /** \brief Enforces the budget on @a storage whenever a node is added to it. Pass nullptr to stop. */
+    void SetDataStorage(DataStorage *storage);
+
+  private:
+    struct CacheEntry
+    {
+      std::string Type;
+      const BaseData *Owner;
+      unsigned long LastUse;
+    };
+
+    struct IdleImage
+    {
+      std::chrono::steady_clock::time_point Since;
+      unsigned long MTime;
+      std::size_t DataSize;
+    };
+
+    void OnNodeAdded(const DataNode *node);
+
+    ImageHibernationStore::Pointer CreateHibernationStore() const;
+
+    mutable std::mutex m_Mutex;
+    std::map<Cache *, CacheEntry> m_Caches;
+    unsigned long m_UseCounter;
+
+    std::size_t m_Budget;
+    bool m_HibernateInvisibleImages;
+    BudgetExceededCallback m_BudgetExceededCallback;
+    HibernationStoreFactory m_HibernationStoreFactory;
+
+    std::chrono::seconds m_IdleHibernationDelay;
+    /** \brief Invisible images by the time since they are idle, only accessed by HibernateIdleImages() */
+    std::map<const BaseData *, IdleImage> m_IdleImages;
+
+    WeakPointer<DataStorage> m_DataStorage;
+  };
+}
+
+#endif
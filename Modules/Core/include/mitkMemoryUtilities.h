@@ -80,6 +80,92 @@ namespace mitk
       }
     }
 
+    /**
+     * Allocates a zero-initialized block of @a size bytes that is backed by an
+     * anonymous temporary file instead of the heap. The operating system pages
+     * the block in on first access and may write it back to the file instead of
+     * the swap space, so blocks larger than the physical RAM can be used.
+     * The temporary file is created in the directory given by the environment
+     * variable MITK_MAPPED_MEMORY_DIR (falling back to the system's temporary
+     * directory) and is removed automatically when the block is released.
+     * @param size the number of bytes to allocate
+     * @param noThrow if set to false, an itk::MemoryAllocationError is thrown if
+     *                the mapping could not be created
+     * @returns a pointer to the mapped block or nullptr if noThrow == true and the
+     *          mapping failed.
+     */
+    static void *AllocateMappedMemory(size_t size, bool noThrow = false);
+
+    /**
+     * Releases a block previously allocated by AllocateMappedMemory.
+     * @param memory the block to release. Note that nullptr is an accepted value.
+     * @param size the size that was passed to AllocateMappedMemory
+     */
+    static void DeleteMappedMemory(void *memory, size_t size);
+
+    /**
+     * Statistics of the memory handed out by AllocatePooledMemory.
+     */
+    struct PoolStatistics
+    {
+      /** Bytes of all blocks currently allocated by AllocatePooledMemory. */
+      size_t BytesInUse;
+      /** Maximum of BytesInUse since the last call of ResetPoolStatistics. */
+      size_t HighWaterMark;
+      /** Bytes of released blocks that are kept for reuse. */
+      size_t BytesCached;
+      /** Number of successful AllocatePooledMemory calls. */
+      size_t NumberOfAllocations;
+      /** Number of allocations that were served from a cached block. */
+      size_t NumberOfReuses;
+    };
+
+    /**
+     * Allocates an uninitialized block of at least @a size bytes from the image memory pool.
+     * Blocks up to GetMaximumPooledBlockSize() bytes are rounded up to the next power of two
+     * and returned to a per-size free list when released, so that frequently created and
+     * destroyed images of equal size (e.g. extracted slices) do not hit the system allocator
+     * each time. Larger blocks are allocated and released directly but are included in
+     * the statistics.
+     * @param size the number of bytes to allocate
+     * @param noThrow if set to false, an itk::MemoryAllocationError is thrown if
+     *                memory allocation fails
+     * @returns a pointer to the block or nullptr if noThrow == true and allocation failed.
+     */
+    static void *AllocatePooledMemory(size_t size, bool noThrow = false);
+
+    /**
+     * Releases a block previously allocated by AllocatePooledMemory.
+     * @param memory the block to release. Note that nullptr is an accepted value.
+     * @param size the size that was passed to AllocatePooledMemory
+     */
+    static void DeletePooledMemory(void *memory, size_t size);
+
+    /**
+     * Frees all blocks cached by the image memory pool.
+     */
+    static void ReleasePooledMemory();
+
+    /**
+     * Sets the maximum number of bytes the image memory pool keeps cached for reuse
+     * (default: 128 MiB). Released blocks exceeding the limit are freed immediately.
+     */
+    static void SetPoolCacheLimit(size_t bytes);
+    static size_t GetPoolCacheLimit();
+
+    /**
+     * Returns the size of the largest block that is cached by the image memory pool.
+     */
+    static size_t GetMaximumPooledBlockSize();
+
+    static PoolStatistics GetPoolStatistics();
+
+    /**
+     * Resets the allocation counters and sets the high-water mark to the current
+     * number of bytes in use.
+     */
+    static void ResetPoolStatistics();
+
   protected:
 #ifndef _MSC_VER
     static int ReadStatmFromProcFS(
@@ -44,6 +44,16 @@ namespace mitk
     //## @brief Checks, if the nodes contains a property that is equal to m_ValidProperty
     bool CheckNode(const mitk::DataNode *node) const override;
 
+    //##Documentation
+    //## @brief Returns the name of the checked property
+    const std::string &GetValidPropertyName() const { return m_ValidPropertyName; }
+    //##Documentation
+    //## @brief Returns the property value that is checked for, or nullptr if only the existence is checked
+    const mitk::BaseProperty *GetValidProperty() const { return m_ValidProperty; }
+    //##Documentation
+    //## @brief Returns the renderer whose renderer-specific property is checked, nullptr for the common property
+    const mitk::BaseRenderer *GetRenderer() const { return m_Renderer; }
+
   protected:
     //##Documentation
     //## @brief Constructor to check for a named property
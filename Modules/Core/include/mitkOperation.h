@@ -39,6 +39,13 @@ namespace mitk
 
     OperationType GetOperationType();
 
+    //##Documentation
+    //## @brief Returns the number of bytes of data held by the operation.
+    //##
+    //## Used by the undo models to limit their memory, see LimitedLinearUndo::SetMemoryLimit().
+    //## The default implementation returns 0, i.e. the operation is considered to be small.
+    virtual std::size_t GetMemorySize() const;
+
   protected:
     OperationType m_OperationType;
   };
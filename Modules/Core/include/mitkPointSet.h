@@ -18,6 +18,9 @@ found in the LICENSE file.
 #include <itkDefaultDynamicMeshTraits.h>
 #include <itkMesh.h>
 
+#include <memory>
+#include <mutex>
+
 namespace mitk
 {
   /**
@@ -253,6 +256,16 @@ namespace mitk
      */
     int SearchPoint(Point3D point, ScalarType distance, int t = 0) const;
 
+    /**
+     * \brief searches the point closest to the given point
+     *
+     * \param point is in world coordinates.
+     * \param distance is in mm, measured in world coordinates.
+     * returns -1 if no point is closer than distance
+     * or the identifier of the closest point
+     */
+    int SearchClosestPoint(const Point3D &point, ScalarType distance, int t = 0) const;
+
     bool IsEmptyTimeStep(unsigned int t) const override;
 
     // virtual methods, that need to be implemented
@@ -291,6 +304,24 @@ namespace mitk
     * @brief flag to indicate the right time to call SetBounds
     **/
     bool m_CalculateBoundingBox;
+
+  private:
+    /**
+    * @brief Uniform grid of the points of one time step in index coordinates, used by SearchPoint() and
+    * SearchClosestPoint() for large point sets. It is built on demand, rebuilt after unknown changes of the
+    * points container and updated incrementally by the point operations.
+    **/
+    struct SpatialIndex;
+
+    SpatialIndex *GetSpatialIndex(int t) const;
+    void UpdateSpatialIndex(int t,
+                            PointIdentifier id,
+                            const PointType *oldPoint,
+                            const PointType *newPoint,
+                            itk::ModifiedTimeType timeBeforeChange);
+
+    mutable std::vector<std::unique_ptr<SpatialIndex>> m_SpatialIndices;
+    mutable std::mutex m_SpatialIndexMutex;
   };
 
   /**
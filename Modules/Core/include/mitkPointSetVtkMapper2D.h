@@ -26,7 +26,7 @@ class vtkPropAssembly;
 class vtkPolyData;
 class vtkPolyDataMapper;
 class vtkGlyphSource2D;
-class vtkGlyph3D;
+class vtkGlyph3DMapper;
 class vtkFloatArray;
 class vtkCellArray;
 
@@ -160,9 +160,9 @@ namespace mitk
       vtkSmartPointer<vtkGlyphSource2D> m_UnselectedGlyphSource2D;
       vtkSmartPointer<vtkGlyphSource2D> m_SelectedGlyphSource2D;
 
-      // glyph
-      vtkSmartPointer<vtkGlyph3D> m_UnselectedGlyph3D;
-      vtkSmartPointer<vtkGlyph3D> m_SelectedGlyph3D;
+      // glyph mappers, rendering the glyphs instanced on the GPU
+      vtkSmartPointer<vtkGlyph3DMapper> m_UnselectedGlyphMapper;
+      vtkSmartPointer<vtkGlyph3DMapper> m_SelectedGlyphMapper;
 
       // polydata
       vtkSmartPointer<vtkPolyData> m_VtkUnselectedPointListPolyData;
@@ -180,8 +180,6 @@ namespace mitk
       std::vector<vtkSmartPointer<vtkTextActor>> m_VtkTextAngleActors;
 
       // mappers
-      vtkSmartPointer<vtkPolyDataMapper> m_VtkUnselectedPolyDataMapper;
-      vtkSmartPointer<vtkPolyDataMapper> m_VtkSelectedPolyDataMapper;
       vtkSmartPointer<vtkPolyDataMapper> m_VtkContourPolyDataMapper;
 
       // propassembly
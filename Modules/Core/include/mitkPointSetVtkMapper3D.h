@@ -18,11 +18,18 @@ found in the LICENSE file.
 #include <MitkCoreExports.h>
 #include <vtkSmartPointer.h>
 
+#include <vector>
+
 class vtkActor;
 class vtkCellArray;
+class vtkConeSource;
+class vtkCubeSource;
+class vtkCylinderSource;
+class vtkGlyph3DMapper;
 class vtkPropAssembly;
 class vtkAppendPolyData;
 class vtkPolyData;
+class vtkSphereSource;
 class vtkTubeFilter;
 class vtkPolyDataMapper;
 class vtkTransformPolyDataFilter;
@@ -50,6 +57,12 @@ namespace mitk
   * Then the three Actors are combined inside a vtkPropAssembly and this
   * object is returned in GetProp() and so hooked up into the rendering
   * pipeline.
+  *
+  * The glyphs marking the points (sphere, cube, cone or cylinder depending on
+  * the point type) are not built per point, they are instanced on the GPU by
+  * a vtkGlyph3DMapper for the selected and one for the unselected points.
+  * If points were only appended to the point set since the last update, just
+  * the glyphs of the new points are added. Labels are still built per point.
 
   * Properties that can be set for point sets and influence the PointSetVTKMapper3D are:
   *
@@ -125,6 +138,12 @@ namespace mitk
     virtual void CreateContour(vtkPoints *points, vtkCellArray *connections);
     virtual void CreateVTKRenderObjects();
 
+    /// Fills the glyph points from m_WorldPositions. Only the glyphs of appended points are added
+    /// if the points and @a glyphStates of the last call are unchanged.
+    void UpdateGlyphs(vtkPoints *lastWorldPositions, const std::vector<unsigned char> &glyphStates);
+    /// Sets the size and resolution of the glyph sources
+    void UpdateGlyphSources(bool isInputDevice);
+
     /// All point positions, already in world coordinates
     vtkSmartPointer<vtkPoints> m_WorldPositions;
     /// All connections between two points (used for contour drawing)
@@ -145,6 +164,22 @@ namespace mitk
     vtkSmartPointer<vtkActor> m_UnselectedActor;
     vtkSmartPointer<vtkActor> m_ContourActor;
 
+    /// Sources of the instanced glyphs, indexed by the "glyph type" array of the glyph points
+    vtkSmartPointer<vtkSphereSource> m_SphereGlyphSource;
+    vtkSmartPointer<vtkCubeSource> m_CubeGlyphSource;
+    vtkSmartPointer<vtkConeSource> m_ConeGlyphSource;
+    vtkSmartPointer<vtkCylinderSource> m_CylinderGlyphSource;
+
+    vtkSmartPointer<vtkPolyData> m_SelectedGlyphPoints;
+    vtkSmartPointer<vtkPolyData> m_UnselectedGlyphPoints;
+    vtkSmartPointer<vtkGlyph3DMapper> m_SelectedGlyphMapper;
+    vtkSmartPointer<vtkGlyph3DMapper> m_UnselectedGlyphMapper;
+    vtkSmartPointer<vtkActor> m_SelectedGlyphActor;
+    vtkSmartPointer<vtkActor> m_UnselectedGlyphActor;
+
+    /// Glyph type and selection of the points of the last update, see UpdateGlyphs()
+    std::vector<unsigned char> m_GlyphStates;
+
     vtkSmartPointer<vtkPropAssembly> m_PointsAssembly;
 
     // help for contour between points
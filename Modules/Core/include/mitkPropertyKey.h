@@ -0,0 +1,61 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkPropertyKey_h
+#define mitkPropertyKey_h
+
+#include <MitkCoreExports.h>
+
+#include <string>
+
+namespace mitk
+{
+  /**
+   * @brief Interned key of a property.
+   *
+   * Each distinct key string is registered once in a global table and is identified by an integer afterwards.
+   * PropertyList and DataNode offer lookups by PropertyKey which compare these integers instead of strings and do
+   * not create temporary strings. The key of a frequent lookup should therefore only be created once, e.g. as a
+   * function-local static variable:
+   *
+   * \code
+   * static const mitk::PropertyKey visibleKey("visible");
+   * node->GetBoolProperty(visibleKey, visible, renderer);
+   * \endcode
+   *
+   * Registered keys are never removed from the table, so keys should not be created from arbitrary strings.
+   * Creating a key is thread-safe.
+   *
+   * @ingroup DataManagement
+   */
+  class MITKCORE_EXPORT PropertyKey
+  {
+  public:
+    typedef unsigned int IdType;
+
+    /** Returns the key of the name, registering the name if it is not yet known.*/
+    explicit PropertyKey(const std::string &name);
+
+    IdType GetId() const { return m_Id; }
+    const std::string &GetName() const { return *m_Name; }
+
+    bool operator==(const PropertyKey &other) const { return m_Id == other.m_Id; }
+    bool operator!=(const PropertyKey &other) const { return m_Id != other.m_Id; }
+    bool operator<(const PropertyKey &other) const { return m_Id < other.m_Id; }
+
+  private:
+    IdType m_Id;
+    const std::string *m_Name;
+  };
+}
+
+#endif
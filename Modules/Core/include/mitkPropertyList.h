@@ -17,12 +17,14 @@ found in the LICENSE file.
 #include "mitkGenericProperty.h"
 #include "mitkUIDGenerator.h"
 #include "mitkIPropertyOwner.h"
+#include "mitkPropertyKey.h"
 #include <MitkCoreExports.h>
 
 #include <itkObjectFactory.h>
 
 #include <map>
 #include <string>
+#include <vector>
 
 namespace mitk
 {
@@ -94,6 +96,13 @@ namespace mitk
      */
     mitk::BaseProperty *GetProperty(const std::string &propertyKey) const;
 
+    /**
+     * @brief Get a property by its interned key.
+     *
+     * Gives the same result as GetProperty(propertyKey.GetName()), but only compares integers.
+     */
+    mitk::BaseProperty *GetProperty(const PropertyKey &propertyKey) const;
+
     /**
      * @brief Set a property object in the list/map by reference.
      *
@@ -129,6 +138,7 @@ namespace mitk
     * @brief Convenience method to access the value of a BoolProperty
     */
     bool GetBoolProperty(const char *propertyKey, bool &boolValue) const;
+    bool GetBoolProperty(const PropertyKey &propertyKey, bool &boolValue) const;
     /**
     * @brief ShortCut for the above method
     */
@@ -245,7 +255,19 @@ namespace mitk
      */
     PropertyMap m_Properties;
 
+    typedef std::pair<PropertyKey::IdType, BaseProperty *> KeyIndexElementType;
+
+    /**
+     * @brief The properties of m_Properties, sorted by the ids of their interned keys.
+     *
+     * Used by the lookups by PropertyKey. It has to be updated whenever m_Properties is changed.
+     */
+    std::vector<KeyIndexElementType> m_KeyIndex;
+
   private:
+    void InsertIntoKeyIndex(const std::string &propertyKey, BaseProperty *property);
+    void RemoveFromKeyIndex(const std::string &propertyKey);
+
     itk::LightObject::Pointer InternalClone() const override;
   };
 
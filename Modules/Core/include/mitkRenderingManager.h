@@ -19,6 +19,7 @@ found in the LICENSE file.
 
 #include <itkObject.h>
 #include <itkObjectFactory.h>
+#include <itkRealTimeClock.h>
 #include <string>
 
 #include "mitkProperties.h"
@@ -197,12 +198,74 @@ namespace mitk
 
     /** Executes all pending requests. This method has to be called by the
      * system whenever a RenderingManager induced request event occurs in
-     * the system pipeline (see concrete RenderingManager implementations). */
+     * the system pipeline (see concrete RenderingManager implementations).
+     *
+     * Pending windows are rendered in the order of their priority: the focused
+     * window first, then by #SetRenderWindowPriority, then 2D before 3D windows.
+     * If a frame time budget is set (see #SetFrameTimeBudget), windows which
+     * would exceed it are deferred to the next request event; a window is
+     * deferred at most #GetMaximumNumberOfDeferrals times in a row. Requests
+     * for a window which is already pending are coalesced. */
     virtual void ExecutePendingRequests();
 
+    /** Render time instrumentation of a registered RenderWindow, see
+     * #GetRenderWindowStatistics. Times are in milliseconds. */
+    struct RenderWindowStatistics
+    {
+      unsigned long NumberOfRenders;
+      unsigned long NumberOfCoalescedRequests;
+      unsigned long NumberOfDeferrals;
+      double LastRenderTime;
+      double AverageRenderTime;
+      double MaximumRenderTime;
+    };
+
+    /** Returns the render time instrumentation of a RenderWindow (all zero
+     * for windows which are not registered). */
+    RenderWindowStatistics GetRenderWindowStatistics(vtkRenderWindow *renderWindow) const;
+
+    /** Resets the render time instrumentation of all RenderWindows. */
+    void ResetRenderWindowStatistics();
+
+    /** Sets the scheduling priority of a registered RenderWindow (default 0).
+     * Pending windows with a higher priority are rendered first; the focused
+     * window always precedes all others. */
+    void SetRenderWindowPriority(vtkRenderWindow *renderWindow, int priority);
+    int GetRenderWindowPriority(vtkRenderWindow *renderWindow) const;
+
+    /** Time in milliseconds that one call of #ExecutePendingRequests may spend
+     * rendering. The first window is always rendered, further windows only if
+     * their average render time still fits. 0 (default) disables the budget. */
+    itkSetMacro(FrameTimeBudget, double);
+    itkGetConstMacro(FrameTimeBudget, double);
+
+    /** Number of consecutive request events in which a window may be deferred
+     * because of the frame time budget, before it is rendered regardless.
+     * Prevents starvation of slow windows during continuous interaction. */
+    itkSetMacro(MaximumNumberOfDeferrals, unsigned int);
+    itkGetConstMacro(MaximumNumberOfDeferrals, unsigned int);
+
     bool IsRendering() const;
     void AbortRendering();
 
+    /** Marks the begin of a continuous user interaction, e.g. panning or
+     * scrolling with the mouse (see DisplayInteractor). While an interaction
+     * is in progress, 2D mappers render at reduced quality if the
+     * "interaction-LOD-slice-rendering" property is enabled. */
+    void StartInteraction();
+
+    /** Marks the end of an interaction started by #StartInteraction and
+     * requests a full quality update of the 2D windows. */
+    void EndInteraction();
+
+    /** Marks a single interaction step, e.g. scrolling by one slice with the
+     * mouse wheel. The interaction ends if no further step follows before the
+     * high resolution timer of the platform specific subclass fires (see
+     * #StartOrResetTimer). */
+    void NotifyInteractionStep();
+
+    bool IsInteractionInProgress() const;
+
     /** En-/Disable LOD increase globally. */
     itkSetMacro(LODIncreaseBlocked, bool);
 
@@ -324,6 +387,10 @@ namespace mitk
 
     bool m_LODAbortMechanismEnabled;
 
+    unsigned int m_InteractionCounter;
+
+    bool m_InteractionStepPending;
+
     BoolVector m_ShadingEnabled;
 
     bool m_ClippingPlaneEnabled;
@@ -348,6 +415,20 @@ namespace mitk
 
     RenderWindowCallbacksList m_RenderWindowCallbacksList;
 
+    struct RenderWindowSchedule
+    {
+      int Priority;
+      unsigned int Deferrals;
+      RenderWindowStatistics Statistics;
+    };
+
+    typedef std::map<vtkRenderWindow *, RenderWindowSchedule> RenderWindowScheduleList;
+
+    RenderWindowScheduleList m_RenderWindowScheduleList;
+
+    double m_FrameTimeBudget;
+    unsigned int m_MaximumNumberOfDeferrals;
+
     itk::SmartPointer<SliceNavigationController> m_TimeNavigationController;
 
     static RenderingManager::Pointer s_Instance;
@@ -365,8 +446,12 @@ namespace mitk
                                     bool boundingBoxInitialized,
                                     int mapperID);
 
+    /** Returns true if @a a is to be rendered before @a b */
+    bool IsScheduledBefore(vtkRenderWindow *a, vtkRenderWindow *b) const;
+
     vtkRenderWindow *m_FocusedRenderWindow;
     AntiAliasing m_AntiAliasing;
+    itk::RealTimeClock::Pointer m_RenderClock;
   };
 
 #pragma GCC visibility push(default)
@@ -0,0 +1,120 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITKRENDERINGPROFILER_H
+#define MITKRENDERINGPROFILER_H
+
+#include <MitkCoreExports.h>
+#include <mitkCommon.h>
+
+#include <itkObject.h>
+#include <itkRealTimeClock.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace mitk
+{
+  class Mapper;
+
+  /**
+    \brief Records the time a BaseRenderer spends in mapper updates, mapper rendering and annotations.
+
+    Every BaseRenderer owns a profiler, see BaseRenderer::GetRenderingProfiler(). It is disabled by
+    default, the instrumented code only measures times while it is enabled. A frame starts and ends
+    with the rendering of the render window. Times recorded between two frames, e.g. mapper updates
+    triggered by a resize or layouts of annotations, are added to the following frame.
+
+    An itk::EndEvent is invoked after each frame. The observers must not request a new rendering
+    of the render window, since this would render continuously.
+
+    All times are in milliseconds.
+    */
+  class MITKCORE_EXPORT RenderingProfiler : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(RenderingProfiler, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    struct MapperTimes
+    {
+      std::string NodeName;
+      std::string MapperName;
+      /** \brief Time spent in Mapper::Update(), which calls GenerateDataForRenderer() */
+      double UpdateTime;
+      /** \brief Time spent in Mapper::MitkRender() for all render passes */
+      double RenderTime;
+    };
+
+    struct FrameTimes
+    {
+      unsigned long FrameNumber;
+      double MapperUpdateTime;
+      double MapperRenderTime;
+      double AnnotationTime;
+      /** \brief Time between start and end of the rendering of the render window */
+      double TotalTime;
+      /** \brief Times of the mappers in the order of their first update or rendering in the frame */
+      std::vector<MapperTimes> Mappers;
+    };
+
+    /** \brief Enabling the profiler discards all recorded frames. */
+    void SetEnabled(bool enabled);
+    itkGetConstMacro(Enabled, bool);
+    itkBooleanMacro(Enabled);
+
+    /** \brief Current time of the profiler clock. */
+    double GetTime() const;
+
+    void StartFrame();
+    void EndFrame();
+
+    void AddMapperUpdateTime(const Mapper *mapper, double time);
+    void AddMapperRenderTime(const Mapper *mapper, double time);
+    void AddAnnotationTime(double time);
+
+    /** \brief Times of the last finished frame. FrameNumber is 0 if no frame was finished. */
+    const FrameTimes &GetLastFrame() const;
+
+    itkGetConstMacro(NumberOfFrames, unsigned long);
+    /** \brief Exponential moving average of the total frame time */
+    itkGetConstMacro(AverageTotalTime, double);
+    itkGetConstMacro(MaximumTotalTime, double);
+
+    /** \brief Multi-line description of the last frame, listing the @a numberOfMappers slowest mappers. */
+    std::string GetSummary(unsigned int numberOfMappers = 5) const;
+
+  protected:
+    RenderingProfiler();
+    ~RenderingProfiler() override;
+
+  private:
+    MapperTimes &GetMapperTimes(const Mapper *mapper);
+    void ResetCurrentFrame();
+
+    bool m_Enabled;
+    itk::RealTimeClock::Pointer m_Clock;
+
+    bool m_FrameStarted;
+    double m_FrameStartTime;
+    FrameTimes m_CurrentFrame;
+    std::map<const Mapper *, std::size_t> m_CurrentMapperIndices;
+    FrameTimes m_LastFrame;
+
+    unsigned long m_NumberOfFrames;
+    double m_AverageTotalTime;
+    double m_MaximumTotalTime;
+  };
+}
+
+#endif // MITKRENDERINGPROFILER_H
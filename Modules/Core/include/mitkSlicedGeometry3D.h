@@ -77,6 +77,11 @@ namespace mitk
       * requested as the plane of the first slice shifted by m_Spacing[3]*s
       * in the direction of m_DirectionVector.
       *
+      * Only the most recently requested of these calculated geometries are kept,
+      * so a stack with many slices does not hold a PlaneGeometry per slice. Keep a
+      * smart pointer to the returned geometry if it is needed while many other
+      * slices are requested.
+      *
       * \warning The PlaneGeometries are not necessarily up-to-date and not even
       * initialized.
       *
@@ -279,11 +284,22 @@ namespace mitk
     */
     mitk::Vector3D AdjustNormal(const mitk::Vector3D &normal) const;
 
+    /** Discards the PlaneGeometries calculated for an evenly spaced stack, e.g. after the first slice changed. */
+    void ClearGeneratedPlaneGeometries();
+
     /**
     * Container for the 2D-geometries contained within this SliceGeometry3D.
     */
     mutable std::vector<PlaneGeometry::Pointer> m_PlaneGeometries;
 
+    /**
+    * PlaneGeometries calculated by GetPlaneGeometry() for an evenly spaced stack,
+    * together with their slice. The most recently requested one is the last.
+    * They are not stored in m_PlaneGeometries, so only a few of them are kept
+    * and clones of this geometry do not copy them.
+    */
+    mutable std::vector<std::pair<int, PlaneGeometry::Pointer>> m_GeneratedPlaneGeometries;
+
     /**
     * If (a) m_EvenlySpaced==true, (b) we don't have a PlaneGeometry stored
     * for the requested slice, and (c) the first slice (s=0)
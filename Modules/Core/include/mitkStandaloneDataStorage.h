@@ -17,6 +17,9 @@ found in the LICENSE file.
 #include "mitkDataStorage.h"
 #include "mitkMessage.h"
 #include <map>
+#include <set>
+#include <string>
+#include <vector>
 
 namespace mitk
 {
@@ -88,6 +91,16 @@ namespace mitk
     //##
     SetOfObjects::ConstPointer GetAll() const override;
 
+    //##Documentation
+    //## @brief returns a set of data objects that meet the given condition(s)
+    //##
+    //## Conditions on the data type (NodePredicateDataType), on the name (NodePredicateProperty for the
+    //## "name" property with a StringProperty) and conjunctions (NodePredicateAnd) containing any of them
+    //## are answered from indices, so only the nodes of the matching index entries are checked against the
+    //## condition. The indices are updated when nodes are added, removed or modified and when the name
+    //## property of a node is changed. All other conditions are checked against all nodes.
+    SetOfObjects::ConstPointer GetSubset(const NodePredicateBase *condition) const override;
+
     /*ITK Mutex */
     mutable itk::SimpleFastMutexLock m_Mutex;
 
@@ -122,12 +135,62 @@ namespace mitk
     //## @brief Prints the contents of the StandaloneDataStorage to os. Do not call directly, call ->Print() instead
     void PrintSelf(std::ostream &os, itk::Indent indent) const override;
 
+    typedef std::set<const mitk::DataNode *> NodeSet;
+
+    //##Documentation
+    //## @brief Index state of a node, which is needed to remove the node from the indices again
+    struct IndexEntry
+    {
+      bool IsIndexed = false;
+      std::string DataType;
+      bool HasDataType = false;
+      std::string Name;
+      bool HasIndexedName = false;
+      BaseProperty::Pointer NameProperty;
+      unsigned long NameObserverTag = 0;
+      unsigned long NodeObserverTag = 0;
+    };
+
+    //##Documentation
+    //## @brief Adds the node to the indices and observes it to keep the indices up to date
+    void AddToIndex(const mitk::DataNode *node);
+
+    //##Documentation
+    //## @brief Removes the node from the indices and removes the observers
+    void RemoveFromIndex(const mitk::DataNode *node);
+
+    //##Documentation
+    //## @brief Moves the node to the index entries of its current data type and name (m_IndexMutex must be locked)
+    void UpdateIndexEntry(const mitk::DataNode *node, IndexEntry &entry);
+
+    void OnIndexedNodeModified(const itk::Object *caller, const itk::EventObject &event);
+    void OnIndexedNamePropertyModified(const itk::Object *caller, const itk::EventObject &event);
+
+    //##Documentation
+    //## @brief Gets the nodes that may fulfill the condition from the indices.
+    //## @return false if the condition cannot be answered by the indices
+    bool GetIndexCandidates(const NodePredicateBase *condition, std::vector<const mitk::DataNode *> &candidates) const;
+
     //##Documentation
     //## @brief Nodes and their relation are stored in m_SourceNodes
     AdjacencyList m_SourceNodes;
     //##Documentation
     //## @brief Nodes are stored in reverse relation for easier traversal in the opposite direction of the relation
     AdjacencyList m_DerivedNodes;
+
+    //##Documentation
+    //## @brief Protects the indices, which are also updated from the modified events of the nodes
+    mutable itk::SimpleFastMutexLock m_IndexMutex;
+    std::map<const mitk::DataNode *, IndexEntry> m_IndexEntries;
+    //##Documentation
+    //## @brief Nodes by the GetNameOfClass() of their data
+    std::map<std::string, NodeSet> m_DataTypeIndex;
+    //##Documentation
+    //## @brief Nodes by the value of their "name" StringProperty
+    std::map<std::string, NodeSet> m_NameIndex;
+    //##Documentation
+    //## @brief Nodes without an own "name" StringProperty, their name may come from the data and is always checked
+    NodeSet m_NodesWithoutIndexedName;
   };
 } // namespace mitk
 #endif /* MITKSTANDALONEDATASTORAGE_H_HEADER_INCLUDED_ */
@@ -16,7 +16,9 @@ found in the LICENSE file.
 #include "MitkCoreExports.h"
 #include "mitkStateMachineTransition.h"
 #include <itkLightObject.h>
+#include <map>
 #include <string>
+#include <utility>
 
 namespace mitk
 {
@@ -48,8 +50,11 @@ namespace mitk
 
     /**
     * @brief Return Transitions that match given event description.
+    *
+    * The result of the first query of an event description is stored in a transition table, so subsequent
+    * events of the same class and variant are a single look-up.
     **/
-    TransitionVector GetTransitionList(const std::string &eventClass, const std::string &eventVariant);
+    const TransitionVector &GetTransitionList(const std::string &eventClass, const std::string &eventVariant);
 
     /**
     * @brief Returns the name.
@@ -89,6 +94,11 @@ namespace mitk
     * @brief map of transitions that lead from this state to the next state
     **/
     TransitionVector m_Transitions;
+
+    /**
+    * @brief Matching transitions per event class and event variant, see GetTransitionList()
+    **/
+    std::map<std::pair<std::string, std::string>, TransitionVector> m_TransitionTable;
   };
 } // namespace mitk
 #endif /* SMSTATE_H_HEADER_INCLUDED_C19A8A5D */
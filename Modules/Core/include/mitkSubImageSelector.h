@@ -27,6 +27,10 @@ namespace mitk
   //## a slice (mitk::ImageSilceSelector) or a volume at a specific time
   //## (mitk::ImageTimeSelector). If the input is generated by a ProcessObject,
   //## only the required data is requested.
+  //##
+  //## The data items of the output are views of the memory of the input
+  //## (see ImageDataItem::SetSharedView): the output keeps the memory alive and
+  //## copies it only before the first write access by an ImageWriteAccessor.
   //## @ingroup Process
   class MITKCORE_EXPORT SubImageSelector : public ImageToImageFilter
   {
@@ -0,0 +1,75 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITKSURFACECUTLOCATOR_H
+#define MITKSURFACECUTLOCATOR_H
+
+#include <MitkCoreExports.h>
+
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
+
+#include <vector>
+
+namespace mitk
+{
+  /**
+    \brief Finds the cells of a vtkPolyData that are intersected by parallel planes, as used by SurfaceVtkMapper2D.
+
+    SetInput() projects all points onto the plane normal and sorts the cells into buckets by the
+    interval they span along the normal. This is done once per state of the poly data and normal.
+    ExtractCells() then only visits the cells of the bucket containing the plane, so that the
+    following vtkCutter only has to process the cells that actually can be intersected instead of
+    the whole surface.
+    */
+  class MITKCORE_EXPORT SurfaceCutLocator
+  {
+  public:
+    SurfaceCutLocator();
+
+    /** \brief Sets the poly data and the normal of the planes. The buckets are rebuilt only if
+      @a polyData, its modification time or @a normal changed. */
+    void SetInput(vtkPolyData *polyData, const double normal[3]);
+
+    /** \brief Returns a new poly data containing the cells intersected by the plane through @a origin
+      (and with the normal of SetInput()), together with their points, point data and cell data. */
+    vtkSmartPointer<vtkPolyData> ExtractCells(const double origin[3]);
+
+    /** \brief Number of buckets, 0 if there is no input. */
+    std::size_t GetNumberOfBuckets() const { return m_BucketOffsets.empty() ? 0 : m_BucketOffsets.size() - 1; }
+
+    /** \brief Drops the input and the buckets. */
+    void Initialize();
+
+  private:
+    void BuildBuckets();
+
+    vtkSmartPointer<vtkPolyData> m_PolyData;
+    unsigned long m_PolyDataMTime;
+    double m_Normal[3];
+
+    /** \brief Interval of each cell along the normal */
+    std::vector<double> m_CellMinimum;
+    std::vector<double> m_CellMaximum;
+
+    double m_Minimum;
+    double m_BucketWidth;
+    /** \brief The cells of bucket i are m_BucketCells[m_BucketOffsets[i] .. m_BucketOffsets[i + 1] - 1] */
+    std::vector<std::size_t> m_BucketOffsets;
+    std::vector<vtkIdType> m_BucketCells;
+
+    /** \brief Index of each input point in the extracted poly data, -1 if not extracted */
+    std::vector<vtkIdType> m_PointMap;
+  };
+}
+
+#endif // MITKSURFACECUTLOCATOR_H
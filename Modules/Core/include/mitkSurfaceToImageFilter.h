@@ -28,17 +28,18 @@ namespace mitk
    * image, which header information defines the output image.
    *
    * The resulting image has the same dimension, size, and Geometry3D
-   * as the input image. The image is cut using a vtkStencil.
+   * as the input image. The surface is voxelized with vtkPolyDataToImageStencil
+   * restricted to its bounding box, slabs of slices are processed in parallel.
    * The user can decide if he wants to keep the original values or create a
    * binary image by setting MakeBinaryOutputOn (default is \a false). If
    * set to \a true all voxels inside the surface are set to one and all
-   * outside voxel are set to zero.
+   * outside voxel are set to zero. Otherwise voxels inside the surface keep
+   * the value of the input image and all others are set to the background value.
    *
-   * NOTE: Since the reference input image is passed to the vtkStencil in
-   * any case, the image needs to be initialized with pixel values greater than
-   * the numerical minimum of the used pixel type (e.g. at least -127 for
-   * unsigned char images, etc.) to produce a correct binary image
-   * representation of the surface in MakeOutputBinary mode.
+   * Several surfaces can be voxelized in one pass with SetSurface(). With
+   * MakeOutputLabelImageOn the output is an unsigned short label image in which
+   * the voxels inside the surface with index i are set to i + 1; where surfaces
+   * overlap, the one with the higher index wins.
    *
    * @ingroup SurfaceFilters
    * @ingroup Process
@@ -57,6 +58,10 @@ namespace mitk
     itkGetMacro(UShortBinaryPixelType, bool);
     itkBooleanMacro(UShortBinaryPixelType);
 
+    itkSetMacro(MakeOutputLabelImage, bool);
+    itkGetMacro(MakeOutputLabelImage, bool);
+    itkBooleanMacro(MakeOutputLabelImage);
+
     itkGetConstMacro(BackgroundValue, float);
     itkSetMacro(BackgroundValue, float);
 
@@ -74,6 +79,15 @@ namespace mitk
     using itk::ProcessObject::SetInput;
     virtual void SetInput(const mitk::Surface *surface);
 
+    /**
+     * \brief Sets the surface with the given index. Surface 0 is the one set by SetInput().
+     */
+    void SetSurface(unsigned int index, const mitk::Surface *surface);
+
+    const mitk::Surface *GetSurface(unsigned int index);
+
+    unsigned int GetNumberOfSurfaces();
+
     void SetImage(const mitk::Image *source);
 
     const mitk::Image *GetImage(void);
@@ -87,6 +101,7 @@ namespace mitk
 
     bool m_MakeOutputBinary;
     bool m_UShortBinaryPixelType;
+    bool m_MakeOutputLabelImage;
 
     float m_BackgroundValue;
     double m_Tolerance;
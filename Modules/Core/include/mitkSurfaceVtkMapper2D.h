@@ -15,6 +15,7 @@ found in the LICENSE file.
 
 #include "mitkBaseRenderer.h"
 #include "mitkLocalStorageHandler.h"
+#include "mitkSurfaceCutLocator.h"
 #include "mitkVtkMapper.h"
 #include <MitkCoreExports.h>
 
@@ -27,6 +28,7 @@ class vtkLookupTable;
 class vtkGlyph3D;
 class vtkArrowSource;
 class vtkReverseSense;
+class vtkTransformPolyDataFilter;
 
 namespace mitk
 {
@@ -36,9 +38,11 @@ namespace mitk
     * @brief Vtk-based mapper for cutting 2D slices out of Surfaces.
     *
     * The mapper uses a vtkCutter filter to cut out slices (contours) of the 3D
-    * volume and render these slices as vtkPolyData. The data is transformed
-    * according to its geometry before cutting, to support the geometry concept
-    * of MITK.
+    * volume and render these slices as vtkPolyData. The cutting plane is
+    * transformed into the coordinates of the data and the contour is transformed
+    * according to the geometry of the data after cutting, to support the geometry
+    * concept of MITK. A SurfaceCutLocator, built once per surface and plane
+    * orientation, passes only the cells intersected by the plane to the cutter.
     *
     * Properties:
     * \b Surface.2D.Line Width: Thickness of the rendered lines in 2D.
@@ -109,6 +113,14 @@ namespace mitk
          * @brief m_CuttingPlane The plane where to cut off the 2D slice.
          */
       vtkSmartPointer<vtkPlane> m_CuttingPlane;
+      /**
+         * @brief m_CutLocator Selects the cells intersected by the cutting plane.
+         */
+      SurfaceCutLocator m_CutLocator;
+      /**
+         * @brief m_CutTransformFilter Transforms the cut according to the geometry of the data.
+         */
+      vtkSmartPointer<vtkTransformPolyDataFilter> m_CutTransformFilter;
 
       /**
        * @brief m_NormalMapper Mapper for the normals.
@@ -155,9 +167,10 @@ namespace mitk
      * The base class transforms the actor according to the respective
      * geometry which is correct for most cases. This mapper, however,
      * uses a vtkCutter to cut out a contour. To cut out the correct
-     * contour, the data has to be transformed beforehand. Else the
-     * current plane geometry will point the cutter to en empty location
-     * (if the surface does have a geometry, which is a rather rare case).
+     * contour, the plane is transformed into the coordinates of the data
+     * and the contour is transformed afterwards. Else the current plane
+     * geometry will point the cutter to en empty location (if the surface
+     * does have a geometry, which is a rather rare case).
      */
     void UpdateVtkTransform(mitk::BaseRenderer * /*renderer*/) override {}
   protected:
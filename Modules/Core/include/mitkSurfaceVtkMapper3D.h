@@ -15,9 +15,11 @@ found in the LICENSE file.
 
 #include "mitkBaseRenderer.h"
 #include "mitkLocalStorageHandler.h"
+#include "mitkMemoryAccounting.h"
 #include "mitkVtkMapper.h"
 #include <MitkCoreExports.h>
 #include <mitkSurface.h>
+#include <mitkThreadPool.h>
 
 #include <vtkActor.h>
 #include <vtkDepthSortPolyData.h>
@@ -26,6 +28,11 @@ found in the LICENSE file.
 #include <vtkPolyDataNormals.h>
 #include <vtkSmartPointer.h>
 
+#include <future>
+#include <map>
+#include <memory>
+#include <vector>
+
 namespace mitk
 {
   /**
@@ -56,6 +63,8 @@ namespace mitk
   *   - \b "scalar visibility": (BoolProperty) If the scarlars of the surface are visible
   *   - \b "Surface.TransferFunction (TransferFunctionProperty) Set a transferfunction for coloring the surface
   *   - \b "LookupTable (LookupTableProperty) LookupTable
+  *   - \b "Surface.LevelOfDetail": (BoolProperty) Render large surfaces with a decimated level of detail
+  *        while interacting or if the surface covers only few pixels. True by default.
 
   * Properties to look for are:
   *
@@ -65,13 +74,17 @@ namespace mitk
   *         for the level window settings.
   *   - \b "ScalarsRangeMaximum": Optional. See above.
   *
+  * For surfaces with at least a million polygons, a level of detail pyramid is computed by quadric
+  * decimation on the mitk::ThreadPool. Every level has a quarter of the polygons of the next finer
+  * level. Until the pyramid is available, the surface is rendered at full resolution.
+  *
   * There might be still some other, deprecated properties. These will not be documented anymore.
   * Please check the source if you really need them.
   *
   * @ingroup Mapper
   */
 
-  class MITKCORE_EXPORT SurfaceVtkMapper3D : public VtkMapper
+  class MITKCORE_EXPORT SurfaceVtkMapper3D : public VtkMapper, public MemoryAccounting::Cache
   {
   public:
     mitkClassMacro(SurfaceVtkMapper3D, VtkMapper);
@@ -92,6 +105,15 @@ namespace mitk
 
     static void SetDefaultProperties(mitk::DataNode *node, mitk::BaseRenderer *renderer = nullptr, bool overwrite = false);
 
+    /** Returns true if the "Surface.LevelOfDetail" property is enabled and the surface is large enough. */
+    bool IsLODEnabled(BaseRenderer *renderer) const override;
+
+    /** Bytes held by the computed levels of detail, accounted as MemoryAccounting::SurfaceLevelOfDetailType. */
+    std::size_t GetCacheSize() const override;
+
+    /** Discards the levels of detail, they are recomputed in the background on the next render. */
+    void ReleaseCache() override;
+
   protected:
     SurfaceVtkMapper3D();
 
@@ -105,6 +127,11 @@ namespace mitk
      * adds it to m_ClippingPlaneCollection (internal method). */
     virtual void CheckForClippingProperty(mitk::BaseRenderer *renderer, mitk::BaseProperty *property);
 
+    /** Returns the level of detail of the poly data to render. That is the finest level whose number
+     * of polygons does not exceed a budget based on the projected size of the surface, which is
+     * further limited while the renderer renders interactively (internal method). */
+    vtkPolyData *GetLevelOfDetail(mitk::BaseRenderer *renderer, vtkPolyData *polyData);
+
     bool m_GenerateNormals;
 
   public:
@@ -135,6 +162,24 @@ namespace mitk
 
     mitk::LocalStorageHandler<LocalStorage> m_LSH;
 
+  private:
+    /** The levels of detail of the poly data of one time step, shared by all renderers. */
+    struct LevelOfDetailPyramid
+    {
+      /** The poly data and its modification time the pyramid was computed for.*/
+      const vtkPolyData *Source = nullptr;
+      vtkMTimeType SourceMTime = 0;
+
+      /** Coarser levels of the source, filled by the background task.*/
+      std::shared_ptr<std::vector<vtkSmartPointer<vtkPolyData>>> Levels;
+      std::future<void> Future;
+      ThreadPool::CancellationToken Token;
+      bool IsAvailable = false;
+    };
+
+    std::map<int, LevelOfDetailPyramid> m_LevelOfDetailPyramids;
+
+  public:
     static void ApplyMitkPropertiesToVtkProperty(mitk::DataNode *node,
                                                  vtkProperty *property,
                                                  mitk::BaseRenderer *renderer);
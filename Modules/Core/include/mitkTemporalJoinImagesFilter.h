@@ -17,6 +17,8 @@ found in the LICENSE file.
 #include "mitkImageToImageFilter.h"
 #include "mitkCommon.h"
 
+#include <functional>
+
 #include "MitkCoreExports.h"
 
 namespace mitk
@@ -25,7 +27,10 @@ namespace mitk
   Preconditions of this filter are, that all input images have the same pixel type and geometry.
   The sequence of frames in the output image is the same then the sequence of inputs.
   It no time bounds are defined the dynamic image will start at 0 ms and each time step has a duration
-  of 1 ms.*/
+  of 1 ms.
+  In the streaming mode (see SetFrameLoader()) only the first frame is set as input. The filter allocates
+  the output for the given number of frames and loads the other frames one after another, copying each
+  directly into its time step. So at most one frame besides the output is held in memory.*/
   class MITKCORE_EXPORT TemporalJoinImagesFilter : public ImageToImageFilter
   {
   public:
@@ -42,6 +47,14 @@ namespace mitk
     /**Set custom max time bounds for all time steps.*/
     void SetMaxTimeBounds(const TimeBoundsVectorType &bounds);
 
+    /**Function that loads the frame of the passed time step (> 0) in the streaming mode.*/
+    typedef std::function<mitk::Image::Pointer(unsigned int)> FrameLoaderType;
+
+    /**Enables the streaming mode for numberOfFrames frames (including the first one, which is the input
+    of the filter). Frames whose geometry or pixel type differs from the first frame are rejected like
+    inputs. An empty loader disables the streaming mode.*/
+    void SetFrameLoader(const FrameLoaderType &loader, unsigned int numberOfFrames);
+
   protected:
     TemporalJoinImagesFilter(){};
     ~TemporalJoinImagesFilter() override{};
@@ -53,8 +66,13 @@ namespace mitk
     void GenerateData() override;
 
   private:
+    unsigned int GetNumberOfFrames() const;
+    void CheckFrame(const mitk::Image *frame, unsigned int pos) const;
+
     TimeBoundsVectorType m_MaxTimeBounds;
     mitk::TimePointType m_FirstMinTimeBound = 0.0;
+    FrameLoaderType m_FrameLoader;
+    unsigned int m_NumberOfFrames = 0;
   };
 }
 
@@ -0,0 +1,171 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkThreadPool_h
+#define mitkThreadPool_h
+
+#include <MitkCoreExports.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mitk
+{
+  /**
+   * \brief A work-stealing thread pool with task priorities which is shared by background work.
+   *
+   * Use GetInstance() instead of spawning threads for background work, so that the number of
+   * threads stays close to the number of cores.
+   *
+   * Tasks are taken in the order of their priority (Interactive before Visible before Background).
+   * Tasks submitted from a worker thread are queued at this worker and taken last in, first out;
+   * idle workers steal the oldest tasks of other workers.
+   *
+   * Nested parallelism: a worker thread waiting with Wait() or ParallelFor() runs pending tasks
+   * instead of blocking. Code running in a task should pass GetRecommendedNumberOfThreads() to
+   * multi-threaded ITK filters instead of using all cores.
+   *
+   * The size of the shared pool is the number of hardware threads or the value of the
+   * MITK_THREAD_POOL_SIZE environment variable.
+   */
+  class MITKCORE_EXPORT ThreadPool
+  {
+  public:
+    enum class Priority
+    {
+      Interactive = 0, ///< Blocks user interaction, e.g. a preview during a mouse drag
+      Visible = 1,     ///< Result is visible in the application, e.g. a surface of a segmentation
+      Background = 2   ///< Everything else
+    };
+
+    /**
+     * \brief Shared flag for canceling tasks.
+     *
+     * Copies share their state. Tasks which have not started when the token is canceled are not
+     * run. Running tasks have to check IsCanceled() themselves.
+     */
+    class MITKCORE_EXPORT CancellationToken
+    {
+    public:
+      CancellationToken();
+
+      void Cancel();
+      bool IsCanceled() const;
+
+    private:
+      std::shared_ptr<std::atomic<bool>> m_Canceled;
+    };
+
+    using Task = std::function<void()>;
+    using RangeTask = std::function<void(std::size_t begin, std::size_t end)>;
+
+    /**
+     * \brief The thread pool shared by MITK.
+     *
+     * It is never destroyed, so that tasks can run until the process exits.
+     */
+    static ThreadPool &GetInstance();
+
+    /**
+     * \param numberOfThreads The number of worker threads; 0 means the number of hardware threads.
+     */
+    explicit ThreadPool(unsigned int numberOfThreads = 0);
+
+    /**
+     * Runs all queued tasks and joins the worker threads.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * \brief Queues a task.
+     *
+     * \return A future which becomes ready when the task has run or was skipped because of
+     * \a token. Exceptions thrown by the task are rethrown by std::future::get().
+     */
+    std::future<void> Submit(Task task, Priority priority = Priority::Background, const CancellationToken &token = CancellationToken());
+
+    /**
+     * \brief Waits for a future, running pending tasks meanwhile if called from a worker thread.
+     */
+    void Wait(const std::future<void> &future);
+
+    /**
+     * \brief Calls \a task for consecutive, disjoint sub-ranges covering [begin, end) and returns
+     * afterwards.
+     *
+     * The calling thread works on the range as well. Only idle workers help if called from a
+     * worker thread, and the helper tasks inherit the priority of the calling task. The first
+     * exception thrown by \a task is rethrown; sub-ranges which have not started are skipped then.
+     *
+     * \param grainSize The minimum size of a sub-range.
+     */
+    void ParallelFor(std::size_t begin, std::size_t end, const RangeTask &task, std::size_t grainSize = 1, Priority priority = Priority::Visible);
+
+    unsigned int GetNumberOfThreads() const;
+    unsigned int GetNumberOfIdleThreads() const;
+
+    /**
+     * \brief Whether the calling thread is a worker thread of this pool.
+     */
+    bool IsWorkerThread() const;
+
+    /**
+     * \brief The number of threads multi-threaded code called by the calling thread should use.
+     *
+     * This is the number of threads of the pool if called from another thread. In a task it is
+     * the number of idle workers plus one, so nested parallel work does not oversubscribe the cores.
+     */
+    unsigned int GetRecommendedNumberOfThreads() const;
+
+  private:
+    struct Item
+    {
+      Task Function;
+      std::promise<void> Promise;
+      CancellationToken Token;
+      Priority TaskPriority;
+    };
+
+    struct Worker
+    {
+      std::mutex Mutex;
+      std::deque<Item> Queues[3];
+      std::thread Thread;
+    };
+
+    void Run(std::size_t workerIndex);
+    bool TryTake(Item &item);
+    void Execute(Item &item);
+
+    std::vector<std::unique_ptr<Worker>> m_Workers;
+
+    std::mutex m_Mutex;
+    std::condition_variable m_Condition;
+    std::deque<Item> m_Queues[3];
+    std::atomic<std::size_t> m_NumberOfPendingTasks;
+    std::atomic<unsigned int> m_NumberOfIdleThreads;
+    bool m_Stop;
+  };
+}
+
+#endif
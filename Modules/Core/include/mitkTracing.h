@@ -0,0 +1,203 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkTracing_h
+#define mitkTracing_h
+
+#include <MitkCoreExports.h>
+#include <mitkConfig.h>
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mitk
+{
+  /**
+    \brief Low-overhead recording of timed events and counters of hot paths, exported as Chrome trace.
+
+    The instrumented code uses the macros MITK_TRACE_SCOPE(), MITK_TRACE_SCOPE_ARGS(), MITK_TRACE_COUNT() and
+    MITK_TRACE_COUNTER(), which are compiled only if the CMake option MITK_ENABLE_TRACING is on (the default).
+    Recording is disabled at runtime until SetEnabled() is called, e.g. from the Help menu of the workbench or
+    by setting the environment variable MITK_TRACE to the path of a trace file, which is written at exit.
+    While it is disabled, an instrumented scope costs one relaxed atomic load.
+
+    Each thread records into a buffer of its own, so threads do not contend while recording. A buffer keeps
+    the last GetMaximumNumberOfEvents() events, older events are overwritten, so recording can be left on
+    for long sessions. WriteChromeTrace() writes the Chrome trace JSON format, which can be inspected with
+    chrome://tracing or https://ui.perfetto.dev.
+
+    Categories and names of events and counters have to be string literals or other strings that live
+    until the process ends, only their addresses are recorded. Time stamps are microseconds since the
+    first use of the class. All methods are thread-safe.
+    */
+  class MITKCORE_EXPORT Tracing
+  {
+  public:
+    /** \brief Records a complete event covering the lifetime of this object, if recording is enabled. */
+    class MITKCORE_EXPORT Scope
+    {
+    public:
+      Scope(const char *category, const char *name)
+        : m_Category(category), m_Name(name), m_Begin(Tracing::IsEnabled() ? Tracing::Now() : -1.0)
+      {
+      }
+
+      ~Scope()
+      {
+        if (m_Begin >= 0.0)
+          Tracing::AddCompleteEvent(m_Category, m_Name, m_Begin, Tracing::Now(), std::move(m_Args));
+      }
+
+      /** \brief True if the event is recorded, i.e. recording was enabled when the scope was entered. */
+      bool IsRecording() const { return m_Begin >= 0.0; }
+
+      /** \brief JSON object members shown as arguments of the event, e.g. <code>"\"size\": 3"</code>. */
+      void SetArgs(std::string args) { m_Args = std::move(args); }
+
+    private:
+      Scope(const Scope &) = delete;
+      Scope &operator=(const Scope &) = delete;
+
+      const char *m_Category;
+      const char *m_Name;
+      double m_Begin;
+      std::string m_Args;
+    };
+
+    /**
+      \brief A counter that accumulates while recording is enabled, e.g. the number of calls of a method.
+
+      Counters register themselves and are exported with their value at the time of the export. They are
+      reset by Clear() and by enabling recording. Create them as static objects, see MITK_TRACE_COUNT().
+      */
+    class MITKCORE_EXPORT Counter
+    {
+    public:
+      Counter(const char *category, const char *name);
+      ~Counter();
+
+      void Add(std::int64_t delta)
+      {
+        if (Tracing::IsEnabled())
+          m_Value.fetch_add(delta, std::memory_order_relaxed);
+      }
+
+      std::int64_t GetValue() const { return m_Value.load(std::memory_order_relaxed); }
+      void Reset() { m_Value.store(0, std::memory_order_relaxed); }
+
+      const char *GetCategory() const { return m_Category; }
+      const char *GetName() const { return m_Name; }
+
+    private:
+      Counter(const Counter &) = delete;
+      Counter &operator=(const Counter &) = delete;
+
+      const char *m_Category;
+      const char *m_Name;
+      std::atomic<std::int64_t> m_Value;
+    };
+
+    /** \brief Enabling discards all events recorded before and resets the counters. */
+    static void SetEnabled(bool enabled);
+
+    static bool IsEnabled() { return s_Enabled.load(std::memory_order_relaxed); }
+
+    /** \brief Microseconds since the first use of the class. */
+    static double Now();
+
+    static void AddCompleteEvent(const char *category, const char *name, double begin, double end, std::string args = "");
+
+    static void AddInstantEvent(const char *category, const char *name, std::string args = "");
+
+    /** \brief Records the current value of a quantity, e.g. the size of a cache, shown as counter track. */
+    static void AddCounterSample(const char *category, const char *name, double value);
+
+    /** \brief A JSON object member with an escaped string value, for the arguments of events. */
+    static std::string MakeArg(const char *key, const std::string &value);
+
+    /** \brief Maximum number of events kept per thread, 65536 by default. */
+    static void SetMaximumNumberOfEvents(std::size_t numberOfEvents);
+    static std::size_t GetMaximumNumberOfEvents();
+
+    /** \brief Number of events currently kept by all threads. */
+    static std::size_t GetNumberOfEvents();
+
+    /** \brief Category, name and value of all counters. */
+    static std::vector<std::pair<std::string, std::int64_t>> GetCounterValues();
+
+    /** \brief Discards all recorded events and resets the counters. */
+    static void Clear();
+
+    /** \brief Writes the recorded events and the counters in the Chrome trace JSON object format. */
+    static void WriteChromeTrace(std::ostream &stream);
+
+    /** \return false if the file could not be written. */
+    static bool WriteChromeTrace(const std::string &filePath);
+
+  private:
+    Tracing() = delete;
+
+    static std::atomic<bool> s_Enabled;
+  };
+}
+
+#ifdef MITK_ENABLE_TRACING
+
+#define MITK_TRACE_CONCAT_IMPL(a, b) a##b
+#define MITK_TRACE_CONCAT(a, b) MITK_TRACE_CONCAT_IMPL(a, b)
+
+/** \brief Records the time until the end of the enclosing block as event, see mitk::Tracing. */
+#define MITK_TRACE_SCOPE(category, name) \
+  mitk::Tracing::Scope MITK_TRACE_CONCAT(mitkTraceScope, __LINE__)(category, name)
+
+/** \brief Like MITK_TRACE_SCOPE(), @a args (JSON object members) is evaluated only while recording. */
+#define MITK_TRACE_SCOPE_ARGS(category, name, args)                              \
+  mitk::Tracing::Scope MITK_TRACE_CONCAT(mitkTraceScope, __LINE__)(category, name); \
+  if (MITK_TRACE_CONCAT(mitkTraceScope, __LINE__).IsRecording())                 \
+  MITK_TRACE_CONCAT(mitkTraceScope, __LINE__).SetArgs(args)
+
+/** \brief Adds @a delta to a counter, see mitk::Tracing::Counter. */
+#define MITK_TRACE_COUNT(category, name, delta)                           \
+  do                                                                      \
+  {                                                                       \
+    static mitk::Tracing::Counter mitkTraceCounter(category, name);      \
+    mitkTraceCounter.Add(delta);                                          \
+  } while (false)
+
+/** \brief Records the current value of a quantity, see mitk::Tracing::AddCounterSample(). */
+#define MITK_TRACE_COUNTER(category, name, value)                                      \
+  do                                                                                   \
+  {                                                                                    \
+    if (mitk::Tracing::IsEnabled())                                                    \
+      mitk::Tracing::AddCounterSample(category, name, static_cast<double>(value));     \
+  } while (false)
+
+#else
+
+#define MITK_TRACE_SCOPE(category, name)
+#define MITK_TRACE_SCOPE_ARGS(category, name, args)
+#define MITK_TRACE_COUNT(category, name, delta) \
+  do                                            \
+  {                                             \
+  } while (false)
+#define MITK_TRACE_COUNTER(category, name, value) \
+  do                                              \
+  {                                               \
+  } while (false)
+
+#endif
+
+#endif
@@ -29,6 +29,7 @@ namespace mitk
    * Voxels are counted if their gray value is above a threshold (see SetThreshold), the default threshold is 0.
    *
    * The filter works for 2D, 3D and 3D+t. In the 3D+t case a vector of volumes is provided (see GetVolumes()).
+   * The voxels are counted in parallel on the mitk::ThreadPool.
    */
   class MITKCORE_EXPORT VolumeCalculator : public itk::Object
   {
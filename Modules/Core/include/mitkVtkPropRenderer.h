@@ -193,6 +193,10 @@ namespace mitk
 
     static void RenderingCallback(vtkObject *caller, unsigned long eid, void *clientdata, void *calldata);
 
+    /** \brief Start and end of a frame of the RenderingProfiler, observing the render window */
+    static void FrameStartCallback(vtkObject *caller, unsigned long eid, void *clientdata, void *calldata);
+    static void FrameEndCallback(vtkObject *caller, unsigned long eid, void *clientdata, void *calldata);
+
     virtual void UpdatePaths(); // apply transformations and properties recursively
 
   private:
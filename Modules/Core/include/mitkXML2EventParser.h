@@ -64,6 +64,13 @@ namespace mitk
     typedef std::vector<mitk::InteractionEvent::Pointer> EventContainerType;
 
     EventContainerType GetInteractions() { return m_InteractionList; }
+
+    /**
+     * @brief Recorded time of each event in milliseconds since the start of the recording.
+     *
+     * Has one entry per event of GetInteractions(); events without timestamp (recorded by older versions) get -1.
+     */
+    std::vector<double> GetTimestamps() { return m_Timestamps; }
     ~XML2EventParser() override{};
 
   protected:
@@ -84,6 +91,7 @@ namespace mitk
     PropertyList::Pointer m_EventPropertyList;
 
     EventContainerType m_InteractionList;
+    std::vector<double> m_Timestamps;
   };
 
 } // namespace mitk
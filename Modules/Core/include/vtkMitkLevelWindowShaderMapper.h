@@ -0,0 +1,125 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef vtkMitkLevelWindowShaderMapper_h
+#define vtkMitkLevelWindowShaderMapper_h
+
+#include <MitkCoreExports.h>
+
+#include <vtkImageData.h>
+#include <vtkLookupTable.h>
+#include <vtkOpenGLPolyDataMapper.h>
+#include <vtkSmartPointer.h>
+
+class vtkOpenGLRenderWindow;
+class vtkTextureObject;
+
+/** Documentation
+* \brief Renders a textured plane, applying the level window and lookup table to the raw scalar slice on the GPU.
+*
+* This mapper is the GPU counterpart of vtkMitkLevelWindowFilter for single component
+* slices and linear lookup tables. The scalar values of the slice are uploaded once as
+* floating point texture, the lookup table as a small second texture. The fragment shader
+* maps every texel through the lookup table using its current table range (which is how
+* the level window is set, see ImageVtkMapper2D::ApplyLevelWindow()), applies the clipping
+* bounds and optionally draws the outline of binary images instead of the filled area.
+*
+* Changing the level window or lookup table therefore neither re-executes a filter nor
+* re-uploads the slice. The input polydata must carry texture coordinates spanning the
+* slice (e.g. vtkPlaneSource).
+*
+* If the OpenGL contexts of all render windows share their objects (see SetShareSliceTextures()),
+* mappers rendering the same unmodified slice object, e.g. the slice from the ImageSliceCache that
+* ImageVtkMapper2D displays in several render windows with the same plane geometry, use the
+* texture uploaded by the first of them instead of uploading the slice again.
+*
+* \ingroup Renderer
+*/
+class MITKCORE_EXPORT vtkMitkLevelWindowShaderMapper : public vtkOpenGLPolyDataMapper
+{
+public:
+  static vtkMitkLevelWindowShaderMapper *New();
+  vtkTypeMacro(vtkMitkLevelWindowShaderMapper, vtkOpenGLPolyDataMapper);
+
+  /** \brief True if the slice can be rendered by this mapper (a 2D slice with a single component). */
+  static bool IsSliceSupported(vtkImageData *slice);
+
+  /** \brief True if the lookup table can be applied by this mapper (a vtkLookupTable with linear scale). */
+  static bool IsLookupTableSupported(vtkScalarsToColors *lookupTable);
+
+  /** \brief Share uploaded slice textures between the mappers of different render windows (default: off).
+   *
+   * Only valid if all render windows use OpenGL contexts that share their objects, as set up by
+   * mitk::BaseApplication (Qt::AA_ShareOpenGLContexts).
+   */
+  static void SetShareSliceTextures(bool share);
+  static bool GetShareSliceTextures();
+
+  /** \brief Set the slice, its scalars are uploaded whenever it was modified. */
+  void SetSlice(vtkImageData *slice);
+  vtkImageData *GetSlice() const { return m_Slice; }
+
+  /** \brief Set the lookup table, its table range defines the level window. */
+  void SetImageLookupTable(vtkLookupTable *lookupTable);
+  vtkLookupTable *GetImageLookupTable() const { return m_ImageLookupTable; }
+
+  /** \brief Set clipping bounds (xmin, xmax, ymin, ymax in pixels of the slice), pixels outside are transparent. */
+  void SetClippingBounds(double *bounds);
+
+  /** \brief Interpolate the colors of neighboring pixels, as done by vtkTexture::SetInterpolate(). */
+  void SetTextureInterpolation(bool interpolate);
+
+  /** \brief Only draw the outline of the non-transparent pixels, with the given width in screen pixels
+   * (0: draw the filled pixels). The outline takes the color and opacity of the actor. */
+  void SetOutlineWidth(float width);
+
+  void ReleaseGraphicsResources(vtkWindow *window) override;
+
+protected:
+  vtkMitkLevelWindowShaderMapper();
+  ~vtkMitkLevelWindowShaderMapper() override;
+
+  void ReplaceShaderValues(std::map<vtkShader::Type, vtkShader *> shaders, vtkRenderer *ren, vtkActor *act) override;
+  void SetMapperShaderParameters(vtkOpenGLHelper &cellBO, vtkRenderer *ren, vtkActor *act) override;
+  void RenderPieceStart(vtkRenderer *ren, vtkActor *act) override;
+  void RenderPieceFinish(vtkRenderer *ren, vtkActor *act) override;
+
+private:
+  vtkMitkLevelWindowShaderMapper(const vtkMitkLevelWindowShaderMapper &); // Not implemented.
+  void operator=(const vtkMitkLevelWindowShaderMapper &);                 // Not implemented.
+
+  /** \brief Uploads slice and lookup table if they changed since the last upload, false on failure.
+   * Sets m_ActiveSliceTexture to m_SliceTexture or to a shared texture holding the slice. */
+  bool UploadTextures(vtkRenderer *ren);
+
+  vtkSmartPointer<vtkImageData> m_Slice;
+  vtkSmartPointer<vtkLookupTable> m_ImageLookupTable;
+  vtkSmartPointer<vtkTextureObject> m_SliceTexture;
+  vtkSmartPointer<vtkTextureObject> m_LookupTableTexture;
+  vtkTimeStamp m_SliceUploadTime;
+  vtkTimeStamp m_LookupTableUploadTime;
+  /** \brief Set if the slice or the lookup table object was exchanged or the textures were released */
+  bool m_SliceTextureOutdated;
+  bool m_LookupTableTextureOutdated;
+  /** \brief Texture of the slice that is rendered, possibly uploaded by the mapper of another render window */
+  vtkTextureObject *m_ActiveSliceTexture;
+  /** \brief Render window the textures are bound in from RenderPieceStart() to RenderPieceFinish() */
+  vtkOpenGLRenderWindow *m_ActiveRenderWindow;
+  /** \brief True from RenderPieceStart() to RenderPieceFinish() if both textures are bound */
+  bool m_TexturesActive;
+
+  double m_ClippingBounds[4];
+  bool m_TextureInterpolation;
+  float m_OutlineWidth;
+};
+
+#endif
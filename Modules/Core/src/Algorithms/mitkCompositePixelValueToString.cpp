@@ -72,3 +72,15 @@ std::string mitk::ConvertCompositePixelValueToString(Image::Pointer image, itk::
 
   return string;
 }
+
+std::string mitk::ConvertCompositePixelValueToString(const std::vector<ScalarType> &components)
+{
+  std::ostringstream stream;
+  for (std::size_t i = 0; i < components.size(); ++i)
+  {
+    if (0 != i)
+      stream << "  ";
+    stream << components[i];
+  }
+  return stream.str();
+}
@@ -14,12 +14,211 @@ found in the LICENSE file.
 
 #include <mitkAbstractTransformGeometry.h>
 #include <mitkPlaneClipping.h>
+#include <mitkThreadPool.h>
+#include <mitkTracing.h>
 
 #include <vtkGeneralTransform.h>
 #include <vtkImageChangeInformation.h>
 #include <vtkImageData.h>
 #include <vtkImageExtractComponents.h>
 #include <vtkLinearTransform.h>
+#include <vtkPointData.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+  template <typename T>
+  void ConvertBackgroundLevel(double backgroundLevel, void *pixel)
+  {
+    const double clamped = std::min<double>(
+      std::max<double>(backgroundLevel, std::numeric_limits<T>::lowest()), std::numeric_limits<T>::max());
+    *static_cast<T *>(pixel) = static_cast<T>(clamped);
+  }
+
+  /* Output pixel (i, j) of the slice is sampled at the continuous input index Base + i * StepI + j * StepJ. */
+  struct ResliceGrid
+  {
+    double Base[3];
+    double StepI[3];
+    double StepJ[3];
+    int InputExtent[6];
+    int Width;
+    int Height;
+    int NumberOfComponents;
+    bool Linear;
+  };
+
+  template <typename T>
+  T ConvertInterpolatedValue(double value)
+  {
+    if (std::numeric_limits<T>::is_integer)
+    {
+      value = std::min<double>(std::max<double>(value, std::numeric_limits<T>::lowest()), std::numeric_limits<T>::max());
+      return static_cast<T>(std::floor(value + 0.5));
+    }
+    return static_cast<T>(value);
+  }
+
+  /*
+   * Reslices the rows of the output in parallel. Like vtkImageReslice (with its default border of half
+   * a voxel), points up to half a voxel outside of the input extent are clamped to the border voxels;
+   * all other points are set to the background level. The range of each row which lies inside the input
+   * is computed upfront, so the inner loops do not need to check bounds.
+   */
+  template <typename T>
+  void ResliceKernel(const ResliceGrid &grid, const T *input, double backgroundLevel, T *output)
+  {
+    const int *extent = grid.InputExtent;
+    const int numberOfComponents = grid.NumberOfComponents;
+    const vtkIdType increments[3] = {numberOfComponents,
+                                     numberOfComponents * static_cast<vtkIdType>(extent[1] - extent[0] + 1),
+                                     numberOfComponents * static_cast<vtkIdType>(extent[1] - extent[0] + 1) *
+                                       (extent[3] - extent[2] + 1)};
+    const double border = 0.5;
+
+    T background;
+    ConvertBackgroundLevel<T>(backgroundLevel, &background);
+
+    auto isInside = [&](const double rowStart[3], int i) {
+      for (int d = 0; d < 3; ++d)
+      {
+        const double x = rowStart[d] + i * grid.StepI[d];
+        if (!(x >= extent[2 * d] - border && x <= extent[2 * d + 1] + border))
+          return false;
+      }
+      return true;
+    };
+
+    mitk::ThreadPool::GetInstance().ParallelFor(
+      0,
+      grid.Height,
+      [&](std::size_t beginRow, std::size_t endRow) {
+        for (auto j = static_cast<int>(beginRow); j < static_cast<int>(endRow); ++j)
+        {
+          double rowStart[3];
+          for (int d = 0; d < 3; ++d)
+            rowStart[d] = grid.Base[d] + j * grid.StepJ[d];
+
+          // solve lower <= rowStart + i * step <= upper for i
+          double iMin = 0.0;
+          double iMax = grid.Width - 1.0;
+          for (int d = 0; d < 3; ++d)
+          {
+            const double lower = extent[2 * d] - border - rowStart[d];
+            const double upper = extent[2 * d + 1] + border - rowStart[d];
+            if (grid.StepI[d] == 0.0)
+            {
+              if (lower > 0.0 || upper < 0.0)
+                iMax = -1.0;
+            }
+            else if (grid.StepI[d] > 0.0)
+            {
+              iMin = std::max(iMin, lower / grid.StepI[d]);
+              iMax = std::min(iMax, upper / grid.StepI[d]);
+            }
+            else
+            {
+              iMin = std::max(iMin, upper / grid.StepI[d]);
+              iMax = std::min(iMax, lower / grid.StepI[d]);
+            }
+          }
+
+          int begin = static_cast<int>(std::max(0.0, std::ceil(iMin)));
+          int end = static_cast<int>(std::min(static_cast<double>(grid.Width), std::floor(iMax) + 1.0));
+          if (begin < end)
+          {
+            // make the range consistent with the test of each single point
+            while (begin < end && !isInside(rowStart, begin))
+              ++begin;
+            while (begin > 0 && isInside(rowStart, begin - 1))
+              --begin;
+            while (end > begin && !isInside(rowStart, end - 1))
+              --end;
+            while (end < grid.Width && isInside(rowStart, end))
+              ++end;
+          }
+          else
+          {
+            begin = end = 0;
+          }
+
+          T *outputRow = output + static_cast<vtkIdType>(j) * grid.Width * numberOfComponents;
+          std::fill(outputRow, outputRow + begin * numberOfComponents, background);
+          std::fill(outputRow + end * numberOfComponents, outputRow + grid.Width * numberOfComponents, background);
+
+          if (!grid.Linear)
+          {
+            for (int i = begin; i < end; ++i)
+            {
+              vtkIdType offset = 0;
+              for (int d = 0; d < 3; ++d)
+              {
+                const int index = static_cast<int>(std::floor(rowStart[d] + i * grid.StepI[d] + 0.5));
+                offset += (std::min(std::max(index, extent[2 * d]), extent[2 * d + 1]) - extent[2 * d]) * increments[d];
+              }
+              std::copy(input + offset, input + offset + numberOfComponents, outputRow + i * numberOfComponents);
+            }
+          }
+          else
+          {
+            for (int i = begin; i < end; ++i)
+            {
+              vtkIdType offsets[3][2];
+              double weights[3][2];
+              for (int d = 0; d < 3; ++d)
+              {
+                const double x = rowStart[d] + i * grid.StepI[d];
+                const double floorX = std::floor(x);
+                const int index = static_cast<int>(floorX);
+                weights[d][1] = x - floorX;
+                weights[d][0] = 1.0 - weights[d][1];
+                offsets[d][0] = (std::min(std::max(index, extent[2 * d]), extent[2 * d + 1]) - extent[2 * d]) * increments[d];
+                offsets[d][1] = (std::min(std::max(index + 1, extent[2 * d]), extent[2 * d + 1]) - extent[2 * d]) * increments[d];
+              }
+
+              for (int c = 0; c < numberOfComponents; ++c)
+              {
+                double value = 0.0;
+                for (int z = 0; z < 2; ++z)
+                  for (int y = 0; y < 2; ++y)
+                    for (int x = 0; x < 2; ++x)
+                      value += weights[2][z] * weights[1][y] * weights[0][x] *
+                               input[offsets[2][z] + offsets[1][y] + offsets[0][x] + c];
+                outputRow[i * numberOfComponents + c] = ConvertInterpolatedValue<T>(value);
+              }
+            }
+          }
+        }
+      },
+      8);
+  }
+
+  /* Returns the axis of a (signed) unit step along one of the index axes, -1 otherwise. */
+  int GetUnitStepAxis(const double step[3], int intStep[3])
+  {
+    const double tolerance = 1e-3;
+    int axis = -1;
+    for (int d = 0; d < 3; ++d)
+    {
+      intStep[d] = 0;
+      if (std::abs(std::abs(step[d]) - 1.0) < tolerance)
+      {
+        if (axis != -1)
+          return -1;
+        axis = d;
+        intStep[d] = step[d] > 0 ? 1 : -1;
+      }
+      else if (std::abs(step[d]) >= tolerance)
+      {
+        return -1;
+      }
+    }
+    return axis;
+  }
+}
 
 mitk::ExtractSliceFilter::ExtractSliceFilter(vtkImageReslice *reslicer): m_XMin(0), m_XMax(0), m_YMin(0), m_YMax(0)
 {
@@ -37,6 +236,7 @@ mitk::ExtractSliceFilter::ExtractSliceFilter(vtkImageReslice *reslicer): m_XMin(
   m_InterpolationMode = ExtractSliceFilter::RESLICE_NEAREST;
   m_ResliceTransform = nullptr;
   m_InPlaneResampleExtentByGeometry = false;
+  m_InPlaneDownsamplingFactor = 1;
   m_OutPutSpacing = new mitk::ScalarType[2];
   m_OutputDimension = 2;
   m_ZSpacing = 1.0;
@@ -149,6 +349,12 @@ void mitk::ExtractSliceFilter::GenerateOutputInformation()
   right.Normalize();
   bottom.Normalize();
 
+  if (m_InPlaneDownsamplingFactor > 1)
+  {
+    extent[0] = std::max(1.0, extent[0] / m_InPlaneDownsamplingFactor);
+    extent[1] = std::max(1.0, extent[1] / m_InPlaneDownsamplingFactor);
+  }
+
   m_OutPutSpacing[0] = widthInMM / extent[0];
   m_OutPutSpacing[1] = heightInMM / extent[1];
 
@@ -242,6 +448,7 @@ mitk::ScalarType *mitk::ExtractSliceFilter::GetOutputSpacing()
 
 void mitk::ExtractSliceFilter::GenerateData()
 {
+  MITK_TRACE_SCOPE("Rendering", "ExtractSliceFilter::GenerateData");
   mitk::Image *input = this->GetInput();
 
   if (!input)
@@ -426,13 +633,17 @@ void mitk::ExtractSliceFilter::GenerateData()
 
   m_Reslicer->SetOutputSpacing(m_OutPutSpacing[0], m_OutPutSpacing[1], m_ZSpacing);
 
-  // TODO check the following lines, they are responsible whether vtk error outputs appear or not
-  m_Reslicer->UpdateWholeExtent(); // this produces a bad allocation error for 2D images
-  // m_Reslicer->GetOutput()->UpdateInformation();
-  // m_Reslicer->GetOutput()->SetUpdateExtentToWholeExtent();
+  if (abstractGeometry != nullptr || (!this->GenerateDataFromBrickedVolume(input->GetVtkImageData(m_TimeStep)) &&
+                                      !this->GenerateDataWithResliceKernel(input->GetVtkImageData(m_TimeStep))))
+  {
+    // TODO check the following lines, they are responsible whether vtk error outputs appear or not
+    m_Reslicer->UpdateWholeExtent(); // this produces a bad allocation error for 2D images
+    // m_Reslicer->GetOutput()->UpdateInformation();
+    // m_Reslicer->GetOutput()->SetUpdateExtentToWholeExtent();
 
-  // start the pipeline
-  m_Reslicer->Update();
+    // start the pipeline
+    m_Reslicer->Update();
+  }
   /*================ #END setup vtkImageReslice properties================*/
 
   if (m_VtkOutputRequested)
@@ -495,6 +706,136 @@ void mitk::ExtractSliceFilter::GenerateData()
   }
 }
 
+bool mitk::ExtractSliceFilter::GenerateDataFromBrickedVolume(vtkImageData *inputVtkImage)
+{
+  const mitk::Image *input = this->GetInput();
+  if (m_InterpolationMode != RESLICE_NEAREST || m_OutputDimension != 2 || m_ZMin != m_ZMax ||
+      input->GetDimension() < 3 || !input->GetBrickedLayoutEnabled() || inputVtkImage == nullptr ||
+      inputVtkImage->GetNumberOfScalarComponents() != 1)
+    return false;
+
+  BrickedImageVolume::Pointer brickedVolume = input->GetBrickedVolume(m_TimeStep);
+  if (brickedVolume.IsNull() || brickedVolume->GetPixelSize() != static_cast<size_t>(inputVtkImage->GetScalarSize()))
+    return false;
+
+  double base[3], stepI[3], stepJ[3];
+  this->ComputeInputIndexGrid(inputVtkImage, base, stepI, stepJ);
+
+  int origin[3];
+  for (int d = 0; d < 3; ++d)
+    origin[d] = static_cast<int>(std::floor(base[d] + 0.5));
+
+  int intStepI[3], intStepJ[3];
+  const int axisI = GetUnitStepAxis(stepI, intStepI);
+  const int axisJ = GetUnitStepAxis(stepJ, intStepJ);
+  if (axisI < 0 || axisJ < 0 || axisI == axisJ)
+    return false;
+
+  const int xMax = std::max(0, m_XMax - 1);
+  const int yMax = std::max(0, m_YMax - 1);
+
+  double background[1];
+  switch (inputVtkImage->GetScalarType())
+  {
+    vtkTemplateMacro(ConvertBackgroundLevel<VTK_TT>(m_BackgroundLevel, background));
+    default:
+      return false;
+  }
+
+  vtkImageData *output = m_Reslicer->GetOutput();
+  output->SetExtent(m_XMin, xMax, m_YMin, yMax, m_ZMin, m_ZMax);
+  output->SetOrigin(0.0, 0.0, 0.0);
+  output->SetSpacing(m_OutPutSpacing[0], m_OutPutSpacing[1], m_ZSpacing);
+  output->AllocateScalars(inputVtkImage->GetScalarType(), 1);
+
+  brickedVolume->ExtractSlice(origin,
+                              intStepI,
+                              intStepJ,
+                              static_cast<unsigned int>(xMax - m_XMin + 1),
+                              static_cast<unsigned int>(yMax - m_YMin + 1),
+                              background,
+                              output->GetScalarPointer());
+  return true;
+}
+
+void mitk::ExtractSliceFilter::ComputeInputIndexGrid(vtkImageData *inputVtkImage,
+                                                     double base[3],
+                                                     double stepI[3],
+                                                     double stepJ[3])
+{
+  // map output pixels to continuous input indices exactly like vtkImageReslice does
+  vtkMatrix4x4 *resliceAxes = m_Reslicer->GetResliceAxes();
+  vtkAbstractTransform *resliceTransform = m_Reslicer->GetResliceTransform();
+
+  double inputOrigin[3];
+  double inputSpacing[3];
+  inputVtkImage->GetOrigin(inputOrigin);
+  inputVtkImage->GetSpacing(inputSpacing);
+  if (m_ResliceTransform.IsNotNull())
+    std::fill(inputSpacing, inputSpacing + 3, 1.0); // see unitSpacingImageFilter in GenerateData()
+
+  auto toInputIndex = [&](int i, int j, double index[3]) {
+    const double outputPoint[4] = {i * m_OutPutSpacing[0], j * m_OutPutSpacing[1], m_ZMin * m_ZSpacing, 1.0};
+    double point[4];
+    resliceAxes->MultiplyPoint(outputPoint, point);
+    if (resliceTransform != nullptr)
+    {
+      const double axesPoint[3] = {point[0], point[1], point[2]};
+      resliceTransform->TransformPoint(axesPoint, point);
+    }
+    for (int d = 0; d < 3; ++d)
+      index[d] = (point[d] - inputOrigin[d]) / inputSpacing[d];
+  };
+
+  double nextI[3], nextJ[3];
+  toInputIndex(m_XMin, m_YMin, base);
+  toInputIndex(m_XMin + 1, m_YMin, nextI);
+  toInputIndex(m_XMin, m_YMin + 1, nextJ);
+
+  for (int d = 0; d < 3; ++d)
+  {
+    stepI[d] = nextI[d] - base[d];
+    stepJ[d] = nextJ[d] - base[d];
+  }
+}
+
+bool mitk::ExtractSliceFilter::GenerateDataWithResliceKernel(vtkImageData *inputVtkImage)
+{
+  if ((m_InterpolationMode != RESLICE_NEAREST && m_InterpolationMode != RESLICE_LINEAR) || m_OutputDimension != 2 ||
+      m_ZMin != m_ZMax || inputVtkImage == nullptr || inputVtkImage->GetPointData()->GetScalars() == nullptr)
+    return false;
+
+  // The output pixels are an affine function of the input indices only for linear transforms
+  vtkAbstractTransform *resliceTransform = m_Reslicer->GetResliceTransform();
+  if (resliceTransform != nullptr && vtkLinearTransform::SafeDownCast(resliceTransform) == nullptr)
+    return false;
+
+  ResliceGrid grid;
+  this->ComputeInputIndexGrid(inputVtkImage, grid.Base, grid.StepI, grid.StepJ);
+  inputVtkImage->GetExtent(grid.InputExtent);
+  grid.Width = std::max(0, m_XMax - 1) - m_XMin + 1;
+  grid.Height = std::max(0, m_YMax - 1) - m_YMin + 1;
+  grid.NumberOfComponents = inputVtkImage->GetNumberOfScalarComponents();
+  grid.Linear = m_InterpolationMode == RESLICE_LINEAR;
+
+  vtkImageData *output = m_Reslicer->GetOutput();
+  output->SetExtent(m_XMin, m_XMin + grid.Width - 1, m_YMin, m_YMin + grid.Height - 1, m_ZMin, m_ZMax);
+  output->SetOrigin(0.0, 0.0, 0.0);
+  output->SetSpacing(m_OutPutSpacing[0], m_OutPutSpacing[1], m_ZSpacing);
+  output->AllocateScalars(inputVtkImage->GetScalarType(), grid.NumberOfComponents);
+
+  switch (inputVtkImage->GetScalarType())
+  {
+    vtkTemplateMacro(ResliceKernel<VTK_TT>(grid,
+                                           static_cast<const VTK_TT *>(inputVtkImage->GetScalarPointer()),
+                                           m_BackgroundLevel,
+                                           static_cast<VTK_TT *>(output->GetScalarPointer())));
+    default:
+      return false;
+  }
+  return true;
+}
+
 bool mitk::ExtractSliceFilter::GetClippedPlaneBounds(double bounds[6])
 {
   if (!m_WorldGeometry || !this->GetInput())
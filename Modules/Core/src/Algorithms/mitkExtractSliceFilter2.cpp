@@ -14,12 +14,349 @@ found in the LICENSE file.
 #include <mitkExceptionMacro.h>
 #include <mitkImageAccessByItk.h>
 #include <mitkImageWriteAccessor.h>
+#include <mitkThreadPool.h>
 
-#include <itkBSplineInterpolateImageFunction.h>
+#include <itkCommand.h>
 #include <itkLinearInterpolateImageFunction.h>
 #include <itkNearestNeighborInterpolateImageFunction.h>
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+  /** \brief Quadratic B-spline coefficients of an image volume, computed brick by brick on demand.
+   *
+   * The coefficients of a brick are computed with the recursive prefilter of
+   * itk::BSplineDecompositionImageFilter, applied to the brick grown by a margin on every side.
+   * The influence of a voxel on a coefficient decays with the distance to the power of the filter
+   * pole (|z| < 0.18), so voxels outside of the margin are negligible. ITK truncates its own
+   * filter at a shorter distance.
+   */
+  class BSplineCoefficients
+  {
+  public:
+    static const unsigned int BrickShift = 5;
+    static const unsigned int BrickEdgeLength = 1u << BrickShift;
+    static const unsigned int Margin = 16;
+
+    BSplineCoefficients(const unsigned int dimensions[3], itk::ModifiedTimeType sourceMTime)
+      : m_SourceMTime(sourceMTime)
+    {
+      std::size_t numberOfBricks = 1;
+
+      for (int d = 0; d < 3; ++d)
+      {
+        m_Dimensions[d] = dimensions[d];
+        m_NumberOfBricks[d] = (dimensions[d] + BrickEdgeLength - 1) >> BrickShift;
+        numberOfBricks *= m_NumberOfBricks[d];
+      }
+
+      m_Bricks = std::vector<Brick>(numberOfBricks);
+    }
+
+    itk::ModifiedTimeType GetSourceMTime() const
+    {
+      return m_SourceMTime;
+    }
+
+    bool HasDimensions(const unsigned int dimensions[3]) const
+    {
+      return std::equal(m_Dimensions, m_Dimensions + 3, dimensions);
+    }
+
+    std::size_t GetNumberOfBricks() const
+    {
+      return m_Bricks.size();
+    }
+
+    /** \brief Marks the bricks that Evaluate() reads at the given continuous index. */
+    void MarkRequiredBricks(const double index[3], std::vector<char>& requiredBricks) const
+    {
+      unsigned int lower[3];
+      unsigned int upper[3];
+
+      for (int d = 0; d < 3; ++d)
+      {
+        const long center = static_cast<long>(std::floor(index[d] + 0.5));
+        lower[d] = static_cast<unsigned int>(std::max(center - 1, 0L)) >> BrickShift;
+        upper[d] = static_cast<unsigned int>(std::min(center + 1, static_cast<long>(m_Dimensions[d]) - 1)) >> BrickShift;
+      }
+
+      for (auto z = lower[2]; z <= upper[2]; ++z)
+        for (auto y = lower[1]; y <= upper[1]; ++y)
+          for (auto x = lower[0]; x <= upper[0]; ++x)
+            requiredBricks[x + m_NumberOfBricks[0] * (y + m_NumberOfBricks[1] * z)] = 1;
+    }
+
+    /** \brief Computes the coefficients of all given bricks that were not computed yet, in parallel. */
+    template <typename TPixel>
+    void ComputeBricks(const TPixel* data, const std::vector<std::size_t>& bricks)
+    {
+      mitk::ThreadPool::GetInstance().ParallelFor(0, bricks.size(), [&](std::size_t begin, std::size_t end)
+      {
+        for (auto i = begin; i < end; ++i)
+        {
+          auto& brick = m_Bricks[bricks[i]];
+          std::call_once(brick.Computed, [&]() { this->ComputeBrick(data, bricks[i]); });
+        }
+      });
+    }
+
+    /** \brief Same as itk::BSplineInterpolateImageFunction::EvaluateAtContinuousIndex() with spline order 2.
+     *
+     * All bricks marked by MarkRequiredBricks() for the index must have been computed.
+     */
+    double Evaluate(const double index[3]) const
+    {
+      unsigned int bricks[3][3];
+      unsigned int offsets[3][3];
+      double weights[3][3];
+
+      for (int d = 0; d < 3; ++d)
+      {
+        const long center = static_cast<long>(std::floor(index[d] + 0.5));
+        const double w = index[d] - center;
+
+        weights[d][1] = 0.75 - w * w;
+        weights[d][2] = 0.5 * (w - weights[d][1] + 1.0);
+        weights[d][0] = 1.0 - weights[d][1] - weights[d][2];
+
+        // mirror boundary conditions
+        const long last = static_cast<long>(m_Dimensions[d]) - 1;
+
+        for (int k = 0; k < 3; ++k)
+        {
+          long i = center - 1 + k;
+
+          if (0 == last)
+            i = 0;
+          else if (i < 0)
+            i = -i;
+          else if (i > last)
+            i = 2 * last - i;
+
+          bricks[d][k] = static_cast<unsigned int>(i) >> BrickShift;
+          offsets[d][k] = static_cast<unsigned int>(i) & (BrickEdgeLength - 1);
+        }
+      }
+
+      double value = 0.0;
+
+      for (int z = 0; z < 3; ++z)
+      {
+        for (int y = 0; y < 3; ++y)
+        {
+          double rowValue = 0.0;
+
+          for (int x = 0; x < 3; ++x)
+          {
+            const auto& brick = m_Bricks[bricks[0][x] + m_NumberOfBricks[0] * (bricks[1][y] + m_NumberOfBricks[1] * bricks[2][z])];
+            rowValue += weights[0][x] * brick.Coefficients[offsets[0][x] + BrickEdgeLength * (offsets[1][y] + BrickEdgeLength * offsets[2][z])];
+          }
+
+          value += weights[2][z] * weights[1][y] * rowValue;
+        }
+      }
+
+      return value;
+    }
+
+  private:
+    struct Brick
+    {
+      std::once_flag Computed;
+      std::unique_ptr<double[]> Coefficients;
+    };
+
+    template <typename TPixel>
+    void ComputeBrick(const TPixel* data, std::size_t brickIndex)
+    {
+      std::size_t brickPosition[3] = {
+        brickIndex % m_NumberOfBricks[0],
+        (brickIndex / m_NumberOfBricks[0]) % m_NumberOfBricks[1],
+        brickIndex / (m_NumberOfBricks[0] * m_NumberOfBricks[1])
+      };
+
+      std::size_t lower[3];
+      std::size_t upper[3];
+      std::size_t regionLower[3];
+      std::size_t regionSize[3];
+
+      for (int d = 0; d < 3; ++d)
+      {
+        lower[d] = brickPosition[d] << BrickShift;
+        upper[d] = std::min<std::size_t>(lower[d] + BrickEdgeLength, m_Dimensions[d]);
+        regionLower[d] = lower[d] > Margin ? lower[d] - Margin : 0;
+        regionSize[d] = std::min<std::size_t>(upper[d] + Margin, m_Dimensions[d]) - regionLower[d];
+      }
+
+      std::vector<double> region(regionSize[0] * regionSize[1] * regionSize[2]);
+
+      for (std::size_t z = 0; z < regionSize[2]; ++z)
+      {
+        for (std::size_t y = 0; y < regionSize[1]; ++y)
+        {
+          const auto* source = data + regionLower[0] + m_Dimensions[0] * ((regionLower[1] + y) + static_cast<std::size_t>(m_Dimensions[1]) * (regionLower[2] + z));
+          std::copy(source, source + regionSize[0], region.begin() + regionSize[0] * (y + regionSize[1] * z));
+        }
+      }
+
+      const std::size_t strides[3] = { 1, regionSize[0], regionSize[0] * regionSize[1] };
+      std::vector<double> line;
+
+      for (int d = 0; d < 3; ++d)
+      {
+        const int d1 = (d + 1) % 3;
+        const int d2 = (d + 2) % 3;
+        line.resize(regionSize[d]);
+
+        for (std::size_t j = 0; j < regionSize[d2]; ++j)
+        {
+          for (std::size_t i = 0; i < regionSize[d1]; ++i)
+          {
+            auto* first = region.data() + i * strides[d1] + j * strides[d2];
+
+            for (std::size_t n = 0; n < regionSize[d]; ++n)
+              line[n] = first[n * strides[d]];
+
+            DataToCoefficients(line);
+
+            for (std::size_t n = 0; n < regionSize[d]; ++n)
+              first[n * strides[d]] = line[n];
+          }
+        }
+      }
+
+      auto& brick = m_Bricks[brickIndex];
+      brick.Coefficients.reset(new double[BrickEdgeLength * BrickEdgeLength * BrickEdgeLength]());
+
+      for (auto z = lower[2]; z < upper[2]; ++z)
+      {
+        for (auto y = lower[1]; y < upper[1]; ++y)
+        {
+          const auto source = region.begin() + (lower[0] - regionLower[0]) + regionSize[0] * ((y - regionLower[1]) + regionSize[1] * (z - regionLower[2]));
+          std::copy(source, source + (upper[0] - lower[0]), brick.Coefficients.get() + BrickEdgeLength * ((y - lower[1]) + BrickEdgeLength * (z - lower[2])));
+        }
+      }
+    }
+
+    /** \brief Same as itk::BSplineDecompositionImageFilter::DataToCoefficients1D() with spline order 2. */
+    static void DataToCoefficients(std::vector<double>& c)
+    {
+      const long length = static_cast<long>(c.size());
+
+      if (1 == length)
+        return;
+
+      const double z = std::sqrt(8.0) - 3.0;
+      const double gain = (1.0 - z) * (1.0 - 1.0 / z);
+
+      for (auto& value : c)
+        value *= gain;
+
+      // causal initialization, see itk::BSplineDecompositionImageFilter::SetInitialCausalCoefficient()
+      const long horizon = static_cast<long>(std::ceil(std::log(1e-10) / std::log(std::fabs(z))));
+      double zn = z;
+
+      if (horizon < length)
+      {
+        double sum = c[0];
+
+        for (long n = 1; n < horizon; ++n)
+        {
+          sum += zn * c[n];
+          zn *= z;
+        }
+
+        c[0] = sum;
+      }
+      else
+      {
+        const double iz = 1.0 / z;
+        double z2n = std::pow(z, static_cast<double>(length - 1));
+        double sum = c[0] + z2n * c[length - 1];
+        z2n *= z2n * iz;
+
+        for (long n = 1; n <= length - 2; ++n)
+        {
+          sum += (zn + z2n) * c[n];
+          zn *= z;
+          z2n *= iz;
+        }
+
+        c[0] = sum / (1.0 - zn * zn);
+      }
+
+      for (long n = 1; n < length; ++n)
+        c[n] += z * c[n - 1];
+
+      c[length - 1] = (z / (z * z - 1.0)) * (z * c[length - 2] + c[length - 1]);
+
+      for (long n = length - 2; n >= 0; --n)
+        c[n] = z * (c[n + 1] - c[n]);
+    }
+
+    unsigned int m_Dimensions[3];
+    std::size_t m_NumberOfBricks[3];
+    itk::ModifiedTimeType m_SourceMTime;
+    std::vector<Brick> m_Bricks;
+  };
+
+  /** \brief B-spline coefficients shared by all filters over the same input image.
+   *
+   * Entries are replaced when the image was modified and removed when the image is deleted.
+   */
+  struct BSplineCoefficientsCache
+  {
+    std::mutex Mutex;
+    std::map<const itk::Object*, std::shared_ptr<BSplineCoefficients>> Entries;
+  };
+
+  BSplineCoefficientsCache& GetBSplineCoefficientsCache()
+  {
+    // Never destroyed, since images may be deleted during static deinitialization
+    static auto* cache = new BSplineCoefficientsCache;
+    return *cache;
+  }
+
+  void RemoveBSplineCoefficients(itk::Object* image, const itk::EventObject&, void*)
+  {
+    auto& cache = GetBSplineCoefficientsCache();
+    std::lock_guard<std::mutex> lock(cache.Mutex);
+    cache.Entries.erase(image);
+  }
+
+  std::shared_ptr<BSplineCoefficients> GetBSplineCoefficients(const mitk::Image* image)
+  {
+    const auto mTime = image->GetMTime();
+    const auto* dimensions = image->GetDimensions();
+
+    auto& cache = GetBSplineCoefficientsCache();
+    std::lock_guard<std::mutex> lock(cache.Mutex);
+
+    auto iter = cache.Entries.find(image);
+
+    if (cache.Entries.end() == iter)
+    {
+      auto command = itk::CStyleCommand::New();
+      command->SetCallback(RemoveBSplineCoefficients);
+      image->AddObserver(itk::DeleteEvent(), command);
+
+      iter = cache.Entries.emplace(image, nullptr).first;
+    }
+
+    if (nullptr == iter->second || iter->second->GetSourceMTime() != mTime || !iter->second->HasDimensions(dimensions))
+      iter->second = std::make_shared<BSplineCoefficients>(dimensions, mTime);
+
+    return iter->second;
+  }
+}
 
 struct mitk::ExtractSliceFilter2::Impl
 {
@@ -29,10 +366,12 @@ struct mitk::ExtractSliceFilter2::Impl
   PlaneGeometry::Pointer OutputGeometry;
   mitk::ExtractSliceFilter2::Interpolator Interpolator;
   itk::Object::Pointer InterpolateImageFunction;
+  itk::ModifiedTimeType InterpolateImageFunctionMTime;
 };
 
 mitk::ExtractSliceFilter2::Impl::Impl()
-  : Interpolator(NearestNeighbor)
+  : Interpolator(NearestNeighbor),
+    InterpolateImageFunctionMTime(0)
 {
 }
 
@@ -57,14 +396,6 @@ namespace
         interpolateImageFunction = itk::LinearInterpolateImageFunction<TInputImage>::New().GetPointer();
         break;
 
-      case mitk::ExtractSliceFilter2::Cubic:
-      {
-        auto bSplineInterpolateImageFunction = itk::BSplineInterpolateImageFunction<TInputImage>::New();
-        bSplineInterpolateImageFunction->SetSplineOrder(2);
-        interpolateImageFunction = bSplineInterpolateImageFunction.GetPointer();
-        break;
-      }
-
       default:
         mitkThrow() << "Interplator is unknown.";
     }
@@ -75,7 +406,7 @@ namespace
   }
 
   template <typename TPixel, unsigned int VImageDimension>
-  void GenerateData(const itk::Image<TPixel, VImageDimension>* inputImage, mitk::Image* outputImage, const mitk::ExtractSliceFilter2::OutputImageRegionType& outputRegion, itk::Object* interpolateImageFunction)
+  void GenerateData(const itk::Image<TPixel, VImageDimension>* inputImage, mitk::Image* outputImage, const mitk::ExtractSliceFilter2::OutputImageRegionType& outputRegion, itk::Object* interpolateImageFunction, BSplineCoefficients* coefficients)
   {
     typedef itk::Image<TPixel, VImageDimension> TInputImage;
     typedef itk::InterpolateImageFunction<TInputImage> TInterpolateImageFunction;
@@ -94,42 +425,70 @@ namespace
     auto spacingAlongXDirection = xDirection * spacing[0];
     auto spacingAlongYDirection = yDirection * spacing[1];
 
-    const std::size_t pixelSize = outputImage->GetPixelType().GetSize();
     const std::size_t width = outputGeometry->GetExtent(0);
     const std::size_t xBegin = outputRegion.GetIndex(0);
     const std::size_t yBegin = outputRegion.GetIndex(1);
     const std::size_t xEnd = xBegin + outputRegion.GetSize(0);
     const std::size_t yEnd = yBegin + outputRegion.GetSize(1);
 
+    if (nullptr != coefficients)
+    {
+      // Compute the coefficients of the bricks around the slice that are not cached yet
+      std::vector<char> requiredBricks(coefficients->GetNumberOfBricks(), 0);
+      itk::ContinuousIndex<mitk::ScalarType, 3> index;
+
+      for (std::size_t y = yBegin; y < yEnd; ++y)
+      {
+        mitk::Point3D yPoint = origin + spacingAlongYDirection * y;
+
+        for (std::size_t x = xBegin; x < xEnd; ++x)
+        {
+          if (inputImage->TransformPhysicalPointToContinuousIndex(yPoint + spacingAlongXDirection * x, index))
+            coefficients->MarkRequiredBricks(index.GetDataPointer(), requiredBricks);
+        }
+      }
+
+      std::vector<std::size_t> bricks;
+
+      for (std::size_t i = 0; i < requiredBricks.size(); ++i)
+      {
+        if (0 != requiredBricks[i])
+          bricks.push_back(i);
+      }
+
+      coefficients->ComputeBricks(inputImage->GetBufferPointer(), bricks);
+    }
+
     mitk::ImageWriteAccessor writeAccess(outputImage, nullptr, mitk::ImageAccessorBase::IgnoreLock);
-    auto data = static_cast<char*>(writeAccess.GetData());
+    auto data = static_cast<TPixel*>(writeAccess.GetData());
 
     const TPixel backgroundPixel = std::numeric_limits<TPixel>::lowest();
-    TPixel pixel;
-
-    itk::ContinuousIndex<mitk::ScalarType, 3> index;
-    mitk::Point3D yPoint;
-    mitk::Point3D point;
 
-    for (std::size_t y = yBegin; y < yEnd; ++y)
+    mitk::ThreadPool::GetInstance().ParallelFor(yBegin, yEnd, [&](std::size_t begin, std::size_t end)
     {
-      yPoint = origin + spacingAlongYDirection * y;
+      itk::ContinuousIndex<mitk::ScalarType, 3> index;
 
-      for (std::size_t x = xBegin; x < xEnd; ++x)
+      for (std::size_t y = begin; y < end; ++y)
       {
-        point = yPoint + spacingAlongXDirection * x;
+        mitk::Point3D yPoint = origin + spacingAlongYDirection * y;
 
-        if (inputImage->TransformPhysicalPointToContinuousIndex(point, index))
-        {
-          pixel = interpolator->EvaluateAtContinuousIndex(index);
-          memcpy(static_cast<void*>(data + pixelSize * (width * y + x)), static_cast<const void*>(&pixel), pixelSize);
-        }
-        else
+        for (std::size_t x = xBegin; x < xEnd; ++x)
         {
-          memcpy(static_cast<void*>(data + pixelSize * (width * y + x)), static_cast<const void*>(&backgroundPixel), pixelSize);
+          auto& pixel = data[width * y + x];
+
+          if (inputImage->TransformPhysicalPointToContinuousIndex(yPoint + spacingAlongXDirection * x, index))
+          {
+            pixel = nullptr != coefficients
+              ? static_cast<TPixel>(coefficients->Evaluate(index.GetDataPointer()))
+              : static_cast<TPixel>(interpolator->EvaluateAtContinuousIndex(index));
+          }
+          else
+          {
+            pixel = backgroundPixel;
+          }
         }
       }
-    }
+    }, 8);
   }
 
   void VerifyInputImage(const mitk::Image* inputImage)
@@ -213,17 +572,23 @@ void mitk::ExtractSliceFilter2::ThreadedGenerateData(const OutputImageRegionType
 
 void mitk::ExtractSliceFilter2::GenerateData()
 {
-  if (nullptr != m_Impl->InterpolateImageFunction && this->GetInput()->GetMTime() < this->GetMTime())
-    return;
-
   const auto* inputImage = this->GetInput();
+  std::shared_ptr<BSplineCoefficients> coefficients;
 
-  AccessFixedDimensionByItk_2(inputImage, CreateInterpolateImageFunction, 3, this->GetInterpolator(), m_Impl->InterpolateImageFunction);
+  if (Cubic == this->GetInterpolator())
+  {
+    coefficients = GetBSplineCoefficients(inputImage);
+  }
+  else if (nullptr == m_Impl->InterpolateImageFunction || inputImage->GetMTime() != m_Impl->InterpolateImageFunctionMTime)
+  {
+    AccessFixedDimensionByItk_2(inputImage, CreateInterpolateImageFunction, 3, this->GetInterpolator(), m_Impl->InterpolateImageFunction);
+    m_Impl->InterpolateImageFunctionMTime = inputImage->GetMTime();
+  }
 
   this->AllocateOutputs();
   auto outputRegion = this->GetOutput()->GetLargestPossibleRegion();
 
-  AccessFixedDimensionByItk_3(inputImage, ::GenerateData, 3, this->GetOutput(), outputRegion, m_Impl->InterpolateImageFunction);
+  AccessFixedDimensionByItk_n(inputImage, ::GenerateData, 3, (this->GetOutput(), outputRegion, m_Impl->InterpolateImageFunction.GetPointer(), coefficients.get()));
 }
 
 void mitk::ExtractSliceFilter2::SetInput(const InputImageType* image)
@@ -62,7 +62,9 @@ void InternalCompute(itk::Image<TPixel, VImageDimension> *itkImage,
 
 void mitk::HistogramGenerator::ComputeHistogram()
 {
-  if ((m_Histogram.IsNull()) || (m_Histogram->GetMTime() < m_Image->GetMTime()))
+  // setting another image or size modifies the generator
+  if ((m_Histogram.IsNull()) || (m_Histogram->GetMTime() < m_Image->GetMTime()) ||
+      (m_Histogram->GetMTime() < this->GetMTime()))
   {
     const_cast<mitk::Image *>(m_Image.GetPointer())->SetRequestedRegionToLargestPossibleRegion(); //@todo without this,
                                                                                                   // Image::GetScalarMin
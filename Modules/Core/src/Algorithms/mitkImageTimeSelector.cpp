@@ -67,12 +67,7 @@ void mitk::ImageTimeSelector::GenerateData()
 
   // do we really need a complete volume at a time?
   if (requestedRegion.GetSize(2) > 1)
-  {
-    mitk::ImageDataItem::Pointer im = this->GetVolumeData(m_TimeNr, m_ChannelNr)->Clone();
-    im->SetTimestep(0);
-    im->SetManageMemory(false);
-    this->SetVolumeItem(im, 0);
-  }
+    this->SetVolumeItem(this->GetVolumeData(m_TimeNr, m_ChannelNr), 0);
   else
     // no, so take just a slice!
     this->SetSliceItem(
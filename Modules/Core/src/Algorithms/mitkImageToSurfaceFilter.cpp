@@ -13,18 +13,192 @@ found in the LICENSE file.
 #include "mitkException.h"
 #include <mitkImageToSurfaceFilter.h>
 #include <vtkDecimatePro.h>
-#include <vtkImageChangeInformation.h>
 #include <vtkImageData.h>
 #include <vtkLinearTransform.h>
 #include <vtkMath.h>
 #include <vtkMatrix4x4.h>
 #include <vtkQuadricDecimation.h>
 
+#include <vtkCellArray.h>
 #include <vtkCleanPolyData.h>
+#include <vtkMergePoints.h>
+#include <vtkPointData.h>
 #include <vtkPolyDataNormals.h>
 #include <vtkSmartPointer.h>
 
 #include "mitkProgressBar.h"
+#include "mitkThreadPool.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+  /**
+   * Marching cubes only creates triangles in cells with voxels on both sides of the threshold, so the
+   * bounding box of all voxels with a value of at least the threshold, grown by one voxel, contains the
+   * whole surface. Returns false if there is no such voxel.
+   */
+  template <typename TPixel>
+  bool ComputeForegroundExtent(const TPixel *scalars,
+                               const int *extent,
+                               int numberOfComponents,
+                               double threshold,
+                               int *foregroundExtent)
+  {
+    const vtkIdType dimX = extent[1] - extent[0] + 1;
+    const vtkIdType dimY = extent[3] - extent[2] + 1;
+    const vtkIdType dimZ = extent[5] - extent[4] + 1;
+
+    int result[6] = {static_cast<int>(dimX), -1, static_cast<int>(dimY), -1, static_cast<int>(dimZ), -1};
+    std::mutex mutex;
+
+    mitk::ThreadPool::GetInstance().ParallelFor(0, dimZ, [&](std::size_t begin, std::size_t end) {
+      int local[6] = {static_cast<int>(dimX), -1, static_cast<int>(dimY), -1, static_cast<int>(dimZ), -1};
+      for (auto z = static_cast<vtkIdType>(begin); z < static_cast<vtkIdType>(end); ++z)
+      {
+        for (vtkIdType y = 0; y < dimY; ++y)
+        {
+          const TPixel *row = scalars + (z * dimY + y) * dimX * numberOfComponents;
+
+          vtkIdType first = 0;
+          while (first < dimX && !(static_cast<double>(row[first * numberOfComponents]) >= threshold))
+            ++first;
+          if (first == dimX)
+            continue;
+
+          vtkIdType last = dimX - 1;
+          while (last > first && !(static_cast<double>(row[last * numberOfComponents]) >= threshold))
+            --last;
+
+          local[0] = std::min(local[0], static_cast<int>(first));
+          local[1] = std::max(local[1], static_cast<int>(last));
+          local[2] = std::min(local[2], static_cast<int>(y));
+          local[3] = std::max(local[3], static_cast<int>(y));
+          local[4] = std::min(local[4], static_cast<int>(z));
+          local[5] = std::max(local[5], static_cast<int>(z));
+        }
+      }
+
+      std::lock_guard<std::mutex> lock(mutex);
+      for (int i = 0; i < 6; i += 2)
+      {
+        result[i] = std::min(result[i], local[i]);
+        result[i + 1] = std::max(result[i + 1], local[i + 1]);
+      }
+    });
+
+    if (result[1] < 0)
+      return false;
+
+    for (int i = 0; i < 6; i += 2)
+    {
+      foregroundExtent[i] = std::max(extent[i], extent[i] + result[i] - 1);
+      foregroundExtent[i + 1] = std::min(extent[i + 1], extent[i] + result[i + 1] + 1);
+    }
+    return true;
+  }
+
+  /** Copies a sub-extent of the image into a new image with the same spacing and origin (0, 0, 0). */
+  vtkSmartPointer<vtkImageData> CopyRegion(vtkImageData *image, const char *scalars, int *extent)
+  {
+    const int *imageExtent = image->GetExtent();
+    const vtkIdType dimX = imageExtent[1] - imageExtent[0] + 1;
+    const vtkIdType dimY = imageExtent[3] - imageExtent[2] + 1;
+    const vtkIdType pixelSize = image->GetScalarSize() * image->GetNumberOfScalarComponents();
+    const std::size_t rowSize = (extent[1] - extent[0] + 1) * pixelSize;
+
+    auto region = vtkSmartPointer<vtkImageData>::New();
+    region->SetExtent(extent);
+    region->SetSpacing(image->GetSpacing());
+    region->SetOrigin(0.0, 0.0, 0.0);
+    region->AllocateScalars(image->GetScalarType(), image->GetNumberOfScalarComponents());
+
+    auto *target = static_cast<char *>(region->GetScalarPointer());
+    for (int z = extent[4]; z <= extent[5]; ++z)
+    {
+      for (int y = extent[2]; y <= extent[3]; ++y)
+      {
+        const vtkIdType offset = ((z - imageExtent[4]) * dimY + (y - imageExtent[2])) * dimX + (extent[0] - imageExtent[0]);
+        std::memcpy(target, scalars + offset * pixelSize, rowSize);
+        target += rowSize;
+      }
+    }
+    return region;
+  }
+
+  /**
+   * Joins the surfaces of adjacent slabs. Points are merged in the order they were created, so the result
+   * is the same as running marching cubes over all slabs at once.
+   */
+  vtkSmartPointer<vtkPolyData> MergeSlabs(const std::vector<vtkSmartPointer<vtkPolyData>> &slabs)
+  {
+    if (slabs.size() == 1)
+      return slabs.front();
+
+    auto merged = vtkSmartPointer<vtkPolyData>::New();
+    auto points = vtkSmartPointer<vtkPoints>::New();
+    auto polys = vtkSmartPointer<vtkCellArray>::New();
+    merged->SetPoints(points);
+    merged->SetPolys(polys);
+
+    double bounds[6] = {VTK_DOUBLE_MAX, VTK_DOUBLE_MIN, VTK_DOUBLE_MAX, VTK_DOUBLE_MIN, VTK_DOUBLE_MAX, VTK_DOUBLE_MIN};
+    vtkIdType numberOfPoints = 0;
+    for (const auto &slab : slabs)
+    {
+      if (slab->GetNumberOfPoints() == 0)
+        continue;
+
+      const double *slabBounds = slab->GetBounds();
+      for (int i = 0; i < 6; i += 2)
+      {
+        bounds[i] = std::min(bounds[i], slabBounds[i]);
+        bounds[i + 1] = std::max(bounds[i + 1], slabBounds[i + 1]);
+      }
+      numberOfPoints += slab->GetNumberOfPoints();
+    }
+
+    if (numberOfPoints == 0)
+      return merged;
+
+    auto locator = vtkSmartPointer<vtkMergePoints>::New();
+    locator->InitPointInsertion(points, bounds, numberOfPoints);
+
+    std::vector<vtkIdType> pointIds;
+    for (const auto &slab : slabs)
+    {
+      pointIds.resize(slab->GetNumberOfPoints());
+      for (vtkIdType i = 0; i < slab->GetNumberOfPoints(); ++i)
+        locator->InsertUniquePoint(slab->GetPoint(i), pointIds[i]);
+
+      vtkCellArray *slabPolys = slab->GetPolys();
+      vtkIdType numberOfCellPoints;
+      vtkIdType *cellPoints;
+      for (slabPolys->InitTraversal(); slabPolys->GetNextCell(numberOfCellPoints, cellPoints);)
+      {
+        polys->InsertNextCell(numberOfCellPoints);
+        for (vtkIdType i = 0; i < numberOfCellPoints; ++i)
+          polys->InsertCellPoint(pointIds[cellPoints[i]]);
+      }
+    }
+    return merged;
+  }
+
+  template <typename TCoordinate>
+  void TransformPoints(mitk::ImageToSurfaceFilter *filter, TCoordinate *points, vtkIdType numberOfPoints, double matrix[4][4])
+  {
+    mitk::ThreadPool::GetInstance().ParallelFor(
+      0,
+      numberOfPoints,
+      [filter, points, matrix](std::size_t begin, std::size_t end) {
+        for (auto i = begin; i < end; ++i)
+          filter->mitkVtkLinearTransformPoint(matrix, points + 3 * i, points + 3 * i);
+      },
+      4096);
+  }
+}
 
 mitk::ImageToSurfaceFilter::ImageToSurfaceFilter()
   : m_Smooth(false),
@@ -40,32 +214,75 @@ mitk::ImageToSurfaceFilter::~ImageToSurfaceFilter()
 {
 }
 
+vtkSmartPointer<vtkPolyData> mitk::ImageToSurfaceFilter::CreateIsoSurface(vtkImageData *vtkimage,
+                                                                         const ScalarType threshold)
+{
+  if (vtkimage->GetPointData()->GetScalars() == nullptr)
+    return vtkSmartPointer<vtkPolyData>::New();
+
+  const auto *scalars = static_cast<const char *>(vtkimage->GetScalarPointer());
+
+  // Only the bounding box of the foreground is contoured
+  int extent[6];
+  vtkimage->GetExtent(extent);
+
+  bool hasForeground = true;
+  switch (vtkimage->GetScalarType())
+  {
+    vtkTemplateMacro(hasForeground = ComputeForegroundExtent(reinterpret_cast<const VTK_TT *>(scalars),
+                                                              vtkimage->GetExtent(),
+                                                              vtkimage->GetNumberOfScalarComponents(),
+                                                              threshold,
+                                                              extent));
+  }
+
+  if (!hasForeground)
+    return vtkSmartPointer<vtkPolyData>::New();
+
+  // Split the cells into slabs along z, which are contoured in parallel. Adjacent slabs share one slice.
+  const int numberOfCellSlices = extent[5] - extent[4];
+  const int minimumSlabThickness = 16;
+  const int numberOfSlabs = std::max(1,
+                                     std::min(static_cast<int>(ThreadPool::GetInstance().GetRecommendedNumberOfThreads()),
+                                              numberOfCellSlices / minimumSlabThickness));
+
+  std::vector<vtkSmartPointer<vtkPolyData>> slabs(numberOfSlabs);
+
+  ThreadPool::GetInstance().ParallelFor(0, numberOfSlabs, [&](std::size_t begin, std::size_t end) {
+    for (auto slab = begin; slab < end; ++slab)
+    {
+      int slabExtent[6] = {extent[0], extent[1], extent[2], extent[3], 0, 0};
+      slabExtent[4] = extent[4] + static_cast<int>(slab * numberOfCellSlices / numberOfSlabs);
+      slabExtent[5] = extent[4] + static_cast<int>((slab + 1) * numberOfCellSlices / numberOfSlabs);
+
+      vtkSmartPointer<vtkMarchingCubes> skinExtractor = vtkSmartPointer<vtkMarchingCubes>::New();
+      skinExtractor->ComputeScalarsOff();
+      skinExtractor->ComputeNormalsOff(); // computed for the final surface
+      skinExtractor->SetValue(0, threshold);
+
+      skinExtractor->SetInputData(CopyRegion(vtkimage, scalars, slabExtent));
+      skinExtractor->Update();
+      slabs[slab] = skinExtractor->GetOutput();
+    }
+  });
+
+  return MergeSlabs(slabs);
+}
+
 void mitk::ImageToSurfaceFilter::CreateSurface(int time,
                                                vtkImageData *vtkimage,
                                                mitk::Surface *surface,
                                                const ScalarType threshold)
 {
-  vtkImageChangeInformation *indexCoordinatesImageFilter = vtkImageChangeInformation::New();
-  indexCoordinatesImageFilter->SetInputData(vtkimage);
-  indexCoordinatesImageFilter->SetOutputOrigin(0.0, 0.0, 0.0);
-
-  // MarchingCube -->create Surface
-  vtkSmartPointer<vtkMarchingCubes> skinExtractor = vtkSmartPointer<vtkMarchingCubes>::New();
-  skinExtractor->ComputeScalarsOff();
-  skinExtractor->SetInputConnection(indexCoordinatesImageFilter->GetOutputPort()); // RC++
-  indexCoordinatesImageFilter->Delete();
-  skinExtractor->SetValue(0, threshold);
-
-  vtkPolyData *polydata;
-  skinExtractor->Update();
-  polydata = skinExtractor->GetOutput();
+  vtkSmartPointer<vtkPolyData> isoSurface = this->CreateIsoSurface(vtkimage, threshold);
+  vtkPolyData *polydata = isoSurface;
   polydata->Register(nullptr); // RC++
 
   if (m_Smooth)
   {
     vtkSmoothPolyDataFilter *smoother = vtkSmoothPolyDataFilter::New();
     // read poly1 (poly1 can be the original polygon, or the decimated polygon)
-    smoother->SetInputConnection(skinExtractor->GetOutputPort()); // RC++
+    smoother->SetInputData(polydata); // RC++
     smoother->SetNumberOfIterations(m_SmoothIteration);
     smoother->SetRelaxationFactor(m_SmoothRelaxation);
     smoother->SetFeatureAngle(60);
@@ -131,15 +348,27 @@ void mitk::ImageToSurfaceFilter::CreateSurface(int time,
       for (j = 0; j < 3; ++j)
         matrix[i][j] /= spacing[j];
 
-    unsigned int n = points->GetNumberOfPoints();
-    double point[3];
-
-    for (i = 0; i < n; i++)
+    if (points->GetDataType() == VTK_FLOAT)
+    {
+      TransformPoints(this, static_cast<float *>(points->GetVoidPointer(0)), points->GetNumberOfPoints(), matrix);
+    }
+    else if (points->GetDataType() == VTK_DOUBLE)
+    {
+      TransformPoints(this, static_cast<double *>(points->GetVoidPointer(0)), points->GetNumberOfPoints(), matrix);
+    }
+    else
     {
-      points->GetPoint(i, point);
-      mitkVtkLinearTransformPoint(matrix, point, point);
-      points->SetPoint(i, point);
+      unsigned int n = points->GetNumberOfPoints();
+      double point[3];
+
+      for (i = 0; i < n; i++)
+      {
+        points->GetPoint(i, point);
+        mitkVtkLinearTransformPoint(matrix, point, point);
+        points->SetPoint(i, point);
+      }
     }
+    points->Modified();
     vtkmatrix->Delete();
   }
   ProgressBar::GetInstance()->Progress();
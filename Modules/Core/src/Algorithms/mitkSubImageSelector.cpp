@@ -12,6 +12,25 @@ found in the LICENSE file.
 
 #include "mitkSubImageSelector.h"
 
+namespace
+{
+  // The output references the memory of the input instead of a copy of it, see ImageDataItem::SetSharedView
+  mitk::Image::ImageDataItemPointer CreateSharedView(const mitk::Image *output,
+                                                     const mitk::ImageDataItem *dataItem,
+                                                     int t,
+                                                     unsigned int dimension)
+  {
+    if (dataItem == nullptr)
+      return nullptr;
+
+    mitk::Image::ImageDataItemPointer view =
+      new mitk::ImageDataItem(*dataItem, output->GetImageDescriptor(), t, dimension);
+    view->SetComplete(dataItem->IsComplete());
+    view->SetSharedView(true);
+    return view;
+  }
+}
+
 void mitk::SubImageSelector::SetPosNr(int /*p*/)
 {
 }
@@ -39,7 +58,8 @@ void mitk::SubImageSelector::SetChannelItem(mitk::Image::ImageDataItemPointer da
   mitk::Image::Pointer output = this->GetOutput();
   if (output->IsValidChannel(n) == false)
     return;
-  output->m_Channels[n] = dataItem;
+  output->m_Channels[n] = CreateSharedView(output, dataItem, 0, output->GetDimension());
+  output->m_HasSharedViews = true;
 }
 
 void mitk::SubImageSelector::SetVolumeItem(mitk::Image::ImageDataItemPointer dataItem, int t, int n)
@@ -49,7 +69,8 @@ void mitk::SubImageSelector::SetVolumeItem(mitk::Image::ImageDataItemPointer dat
     return;
   int pos;
   pos = output->GetVolumeIndex(t, n);
-  output->m_Volumes[pos] = dataItem;
+  output->m_Volumes[pos] = CreateSharedView(output, dataItem, t, 3);
+  output->m_HasSharedViews = true;
 }
 
 void mitk::SubImageSelector::SetSliceItem(mitk::Image::ImageDataItemPointer dataItem, int s, int t, int n)
@@ -59,7 +80,8 @@ void mitk::SubImageSelector::SetSliceItem(mitk::Image::ImageDataItemPointer data
     return;
   int pos;
   pos = output->GetSliceIndex(s, t, n);
-  output->m_Slices[pos] = dataItem;
+  output->m_Slices[pos] = CreateSharedView(output, dataItem, t, 2);
+  output->m_HasSharedViews = true;
 }
 
 mitk::SubImageSelector::SubImageSelector()
@@ -12,12 +12,13 @@ found in the LICENSE file.
 
 #include "mitkSurfaceToImageFilter.h"
 #include "mitkImageWriteAccessor.h"
+#include "mitkPixelTypeMultiplex.h"
+#include "mitkThreadPool.h"
 #include "mitkTimeHelper.h"
 #include <mitkImageReadAccessor.h>
 
-#include <vtkImageData.h>
-#include <vtkImageStencil.h>
-#include <vtkPointData.h>
+#include <vtkCellArray.h>
+#include <vtkImageStencilData.h>
 #include <vtkPolyData.h>
 #include <vtkPolyDataNormals.h>
 #include <vtkPolyDataToImageStencil.h>
@@ -25,8 +26,144 @@ found in the LICENSE file.
 #include <vtkTransform.h>
 #include <vtkTransformPolyDataFilter.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace
+{
+  struct VoxelizationTarget
+  {
+    void *Output;
+    const void *Input; // copied into the output inside the surfaces if set
+    vtkIdType Dimensions[3];
+    vtkIdType NumberOfComponents;
+  };
+
+  template <typename TPixel>
+  void FillImage(const mitk::PixelType &, const VoxelizationTarget &target, double value)
+  {
+    auto *output = static_cast<TPixel *>(target.Output);
+    const vtkIdType size =
+      target.Dimensions[0] * target.Dimensions[1] * target.Dimensions[2] * target.NumberOfComponents;
+    std::fill(output, output + size, static_cast<TPixel>(value));
+  }
+
+  template <typename TPixel>
+  void FillStencil(const mitk::PixelType &, const VoxelizationTarget &target, vtkImageStencilData *stencil, double value)
+  {
+    auto *output = static_cast<TPixel *>(target.Output);
+    const auto *input = static_cast<const TPixel *>(target.Input);
+    const auto pixelValue = static_cast<TPixel>(value);
+    const int *extent = stencil->GetExtent();
+
+    for (int z = extent[4]; z <= extent[5]; ++z)
+    {
+      for (int y = extent[2]; y <= extent[3]; ++y)
+      {
+        const vtkIdType rowOffset = (z * target.Dimensions[1] + y) * target.Dimensions[0];
+        int iter = 0;
+        int r1, r2;
+        while (stencil->GetNextExtent(r1, r2, extent[0], extent[1], y, z, iter))
+        {
+          const vtkIdType begin = (rowOffset + r1) * target.NumberOfComponents;
+          const vtkIdType end = (rowOffset + r2 + 1) * target.NumberOfComponents;
+          if (input != nullptr)
+            std::copy(input + begin, input + end, output + begin);
+          else
+            std::fill(output + begin, output + end, pixelValue);
+        }
+      }
+    }
+  }
+
+  /** Transforms the surface into the continuous index coordinates of the image. */
+  vtkSmartPointer<vtkPolyData> TransformToIndexCoordinates(vtkPolyData *polydata,
+                                                           mitk::BaseGeometry *geometry,
+                                                           mitk::BaseGeometry *imageGeometry)
+  {
+    vtkSmartPointer<vtkTransformPolyDataFilter> move = vtkSmartPointer<vtkTransformPolyDataFilter>::New();
+    move->SetInputData(polydata);
+    move->ReleaseDataFlagOn();
+
+    vtkSmartPointer<vtkTransform> transform = vtkSmartPointer<vtkTransform>::New();
+    transform->PostMultiply();
+    transform->Concatenate(geometry->GetVtkTransform()->GetMatrix());
+    transform->Concatenate(imageGeometry->GetVtkTransform()->GetLinearInverse());
+    move->SetTransform(transform);
+
+    vtkSmartPointer<vtkPolyDataNormals> normalsFilter = vtkSmartPointer<vtkPolyDataNormals>::New();
+    normalsFilter->SetFeatureAngle(50);
+    normalsFilter->SetConsistency(1);
+    normalsFilter->SetSplitting(1);
+    normalsFilter->SetFlipNormals(0);
+    normalsFilter->SetInputConnection(move->GetOutputPort());
+    normalsFilter->Update();
+
+    return normalsFilter->GetOutput();
+  }
+
+  /**
+   * Copies the polygons which reach into the z range. The copy is used by one thread only, as traversing
+   * the cells of a vtkPolyData is not thread-safe.
+   */
+  vtkSmartPointer<vtkPolyData> SelectPolygons(vtkPolyData *polydata, double zMin, double zMax)
+  {
+    vtkPoints *points = polydata->GetPoints();
+    vtkCellArray *polys = polydata->GetPolys();
+    const vtkIdType *cells = polys->GetPointer();
+    const vtkIdType numberOfEntries = polys->GetNumberOfConnectivityEntries();
+
+    auto selectedPoints = vtkSmartPointer<vtkPoints>::New();
+    auto selectedPolys = vtkSmartPointer<vtkCellArray>::New();
+    std::vector<vtkIdType> pointMap(points->GetNumberOfPoints(), -1);
+    double point[3];
+
+    for (vtkIdType i = 0; i < numberOfEntries; i += cells[i] + 1)
+    {
+      const vtkIdType numberOfCellPoints = cells[i];
+      const vtkIdType *cellPoints = cells + i + 1;
+
+      double low = VTK_DOUBLE_MAX;
+      double high = VTK_DOUBLE_MIN;
+      for (vtkIdType j = 0; j < numberOfCellPoints; ++j)
+      {
+        points->GetPoint(cellPoints[j], point);
+        low = std::min(low, point[2]);
+        high = std::max(high, point[2]);
+      }
+
+      if (high < zMin || low > zMax)
+        continue;
+
+      selectedPolys->InsertNextCell(numberOfCellPoints);
+      for (vtkIdType j = 0; j < numberOfCellPoints; ++j)
+      {
+        vtkIdType &id = pointMap[cellPoints[j]];
+        if (id < 0)
+        {
+          points->GetPoint(cellPoints[j], point);
+          id = selectedPoints->InsertNextPoint(point);
+        }
+        selectedPolys->InsertCellPoint(id);
+      }
+    }
+
+    auto selection = vtkSmartPointer<vtkPolyData>::New();
+    selection->SetPoints(selectedPoints);
+    selection->SetPolys(selectedPolys);
+    return selection;
+  }
+}
+
 mitk::SurfaceToImageFilter::SurfaceToImageFilter()
-  : m_MakeOutputBinary(false), m_UShortBinaryPixelType(false), m_BackgroundValue(-10000), m_Tolerance(0.0)
+  : m_MakeOutputBinary(false),
+    m_UShortBinaryPixelType(false),
+    m_MakeOutputLabelImage(false),
+    m_BackgroundValue(-10000),
+    m_Tolerance(0.0)
 {
 }
 
@@ -53,7 +190,11 @@ void mitk::SurfaceToImageFilter::GenerateOutputInformation()
   if ((inputImage == nullptr) || (inputImage->IsInitialized() == false) || (inputImage->GetTimeGeometry() == nullptr))
     return;
 
-  if (m_MakeOutputBinary)
+  if (m_MakeOutputLabelImage)
+  {
+    output->Initialize(mitk::MakeScalarPixelType<unsigned short>(), *inputImage->GetTimeGeometry());
+  }
+  else if (m_MakeOutputBinary)
   {
     if (m_UShortBinaryPixelType)
     {
@@ -105,106 +246,133 @@ void mitk::SurfaceToImageFilter::GenerateData()
 void mitk::SurfaceToImageFilter::Stencil3DImage(int time)
 {
   mitk::Image::Pointer output = this->GetOutput();
-  mitk::Image::Pointer binaryImage = mitk::Image::New();
+  const mitk::Image *image = this->GetImage();
+  const mitk::TimeGeometry *imageTimeGeometry = image->GetTimeGeometry();
+  BaseGeometry *imageGeometry = imageTimeGeometry->GetGeometryForTimeStep(time);
 
-  unsigned int size = sizeof(unsigned char);
-  if (m_MakeOutputBinary)
-  {
-    if (m_UShortBinaryPixelType)
-    {
-      binaryImage->Initialize(mitk::MakeScalarPixelType<unsigned short>(), *this->GetImage()->GetTimeGeometry(), 1, 1);
-      size = sizeof(unsigned short);
-    }
-    else
-    {
-      binaryImage->Initialize(mitk::MakeScalarPixelType<unsigned char>(), *this->GetImage()->GetTimeGeometry(), 1, 1);
-    }
-  }
-  else
-  {
-    binaryImage->Initialize(this->GetImage()->GetPixelType(), *this->GetImage()->GetTimeGeometry(), 1, 1);
-    size = this->GetImage()->GetPixelType().GetSize();
-  }
+  // Convert time step from image time-frame to surface time-frame
+  const mitk::TimePointType matchingTimePoint = imageTimeGeometry->TimeStepToTimePoint(time);
 
-  for (unsigned int i = 0; i < binaryImage->GetDimension(); ++i)
+  const unsigned int numberOfSurfaces = this->GetNumberOfSurfaces();
+  std::vector<vtkPolyData *> polydatas(numberOfSurfaces, nullptr);
+  std::vector<BaseGeometry *> geometries(numberOfSurfaces, nullptr);
+  for (unsigned int i = 0; i < numberOfSurfaces; ++i)
   {
-    size *= binaryImage->GetDimension(i);
-  }
-
-  mitk::ImageWriteAccessor accessor(binaryImage);
-  memset(accessor.GetData(), 1, size);
+    const mitk::Surface *surface = this->GetSurface(i);
+    if (surface == nullptr)
+      continue;
 
-  const mitk::TimeGeometry *surfaceTimeGeometry = GetInput()->GetTimeGeometry();
-  const mitk::TimeGeometry *imageTimeGeometry = GetImage()->GetTimeGeometry();
+    const mitk::TimeGeometry *surfaceTimeGeometry = surface->GetTimeGeometry();
+    mitk::TimeStepType surfaceTimeStep = surfaceTimeGeometry->TimePointToTimeStep(matchingTimePoint);
 
-  // Convert time step from image time-frame to surface time-frame
-  mitk::TimePointType matchingTimePoint = imageTimeGeometry->TimeStepToTimePoint(time);
-  mitk::TimeStepType surfaceTimeStep = surfaceTimeGeometry->TimePointToTimeStep(matchingTimePoint);
+    polydatas[i] = surface->GetVtkPolyData(surfaceTimeStep);
+    geometries[i] = surfaceTimeGeometry->GetGeometryForTimeStep(surfaceTimeStep);
+    if (!geometries[i])
+    {
+      geometries[i] = const_cast<mitk::Surface *>(surface)->GetGeometry();
+    }
+  }
 
-  vtkPolyData *polydata = ((mitk::Surface *)GetInput())->GetVtkPolyData(surfaceTimeStep);
-  if (polydata)
+  // Bring all surfaces into index coordinates of the image
+  std::vector<vtkSmartPointer<vtkPolyData>> surfaces(numberOfSurfaces);
+  ThreadPool::GetInstance().ParallelFor(0, numberOfSurfaces, [&](std::size_t begin, std::size_t end) {
+    for (auto i = begin; i < end; ++i)
+    {
+      if (polydatas[i] != nullptr)
+        surfaces[i] = TransformToIndexCoordinates(polydatas[i], geometries[i], imageGeometry);
+    }
+  });
+
+  // Only the bounding boxes of the surfaces are voxelized
+  const unsigned int *dimensions = output->GetDimensions();
+  std::vector<std::array<int, 6>> surfaceExtents(numberOfSurfaces);
+  int zMin = static_cast<int>(dimensions[2]);
+  int zMax = -1;
+  for (unsigned int i = 0; i < numberOfSurfaces; ++i)
   {
-    vtkSmartPointer<vtkTransformPolyDataFilter> move = vtkSmartPointer<vtkTransformPolyDataFilter>::New();
-    move->SetInputData(polydata);
-    move->ReleaseDataFlagOn();
-
-    vtkSmartPointer<vtkTransform> transform = vtkSmartPointer<vtkTransform>::New();
-    BaseGeometry *geometry = surfaceTimeGeometry->GetGeometryForTimeStep(surfaceTimeStep);
-    if (!geometry)
+    if (surfaces[i] == nullptr || surfaces[i]->GetNumberOfPolys() == 0)
     {
-      geometry = GetInput()->GetGeometry();
+      surfaces[i] = nullptr;
+      continue;
     }
-    transform->PostMultiply();
-    transform->Concatenate(geometry->GetVtkTransform()->GetMatrix());
-    // take image geometry into account. vtk-Image information will be changed to unit spacing and zero origin below.
-    BaseGeometry *imageGeometry = imageTimeGeometry->GetGeometryForTimeStep(time);
-    transform->Concatenate(imageGeometry->GetVtkTransform()->GetLinearInverse());
-    move->SetTransform(transform);
 
-    vtkSmartPointer<vtkPolyDataNormals> normalsFilter = vtkSmartPointer<vtkPolyDataNormals>::New();
-    normalsFilter->SetFeatureAngle(50);
-    normalsFilter->SetConsistency(1);
-    normalsFilter->SetSplitting(1);
-    normalsFilter->SetFlipNormals(0);
-    normalsFilter->ReleaseDataFlagOn();
+    const double *bounds = surfaces[i]->GetBounds();
+    auto &extent = surfaceExtents[i];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      extent[2 * axis] = std::max(0, static_cast<int>(std::floor(bounds[2 * axis] - m_Tolerance)));
+      extent[2 * axis + 1] = std::min(static_cast<int>(dimensions[axis]) - 1,
+                                      static_cast<int>(std::ceil(bounds[2 * axis + 1] + m_Tolerance)));
+      if (extent[2 * axis] > extent[2 * axis + 1])
+        surfaces[i] = nullptr;
+    }
 
-    normalsFilter->SetInputConnection(move->GetOutputPort());
+    if (surfaces[i] != nullptr)
+    {
+      zMin = std::min(zMin, extent[4]);
+      zMax = std::max(zMax, extent[5]);
+    }
+  }
 
-    vtkSmartPointer<vtkPolyDataToImageStencil> surfaceConverter = vtkSmartPointer<vtkPolyDataToImageStencil>::New();
-    surfaceConverter->SetTolerance(m_Tolerance);
-    surfaceConverter->ReleaseDataFlagOn();
+  const bool copyInput = !m_MakeOutputBinary && !m_MakeOutputLabelImage;
+  const mitk::PixelType pixelType = output->GetPixelType();
 
-    surfaceConverter->SetInputConnection(normalsFilter->GetOutputPort());
+  mitk::ImageWriteAccessor accessor(output, output->GetVolumeData(time));
+  std::unique_ptr<mitk::ImageReadAccessor> inputAccessor;
+  if (copyInput)
+    inputAccessor.reset(new mitk::ImageReadAccessor(image, image->GetVolumeData(time)));
 
-    vtkImageData *image = m_MakeOutputBinary ? binaryImage->GetVtkImageData() :
-                                               const_cast<mitk::Image *>(this->GetImage())->GetVtkImageData(time);
+  VoxelizationTarget target;
+  target.Output = accessor.GetData();
+  target.Input = copyInput ? inputAccessor->GetData() : nullptr;
+  for (int i = 0; i < 3; ++i)
+    target.Dimensions[i] = dimensions[i];
+  target.NumberOfComponents = pixelType.GetNumberOfComponents();
 
-    // fill the image with foreground voxels:
-    unsigned char inval = 1;
-    vtkIdType count = image->GetNumberOfPoints();
-    for (vtkIdType i = 0; i < count; ++i)
-    {
-      image->GetPointData()->GetScalars()->SetTuple1(i, inval);
-    }
-
-    // Create stencil and use numerical minimum of pixel type as background value
-    vtkSmartPointer<vtkImageStencil> stencil = vtkSmartPointer<vtkImageStencil>::New();
-    stencil->SetInputData(image);
-    stencil->ReverseStencilOff();
-    stencil->ReleaseDataFlagOn();
-    stencil->SetStencilConnection(surfaceConverter->GetOutputPort());
+  const double background = copyInput ? m_BackgroundValue : 0.0;
+  mitkPixelTypeMultiplex2(FillImage, pixelType, target, background);
 
-    stencil->SetBackgroundValue(m_MakeOutputBinary ? 0 : m_BackgroundValue);
-    stencil->Update();
+  if (zMax < zMin)
+    return;
 
-    output->SetVolume(stencil->GetOutput()->GetScalarPointer(), time);
-    MITK_INFO << "stencil ref count: " << stencil->GetReferenceCount() << std::endl;
-  }
-  else
-  {
-    memset(accessor.GetData(), 0, size);
-    output->SetVolume(accessor.GetData(), time);
-  }
+  // Slabs of slices are voxelized in parallel. Surfaces are processed in the order of their index,
+  // so later surfaces overwrite earlier ones in a label image.
+  const double tolerance = m_Tolerance;
+  const bool labelImage = m_MakeOutputLabelImage;
+  ThreadPool::GetInstance().ParallelFor(
+    zMin,
+    zMax + 1,
+    [&](std::size_t begin, std::size_t end) {
+      for (unsigned int i = 0; i < numberOfSurfaces; ++i)
+      {
+        if (surfaces[i] == nullptr)
+          continue;
+
+        int slabExtent[6];
+        std::copy(surfaceExtents[i].begin(), surfaceExtents[i].end(), slabExtent);
+        slabExtent[4] = std::max(slabExtent[4], static_cast<int>(begin));
+        slabExtent[5] = std::min(slabExtent[5], static_cast<int>(end) - 1);
+        if (slabExtent[4] > slabExtent[5])
+          continue;
+
+        vtkSmartPointer<vtkPolyData> slab =
+          SelectPolygons(surfaces[i], slabExtent[4] - 1.0 - tolerance, slabExtent[5] + 1.0 + tolerance);
+        if (slab->GetNumberOfPolys() == 0)
+          continue;
+
+        vtkSmartPointer<vtkPolyDataToImageStencil> surfaceConverter = vtkSmartPointer<vtkPolyDataToImageStencil>::New();
+        surfaceConverter->SetInputData(slab);
+        surfaceConverter->SetTolerance(tolerance);
+        surfaceConverter->SetOutputOrigin(0.0, 0.0, 0.0);
+        surfaceConverter->SetOutputSpacing(1.0, 1.0, 1.0);
+        surfaceConverter->SetOutputWholeExtent(slabExtent);
+        surfaceConverter->Update();
+
+        const double value = labelImage ? i + 1.0 : 1.0;
+        mitkPixelTypeMultiplex3(FillStencil, pixelType, target, surfaceConverter->GetOutput(), value);
+      }
+    },
+    4);
 }
 
 const mitk::Surface *mitk::SurfaceToImageFilter::GetInput(void)
@@ -223,6 +391,27 @@ void mitk::SurfaceToImageFilter::SetInput(const mitk::Surface *input)
   this->ProcessObject::SetNthInput(0, const_cast<mitk::Surface *>(input));
 }
 
+void mitk::SurfaceToImageFilter::SetSurface(unsigned int index, const mitk::Surface *surface)
+{
+  // Input 1 is the image, so additional surfaces start at input 2
+  this->ProcessObject::SetNthInput(index == 0 ? 0 : index + 1, const_cast<mitk::Surface *>(surface));
+}
+
+const mitk::Surface *mitk::SurfaceToImageFilter::GetSurface(unsigned int index)
+{
+  const unsigned int inputIndex = index == 0 ? 0 : index + 1;
+  if (inputIndex >= this->GetNumberOfIndexedInputs())
+    return nullptr;
+
+  return static_cast<const mitk::Surface *>(this->ProcessObject::GetInput(inputIndex));
+}
+
+unsigned int mitk::SurfaceToImageFilter::GetNumberOfSurfaces()
+{
+  const unsigned int numberOfInputs = this->GetNumberOfIndexedInputs();
+  return numberOfInputs > 2 ? numberOfInputs - 1 : std::min(numberOfInputs, 1u);
+}
+
 void mitk::SurfaceToImageFilter::SetImage(const mitk::Image *source)
 {
   this->ProcessObject::SetNthInput(1, const_cast<mitk::Image *>(source));
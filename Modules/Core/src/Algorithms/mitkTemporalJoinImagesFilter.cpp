@@ -12,18 +12,85 @@ found in the LICENSE file.
 
 #include "mitkTemporalJoinImagesFilter.h"
 
+#include <cstring>
 #include <numeric>
 
 #include "mitkArbitraryTimeGeometry.h"
 #include "mitkImageReadAccessor.h"
+#include "mitkImageWriteAccessor.h"
 #include "mitkTemporoSpatialStringProperty.h"
 
+namespace
+{
+  /** Adds the properties of frame pos that are missing in the target. Values of temporo spatial properties are
+   added for the time step of the frame, all other properties keep the values of the first frame.*/
+  void MergeFrameProperties(mitk::PropertyList* target, const mitk::PropertyList* frameList, unsigned int pos)
+  {
+    for (const auto& key : frameList->GetPropertyKeys())
+    {
+      auto prop = target->GetProperty(key);
+      if (prop == nullptr)
+      {
+        target->SetProperty(key, frameList->GetProperty(key)->Clone());
+      }
+      else
+      {
+        auto tempoSpatialProp = dynamic_cast<mitk::TemporoSpatialStringProperty*>(prop);
+        auto oTempoSpatialProp = dynamic_cast<const mitk::TemporoSpatialStringProperty*>(frameList->GetConstProperty(key).GetPointer());
+        if (tempoSpatialProp != nullptr && oTempoSpatialProp != nullptr)
+        {
+          auto availabelSlices = oTempoSpatialProp->GetAvailableSlices(0);
+
+          for (const auto& sliceID : availabelSlices)
+          {
+            tempoSpatialProp->SetValue(pos, sliceID, oTempoSpatialProp->GetValueBySlice(sliceID));
+          }
+        }
+        //other prop types can be ignored, we only use the values of the first frame.
+      }
+    }
+  }
+}
+
 void mitk::TemporalJoinImagesFilter::SetMaxTimeBounds(const TimeBoundsVectorType& timeBounds)
 {
   m_MaxTimeBounds = timeBounds;
   this->Modified();
 }
 
+void mitk::TemporalJoinImagesFilter::SetFrameLoader(const FrameLoaderType& loader, unsigned int numberOfFrames)
+{
+  m_FrameLoader = loader;
+  m_NumberOfFrames = numberOfFrames;
+  this->Modified();
+}
+
+unsigned int mitk::TemporalJoinImagesFilter::GetNumberOfFrames() const
+{
+  if (m_FrameLoader)
+    return m_NumberOfFrames;
+
+  return static_cast<unsigned int>(this->GetNumberOfInputs());
+}
+
+void mitk::TemporalJoinImagesFilter::CheckFrame(const mitk::Image* frame, unsigned int pos) const
+{
+  const auto refInput = this->GetInput();
+
+  if (frame == nullptr)
+  {
+    mitkThrow() << "Cannot fuse images. Image #" << pos << " is missing.";
+  }
+  if (!Equal(*(refInput->GetGeometry()), *(frame->GetGeometry()), mitk::eps, false))
+  {
+    mitkThrow() << "Cannot fuse images. At least image #" << pos << " has another geometry than the first image.";
+  }
+  if (refInput->GetPixelType() != frame->GetPixelType())
+  {
+    mitkThrow() << "Cannot fuse images. At least image #" << pos << " has another pixeltype than the first image.";
+  }
+}
+
 void mitk::TemporalJoinImagesFilter::GenerateInputRequestedRegion()
 {
   Superclass::GenerateInputRequestedRegion();
@@ -39,56 +106,38 @@ void mitk::TemporalJoinImagesFilter::GenerateOutputInformation()
   mitk::Image::ConstPointer input = this->GetInput();
   mitk::Image::Pointer output = this->GetOutput();
 
-  const auto nrOfInputs = this->GetNumberOfInputs();
+  const auto nrOfFrames = this->GetNumberOfFrames();
   auto timeBounds = m_MaxTimeBounds;
 
   if (timeBounds.empty())
   {
-    timeBounds.resize(nrOfInputs);
+    timeBounds.resize(nrOfFrames);
     std::iota(timeBounds.begin(), timeBounds.end(), 1.0);
   }
-  else if(timeBounds.size() != nrOfInputs)
+  else if(timeBounds.size() != nrOfFrames)
   {
-    mitkThrow() << "User defined max time bounds do not match the number if inputs (" << nrOfInputs << "). Size of max timebounds is " << timeBounds.size() << ", but it should be " << nrOfInputs << ".";
+    mitkThrow() << "User defined max time bounds do not match the number if inputs (" << nrOfFrames << "). Size of max timebounds is " << timeBounds.size() << ", but it should be " << nrOfFrames << ".";
   }
 
   timeBounds.insert(timeBounds.begin(), m_FirstMinTimeBound);
 
   auto timeGeo = mitk::ArbitraryTimeGeometry::New();
-  timeGeo->ReserveSpaceForGeometries(nrOfInputs);
+  timeGeo->ReserveSpaceForGeometries(nrOfFrames);
 
-  for (DataObjectPointerArraySizeType pos = 0; pos < nrOfInputs; ++pos)
+  for (unsigned int pos = 0; pos < nrOfFrames; ++pos)
   {
-    timeGeo->AppendNewTimeStepClone(this->GetInput(pos)->GetGeometry(), timeBounds[pos], timeBounds[pos + 1]);
+    // in the streaming mode the frames are not loaded yet, they must have the geometry of the first one anyway
+    const auto frame = m_FrameLoader ? input.GetPointer() : this->GetInput(pos);
+    timeGeo->AppendNewTimeStepClone(frame->GetGeometry(), timeBounds[pos], timeBounds[pos + 1]);
   }
   output->Initialize(input->GetPixelType(), *timeGeo);
 
   auto newPropList = input->GetPropertyList()->Clone();
-  for (DataObjectPointerArraySizeType pos = 1; pos < nrOfInputs; ++pos)
+  if (!m_FrameLoader)
   {
-    const auto otherList = this->GetInput(pos)->GetPropertyList();
-    for (const auto& key : otherList->GetPropertyKeys())
+    for (unsigned int pos = 1; pos < nrOfFrames; ++pos)
     {
-      auto prop = newPropList->GetProperty(key);
-      if (prop == nullptr)
-      {
-        newPropList->SetProperty(key, otherList->GetProperty(key)->Clone());
-      }
-      else
-      {
-        auto tempoSpatialProp = dynamic_cast<mitk::TemporoSpatialStringProperty*>(prop);
-        auto oTempoSpatialProp = dynamic_cast<mitk::TemporoSpatialStringProperty*>(otherList->GetProperty(key));
-        if (prop != nullptr && oTempoSpatialProp != nullptr)
-        {
-          auto availabelSlices = oTempoSpatialProp->GetAvailableSlices(0);
-
-          for (const auto& sliceID : availabelSlices)
-          {
-            tempoSpatialProp->SetValue(pos, sliceID, oTempoSpatialProp->GetValueBySlice(sliceID));
-          }
-        }
-        //other prop types can be ignored, we only use the values of the first frame.
-      }
+      MergeFrameProperties(newPropList, this->GetInput(pos)->GetPropertyList(), pos);
     }
   }
 
@@ -99,24 +148,34 @@ void mitk::TemporalJoinImagesFilter::GenerateOutputInformation()
 void mitk::TemporalJoinImagesFilter::GenerateData()
 {
   mitk::Image::Pointer output = this->GetOutput();
-  mitk::Image::ConstPointer refInput = this->GetInput();
-  const auto nrOfInputs = this->GetNumberOfInputs();
+  const auto nrOfFrames = this->GetNumberOfFrames();
 
-  for (DataObjectPointerArraySizeType pos = 0; pos < nrOfInputs; ++pos)
+  if (!m_FrameLoader)
   {
-    if (!Equal(*(refInput->GetGeometry()), *(this->GetInput(pos)->GetGeometry()), mitk::eps, false))
+    for (unsigned int pos = 0; pos < nrOfFrames; ++pos)
     {
-      mitkThrow() << "Cannot fuse images. At least image #" << pos << " has another geometry than the first image.";
-    }
-    if (refInput->GetPixelType() != this->GetInput(pos)->GetPixelType())
-    {
-      mitkThrow() << "Cannot fuse images. At least image #" << pos << " has another pixeltype than the first image.";
+      this->CheckFrame(this->GetInput(pos), pos);
     }
   }
 
-  for (DataObjectPointerArraySizeType pos = 0; pos < nrOfInputs; ++pos)
+  // Allocate the whole output at once, the frames are copied into their time steps. Otherwise the frames
+  // would be copied again into one block on the first access to the whole output (e.g. when it is saved).
+  output->GetChannelData();
+
+  for (unsigned int pos = 0; pos < nrOfFrames; ++pos)
   {
-    mitk::ImageReadAccessor accessor(this->GetInput(pos));
-    output->SetVolume(accessor.GetData(), pos);
+    mitk::Image::ConstPointer frame = this->GetInput(pos);
+
+    if (m_FrameLoader && pos > 0)
+    {
+      frame = m_FrameLoader(pos);
+      this->CheckFrame(frame, pos);
+      MergeFrameProperties(output->GetPropertyList(), frame->GetPropertyList(), pos);
+    }
+
+    auto volume = output->GetVolumeData(pos);
+    mitk::ImageReadAccessor readAccessor(frame);
+    mitk::ImageWriteAccessor writeAccessor(output, volume);
+    std::memcpy(writeAccessor.GetData(), readAccessor.GetData(), volume->GetSize());
   }
 }
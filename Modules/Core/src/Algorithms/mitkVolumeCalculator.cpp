@@ -12,24 +12,40 @@ found in the LICENSE file.
 
 #include "mitkVolumeCalculator.h"
 #include "mitkImageAccessByItk.h"
-#include <itkImageRegionConstIterator.h>
+#include "mitkThreadPool.h"
 
 #include "mitkImageStatisticsHolder.h"
 
+#include <atomic>
+
+namespace
+{
+  /** Number of voxels counted by one task of the thread pool */
+  const std::size_t VoxelsPerTask = 1 << 16;
+}
+
 template <typename TPixel, unsigned int VImageDimension>
 void mitk::VolumeCalculator::InternalCompute(const itk::Image<TPixel, VImageDimension> *itkImage)
 {
-  itk::ImageRegionConstIterator<itk::Image<TPixel, VImageDimension>> imageIt(itkImage,
-                                                                             itkImage->GetLargestPossibleRegion());
-  unsigned long int count = 0;
-
-  for (imageIt.GoToBegin(); !imageIt.IsAtEnd(); ++imageIt)
-  {
-    if ((int)(imageIt.Get()) >= m_Threshold)
-    {
-      count++;
-    }
-  }
+  const TPixel *buffer = itkImage->GetBufferPointer();
+  const int threshold = m_Threshold;
+  std::atomic<unsigned long int> totalCount(0);
+
+  ThreadPool::GetInstance().ParallelFor(
+    0,
+    itkImage->GetBufferedRegion().GetNumberOfPixels(),
+    [&](std::size_t begin, std::size_t end) {
+      unsigned long int count = 0;
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        if ((int)(buffer[i]) >= threshold)
+          count++;
+      }
+      totalCount += count;
+    },
+    VoxelsPerTask);
+
+  const unsigned long int count = totalCount;
   if (itkImage->GetLargestPossibleRegion().GetImageDimension() == 3)
   {
     m_Volume = count / 1000.0 * itkImage->GetSpacing()[0] * itkImage->GetSpacing()[1] * itkImage->GetSpacing()[2];
@@ -34,6 +34,11 @@ namespace mitk
     m_Implementation = implementation;
   }
 
+  bool CallbackFromGUIThread::IsImplementationRegistered()
+  {
+    return m_Implementation != nullptr;
+  }
+
   void CallbackFromGUIThread::CallThisFromGUIThread(itk::Command *cmd, itk::EventObject *e)
   {
     if (m_Implementation)
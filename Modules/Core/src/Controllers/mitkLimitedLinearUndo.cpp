@@ -13,8 +13,10 @@ found in the LICENSE file.
 #include "mitkLimitedLinearUndo.h"
 #include <mitkRenderingManager.h>
 
+#include <algorithm>
+
 mitk::LimitedLinearUndo::LimitedLinearUndo()
-: m_UndoLimit(0)
+: m_UndoLimit(0), m_MemoryLimit(0), m_NumberOfEvictedItems(0), m_EvictedMemorySize(0)
 {
   // nothing to do
 }
@@ -49,13 +51,8 @@ bool mitk::LimitedLinearUndo::SetOperationEvent(UndoStackItem *stackItem)
     InvokeEvent(RedoEmptyEvent());
   }
 
-  if (0 != m_UndoLimit && m_UndoList.size() == m_UndoLimit)
-  {
-    auto item = m_UndoList.front();
-    m_UndoList.pop_front();
-    delete item;
-  }
   m_UndoList.push_back(operationEvent);
+  this->LimitUndoList();
 
   InvokeEvent(UndoNotEmptyEvent());
 
@@ -182,14 +179,75 @@ void mitk::LimitedLinearUndo::SetUndoLimit(std::size_t undoLimit)
 {
   if (undoLimit != m_UndoLimit)
   {
-    if (m_UndoList.size() > undoLimit)
-    {
-      m_UndoList.erase(m_UndoList.begin(), m_UndoList.end() - undoLimit);
-    }
     m_UndoLimit = undoLimit;
+    this->LimitUndoList();
+  }
+}
+
+std::size_t mitk::LimitedLinearUndo::GetMemoryLimit() const
+{
+  return m_MemoryLimit;
+}
+
+void mitk::LimitedLinearUndo::SetMemoryLimit(std::size_t memoryLimit)
+{
+  if (memoryLimit != m_MemoryLimit)
+  {
+    m_MemoryLimit = memoryLimit;
+    this->LimitUndoList();
   }
 }
 
+std::size_t mitk::LimitedLinearUndo::GetMemorySize() const
+{
+  std::size_t memorySize = 0;
+  for (const UndoStackItem *item : m_UndoList)
+    memorySize += item->GetMemorySize();
+  for (const UndoStackItem *item : m_RedoList)
+    memorySize += item->GetMemorySize();
+  return memorySize;
+}
+
+std::size_t mitk::LimitedLinearUndo::GetNumberOfEvictedItems() const
+{
+  return m_NumberOfEvictedItems;
+}
+
+std::size_t mitk::LimitedLinearUndo::GetEvictedMemorySize() const
+{
+  return m_EvictedMemorySize;
+}
+
+void mitk::LimitedLinearUndo::ResetEvictionStatistics()
+{
+  m_NumberOfEvictedItems = 0;
+  m_EvictedMemorySize = 0;
+}
+
+void mitk::LimitedLinearUndo::LimitUndoList()
+{
+  // the memory of the items is summed up only if there is a memory limit
+  std::size_t memorySize = 0 != m_MemoryLimit ? this->GetMemorySize() : 0;
+
+  while (!m_UndoList.empty())
+  {
+    const bool exceedsUndoLimit = 0 != m_UndoLimit && m_UndoList.size() > m_UndoLimit;
+    const bool exceedsMemoryLimit = 0 != m_MemoryLimit && memorySize > m_MemoryLimit && m_UndoList.size() > 1;
+    if (!exceedsUndoLimit && !exceedsMemoryLimit)
+      break;
+
+    UndoStackItem *item = m_UndoList.front();
+    const std::size_t itemMemorySize = item->GetMemorySize();
+    m_UndoList.pop_front();
+    delete item;
+
+    memorySize -= std::min(memorySize, itemMemorySize);
+    ++m_NumberOfEvictedItems;
+    m_EvictedMemorySize += itemMemorySize;
+  }
+
+}
+
 int mitk::LimitedLinearUndo::GetLastObjectEventIdInList()
 {
   return m_UndoList.back()->GetObjectEventId();
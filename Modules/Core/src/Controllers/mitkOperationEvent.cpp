@@ -72,6 +72,11 @@ void mitk::UndoStackItem::ReverseAndExecute()
   ReverseOperations();
 }
 
+std::size_t mitk::UndoStackItem::GetMemorySize() const
+{
+  return 0;
+}
+
 // ******************** mitk::OperationEvent ********************
 
 mitk::Operation *mitk::OperationEvent::GetOperation()
@@ -148,3 +153,13 @@ bool mitk::OperationEvent::IsValid()
 {
   return !m_Invalid;
 }
+
+std::size_t mitk::OperationEvent::GetMemorySize() const
+{
+  std::size_t memorySize = 0;
+  if (m_Operation != nullptr)
+    memorySize += m_Operation->GetMemorySize();
+  if (m_UndoOperation != nullptr)
+    memorySize += m_UndoOperation->GetMemorySize();
+  return memorySize;
+}
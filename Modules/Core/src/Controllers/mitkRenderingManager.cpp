@@ -41,12 +41,17 @@ namespace mitk
       m_MaxLOD(1),
       m_LODIncreaseBlocked(false),
       m_LODAbortMechanismEnabled(false),
+      m_InteractionCounter(0),
+      m_InteractionStepPending(false),
       m_ClippingPlaneEnabled(false),
+      m_FrameTimeBudget(0.0),
+      m_MaximumNumberOfDeferrals(3),
       m_TimeNavigationController(SliceNavigationController::New()),
       m_DataStorage(nullptr),
       m_ConstrainedPanningZooming(true),
       m_FocusedRenderWindow(nullptr),
-      m_AntiAliasing(AntiAliasing::FastApproximate)
+      m_AntiAliasing(AntiAliasing::FastApproximate),
+      m_RenderClock(itk::RealTimeClock::New())
   {
     m_ShadingEnabled.assign(3, false);
     m_ShadingValues.assign(4, 0.0);
@@ -122,6 +127,7 @@ namespace mitk
     if (renderWindow && (m_RenderWindowList.find(renderWindow) == m_RenderWindowList.end()))
     {
       m_RenderWindowList[renderWindow] = RENDERING_INACTIVE;
+      m_RenderWindowScheduleList[renderWindow] = RenderWindowSchedule();
       m_AllRenderWindows.push_back(renderWindow);
 
       if (m_DataStorage.IsNotNull())
@@ -162,6 +168,8 @@ namespace mitk
   {
     if (m_RenderWindowList.erase(renderWindow))
     {
+      m_RenderWindowScheduleList.erase(renderWindow);
+
       auto callbacks_it = this->m_RenderWindowCallbacksList.find(renderWindow);
       if (callbacks_it != this->m_RenderWindowCallbacksList.end())
       {
@@ -202,6 +210,9 @@ namespace mitk
       return;
     }
 
+    if (m_RenderWindowList[renderWindow] == RENDERING_REQUESTED)
+      ++m_RenderWindowScheduleList[renderWindow].Statistics.NumberOfCoalescedRequests;
+
     m_RenderWindowList[renderWindow] = RENDERING_REQUESTED;
 
     if (!m_UpdatePending)
@@ -242,7 +253,25 @@ namespace mitk
       if (vPR)
         vPR->PrepareRender();
       // Execute rendering
+      const double start = m_RenderClock->GetTimeInSeconds();
       renderWindow->Render();
+      const double renderTime = (m_RenderClock->GetTimeInSeconds() - start) * 1000.0;
+
+      // the window might have been removed while rendering
+      auto scheduleIter = m_RenderWindowScheduleList.find(renderWindow);
+      if (scheduleIter != m_RenderWindowScheduleList.end())
+      {
+        RenderWindowSchedule &schedule = scheduleIter->second;
+        RenderWindowStatistics &statistics = schedule.Statistics;
+        schedule.Deferrals = 0;
+        ++statistics.NumberOfRenders;
+        statistics.LastRenderTime = renderTime;
+        statistics.MaximumRenderTime = std::max(statistics.MaximumRenderTime, renderTime);
+        // exponential moving average, so that the estimate follows changes of the scene
+        statistics.AverageRenderTime = statistics.NumberOfRenders == 1
+                                         ? renderTime
+                                         : 0.8 * statistics.AverageRenderTime + 0.2 * renderTime;
+      }
     }
   }
 
@@ -520,16 +549,100 @@ namespace mitk
   {
     m_UpdatePending = false;
 
-    // Satisfy all pending update requests
-    RenderWindowList::const_iterator it;
-    int i = 0;
-    for (it = m_RenderWindowList.cbegin(); it != m_RenderWindowList.cend(); ++it, ++i)
+    RenderWindowVector pendingRenderWindows;
+    for (auto it = m_RenderWindowList.cbegin(); it != m_RenderWindowList.cend(); ++it)
     {
       if (it->second == RENDERING_REQUESTED)
+        pendingRenderWindows.push_back(it->first);
+    }
+
+    std::stable_sort(pendingRenderWindows.begin(),
+                     pendingRenderWindows.end(),
+                     [this](vtkRenderWindow *a, vtkRenderWindow *b) { return this->IsScheduledBefore(a, b); });
+
+    // Satisfy the pending update requests within the frame time budget
+    const double start = m_RenderClock->GetTimeInSeconds();
+    bool deferred = false;
+    for (auto renderWindow : pendingRenderWindows)
+    {
+      // rendering a window might remove or satisfy the requests of others
+      auto it = m_RenderWindowList.find(renderWindow);
+      if (it == m_RenderWindowList.end() || it->second != RENDERING_REQUESTED)
+        continue;
+
+      RenderWindowSchedule &schedule = m_RenderWindowScheduleList[renderWindow];
+      if (m_FrameTimeBudget > 0.0 && renderWindow != pendingRenderWindows.front() &&
+          schedule.Deferrals < m_MaximumNumberOfDeferrals)
       {
-        this->ForceImmediateUpdate(it->first);
+        const double elapsedTime = (m_RenderClock->GetTimeInSeconds() - start) * 1000.0;
+        if (elapsedTime + schedule.Statistics.AverageRenderTime > m_FrameTimeBudget)
+        {
+          ++schedule.Deferrals;
+          ++schedule.Statistics.NumberOfDeferrals;
+          deferred = true;
+          continue;
+        }
       }
+
+      this->ForceImmediateUpdate(renderWindow);
     }
+
+    // ForceImmediateUpdate() resets the flag, so the deferred windows need a new request event
+    if (deferred)
+    {
+      m_UpdatePending = true;
+      this->GenerateRenderingRequestEvent();
+    }
+  }
+
+  bool RenderingManager::IsScheduledBefore(vtkRenderWindow *a, vtkRenderWindow *b) const
+  {
+    if ((a == m_FocusedRenderWindow) != (b == m_FocusedRenderWindow))
+      return a == m_FocusedRenderWindow;
+
+    const RenderWindowSchedule &scheduleA = m_RenderWindowScheduleList.at(a);
+    const RenderWindowSchedule &scheduleB = m_RenderWindowScheduleList.at(b);
+    if (scheduleA.Priority != scheduleB.Priority)
+      return scheduleA.Priority > scheduleB.Priority;
+
+    // windows which were deferred before catch up first
+    if (scheduleA.Deferrals != scheduleB.Deferrals)
+      return scheduleA.Deferrals > scheduleB.Deferrals;
+
+    const bool is2DA = BaseRenderer::GetInstance(a) != nullptr &&
+                       BaseRenderer::GetInstance(a)->GetMapperID() == BaseRenderer::Standard2D;
+    const bool is2DB = BaseRenderer::GetInstance(b) != nullptr &&
+                       BaseRenderer::GetInstance(b)->GetMapperID() == BaseRenderer::Standard2D;
+    return is2DA && !is2DB;
+  }
+
+  RenderingManager::RenderWindowStatistics RenderingManager::GetRenderWindowStatistics(
+    vtkRenderWindow *renderWindow) const
+  {
+    auto it = m_RenderWindowScheduleList.find(renderWindow);
+    if (it == m_RenderWindowScheduleList.cend())
+      return RenderWindowStatistics();
+
+    return it->second.Statistics;
+  }
+
+  void RenderingManager::ResetRenderWindowStatistics()
+  {
+    for (auto &schedule : m_RenderWindowScheduleList)
+      schedule.second.Statistics = RenderWindowStatistics();
+  }
+
+  void RenderingManager::SetRenderWindowPriority(vtkRenderWindow *renderWindow, int priority)
+  {
+    auto it = m_RenderWindowScheduleList.find(renderWindow);
+    if (it != m_RenderWindowScheduleList.end())
+      it->second.Priority = priority;
+  }
+
+  int RenderingManager::GetRenderWindowPriority(vtkRenderWindow *renderWindow) const
+  {
+    auto it = m_RenderWindowScheduleList.find(renderWindow);
+    return it != m_RenderWindowScheduleList.cend() ? it->second.Priority : 0;
   }
 
   void RenderingManager::RenderingStartCallback(vtkObject *caller, unsigned long, void *, void *)
@@ -627,8 +740,38 @@ namespace mitk
     }
   }
 
+  void RenderingManager::StartInteraction() { ++m_InteractionCounter; }
+
+  void RenderingManager::EndInteraction()
+  {
+    if (m_InteractionCounter > 0 && --m_InteractionCounter == 0)
+    {
+      // render the final state at full quality
+      this->RequestUpdateAll(REQUEST_UPDATE_2DWINDOWS);
+    }
+  }
+
+  void RenderingManager::NotifyInteractionStep()
+  {
+    if (!m_InteractionStepPending)
+    {
+      m_InteractionStepPending = true;
+      this->StartInteraction();
+    }
+    this->StartOrResetTimer();
+  }
+
+  bool RenderingManager::IsInteractionInProgress() const { return m_InteractionCounter > 0; }
+
   void RenderingManager::ExecutePendingHighResRenderingRequest()
   {
+    // the timer fired without a further interaction step in between
+    if (m_InteractionStepPending)
+    {
+      m_InteractionStepPending = false;
+      this->EndInteraction();
+    }
+
     RenderWindowList::const_iterator it;
     for (it = m_RenderWindowList.cbegin(); it != m_RenderWindowList.cend(); ++it)
     {
@@ -689,6 +832,10 @@ namespace mitk
     this->SetProperty("coupled-zoom", BoolProperty::New(false));
     this->SetProperty("coupled-plane-rotation", BoolProperty::New(false));
     this->SetProperty("MIP-slice-rendering", BoolProperty::New(false));
+    this->SetProperty("interaction-LOD-slice-rendering", BoolProperty::New(false));
+    this->SetProperty("interaction-LOD-downsampling", IntProperty::New(2));
+    this->SetProperty("shader-level-window-rendering", BoolProperty::New(false));
+    this->SetProperty("slice-prefetching", IntProperty::New(0));
   }
 
   PropertyList::Pointer RenderingManager::GetPropertyList() const { return m_PropertyList; }
@@ -0,0 +1,392 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkThreadPool.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+
+namespace
+{
+  // The pool and index of the worker running on the current thread, and the
+  // priority of the task it is running.
+  thread_local const mitk::ThreadPool *t_Pool = nullptr;
+  thread_local std::size_t t_WorkerIndex = 0;
+  thread_local mitk::ThreadPool::Priority t_Priority = mitk::ThreadPool::Priority::Background;
+
+  unsigned int GetDefaultNumberOfThreads()
+  {
+    const char *size = std::getenv("MITK_THREAD_POOL_SIZE");
+
+    if (nullptr != size)
+    {
+      auto numberOfThreads = std::strtoul(size, nullptr, 10);
+
+      if (0 < numberOfThreads)
+        return static_cast<unsigned int>(numberOfThreads);
+    }
+
+    return std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  struct ParallelForState
+  {
+    mitk::ThreadPool::RangeTask Function;
+    std::size_t Begin;
+    std::size_t Size;
+    std::size_t NumberOfChunks;
+
+    std::atomic<std::size_t> NextChunk;
+    std::atomic<bool> Failed;
+
+    std::mutex Mutex;
+    std::condition_variable Condition;
+    std::size_t NumberOfCompletedChunks;
+    std::exception_ptr Exception;
+
+    ParallelForState()
+      : Begin(0),
+        Size(0),
+        NumberOfChunks(0),
+        NextChunk(0),
+        Failed(false),
+        NumberOfCompletedChunks(0)
+    {
+    }
+
+    void Work()
+    {
+      const auto quotient = Size / NumberOfChunks;
+      const auto remainder = Size % NumberOfChunks;
+
+      for (auto chunk = NextChunk++; chunk < NumberOfChunks; chunk = NextChunk++)
+      {
+        if (!Failed)
+        {
+          auto begin = Begin + chunk * quotient + std::min(chunk, remainder);
+          auto end = begin + quotient + (chunk < remainder ? 1 : 0);
+
+          try
+          {
+            Function(begin, end);
+          }
+          catch (...)
+          {
+            std::lock_guard<std::mutex> lock(Mutex);
+
+            if (!Exception)
+              Exception = std::current_exception();
+
+            Failed = true;
+          }
+        }
+
+        std::lock_guard<std::mutex> lock(Mutex);
+
+        if (++NumberOfCompletedChunks == NumberOfChunks)
+          Condition.notify_all();
+      }
+    }
+  };
+}
+
+mitk::ThreadPool::CancellationToken::CancellationToken()
+  : m_Canceled(std::make_shared<std::atomic<bool>>(false))
+{
+}
+
+void mitk::ThreadPool::CancellationToken::Cancel()
+{
+  *m_Canceled = true;
+}
+
+bool mitk::ThreadPool::CancellationToken::IsCanceled() const
+{
+  return *m_Canceled;
+}
+
+mitk::ThreadPool &mitk::ThreadPool::GetInstance()
+{
+  // Intentionally leaked: joining threads during static destruction can dead-lock.
+  static auto instance = new ThreadPool(GetDefaultNumberOfThreads());
+  return *instance;
+}
+
+mitk::ThreadPool::ThreadPool(unsigned int numberOfThreads)
+  : m_NumberOfPendingTasks(0),
+    m_NumberOfIdleThreads(0),
+    m_Stop(false)
+{
+  if (0 == numberOfThreads)
+    numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+
+  for (decltype(numberOfThreads) i = 0; i < numberOfThreads; ++i)
+    m_Workers.emplace_back(new Worker);
+
+  for (std::size_t i = 0; i < m_Workers.size(); ++i)
+    m_Workers[i]->Thread = std::thread(&ThreadPool::Run, this, i);
+}
+
+mitk::ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stop = true;
+  }
+
+  m_Condition.notify_all();
+
+  for (auto &worker : m_Workers)
+    worker->Thread.join();
+}
+
+std::future<void> mitk::ThreadPool::Submit(Task task, Priority priority, const CancellationToken &token)
+{
+  Item item;
+  item.Function = std::move(task);
+  item.Token = token;
+  item.TaskPriority = priority;
+
+  auto future = item.Promise.get_future();
+  const auto queue = static_cast<std::size_t>(priority);
+
+  if (this->IsWorkerThread())
+  {
+    auto &worker = *m_Workers[t_WorkerIndex];
+
+    {
+      std::lock_guard<std::mutex> lock(worker.Mutex);
+      worker.Queues[queue].push_back(std::move(item));
+    }
+
+    // Count the task while holding the pool mutex, so that no worker misses it
+    // between checking the count and waiting.
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    ++m_NumberOfPendingTasks;
+  }
+  else
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Queues[queue].push_back(std::move(item));
+    ++m_NumberOfPendingTasks;
+  }
+
+  m_Condition.notify_one();
+
+  return future;
+}
+
+void mitk::ThreadPool::Wait(const std::future<void> &future)
+{
+  if (!this->IsWorkerThread())
+  {
+    future.wait();
+    return;
+  }
+
+  while (std::future_status::ready != future.wait_for(std::chrono::seconds(0)))
+  {
+    Item item;
+
+    if (this->TryTake(item))
+    {
+      this->Execute(item);
+    }
+    else
+    {
+      future.wait_for(std::chrono::milliseconds(1));
+    }
+  }
+}
+
+void mitk::ThreadPool::ParallelFor(std::size_t begin, std::size_t end, const RangeTask &task, std::size_t grainSize, Priority priority)
+{
+  if (end <= begin)
+    return;
+
+  const auto size = end - begin;
+  const auto isWorkerThread = this->IsWorkerThread();
+
+  std::size_t numberOfHelpers = isWorkerThread
+    ? this->GetNumberOfIdleThreads()
+    : this->GetNumberOfThreads() - 1;
+
+  // A few chunks per thread balance the load of uneven sub-ranges
+  const auto numberOfChunks = std::min(size / std::max<std::size_t>(1, grainSize), 4 * (numberOfHelpers + 1));
+
+  if (1 >= numberOfChunks || 0 == numberOfHelpers)
+  {
+    task(begin, end);
+    return;
+  }
+
+  numberOfHelpers = std::min(numberOfHelpers, numberOfChunks - 1);
+
+  auto state = std::make_shared<ParallelForState>();
+  state->Function = task;
+  state->Begin = begin;
+  state->Size = size;
+  state->NumberOfChunks = numberOfChunks;
+
+  if (isWorkerThread)
+    priority = t_Priority;
+
+  CancellationToken token;
+
+  for (std::size_t i = 0; i < numberOfHelpers; ++i)
+    this->Submit([state]() { state->Work(); }, priority, token);
+
+  state->Work();
+
+  {
+    std::unique_lock<std::mutex> lock(state->Mutex);
+    state->Condition.wait(lock, [&state]() { return state->NumberOfCompletedChunks == state->NumberOfChunks; });
+  }
+
+  // Helpers which did not start yet would not find any chunk
+  token.Cancel();
+
+  if (state->Exception)
+    std::rethrow_exception(state->Exception);
+}
+
+unsigned int mitk::ThreadPool::GetNumberOfThreads() const
+{
+  return static_cast<unsigned int>(m_Workers.size());
+}
+
+unsigned int mitk::ThreadPool::GetNumberOfIdleThreads() const
+{
+  return m_NumberOfIdleThreads;
+}
+
+bool mitk::ThreadPool::IsWorkerThread() const
+{
+  return this == t_Pool;
+}
+
+unsigned int mitk::ThreadPool::GetRecommendedNumberOfThreads() const
+{
+  return this->IsWorkerThread()
+    ? this->GetNumberOfIdleThreads() + 1
+    : this->GetNumberOfThreads();
+}
+
+void mitk::ThreadPool::Run(std::size_t workerIndex)
+{
+  t_Pool = this;
+  t_WorkerIndex = workerIndex;
+
+  for (;;)
+  {
+    Item item;
+
+    if (this->TryTake(item))
+    {
+      this->Execute(item);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+    ++m_NumberOfIdleThreads;
+    m_Condition.wait(lock, [this]() { return m_Stop || 0 < m_NumberOfPendingTasks; });
+    --m_NumberOfIdleThreads;
+
+    if (m_Stop && 0 == m_NumberOfPendingTasks)
+      return;
+  }
+}
+
+bool mitk::ThreadPool::TryTake(Item &item)
+{
+  if (0 == m_NumberOfPendingTasks)
+    return false;
+
+  const auto isWorkerThread = this->IsWorkerThread();
+  const auto numberOfWorkers = m_Workers.size();
+  const std::size_t firstVictim = isWorkerThread ? t_WorkerIndex + 1 : 0;
+
+  for (std::size_t queue = 0; queue < 3; ++queue)
+  {
+    // Own tasks are taken last in, first out to keep their data in the cache
+    if (isWorkerThread)
+    {
+      auto &worker = *m_Workers[t_WorkerIndex];
+      std::lock_guard<std::mutex> lock(worker.Mutex);
+
+      if (!worker.Queues[queue].empty())
+      {
+        item = std::move(worker.Queues[queue].back());
+        worker.Queues[queue].pop_back();
+        --m_NumberOfPendingTasks;
+        return true;
+      }
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+
+      if (!m_Queues[queue].empty())
+      {
+        item = std::move(m_Queues[queue].front());
+        m_Queues[queue].pop_front();
+        --m_NumberOfPendingTasks;
+        return true;
+      }
+    }
+
+    // Steal the oldest task of another worker
+    for (std::size_t i = 0; i < numberOfWorkers; ++i)
+    {
+      const auto victimIndex = (firstVictim + i) % numberOfWorkers;
+
+      if (isWorkerThread && victimIndex == t_WorkerIndex)
+        continue;
+
+      auto &victim = *m_Workers[victimIndex];
+      std::lock_guard<std::mutex> lock(victim.Mutex);
+
+      if (!victim.Queues[queue].empty())
+      {
+        item = std::move(victim.Queues[queue].front());
+        victim.Queues[queue].pop_front();
+        --m_NumberOfPendingTasks;
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+void mitk::ThreadPool::Execute(Item &item)
+{
+  const auto previousPriority = t_Priority;
+  t_Priority = item.TaskPriority;
+
+  try
+  {
+    if (!item.Token.IsCanceled())
+      item.Function();
+
+    item.Promise.set_value();
+  }
+  catch (...)
+  {
+    item.Promise.set_exception(std::current_exception());
+  }
+
+  t_Priority = previousPriority;
+}
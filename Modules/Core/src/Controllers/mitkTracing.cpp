@@ -0,0 +1,377 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTracing.h"
+
+#include <mitkLogMacros.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+std::atomic<bool> mitk::Tracing::s_Enabled(false);
+
+namespace
+{
+  struct TraceEvent
+  {
+    const char *Category;
+    const char *Name;
+    char Phase;
+    unsigned int ThreadIndex;
+    double Timestamp;
+    /** Duration of complete events, value of counter samples */
+    double Value;
+    std::string Args;
+  };
+
+  // Keeps the last events, overwriting the oldest ones once it is full
+  struct EventRing
+  {
+    std::vector<TraceEvent> Events;
+    std::size_t Next = 0;
+
+    void Add(TraceEvent &&event, std::size_t maximumNumberOfEvents)
+    {
+      if (Events.size() < maximumNumberOfEvents)
+      {
+        Events.push_back(std::move(event));
+        return;
+      }
+
+      if (Next >= Events.size())
+        Next = 0;
+      Events[Next++] = std::move(event);
+    }
+
+    void Clear()
+    {
+      Events.clear();
+      Next = 0;
+    }
+  };
+
+  // The events of one thread, its mutex is only contended while the events are exported
+  struct ThreadBuffer
+  {
+    std::mutex Mutex;
+    EventRing Ring;
+    unsigned int ThreadIndex = 0;
+  };
+
+  struct TraceState
+  {
+    std::chrono::steady_clock::time_point Origin = std::chrono::steady_clock::now();
+    std::atomic<std::size_t> MaximumNumberOfEvents{65536};
+    std::atomic<unsigned int> NextThreadIndex{0};
+
+    std::mutex Mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> Buffers;
+    /** Events of finished threads, e.g. of the worker threads of ITK filters */
+    EventRing RetiredEvents;
+    std::vector<mitk::Tracing::Counter *> Counters;
+
+    std::shared_ptr<ThreadBuffer> CreateBuffer()
+    {
+      auto buffer = std::make_shared<ThreadBuffer>();
+      buffer->ThreadIndex = NextThreadIndex++;
+
+      std::lock_guard<std::mutex> lock(Mutex);
+      Buffers.push_back(buffer);
+      return buffer;
+    }
+
+    void RetireBuffer(const std::shared_ptr<ThreadBuffer> &buffer)
+    {
+      std::lock_guard<std::mutex> lock(Mutex);
+      Buffers.erase(std::remove(Buffers.begin(), Buffers.end(), buffer), Buffers.end());
+
+      std::lock_guard<std::mutex> bufferLock(buffer->Mutex);
+      for (auto &event : buffer->Ring.Events)
+        RetiredEvents.Add(std::move(event), MaximumNumberOfEvents);
+    }
+  };
+
+  TraceState &GetTraceState()
+  {
+    // never destroyed, threads may record until the process ends
+    static auto *state = new TraceState;
+    return *state;
+  }
+
+  struct ThreadBufferHolder
+  {
+    std::shared_ptr<ThreadBuffer> Buffer;
+
+    ~ThreadBufferHolder()
+    {
+      if (Buffer)
+        GetTraceState().RetireBuffer(Buffer);
+    }
+  };
+
+  ThreadBuffer &GetThreadBuffer()
+  {
+    thread_local ThreadBufferHolder holder;
+    if (!holder.Buffer)
+      holder.Buffer = GetTraceState().CreateBuffer();
+    return *holder.Buffer;
+  }
+
+  void AddEvent(const char *category, const char *name, char phase, double timestamp, double value, std::string &&args)
+  {
+    ThreadBuffer &buffer = GetThreadBuffer();
+    const std::size_t maximumNumberOfEvents = GetTraceState().MaximumNumberOfEvents;
+
+    std::lock_guard<std::mutex> lock(buffer.Mutex);
+    buffer.Ring.Add({category, name, phase, buffer.ThreadIndex, timestamp, value, std::move(args)},
+                    maximumNumberOfEvents);
+  }
+
+  std::string EscapeJson(const std::string &str)
+  {
+    std::string result;
+    result.reserve(str.size());
+
+    for (const auto c : str)
+    {
+      switch (c)
+      {
+        case '"':
+          result += "\\\"";
+          break;
+
+        case '\\':
+          result += "\\\\";
+          break;
+
+        case '\n':
+          result += "\\n";
+          break;
+
+        case '\t':
+          result += "\\t";
+          break;
+
+        default:
+          result += static_cast<unsigned char>(c) < 0x20 ? ' ' : c;
+          break;
+      }
+    }
+
+    return result;
+  }
+
+  int GetProcessId()
+  {
+#ifdef _WIN32
+    return _getpid();
+#else
+    return static_cast<int>(getpid());
+#endif
+  }
+
+  void WriteEvent(std::ostream &stream, const TraceEvent &event, int pid)
+  {
+    stream << "{\"name\": \"" << EscapeJson(event.Name) << "\", \"cat\": \"" << EscapeJson(event.Category)
+           << "\", \"ph\": \"" << event.Phase << "\", \"ts\": " << event.Timestamp << ", \"pid\": " << pid
+           << ", \"tid\": " << event.ThreadIndex;
+
+    switch (event.Phase)
+    {
+      case 'X':
+        stream << ", \"dur\": " << event.Value;
+        break;
+
+      case 'C':
+        stream << ", \"args\": {\"value\": " << event.Value << "}},\n";
+        return;
+
+      default:
+        stream << ", \"s\": \"t\"";
+        break;
+    }
+
+    if (!event.Args.empty())
+      stream << ", \"args\": {" << event.Args << '}';
+
+    stream << "},\n";
+  }
+}
+
+mitk::Tracing::Counter::Counter(const char *category, const char *name)
+  : m_Category(category), m_Name(name), m_Value(0)
+{
+  auto &state = GetTraceState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  state.Counters.push_back(this);
+}
+
+mitk::Tracing::Counter::~Counter()
+{
+  auto &state = GetTraceState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  state.Counters.erase(std::remove(state.Counters.begin(), state.Counters.end(), this), state.Counters.end());
+}
+
+void mitk::Tracing::SetEnabled(bool enabled)
+{
+  if (enabled == IsEnabled())
+    return;
+
+  if (enabled)
+    Clear();
+
+  s_Enabled.store(enabled);
+}
+
+double mitk::Tracing::Now()
+{
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - GetTraceState().Origin)
+    .count();
+}
+
+void mitk::Tracing::AddCompleteEvent(const char *category, const char *name, double begin, double end, std::string args)
+{
+  if (IsEnabled())
+    AddEvent(category, name, 'X', begin, std::max(0.0, end - begin), std::move(args));
+}
+
+void mitk::Tracing::AddInstantEvent(const char *category, const char *name, std::string args)
+{
+  if (IsEnabled())
+    AddEvent(category, name, 'i', Now(), 0.0, std::move(args));
+}
+
+void mitk::Tracing::AddCounterSample(const char *category, const char *name, double value)
+{
+  if (IsEnabled())
+    AddEvent(category, name, 'C', Now(), value, std::string());
+}
+
+std::string mitk::Tracing::MakeArg(const char *key, const std::string &value)
+{
+  return "\"" + EscapeJson(key) + "\": \"" + EscapeJson(value) + "\"";
+}
+
+void mitk::Tracing::SetMaximumNumberOfEvents(std::size_t numberOfEvents)
+{
+  // the rings only grow up to the new maximum, so they are cleared to apply it
+  GetTraceState().MaximumNumberOfEvents = std::max<std::size_t>(1, numberOfEvents);
+  Clear();
+}
+
+std::size_t mitk::Tracing::GetMaximumNumberOfEvents()
+{
+  return GetTraceState().MaximumNumberOfEvents;
+}
+
+std::size_t mitk::Tracing::GetNumberOfEvents()
+{
+  auto &state = GetTraceState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+
+  std::size_t numberOfEvents = state.RetiredEvents.Events.size();
+  for (const auto &buffer : state.Buffers)
+  {
+    std::lock_guard<std::mutex> bufferLock(buffer->Mutex);
+    numberOfEvents += buffer->Ring.Events.size();
+  }
+  return numberOfEvents;
+}
+
+std::vector<std::pair<std::string, std::int64_t>> mitk::Tracing::GetCounterValues()
+{
+  auto &state = GetTraceState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+
+  std::vector<std::pair<std::string, std::int64_t>> values;
+  for (const auto *counter : state.Counters)
+    values.emplace_back(std::string(counter->GetCategory()) + '/' + counter->GetName(), counter->GetValue());
+
+  return values;
+}
+
+void mitk::Tracing::Clear()
+{
+  auto &state = GetTraceState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+
+  state.RetiredEvents.Clear();
+  for (const auto &buffer : state.Buffers)
+  {
+    std::lock_guard<std::mutex> bufferLock(buffer->Mutex);
+    buffer->Ring.Clear();
+  }
+
+  for (auto *counter : state.Counters)
+    counter->Reset();
+}
+
+void mitk::Tracing::WriteChromeTrace(std::ostream &stream)
+{
+  auto &state = GetTraceState();
+  const int pid = GetProcessId();
+  const double now = Now();
+
+  stream.precision(15);
+  stream << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+
+  {
+    std::lock_guard<std::mutex> lock(state.Mutex);
+
+    for (const auto &event : state.RetiredEvents.Events)
+      WriteEvent(stream, event, pid);
+
+    for (const auto &buffer : state.Buffers)
+    {
+      std::lock_guard<std::mutex> bufferLock(buffer->Mutex);
+      for (const auto &event : buffer->Ring.Events)
+        WriteEvent(stream, event, pid);
+    }
+
+    // the counters are written as samples of their current value
+    for (const auto *counter : state.Counters)
+    {
+      if (counter->GetValue() != 0)
+      {
+        WriteEvent(stream,
+                   {counter->GetCategory(), counter->GetName(), 'C', 0, now, static_cast<double>(counter->GetValue()), ""},
+                   pid);
+      }
+    }
+  }
+
+  stream << "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": " << pid
+         << ", \"tid\": 0, \"args\": {\"name\": \"MITK\"}}\n]}\n";
+}
+
+bool mitk::Tracing::WriteChromeTrace(const std::string &filePath)
+{
+  std::ofstream file(filePath.c_str(), std::ios::out | std::ios::trunc);
+  if (!file)
+  {
+    MITK_WARN << "Cannot write the trace to \"" << filePath << "\".";
+    return false;
+  }
+
+  WriteChromeTrace(file);
+  return static_cast<bool>(file);
+}
@@ -33,6 +33,7 @@ mitk::BaseGeometry::BaseGeometry()
     mitk::OperationActor(),
     m_FrameOfReferenceID(0),
     m_IndexToWorldTransformLastModified(0),
+    m_TransformCacheMTime(0),
     m_ImageGeometry(false),
     m_ModifiedLockFlag(false),
     m_ModifiedCalledFlag(false)
@@ -46,6 +47,7 @@ mitk::BaseGeometry::BaseGeometry(const BaseGeometry &other)
     mitk::OperationActor(),
     m_FrameOfReferenceID(other.m_FrameOfReferenceID),
     m_IndexToWorldTransformLastModified(other.m_IndexToWorldTransformLastModified),
+    m_TransformCacheMTime(0),
     m_ImageGeometry(other.m_ImageGeometry),
     m_ModifiedLockFlag(false),
     m_ModifiedCalledFlag(false)
@@ -419,44 +421,163 @@ bool mitk::BaseGeometry::IsIndexInside(const mitk::Point3D &index) const
 
 void mitk::BaseGeometry::WorldToIndex(const mitk::Point3D &pt_mm, mitk::Point3D &pt_units) const
 {
-  mitk::Vector3D tempIn, tempOut;
-  const TransformType::OffsetType &offset = this->GetIndexToWorldTransform()->GetOffset();
-  tempIn = pt_mm.GetVectorFromOrigin() - offset;
+  this->WorldToIndex(&pt_mm, &pt_units, 1);
+}
 
-  WorldToIndex(tempIn, tempOut);
+void mitk::BaseGeometry::WorldToIndex(const mitk::Vector3D &vec_mm, mitk::Vector3D &vec_units) const
+{
+  const TransformCache &cache = this->GetTransformCache();
 
-  pt_units = tempOut;
+  if (!cache.IsInvertible)
+  {
+    itkExceptionMacro("Internal ITK matrix inversion error, cannot proceed. Matrix was: "
+                      << std::endl
+                      << this->GetIndexToWorldTransform()->GetMatrix());
+  }
+  const mitk::Vector3D vec = vec_mm;
+
+  for (int i = 0; i < 3; ++i)
+  {
+    vec_units[i] = cache.WorldToIndexMatrix[i][0] * vec[0] + cache.WorldToIndexMatrix[i][1] * vec[1] +
+                   cache.WorldToIndexMatrix[i][2] * vec[2];
+  }
 }
 
-void mitk::BaseGeometry::WorldToIndex(const mitk::Vector3D &vec_mm, mitk::Vector3D &vec_units) const
+void mitk::BaseGeometry::WorldToIndex(const mitk::Point3D *pts_mm, mitk::Point3D *pts_units, std::size_t numberOfPoints) const
 {
-  // Get WorldToIndex transform
-  if (m_IndexToWorldTransformLastModified != this->GetIndexToWorldTransform()->GetMTime())
+  const TransformCache &cache = this->GetTransformCache();
+
+  if (!cache.IsInvertible)
   {
-    if (!m_InvertedTransform)
+    itkExceptionMacro("Internal ITK matrix inversion error, cannot proceed. Matrix was: "
+                      << std::endl
+                      << this->GetIndexToWorldTransform()->GetMatrix());
+  }
+
+  if (cache.IsAxisAligned)
+  {
+    const ScalarType scale[3] = {
+      cache.WorldToIndexMatrix[0][0], cache.WorldToIndexMatrix[1][1], cache.WorldToIndexMatrix[2][2]};
+
+    for (std::size_t n = 0; n < numberOfPoints; ++n)
     {
-      m_InvertedTransform = TransformType::New();
+      for (int i = 0; i < 3; ++i)
+        pts_units[n][i] = (pts_mm[n][i] - cache.Offset[i]) * scale[i];
     }
-    if (!this->GetIndexToWorldTransform()->GetInverse(m_InvertedTransform.GetPointer()))
+  }
+  else
+  {
+    for (std::size_t n = 0; n < numberOfPoints; ++n)
     {
-      itkExceptionMacro("Internal ITK matrix inversion error, cannot proceed.");
+      const ScalarType vec[3] = {
+        pts_mm[n][0] - cache.Offset[0], pts_mm[n][1] - cache.Offset[1], pts_mm[n][2] - cache.Offset[2]};
+
+      for (int i = 0; i < 3; ++i)
+      {
+        pts_units[n][i] = cache.WorldToIndexMatrix[i][0] * vec[0] + cache.WorldToIndexMatrix[i][1] * vec[1] +
+                          cache.WorldToIndexMatrix[i][2] * vec[2];
+      }
     }
-    m_IndexToWorldTransformLastModified = this->GetIndexToWorldTransform()->GetMTime();
+  }
+}
+
+void mitk::BaseGeometry::IndexToWorld(const mitk::Point3D *pts_units, mitk::Point3D *pts_mm, std::size_t numberOfPoints) const
+{
+  const TransformCache &cache = this->GetTransformCache();
+
+  if (cache.IsAxisAligned)
+  {
+    const ScalarType scale[3] = {
+      cache.IndexToWorldMatrix[0][0], cache.IndexToWorldMatrix[1][1], cache.IndexToWorldMatrix[2][2]};
+
+    for (std::size_t n = 0; n < numberOfPoints; ++n)
+    {
+      for (int i = 0; i < 3; ++i)
+        pts_mm[n][i] = pts_units[n][i] * scale[i] + cache.Offset[i];
+    }
+  }
+  else
+  {
+    for (std::size_t n = 0; n < numberOfPoints; ++n)
+    {
+      const ScalarType index[3] = {pts_units[n][0], pts_units[n][1], pts_units[n][2]};
+
+      for (int i = 0; i < 3; ++i)
+      {
+        pts_mm[n][i] = cache.IndexToWorldMatrix[i][0] * index[0] + cache.IndexToWorldMatrix[i][1] * index[1] +
+                       cache.IndexToWorldMatrix[i][2] * index[2] + cache.Offset[i];
+      }
+    }
+  }
+}
+
+bool mitk::BaseGeometry::IsIndexToWorldTransformAxisAligned() const
+{
+  return this->GetTransformCache().IsAxisAligned;
+}
+
+const mitk::BaseGeometry::TransformCache &mitk::BaseGeometry::GetTransformCache() const
+{
+  const TransformType *transform = this->GetIndexToWorldTransform();
+
+  if (m_TransformCacheMTime.load(std::memory_order_acquire) == transform->GetMTime())
+    return m_TransformCache;
+
+  std::lock_guard<std::mutex> lock(m_TransformCacheMutex);
+
+  if (m_TransformCacheMTime.load(std::memory_order_relaxed) == transform->GetMTime())
+    return m_TransformCache;
+
+  const TransformType::MatrixType &matrix = transform->GetMatrix();
+  const TransformType::OffsetType &offset = transform->GetOffset();
+  m_TransformCache.IsAxisAligned = true;
+
+  for (int i = 0; i < 3; ++i)
+  {
+    m_TransformCache.Offset[i] = offset[i];
+
+    for (int j = 0; j < 3; ++j)
+    {
+      m_TransformCache.IndexToWorldMatrix[i][j] = matrix[i][j];
+
+      if (i != j && matrix[i][j] != 0.0)
+        m_TransformCache.IsAxisAligned = false;
+    }
+
+    if (matrix[i][i] == 0.0)
+      m_TransformCache.IsAxisAligned = false;
+  }
+
+  // Get WorldToIndex transform. A singular matrix is only reported by WorldToIndex, IndexToWorld stays valid.
+  m_TransformCache.IsInvertible = true;
+  if (!m_InvertedTransform || m_IndexToWorldTransformLastModified != transform->GetMTime())
+  {
+    if (!m_InvertedTransform)
+    {
+      m_InvertedTransform = TransformType::New();
+    }
+    m_TransformCache.IsInvertible = transform->GetInverse(m_InvertedTransform.GetPointer());
+    m_IndexToWorldTransformLastModified = transform->GetMTime();
   }
 
   // Check for valid matrix inversion
   const TransformType::MatrixType &inverse = m_InvertedTransform->GetMatrix();
-  if (inverse.GetVnlMatrix().has_nans())
+  m_TransformCache.IsInvertible = m_TransformCache.IsInvertible && !inverse.GetVnlMatrix().has_nans();
+
+  for (int i = 0; i < 3; ++i)
   {
-    itkExceptionMacro("Internal ITK matrix inversion error, cannot proceed. Matrix was: "
-                      << std::endl
-                      << this->GetIndexToWorldTransform()->GetMatrix()
-                      << "Suggested inverted matrix is:"
-                      << std::endl
-                      << inverse);
+    for (int j = 0; j < 3; ++j)
+    {
+      // the exact reciprocal of the spacing for axis-aligned matrices, the inversion may leave rounding noise
+      if (m_TransformCache.IsAxisAligned)
+        m_TransformCache.WorldToIndexMatrix[i][j] = i == j ? 1.0 / matrix[i][i] : 0.0;
+      else
+        m_TransformCache.WorldToIndexMatrix[i][j] = inverse[i][j];
+    }
   }
 
-  vec_units = inverse * vec_mm;
+  m_TransformCacheMTime.store(transform->GetMTime(), std::memory_order_release);
+  return m_TransformCache;
 }
 
 void mitk::BaseGeometry::WorldToIndex(const mitk::Point3D & /*atPt3d_mm*/,
@@ -510,12 +631,19 @@ void mitk::BaseGeometry::Translate(const Vector3D &vector)
 
 void mitk::BaseGeometry::IndexToWorld(const mitk::Point3D &pt_units, mitk::Point3D &pt_mm) const
 {
-  pt_mm = this->GetIndexToWorldTransform()->TransformPoint(pt_units);
+  this->IndexToWorld(&pt_units, &pt_mm, 1);
 }
 
 void mitk::BaseGeometry::IndexToWorld(const mitk::Vector3D &vec_units, mitk::Vector3D &vec_mm) const
 {
-  vec_mm = this->GetIndexToWorldTransform()->TransformVector(vec_units);
+  const TransformCache &cache = this->GetTransformCache();
+  const mitk::Vector3D vec = vec_units;
+
+  for (int i = 0; i < 3; ++i)
+  {
+    vec_mm[i] = cache.IndexToWorldMatrix[i][0] * vec[0] + cache.IndexToWorldMatrix[i][1] * vec[1] +
+                cache.IndexToWorldMatrix[i][2] * vec[2];
+  }
 }
 
 void mitk::BaseGeometry::ExecuteOperation(Operation *operation)
@@ -0,0 +1,212 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkBrickedImageVolume.h"
+
+#include "mitkExceptionMacro.h"
+#include "mitkImage.h"
+#include "mitkImageReadAccessor.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+  template <typename TPixel>
+  void CopySectionTile(const mitk::BrickedImageVolume *volume,
+                       const int origin[3],
+                       const int stepI[3],
+                       const int stepJ[3],
+                       unsigned int width,
+                       unsigned int iBegin,
+                       unsigned int iEnd,
+                       unsigned int jBegin,
+                       unsigned int jEnd,
+                       const void *background,
+                       void *buffer)
+  {
+    const unsigned int *dimensions = volume->GetDimensions();
+    const TPixel backgroundValue = *static_cast<const TPixel *>(background);
+    auto *output = static_cast<TPixel *>(buffer);
+
+    for (unsigned int j = jBegin; j < jEnd; ++j)
+    {
+      TPixel *outputRow = output + static_cast<size_t>(j) * width;
+      for (unsigned int i = iBegin; i < iEnd; ++i)
+      {
+        const int x = origin[0] + static_cast<int>(i) * stepI[0] + static_cast<int>(j) * stepJ[0];
+        const int y = origin[1] + static_cast<int>(i) * stepI[1] + static_cast<int>(j) * stepJ[1];
+        const int z = origin[2] + static_cast<int>(i) * stepI[2] + static_cast<int>(j) * stepJ[2];
+
+        if (x < 0 || y < 0 || z < 0 || static_cast<unsigned int>(x) >= dimensions[0] ||
+            static_cast<unsigned int>(y) >= dimensions[1] || static_cast<unsigned int>(z) >= dimensions[2])
+        {
+          outputRow[i] = backgroundValue;
+        }
+        else
+        {
+          outputRow[i] = *static_cast<const TPixel *>(volume->GetPixel(x, y, z));
+        }
+      }
+    }
+  }
+
+  void CopySectionTileGeneric(const mitk::BrickedImageVolume *volume,
+                              const int origin[3],
+                              const int stepI[3],
+                              const int stepJ[3],
+                              unsigned int width,
+                              unsigned int iBegin,
+                              unsigned int iEnd,
+                              unsigned int jBegin,
+                              unsigned int jEnd,
+                              const void *background,
+                              void *buffer)
+  {
+    const unsigned int *dimensions = volume->GetDimensions();
+    const size_t pixelSize = volume->GetPixelSize();
+    auto *output = static_cast<unsigned char *>(buffer);
+
+    for (unsigned int j = jBegin; j < jEnd; ++j)
+    {
+      for (unsigned int i = iBegin; i < iEnd; ++i)
+      {
+        const int x = origin[0] + static_cast<int>(i) * stepI[0] + static_cast<int>(j) * stepJ[0];
+        const int y = origin[1] + static_cast<int>(i) * stepI[1] + static_cast<int>(j) * stepJ[1];
+        const int z = origin[2] + static_cast<int>(i) * stepI[2] + static_cast<int>(j) * stepJ[2];
+
+        const void *source = background;
+        if (x >= 0 && y >= 0 && z >= 0 && static_cast<unsigned int>(x) < dimensions[0] &&
+            static_cast<unsigned int>(y) < dimensions[1] && static_cast<unsigned int>(z) < dimensions[2])
+        {
+          source = volume->GetPixel(x, y, z);
+        }
+        std::memcpy(output + (static_cast<size_t>(j) * width + i) * pixelSize, source, pixelSize);
+      }
+    }
+  }
+}
+
+mitk::BrickedImageVolume::BrickedImageVolume() : m_PixelSize(0), m_BrickShift(0), m_SourceMTime(0)
+{
+  std::fill(m_Dimensions, m_Dimensions + 3, 0u);
+  std::fill(m_NumberOfBricks, m_NumberOfBricks + 2, 0);
+}
+
+mitk::BrickedImageVolume::~BrickedImageVolume()
+{
+}
+
+void mitk::BrickedImageVolume::Initialize(const void *data,
+                                          const unsigned int dimensions[3],
+                                          size_t pixelSize,
+                                          unsigned int brickEdgeLength)
+{
+  m_BrickShift = 0;
+  while ((1u << m_BrickShift) < std::max(brickEdgeLength, 1u))
+    ++m_BrickShift;
+  const unsigned int edge = 1u << m_BrickShift;
+
+  std::copy(dimensions, dimensions + 3, m_Dimensions);
+  m_PixelSize = pixelSize;
+  m_SourceMTime = 0;
+
+  size_t numberOfBricks[3];
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    numberOfBricks[i] = (std::max(dimensions[i], 1u) + edge - 1) >> m_BrickShift;
+  }
+  m_NumberOfBricks[0] = numberOfBricks[0];
+  m_NumberOfBricks[1] = numberOfBricks[1];
+
+  const size_t numberOfVoxels = (numberOfBricks[0] * numberOfBricks[1] * numberOfBricks[2]) << (3 * m_BrickShift);
+  m_Data.assign(numberOfVoxels * pixelSize, 0);
+
+  // copy row segments: a row of one brick is contiguous in both layouts
+  const auto *source = static_cast<const unsigned char *>(data);
+  for (unsigned int z = 0; z < dimensions[2]; ++z)
+  {
+    for (unsigned int y = 0; y < dimensions[1]; ++y)
+    {
+      const unsigned char *sourceRow = source + (static_cast<size_t>(z) * dimensions[1] + y) * dimensions[0] * pixelSize;
+      for (unsigned int x = 0; x < dimensions[0]; x += edge)
+      {
+        const unsigned int length = std::min(edge, dimensions[0] - x);
+        std::memcpy(&m_Data[this->GetPixelOffset(x, y, z) * pixelSize], sourceRow + x * pixelSize, length * pixelSize);
+      }
+    }
+  }
+
+  this->Modified();
+}
+
+void mitk::BrickedImageVolume::Initialize(const Image *image, int t, int n, unsigned int brickEdgeLength)
+{
+  if (image == nullptr || !image->IsVolumeSet(t, n))
+  {
+    mitkThrow() << "Cannot create a bricked copy of volume " << t << " of channel " << n << ": volume is not set.";
+  }
+
+  ImageDataItem::Pointer volume = image->GetVolumeData(t, n);
+  ImageReadAccessor accessor(image, volume.GetPointer());
+
+  unsigned int dimensions[3];
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    dimensions[i] = i < image->GetDimension() ? image->GetDimension(i) : 1;
+  }
+
+  this->Initialize(accessor.GetData(), dimensions, image->GetPixelType().GetSize(), brickEdgeLength);
+  m_SourceMTime = image->GetMTime();
+}
+
+void mitk::BrickedImageVolume::ExtractSlice(const int origin[3],
+                                            const int stepI[3],
+                                            const int stepJ[3],
+                                            unsigned int width,
+                                            unsigned int height,
+                                            const void *background,
+                                            void *buffer) const
+{
+  const unsigned int edge = this->GetBrickEdgeLength();
+
+  // process the section in tiles of one brick edge, a tile is then covered by at most 2x2 bricks
+  for (unsigned int jBegin = 0; jBegin < height; jBegin += edge)
+  {
+    const unsigned int jEnd = std::min(jBegin + edge, height);
+    for (unsigned int iBegin = 0; iBegin < width; iBegin += edge)
+    {
+      const unsigned int iEnd = std::min(iBegin + edge, width);
+      switch (m_PixelSize)
+      {
+        case 1:
+          CopySectionTile<unsigned char>(
+            this, origin, stepI, stepJ, width, iBegin, iEnd, jBegin, jEnd, background, buffer);
+          break;
+        case 2:
+          CopySectionTile<unsigned short>(
+            this, origin, stepI, stepJ, width, iBegin, iEnd, jBegin, jEnd, background, buffer);
+          break;
+        case 4:
+          CopySectionTile<unsigned int>(
+            this, origin, stepI, stepJ, width, iBegin, iEnd, jBegin, jEnd, background, buffer);
+          break;
+        case 8:
+          CopySectionTile<unsigned long long>(
+            this, origin, stepI, stepJ, width, iBegin, iEnd, jBegin, jEnd, background, buffer);
+          break;
+        default:
+          CopySectionTileGeneric(this, origin, stepI, stepJ, width, iBegin, iEnd, jBegin, jEnd, background, buffer);
+      }
+    }
+  }
+}
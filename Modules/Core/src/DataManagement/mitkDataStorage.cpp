@@ -15,6 +15,7 @@ found in the LICENSE file.
 #include "itkCommand.h"
 #include "itkMutexLockHolder.h"
 #include "mitkDataNode.h"
+#include "mitkExceptionMacro.h"
 #include "mitkGroupTagProperty.h"
 #include "mitkImage.h"
 #include "mitkNodePredicateBase.h"
@@ -22,7 +23,9 @@ found in the LICENSE file.
 #include "mitkProperties.h"
 #include "mitkArbitraryTimeGeometry.h"
 
-mitk::DataStorage::DataStorage() : itk::Object(), m_BlockNodeModifiedEvents(false)
+#include <algorithm>
+
+mitk::DataStorage::DataStorage() : itk::Object(), m_BlockNodeModifiedEvents(false), m_BatchDepth(0)
 {
 }
 
@@ -175,14 +178,66 @@ const mitk::DataNode::GroupTagList mitk::DataStorage::GetGroupTags() const
 
 void mitk::DataStorage::EmitAddNodeEvent(const DataNode *node)
 {
+  {
+    itk::MutexLockHolder<itk::SimpleFastMutexLock> locked(m_BatchMutex);
+    if (m_BatchDepth > 0)
+    {
+      m_BatchAddedNodes.push_back(node);
+      return;
+    }
+  }
   AddNodeEvent.Send(node);
 }
 
 void mitk::DataStorage::EmitRemoveNodeEvent(const DataNode *node)
 {
+  {
+    itk::MutexLockHolder<itk::SimpleFastMutexLock> locked(m_BatchMutex);
+    if (m_BatchDepth > 0)
+    {
+      // observers have not been notified about nodes that were added during the batch
+      auto pendingIter = std::find(m_BatchAddedNodes.begin(), m_BatchAddedNodes.end(), node);
+      if (pendingIter != m_BatchAddedNodes.end())
+      {
+        m_BatchAddedNodes.erase(pendingIter);
+        return;
+      }
+    }
+  }
   RemoveNodeEvent.Send(node);
 }
 
+void mitk::DataStorage::BeginBatch()
+{
+  itk::MutexLockHolder<itk::SimpleFastMutexLock> locked(m_BatchMutex);
+  ++m_BatchDepth;
+}
+
+void mitk::DataStorage::EndBatch()
+{
+  std::vector<DataNode::ConstPointer> addedNodes;
+  {
+    itk::MutexLockHolder<itk::SimpleFastMutexLock> locked(m_BatchMutex);
+    if (m_BatchDepth == 0)
+      mitkThrow() << "EndBatch() called without matching BeginBatch()";
+    if (--m_BatchDepth > 0)
+      return;
+    addedNodes.swap(m_BatchAddedNodes);
+  }
+
+  if (addedNodes.empty())
+    return;
+
+  SetOfObjects::Pointer nodes = SetOfObjects::New();
+  nodes->reserve(addedNodes.size());
+  for (const auto &node : addedNodes)
+    nodes->push_back(const_cast<DataNode *>(node.GetPointer()));
+
+  AddNodesEvent.Send(nodes);
+  for (const auto &node : addedNodes)
+    AddNodeEvent.Send(node);
+}
+
 void mitk::DataStorage::OnNodeInteractorChanged(itk::Object *caller, const itk::EventObject &)
 {
   const auto *_Node = dynamic_cast<const DataNode *>(caller);
@@ -13,6 +13,7 @@ found in the LICENSE file.
 // MITK
 #include "mitkImage.h"
 #include "mitkCompareImageDataFilter.h"
+#include "mitkImageHibernationStore.h"
 #include "mitkImageStatisticsHolder.h"
 #include "mitkImageVtkReadAccessor.h"
 #include "mitkImageVtkWriteAccessor.h"
@@ -26,7 +27,12 @@ found in the LICENSE file.
 #include <itkMutexLockHolder.h>
 
 // Other
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <thread>
 
 #define FILL_C_ARRAY(_arr, _size, _value)                                                                              \
   for (unsigned int i = 0u; i < _size; i++)                                                                            \
@@ -41,7 +47,13 @@ mitk::Image::Image()
     m_ImageDescriptor(nullptr),
     m_OffsetTable(nullptr),
     m_CompleteData(nullptr),
-    m_ImageStatistics(nullptr)
+    m_StorageMode(ImageDataItem::HeapStorage),
+    m_ProvidedVolumesMemoryBudget(0),
+    m_BrickedLayoutEnabled(false),
+    m_WholeImageModifiedTime(0),
+    m_ImageStatistics(nullptr),
+    m_HasSharedViews(false),
+    m_NumberOfWriters(0)
 {
   m_Dimensions = new unsigned int[MAX_IMAGE_DIMENSIONS];
   FILL_C_ARRAY(m_Dimensions, MAX_IMAGE_DIMENSIONS, 0u);
@@ -56,7 +68,13 @@ mitk::Image::Image(const Image &other)
     m_ImageDescriptor(nullptr),
     m_OffsetTable(nullptr),
     m_CompleteData(nullptr),
-    m_ImageStatistics(nullptr)
+    m_StorageMode(other.m_StorageMode),
+    m_ProvidedVolumesMemoryBudget(0),
+    m_BrickedLayoutEnabled(other.m_BrickedLayoutEnabled),
+    m_WholeImageModifiedTime(0),
+    m_ImageStatistics(nullptr),
+    m_HasSharedViews(false),
+    m_NumberOfWriters(0)
 {
   m_Dimensions = new unsigned int[MAX_IMAGE_DIMENSIONS];
   FILL_C_ARRAY(m_Dimensions, MAX_IMAGE_DIMENSIONS, 0u);
@@ -343,7 +361,13 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetVolumeData_unlocked(
   int pos = GetVolumeIndex(t, n);
   vol = m_Volumes[pos];
   if ((vol.GetPointer() != nullptr) && (vol->IsComplete()))
+  {
+    // keep track of the access order of volumes created by the volume provider
+    auto providedIt = std::find(m_ProvidedVolumes.begin(), m_ProvidedVolumes.end(), pos);
+    if (providedIt != m_ProvidedVolumes.end())
+      m_ProvidedVolumes.splice(m_ProvidedVolumes.begin(), m_ProvidedVolumes, providedIt);
     return vol;
+  }
 
   const size_t ptypeSize = this->m_ImageDescriptor->GetChannelTypeById(n).GetSize();
 
@@ -391,7 +415,7 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetVolumeData_unlocked(
       // ok, let's combine the slices!
       if (vol.GetPointer() == nullptr)
       {
-        vol = new ImageDataItem(chPixelType, t, 3, m_Dimensions, nullptr, true);
+        vol = new ImageDataItem(chPixelType, t, 3, m_Dimensions, nullptr, true, m_StorageMode);
       }
       vol->SetComplete(true);
       size_t size = m_OffsetTable[2] * (ptypeSize);
@@ -424,6 +448,12 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetVolumeData_unlocked(
     return m_Volumes[pos] = vol;
   }
 
+  // volume is unavailable. Can it be provided on demand?
+  if (m_VolumeProvider.IsNotNull() && data == nullptr && m_Channels[n].GetPointer() == nullptr)
+  {
+    return ProvideVolumeData_unlocked(t, n, true);
+  }
+
   // volume is unavailable. Can we calculate it?
   if ((GetSource().IsNotNull()) && (GetSource()->Updating() == false))
   {
@@ -454,6 +484,410 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetVolumeData_unlocked(
   }
 }
 
+bool mitk::Image::CopySharedViews() const
+{
+  if (!m_HasSharedViews)
+    return false;
+
+  MutexHolder lock(m_ImageDataArraysLock);
+
+  bool copied = false;
+  for (auto *items : {&m_Channels, &m_Volumes, &m_Slices})
+  {
+    for (auto &item : *items)
+    {
+      if (item.IsNotNull() && item->IsSharedView())
+      {
+        item->CopySharedMemory();
+        copied = true;
+      }
+    }
+  }
+
+  // items derived from a view still point to the shared memory
+  if (copied)
+  {
+    for (auto *items : {&m_Channels, &m_Volumes, &m_Slices})
+    {
+      for (auto &item : *items)
+      {
+        if (item.IsNotNull())
+          item->UpdateDataFromParent();
+      }
+    }
+  }
+
+  m_HasSharedViews = false;
+  return copied;
+}
+
+unsigned int mitk::Image::GetReaderShardIndex()
+{
+  return std::hash<std::thread::id>()(std::this_thread::get_id()) % NumberOfReaderShards;
+}
+
+mitk::Image::ImageDataItemPointer mitk::Image::ProvideVolumeData_unlocked(int t, int n, bool releaseVolumes) const
+{
+  ImageDataItemPointer vol = AllocateVolumeData_unlocked(t, n, nullptr, CopyMemory);
+  if (vol.IsNull() || !m_VolumeProvider->ProvideVolume(this, t, n, vol->m_Data))
+  {
+    m_Volumes[GetVolumeIndex(t, n)] = nullptr;
+    return nullptr;
+  }
+  vol->SetComplete(true);
+
+  m_ProvidedVolumes.push_front(GetVolumeIndex(t, n));
+  if (releaseVolumes && m_ProvidedVolumesMemoryBudget != 0)
+    this->ReleaseProvidedVolumes_unlocked(m_ProvidedVolumesMemoryBudget, true);
+
+  return vol;
+}
+
+void mitk::Image::ReleaseProvidedVolumes_unlocked(size_t budget, bool keepMostRecentlyAccessed) const
+{
+  if (m_ProvidedVolumes.empty())
+    return;
+
+  size_t usedMemory = 0;
+  for (int pos : m_ProvidedVolumes)
+  {
+    const int n = pos / m_Dimensions[3];
+    usedMemory += m_OffsetTable[3] * this->m_ImageDescriptor->GetChannelTypeById(n).GetSize();
+  }
+
+  // Accessors do not reference the image data items they access but only store the memory range.
+  // Do not wait for them here (they lock the data arrays while holding their locks) but retry later.
+  std::vector<itk::SimpleFastMutexLock *> lockedAccessorLocks;
+  auto unlockAccessorLocks = [&lockedAccessorLocks]() {
+    for (auto lockIt = lockedAccessorLocks.rbegin(); lockIt != lockedAccessorLocks.rend(); ++lockIt)
+      (*lockIt)->Unlock();
+  };
+
+  std::vector<itk::SimpleFastMutexLock *> accessorLocks = {&m_ReadWriteLock};
+  for (auto &shard : m_ReaderShards)
+    accessorLocks.push_back(&shard.m_Lock);
+  accessorLocks.push_back(&m_VtkReadersLock);
+
+  for (auto *accessorLock : accessorLocks)
+  {
+    if (!accessorLock->TryLock())
+    {
+      unlockAccessorLocks();
+      return;
+    }
+    lockedAccessorLocks.push_back(accessorLock);
+  }
+
+  std::vector<const std::vector<ImageAccessorBase *> *> accessorLists = {&m_Writers, &m_VtkReaders};
+  for (const auto &shard : m_ReaderShards)
+    accessorLists.push_back(&shard.m_Readers);
+
+  auto isAccessed = [&accessorLists](const ImageDataItem *item) {
+    const void *begin = item->m_Data;
+    const void *end = item->m_Data + item->m_Size;
+    for (const auto *accessors : accessorLists)
+    {
+      for (const ImageAccessorBase *accessor : *accessors)
+      {
+        if (accessor->m_AddressBegin < end && accessor->m_AddressEnd > begin)
+          return true;
+      }
+    }
+    return false;
+  };
+
+  // collect the candidates before erasing any of them, erasing a list node only invalidates iterators to that node;
+  // they are visited in reverse order, least recently accessed first
+  std::vector<std::list<int>::iterator> candidates;
+  const auto first = keepMostRecentlyAccessed ? std::next(m_ProvidedVolumes.begin()) : m_ProvidedVolumes.begin();
+  for (auto it = first; it != m_ProvidedVolumes.end(); ++it)
+    candidates.push_back(it);
+
+  for (auto candidateIt = candidates.rbegin(); candidateIt != candidates.rend() && usedMemory > budget; ++candidateIt)
+  {
+    const auto current = *candidateIt;
+    const int pos = *current;
+    const int t = pos % m_Dimensions[3];
+    const int n = pos / m_Dimensions[3];
+
+    if (m_Volumes[pos].IsNotNull() && isAccessed(m_Volumes[pos]))
+      continue;
+
+    // slices reference the volume they are part of
+    for (unsigned int s = 0; s < m_Dimensions[2]; ++s)
+    {
+      ImageDataItemPointer &sl = m_Slices[GetSliceIndex(s, t, n)];
+      if (sl.IsNotNull() && sl->GetParent() == m_Volumes[pos])
+        sl = nullptr;
+    }
+
+    if (m_Volumes[pos].IsNull() || m_Volumes[pos]->GetReferenceCount() == 1)
+    {
+      m_Volumes[pos] = nullptr;
+      m_ProvidedVolumes.erase(current);
+      usedMemory -= m_OffsetTable[3] * this->m_ImageDescriptor->GetChannelTypeById(n).GetSize();
+    }
+  }
+
+  unlockAccessorLocks();
+}
+
+void mitk::Image::SetVolumeProvider(ImageVolumeProvider *provider)
+{
+  {
+    MutexHolder lock(m_ImageDataArraysLock);
+    if (m_VolumeProvider == provider)
+      return;
+
+    m_VolumeProvider = provider;
+    // volumes created by a former provider are ordinary volumes from now on
+    m_ProvidedVolumes.clear();
+  }
+  Modified();
+}
+
+void mitk::Image::SetProvidedVolumesMemoryBudget(size_t budget)
+{
+  MutexHolder lock(m_ImageDataArraysLock);
+  m_ProvidedVolumesMemoryBudget = budget;
+  if (budget != 0)
+    this->ReleaseProvidedVolumes_unlocked(budget, true);
+}
+
+size_t mitk::Image::Hibernate(ImageHibernationStore *store)
+{
+  MutexHolder lock(m_ImageDataArraysLock);
+
+  auto *previousStore = dynamic_cast<ImageHibernationStore *>(m_VolumeProvider.GetPointer());
+  if (!IsInitialized() || m_CompleteData.IsNotNull() || (m_VolumeProvider.IsNotNull() && previousStore == nullptr) ||
+      (store != nullptr && store == previousStore))
+    return 0;
+
+  // memory owned by the data items, views into other items do not count
+  auto getOwnedMemory = [this]() {
+    size_t size = 0;
+    for (const auto *items : {&m_Channels, &m_Volumes, &m_Slices})
+    {
+      for (const auto &item : *items)
+      {
+        if (item.IsNotNull() && item->GetParent().IsNull())
+          size += item->GetSize();
+      }
+    }
+    return size;
+  };
+  const size_t ownedMemory = getOwnedMemory() + (previousStore != nullptr ? previousStore->GetMemorySize() : 0);
+
+  // volumes released by an earlier hibernation are restored from the previous store
+  ImageHibernationStore::Pointer newStore = store;
+  if (newStore.IsNull())
+    newStore = MappedFileHibernationStore::New().GetPointer();
+
+  std::list<int> volumes;
+  std::vector<char> buffer;
+  for (unsigned int n = 0; n < GetNumberOfChannels(); ++n)
+  {
+    const size_t volumeSize = m_OffsetTable[3] * this->m_ImageDescriptor->GetChannelTypeById(n).GetSize();
+    for (unsigned int t = 0; t < m_Dimensions[3]; ++t)
+    {
+      bool isStored = false;
+      if (IsVolumeSet_unlocked(t, n))
+      {
+        ImageDataItemPointer vol = GetVolumeData_unlocked(t, n, nullptr, CopyMemory);
+        isStored = newStore->StoreVolume(this, t, n, vol->m_Data, volumeSize);
+      }
+      else if (previousStore != nullptr)
+      {
+        buffer.resize(volumeSize);
+        isStored = previousStore->ProvideVolume(this, t, n, buffer.data()) &&
+                   newStore->StoreVolume(this, t, n, buffer.data(), volumeSize);
+      }
+
+      if (!isStored)
+        return 0;
+      volumes.push_back(GetVolumeIndex(t, n));
+    }
+  }
+
+  m_VolumeProvider = newStore.GetPointer();
+  m_ProvidedVolumes = volumes;
+  this->ReleaseProvidedVolumes_unlocked(0, false);
+
+  // channels can be released as soon as none of their volumes is left
+  for (unsigned int n = 0; n < GetNumberOfChannels(); ++n)
+  {
+    ImageDataItemPointer &ch = m_Channels[n];
+    if (ch.IsNull())
+      continue;
+
+    bool isUsed = false;
+    for (unsigned int t = 0; t < m_Dimensions[3]; ++t)
+      isUsed = isUsed || m_Volumes[GetVolumeIndex(t, n)].IsNotNull();
+
+    for (auto &sl : m_Slices)
+    {
+      if (sl.IsNotNull() && sl->GetParent() == ch && sl->GetReferenceCount() == 1)
+        sl = nullptr;
+    }
+
+    if (!isUsed && ch->GetReferenceCount() == 1)
+      ch = nullptr;
+  }
+
+  const size_t remainingMemory = getOwnedMemory() + newStore->GetMemorySize();
+  return ownedMemory > remainingMemory ? ownedMemory - remainingMemory : 0;
+}
+
+void mitk::Image::SetBrickedLayoutEnabled(bool enabled)
+{
+  MutexHolder lock(m_BrickedVolumesLock);
+  m_BrickedLayoutEnabled = enabled;
+  if (!enabled)
+    m_BrickedVolumes.clear();
+}
+
+mitk::BrickedImageVolume::Pointer mitk::Image::GetBrickedVolume(int t, int n) const
+{
+  if (!m_BrickedLayoutEnabled || m_Dimension < 3 || !this->IsVolumeSet(t, n))
+    return nullptr;
+
+  MutexHolder lock(m_BrickedVolumesLock);
+  BrickedImageVolume::Pointer &brickedVolume = m_BrickedVolumes[this->GetVolumeIndex(t, n)];
+  if (brickedVolume.IsNull() || brickedVolume->GetSourceMTime() < this->GetMTime())
+  {
+    BrickedImageVolume::Pointer newBrickedVolume = BrickedImageVolume::New();
+    newBrickedVolume->Initialize(this, t, n);
+    brickedVolume = newBrickedVolume;
+  }
+  return brickedVolume;
+}
+
+void mitk::Image::Modified() const
+{
+  // observers of the ModifiedEvent must already see the whole image as modified
+  const itk::ModifiedTimeType pending = std::numeric_limits<itk::ModifiedTimeType>::max();
+  {
+    MutexHolder lock(m_ModifiedRegionsLock);
+    m_WholeImageModifiedTime = pending;
+    m_ModifiedRegions.clear();
+  }
+
+  Superclass::Modified();
+
+  MutexHolder lock(m_ModifiedRegionsLock);
+  if (m_WholeImageModifiedTime == pending)
+    m_WholeImageModifiedTime = this->itk::Object::GetMTime();
+}
+
+void mitk::Image::RegionModified(const RegionType &region) const
+{
+  // recording more regions makes queries expensive and their union is
+  // likely to cover most of the image anyway
+  const std::size_t maximumNumberOfRecords = 64;
+  const itk::ModifiedTimeType pending = std::numeric_limits<itk::ModifiedTimeType>::max();
+
+  {
+    MutexHolder lock(m_ModifiedRegionsLock);
+    m_ModifiedRegions.push_back({pending, region});
+    if (m_ModifiedRegions.size() > maximumNumberOfRecords)
+    {
+      m_WholeImageModifiedTime = std::max(m_WholeImageModifiedTime, m_ModifiedRegions.front().m_Time);
+      m_ModifiedRegions.pop_front();
+    }
+  }
+
+  // not this->Modified(), which would mark the whole image
+  Superclass::Modified();
+
+  const itk::ModifiedTimeType time = this->itk::Object::GetMTime();
+  MutexHolder lock(m_ModifiedRegionsLock);
+  for (auto &record : m_ModifiedRegions)
+  {
+    if (record.m_Time == pending)
+      record.m_Time = time;
+  }
+  if (m_WholeImageModifiedTime == pending)
+    m_WholeImageModifiedTime = time;
+}
+
+bool mitk::Image::GetModifiedRegion(itk::ModifiedTimeType time, RegionType &region) const
+{
+  const TimeGeometry *timeGeometry = this->GetTimeGeometry();
+  if (timeGeometry != nullptr && timeGeometry->GetMTime() > time)
+    return false;
+
+  MutexHolder lock(m_ModifiedRegionsLock);
+  if (m_WholeImageModifiedTime > time)
+    return false;
+
+  RegionType::IndexType lower;
+  RegionType::IndexType upper;
+  bool empty = true;
+  for (const auto &record : m_ModifiedRegions)
+  {
+    if (record.m_Time <= time || record.m_Region.GetNumberOfPixels() == 0)
+      continue;
+
+    const RegionType::IndexType recordLower = record.m_Region.GetIndex();
+    const RegionType::IndexType recordUpper = record.m_Region.GetUpperIndex();
+    for (unsigned int i = 0; i < RegionDimension; ++i)
+    {
+      lower[i] = empty ? recordLower[i] : std::min(lower[i], recordLower[i]);
+      upper[i] = empty ? recordUpper[i] : std::max(upper[i], recordUpper[i]);
+    }
+    empty = false;
+  }
+
+  if (empty)
+  {
+    region = RegionType();
+  }
+  else
+  {
+    region.SetIndex(lower);
+    region.SetUpperIndex(upper);
+  }
+  return true;
+}
+
+mitk::Image::RegionType mitk::Image::GetRegionOfPlane(const PlaneGeometry *plane, int t) const
+{
+  RegionType region;
+  const BaseGeometry *geometry = this->GetGeometry(t);
+  if (plane == nullptr || geometry == nullptr || !this->IsValidTimeStep(t))
+    return region;
+
+  RegionType::IndexType lower;
+  RegionType::IndexType upper;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    lower[i] = itk::NumericTraits<RegionType::IndexValueType>::max();
+    upper[i] = itk::NumericTraits<RegionType::IndexValueType>::NonpositiveMin();
+  }
+
+  for (int corner = 0; corner < 8; ++corner)
+  {
+    Point3D index;
+    geometry->WorldToIndex(plane->GetCornerPoint(corner), index);
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      // include every voxel the (continuous) index may round to
+      lower[i] = std::min(lower[i], static_cast<RegionType::IndexValueType>(std::floor(index[i])));
+      upper[i] = std::max(upper[i], static_cast<RegionType::IndexValueType>(std::ceil(index[i])));
+    }
+  }
+
+  lower[3] = upper[3] = t;
+  lower[4] = 0;
+  upper[4] = static_cast<RegionType::IndexValueType>(this->GetNumberOfChannels()) - 1;
+
+  region.SetIndex(lower);
+  region.SetUpperIndex(upper);
+  if (!region.Crop(this->GetLargestPossibleRegion()))
+    return RegionType();
+  return region;
+}
+
 mitk::Image::ImageDataItemPointer mitk::Image::GetChannelData(int n,
                                                               void *data,
                                                               ImportMemoryManagementType importMemoryManagement) const
@@ -494,7 +928,7 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetChannelData_unlocked(
       ch = m_Channels[n];
       // ok, let's combine the volumes!
       if (ch.GetPointer() == nullptr)
-        ch = new ImageDataItem(this->m_ImageDescriptor, -1, nullptr, true);
+        ch = new ImageDataItem(this->m_ImageDescriptor, -1, nullptr, true, m_StorageMode);
       ch->SetComplete(true);
       size_t size = m_OffsetTable[m_Dimension - 1] * (ptypeSize);
       unsigned int t;
@@ -538,6 +972,27 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetChannelData_unlocked(
     return m_Channels[n] = ch;
   }
 
+  // channel is unavailable. Can its volumes be provided on demand?
+  if (m_VolumeProvider.IsNotNull() && data == nullptr)
+  {
+    // the complete channel is requested, so the memory budget cannot be met anyway
+    bool provided = true;
+    for (unsigned int t = 0; t < m_Dimensions[3] && provided; ++t)
+    {
+      if (!IsVolumeSet_unlocked(t, n))
+        provided = ProvideVolumeData_unlocked(t, n, false).IsNotNull();
+    }
+    if (!provided)
+      return nullptr;
+
+    // the volumes are part of the channel now and must not be released anymore
+    const int channelOffset = n * m_Dimensions[3];
+    m_ProvidedVolumes.remove_if([channelOffset, this](int pos) {
+      return pos >= channelOffset && pos < channelOffset + static_cast<int>(m_Dimensions[3]);
+    });
+    return GetChannelData_unlocked(n, data, importMemoryManagement);
+  }
+
   // channel is unavailable. Can we calculate it?
   if ((GetSource().IsNotNull()) && (GetSource()->Updating() == false))
   {
@@ -698,7 +1153,14 @@ bool mitk::Image::SetImportSlice(void *data, int s, int t, int n, ImportMemoryMa
       std::memcpy(sl->GetData(), data, m_OffsetTable[2] * (ptypeSize));
     sl->Modified();
     // we have changed the data: call Modified()!
-    Modified();
+    RegionType region = this->GetLargestPossibleRegion();
+    region.SetIndex(2, s);
+    region.SetSize(2, 1);
+    region.SetIndex(3, t);
+    region.SetSize(3, 1);
+    region.SetIndex(4, n);
+    region.SetSize(4, 1);
+    RegionModified(region);
   }
   else
   {
@@ -720,6 +1182,13 @@ bool mitk::Image::SetImportVolume(void *data, int t, int n, ImportMemoryManageme
 
   const size_t ptypeSize = this->m_ImageDescriptor->GetChannelTypeById(n).GetSize();
   ImageDataItemPointer vol;
+
+  {
+    // explicitly set volumes are never released by the provided volumes memory budget
+    MutexHolder lock(m_ImageDataArraysLock);
+    m_ProvidedVolumes.remove(GetVolumeIndex(t, n));
+  }
+
   if (IsVolumeSet(t, n))
   {
     vol = GetVolumeData(t, n, data, importMemoryManagement);
@@ -734,7 +1203,12 @@ bool mitk::Image::SetImportVolume(void *data, int t, int n, ImportMemoryManageme
     vol->Modified();
     vol->SetComplete(true);
     // we have changed the data: call Modified()!
-    Modified();
+    RegionType region = this->GetLargestPossibleRegion();
+    region.SetIndex(3, t);
+    region.SetSize(3, 1);
+    region.SetIndex(4, n);
+    region.SetSize(4, 1);
+    RegionModified(region);
   }
   else
   {
@@ -782,7 +1256,10 @@ bool mitk::Image::SetImportChannel(void *data, int n, ImportMemoryManagementType
     ch->Modified();
     ch->SetComplete(true);
     // we have changed the data: call Modified()!
-    Modified();
+    RegionType region = this->GetLargestPossibleRegion();
+    region.SetIndex(4, n);
+    region.SetSize(4, 1);
+    RegionModified(region);
   }
   else
   {
@@ -816,6 +1293,21 @@ void mitk::Image::Initialize()
     (*it) = nullptr;
   }
   m_CompleteData = nullptr;
+  m_ProvidedVolumes.clear();
+
+  {
+    MutexHolder lock(m_BrickedVolumesLock);
+    m_BrickedVolumes.clear();
+  }
+
+  {
+    // the data arrays are recreated: everything recorded so far is meaningless
+    itk::TimeStamp initializeTime;
+    initializeTime.Modified();
+    MutexHolder lock(m_ModifiedRegionsLock);
+    m_ModifiedRegions.clear();
+    m_WholeImageModifiedTime = initializeTime.GetMTime();
+  }
 
   if (m_ImageStatistics == nullptr)
   {
@@ -1266,7 +1758,7 @@ mitk::Image::ImageDataItemPointer mitk::Image::AllocateVolumeData_unlocked(
   // allocate new volume
   if (importMemoryManagement == CopyMemory)
   {
-    vol = new ImageDataItem(chPixelType, t, 3, m_Dimensions, nullptr, true);
+    vol = new ImageDataItem(chPixelType, t, 3, m_Dimensions, nullptr, true, m_StorageMode);
     if (data != nullptr)
       std::memcpy(vol->GetData(), data, m_OffsetTable[3] * (ptypeSize));
   }
@@ -1294,7 +1786,7 @@ mitk::Image::ImageDataItemPointer mitk::Image::AllocateChannelData_unlocked(
   {
     const size_t ptypeSize = this->m_ImageDescriptor->GetChannelTypeById(n).GetSize();
 
-    ch = new ImageDataItem(this->m_ImageDescriptor, -1, nullptr, true);
+    ch = new ImageDataItem(this->m_ImageDescriptor, -1, nullptr, true, m_StorageMode);
     if (data != nullptr)
       std::memcpy(ch->GetData(), data, m_OffsetTable[4] * (ptypeSize));
   }
@@ -12,6 +12,7 @@ found in the LICENSE file.
 
 #include "mitkImageAccessorBase.h"
 #include "mitkImage.h"
+#include "mitkTracing.h"
 
 mitk::ImageAccessorBase::ThreadIDType mitk::ImageAccessorBase::CurrentThreadHandle()
 {
@@ -47,6 +48,7 @@ mitk::ImageAccessorBase::ImageAccessorBase(ImageConstPointer image,
     m_Options(OptionFlags),
     m_CoherentMemory(false)
 {
+  MITK_TRACE_COUNT("Image", "Image accessors", 1);
   m_Thread = CurrentThreadHandle();
 
   // Initialize WaitLock
@@ -151,6 +153,8 @@ bool mitk::ImageAccessorBase::Overlap(const ImageAccessorBase *iAB)
 /** \brief Uses the WaitLock to wait for another ImageAccessor*/
 void mitk::ImageAccessorBase::WaitForReleaseOf(ImageAccessorWaitLock *wL)
 {
+  // the time accessors are blocked by overlapping accessors of other threads
+  MITK_TRACE_SCOPE("Image", "Wait for image accessor");
   wL->m_Mutex.Lock();
 
   // Decrement
@@ -171,14 +175,22 @@ void mitk::ImageAccessorBase::WaitForReleaseOf(ImageAccessorWaitLock *wL)
 
 void mitk::ImageAccessorBase::PreventRecursiveMutexLock(mitk::ImageAccessorBase *iAB)
 {
-#ifdef MITK_USE_RECURSIVE_MUTEX_PREVENTION
   // Prevent deadlock
-  ThreadIDType id = CurrentThreadHandle();
-  if (CompareThreadHandles(id, iAB->m_Thread))
+  if (IsRequestedRecursively(iAB))
   {
     GetImage()->m_ReadWriteLock.Unlock();
     mitkThrow()
       << "Prohibited image access: the requested image part is already in use and cannot be requested recursively!";
   }
+}
+
+bool mitk::ImageAccessorBase::IsRequestedRecursively(const mitk::ImageAccessorBase *iAB)
+{
+#ifdef MITK_USE_RECURSIVE_MUTEX_PREVENTION
+  ThreadIDType id = CurrentThreadHandle();
+  return CompareThreadHandles(id, iAB->m_Thread);
+#else
+  (void)iAB;
+  return false;
 #endif
 }
@@ -31,6 +31,20 @@ found in the LICENSE file.
 #include <mitkImageVtkReadAccessor.h>
 #include <mitkImageVtkWriteAccessor.h>
 
+namespace
+{
+  // Points the scalars of the vtkImageData of an item to new memory of the same size
+  void RebindScalars(vtkImageData *imageData, void *data)
+  {
+    vtkDataArray *scalars = imageData->GetPointData()->GetScalars();
+    if (scalars != nullptr)
+    {
+      scalars->SetVoidArray(data, scalars->GetNumberOfValues(), 1);
+      imageData->Modified();
+    }
+  }
+}
+
 mitk::ImageDataItem::ImageDataItem(const ImageDataItem &aParent,
                                    const mitk::ImageDescriptor::Pointer desc,
                                    int timestep,
@@ -41,6 +55,8 @@ mitk::ImageDataItem::ImageDataItem(const ImageDataItem &aParent,
   : m_Data(static_cast<unsigned char *>(aParent.m_Data) + offset),
     m_PixelType(new mitk::PixelType(aParent.GetPixelType())),
     m_ManageMemory(false),
+    m_StorageMode(aParent.m_StorageMode),
+    m_PooledMemory(false),
     m_VtkImageData(nullptr),
     m_VtkImageReadAccessor(nullptr),
     m_VtkImageWriteAccessor(nullptr),
@@ -48,6 +64,7 @@ mitk::ImageDataItem::ImageDataItem(const ImageDataItem &aParent,
     m_IsComplete(false),
     m_Size(0),
     m_Parent(&aParent),
+    m_SharedView(false),
     m_Dimension(dimension),
     m_Timestep(timestep)
 {
@@ -90,7 +107,14 @@ mitk::ImageDataItem::~ImageDataItem()
   if (m_Parent.IsNull())
   {
     if (m_ManageMemory)
-      delete[] m_Data;
+    {
+      if (m_StorageMode == MappedFileStorage)
+        mitk::MemoryUtilities::DeleteMappedMemory(m_Data, m_Size);
+      else if (m_PooledMemory)
+        mitk::MemoryUtilities::DeletePooledMemory(m_Data, m_Size);
+      else
+        delete[] m_Data;
+    }
   }
   delete m_PixelType;
 }
@@ -98,16 +122,20 @@ mitk::ImageDataItem::~ImageDataItem()
 mitk::ImageDataItem::ImageDataItem(const mitk::ImageDescriptor::Pointer desc,
                                    int timestep,
                                    void *data,
-                                   bool manageMemory)
+                                   bool manageMemory,
+                                   StorageMode storageMode)
   : m_Data(static_cast<unsigned char *>(data)),
     m_PixelType(new mitk::PixelType(desc->GetChannelDescriptor(0).GetPixelType())),
     m_ManageMemory(manageMemory),
+    m_StorageMode(HeapStorage),
+    m_PooledMemory(false),
     m_VtkImageData(nullptr),
     m_VtkImageReadAccessor(nullptr),
     m_VtkImageWriteAccessor(nullptr),
     m_Offset(0),
     m_IsComplete(false),
     m_Size(0),
+    m_SharedView(false),
     m_Dimension(desc->GetNumberOfDimensions()),
     m_Timestep(timestep)
 {
@@ -122,8 +150,8 @@ mitk::ImageDataItem::ImageDataItem(const mitk::ImageDescriptor::Pointer desc,
 
   if (m_Data == nullptr)
   {
-    m_Data = mitk::MemoryUtilities::AllocateElements<unsigned char>(m_Size);
-    m_ManageMemory = true;
+    m_StorageMode = storageMode;
+    this->AllocateData();
   }
 
   m_ReferenceCount = 0;
@@ -134,10 +162,13 @@ mitk::ImageDataItem::ImageDataItem(const mitk::PixelType &type,
                                    unsigned int dimension,
                                    unsigned int *dimensions,
                                    void *data,
-                                   bool manageMemory)
+                                   bool manageMemory,
+                                   StorageMode storageMode)
   : m_Data(static_cast<unsigned char *>(data)),
     m_PixelType(new mitk::PixelType(type)),
     m_ManageMemory(manageMemory),
+    m_StorageMode(HeapStorage),
+    m_PooledMemory(false),
     m_VtkImageData(nullptr),
     m_VtkImageReadAccessor(nullptr),
     m_VtkImageWriteAccessor(nullptr),
@@ -145,6 +176,7 @@ mitk::ImageDataItem::ImageDataItem(const mitk::PixelType &type,
     m_IsComplete(false),
     m_Size(0),
     m_Parent(nullptr),
+    m_SharedView(false),
     m_Dimension(dimension),
     m_Timestep(timestep)
 {
@@ -157,8 +189,8 @@ mitk::ImageDataItem::ImageDataItem(const mitk::PixelType &type,
 
   if (m_Data == nullptr)
   {
-    m_Data = mitk::MemoryUtilities::AllocateElements<unsigned char>(m_Size);
-    m_ManageMemory = true;
+    m_StorageMode = storageMode;
+    this->AllocateData();
   }
 
   m_ReferenceCount = 0;
@@ -169,6 +201,8 @@ mitk::ImageDataItem::ImageDataItem(const ImageDataItem &other)
     m_Data(other.m_Data),
     m_PixelType(new mitk::PixelType(*other.m_PixelType)),
     m_ManageMemory(other.m_ManageMemory),
+    m_StorageMode(other.m_StorageMode),
+    m_PooledMemory(other.m_PooledMemory),
     m_VtkImageData(nullptr),
     m_VtkImageReadAccessor(nullptr),
     m_VtkImageWriteAccessor(nullptr),
@@ -176,6 +210,7 @@ mitk::ImageDataItem::ImageDataItem(const ImageDataItem &other)
     m_IsComplete(other.m_IsComplete),
     m_Size(other.m_Size),
     m_Parent(other.m_Parent),
+    m_SharedView(other.m_SharedView),
     m_Dimension(other.m_Dimension),
     m_Timestep(other.m_Timestep)
 {
@@ -200,6 +235,63 @@ void mitk::ImageDataItem::ComputeItemSize(const unsigned int *dimensions, unsign
   }
 }
 
+void mitk::ImageDataItem::AllocateData()
+{
+  if (m_StorageMode == MappedFileStorage)
+  {
+    m_Data = static_cast<unsigned char *>(mitk::MemoryUtilities::AllocateMappedMemory(m_Size, true));
+    if (m_Data == nullptr)
+    {
+      MITK_WARN << "Could not map " << m_Size << " bytes of image memory to a file. Using heap memory instead.";
+      m_StorageMode = HeapStorage;
+    }
+  }
+
+  if (m_Data == nullptr)
+  {
+    m_Data = static_cast<unsigned char *>(mitk::MemoryUtilities::AllocatePooledMemory(m_Size));
+    m_PooledMemory = true;
+  }
+  m_ManageMemory = true;
+}
+
+void mitk::ImageDataItem::CopySharedMemory()
+{
+  if (!m_SharedView)
+    return;
+
+  const unsigned char *sharedData = m_Data;
+
+  m_Data = nullptr;
+  this->AllocateData();
+  memcpy(m_Data, sharedData, m_Size);
+
+  // the memory of the parent is not referenced anymore
+  m_Parent = nullptr;
+  m_Offset = 0;
+  m_SharedView = false;
+
+  if (m_VtkImageData != nullptr)
+    RebindScalars(m_VtkImageData, m_Data);
+}
+
+void mitk::ImageDataItem::UpdateDataFromParent()
+{
+  if (m_Parent.IsNull() || m_SharedView)
+    return;
+
+  const_cast<ImageDataItem *>(m_Parent.GetPointer())->UpdateDataFromParent();
+
+  unsigned char *data = m_Parent->m_Data + m_Offset;
+  if (data == m_Data)
+    return;
+
+  m_Data = data;
+
+  if (m_VtkImageData != nullptr)
+    RebindScalars(m_VtkImageData, m_Data);
+}
+
 void mitk::ImageDataItem::ConstructVtkImageData(ImageConstPointer iP) const
 {
   vtkImageData *inData = vtkImageData::New();
@@ -0,0 +1,63 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkImageHibernationStore.h"
+#include "mitkMemoryUtilities.h"
+
+#include <cstring>
+
+mitk::ImageHibernationStore::ImageHibernationStore()
+{
+}
+
+mitk::ImageHibernationStore::~ImageHibernationStore()
+{
+}
+
+mitk::MappedFileHibernationStore::MappedFileHibernationStore()
+{
+}
+
+mitk::MappedFileHibernationStore::~MappedFileHibernationStore()
+{
+  for (const auto &volume : m_Volumes)
+    MemoryUtilities::DeleteMappedMemory(volume.second.Memory, volume.second.Size);
+}
+
+bool mitk::MappedFileHibernationStore::StoreVolume(const Image *, int t, int n, const void *data, std::size_t size)
+{
+  void *memory = MemoryUtilities::AllocateMappedMemory(size, true);
+  if (memory == nullptr)
+    return false;
+
+  std::memcpy(memory, data, size);
+
+  auto &volume = m_Volumes[std::make_pair(t, n)];
+  MemoryUtilities::DeleteMappedMemory(volume.Memory, volume.Size);
+  volume = Volume{memory, size};
+  return true;
+}
+
+bool mitk::MappedFileHibernationStore::ProvideVolume(const Image *, int t, int n, void *buffer)
+{
+  auto it = m_Volumes.find(std::make_pair(t, n));
+  if (it == m_Volumes.end())
+    return false;
+
+  std::memcpy(buffer, it->second.Memory, it->second.Size);
+  return true;
+}
+
+std::size_t mitk::MappedFileHibernationStore::GetMemorySize() const
+{
+  return 0;
+}
@@ -0,0 +1,195 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkImagePixelValueLookup.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  template <typename TComponent>
+  mitk::ScalarType ReadComponent(const void *data, std::size_t offset)
+  {
+    return static_cast<mitk::ScalarType>(static_cast<const TComponent *>(data)[offset]);
+  }
+
+  typedef mitk::ScalarType (*ReadComponentFunction)(const void *data, std::size_t offset);
+
+  ReadComponentFunction GetReadComponentFunction(int componentType)
+  {
+    switch (componentType)
+    {
+      case itk::ImageIOBase::UCHAR:
+        return &ReadComponent<unsigned char>;
+      case itk::ImageIOBase::CHAR:
+        return &ReadComponent<char>;
+      case itk::ImageIOBase::USHORT:
+        return &ReadComponent<unsigned short>;
+      case itk::ImageIOBase::SHORT:
+        return &ReadComponent<short>;
+      case itk::ImageIOBase::UINT:
+        return &ReadComponent<unsigned int>;
+      case itk::ImageIOBase::INT:
+        return &ReadComponent<int>;
+      case itk::ImageIOBase::ULONG:
+        return &ReadComponent<unsigned long>;
+      case itk::ImageIOBase::LONG:
+        return &ReadComponent<long>;
+      case itk::ImageIOBase::FLOAT:
+        return &ReadComponent<float>;
+      case itk::ImageIOBase::DOUBLE:
+        return &ReadComponent<double>;
+      default:
+        return nullptr;
+    }
+  }
+}
+
+mitk::ImagePixelValueLookup::ImagePixelValueLookup()
+{
+}
+
+mitk::ImagePixelValueLookup::~ImagePixelValueLookup()
+{
+}
+
+void mitk::ImagePixelValueLookup::Clear()
+{
+  m_Entries.clear();
+}
+
+mitk::ImagePixelValueLookup::Result mitk::ImagePixelValueLookup::Lookup(const Image *image,
+                                                                        const Point3D &worldPosition,
+                                                                        TimePointType timePoint,
+                                                                        int component)
+{
+  return this->Lookup(std::vector<const Image *>{image}, worldPosition, timePoint, component).front();
+}
+
+std::vector<mitk::ImagePixelValueLookup::Result> mitk::ImagePixelValueLookup::Lookup(
+  const std::vector<const Image *> &images, const Point3D &worldPosition, TimePointType timePoint, int component)
+{
+  // drop the images that are not part of this lookup, so that they are not kept alive by their accessors
+  for (auto iter = m_Entries.begin(); iter != m_Entries.end();)
+  {
+    if (std::find(images.begin(), images.end(), iter->first) == images.end())
+      iter = m_Entries.erase(iter);
+    else
+      ++iter;
+  }
+
+  std::vector<Result> results;
+  results.reserve(images.size());
+  for (const auto *image : images)
+  {
+    results.push_back(this->LookupImage(image, worldPosition, timePoint, component));
+  }
+  return results;
+}
+
+mitk::ImagePixelValueLookup::Result mitk::ImagePixelValueLookup::LookupImage(const Image *image,
+                                                                             const Point3D &worldPosition,
+                                                                             TimePointType timePoint,
+                                                                             int component)
+{
+  Result result;
+  if (nullptr == image || !image->IsInitialized() || component < 0)
+    return result;
+
+  const auto *timeGeometry = image->GetTimeGeometry();
+  if (nullptr == timeGeometry || !timeGeometry->IsValidTimePoint(timePoint))
+    return result;
+
+  const auto timeStep = timeGeometry->TimePointToTimeStep(timePoint);
+  const auto *geometry = timeGeometry->GetGeometryForTimeStep(timeStep).GetPointer();
+  if (nullptr == geometry)
+    return result;
+
+  Point3D index;
+  geometry->WorldToIndex(worldPosition, index);
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    // same rounding as itk::Index::CopyWithRound, which is used by mitk::Image::GetPixelValueByWorldCoordinate
+    result.Index[i] = static_cast<itk::IndexValueType>(std::floor(index[i] + 0.5));
+  }
+
+  auto *entry = this->GetEntry(image, timeStep);
+  if (nullptr == entry || static_cast<std::size_t>(component) >= entry->NumberOfComponents)
+    return result;
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    if (result.Index[i] < 0 || static_cast<std::size_t>(result.Index[i]) >= entry->Dimensions[i])
+      return result;
+  }
+
+  const std::size_t offset =
+    entry->NumberOfComponents *
+    (result.Index[0] + entry->Dimensions[0] * (result.Index[1] + entry->Dimensions[1] * result.Index[2]));
+
+  const auto *data = entry->Accessor->GetData();
+  result.Components.resize(entry->NumberOfComponents);
+  for (std::size_t i = 0; i < entry->NumberOfComponents; ++i)
+  {
+    result.Components[i] = entry->ReadComponent(data, offset + i);
+  }
+  result.Value = result.Components[component];
+  result.IsInside = true;
+  return result;
+}
+
+mitk::ImagePixelValueLookup::Entry *mitk::ImagePixelValueLookup::GetEntry(const Image *image, TimeStepType timeStep)
+{
+  auto &entry = m_Entries[image];
+
+  if (nullptr != entry.Accessor && entry.ImageMTime == image->GetMTime() && entry.TimeStep == timeStep)
+    return entry.ReadComponent != nullptr ? &entry : nullptr;
+
+  entry.Accessor.reset();
+  entry.Volume = nullptr;
+  entry.ImageMTime = image->GetMTime();
+  entry.TimeStep = timeStep;
+  entry.ReadComponent = nullptr;
+
+  // do not allocate volumes that do not exist and will not be provided
+  if (!image->IsVolumeSet(timeStep) && nullptr == image->GetVolumeProvider())
+    return nullptr;
+
+  const auto pixelType = image->GetPixelType();
+  const auto readComponent = GetReadComponentFunction(pixelType.GetComponentType());
+  if (nullptr == readComponent)
+    return nullptr;
+
+  try
+  {
+    auto volume = image->GetVolumeData(timeStep);
+    if (volume.IsNull())
+      return nullptr;
+
+    entry.Accessor = std::make_unique<ImageReadAccessor>(
+      ImageConstPointer(image), volume.GetPointer(), ImageAccessorBase::IgnoreLock);
+    entry.Volume = volume;
+  }
+  catch (const mitk::Exception &)
+  {
+    return nullptr;
+  }
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    entry.Dimensions[i] = i < image->GetDimension() ? image->GetDimension(i) : 1;
+  }
+  entry.NumberOfComponents = pixelType.GetNumberOfComponents();
+  entry.ReadComponent = readComponent;
+  return &entry;
+}
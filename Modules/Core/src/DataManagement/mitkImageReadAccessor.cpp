@@ -14,8 +14,10 @@ found in the LICENSE file.
 
 #include "mitkImage.h"
 
+#include <algorithm>
+
 mitk::ImageReadAccessor::ImageReadAccessor(ImageConstPointer image, const mitk::ImageDataItem *iDI, int OptionFlags)
-  : ImageAccessorBase(image, iDI, OptionFlags), m_Image(image)
+  : ImageAccessorBase(image, iDI, OptionFlags), m_Image(image), m_ReaderShardIndex(0)
 {
   if (!(OptionFlags & ImageAccessorBase::IgnoreLock))
   {
@@ -32,7 +34,7 @@ mitk::ImageReadAccessor::ImageReadAccessor(ImageConstPointer image, const mitk::
 }
 
 mitk::ImageReadAccessor::ImageReadAccessor(ImagePointer image, const mitk::ImageDataItem *iDI, int OptionFlags)
-  : ImageAccessorBase(image.GetPointer(), iDI, OptionFlags), m_Image(image.GetPointer())
+  : ImageAccessorBase(image.GetPointer(), iDI, OptionFlags), m_Image(image.GetPointer()), m_ReaderShardIndex(0)
 {
   if (!(OptionFlags & ImageAccessorBase::IgnoreLock))
   {
@@ -49,7 +51,7 @@ mitk::ImageReadAccessor::ImageReadAccessor(ImagePointer image, const mitk::Image
 }
 
 mitk::ImageReadAccessor::ImageReadAccessor(const mitk::Image *image, const ImageDataItem *iDI)
-  : ImageAccessorBase(image, iDI, ImageAccessorBase::DefaultBehavior), m_Image(image)
+  : ImageAccessorBase(image, iDI, ImageAccessorBase::DefaultBehavior), m_Image(image), m_ReaderShardIndex(0)
 {
   OrganizeReadAccess();
 }
@@ -60,11 +62,13 @@ mitk::ImageReadAccessor::~ImageReadAccessor()
   {
     // Future work: In case of non-coherent memory, copied area needs to be deleted
 
-    m_Image->m_ReadWriteLock.Lock();
+    Image::ReaderShard &shard = m_Image->m_ReaderShards[m_ReaderShardIndex];
+    shard.m_Lock.Lock();
 
-    // delete self from list of ImageReadAccessors in Image
-    auto it = std::find(m_Image->m_Readers.begin(), m_Image->m_Readers.end(), this);
-    m_Image->m_Readers.erase(it);
+    // delete self from list of ImageReadAccessors in Image (the order of the list is irrelevant)
+    auto it = std::find(shard.m_Readers.begin(), shard.m_Readers.end(), this);
+    *it = shard.m_Readers.back();
+    shard.m_Readers.pop_back();
 
     // delete lock, if there are no waiting ImageAccessors
     if (m_WaitLock->m_WaiterCount <= 0)
@@ -77,7 +81,7 @@ mitk::ImageReadAccessor::~ImageReadAccessor()
       m_WaitLock->m_Mutex.Unlock();
     }
 
-    m_Image->m_ReadWriteLock.Unlock();
+    shard.m_Lock.Unlock();
   }
   else
   {
@@ -92,56 +96,106 @@ const mitk::Image *mitk::ImageReadAccessor::GetImage() const
 
 void mitk::ImageReadAccessor::OrganizeReadAccess()
 {
+  m_ReaderShardIndex = Image::GetReaderShardIndex();
+  Image::ReaderShard &shard = m_Image->m_ReaderShards[m_ReaderShardIndex];
+
+  // Fast path: as long as no write access exists or is being organized, only the shard of this thread
+  // has to be locked. Writers announce themselves before they lock all shards to check the readers,
+  // so either they see this accessor or this accessor sees them.
+  shard.m_Lock.Lock();
+  if (m_Image->m_NumberOfWriters == 0)
+  {
+    m_WaitLock->m_Mutex.Lock();
+    shard.m_Readers.push_back(this);
+    shard.m_Lock.Unlock();
+    return;
+  }
+  shard.m_Lock.Unlock();
+
   m_Image->m_ReadWriteLock.Lock();
 
-  // Check, if there is any Write-Access going on
-  if (m_Image->m_Writers.size() > 0)
+  // Check, if there is any Write-Access going on or waiting. Waiting writers are preferred over new readers,
+  // unless this thread already holds a read access the waiting writer may wait for.
+  ImageAccessorBase *overlappingWriter = nullptr;
+  for (ImageAccessorBase *w : m_Image->m_Writers)
   {
-    // Check for every WriteAccessors, if the Region of this ImageAccessors overlaps
-    // make sure this iterator is not used, when m_ReadWriteLock is Unlocked!
-    auto it = m_Image->m_Writers.begin();
-
-    for (; it != m_Image->m_Writers.end(); ++it)
+    if (Overlap(w))
+    {
+      overlappingWriter = w;
+      break;
+    }
+  }
+  if (overlappingWriter == nullptr)
+  {
+    for (ImageAccessorBase *w : m_Image->m_PendingWriters)
     {
-      ImageAccessorBase *w = *it;
-      if (Overlap(w))
+      if (Overlap(w) && !HoldsReadAccessRequiredBy(w))
       {
-        // An Overlap was detected. There are two possibilities to deal with this situation:
-        // Throw an exception or wait for the WriteAccessor w until it is released and start again with the request
-        // afterwards.
-        if (!(m_Options & ExceptionIfLocked))
-        {
-          PreventRecursiveMutexLock(w);
-
-          // WAIT
-          w->Increment();
-          m_Image->m_ReadWriteLock.Unlock();
-          ImageAccessorBase::WaitForReleaseOf(w->m_WaitLock);
-
-          // after waiting for the WriteAccessor w, start this method again
-          OrganizeReadAccess();
-          return;
-        }
-        else
-        {
-          // THROW EXCEPTION
-          m_Image->m_ReadWriteLock.Unlock();
-          mitkThrowException(mitk::MemoryIsLockedException)
-            << "The image part being ordered by the ImageAccessor is already in use and locked";
-          return;
-        }
-      } // if
-    }   // for
-  }     // if
+        overlappingWriter = w;
+        break;
+      }
+    }
+  }
+
+  if (overlappingWriter != nullptr)
+  {
+    // An Overlap was detected. There are two possibilities to deal with this situation:
+    // Throw an exception or wait for the WriteAccessor w until it is released and start again with the request
+    // afterwards.
+    if (!(m_Options & ExceptionIfLocked))
+    {
+      PreventRecursiveMutexLock(overlappingWriter);
+
+      // WAIT
+      overlappingWriter->Increment();
+      m_Image->m_ReadWriteLock.Unlock();
+      ImageAccessorBase::WaitForReleaseOf(overlappingWriter->m_WaitLock);
+
+      // after waiting for the WriteAccessor w, start this method again
+      OrganizeReadAccess();
+      return;
+    }
+    else
+    {
+      // THROW EXCEPTION
+      m_Image->m_ReadWriteLock.Unlock();
+      mitkThrowException(mitk::MemoryIsLockedException)
+        << "The image part being ordered by the ImageAccessor is already in use and locked";
+      return;
+    }
+  }
 
   // Now, we know, that there is no conflict with a Write-Access
   // Lock the Mutex in ImageAccessorBase, to make sure that every other ImageAccessor has to wait if it locks the mutex
   m_WaitLock->m_Mutex.Lock();
 
   // insert self into readers list in Image
-  m_Image->m_Readers.push_back(this);
+  shard.m_Lock.Lock();
+  shard.m_Readers.push_back(this);
+  shard.m_Lock.Unlock();
 
-  // printf("ReadAccess %d %d\n",(int) m_Image->m_Readers.size(),(int) m_Image->m_Writers.size());
-  // fflush(0);
   m_Image->m_ReadWriteLock.Unlock();
 }
+
+bool mitk::ImageReadAccessor::HoldsReadAccessRequiredBy(ImageAccessorBase *writer)
+{
+  // m_ReadWriteLock is locked, so the shards may be locked in ascending order
+  bool holdsReadAccess = false;
+  for (auto &shard : m_Image->m_ReaderShards)
+  {
+    shard.m_Lock.Lock();
+    for (const ImageAccessorBase *r : shard.m_Readers)
+    {
+      if (IsRequestedRecursively(r) && writer->Overlap(r))
+      {
+        holdsReadAccess = true;
+        break;
+      }
+    }
+    shard.m_Lock.Unlock();
+
+    if (holdsReadAccess)
+      break;
+  }
+  return holdsReadAccess;
+}
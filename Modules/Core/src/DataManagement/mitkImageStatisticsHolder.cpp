@@ -11,9 +11,36 @@ found in the LICENSE file.
 ============================================================================*/
 #include "mitkImageStatisticsHolder.h"
 
+#include "mitkCallbackFromGUIThread.h"
 #include "mitkHistogramGenerator.h"
+#include "mitkImageReadAccessor.h"
+#include "mitkPixelTypeMultiplex.h"
 #include <mitkProperties.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+struct mitk::ImageStatisticsHolder::AsyncComputation
+{
+  std::thread m_Thread;
+  std::atomic<bool> m_Cancel;
+  std::atomic<bool> m_Finished;
+  int m_TimeStep;
+  itk::ModifiedTimeType m_ImageMTime;
+
+  /** Written by the worker thread before m_Finished is set */
+  StatisticsEstimate m_Result;
+  bool m_Complete;
+
+  /** Guards m_Holder, which is reset when the holder is destroyed */
+  std::mutex m_HolderMutex;
+  ImageStatisticsHolder *m_Holder;
+};
+
 mitk::ImageStatisticsHolder::ImageStatisticsHolder(mitk::Image *image)
   : m_Image(image)
 {
@@ -30,6 +57,26 @@ mitk::ImageStatisticsHolder::ImageStatisticsHolder(mitk::Image *image)
 
 mitk::ImageStatisticsHolder::~ImageStatisticsHolder()
 {
+  MemoryAccounting::GetInstance().UnregisterCache(this);
+
+  if (m_AsyncComputation)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_AsyncComputation->m_HolderMutex);
+      m_AsyncComputation->m_Holder = nullptr;
+    }
+    m_AsyncComputation->m_Cancel = true;
+
+    if (m_AsyncComputation->m_Thread.joinable())
+    {
+      // the worker releases its image reference when done, which might destroy the image and us
+      if (m_AsyncComputation->m_Thread.get_id() == std::this_thread::get_id())
+        m_AsyncComputation->m_Thread.detach();
+      else
+        m_AsyncComputation->m_Thread.join();
+    }
+  }
+
   m_HistogramGeneratorObject = nullptr;
 }
 
@@ -42,15 +89,34 @@ const mitk::ImageStatisticsHolder::HistogramType *mitk::ImageStatisticsHolder::G
     timeSelector->SetTimeNr(t);
     timeSelector->UpdateLargestPossibleRegion();
 
+    std::lock_guard<std::mutex> lock(m_HistogramMutex);
     auto *generator =
       static_cast<mitk::HistogramGenerator *>(m_HistogramGeneratorObject.GetPointer());
     generator->SetImage(timeSelector->GetOutput());
     generator->ComputeHistogram();
+    MemoryAccounting::GetInstance().RegisterCache(this, MemoryAccounting::StatisticsHistogramType, m_Image);
     return static_cast<const mitk::ImageStatisticsHolder::HistogramType *>(generator->GetHistogram());
   }
   return nullptr;
 }
 
+std::size_t mitk::ImageStatisticsHolder::GetCacheSize() const
+{
+  std::lock_guard<std::mutex> lock(m_HistogramMutex);
+  const auto *generator = static_cast<const mitk::HistogramGenerator *>(m_HistogramGeneratorObject.GetPointer());
+  const HistogramType *histogram = generator != nullptr ? generator->GetHistogram() : nullptr;
+
+  // frequency and bin bounds of every bin
+  return histogram != nullptr ? histogram->Size() * 3 * sizeof(double) : 0;
+}
+
+void mitk::ImageStatisticsHolder::ReleaseCache()
+{
+  std::lock_guard<std::mutex> lock(m_HistogramMutex);
+  if (auto *generator = static_cast<mitk::HistogramGenerator *>(m_HistogramGeneratorObject.GetPointer()))
+    generator->SetImage(nullptr);
+}
+
 bool mitk::ImageStatisticsHolder::IsValidTimeStep(int t) const
 {
   return m_Image->IsValidTimeStep(t);
@@ -95,6 +161,9 @@ void mitk::ImageStatisticsHolder::ResetImageStatistics()
 }
 
 #include "mitkImageAccessByItk.h"
+#include "mitkImageExtremaAccumulator.h"
+
+#include <itkImageScanlineConstIterator.h>
 
 //#define BOUNDINGOBJECT_IGNORE
 
@@ -108,9 +177,7 @@ void mitk::_ComputeExtremaInItkImage(const ItkImageType *itkImage, mitk::ImageSt
   if (region != itkImage->GetRequestedRegion())
     return;
 
-  itk::ImageRegionConstIterator<ItkImageType> it(itkImage, region);
   typedef typename ItkImageType::PixelType TPixel;
-  TPixel value = 0;
 
   if (statisticsHolder == nullptr || !statisticsHolder->IsValidTimeStep(t))
     return;
@@ -122,49 +189,34 @@ void mitk::_ComputeExtremaInItkImage(const ItkImageType *itkImage, mitk::ImageSt
   statisticsHolder->m_Scalar2ndMax[t] = statisticsHolder->m_ScalarMax[t] =
     itk::NumericTraits<ScalarType>::NonpositiveMin();
 
-  while (!it.IsAtEnd())
+  ImageExtremaAccumulator<TPixel> extrema;
+  if (region == itkImage->GetBufferedRegion())
   {
-    value = it.Get();
-#ifdef BOUNDINGOBJECT_IGNORE
-    if (value > -32765)
+    // the usual case: one pass over the contiguous buffer, multi-threaded
+    extrema = ImageExtremaAccumulator<TPixel>::Compute(itkImage->GetBufferPointer(), region.GetNumberOfPixels());
+  }
+  else
+  {
+    itk::ImageScanlineConstIterator<ItkImageType> it(itkImage, region);
+    while (!it.IsAtEnd())
     {
-#endif
-      // update min
-      if (value < statisticsHolder->m_ScalarMin[t])
-      {
-        statisticsHolder->m_Scalar2ndMin[t] = statisticsHolder->m_ScalarMin[t];
-        statisticsHolder->m_ScalarMin[t] = value;
-        statisticsHolder->m_CountOfMinValuedVoxels[t] = 1;
-      }
-      else if (value == statisticsHolder->m_ScalarMin[t])
-      {
-        ++statisticsHolder->m_CountOfMinValuedVoxels[t];
-      }
-      else if (value < statisticsHolder->m_Scalar2ndMin[t])
-      {
-        statisticsHolder->m_Scalar2ndMin[t] = value;
-      }
-
-      // update max
-      if (value > statisticsHolder->m_ScalarMax[t])
-      {
-        statisticsHolder->m_Scalar2ndMax[t] = statisticsHolder->m_ScalarMax[t];
-        statisticsHolder->m_ScalarMax[t] = value;
-        statisticsHolder->m_CountOfMaxValuedVoxels[t] = 1;
-      }
-      else if (value == statisticsHolder->m_ScalarMax[t])
-      {
-        ++statisticsHolder->m_CountOfMaxValuedVoxels[t];
-      }
-      else if (value > statisticsHolder->m_Scalar2ndMax[t])
-      {
-        statisticsHolder->m_Scalar2ndMax[t] = value;
-      }
-#ifdef BOUNDINGOBJECT_IGNORE
+      extrema.Add(&it.Value(), region.GetSize(0));
+      it.NextLine();
     }
-#endif
+  }
 
-    ++it;
+  if (!extrema.IsEmpty())
+  {
+    statisticsHolder->m_ScalarMin[t] = extrema.GetMin();
+    statisticsHolder->m_ScalarMax[t] = extrema.GetMax();
+    statisticsHolder->m_CountOfMinValuedVoxels[t] = static_cast<unsigned int>(extrema.GetMinCount());
+    statisticsHolder->m_CountOfMaxValuedVoxels[t] = static_cast<unsigned int>(extrema.GetMaxCount());
+    if (extrema.GetMin() != extrema.GetMax())
+    {
+      // both exist if there are at least two distinct values
+      statisticsHolder->m_Scalar2ndMin[t] = extrema.GetSecondMin();
+      statisticsHolder->m_Scalar2ndMax[t] = extrema.GetSecondMax();
+    }
   }
 
   //// guard for wrong 2dMin/Max on single constant value images
@@ -259,6 +311,10 @@ void mitk::ImageStatisticsHolder::ComputeImageStatistics(int t, unsigned int com
   if (!m_Image->IsValidTimeStep(t))
     return;
 
+  // a background computation of this time step is faster to wait for than to repeat
+  if (m_AsyncComputation)
+    this->AdoptAsyncComputation(m_AsyncComputation->m_TimeStep == t);
+
   // image modified?
   if (this->m_Image->GetMTime() > m_LastRecomputeTimeStamp.GetMTime())
     this->ResetImageStatistics();
@@ -345,3 +401,267 @@ mitk::ScalarType mitk::ImageStatisticsHolder::GetCountOfMaxValuedVoxels(int t, u
   ComputeImageStatistics(t, component);
   return m_CountOfMaxValuedVoxels[t];
 }
+
+
+namespace
+{
+  /** Statistics in the form ImageStatisticsHolder stores them, see _ComputeExtremaInItkImage() */
+  template <typename TPixel>
+  mitk::ImageStatisticsHolder::StatisticsEstimate ToStatistics(const mitk::ImageExtremaAccumulator<TPixel> &extrema,
+                                                               mitk::ScalarType countScale,
+                                                               bool isExact)
+  {
+    mitk::ImageStatisticsHolder::StatisticsEstimate statistics;
+    statistics.SecondMin = statistics.Min = itk::NumericTraits<mitk::ScalarType>::max();
+    statistics.SecondMax = statistics.Max = itk::NumericTraits<mitk::ScalarType>::NonpositiveMin();
+    statistics.CountOfMinValuedVoxels = statistics.CountOfMaxValuedVoxels = 0;
+    statistics.IsExact = isExact;
+
+    if (!extrema.IsEmpty())
+    {
+      statistics.Min = extrema.GetMin();
+      statistics.Max = extrema.GetMax();
+      statistics.CountOfMinValuedVoxels = std::round(extrema.GetMinCount() * countScale);
+      statistics.CountOfMaxValuedVoxels = std::round(extrema.GetMaxCount() * countScale);
+      if (extrema.GetMin() != extrema.GetMax())
+      {
+        statistics.SecondMin = extrema.GetSecondMin();
+        statistics.SecondMax = extrema.GetSecondMax();
+      }
+      else
+      {
+        statistics.SecondMin = statistics.SecondMax = statistics.Max;
+      }
+    }
+    return statistics;
+  }
+
+  /** Estimates the statistics from every stride-th voxel of count voxels */
+  template <typename TPixel>
+  void EstimateStatistics(const mitk::PixelType &,
+                          const void *data,
+                          std::size_t count,
+                          std::size_t stride,
+                          mitk::ImageStatisticsHolder::StatisticsEstimate *statistics)
+  {
+    const auto *pixels = static_cast<const TPixel *>(data);
+    std::vector<TPixel> samples;
+    samples.reserve(count / stride + 1);
+    for (std::size_t i = 0; i < count; i += stride)
+      samples.push_back(pixels[i]);
+
+    mitk::ImageExtremaAccumulator<TPixel> extrema;
+    extrema.Add(samples.data(), samples.size());
+    *statistics = ToStatistics(extrema, static_cast<mitk::ScalarType>(count) / samples.size(), false);
+  }
+
+  /** Computes the exact statistics in chunks, so that writers are not locked out and cancel requests are served.
+    statistics is only changed, and IsExact set, if the computation was not cancelled. */
+  template <typename TPixel>
+  void ComputeStatisticsInChunks(const mitk::PixelType &,
+                                 const mitk::Image *image,
+                                 const mitk::ImageDataItem *volume,
+                                 std::size_t count,
+                                 const std::atomic<bool> *cancel,
+                                 mitk::ImageStatisticsHolder::StatisticsEstimate *statistics)
+  {
+    const std::size_t chunkSize = 1 << 22;
+
+    mitk::ImageExtremaAccumulator<TPixel> extrema;
+    for (std::size_t offset = 0; offset < count; offset += chunkSize)
+    {
+      if (*cancel)
+        return;
+
+      mitk::ImageReadAccessor accessor(mitk::Image::ConstPointer(image), volume);
+      const auto *pixels = static_cast<const TPixel *>(accessor.GetData()) + offset;
+      extrema.Merge(mitk::ImageExtremaAccumulator<TPixel>::Compute(pixels, std::min(chunkSize, count - offset)));
+    }
+
+    *statistics = ToStatistics(extrema, 1.0, true);
+  }
+
+  /** Command executed in the GUI thread when a background computation is finished */
+  class StatisticsComputedCommand : public itk::Command
+  {
+  public:
+    typedef StatisticsComputedCommand Self;
+    typedef itk::SmartPointer<Self> Pointer;
+    itkFactorylessNewMacro(Self);
+
+    std::function<void()> m_Callback;
+
+    void Execute(itk::Object *, const itk::EventObject &) override { m_Callback(); }
+    void Execute(const itk::Object *, const itk::EventObject &) override { m_Callback(); }
+  };
+}
+
+mitk::ImageStatisticsHolder::StatisticsEstimate mitk::ImageStatisticsHolder::ComputeImageStatisticsAsync(
+  int t, unsigned int component)
+{
+  StatisticsEstimate statistics;
+  statistics.SecondMin = statistics.Min = itk::NumericTraits<ScalarType>::max();
+  statistics.SecondMax = statistics.Max = itk::NumericTraits<ScalarType>::NonpositiveMin();
+  statistics.CountOfMinValuedVoxels = statistics.CountOfMaxValuedVoxels = 0;
+  statistics.IsExact = true;
+
+  if (!m_Image->IsValidTimeStep(t))
+    return statistics;
+
+  if (m_AsyncComputation)
+  {
+    this->AdoptAsyncComputation(false);
+    if (m_AsyncComputation && m_AsyncComputation->m_TimeStep != t)
+    {
+      this->CancelImageStatisticsComputation();
+    }
+  }
+
+  const std::size_t count =
+    static_cast<std::size_t>(m_Image->GetDimension(0)) * m_Image->GetDimension(1) * m_Image->GetDimension(2);
+
+  // a subsample of about 64k voxels is cheap enough for every interaction
+  const std::size_t sampleSize = 1 << 16;
+
+  const mitk::PixelType pType = m_Image->GetPixelType(0);
+  const bool isScalar = pType.GetNumberOfComponents() == 1 &&
+                        pType.GetPixelType() != itk::ImageIOBase::UNKNOWNPIXELTYPE &&
+                        pType.GetPixelType() != itk::ImageIOBase::VECTOR;
+  mitk::ImageDataItem::Pointer volume;
+  if (isScalar && count > sampleSize && !m_AsyncComputation && !this->IsImageStatisticsAvailable(t))
+    volume = m_Image->GetVolumeData(t);
+
+  if (volume.IsNull())
+  {
+    // available, already being computed or not suited for background computation
+    if (!m_AsyncComputation || this->IsImageStatisticsAvailable(t))
+    {
+      this->ComputeImageStatistics(t, component);
+      statistics.Min = m_ScalarMin[t];
+      statistics.Max = m_ScalarMax[t];
+      statistics.SecondMin = m_Scalar2ndMin[t];
+      statistics.SecondMax = m_Scalar2ndMax[t];
+      statistics.CountOfMinValuedVoxels = m_CountOfMinValuedVoxels[t];
+      statistics.CountOfMaxValuedVoxels = m_CountOfMaxValuedVoxels[t];
+      return statistics;
+    }
+  }
+
+  const std::size_t stride = std::max<std::size_t>(1, count / sampleSize);
+  {
+    mitk::ImageReadAccessor accessor(mitk::Image::ConstPointer(m_Image),
+                                     volume.IsNotNull() ? volume.GetPointer() : m_Image->GetVolumeData(t).GetPointer());
+    mitkPixelTypeMultiplex4(EstimateStatistics, pType, accessor.GetData(), count, stride, &statistics);
+  }
+
+  statistics.IsExact = false;
+  if (volume.IsNull())
+    return statistics;
+
+  m_AsyncComputation = std::make_shared<AsyncComputation>();
+  m_AsyncComputation->m_Cancel = false;
+  m_AsyncComputation->m_Finished = false;
+  m_AsyncComputation->m_TimeStep = t;
+  m_AsyncComputation->m_ImageMTime = m_Image->GetMTime();
+  m_AsyncComputation->m_Result = statistics;
+  m_AsyncComputation->m_Complete = false;
+  m_AsyncComputation->m_Holder = this;
+
+  std::shared_ptr<AsyncComputation> state = m_AsyncComputation;
+  mitk::Image::ConstPointer image = m_Image;
+  m_AsyncComputation->m_Thread = std::thread([state, image, volume, pType, count]() mutable {
+    StatisticsEstimate result = state->m_Result;
+    mitkPixelTypeMultiplex5(
+      ComputeStatisticsInChunks, pType, image.GetPointer(), volume.GetPointer(), count, &state->m_Cancel, &result);
+    const bool complete = result.IsExact;
+
+    state->m_Result = result;
+    state->m_Complete = complete;
+
+    // might destroy the image and its statistics holder, which then detaches this thread
+    volume = nullptr;
+    image = nullptr;
+
+    state->m_Finished = true;
+
+    std::lock_guard<std::mutex> lock(state->m_HolderMutex);
+    if (state->m_Holder != nullptr && complete && mitk::CallbackFromGUIThread::IsImplementationRegistered())
+    {
+      auto command = StatisticsComputedCommand::New();
+      command->m_Callback = [state]() {
+        // the image keeps the holder alive while observers of the event run
+        mitk::Image::Pointer computedImage;
+        {
+          std::lock_guard<std::mutex> lock(state->m_HolderMutex);
+          if (state->m_Holder != nullptr && state->m_Holder->m_AsyncComputation == state)
+            computedImage = state->m_Holder->m_Image;
+        }
+        if (computedImage.IsNotNull())
+          computedImage->GetStatistics()->AdoptAsyncComputation(false);
+      };
+      mitk::CallbackFromGUIThread::GetInstance()->CallThisFromGUIThread(command);
+    }
+  });
+
+  return statistics;
+}
+
+bool mitk::ImageStatisticsHolder::AdoptAsyncComputation(bool wait)
+{
+  if (!m_AsyncComputation || (!wait && !m_AsyncComputation->m_Finished))
+    return false;
+
+  std::shared_ptr<AsyncComputation> state = m_AsyncComputation;
+  m_AsyncComputation = nullptr;
+  if (state->m_Thread.joinable())
+    state->m_Thread.join();
+
+  // discard results of an image which changed since the computation started
+  if (!state->m_Complete || state->m_Cancel || m_Image->GetMTime() != state->m_ImageMTime)
+    return false;
+
+  const int t = state->m_TimeStep;
+  if (m_Image->GetMTime() > m_LastRecomputeTimeStamp.GetMTime())
+    this->ResetImageStatistics();
+  this->Expand(t + 1);
+  m_ScalarMin[t] = state->m_Result.Min;
+  m_ScalarMax[t] = state->m_Result.Max;
+  m_Scalar2ndMin[t] = state->m_Result.SecondMin;
+  m_Scalar2ndMax[t] = state->m_Result.SecondMax;
+  m_CountOfMinValuedVoxels[t] = static_cast<unsigned int>(state->m_Result.CountOfMinValuedVoxels);
+  m_CountOfMaxValuedVoxels[t] = static_cast<unsigned int>(state->m_Result.CountOfMaxValuedVoxels);
+  m_LastRecomputeTimeStamp.Modified();
+
+  m_Image->InvokeEvent(ImageStatisticsComputedEvent());
+
+  return true;
+}
+
+bool mitk::ImageStatisticsHolder::IsImageStatisticsAvailable(int t) const
+{
+  if (t < 0 || static_cast<std::size_t>(t) >= m_ScalarMin.size() ||
+      m_Image->GetMTime() > m_LastRecomputeTimeStamp.GetMTime())
+    return false;
+
+  return m_ScalarMin[t] != itk::NumericTraits<ScalarType>::max() ||
+         m_Scalar2ndMin[t] != itk::NumericTraits<ScalarType>::max();
+}
+
+bool mitk::ImageStatisticsHolder::IsImageStatisticsComputationRunning() const
+{
+  return m_AsyncComputation && !m_AsyncComputation->m_Finished;
+}
+
+void mitk::ImageStatisticsHolder::CancelImageStatisticsComputation()
+{
+  if (!m_AsyncComputation)
+    return;
+
+  m_AsyncComputation->m_Cancel = true;
+  this->AdoptAsyncComputation(true);
+}
+
+void mitk::ImageStatisticsHolder::WaitForImageStatistics()
+{
+  this->AdoptAsyncComputation(true);
+}
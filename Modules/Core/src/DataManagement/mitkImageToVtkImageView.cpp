@@ -0,0 +1,82 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkImageToVtkImageView.h"
+
+#include "mitkExceptionMacro.h"
+#include "mitkImage.h"
+#include "mitkImageReadAccessor.h"
+#include "mitkImageVtkReadAccessor.h"
+
+#include <vtkCallbackCommand.h>
+
+#include <memory>
+
+namespace
+{
+  /** Keeps the viewed volume and its read access alive until the view is deleted. */
+  struct VtkImageViewOwner
+  {
+    mitk::Image::ImageDataItemPointer m_Volume;
+    std::unique_ptr<mitk::ImageReadAccessor> m_Accessor;
+  };
+
+  void ReleaseVtkImageView(void *clientData) { delete static_cast<VtkImageViewOwner *>(clientData); }
+  void IgnoreVtkImageViewEvent(vtkObject *, unsigned long, void *, void *) {}
+}
+
+vtkSmartPointer<vtkImageData> mitk::ImageToVtkImageView(const Image *image, int t, int n)
+{
+  if (image == nullptr)
+  {
+    mitkThrow() << "Cannot create a vtkImageData view of a null image.";
+  }
+
+  if (!image->IsInitialized())
+  {
+    mitkThrow() << "Cannot create a vtkImageData view of an uninitialized image.";
+  }
+
+  std::unique_ptr<VtkImageViewOwner> owner(new VtkImageViewOwner);
+  owner->m_Volume = image->GetVolumeData(t, n);
+  if (owner->m_Volume.IsNull())
+  {
+    mitkThrow() << "Image has no volume for time step " << t << " and channel " << n << ".";
+  }
+
+  // Lock before touching the vtkImageData of the volume, so a concurrent writer cannot interfere.
+  owner->m_Accessor.reset(new ImageReadAccessor(image, owner->m_Volume.GetPointer()));
+  if (owner->m_Accessor->GetData() == nullptr)
+  {
+    mitkThrow() << "Image has no data for time step " << t << " and channel " << n << ".";
+  }
+
+  const vtkImageData *volumeVtkImage = owner->m_Volume->GetVtkImageAccessor(image)->GetVtkImageData();
+  if (volumeVtkImage == nullptr)
+  {
+    mitkThrow() << "Pixel type " << image->GetPixelType().GetPixelTypeAsString()
+                << " cannot be represented as vtkImageData.";
+  }
+
+  // ShallowCopy shares the scalar array of the volume, the pixel buffer itself is not copied.
+  vtkSmartPointer<vtkImageData> view = vtkSmartPointer<vtkImageData>::New();
+  view->ShallowCopy(const_cast<vtkImageData *>(volumeVtkImage));
+
+  // The command is destroyed together with the view and releases the owner on destruction.
+  vtkSmartPointer<vtkCallbackCommand> ownerCommand = vtkSmartPointer<vtkCallbackCommand>::New();
+  ownerCommand->SetCallback(&IgnoreVtkImageViewEvent);
+  ownerCommand->SetClientData(owner.release());
+  ownerCommand->SetClientDataDeleteCallback(&ReleaseVtkImageView);
+  view->AddObserver(vtkCommand::DeleteEvent, ownerCommand);
+
+  return view;
+}
@@ -0,0 +1,21 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkImageVolumeProvider.h"
+
+mitk::ImageVolumeProvider::ImageVolumeProvider()
+{
+}
+
+mitk::ImageVolumeProvider::~ImageVolumeProvider()
+{
+}
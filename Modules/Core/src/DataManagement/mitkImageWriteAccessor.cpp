@@ -12,11 +12,22 @@ found in the LICENSE file.
 
 #include "mitkImageWriteAccessor.h"
 
+#include <algorithm>
+#include <iterator>
+
 mitk::ImageWriteAccessor::ImageWriteAccessor(ImagePointer image, const mitk::ImageDataItem *iDI, int OptionFlags)
   : ImageAccessorBase(image.GetPointer(), iDI, OptionFlags), m_Image(image)
 
 {
   OrganizeWriteAccess();
+
+  // copy-on-write: memory that is shared with another image must not be changed
+  if (m_Image->CopySharedViews())
+  {
+    const ImageDataItem *item = iDI != nullptr ? iDI : m_Image->GetChannelData().GetPointer();
+    m_AddressBegin = item->m_Data;
+    m_AddressEnd = static_cast<unsigned char *>(m_AddressBegin) + item->m_Size;
+  }
 }
 
 mitk::ImageWriteAccessor::~ImageWriteAccessor()
@@ -26,9 +37,10 @@ mitk::ImageWriteAccessor::~ImageWriteAccessor()
 
   m_Image->m_ReadWriteLock.Lock();
 
-  // delete self from list of ImageReadAccessors in Image
+  // delete self from list of ImageWriteAccessors in Image
   auto it = std::find(m_Image->m_Writers.begin(), m_Image->m_Writers.end(), this);
   m_Image->m_Writers.erase(it);
+  --m_Image->m_NumberOfWriters;
 
   // delete lock, if there are no waiting ImageAccessors
   if (m_WaitLock->m_WaiterCount <= 0)
@@ -53,69 +65,78 @@ void mitk::ImageWriteAccessor::OrganizeWriteAccess()
 {
   m_Image->m_ReadWriteLock.Lock();
 
-  bool readOverlap = false;
-  bool writeOverlap = false;
+  const bool pending =
+    std::find(m_Image->m_PendingWriters.begin(), m_Image->m_PendingWriters.end(), this) !=
+    m_Image->m_PendingWriters.end();
+
+  // announce the write access, so that new readers cannot take the fast path that bypasses m_ReadWriteLock
+  if (!pending)
+    ++m_Image->m_NumberOfWriters;
 
+  ImageAccessorBase *overlapping = nullptr;
   ImageAccessorWaitLock *overlapLock = nullptr;
+  bool recursive = false;
 
-  // Check, if there is any Read-Access going on
-  if (m_Image->m_Readers.size() > 0)
-  {
-    // Check for every ReadAccessor, if the Region of this ImageAccessors overlaps
-    // make sure this iterator is not used, when m_ReadWriteLock is Unlocked!
-    auto it = m_Image->m_Readers.begin();
+  // Check, if there is any Read-Access going on. The shards are locked in ascending order,
+  // waiter counts of readers are protected by the lock of their shard.
+  for (auto &shard : m_Image->m_ReaderShards)
+    shard.m_Lock.Lock();
 
-    for (; it != m_Image->m_Readers.end(); ++it)
+  for (auto shardIt = std::begin(m_Image->m_ReaderShards);
+       shardIt != std::end(m_Image->m_ReaderShards) && overlapping == nullptr;
+       ++shardIt)
+  {
+    for (ImageAccessorBase *r : shardIt->m_Readers)
     {
-      ImageAccessorBase *r = *it;
-
       if ((r->m_Options & IgnoreLock) == 0 && Overlap(r))
       {
         // An Overlap was detected.
-
-        PreventRecursiveMutexLock(r);
-
-        readOverlap = true;
-        overlapLock = r->m_WaitLock;
+        overlapping = r;
+        recursive = IsRequestedRecursively(r);
+        if (!recursive && !(m_Options & ExceptionIfLocked))
+        {
+          overlapLock = r->m_WaitLock;
+          overlapLock->m_WaiterCount += 1;
+        }
         break;
-      } // if
-    }   // for
-  }     // if
+      }
+    }
+  }
+
+  for (auto shardIt = std::rbegin(m_Image->m_ReaderShards); shardIt != std::rend(m_Image->m_ReaderShards); ++shardIt)
+    shardIt->m_Lock.Unlock();
 
   // Check, if there is any Write-Access going on
-  if (m_Image->m_Writers.size() > 0)
+  if (overlapping == nullptr)
   {
-    // Check for every WriteAccessor, if the Region of this ImageAccessors overlaps
-    // make sure this iterator is not used, when m_ReadWriteLock is Unlocked!
-    auto it = m_Image->m_Writers.begin();
-
-    for (; it != m_Image->m_Writers.end(); ++it)
+    for (ImageAccessorBase *w : m_Image->m_Writers)
     {
-      ImageAccessorBase *w = *it;
-
       if ((w->m_Options & IgnoreLock) == 0 && Overlap(w))
       {
         // An Overlap was detected.
-
-        PreventRecursiveMutexLock(w);
-
-        // save overlapping Waitlock
-        writeOverlap = true;
-        overlapLock = w->m_WaitLock;
+        overlapping = w;
+        recursive = IsRequestedRecursively(w);
+        if (!recursive && !(m_Options & ExceptionIfLocked))
+        {
+          overlapLock = w->m_WaitLock;
+          overlapLock->m_WaiterCount += 1;
+        }
         break;
+      }
+    }
+  }
 
-      } // if
-    }   // for
-  }     // if
-
-  if (readOverlap || writeOverlap)
+  if (overlapping != nullptr)
   {
-    // Throw an exception or wait for the WriteAccessor w until it is released and start again with the request
-    // afterwards.
-    if (!(m_Options & ExceptionIfLocked))
+    // Wait for the ImageAccessor until it is released and start again with the request afterwards
+    if (overlapLock != nullptr)
     {
-      // WAIT
-      overlapLock->m_WaiterCount += 1;
+      if (!pending)
+      {
+        // Until this accessor gets its access, new overlapping readers wait for it (writer preference)
+        m_WaitLock->m_Mutex.Lock();
+        m_Image->m_PendingWriters.push_back(this);
+      }
       m_Image->m_ReadWriteLock.Unlock();
       ImageAccessorBase::WaitForReleaseOf(overlapLock);
 
@@ -123,25 +144,58 @@ void mitk::ImageWriteAccessor::OrganizeWriteAccess()
       OrganizeWriteAccess();
       return;
     }
+
+    // Throw an exception: withdraw the announced (and possibly pending) write access first
+    --m_Image->m_NumberOfWriters;
+    if (pending)
+    {
+      m_Image->m_PendingWriters.erase(
+        std::find(m_Image->m_PendingWriters.begin(), m_Image->m_PendingWriters.end(), this));
+
+      // delete lock, if there are no waiting ImageAccessors (otherwise the last waiting one deletes it)
+      if (m_WaitLock->m_WaiterCount <= 0)
+      {
+        m_WaitLock->m_Mutex.Unlock();
+        delete m_WaitLock;
+      }
+      else
+      {
+        m_WaitLock->m_Mutex.Unlock();
+      }
+    }
     else
     {
-      // THROW EXCEPTION
-      m_Image->m_ReadWriteLock.Unlock();
-      mitkThrowException(mitk::MemoryIsLockedException)
-        << "The image part being ordered by the ImageAccessor is already in use and locked";
-      // MITK_ERROR("Speicherbereich belegt");
-      return;
+      delete m_WaitLock;
     }
+    // the destructor is not called if the constructor throws
+    m_WaitLock = nullptr;
+    m_Image->m_ReadWriteLock.Unlock();
+
+    if (recursive)
+    {
+      mitkThrow()
+        << "Prohibited image access: the requested image part is already in use and cannot be requested recursively!";
+    }
+    mitkThrowException(mitk::MemoryIsLockedException)
+      << "The image part being ordered by the ImageAccessor is already in use and locked";
+    return;
   }
 
   // Now, we know, that there is no conflict with a Read- or Write-Access
   // Lock the Mutex in ImageAccessorBase, to make sure that every other ImageAccessor has to wait
-  m_WaitLock->m_Mutex.Lock();
+  if (pending)
+  {
+    // the mutex is already locked since this accessor started to wait
+    m_Image->m_PendingWriters.erase(
+      std::find(m_Image->m_PendingWriters.begin(), m_Image->m_PendingWriters.end(), this));
+  }
+  else
+  {
+    m_WaitLock->m_Mutex.Lock();
+  }
 
   // insert self into Writers list in Image
   m_Image->m_Writers.push_back(this);
 
-  // printf("WriteAccess %d %d\n",(int) m_Image->m_Readers.size(),(int) m_Image->m_Writers.size());
-  // fflush(0);
   m_Image->m_ReadWriteLock.Unlock();
 }
@@ -27,12 +27,15 @@ found in the LICENSE file.
 mitk::LevelWindowManager::LevelWindowManager()
   : m_DataStorage(nullptr)
   , m_LevelWindowProperty(nullptr)
+  , m_NextSequence(0)
+  , m_NodeMarkedToDelete(nullptr)
   , m_AutoTopMost(true)
   , m_SelectedImagesMode(false)
   , m_IsObserverTagSet(false)
   , m_CurrentImage(nullptr)
   , m_IsPropertyModifiedTagSet(false)
   , m_LevelWindowMutex(false)
+  , m_ResetAllNodes(true)
 {
 }
 
@@ -53,8 +56,7 @@ mitk::LevelWindowManager::~LevelWindowManager()
     m_IsPropertyModifiedTagSet = false;
   }
 
-  // clear both observer maps
-  this->ClearPropObserverLists();
+  this->ClearIndex();
 }
 
 void mitk::LevelWindowManager::SetDataStorage(DataStorage *ds)
@@ -71,6 +73,9 @@ void mitk::LevelWindowManager::SetDataStorage(DataStorage *ds)
       MessageDelegate1<LevelWindowManager, const DataNode *>(this, &LevelWindowManager::DataStorageRemovedNode));
   }
 
+  this->ClearIndex();
+  m_ResetAllNodes = true;
+
   /* register listener for new DataStorage */
   m_DataStorage = ds; // register
   m_DataStorage->AddNodeEvent.AddListener(
@@ -109,54 +114,21 @@ void mitk::LevelWindowManager::SetAutoTopMostImage(bool autoTopMost, const DataN
     mitkThrow() << "DataStorage not set";
   }
 
-  DataNode::Pointer topLevelNode;
-  int maxVisibleLayer = itk::NumericTraits<int>::min();
   m_LevelWindowProperty = nullptr;
   m_CurrentImage = nullptr;
 
-  DataStorage::SetOfObjects::ConstPointer all = this->GetRelevantNodes();
-  for (DataStorage::SetOfObjects::ConstIterator it = all->Begin(); it != all->End(); ++it)
-  {
-    DataNode::Pointer node = it->Value();
-    if (node.IsNull() || node == removedNode)
-    {
-      continue;
-    }
-
-    m_LevelWindowMutex = true;
-    node->SetBoolProperty("imageForLevelWindow", false);
-    m_LevelWindowMutex = false;
-
-    if (false == node->IsVisible(nullptr))
-    {
-      continue;
-    }
-
-    int layer = -1;
-    node->GetIntProperty("layer", layer);
-    if (layer < maxVisibleLayer)
-    {
-      continue;
-    }
+  this->ResetImageForLevelWindow(nullptr);
 
-    bool ignore = this->IgnoreNode(node);
-    if (ignore)
-    {
-      continue;
-    }
-
-    m_LevelWindowProperty = dynamic_cast<LevelWindowProperty*>(node->GetProperty("levelwindow"));
-    topLevelNode = node;
-    maxVisibleLayer = layer;
-  }
-
-  // this will set the "imageForLevelWindow" property and the 'm_CurrentImage' and call 'Modified()'
-  this->SetLevelWindowProperty(m_LevelWindowProperty);
-
-  if (m_LevelWindowProperty.IsNull())
+  DataNode *topLevelNode = this->GetTopMostNode(true, removedNode);
+  if (nullptr == topLevelNode)
   {
     this->Modified();
+    return;
   }
+
+  // this will set the "imageForLevelWindow" property and the 'm_CurrentImage' and call 'Modified()'
+  this->ActivateLevelWindowProperty(dynamic_cast<LevelWindowProperty *>(topLevelNode->GetProperty("levelwindow")),
+                                    topLevelNode);
 }
 
 void mitk::LevelWindowManager::SetSelectedImages(bool selectedImagesMode, const DataNode *removedNode/* = nullptr*/)
@@ -182,56 +154,40 @@ void mitk::LevelWindowManager::SetSelectedImages(bool selectedImagesMode, const
     mitkThrow() << "DataStorage not set";
   }
 
-  DataNode::Pointer lastSelectedNode;
+  DataNode *lastSelectedNode = nullptr;
   m_LevelWindowProperty = nullptr;
   m_CurrentImage = nullptr;
 
-  DataStorage::SetOfObjects::ConstPointer all = this->GetRelevantNodes();
-  for (DataStorage::SetOfObjects::ConstIterator it = all->Begin(); it != all->End(); ++it)
-  {
-    DataNode::Pointer node = it->Value();
-    if (node.IsNull() || node == removedNode)
-    {
-      continue;
-    }
-
-    m_LevelWindowMutex = true;
-    node->SetBoolProperty("imageForLevelWindow", false);
-    m_LevelWindowMutex = false;
+  this->ResetImageForLevelWindow(nullptr);
 
-    if (false == node->IsSelected())
-    {
-      continue;
-    }
-
-    bool ignore = this->IgnoreNode(node);
-    if (ignore)
+  for (const auto &indexedNode : m_IndexedNodes)
+  {
+    DataNode *node = indexedNode.second.Node;
+    if (node == removedNode || false == node->IsSelected() || indexedNode.second.Ignored)
     {
       continue;
     }
 
-    m_LevelWindowProperty = dynamic_cast<LevelWindowProperty*>(node->GetProperty("levelwindow"));
     m_RelevantDataNodes.push_back(node);
     lastSelectedNode = node;
   }
 
-  // this will set the "imageForLevelWindow" property and the 'm_CurrentImage' and call 'Modified()'
-  this->SetLevelWindowProperty(m_LevelWindowProperty);
-
-  if (m_LevelWindowProperty.IsNull())
+  if (nullptr == lastSelectedNode)
   {
     this->Modified();
+    return;
   }
+
+  // this will set the "imageForLevelWindow" property and the 'm_CurrentImage' and call 'Modified()'
+  this->ActivateLevelWindowProperty(
+    dynamic_cast<LevelWindowProperty *>(lastSelectedNode->GetProperty("levelwindow")), lastSelectedNode);
 }
 
 void mitk::LevelWindowManager::RecalculateLevelWindowForSelectedComponent(const itk::EventObject &event)
 {
-  DataStorage::SetOfObjects::ConstPointer all = this->GetRelevantNodes();
-  for (DataStorage::SetOfObjects::ConstIterator it = all->Begin(); it != all->End(); ++it)
+  for (const auto &indexedNode : m_IndexedNodes)
   {
-    DataNode::Pointer node = it->Value();
-    if (node.IsNull())
-      continue;
+    DataNode *node = indexedNode.second.Node;
 
     bool isSelected = false;
     node->GetBoolProperty("selected", isSelected);
@@ -249,9 +205,6 @@ void mitk::LevelWindowManager::RecalculateLevelWindowForSelectedComponent(const
         node->SetLevelWindow(selectedLevelWindow);
       }
     }
-
-    LevelWindow levelWindow;
-    node->GetLevelWindow(levelWindow);
   }
 
   this->Update(event);
@@ -277,44 +230,19 @@ void mitk::LevelWindowManager::Update(const itk::EventObject &)
     return;
   }
 
-  int maxVisibleLayer = itk::NumericTraits<int>::min();
-  DataNode::Pointer topLevelNode = nullptr;
-  std::vector<DataNode::Pointer> nodesForLevelWindow;
-
-  DataStorage::SetOfObjects::ConstPointer all = this->GetRelevantNodes();
-  for (DataStorage::SetOfObjects::ConstIterator it = all->Begin(); it != all->End(); ++it)
+  std::vector<DataNode *> nodesForLevelWindow;
+  for (const auto *node : m_NodesForLevelWindow)
   {
-    DataNode::Pointer node = it->Value();
-
-    if (node.IsNull())
+    if (m_IndexedNodes.at(node).Visible)
     {
-      continue;
-    }
-
-    if (node->IsVisible(nullptr) == false)
-    {
-      continue;
-    }
-
-    bool prop = false;
-    node->GetBoolProperty("imageForLevelWindow", prop);
-    if (prop)
-    {
-      nodesForLevelWindow.push_back(node);
-      continue;
-    }
-
-    int layer = -1;
-    node->GetIntProperty("layer", layer);
-    if (layer > maxVisibleLayer)
-    {
-      // top level node is backup node, if no node with
-      // "imageForLevelWindow" property with value "true" is found
-      topLevelNode = node;
-      maxVisibleLayer = layer;
+      nodesForLevelWindow.push_back(m_IndexedNodes.at(node).Node);
     }
   }
 
+  // top level node is backup node, if no node with
+  // "imageForLevelWindow" property with value "true" is found
+  DataNode *topLevelNode = this->GetTopMostNode(false);
+
   int nodesForLevelWindowSize = nodesForLevelWindow.size();
   if (nodesForLevelWindowSize > 2)
   {
@@ -330,7 +258,7 @@ void mitk::LevelWindowManager::Update(const itk::EventObject &)
       LevelWindowProperty::Pointer newProp = dynamic_cast<LevelWindowProperty *>(node->GetProperty("levelwindow"));
       if (newProp != m_LevelWindowProperty)
       {
-        this->SetLevelWindowProperty(newProp);
+        this->ActivateLevelWindowProperty(newProp, node);
         return;
       }
     }
@@ -339,7 +267,7 @@ void mitk::LevelWindowManager::Update(const itk::EventObject &)
   {
     // no nodes for level window found
     LevelWindowProperty::Pointer lvlProp = dynamic_cast<LevelWindowProperty *>(topLevelNode->GetProperty("levelwindow"));
-    this->SetLevelWindowProperty(lvlProp);
+    this->ActivateLevelWindowProperty(lvlProp, topLevelNode);
   }
   else
   {
@@ -369,30 +297,47 @@ void mitk::LevelWindowManager::SetLevelWindowProperty(LevelWindowProperty::Point
     return;
   }
 
-  // find data node that belongs to the property
-  DataStorage::SetOfObjects::ConstPointer all = m_DataStorage->GetAll();
-  mitk::DataNode::Pointer propNode = nullptr;
-  for (DataStorage::SetOfObjects::ConstIterator it = all->Begin(); it != all->End(); ++it)
+  // find data node that belongs to the property, usually one of the relevant nodes
+  DataNode *propNode = nullptr;
+  for (const auto &indexedNode : m_IndexedNodes)
   {
-    DataNode::Pointer node = it.Value();
-    LevelWindowProperty::Pointer property = dynamic_cast<LevelWindowProperty *>(node->GetProperty("levelwindow"));
-    if (property == levelWindowProperty)
+    if (indexedNode.second.Node->GetProperty("levelwindow") == levelWindowProperty.GetPointer())
     {
-      propNode = node;
+      propNode = indexedNode.second.Node;
     }
-    else
+  }
+
+  if (nullptr == propNode && m_DataStorage.IsNotNull())
+  {
+    DataStorage::SetOfObjects::ConstPointer all = m_DataStorage->GetAll();
+    for (DataStorage::SetOfObjects::ConstIterator it = all->Begin(); it != all->End(); ++it)
     {
-      m_LevelWindowMutex = true;
-      node->SetBoolProperty("imageForLevelWindow", false);
-      m_LevelWindowMutex = false;
+      if (it.Value()->GetProperty("levelwindow") == levelWindowProperty.GetPointer())
+      {
+        propNode = it.Value();
+      }
     }
+    m_ResetAllNodes = true;
   }
 
-  if (propNode.IsNull())
+  if (nullptr == propNode)
   {
     mitkThrow() << "No Image in the data storage that belongs to level-window property " << m_LevelWindowProperty;
   }
 
+  this->ActivateLevelWindowProperty(levelWindowProperty, propNode);
+}
+
+void mitk::LevelWindowManager::ActivateLevelWindowProperty(LevelWindowProperty *levelWindowProperty,
+                                                           DataNode *propNode)
+{
+  if (nullptr == levelWindowProperty)
+  {
+    return;
+  }
+
+  this->ResetImageForLevelWindow(propNode);
+
   if (m_IsPropertyModifiedTagSet) // remove listener for old property
   {
     m_LevelWindowProperty->RemoveObserver(m_PropertyModifiedTag);
@@ -416,6 +361,38 @@ void mitk::LevelWindowManager::SetLevelWindowProperty(LevelWindowProperty::Point
   this->Modified();
 }
 
+void mitk::LevelWindowManager::ResetImageForLevelWindow(const DataNode *exceptNode)
+{
+  m_LevelWindowMutex = true;
+
+  if (m_ResetAllNodes && m_DataStorage.IsNotNull())
+  {
+    DataStorage::SetOfObjects::ConstPointer all = m_DataStorage->GetAll();
+    for (DataStorage::SetOfObjects::ConstIterator it = all->Begin(); it != all->End(); ++it)
+    {
+      if (it.Value() != exceptNode)
+      {
+        it.Value()->SetBoolProperty("imageForLevelWindow", false);
+      }
+    }
+    m_ResetAllNodes = false;
+  }
+  else
+  {
+    // the property observers remove the nodes from m_NodesForLevelWindow
+    const std::set<const DataNode *> nodesForLevelWindow = m_NodesForLevelWindow;
+    for (const auto *node : nodesForLevelWindow)
+    {
+      if (node != exceptNode)
+      {
+        m_IndexedNodes.at(node).Node->SetBoolProperty("imageForLevelWindow", false);
+      }
+    }
+  }
+
+  m_LevelWindowMutex = false;
+}
+
 void mitk::LevelWindowManager::SetLevelWindow(const LevelWindow &levelWindow)
 {
   if (m_LevelWindowProperty.IsNotNull())
@@ -464,35 +441,18 @@ bool mitk::LevelWindowManager::IsSelectedImages()
 
 void mitk::LevelWindowManager::DataStorageAddedNode(const DataNode *)
 {
-  // update observers with new data storage
-  this->UpdateObservers();
+  // index the new node, if it is relevant
+  this->UpdateIndex();
 
   // Initialize LevelWindowsManager to new image
   this->SetAutoTopMostImage(true);
-
-  // check if everything is still ok
-  if ((m_ObserverToVisibleProperty.size() != m_ObserverToLayerProperty.size()) ||
-      (m_ObserverToLayerProperty.size() != this->GetRelevantNodes()->size()))
-  {
-    mitkThrow() << "Wrong number of observers in Level Window Manager!";
-  }
 }
 
 void mitk::LevelWindowManager::DataStorageRemovedNode(const DataNode *removedNode)
 {
   // First: check if deleted node is part of relevant nodes.
   // If not, abort method because there is no need change anything.
-  bool removedNodeIsRelevant = false;
-  DataStorage::SetOfObjects::ConstPointer relevantNodes = GetRelevantNodes();
-  for (DataStorage::SetOfObjects::ConstIterator it = relevantNodes->Begin(); it != relevantNodes->End(); ++it)
-  {
-    if (it->Value() == removedNode)
-    {
-      removedNodeIsRelevant = true;
-    }
-  }
-
-  if (false == removedNodeIsRelevant)
+  if (0 == m_IndexedNodes.count(removedNode))
   {
     return;
   }
@@ -500,34 +460,18 @@ void mitk::LevelWindowManager::DataStorageRemovedNode(const DataNode *removedNod
   // remember node which will be removed
   m_NodeMarkedToDelete = removedNode;
 
-  // update observers
-  this->UpdateObservers();
+  this->RemoveNodeFromIndex(removedNode);
 
-  // search image that belongs to the property
-  if (m_LevelWindowProperty.IsNull())
+  // if the node of the current property is deleted, change our behavior to AutoTopMost,
+  // if AutoTopMost is true change level window to topmost node
+  if (m_LevelWindowProperty.IsNull() || m_AutoTopMost ||
+      removedNode->GetProperty("levelwindow") == m_LevelWindowProperty.GetPointer())
   {
     this->SetAutoTopMostImage(true, removedNode);
   }
-  else
-  {
-    NodePredicateProperty::Pointer property = NodePredicateProperty::New("levelwindow", m_LevelWindowProperty);
-    DataNode *n = m_DataStorage->GetNode(property);
-    if (n == nullptr || m_AutoTopMost) // if node was deleted, change our behavior to AutoTopMost, if AutoTopMost is
-                                       // true change level window to topmost node
-    {
-      this->SetAutoTopMostImage(true, removedNode);
-    }
-  }
 
   // reset variable
   m_NodeMarkedToDelete = nullptr;
-
-  // check if everything is still ok
-  if ((m_ObserverToVisibleProperty.size() != m_ObserverToLayerProperty.size()) ||
-      (m_ObserverToLayerProperty.size() != (relevantNodes->size() - 1)))
-  {
-    mitkThrow() << "Wrong number of observers in Level Window Manager!";
-  }
 }
 
 void mitk::LevelWindowManager::OnPropertyModified(const itk::EventObject &)
@@ -542,7 +486,7 @@ mitk::Image *mitk::LevelWindowManager::GetCurrentImage()
 
 int mitk::LevelWindowManager::GetNumberOfObservers()
 {
-  return m_ObserverToVisibleProperty.size();
+  return m_IndexedNodes.size();
 }
 
 mitk::DataStorage::SetOfObjects::ConstPointer mitk::LevelWindowManager::GetRelevantNodes()
@@ -577,132 +521,211 @@ mitk::DataStorage::SetOfObjects::ConstPointer mitk::LevelWindowManager::GetRelev
   return relevantNodes;
 }
 
-void mitk::LevelWindowManager::UpdateObservers()
+void mitk::LevelWindowManager::UpdateIndex()
 {
-  this->ClearPropObserverLists();  // remove old observers
-  this->CreatePropObserverLists(); // create new observer lists
+  if (m_DataStorage.IsNull()) // check if data storage is set
+  {
+    mitkThrow() << "DataStorage not set";
+  }
+
+  std::set<const DataNode *> relevantNodes;
+  DataStorage::SetOfObjects::ConstPointer all = this->GetRelevantNodes();
+  for (DataStorage::SetOfObjects::ConstIterator it = all->Begin(); it != all->End(); ++it)
+  {
+    if ((it->Value().IsNull()) || (it->Value() == m_NodeMarkedToDelete))
+    {
+      continue;
+    }
+
+    relevantNodes.insert(it->Value());
+    this->IndexNode(it->Value());
+  }
+
+  // remove nodes which are no longer relevant, e.g. because they became binary
+  for (auto it = m_IndexedNodes.begin(); it != m_IndexedNodes.end();)
+  {
+    const DataNode *node = it->first;
+    ++it;
+    if (0 == relevantNodes.count(node))
+    {
+      this->RemoveNodeFromIndex(node);
+    }
+  }
 }
 
-void mitk::LevelWindowManager::ClearPropObserverLists()
+void mitk::LevelWindowManager::ClearIndex()
 {
-  for (auto iter = m_ObserverToVisibleProperty.begin(); iter != m_ObserverToVisibleProperty.end(); ++iter)
+  while (!m_IndexedNodes.empty())
   {
-    (*iter).second->RemoveObserver((*iter).first.first);
-    (*iter).second = nullptr;
+    this->RemoveNodeFromIndex(m_IndexedNodes.begin()->first);
   }
-  m_ObserverToVisibleProperty.clear();
+}
 
-  for (auto iter = m_ObserverToLayerProperty.begin(); iter != m_ObserverToLayerProperty.end(); ++iter)
+void mitk::LevelWindowManager::IndexNode(DataNode *node)
+{
+  IndexedNode &indexedNode = m_IndexedNodes[node];
+  if (indexedNode.Node.IsNull())
   {
-    (*iter).second->RemoveObserver((*iter).first.first);
-    (*iter).second = nullptr;
+    indexedNode.Node = node;
+    indexedNode.Sequence = m_NextSequence++;
   }
-  m_ObserverToLayerProperty.clear();
 
-  for (auto iter = m_ObserverToRenderingModeProperty.begin(); iter != m_ObserverToRenderingModeProperty.end(); ++iter)
+  if (nullptr == node->GetProperty("imageForLevelWindow"))
   {
-    (*iter).second->RemoveObserver((*iter).first.first);
-    (*iter).second = nullptr;
+    node->SetBoolProperty("imageForLevelWindow", false);
   }
-  m_ObserverToRenderingModeProperty.clear();
+  if (nullptr == node->GetProperty("selected"))
+  {
+    node->SetBoolProperty("selected", false);
+  }
+
+  // properties which did not exist when the node was indexed are observed as soon as they exist
+  this->ObserveProperty(indexedNode, "visible", &LevelWindowManager::OnIndexedPropertyModified);
+  this->ObserveProperty(indexedNode, "layer", &LevelWindowManager::OnIndexedPropertyModified);
+  this->ObserveProperty(indexedNode, "Image Rendering.Mode", &LevelWindowManager::OnIndexedPropertyModified);
+  this->ObserveProperty(indexedNode, "imageForLevelWindow", &LevelWindowManager::OnIndexedPropertyModified);
+  this->ObserveProperty(indexedNode, "selected", &LevelWindowManager::OnSelectedPropertyModified);
+  this->ObserveProperty(
+    indexedNode, "Image.Displayed Component", &LevelWindowManager::OnDisplayedComponentPropertyModified);
+
+  this->UpdateIndexedNode(indexedNode);
+}
 
-  for (auto iter = m_ObserverToDisplayedComponentProperty.begin(); iter != m_ObserverToDisplayedComponentProperty.end(); ++iter)
+void mitk::LevelWindowManager::RemoveNodeFromIndex(const DataNode *node)
+{
+  auto it = m_IndexedNodes.find(node);
+  if (it == m_IndexedNodes.end())
   {
-    (*iter).second->RemoveObserver((*iter).first.first);
-    (*iter).second = nullptr;
+    return;
   }
-  m_ObserverToDisplayedComponentProperty.clear();
 
-  for (auto iter = m_ObserverToLevelWindowImageProperty.begin(); iter != m_ObserverToLevelWindowImageProperty.end(); ++iter)
+  for (const auto &observer : it->second.Observers)
   {
-    (*iter).second->RemoveObserver((*iter).first.first);
-    (*iter).second = nullptr;
+    this->RemovePropertyObserver(node, observer.second);
   }
-  m_ObserverToLevelWindowImageProperty.clear();
 
-  for (auto iter = m_ObserverToSelectedProperty.begin(); iter != m_ObserverToSelectedProperty.end(); ++iter)
+  if (it->second.Visible)
   {
-    (*iter).second->RemoveObserver((*iter).first.first);
-    (*iter).second = nullptr;
+    m_VisibleNodesByLayer.erase(LayerKey(it->second.Layer, it->second.Sequence));
   }
-  m_ObserverToSelectedProperty.clear();
+  m_NodesForLevelWindow.erase(node);
+  m_IndexedNodes.erase(it);
 }
 
-void mitk::LevelWindowManager::CreatePropObserverLists()
+void mitk::LevelWindowManager::ObserveProperty(IndexedNode &indexedNode,
+                                               const std::string &propertyKey,
+                                               void (LevelWindowManager::*callback)(itk::Object *,
+                                                                                    const itk::EventObject &))
 {
-  if (m_DataStorage.IsNull()) // check if data storage is set
-  {
-    mitkThrow() << "DataStorage not set";
-  }
+  BaseProperty *property = indexedNode.Node->GetProperty(propertyKey.c_str());
 
-  /* add observers for all relevant nodes */
-  DataStorage::SetOfObjects::ConstPointer all = this->GetRelevantNodes();
-  for (DataStorage::SetOfObjects::ConstIterator it = all->Begin(); it != all->End(); ++it)
+  auto observer = indexedNode.Observers.find(propertyKey);
+  if (observer != indexedNode.Observers.end())
   {
-    if ((it->Value().IsNull()) || (it->Value() == m_NodeMarkedToDelete))
+    if (observer->second.first == property)
     {
-      continue;
+      return;
     }
 
-    /* register listener for changes in visible property */
-    itk::ReceptorMemberCommand<LevelWindowManager>::Pointer command =
-      itk::ReceptorMemberCommand<LevelWindowManager>::New();
-    command->SetCallbackFunction(this, &LevelWindowManager::Update);
-    unsigned long visIdx = it->Value()->GetProperty("visible")->AddObserver(itk::ModifiedEvent(), command);
-    m_ObserverToVisibleProperty[PropDataPair(visIdx, it->Value())] = it->Value()->GetProperty("visible");
-
-    /* register listener for changes in layer property */
-    itk::ReceptorMemberCommand<LevelWindowManager>::Pointer command2 =
-      itk::ReceptorMemberCommand<LevelWindowManager>::New();
-    command2->SetCallbackFunction(this, &LevelWindowManager::Update);
-    unsigned long layerIdx = it->Value()->GetProperty("layer")->AddObserver(itk::ModifiedEvent(), command2);
-    m_ObserverToLayerProperty[PropDataPair(layerIdx, it->Value())] = it->Value()->GetProperty("layer");
-
-    /* register listener for changes in layer property */
-    itk::ReceptorMemberCommand<LevelWindowManager>::Pointer command3 =
-      itk::ReceptorMemberCommand<LevelWindowManager>::New();
-    command3->SetCallbackFunction(this, &LevelWindowManager::Update);
-    BaseProperty::Pointer imageRenderingMode = it->Value()->GetProperty("Image Rendering.Mode");
-    if (imageRenderingMode.IsNotNull())
-    {
-      unsigned long rendIdx = imageRenderingMode->AddObserver(itk::ModifiedEvent(), command3);
-      m_ObserverToRenderingModeProperty[PropDataPair(rendIdx, it->Value())] = imageRenderingMode.GetPointer();
-    }
+    // the property was replaced
+    this->RemovePropertyObserver(indexedNode.Node, observer->second);
+    indexedNode.Observers.erase(observer);
+  }
 
-    itk::ReceptorMemberCommand<LevelWindowManager>::Pointer command4 =
-      itk::ReceptorMemberCommand<LevelWindowManager>::New();
-    command4->SetCallbackFunction(this, &LevelWindowManager::RecalculateLevelWindowForSelectedComponent);
-    BaseProperty::Pointer displayedImageComponent = it->Value()->GetProperty("Image.Displayed Component");
-    if (displayedImageComponent.IsNotNull())
-    {
-      unsigned long dispIdx = displayedImageComponent->AddObserver(itk::ModifiedEvent(), command4);
-      m_ObserverToDisplayedComponentProperty[PropDataPair(dispIdx, it->Value())] = displayedImageComponent.GetPointer();
-    }
+  if (nullptr == property)
+  {
+    return;
+  }
 
-    itk::ReceptorMemberCommand<LevelWindowManager>::Pointer command5 =
-      itk::ReceptorMemberCommand<LevelWindowManager>::New();
-    command5->SetCallbackFunction(this, &LevelWindowManager::Update);
-    BaseProperty::Pointer imgForLvlWin = it->Value()->GetProperty("imageForLevelWindow");
-    if (imgForLvlWin.IsNull())
+  itk::MemberCommand<LevelWindowManager>::Pointer command = itk::MemberCommand<LevelWindowManager>::New();
+  command->SetCallbackFunction(this, callback);
+  unsigned long tag = property->AddObserver(itk::ModifiedEvent(), command);
+  indexedNode.Observers[propertyKey] = std::make_pair(BaseProperty::Pointer(property), tag);
+  m_NodesByObservedProperty.emplace(property, indexedNode.Node.GetPointer());
+}
+
+void mitk::LevelWindowManager::RemovePropertyObserver(const DataNode *node,
+                                                      const std::pair<BaseProperty::Pointer, unsigned long> &observer)
+{
+  observer.first->RemoveObserver(observer.second);
+
+  auto range = m_NodesByObservedProperty.equal_range(observer.first.GetPointer());
+  for (auto it = range.first; it != range.second; ++it)
+  {
+    if (it->second == node)
     {
-      it->Value()->SetBoolProperty("imageForLevelWindow", false);
-      imgForLvlWin = it->Value()->GetProperty("imageForLevelWindow");
+      m_NodesByObservedProperty.erase(it);
+      break;
     }
-    unsigned long lvlWinIdx = imgForLvlWin->AddObserver(itk::ModifiedEvent(), command5);
-    m_ObserverToLevelWindowImageProperty[PropDataPair(lvlWinIdx, it->Value())] = it->Value()->GetProperty("imageForLevelWindow");
-
-    itk::ReceptorMemberCommand<LevelWindowManager>::Pointer command6 =
-      itk::ReceptorMemberCommand<LevelWindowManager>::New();
-    command6->SetCallbackFunction(this, &LevelWindowManager::UpdateSelected);
-    BaseProperty::Pointer selectedDataNode = it->Value()->GetProperty("selected");
-    if (selectedDataNode.IsNull())
+  }
+}
+
+void mitk::LevelWindowManager::UpdateIndexedNode(IndexedNode &indexedNode)
+{
+  if (indexedNode.Visible)
+  {
+    m_VisibleNodesByLayer.erase(LayerKey(indexedNode.Layer, indexedNode.Sequence));
+  }
+
+  DataNode *node = indexedNode.Node;
+  indexedNode.Layer = -1;
+  node->GetIntProperty("layer", indexedNode.Layer);
+  indexedNode.Visible = node->IsVisible(nullptr);
+  indexedNode.Ignored = this->IgnoreNode(node);
+  indexedNode.ImageForLevelWindow = false;
+  node->GetBoolProperty("imageForLevelWindow", indexedNode.ImageForLevelWindow);
+
+  if (indexedNode.Visible)
+  {
+    m_VisibleNodesByLayer[LayerKey(indexedNode.Layer, indexedNode.Sequence)] = node;
+  }
+
+  if (indexedNode.ImageForLevelWindow)
+  {
+    m_NodesForLevelWindow.insert(node);
+  }
+  else
+  {
+    m_NodesForLevelWindow.erase(node);
+  }
+}
+
+void mitk::LevelWindowManager::OnIndexedPropertyModified(itk::Object *caller, const itk::EventObject &e)
+{
+  // the index is updated even for changes made by this object
+  auto range = m_NodesByObservedProperty.equal_range(caller);
+  for (auto it = range.first; it != range.second; ++it)
+  {
+    this->UpdateIndexedNode(m_IndexedNodes.at(it->second));
+  }
+
+  this->Update(e);
+}
+
+void mitk::LevelWindowManager::OnSelectedPropertyModified(itk::Object *, const itk::EventObject &e)
+{
+  this->UpdateSelected(e);
+}
+
+void mitk::LevelWindowManager::OnDisplayedComponentPropertyModified(itk::Object *, const itk::EventObject &e)
+{
+  this->RecalculateLevelWindowForSelectedComponent(e);
+}
+
+mitk::DataNode *mitk::LevelWindowManager::GetTopMostNode(bool skipIgnoredNodes, const DataNode *excludedNode) const
+{
+  for (auto it = m_VisibleNodesByLayer.rbegin(); it != m_VisibleNodesByLayer.rend(); ++it)
+  {
+    const IndexedNode &indexedNode = m_IndexedNodes.at(it->second);
+    if (it->second == excludedNode || (skipIgnoredNodes && indexedNode.Ignored))
     {
-      it->Value()->SetBoolProperty("selected", false);
-      selectedDataNode = it->Value()->GetProperty("selected");
+      continue;
     }
-    unsigned long selectedIdx = selectedDataNode->AddObserver(itk::ModifiedEvent(), command5);
-    m_ObserverToSelectedProperty[PropDataPair(selectedIdx, it->Value())] = it->Value()->GetProperty("selected");
+
+    return indexedNode.Node;
   }
+
+  return nullptr;
 }
 
 bool mitk::LevelWindowManager::IgnoreNode(const DataNode* dataNode)
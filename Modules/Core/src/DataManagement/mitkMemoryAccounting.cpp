@@ -0,0 +1,375 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkMemoryAccounting.h"
+
+#include "mitkDataStorage.h"
+#include "mitkImage.h"
+#include "mitkLogMacros.h"
+#include "mitkSurface.h"
+
+#include <vtkPolyData.h>
+
+#include <algorithm>
+#include <vector>
+
+const std::string mitk::MemoryAccounting::ResliceCacheType = "ResliceCache";
+const std::string mitk::MemoryAccounting::SurfaceLevelOfDetailType = "SurfaceLevelOfDetail";
+const std::string mitk::MemoryAccounting::StatisticsHistogramType = "StatisticsHistogram";
+const std::string mitk::MemoryAccounting::ImageDataType = "Image";
+const std::string mitk::MemoryAccounting::SurfaceDataType = "Surface";
+
+mitk::MemoryAccounting::Cache::~Cache()
+{
+}
+
+mitk::MemoryAccounting &mitk::MemoryAccounting::GetInstance()
+{
+  // never destroyed, caches may unregister during static destruction
+  static auto *instance = new MemoryAccounting;
+  return *instance;
+}
+
+mitk::MemoryAccounting::MemoryAccounting()
+  : m_UseCounter(0), m_Budget(0), m_HibernateInvisibleImages(false), m_IdleHibernationDelay(0)
+{
+}
+
+mitk::MemoryAccounting::~MemoryAccounting()
+{
+  this->SetDataStorage(nullptr);
+}
+
+void mitk::MemoryAccounting::RegisterCache(Cache *cache, const std::string &type, const BaseData *owner)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  auto it = m_Caches.find(cache);
+  if (it != m_Caches.end())
+  {
+    it->second.Type = type;
+    it->second.Owner = owner;
+    it->second.LastUse = ++m_UseCounter;
+  }
+  else
+  {
+    m_Caches.emplace(cache, CacheEntry{type, owner, ++m_UseCounter});
+  }
+}
+
+void mitk::MemoryAccounting::UnregisterCache(Cache *cache)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Caches.erase(cache);
+}
+
+void mitk::MemoryAccounting::TouchCache(Cache *cache)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  auto it = m_Caches.find(cache);
+  if (it != m_Caches.end())
+    it->second.LastUse = ++m_UseCounter;
+}
+
+std::size_t mitk::MemoryAccounting::GetDataSize(const BaseData *data)
+{
+  std::size_t size = 0;
+
+  if (auto image = dynamic_cast<const Image *>(data))
+  {
+    if (!image->IsInitialized())
+      return 0;
+
+    const std::size_t numberOfVoxels = static_cast<std::size_t>(image->GetDimension(0)) * image->GetDimension(1) *
+                                       image->GetDimension(2);
+    for (unsigned int n = 0; n < image->GetNumberOfChannels(); ++n)
+    {
+      const std::size_t volumeSize = numberOfVoxels * image->GetPixelType(n).GetSize();
+      for (unsigned int t = 0; t < image->GetDimension(3); ++t)
+      {
+        if (image->IsVolumeSet(t, n))
+          size += volumeSize;
+      }
+    }
+
+    if (auto store = dynamic_cast<const ImageHibernationStore *>(image->GetVolumeProvider()))
+      size += store->GetMemorySize();
+  }
+  else if (auto surface = dynamic_cast<const Surface *>(data))
+  {
+    for (unsigned int t = 0; t < surface->GetSizeOfPolyDataSeries(); ++t)
+    {
+      if (vtkPolyData *polyData = surface->GetVtkPolyData(t))
+        size += static_cast<std::size_t>(polyData->GetActualMemorySize()) * 1024;
+    }
+  }
+
+  return size;
+}
+
+mitk::MemoryAccounting::Usage mitk::MemoryAccounting::GetUsage(const BaseData *data) const
+{
+  Usage usage;
+  if (data == nullptr)
+    return usage;
+
+  usage.DataSize = GetDataSize(data);
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  for (const auto &cache : m_Caches)
+  {
+    if (cache.second.Owner == data)
+      usage.CacheSize += cache.first->GetCacheSize();
+  }
+  return usage;
+}
+
+mitk::MemoryAccounting::Usage mitk::MemoryAccounting::GetUsage(const DataNode *node) const
+{
+  return node != nullptr ? this->GetUsage(node->GetData()) : Usage();
+}
+
+std::map<std::string, std::size_t> mitk::MemoryAccounting::GetUsageByType(const DataStorage *storage) const
+{
+  std::map<std::string, std::size_t> usage;
+
+  if (storage != nullptr)
+  {
+    auto nodes = storage->GetAll();
+    for (const auto &node : *nodes)
+    {
+      const BaseData *data = node->GetData();
+      if (dynamic_cast<const Image *>(data) != nullptr)
+        usage[ImageDataType] += GetDataSize(data);
+      else if (dynamic_cast<const Surface *>(data) != nullptr)
+        usage[SurfaceDataType] += GetDataSize(data);
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  for (const auto &cache : m_Caches)
+    usage[cache.second.Type] += cache.first->GetCacheSize();
+
+  return usage;
+}
+
+std::size_t mitk::MemoryAccounting::GetTotalUsage(const DataStorage *storage) const
+{
+  std::size_t total = 0;
+  for (const auto &usage : this->GetUsageByType(storage))
+    total += usage.second;
+  return total;
+}
+
+void mitk::MemoryAccounting::SetBudget(std::size_t budget)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Budget = budget;
+}
+
+std::size_t mitk::MemoryAccounting::GetBudget() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Budget;
+}
+
+void mitk::MemoryAccounting::SetHibernateInvisibleImages(bool hibernate)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_HibernateInvisibleImages = hibernate;
+}
+
+bool mitk::MemoryAccounting::GetHibernateInvisibleImages() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_HibernateInvisibleImages;
+}
+
+void mitk::MemoryAccounting::SetBudgetExceededCallback(const BudgetExceededCallback &callback)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_BudgetExceededCallback = callback;
+}
+
+void mitk::MemoryAccounting::SetHibernationStoreFactory(const HibernationStoreFactory &factory)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_HibernationStoreFactory = factory;
+}
+
+mitk::ImageHibernationStore::Pointer mitk::MemoryAccounting::CreateHibernationStore() const
+{
+  HibernationStoreFactory factory;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    factory = m_HibernationStoreFactory;
+  }
+
+  // nullptr lets Image::Hibernate use temporary files
+  return factory ? factory() : nullptr;
+}
+
+void mitk::MemoryAccounting::SetIdleHibernationDelay(std::chrono::seconds delay)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_IdleHibernationDelay = delay;
+}
+
+std::chrono::seconds mitk::MemoryAccounting::GetIdleHibernationDelay() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_IdleHibernationDelay;
+}
+
+std::size_t mitk::MemoryAccounting::HibernateIdleImages()
+{
+  const auto delay = this->GetIdleHibernationDelay();
+  auto storage = m_DataStorage.Lock();
+  if (delay.count() <= 0 || storage.IsNull())
+  {
+    m_IdleImages.clear();
+    return 0;
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  std::map<const BaseData *, IdleImage> idleImages;
+  std::size_t released = 0;
+
+  auto nodes = storage->GetAll();
+  for (const auto &node : *nodes)
+  {
+    auto image = dynamic_cast<Image *>(node->GetData());
+    if (image == nullptr || node->IsVisible(nullptr))
+      continue;
+
+    const unsigned long mTime = image->GetMTime();
+    const std::size_t dataSize = GetDataSize(image);
+
+    // an image counts as used if it was modified or if volumes were restored from hibernation
+    auto it = m_IdleImages.find(image);
+    IdleImage idle = it != m_IdleImages.end() ? it->second : IdleImage{now, mTime, dataSize};
+    if (idle.MTime != mTime || dataSize > idle.DataSize)
+      idle = IdleImage{now, mTime, dataSize};
+
+    // only the memory of the store is left if the image is hibernated already
+    auto store = dynamic_cast<const ImageHibernationStore *>(image->GetVolumeProvider());
+    const bool isHibernated = store != nullptr && dataSize <= store->GetMemorySize();
+
+    if (!isHibernated && dataSize > 0 && now - idle.Since >= delay)
+    {
+      released += image->Hibernate(this->CreateHibernationStore());
+      idle = IdleImage{now, image->GetMTime(), GetDataSize(image)};
+    }
+    idle.DataSize = std::min(idle.DataSize, dataSize);
+
+    idleImages.emplace(image, idle);
+  }
+
+  // forgets images that were removed or became visible
+  m_IdleImages.swap(idleImages);
+  return released;
+}
+
+std::size_t mitk::MemoryAccounting::EnforceBudget(const DataStorage *storage)
+{
+  std::size_t budget;
+  bool hibernate;
+  BudgetExceededCallback callback;
+  std::vector<std::pair<unsigned long, Cache *>> caches;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    budget = m_Budget;
+    hibernate = m_HibernateInvisibleImages;
+    callback = m_BudgetExceededCallback;
+    for (const auto &cache : m_Caches)
+      caches.emplace_back(cache.second.LastUse, cache.first);
+  }
+
+  if (budget == 0)
+    return 0;
+
+  std::size_t usage = this->GetTotalUsage(storage);
+  std::size_t released = 0;
+
+  // least recently used caches first
+  std::sort(caches.begin(), caches.end());
+  for (const auto &cache : caches)
+  {
+    if (usage <= budget)
+      break;
+
+    const std::size_t size = cache.second->GetCacheSize();
+    if (size == 0)
+      continue;
+
+    cache.second->ReleaseCache();
+    const std::size_t freed = size - std::min(size, cache.second->GetCacheSize());
+    usage -= std::min(usage, freed);
+    released += freed;
+  }
+
+  if (usage > budget && hibernate && storage != nullptr)
+  {
+    // largest images first
+    std::vector<std::pair<std::size_t, Image *>> images;
+    auto nodes = storage->GetAll();
+    for (const auto &node : *nodes)
+    {
+      auto image = dynamic_cast<Image *>(node->GetData());
+      if (image != nullptr && !node->IsVisible(nullptr))
+        images.emplace_back(GetDataSize(image), image);
+    }
+    std::sort(images.rbegin(), images.rend());
+
+    for (const auto &image : images)
+    {
+      if (usage <= budget)
+        break;
+
+      const std::size_t freed = image.second->Hibernate(this->CreateHibernationStore());
+      usage -= std::min(usage, freed);
+      released += freed;
+    }
+  }
+
+  if (usage > budget)
+  {
+    MITK_WARN << "Memory budget exceeded: " << usage / (1024 * 1024) << " MiB in use, budget is "
+              << budget / (1024 * 1024) << " MiB";
+    if (callback)
+      callback(usage, budget);
+  }
+
+  return released;
+}
+
+void mitk::MemoryAccounting::SetDataStorage(DataStorage *storage)
+{
+  if (auto oldStorage = m_DataStorage.Lock())
+  {
+    oldStorage->AddNodeEvent.RemoveListener(
+      MessageDelegate1<MemoryAccounting, const DataNode *>(this, &MemoryAccounting::OnNodeAdded));
+  }
+
+  m_DataStorage = storage;
+
+  if (storage != nullptr)
+  {
+    storage->AddNodeEvent.AddListener(
+      MessageDelegate1<MemoryAccounting, const DataNode *>(this, &MemoryAccounting::OnNodeAdded));
+  }
+}
+
+void mitk::MemoryAccounting::OnNodeAdded(const DataNode *)
+{
+  if (auto storage = m_DataStorage.Lock())
+    this->EnforceBudget(storage);
+}
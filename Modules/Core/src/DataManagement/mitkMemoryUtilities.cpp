@@ -13,15 +13,24 @@ found in the LICENSE file.
 #include "mitkMemoryUtilities.h"
 
 #include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <vector>
 #if _MSC_VER
 #include <windows.h>
 #include <psapi.h>
 #elif defined(__APPLE__)
+#include <fcntl.h>
 #include <mach/mach_host.h>
 #include <mach/mach_init.h>
 #include <mach/task.h>
+#include <sys/mman.h>
 #include <sys/sysctl.h>
+#include <unistd.h>
 #else
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/sysinfo.h>
 #include <unistd.h>
 #endif
@@ -91,6 +100,288 @@ size_t mitk::MemoryUtilities::GetTotalSizeOfPhysicalRam()
 #endif
 }
 
+void *mitk::MemoryUtilities::AllocateMappedMemory(size_t size, bool noThrow)
+{
+  void *memory = nullptr;
+
+  if (size != 0)
+  {
+    const char *mappedMemoryDir = std::getenv("MITK_MAPPED_MEMORY_DIR");
+#if _MSC_VER
+    std::string dir;
+    if (mappedMemoryDir != nullptr)
+    {
+      dir = mappedMemoryDir;
+    }
+    else
+    {
+      char tempPath[MAX_PATH + 1];
+      if (GetTempPathA(MAX_PATH + 1, tempPath) != 0)
+        dir = tempPath;
+    }
+
+    char fileName[MAX_PATH + 1];
+    if (!dir.empty() && GetTempFileNameA(dir.c_str(), "mitk", 0, fileName) != 0)
+    {
+      // the file is deleted by the system as soon as the mapping is released
+      HANDLE file = CreateFileA(fileName,
+                                GENERIC_READ | GENERIC_WRITE,
+                                0,
+                                nullptr,
+                                CREATE_ALWAYS,
+                                FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE,
+                                nullptr);
+      if (file != INVALID_HANDLE_VALUE)
+      {
+        const unsigned long long largeSize = size;
+        HANDLE mapping = CreateFileMappingA(file,
+                                            nullptr,
+                                            PAGE_READWRITE,
+                                            static_cast<DWORD>(largeSize >> 32),
+                                            static_cast<DWORD>(largeSize & 0xFFFFFFFFull),
+                                            nullptr);
+        if (mapping != nullptr)
+        {
+          memory = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+          // the view keeps the mapping and the file alive
+          CloseHandle(mapping);
+        }
+        CloseHandle(file);
+      }
+    }
+#else
+    std::string pattern = mappedMemoryDir != nullptr ? mappedMemoryDir : "";
+    if (pattern.empty())
+    {
+      const char *tmpDir = std::getenv("TMPDIR");
+      pattern = tmpDir != nullptr ? tmpDir : "/tmp";
+    }
+    pattern += "/mitk-mapped-XXXXXX";
+
+    std::vector<char> fileName(pattern.begin(), pattern.end());
+    fileName.push_back('\0');
+
+    int fd = mkstemp(fileName.data());
+    if (fd != -1)
+    {
+      // unlink immediately: the file vanishes once the mapping is released
+      unlink(fileName.data());
+      if (ftruncate(fd, static_cast<off_t>(size)) == 0)
+      {
+        memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (memory == MAP_FAILED)
+          memory = nullptr;
+      }
+      close(fd);
+    }
+#endif
+  }
+
+  if ((memory == nullptr) && (noThrow == false))
+  {
+    throw itk::MemoryAllocationError(__FILE__, __LINE__, "Failed to allocate mapped memory.", ITK_LOCATION);
+  }
+  return memory;
+}
+
+void mitk::MemoryUtilities::DeleteMappedMemory(void *memory, size_t size)
+{
+  if (memory == nullptr)
+    return;
+#if _MSC_VER
+  (void)size;
+  UnmapViewOfFile(memory);
+#else
+  munmap(memory, size);
+#endif
+}
+
+namespace
+{
+  // Pooled blocks range from 256 bytes to 16 MiB. Each power of two interval is split into four
+  // size classes, so rounding up a request wastes at most a quarter of the block.
+  const unsigned int MinimumPooledBlockSizeExponent = 8;
+  const unsigned int MaximumPooledBlockSizeExponent = 24;
+  const unsigned int NumberOfPoolSizeClasses = 1 + 4 * (MaximumPooledBlockSizeExponent - MinimumPooledBlockSizeExponent);
+
+  struct ImageMemoryPool
+  {
+    ImageMemoryPool() : CacheLimit(128 * 1024 * 1024), Statistics() {}
+
+    std::mutex Mutex;
+    std::vector<unsigned char *> FreeBlocks[NumberOfPoolSizeClasses];
+    size_t CacheLimit;
+    mitk::MemoryUtilities::PoolStatistics Statistics;
+  };
+
+  ImageMemoryPool &GetImageMemoryPool()
+  {
+    // Never destroyed on purpose: images may still be released during static destruction.
+    static ImageMemoryPool *pool = new ImageMemoryPool;
+    return *pool;
+  }
+
+  /**
+   * Returns the size class of a block of the given size, or -1 if blocks of this size are not cached.
+   * The size of the block that is actually allocated is returned in blockSize.
+   */
+  int GetPoolSizeClass(size_t size, size_t &blockSize)
+  {
+    const size_t minimumBlockSize = static_cast<size_t>(1) << MinimumPooledBlockSizeExponent;
+    if (size <= minimumBlockSize)
+    {
+      blockSize = minimumBlockSize;
+      return 0;
+    }
+    if (size > (static_cast<size_t>(1) << MaximumPooledBlockSizeExponent))
+    {
+      blockSize = size;
+      return -1;
+    }
+
+    unsigned int exponent = MinimumPooledBlockSizeExponent + 1;
+    while ((static_cast<size_t>(1) << exponent) < size)
+      ++exponent;
+
+    // size lies in (2^(exponent-1), 2^exponent], which is divided into four steps
+    const size_t lowerBound = static_cast<size_t>(1) << (exponent - 1);
+    const size_t step = static_cast<size_t>(1) << (exponent - 3);
+    const size_t numberOfSteps = (size - lowerBound + step - 1) / step;
+    blockSize = lowerBound + numberOfSteps * step;
+
+    return static_cast<int>(1 + 4 * (exponent - MinimumPooledBlockSizeExponent - 1) + (numberOfSteps - 1));
+  }
+}
+
+void *mitk::MemoryUtilities::AllocatePooledMemory(size_t size, bool noThrow)
+{
+  ImageMemoryPool &pool = GetImageMemoryPool();
+  size_t blockSize = 0;
+  const int sizeClass = GetPoolSizeClass(size, blockSize);
+
+  unsigned char *block = nullptr;
+  bool reused = false;
+
+  if (sizeClass >= 0)
+  {
+    std::lock_guard<std::mutex> lock(pool.Mutex);
+    std::vector<unsigned char *> &freeBlocks = pool.FreeBlocks[sizeClass];
+    if (!freeBlocks.empty())
+    {
+      block = freeBlocks.back();
+      freeBlocks.pop_back();
+      pool.Statistics.BytesCached -= blockSize;
+      reused = true;
+    }
+  }
+
+  if (block == nullptr)
+  {
+    block = AllocateElements<unsigned char>(blockSize, true);
+    if (block == nullptr)
+    {
+      // the cached blocks might be what keeps this allocation from succeeding
+      ReleasePooledMemory();
+      block = AllocateElements<unsigned char>(blockSize, noThrow);
+      if (block == nullptr)
+        return nullptr;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(pool.Mutex);
+  PoolStatistics &statistics = pool.Statistics;
+  ++statistics.NumberOfAllocations;
+  if (reused)
+    ++statistics.NumberOfReuses;
+  statistics.BytesInUse += blockSize;
+  if (statistics.BytesInUse > statistics.HighWaterMark)
+    statistics.HighWaterMark = statistics.BytesInUse;
+
+  return block;
+}
+
+void mitk::MemoryUtilities::DeletePooledMemory(void *memory, size_t size)
+{
+  if (memory == nullptr)
+    return;
+
+  ImageMemoryPool &pool = GetImageMemoryPool();
+  size_t blockSize = 0;
+  const int sizeClass = GetPoolSizeClass(size, blockSize);
+
+  {
+    std::lock_guard<std::mutex> lock(pool.Mutex);
+    pool.Statistics.BytesInUse -= blockSize;
+
+    if (sizeClass >= 0 && pool.Statistics.BytesCached + blockSize <= pool.CacheLimit)
+    {
+      pool.FreeBlocks[sizeClass].push_back(static_cast<unsigned char *>(memory));
+      pool.Statistics.BytesCached += blockSize;
+      return;
+    }
+  }
+
+  DeleteElements(static_cast<unsigned char *>(memory));
+}
+
+void mitk::MemoryUtilities::ReleasePooledMemory()
+{
+  ImageMemoryPool &pool = GetImageMemoryPool();
+  std::vector<unsigned char *> blocks;
+  {
+    std::lock_guard<std::mutex> lock(pool.Mutex);
+    for (auto &freeBlocks : pool.FreeBlocks)
+    {
+      blocks.insert(blocks.end(), freeBlocks.begin(), freeBlocks.end());
+      freeBlocks.clear();
+    }
+    pool.Statistics.BytesCached = 0;
+  }
+
+  for (auto block : blocks)
+    DeleteElements(block);
+}
+
+void mitk::MemoryUtilities::SetPoolCacheLimit(size_t bytes)
+{
+  ImageMemoryPool &pool = GetImageMemoryPool();
+  {
+    std::lock_guard<std::mutex> lock(pool.Mutex);
+    pool.CacheLimit = bytes;
+    if (pool.Statistics.BytesCached <= bytes)
+      return;
+  }
+  ReleasePooledMemory();
+}
+
+size_t mitk::MemoryUtilities::GetPoolCacheLimit()
+{
+  ImageMemoryPool &pool = GetImageMemoryPool();
+  std::lock_guard<std::mutex> lock(pool.Mutex);
+  return pool.CacheLimit;
+}
+
+size_t mitk::MemoryUtilities::GetMaximumPooledBlockSize()
+{
+  return static_cast<size_t>(1) << MaximumPooledBlockSizeExponent;
+}
+
+mitk::MemoryUtilities::PoolStatistics mitk::MemoryUtilities::GetPoolStatistics()
+{
+  ImageMemoryPool &pool = GetImageMemoryPool();
+  std::lock_guard<std::mutex> lock(pool.Mutex);
+  return pool.Statistics;
+}
+
+void mitk::MemoryUtilities::ResetPoolStatistics()
+{
+  ImageMemoryPool &pool = GetImageMemoryPool();
+  std::lock_guard<std::mutex> lock(pool.Mutex);
+  pool.Statistics.HighWaterMark = pool.Statistics.BytesInUse;
+  pool.Statistics.NumberOfAllocations = 0;
+  pool.Statistics.NumberOfReuses = 0;
+}
+
 #ifndef _MSC_VER
 #ifndef __APPLE__
 int mitk::MemoryUtilities::ReadStatmFromProcFS(
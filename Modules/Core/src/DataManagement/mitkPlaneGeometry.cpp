@@ -875,9 +875,8 @@ namespace mitk
     // pt3d_units is a continuos index. We divided it with the Scale Factor (= spacing in x and y) to convert it from mm
     // to index units.
     //
-    pt3d_mm = GetIndexToWorldTransform()->TransformPoint(pt3d_units);
-    // now we convert the 3d index to a 3D world point in mm. We could have used IndexToWorld as well as
-    // GetITW->Transform...
+    Superclass::IndexToWorld(pt3d_units, pt3d_mm);
+    // now we convert the 3d index to a 3D world point in mm.
   }
 
   void PlaneGeometry::SetSizeInUnits(mitk::ScalarType width, mitk::ScalarType height)
@@ -912,7 +911,7 @@ namespace mitk
     Point3D pt3d_units;
     Superclass::WorldToIndex(pt3d_mm, pt3d_units);
     pt3d_units[2] = 0;
-    projectedPt3d_mm = GetIndexToWorldTransform()->TransformPoint(pt3d_units);
+    Superclass::IndexToWorld(pt3d_units, projectedPt3d_mm);
     return this->GetBoundingBox()->IsInside(pt3d_units);
   }
 
@@ -923,7 +922,7 @@ namespace mitk
     Vector3D vec3d_units;
     Superclass::WorldToIndex(vec3d_mm, vec3d_units);
     vec3d_units[2] = 0;
-    projectedVec3d_mm = GetIndexToWorldTransform()->TransformVector(vec3d_units);
+    Superclass::IndexToWorld(vec3d_units, projectedVec3d_mm);
     return true;
   }
 
@@ -14,8 +14,183 @@ found in the LICENSE file.
 #include "mitkInteractionConst.h"
 #include "mitkPointOperation.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <iomanip>
+#include <limits>
 #include <mitkNumericTypes.h>
+#include <unordered_map>
+
+namespace
+{
+  // Below this size a linear search is as fast as maintaining the spatial index
+  const std::size_t MinimumNumberOfPointsForSpatialIndex = 64;
+
+  // The grid is rebuilt with a new cell size once the number of points changed by this factor
+  const std::size_t SpatialIndexRebuildFactor = 4;
+}
+
+struct mitk::PointSet::SpatialIndex
+{
+  typedef std::int64_t CellKey;
+
+  const PointsContainer *Points = nullptr;
+  itk::ModifiedTimeType Time = 0;
+  std::size_t NumberOfPointsAtBuild = 0;
+  ScalarType CellSize = 1.0;
+  std::unordered_map<CellKey, std::vector<PointIdentifier>> Cells;
+
+  bool IsUpToDate(const PointsContainer *points) const
+  {
+    if (Points != points || Time != points->GetMTime())
+      return false;
+
+    const auto numberOfPoints = points->Size();
+    return numberOfPoints <= SpatialIndexRebuildFactor * NumberOfPointsAtBuild &&
+           numberOfPoints * SpatialIndexRebuildFactor >= NumberOfPointsAtBuild;
+  }
+
+  static CellKey GetCellKey(std::int64_t x, std::int64_t y, std::int64_t z)
+  {
+    // 21 bits per dimension; cells far apart may share a key, which only adds candidates
+    const std::int64_t mask = (1 << 21) - 1;
+    return ((x & mask) << 42) | ((y & mask) << 21) | (z & mask);
+  }
+
+  bool GetCell(ScalarType coordinate, std::int64_t &cell) const
+  {
+    const auto scaled = std::floor(coordinate / CellSize);
+
+    if (!(std::abs(scaled) < 1e15))
+      return false;
+
+    cell = static_cast<std::int64_t>(scaled);
+    return true;
+  }
+
+  CellKey GetCellKey(const PointType &point) const
+  {
+    std::int64_t cell[3] = {0, 0, 0};
+
+    for (int i = 0; i < 3; ++i)
+      this->GetCell(point[i], cell[i]);
+
+    return GetCellKey(cell[0], cell[1], cell[2]);
+  }
+
+  void Build(const PointsContainer *points)
+  {
+    Points = points;
+    Time = points->GetMTime();
+    NumberOfPointsAtBuild = points->Size();
+    Cells.clear();
+
+    // Choose the cell size so that there are a few points per cell on average
+    PointType minimum, maximum;
+    minimum.Fill(std::numeric_limits<ScalarType>::max());
+    maximum.Fill(std::numeric_limits<ScalarType>::lowest());
+
+    for (auto it = points->Begin(); it != points->End(); ++it)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        minimum[i] = std::min(minimum[i], it->Value()[i]);
+        maximum[i] = std::max(maximum[i], it->Value()[i]);
+      }
+    }
+
+    ScalarType volume = 1.0;
+    int dimension = 0;
+
+    for (int i = 0; i < 3; ++i)
+    {
+      const auto extent = maximum[i] - minimum[i];
+
+      if (extent > 1e-6)
+      {
+        volume *= extent;
+        ++dimension;
+      }
+    }
+
+    CellSize = 0 < dimension ? std::pow(4.0 * volume / NumberOfPointsAtBuild, 1.0 / dimension) : 1.0;
+
+    if (!(CellSize > 1e-6) || !std::isfinite(CellSize))
+      CellSize = 1.0;
+
+    for (auto it = points->Begin(); it != points->End(); ++it)
+      Cells[this->GetCellKey(it->Value())].push_back(it->Index());
+  }
+
+  void Insert(PointIdentifier id, const PointType &point)
+  {
+    Cells[this->GetCellKey(point)].push_back(id);
+  }
+
+  void Remove(PointIdentifier id, const PointType &point)
+  {
+    auto cell = Cells.find(this->GetCellKey(point));
+
+    if (cell == Cells.end())
+      return;
+
+    auto &ids = cell->second;
+    ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+
+    if (ids.empty())
+      Cells.erase(cell);
+  }
+
+  /**
+   * Calls function for all points in the cells overlapping the box around center.
+   * Returns false without calling function if more than maximumNumberOfCells would be visited.
+   */
+  template <typename TFunction>
+  bool ForEachCandidate(const PointType &center,
+                        const ScalarType halfExtents[3],
+                        std::size_t maximumNumberOfCells,
+                        TFunction function) const
+  {
+    std::int64_t lower[3], upper[3];
+    std::size_t numberOfCells = 1;
+
+    for (int i = 0; i < 3; ++i)
+    {
+      if (!this->GetCell(center[i] - halfExtents[i], lower[i]) || !this->GetCell(center[i] + halfExtents[i], upper[i]))
+        return false;
+
+      const auto numberOfCellsInDimension = static_cast<std::size_t>(upper[i] - lower[i] + 1);
+
+      if (numberOfCellsInDimension > maximumNumberOfCells)
+        return false;
+
+      numberOfCells *= numberOfCellsInDimension;
+
+      if (numberOfCells > maximumNumberOfCells)
+        return false;
+    }
+
+    for (auto x = lower[0]; x <= upper[0]; ++x)
+    {
+      for (auto y = lower[1]; y <= upper[1]; ++y)
+      {
+        for (auto z = lower[2]; z <= upper[2]; ++z)
+        {
+          auto cell = Cells.find(GetCellKey(x, y, z));
+
+          if (cell == Cells.end())
+            continue;
+
+          for (const auto id : cell->second)
+            function(id);
+        }
+      }
+    }
+
+    return true;
+  }
+};
 
 mitk::PointSet::PointSet() : m_CalculateBoundingBox(true)
 {
@@ -211,6 +386,31 @@ int mitk::PointSet::SearchPoint(Point3D point, ScalarType distance, int t) const
   ScalarType bestDist = distance;
   ScalarType dist, tmp;
 
+  const PointsContainer *points = m_PointSetSeries[t]->GetPoints();
+
+  if (points->Size() >= MinimumNumberOfPointsForSpatialIndex)
+  {
+    std::lock_guard<std::mutex> lock(m_SpatialIndexMutex);
+    const ScalarType radius = std::sqrt(distance);
+    const ScalarType halfExtents[3] = {radius, radius, radius};
+
+    // Same result as the linear search below: the closest point, the first one in the list if equally close
+    bool searched = this->GetSpatialIndex(t)->ForEachCandidate(
+      indexPoint, halfExtents, points->Size(), [&](PointIdentifier id) {
+        out = points->ElementAt(id);
+        ScalarType d = out.SquaredEuclideanDistanceTo(indexPoint);
+
+        if (d < bestDist || (d == bestDist && bestIndex > static_cast<int>(id)))
+        {
+          bestIndex = id;
+          bestDist = d;
+        }
+      });
+
+    if (searched)
+      return bestIndex;
+  }
+
   for (it = m_PointSetSeries[t]->GetPoints()->Begin(), i = 0; it != end; ++it, ++i)
   {
     bool ok = m_PointSetSeries[t]->GetPoints()->GetElementIfIndexExists(it->Index(), &out);
@@ -241,6 +441,124 @@ int mitk::PointSet::SearchPoint(Point3D point, ScalarType distance, int t) const
   return bestIndex;
 }
 
+int mitk::PointSet::SearchClosestPoint(const Point3D &point, ScalarType distance, int t) const
+{
+  if (t < 0 || t >= (int)m_PointSetSeries.size())
+  {
+    return -1;
+  }
+
+  const BaseGeometry *geometry = this->GetGeometry(t);
+  const PointsContainer *points = m_PointSetSeries[t]->GetPoints();
+
+  int bestIndex = -1;
+  ScalarType bestDist = distance * distance;
+  PointType worldPoint;
+
+  auto check = [&](PointIdentifier id, const PointType &indexPoint) {
+    geometry->IndexToWorld(indexPoint, worldPoint);
+    ScalarType d = worldPoint.SquaredEuclideanDistanceTo(point);
+
+    if (d < bestDist || (d == bestDist && bestIndex > static_cast<int>(id)))
+    {
+      bestIndex = id;
+      bestDist = d;
+    }
+  };
+
+  if (points->Size() >= MinimumNumberOfPointsForSpatialIndex)
+  {
+    // The box in index coordinates covering the search sphere is known for orthogonal geometries only
+    Vector3D axes[3];
+    bool isOrthogonal = true;
+
+    for (int i = 0; i < 3; ++i)
+    {
+      Vector3D unit;
+      unit.Fill(0);
+      unit[i] = 1;
+      geometry->IndexToWorld(unit, axes[i]);
+    }
+
+    for (int i = 0; i < 3 && isOrthogonal; ++i)
+    {
+      for (int j = i + 1; j < 3 && isOrthogonal; ++j)
+        isOrthogonal = std::abs(axes[i] * axes[j]) <= 1e-6 * axes[i].GetNorm() * axes[j].GetNorm();
+    }
+
+    if (isOrthogonal)
+    {
+      std::lock_guard<std::mutex> lock(m_SpatialIndexMutex);
+      PointType indexPoint;
+      geometry->WorldToIndex(point, indexPoint);
+
+      ScalarType halfExtents[3];
+
+      for (int i = 0; i < 3; ++i)
+        halfExtents[i] = distance / axes[i].GetNorm();
+
+      bool searched = this->GetSpatialIndex(t)->ForEachCandidate(
+        indexPoint, halfExtents, points->Size(), [&](PointIdentifier id) { check(id, points->ElementAt(id)); });
+
+      if (searched)
+        return bestIndex;
+
+      bestIndex = -1;
+      bestDist = distance * distance;
+    }
+  }
+
+  for (auto it = points->Begin(); it != points->End(); ++it)
+    check(it->Index(), it->Value());
+
+  return bestIndex;
+}
+
+mitk::PointSet::SpatialIndex *mitk::PointSet::GetSpatialIndex(int t) const
+{
+  if (m_SpatialIndices.size() < m_PointSetSeries.size())
+    m_SpatialIndices.resize(m_PointSetSeries.size());
+
+  auto &index = m_SpatialIndices[t];
+
+  if (nullptr == index)
+    index.reset(new SpatialIndex);
+
+  const PointsContainer *points = m_PointSetSeries[t]->GetPoints();
+
+  if (!index->IsUpToDate(points))
+    index->Build(points);
+
+  return index.get();
+}
+
+void mitk::PointSet::UpdateSpatialIndex(int t,
+                                         PointIdentifier id,
+                                         const PointType *oldPoint,
+                                         const PointType *newPoint,
+                                         itk::ModifiedTimeType timeBeforeChange)
+{
+  std::lock_guard<std::mutex> lock(m_SpatialIndexMutex);
+
+  if (t < 0 || static_cast<std::size_t>(t) >= m_SpatialIndices.size() || nullptr == m_SpatialIndices[t])
+    return;
+
+  auto &index = *m_SpatialIndices[t];
+  const PointsContainer *points = m_PointSetSeries[t]->GetPoints();
+
+  // An index which was outdated before the change is rebuilt by the next search anyway
+  if (index.Points != points || index.Time != timeBeforeChange)
+    return;
+
+  if (nullptr != oldPoint)
+    index.Remove(id, *oldPoint);
+
+  if (nullptr != newPoint)
+    index.Insert(id, *newPoint);
+
+  index.Time = points->GetMTime();
+}
+
 mitk::PointSet::PointType mitk::PointSet::GetPoint(PointIdentifier id, int t) const
 {
   PointType out;
@@ -598,7 +916,13 @@ void mitk::PointSet::ExecuteOperation(Operation *operation)
       }
       geometry->WorldToIndex(pt, pt);
 
-      m_PointSetSeries[timeStep]->GetPoints()->InsertElement(position, pt);
+      PointsContainer *points = m_PointSetSeries[timeStep]->GetPoints();
+      const auto timeBeforeChange = points->GetMTime();
+      PointType oldPoint;
+      const bool existed = points->GetElementIfIndexExists(position, &oldPoint);
+
+      points->InsertElement(position, pt);
+      this->UpdateSpatialIndex(timeStep, position, existed ? &oldPoint : nullptr, &pt, timeBeforeChange);
 
       PointDataType pointData = {
         static_cast<unsigned int>(pointOp->GetIndex()), pointOp->GetSelected(), pointOp->GetPointType()};
@@ -623,8 +947,14 @@ void mitk::PointSet::ExecuteOperation(Operation *operation)
       // transfer from world to index coordinates
       this->GetGeometry(timeStep)->WorldToIndex(pt, pt);
 
+      PointsContainer *points = m_PointSetSeries[timeStep]->GetPoints();
+      const auto timeBeforeChange = points->GetMTime();
+      PointType oldPoint;
+      const bool existed = points->GetElementIfIndexExists(pointOp->GetIndex(), &oldPoint);
+
       // Copy new point into container
       m_PointSetSeries[timeStep]->SetPoint(pointOp->GetIndex(), pt);
+      this->UpdateSpatialIndex(timeStep, pointOp->GetIndex(), existed ? &oldPoint : nullptr, &pt, timeBeforeChange);
 
       // Insert a default point data object to keep the containers in sync
       // (if no point data object exists yet)
@@ -647,7 +977,15 @@ void mitk::PointSet::ExecuteOperation(Operation *operation)
 
     case OpREMOVE: // removes the point at given by position
     {
-      m_PointSetSeries[timeStep]->GetPoints()->DeleteIndex((unsigned)pointOp->GetIndex());
+      PointsContainer *points = m_PointSetSeries[timeStep]->GetPoints();
+      const auto timeBeforeChange = points->GetMTime();
+      PointType oldPoint;
+
+      if (points->GetElementIfIndexExists(pointOp->GetIndex(), &oldPoint))
+      {
+        points->DeleteIndex((unsigned)pointOp->GetIndex());
+        this->UpdateSpatialIndex(timeStep, pointOp->GetIndex(), &oldPoint, nullptr, timeBeforeChange);
+      }
       m_PointSetSeries[timeStep]->GetPointData()->DeleteIndex((unsigned)pointOp->GetIndex());
 
       this->OnPointSetChange();
@@ -0,0 +1,50 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkPropertyKey.h"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+  struct PropertyKeyTable
+  {
+    std::mutex Mutex;
+    std::unordered_map<std::string, mitk::PropertyKey::IdType> Ids;
+    // a deque does not move its elements when growing, so the names can be referenced by the keys
+    std::deque<std::string> Names;
+  };
+
+  PropertyKeyTable &GetPropertyKeyTable()
+  {
+    static PropertyKeyTable table;
+    return table;
+  }
+}
+
+mitk::PropertyKey::PropertyKey(const std::string &name)
+{
+  auto &table = GetPropertyKeyTable();
+  std::lock_guard<std::mutex> lock(table.Mutex);
+
+  auto iter = table.Ids.find(name);
+  if (iter == table.Ids.end())
+  {
+    iter = table.Ids.emplace(name, static_cast<IdType>(table.Names.size())).first;
+    table.Names.push_back(name);
+  }
+
+  m_Id = iter->second;
+  m_Name = &table.Names[m_Id];
+}
@@ -16,6 +16,17 @@ found in the LICENSE file.
 #include "mitkProperties.h"
 #include "mitkStringProperty.h"
 
+#include <algorithm>
+
+namespace
+{
+  template <typename ElementType>
+  bool CompareKeyIds(const ElementType &element, mitk::PropertyKey::IdType id)
+  {
+    return element.first < id;
+  }
+}
+
 mitk::BaseProperty::ConstPointer mitk::PropertyList::GetConstProperty(const std::string &propertyKey, const std::string &/*contextName*/, bool /*fallBackOnDefaultContext*/) const
 {
   PropertyMap::const_iterator it;
@@ -56,6 +67,37 @@ mitk::BaseProperty *mitk::PropertyList::GetProperty(const std::string &propertyK
     return nullptr;
 }
 
+mitk::BaseProperty *mitk::PropertyList::GetProperty(const PropertyKey &propertyKey) const
+{
+  auto it = std::lower_bound(
+    m_KeyIndex.cbegin(), m_KeyIndex.cend(), propertyKey.GetId(), CompareKeyIds<KeyIndexElementType>);
+
+  if (it != m_KeyIndex.cend() && it->first == propertyKey.GetId())
+    return it->second;
+  else
+    return nullptr;
+}
+
+void mitk::PropertyList::InsertIntoKeyIndex(const std::string &propertyKey, BaseProperty *property)
+{
+  const PropertyKey key(propertyKey);
+  auto it = std::lower_bound(m_KeyIndex.begin(), m_KeyIndex.end(), key.GetId(), CompareKeyIds<KeyIndexElementType>);
+
+  if (it != m_KeyIndex.end() && it->first == key.GetId())
+    it->second = property;
+  else
+    m_KeyIndex.insert(it, KeyIndexElementType(key.GetId(), property));
+}
+
+void mitk::PropertyList::RemoveFromKeyIndex(const std::string &propertyKey)
+{
+  const PropertyKey key(propertyKey);
+  auto it = std::lower_bound(m_KeyIndex.begin(), m_KeyIndex.end(), key.GetId(), CompareKeyIds<KeyIndexElementType>);
+
+  if (it != m_KeyIndex.end() && it->first == key.GetId())
+    m_KeyIndex.erase(it);
+}
+
 mitk::BaseProperty * mitk::PropertyList::GetNonConstProperty(const std::string &propertyKey, const std::string &/*contextName*/, bool /*fallBackOnDefaultContext*/)
 {
   return this->GetProperty(propertyKey);
@@ -104,6 +146,7 @@ void mitk::PropertyList::SetProperty(const std::string &propertyKey, BasePropert
 
   // no? add it.
   m_Properties.insert(PropertyMap::value_type(propertyKey, property));
+  this->InsertIntoKeyIndex(propertyKey, property);
   this->Modified();
 }
 
@@ -123,6 +166,7 @@ void mitk::PropertyList::ReplaceProperty(const std::string &propertyKey, BasePro
 
   // no? add/replace it.
   m_Properties.insert(PropertyMap::value_type(propertyKey, property));
+  this->InsertIntoKeyIndex(propertyKey, property);
   Modified();
 }
 
@@ -133,6 +177,7 @@ void mitk::PropertyList::RemoveProperty(const std::string &propertyKey, const st
   // Is a property with key @a propertyKey contained in the list?
   if (it != m_Properties.cend())
   {
+    this->RemoveFromKeyIndex(propertyKey);
     it->second = nullptr;
     m_Properties.erase(it);
     Modified();
@@ -147,7 +192,9 @@ mitk::PropertyList::PropertyList(const mitk::PropertyList &other) : itk::Object(
 {
   for (auto i = other.m_Properties.cbegin(); i != other.m_Properties.cend(); ++i)
   {
-    m_Properties.insert(std::make_pair(i->first, i->second->Clone()));
+    BaseProperty::Pointer property = i->second->Clone();
+    m_Properties.insert(std::make_pair(i->first, property));
+    this->InsertIntoKeyIndex(i->first, property);
   }
 }
 
@@ -184,6 +231,7 @@ bool mitk::PropertyList::DeleteProperty(const std::string &propertyKey)
 
   if (it != m_Properties.end())
   {
+    this->RemoveFromKeyIndex(propertyKey);
     it->second = nullptr;
     m_Properties.erase(it);
     Modified();
@@ -200,6 +248,7 @@ void mitk::PropertyList::Clear()
     it->second = nullptr;
     ++it;
   }
+  m_KeyIndex.clear();
   m_Properties.clear();
 }
 
@@ -247,6 +296,17 @@ bool mitk::PropertyList::GetBoolProperty(const char *propertyKey, bool &boolValu
   // return GetPropertyValue<bool>(propertyKey, boolValue);
 }
 
+bool mitk::PropertyList::GetBoolProperty(const PropertyKey &propertyKey, bool &boolValue) const
+{
+  BoolProperty *gp = dynamic_cast<BoolProperty *>(GetProperty(propertyKey));
+  if (gp != nullptr)
+  {
+    boolValue = gp->GetValue();
+    return true;
+  }
+  return false;
+}
+
 bool mitk::PropertyList::GetIntProperty(const char *propertyKey, int &intValue) const
 {
   IntProperty *gp = dynamic_cast<IntProperty *>(GetProperty(propertyKey));
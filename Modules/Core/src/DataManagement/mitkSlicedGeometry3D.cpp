@@ -24,6 +24,9 @@ found in the LICENSE file.
 
 const mitk::ScalarType PI = 3.14159265359;
 
+// Number of PlaneGeometries calculated for an evenly spaced stack that are kept for later requests
+const std::size_t MaximumNumberOfGeneratedPlaneGeometries = 32;
+
 mitk::SlicedGeometry3D::SlicedGeometry3D()
   : m_EvenlySpaced(true), m_Slices(0), m_ReferenceGeometry(nullptr), m_SliceNavigationController(nullptr)
 {
@@ -88,6 +91,18 @@ mitk::PlaneGeometry *mitk::SlicedGeometry3D::GetPlaneGeometry(int s) const
     // in the direction of m_DirectionVector.
     if ((m_EvenlySpaced) && (geometry2D.IsNull()))
     {
+      for (auto iter = m_GeneratedPlaneGeometries.begin(); iter != m_GeneratedPlaneGeometries.end(); ++iter)
+      {
+        if (iter->first == s)
+        {
+          // move it to the end, so the least recently requested geometries are discarded first
+          geometry2D = iter->second;
+          m_GeneratedPlaneGeometries.erase(iter);
+          m_GeneratedPlaneGeometries.emplace_back(s, geometry2D);
+          return geometry2D;
+        }
+      }
+
       PlaneGeometry *firstSlice = m_PlaneGeometries[0];
 
       if (firstSlice != nullptr &&
@@ -108,7 +123,21 @@ mitk::PlaneGeometry *mitk::SlicedGeometry3D::GetPlaneGeometry(int s) const
         requestedslice->SetOrigin(requestedslice->GetOrigin() + direction * s);
 
         geometry2D = requestedslice;
-        m_PlaneGeometries[s] = geometry2D;
+
+        // Discard the least recently requested geometry which is not referenced elsewhere. If all of them
+        // are still in use, the cache grows instead of invalidating them.
+        if (m_GeneratedPlaneGeometries.size() >= MaximumNumberOfGeneratedPlaneGeometries)
+        {
+          for (auto iter = m_GeneratedPlaneGeometries.begin(); iter != m_GeneratedPlaneGeometries.end(); ++iter)
+          {
+            if (iter->second->GetReferenceCount() == 1)
+            {
+              m_GeneratedPlaneGeometries.erase(iter);
+              break;
+            }
+          }
+        }
+        m_GeneratedPlaneGeometries.emplace_back(s, geometry2D);
       }
     }
     return geometry2D;
@@ -129,6 +158,15 @@ bool mitk::SlicedGeometry3D::SetPlaneGeometry(mitk::PlaneGeometry *geometry2D, i
 {
   if (this->IsValidSlice(s))
   {
+    for (auto iter = m_GeneratedPlaneGeometries.begin(); iter != m_GeneratedPlaneGeometries.end(); ++iter)
+    {
+      if (iter->first == s)
+      {
+        m_GeneratedPlaneGeometries.erase(iter);
+        break;
+      }
+    }
+
     m_PlaneGeometries[s] = geometry2D;
     m_PlaneGeometries[s]->SetReferenceGeometry(m_ReferenceGeometry);
     return true;
@@ -142,6 +180,7 @@ void mitk::SlicedGeometry3D::InitializeSlicedGeometry(unsigned int slices)
   m_Slices = slices;
 
   PlaneGeometry::Pointer gnull = nullptr;
+  this->ClearGeneratedPlaneGeometries();
   m_PlaneGeometries.assign(m_Slices, gnull);
 
   Vector3D spacing;
@@ -176,6 +215,7 @@ void mitk::SlicedGeometry3D::InitializeEvenlySpaced(mitk::PlaneGeometry *geometr
 
   // clear and reserve
   PlaneGeometry::Pointer gnull = nullptr;
+  this->ClearGeneratedPlaneGeometries();
   m_PlaneGeometries.assign(m_Slices, gnull);
 
   Vector3D directionVector = geometry2D->GetAxisVector(2);
@@ -367,6 +407,7 @@ void mitk::SlicedGeometry3D::ReinitializePlanes(const Point3D &center, const Poi
 
   // Finally, we can clear the previous geometry stack and initialize it with
   // our re-initialized "first plane".
+  this->ClearGeneratedPlaneGeometries();
   m_PlaneGeometries.assign(m_Slices, PlaneGeometry::Pointer(nullptr));
 
   if (m_Slices > 0)
@@ -433,6 +474,11 @@ void mitk::SlicedGeometry3D::SetImageGeometry(const bool isAnImageGeometry)
       geometry->SetImageGeometry(isAnImageGeometry);
     }
   }
+
+  for (auto &generated : m_GeneratedPlaneGeometries)
+  {
+    generated.second->SetImageGeometry(isAnImageGeometry);
+  }
 }
 
 void mitk::SlicedGeometry3D::ChangeImageGeometryConsideringOriginOffset(const bool isAnImageGeometry)
@@ -447,6 +493,11 @@ void mitk::SlicedGeometry3D::ChangeImageGeometryConsideringOriginOffset(const bo
     }
   }
 
+  for (auto &generated : m_GeneratedPlaneGeometries)
+  {
+    generated.second->ChangeImageGeometryConsideringOriginOffset(isAnImageGeometry);
+  }
+
   Superclass::ChangeImageGeometryConsideringOriginOffset(isAnImageGeometry);
 }
 
@@ -470,6 +521,16 @@ void mitk::SlicedGeometry3D::SetReferenceGeometry(const BaseGeometry *referenceG
   {
     (*it)->SetReferenceGeometry(referenceGeometry);
   }
+
+  for (auto &generated : m_GeneratedPlaneGeometries)
+  {
+    generated.second->SetReferenceGeometry(referenceGeometry);
+  }
+}
+
+void mitk::SlicedGeometry3D::ClearGeneratedPlaneGeometries()
+{
+  m_GeneratedPlaneGeometries.clear();
 }
 
 bool mitk::SlicedGeometry3D::HasReferenceGeometry() const
@@ -542,6 +603,7 @@ void mitk::SlicedGeometry3D::PreSetSpacing(const mitk::Vector3D &aSpacing)
 
   // clear and reserve
   PlaneGeometry::Pointer gnull = nullptr;
+  this->ClearGeneratedPlaneGeometries();
   m_PlaneGeometries.assign(m_Slices, gnull);
 
   if (m_Slices > 0)
@@ -566,6 +628,16 @@ void mitk::SlicedGeometry3D::SetEvenlySpaced(bool on)
 {
   if (m_EvenlySpaced != on)
   {
+    if (!on)
+    {
+      // the calculated geometries become regular slices, as they cannot be calculated anymore
+      for (auto &generated : m_GeneratedPlaneGeometries)
+      {
+        m_PlaneGeometries[generated.first] = generated.second;
+      }
+      this->ClearGeneratedPlaneGeometries();
+    }
+
     m_EvenlySpaced = on;
     this->Modified();
   }
@@ -694,6 +766,11 @@ void mitk::SlicedGeometry3D::ExecuteOperation(Operation *operation)
               }
             }
 
+            for (auto &generated : m_GeneratedPlaneGeometries)
+            {
+              generated.second->ExecuteOperation(operation);
+            }
+
             // rotate overall geometry
             auto *rotOp = dynamic_cast<RotationOperation *>(operation);
             BaseGeometry::ExecuteOperation(rotOp);
@@ -897,6 +974,7 @@ void mitk::SlicedGeometry3D::ExecuteOperation(Operation *operation)
             m_Slices = 1;
           }
 
+          this->ClearGeneratedPlaneGeometries();
           m_PlaneGeometries.assign(m_Slices, PlaneGeometry::Pointer(nullptr));
 
           if (m_Slices > 0)
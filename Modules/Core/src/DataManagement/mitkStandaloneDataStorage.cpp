@@ -12,13 +12,34 @@ found in the LICENSE file.
 
 #include "mitkStandaloneDataStorage.h"
 
+#include "itkCommand.h"
 #include "itkMutexLockHolder.h"
 #include "itkSimpleFastMutexLock.h"
 #include "mitkDataNode.h"
 #include "mitkGroupTagProperty.h"
+#include "mitkNodePredicateAnd.h"
 #include "mitkNodePredicateBase.h"
+#include "mitkNodePredicateDataType.h"
 #include "mitkNodePredicateProperty.h"
 #include "mitkProperties.h"
+#include "mitkStringProperty.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace
+{
+  template <typename TIndex>
+  void EraseFromIndex(TIndex &index, const std::string &key, const mitk::DataNode *node)
+  {
+    auto it = index.find(key);
+    if (it == index.end())
+      return;
+    it->second.erase(node);
+    if (it->second.empty())
+      index.erase(it);
+  }
+}
 
 mitk::StandaloneDataStorage::StandaloneDataStorage() : mitk::DataStorage()
 {
@@ -29,6 +50,7 @@ mitk::StandaloneDataStorage::~StandaloneDataStorage()
   for (auto it = m_SourceNodes.begin(); it != m_SourceNodes.end(); ++it)
   {
     this->RemoveListeners(it->first);
+    this->RemoveFromIndex(it->first);
   }
 }
 
@@ -81,6 +103,7 @@ void mitk::StandaloneDataStorage::Add(mitk::DataNode *node, const mitk::DataStor
 
     // register for ITK changed events
     this->AddListeners(node);
+    this->AddToIndex(node);
   }
 
   /* Notify observers */
@@ -109,7 +132,8 @@ void mitk::StandaloneDataStorage::Remove(const mitk::DataNode *node)
   EmitRemoveNodeEvent(node);
   {
     itk::MutexLockHolder<itk::SimpleFastMutexLock> locked(m_Mutex);
-    /* remove node from both relation adjacency lists */
+    /* remove node from the indices and from both relation adjacency lists */
+    this->RemoveFromIndex(node);
     this->RemoveFromRelation(node, m_SourceNodes);
     this->RemoveFromRelation(node, m_DerivedNodes);
   }
@@ -161,6 +185,182 @@ mitk::DataStorage::SetOfObjects::ConstPointer mitk::StandaloneDataStorage::GetAl
   return SetOfObjects::ConstPointer(resultset);
 }
 
+mitk::DataStorage::SetOfObjects::ConstPointer mitk::StandaloneDataStorage::GetSubset(
+  const NodePredicateBase *condition) const
+{
+  if (condition == nullptr)
+    return Superclass::GetSubset(condition);
+
+  mitk::DataStorage::SetOfObjects::Pointer candidateSet = mitk::DataStorage::SetOfObjects::New();
+  {
+    itk::MutexLockHolder<itk::SimpleFastMutexLock> locked(m_IndexMutex);
+    std::vector<const mitk::DataNode *> candidates;
+    if (this->GetIndexCandidates(condition, candidates))
+    {
+      /* the candidates are ordered by their pointers, like the nodes returned by GetAll() */
+      for (auto candidate : candidates)
+        candidateSet->InsertElement(candidateSet->Size(), const_cast<mitk::DataNode *>(candidate));
+    }
+    else
+    {
+      candidateSet = nullptr;
+    }
+  }
+
+  /* the lock of the indices must not be held here, GetAll() locks m_Mutex */
+  if (candidateSet.IsNull())
+    return Superclass::GetSubset(condition);
+  return this->FilterSetOfObjects(candidateSet, condition);
+}
+
+bool mitk::StandaloneDataStorage::GetIndexCandidates(const NodePredicateBase *condition,
+                                                     std::vector<const mitk::DataNode *> &candidates) const
+{
+  if (const auto *dataTypePredicate = dynamic_cast<const NodePredicateDataType *>(condition))
+  {
+    auto it = m_DataTypeIndex.find(dataTypePredicate->GetValidDataType());
+    if (it != m_DataTypeIndex.cend())
+      candidates.assign(it->second.cbegin(), it->second.cend());
+    return true;
+  }
+
+  if (const auto *propertyPredicate = dynamic_cast<const NodePredicateProperty *>(condition))
+  {
+    const auto *validName = dynamic_cast<const StringProperty *>(propertyPredicate->GetValidProperty());
+    if (propertyPredicate->GetRenderer() != nullptr || propertyPredicate->GetValidPropertyName() != "name" ||
+        validName == nullptr)
+      return false;
+
+    /* nodes without an own name property may get their name from the data, so they are always checked */
+    auto it = m_NameIndex.find(validName->GetValue());
+    if (it != m_NameIndex.cend())
+      std::set_union(it->second.cbegin(), it->second.cend(), m_NodesWithoutIndexedName.cbegin(),
+                     m_NodesWithoutIndexedName.cend(), std::back_inserter(candidates));
+    else
+      candidates.assign(m_NodesWithoutIndexedName.cbegin(), m_NodesWithoutIndexedName.cend());
+    return true;
+  }
+
+  if (const auto *andPredicate = dynamic_cast<const NodePredicateAnd *>(condition))
+  {
+    /* every node has to fulfill all child predicates, so the smallest candidate set of any child is sufficient */
+    bool hasCandidates = false;
+    for (const auto &childPredicate : andPredicate->GetPredicates())
+    {
+      std::vector<const mitk::DataNode *> childCandidates;
+      if (this->GetIndexCandidates(childPredicate, childCandidates) &&
+          (!hasCandidates || childCandidates.size() < candidates.size()))
+      {
+        candidates.swap(childCandidates);
+        hasCandidates = true;
+      }
+    }
+    return hasCandidates;
+  }
+
+  return false;
+}
+
+void mitk::StandaloneDataStorage::AddToIndex(const mitk::DataNode *node)
+{
+  itk::MemberCommand<StandaloneDataStorage>::Pointer nodeModifiedCommand =
+    itk::MemberCommand<StandaloneDataStorage>::New();
+  nodeModifiedCommand->SetCallbackFunction(this, &StandaloneDataStorage::OnIndexedNodeModified);
+
+  itk::MutexLockHolder<itk::SimpleFastMutexLock> locked(m_IndexMutex);
+  IndexEntry &entry = m_IndexEntries[node];
+  entry.NodeObserverTag = const_cast<mitk::DataNode *>(node)->AddObserver(itk::ModifiedEvent(), nodeModifiedCommand);
+  this->UpdateIndexEntry(node, entry);
+}
+
+void mitk::StandaloneDataStorage::RemoveFromIndex(const mitk::DataNode *node)
+{
+  itk::MutexLockHolder<itk::SimpleFastMutexLock> locked(m_IndexMutex);
+  auto entryIt = m_IndexEntries.find(node);
+  if (entryIt == m_IndexEntries.end())
+    return;
+
+  IndexEntry &entry = entryIt->second;
+  if (entry.HasDataType)
+    EraseFromIndex(m_DataTypeIndex, entry.DataType, node);
+  if (entry.HasIndexedName)
+    EraseFromIndex(m_NameIndex, entry.Name, node);
+  else
+    m_NodesWithoutIndexedName.erase(node);
+  if (entry.NameProperty.IsNotNull())
+    entry.NameProperty->RemoveObserver(entry.NameObserverTag);
+  const_cast<mitk::DataNode *>(node)->RemoveObserver(entry.NodeObserverTag);
+  m_IndexEntries.erase(entryIt);
+}
+
+void mitk::StandaloneDataStorage::UpdateIndexEntry(const mitk::DataNode *node, IndexEntry &entry)
+{
+  /* remove the node from its previous index entries */
+  if (entry.IsIndexed)
+  {
+    if (entry.HasDataType)
+      EraseFromIndex(m_DataTypeIndex, entry.DataType, node);
+    if (entry.HasIndexedName)
+      EraseFromIndex(m_NameIndex, entry.Name, node);
+    else
+      m_NodesWithoutIndexedName.erase(node);
+  }
+
+  const mitk::BaseData *data = node->GetData();
+  entry.HasDataType = data != nullptr;
+  entry.DataType = data != nullptr ? data->GetNameOfClass() : "";
+  if (entry.HasDataType)
+    m_DataTypeIndex[entry.DataType].insert(node);
+
+  /* only the own name property of the node is indexed, properties of the data are not observed */
+  auto *nameProperty = dynamic_cast<StringProperty *>(node->GetPropertyList()->GetProperty("name"));
+  entry.HasIndexedName = nameProperty != nullptr;
+  entry.Name = nameProperty != nullptr ? nameProperty->GetValue() : "";
+  if (entry.HasIndexedName)
+    m_NameIndex[entry.Name].insert(node);
+  else
+    m_NodesWithoutIndexedName.insert(node);
+
+  /* the value of the name property can be changed without modifying the node, so the property is observed too */
+  if (entry.NameProperty.GetPointer() != nameProperty)
+  {
+    if (entry.NameProperty.IsNotNull())
+      entry.NameProperty->RemoveObserver(entry.NameObserverTag);
+    entry.NameProperty = nameProperty;
+    if (nameProperty != nullptr)
+    {
+      itk::MemberCommand<StandaloneDataStorage>::Pointer nameModifiedCommand =
+        itk::MemberCommand<StandaloneDataStorage>::New();
+      nameModifiedCommand->SetCallbackFunction(this, &StandaloneDataStorage::OnIndexedNamePropertyModified);
+      entry.NameObserverTag = nameProperty->AddObserver(itk::ModifiedEvent(), nameModifiedCommand);
+    }
+  }
+  entry.IsIndexed = true;
+}
+
+void mitk::StandaloneDataStorage::OnIndexedNodeModified(const itk::Object *caller, const itk::EventObject &)
+{
+  const auto *node = dynamic_cast<const mitk::DataNode *>(caller);
+  if (node == nullptr)
+    return;
+
+  itk::MutexLockHolder<itk::SimpleFastMutexLock> locked(m_IndexMutex);
+  auto entryIt = m_IndexEntries.find(node);
+  if (entryIt != m_IndexEntries.end())
+    this->UpdateIndexEntry(node, entryIt->second);
+}
+
+void mitk::StandaloneDataStorage::OnIndexedNamePropertyModified(const itk::Object *caller, const itk::EventObject &)
+{
+  itk::MutexLockHolder<itk::SimpleFastMutexLock> locked(m_IndexMutex);
+  /* a property may be shared by several nodes */
+  for (auto &entry : m_IndexEntries)
+  {
+    if (entry.second.NameProperty.GetPointer() == caller)
+      this->UpdateIndexEntry(entry.first, entry.second);
+  }
+}
+
 mitk::DataStorage::SetOfObjects::ConstPointer mitk::StandaloneDataStorage::GetRelations(
   const mitk::DataNode *node,
   const AdjacencyList &relation,
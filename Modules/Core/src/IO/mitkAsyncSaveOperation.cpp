@@ -0,0 +1,134 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkAsyncSaveOperation.h"
+
+#include <itksys/SystemTools.hxx>
+
+#include <thread>
+
+mitk::AsyncSaveOperation::AsyncSaveOperation(const BaseData *snapshot,
+                                             const FileWriterSelector &writerSelector,
+                                             const std::string &path,
+                                             const CallbackType &callback)
+  : m_Snapshot(snapshot),
+    m_WriterSelector(writerSelector),
+    m_Path(path),
+    m_Callback(callback),
+    m_State(State::Pending),
+    m_CancelRequested(false)
+{
+}
+
+mitk::AsyncSaveOperation::~AsyncSaveOperation()
+{
+}
+
+mitk::AsyncSaveOperation::Pointer mitk::AsyncSaveOperation::Start(const BaseData *snapshot,
+                                                                  const FileWriterSelector &writerSelector,
+                                                                  const std::string &path,
+                                                                  const CallbackType &callback)
+{
+  Pointer operation = new AsyncSaveOperation(snapshot, writerSelector, path, callback);
+  operation->UnRegister();
+
+  // the thread keeps the operation alive until it is done
+  std::thread([operation]() { operation->Write(); }).detach();
+
+  return operation;
+}
+
+mitk::AsyncSaveOperation::State mitk::AsyncSaveOperation::GetState() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_State;
+}
+
+bool mitk::AsyncSaveOperation::IsDone() const
+{
+  State state = this->GetState();
+  return state != State::Pending && state != State::Writing;
+}
+
+std::string mitk::AsyncSaveOperation::GetErrorMessage() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_ErrorMessage;
+}
+
+std::string mitk::AsyncSaveOperation::GetPath() const
+{
+  return m_Path;
+}
+
+void mitk::AsyncSaveOperation::Cancel()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_CancelRequested = true;
+}
+
+void mitk::AsyncSaveOperation::Wait() const
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  m_Done.wait(lock, [this]() { return m_State != State::Pending && m_State != State::Writing; });
+}
+
+void mitk::AsyncSaveOperation::Write()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_State = m_CancelRequested ? State::Cancelled : State::Writing;
+  }
+
+  if (this->GetState() == State::Writing)
+  {
+    std::string errorMessage;
+    try
+    {
+      IFileWriter *writer = m_WriterSelector.GetSelected().GetWriter();
+      writer->SetOutputLocation(m_Path);
+      writer->Write();
+    }
+    catch (const std::exception &e)
+    {
+      errorMessage = std::string("Exception occurred when writing to ") + m_Path + ":\n" + e.what() + "\n";
+    }
+    catch (...)
+    {
+      errorMessage = std::string("Unknown exception occurred when writing to ") + m_Path + "\n";
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (!errorMessage.empty())
+    {
+      MITK_ERROR << errorMessage;
+      m_ErrorMessage = errorMessage;
+      m_State = State::Failed;
+    }
+    else if (m_CancelRequested)
+    {
+      itksys::SystemTools::RemoveFile(m_Path);
+      m_State = State::Cancelled;
+    }
+    else
+    {
+      m_State = State::Finished;
+    }
+  }
+
+  // release the snapshot before the callback, which may start the next save
+  m_Snapshot = nullptr;
+  m_Done.notify_all();
+
+  if (m_Callback)
+    m_Callback(this);
+}
@@ -22,6 +22,36 @@ found in the LICENSE file.
 
 #include <itksys/SystemTools.hxx>
 
+#include <mutex>
+
+namespace
+{
+  /** The confidence levels of the readers (by service id) for recently selected files. Readers may open the file
+   * in GetConfidenceLevel(), which should only happen once if a file is selected several times, e.g. by a reader
+   * options dialog and by IOUtil, or if it is loaded again.*/
+  struct ConfidenceLevelCache
+  {
+    struct FileEntry
+    {
+      long int ModifiedTime;
+      unsigned long Length;
+      std::map<long, mitk::IFileReader::ConfidenceLevel> ConfidenceLevels;
+    };
+
+    std::mutex Mutex;
+    std::map<std::string, FileEntry> Files;
+  };
+
+  ConfidenceLevelCache &GetConfidenceLevelCache()
+  {
+    static ConfidenceLevelCache cache;
+    return cache;
+  }
+
+  /** Bounds the memory of the cache in long sessions*/
+  const std::size_t MaximumNumberOfCachedFiles = 4096;
+}
+
 namespace mitk
 {
   struct FileReaderSelector::Item::Impl : us::SharedData
@@ -61,6 +91,20 @@ namespace mitk
     if (m_Data->m_MimeTypes.empty())
       return;
 
+    ConfidenceLevelCache::FileEntry cachedFile;
+    cachedFile.ModifiedTime = itksys::SystemTools::ModifiedTime(path);
+    cachedFile.Length = itksys::SystemTools::FileLength(path);
+    {
+      auto &cache = GetConfidenceLevelCache();
+      std::lock_guard<std::mutex> lock(cache.Mutex);
+      auto cacheIter = cache.Files.find(path);
+      if (cacheIter != cache.Files.end() && cacheIter->second.ModifiedTime == cachedFile.ModifiedTime &&
+          cacheIter->second.Length == cachedFile.Length)
+      {
+        cachedFile.ConfidenceLevels = cacheIter->second.ConfidenceLevels;
+      }
+    }
+
     for (std::vector<MimeType>::const_iterator mimeTypeIter = m_Data->m_MimeTypes.begin(),
                                                mimeTypeIterEnd = m_Data->m_MimeTypes.end();
          mimeTypeIter != mimeTypeIterEnd;
@@ -77,8 +121,21 @@ namespace mitk
           continue;
         try
         {
+          auto id = us::any_cast<long>(readerIter->GetProperty(us::ServiceConstants::SERVICE_ID()));
+
           reader->SetInput(path);
-          IFileReader::ConfidenceLevel confidenceLevel = reader->GetConfidenceLevel();
+          IFileReader::ConfidenceLevel confidenceLevel;
+          auto levelIter = cachedFile.ConfidenceLevels.find(id);
+          if (levelIter != cachedFile.ConfidenceLevels.end())
+          {
+            confidenceLevel = levelIter->second;
+          }
+          else
+          {
+            confidenceLevel = reader->GetConfidenceLevel();
+            cachedFile.ConfidenceLevels[id] = confidenceLevel;
+          }
+
           if (confidenceLevel == IFileReader::Unsupported)
           {
             continue;
@@ -89,7 +146,7 @@ namespace mitk
           item.d->m_FileReader = reader;
           item.d->m_ConfidenceLevel = confidenceLevel;
           item.d->m_MimeType = *mimeTypeIter;
-          item.d->m_Id = us::any_cast<long>(readerIter->GetProperty(us::ServiceConstants::SERVICE_ID()));
+          item.d->m_Id = id;
           m_Data->m_Items.insert(std::make_pair(item.d->m_Id, item));
           // m_Data->m_MimeTypes.insert(mimeType);
         }
@@ -105,6 +162,14 @@ namespace mitk
       }
     }
 
+    {
+      auto &cache = GetConfidenceLevelCache();
+      std::lock_guard<std::mutex> lock(cache.Mutex);
+      if (cache.Files.size() >= MaximumNumberOfCachedFiles)
+        cache.Files.clear();
+      cache.Files[path] = cachedFile;
+    }
+
     // get the "best" reader
 
     if (!m_Data->m_Items.empty())
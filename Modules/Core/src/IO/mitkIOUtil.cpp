@@ -20,6 +20,7 @@ found in the LICENSE file.
 #include <mitkIMimeTypeProvider.h>
 #include <mitkProgressBar.h>
 #include <mitkStandaloneDataStorage.h>
+#include <mitkTracing.h>
 #include <usGetModuleContext.h>
 #include <usLDAPProp.h>
 #include <usModuleContext.h>
@@ -35,8 +36,13 @@ found in the LICENSE file.
 #include <vtkSmartPointer.h>
 #include <vtkTriangleFilter.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cerrno>
 #include <cstdlib>
+#include <mutex>
+#include <set>
+#include <thread>
 
 static std::string GetLastErrorStr()
 {
@@ -313,7 +319,30 @@ namespace mitk
 
     static BaseData::Pointer LoadBaseDataFromFile(const std::string &path, const ReaderOptionsFunctorBase* optionsCallback = nullptr);
 
-    static void SetDefaultDataNodeProperties(mitk::DataNode *node, const std::string &filePath = std::string());
+    static void SetDefaultDataNodeProperties(mitk::DataNode *node,
+                                             const std::string &filePath,
+                                             const MimeType &mimeType);
+
+    typedef std::map<std::string, FileReaderSelector::Item> UsedReaderItemsType;
+
+    /** Selects the reader of the file, asking the options callback if necessary. Returns nullptr if there is no
+     * suitable reader or the loading was cancelled (abort).*/
+    static IFileReader *SelectReader(LoadInfo &loadInfo,
+                                     UsedReaderItemsType &usedReaderItems,
+                                     const ReaderOptionsFunctorBase *optionsCallback,
+                                     std::string &errMsg,
+                                     bool &abort);
+
+    /** Creates the nodes of read data and adds them to the data storage, if given.*/
+    static DataStorage::SetOfObjects::Pointer CreateNodes(LoadInfo &loadInfo,
+                                                          const std::vector<BaseData::Pointer> &baseData,
+                                                          DataStorage *ds);
+
+    /** Stores the data of the read nodes in the load info and the node result.*/
+    static void AddOutput(LoadInfo &loadInfo,
+                          const DataStorage::SetOfObjects *nodes,
+                          DataStorage::SetOfObjects *nodeResult,
+                          std::string &errMsg);
   };
 
   BaseData::Pointer IOUtil::Impl::LoadBaseDataFromFile(const std::string &path,
@@ -567,169 +596,208 @@ namespace mitk
     return result;
   }
 
+  DataStorage::SetOfObjects::Pointer IOUtil::LoadConcurrently(const std::vector<std::string> &paths,
+                                                              DataStorage &storage,
+                                                              unsigned int numberOfThreads,
+                                                              const ReaderOptionsFunctorBase *optionsCallback)
+  {
+    DataStorage::SetOfObjects::Pointer nodeResult = DataStorage::SetOfObjects::New();
+    std::vector<LoadInfo> loadInfos;
+    for (auto loadInfo : paths)
+    {
+      loadInfos.push_back(loadInfo);
+    }
+    std::string errMsg = Load(loadInfos, nodeResult, &storage, optionsCallback, numberOfThreads);
+    if (!errMsg.empty())
+    {
+      mitkThrow() << errMsg;
+    }
+    return nodeResult;
+  }
+
   std::string IOUtil::Load(std::vector<LoadInfo> &loadInfos,
                            DataStorage::SetOfObjects *nodeResult,
                            DataStorage *ds,
                            const ReaderOptionsFunctorBase *optionsCallback)
+  {
+    return Load(loadInfos, nodeResult, ds, optionsCallback, 1);
+  }
+
+  std::string IOUtil::Load(std::vector<LoadInfo> &loadInfos,
+                           DataStorage::SetOfObjects *nodeResult,
+                           DataStorage *ds,
+                           const ReaderOptionsFunctorBase *optionsCallback,
+                           unsigned int numberOfThreads)
   {
     if (loadInfos.empty())
     {
       return "No input files given";
     }
 
+    MITK_TRACE_SCOPE_ARGS("IO", "IOUtil::Load", "\"files\": " + std::to_string(loadInfos.size()));
+
+    if (numberOfThreads == 0)
+    {
+      numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
     int filesToRead = loadInfos.size();
     mitk::ProgressBar::GetInstance()->AddStepsToDo(2 * filesToRead);
 
     std::string errMsg;
 
-    std::map<std::string, FileReaderSelector::Item> usedReaderItems;
+    Impl::UsedReaderItemsType usedReaderItems;
 
     std::vector< std::string > read_files;
-    for (auto &loadInfo : loadInfos)
-    {
-      if(std::find(read_files.begin(), read_files.end(), loadInfo.m_Path) != read_files.end())
-        continue;
-
-      std::vector<FileReaderSelector::Item> readers = loadInfo.m_ReaderSelector.Get();
 
-      if (readers.empty())
+    if (numberOfThreads == 1 || loadInfos.size() == 1)
+    {
+      for (auto &loadInfo : loadInfos)
       {
-        if (!itksys::SystemTools::FileExists(loadInfo.m_Path.c_str()))
+        if(std::find(read_files.begin(), read_files.end(), loadInfo.m_Path) != read_files.end())
+          continue;
+
+        bool abort = false;
+        IFileReader *reader = Impl::SelectReader(loadInfo, usedReaderItems, optionsCallback, errMsg, abort);
+        if (abort)
+          break;
+        if (reader == nullptr)
+          continue;
+
+        // Do the actual reading
+        try
         {
-          errMsg += "File '" + loadInfo.m_Path + "' does not exist\n";
+          MITK_TRACE_SCOPE_ARGS("IO", "Read file", Tracing::MakeArg("path", loadInfo.m_Path));
+          DataStorage::SetOfObjects::Pointer nodes;
+          if (ds != nullptr)
+          {
+            nodes = reader->Read(*ds);
+          }
+          else
+          {
+            nodes = Impl::CreateNodes(loadInfo, reader->Read(), nullptr);
+          }
+
+          std::vector< std::string > new_files =  reader->GetReadFiles();
+          read_files.insert( read_files.end(), new_files.begin(), new_files.end() );
+
+          Impl::AddOutput(loadInfo, nodes, nodeResult, errMsg);
         }
-        else
+        catch (const std::exception &e)
         {
-          errMsg += "No reader available for '" + loadInfo.m_Path + "'\n";
+          errMsg += "Exception occured when reading file " + loadInfo.m_Path + ":\n" + e.what() + "\n\n";
         }
-        continue;
+        mitk::ProgressBar::GetInstance()->Progress(2);
+        --filesToRead;
+      }
+    }
+    else
+    {
+      // the readers are selected on this thread, since the options callback may ask the user
+      std::vector<IFileReader *> readers(loadInfos.size(), nullptr);
+      for (std::size_t i = 0; i < loadInfos.size(); ++i)
+      {
+        bool abort = false;
+        readers[i] = Impl::SelectReader(loadInfos[i], usedReaderItems, optionsCallback, errMsg, abort);
+        if (abort)
+          break;
       }
 
-      bool callOptionsCallback = readers.size() > 1 || !readers.front().GetReader()->GetOptions().empty();
-
-      // check if we already used a reader which should be re-used
-      std::vector<MimeType> currMimeTypes = loadInfo.m_ReaderSelector.GetMimeTypes();
-      std::string selectedMimeType;
-      for (std::vector<MimeType>::const_iterator mimeTypeIter = currMimeTypes.begin(),
-                                                 mimeTypeIterEnd = currMimeTypes.end();
-           mimeTypeIter != mimeTypeIterEnd;
-           ++mimeTypeIter)
+      // only the reading itself runs on the worker threads
+      struct ConcurrentRead
       {
-        std::map<std::string, FileReaderSelector::Item>::const_iterator oldSelectedItemIter =
-          usedReaderItems.find(mimeTypeIter->GetName());
-        if (oldSelectedItemIter != usedReaderItems.end())
+        bool Done = false;
+        std::vector<BaseData::Pointer> Data;
+        std::vector<std::string> ReadFiles;
+        std::string Error;
+      };
+      std::vector<ConcurrentRead> reads(loadInfos.size());
+
+      std::set<std::string> finishedFiles;
+      std::mutex finishedFilesMutex;
+      std::atomic<std::size_t> nextIndex(0);
+
+      auto worker = [&]() {
+        for (std::size_t i = nextIndex++; i < loadInfos.size(); i = nextIndex++)
         {
-          // we found an already used item for a mime-type which is contained
-          // in the current reader set, check all current readers if there service
-          // id equals the old reader
-          for (std::vector<FileReaderSelector::Item>::const_iterator currReaderItem = readers.begin(),
-                                                                     currReaderItemEnd = readers.end();
-               currReaderItem != currReaderItemEnd;
-               ++currReaderItem)
+          if (readers[i] == nullptr)
+            continue;
+
           {
-            if (currReaderItem->GetMimeType().GetName() == mimeTypeIter->GetName() &&
-                currReaderItem->GetServiceId() == oldSelectedItemIter->second.GetServiceId() &&
-                currReaderItem->GetConfidenceLevel() >= oldSelectedItemIter->second.GetConfidenceLevel())
-            {
-              // okay, we used the same reader already, re-use its options
-              selectedMimeType = mimeTypeIter->GetName();
-              callOptionsCallback = false;
-              loadInfo.m_ReaderSelector.Select(oldSelectedItemIter->second.GetServiceId());
-              loadInfo.m_ReaderSelector.GetSelected().GetReader()->SetOptions(
-                oldSelectedItemIter->second.GetReader()->GetOptions());
-              break;
-            }
+            // skip files which were already read together with another file, e.g. the files of an image series
+            std::lock_guard<std::mutex> lock(finishedFilesMutex);
+            if (finishedFiles.count(loadInfos[i].m_Path) != 0)
+              continue;
           }
-          if (!selectedMimeType.empty())
-            break;
-        }
-      }
 
-      if (callOptionsCallback && optionsCallback)
-      {
-        callOptionsCallback = (*optionsCallback)(loadInfo);
-        if (!callOptionsCallback && !loadInfo.m_Cancel)
-        {
-          usedReaderItems.erase(selectedMimeType);
-          FileReaderSelector::Item selectedItem = loadInfo.m_ReaderSelector.GetSelected();
-          usedReaderItems.insert(std::make_pair(selectedItem.GetMimeType().GetName(), selectedItem));
+          try
+          {
+            MITK_TRACE_SCOPE_ARGS("IO", "Read file", Tracing::MakeArg("path", loadInfos[i].m_Path));
+            reads[i].Data = readers[i]->Read();
+            reads[i].ReadFiles = readers[i]->GetReadFiles();
+          }
+          catch (const std::exception &e)
+          {
+            reads[i].Error =
+              "Exception occured when reading file " + loadInfos[i].m_Path + ":\n" + e.what() + "\n\n";
+          }
+          reads[i].Done = true;
+
+          std::lock_guard<std::mutex> lock(finishedFilesMutex);
+          finishedFiles.insert(reads[i].ReadFiles.begin(), reads[i].ReadFiles.end());
         }
-      }
+      };
 
-      if (loadInfo.m_Cancel)
+      const auto numberOfWorkers = std::min<std::size_t>(numberOfThreads, loadInfos.size());
+      std::vector<std::thread> threads;
+      for (std::size_t i = 1; i < numberOfWorkers; ++i)
       {
-        errMsg += "Reading operation(s) cancelled.";
-        break;
+        threads.emplace_back(worker);
       }
-
-      IFileReader *reader = loadInfo.m_ReaderSelector.GetSelected().GetReader();
-      if (reader == nullptr)
+      worker();
+      for (auto &thread : threads)
       {
-        errMsg += "Unexpected nullptr reader.";
-        break;
+        thread.join();
       }
 
-      // Do the actual reading
-      try
+      // add the results in the original order, which gives the same result as reading the files one after another
+      for (std::size_t i = 0; i < loadInfos.size(); ++i)
       {
-        DataStorage::SetOfObjects::Pointer nodes;
-        if (ds != nullptr)
-        {
-          nodes = reader->Read(*ds);
+        LoadInfo &loadInfo = loadInfos[i];
+        if (readers[i] == nullptr ||
+            std::find(read_files.begin(), read_files.end(), loadInfo.m_Path) != read_files.end())
+          continue;
 
-          std::vector< std::string > new_files =  reader->GetReadFiles();
-          read_files.insert( read_files.end(), new_files.begin(), new_files.end() );
-        }
-        else
+        try
         {
-          nodes = DataStorage::SetOfObjects::New();
-          std::vector<mitk::BaseData::Pointer> baseData = reader->Read();
-          for (auto iter = baseData.begin(); iter != baseData.end(); ++iter)
+          if (!reads[i].Done)
           {
-            if (iter->IsNotNull())
-            {
-              mitk::DataNode::Pointer node = mitk::DataNode::New();
-              node->SetData(*iter);
-              nodes->InsertElement(nodes->Size(), node);
-            }
+            // skipped by the workers, but its file is not read by a previous file of the list
+            reads[i].Data = readers[i]->Read();
+            reads[i].ReadFiles = readers[i]->GetReadFiles();
           }
-
-          std::vector< std::string > new_files =  reader->GetReadFiles();
-          read_files.insert( read_files.end(), new_files.begin(), new_files.end() );
-        }
-
-        for (DataStorage::SetOfObjects::ConstIterator nodeIter = nodes->Begin(), nodeIterEnd = nodes->End();
-             nodeIter != nodeIterEnd;
-             ++nodeIter)
-        {
-          const mitk::DataNode::Pointer &node = nodeIter->Value();
-          mitk::BaseData::Pointer data = node->GetData();
-          if (data.IsNull())
+          else if (!reads[i].Error.empty())
           {
-            continue;
+            errMsg += reads[i].Error;
           }
 
-          mitk::StringProperty::Pointer pathProp = mitk::StringProperty::New(loadInfo.m_Path);
-          data->SetProperty("path", pathProp);
-
-          loadInfo.m_Output.push_back(data);
-          if (nodeResult)
+          if (reads[i].Error.empty())
           {
-            nodeResult->push_back(nodeIter->Value());
+            read_files.insert(read_files.end(), reads[i].ReadFiles.begin(), reads[i].ReadFiles.end());
+
+            DataStorage::SetOfObjects::Pointer nodes = Impl::CreateNodes(loadInfo, reads[i].Data, ds);
+            Impl::AddOutput(loadInfo, nodes, nodeResult, errMsg);
           }
         }
-
-        if (loadInfo.m_Output.empty() || (nodeResult && nodeResult->Size() == 0))
+        catch (const std::exception &e)
         {
-          errMsg += "Unknown read error occurred reading " + loadInfo.m_Path;
+          errMsg += "Exception occured when reading file " + loadInfo.m_Path + ":\n" + e.what() + "\n\n";
         }
+        reads[i].Data.clear();
+
+        mitk::ProgressBar::GetInstance()->Progress(2);
+        --filesToRead;
       }
-      catch (const std::exception &e)
-      {
-        errMsg += "Exception occured when reading file " + loadInfo.m_Path + ":\n" + e.what() + "\n\n";
-      }
-      mitk::ProgressBar::GetInstance()->Progress(2);
-      --filesToRead;
     }
 
     if (!errMsg.empty())
@@ -742,6 +810,149 @@ namespace mitk
     return errMsg;
   }
 
+  IFileReader *IOUtil::Impl::SelectReader(LoadInfo &loadInfo,
+                                          UsedReaderItemsType &usedReaderItems,
+                                          const ReaderOptionsFunctorBase *optionsCallback,
+                                          std::string &errMsg,
+                                          bool &abort)
+  {
+    std::vector<FileReaderSelector::Item> readers = loadInfo.m_ReaderSelector.Get();
+
+    if (readers.empty())
+    {
+      if (!itksys::SystemTools::FileExists(loadInfo.m_Path.c_str()))
+      {
+        errMsg += "File '" + loadInfo.m_Path + "' does not exist\n";
+      }
+      else
+      {
+        errMsg += "No reader available for '" + loadInfo.m_Path + "'\n";
+      }
+      return nullptr;
+    }
+
+    bool callOptionsCallback = readers.size() > 1 || !readers.front().GetReader()->GetOptions().empty();
+
+    // check if we already used a reader which should be re-used
+    std::vector<MimeType> currMimeTypes = loadInfo.m_ReaderSelector.GetMimeTypes();
+    std::string selectedMimeType;
+    for (std::vector<MimeType>::const_iterator mimeTypeIter = currMimeTypes.begin(),
+                                               mimeTypeIterEnd = currMimeTypes.end();
+         mimeTypeIter != mimeTypeIterEnd;
+         ++mimeTypeIter)
+    {
+      std::map<std::string, FileReaderSelector::Item>::const_iterator oldSelectedItemIter =
+        usedReaderItems.find(mimeTypeIter->GetName());
+      if (oldSelectedItemIter != usedReaderItems.end())
+      {
+        // we found an already used item for a mime-type which is contained
+        // in the current reader set, check all current readers if there service
+        // id equals the old reader
+        for (std::vector<FileReaderSelector::Item>::const_iterator currReaderItem = readers.begin(),
+                                                                   currReaderItemEnd = readers.end();
+             currReaderItem != currReaderItemEnd;
+             ++currReaderItem)
+        {
+          if (currReaderItem->GetMimeType().GetName() == mimeTypeIter->GetName() &&
+              currReaderItem->GetServiceId() == oldSelectedItemIter->second.GetServiceId() &&
+              currReaderItem->GetConfidenceLevel() >= oldSelectedItemIter->second.GetConfidenceLevel())
+          {
+            // okay, we used the same reader already, re-use its options
+            selectedMimeType = mimeTypeIter->GetName();
+            callOptionsCallback = false;
+            loadInfo.m_ReaderSelector.Select(oldSelectedItemIter->second.GetServiceId());
+            loadInfo.m_ReaderSelector.GetSelected().GetReader()->SetOptions(
+              oldSelectedItemIter->second.GetReader()->GetOptions());
+            break;
+          }
+        }
+        if (!selectedMimeType.empty())
+          break;
+      }
+    }
+
+    if (callOptionsCallback && optionsCallback)
+    {
+      callOptionsCallback = (*optionsCallback)(loadInfo);
+      if (!callOptionsCallback && !loadInfo.m_Cancel)
+      {
+        usedReaderItems.erase(selectedMimeType);
+        FileReaderSelector::Item selectedItem = loadInfo.m_ReaderSelector.GetSelected();
+        usedReaderItems.insert(std::make_pair(selectedItem.GetMimeType().GetName(), selectedItem));
+      }
+    }
+
+    if (loadInfo.m_Cancel)
+    {
+      errMsg += "Reading operation(s) cancelled.";
+      abort = true;
+      return nullptr;
+    }
+
+    IFileReader *reader = loadInfo.m_ReaderSelector.GetSelected().GetReader();
+    if (reader == nullptr)
+    {
+      errMsg += "Unexpected nullptr reader.";
+      abort = true;
+    }
+    return reader;
+  }
+
+  DataStorage::SetOfObjects::Pointer IOUtil::Impl::CreateNodes(LoadInfo &loadInfo,
+                                                               const std::vector<BaseData::Pointer> &baseData,
+                                                               DataStorage *ds)
+  {
+    DataStorage::SetOfObjects::Pointer nodes = DataStorage::SetOfObjects::New();
+    for (auto iter = baseData.begin(); iter != baseData.end(); ++iter)
+    {
+      if (iter->IsNotNull())
+      {
+        mitk::DataNode::Pointer node = mitk::DataNode::New();
+        node->SetData(*iter);
+        if (ds != nullptr)
+        {
+          // like AbstractFileReader::Read(DataStorage&)
+          SetDefaultDataNodeProperties(node, loadInfo.m_Path, loadInfo.m_ReaderSelector.GetSelected().GetMimeType());
+          ds->Add(node);
+        }
+        nodes->InsertElement(nodes->Size(), node);
+      }
+    }
+    return nodes;
+  }
+
+  void IOUtil::Impl::AddOutput(LoadInfo &loadInfo,
+                               const DataStorage::SetOfObjects *nodes,
+                               DataStorage::SetOfObjects *nodeResult,
+                               std::string &errMsg)
+  {
+    for (DataStorage::SetOfObjects::ConstIterator nodeIter = nodes->Begin(), nodeIterEnd = nodes->End();
+         nodeIter != nodeIterEnd;
+         ++nodeIter)
+    {
+      const mitk::DataNode::Pointer &node = nodeIter->Value();
+      mitk::BaseData::Pointer data = node->GetData();
+      if (data.IsNull())
+      {
+        continue;
+      }
+
+      mitk::StringProperty::Pointer pathProp = mitk::StringProperty::New(loadInfo.m_Path);
+      data->SetProperty("path", pathProp);
+
+      loadInfo.m_Output.push_back(data);
+      if (nodeResult)
+      {
+        nodeResult->push_back(nodeIter->Value());
+      }
+    }
+
+    if (loadInfo.m_Output.empty() || (nodeResult && nodeResult->Size() == 0))
+    {
+      errMsg += "Unknown read error occurred reading " + loadInfo.m_Path;
+    }
+  }
+
   std::vector<BaseData::Pointer> IOUtil::Load(const us::ModuleResource &usResource, std::ios_base::openmode mode)
   {
     us::ModuleResourceStream resStream(usResource, mode);
@@ -818,6 +1029,40 @@ namespace mitk
     }
   }
 
+  AsyncSaveOperation::Pointer IOUtil::SaveAsync(const BaseData *data,
+                                                const std::string &path,
+                                                const AsyncSaveOperation::CallbackType &callback,
+                                                const IFileWriter::Options &options)
+  {
+    if ((data == nullptr) || (data->IsEmpty()))
+      mitkThrow() << "BaseData cannotbe null or empty for save methods in IOUtil.h.";
+
+    if (path.empty())
+      mitkThrow() << "No output filename given";
+
+    // the snapshot is written, so the data may change while it is saved
+    itk::LightObject::Pointer clone = data->Clone();
+    BaseData::Pointer snapshot = dynamic_cast<BaseData *>(clone.GetPointer());
+    if (snapshot.IsNull())
+      mitkThrow() << "Could not copy the " << data->GetNameOfClass() << " data for saving it to " << path;
+
+    SaveInfo saveInfo(snapshot, MimeType(), path);
+    if (saveInfo.m_WriterSelector.IsEmpty())
+    {
+      mitkThrow() << "No suitable writer found for the current data of type " << data->GetNameOfClass()
+                  << " and path " << path;
+    }
+
+    IFileWriter *writer = saveInfo.m_WriterSelector.GetSelected().GetWriter();
+    if (writer == nullptr)
+      mitkThrow() << "Unexpected nullptr writer.";
+
+    if (!options.empty())
+      writer->SetOptions(options);
+
+    return AsyncSaveOperation::Start(snapshot, saveInfo.m_WriterSelector, path, callback);
+  }
+
   std::string IOUtil::Save(const BaseData *data,
                            const std::string &mimeTypeName,
                            const std::string &path,
@@ -963,8 +1208,8 @@ namespace mitk
     return errMsg;
   }
 
-  // This method can be removed after the deprecated LoadDataNode() method was removed
-  void IOUtil::Impl::SetDefaultDataNodeProperties(DataNode *node, const std::string &filePath)
+  // Same as AbstractFileReader::SetDefaultDataNodeProperties(), for nodes of data which was read concurrently
+  void IOUtil::Impl::SetDefaultDataNodeProperties(DataNode *node, const std::string &filePath, const MimeType &mimeType)
   {
     // path
     mitk::StringProperty::Pointer pathProp = mitk::StringProperty::New(itksys::SystemTools::GetFilenamePath(filePath));
@@ -980,7 +1225,9 @@ namespace mitk
       if (baseDataNameProp.IsNull() || baseDataNameProp->GetValue() == DataNode::NO_NAME_VALUE())
       {
         // name neither defined in node, nor in BaseData -> name = filename
-        nameProp = mitk::StringProperty::New(itksys::SystemTools::GetFilenameWithoutExtension(filePath));
+        const std::string fileName = mimeType.IsValid() ? mimeType.GetFilenameWithoutExtension(filePath)
+                                                        : itksys::SystemTools::GetFilenameWithoutExtension(filePath);
+        nameProp = mitk::StringProperty::New(fileName);
         node->SetProperty("name", nameProp);
       }
       else
@@ -16,18 +16,25 @@ found in the LICENSE file.
 #include <mitkCoreServices.h>
 #include <mitkCustomMimeType.h>
 #include <mitkIOMimeTypes.h>
+#include <mitkIOUtil.h>
 #include <mitkIPropertyPersistence.h>
 #include <mitkImage.h>
 #include <mitkImageReadAccessor.h>
 #include <mitkLocaleSwitch.h>
 
+#include "mitkParallelGzip.h"
+
 #include <itkImage.h>
 #include <itkImageFileReader.h>
 #include <itkImageIOFactory.h>
 #include <itkImageIORegion.h>
 #include <itkMetaDataObject.h>
 
+#include <itksys/SystemTools.hxx>
+
 #include <algorithm>
+#include <fstream>
+#include <thread>
 
 namespace mitk
 {
@@ -35,6 +42,7 @@ namespace mitk
   const char *const PROPERTY_NAME_TIMEGEOMETRY_TIMEPOINTS = "org.mitk.timegeometry.timepoints";
   const char *const PROPERTY_KEY_TIMEGEOMETRY_TYPE = "org_mitk_timegeometry_type";
   const char *const PROPERTY_KEY_TIMEGEOMETRY_TIMEPOINTS = "org_mitk_timegeometry_timepoints";
+  const char *const OPTION_NAME_COMPRESSION_THREADS = "Compression threads";
 
   ItkImageIO::ItkImageIO(const ItkImageIO &other)
     : AbstractFileIO(other), m_ImageIO(dynamic_cast<itk::ImageIOBase *>(other.m_ImageIO->Clone().GetPointer()))
@@ -191,6 +199,7 @@ namespace mitk
     this->SetReaderDescription(description);
     this->SetWriterDescription(description);
 
+    this->InitializeDefaultWriterOptions();
     this->RegisterService();
   }
 
@@ -212,6 +221,7 @@ namespace mitk
       this->AbstractFileWriter::SetRanking(rank);
     }
 
+    this->InitializeDefaultWriterOptions();
     this->RegisterService();
   }
 
@@ -615,11 +625,29 @@ namespace mitk
         ioRegion.SetIndex(i, image->GetLargestPossibleRegion().GetIndex(i));
       }
 
-      // use compression if available
-      m_ImageIO->UseCompressionOn();
+      // Compress NRRD and NIfTI files on several threads: ITK writes the file uncompressed to a temporary
+      // file, which is then compressed block-wise in parallel. Otherwise, use compression if available.
+      const ParallelCompressionFormat parallelCompressionFormat = this->GetParallelCompressionFormat(path);
+      std::string uncompressedFile;
+
+      if (parallelCompressionFormat != ParallelCompressionFormat::None)
+      {
+        const std::string extension = parallelCompressionFormat == ParallelCompressionFormat::Nrrd ? ".nrrd" : ".nii";
+        std::string directory = itksys::SystemTools::GetFilenamePath(path);
+        if (!directory.empty())
+          directory += '/';
+
+        uncompressedFile = IOUtil::CreateTemporaryFile("XXXXXX" + extension, directory);
+        m_ImageIO->UseCompressionOff();
+        m_ImageIO->SetFileName(uncompressedFile);
+      }
+      else
+      {
+        m_ImageIO->UseCompressionOn();
+        m_ImageIO->SetFileName(path);
+      }
 
       m_ImageIO->SetIORegion(ioRegion);
-      m_ImageIO->SetFileName(path);
 
       // Handle time geometry
       const auto *arbitraryTG = dynamic_cast<const ArbitraryTimeGeometry *>(image->GetTimeGeometry());
@@ -660,7 +688,23 @@ namespace mitk
 
       ImageReadAccessor imageAccess(image);
       LocaleSwitch localeSwitch2("C");
-      m_ImageIO->Write(imageAccess.GetData());
+
+      try
+      {
+        m_ImageIO->Write(imageAccess.GetData());
+
+        if (parallelCompressionFormat != ParallelCompressionFormat::None)
+          this->CompressFile(uncompressedFile, path, parallelCompressionFormat);
+      }
+      catch (...)
+      {
+        if (!uncompressedFile.empty())
+          itksys::SystemTools::RemoveFile(uncompressedFile);
+        throw;
+      }
+
+      if (!uncompressedFile.empty())
+        itksys::SystemTools::RemoveFile(uncompressedFile);
     }
     catch (const std::exception &e)
     {
@@ -668,6 +712,81 @@ namespace mitk
     }
   }
 
+  void ItkImageIO::InitializeDefaultWriterOptions()
+  {
+    const std::string imageIOName = m_ImageIO->GetNameOfClass();
+    if (imageIOName != "NrrdImageIO" && imageIOName != "NiftiImageIO")
+      return;
+
+    // 0 uses one thread per hardware thread, 1 uses the single-threaded compression of ITK
+    Options defaultOptions;
+    defaultOptions[OPTION_NAME_COMPRESSION_THREADS] = 0;
+    this->SetDefaultWriterOptions(defaultOptions);
+  }
+
+  ItkImageIO::ParallelCompressionFormat ItkImageIO::GetParallelCompressionFormat(const std::string &path) const
+  {
+    us::Any threadsOption = this->GetWriterOption(OPTION_NAME_COMPRESSION_THREADS);
+    if (threadsOption.Empty() || this->GetNumberOfCompressionThreads() <= 1)
+      return ParallelCompressionFormat::None;
+
+    // NRRD files with detached headers (.nhdr) and NIfTI file pairs (.hdr/.img) are left to ITK
+    const std::string imageIOName = m_ImageIO->GetNameOfClass();
+    const std::string lowerPath = itksys::SystemTools::LowerCase(path);
+
+    if (imageIOName == "NrrdImageIO" && itksys::SystemTools::StringEndsWith(lowerPath, ".nrrd"))
+      return ParallelCompressionFormat::Nrrd;
+
+    if (imageIOName == "NiftiImageIO" && itksys::SystemTools::StringEndsWith(lowerPath, ".nii.gz"))
+      return ParallelCompressionFormat::Nifti;
+
+    return ParallelCompressionFormat::None;
+  }
+
+  unsigned int ItkImageIO::GetNumberOfCompressionThreads() const
+  {
+    const int threads = us::any_cast<int>(this->GetWriterOption(OPTION_NAME_COMPRESSION_THREADS));
+    if (threads > 0)
+      return static_cast<unsigned int>(threads);
+
+    return std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  void ItkImageIO::CompressFile(const std::string &uncompressedFile,
+                                const std::string &path,
+                                ParallelCompressionFormat format) const
+  {
+    std::string header;
+    std::size_t offset = 0;
+
+    if (format == ParallelCompressionFormat::Nrrd)
+    {
+      // The NRRD header ends with an empty line and is followed by the data, which is compressed
+      // as gzip stream after switching the encoding of the header from raw to gzip.
+      std::ifstream input(uncompressedFile, std::ios::binary);
+      bool rawEncoding = false;
+      std::string line;
+      while (std::getline(input, line) && !line.empty())
+      {
+        if (line == "encoding: raw")
+        {
+          line = "encoding: gzip";
+          rawEncoding = true;
+        }
+        header += line + '\n';
+      }
+      header += '\n';
+
+      if (!input || !rawEncoding)
+        mitkThrow() << "Unexpected NRRD header in " << uncompressedFile;
+
+      offset = static_cast<std::size_t>(input.tellg());
+    }
+
+    ParallelGzipCompressFile(uncompressedFile, path, header, offset, -1 /* zlib default */,
+                             this->GetNumberOfCompressionThreads());
+  }
+
   AbstractFileIO::ConfidenceLevel ItkImageIO::GetWriterConfidenceLevel() const
   {
     // Check if the image dimension is supported
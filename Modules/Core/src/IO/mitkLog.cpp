@@ -14,6 +14,8 @@ found in the LICENSE file.
 #include <mitkLog.h>
 #include <mitkLogMacros.h>
 
+#include <mbilogBackendAsync.h>
+
 #include <itkOutputWindow.h>
 #include <itkSimpleFastMutexLock.h>
 
@@ -23,6 +25,7 @@ found in the LICENSE file.
 
 static itk::SimpleFastMutexLock logMutex;
 static mitk::LoggingBackend *mitkLogBackend = nullptr;
+static mbilog::BackendAsync *mitkAsyncLogBackend = nullptr;
 static std::ofstream *logFile = nullptr;
 static std::string logFileName = "";
 static std::stringstream *outputWindow = nullptr;
@@ -68,12 +71,21 @@ void mitk::LoggingBackend::ProcessMessage(const mbilog::LogMessage &l)
   logMutex.Unlock();
 }
 
-void mitk::LoggingBackend::Register()
+void mitk::LoggingBackend::Register(bool asynchronous)
 {
   if (mitkLogBackend)
     return;
   mitkLogBackend = new mitk::LoggingBackend();
-  mbilog::RegisterBackend(mitkLogBackend);
+
+  if (asynchronous)
+  {
+    mitkAsyncLogBackend = new mbilog::BackendAsync(mitkLogBackend);
+    mbilog::RegisterBackend(mitkAsyncLogBackend);
+  }
+  else
+  {
+    mbilog::RegisterBackend(mitkLogBackend);
+  }
 }
 
 void mitk::LoggingBackend::Unregister()
@@ -81,14 +93,34 @@ void mitk::LoggingBackend::Unregister()
   if (mitkLogBackend)
   {
     SetLogFile(nullptr);
-    mbilog::UnregisterBackend(mitkLogBackend);
+
+    if (mitkAsyncLogBackend)
+    {
+      mbilog::UnregisterBackend(mitkAsyncLogBackend);
+      delete mitkAsyncLogBackend; // writes the pending messages
+      mitkAsyncLogBackend = nullptr;
+    }
+    else
+    {
+      mbilog::UnregisterBackend(mitkLogBackend);
+    }
+
     delete mitkLogBackend;
     mitkLogBackend = nullptr;
   }
 }
 
+void mitk::LoggingBackend::Flush()
+{
+  if (mitkAsyncLogBackend)
+    mitkAsyncLogBackend->Flush();
+}
+
 void mitk::LoggingBackend::SetLogFile(const char *file)
 {
+  // pending messages still belong into the old logfile
+  Flush();
+
   // closing old logfile
   {
     bool closed = false;
@@ -19,14 +19,30 @@ found in the LICENSE file.
 
 #include <itksys/SystemTools.hxx>
 
+#include <algorithm>
+#include <cctype>
+#include <typeinfo>
+
 #ifdef _MSC_VER
 #pragma warning(disable : 4503) // decorated name length exceeded, name was truncated
 #pragma warning(disable : 4355)
 #endif
 
+namespace
+{
+  std::string ToLower(std::string str)
+  {
+    std::transform(str.begin(), str.end(), str.begin(), ::tolower);
+    return str;
+  }
+
+  /** Bounds the memory of the file cache in long sessions*/
+  const std::size_t MaximumNumberOfCachedFiles = 4096;
+}
+
 namespace mitk
 {
-  MimeTypeProvider::MimeTypeProvider() : m_Tracker(nullptr) {}
+  MimeTypeProvider::MimeTypeProvider() : m_Tracker(nullptr), m_ExtensionIndexIsValid(false), m_Generation(0) {}
   MimeTypeProvider::~MimeTypeProvider() { delete m_Tracker; }
   void MimeTypeProvider::Start()
   {
@@ -50,16 +66,61 @@ namespace mitk
 
   std::vector<MimeType> MimeTypeProvider::GetMimeTypesForFile(const std::string &filePath) const
   {
+    const long int modifiedTime = itksys::SystemTools::ModifiedTime(filePath);
+    const unsigned long length = itksys::SystemTools::FileLength(filePath);
+
     std::vector<MimeType> result;
-    for (const auto &elem : m_NameToMimeType)
+    std::vector<MimeType> otherMimeTypes;
+    unsigned long generation = 0;
     {
-      if (elem.second.AppliesTo(filePath))
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      generation = m_Generation;
+
+      auto cacheIter = m_FileMimeTypesCache.find(filePath);
+      if (cacheIter != m_FileMimeTypesCache.end() && cacheIter->second.ModifiedTime == modifiedTime &&
+          cacheIter->second.Length == length)
       {
-        result.push_back(elem.second);
+        return cacheIter->second.MimeTypes;
+      }
+
+      this->UpdateExtensionIndex();
+
+      // CustomMimeType::MatchesExtension() compares the end of the path with each extension
+      const std::string lowerCasePath = ToLower(filePath);
+      for (auto extensionLength : m_ExtensionLengths)
+      {
+        if (extensionLength > lowerCasePath.size())
+          break;
+
+        auto range = m_ExtensionIndex.equal_range(lowerCasePath.substr(lowerCasePath.size() - extensionLength));
+        for (auto iter = range.first; iter != range.second; ++iter)
+        {
+          if (std::find(result.begin(), result.end(), iter->second) == result.end())
+            result.push_back(iter->second);
+        }
+      }
+
+      otherMimeTypes = m_OtherMimeTypes;
+    }
+
+    // the other mime types may read the file, so they are not asked while the lock is held
+    for (const auto &mimeType : otherMimeTypes)
+    {
+      if (mimeType.AppliesTo(filePath))
+      {
+        result.push_back(mimeType);
       }
     }
     std::sort(result.begin(), result.end());
     std::reverse(result.begin(), result.end());
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (generation == m_Generation)
+    {
+      if (m_FileMimeTypesCache.size() >= MaximumNumberOfCachedFiles)
+        m_FileMimeTypesCache.clear();
+      m_FileMimeTypesCache[filePath] = FileMimeTypes{modifiedTime, length, result};
+    }
     return result;
   }
 
@@ -102,9 +163,17 @@ namespace mitk
 
   MimeTypeProvider::TrackedType MimeTypeProvider::AddingService(const ServiceReferenceType &reference)
   {
-    MimeType result = this->GetMimeType(reference);
+    bool extensionOnly = false;
+    MimeType result = this->GetMimeType(reference, &extensionOnly);
     if (result.IsValid())
     {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_ExtensionIndexIsValid = false;
+      m_FileMimeTypesCache.clear();
+      ++m_Generation;
+      if (extensionOnly)
+        m_ExtensionOnlyMimeTypes.insert(result);
+
       std::string name = result.GetName();
       m_NameToMimeTypes[name].insert(result);
 
@@ -121,6 +190,12 @@ namespace mitk
 
   void MimeTypeProvider::RemovedService(const ServiceReferenceType & /*reference*/, TrackedType mimeType)
   {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_ExtensionIndexIsValid = false;
+    m_FileMimeTypesCache.clear();
+    ++m_Generation;
+    m_ExtensionOnlyMimeTypes.erase(mimeType);
+
     std::string name = mimeType.GetName();
     std::set<MimeType> &mimeTypes = m_NameToMimeTypes[name];
     mimeTypes.erase(mimeType);
@@ -136,7 +211,7 @@ namespace mitk
     }
   }
 
-  MimeType MimeTypeProvider::GetMimeType(const ServiceReferenceType &reference) const
+  MimeType MimeTypeProvider::GetMimeType(const ServiceReferenceType &reference, bool *extensionOnly) const
   {
     MimeType result;
     if (!reference)
@@ -155,6 +230,10 @@ namespace mitk
         }
         auto id = us::any_cast<long>(reference.GetProperty(us::ServiceConstants::SERVICE_ID()));
         result = MimeType(*mimeType, rank, id);
+
+        // subclasses may override AppliesTo(), e.g. to look into the file
+        if (extensionOnly != nullptr)
+          *extensionOnly = typeid(*mimeType) == typeid(CustomMimeType);
       }
       catch (const us::BadAnyCastException &e)
       {
@@ -164,4 +243,32 @@ namespace mitk
     }
     return result;
   }
+
+  void MimeTypeProvider::UpdateExtensionIndex() const
+  {
+    if (m_ExtensionIndexIsValid)
+      return;
+
+    m_ExtensionIndex.clear();
+    m_ExtensionLengths.clear();
+    m_OtherMimeTypes.clear();
+    for (const auto &elem : m_NameToMimeType)
+    {
+      if (m_ExtensionOnlyMimeTypes.count(elem.second) == 0)
+      {
+        m_OtherMimeTypes.push_back(elem.second);
+        continue;
+      }
+
+      for (const auto &extension : elem.second.GetExtensions())
+      {
+        if (extension.empty())
+          continue;
+
+        m_ExtensionIndex.insert(std::make_pair(ToLower(extension), elem.second));
+        m_ExtensionLengths.insert(extension.size());
+      }
+    }
+    m_ExtensionIndexIsValid = true;
+  }
 }
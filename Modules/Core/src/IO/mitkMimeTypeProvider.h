@@ -19,6 +19,8 @@ found in the LICENSE file.
 #include "usServiceTracker.h"
 #include "usServiceTrackerCustomizer.h"
 
+#include <map>
+#include <mutex>
 #include <set>
 
 namespace mitk
@@ -53,7 +55,11 @@ namespace mitk
     void ModifiedService(const ServiceReferenceType &reference, TrackedType service) override;
     void RemovedService(const ServiceReferenceType &reference, TrackedType service) override;
 
-    MimeType GetMimeType(const ServiceReferenceType &reference) const;
+    /** \param extensionOnly set to whether the mime type is a plain CustomMimeType, if not nullptr*/
+    MimeType GetMimeType(const ServiceReferenceType &reference, bool *extensionOnly = nullptr) const;
+
+    /** Rebuilds the extension index if mime types were added or removed. Requires m_Mutex to be locked.*/
+    void UpdateExtensionIndex() const;
 
     us::ServiceTracker<CustomMimeType, MimeTypeTrackerTypeTraits> *m_Tracker;
 
@@ -61,6 +67,31 @@ namespace mitk
     MapType m_NameToMimeTypes;
 
     std::map<std::string, MimeType> m_NameToMimeType;
+
+    /** Mime types registered as plain CustomMimeType, whose AppliesTo() only compares extensions.*/
+    std::set<MimeType> m_ExtensionOnlyMimeTypes;
+
+    /** The extension-only mime types by lower case extension. The other mime types may open the file in their
+     * AppliesTo() and have to be asked for every file.*/
+    mutable std::multimap<std::string, MimeType> m_ExtensionIndex;
+    mutable std::set<std::size_t> m_ExtensionLengths;
+    mutable std::vector<MimeType> m_OtherMimeTypes;
+    mutable bool m_ExtensionIndexIsValid;
+
+    struct FileMimeTypes
+    {
+      long int ModifiedTime;
+      unsigned long Length;
+      std::vector<MimeType> MimeTypes;
+    };
+
+    /** The mime types of recently queried files, until the file or the registered mime types change.*/
+    mutable std::map<std::string, FileMimeTypes> m_FileMimeTypesCache;
+
+    /** Incremented whenever mime types are added or removed*/
+    unsigned long m_Generation;
+
+    mutable std::mutex m_Mutex;
   };
 }
 
@@ -0,0 +1,184 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkParallelGzip.h"
+
+#include <mitkExceptionMacro.h>
+
+#include "itk_zlib.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  const std::size_t BlockSize = 1 << 20;
+  const std::size_t DictionarySize = 1 << 15;
+
+  struct CompressedBlock
+  {
+    std::vector<unsigned char> Data;
+    uLong Crc;
+  };
+
+  void DeflateBlock(const unsigned char *data, std::size_t begin, std::size_t end, bool last, int level,
+                    CompressedBlock &block)
+  {
+    z_stream stream;
+    stream.zalloc = Z_NULL;
+    stream.zfree = Z_NULL;
+    stream.opaque = Z_NULL;
+
+    // raw deflate, the gzip header and trailer are written once for all blocks
+    if (deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+      mitkThrow() << "Could not initialize zlib compression.";
+
+    if (begin > 0)
+    {
+      const std::size_t dictionaryBegin = begin > DictionarySize ? begin - DictionarySize : 0;
+      deflateSetDictionary(&stream, data + dictionaryBegin, static_cast<uInt>(begin - dictionaryBegin));
+    }
+
+    const auto length = static_cast<uInt>(end - begin);
+    stream.next_in = const_cast<Bytef *>(data + begin);
+    stream.avail_in = length;
+
+    // all but the last block end on a byte boundary (Z_SYNC_FLUSH), so they can simply be concatenated
+    const int flush = last ? Z_FINISH : Z_SYNC_FLUSH;
+    block.Data.resize(deflateBound(&stream, length) + 16);
+    std::size_t written = 0;
+
+    for (;;)
+    {
+      stream.next_out = block.Data.data() + written;
+      stream.avail_out = static_cast<uInt>(block.Data.size() - written);
+      const int result = deflate(&stream, flush);
+      written = block.Data.size() - stream.avail_out;
+
+      if (result == Z_STREAM_END || (result == Z_OK && !last && stream.avail_out != 0))
+        break;
+
+      if (result != Z_OK && result != Z_BUF_ERROR)
+      {
+        deflateEnd(&stream);
+        mitkThrow() << "zlib compression failed with error code " << result << ".";
+      }
+
+      block.Data.resize(block.Data.size() * 2);
+    }
+
+    deflateEnd(&stream);
+    block.Data.resize(written);
+    block.Crc = crc32(crc32(0L, Z_NULL, 0), data + begin, length);
+  }
+
+  void WriteLittleEndian(std::ostream &output, uLong value)
+  {
+    for (int i = 0; i < 4; ++i)
+      output.put(static_cast<char>((value >> (8 * i)) & 0xff));
+  }
+}
+
+void mitk::ParallelGzipCompress(
+  const char *data, std::size_t size, std::ostream &output, int level, unsigned int numberOfThreads)
+{
+  const auto *bytes = reinterpret_cast<const unsigned char *>(data);
+  const std::size_t numberOfBlocks = std::max<std::size_t>(1, (size + BlockSize - 1) / BlockSize);
+
+  if (numberOfThreads == 0)
+    numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+
+  std::vector<CompressedBlock> blocks(numberOfBlocks);
+  std::atomic<std::size_t> nextBlock(0);
+  std::mutex errorMutex;
+  std::string errorMessage;
+
+  auto worker = [&]() {
+    for (std::size_t i = nextBlock++; i < numberOfBlocks; i = nextBlock++)
+    {
+      try
+      {
+        DeflateBlock(bytes, i * BlockSize, std::min(size, (i + 1) * BlockSize), i + 1 == numberOfBlocks, level,
+                     blocks[i]);
+      }
+      catch (const std::exception &e)
+      {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        errorMessage = e.what();
+        nextBlock = numberOfBlocks;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1; i < std::min<std::size_t>(numberOfThreads, numberOfBlocks); ++i)
+    threads.emplace_back(worker);
+  worker();
+
+  for (auto &thread : threads)
+    thread.join();
+
+  if (!errorMessage.empty())
+    mitkThrow() << errorMessage;
+
+  // gzip header: magic number, deflate, no flags, no modification time, no extra flags, unix
+  const char header[10] = {'\x1f', '\x8b', 8, 0, 0, 0, 0, 0, 0, 3};
+  output.write(header, sizeof(header));
+
+  uLong crc = crc32(0L, Z_NULL, 0);
+  for (std::size_t i = 0; i < numberOfBlocks; ++i)
+  {
+    output.write(reinterpret_cast<const char *>(blocks[i].Data.data()), blocks[i].Data.size());
+    const std::size_t blockLength = std::min(size, (i + 1) * BlockSize) - i * BlockSize;
+    crc = crc32_combine(crc, blocks[i].Crc, static_cast<z_off_t>(blockLength));
+  }
+
+  WriteLittleEndian(output, crc);
+  WriteLittleEndian(output, static_cast<uLong>(size & 0xffffffff));
+
+  if (!output)
+    mitkThrow() << "Could not write the compressed data.";
+}
+
+void mitk::ParallelGzipCompressFile(const std::string &inputPath,
+                                    const std::string &outputPath,
+                                    const std::string &header,
+                                    std::size_t offset,
+                                    int level,
+                                    unsigned int numberOfThreads)
+{
+  std::ifstream input(inputPath, std::ios::binary | std::ios::ate);
+  if (!input)
+    mitkThrow() << "Could not open " << inputPath << " for reading.";
+
+  const auto fileSize = static_cast<std::size_t>(input.tellg());
+  if (fileSize < offset)
+    mitkThrow() << "Unexpected size of " << inputPath << ".";
+
+  std::vector<char> data(fileSize - offset);
+  input.seekg(offset);
+  input.read(data.data(), data.size());
+  if (!input)
+    mitkThrow() << "Could not read " << inputPath << ".";
+  input.close();
+
+  std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+  if (!output)
+    mitkThrow() << "Could not open " << outputPath << " for writing.";
+
+  output << header;
+  ParallelGzipCompress(data.data(), data.size(), output, level, numberOfThreads);
+}
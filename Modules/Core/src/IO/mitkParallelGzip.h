@@ -0,0 +1,50 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkParallelGzip_h
+#define mitkParallelGzip_h
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+namespace mitk
+{
+  /**
+   * @brief Compresses data into a gzip stream on several threads, like pigz does.
+   *
+   * The data is split into blocks which are deflated concurrently. Each block is primed with the last 32 KiB of
+   * the previous block as dictionary, so the compression ratio is almost the same as for a single thread. The
+   * blocks are joined into one standard gzip member, which can be read by any gzip/zlib reader.
+   *
+   * @param level The zlib compression level (0-9, or -1 for the zlib default).
+   * @param numberOfThreads The number of threads, 0 uses one thread per hardware thread.
+   * @throw mitk::Exception if zlib reports an error or the output cannot be written.
+   */
+  void ParallelGzipCompress(
+    const char *data, std::size_t size, std::ostream &output, int level, unsigned int numberOfThreads);
+
+  /**
+   * @brief Compresses the file inputPath into the gzip file outputPath with ParallelGzipCompress().
+   *
+   * @param header Written uncompressed in front of the gzip stream, e.g. the header of a NRRD file.
+   * @param offset The number of bytes at the beginning of inputPath which are skipped.
+   */
+  void ParallelGzipCompressFile(const std::string &inputPath,
+                                const std::string &outputPath,
+                                const std::string &header,
+                                std::size_t offset,
+                                int level,
+                                unsigned int numberOfThreads);
+}
+
+#endif
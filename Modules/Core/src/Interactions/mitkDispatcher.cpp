@@ -14,8 +14,14 @@ found in the LICENSE file.
 #include "mitkInteractionEvent.h"
 #include "mitkInteractionEventObserver.h"
 #include "mitkInternalEvent.h"
+#include "mitkTracing.h"
 #include "usGetModuleContext.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <typeinfo>
+
 namespace
 {
   struct cmp
@@ -25,9 +31,18 @@ namespace
       return (d1.Lock()->GetLayer() > d2.Lock()->GetLayer());
     }
   };
+
+  double GetMillisecondsSince(const std::chrono::steady_clock::time_point &start)
+  {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  }
 }
 
-mitk::Dispatcher::Dispatcher(const std::string &rendererName) : m_ProcessingMode(REGULAR)
+mitk::Dispatcher::Dispatcher(const std::string &rendererName)
+  : m_MoveEventCoalescingEnabled(true),
+    m_NumberOfCoalescedEvents(0),
+    m_EventHandlingStatisticsEnabled(false),
+    m_ProcessingMode(REGULAR)
 {
   // LDAP filter string to find all listeners specific for the renderer
   // corresponding to this dispatcher
@@ -99,8 +114,14 @@ mitk::Dispatcher::~Dispatcher()
 
 bool mitk::Dispatcher::ProcessEvent(InteractionEvent *event)
 {
+  MITK_TRACE_SCOPE_ARGS("Interaction", "Dispatcher::ProcessEvent", Tracing::MakeArg("event", event->GetNameOfClass()));
   InteractionEvent::Pointer p = event;
   bool eventIsHandled = false;
+
+  // A pending move event happened before this event
+  if (m_PendingEvent.IsNotNull() && m_PendingEvent.GetPointer() != event)
+    this->ProcessPendingEvent();
+
   /* Filter out and handle Internal Events separately */
   auto *internalEvent = dynamic_cast<InternalEvent *>(event);
   if (internalEvent != nullptr)
@@ -121,20 +142,20 @@ bool mitk::Dispatcher::ProcessEvent(InteractionEvent *event)
         m_ProcessingMode = REGULAR;
 
         if (!m_SelectedInteractor.IsExpired())
-          eventIsHandled = m_SelectedInteractor.Lock()->HandleEvent(event, m_SelectedInteractor.Lock()->GetDataNode());
+          eventIsHandled = this->HandleEvent(m_SelectedInteractor.Lock(), event);
 
         m_SelectedInteractor = nullptr;
       }
       // give event to selected interactor
       if (eventIsHandled == false && !m_SelectedInteractor.IsExpired())
-        eventIsHandled = m_SelectedInteractor.Lock()->HandleEvent(event, m_SelectedInteractor.Lock()->GetDataNode());
+        eventIsHandled = this->HandleEvent(m_SelectedInteractor.Lock(), event);
 
       break;
 
     case GRABINPUT:
       if (!m_SelectedInteractor.IsExpired())
       {
-        eventIsHandled = m_SelectedInteractor.Lock()->HandleEvent(event, m_SelectedInteractor.Lock()->GetDataNode());
+        eventIsHandled = this->HandleEvent(m_SelectedInteractor.Lock(), event);
         SetEventProcessingMode(m_SelectedInteractor.Lock());
       }
 
@@ -142,7 +163,7 @@ bool mitk::Dispatcher::ProcessEvent(InteractionEvent *event)
 
     case PREFERINPUT:
       if (!m_SelectedInteractor.IsExpired() &&
-          m_SelectedInteractor.Lock()->HandleEvent(event, m_SelectedInteractor.Lock()->GetDataNode()) == true)
+          this->HandleEvent(m_SelectedInteractor.Lock(), event) == true)
       {
         SetEventProcessingMode(m_SelectedInteractor.Lock());
         eventIsHandled = true;
@@ -167,7 +188,7 @@ bool mitk::Dispatcher::ProcessEvent(InteractionEvent *event)
     ListInteractorType::const_iterator it;
     for (it = tmpInteractorList.cbegin(); it != tmpInteractorList.cend(); ++it)
     {
-      if (!(*it).IsExpired() && (*it).Lock()->HandleEvent(event, (*it).Lock()->GetDataNode()))
+      if (!(*it).IsExpired() && this->HandleEvent((*it).Lock(), event))
       {
         // Interactor can be deleted during HandleEvent(), so check it again
         if (!(*it).IsExpired())
@@ -199,7 +220,19 @@ bool mitk::Dispatcher::ProcessEvent(InteractionEvent *event)
     {
       if (interactionEventObserver->IsEnabled())
       {
-        interactionEventObserver->Notify(event, eventIsHandled);
+        if (m_EventHandlingStatisticsEnabled)
+        {
+          auto object = dynamic_cast<itk::LightObject *>(interactionEventObserver);
+          const std::string name = nullptr != object ? object->GetNameOfClass() : typeid(*interactionEventObserver).name();
+
+          const auto start = std::chrono::steady_clock::now();
+          interactionEventObserver->Notify(event, eventIsHandled);
+          this->AddEventHandlingTime(name, GetMillisecondsSince(start));
+        }
+        else
+        {
+          interactionEventObserver->Notify(event, eventIsHandled);
+        }
       }
     }
   }
@@ -214,6 +247,109 @@ bool mitk::Dispatcher::ProcessEvent(InteractionEvent *event)
   return eventIsHandled;
 }
 
+bool mitk::Dispatcher::PostEvent(InteractionEvent *event)
+{
+  if (m_MoveEventCoalescingEnabled && std::strcmp(event->GetNameOfClass(), "MouseMoveEvent") == 0)
+  {
+    if (m_PendingEvent.IsNotNull())
+      ++m_NumberOfCoalescedEvents;
+
+    m_PendingEvent = event;
+    return false;
+  }
+
+  return this->ProcessEvent(event);
+}
+
+bool mitk::Dispatcher::ProcessPendingEvent()
+{
+  if (m_PendingEvent.IsNull())
+    return false;
+
+  InteractionEvent::Pointer event = m_PendingEvent;
+  m_PendingEvent = nullptr;
+
+  return this->ProcessEvent(event);
+}
+
+bool mitk::Dispatcher::HasPendingEvent() const
+{
+  return m_PendingEvent.IsNotNull();
+}
+
+void mitk::Dispatcher::SetMoveEventCoalescingEnabled(bool enabled)
+{
+  m_MoveEventCoalescingEnabled = enabled;
+
+  if (!enabled)
+    this->ProcessPendingEvent();
+}
+
+bool mitk::Dispatcher::IsMoveEventCoalescingEnabled() const
+{
+  return m_MoveEventCoalescingEnabled;
+}
+
+unsigned long mitk::Dispatcher::GetNumberOfCoalescedEvents() const
+{
+  return m_NumberOfCoalescedEvents;
+}
+
+void mitk::Dispatcher::SetEventHandlingStatisticsEnabled(bool enabled)
+{
+  m_EventHandlingStatisticsEnabled = enabled;
+}
+
+bool mitk::Dispatcher::IsEventHandlingStatisticsEnabled() const
+{
+  return m_EventHandlingStatisticsEnabled;
+}
+
+std::vector<mitk::Dispatcher::EventHandlingStatistics> mitk::Dispatcher::GetEventHandlingStatistics() const
+{
+  std::vector<EventHandlingStatistics> result;
+  result.reserve(m_EventHandlingStatistics.size());
+
+  for (const auto &statistics : m_EventHandlingStatistics)
+    result.push_back(statistics.second);
+
+  std::sort(result.begin(), result.end(), [](const EventHandlingStatistics &a, const EventHandlingStatistics &b) {
+    return a.TotalMilliseconds > b.TotalMilliseconds;
+  });
+
+  return result;
+}
+
+void mitk::Dispatcher::ResetEventHandlingStatistics()
+{
+  m_EventHandlingStatistics.clear();
+  m_NumberOfCoalescedEvents = 0;
+}
+
+bool mitk::Dispatcher::HandleEvent(DataInteractor *dataInteractor, InteractionEvent *event)
+{
+  if (!m_EventHandlingStatisticsEnabled)
+    return dataInteractor->HandleEvent(event, dataInteractor->GetDataNode());
+
+  // The interactor can be deleted during HandleEvent()
+  const std::string name = dataInteractor->GetNameOfClass();
+
+  const auto start = std::chrono::steady_clock::now();
+  const bool eventIsHandled = dataInteractor->HandleEvent(event, dataInteractor->GetDataNode());
+  this->AddEventHandlingTime(name, GetMillisecondsSince(start));
+
+  return eventIsHandled;
+}
+
+void mitk::Dispatcher::AddEventHandlingTime(const std::string &name, double milliseconds)
+{
+  auto &statistics = m_EventHandlingStatistics[name];
+  statistics.Name = name;
+  ++statistics.NumberOfEvents;
+  statistics.TotalMilliseconds += milliseconds;
+  statistics.MaximumMilliseconds = std::max(statistics.MaximumMilliseconds, milliseconds);
+}
+
 /*
  * Checks if DataNodes associated with DataInteractors point back to them.
  * If not remove the DataInteractors. (This can happen when s.o. tries to set DataNodes to multiple DataInteractors)
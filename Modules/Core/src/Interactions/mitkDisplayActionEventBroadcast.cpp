@@ -20,12 +20,11 @@ found in the LICENSE file.
 #include <mitkCompositePixelValueToString.h>
 #include <mitkDisplayActionEvents.h>
 #include <mitkImage.h>
-#include <mitkImagePixelReadAccessor.h>
 #include <mitkInteractionConst.h>
 #include <mitkInteractionPositionEvent.h>
 #include <mitkLine.h>
 #include <mitkNodePredicateDataType.h>
-#include <mitkPixelTypeMultiplex.h>
+#include <mitkRenderingManager.h>
 #include <mitkRotationOperation.h>
 #include <mitkStatusBar.h>
 
@@ -41,6 +40,7 @@ mitk::DisplayActionEventBroadcast::DisplayActionEventBroadcast()
   , m_InvertMoveDirection(false)
   , m_InvertLevelWindowDirection(false)
   , m_LinkPlanes(true)
+  , m_InteractionInProgress(false)
 {
   m_StartCoordinateInMM.Fill(0);
   m_LastDisplayCoordinate.Fill(0);
@@ -56,6 +56,11 @@ mitk::DisplayActionEventBroadcast::DisplayActionEventBroadcast()
 mitk::DisplayActionEventBroadcast::~DisplayActionEventBroadcast()
 {
   m_ServiceRegistration.Unregister();
+
+  if (m_InteractionInProgress)
+  {
+    RenderingManager::GetInstance()->EndInteraction();
+  }
 }
 
 void mitk::DisplayActionEventBroadcast::Notify(InteractionEvent* interactionEvent, bool isHandled)
@@ -74,6 +79,7 @@ void mitk::DisplayActionEventBroadcast::ConnectActionsAndFunctions()
   CONNECT_CONDITION("check_can_swivel", CheckSwivelPossible);
 
   CONNECT_FUNCTION("init", Init);
+  CONNECT_FUNCTION("endInteraction", EndInteraction);
   CONNECT_FUNCTION("move", Move);
   CONNECT_FUNCTION("zoom", Zoom);
   CONNECT_FUNCTION("scroll", Scroll);
@@ -466,6 +472,21 @@ void mitk::DisplayActionEventBroadcast::Init(StateMachineAction* /*stateMachineA
   m_CurrentDisplayCoordinate = m_LastDisplayCoordinate;
   positionEvent->GetSender()->DisplayToPlane(m_LastDisplayCoordinate, m_StartCoordinateInMM);
   m_LastCoordinateInMM = m_StartCoordinateInMM;
+
+  if (!m_InteractionInProgress)
+  {
+    m_InteractionInProgress = true;
+    RenderingManager::GetInstance()->StartInteraction();
+  }
+}
+
+void mitk::DisplayActionEventBroadcast::EndInteraction(StateMachineAction* /*stateMachineAction*/, InteractionEvent* /*interactionEvent*/)
+{
+  if (m_InteractionInProgress)
+  {
+    m_InteractionInProgress = false;
+    RenderingManager::GetInstance()->EndInteraction();
+  }
 }
 
 void mitk::DisplayActionEventBroadcast::Move(StateMachineAction* /*stateMachineAction*/, InteractionEvent* interactionEvent)
@@ -605,6 +626,7 @@ void mitk::DisplayActionEventBroadcast::ScrollOneUp(StateMachineAction* /*stateM
 
   // propagate scroll event with a single slice delta (increase)
   InvokeEvent(DisplayScrollEvent(interactionEvent, sliceDelta));
+  RenderingManager::GetInstance()->NotifyInteractionStep();
 }
 
 void mitk::DisplayActionEventBroadcast::ScrollOneDown(StateMachineAction* /*stateMachineAction*/, InteractionEvent* interactionEvent)
@@ -617,6 +639,7 @@ void mitk::DisplayActionEventBroadcast::ScrollOneDown(StateMachineAction* /*stat
 
   // propagate scroll event with a single slice delta (decrease)
   InvokeEvent(DisplayScrollEvent(interactionEvent, sliceDelta));
+  RenderingManager::GetInstance()->NotifyInteractionStep();
 }
 
 void mitk::DisplayActionEventBroadcast::AdjustLevelWindow(StateMachineAction* /*stateMachineAction*/, InteractionEvent* interactionEvent)
@@ -858,14 +881,14 @@ void mitk::DisplayActionEventBroadcast::UpdateStatusbar(StateMachineAction* /*st
   auto statusBar = StatusBar::GetInstance();
   if (image3D.IsNotNull() && statusBar != nullptr)
   {
-    itk::Index<3> p;
-    image3D->GetGeometry()->WorldToIndex(worldposition, p);
+    const auto lookup = m_PixelValueLookup.Lookup(image3D, worldposition, renderer->GetTime(), component);
+    const auto &p = lookup.Index;
 
     auto pixelType = image3D->GetChannelDescriptor().GetPixelType().GetPixelType();
     if (pixelType == itk::ImageIOBase::RGB || pixelType == itk::ImageIOBase::RGBA)
     {
       std::string pixelValue = "Pixel RGB(A) value: ";
-      pixelValue.append(ConvertCompositePixelValueToString(image3D, p));
+      pixelValue.append(lookup.IsInside ? ConvertCompositePixelValueToString(lookup.Components) : "Out of bounds");
       statusBar->DisplayImageInfo(worldposition, p, renderer->GetTime(), pixelValue.c_str());
     }
     else if (pixelType == itk::ImageIOBase::DIFFUSIONTENSOR3D || pixelType == itk::ImageIOBase::SYMMETRICSECONDRANKTENSOR)
@@ -873,18 +896,13 @@ void mitk::DisplayActionEventBroadcast::UpdateStatusbar(StateMachineAction* /*st
       std::string pixelValue = "See ODF Details view. ";
       statusBar->DisplayImageInfo(worldposition, p, renderer->GetTime(), pixelValue.c_str());
     }
+    else if (lookup.IsInside)
+    {
+      statusBar->DisplayImageInfo(worldposition, p, renderer->GetTime(), lookup.Value);
+    }
     else
     {
-      ScalarType pixelValue;
-      mitkPixelTypeMultiplex5(
-        FastSinglePixelAccess,
-        image3D->GetChannelDescriptor().GetPixelType(),
-        image3D,
-        image3D->GetVolumeData(renderer->GetTimeStep()),
-        p,
-        pixelValue,
-        component);
-      statusBar->DisplayImageInfo(worldposition, p, renderer->GetTime(), pixelValue);
+      statusBar->DisplayImageInfoInvalid();
     }
   }
   else
@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include "mitkCameraController.h"
 #include "mitkInteractionPositionEvent.h"
 #include "mitkPropertyList.h"
+#include "mitkRenderingManager.h"
 #include <mitkAbstractTransformGeometry.h>
 #include <mitkRotationOperation.h>
 #include <cstring>
@@ -30,12 +31,9 @@ found in the LICENSE file.
 // Rotation
 #include "mitkInteractionConst.h"
 #include "rotate_cursor.xpm"
-#include <mitkImagePixelReadAccessor.h>
 #include <mitkRotationOperation.h>
 
 #include "mitkImage.h"
-#include "mitkImagePixelReadAccessor.h"
-#include "mitkPixelTypeMultiplex.h"
 #include "mitkStatusBar.h"
 
 #include <mitkCompositePixelValueToString.h>
@@ -60,6 +58,7 @@ mitk::DisplayInteractor::DisplayInteractor()
   , m_AlwaysReact(false)
   , m_ZoomFactor(2)
   , m_LinkPlanes(true)
+  , m_InteractionInProgress(false)
 {
   m_StartCoordinateInMM.Fill(0);
   m_LastDisplayCoordinate.Fill(0);
@@ -69,7 +68,10 @@ mitk::DisplayInteractor::DisplayInteractor()
 
 mitk::DisplayInteractor::~DisplayInteractor()
 {
-  // nothing here
+  if (m_InteractionInProgress)
+  {
+    RenderingManager::GetInstance()->EndInteraction();
+  }
 }
 
 void mitk::DisplayInteractor::ConnectActionsAndFunctions()
@@ -79,6 +81,7 @@ void mitk::DisplayInteractor::ConnectActionsAndFunctions()
   CONNECT_CONDITION("check_can_swivel", CheckSwivelPossible);
 
   CONNECT_FUNCTION("init", Init);
+  CONNECT_FUNCTION("endInteraction", EndInteraction);
   CONNECT_FUNCTION("move", Move);
   CONNECT_FUNCTION("zoom", Zoom);
   CONNECT_FUNCTION("scroll", Scroll);
@@ -356,6 +359,21 @@ void mitk::DisplayInteractor::Init(StateMachineAction *, InteractionEvent *inter
   m_CurrentDisplayCoordinate = m_LastDisplayCoordinate;
   positionEvent->GetSender()->DisplayToPlane(m_LastDisplayCoordinate, m_StartCoordinateInMM);
   m_LastCoordinateInMM = m_StartCoordinateInMM;
+
+  if (!m_InteractionInProgress)
+  {
+    m_InteractionInProgress = true;
+    RenderingManager::GetInstance()->StartInteraction();
+  }
+}
+
+void mitk::DisplayInteractor::EndInteraction(StateMachineAction *, InteractionEvent *)
+{
+  if (m_InteractionInProgress)
+  {
+    m_InteractionInProgress = false;
+    RenderingManager::GetInstance()->EndInteraction();
+  }
 }
 
 void mitk::DisplayInteractor::Move(StateMachineAction *, InteractionEvent *interactionEvent)
@@ -531,6 +549,7 @@ void mitk::DisplayInteractor::ScrollOneDown(StateMachineAction *, InteractionEve
       stepper = sliceNaviController->GetTime();
     }
     stepper->Next();
+    RenderingManager::GetInstance()->NotifyInteractionStep();
   }
 }
 
@@ -546,6 +565,7 @@ void mitk::DisplayInteractor::ScrollOneUp(StateMachineAction *, InteractionEvent
       stepper = sliceNaviController->GetTime();
     }
     stepper->Previous();
+    RenderingManager::GetInstance()->NotifyInteractionStep();
   }
 }
 
@@ -792,14 +812,14 @@ void mitk::DisplayInteractor::UpdateStatusbar(mitk::StateMachineAction *, mitk::
   auto statusBar = StatusBar::GetInstance();
   if (image3D.IsNotNull() && statusBar != nullptr)
   {
-    itk::Index<3> p;
-    image3D->GetGeometry()->WorldToIndex(worldposition, p);
+    const auto lookup = m_PixelValueLookup.Lookup(image3D, worldposition, globalCurrentTimePoint, component);
+    const auto &p = lookup.Index;
 
     auto pixelType = image3D->GetChannelDescriptor().GetPixelType().GetPixelType();
     if (pixelType == itk::ImageIOBase::RGB || pixelType == itk::ImageIOBase::RGBA)
     {
       std::string pixelValue = "Pixel RGB(A) value: ";
-      pixelValue.append(ConvertCompositePixelValueToString(image3D, p));
+      pixelValue.append(lookup.IsInside ? ConvertCompositePixelValueToString(lookup.Components) : "Out of bounds");
       statusBar->DisplayImageInfo(worldposition, p, globalCurrentTimePoint, pixelValue.c_str());
     }
     else if (pixelType == itk::ImageIOBase::DIFFUSIONTENSOR3D || pixelType == itk::ImageIOBase::SYMMETRICSECONDRANKTENSOR)
@@ -807,17 +827,13 @@ void mitk::DisplayInteractor::UpdateStatusbar(mitk::StateMachineAction *, mitk::
       std::string pixelValue = "See ODF Details view. ";
       statusBar->DisplayImageInfo(worldposition, p, globalCurrentTimePoint, pixelValue.c_str());
     }
+    else if (lookup.IsInside)
+    {
+      statusBar->DisplayImageInfo(worldposition, p, globalCurrentTimePoint, lookup.Value);
+    }
     else
     {
-      mitk::ScalarType pixelValue;
-      mitkPixelTypeMultiplex5(mitk::FastSinglePixelAccess,
-        image3D->GetChannelDescriptor().GetPixelType(),
-        image3D,
-        image3D->GetVolumeData(image3D->GetTimeGeometry()->TimePointToTimeStep(globalCurrentTimePoint)),
-        p,
-        pixelValue,
-        component);
-      statusBar->DisplayImageInfo(worldposition, p, globalCurrentTimePoint, pixelValue);
+      statusBar->DisplayImageInfoInvalid();
     }
   }
   else
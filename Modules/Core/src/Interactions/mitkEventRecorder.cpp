@@ -19,6 +19,8 @@ found in the LICENSE file.
 
 #include "mitkBaseRenderer.h"
 
+#include <sstream>
+
 static void WriteEventXMLHeader(std::ofstream &stream)
 {
   stream << mitk::InteractionEventConst::xmlHead() << "\n";
@@ -124,8 +126,25 @@ mitk::EventRecorder::~EventRecorder()
 
 void mitk::EventRecorder::Notify(mitk::InteractionEvent *interactionEvent, bool /*isHandled*/)
 {
-  if (m_FileStream.is_open())
-    m_FileStream << EventFactory::EventToXML(interactionEvent) << "\n";
+  if (!m_FileStream.is_open())
+    return;
+
+  std::string eventXML = EventFactory::EventToXML(interactionEvent);
+  const std::string closingTag = "</" + InteractionEventConst::xmlTagEventVariant() + ">";
+  const std::size_t closingTagPosition = eventXML.rfind(closingTag);
+
+  if (closingTagPosition != std::string::npos)
+  {
+    const double timestamp =
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_StartTime).count();
+    std::ostringstream timestampXML;
+    timestampXML << " <" << InteractionEventConst::xmlTagAttribute() << " " << InteractionEventConst::xmlParameterName()
+                 << "=\"" << InteractionEventConst::xmlEventPropertyTimestamp() << "\" "
+                 << InteractionEventConst::xmlParameterValue() << "=\"" << timestamp << "\"/>\n";
+    eventXML.insert(closingTagPosition, timestampXML.str());
+  }
+
+  m_FileStream << eventXML << "\n";
 }
 
 void mitk::EventRecorder::SetEventIgnoreList(std::vector<std::string> list)
@@ -155,6 +174,7 @@ void mitk::EventRecorder::StartRecording()
   }
 
   m_Active = true;
+  m_StartTime = std::chrono::steady_clock::now();
 
   // write head and config
   // <?xml version="1.0"?>
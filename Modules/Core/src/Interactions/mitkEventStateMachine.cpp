@@ -20,6 +20,61 @@ found in the LICENSE file.
 #include "mitkStateMachineTransition.h"
 #include "mitkUndoController.h"
 
+#include <map>
+
+#include "usGetModuleContext.h"
+#include "usModule.h"
+
+namespace
+{
+  /**
+   * State machines loaded from the same pattern are shared by all interactors, since the states and transitions
+   * do not depend on the interactor. Each interactor keeps its own current state.
+   */
+  mitk::StateMachineContainer *GetSharedStateMachineContainer(const std::string &filename, const us::Module *module)
+  {
+    // Intentionally leaked, interactors may be destroyed during static destruction
+    static auto containers = new std::map<std::string, mitk::StateMachineContainer *>;
+
+    if (module == nullptr)
+    {
+      module = us::GetModuleContext()->GetModule();
+    }
+
+    const std::string key = module->GetName() + '/' + filename;
+    auto iter = containers->find(key);
+
+    if (iter != containers->end())
+    {
+      iter->second->Register(nullptr);
+      return iter->second;
+    }
+
+    auto container = mitk::StateMachineContainer::New();
+
+    // LoadBehavior() throws if the pattern does not exist
+    try
+    {
+      if (!container->LoadBehavior(filename, module))
+      {
+        container->Delete();
+        return nullptr;
+      }
+    }
+    catch (...)
+    {
+      container->Delete();
+      throw;
+    }
+
+    // One reference for the cache, one for the caller
+    container->Register(nullptr);
+    (*containers)[key] = container;
+
+    return container;
+  }
+}
+
 mitk::EventStateMachine::EventStateMachine()
   : m_IsActive(true),
     m_UndoController(nullptr),
@@ -43,10 +98,11 @@ bool mitk::EventStateMachine::LoadStateMachine(const std::string &filename, cons
   if (m_StateMachineContainer != nullptr)
   {
     m_StateMachineContainer->Delete();
+    m_StateMachineContainer = nullptr;
   }
-  m_StateMachineContainer = StateMachineContainer::New();
+  m_StateMachineContainer = GetSharedStateMachineContainer(filename, module);
 
-  if (m_StateMachineContainer->LoadBehavior(filename, module))
+  if (m_StateMachineContainer != nullptr)
   {
     m_CurrentState = m_StateMachineContainer->GetStartState();
 
@@ -245,7 +301,7 @@ mitk::StateMachineTransition *mitk::EventStateMachine::GetExecutableTransition(m
   std::map<std::string, bool> conditionsMap;
 
   // Get a list of all transitions that match the given event
-  const mitk::StateMachineState::TransitionVector transitionList =
+  const mitk::StateMachineState::TransitionVector &transitionList =
     m_CurrentState->GetTransitionList(event->GetNameOfClass(), MapToEventVariant(event));
 
   // if there are not transitions, we can return nullptr here.
@@ -261,7 +317,7 @@ mitk::StateMachineTransition *mitk::EventStateMachine::GetExecutableTransition(m
     bool allConditionsFulfilled(true);
 
     // Get all conditions for the current transition
-    const ConditionVectorType conditions = (*transitionIter)->GetConditions();
+    const ConditionVectorType &conditions = (*transitionIter)->GetConditions();
     for (conditionIter = conditions.cbegin(); conditionIter != conditions.cend(); ++conditionIter)
     {
       bool currentConditionFulfilled(false);
@@ -320,7 +376,10 @@ mitk::StateMachineTransition *mitk::EventStateMachine::GetExecutableTransition(m
 
 void mitk::EventStateMachine::ResetToStartState()
 {
-  m_CurrentState = m_StateMachineContainer->GetStartState();
+  if (m_StateMachineContainer != nullptr)
+  {
+    m_CurrentState = m_StateMachineContainer->GetStartState();
+  }
 }
 
 void mitk::EventStateMachine::SetMouseCursor(const char *xpm[], int hotspotX, int hotspotY)
@@ -158,6 +158,12 @@ namespace mitk
     return xmlEventPropertyMapperID;
   }
 
+  const std::string InteractionEventConst::xmlEventPropertyTimestamp()
+  {
+    static const std::string xmlEventPropertyTimestamp = "Timestamp";
+    return xmlEventPropertyTimestamp;
+  }
+
   const std::string mitk::InteractionEventConst::xmlRenderSizeX()
   {
     static const std::string xmlSize = "RenderSizeX";
@@ -508,21 +508,12 @@ int mitk::PointSetDataInteractor::GetPointIndexByPosition(Point3D position, unsi
   if (points->GetPointSet(time) == nullptr)
     return -1;
 
-  PointSet::PointsContainer *pointsContainer = points->GetPointSet(time)->GetPoints();
-
   float minDistance = m_SelectionAccuracy;
   if (accuracy != -1)
     minDistance = accuracy;
 
-  for (PointSet::PointsIterator it = pointsContainer->Begin(); it != pointsContainer->End(); it++)
-  {
-    float distance = sqrt(position.SquaredEuclideanDistanceTo(points->GetPoint(it->Index(), time)));
-    if (distance <
-        minDistance) // if several points fall within the margin, choose the one with minimal distance to position
-    {
-      index = it->Index();
-    }
-  }
+  // if several points fall within the margin, choose the one with minimal distance to position
+  index = points->SearchClosestPoint(position, minDistance, time);
   return index;
 }
 
@@ -35,13 +35,14 @@ bool mitk::StateMachineState::AddTransition(StateMachineTransition::Pointer tran
       return false;
   }
   m_Transitions.push_back(transition);
+  m_TransitionTable.clear();
   return true;
 }
 
 mitk::StateMachineTransition::Pointer mitk::StateMachineState::GetTransition(const std::string &eventClass,
                                                                              const std::string &eventVariant)
 {
-  TransitionVector transitions = this->GetTransitionList(eventClass, eventVariant);
+  const TransitionVector &transitions = this->GetTransitionList(eventClass, eventVariant);
 
   if (transitions.size() > 1)
   {
@@ -59,10 +60,17 @@ mitk::StateMachineTransition::Pointer mitk::StateMachineState::GetTransition(con
   }
 }
 
-mitk::StateMachineState::TransitionVector mitk::StateMachineState::GetTransitionList(const std::string &eventClass,
-                                                                                     const std::string &eventVariant)
+const mitk::StateMachineState::TransitionVector &mitk::StateMachineState::GetTransitionList(
+  const std::string &eventClass, const std::string &eventVariant)
 {
-  TransitionVector transitions;
+  auto key = std::make_pair(eventClass, eventVariant);
+  auto entry = m_TransitionTable.find(key);
+
+  if (entry != m_TransitionTable.end())
+    return entry->second;
+
+  // The comparison creates events by class name, so it is done only once per event description
+  TransitionVector &transitions = m_TransitionTable[key];
   mitk::StateMachineTransition::Pointer t = mitk::StateMachineTransition::New("", eventClass, eventVariant);
   for (auto it = m_Transitions.begin(); it != m_Transitions.end(); ++it)
   {
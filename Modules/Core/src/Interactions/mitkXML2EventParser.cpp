@@ -21,6 +21,8 @@ found in the LICENSE file.
 // VTK
 #include <vtkXMLDataElement.h>
 
+#include <cstdlib>
+
 // us
 #include "usGetModuleContext.h"
 #include "usModule.h"
@@ -68,6 +70,12 @@ namespace mitk
       if (event.IsNotNull())
       {
         m_InteractionList.push_back(event);
+
+        std::string timestamp;
+        m_Timestamps.push_back(
+          m_EventPropertyList->GetStringProperty(InteractionEventConst::xmlEventPropertyTimestamp().c_str(), timestamp)
+            ? std::atof(timestamp.c_str())
+            : -1.0);
       }
       else
       {
@@ -63,10 +63,15 @@ namespace mitk
     BaseRenderer *renderer = GetCurrentBaseRenderer();
     if (renderer)
     {
+      RenderingProfiler *profiler = renderer->GetRenderingProfiler();
+      const bool profiling = profiler->GetEnabled();
+      const double start = profiling ? profiler->GetTime() : 0.0;
       for (Annotation *o : this->GetServices())
       {
         o->Update(renderer);
       }
+      if (profiling)
+        profiler->AddAnnotationTime(profiler->GetTime() - start);
     }
   }
   const std::string AbstractAnnotationRenderer::GetID() const { return m_ID; }
@@ -87,11 +92,16 @@ namespace mitk
                                                    AbstractAnnotationRenderer::TrackedType tracked)
   {
     BaseRenderer *renderer = GetCurrentBaseRenderer();
+    RenderingProfiler *profiler = renderer ? renderer->GetRenderingProfiler() : nullptr;
+    const bool profiling = profiler && profiler->GetEnabled();
+    const double start = profiling ? profiler->GetTime() : 0.0;
     if (tracked && renderer)
     {
       tracked->Update(renderer);
     }
     OnAnnotationRenderersChanged();
+    if (profiling)
+      profiler->AddAnnotationTime(profiler->GetTime() - start);
   }
 
   void AbstractAnnotationRenderer::RemovedService(const AbstractAnnotationRenderer::ServiceReferenceType &,
@@ -85,8 +85,14 @@ namespace mitk
 
     if (nullptr != renderer)
     {
+      // layout of the annotations, e.g. after a resize
+      RenderingProfiler *profiler = renderer->GetRenderingProfiler();
+      const bool profiling = profiler->GetEnabled();
+      const double start = profiling ? profiler->GetTime() : 0.0;
       for (AbstractAnnotationRenderer *annotationRenderer : GetAnnotationRenderer(renderer->GetName()))
         annotationRenderer->OnRenderWindowModified();
+      if (profiling)
+        profiler->AddAnnotationTime(profiler->GetTime() - start);
     }
   }
 
@@ -112,7 +112,8 @@ mitk::BaseRenderer::BaseRenderer(const char *name,
     m_CurrentWorldPlaneGeometryTransformTime(0),
     m_Name(name),
     m_EmptyWorldGeometry(true),
-    m_NumberOfVisibleLODEnabledMappers(0)
+    m_NumberOfVisibleLODEnabledMappers(0),
+    m_RenderingProfiler(RenderingProfiler::New())
 {
   m_Bounds[0] = 0;
   m_Bounds[1] = 0;
@@ -159,6 +160,8 @@ mitk::BaseRenderer::BaseRenderer(const char *name,
 
   m_CurrentWorldPlaneGeometryNode->SetProperty("reslice.thickslices", mitk::ResliceMethodProperty::New());
   m_CurrentWorldPlaneGeometryNode->SetProperty("reslice.thickslices.num", mitk::IntProperty::New(1));
+  // slab thickness in mm, overrides "reslice.thickslices.num" if positive
+  m_CurrentWorldPlaneGeometryNode->SetProperty("reslice.thickslices.thickness", mitk::FloatProperty::New(0.0f));
 
   m_CurrentWorldPlaneGeometryTransformTime = m_CurrentWorldPlaneGeometryNode->GetVtkTransform()->GetMTime();
 
@@ -561,6 +564,11 @@ unsigned int mitk::BaseRenderer::GetNumberOfVisibleLODEnabledMappers() const
   return m_NumberOfVisibleLODEnabledMappers;
 }
 
+mitk::RenderingProfiler *mitk::BaseRenderer::GetRenderingProfiler() const
+{
+  return m_RenderingProfiler;
+}
+
 /*!
  Sets the new Navigation controller
  */
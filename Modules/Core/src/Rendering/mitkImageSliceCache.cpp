@@ -0,0 +1,187 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkImageSliceCache.h"
+
+#include <mitkPlaneGeometry.h>
+
+#include <functional>
+
+namespace
+{
+  template <typename T>
+  void HashCombine(std::size_t &seed, const T &value)
+  {
+    seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  }
+}
+
+mitk::ImageSliceCache::Key::Key()
+  : ReferenceGeometry(nullptr),
+    ReferenceGeometryMTime(0),
+    TimeStep(0),
+    InterpolationMode(0),
+    ThickSlicesMode(0),
+    ThickSlicesNum(1),
+    InPlaneResampleExtentByGeometry(false)
+{
+  Transform.fill(0.0);
+  Bounds.fill(0.0);
+}
+
+void mitk::ImageSliceCache::Key::SetPlaneGeometry(const PlaneGeometry *geometry)
+{
+  const AffineTransform3D *transform = geometry->GetIndexToWorldTransform();
+  const AffineTransform3D::MatrixType &matrix = transform->GetMatrix();
+  const AffineTransform3D::OutputVectorType &offset = transform->GetOffset();
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    for (unsigned int j = 0; j < 3; ++j)
+      Transform[3 * i + j] = matrix[i][j];
+    Transform[9 + i] = offset[i];
+  }
+
+  const BaseGeometry::BoundsArrayType bounds = geometry->GetBounds();
+  for (unsigned int i = 0; i < 6; ++i)
+    Bounds[i] = bounds[i];
+
+  const BaseGeometry *referenceGeometry = geometry->GetReferenceGeometry();
+  ReferenceGeometry = referenceGeometry;
+  ReferenceGeometryMTime = referenceGeometry != nullptr ? referenceGeometry->GetMTime() : 0;
+}
+
+std::size_t mitk::ImageSliceCache::Key::GetHash() const
+{
+  std::size_t hash = 0;
+  for (double value : Transform)
+    HashCombine(hash, value);
+  for (double value : Bounds)
+    HashCombine(hash, value);
+  HashCombine(hash, ReferenceGeometry);
+  HashCombine(hash, ReferenceGeometryMTime);
+  HashCombine(hash, TimeStep);
+  HashCombine(hash, InterpolationMode);
+  HashCombine(hash, ThickSlicesMode);
+  HashCombine(hash, ThickSlicesNum);
+  HashCombine(hash, InPlaneResampleExtentByGeometry);
+  return hash;
+}
+
+bool mitk::ImageSliceCache::Key::operator==(const Key &other) const
+{
+  return Transform == other.Transform && Bounds == other.Bounds && ReferenceGeometry == other.ReferenceGeometry &&
+         ReferenceGeometryMTime == other.ReferenceGeometryMTime && TimeStep == other.TimeStep &&
+         InterpolationMode == other.InterpolationMode && ThickSlicesMode == other.ThickSlicesMode &&
+         ThickSlicesNum == other.ThickSlicesNum &&
+         InPlaneResampleExtentByGeometry == other.InPlaneResampleExtentByGeometry;
+}
+
+mitk::ImageSliceCache::ImageSliceCache(std::size_t capacity) : m_Capacity(capacity), m_ImageTime(0)
+{
+}
+
+const mitk::ImageSliceCache::Slice *mitk::ImageSliceCache::Find(const Key &key, unsigned long imageTime)
+{
+  this->CheckImageTime(imageTime);
+
+  const std::size_t hash = key.GetHash();
+  for (auto it = m_Entries.begin(); it != m_Entries.end(); ++it)
+  {
+    if (it->m_Hash == hash && it->m_Key == key)
+    {
+      // move to the front, the least recently used slice is dropped first
+      m_Entries.splice(m_Entries.begin(), m_Entries, it);
+      return &m_Entries.front().m_Slice;
+    }
+  }
+  return nullptr;
+}
+
+void mitk::ImageSliceCache::Insert(
+  const Key &key, unsigned long imageTime, vtkImageData *image, const ScalarType spacing[2], vtkMatrix4x4 *resliceAxes)
+{
+  if (m_Capacity == 0 || image == nullptr || resliceAxes == nullptr)
+  {
+    this->CheckImageTime(imageTime);
+    return;
+  }
+
+  Slice slice;
+  slice.Image = vtkSmartPointer<vtkImageData>::New();
+  slice.Image->DeepCopy(image);
+  slice.Spacing[0] = spacing[0];
+  slice.Spacing[1] = spacing[1];
+  slice.ResliceAxes = vtkSmartPointer<vtkMatrix4x4>::New();
+  slice.ResliceAxes->DeepCopy(resliceAxes);
+  this->Insert(key, imageTime, slice);
+}
+
+void mitk::ImageSliceCache::Insert(const Key &key, unsigned long imageTime, const Slice &slice)
+{
+  this->CheckImageTime(imageTime);
+  if (m_Capacity == 0 || slice.Image == nullptr || slice.ResliceAxes == nullptr)
+    return;
+
+  const std::size_t hash = key.GetHash();
+  m_Entries.remove_if([&](const Entry &entry) { return entry.m_Hash == hash && entry.m_Key == key; });
+  while (m_Entries.size() >= m_Capacity)
+    m_Entries.pop_back();
+
+  Entry entry;
+  entry.m_Key = key;
+  entry.m_Hash = hash;
+  entry.m_Slice = slice;
+  m_Entries.push_front(entry);
+}
+
+bool mitk::ImageSliceCache::Contains(const Key &key, unsigned long imageTime) const
+{
+  if (imageTime != m_ImageTime)
+    return false;
+
+  const std::size_t hash = key.GetHash();
+  for (const auto &entry : m_Entries)
+  {
+    if (entry.m_Hash == hash && entry.m_Key == key)
+      return true;
+  }
+  return false;
+}
+
+std::size_t mitk::ImageSliceCache::GetMemorySize() const
+{
+  std::size_t size = 0;
+  for (const auto &entry : m_Entries)
+    size += static_cast<std::size_t>(entry.m_Slice.Image->GetActualMemorySize()) * 1024;
+  return size;
+}
+
+void mitk::ImageSliceCache::Clear()
+{
+  m_Entries.clear();
+}
+
+void mitk::ImageSliceCache::SetCapacity(std::size_t capacity)
+{
+  m_Capacity = capacity;
+  while (m_Entries.size() > m_Capacity)
+    m_Entries.pop_back();
+}
+
+void mitk::ImageSliceCache::CheckImageTime(unsigned long imageTime)
+{
+  if (imageTime != m_ImageTime)
+  {
+    this->Clear();
+    m_ImageTime = imageTime;
+  }
+}
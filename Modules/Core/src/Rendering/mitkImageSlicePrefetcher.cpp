@@ -0,0 +1,211 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkImageSlicePrefetcher.h"
+
+#include <mitkImageReadAccessor.h>
+
+#include <algorithm>
+
+mitk::ImageSlicePrefetcher::ImageSlicePrefetcher() : m_Running(false), m_Stop(false)
+{
+}
+
+mitk::ImageSlicePrefetcher::~ImageSlicePrefetcher()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Jobs.clear();
+    m_Stop = true;
+  }
+  m_Condition.notify_one();
+  if (m_Thread.joinable())
+    m_Thread.join();
+}
+
+void mitk::ImageSlicePrefetcher::Prefetch(const Image *image,
+                                          TimeStepType t,
+                                          unsigned long imageTime,
+                                          ExtractSliceFilter::ResliceInterpolation interpolation,
+                                          bool inPlaneResampleExtentByGeometry,
+                                          const std::vector<Request> &requests)
+{
+  if (image == nullptr || requests.empty() || !image->IsValidTimeStep(t))
+    return;
+
+  auto batch = std::make_shared<Batch>();
+  batch->m_Image = image;
+  batch->m_Volume = image->GetVolumeData(t);
+  if (batch->m_Volume.IsNull())
+    return;
+  batch->m_Geometry = image->GetTimeGeometry()->GetGeometryForTimeStep(t)->Clone();
+  batch->m_ImageTime = imageTime;
+  batch->m_Interpolation = interpolation;
+  batch->m_InPlaneResampleExtentByGeometry = inPlaneResampleExtentByGeometry;
+
+  std::deque<Job> jobs;
+  for (const auto &request : requests)
+  {
+    if (request.Geometry.IsNull())
+      continue;
+
+    Job job;
+    job.m_Batch = batch;
+    job.m_Key = request.Key;
+    job.m_Geometry = request.Geometry->Clone();
+    if (request.Geometry->GetReferenceGeometry() != nullptr)
+    {
+      job.m_ReferenceGeometry = request.Geometry->GetReferenceGeometry()->Clone();
+      job.m_Geometry->SetReferenceGeometry(job.m_ReferenceGeometry);
+    }
+    jobs.push_back(job);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Jobs.swap(jobs);
+    if (!m_Thread.joinable())
+      m_Thread = std::thread(&ImageSlicePrefetcher::Run, this);
+  }
+  m_Condition.notify_one();
+  // the dropped jobs are released here, outside of the lock
+}
+
+void mitk::ImageSlicePrefetcher::Cancel()
+{
+  std::deque<Job> jobs;
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Jobs.swap(jobs);
+}
+
+void mitk::ImageSlicePrefetcher::TransferSlices(ImageSliceCache &cache, unsigned long imageTime)
+{
+  std::vector<Result> results;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    results.swap(m_Results);
+  }
+
+  for (const auto &result : results)
+  {
+    if (result.m_ImageTime == imageTime)
+      cache.Insert(result.m_Key, imageTime, result.m_Slice);
+  }
+}
+
+bool mitk::ImageSlicePrefetcher::IsBusy()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Running || !m_Jobs.empty();
+}
+
+void mitk::ImageSlicePrefetcher::Run()
+{
+  std::shared_ptr<Batch> proxyBatch;
+  Image::Pointer proxy;
+
+  for (;;)
+  {
+    bool idle = false;
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Running = false;
+      idle = m_Jobs.empty();
+    }
+    if (idle)
+    {
+      // do not keep the image alive while there is nothing to do
+      proxy = nullptr;
+      proxyBatch = nullptr;
+    }
+
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_Condition.wait(lock, [this]() { return m_Stop || !m_Jobs.empty(); });
+      if (m_Stop)
+        return;
+      job = m_Jobs.front();
+      m_Jobs.pop_front();
+      m_Running = true;
+    }
+
+    if (job.m_Batch != proxyBatch)
+    {
+      proxy = CreateProxy(*job.m_Batch);
+      proxyBatch = job.m_Batch;
+    }
+
+    Result result;
+    if (proxy.IsNotNull() && Reslice(job, proxy, result.m_Slice))
+    {
+      result.m_Key = job.m_Key;
+      result.m_ImageTime = job.m_Batch->m_ImageTime;
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Results.push_back(result);
+    }
+  }
+}
+
+mitk::Image::Pointer mitk::ImageSlicePrefetcher::CreateProxy(const Batch &batch)
+{
+  try
+  {
+    ImageReadAccessor accessor(batch.m_Image, batch.m_Volume);
+
+    auto proxy = Image::New();
+    proxy->Initialize(batch.m_Image->GetPixelType(), *batch.m_Geometry);
+    proxy->SetImportVolume(const_cast<void *>(accessor.GetData()), 0, 0, Image::ReferenceMemory);
+    return proxy;
+  }
+  catch (const itk::ExceptionObject &e)
+  {
+    MITK_WARN << "Slice prefetching not possible: " << e.GetDescription();
+    return nullptr;
+  }
+}
+
+bool mitk::ImageSlicePrefetcher::Reslice(const Job &job, Image *proxy, ImageSliceCache::Slice &slice)
+{
+  try
+  {
+    // keeps writers away from the volume referenced by the proxy
+    ImageReadAccessor accessor(job.m_Batch->m_Image, job.m_Batch->m_Volume);
+
+    auto reslicer = ExtractSliceFilter::New();
+    reslicer->SetInput(proxy);
+    reslicer->SetWorldGeometry(job.m_Geometry);
+    reslicer->SetTimeStep(0);
+    reslicer->SetResliceTransformByGeometry(job.m_Batch->m_Geometry);
+    reslicer->SetInPlaneResampleExtentByGeometry(job.m_Batch->m_InPlaneResampleExtentByGeometry);
+    reslicer->SetInterpolationMode(job.m_Batch->m_Interpolation);
+    reslicer->SetVtkOutputRequest(true);
+    reslicer->UpdateLargestPossibleRegion();
+
+    vtkImageData *output = reslicer->GetVtkOutput();
+    if (output == nullptr)
+      return false;
+
+    slice.Image = vtkSmartPointer<vtkImageData>::New();
+    slice.Image->DeepCopy(output);
+    const ScalarType *spacing = reslicer->GetOutputSpacing();
+    std::copy(spacing, spacing + 2, slice.Spacing);
+    slice.ResliceAxes = vtkSmartPointer<vtkMatrix4x4>::New();
+    slice.ResliceAxes->DeepCopy(reslicer->GetResliceAxes());
+    return true;
+  }
+  catch (const itk::ExceptionObject &e)
+  {
+    MITK_WARN << "Prefetching of a slice failed: " << e.GetDescription();
+    return false;
+  }
+}
@@ -20,6 +20,7 @@ found in the LICENSE file.
 #include <mitkPlaneGeometry.h>
 #include <mitkProperties.h>
 #include <mitkPropertyNameHelper.h>
+#include <mitkRenderingManager.h>
 #include <mitkResliceMethodProperty.h>
 #include <mitkVtkResliceInterpolationProperty.h>
 
@@ -31,6 +32,7 @@ found in the LICENSE file.
 // MITK Rendering
 #include "mitkImageVtkMapper2D.h"
 #include "vtkMitkLevelWindowFilter.h"
+#include "vtkMitkLevelWindowShaderMapper.h"
 #include "vtkMitkThickSlicesFilter.h"
 #include "vtkNeverTranslucentTexture.h"
 
@@ -55,12 +57,104 @@ found in the LICENSE file.
 #include <itkRGBAPixel.h>
 #include <mitkRenderingModeProperty.h>
 
+#include <algorithm>
+#include <set>
+
+namespace
+{
+  /** In-plane downsampling of the slice while the user interacts (see RenderingManager::StartInteraction()),
+    1 if the slice is to be rendered at full quality */
+  unsigned int GetInteractionDownsamplingFactor()
+  {
+    mitk::RenderingManager *renderingManager = mitk::RenderingManager::GetInstance();
+    if (renderingManager == nullptr || !renderingManager->IsInteractionInProgress())
+      return 1;
+
+    auto *enabled =
+      dynamic_cast<mitk::BoolProperty *>(renderingManager->GetProperty("interaction-LOD-slice-rendering"));
+    if (enabled == nullptr || !enabled->GetValue())
+      return 1;
+
+    auto *factor = dynamic_cast<mitk::IntProperty *>(renderingManager->GetProperty("interaction-LOD-downsampling"));
+    return factor != nullptr ? static_cast<unsigned int>(std::max(1, factor->GetValue())) : 2;
+  }
+
+  /** Number of slices to reslice in advance in the scroll direction (see ImageSlicePrefetcher), 0 if disabled */
+  int GetSlicePrefetchCount()
+  {
+    mitk::RenderingManager *renderingManager = mitk::RenderingManager::GetInstance();
+    if (renderingManager == nullptr)
+      return 0;
+
+    auto *count = dynamic_cast<mitk::IntProperty *>(renderingManager->GetProperty("slice-prefetching"));
+    return count != nullptr ? std::max(0, count->GetValue()) : 0;
+  }
+
+  mitk::ExtractSliceFilter::ResliceInterpolation ToResliceInterpolation(int vtkInterpolationMode)
+  {
+    switch (vtkInterpolationMode)
+    {
+      case VTK_RESLICE_LINEAR:
+        return mitk::ExtractSliceFilter::RESLICE_LINEAR;
+      case VTK_RESLICE_CUBIC:
+        return mitk::ExtractSliceFilter::RESLICE_CUBIC;
+      default:
+        return mitk::ExtractSliceFilter::RESLICE_NEAREST;
+    }
+  }
+
+  /** True if level window and lookup table are to be applied on the GPU (see vtkMitkLevelWindowShaderMapper) */
+  bool IsShaderLevelWindowEnabled()
+  {
+    mitk::RenderingManager *renderingManager = mitk::RenderingManager::GetInstance();
+    if (renderingManager == nullptr)
+      return false;
+
+    auto *enabled = dynamic_cast<mitk::BoolProperty *>(renderingManager->GetProperty("shader-level-window-rendering"));
+    return enabled != nullptr && enabled->GetValue();
+  }
+
+  /** Properties that are applied by the shader without reslicing, see ImageVtkMapper2D::UpdateShaderLevelWindow() */
+  bool IsShaderLevelWindowProperty(const std::string &name)
+  {
+    static const std::set<std::string> names = {"levelwindow",
+                                                "opaclevelwindow",
+                                                "LookupTable",
+                                                "color",
+                                                "opacity",
+                                                "selected",
+                                                "binaryimage.ishovering",
+                                                "binaryimage.hoveringcolor",
+                                                "binaryimage.selectedcolor"};
+    return names.count(name) > 0;
+  }
+
+  /** Checks the properties of @a list modified after @a time: false if one of them is not applied by the shader */
+  bool OnlyShaderLevelWindowPropertiesModified(const mitk::PropertyList *list,
+                                               itk::ModifiedTimeType time,
+                                               bool &modified)
+  {
+    for (const auto &property : *list->GetMap())
+    {
+      if (property.second.IsNotNull() && property.second->GetMTime() > time)
+      {
+        if (!IsShaderLevelWindowProperty(property.first))
+          return false;
+        modified = true;
+      }
+    }
+    return true;
+  }
+}
+
 mitk::ImageVtkMapper2D::ImageVtkMapper2D()
 {
 }
 
 mitk::ImageVtkMapper2D::~ImageVtkMapper2D()
 {
+  MemoryAccounting::GetInstance().UnregisterCache(this);
+
   // The 3D RW Mapper (PlaneGeometryDataVtkMapper3D) is listening to this event,
   // in order to delete the images from the 3D RW.
   this->InvokeEvent(itk::DeleteEvent());
@@ -141,6 +235,7 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
     // see bug-13275
     localStorage->m_ReslicedImage = nullptr;
     localStorage->m_Mapper->SetInputData(localStorage->m_EmptyPolyData);
+    localStorage->m_Actor->SetMapper(localStorage->m_Mapper);
     return;
   }
 
@@ -158,37 +253,28 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
   datanode->GetBoolProperty("in plane resample extent by geometry", inPlaneResampleExtentByGeometry, renderer);
   localStorage->m_Reslicer->SetInPlaneResampleExtentByGeometry(inPlaneResampleExtentByGeometry);
 
+  // during interactions, a coarse nearest neighbor slice is sufficient; Update() triggers
+  // the full quality pass when the interaction ends
+  const unsigned int downsamplingFactor = GetInteractionDownsamplingFactor();
+  localStorage->m_Reslicer->SetInPlaneDownsamplingFactor(downsamplingFactor);
+
   // Initialize the interpolation mode for resampling; switch to nearest
   // neighbor if the input image is too small.
+  int interpolationMode = VTK_RESLICE_NEAREST;
   if ((image->GetDimension() >= 3) && (image->GetDimension(2) > 1))
   {
     VtkResliceInterpolationProperty *resliceInterpolationProperty;
     datanode->GetProperty(resliceInterpolationProperty, "reslice interpolation", renderer);
 
-    int interpolationMode = VTK_RESLICE_NEAREST;
     if (resliceInterpolationProperty != nullptr)
     {
       interpolationMode = resliceInterpolationProperty->GetInterpolation();
     }
-
-    switch (interpolationMode)
-    {
-      case VTK_RESLICE_NEAREST:
-        localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
-        break;
-      case VTK_RESLICE_LINEAR:
-        localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_LINEAR);
-        break;
-      case VTK_RESLICE_CUBIC:
-        localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_CUBIC);
-        break;
-    }
-  }
-  else
-  {
-    localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
   }
 
+  localStorage->m_Reslicer->SetInterpolationMode(
+    ToResliceInterpolation(downsamplingFactor == 1 ? interpolationMode : VTK_RESLICE_NEAREST));
+
   // set the vtk output property to true, makes sure that no unneeded mitk image convertion
   // is done.
   localStorage->m_Reslicer->SetVtkOutputRequest(true);
@@ -196,6 +282,7 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
   // Thickslicing
   int thickSlicesMode = 0;
   int thickSlicesNum = 1;
+  float thickSlicesThickness = 0.0f;
   // Thick slices parameters
   if (image->GetPixelType().GetNumberOfComponents() == 1) // for now only single component are allowed
   {
@@ -214,6 +301,10 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
         if (thickSlicesNum < 1)
           thickSlicesNum = 1;
       }
+
+      FloatProperty *thicknessProperty = nullptr;
+      if (dn->GetProperty(thicknessProperty, "reslice.thickslices.thickness", renderer) && thicknessProperty)
+        thickSlicesThickness = thicknessProperty->GetValue();
     }
     else
     {
@@ -223,10 +314,9 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
 
   const auto *planeGeometry = dynamic_cast<const PlaneGeometry *>(worldGeometry);
 
+  double dataZSpacing = 1.0;
   if (thickSlicesMode > 0)
   {
-    double dataZSpacing = 1.0;
-
     Vector3D normInIndex, normal;
 
     const auto *abstractGeometry =
@@ -248,6 +338,44 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
 
     dataZSpacing = 1.0 / normInIndex.GetNorm();
 
+    // a slab thickness in mm takes precedence over the number of slices
+    if (thickSlicesThickness > 0.0f)
+    {
+      thickSlicesNum = std::max(1, static_cast<int>(0.5 * (thickSlicesThickness / dataZSpacing - 1.0) + 0.5));
+    }
+  }
+
+  // Slices of plane geometries are cached in full quality, so that returning to a slice (e.g. when
+  // scrolling back and forth) or to the image after an interaction does not reslice again.
+  // Downsampled slices are never stored.
+  ImageSliceCache::Key cacheKey;
+  const ImageSliceCache::Slice *cachedSlice = nullptr;
+  const bool cacheSlice =
+    planeGeometry != nullptr && dynamic_cast<const AbstractTransformGeometry *>(worldGeometry) == nullptr;
+  const BaseGeometry::Pointer imageGeometry = image->GetTimeGeometry()->GetGeometryForTimeStep(this->GetTimestep());
+  const unsigned long imageTime =
+    std::max({image->GetMTime(), image->GetTimeGeometry()->GetMTime(), imageGeometry->GetMTime()});
+  if (cacheSlice)
+  {
+    cacheKey.SetPlaneGeometry(planeGeometry);
+    cacheKey.TimeStep = this->GetTimestep();
+    cacheKey.InterpolationMode = interpolationMode;
+    cacheKey.ThickSlicesMode = thickSlicesMode;
+    cacheKey.ThickSlicesNum = thickSlicesMode > 0 ? thickSlicesNum : 1;
+    cacheKey.InPlaneResampleExtentByGeometry = inPlaneResampleExtentByGeometry;
+    m_SlicePrefetcher.TransferSlices(m_SliceCache, imageTime);
+    cachedSlice = m_SliceCache.Find(cacheKey, imageTime);
+    MemoryAccounting::GetInstance().RegisterCache(this, MemoryAccounting::ResliceCacheType, image);
+  }
+
+  if (cachedSlice != nullptr)
+  {
+    localStorage->m_ReslicedImage = cachedSlice->Image;
+    std::copy(cachedSlice->Spacing, cachedSlice->Spacing + 2, localStorage->m_SliceSpacing);
+    localStorage->m_ResliceAxes->DeepCopy(cachedSlice->ResliceAxes);
+  }
+  else if (thickSlicesMode > 0)
+  {
     localStorage->m_Reslicer->SetOutputDimensionality(3);
     localStorage->m_Reslicer->SetOutputSpacingZDirection(dataZSpacing);
     localStorage->m_Reslicer->SetOutputExtentZDirection(-thickSlicesNum, 0 + thickSlicesNum);
@@ -279,6 +407,29 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
     localStorage->m_ReslicedImage = localStorage->m_Reslicer->GetVtkOutput();
   }
 
+  if (cachedSlice == nullptr)
+  {
+    // get the spacing and the axes of the slice
+    const mitk::ScalarType *spacing = localStorage->m_Reslicer->GetOutputSpacing();
+    std::copy(spacing, spacing + 2, localStorage->m_SliceSpacing);
+    localStorage->m_ResliceAxes->DeepCopy(localStorage->m_Reslicer->GetResliceAxes());
+
+    if (cacheSlice && downsamplingFactor == 1)
+    {
+      m_SliceCache.Insert(cacheKey,
+                          imageTime,
+                          localStorage->m_ReslicedImage,
+                          localStorage->m_SliceSpacing,
+                          localStorage->m_ResliceAxes);
+    }
+  }
+  localStorage->m_mmPerPixel = localStorage->m_SliceSpacing;
+
+  if (cacheSlice)
+  {
+    this->PrefetchNeighboringSlices(renderer, cacheKey, imageTime);
+  }
+
   // Bounds information for reslicing (only reuqired if reference geometry
   // is present)
   // this used for generating a vtkPLaneSource with the right size
@@ -289,9 +440,6 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
   }
   localStorage->m_Reslicer->GetClippedPlaneBounds(sliceBounds);
 
-  // get the spacing of the slice
-  localStorage->m_mmPerPixel = localStorage->m_Reslicer->GetOutputSpacing();
-
   // calculate minimum bounding rect of IMAGE in texture
   {
     double textureClippingBounds[6];
@@ -311,18 +459,31 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
 
     // clipping bounds for cutting the image
     localStorage->m_LevelWindowFilter->SetClippingBounds(textureClippingBounds);
+    localStorage->m_ShaderMapper->SetClippingBounds(textureClippingBounds);
   }
 
   // get the number of scalar components to distinguish between different image types
   int numberOfComponents = localStorage->m_ReslicedImage->GetNumberOfScalarComponents();
+  // the lookup table is checked below, the one of binary images is always supported
+  bool shaderLevelWindow =
+    IsShaderLevelWindowEnabled() && vtkMitkLevelWindowShaderMapper::IsSliceSupported(localStorage->m_ReslicedImage);
   // get the binary property
   bool binary = false;
   bool binaryOutline = false;
+  bool binaryOutlineShadow = false;
+  float binaryOutlineWidth = 1.0;
   datanode->GetBoolProperty("binary", binary, renderer);
   if (binary) // binary image
   {
     datanode->GetBoolProperty("outline binary", binaryOutline, renderer);
-    if (binaryOutline) // contour rendering
+    datanode->GetBoolProperty("outline binary shadow", binaryOutlineShadow, renderer);
+    // the shader draws the outline, but no shadow
+    shaderLevelWindow = shaderLevelWindow && !(binaryOutline && binaryOutlineShadow);
+    if (binaryOutline && shaderLevelWindow)
+    {
+      datanode->GetFloatProperty("outline width", binaryOutlineWidth, renderer);
+    }
+    else if (binaryOutline) // contour rendering
     {
       // get pixel type of vtk image
       itk::ImageIOBase::IOComponentType componentType = static_cast<itk::ImageIOBase::IOComponentType>(image->GetPixelType().GetComponentType());
@@ -343,7 +504,6 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
       }
       if (binaryOutline) // binary outline is still true --> add outline
       {
-        float binaryOutlineWidth = 1.0;
         if (datanode->GetFloatProperty("outline width", binaryOutlineWidth, renderer))
         {
           if (localStorage->m_Actors->GetNumberOfPaths() > 1)
@@ -370,6 +530,8 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
 
   this->ApplyOpacity(renderer);
   this->ApplyRenderingMode(renderer);
+  shaderLevelWindow = shaderLevelWindow && vtkMitkLevelWindowShaderMapper::IsLookupTableSupported(
+                                             localStorage->m_LevelWindowFilter->GetLookupTable());
 
   // do not use a VTK lookup table (we do that ourselves in m_LevelWindowFilter)
   localStorage->m_Texture->SetColorModeToDirectScalars();
@@ -403,14 +565,27 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
 
   auto *contourShadowActor = dynamic_cast<vtkActor *>(localStorage->m_Actors->GetParts()->GetItemAsObject(0));
 
-  if (binary && binaryOutline) // connect the mapper with the polyData which contains the lines
+  if (shaderLevelWindow) // level window, lookup table and outline are applied on the GPU
+  {
+    this->GeneratePlane(renderer, sliceBounds);
+    localStorage->m_ShaderMapper->SetInputConnection(localStorage->m_Plane->GetOutputPort());
+    localStorage->m_ShaderMapper->SetSlice(localStorage->m_ReslicedImage);
+    localStorage->m_ShaderMapper->SetImageLookupTable(
+      vtkLookupTable::SafeDownCast(localStorage->m_LevelWindowFilter->GetLookupTable()));
+    localStorage->m_ShaderMapper->SetTextureInterpolation(textureInterpolation);
+    localStorage->m_ShaderMapper->SetOutlineWidth(binary && binaryOutline ? binaryOutlineWidth : 0.0f);
+
+    localStorage->m_Actor->SetMapper(localStorage->m_ShaderMapper);
+    localStorage->m_Actor->SetTexture(nullptr);
+    contourShadowActor->SetVisibility(false);
+  }
+  else if (binary && binaryOutline) // connect the mapper with the polyData which contains the lines
   {
     // We need the contour for the binary outline property as actor
     localStorage->m_Mapper->SetInputData(localStorage->m_OutlinePolyData);
+    localStorage->m_Actor->SetMapper(localStorage->m_Mapper);
     localStorage->m_Actor->SetTexture(nullptr); // no texture for contours
 
-    bool binaryOutlineShadow = false;
-    datanode->GetBoolProperty("outline binary shadow", binaryOutlineShadow, renderer);
     if (binaryOutlineShadow)
     {
       contourShadowActor->SetVisibility(true);
@@ -426,6 +601,7 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
     this->GeneratePlane(renderer, sliceBounds);
     // set the plane as input for the mapper
     localStorage->m_Mapper->SetInputConnection(localStorage->m_Plane->GetOutputPort());
+    localStorage->m_Actor->SetMapper(localStorage->m_Mapper);
     // set the texture for the actor
 
     localStorage->m_Actor->SetTexture(localStorage->m_Texture);
@@ -664,14 +840,28 @@ void mitk::ImageVtkMapper2D::Update(mitk::BaseRenderer *renderer)
   data->UpdateOutputInformation();
   LocalStorage *localStorage = m_LSH.GetLocalStorage(renderer);
 
-  // check if something important has changed and we need to rerender
-  if ((localStorage->m_LastUpdateTime < node->GetMTime()) ||
-      (localStorage->m_LastUpdateTime < data->GetPipelineMTime()) ||
+  // skip modifications of the image data that do not touch the displayed slice (see Image::RegionModified())
+  bool dataModified = localStorage->m_LastUpdateTime < data->GetPipelineMTime();
+  Image::RegionType modifiedRegion;
+  if (dataModified && data->GetSource().IsNull() &&
+      data->GetModifiedRegion(localStorage->m_LastUpdateTime.GetMTime(), modifiedRegion))
+  {
+    Image::RegionType sliceRegion =
+      data->GetRegionOfPlane(renderer->GetCurrentWorldPlaneGeometry(), this->GetTimestep());
+    dataModified = modifiedRegion.GetNumberOfPixels() > 0 && sliceRegion.Crop(modifiedRegion);
+  }
+
+  const bool propertiesModified = (localStorage->m_LastUpdateTime < node->GetPropertyList()->GetMTime()) ||
+                                  (localStorage->m_LastUpdateTime < node->GetPropertyList(renderer)->GetMTime()) ||
+                                  (localStorage->m_LastUpdateTime < data->GetPropertyList()->GetMTime());
+
+  // check if something important has changed and we need to rerender; a modified level window
+  // of a slice rendered on the GPU does not require a new slice
+  if ((localStorage->m_LastUpdateTime < node->GetMTime()) || dataModified ||
+      (localStorage->m_Reslicer->GetInPlaneDownsamplingFactor() != GetInteractionDownsamplingFactor()) ||
       (localStorage->m_LastUpdateTime < renderer->GetCurrentWorldPlaneGeometryUpdateTime()) ||
       (localStorage->m_LastUpdateTime < renderer->GetCurrentWorldPlaneGeometry()->GetMTime()) ||
-      (localStorage->m_LastUpdateTime < node->GetPropertyList()->GetMTime()) ||
-      (localStorage->m_LastUpdateTime < node->GetPropertyList(renderer)->GetMTime()) ||
-      (localStorage->m_LastUpdateTime < data->GetPropertyList()->GetMTime()))
+      (propertiesModified && !this->UpdateShaderLevelWindow(renderer)))
   {
     this->GenerateDataForRenderer(renderer);
   }
@@ -681,6 +871,38 @@ void mitk::ImageVtkMapper2D::Update(mitk::BaseRenderer *renderer)
   localStorage->m_LastUpdateTime.Modified();
 }
 
+bool mitk::ImageVtkMapper2D::UpdateShaderLevelWindow(mitk::BaseRenderer *renderer)
+{
+  LocalStorage *localStorage = m_LSH.GetLocalStorage(renderer);
+  if (localStorage->m_Actor->GetMapper() != localStorage->m_ShaderMapper.GetPointer() || !IsShaderLevelWindowEnabled())
+  {
+    return false;
+  }
+
+  // a modified property list without modified properties means properties were added or removed
+  const itk::ModifiedTimeType lastUpdateTime = localStorage->m_LastUpdateTime.GetMTime();
+  bool modified = false;
+  if (!OnlyShaderLevelWindowPropertiesModified(this->GetDataNode()->GetPropertyList(), lastUpdateTime, modified) ||
+      !OnlyShaderLevelWindowPropertiesModified(
+        this->GetDataNode()->GetPropertyList(renderer), lastUpdateTime, modified) ||
+      !OnlyShaderLevelWindowPropertiesModified(this->GetInput()->GetPropertyList(), lastUpdateTime, modified) ||
+      !modified)
+  {
+    return false;
+  }
+
+  this->ApplyOpacity(renderer);
+  this->ApplyRenderingMode(renderer);
+
+  vtkScalarsToColors *lookupTable = localStorage->m_LevelWindowFilter->GetLookupTable();
+  if (!vtkMitkLevelWindowShaderMapper::IsLookupTableSupported(lookupTable))
+  {
+    return false;
+  }
+  localStorage->m_ShaderMapper->SetImageLookupTable(vtkLookupTable::SafeDownCast(lookupTable));
+  return true;
+}
+
 void mitk::ImageVtkMapper2D::SetDefaultProperties(mitk::DataNode *node, mitk::BaseRenderer *renderer, bool overwrite)
 {
   mitk::Image::Pointer image = dynamic_cast<mitk::Image *>(node->GetData());
@@ -864,6 +1086,26 @@ mitk::ImageVtkMapper2D::LocalStorage *mitk::ImageVtkMapper2D::GetLocalStorage(mi
   return m_LSH.GetLocalStorage(renderer);
 }
 
+void mitk::ImageVtkMapper2D::SetSliceCacheCapacity(std::size_t capacity)
+{
+  m_SliceCache.SetCapacity(capacity);
+}
+
+std::size_t mitk::ImageVtkMapper2D::GetSliceCacheCapacity() const
+{
+  return m_SliceCache.GetCapacity();
+}
+
+std::size_t mitk::ImageVtkMapper2D::GetCacheSize() const
+{
+  return m_SliceCache.GetMemorySize();
+}
+
+void mitk::ImageVtkMapper2D::ReleaseCache()
+{
+  m_SliceCache.Clear();
+}
+
 template <typename TPixel>
 vtkSmartPointer<vtkPolyData> mitk::ImageVtkMapper2D::CreateOutlinePolyData(mitk::BaseRenderer *renderer)
 {
@@ -1028,8 +1270,7 @@ void mitk::ImageVtkMapper2D::TransformActor(mitk::BaseRenderer *renderer)
   LocalStorage *localStorage = m_LSH.GetLocalStorage(renderer);
   // get the transformation matrix of the reslicer in order to render the slice as axial, coronal or saggital
   vtkSmartPointer<vtkTransform> trans = vtkSmartPointer<vtkTransform>::New();
-  vtkSmartPointer<vtkMatrix4x4> matrix = localStorage->m_Reslicer->GetResliceAxes();
-  trans->SetMatrix(matrix);
+  trans->SetMatrix(localStorage->m_ResliceAxes);
   // transform the plane/contour (the actual actor) to the corresponding view (axial, coronal or saggital)
   localStorage->m_Actor->SetUserTransform(trans);
   // transform the origin to center based coordinates, because MITK is center based.
@@ -1043,6 +1284,55 @@ void mitk::ImageVtkMapper2D::TransformActor(mitk::BaseRenderer *renderer)
   }
 }
 
+void mitk::ImageVtkMapper2D::PrefetchNeighboringSlices(mitk::BaseRenderer *renderer,
+                                                       const ImageSliceCache::Key &key,
+                                                       unsigned long imageTime)
+{
+  LocalStorage *localStorage = m_LSH.GetLocalStorage(renderer);
+  auto *image = const_cast<mitk::Image *>(this->GetInput());
+
+  // follow the scroll direction of the slice stepper
+  const unsigned int slice = renderer->GetSlice();
+  if (slice != localStorage->m_LastSlice)
+  {
+    localStorage->m_SliceStep = slice > localStorage->m_LastSlice ? 1 : -1;
+    localStorage->m_LastSlice = slice;
+  }
+
+  // images produced by a filter are not touched from another thread
+  const int count = GetSlicePrefetchCount();
+  const auto *slicedWorldGeometry = dynamic_cast<const SlicedGeometry3D *>(renderer->GetCurrentWorldGeometry());
+  if (count == 0 || key.ThickSlicesMode > 0 || image->GetSource().IsNotNull() || slicedWorldGeometry == nullptr)
+    return;
+
+  std::vector<ImageSlicePrefetcher::Request> requests;
+  for (int i = 1; i <= count; ++i)
+  {
+    const int neighbor = static_cast<int>(slice) + i * localStorage->m_SliceStep;
+    if (neighbor < 0 || neighbor >= static_cast<int>(slicedWorldGeometry->GetSlices()))
+      break;
+
+    const PlaneGeometry *plane = slicedWorldGeometry->GetPlaneGeometry(neighbor);
+    if (plane == nullptr || !plane->HasReferenceGeometry() ||
+        !RenderingGeometryIntersectsImage(plane, image->GetSlicedGeometry()))
+      break;
+
+    ImageSlicePrefetcher::Request request;
+    request.Key = key;
+    request.Key.SetPlaneGeometry(plane);
+    request.Geometry = plane;
+    if (!m_SliceCache.Contains(request.Key, imageTime))
+      requests.push_back(request);
+  }
+
+  m_SlicePrefetcher.Prefetch(image,
+                             this->GetTimestep(),
+                             imageTime,
+                             ToResliceInterpolation(key.InterpolationMode),
+                             key.InPlaneResampleExtentByGeometry,
+                             requests);
+}
+
 bool mitk::ImageVtkMapper2D::RenderingGeometryIntersectsImage(const PlaneGeometry *renderingGeometry,
                                                               SlicedGeometry3D *imageGeometry)
 {
@@ -1088,10 +1378,16 @@ mitk::ImageVtkMapper2D::LocalStorage::LocalStorage()
   m_BinaryLookupTable = vtkSmartPointer<vtkLookupTable>::New();
   m_ColorLookupTable = vtkSmartPointer<vtkLookupTable>::New();
   m_Mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+  m_ShaderMapper = vtkSmartPointer<vtkMitkLevelWindowShaderMapper>::New();
   m_Actor = vtkSmartPointer<vtkActor>::New();
   m_Actors = vtkSmartPointer<vtkPropAssembly>::New();
   m_Reslicer = mitk::ExtractSliceFilter::New();
   m_TSFilter = vtkSmartPointer<vtkMitkThickSlicesFilter>::New();
+  m_ResliceAxes = vtkSmartPointer<vtkMatrix4x4>::New();
+  m_SliceSpacing[0] = m_SliceSpacing[1] = 1.0;
+  m_mmPerPixel = m_SliceSpacing;
+  m_LastSlice = 0;
+  m_SliceStep = 1;
   m_OutlinePolyData = vtkSmartPointer<vtkPolyData>::New();
   m_ReslicedImage = vtkSmartPointer<vtkImageData>::New();
   m_EmptyPolyData = vtkSmartPointer<vtkPolyData>::New();
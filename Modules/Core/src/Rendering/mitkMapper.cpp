@@ -14,6 +14,7 @@ found in the LICENSE file.
 #include "mitkBaseRenderer.h"
 #include "mitkDataNode.h"
 #include "mitkProperties.h"
+#include "mitkTracing.h"
 
 mitk::Mapper::Mapper() : m_DataNode(nullptr), m_TimeStep(0)
 {
@@ -113,6 +114,11 @@ void mitk::Mapper::Update(mitk::BaseRenderer *renderer)
     return;
   }
 
+  // the events are named by the class of the mapper
+  MITK_TRACE_SCOPE_ARGS("Rendering",
+                        this->GetNameOfClass(),
+                        Tracing::MakeArg("renderer", renderer->GetName()) + ", " +
+                          Tracing::MakeArg("node", node->GetName()));
   this->GenerateDataForRenderer(renderer);
 }
 
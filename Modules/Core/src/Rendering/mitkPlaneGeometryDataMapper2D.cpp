@@ -369,7 +369,11 @@ void mitk::PlaneGeometryDataMapper2D::CreateVtkCrosshair(mitk::BaseRenderer *ren
         referenceGeometry ? referenceGeometry->GetSpacing() : inputPlaneGeometry->GetSpacing(), orthogonalVector);
 
       IntProperty *intProperty = nullptr;
-      if (GetDataNode()->GetProperty(intProperty, "reslice.thickslices.num") && intProperty)
+      float thickSlicesThickness = 0.0f;
+      if (GetDataNode()->GetFloatProperty("reslice.thickslices.thickness", thickSlicesThickness) &&
+          thickSlicesThickness > 0.0f)
+        thickSliceDistance = 0.5 * thickSlicesThickness;
+      else if (GetDataNode()->GetProperty(intProperty, "reslice.thickslices.num") && intProperty)
         thickSliceDistance *= intProperty->GetValue() + 0.5;
       else
         showAreaOfThickSlicing = false;
@@ -23,7 +23,7 @@ found in the LICENSE file.
 #include <vtkActor.h>
 #include <vtkCellArray.h>
 #include <vtkFloatArray.h>
-#include <vtkGlyph3D.h>
+#include <vtkGlyph3DMapper.h>
 #include <vtkGlyphSource2D.h>
 #include <vtkLine.h>
 #include <vtkPointData.h>
@@ -46,7 +46,9 @@ mitk::PointSetVtkMapper2D::LocalStorage::LocalStorage()
 
   // scales
   m_UnselectedScales = vtkSmartPointer<vtkFloatArray>::New();
+  m_UnselectedScales->SetName("scales");
   m_SelectedScales = vtkSmartPointer<vtkFloatArray>::New();
+  m_SelectedScales->SetName("scales");
 
   // distances
   m_DistancesBetweenPoints = vtkSmartPointer<vtkFloatArray>::New();
@@ -58,9 +60,9 @@ mitk::PointSetVtkMapper2D::LocalStorage::LocalStorage()
   m_UnselectedGlyphSource2D = vtkSmartPointer<vtkGlyphSource2D>::New();
   m_SelectedGlyphSource2D = vtkSmartPointer<vtkGlyphSource2D>::New();
 
-  // glyphs
-  m_UnselectedGlyph3D = vtkSmartPointer<vtkGlyph3D>::New();
-  m_SelectedGlyph3D = vtkSmartPointer<vtkGlyph3D>::New();
+  // glyph mappers
+  m_UnselectedGlyphMapper = vtkSmartPointer<vtkGlyph3DMapper>::New();
+  m_SelectedGlyphMapper = vtkSmartPointer<vtkGlyph3DMapper>::New();
 
   // polydata
   m_VtkUnselectedPointListPolyData = vtkSmartPointer<vtkPolyData>::New();
@@ -73,8 +75,6 @@ mitk::PointSetVtkMapper2D::LocalStorage::LocalStorage()
   m_ContourActor = vtkSmartPointer<vtkActor>::New();
 
   // mappers
-  m_VtkUnselectedPolyDataMapper = vtkSmartPointer<vtkPolyDataMapper>::New();
-  m_VtkSelectedPolyDataMapper = vtkSmartPointer<vtkPolyDataMapper>::New();
   m_VtkContourPolyDataMapper = vtkSmartPointer<vtkPolyDataMapper>::New();
 
   // propassembly
@@ -522,16 +522,16 @@ void mitk::PointSetVtkMapper2D::CreateVTKRenderObjects(mitk::BaseRenderer *rende
   transformFilterU->SetTransform(transform);
 
   ls->m_VtkUnselectedPointListPolyData->SetPoints(ls->m_UnselectedPoints);
-  ls->m_VtkUnselectedPointListPolyData->GetPointData()->SetVectors(ls->m_UnselectedScales);
+  ls->m_VtkUnselectedPointListPolyData->GetPointData()->AddArray(ls->m_UnselectedScales);
 
-  // apply transform of current plane to glyphs
-  ls->m_UnselectedGlyph3D->SetSourceConnection(transformFilterU->GetOutputPort());
-  ls->m_UnselectedGlyph3D->SetInputData(ls->m_VtkUnselectedPointListPolyData);
-  ls->m_UnselectedGlyph3D->SetScaleModeToScaleByVector();
-  ls->m_UnselectedGlyph3D->SetVectorModeToUseVector();
+  // apply transform of current plane to glyphs, the glyphs are scaled by the magnitude of the scales
+  ls->m_UnselectedGlyphMapper->SetSourceConnection(transformFilterU->GetOutputPort());
+  ls->m_UnselectedGlyphMapper->SetInputData(ls->m_VtkUnselectedPointListPolyData);
+  ls->m_UnselectedGlyphMapper->SetScaleArray("scales");
+  ls->m_UnselectedGlyphMapper->SetScaleModeToScaleByMagnitude();
+  ls->m_UnselectedGlyphMapper->OrientOff();
 
-  ls->m_VtkUnselectedPolyDataMapper->SetInputConnection(ls->m_UnselectedGlyph3D->GetOutputPort());
-  ls->m_UnselectedActor->SetMapper(ls->m_VtkUnselectedPolyDataMapper);
+  ls->m_UnselectedActor->SetMapper(ls->m_UnselectedGlyphMapper);
   ls->m_UnselectedActor->GetProperty()->SetLineWidth(m_PointLineWidth);
 
   ls->m_PropAssembly->AddPart(ls->m_UnselectedActor);
@@ -548,16 +548,16 @@ void mitk::PointSetVtkMapper2D::CreateVTKRenderObjects(mitk::BaseRenderer *rende
   transformFilterS->SetTransform(transform);
 
   ls->m_VtkSelectedPointListPolyData->SetPoints(ls->m_SelectedPoints);
-  ls->m_VtkSelectedPointListPolyData->GetPointData()->SetVectors(ls->m_SelectedScales);
+  ls->m_VtkSelectedPointListPolyData->GetPointData()->AddArray(ls->m_SelectedScales);
 
-  // apply transform of current plane to glyphs
-  ls->m_SelectedGlyph3D->SetSourceConnection(transformFilterS->GetOutputPort());
-  ls->m_SelectedGlyph3D->SetInputData(ls->m_VtkSelectedPointListPolyData);
-  ls->m_SelectedGlyph3D->SetScaleModeToScaleByVector();
-  ls->m_SelectedGlyph3D->SetVectorModeToUseVector();
+  // apply transform of current plane to glyphs, the glyphs are scaled by the magnitude of the scales
+  ls->m_SelectedGlyphMapper->SetSourceConnection(transformFilterS->GetOutputPort());
+  ls->m_SelectedGlyphMapper->SetInputData(ls->m_VtkSelectedPointListPolyData);
+  ls->m_SelectedGlyphMapper->SetScaleArray("scales");
+  ls->m_SelectedGlyphMapper->SetScaleModeToScaleByMagnitude();
+  ls->m_SelectedGlyphMapper->OrientOff();
 
-  ls->m_VtkSelectedPolyDataMapper->SetInputConnection(ls->m_SelectedGlyph3D->GetOutputPort());
-  ls->m_SelectedActor->SetMapper(ls->m_VtkSelectedPolyDataMapper);
+  ls->m_SelectedActor->SetMapper(ls->m_SelectedGlyphMapper);
   ls->m_SelectedActor->GetProperty()->SetLineWidth(m_PointLineWidth);
 
   ls->m_PropAssembly->AddPart(ls->m_SelectedActor);
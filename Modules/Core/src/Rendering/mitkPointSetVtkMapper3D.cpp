@@ -23,6 +23,8 @@ found in the LICENSE file.
 #include <vtkConeSource.h>
 #include <vtkCubeSource.h>
 #include <vtkCylinderSource.h>
+#include <vtkGlyph3DMapper.h>
+#include <vtkPointData.h>
 #include <vtkPolyDataAlgorithm.h>
 #include <vtkPolyDataMapper.h>
 #include <vtkPropAssembly.h>
@@ -32,13 +34,49 @@ found in the LICENSE file.
 #include <vtkTransform.h>
 #include <vtkTransformPolyDataFilter.h>
 #include <vtkTubeFilter.h>
+#include <vtkUnsignedCharArray.h>
 #include <vtkVectorText.h>
 
+#include <algorithm>
 #include <cstdlib>
 
 #include <mitkPropertyObserver.h>
 #include <vtk_glew.h>
 
+namespace
+{
+  // source indices of the glyph mappers
+  enum GlyphType
+  {
+    SphereGlyph = 0,
+    CubeGlyph,
+    ConeGlyph,
+    CylinderGlyph,
+    NumberOfGlyphTypes
+  };
+
+  // marks selected points in the glyph states, in addition to the glyph type
+  const unsigned char SelectedGlyphFlag = 4;
+
+  const char *const GlyphTypeArrayName = "glyph type";
+
+  vtkSmartPointer<vtkPolyData> CreateGlyphPoints()
+  {
+    vtkSmartPointer<vtkUnsignedCharArray> glyphTypes = vtkSmartPointer<vtkUnsignedCharArray>::New();
+    glyphTypes->SetName(GlyphTypeArrayName);
+
+    vtkSmartPointer<vtkPolyData> glyphPoints = vtkSmartPointer<vtkPolyData>::New();
+    glyphPoints->SetPoints(vtkSmartPointer<vtkPoints>::New());
+    glyphPoints->GetPointData()->AddArray(glyphTypes);
+    return glyphPoints;
+  }
+
+  vtkUnsignedCharArray *GetGlyphTypes(vtkPolyData *glyphPoints)
+  {
+    return static_cast<vtkUnsignedCharArray *>(glyphPoints->GetPointData()->GetArray(GlyphTypeArrayName));
+  }
+}
+
 const mitk::PointSet *mitk::PointSetVtkMapper3D::GetInput()
 {
   return static_cast<const mitk::PointSet *>(GetDataNode()->GetData());
@@ -62,6 +100,39 @@ mitk::PointSetVtkMapper3D::PointSetVtkMapper3D()
   m_SelectedActor = vtkSmartPointer<vtkActor>::New();
   m_UnselectedActor = vtkSmartPointer<vtkActor>::New();
   m_ContourActor = vtkSmartPointer<vtkActor>::New();
+
+  // instanced glyphs of the selected and unselected points
+  m_SphereGlyphSource = vtkSmartPointer<vtkSphereSource>::New();
+  m_CubeGlyphSource = vtkSmartPointer<vtkCubeSource>::New();
+  m_ConeGlyphSource = vtkSmartPointer<vtkConeSource>::New();
+  m_CylinderGlyphSource = vtkSmartPointer<vtkCylinderSource>::New();
+  this->UpdateGlyphSources(false);
+
+  m_SelectedGlyphPoints = CreateGlyphPoints();
+  m_UnselectedGlyphPoints = CreateGlyphPoints();
+  m_SelectedGlyphMapper = vtkSmartPointer<vtkGlyph3DMapper>::New();
+  m_SelectedGlyphMapper->SetInputData(m_SelectedGlyphPoints);
+  m_UnselectedGlyphMapper = vtkSmartPointer<vtkGlyph3DMapper>::New();
+  m_UnselectedGlyphMapper->SetInputData(m_UnselectedGlyphPoints);
+
+  for (vtkGlyph3DMapper *glyphMapper : {m_SelectedGlyphMapper.GetPointer(), m_UnselectedGlyphMapper.GetPointer()})
+  {
+    glyphMapper->SetSourceConnection(SphereGlyph, m_SphereGlyphSource->GetOutputPort());
+    glyphMapper->SetSourceConnection(CubeGlyph, m_CubeGlyphSource->GetOutputPort());
+    glyphMapper->SetSourceConnection(ConeGlyph, m_ConeGlyphSource->GetOutputPort());
+    glyphMapper->SetSourceConnection(CylinderGlyph, m_CylinderGlyphSource->GetOutputPort());
+    glyphMapper->SourceIndexingOn();
+    glyphMapper->SetSourceIndexArray(GlyphTypeArrayName);
+    // maps the glyph types 0..NumberOfGlyphTypes-1 one-to-one to the sources
+    glyphMapper->SetRange(0, NumberOfGlyphTypes);
+    glyphMapper->ScalingOff();
+    glyphMapper->OrientOff();
+  }
+
+  m_SelectedGlyphActor = vtkSmartPointer<vtkActor>::New();
+  m_SelectedGlyphActor->SetMapper(m_SelectedGlyphMapper);
+  m_UnselectedGlyphActor = vtkSmartPointer<vtkActor>::New();
+  m_UnselectedGlyphActor->SetMapper(m_UnselectedGlyphMapper);
 }
 
 mitk::PointSetVtkMapper3D::~PointSetVtkMapper3D()
@@ -75,6 +146,8 @@ void mitk::PointSetVtkMapper3D::ReleaseGraphicsResources(vtkWindow *renWin)
   m_SelectedActor->ReleaseGraphicsResources(renWin);
   m_UnselectedActor->ReleaseGraphicsResources(renWin);
   m_ContourActor->ReleaseGraphicsResources(renWin);
+  m_SelectedGlyphActor->ReleaseGraphicsResources(renWin);
+  m_UnselectedGlyphActor->ReleaseGraphicsResources(renWin);
 }
 
 void mitk::PointSetVtkMapper3D::ReleaseGraphicsResources(mitk::BaseRenderer *renderer)
@@ -84,6 +157,8 @@ void mitk::PointSetVtkMapper3D::ReleaseGraphicsResources(mitk::BaseRenderer *ren
   m_SelectedActor->ReleaseGraphicsResources(renderer->GetRenderWindow());
   m_UnselectedActor->ReleaseGraphicsResources(renderer->GetRenderWindow());
   m_ContourActor->ReleaseGraphicsResources(renderer->GetRenderWindow());
+  m_SelectedGlyphActor->ReleaseGraphicsResources(renderer->GetRenderWindow());
+  m_UnselectedGlyphActor->ReleaseGraphicsResources(renderer->GetRenderWindow());
 }
 
 void mitk::PointSetVtkMapper3D::CreateVTKRenderObjects()
@@ -99,6 +174,10 @@ void mitk::PointSetVtkMapper3D::CreateVTKRenderObjects()
     m_PointsAssembly->RemovePart(m_UnselectedActor);
   if (m_PointsAssembly->GetParts()->IsItemPresent(m_ContourActor))
     m_PointsAssembly->RemovePart(m_ContourActor);
+  if (m_PointsAssembly->GetParts()->IsItemPresent(m_SelectedGlyphActor))
+    m_PointsAssembly->RemovePart(m_SelectedGlyphActor);
+  if (m_PointsAssembly->GetParts()->IsItemPresent(m_UnselectedGlyphActor))
+    m_PointsAssembly->RemovePart(m_UnselectedGlyphActor);
 
   // exceptional displaying for PositionTracker -> MouseOrientationTool
   int mapperID;
@@ -172,6 +251,7 @@ void mitk::PointSetVtkMapper3D::CreateVTKRenderObjects()
   m_NumberOfSelectedAdded = 0;
   m_NumberOfUnselectedAdded = 0;
   vtkSmartPointer<vtkPoints> localPoints = vtkSmartPointer<vtkPoints>::New();
+  vtkSmartPointer<vtkPoints> lastWorldPositions = m_WorldPositions;
   m_WorldPositions = vtkSmartPointer<vtkPoints>::New();
   m_PointConnections = vtkSmartPointer<vtkCellArray>::New(); // m_PointConnections between points
   for (ptIdx = 0, pointsIter = itkPointSet->GetPoints()->Begin(); pointsIter != itkPointSet->GetPoints()->End();
@@ -200,13 +280,14 @@ void mitk::PointSetVtkMapper3D::CreateVTKRenderObjects()
   // inserted manually and can not be visualized according to the PointData (selected/unselected)
   bool pointDataBroken = (itkPointSet->GetPointData()->Size() != itkPointSet->GetPoints()->Size());
 
-  // now add an object for each point in data
+  // now determine the glyph of each point in data, the glyphs are instanced by the glyph mappers
+  const int numberOfGlyphs = std::min<int>(nbPoints, m_WorldPositions->GetNumberOfPoints());
+  std::vector<unsigned char> glyphStates(numberOfGlyphs);
   mitk::PointSet::PointDataContainer::Iterator pointDataIter = itkPointSet->GetPointData()->Begin();
-  for (ptIdx = 0; ptIdx < nbPoints; ++ptIdx) // pointDataIter moved at end of loop
+  for (ptIdx = 0; ptIdx < numberOfGlyphs; ++ptIdx) // pointDataIter moved at end of loop
   {
     double currentPoint[3];
     m_WorldPositions->GetPoint(ptIdx, currentPoint);
-    vtkSmartPointer<vtkPolyDataAlgorithm> source;
 
     // check for the pointtype in data and decide which geom-object to take and then add to the selected or unselected
     // list
@@ -216,90 +297,25 @@ void mitk::PointSetVtkMapper3D::CreateVTKRenderObjects()
     else
       pointType = pointDataIter.Value().pointSpec;
 
+    unsigned char glyphType = SphereGlyph;
     switch (pointType)
     {
-      case mitk::PTUNDEFINED:
-      {
-        vtkSmartPointer<vtkSphereSource> sphere = vtkSmartPointer<vtkSphereSource>::New();
-        sphere->SetRadius(m_PointSize / 2.0f);
-        sphere->SetCenter(currentPoint);
-        // sphere->SetCenter(pointsIter.Value()[0],pointsIter.Value()[1],pointsIter.Value()[2]);
-
-        // MouseOrientation Tool (PositionTracker)
-        if (isInputDevice)
-        {
-          sphere->SetThetaResolution(10);
-          sphere->SetPhiResolution(10);
-        }
-        else
-        {
-          sphere->SetThetaResolution(20);
-          sphere->SetPhiResolution(20);
-        }
-        source = sphere;
-      }
-      break;
       case mitk::PTSTART:
-      {
-        vtkSmartPointer<vtkCubeSource> cube = vtkSmartPointer<vtkCubeSource>::New();
-        cube->SetXLength(m_PointSize / 2);
-        cube->SetYLength(m_PointSize / 2);
-        cube->SetZLength(m_PointSize / 2);
-        cube->SetCenter(currentPoint);
-        source = cube;
-      }
-      break;
+        glyphType = CubeGlyph;
+        break;
       case mitk::PTCORNER:
-      {
-        vtkSmartPointer<vtkConeSource> cone = vtkSmartPointer<vtkConeSource>::New();
-        cone->SetRadius(m_PointSize / 2.0f);
-        cone->SetCenter(currentPoint);
-        cone->SetResolution(20);
-        source = cone;
-      }
-      break;
+        glyphType = ConeGlyph;
+        break;
       case mitk::PTEDGE:
-      {
-        vtkSmartPointer<vtkCylinderSource> cylinder = vtkSmartPointer<vtkCylinderSource>::New();
-        cylinder->SetRadius(m_PointSize / 2.0f);
-        cylinder->SetCenter(currentPoint);
-        cylinder->SetResolution(20);
-        source = cylinder;
-      }
-      break;
-      case mitk::PTEND:
-      {
-        vtkSmartPointer<vtkSphereSource> sphere = vtkSmartPointer<vtkSphereSource>::New();
-        sphere->SetRadius(m_PointSize / 2.0f);
-        // no SetCenter?? this functionality should be explained!
-        // otherwise: join with default block!
-        sphere->SetThetaResolution(20);
-        sphere->SetPhiResolution(20);
-        source = sphere;
-      }
-      break;
-      default:
-      {
-        vtkSmartPointer<vtkSphereSource> sphere = vtkSmartPointer<vtkSphereSource>::New();
-        sphere->SetRadius(m_PointSize / 2.0f);
-        sphere->SetCenter(currentPoint);
-        sphere->SetThetaResolution(20);
-        sphere->SetPhiResolution(20);
-        source = sphere;
-      }
-      break;
+        glyphType = CylinderGlyph;
+        break;
+      default: // mitk::PTUNDEFINED, mitk::PTEND
+        break;
     }
 
-    if (pointDataIter.Value().selected && !pointDataBroken)
-    {
-      m_vtkSelectedPointList->AddInputConnection(source->GetOutputPort());
-      ++m_NumberOfSelectedAdded;
-    }
-    else
-    {
-      m_vtkUnselectedPointList->AddInputConnection(source->GetOutputPort());
-      ++m_NumberOfUnselectedAdded;
-    }
+    const bool selected = !pointDataBroken && pointDataIter.Value().selected;
+    glyphStates[ptIdx] = selected ? glyphType | SelectedGlyphFlag : glyphType;
+
     if (showLabel)
     {
       char buffer[20];
@@ -341,7 +357,14 @@ void mitk::PointSetVtkMapper3D::CreateVTKRenderObjects()
       pointDataIter++;
   } // end FOR
 
-  // now according to number of elements added to selected or unselected, build up the rendering pipeline
+  this->UpdateGlyphSources(isInputDevice);
+  this->UpdateGlyphs(lastWorldPositions, glyphStates);
+  if (m_SelectedGlyphPoints->GetNumberOfPoints() > 0)
+    m_PointsAssembly->AddPart(m_SelectedGlyphActor);
+  if (m_UnselectedGlyphPoints->GetNumberOfPoints() > 0)
+    m_PointsAssembly->AddPart(m_UnselectedGlyphActor);
+
+  // now according to number of labels added to selected or unselected, build up the rendering pipeline
   if (m_NumberOfSelectedAdded > 0)
   {
     m_VtkSelectedPolyDataMapper = vtkSmartPointer<vtkPolyDataMapper>::New();
@@ -367,6 +390,81 @@ void mitk::PointSetVtkMapper3D::CreateVTKRenderObjects()
   }
 }
 
+void mitk::PointSetVtkMapper3D::UpdateGlyphSources(bool isInputDevice)
+{
+  // MouseOrientation Tool (PositionTracker)
+  const int sphereResolution = isInputDevice ? 10 : 20;
+  m_SphereGlyphSource->SetRadius(m_PointSize / 2.0f);
+  m_SphereGlyphSource->SetThetaResolution(sphereResolution);
+  m_SphereGlyphSource->SetPhiResolution(sphereResolution);
+
+  m_CubeGlyphSource->SetXLength(m_PointSize / 2);
+  m_CubeGlyphSource->SetYLength(m_PointSize / 2);
+  m_CubeGlyphSource->SetZLength(m_PointSize / 2);
+
+  m_ConeGlyphSource->SetRadius(m_PointSize / 2.0f);
+  m_ConeGlyphSource->SetResolution(20);
+
+  m_CylinderGlyphSource->SetRadius(m_PointSize / 2.0f);
+  m_CylinderGlyphSource->SetResolution(20);
+}
+
+void mitk::PointSetVtkMapper3D::UpdateGlyphs(vtkPoints *lastWorldPositions,
+                                              const std::vector<unsigned char> &glyphStates)
+{
+  const vtkIdType numberOfGlyphs = static_cast<vtkIdType>(glyphStates.size());
+  const vtkIdType numberOfLastGlyphs = static_cast<vtkIdType>(m_GlyphStates.size());
+
+  // keep the glyphs of the last update if the points were only appended
+  vtkIdType firstNewGlyph = 0;
+  if (lastWorldPositions != nullptr && numberOfLastGlyphs <= numberOfGlyphs &&
+      numberOfLastGlyphs <= lastWorldPositions->GetNumberOfPoints())
+  {
+    firstNewGlyph = numberOfLastGlyphs;
+    for (vtkIdType i = 0; i < numberOfLastGlyphs; ++i)
+    {
+      double lastPoint[3], point[3];
+      lastWorldPositions->GetPoint(i, lastPoint);
+      m_WorldPositions->GetPoint(i, point);
+      if (glyphStates[i] != m_GlyphStates[i] || !std::equal(point, point + 3, lastPoint))
+      {
+        firstNewGlyph = 0;
+        break;
+      }
+    }
+  }
+
+  vtkPolyData *glyphPoints[2] = {m_UnselectedGlyphPoints, m_SelectedGlyphPoints};
+  if (firstNewGlyph == 0)
+  {
+    for (vtkPolyData *points : glyphPoints)
+    {
+      points->GetPoints()->Reset();
+      GetGlyphTypes(points)->Reset();
+    }
+  }
+  else if (firstNewGlyph == numberOfGlyphs)
+  {
+    // unchanged, the glyph mappers do not need to upload the instances again
+    return;
+  }
+
+  for (vtkIdType i = firstNewGlyph; i < numberOfGlyphs; ++i)
+  {
+    vtkPolyData *points = glyphPoints[(glyphStates[i] & SelectedGlyphFlag) != 0 ? 1 : 0];
+    points->GetPoints()->InsertNextPoint(m_WorldPositions->GetPoint(i));
+    GetGlyphTypes(points)->InsertNextValue(glyphStates[i] & ~SelectedGlyphFlag);
+  }
+
+  for (vtkPolyData *points : glyphPoints)
+  {
+    points->GetPoints()->Modified();
+    GetGlyphTypes(points)->Modified();
+    points->Modified();
+  }
+  m_GlyphStates = glyphStates;
+}
+
 void mitk::PointSetVtkMapper3D::GenerateDataForRenderer(mitk::BaseRenderer *renderer)
 {
   bool visible = true;
@@ -375,6 +473,8 @@ void mitk::PointSetVtkMapper3D::GenerateDataForRenderer(mitk::BaseRenderer *rend
   {
     m_UnselectedActor->VisibilityOff();
     m_SelectedActor->VisibilityOff();
+    m_UnselectedGlyphActor->VisibilityOff();
+    m_SelectedGlyphActor->VisibilityOff();
     m_ContourActor->VisibilityOff();
     return;
   }
@@ -405,6 +505,8 @@ void mitk::PointSetVtkMapper3D::GenerateDataForRenderer(mitk::BaseRenderer *rend
 
   m_UnselectedActor->SetVisibility(showPoints);
   m_SelectedActor->SetVisibility(showPoints);
+  m_UnselectedGlyphActor->SetVisibility(showPoints);
+  m_SelectedGlyphActor->SetVisibility(showPoints);
 
   if (false && dynamic_cast<mitk::FloatProperty *>(this->GetDataNode()->GetProperty("opacity")) != nullptr)
   {
@@ -553,7 +655,9 @@ void mitk::PointSetVtkMapper3D::ApplyAllProperties(mitk::BaseRenderer *renderer,
   this->GetDataNode()->GetBoolProperty("show contour", showContour, renderer);
   if (showContour && (m_ContourActor != nullptr))
   {
-    this->CreateContour(m_WorldPositions, m_PointConnections);
+    // the contour only changes with the points, it is removed by CreateVTKRenderObjects()
+    if (!m_PointsAssembly->GetParts()->IsItemPresent(m_ContourActor))
+      this->CreateContour(m_WorldPositions, m_PointConnections);
     m_ContourActor->GetProperty()->SetColor(contourColor);
     m_ContourActor->GetProperty()->SetOpacity(opacity);
   }
@@ -563,6 +667,12 @@ void mitk::PointSetVtkMapper3D::ApplyAllProperties(mitk::BaseRenderer *renderer,
 
   m_UnselectedActor->GetProperty()->SetColor(unselectedColor);
   m_UnselectedActor->GetProperty()->SetOpacity(opacity);
+
+  m_SelectedGlyphActor->GetProperty()->SetColor(selectedColor);
+  m_SelectedGlyphActor->GetProperty()->SetOpacity(opacity);
+
+  m_UnselectedGlyphActor->GetProperty()->SetColor(unselectedColor);
+  m_UnselectedGlyphActor->GetProperty()->SetOpacity(opacity);
 }
 
 void mitk::PointSetVtkMapper3D::CreateContour(vtkPoints *points, vtkCellArray *m_PointConnections)
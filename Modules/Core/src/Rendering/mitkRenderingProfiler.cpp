@@ -0,0 +1,177 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkRenderingProfiler.h"
+
+#include <mitkDataNode.h>
+#include <mitkMapper.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+mitk::RenderingProfiler::RenderingProfiler()
+  : m_Enabled(false),
+    m_Clock(itk::RealTimeClock::New()),
+    m_FrameStarted(false),
+    m_FrameStartTime(0.0),
+    m_NumberOfFrames(0),
+    m_AverageTotalTime(0.0),
+    m_MaximumTotalTime(0.0)
+{
+  this->ResetCurrentFrame();
+  m_LastFrame = m_CurrentFrame;
+}
+
+mitk::RenderingProfiler::~RenderingProfiler()
+{
+}
+
+void mitk::RenderingProfiler::SetEnabled(bool enabled)
+{
+  if (enabled == m_Enabled)
+    return;
+
+  m_Enabled = enabled;
+  if (m_Enabled)
+  {
+    m_FrameStarted = false;
+    m_NumberOfFrames = 0;
+    m_AverageTotalTime = 0.0;
+    m_MaximumTotalTime = 0.0;
+    this->ResetCurrentFrame();
+    m_LastFrame = m_CurrentFrame;
+  }
+  this->Modified();
+}
+
+double mitk::RenderingProfiler::GetTime() const
+{
+  return m_Clock->GetTimeInSeconds() * 1000.0;
+}
+
+void mitk::RenderingProfiler::StartFrame()
+{
+  if (!m_Enabled)
+    return;
+
+  m_FrameStarted = true;
+  m_FrameStartTime = this->GetTime();
+}
+
+void mitk::RenderingProfiler::EndFrame()
+{
+  if (!m_Enabled || !m_FrameStarted)
+    return;
+
+  m_FrameStarted = false;
+  m_CurrentFrame.TotalTime = this->GetTime() - m_FrameStartTime;
+  m_CurrentFrame.FrameNumber = ++m_NumberOfFrames;
+
+  const double totalTime = m_CurrentFrame.TotalTime;
+  m_MaximumTotalTime = std::max(m_MaximumTotalTime, totalTime);
+  // exponential moving average, as for the render window statistics of the RenderingManager
+  m_AverageTotalTime = m_NumberOfFrames == 1 ? totalTime : 0.8 * m_AverageTotalTime + 0.2 * totalTime;
+
+  std::swap(m_LastFrame, m_CurrentFrame);
+  this->ResetCurrentFrame();
+
+  this->InvokeEvent(itk::EndEvent());
+}
+
+void mitk::RenderingProfiler::AddMapperUpdateTime(const Mapper *mapper, double time)
+{
+  if (!m_Enabled)
+    return;
+
+  this->GetMapperTimes(mapper).UpdateTime += time;
+  m_CurrentFrame.MapperUpdateTime += time;
+}
+
+void mitk::RenderingProfiler::AddMapperRenderTime(const Mapper *mapper, double time)
+{
+  if (!m_Enabled)
+    return;
+
+  this->GetMapperTimes(mapper).RenderTime += time;
+  m_CurrentFrame.MapperRenderTime += time;
+}
+
+void mitk::RenderingProfiler::AddAnnotationTime(double time)
+{
+  if (m_Enabled)
+    m_CurrentFrame.AnnotationTime += time;
+}
+
+const mitk::RenderingProfiler::FrameTimes &mitk::RenderingProfiler::GetLastFrame() const
+{
+  return m_LastFrame;
+}
+
+std::string mitk::RenderingProfiler::GetSummary(unsigned int numberOfMappers) const
+{
+  std::ostringstream summary;
+  summary << std::fixed << std::setprecision(1);
+  summary << "Frame " << m_LastFrame.FrameNumber << ": " << m_LastFrame.TotalTime << " ms (avg "
+          << m_AverageTotalTime << " ms, max " << m_MaximumTotalTime << " ms)\n";
+  summary << "Mapper update " << m_LastFrame.MapperUpdateTime << " ms, render " << m_LastFrame.MapperRenderTime
+          << " ms, annotations " << m_LastFrame.AnnotationTime << " ms";
+
+  std::vector<const MapperTimes *> mappers;
+  for (const auto &mapperTimes : m_LastFrame.Mappers)
+    mappers.push_back(&mapperTimes);
+  std::stable_sort(mappers.begin(), mappers.end(), [](const MapperTimes *a, const MapperTimes *b) {
+    return a->UpdateTime + a->RenderTime > b->UpdateTime + b->RenderTime;
+  });
+  if (mappers.size() > numberOfMappers)
+    mappers.resize(numberOfMappers);
+
+  for (const MapperTimes *mapperTimes : mappers)
+  {
+    summary << "\n  " << mapperTimes->NodeName << " (" << mapperTimes->MapperName << "): update "
+            << mapperTimes->UpdateTime << " ms, render " << mapperTimes->RenderTime << " ms";
+  }
+  return summary.str();
+}
+
+mitk::RenderingProfiler::MapperTimes &mitk::RenderingProfiler::GetMapperTimes(const Mapper *mapper)
+{
+  auto it = m_CurrentMapperIndices.find(mapper);
+  if (it != m_CurrentMapperIndices.end())
+    return m_CurrentFrame.Mappers[it->second];
+
+  MapperTimes mapperTimes;
+  mapperTimes.UpdateTime = 0.0;
+  mapperTimes.RenderTime = 0.0;
+  if (mapper != nullptr)
+  {
+    mapperTimes.MapperName = mapper->GetNameOfClass();
+    const DataNode *node = mapper->GetDataNode();
+    if (node != nullptr)
+      mapperTimes.NodeName = node->GetName();
+  }
+
+  m_CurrentMapperIndices[mapper] = m_CurrentFrame.Mappers.size();
+  m_CurrentFrame.Mappers.push_back(mapperTimes);
+  return m_CurrentFrame.Mappers.back();
+}
+
+void mitk::RenderingProfiler::ResetCurrentFrame()
+{
+  m_CurrentFrame.FrameNumber = 0;
+  m_CurrentFrame.MapperUpdateTime = 0.0;
+  m_CurrentFrame.MapperRenderTime = 0.0;
+  m_CurrentFrame.AnnotationTime = 0.0;
+  m_CurrentFrame.TotalTime = 0.0;
+  m_CurrentFrame.Mappers.clear();
+  m_CurrentMapperIndices.clear();
+}
@@ -0,0 +1,237 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkSurfaceCutLocator.h"
+
+#include <vtkCellData.h>
+#include <vtkIdList.h>
+#include <vtkMath.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+  // upper limit of the number of buckets, bounds the memory needed for the bucket offsets
+  const std::size_t MaximumNumberOfBuckets = 1 << 20;
+}
+
+mitk::SurfaceCutLocator::SurfaceCutLocator() : m_PolyDataMTime(0), m_Minimum(0.0), m_BucketWidth(1.0)
+{
+  std::fill(m_Normal, m_Normal + 3, 0.0);
+}
+
+void mitk::SurfaceCutLocator::Initialize()
+{
+  m_PolyData = nullptr;
+  m_PolyDataMTime = 0;
+  std::fill(m_Normal, m_Normal + 3, 0.0);
+  m_CellMinimum.clear();
+  m_CellMaximum.clear();
+  m_BucketOffsets.clear();
+  m_BucketCells.clear();
+  m_PointMap.clear();
+}
+
+void mitk::SurfaceCutLocator::SetInput(vtkPolyData *polyData, const double normal[3])
+{
+  if (polyData == nullptr)
+  {
+    this->Initialize();
+    return;
+  }
+
+  if (polyData == m_PolyData && polyData->GetMTime() == m_PolyDataMTime && std::equal(normal, normal + 3, m_Normal))
+    return;
+
+  m_PolyData = polyData;
+  m_PolyDataMTime = polyData->GetMTime();
+  std::copy(normal, normal + 3, m_Normal);
+  this->BuildBuckets();
+}
+
+void mitk::SurfaceCutLocator::BuildBuckets()
+{
+  m_CellMinimum.clear();
+  m_CellMaximum.clear();
+  m_BucketOffsets.clear();
+  m_BucketCells.clear();
+  m_PointMap.clear();
+
+  vtkPoints *points = m_PolyData->GetPoints();
+  if (points == nullptr || m_PolyData->GetNumberOfCells() == 0)
+    return;
+
+  const vtkIdType numberOfPoints = points->GetNumberOfPoints();
+  std::vector<double> projections(numberOfPoints);
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+  {
+    double point[3];
+    points->GetPoint(i, point);
+    projections[i] = vtkMath::Dot(point, m_Normal);
+  }
+  m_PointMap.assign(numberOfPoints, -1);
+
+  const vtkIdType numberOfCells = m_PolyData->GetNumberOfCells();
+  m_CellMinimum.resize(numberOfCells);
+  m_CellMaximum.resize(numberOfCells);
+
+  double minimum = std::numeric_limits<double>::max();
+  double maximum = std::numeric_limits<double>::lowest();
+  double totalSpan = 0.0;
+  std::size_t numberOfValidCells = 0;
+  vtkSmartPointer<vtkIdList> cellPoints = vtkSmartPointer<vtkIdList>::New();
+  for (vtkIdType cellId = 0; cellId < numberOfCells; ++cellId)
+  {
+    m_PolyData->GetCellPoints(cellId, cellPoints);
+    double cellMinimum = std::numeric_limits<double>::max();
+    double cellMaximum = std::numeric_limits<double>::lowest();
+    for (vtkIdType i = 0; i < cellPoints->GetNumberOfIds(); ++i)
+    {
+      const double projection = projections[cellPoints->GetId(i)];
+      cellMinimum = std::min(cellMinimum, projection);
+      cellMaximum = std::max(cellMaximum, projection);
+    }
+    m_CellMinimum[cellId] = cellMinimum;
+    m_CellMaximum[cellId] = cellMaximum;
+
+    // empty cells keep an empty interval and are not sorted into any bucket
+    if (cellMinimum <= cellMaximum)
+    {
+      minimum = std::min(minimum, cellMinimum);
+      maximum = std::max(maximum, cellMaximum);
+      totalSpan += cellMaximum - cellMinimum;
+      ++numberOfValidCells;
+    }
+  }
+
+  if (numberOfValidCells == 0)
+    return;
+
+  // the cutter evaluates the plane as n * (x - o) instead of n * x - n * o, widen the intervals a little
+  // so that cells touched by the plane are not lost by rounding
+  const double span = maximum - minimum;
+  const double tolerance = 1e-9 * std::max({std::abs(minimum), std::abs(maximum), span, 1.0});
+  for (vtkIdType cellId = 0; cellId < numberOfCells; ++cellId)
+  {
+    if (m_CellMinimum[cellId] <= m_CellMaximum[cellId])
+    {
+      m_CellMinimum[cellId] -= tolerance;
+      m_CellMaximum[cellId] += tolerance;
+    }
+  }
+  minimum -= tolerance;
+  maximum += tolerance;
+
+  // buckets about as wide as the average cell, so that most cells end up in one or two buckets
+  const double averageSpan = totalSpan / numberOfValidCells;
+  double numberOfBuckets = averageSpan > 0.0 ? (maximum - minimum) / averageSpan : numberOfValidCells;
+  numberOfBuckets = std::max(1.0, std::min(numberOfBuckets, static_cast<double>(numberOfValidCells)));
+  numberOfBuckets = std::min(numberOfBuckets, static_cast<double>(MaximumNumberOfBuckets));
+  const std::size_t bucketCount = static_cast<std::size_t>(numberOfBuckets);
+
+  m_Minimum = minimum;
+  m_BucketWidth = (maximum - minimum) / bucketCount;
+
+  auto bucketOf = [this, bucketCount](double value) {
+    const double bucket = std::floor((value - m_Minimum) / m_BucketWidth);
+    return static_cast<std::size_t>(std::max(0.0, std::min(bucket, static_cast<double>(bucketCount - 1))));
+  };
+
+  m_BucketOffsets.assign(bucketCount + 1, 0);
+  for (vtkIdType cellId = 0; cellId < numberOfCells; ++cellId)
+  {
+    if (m_CellMinimum[cellId] > m_CellMaximum[cellId])
+      continue;
+    const std::size_t last = bucketOf(m_CellMaximum[cellId]);
+    for (std::size_t bucket = bucketOf(m_CellMinimum[cellId]); bucket <= last; ++bucket)
+      ++m_BucketOffsets[bucket + 1];
+  }
+  for (std::size_t bucket = 0; bucket < bucketCount; ++bucket)
+    m_BucketOffsets[bucket + 1] += m_BucketOffsets[bucket];
+
+  m_BucketCells.resize(m_BucketOffsets.back());
+  std::vector<std::size_t> next(m_BucketOffsets.begin(), m_BucketOffsets.end() - 1);
+  for (vtkIdType cellId = 0; cellId < numberOfCells; ++cellId)
+  {
+    if (m_CellMinimum[cellId] > m_CellMaximum[cellId])
+      continue;
+    const std::size_t last = bucketOf(m_CellMaximum[cellId]);
+    for (std::size_t bucket = bucketOf(m_CellMinimum[cellId]); bucket <= last; ++bucket)
+      m_BucketCells[next[bucket]++] = cellId;
+  }
+}
+
+vtkSmartPointer<vtkPolyData> mitk::SurfaceCutLocator::ExtractCells(const double origin[3])
+{
+  vtkSmartPointer<vtkPolyData> output = vtkSmartPointer<vtkPolyData>::New();
+  if (m_PolyData == nullptr || m_BucketOffsets.empty())
+    return output;
+
+  const double value = vtkMath::Dot(origin, m_Normal);
+  const std::size_t numberOfBuckets = this->GetNumberOfBuckets();
+  const double bucketPosition = std::floor((value - m_Minimum) / m_BucketWidth);
+  if (bucketPosition < 0.0 || bucketPosition >= numberOfBuckets)
+    return output;
+
+  const std::size_t bucket = static_cast<std::size_t>(bucketPosition);
+  std::vector<vtkIdType> cells;
+  for (std::size_t i = m_BucketOffsets[bucket]; i < m_BucketOffsets[bucket + 1]; ++i)
+  {
+    const vtkIdType cellId = m_BucketCells[i];
+    if (m_CellMinimum[cellId] <= value && value <= m_CellMaximum[cellId])
+      cells.push_back(cellId);
+  }
+
+  vtkPoints *inputPoints = m_PolyData->GetPoints();
+  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+  points->SetDataType(inputPoints->GetDataType());
+  output->SetPoints(points);
+  output->Allocate(static_cast<vtkIdType>(cells.size()));
+
+  vtkPointData *inputPointData = m_PolyData->GetPointData();
+  vtkPointData *outputPointData = output->GetPointData();
+  outputPointData->CopyAllocate(inputPointData, static_cast<vtkIdType>(3 * cells.size()));
+  vtkCellData *inputCellData = m_PolyData->GetCellData();
+  vtkCellData *outputCellData = output->GetCellData();
+  outputCellData->CopyAllocate(inputCellData, static_cast<vtkIdType>(cells.size()));
+
+  std::vector<vtkIdType> extractedPoints;
+  vtkSmartPointer<vtkIdList> cellPoints = vtkSmartPointer<vtkIdList>::New();
+  for (const vtkIdType cellId : cells)
+  {
+    m_PolyData->GetCellPoints(cellId, cellPoints);
+    for (vtkIdType i = 0; i < cellPoints->GetNumberOfIds(); ++i)
+    {
+      const vtkIdType pointId = cellPoints->GetId(i);
+      vtkIdType &extractedId = m_PointMap[pointId];
+      if (extractedId < 0)
+      {
+        extractedId = points->InsertNextPoint(inputPoints->GetPoint(pointId));
+        outputPointData->CopyData(inputPointData, pointId, extractedId);
+        extractedPoints.push_back(pointId);
+      }
+      cellPoints->SetId(i, extractedId);
+    }
+    const vtkIdType extractedCellId = output->InsertNextCell(m_PolyData->GetCellType(cellId), cellPoints);
+    outputCellData->CopyData(inputCellData, cellId, extractedCellId);
+  }
+
+  // reset only the entries used by this extraction
+  for (const vtkIdType pointId : extractedPoints)
+    m_PointMap[pointId] = -1;
+
+  return output;
+}
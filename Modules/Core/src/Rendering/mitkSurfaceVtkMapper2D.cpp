@@ -30,7 +30,9 @@ found in the LICENSE file.
 #include <vtkAssembly.h>
 #include <vtkCutter.h>
 #include <vtkGlyph3D.h>
+#include <vtkLinearTransform.h>
 #include <vtkLookupTable.h>
+#include <vtkMatrix4x4.h>
 #include <vtkPlane.h>
 #include <vtkPointData.h>
 #include <vtkPolyData.h>
@@ -48,7 +50,9 @@ mitk::SurfaceVtkMapper2D::LocalStorage::LocalStorage()
   m_CuttingPlane = vtkSmartPointer<vtkPlane>::New();
   m_Cutter = vtkSmartPointer<vtkCutter>::New();
   m_Cutter->SetCutFunction(m_CuttingPlane);
-  m_Mapper->SetInputConnection(m_Cutter->GetOutputPort());
+  m_CutTransformFilter = vtkSmartPointer<vtkTransformPolyDataFilter>::New();
+  m_CutTransformFilter->SetInputConnection(m_Cutter->GetOutputPort());
+  m_Mapper->SetInputConnection(m_CutTransformFilter->GetOutputPort());
 
   m_NormalGlyph = vtkSmartPointer<vtkGlyph3D>::New();
 
@@ -208,22 +212,36 @@ void mitk::SurfaceVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rende
   normal[1] = planeGeometry->GetNormal()[1];
   normal[2] = planeGeometry->GetNormal()[2];
 
-  localStorage->m_CuttingPlane->SetOrigin(origin);
-  localStorage->m_CuttingPlane->SetNormal(normal);
-  // Transform the data according to its geometry.
+  // Cut the data in its own coordinates and transform the cut according to the geometry of the data.
   // See UpdateVtkTransform documentation for details.
   vtkSmartPointer<vtkLinearTransform> vtktransform = GetDataNode()->GetVtkTransform(this->GetTimestep());
-  vtkSmartPointer<vtkTransformPolyDataFilter> filter = vtkSmartPointer<vtkTransformPolyDataFilter>::New();
-  filter->SetTransform(vtktransform);
-  filter->SetInputData(inputPolyData);
-  localStorage->m_Cutter->SetInputConnection(filter->GetOutputPort());
-  localStorage->m_Cutter->Update();
+  vtkMatrix4x4 *matrix = vtktransform->GetMatrix();
+
+  // the plane n * (A * x + t - o) = 0 in data coordinates has the normal A^T * n
+  double dataOrigin[3];
+  vtktransform->GetLinearInverse()->TransformPoint(origin, dataOrigin);
+  double dataNormal[3];
+  for (int j = 0; j < 3; ++j)
+  {
+    dataNormal[j] = matrix->GetElement(0, j) * normal[0] + matrix->GetElement(1, j) * normal[1] +
+                    matrix->GetElement(2, j) * normal[2];
+  }
+
+  localStorage->m_CuttingPlane->SetOrigin(dataOrigin);
+  localStorage->m_CuttingPlane->SetNormal(dataNormal);
+
+  // only the cells intersected by the plane are cut, the locator is rebuilt when the surface or
+  // the orientation of the plane changes
+  localStorage->m_CutLocator.SetInput(inputPolyData, dataNormal);
+  localStorage->m_Cutter->SetInputData(localStorage->m_CutLocator.ExtractCells(dataOrigin));
+  localStorage->m_CutTransformFilter->SetTransform(vtktransform);
+  localStorage->m_CutTransformFilter->Update();
 
   bool generateNormals = false;
   node->GetBoolProperty("draw normals 2D", generateNormals);
   if (generateNormals)
   {
-    localStorage->m_NormalGlyph->SetInputConnection(localStorage->m_Cutter->GetOutputPort());
+    localStorage->m_NormalGlyph->SetInputConnection(localStorage->m_CutTransformFilter->GetOutputPort());
     localStorage->m_NormalGlyph->Update();
 
     localStorage->m_NormalMapper->SetInputConnection(localStorage->m_NormalGlyph->GetOutputPort());
@@ -240,7 +258,7 @@ void mitk::SurfaceVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rende
   node->GetBoolProperty("invert normals", generateInverseNormals);
   if (generateInverseNormals)
   {
-    localStorage->m_ReverseSense->SetInputConnection(localStorage->m_Cutter->GetOutputPort());
+    localStorage->m_ReverseSense->SetInputConnection(localStorage->m_CutTransformFilter->GetOutputPort());
     localStorage->m_ReverseSense->ReverseCellsOff();
     localStorage->m_ReverseSense->ReverseNormalsOn();
 
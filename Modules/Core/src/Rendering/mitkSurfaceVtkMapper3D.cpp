@@ -21,6 +21,7 @@ found in the LICENSE file.
 #include <mitkImageSliceSelector.h>
 #include <mitkLookupTableProperty.h>
 #include <mitkProperties.h>
+#include <mitkRenderingManager.h>
 #include <mitkSmartPointerProperty.h>
 #include <mitkTransferFunctionProperty.h>
 #include <mitkVtkInterpolationProperty.h>
@@ -29,13 +30,104 @@ found in the LICENSE file.
 
 // VTK
 #include <vtkActor.h>
+#include <vtkCamera.h>
+#include <vtkCellArray.h>
+#include <vtkMath.h>
 #include <vtkPlaneCollection.h>
 #include <vtkPointData.h>
 #include <vtkPolyData.h>
 #include <vtkPolyDataMapper.h>
 #include <vtkPolyDataNormals.h>
 #include <vtkProperty.h>
+#include <vtkQuadricDecimation.h>
 #include <vtkSmartPointer.h>
+#include <vtkTriangleFilter.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace
+{
+  // Smaller surfaces are always rendered at full resolution
+  const vtkIdType MinimumNumberOfPolysForLevelOfDetail = 1000000;
+
+  // The coarsest level of the pyramid has at least this number of polygons
+  const vtkIdType MinimumNumberOfPolysPerLevel = 50000;
+
+  // Polygon budget while the renderer renders interactively
+  const vtkIdType InteractiveNumberOfPolys = 500000;
+
+  // More polygons per pixel of the projected surface do not improve the image
+  const double PolysPerPixel = 4.0;
+
+  vtkIdType GetNumberOfPolys(const mitk::Surface *surface, int timeStep)
+  {
+    auto polyData = nullptr != surface ? surface->GetVtkPolyData(timeStep) : nullptr;
+    return nullptr != polyData ? polyData->GetNumberOfPolys() : 0;
+  }
+
+  // Computes coarser levels of the poly data, each with a quarter of the polygons of the previous one
+  std::vector<vtkSmartPointer<vtkPolyData>> ComputeLevelOfDetailPyramid(vtkPolyData *polyData)
+  {
+    std::vector<vtkSmartPointer<vtkPolyData>> levels;
+    vtkSmartPointer<vtkPolyData> level = polyData;
+
+    // The quadric decimation only supports triangles
+    if (0 < polyData->GetNumberOfStrips() || 3 < polyData->GetPolys()->GetMaxCellSize())
+    {
+      auto triangleFilter = vtkSmartPointer<vtkTriangleFilter>::New();
+      triangleFilter->SetInputData(polyData);
+      triangleFilter->PassVertsOff();
+      triangleFilter->PassLinesOff();
+      triangleFilter->Update();
+      level = triangleFilter->GetOutput();
+    }
+
+    while (4 * MinimumNumberOfPolysPerLevel <= level->GetNumberOfPolys())
+    {
+      auto decimation = vtkSmartPointer<vtkQuadricDecimation>::New();
+      decimation->SetInputData(level);
+      decimation->SetTargetReduction(0.75);
+      decimation->Update();
+
+      level = decimation->GetOutput();
+      levels.push_back(level);
+    }
+
+    return levels;
+  }
+
+  // Returns the area in pixels of the bounding sphere of the geometry projected by the camera of the renderer
+  double GetProjectedArea(mitk::BaseRenderer *renderer, const mitk::BaseGeometry *geometry)
+  {
+    const double windowArea = static_cast<double>(renderer->GetSizeX()) * renderer->GetSizeY();
+    auto camera = renderer->GetVtkRenderer()->GetActiveCamera();
+
+    const double radius = 0.5 * geometry->GetDiagonalLength();
+    double pixelsPerUnit = 0.0;
+
+    if (camera->GetParallelProjection())
+    {
+      pixelsPerUnit = renderer->GetSizeY() / (2.0 * camera->GetParallelScale());
+    }
+    else
+    {
+      mitk::Point3D position(camera->GetPosition());
+      const double distance = position.EuclideanDistanceTo(geometry->GetCenter());
+
+      // the camera is inside of the bounding sphere
+      if (distance <= radius)
+        return windowArea;
+
+      const double halfViewAngle = vtkMath::RadiansFromDegrees(0.5 * camera->GetViewAngle());
+      pixelsPerUnit = renderer->GetSizeY() / (2.0 * distance * std::tan(halfViewAngle));
+    }
+
+    const double pixelRadius = radius * pixelsPerUnit;
+    return std::min(vtkMath::Pi() * pixelRadius * pixelRadius, windowArea);
+  }
+}
 
 const mitk::Surface *mitk::SurfaceVtkMapper3D::GetInput()
 {
@@ -49,6 +141,110 @@ mitk::SurfaceVtkMapper3D::SurfaceVtkMapper3D()
 
 mitk::SurfaceVtkMapper3D::~SurfaceVtkMapper3D()
 {
+  MemoryAccounting::GetInstance().UnregisterCache(this);
+
+  // Pyramids which are not computed yet are not needed anymore
+  for (auto &pyramid : m_LevelOfDetailPyramids)
+    pyramid.second.Token.Cancel();
+}
+
+std::size_t mitk::SurfaceVtkMapper3D::GetCacheSize() const
+{
+  std::size_t size = 0;
+  for (const auto &pyramid : m_LevelOfDetailPyramids)
+  {
+    if (!pyramid.second.IsAvailable)
+      continue;
+
+    for (const auto &level : *pyramid.second.Levels)
+      size += static_cast<std::size_t>(level->GetActualMemorySize()) * 1024;
+  }
+  return size;
+}
+
+void mitk::SurfaceVtkMapper3D::ReleaseCache()
+{
+  for (auto &pyramid : m_LevelOfDetailPyramids)
+    pyramid.second.Token.Cancel();
+  m_LevelOfDetailPyramids.clear();
+}
+
+bool mitk::SurfaceVtkMapper3D::IsLODEnabled(BaseRenderer *renderer) const
+{
+  bool levelOfDetail = false;
+  const auto node = this->GetDataNode();
+
+  if (nullptr == node || !node->GetBoolProperty("Surface.LevelOfDetail", levelOfDetail, renderer) || !levelOfDetail)
+    return false;
+
+  const auto surface = dynamic_cast<const Surface *>(node->GetData());
+  return MinimumNumberOfPolysForLevelOfDetail <= GetNumberOfPolys(surface, this->GetTimestep());
+}
+
+vtkPolyData *mitk::SurfaceVtkMapper3D::GetLevelOfDetail(mitk::BaseRenderer *renderer, vtkPolyData *polyData)
+{
+  // Texture coordinates are not preserved by the decimation
+  if (!this->IsLODEnabled(renderer) || nullptr != this->GetDataNode()->GetProperty("Surface.Texture", renderer))
+    return polyData;
+
+  auto &pyramid = m_LevelOfDetailPyramids[this->GetTimestep()];
+  MemoryAccounting::GetInstance().RegisterCache(this, MemoryAccounting::SurfaceLevelOfDetailType, this->GetInput());
+
+  if (pyramid.Source != polyData || pyramid.SourceMTime != polyData->GetMTime())
+  {
+    pyramid.Token.Cancel();
+    pyramid = LevelOfDetailPyramid();
+    pyramid.Source = polyData;
+    pyramid.SourceMTime = polyData->GetMTime();
+    pyramid.Levels = std::make_shared<std::vector<vtkSmartPointer<vtkPolyData>>>();
+
+    // The background task works on a shallow copy, since connecting a filter to the
+    // poly data would modify its pipeline information while it is rendered
+    auto source = vtkSmartPointer<vtkPolyData>::New();
+    source->ShallowCopy(polyData);
+
+    auto levels = pyramid.Levels;
+    pyramid.Future = ThreadPool::GetInstance().Submit(
+      [source, levels]() { *levels = ComputeLevelOfDetailPyramid(source); },
+      ThreadPool::Priority::Background,
+      pyramid.Token);
+  }
+
+  if (!pyramid.IsAvailable)
+  {
+    if (std::future_status::ready != pyramid.Future.wait_for(std::chrono::seconds(0)))
+      return polyData;
+
+    try
+    {
+      pyramid.Future.get();
+    }
+    catch (const std::exception &e)
+    {
+      MITK_WARN << "Could not compute the level of detail of a surface: " << e.what();
+      pyramid.Levels->clear();
+    }
+
+    pyramid.IsAvailable = true;
+  }
+
+  const auto geometry = this->GetInput()->GetGeometry(this->GetTimestep());
+  auto budget = static_cast<vtkIdType>(PolysPerPixel * GetProjectedArea(renderer, geometry));
+
+  if (0 == RenderingManager::GetInstance()->GetNextLOD(renderer))
+    budget = std::min(budget, InteractiveNumberOfPolys);
+
+  vtkPolyData *levelOfDetail = polyData;
+
+  for (const auto &level : *pyramid.Levels)
+  {
+    if (levelOfDetail->GetNumberOfPolys() <= budget)
+      break;
+
+    levelOfDetail = level;
+  }
+
+  return levelOfDetail;
 }
 
 void mitk::SurfaceVtkMapper3D::GenerateDataForRenderer(mitk::BaseRenderer *renderer)
@@ -74,6 +270,9 @@ void mitk::SurfaceVtkMapper3D::GenerateDataForRenderer(mitk::BaseRenderer *rende
     ls->m_Actor->VisibilityOff();
     return;
   }
+
+  polydata = this->GetLevelOfDetail(renderer, polydata);
+
   if (m_GenerateNormals)
   {
     ls->m_VtkPolyDataNormals->SetInputData(polydata);
@@ -509,11 +708,16 @@ void mitk::SurfaceVtkMapper3D::SetDefaultProperties(mitk::DataNode *node, mitk::
   node->AddProperty("Backface Culling", mitk::BoolProperty::New(false), renderer, overwrite);
 
   node->AddProperty("Depth Sorting", mitk::BoolProperty::New(false), renderer, overwrite);
+  node->AddProperty("Surface.LevelOfDetail", mitk::BoolProperty::New(true), renderer, overwrite);
   mitk::CoreServicePointer<mitk::IPropertyDescriptions> propDescService(mitk::CoreServices::GetPropertyDescriptions());
   propDescService->AddDescription(
     "Depth Sorting",
     "Enables correct rendering for transparent objects by ordering polygons according to the distance "
     "to the camera. It is not recommended to enable this property for large surfaces (rendering might "
     "be slow).");
+  propDescService->AddDescription(
+    "Surface.LevelOfDetail",
+    "Renders surfaces with at least a million polygons with a decimated level of detail while interacting "
+    "or if the surface covers only few pixels. The levels are computed in the background.");
   Superclass::SetDefaultProperties(node, renderer, overwrite);
 }
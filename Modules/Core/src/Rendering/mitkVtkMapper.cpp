@@ -12,6 +12,15 @@ found in the LICENSE file.
 
 #include "mitkVtkMapper.h"
 
+namespace
+{
+  const mitk::PropertyKey &GetVisibleKey()
+  {
+    static const mitk::PropertyKey visibleKey("visible");
+    return visibleKey;
+  }
+}
+
 mitk::VtkMapper::VtkMapper()
 {
 }
@@ -47,7 +56,7 @@ bool mitk::VtkMapper::IsVtkBased() const
 void mitk::VtkMapper::MitkRenderOverlay(BaseRenderer *renderer)
 {
   bool visible = true;
-  GetDataNode()->GetVisibility(visible, renderer, "visible");
+  GetDataNode()->GetBoolProperty(GetVisibleKey(), visible, renderer);
   if (!visible)
     return;
 
@@ -61,7 +70,7 @@ void mitk::VtkMapper::MitkRenderOpaqueGeometry(BaseRenderer *renderer)
 {
   bool visible = true;
 
-  GetDataNode()->GetVisibility(visible, renderer, "visible");
+  GetDataNode()->GetBoolProperty(GetVisibleKey(), visible, renderer);
   if (!visible)
     return;
 
@@ -74,7 +83,7 @@ void mitk::VtkMapper::MitkRenderOpaqueGeometry(BaseRenderer *renderer)
 void mitk::VtkMapper::MitkRenderTranslucentGeometry(BaseRenderer *renderer)
 {
   bool visible = true;
-  GetDataNode()->GetVisibility(visible, renderer, "visible");
+  GetDataNode()->GetBoolProperty(GetVisibleKey(), visible, renderer);
   if (!visible)
     return;
 
@@ -87,7 +96,7 @@ void mitk::VtkMapper::MitkRenderTranslucentGeometry(BaseRenderer *renderer)
 void mitk::VtkMapper::MitkRenderVolumetricGeometry(BaseRenderer *renderer)
 {
   bool visible = true;
-  GetDataNode()->GetVisibility(visible, renderer, "visible");
+  GetDataNode()->GetBoolProperty(GetVisibleKey(), visible, renderer);
   if (!visible)
     return;
 
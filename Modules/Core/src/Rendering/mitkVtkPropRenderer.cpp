@@ -171,10 +171,15 @@ int mitk::VtkPropRenderer::Render(mitk::VtkPropRenderer::RenderType type)
   }
 
   // go through the generated list and let the sorted mappers paint
+  RenderingProfiler *profiler = this->GetRenderingProfiler();
+  const bool profiling = profiler->GetEnabled();
   for (auto it = m_MappersMap.cbegin(); it != m_MappersMap.cend(); it++)
   {
     Mapper *mapper = (*it).second;
+    const double start = profiling ? profiler->GetTime() : 0.0;
     mapper->MitkRender(this, type);
+    if (profiling)
+      profiler->AddMapperRenderTime(mapper, profiler->GetTime() - start);
   }
 
   // Render text
@@ -230,6 +235,9 @@ void mitk::VtkPropRenderer::PrepareMapperQueue()
 
   DataStorage::SetOfObjects::ConstPointer allObjects = m_DataStorage->GetAll();
 
+  static const PropertyKey visibleKey("visible");
+  static const PropertyKey layerKey("layer");
+
   for (DataStorage::SetOfObjects::ConstIterator it = allObjects->Begin(); it != allObjects->End(); ++it)
   {
     const DataNode::Pointer node = it->Value();
@@ -241,7 +249,7 @@ void mitk::VtkPropRenderer::PrepareMapperQueue()
       continue;
 
     bool visible = true;
-    node->GetVisibility(visible, this, "visible");
+    node->GetBoolProperty(visibleKey, visible, this);
 
     // The information about LOD-enabled mappers is required by RenderingManager
     if (mapper->IsLODEnabled(this) && visible)
@@ -250,7 +258,7 @@ void mitk::VtkPropRenderer::PrepareMapperQueue()
     }
     // mapper without a layer property get layer number 1
     int layer = 1;
-    node->GetIntProperty("layer", layer, this);
+    node->GetIntProperty(layerKey, layer, this);
     int nr = (layer << 16) + mapperNo;
     m_MappersMap.insert(std::pair<int, Mapper *>(nr, mapper));
     mapperNo++;
@@ -294,7 +302,12 @@ void mitk::VtkPropRenderer::Update(mitk::DataNode *datatreenode)
     {
       if (GetCurrentWorldPlaneGeometry()->IsValid())
       {
+        RenderingProfiler *profiler = this->GetRenderingProfiler();
+        const bool profiling = profiler->GetEnabled();
+        const double start = profiling ? profiler->GetTime() : 0.0;
         mapper->Update(this);
+        if (profiling)
+          profiler->AddMapperUpdateTime(mapper, profiler->GetTime() - start);
         {
           auto *vtkmapper = dynamic_cast<VtkMapper *>(mapper.GetPointer());
           if (vtkmapper != nullptr)
@@ -341,12 +354,43 @@ void mitk::VtkPropRenderer::InitRenderer(vtkRenderWindow *renderWindow)
     return;
   }
 
+  // frames of the rendering profiler
+  vtkCallbackCommand *frameStartCallbackCommand = vtkCallbackCommand::New();
+  frameStartCallbackCommand->SetCallback(VtkPropRenderer::FrameStartCallback);
+  renderWindow->AddObserver(vtkCommand::StartEvent, frameStartCallbackCommand);
+  frameStartCallbackCommand->Delete();
+
+  vtkCallbackCommand *frameEndCallbackCommand = vtkCallbackCommand::New();
+  frameEndCallbackCommand->SetCallback(VtkPropRenderer::FrameEndCallback);
+  renderWindow->AddObserver(vtkCommand::EndEvent, frameEndCallbackCommand);
+  frameEndCallbackCommand->Delete();
+
   m_InitNeeded = true;
   m_ResizeNeeded = true;
 
   m_LastUpdateTime = 0;
 }
 
+void mitk::VtkPropRenderer::FrameStartCallback(vtkObject *caller, unsigned long, void *, void *)
+{
+  auto *renderWindow = dynamic_cast<vtkRenderWindow *>(caller);
+  if (!renderWindow)
+    return;
+  mitk::BaseRenderer *renderer = mitk::BaseRenderer::GetInstance(renderWindow);
+  if (renderer)
+    renderer->GetRenderingProfiler()->StartFrame();
+}
+
+void mitk::VtkPropRenderer::FrameEndCallback(vtkObject *caller, unsigned long, void *, void *)
+{
+  auto *renderWindow = dynamic_cast<vtkRenderWindow *>(caller);
+  if (!renderWindow)
+    return;
+  mitk::BaseRenderer *renderer = mitk::BaseRenderer::GetInstance(renderWindow);
+  if (renderer)
+    renderer->GetRenderingProfiler()->EndFrame();
+}
+
 void mitk::VtkPropRenderer::RenderingCallback(vtkObject *caller, unsigned long, void *, void *)
 {
   auto *renderWindowInteractor = dynamic_cast<vtkRenderWindowInteractor *>(caller);
@@ -0,0 +1,401 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "vtkMitkLevelWindowShaderMapper.h"
+
+#include <vtkDataArray.h>
+#include <vtkObjectFactory.h>
+#include <vtkOpenGLHelper.h>
+#include <vtkOpenGLRenderWindow.h>
+#include <vtkPointData.h>
+#include <vtkRenderer.h>
+#include <vtkShaderProgram.h>
+#include <vtkTextureObject.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkWeakPointer.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace
+{
+  // larger tables are rare and are mapped on the CPU by vtkMitkLevelWindowFilter
+  const vtkIdType MaximumNumberOfColors = 4096;
+
+  const char *VertexShaderDeclarations = "//VTK::TCoord::Dec\n"
+                                         "in vec2 tcoordMC;\n"
+                                         "out vec2 levelWindowTCoordVSOutput;\n";
+
+  const char *VertexShaderImplementation = "//VTK::TCoord::Impl\n"
+                                           "levelWindowTCoordVSOutput = tcoordMC;\n";
+
+  const char *FragmentShaderDeclarations =
+    "//VTK::TCoord::Dec\n"
+    "in vec2 levelWindowTCoordVSOutput;\n"
+    "uniform sampler2D levelWindowSlice;\n"
+    "uniform sampler2D levelWindowLookupTable;\n"
+    "uniform int levelWindowNumberOfColors;\n"
+    "uniform vec2 levelWindowScaleBias;\n"
+    "uniform vec4 levelWindowClippingBounds;\n"
+    "uniform int levelWindowInterpolate;\n"
+    "uniform float levelWindowOutlineWidth;\n"
+    "vec4 levelWindowColor(ivec2 pixel)\n"
+    "{\n"
+    "  ivec2 size = textureSize(levelWindowSlice, 0);\n"
+    "  if (any(lessThan(pixel, ivec2(0))) || any(greaterThanEqual(pixel, size)) ||\n"
+    "      float(pixel.x) < levelWindowClippingBounds.x || float(pixel.x) >= levelWindowClippingBounds.y ||\n"
+    "      float(pixel.y) < levelWindowClippingBounds.z || float(pixel.y) >= levelWindowClippingBounds.w)\n"
+    "  {\n"
+    "    return vec4(0.0);\n"
+    "  }\n"
+    "  float value = texelFetch(levelWindowSlice, pixel, 0).r;\n"
+    "  float index = clamp(floor(value * levelWindowScaleBias.x + levelWindowScaleBias.y),\n"
+    "                      0.0, float(levelWindowNumberOfColors - 1));\n"
+    "  return texelFetch(levelWindowLookupTable, ivec2(int(index), 0), 0);\n"
+    "}\n";
+
+  // same rounding as vtkApplyLookupTableOnScalarsFast() in vtkMitkLevelWindowFilter
+  const char *FragmentShaderImplementation =
+    "//VTK::TCoord::Impl\n"
+    "vec2 levelWindowPosition = levelWindowTCoordVSOutput * vec2(textureSize(levelWindowSlice, 0));\n"
+    "vec2 levelWindowPixelsPerFragment = fwidth(levelWindowPosition);\n"
+    "ivec2 levelWindowPixel = ivec2(floor(levelWindowPosition));\n"
+    "if (levelWindowOutlineWidth > 0.0)\n"
+    "{\n"
+    "  vec2 border = levelWindowOutlineWidth * levelWindowPixelsPerFragment;\n"
+    "  vec2 offset = fract(levelWindowPosition);\n"
+    "  if (levelWindowColor(levelWindowPixel).a == 0.0 ||\n"
+    "      !((offset.x < border.x && levelWindowColor(levelWindowPixel - ivec2(1, 0)).a == 0.0) ||\n"
+    "        (1.0 - offset.x < border.x && levelWindowColor(levelWindowPixel + ivec2(1, 0)).a == 0.0) ||\n"
+    "        (offset.y < border.y && levelWindowColor(levelWindowPixel - ivec2(0, 1)).a == 0.0) ||\n"
+    "        (1.0 - offset.y < border.y && levelWindowColor(levelWindowPixel + ivec2(0, 1)).a == 0.0)))\n"
+    "  {\n"
+    "    discard;\n"
+    "  }\n"
+    "}\n"
+    "else if (levelWindowInterpolate != 0)\n"
+    "{\n"
+    "  vec2 position = levelWindowPosition - vec2(0.5);\n"
+    "  ivec2 size = textureSize(levelWindowSlice, 0);\n"
+    "  ivec2 pixel = clamp(ivec2(floor(position)), ivec2(0), size - 1);\n"
+    "  ivec2 next = min(pixel + 1, size - 1);\n"
+    "  vec2 weight = clamp(position - floor(position), 0.0, 1.0);\n"
+    "  gl_FragData[0] = gl_FragData[0] *\n"
+    "    mix(mix(levelWindowColor(pixel), levelWindowColor(ivec2(next.x, pixel.y)), weight.x),\n"
+    "        mix(levelWindowColor(ivec2(pixel.x, next.y)), levelWindowColor(next), weight.x), weight.y);\n"
+    "}\n"
+    "else\n"
+    "{\n"
+    "  gl_FragData[0] = gl_FragData[0] * levelWindowColor(levelWindowPixel);\n"
+    "}\n";
+
+  /** Slice textures that can be used by the mappers of all render windows, only accessed by the rendering thread */
+  struct SharedSliceTexture
+  {
+    vtkWeakPointer<vtkImageData> Slice;
+    vtkMTimeType SliceTime;
+    vtkWeakPointer<vtkTextureObject> Texture;
+  };
+
+  bool ShareSliceTextures = false;
+
+  std::vector<SharedSliceTexture> &GetSharedSliceTextures()
+  {
+    static std::vector<SharedSliceTexture> sharedSliceTextures;
+    return sharedSliceTextures;
+  }
+
+  /** Removes the entries of released textures and, if given, of @a texture */
+  void ForgetSharedSliceTextures(vtkTextureObject *texture)
+  {
+    auto &sharedSliceTextures = GetSharedSliceTextures();
+    sharedSliceTextures.erase(std::remove_if(sharedSliceTextures.begin(),
+                                             sharedSliceTextures.end(),
+                                             [texture](const SharedSliceTexture &shared) {
+                                               return shared.Slice == nullptr || shared.Texture == nullptr ||
+                                                      shared.Texture->GetHandle() == 0 ||
+                                                      shared.Texture == texture;
+                                             }),
+                              sharedSliceTextures.end());
+  }
+
+  /** Returns a texture holding the current state of @a slice or nullptr */
+  vtkTextureObject *FindSharedSliceTexture(vtkImageData *slice)
+  {
+    ForgetSharedSliceTextures(nullptr);
+    for (const auto &shared : GetSharedSliceTextures())
+    {
+      if (shared.Slice == slice && shared.SliceTime == slice->GetMTime())
+        return shared.Texture;
+    }
+    return nullptr;
+  }
+
+  template <typename T>
+  void ConvertToFloat(const T *input, vtkIdType count, float *output)
+  {
+    for (vtkIdType i = 0; i < count; ++i)
+      output[i] = static_cast<float>(input[i]);
+  }
+}
+
+vtkStandardNewMacro(vtkMitkLevelWindowShaderMapper);
+
+vtkMitkLevelWindowShaderMapper::vtkMitkLevelWindowShaderMapper()
+  : m_SliceTexture(vtkSmartPointer<vtkTextureObject>::New()),
+    m_LookupTableTexture(vtkSmartPointer<vtkTextureObject>::New()),
+    m_SliceTextureOutdated(true),
+    m_LookupTableTextureOutdated(true),
+    m_ActiveSliceTexture(nullptr),
+    m_ActiveRenderWindow(nullptr),
+    m_TexturesActive(false),
+    m_TextureInterpolation(false),
+    m_OutlineWidth(0.0f)
+{
+  m_ClippingBounds[0] = m_ClippingBounds[2] = std::numeric_limits<float>::lowest();
+  m_ClippingBounds[1] = m_ClippingBounds[3] = std::numeric_limits<float>::max();
+
+  // colors are taken from the lookup table, not from point scalars
+  this->ScalarVisibilityOff();
+}
+
+vtkMitkLevelWindowShaderMapper::~vtkMitkLevelWindowShaderMapper()
+{
+}
+
+void vtkMitkLevelWindowShaderMapper::SetShareSliceTextures(bool share)
+{
+  ShareSliceTextures = share;
+  if (!share)
+    GetSharedSliceTextures().clear();
+}
+
+bool vtkMitkLevelWindowShaderMapper::GetShareSliceTextures()
+{
+  return ShareSliceTextures;
+}
+
+bool vtkMitkLevelWindowShaderMapper::IsSliceSupported(vtkImageData *slice)
+{
+  return slice != nullptr && slice->GetPointData()->GetScalars() != nullptr &&
+         slice->GetNumberOfScalarComponents() == 1 && slice->GetDimensions()[2] == 1;
+}
+
+bool vtkMitkLevelWindowShaderMapper::IsLookupTableSupported(vtkScalarsToColors *lookupTable)
+{
+  auto *table = vtkLookupTable::SafeDownCast(lookupTable);
+  return table != nullptr && table->GetScale() == VTK_SCALE_LINEAR &&
+         table->GetNumberOfColors() <= MaximumNumberOfColors;
+}
+
+void vtkMitkLevelWindowShaderMapper::SetSlice(vtkImageData *slice)
+{
+  if (m_Slice != slice)
+  {
+    m_Slice = slice;
+    m_SliceTextureOutdated = true;
+    this->Modified();
+  }
+}
+
+void vtkMitkLevelWindowShaderMapper::SetImageLookupTable(vtkLookupTable *lookupTable)
+{
+  if (m_ImageLookupTable != lookupTable)
+  {
+    m_ImageLookupTable = lookupTable;
+    m_LookupTableTextureOutdated = true;
+    this->Modified();
+  }
+}
+
+void vtkMitkLevelWindowShaderMapper::SetClippingBounds(double *bounds)
+{
+  for (unsigned int i = 0; i < 4; ++i)
+    m_ClippingBounds[i] = bounds[i];
+}
+
+void vtkMitkLevelWindowShaderMapper::SetTextureInterpolation(bool interpolate)
+{
+  m_TextureInterpolation = interpolate;
+}
+
+void vtkMitkLevelWindowShaderMapper::SetOutlineWidth(float width)
+{
+  m_OutlineWidth = width;
+}
+
+void vtkMitkLevelWindowShaderMapper::ReleaseGraphicsResources(vtkWindow *window)
+{
+  ForgetSharedSliceTextures(m_SliceTexture);
+  m_SliceTexture->ReleaseGraphicsResources(window);
+  m_LookupTableTexture->ReleaseGraphicsResources(window);
+  m_SliceTextureOutdated = true;
+  m_LookupTableTextureOutdated = true;
+
+  this->Superclass::ReleaseGraphicsResources(window);
+}
+
+void vtkMitkLevelWindowShaderMapper::ReplaceShaderValues(std::map<vtkShader::Type, vtkShader *> shaders,
+                                                         vtkRenderer *ren,
+                                                         vtkActor *act)
+{
+  // The actor has no texture, so the superclass leaves the texture coordinate tags alone
+  std::string vertexShader = shaders[vtkShader::Vertex]->GetSource();
+  vtkShaderProgram::Substitute(vertexShader, "//VTK::TCoord::Dec", VertexShaderDeclarations);
+  vtkShaderProgram::Substitute(vertexShader, "//VTK::TCoord::Impl", VertexShaderImplementation);
+  shaders[vtkShader::Vertex]->SetSource(vertexShader);
+
+  std::string fragmentShader = shaders[vtkShader::Fragment]->GetSource();
+  vtkShaderProgram::Substitute(fragmentShader, "//VTK::TCoord::Dec", FragmentShaderDeclarations);
+  vtkShaderProgram::Substitute(fragmentShader, "//VTK::TCoord::Impl", FragmentShaderImplementation);
+  shaders[vtkShader::Fragment]->SetSource(fragmentShader);
+
+  this->Superclass::ReplaceShaderValues(shaders, ren, act);
+}
+
+bool vtkMitkLevelWindowShaderMapper::UploadTextures(vtkRenderer *ren)
+{
+  auto *renderWindow = vtkOpenGLRenderWindow::SafeDownCast(ren->GetRenderWindow());
+
+  if (m_SliceTexture->GetContext() != renderWindow)
+  {
+    m_SliceTexture->SetContext(renderWindow);
+    m_LookupTableTexture->SetContext(renderWindow);
+    m_SliceTextureOutdated = true;
+    m_LookupTableTextureOutdated = true;
+  }
+
+  m_ActiveSliceTexture = m_SliceTexture;
+  if (m_SliceTextureOutdated || m_Slice->GetMTime() > m_SliceUploadTime)
+  {
+    // another render window may display the same slice, e.g. with linked plane geometries
+    vtkTextureObject *sharedTexture = ShareSliceTextures ? FindSharedSliceTexture(m_Slice) : nullptr;
+    if (sharedTexture != nullptr)
+    {
+      m_ActiveSliceTexture = sharedTexture;
+    }
+    else
+    {
+      vtkDataArray *scalars = m_Slice->GetPointData()->GetScalars();
+      const int *dimensions = m_Slice->GetDimensions();
+      std::vector<float> values(scalars->GetNumberOfTuples());
+
+      switch (scalars->GetDataType())
+      {
+        vtkTemplateMacro(ConvertToFloat(
+          static_cast<const VTK_TT *>(scalars->GetVoidPointer(0)), scalars->GetNumberOfTuples(), values.data()));
+        default:
+          vtkErrorMacro(<< "UploadTextures: Unknown ScalarType");
+          return false;
+      }
+
+      m_SliceTexture->SetMinificationFilter(vtkTextureObject::Nearest);
+      m_SliceTexture->SetMagnificationFilter(vtkTextureObject::Nearest);
+      m_SliceTexture->SetWrapS(vtkTextureObject::ClampToEdge);
+      m_SliceTexture->SetWrapT(vtkTextureObject::ClampToEdge);
+      m_SliceTexture->Create2DFromRaw(dimensions[0], dimensions[1], 1, VTK_FLOAT, values.data());
+
+      m_SliceTextureOutdated = false;
+      m_SliceUploadTime.Modified();
+
+      if (ShareSliceTextures)
+      {
+        ForgetSharedSliceTextures(m_SliceTexture);
+        GetSharedSliceTextures().push_back(
+          SharedSliceTexture{m_Slice, m_Slice->GetMTime(), m_SliceTexture.GetPointer()});
+      }
+    }
+  }
+
+  // the table range is passed as uniform, but building the table may change the colors;
+  // re-uploading a few hundred colors is negligible compared to a slice
+  m_ImageLookupTable->Build();
+  if (m_LookupTableTextureOutdated || m_ImageLookupTable->GetMTime() > m_LookupTableUploadTime ||
+      m_ImageLookupTable->GetTable()->GetMTime() > m_LookupTableUploadTime)
+  {
+    m_LookupTableTexture->SetMinificationFilter(vtkTextureObject::Nearest);
+    m_LookupTableTexture->SetMagnificationFilter(vtkTextureObject::Nearest);
+    m_LookupTableTexture->Create2DFromRaw(static_cast<unsigned int>(m_ImageLookupTable->GetNumberOfColors()),
+                                          1,
+                                          4,
+                                          VTK_UNSIGNED_CHAR,
+                                          m_ImageLookupTable->GetTable()->GetVoidPointer(0));
+
+    m_LookupTableTextureOutdated = false;
+    m_LookupTableUploadTime.Modified();
+  }
+  return true;
+}
+
+void vtkMitkLevelWindowShaderMapper::RenderPieceStart(vtkRenderer *ren, vtkActor *act)
+{
+  m_TexturesActive = m_Slice != nullptr && m_ImageLookupTable != nullptr && this->UploadTextures(ren);
+  if (m_TexturesActive)
+  {
+    // a shared slice texture belongs to the context of another render window, so it is bound via this one
+    m_ActiveRenderWindow = vtkOpenGLRenderWindow::SafeDownCast(ren->GetRenderWindow());
+    m_ActiveRenderWindow->ActivateTexture(m_ActiveSliceTexture);
+    m_LookupTableTexture->Activate();
+  }
+
+  this->Superclass::RenderPieceStart(ren, act);
+}
+
+void vtkMitkLevelWindowShaderMapper::RenderPieceFinish(vtkRenderer *ren, vtkActor *act)
+{
+  this->Superclass::RenderPieceFinish(ren, act);
+
+  if (m_TexturesActive)
+  {
+    m_LookupTableTexture->Deactivate();
+    m_ActiveRenderWindow->DeactivateTexture(m_ActiveSliceTexture);
+    m_ActiveRenderWindow = nullptr;
+    m_TexturesActive = false;
+  }
+}
+
+void vtkMitkLevelWindowShaderMapper::SetMapperShaderParameters(vtkOpenGLHelper &cellBO,
+                                                               vtkRenderer *ren,
+                                                               vtkActor *act)
+{
+  this->Superclass::SetMapperShaderParameters(cellBO, ren, act);
+
+  vtkShaderProgram *program = cellBO.Program;
+  if (!m_TexturesActive)
+    return;
+
+  program->SetUniformi("levelWindowSlice", m_ActiveRenderWindow->GetTextureUnitForTexture(m_ActiveSliceTexture));
+  program->SetUniformi("levelWindowLookupTable", m_LookupTableTexture->GetTextureUnit());
+
+  // maps a scalar value to the index of its color, as in vtkApplyLookupTableOnScalarsFast()
+  double tableRange[2] = {0.0, 1.0};
+  int numberOfColors = 1;
+  if (m_ImageLookupTable != nullptr)
+  {
+    m_ImageLookupTable->GetTableRange(tableRange);
+    numberOfColors = static_cast<int>(m_ImageLookupTable->GetNumberOfColors());
+  }
+  const double scale = tableRange[1] - tableRange[0] > 0 ? numberOfColors / (tableRange[1] - tableRange[0]) : 0.0;
+  const float scaleBias[2] = {static_cast<float>(scale), static_cast<float>(-tableRange[0] * scale + 0.5)};
+  program->SetUniform2f("levelWindowScaleBias", scaleBias);
+  program->SetUniformi("levelWindowNumberOfColors", numberOfColors);
+
+  const float clippingBounds[4] = {static_cast<float>(m_ClippingBounds[0]),
+                                   static_cast<float>(m_ClippingBounds[1]),
+                                   static_cast<float>(m_ClippingBounds[2]),
+                                   static_cast<float>(m_ClippingBounds[3])};
+  program->SetUniform4f("levelWindowClippingBounds", clippingBounds);
+
+  program->SetUniformi("levelWindowInterpolate", m_TextureInterpolation ? 1 : 0);
+  program->SetUniformf("levelWindowOutlineWidth", m_OutlineWidth);
+}
@@ -20,8 +20,10 @@ found in the LICENSE file.
 #include "vtkPointData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <cmath>
 #include <sstream>
+#include <vector>
 
 vtkStandardNewMacro(vtkMitkThickSlicesFilter);
 
@@ -105,9 +107,11 @@ int vtkMitkThickSlicesFilter::RequestUpdateExtent(vtkInformation *,
 }
 
 //----------------------------------------------------------------------------
-// This execute method handles boundaries.
-// it handles boundaries. Pixels are just replicated to get values
-// out of extent.
+// Projects all slices of the input slab onto the output extent. The slab is
+// processed row by row: for each output row the corresponding rows of all
+// slices are accumulated with contiguous inner loops, which compilers
+// vectorize, instead of walking through the slab for every single pixel.
+// The threads of vtkThreadedImageAlgorithm work on separate output rows.
 template <class T>
 void vtkMitkThickSlicesFilterExecute(vtkMitkThickSlicesFilter *self,
                                      vtkImageData *inData,
@@ -117,223 +121,132 @@ void vtkMitkThickSlicesFilterExecute(vtkMitkThickSlicesFilter *self,
                                      int outExt[6],
                                      int /*id*/)
 {
-  int idxX, idxY;
-  int maxX, maxY;
-  vtkIdType inIncX, inIncY, inIncZ;
   vtkIdType outIncX, outIncY, outIncZ;
-  // int axesNum;
   int *inExt = inData->GetExtent();
-  int *wholeExtent;
-  vtkIdType *inIncs;
-  // int useYMin, useYMax, useXMin, useXMax;
 
   // find the region to loop over
-  maxX = outExt[1] - outExt[0];
-  maxY = outExt[3] - outExt[2];
-
-  //  maxZ = outExt[5] - outExt[4];
-
-  // Get the dimensionality of the gradient.
-  // axesNum = self->GetDimensionality();
+  const int maxY = outExt[3] - outExt[2];
+  const vtkIdType rowLength = outExt[1] - outExt[0] + 1;
 
   // Get increments to march through data
-  inData->GetContinuousIncrements(outExt, inIncX, inIncY, inIncZ);
   outData->GetContinuousIncrements(outExt, outIncX, outIncY, outIncZ);
-  /*
-// The data spacing is important for computing the gradient.
-// central differences (2 * ratio).
-// Negative because below we have (min - max) for dx ...
-inData->GetSpacing(r);
-r[0] = -0.5 / r[0];
-r[1] = -0.5 / r[1];
-r[2] = -0.5 / r[2];
-    */
-  // get some other info we need
-  inIncs = inData->GetIncrements();
-  wholeExtent = inData->GetExtent();
+  vtkIdType *inIncs = inData->GetIncrements();
 
   // Move the pointer to the correct starting position.
   inPtr += (outExt[0] - inExt[0]) * inIncs[0] + (outExt[2] - inExt[2]) * inIncs[1] + (outExt[4] - inExt[4]) * inIncs[2];
 
-  // Loop through ouput pixels
-
-  int _minZ = /*-5 + outExt[4];  if( _minZ  < wholeExtent[4]) _minZ=*/wholeExtent[4];
-  int _maxZ = /* 5 + outExt[4];  if( _maxZ  > wholeExtent[5]) _maxZ=*/wholeExtent[5];
+  // the whole slab is projected
+  const int _minZ = inExt[4];
+  const int _maxZ = inExt[5];
 
   if (_maxZ < _minZ)
     return;
 
-  double invNum = 1.0 / (_maxZ - _minZ + 1);
+  const double invNum = 1.0 / (_maxZ - _minZ + 1);
+  const int mode = self->GetThickSliceMode();
 
-  switch (self->GetThickSliceMode())
+  std::vector<double> weights;
+  if (mode == vtkMitkThickSlicesFilter::WEIGHTED)
   {
-    default:
-    case vtkMitkThickSlicesFilter::MIP:
+    const int size = _maxZ - _minZ;
+    weights.resize(size);
+    double mean = 0.5 * double(_minZ + _maxZ);
+    double sigma_sq = double(size) / 6.0;
+    sigma_sq *= sigma_sq;
+    double sum = 0;
+    int i = 0;
+    for (int z = _minZ + 1; z <= _maxZ; z++)
     {
-      // MIP
-      for (idxY = 0; idxY <= maxY; idxY++)
-      {
-        // useYMin = ((idxY + outExt[2]) <= wholeExtent[2]) ? 0 : -inIncs[1];
-        // useYMax = ((idxY + outExt[2]) >= wholeExtent[3]) ? 0 : inIncs[1];
-        for (idxX = 0; idxX <= maxX; idxX++)
-        {
-          // useXMin = ((idxX + outExt[0]) <= wholeExtent[0]) ? 0 : -inIncs[0];
-          // useXMax = ((idxX + outExt[0]) >= wholeExtent[1]) ? 0 : inIncs[0];
-
-          T mip = inPtr[_minZ * inIncs[2]];
-
-          for (int z = _minZ + 1; z <= _maxZ; z++)
-          {
-            T value = inPtr[z * inIncs[2]];
-            if (value > mip)
-              mip = value;
-          }
-
-          // do X axis
-          *outPtr = mip;
-          outPtr++;
-          inPtr++;
-        }
-        outPtr += outIncY;
-        inPtr += inIncY;
-      }
+      double val = exp(-(((double)z - mean) / sigma_sq));
+      weights[i++] = val;
+      sum += val;
     }
-    break;
-
-    case vtkMitkThickSlicesFilter::SUM:
+    for (i = 0; i < size; i++)
     {
-      // MIP
-      for (idxY = 0; idxY <= maxY; idxY++)
-      {
-        // useYMin = ((idxY + outExt[2]) <= wholeExtent[2]) ? 0 : -inIncs[1];
-        // useYMax = ((idxY + outExt[2]) >= wholeExtent[3]) ? 0 : inIncs[1];
-        for (idxX = 0; idxX <= maxX; idxX++)
-        {
-          // useXMin = ((idxX + outExt[0]) <= wholeExtent[0]) ? 0 : -inIncs[0];
-          // useXMax = ((idxX + outExt[0]) >= wholeExtent[1]) ? 0 : inIncs[0];
-
-          double sum = 0;
+      weights[i] /= sum;
+    }
+  }
 
-          for (int z = _minZ; z <= _maxZ; z++)
-          {
-            T value = inPtr[z * inIncs[2]];
-            sum += value;
-          }
+  // accumulated values of one row for the averaging modes
+  std::vector<double> rowSum(rowLength);
+  double *sum = rowSum.data();
 
-          // do X axis
-          *outPtr = static_cast<T>(invNum * sum);
-          outPtr++;
-          inPtr++;
-        }
-        outPtr += outIncY;
-        inPtr += inIncY;
-      }
-    }
-    break;
+  for (int idxY = 0; idxY <= maxY; idxY++)
+  {
+    const T *inRow = inPtr + idxY * inIncs[1];
 
-    case vtkMitkThickSlicesFilter::WEIGHTED:
+    switch (mode)
     {
-      const int size = _maxZ - _minZ;
-      std::vector<double> weights(size);
-      double mean = 0.5 * double(_minZ + _maxZ);
-      double sigma_sq = double(size) / 6.0;
-      sigma_sq *= sigma_sq;
-      double sum = 0;
-      int i = 0;
-      for (int z = _minZ + 1; z <= _maxZ; z++)
+      default:
+      case vtkMitkThickSlicesFilter::MIP:
       {
-        double val = exp(-(((double)z - mean) / sigma_sq));
-        weights[i++] = val;
-        sum += val;
-      }
-      for (i = 0; i < size; i++)
-      {
-        weights[i] /= sum;
+        const T *slice = inRow + _minZ * inIncs[2];
+        std::copy(slice, slice + rowLength, outPtr);
+        for (int z = _minZ + 1; z <= _maxZ; z++)
+        {
+          slice = inRow + z * inIncs[2];
+          for (vtkIdType x = 0; x < rowLength; x++)
+            outPtr[x] = slice[x] > outPtr[x] ? slice[x] : outPtr[x];
+        }
       }
+      break;
 
-      for (idxY = 0; idxY <= maxY; idxY++)
+      case vtkMitkThickSlicesFilter::MINIP:
       {
-        // useYMin = ((idxY + outExt[2]) <= wholeExtent[2]) ? 0 : -inIncs[1];
-        // useYMax = ((idxY + outExt[2]) >= wholeExtent[3]) ? 0 : inIncs[1];
-        for (idxX = 0; idxX <= maxX; idxX++)
+        const T *slice = inRow + _minZ * inIncs[2];
+        std::copy(slice, slice + rowLength, outPtr);
+        for (int z = _minZ + 1; z <= _maxZ; z++)
         {
-          // useXMin = ((idxX + outExt[0]) <= wholeExtent[0]) ? 0 : -inIncs[0];
-          // useXMax = ((idxX + outExt[0]) >= wholeExtent[1]) ? 0 : inIncs[0];
-
-          T mip = inPtr[_minZ * inIncs[2]];
-          i = 0;
-          double mymip = 0;
-          for (int z = _minZ + 1; z <= _maxZ; z++)
-          {
-            double value = inPtr[z * inIncs[2]];
-            mymip += value * weights[i++];
-          }
-          mip = static_cast<T>(mymip);
-          // do X axis
-          *outPtr = mip;
-          outPtr++;
-          inPtr++;
+          slice = inRow + z * inIncs[2];
+          for (vtkIdType x = 0; x < rowLength; x++)
+            outPtr[x] = slice[x] < outPtr[x] ? slice[x] : outPtr[x];
         }
-        outPtr += outIncY;
-        inPtr += inIncY;
       }
-    }
-    break;
+      break;
 
-    case vtkMitkThickSlicesFilter::MINIP:
-    {
-      for (idxY = 0; idxY <= maxY; idxY++)
+      case vtkMitkThickSlicesFilter::SUM:
+      case vtkMitkThickSlicesFilter::MEAN:
       {
-        for (idxX = 0; idxX <= maxX; idxX++)
+        std::fill(sum, sum + rowLength, 0.0);
+        for (int z = _minZ; z <= _maxZ; z++)
         {
-          T mip = inPtr[_minZ * inIncs[2]];
-
-          for (int z = _minZ + 1; z <= _maxZ; z++)
-          {
-            T value = inPtr[z * inIncs[2]];
-            if (value < mip)
-              mip = value;
-          }
-
-          // do X axis
-          *outPtr = mip;
-          outPtr++;
-          inPtr++;
+          const T *slice = inRow + z * inIncs[2];
+          for (vtkIdType x = 0; x < rowLength; x++)
+            sum[x] += slice[x];
         }
-        outPtr += outIncY;
-        inPtr += inIncY;
-      }
-    }
-    break;
 
-    case vtkMitkThickSlicesFilter::MEAN:
-    {
-      const int size = _maxZ - _minZ;
+        if (mode == vtkMitkThickSlicesFilter::SUM)
+        {
+          for (vtkIdType x = 0; x < rowLength; x++)
+            outPtr[x] = static_cast<T>(invNum * sum[x]);
+        }
+        else
+        {
+          // MEAN historically divides by the number of slices minus one
+          const double size = std::max(1, _maxZ - _minZ);
+          for (vtkIdType x = 0; x < rowLength; x++)
+            outPtr[x] = static_cast<T>(sum[x] / size);
+        }
+      }
+      break;
 
-      // MEAN
-      for (idxY = 0; idxY <= maxY; idxY++)
+      case vtkMitkThickSlicesFilter::WEIGHTED:
       {
-        for (idxX = 0; idxX <= maxX; idxX++)
+        std::fill(sum, sum + rowLength, 0.0);
+        for (int z = _minZ + 1; z <= _maxZ; z++)
         {
-          long double sum = 0;
-          for (int z = _minZ; z <= _maxZ; z++)
-          {
-            T value = inPtr[z * inIncs[2]];
-            sum += value;
-          }
-
-          T mip = static_cast<T>(sum / size);
-
-          // do X axis
-          *outPtr = mip;
-          outPtr++;
-          inPtr++;
+          const T *slice = inRow + z * inIncs[2];
+          const double weight = weights[z - _minZ - 1];
+          for (vtkIdType x = 0; x < rowLength; x++)
+            sum[x] += slice[x] * weight;
         }
-        outPtr += outIncY;
-        inPtr += inIncY;
+        for (vtkIdType x = 0; x < rowLength; x++)
+          outPtr[x] = static_cast<T>(sum[x]);
       }
+      break;
     }
-    break;
+
+    outPtr += rowLength + outIncY;
   }
 }
 
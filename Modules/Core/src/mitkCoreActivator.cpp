@@ -27,6 +27,7 @@ found in the LICENSE file.
 #include <mitkSurfaceStlIO.h>
 #include <mitkSurfaceVtkLegacyIO.h>
 #include <mitkSurfaceVtkXmlIO.h>
+#include <mitkTracing.h>
 
 #include "mitkLegacyFileWriterService.h"
 #include <mitkFileWriter.h>
@@ -54,6 +55,8 @@ found in the LICENSE file.
 // method), we include the ITK header here.
 #include <itkImageIOFactoryRegisterManager.h>
 
+#include <cstdlib>
+
 void HandleMicroServicesMessages(us::MsgType type, const char *msg)
 {
   switch (type)
@@ -128,6 +131,14 @@ void MitkCoreActivator::Load(us::ModuleContext *context)
 
   this->m_Context = context;
 
+  // record a trace of the whole session if the environment provides a trace file
+  const char *traceFilePath = std::getenv("MITK_TRACE");
+  if (traceFilePath != nullptr && *traceFilePath != '\0')
+  {
+    m_TraceFilePath = traceFilePath;
+    mitk::Tracing::SetEnabled(true);
+  }
+
   // Add the current application directory to the auto-load paths.
   // This is useful for third-party executables.
   std::string programPath = mitk::IOUtil::GetProgramPath();
@@ -192,6 +203,12 @@ void MitkCoreActivator::Load(us::ModuleContext *context)
 
 void MitkCoreActivator::Unload(us::ModuleContext *)
 {
+  if (!m_TraceFilePath.empty())
+  {
+    mitk::Tracing::WriteChromeTrace(m_TraceFilePath);
+    mitk::Tracing::SetEnabled(false);
+  }
+
   for (auto &elem : m_FileReaders)
   {
     delete elem;
@@ -75,6 +75,9 @@ private:
   us::ServiceRegistration<mitk::IMimeTypeProvider> m_MimeTypeProviderReg;
 
   us::ModuleContext *m_Context;
+
+  /** File the trace of the session is written to, see the MITK_TRACE environment variable */
+  std::string m_TraceFilePath;
 };
 
 #endif // MITKCOREACTIVATOR_H_
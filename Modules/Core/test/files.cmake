@@ -37,6 +37,18 @@ set(MODULE_TESTS
   mitkGeometryDataToSurfaceFilterTest.cpp
   mitkImageCastTest.cpp
   mitkImageDataItemTest.cpp
+  mitkImageExtremaAccumulatorTest.cpp
+  mitkImageModifiedRegionTest.cpp
+  mitkImageSliceCacheTest.cpp
+  mitkImageSlicePrefetcherTest.cpp
+  mitkRenderingProfilerTest.cpp
+  mitkSurfaceCutLocatorTest.cpp
+  mitkLevelWindowShaderMapperTest.cpp
+  mitkImageStatisticsHolderAsyncTest.cpp
+  mitkImageAccessorConcurrencyTest.cpp
+  mitkImageVolumeProviderTest.cpp
+  mitkMemoryAccountingTest.cpp
+  mitkBrickedImageVolumeTest.cpp
   mitkImageGeneratorTest.cpp
   mitkIOUtilTest.cpp
   mitkBaseDataTest.cpp
@@ -68,6 +80,7 @@ set(MODULE_TESTS
   mitkSurfaceToSurfaceFilterTest.cpp
   mitkTimeGeometryTest.cpp
   mitkProportionalTimeGeometryTest.cpp
+  mitkLimitedLinearUndoTest.cpp
   mitkUndoControllerTest.cpp
   mitkVtkWidgetRenderingTest.cpp
   mitkVerboseLimitedLinearUndoTest.cpp
@@ -76,6 +89,7 @@ set(MODULE_TESTS
   mitkStepperTest.cpp
   mitkRenderingManagerTest.cpp
   mitkCompositePixelValueToStringTest.cpp
+  mitkImagePixelValueLookupTest.cpp
   vtkMitkThickSlicesFilterTest.cpp
   mitkNodePredicateSourceTest.cpp
   mitkNodePredicateDataPropertyTest.cpp
@@ -123,6 +137,8 @@ set(MODULE_TESTS
   mitkSurfaceVtkMapper2DTest.cpp #new rendering test in CppUnit style
   mitkSurfaceVtkMapper2D3DTest.cpp # comparisons/consistency 2D/3D
   mitkTemporalJoinImagesFilterTest.cpp
+  mitkThreadPoolTest.cpp
+  mitkTracingTest.cpp
 )
 
 # test with image filename as an extra command line parameter
@@ -16,6 +16,7 @@ found in the LICENSE file.
 
 #include <mitkITKImageImport.h>
 #include <mitkImageAccessByItk.h>
+#include <mitkImageAccessByItkDispatch.h>
 
 #define TestImageType(type, dim)                                                                                       \
   MITK_TEST_CONDITION(typeid(type) == typeid(TPixel) && dim == VDimension,                                             \
@@ -167,6 +168,50 @@ public:
     MITK_TEST_FOR_EXCEPTION_END(mitk::AccessByItkException)
   }
 
+  void testAccessHotPixelTypeByItk()
+  {
+    mitk::Image::Pointer mitkIntImage2D = createMitkImage<IntImage2D>();
+    mitk::Image::Pointer mitkFloatImage3D = createMitkImage<FloatImage3D>();
+
+    AccessHotPixelTypeByItk(mitkFloatImage3D, AccessItkImage);
+    AccessHotPixelTypeByItk_n(mitkFloatImage3D, AccessItkImage, (Float3D, 2));
+
+    // Test for wrong pixel type (int is not a hot pixel type)
+    MITK_TEST_FOR_EXCEPTION_BEGIN(mitk::AccessByItkException)
+    AccessHotPixelTypeByItk(mitkIntImage2D, AccessItkImage);
+    MITK_TEST_FOR_EXCEPTION_END(mitk::AccessByItkException)
+  }
+
+  void testAccessByItkDispatcher()
+  {
+    typedef mitk::AccessByItkDispatcher<mitk::AccessPixelTypes<int, float>, mitk::AccessDimensions<2, 3>> Dispatcher;
+
+    mitk::Image::Pointer mitkIntImage2D = createMitkImage<IntImage2D>();
+    mitk::Image::ConstPointer mitkIntImage3D(createMitkImage<IntImage3D>());
+    mitk::Image::ConstPointer mitkFloatImage2D(createMitkImage<FloatImage2D>());
+    mitk::Image::Pointer mitkFloatImage3D = createMitkImage<FloatImage3D>();
+
+    auto access = [this](auto itkImage, EImageType imageType, int param2) {
+      this->AccessItkImage(itkImage, imageType, param2);
+    };
+
+    Dispatcher::Dispatch(mitkIntImage2D.GetPointer(), access, Int2D, 2);
+    Dispatcher::Dispatch(mitkIntImage3D.GetPointer(), access, Int3D, 2);
+    Dispatcher::Dispatch(mitkFloatImage2D.GetPointer(), access, Float2D, 2);
+    Dispatcher::Dispatch(mitkFloatImage3D.GetPointer(), access, Float3D, 2);
+
+    // Test for wrong pixel type
+    MITK_TEST_FOR_EXCEPTION_BEGIN(mitk::AccessByItkException)
+    mitk::AccessByItkDispatcher<mitk::AccessHotPixelTypes>::Dispatch(mitkIntImage2D.GetPointer(), access, Int2D, 2);
+    MITK_TEST_FOR_EXCEPTION_END(mitk::AccessByItkException)
+
+    // Test for wrong dimension
+    MITK_TEST_FOR_EXCEPTION_BEGIN(mitk::AccessByItkException)
+    mitk::AccessByItkDispatcher<mitk::AccessPixelTypes<float>, mitk::AccessDimensions<2>>::Dispatch(
+      mitkFloatImage3D.GetPointer(), access, Float3D, 2);
+    MITK_TEST_FOR_EXCEPTION_END(mitk::AccessByItkException)
+  }
+
   void testAccessTwoImagesFixedDimensionByItk()
   {
     mitk::Image::Pointer mitkIntImage2D = createMitkImage<IntImage2D>();
@@ -299,6 +344,12 @@ int mitkAccessByItkTest(int /*argc*/, char * /*argv*/ [])
   MITK_TEST_OUTPUT(<< "Testing AccessFixedPixelTypeByItk macro")
   accessTest.testAccessFixedPixelTypeByItk();
 
+  MITK_TEST_OUTPUT(<< "Testing AccessHotPixelTypeByItk macro")
+  accessTest.testAccessHotPixelTypeByItk();
+
+  MITK_TEST_OUTPUT(<< "Testing AccessByItkDispatcher")
+  accessTest.testAccessByItkDispatcher();
+
   MITK_TEST_OUTPUT(<< "Testing AccessTwoImagesFixedDimensionByItk macro")
   accessTest.testAccessTwoImagesFixedDimensionByItk();
 
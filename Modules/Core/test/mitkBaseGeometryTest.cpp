@@ -33,6 +33,8 @@ found in the LICENSE file.
 #include <mitkMatrixConvert.h>
 #include <mitkRotationOperation.h>
 #include <mitkScaleOperation.h>
+#include <cmath>
+#include <vector>
 
 class vtkMatrix4x4;
 class vtkMatrixToLinearTransform;
@@ -110,6 +112,7 @@ class mitkBaseGeometryTestSuite : public mitk::TestFixture
   MITK_TEST(TestComposeVtkMatrix);
   MITK_TEST(TestTranslate);
   MITK_TEST(TestIndexToWorld);
+  MITK_TEST(TestIndexToWorldForPointArrays);
   MITK_TEST(TestExecuteOperation);
   MITK_TEST(TestCalculateBoundingBoxRelToTransform);
   // MITK_TEST(TestSetTimeBounds);
@@ -899,6 +902,49 @@ public:
     testIndexAndWorldConsistencyForIndex(dummy);
   }
 
+  void TestIndexToWorldForPointArrays()
+  {
+    DummyTestClass::Pointer dummy = DummyTestClass::New();
+    dummy->SetOrigin(anotherPoint);
+    dummy->SetSpacing(anotherSpacing);
+    CPPUNIT_ASSERT(dummy->IsIndexToWorldTransformAxisAligned());
+    testIndexAndWorldConsistencyForPointArrays(dummy);
+
+    mitk::AffineTransform3D::MatrixType rotation;
+    rotation.SetIdentity();
+    rotation(0, 0) = rotation(1, 1) = std::cos(0.3);
+    rotation(0, 1) = -std::sin(0.3);
+    rotation(1, 0) = std::sin(0.3);
+    dummy->GetIndexToWorldTransform()->SetMatrix(rotation * dummy->GetIndexToWorldTransform()->GetMatrix());
+    CPPUNIT_ASSERT(!dummy->IsIndexToWorldTransformAxisAligned());
+    testIndexAndWorldConsistencyForPointArrays(dummy);
+  }
+
+  void testIndexAndWorldConsistencyForPointArrays(DummyTestClass::Pointer dummyGeometry)
+  {
+    const mitk::AffineTransform3D *transform = dummyGeometry->GetIndexToWorldTransform();
+    std::vector<mitk::Point3D> indices(10);
+
+    for (std::size_t i = 0; i < indices.size(); ++i)
+      mitk::FillVector3D(indices[i], 0.5 * i, 3.0 - i, 2.0 * i - 7.0);
+
+    std::vector<mitk::Point3D> points(indices.size());
+    dummyGeometry->IndexToWorld(indices.data(), points.data(), indices.size());
+
+    std::vector<mitk::Point3D> backTransformed(points);
+    dummyGeometry->WorldToIndex(backTransformed.data(), backTransformed.data(), backTransformed.size());
+
+    for (std::size_t i = 0; i < indices.size(); ++i)
+    {
+      CPPUNIT_ASSERT(mitk::Equal(transform->TransformPoint(indices[i]), points[i]));
+      CPPUNIT_ASSERT(mitk::Equal(indices[i], backTransformed[i]));
+
+      mitk::Point3D point;
+      dummyGeometry->IndexToWorld(indices[i], point);
+      CPPUNIT_ASSERT(mitk::Equal(points[i], point));
+    }
+  }
+
   void TestExecuteOperation()
   {
     DummyTestClass::Pointer dummy = DummyTestClass::New();
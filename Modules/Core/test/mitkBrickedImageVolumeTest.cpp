@@ -0,0 +1,228 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkBrickedImageVolume.h>
+#include <mitkExtractSliceFilter.h>
+#include <mitkImage.h>
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkPlaneGeometry.h>
+
+#include <vtkImageData.h>
+
+#include <array>
+#include <vector>
+
+class mitkBrickedImageVolumeTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkBrickedImageVolumeTestSuite);
+  MITK_TEST(GetPixel_AllVoxels_MatchScanlineData);
+  MITK_TEST(ExtractSlice_OrthogonalSections_MatchScanlineData);
+  MITK_TEST(ExtractSlice_OutsideVolume_ReturnsBackground);
+  MITK_TEST(GetBrickedVolume_ModifiedImage_IsRecreated);
+  MITK_TEST(ExtractSliceFilter_BrickedLayout_EqualsReslicer);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  std::array<unsigned int, 3> m_Dimensions;
+  std::vector<short> m_Data;
+  mitk::Image::Pointer m_Image;
+
+  short GetValue(int x, int y, int z) const
+  {
+    return m_Data[x + m_Dimensions[0] * (y + m_Dimensions[1] * z)];
+  }
+
+public:
+  void setUp() override
+  {
+    // deliberately not a multiple of the brick edge length
+    m_Dimensions = {{37, 21, 45}};
+    m_Data.resize(m_Dimensions[0] * m_Dimensions[1] * m_Dimensions[2]);
+    for (size_t i = 0; i < m_Data.size(); ++i)
+      m_Data[i] = static_cast<short>(i % 30011);
+
+    m_Image = mitk::Image::New();
+    m_Image->Initialize(mitk::MakeScalarPixelType<short>(), 3, m_Dimensions.data());
+    m_Image->SetVolume(m_Data.data());
+  }
+
+  void tearDown() override
+  {
+    m_Image = nullptr;
+    m_Data.clear();
+  }
+
+  void GetPixel_AllVoxels_MatchScanlineData()
+  {
+    auto bricked = mitk::BrickedImageVolume::New();
+    bricked->Initialize(m_Data.data(), m_Dimensions.data(), sizeof(short), 8);
+    CPPUNIT_ASSERT_EQUAL(8u, bricked->GetBrickEdgeLength());
+
+    for (unsigned int z = 0; z < m_Dimensions[2]; ++z)
+      for (unsigned int y = 0; y < m_Dimensions[1]; ++y)
+        for (unsigned int x = 0; x < m_Dimensions[0]; ++x)
+          CPPUNIT_ASSERT_EQUAL(GetValue(x, y, z), *static_cast<const short *>(bricked->GetPixel(x, y, z)));
+  }
+
+  void ExtractSlice_OrthogonalSections_MatchScanlineData()
+  {
+    auto bricked = mitk::BrickedImageVolume::New();
+    bricked->Initialize(m_Data.data(), m_Dimensions.data(), sizeof(short), 8);
+    const short background = -1;
+
+    // sagittal section with flipped rows
+    {
+      const int origin[3] = {11, 0, static_cast<int>(m_Dimensions[2]) - 1};
+      const int stepI[3] = {0, 1, 0};
+      const int stepJ[3] = {0, 0, -1};
+      std::vector<short> slice(m_Dimensions[1] * m_Dimensions[2]);
+      bricked->ExtractSlice(origin, stepI, stepJ, m_Dimensions[1], m_Dimensions[2], &background, slice.data());
+
+      for (unsigned int j = 0; j < m_Dimensions[2]; ++j)
+        for (unsigned int i = 0; i < m_Dimensions[1]; ++i)
+          CPPUNIT_ASSERT_EQUAL(GetValue(11, i, m_Dimensions[2] - 1 - j), slice[i + j * m_Dimensions[1]]);
+    }
+
+    // coronal section with swapped axes
+    {
+      const int origin[3] = {0, 7, 0};
+      const int stepI[3] = {0, 0, 1};
+      const int stepJ[3] = {1, 0, 0};
+      std::vector<short> slice(m_Dimensions[2] * m_Dimensions[0]);
+      bricked->ExtractSlice(origin, stepI, stepJ, m_Dimensions[2], m_Dimensions[0], &background, slice.data());
+
+      for (unsigned int j = 0; j < m_Dimensions[0]; ++j)
+        for (unsigned int i = 0; i < m_Dimensions[2]; ++i)
+          CPPUNIT_ASSERT_EQUAL(GetValue(j, 7, i), slice[i + j * m_Dimensions[2]]);
+    }
+
+    // axial section
+    {
+      const int origin[3] = {0, 0, 30};
+      const int stepI[3] = {1, 0, 0};
+      const int stepJ[3] = {0, 1, 0};
+      std::vector<short> slice(m_Dimensions[0] * m_Dimensions[1]);
+      bricked->ExtractSlice(origin, stepI, stepJ, m_Dimensions[0], m_Dimensions[1], &background, slice.data());
+
+      for (unsigned int j = 0; j < m_Dimensions[1]; ++j)
+        for (unsigned int i = 0; i < m_Dimensions[0]; ++i)
+          CPPUNIT_ASSERT_EQUAL(GetValue(i, j, 30), slice[i + j * m_Dimensions[0]]);
+    }
+  }
+
+  void ExtractSlice_OutsideVolume_ReturnsBackground()
+  {
+    auto bricked = mitk::BrickedImageVolume::New();
+    bricked->Initialize(m_Data.data(), m_Dimensions.data(), sizeof(short));
+    const short background = -1024;
+
+    const int width = 50;
+    const int height = 30;
+    const int origin[3] = {-5, -4, 3};
+    const int stepI[3] = {1, 0, 0};
+    const int stepJ[3] = {0, 1, 0};
+    std::vector<short> slice(width * height);
+    bricked->ExtractSlice(origin, stepI, stepJ, width, height, &background, slice.data());
+
+    for (int j = 0; j < height; ++j)
+    {
+      for (int i = 0; i < width; ++i)
+      {
+        const int x = i - 5;
+        const int y = j - 4;
+        const bool inside = x >= 0 && y >= 0 && x < static_cast<int>(m_Dimensions[0]) &&
+                            y < static_cast<int>(m_Dimensions[1]);
+        CPPUNIT_ASSERT_EQUAL(inside ? GetValue(x, y, 3) : background, slice[i + j * width]);
+      }
+    }
+
+    // section completely outside of the volume
+    const int outsideOrigin[3] = {0, 0, 100};
+    bricked->ExtractSlice(outsideOrigin, stepI, stepJ, width, height, &background, slice.data());
+    for (short value : slice)
+      CPPUNIT_ASSERT_EQUAL(background, value);
+  }
+
+  void GetBrickedVolume_ModifiedImage_IsRecreated()
+  {
+    CPPUNIT_ASSERT(m_Image->GetBrickedVolume().IsNull());
+
+    m_Image->SetBrickedLayoutEnabled(true);
+    mitk::BrickedImageVolume::Pointer bricked = m_Image->GetBrickedVolume();
+    CPPUNIT_ASSERT(bricked.IsNotNull());
+    CPPUNIT_ASSERT(bricked == m_Image->GetBrickedVolume());
+
+    {
+      mitk::ImagePixelWriteAccessor<short, 3> writeAccess(m_Image);
+      itk::Index<3> index = {{2, 3, 4}};
+      writeAccess.SetPixelByIndex(index, 4711);
+    }
+    m_Image->Modified();
+
+    mitk::BrickedImageVolume::Pointer recreated = m_Image->GetBrickedVolume();
+    CPPUNIT_ASSERT(recreated.IsNotNull());
+    CPPUNIT_ASSERT(recreated != bricked);
+    CPPUNIT_ASSERT_EQUAL(static_cast<short>(4711), *static_cast<const short *>(recreated->GetPixel(2, 3, 4)));
+
+    m_Image->SetBrickedLayoutEnabled(false);
+    CPPUNIT_ASSERT(m_Image->GetBrickedVolume().IsNull());
+  }
+
+  void ExtractSliceFilter_BrickedLayout_EqualsReslicer()
+  {
+    const mitk::PlaneGeometry::PlaneOrientation orientations[] = {
+      mitk::PlaneGeometry::Axial, mitk::PlaneGeometry::Sagittal, mitk::PlaneGeometry::Frontal};
+
+    for (auto orientation : orientations)
+    {
+      auto plane = mitk::PlaneGeometry::New();
+      plane->InitializeStandardPlane(m_Image->GetGeometry(), orientation, 9);
+      mitk::Vector3D normal = plane->GetNormal();
+      normal.Normalize();
+      plane->SetOrigin(plane->GetOrigin() + normal * 0.5); // pixel spacing is 1
+
+      m_Image->SetBrickedLayoutEnabled(false);
+      auto reslicer = mitk::ExtractSliceFilter::New();
+      reslicer->SetInput(m_Image);
+      reslicer->SetWorldGeometry(plane);
+      reslicer->SetVtkOutputRequest(true);
+      reslicer->Update();
+      vtkImageData *expected = reslicer->GetVtkOutput();
+
+      m_Image->SetBrickedLayoutEnabled(true);
+      auto brickedSlicer = mitk::ExtractSliceFilter::New();
+      brickedSlicer->SetInput(m_Image);
+      brickedSlicer->SetWorldGeometry(plane);
+      brickedSlicer->SetVtkOutputRequest(true);
+      brickedSlicer->Update();
+      vtkImageData *actual = brickedSlicer->GetVtkOutput();
+
+      int expectedExtent[6], actualExtent[6];
+      expected->GetExtent(expectedExtent);
+      actual->GetExtent(actualExtent);
+      for (int i = 0; i < 6; ++i)
+        CPPUNIT_ASSERT_EQUAL(expectedExtent[i], actualExtent[i]);
+
+      const auto numberOfPoints = expected->GetNumberOfPoints();
+      CPPUNIT_ASSERT_EQUAL(numberOfPoints, actual->GetNumberOfPoints());
+      const auto *expectedValues = static_cast<const short *>(expected->GetScalarPointer());
+      const auto *actualValues = static_cast<const short *>(actual->GetScalarPointer());
+      for (vtkIdType i = 0; i < numberOfPoints; ++i)
+        CPPUNIT_ASSERT_EQUAL(expectedValues[i], actualValues[i]);
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkBrickedImageVolume)
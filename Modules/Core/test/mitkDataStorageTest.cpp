@@ -37,6 +37,8 @@ found in the LICENSE file.
 #include "mitkTestingMacros.h"
 
 void TestDataStorage(mitk::DataStorage *ds, std::string filename);
+void TestStandaloneDataStorageIndices();
+void TestDataStorageBatch();
 
 namespace mitk
 {
@@ -60,10 +62,25 @@ class DSEventReceiver // Helper class for event testing
 public:
   const mitk::DataNode *m_NodeAdded;
   const mitk::DataNode *m_NodeRemoved;
+  unsigned int m_NumberOfAddEvents;
+  unsigned int m_NumberOfBatchEvents;
+  unsigned int m_BatchSize;
 
-  DSEventReceiver() : m_NodeAdded(nullptr), m_NodeRemoved(nullptr) {}
-  void OnAdd(const mitk::DataNode *node) { m_NodeAdded = node; }
+  DSEventReceiver()
+    : m_NodeAdded(nullptr), m_NodeRemoved(nullptr), m_NumberOfAddEvents(0), m_NumberOfBatchEvents(0), m_BatchSize(0)
+  {
+  }
+  void OnAdd(const mitk::DataNode *node)
+  {
+    m_NodeAdded = node;
+    ++m_NumberOfAddEvents;
+  }
   void OnRemove(const mitk::DataNode *node) { m_NodeRemoved = node; }
+  void OnAddBatch(const mitk::DataStorage::SetOfObjects *nodes)
+  {
+    ++m_NumberOfBatchEvents;
+    m_BatchSize = nodes->Size();
+  }
 };
 
 ///
@@ -146,12 +163,109 @@ int mitkDataStorageTest(int argc, char *argv[])
   MITK_TEST_OUTPUT(<< "Testing StandaloneDataStorage: ");
   MITK_TEST_CONDITION_REQUIRED(argc > 1, "Testing correct test invocation");
   TestDataStorage(sds, argv[1]);
-  // TODO: Add specific StandaloneDataStorage Tests here
   sds = nullptr;
 
+  MITK_TEST_OUTPUT(<< "Testing indices of StandaloneDataStorage: ");
+  TestStandaloneDataStorageIndices();
+
+  MITK_TEST_OUTPUT(<< "Testing batches of StandaloneDataStorage: ");
+  TestDataStorageBatch();
+
   MITK_TEST_END();
 }
 
+//##Documentation
+//## @brief Checks that the indexed queries of StandaloneDataStorage follow changes of the nodes
+void TestStandaloneDataStorageIndices()
+{
+  mitk::StandaloneDataStorage::Pointer ds = mitk::StandaloneDataStorage::New();
+  mitk::NodePredicateDataType::Pointer isImage = mitk::NodePredicateDataType::New("Image");
+  mitk::NodePredicateDataType::Pointer isSurface = mitk::NodePredicateDataType::New("Surface");
+
+  mitk::DataNode::Pointer node = mitk::DataNode::New();
+  node->SetData(mitk::Image::New());
+  node->SetName("first name");
+  mitk::DataNode::Pointer otherNode = mitk::DataNode::New();
+  otherNode->SetData(mitk::Surface::New());
+  otherNode->SetName("other name");
+  ds->Add(node);
+  ds->Add(otherNode);
+
+  MITK_TEST_CONDITION(ds->GetNamedNode("first name") == node, "Indexed name is found");
+  MITK_TEST_CONDITION(ds->GetSubset(isImage)->Size() == 1 && ds->GetSubset(isImage)->GetElement(0) == node,
+                      "Indexed data type is found");
+
+  node->SetName("second name");
+  MITK_TEST_CONDITION(ds->GetNamedNode("first name") == nullptr && ds->GetNamedNode("second name") == node,
+                      "Index follows SetName()");
+
+  auto *nameProperty = dynamic_cast<mitk::StringProperty *>(node->GetProperty("name"));
+  MITK_TEST_CONDITION_REQUIRED(nameProperty != nullptr, "Node has a name property");
+  nameProperty->SetValue("third name");
+  MITK_TEST_CONDITION(ds->GetNamedNode("second name") == nullptr && ds->GetNamedNode("third name") == node,
+                      "Index follows a value change of the name property");
+
+  otherNode->GetPropertyList()->DeleteProperty("name");
+  otherNode->GetData()->SetProperty("name", mitk::StringProperty::New("data name"));
+  MITK_TEST_CONDITION(ds->GetNamedNode("data name") == otherNode, "Name of the data is found");
+
+  node->SetData(mitk::Surface::New());
+  MITK_TEST_CONDITION(ds->GetSubset(isImage)->Size() == 0 && ds->GetSubset(isSurface)->Size() == 2,
+                      "Index follows SetData()");
+
+  node->SetName("third name");
+  mitk::NodePredicateAnd::Pointer isNamedSurface = mitk::NodePredicateAnd::New(
+    isSurface, mitk::NodePredicateProperty::New("name", mitk::StringProperty::New("third name")));
+  mitk::DataStorage::SetOfObjects::ConstPointer namedSurfaces = ds->GetSubset(isNamedSurface);
+  MITK_TEST_CONDITION(namedSurfaces->Size() == 1 && namedSurfaces->GetElement(0) == node,
+                      "Conjunction is answered from the indices");
+
+  ds->Remove(node);
+  MITK_TEST_CONDITION(ds->GetNamedNode("third name") == nullptr && ds->GetSubset(isSurface)->Size() == 1,
+                      "Removed node is removed from the indices");
+}
+
+//##Documentation
+//## @brief Checks that the AddNodeEvents of a batch are deferred and aggregated
+void TestDataStorageBatch()
+{
+  mitk::StandaloneDataStorage::Pointer ds = mitk::StandaloneDataStorage::New();
+  DSEventReceiver listener;
+  ds->AddNodeEvent.AddListener(
+    mitk::MessageDelegate1<DSEventReceiver, const mitk::DataNode *>(&listener, &DSEventReceiver::OnAdd));
+  ds->AddNodesEvent.AddListener(mitk::MessageDelegate1<DSEventReceiver, const mitk::DataStorage::SetOfObjects *>(
+    &listener, &DSEventReceiver::OnAddBatch));
+
+  mitk::DataNode::Pointer first = mitk::DataNode::New();
+  mitk::DataNode::Pointer second = mitk::DataNode::New();
+  mitk::DataNode::Pointer removed = mitk::DataNode::New();
+
+  ds->BeginBatch();
+  ds->Add(first);
+  ds->BeginBatch();
+  ds->Add(second, first);
+  ds->Add(removed);
+  ds->EndBatch();
+  ds->Remove(removed);
+  MITK_TEST_CONDITION(listener.m_NumberOfAddEvents == 0 && listener.m_NumberOfBatchEvents == 0,
+                      "No events are emitted during a batch");
+  MITK_TEST_CONDITION(ds->Exists(first) && ds->Exists(second) && ds->GetSources(second)->Size() == 1,
+                      "Nodes are added to the storage immediately");
+  ds->EndBatch();
+
+  MITK_TEST_CONDITION(listener.m_NumberOfBatchEvents == 1 && listener.m_BatchSize == 2,
+                      "One aggregated event for the remaining nodes at the end of the outermost batch");
+  MITK_TEST_CONDITION(listener.m_NumberOfAddEvents == 2 && listener.m_NodeAdded == second,
+                      "AddNodeEvents are emitted after the aggregated event");
+  MITK_TEST_CONDITION(listener.m_NodeRemoved == nullptr, "No RemoveNodeEvent for a node added in the same batch");
+
+  ds->Add(removed);
+  MITK_TEST_CONDITION(listener.m_NumberOfAddEvents == 3 && listener.m_NumberOfBatchEvents == 1,
+                      "AddNodeEvent is emitted immediately outside of batches");
+
+  MITK_TEST_FOR_EXCEPTION(mitk::Exception, ds->EndBatch());
+}
+
 //##Documentation
 //## @brief Test for the DataStorage class and its associated classes (e.g. the predicate classes)
 //## This method will be called once for each subclass of DataStorage
@@ -38,7 +38,9 @@ found in the LICENSE file.
 #include <vtkImageReslice.h>
 #include <vtkInteractorStyleImage.h>
 #include <vtkLookupTable.h>
+#include <vtkMatrix4x4.h>
 #include <vtkPlaneSource.h>
+#include <vtkPointData.h>
 #include <vtkPolyDataMapper.h>
 #include <vtkRenderWindow.h>
 #include <vtkRenderWindowInteractor.h>
@@ -635,6 +637,50 @@ public:
            (((float)rand() + 1.0) / ((float)RAND_MAX + 1.0)) / ((float)RAND_MAX + 1.0);
   }
 
+  /* compares the slice of the filter's own reslice kernel with the one of vtkImageReslice */
+  static void TestResliceKernel(mitk::PlaneGeometry *planeGeometry,
+                                mitk::ExtractSliceFilter::ResliceInterpolation interpolation,
+                                std::string testname)
+  {
+    mitk::ExtractSliceFilter::Pointer slicer = mitk::ExtractSliceFilter::New();
+    slicer->SetInput(TestVolume);
+    slicer->SetWorldGeometry(planeGeometry);
+    slicer->SetInterpolationMode(interpolation);
+    slicer->SetVtkOutputRequest(true);
+    slicer->Update();
+    vtkImageData *slice = slicer->GetVtkOutput();
+
+    vtkSmartPointer<vtkImageReslice> reslicer = vtkSmartPointer<vtkImageReslice>::New();
+    reslicer->SetInputData(TestVolume->GetVtkImageData());
+    vtkSmartPointer<vtkMatrix4x4> resliceAxes = vtkSmartPointer<vtkMatrix4x4>::New();
+    resliceAxes->DeepCopy(slicer->GetResliceAxes());
+    reslicer->SetResliceAxes(resliceAxes);
+    reslicer->SetOutputDimensionality(2);
+    reslicer->SetOutputExtent(slice->GetExtent());
+    reslicer->SetOutputOrigin(slice->GetOrigin());
+    reslicer->SetOutputSpacing(slice->GetSpacing());
+    reslicer->SetBackgroundLevel(-32768.0);
+    if (interpolation == mitk::ExtractSliceFilter::RESLICE_LINEAR)
+      reslicer->SetInterpolationModeToLinear();
+    else
+      reslicer->SetInterpolationModeToNearestNeighbor();
+    reslicer->Update();
+    vtkImageData *reference = reslicer->GetOutput();
+
+    MITK_TEST_CONDITION_REQUIRED(slice->GetNumberOfPoints() == reference->GetNumberOfPoints(),
+                                 testname << " - slice size");
+
+    // samples exactly between two voxels may be rounded differently
+    vtkIdType differences = 0;
+    for (vtkIdType i = 0; i < slice->GetNumberOfPoints(); ++i)
+    {
+      if (std::abs(slice->GetPointData()->GetScalars()->GetTuple1(i) -
+                   reference->GetPointData()->GetScalars()->GetTuple1(i)) > 1.0)
+        ++differences;
+    }
+    MITK_TEST_CONDITION(differences <= slice->GetNumberOfPoints() / 100, testname << " - pixel values");
+  }
+
   /* create a sphere with the size of the given testVolumeSize*/
   static void InitializeTestVolume()
   {
@@ -937,6 +983,11 @@ int mitkExtractSliceFilterTest(int /*argc*/, char * /*argv*/ [])
   delete op;
 
   mitkExtractSliceFilterTestClass::TestSlice(obliquePlane, "Testing oblique plane");
+
+  mitkExtractSliceFilterTestClass::TestResliceKernel(
+    obliquePlane, mitk::ExtractSliceFilter::RESLICE_NEAREST, "Testing reslice kernel with nearest neighbor");
+  mitkExtractSliceFilterTestClass::TestResliceKernel(
+    obliquePlane, mitk::ExtractSliceFilter::RESLICE_LINEAR, "Testing reslice kernel with linear interpolation");
 /* end oblique plane */
 
 #ifdef SHOW_SLICE_IN_RENDER_WINDOW
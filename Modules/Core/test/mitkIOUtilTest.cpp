@@ -16,9 +16,12 @@ found in the LICENSE file.
 
 #include <mitkIOUtil.h>
 #include <mitkImageGenerator.h>
+#include <mitkStandaloneDataStorage.h>
 
 #include <itksys/SystemTools.hxx>
 
+#include <atomic>
+
 class mitkIOUtilTestSuite : public mitk::TestFixture
 {
   CPPUNIT_TEST_SUITE(mitkIOUtilTestSuite);
@@ -29,6 +32,8 @@ class mitkIOUtilTestSuite : public mitk::TestFixture
   MITK_TEST(TestNullSave);
   MITK_TEST(TestLoadAndSavePointSet);
   MITK_TEST(TestLoadAndSaveSurface);
+  MITK_TEST(TestLoadConcurrently);
+  MITK_TEST(TestSaveAsync);
   MITK_TEST(TestTempMethodsForUniqueFilenames);
   MITK_TEST(TestTempMethodsForUniqueFilenames);
   CPPUNIT_TEST_SUITE_END();
@@ -226,6 +231,60 @@ public:
     // delete the files after the test is done
     std::remove(surfacePath.c_str());
   }
+
+  void TestLoadConcurrently()
+  {
+    std::vector<std::string> paths = {m_ImagePath, m_SurfacePath, m_PointSetPath, m_ImagePath};
+
+    mitk::StandaloneDataStorage::Pointer storage = mitk::StandaloneDataStorage::New();
+    mitk::DataStorage::SetOfObjects::Pointer nodes = mitk::IOUtil::LoadConcurrently(paths, *storage, 4);
+
+    // the nodes are added in the order of the paths
+    CPPUNIT_ASSERT_EQUAL(paths.size(), static_cast<std::size_t>(nodes->Size()));
+    CPPUNIT_ASSERT_EQUAL(paths.size(), static_cast<std::size_t>(storage->GetAll()->Size()));
+    CPPUNIT_ASSERT(dynamic_cast<mitk::Image *>(nodes->GetElement(0)->GetData()) != nullptr);
+    CPPUNIT_ASSERT(dynamic_cast<mitk::Surface *>(nodes->GetElement(1)->GetData()) != nullptr);
+    CPPUNIT_ASSERT(dynamic_cast<mitk::PointSet *>(nodes->GetElement(2)->GetData()) != nullptr);
+    CPPUNIT_ASSERT(dynamic_cast<mitk::Image *>(nodes->GetElement(3)->GetData()) != nullptr);
+    CPPUNIT_ASSERT_EQUAL(std::string("Pic3D"), nodes->GetElement(0)->GetName());
+
+    CPPUNIT_ASSERT_THROW(mitk::IOUtil::LoadConcurrently({m_ImagePath, "nonexistent.nrrd"}, *storage), mitk::Exception);
+  }
+
+  void TestSaveAsync()
+  {
+    mitk::PointSet::Pointer pointset = mitk::IOUtil::Load<mitk::PointSet>(m_PointSetPath);
+    const int numberOfPoints = pointset->GetSize();
+
+    std::ofstream tmpStream;
+    std::string pointSetPath = mitk::IOUtil::CreateTemporaryFile(tmpStream, "XXXXXX.mps");
+    tmpStream.close();
+
+    std::atomic<bool> callbackCalled(false);
+    mitk::AsyncSaveOperation::Pointer operation = mitk::IOUtil::SaveAsync(
+      pointset, pointSetPath, [&callbackCalled](const mitk::AsyncSaveOperation *) { callbackCalled = true; });
+
+    // the operation writes a snapshot
+    mitk::Point3D point;
+    point.Fill(1.0);
+    pointset->InsertPoint(numberOfPoints + 10, point);
+
+    operation->Wait();
+    CPPUNIT_ASSERT(operation->GetState() == mitk::AsyncSaveOperation::State::Finished);
+    CPPUNIT_ASSERT(operation->GetErrorMessage().empty());
+
+    mitk::PointSet::Pointer savedPointset = mitk::IOUtil::Load<mitk::PointSet>(pointSetPath);
+    CPPUNIT_ASSERT_EQUAL(numberOfPoints, savedPointset->GetSize());
+
+    // the callback is called after the waiting threads are notified
+    for (int i = 0; i < 100 && !callbackCalled; ++i)
+      itksys::SystemTools::Delay(10);
+    CPPUNIT_ASSERT(callbackCalled);
+
+    CPPUNIT_ASSERT_THROW(mitk::IOUtil::SaveAsync(nullptr, pointSetPath), mitk::Exception);
+
+    std::remove(pointSetPath.c_str());
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkIOUtil)
@@ -0,0 +1,141 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkImage.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+
+/**
+ * Measures the cost of acquiring ImageReadAccessors concurrently from 1 to 64 threads and checks that
+ * write accessors still get exclusive access to the accessed image part.
+ */
+class mitkImageAccessorConcurrencyTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageAccessorConcurrencyTestSuite);
+  MITK_TEST(TestConcurrentReadAccessAcquisition);
+  MITK_TEST(TestWriteAccessIsExclusive);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+  std::vector<mitk::ImageDataItem::Pointer> m_Slices;
+
+  static const unsigned int NumberOfSlices = 16;
+  static const unsigned int SliceSize = 64 * 64;
+
+public:
+  void setUp() override
+  {
+    m_Image = mitk::Image::New();
+    std::array<unsigned int, 3> dimensions = {{ 64, 64, NumberOfSlices }};
+    m_Image->Initialize(mitk::MakeScalarPixelType<unsigned char>(), 3, dimensions.data());
+
+    std::vector<unsigned char> data(SliceSize * NumberOfSlices, 0);
+    m_Image->SetVolume(data.data());
+
+    for (unsigned int s = 0; s < NumberOfSlices; ++s)
+      m_Slices.push_back(m_Image->GetSliceData(s));
+  }
+
+  void tearDown() override
+  {
+    m_Slices.clear();
+    m_Image = nullptr;
+  }
+
+  void TestConcurrentReadAccessAcquisition()
+  {
+    const unsigned int accessesPerThread = 2000;
+
+    for (unsigned int numberOfThreads = 1; numberOfThreads <= 64; numberOfThreads *= 2)
+    {
+      std::atomic<unsigned int> numberOfAccesses(0);
+      std::vector<std::thread> threads;
+
+      auto start = std::chrono::steady_clock::now();
+      for (unsigned int i = 0; i < numberOfThreads; ++i)
+      {
+        threads.emplace_back([this, i, accessesPerThread, &numberOfAccesses]() {
+          for (unsigned int a = 0; a < accessesPerThread; ++a)
+          {
+            mitk::ImageReadAccessor readAccess(m_Image, m_Slices[(i + a) % NumberOfSlices]);
+            if (readAccess.GetData() != nullptr)
+              ++numberOfAccesses;
+          }
+        });
+      }
+      for (auto &thread : threads)
+        thread.join();
+      auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+      CPPUNIT_ASSERT_EQUAL(numberOfThreads * accessesPerThread, numberOfAccesses.load());
+      MITK_INFO << "ImageReadAccessor acquisition with " << numberOfThreads << " thread(s): "
+                << duration.count() / (numberOfThreads * accessesPerThread) << " ns per accessor";
+    }
+  }
+
+  void TestWriteAccessIsExclusive()
+  {
+    const unsigned int numberOfReaders = 8;
+    const unsigned int numberOfWriters = 2;
+    const unsigned int iterations = 200;
+
+    std::atomic<bool> consistent(true);
+    std::vector<std::thread> threads;
+
+    for (unsigned int i = 0; i < numberOfWriters; ++i)
+    {
+      threads.emplace_back([this, i, iterations]() {
+        for (unsigned int a = 0; a < iterations; ++a)
+        {
+          mitk::ImageWriteAccessor writeAccess(m_Image, m_Slices[a % NumberOfSlices]);
+          auto *data = static_cast<unsigned char *>(writeAccess.GetData());
+          for (unsigned int p = 0; p < SliceSize; ++p)
+            data[p] = static_cast<unsigned char>(i + a);
+        }
+      });
+    }
+
+    for (unsigned int i = 0; i < numberOfReaders; ++i)
+    {
+      threads.emplace_back([this, i, iterations, &consistent]() {
+        for (unsigned int a = 0; a < iterations; ++a)
+        {
+          mitk::ImageReadAccessor readAccess(m_Image, m_Slices[(i + a) % NumberOfSlices]);
+          auto *data = static_cast<const unsigned char *>(readAccess.GetData());
+          // a slice is always written completely while it is exclusively locked
+          for (unsigned int p = 1; p < SliceSize; ++p)
+          {
+            if (data[p] != data[0])
+              consistent = false;
+          }
+        }
+      });
+    }
+
+    for (auto &thread : threads)
+      thread.join();
+
+    CPPUNIT_ASSERT_MESSAGE("Readers observed partially written slices", consistent);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageAccessorConcurrency)
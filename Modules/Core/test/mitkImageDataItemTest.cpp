@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include "mitkTestingMacros.h"
 
 #include <mitkImageDataItem.h>
+#include <mitkMemoryUtilities.h>
 
 #include <mitkPixelType.h>
 #include <mitkImage.h>
@@ -25,6 +26,8 @@ class mitkImageDataItemTestSuite : public mitk::TestFixture
 {
   CPPUNIT_TEST_SUITE(mitkImageDataItemTestSuite);
   MITK_TEST(TestAccessOnHugeImage);
+  MITK_TEST(TestMappedFileStorage);
+  MITK_TEST(TestPooledHeapStorage);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -65,6 +68,67 @@ public:
       exit(77);
     }
   }
+
+  void TestMappedFileStorage()
+  {
+    auto image = mitk::Image::New();
+    std::array<unsigned int, 4> dimensions = {{ 64, 32, 16, 3 }};
+    image->Initialize(mitk::MakeScalarPixelType<short>(), 4, dimensions.data());
+    image->SetStorageMode(mitk::ImageDataItem::MappedFileStorage);
+
+    mitk::ImageDataItem::Pointer volume = image->GetVolumeData(1);
+    CPPUNIT_ASSERT(volume.IsNotNull());
+    CPPUNIT_ASSERT_EQUAL(mitk::ImageDataItem::MappedFileStorage, volume->GetStorageMode());
+
+    {
+      mitk::ImagePixelWriteAccessor<short, 3> writeAccess(image, volume);
+      itk::Index<3> index = {{ 63, 31, 15 }};
+      writeAccess.SetPixelByIndex(index, 42);
+      CPPUNIT_ASSERT_EQUAL(short(42), writeAccess.GetPixelByIndex(index));
+
+      // fresh mapped memory is zero-initialized
+      index.Fill(0);
+      CPPUNIT_ASSERT_EQUAL(short(0), writeAccess.GetPixelByIndex(index));
+    }
+
+    // clones keep the storage mode
+    auto clone = image->Clone();
+    CPPUNIT_ASSERT_EQUAL(mitk::ImageDataItem::MappedFileStorage, clone->GetStorageMode());
+    CPPUNIT_ASSERT(mitk::Equal(*image, *clone, mitk::eps, true));
+  }
+
+  void TestPooledHeapStorage()
+  {
+    std::array<unsigned int, 2> dimensions = {{ 100, 100 }};
+    const mitk::PixelType pixelType = mitk::MakeScalarPixelType<short>();
+    const size_t size = 100 * 100 * sizeof(short);
+
+    mitk::MemoryUtilities::ResetPoolStatistics();
+    const mitk::MemoryUtilities::PoolStatistics before = mitk::MemoryUtilities::GetPoolStatistics();
+
+    mitk::ImageDataItem::Pointer item =
+      new mitk::ImageDataItem(pixelType, 0, 2, dimensions.data(), nullptr, true);
+    mitk::MemoryUtilities::PoolStatistics statistics = mitk::MemoryUtilities::GetPoolStatistics();
+    CPPUNIT_ASSERT_EQUAL(before.NumberOfAllocations + 1, statistics.NumberOfAllocations);
+    CPPUNIT_ASSERT(statistics.BytesInUse >= before.BytesInUse + size);
+    // size classes waste at most a quarter of a block
+    CPPUNIT_ASSERT(statistics.BytesInUse <= before.BytesInUse + size + size / 4);
+    CPPUNIT_ASSERT(statistics.HighWaterMark >= statistics.BytesInUse);
+
+    // a released block of the same size class is reused by the next item
+    item = nullptr;
+    statistics = mitk::MemoryUtilities::GetPoolStatistics();
+    CPPUNIT_ASSERT_EQUAL(before.BytesInUse, statistics.BytesInUse);
+    CPPUNIT_ASSERT(statistics.BytesCached >= size);
+
+    item = new mitk::ImageDataItem(pixelType, 0, 2, dimensions.data(), nullptr, true);
+    statistics = mitk::MemoryUtilities::GetPoolStatistics();
+    CPPUNIT_ASSERT_EQUAL(before.NumberOfReuses + 1, statistics.NumberOfReuses);
+
+    item = nullptr;
+    mitk::MemoryUtilities::ReleasePooledMemory();
+    CPPUNIT_ASSERT_EQUAL(size_t(0), mitk::MemoryUtilities::GetPoolStatistics().BytesCached);
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkImageDataItem)
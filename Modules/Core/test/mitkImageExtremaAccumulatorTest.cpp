@@ -0,0 +1,218 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkImage.h>
+#include <mitkImageExtremaAccumulator.h>
+#include <mitkImageStatisticsHolder.h>
+
+#include <itkRealTimeClock.h>
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+  /* The scalar loop ImageStatisticsHolder used before, as reference and benchmark baseline */
+  template <typename TPixel>
+  struct ReferenceExtrema
+  {
+    double min = std::numeric_limits<double>::max();
+    double secondMin = std::numeric_limits<double>::max();
+    double max = std::numeric_limits<double>::lowest();
+    double secondMax = std::numeric_limits<double>::lowest();
+    std::size_t minCount = 0;
+    std::size_t maxCount = 0;
+
+    explicit ReferenceExtrema(const std::vector<TPixel> &data)
+    {
+      for (TPixel value : data)
+      {
+        if (value < min)
+        {
+          secondMin = min;
+          min = value;
+          minCount = 1;
+        }
+        else if (value == min)
+        {
+          ++minCount;
+        }
+        else if (value < secondMin)
+        {
+          secondMin = value;
+        }
+
+        if (value > max)
+        {
+          secondMax = max;
+          max = value;
+          maxCount = 1;
+        }
+        else if (value == max)
+        {
+          ++maxCount;
+        }
+        else if (value > secondMax)
+        {
+          secondMax = value;
+        }
+      }
+    }
+  };
+
+  template <typename TPixel>
+  void CheckAgainstReference(const std::vector<TPixel> &data, unsigned int numberOfThreads)
+  {
+    const ReferenceExtrema<TPixel> expected(data);
+    const auto actual = mitk::ImageExtremaAccumulator<TPixel>::Compute(data.data(), data.size(), numberOfThreads);
+
+    CPPUNIT_ASSERT_EQUAL(expected.min, static_cast<double>(actual.GetMin()));
+    CPPUNIT_ASSERT_EQUAL(expected.max, static_cast<double>(actual.GetMax()));
+    CPPUNIT_ASSERT_EQUAL(expected.minCount, actual.GetMinCount());
+    CPPUNIT_ASSERT_EQUAL(expected.maxCount, actual.GetMaxCount());
+    if (expected.min != expected.max)
+    {
+      CPPUNIT_ASSERT_EQUAL(expected.secondMin, static_cast<double>(actual.GetSecondMin()));
+      CPPUNIT_ASSERT_EQUAL(expected.secondMax, static_cast<double>(actual.GetSecondMax()));
+    }
+  }
+
+  template <typename TPixel>
+  std::vector<TPixel> RandomData(std::size_t size, int low, int high, unsigned int seed)
+  {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<int> distribution(low, high);
+    std::vector<TPixel> data(size);
+    for (auto &value : data)
+      value = static_cast<TPixel>(distribution(generator));
+    return data;
+  }
+}
+
+class mitkImageExtremaAccumulatorTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageExtremaAccumulatorTestSuite);
+  MITK_TEST(Compute_RandomData_EqualsReference);
+  MITK_TEST(Compute_SpecialValues_EqualsReference);
+  MITK_TEST(Compute_FloatWithNaN_IgnoresNaN);
+  MITK_TEST(StatisticsHolder_Image_ReturnsExtrema);
+  MITK_TEST(Benchmark_LargeVolume_ReportsSpeedup);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void Compute_RandomData_EqualsReference()
+  {
+    // sizes around the lane count and the thread partitioning
+    const std::array<std::size_t, 6> sizes = {{1, 15, 16, 17, 1000, (1 << 20) + 3}};
+    for (std::size_t size : sizes)
+    {
+      for (unsigned int threads = 1; threads <= 4; threads += 3)
+      {
+        CheckAgainstReference(RandomData<short>(size, -1024, 3071, 1), threads);
+        CheckAgainstReference(RandomData<unsigned char>(size, 0, 255, 2), threads);
+        CheckAgainstReference(RandomData<float>(size, -500, 500, 3), threads);
+        CheckAgainstReference(RandomData<int>(size, -3, 3, 4), threads);
+      }
+    }
+  }
+
+  void Compute_SpecialValues_EqualsReference()
+  {
+    // constant image
+    CheckAgainstReference(std::vector<short>(100, 42), 1);
+    // extrema at the limits of the pixel type, which are also the initial values
+    std::vector<unsigned char> limits(70, 128);
+    limits[3] = 255;
+    limits[50] = 0;
+    limits[69] = 255;
+    CheckAgainstReference(limits, 1);
+    CheckAgainstReference(std::vector<unsigned char>(33, 255), 1);
+    // infinite values
+    std::vector<float> infinite(40, 1.0f);
+    infinite[7] = std::numeric_limits<float>::infinity();
+    infinite[8] = -std::numeric_limits<float>::infinity();
+    CheckAgainstReference(infinite, 1);
+  }
+
+  void Compute_FloatWithNaN_IgnoresNaN()
+  {
+    std::vector<float> data(50, 3.0f);
+    data[0] = std::numeric_limits<float>::quiet_NaN();
+    data[20] = std::numeric_limits<float>::quiet_NaN();
+    data[21] = 1.0f;
+    data[33] = 7.0f;
+
+    const auto extrema = mitk::ImageExtremaAccumulator<float>::Compute(data.data(), data.size(), 1);
+    CPPUNIT_ASSERT_EQUAL(1.0f, extrema.GetMin());
+    CPPUNIT_ASSERT_EQUAL(3.0f, extrema.GetSecondMin());
+    CPPUNIT_ASSERT_EQUAL(7.0f, extrema.GetMax());
+    CPPUNIT_ASSERT_EQUAL(3.0f, extrema.GetSecondMax());
+
+    const std::vector<float> onlyNaN(17, std::numeric_limits<float>::quiet_NaN());
+    CPPUNIT_ASSERT(mitk::ImageExtremaAccumulator<float>::Compute(onlyNaN.data(), onlyNaN.size(), 1).IsEmpty());
+  }
+
+  void StatisticsHolder_Image_ReturnsExtrema()
+  {
+    std::array<unsigned int, 3> dimensions = {{64, 48, 40}};
+    std::vector<short> data = RandomData<short>(dimensions[0] * dimensions[1] * dimensions[2], -1000, 1000, 5);
+    data[17] = -2000;
+    data[18] = -2000;
+    data[300] = 4000;
+
+    auto image = mitk::Image::New();
+    image->Initialize(mitk::MakeScalarPixelType<short>(), 3, dimensions.data());
+    image->SetVolume(data.data());
+
+    const ReferenceExtrema<short> expected(data);
+    CPPUNIT_ASSERT_EQUAL(-2000.0, image->GetStatistics()->GetScalarValueMin());
+    CPPUNIT_ASSERT_EQUAL(4000.0, image->GetStatistics()->GetScalarValueMax());
+    CPPUNIT_ASSERT_EQUAL(expected.secondMin, image->GetStatistics()->GetScalarValue2ndMin());
+    CPPUNIT_ASSERT_EQUAL(expected.secondMax, image->GetStatistics()->GetScalarValue2ndMax());
+    CPPUNIT_ASSERT_EQUAL(2.0, image->GetStatistics()->GetCountOfMinValuedVoxels());
+    CPPUNIT_ASSERT_EQUAL(1.0, image->GetStatistics()->GetCountOfMaxValuedVoxels());
+  }
+
+  void Benchmark_LargeVolume_ReportsSpeedup()
+  {
+    // 256^3 CT-like volume; the timings are reported, not asserted
+    const std::vector<short> data = RandomData<short>(256 * 256 * 256, -1024, 3071, 6);
+    auto clock = itk::RealTimeClock::New();
+
+    double start = clock->GetTimeInSeconds();
+    const ReferenceExtrema<short> expected(data);
+    const double referenceTime = clock->GetTimeInSeconds() - start;
+
+    start = clock->GetTimeInSeconds();
+    auto singleThreaded = mitk::ImageExtremaAccumulator<short>::Compute(data.data(), data.size(), 1);
+    const double singleThreadedTime = clock->GetTimeInSeconds() - start;
+
+    start = clock->GetTimeInSeconds();
+    auto multiThreaded = mitk::ImageExtremaAccumulator<short>::Compute(data.data(), data.size());
+    const double multiThreadedTime = clock->GetTimeInSeconds() - start;
+
+    MITK_INFO << "Extrema of 256^3 short voxels: scalar reference " << referenceTime * 1000 << " ms, vectorized "
+              << singleThreadedTime * 1000 << " ms, vectorized and multi-threaded " << multiThreadedTime * 1000
+              << " ms";
+
+    CPPUNIT_ASSERT_EQUAL(expected.min, static_cast<double>(singleThreaded.GetMin()));
+    CPPUNIT_ASSERT_EQUAL(expected.maxCount, multiThreaded.GetMaxCount());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageExtremaAccumulator)
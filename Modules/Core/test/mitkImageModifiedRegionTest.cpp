@@ -0,0 +1,153 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkImage.h>
+#include <mitkPlaneGeometry.h>
+
+#include <array>
+#include <vector>
+
+class mitkImageModifiedRegionTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageModifiedRegionTestSuite);
+  MITK_TEST(GetModifiedRegion_NoModification_ReturnsEmptyRegion);
+  MITK_TEST(GetModifiedRegion_SetSlice_ReturnsSliceRegion);
+  MITK_TEST(GetModifiedRegion_SeveralRegions_ReturnsBoundingBox);
+  MITK_TEST(GetModifiedRegion_WholeImageModified_ReturnsFalse);
+  MITK_TEST(GetModifiedRegion_TooManyRegions_ReturnsFalseForOldTime);
+  MITK_TEST(GetRegionOfPlane_AxialPlane_ReturnsSliceRegion);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+  std::array<unsigned int, 4> m_Dimensions;
+
+  mitk::Image::RegionType MakeRegion(long x, long y, long z, unsigned long sx, unsigned long sy, unsigned long sz)
+  {
+    mitk::Image::RegionType region = m_Image->GetLargestPossibleRegion();
+    region.SetIndex(0, x);
+    region.SetIndex(1, y);
+    region.SetIndex(2, z);
+    region.SetIndex(3, 1);
+    region.SetSize(0, sx);
+    region.SetSize(1, sy);
+    region.SetSize(2, sz);
+    region.SetSize(3, 1);
+    return region;
+  }
+
+public:
+  void setUp() override
+  {
+    m_Dimensions = {{20, 16, 12, 2}};
+    m_Image = mitk::Image::New();
+    m_Image->Initialize(mitk::MakeScalarPixelType<unsigned char>(), 4, m_Dimensions.data());
+
+    std::vector<unsigned char> data(m_Dimensions[0] * m_Dimensions[1] * m_Dimensions[2], 0);
+    m_Image->SetVolume(data.data(), 0);
+    m_Image->SetVolume(data.data(), 1);
+  }
+
+  void tearDown() override { m_Image = nullptr; }
+
+  void GetModifiedRegion_NoModification_ReturnsEmptyRegion()
+  {
+    const itk::ModifiedTimeType time = m_Image->GetMTime();
+
+    mitk::Image::RegionType region = MakeRegion(1, 1, 1, 1, 1, 1);
+    CPPUNIT_ASSERT(m_Image->GetModifiedRegion(time, region));
+    CPPUNIT_ASSERT_EQUAL(static_cast<itk::SizeValueType>(0), region.GetNumberOfPixels());
+  }
+
+  void GetModifiedRegion_SetSlice_ReturnsSliceRegion()
+  {
+    const itk::ModifiedTimeType time = m_Image->GetMTime();
+    const itk::ModifiedTimeType timeGeometryTime = m_Image->GetTimeGeometry()->GetMTime();
+
+    std::vector<unsigned char> slice(m_Dimensions[0] * m_Dimensions[1], 7);
+    m_Image->SetSlice(slice.data(), 5, 1);
+    CPPUNIT_ASSERT(m_Image->GetMTime() > time);
+    CPPUNIT_ASSERT_EQUAL(timeGeometryTime, m_Image->GetTimeGeometry()->GetMTime());
+
+    mitk::Image::RegionType region;
+    CPPUNIT_ASSERT(m_Image->GetModifiedRegion(time, region));
+    CPPUNIT_ASSERT_EQUAL(MakeRegion(0, 0, 5, m_Dimensions[0], m_Dimensions[1], 1), region);
+  }
+
+  void GetModifiedRegion_SeveralRegions_ReturnsBoundingBox()
+  {
+    const itk::ModifiedTimeType time = m_Image->GetMTime();
+    m_Image->RegionModified(MakeRegion(2, 3, 4, 2, 2, 1));
+    const itk::ModifiedTimeType intermediateTime = m_Image->GetMTime();
+    m_Image->RegionModified(MakeRegion(8, 1, 6, 3, 1, 2));
+
+    mitk::Image::RegionType region;
+    CPPUNIT_ASSERT(m_Image->GetModifiedRegion(time, region));
+    CPPUNIT_ASSERT_EQUAL(MakeRegion(2, 1, 4, 9, 4, 4), region);
+
+    CPPUNIT_ASSERT(m_Image->GetModifiedRegion(intermediateTime, region));
+    CPPUNIT_ASSERT_EQUAL(MakeRegion(8, 1, 6, 3, 1, 2), region);
+  }
+
+  void GetModifiedRegion_WholeImageModified_ReturnsFalse()
+  {
+    const itk::ModifiedTimeType time = m_Image->GetMTime();
+    m_Image->RegionModified(MakeRegion(2, 3, 4, 2, 2, 1));
+    m_Image->Modified();
+
+    mitk::Image::RegionType region;
+    CPPUNIT_ASSERT(!m_Image->GetModifiedRegion(time, region));
+
+    // later region modifications are tracked again
+    const itk::ModifiedTimeType laterTime = m_Image->GetMTime();
+    m_Image->RegionModified(MakeRegion(2, 3, 4, 2, 2, 1));
+    CPPUNIT_ASSERT(m_Image->GetModifiedRegion(laterTime, region));
+    CPPUNIT_ASSERT_EQUAL(MakeRegion(2, 3, 4, 2, 2, 1), region);
+  }
+
+  void GetModifiedRegion_TooManyRegions_ReturnsFalseForOldTime()
+  {
+    const itk::ModifiedTimeType time = m_Image->GetMTime();
+    for (int i = 0; i < 100; ++i)
+      m_Image->RegionModified(MakeRegion(i % 20, 0, 0, 1, 1, 1));
+    const itk::ModifiedTimeType recentTime = m_Image->GetMTime();
+    m_Image->RegionModified(MakeRegion(3, 0, 0, 1, 1, 1));
+
+    mitk::Image::RegionType region;
+    CPPUNIT_ASSERT(!m_Image->GetModifiedRegion(time, region));
+    CPPUNIT_ASSERT(m_Image->GetModifiedRegion(recentTime, region));
+    CPPUNIT_ASSERT_EQUAL(MakeRegion(3, 0, 0, 1, 1, 1), region);
+  }
+
+  void GetRegionOfPlane_AxialPlane_ReturnsSliceRegion()
+  {
+    auto plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(m_Image->GetGeometry(1), mitk::PlaneGeometry::Axial, 5);
+
+    mitk::Image::RegionType region = m_Image->GetRegionOfPlane(plane, 1);
+    CPPUNIT_ASSERT_EQUAL(static_cast<itk::IndexValueType>(1), region.GetIndex(3));
+    CPPUNIT_ASSERT_EQUAL(static_cast<itk::SizeValueType>(1), region.GetSize(3));
+    CPPUNIT_ASSERT_EQUAL(static_cast<itk::SizeValueType>(m_Dimensions[0]), region.GetSize(0));
+    CPPUNIT_ASSERT_EQUAL(static_cast<itk::SizeValueType>(m_Dimensions[1]), region.GetSize(1));
+    CPPUNIT_ASSERT(region.GetIndex(2) <= 5 && region.GetUpperIndex()[2] >= 5);
+    CPPUNIT_ASSERT(region.GetSize(2) <= 3);
+
+    // a modification elsewhere does not touch the plane
+    mitk::Image::RegionType modifiedRegion = MakeRegion(0, 0, 10, 4, 4, 1);
+    CPPUNIT_ASSERT(!region.Crop(modifiedRegion));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageModifiedRegion)
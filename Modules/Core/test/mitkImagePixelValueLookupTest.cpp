@@ -0,0 +1,174 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestingMacros.h"
+#include <mitkTestFixture.h>
+
+#include <itkImage.h>
+#include <mitkCompositePixelValueToString.h>
+#include <mitkImage.h>
+#include <mitkImagePixelValueLookup.h>
+#include <mitkImageReadAccessor.h>
+
+class mitkImagePixelValueLookupTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImagePixelValueLookupTestSuite);
+  MITK_TEST(TestLookup_EqualsPixelValueByWorldCoordinate);
+  MITK_TEST(TestLookupOutside_NotInside);
+  MITK_TEST(TestLookupSeveralImages_CorrectResults);
+  MITK_TEST(TestLookupModifiedImage_CorrectResult);
+  MITK_TEST(TestLookupRGB_CorrectString);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer CreateShortImage(short offset)
+  {
+    typedef itk::Image<short, 3> ImageType;
+    ImageType::RegionType region;
+    ImageType::SizeType size = {{4, 5, 6}};
+    region.SetSize(size);
+
+    ImageType::Pointer itkImage = ImageType::New();
+    itkImage->SetRegions(region);
+    ImageType::SpacingType spacing;
+    spacing[0] = 0.5;
+    spacing[1] = 1.0;
+    spacing[2] = 2.0;
+    itkImage->SetSpacing(spacing);
+    ImageType::PointType origin;
+    origin[0] = 10.0;
+    origin[1] = -5.0;
+    origin[2] = 3.0;
+    itkImage->SetOrigin(origin);
+    itkImage->Allocate();
+
+    short value = offset;
+    for (short *pixel = itkImage->GetBufferPointer(); pixel != itkImage->GetBufferPointer() + 4 * 5 * 6; ++pixel)
+    {
+      *pixel = value++;
+    }
+
+    mitk::Image::Pointer image = mitk::Image::New();
+    image->InitializeByItk(itkImage.GetPointer());
+    image->SetVolume(itkImage->GetBufferPointer());
+    return image;
+  }
+
+  mitk::ImagePixelValueLookup m_Lookup;
+
+public:
+  void tearDown() override { m_Lookup.Clear(); }
+
+  void TestLookup_EqualsPixelValueByWorldCoordinate()
+  {
+    auto image = this->CreateShortImage(0);
+
+    for (itk::IndexValueType z = 0; z < 6; ++z)
+    {
+      for (itk::IndexValueType y = 0; y < 5; ++y)
+      {
+        for (itk::IndexValueType x = 0; x < 4; ++x)
+        {
+          itk::Index<3> index = {{x, y, z}};
+          mitk::Point3D world;
+          image->GetGeometry()->IndexToWorld(index, world);
+
+          const auto result = m_Lookup.Lookup(image, world, 0.0);
+          CPPUNIT_ASSERT(result.IsInside);
+          CPPUNIT_ASSERT(result.Index == index);
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(image->GetPixelValueByWorldCoordinate(world), result.Value, mitk::eps);
+        }
+      }
+    }
+  }
+
+  void TestLookupOutside_NotInside()
+  {
+    auto image = this->CreateShortImage(0);
+
+    itk::Index<3> index = {{4, 0, 0}};
+    mitk::Point3D world;
+    image->GetGeometry()->IndexToWorld(index, world);
+
+    CPPUNIT_ASSERT(!m_Lookup.Lookup(image, world, 0.0).IsInside);
+    CPPUNIT_ASSERT(!m_Lookup.Lookup(image, world, 0.0, 1).IsInside);
+    CPPUNIT_ASSERT(!m_Lookup.Lookup(nullptr, world, 0.0).IsInside);
+  }
+
+  void TestLookupSeveralImages_CorrectResults()
+  {
+    auto first = this->CreateShortImage(0);
+    auto second = this->CreateShortImage(100);
+
+    itk::Index<3> index = {{1, 2, 3}};
+    mitk::Point3D world;
+    first->GetGeometry()->IndexToWorld(index, world);
+
+    const auto results = m_Lookup.Lookup({first.GetPointer(), second.GetPointer()}, world, 0.0);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), results.size());
+    CPPUNIT_ASSERT(results[0].IsInside && results[1].IsInside);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0 + 4 * (2 + 5 * 3), results[0].Value, mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(101.0 + 4 * (2 + 5 * 3), results[1].Value, mitk::eps);
+  }
+
+  void TestLookupModifiedImage_CorrectResult()
+  {
+    auto image = this->CreateShortImage(0);
+
+    itk::Index<3> index = {{1, 2, 3}};
+    mitk::Point3D world;
+    image->GetGeometry()->IndexToWorld(index, world);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0 + 4 * (2 + 5 * 3), m_Lookup.Lookup(image, world, 0.0).Value, mitk::eps);
+
+    // re-initialization replaces the volume the lookup read before
+    auto other = this->CreateShortImage(100);
+    image->Initialize(other);
+    image->SetVolume(mitk::ImageReadAccessor(other).GetData());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(101.0 + 4 * (2 + 5 * 3), m_Lookup.Lookup(image, world, 0.0).Value, mitk::eps);
+  }
+
+  void TestLookupRGB_CorrectString()
+  {
+    typedef itk::RGBPixel<unsigned char> PixelType;
+    typedef itk::Image<PixelType, 3> ImageType;
+
+    ImageType::RegionType region;
+    ImageType::SizeType size;
+    size.Fill(1);
+    region.SetSize(size);
+
+    ImageType::Pointer itkImage = ImageType::New();
+    itkImage->SetRegions(region);
+    itkImage->Allocate();
+
+    PixelType rgbPixel;
+    rgbPixel.Set(0, 125, 250);
+    itkImage->FillBuffer(rgbPixel);
+
+    mitk::Image::Pointer image = mitk::Image::New();
+    image->InitializeByItk(itkImage.GetPointer());
+    image->SetVolume(itkImage->GetBufferPointer());
+
+    itk::Index<3> index;
+    index.Fill(0);
+    mitk::Point3D world;
+    image->GetGeometry()->IndexToWorld(index, world);
+
+    const auto result = m_Lookup.Lookup(image, world, 0.0, 2);
+    CPPUNIT_ASSERT(result.IsInside);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(250.0, result.Value, mitk::eps);
+    CPPUNIT_ASSERT_EQUAL(ConvertCompositePixelValueToString(image, index),
+                         mitk::ConvertCompositePixelValueToString(result.Components));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImagePixelValueLookup)
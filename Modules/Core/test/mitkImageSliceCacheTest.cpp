@@ -0,0 +1,134 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkImageSliceCache.h>
+#include <mitkPlaneGeometry.h>
+
+class mitkImageSliceCacheTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageSliceCacheTestSuite);
+  MITK_TEST(Find_InsertedSlice_ReturnsCopy);
+  MITK_TEST(Find_DifferentPlaneOrParameters_ReturnsNothing);
+  MITK_TEST(Find_ImageModified_ClearsCache);
+  MITK_TEST(Insert_CapacityReached_DropsLeastRecentlyUsed);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  vtkSmartPointer<vtkImageData> m_Slice;
+  vtkSmartPointer<vtkMatrix4x4> m_ResliceAxes;
+  mitk::ScalarType m_Spacing[2];
+
+  mitk::ImageSliceCache::Key CreateKey(int slice)
+  {
+    auto geometry = mitk::PlaneGeometry::New();
+    geometry->InitializeStandardPlane(100, 100, mitk::Vector3D(1.0), mitk::PlaneGeometry::Axial, slice);
+
+    mitk::ImageSliceCache::Key key;
+    key.SetPlaneGeometry(geometry);
+    return key;
+  }
+
+public:
+  void setUp() override
+  {
+    m_Slice = vtkSmartPointer<vtkImageData>::New();
+    m_Slice->SetDimensions(4, 4, 1);
+    m_Slice->AllocateScalars(VTK_SHORT, 1);
+    m_Slice->SetScalarComponentFromDouble(1, 2, 0, 0, 42.0);
+
+    m_ResliceAxes = vtkSmartPointer<vtkMatrix4x4>::New();
+    m_ResliceAxes->SetElement(0, 3, 5.0);
+
+    m_Spacing[0] = 0.5;
+    m_Spacing[1] = 0.25;
+  }
+
+  void tearDown() override
+  {
+    m_Slice = nullptr;
+    m_ResliceAxes = nullptr;
+  }
+
+  void Find_InsertedSlice_ReturnsCopy()
+  {
+    mitk::ImageSliceCache cache;
+    cache.Insert(CreateKey(3), 1, m_Slice, m_Spacing, m_ResliceAxes);
+    // the reslicer reuses its output
+    m_Slice->SetScalarComponentFromDouble(1, 2, 0, 0, 0.0);
+
+    const mitk::ImageSliceCache::Slice *slice = cache.Find(CreateKey(3), 1);
+    CPPUNIT_ASSERT(slice != nullptr);
+    CPPUNIT_ASSERT(slice->Image != m_Slice);
+    CPPUNIT_ASSERT_EQUAL(42.0, slice->Image->GetScalarComponentAsDouble(1, 2, 0, 0));
+    CPPUNIT_ASSERT_EQUAL(0.5, slice->Spacing[0]);
+    CPPUNIT_ASSERT_EQUAL(0.25, slice->Spacing[1]);
+    CPPUNIT_ASSERT_EQUAL(5.0, slice->ResliceAxes->GetElement(0, 3));
+  }
+
+  void Find_DifferentPlaneOrParameters_ReturnsNothing()
+  {
+    mitk::ImageSliceCache cache;
+    cache.Insert(CreateKey(3), 1, m_Slice, m_Spacing, m_ResliceAxes);
+
+    CPPUNIT_ASSERT(cache.Find(CreateKey(4), 1) == nullptr);
+
+    mitk::ImageSliceCache::Key key = CreateKey(3);
+    key.TimeStep = 1;
+    CPPUNIT_ASSERT(cache.Find(key, 1) == nullptr);
+
+    key = CreateKey(3);
+    key.ThickSlicesMode = 1;
+    key.ThickSlicesNum = 2;
+    CPPUNIT_ASSERT(cache.Find(key, 1) == nullptr);
+
+    key = CreateKey(3);
+    key.InterpolationMode = 1;
+    CPPUNIT_ASSERT(cache.Find(key, 1) == nullptr);
+
+    CPPUNIT_ASSERT(cache.Find(CreateKey(3), 1) != nullptr);
+  }
+
+  void Find_ImageModified_ClearsCache()
+  {
+    mitk::ImageSliceCache cache;
+    cache.Insert(CreateKey(3), 1, m_Slice, m_Spacing, m_ResliceAxes);
+    cache.Insert(CreateKey(4), 1, m_Slice, m_Spacing, m_ResliceAxes);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), cache.GetSize());
+
+    CPPUNIT_ASSERT(cache.Find(CreateKey(3), 2) == nullptr);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), cache.GetSize());
+  }
+
+  void Insert_CapacityReached_DropsLeastRecentlyUsed()
+  {
+    mitk::ImageSliceCache cache(2);
+    cache.Insert(CreateKey(1), 1, m_Slice, m_Spacing, m_ResliceAxes);
+    cache.Insert(CreateKey(2), 1, m_Slice, m_Spacing, m_ResliceAxes);
+    CPPUNIT_ASSERT(cache.Find(CreateKey(1), 1) != nullptr);
+    cache.Insert(CreateKey(3), 1, m_Slice, m_Spacing, m_ResliceAxes);
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), cache.GetSize());
+    CPPUNIT_ASSERT(cache.Find(CreateKey(1), 1) != nullptr);
+    CPPUNIT_ASSERT(cache.Find(CreateKey(2), 1) == nullptr);
+    CPPUNIT_ASSERT(cache.Find(CreateKey(3), 1) != nullptr);
+
+    cache.SetCapacity(0);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), cache.GetSize());
+    cache.Insert(CreateKey(1), 1, m_Slice, m_Spacing, m_ResliceAxes);
+    CPPUNIT_ASSERT(cache.Find(CreateKey(1), 1) == nullptr);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageSliceCache)
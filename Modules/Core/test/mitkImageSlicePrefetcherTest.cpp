@@ -0,0 +1,139 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkExtractSliceFilter.h>
+#include <mitkImage.h>
+#include <mitkImageSlicePrefetcher.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+class mitkImageSlicePrefetcherTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageSlicePrefetcherTestSuite);
+  MITK_TEST(Prefetch_Planes_EqualExtractSliceFilter);
+  MITK_TEST(Prefetch_ImageModified_DiscardsSlices);
+  MITK_TEST(Prefetch_Twice_ReslicesLatestRequests);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+
+  mitk::ImageSlicePrefetcher::Request CreateRequest(int slice)
+  {
+    auto plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(m_Image->GetGeometry(), mitk::PlaneGeometry::Axial, slice);
+    plane->SetReferenceGeometry(m_Image->GetGeometry());
+
+    mitk::ImageSlicePrefetcher::Request request;
+    request.Key.SetPlaneGeometry(plane);
+    request.Geometry = plane.GetPointer();
+    return request;
+  }
+
+  static void Wait(mitk::ImageSlicePrefetcher &prefetcher)
+  {
+    for (int i = 0; i < 1000 && prefetcher.IsBusy(); ++i)
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    CPPUNIT_ASSERT(!prefetcher.IsBusy());
+  }
+
+public:
+  void setUp() override
+  {
+    std::array<unsigned int, 3> dimensions = {{32, 24, 16}};
+    std::vector<short> data(dimensions[0] * dimensions[1] * dimensions[2]);
+    for (std::size_t i = 0; i < data.size(); ++i)
+      data[i] = static_cast<short>(i % 4000);
+
+    m_Image = mitk::Image::New();
+    m_Image->Initialize(mitk::MakeScalarPixelType<short>(), 3, dimensions.data());
+    m_Image->SetVolume(data.data());
+  }
+
+  void tearDown() override { m_Image = nullptr; }
+
+  void Prefetch_Planes_EqualExtractSliceFilter()
+  {
+    const std::vector<mitk::ImageSlicePrefetcher::Request> requests = {CreateRequest(3), CreateRequest(4)};
+
+    mitk::ImageSlicePrefetcher prefetcher;
+    prefetcher.Prefetch(m_Image, 0, m_Image->GetMTime(), mitk::ExtractSliceFilter::RESLICE_NEAREST, false, requests);
+    Wait(prefetcher);
+
+    mitk::ImageSliceCache cache;
+    prefetcher.TransferSlices(cache, m_Image->GetMTime());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), cache.GetSize());
+
+    for (const auto &request : requests)
+    {
+      auto reslicer = mitk::ExtractSliceFilter::New();
+      reslicer->SetInput(m_Image);
+      reslicer->SetWorldGeometry(request.Geometry);
+      reslicer->SetResliceTransformByGeometry(m_Image->GetGeometry());
+      reslicer->SetInterpolationMode(mitk::ExtractSliceFilter::RESLICE_NEAREST);
+      reslicer->SetVtkOutputRequest(true);
+      reslicer->UpdateLargestPossibleRegion();
+      vtkImageData *expected = reslicer->GetVtkOutput();
+
+      const mitk::ImageSliceCache::Slice *slice = cache.Find(request.Key, m_Image->GetMTime());
+      CPPUNIT_ASSERT(slice != nullptr);
+      CPPUNIT_ASSERT_EQUAL(expected->GetNumberOfPoints(), slice->Image->GetNumberOfPoints());
+      const auto *expectedPixels = static_cast<const short *>(expected->GetScalarPointer());
+      const auto *pixels = static_cast<const short *>(slice->Image->GetScalarPointer());
+      CPPUNIT_ASSERT(std::equal(pixels, pixels + expected->GetNumberOfPoints(), expectedPixels));
+      CPPUNIT_ASSERT_EQUAL(reslicer->GetOutputSpacing()[0], slice->Spacing[0]);
+      CPPUNIT_ASSERT_EQUAL(reslicer->GetResliceAxes()->GetElement(2, 3), slice->ResliceAxes->GetElement(2, 3));
+    }
+  }
+
+  void Prefetch_ImageModified_DiscardsSlices()
+  {
+    const unsigned long imageTime = m_Image->GetMTime();
+
+    mitk::ImageSlicePrefetcher prefetcher;
+    prefetcher.Prefetch(
+      m_Image, 0, imageTime, mitk::ExtractSliceFilter::RESLICE_NEAREST, false, {CreateRequest(3), CreateRequest(4)});
+    Wait(prefetcher);
+    m_Image->Modified();
+
+    mitk::ImageSliceCache cache;
+    prefetcher.TransferSlices(cache, m_Image->GetMTime());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), cache.GetSize());
+  }
+
+  void Prefetch_Twice_ReslicesLatestRequests()
+  {
+    std::vector<mitk::ImageSlicePrefetcher::Request> requests;
+    for (int slice = 0; slice < 16; ++slice)
+      requests.push_back(CreateRequest(slice));
+
+    mitk::ImageSlicePrefetcher prefetcher;
+    const unsigned long imageTime = m_Image->GetMTime();
+    prefetcher.Prefetch(m_Image, 0, imageTime, mitk::ExtractSliceFilter::RESLICE_NEAREST, false, requests);
+    prefetcher.Prefetch(m_Image, 0, imageTime, mitk::ExtractSliceFilter::RESLICE_NEAREST, false, {CreateRequest(7)});
+    Wait(prefetcher);
+
+    mitk::ImageSliceCache cache(32);
+    prefetcher.TransferSlices(cache, imageTime);
+    // the first requests may have been resliced in between, the replacement is always
+    CPPUNIT_ASSERT(cache.Contains(CreateRequest(7).Key, imageTime));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageSlicePrefetcher)
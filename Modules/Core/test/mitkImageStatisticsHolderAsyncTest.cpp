@@ -0,0 +1,141 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkImage.h>
+#include <mitkImageStatisticsHolder.h>
+
+#include <itkCommand.h>
+
+#include <array>
+#include <vector>
+
+class mitkImageStatisticsHolderAsyncTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageStatisticsHolderAsyncTestSuite);
+  MITK_TEST(ComputeAsync_LargeImage_ReturnsEstimateAndExactValuesLater);
+  MITK_TEST(ComputeAsync_SmallImage_ReturnsExactValues);
+  MITK_TEST(ComputeAsync_Cancel_DiscardsResult);
+  MITK_TEST(ComputeAsync_ImageModified_DiscardsResult);
+  MITK_TEST(ComputeAsync_ImageReleased_DoesNotCrash);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+  unsigned int m_NumberOfEvents;
+
+  mitk::Image::Pointer CreateImage(unsigned int size)
+  {
+    std::array<unsigned int, 3> dimensions = {{size, size, size}};
+    std::vector<short> data(size * size * size);
+    for (std::size_t i = 0; i < data.size(); ++i)
+      data[i] = static_cast<short>(i % 1000);
+    // not part of the regular subsample
+    data[1] = -5;
+    data[data.size() - 2] = 5000;
+
+    auto image = mitk::Image::New();
+    image->Initialize(mitk::MakeScalarPixelType<short>(), 3, dimensions.data());
+    image->SetVolume(data.data());
+    return image;
+  }
+
+  void OnStatisticsComputed() { ++m_NumberOfEvents; }
+
+public:
+  void setUp() override
+  {
+    m_Image = CreateImage(128);
+    m_NumberOfEvents = 0;
+
+    auto command = itk::SimpleMemberCommand<mitkImageStatisticsHolderAsyncTestSuite>::New();
+    command->SetCallbackFunction(this, &mitkImageStatisticsHolderAsyncTestSuite::OnStatisticsComputed);
+    m_Image->AddObserver(mitk::ImageStatisticsComputedEvent(), command);
+  }
+
+  void tearDown() override { m_Image = nullptr; }
+
+  void ComputeAsync_LargeImage_ReturnsEstimateAndExactValuesLater()
+  {
+    mitk::ImageStatisticsHolder *statistics = m_Image->GetStatistics();
+    const mitk::ImageStatisticsHolder::StatisticsEstimate estimate = statistics->ComputeImageStatisticsAsync();
+    CPPUNIT_ASSERT(!estimate.IsExact);
+    CPPUNIT_ASSERT(estimate.Min >= -5.0 && estimate.Max <= 5000.0);
+
+    statistics->WaitForImageStatistics();
+    CPPUNIT_ASSERT(!statistics->IsImageStatisticsComputationRunning());
+    CPPUNIT_ASSERT(statistics->IsImageStatisticsAvailable());
+    CPPUNIT_ASSERT_EQUAL(1u, m_NumberOfEvents);
+
+    CPPUNIT_ASSERT_EQUAL(-5.0, statistics->GetScalarValueMinNoRecompute());
+    CPPUNIT_ASSERT_EQUAL(5000.0, statistics->GetScalarValueMaxNoRecompute());
+    CPPUNIT_ASSERT_EQUAL(0.0, statistics->GetScalarValue2ndMinNoRecompute());
+    CPPUNIT_ASSERT_EQUAL(999.0, statistics->GetScalarValue2ndMaxNoRecompute());
+    CPPUNIT_ASSERT_EQUAL(1u, statistics->GetCountOfMinValuedVoxelsNoRecompute());
+
+    const mitk::ImageStatisticsHolder::StatisticsEstimate exact = statistics->ComputeImageStatisticsAsync();
+    CPPUNIT_ASSERT(exact.IsExact);
+    CPPUNIT_ASSERT_EQUAL(-5.0, exact.Min);
+    CPPUNIT_ASSERT_EQUAL(5000.0, exact.Max);
+  }
+
+  void ComputeAsync_SmallImage_ReturnsExactValues()
+  {
+    m_Image = CreateImage(16);
+    const mitk::ImageStatisticsHolder::StatisticsEstimate statistics =
+      m_Image->GetStatistics()->ComputeImageStatisticsAsync();
+    CPPUNIT_ASSERT(statistics.IsExact);
+    CPPUNIT_ASSERT(!m_Image->GetStatistics()->IsImageStatisticsComputationRunning());
+    CPPUNIT_ASSERT_EQUAL(-5.0, statistics.Min);
+    CPPUNIT_ASSERT_EQUAL(5000.0, statistics.Max);
+    CPPUNIT_ASSERT_EQUAL(1.0, statistics.CountOfMaxValuedVoxels);
+  }
+
+  void ComputeAsync_Cancel_DiscardsResult()
+  {
+    mitk::ImageStatisticsHolder *statistics = m_Image->GetStatistics();
+    statistics->ComputeImageStatisticsAsync();
+    statistics->CancelImageStatisticsComputation();
+
+    CPPUNIT_ASSERT(!statistics->IsImageStatisticsComputationRunning());
+    CPPUNIT_ASSERT(!statistics->IsImageStatisticsAvailable());
+    CPPUNIT_ASSERT_EQUAL(0u, m_NumberOfEvents);
+
+    // the synchronous path still works
+    CPPUNIT_ASSERT_EQUAL(-5.0, statistics->GetScalarValueMin());
+  }
+
+  void ComputeAsync_ImageModified_DiscardsResult()
+  {
+    mitk::ImageStatisticsHolder *statistics = m_Image->GetStatistics();
+    statistics->ComputeImageStatisticsAsync();
+    m_Image->Modified();
+    statistics->WaitForImageStatistics();
+
+    CPPUNIT_ASSERT(!statistics->IsImageStatisticsAvailable());
+    CPPUNIT_ASSERT_EQUAL(0u, m_NumberOfEvents);
+    CPPUNIT_ASSERT_EQUAL(5000.0, statistics->GetScalarValueMax());
+  }
+
+  void ComputeAsync_ImageReleased_DoesNotCrash()
+  {
+    for (int i = 0; i < 4; ++i)
+    {
+      mitk::Image::Pointer image = CreateImage(128);
+      image->GetStatistics()->ComputeImageStatisticsAsync();
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageStatisticsHolderAsync)
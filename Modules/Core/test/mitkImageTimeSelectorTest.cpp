@@ -12,7 +12,9 @@ found in the LICENSE file.
 
 #include "mitkImage.h"
 #include "mitkImageGenerator.h"
+#include "mitkImageReadAccessor.h"
 #include "mitkImageTimeSelector.h"
+#include "mitkImageWriteAccessor.h"
 
 #include "mitkTestingMacros.h"
 
@@ -96,6 +98,46 @@ static void Valid_ImageExpandedByTimestep_ReturnsTrue()
   }
 }
 
+static void Valid_OutputSharesInputMemoryUntilWritten_ReturnsTrue()
+{
+  unsigned int dimensions[4] = {8, 8, 4, 3};
+  mitk::Image::Pointer image = mitk::Image::New();
+  image->Initialize(mitk::MakeScalarPixelType<short>(), 4, dimensions);
+
+  {
+    mitk::ImageWriteAccessor writeAccess(image);
+    auto *data = static_cast<short *>(writeAccess.GetData());
+    for (unsigned int i = 0; i < 8 * 8 * 4 * 3; ++i)
+      data[i] = static_cast<short>(i);
+  }
+
+  mitk::ImageTimeSelector::Pointer timeSelector = mitk::ImageTimeSelector::New();
+  timeSelector->SetInput(image);
+  timeSelector->SetTimeNr(1);
+  timeSelector->Update();
+
+  mitk::Image::Pointer output = timeSelector->GetOutput();
+  const void *inputData = mitk::ImageReadAccessor(image, image->GetVolumeData(1)).GetData();
+
+  {
+    mitk::ImageReadAccessor readAccess(output, output->GetVolumeData(0));
+    MITK_TEST_CONDITION(readAccess.GetData() == inputData, "Output references the memory of the input");
+  }
+
+  // the input must be independent of the output, even if the selector is gone
+  timeSelector = nullptr;
+
+  {
+    mitk::ImageWriteAccessor writeAccess(output, output->GetVolumeData(0));
+    MITK_TEST_CONDITION(writeAccess.GetData() != inputData, "Output memory is copied before writing");
+    MITK_TEST_CONDITION(static_cast<short *>(writeAccess.GetData())[0] == 8 * 8 * 4, "Copy contains the time step");
+    static_cast<short *>(writeAccess.GetData())[0] = -1;
+  }
+
+  mitk::ImageReadAccessor readAccess(image, image->GetVolumeData(1));
+  MITK_TEST_CONDITION(static_cast<const short *>(readAccess.GetData())[0] == 8 * 8 * 4, "Input is not changed");
+}
+
 int mitkImageTimeSelectorTest(int /*argc*/, char *argv[])
 {
   MITK_TEST_BEGIN(mitkImageTimeSelectorTest);
@@ -104,6 +146,7 @@ int mitkImageTimeSelectorTest(int /*argc*/, char *argv[])
 
   Valid_AllInputTimesteps_ReturnsTrue();
   Valid_ImageExpandedByTimestep_ReturnsTrue();
+  Valid_OutputSharesInputMemoryUntilWritten_ReturnsTrue();
 
   MITK_TEST_END();
 }
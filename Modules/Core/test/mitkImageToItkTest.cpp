@@ -20,6 +20,9 @@ found in the LICENSE file.
 #include <mitkIOUtil.h>
 #include <mitkImageAccessByItk.h>
 #include <mitkImageCast.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageToItk.h>
+#include <mitkImageToVtkImageView.h>
 
 static mitk::Image::Pointer GetEmptyTestImageWithGeometry(mitk::PixelType pt)
 {
@@ -55,6 +58,9 @@ class mitkImageToItkTestSuite : public mitk::TestFixture
   MITK_TEST(ImageCastDoubleToTensorDouble_EmptyImage_ThrowsException);
   MITK_TEST(ImageCastToItkAndBack_SamePointer_Success);
   MITK_TEST(ImageCastToItk_TestImage_Success);
+  MITK_TEST(ImageToItkImage_SameType_ReferencesMemory);
+  MITK_TEST(ImageToItkImage_WrongType_ThrowsException);
+  MITK_TEST(ImageToVtkImageView_ReleasedImage_ReferencesMemory);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -155,5 +161,38 @@ public:
     MITK_ASSERT_EQUAL(mitkImageAfterCast, testDataImage, "Cast with test data followed by import produces same images");
   }
 
+  void ImageToItkImage_SameType_ReferencesMemory()
+  {
+    mitk::Image::Pointer image = GetEmptyTestImageWithGeometry(mitk::MakeScalarPixelType<short>());
+    const void *mitkBuffer = mitk::ImageReadAccessor(image).GetData();
+
+    itk::Image<short, 3>::ConstPointer itkImage =
+      mitk::ImageToItkImage<short, 3>(static_cast<const mitk::Image *>(image.GetPointer()));
+
+    CPPUNIT_ASSERT_MESSAGE("ITK image references the MITK image memory", itkImage->GetBufferPointer() == mitkBuffer);
+  }
+
+  void ImageToItkImage_WrongType_ThrowsException()
+  {
+    mitk::Image::Pointer image = GetEmptyTestImageWithGeometry(mitk::MakeScalarPixelType<short>());
+
+    CPPUNIT_ASSERT_THROW_MESSAGE("Mismatching pixel type is rejected instead of copied",
+                                 mitk::ImageToItkImage<float, 3>(image.GetPointer()),
+                                 itk::ExceptionObject);
+  }
+
+  void ImageToVtkImageView_ReleasedImage_ReferencesMemory()
+  {
+    mitk::Image::Pointer image = GetEmptyTestImageWithGeometry(mitk::MakeScalarPixelType<short>());
+    const void *mitkBuffer = mitk::ImageReadAccessor(image).GetData();
+
+    vtkSmartPointer<vtkImageData> view = mitk::ImageToVtkImageView(image);
+    image = nullptr;
+
+    CPPUNIT_ASSERT_MESSAGE("vtkImageData view references the MITK image memory",
+                           view->GetScalarPointer() == mitkBuffer);
+    CPPUNIT_ASSERT_EQUAL(40, view->GetDimensions()[2]);
+  }
+
 }; // END TEST SUITE CLASS DECL
 MITK_TEST_SUITE_REGISTRATION(mitkImageToItk);
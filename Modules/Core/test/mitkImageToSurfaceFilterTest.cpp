@@ -41,6 +41,7 @@ class mitkImageToSurfaceFilterTestSuite : public mitk::TestFixture
   MITK_TEST(testImageToSurfaceFilterInitialization);
   MITK_TEST(testInput);
   MITK_TEST(testSurfaceGeneration);
+  MITK_TEST(testSurfaceGenerationWithoutForeground);
   MITK_TEST(testDecimatePromeshDecimation);
   MITK_TEST(testQuadricDecimation);
   MITK_TEST(testSmoothingOfSurface);
@@ -88,6 +89,16 @@ public:
     CPPUNIT_ASSERT_MESSAGE("Testing surface generation!", testObject->GetOutput() != nullptr);
   }
 
+  void testSurfaceGenerationWithoutForeground()
+  {
+    mitk::ImageToSurfaceFilter::Pointer testObject = mitk::ImageToSurfaceFilter::New();
+    testObject->SetInput(m_BallImage);
+    testObject->SetThreshold(2.0);
+    testObject->Update();
+    CPPUNIT_ASSERT_MESSAGE("Testing surface generation without voxels above the threshold!",
+                           testObject->GetOutput()->GetVtkPolyData()->GetNumberOfPoints() == 0);
+  }
+
   void testDecimatePromeshDecimation()
   {
     mitk::ImageToSurfaceFilter::Pointer testObject = mitk::ImageToSurfaceFilter::New();
@@ -0,0 +1,145 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkImage.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImageVolumeProvider.h>
+
+namespace
+{
+  /** Fills every voxel of time step t with the value t and counts the calls */
+  class TimeStepValueProvider : public mitk::ImageVolumeProvider
+  {
+  public:
+    mitkClassMacro(TimeStepValueProvider, mitk::ImageVolumeProvider);
+    itkFactorylessNewMacro(Self);
+
+    bool ProvideVolume(const mitk::Image *image, int t, int /*n*/, void *buffer) override
+    {
+      ++m_NumberOfCalls;
+      const size_t numberOfVoxels = image->GetDimension(0) * image->GetDimension(1) * image->GetDimension(2);
+      std::fill_n(static_cast<short *>(buffer), numberOfVoxels, static_cast<short>(t));
+      return true;
+    }
+
+    unsigned int m_NumberOfCalls = 0;
+  };
+}
+
+class mitkImageVolumeProviderTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageVolumeProviderTestSuite);
+  MITK_TEST(TestVolumesAreProvidedOnDemand);
+  MITK_TEST(TestMemoryBudgetReleasesLeastRecentlyUsedVolumes);
+  MITK_TEST(TestImportedVolumesTakePrecedence);
+  MITK_TEST(TestChannelDataIsAssembledFromProvidedVolumes);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+  TimeStepValueProvider::Pointer m_Provider;
+  size_t m_VolumeSize;
+
+  short GetFirstVoxelValue(int t)
+  {
+    mitk::ImagePixelReadAccessor<short, 3> readAccess(m_Image, m_Image->GetVolumeData(t));
+    itk::Index<3> index;
+    index.Fill(0);
+    return readAccess.GetPixelByIndex(index);
+  }
+
+public:
+  void setUp() override
+  {
+    m_Image = mitk::Image::New();
+    std::array<unsigned int, 4> dimensions = {{ 16, 8, 4, 5 }};
+    m_Image->Initialize(mitk::MakeScalarPixelType<short>(), 4, dimensions.data());
+    m_VolumeSize = 16 * 8 * 4 * sizeof(short);
+
+    m_Provider = TimeStepValueProvider::New();
+    m_Image->SetVolumeProvider(m_Provider);
+  }
+
+  void tearDown() override
+  {
+    m_Image = nullptr;
+    m_Provider = nullptr;
+  }
+
+  void TestVolumesAreProvidedOnDemand()
+  {
+    CPPUNIT_ASSERT(!m_Image->IsVolumeSet(3));
+    CPPUNIT_ASSERT_EQUAL(short(3), GetFirstVoxelValue(3));
+    CPPUNIT_ASSERT(m_Image->IsVolumeSet(3));
+    CPPUNIT_ASSERT(!m_Image->IsVolumeSet(2));
+
+    // an available volume is not provided again
+    CPPUNIT_ASSERT_EQUAL(short(3), GetFirstVoxelValue(3));
+    CPPUNIT_ASSERT_EQUAL(1u, m_Provider->m_NumberOfCalls);
+  }
+
+  void TestMemoryBudgetReleasesLeastRecentlyUsedVolumes()
+  {
+    m_Image->SetProvidedVolumesMemoryBudget(2 * m_VolumeSize);
+
+    GetFirstVoxelValue(0);
+    GetFirstVoxelValue(1);
+    GetFirstVoxelValue(0);
+    GetFirstVoxelValue(2);
+
+    // time step 1 was accessed least recently
+    CPPUNIT_ASSERT(m_Image->IsVolumeSet(0));
+    CPPUNIT_ASSERT(!m_Image->IsVolumeSet(1));
+    CPPUNIT_ASSERT(m_Image->IsVolumeSet(2));
+
+    CPPUNIT_ASSERT_EQUAL(short(1), GetFirstVoxelValue(1));
+    CPPUNIT_ASSERT_EQUAL(4u, m_Provider->m_NumberOfCalls);
+  }
+
+  void TestImportedVolumesTakePrecedence()
+  {
+    std::vector<short> data(m_VolumeSize / sizeof(short), 42);
+    m_Image->SetVolume(data.data(), 1);
+    m_Image->SetProvidedVolumesMemoryBudget(m_VolumeSize);
+
+    GetFirstVoxelValue(0);
+    GetFirstVoxelValue(2);
+
+    CPPUNIT_ASSERT_EQUAL(short(42), GetFirstVoxelValue(1));
+    CPPUNIT_ASSERT(m_Image->IsVolumeSet(1));
+    CPPUNIT_ASSERT_EQUAL(2u, m_Provider->m_NumberOfCalls);
+  }
+
+  void TestChannelDataIsAssembledFromProvidedVolumes()
+  {
+    m_Image->SetProvidedVolumesMemoryBudget(m_VolumeSize);
+
+    mitk::ImagePixelReadAccessor<short, 4> readAccess(m_Image, m_Image->GetChannelData());
+    itk::Index<4> index;
+    index.Fill(0);
+    for (unsigned int t = 0; t < m_Image->GetDimension(3); ++t)
+    {
+      index[3] = t;
+      CPPUNIT_ASSERT_EQUAL(static_cast<short>(t), readAccess.GetPixelByIndex(index));
+    }
+    CPPUNIT_ASSERT(m_Image->IsChannelSet());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageVolumeProvider)
@@ -18,10 +18,12 @@ found in the LICENSE file.
 #include "mitkIOUtil.h"
 #include "mitkITKImageImport.h"
 #include <mitkExtractSliceFilter.h>
+#include <mitkImageReadAccessor.h>
 
 #include "itksys/SystemTools.hxx"
 #include <itkImageRegionIterator.h>
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 
@@ -43,6 +45,8 @@ class mitkItkImageIOTestSuite : public mitk::TestFixture
   MITK_TEST(TestWrite3DImageWithTwoPlanes);
   MITK_TEST(TestWrite3DplusT_ArbitraryTG);
   MITK_TEST(TestWrite3DplusT_ProportionalTG);
+  MITK_TEST(TestParallelCompressionNrrd);
+  MITK_TEST(TestParallelCompressionNifti);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -62,6 +66,9 @@ public:
     TestImageWriter("3D+t-ITKIO-TestData/LinearModel_4D_prop_time_geometry.nrrd");
   }
 
+  void TestParallelCompressionNrrd() { TestParallelCompression("XXXXXX.nrrd"); }
+  void TestParallelCompressionNifti() { TestParallelCompression("XXXXXX.nii.gz"); }
+
   void TestImageWriterSimple()
   {
     // TODO
@@ -418,6 +425,46 @@ public:
     CPPUNIT_ASSERT_THROW(mitk::IOUtil::Save(image, mitk::IOUtil::CreateTemporaryFile("3Dto2DTestImageXXXXXX.png")),
                          mitk::Exception);
   }
+
+  /**
+  * Write an image spanning several compression blocks on several threads and compare the pixels after reading
+  */
+  void TestParallelCompression(const std::string &templateName)
+  {
+    typedef itk::Image<short, 3> ImageType;
+
+    ImageType::Pointer itkImage = ImageType::New();
+    ImageType::SizeType size;
+    size[0] = 256;
+    size[1] = 256;
+    size[2] = 20;
+    itkImage->SetRegions(size);
+    itkImage->Allocate();
+
+    itk::ImageRegionIterator<ImageType> imageIterator(itkImage, itkImage->GetLargestPossibleRegion());
+    for (short value = 0; !imageIterator.IsAtEnd(); ++imageIterator, ++value)
+      imageIterator.Set(value % 1000);
+
+    mitk::Image::Pointer image = mitk::ImportItkImage(itkImage);
+
+    std::string tmpFilePath = mitk::IOUtil::CreateTemporaryFile(templateName);
+
+    mitk::IFileWriter::Options options;
+    options["Compression threads"] = 4;
+    mitk::IOUtil::Save(image, tmpFilePath, options);
+
+    mitk::Image::Pointer compareImage = mitk::IOUtil::Load<mitk::Image>(tmpFilePath);
+    std::remove(tmpFilePath.c_str());
+    CPPUNIT_ASSERT_MESSAGE("Compressed image was loaded again", compareImage.IsNotNull());
+
+    const std::size_t byteSize = size[0] * size[1] * size[2] * sizeof(short);
+    mitk::ImageReadAccessor imageAccess(image);
+    mitk::ImageReadAccessor compareAccess(compareImage);
+    CPPUNIT_ASSERT_MESSAGE("Pixels are equal after compression",
+                           std::equal(static_cast<const char *>(imageAccess.GetData()),
+                                      static_cast<const char *>(imageAccess.GetData()) + byteSize,
+                                      static_cast<const char *>(compareAccess.GetData())));
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkItkImageIO)
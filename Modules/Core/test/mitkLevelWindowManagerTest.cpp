@@ -328,6 +328,40 @@ public:
                         "Testing exclusive imageForLevelWindow property for node 3.");
   }
 
+  static void TestImageForLevelWindowOnLayerChange(std::string testImageFile)
+  {
+    mitk::LevelWindowManager::Pointer manager = mitk::LevelWindowManager::New();
+    mitk::StandaloneDataStorage::Pointer ds = mitk::StandaloneDataStorage::New();
+    manager->SetDataStorage(ds);
+
+    mitk::DataNode::Pointer node3 = mitk::IOUtil::Load(testImageFile, *ds)->GetElement(0);
+    mitk::DataNode::Pointer node2 = mitk::IOUtil::Load(testImageFile, *ds)->GetElement(0);
+    mitk::DataNode::Pointer node1 = mitk::IOUtil::Load(testImageFile, *ds)->GetElement(0);
+
+    node3->SetIntProperty("layer", 1);
+    node2->SetIntProperty("layer", 2);
+    node1->SetIntProperty("layer", 3);
+
+    MITK_TEST_CONDITION(manager->GetCurrentImage() == node1->GetData(), "Testing top-most image in auto top-most mode.");
+
+    node3->SetIntProperty("layer", 4);
+    MITK_TEST_CONDITION(manager->GetCurrentImage() == node3->GetData(), "Testing top-most image after layer change.");
+
+    node3->SetVisibility(false);
+    MITK_TEST_CONDITION(manager->GetCurrentImage() == node1->GetData(),
+                        "Testing top-most image after visibility change.");
+
+    node2->SetIntProperty("layer", 5);
+    bool isImageForLevelWindow1, isImageForLevelWindow2, isImageForLevelWindow3;
+    node1->GetBoolProperty("imageForLevelWindow", isImageForLevelWindow1);
+    node2->GetBoolProperty("imageForLevelWindow", isImageForLevelWindow2);
+    node3->GetBoolProperty("imageForLevelWindow", isImageForLevelWindow3);
+
+    MITK_TEST_CONDITION(!isImageForLevelWindow1 && isImageForLevelWindow2 && !isImageForLevelWindow3,
+                        "Testing exclusive imageForLevelWindow property after layer change.");
+    MITK_TEST_CONDITION(manager->GetNumberOfObservers() == 3, "Testing that layer changes keep the observers.");
+  }
+
   static void TestImageForLevelWindowOnRandomPropertyChange(std::string testImageFile)
   {
     typedef std::vector<bool> BoolVecType;
@@ -614,6 +648,7 @@ int mitkLevelWindowManagerTest(int argc, char *args[])
   mitkLevelWindowManagerTestClass::TestLevelWindowSliderVisibility(testImage);
   mitkLevelWindowManagerTestClass::TestSetLevelWindowProperty(testImage);
   mitkLevelWindowManagerTestClass::TestImageForLevelWindowOnVisibilityChange(testImage);
+  mitkLevelWindowManagerTestClass::TestImageForLevelWindowOnLayerChange(testImage);
   mitkLevelWindowManagerTestClass::TestImageForLevelWindowOnRandomVisibilityChange(testImage);
   mitkLevelWindowManagerTestClass::TestImageForLevelWindowOnRandomPropertyChange(testImage);
 
@@ -0,0 +1,77 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkLookupTable.h>
+#include <vtkMitkLevelWindowShaderMapper.h>
+
+#include <vtkColorTransferFunction.h>
+#include <vtkImageData.h>
+#include <vtkLookupTable.h>
+#include <vtkSmartPointer.h>
+
+class mitkLevelWindowShaderMapperTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkLevelWindowShaderMapperTestSuite);
+  MITK_TEST(IsSliceSupported_ScalarSlice_ReturnsTrue);
+  MITK_TEST(IsSliceSupported_VolumeOrRGB_ReturnsFalse);
+  MITK_TEST(IsLookupTableSupported_MitkLookupTables_ReturnsTrue);
+  MITK_TEST(IsLookupTableSupported_OtherMappings_ReturnsFalse);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  vtkSmartPointer<vtkImageData> CreateSlice(int depth, int components)
+  {
+    auto slice = vtkSmartPointer<vtkImageData>::New();
+    slice->SetDimensions(16, 8, depth);
+    slice->AllocateScalars(VTK_SHORT, components);
+    return slice;
+  }
+
+public:
+  void IsSliceSupported_ScalarSlice_ReturnsTrue()
+  {
+    CPPUNIT_ASSERT(vtkMitkLevelWindowShaderMapper::IsSliceSupported(CreateSlice(1, 1)));
+  }
+
+  void IsSliceSupported_VolumeOrRGB_ReturnsFalse()
+  {
+    CPPUNIT_ASSERT(!vtkMitkLevelWindowShaderMapper::IsSliceSupported(nullptr));
+    CPPUNIT_ASSERT(!vtkMitkLevelWindowShaderMapper::IsSliceSupported(vtkSmartPointer<vtkImageData>::New()));
+    CPPUNIT_ASSERT(!vtkMitkLevelWindowShaderMapper::IsSliceSupported(CreateSlice(3, 1)));
+    CPPUNIT_ASSERT(!vtkMitkLevelWindowShaderMapper::IsSliceSupported(CreateSlice(1, 3)));
+  }
+
+  void IsLookupTableSupported_MitkLookupTables_ReturnsTrue()
+  {
+    auto lookupTable = mitk::LookupTable::New();
+    lookupTable->SetType(mitk::LookupTable::GRAYSCALE);
+    CPPUNIT_ASSERT(vtkMitkLevelWindowShaderMapper::IsLookupTableSupported(lookupTable->GetVtkLookupTable()));
+    lookupTable->SetType(mitk::LookupTable::LEGACY_BINARY);
+    CPPUNIT_ASSERT(vtkMitkLevelWindowShaderMapper::IsLookupTableSupported(lookupTable->GetVtkLookupTable()));
+  }
+
+  void IsLookupTableSupported_OtherMappings_ReturnsFalse()
+  {
+    CPPUNIT_ASSERT(!vtkMitkLevelWindowShaderMapper::IsLookupTableSupported(nullptr));
+    CPPUNIT_ASSERT(!vtkMitkLevelWindowShaderMapper::IsLookupTableSupported(
+      vtkSmartPointer<vtkColorTransferFunction>::New()));
+
+    auto logarithmic = vtkSmartPointer<vtkLookupTable>::New();
+    logarithmic->SetScaleToLog10();
+    CPPUNIT_ASSERT(!vtkMitkLevelWindowShaderMapper::IsLookupTableSupported(logarithmic));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkLevelWindowShaderMapper)
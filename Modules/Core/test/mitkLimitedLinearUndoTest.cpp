@@ -0,0 +1,103 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkInteractionConst.h>
+#include <mitkLimitedLinearUndo.h>
+#include <mitkOperation.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+namespace
+{
+  class SizedTestOperation : public mitk::Operation
+  {
+  public:
+    SizedTestOperation(std::size_t memorySize) : Operation(mitk::OpTEST), m_MemorySize(memorySize) {}
+    std::size_t GetMemorySize() const override { return m_MemorySize; }
+
+  private:
+    std::size_t m_MemorySize;
+  };
+}
+
+class mitkLimitedLinearUndoTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkLimitedLinearUndoTestSuite);
+  MITK_TEST(SetOperationEvent_UndoLimit_EvictsOldestItems);
+  MITK_TEST(SetOperationEvent_MemoryLimit_EvictsOldestItems);
+  MITK_TEST(SetMemoryLimit_KeepsMostRecentItem);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::LimitedLinearUndo::Pointer m_Undo;
+
+  void AddOperationEvent(std::size_t memorySize)
+  {
+    m_Undo->SetOperationEvent(new mitk::OperationEvent(
+      nullptr, new SizedTestOperation(memorySize), new SizedTestOperation(memorySize), "Test"));
+    mitk::OperationEvent::IncCurrObjectEventId();
+  }
+
+public:
+  void setUp() override { m_Undo = mitk::LimitedLinearUndo::New(); }
+
+  void tearDown() override { m_Undo = nullptr; }
+
+  void SetOperationEvent_UndoLimit_EvictsOldestItems()
+  {
+    m_Undo->SetUndoLimit(2);
+    for (int i = 0; i < 5; ++i)
+      this->AddOperationEvent(10);
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(40), m_Undo->GetMemorySize());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), m_Undo->GetNumberOfEvictedItems());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(60), m_Undo->GetEvictedMemorySize());
+
+    m_Undo->ResetEvictionStatistics();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_Undo->GetNumberOfEvictedItems());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_Undo->GetEvictedMemorySize());
+  }
+
+  void SetOperationEvent_MemoryLimit_EvictsOldestItems()
+  {
+    m_Undo->SetMemoryLimit(100);
+    for (int i = 0; i < 4; ++i)
+      this->AddOperationEvent(10);
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_Undo->GetNumberOfEvictedItems());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(80), m_Undo->GetMemorySize());
+
+    // undone items still count until a new operation clears the redo list
+    m_Undo->Undo();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(80), m_Undo->GetMemorySize());
+
+    this->AddOperationEvent(30);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), m_Undo->GetNumberOfEvictedItems());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(20), m_Undo->GetEvictedMemorySize());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(100), m_Undo->GetMemorySize());
+  }
+
+  void SetMemoryLimit_KeepsMostRecentItem()
+  {
+    this->AddOperationEvent(10);
+    this->AddOperationEvent(500);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1020), m_Undo->GetMemorySize());
+
+    m_Undo->SetMemoryLimit(100);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), m_Undo->GetNumberOfEvictedItems());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1000), m_Undo->GetMemorySize());
+    CPPUNIT_ASSERT(m_Undo->Undo() == false);
+    CPPUNIT_ASSERT(m_Undo->RedoListEmpty() == false);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkLimitedLinearUndo)
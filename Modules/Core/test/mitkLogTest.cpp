@@ -14,6 +14,7 @@ found in the LICENSE file.
 #include "mitkTestingMacros.h"
 #include <itkMultiThreader.h>
 #include <itksys/SystemTools.hxx>
+#include <mbilogBackendAsync.h>
 #include <mitkLog.h>
 #include <mitkNumericTypes.h>
 #include <mitkStandardFileLocations.h>
@@ -43,6 +44,27 @@ public:
 private:
   bool m_Called;
 };
+/** Documentation
+ *
+ * @brief this class counts the processed messages and remembers the thread they were processed by.
+ * It is needed for the asynchronous backend test.
+ */
+class TestBackendCounting : public mbilog::BackendBase
+{
+public:
+  TestBackendCounting() : m_NumberOfMessages(0) {}
+
+  void ProcessMessage(const mbilog::LogMessage &) override
+  {
+    ++m_NumberOfMessages;
+    m_ThreadId = std::this_thread::get_id();
+  }
+
+  mbilog::OutputType GetOutputType() const override { return mbilog::Other; }
+
+  unsigned int m_NumberOfMessages;
+  std::thread::id m_ThreadId;
+};
 /** Documentation
   *
   * @brief Objects of this class can start an internal thread by calling the Start() method.
@@ -266,6 +288,28 @@ public:
     MITK_TEST_CONDITION_REQUIRED(true, "Test add/remove logging backend.");
   }
 
+  static void TestAsynchronousBackend()
+  {
+    TestBackendCounting countingBackend;
+    {
+      mbilog::BackendAsync asyncBackend(&countingBackend);
+      mbilog::RegisterBackend(&asyncBackend);
+
+      for (int i = 0; i < 1000; ++i)
+        MITK_INFO << "Test asynchronous logging " << i;
+      asyncBackend.Flush();
+
+      MITK_TEST_CONDITION(countingBackend.m_NumberOfMessages == 1000, "Test flushing the asynchronous backend.");
+      MITK_TEST_CONDITION(countingBackend.m_ThreadId != std::this_thread::get_id(),
+                          "Test writing on a dedicated thread.");
+
+      MITK_INFO << "Written when the asynchronous backend is destroyed";
+      mbilog::UnregisterBackend(&asyncBackend);
+    }
+    MITK_TEST_CONDITION_REQUIRED(countingBackend.m_NumberOfMessages == 1001,
+                                 "Test writing pending messages on destruction.");
+  }
+
   static void TestDefaultBackend()
   {
     // not possible now, because we cannot unregister the mitk logging backend in the moment. If such a method is added
@@ -305,6 +349,7 @@ int mitkLogTest(int /* argc */, char * /*argv*/ [])
   mitkLogTestClass::TestThreadSaveLog(false); // false = to console
   mitkLogTestClass::TestThreadSaveLog(true);  // true = to file
   mitkLogTestClass::TestEnableDisableBackends();
+  mitkLogTestClass::TestAsynchronousBackend();
   // TODO actually test file somehow?
 
   // always end with this!
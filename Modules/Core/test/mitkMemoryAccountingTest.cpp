@@ -0,0 +1,249 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <array>
+#include <thread>
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkImage.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkMemoryAccounting.h>
+#include <mitkStandaloneDataStorage.h>
+
+namespace
+{
+  const std::size_t VolumeSize = 16 * 8 * 4 * sizeof(short);
+
+  class FakeCache : public mitk::MemoryAccounting::Cache
+  {
+  public:
+    explicit FakeCache(std::size_t size) : m_Size(size) {}
+
+    std::size_t GetCacheSize() const override { return m_Size; }
+    void ReleaseCache() override { m_Size = 0; }
+
+    std::size_t m_Size;
+  };
+}
+
+class mitkMemoryAccountingTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkMemoryAccountingTestSuite);
+  MITK_TEST(GetUsage_ImageWithCache_CountsVolumesAndCache);
+  MITK_TEST(EnforceBudget_CachesExceedBudget_ReleasesLeastRecentlyUsedFirst);
+  MITK_TEST(EnforceBudget_BudgetNotReachable_CallsCallback);
+  MITK_TEST(EnforceBudget_InvisibleImage_IsHibernated);
+  MITK_TEST(Hibernate_Image_KeepsContent);
+  MITK_TEST(Hibernate_ReferencedVolume_IsKept);
+  MITK_TEST(SetProvidedVolumesMemoryBudget_AccessedVolume_IsKept);
+  MITK_TEST(HibernateIdleImages_InvisibleForDelay_IsHibernatedIntoFactoryStore);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+  mitk::DataNode::Pointer m_Node;
+  mitk::StandaloneDataStorage::Pointer m_DataStorage;
+
+public:
+  void setUp() override
+  {
+    m_Image = mitk::Image::New();
+    std::array<unsigned int, 4> dimensions = {{16, 8, 4, 3}};
+    m_Image->Initialize(mitk::MakeScalarPixelType<short>(), 4, dimensions.data());
+
+    for (int t = 0; t < 3; ++t)
+    {
+      mitk::ImagePixelWriteAccessor<short, 3> writeAccess(m_Image, m_Image->GetVolumeData(t));
+      for (unsigned int i = 0; i < 16 * 8 * 4; ++i)
+        writeAccess.GetData()[i] = static_cast<short>(100 * t + i);
+    }
+
+    m_Node = mitk::DataNode::New();
+    m_Node->SetData(m_Image);
+    m_DataStorage = mitk::StandaloneDataStorage::New();
+    m_DataStorage->Add(m_Node);
+  }
+
+  void tearDown() override
+  {
+    m_DataStorage = nullptr;
+    m_Node = nullptr;
+    m_Image = nullptr;
+  }
+
+  void GetUsage_ImageWithCache_CountsVolumesAndCache()
+  {
+    mitk::MemoryAccounting accounting;
+    FakeCache cache(1000);
+    accounting.RegisterCache(&cache, mitk::MemoryAccounting::ResliceCacheType, m_Image);
+
+    const auto usage = accounting.GetUsage(m_Node);
+    CPPUNIT_ASSERT_EQUAL(3 * VolumeSize, usage.DataSize);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1000), usage.CacheSize);
+
+    auto usageByType = accounting.GetUsageByType(m_DataStorage);
+    CPPUNIT_ASSERT_EQUAL(3 * VolumeSize, usageByType[mitk::MemoryAccounting::ImageDataType]);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1000), usageByType[mitk::MemoryAccounting::ResliceCacheType]);
+    CPPUNIT_ASSERT_EQUAL(3 * VolumeSize + 1000, accounting.GetTotalUsage(m_DataStorage));
+
+    accounting.UnregisterCache(&cache);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), accounting.GetUsage(m_Node).CacheSize);
+  }
+
+  void EnforceBudget_CachesExceedBudget_ReleasesLeastRecentlyUsedFirst()
+  {
+    mitk::MemoryAccounting accounting;
+    FakeCache oldCache(1000);
+    FakeCache recentCache(1000);
+    accounting.RegisterCache(&oldCache, mitk::MemoryAccounting::ResliceCacheType, m_Image);
+    accounting.RegisterCache(&recentCache, mitk::MemoryAccounting::ResliceCacheType, m_Image);
+    accounting.TouchCache(&recentCache);
+
+    accounting.SetBudget(3 * VolumeSize + 1500);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1000), accounting.EnforceBudget(m_DataStorage));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), oldCache.m_Size);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1000), recentCache.m_Size);
+
+    accounting.UnregisterCache(&oldCache);
+    accounting.UnregisterCache(&recentCache);
+  }
+
+  void EnforceBudget_BudgetNotReachable_CallsCallback()
+  {
+    mitk::MemoryAccounting accounting;
+    std::size_t reportedUsage = 0;
+    accounting.SetBudgetExceededCallback([&reportedUsage](std::size_t usage, std::size_t) { reportedUsage = usage; });
+
+    // the image is visible, so it is not hibernated
+    accounting.SetHibernateInvisibleImages(true);
+    accounting.SetBudget(VolumeSize);
+    accounting.EnforceBudget(m_DataStorage);
+
+    CPPUNIT_ASSERT_EQUAL(3 * VolumeSize, reportedUsage);
+    CPPUNIT_ASSERT(m_Image->IsVolumeSet(0));
+  }
+
+  void EnforceBudget_InvisibleImage_IsHibernated()
+  {
+    mitk::MemoryAccounting accounting;
+    accounting.SetBudget(VolumeSize);
+    m_Node->SetVisibility(false);
+
+    // hibernation is disabled by default
+    accounting.EnforceBudget(m_DataStorage);
+    CPPUNIT_ASSERT_EQUAL(3 * VolumeSize, mitk::MemoryAccounting::GetDataSize(m_Image));
+
+    accounting.SetHibernateInvisibleImages(true);
+    CPPUNIT_ASSERT_EQUAL(3 * VolumeSize, accounting.EnforceBudget(m_DataStorage));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), mitk::MemoryAccounting::GetDataSize(m_Image));
+  }
+
+  void Hibernate_Image_KeepsContent()
+  {
+    CPPUNIT_ASSERT_EQUAL(3 * VolumeSize, m_Image->Hibernate());
+    CPPUNIT_ASSERT(!m_Image->IsVolumeSet(1));
+
+    {
+      mitk::ImagePixelReadAccessor<short, 3> readAccess(m_Image, m_Image->GetVolumeData(1));
+      for (unsigned int i = 0; i < 16 * 8 * 4; ++i)
+        CPPUNIT_ASSERT_EQUAL(static_cast<short>(100 + i), readAccess.GetData()[i]);
+    }
+
+    // hibernating again copies the released volumes from the earlier hibernation
+    CPPUNIT_ASSERT_EQUAL(VolumeSize, m_Image->Hibernate());
+
+    mitk::ImagePixelReadAccessor<short, 3> readAccess(m_Image, m_Image->GetVolumeData(2));
+    for (unsigned int i = 0; i < 16 * 8 * 4; ++i)
+      CPPUNIT_ASSERT_EQUAL(static_cast<short>(200 + i), readAccess.GetData()[i]);
+  }
+
+  void Hibernate_ReferencedVolume_IsKept()
+  {
+    // the referenced volume is the first candidate for release and is skipped, the others are released
+    mitk::Image::ImageDataItemPointer volume = m_Image->GetVolumeData(2);
+    m_Image->Hibernate();
+
+    CPPUNIT_ASSERT(volume->IsComplete());
+    {
+      mitk::ImagePixelReadAccessor<short, 3> readAccess(m_Image, volume);
+      for (unsigned int i = 0; i < 16 * 8 * 4; ++i)
+        CPPUNIT_ASSERT_EQUAL(static_cast<short>(200 + i), readAccess.GetData()[i]);
+    }
+
+    for (int t = 0; t < 3; ++t)
+    {
+      mitk::ImagePixelReadAccessor<short, 3> readAccess(m_Image, m_Image->GetVolumeData(t));
+      for (unsigned int i = 0; i < 16 * 8 * 4; ++i)
+        CPPUNIT_ASSERT_EQUAL(static_cast<short>(100 * t + i), readAccess.GetData()[i]);
+    }
+  }
+
+  void SetProvidedVolumesMemoryBudget_AccessedVolume_IsKept()
+  {
+    CPPUNIT_ASSERT_EQUAL(3 * VolumeSize, m_Image->Hibernate());
+
+    // restore the volumes, time step 0 is the least recently provided one
+    mitk::Image::ImageDataItemPointer volume = m_Image->GetVolumeData(0);
+    m_Image->GetVolumeData(1);
+    m_Image->GetVolumeData(2);
+    CPPUNIT_ASSERT(m_Image->IsVolumeSet(0) && m_Image->IsVolumeSet(1) && m_Image->IsVolumeSet(2));
+
+    {
+      mitk::ImagePixelReadAccessor<short, 3> readAccess(m_Image, volume);
+      volume = nullptr;
+
+      // time step 0 is accessed, time step 2 was provided most recently, so only time step 1 is released
+      m_Image->SetProvidedVolumesMemoryBudget(VolumeSize);
+      CPPUNIT_ASSERT(m_Image->IsVolumeSet(0));
+      CPPUNIT_ASSERT(!m_Image->IsVolumeSet(1));
+      CPPUNIT_ASSERT(m_Image->IsVolumeSet(2));
+      CPPUNIT_ASSERT_EQUAL(static_cast<short>(1), readAccess.GetData()[1]);
+    }
+
+    // the budget is met as soon as the volume is not accessed anymore
+    m_Image->SetProvidedVolumesMemoryBudget(VolumeSize);
+    CPPUNIT_ASSERT(!m_Image->IsVolumeSet(0));
+    CPPUNIT_ASSERT(m_Image->IsVolumeSet(2));
+
+    mitk::ImagePixelReadAccessor<short, 3> readAccess(m_Image, m_Image->GetVolumeData(1));
+    for (unsigned int i = 0; i < 16 * 8 * 4; ++i)
+      CPPUNIT_ASSERT_EQUAL(static_cast<short>(100 + i), readAccess.GetData()[i]);
+  }
+
+  void HibernateIdleImages_InvisibleForDelay_IsHibernatedIntoFactoryStore()
+  {
+    mitk::MemoryAccounting accounting;
+    accounting.SetDataStorage(m_DataStorage);
+    accounting.SetIdleHibernationDelay(std::chrono::seconds(1));
+
+    mitk::MappedFileHibernationStore::Pointer store = mitk::MappedFileHibernationStore::New();
+    accounting.SetHibernationStoreFactory([&store]() { return store.GetPointer(); });
+
+    // visible images are never idle
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), accounting.HibernateIdleImages());
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), accounting.HibernateIdleImages());
+
+    m_Node->SetVisibility(false);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), accounting.HibernateIdleImages());
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    CPPUNIT_ASSERT_EQUAL(3 * VolumeSize, accounting.HibernateIdleImages());
+    CPPUNIT_ASSERT(m_Image->GetVolumeProvider() == store.GetPointer());
+
+    accounting.SetDataStorage(nullptr);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkMemoryAccounting)
@@ -41,6 +41,8 @@ class mitkPointSetTestSuite : public mitk::TestFixture
   MITK_TEST(TestRemovePointInterface);
   MITK_TEST(TestMaxIdAccess);
   MITK_TEST(TestInsertPointAtEnd);
+  MITK_TEST(TestSearchPointInLargePointSet);
+  MITK_TEST(TestSearchClosestPointInLargePointSet);
 
   CPPUNIT_TEST_SUITE_END();
 
@@ -478,6 +480,77 @@ std::cout<<"[PASSED]"<<std::endl;
     pointSet->InsertPoint(in4, 7);
     MITK_ASSERT_EQUAL(pointSet, refPs4, "Check point insertion for time step 7.");
   }
+
+  void TestSearchPointInLargePointSet()
+  {
+    // A grid of 20 x 20 x 3 points with a spacing of 2, large enough to be searched by the spatial index
+    mitk::PointSet::Pointer largePointSet = mitk::PointSet::New();
+
+    for (int z = 0; z < 3; ++z)
+      for (int y = 0; y < 20; ++y)
+        for (int x = 0; x < 20; ++x)
+        {
+          mitk::Point3D point;
+          mitk::FillVector3D(point, 2.0 * x, 2.0 * y, 2.0 * z);
+          largePointSet->InsertPoint(point);
+        }
+
+    mitk::Point3D query;
+    mitk::FillVector3D(query, 10.4, 10.0, 2.0);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Closest point within the distance", 505, largePointSet->SearchPoint(query, 0.5));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("No point within the distance", -1, largePointSet->SearchPoint(query, 0.3));
+
+    // The point exactly in the middle of two points is assigned to the one first in the list
+    mitk::FillVector3D(query, 11.0, 10.0, 2.0);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Equally close points", 505, largePointSet->SearchPoint(query, 1.5));
+
+    // Moving, inserting and removing points by operations updates the index
+    mitk::Point3D target;
+    mitk::FillVector3D(target, 100.0, 100.0, 100.0);
+    mitk::PointOperation moveOperation(mitk::OpMOVE, 0, target, 505);
+    largePointSet->ExecuteOperation(&moveOperation);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE(
+      "Moved point is found at its new position", 505, largePointSet->SearchPoint(target, 0.1));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE(
+      "Moved point is not found at its old position", 506, largePointSet->SearchPoint(query, 1.5));
+
+    mitk::PointOperation removeOperation(mitk::OpREMOVE, 0, target, 505);
+    largePointSet->ExecuteOperation(&removeOperation);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Removed point is not found", -1, largePointSet->SearchPoint(target, 0.1));
+
+    mitk::PointOperation insertOperation(mitk::OpINSERT, 0, target, 2000);
+    largePointSet->ExecuteOperation(&insertOperation);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Inserted point is found", 2000, largePointSet->SearchPoint(target, 0.1));
+
+    // Changes which do not use operations cause a rebuild of the index
+    largePointSet->SetPoint(0, target);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Point set without an operation is found", 0, largePointSet->SearchPoint(target, 0.1));
+  }
+
+  void TestSearchClosestPointInLargePointSet()
+  {
+    mitk::PointSet::Pointer largePointSet = mitk::PointSet::New();
+
+    for (int y = 0; y < 20; ++y)
+      for (int x = 0; x < 20; ++x)
+      {
+        mitk::Point3D point;
+        mitk::FillVector3D(point, 2.0 * x, 2.0 * y, 0.0);
+        largePointSet->InsertPoint(point);
+      }
+
+    // Scale the geometry, so that world and index coordinates differ
+    mitk::Vector3D spacing;
+    mitk::FillVector3D(spacing, 2.0, 2.0, 2.0);
+    largePointSet->GetGeometry()->SetSpacing(spacing);
+
+    mitk::Point3D query = largePointSet->GetPoint(42);
+    query[0] += 0.5;
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE(
+      "Closest point within the distance", 42, largePointSet->SearchClosestPoint(query, 1.0));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("No point within the distance", -1, largePointSet->SearchClosestPoint(query, 0.4));
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkPointSet)
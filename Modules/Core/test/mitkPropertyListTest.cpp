@@ -255,6 +255,36 @@ int mitkPropertyListTest(int /*argc*/, char * /*argv*/ [])
     std::cout << "[PASSED]" << std::endl;
   }
 
+  {
+    std::cout << "Testing GetProperty() with interned keys: ";
+    const mitk::PropertyKey firstKey("first");
+    const mitk::PropertyKey secondKey("second");
+    mitk::BoolProperty::Pointer first = mitk::BoolProperty::New(true);
+    mitk::IntProperty::Pointer second = mitk::IntProperty::New(3);
+    propList->SetProperty("second", second);
+    propList->SetProperty("first", first);
+    bool found = propList->GetProperty(firstKey) == first && propList->GetProperty(secondKey) == second;
+
+    mitk::IntProperty::Pointer replacement = mitk::IntProperty::New(4);
+    propList->ReplaceProperty("second", replacement);
+    found = found && propList->GetProperty(secondKey) == replacement;
+
+    mitk::PropertyList::Pointer clonedList = propList->Clone();
+    found = found && clonedList->GetProperty(secondKey) == clonedList->GetProperty("second") &&
+            clonedList->GetProperty(secondKey) != nullptr;
+
+    propList->DeleteProperty("first");
+    propList->RemoveProperty("second");
+    found = found && propList->GetProperty(firstKey) == nullptr && propList->GetProperty(secondKey) == nullptr &&
+            propList->GetProperty(mitk::PropertyKey("never set")) == nullptr;
+    if (!found)
+    {
+      std::cout << "[FAILED]" << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::cout << "[PASSED]" << std::endl;
+  }
+
   std::cout << "Testing SetProperty() with no property (nullptr): ";
   tBefore = propList->GetMTime();
   propList->SetProperty("nullprop", nullptr);
@@ -157,6 +157,65 @@ public:
     myRenderingManager->ForceImmediateUpdateAll();
   }
 
+  static void TestScheduling()
+  {
+    mitk::RenderingManager::Pointer myRenderingManager = mitk::RenderingManager::New();
+    vtkRenderWindow *vtkRenWin = vtkRenderWindow::New();
+    myRenderingManager->AddRenderWindow(vtkRenWin);
+
+    MITK_TEST_CONDITION(myRenderingManager->GetRenderWindowPriority(vtkRenWin) == 0, "Default priority is 0")
+    myRenderingManager->SetRenderWindowPriority(vtkRenWin, 5);
+    MITK_TEST_CONDITION(myRenderingManager->GetRenderWindowPriority(vtkRenWin) == 5, "Priority can be set")
+
+    MITK_TEST_CONDITION(myRenderingManager->GetFrameTimeBudget() == 0.0, "Frame time budget is disabled by default")
+    myRenderingManager->SetFrameTimeBudget(16.0);
+
+    myRenderingManager->RequestUpdate(vtkRenWin);
+    myRenderingManager->RequestUpdate(vtkRenWin);
+    myRenderingManager->RequestUpdate(vtkRenWin);
+    MITK_TEST_CONDITION(myRenderingManager->GetRenderWindowStatistics(vtkRenWin).NumberOfCoalescedRequests == 2,
+                        "Repeated requests are coalesced")
+
+    // the window has no size and is not rendered, but its request is satisfied
+    myRenderingManager->ExecutePendingRequests();
+    MITK_TEST_CONDITION(myRenderingManager->GetRenderWindowStatistics(vtkRenWin).NumberOfDeferrals == 0,
+                        "A single window is never deferred")
+    myRenderingManager->RequestUpdate(vtkRenWin);
+    MITK_TEST_CONDITION(myRenderingManager->GetRenderWindowStatistics(vtkRenWin).NumberOfCoalescedRequests == 2,
+                        "Requests after execution are not coalesced")
+
+    myRenderingManager->ResetRenderWindowStatistics();
+    MITK_TEST_CONDITION(myRenderingManager->GetRenderWindowStatistics(vtkRenWin).NumberOfCoalescedRequests == 0,
+                        "Statistics can be reset")
+
+    myRenderingManager->RemoveRenderWindow(vtkRenWin);
+    MITK_TEST_CONDITION(myRenderingManager->GetRenderWindowStatistics(vtkRenWin).NumberOfRenders == 0,
+                        "Statistics of unregistered windows are empty")
+    vtkRenWin->Delete();
+  }
+
+  static void TestInteraction()
+  {
+    mitk::RenderingManager::Pointer myRenderingManager = mitk::RenderingManager::New();
+    MITK_TEST_CONDITION(!myRenderingManager->IsInteractionInProgress(), "No interaction in progress initially")
+
+    myRenderingManager->StartInteraction();
+    myRenderingManager->StartInteraction();
+    myRenderingManager->EndInteraction();
+    MITK_TEST_CONDITION(myRenderingManager->IsInteractionInProgress(), "Nested interactions are counted")
+    myRenderingManager->EndInteraction();
+    MITK_TEST_CONDITION(!myRenderingManager->IsInteractionInProgress(), "Interaction ends with the last caller")
+    myRenderingManager->EndInteraction();
+    MITK_TEST_CONDITION(!myRenderingManager->IsInteractionInProgress(), "Unbalanced EndInteraction is ignored")
+
+    myRenderingManager->NotifyInteractionStep();
+    myRenderingManager->NotifyInteractionStep();
+    MITK_TEST_CONDITION(myRenderingManager->IsInteractionInProgress(), "Interaction steps start an interaction")
+    myRenderingManager->ExecutePendingHighResRenderingRequest();
+    MITK_TEST_CONDITION(!myRenderingManager->IsInteractionInProgress(),
+                        "The high resolution request ends an interaction of single steps")
+  }
+
 }; // mitkDataNodeTestClass
 int mitkRenderingManagerTest(int /* argc */, char * /*argv*/ [])
 {
@@ -165,6 +224,10 @@ int mitkRenderingManagerTest(int /* argc */, char * /*argv*/ [])
 
   mitkRenderingManagerTestClass::TestAddRemoveRenderWindow();
 
+  mitkRenderingManagerTestClass::TestScheduling();
+
+  mitkRenderingManagerTestClass::TestInteraction();
+
   mitk::RenderingManager::Pointer globalRenderingManager = mitk::RenderingManager::GetInstance();
 
   MITK_TEST_CONDITION_REQUIRED(globalRenderingManager.IsNotNull(), "Testing instantiation of global static instance")
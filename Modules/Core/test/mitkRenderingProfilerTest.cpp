@@ -0,0 +1,144 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkDataNode.h>
+#include <mitkPointSetVtkMapper2D.h>
+#include <mitkRenderingProfiler.h>
+
+#include <itkCommand.h>
+
+class mitkRenderingProfilerTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkRenderingProfilerTestSuite);
+  MITK_TEST(EndFrame_Disabled_RecordsNothing);
+  MITK_TEST(EndFrame_Enabled_SumsTimesPerMapper);
+  MITK_TEST(EndFrame_Enabled_InvokesEndEvent);
+  MITK_TEST(SetEnabled_DiscardsFrames);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::RenderingProfiler::Pointer m_Profiler;
+  mitk::DataNode::Pointer m_Node;
+  mitk::PointSetVtkMapper2D::Pointer m_Mapper;
+  unsigned int m_NumberOfEndEvents;
+
+  void OnEndEvent() { ++m_NumberOfEndEvents; }
+
+public:
+  void setUp() override
+  {
+    m_Profiler = mitk::RenderingProfiler::New();
+    m_Node = mitk::DataNode::New();
+    m_Node->SetName("landmarks");
+    m_Mapper = mitk::PointSetVtkMapper2D::New();
+    m_Mapper->SetDataNode(m_Node);
+    m_NumberOfEndEvents = 0;
+  }
+
+  void tearDown() override
+  {
+    m_Profiler = nullptr;
+    m_Mapper = nullptr;
+    m_Node = nullptr;
+  }
+
+  void EndFrame_Disabled_RecordsNothing()
+  {
+    CPPUNIT_ASSERT(!m_Profiler->GetEnabled());
+    m_Profiler->StartFrame();
+    m_Profiler->AddMapperUpdateTime(m_Mapper, 2.0);
+    m_Profiler->EndFrame();
+
+    CPPUNIT_ASSERT_EQUAL(0ul, m_Profiler->GetNumberOfFrames());
+    CPPUNIT_ASSERT_EQUAL(0ul, m_Profiler->GetLastFrame().FrameNumber);
+    CPPUNIT_ASSERT(m_Profiler->GetLastFrame().Mappers.empty());
+  }
+
+  void EndFrame_Enabled_SumsTimesPerMapper()
+  {
+    auto otherMapper = mitk::PointSetVtkMapper2D::New();
+
+    m_Profiler->EnabledOn();
+    m_Profiler->StartFrame();
+    m_Profiler->AddMapperUpdateTime(m_Mapper, 2.0);
+    m_Profiler->AddMapperRenderTime(otherMapper, 4.0);
+    m_Profiler->AddMapperRenderTime(m_Mapper, 1.0);
+    m_Profiler->AddMapperRenderTime(m_Mapper, 0.5);
+    m_Profiler->AddAnnotationTime(0.25);
+    m_Profiler->EndFrame();
+
+    const mitk::RenderingProfiler::FrameTimes &frame = m_Profiler->GetLastFrame();
+    CPPUNIT_ASSERT_EQUAL(1ul, frame.FrameNumber);
+    CPPUNIT_ASSERT_EQUAL(2.0, frame.MapperUpdateTime);
+    CPPUNIT_ASSERT_EQUAL(5.5, frame.MapperRenderTime);
+    CPPUNIT_ASSERT_EQUAL(0.25, frame.AnnotationTime);
+    CPPUNIT_ASSERT(frame.TotalTime >= 0.0);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), frame.Mappers.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("landmarks"), frame.Mappers[0].NodeName);
+    CPPUNIT_ASSERT_EQUAL(std::string("PointSetVtkMapper2D"), frame.Mappers[0].MapperName);
+    CPPUNIT_ASSERT_EQUAL(2.0, frame.Mappers[0].UpdateTime);
+    CPPUNIT_ASSERT_EQUAL(1.5, frame.Mappers[0].RenderTime);
+    CPPUNIT_ASSERT_EQUAL(4.0, frame.Mappers[1].RenderTime);
+
+    // the summary lists the slowest mappers first
+    const std::string summary = m_Profiler->GetSummary(1);
+    CPPUNIT_ASSERT(summary.find("Frame 1") != std::string::npos);
+    CPPUNIT_ASSERT(summary.find("update 2.0 ms, render 1.5 ms") == std::string::npos);
+    CPPUNIT_ASSERT(summary.find("update 0.0 ms, render 4.0 ms") != std::string::npos);
+
+    // the next frame starts empty
+    m_Profiler->StartFrame();
+    m_Profiler->EndFrame();
+    CPPUNIT_ASSERT_EQUAL(2ul, m_Profiler->GetLastFrame().FrameNumber);
+    CPPUNIT_ASSERT_EQUAL(0.0, m_Profiler->GetLastFrame().MapperUpdateTime);
+    CPPUNIT_ASSERT(m_Profiler->GetLastFrame().Mappers.empty());
+  }
+
+  void EndFrame_Enabled_InvokesEndEvent()
+  {
+    auto command = itk::SimpleMemberCommand<mitkRenderingProfilerTestSuite>::New();
+    command->SetCallbackFunction(this, &mitkRenderingProfilerTestSuite::OnEndEvent);
+    m_Profiler->AddObserver(itk::EndEvent(), command);
+
+    m_Profiler->EnabledOn();
+    // frames end only after they were started
+    m_Profiler->EndFrame();
+    CPPUNIT_ASSERT_EQUAL(0u, m_NumberOfEndEvents);
+
+    m_Profiler->StartFrame();
+    m_Profiler->EndFrame();
+    CPPUNIT_ASSERT_EQUAL(1u, m_NumberOfEndEvents);
+  }
+
+  void SetEnabled_DiscardsFrames()
+  {
+    m_Profiler->EnabledOn();
+    m_Profiler->StartFrame();
+    m_Profiler->AddMapperUpdateTime(m_Mapper, 2.0);
+    m_Profiler->EndFrame();
+    m_Profiler->AddMapperUpdateTime(m_Mapper, 3.0);
+
+    m_Profiler->EnabledOff();
+    m_Profiler->EnabledOn();
+    CPPUNIT_ASSERT_EQUAL(0ul, m_Profiler->GetNumberOfFrames());
+    CPPUNIT_ASSERT_EQUAL(0.0, m_Profiler->GetMaximumTotalTime());
+
+    m_Profiler->StartFrame();
+    m_Profiler->EndFrame();
+    CPPUNIT_ASSERT_EQUAL(0.0, m_Profiler->GetLastFrame().MapperUpdateTime);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkRenderingProfiler)
@@ -132,6 +132,48 @@ void mitkSlicedGeometry3D_ChangeImageGeometryConsideringOriginOffset_Test()
   MITK_TEST_CONDITION_REQUIRED(lastPlaneGeometry->GetOrigin() == originOfLastPlaneGeometry, "");
 }
 
+void mitkSlicedGeometry3D_GeneratedPlaneGeometries_Test()
+{
+  MITK_TEST_OUTPUT(<< "====== mitkSlicedGeometry3D_GeneratedPlaneGeometries_Test() ======");
+
+  mitk::ScalarType thicknessInMM = 2.0;
+  auto spacing = createVector(1.0, 1.0, thicknessInMM);
+
+  auto planeGeometry = mitk::PlaneGeometry::New();
+  planeGeometry->InitializeStandardPlane(createVector(100.0, 0.0, 0.0), createVector(0.0, 100.0, 0.0), &spacing);
+
+  auto numberOfSlices = 1000;
+  auto slicedGeometry = createEvenlySpacedSlicedGeometry(planeGeometry, thicknessInMM, numberOfSlices);
+
+  mitk::PlaneGeometry::Pointer heldPlaneGeometry = slicedGeometry->GetPlaneGeometry(1);
+
+  MITK_TEST_OUTPUT(<< "Check the origins of all PlaneGeometries of a stack with many slices");
+  bool allOriginsAreCorrect = true;
+  for (int s = 0; s < numberOfSlices; ++s)
+  {
+    auto expectedOrigin = createPoint(0.0, 0.0, thicknessInMM * s);
+    allOriginsAreCorrect &= mitk::Equal(slicedGeometry->GetPlaneGeometry(s)->GetOrigin(), expectedOrigin, slicedGeometryEps);
+  }
+  MITK_TEST_CONDITION_REQUIRED(allOriginsAreCorrect, "");
+
+  MITK_TEST_OUTPUT(<< "Check that a referenced PlaneGeometry is still returned after many other slices were requested");
+  MITK_TEST_CONDITION_REQUIRED(slicedGeometry->GetPlaneGeometry(1) == heldPlaneGeometry.GetPointer(), "");
+
+  MITK_TEST_OUTPUT(<< "Check that recently requested PlaneGeometries are reused");
+  MITK_TEST_CONDITION_REQUIRED(slicedGeometry->GetPlaneGeometry(numberOfSlices - 1) == slicedGeometry->GetPlaneGeometry(numberOfSlices - 1), "");
+
+  MITK_TEST_OUTPUT(<< "Check the PlaneGeometries of a clone");
+  auto clonedGeometry = slicedGeometry->Clone();
+  auto expectedOriginOfLastSlice = createPoint(0.0, 0.0, thicknessInMM * (numberOfSlices - 1));
+  MITK_TEST_CONDITION_REQUIRED(clonedGeometry->GetPlaneGeometry(numberOfSlices - 1) != slicedGeometry->GetPlaneGeometry(numberOfSlices - 1), "");
+  MITK_TEST_CONDITION_REQUIRED(mitk::Equal(clonedGeometry->GetPlaneGeometry(numberOfSlices - 1)->GetOrigin(), expectedOriginOfLastSlice, slicedGeometryEps), "");
+
+  MITK_TEST_OUTPUT(<< "Check that PlaneGeometries are kept when the stack is not evenly spaced anymore");
+  slicedGeometry->SetEvenlySpaced(false);
+  MITK_TEST_CONDITION_REQUIRED(slicedGeometry->GetPlaneGeometry(1) == heldPlaneGeometry.GetPointer(), "");
+  MITK_TEST_CONDITION_REQUIRED(mitk::Equal(slicedGeometry->GetPlaneGeometry(numberOfSlices - 1)->GetOrigin(), expectedOriginOfLastSlice, slicedGeometryEps), "");
+}
+
 int mitkSlicedGeometry3DTest(int, char *[])
 {
   mitk::ScalarType width = 100.0;
@@ -166,6 +208,7 @@ int mitkSlicedGeometry3DTest(int, char *[])
   MITK_TEST_CONDITION_REQUIRED(mitk::Equal(lastPlaneGeometry->GetOrigin(), expectedOriginOfLastSlice, slicedGeometryEps), "");
 
   mitkSlicedGeometry3D_ChangeImageGeometryConsideringOriginOffset_Test();
+  mitkSlicedGeometry3D_GeneratedPlaneGeometries_Test();
 
   std::cout << "[TEST DONE]" << std::endl;
   return EXIT_SUCCESS;
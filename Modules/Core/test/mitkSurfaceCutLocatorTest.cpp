@@ -0,0 +1,125 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkSurfaceCutLocator.h>
+
+#include <vtkCutter.h>
+#include <vtkPlane.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkSphereSource.h>
+
+class mitkSurfaceCutLocatorTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkSurfaceCutLocatorTestSuite);
+  MITK_TEST(ExtractCells_Plane_CutEqualsCutOfWholeSurface);
+  MITK_TEST(ExtractCells_PlaneOutsideSurface_ReturnsNoCells);
+  MITK_TEST(SetInput_SurfaceModified_RebuildsBuckets);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  vtkSmartPointer<vtkPolyData> m_Sphere;
+
+  static vtkSmartPointer<vtkPolyData> Cut(vtkPolyData *polyData, const double origin[3], const double normal[3])
+  {
+    vtkSmartPointer<vtkPlane> plane = vtkSmartPointer<vtkPlane>::New();
+    plane->SetOrigin(origin[0], origin[1], origin[2]);
+    plane->SetNormal(normal[0], normal[1], normal[2]);
+
+    vtkSmartPointer<vtkCutter> cutter = vtkSmartPointer<vtkCutter>::New();
+    cutter->SetCutFunction(plane);
+    cutter->SetInputData(polyData);
+    cutter->Update();
+    return cutter->GetOutput();
+  }
+
+public:
+  void setUp() override
+  {
+    vtkSmartPointer<vtkSphereSource> sphere = vtkSmartPointer<vtkSphereSource>::New();
+    sphere->SetRadius(10.0);
+    sphere->SetThetaResolution(64);
+    sphere->SetPhiResolution(64);
+    sphere->Update();
+    m_Sphere = sphere->GetOutput();
+  }
+
+  void tearDown() override { m_Sphere = nullptr; }
+
+  void ExtractCells_Plane_CutEqualsCutOfWholeSurface()
+  {
+    const double normal[3] = {0.3, -0.2, 1.0};
+    mitk::SurfaceCutLocator locator;
+    locator.SetInput(m_Sphere, normal);
+    CPPUNIT_ASSERT(locator.GetNumberOfBuckets() > 1);
+
+    for (double z = -9.5; z < 10.0; z += 1.5)
+    {
+      const double origin[3] = {0.0, 0.0, z};
+      vtkSmartPointer<vtkPolyData> cells = locator.ExtractCells(origin);
+      CPPUNIT_ASSERT(cells->GetNumberOfCells() > 0);
+      CPPUNIT_ASSERT(cells->GetNumberOfCells() < m_Sphere->GetNumberOfCells() / 4);
+      CPPUNIT_ASSERT(cells->GetPointData()->GetNormals() != nullptr);
+
+      vtkSmartPointer<vtkPolyData> expectedCut = Cut(m_Sphere, origin, normal);
+      vtkSmartPointer<vtkPolyData> cut = Cut(cells, origin, normal);
+      CPPUNIT_ASSERT_EQUAL(expectedCut->GetNumberOfPoints(), cut->GetNumberOfPoints());
+      CPPUNIT_ASSERT_EQUAL(expectedCut->GetNumberOfLines(), cut->GetNumberOfLines());
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(expectedCut->GetLength(), cut->GetLength(), 1e-9);
+    }
+  }
+
+  void ExtractCells_PlaneOutsideSurface_ReturnsNoCells()
+  {
+    const double normal[3] = {0.0, 0.0, 1.0};
+    mitk::SurfaceCutLocator locator;
+    locator.SetInput(m_Sphere, normal);
+
+    const double above[3] = {0.0, 0.0, 10.5};
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(0), locator.ExtractCells(above)->GetNumberOfCells());
+    const double below[3] = {0.0, 0.0, -10.5};
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(0), locator.ExtractCells(below)->GetNumberOfCells());
+  }
+
+  void SetInput_SurfaceModified_RebuildsBuckets()
+  {
+    const double normal[3] = {0.0, 0.0, 1.0};
+    mitk::SurfaceCutLocator locator;
+    locator.SetInput(m_Sphere, normal);
+
+    const double origin[3] = {0.0, 0.0, 15.0};
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(0), locator.ExtractCells(origin)->GetNumberOfCells());
+
+    // move the sphere up to the plane
+    vtkPoints *points = m_Sphere->GetPoints();
+    for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+    {
+      double point[3];
+      points->GetPoint(i, point);
+      point[2] += 15.0;
+      points->SetPoint(i, point);
+    }
+    points->Modified();
+
+    locator.SetInput(m_Sphere, normal);
+    CPPUNIT_ASSERT(locator.ExtractCells(origin)->GetNumberOfCells() > 0);
+
+    locator.Initialize();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), locator.GetNumberOfBuckets());
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(0), locator.ExtractCells(origin)->GetNumberOfCells());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkSurfaceCutLocator)
@@ -28,6 +28,7 @@ class mitkTemporalJoinImagesFilterTestSuite : public mitk::TestFixture
   MITK_TEST(InvalidUsage);
   MITK_TEST(FuseDefault);
   MITK_TEST(FuseUseDefinedTimeBounds);
+  MITK_TEST(FuseStreaming);
 
   CPPUNIT_TEST_SUITE_END();
 
@@ -88,6 +89,13 @@ public:
     filter->SetMaxTimeBounds({ 3 });
 
     CPPUNIT_ASSERT_THROW(filter->Update(), mitk::Exception);
+
+    filter = mitk::TemporalJoinImagesFilter::New();
+
+    filter->SetInput(0, t0);
+    filter->SetFrameLoader([this](unsigned int) { return invalidGeometry; }, 2);
+
+    CPPUNIT_ASSERT_THROW(filter->Update(), mitk::Exception);
   }
 
   void FuseDefault()
@@ -183,6 +191,46 @@ public:
     CPPUNIT_ASSERT_EQUAL(2420., accessor.GetPixelByIndex(testIndex2));
   }
 
+  void FuseStreaming()
+  {
+    auto filter = mitk::TemporalJoinImagesFilter::New();
+
+    std::vector<unsigned int> loadedFrames;
+    filter->SetInput(0, t0);
+    filter->SetFrameLoader([this, &loadedFrames](unsigned int pos)
+    {
+      loadedFrames.push_back(pos);
+      return 1 == pos ? t1 : t2;
+    }, 3);
+
+    filter->Update();
+    auto output = filter->GetOutput();
+
+    CPPUNIT_ASSERT(loadedFrames == std::vector<unsigned int>({ 1, 2 }));
+    CPPUNIT_ASSERT(output->GetTimeSteps() == 3);
+    auto allProp = output->GetProperty("all");
+    CPPUNIT_ASSERT(allProp->GetValueAsString() == "all_0");
+    auto specialProp = output->GetProperty("special");
+    CPPUNIT_ASSERT(specialProp->GetValueAsString() == "special_1");
+    auto tsProp = dynamic_cast<const mitk::TemporoSpatialStringProperty*>(output->GetProperty("ts").GetPointer());
+    CPPUNIT_ASSERT(tsProp->GetValueByTimeStep(0) == "ts_0");
+    CPPUNIT_ASSERT(tsProp->GetValueByTimeStep(1) == "ts_1");
+    CPPUNIT_ASSERT(tsProp->GetValueByTimeStep(2) == "ts_2");
+
+    CPPUNIT_ASSERT(output->GetTimeGeometry()->GetMinimumTimePoint(2) == 2.);
+    CPPUNIT_ASSERT(output->GetTimeGeometry()->GetMaximumTimePoint(2) == 3.);
+
+    mitk::ImagePixelReadAccessor<mitk::ScalarType, 4> accessor(output);
+    itk::Index<4> testIndex;
+    testIndex.Fill(2);
+    testIndex[3] = 0;
+    CPPUNIT_ASSERT_EQUAL(28., accessor.GetPixelByIndex(testIndex));
+    testIndex[3] = 1;
+    CPPUNIT_ASSERT_EQUAL(180., accessor.GetPixelByIndex(testIndex));
+    testIndex[3] = 2;
+    CPPUNIT_ASSERT_EQUAL(2420., accessor.GetPixelByIndex(testIndex));
+  }
+
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkTemporalJoinImagesFilter)
@@ -0,0 +1,159 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+// std includes
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+// MITK includes
+#include <mitkThreadPool.h>
+
+class mitkThreadPoolTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkThreadPoolTestSuite);
+
+  MITK_TEST(Submit_AllTasksRun);
+  MITK_TEST(Submit_CanceledTaskIsSkipped);
+  MITK_TEST(Submit_ExceptionIsPropagated);
+  MITK_TEST(Priority_InteractiveBeforeBackground);
+  MITK_TEST(ParallelFor_CoversRange);
+  MITK_TEST(ParallelFor_ExceptionIsPropagated);
+  MITK_TEST(NestedParallelism_NoDeadlock);
+
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void Submit_AllTasksRun()
+  {
+    mitk::ThreadPool pool(4);
+    std::atomic<int> counter(0);
+    std::vector<std::future<void>> futures;
+
+    for (int i = 0; i < 100; ++i)
+      futures.push_back(pool.Submit([&counter]() { ++counter; }));
+
+    for (const auto &future : futures)
+      pool.Wait(future);
+
+    CPPUNIT_ASSERT_EQUAL(100, counter.load());
+    CPPUNIT_ASSERT(!pool.IsWorkerThread());
+    CPPUNIT_ASSERT_EQUAL(4u, pool.GetNumberOfThreads());
+  }
+
+  void Submit_CanceledTaskIsSkipped()
+  {
+    mitk::ThreadPool pool(1);
+    mitk::ThreadPool::CancellationToken token;
+    token.Cancel();
+
+    bool taskRan = false;
+    auto future = pool.Submit([&taskRan]() { taskRan = true; }, mitk::ThreadPool::Priority::Background, token);
+
+    future.get();
+    CPPUNIT_ASSERT(!taskRan);
+  }
+
+  void Submit_ExceptionIsPropagated()
+  {
+    mitk::ThreadPool pool(1);
+    auto future = pool.Submit([]() { throw std::runtime_error("Task failed"); });
+
+    CPPUNIT_ASSERT_THROW(future.get(), std::runtime_error);
+  }
+
+  void Priority_InteractiveBeforeBackground()
+  {
+    mitk::ThreadPool pool(1);
+
+    // Keep the only worker busy until all tasks are queued
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    auto blocker = pool.Submit([released]() { released.wait(); });
+
+    std::mutex mutex;
+    std::vector<int> order;
+
+    auto background = pool.Submit([&]() { std::lock_guard<std::mutex> lock(mutex); order.push_back(2); }, mitk::ThreadPool::Priority::Background);
+    auto visible = pool.Submit([&]() { std::lock_guard<std::mutex> lock(mutex); order.push_back(1); }, mitk::ThreadPool::Priority::Visible);
+    auto interactive = pool.Submit([&]() { std::lock_guard<std::mutex> lock(mutex); order.push_back(0); }, mitk::ThreadPool::Priority::Interactive);
+
+    release.set_value();
+    background.get();
+    visible.get();
+    interactive.get();
+    blocker.get();
+
+    CPPUNIT_ASSERT(std::vector<int>({ 0, 1, 2 }) == order);
+  }
+
+  void ParallelFor_CoversRange()
+  {
+    mitk::ThreadPool pool(4);
+    std::vector<std::atomic<int>> visits(1000);
+
+    for (auto &visit : visits)
+      visit = 0;
+
+    pool.ParallelFor(0, visits.size(), [&visits](std::size_t begin, std::size_t end) {
+      for (auto i = begin; i < end; ++i)
+        ++visits[i];
+    });
+
+    for (const auto &visit : visits)
+      CPPUNIT_ASSERT_EQUAL(1, visit.load());
+  }
+
+  void ParallelFor_ExceptionIsPropagated()
+  {
+    mitk::ThreadPool pool(4);
+
+    CPPUNIT_ASSERT_THROW(pool.ParallelFor(0, 1000, [](std::size_t begin, std::size_t) {
+      if (begin > 500)
+        throw std::runtime_error("Sub-range failed");
+    }), std::runtime_error);
+  }
+
+  void NestedParallelism_NoDeadlock()
+  {
+    mitk::ThreadPool pool(2);
+    std::atomic<long> sum(0);
+    std::vector<std::future<void>> futures;
+
+    for (int i = 0; i < 20; ++i)
+    {
+      futures.push_back(pool.Submit([&pool, &sum]() {
+        CPPUNIT_ASSERT(pool.IsWorkerThread());
+        CPPUNIT_ASSERT(pool.GetRecommendedNumberOfThreads() <= pool.GetNumberOfThreads());
+
+        pool.ParallelFor(0, 100, [&sum](std::size_t begin, std::size_t end) {
+          for (auto i = begin; i < end; ++i)
+            sum += static_cast<long>(i);
+        });
+
+        auto nested = pool.Submit([&sum]() { ++sum; });
+        pool.Wait(nested);
+      }));
+    }
+
+    for (auto &future : futures)
+      future.get();
+
+    CPPUNIT_ASSERT_EQUAL(20L * (4950L + 1L), sum.load());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkThreadPool)
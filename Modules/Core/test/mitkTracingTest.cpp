@@ -0,0 +1,102 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+// std includes
+#include <sstream>
+#include <thread>
+
+// MITK includes
+#include <mitkTracing.h>
+
+class mitkTracingTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkTracingTestSuite);
+
+  MITK_TEST(Scope_Disabled_RecordsNothing);
+  MITK_TEST(Scope_Enabled_RecordsEventsOfAllThreads);
+  MITK_TEST(MaximumNumberOfEvents_KeepsLatestEvents);
+  MITK_TEST(WriteChromeTrace_WritesEventsAndCounters);
+
+  CPPUNIT_TEST_SUITE_END();
+
+  static void TracedCall()
+  {
+    MITK_TRACE_SCOPE_ARGS("Test", "TracedCall", "\"size\": 3");
+    MITK_TRACE_COUNT("Test", "Traced calls", 1);
+  }
+
+public:
+  void setUp() override { mitk::Tracing::SetEnabled(false); }
+
+  void tearDown() override
+  {
+    mitk::Tracing::SetEnabled(false);
+    mitk::Tracing::SetMaximumNumberOfEvents(65536);
+  }
+
+  void Scope_Disabled_RecordsNothing()
+  {
+    mitk::Tracing::Clear();
+    TracedCall();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), mitk::Tracing::GetNumberOfEvents());
+  }
+
+  void Scope_Enabled_RecordsEventsOfAllThreads()
+  {
+    mitk::Tracing::SetEnabled(true);
+    TracedCall();
+    std::thread thread([]() {
+      TracedCall();
+      TracedCall();
+    });
+    thread.join();
+
+#ifdef MITK_ENABLE_TRACING
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), mitk::Tracing::GetNumberOfEvents());
+#endif
+  }
+
+  void MaximumNumberOfEvents_KeepsLatestEvents()
+  {
+    mitk::Tracing::SetMaximumNumberOfEvents(2);
+    mitk::Tracing::SetEnabled(true);
+    for (int i = 0; i < 5; ++i)
+      mitk::Tracing::AddInstantEvent("Test", "Instant");
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), mitk::Tracing::GetNumberOfEvents());
+  }
+
+  void WriteChromeTrace_WritesEventsAndCounters()
+  {
+    mitk::Tracing::SetEnabled(true);
+    TracedCall();
+    mitk::Tracing::AddCounterSample("Test", "Cache size", 42);
+
+    std::ostringstream stream;
+    mitk::Tracing::WriteChromeTrace(stream);
+    const std::string trace = stream.str();
+
+    CPPUNIT_ASSERT(trace.find("\"traceEvents\"") != std::string::npos);
+    CPPUNIT_ASSERT(trace.find("\"name\": \"Cache size\", \"cat\": \"Test\", \"ph\": \"C\"") != std::string::npos);
+#ifdef MITK_ENABLE_TRACING
+    CPPUNIT_ASSERT(trace.find("\"name\": \"TracedCall\", \"cat\": \"Test\", \"ph\": \"X\"") != std::string::npos);
+    CPPUNIT_ASSERT(trace.find("\"size\": 3") != std::string::npos);
+    CPPUNIT_ASSERT(trace.find("\"name\": \"Traced calls\"") != std::string::npos);
+#endif
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkTracing)
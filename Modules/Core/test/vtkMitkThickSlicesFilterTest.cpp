@@ -20,6 +20,9 @@ found in the LICENSE file.
 #include <vtkDataArray.h>
 #include <vtkImageData.h>
 #include <vtkPointData.h>
+#include <vtkSmartPointer.h>
+
+#include <algorithm>
 
 class vtkMitkThickSlicesFilterTestHelper
 {
@@ -56,6 +59,50 @@ public:
     MITK_INFO << "actual value: " << static_cast<double>(value[0]);
     MITK_TEST_CONDITION_REQUIRED(value[0] == expectedValue, "Resulting image has correct pixel-value");
   }
+
+  /** A thick slab with varying pixel values, projected by the filter and by a plain loop over every pixel */
+  static void EvaluateLargeSlab(vtkMitkThickSlicesFilter *filter, int mode, const char *projection)
+  {
+    const int dimX = 37, dimY = 23, dimZ = 101;
+    vtkSmartPointer<vtkImageData> slab = vtkSmartPointer<vtkImageData>::New();
+    slab->SetDimensions(dimX, dimY, dimZ);
+    slab->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+    auto *data = static_cast<unsigned char *>(slab->GetScalarPointer());
+    for (int z = 0; z < dimZ; ++z)
+      for (int y = 0; y < dimY; ++y)
+        for (int x = 0; x < dimX; ++x)
+          data[(z * dimY + y) * dimX + x] = static_cast<unsigned char>((x * 7 + y * 13 + z * z) % 251);
+
+    filter->SetInputData(slab);
+    filter->SetThickSliceMode(mode);
+    filter->Modified();
+    filter->Update();
+    vtkImageData *output = filter->GetOutput();
+    MITK_TEST_CONDITION_REQUIRED(output->GetDimensions()[0] == dimX && output->GetDimensions()[1] == dimY,
+                                 "Resulting image of large slab has correct size");
+
+    bool equal = true;
+    for (int y = 0; y < dimY; ++y)
+    {
+      for (int x = 0; x < dimX; ++x)
+      {
+        double min = 255, max = 0, sum = 0;
+        for (int z = 0; z < dimZ; ++z)
+        {
+          const double value = data[(z * dimY + y) * dimX + x];
+          min = std::min(min, value);
+          max = std::max(max, value);
+          sum += value;
+        }
+        const double expected = mode == vtkMitkThickSlicesFilter::MIP ? max
+                                : mode == vtkMitkThickSlicesFilter::MINIP ? min
+                                : static_cast<unsigned char>(1.0 / dimZ * sum);
+        equal = equal && expected == *static_cast<unsigned char *>(output->GetScalarPointer(x, y, 0));
+      }
+    }
+    MITK_INFO << "Evaluating projection mode of large slab: " << projection;
+    MITK_TEST_CONDITION_REQUIRED(equal, "Resulting image of large slab has correct pixel-values");
+  }
 };
 
 /**
@@ -149,6 +196,10 @@ int vtkMitkThickSlicesFilterTest(int, char *[])
   thickSliceFilter->Update();
   vtkMitkThickSlicesFilterTestHelper::EvaluateResult(6, thickSliceFilter->GetOutput(), "Mean");
 
+  vtkMitkThickSlicesFilterTestHelper::EvaluateLargeSlab(thickSliceFilter, vtkMitkThickSlicesFilter::MIP, "MaxIP");
+  vtkMitkThickSlicesFilterTestHelper::EvaluateLargeSlab(thickSliceFilter, vtkMitkThickSlicesFilter::SUM, "Sum");
+  vtkMitkThickSlicesFilterTestHelper::EvaluateLargeSlab(thickSliceFilter, vtkMitkThickSlicesFilter::MINIP, "MinIP");
+
   thickSliceFilter->Delete();
 
   MITK_TEST_END()
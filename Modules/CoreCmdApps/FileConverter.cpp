@@ -14,11 +14,392 @@ found in the LICENSE file.
 
 #include "mitkCommandLineParser.h"
 #include "mitkIOUtil.h"
+#include "mitkThreadPool.h"
 
+#include <itkImageFileReader.h>
+#include <itkImageFileWriter.h>
+#include <itkImageIOFactory.h>
+#include <itksys/Directory.hxx>
 #include <itksys/SystemTools.hxx>
 
 #include "mitkPreferenceListReaderOptionsFunctor.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <condition_variable>
+#include <fstream>
+#include <future>
+#include <limits>
+#include <mutex>
+#include <set>
+#include <thread>
+
+namespace
+{
+  const std::uint64_t MegaByte = 1024 * 1024;
+
+  struct ConversionOptions
+  {
+    mitk::PreferenceListReaderOptionsFunctor::ListType ReaderPreference;
+    /** Images larger than this are streamed if the formats of the input and output support it */
+    std::uint64_t StreamingThreshold;
+    /** Size of the pieces of streamed images */
+    std::uint64_t SlabSize;
+  };
+
+  /**
+   * Limits the memory which the conversions running at the same time are estimated to need. A conversion
+   * needing more than the whole budget waits until it runs alone.
+   */
+  class MemoryBudget
+  {
+  public:
+    explicit MemoryBudget(std::uint64_t size) : m_Size(size), m_Available(size) {}
+
+    std::uint64_t Acquire(std::uint64_t size)
+    {
+      size = std::min(size, m_Size);
+
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_Released.wait(lock, [this, size] { return m_Available >= size; });
+      m_Available -= size;
+      return size;
+    }
+
+    void Release(std::uint64_t size)
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Available += size;
+      }
+      m_Released.notify_all();
+    }
+
+  private:
+    const std::uint64_t m_Size;
+    std::uint64_t m_Available;
+    std::mutex m_Mutex;
+    std::condition_variable m_Released;
+  };
+
+  struct ImageInformation
+  {
+    /** Size of the pixel data, 0 if the input cannot be read by ITK */
+    std::uint64_t SizeInBytes = 0;
+    bool CanStream = false;
+    itk::ImageIOBase::IOComponentType ComponentType = itk::ImageIOBase::UNKNOWNCOMPONENTTYPE;
+    unsigned int Dimension = 0;
+  };
+
+  /** Reads only the header of the input and checks whether it can be streamed to the format of the output. */
+  ImageInformation InspectImage(const std::string &inputFilename, const std::string &outputFilename)
+  {
+    ImageInformation information;
+    try
+    {
+      auto readIO = itk::ImageIOFactory::CreateImageIO(inputFilename.c_str(), itk::ImageIOFactory::ReadMode);
+      if (readIO.IsNull())
+        return information;
+
+      readIO->SetFileName(inputFilename);
+      readIO->ReadImageInformation();
+      information.SizeInBytes = readIO->GetImageSizeInBytes();
+      information.ComponentType = readIO->GetComponentType();
+      information.Dimension = readIO->GetNumberOfDimensions();
+
+      auto writeIO = itk::ImageIOFactory::CreateImageIO(outputFilename.c_str(), itk::ImageIOFactory::WriteMode);
+      if (writeIO.IsNull())
+        return information;
+
+      writeIO->SetFileName(outputFilename);
+
+      // multi-component images are converted by MITK to keep their pixel type, e.g. RGB
+      information.CanStream = readIO->CanStreamRead() && writeIO->CanStreamWrite() &&
+                              readIO->GetNumberOfComponents() == 1 && information.Dimension >= 2 &&
+                              information.Dimension <= 4;
+    }
+    catch (const itk::ExceptionObject &)
+    {
+      // not an image ITK can read, e.g. a surface
+    }
+    return information;
+  }
+
+  template <typename TImage>
+  void StreamImage(const std::string &inputFilename, const std::string &outputFilename, unsigned int numberOfSlabs)
+  {
+    auto reader = itk::ImageFileReader<TImage>::New();
+    reader->SetFileName(inputFilename);
+
+    auto writer = itk::ImageFileWriter<TImage>::New();
+    writer->SetInput(reader->GetOutput());
+    writer->SetFileName(outputFilename);
+    writer->SetNumberOfStreamDivisions(numberOfSlabs);
+    writer->Update();
+  }
+
+  template <typename TComponent>
+  void StreamImage(const ImageInformation &information,
+                   const std::string &inputFilename,
+                   const std::string &outputFilename,
+                   unsigned int numberOfSlabs)
+  {
+    switch (information.Dimension)
+    {
+      case 2:
+        StreamImage<itk::Image<TComponent, 2>>(inputFilename, outputFilename, numberOfSlabs);
+        break;
+      case 3:
+        StreamImage<itk::Image<TComponent, 3>>(inputFilename, outputFilename, numberOfSlabs);
+        break;
+      case 4:
+        StreamImage<itk::Image<TComponent, 4>>(inputFilename, outputFilename, numberOfSlabs);
+        break;
+      default:
+        mitkThrow() << "Cannot stream images of dimension " << information.Dimension;
+    }
+  }
+
+  /** Converts the image piece by piece with ITK, so it never resides in memory as a whole. */
+  void StreamImage(const ImageInformation &information,
+                   const std::string &inputFilename,
+                   const std::string &outputFilename,
+                   unsigned int numberOfSlabs)
+  {
+    switch (information.ComponentType)
+    {
+      case itk::ImageIOBase::UCHAR:
+        StreamImage<unsigned char>(information, inputFilename, outputFilename, numberOfSlabs);
+        break;
+      case itk::ImageIOBase::CHAR:
+        StreamImage<char>(information, inputFilename, outputFilename, numberOfSlabs);
+        break;
+      case itk::ImageIOBase::USHORT:
+        StreamImage<unsigned short>(information, inputFilename, outputFilename, numberOfSlabs);
+        break;
+      case itk::ImageIOBase::SHORT:
+        StreamImage<short>(information, inputFilename, outputFilename, numberOfSlabs);
+        break;
+      case itk::ImageIOBase::UINT:
+        StreamImage<unsigned int>(information, inputFilename, outputFilename, numberOfSlabs);
+        break;
+      case itk::ImageIOBase::INT:
+        StreamImage<int>(information, inputFilename, outputFilename, numberOfSlabs);
+        break;
+      case itk::ImageIOBase::FLOAT:
+        StreamImage<float>(information, inputFilename, outputFilename, numberOfSlabs);
+        break;
+      case itk::ImageIOBase::DOUBLE:
+        StreamImage<double>(information, inputFilename, outputFilename, numberOfSlabs);
+        break;
+      default:
+        mitkThrow() << "Cannot stream images with pixels of type "
+                    << itk::ImageIOBase::GetComponentTypeAsString(information.ComponentType);
+    }
+  }
+
+  /**
+   * Converts one file and returns the number of bytes read. Images larger than the streaming threshold are
+   * streamed if possible, everything else is loaded and saved by MITK. Further data of the input is saved
+   * to numbered files next to the output.
+   */
+  std::uint64_t ConvertFile(const std::string &inputFilename,
+                            const std::string &outputFilename,
+                            const ConversionOptions &options,
+                            MemoryBudget &budget)
+  {
+    const auto information = InspectImage(inputFilename, outputFilename);
+
+    if (options.ReaderPreference.empty() && information.CanStream &&
+        information.SizeInBytes > options.StreamingThreshold)
+    {
+      const auto slabSize = std::max<std::uint64_t>(1, options.SlabSize);
+      const auto numberOfSlabs = static_cast<unsigned int>((information.SizeInBytes + slabSize - 1) / slabSize);
+
+      const auto reserved = budget.Acquire(slabSize);
+      try
+      {
+        StreamImage(information, inputFilename, outputFilename, numberOfSlabs);
+      }
+      catch (...)
+      {
+        budget.Release(reserved);
+        throw;
+      }
+      budget.Release(reserved);
+      return information.SizeInBytes;
+    }
+
+    // compressed files which ITK cannot inspect need more memory than their size, so this is only a lower bound
+    const std::uint64_t size =
+      information.SizeInBytes > 0 ? information.SizeInBytes : itksys::SystemTools::FileLength(inputFilename);
+
+    const auto reserved = budget.Acquire(size);
+    try
+    {
+      mitk::PreferenceListReaderOptionsFunctor::ListType emptyList = {};
+      mitk::PreferenceListReaderOptionsFunctor functor =
+        mitk::PreferenceListReaderOptionsFunctor(options.ReaderPreference, emptyList);
+
+      std::string extension = itksys::SystemTools::GetFilenameExtension(outputFilename);
+      std::string filename = itksys::SystemTools::GetFilenameWithoutExtension(outputFilename);
+      std::string path = itksys::SystemTools::GetFilenamePath(outputFilename);
+
+      auto nodes = mitk::IOUtil::Load(inputFilename, &functor);
+
+      unsigned count = 0;
+      for (auto node : nodes)
+      {
+        std::string writeName = path + "/" + filename + extension;
+        if (count > 0)
+        {
+          writeName = path + "/" + filename + "_" + std::to_string(count) + extension;
+        }
+        mitk::IOUtil::Save(node, writeName);
+        ++count;
+      }
+    }
+    catch (...)
+    {
+      budget.Release(reserved);
+      throw;
+    }
+    budget.Release(reserved);
+    return size;
+  }
+
+  /** The files of a directory or the lines of a list file, empty lines and lines starting with '#' are skipped. */
+  std::vector<std::string> GetBatchInputs(const std::string &input, bool isList)
+  {
+    std::vector<std::string> inputs;
+    if (isList)
+    {
+      std::ifstream list(input);
+      if (!list)
+        mitkThrow() << "Cannot open the input list " << input;
+
+      std::string line;
+      while (std::getline(list, line))
+      {
+        line = itksys::SystemTools::TrimWhitespace(line);
+        if (!line.empty() && line[0] != '#')
+          inputs.push_back(line);
+      }
+      return inputs;
+    }
+
+    itksys::Directory directory;
+    if (!directory.Load(input))
+      mitkThrow() << "Cannot read the input directory " << input;
+
+    for (unsigned long i = 0; i < directory.GetNumberOfFiles(); ++i)
+    {
+      const std::string name = directory.GetFile(i);
+      const std::string path = input + "/" + name;
+      if (name[0] != '.' && !itksys::SystemTools::FileIsDirectory(path))
+        inputs.push_back(path);
+    }
+    std::sort(inputs.begin(), inputs.end());
+    return inputs;
+  }
+
+  /** The name of the input without its extension, which includes a compression suffix like in "image.nii.gz" */
+  std::string GetNameWithoutExtension(const std::string &filename)
+  {
+    std::string name = itksys::SystemTools::GetFilenameWithoutLastExtension(filename);
+    const std::string extension = itksys::SystemTools::GetFilenameLastExtension(filename);
+    if (extension == ".gz" || extension == ".bz2" || extension == ".zip")
+      name = itksys::SystemTools::GetFilenameWithoutLastExtension(name);
+
+    return name;
+  }
+
+  int ConvertBatch(const std::vector<std::string> &inputs,
+                   const std::string &outputDirectory,
+                   const std::string &extension,
+                   unsigned int numberOfThreads,
+                   std::uint64_t memoryBudget,
+                   const ConversionOptions &options)
+  {
+    if (!itksys::SystemTools::MakeDirectory(outputDirectory))
+    {
+      MITK_ERROR << "Cannot create the output directory " << outputDirectory;
+      return EXIT_FAILURE;
+    }
+
+    std::vector<std::string> outputs;
+    std::set<std::string> usedOutputs;
+    unsigned int numberOfFailures = 0;
+    for (const auto &input : inputs)
+    {
+      std::string output = outputDirectory + "/" + GetNameWithoutExtension(input) + extension;
+      if (!usedOutputs.insert(output).second)
+      {
+        MITK_ERROR << "Skipping " << input << ": another input is converted to " << output;
+        output.clear();
+        ++numberOfFailures;
+      }
+      outputs.push_back(output);
+    }
+
+    mitk::ThreadPool threadPool(numberOfThreads);
+    MemoryBudget budget(memoryBudget);
+
+    std::mutex reportMutex;
+    std::atomic<std::uint64_t> numberOfBytes(0);
+    std::atomic<unsigned int> numberOfConvertedFiles(0);
+
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::future<void>> conversions;
+    for (std::size_t i = 0; i < inputs.size(); ++i)
+    {
+      if (outputs[i].empty())
+        continue;
+
+      conversions.push_back(threadPool.Submit([&, i]() {
+        const auto fileStart = std::chrono::steady_clock::now();
+        const auto size = ConvertFile(inputs[i], outputs[i], options, budget);
+        const std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - fileStart;
+
+        numberOfBytes += size;
+        const auto numberOfFiles = ++numberOfConvertedFiles;
+
+        std::lock_guard<std::mutex> lock(reportMutex);
+        std::cout << "[" << numberOfFiles << "/" << inputs.size() << "] " << inputs[i] << " -> " << outputs[i]
+                  << " (" << size / MegaByte << " MB, " << seconds.count() << " s)" << std::endl;
+      }));
+    }
+
+    for (std::size_t i = 0, conversion = 0; i < inputs.size(); ++i)
+    {
+      if (outputs[i].empty())
+        continue;
+
+      try
+      {
+        conversions[conversion++].get();
+      }
+      catch (const std::exception &e)
+      {
+        MITK_ERROR << "Cannot convert " << inputs[i] << ": " << e.what();
+        ++numberOfFailures;
+      }
+    }
+
+    const std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+    const double megaBytes = static_cast<double>(numberOfBytes.load()) / MegaByte;
+    const unsigned int numberOfFiles = numberOfConvertedFiles.load();
+    std::cout << "Converted " << numberOfFiles << " of " << inputs.size() << " files (" << megaBytes << " MB) in "
+              << seconds.count() << " s: " << numberOfFiles / seconds.count() << " files/s, "
+              << megaBytes / seconds.count() << " MB/s" << std::endl;
+
+    return numberOfFailures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+}
+
 
 int main(int argc, char* argv[])
 {
@@ -26,16 +407,24 @@ int main(int argc, char* argv[])
 
   parser.setTitle("File Converter");
   parser.setCategory("Basic Image Processing");
-  parser.setDescription("");
+  parser.setDescription("Converts a file, or in batch mode all files of a directory or list, to the format of the output. "
+                        "Images larger than the streaming threshold are converted piece by piece if both formats "
+                        "support streaming.");
   parser.setContributor("German Cancer Research Center (DKFZ)");
 
   parser.setArgumentPrefix("--","-");
   // Add command line argument names
   parser.addArgument("help", "h",mitkCommandLineParser::Bool, "Help:", "Show this help text");
-  parser.addArgument("input", "i", mitkCommandLineParser::File, "Input file:", "Input File",us::Any(),false, false, false, mitkCommandLineParser::Input);
-  parser.addArgument("output", "o", mitkCommandLineParser::File, "Output file:", "Output file", us::Any(), false, false, false, mitkCommandLineParser::Output);
+  parser.addArgument("input", "i", mitkCommandLineParser::File, "Input file:", "Input file, or input directory in batch mode",us::Any(),false, false, false, mitkCommandLineParser::Input);
+  parser.addArgument("output", "o", mitkCommandLineParser::File, "Output file:", "Output file, or output directory in batch mode", us::Any(), false, false, false, mitkCommandLineParser::Output);
   parser.addArgument("reader", "r", mitkCommandLineParser::String, "Reader Name", "Reader Name", us::Any());
   parser.addArgument("list-readers", "lr", mitkCommandLineParser::Bool, "Reader Name", "Reader Name", us::Any());
+  parser.addArgument("list", "l", mitkCommandLineParser::Bool, "Input list:", "The input is a text file listing one input file per line (batch mode)");
+  parser.addArgument("extension", "e", mitkCommandLineParser::String, "Output extension:", "Extension of the output files in batch mode, e.g. .nii.gz");
+  parser.addArgument("threads", "t", mitkCommandLineParser::Int, "Threads:", "Number of files that are converted in parallel in batch mode (default: number of cores)");
+  parser.addArgument("memory", "m", mitkCommandLineParser::Int, "Memory budget:", "Megabytes of image data that the parallel conversions may hold at the same time (default: 4096)");
+  parser.addArgument("streaming-threshold", "st", mitkCommandLineParser::Int, "Streaming threshold:", "Images with more megabytes are streamed if both formats support it (default: 1024)");
+  parser.addArgument("slab-size", "ss", mitkCommandLineParser::Int, "Slab size:", "Megabytes of the pieces of streamed images (default: 64)");
 
 
   std::map<std::string, us::Any> parsedArgs = parser.parseArguments(argc, argv);
@@ -87,26 +476,52 @@ int main(int argc, char* argv[])
     return 0;
   }
 
-  mitk::PreferenceListReaderOptionsFunctor::ListType emptyList = {};
-  mitk::PreferenceListReaderOptionsFunctor functor = mitk::PreferenceListReaderOptionsFunctor(preference, emptyList);
-
-  std::string extension = itksys::SystemTools::GetFilenameExtension(outputFilename);
-  std::string filename = itksys::SystemTools::GetFilenameWithoutExtension(outputFilename);
-  std::string path = itksys::SystemTools::GetFilenamePath(outputFilename);
+  auto getMegaBytes = [&parsedArgs](const std::string &name, int defaultValue) {
+    const int value = parsedArgs.count(name) ? us::any_cast<int>(parsedArgs[name]) : defaultValue;
+    return static_cast<std::uint64_t>(std::max(1, value)) * MegaByte;
+  };
 
-  auto nodes = mitk::IOUtil::Load(inputFilename, &functor);
+  ConversionOptions options;
+  options.ReaderPreference = preference;
+  options.StreamingThreshold = getMegaBytes("streaming-threshold", 1024);
+  options.SlabSize = getMegaBytes("slab-size", 64);
 
-  unsigned count = 0;
-  for (auto node : nodes)
+  const bool isList = parsedArgs.count("list") && us::any_cast<bool>(parsedArgs["list"]);
+  if (isList || itksys::SystemTools::FileIsDirectory(inputFilename))
   {
-    std::string writeName = path + "/" + filename + extension;
-    if (count > 0)
+    if (parsedArgs.count("extension") == 0)
+    {
+      MITK_ERROR << "The batch mode needs the extension of the output files, e.g. --extension .nrrd";
+      return EXIT_FAILURE;
+    }
+    std::string extension = us::any_cast<std::string>(parsedArgs["extension"]);
+    if (!extension.empty() && extension[0] != '.')
+      extension = "." + extension;
+
+    unsigned int numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+    if (parsedArgs.count("threads"))
     {
-      writeName = path + "/" + filename + "_" + std::to_string(count) + extension;
+      numberOfThreads = static_cast<unsigned int>(std::max(1, us::any_cast<int>(parsedArgs["threads"])));
+    }
+
+    try
+    {
+      return ConvertBatch(GetBatchInputs(inputFilename, isList),
+                          outputFilename,
+                          extension,
+                          numberOfThreads,
+                          getMegaBytes("memory", 4096),
+                          options);
+    }
+    catch (const std::exception &e)
+    {
+      MITK_ERROR << e.what();
+      return EXIT_FAILURE;
     }
-    mitk::IOUtil::Save(node, writeName);
-    ++count;
   }
 
+  MemoryBudget budget(std::numeric_limits<std::uint64_t>::max());
+  ConvertFile(inputFilename, outputFilename, options, budget);
+
   return EXIT_SUCCESS;
 }
@@ -152,6 +152,41 @@ public:
    */
   static const std::string& PROP_AUTOLOADED_MODULES();
 
+  /**
+   * Returns the property key with a value of \c module.activation_policy for
+   * looking up this module's activation policy.
+   * The property value is of type \c std::string. If it is \c lazy, the call of
+   * the module activator's ModuleActivator::Load method is deferred until
+   * services are looked up for the first time or ModuleRegistry::ActivateDeferredModules()
+   * is called. Only modules whose activators just register services should use it.
+   *
+   * @return The activation policy property key.
+   *
+   * \sa ModuleSettings::IsLazyActivationEnabled()
+   */
+  static const std::string& PROP_ACTIVATION_POLICY();
+
+  /**
+   * Returns the property key with a value of \c module.activation_dependencies for
+   * looking up the names of modules whose activators have to be called before the
+   * activator of this module when activations are deferred.
+   * The property value is a list of strings.
+   *
+   * @return The activation dependencies property key.
+   */
+  static const std::string& PROP_ACTIVATION_DEPENDENCIES();
+
+  /**
+   * Returns the property key with a value of \c module.activation_time for
+   * looking up the time it took to call the ModuleActivator::Load method of
+   * this module's activator.
+   * The property value is of type \c double and given in milliseconds. It is
+   * not set before the activator has been called.
+   *
+   * @return The activation time property key.
+   */
+  static const std::string& PROP_ACTIVATION_TIME();
+
   ~Module();
 
   /**
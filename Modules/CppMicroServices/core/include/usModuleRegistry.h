@@ -74,6 +74,20 @@ public:
    */
   static std::vector<Module*> GetLoadedModules();
 
+  /**
+   * Calls the activators of all modules whose activation has been deferred
+   * because of their lazy activation policy. Activators which do not
+   * depend on each other are called in parallel.
+   *
+   * Deferred activators are also called before services are looked up,
+   * calling this method early, e.g. right after the application has loaded
+   * its modules, just saves time. It must not be called during the static
+   * initialization of a shared library.
+   *
+   * @see Module::PROP_ACTIVATION_POLICY()
+   */
+  static void ActivateDeferredModules();
+
   static void Register(ModuleInfo* info);
 
   static void UnRegister(const ModuleInfo* info);
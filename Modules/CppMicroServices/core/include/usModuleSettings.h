@@ -41,6 +41,9 @@ US_BEGIN_NAMESPACE
  * - \e US_DISABLE_AUTOLOADING If set, auto-loading of modules is disabled.
  * - \e US_AUTOLOAD_PATHS A ':' (Unix) or ';' (Windows) separated list of paths
  *   from which modules should be auto-loaded.
+ * - \e US_DISABLE_LAZY_ACTIVATION If set, the activators of modules with a lazy
+ *   activation policy are called when the module is loaded.
+ * - \e US_ACTIVATION_TIMING If set, the time spent in each module activator is logged.
  *
  * \remarks This class is thread safe.
  */
@@ -118,6 +121,40 @@ public:
    */
   static void AddAutoLoadPath(const std::string& path);
 
+  /**
+   * \return \c true if the activators of modules with a lazy activation policy
+   * are called deferred, \c false otherwise.
+   *
+   * \remarks This method will always return \c false if lazy activation has been
+   * disabled by defining the US_DISABLE_LAZY_ACTIVATION environment variable.
+   *
+   * \sa Module::PROP_ACTIVATION_POLICY()
+   */
+  static bool IsLazyActivationEnabled();
+
+  /**
+   * Enable or disable lazy activation. Modules which have already been
+   * loaded are not affected.
+   *
+   * \param enable If \c true, enable lazy activation, disable it otherwise.
+   */
+  static void SetLazyActivationEnabled(bool enable);
+
+  /**
+   * \return \c true if the time spent in each module activator is logged,
+   * \c false otherwise.
+   *
+   * \sa Module::PROP_ACTIVATION_TIME()
+   */
+  static bool IsActivationTimingEnabled();
+
+  /**
+   * Enable or disable logging of the time spent in each module activator.
+   *
+   * \param enable If \c true, log activation times, disable it otherwise.
+   */
+  static void SetActivationTimingEnabled(bool enable);
+
   /**
    * Set a local storage path for persistend module data.
    *
@@ -27,6 +27,7 @@
 #include "usServiceRegistry_p.h"
 #include "usModuleHooks_p.h"
 #include "usServiceHooks_p.h"
+#include "usModuleActivationScheduler_p.h"
 
 US_BEGIN_NAMESPACE
 
@@ -57,6 +58,11 @@ public:
    */
   ModuleHooks moduleHooks;
 
+  /**
+   * Deferred module activators.
+   */
+  ModuleActivationScheduler activationScheduler;
+
   /**
    * Contruct a core context
    *
@@ -33,6 +33,27 @@
 
 US_BEGIN_NAMESPACE
 
+namespace {
+
+// Marks a running module activator for the scheduler of deferred activators.
+struct ModuleStartGuard
+{
+  ModuleStartGuard(ModuleActivationScheduler& scheduler)
+    : scheduler(scheduler)
+  {
+    scheduler.ModuleStarting();
+  }
+
+  ~ModuleStartGuard()
+  {
+    scheduler.ModuleStarted();
+  }
+
+  ModuleActivationScheduler& scheduler;
+};
+
+}
+
 const std::string& Module::PROP_ID()
 {
   static const std::string s("module.id");
@@ -78,6 +99,24 @@ const std::string&Module::PROP_AUTOLOADED_MODULES()
   return s;
 }
 
+const std::string&Module::PROP_ACTIVATION_POLICY()
+{
+  static const std::string s("module.activation_policy");
+  return s;
+}
+
+const std::string&Module::PROP_ACTIVATION_DEPENDENCIES()
+{
+  static const std::string s("module.activation_dependencies");
+  return s;
+}
+
+const std::string&Module::PROP_ACTIVATION_TIME()
+{
+  static const std::string s("module.activation_time");
+  return s;
+}
+
 Module::Module()
 : d(nullptr)
 {
@@ -135,8 +174,8 @@ void Module::Start()
   std::memcpy(&activatorHook, &activatorHookSym, sizeof(void*));
 
   d->coreCtx->listeners.ModuleChanged(ModuleEvent(ModuleEvent::LOADING, this));
-  // try to get a ModuleActivator instance
 
+  // try to get a ModuleActivator instance
   if (activatorHook)
   {
     try
@@ -148,12 +187,19 @@ void Module::Start()
       US_ERROR << "Creating the module activator of " << d->info.name << " failed";
       throw;
     }
+  }
+
+  // Only the call of Load() is deferred. The activator is created here so
+  // that it is destroyed after the module is unloaded.
+  const Any activationPolicy = d->moduleManifest.GetValue(PROP_ACTIVATION_POLICY());
+  const bool lazy = d->moduleActivator != nullptr && ModuleSettings::IsLazyActivationEnabled() &&
+      activationPolicy.Type() == typeid(std::string) &&
+      ref_any_cast<std::string>(activationPolicy) == "lazy";
 
-    // This method should be "noexcept" and by not catching exceptions
-    // here we semantically treat it that way since any exception during
-    // static initialization will either terminate the program or cause
-    // the dynamic loader to report an error.
-    d->moduleActivator->Load(d->moduleContext);
+  if (d->moduleActivator && !lazy)
+  {
+    ModuleStartGuard guard(d->coreCtx->activationScheduler);
+    d->LoadActivator();
   }
 
 #ifdef US_ENABLE_AUTOLOADING_SUPPORT
@@ -167,6 +213,13 @@ void Module::Start()
   }
 #endif
 
+  if (lazy)
+  {
+    // the LOADED event is sent after the activator has been called
+    d->coreCtx->activationScheduler.Defer(d);
+    return;
+  }
+
   d->coreCtx->listeners.ModuleChanged(ModuleEvent(ModuleEvent::LOADED, this));
 }
 
@@ -178,6 +231,8 @@ void Module::Stop()
     return;
   }
 
+  d->coreCtx->activationScheduler.Remove(d);
+
   try
   {
     d->coreCtx->listeners.ModuleChanged(ModuleEvent(ModuleEvent::UNLOADING, this));
@@ -0,0 +1,266 @@
+/*============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) German Cancer Research Center (DKFZ)
+  All rights reserved.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+============================================================================*/
+
+#include "usModuleActivationScheduler_p.h"
+
+#include "usModule.h"
+#include "usModuleEvent.h"
+#include "usModulePrivate.h"
+#include "usCoreModuleContext_p.h"
+#include "usLog_p.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+US_BEGIN_NAMESPACE
+
+ModuleActivationScheduler::ModuleActivationScheduler()
+{
+}
+
+void ModuleActivationScheduler::Defer(ModulePrivate* module)
+{
+  Activation activation;
+  activation.module = module;
+  activation.running = false;
+
+  Any dependencies = module->moduleManifest.GetValue(Module::PROP_ACTIVATION_DEPENDENCIES());
+  if (dependencies.Type() == typeid(std::vector<Any>))
+  {
+    const std::vector<Any>& list = ref_any_cast<std::vector<Any> >(dependencies);
+    for (std::vector<Any>::const_iterator i = list.begin(); i != list.end(); ++i)
+    {
+      if (i->Type() == typeid(std::string))
+      {
+        activation.dependencies.push_back(ref_any_cast<std::string>(*i));
+      }
+    }
+  }
+  else if (dependencies.Type() == typeid(std::string))
+  {
+    activation.dependencies.push_back(ref_any_cast<std::string>(dependencies));
+  }
+
+  Lock l(this);
+  US_UNUSED(l);
+  activations.push_back(activation);
+  activationCount.Ref();
+}
+
+void ModuleActivationScheduler::Remove(ModulePrivate* module)
+{
+  if (activationCount == 0) return;
+
+  Lock l(this);
+  US_UNUSED(l);
+  for (;;)
+  {
+    ActivationList::iterator i = activations.begin();
+    while (i != activations.end() && i->module != module) ++i;
+    if (i == activations.end())
+    {
+      return;
+    }
+    if (!i->running)
+    {
+      // Load() has not been called, so Unload() must not be called either
+      module->moduleActivator = nullptr;
+      activations.erase(i);
+      activationCount.Deref();
+      this->NotifyAll();
+      return;
+    }
+    if (IsActivatingThread_unlocked())
+    {
+      return;
+    }
+    this->Wait();
+  }
+}
+
+void ModuleActivationScheduler::ActivateAll(bool parallel)
+{
+  if (activationCount == 0) return;
+
+  {
+    Lock l(this);
+    US_UNUSED(l);
+    if (IsActivatingThread_unlocked())
+    {
+      return;
+    }
+  }
+
+#ifdef US_ENABLE_THREADING_SUPPORT
+  std::vector<std::thread> threads;
+  if (parallel && startingModules == 0)
+  {
+    const std::size_t pending = static_cast<int>(activationCount);
+    const std::size_t threadCount = std::min<std::size_t>(std::thread::hardware_concurrency(), pending);
+    try
+    {
+      for (std::size_t i = 1; i < threadCount; ++i)
+      {
+        threads.push_back(std::thread(&ModuleActivationScheduler::Run, this));
+      }
+    }
+    catch (const std::exception& e)
+    {
+      US_WARN << "Could not start a thread for calling module activators: " << e.what();
+    }
+  }
+#else
+  US_UNUSED(parallel);
+#endif
+
+  this->Run();
+
+#ifdef US_ENABLE_THREADING_SUPPORT
+  for (std::vector<std::thread>::iterator i = threads.begin(); i != threads.end(); ++i)
+  {
+    i->join();
+  }
+#endif
+}
+
+void ModuleActivationScheduler::ModuleStarting()
+{
+  startingModules.Ref();
+}
+
+void ModuleActivationScheduler::ModuleStarted()
+{
+  startingModules.Deref();
+}
+
+void ModuleActivationScheduler::Run()
+{
+  for (;;)
+  {
+    ActivationList::iterator activation;
+    {
+      Lock l(this);
+      US_UNUSED(l);
+      activation = NextActivation_unlocked();
+      if (activation == activations.end())
+      {
+        return;
+      }
+      activation->running = true;
+      activatingThreads.push_back(std::this_thread::get_id());
+    }
+
+    // the list element is not erased by other threads while it is running
+    Activate(*activation);
+
+    {
+      Lock l(this);
+      US_UNUSED(l);
+      activatingThreads.erase(std::find(activatingThreads.begin(), activatingThreads.end(),
+                                        std::this_thread::get_id()));
+      activations.erase(activation);
+      activationCount.Deref();
+      this->NotifyAll();
+    }
+  }
+}
+
+ModuleActivationScheduler::ActivationList::iterator ModuleActivationScheduler::NextActivation_unlocked()
+{
+  for (;;)
+  {
+    bool running = false;
+    for (ActivationList::iterator i = activations.begin(); i != activations.end(); ++i)
+    {
+      if (i->running)
+      {
+        running = true;
+      }
+      else if (IsReady_unlocked(*i))
+      {
+        return i;
+      }
+    }
+
+    if (activations.empty())
+    {
+      return activations.end();
+    }
+
+    if (!running)
+    {
+      // none of the remaining activations is ready, so their dependencies are cyclic
+      US_WARN << "Cyclic activation dependencies of module " << activations.front().module->info.name;
+      return activations.begin();
+    }
+
+#ifdef US_ENABLE_THREADING_SUPPORT
+    this->Wait();
+#else
+    return activations.end();
+#endif
+  }
+}
+
+bool ModuleActivationScheduler::IsReady_unlocked(const Activation& activation) const
+{
+  for (std::vector<std::string>::const_iterator dependency = activation.dependencies.begin();
+       dependency != activation.dependencies.end(); ++dependency)
+  {
+    for (ActivationList::const_iterator i = activations.begin(); i != activations.end(); ++i)
+    {
+      if (i->module != activation.module && i->module->info.name == *dependency)
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool ModuleActivationScheduler::IsActivatingThread_unlocked() const
+{
+  return std::find(activatingThreads.begin(), activatingThreads.end(),
+                   std::this_thread::get_id()) != activatingThreads.end();
+}
+
+void ModuleActivationScheduler::Activate(const Activation& activation)
+{
+  ModulePrivate* module = activation.module;
+  try
+  {
+    module->LoadActivator();
+  }
+  catch (const std::exception& e)
+  {
+    US_ERROR << "Calling the deferred activator of module " << module->info.name << " failed: " << e.what();
+    module->moduleActivator = nullptr;
+  }
+  catch (...)
+  {
+    US_ERROR << "Calling the deferred activator of module " << module->info.name << " failed";
+    module->moduleActivator = nullptr;
+  }
+
+  module->coreCtx->listeners.ModuleChanged(ModuleEvent(ModuleEvent::LOADED, module->q));
+}
+
+US_END_NAMESPACE
@@ -0,0 +1,130 @@
+/*============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) German Cancer Research Center (DKFZ)
+  All rights reserved.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+============================================================================*/
+
+#ifndef USMODULEACTIVATIONSCHEDULER_P_H
+#define USMODULEACTIVATIONSCHEDULER_P_H
+
+#include "usCoreConfig.h"
+#include "usAtomicInt_p.h"
+#include "usThreads_p.h"
+
+#include <list>
+#include <string>
+#include <thread>
+#include <vector>
+
+US_BEGIN_NAMESPACE
+
+class ModulePrivate;
+
+/**
+ * Calls the activators of modules with a lazy activation policy.
+ *
+ * The deferred activators are called when services are looked up or
+ * when ModuleRegistry::ActivateDeferredModules() is called. An activator
+ * is called after the activators of the modules listed in the
+ * Module::PROP_ACTIVATION_DEPENDENCIES() property of its module, other
+ * activators can be called in parallel.
+ *
+ * This class is not part of the public API.
+ */
+class ModuleActivationScheduler : public MultiThreaded<MutexLockingStrategy, WaitCondition>
+{
+
+public:
+
+  ModuleActivationScheduler();
+
+  /**
+   * Defers the call of the activator of a module which has been started.
+   */
+  void Defer(ModulePrivate* module);
+
+  /**
+   * Removes the deferred activator of a module which is stopped. If the
+   * activator is called by another thread, this method waits until it returns.
+   * If it has not been called, the module activator is reset.
+   */
+  void Remove(ModulePrivate* module);
+
+  /**
+   * Calls all deferred activators and returns after they have been called.
+   * Calls from within an activator return immediately.
+   *
+   * @param parallel If \c true, additional threads are used to call
+   *        independent activators. This is not done while a module is started.
+   */
+  void ActivateAll(bool parallel);
+
+  /**
+   * Marks the begin and end of Module::Start, which is usually called
+   * during the static initialization of a shared library.
+   */
+  void ModuleStarting();
+  void ModuleStarted();
+
+private:
+
+  struct Activation
+  {
+    ModulePrivate* module;
+    std::vector<std::string> dependencies;
+    bool running;
+  };
+
+  typedef std::list<Activation> ActivationList;
+
+  /**
+   * Deferred activations, including the ones being called.
+   */
+  ActivationList activations;
+
+  /**
+   * The threads which currently call an activator.
+   */
+  std::vector<std::thread::id> activatingThreads;
+
+  /**
+   * The size of activations, for checking it without locking.
+   */
+  AtomicInt activationCount;
+
+  AtomicInt startingModules;
+
+  void Run();
+
+  ActivationList::iterator NextActivation_unlocked();
+
+  bool IsReady_unlocked(const Activation& activation) const;
+
+  bool IsActivatingThread_unlocked() const;
+
+  static void Activate(const Activation& activation);
+
+  // purposely not implemented
+  ModuleActivationScheduler(const ModuleActivationScheduler&);
+  ModuleActivationScheduler& operator=(const ModuleActivationScheduler&);
+
+};
+
+US_END_NAMESPACE
+
+#endif // USMODULEACTIVATIONSCHEDULER_P_H
@@ -86,6 +86,7 @@ std::vector<ServiceReferenceU > ModuleContext::GetServiceReferences(const std::s
 {
   std::vector<ServiceReferenceU> result;
   std::vector<ServiceReferenceBase> refs;
+  d->module->coreCtx->activationScheduler.ActivateAll(false);
   d->module->coreCtx->services.Get(clazz, filter, d->module, refs);
   for (std::vector<ServiceReferenceBase>::const_iterator iter = refs.begin();
        iter != refs.end(); ++iter)
@@ -97,6 +98,7 @@ std::vector<ServiceReferenceU > ModuleContext::GetServiceReferences(const std::s
 
 ServiceReferenceU ModuleContext::GetServiceReference(const std::string& clazz)
 {
+  d->module->coreCtx->activationScheduler.ActivateAll(false);
   return d->module->coreCtx->services.Get(d->module, clazz);
 }
 
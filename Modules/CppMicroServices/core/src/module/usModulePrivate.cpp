@@ -35,6 +35,7 @@
 #include <algorithm>
 #include <iterator>
 #include <cassert>
+#include <chrono>
 #include <cstring>
 
 US_BEGIN_NAMESPACE
@@ -115,6 +116,25 @@ ModulePrivate::~ModulePrivate()
   delete moduleContext;
 }
 
+void ModulePrivate::LoadActivator()
+{
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  // This method should be "noexcept" and by not catching exceptions
+  // here we semantically treat it that way since any exception during
+  // static initialization will either terminate the program or cause
+  // the dynamic loader to report an error.
+  moduleActivator->Load(moduleContext);
+
+  const double activationTime = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+  moduleManifest.SetValue(Module::PROP_ACTIVATION_TIME(), Any(activationTime));
+  if (ModuleSettings::IsActivationTimingEnabled())
+  {
+    US_INFO << "Activating module " << info.name << " took " << activationTime << " ms";
+  }
+}
+
 void ModulePrivate::RemoveModuleResources()
 {
   coreCtx->listeners.RemoveAllListeners(moduleContext);
@@ -55,6 +55,12 @@ public:
 
   void RemoveModuleResources();
 
+  /**
+   * Calls the Load() method of the module activator and records
+   * the time it took.
+   */
+  void LoadActivator();
+
   CoreModuleContext* const coreCtx;
 
   /**
@@ -202,6 +202,11 @@ std::vector<Module*> ModuleRegistry::GetLoadedModules()
   return result;
 }
 
+void ModuleRegistry::ActivateDeferredModules()
+{
+  coreModuleContext()->activationScheduler.ActivateAll(true);
+}
+
 // Control the static initialization order for several core objects
 struct StaticInitializationOrder
 {
@@ -67,6 +67,9 @@ struct ModuleSettingsPrivate : public MultiThreaded<>
     , autoLoadingEnabled(false)
   #endif
     , autoLoadingDisabled(false)
+    , lazyActivationEnabled(true)
+    , lazyActivationDisabled(false)
+    , activationTimingEnabled(false)
     , logLevel(DebugMsg)
   {
     autoLoadPaths.insert(ModuleSettings::CURRENT_MODULE_PATH());
@@ -95,12 +98,25 @@ struct ModuleSettingsPrivate : public MultiThreaded<>
     {
       autoLoadingDisabled = true;
     }
+
+    if (getenv("US_DISABLE_LAZY_ACTIVATION"))
+    {
+      lazyActivationDisabled = true;
+    }
+
+    if (getenv("US_ACTIVATION_TIMING"))
+    {
+      activationTimingEnabled = true;
+    }
   }
 
   std::set<std::string> autoLoadPaths;
   std::set<std::string> extraPaths;
   bool autoLoadingEnabled;
   bool autoLoadingDisabled;
+  bool lazyActivationEnabled;
+  bool lazyActivationDisabled;
+  bool activationTimingEnabled;
   std::string storagePath;
   MsgType logLevel;
 };
@@ -162,6 +178,31 @@ void ModuleSettings::AddAutoLoadPath(const std::string& path)
   moduleSettingsPrivate()->autoLoadPaths.insert(RemoveTrailingPathSeparator(path));
 }
 
+bool ModuleSettings::IsLazyActivationEnabled()
+{
+  US_UNUSED(ModuleSettingsPrivate::Lock(moduleSettingsPrivate()));
+  return !moduleSettingsPrivate()->lazyActivationDisabled &&
+      moduleSettingsPrivate()->lazyActivationEnabled;
+}
+
+void ModuleSettings::SetLazyActivationEnabled(bool enable)
+{
+  US_UNUSED(ModuleSettingsPrivate::Lock(moduleSettingsPrivate()));
+  moduleSettingsPrivate()->lazyActivationEnabled = enable;
+}
+
+bool ModuleSettings::IsActivationTimingEnabled()
+{
+  US_UNUSED(ModuleSettingsPrivate::Lock(moduleSettingsPrivate()));
+  return moduleSettingsPrivate()->activationTimingEnabled;
+}
+
+void ModuleSettings::SetActivationTimingEnabled(bool enable)
+{
+  US_UNUSED(ModuleSettingsPrivate::Lock(moduleSettingsPrivate()));
+  moduleSettingsPrivate()->activationTimingEnabled = enable;
+}
+
 void ModuleSettings::SetStoragePath(const std::string &path)
 {
   US_UNUSED(ModuleSettingsPrivate::Lock(moduleSettingsPrivate()));
@@ -282,6 +282,30 @@ bool LDAPExpr::IsSimple(const StringList& keywords, LocalCache& cache,
   return false;
 }
 
+bool LDAPExpr::GetRequiredPropertyValue(std::string& attrName, std::string& attrValue) const
+{
+  if (d->m_operator == EQ)
+  {
+    if ((d->m_attrName.length() != ServiceConstants::OBJECTCLASS().length() ||
+         !std::equal(d->m_attrName.begin(), d->m_attrName.end(), ServiceConstants::OBJECTCLASS().begin(), stricomp)) &&
+        d->m_attrValue.find(LDAPExprConstants::WILDCARD()) == std::string::npos)
+    {
+      attrName = d->m_attrName;
+      attrValue = d->m_attrValue;
+      return true;
+    }
+  }
+  else if (d->m_operator == AND)
+  {
+    for (std::size_t i = 0; i < d->m_args.size(); i++)
+    {
+      if (d->m_args[i].GetRequiredPropertyValue(attrName, attrValue))
+        return true;
+    }
+  }
+  return false;
+}
+
 bool LDAPExpr::IsNull() const
 {
   return !d;
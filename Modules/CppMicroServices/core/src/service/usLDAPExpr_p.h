@@ -110,6 +110,18 @@ public:
     LocalCache& cache,
     bool matchCase) const;
 
+  /**
+   * Gets the attribute name and value of an equality term without
+   * wildcards which must be true for this expression to be true, i.e.
+   * the expression itself or an argument of an <code>AND</code>
+   * expression. Terms for the object class are skipped.
+   *
+   * @param attrName The name of the first such term.
+   * @param attrValue The value of the first such term.
+   * @return <code>true</code> if such a term was found.
+   */
+  bool GetRequiredPropertyValue(std::string& attrName, std::string& attrValue) const;
+
   /**
    * Returns <code>true</code> if this instance is invalid, i.e. it was
    * constructed using LDAPExpr().
@@ -19,7 +19,9 @@
 
 ============================================================================*/
 
+#include <algorithm>
 #include <iterator>
+#include <list>
 #include <stdexcept>
 #include <cassert>
 
@@ -34,6 +36,16 @@
 
 US_BEGIN_NAMESPACE
 
+namespace {
+
+// The number of parsed filters which are kept, the cache is cleared when it is full.
+const std::size_t MaxCachedFilters = 256;
+
+// The number of property keys which are indexed.
+const std::size_t MaxPropertyIndexes = 32;
+
+}
+
 ServicePropertiesImpl ServiceRegistry::CreateServiceProperties(const ServiceProperties& in,
                                                                const std::vector<std::string>& classes,
                                                                bool isFactory, bool isPrototypeFactory,
@@ -81,6 +93,8 @@ void ServiceRegistry::Clear()
   services.clear();
   serviceRegistrations.clear();
   classServices.clear();
+  filterCache.clear();
+  propertyIndexes.clear();
   core = nullptr;
 }
 
@@ -123,6 +137,11 @@ ServiceRegistrationBase ServiceRegistry::RegisterService(ModulePrivate* module,
           std::lower_bound(s.begin(), s.end(), res);
       s.insert(ip, res);
     }
+    for (MapPropertyIndexes::iterator i = propertyIndexes.begin();
+         i != propertyIndexes.end(); ++i)
+    {
+      AddToPropertyIndex_unlocked(i->first, i->second, res);
+    }
   }
 
   ServiceReferenceBase r = res.GetReference(std::string());
@@ -147,6 +166,21 @@ void ServiceRegistry::UpdateServiceRegistrationOrder(const ServiceRegistrationBa
   }
 }
 
+void ServiceRegistry::UpdatePropertyIndexes(const ServiceRegistrationBase& sr)
+{
+  MutexLock lock(mutex);
+  if (services.find(sr) == services.end())
+  {
+    return;
+  }
+  RemoveFromPropertyIndexes_unlocked(sr);
+  for (MapPropertyIndexes::iterator i = propertyIndexes.begin();
+       i != propertyIndexes.end(); ++i)
+  {
+    AddToPropertyIndex_unlocked(i->first, i->second, sr);
+  }
+}
+
 void ServiceRegistry::Get(const std::string& clazz,
                           std::vector<ServiceRegistrationBase>& serviceRegs) const
 {
@@ -198,23 +232,32 @@ void ServiceRegistry::Get_unlocked(const std::string& clazz, const std::string&
   std::vector<ServiceRegistrationBase>::const_iterator s;
   std::vector<ServiceRegistrationBase>::const_iterator send;
   std::vector<ServiceRegistrationBase> v;
+  std::vector<ServiceRegistrationBase> indexed;
   LDAPExpr ldap;
   if (clazz.empty())
   {
     if (!filter.empty())
     {
-      ldap = LDAPExpr(filter);
-      LDAPExpr::ObjectClassSet matched;
-      if (ldap.GetMatchedObjectClasses(matched))
+      // copied, since the cache may be modified by a service hook
+      const CompiledFilter compiled = GetCompiledFilter_unlocked(filter);
+      ldap = compiled.ldap;
+      const bool useIndex = GetIndexedServices_unlocked(compiled, indexed);
+      if (compiled.hasObjectClasses)
       {
-        v.clear();
-        for(LDAPExpr::ObjectClassSet::const_iterator className = matched.begin();
-            className != matched.end(); ++className)
+        for(LDAPExpr::ObjectClassSet::const_iterator className = compiled.objectClasses.begin();
+            className != compiled.objectClasses.end(); ++className)
         {
           MapClassServices::const_iterator i = classServices.find(*className);
           if (i != classServices.end())
           {
-            std::copy(i->second.begin(), i->second.end(), std::back_inserter(v));
+            if (useIndex)
+            {
+              SelectIndexedServices_unlocked(i->second, *className, indexed, v);
+            }
+            else
+            {
+              std::copy(i->second.begin(), i->second.end(), std::back_inserter(v));
+            }
           }
         }
         if (!v.empty())
@@ -227,6 +270,11 @@ void ServiceRegistry::Get_unlocked(const std::string& clazz, const std::string&
           return;
         }
       }
+      else if (useIndex && indexed.size() < serviceRegistrations.size())
+      {
+        s = indexed.begin();
+        send = indexed.end();
+      }
       else
       {
         s = serviceRegistrations.begin();
@@ -253,7 +301,14 @@ void ServiceRegistry::Get_unlocked(const std::string& clazz, const std::string&
     }
     if (!filter.empty())
     {
-      ldap = LDAPExpr(filter);
+      const CompiledFilter compiled = GetCompiledFilter_unlocked(filter);
+      ldap = compiled.ldap;
+      if (GetIndexedServices_unlocked(compiled, indexed))
+      {
+        SelectIndexedServices_unlocked(it->second, clazz, indexed, v);
+        s = v.begin();
+        send = v.end();
+      }
     }
   }
 
@@ -280,10 +335,187 @@ void ServiceRegistry::Get_unlocked(const std::string& clazz, const std::string&
   }
 }
 
+const ServiceRegistry::CompiledFilter& ServiceRegistry::GetCompiledFilter_unlocked(const std::string& filter) const
+{
+  MapFilters::const_iterator cached = filterCache.find(filter);
+  if (cached != filterCache.end())
+  {
+    return cached->second;
+  }
+
+  // throws std::invalid_argument for malformed filters, which are not cached
+  CompiledFilter compiled;
+  compiled.ldap = LDAPExpr(filter);
+  compiled.hasObjectClasses = compiled.ldap.GetMatchedObjectClasses(compiled.objectClasses);
+
+  compiled.ldap.GetRequiredPropertyValue(compiled.indexKey, compiled.indexValue);
+
+  if (filterCache.size() >= MaxCachedFilters)
+  {
+    filterCache.clear();
+  }
+  return filterCache.insert(std::make_pair(filter, compiled)).first->second;
+}
+
+bool ServiceRegistry::GetIndexedServices_unlocked(const CompiledFilter& compiled,
+                                                  std::vector<ServiceRegistrationBase>& serviceRegs) const
+{
+  if (compiled.indexKey.empty())
+  {
+    return false;
+  }
+
+  MapPropertyIndexes::iterator index = propertyIndexes.find(compiled.indexKey);
+  if (index == propertyIndexes.end())
+  {
+    if (propertyIndexes.size() >= MaxPropertyIndexes)
+    {
+      return false;
+    }
+    index = propertyIndexes.insert(std::make_pair(compiled.indexKey, PropertyIndex())).first;
+    for (std::vector<ServiceRegistrationBase>::const_iterator i = serviceRegistrations.begin();
+         i != serviceRegistrations.end(); ++i)
+    {
+      AddToPropertyIndex_unlocked(index->first, index->second, *i);
+    }
+  }
+
+  // only services with a matching value or a value which is not a string can match
+  const PropertyIndex& propertyIndex = index->second;
+  MapClassServices::const_iterator values = propertyIndex.valueServices.find(compiled.indexValue);
+  if (values == propertyIndex.valueServices.end())
+  {
+    serviceRegs = propertyIndex.otherServices;
+  }
+  else if (propertyIndex.otherServices.empty())
+  {
+    serviceRegs = values->second;
+  }
+  else
+  {
+    std::merge(values->second.begin(), values->second.end(),
+               propertyIndex.otherServices.begin(), propertyIndex.otherServices.end(),
+               std::back_inserter(serviceRegs), ServiceIdLess);
+  }
+  return true;
+}
+
+void ServiceRegistry::SelectIndexedServices_unlocked(const std::vector<ServiceRegistrationBase>& classRegs,
+                                                     const std::string& clazz,
+                                                     const std::vector<ServiceRegistrationBase>& indexedRegs,
+                                                     std::vector<ServiceRegistrationBase>& serviceRegs) const
+{
+  if (indexedRegs.size() >= classRegs.size())
+  {
+    std::copy(classRegs.begin(), classRegs.end(), std::back_inserter(serviceRegs));
+    return;
+  }
+
+  // keep the ranking order of the class services
+  const std::size_t first = serviceRegs.size();
+  for (std::vector<ServiceRegistrationBase>::const_iterator i = indexedRegs.begin();
+       i != indexedRegs.end(); ++i)
+  {
+    MapServiceClasses::const_iterator classes = services.find(*i);
+    if (classes != services.end() &&
+        std::find(classes->second.begin(), classes->second.end(), clazz) != classes->second.end())
+    {
+      serviceRegs.push_back(*i);
+    }
+  }
+  std::sort(serviceRegs.begin() + first, serviceRegs.end());
+}
+
+long ServiceRegistry::GetServiceId(const ServiceRegistrationBase& sr)
+{
+  return any_cast<long>(sr.d->properties.Value(ServiceConstants::SERVICE_ID()));
+}
+
+bool ServiceRegistry::ServiceIdLess(const ServiceRegistrationBase& a, const ServiceRegistrationBase& b)
+{
+  return GetServiceId(a) < GetServiceId(b);
+}
+
+void ServiceRegistry::InsertByServiceId(std::vector<ServiceRegistrationBase>& serviceRegs,
+                                        const ServiceRegistrationBase& sr)
+{
+  std::vector<ServiceRegistrationBase>::iterator i =
+      std::lower_bound(serviceRegs.begin(), serviceRegs.end(), sr, ServiceIdLess);
+  if (i == serviceRegs.end() || !(*i == sr))
+  {
+    serviceRegs.insert(i, sr);
+  }
+}
+
+void ServiceRegistry::AddToPropertyIndex_unlocked(const std::string& key, PropertyIndex& index,
+                                                  const ServiceRegistrationBase& sr) const
+{
+  // the same lookup as in LDAPExpr::Evaluate
+  const ServicePropertiesImpl& props = sr.d->properties;
+  int i = props.FindCaseSensitive(key);
+  if (i < 0) i = props.Find(key);
+  if (i < 0) return;
+
+  const Any& value = props.Value(i);
+  if (value.Empty())
+  {
+    return;
+  }
+  else if (value.Type() == typeid(std::string))
+  {
+    InsertByServiceId(index.valueServices[ref_any_cast<std::string>(value)], sr);
+  }
+  else if (value.Type() == typeid(std::vector<std::string>))
+  {
+    const std::vector<std::string>& list = ref_any_cast<std::vector<std::string> >(value);
+    for (std::vector<std::string>::const_iterator it = list.begin(); it != list.end(); ++it)
+    {
+      InsertByServiceId(index.valueServices[*it], sr);
+    }
+  }
+  else if (value.Type() == typeid(std::list<std::string>))
+  {
+    const std::list<std::string>& list = ref_any_cast<std::list<std::string> >(value);
+    for (std::list<std::string>::const_iterator it = list.begin(); it != list.end(); ++it)
+    {
+      InsertByServiceId(index.valueServices[*it], sr);
+    }
+  }
+  else
+  {
+    InsertByServiceId(index.otherServices, sr);
+  }
+}
+
+void ServiceRegistry::RemoveFromPropertyIndexes_unlocked(const ServiceRegistrationBase& sr) const
+{
+  for (MapPropertyIndexes::iterator index = propertyIndexes.begin();
+       index != propertyIndexes.end(); ++index)
+  {
+    MapClassServices& valueServices = index->second.valueServices;
+    for (MapClassServices::iterator i = valueServices.begin(); i != valueServices.end();)
+    {
+      i->second.erase(std::remove(i->second.begin(), i->second.end(), sr), i->second.end());
+      if (i->second.empty())
+      {
+        i = valueServices.erase(i);
+      }
+      else
+      {
+        ++i;
+      }
+    }
+    std::vector<ServiceRegistrationBase>& otherServices = index->second.otherServices;
+    otherServices.erase(std::remove(otherServices.begin(), otherServices.end(), sr), otherServices.end());
+  }
+}
+
 void ServiceRegistry::RemoveServiceRegistration(const ServiceRegistrationBase& sr)
 {
   MutexLock lock(mutex);
 
+  RemoveFromPropertyIndexes_unlocked(sr);
+
   assert(sr.d->properties.Value(ServiceConstants::OBJECTCLASS()).Type() == typeid(std::vector<std::string>));
   const std::vector<std::string>& classes = ref_any_cast<std::vector<std::string> >(
         sr.d->properties.Value(ServiceConstants::OBJECTCLASS()));
@@ -27,6 +27,7 @@
 #include "usServiceRegistration.h"
 
 #include "usThreads_p.h"
+#include "usLDAPExpr_p.h"
 
 US_BEGIN_NAMESPACE
 
@@ -79,6 +80,47 @@ public:
    */
   MapClassServices classServices;
 
+  /**
+   * A parsed LDAP filter together with the information which is
+   * needed to select the services it has to be evaluated for.
+   */
+  struct CompiledFilter
+  {
+    LDAPExpr ldap;
+    bool hasObjectClasses;
+    LDAPExpr::ObjectClassSet objectClasses;
+    std::string indexKey;
+    std::string indexValue;
+  };
+
+  typedef US_UNORDERED_MAP_TYPE<std::string, CompiledFilter> MapFilters;
+
+  /**
+   * Registered services by the (string) value of a property key.
+   * Services with a non-string value for the key can not be indexed
+   * and are kept in otherServices. All lists are ordered by service id.
+   */
+  struct PropertyIndex
+  {
+    MapClassServices valueServices;
+    std::vector<ServiceRegistrationBase> otherServices;
+  };
+
+  typedef US_UNORDERED_MAP_TYPE<std::string, PropertyIndex> MapPropertyIndexes;
+
+  /**
+   * Filters which have been used for service lookups, so that they
+   * do not have to be parsed again.
+   */
+  mutable MapFilters filterCache;
+
+  /**
+   * Indexes of the property keys used in equality terms of filters.
+   * An index is created when a key is used for the first time and is
+   * kept up to date afterwards.
+   */
+  mutable MapPropertyIndexes propertyIndexes;
+
   CoreModuleContext* core;
 
   ServiceRegistry(CoreModuleContext* coreCtx);
@@ -116,6 +158,13 @@ public:
   void UpdateServiceRegistrationOrder(const ServiceRegistrationBase& sr,
                                       const std::vector<std::string>& classes);
 
+  /**
+   * Service properties changed, update the property indexes.
+   *
+   * @param sr The ServiceRegistration object with the new properties.
+   */
+  void UpdatePropertyIndexes(const ServiceRegistrationBase& sr);
+
   /**
    * Get all services implementing a certain class.
    * Only used internally by the framework.
@@ -178,6 +227,28 @@ private:
   void Get_unlocked(const std::string& clazz, const std::string& filter,
                     ModulePrivate* module, std::vector<ServiceReferenceBase>& serviceRefs) const;
 
+  const CompiledFilter& GetCompiledFilter_unlocked(const std::string& filter) const;
+
+  bool GetIndexedServices_unlocked(const CompiledFilter& compiled,
+                                   std::vector<ServiceRegistrationBase>& serviceRegs) const;
+
+  void SelectIndexedServices_unlocked(const std::vector<ServiceRegistrationBase>& classRegs,
+                                      const std::string& clazz,
+                                      const std::vector<ServiceRegistrationBase>& indexedRegs,
+                                      std::vector<ServiceRegistrationBase>& serviceRegs) const;
+
+  void AddToPropertyIndex_unlocked(const std::string& key, PropertyIndex& index,
+                                   const ServiceRegistrationBase& sr) const;
+
+  void RemoveFromPropertyIndexes_unlocked(const ServiceRegistrationBase& sr) const;
+
+  static long GetServiceId(const ServiceRegistrationBase& sr);
+
+  static bool ServiceIdLess(const ServiceRegistrationBase& a, const ServiceRegistrationBase& b);
+
+  static void InsertByServiceId(std::vector<ServiceRegistrationBase>& serviceRegs,
+                                const ServiceRegistrationBase& sr);
+
   // purposely not implemented
   ServiceRegistry(const ServiceRegistry&);
   ServiceRegistry& operator=(const ServiceRegistry&);
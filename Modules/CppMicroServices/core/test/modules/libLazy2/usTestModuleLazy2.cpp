@@ -0,0 +1,54 @@
+/*============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) German Cancer Research Center (DKFZ)
+  All rights reserved.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+============================================================================*/
+
+#include <usModuleActivator.h>
+#include <usModuleContext.h>
+#include <usServiceInterface.h>
+
+US_BEGIN_NAMESPACE
+
+struct TestModuleLazy2Service
+{
+  virtual ~TestModuleLazy2Service() {}
+};
+
+class TestModuleLazy2Activator : public ModuleActivator, public TestModuleLazy2Service
+{
+public:
+
+  void Load(ModuleContext* context) override
+  {
+    // the activator of TestModuleLazy has to be called before
+    if (context->GetServiceReference("us::TestModuleLazyService"))
+    {
+      context->RegisterService<TestModuleLazy2Service>(this);
+    }
+  }
+
+  void Unload(ModuleContext*) override
+  {
+  }
+
+};
+
+US_END_NAMESPACE
+
+US_EXPORT_MODULE_ACTIVATOR(US_PREPEND_NAMESPACE(TestModuleLazy2Activator))
@@ -293,6 +293,79 @@ void frame045a(ModuleContext* mc)
   }
 }
 
+#ifdef US_BUILD_SHARED_LIBS
+// Load a module with a lazy activation policy and check that its activator
+// is called on the first service lookup
+void frame050a(ModuleContext* mc, TestModuleListener& listener)
+{
+  SharedLibrary libLazy(LIB_PATH, "TestModuleLazy");
+  try
+  {
+    libLazy.Load();
+  }
+  catch (const std::exception& e)
+  {
+    US_TEST_FAILED_MSG(<< "Load module exception: " << e.what())
+  }
+
+  Module* moduleLazy = ModuleRegistry::GetModule("TestModuleLazy");
+  US_TEST_CONDITION_REQUIRED(moduleLazy != nullptr, "Test for existing module TestModuleLazy")
+  US_TEST_CONDITION(moduleLazy->IsLoaded() == true, "Test if loaded correctly")
+  US_TEST_CONDITION(moduleLazy->GetRegisteredServices().empty(), "Test for deferred activator")
+  US_TEST_CONDITION(moduleLazy->GetProperty(Module::PROP_ACTIVATION_TIME()).Empty(), "Test for missing activation time")
+
+  ServiceReferenceU sr1 = mc->GetServiceReference("us::TestModuleLazyService");
+  US_TEST_CONDITION(sr1, "Test for service registered by the deferred activator")
+  US_TEST_CONDITION(moduleLazy->GetProperty(Module::PROP_ACTIVATION_TIME()).Type() == typeid(double), "Test for activation time")
+
+  std::vector<ModuleEvent> pEvts;
+  pEvts.push_back(ModuleEvent(ModuleEvent::LOADING, moduleLazy));
+  pEvts.push_back(ModuleEvent(ModuleEvent::LOADED, moduleLazy));
+
+  std::vector<ServiceEvent> seEvts;
+  seEvts.push_back(ServiceEvent(ServiceEvent::REGISTERED, sr1));
+
+  US_TEST_CONDITION(listener.CheckListenerEvents(pEvts, seEvts), "Test for unexpected events");
+
+  libLazy.Unload();
+  US_TEST_CONDITION(moduleLazy->IsLoaded() == false, "Test for unloaded state")
+
+  pEvts.clear();
+  pEvts.push_back(ModuleEvent(ModuleEvent::UNLOADING, moduleLazy));
+  pEvts.push_back(ModuleEvent(ModuleEvent::UNLOADED, moduleLazy));
+
+  seEvts.clear();
+  seEvts.push_back(ServiceEvent(ServiceEvent::UNREGISTERING, sr1));
+
+  US_TEST_CONDITION(listener.CheckListenerEvents(pEvts, seEvts), "Test for unexpected events");
+
+  // Load it again together with a module depending on it and call the
+  // deferred activators explicitly
+  SharedLibrary libLazy2(LIB_PATH, "TestModuleLazy2");
+  try
+  {
+    libLazy2.Load();
+    libLazy.Load();
+  }
+  catch (const std::exception& e)
+  {
+    US_TEST_FAILED_MSG(<< "Load module exception: " << e.what())
+  }
+
+  Module* moduleLazy2 = ModuleRegistry::GetModule("TestModuleLazy2");
+  US_TEST_CONDITION_REQUIRED(moduleLazy2 != nullptr, "Test for existing module TestModuleLazy2")
+  US_TEST_CONDITION(moduleLazy->GetRegisteredServices().empty(), "Test for deferred activator")
+  US_TEST_CONDITION(moduleLazy2->GetRegisteredServices().empty(), "Test for deferred activator")
+  ModuleRegistry::ActivateDeferredModules();
+  US_TEST_CONDITION(moduleLazy->GetRegisteredServices().size() == 1, "Test for called activator")
+  US_TEST_CONDITION(moduleLazy2->GetRegisteredServices().size() == 1, "Test for activator called after its dependency")
+
+  libLazy2.Unload();
+  libLazy.Unload();
+  US_TEST_CONDITION(moduleLazy->IsLoaded() == false, "Test for unloaded state")
+}
+#endif
+
 } // end unnamed namespace
 
 int usModuleTest(int /*argc*/, char* /*argv*/[])
@@ -342,6 +415,10 @@ int usModuleTest(int /*argc*/, char* /*argv*/[])
 
   frame045a(mc);
 
+#ifdef US_BUILD_SHARED_LIBS
+  frame050a(mc, listener);
+#endif
+
   mc->RemoveModuleListener(&listener, &TestModuleListener::ModuleChanged);
   mc->RemoveServiceListener(&listener, &TestModuleListener::ServiceChanged);
 
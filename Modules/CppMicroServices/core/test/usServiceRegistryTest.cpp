@@ -127,6 +127,63 @@ void TestServicePropertiesUpdate()
   US_TEST_CONDITION_REQUIRED(context->GetServiceReferences<ITestServiceA>().empty(), "Testing service count")
 }
 
+void TestFilteredServiceReferences()
+{
+  struct TestServiceA : public ITestServiceA
+  {
+  };
+
+  ModuleContext* context = GetModuleContext();
+
+  TestServiceA s1;
+  TestServiceA s2;
+  TestServiceA s3;
+
+  ServiceProperties props;
+  props["name"] = std::string("a");
+  ServiceRegistration<ITestServiceA> reg1 = context->RegisterService<ITestServiceA>(&s1, props);
+  props["name"] = 1;
+  ServiceRegistration<ITestServiceA> reg2 = context->RegisterService<ITestServiceA>(&s2, props);
+  std::vector<std::string> names;
+  names.push_back("a");
+  names.push_back("b");
+  props["name"] = names;
+  ServiceRegistration<ITestServiceA> reg3 = context->RegisterService<ITestServiceA>(&s3, props);
+
+  // repeat the lookups to use the cached filters
+  for (int i = 0; i < 2; ++i)
+  {
+    US_TEST_CONDITION_REQUIRED(context->GetServiceReferences<ITestServiceA>("(name=a)").size() == 2, "Testing string property filter")
+    US_TEST_CONDITION_REQUIRED(context->GetServiceReferences<ITestServiceA>("(NAME=b)").size() == 1, "Testing case insensitive key")
+    US_TEST_CONDITION_REQUIRED(context->GetServiceReferences<ITestServiceA>("(name=1)").size() == 1, "Testing integer property filter")
+    US_TEST_CONDITION_REQUIRED(context->GetServiceReferences<ITestServiceA>("(name=*)").size() == 3, "Testing presence filter")
+    US_TEST_CONDITION_REQUIRED(context->GetServiceReferences<ITestServiceA>("(|(name=b)(name=1))").size() == 2, "Testing or filter")
+    US_TEST_CONDITION_REQUIRED(context->GetServiceReferences("", "(&(objectclass=ITestServiceA)(name=a))").size() == 2, "Testing object class filter")
+    US_TEST_CONDITION_REQUIRED(context->GetServiceReferences("", "(name=b)").size() == 1, "Testing filter without class")
+  }
+
+  props["name"] = std::string("b");
+  reg1.SetProperties(props);
+  US_TEST_CONDITION_REQUIRED(context->GetServiceReferences<ITestServiceA>("(name=a)").size() == 1, "Testing filter after property update")
+  US_TEST_CONDITION_REQUIRED(context->GetServiceReferences<ITestServiceA>("(name=b)").size() == 2, "Testing filter after property update")
+
+  reg3.Unregister();
+  US_TEST_CONDITION_REQUIRED(context->GetServiceReferences<ITestServiceA>("(name=a)").empty(), "Testing filter after unregistration")
+  US_TEST_CONDITION_REQUIRED(context->GetServiceReferences<ITestServiceA>("(name=b)").size() == 1, "Testing filter after unregistration")
+
+  try
+  {
+    context->GetServiceReferences<ITestServiceA>("(name=a");
+    US_TEST_FAILED_MSG(<< "Invalid filter accepted")
+  }
+  catch (const std::invalid_argument&)
+  {
+  }
+
+  reg1.Unregister();
+  reg2.Unregister();
+}
+
 
 int usServiceRegistryTest(int /*argc*/, char* /*argv*/[])
 {
@@ -135,6 +192,7 @@ int usServiceRegistryTest(int /*argc*/, char* /*argv*/[])
   TestServiceInterfaceId();
   TestMultipleServiceRegistrations();
   TestServicePropertiesUpdate();
+  TestFilteredServiceReferences();
 
   US_TEST_END()
 }
@@ -0,0 +1,439 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkCommandLineParser.h"
+
+#include "mitkDICOMFileReaderSelector.h"
+#include "mitkDICOMPersistentTagCacheIndex.h"
+
+#include <itksys/Directory.hxx>
+#include <itksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  /** Tags that are written for each block in addition to the file list, with their JSON keys */
+  const std::vector<std::pair<mitk::DICOMTag, std::string>> IndexedTags = {
+    {mitk::DICOMTag(0x0010, 0x0020), "patientID"},
+    {mitk::DICOMTag(0x0020, 0x000d), "studyInstanceUID"},
+    {mitk::DICOMTag(0x0008, 0x0020), "studyDate"},
+    {mitk::DICOMTag(0x0020, 0x000e), "seriesInstanceUID"},
+    {mitk::DICOMTag(0x0020, 0x0011), "seriesNumber"},
+    {mitk::DICOMTag(0x0008, 0x103e), "seriesDescription"},
+    {mitk::DICOMTag(0x0008, 0x0060), "modality"}};
+
+  std::string PropertyNameOfTag(const std::string &key) { return "indexer." + key; }
+
+  std::string EscapeJSON(const std::string &value)
+  {
+    std::ostringstream stream;
+    for (const char c : value)
+    {
+      switch (c)
+      {
+        case '"':
+          stream << "\\\"";
+          break;
+        case '\\':
+          stream << "\\\\";
+          break;
+        case '\n':
+          stream << "\\n";
+          break;
+        case '\r':
+          stream << "\\r";
+          break;
+        case '\t':
+          stream << "\\t";
+          break;
+        default:
+          if (static_cast<unsigned char>(c) < 0x20)
+          {
+            stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+          }
+          else
+          {
+            stream << c;
+          }
+      }
+    }
+    return stream.str();
+  }
+
+  /** DICOM part 10 files have "DICM" after the 128 byte preamble */
+  bool HasDICOMPreamble(const std::string &filename)
+  {
+    std::ifstream stream(filename, std::ios::binary);
+    char magic[4] = {0};
+    stream.seekg(128);
+    stream.read(magic, 4);
+    return stream && std::memcmp(magic, "DICM", 4) == 0;
+  }
+
+  /** Limits the number of directories whose files are read at the same time */
+  class IOSlots
+  {
+  public:
+    explicit IOSlots(unsigned int count) : m_Available(count) {}
+
+    void Acquire()
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_Condition.wait(lock, [this]() { return m_Available > 0; });
+      --m_Available;
+    }
+
+    void Release()
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        ++m_Available;
+      }
+      m_Condition.notify_one();
+    }
+
+  private:
+    std::mutex m_Mutex;
+    std::condition_variable m_Condition;
+    unsigned int m_Available;
+  };
+
+  /** Directories that wait to be indexed. Workers add the subdirectories they find. */
+  class DirectoryQueue
+  {
+  public:
+    explicit DirectoryQueue(const std::string &root) : m_Directories(1, root), m_NumberOfBusyWorkers(0) {}
+
+    /** Returns false if all directories are done */
+    bool Pop(std::string &directory)
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_Condition.wait(lock, [this]() { return !m_Directories.empty() || m_NumberOfBusyWorkers == 0; });
+      if (m_Directories.empty())
+      {
+        return false;
+      }
+
+      directory = m_Directories.front();
+      m_Directories.pop_front();
+      ++m_NumberOfBusyWorkers;
+      return true;
+    }
+
+    void Push(const std::vector<std::string> &directories)
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Directories.insert(m_Directories.end(), directories.begin(), directories.end());
+      }
+      m_Condition.notify_all();
+    }
+
+    void Done()
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        --m_NumberOfBusyWorkers;
+      }
+      m_Condition.notify_all();
+    }
+
+  private:
+    std::mutex m_Mutex;
+    std::condition_variable m_Condition;
+    std::deque<std::string> m_Directories;
+    unsigned int m_NumberOfBusyWorkers;
+  };
+
+  struct IndexerSettings
+  {
+    bool recursive;
+    bool allFiles;
+    bool load3DnT;
+  };
+
+  /** Groups the files of one directory into blocks and returns one JSON line per block */
+  std::string IndexFiles(const std::string &directory, const mitk::StringList &files, const IndexerSettings &settings)
+  {
+    mitk::DICOMFileReaderSelector::Pointer selector = mitk::DICOMFileReaderSelector::New();
+    if (settings.load3DnT)
+    {
+      selector->LoadBuiltIn3DnTConfigs();
+    }
+    selector->LoadBuiltIn3DConfigs();
+
+    // directories are indexed in parallel already
+    selector->SetNumberOfThreads(1);
+
+    mitk::DICOMFileReader::AdditionalTagsMapType additionalTags;
+    for (const auto &tag : IndexedTags)
+    {
+      additionalTags[mitk::DICOMTagPath(tag.first)] = PropertyNameOfTag(tag.second);
+    }
+    for (const auto &reader : selector->GetAllConfiguredReaders())
+    {
+      reader->SetAdditionalTagsOfInterest(additionalTags);
+    }
+
+    selector->SetInputFiles(files);
+    mitk::DICOMFileReader::Pointer reader = selector->GetFirstReaderWithMinimumNumberOfOutputImages();
+    if (reader.IsNull())
+    {
+      return std::string();
+    }
+
+    std::ostringstream lines;
+    for (unsigned int i = 0; i < reader->GetNumberOfOutputs(); ++i)
+    {
+      const mitk::DICOMImageBlockDescriptor &block = reader->GetOutput(i);
+      const mitk::DICOMImageFrameList &frames = block.GetImageFrameList();
+
+      lines << "{\"directory\":\"" << EscapeJSON(directory) << "\"";
+      lines << ",\"reader\":\"" << EscapeJSON(reader->GetConfigurationLabel()) << "\"";
+      lines << ",\"sopClassUID\":\"" << EscapeJSON(block.GetSOPClassUID()) << "\"";
+      for (const auto &tag : IndexedTags)
+      {
+        lines << ",\"" << tag.second << "\":\"" << EscapeJSON(block.GetPropertyAsString(PropertyNameOfTag(tag.second)))
+              << "\"";
+      }
+      lines << ",\"numberOfFrames\":" << frames.size();
+      lines << ",\"numberOfTimeSteps\":" << block.GetNumberOfTimeSteps();
+      lines << ",\"gantryTilt\":" << (block.GetTiltInformation().IsSheared() ? "true" : "false");
+
+      // multi-frame files contribute several frames
+      lines << ",\"files\":[";
+      std::string lastFilename;
+      bool first = true;
+      for (const auto &frame : frames)
+      {
+        if (frame->Filename != lastFilename)
+        {
+          lines << (first ? "" : ",") << "\"" << EscapeJSON(frame->Filename) << "\"";
+          lastFilename = frame->Filename;
+          first = false;
+        }
+      }
+      lines << "]}\n";
+    }
+
+    return lines.str();
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  mitkCommandLineParser parser;
+
+  parser.setTitle("DICOM Indexer");
+  parser.setCategory("DICOM");
+  parser.setDescription("Groups the DICOM files of a directory tree into series/blocks without loading pixel data and "
+                        "writes one JSON line per block.");
+  parser.setContributor("German Cancer Research Center (DKFZ)");
+
+  parser.setArgumentPrefix("--", "-");
+  parser.addArgument("help", "h", mitkCommandLineParser::Bool, "Help:", "Show this help text");
+  parser.addArgument("input", "i", mitkCommandLineParser::Directory, "Input directory:", "Root of the directory tree",
+                     us::Any(), false, false, false, mitkCommandLineParser::Input);
+  parser.addArgument("output", "o", mitkCommandLineParser::File, "Output file:", "Index file (JSON lines)",
+                     us::Any(), false, false, false, mitkCommandLineParser::Output);
+  parser.addArgument("threads", "t", mitkCommandLineParser::Int, "Threads:",
+                     "Number of directories that are indexed in parallel (default: number of cores)");
+  parser.addArgument("io", "io", mitkCommandLineParser::Int, "Concurrent I/O:",
+                     "Maximum number of directories whose files are read at the same time (default: threads), "
+                     "use a small number for network file systems");
+  parser.addArgument("cache", "c", mitkCommandLineParser::File, "Tag cache:",
+                     "File of a persistent tag cache index that is used and updated, so unchanged files are not "
+                     "parsed again in the next run");
+  parser.addArgument("no-recursion", "nr", mitkCommandLineParser::Bool, "No recursion:",
+                     "Only index the files in the input directory");
+  parser.addArgument("all-files", "a", mitkCommandLineParser::Bool, "All files:",
+                     "Also pass files without DICOM preamble to the readers (e.g. ACR-NEMA files)");
+  parser.addArgument("3dnt", "4d", mitkCommandLineParser::Bool, "3D+t:", "Prefer readers that create 3D+t blocks");
+
+  std::map<std::string, us::Any> parsedArgs = parser.parseArguments(argc, argv);
+
+  if (parsedArgs.size() == 0)
+    return EXIT_FAILURE;
+
+  if (parsedArgs.count("help") || parsedArgs.count("h"))
+  {
+    std::cout << parser.helpText();
+    return EXIT_SUCCESS;
+  }
+
+  const std::string inputDirectory = us::any_cast<std::string>(parsedArgs["input"]);
+  const std::string outputFilename = us::any_cast<std::string>(parsedArgs["output"]);
+
+  if (!itksys::SystemTools::FileIsDirectory(inputDirectory))
+  {
+    MITK_ERROR << "Input is not a directory: " << inputDirectory;
+    return EXIT_FAILURE;
+  }
+
+  unsigned int numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+  if (parsedArgs.count("threads"))
+  {
+    numberOfThreads = static_cast<unsigned int>(std::max(1, us::any_cast<int>(parsedArgs["threads"])));
+  }
+
+  unsigned int numberOfIOSlots = numberOfThreads;
+  if (parsedArgs.count("io"))
+  {
+    numberOfIOSlots = static_cast<unsigned int>(std::max(1, us::any_cast<int>(parsedArgs["io"])));
+  }
+
+  IndexerSettings settings;
+  settings.recursive = !parsedArgs.count("no-recursion");
+  settings.allFiles = parsedArgs.count("all-files") > 0;
+  settings.load3DnT = parsedArgs.count("3dnt") > 0;
+
+  mitk::DICOMPersistentTagCacheIndex::Pointer cacheIndex;
+  if (parsedArgs.count("cache"))
+  {
+    cacheIndex = mitk::DICOMPersistentTagCacheIndex::New();
+    cacheIndex->SetFileName(us::any_cast<std::string>(parsedArgs["cache"]));
+    if (!cacheIndex->Load())
+    {
+      MITK_WARN << "Starting with an empty tag cache index.";
+    }
+    mitk::DICOMPersistentTagCacheIndex::SetGlobalIndex(cacheIndex);
+  }
+
+  std::ofstream output(outputFilename, std::ios::out | std::ios::trunc);
+  if (!output)
+  {
+    MITK_ERROR << "Cannot write index file: " << outputFilename;
+    return EXIT_FAILURE;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+
+  DirectoryQueue queue(itksys::SystemTools::CollapseFullPath(inputDirectory));
+  IOSlots ioSlots(numberOfIOSlots);
+  std::mutex outputMutex;
+  std::atomic<unsigned long long> numberOfFiles(0);
+  std::atomic<unsigned long long> numberOfBlocks(0);
+  std::atomic<unsigned long long> numberOfDirectories(0);
+
+  auto indexDirectories = [&]() {
+    std::string directory;
+    while (queue.Pop(directory))
+    {
+      std::vector<std::string> subdirectories;
+      std::string lines;
+
+      ioSlots.Acquire();
+      try
+      {
+        mitk::StringList files;
+        itksys::Directory entries;
+        if (entries.Load(directory))
+        {
+          for (unsigned long i = 0; i < entries.GetNumberOfFiles(); ++i)
+          {
+            const std::string name = entries.GetFile(i);
+            if (name == "." || name == "..")
+            {
+              continue;
+            }
+
+            const std::string path = directory + "/" + name;
+            if (itksys::SystemTools::FileIsDirectory(path))
+            {
+              // symbolic links could create cycles
+              if (settings.recursive && !itksys::SystemTools::FileIsSymlink(path))
+              {
+                subdirectories.push_back(path);
+              }
+            }
+            else if (settings.allFiles || HasDICOMPreamble(path))
+            {
+              files.push_back(path);
+            }
+          }
+        }
+        else
+        {
+          MITK_WARN << "Cannot read directory " << directory;
+        }
+
+        // the queue does not need to wait for the indexing of this directory
+        queue.Push(subdirectories);
+
+        if (!files.empty())
+        {
+          std::sort(files.begin(), files.end());
+          lines = IndexFiles(directory, files, settings);
+          numberOfFiles += files.size();
+          numberOfBlocks += std::count(lines.begin(), lines.end(), '\n');
+        }
+      }
+      catch (const std::exception &e)
+      {
+        MITK_ERROR << "Cannot index directory " << directory << ": " << e.what();
+      }
+      ioSlots.Release();
+
+      if (!lines.empty())
+      {
+        std::lock_guard<std::mutex> lock(outputMutex);
+        output << lines;
+      }
+
+      ++numberOfDirectories;
+      queue.Done();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned int i = 1; i < numberOfThreads; ++i)
+  {
+    threads.emplace_back(indexDirectories);
+  }
+  indexDirectories();
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  output.close();
+
+  if (cacheIndex.IsNotNull() && !cacheIndex->Save())
+  {
+    MITK_WARN << "Cannot save the tag cache index.";
+  }
+
+  const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+  std::cout << "Indexed " << numberOfFiles << " files in " << numberOfDirectories << " directories into "
+            << numberOfBlocks << " blocks in " << duration.count() << " s." << std::endl;
+
+  if (!output)
+  {
+    MITK_ERROR << "Cannot write index file: " << outputFilename;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -29,6 +29,9 @@ set(CPP_FILES
   mitkDICOMTagCache.cpp
   mitkDICOMGDCMTagCache.cpp
   mitkDICOMGenericTagCache.cpp
+  mitkDICOMPersistentTagCacheIndex.cpp
+  mitkDICOMProgressiveImageLoader.cpp
+  mitkDICOMTimeStepVolumeProvider.cpp
   mitkDICOMEnums.cpp
   mitkDICOMReaderConfigurator.cpp
   mitkDICOMFileReaderSelector.cpp
@@ -38,6 +38,14 @@ public:
 
   IFileReader::ConfidenceLevel GetConfidenceLevel() const override;
 
+  /** Name of the (bool) option that makes Read() return images whose slices are still loaded
+   * in the background (see DICOMITKSeriesGDCMReader::SetProgressiveLoading()).*/
+  static const std::string PROGRESSIVE_LOADING_OPTION_NAME;
+
+  /** Name of the (bool) option that makes Read() decode the time steps of 3D+t images on first access
+   * (see ThreeDnTDICOMSeriesReader::SetLoadTimeStepsOnDemand()).*/
+  static const std::string LOAD_TIME_STEPS_ON_DEMAND_OPTION_NAME;
+
 protected:
   /** Returns the list of all DCM files that are in the same directory
    * like this->GetLocalFileName().*/
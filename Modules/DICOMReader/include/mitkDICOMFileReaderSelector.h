@@ -78,7 +78,13 @@ class MITKDICOMREADER_EXPORT DICOMFileReaderSelector : public itk::LightObject
     /// Input files
     const StringList& GetInputFiles() const;
 
+    /// \brief Number of threads that scan the files and analyze them, 0 (default) uses one thread per core.
+    /// Set 1 to select readers for several file sets in parallel.
+    void SetNumberOfThreads(unsigned int numberOfThreads);
+    unsigned int GetNumberOfThreads() const;
+
     /// Execute the analysis and selection process. The first reader with a minimal number of outputs will be returned.
+    /// The input files are scanned once for the tags of all readers, the readers then analyze the files in parallel.
     DICOMFileReader::Pointer GetFirstReaderWithMinimumNumberOfOutputImages();
 
   protected:
@@ -94,6 +100,7 @@ class MITKDICOMREADER_EXPORT DICOMFileReaderSelector : public itk::LightObject
     StringList m_PossibleConfigurations;
     StringList m_InputFilenames;
     ReaderList m_Readers;
+    unsigned int m_NumberOfThreads;
 
  };
 
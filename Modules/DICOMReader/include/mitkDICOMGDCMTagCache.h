@@ -14,9 +14,12 @@ found in the LICENSE file.
 #define mitkDICOMGDCMTagCache_h
 
 #include "mitkDICOMTagCache.h"
+#include "mitkDICOMPersistentTagCacheIndex.h"
 
+#include <map>
 #include <set>
 #include <memory>
+#include <vector>
 
 #include <gdcmScanner.h>
 
@@ -43,6 +46,26 @@ namespace mitk
 
       void InitCache(const std::set<DICOMTag>& scannedTags, const std::shared_ptr<gdcm::Scanner>& scanner, const StringList& inputFiles);
 
+      /**
+        \brief Initialize the cache with the results of several scanners.
+        Each scanner scanned a part of the input files.
+      */
+      void InitCache(const std::set<DICOMTag>& scannedTags,
+                     const std::vector<std::shared_ptr<gdcm::Scanner>>& scanners,
+                     const StringList& inputFiles);
+
+      /**
+        \brief Initialize the cache with the results of several scanners and the values of files
+        that were found in a DICOMPersistentTagCacheIndex instead of being scanned.
+      */
+      void InitCache(const std::set<DICOMTag>& scannedTags,
+                     const std::vector<std::shared_ptr<gdcm::Scanner>>& scanners,
+                     const std::map<std::string, DICOMPersistentTagCacheIndex::FindingsType>& cachedFindings,
+                     const StringList& inputFiles);
+
+      /**
+        \brief Returns the (first) scanner of the cache.
+      */
       const gdcm::Scanner& GetScanner() const;
 
   protected:
@@ -52,7 +75,10 @@ namespace mitk
 
       std::set<DICOMTag> m_ScannedTags;
 
-      std::shared_ptr<gdcm::Scanner> m_Scanner;
+      // the frame infos refer to the values stored in the scanners
+      std::vector<std::shared_ptr<gdcm::Scanner>> m_Scanners;
+      // the frame infos of cached files refer to these values
+      std::shared_ptr<std::set<std::string>> m_CachedValues;
 
       DICOMDatasetAccessingImageFrameList m_ScanResult;
 
@@ -206,6 +206,7 @@ class MITKDICOMREADER_EXPORT DICOMITKSeriesGDCMReader : public DICOMFileReader
     // void AllocateOutputImages();
     /**
       \brief Loads images using itk::ImageSeriesReader, potentially applies shearing to correct gantry tilt.
+      Independent blocks are loaded concurrently and the slices of each block are decoded in parallel.
     */
     bool LoadImages() override;
 
@@ -227,6 +228,15 @@ class MITKDICOMREADER_EXPORT DICOMITKSeriesGDCMReader : public DICOMFileReader
 
     bool GetFixTiltByShearing() const;
 
+    /**
+      \brief Controls whether LoadImages() returns the images immediately and loads their slices in the background.
+      Blocks that need a gantry tilt correction or consist of multi-frame files are loaded as usual
+      (see DICOMProgressiveImageLoader).
+    */
+    void SetProgressiveLoading(bool on);
+
+    bool GetProgressiveLoading() const;
+
     /**
       \brief Controls whether groups of only two images are accepted when ensuring consecutive slices via EquiDistantBlocksSorter.
     */
@@ -345,6 +355,8 @@ class MITKDICOMREADER_EXPORT DICOMITKSeriesGDCMReader : public DICOMFileReader
 
     bool m_SimpleVolumeReading;
 
+    bool m_ProgressiveLoading;
+
   private:
 
     SortingBlockList m_SortingResultInProgress;
@@ -370,6 +382,9 @@ class MITKDICOMREADER_EXPORT DICOMITKSeriesGDCMReader : public DICOMFileReader
 
     DICOMTagCache::Pointer m_TagCache;
     bool m_ExternalCache;
+
+    // threads per block while LoadImages() loads several blocks, 0 uses all cores
+    unsigned int m_NumberOfSliceDecodingThreads;
 };
 
 }
@@ -161,6 +161,8 @@ namespace mitk
     int GetNumberOfTimeSteps() const;
     /**return the number of frames that constitute one timestep.*/
     int GetNumberOfFramesPerTimeStep() const;
+    /**return the files of the frames that constitute the given timestep, in the order of the frames.*/
+    StringList GetFilenamesOfTimeStep(int timeStep) const;
 
     void SetTagCache(DICOMTagCache* privateCache);
 
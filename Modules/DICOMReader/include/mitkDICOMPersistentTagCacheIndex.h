@@ -0,0 +1,129 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkDICOMPersistentTagCacheIndex_h
+#define mitkDICOMPersistentTagCacheIndex_h
+
+#include <itkObjectFactory.h>
+#include <mitkCommon.h>
+
+#include "mitkDICOMTagPath.h"
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <MitkDICOMReaderExports.h>
+
+namespace mitk
+{
+
+  /**
+    \ingroup DICOMReaderModule
+    \brief Keeps the tag values of scanned DICOM files in a file, so they do not have to be parsed again.
+
+    The tag scanners consult the index before they parse a file and add the results of
+    parsed files. Entries are identified by the absolute path of the file and are only
+    used as long as the size and the modification time of the file are unchanged and
+    all requested tag paths have been scanned before.
+
+    Set an index for all scanners with SetGlobalIndex() or for a single scanner with
+    DICOMTagScanner::SetPersistentTagCacheIndex(). The scanners call Save() after they
+    added entries, if a file name is set.
+
+    The index is stored in a compact binary format in native byte order. It is meant as
+    a local cache, unreadable index files are ignored.
+
+    All methods can be called from several threads.
+  */
+  class MITKDICOMREADER_EXPORT DICOMPersistentTagCacheIndex : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(DICOMPersistentTagCacheIndex, itk::Object);
+    itkFactorylessNewMacro(DICOMPersistentTagCacheIndex);
+
+    /** The values of a file, paths are explicit (e.g. specific sequence items) */
+    typedef std::vector<std::pair<DICOMTagPath, std::string>> FindingsType;
+    typedef std::set<DICOMTagPath> TagPathSetType;
+
+    /**
+      \brief Set the file the index is loaded from and saved to.
+    */
+    void SetFileName(const std::string &fileName);
+    std::string GetFileName() const;
+
+    /**
+      \brief Replaces the entries by the ones in the file of the index. A missing file leaves the index empty.
+      \return false if the file exists but could not be read.
+    */
+    bool Load();
+
+    /**
+      \brief Writes the entries into the file of the index, if entries were added since the last Load() or
+      Save(). Does nothing if no file name is set.
+      \return false if the file could not be written.
+    */
+    bool Save();
+
+    /**
+      \brief Get the values of a file, if all paths were scanned for the current version of the file.
+    */
+    bool Lookup(const std::string &fileName, const TagPathSetType &paths, FindingsType &findings) const;
+
+    /**
+      \brief Add the values of a file that was scanned for the given paths.
+      Values of other paths of an entry of the same version of the file are kept.
+    */
+    void Insert(const std::string &fileName, const TagPathSetType &paths, const FindingsType &findings);
+
+    void Clear();
+
+    std::size_t GetNumberOfEntries() const;
+
+    /**
+      \brief The index used by all tag scanners that have no index of their own, nullptr by default.
+    */
+    static DICOMPersistentTagCacheIndex::Pointer GetGlobalIndex();
+    static void SetGlobalIndex(DICOMPersistentTagCacheIndex *index);
+
+  protected:
+    DICOMPersistentTagCacheIndex();
+    ~DICOMPersistentTagCacheIndex() override;
+
+  private:
+    struct Entry
+    {
+      long long ModificationTime;
+      unsigned long long Size;
+      TagPathSetType ScannedPaths;
+      FindingsType Findings;
+    };
+
+    /** Returns false if the file does not exist */
+    static bool GetFileVersion(const std::string &fileName, long long &modificationTime, unsigned long long &size);
+
+    mutable std::mutex m_Mutex;
+    std::string m_FileName;
+    std::map<std::string, Entry> m_Entries;
+    bool m_Changed;
+
+    static std::mutex s_GlobalIndexMutex;
+    static DICOMPersistentTagCacheIndex::Pointer s_GlobalIndex;
+
+    DICOMPersistentTagCacheIndex(const DICOMPersistentTagCacheIndex &);
+  };
+}
+
+#endif
@@ -0,0 +1,106 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkDICOMProgressiveImageLoader_h
+#define mitkDICOMProgressiveImageLoader_h
+
+#include <itkObjectFactory.h>
+#include <mitkCommon.h>
+#include <mitkImage.h>
+
+#include "mitkDICOMEnums.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include <MitkDICOMReaderExports.h>
+
+namespace mitk
+{
+
+  /**
+    \ingroup DICOMReaderModule
+    \brief Loads the slices of a 3D DICOM series in a background thread into an image that is available immediately.
+
+    Initialize() creates the image with the geometry of the series and an empty (zero) buffer. Start()
+    decodes the central slice, so e.g. the level window can be guessed, and continues with the other
+    slices from the center outwards in a background thread. IsSliceLoaded() reflects the progress.
+
+    While loading, the image is marked modified and a render update is requested at most every
+    250 ms. Observers of the image are called from the loading thread in this case.
+
+    Only series of single-frame files with the same pixel type are supported, Initialize() returns
+    false otherwise. Loaders are kept alive until they finished, loaders that still run when the
+    application shuts down are cancelled.
+  */
+  class MITKDICOMREADER_EXPORT DICOMProgressiveImageLoader : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(DICOMProgressiveImageLoader, itk::Object);
+    itkFactorylessNewMacro(DICOMProgressiveImageLoader);
+
+    /**
+      \brief Creates the image for the sorted files of a 3D block, one file per slice.
+      \return false if the files cannot be loaded progressively.
+    */
+    bool Initialize(const StringList& filenames);
+
+    Image::Pointer GetImage() const;
+
+    /**
+      \brief Loads the central slice and starts loading the other slices in the background.
+    */
+    void Start();
+
+    /** \brief Stops loading after the current slice, slices that are not loaded stay empty. */
+    void Cancel();
+
+    /** \brief Blocks until all slices are loaded or loading was cancelled. */
+    void Wait();
+
+    bool IsSliceLoaded(unsigned int slice) const;
+    unsigned int GetNumberOfLoadedSlices() const;
+    bool IsFinished() const;
+
+    /** \brief Cancels all running loaders and waits for them. */
+    static void CancelAll();
+
+  protected:
+    DICOMProgressiveImageLoader();
+    ~DICOMProgressiveImageLoader() override;
+
+  private:
+    bool LoadSlice(unsigned int slice);
+    void LoadRemainingSlices();
+    void NotifyProgress(bool force);
+
+    StringList m_Filenames;
+    Image::Pointer m_Image;
+    char* m_Buffer;
+    std::size_t m_BytesPerSlice;
+    int m_ComponentType;
+    unsigned int m_NumberOfComponents;
+
+    std::unique_ptr<std::atomic<bool>[]> m_SliceIsLoaded;
+    std::atomic<unsigned int> m_NumberOfLoadedSlices;
+    std::atomic<bool> m_Cancelled;
+    std::atomic<bool> m_Finished;
+    std::thread m_Thread;
+    std::chrono::steady_clock::time_point m_LastNotification;
+
+    DICOMProgressiveImageLoader(const DICOMProgressiveImageLoader &);
+  };
+}
+
+#endif
@@ -13,6 +13,7 @@ found in the LICENSE file.
 #ifndef mitkDICOMTagScanner_h
 #define mitkDICOMTagScanner_h
 
+#include <functional>
 #include <stack>
 #include "itkMutexLock.h"
 
@@ -20,6 +21,7 @@ found in the LICENSE file.
 #include "mitkDICOMTagPath.h"
 #include "mitkDICOMTagCache.h"
 #include "mitkDICOMDatasetAccessingImageFrameInfo.h"
+#include "mitkDICOMPersistentTagCacheIndex.h"
 
 namespace mitk
 {
@@ -38,6 +40,10 @@ namespace mitk
     @remark When used in a process where multiple classes will access the scan
     results, care should be taken that all the tags and files of interest
     are communicated to DICOMTagScanner before requesting the results!
+
+    Larger sets of files are scanned by several threads. The results are
+    independent of the number of threads, they are always in the order of
+    the input files.
   */
   class MITKDICOMREADER_EXPORT DICOMTagScanner : public itk::Object
   {
@@ -86,8 +92,35 @@ namespace mitk
       */
       virtual DICOMTagCache::Pointer GetScanCache() const = 0;
 
+      /**
+        \brief Set the number of threads that scan the files, 0 (default) uses one thread per core.
+        Scanning is mostly limited by reading the files, so more threads than cores
+        may help for files on network storage.
+      */
+      itkSetMacro(NumberOfThreads, unsigned int);
+      itkGetConstMacro(NumberOfThreads, unsigned int);
+
+      /**
+        \brief Set the index of tag values that is consulted before a file is parsed.
+        If no index is set, DICOMPersistentTagCacheIndex::GetGlobalIndex() is used.
+      */
+      itkSetObjectMacro(PersistentTagCacheIndex, DICOMPersistentTagCacheIndex);
+      itkGetObjectMacro(PersistentTagCacheIndex, DICOMPersistentTagCacheIndex);
+
     protected:
 
+      /**
+      \brief Calls scanFiles for consecutive ranges [begin, end) of the numberOfFiles input files.
+      The ranges are distributed to worker threads, unless there are only a few files. Then
+      scanFiles is called once for all files in the calling thread. The first exception thrown
+      by scanFiles is rethrown after all workers finished.
+      */
+      void ScanInParallel(std::size_t numberOfFiles,
+                          const std::function<void(std::size_t begin, std::size_t end)> &scanFiles) const;
+
+      /** \brief Returns the index of this scanner or the global index, may be nullptr */
+      DICOMPersistentTagCacheIndex::Pointer GetEffectivePersistentTagCacheIndex() const;
+
       /** \brief Return active C locale */
       static std::string GetActiveLocale();
       /**
@@ -104,6 +137,9 @@ namespace mitk
       DICOMTagScanner();
       ~DICOMTagScanner() override;
 
+      unsigned int m_NumberOfThreads;
+      DICOMPersistentTagCacheIndex::Pointer m_PersistentTagCacheIndex;
+
     private:
 
       static itk::MutexLock::Pointer s_LocaleMutex;
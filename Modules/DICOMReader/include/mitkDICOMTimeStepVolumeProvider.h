@@ -0,0 +1,74 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkDICOMTimeStepVolumeProvider_h
+#define mitkDICOMTimeStepVolumeProvider_h
+
+#include <itkObjectFactory.h>
+#include <mitkCommon.h>
+#include <mitkImageVolumeProvider.h>
+
+#include "mitkDICOMEnums.h"
+#include "mitkGantryTiltInformation.h"
+
+#include <vector>
+
+#include <MitkDICOMReaderExports.h>
+
+namespace mitk
+{
+
+  /**
+    \ingroup DICOMReaderModule
+    \brief Decodes the time steps of a 3D+t DICOM block when they are accessed for the first time.
+
+    Set as volume provider of a 3D+t image (see Image::SetVolumeProvider()), the provider loads the
+    files of a time step once Image::GetVolumeData() is called for a time step that is not set yet.
+    ThreeDnTDICOMSeriesReader uses this when time steps are loaded on demand
+    (see ThreeDnTDICOMSeriesReader::SetLoadTimeStepsOnDemand()).
+
+    Time steps are decoded like the time steps of a completely loaded block, i.e. with the same
+    gantry tilt correction.
+  */
+  class MITKDICOMREADER_EXPORT DICOMTimeStepVolumeProvider : public ImageVolumeProvider
+  {
+  public:
+    mitkClassMacro(DICOMTimeStepVolumeProvider, ImageVolumeProvider);
+    itkFactorylessNewMacro(DICOMTimeStepVolumeProvider);
+
+    typedef std::vector<StringList> FilenamesPerTimeStepType;
+
+    /**
+      \brief The sorted files of each time step and the tilt correction that is applied to them.
+    */
+    void SetTimeSteps(const FilenamesPerTimeStepType& filenamesPerTimeStep,
+                      bool correctTilt,
+                      const GantryTiltInformation& tiltInfo);
+
+    const FilenamesPerTimeStepType& GetFilenamesPerTimeStep() const;
+
+    bool ProvideVolume(const Image* image, int t, int n, void* buffer) override;
+
+  protected:
+    DICOMTimeStepVolumeProvider();
+    ~DICOMTimeStepVolumeProvider() override;
+
+  private:
+    FilenamesPerTimeStepType m_FilenamesPerTimeStep;
+    bool m_CorrectTilt;
+    GantryTiltInformation m_TiltInfo;
+
+    DICOMTimeStepVolumeProvider(const DICOMTimeStepVolumeProvider &);
+  };
+}
+
+#endif
@@ -19,6 +19,8 @@ found in the LICENSE file.
 
 #include <itkGDCMImageIO.h>
 
+#include <functional>
+
 /* Forward deceleration of an DCMTK class. Used in the txx but part of the interface.*/
 class OFDateTime;
 
@@ -36,9 +38,26 @@ class ITKDICOMSeriesReaderHelper
     typedef std::vector<std::string> StringContainer;
     typedef std::list<StringContainer> StringContainerList;
 
+    ITKDICOMSeriesReaderHelper();
+
+    /**
+      \brief Set the number of threads that decode the slices of a 3D volume, 0 (default) uses one thread per core.
+      Each thread reads whole files directly into the buffer of the volume.
+    */
+    void SetNumberOfThreads(unsigned int numberOfThreads);
+    unsigned int GetNumberOfThreads() const;
+
     Image::Pointer Load( const StringContainer& filenames, bool correctTilt, const GantryTiltInformation& tiltInfo );
     Image::Pointer Load3DnT( const StringContainerList& filenamesLists, bool correctTilt, const GantryTiltInformation& tiltInfo );
 
+    /**
+      \brief Like Load3DnT(), but only decodes the first time step. The other time steps are decoded
+      when they are accessed for the first time (see DICOMTimeStepVolumeProvider).
+    */
+    Image::Pointer Load3DnTOnDemand( const StringContainerList& filenamesLists,
+                                     bool correctTilt,
+                                     const GantryTiltInformation& tiltInfo );
+
     static bool CanHandleFile(const std::string& filename);
 
   private:
@@ -79,10 +98,44 @@ class ITKDICOMSeriesReaderHelper
     */
     static TimeGeometry::Pointer GenerateTimeGeometry(const BaseGeometry* templateGeometry, const TimeBoundsList& boundsList);
 
+    /** Row shift that undoes a gantry tilt: row y of slice z of the corrected volume is interpolated
+        at row y + z * RowShiftPerSlice - RowOffset of the slice as it was read. */
+    struct TiltShear
+    {
+      double RowShiftPerSlice;
+      double RowOffset;
+    };
+
+    /** Returns a copy of input with the gantry tilt corrected by shearing its slices in parallel. */
     template <typename ImageType>
     typename ImageType::Pointer
     FixUpTiltedGeometry( ImageType* input, const GantryTiltInformation& tiltInfo );
 
+    /** Allocates output with the geometry of input after the gantry tilt correction, i.e. with
+        additional rows for the shifted slices and the real z spacing, and returns the row shift. */
+    template <typename ImageType>
+    static TiltShear InitializeTiltCorrectedVolume( const ImageType* input,
+                                                    const GantryTiltInformation& tiltInfo,
+                                                    ImageType* output );
+
+    /** Copies the rows of one slice to the tilt corrected slice, shifted by rowOffset rows and linearly
+        interpolated between two rows. Rows outside of the input are filled with the minimum value. */
+    template <typename PixelType>
+    static void ShearSlice( const PixelType* inputSlice,
+                            std::size_t inputRows,
+                            PixelType* outputSlice,
+                            std::size_t outputRows,
+                            std::size_t columns,
+                            double rowOffset );
+
+    /** Number of threads that process the slices of a volume, see SetNumberOfThreads(). */
+    std::size_t GetNumberOfThreadsToUse() const;
+
+    /** Calls function for every slice index on numberOfThreads threads and rethrows the first exception. */
+    static void ForEachSliceInParallel( std::size_t numberOfSlices,
+                                        std::size_t numberOfThreads,
+                                        const std::function<void( std::size_t )>& function );
+
     template <typename PixelType>
     Image::Pointer
     LoadDICOMByITK( const StringContainer& filenames,
@@ -90,6 +143,24 @@ class ITKDICOMSeriesReaderHelper
                     const GantryTiltInformation& tiltInfo,
                     itk::GDCMImageIO::Pointer& io);
 
+    /** Reads the pixel data of an uncompressed single-frame CT, MR or PET file directly into output,
+        applying the rescale slope and intercept like GDCM does. Returns false if the file has to be
+        decoded by GDCM (e.g. compressed data, color images or stored values that need bit operations). */
+    static bool ReadUncompressedSlice( const std::string& filename,
+                                       unsigned int columns,
+                                       unsigned int rows,
+                                       int outputComponentType,
+                                       void* output );
+
+    /** Decodes one file per slice into a new volume with the information of the image series reader.
+        With correctTilt, every slice is sheared into the tilt corrected volume right after it is decoded.
+        Returns nullptr if the files are no single slices. */
+    template <typename ImageType>
+    typename ImageType::Pointer ReadSlicesInParallel( const StringContainer& filenames,
+                                                      const ImageType* seriesInformation,
+                                                      bool correctTilt,
+                                                      const GantryTiltInformation& tiltInfo ) const;
+
     template <typename PixelType>
     Image::Pointer
     LoadDICOMByITK3DnT( const StringContainerList& filenames,
@@ -97,6 +168,7 @@ class ITKDICOMSeriesReaderHelper
                         const GantryTiltInformation& tiltInfo,
                         itk::GDCMImageIO::Pointer& io);
 
+    unsigned int m_NumberOfThreads;
 
 };
 
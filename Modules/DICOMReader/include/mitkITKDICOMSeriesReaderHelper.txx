@@ -12,14 +12,14 @@ found in the LICENSE file.
 
 #include "mitkITKDICOMSeriesReaderHelper.h"
 
+#include <itkImageFileReader.h>
 #include <itkImageSeriesReader.h>
-#include <itkResampleImageFilter.h>
-//#include <itkAffineTransform.h>
-//#include <itkLinearInterpolateImageFunction.h>
-//#include <itkTimeProbesCollectorBase.h>
 
 #include "dcmtk/ofstd/ofdatime.h"
 
+#include <algorithm>
+#include <vector>
+
 template <typename PixelType>
 mitk::Image::Pointer
 mitk::ITKDICOMSeriesReaderHelper
@@ -46,13 +46,22 @@ mitk::ITKDICOMSeriesReaderHelper
                              // see NormalDirectionConsistencySorter.
 
   reader->SetFileNames(filenames);
-  reader->Update();
-  typename ImageType::Pointer readVolume = reader->GetOutput();
 
-  // if we detected that the images are from a tilted gantry acquisition, we need to push some pixels into the right position
-  if (correctTilt)
+  // the series reader decodes one file after the other, so it only provides the geometry
+  // and the slices are decoded in parallel if possible
+  reader->UpdateOutputInformation();
+  typename ImageType::Pointer readVolume = this->ReadSlicesInParallel(filenames, reader->GetOutput(), correctTilt, tiltInfo);
+
+  if (readVolume.IsNull())
   {
-    readVolume = FixUpTiltedGeometry( reader->GetOutput(), tiltInfo );
+    reader->Update();
+    readVolume = reader->GetOutput();
+
+    // if we detected that the images are from a tilted gantry acquisition, we need to push some pixels into the right position
+    if (correctTilt)
+    {
+      readVolume = FixUpTiltedGeometry( readVolume.GetPointer(), tiltInfo );
+    }
   }
 
   image->InitializeByItk(readVolume.GetPointer());
@@ -72,6 +81,101 @@ mitk::ITKDICOMSeriesReaderHelper
   return image;
 }
 
+template <typename ImageType>
+typename ImageType::Pointer
+mitk::ITKDICOMSeriesReaderHelper
+::ReadSlicesInParallel( const StringContainer& filenames,
+                        const ImageType* seriesInformation,
+                        bool correctTilt,
+                        const GantryTiltInformation& tiltInfo ) const
+{
+  typedef typename ImageType::PixelType PixelType;
+  typedef typename itk::NumericTraits<PixelType>::ValueType ComponentType;
+  typedef itk::ImageFileReader<ImageType> SliceReaderType;
+
+  const typename ImageType::SizeType size = seriesInformation->GetLargestPossibleRegion().GetSize();
+  const std::size_t numberOfThreads = std::min(this->GetNumberOfThreadsToUse(), filenames.size());
+
+  // multi-frame files are left to the series reader
+  if ( numberOfThreads < 2 || size[2] != filenames.size() )
+  {
+    return nullptr;
+  }
+
+  typename ImageType::Pointer volume = ImageType::New();
+  TiltShear tiltShear = { 0.0, 0.0 };
+  if ( correctTilt )
+  {
+    tiltShear = InitializeTiltCorrectedVolume( seriesInformation, tiltInfo, volume.GetPointer() );
+  }
+  else
+  {
+    volume->CopyInformation( seriesInformation );
+    volume->SetRegions( seriesInformation->GetLargestPossibleRegion() );
+    volume->Allocate();
+  }
+
+  const std::size_t pixelsPerSlice = size[0] * size[1];
+  const std::size_t outputRows = volume->GetLargestPossibleRegion().GetSize()[1];
+  PixelType* buffer = volume->GetBufferPointer();
+
+  auto decodeSlice = [&]( std::size_t z, PixelType* slice ) {
+    if ( sizeof( ComponentType ) == sizeof( PixelType )
+         && ReadUncompressedSlice( filenames[z], size[0], size[1],
+                                   itk::ImageIOBase::MapPixelType<ComponentType>::CType, slice ) )
+    {
+      return;
+    }
+
+    // GDCMImageIO is not thread-safe, every slice gets its own
+    itk::GDCMImageIO::Pointer io = itk::GDCMImageIO::New();
+    io->SetFileName( filenames[z].c_str() );
+    io->ReadImageInformation();
+
+    if ( io->GetDimensions( 0 ) != size[0] || io->GetDimensions( 1 ) != size[1]
+         || ( io->GetNumberOfDimensions() > 2 && io->GetDimensions( 2 ) != 1 ) )
+    {
+      mitkThrow() << "Size of slice " << filenames[z] << " differs from the first slice of the series.";
+    }
+
+    if ( io->GetComponentType() == itk::ImageIOBase::MapPixelType<ComponentType>::CType
+         && io->GetNumberOfComponents() * sizeof( ComponentType ) == sizeof( PixelType ) )
+    {
+      io->Read( slice );
+    }
+    else
+    {
+      // the pixel type differs from the first slice (e.g. due to rescaling), let ITK convert it
+      typename SliceReaderType::Pointer sliceReader = SliceReaderType::New();
+      sliceReader->SetImageIO( io );
+      sliceReader->SetFileName( filenames[z] );
+      sliceReader->Update();
+      const PixelType* sliceBuffer = sliceReader->GetOutput()->GetBufferPointer();
+      std::copy( sliceBuffer, sliceBuffer + pixelsPerSlice, slice );
+    }
+  };
+
+  ForEachSliceInParallel( filenames.size(), numberOfThreads, [&]( std::size_t z ) {
+    if ( !correctTilt )
+    {
+      decodeSlice( z, buffer + z * pixelsPerSlice );
+      return;
+    }
+
+    // with gantry tilt, the slice is decoded into a buffer of its own and sheared into the volume right away
+    std::vector<PixelType> tiltedSlice( pixelsPerSlice );
+    decodeSlice( z, tiltedSlice.data() );
+    ShearSlice( tiltedSlice.data(),
+                size[1],
+                buffer + z * size[0] * outputRows,
+                outputRows,
+                size[0],
+                z * tiltShear.RowShiftPerSlice - tiltShear.RowOffset );
+  } );
+
+  return volume;
+}
+
 #define MITK_DEBUG_OUTPUT_FILELIST(list)\
   MITK_DEBUG << "-------------------------------------------"; \
   for (StringContainer::const_iterator _iter = (list).cbegin(); _iter!=(list).cend(); ++_iter) \
@@ -178,95 +282,68 @@ typename ImageType::Pointer
 mitk::ITKDICOMSeriesReaderHelper
 ::FixUpTiltedGeometry( ImageType* input, const GantryTiltInformation& tiltInfo )
 {
-  typedef itk::ResampleImageFilter<ImageType,ImageType> ResampleFilterType;
-  typename ResampleFilterType::Pointer resampler = ResampleFilterType::New();
-  resampler->SetInput( input );
+  typedef typename ImageType::PixelType PixelType;
 
-  /*
-     Transform for a point is
-      - transform from actual position to index coordinates
-      - apply a shear that undoes the gantry tilt
-      - transform back into world coordinates
+  typename ImageType::Pointer result = ImageType::New();
+  const TiltShear tiltShear = InitializeTiltCorrectedVolume( input, tiltInfo, result.GetPointer() );
 
-     Anybody who does this in a simpler way: don't forget to write up how and why your solution works
-  */
-  typedef itk::ScalableAffineTransform< double, ImageType::ImageDimension > TransformType;
-  typename TransformType::Pointer transformShear = TransformType::New();
+  const typename ImageType::SizeType inputSize = input->GetLargestPossibleRegion().GetSize();
+  const std::size_t outputRows = result->GetLargestPossibleRegion().GetSize()[1];
 
-  /**
-    - apply a shear and spacing correction to the image block that corrects the ITK reader's error
-      - ITK ignores the shear and loads slices into an orthogonal volume
-      - ITK calculates the spacing from the origin distance, which is more than the actual spacing with gantry tilt images
-    - to undo the effect
-      - we have calculated some information in tiltInfo:
-        - the shift in Y direction that is added with each additional slice is the most important information
-        - the Y-shift is calculated in mm world coordinates
-      - we apply a shearing transformation to the ITK-read image volume
-        - to do this locally,
-          - we transform the image volume back to origin and "normal" orientation by applying the inverse of its transform
-            (this brings us into the image's "index coordinate" system)
-          - we apply a shear with the Y-shift factor put into a unit transform at row 1, col 2
-          - we transform the image volume back to its actual position (from index to world coordinates)
-      - we lastly apply modify the image spacing in z direction by replacing this number with the correctly calulcated inter-slice distance
-  */
-
-  const ScalarType factor = tiltInfo.GetMatrixCoefficientForCorrectionInWorldCoordinates() / input->GetSpacing()[1];
-  // row 1, column 2 corrects shear in parallel to Y axis, proportional to distance in Z direction
-  transformShear->Shear( 1, 2, factor );
-
-  typename TransformType::Pointer imageIndexToWorld = TransformType::New();
-  imageIndexToWorld->SetOffset( input->GetOrigin().GetVectorFromOrigin() );
-
-  typename TransformType::MatrixType indexToWorldMatrix;
-  indexToWorldMatrix = input->GetDirection();
-
-  typename ImageType::DirectionType scale;
-  for ( unsigned int i = 0; i < ImageType::ImageDimension; i++ )
+  // all dimensions above z (i.e. time for 3D+t) are handled like further slices
+  std::size_t numberOfSlices = 1;
+  for ( unsigned int i = 2; i < ImageType::ImageDimension; ++i )
   {
-    scale[i][i] = input->GetSpacing()[i];
+    numberOfSlices *= inputSize[i];
   }
-  indexToWorldMatrix *= scale;
-
-  imageIndexToWorld->SetMatrix( indexToWorldMatrix );
 
-  typename TransformType::Pointer imageWorldToIndex = TransformType::New();
-  imageIndexToWorld->GetInverse( imageWorldToIndex );
+  const PixelType* inputBuffer = input->GetBufferPointer();
+  PixelType* outputBuffer = result->GetBufferPointer();
+  const std::size_t threads = std::min( this->GetNumberOfThreadsToUse(), numberOfSlices );
 
-  typename TransformType::Pointer gantryTiltCorrection = TransformType::New();
-  gantryTiltCorrection->Compose( imageWorldToIndex );
-  gantryTiltCorrection->Compose( transformShear );
-  gantryTiltCorrection->Compose( imageIndexToWorld );
+  ForEachSliceInParallel( numberOfSlices, threads, [&]( std::size_t slice ) {
+    const std::size_t z = slice % inputSize[2];
+    ShearSlice( inputBuffer + slice * inputSize[0] * inputSize[1],
+                inputSize[1],
+                outputBuffer + slice * inputSize[0] * outputRows,
+                outputRows,
+                inputSize[0],
+                z * tiltShear.RowShiftPerSlice - tiltShear.RowOffset );
+  } );
 
-  resampler->SetTransform( gantryTiltCorrection );
+  return result;
+}
 
-  typedef itk::LinearInterpolateImageFunction< ImageType, double > InterpolatorType;
-  typename InterpolatorType::Pointer interpolator = InterpolatorType::New();
-  resampler->SetInterpolator( interpolator );
+template <typename ImageType>
+typename mitk::ITKDICOMSeriesReaderHelper::TiltShear
+mitk::ITKDICOMSeriesReaderHelper
+::InitializeTiltCorrectedVolume( const ImageType* input, const GantryTiltInformation& tiltInfo, ImageType* output )
+{
   /*
-     This would be the right place to invent a meaningful value for positions outside of the image.
-     For CT, HU -1000 might be meaningful, but a general solution seems not possible. Even for CT,
-     -1000 would only look natural for many not all images.
+    - ITK ignores the shear and loads slices into an orthogonal volume
+    - ITK calculates the spacing from the origin distance, which is more than the actual spacing with gantry tilt images
+    - to undo the effect
+      - we have calculated some information in tiltInfo:
+        - the shift in Y direction that is added with each additional slice is the most important information
+        - the Y-shift is calculated in mm world coordinates
+      - in index coordinates, the correction is a shear that shifts the rows of slice z by z times the Y-shift,
+        so every slice can be corrected on its own by moving its rows (see ShearSlice)
+      - the corrected volume needs additional rows to accomodate the shifted slices
+      - we lastly replace the spacing in z direction by the correctly calculated inter-slice distance
   */
+  typename ImageType::SizeType size = input->GetLargestPossibleRegion().GetSize();
+  const double imageSizeZ = size[2];
+  const double additionalSize = tiltInfo.GetTiltCorrectedAdditionalSize( imageSizeZ );
+  const double ySpacing = input->GetSpacing()[1];
 
-  // TODO use (0028,0120) Pixel Padding Value if present
-  resampler->SetDefaultPixelValue( itk::NumericTraits< typename ImageType::PixelType >::min() );
-
-  // adjust size in Y direction! (maybe just transform the outer last pixel to see how much space we would need
-
-  resampler->SetOutputParametersFromImage( input ); // we basically need the same image again, just sheared
+  TiltShear tiltShear;
+  tiltShear.RowShiftPerSlice = tiltInfo.GetMatrixCoefficientForCorrectionInWorldCoordinates() / ySpacing;
+  tiltShear.RowOffset = 0.0;
 
+  size[1] += static_cast<typename ImageType::SizeType::SizeValueType>( additionalSize / ySpacing + 2.0 );
 
   // if tilt positive, then we need additional pixels BELOW origin, otherwise we need pixels behind the end of the block
-
-  // in any case we need more size to accomodate shifted slices
-  typename ImageType::SizeType largerSize = resampler->GetSize(); // now the resampler already holds the input image's size.
-  const double imageSizeZ = largerSize[2];
-  //MITK_DEBUG <<"Calculate lager size = " << largerSize[1] << " + " << tiltInfo.GetTiltCorrectedAdditionalSize(imageSizeZ) << " / " << input->GetSpacing()[1] << "+ 2.0";
-  largerSize[1] += static_cast<typename ImageType::SizeType::SizeValueType>(tiltInfo.GetTiltCorrectedAdditionalSize(imageSizeZ) / input->GetSpacing()[1]+ 2.0);
-  resampler->SetSize( largerSize );
-  //MITK_DEBUG << "Fix Y size of image w/ spacing " << input->GetSpacing()[1] << " from " << input->GetLargestPossibleRegion().GetSize()[1] << " to " << largerSize[1];
-
-  // in SOME cases this additional size is below/behind origin
+  typename ImageType::PointType origin = input->GetOrigin();
   if ( tiltInfo.GetMatrixCoefficientForCorrectionInWorldCoordinates() > 0.0 )
   {
     typename ImageType::DirectionType imageDirection = input->GetDirection();
@@ -276,27 +353,78 @@ mitk::ITKDICOMSeriesReaderHelper
     yDirection[2] = imageDirection[2][1];
     yDirection.Normalize();
 
-    typename ImageType::PointType shiftedOrigin;
-    shiftedOrigin = input->GetOrigin();
-
     // add some pixels to make everything fit
-    shiftedOrigin[0] -= yDirection[0] * (tiltInfo.GetTiltCorrectedAdditionalSize(imageSizeZ) + 1.0 * input->GetSpacing()[1]);
-    shiftedOrigin[1] -= yDirection[1] * (tiltInfo.GetTiltCorrectedAdditionalSize(imageSizeZ) + 1.0 * input->GetSpacing()[1]);
-    shiftedOrigin[2] -= yDirection[2] * (tiltInfo.GetTiltCorrectedAdditionalSize(imageSizeZ) + 1.0 * input->GetSpacing()[1]);
+    origin[0] -= yDirection[0] * ( additionalSize + 1.0 * ySpacing );
+    origin[1] -= yDirection[1] * ( additionalSize + 1.0 * ySpacing );
+    origin[2] -= yDirection[2] * ( additionalSize + 1.0 * ySpacing );
 
-    resampler->SetOutputOrigin( shiftedOrigin );
+    tiltShear.RowOffset = additionalSize / ySpacing + 1.0;
   }
 
-  resampler->Update();
-  typename ImageType::Pointer result = resampler->GetOutput();
-
   // ImageSeriesReader calculates z spacing as the distance between the first two origins.
   // This is not correct in case of gantry tilt, so we set our calculated spacing.
-  typename ImageType::SpacingType correctedSpacing = result->GetSpacing();
+  typename ImageType::SpacingType correctedSpacing = input->GetSpacing();
   correctedSpacing[2] = tiltInfo.GetRealZSpacing();
-  result->SetSpacing( correctedSpacing );
 
-  return result;
+  output->SetRegions( size );
+  output->SetOrigin( origin );
+  output->SetSpacing( correctedSpacing );
+  output->SetDirection( input->GetDirection() );
+  output->Allocate();
+
+  return tiltShear;
 }
 
+template <typename PixelType>
+void
+mitk::ITKDICOMSeriesReaderHelper
+::ShearSlice( const PixelType* inputSlice,
+              std::size_t inputRows,
+              PixelType* outputSlice,
+              std::size_t outputRows,
+              std::size_t columns,
+              double rowOffset )
+{
+  // RGB pixels are interpolated component-wise, so the rows are handled as arrays of components
+  typedef typename itk::NumericTraits<PixelType>::ValueType ComponentType;
+  const std::size_t componentsPerRow = columns * ( sizeof( PixelType ) / sizeof( ComponentType ) );
+  const ComponentType* input = reinterpret_cast<const ComponentType*>( inputSlice );
+  ComponentType* output = reinterpret_cast<ComponentType*>( outputSlice );
 
+  /*
+     This would be the right place to invent a meaningful value for positions outside of the image.
+     For CT, HU -1000 might be meaningful, but a general solution seems not possible. Even for CT,
+     -1000 would only look natural for many not all images.
+  */
+  // TODO use (0028,0120) Pixel Padding Value if present
+  const ComponentType outsideValue = itk::NumericTraits<ComponentType>::min();
+
+  for ( std::size_t y = 0; y < outputRows; ++y )
+  {
+    ComponentType* outputRow = output + y * componentsPerRow;
+    const double inputRow = y + rowOffset;
+
+    // like itk::LinearInterpolateImageFunction, which treats positions up to half a row outside as inside
+    if ( inputRow < -0.5 || inputRow >= inputRows - 0.5 )
+    {
+      std::fill( outputRow, outputRow + componentsPerRow, outsideValue );
+      continue;
+    }
+
+    const std::size_t baseRow = inputRow > 0.0 ? static_cast<std::size_t>( inputRow ) : 0;
+    const double weight = inputRow - baseRow;
+    const ComponentType* row0 = input + baseRow * componentsPerRow;
+
+    if ( weight <= 0.0 || baseRow + 1 >= inputRows )
+    {
+      std::copy( row0, row0 + componentsPerRow, outputRow );
+      continue;
+    }
+
+    const ComponentType* row1 = row0 + componentsPerRow;
+    for ( std::size_t i = 0; i < componentsPerRow; ++i )
+    {
+      outputRow[i] = static_cast<ComponentType>( row0[i] + ( static_cast<double>( row1[i] ) - row0[i] ) * weight );
+    }
+  }
+}
@@ -51,6 +51,13 @@ class MITKDICOMREADER_EXPORT ThreeDnTDICOMSeriesReader : public DICOMITKSeriesGD
     void SetGroup3DandT(bool on);
     bool GetGroup3DandT() const;
 
+    /**
+      \brief Control whether LoadImages() only decodes the first time step of 3D+t blocks.
+      The other time steps are decoded when they are accessed for the first time (see DICOMTimeStepVolumeProvider).
+    */
+    void SetLoadTimeStepsOnDemand(bool on);
+    bool GetLoadTimeStepsOnDemand() const;
+
     itkBooleanMacro(OnlyCondenseSameSeries);
     itkSetMacro(OnlyCondenseSameSeries, bool);
     itkGetConstMacro(OnlyCondenseSameSeries, bool);
@@ -89,6 +96,7 @@ class MITKDICOMREADER_EXPORT ThreeDnTDICOMSeriesReader : public DICOMITKSeriesGD
 
     bool m_Group3DandT;
     bool m_OnlyCondenseSameSeries;
+    bool m_LoadTimeStepsOnDemand;
 
     const static bool m_DefaultGroup3DandT = true;
     const static bool m_DefaultOnlyCondenseSameSeries = true;
@@ -21,6 +21,8 @@ found in the LICENSE file.
 #include <mitkDICOMProperty.h>
 #include "legacy/mitkDicomSeriesReader.h"
 #include <mitkDICOMDCMTKTagScanner.h>
+#include <mitkDICOMITKSeriesGDCMReader.h>
+#include <mitkThreeDnTDICOMSeriesReader.h>
 #include <mitkLocaleSwitch.h>
 #include "mitkIPropertyProvider.h"
 #include "mitkPropertyNameHelper.h"
@@ -33,15 +35,25 @@ found in the LICENSE file.
 
 namespace mitk
 {
+  const std::string BaseDICOMReaderService::PROGRESSIVE_LOADING_OPTION_NAME = "Load slices progressively";
+  const std::string BaseDICOMReaderService::LOAD_TIME_STEPS_ON_DEMAND_OPTION_NAME = "Load time steps on demand";
 
   BaseDICOMReaderService::BaseDICOMReaderService(const std::string& description)
     : AbstractFileReader(CustomMimeType(IOMimeTypes::DICOM_MIMETYPE()), description)
 {
+  Options defaultOptions;
+  defaultOptions[PROGRESSIVE_LOADING_OPTION_NAME] = false;
+  defaultOptions[LOAD_TIME_STEPS_ON_DEMAND_OPTION_NAME] = false;
+  this->SetDefaultOptions(defaultOptions);
 }
 
 BaseDICOMReaderService::BaseDICOMReaderService(const mitk::CustomMimeType& customType, const std::string& description)
   : AbstractFileReader(customType, description)
 {
+  Options defaultOptions;
+  defaultOptions[PROGRESSIVE_LOADING_OPTION_NAME] = false;
+  defaultOptions[LOAD_TIME_STEPS_ON_DEMAND_OPTION_NAME] = false;
+  this->SetDefaultOptions(defaultOptions);
 }
 
 void BaseDICOMReaderService::SetOnlyRegardOwnSeries(bool regard)
@@ -144,6 +156,22 @@ std::vector<itk::SmartPointer<BaseData> > BaseDICOMReaderService::Read()
 
           reader->SetTagCache(scanner->GetScanCache());
           reader->AnalyzeInputFiles();
+
+          // the images are returned right away and filled in the background
+          auto gdcmReader = dynamic_cast<DICOMITKSeriesGDCMReader*>(reader.GetPointer());
+          const us::Any progressiveLoading = this->GetOption(PROGRESSIVE_LOADING_OPTION_NAME);
+          if (nullptr != gdcmReader && !progressiveLoading.Empty() && progressiveLoading.Type() == typeid(bool))
+          {
+            gdcmReader->SetProgressiveLoading(us::any_cast<bool>(progressiveLoading));
+          }
+
+          auto threeDnTReader = dynamic_cast<ThreeDnTDICOMSeriesReader*>(reader.GetPointer());
+          const us::Any timeStepsOnDemand = this->GetOption(LOAD_TIME_STEPS_ON_DEMAND_OPTION_NAME);
+          if (nullptr != threeDnTReader && !timeStepsOnDemand.Empty() && timeStepsOnDemand.Type() == typeid(bool))
+          {
+            threeDnTReader->SetLoadTimeStepsOnDemand(us::any_cast<bool>(timeStepsOnDemand));
+          }
+
           reader->LoadImages();
 
           for (unsigned int i = 0; i < reader->GetNumberOfOutputs(); ++i)
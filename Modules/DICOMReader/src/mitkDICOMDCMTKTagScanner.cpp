@@ -13,9 +13,13 @@ found in the LICENSE file.
 #include "mitkDICOMDCMTKTagScanner.h"
 #include "mitkDICOMGenericImageFrameInfo.h"
 
+#include <mitkTracing.h>
+
 #include <dcmtk/dcmdata/dcfilefo.h>
 #include <dcmtk/dcmdata/dcpath.h>
 
+#include <vector>
+
 mitk::DICOMDCMTKTagScanner::DICOMDCMTKTagScanner()
 {
 }
@@ -98,62 +102,151 @@ mitk::DICOMTagPath DcmPathToTagPath(DcmPath * dcmpath)
   return result;
 }
 
-void mitk::DICOMDCMTKTagScanner::Scan()
+namespace
 {
-  this->PushLocale();
+  /** Returns the tag at which the parsing of a file can stop. This is the first tag after the
+  top level elements of all scanned paths, so pixel data and any other trailing elements are not
+  read. Returns DCM_UndefinedTagKey if a path starts with a wildcard.*/
+  DcmTagKey GetStopParsingTag(const std::set<mitk::DICOMTagPath> &paths)
+  {
+    DcmTagKey lastTag(0, 0);
+    for (const auto &path : paths)
+    {
+      if (path.IsEmpty() || path.GetFirstNode().type == mitk::DICOMTagPath::NodeInfo::NodeType::AnyElement)
+      {
+        return DCM_UndefinedTagKey;
+      }
 
-  try
+      const DcmTagKey tag(path.GetFirstNode().tag.GetGroup(), path.GetFirstNode().tag.GetElement());
+      if (lastTag < tag)
+      {
+        lastTag = tag;
+      }
+    }
+
+    if (lastTag.getElement() < 0xFFFF)
+    {
+      return DcmTagKey(lastTag.getGroup(), lastTag.getElement() + 1);
+    }
+    if (lastTag.getGroup() < 0xFFFF)
+    {
+      return DcmTagKey(lastTag.getGroup() + 1, 0);
+    }
+    return DCM_UndefinedTagKey;
+  }
+
+  /** Scans one file, returns nullptr if it cannot be read. The values are also added to findings.*/
+  mitk::DICOMGenericImageFrameInfo::Pointer ScanFile(const std::string &fileName,
+                                                     const std::set<mitk::DICOMTagPath> &paths,
+                                                     const DcmTagKey &stopParsingTag,
+                                                     DcmPathProcessor &processor,
+                                                     mitk::DICOMPersistentTagCacheIndex::FindingsType &findings)
   {
-    DcmPathProcessor processor;
-    processor.setItemWildcardSupport(true);
+    DcmFileFormat dfile;
+    OFCondition cond = dfile.loadFileUntilTag(
+      fileName.c_str(), EXS_Unknown, EGL_noChange, DCM_MaxReadLength, ERM_autoDetect, stopParsingTag);
+    if (cond.bad())
+    {
+      return nullptr;
+    }
 
-    DICOMGenericTagCache::Pointer newCache = DICOMGenericTagCache::New();
+    mitk::DICOMGenericImageFrameInfo::Pointer info = mitk::DICOMGenericImageFrameInfo::New(fileName);
 
-    for (const auto& fileName : this->m_InputFilenames)
+    for (const auto& path : paths)
     {
-      DcmFileFormat dfile;
-      OFCondition cond = dfile.loadFile(fileName.c_str());
-      if (cond.bad())
+      std::string tagPath = mitk::DICOMTagPathToDCMTKSearchPath(path);
+      cond = processor.findOrCreatePath(dfile.getDataset(), tagPath.c_str());
+      if (cond.good())
       {
-        MITK_ERROR << "Error when scanning for tags. Cannot open given file. File: " << fileName;
+        OFList< DcmPath * > results;
+        processor.getResults(results);
+        for (const auto& finding : results)
+        {
+          auto element = dynamic_cast<DcmElement*>(finding->back()->m_obj);
+          if (!element)
+          {
+            auto item = dynamic_cast<DcmItem*>(finding->back()->m_obj);
+            if (item)
+            {
+              element = item->getElement(finding->back()->m_itemNo);
+            }
+          }
+
+          if (element)
+          {
+            OFString value;
+            cond = element->getOFStringArray(value);
+            if (cond.good())
+            {
+              const mitk::DICOMTagPath valuePath = DcmPathToTagPath(finding);
+              info->SetTagValue(valuePath, std::string(value.c_str()));
+              findings.emplace_back(valuePath, std::string(value.c_str()));
+            }
+          }
+        }
       }
-      else
+    }
+
+    return info;
+  }
+}
+
+void mitk::DICOMDCMTKTagScanner::Scan()
+{
+  MITK_TRACE_SCOPE("DICOM", "DICOMDCMTKTagScanner::Scan");
+  this->PushLocale();
+
+  try
+  {
+    const DcmTagKey stopParsingTag = GetStopParsingTag(this->m_ScannedTags);
+    const DICOMPersistentTagCacheIndex::Pointer index = this->GetEffectivePersistentTagCacheIndex();
+
+    // every file has its own slot, so the results keep the order of the input files
+    std::vector<DICOMGenericImageFrameInfo::Pointer> infos(this->m_InputFilenames.size());
+
+    this->ScanInParallel(this->m_InputFilenames.size(), [&](std::size_t begin, std::size_t end) {
+      DcmPathProcessor processor;
+      processor.setItemWildcardSupport(true);
+
+      for (std::size_t i = begin; i < end; ++i)
       {
-        DICOMGenericImageFrameInfo::Pointer info = DICOMGenericImageFrameInfo::New(fileName);
+        const std::string& fileName = this->m_InputFilenames[i];
+        DICOMPersistentTagCacheIndex::FindingsType findings;
 
-        for (const auto& path : this->m_ScannedTags)
+        if (index.IsNotNull() && index->Lookup(fileName, this->m_ScannedTags, findings))
         {
-          std::string tagPath = DICOMTagPathToDCMTKSearchPath(path);
-          cond = processor.findOrCreatePath(dfile.getDataset(), tagPath.c_str());
-          if (cond.good())
+          infos[i] = DICOMGenericImageFrameInfo::New(fileName);
+          for (const auto& finding : findings)
           {
-            OFList< DcmPath * > findings;
-            processor.getResults(findings);
-            for (const auto& finding : findings)
-            {
-              auto element = dynamic_cast<DcmElement*>(finding->back()->m_obj);
-              if (!element)
-              {
-                auto item = dynamic_cast<DcmItem*>(finding->back()->m_obj);
-                if (item)
-                {
-                  element = item->getElement(finding->back()->m_itemNo);
-                }
-              }
-
-              if (element)
-              {
-                OFString value;
-                cond = element->getOFStringArray(value);
-                if (cond.good())
-                {
-                  info->SetTagValue(DcmPathToTagPath(finding), std::string(value.c_str()));
-                }
-              }
-            }
+            infos[i]->SetTagValue(finding.first, finding.second);
           }
+          continue;
+        }
+
+        infos[i] = ScanFile(fileName, this->m_ScannedTags, stopParsingTag, processor, findings);
+        if (index.IsNotNull() && infos[i].IsNotNull())
+        {
+          index->Insert(fileName, this->m_ScannedTags, findings);
         }
-        newCache->AddFrameInfo(info);
+      }
+    });
+
+    if (index.IsNotNull())
+    {
+      index->Save();
+    }
+
+    DICOMGenericTagCache::Pointer newCache = DICOMGenericTagCache::New();
+
+    for (std::size_t i = 0; i < infos.size(); ++i)
+    {
+      if (infos[i].IsNull())
+      {
+        MITK_ERROR << "Error when scanning for tags. Cannot open given file. File: " << this->m_InputFilenames[i];
+      }
+      else
+      {
+        newCache->AddFrameInfo(infos[i]);
       }
     }
 
@@ -20,8 +20,15 @@ found in the LICENSE file.
 #include <usModuleResourceStream.h>
 #include <usModule.h>
 
+#include <algorithm>
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
 mitk::DICOMFileReaderSelector
 ::DICOMFileReaderSelector()
+: m_NumberOfThreads(0)
 {
 }
 
@@ -178,6 +185,20 @@ mitk::DICOMFileReaderSelector
   return m_InputFilenames;
 }
 
+void
+mitk::DICOMFileReaderSelector
+::SetNumberOfThreads(unsigned int numberOfThreads)
+{
+  m_NumberOfThreads = numberOfThreads;
+}
+
+unsigned int
+mitk::DICOMFileReaderSelector
+::GetNumberOfThreads() const
+{
+  return m_NumberOfThreads;
+}
+
 mitk::DICOMFileReader::Pointer
 mitk::DICOMFileReaderSelector
 ::GetFirstReaderWithMinimumNumberOfOutputImages()
@@ -187,6 +208,7 @@ mitk::DICOMFileReaderSelector
   // do the tag scanning externally and just ONCE
   DICOMGDCMTagScanner::Pointer gdcmScanner = DICOMGDCMTagScanner::New();
   gdcmScanner->SetInputFiles( m_InputFilenames );
+  gdcmScanner->SetNumberOfThreads( m_NumberOfThreads );
 
   // let all readers analyze the file set
   for ( auto rIter = m_Readers.cbegin(); rIter != m_Readers.cend(); ++rIter )
@@ -196,15 +218,72 @@ mitk::DICOMFileReaderSelector
 
   gdcmScanner->Scan();
 
-  // let all readers analyze the file set
+  // let all readers analyze the file set, the readers only share the (read-only) tag cache,
+  // so their sorting can run in parallel
+  std::vector<DICOMFileReader::Pointer> readers(m_Readers.cbegin(), m_Readers.cend());
+  std::vector<std::string> errors(readers.size());
+  std::vector<char> analyzed(readers.size(), 0);
+
+  std::set<DICOMFileReader*> uniqueReaders;
+  std::vector<std::size_t> readersToAnalyze;
+  for (std::size_t i = 0; i < readers.size(); ++i)
+  {
+    readers[i]->SetInputFiles( m_InputFilenames );
+    readers[i]->SetTagCache( gdcmScanner->GetScanCache() );
+    // a reader that was added twice must not analyze in two threads at once
+    if (uniqueReaders.insert(readers[i].GetPointer()).second)
+    {
+      readersToAnalyze.push_back(i);
+    }
+  }
+
+  std::atomic<std::size_t> nextReader(0);
+  auto analyze = [&]() {
+    for (std::size_t next = nextReader++; next < readersToAnalyze.size(); next = nextReader++)
+    {
+      const std::size_t i = readersToAnalyze[next];
+      try
+      {
+        readers[i]->AnalyzeInputFiles();
+        analyzed[i] = 1;
+      }
+      catch ( const std::exception& e )
+      {
+        errors[i] = std::string("exception during file analysis, ignoring this reader. Exception: ") + e.what();
+      }
+      catch (...)
+      {
+        errors[i] = "unknown exception during file analysis, ignoring this reader.";
+      }
+    }
+  };
+
+  const unsigned int maximumNumberOfThreads =
+    m_NumberOfThreads > 0 ? m_NumberOfThreads : std::max(1u, std::thread::hardware_concurrency());
+  const std::size_t numberOfThreads = std::min<std::size_t>(maximumNumberOfThreads, readersToAnalyze.size());
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1; i < numberOfThreads; ++i)
+  {
+    threads.emplace_back(analyze);
+  }
+  analyze();
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  // evaluate the results in the order of preference
   unsigned int readerIndex(0);
-  for ( auto rIter = m_Readers.cbegin(); rIter != m_Readers.cend(); ++readerIndex, ++rIter )
+  std::set<DICOMFileReader*> evaluatedReaders;
+  for ( auto rIter = readers.cbegin(); rIter != readers.cend(); ++readerIndex, ++rIter )
   {
-    (*rIter)->SetInputFiles( m_InputFilenames );
-    (*rIter)->SetTagCache( gdcmScanner->GetScanCache() );
-    try
+    if (!evaluatedReaders.insert((*rIter).GetPointer()).second)
+    {
+      continue;
+    }
+
+    if (analyzed[readerIndex])
     {
-      (*rIter)->AnalyzeInputFiles();
       workingCandidates.push_back( *rIter );
       MITK_INFO << "Reader " << readerIndex << " (" << (*rIter)->GetConfigurationLabel() << ") suggests " << (*rIter)->GetNumberOfOutputs() << " 3D blocks";
       if ((*rIter)->GetNumberOfOutputs() == 1)
@@ -213,13 +292,9 @@ mitk::DICOMFileReaderSelector
         return *rIter;
       }
     }
-    catch ( const std::exception& e )
+    else
     {
-      MITK_ERROR << "Reader " << readerIndex << " (" << (*rIter)->GetConfigurationLabel() << ") threw exception during file analysis, ignoring this reader. Exception: " << e.what();
-    }
-    catch (...)
-    {
-      MITK_ERROR << "Reader " << readerIndex << " (" << (*rIter)->GetConfigurationLabel() << ") threw unknown exception during file analysis, ignoring this reader.";
+      MITK_ERROR << "Reader " << readerIndex << " (" << (*rIter)->GetConfigurationLabel() << ") threw " << errors[readerIndex];
     }
   }
 
@@ -241,6 +316,12 @@ mitk::DICOMFileReaderSelector
     }
   }
 
+  // none of the readers produces output, e.g. for structured reports
+  if (bestReader.IsNull())
+  {
+    return bestReader;
+  }
+
   MITK_DEBUG << "Decided for reader #" << bestReaderIndex << " (" << bestReader->GetConfigurationLabel() << ")";
   MITK_DEBUG << m_PossibleConfigurations[bestReaderIndex];
 
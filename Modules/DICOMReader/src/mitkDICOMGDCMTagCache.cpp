@@ -82,23 +82,69 @@ mitk::DICOMDatasetAccessingImageFrameList mitk::DICOMGDCMTagCache::GetFrameInfoL
 
 void
 mitk::DICOMGDCMTagCache::InitCache(const std::set<DICOMTag>& scannedTags, const std::shared_ptr<gdcm::Scanner>& scanner, const StringList& inputFiles)
+{
+  this->InitCache(scannedTags, std::vector<std::shared_ptr<gdcm::Scanner>>(1, scanner), inputFiles);
+}
+
+void
+mitk::DICOMGDCMTagCache::InitCache(const std::set<DICOMTag>& scannedTags,
+                                   const std::vector<std::shared_ptr<gdcm::Scanner>>& scanners,
+                                   const StringList& inputFiles)
+{
+  const std::map<std::string, DICOMPersistentTagCacheIndex::FindingsType> noCachedFindings;
+  this->InitCache(scannedTags, scanners, noCachedFindings, inputFiles);
+}
+
+void
+mitk::DICOMGDCMTagCache::InitCache(const std::set<DICOMTag>& scannedTags,
+                                   const std::vector<std::shared_ptr<gdcm::Scanner>>& scanners,
+                                   const std::map<std::string,
+                                                  DICOMPersistentTagCacheIndex::FindingsType>& cachedFindings,
+                                   const StringList& inputFiles)
 {
   m_ScannedTags = scannedTags;
   m_InputFilenames = inputFiles;
-  m_Scanner = scanner;
+  m_Scanners = scanners;
+  m_CachedValues = std::make_shared<std::set<std::string>>();
 
   m_ScanResult.clear();
   m_ScanResult.reserve(m_InputFilenames.size());
 
   for (auto inputIter = m_InputFilenames.cbegin(); inputIter != m_InputFilenames.cend(); ++inputIter)
   {
-    m_ScanResult.push_back(DICOMGDCMImageFrameInfo::New(DICOMImageFrameInfo::New(*inputIter, 0),
-      m_Scanner->GetMapping(inputIter->c_str())).GetPointer());
+    gdcm::Scanner::TagToValue mapping;
+
+    const auto cached = cachedFindings.find(*inputIter);
+    if (cached != cachedFindings.cend())
+    {
+      for (const auto& finding : cached->second)
+      {
+        if (finding.first.Size() == 1)
+        {
+          const DICOMTag& tag = finding.first.GetFirstNode().tag;
+          mapping[gdcm::Tag(tag.GetGroup(), tag.GetElement())] = m_CachedValues->insert(finding.second).first->c_str();
+        }
+      }
+    }
+    else
+    {
+      // files that could not be read are unknown to all scanners and get the empty mapping
+      for (const auto& scanner : m_Scanners)
+      {
+        if (scanner->IsKey(inputIter->c_str()))
+        {
+          mapping = scanner->GetMapping(inputIter->c_str());
+          break;
+        }
+      }
+    }
+
+    m_ScanResult.push_back(DICOMGDCMImageFrameInfo::New(DICOMImageFrameInfo::New(*inputIter, 0), mapping).GetPointer());
   }
 }
 
 const gdcm::Scanner&
 mitk::DICOMGDCMTagCache::GetScanner() const
 {
-  return *(this->m_Scanner);
+  return *(this->m_Scanners.front());
 }
@@ -14,8 +14,13 @@ found in the LICENSE file.
 #include "mitkDICOMGDCMTagCache.h"
 #include "mitkDICOMGDCMImageFrameInfo.h"
 
+#include <mitkTracing.h>
+
 #include <gdcmScanner.h>
 
+#include <map>
+#include <mutex>
+
 mitk::DICOMGDCMTagScanner::DICOMGDCMTagScanner()
 {
   m_GDCMScanner = std::make_shared<gdcm::Scanner>();
@@ -92,11 +97,103 @@ void mitk::DICOMGDCMTagScanner::SetInputFiles( const StringList& filenames )
 
 void mitk::DICOMGDCMTagScanner::Scan()
 {
+  MITK_TRACE_SCOPE("DICOM", "DICOMGDCMTagScanner::Scan");
   // TODO integrate push/pop locale??
-  m_GDCMScanner->Scan( m_InputFilenames );
+
+  // Files with an entry in the index are not read at all.
+  const DICOMPersistentTagCacheIndex::Pointer index = this->GetEffectivePersistentTagCacheIndex();
+  DICOMPersistentTagCacheIndex::TagPathSetType scannedPaths;
+  for (const auto& tag : m_ScannedTags)
+  {
+    scannedPaths.insert(DICOMTagPath(tag));
+  }
+
+  std::vector<DICOMPersistentTagCacheIndex::FindingsType> findings(m_InputFilenames.size());
+  std::vector<char> isCached(m_InputFilenames.size(), 0);
+  if (index.IsNotNull())
+  {
+    this->ScanInParallel(m_InputFilenames.size(), [&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        isCached[i] = index->Lookup(m_InputFilenames[i], scannedPaths, findings[i]);
+      }
+    });
+  }
+
+  std::map<std::string, DICOMPersistentTagCacheIndex::FindingsType> cachedFindings;
+  StringList filesToScan;
+  for (std::size_t i = 0; i < m_InputFilenames.size(); ++i)
+  {
+    if (isCached[i])
+    {
+      cachedFindings[m_InputFilenames[i]].swap(findings[i]);
+    }
+    else
+    {
+      filesToScan.push_back(m_InputFilenames[i]);
+    }
+  }
+
+  // gdcm::Scanner already stops reading each file after the last scanned tag.
+  // Parts of the files are scanned by separate scanners in parallel, sorted by
+  // their first file to keep the cache independent of the thread scheduling.
+  std::map<std::size_t, std::shared_ptr<gdcm::Scanner>> scanners;
+  std::mutex scannersMutex;
+
+  this->ScanInParallel(filesToScan.size(), [&](std::size_t begin, std::size_t end) {
+    std::shared_ptr<gdcm::Scanner> scanner = m_GDCMScanner;
+    if (begin != 0 || end != filesToScan.size())
+    {
+      scanner = std::make_shared<gdcm::Scanner>();
+      for (const auto& tag : m_ScannedTags)
+      {
+        scanner->AddTag(gdcm::Tag(tag.GetGroup(), tag.GetElement()));
+      }
+    }
+
+    scanner->Scan(gdcm::Directory::FilenamesType(filesToScan.begin() + begin, filesToScan.begin() + end));
+
+    if (index.IsNotNull())
+    {
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        if (!scanner->IsKey(filesToScan[i].c_str()))
+        {
+          continue;
+        }
+
+        DICOMPersistentTagCacheIndex::FindingsType fileFindings;
+        for (const auto& value : scanner->GetMapping(filesToScan[i].c_str()))
+        {
+          fileFindings.emplace_back(DICOMTagPath(value.first.GetGroup(), value.first.GetElement()),
+                                    value.second ? std::string(value.second) : std::string());
+        }
+        index->Insert(filesToScan[i], scannedPaths, fileFindings);
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(scannersMutex);
+    scanners[begin] = scanner;
+  });
+
+  std::vector<std::shared_ptr<gdcm::Scanner>> scannerList;
+  for (const auto& scanner : scanners)
+  {
+    scannerList.push_back(scanner.second);
+  }
+  if (scannerList.empty())
+  {
+    m_GDCMScanner->Scan(filesToScan);
+    scannerList.push_back(m_GDCMScanner);
+  }
+
+  if (index.IsNotNull())
+  {
+    index->Save();
+  }
 
   DICOMGDCMTagCache::Pointer newCache = DICOMGDCMTagCache::New();
-  newCache->InitCache(m_ScannedTags, m_GDCMScanner, m_InputFilenames);
+  newCache->InitCache(m_ScannedTags, scannerList, cachedFindings, m_InputFilenames);
 
   m_Cache = newCache;
 }
@@ -20,6 +20,14 @@ found in the LICENSE file.
 #include "mitkGantryTiltInformation.h"
 #include "mitkDICOMTagBasedSorter.h"
 #include "mitkDICOMGDCMTagScanner.h"
+#include "mitkDICOMProgressiveImageLoader.h"
+
+#include <mitkTracing.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 itk::MutexLock::Pointer mitk::DICOMITKSeriesGDCMReader::s_LocaleMutex = itk::MutexLock::New();
 
@@ -28,8 +36,10 @@ mitk::DICOMITKSeriesGDCMReader::DICOMITKSeriesGDCMReader( unsigned int decimalPl
 : DICOMFileReader()
 , m_FixTiltByShearing(m_DefaultFixTiltByShearing)
 , m_SimpleVolumeReading( simpleVolumeImport )
+, m_ProgressiveLoading( false )
 , m_DecimalPlacesForOrientation( decimalPlacesForOrientation )
 , m_ExternalCache(false)
+, m_NumberOfSliceDecodingThreads(0)
 {
   this->EnsureMandatorySortersArePresent( decimalPlacesForOrientation, simpleVolumeImport );
 }
@@ -38,6 +48,8 @@ mitk::DICOMITKSeriesGDCMReader::DICOMITKSeriesGDCMReader( unsigned int decimalPl
 mitk::DICOMITKSeriesGDCMReader::DICOMITKSeriesGDCMReader( const DICOMITKSeriesGDCMReader& other )
 : DICOMFileReader( other )
 , m_FixTiltByShearing( other.m_FixTiltByShearing)
+, m_SimpleVolumeReading( other.m_SimpleVolumeReading )
+, m_ProgressiveLoading( other.m_ProgressiveLoading )
 , m_SortingResultInProgress( other.m_SortingResultInProgress )
 , m_Sorter( other.m_Sorter )
 , m_EquiDistantBlocksSorter( other.m_EquiDistantBlocksSorter->Clone() )
@@ -47,6 +59,7 @@ mitk::DICOMITKSeriesGDCMReader::DICOMITKSeriesGDCMReader( const DICOMITKSeriesGD
 , m_DecimalPlacesForOrientation( other.m_DecimalPlacesForOrientation )
 , m_TagCache( other.m_TagCache )
 , m_ExternalCache(other.m_ExternalCache)
+, m_NumberOfSliceDecodingThreads(0)
 {
 }
 
@@ -61,6 +74,7 @@ mitk::DICOMITKSeriesGDCMReader& mitk::DICOMITKSeriesGDCMReader::
   {
     DICOMFileReader::operator                =( other );
     this->m_FixTiltByShearing                = other.m_FixTiltByShearing;
+    this->m_ProgressiveLoading               = other.m_ProgressiveLoading;
     this->m_SortingResultInProgress          = other.m_SortingResultInProgress;
     this->m_Sorter                           = other.m_Sorter; // TODO should clone the list items
     this->m_EquiDistantBlocksSorter          = other.m_EquiDistantBlocksSorter->Clone();
@@ -119,6 +133,16 @@ bool mitk::DICOMITKSeriesGDCMReader::GetFixTiltByShearing() const
   return m_FixTiltByShearing;
 }
 
+void mitk::DICOMITKSeriesGDCMReader::SetProgressiveLoading( bool on )
+{
+  m_ProgressiveLoading = on;
+}
+
+bool mitk::DICOMITKSeriesGDCMReader::GetProgressiveLoading() const
+{
+  return m_ProgressiveLoading;
+}
+
 void mitk::DICOMITKSeriesGDCMReader::SetAcceptTwoSlicesGroups( bool accept ) const
 {
   this->Modified();
@@ -333,6 +357,8 @@ void mitk::DICOMITKSeriesGDCMReader::AnalyzeInputFiles()
 mitk::DICOMITKSeriesGDCMReader::SortingBlockList mitk::DICOMITKSeriesGDCMReader::InternalExecuteSortingStep(
   unsigned int sortingStepIndex, const DICOMDatasetSorter::Pointer& sorter, const SortingBlockList& input )
 {
+  MITK_TRACE_SCOPE_ARGS( "DICOM", "Sorting step",
+                         Tracing::MakeArg( "sorter", sorter->GetNameOfClass() ) + ", \"blocks\": " + std::to_string( input.size() ) );
   SortingBlockList nextStepSorting; // we should not modify our input list while processing it
   std::stringstream ss;
   ss << "Sorting step " << sortingStepIndex << " '";
@@ -420,13 +446,55 @@ mitk::ReaderImplementationLevel
 
 bool mitk::DICOMITKSeriesGDCMReader::LoadImages()
 {
-  bool success = true;
+  MITK_TRACE_SCOPE( "DICOM", "DICOMITKSeriesGDCMReader::LoadImages" );
+  std::atomic<bool> success( true );
+
+  const unsigned int numberOfOutputs = this->GetNumberOfOutputs();
+  if ( numberOfOutputs == 0 )
+  {
+    return true;
+  }
+
+  // the blocks are independent and loaded concurrently, the cores that are
+  // left decode the slices of each block
+  const unsigned int numberOfCores = std::max( 1u, std::thread::hardware_concurrency() );
+  const unsigned int numberOfBlockThreads = std::min( numberOfCores, numberOfOutputs );
+  m_NumberOfSliceDecodingThreads = std::max( 1u, numberOfCores / numberOfBlockThreads );
+
+  std::atomic<unsigned int> nextOutput( 0 );
+  auto loadOutputs = [&]() {
+    for ( unsigned int o = nextOutput++; o < numberOfOutputs; o = nextOutput++ )
+    {
+      try
+      {
+        if ( !this->LoadMitkImageForOutput( o ) )
+        {
+          success = false;
+        }
+      }
+      catch ( ... )
+      {
+        MITK_ERROR << "Unspecified error encountered when loading block " << o;
+        success = false;
+      }
+    }
+  };
 
-  unsigned int numberOfOutputs = this->GetNumberOfOutputs();
-  for ( unsigned int o = 0; o < numberOfOutputs; ++o )
+  // the locale is switched once for all blocks
+  PushLocale();
+  std::vector<std::thread> threads;
+  for ( unsigned int i = 1; i < numberOfBlockThreads; ++i )
+  {
+    threads.emplace_back( loadOutputs );
+  }
+  loadOutputs();
+  for ( auto& thread : threads )
   {
-    success &= this->LoadMitkImageForOutput( o );
+    thread.join();
   }
+  PopLocale();
+
+  m_NumberOfSliceDecodingThreads = 0;
 
   return success;
 }
@@ -446,7 +514,20 @@ bool mitk::DICOMITKSeriesGDCMReader::LoadMitkImageForImageBlockDescriptor(
     filenames.push_back( ( *frameIter )->Filename );
   }
 
+  if ( m_ProgressiveLoading && !( m_FixTiltByShearing && hasTilt ) )
+  {
+    DICOMProgressiveImageLoader::Pointer loader = DICOMProgressiveImageLoader::New();
+    if ( loader->Initialize( filenames ) )
+    {
+      block.SetMitkImage( loader->GetImage() );
+      loader->Start();
+      PopLocale();
+      return true;
+    }
+  }
+
   mitk::ITKDICOMSeriesReaderHelper helper;
+  helper.SetNumberOfThreads( m_NumberOfSliceDecodingThreads );
   bool success( true );
   try
   {
@@ -468,6 +549,7 @@ bool mitk::DICOMITKSeriesGDCMReader::LoadMitkImageForImageBlockDescriptor(
 bool mitk::DICOMITKSeriesGDCMReader::LoadMitkImageForOutput( unsigned int o )
 {
   DICOMImageBlockDescriptor& block = this->InternalGetOutput( o );
+  MITK_TRACE_SCOPE_ARGS( "DICOM", "Decode block", "\"frames\": " + std::to_string( block.GetImageFrameList().size() ) );
   return this->LoadMitkImageForImageBlockDescriptor( block );
 }
 
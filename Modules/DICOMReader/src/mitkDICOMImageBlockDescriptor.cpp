@@ -591,6 +591,25 @@ int mitk::DICOMImageBlockDescriptor::GetNumberOfFramesPerTimeStep() const
   return numberOfFramesPerTimestep;
 };
 
+mitk::StringList mitk::DICOMImageBlockDescriptor::GetFilenamesOfTimeStep(int timeStep) const
+{
+  StringList filenames;
+  if (timeStep < 0 || timeStep >= this->GetNumberOfTimeSteps())
+  {
+    return filenames;
+  }
+
+  const int numberOfFramesPerTimestep = this->GetNumberOfFramesPerTimeStep();
+  auto timeStepStart = m_ImageFrameList.cbegin() + timeStep * numberOfFramesPerTimestep;
+  auto timeStepEnd = timeStepStart + numberOfFramesPerTimestep;
+  for (auto frameIter = timeStepStart; frameIter != timeStepEnd; ++frameIter)
+  {
+    filenames.push_back((*frameIter)->Filename);
+  }
+
+  return filenames;
+}
+
 
 void mitk::DICOMImageBlockDescriptor::SetTagCache( DICOMTagCache* privateCache )
 {
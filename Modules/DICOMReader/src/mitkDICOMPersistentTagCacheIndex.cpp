@@ -0,0 +1,341 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMPersistentTagCacheIndex.h"
+
+#include <mitkLogMacros.h>
+
+#include <itksys/SystemTools.hxx>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+  const char IndexMagic[] = "MITKDICOMTAGINDEX";
+  const std::uint32_t IndexVersion = 1;
+
+  template <typename T>
+  void WriteValue(std::ostream &stream, T value)
+  {
+    stream.write(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+
+  template <typename T>
+  T ReadValue(std::istream &stream)
+  {
+    T value = T();
+    stream.read(reinterpret_cast<char *>(&value), sizeof(T));
+    return value;
+  }
+
+  void WriteString(std::ostream &stream, const std::string &value)
+  {
+    WriteValue<std::uint32_t>(stream, static_cast<std::uint32_t>(value.size()));
+    stream.write(value.data(), value.size());
+  }
+
+  std::string ReadString(std::istream &stream)
+  {
+    const auto size = ReadValue<std::uint32_t>(stream);
+    std::string value;
+    if (stream && size > 0)
+    {
+      value.resize(size);
+      stream.read(&value[0], size);
+    }
+    return value;
+  }
+
+  // binary instead of DICOMTagPath::ToStr()/FromStr(), which parses each node with regular expressions
+  void WritePath(std::ostream &stream, const mitk::DICOMTagPath &path)
+  {
+    WriteValue<std::uint32_t>(stream, static_cast<std::uint32_t>(path.Size()));
+    for (const auto &node : path.GetNodes())
+    {
+      WriteValue<std::uint8_t>(stream, static_cast<std::uint8_t>(node.type));
+      WriteValue<std::uint16_t>(stream, static_cast<std::uint16_t>(node.tag.GetGroup()));
+      WriteValue<std::uint16_t>(stream, static_cast<std::uint16_t>(node.tag.GetElement()));
+      WriteValue<std::int32_t>(stream, node.selection);
+    }
+  }
+
+  mitk::DICOMTagPath ReadPath(std::istream &stream)
+  {
+    mitk::DICOMTagPath path;
+    const auto size = ReadValue<std::uint32_t>(stream);
+    for (std::uint32_t i = 0; stream && i < size; ++i)
+    {
+      const auto type = static_cast<mitk::DICOMTagPath::NodeInfo::NodeType>(ReadValue<std::uint8_t>(stream));
+      const auto group = ReadValue<std::uint16_t>(stream);
+      const auto element = ReadValue<std::uint16_t>(stream);
+      const auto selection = ReadValue<std::int32_t>(stream);
+      path.AddNode(mitk::DICOMTagPath::NodeInfo(mitk::DICOMTag(group, element), type, selection));
+    }
+    return path;
+  }
+}
+
+std::mutex mitk::DICOMPersistentTagCacheIndex::s_GlobalIndexMutex;
+mitk::DICOMPersistentTagCacheIndex::Pointer mitk::DICOMPersistentTagCacheIndex::s_GlobalIndex;
+
+mitk::DICOMPersistentTagCacheIndex::DICOMPersistentTagCacheIndex() : m_Changed(false)
+{
+}
+
+mitk::DICOMPersistentTagCacheIndex::~DICOMPersistentTagCacheIndex()
+{
+}
+
+void mitk::DICOMPersistentTagCacheIndex::SetFileName(const std::string &fileName)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_FileName = fileName;
+}
+
+std::string mitk::DICOMPersistentTagCacheIndex::GetFileName() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_FileName;
+}
+
+bool mitk::DICOMPersistentTagCacheIndex::Load()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  m_Entries.clear();
+  m_Changed = false;
+
+  if (m_FileName.empty() || !itksys::SystemTools::FileExists(m_FileName, true))
+  {
+    return true;
+  }
+
+  std::ifstream stream(m_FileName, std::ios::binary);
+  char magic[sizeof(IndexMagic)] = {0};
+  stream.read(magic, sizeof(IndexMagic));
+  if (!stream || std::memcmp(magic, IndexMagic, sizeof(IndexMagic)) != 0 ||
+      ReadValue<std::uint32_t>(stream) != IndexVersion)
+  {
+    MITK_WARN << "Ignoring DICOM tag cache index with unknown format: " << m_FileName;
+    return false;
+  }
+
+  std::map<std::string, Entry> entries;
+  const auto numberOfEntries = ReadValue<std::uint64_t>(stream);
+  for (std::uint64_t i = 0; stream && i < numberOfEntries; ++i)
+  {
+    const std::string fileName = ReadString(stream);
+
+    Entry entry;
+    entry.ModificationTime = ReadValue<std::int64_t>(stream);
+    entry.Size = ReadValue<std::uint64_t>(stream);
+
+    const auto numberOfPaths = ReadValue<std::uint32_t>(stream);
+    for (std::uint32_t p = 0; stream && p < numberOfPaths; ++p)
+    {
+      entry.ScannedPaths.insert(ReadPath(stream));
+    }
+
+    const auto numberOfFindings = ReadValue<std::uint32_t>(stream);
+    for (std::uint32_t f = 0; stream && f < numberOfFindings; ++f)
+    {
+      DICOMTagPath path = ReadPath(stream);
+      entry.Findings.emplace_back(path, ReadString(stream));
+    }
+
+    entries[fileName] = entry;
+  }
+
+  if (!stream)
+  {
+    MITK_WARN << "Ignoring truncated DICOM tag cache index: " << m_FileName;
+    return false;
+  }
+
+  m_Entries.swap(entries);
+  return true;
+}
+
+bool mitk::DICOMPersistentTagCacheIndex::Save()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  if (m_FileName.empty() || !m_Changed)
+  {
+    return true;
+  }
+
+  // write a temporary file first, so an interrupted Save() does not destroy the index
+  const std::string temporaryFileName = m_FileName + ".tmp";
+  {
+    std::ofstream stream(temporaryFileName, std::ios::binary | std::ios::trunc);
+    stream.write(IndexMagic, sizeof(IndexMagic));
+    WriteValue<std::uint32_t>(stream, IndexVersion);
+    WriteValue<std::uint64_t>(stream, m_Entries.size());
+
+    for (const auto &entry : m_Entries)
+    {
+      WriteString(stream, entry.first);
+      WriteValue<std::int64_t>(stream, entry.second.ModificationTime);
+      WriteValue<std::uint64_t>(stream, entry.second.Size);
+
+      WriteValue<std::uint32_t>(stream, static_cast<std::uint32_t>(entry.second.ScannedPaths.size()));
+      for (const auto &path : entry.second.ScannedPaths)
+      {
+        WritePath(stream, path);
+      }
+
+      WriteValue<std::uint32_t>(stream, static_cast<std::uint32_t>(entry.second.Findings.size()));
+      for (const auto &finding : entry.second.Findings)
+      {
+        WritePath(stream, finding.first);
+        WriteString(stream, finding.second);
+      }
+    }
+
+    if (!stream)
+    {
+      MITK_WARN << "Cannot write DICOM tag cache index: " << temporaryFileName;
+      return false;
+    }
+  }
+
+  std::remove(m_FileName.c_str());
+  if (std::rename(temporaryFileName.c_str(), m_FileName.c_str()) != 0)
+  {
+    MITK_WARN << "Cannot write DICOM tag cache index: " << m_FileName;
+    return false;
+  }
+
+  m_Changed = false;
+  return true;
+}
+
+bool mitk::DICOMPersistentTagCacheIndex::Lookup(const std::string &fileName,
+                                                const TagPathSetType &paths,
+                                                FindingsType &findings) const
+{
+  long long modificationTime = 0;
+  unsigned long long size = 0;
+  if (!GetFileVersion(fileName, modificationTime, size))
+  {
+    return false;
+  }
+
+  const std::string fullPath = itksys::SystemTools::CollapseFullPath(fileName);
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  const auto entry = m_Entries.find(fullPath);
+  if (entry == m_Entries.cend() || entry->second.ModificationTime != modificationTime || entry->second.Size != size)
+  {
+    return false;
+  }
+
+  for (const auto &path : paths)
+  {
+    if (entry->second.ScannedPaths.find(path) == entry->second.ScannedPaths.cend())
+    {
+      return false;
+    }
+  }
+
+  findings = entry->second.Findings;
+  return true;
+}
+
+void mitk::DICOMPersistentTagCacheIndex::Insert(const std::string &fileName,
+                                                const TagPathSetType &paths,
+                                                const FindingsType &findings)
+{
+  Entry newEntry;
+  if (!GetFileVersion(fileName, newEntry.ModificationTime, newEntry.Size))
+  {
+    return;
+  }
+  newEntry.ScannedPaths = paths;
+  newEntry.Findings = findings;
+
+  const std::string fullPath = itksys::SystemTools::CollapseFullPath(fileName);
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  const auto entry = m_Entries.find(fullPath);
+  if (entry != m_Entries.cend() && entry->second.ModificationTime == newEntry.ModificationTime &&
+      entry->second.Size == newEntry.Size)
+  {
+    // keep the values of paths that were scanned before and are not part of the new scan
+    for (const auto &finding : entry->second.Findings)
+    {
+      bool rescanned = false;
+      for (const auto &path : paths)
+      {
+        if (path.Equals(finding.first))
+        {
+          rescanned = true;
+          break;
+        }
+      }
+
+      if (!rescanned)
+      {
+        newEntry.Findings.push_back(finding);
+      }
+    }
+    newEntry.ScannedPaths.insert(entry->second.ScannedPaths.cbegin(), entry->second.ScannedPaths.cend());
+  }
+
+  m_Entries[fullPath] = newEntry;
+  m_Changed = true;
+}
+
+void mitk::DICOMPersistentTagCacheIndex::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Changed = m_Changed || !m_Entries.empty();
+  m_Entries.clear();
+}
+
+std::size_t mitk::DICOMPersistentTagCacheIndex::GetNumberOfEntries() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Entries.size();
+}
+
+mitk::DICOMPersistentTagCacheIndex::Pointer mitk::DICOMPersistentTagCacheIndex::GetGlobalIndex()
+{
+  std::lock_guard<std::mutex> lock(s_GlobalIndexMutex);
+  return s_GlobalIndex;
+}
+
+void mitk::DICOMPersistentTagCacheIndex::SetGlobalIndex(DICOMPersistentTagCacheIndex *index)
+{
+  std::lock_guard<std::mutex> lock(s_GlobalIndexMutex);
+  s_GlobalIndex = index;
+}
+
+bool mitk::DICOMPersistentTagCacheIndex::GetFileVersion(const std::string &fileName,
+                                                        long long &modificationTime,
+                                                        unsigned long long &size)
+{
+  if (!itksys::SystemTools::FileExists(fileName, true))
+  {
+    return false;
+  }
+
+  modificationTime = itksys::SystemTools::ModifiedTime(fileName);
+  size = itksys::SystemTools::FileLength(fileName);
+  return true;
+}
@@ -0,0 +1,312 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMProgressiveImageLoader.h"
+
+#include <mitkImageWriteAccessor.h>
+#include <mitkRenderingManager.h>
+
+#include <itkGDCMImageIO.h>
+#include <itkImageSeriesReader.h>
+
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+  const std::chrono::milliseconds ProgressNotificationInterval(250);
+
+  /** Keeps the running loaders alive and cancels them on shutdown */
+  class LoaderRegistry
+  {
+  public:
+    ~LoaderRegistry() { this->CancelAll(); }
+
+    void Add(mitk::DICOMProgressiveImageLoader *loader)
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+
+      // forget the loaders that finished in the meantime
+      m_Loaders.erase(std::remove_if(m_Loaders.begin(),
+                                     m_Loaders.end(),
+                                     [](const mitk::DICOMProgressiveImageLoader::Pointer &running) {
+                                       return running->IsFinished();
+                                     }),
+                      m_Loaders.end());
+      m_Loaders.push_back(loader);
+    }
+
+    void CancelAll()
+    {
+      std::vector<mitk::DICOMProgressiveImageLoader::Pointer> loaders;
+      {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        loaders.swap(m_Loaders);
+      }
+
+      for (const auto &loader : loaders)
+      {
+        loader->Cancel();
+        loader->Wait();
+      }
+    }
+
+  private:
+    std::mutex m_Mutex;
+    std::vector<mitk::DICOMProgressiveImageLoader::Pointer> m_Loaders;
+  };
+
+  LoaderRegistry &GetLoaderRegistry()
+  {
+    static LoaderRegistry registry;
+    return registry;
+  }
+
+  bool ReadPixelTypeOfFile(const std::string &filename, int &componentType, unsigned int &numberOfComponents)
+  {
+    itk::GDCMImageIO::Pointer io = itk::GDCMImageIO::New();
+    if (!io->CanReadFile(filename.c_str()))
+    {
+      return false;
+    }
+
+    io->SetFileName(filename.c_str());
+    io->ReadImageInformation();
+    componentType = io->GetComponentType();
+    numberOfComponents = io->GetNumberOfComponents();
+    return true;
+  }
+}
+
+mitk::DICOMProgressiveImageLoader::DICOMProgressiveImageLoader()
+  : m_Buffer(nullptr),
+    m_BytesPerSlice(0),
+    m_ComponentType(0),
+    m_NumberOfComponents(0),
+    m_NumberOfLoadedSlices(0),
+    m_Cancelled(false),
+    m_Finished(false)
+{
+}
+
+mitk::DICOMProgressiveImageLoader::~DICOMProgressiveImageLoader()
+{
+  this->Cancel();
+  this->Wait();
+}
+
+bool mitk::DICOMProgressiveImageLoader::Initialize(const StringList &filenames)
+{
+  if (filenames.size() < 2 || m_Image.IsNotNull())
+  {
+    return false;
+  }
+
+  // the pixel data is not read, so the pixel type of the series reader does not matter
+  typedef itk::Image<char, 3> InformationImageType;
+  typedef itk::ImageSeriesReader<InformationImageType> ReaderType;
+
+  itk::GDCMImageIO::Pointer io = itk::GDCMImageIO::New();
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetImageIO(io);
+  reader->ReverseOrderOff(); // see ITKDICOMSeriesReaderHelper::LoadDICOMByITK()
+  reader->SetFileNames(filenames);
+
+  try
+  {
+    reader->UpdateOutputInformation();
+
+    // multi-frame files are left to the series reader
+    if (reader->GetOutput()->GetLargestPossibleRegion().GetSize()[2] != filenames.size())
+    {
+      return false;
+    }
+
+    // a different pixel type (e.g. due to rescaling) would need a conversion, check some files in advance
+    if (!ReadPixelTypeOfFile(filenames.front(), m_ComponentType, m_NumberOfComponents))
+    {
+      return false;
+    }
+
+    for (const auto &filename : {filenames[filenames.size() / 2], filenames.back()})
+    {
+      int componentType = 0;
+      unsigned int numberOfComponents = 0;
+      if (!ReadPixelTypeOfFile(filename, componentType, numberOfComponents) || componentType != m_ComponentType ||
+          numberOfComponents != m_NumberOfComponents)
+      {
+        return false;
+      }
+    }
+
+    io->SetFileName(filenames.front().c_str());
+    io->ReadImageInformation();
+
+    Image::Pointer geometryImage = Image::New();
+    geometryImage->InitializeByItk(reader->GetOutput());
+
+    Image::Pointer image = Image::New();
+    image->Initialize(MakePixelType(io), *(geometryImage->GetTimeGeometry()));
+
+    m_BytesPerSlice = io->GetImageSizeInBytes();
+    if (m_BytesPerSlice != image->GetPixelType().GetSize() * image->GetDimension(0) * image->GetDimension(1))
+    {
+      return false;
+    }
+
+    {
+      ImageWriteAccessor accessor(image);
+      m_Buffer = static_cast<char *>(accessor.GetData());
+      std::memset(m_Buffer, 0, m_BytesPerSlice * filenames.size());
+    }
+
+    m_Image = image;
+  }
+  catch (const std::exception &e)
+  {
+    MITK_WARN << "Cannot load DICOM series progressively: " << e.what();
+    return false;
+  }
+
+  m_Filenames = filenames;
+  m_SliceIsLoaded.reset(new std::atomic<bool>[filenames.size()]);
+  for (std::size_t i = 0; i < filenames.size(); ++i)
+  {
+    m_SliceIsLoaded[i] = false;
+  }
+
+  return true;
+}
+
+mitk::Image::Pointer mitk::DICOMProgressiveImageLoader::GetImage() const
+{
+  return m_Image;
+}
+
+void mitk::DICOMProgressiveImageLoader::Start()
+{
+  if (m_Image.IsNull() || m_Thread.joinable() || m_Finished)
+  {
+    return;
+  }
+
+  this->LoadSlice(static_cast<unsigned int>(m_Filenames.size() / 2));
+
+  GetLoaderRegistry().Add(this);
+  m_Thread = std::thread(&DICOMProgressiveImageLoader::LoadRemainingSlices, this);
+}
+
+void mitk::DICOMProgressiveImageLoader::Cancel()
+{
+  m_Cancelled = true;
+}
+
+void mitk::DICOMProgressiveImageLoader::Wait()
+{
+  if (m_Thread.joinable() && m_Thread.get_id() != std::this_thread::get_id())
+  {
+    m_Thread.join();
+  }
+}
+
+bool mitk::DICOMProgressiveImageLoader::IsSliceLoaded(unsigned int slice) const
+{
+  return slice < m_Filenames.size() && m_SliceIsLoaded[slice];
+}
+
+unsigned int mitk::DICOMProgressiveImageLoader::GetNumberOfLoadedSlices() const
+{
+  return m_NumberOfLoadedSlices;
+}
+
+bool mitk::DICOMProgressiveImageLoader::IsFinished() const
+{
+  return m_Finished;
+}
+
+void mitk::DICOMProgressiveImageLoader::CancelAll()
+{
+  GetLoaderRegistry().CancelAll();
+}
+
+bool mitk::DICOMProgressiveImageLoader::LoadSlice(unsigned int slice)
+{
+  try
+  {
+    // GDCMImageIO is not thread-safe, every slice gets its own
+    itk::GDCMImageIO::Pointer io = itk::GDCMImageIO::New();
+    io->SetFileName(m_Filenames[slice].c_str());
+    io->ReadImageInformation();
+
+    if (io->GetComponentType() != m_ComponentType || io->GetNumberOfComponents() != m_NumberOfComponents ||
+        io->GetImageSizeInBytes() != m_BytesPerSlice)
+    {
+      MITK_WARN << "Pixel type or size of slice " << m_Filenames[slice]
+                << " differs from the first slice of the series, slice stays empty.";
+      return false;
+    }
+
+    io->Read(m_Buffer + slice * m_BytesPerSlice);
+  }
+  catch (const std::exception &e)
+  {
+    MITK_ERROR << "Cannot load slice " << m_Filenames[slice] << ": " << e.what();
+    return false;
+  }
+
+  m_SliceIsLoaded[slice] = true;
+  ++m_NumberOfLoadedSlices;
+  return true;
+}
+
+void mitk::DICOMProgressiveImageLoader::LoadRemainingSlices()
+{
+  const int numberOfSlices = static_cast<int>(m_Filenames.size());
+  const int center = numberOfSlices / 2;
+
+  m_LastNotification = std::chrono::steady_clock::now();
+
+  // center-out: center + 1, center - 1, center + 2, ...
+  for (int distance = 1; distance <= center + 1 && !m_Cancelled; ++distance)
+  {
+    for (const int slice : {center + distance, center - distance})
+    {
+      if (slice >= 0 && slice < numberOfSlices && !m_Cancelled)
+      {
+        this->LoadSlice(static_cast<unsigned int>(slice));
+        this->NotifyProgress(false);
+      }
+    }
+  }
+
+  this->NotifyProgress(true);
+  m_Finished = true;
+}
+
+void mitk::DICOMProgressiveImageLoader::NotifyProgress(bool force)
+{
+  const auto now = std::chrono::steady_clock::now();
+  if (!force && now - m_LastNotification < ProgressNotificationInterval)
+  {
+    return;
+  }
+  m_LastNotification = now;
+
+  m_Image->Modified();
+  if (RenderingManager::IsInstantiated())
+  {
+    RenderingManager::GetInstance()->RequestUpdateAll();
+  }
+}
@@ -12,9 +12,25 @@ found in the LICENSE file.
 
 #include "mitkDICOMTagScanner.h"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  // fewer files are not worth a thread
+  const std::size_t MinimumNumberOfFilesPerThread = 8;
+  // ranges per thread, balances files of different size or access time
+  const std::size_t NumberOfRangesPerThread = 4;
+}
+
 itk::MutexLock::Pointer mitk::DICOMTagScanner::s_LocaleMutex = itk::MutexLock::New();
 
 mitk::DICOMTagScanner::DICOMTagScanner()
+  : m_NumberOfThreads(0)
 {
 }
 
@@ -70,3 +86,75 @@ std::string mitk::DICOMTagScanner::GetActiveLocale()
 {
   return setlocale(LC_NUMERIC, nullptr);
 }
+
+void mitk::DICOMTagScanner::ScanInParallel(
+  std::size_t numberOfFiles, const std::function<void(std::size_t begin, std::size_t end)> &scanFiles) const
+{
+  std::size_t numberOfThreads = m_NumberOfThreads;
+  if (numberOfThreads == 0)
+  {
+    numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  numberOfThreads = std::min(numberOfThreads, numberOfFiles / MinimumNumberOfFilesPerThread);
+
+  if (numberOfThreads <= 1)
+  {
+    if (numberOfFiles > 0)
+    {
+      scanFiles(0, numberOfFiles);
+    }
+    return;
+  }
+
+  const std::size_t numberOfRanges = numberOfThreads * NumberOfRangesPerThread;
+  const std::size_t rangeSize = (numberOfFiles + numberOfRanges - 1) / numberOfRanges;
+
+  std::atomic<std::size_t> nextRange(0);
+  std::exception_ptr exception;
+  std::mutex exceptionMutex;
+
+  auto worker = [&]() {
+    for (std::size_t range = nextRange++; range * rangeSize < numberOfFiles; range = nextRange++)
+    {
+      try
+      {
+        scanFiles(range * rangeSize, std::min(numberOfFiles, (range + 1) * rangeSize));
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(exceptionMutex);
+        if (!exception)
+        {
+          exception = std::current_exception();
+        }
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(numberOfThreads - 1);
+  for (std::size_t i = 1; i < numberOfThreads; ++i)
+  {
+    threads.emplace_back(worker);
+  }
+  worker();
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  if (exception)
+  {
+    std::rethrow_exception(exception);
+  }
+}
+
+mitk::DICOMPersistentTagCacheIndex::Pointer mitk::DICOMTagScanner::GetEffectivePersistentTagCacheIndex() const
+{
+  if (m_PersistentTagCacheIndex.IsNotNull())
+  {
+    return m_PersistentTagCacheIndex;
+  }
+  return DICOMPersistentTagCacheIndex::GetGlobalIndex();
+}
@@ -0,0 +1,106 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMTimeStepVolumeProvider.h"
+#include "mitkITKDICOMSeriesReaderHelper.h"
+
+#include <mitkImageReadAccessor.h>
+
+#include <clocale>
+#include <cstring>
+#include <mutex>
+
+namespace
+{
+  /** Activates the "C" numeric locale while a time step is decoded (compare DICOMTagScanner::PushLocale()) */
+  class ScopedCNumericLocale
+  {
+  public:
+    ScopedCNumericLocale() : m_Lock(GetMutex())
+    {
+      m_ReplacedLocale = setlocale(LC_NUMERIC, nullptr);
+      setlocale(LC_NUMERIC, "C");
+    }
+
+    ~ScopedCNumericLocale() { setlocale(LC_NUMERIC, m_ReplacedLocale.c_str()); }
+
+  private:
+    static std::mutex &GetMutex()
+    {
+      static std::mutex mutex;
+      return mutex;
+    }
+
+    std::lock_guard<std::mutex> m_Lock;
+    std::string m_ReplacedLocale;
+  };
+}
+
+mitk::DICOMTimeStepVolumeProvider::DICOMTimeStepVolumeProvider() : m_CorrectTilt(false)
+{
+}
+
+mitk::DICOMTimeStepVolumeProvider::~DICOMTimeStepVolumeProvider()
+{
+}
+
+void mitk::DICOMTimeStepVolumeProvider::SetTimeSteps(const FilenamesPerTimeStepType &filenamesPerTimeStep,
+                                                     bool correctTilt,
+                                                     const GantryTiltInformation &tiltInfo)
+{
+  m_FilenamesPerTimeStep = filenamesPerTimeStep;
+  m_CorrectTilt = correctTilt;
+  m_TiltInfo = tiltInfo;
+  this->Modified();
+}
+
+const mitk::DICOMTimeStepVolumeProvider::FilenamesPerTimeStepType &
+  mitk::DICOMTimeStepVolumeProvider::GetFilenamesPerTimeStep() const
+{
+  return m_FilenamesPerTimeStep;
+}
+
+bool mitk::DICOMTimeStepVolumeProvider::ProvideVolume(const Image *image, int t, int n, void *buffer)
+{
+  if (nullptr == image || n != 0 || t < 0 || static_cast<std::size_t>(t) >= m_FilenamesPerTimeStep.size())
+  {
+    return false;
+  }
+
+  Image::Pointer volume;
+  {
+    // setlocale() is process-wide, time steps that are accessed at the same time are decoded one after another
+    ScopedCNumericLocale locale;
+    ITKDICOMSeriesReaderHelper helper;
+    volume = helper.Load(m_FilenamesPerTimeStep[t], m_CorrectTilt, m_TiltInfo);
+  }
+
+  if (volume.IsNull())
+  {
+    MITK_ERROR << "Cannot load time step " << t << " of DICOM block.";
+    return false;
+  }
+
+  if (volume->GetPixelType() != image->GetPixelType() || volume->GetDimension(0) != image->GetDimension(0) ||
+      volume->GetDimension(1) != image->GetDimension(1) || volume->GetDimension(2) != image->GetDimension(2))
+  {
+    MITK_ERROR << "Time step " << t << " of DICOM block differs in size or pixel type from the first time step.";
+    return false;
+  }
+
+  ImageReadAccessor accessor(volume);
+  std::memcpy(buffer,
+              accessor.GetData(),
+              static_cast<std::size_t>(image->GetPixelType().GetSize()) * image->GetDimension(0) *
+                image->GetDimension(1) * image->GetDimension(2));
+  return true;
+}
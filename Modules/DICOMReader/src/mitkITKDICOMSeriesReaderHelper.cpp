@@ -28,15 +28,258 @@ found in the LICENSE file.
 #include "mitkITKDICOMSeriesReaderHelper.txx"
 
 #include "mitkDICOMGDCMTagScanner.h"
+#include "mitkDICOMTimeStepVolumeProvider.h"
 #include "mitkArbitraryTimeGeometry.h"
+#include "mitkImageReadAccessor.h"
 
 #include "dcmtk/dcmdata/dcvrda.h"
+#include "dcmtk/dcmdata/dcdeftag.h"
+#include "dcmtk/dcmdata/dcfilefo.h"
+#include "dcmtk/dcmdata/dcuid.h"
+
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  template <typename InputType, typename OutputType>
+  void RescalePixels( const InputType* input,
+                      OutputType* output,
+                      std::size_t numberOfPixels,
+                      double slope,
+                      double intercept )
+  {
+    // a plain loop, so the compiler can vectorize it
+    for ( std::size_t i = 0; i < numberOfPixels; ++i )
+    {
+      output[i] = static_cast<OutputType>( input[i] * slope + intercept );
+    }
+  }
+
+#define rescaleCase( IOType, T )                                                          \
+  case IOType:                                                                            \
+    RescalePixels( input, static_cast<T*>( output ), numberOfPixels, slope, intercept ); \
+    return true;
+
+  template <typename InputType>
+  bool RescalePixels( const void* storedValues,
+                      int outputComponentType,
+                      void* output,
+                      std::size_t numberOfPixels,
+                      double slope,
+                      double intercept )
+  {
+    const InputType* input = static_cast<const InputType*>( storedValues );
+    switch ( outputComponentType )
+    {
+      rescaleCase( itk::ImageIOBase::UCHAR, unsigned char )
+      rescaleCase( itk::ImageIOBase::CHAR, char )
+      rescaleCase( itk::ImageIOBase::USHORT, unsigned short )
+      rescaleCase( itk::ImageIOBase::SHORT, short )
+      rescaleCase( itk::ImageIOBase::UINT, unsigned int )
+      rescaleCase( itk::ImageIOBase::INT, int )
+      rescaleCase( itk::ImageIOBase::ULONG, long unsigned int )
+      rescaleCase( itk::ImageIOBase::LONG, long int )
+      rescaleCase( itk::ImageIOBase::FLOAT, float )
+      rescaleCase( itk::ImageIOBase::DOUBLE, double )
+      default:
+        return false;
+    }
+  }
+
+#undef rescaleCase
+}
 
 
 const mitk::DICOMTag mitk::ITKDICOMSeriesReaderHelper::AcquisitionDateTag = mitk::DICOMTag( 0x0008, 0x0022 );
 const mitk::DICOMTag mitk::ITKDICOMSeriesReaderHelper::AcquisitionTimeTag = mitk::DICOMTag( 0x0008, 0x0032 );
 const mitk::DICOMTag mitk::ITKDICOMSeriesReaderHelper::TriggerTimeTag = mitk::DICOMTag( 0x0018, 0x1060 );
 
+mitk::ITKDICOMSeriesReaderHelper::ITKDICOMSeriesReaderHelper() : m_NumberOfThreads(0)
+{
+}
+
+void mitk::ITKDICOMSeriesReaderHelper::SetNumberOfThreads( unsigned int numberOfThreads )
+{
+  m_NumberOfThreads = numberOfThreads;
+}
+
+unsigned int mitk::ITKDICOMSeriesReaderHelper::GetNumberOfThreads() const
+{
+  return m_NumberOfThreads;
+}
+
+std::size_t mitk::ITKDICOMSeriesReaderHelper::GetNumberOfThreadsToUse() const
+{
+  if ( m_NumberOfThreads > 0 )
+  {
+    return m_NumberOfThreads;
+  }
+  return std::max( std::thread::hardware_concurrency(), 1u );
+}
+
+void mitk::ITKDICOMSeriesReaderHelper::ForEachSliceInParallel( std::size_t numberOfSlices,
+                                                               std::size_t numberOfThreads,
+                                                               const std::function<void( std::size_t )>& function )
+{
+  std::atomic<std::size_t> nextSlice( 0 );
+  std::exception_ptr exception;
+  std::mutex exceptionMutex;
+
+  auto processSlices = [&]() {
+    for ( std::size_t z = nextSlice++; z < numberOfSlices; z = nextSlice++ )
+    {
+      try
+      {
+        function( z );
+      }
+      catch ( ... )
+      {
+        std::lock_guard<std::mutex> lock( exceptionMutex );
+        if ( !exception )
+        {
+          exception = std::current_exception();
+        }
+        nextSlice = numberOfSlices;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for ( std::size_t i = 1; i < numberOfThreads; ++i )
+  {
+    threads.emplace_back( processSlices );
+  }
+  processSlices();
+  for ( auto& thread : threads )
+  {
+    thread.join();
+  }
+
+  if ( exception )
+  {
+    std::rethrow_exception( exception );
+  }
+}
+
+bool mitk::ITKDICOMSeriesReaderHelper::ReadUncompressedSlice( const std::string& filename,
+                                                               unsigned int columns,
+                                                               unsigned int rows,
+                                                               int outputComponentType,
+                                                               void* output )
+{
+  // elements longer than this (i.e. the pixel data) stay in the file until they are accessed
+  const Uint32 maxReadLength = 4096;
+
+  DcmFileFormat fileFormat;
+  if ( fileFormat.loadFile( filename.c_str(), EXS_Unknown, EGL_noChange, maxReadLength ).bad() )
+  {
+    return false;
+  }
+
+  DcmDataset* dataset = fileFormat.getDataset();
+  const E_TransferSyntax transferSyntax = dataset->getOriginalXfer();
+  if ( transferSyntax != EXS_LittleEndianImplicit && transferSyntax != EXS_LittleEndianExplicit
+       && transferSyntax != EXS_BigEndianExplicit )
+  {
+    return false;
+  }
+
+  // GDCM ignores the rescale values of MR images, other SOP classes are left to GDCM
+  OFString sopClassUID;
+  dataset->findAndGetOFString( DCM_SOPClassUID, sopClassUID );
+  const bool ignoreRescale = sopClassUID == UID_MRImageStorage;
+  if ( !ignoreRescale && sopClassUID != UID_CTImageStorage
+       && sopClassUID != UID_PositronEmissionTomographyImageStorage )
+  {
+    return false;
+  }
+
+  Uint16 samplesPerPixel = 0, datasetRows = 0, datasetColumns = 0;
+  Uint16 bitsAllocated = 0, bitsStored = 0, highBit = 0, pixelRepresentation = 0;
+  Sint32 numberOfFrames = 1;
+  OFString photometricInterpretation;
+  dataset->findAndGetSint32( DCM_NumberOfFrames, numberOfFrames );
+  dataset->findAndGetOFString( DCM_PhotometricInterpretation, photometricInterpretation );
+  if ( dataset->findAndGetUint16( DCM_SamplesPerPixel, samplesPerPixel ).bad() || samplesPerPixel != 1
+       || dataset->findAndGetUint16( DCM_Rows, datasetRows ).bad() || datasetRows != rows
+       || dataset->findAndGetUint16( DCM_Columns, datasetColumns ).bad() || datasetColumns != columns
+       || dataset->findAndGetUint16( DCM_BitsAllocated, bitsAllocated ).bad()
+       || dataset->findAndGetUint16( DCM_BitsStored, bitsStored ).bad()
+       || dataset->findAndGetUint16( DCM_HighBit, highBit ).bad()
+       || dataset->findAndGetUint16( DCM_PixelRepresentation, pixelRepresentation ).bad()
+       || numberOfFrames > 1
+       || ( photometricInterpretation != "MONOCHROME1" && photometricInterpretation != "MONOCHROME2" ) )
+  {
+    return false;
+  }
+
+  // values that need masking or sign extension are left to GDCM, just like byte swapping of 32 bit values
+  if ( bitsStored != bitsAllocated || highBit + 1 != bitsStored
+       || ( bitsAllocated != 8 && bitsAllocated != 16 && bitsAllocated != 32 )
+       || ( transferSyntax == EXS_BigEndianExplicit && bitsAllocated == 32 ) )
+  {
+    return false;
+  }
+
+  Float64 slope = 1.0;
+  Float64 intercept = 0.0;
+  if ( !ignoreRescale )
+  {
+    dataset->findAndGetFloat64( DCM_RescaleSlope, slope );
+    dataset->findAndGetFloat64( DCM_RescaleIntercept, intercept );
+  }
+
+  DcmElement* pixelData = nullptr;
+  const std::size_t numberOfPixels = static_cast<std::size_t>( rows ) * columns;
+  const std::size_t numberOfBytes = numberOfPixels * ( bitsAllocated / 8 );
+  if ( dataset->findAndGetElement( DCM_PixelData, pixelData ).bad() || pixelData->getLength() < numberOfBytes )
+  {
+    return false;
+  }
+
+  int storedComponentType = itk::ImageIOBase::UNKNOWNCOMPONENTTYPE;
+  switch ( bitsAllocated )
+  {
+    case 8: storedComponentType = pixelRepresentation ? itk::ImageIOBase::CHAR : itk::ImageIOBase::UCHAR; break;
+    case 16: storedComponentType = pixelRepresentation ? itk::ImageIOBase::SHORT : itk::ImageIOBase::USHORT; break;
+    default: storedComponentType = pixelRepresentation ? itk::ImageIOBase::INT : itk::ImageIOBase::UINT; break;
+  }
+
+  // the values can be used as they are stored, read them directly into the output
+  if ( storedComponentType == outputComponentType && slope == 1.0 && intercept == 0.0 )
+  {
+    return pixelData->getPartialValue( output, 0, static_cast<Uint32>( numberOfBytes ) ).good();
+  }
+
+  std::vector<char> storedValues( numberOfBytes );
+  if ( pixelData->getPartialValue( storedValues.data(), 0, static_cast<Uint32>( numberOfBytes ) ).bad() )
+  {
+    return false;
+  }
+
+  const void* input = storedValues.data();
+  switch ( storedComponentType )
+  {
+    case itk::ImageIOBase::CHAR:
+      return RescalePixels<Sint8>( input, outputComponentType, output, numberOfPixels, slope, intercept );
+    case itk::ImageIOBase::UCHAR:
+      return RescalePixels<Uint8>( input, outputComponentType, output, numberOfPixels, slope, intercept );
+    case itk::ImageIOBase::SHORT:
+      return RescalePixels<Sint16>( input, outputComponentType, output, numberOfPixels, slope, intercept );
+    case itk::ImageIOBase::USHORT:
+      return RescalePixels<Uint16>( input, outputComponentType, output, numberOfPixels, slope, intercept );
+    case itk::ImageIOBase::INT:
+      return RescalePixels<Sint32>( input, outputComponentType, output, numberOfPixels, slope, intercept );
+    default:
+      return RescalePixels<Uint32>( input, outputComponentType, output, numberOfPixels, slope, intercept );
+  }
+}
+
 #define switch3DCase( IOType, T ) \
   case IOType:                    \
     return LoadDICOMByITK<T>( filenames, correctTilt, tiltInfo, io );
@@ -202,6 +445,68 @@ mitk::Image::Pointer mitk::ITKDICOMSeriesReaderHelper::Load3DnT( const StringCon
   return nullptr;
 }
 
+mitk::Image::Pointer mitk::ITKDICOMSeriesReaderHelper::Load3DnTOnDemand( const StringContainerList& filenamesLists,
+                                                                         bool correctTilt,
+                                                                         const GantryTiltInformation& tiltInfo )
+{
+  if ( filenamesLists.empty() || filenamesLists.front().empty() )
+  {
+    MITK_DEBUG
+      << "Calling LoadDicomSeries with empty filename string container. Probably invalid application logic.";
+    return nullptr; // this is not actually an error but the result is very simple
+  }
+
+  Image::Pointer firstTimeStep = this->Load( filenamesLists.front(), correctTilt, tiltInfo );
+  if ( firstTimeStep.IsNull() )
+  {
+    return nullptr;
+  }
+
+  try
+  {
+    const TimeBoundsList timeBoundsList = ExtractTimeBoundsOfTimeSteps( filenamesLists );
+    if ( filenamesLists.size() != timeBoundsList.size() )
+    {
+      MITK_ERROR << "Error while loading 3D+t. Inconsistent size of generated time bounds list. List size: "
+                 << timeBoundsList.size() << "; number of steps: " << filenamesLists.size();
+      return nullptr;
+    }
+
+    const unsigned int dimensions[4] = { firstTimeStep->GetDimension( 0 ),
+                                         firstTimeStep->GetDimension( 1 ),
+                                         firstTimeStep->GetDimension( 2 ),
+                                         static_cast<unsigned int>( filenamesLists.size() ) };
+
+    Image::Pointer image = Image::New();
+    image->Initialize( firstTimeStep->GetPixelType(), 4, dimensions );
+    image->SetTimeGeometry( GenerateTimeGeometry( firstTimeStep->GetGeometry(), timeBoundsList ) );
+
+    {
+      ImageReadAccessor accessor( firstTimeStep );
+      image->SetVolume( accessor.GetData(), 0 );
+    }
+
+    DICOMTimeStepVolumeProvider::Pointer provider = DICOMTimeStepVolumeProvider::New();
+    provider->SetTimeSteps( DICOMTimeStepVolumeProvider::FilenamesPerTimeStepType( filenamesLists.cbegin(),
+                                                                                   filenamesLists.cend() ),
+                            correctTilt,
+                            tiltInfo );
+    image->SetVolumeProvider( provider );
+
+    return image;
+  }
+  catch ( const itk::MemoryAllocationError& e )
+  {
+    MITK_ERROR << "Out of memory. Cannot load DICOM series: " << e.what();
+  }
+  catch ( const std::exception& e )
+  {
+    MITK_ERROR << "Error encountered when loading DICOM series:" << e.what();
+  }
+
+  return nullptr;
+}
+
 bool ConvertDICOMDateTimeString( const std::string& dateString,
                                  const std::string& timeString,
                                  OFDateTime& time )
@@ -17,6 +17,7 @@ mitk::ThreeDnTDICOMSeriesReader
 ::ThreeDnTDICOMSeriesReader(unsigned int decimalPlacesForOrientation)
 :DICOMITKSeriesGDCMReader(decimalPlacesForOrientation)
 ,m_Group3DandT(m_DefaultGroup3DandT), m_OnlyCondenseSameSeries(m_DefaultOnlyCondenseSameSeries)
+,m_LoadTimeStepsOnDemand(false)
 {
 }
 
@@ -24,6 +25,7 @@ mitk::ThreeDnTDICOMSeriesReader
 ::ThreeDnTDICOMSeriesReader(const ThreeDnTDICOMSeriesReader& other )
 :DICOMITKSeriesGDCMReader(other)
 ,m_Group3DandT(m_DefaultGroup3DandT), m_OnlyCondenseSameSeries(m_DefaultOnlyCondenseSameSeries)
+,m_LoadTimeStepsOnDemand(other.m_LoadTimeStepsOnDemand)
 {
 }
 
@@ -40,6 +42,7 @@ mitk::ThreeDnTDICOMSeriesReader
   {
     DICOMITKSeriesGDCMReader::operator=(other);
     this->m_Group3DandT = other.m_Group3DandT;
+    this->m_LoadTimeStepsOnDemand = other.m_LoadTimeStepsOnDemand;
   }
   return *this;
 }
@@ -74,6 +77,20 @@ mitk::ThreeDnTDICOMSeriesReader
   return m_Group3DandT;
 }
 
+void
+mitk::ThreeDnTDICOMSeriesReader
+::SetLoadTimeStepsOnDemand(bool on)
+{
+  m_LoadTimeStepsOnDemand = on;
+}
+
+bool
+mitk::ThreeDnTDICOMSeriesReader
+::GetLoadTimeStepsOnDemand() const
+{
+  return m_LoadTimeStepsOnDemand;
+}
+
 mitk::DICOMITKSeriesGDCMReader::SortingBlockList
 mitk::ThreeDnTDICOMSeriesReader
 ::Condense3DBlocks(SortingBlockList& resultOf3DGrouping)
@@ -223,8 +240,6 @@ bool
 mitk::ThreeDnTDICOMSeriesReader
 ::LoadMitkImageForImageBlockDescriptor(DICOMImageBlockDescriptor& block) const
 {
-  PushLocale();
-  const DICOMImageFrameList& frames = block.GetImageFrameList();
   const GantryTiltInformation tiltInfo = block.GetTiltInformation();
   const bool hasTilt = tiltInfo.IsRegularGantryTilt();
 
@@ -235,26 +250,18 @@ mitk::ThreeDnTDICOMSeriesReader
     return DICOMITKSeriesGDCMReader::LoadMitkImageForImageBlockDescriptor(block);
   }
 
-  const int numberOfFramesPerTimestep = block.GetNumberOfFramesPerTimeStep();
+  PushLocale();
 
   ITKDICOMSeriesReaderHelper::StringContainerList filenamesPerTimestep;
   for (int timeStep = 0; timeStep<numberOfTimesteps; ++timeStep)
   {
-    // use numberOfFramesPerTimestep frames for a new item in filenamesPerTimestep
-    ITKDICOMSeriesReaderHelper::StringContainer filenamesOfThisTimeStep;
-    auto timeStepStart = frames.cbegin() + timeStep * numberOfFramesPerTimestep;
-    auto timeStepEnd   = frames.cbegin() + (timeStep+1) * numberOfFramesPerTimestep;
-    for (auto frameIter = timeStepStart;
-        frameIter != timeStepEnd;
-        ++frameIter)
-    {
-      filenamesOfThisTimeStep.push_back( (*frameIter)->Filename );
-    }
-    filenamesPerTimestep.push_back( filenamesOfThisTimeStep );
+    filenamesPerTimestep.push_back( block.GetFilenamesOfTimeStep(timeStep) );
   }
 
   mitk::ITKDICOMSeriesReaderHelper helper;
-  mitk::Image::Pointer mitkImage = helper.Load3DnT( filenamesPerTimestep, m_FixTiltByShearing && hasTilt, tiltInfo );
+  mitk::Image::Pointer mitkImage = m_LoadTimeStepsOnDemand
+    ? helper.Load3DnTOnDemand( filenamesPerTimestep, m_FixTiltByShearing && hasTilt, tiltInfo )
+    : helper.Load3DnT( filenamesPerTimestep, m_FixTiltByShearing && hasTilt, tiltInfo );
 
   block.SetMitkImage( mitkImage );
 
@@ -24,6 +24,7 @@ class mitkDICOMDCMTKTagScannerTestSuite : public mitk::TestFixture
 
   MITK_TEST(DeepScanning);
   MITK_TEST(MultiFileScanning);
+  MITK_TEST(ParallelScanning);
 
   CPPUNIT_TEST_SUITE_END();
 
@@ -119,6 +120,42 @@ public:
     CPPUNIT_ASSERT_MESSAGE("Testing value of instance uid finding of frame 3", findings.front().value == "1.2.276.0.99.1.4.8323329.3795.1303917947.940055");
   }
 
+  void ParallelScanning()
+  {
+    mitk::DICOMTagPath instanceUID(0x0008, 0x0018);
+
+    // enough files for several threads, results have to stay in input order
+    mitk::StringList files;
+    for (unsigned int i = 0; i < 8; ++i)
+    {
+      files.insert(files.end(), ctFiles.begin(), ctFiles.end());
+    }
+
+    scanner->SetInputFiles(files);
+    scanner->AddTagPath(instanceUID);
+    scanner->SetNumberOfThreads(4);
+
+    scanner->Scan();
+
+    mitk::DICOMDatasetAccessingImageFrameList frames = scanner->GetFrameInfoList();
+    CPPUNIT_ASSERT_MESSAGE("Testing DICOMDCMTKTagScanner::GetFrameInfoList()", frames.size() == files.size());
+
+    const std::string expectedUIDs[] = {"1.2.276.0.99.1.4.8323329.3795.1303917947.940051",
+                                        "1.2.276.0.99.1.4.8323329.3795.1303917947.940052",
+                                        "1.2.276.0.99.1.4.8323329.3795.1303917947.940053",
+                                        "1.2.276.0.99.1.4.8323329.3795.1303917947.940055"};
+
+    for (std::size_t i = 0; i < frames.size(); ++i)
+    {
+      CPPUNIT_ASSERT_MESSAGE("Testing order of frames", frames[i]->GetFilenameIfAvailable() == files[i]);
+
+      mitk::DICOMDatasetAccess::FindingsListType findings = frames[i]->GetTagValueAsString(instanceUID);
+      CPPUNIT_ASSERT_MESSAGE("Testing number of instance uid findings", findings.size() == 1);
+      CPPUNIT_ASSERT_MESSAGE("Testing validity of instance uid finding", findings.front().isValid);
+      CPPUNIT_ASSERT_MESSAGE("Testing value of instance uid finding", findings.front().value == expectedUIDs[i % 4]);
+    }
+  }
+
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkDICOMDCMTKTagScanner)
@@ -0,0 +1,203 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMPersistentTagCacheIndex.h"
+#include "mitkDICOMDCMTKTagScanner.h"
+#include "mitkDICOMGDCMTagScanner.h"
+#include "mitkDICOMFileReaderTestHelper.h"
+
+#include "mitkIOUtil.h"
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <itksys/SystemTools.hxx>
+
+#include <cstdio>
+#include <fstream>
+
+class mitkDICOMPersistentTagCacheIndexTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDICOMPersistentTagCacheIndexTestSuite);
+
+  MITK_TEST(DCMTKScannerUsesIndex);
+  MITK_TEST(GDCMScannerUsesIndex);
+  MITK_TEST(SaveAndLoad);
+  MITK_TEST(ChangedFilesAreIgnored);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  mitk::DICOMPersistentTagCacheIndex::Pointer index;
+  mitk::DICOMPersistentTagCacheIndex::TagPathSetType paths;
+
+  mitk::StringList ctFiles;
+  std::vector<std::string> temporaryFiles;
+
+public:
+
+  void setUp() override
+  {
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/100"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/101"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/102"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/104"));
+
+    paths.insert(mitk::DICOMTagPath(0x0008, 0x0018));
+
+    index = mitk::DICOMPersistentTagCacheIndex::New();
+  }
+
+  void tearDown() override
+  {
+    for (const auto& fileName : temporaryFiles)
+    {
+      std::remove(fileName.c_str());
+    }
+    temporaryFiles.clear();
+  }
+
+  void DCMTKScannerUsesIndex()
+  {
+    mitk::DICOMDCMTKTagScanner::Pointer scanner = mitk::DICOMDCMTKTagScanner::New();
+    scanner->SetPersistentTagCacheIndex(index);
+    scanner->SetInputFiles(ctFiles);
+    scanner->AddTagPath(*paths.begin());
+    scanner->Scan();
+
+    CPPUNIT_ASSERT_MESSAGE("Testing entries of scanned files", index->GetNumberOfEntries() == ctFiles.size());
+
+    mitk::DICOMPersistentTagCacheIndex::FindingsType findings;
+    CPPUNIT_ASSERT_MESSAGE("Testing lookup of scanned file", index->Lookup(ctFiles[0], paths, findings));
+    CPPUNIT_ASSERT_MESSAGE("Testing value of scanned file", findings.size() == 1 &&
+                           findings.front().second == "1.2.276.0.99.1.4.8323329.3795.1303917947.940051");
+
+    // a known file must not be parsed again, so a modified entry shows up in the result
+    findings.front().second = "cached";
+    index->Insert(ctFiles[0], paths, findings);
+
+    mitk::DICOMDCMTKTagScanner::Pointer secondScanner = mitk::DICOMDCMTKTagScanner::New();
+    secondScanner->SetPersistentTagCacheIndex(index);
+    secondScanner->SetInputFiles(ctFiles);
+    secondScanner->AddTagPath(*paths.begin());
+    secondScanner->Scan();
+
+    mitk::DICOMDatasetAccessingImageFrameList frames = secondScanner->GetFrameInfoList();
+    CPPUNIT_ASSERT_MESSAGE("Testing number of frames", frames.size() == ctFiles.size());
+
+    mitk::DICOMDatasetAccess::FindingsListType frameFindings = frames[0]->GetTagValueAsString(*paths.begin());
+    CPPUNIT_ASSERT_MESSAGE("Testing value of cached file", frameFindings.size() == 1 &&
+                           frameFindings.front().isValid && frameFindings.front().value == "cached");
+
+    frameFindings = frames[3]->GetTagValueAsString(*paths.begin());
+    CPPUNIT_ASSERT_MESSAGE("Testing value of other file", frameFindings.size() == 1 &&
+                           frameFindings.front().value == "1.2.276.0.99.1.4.8323329.3795.1303917947.940055");
+  }
+
+  void GDCMScannerUsesIndex()
+  {
+    const mitk::DICOMTag instanceUID(0x0008, 0x0018);
+
+    mitk::DICOMGDCMTagScanner::Pointer scanner = mitk::DICOMGDCMTagScanner::New();
+    scanner->SetPersistentTagCacheIndex(index);
+    scanner->SetInputFiles(ctFiles);
+    scanner->AddTag(instanceUID);
+    scanner->Scan();
+
+    CPPUNIT_ASSERT_MESSAGE("Testing entries of scanned files", index->GetNumberOfEntries() == ctFiles.size());
+
+    mitk::DICOMPersistentTagCacheIndex::FindingsType findings;
+    CPPUNIT_ASSERT_MESSAGE("Testing lookup of scanned file", index->Lookup(ctFiles[1], paths, findings));
+    CPPUNIT_ASSERT_MESSAGE("Testing value of scanned file", findings.size() == 1 &&
+                           findings.front().second == "1.2.276.0.99.1.4.8323329.3795.1303917947.940052");
+
+    findings.front().second = "cached";
+    index->Insert(ctFiles[1], paths, findings);
+
+    mitk::DICOMGDCMTagScanner::Pointer secondScanner = mitk::DICOMGDCMTagScanner::New();
+    secondScanner->SetPersistentTagCacheIndex(index);
+    secondScanner->SetInputFiles(ctFiles);
+    secondScanner->AddTag(instanceUID);
+    secondScanner->Scan();
+
+    mitk::DICOMDatasetAccessingImageFrameList frames = secondScanner->GetFrameInfoList();
+    CPPUNIT_ASSERT_MESSAGE("Testing number of frames", frames.size() == ctFiles.size());
+
+    mitk::DICOMDatasetFinding finding = frames[1]->GetTagValueAsString(instanceUID);
+    CPPUNIT_ASSERT_MESSAGE("Testing value of cached file", finding.isValid && finding.value == "cached");
+  }
+
+  void SaveAndLoad()
+  {
+    std::ofstream stream;
+    const std::string indexFileName = mitk::IOUtil::CreateTemporaryFile(stream, std::ios_base::binary, "XXXXXX.index");
+    stream.close();
+    temporaryFiles.push_back(indexFileName);
+
+    index->SetFileName(indexFileName);
+    mitk::DICOMDCMTKTagScanner::Pointer scanner = mitk::DICOMDCMTKTagScanner::New();
+    scanner->SetPersistentTagCacheIndex(index);
+    scanner->SetInputFiles(ctFiles);
+    scanner->AddTagPath(*paths.begin());
+    scanner->Scan();
+
+    mitk::DICOMPersistentTagCacheIndex::Pointer loadedIndex = mitk::DICOMPersistentTagCacheIndex::New();
+    loadedIndex->SetFileName(indexFileName);
+    CPPUNIT_ASSERT_MESSAGE("Testing Load()", loadedIndex->Load());
+    CPPUNIT_ASSERT_MESSAGE("Testing entries of loaded index", loadedIndex->GetNumberOfEntries() == ctFiles.size());
+
+    for (const auto& fileName : ctFiles)
+    {
+      mitk::DICOMPersistentTagCacheIndex::FindingsType expected;
+      mitk::DICOMPersistentTagCacheIndex::FindingsType loaded;
+      CPPUNIT_ASSERT(index->Lookup(fileName, paths, expected));
+      CPPUNIT_ASSERT_MESSAGE("Testing lookup in loaded index", loadedIndex->Lookup(fileName, paths, loaded));
+      CPPUNIT_ASSERT_MESSAGE("Testing number of loaded values", loaded.size() == expected.size());
+      for (std::size_t i = 0; i < loaded.size(); ++i)
+      {
+        CPPUNIT_ASSERT_MESSAGE("Testing loaded path", loaded[i].first == expected[i].first);
+        CPPUNIT_ASSERT_MESSAGE("Testing loaded value", loaded[i].second == expected[i].second);
+      }
+    }
+
+    mitk::DICOMPersistentTagCacheIndex::TagPathSetType otherPaths = paths;
+    otherPaths.insert(mitk::DICOMTagPath(0x0010, 0x0010));
+    mitk::DICOMPersistentTagCacheIndex::FindingsType findings;
+    CPPUNIT_ASSERT_MESSAGE("Testing lookup of paths that were not scanned",
+                           !loadedIndex->Lookup(ctFiles[0], otherPaths, findings));
+  }
+
+  void ChangedFilesAreIgnored()
+  {
+    std::ofstream stream;
+    const std::string fileName = mitk::IOUtil::CreateTemporaryFile(stream, std::ios_base::binary, "XXXXXX.dcm");
+    stream.close();
+    temporaryFiles.push_back(fileName);
+    CPPUNIT_ASSERT(itksys::SystemTools::CopyFileAlways(ctFiles[0], fileName));
+
+    mitk::DICOMPersistentTagCacheIndex::FindingsType findings;
+    findings.emplace_back(*paths.begin(), "value");
+    index->Insert(fileName, paths, findings);
+
+    findings.clear();
+    CPPUNIT_ASSERT_MESSAGE("Testing lookup of unchanged file", index->Lookup(fileName, paths, findings));
+
+    CPPUNIT_ASSERT(itksys::SystemTools::CopyFileAlways(ctFiles[1], fileName));
+    std::ofstream appendStream(fileName, std::ios_base::binary | std::ios_base::app);
+    appendStream << "changed";
+    appendStream.close();
+
+    CPPUNIT_ASSERT_MESSAGE("Testing lookup of changed file", !index->Lookup(fileName, paths, findings));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDICOMPersistentTagCacheIndex)
@@ -0,0 +1,138 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMTimeStepVolumeProvider.h"
+#include "mitkDICOMITKSeriesGDCMReader.h"
+
+#include "mitkImageReadAccessor.h"
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <vector>
+#include <cstring>
+
+class mitkDICOMTimeStepVolumeProviderTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDICOMTimeStepVolumeProviderTestSuite);
+
+  MITK_TEST(TimeStepsAreProvidedOnAccess);
+  MITK_TEST(InvalidTimeStepsAreNotProvided);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  mitk::Image::Pointer volume;
+  mitk::StringList sortedFiles;
+
+public:
+
+  void setUp() override
+  {
+    mitk::StringList ctFiles;
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/100"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/101"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/102"));
+
+    mitk::DICOMITKSeriesGDCMReader::Pointer reader = mitk::DICOMITKSeriesGDCMReader::New();
+    reader->SetInputFiles(ctFiles);
+    reader->AnalyzeInputFiles();
+    reader->LoadImages();
+    CPPUNIT_ASSERT_MESSAGE("Testing number of blocks", reader->GetNumberOfOutputs() == 1);
+
+    const mitk::DICOMImageBlockDescriptor &block = reader->GetOutput(0);
+    volume = block.GetMitkImage();
+    sortedFiles = block.GetFilenamesOfTimeStep(0);
+    CPPUNIT_ASSERT_MESSAGE("Testing files of time step", sortedFiles.size() == ctFiles.size());
+  }
+
+  void tearDown() override
+  {
+    volume = nullptr;
+    sortedFiles.clear();
+  }
+
+  mitk::Image::Pointer CreateImageWithProvider(
+    const mitk::DICOMTimeStepVolumeProvider::FilenamesPerTimeStepType &timeSteps)
+  {
+    const unsigned int dimensions[4] = {volume->GetDimension(0),
+                                        volume->GetDimension(1),
+                                        volume->GetDimension(2),
+                                        static_cast<unsigned int>(timeSteps.size())};
+
+    mitk::Image::Pointer image = mitk::Image::New();
+    image->Initialize(volume->GetPixelType(), 4, dimensions);
+
+    mitk::DICOMTimeStepVolumeProvider::Pointer provider = mitk::DICOMTimeStepVolumeProvider::New();
+    provider->SetTimeSteps(timeSteps, false, mitk::GantryTiltInformation());
+    image->SetVolumeProvider(provider);
+
+    return image;
+  }
+
+  void TimeStepsAreProvidedOnAccess()
+  {
+    // the second time step has the slices in reversed order
+    mitk::StringList reversedFiles(sortedFiles.rbegin(), sortedFiles.rend());
+    mitk::Image::Pointer image = CreateImageWithProvider({sortedFiles, reversedFiles});
+
+    CPPUNIT_ASSERT_MESSAGE("Testing that time steps are not decoded in advance", !image->IsVolumeSet(0) &&
+                           !image->IsVolumeSet(1));
+
+    const std::size_t sliceSize =
+      volume->GetPixelType().GetSize() * volume->GetDimension(0) * volume->GetDimension(1);
+    const unsigned int numberOfSlices = volume->GetDimension(2);
+
+    mitk::ImageReadAccessor volumeAccessor(volume);
+    const char *expected = static_cast<const char *>(volumeAccessor.GetData());
+
+    {
+      mitk::ImageReadAccessor accessor(image, image->GetVolumeData(1));
+      const char *provided = static_cast<const char *>(accessor.GetData());
+      CPPUNIT_ASSERT_MESSAGE("Testing that the accessed time step is decoded", image->IsVolumeSet(1));
+      CPPUNIT_ASSERT_MESSAGE("Testing that other time steps are not decoded", !image->IsVolumeSet(0));
+
+      for (unsigned int slice = 0; slice < numberOfSlices; ++slice)
+      {
+        CPPUNIT_ASSERT_MESSAGE("Testing reversed slice of second time step",
+                               std::memcmp(provided + slice * sliceSize,
+                                           expected + (numberOfSlices - 1 - slice) * sliceSize,
+                                           sliceSize) == 0);
+      }
+    }
+
+    {
+      mitk::ImageReadAccessor accessor(image, image->GetVolumeData(0));
+      CPPUNIT_ASSERT_MESSAGE("Testing first time step",
+                             std::memcmp(accessor.GetData(), expected, sliceSize * numberOfSlices) == 0);
+    }
+  }
+
+  void InvalidTimeStepsAreNotProvided()
+  {
+    // a time step with a different number of slices does not fit into the image
+    mitk::StringList fewerFiles(sortedFiles.begin(), sortedFiles.begin() + 1);
+    mitk::Image::Pointer image = CreateImageWithProvider({sortedFiles, fewerFiles});
+
+    CPPUNIT_ASSERT_MESSAGE("Testing time step of different size", image->GetVolumeData(1).IsNull());
+    CPPUNIT_ASSERT_MESSAGE("Testing that a failed time step is not set", !image->IsVolumeSet(1));
+
+    mitk::DICOMTimeStepVolumeProvider::Pointer provider = mitk::DICOMTimeStepVolumeProvider::New();
+    provider->SetTimeSteps({sortedFiles}, false, mitk::GantryTiltInformation());
+    std::vector<char> buffer(volume->GetPixelType().GetSize() * volume->GetDimension(0) * volume->GetDimension(1) *
+                             volume->GetDimension(2));
+    CPPUNIT_ASSERT_MESSAGE("Testing time step out of range", !provider->ProvideVolume(image, 2, 0, buffer.data()));
+    CPPUNIT_ASSERT_MESSAGE("Testing channel out of range", !provider->ProvideVolume(image, 0, 1, buffer.data()));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDICOMTimeStepVolumeProvider)
@@ -1,7 +1,9 @@
 set(H_FILES
   include/mitkTestDICOMLoading.h
+  include/mitkTestDICOMSeriesGenerator.h
 )
 
 set(CPP_FILES
   mitkTestDICOMLoading.cpp
+  mitkTestDICOMSeriesGenerator.cpp
 )
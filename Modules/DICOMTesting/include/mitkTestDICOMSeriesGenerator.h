@@ -0,0 +1,78 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkTestDICOMSeriesGenerator_h
+#define mitkTestDICOMSeriesGenerator_h
+
+#include "mitkDICOMEnums.h"
+
+#include "MitkDICOMTestingExports.h"
+
+namespace mitk
+{
+
+/**
+  \brief Writes synthetic CT series for tests and benchmarks of the DICOM readers.
+
+  All series belong to one study and one frame of reference. The output only depends
+  on the settings, i.e. calling Generate() twice with the same settings (including the seed)
+  writes identical files, so load times of different versions can be compared.
+
+  The returned file list mimics the sorting complexity of real data:
+    - with more than one series, the slices of the series are interleaved
+    - with Shuffle, the files are returned in a (seeded) random order
+    - with a gantry tilt, the slice origins are sheared as in tilted CT acquisitions
+*/
+class MITKDICOMTESTING_EXPORT TestDICOMSeriesGenerator
+{
+  public:
+
+    enum TransferSyntax
+    {
+      ImplicitVRLittleEndian,
+      ExplicitVRLittleEndian,
+      ExplicitVRBigEndian,
+      RLELossless,
+      JPEGLossless
+    };
+
+    struct Settings
+    {
+      Settings();
+
+      unsigned int Rows;
+      unsigned int Columns;
+      unsigned int NumberOfSlices;
+      unsigned int NumberOfSeries;
+      TransferSyntax Syntax;
+      /// gantry tilt in degrees, 0 for untilted slices
+      double GantryTilt;
+      double PixelSpacing;
+      double SliceDistance;
+      bool Shuffle;
+      unsigned int Seed;
+    };
+
+    /**
+      \brief Writes the series into an existing directory.
+      \return the file names in the order described in the class documentation.
+      \throws std::exception if a file cannot be written.
+    */
+    static StringList Generate(const std::string& directory, const Settings& settings);
+
+    static TransferSyntax TransferSyntaxFromString(const std::string& name);
+    static std::string TransferSyntaxToString(TransferSyntax syntax);
+};
+
+}
+
+#endif
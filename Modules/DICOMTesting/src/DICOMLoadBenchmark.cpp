@@ -0,0 +1,214 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestDICOMSeriesGenerator.h"
+#include "mitkClassicDICOMSeriesReader.h"
+#include "mitkDICOMGDCMTagScanner.h"
+
+#include <itksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+/*
+  Generates a synthetic DICOM data set (see mitk::TestDICOMSeriesGenerator) and measures
+  the three phases of loading it separately:
+    - scan: reading the tags of interest of all files
+    - sort: splitting and sorting the files into blocks (AnalyzeInputFiles())
+    - decode: loading the pixel data of all blocks (LoadImages())
+
+  Returns a non-zero value if the data set is not sorted into one block per generated series.
+*/
+
+namespace
+{
+  typedef std::chrono::steady_clock Clock;
+
+  struct PhaseTimes
+  {
+    std::vector<double> Scan;
+    std::vector<double> Sort;
+    std::vector<double> Decode;
+  };
+
+  double Milliseconds(const Clock::time_point& start, const Clock::time_point& end)
+  {
+    return std::chrono::duration<double, std::milli>(end - start).count();
+  }
+
+  void PrintPhase(const std::string& name, std::vector<double> times)
+  {
+    std::sort(times.begin(), times.end());
+    const double mean = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+
+    std::cout << std::left << std::setw(8) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(12) << times.front()
+              << std::setw(12) << times[times.size() / 2]
+              << std::setw(12) << mean
+              << std::setw(12) << times.back() << "\n";
+  }
+
+  void PrintUsage(const char* executable)
+  {
+    std::cerr << "Usage: " << executable << " <output directory> [options]\n"
+              << "  --rows <n>           rows per slice (default 256)\n"
+              << "  --columns <n>        columns per slice (default 256)\n"
+              << "  --slices <n>         slices per series (default 100)\n"
+              << "  --series <n>         interleaved series (default 1)\n"
+              << "  --syntax <name>      implicit, explicit, bigendian, rle or jpeglossless (default explicit)\n"
+              << "  --tilt <degrees>     gantry tilt (default 0)\n"
+              << "  --shuffle            pass the files in random order\n"
+              << "  --seed <n>           seed of the generated data (default 1)\n"
+              << "  --reader <name>      classic or itk (default classic)\n"
+              << "  --repetitions <n>    number of measurements (default 5)\n";
+  }
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 2)
+  {
+    PrintUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  const std::string directory = argv[1];
+  mitk::TestDICOMSeriesGenerator::Settings settings;
+  std::string readerName = "classic";
+  unsigned int repetitions = 5;
+
+  try
+  {
+    for (int arg = 2; arg < argc; ++arg)
+    {
+      const std::string option = argv[arg];
+      if (option == "--shuffle")
+      {
+        settings.Shuffle = true;
+        continue;
+      }
+
+      if (arg + 1 >= argc)
+      {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+      }
+
+      const std::string value = argv[++arg];
+      if (option == "--rows") settings.Rows = std::stoul(value);
+      else if (option == "--columns") settings.Columns = std::stoul(value);
+      else if (option == "--slices") settings.NumberOfSlices = std::stoul(value);
+      else if (option == "--series") settings.NumberOfSeries = std::stoul(value);
+      else if (option == "--syntax") settings.Syntax = mitk::TestDICOMSeriesGenerator::TransferSyntaxFromString(value);
+      else if (option == "--tilt") settings.GantryTilt = std::stod(value);
+      else if (option == "--seed") settings.Seed = std::stoul(value);
+      else if (option == "--reader") readerName = value;
+      else if (option == "--repetitions") repetitions = std::max(1ul, std::stoul(value));
+      else
+      {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "Invalid option: " << e.what() << "\n";
+    PrintUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  if (readerName != "classic" && readerName != "itk")
+  {
+    PrintUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  mitk::StringList files;
+  try
+  {
+    itksys::SystemTools::MakeDirectory(directory);
+    files = mitk::TestDICOMSeriesGenerator::Generate(directory, settings);
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "Could not generate data: " << e.what() << "\n";
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Data: " << settings.NumberOfSeries << " series x " << settings.NumberOfSlices << " slices of "
+            << settings.Columns << "x" << settings.Rows << ", "
+            << mitk::TestDICOMSeriesGenerator::TransferSyntaxToString(settings.Syntax)
+            << ", tilt " << settings.GantryTilt << ", " << (settings.Shuffle ? "shuffled" : "interleaved")
+            << ", reader " << readerName << "\n";
+
+  PhaseTimes times;
+  unsigned int numberOfOutputs = 0;
+  for (unsigned int repetition = 0; repetition < repetitions; ++repetition)
+  {
+    mitk::DICOMITKSeriesGDCMReader::Pointer reader;
+    if (readerName == "classic")
+    {
+      mitk::ClassicDICOMSeriesReader::Pointer classicReader = mitk::ClassicDICOMSeriesReader::New();
+      classicReader->SetFixTiltByShearing(true);
+      reader = classicReader.GetPointer();
+    }
+    else
+    {
+      reader = mitk::DICOMITKSeriesGDCMReader::New();
+    }
+
+    const Clock::time_point start = Clock::now();
+
+    mitk::DICOMGDCMTagScanner::Pointer scanner = mitk::DICOMGDCMTagScanner::New();
+    scanner->SetInputFiles(files);
+    scanner->AddTagPaths(reader->GetTagsOfInterest());
+    scanner->Scan();
+
+    const Clock::time_point scanned = Clock::now();
+
+    reader->SetInputFiles(files);
+    reader->SetTagCache(scanner->GetScanCache());
+    reader->AnalyzeInputFiles();
+
+    const Clock::time_point sorted = Clock::now();
+
+    reader->LoadImages();
+
+    const Clock::time_point decoded = Clock::now();
+
+    times.Scan.push_back(Milliseconds(start, scanned));
+    times.Sort.push_back(Milliseconds(scanned, sorted));
+    times.Decode.push_back(Milliseconds(sorted, decoded));
+    numberOfOutputs = reader->GetNumberOfOutputs();
+  }
+
+  std::cout << std::left << std::setw(8) << "[ms]" << std::right
+            << std::setw(12) << "min" << std::setw(12) << "median"
+            << std::setw(12) << "mean" << std::setw(12) << "max" << "\n";
+  PrintPhase("scan", times.Scan);
+  PrintPhase("sort", times.Sort);
+  PrintPhase("decode", times.Decode);
+
+  if (numberOfOutputs != settings.NumberOfSeries)
+  {
+    std::cerr << "Expected " << settings.NumberOfSeries << " blocks, reader produced " << numberOfOutputs << "\n";
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
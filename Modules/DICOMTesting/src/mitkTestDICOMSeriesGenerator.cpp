@@ -0,0 +1,253 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestDICOMSeriesGenerator.h"
+
+#include <gdcmAttribute.h>
+#include <gdcmImageChangeTransferSyntax.h>
+#include <gdcmImageWriter.h>
+#include <gdcmUIDGenerator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+  const char* const CTImageStorage = "1.2.840.10008.5.1.4.1.1.2";
+
+  gdcm::TransferSyntax::TSType ToGDCMTransferSyntax(mitk::TestDICOMSeriesGenerator::TransferSyntax syntax)
+  {
+    switch (syntax)
+    {
+      case mitk::TestDICOMSeriesGenerator::ImplicitVRLittleEndian:
+        return gdcm::TransferSyntax::ImplicitVRLittleEndian;
+      case mitk::TestDICOMSeriesGenerator::ExplicitVRBigEndian:
+        return gdcm::TransferSyntax::ExplicitVRBigEndian;
+      case mitk::TestDICOMSeriesGenerator::RLELossless:
+        return gdcm::TransferSyntax::RLELossless;
+      case mitk::TestDICOMSeriesGenerator::JPEGLossless:
+        return gdcm::TransferSyntax::JPEGLosslessProcess14_1;
+      case mitk::TestDICOMSeriesGenerator::ExplicitVRLittleEndian:
+      default:
+        return gdcm::TransferSyntax::ExplicitVRLittleEndian;
+    }
+  }
+
+  // uses the raw engine output, std::uniform_int_distribution differs between standard libraries
+  std::vector<std::int16_t> CreatePixels(unsigned int rows,
+                                         unsigned int columns,
+                                         unsigned int slice,
+                                         std::mt19937& random)
+  {
+    std::vector<std::int16_t> pixels(static_cast<std::size_t>(rows) * columns);
+
+    const double centerX = 0.5 * columns;
+    const double centerY = 0.5 * rows;
+    const double radius = 0.4 * std::min(rows, columns);
+
+    auto pixel = pixels.begin();
+    for (unsigned int y = 0; y < rows; ++y)
+    {
+      for (unsigned int x = 0; x < columns; ++x, ++pixel)
+      {
+        // a "body" of soft tissue with some structure that changes from slice to slice, air around it
+        const double distance = std::sqrt((x - centerX) * (x - centerX) + (y - centerY) * (y - centerY));
+        const int noise = static_cast<int>(random() % 41) - 20;
+        const int tissue = distance < radius ? 40 + static_cast<int>((x + y + 3 * slice) % 64) : -1000;
+        *pixel = static_cast<std::int16_t>(tissue + noise);
+      }
+    }
+
+    return pixels;
+  }
+
+  template <uint16_t Group, uint16_t Element, typename T>
+  void SetAttribute(gdcm::DataSet& dataset, const T& value)
+  {
+    gdcm::Attribute<Group, Element> attribute;
+    attribute.SetValue(value);
+    dataset.Replace(attribute.GetAsDataElement());
+  }
+}
+
+mitk::TestDICOMSeriesGenerator::Settings::Settings()
+: Rows(256),
+  Columns(256),
+  NumberOfSlices(100),
+  NumberOfSeries(1),
+  Syntax(ExplicitVRLittleEndian),
+  GantryTilt(0.0),
+  PixelSpacing(0.8),
+  SliceDistance(2.0),
+  Shuffle(false),
+  Seed(1)
+{
+}
+
+mitk::StringList
+mitk::TestDICOMSeriesGenerator
+::Generate(const std::string& directory, const Settings& settings)
+{
+  if (settings.Rows == 0 || settings.Columns == 0 || settings.NumberOfSlices == 0 || settings.NumberOfSeries == 0)
+  {
+    throw std::invalid_argument("Synthetic DICOM series need at least one series, slice, row and column.");
+  }
+
+  // fixed UIDs make the generated files reproducible
+  std::stringstream uidRoot;
+  uidRoot << gdcm::UIDGenerator::GetGDCMUID() << ".1." << settings.Seed;
+  const std::string studyUID = uidRoot.str() + ".1";
+  const std::string frameOfReferenceUID = uidRoot.str() + ".2";
+
+  const double iop[6] = { 1.0, 0.0, 0.0, 0.0, 1.0, 0.0 };
+  const double spacing[3] = { settings.PixelSpacing, settings.PixelSpacing, settings.SliceDistance };
+  const double pi = 3.14159265358979323846;
+  const double tiltShearPerSlice = settings.SliceDistance * std::tan(settings.GantryTilt * pi / 180.0);
+
+  std::vector<StringList> filenamesPerSeries(settings.NumberOfSeries);
+  for (unsigned int series = 0; series < settings.NumberOfSeries; ++series)
+  {
+    const std::string seriesUID = uidRoot.str() + ".3." + std::to_string(series + 1);
+
+    for (unsigned int slice = 0; slice < settings.NumberOfSlices; ++slice)
+    {
+      std::stringstream filename;
+      filename << directory << "/series" << std::setw(3) << std::setfill('0') << series + 1
+               << "_slice" << std::setw(5) << std::setfill('0') << slice + 1 << ".dcm";
+
+      std::mt19937 random(settings.Seed + series * settings.NumberOfSlices + slice);
+      const std::vector<std::int16_t> pixels = CreatePixels(settings.Rows, settings.Columns, slice, random);
+
+      gdcm::Image image;
+      image.SetNumberOfDimensions(2);
+      image.SetDimension(0, settings.Columns);
+      image.SetDimension(1, settings.Rows);
+      image.SetPixelFormat(gdcm::PixelFormat::INT16);
+      image.SetPhotometricInterpretation(gdcm::PhotometricInterpretation::MONOCHROME2);
+      image.SetTransferSyntax(gdcm::TransferSyntax::ExplicitVRLittleEndian);
+      image.SetSpacing(spacing);
+      image.SetDirectionCosines(iop);
+
+      // a tilted gantry shifts the origins of the (axial) slices along the image rows
+      const double origin[3] = { 0.0, slice * tiltShearPerSlice, slice * settings.SliceDistance };
+      image.SetOrigin(origin);
+
+      gdcm::DataElement pixelData(gdcm::Tag(0x7fe0, 0x0010));
+      pixelData.SetByteValue(reinterpret_cast<const char*>(pixels.data()),
+                             static_cast<uint32_t>(pixels.size() * sizeof(std::int16_t)));
+      image.SetDataElement(pixelData);
+
+      gdcm::ImageWriter writer;
+      const gdcm::TransferSyntax::TSType syntax = ToGDCMTransferSyntax(settings.Syntax);
+      if (syntax != gdcm::TransferSyntax::ExplicitVRLittleEndian)
+      {
+        gdcm::ImageChangeTransferSyntax change;
+        change.SetTransferSyntax(syntax);
+        change.SetInput(image);
+        if (!change.Change())
+        {
+          throw std::runtime_error("Cannot encode synthetic DICOM slice as " + TransferSyntaxToString(settings.Syntax));
+        }
+        writer.SetImage(change.GetOutput());
+      }
+      else
+      {
+        writer.SetImage(image);
+      }
+
+      gdcm::DataSet& dataset = writer.GetFile().GetDataSet();
+      SetAttribute<0x0008, 0x0016>(dataset, CTImageStorage);
+      SetAttribute<0x0008, 0x0018>(dataset,
+        (uidRoot.str() + ".4." + std::to_string(series + 1) + "." + std::to_string(slice + 1)).c_str());
+      SetAttribute<0x0008, 0x0020>(dataset, "20200101");
+      SetAttribute<0x0008, 0x0060>(dataset, "CT");
+      SetAttribute<0x0008, 0x103e>(dataset, ("Synthetic series " + std::to_string(series + 1)).c_str());
+      SetAttribute<0x0010, 0x0010>(dataset, "Synthetic^Patient");
+      SetAttribute<0x0010, 0x0020>(dataset, "SYNTHETIC");
+      SetAttribute<0x0018, 0x0050>(dataset, settings.SliceDistance);
+      SetAttribute<0x0018, 0x1120>(dataset, settings.GantryTilt);
+      SetAttribute<0x0020, 0x000d>(dataset, studyUID.c_str());
+      SetAttribute<0x0020, 0x000e>(dataset, seriesUID.c_str());
+      SetAttribute<0x0020, 0x0011>(dataset, static_cast<int>(series + 1));
+      SetAttribute<0x0020, 0x0013>(dataset, static_cast<int>(slice + 1));
+      SetAttribute<0x0020, 0x0052>(dataset, frameOfReferenceUID.c_str());
+      SetAttribute<0x0020, 0x1041>(dataset, origin[2]);
+
+      writer.SetFileName(filename.str().c_str());
+      if (!writer.Write())
+      {
+        throw std::runtime_error("Cannot write synthetic DICOM file " + filename.str());
+      }
+
+      filenamesPerSeries[series].push_back(filename.str());
+    }
+  }
+
+  // interleave the series slice by slice
+  StringList filenames;
+  for (unsigned int slice = 0; slice < settings.NumberOfSlices; ++slice)
+  {
+    for (unsigned int series = 0; series < settings.NumberOfSeries; ++series)
+    {
+      filenames.push_back(filenamesPerSeries[series][slice]);
+    }
+  }
+
+  if (settings.Shuffle)
+  {
+    // Fisher-Yates with the raw engine output, std::shuffle differs between standard libraries
+    std::mt19937 random(settings.Seed);
+    for (std::size_t i = filenames.size() - 1; i > 0; --i)
+    {
+      std::swap(filenames[i], filenames[random() % (i + 1)]);
+    }
+  }
+
+  return filenames;
+}
+
+mitk::TestDICOMSeriesGenerator::TransferSyntax
+mitk::TestDICOMSeriesGenerator
+::TransferSyntaxFromString(const std::string& name)
+{
+  for (const auto syntax : { ImplicitVRLittleEndian, ExplicitVRLittleEndian, ExplicitVRBigEndian, RLELossless,
+                             JPEGLossless })
+  {
+    if (name == TransferSyntaxToString(syntax))
+    {
+      return syntax;
+    }
+  }
+
+  throw std::invalid_argument("Unknown transfer syntax '" + name + "'");
+}
+
+std::string
+mitk::TestDICOMSeriesGenerator
+::TransferSyntaxToString(TransferSyntax syntax)
+{
+  switch (syntax)
+  {
+    case ImplicitVRLittleEndian: return "implicit";
+    case ExplicitVRLittleEndian: return "explicit";
+    case ExplicitVRBigEndian: return "bigendian";
+    case RLELossless: return "rle";
+    case JPEGLossless: return "jpeglossless";
+    default: return "unknown";
+  }
+}
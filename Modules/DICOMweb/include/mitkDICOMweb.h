@@ -17,7 +17,9 @@ found in the LICENSE file.
 
 #include "cpprest/asyncrt_utils.h"
 #include "cpprest/http_client.h"
+#include <functional>
 #include <iostream>
+#include <vector>
 #include <mitkCommon.h>
 #include <mitkIRESTManager.h>
 #include <mitkRESTUtil.h>
@@ -44,6 +46,23 @@ namespace mitk
    typedef web::http::http_response MitkResponse;
    typedef web::http::methods MitkRESTMethods;
 
+   /**
+    * @brief One part of a multipart/related WADO-RS response, e.g. a DICOM object instance or a frame.
+    */
+   struct MultipartPart
+   {
+     utility::string_t contentType;
+     utility::string_t contentLocation;
+     std::vector<unsigned char> data;
+   };
+
+   typedef std::vector<MultipartPart> MultipartPartList;
+
+   /**
+    * @brief Called for every retrieved instance of a series with the SOP instance uid and the parts of the response.
+    */
+   typedef std::function<void(const utility::string_t &instanceUID, MultipartPartList &parts)> InstanceCallback;
+
    DICOMweb();
 
    /**
@@ -91,6 +110,55 @@ namespace mitk
                                     utility::string_t studyUID,
                                     utility::string_t seriesUID);
 
+   /**
+    * @brief Sends a WADO-RS request for a DICOM object instance and keeps the response in memory.
+    *
+    * @param studyUID the DICOM study uid
+    * @param seriesUID the DICOM series uid
+    * @param instanceUID the DICOM instance uid
+    * @return the task to wait for, which unfolds the parts of the multipart response, one per DICOM object
+    */
+   pplx::task<MultipartPartList> SendWADORS(utility::string_t studyUID,
+                                            utility::string_t seriesUID,
+                                            utility::string_t instanceUID);
+
+   /**
+    * @brief Retrieves all instances of a series with WADO-RS. The instances are requested concurrently, at most
+    * GetMaximumNumberOfConcurrentRequests() at a time, and handed to the callback as soon as they arrived.
+    *
+    * The callback is called from the threads of the task scheduler, but never concurrently.
+    *
+    * @param studyUID the DICOM study uid
+    * @param seriesUID the DICOM series uid
+    * @param callback processes the parts of each retrieved instance, e.g. parses the DICOM objects from memory
+    * @return the task to wait for, which unfolds the number of retrieved instances
+    */
+   pplx::task<unsigned int> SendWADORS(utility::string_t studyUID,
+                                       utility::string_t seriesUID,
+                                       InstanceCallback callback);
+
+   /**
+    * @brief Sends a WADO-RS request for single frames of a DICOM object instance, e.g. to load the frames of a
+    * multi-frame instance lazily.
+    *
+    * @param studyUID the DICOM study uid
+    * @param seriesUID the DICOM series uid
+    * @param instanceUID the DICOM instance uid
+    * @param frameNumbers the frame numbers, starting at 1
+    * @return the task to wait for, which unfolds the pixel data of the frames in the requested order
+    */
+   pplx::task<MultipartPartList> SendWADORSFrames(utility::string_t studyUID,
+                                                  utility::string_t seriesUID,
+                                                  utility::string_t instanceUID,
+                                                  std::vector<unsigned int> frameNumbers);
+
+   /**
+    * @brief Sets the maximum number of WADO-RS requests that are sent concurrently when retrieving a series.
+    * Values below 1 are treated as 1, the default is 8.
+    */
+   void SetMaximumNumberOfConcurrentRequests(unsigned int number);
+   unsigned int GetMaximumNumberOfConcurrentRequests() const;
+
    /**
     * @brief Sends a QIDO request containing the given parameters to filter the query.
     *
@@ -118,6 +186,18 @@ namespace mitk
                                    utility::string_t seriesUID,
                                    utility::string_t instanceUID);
 
+   /**
+    * @brief Creates a WADO-RS request URI for an instance, or for the series if the instance uid is empty
+    */
+   utility::string_t CreateWADORSUri(utility::string_t studyUID,
+                                     utility::string_t seriesUID,
+                                     utility::string_t instanceUID);
+
+   /**
+    * @brief Sends a GET request with the given Accept header and splits the multipart response into its parts
+    */
+   pplx::task<MultipartPartList> SendMultipartRequest(utility::string_t uri, utility::string_t accept);
+
    /**
     * @brief Creates a STOW request URI with the study uid
     */
@@ -131,6 +211,7 @@ namespace mitk
 
    utility::string_t m_BaseURI;
    mitk::IRESTManager *m_RESTManager;
+   unsigned int m_MaximumNumberOfConcurrentRequests;
  };
 }
 
@@ -12,9 +12,142 @@ found in the LICENSE file.
 
 #include "mitkDICOMweb.h"
 
-mitk::DICOMweb::DICOMweb() {}
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <memory>
+#include <mutex>
 
-mitk::DICOMweb::DICOMweb(utility::string_t baseURI) : m_BaseURI(baseURI)
+namespace
+{
+  /**
+   * @brief Extracts the boundary parameter of a multipart content type.
+   */
+  std::string GetMultipartBoundary(const utility::string_t &contentType)
+  {
+    auto type = mitk::RESTUtil::convertToUtf8(contentType);
+    std::string lowerType = type;
+    std::transform(lowerType.begin(), lowerType.end(), lowerType.begin(), ::tolower);
+
+    auto position = lowerType.find("boundary=");
+    if (std::string::npos == position)
+      return std::string();
+
+    auto boundary = type.substr(position + 9);
+    if (!boundary.empty() && '"' == boundary[0])
+    {
+      auto end = boundary.find('"', 1);
+      return boundary.substr(1, std::string::npos == end ? std::string::npos : end - 1);
+    }
+
+    return boundary.substr(0, boundary.find_first_of("; \t"));
+  }
+
+  /**
+   * @brief Splits a multipart body (RFC 2046) into its parts without copying it to a file.
+   */
+  mitk::DICOMweb::MultipartPartList ParseMultipartBody(const std::vector<unsigned char> &body,
+                                                      const std::string &boundary)
+  {
+    mitk::DICOMweb::MultipartPartList parts;
+
+    const std::string delimiter = "--" + boundary;
+    const std::string headerEnd = "\r\n\r\n";
+
+    auto position = std::search(body.begin(), body.end(), delimiter.begin(), delimiter.end());
+    while (position != body.end())
+    {
+      position += delimiter.size();
+
+      // the closing delimiter is followed by "--"
+      if (body.end() - position >= 2 && '-' == position[0] && '-' == position[1])
+        break;
+
+      auto headersEnd = std::search(position, body.end(), headerEnd.begin(), headerEnd.end());
+      if (headersEnd == body.end())
+        break;
+
+      mitk::DICOMweb::MultipartPart part;
+
+      std::string headers(position, headersEnd);
+      std::string::size_type lineStart = 0;
+      while (lineStart < headers.size())
+      {
+        auto lineEnd = headers.find("\r\n", lineStart);
+        auto line = headers.substr(lineStart, std::string::npos == lineEnd ? std::string::npos : lineEnd - lineStart);
+        lineStart = std::string::npos == lineEnd ? headers.size() : lineEnd + 2;
+
+        auto colon = line.find(':');
+        if (std::string::npos == colon)
+          continue;
+
+        auto name = line.substr(0, colon);
+        std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+        auto valueStart = line.find_first_not_of(" \t", colon + 1);
+        auto value = std::string::npos == valueStart ? std::string() : line.substr(valueStart);
+
+        if ("content-type" == name)
+          part.contentType = mitk::RESTUtil::convertToTString(value);
+        else if ("content-location" == name)
+          part.contentLocation = mitk::RESTUtil::convertToTString(value);
+      }
+
+      auto dataBegin = headersEnd + headerEnd.size();
+      const std::string nextDelimiter = "\r\n" + delimiter;
+      auto dataEnd = std::search(dataBegin, body.end(), nextDelimiter.begin(), nextDelimiter.end());
+      if (dataEnd == body.end())
+        mitkThrow() << "Truncated multipart response: missing boundary " << boundary;
+
+      part.data.assign(dataBegin, dataEnd);
+      parts.push_back(std::move(part));
+
+      position = dataEnd + 2;
+    }
+
+    return parts;
+  }
+
+  /**
+   * @brief Shared state of the requests retrieving the instances of a series.
+   */
+  struct SeriesRetrieval
+  {
+    utility::string_t studyUID;
+    utility::string_t seriesUID;
+    std::vector<utility::string_t> instanceUIDs;
+    mitk::DICOMweb::InstanceCallback callback;
+    std::atomic<std::size_t> nextInstance;
+    std::atomic<unsigned int> numberOfRetrievedInstances;
+    std::mutex callbackMutex;
+  };
+
+  /**
+   * @brief Retrieves the remaining instances of a series one after another, so several of these chains
+   * limit the number of concurrent requests.
+   */
+  pplx::task<void> RetrieveRemainingInstances(mitk::DICOMweb *dicomWeb, std::shared_ptr<SeriesRetrieval> retrieval)
+  {
+    auto index = retrieval->nextInstance++;
+    if (index >= retrieval->instanceUIDs.size())
+      return pplx::task_from_result();
+
+    auto instanceUID = retrieval->instanceUIDs[index];
+    return dicomWeb->SendWADORS(retrieval->studyUID, retrieval->seriesUID, instanceUID)
+      .then([=](mitk::DICOMweb::MultipartPartList parts) {
+        {
+          std::lock_guard<std::mutex> lock(retrieval->callbackMutex);
+          retrieval->callback(instanceUID, parts);
+        }
+        ++retrieval->numberOfRetrievedInstances;
+        return RetrieveRemainingInstances(dicomWeb, retrieval);
+      });
+  }
+}
+
+mitk::DICOMweb::DICOMweb() : m_RESTManager(nullptr), m_MaximumNumberOfConcurrentRequests(8) {}
+
+mitk::DICOMweb::DICOMweb(utility::string_t baseURI)
+  : m_BaseURI(baseURI), m_RESTManager(nullptr), m_MaximumNumberOfConcurrentRequests(8)
 {
   MITK_INFO << "base uri: " << mitk::RESTUtil::convertToUtf8(m_BaseURI);
   InitializeRESTManager();
@@ -46,6 +179,24 @@ utility::string_t mitk::DICOMweb::CreateWADOUri(utility::string_t studyUID,
   return builder.to_string();
 }
 
+utility::string_t mitk::DICOMweb::CreateWADORSUri(utility::string_t studyUID,
+                                                  utility::string_t seriesUID,
+                                                  utility::string_t instanceUID)
+{
+  MitkUriBuilder builder(m_BaseURI + U("rs/studies"));
+  builder.append_path(studyUID);
+  builder.append_path(U("series"));
+  builder.append_path(seriesUID);
+
+  if (!instanceUID.empty())
+  {
+    builder.append_path(U("instances"));
+    builder.append_path(instanceUID);
+  }
+
+  return builder.to_string();
+}
+
 utility::string_t mitk::DICOMweb::CreateSTOWUri(utility::string_t studyUID)
 {
   MitkUriBuilder builder(m_BaseURI + U("rs/studies"));
@@ -193,6 +344,123 @@ pplx::task<std::string> mitk::DICOMweb::SendWADO(utility::string_t folderPath,
   });
 }
 
+pplx::task<mitk::DICOMweb::MultipartPartList> mitk::DICOMweb::SendMultipartRequest(utility::string_t uri,
+                                                                                   utility::string_t accept)
+{
+  web::http::client::http_client_config config;
+  config.set_validate_certificates(false);
+  auto client = std::make_shared<web::http::client::http_client>(uri, config);
+
+  MitkRequest request(MitkRESTMethods::GET);
+  request.headers().add(U("Accept"), accept);
+
+  // the client has to live until the body is read
+  return client->request(request).then([client](MitkResponse response) {
+    auto status = response.status_code();
+    if (web::http::status_codes::OK != status && web::http::status_codes::PartialContent != status)
+    {
+      MITK_WARN << "Status: " << status;
+      mitkThrow() << mitk::RESTUtil::convertToUtf8(response.to_string());
+    }
+
+    auto boundary = GetMultipartBoundary(response.headers().content_type());
+    if (boundary.empty())
+      mitkThrow() << "WADO-RS response is not a multipart response: "
+                  << mitk::RESTUtil::convertToUtf8(response.headers().content_type());
+
+    return response.extract_vector().then([client, boundary](std::vector<unsigned char> body) {
+      return ParseMultipartBody(body, boundary);
+    });
+  });
+}
+
+pplx::task<mitk::DICOMweb::MultipartPartList> mitk::DICOMweb::SendWADORS(utility::string_t studyUID,
+                                                                         utility::string_t seriesUID,
+                                                                         utility::string_t instanceUID)
+{
+  auto uri = CreateWADORSUri(studyUID, seriesUID, instanceUID);
+  return SendMultipartRequest(uri, U("multipart/related; type=\"application/dicom\""));
+}
+
+pplx::task<unsigned int> mitk::DICOMweb::SendWADORS(utility::string_t studyUID,
+                                                    utility::string_t seriesUID,
+                                                    InstanceCallback callback)
+{
+  mitk::RESTUtil::ParamMap seriesInstances;
+  seriesInstances.insert(mitk::RESTUtil::ParamMap::value_type(U("StudyInstanceUID"), studyUID));
+  seriesInstances.insert(mitk::RESTUtil::ParamMap::value_type(U("SeriesInstanceUID"), seriesUID));
+
+  return SendQIDO(seriesInstances).then([=](web::json::value jsonResult) -> pplx::task<unsigned int> {
+    auto retrieval = std::make_shared<SeriesRetrieval>();
+    retrieval->studyUID = studyUID;
+    retrieval->seriesUID = seriesUID;
+    retrieval->callback = callback;
+    retrieval->nextInstance = 0;
+    retrieval->numberOfRetrievedInstances = 0;
+
+    try
+    {
+      for (auto &instance : jsonResult.as_array())
+      {
+        auto valueArray = instance.at(U("00080018")).as_object().at(U("Value")).as_array();
+        retrieval->instanceUIDs.push_back(valueArray[0].as_string());
+      }
+    }
+    catch (const web::json::json_exception &e)
+    {
+      MITK_ERROR << e.what();
+      mitkThrow() << e.what();
+    }
+
+    auto numberOfChains = std::min<std::size_t>(std::max(1u, m_MaximumNumberOfConcurrentRequests),
+                                                retrieval->instanceUIDs.size());
+
+    std::vector<pplx::task<void>> chains;
+    for (std::size_t i = 0; i < numberOfChains; ++i)
+    {
+      chains.push_back(RetrieveRemainingInstances(this, retrieval));
+    }
+
+    return pplx::when_all(begin(chains), end(chains)).then([retrieval](void) -> unsigned int {
+      return retrieval->numberOfRetrievedInstances;
+    });
+  });
+}
+
+pplx::task<mitk::DICOMweb::MultipartPartList> mitk::DICOMweb::SendWADORSFrames(utility::string_t studyUID,
+                                                                               utility::string_t seriesUID,
+                                                                               utility::string_t instanceUID,
+                                                                               std::vector<unsigned int> frameNumbers)
+{
+  if (frameNumbers.empty())
+    return pplx::task_from_result(MultipartPartList());
+
+  utility::string_t frameList;
+  for (auto frameNumber : frameNumbers)
+  {
+    if (!frameList.empty())
+      frameList += U(",");
+
+    frameList += utility::conversions::to_string_t(std::to_string(frameNumber));
+  }
+
+  MitkUriBuilder builder(CreateWADORSUri(studyUID, seriesUID, instanceUID));
+  builder.append_path(U("frames"));
+  builder.append_path(frameList);
+
+  return SendMultipartRequest(builder.to_string(), U("multipart/related; type=\"application/octet-stream\""));
+}
+
+void mitk::DICOMweb::SetMaximumNumberOfConcurrentRequests(unsigned int number)
+{
+  m_MaximumNumberOfConcurrentRequests = std::max(1u, number);
+}
+
+unsigned int mitk::DICOMweb::GetMaximumNumberOfConcurrentRequests() const
+{
+  return m_MaximumNumberOfConcurrentRequests;
+}
+
 pplx::task<web::json::value> mitk::DICOMweb::SendQIDO(mitk::RESTUtil::ParamMap map)
 {
   auto uri = CreateQIDOUri(map);
@@ -76,6 +76,9 @@ namespace mitk
     Image *GetImage() { return m_Image; }
     Image::Pointer GetDiffImage();
 
+    /// the size of the compressed difference image
+    std::size_t GetMemorySize() const override;
+
     bool IsImageStillValid() { return m_ImageStillValid; }
   };
 
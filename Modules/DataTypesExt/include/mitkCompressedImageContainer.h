@@ -21,6 +21,7 @@ found in the LICENSE file.
 
 #include <itkObject.h>
 
+#include <future>
 #include <vector>
 
 namespace mitk
@@ -30,6 +31,14 @@ namespace mitk
 
     Uses zlib to compress the data of an mitk::Image.
 
+    Optionally, only the pixels that differ from a reference image are stored (see
+    SetImage(Image*, const Image*)). Such a delta needs the reference image again to
+    restore the image, see GetImage(const Image*).
+
+    In asynchronous mode (see SetAsynchronous()) SetImage() only copies the pixel data and
+    the compression runs on a background thread. The container holds the uncompressed copy
+    until the compression is done. GetImage() waits only if the compression is still pending.
+
     $Author$
   */
   class MITKDATATYPESEXT_EXPORT CompressedImageContainer : public itk::Object
@@ -47,19 +56,96 @@ namespace mitk
        */
       void SetImage(Image *);
 
+    /**
+     * \brief Creates a compressed version of the pixels of the image that differ from @a referenceImage.
+     *
+     * If @a referenceImage is nullptr or differs in pixel type or size, the complete image is stored.
+     * Will not hold any further SmartPointers to the images.
+     */
+    void SetImage(Image *image, const Image *referenceImage);
+
     /**
      * \brief Creates a full mitk::Image from its compressed version.
      *
      * This Method hold no buffer, so the uncompression algorithm will be
      * executed every time you call this method. Don't overdo it.
      *
+     * Returns nullptr if the container holds a delta, see IsDelta().
      */
     Image::Pointer GetImage();
 
+    /**
+     * \brief Creates a full mitk::Image from its compressed version and the reference image.
+     *
+     * @a referenceImage has to have the content of the reference image passed to SetImage()
+     * at the changed pixels. Throws if the container holds a delta and @a referenceImage does not
+     * match its pixel type and size. Equal to GetImage() if the container holds a complete image.
+     */
+    Image::Pointer GetImage(const Image *referenceImage);
+
+    /**
+     * \brief Uncompresses the pixel data of time step @a timeStep into @a buffer without creating an image.
+     *
+     * @a size has to be the size of one time step of the image in bytes. Returns false if the container
+     * holds a delta or no such time step.
+     */
+    bool GetTimeStepData(unsigned int timeStep, void *buffer, std::size_t size);
+
+    /**
+     * \brief True if only the pixels that differ from a reference image are stored.
+     */
+    bool IsDelta() const { return m_IsDelta; }
+
+    /**
+     * \brief Number of bytes of the compressed data of all time steps.
+     */
+    std::size_t GetCompressedSize() const;
+
+    /**
+     * \brief zlib compression level, from 1 (Z_BEST_SPEED, default) to 9 (Z_BEST_COMPRESSION).
+     *
+     * Images are compressed on the hot path of interactive tools, where speed beats the
+     * few percent saved by the higher levels.
+     */
+    itkSetClampMacro(CompressionLevel, int, 1, 9);
+    itkGetConstMacro(CompressionLevel, int);
+
+    /**
+     * \brief Compress on a background thread instead of within SetImage(), default off.
+     */
+    itkSetMacro(Asynchronous, bool);
+    itkGetConstMacro(Asynchronous, bool);
+    itkBooleanMacro(Asynchronous);
+
+    /**
+     * \brief True while the compression of the last SetImage() call runs in the background.
+     */
+    bool IsCompressionPending() const;
+
+    /**
+     * \brief Blocks until a pending compression is done.
+     */
+    void WaitForCompression();
+
   protected:
     CompressedImageContainer(); // purposely hidden
     ~CompressedImageContainer() override;
 
+    void ClearBuffers();
+    void SetImageInformation(Image *image);
+
+    /// compresses @a sourceLen bytes and appends the result to m_ByteBuffers
+    void CompressBuffer(const unsigned char *source, unsigned long sourceLen);
+
+    /// compresses the data of all time steps, @a references is only used for a delta
+    void CompressTimeSteps(const std::vector<const unsigned char *> &sources,
+                           const std::vector<const unsigned char *> &references);
+
+    /// uncompresses time step @a timeStep into @a dest, which has to hold m_UncompressedSizes[timeStep] bytes
+    bool UncompressBuffer(unsigned int timeStep, unsigned char *dest) const;
+
+    Image::Pointer CreateEmptyImage() const;
+
     PixelType *m_PixelType;
 
     unsigned int m_ImageDimension;
@@ -72,7 +158,22 @@ namespace mitk
     /// one for each timestep. first = pointer to compressed data; second = size of buffer in bytes
     std::vector<std::pair<unsigned char *, unsigned long>> m_ByteBuffers;
 
+    /// one for each timestep, size of the uncompressed data (a delta is smaller than the image)
+    std::vector<unsigned long> m_UncompressedSizes;
+
     BaseGeometry::Pointer m_ImageGeometry;
+
+    bool m_IsDelta;
+
+    int m_CompressionLevel;
+
+    bool m_Asynchronous;
+
+    /// the background compression, it owns the uncompressed copy of the data
+    std::future<void> m_PendingCompression;
+
+    /// bytes of the uncompressed copy held while the compression is pending
+    std::size_t m_PendingSize;
   };
 
 } // namespace
@@ -0,0 +1,61 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkCompressedImageHibernationStore_h
+#define mitkCompressedImageHibernationStore_h
+
+#include "MitkDataTypesExtExports.h"
+#include "mitkCompressedImageContainer.h"
+
+#include <mitkImageHibernationStore.h>
+
+#include <map>
+#include <utility>
+
+namespace mitk
+{
+  /**
+    \brief Keeps the volumes of a hibernated image compressed in main memory (see Image::Hibernate).
+
+    Every volume is compressed by its own CompressedImageContainer with the fastest zlib level, so
+    restoring a volume on access only uncompresses this volume. Compared to the default
+    MappedFileHibernationStore, this trades some CPU time for not touching the disk; segmentations
+    and CT images typically shrink to a fraction of their size.
+  */
+  class MITKDATATYPESEXT_EXPORT CompressedImageHibernationStore : public ImageHibernationStore
+  {
+  public:
+    mitkClassMacro(CompressedImageHibernationStore, ImageHibernationStore);
+    itkFactorylessNewMacro(Self);
+
+    bool StoreVolume(const Image *image, int t, int n, const void *data, std::size_t size) override;
+    bool ProvideVolume(const Image *image, int t, int n, void *buffer) override;
+
+    /** \brief Bytes of the compressed volumes. */
+    std::size_t GetMemorySize() const override;
+
+  protected:
+    CompressedImageHibernationStore();
+    ~CompressedImageHibernationStore() override;
+
+  private:
+    struct Volume
+    {
+      CompressedImageContainer::Pointer Container;
+      std::size_t Size;
+    };
+
+    std::map<std::pair<int, int>, Volume> m_Volumes;
+  };
+}
+
+#endif
@@ -29,6 +29,9 @@ namespace mitk
    *
    * Labels are expected to be of an unsigned integer type.
    *
+   * The voxels of all labels are counted in a single pass, which is distributed over the
+   * mitk::ThreadPool.
+   *
    * TODO: Extend class for time resolved images
    */
   class MITKDATATYPESEXT_EXPORT LabeledImageVolumeCalculator : public itk::Object
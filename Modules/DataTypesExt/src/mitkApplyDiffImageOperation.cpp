@@ -65,3 +65,8 @@ mitk::Image::Pointer mitk::ApplyDiffImageOperation::GetDiffImage()
 
   return image;
 }
+
+std::size_t mitk::ApplyDiffImageOperation::GetMemorySize() const
+{
+  return zlibContainer.IsNotNull() ? zlibContainer->GetCompressedSize() : 0;
+}
@@ -11,27 +11,121 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkCompressedImageContainer.h"
+#include "mitkExceptionMacro.h"
 #include "mitkImageReadAccessor.h"
+#include "mitkImageWriteAccessor.h"
 
 #include "itk_zlib.h"
 
+#include <chrono>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
 
-mitk::CompressedImageContainer::CompressedImageContainer() : m_PixelType(nullptr), m_ImageGeometry(nullptr)
+namespace
+{
+  typedef std::uint32_t DeltaCountType;
+
+  /**
+    A delta is a sequence of records, each consisting of the number of unchanged pixels since the
+    end of the previous record, the number of pixels of the record and their values.
+    */
+  void EncodeDelta(const unsigned char *image,
+                   const unsigned char *reference,
+                   std::size_t numberOfPixels,
+                   std::size_t pixelSize,
+                   std::vector<unsigned char> &delta)
+  {
+    // unchanged pixels are stored within a record instead of starting a new one if that is smaller
+    const std::size_t maximumGap = 2 * sizeof(DeltaCountType) / pixelSize;
+
+    auto isUnchanged = [&](std::size_t pixel) {
+      return std::memcmp(image + pixel * pixelSize, reference + pixel * pixelSize, pixelSize) == 0;
+    };
+
+    delta.clear();
+    std::size_t pixel = 0;
+    std::size_t recordEnd = 0;
+    while (pixel < numberOfPixels)
+    {
+      while (pixel < numberOfPixels && isUnchanged(pixel))
+        ++pixel;
+      if (pixel == numberOfPixels)
+        break;
+
+      const std::size_t recordBegin = pixel;
+      std::size_t gap = 0;
+      while (pixel < numberOfPixels && gap <= maximumGap &&
+             pixel - recordBegin < std::numeric_limits<DeltaCountType>::max())
+      {
+        gap = isUnchanged(pixel) ? gap + 1 : 0;
+        ++pixel;
+      }
+      const std::size_t count = pixel - recordBegin - gap;
+
+      const DeltaCountType header[2] = {static_cast<DeltaCountType>(recordBegin - recordEnd),
+                                        static_cast<DeltaCountType>(count)};
+      const auto *headerBytes = reinterpret_cast<const unsigned char *>(header);
+      delta.insert(delta.end(), headerBytes, headerBytes + sizeof(header));
+      delta.insert(delta.end(), image + recordBegin * pixelSize, image + (recordBegin + count) * pixelSize);
+      recordEnd = recordBegin + count;
+    }
+  }
+
+  void DecodeDelta(const unsigned char *delta, std::size_t deltaSize, std::size_t pixelSize, unsigned char *image)
+  {
+    const unsigned char *record = delta;
+    const unsigned char *end = delta + deltaSize;
+    unsigned char *pixel = image;
+    while (record + 2 * sizeof(DeltaCountType) <= end)
+    {
+      DeltaCountType header[2];
+      std::memcpy(header, record, sizeof(header));
+      record += sizeof(header);
+
+      pixel += header[0] * pixelSize;
+      const std::size_t count = header[1] * pixelSize;
+      std::memcpy(pixel, record, count);
+      pixel += count;
+      record += count;
+    }
+  }
+
+  bool HaveSameSize(const mitk::Image *image, const mitk::PixelType &pixelType, const std::vector<unsigned int> &dims)
+  {
+    if (image->GetPixelType() != pixelType || image->GetDimension() != dims.size())
+      return false;
+
+    for (unsigned int i = 0; i < dims.size(); ++i)
+    {
+      if (image->GetDimension(i) != dims[i])
+        return false;
+    }
+    return true;
+  }
+}
+
+mitk::CompressedImageContainer::CompressedImageContainer()
+  : m_PixelType(nullptr),
+    m_ImageGeometry(nullptr),
+    m_IsDelta(false),
+    m_CompressionLevel(Z_BEST_SPEED),
+    m_Asynchronous(false),
+    m_PendingSize(0)
 {
 }
 
 mitk::CompressedImageContainer::~CompressedImageContainer()
 {
-  for (auto iter = m_ByteBuffers.begin(); iter != m_ByteBuffers.end(); ++iter)
-  {
-    free(iter->first);
-  }
+  this->WaitForCompression();
+  this->ClearBuffers();
 
   delete m_PixelType;
 }
 
-void mitk::CompressedImageContainer::SetImage(Image *image)
+void mitk::CompressedImageContainer::ClearBuffers()
 {
   for (auto iter = m_ByteBuffers.begin(); iter != m_ByteBuffers.end(); ++iter)
   {
@@ -39,12 +133,18 @@ void mitk::CompressedImageContainer::SetImage(Image *image)
   }
 
   m_ByteBuffers.clear();
+  m_UncompressedSizes.clear();
+}
+
+void mitk::CompressedImageContainer::SetImageInformation(Image *image)
+{
+  this->ClearBuffers();
 
-  // Compress diff image using zlib (will be restored on demand)
   // determine memory size occupied by voxel data
   m_ImageDimension = image->GetDimension();
   m_ImageDimensions.clear();
 
+  delete m_PixelType;
   m_PixelType = new mitk::PixelType(image->GetPixelType());
 
   m_OneTimeStepImageSizeInBytes = m_PixelType->GetSize(); // bits per element divided by 8
@@ -65,68 +165,205 @@ void mitk::CompressedImageContainer::SetImage(Image *image)
   {
     m_NumberOfTimeSteps = image->GetDimension(3);
   }
+}
 
-  for (unsigned int timestep = 0; timestep < m_NumberOfTimeSteps; ++timestep)
+void mitk::CompressedImageContainer::CompressBuffer(const unsigned char *source, unsigned long sourceLen)
+{
+  // allocate a buffer as specified by zlib
+  unsigned long bufferSize = ::compressBound(sourceLen);
+  auto *byteBuffer = (unsigned char *)malloc(bufferSize);
+
+  if (itk::Object::GetDebug())
   {
-    // allocate a buffer as specified by zlib
-    unsigned long bufferSize =
-      m_OneTimeStepImageSizeInBytes + static_cast<unsigned long>(m_OneTimeStepImageSizeInBytes * 0.2) + 12;
-    auto *byteBuffer = (unsigned char *)malloc(bufferSize);
+    // compress image here into a buffer
+    MITK_INFO << "Using ZLib version: '" << zlibVersion() << "'" << std::endl
+              << "Attempting to compress " << sourceLen << " image bytes into a buffer of size " << bufferSize
+              << std::endl;
+  }
 
-    if (itk::Object::GetDebug())
+  ::Bytef *dest(byteBuffer);
+  ::uLongf destLen(bufferSize);
+  int zlibRetVal = ::compress2(dest, &destLen, source, sourceLen, m_CompressionLevel);
+  if (itk::Object::GetDebug())
+  {
+    if (zlibRetVal == Z_OK)
     {
-      // compress image here into a buffer
-      MITK_INFO << "Using ZLib version: '" << zlibVersion() << "'" << std::endl
-                << "Attempting to compress " << m_OneTimeStepImageSizeInBytes << " image bytes into a buffer of size "
-                << bufferSize << std::endl;
+      MITK_INFO << "Success, using " << destLen << " bytes of the buffer (ratio "
+                << ((double)destLen / (double)sourceLen) << ")" << std::endl;
     }
-
-    ImageReadAccessor imgAcc(image, image->GetVolumeData(timestep));
-    ::Bytef *dest(byteBuffer);
-    ::uLongf destLen(bufferSize);
-    auto *source((unsigned char *)imgAcc.GetData());
-    ::uLongf sourceLen(m_OneTimeStepImageSizeInBytes);
-    int zlibRetVal = ::compress(dest, &destLen, source, sourceLen);
-    if (itk::Object::GetDebug())
+    else
     {
-      if (zlibRetVal == Z_OK)
+      switch (zlibRetVal)
       {
-        MITK_INFO << "Success, using " << destLen << " bytes of the buffer (ratio "
-                  << ((double)destLen / (double)sourceLen) << ")" << std::endl;
+        case Z_MEM_ERROR:
+          MITK_ERROR << "not enough memory" << std::endl;
+          break;
+        case Z_BUF_ERROR:
+          MITK_ERROR << "output buffer too small" << std::endl;
+          break;
+        default:
+          MITK_ERROR << "other, unspecified error" << std::endl;
+          break;
       }
-      else
+    }
+  }
+
+  // only use the neccessary amount of memory, realloc the buffer!
+  // (an empty delta compresses to a few bytes, realloc never sees a size of 0)
+  byteBuffer = (unsigned char *)realloc(byteBuffer, destLen);
+  bufferSize = destLen;
+
+  m_ByteBuffers.push_back(std::pair<unsigned char *, unsigned long>(byteBuffer, bufferSize));
+  m_UncompressedSizes.push_back(sourceLen);
+}
+
+bool mitk::CompressedImageContainer::UncompressBuffer(unsigned int timeStep, unsigned char *dest) const
+{
+  ::uLongf destLen(m_UncompressedSizes[timeStep]);
+  const ::Bytef *source(m_ByteBuffers[timeStep].first);
+  ::uLongf sourceLen(m_ByteBuffers[timeStep].second);
+  int zlibRetVal = ::uncompress(dest, &destLen, source, sourceLen);
+  if (itk::Object::GetDebug())
+  {
+    if (zlibRetVal == Z_OK)
+    {
+      MITK_INFO << "Success, destLen now " << destLen << " bytes" << std::endl;
+    }
+    else
+    {
+      switch (zlibRetVal)
       {
-        switch (zlibRetVal)
-        {
-          case Z_MEM_ERROR:
-            MITK_ERROR << "not enough memory" << std::endl;
-            break;
-          case Z_BUF_ERROR:
-            MITK_ERROR << "output buffer too small" << std::endl;
-            break;
-          default:
-            MITK_ERROR << "other, unspecified error" << std::endl;
-            break;
-        }
+        case Z_DATA_ERROR:
+          MITK_ERROR << "compressed data corrupted" << std::endl;
+          break;
+        case Z_MEM_ERROR:
+          MITK_ERROR << "not enough memory" << std::endl;
+          break;
+        case Z_BUF_ERROR:
+          MITK_ERROR << "output buffer too small" << std::endl;
+          break;
+        default:
+          MITK_ERROR << "other, unspecified error" << std::endl;
+          break;
       }
     }
+  }
+  return zlibRetVal == Z_OK;
+}
 
-    // only use the neccessary amount of memory, realloc the buffer!
-    byteBuffer = (unsigned char *)realloc(byteBuffer, destLen);
-    bufferSize = destLen;
-    // MITK_INFO << "Using " << bufferSize << " bytes to store compressed image (" << destLen << " needed)" <<
-    // std::endl;
+void mitk::CompressedImageContainer::SetImage(Image *image)
+{
+  this->SetImage(image, nullptr);
+}
+
+void mitk::CompressedImageContainer::SetImage(Image *image, const Image *referenceImage)
+{
+  this->WaitForCompression();
 
-    m_ByteBuffers.push_back(std::pair<unsigned char *, unsigned long>(byteBuffer, bufferSize));
+  // Compress diff image using zlib (will be restored on demand)
+  this->SetImageInformation(image);
+
+  m_IsDelta = referenceImage != nullptr && HaveSameSize(referenceImage, *m_PixelType, m_ImageDimensions);
+
+  std::vector<std::unique_ptr<ImageReadAccessor>> accessors;
+  std::vector<const unsigned char *> sources;
+  std::vector<const unsigned char *> references;
+  for (unsigned int timestep = 0; timestep < m_NumberOfTimeSteps; ++timestep)
+  {
+    accessors.emplace_back(new ImageReadAccessor(image, image->GetVolumeData(timestep)));
+    sources.push_back((const unsigned char *)accessors.back()->GetData());
+
+    if (m_IsDelta)
+    {
+      accessors.emplace_back(new ImageReadAccessor(referenceImage, referenceImage->GetVolumeData(timestep)));
+      references.push_back((const unsigned char *)accessors.back()->GetData());
+    }
   }
+
+  if (!m_Asynchronous)
+  {
+    this->CompressTimeSteps(sources, references);
+    return;
+  }
+
+  // the background thread works on a copy, the images may be modified as soon as this method returns
+  const unsigned long size = m_OneTimeStepImageSizeInBytes;
+  auto copies = std::make_shared<std::vector<std::vector<unsigned char>>>();
+  for (const unsigned char *source : sources)
+    copies->emplace_back(source, source + size);
+  for (const unsigned char *reference : references)
+    copies->emplace_back(reference, reference + size);
+  m_PendingSize = copies->size() * size;
+
+  m_PendingCompression = std::async(std::launch::async, [this, copies]() {
+    std::vector<const unsigned char *> copiedSources;
+    std::vector<const unsigned char *> copiedReferences;
+    for (unsigned int timestep = 0; timestep < m_NumberOfTimeSteps; ++timestep)
+    {
+      copiedSources.push_back((*copies)[timestep].data());
+      if (m_IsDelta)
+        copiedReferences.push_back((*copies)[m_NumberOfTimeSteps + timestep].data());
+    }
+    this->CompressTimeSteps(copiedSources, copiedReferences);
+  });
 }
 
-mitk::Image::Pointer mitk::CompressedImageContainer::GetImage()
+void mitk::CompressedImageContainer::CompressTimeSteps(const std::vector<const unsigned char *> &sources,
+                                                       const std::vector<const unsigned char *> &references)
 {
-  if (m_ByteBuffers.empty())
-    return nullptr;
+  std::vector<unsigned char> delta;
+  for (unsigned int timestep = 0; timestep < sources.size(); ++timestep)
+  {
+    if (m_IsDelta)
+    {
+      const std::size_t pixelSize = m_PixelType->GetSize();
+      EncodeDelta(
+        sources[timestep], references[timestep], m_OneTimeStepImageSizeInBytes / pixelSize, pixelSize, delta);
+      this->CompressBuffer(delta.data(), delta.size());
+    }
+    else
+    {
+      this->CompressBuffer(sources[timestep], m_OneTimeStepImageSizeInBytes);
+    }
+  }
+}
 
-  // uncompress image data, create an Image
+bool mitk::CompressedImageContainer::IsCompressionPending() const
+{
+  return m_PendingCompression.valid() &&
+         m_PendingCompression.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
+
+void mitk::CompressedImageContainer::WaitForCompression()
+{
+  if (!m_PendingCompression.valid())
+    return;
+
+  try
+  {
+    m_PendingCompression.get();
+  }
+  catch (const std::exception &e)
+  {
+    MITK_ERROR << "Image compression failed: " << e.what();
+  }
+  m_PendingSize = 0;
+}
+
+std::size_t mitk::CompressedImageContainer::GetCompressedSize() const
+{
+  // the uncompressed copy is what the container holds until the compression is done
+  if (this->IsCompressionPending())
+    return m_PendingSize;
+
+  std::size_t compressedSize = 0;
+  for (const auto &buffer : m_ByteBuffers)
+    compressedSize += buffer.second;
+  return compressedSize;
+}
+
+mitk::Image::Pointer mitk::CompressedImageContainer::CreateEmptyImage() const
+{
   Image::Pointer image = Image::New();
   unsigned int dims[20]; // more than 20 dimensions and bang
   for (unsigned int dim = 0; dim < m_ImageDimension; ++dim)
@@ -134,41 +371,65 @@ mitk::Image::Pointer mitk::CompressedImageContainer::GetImage()
 
   image->Initialize(*m_PixelType, m_ImageDimension, dims); // this IS needed, right ?? But it does allocate memory ->
                                                            // does create one big lump of memory (also in windows)
+  return image;
+}
+
+mitk::Image::Pointer mitk::CompressedImageContainer::GetImage()
+{
+  this->WaitForCompression();
+
+  if (m_ByteBuffers.empty() || m_IsDelta)
+    return nullptr;
+
+  // uncompress image data, create an Image
+  Image::Pointer image = this->CreateEmptyImage();
+
+  for (unsigned int timeStep = 0; timeStep < m_ByteBuffers.size(); ++timeStep)
+  {
+    ImageWriteAccessor imgAcc(image, image->GetVolumeData(timeStep));
+    this->UncompressBuffer(timeStep, (unsigned char *)imgAcc.GetData());
+  }
+
+  image->SetGeometry(m_ImageGeometry);
+  image->Modified();
+
+  return image;
+}
 
-  unsigned int timeStep(0);
-  for (auto iter = m_ByteBuffers.begin(); iter != m_ByteBuffers.end(); ++iter, ++timeStep)
+bool mitk::CompressedImageContainer::GetTimeStepData(unsigned int timeStep, void *buffer, std::size_t size)
+{
+  this->WaitForCompression();
+
+  if (m_IsDelta || timeStep >= m_ByteBuffers.size() || size != m_UncompressedSizes[timeStep])
+    return false;
+
+  return this->UncompressBuffer(timeStep, static_cast<unsigned char *>(buffer));
+}
+
+mitk::Image::Pointer mitk::CompressedImageContainer::GetImage(const Image *referenceImage)
+{
+  if (!m_IsDelta)
+    return this->GetImage();
+
+  this->WaitForCompression();
+
+  if (referenceImage == nullptr || !HaveSameSize(referenceImage, *m_PixelType, m_ImageDimensions))
+    mitkThrow() << "The reference image does not match the image the delta was created for.";
+
+  Image::Pointer image = this->CreateEmptyImage();
+
+  std::vector<unsigned char> delta;
+  for (unsigned int timeStep = 0; timeStep < m_ByteBuffers.size(); ++timeStep)
   {
-    ImageReadAccessor imgAcc(image, image->GetVolumeData(timeStep));
+    ImageWriteAccessor imgAcc(image, image->GetVolumeData(timeStep));
+    ImageReadAccessor refAcc(referenceImage, referenceImage->GetVolumeData(timeStep));
     auto *dest((unsigned char *)imgAcc.GetData());
-    ::uLongf destLen(m_OneTimeStepImageSizeInBytes);
-    ::Bytef *source(iter->first);
-    ::uLongf sourceLen(iter->second);
-    int zlibRetVal = ::uncompress(dest, &destLen, source, sourceLen);
-    if (itk::Object::GetDebug())
-    {
-      if (zlibRetVal == Z_OK)
-      {
-        MITK_INFO << "Success, destLen now " << destLen << " bytes" << std::endl;
-      }
-      else
-      {
-        switch (zlibRetVal)
-        {
-          case Z_DATA_ERROR:
-            MITK_ERROR << "compressed data corrupted" << std::endl;
-            break;
-          case Z_MEM_ERROR:
-            MITK_ERROR << "not enough memory" << std::endl;
-            break;
-          case Z_BUF_ERROR:
-            MITK_ERROR << "output buffer too small" << std::endl;
-            break;
-          default:
-            MITK_ERROR << "other, unspecified error" << std::endl;
-            break;
-        }
-      }
-    }
+    std::memcpy(dest, refAcc.GetData(), m_OneTimeStepImageSizeInBytes);
+
+    // an empty delta means the image equals the reference image
+    delta.resize(m_UncompressedSizes[timeStep]);
+    if (!delta.empty() && this->UncompressBuffer(timeStep, delta.data()))
+      DecodeDelta(delta.data(), delta.size(), m_PixelType->GetSize(), dest);
   }
 
   image->SetGeometry(m_ImageGeometry);
@@ -0,0 +1,58 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkCompressedImageHibernationStore.h"
+
+#include <algorithm>
+
+mitk::CompressedImageHibernationStore::CompressedImageHibernationStore()
+{
+}
+
+mitk::CompressedImageHibernationStore::~CompressedImageHibernationStore()
+{
+}
+
+bool mitk::CompressedImageHibernationStore::StoreVolume(
+  const Image *image, int t, int n, const void *data, std::size_t size)
+{
+  // The container compresses images, so the volume is wrapped into one without copying it.
+  // Only the descriptor of the hibernated image is read, its data arrays are locked.
+  const unsigned int dimension = std::min(image->GetDimension(), 3u);
+  Image::Pointer volume = Image::New();
+  volume->Initialize(image->GetPixelType(n), dimension, image->GetDimensions());
+  volume->SetImportVolume(const_cast<void *>(data), 0, 0, Image::ReferenceMemory);
+
+  // the container compresses with the fastest level by default
+  CompressedImageContainer::Pointer container = CompressedImageContainer::New();
+  container->SetImage(volume);
+
+  m_Volumes[std::make_pair(t, n)] = Volume{container, size};
+  return true;
+}
+
+bool mitk::CompressedImageHibernationStore::ProvideVolume(const Image *, int t, int n, void *buffer)
+{
+  auto it = m_Volumes.find(std::make_pair(t, n));
+  if (it == m_Volumes.end())
+    return false;
+
+  return it->second.Container->GetTimeStepData(0, buffer, it->second.Size);
+}
+
+std::size_t mitk::CompressedImageHibernationStore::GetMemorySize() const
+{
+  std::size_t size = 0;
+  for (const auto &volume : m_Volumes)
+    size += volume.second.Container->GetCompressedSize();
+  return size;
+}
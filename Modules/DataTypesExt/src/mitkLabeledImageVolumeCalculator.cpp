@@ -13,7 +13,16 @@ found in the LICENSE file.
 #include "mitkLabeledImageVolumeCalculator.h"
 #include "mitkImageAccessByItk.h"
 
-#include <itkImageRegionConstIteratorWithIndex.h>
+#include <mitkThreadPool.h>
+
+#include <algorithm>
+#include <mutex>
+
+namespace
+{
+  /** Minimum number of voxels processed by one task of the thread pool */
+  const std::size_t VoxelsPerTask = 1 << 16;
+}
 
 namespace mitk
 {
@@ -75,31 +84,68 @@ namespace mitk
   {
     typedef itk::Image<TPixel, VImageDimension> ImageType;
     typedef typename ImageType::IndexType IndexType;
-    typedef itk::ImageRegionConstIteratorWithIndex<ImageType> IteratorType;
-
-    // Reset volume and centroid vectors
-    m_VolumeVector.clear();
-    m_CentroidVector.clear();
 
-    // Iterate over image and determine number of voxels and centroid
-    // per label
-    IteratorType it(image, image->GetBufferedRegion());
-    for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    // Determine number of voxels and sum of indices per label in one parallel pass over the rows of the
+    // image. Every task accumulates into its own vectors, which are merged at its end.
+    const typename ImageType::RegionType &region = image->GetBufferedRegion();
+    const TPixel *buffer = image->GetBufferPointer();
+    const std::size_t rowLength = region.GetSize(0);
+    const std::size_t numberOfRows = region.GetNumberOfPixels() / std::max<std::size_t>(rowLength, 1);
+    const unsigned int numberOfIndexDimensions = std::min(VImageDimension, 3u);
+
+    std::vector<double> volumes;
+    std::vector<double> indexSums; // three per label
+    std::mutex mutex;
+
+    ThreadPool::GetInstance().ParallelFor(
+      0,
+      numberOfRows,
+      [&](std::size_t beginRow, std::size_t endRow) {
+        std::vector<double> localVolumes;
+        std::vector<double> localIndexSums;
+
+        for (std::size_t row = beginRow; row < endRow; ++row)
+        {
+          const TPixel *rowBuffer = buffer + row * rowLength;
+          IndexType index = image->ComputeIndex(row * rowLength);
+
+          for (std::size_t x = 0; x < rowLength; ++x, ++index[0])
+          {
+            auto pixel = static_cast<unsigned int>(rowBuffer[x]);
+
+            if (localVolumes.size() <= pixel)
+            {
+              localVolumes.resize(pixel + 1);
+              localIndexSums.resize(3 * (pixel + 1));
+            }
+
+            localVolumes[pixel] += 1.0;
+
+            for (unsigned int d = 0; d < numberOfIndexDimensions; ++d)
+              localIndexSums[3 * pixel + d] += index[d];
+          }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (volumes.size() < localVolumes.size())
+        {
+          volumes.resize(localVolumes.size());
+          indexSums.resize(localIndexSums.size());
+        }
+        for (std::size_t i = 0; i < localVolumes.size(); ++i)
+          volumes[i] += localVolumes[i];
+        for (std::size_t i = 0; i < localIndexSums.size(); ++i)
+          indexSums[i] += localIndexSums[i];
+      },
+      std::max<std::size_t>(1, VoxelsPerTask / std::max<std::size_t>(rowLength, 1)));
+
+    m_VolumeVector = volumes;
+    m_CentroidVector.resize(volumes.size(), m_DummyPoint);
+    for (unsigned int i = 0; i < volumes.size(); ++i)
     {
-      const IndexType &index = it.GetIndex();
-      auto pixel = static_cast<unsigned int>(it.Get());
-
-      if (m_VolumeVector.size() <= pixel)
-      {
-        m_VolumeVector.resize(pixel + 1);
-        m_CentroidVector.resize(pixel + 1);
-      }
-
-      m_VolumeVector[pixel] += 1.0;
-
-      m_CentroidVector[pixel][0] += index[0];
-      m_CentroidVector[pixel][1] += index[1];
-      m_CentroidVector[pixel][2] += index[2];
+      m_CentroidVector[i][0] = indexSums[3 * i];
+      m_CentroidVector[i][1] = indexSums[3 * i + 1];
+      m_CentroidVector[i][2] = indexSums[3 * i + 2];
     }
 
     // Calculate voxel volume from spacing
@@ -11,10 +11,14 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkCompressedImageContainer.h"
+#include "mitkCompressedImageHibernationStore.h"
 #include "mitkCoreObjectFactory.h"
 #include "mitkIOUtil.h"
 #include "mitkImageDataItem.h"
 #include "mitkImageReadAccessor.h"
+#include "mitkImageWriteAccessor.h"
+
+#include <cstring>
 
 class mitkCompressedImageContainerTestClass
 {
@@ -106,6 +110,74 @@ public:
         break; // break "for timeStep"
       }
     }
+
+    TestDelta(container, image, oneTimeStepSizeInBytes, numberFailed);
+    TestHibernation(image, oneTimeStepSizeInBytes, numberOfTimeSteps, numberFailed);
+  }
+
+  static void TestHibernation(mitk::Image *image,
+                              unsigned long oneTimeStepSizeInBytes,
+                              unsigned int numberOfTimeSteps,
+                              unsigned int &numberFailed)
+  {
+    mitk::Image::Pointer hibernatedImage = image->Clone();
+    mitk::CompressedImageHibernationStore::Pointer store = mitk::CompressedImageHibernationStore::New();
+    if (hibernatedImage->Hibernate(store) == 0)
+    {
+      std::cout << "  (II) Image cannot be hibernated, skipping hibernation test." << std::endl;
+      return;
+    }
+
+    if (hibernatedImage->IsVolumeSet(0) || store->GetMemorySize() == 0)
+    {
+      ++numberFailed;
+      std::cerr << "  (EE) Volumes not moved into the compressed hibernation store" << std::endl;
+    }
+
+    // volumes are restored on access
+    for (unsigned int timeStep = 0; timeStep < numberOfTimeSteps; ++timeStep)
+    {
+      mitk::ImageReadAccessor origImgAcc(image, image->GetVolumeData(timeStep));
+      mitk::ImageReadAccessor restoredImgAcc(hibernatedImage, hibernatedImage->GetVolumeData(timeStep));
+      if (memcmp(origImgAcc.GetData(), restoredImgAcc.GetData(), oneTimeStepSizeInBytes) != 0)
+      {
+        ++numberFailed;
+        std::cerr << "  (EE) Pixel data in timestep " << timeStep << " not identical after hibernation." << std::endl;
+        break;
+      }
+    }
+  }
+
+  static void TestDelta(mitk::CompressedImageContainer *container,
+                        mitk::Image *image,
+                        unsigned long oneTimeStepSizeInBytes,
+                        unsigned int &numberFailed)
+  {
+    // change every 1000th byte of the first time step and store the changed pixels only
+    mitk::Image::Pointer changedImage = image->Clone();
+    {
+      mitk::ImageWriteAccessor changedImgAcc(changedImage, changedImage->GetVolumeData(0));
+      auto *changedData((unsigned char *)changedImgAcc.GetData());
+      for (unsigned long byte = 0; byte < oneTimeStepSizeInBytes; byte += 1000)
+        changedData[byte] = ~changedData[byte];
+    }
+
+    container->SetImage(changedImage, image);
+    if (!container->IsDelta() || container->GetImage().IsNotNull())
+    {
+      ++numberFailed;
+      std::cerr << "  (EE) Container does not hold a delta" << std::endl;
+      return;
+    }
+
+    mitk::Image::Pointer restoredImage = container->GetImage(image);
+    mitk::ImageReadAccessor changedImgAcc(changedImage, changedImage->GetVolumeData(0));
+    mitk::ImageReadAccessor restoredImgAcc(restoredImage, restoredImage->GetVolumeData(0));
+    if (memcmp(changedImgAcc.GetData(), restoredImgAcc.GetData(), oneTimeStepSizeInBytes) != 0)
+    {
+      ++numberFailed;
+      std::cerr << "  (EE) Pixel data not identical after applying the delta." << std::endl;
+    }
   }
 };
 
@@ -162,6 +234,16 @@ int mitkCompressedImageContainerTest(int argc, char *argv[])
   // some real work
   mitkCompressedImageContainerTestClass::Test(container, image, numberFailed);
 
+  std::cout << "Testing asynchronous compression" << std::endl;
+  container->AsynchronousOn();
+  mitkCompressedImageContainerTestClass::Test(container, image, numberFailed);
+  container->WaitForCompression();
+  if (container->IsCompressionPending())
+  {
+    ++numberFailed;
+    std::cerr << "  (EE) Compression still pending after waiting for it" << std::endl;
+  }
+
   std::cout << "Testing destruction" << std::endl;
 
   // freeing
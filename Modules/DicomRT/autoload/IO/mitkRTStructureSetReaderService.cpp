@@ -225,14 +225,14 @@ namespace mitk
           contourItem.getNumberOfContourPoints(numberOfPoints);
           contourItem.getContourData(contourData_LPS);
 
-          for (unsigned int i = 0; i < contourData_LPS.size() / 3; i++)
+          std::vector<mitk::Point3D> points(contourData_LPS.size() / 3);
+          for (std::size_t i = 0; i < points.size(); i++)
           {
-            mitk::Point3D point;
-            point[0] = contourData_LPS.at(3 * i);
-            point[1] = contourData_LPS.at(3 * i + 1);
-            point[2] = contourData_LPS.at(3 * i + 2);
-            contourSequence->AddVertex(point);
+            points[i][0] = contourData_LPS[3 * i];
+            points[i][1] = contourData_LPS[3 * i + 1];
+            points[i][2] = contourData_LPS[3 * i + 2];
           }
+          contourSequence->AddVertices(points);
 
           contourSequence->Close();
           contourSet->AddContourModel(contourSequence);
@@ -27,6 +27,8 @@ found in the LICENSE file.
 #include <vtkPropAssembly.h>
 #include <vtkCellArray.h>
 
+#include <vector>
+
 class vtkActor;
 class vtkPolyDataMapper;
 class vtkPlaneSource;
@@ -38,11 +40,14 @@ class vtkImageChangeInformation;
 class vtkPoints;
 class vtkMitkThickSlicesFilter;
 class vtkPolyData;
+class vtkUnsignedCharArray;
 class vtkMitkApplyLevelWindowToRGBFilter;
 class vtkMitkLevelWindowFilter;
 
 namespace mitk {
 
+  class IsoDoseLevel;
+
   /** \brief Mapper to resample and display 2D slices of a 3D image.
   *
   * The following image gives a brief overview of the mapping and the involved parts.
@@ -300,7 +305,11 @@ namespace mitk {
     bool RenderingGeometryIntersectsImage( const PlaneGeometry* renderingGeometry, SlicedGeometry3D* imageGeometry );
 
   private:
-    void CreateLevelOutline(mitk::BaseRenderer* renderer, const mitk::IsoDoseLevel* level, float pref, vtkSmartPointer<vtkPoints> points, vtkSmartPointer<vtkCellArray> lines,  vtkSmartPointer<vtkUnsignedCharArray> colors);
+    /** \brief Adds the outlines of all given levels to points, lines and colors.
+    * Every pixel of the slice is classified once against all dose thresholds, so the costs
+    * do not grow with the number of levels but only with the number of emitted lines.
+    */
+    void CreateLevelOutlines(mitk::BaseRenderer* renderer, const std::vector<const mitk::IsoDoseLevel*>& levels, float pref, vtkSmartPointer<vtkPoints> points, vtkSmartPointer<vtkCellArray> lines,  vtkSmartPointer<vtkUnsignedCharArray> colors);
 
   };
 
@@ -58,6 +58,8 @@ found in the LICENSE file.
 // ITK
 #include <itkRGBAPixel.h>
 
+#include <algorithm>
+
 mitk::DoseImageVtkMapper2D::DoseImageVtkMapper2D()
 {
 }
@@ -853,6 +855,9 @@ vtkSmartPointer<vtkPolyData> mitk::DoseImageVtkMapper2D::CreateOutlinePolyData(m
   float pref;
   this->GetDataNode()->GetFloatProperty(mitk::RTConstants::REFERENCE_DOSE_PROPERTY_NAME.c_str(), pref);
 
+  // collect all visible levels, so that the slice is traversed only once for all of them
+  std::vector<const mitk::IsoDoseLevel *> levels;
+
   mitk::IsoDoseLevelSetProperty::Pointer propIsoSet = dynamic_cast<mitk::IsoDoseLevelSetProperty *>(
     GetDataNode()->GetProperty(mitk::RTConstants::DOSE_ISO_LEVELS_PROPERTY_NAME.c_str()));
   mitk::IsoDoseLevelSet::Pointer isoDoseLevelSet = propIsoSet->GetValue();
@@ -862,7 +867,7 @@ vtkSmartPointer<vtkPolyData> mitk::DoseImageVtkMapper2D::CreateOutlinePolyData(m
   {
     if (doseIT->GetVisibleIsoLine())
     {
-      this->CreateLevelOutline(renderer, &(doseIT.Value()), pref, points, lines, colors);
+      levels.push_back(&(doseIT.Value()));
     } // end of if visible dose value
   }   // end of loop over all does values
 
@@ -876,10 +881,12 @@ vtkSmartPointer<vtkPolyData> mitk::DoseImageVtkMapper2D::CreateOutlinePolyData(m
   {
     if (freeDoseIT->Value()->GetVisibleIsoLine())
     {
-      this->CreateLevelOutline(renderer, freeDoseIT->Value(), pref, points, lines, colors);
+      levels.push_back(freeDoseIT->Value());
     } // end of if visible dose value
   }   // end of loop over all does values
 
+  this->CreateLevelOutlines(renderer, levels, pref, points, lines, colors);
+
   // Create a polydata to store everything in
   vtkSmartPointer<vtkPolyData> polyData = vtkSmartPointer<vtkPolyData>::New();
   // Add the points to the dataset
@@ -890,13 +897,18 @@ vtkSmartPointer<vtkPolyData> mitk::DoseImageVtkMapper2D::CreateOutlinePolyData(m
   return polyData;
 }
 
-void mitk::DoseImageVtkMapper2D::CreateLevelOutline(mitk::BaseRenderer *renderer,
-                                                    const mitk::IsoDoseLevel *level,
-                                                    float pref,
-                                                    vtkSmartPointer<vtkPoints> points,
-                                                    vtkSmartPointer<vtkCellArray> lines,
-                                                    vtkSmartPointer<vtkUnsignedCharArray> colors)
+void mitk::DoseImageVtkMapper2D::CreateLevelOutlines(mitk::BaseRenderer *renderer,
+                                                     const std::vector<const mitk::IsoDoseLevel *> &levels,
+                                                     float pref,
+                                                     vtkSmartPointer<vtkPoints> points,
+                                                     vtkSmartPointer<vtkCellArray> lines,
+                                                     vtkSmartPointer<vtkUnsignedCharArray> colors)
 {
+  if (levels.empty())
+  {
+    return;
+  }
+
   LocalStorage *localStorage = this->GetLocalStorage(renderer);
 
   // get the min and max index values of each direction
@@ -911,154 +923,92 @@ void mitk::DoseImageVtkMapper2D::CreateLevelOutline(mitk::BaseRenderer *renderer
   // get the depth for each contour
   float depth = CalculateLayerDepth(renderer);
 
-  double doseValue = level->GetDoseValue() * pref;
-  mitk::IsoDoseLevel::ColorType isoColor = level->GetColor();
-  unsigned char colorLine[3] = {static_cast<unsigned char>(isoColor.GetRed() * 255),
-                                static_cast<unsigned char>(isoColor.GetGreen() * 255),
-                                static_cast<unsigned char>(isoColor.GetBlue() * 255)};
-
-  int x = xMin; // pixel index x
-  int y = yMin; // pixel index y
-  float *currentPixel;
-
   // We take the pointer to the first pixel of the image
-  currentPixel = static_cast<float *>(localStorage->m_ReslicedImage->GetScalarPointer());
+  const float *firstPixel = static_cast<const float *>(localStorage->m_ReslicedImage->GetScalarPointer());
 
-  if (!currentPixel){
+  if (!firstPixel)
+  {
     mitkThrow() << "currentPixel invalid";
   }
 
-  while (y <= yMax)
+  // sort the levels by their absolute dose, so that the number of thresholds a pixel reaches
+  // identifies all levels it lies inside of
+  struct LevelInfo
   {
-    // if the current pixel value is set to something
-    if ((currentPixel) && (*currentPixel >= doseValue))
-    {
-      // check in which direction a line is necessary
-      // a line is added if the neighbor of the current pixel has the value 0
-      // and if the pixel is located at the edge of the image
-
-      // if   vvvvv  not the first line vvvvv
-      if (y > yMin && *(currentPixel - line) < doseValue)
-      { // x direction - bottom edge of the pixel
-        // add the 2 points
-        vtkIdType p1 =
-          points->InsertNextPoint(x * localStorage->m_mmPerPixel[0], y * localStorage->m_mmPerPixel[1], depth);
-        vtkIdType p2 =
-          points->InsertNextPoint((x + 1) * localStorage->m_mmPerPixel[0], y * localStorage->m_mmPerPixel[1], depth);
-        // add the line between both points
-        lines->InsertNextCell(2);
-        lines->InsertCellPoint(p1);
-        lines->InsertCellPoint(p2);
-        colors->InsertNextTypedTuple(colorLine);
-      }
-
-      // if   vvvvv  not the last line vvvvv
-      if (y < yMax && *(currentPixel + line) < doseValue)
-      { // x direction - top edge of the pixel
-        vtkIdType p1 =
-          points->InsertNextPoint(x * localStorage->m_mmPerPixel[0], (y + 1) * localStorage->m_mmPerPixel[1], depth);
-        vtkIdType p2 = points->InsertNextPoint(
-          (x + 1) * localStorage->m_mmPerPixel[0], (y + 1) * localStorage->m_mmPerPixel[1], depth);
-        lines->InsertNextCell(2);
-        lines->InsertCellPoint(p1);
-        lines->InsertCellPoint(p2);
-        colors->InsertNextTypedTuple(colorLine);
-      }
+    double doseValue;
+    unsigned char color[3];
+  };
 
-      // if   vvvvv  not the first pixel vvvvv
-      if ((x > xMin || y > yMin) && *(currentPixel - 1) < doseValue)
-      { // y direction - left edge of the pixel
-        vtkIdType p1 =
-          points->InsertNextPoint(x * localStorage->m_mmPerPixel[0], y * localStorage->m_mmPerPixel[1], depth);
-        vtkIdType p2 =
-          points->InsertNextPoint(x * localStorage->m_mmPerPixel[0], (y + 1) * localStorage->m_mmPerPixel[1], depth);
-        lines->InsertNextCell(2);
-        lines->InsertCellPoint(p1);
-        lines->InsertCellPoint(p2);
-        colors->InsertNextTypedTuple(colorLine);
-      }
+  std::vector<LevelInfo> levelInfos;
+  levelInfos.reserve(levels.size());
+  for (const auto *level : levels)
+  {
+    mitk::IsoDoseLevel::ColorType isoColor = level->GetColor();
+    levelInfos.push_back({level->GetDoseValue() * pref,
+                          {static_cast<unsigned char>(isoColor.GetRed() * 255),
+                           static_cast<unsigned char>(isoColor.GetGreen() * 255),
+                           static_cast<unsigned char>(isoColor.GetBlue() * 255)}});
+  }
+  std::stable_sort(levelInfos.begin(), levelInfos.end(), [](const LevelInfo &a, const LevelInfo &b) {
+    return a.doseValue < b.doseValue;
+  });
 
-      // if   vvvvv  not the last pixel vvvvv
-      if ((y < yMax || (x < xMax)) && *(currentPixel + 1) < doseValue)
-      { // y direction - right edge of the pixel
-        vtkIdType p1 =
-          points->InsertNextPoint((x + 1) * localStorage->m_mmPerPixel[0], y * localStorage->m_mmPerPixel[1], depth);
-        vtkIdType p2 = points->InsertNextPoint(
-          (x + 1) * localStorage->m_mmPerPixel[0], (y + 1) * localStorage->m_mmPerPixel[1], depth);
-        lines->InsertNextCell(2);
-        lines->InsertCellPoint(p1);
-        lines->InsertCellPoint(p2);
-        colors->InsertNextTypedTuple(colorLine);
-      }
+  std::vector<double> thresholds;
+  thresholds.reserve(levelInfos.size());
+  for (const auto &info : levelInfos)
+  {
+    thresholds.push_back(info.doseValue);
+  }
 
-      /*  now consider pixels at the edge of the image  */
-
-      // if   vvvvv  left edge of image vvvvv
-      if (x == xMin)
-      { // draw left edge of the pixel
-        vtkIdType p1 =
-          points->InsertNextPoint(x * localStorage->m_mmPerPixel[0], y * localStorage->m_mmPerPixel[1], depth);
-        vtkIdType p2 =
-          points->InsertNextPoint(x * localStorage->m_mmPerPixel[0], (y + 1) * localStorage->m_mmPerPixel[1], depth);
-        lines->InsertNextCell(2);
-        lines->InsertCellPoint(p1);
-        lines->InsertCellPoint(p2);
-        colors->InsertNextTypedTuple(colorLine);
-      }
+  // classify every pixel once: the class is the number of levels whose dose the pixel reaches
+  const std::size_t numberOfPixels = static_cast<std::size_t>(xMax - xMin + 1) * (yMax - yMin + 1);
+  std::vector<unsigned int> classes(numberOfPixels);
+  for (std::size_t i = 0; i < numberOfPixels; ++i)
+  {
+    classes[i] = static_cast<unsigned int>(
+      std::upper_bound(thresholds.begin(), thresholds.end(), static_cast<double>(firstPixel[i])) - thresholds.begin());
+  }
 
-      // if   vvvvv  right edge of image vvvvv
-      if (x == xMax)
-      { // draw right edge of the pixel
-        vtkIdType p1 =
-          points->InsertNextPoint((x + 1) * localStorage->m_mmPerPixel[0], y * localStorage->m_mmPerPixel[1], depth);
-        vtkIdType p2 = points->InsertNextPoint(
-          (x + 1) * localStorage->m_mmPerPixel[0], (y + 1) * localStorage->m_mmPerPixel[1], depth);
-        lines->InsertNextCell(2);
-        lines->InsertCellPoint(p1);
-        lines->InsertCellPoint(p2);
-        colors->InsertNextTypedTuple(colorLine);
-      }
+  const double xSpacing = localStorage->m_mmPerPixel[0];
+  const double ySpacing = localStorage->m_mmPerPixel[1];
 
-      // if   vvvvv  bottom edge of image vvvvv
-      if (y == yMin)
-      { // draw bottom edge of the pixel
-        vtkIdType p1 =
-          points->InsertNextPoint(x * localStorage->m_mmPerPixel[0], y * localStorage->m_mmPerPixel[1], depth);
-        vtkIdType p2 =
-          points->InsertNextPoint((x + 1) * localStorage->m_mmPerPixel[0], y * localStorage->m_mmPerPixel[1], depth);
-        lines->InsertNextCell(2);
-        lines->InsertCellPoint(p1);
-        lines->InsertCellPoint(p2);
-        colors->InsertNextTypedTuple(colorLine);
-      }
+  // adds the edge (x0,y0)-(x1,y1) for every level in [fromLevel, toLevel)
+  auto addEdge = [&](int x0, int y0, int x1, int y1, unsigned int fromLevel, unsigned int toLevel) {
+    for (unsigned int level = fromLevel; level < toLevel; ++level)
+    {
+      vtkIdType p1 = points->InsertNextPoint(x0 * xSpacing, y0 * ySpacing, depth);
+      vtkIdType p2 = points->InsertNextPoint(x1 * xSpacing, y1 * ySpacing, depth);
+      lines->InsertNextCell(2);
+      lines->InsertCellPoint(p1);
+      lines->InsertCellPoint(p2);
+      colors->InsertNextTypedTuple(levelInfos[level].color);
+    }
+  };
 
-      // if   vvvvv  top edge of image vvvvv
-      if (y == yMax)
-      { // draw top edge of the pixel
-        vtkIdType p1 =
-          points->InsertNextPoint(x * localStorage->m_mmPerPixel[0], (y + 1) * localStorage->m_mmPerPixel[1], depth);
-        vtkIdType p2 = points->InsertNextPoint(
-          (x + 1) * localStorage->m_mmPerPixel[0], (y + 1) * localStorage->m_mmPerPixel[1], depth);
-        lines->InsertNextCell(2);
-        lines->InsertCellPoint(p1);
-        lines->InsertCellPoint(p2);
-        colors->InsertNextTypedTuple(colorLine);
+  const unsigned int *currentClass = classes.data();
+  for (int y = yMin; y <= yMax; ++y)
+  {
+    for (int x = xMin; x <= xMax; ++x, ++currentClass)
+    {
+      const unsigned int pixelClass = *currentClass;
+      if (pixelClass == 0)
+      {
+        continue;
       }
-    } // end if currentpixel is set
-
-    x++;
 
-    if (x > xMax)
-    { // reached end of line
-      x = xMin;
-      y++;
+      // a line is added for every level the pixel reaches but its neighbor does not,
+      // and for every level the pixel reaches if it is located at the edge of the image
+      const unsigned int bottom = y > yMin ? std::min(pixelClass, *(currentClass - line)) : 0;
+      const unsigned int top = y < yMax ? std::min(pixelClass, *(currentClass + line)) : 0;
+      const unsigned int left = x > xMin ? std::min(pixelClass, *(currentClass - 1)) : 0;
+      const unsigned int right = x < xMax ? std::min(pixelClass, *(currentClass + 1)) : 0;
+
+      addEdge(x, y, x + 1, y, bottom, pixelClass);        // bottom edge of the pixel
+      addEdge(x, y + 1, x + 1, y + 1, top, pixelClass);   // top edge of the pixel
+      addEdge(x, y, x, y + 1, left, pixelClass);          // left edge of the pixel
+      addEdge(x + 1, y, x + 1, y + 1, right, pixelClass); // right edge of the pixel
     }
-
-    // Increase the pointer-position to the next pixel.
-    // This is safe, as the while-loop and the x-reset logic above makes
-    // sure we do not exceed the bounds of the image
-    currentPixel++;
-  } // end of while
+  }
 }
 
 void mitk::DoseImageVtkMapper2D::TransformActor(mitk::BaseRenderer *renderer)
@@ -17,6 +17,9 @@ found in the LICENSE file.
 
 #include "itkImageRegionConstIterator.h"
 
+#include <map>
+#include <vector>
+
 namespace itk
 {
   /** \brief Cost function for LiveWire purposes.
@@ -35,6 +38,9 @@ namespace itk
   To compute  the costs of the gradient magnitude dynamically
   an iverted map of the histogram of gradient magnitude image is used.
 
+  The feature images are computed once per image. The local costs of all pixels are precomputed on several
+  threads whenever the image or the cost map settings change, so GetCost() only looks them up.
+
   */
   template <class TInputImageType>
   class ITK_EXPORT ShortestPathCostFunctionLiveWire : public ShortestPathCostFunction<TInputImageType>
@@ -93,14 +99,31 @@ namespace itk
       this->m_CostMap = costMap;
       this->m_UseCostMap = true;
       this->m_MaxMapCosts = -1;
+      this->m_PixelCostsValid = false;
       this->Modified();
     }
 
-    void SetUseCostMap(bool useCostMap) { this->m_UseCostMap = useCostMap; }
+    void SetUseCostMap(bool useCostMap)
+    {
+      if (this->m_UseCostMap != useCostMap)
+      {
+        this->m_UseCostMap = useCostMap;
+        this->m_PixelCostsValid = false;
+        this->Modified();
+      }
+    }
     /**
      \brief Set the maximum of the dynamic cost map to save computation time.
     */
-    void SetCostMapMaximum(double max) { this->m_MaxMapCosts = max; }
+    void SetCostMapMaximum(double max)
+    {
+      if (this->m_MaxMapCosts != max)
+      {
+        this->m_MaxMapCosts = max;
+        this->m_PixelCostsValid = false;
+        this->Modified();
+      }
+    }
     enum Constants
     {
       MAPSCALEFACTOR = 10
@@ -121,6 +144,18 @@ namespace itk
     const FloatImageType *GetGradientMagnitudeImage() { return this->m_GradientMagnitudeImage.GetPointer(); };
     const FloatImageType *GetEdgeImage() { return this->m_EdgeImage.GetPointer(); };
     const VectorOutputImageType *GetGradientImage() { return this->m_GradientImage.GetPointer(); };
+    double GetGradientMaximum() const { return this->m_GradientMax; }
+
+    /** \brief Computes the gradient magnitude, gradient and edge images of the image, if not done yet.
+    Initialize() calls it, it can also be called in advance to share the images via SetFeatureImages().*/
+    void ComputeFeatureImages();
+
+    /** \brief Uses feature images which were computed by another cost function for the same image, instead of
+    computing them again. Must be called after SetImage().*/
+    void SetFeatureImages(const FloatImageType *gradientMagnitudeImage,
+                          const VectorOutputImageType *gradientImage,
+                          const FloatImageType *edgeImage,
+                          double gradientMax);
   protected:
     ShortestPathCostFunctionLiveWire();
 
@@ -152,6 +187,17 @@ namespace itk
 
     double m_MaxMapCosts;
 
+    /** \brief Local costs of going to each pixel, without the repulsive points and the diagonal scaling*/
+    std::vector<double> m_PixelCosts;
+
+    bool m_PixelCostsValid;
+
+    /** \brief Precomputes m_PixelCosts for the current feature images and cost map settings*/
+    void UpdatePixelCosts();
+
+    /** \brief Returns the gradient magnitude cost of the dynamic cost map for the given gradient magnitude bin*/
+    double GetCostMapGradientCost(int keyOfX);
+
   private:
     double SigmoidFunction(double I, double max, double min, double alpha, double beta);
   };
@@ -15,7 +15,11 @@ found in the LICENSE file.
 
 #include "itkShortestPathCostFunctionLiveWire.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <thread>
+#include <vector>
 
 #include <itkCannyEdgeDetectionImageFilter.h>
 #include <itkCastImageFilter.h>
@@ -29,7 +33,7 @@ namespace itk
 {
   // Constructor
   template <class TInputImageType>
-  ShortestPathCostFunctionLiveWire<TInputImageType>::ShortestPathCostFunctionLiveWire(): m_MinCosts(0.0), m_UseRepulsivePoints(false), m_GradientMax(0.0), m_Initialized(false),  m_UseCostMap(false), m_MaxMapCosts(-1.0)
+  ShortestPathCostFunctionLiveWire<TInputImageType>::ShortestPathCostFunctionLiveWire(): m_MinCosts(0.0), m_UseRepulsivePoints(false), m_GradientMax(0.0), m_Initialized(false),  m_UseCostMap(false), m_MaxMapCosts(-1.0), m_PixelCostsValid(false)
   {
   }
 
@@ -38,12 +42,14 @@ namespace itk
   {
     this->m_MaskImage->SetPixel(index, 255);
     m_UseRepulsivePoints = true;
+    this->Modified();
   }
 
   template <class TInputImageType>
   void ShortestPathCostFunctionLiveWire<TInputImageType>::RemoveRepulsivePoint(const IndexType &index)
   {
     this->m_MaskImage->SetPixel(index, 0);
+    this->Modified();
   }
 
   template <class TInputImageType>
@@ -64,6 +70,7 @@ namespace itk
 
       this->Modified();
       this->m_Initialized = false;
+      this->m_PixelCostsValid = false;
     }
   }
 
@@ -72,18 +79,12 @@ namespace itk
   {
     m_UseRepulsivePoints = false;
     this->m_MaskImage->FillBuffer(0);
+    this->Modified();
   }
 
   template <class TInputImageType>
   double ShortestPathCostFunctionLiveWire<TInputImageType>::GetCost(IndexType p1, IndexType p2)
   {
-    // local component costs
-    // weights
-    double w1;
-    double w2;
-    double w3;
-    double costs = 0.0;
-
     // if we are on the mask, return asap
     if (m_UseRepulsivePoints)
     {
@@ -91,198 +92,234 @@ namespace itk
         return 1000;
     }
 
-    double gradientX, gradientY;
-    gradientX = gradientY = 0.0;
-
-    double gradientCost;
-
-    double gradientMagnitude;
+    // the local costs only depend on p2 and are precomputed by UpdatePixelCosts()
+    double costs = m_PixelCosts[this->m_GradientMagnitudeImage->ComputeOffset(p2)];
 
-    // Gradient Magnitude costs
-    gradientMagnitude = this->m_GradientMagnitudeImage->GetPixel(p2);
-    gradientX = m_GradientImage->GetPixel(p2)[0];
-    gradientY = m_GradientImage->GetPixel(p2)[1];
-
-    if (m_UseCostMap && !m_CostMap.empty())
+    // scale by euclidian distance
+    if (p1[0] != p2[0] && p1[1] != p2[1])
     {
-      std::map<int, int>::iterator end = m_CostMap.end();
-      std::map<int, int>::iterator last = --(m_CostMap.end());
-
-      // current position
-      std::map<int, int>::iterator x;
-      // std::map< int, int >::key_type keyOfX = static_cast<std::map< int, int >::key_type>(gradientMagnitude * 1000);
-      int keyOfX = static_cast<int>(gradientMagnitude /* ShortestPathCostFunctionLiveWire::MAPSCALEFACTOR*/);
-      x = m_CostMap.find(keyOfX);
-
-      std::map<int, int>::iterator left2;
-      std::map<int, int>::iterator left1;
-      std::map<int, int>::iterator right1;
-      std::map<int, int>::iterator right2;
-
-      if (x == end)
-      { // x can also be == end if the key is not in the map but between two other keys
-        // search next key within map from x upwards
-        right1 = m_CostMap.lower_bound(keyOfX);
-      }
-      else
-      {
-        right1 = x;
-      }
-
-      if (right1 == end || right1 == last)
-      {
-        right2 = end;
-      }
-      else //( right1 != (end-1) )
-      {
-        auto temp = right1;
-        right2 = ++right1; // rght1 + 1
-        right1 = temp;
-      }
+      // diagonal neighbor
+      costs *= sqrt(2.0);
+    }
 
-      if (right1 == m_CostMap.begin())
-      {
-        left1 = end;
-        left2 = end;
-      }
-      else if (right1 == (++(m_CostMap.begin())))
-      {
-        auto temp = right1;
-        left1 = --right1; // rght1 - 1
-        right1 = temp;
-        left2 = end;
-      }
-      else
-      {
-        auto temp = right1;
-        left1 = --right1; // rght1 - 1
-        left2 = --right1; // rght1 - 2
-        right1 = temp;
-      }
+    return costs;
+  }
 
-      double partRight1, partRight2, partLeft1, partLeft2;
-      partRight1 = partRight2 = partLeft1 = partLeft2 = 0.0;
+  template <class TInputImageType>
+  double ShortestPathCostFunctionLiveWire<TInputImageType>::GetCostMapGradientCost(int keyOfX)
+  {
+    std::map<int, int>::iterator end = m_CostMap.end();
+    std::map<int, int>::iterator last = --(m_CostMap.end());
+
+    // current position
+    std::map<int, int>::iterator x;
+    x = m_CostMap.find(keyOfX);
+
+    std::map<int, int>::iterator left2;
+    std::map<int, int>::iterator left1;
+    std::map<int, int>::iterator right1;
+    std::map<int, int>::iterator right2;
+
+    if (x == end)
+    { // x can also be == end if the key is not in the map but between two other keys
+      // search next key within map from x upwards
+      right1 = m_CostMap.lower_bound(keyOfX);
+    }
+    else
+    {
+      right1 = x;
+    }
 
-      /*
-      f(x) = v(bin) * e^ ( -1/2 * (|x-k(bin)| / sigma)^2 )
+    if (right1 == end || right1 == last)
+    {
+      right2 = end;
+    }
+    else //( right1 != (end-1) )
+    {
+      auto temp = right1;
+      right2 = ++right1; // rght1 + 1
+      right1 = temp;
+    }
 
-      gaussian approximation
+    if (right1 == m_CostMap.begin())
+    {
+      left1 = end;
+      left2 = end;
+    }
+    else if (right1 == (++(m_CostMap.begin())))
+    {
+      auto temp = right1;
+      left1 = --right1; // rght1 - 1
+      right1 = temp;
+      left2 = end;
+    }
+    else
+    {
+      auto temp = right1;
+      left1 = --right1; // rght1 - 1
+      left2 = --right1; // rght1 - 2
+      right1 = temp;
+    }
 
-      where
-      v(bin) is the value in the map
-      k(bin) is the key
-      */
+    double partRight1, partRight2, partLeft1, partLeft2;
+    partRight1 = partRight2 = partLeft1 = partLeft2 = 0.0;
 
-      if (left2 != end)
-      {
-        partLeft2 = ShortestPathCostFunctionLiveWire<TInputImageType>::Gaussian(keyOfX, left2->first, left2->second);
-      }
+    /*
+    f(x) = v(bin) * e^ ( -1/2 * (|x-k(bin)| / sigma)^2 )
 
-      if (left1 != end)
-      {
-        partLeft1 = ShortestPathCostFunctionLiveWire<TInputImageType>::Gaussian(keyOfX, left1->first, left1->second);
-      }
+    gaussian approximation
 
-      if (right1 != end)
-      {
-        partRight1 = ShortestPathCostFunctionLiveWire<TInputImageType>::Gaussian(keyOfX, right1->first, right1->second);
-      }
+    where
+    v(bin) is the value in the map
+    k(bin) is the key
+    */
 
-      if (right2 != end)
-      {
-        partRight2 = ShortestPathCostFunctionLiveWire<TInputImageType>::Gaussian(keyOfX, right2->first, right2->second);
-      }
-
-      if (m_MaxMapCosts > 0.0)
-      {
-        gradientCost = 1.0 - ((partRight1 + partRight2 + partLeft1 + partLeft2) / m_MaxMapCosts);
-      }
-      else
-      { // use linear mapping
-        gradientCost = 1.0 - (gradientMagnitude / m_GradientMax);
-      }
-    }
-    else
-    { // use linear mapping
-      // value between 0 (good) and 1 (bad)
-      gradientCost = 1.0 - (gradientMagnitude / m_GradientMax);
+    if (left2 != end)
+    {
+      partLeft2 = ShortestPathCostFunctionLiveWire<TInputImageType>::Gaussian(keyOfX, left2->first, left2->second);
     }
 
-    //  Laplacian zero crossing costs
-    // f(p) =     0;   if I(p)=0
-    //     or     1;   if I(p)!=0
-    double laplacianCost;
-    typename Superclass::PixelType laplaceImageValue;
-
-    laplaceImageValue = m_EdgeImage->GetPixel(p2);
-
-    if (laplaceImageValue < 0 || laplaceImageValue > 0)
+    if (left1 != end)
     {
-      laplacianCost = 1.0;
+      partLeft1 = ShortestPathCostFunctionLiveWire<TInputImageType>::Gaussian(keyOfX, left1->first, left1->second);
     }
-    else
+
+    if (right1 != end)
     {
-      laplacianCost = 0.0;
+      partRight1 = ShortestPathCostFunctionLiveWire<TInputImageType>::Gaussian(keyOfX, right1->first, right1->second);
     }
 
-    // gradient vector at p1
-    double nGradientAtP1[2];
-    nGradientAtP1[0] = gradientX; // previously computed for gradient magnitude
-    nGradientAtP1[1] = gradientY;
+    if (right2 != end)
+    {
+      partRight2 = ShortestPathCostFunctionLiveWire<TInputImageType>::Gaussian(keyOfX, right2->first, right2->second);
+    }
 
-    // gradient direction unit vector of p1
-    nGradientAtP1[0] /= gradientMagnitude;
-    nGradientAtP1[1] /= gradientMagnitude;
-    //-------
+    double partRight1, partRight2, partLeft1, partLeft2;
+    partRight1 = partRight2 = partLeft1 = partLeft2 = 0.0;
 
-    // gradient vector at p1
-    double nGradientAtP2[2];
+    /*
+    f(x) = v(bin) * e^ ( -1/2 * (|x-k(bin)| / sigma)^2 )
 
-    nGradientAtP2[0] = m_GradientImage->GetPixel(p2)[0];
-    nGradientAtP2[1] = m_GradientImage->GetPixel(p2)[1];
+    gaussian approximation
 
-    nGradientAtP2[0] /= m_GradientMagnitudeImage->GetPixel(p2);
-    nGradientAtP2[1] /= m_GradientMagnitudeImage->GetPixel(p2);
+    where
+    v(bin) is the value in the map
+    k(bin) is the key
+    */
 
-    double scalarProduct = (nGradientAtP1[0] * nGradientAtP2[0]) + (nGradientAtP1[1] * nGradientAtP2[1]);
-    if (std::abs(scalarProduct) >= 1.0)
+    if (left2 != end)
     {
-      // this should probably not happen; make sure the input for acos is valid
-      scalarProduct = 0.999999999;
+      partLeft2 = ShortestPathCostFunctionLiveWire<TInputImageType>::Gaussian(keyOfX, left2->first, left2->second);
     }
 
-    double gradientDirectionCost = acos(scalarProduct) / 3.14159265;
-
-    if (this->m_UseCostMap)
+    if (left1 != end)
     {
-      w1 = 0.43;
-      w2 = 0.43;
-      w3 = 0.14;
+      partLeft1 = ShortestPathCostFunctionLiveWire<TInputImageType>::Gaussian(keyOfX, left1->first, left1->second);
     }
-    else
+
+    if (right1 != end)
     {
-      w1 = 0.10;
-      w2 = 0.85;
-      w3 = 0.05;
+      partRight1 = ShortestPathCostFunctionLiveWire<TInputImageType>::Gaussian(keyOfX, right1->first, right1->second);
     }
-    costs = w1 * laplacianCost + w2 * gradientCost + w3 * gradientDirectionCost;
 
-    // scale by euclidian distance
-    double costScale;
-    if (p1[0] == p2[0] || p1[1] == p2[1])
+    if (right2 != end)
     {
-      // horizontal or vertical neighbor
-      costScale = 1.0;
+      partRight2 = ShortestPathCostFunctionLiveWire<TInputImageType>::Gaussian(keyOfX, right2->first, right2->second);
     }
-    else
+
+    return 1.0 - ((partRight1 + partRight2 + partLeft1 + partLeft2) / m_MaxMapCosts);
+  }
+
+  template <class TInputImageType>
+  void ShortestPathCostFunctionLiveWire<TInputImageType>::UpdatePixelCosts()
+  {
+    const float *gradientMagnitudes = this->m_GradientMagnitudeImage->GetBufferPointer();
+    const OutputPixelType *gradients = this->m_GradientImage->GetBufferPointer();
+    const float *edges = this->m_EdgeImage->GetBufferPointer();
+    const std::size_t numberOfPixels = this->m_GradientMagnitudeImage->GetBufferedRegion().GetNumberOfPixels();
+    m_PixelCosts.resize(numberOfPixels);
+
+    // the dynamic cost map is evaluated once per bin of the gradient magnitude instead of once per edge
+    std::vector<double> costMapGradientCosts;
+    const bool useCostMapGradientCosts = m_UseCostMap && !m_CostMap.empty() && m_MaxMapCosts > 0.0;
+    if (useCostMapGradientCosts && m_GradientMax < numberOfPixels)
     {
-      // diagonal neighbor
-      costScale = sqrt(2.0);
+      costMapGradientCosts.resize(static_cast<std::size_t>(std::max(0.0, m_GradientMax)) + 1);
+      for (std::size_t key = 0; key < costMapGradientCosts.size(); ++key)
+        costMapGradientCosts[key] = this->GetCostMapGradientCost(static_cast<int>(key));
     }
 
-    costs *= costScale;
+    // weights of the laplacian, gradient magnitude and gradient direction costs
+    const double w1 = m_UseCostMap ? 0.43 : 0.10;
+    const double w2 = m_UseCostMap ? 0.43 : 0.85;
+    const double w3 = m_UseCostMap ? 0.14 : 0.05;
+    const double gradientMax = m_GradientMax;
 
-    return costs;
+    auto computeCosts = [&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        const double gradientMagnitude = gradientMagnitudes[i];
+
+        // value between 0 (good) and 1 (bad), a constant image has no edges at all
+        double gradientCost = gradientMax > 0.0 ? 1.0 - (gradientMagnitude / gradientMax) : 1.0;
+        if (useCostMapGradientCosts)
+        {
+          gradientCost = costMapGradientCosts.empty()
+                           ? this->GetCostMapGradientCost(static_cast<int>(gradientMagnitude))
+                           : costMapGradientCosts[static_cast<std::size_t>(gradientMagnitude)];
+        }
+
+        //  Laplacian zero crossing costs
+        // f(p) =     0;   if I(p)=0
+        //     or     1;   if I(p)!=0
+        const double laplacianCost = (edges[i] < 0 || edges[i] > 0) ? 1.0 : 0.0;
+
+        // scalar product of the gradient direction unit vectors, which are both taken at p2. Without a gradient
+        // the direction is undefined, it is treated like parallel directions.
+        double scalarProduct = 0.999999999;
+        if (gradientMagnitude > 0.0)
+        {
+          const double nGradientX = gradients[i][0] / gradientMagnitude;
+          const double nGradientY = gradients[i][1] / gradientMagnitude;
+          scalarProduct = (nGradientX * nGradientX) + (nGradientY * nGradientY);
+          if (std::abs(scalarProduct) >= 1.0)
+          {
+            // make sure the input for acos is valid
+            scalarProduct = 0.999999999;
+          }
+        }
+
+        const double gradientDirectionCost = acos(scalarProduct) / 3.14159265;
+
+        m_PixelCosts[i] = w1 * laplacianCost + w2 * gradientCost + w3 * gradientDirectionCost;
+      }
+    };
+
+    // rows of pixels are distributed to the threads
+    const std::size_t rowLength = this->m_GradientMagnitudeImage->GetBufferedRegion().GetSize(0);
+    const std::size_t numberOfRows = rowLength > 0 ? numberOfPixels / rowLength : 0;
+    const std::size_t rowsPerTask = 64;
+    const std::size_t numberOfTasks = (numberOfRows + rowsPerTask - 1) / rowsPerTask;
+    const std::size_t numberOfThreads =
+      std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), numberOfTasks);
+    std::atomic<std::size_t> nextTask(0);
+
+    auto worker = [&]() {
+      for (std::size_t task = nextTask++; task < numberOfTasks; task = nextTask++)
+      {
+        computeCosts(task * rowsPerTask * rowLength, std::min(numberOfRows, (task + 1) * rowsPerTask) * rowLength);
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < numberOfThreads; ++i)
+      threads.emplace_back(worker);
+    worker();
+
+    for (auto &thread : threads)
+      thread.join();
+
+    m_PixelCostsValid = true;
   }
 
   template <class TInputImageType>
@@ -293,6 +330,19 @@ namespace itk
 
   template <class TInputImageType>
   void ShortestPathCostFunctionLiveWire<TInputImageType>::Initialize()
+  {
+    this->ComputeFeatureImages();
+
+    if (!m_PixelCostsValid)
+      this->UpdatePixelCosts();
+
+    // check start/end point value
+    startValue = this->m_Image->GetPixel(this->m_StartIndex);
+    endValue = this->m_Image->GetPixel(this->m_EndIndex);
+  }
+
+  template <class TInputImageType>
+  void ShortestPathCostFunctionLiveWire<TInputImageType>::ComputeFeatureImages()
   {
     if (!m_Initialized)
     {
@@ -369,11 +419,24 @@ namespace itk
                       // but a different path.
 
       m_Initialized = true;
+      m_PixelCostsValid = false;
     }
+  }
 
-    // check start/end point value
-    startValue = this->m_Image->GetPixel(this->m_StartIndex);
-    endValue = this->m_Image->GetPixel(this->m_EndIndex);
+  template <class TInputImageType>
+  void ShortestPathCostFunctionLiveWire<TInputImageType>::SetFeatureImages(
+    const FloatImageType *gradientMagnitudeImage, const VectorOutputImageType *gradientImage,
+    const FloatImageType *edgeImage, double gradientMax)
+  {
+    // the feature images are only read, so they can be shared by several cost functions
+    this->m_GradientMagnitudeImage = const_cast<FloatImageType *>(gradientMagnitudeImage);
+    this->m_GradientImage = const_cast<VectorOutputImageType *>(gradientImage);
+    this->m_EdgeImage = const_cast<FloatImageType *>(edgeImage);
+    this->m_GradientMax = gradientMax;
+    this->m_MinCosts = 0.0;
+    this->m_Initialized = true;
+    this->m_PixelCostsValid = false;
+    this->Modified();
   }
 
   template <class TInputImageType>
@@ -15,6 +15,7 @@ found in the LICENSE file.
 #include "itkImageToImageFilter.h"
 #include "itkShortestPathCostFunction.h"
 #include "itkShortestPathNode.h"
+#include "itkShortestPathRadixHeap.h"
 #include <itkImageRegionIteratorWithIndex.h>
 
 #include <itkMacro.h>
@@ -35,6 +36,9 @@ found in the LICENSE file.
 // for GetVectorOrderImage
 // void AddEndIndex(const IndexType & EndIndex) //Optional. By calling this function you can add several endpoints! The
 // algorithm will look for several shortest Pathes. From Start to all Endpoints.
+// void SetReuseShortestPathTree(bool) // Optional (default=false), Calculate the shortest paths from the start point to
+// all pixels once and answer following end points by back-tracing. Recalculated only if the start point, the input or
+// the cost function changes. Ideal for interactive use (e.g. live-wire), where only the end point moves.
 //
 /// GET FUNCTIONS
 // std::vector< itk::Index<3> > GetVectorPath(); // returns the shortest path as vector
@@ -130,6 +134,12 @@ namespace itk
     itkSetMacro(ActivateTimeOut, bool);
     itkGetMacro(ActivateTimeOut, bool);
 
+    // \brief (default=false), Calculate the shortest path tree from the start index to all pixels (Dijkstra) once and
+    // answer all following end indices by back-tracing it. The tree is recalculated only if the start index, the input,
+    // the cost function or the neighborhood changes. The cost function must not depend on the end index.
+    itkSetMacro(ReuseShortestPathTree, bool);
+    itkGetMacro(ReuseShortestPathTree, bool);
+
     // \brief returns shortest Path as vector
     std::vector<IndexType> GetVectorPath();
 
@@ -183,6 +193,14 @@ namespace itk
 
     bool m_Initialized;
 
+    bool m_ReuseShortestPathTree;
+    bool m_ShortestPathTreeValid;
+    NodeNumType m_ShortestPathTreeStartNode;
+    bool m_ShortestPathTreeFullNeighbors;
+    ModifiedTimeType m_ShortestPathTreeInputMTime;
+    ModifiedTimeType m_ShortestPathTreeCostFunctionMTime;
+    ShortestPathRadixHeap m_ShortestPathTreeHeap;
+
     CostFunctionTypePointer m_CostFunction;
     IndexType m_StartIndex, m_EndIndex;
     std::vector<IndexType> m_VectorPath;
@@ -222,6 +240,12 @@ namespace itk
 
     // \brief Start ShortestPathSearch
     void StartShortestPathSearch();
+
+    // \brief Returns true if the current shortest path tree was calculated with the current settings
+    bool IsShortestPathTreeValid();
+
+    // \brief Calculates the shortest paths from the start node to all nodes (used if m_ReuseShortestPathTree is on)
+    void CalculateShortestPathTree();
   };
 
 } // end of namespace itk
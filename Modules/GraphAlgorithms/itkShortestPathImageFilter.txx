@@ -34,7 +34,13 @@ namespace itk
       m_CalcAllDistances(false),
       multipleEndPoints(false),
       m_ActivateTimeOut(false),
-      m_Initialized(false)
+      m_Initialized(false),
+      m_ReuseShortestPathTree(false),
+      m_ShortestPathTreeValid(false),
+      m_ShortestPathTreeStartNode(0),
+      m_ShortestPathTreeFullNeighbors(false),
+      m_ShortestPathTreeInputMTime(0),
+      m_ShortestPathTreeCostFunctionMTime(0)
   {
     m_endPoints.clear();
     m_endPointsClosed.clear();
@@ -704,6 +710,123 @@ namespace itk
     }
   }
 
+  template <class TInputImageType, class TOutputImageType>
+  bool ShortestPathImageFilter<TInputImageType, TOutputImageType>::IsShortestPathTreeValid()
+  {
+    return m_ShortestPathTreeValid && m_Nodes != nullptr && m_ShortestPathTreeStartNode == m_Graph_StartNode &&
+           m_ShortestPathTreeFullNeighbors == m_Graph_fullNeighbors &&
+           m_ShortestPathTreeInputMTime == this->GetInput()->GetMTime() &&
+           m_ShortestPathTreeCostFunctionMTime == m_CostFunction->GetMTime();
+  }
+
+  template <class TInputImageType, class TOutputImageType>
+  void ShortestPathImageFilter<TInputImageType, TOutputImageType>::CalculateShortestPathTree()
+  {
+    const unsigned int dim = InputImageType::ImageDimension;
+    const InputImageSizeType &size = this->GetInput()->GetRequestedRegion().GetSize();
+
+    NodeNumType numberOfNodes = 1;
+    for (unsigned int i = 0; i < dim; ++i)
+      numberOfNodes *= size[i];
+
+    if (m_Nodes == nullptr || numberOfNodes != m_Graph_NumberOfNodes)
+    {
+      delete[] m_Nodes;
+      m_Nodes = new ShortestPathNode[numberOfNodes];
+      m_Graph_NumberOfNodes = numberOfNodes;
+    }
+
+    for (NodeNumType i = 0; i < m_Graph_NumberOfNodes; i++)
+    {
+      m_Nodes[i].distAndEst = -1;
+      m_Nodes[i].distance = -1;
+      m_Nodes[i].prevNode = -1;
+      m_Nodes[i].mainListIndex = i;
+      m_Nodes[i].closed = false;
+    }
+
+    // the nodes are not in the initial state anymore
+    m_Initialized = false;
+    m_VectorOrder.clear();
+
+    // offsets of the neighbors, the same neighborhood as GetNeighbors()
+    typedef typename IndexType::OffsetType OffsetType;
+    std::vector<OffsetType> neighborOffsets;
+    OffsetType offset;
+    offset.Fill(-1);
+    for (;;)
+    {
+      unsigned int numberOfNonZeros = 0;
+      for (unsigned int i = 0; i < dim; ++i)
+        numberOfNonZeros += offset[i] != 0 ? 1 : 0;
+
+      if (numberOfNonZeros == 1 || (m_Graph_fullNeighbors && numberOfNonZeros > 1))
+        neighborOffsets.push_back(offset);
+
+      unsigned int i = 0;
+      while (i < dim && offset[i] == 1)
+        offset[i++] = -1;
+      if (i == dim)
+        break;
+      ++offset[i];
+    }
+
+    m_CostFunction->Initialize();
+
+    m_Nodes[m_Graph_StartNode].distance = 0;
+    m_Nodes[m_Graph_StartNode].distAndEst = 0;
+
+    m_ShortestPathTreeHeap.Clear();
+    m_ShortestPathTreeHeap.Push(0, m_Graph_StartNode);
+
+    while (!m_ShortestPathTreeHeap.Empty())
+    {
+      const NodeNumType currentNode = m_ShortestPathTreeHeap.Pop();
+      ShortestPathNode &current = m_Nodes[currentNode];
+
+      // outdated entry of a node whose distance was decreased meanwhile
+      if (current.closed)
+        continue;
+      current.closed = true;
+
+      if (m_StoreVectorOrder)
+        m_VectorOrder.push_back(currentNode);
+
+      const IndexType coordCurNode = NodeToCoord(currentNode);
+
+      for (const auto &neighborOffset : neighborOffsets)
+      {
+        const IndexType coordNeighborNode = coordCurNode + neighborOffset;
+        if (!CoordIsInBounds(coordNeighborNode))
+          continue;
+
+        ShortestPathNode &neighbor = m_Nodes[CoordToNode(coordNeighborNode)];
+        if (neighbor.closed)
+          continue;
+
+        // Dijkstra (and the heap) require non-negative costs
+        double cost = m_CostFunction->GetCost(coordCurNode, coordNeighborNode);
+        if (!(cost > 0))
+          cost = 0;
+
+        const double newDistance = current.distance + cost;
+        if (neighbor.distance == -1 || newDistance < neighbor.distance)
+        {
+          neighbor.distance = newDistance;
+          neighbor.distAndEst = newDistance;
+          neighbor.prevNode = currentNode;
+          m_ShortestPathTreeHeap.Push(newDistance, neighbor.mainListIndex);
+        }
+      }
+    }
+
+    m_ShortestPathTreeValid = true;
+    m_ShortestPathTreeStartNode = m_Graph_StartNode;
+    m_ShortestPathTreeFullNeighbors = m_Graph_fullNeighbors;
+    m_ShortestPathTreeInputMTime = this->GetInput()->GetMTime();
+    m_ShortestPathTreeCostFunctionMTime = m_CostFunction->GetMTime();
+  }
+
   template <class TInputImageType, class TOutputImageType>
   void ShortestPathImageFilter<TInputImageType, TOutputImageType>::MakeOutputs()
   {
@@ -861,16 +984,30 @@ namespace itk
 
     if (m_Nodes)
       delete[] m_Nodes;
+    m_Nodes = nullptr;
+    m_ShortestPathTreeValid = false;
   }
 
   template <class TInputImageType, class TOutputImageType>
   void ShortestPathImageFilter<TInputImageType, TOutputImageType>::GenerateData()
   {
-    // Build Graph
-    InitGraph();
+    if (m_ReuseShortestPathTree)
+    {
+      // all end points can be answered from the shortest path tree
+      if (!IsShortestPathTreeValid())
+        CalculateShortestPathTree();
+
+      m_endPointsClosed.insert(m_endPointsClosed.end(), m_endPoints.begin(), m_endPoints.end());
+      m_endPoints.clear();
+    }
+    else
+    {
+      // Build Graph
+      InitGraph();
 
-    // Calc Shortest Parth
-    StartShortestPathSearch();
+      // Calc Shortest Parth
+      StartShortestPathSearch();
+    }
 
     // Fill Shortest Path
     MakeShortestPathVector();
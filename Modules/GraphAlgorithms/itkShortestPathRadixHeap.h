@@ -0,0 +1,119 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+#ifndef __itkShortestPathRadixHeap_h_
+#define __itkShortestPathRadixHeap_h_
+
+#include "itkShortestPathNode.h"
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+  /** \brief Monotone priority queue of nodes for Dijkstra's algorithm.
+
+  A radix heap sorts the nodes into buckets by the highest bit in which their distance differs from the
+  distance of the last popped node. Pushing is O(1) and every node is moved to a lower bucket at most once per
+  bit, no tree of heap allocated elements is maintained.
+
+  The distances must not be negative and must not be smaller than the distance of the last popped node, which
+  is always the case for Dijkstra's algorithm with non-negative costs. Non-negative IEEE doubles have the same
+  order as their bit patterns, so the buckets are computed on the bits directly.
+
+  Nodes whose distance decreases are simply pushed again, the outdated entries have to be skipped by the caller.
+  */
+  class ShortestPathRadixHeap
+  {
+  public:
+    ShortestPathRadixHeap() : m_Buckets(65), m_Last(0), m_Size(0) {}
+
+    void Clear()
+    {
+      for (auto &bucket : m_Buckets)
+        bucket.clear();
+      m_Last = 0;
+      m_Size = 0;
+    }
+
+    bool Empty() const { return m_Size == 0; }
+
+    void Push(DistanceType distance, NodeNumType node)
+    {
+      std::uint64_t key = ToKey(distance);
+      if (key < m_Last)
+        key = m_Last;
+      m_Buckets[GetBucket(key)].emplace_back(key, node);
+      ++m_Size;
+    }
+
+    /** \brief Removes a node with minimal distance and returns it. The heap must not be empty. */
+    NodeNumType Pop()
+    {
+      if (m_Buckets[0].empty())
+      {
+        std::size_t i = 1;
+        while (m_Buckets[i].empty())
+          ++i;
+
+        // all entries of the first non-empty bucket move to lower buckets relative to its minimum
+        auto &bucket = m_Buckets[i];
+        m_Last = bucket.front().first;
+        for (const auto &entry : bucket)
+        {
+          if (entry.first < m_Last)
+            m_Last = entry.first;
+        }
+        for (const auto &entry : bucket)
+          m_Buckets[GetBucket(entry.first)].push_back(entry);
+        bucket.clear();
+      }
+
+      const NodeNumType node = m_Buckets[0].back().second;
+      m_Buckets[0].pop_back();
+      --m_Size;
+      return node;
+    }
+
+  private:
+    typedef std::pair<std::uint64_t, NodeNumType> EntryType;
+
+    static std::uint64_t ToKey(DistanceType distance)
+    {
+      if (!(distance > 0))
+        return 0;
+
+      std::uint64_t key;
+      std::memcpy(&key, &distance, sizeof(key));
+      return key;
+    }
+
+    std::size_t GetBucket(std::uint64_t key) const
+    {
+      std::uint64_t difference = key ^ m_Last;
+      std::size_t bucket = 0;
+      while (difference != 0)
+      {
+        difference >>= 1;
+        ++bucket;
+      }
+      return bucket;
+    }
+
+    std::vector<std::vector<EntryType>> m_Buckets;
+    std::uint64_t m_Last;
+    std::size_t m_Size;
+  };
+}
+
+#endif
@@ -12,6 +12,10 @@ found in the LICENSE file.
 
 #include "mitkNavigationDataEvaluationFilter.h"
 #include <mitkPointSetStatisticsCalculator.h>
+#include "mitkIGTTimeStamp.h"
+
+#include <iomanip>
+#include <sstream>
 
 mitk::NavigationDataEvaluationFilter::NavigationDataEvaluationFilter()
   : mitk::NavigationDataToNavigationDataFilter()
@@ -27,6 +31,8 @@ void mitk::NavigationDataEvaluationFilter::GenerateData()
   this->CreateOutputsForAllInputs(); // make sure that we have the same number of outputs as inputs
   this->CreateMembersForAllInputs();
 
+  const double now = mitk::IGTTimeStamp::GetInstance()->GetElapsed();
+
   /* update outputs with tracking data from tools */
   for (unsigned int i = 0; i < this->GetNumberOfOutputs(); ++i)
   {
@@ -43,6 +49,7 @@ void mitk::NavigationDataEvaluationFilter::GenerateData()
     {
       m_LoggedPositions[i].push_back(input->GetPosition());
       m_LoggedQuaternions[i].push_back(input->GetOrientation());
+      this->AddLatencySamples(i, input, now);
     }
     else
     {
@@ -74,6 +81,70 @@ void mitk::NavigationDataEvaluationFilter::ResetStatistic()
   for (unsigned int i = 0; i < m_LoggedPositions.size(); i++) m_LoggedPositions[i] = std::vector<mitk::Point3D>();
   for (unsigned int i = 0; i < m_LoggedQuaternions.size(); i++) m_LoggedQuaternions[i] = std::vector<mitk::Quaternion>();
   for (unsigned int i = 0; i < m_InvalidSamples.size(); i++) m_InvalidSamples[i] = 0;
+  for (auto& latencies : m_Latencies) latencies.second.Reset();
+  m_StageLatencies.clear();
+}
+
+void mitk::NavigationDataEvaluationFilter::AddLatencySamples(std::size_t input, const mitk::NavigationData* nd,
+  double now)
+{
+  m_Latencies[input].AddSample(now - nd->GetIGTTimeStamp());
+
+  const mitk::NavigationData::StageTimeStampsType& stages = nd->GetStageTimeStamps();
+  auto& stageLatencies = m_StageLatencies[input];
+
+  // the pipeline was changed, start a new statistic
+  bool pipelineChanged = stageLatencies.size() != stages.size();
+  for (std::size_t i = 0; !pipelineChanged && i < stages.size(); ++i)
+    pipelineChanged = stageLatencies[i].first != stages[i].first;
+
+  if (pipelineChanged)
+  {
+    stageLatencies.clear();
+    for (const auto& stage : stages)
+      stageLatencies.emplace_back(stage.first, mitk::NavigationDataLatencyStatistics());
+  }
+
+  double previousTimeStamp = nd->GetIGTTimeStamp();
+  for (std::size_t i = 0; i < stages.size(); ++i)
+  {
+    stageLatencies[i].second.AddSample(stages[i].second - previousTimeStamp);
+    previousTimeStamp = stages[i].second;
+  }
+}
+
+const mitk::NavigationDataLatencyStatistics& mitk::NavigationDataEvaluationFilter::GetLatencyStatistics(int input)
+{
+  return m_Latencies[input];
+}
+
+double mitk::NavigationDataEvaluationFilter::GetLatencyPercentile(int input, double percentile)
+{
+  return m_Latencies[input].GetPercentile(percentile);
+}
+
+const std::vector<std::pair<std::string, mitk::NavigationDataLatencyStatistics> >&
+mitk::NavigationDataEvaluationFilter::GetStageLatencyStatistics(int input)
+{
+  return m_StageLatencies[input];
+}
+
+std::string mitk::NavigationDataEvaluationFilter::GetLatencyReport(int input)
+{
+  const mitk::NavigationDataLatencyStatistics& latencies = m_Latencies[input];
+
+  std::ostringstream report;
+  report << std::fixed << std::setprecision(3);
+  report << "Latency of " << latencies.GetNumberOfSamples() << " samples [ms]: p50 " << latencies.GetPercentile(50)
+         << ", p99 " << latencies.GetPercentile(99) << ", max " << latencies.GetMaximum() << "\n";
+
+  for (const auto& stage : m_StageLatencies[input])
+  {
+    report << "  " << stage.first << ": p50 " << stage.second.GetPercentile(50) << ", p99 "
+           << stage.second.GetPercentile(99) << "\n";
+  }
+
+  return report.str();
 }
 
 int mitk::NavigationDataEvaluationFilter::GetNumberOfAnalysedNavigationData(int input)
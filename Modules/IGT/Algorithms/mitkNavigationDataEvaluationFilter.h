@@ -15,6 +15,7 @@ found in the LICENSE file.
 #define MITKNavigationDataEvaluationFilter_H_HEADER_INCLUDED_
 
 #include <mitkNavigationDataToNavigationDataFilter.h>
+#include <mitkNavigationDataLatencyStatistics.h>
 #include <mitkPointSet.h>
 #include <itkQuaternionRigidTransform.h>
 #include <itkTransform.h>
@@ -26,6 +27,12 @@ namespace mitk {
   * \brief NavigationDataEvaluationFilter calculates statistical data (mean value, mean error, etc.) on the input navigation data.
   * Input navigation data are set 1:1 on output navigation data.
   *
+  * The filter also measures the latency of the valid input navigation data, which is the time between their
+  * acquisition (IGT timestamp) and the update of this filter. If latency measurement is enabled for the filters
+  * of the pipeline (see NavigationDataSource::SetLatencyMeasurementEnabled()), the processing time of every stage
+  * is evaluated as well. Put the filter at the end of the pipeline, e.g. after a
+  * NavigationDataObjectVisualizationFilter, to measure the latency up to the rendering.
+  *
   * \ingroup IGT
   */
   class MITKIGT_EXPORT NavigationDataEvaluationFilter : public NavigationDataToNavigationDataFilter
@@ -85,6 +92,18 @@ namespace mitk {
     /** @return Returns a logged orientation on position i of the specified input. If there is no orientation on position i the method returns [0,0,0,0] */
     mitk::Quaternion GetLoggedOrientation(unsigned int i, int input);
 
+    /** @return Returns the latency statistic (in milliseconds, from acquisition to this filter) of the specified input. */
+    const mitk::NavigationDataLatencyStatistics& GetLatencyStatistics(int input);
+    /** @return Returns the given percentile (e.g. 50 or 99) of the latency in milliseconds of the specified input. */
+    double GetLatencyPercentile(int input, double percentile);
+    /** @return Returns the latency statistics of the pipeline stages of the specified input, in the order of the
+      *         pipeline. The latency of a stage is the time since the previous stage (or the acquisition for the first
+      *         one). Empty if latency measurement is not enabled for the pipeline. */
+    const std::vector<std::pair<std::string, mitk::NavigationDataLatencyStatistics> >& GetStageLatencyStatistics(int input);
+    /** @return Returns a human readable report of the end-to-end and per-stage latencies (50th and 99th percentile)
+      *         of the specified input. */
+    std::string GetLatencyReport(int input);
+
   protected:
 
     NavigationDataEvaluationFilter();
@@ -104,6 +123,11 @@ namespace mitk {
     std::map<std::size_t,std::vector<mitk::Point3D> > m_LoggedPositions; //a map here, to have one list for every navigation data
     std::map<std::size_t,std::vector<mitk::Quaternion> > m_LoggedQuaternions;
     std::map<std::size_t,int> m_InvalidSamples;
+    std::map<std::size_t,mitk::NavigationDataLatencyStatistics> m_Latencies;
+    std::map<std::size_t,std::vector<std::pair<std::string,mitk::NavigationDataLatencyStatistics> > > m_StageLatencies;
+
+    /** @brief Adds the latencies of the given input navigation data to the statistics of the specified input. */
+    void AddLatencySamples(std::size_t input, const mitk::NavigationData* nd, double now);
 
     mitk::Quaternion GetMean(std::vector<mitk::Quaternion> list);
 
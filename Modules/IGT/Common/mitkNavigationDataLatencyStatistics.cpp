@@ -0,0 +1,82 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkNavigationDataLatencyStatistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+mitk::NavigationDataLatencyStatistics::NavigationDataLatencyStatistics(std::size_t maximumNumberOfSamples)
+  : m_MaximumNumberOfSamples(std::max<std::size_t>(1, maximumNumberOfSamples)), m_NextSample(0)
+{
+}
+
+void mitk::NavigationDataLatencyStatistics::AddSample(double latency)
+{
+  if (m_Samples.size() < m_MaximumNumberOfSamples)
+  {
+    m_Samples.push_back(latency);
+  }
+  else
+  {
+    // overwrite the oldest sample
+    m_Samples[m_NextSample] = latency;
+    m_NextSample = (m_NextSample + 1) % m_MaximumNumberOfSamples;
+  }
+}
+
+void mitk::NavigationDataLatencyStatistics::Reset()
+{
+  m_Samples.clear();
+  m_NextSample = 0;
+}
+
+std::size_t mitk::NavigationDataLatencyStatistics::GetNumberOfSamples() const
+{
+  return m_Samples.size();
+}
+
+double mitk::NavigationDataLatencyStatistics::GetPercentile(double percentile) const
+{
+  if (m_Samples.empty())
+    return 0.0;
+
+  percentile = std::min(100.0, std::max(0.0, percentile));
+  const auto rank = static_cast<std::size_t>(std::ceil(percentile / 100.0 * m_Samples.size()));
+  const std::size_t index = rank > 0 ? rank - 1 : 0;
+
+  std::vector<double> samples(m_Samples);
+  std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+  return samples[index];
+}
+
+double mitk::NavigationDataLatencyStatistics::GetMedian() const
+{
+  return this->GetPercentile(50.0);
+}
+
+double mitk::NavigationDataLatencyStatistics::GetMean() const
+{
+  if (m_Samples.empty())
+    return 0.0;
+
+  return std::accumulate(m_Samples.begin(), m_Samples.end(), 0.0) / m_Samples.size();
+}
+
+double mitk::NavigationDataLatencyStatistics::GetMaximum() const
+{
+  if (m_Samples.empty())
+    return 0.0;
+
+  return *std::max_element(m_Samples.begin(), m_Samples.end());
+}
@@ -0,0 +1,71 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkNavigationDataLatencyStatistics_h
+#define mitkNavigationDataLatencyStatistics_h
+
+#include <MitkIGTExports.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace mitk {
+
+  /**
+  * \brief Collects latency samples (in milliseconds) and computes percentiles of them.
+  *
+  * Only the most recent samples are kept (see the constructor), so the statistic of a long running
+  * navigation session does not grow without bounds and reflects the current behavior of the pipeline.
+  *
+  * The class is not thread safe. Typical use is to add a sample for each navigation data at the end of
+  * a pipeline, e.g. IGTTimeStamp::GetInstance()->GetElapsed() - navigationData->GetIGTTimeStamp().
+  *
+  * \ingroup IGT
+  */
+  class MITKIGT_EXPORT NavigationDataLatencyStatistics
+  {
+  public:
+    /**
+    * \param maximumNumberOfSamples the number of most recent samples which are used for the statistic
+    */
+    explicit NavigationDataLatencyStatistics(std::size_t maximumNumberOfSamples = 10000);
+
+    void AddSample(double latency);
+
+    /** @brief Removes all samples. */
+    void Reset();
+
+    /** @return Returns the number of samples used for the statistic. */
+    std::size_t GetNumberOfSamples() const;
+
+    /**
+    * @return Returns the given percentile (0 to 100, nearest rank method) of the samples or 0 if there are none.
+    */
+    double GetPercentile(double percentile) const;
+
+    /** @return Returns the 50th percentile of the samples. */
+    double GetMedian() const;
+
+    /** @return Returns the mean of the samples or 0 if there are none. */
+    double GetMean() const;
+
+    /** @return Returns the maximum of the samples or 0 if there are none. */
+    double GetMaximum() const;
+
+  private:
+    std::size_t m_MaximumNumberOfSamples;
+    std::size_t m_NextSample;
+    std::vector<double> m_Samples;
+  };
+} // namespace mitk
+
+#endif
@@ -23,6 +23,7 @@ found in the LICENSE file.
 #include <fcntl.h>
 #include <unistd.h>
 #include <termios.h>
+#include <poll.h>
 #include <cerrno>
 
 #define INVALID_HANDLE_VALUE -1
@@ -31,6 +32,43 @@ found in the LICENSE file.
 #define OK 1
 #define ERROR_VALUE 0
 
+namespace
+{
+#ifdef WIN32
+  /** Waits for the completion of an overlapped operation. The timeouts set with SetCommTimeouts() still apply. */
+  BOOL CompleteOverlappedOperation(HANDLE handle, BOOL result, OVERLAPPED& overlapped, DWORD& numberOfBytes)
+  {
+    if (result == FALSE && GetLastError() == ERROR_IO_PENDING)
+      result = GetOverlappedResult(handle, &overlapped, &numberOfBytes, TRUE);
+    return result;
+  }
+
+  bool IsDataAvailable(HANDLE handle)
+  {
+    DWORD errors = 0;
+    COMSTAT status;
+    return ClearCommError(handle, &errors, &status) != FALSE && status.cbInQue > 0;
+  }
+#else
+  /** Waits until fileDescriptor is readable, a negative timeout waits indefinitely. */
+  bool PollForData(int fileDescriptor, int timeout)
+  {
+    pollfd descriptor;
+    descriptor.fd = fileDescriptor;
+    descriptor.events = POLLIN;
+    descriptor.revents = 0;
+
+    int result;
+    do
+    {
+      result = poll(&descriptor, 1, timeout);
+    } while (result == -1 && errno == EINTR);
+
+    return result > 0 && (descriptor.revents & POLLIN) != 0;
+  }
+#endif
+}
+
 mitk::SerialCommunication::SerialCommunication() : itk::Object(),
   m_DeviceName(""), m_PortNumber(COM1), m_BaudRate(BaudRate9600),
   m_DataBits(DataBits8), m_Parity(None), m_StopBits(StopBits1),
@@ -39,6 +77,9 @@ mitk::SerialCommunication::SerialCommunication() : itk::Object(),
 {
 #ifdef  WIN32 // Windows
   m_ComPortHandle = INVALID_HANDLE_VALUE;
+  m_ReadEvent = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+  m_WriteEvent = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+  m_WaitEvent = CreateEvent(nullptr, TRUE, FALSE, nullptr);
 #else // Posix
   m_FileDescriptor = INVALID_HANDLE_VALUE;
 #endif
@@ -47,6 +88,11 @@ mitk::SerialCommunication::SerialCommunication() : itk::Object(),
 mitk::SerialCommunication::~SerialCommunication()
 {
   CloseConnection();
+#ifdef WIN32
+  CloseHandle(m_ReadEvent);
+  CloseHandle(m_WriteEvent);
+  CloseHandle(m_WaitEvent);
+#endif
 }
 
 bool mitk::SerialCommunication::IsConnected()
@@ -70,7 +116,7 @@ int mitk::SerialCommunication::OpenConnection()
     0,             // no sharing
     0,             // no security flags
     OPEN_EXISTING, // open com port, don't create it
-    0,             // no flags
+    FILE_FLAG_OVERLAPPED, // allows waiting for received data with a timeout
     0);            // no template
   if (m_ComPortHandle == INVALID_HANDLE_VALUE)
     return ERROR_VALUE;
@@ -154,7 +200,10 @@ int mitk::SerialCommunication::Receive(std::string& answer, unsigned int numberO
 
   DWORD numberOfBytesRead = 0;
   char* buffer = new char[numberOfBytes];
-  if (ReadFile(m_ComPortHandle, buffer, numberOfBytes, &numberOfBytesRead, nullptr) != 0)
+  OVERLAPPED overlapped = {};
+  overlapped.hEvent = m_ReadEvent;
+  BOOL result = ReadFile(m_ComPortHandle, buffer, numberOfBytes, &numberOfBytesRead, &overlapped);
+  if (CompleteOverlappedOperation(m_ComPortHandle, result, overlapped, numberOfBytesRead) != 0)
   {
     if (numberOfBytesRead > 0) // data read
     {
@@ -186,10 +235,15 @@ int mitk::SerialCommunication::Receive(std::string& answer, unsigned int numberO
   unsigned long bytesRead = 0;
   unsigned long bytesLeft = numberOfBytes;
   auto  buffer = new char[numberOfBytes];
+  const int timeout = m_ReceiveTimeout == 0 ? -1 : static_cast<int>(m_ReceiveTimeout);
 
   while ((bytesLeft > 0) && (bytesRead < numberOfBytes))
   {
-    int num = read(m_FileDescriptor, &buffer[bytesRead], 1); // read one byte
+    if (!PollForData(m_FileDescriptor, timeout)) // sleep until data arrives
+      break;
+
+    // with an eol character, read byte by byte to not consume the beginning of the next reply
+    int num = read(m_FileDescriptor, &buffer[bytesRead], eol ? 1 : bytesLeft);
     if (num == -1) // ERROR_VALUE
     {
       if (errno == EAGAIN) // nonblocking, no byte there right now, but maybe next time
@@ -219,6 +273,46 @@ int mitk::SerialCommunication::Receive(std::string& answer, unsigned int numberO
 #endif
 }
 
+bool mitk::SerialCommunication::WaitForData(unsigned int timeout)
+{
+  if (m_Connected == false)
+    return false;
+
+#ifdef WIN32
+  if (m_ComPortHandle == INVALID_HANDLE_VALUE)
+    return false;
+
+  if (IsDataAvailable(m_ComPortHandle))
+    return true;
+
+  if (SetCommMask(m_ComPortHandle, EV_RXCHAR) == FALSE)
+    return false;
+
+  OVERLAPPED overlapped = {};
+  overlapped.hEvent = m_WaitEvent;
+  DWORD eventMask = 0;
+  if (WaitCommEvent(m_ComPortHandle, &eventMask, &overlapped) == FALSE)
+  {
+    if (GetLastError() != ERROR_IO_PENDING)
+      return false;
+
+    // setting the mask again completes a pending WaitCommEvent() on timeout
+    if (WaitForSingleObject(m_WaitEvent, timeout) != WAIT_OBJECT_0)
+      SetCommMask(m_ComPortHandle, EV_RXCHAR);
+
+    DWORD unused = 0;
+    GetOverlappedResult(m_ComPortHandle, &overlapped, &unused, TRUE);
+  }
+  return IsDataAvailable(m_ComPortHandle);
+
+#else // Posix
+  if (m_FileDescriptor == INVALID_HANDLE_VALUE)
+    return false;
+
+  return PollForData(m_FileDescriptor, static_cast<int>(timeout));
+#endif
+}
+
 int mitk::SerialCommunication::Send(const std::string& input, bool block)
 {
   //long retval = E2ERR_OPENFAILED;
@@ -232,7 +326,10 @@ int mitk::SerialCommunication::Send(const std::string& input, bool block)
     return ERROR_VALUE;
 
   DWORD bytesWritten = 0;
-  if (WriteFile(m_ComPortHandle, input.data(), static_cast<DWORD>(input.size()), &bytesWritten, nullptr) == TRUE)
+  OVERLAPPED overlapped = {};
+  overlapped.hEvent = m_WriteEvent;
+  BOOL result = WriteFile(m_ComPortHandle, input.data(), static_cast<DWORD>(input.size()), &bytesWritten, &overlapped);
+  if (CompleteOverlappedOperation(m_ComPortHandle, result, overlapped, bytesWritten) == TRUE)
     return OK;
   else
     return ERROR_VALUE;
@@ -151,6 +151,19 @@ namespace mitk
     */
     int Receive(std::string& answer, unsigned int numberOfBytes, const char *eol=nullptr);
 
+    /**
+    * \brief Wait until data has been received on the serial interface
+    *
+    * The calling thread is suspended (using poll() on Posix and an overlapped
+    * WaitCommEvent() on Windows) until at least one byte can be read or the
+    * timeout has expired. Use this method instead of fixed delays to wait for
+    * the reply of a device, Receive() waits in the same way before each read.
+    *
+    * \param[in] timeout  Maximum time to wait in milliseconds.
+    * \return true if data can be read, false if the timeout expired or an error occurred.
+    */
+    bool WaitForData(unsigned int timeout);
+
     /**
     * \brief Send the string input
     *
@@ -335,7 +348,10 @@ namespace mitk
     bool m_Connected;       ///< is set to true if a connection currently established
 
 #ifdef WIN32
-    HANDLE m_ComPortHandle;
+    HANDLE m_ComPortHandle; ///< opened for overlapped I/O, so that WaitForData() can be interrupted by a timeout
+    HANDLE m_ReadEvent;
+    HANDLE m_WriteEvent;
+    HANDLE m_WaitEvent;
     DWORD m_PreviousMask;
     COMMTIMEOUTS m_PreviousTimeout;
     DCB m_PreviousDeviceControlBlock;
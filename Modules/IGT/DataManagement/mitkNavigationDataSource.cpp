@@ -12,6 +12,7 @@ found in the LICENSE file.
 
 #include "mitkNavigationDataSource.h"
 #include "mitkUIDGenerator.h"
+#include "mitkIGTTimeStamp.h"
 
 
 //Microservices
@@ -26,7 +27,8 @@ const std::string mitk::NavigationDataSource::US_PROPKEY_ID = US_INTERFACE_NAME
 const std::string mitk::NavigationDataSource::US_PROPKEY_ISACTIVE = US_INTERFACE_NAME + ".isActive";
 
 mitk::NavigationDataSource::NavigationDataSource()
-: itk::ProcessObject(), m_Name("NavigationDataSource (no defined type)"), m_IsFrozen(false), m_ToolMetaDataCollection(mitk::NavigationToolStorage::New())
+: itk::ProcessObject(), m_Name("NavigationDataSource (no defined type)"), m_IsFrozen(false),
+  m_LatencyMeasurementEnabled(false), m_ToolMetaDataCollection(mitk::NavigationToolStorage::New())
 {
 }
 
@@ -141,6 +143,33 @@ mitk::PropertyList::ConstPointer mitk::NavigationDataSource::GetParameters() con
   return mitk::PropertyList::ConstPointer(p);
 }
 
+void mitk::NavigationDataSource::UpdateOutputData(itk::DataObject *output)
+{
+  if (!m_LatencyMeasurementEnabled)
+  {
+    Superclass::UpdateOutputData(output);
+    return;
+  }
+
+  // filters which do not graft their inputs onto their outputs start a new list of stages
+  for (DataObjectPointerArraySizeType i = 0; i < this->GetNumberOfIndexedOutputs(); ++i)
+  {
+    mitk::NavigationData* nd = dynamic_cast<mitk::NavigationData*>(this->ProcessObject::GetOutput(i));
+    if (nd != nullptr)
+      nd->ClearStageTimeStamps();
+  }
+
+  Superclass::UpdateOutputData(output);
+
+  const mitk::NavigationData::TimeStampType now = mitk::IGTTimeStamp::GetInstance()->GetElapsed();
+  for (DataObjectPointerArraySizeType i = 0; i < this->GetNumberOfIndexedOutputs(); ++i)
+  {
+    mitk::NavigationData* nd = dynamic_cast<mitk::NavigationData*>(this->ProcessObject::GetOutput(i));
+    if (nd != nullptr)
+      nd->AddStageTimeStamp(m_Name, now);
+  }
+}
+
 void mitk::NavigationDataSource::Freeze()
 {
   m_IsFrozen = true;
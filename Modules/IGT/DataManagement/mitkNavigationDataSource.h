@@ -186,6 +186,18 @@ namespace mitk {
     /** @return Returns whether the data source is currently frozen. */
     itkGetMacro(IsFrozen,bool);
 
+    /** If latency measurement is enabled, the source appends a stage timestamp (see
+     *  NavigationData::AddStageTimeStamp()) with its name and the current IGT time to each output
+     *  whenever it generated new output data. The stage timestamps of the inputs are passed on by
+     *  NavigationData::Graft(), so the processing time of every stage of a pipeline can be evaluated
+     *  at its end, e.g. by a NavigationDataEvaluationFilter. Disabled by default. */
+    itkSetMacro(LatencyMeasurementEnabled,bool);
+    itkGetMacro(LatencyMeasurementEnabled,bool);
+    itkBooleanMacro(LatencyMeasurementEnabled);
+
+    /** Generates the output data and records the stage timestamps if latency measurement is enabled. */
+    void UpdateOutputData(itk::DataObject *output) override;
+
 
   protected:
     NavigationDataSource();
@@ -195,6 +207,8 @@ namespace mitk {
 
     bool m_IsFrozen;
 
+    bool m_LatencyMeasurementEnabled;
+
     /** Holds the metadata of all tools identified by the tool name.
      *  There is no need to set the metadata of the tools, so not
      *  every tool has metadata available. */
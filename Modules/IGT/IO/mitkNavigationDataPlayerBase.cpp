@@ -62,9 +62,17 @@ void mitk::NavigationDataPlayerBase::InitPlayer()
       << "NavigationDataSet has to be set before initializing player.";
   }
 
+  this->InitOutputs(m_NavigationDataSet->GetNumberOfTools());
+
+  this->Modified();
+  this->GenerateData();
+}
+
+void mitk::NavigationDataPlayerBase::InitOutputs(unsigned int numberOfTools)
+{
   if (GetNumberOfOutputs() == 0)
   {
-    unsigned int requiredOutputs = m_NavigationDataSet->GetNumberOfTools();
+    unsigned int requiredOutputs = numberOfTools;
     this->SetNumberOfRequiredOutputs(requiredOutputs);
 
     for (unsigned int n = this->GetNumberOfOutputs(); n < requiredOutputs; ++n)
@@ -74,20 +82,17 @@ void mitk::NavigationDataPlayerBase::InitPlayer()
       this->Modified();
     }
   }
-  else if (GetNumberOfOutputs() != m_NavigationDataSet->GetNumberOfTools())
+  else if (GetNumberOfOutputs() != numberOfTools)
   {
     mitkThrowException(mitk::IGTException)
       << "Number of tools cannot be changed in existing player. Please create "
       << "a new player, if the NavigationDataSet has another number of tools now.";
   }
-
-  this->Modified();
-  this->GenerateData();
 }
 
 void mitk::NavigationDataPlayerBase::GraftEmptyOutput()
 {
-  for (unsigned int index = 0; index < m_NavigationDataSet->GetNumberOfTools(); index++)
+  for (unsigned int index = 0; index < this->GetNumberOfOutputs(); index++)
   {
     mitk::NavigationData* output = this->GetOutput(index);
     assert(output);
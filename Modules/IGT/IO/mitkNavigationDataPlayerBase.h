@@ -64,16 +64,16 @@ namespace mitk{
     *
     * @return Returns the number of navigation data snapshots available in the player.
     */
-    unsigned int GetNumberOfSnapshots();
+    virtual unsigned int GetNumberOfSnapshots();
 
-    unsigned int GetCurrentSnapshotNumber();
+    virtual unsigned int GetCurrentSnapshotNumber();
 
     /**
     * \brief This method checks if player arrived at end of file.
     *
     * @return true if last mitk::NavigationData object is in the outputs, false otherwise
     */
-    bool IsAtEnd();
+    virtual bool IsAtEnd();
 
   protected:
     NavigationDataPlayerBase();
@@ -90,6 +90,12 @@ namespace mitk{
     */
     void InitPlayer();
 
+    /**
+    * \brief Creates one output per tool.
+    * @throw mitk::IGTException if the player already has outputs for another number of tools
+    */
+    void InitOutputs(unsigned int numberOfTools);
+
     /**
     * \brief Convenience method for subclasses.
     * When there are no further mitk::NavigationData objects available, this
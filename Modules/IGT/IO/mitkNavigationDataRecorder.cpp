@@ -27,6 +27,7 @@ mitk::NavigationDataRecorder::NavigationDataRecorder()
 
 mitk::NavigationDataRecorder::~NavigationDataRecorder()
 {
+  // the writer closes the file on destruction
   //mitk::IGTTimeStamp::GetInstance()->Stop(this); //commented out because of bug 18952
 }
 
@@ -67,15 +68,18 @@ void mitk::NavigationDataRecorder::GenerateData()
   }
 
   // if limitation is set and has been reached, stop recording
-  if ((m_RecordCountLimit > 0) && (m_NavigationDataSet->Size() >= static_cast<unsigned int>(m_RecordCountLimit)))
+  if ((m_RecordCountLimit > 0) && (this->GetNumberOfRecordedSteps() >= m_RecordCountLimit))
     m_Recording = false;
   // We can skip the rest of the method, if recording is deactivated
   if (!m_Recording) return;
   // We can skip the rest of the method, if we read only valid data
   if (m_RecordOnlyValidData && atLeastOneInputIsInvalid) return;
 
-  // Add data to set
-  m_NavigationDataSet->AddNavigationDatas(clonedDatas);
+  // Add data to set or stream it to the file
+  if (m_StreamingWriter)
+    m_StreamingWriter->Append(clonedDatas);
+  else
+    m_NavigationDataSet->AddNavigationDatas(clonedDatas);
 }
 
 void mitk::NavigationDataRecorder::StartRecording()
@@ -94,6 +98,9 @@ void mitk::NavigationDataRecorder::StartRecording()
 
   if (m_NavigationDataSet.IsNull())
     m_NavigationDataSet = mitk::NavigationDataSet::New(GetNumberOfIndexedInputs());
+
+  if (!m_StreamingFileName.empty() && !m_StreamingWriter)
+    this->OpenStreamingFile();
 }
 
 void mitk::NavigationDataRecorder::StopRecording()
@@ -104,12 +111,25 @@ void mitk::NavigationDataRecorder::StopRecording()
     return;
   }
   m_Recording = false;
+
+  // make the recorded data available in the file while the recording is paused
+  if (m_StreamingWriter)
+    m_StreamingWriter->Flush();
 }
 
 void mitk::NavigationDataRecorder::ResetRecording()
 {
   m_NavigationDataSet = mitk::NavigationDataSet::New(GetNumberOfIndexedInputs());
 
+  if (m_StreamingWriter)
+  {
+    m_StreamingWriter->Close();
+    m_StreamingWriter.reset();
+
+    if (m_Recording)
+      this->OpenStreamingFile();
+  }
+
   if (m_Recording)
   {
     mitk::IGTTimeStamp::GetInstance()->Stop(this);
@@ -119,5 +139,27 @@ void mitk::NavigationDataRecorder::ResetRecording()
 
 int mitk::NavigationDataRecorder::GetNumberOfRecordedSteps()
 {
+  if (m_StreamingWriter)
+    return static_cast<int>(m_StreamingWriter->GetNumberOfSnapshots());
+
   return m_NavigationDataSet->Size();
 }
+
+void mitk::NavigationDataRecorder::OpenStreamingFile()
+{
+  std::vector<std::string> toolNames;
+  for (unsigned int index = 0; index < this->GetNumberOfIndexedInputs(); index++)
+    toolNames.push_back(this->GetInput(index)->GetName());
+
+  m_StreamingWriter.reset(new mitk::NavigationDataBinaryFileWriter);
+  try
+  {
+    m_StreamingWriter->Open(m_StreamingFileName, toolNames);
+  }
+  catch (...)
+  {
+    m_StreamingWriter.reset();
+    m_Recording = false;
+    throw;
+  }
+}
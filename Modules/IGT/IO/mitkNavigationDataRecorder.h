@@ -16,6 +16,9 @@ found in the LICENSE file.
 #include "mitkNavigationDataToNavigationDataFilter.h"
 #include "mitkNavigationData.h"
 #include "mitkNavigationDataSet.h"
+#include "mitkNavigationDataBinaryFileWriter.h"
+
+#include <memory>
 
 namespace mitk
 {
@@ -27,6 +30,11 @@ namespace mitk
   * With StopRecording() the stream is stopped, but can be resumed anytime.
   * To start recording to a new NavigationDataSet, call ResetRecording();
   *
+  * If a streaming file name is set, the NavigationDatas are not kept in the NavigationDataSet but written
+  * to that file in the binary format of mitk::NavigationDataBinaryFileWriter while recording. So the memory
+  * usage does not grow with the length of the recording. The file can be played with
+  * mitk::NavigationDataSequentialPlayer::SetBinaryFileName() or loaded with mitk::IOUtil.
+  *
   * \warning Do not add inputs while the recorder ist recording. The recorder can't handle that and will cause a nullpointer exception.
   * \ingroup IGT
   */
@@ -78,6 +86,13 @@ namespace mitk
     */
     itkGetMacro(RecordOnlyValidData, bool);
 
+    /**
+    * \brief Sets the file the recording is streamed to. An empty name (default) records into the
+    * NavigationDataSet. Must be set before StartRecording().
+    */
+    itkSetStringMacro(StreamingFileName);
+    itkGetStringMacro(StreamingFileName);
+
     /**
     * \brief Starts recording NavigationData into the NavigationDataSet
     */
@@ -95,6 +110,7 @@ namespace mitk
     * \brief Resets the Datasets and the timestamp, so a new recording can happen.
     *
     * Do not forget to save the old Dataset, it will be lost after calling this function.
+    * In streaming mode the file is closed, a following StartRecording() overwrites it.
     */
     virtual void ResetRecording();
 
@@ -112,6 +128,12 @@ namespace mitk
 
     ~NavigationDataRecorder() override;
 
+    /**
+    * \brief Creates the streaming writer and opens m_StreamingFileName, using the names of the inputs as tool names.
+    * \throw mitk::IGTIOException if the file cannot be created
+    */
+    void OpenStreamingFile();
+
     unsigned int m_NumberOfInputs; ///< counts the numbers of added input NavigationDatas
 
     mitk::NavigationDataSet::Pointer m_NavigationDataSet;
@@ -125,6 +147,10 @@ namespace mitk
     int m_RecordCountLimit; ///< limits the number of frames, recording will be stopped if the limit is reached. -1 disables the limit
 
     bool m_RecordOnlyValidData; ///< indicates whether only valid data is recorded
+
+    std::string m_StreamingFileName; ///< the file the recording is streamed to, empty if recording into the set
+
+    std::unique_ptr<NavigationDataBinaryFileWriter> m_StreamingWriter;
   };
 }
 #endif // #define _MITK_POINT_SET_SOURCE_H
@@ -21,6 +21,7 @@ found in the LICENSE file.
 #include "mitkIGTIOException.h"
 
 mitk::NavigationDataSequentialPlayer::NavigationDataSequentialPlayer()
+  : m_CurrentSnapshot(0)
 {
 }
 
@@ -37,7 +38,10 @@ void mitk::NavigationDataSequentialPlayer::GoToSnapshot(unsigned int i)
   }
 
   // set iterator to given position (modulo for allowing repeat)
-  m_NavigationDataSetIterator = m_NavigationDataSet->Begin() + ( i % this->GetNumberOfSnapshots() );
+  if (this->IsPlayingBinaryFile())
+    m_CurrentSnapshot = i % this->GetNumberOfSnapshots();
+  else
+    m_NavigationDataSetIterator = m_NavigationDataSet->Begin() + ( i % this->GetNumberOfSnapshots() );
 
   // set outputs to selected snapshot
   this->GenerateData();
@@ -45,6 +49,27 @@ void mitk::NavigationDataSequentialPlayer::GoToSnapshot(unsigned int i)
 
 bool mitk::NavigationDataSequentialPlayer::GoToNextSnapshot()
 {
+  if (this->IsPlayingBinaryFile())
+  {
+    const unsigned int numberOfSnapshots = this->GetNumberOfSnapshots();
+    if (m_CurrentSnapshot >= numberOfSnapshots)
+    {
+      MITK_WARN("NavigationDataSequentialPlayer") << "Cannot go to next snapshot, already at end of file. Ignoring...";
+      return false;
+    }
+
+    ++m_CurrentSnapshot;
+    if (m_CurrentSnapshot == numberOfSnapshots)
+    {
+      if (!m_Repeat)
+        return false;
+      m_CurrentSnapshot = 0;
+    }
+
+    this->GenerateData();
+    return true;
+  }
+
   if (m_NavigationDataSetIterator == m_NavigationDataSet->End())
   {
     MITK_WARN("NavigationDataSequentialPlayer") << "Cannot go to next snapshot, already at end of NavigationDataset. Ignoring...";
@@ -69,6 +94,25 @@ bool mitk::NavigationDataSequentialPlayer::GoToNextSnapshot()
 
 void mitk::NavigationDataSequentialPlayer::GenerateData()
 {
+  if (this->IsPlayingBinaryFile())
+  {
+    if (m_CurrentSnapshot >= this->GetNumberOfSnapshots())
+    {
+      this->GraftEmptyOutput();
+      return;
+    }
+
+    const auto snapshot = m_BinaryFileReader->ReadSnapshot(m_CurrentSnapshot);
+    for (unsigned int index = 0; index < GetNumberOfOutputs(); index++)
+    {
+      mitk::NavigationData* output = this->GetOutput(index);
+      if( !output ) { mitkThrowException(mitk::IGTException) << "Output of index "<<index<<" is null."; }
+
+      output->Graft(snapshot.at(index));
+    }
+    return;
+  }
+
   if ( m_NavigationDataSetIterator == m_NavigationDataSet->End() )
   {
     // no more data available
@@ -91,3 +135,46 @@ void mitk::NavigationDataSequentialPlayer::UpdateOutputInformation()
   this->Modified();  // make sure that we need to be updated
   Superclass::UpdateOutputInformation();
 }
+
+void mitk::NavigationDataSequentialPlayer::SetBinaryFileName(const std::string &fileName)
+{
+  std::unique_ptr<NavigationDataBinaryFileReader> reader(new NavigationDataBinaryFileReader(fileName));
+  this->InitOutputs(reader->GetNumberOfTools());
+
+  m_BinaryFileReader = std::move(reader);
+  m_NavigationDataSet = nullptr;
+  m_CurrentSnapshot = 0;
+
+  this->Modified();
+  this->GenerateData();
+}
+
+bool mitk::NavigationDataSequentialPlayer::IsPlayingBinaryFile() const
+{
+  // SetNavigationDataSet() switches back to playing the set
+  return m_BinaryFileReader && m_NavigationDataSet.IsNull();
+}
+
+unsigned int mitk::NavigationDataSequentialPlayer::GetNumberOfSnapshots()
+{
+  if (this->IsPlayingBinaryFile())
+    return static_cast<unsigned int>(m_BinaryFileReader->GetNumberOfSnapshots());
+
+  return Superclass::GetNumberOfSnapshots();
+}
+
+unsigned int mitk::NavigationDataSequentialPlayer::GetCurrentSnapshotNumber()
+{
+  if (this->IsPlayingBinaryFile())
+    return m_CurrentSnapshot;
+
+  return Superclass::GetCurrentSnapshotNumber();
+}
+
+bool mitk::NavigationDataSequentialPlayer::IsAtEnd()
+{
+  if (this->IsPlayingBinaryFile())
+    return m_CurrentSnapshot >= this->GetNumberOfSnapshots();
+
+  return Superclass::IsAtEnd();
+}
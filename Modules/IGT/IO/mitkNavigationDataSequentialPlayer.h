@@ -14,6 +14,9 @@ found in the LICENSE file.
 #define MITKNavigationDataSequentialPlayer_H_HEADER_INCLUDED_
 
 #include <mitkNavigationDataPlayerBase.h>
+#include <mitkNavigationDataBinaryFileReader.h>
+
+#include <memory>
 
 namespace mitk
 {
@@ -22,6 +25,10 @@ namespace mitk
   * NavigationDataPlayer which does not care about timestamps and just
   * outputs the navigationdatas in their sequential order
   *
+  * Instead of a mitk::NavigationDataSet, a binary file written by mitk::NavigationDataRecorder in streaming
+  * mode can be played with SetBinaryFileName(). Then only the current snapshot is read from the file, so
+  * seeking in long recordings is fast and needs no memory.
+  *
   * \ingroup IGT
   */
   class MITKIGT_EXPORT NavigationDataSequentialPlayer
@@ -59,6 +66,19 @@ namespace mitk
     */
     void UpdateOutputInformation() override;
 
+    /**
+    * \brief Plays the given binary navigation data file instead of a NavigationDataSet.
+    * The first snapshot is loaded into the outputs.
+    *
+    * @throw mitk::IGTIOException if the file cannot be read
+    * @throw mitk::IGTException if the player already has outputs for another number of tools
+    */
+    void SetBinaryFileName(const std::string &fileName);
+
+    unsigned int GetNumberOfSnapshots() override;
+    unsigned int GetCurrentSnapshotNumber() override;
+    bool IsAtEnd() override;
+
   protected:
     NavigationDataSequentialPlayer();
     ~NavigationDataSequentialPlayer() override;
@@ -69,6 +89,15 @@ namespace mitk
     * for generating next data.
     */
     void GenerateData() override;
+
+    bool IsPlayingBinaryFile() const;
+
+    std::unique_ptr<NavigationDataBinaryFileReader> m_BinaryFileReader;
+
+    /**
+    * \brief The snapshot in the outputs if a binary file is played, equals the number of snapshots at the end.
+    */
+    unsigned int m_CurrentSnapshot;
   };
 } // namespace mitk
 
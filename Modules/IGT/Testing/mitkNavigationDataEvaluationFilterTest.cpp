@@ -11,6 +11,8 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkNavigationDataEvaluationFilter.h"
+#include "mitkNavigationDataPassThroughFilter.h"
+#include "mitkIGTTimeStamp.h"
 #include "mitkTestingMacros.h"
 
 /**Documentation
@@ -136,6 +138,53 @@ static void TestComplexCase()
     MITK_TEST_CONDITION_REQUIRED(mitk::Equal(myNavigationDataEvaluationFilter->GetNumberOfAnalysedNavigationData(0),0),".. Testing ResetStatistic");
 
     }
+
+static void TestLatencyStatistics()
+    {
+    MITK_TEST_OUTPUT(<< "Starting latency statistics test...");
+    mitk::NavigationDataLatencyStatistics statistics(100);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(statistics.GetPercentile(50),0),".. Testing GetPercentile without samples");
+    for (int i = 1; i <= 200; ++i)
+      statistics.AddSample(i);
+    MITK_TEST_CONDITION_REQUIRED(statistics.GetNumberOfSamples()==100,".. Testing that only the most recent samples are kept");
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(statistics.GetMedian(),150),".. Testing GetMedian");
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(statistics.GetPercentile(99),199),".. Testing GetPercentile");
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(statistics.GetMaximum(),200),".. Testing GetMaximum");
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(statistics.GetMean(),150.5),".. Testing GetMean");
+    statistics.Reset();
+    MITK_TEST_CONDITION_REQUIRED(statistics.GetNumberOfSamples()==0,".. Testing Reset");
+    }
+
+static void TestLatencyMeasurement()
+    {
+    MITK_TEST_OUTPUT(<< "Starting latency measurement test...");
+    mitk::NavigationData::Pointer testData = mitk::NavigationData::New();
+    testData->SetDataValid(true);
+
+    mitk::NavigationDataPassThroughFilter::Pointer passThroughFilter = mitk::NavigationDataPassThroughFilter::New();
+    passThroughFilter->SetName("PassThrough");
+    passThroughFilter->LatencyMeasurementEnabledOn();
+    passThroughFilter->SetInput(testData);
+
+    mitk::NavigationDataEvaluationFilter::Pointer myNavigationDataEvaluationFilter = mitk::NavigationDataEvaluationFilter::New();
+    myNavigationDataEvaluationFilter->SetInput(passThroughFilter->GetOutput());
+
+    mitk::IGTTimeStamp::GetInstance()->Start(passThroughFilter);
+    for (int i = 0; i < 10; ++i)
+    {
+      testData->SetIGTTimeStamp(mitk::IGTTimeStamp::GetInstance()->GetElapsed());
+      testData->Modified();
+      myNavigationDataEvaluationFilter->Update();
+    }
+    mitk::IGTTimeStamp::GetInstance()->Stop(passThroughFilter);
+
+    MITK_TEST_CONDITION_REQUIRED(myNavigationDataEvaluationFilter->GetLatencyStatistics(0).GetNumberOfSamples()==10,".. Testing number of latency samples");
+    MITK_TEST_CONDITION_REQUIRED(myNavigationDataEvaluationFilter->GetLatencyPercentile(0, 99)>=0,".. Testing GetLatencyPercentile");
+    MITK_TEST_CONDITION_REQUIRED(myNavigationDataEvaluationFilter->GetStageLatencyStatistics(0).size()==1,".. Testing number of pipeline stages");
+    MITK_TEST_CONDITION_REQUIRED(myNavigationDataEvaluationFilter->GetStageLatencyStatistics(0).at(0).first=="PassThrough",".. Testing name of pipeline stage");
+    MITK_TEST_CONDITION_REQUIRED(myNavigationDataEvaluationFilter->GetStageLatencyStatistics(0).at(0).second.GetNumberOfSamples()==10,".. Testing number of stage latency samples");
+    MITK_TEST_CONDITION_REQUIRED(!myNavigationDataEvaluationFilter->GetLatencyReport(0).empty(),".. Testing GetLatencyReport");
+    }
 };
 
 /**
@@ -149,6 +198,8 @@ int mitkNavigationDataEvaluationFilterTest(int /* argc */, char* /*argv*/[])
   NavigationDataEvaluationFilterTestClass::TestInstantiation();
   NavigationDataEvaluationFilterTestClass::TestSimpleCase();
   NavigationDataEvaluationFilterTestClass::TestComplexCase();
+  NavigationDataEvaluationFilterTestClass::TestLatencyStatistics();
+  NavigationDataEvaluationFilterTestClass::TestLatencyMeasurement();
 
   // always end with this!
   MITK_TEST_END()
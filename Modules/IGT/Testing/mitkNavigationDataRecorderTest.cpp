@@ -18,6 +18,8 @@ found in the LICENSE file.
 #include <mitkTestFixture.h>
 #include <mitkIOUtil.h>
 
+#include <cstdio>
+
 //for exceptions
 #include "mitkIGTException.h"
 #include "mitkIGTIOException.h"
@@ -28,6 +30,7 @@ class mitkNavigationDataRecorderTestSuite : public mitk::TestFixture
   MITK_TEST(TestRecording);
   MITK_TEST(TestStopRecording);
   MITK_TEST(TestLimiting);
+  MITK_TEST(TestStreamingToBinaryFile);
 
   CPPUNIT_TEST_SUITE_END();
 
@@ -113,6 +116,54 @@ public:
     MITK_TEST_CONDITION_REQUIRED(m_Recorder->GetNavigationDataSet()->Size() == 30, "Test if SetRecordCountLimit works as intended.");
   }
 
+  void TestStreamingToBinaryFile()
+  {
+    std::string fileName = mitk::IOUtil::CreateTemporaryFile("NavigationDataRecorderTest_XXXXXX.ndb");
+    m_Recorder->SetStreamingFileName(fileName);
+    m_Recorder->StartRecording();
+    while (!m_Player->IsAtEnd())
+    {
+      m_Recorder->Update();
+      m_Player->GoToNextSnapshot();
+    }
+    m_Recorder->StopRecording();
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Test if all snapshots were streamed", static_cast<int>(m_NavigationDataSet->Size()),
+                                 m_Recorder->GetNumberOfRecordedSteps());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Test if the data set stays empty while streaming", 0u,
+                                 m_Recorder->GetNavigationDataSet()->Size());
+
+    // closes the file
+    m_Recorder->ResetRecording();
+
+    mitk::NavigationDataSequentialPlayer::Pointer filePlayer = mitk::NavigationDataSequentialPlayer::New();
+    filePlayer->SetBinaryFileName(fileName);
+    CPPUNIT_ASSERT_EQUAL(m_NavigationDataSet->Size(), filePlayer->GetNumberOfSnapshots());
+    CPPUNIT_ASSERT_EQUAL(m_NavigationDataSet->GetNumberOfTools(), filePlayer->GetNumberOfOutputs());
+
+    // seek backwards through the file
+    for (unsigned int i = filePlayer->GetNumberOfSnapshots(); i-- > 0;)
+    {
+      filePlayer->GoToSnapshot(i);
+      for (unsigned int tool = 0; tool < filePlayer->GetNumberOfOutputs(); tool++)
+      {
+        mitk::NavigationData::Pointer ref = m_NavigationDataSet->GetNavigationDataForIndex(i, tool);
+        CPPUNIT_ASSERT_MESSAGE("Test if the streamed position equals the reference",
+                               ref->GetPosition() == filePlayer->GetOutput(tool)->GetPosition());
+        CPPUNIT_ASSERT_MESSAGE(
+          "Test if the streamed orientation equals the reference",
+          ref->GetOrientation().as_vector() == filePlayer->GetOutput(tool)->GetOrientation().as_vector());
+      }
+    }
+
+    mitk::NavigationDataSet::Pointer loadedData =
+      dynamic_cast<mitk::NavigationDataSet*>(mitk::IOUtil::Load(fileName)[0].GetPointer());
+    CPPUNIT_ASSERT_MESSAGE("Test if the binary file can be loaded", loadedData.IsNotNull());
+    CPPUNIT_ASSERT_MESSAGE("Test loaded dataset for equality with reference", compareDataSet(loadedData));
+
+    std::remove(fileName.c_str());
+  }
+
 private:
 
   /*
@@ -150,8 +150,6 @@ mitk::NDIErrorCode mitk::NDIProtocol::IRCHK(bool* IRdetected)
     m_TrackingDevice->ClearReceiveBuffer();   // flush the buffer to remove any reply
     return returnValue;
   }
-  /* wait for the trackingsystem to process the command */
-  itksys::SystemTools::Delay(100);
   /* read and parse the reply from tracking device */
   // the reply for IRCHK can be either Infrared Source Information or ERROR##
   // because we use the simple reply format, the answer will be only one char:
@@ -235,8 +233,6 @@ mitk::NDIErrorCode mitk::NDIProtocol::PHSR(PHSRQueryType queryType, std::string*
     return returnValue;
   }
 
-  itksys::SystemTools::Delay(100);
-
   std::string reply;
   m_TrackingDevice->Receive(&reply, 2);       // read first 2 characters of reply ("Number of Handles" as a 2 digit hexadecimal number)
   static const std::string error("ERROR");
@@ -316,8 +312,6 @@ mitk::NDIErrorCode mitk::NDIProtocol::PHRQ(std::string* portHandle)
     return returnValue;
   }
 
-  itksys::SystemTools::Delay(100);            // give the tracking device some time to process the command
-
   std::string reply;
   m_TrackingDevice->Receive(&reply, 2);       // read first 2 characters of reply ("Number of Handles" as a 2 digit hexadecimal number)
   static const std::string error("ERROR");
@@ -396,7 +390,6 @@ mitk::NDIErrorCode mitk::NDIProtocol::PVWR(std::string* portHandle, const unsign
     sprintf(hexcharacter, "%s%04X", portHandle->c_str(), j/2);              // build the first two parameters: PortHandle and SROM device adress (not in hex characters, but in bytes)
     fullcommand = basecommand + hexcharacter + hexSROMData.substr(j, 128);  // build complete command string
     returnValue = m_TrackingDevice->Send(&fullcommand, m_UseCRC);           // send command
-    itksys::SystemTools::Delay(50);               // Wait for trackingsystem to process the data
     if (returnValue != NDIOKAY)                   // check for send error
       break;
     returnValue = this->ParseOkayError();         // parse answer
@@ -431,8 +424,6 @@ mitk::NDIErrorCode mitk::NDIProtocol::PINIT(std::string* portHandle)
     return returnValue;
   }
 
-  /* wait for the trackingsystem to process the command */
-  itksys::SystemTools::Delay(100);
   std::string reply;
   m_TrackingDevice->Receive(&reply, 4);                 // read first 4 characters of reply
 
@@ -577,9 +568,6 @@ mitk::NDIErrorCode mitk::NDIProtocol::BEEP(unsigned char count)
     return returnValue;
   }
 
-  /* wait for the trackingsystem to process the command */
-  itksys::SystemTools::Delay(100);
-
   std::string reply;
   char b;
   m_TrackingDevice->ReceiveByte(&b);          // read the first byte
@@ -1433,8 +1421,6 @@ mitk::NDIErrorCode mitk::NDIProtocol::GenericCommand(const std::string command,
     m_TrackingDevice->ClearReceiveBuffer();   // flush the buffer to remove any reply
     return returnValue;
   }
-  /* wait for the trackingsystem to process the command */
-  itksys::SystemTools::Delay(100);
 
   /* read and parse the reply from tracking device */
   // the reply for a generic command can be OKAY or ERROR##
@@ -807,8 +807,6 @@ void mitk::NDITrackingDevice::TrackMarkerPositions()
     this->m_StopTrackingMutex->Lock();
     localStopTracking = m_StopTracking;
     this->m_StopTrackingMutex->Unlock();
-
-    itksys::SystemTools::Delay(1);
   }
   /* StopTracking was called, thus the mode should be changed back to Ready now that the tracking loop has ended. */
   returnvalue = m_DeviceProtocol->DSTOP();
@@ -1160,7 +1158,6 @@ bool mitk::NDITrackingDevice::DiscoverWiredTools()
      if ((returnvaluePort == NDIOKAY) && (portInfo.size() > 31))
         dynamic_cast<mitk::NDIPassiveTool*>(this->GetInternalTool(ph))->SetSerialNumber(portInfo.substr(23, 8));
      MITK_INFO << "portInfo: " << portInfo;
-     itksys::SystemTools::Delay(10);
   }
 
   return true;
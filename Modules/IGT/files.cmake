@@ -19,6 +19,7 @@ set(CPP_FILES
   Algorithms/mitkPivotCalibration.cpp
 
   Common/mitkIGTTimeStamp.cpp
+  Common/mitkNavigationDataLatencyStatistics.cpp
   Common/mitkSerialCommunication.cpp
 
   DataManagement/mitkNavigationDataSource.cpp
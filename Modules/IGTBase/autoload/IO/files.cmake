@@ -2,6 +2,8 @@ set(CPP_FILES
    mitkIGTBaseActivator.cpp
    mitkNavigationDataSetWriterXML.cpp
    mitkNavigationDataSetWriterCSV.cpp
+   mitkNavigationDataSetWriterBinary.cpp
    mitkNavigationDataReaderXML.cpp
    mitkNavigationDataReaderCSV.cpp
+   mitkNavigationDataReaderBinary.cpp
 )
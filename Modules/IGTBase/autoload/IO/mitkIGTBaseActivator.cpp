@@ -16,6 +16,8 @@ found in the LICENSE file.
 #include <mitkNavigationDataSetWriterCSV.h>
 #include <mitkNavigationDataReaderCSV.h>
 #include <mitkNavigationDataReaderXML.h>
+#include <mitkNavigationDataSetWriterBinary.h>
+#include <mitkNavigationDataReaderBinary.h>
 
 namespace mitk {
 
@@ -25,6 +27,8 @@ void IOExtActivator::Load(us::ModuleContext*)
   m_NavigationDataSetWriterCSV.reset(new NavigationDataSetWriterCSV());
   m_NavigationDataReaderCSV.reset(new NavigationDataReaderCSV());
   m_NavigationDataReaderXML.reset(new NavigationDataReaderXML());
+  m_NavigationDataSetWriterBinary.reset(new NavigationDataSetWriterBinary());
+  m_NavigationDataReaderBinary.reset(new NavigationDataReaderBinary());
 
 }
 
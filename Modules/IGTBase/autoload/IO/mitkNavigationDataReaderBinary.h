@@ -0,0 +1,47 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkNavigationDataReaderBinary_h
+#define mitkNavigationDataReaderBinary_h
+
+#include <MitkIGTIOExports.h>
+
+#include <mitkAbstractFileReader.h>
+#include <mitkNavigationDataSet.h>
+
+namespace mitk {
+  /** This class reads navigation data sets written by mitk::NavigationDataSetWriterBinary or recorded by
+   *  mitk::NavigationDataRecorder in streaming mode.
+   *
+   *  The whole recording is loaded into memory, use mitk::NavigationDataSequentialPlayer::SetBinaryFileName()
+   *  to play long recordings directly from the file.
+   */
+  class MITKIGTIO_EXPORT NavigationDataReaderBinary : public AbstractFileReader
+  {
+  public:
+
+    NavigationDataReaderBinary();
+    ~NavigationDataReaderBinary() override;
+
+    using AbstractFileReader::Read;
+    std::vector<itk::SmartPointer<BaseData>> Read() override;
+
+  protected:
+
+    NavigationDataReaderBinary(const NavigationDataReaderBinary& other);
+
+    mitk::NavigationDataReaderBinary* Clone() const override;
+
+  };
+}
+
+#endif
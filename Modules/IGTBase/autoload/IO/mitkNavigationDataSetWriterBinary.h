@@ -0,0 +1,39 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkNavigationDataSetWriterBinary_h
+#define mitkNavigationDataSetWriterBinary_h
+
+#include <MitkIGTIOExports.h>
+
+#include <mitkNavigationDataSet.h>
+#include <mitkAbstractFileWriter.h>
+
+namespace mitk {
+  /** Writes a navigation data set into the binary format of mitk::NavigationDataBinaryFileWriter. */
+  class MITKIGTIO_EXPORT NavigationDataSetWriterBinary : public AbstractFileWriter
+  {
+  public:
+    NavigationDataSetWriterBinary();
+    ~NavigationDataSetWriterBinary() override;
+
+    using AbstractFileWriter::Write;
+    void Write() override;
+
+  protected:
+    NavigationDataSetWriterBinary(const NavigationDataSetWriterBinary& other);
+
+    mitk::NavigationDataSetWriterBinary* Clone() const override;
+  };
+}
+
+#endif
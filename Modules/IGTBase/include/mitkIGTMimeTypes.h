@@ -23,6 +23,7 @@ namespace mitk {
   public:
     static CustomMimeType NAVIGATIONDATASETXML_MIMETYPE();
     static CustomMimeType NAVIGATIONDATASETCSV_MIMETYPE();
+    static CustomMimeType NAVIGATIONDATASETBINARY_MIMETYPE();
     static CustomMimeType USDEVICEINFORMATIONXML_MIMETYPE();
   };
 }
@@ -18,6 +18,10 @@ found in the LICENSE file.
 #include <mitkCommon.h>
 #include <mitkNumericTypes.h>
 
+#include <string>
+#include <utility>
+#include <vector>
+
 namespace mitk {
 
     /**Documentation
@@ -58,6 +62,11 @@ namespace mitk {
       * \brief type that holds the time at which the data was recorded in milliseconds
       */
       typedef double TimeStampType;
+      /**
+      * \brief type that holds the names of the pipeline stages which produced this object, together with the time
+      * (in milliseconds, same clock as the IGT timestamp) at which each stage finished
+      */
+      typedef std::vector<std::pair<std::string, TimeStampType> > StageTimeStampsType;
 
       /**
       * \brief sets the position of the NavigationData object
@@ -125,6 +134,22 @@ namespace mitk {
       */
       itkGetStringMacro(Name);
 
+      /**
+      * \brief appends the time at which the given pipeline stage finished processing this object
+      *
+      * Stage timestamps are recorded by the navigation data filters if latency measurement is enabled for them,
+      * see NavigationDataSource::SetLatencyMeasurementEnabled(). They are passed on by Graft().
+      */
+      void AddStageTimeStamp(const std::string& stage, TimeStampType timeStamp);
+      /**
+      * \brief returns the stage timestamps in the order of the pipeline stages
+      */
+      const StageTimeStampsType& GetStageTimeStamps() const;
+      /**
+      * \brief removes all stage timestamps
+      */
+      void ClearStageTimeStamps();
+
       /**
       * \brief Graft the data and information from one NavigationData to another.
       *
@@ -262,6 +287,10 @@ namespace mitk {
       * \brief name of the navigation data
       */
       std::string m_Name;
+      /**
+      * \brief times at which the pipeline stages finished processing this object
+      */
+      StageTimeStampsType m_StageTimeStamps;
 
     private:
 
@@ -0,0 +1,74 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkNavigationDataBinaryFileReader_h
+#define mitkNavigationDataBinaryFileReader_h
+
+#include <MitkIGTBaseExports.h>
+#include "mitkNavigationData.h"
+#include "mitkNavigationDataSet.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace mitk {
+  /**
+  * \brief Reads files written by mitk::NavigationDataBinaryFileWriter.
+  *
+  * Snapshots can be read in any order with ReadSnapshot(), each call only reads the records of the requested
+  * snapshot. So players can seek in long recordings without loading them into memory first.
+  *
+  * \ingroup IGT
+  */
+  class MITKIGTBASE_EXPORT NavigationDataBinaryFileReader
+  {
+  public:
+    /**
+    * \brief Opens the file and reads its header.
+    * \throw mitk::IGTIOException if the file cannot be opened or is no binary navigation data file
+    */
+    explicit NavigationDataBinaryFileReader(const std::string &fileName);
+
+    NavigationDataBinaryFileReader(const NavigationDataBinaryFileReader &) = delete;
+    NavigationDataBinaryFileReader &operator=(const NavigationDataBinaryFileReader &) = delete;
+
+    unsigned int GetNumberOfTools() const;
+    const std::vector<std::string> &GetToolNames() const;
+
+    /**
+    * \return Returns the number of complete snapshots in the file. The file is checked again on each call, so
+    * snapshots written meanwhile by another process are counted as well.
+    */
+    std::size_t GetNumberOfSnapshots();
+
+    /**
+    * \brief Reads one navigation data per tool of the given snapshot.
+    * \throw mitk::IGTIOException if index is out of range or the file cannot be read
+    */
+    std::vector<NavigationData::Pointer> ReadSnapshot(std::size_t index);
+
+    /**
+    * \brief Reads all snapshots into a navigation data set.
+    */
+    NavigationDataSet::Pointer ReadNavigationDataSet();
+
+  private:
+    std::ifstream m_File;
+    std::string m_FileName;
+    std::vector<std::string> m_ToolNames;
+    std::streamoff m_HeaderSize;
+    std::vector<char> m_Buffer;
+  };
+} // namespace mitk
+
+#endif
@@ -0,0 +1,117 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkNavigationDataBinaryFileWriter_h
+#define mitkNavigationDataBinaryFileWriter_h
+
+#include <MitkIGTBaseExports.h>
+#include "mitkNavigationData.h"
+#include "mitkNavigationDataSet.h"
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mitk {
+  /**
+  * \brief Streams navigation data snapshots into a compact binary file.
+  *
+  * Every snapshot (one mitk::NavigationData per tool) is stored as fixed size records, so the file can be read
+  * with random access by mitk::NavigationDataBinaryFileReader. Append() only copies the snapshot into the current
+  * chunk, full chunks are written to disk by a background thread. So recording at high rates does not block the
+  * tracking pipeline and the memory usage does not grow with the length of the recording.
+  *
+  * If the writer falls behind the disk, Append() blocks until the backlog is below GetMaximumNumberOfPendingChunks().
+  *
+  * \ingroup IGT
+  */
+  class MITKIGTBASE_EXPORT NavigationDataBinaryFileWriter
+  {
+  public:
+    NavigationDataBinaryFileWriter();
+
+    /** Closes the file, see Close(). Errors are only logged. */
+    ~NavigationDataBinaryFileWriter();
+
+    NavigationDataBinaryFileWriter(const NavigationDataBinaryFileWriter &) = delete;
+    NavigationDataBinaryFileWriter &operator=(const NavigationDataBinaryFileWriter &) = delete;
+
+    /**
+    * \brief Creates (or overwrites) the file, writes the header and starts the writer thread.
+    * \param toolNames the names of the tools, which also defines the number of navigation datas per snapshot
+    * \throw mitk::IGTIOException if the file cannot be created or a file is already open
+    */
+    void Open(const std::string &fileName, const std::vector<std::string> &toolNames);
+
+    /**
+    * \brief Adds a snapshot, which must contain one navigation data per tool.
+    * \throw mitk::IGTIOException if the file is not open, the number of navigation datas is wrong or the writer
+    * thread failed to write to the file
+    */
+    void Append(const std::vector<NavigationData::Pointer> &snapshot);
+
+    /**
+    * \brief Hands the current (partial) chunk over to the writer thread, e.g. when a recording is paused.
+    */
+    void Flush();
+
+    /**
+    * \brief Writes all remaining snapshots, stops the writer thread and closes the file.
+    * \throw mitk::IGTIOException if writing failed
+    */
+    void Close();
+
+    bool IsOpen() const;
+
+    /** \return Returns the number of snapshots appended since Open(). */
+    std::size_t GetNumberOfSnapshots() const;
+
+    /** \brief Sets the number of snapshots that are written at once. Default is 100. */
+    void SetChunkSize(std::size_t numberOfSnapshots);
+    std::size_t GetChunkSize() const;
+
+    void SetMaximumNumberOfPendingChunks(std::size_t numberOfChunks);
+    std::size_t GetMaximumNumberOfPendingChunks() const;
+
+    /**
+    * \brief Writes a complete navigation data set, the tool names are taken from its first snapshot.
+    * \throw mitk::IGTIOException if writing failed
+    */
+    static void Write(const std::string &fileName, const NavigationDataSet *navigationDataSet);
+
+  private:
+    void WriterThread();
+    void QueueCurrentChunk(std::unique_lock<std::mutex> &lock);
+
+    std::ofstream m_File;
+    std::string m_FileName;
+    std::size_t m_NumberOfTools;
+    std::size_t m_NumberOfSnapshots;
+    std::size_t m_ChunkSize;
+    std::size_t m_MaximumNumberOfPendingChunks;
+
+    std::vector<char> m_CurrentChunk;
+    std::deque<std::vector<char>> m_PendingChunks;
+    std::mutex m_Mutex;
+    std::condition_variable m_ChunkAvailable;
+    std::condition_variable m_ChunkWritten;
+    bool m_StopWriting;
+    std::string m_Error;
+    std::thread m_WriterThread;
+  };
+} // namespace mitk
+
+#endif
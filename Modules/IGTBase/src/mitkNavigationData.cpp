@@ -27,7 +27,7 @@ m_Name()
 mitk::NavigationData::NavigationData(const mitk::NavigationData& toCopy) : itk::DataObject(),
     m_Position(toCopy.GetPosition()), m_Orientation(toCopy.GetOrientation()), m_CovErrorMatrix(toCopy.GetCovErrorMatrix()),
         m_HasPosition(toCopy.GetHasPosition()), m_HasOrientation(toCopy.GetHasOrientation()), m_DataValid(toCopy.IsDataValid()), m_IGTTimeStamp(toCopy.GetIGTTimeStamp()),
-        m_Name(toCopy.GetName())
+        m_Name(toCopy.GetName()), m_StageTimeStamps(toCopy.GetStageTimeStamps())
 {/* TODO SW: Graft does the same, remove code duplications, set Graft to deprecated, remove duplication in tescode */}
 
 mitk::NavigationData::~NavigationData()
@@ -67,6 +67,25 @@ void mitk::NavigationData::Graft( const DataObject *data )
   this->SetHasOrientation(nd->GetHasOrientation());
   this->SetCovErrorMatrix(nd->GetCovErrorMatrix());
   this->SetName(nd->GetName());
+  m_StageTimeStamps = nd->GetStageTimeStamps();
+}
+
+
+void mitk::NavigationData::AddStageTimeStamp(const std::string& stage, TimeStampType timeStamp)
+{
+  m_StageTimeStamps.emplace_back(stage, timeStamp);
+}
+
+
+const mitk::NavigationData::StageTimeStampsType& mitk::NavigationData::GetStageTimeStamps() const
+{
+  return m_StageTimeStamps;
+}
+
+
+void mitk::NavigationData::ClearStageTimeStamps()
+{
+  m_StageTimeStamps.clear();
 }
 
 
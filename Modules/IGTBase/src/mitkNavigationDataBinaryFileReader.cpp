@@ -0,0 +1,130 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkNavigationDataBinaryFileReader.h"
+#include "mitkNavigationDataBinaryFormat.h"
+#include "mitkIGTIOException.h"
+
+#include <cstring>
+
+namespace
+{
+  std::uint32_t ReadUInt32(std::istream &stream)
+  {
+    char buffer[4] = {0, 0, 0, 0};
+    stream.read(buffer, sizeof(buffer));
+
+    std::uint32_t value;
+    mitk::NavigationDataBinaryFormat::ReadValue<std::uint32_t>(buffer, value);
+    return value;
+  }
+}
+
+mitk::NavigationDataBinaryFileReader::NavigationDataBinaryFileReader(const std::string &fileName)
+  : m_FileName(fileName), m_HeaderSize(0)
+{
+  if (!NavigationDataBinaryFormat::IsLittleEndianHost())
+    mitkThrowException(mitk::IGTIOException) << "The binary navigation data format is not supported on this platform.";
+
+  m_File.open(fileName, std::ios::binary);
+  if (!m_File)
+    mitkThrowException(mitk::IGTIOException) << "Cannot open " << fileName << " for reading.";
+
+  char magic[sizeof(NavigationDataBinaryFormat::Magic)];
+  m_File.read(magic, sizeof(magic));
+  if (!m_File || std::memcmp(magic, NavigationDataBinaryFormat::Magic, sizeof(magic)) != 0)
+    mitkThrowException(mitk::IGTIOException) << fileName << " is no binary navigation data file.";
+
+  const std::uint32_t version = ReadUInt32(m_File);
+  const std::uint32_t numberOfTools = ReadUInt32(m_File);
+  const std::uint32_t recordSize = ReadUInt32(m_File);
+
+  if (!m_File || version != NavigationDataBinaryFormat::Version || recordSize != NavigationDataBinaryFormat::RecordSize)
+  {
+    mitkThrowException(mitk::IGTIOException) << "Unsupported version " << version << " of binary navigation data file "
+                                             << fileName << ".";
+  }
+
+  for (std::uint32_t i = 0; i < numberOfTools; ++i)
+  {
+    const std::uint32_t length = ReadUInt32(m_File);
+    std::string toolName(length, '\0');
+    if (length > 0)
+      m_File.read(&toolName[0], length);
+    if (!m_File)
+      mitkThrowException(mitk::IGTIOException) << "The header of " << fileName << " is truncated.";
+    m_ToolNames.push_back(toolName);
+  }
+
+  m_HeaderSize = m_File.tellg();
+  m_Buffer.resize(m_ToolNames.size() * NavigationDataBinaryFormat::RecordSize);
+}
+
+unsigned int mitk::NavigationDataBinaryFileReader::GetNumberOfTools() const
+{
+  return static_cast<unsigned int>(m_ToolNames.size());
+}
+
+const std::vector<std::string> &mitk::NavigationDataBinaryFileReader::GetToolNames() const
+{
+  return m_ToolNames;
+}
+
+std::size_t mitk::NavigationDataBinaryFileReader::GetNumberOfSnapshots()
+{
+  if (m_Buffer.empty())
+    return 0;
+
+  m_File.clear();
+  m_File.seekg(0, std::ios::end);
+  const std::streamoff fileSize = m_File.tellg();
+  if (fileSize <= m_HeaderSize)
+    return 0;
+
+  return static_cast<std::size_t>(fileSize - m_HeaderSize) / m_Buffer.size();
+}
+
+std::vector<mitk::NavigationData::Pointer> mitk::NavigationDataBinaryFileReader::ReadSnapshot(std::size_t index)
+{
+  if (index >= this->GetNumberOfSnapshots())
+  {
+    mitkThrowException(mitk::IGTIOException) << "Snapshot " << index << " does not exist in " << m_FileName << ".";
+  }
+
+  m_File.clear();
+  m_File.seekg(m_HeaderSize + static_cast<std::streamoff>(index * m_Buffer.size()));
+  m_File.read(m_Buffer.data(), m_Buffer.size());
+  if (!m_File)
+    mitkThrowException(mitk::IGTIOException) << "Cannot read snapshot " << index << " from " << m_FileName << ".";
+
+  std::vector<NavigationData::Pointer> snapshot;
+  snapshot.reserve(m_ToolNames.size());
+  for (std::size_t i = 0; i < m_ToolNames.size(); ++i)
+  {
+    auto nd = NavigationData::New();
+    NavigationDataBinaryFormat::ReadRecord(m_Buffer.data() + i * NavigationDataBinaryFormat::RecordSize, nd);
+    nd->SetName(m_ToolNames[i]);
+    snapshot.push_back(nd);
+  }
+  return snapshot;
+}
+
+mitk::NavigationDataSet::Pointer mitk::NavigationDataBinaryFileReader::ReadNavigationDataSet()
+{
+  auto navigationDataSet = NavigationDataSet::New(this->GetNumberOfTools());
+
+  const std::size_t numberOfSnapshots = this->GetNumberOfSnapshots();
+  for (std::size_t i = 0; i < numberOfSnapshots; ++i)
+    navigationDataSet->AddNavigationDatas(this->ReadSnapshot(i));
+
+  return navigationDataSet;
+}
@@ -0,0 +1,232 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkNavigationDataBinaryFileWriter.h"
+#include "mitkNavigationDataBinaryFormat.h"
+#include "mitkIGTIOException.h"
+
+#include <algorithm>
+
+mitk::NavigationDataBinaryFileWriter::NavigationDataBinaryFileWriter()
+  : m_NumberOfTools(0),
+    m_NumberOfSnapshots(0),
+    m_ChunkSize(100),
+    m_MaximumNumberOfPendingChunks(64),
+    m_StopWriting(false)
+{
+}
+
+mitk::NavigationDataBinaryFileWriter::~NavigationDataBinaryFileWriter()
+{
+  try
+  {
+    this->Close();
+  }
+  catch (const std::exception &e)
+  {
+    MITK_ERROR << e.what();
+  }
+}
+
+void mitk::NavigationDataBinaryFileWriter::Open(const std::string &fileName, const std::vector<std::string> &toolNames)
+{
+  if (this->IsOpen())
+    mitkThrowException(mitk::IGTIOException) << "Cannot open " << fileName << ", " << m_FileName << " is still open.";
+
+  if (!NavigationDataBinaryFormat::IsLittleEndianHost())
+    mitkThrowException(mitk::IGTIOException) << "The binary navigation data format is not supported on this platform.";
+
+  m_File.open(fileName, std::ios::binary | std::ios::trunc);
+  if (!m_File)
+    mitkThrowException(mitk::IGTIOException) << "Cannot open " << fileName << " for writing.";
+
+  m_File.write(NavigationDataBinaryFormat::Magic, sizeof(NavigationDataBinaryFormat::Magic));
+
+  char value[4];
+  NavigationDataBinaryFormat::WriteValue<std::uint32_t>(value, NavigationDataBinaryFormat::Version);
+  m_File.write(value, sizeof(value));
+  NavigationDataBinaryFormat::WriteValue<std::uint32_t>(value, static_cast<std::uint32_t>(toolNames.size()));
+  m_File.write(value, sizeof(value));
+  NavigationDataBinaryFormat::WriteValue<std::uint32_t>(value, NavigationDataBinaryFormat::RecordSize);
+  m_File.write(value, sizeof(value));
+
+  for (const auto &toolName : toolNames)
+  {
+    NavigationDataBinaryFormat::WriteValue<std::uint32_t>(value, static_cast<std::uint32_t>(toolName.size()));
+    m_File.write(value, sizeof(value));
+    m_File.write(toolName.data(), toolName.size());
+  }
+
+  if (!m_File.flush())
+  {
+    m_File.close();
+    mitkThrowException(mitk::IGTIOException) << "Cannot write the header of " << fileName << ".";
+  }
+
+  m_FileName = fileName;
+  m_NumberOfTools = toolNames.size();
+  m_NumberOfSnapshots = 0;
+  m_CurrentChunk.clear();
+  m_CurrentChunk.reserve(m_ChunkSize * m_NumberOfTools * NavigationDataBinaryFormat::RecordSize);
+  m_StopWriting = false;
+  m_Error.clear();
+  m_WriterThread = std::thread(&NavigationDataBinaryFileWriter::WriterThread, this);
+}
+
+void mitk::NavigationDataBinaryFileWriter::Append(const std::vector<NavigationData::Pointer> &snapshot)
+{
+  if (!this->IsOpen())
+    mitkThrowException(mitk::IGTIOException) << "Cannot append navigation data, no file is open.";
+
+  if (snapshot.size() != m_NumberOfTools)
+  {
+    mitkThrowException(mitk::IGTIOException) << "Cannot append " << snapshot.size()
+                                             << " navigation datas to a file with " << m_NumberOfTools << " tools.";
+  }
+
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  if (!m_Error.empty())
+    mitkThrowException(mitk::IGTIOException) << m_Error;
+
+  const std::size_t offset = m_CurrentChunk.size();
+  m_CurrentChunk.resize(offset + m_NumberOfTools * NavigationDataBinaryFormat::RecordSize);
+  for (std::size_t i = 0; i < m_NumberOfTools; ++i)
+  {
+    NavigationDataBinaryFormat::WriteRecord(
+      m_CurrentChunk.data() + offset + i * NavigationDataBinaryFormat::RecordSize, snapshot[i]);
+  }
+  ++m_NumberOfSnapshots;
+
+  if (m_CurrentChunk.size() >= m_ChunkSize * m_NumberOfTools * NavigationDataBinaryFormat::RecordSize)
+    this->QueueCurrentChunk(lock);
+}
+
+void mitk::NavigationDataBinaryFileWriter::Flush()
+{
+  if (!this->IsOpen())
+    return;
+
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  this->QueueCurrentChunk(lock);
+}
+
+void mitk::NavigationDataBinaryFileWriter::Close()
+{
+  if (!this->IsOpen())
+    return;
+
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    this->QueueCurrentChunk(lock);
+    m_StopWriting = true;
+  }
+  m_ChunkAvailable.notify_one();
+  m_WriterThread.join();
+  m_File.close();
+
+  if (!m_Error.empty())
+    mitkThrowException(mitk::IGTIOException) << m_Error;
+}
+
+bool mitk::NavigationDataBinaryFileWriter::IsOpen() const
+{
+  return m_WriterThread.joinable();
+}
+
+std::size_t mitk::NavigationDataBinaryFileWriter::GetNumberOfSnapshots() const
+{
+  return m_NumberOfSnapshots;
+}
+
+void mitk::NavigationDataBinaryFileWriter::SetChunkSize(std::size_t numberOfSnapshots)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_ChunkSize = std::max<std::size_t>(1, numberOfSnapshots);
+}
+
+std::size_t mitk::NavigationDataBinaryFileWriter::GetChunkSize() const
+{
+  return m_ChunkSize;
+}
+
+void mitk::NavigationDataBinaryFileWriter::SetMaximumNumberOfPendingChunks(std::size_t numberOfChunks)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_MaximumNumberOfPendingChunks = std::max<std::size_t>(1, numberOfChunks);
+}
+
+std::size_t mitk::NavigationDataBinaryFileWriter::GetMaximumNumberOfPendingChunks() const
+{
+  return m_MaximumNumberOfPendingChunks;
+}
+
+void mitk::NavigationDataBinaryFileWriter::Write(const std::string &fileName,
+                                                 const NavigationDataSet *navigationDataSet)
+{
+  std::vector<std::string> toolNames;
+  if (navigationDataSet->Size() > 0)
+  {
+    for (const auto &nd : navigationDataSet->GetTimeStep(0))
+      toolNames.push_back(nd->GetName());
+  }
+  else
+  {
+    toolNames.resize(navigationDataSet->GetNumberOfTools());
+  }
+
+  NavigationDataBinaryFileWriter writer;
+  writer.SetChunkSize(1000);
+  writer.Open(fileName, toolNames);
+  for (auto it = navigationDataSet->Begin(); it != navigationDataSet->End(); ++it)
+    writer.Append(*it);
+  writer.Close();
+}
+
+void mitk::NavigationDataBinaryFileWriter::QueueCurrentChunk(std::unique_lock<std::mutex> &lock)
+{
+  if (m_CurrentChunk.empty())
+    return;
+
+  // block the producer instead of letting the backlog grow without bounds
+  m_ChunkWritten.wait(lock, [this]() {
+    return m_PendingChunks.size() < m_MaximumNumberOfPendingChunks || !m_Error.empty();
+  });
+
+  std::vector<char> chunk;
+  chunk.reserve(m_CurrentChunk.capacity());
+  m_PendingChunks.push_back(std::move(m_CurrentChunk));
+  m_CurrentChunk = std::move(chunk);
+  m_ChunkAvailable.notify_one();
+}
+
+void mitk::NavigationDataBinaryFileWriter::WriterThread()
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  for (;;)
+  {
+    m_ChunkAvailable.wait(lock, [this]() { return !m_PendingChunks.empty() || m_StopWriting; });
+    if (m_PendingChunks.empty())
+      return;
+
+    std::vector<char> chunk = std::move(m_PendingChunks.front());
+    m_PendingChunks.pop_front();
+
+    lock.unlock();
+    const bool success = static_cast<bool>(m_File.write(chunk.data(), chunk.size()).flush());
+    lock.lock();
+
+    if (!success && m_Error.empty())
+      m_Error = "Cannot write navigation data to " + m_FileName + ".";
+
+    m_ChunkWritten.notify_all();
+  }
+}
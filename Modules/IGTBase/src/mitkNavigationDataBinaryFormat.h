@@ -0,0 +1,132 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkNavigationDataBinaryFormat_h
+#define mitkNavigationDataBinaryFormat_h
+
+#include "mitkNavigationData.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace mitk
+{
+  /**
+   * Layout of the binary navigation data format, shared by NavigationDataBinaryFileWriter and
+   * NavigationDataBinaryFileReader. All values are stored little endian.
+   *
+   * Header: 8 byte magic, uint32 version, uint32 number of tools, uint32 record size and for each tool
+   * an uint32 name length followed by the name.
+   *
+   * Then one fixed size record per tool and snapshot follows: double timestamp, double position[3],
+   * double orientation[4], float covariance diagonal[6] and an uint8 with the valid/hasPosition/hasOrientation
+   * flags. Since all snapshots have the same size, snapshot i is found without an index, and a file which
+   * was not closed properly (e.g. after a crash) can still be read up to the last complete snapshot.
+   */
+  namespace NavigationDataBinaryFormat
+  {
+    const char Magic[8] = {'M', 'I', 'T', 'K', 'N', 'D', 'B', '\0'};
+    const std::uint32_t Version = 1;
+    const std::uint32_t RecordSize = 8 + 3 * 8 + 4 * 8 + 6 * 4 + 1;
+
+    enum Flags : std::uint8_t
+    {
+      DataValid = 1,
+      HasPosition = 2,
+      HasOrientation = 4
+    };
+
+    inline bool IsLittleEndianHost()
+    {
+      const std::uint16_t one = 1;
+      return *reinterpret_cast<const unsigned char *>(&one) == 1;
+    }
+
+    template <typename T>
+    char *WriteValue(char *buffer, T value)
+    {
+      std::memcpy(buffer, &value, sizeof(T));
+      return buffer + sizeof(T);
+    }
+
+    template <typename T>
+    const char *ReadValue(const char *buffer, T &value)
+    {
+      std::memcpy(&value, buffer, sizeof(T));
+      return buffer + sizeof(T);
+    }
+
+    /** Writes RecordSize bytes to buffer. */
+    inline void WriteRecord(char *buffer, const NavigationData *nd)
+    {
+      buffer = WriteValue<double>(buffer, nd->GetIGTTimeStamp());
+
+      const NavigationData::PositionType position = nd->GetPosition();
+      for (int i = 0; i < 3; ++i)
+        buffer = WriteValue<double>(buffer, position[i]);
+
+      const NavigationData::OrientationType orientation = nd->GetOrientation();
+      for (int i = 0; i < 4; ++i)
+        buffer = WriteValue<double>(buffer, orientation[i]);
+
+      const NavigationData::CovarianceMatrixType covariance = nd->GetCovErrorMatrix();
+      for (int i = 0; i < 6; ++i)
+        buffer = WriteValue<float>(buffer, static_cast<float>(covariance[i][i]));
+
+      std::uint8_t flags = 0;
+      if (nd->IsDataValid())
+        flags |= DataValid;
+      if (nd->GetHasPosition())
+        flags |= HasPosition;
+      if (nd->GetHasOrientation())
+        flags |= HasOrientation;
+      WriteValue<std::uint8_t>(buffer, flags);
+    }
+
+    /** Reads RecordSize bytes from buffer. */
+    inline void ReadRecord(const char *buffer, NavigationData *nd)
+    {
+      double timeStamp;
+      buffer = ReadValue<double>(buffer, timeStamp);
+
+      NavigationData::PositionType position;
+      for (int i = 0; i < 3; ++i)
+        buffer = ReadValue<double>(buffer, position[i]);
+
+      NavigationData::OrientationType orientation;
+      for (int i = 0; i < 4; ++i)
+        buffer = ReadValue<double>(buffer, orientation[i]);
+
+      NavigationData::CovarianceMatrixType covariance;
+      covariance.Fill(0.0);
+      for (int i = 0; i < 6; ++i)
+      {
+        float value;
+        buffer = ReadValue<float>(buffer, value);
+        covariance[i][i] = value;
+      }
+
+      std::uint8_t flags;
+      ReadValue<std::uint8_t>(buffer, flags);
+
+      nd->SetIGTTimeStamp(timeStamp);
+      nd->SetPosition(position);
+      nd->SetOrientation(orientation);
+      nd->SetCovErrorMatrix(covariance);
+      nd->SetDataValid((flags & DataValid) != 0);
+      nd->SetHasPosition((flags & HasPosition) != 0);
+      nd->SetHasOrientation((flags & HasOrientation) != 0);
+    }
+  }
+}
+
+#endif
@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include "mitkIOExtActivator.h"
 
 #include "mitkObjFileReaderService.h"
+#include "mitkOmeZarrImageIO.h"
 #include "mitkPlyFileReaderService.h"
 #include "mitkPlyFileWriterService.h"
 #include "mitkSceneFileReader.h"
@@ -29,6 +30,8 @@ namespace mitk
 
     m_PlyReader.reset(new PlyFileReaderService());
     m_ObjWriter.reset(new PlyFileWriterService());
+
+    m_OmeZarrImageIO.reset(new OmeZarrImageIO());
   }
 
   void IOExtActivator::Unload(us::ModuleContext *) {}
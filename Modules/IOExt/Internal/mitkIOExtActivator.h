@@ -35,6 +35,7 @@ namespace mitk
     std::unique_ptr<IFileWriter> m_ObjWriter;
 
     std::unique_ptr<IFileReader> m_PlyReader;
+    std::unique_ptr<IFileReader> m_OmeZarrImageIO;
   };
 }
 
@@ -0,0 +1,936 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkOmeZarrImageIO.h"
+
+#include <mitkCustomMimeType.h>
+#include <mitkIOMimeTypes.h>
+#include <mitkImage.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkLocaleSwitch.h>
+#include <mitkProportionalTimeGeometry.h>
+
+#include <itksys/SystemTools.hxx>
+
+#include "itk_zlib.h"
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+  const char *const OPTION_NAME_CHUNK_SIZE = "Chunk size";
+  const char *const OPTION_NAME_RESOLUTION_LEVELS = "Resolution levels";
+  const char *const OPTION_NAME_RESOLUTION_LEVEL = "Resolution level";
+
+  // Zarr lists the axes from the slowest to the fastest varying one, i.e. in reverse order of mitk::Image
+  const char *const AXIS_NAMES[] = {"t", "z", "y", "x"};
+
+  const int COMPRESSION_LEVEL = 1;
+  const unsigned int MAX_NUMBER_OF_LEVELS = 16;
+
+  typedef boost::property_tree::ptree JsonTree;
+
+  mitk::CustomMimeType OME_ZARR_MIMETYPE()
+  {
+    mitk::CustomMimeType mimeType(mitk::IOMimeTypes::DEFAULT_BASE_NAME() + ".image.omezarr");
+    mimeType.SetCategory("Images");
+    mimeType.SetComment("OME-Zarr image");
+    mimeType.AddExtension("ome.zarr");
+    mimeType.AddExtension("zarr");
+    return mimeType;
+  }
+
+  /** The shape and chunk shape of a Zarr array in Zarr (C) order.*/
+  struct ArrayLayout
+  {
+    std::vector<std::size_t> Shape;
+    std::vector<std::size_t> Chunks;
+    std::size_t ElementSize;
+
+    std::size_t GetNumberOfElements() const
+    {
+      std::size_t numberOfElements = 1;
+      for (auto size : Shape)
+        numberOfElements *= size;
+      return numberOfElements;
+    }
+
+    std::size_t GetChunkSizeInBytes() const
+    {
+      std::size_t size = ElementSize;
+      for (auto chunkSize : Chunks)
+        size *= chunkSize;
+      return size;
+    }
+
+    std::size_t GetNumberOfChunks() const
+    {
+      std::size_t numberOfChunks = 1;
+      for (std::size_t i = 0; i < Shape.size(); ++i)
+        numberOfChunks *= (Shape[i] + Chunks[i] - 1) / Chunks[i];
+      return numberOfChunks;
+    }
+
+    std::vector<std::size_t> GetChunkIndex(std::size_t flatIndex) const
+    {
+      std::vector<std::size_t> chunkIndex(Shape.size());
+      for (std::size_t i = Shape.size(); i-- > 0;)
+      {
+        const std::size_t numberOfChunks = (Shape[i] + Chunks[i] - 1) / Chunks[i];
+        chunkIndex[i] = flatIndex % numberOfChunks;
+        flatIndex /= numberOfChunks;
+      }
+      return chunkIndex;
+    }
+  };
+
+  std::string GetChunkKey(const std::vector<std::size_t> &chunkIndex, std::size_t numberOfAxes, char separator)
+  {
+    std::ostringstream key;
+    for (std::size_t i = 0; i < numberOfAxes; ++i)
+    {
+      if (i != 0)
+        key << separator;
+      key << chunkIndex[i];
+    }
+    return key.str();
+  }
+
+  /**
+   * Calls function(arrayOffset, chunkOffset, size) with the byte offsets of all rows of a chunk that lie inside
+   * the array. Rows run along the fastest varying axis, edge chunks are only partially covered by the array.
+   */
+  template <typename Function>
+  void ForEachChunkRow(const ArrayLayout &layout, const std::vector<std::size_t> &chunkIndex, Function function)
+  {
+    const std::size_t numberOfAxes = layout.Shape.size();
+    std::vector<std::size_t> begin(numberOfAxes), extent(numberOfAxes);
+    std::vector<std::size_t> arrayStride(numberOfAxes), chunkStride(numberOfAxes);
+
+    for (std::size_t i = numberOfAxes; i-- > 0;)
+    {
+      begin[i] = chunkIndex[i] * layout.Chunks[i];
+      extent[i] = std::min(layout.Chunks[i], layout.Shape[i] - begin[i]);
+      arrayStride[i] = i + 1 == numberOfAxes ? layout.ElementSize : arrayStride[i + 1] * layout.Shape[i + 1];
+      chunkStride[i] = i + 1 == numberOfAxes ? layout.ElementSize : chunkStride[i + 1] * layout.Chunks[i + 1];
+    }
+
+    const std::size_t rowSize = extent.back() * layout.ElementSize;
+    std::vector<std::size_t> position(numberOfAxes, 0);
+
+    for (;;)
+    {
+      std::size_t arrayOffset = begin.back() * arrayStride.back();
+      std::size_t chunkOffset = 0;
+      for (std::size_t i = 0; i + 1 < numberOfAxes; ++i)
+      {
+        arrayOffset += (begin[i] + position[i]) * arrayStride[i];
+        chunkOffset += position[i] * chunkStride[i];
+      }
+
+      function(arrayOffset, chunkOffset, rowSize);
+
+      std::size_t axis = numberOfAxes - 1;
+      while (axis > 0 && ++position[axis - 1] == extent[axis - 1])
+        position[--axis] = 0;
+
+      if (axis == 0)
+        break;
+    }
+  }
+
+  /** Calls function(i) for all i in [0, count) on one thread per hardware thread and rethrows the first error.*/
+  template <typename Function>
+  void ParallelFor(std::size_t count, Function function)
+  {
+    const std::size_t numberOfThreads =
+      std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), count);
+
+    std::atomic<std::size_t> nextIndex(0);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    auto worker = [&]() {
+      for (std::size_t i = nextIndex++; i < count; i = nextIndex++)
+      {
+        try
+        {
+          function(i);
+        }
+        catch (...)
+        {
+          std::lock_guard<std::mutex> lock(errorMutex);
+          if (!error)
+            error = std::current_exception();
+          nextIndex = count;
+        }
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < numberOfThreads; ++i)
+      threads.emplace_back(worker);
+    worker();
+
+    for (auto &thread : threads)
+      thread.join();
+
+    if (error)
+      std::rethrow_exception(error);
+  }
+
+  bool IsLittleEndian()
+  {
+    const std::uint16_t one = 1;
+    return *reinterpret_cast<const unsigned char *>(&one) == 1;
+  }
+
+  std::string GetZarrDataType(const mitk::PixelType &pixelType)
+  {
+    if (pixelType.GetNumberOfComponents() != 1)
+      return std::string();
+
+    const std::string byteOrder = IsLittleEndian() ? "<" : ">";
+
+    switch (pixelType.GetComponentType())
+    {
+      case itk::ImageIOBase::UCHAR:
+        return "|u1";
+      case itk::ImageIOBase::CHAR:
+        return "|i1";
+      case itk::ImageIOBase::USHORT:
+        return byteOrder + "u2";
+      case itk::ImageIOBase::SHORT:
+        return byteOrder + "i2";
+      case itk::ImageIOBase::UINT:
+        return byteOrder + "u4";
+      case itk::ImageIOBase::INT:
+        return byteOrder + "i4";
+      case itk::ImageIOBase::FLOAT:
+        return byteOrder + "f4";
+      case itk::ImageIOBase::DOUBLE:
+        return byteOrder + "f8";
+      default:
+        return std::string();
+    }
+  }
+
+  mitk::PixelType MakeZarrPixelType(const std::string &dataType)
+  {
+    const std::string type = dataType.size() == 3 ? dataType.substr(1) : std::string();
+
+    if (type == "u1")
+      return mitk::MakeScalarPixelType<unsigned char>();
+    if (type == "i1")
+      return mitk::MakeScalarPixelType<char>();
+    if (type == "u2")
+      return mitk::MakeScalarPixelType<unsigned short>();
+    if (type == "i2")
+      return mitk::MakeScalarPixelType<short>();
+    if (type == "u4")
+      return mitk::MakeScalarPixelType<unsigned int>();
+    if (type == "i4")
+      return mitk::MakeScalarPixelType<int>();
+    if (type == "f4")
+      return mitk::MakeScalarPixelType<float>();
+    if (type == "f8")
+      return mitk::MakeScalarPixelType<double>();
+
+    mitkThrow() << "Unsupported Zarr data type " << dataType;
+  }
+
+  template <typename T>
+  void FillTyped(char *data, std::size_t numberOfElements, double value)
+  {
+    std::fill_n(reinterpret_cast<T *>(data), numberOfElements, static_cast<T>(value));
+  }
+
+  void Fill(char *data, std::size_t numberOfElements, const mitk::PixelType &pixelType, double value)
+  {
+    switch (pixelType.GetComponentType())
+    {
+      case itk::ImageIOBase::UCHAR:
+        return FillTyped<unsigned char>(data, numberOfElements, value);
+      case itk::ImageIOBase::CHAR:
+        return FillTyped<char>(data, numberOfElements, value);
+      case itk::ImageIOBase::USHORT:
+        return FillTyped<unsigned short>(data, numberOfElements, value);
+      case itk::ImageIOBase::SHORT:
+        return FillTyped<short>(data, numberOfElements, value);
+      case itk::ImageIOBase::UINT:
+        return FillTyped<unsigned int>(data, numberOfElements, value);
+      case itk::ImageIOBase::INT:
+        return FillTyped<int>(data, numberOfElements, value);
+      case itk::ImageIOBase::FLOAT:
+        return FillTyped<float>(data, numberOfElements, value);
+      default:
+        return FillTyped<double>(data, numberOfElements, value);
+    }
+  }
+
+  void SwapBytes(char *data, std::size_t size, std::size_t elementSize)
+  {
+    for (std::size_t offset = 0; offset + elementSize <= size; offset += elementSize)
+      std::reverse(data + offset, data + offset + elementSize);
+  }
+
+  std::vector<char> Compress(const std::vector<char> &data)
+  {
+    uLongf size = compressBound(static_cast<uLong>(data.size()));
+    std::vector<char> result(size);
+
+    if (compress2(reinterpret_cast<Bytef *>(result.data()),
+                  &size,
+                  reinterpret_cast<const Bytef *>(data.data()),
+                  static_cast<uLong>(data.size()),
+                  COMPRESSION_LEVEL) != Z_OK)
+    {
+      mitkThrow() << "Could not compress a chunk.";
+    }
+
+    result.resize(size);
+    return result;
+  }
+
+  /** Inflates zlib as well as gzip compressed chunks.*/
+  void Decompress(std::vector<char> &data, char *output, std::size_t outputSize)
+  {
+    z_stream stream;
+    stream.zalloc = Z_NULL;
+    stream.zfree = Z_NULL;
+    stream.opaque = Z_NULL;
+    stream.next_in = reinterpret_cast<Bytef *>(data.data());
+    stream.avail_in = static_cast<uInt>(data.size());
+
+    if (inflateInit2(&stream, 32 + MAX_WBITS) != Z_OK)
+      mitkThrow() << "Could not initialize zlib decompression.";
+
+    stream.next_out = reinterpret_cast<Bytef *>(output);
+    stream.avail_out = static_cast<uInt>(outputSize);
+
+    const int result = inflate(&stream, Z_FINISH);
+    const bool complete = result == Z_STREAM_END && stream.avail_out == 0;
+    inflateEnd(&stream);
+
+    if (!complete)
+      mitkThrow() << "Invalid compressed chunk.";
+  }
+
+  std::vector<char> ReadFile(const std::string &path)
+  {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+      mitkThrow() << "Could not open " << path;
+
+    std::vector<char> data(static_cast<std::size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(data.data(), data.size());
+
+    if (!file)
+      mitkThrow() << "Could not read " << path;
+
+    return data;
+  }
+
+  void WriteFile(const std::string &path, const char *data, std::size_t size)
+  {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(data, size);
+
+    if (!file)
+      mitkThrow() << "Could not write " << path;
+  }
+
+  JsonTree ReadJson(const std::string &path)
+  {
+    JsonTree tree;
+    boost::property_tree::read_json(path, tree);
+    return tree;
+  }
+
+  template <typename T>
+  std::vector<T> GetJsonArray(const JsonTree &tree, const std::string &key)
+  {
+    std::vector<T> values;
+    for (const auto &child : tree.get_child(key))
+      values.push_back(child.second.get_value<T>());
+    return values;
+  }
+
+  template <typename T>
+  std::string ToJsonArray(const std::vector<T> &values)
+  {
+    std::ostringstream stream;
+    stream << std::setprecision(std::numeric_limits<double>::max_digits10) << '[';
+    for (std::size_t i = 0; i < values.size(); ++i)
+      stream << (i != 0 ? ", " : "") << values[i];
+    stream << ']';
+    return stream.str();
+  }
+
+  /** Downsamples the spatial axes by 2 by taking every second voxel, which is valid for label images, too.*/
+  std::vector<char> Downsample(const char *data, ArrayLayout &layout, const std::vector<bool> &isSpatial)
+  {
+    const std::size_t numberOfAxes = layout.Shape.size();
+    std::vector<std::size_t> shape(numberOfAxes), sourceStride(numberOfAxes), factor(numberOfAxes);
+
+    for (std::size_t i = numberOfAxes; i-- > 0;)
+    {
+      factor[i] = isSpatial[i] && layout.Shape[i] > 1 ? 2 : 1;
+      shape[i] = (layout.Shape[i] + factor[i] - 1) / factor[i];
+      sourceStride[i] = i + 1 == numberOfAxes ? layout.ElementSize : sourceStride[i + 1] * layout.Shape[i + 1];
+    }
+
+    ArrayLayout downsampledLayout = layout;
+    downsampledLayout.Shape = shape;
+    std::vector<char> result(downsampledLayout.GetNumberOfElements() * layout.ElementSize);
+
+    char *target = result.data();
+    std::vector<std::size_t> position(numberOfAxes, 0);
+
+    for (;;)
+    {
+      std::size_t sourceOffset = 0;
+      for (std::size_t i = 0; i + 1 < numberOfAxes; ++i)
+        sourceOffset += position[i] * factor[i] * sourceStride[i];
+
+      for (std::size_t x = 0; x < shape.back(); ++x)
+      {
+        std::memcpy(target, data + sourceOffset + x * factor.back() * layout.ElementSize, layout.ElementSize);
+        target += layout.ElementSize;
+      }
+
+      std::size_t axis = numberOfAxes - 1;
+      while (axis > 0 && ++position[axis - 1] == shape[axis - 1])
+        position[--axis] = 0;
+
+      if (axis == 0)
+        break;
+    }
+
+    layout.Shape = shape;
+    return result;
+  }
+
+  void WriteLevel(const std::string &levelPath,
+                  const ArrayLayout &layout,
+                  const char *data,
+                  const std::string &dataType)
+  {
+    if (!itksys::SystemTools::MakeDirectory(levelPath))
+      mitkThrow() << "Could not create directory " << levelPath;
+
+    std::ostringstream arrayMetaData;
+    arrayMetaData << "{\n"
+                  << "  \"zarr_format\": 2,\n"
+                  << "  \"shape\": " << ToJsonArray(layout.Shape) << ",\n"
+                  << "  \"chunks\": " << ToJsonArray(layout.Chunks) << ",\n"
+                  << "  \"dtype\": \"" << dataType << "\",\n"
+                  << "  \"compressor\": {\"id\": \"zlib\", \"level\": " << COMPRESSION_LEVEL << "},\n"
+                  << "  \"fill_value\": 0,\n"
+                  << "  \"order\": \"C\",\n"
+                  << "  \"filters\": null,\n"
+                  << "  \"dimension_separator\": \"/\"\n"
+                  << "}\n";
+    const std::string arrayMetaDataString = arrayMetaData.str();
+    WriteFile(levelPath + "/.zarray", arrayMetaDataString.data(), arrayMetaDataString.size());
+
+    const std::size_t numberOfAxes = layout.Shape.size();
+    const std::size_t numberOfChunks = layout.GetNumberOfChunks();
+
+    // The chunks are written concurrently, so their directories are created up front
+    for (std::size_t i = 0; i < numberOfChunks; ++i)
+    {
+      const std::vector<std::size_t> chunkIndex = layout.GetChunkIndex(i);
+      if (chunkIndex.back() == 0)
+        itksys::SystemTools::MakeDirectory(levelPath + '/' + GetChunkKey(chunkIndex, numberOfAxes - 1, '/'));
+    }
+
+    ParallelFor(numberOfChunks, [&](std::size_t i) {
+      const std::vector<std::size_t> chunkIndex = layout.GetChunkIndex(i);
+      std::vector<char> chunk(layout.GetChunkSizeInBytes(), 0);
+
+      ForEachChunkRow(layout, chunkIndex, [&](std::size_t arrayOffset, std::size_t chunkOffset, std::size_t size) {
+        std::memcpy(chunk.data() + chunkOffset, data + arrayOffset, size);
+      });
+
+      // Chunks containing only the fill value are omitted, which saves a lot of requests for label images
+      if (std::all_of(chunk.begin(), chunk.end(), [](char value) { return value == 0; }))
+        return;
+
+      const std::vector<char> compressedChunk = Compress(chunk);
+      WriteFile(levelPath + '/' + GetChunkKey(chunkIndex, numberOfAxes, '/'),
+                compressedChunk.data(),
+                compressedChunk.size());
+    });
+  }
+
+  void PrepareStoreDirectory(const std::string &path)
+  {
+    if (itksys::SystemTools::FileExists(path))
+    {
+      if (itksys::SystemTools::FileIsDirectory(path))
+      {
+        // Replace an existing store, so that no chunks of a previous, larger image remain
+        if (!itksys::SystemTools::FileExists(path + "/.zgroup"))
+          mitkThrow() << path << " already exists and is not a Zarr store.";
+
+        if (!itksys::SystemTools::RemoveADirectory(path))
+          mitkThrow() << "Could not remove the existing Zarr store " << path;
+      }
+      else if (itksys::SystemTools::FileLength(path) == 0)
+      {
+        // e.g. a placeholder created by IOUtil::CreateTemporaryFile()
+        itksys::SystemTools::RemoveFile(path);
+      }
+      else
+      {
+        mitkThrow() << path << " already exists and is not a Zarr store.";
+      }
+    }
+
+    if (!itksys::SystemTools::MakeDirectory(path))
+      mitkThrow() << "Could not create directory " << path;
+  }
+
+  /** Reads the scale and translation of a list of OME-Zarr coordinate transformations.*/
+  void ReadCoordinateTransformations(const JsonTree &tree, std::vector<double> &scale, std::vector<double> &translation)
+  {
+    auto transformations = tree.get_child_optional("coordinateTransformations");
+    if (!transformations)
+      return;
+
+    for (const auto &transformation : *transformations)
+    {
+      const std::string type = transformation.second.get<std::string>("type");
+      if (type == "scale")
+        scale = GetJsonArray<double>(transformation.second, "scale");
+      else if (type == "translation")
+        translation = GetJsonArray<double>(transformation.second, "translation");
+    }
+  }
+}
+
+namespace mitk
+{
+  OmeZarrImageIO::OmeZarrImageIO()
+    : AbstractFileIO(Image::GetStaticNameOfClass(), OME_ZARR_MIMETYPE(), "OME-Zarr Image")
+  {
+    Options defaultReaderOptions;
+    defaultReaderOptions[OPTION_NAME_RESOLUTION_LEVEL] = 0;
+    this->SetDefaultReaderOptions(defaultReaderOptions);
+
+    Options defaultWriterOptions;
+    defaultWriterOptions[OPTION_NAME_CHUNK_SIZE] = 64;
+    defaultWriterOptions[OPTION_NAME_RESOLUTION_LEVELS] = 0;
+    this->SetDefaultWriterOptions(defaultWriterOptions);
+
+    this->RegisterService();
+  }
+
+  OmeZarrImageIO::OmeZarrImageIO(const OmeZarrImageIO &other) : AbstractFileIO(other) {}
+
+  std::vector<BaseData::Pointer> OmeZarrImageIO::Read()
+  {
+    const std::string path = this->GetInputLocation();
+    LocaleSwitch localeSwitch("C");
+
+    try
+    {
+      const JsonTree attributes = ReadJson(path + "/.zattrs");
+      const JsonTree &multiscales = attributes.get_child("multiscales");
+      if (multiscales.empty())
+        mitkThrow() << "The OME-Zarr store " << path << " does not contain any image.";
+
+      const JsonTree &multiscale = multiscales.begin()->second;
+
+      // OME-Zarr 0.3 lists the axes as strings, 0.4 as objects
+      std::vector<std::string> axes;
+      for (const auto &axis : multiscale.get_child("axes"))
+      {
+        axes.push_back(axis.second.empty() ? axis.second.get_value<std::string>()
+                                           : axis.second.get<std::string>("name"));
+      }
+
+      std::vector<const JsonTree *> datasets;
+      for (const auto &dataset : multiscale.get_child("datasets"))
+        datasets.push_back(&dataset.second);
+
+      if (datasets.empty())
+        mitkThrow() << "The OME-Zarr store " << path << " does not contain any resolution level.";
+
+      const int requestedLevel = us::any_cast<int>(this->GetReaderOption(OPTION_NAME_RESOLUTION_LEVEL));
+      const std::size_t level = std::min<std::size_t>(std::max(0, requestedLevel), datasets.size() - 1);
+      const JsonTree &dataset = *datasets[level];
+      const std::string levelPath = path + '/' + dataset.get<std::string>("path");
+
+      const JsonTree arrayMetaData = ReadJson(levelPath + "/.zarray");
+      if (arrayMetaData.get<int>("zarr_format") != 2)
+        mitkThrow() << "Only Zarr format 2 is supported.";
+
+      ArrayLayout layout;
+      layout.Shape = GetJsonArray<std::size_t>(arrayMetaData, "shape");
+      layout.Chunks = GetJsonArray<std::size_t>(arrayMetaData, "chunks");
+
+      if (axes.size() != layout.Shape.size() || layout.Chunks.size() != layout.Shape.size())
+        mitkThrow() << "The axes of " << path << " do not match the shape of its arrays.";
+
+      if (arrayMetaData.get<std::string>("order", "C") != "C")
+        mitkThrow() << "Only Zarr arrays in C order are supported.";
+
+      const auto filters = arrayMetaData.get_child_optional("filters");
+      if (filters && !filters->empty())
+        mitkThrow() << "Zarr filters are not supported.";
+
+      std::string compressor;
+      const auto compressorMetaData = arrayMetaData.get_child_optional("compressor");
+      if (compressorMetaData)
+        compressor = compressorMetaData->get<std::string>("id", "");
+
+      if (!compressor.empty() && compressor != "zlib" && compressor != "gzip")
+        mitkThrow() << "The Zarr compressor " << compressor << " is not supported.";
+
+      const std::string dataType = arrayMetaData.get<std::string>("dtype");
+      const PixelType pixelType = MakeZarrPixelType(dataType);
+      const bool swapBytes = dataType[0] == (IsLittleEndian() ? '>' : '<');
+      layout.ElementSize = pixelType.GetSize();
+
+      const double fillValue = arrayMetaData.get_optional<double>("fill_value").get_value_or(0.0);
+      const char separator = arrayMetaData.get<std::string>("dimension_separator", ".").front();
+
+      // dataset transformations are applied first, then the ones of the whole multiscale image
+      std::vector<double> scale(axes.size(), 1.0), translation(axes.size(), 0.0);
+      ReadCoordinateTransformations(dataset, scale, translation);
+
+      std::vector<double> globalScale(axes.size(), 1.0), globalTranslation(axes.size(), 0.0);
+      ReadCoordinateTransformations(multiscale, globalScale, globalTranslation);
+
+      if (scale.size() != axes.size() || translation.size() != axes.size() || globalScale.size() != axes.size() ||
+          globalTranslation.size() != axes.size())
+        mitkThrow() << "The coordinate transformations of " << path << " do not match its axes.";
+
+      // Only the axes t, (c), z, y, x in this order are supported, so that the memory layout of the Zarr array
+      // matches the one of the mitk::Image. A channel axis is only supported with a single channel.
+      const std::string axisOrder = "tczyx";
+      unsigned int dimensions[4] = {1, 1, 1, 1};
+      Vector3D spacing;
+      spacing.Fill(1.0);
+      Point3D origin;
+      origin.Fill(0.0);
+      TimePointType firstTimePoint = 0.0;
+      TimePointType stepDuration = 1.0;
+      bool hasZ = false;
+      std::size_t previousAxisPosition = 0;
+
+      for (std::size_t i = 0; i < axes.size(); ++i)
+      {
+        const std::size_t axisPosition = axisOrder.find(axes[i]);
+        if (axes[i].size() != 1 || axisPosition == std::string::npos ||
+            (i != 0 && axisPosition <= previousAxisPosition))
+        {
+          mitkThrow() << "The axes of " << path << " are not supported.";
+        }
+        previousAxisPosition = axisPosition;
+
+        const double axisScale = scale[i] * globalScale[i];
+        const double axisTranslation = translation[i] * globalScale[i] + globalTranslation[i];
+
+        if (axes[i] == "c")
+        {
+          if (layout.Shape[i] != 1)
+            mitkThrow() << "Multi-channel OME-Zarr images are not supported.";
+        }
+        else if (axes[i] == "t")
+        {
+          dimensions[3] = static_cast<unsigned int>(layout.Shape[i]);
+          firstTimePoint = axisTranslation;
+          if (axisScale > 0)
+            stepDuration = axisScale;
+        }
+        else
+        {
+          const unsigned int mitkAxis = static_cast<unsigned int>(axisOrder.size() - 1 - axisPosition);
+          dimensions[mitkAxis] = static_cast<unsigned int>(layout.Shape[i]);
+          spacing[mitkAxis] = axisScale > 0 ? axisScale : 1.0;
+          origin[mitkAxis] = axisTranslation;
+          hasZ = hasZ || mitkAxis == 2;
+        }
+      }
+
+      const unsigned int dimension = dimensions[3] > 1 ? 4 : (hasZ ? 3 : 2);
+
+      std::unique_ptr<char[]> buffer(new char[layout.GetNumberOfElements() * layout.ElementSize]);
+      Fill(buffer.get(), layout.GetNumberOfElements(), pixelType, fillValue);
+
+      // Only the chunks of the requested level are read, missing chunks contain the fill value only
+      const std::size_t chunkSize = layout.GetChunkSizeInBytes();
+      ParallelFor(layout.GetNumberOfChunks(), [&](std::size_t i) {
+        const std::vector<std::size_t> chunkIndex = layout.GetChunkIndex(i);
+        const std::string chunkPath = levelPath + '/' + GetChunkKey(chunkIndex, chunkIndex.size(), separator);
+        if (!itksys::SystemTools::FileExists(chunkPath))
+          return;
+
+        std::vector<char> data = ReadFile(chunkPath);
+        std::vector<char> chunk(chunkSize);
+
+        if (compressor.empty())
+        {
+          if (data.size() != chunkSize)
+            mitkThrow() << "Invalid chunk " << chunkPath;
+          chunk.swap(data);
+        }
+        else
+        {
+          Decompress(data, chunk.data(), chunk.size());
+        }
+
+        if (swapBytes)
+          SwapBytes(chunk.data(), chunk.size(), layout.ElementSize);
+
+        ForEachChunkRow(layout, chunkIndex, [&](std::size_t arrayOffset, std::size_t chunkOffset, std::size_t size) {
+          std::memcpy(buffer.get() + arrayOffset, chunk.data() + chunkOffset, size);
+        });
+      });
+
+      Image::Pointer image = Image::New();
+      image->Initialize(pixelType, dimension, dimensions);
+      image->SetImportChannel(buffer.release(), 0, Image::ManageMemory);
+
+      Matrix3D matrix;
+      matrix.SetIdentity();
+      auto mitkAttributes = attributes.get_child_optional("mitk");
+      if (mitkAttributes && mitkAttributes->get_child_optional("direction"))
+      {
+        const std::vector<double> direction = GetJsonArray<double>(*mitkAttributes, "direction");
+        if (direction.size() == 9)
+        {
+          for (unsigned int i = 0; i < 3; ++i)
+            for (unsigned int j = 0; j < 3; ++j)
+              matrix[i][j] = direction[3 * i + j];
+        }
+      }
+
+      PlaneGeometry *planeGeometry = image->GetSlicedGeometry(0)->GetPlaneGeometry(0);
+      planeGeometry->SetOrigin(origin);
+      planeGeometry->GetIndexToWorldTransform()->SetMatrix(matrix);
+
+      SlicedGeometry3D *slicedGeometry = image->GetSlicedGeometry(0);
+      slicedGeometry->InitializeEvenlySpaced(planeGeometry, image->GetDimension(2));
+      slicedGeometry->SetSpacing(spacing);
+
+      ProportionalTimeGeometry::Pointer timeGeometry = ProportionalTimeGeometry::New();
+      timeGeometry->Initialize(slicedGeometry, image->GetDimension(3));
+      timeGeometry->SetFirstTimePoint(firstTimePoint);
+      timeGeometry->SetStepDuration(stepDuration);
+      image->SetTimeGeometry(timeGeometry);
+
+      std::vector<BaseData::Pointer> result;
+      result.push_back(image.GetPointer());
+      return result;
+    }
+    catch (const boost::property_tree::ptree_error &e)
+    {
+      mitkThrow() << "Invalid OME-Zarr metadata in " << path << ": " << e.what();
+    }
+  }
+
+  IFileIO::ConfidenceLevel OmeZarrImageIO::GetReaderConfidenceLevel() const
+  {
+    // AbstractFileReader only accepts regular files, but a store is a directory
+    if (this->GetInputStream() != nullptr)
+      return Unsupported;
+
+    const std::string attributesPath = this->GetInputLocation() + "/.zattrs";
+    if (!itksys::SystemTools::FileExists(attributesPath))
+      return Unsupported;
+
+    try
+    {
+      return ReadJson(attributesPath).get_child_optional("multiscales") ? Supported : Unsupported;
+    }
+    catch (const boost::property_tree::ptree_error &)
+    {
+      return Unsupported;
+    }
+  }
+
+  void OmeZarrImageIO::Write()
+  {
+    this->ValidateOutputLocation();
+
+    const auto *image = dynamic_cast<const Image *>(this->GetInput());
+    if (image == nullptr)
+      mitkThrow() << "Cannot write non-image data";
+
+    const std::string dataType = GetZarrDataType(image->GetPixelType());
+    if (dataType.empty() || image->GetDimension() > 4)
+      mitkThrow() << "Only scalar images with up to four dimensions can be written as OME-Zarr.";
+
+    const std::string path = this->GetOutputLocation();
+    if (path.empty())
+      mitkThrow() << "OME-Zarr stores cannot be written to streams.";
+
+    LocaleSwitch localeSwitch("C");
+
+    const auto chunkSize = static_cast<std::size_t>(
+      std::max(1, us::any_cast<int>(this->GetWriterOption(OPTION_NAME_CHUNK_SIZE))));
+    const auto requestedLevels =
+      static_cast<unsigned int>(std::max(0, us::any_cast<int>(this->GetWriterOption(OPTION_NAME_RESOLUTION_LEVELS))));
+
+    PrepareStoreDirectory(path);
+
+    const BaseGeometry *geometry = image->GetGeometry();
+    const Vector3D spacing = geometry->GetSpacing();
+    const Point3D origin = geometry->GetOrigin();
+    const auto *timeGeometry = dynamic_cast<const ProportionalTimeGeometry *>(image->GetTimeGeometry());
+
+    // Set up the axes in Zarr order, e.g. t, z, y, x for a 3D+t image
+    const unsigned int numberOfAxes = image->GetDimension();
+    ArrayLayout layout;
+    layout.ElementSize = image->GetPixelType().GetSize();
+    std::vector<std::string> axisNames;
+    std::vector<bool> isSpatial;
+    std::vector<double> scale, translation;
+
+    for (unsigned int i = 0; i < numberOfAxes; ++i)
+    {
+      const unsigned int mitkAxis = numberOfAxes - 1 - i;
+      const bool spatial = mitkAxis < 3;
+
+      axisNames.push_back(AXIS_NAMES[4 - numberOfAxes + i]);
+      isSpatial.push_back(spatial);
+      layout.Shape.push_back(image->GetDimension(mitkAxis));
+      layout.Chunks.push_back(spatial ? std::min<std::size_t>(chunkSize, layout.Shape.back()) : 1);
+
+      if (spatial)
+      {
+        scale.push_back(spacing[mitkAxis]);
+        translation.push_back(origin[mitkAxis]);
+      }
+      else
+      {
+        scale.push_back(timeGeometry != nullptr ? timeGeometry->GetStepDuration() : 1.0);
+        translation.push_back(timeGeometry != nullptr ? timeGeometry->GetFirstTimePoint() : 0.0);
+      }
+    }
+
+    ImageReadAccessor imageAccess(image);
+    const char *data = static_cast<const char *>(imageAccess.GetData());
+    std::vector<char> levelData;
+    std::ostringstream datasets;
+
+    for (unsigned int level = 0;; ++level)
+    {
+      const std::string levelName = std::to_string(level);
+      WriteLevel(path + '/' + levelName, layout, data, dataType);
+
+      datasets << (level != 0 ? ",\n" : "") << "        {\"path\": \"" << levelName
+               << "\", \"coordinateTransformations\": [{\"type\": \"scale\", \"scale\": " << ToJsonArray(scale)
+               << "}, {\"type\": \"translation\", \"translation\": " << ToJsonArray(translation) << "}]}";
+
+      bool fitsIntoChunk = true;
+      bool isSingleVoxel = true;
+      for (std::size_t i = 0; i < numberOfAxes; ++i)
+      {
+        if (isSpatial[i])
+        {
+          fitsIntoChunk = fitsIntoChunk && layout.Shape[i] <= chunkSize;
+          isSingleVoxel = isSingleVoxel && layout.Shape[i] == 1;
+        }
+      }
+
+      const bool isLastLevel = requestedLevels != 0 ? level + 1 >= requestedLevels || isSingleVoxel
+                                                    : fitsIntoChunk || level + 1 >= MAX_NUMBER_OF_LEVELS;
+      if (isLastLevel)
+        break;
+
+      for (std::size_t i = 0; i < numberOfAxes; ++i)
+      {
+        if (isSpatial[i] && layout.Shape[i] > 1)
+          scale[i] *= 2.0;
+      }
+
+      std::vector<char> downsampledData = Downsample(data, layout, isSpatial);
+      levelData.swap(downsampledData);
+      data = levelData.data();
+
+      for (std::size_t i = 0; i < numberOfAxes; ++i)
+      {
+        if (isSpatial[i])
+          layout.Chunks[i] = std::min<std::size_t>(chunkSize, layout.Shape[i]);
+      }
+    }
+
+    std::ostringstream axes;
+    for (unsigned int i = 0; i < numberOfAxes; ++i)
+    {
+      axes << (i != 0 ? ", " : "") << "{\"name\": \"" << axisNames[i] << "\", \"type\": \""
+           << (isSpatial[i] ? "space\", \"unit\": \"millimeter\"}" : "time\", \"unit\": \"millisecond\"}");
+    }
+
+    // OME-Zarr 0.4 has no rotations, so the direction of the image is stored as additional attribute
+    const auto &matrix = geometry->GetIndexToWorldTransform()->GetMatrix();
+    std::vector<double> direction;
+    for (unsigned int i = 0; i < 3; ++i)
+      for (unsigned int j = 0; j < 3; ++j)
+        direction.push_back(matrix[i][j] / spacing[j]);
+
+    std::ostringstream attributes;
+    attributes << "{\n"
+               << "  \"multiscales\": [\n"
+               << "    {\n"
+               << "      \"version\": \"0.4\",\n"
+               << "      \"name\": \"" << itksys::SystemTools::GetFilenameWithoutExtension(path) << "\",\n"
+               << "      \"type\": \"nearest\",\n"
+               << "      \"axes\": [" << axes.str() << "],\n"
+               << "      \"datasets\": [\n"
+               << datasets.str() << "\n"
+               << "      ]\n"
+               << "    }\n"
+               << "  ],\n"
+               << "  \"mitk\": {\"direction\": " << ToJsonArray(direction) << "}\n"
+               << "}\n";
+
+    const std::string group = "{\n  \"zarr_format\": 2\n}\n";
+    const std::string attributesString = attributes.str();
+    WriteFile(path + "/.zgroup", group.data(), group.size());
+    WriteFile(path + "/.zattrs", attributesString.data(), attributesString.size());
+  }
+
+  IFileIO::ConfidenceLevel OmeZarrImageIO::GetWriterConfidenceLevel() const
+  {
+    if (AbstractFileIO::GetWriterConfidenceLevel() == Unsupported)
+      return Unsupported;
+
+    const auto *image = dynamic_cast<const Image *>(this->GetInput());
+    if (image == nullptr || image->GetDimension() > 4 || GetZarrDataType(image->GetPixelType()).empty())
+      return Unsupported;
+
+    return Supported;
+  }
+
+  OmeZarrImageIO *OmeZarrImageIO::IOClone() const { return new OmeZarrImageIO(*this); }
+}
@@ -0,0 +1,59 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkOmeZarrImageIO_h
+#define mitkOmeZarrImageIO_h
+
+#include <mitkAbstractFileIO.h>
+
+namespace mitk
+{
+  /**
+   * @brief Reads and writes scalar images as OME-Zarr (NGFF 0.4) multi-resolution stores.
+   *
+   * A store is a directory (e.g. "image.ome.zarr") containing one Zarr v2 array per resolution level. Each array is
+   * split into zlib compressed chunks, which are stored as separate files ("0/t/z/y/x"). Since every chunk is an
+   * independent object, object storages and viewers can fetch only the chunks and the level they need.
+   *
+   * Writer options:
+   * - "Chunk size": the edge length of the (cubic) chunks in voxels.
+   * - "Resolution levels": the number of levels, 0 adds levels (each one downsampled by 2) until a level fits
+   *   into a single chunk.
+   *
+   * Reader options:
+   * - "Resolution level": the level that is read, 0 is the full resolution.
+   *
+   * The direction of the image, which cannot be represented in OME-Zarr 0.4, is stored as "mitk" attribute.
+   *
+   * @ingroup IOExt
+   */
+  class OmeZarrImageIO : public AbstractFileIO
+  {
+  public:
+    OmeZarrImageIO();
+
+    using AbstractFileReader::Read;
+    std::vector<itk::SmartPointer<BaseData>> Read() override;
+    ConfidenceLevel GetReaderConfidenceLevel() const override;
+
+    using AbstractFileWriter::Write;
+    void Write() override;
+    ConfidenceLevel GetWriterConfidenceLevel() const override;
+
+  private:
+    OmeZarrImageIO(const OmeZarrImageIO &other);
+
+    OmeZarrImageIO *IOClone() const override;
+  };
+}
+
+#endif
@@ -1,3 +1,4 @@
 set(MODULE_TESTS
+  itkFastBilateralImageFilterTest.cpp
   itkTotalVariationDenoisingImageFilterTest.cpp
 )
@@ -0,0 +1,120 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "itkFastBilateralImageFilter.h"
+#include "itkImageRegionIterator.h"
+
+#include <cmath>
+
+typedef itk::Image<float, 2> ImageType;
+typedef itk::ImageRegionIterator<ImageType> IteratorType;
+
+/**
+* 32x32 step image (0 on the left, 100 on the right) with a small, deterministic noise pattern
+*/
+static ImageType::Pointer GenerateTestImage(float noiseAmplitude)
+{
+  ImageType::Pointer image = ImageType::New();
+
+  ImageType::RegionType largestPossibleRegion;
+  ImageType::SizeType size = {{32, 32}};
+  largestPossibleRegion.SetSize(size);
+  image->SetRegions(largestPossibleRegion);
+  image->Allocate();
+
+  IteratorType it(image, largestPossibleRegion);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    const float noise = noiseAmplitude * (((index[0] * 7 + index[1] * 13) % 5) - 2);
+    it.Set((index[0] < 16 ? 0.0f : 100.0f) + noise);
+  }
+
+  return image;
+}
+
+static double SquaredDeviation(ImageType *image, float mean, long firstColumn, long lastColumn)
+{
+  double deviation = 0;
+  for (long y = 4; y < 28; ++y)
+  {
+    for (long x = firstColumn; x <= lastColumn; ++x)
+    {
+      ImageType::IndexType index = {{x, y}};
+      deviation += (image->GetPixel(index) - mean) * (image->GetPixel(index) - mean);
+    }
+  }
+  return deviation;
+}
+
+int itkFastBilateralImageFilterTest(int /*argc*/, char * /*argv*/ [])
+{
+  typedef itk::FastBilateralImageFilter<ImageType, ImageType> FilterType;
+
+  try
+  {
+    // a constant image is not changed
+    FilterType::Pointer filter = FilterType::New();
+    filter->SetInput(GenerateTestImage(0.0f));
+    filter->SetDomainSigma(2.0);
+    filter->SetRangeSigma(20.0);
+    filter->Update();
+
+    ImageType::Pointer noiseFreeImage = GenerateTestImage(0.0f);
+    IteratorType expectedIt(noiseFreeImage, noiseFreeImage->GetLargestPossibleRegion());
+    IteratorType outputIt(filter->GetOutput(), noiseFreeImage->GetLargestPossibleRegion());
+    for (; !outputIt.IsAtEnd(); ++outputIt, ++expectedIt)
+    {
+      // the steps are 100 intensities, i.e. five range sigmas, high
+      if (std::fabs(outputIt.Get() - expectedIt.Get()) > 0.5)
+        return EXIT_FAILURE;
+    }
+  }
+  catch (...)
+  {
+    return EXIT_FAILURE;
+  }
+
+  try
+  {
+    // the noise is reduced, but the edge is preserved
+    ImageType::Pointer image = GenerateTestImage(2.0f);
+
+    FilterType::Pointer filter = FilterType::New();
+    filter->SetInput(image);
+    filter->SetDomainSigma(2.0);
+    filter->SetRangeSigma(20.0);
+    filter->SetNumberOfThreads(2);
+    filter->Update();
+    ImageType::Pointer output = filter->GetOutput();
+
+    if (SquaredDeviation(output, 0.0f, 2, 13) > 0.25 * SquaredDeviation(image, 0.0f, 2, 13) ||
+        SquaredDeviation(output, 100.0f, 18, 29) > 0.25 * SquaredDeviation(image, 100.0f, 18, 29))
+    {
+      return EXIT_FAILURE;
+    }
+
+    for (long y = 0; y < 32; ++y)
+    {
+      ImageType::IndexType left = {{15, y}};
+      ImageType::IndexType right = {{16, y}};
+      if (std::fabs(output->GetPixel(left)) > 5.0 || std::fabs(output->GetPixel(right) - 100.0) > 5.0)
+        return EXIT_FAILURE;
+    }
+  }
+  catch (...)
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
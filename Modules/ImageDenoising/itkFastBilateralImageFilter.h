@@ -0,0 +1,112 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef __itkFastBilateralImageFilter_h
+#define __itkFastBilateralImageFilter_h
+
+#include "itkImage.h"
+#include "itkImageToImageFilter.h"
+
+namespace itk
+{
+  /** \class FastBilateralImageFilter
+   * \brief Approximates a bilateral filter with a cost independent of the domain sigma
+   *
+   * The intensity range of the image is sampled at levels which are RangeSigma apart. For every level the range
+   * weights of all pixels and the weighted intensities are smoothed with a recursive gaussian of DomainSigma, and
+   * the quotient is the bilateral filter response of all pixels with exactly that intensity. The output is
+   * interpolated linearly between the responses of the two levels next to the pixel's intensity. This equals a
+   * bilateral grid which is not downsampled in the spatial domain.
+   *
+   * The cost is proportional to the number of pixels times the number of levels, i.e. the intensity range
+   * divided by RangeSigma, but it does not depend on DomainSigma (the brute force BilateralImageFilter scales with
+   * the kernel volume). Both sigmas are used like in itk::BilateralImageFilter: the domain sigma in physical
+   * units, the range sigma in intensity units.
+   *
+   * Reference: Fredo Durand and Julie Dorsey, Fast bilateral filtering for the display of high-dynamic-range
+   * images
+   *
+   * \sa BilateralImageFilter
+   *
+   * \ingroup IntensityImageFilters
+   */
+  template <class TInputImage, class TOutputImage>
+  class FastBilateralImageFilter : public ImageToImageFilter<TInputImage, TOutputImage>
+  {
+  public:
+    /** Extract dimension from input and output image. */
+    itkStaticConstMacro(InputImageDimension, unsigned int, TInputImage::ImageDimension);
+    itkStaticConstMacro(OutputImageDimension, unsigned int, TOutputImage::ImageDimension);
+
+    /** Convenient typedefs for simplifying declarations. */
+    typedef TInputImage InputImageType;
+    typedef TOutputImage OutputImageType;
+
+    /** Standard class typedefs. */
+    typedef FastBilateralImageFilter Self;
+    typedef ImageToImageFilter<InputImageType, OutputImageType> Superclass;
+    typedef SmartPointer<Self> Pointer;
+    typedef SmartPointer<const Self> ConstPointer;
+
+    /** Method for creation through the object factory. */
+    itkFactorylessNewMacro(Self);
+    itkCloneMacro(Self);
+
+    /** Run-time type information (and related methods). */
+    itkTypeMacro(FastBilateralImageFilter, ImageToImageFilter);
+
+    /** Image typedef support. */
+    typedef typename InputImageType::PixelType InputPixelType;
+    typedef typename OutputImageType::PixelType OutputPixelType;
+
+    typedef itk::Image<float, InputImageDimension> RealImageType;
+
+    itkSetMacro(DomainSigma, double);
+    itkGetMacro(DomainSigma, double);
+
+    itkSetMacro(RangeSigma, double);
+    itkGetMacro(RangeSigma, double);
+
+    /** The whole input is needed, since the smoothing is applied to complete images. */
+    void GenerateInputRequestedRegion() override;
+
+  protected:
+    FastBilateralImageFilter();
+    ~FastBilateralImageFilter() override {}
+    void PrintSelf(std::ostream &os, Indent indent) const override;
+
+    void EnlargeOutputRequestedRegion(DataObject *output) override;
+
+    void GenerateData() override;
+
+    /** Calls function(begin, end) for consecutive ranges of [0, size), distributed over GetNumberOfThreads()
+    threads.
+    */
+    template <class TFunction>
+    void ParallelFor(SizeValueType size, TFunction function);
+
+    double m_DomainSigma;
+
+    double m_RangeSigma;
+
+  private:
+    FastBilateralImageFilter(const Self &); // purposely not implemented
+    void operator=(const Self &);           // purposely not implemented
+  };
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkFastBilateralImageFilter.txx"
+#endif
+
+#endif //__itkFastBilateralImageFilter_h
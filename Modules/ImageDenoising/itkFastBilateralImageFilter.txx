@@ -0,0 +1,196 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef _itkFastBilateralImageFilter_txx
+#define _itkFastBilateralImageFilter_txx
+
+#include "itkFastBilateralImageFilter.h"
+
+#include "itkCastImageFilter.h"
+#include "itkSmoothingRecursiveGaussianImageFilter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace itk
+{
+  template <class TInputImage, class TOutputImage>
+  FastBilateralImageFilter<TInputImage, TOutputImage>::FastBilateralImageFilter()
+    : m_DomainSigma(4.0), m_RangeSigma(50.0)
+  {
+  }
+
+  template <class TInputImage, class TOutputImage>
+  void FastBilateralImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+  {
+    Superclass::GenerateInputRequestedRegion();
+
+    auto *input = const_cast<InputImageType *>(this->GetInput());
+    if (input != nullptr)
+      input->SetRequestedRegionToLargestPossibleRegion();
+  }
+
+  template <class TInputImage, class TOutputImage>
+  void FastBilateralImageFilter<TInputImage, TOutputImage>::EnlargeOutputRequestedRegion(DataObject *output)
+  {
+    Superclass::EnlargeOutputRequestedRegion(output);
+    output->SetRequestedRegionToLargestPossibleRegion();
+  }
+
+  template <class TInputImage, class TOutputImage>
+  template <class TFunction>
+  void FastBilateralImageFilter<TInputImage, TOutputImage>::ParallelFor(SizeValueType size, TFunction function)
+  {
+    const SizeValueType chunkSize = 1 << 16;
+    const SizeValueType numberOfChunks = (size + chunkSize - 1) / chunkSize;
+    std::atomic<SizeValueType> nextChunk(0);
+
+    auto worker = [&]() {
+      for (SizeValueType chunk = nextChunk++; chunk < numberOfChunks; chunk = nextChunk++)
+        function(chunk * chunkSize, std::min(size, (chunk + 1) * chunkSize));
+    };
+
+    const SizeValueType numberOfThreads =
+      std::min<SizeValueType>(std::max(1, static_cast<int>(this->GetNumberOfThreads())), numberOfChunks);
+    std::vector<std::thread> threads;
+    for (SizeValueType i = 1; i < numberOfThreads; ++i)
+      threads.emplace_back(worker);
+    worker();
+
+    for (auto &thread : threads)
+      thread.join();
+  }
+
+  template <class TInputImage, class TOutputImage>
+  void FastBilateralImageFilter<TInputImage, TOutputImage>::GenerateData()
+  {
+    this->AllocateOutputs();
+
+    typedef CastImageFilter<InputImageType, RealImageType> CastType;
+    typename CastType::Pointer castFilter = CastType::New();
+    castFilter->SetInput(this->GetInput());
+    castFilter->Update();
+    typename RealImageType::Pointer image = castFilter->GetOutput();
+
+    const SizeValueType numberOfPixels = image->GetBufferedRegion().GetNumberOfPixels();
+    const float *intensities = image->GetBufferPointer();
+    OutputPixelType *output = this->GetOutput()->GetBufferPointer();
+
+    if (numberOfPixels == 0)
+      return;
+
+    const auto range = std::minmax_element(intensities, intensities + numberOfPixels);
+    const double minimum = *range.first;
+    const double maximum = *range.second;
+
+    if (!(maximum > minimum) || !(m_RangeSigma > 0))
+    {
+      // nothing is smoothed across an edge of zero height
+      for (SizeValueType i = 0; i < numberOfPixels; ++i)
+        output[i] = static_cast<OutputPixelType>(intensities[i]);
+      return;
+    }
+
+    // the intensity levels, the step is at most the range sigma
+    const auto numberOfLevels = static_cast<unsigned int>(std::ceil((maximum - minimum) / m_RangeSigma)) + 1;
+    const double levelStep = (maximum - minimum) / (numberOfLevels - 1);
+    const double rangeFactor = -0.5 / (m_RangeSigma * m_RangeSigma);
+
+    // range weights and weighted intensities of the current level
+    typename RealImageType::Pointer weights = RealImageType::New();
+    weights->CopyInformation(image);
+    weights->SetRegions(image->GetBufferedRegion());
+    weights->Allocate();
+
+    typename RealImageType::Pointer weightedIntensities = RealImageType::New();
+    weightedIntensities->CopyInformation(image);
+    weightedIntensities->SetRegions(image->GetBufferedRegion());
+    weightedIntensities->Allocate();
+
+    typedef SmoothingRecursiveGaussianImageFilter<RealImageType, RealImageType> SmoothingType;
+    typename SmoothingType::Pointer weightsSmoothing = SmoothingType::New();
+    weightsSmoothing->SetInput(weights);
+    weightsSmoothing->SetSigma(m_DomainSigma);
+    weightsSmoothing->SetNumberOfThreads(this->GetNumberOfThreads());
+
+    typename SmoothingType::Pointer weightedIntensitiesSmoothing = SmoothingType::New();
+    weightedIntensitiesSmoothing->SetInput(weightedIntensities);
+    weightedIntensitiesSmoothing->SetSigma(m_DomainSigma);
+    weightedIntensitiesSmoothing->SetNumberOfThreads(this->GetNumberOfThreads());
+
+    std::vector<float> result(numberOfPixels, 0.0f);
+
+    for (unsigned int level = 0; level < numberOfLevels; ++level)
+    {
+      const double levelIntensity = minimum + level * levelStep;
+
+      float *weightsBuffer = weights->GetBufferPointer();
+      float *weightedIntensitiesBuffer = weightedIntensities->GetBufferPointer();
+
+      this->ParallelFor(numberOfPixels, [&](SizeValueType begin, SizeValueType end) {
+        for (SizeValueType i = begin; i < end; ++i)
+        {
+          const double difference = intensities[i] - levelIntensity;
+          const double weight = std::exp(rangeFactor * difference * difference);
+          weightsBuffer[i] = weight;
+          weightedIntensitiesBuffer[i] = weight * intensities[i];
+        }
+      });
+
+      weights->Modified();
+      weightedIntensities->Modified();
+      weightsSmoothing->Update();
+      weightedIntensitiesSmoothing->Update();
+
+      const float *smoothedWeights = weightsSmoothing->GetOutput()->GetBufferPointer();
+      const float *smoothedWeightedIntensities = weightedIntensitiesSmoothing->GetOutput()->GetBufferPointer();
+
+      // add the response of this level, weighted by the linear interpolation between the adjacent levels
+      this->ParallelFor(numberOfPixels, [&](SizeValueType begin, SizeValueType end) {
+        for (SizeValueType i = begin; i < end; ++i)
+        {
+          const double interpolationWeight = 1.0 - std::abs(intensities[i] - levelIntensity) / levelStep;
+          if (interpolationWeight <= 0)
+            continue;
+
+          const double response = smoothedWeights[i] > 1e-10 ? smoothedWeightedIntensities[i] / smoothedWeights[i]
+                                                              : static_cast<double>(intensities[i]);
+          result[i] += interpolationWeight * response;
+        }
+      });
+
+      this->UpdateProgress(static_cast<float>(level + 1) / numberOfLevels);
+    }
+
+    this->ParallelFor(numberOfPixels, [&](SizeValueType begin, SizeValueType end) {
+      for (SizeValueType i = begin; i < end; ++i)
+        output[i] = static_cast<OutputPixelType>(result[i]);
+    });
+  }
+
+  /**
+  * Standard "PrintSelf" method
+  */
+  template <class TInputImage, class TOutput>
+  void FastBilateralImageFilter<TInputImage, TOutput>::PrintSelf(std::ostream &os, Indent indent) const
+  {
+    Superclass::PrintSelf(os, indent);
+    os << indent << "DomainSigma: " << m_DomainSigma << std::endl;
+    os << indent << "RangeSigma: " << m_RangeSigma << std::endl;
+  }
+
+} // end namespace itk
+
+#endif
@@ -25,6 +25,11 @@ namespace itk
    *
    * Reference: Tony F. Chan et al., The digital TV filter and nonlinear denoising
    *
+   * All iterations run on two buffers which are allocated once and used alternately as input and output of an
+   * iteration (the local variation is kept in a third buffer). Both steps of an iteration traverse the image
+   * row by row, with the neighbor rows resolved once per row, and the rows are distributed over
+   * GetNumberOfThreads() threads. The result is the same as chaining TotalVariationSingleIterationImageFilter.
+   *
    * \sa Image
    * \sa Neighborhood
    * \sa NeighborhoodOperator
@@ -83,6 +88,26 @@ namespace itk
 
     void GenerateData() override;
 
+    typedef typename OutputImageType::SizeType OutputSizeType;
+
+    /** Computes the local variation of all pixels of image, see LocalVariationImageFilter. */
+    void ComputeLocalVariation(const OutputPixelType *image, const OutputSizeType &size, float *localVariation);
+
+    /** Computes one iteration of the digital TV filter from image into result. */
+    void ComputeIteration(const OutputPixelType *image,
+                          const OutputPixelType *original,
+                          const float *localVariation,
+                          const OutputSizeType &size,
+                          OutputPixelType *result);
+
+    /** Calls rowFunction(rowOffset, neighborRowOffsets) for all rows (along the first dimension) of an image of
+    the given size, distributed over GetNumberOfThreads() threads. neighborRowOffsets holds the offsets of the rows
+    preceding and following the row in the other dimensions (2 * (dimension - 1) values), at the image border the
+    offset of the row itself is used (zero flux Neumann boundary condition).
+    */
+    template <class TRowFunction>
+    void ForEachRow(const OutputSizeType &size, TRowFunction rowFunction);
+
     double m_Lambda;
 
     int m_NumberIterations;
@@ -30,6 +30,9 @@ This file is based heavily on a corresponding ITK filter.
 #include "itkZeroFluxNeumannBoundaryCondition.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
 #include <vector>
 
 namespace itk
@@ -43,54 +46,203 @@ namespace itk
   template <class TInputImage, class TOutputImage>
   void TotalVariationDenoisingImageFilter<TInputImage, TOutputImage>::GenerateData()
   {
-    // first we cast the input image to match output type
+    // first we cast the input image to match output type, it is kept as reference
     typename CastType::Pointer infilter = CastType::New();
     infilter->SetInput(this->GetInput());
     infilter->Update();
-    typename TOutputImage::Pointer image = infilter->GetOutput();
-
-    // a second copy of the input image is saved as reference
-    infilter = CastType::New();
-    infilter->SetInput(this->GetInput());
-    infilter->Update();
     typename TOutputImage::Pointer origImage = infilter->GetOutput();
 
-    typename SingleIterationFilterType::Pointer filter;
-    for (int i = 0; i < m_NumberIterations; i++)
-    {
-      filter = SingleIterationFilterType::New();
-      filter->SetInput(image);
-      filter->SetOriginalImage(origImage);
-      filter->SetLambda(m_Lambda);
-      filter->SetNumberOfThreads(this->GetNumberOfThreads());
-      filter->UpdateLargestPossibleRegion();
-      image = filter->GetOutput();
-      std::cout << "Iteration " << i + 1 << "/" << m_NumberIterations << std::endl;
-    }
+    const OutputImageRegionType region = origImage->GetLargestPossibleRegion();
+    const OutputSizeType size = region.GetSize();
+    const SizeValueType numberOfPixels = region.GetNumberOfPixels();
 
     typename OutputImageType::Pointer output = this->GetOutput();
-    output->SetSpacing(image->GetSpacing());
-    typename OutputImageType::RegionType largestPossibleRegion;
-    largestPossibleRegion.SetSize(image->GetLargestPossibleRegion().GetSize());
-    largestPossibleRegion.SetIndex(image->GetLargestPossibleRegion().GetIndex());
-    output->SetLargestPossibleRegion(image->GetLargestPossibleRegion());
-    output->SetBufferedRegion(image->GetLargestPossibleRegion());
+    output->SetLargestPossibleRegion(region);
+    output->SetBufferedRegion(region);
+    output->SetRequestedRegion(region);
     output->Allocate();
 
-    itk::ImageRegionIterator<OutputImageType> oit(output, output->GetLargestPossibleRegion());
-    oit.GoToBegin();
+    if (numberOfPixels == 0)
+      return;
 
-    itk::ImageRegionConstIterator<OutputImageType> iit(image, image->GetLargestPossibleRegion());
-    iit.GoToBegin();
+    // the iterations alternate between the output and a second buffer, the last one writes into the output
+    std::vector<OutputPixelType> temporaryBuffer(numberOfPixels);
+    std::vector<float> localVariation(numberOfPixels);
 
-    while (!oit.IsAtEnd())
+    OutputPixelType *outputBuffer = output->GetBufferPointer();
+    OutputPixelType *current = m_NumberIterations % 2 == 0 ? outputBuffer : temporaryBuffer.data();
+    OutputPixelType *next = current == outputBuffer ? temporaryBuffer.data() : outputBuffer;
+
+    const OutputPixelType *original = origImage->GetBufferPointer();
+    std::copy(original, original + numberOfPixels, current);
+
+    for (int i = 0; i < m_NumberIterations; i++)
     {
-      oit.Set(iit.Get());
-      ++iit;
-      ++oit;
+      this->ComputeLocalVariation(current, size, localVariation.data());
+      this->ComputeIteration(current, original, localVariation.data(), size, next);
+      std::swap(current, next);
+      this->UpdateProgress(static_cast<float>(i + 1) / m_NumberIterations);
     }
   }
 
+  template <class TInputImage, class TOutputImage>
+  template <class TRowFunction>
+  void TotalVariationDenoisingImageFilter<TInputImage, TOutputImage>::ForEachRow(const OutputSizeType &size,
+                                                                               TRowFunction rowFunction)
+  {
+    const unsigned int dimension = OutputImageDimension;
+
+    SizeValueType strides[OutputImageDimension];
+    strides[0] = 1;
+    for (unsigned int d = 1; d < dimension; ++d)
+      strides[d] = strides[d - 1] * size[d - 1];
+
+    const SizeValueType numberOfRows = strides[dimension - 1] * size[dimension - 1] / size[0];
+    const SizeValueType rowsPerTask = 16;
+    const SizeValueType numberOfTasks = (numberOfRows + rowsPerTask - 1) / rowsPerTask;
+    std::atomic<SizeValueType> nextTask(0);
+
+    auto worker = [&]() {
+      std::vector<SizeValueType> neighborRowOffsets(2 * (dimension - 1) + 1);
+
+      for (SizeValueType task = nextTask++; task < numberOfTasks; task = nextTask++)
+      {
+        const SizeValueType endRow = std::min(numberOfRows, (task + 1) * rowsPerTask);
+        for (SizeValueType row = task * rowsPerTask; row < endRow; ++row)
+        {
+          const SizeValueType rowOffset = row * size[0];
+
+          // minus neighbors from the last dimension down, plus neighbors upwards (the order of
+          // ConstShapedNeighborhoodIterator)
+          SizeValueType remainder = row;
+          for (unsigned int d = 1; d < dimension; ++d)
+          {
+            const SizeValueType index = remainder % size[d];
+            remainder /= size[d];
+            neighborRowOffsets[dimension - 1 - d] = index > 0 ? rowOffset - strides[d] : rowOffset;
+            neighborRowOffsets[dimension - 2 + d] = index + 1 < size[d] ? rowOffset + strides[d] : rowOffset;
+          }
+
+          rowFunction(rowOffset, neighborRowOffsets.data());
+        }
+      }
+    };
+
+    const SizeValueType numberOfThreads =
+      std::min<SizeValueType>(std::max(1, static_cast<int>(this->GetNumberOfThreads())), numberOfTasks);
+    std::vector<std::thread> threads;
+    for (SizeValueType i = 1; i < numberOfThreads; ++i)
+      threads.emplace_back(worker);
+    worker();
+
+    for (auto &thread : threads)
+      thread.join();
+  }
+
+  template <class TInputImage, class TOutputImage>
+  void TotalVariationDenoisingImageFilter<TInputImage, TOutputImage>::ComputeLocalVariation(
+    const OutputPixelType *image, const OutputSizeType &size, float *localVariation)
+  {
+    const unsigned int numberOfRowNeighbors = 2 * (OutputImageDimension - 1);
+    const auto width = static_cast<long>(size[0]);
+
+    this->ForEachRow(size, [&](SizeValueType rowOffset, const SizeValueType *neighborRowOffsets) {
+      const OutputPixelType *row = image + rowOffset;
+      const OutputPixelType *neighborRows[2 * OutputImageDimension];
+      for (unsigned int k = 0; k < numberOfRowNeighbors; ++k)
+        neighborRows[k] = image + neighborRowOffsets[k];
+
+      float *result = localVariation + rowOffset;
+
+      for (long x = 0; x < width; ++x)
+      {
+        const OutputPixelType &center = row[x];
+
+        float locVariation = 0;
+        for (unsigned int k = 0; k < numberOfRowNeighbors / 2; ++k)
+          locVariation += SquaredEuclideanMetric<OutputPixelType>::Calc(neighborRows[k][x] - center);
+
+        // the neighbors outside of the row are the pixel itself and do not contribute
+        if (x > 0)
+          locVariation += SquaredEuclideanMetric<OutputPixelType>::Calc(row[x - 1] - center);
+        if (x + 1 < width)
+          locVariation += SquaredEuclideanMetric<OutputPixelType>::Calc(row[x + 1] - center);
+
+        for (unsigned int k = numberOfRowNeighbors / 2; k < numberOfRowNeighbors; ++k)
+          locVariation += SquaredEuclideanMetric<OutputPixelType>::Calc(neighborRows[k][x] - center);
+
+        result[x] = sqrt(locVariation + 0.0001);
+      }
+    });
+  }
+
+  template <class TInputImage, class TOutputImage>
+  void TotalVariationDenoisingImageFilter<TInputImage, TOutputImage>::ComputeIteration(const OutputPixelType *image,
+                                                                                      const OutputPixelType *original,
+                                                                                      const float *localVariation,
+                                                                                      const OutputSizeType &size,
+                                                                                      OutputPixelType *result)
+  {
+    const unsigned int numberOfRowNeighbors = 2 * (OutputImageDimension - 1);
+    const auto width = static_cast<long>(size[0]);
+    const double lambda = m_Lambda;
+
+    this->ForEachRow(size, [&](SizeValueType rowOffset, const SizeValueType *neighborRowOffsets) {
+      const OutputPixelType *neighborRows[2 * OutputImageDimension];
+      const float *neighborLocalVariations[2 * OutputImageDimension];
+
+      const OutputPixelType *row = image + rowOffset;
+      const float *localVariationRow = localVariation + rowOffset;
+      const OutputPixelType *originalRow = original + rowOffset;
+      OutputPixelType *resultRow = result + rowOffset;
+
+      double ws[2 * OutputImageDimension];
+
+      for (long x = 0; x < width; ++x)
+      {
+        // neighbors in the order of ConstShapedNeighborhoodIterator, at the border the pixel itself
+        const long previous = x > 0 ? x - 1 : x;
+        const long following = x + 1 < width ? x + 1 : x;
+
+        unsigned int count = 0;
+        for (unsigned int k = 0; k < numberOfRowNeighbors / 2; ++k, ++count)
+        {
+          neighborRows[count] = image + neighborRowOffsets[k] + x;
+          neighborLocalVariations[count] = localVariation + neighborRowOffsets[k] + x;
+        }
+        neighborRows[count] = row + previous;
+        neighborLocalVariations[count++] = localVariationRow + previous;
+        neighborRows[count] = row + following;
+        neighborLocalVariations[count++] = localVariationRow + following;
+        for (unsigned int k = numberOfRowNeighbors / 2; k < numberOfRowNeighbors; ++k, ++count)
+        {
+          neighborRows[count] = image + neighborRowOffsets[k] + x;
+          neighborLocalVariations[count] = localVariation + neighborRowOffsets[k] + x;
+        }
+
+        //   1 / ||nabla_alpha(u)||_a
+        const double locvar_alpha_inv = 1.0 / localVariationRow[x];
+
+        // w_alphabeta(u) = 1 / ||nabla_alpha(u)||_a + 1 / ||nabla_beta(u)||_a
+        double wsum = 0;
+        for (unsigned int k = 0; k < count; ++k)
+        {
+          ws[k] = locvar_alpha_inv + (1.0 / (double)*neighborLocalVariations[k]);
+          wsum += ws[k];
+        }
+
+        // h_alphaalpha * u_alpha^zero
+        OutputPixelType res = static_cast<OutputPixelType>(originalRow[x] * (lambda / (lambda + wsum)));
+
+        // add the different h_alphabeta * u_beta
+        for (unsigned int k = 0; k < count; ++k)
+          res += *neighborRows[k] * (ws[k] / (lambda + wsum));
+
+        resultRow[x] = res;
+      }
+    });
+  }
+
   /**
   * Standard "PrintSelf" method
   */
@@ -14,9 +14,10 @@ found in the LICENSE file.
 #include "mitkImageAccessByItk.h"
 #include "mitkImageCast.h"
 #include <itkBilateralImageFilter.h>
+#include <itkFastBilateralImageFilter.h>
 
 mitk::BilateralFilter::BilateralFilter()
-  : m_DomainSigma(2.0f), m_RangeSigma(50.0f), m_AutoKernel(true), m_KernelRadius(1u)
+  : m_DomainSigma(2.0f), m_RangeSigma(50.0f), m_AutoKernel(true), m_KernelRadius(1u), m_Mode(BruteForceMode)
 {
   // default parameters DomainSigma: 2 , RangeSigma: 50, AutoKernel: true, KernelRadius: 1
 }
@@ -62,6 +63,20 @@ void mitk::BilateralFilter::ItkImageProcessing(const itk::Image<TPixel, VImageDi
 {
   // ITK Image type given from the input image
   typedef itk::Image<TPixel, VImageDimension> ItkImageType;
+
+  if (m_Mode == FastMode)
+  {
+    typedef itk::FastBilateralImageFilter<ItkImageType, ItkImageType> FastBilateralFilterType;
+    typename FastBilateralFilterType::Pointer fastBilateralFilter = FastBilateralFilterType::New();
+    fastBilateralFilter->SetInput(itkImage);
+    fastBilateralFilter->SetDomainSigma(m_DomainSigma);
+    fastBilateralFilter->SetRangeSigma(m_RangeSigma);
+    fastBilateralFilter->UpdateLargestPossibleRegion();
+    mitk::Image::Pointer resultImage = this->GetOutput();
+    mitk::CastToMitkImage(fastBilateralFilter->GetOutput(), resultImage);
+    return;
+  }
+
   // bilateral filter with same type
   typedef itk::BilateralImageFilter<ItkImageType, ItkImageType> BilateralFilterType;
   typename BilateralFilterType::Pointer bilateralFilter = BilateralFilterType::New();
@@ -27,6 +27,20 @@ namespace mitk
     mitkClassMacro(BilateralFilter, ImageToImageFilter);
     itkFactorylessNewMacro(Self);
     itkCloneMacro(Self);
+
+    /*!
+    \brief BruteForceMode uses itk::BilateralImageFilter, whose cost grows with the kernel volume. FastMode uses
+    the approximation of itk::FastBilateralImageFilter, whose cost does not depend on the domain sigma but on the
+    intensity range divided by the range sigma. AutoKernel and KernelRadius only apply to BruteForceMode.
+    */
+    enum FilterMode
+    {
+      BruteForceMode,
+      FastMode
+    };
+
+    itkSetMacro(Mode, FilterMode);
+    itkGetMacro(Mode, FilterMode);
     itkSetMacro(DomainSigma, float);
     itkSetMacro(RangeSigma, float);
     itkSetMacro(AutoKernel, bool);
@@ -67,6 +81,7 @@ namespace mitk
     float m_RangeSigma;  /// Sigma of the range mask kernel. See ITK docu
     bool m_AutoKernel;   // true: kernel size is calculated from DomainSigma. See ITK Doc; false: set by m_KernelRadius
     unsigned int m_KernelRadius; // use in combination with m_AutoKernel = true
+    FilterMode m_Mode;           // BruteForceMode (default) or FastMode
   };
 } // END mitk namespace
 #endif
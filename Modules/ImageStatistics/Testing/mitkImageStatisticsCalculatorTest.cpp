@@ -20,6 +20,8 @@ found in the LICENSE file.
 #include <mitkPlanarFigureMaskGenerator.h>
 #include <mitkImageMaskGenerator.h>
 #include <mitkImageStatisticsConstants.h>
+#include <mitkITKImageImport.h>
+#include <mitkImagePixelWriteAccessor.h>
 
 /**
  * \brief Test class for mitkImageStatisticsCalculator
@@ -54,6 +56,9 @@ class mitkImageStatisticsCalculatorTestSuite : public mitk::TestFixture
   MITK_TEST(TestUS4DCroppedPlanarFigureTimeStep1);
   MITK_TEST(TestUS4DCroppedAllTimesteps);
   MITK_TEST(TestUS4DCropped3DMask);
+  MITK_TEST(TestSinglePassMultilabelStatistics);
+  MITK_TEST(TestIncrementalMaskUpdate);
+  MITK_TEST(TestExactMedian);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -84,6 +89,10 @@ public:
   void TestUS4DCroppedPlanarFigureTimeStep1();
   void TestUS4DCroppedAllTimesteps();
   void TestUS4DCropped3DMask();
+
+  void TestSinglePassMultilabelStatistics();
+  void TestIncrementalMaskUpdate();
+  void TestExactMedian();
 private:
 	mitk::Image::ConstPointer m_TestImage;
 
@@ -126,6 +135,10 @@ private:
 		mitk::ImageStatisticsContainer::RealType RMS,
 		mitk::ImageStatisticsContainer::IndexType minIndex,
 		mitk::ImageStatisticsContainer::IndexType maxIndex);
+
+	// checks that all statistics (except the number of voxels and the volume) are equal
+	void VerifyEqualStatistics(mitk::ImageStatisticsContainer::ImageStatisticsObject expected,
+		mitk::ImageStatisticsContainer::ImageStatisticsObject stats);
 };
 
 void mitkImageStatisticsCalculatorTestSuite::TestUninitializedImage()
@@ -1038,6 +1051,297 @@ mitk::PlanarPolygon::Pointer mitkImageStatisticsCalculatorTestSuite::GeneratePla
 	return figure;
 }
 
+void mitkImageStatisticsCalculatorTestSuite::TestSinglePassMultilabelStatistics()
+{
+	MITK_INFO << std::endl << "Test single pass multilabel statistics:-----------------------------------------------------------------------------------";
+
+	// statistics of integer images are computed with a single pass for all labels, those of floating point images
+	// are computed with the separate min/max and statistics passes. Both have to give the same results.
+	typedef itk::Image<short, 3> ShortImageType;
+	typedef itk::Image<float, 3> FloatImageType;
+	typedef itk::Image<unsigned short, 3> LabelImageType;
+
+	ShortImageType::RegionType region;
+	region.SetIndex(ShortImageType::IndexType({ { 0, 0, 0 } }));
+	region.SetSize(ShortImageType::SizeType({ { 12, 10, 4 } }));
+
+	ShortImageType::Pointer shortImage = ShortImageType::New();
+	shortImage->SetRegions(region);
+	shortImage->Allocate();
+	FloatImageType::Pointer floatImage = FloatImageType::New();
+	floatImage->SetRegions(region);
+	floatImage->Allocate();
+	LabelImageType::Pointer labelImage = LabelImageType::New();
+	labelImage->SetRegions(region);
+	labelImage->Allocate();
+
+	const unsigned short numberOfLabels = 6;
+	std::vector<mitk::ImageStatisticsContainer::VoxelCountType> expectedCounts(numberOfLabels, 0);
+
+	itk::ImageRegionIteratorWithIndex<ShortImageType> it(shortImage, region);
+	for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+	{
+		const ShortImageType::IndexType index = it.GetIndex();
+		const short value = static_cast<short>((index[0] * 7 + index[1] * 13 + index[2] * 29) % 53 - 20);
+		const unsigned short label = static_cast<unsigned short>((index[0] / 4 + index[1] / 5 * 3 + index[2]) % numberOfLabels);
+		it.Set(value);
+		floatImage->SetPixel(index, value);
+		labelImage->SetPixel(index, label);
+		++expectedCounts[label];
+	}
+
+	mitk::Image::Pointer mitkShortImage = mitk::ImportItkImage(shortImage)->Clone();
+	mitk::Image::Pointer mitkFloatImage = mitk::ImportItkImage(floatImage)->Clone();
+	mitk::Image::Pointer mitkLabelImage = mitk::ImportItkImage(labelImage)->Clone();
+
+	mitk::ImageMaskGenerator::Pointer shortMaskGen = mitk::ImageMaskGenerator::New();
+	shortMaskGen->SetImageMask(mitkLabelImage);
+	shortMaskGen->SetInputImage(mitkShortImage);
+	mitk::ImageMaskGenerator::Pointer floatMaskGen = mitk::ImageMaskGenerator::New();
+	floatMaskGen->SetImageMask(mitkLabelImage);
+	floatMaskGen->SetInputImage(mitkFloatImage);
+
+	mitk::ImageStatisticsCalculator::Pointer shortCalculator = mitk::ImageStatisticsCalculator::New();
+	shortCalculator->SetInputImage(mitkShortImage);
+	shortCalculator->SetMask(shortMaskGen.GetPointer());
+	mitk::ImageStatisticsCalculator::Pointer floatCalculator = mitk::ImageStatisticsCalculator::New();
+	floatCalculator->SetInputImage(mitkFloatImage);
+	floatCalculator->SetMask(floatMaskGen.GetPointer());
+
+	for (unsigned short label = 0; label < numberOfLabels; ++label)
+	{
+		mitk::ImageStatisticsContainer::Pointer shortStatistics;
+		mitk::ImageStatisticsContainer::Pointer floatStatistics;
+		CPPUNIT_ASSERT_NO_THROW(shortStatistics = shortCalculator->GetStatistics(label));
+		CPPUNIT_ASSERT_NO_THROW(floatStatistics = floatCalculator->GetStatistics(label));
+
+		auto shortStatObj = shortStatistics->GetStatisticsForTimeStep(0);
+		auto floatStatObj = floatStatistics->GetStatisticsForTimeStep(0);
+
+		CPPUNIT_ASSERT_MESSAGE("Single pass statistics have a wrong number of voxels",
+			shortStatObj.GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(mitk::ImageStatisticsConstants::NUMBEROFVOXELS()) == expectedCounts[label]);
+
+		VerifyEqualStatistics(floatStatObj, shortStatObj);
+	}
+}
+
+void mitkImageStatisticsCalculatorTestSuite::TestIncrementalMaskUpdate()
+{
+	MITK_INFO << std::endl << "Test incremental mask update:-----------------------------------------------------------------------------------";
+
+	typedef itk::Image<short, 3> ShortImageType;
+	typedef itk::Image<unsigned short, 3> LabelImageType;
+
+	ShortImageType::RegionType region;
+	region.SetIndex(ShortImageType::IndexType({ { 0, 0, 0 } }));
+	region.SetSize(ShortImageType::SizeType({ { 12, 10, 4 } }));
+
+	ShortImageType::Pointer image = ShortImageType::New();
+	image->SetRegions(region);
+	image->Allocate();
+	LabelImageType::Pointer labelImage = LabelImageType::New();
+	labelImage->SetRegions(region);
+	labelImage->Allocate();
+
+	const unsigned short numberOfLabels = 4;
+	itk::ImageRegionIteratorWithIndex<ShortImageType> it(image, region);
+	for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+	{
+		const ShortImageType::IndexType index = it.GetIndex();
+		it.Set(static_cast<short>((index[0] * 7 + index[1] * 13 + index[2] * 29) % 53 - 20));
+		labelImage->SetPixel(index, static_cast<unsigned short>((index[0] / 4 + index[1] / 5 * 2) % numberOfLabels));
+	}
+
+	mitk::Image::Pointer mitkImage = mitk::ImportItkImage(image)->Clone();
+	mitk::Image::Pointer mitkLabelImage = mitk::ImportItkImage(labelImage)->Clone();
+
+	mitk::ImageMaskGenerator::Pointer maskGen = mitk::ImageMaskGenerator::New();
+	maskGen->SetImageMask(mitkLabelImage);
+	maskGen->SetInputImage(mitkImage);
+
+	mitk::ImageStatisticsCalculator::Pointer calculator = mitk::ImageStatisticsCalculator::New();
+	calculator->SetInputImage(mitkImage);
+	calculator->SetMask(maskGen.GetPointer());
+	calculator->IncrementalMaskUpdatesOn();
+	CPPUNIT_ASSERT_NO_THROW(calculator->GetStatistics(1));
+
+	// paint a block with label 2 and afterwards the minimum voxel of label 3 (its minimum index has to be searched again)
+	mitk::ImageStatisticsCalculator::MaskRegionType blockRegion;
+	blockRegion.SetIndex(mitk::ImageStatisticsCalculator::MaskRegionType::IndexType({ { 3, 2, 1 } }));
+	blockRegion.SetSize(mitk::ImageStatisticsCalculator::MaskRegionType::SizeType({ { 4, 5, 2 } }));
+
+	auto minIndexOfLabel3 = calculator->GetStatistics(3)->GetStatisticsForTimeStep(0).GetValueConverted<mitk::ImageStatisticsContainer::IndexType>(mitk::ImageStatisticsConstants::MINIMUMPOSITION());
+	mitk::ImageStatisticsCalculator::MaskRegionType minVoxelRegion;
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		minVoxelRegion.SetIndex(i, minIndexOfLabel3[i]);
+	}
+	minVoxelRegion.SetSize(mitk::ImageStatisticsCalculator::MaskRegionType::SizeType({ { 1, 1, 1 } }));
+
+	std::vector<std::pair<mitk::ImageStatisticsCalculator::MaskRegionType, unsigned short> > edits = { { blockRegion, 2 }, { minVoxelRegion, 1 } };
+
+	for (const auto& edit : edits)
+	{
+		{
+			mitk::ImagePixelWriteAccessor<unsigned short, 3> accessor(mitkLabelImage);
+			itk::ImageRegionConstIteratorWithIndex<LabelImageType> editIt(labelImage, edit.first);
+			for (; !editIt.IsAtEnd(); ++editIt)
+			{
+				accessor.SetPixelByIndex(editIt.GetIndex(), edit.second);
+			}
+		}
+		mitkLabelImage->Modified();
+
+		CPPUNIT_ASSERT_NO_THROW(calculator->UpdateStatisticsForChangedMaskRegion(edit.first));
+
+		mitk::ImageMaskGenerator::Pointer referenceMaskGen = mitk::ImageMaskGenerator::New();
+		referenceMaskGen->SetImageMask(mitkLabelImage);
+		referenceMaskGen->SetInputImage(mitkImage);
+		mitk::ImageStatisticsCalculator::Pointer referenceCalculator = mitk::ImageStatisticsCalculator::New();
+		referenceCalculator->SetInputImage(mitkImage);
+		referenceCalculator->SetMask(referenceMaskGen.GetPointer());
+
+		for (unsigned short label = 0; label < numberOfLabels; ++label)
+		{
+			auto updatedStatObj = calculator->GetStatistics(label)->GetStatisticsForTimeStep(0);
+			auto referenceStatObj = referenceCalculator->GetStatistics(label)->GetStatisticsForTimeStep(0);
+
+			CPPUNIT_ASSERT_MESSAGE("Incrementally updated number of voxels differs from the recomputation",
+				updatedStatObj.GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(mitk::ImageStatisticsConstants::NUMBEROFVOXELS()) ==
+				referenceStatObj.GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(mitk::ImageStatisticsConstants::NUMBEROFVOXELS()));
+			VerifyEqualStatistics(referenceStatObj, updatedStatObj);
+		}
+	}
+}
+
+void mitkImageStatisticsCalculatorTestSuite::TestExactMedian()
+{
+	MITK_INFO << std::endl << "Test exact median:-----------------------------------------------------------------------------------";
+
+	// the labels have more voxels than collected directly by the refinement, so the float medians need refinement
+	// passes, the short medians are computed from the value counts of the single pass
+	typedef itk::Image<short, 3> ShortImageType;
+	typedef itk::Image<float, 3> FloatImageType;
+	typedef itk::Image<unsigned short, 3> LabelImageType;
+
+	FloatImageType::RegionType region;
+	region.SetIndex(FloatImageType::IndexType({ { 0, 0, 0 } }));
+	region.SetSize(FloatImageType::SizeType({ { 40, 40, 10 } }));
+
+	ShortImageType::Pointer shortImage = ShortImageType::New();
+	shortImage->SetRegions(region);
+	shortImage->Allocate();
+	FloatImageType::Pointer floatImage = FloatImageType::New();
+	floatImage->SetRegions(region);
+	floatImage->Allocate();
+	LabelImageType::Pointer labelImage = LabelImageType::New();
+	labelImage->SetRegions(region);
+	labelImage->Allocate();
+
+	const unsigned short numberOfLabels = 3;
+	std::vector<std::vector<double>> floatValues(numberOfLabels + 1);
+	std::vector<std::vector<double>> shortValues(numberOfLabels);
+
+	itk::ImageRegionIteratorWithIndex<FloatImageType> it(floatImage, region);
+	for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+	{
+		const FloatImageType::IndexType index = it.GetIndex();
+		const long hash = (index[0] * 7919 + index[1] * 104729 + index[2] * 1299709) % 10007;
+		const float value = static_cast<float>(std::sqrt(static_cast<double>(hash)) * 3.7 - 100.);
+		const short shortValue = static_cast<short>(hash % 211 - 50);
+		const unsigned short label = static_cast<unsigned short>((index[0] + index[1] / 3) % numberOfLabels);
+		it.Set(value);
+		shortImage->SetPixel(index, shortValue);
+		labelImage->SetPixel(index, label);
+		floatValues[label].push_back(value);
+		floatValues[numberOfLabels].push_back(value);
+		shortValues[label].push_back(shortValue);
+	}
+
+	auto median = [](std::vector<double> values)
+	{
+		std::sort(values.begin(), values.end());
+		return (values[(values.size() - 1) / 2] + values[values.size() / 2]) / 2.;
+	};
+
+	mitk::Image::Pointer mitkShortImage = mitk::ImportItkImage(shortImage)->Clone();
+	mitk::Image::Pointer mitkFloatImage = mitk::ImportItkImage(floatImage)->Clone();
+	mitk::Image::Pointer mitkLabelImage = mitk::ImportItkImage(labelImage)->Clone();
+
+	mitk::ImageMaskGenerator::Pointer shortMaskGen = mitk::ImageMaskGenerator::New();
+	shortMaskGen->SetImageMask(mitkLabelImage);
+	shortMaskGen->SetInputImage(mitkShortImage);
+	mitk::ImageMaskGenerator::Pointer floatMaskGen = mitk::ImageMaskGenerator::New();
+	floatMaskGen->SetImageMask(mitkLabelImage);
+	floatMaskGen->SetInputImage(mitkFloatImage);
+
+	mitk::ImageStatisticsCalculator::Pointer shortCalculator = mitk::ImageStatisticsCalculator::New();
+	shortCalculator->SetInputImage(mitkShortImage);
+	shortCalculator->SetMask(shortMaskGen.GetPointer());
+	shortCalculator->UseExactMedianOn();
+	mitk::ImageStatisticsCalculator::Pointer floatCalculator = mitk::ImageStatisticsCalculator::New();
+	floatCalculator->SetInputImage(mitkFloatImage);
+	floatCalculator->SetMask(floatMaskGen.GetPointer());
+	floatCalculator->UseExactMedianOn();
+
+	for (unsigned short label = 0; label < numberOfLabels; ++label)
+	{
+		auto shortStatObj = shortCalculator->GetStatistics(label)->GetStatisticsForTimeStep(0);
+		auto floatStatObj = floatCalculator->GetStatistics(label)->GetStatisticsForTimeStep(0);
+
+		CPPUNIT_ASSERT_MESSAGE("Exact median of integer image is wrong",
+			std::abs(shortStatObj.GetValueConverted<mitk::ImageStatisticsContainer::RealType>(mitk::ImageStatisticsConstants::MEDIAN()) - median(shortValues[label])) < mitk::eps);
+		CPPUNIT_ASSERT_MESSAGE("Exact median of floating point image is wrong",
+			std::abs(floatStatObj.GetValueConverted<mitk::ImageStatisticsContainer::RealType>(mitk::ImageStatisticsConstants::MEDIAN()) - median(floatValues[label])) < mitk::eps);
+	}
+
+	mitk::ImageStatisticsCalculator::Pointer unmaskedCalculator = mitk::ImageStatisticsCalculator::New();
+	unmaskedCalculator->SetInputImage(mitkFloatImage);
+	unmaskedCalculator->UseExactMedianOn();
+	auto unmaskedStatObj = unmaskedCalculator->GetStatistics()->GetStatisticsForTimeStep(0);
+	CPPUNIT_ASSERT_MESSAGE("Exact median of unmasked image is wrong",
+		std::abs(unmaskedStatObj.GetValueConverted<mitk::ImageStatisticsContainer::RealType>(mitk::ImageStatisticsConstants::MEDIAN()) - median(floatValues[numberOfLabels])) < mitk::eps);
+
+	// with a tolerance the refinement may stop early
+	const double tolerance = 0.5;
+	floatCalculator->SetExactMedianTolerance(tolerance);
+	for (unsigned short label = 0; label < numberOfLabels; ++label)
+	{
+		auto floatStatObj = floatCalculator->GetStatistics(label)->GetStatisticsForTimeStep(0);
+		CPPUNIT_ASSERT_MESSAGE("Median of floating point image exceeds the tolerance",
+			std::abs(floatStatObj.GetValueConverted<mitk::ImageStatisticsContainer::RealType>(mitk::ImageStatisticsConstants::MEDIAN()) - median(floatValues[label])) <= tolerance);
+	}
+}
+
+void mitkImageStatisticsCalculatorTestSuite::VerifyEqualStatistics(mitk::ImageStatisticsContainer::ImageStatisticsObject expected,
+	mitk::ImageStatisticsContainer::ImageStatisticsObject stats)
+{
+	for (const auto& statisticName : { mitk::ImageStatisticsConstants::MEAN(), mitk::ImageStatisticsConstants::MINIMUM(),
+		mitk::ImageStatisticsConstants::MAXIMUM(), mitk::ImageStatisticsConstants::STANDARDDEVIATION(),
+		mitk::ImageStatisticsConstants::VARIANCE(), mitk::ImageStatisticsConstants::SKEWNESS(),
+		mitk::ImageStatisticsConstants::KURTOSIS(), mitk::ImageStatisticsConstants::RMS(),
+		mitk::ImageStatisticsConstants::MPP(), mitk::ImageStatisticsConstants::MEDIAN(),
+		mitk::ImageStatisticsConstants::ENTROPY(), mitk::ImageStatisticsConstants::UNIFORMITY(),
+		mitk::ImageStatisticsConstants::UPP() })
+	{
+		auto expectedValue = expected.GetValueConverted<mitk::ImageStatisticsContainer::RealType>(statisticName);
+		auto value = stats.GetValueConverted<mitk::ImageStatisticsContainer::RealType>(statisticName);
+		if (std::isnan(expectedValue) && std::isnan(value))
+		{
+			continue;
+		}
+		CPPUNIT_ASSERT_MESSAGE("Statistic " + statisticName + " differs from the expected value",
+			std::abs(expectedValue - value) < mitk::eps);
+	}
+
+	auto expectedMinIndex = expected.GetValueConverted<mitk::ImageStatisticsContainer::IndexType>(mitk::ImageStatisticsConstants::MINIMUMPOSITION());
+	auto minIndex = stats.GetValueConverted<mitk::ImageStatisticsContainer::IndexType>(mitk::ImageStatisticsConstants::MINIMUMPOSITION());
+	auto expectedMaxIndex = expected.GetValueConverted<mitk::ImageStatisticsContainer::IndexType>(mitk::ImageStatisticsConstants::MAXIMUMPOSITION());
+	auto maxIndex = stats.GetValueConverted<mitk::ImageStatisticsContainer::IndexType>(mitk::ImageStatisticsConstants::MAXIMUMPOSITION());
+	CPPUNIT_ASSERT_MESSAGE("Minimum position differs from the expected position", expectedMinIndex == minIndex);
+	CPPUNIT_ASSERT_MESSAGE("Maximum position differs from the expected position", expectedMaxIndex == maxIndex);
+}
+
 const mitk::ImageStatisticsContainer::Pointer
 mitkImageStatisticsCalculatorTestSuite::ComputeStatistics(mitk::Image::ConstPointer image,
 	mitk::MaskGenerator::Pointer maskGen,
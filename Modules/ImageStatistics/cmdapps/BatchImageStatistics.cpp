@@ -0,0 +1,508 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkCommandLineParser.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkIOUtil.h>
+#include <mitkImageMaskGenerator.h>
+#include <mitkImageStatisticsCalculator.h>
+#include <mitkImageStatisticsConstants.h>
+
+#include <itkMultiThreader.h>
+#include <itksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <future>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  /** One row of the manifest */
+  struct ManifestRow
+  {
+    std::string id;
+    std::string image;
+    std::string mask;
+    unsigned short label;
+    unsigned int timeStep;
+  };
+
+  std::string Trim(const std::string &value)
+  {
+    const auto begin = value.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos)
+    {
+      return std::string();
+    }
+    const auto end = value.find_last_not_of(" \t\r\n");
+    std::string trimmed = value.substr(begin, end - begin + 1);
+    if (trimmed.size() >= 2 && trimmed.front() == '"' && trimmed.back() == '"')
+    {
+      trimmed = trimmed.substr(1, trimmed.size() - 2);
+    }
+    return trimmed;
+  }
+
+  std::vector<std::string> SplitCSVLine(const std::string &line)
+  {
+    std::vector<std::string> fields;
+    std::istringstream stream(line);
+    std::string field;
+    while (std::getline(stream, field, ','))
+    {
+      fields.push_back(Trim(field));
+    }
+    return fields;
+  }
+
+  std::string EscapeCSV(const std::string &value)
+  {
+    if (value.find_first_of(",\"\n") == std::string::npos)
+    {
+      return value;
+    }
+
+    std::string escaped = "\"";
+    for (const char c : value)
+    {
+      escaped += c;
+      if (c == '"')
+      {
+        escaped += '"';
+      }
+    }
+    return escaped + "\"";
+  }
+
+  /** Reads the manifest. The first line names the columns: "image" is required, "mask", "label", "timestep" and
+   * "id" are optional. Relative paths are relative to the directory of the manifest. */
+  std::vector<ManifestRow> ReadManifest(const std::string &filename, unsigned short defaultLabel)
+  {
+    std::ifstream stream(filename);
+    if (!stream)
+    {
+      mitkThrow() << "Cannot read manifest " << filename;
+    }
+
+    const std::string manifestDirectory =
+      itksys::SystemTools::GetFilenamePath(itksys::SystemTools::CollapseFullPath(filename));
+
+    std::string line;
+    std::map<std::string, std::size_t> columns;
+    while (std::getline(stream, line))
+    {
+      if (!Trim(line).empty())
+      {
+        const auto names = SplitCSVLine(line);
+        for (std::size_t i = 0; i < names.size(); ++i)
+        {
+          columns[itksys::SystemTools::LowerCase(names[i])] = i;
+        }
+        break;
+      }
+    }
+
+    if (columns.find("image") == columns.end())
+    {
+      mitkThrow() << "Manifest " << filename << " has no \"image\" column";
+    }
+
+    auto field = [&columns](const std::vector<std::string> &fields, const std::string &name) {
+      auto column = columns.find(name);
+      return column != columns.end() && column->second < fields.size() ? fields[column->second] : std::string();
+    };
+
+    auto resolve = [&manifestDirectory](const std::string &path) {
+      return path.empty() ? path : itksys::SystemTools::CollapseFullPath(path, manifestDirectory);
+    };
+
+    std::vector<ManifestRow> rows;
+    while (std::getline(stream, line))
+    {
+      if (Trim(line).empty() || Trim(line).front() == '#')
+      {
+        continue;
+      }
+
+      const auto fields = SplitCSVLine(line);
+      ManifestRow row;
+      row.image = resolve(field(fields, "image"));
+      row.mask = resolve(field(fields, "mask"));
+      row.id = field(fields, "id");
+      const std::string label = field(fields, "label");
+      row.label = label.empty() ? defaultLabel : static_cast<unsigned short>(std::stoul(label));
+      const std::string timeStep = field(fields, "timestep");
+      row.timeStep = timeStep.empty() ? 0 : static_cast<unsigned int>(std::stoul(timeStep));
+
+      if (row.id.empty())
+      {
+        row.id = std::to_string(rows.size() + 1);
+      }
+      rows.push_back(row);
+    }
+
+    return rows;
+  }
+
+  /** Images that are shared by the rows. Images in use are kept, the least recently used other images are
+   * removed as soon as more than the capacity are loaded. An image that is requested while it is loaded by
+   * another thread is only loaded once. */
+  class ImageCache
+  {
+  public:
+    explicit ImageCache(std::size_t capacity) : m_Capacity(capacity), m_UseCounter(0) {}
+
+    mitk::Image::Pointer Acquire(const std::string &path)
+    {
+      std::shared_future<mitk::Image::Pointer> image;
+      std::promise<mitk::Image::Pointer> loading;
+      bool load = false;
+
+      {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto entry = m_Entries.find(path);
+        if (entry == m_Entries.end())
+        {
+          this->RemoveUnusedEntries(m_Capacity > 0 ? m_Capacity - 1 : 0);
+          entry = m_Entries.insert(std::make_pair(path, Entry())).first;
+          entry->second.image = loading.get_future().share();
+          load = true;
+        }
+        ++entry->second.users;
+        entry->second.lastUse = ++m_UseCounter;
+        image = entry->second.image;
+      }
+
+      if (load)
+      {
+        try
+        {
+          loading.set_value(mitk::IOUtil::Load<mitk::Image>(path));
+        }
+        catch (...)
+        {
+          loading.set_exception(std::current_exception());
+        }
+      }
+
+      try
+      {
+        return image.get();
+      }
+      catch (...)
+      {
+        this->Release(path);
+        throw;
+      }
+    }
+
+    void Release(const std::string &path)
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      auto entry = m_Entries.find(path);
+      if (entry != m_Entries.end() && entry->second.users > 0)
+      {
+        --entry->second.users;
+      }
+      this->RemoveUnusedEntries(m_Capacity);
+    }
+
+  private:
+    struct Entry
+    {
+      Entry() : users(0), lastUse(0) {}
+      std::shared_future<mitk::Image::Pointer> image;
+      unsigned int users;
+      unsigned long long lastUse;
+    };
+
+    /** Removes unused entries (least recently used first) until at most maxEntries remain. m_Mutex must be locked. */
+    void RemoveUnusedEntries(std::size_t maxEntries)
+    {
+      while (m_Entries.size() > maxEntries)
+      {
+        auto oldest = m_Entries.end();
+        for (auto entry = m_Entries.begin(); entry != m_Entries.end(); ++entry)
+        {
+          if (entry->second.users == 0 && (oldest == m_Entries.end() || entry->second.lastUse < oldest->second.lastUse))
+          {
+            oldest = entry;
+          }
+        }
+
+        if (oldest == m_Entries.end())
+        {
+          // all remaining images are in use
+          return;
+        }
+        m_Entries.erase(oldest);
+      }
+    }
+
+    std::mutex m_Mutex;
+    std::map<std::string, Entry> m_Entries;
+    std::size_t m_Capacity;
+    unsigned long long m_UseCounter;
+  };
+
+  struct StatisticsSettings
+  {
+    unsigned int numberOfBins;
+    bool exactMedian;
+  };
+
+  /** Computes the statistics of a row and returns the values in the order of the statistic names */
+  std::vector<std::string> CalculateStatistics(const ManifestRow &row,
+                                               ImageCache &cache,
+                                               const StatisticsSettings &settings)
+  {
+    mitk::Image::Pointer image = cache.Acquire(row.image);
+    mitk::Image::Pointer mask;
+
+    std::vector<std::string> values;
+    try
+    {
+      mitk::ImageStatisticsCalculator::Pointer calculator = mitk::ImageStatisticsCalculator::New();
+      calculator->SetInputImage(image);
+      calculator->SetNBinsForHistogramStatistics(settings.numberOfBins);
+      calculator->SetUseExactMedian(settings.exactMedian);
+
+      mitk::ImageMaskGenerator::Pointer maskGenerator;
+      if (!row.mask.empty())
+      {
+        mask = cache.Acquire(row.mask);
+        maskGenerator = mitk::ImageMaskGenerator::New();
+        maskGenerator->SetImageMask(mask);
+        maskGenerator->SetInputImage(image.GetPointer());
+        calculator->SetMask(maskGenerator.GetPointer());
+      }
+
+      const auto statistics = calculator->GetStatistics(mask.IsNotNull() ? row.label : 1);
+      if (!statistics->TimeStepExists(row.timeStep))
+      {
+        mitkThrow() << "No statistics for time step " << row.timeStep;
+      }
+
+      const auto statObj = statistics->GetStatisticsForTimeStep(row.timeStep);
+      for (const auto &name : mitk::ImageStatisticsContainer::ImageStatisticsObject::GetDefaultStatisticNames())
+      {
+        std::ostringstream value;
+        if (statObj.HasStatistic(name))
+        {
+          value << statObj.GetValueNonConverted(name);
+        }
+        values.push_back(value.str());
+      }
+    }
+    catch (...)
+    {
+      if (mask.IsNotNull())
+      {
+        cache.Release(row.mask);
+      }
+      cache.Release(row.image);
+      throw;
+    }
+
+    if (mask.IsNotNull())
+    {
+      cache.Release(row.mask);
+    }
+    cache.Release(row.image);
+
+    return values;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  mitkCommandLineParser parser;
+
+  parser.setTitle("Batch Image Statistics");
+  parser.setCategory("Analysis Tools");
+  parser.setDescription("Computes the image statistics of all image/mask pairs of a CSV manifest and writes them into "
+                        "one CSV table. The manifest needs an \"image\" column, the columns \"mask\", \"label\", "
+                        "\"timestep\" and \"id\" are optional.");
+  parser.setContributor("German Cancer Research Center (DKFZ)");
+
+  parser.setArgumentPrefix("--", "-");
+  parser.addArgument("help", "h", mitkCommandLineParser::Bool, "Help:", "Show this help text");
+  parser.addArgument("input", "i", mitkCommandLineParser::File, "Manifest:",
+                     "CSV file with one image/mask pair per row", us::Any(), false, false, false,
+                     mitkCommandLineParser::Input);
+  parser.addArgument("output", "o", mitkCommandLineParser::File, "Output file:", "Statistics table (CSV)",
+                     us::Any(), false, false, false, mitkCommandLineParser::Output);
+  parser.addArgument("threads", "t", mitkCommandLineParser::Int, "Threads:",
+                     "Number of rows that are processed in parallel (default: number of cores)");
+  parser.addArgument("cache", "c", mitkCommandLineParser::Int, "Cached images:",
+                     "Maximum number of loaded images (default: threads). Images that are used by a row "
+                     "are kept even if this number is exceeded.");
+  parser.addArgument("label", "l", mitkCommandLineParser::Int, "Label:",
+                     "Mask label used for rows without a label (default: 1)");
+  parser.addArgument("bins", "b", mitkCommandLineParser::Int, "Histogram bins:",
+                     "Number of bins of the histogram statistics (default: 100)");
+  parser.addArgument("exact-median", "em", mitkCommandLineParser::Bool, "Exact median:",
+                     "Compute the median from the voxel values instead of the histogram");
+
+  std::map<std::string, us::Any> parsedArgs = parser.parseArguments(argc, argv);
+
+  if (parsedArgs.size() == 0)
+    return EXIT_FAILURE;
+
+  if (parsedArgs.count("help") || parsedArgs.count("h"))
+  {
+    std::cout << parser.helpText();
+    return EXIT_SUCCESS;
+  }
+
+  const std::string manifestFilename = us::any_cast<std::string>(parsedArgs["input"]);
+  const std::string outputFilename = us::any_cast<std::string>(parsedArgs["output"]);
+
+  unsigned int numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+  if (parsedArgs.count("threads"))
+  {
+    numberOfThreads = static_cast<unsigned int>(std::max(1, us::any_cast<int>(parsedArgs["threads"])));
+  }
+
+  std::size_t cacheCapacity = numberOfThreads;
+  if (parsedArgs.count("cache"))
+  {
+    cacheCapacity = static_cast<std::size_t>(std::max(0, us::any_cast<int>(parsedArgs["cache"])));
+  }
+
+  unsigned short defaultLabel = 1;
+  if (parsedArgs.count("label"))
+  {
+    defaultLabel = static_cast<unsigned short>(std::max(0, us::any_cast<int>(parsedArgs["label"])));
+  }
+
+  StatisticsSettings settings;
+  settings.numberOfBins = 100;
+  if (parsedArgs.count("bins"))
+  {
+    settings.numberOfBins = static_cast<unsigned int>(std::max(1, us::any_cast<int>(parsedArgs["bins"])));
+  }
+  settings.exactMedian = parsedArgs.count("exact-median") > 0;
+
+  std::vector<ManifestRow> rows;
+  try
+  {
+    rows = ReadManifest(manifestFilename, defaultLabel);
+  }
+  catch (const std::exception &e)
+  {
+    MITK_ERROR << e.what();
+    return EXIT_FAILURE;
+  }
+
+  std::ofstream output(outputFilename, std::ios::out | std::ios::trunc);
+  if (!output)
+  {
+    MITK_ERROR << "Cannot write statistics table: " << outputFilename;
+    return EXIT_FAILURE;
+  }
+
+  // the rows are processed in parallel already, so the filters of a row share the remaining cores
+  itk::MultiThreader::SetGlobalDefaultNumberOfThreads(
+    std::max(1u, std::max(1u, std::thread::hardware_concurrency()) / numberOfThreads));
+
+  const auto start = std::chrono::steady_clock::now();
+
+  // rows that share images are processed one after the other, so the images are still cached
+  std::vector<std::size_t> order(rows.size());
+  for (std::size_t i = 0; i < order.size(); ++i)
+  {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&rows](std::size_t a, std::size_t b) {
+    return rows[a].image < rows[b].image || (rows[a].image == rows[b].image && rows[a].mask < rows[b].mask);
+  });
+
+  ImageCache cache(cacheCapacity);
+  std::vector<std::vector<std::string>> results(rows.size());
+  std::vector<std::string> errors(rows.size());
+  std::atomic<std::size_t> nextRow(0);
+  std::atomic<std::size_t> numberOfFailedRows(0);
+
+  auto processRows = [&]() {
+    for (std::size_t i = nextRow++; i < order.size(); i = nextRow++)
+    {
+      const std::size_t rowIndex = order[i];
+      try
+      {
+        results[rowIndex] = CalculateStatistics(rows[rowIndex], cache, settings);
+      }
+      catch (const std::exception &e)
+      {
+        errors[rowIndex] = e.what();
+        ++numberOfFailedRows;
+        MITK_ERROR << "Cannot compute statistics of row " << rows[rowIndex].id << ": " << e.what();
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned int i = 1; i < numberOfThreads; ++i)
+  {
+    threads.emplace_back(processRows);
+  }
+  processRows();
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  const auto &statisticNames = mitk::ImageStatisticsContainer::ImageStatisticsObject::GetDefaultStatisticNames();
+
+  output << "id,image,mask,label,timestep";
+  for (const auto &name : statisticNames)
+  {
+    output << "," << EscapeCSV(name);
+  }
+  output << ",error\n";
+
+  for (std::size_t i = 0; i < rows.size(); ++i)
+  {
+    const ManifestRow &row = rows[i];
+    output << EscapeCSV(row.id) << "," << EscapeCSV(row.image) << "," << EscapeCSV(row.mask) << ","
+           << (row.mask.empty() ? std::string() : std::to_string(row.label)) << "," << row.timeStep;
+
+    for (std::size_t j = 0; j < statisticNames.size(); ++j)
+    {
+      output << "," << (j < results[i].size() ? EscapeCSV(results[i][j]) : std::string());
+    }
+    output << "," << EscapeCSV(errors[i]) << "\n";
+  }
+
+  output.close();
+
+  const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+  std::cout << "Computed statistics of " << rows.size() - numberOfFailedRows << " of " << rows.size() << " rows in "
+            << duration.count() << " s." << std::endl;
+
+  if (!output)
+  {
+    MITK_ERROR << "Cannot write statistics table: " << outputFilename;
+    return EXIT_FAILURE;
+  }
+
+  return numberOfFailedRows == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
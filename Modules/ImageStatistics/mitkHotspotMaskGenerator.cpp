@@ -18,8 +18,14 @@ found in the LICENSE file.
 #include "mitkImageAccessByItk.h"
 #include <itkImageDuplicator.h>
 #include <itkFFTConvolutionImageFilter.h>
+#include <itkExtractImageFilter.h>
+#include <itkImageRegionConstIteratorWithIndex.h>
 #include <mitkITKImageImport.h>
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 namespace mitk
 {
     HotspotMaskGenerator::HotspotMaskGenerator():
@@ -185,7 +191,7 @@ namespace mitk
     HotspotMaskGenerator::ImageExtrema
       HotspotMaskGenerator::CalculateExtremaWorld( const itk::Image<TPixel, VImageDimension>* inputImage,
                                                     typename itk::Image<unsigned short, VImageDimension>::Pointer maskImage,
-                                                    double neccessaryDistanceToImageBorderInMM,
+                                                    const itk::ImageRegion<VImageDimension>& allowedExtremaRegion,
                                                     unsigned int label )
     {
       typedef itk::Image< TPixel, VImageDimension > ImageType;
@@ -194,31 +200,11 @@ namespace mitk
       typedef itk::ImageRegionConstIteratorWithIndex<MaskImageType> MaskImageIteratorType;
       typedef itk::ImageRegionConstIteratorWithIndex<ImageType> InputImageIndexIteratorType;
 
-      typename ImageType::SpacingType spacing = inputImage->GetSpacing();
-
       ImageExtrema minMax;
       minMax.Defined = false;
       minMax.MaxIndex.set_size(VImageDimension);
       minMax.MaxIndex.set_size(VImageDimension);
 
-      typename ImageType::RegionType allowedExtremaRegion = inputImage->GetLargestPossibleRegion();
-
-      bool keepDistanceToImageBorders( neccessaryDistanceToImageBorderInMM > 0 );
-      if (keepDistanceToImageBorders)
-      {
-        itk::IndexValueType distanceInPixels[VImageDimension];
-        for(unsigned short dimension = 0; dimension < VImageDimension; ++dimension)
-        {
-          // To confirm that the whole hotspot is inside the image we have to keep a specific distance to the image-borders, which is as long as
-          // the radius. To get the amount of indices we divide the radius by spacing and add 0.5 because voxels are center based:
-          // For example with a radius of 2.2 and a spacing of 1 two indices are enough because 2.2 / 1 + 0.5 = 2.7 => 2.
-          // But with a radius of 2.7 we need 3 indices because 2.7 / 1 + 0.5 = 3.2 => 3
-          distanceInPixels[dimension] = int( neccessaryDistanceToImageBorderInMM / spacing[dimension] + 0.5);
-        }
-
-        allowedExtremaRegion.ShrinkByRadius(distanceInPixels);
-      }
-
       InputImageIndexIteratorType imageIndexIt(inputImage, allowedExtremaRegion);
 
       float maxValue = itk::NumericTraits<float>::min();
@@ -235,7 +221,14 @@ namespace mitk
 
       if (maskImage != nullptr)
       {
-        MaskImageIteratorType maskIt(maskImage, maskImage->GetLargestPossibleRegion());
+        // only the mask pixels within the allowed region can be extrema
+        typename MaskImageType::RegionType maskRegion = maskImage->GetLargestPossibleRegion();
+        if (!maskRegion.Crop(allowedExtremaRegion))
+        {
+          maskRegion.SetSize(typename MaskImageType::SizeType());
+        }
+
+        MaskImageIteratorType maskIt(maskImage, maskRegion);
         typename ImageType::IndexType imageIndex;
         typename ImageType::PointType worldPosition;
         typename ImageType::IndexType maskIndex;
@@ -431,7 +424,11 @@ namespace mitk
 
     template <typename TPixel, unsigned int VImageDimension>
     itk::SmartPointer<itk::Image<TPixel, VImageDimension> >
-      HotspotMaskGenerator::GenerateConvolutionImage( const itk::Image<TPixel, VImageDimension>* inputImage )
+      HotspotMaskGenerator::GenerateConvolutionImage( const itk::Image<TPixel, VImageDimension>* inputImage,
+                                                      const itk::ImageRegion<VImageDimension>& centerRegion,
+                                                      const itk::Image<unsigned short, VImageDimension>* maskImage,
+                                                      unsigned int label,
+                                                      itk::SizeValueType numberOfCenters )
     {
       double mmPerPixel[VImageDimension];
       for (unsigned int dimension = 0; dimension < VImageDimension; ++dimension)
@@ -443,9 +440,64 @@ namespace mitk
       typedef itk::Image< float, VImageDimension > KernelImageType;
       typename KernelImageType::Pointer convolutionKernel = this->GenerateHotspotSearchConvolutionKernel<VImageDimension>(mmPerPixel, m_HotspotRadiusinMM);
 
-      // update convolution image
       typedef itk::Image< TPixel, VImageDimension > InputImageType;
       typedef itk::Image< TPixel, VImageDimension > ConvolutionImageType;
+      typedef typename InputImageType::RegionType RegionType;
+
+      // only the image region covered by the kernel at the possible hotspot centers is needed for the convolution
+      typename KernelImageType::SizeType kernelSize = convolutionKernel->GetLargestPossibleRegion().GetSize();
+      typename KernelImageType::SizeType kernelRadius;
+      for (unsigned int dimension = 0; dimension < VImageDimension; ++dimension)
+      {
+        kernelRadius[dimension] = kernelSize[dimension] / 2;
+      }
+
+      RegionType evaluationRegion = centerRegion;
+      evaluationRegion.PadByRadius(kernelRadius);
+      evaluationRegion.Crop(inputImage->GetLargestPossibleRegion());
+
+      // rough operation counts of both ways: kernel evaluation at each center vs. forward and inverse FFT of the
+      // padded evaluation region
+      double numberOfKernelWeights = 0.;
+      typedef itk::ImageRegionConstIterator<KernelImageType> KernelIteratorType;
+      KernelIteratorType kernelIt(convolutionKernel, convolutionKernel->GetLargestPossibleRegion());
+      for (kernelIt.GoToBegin(); !kernelIt.IsAtEnd(); ++kernelIt)
+      {
+        if (kernelIt.Get() > 0)
+        {
+          ++numberOfKernelWeights;
+        }
+      }
+
+      double fftSize = 1.;
+      for (unsigned int dimension = 0; dimension < VImageDimension; ++dimension)
+      {
+        fftSize *= static_cast<double>(evaluationRegion.GetSize(dimension) + kernelSize[dimension]);
+      }
+
+      const double directCost = static_cast<double>(numberOfCenters) * numberOfKernelWeights;
+      const double fftCost = 10. * fftSize * std::log2(fftSize);
+
+      if (directCost < fftCost)
+      {
+        MITK_DEBUG << "Evaluate convolution at " << numberOfCenters << " possible hotspot centers";
+        return this->GenerateConvolutionImageAtCenters<TPixel, VImageDimension>(
+          inputImage, convolutionKernel.GetPointer(), centerRegion, maskImage, label);
+      }
+
+      // update convolution image
+      typename InputImageType::ConstPointer evaluationImage = inputImage;
+      if (evaluationRegion != inputImage->GetLargestPossibleRegion())
+      {
+        typedef itk::ExtractImageFilter<InputImageType, InputImageType> ExtractFilterType;
+        typename ExtractFilterType::Pointer extractFilter = ExtractFilterType::New();
+        extractFilter->SetInput(inputImage);
+        extractFilter->SetExtractionRegion(evaluationRegion);
+        extractFilter->SetDirectionCollapseToSubmatrix();
+        extractFilter->Update();
+        evaluationImage = extractFilter->GetOutput();
+      }
+
       typedef itk::FFTConvolutionImageFilter<InputImageType,
         KernelImageType,
         ConvolutionImageType> ConvolutionFilterType;
@@ -461,7 +513,7 @@ namespace mitk
         convolutionFilter->SetBoundaryCondition(&boundaryCondition);
       }
 
-      convolutionFilter->SetInput(inputImage);
+      convolutionFilter->SetInput(evaluationImage);
       convolutionFilter->SetKernelImage(convolutionKernel);
       convolutionFilter->SetNormalize(true);
       MITK_DEBUG << "Update Convolution image for hotspot search";
@@ -473,6 +525,94 @@ namespace mitk
       return convolutionImage;
     }
 
+    template <typename TPixel, unsigned int VImageDimension>
+    itk::SmartPointer<itk::Image<TPixel, VImageDimension> >
+      HotspotMaskGenerator::GenerateConvolutionImageAtCenters( const itk::Image<TPixel, VImageDimension>* inputImage,
+                                                               const itk::Image<float, VImageDimension>* convolutionKernel,
+                                                               const itk::ImageRegion<VImageDimension>& centerRegion,
+                                                               const itk::Image<unsigned short, VImageDimension>* maskImage,
+                                                               unsigned int label )
+    {
+      typedef itk::Image< float, VImageDimension > KernelImageType;
+      typedef itk::Image< TPixel, VImageDimension > InputImageType;
+      typedef itk::Image< TPixel, VImageDimension > ConvolutionImageType;
+      typedef itk::Image< unsigned short, VImageDimension > MaskImageType;
+      typedef typename InputImageType::IndexType IndexType;
+      typedef typename InputImageType::OffsetType OffsetType;
+
+      // offsets and normalized weights of the kernel voxels; the offsets are mirrored (convolution)
+      typename KernelImageType::SizeType kernelSize = convolutionKernel->GetLargestPossibleRegion().GetSize();
+      std::vector< std::pair<OffsetType, double> > kernelWeights;
+      double kernelSum = 0.;
+
+      typedef itk::ImageRegionConstIteratorWithIndex<KernelImageType> KernelIteratorType;
+      KernelIteratorType kernelIt(convolutionKernel, convolutionKernel->GetLargestPossibleRegion());
+      for (kernelIt.GoToBegin(); !kernelIt.IsAtEnd(); ++kernelIt)
+      {
+        kernelSum += kernelIt.Get();
+        if (kernelIt.Get() > 0)
+        {
+          OffsetType offset;
+          for (unsigned int dimension = 0; dimension < VImageDimension; ++dimension)
+          {
+            offset[dimension] = static_cast<itk::OffsetValueType>(kernelSize[dimension] / 2) - kernelIt.GetIndex()[dimension];
+          }
+          kernelWeights.push_back(std::make_pair(offset, static_cast<double>(kernelIt.Get())));
+        }
+      }
+
+      for (auto& weight : kernelWeights)
+      {
+        weight.second /= kernelSum;
+      }
+
+      typename ConvolutionImageType::Pointer convolutionImage = ConvolutionImageType::New();
+      convolutionImage->CopyInformation(inputImage);
+      convolutionImage->SetRegions(centerRegion);
+      convolutionImage->Allocate();
+      convolutionImage->FillBuffer(0);
+
+      const typename InputImageType::RegionType imageRegion = inputImage->GetLargestPossibleRegion();
+
+      typedef itk::ImageRegionConstIteratorWithIndex<MaskImageType> MaskIteratorType;
+      MaskIteratorType maskIt(maskImage, centerRegion);
+      for (maskIt.GoToBegin(); !maskIt.IsAtEnd(); ++maskIt)
+      {
+        if (maskIt.Get() != label)
+        {
+          continue;
+        }
+
+        const IndexType center = maskIt.GetIndex();
+        double value = 0.;
+        for (const auto& weight : kernelWeights)
+        {
+          IndexType index = center + weight.first;
+          if (!imageRegion.IsInside(index))
+          {
+            if (m_HotspotMustBeCompletelyInsideImage)
+            {
+              // constant boundary condition (0)
+              continue;
+            }
+
+            // zero flux Neumann boundary condition (default of the convolution filter)
+            for (unsigned int dimension = 0; dimension < VImageDimension; ++dimension)
+            {
+              const itk::IndexValueType lower = imageRegion.GetIndex(dimension);
+              const itk::IndexValueType upper = lower + static_cast<itk::IndexValueType>(imageRegion.GetSize(dimension)) - 1;
+              index[dimension] = std::max(lower, std::min(upper, index[dimension]));
+            }
+          }
+          value += weight.second * inputImage->GetPixel(index);
+        }
+
+        convolutionImage->SetPixel(center, static_cast<TPixel>(value));
+      }
+
+      return convolutionImage;
+    }
+
     template < typename TPixel, unsigned int VImageDimension>
     void
       HotspotMaskGenerator::FillHotspotMaskPixels( itk::Image<TPixel, VImageDimension>* maskImage,
@@ -506,14 +646,6 @@ namespace mitk
         typedef itk::Image< TPixel, VImageDimension > ConvolutionImageType;
         typedef itk::Image< unsigned short, VImageDimension > MaskImageType;
 
-        typename ConvolutionImageType::Pointer convolutionImage = this->GenerateConvolutionImage(inputImage);
-
-        if (convolutionImage.IsNull())
-        {
-          MITK_ERROR << "Empty convolution image in CalculateHotspotStatistics(). We should never reach this state (logic error).";
-          throw std::logic_error("Empty convolution image in CalculateHotspotStatistics()");
-        }
-
         // if mask image is not defined, create an image of the same size as inputImage and fill it with 1's
         // there is maybe a better way to do this!?
         if (maskImage == nullptr)
@@ -534,9 +666,71 @@ namespace mitk
             label = 1;
         }
 
-        // find maximum in convolution image, given the current mask
-        double requiredDistanceToBorder = m_HotspotMustBeCompletelyInsideImage ? m_HotspotRadiusinMM : -1.0;
-        ImageExtrema convolutionImageInformation = CalculateExtremaWorld(convolutionImage.GetPointer(), maskImage, requiredDistanceToBorder, label);
+        typename InputImageType::RegionType allowedCenterRegion = inputImage->GetLargestPossibleRegion();
+        if (m_HotspotMustBeCompletelyInsideImage)
+        {
+          typename InputImageType::SpacingType spacing = inputImage->GetSpacing();
+          itk::IndexValueType distanceInPixels[VImageDimension];
+          for(unsigned short dimension = 0; dimension < VImageDimension; ++dimension)
+          {
+            // To confirm that the whole hotspot is inside the image we have to keep a specific distance to the image-borders, which is as long as
+            // the radius. To get the amount of indices we divide the radius by spacing and add 0.5 because voxels are center based:
+            // For example with a radius of 2.2 and a spacing of 1 two indices are enough because 2.2 / 1 + 0.5 = 2.7 => 2.
+            // But with a radius of 2.7 we need 3 indices because 2.7 / 1 + 0.5 = 3.2 => 3
+            distanceInPixels[dimension] = int( m_HotspotRadiusinMM / spacing[dimension] + 0.5);
+          }
+
+          allowedCenterRegion.ShrinkByRadius(distanceInPixels);
+        }
+
+        // the convolution is only needed within the bounding box of the possible hotspot centers
+        typename MaskImageType::RegionType centerSearchRegion = maskImage->GetLargestPossibleRegion();
+        itk::SizeValueType numberOfCenters = 0;
+        typename InputImageType::IndexType lowerCenterIndex;
+        typename InputImageType::IndexType upperCenterIndex;
+        lowerCenterIndex.Fill(itk::NumericTraits<itk::IndexValueType>::max());
+        upperCenterIndex.Fill(itk::NumericTraits<itk::IndexValueType>::NonpositiveMin());
+
+        if (centerSearchRegion.Crop(allowedCenterRegion))
+        {
+          itk::ImageRegionConstIteratorWithIndex<MaskImageType> maskIt(maskImage, centerSearchRegion);
+          for (maskIt.GoToBegin(); !maskIt.IsAtEnd(); ++maskIt)
+          {
+            if (maskIt.Get() == label)
+            {
+              ++numberOfCenters;
+              for (unsigned int d = 0; d < VImageDimension; ++d)
+              {
+                lowerCenterIndex[d] = std::min(lowerCenterIndex[d], maskIt.GetIndex()[d]);
+                upperCenterIndex[d] = std::max(upperCenterIndex[d], maskIt.GetIndex()[d]);
+              }
+            }
+          }
+        }
+
+        ImageExtrema convolutionImageInformation;
+
+        if (numberOfCenters > 0)
+        {
+          typename InputImageType::RegionType centerRegion;
+          centerRegion.SetIndex(lowerCenterIndex);
+          for (unsigned int d = 0; d < VImageDimension; ++d)
+          {
+            centerRegion.SetSize(d, upperCenterIndex[d] - lowerCenterIndex[d] + 1);
+          }
+
+          typename ConvolutionImageType::Pointer convolutionImage =
+            this->GenerateConvolutionImage(inputImage, centerRegion, maskImage.GetPointer(), label, numberOfCenters);
+
+          if (convolutionImage.IsNull())
+          {
+            MITK_ERROR << "Empty convolution image in CalculateHotspotStatistics(). We should never reach this state (logic error).";
+            throw std::logic_error("Empty convolution image in CalculateHotspotStatistics()");
+          }
+
+          // find maximum in convolution image, given the current mask
+          convolutionImageInformation = CalculateExtremaWorld(convolutionImage.GetPointer(), maskImage, centerRegion, label);
+        }
 
         bool isHotspotDefined = convolutionImageInformation.Defined;
 
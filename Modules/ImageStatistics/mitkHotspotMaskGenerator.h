@@ -33,6 +33,10 @@ namespace mitk
      * The maximum value of the convolved image then corresponds to the hotspot.
      * If a maskGenerator is set, only the pixels of the convolved image where the corresponding mask is == @a label
      * are searched for the maximum value.
+     * The convolution is only computed where it is needed: The fourier domain convolution is restricted to the
+     * bounding box of the possible hotspot centers (enlarged by the kernel radius). If the number of possible centers
+     * is so small that evaluating the kernel directly at each of them is estimated to be cheaper, the convolution is
+     * computed directly at the centers instead. Both ways give the same convolution values at the possible centers.
      */
     class MITKIMAGESTATISTICS_EXPORT HotspotMaskGenerator: public MaskGenerator
     {
@@ -130,10 +134,26 @@ namespace mitk
         itk::SmartPointer< itk::Image<float, VImageDimension> >
           GenerateHotspotSearchConvolutionKernel(double spacing[VImageDimension], double radiusInMM);
 
-        /** \brief Convolves image with spherical kernel image. Used for hotspot calculation.   */
+        /** \brief Convolves image with spherical kernel image. Used for hotspot calculation.
+         * The convolution image is only valid within @a centerRegion at the @a numberOfCenters voxels where
+         * @a maskImage is == @a label. */
         template <typename TPixel, unsigned int VImageDimension>
         itk::SmartPointer< itk::Image<TPixel, VImageDimension> >
-          GenerateConvolutionImage( const itk::Image<TPixel, VImageDimension>* inputImage );
+          GenerateConvolutionImage( const itk::Image<TPixel, VImageDimension>* inputImage,
+                                    const itk::ImageRegion<VImageDimension>& centerRegion,
+                                    const itk::Image<unsigned short, VImageDimension>* maskImage,
+                                    unsigned int label,
+                                    itk::SizeValueType numberOfCenters );
+
+        /** \brief Evaluates the convolution with the kernel image directly at the voxels of @a centerRegion where
+         * @a maskImage is == @a label. */
+        template <typename TPixel, unsigned int VImageDimension>
+        itk::SmartPointer< itk::Image<TPixel, VImageDimension> >
+          GenerateConvolutionImageAtCenters( const itk::Image<TPixel, VImageDimension>* inputImage,
+                                             const itk::Image<float, VImageDimension>* convolutionKernel,
+                                             const itk::ImageRegion<VImageDimension>& centerRegion,
+                                             const itk::Image<unsigned short, VImageDimension>* maskImage,
+                                             unsigned int label );
 
 
         /** \brief Fills pixels of the spherical hotspot mask. */
@@ -155,7 +175,7 @@ namespace mitk
         template <typename TPixel, unsigned int VImageDimension  >
         ImageExtrema CalculateExtremaWorld( const itk::Image<TPixel, VImageDimension>* inputImage,
                                                         typename itk::Image<unsigned short, VImageDimension>::Pointer maskImage,
-                                                        double neccessaryDistanceToImageBorderInMM,
+                                                        const itk::ImageRegion<VImageDimension>& allowedExtremaRegion,
                                                         unsigned int label);
 
         bool IsUpdateRequired() const;
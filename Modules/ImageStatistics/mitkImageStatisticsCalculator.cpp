@@ -19,11 +19,66 @@ found in the LICENSE file.
 #include <mitkImageStatisticsConstants.h>
 #include <mitkImageTimeSelector.h>
 #include <mitkImageToItk.h>
+#include <mitkLabelQuantileImageFilter.h>
 #include <mitkMaskUtilities.h>
 #include <mitkMinMaxImageFilterWithIndex.h>
 #include <mitkMinMaxLabelmageFilterWithIndex.h>
+#include <mitkSinglePassLabelStatisticsImageFilter.h>
 #include <mitkitkMaskImageFilter.h>
 
+#include <itkImageDuplicator.h>
+#include <itkImageRegionConstIteratorWithIndex.h>
+#include <itkImageRegionIteratorWithIndex.h>
+
+#include <limits>
+#include <set>
+
+namespace
+{
+  /** Data of a time step that is needed to update its label statistics incrementally (see
+   * ImageStatisticsCalculator::UpdateStatisticsForChangedMaskRegion()).*/
+  template <typename TPixel, unsigned int VImageDimension>
+  class LabelStatisticsUpdateState : public itk::Object
+  {
+  public:
+    typedef LabelStatisticsUpdateState Self;
+    typedef itk::Object Superclass;
+    typedef itk::SmartPointer<Self> Pointer;
+    typedef itk::SmartPointer<const Self> ConstPointer;
+
+    itkFactorylessNewMacro(Self);
+
+    typedef itk::Image<TPixel, VImageDimension> ImageType;
+    typedef itk::Image<mitk::ImageStatisticsCalculator::MaskPixelType, VImageDimension> MaskType;
+    typedef itk::SinglePassLabelStatisticsImageFilter<ImageType, MaskType> FilterType;
+
+    /** Image the statistics were computed on (image region covered by the mask).*/
+    typename ImageType::ConstPointer m_StatisticsImage;
+    /** Copy of the label map of the last computation or update.*/
+    typename MaskType::Pointer m_LabelMap;
+    /** Filter of the computation; holds the accumulated statistics including the value counts of every label.*/
+    typename FilterType::Pointer m_Filter;
+
+  protected:
+    LabelStatisticsUpdateState() = default;
+    ~LabelStatisticsUpdateState() override = default;
+  };
+
+  /** Checks if index a is visited before index b when iterating over a region (the first dimension is the fastest).*/
+  template <typename TIndex>
+  bool PrecedesInMemoryOrder(const TIndex &a, const TIndex &b)
+  {
+    for (unsigned int i = TIndex::GetIndexDimension(); i > 0; --i)
+    {
+      if (a[i - 1] != b[i - 1])
+      {
+        return a[i - 1] < b[i - 1];
+      }
+    }
+    return false;
+  }
+}
+
 namespace mitk
 {
   void ImageStatisticsCalculator::SetInputImage(const mitk::Image *image)
@@ -104,55 +159,7 @@ namespace mitk
 
     if (IsUpdateRequired(label))
     {
-      auto timeGeometry = m_Image->GetTimeGeometry();
-      // always compute statistics on all timesteps
-      for (unsigned int timeStep = 0; timeStep < m_Image->GetTimeSteps(); timeStep++)
-      {
-        if (m_MaskGenerator.IsNotNull())
-        {
-          m_MaskGenerator->SetTimeStep(timeStep);
-          //See T25625: otherwise, the mask is not computed again after setting a different time step
-          m_MaskGenerator->Modified();
-          m_InternalMask = m_MaskGenerator->GetMask();
-          if (m_MaskGenerator->GetReferenceImage().IsNotNull())
-          {
-            m_InternalImageForStatistics = m_MaskGenerator->GetReferenceImage();
-          }
-          else
-          {
-            m_InternalImageForStatistics = m_Image;
-          }
-        }
-        else
-        {
-          m_InternalImageForStatistics = m_Image;
-        }
-
-        if (m_SecondaryMaskGenerator.IsNotNull())
-        {
-          m_SecondaryMaskGenerator->SetTimeStep(timeStep);
-          m_SecondaryMask = m_SecondaryMaskGenerator->GetMask();
-        }
-
-        ImageTimeSelector::Pointer imgTimeSel = ImageTimeSelector::New();
-        imgTimeSel->SetInput(m_InternalImageForStatistics);
-        imgTimeSel->SetTimeNr(timeStep);
-        imgTimeSel->UpdateLargestPossibleRegion();
-        imgTimeSel->Update();
-        m_ImageTimeSlice = imgTimeSel->GetOutput();
-
-        // Calculate statistics with/without mask
-        if (m_MaskGenerator.IsNull() && m_SecondaryMaskGenerator.IsNull())
-        {
-          // 1) calculate statistics unmasked:
-          AccessByItk_2(m_ImageTimeSlice, InternalCalculateStatisticsUnmasked, timeGeometry, timeStep)
-        }
-        else
-        {
-          // 2) calculate statistics masked
-          AccessByItk_2(m_ImageTimeSlice, InternalCalculateStatisticsMasked, timeGeometry, timeStep)
-        }
-      }
+      CalculateStatistics();
     }
 
     auto it = m_StatisticContainers.find(label);
@@ -167,6 +174,61 @@ namespace mitk
     }
   }
 
+  void ImageStatisticsCalculator::CalculateStatistics()
+  {
+    m_IncrementalUpdateStates.clear();
+
+    auto timeGeometry = m_Image->GetTimeGeometry();
+    // always compute statistics on all timesteps
+    for (unsigned int timeStep = 0; timeStep < m_Image->GetTimeSteps(); timeStep++)
+    {
+      if (m_MaskGenerator.IsNotNull())
+      {
+        m_MaskGenerator->SetTimeStep(timeStep);
+        //See T25625: otherwise, the mask is not computed again after setting a different time step
+        m_MaskGenerator->Modified();
+        m_InternalMask = m_MaskGenerator->GetMask();
+        if (m_MaskGenerator->GetReferenceImage().IsNotNull())
+        {
+          m_InternalImageForStatistics = m_MaskGenerator->GetReferenceImage();
+        }
+        else
+        {
+          m_InternalImageForStatistics = m_Image;
+        }
+      }
+      else
+      {
+        m_InternalImageForStatistics = m_Image;
+      }
+
+      if (m_SecondaryMaskGenerator.IsNotNull())
+      {
+        m_SecondaryMaskGenerator->SetTimeStep(timeStep);
+        m_SecondaryMask = m_SecondaryMaskGenerator->GetMask();
+      }
+
+      ImageTimeSelector::Pointer imgTimeSel = ImageTimeSelector::New();
+      imgTimeSel->SetInput(m_InternalImageForStatistics);
+      imgTimeSel->SetTimeNr(timeStep);
+      imgTimeSel->UpdateLargestPossibleRegion();
+      imgTimeSel->Update();
+      m_ImageTimeSlice = imgTimeSel->GetOutput();
+
+      // Calculate statistics with/without mask
+      if (m_MaskGenerator.IsNull() && m_SecondaryMaskGenerator.IsNull())
+      {
+        // 1) calculate statistics unmasked:
+        AccessByItk_2(m_ImageTimeSlice, InternalCalculateStatisticsUnmasked, timeGeometry, timeStep)
+      }
+      else
+      {
+        // 2) calculate statistics masked
+        AccessByItk_2(m_ImageTimeSlice, InternalCalculateStatisticsMasked, timeGeometry, timeStep)
+      }
+    }
+  }
+
   template <typename TPixel, unsigned int VImageDimension>
   void ImageStatisticsCalculator::InternalCalculateStatisticsUnmasked(
     typename itk::Image<TPixel, VImageDimension> *image, const TimeGeometry *timeGeometry, TimeStepType timeStep)
@@ -250,6 +312,25 @@ namespace mitk
       mitkThrow() << "Image statistics calculation failed due to following ITK Exception: \n " << e.what();
     }
 
+    ImageStatisticsContainer::RealType median = statisticsFilter->GetMedian();
+    if (m_UseExactMedian)
+    {
+      typedef itk::LabelQuantileImageFilter<ImageType, itk::Image<MaskPixelType, VImageDimension>> QuantileFilterType;
+      typename QuantileFilterType::Pointer quantileFilter = QuantileFilterType::New();
+      quantileFilter->SetInput(image);
+      quantileFilter->SetTolerance(m_ExactMedianTolerance);
+      try
+      {
+        quantileFilter->UpdateLargestPossibleRegion();
+      }
+      catch (const itk::ExceptionObject &e)
+      {
+        mitkThrow() << "Image statistics calculation failed due to following ITK Exception: \n " << e.what();
+      }
+      // without label image all voxels have label 1
+      median = quantileFilter->GetQuantiles(1).front();
+    }
+
     auto voxelVolume = GetVoxelVolume<TPixel, VImageDimension>(image);
 
     auto numberOfPixels = image->GetLargestPossibleRegion().GetNumberOfPixels();
@@ -273,7 +354,7 @@ namespace mitk
     statObj.AddStatistic(mitk::ImageStatisticsConstants::RMS(), rms);
     statObj.AddStatistic(mitk::ImageStatisticsConstants::MPP(), statisticsFilter->GetMPP());
     statObj.AddStatistic(mitk::ImageStatisticsConstants::ENTROPY(), statisticsFilter->GetEntropy());
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::MEDIAN(), statisticsFilter->GetMedian());
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MEDIAN(), median);
     statObj.AddStatistic(mitk::ImageStatisticsConstants::UNIFORMITY(), statisticsFilter->GetUniformity());
     statObj.AddStatistic(mitk::ImageStatisticsConstants::UPP(), statisticsFilter->GetUPP());
     statObj.m_Histogram = statisticsFilter->GetHistogram().GetPointer();
@@ -373,137 +454,499 @@ namespace mitk
 
     adaptedImage = maskUtil->ExtractMaskImageRegion(); // this also checks mask sanity
 
-    // find min, max, minindex and maxindex
-    typename MinMaxLabelFilterType::Pointer minMaxFilter = MinMaxLabelFilterType::New();
-    minMaxFilter->SetInput(adaptedImage);
-    minMaxFilter->SetLabelInput(maskImage);
-    minMaxFilter->UpdateLargestPossibleRegion();
+    if (std::numeric_limits<TPixel>::is_integer)
+    {
+      // statistics of all labels with one pass over the image
+      InternalCalculateLabelStatisticsSinglePass<TPixel, VImageDimension>(
+        image, adaptedImage.GetPointer(), maskImage.GetPointer(), timeGeometry, timeStep);
+    }
+    else
+    {
+      // the single pass counts the distinct pixel values per label, which does not pay off for floating point images.
+      // Thus min/max and the remaining statistics are computed in separate passes.
 
-    // set histogram parameters for each label individually (min/max may be different for each label)
-    typedef typename std::map<LabelPixelType, InputImgPixelType> MapType;
-    typedef typename std::pair<LabelPixelType, InputImgPixelType> PairType;
+      // find min, max, minindex and maxindex
+      typename MinMaxLabelFilterType::Pointer minMaxFilter = MinMaxLabelFilterType::New();
+      minMaxFilter->SetInput(adaptedImage);
+      minMaxFilter->SetLabelInput(maskImage);
+      minMaxFilter->UpdateLargestPossibleRegion();
 
-    std::vector<LabelPixelType> relevantLabels = minMaxFilter->GetRelevantLabels();
-    MapType minVals;
-    MapType maxVals;
-    std::map<LabelPixelType, unsigned int> nBins;
+      // set histogram parameters for each label individually (min/max may be different for each label)
+      typedef typename std::map<LabelPixelType, InputImgPixelType> MapType;
+      typedef typename std::pair<LabelPixelType, InputImgPixelType> PairType;
 
-    for (LabelPixelType label : relevantLabels)
-    {
-      minVals.insert(PairType(label, minMaxFilter->GetMin(label)));
-      maxVals.insert(PairType(label, minMaxFilter->GetMax(label)));
+      std::vector<LabelPixelType> relevantLabels = minMaxFilter->GetRelevantLabels();
+      MapType minVals;
+      MapType maxVals;
+      std::map<LabelPixelType, unsigned int> nBins;
 
-      unsigned int nBinsForHistogram;
-      if (m_UseBinSizeOverNBins)
+      for (LabelPixelType label : relevantLabels)
       {
-        nBinsForHistogram =
-          std::max(static_cast<double>(std::ceil(minMaxFilter->GetMax(label) - minMaxFilter->GetMin(label))) /
-                     m_binSizeForHistogramStatistics,
-                   10.); // do not allow less than 10 bins
+        minVals.insert(PairType(label, minMaxFilter->GetMin(label)));
+        maxVals.insert(PairType(label, minMaxFilter->GetMax(label)));
+
+        unsigned int nBinsForHistogram;
+        if (m_UseBinSizeOverNBins)
+        {
+          nBinsForHistogram =
+            std::max(static_cast<double>(std::ceil(minMaxFilter->GetMax(label) - minMaxFilter->GetMin(label))) /
+                       m_binSizeForHistogramStatistics,
+                     10.); // do not allow less than 10 bins
+        }
+        else
+        {
+          nBinsForHistogram = m_nBinsForHistogramStatistics;
+        }
+
+        nBins.insert(typename std::pair<LabelPixelType, unsigned int>(label, nBinsForHistogram));
       }
-      else
+
+      typename ImageStatisticsFilterType::Pointer imageStatisticsFilter = ImageStatisticsFilterType::New();
+      imageStatisticsFilter->SetDirectionTolerance(0.001);
+      imageStatisticsFilter->SetCoordinateTolerance(0.001);
+      imageStatisticsFilter->SetInput(adaptedImage);
+      imageStatisticsFilter->SetLabelInput(maskImage);
+      imageStatisticsFilter->SetHistogramParametersForLabels(nBins, minVals, maxVals);
+      imageStatisticsFilter->Update();
+
+      typedef itk::LabelQuantileImageFilter<ImageType, MaskType> QuantileFilterType;
+      typename QuantileFilterType::Pointer quantileFilter;
+      if (m_UseExactMedian)
       {
-        nBinsForHistogram = m_nBinsForHistogramStatistics;
+        quantileFilter = QuantileFilterType::New();
+        quantileFilter->SetInput(adaptedImage);
+        quantileFilter->SetLabelInput(maskImage);
+        quantileFilter->SetTolerance(m_ExactMedianTolerance);
+        quantileFilter->UpdateLargestPossibleRegion();
+      }
+
+      std::list<int> labels = imageStatisticsFilter->GetRelevantLabels();
+      auto it = labels.begin();
+
+      while (it != labels.end())
+      {
+        ImageStatisticsContainer::Pointer statisticContainerForLabelImage;
+        auto labelIt = m_StatisticContainers.find(*it);
+        // reset if statisticContainer already exist
+        if (labelIt != m_StatisticContainers.end())
+        {
+          statisticContainerForLabelImage = labelIt->second;
+        }
+        // create new statisticContainer
+        else
+        {
+          statisticContainerForLabelImage = ImageStatisticsContainer::New();
+          statisticContainerForLabelImage->SetTimeGeometry(const_cast<mitk::TimeGeometry*>(timeGeometry));
+          // link label (*it) to statisticContainer
+          m_StatisticContainers.emplace(*it, statisticContainerForLabelImage);
+        }
+
+        ImageStatisticsContainer::ImageStatisticsObject statObj;
+
+        // find min, max, minindex and maxindex
+        // make sure to only look in the masked region, use a masker for this
+
+        vnl_vector<int> minIndex, maxIndex;
+        mitk::Point3D worldCoordinateMin;
+        mitk::Point3D worldCoordinateMax;
+        mitk::Point3D indexCoordinateMin;
+        mitk::Point3D indexCoordinateMax;
+        m_InternalImageForStatistics->GetGeometry()->IndexToWorld(minMaxFilter->GetMinIndex(*it), worldCoordinateMin);
+        m_InternalImageForStatistics->GetGeometry()->IndexToWorld(minMaxFilter->GetMaxIndex(*it), worldCoordinateMax);
+        m_Image->GetGeometry()->WorldToIndex(worldCoordinateMin, indexCoordinateMin);
+        m_Image->GetGeometry()->WorldToIndex(worldCoordinateMax, indexCoordinateMax);
+
+        minIndex.set_size(3);
+        maxIndex.set_size(3);
+
+        // for (unsigned int i=0; i < tmpMaxIndex.GetIndexDimension(); i++)
+        for (unsigned int i = 0; i < 3; i++)
+        {
+          minIndex[i] = indexCoordinateMin[i];
+          maxIndex[i] = indexCoordinateMax[i];
+        }
+
+        statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUMPOSITION(), minIndex);
+        statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUMPOSITION(), maxIndex);
+
+        assert(std::abs(minMaxFilter->GetMax(*it) - imageStatisticsFilter->GetMaximum(*it)) < mitk::eps);
+        assert(std::abs(minMaxFilter->GetMin(*it) - imageStatisticsFilter->GetMinimum(*it)) < mitk::eps);
+
+        auto voxelVolume = GetVoxelVolume<TPixel, VImageDimension>(image);
+        auto numberOfVoxels =
+          static_cast<unsigned long>(imageStatisticsFilter->GetSum(*it) / (double)imageStatisticsFilter->GetMean(*it));
+        auto volume = static_cast<double>(numberOfVoxels) * voxelVolume;
+        auto rms = std::sqrt(std::pow(imageStatisticsFilter->GetMean(*it), 2.) +
+                             imageStatisticsFilter->GetVariance(*it)); // variance = sigma^2
+        auto variance = imageStatisticsFilter->GetSigma(*it) * imageStatisticsFilter->GetSigma(*it);
+
+        statObj.AddStatistic(mitk::ImageStatisticsConstants::NUMBEROFVOXELS(), numberOfVoxels);
+        statObj.AddStatistic(mitk::ImageStatisticsConstants::VOLUME(), volume);
+        statObj.AddStatistic(mitk::ImageStatisticsConstants::MEAN(), imageStatisticsFilter->GetMean(*it));
+        statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUM(), imageStatisticsFilter->GetMinimum(*it));
+        statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUM(), imageStatisticsFilter->GetMaximum(*it));
+        statObj.AddStatistic(mitk::ImageStatisticsConstants::STANDARDDEVIATION(), imageStatisticsFilter->GetSigma(*it));
+        statObj.AddStatistic(mitk::ImageStatisticsConstants::VARIANCE(), variance);
+        statObj.AddStatistic(mitk::ImageStatisticsConstants::SKEWNESS(), imageStatisticsFilter->GetSkewness(*it));
+        statObj.AddStatistic(mitk::ImageStatisticsConstants::KURTOSIS(), imageStatisticsFilter->GetKurtosis(*it));
+        statObj.AddStatistic(mitk::ImageStatisticsConstants::RMS(), rms);
+        statObj.AddStatistic(mitk::ImageStatisticsConstants::MPP(), imageStatisticsFilter->GetMPP(*it));
+        statObj.AddStatistic(mitk::ImageStatisticsConstants::ENTROPY(), imageStatisticsFilter->GetEntropy(*it));
+        statObj.AddStatistic(mitk::ImageStatisticsConstants::MEDIAN(),
+                             quantileFilter.IsNotNull() ? quantileFilter->GetQuantiles(*it).front()
+                                                        : imageStatisticsFilter->GetMedian(*it));
+        statObj.AddStatistic(mitk::ImageStatisticsConstants::UNIFORMITY(), imageStatisticsFilter->GetUniformity(*it));
+        statObj.AddStatistic(mitk::ImageStatisticsConstants::UPP(), imageStatisticsFilter->GetUPP(*it));
+        statObj.m_Histogram = imageStatisticsFilter->GetHistogram(*it).GetPointer();
+
+        statisticContainerForLabelImage->SetStatisticsForTimeStep(timeStep, statObj);
+        ++it;
       }
 
-      nBins.insert(typename std::pair<LabelPixelType, unsigned int>(label, nBinsForHistogram));
     }
 
-    typename ImageStatisticsFilterType::Pointer imageStatisticsFilter = ImageStatisticsFilterType::New();
-    imageStatisticsFilter->SetDirectionTolerance(0.001);
-    imageStatisticsFilter->SetCoordinateTolerance(0.001);
-    imageStatisticsFilter->SetInput(adaptedImage);
-    imageStatisticsFilter->SetLabelInput(maskImage);
-    imageStatisticsFilter->SetHistogramParametersForLabels(nBins, minVals, maxVals);
-    imageStatisticsFilter->Update();
+    // swap maskGenerators back
+    if (swapMasks)
+    {
+      m_SecondaryMask = m_InternalMask;
+      m_InternalMask = nullptr;
+    }
+  }
 
-    std::list<int> labels = imageStatisticsFilter->GetRelevantLabels();
-    auto it = labels.begin();
+  template <typename TPixel, unsigned int VImageDimension>
+  void ImageStatisticsCalculator::InternalCalculateLabelStatisticsSinglePass(
+    typename itk::Image<TPixel, VImageDimension> *image,
+    const typename itk::Image<TPixel, VImageDimension> *adaptedImage,
+    const typename itk::Image<MaskPixelType, VImageDimension> *maskImage,
+    const TimeGeometry *timeGeometry,
+    unsigned int timeStep)
+  {
+    typedef LabelStatisticsUpdateState<TPixel, VImageDimension> UpdateStateType;
+    typedef typename UpdateStateType::FilterType LabelStatisticsFilterType;
+
+    const bool keepUpdateState =
+      m_IncrementalMaskUpdates && m_MaskGenerator.IsNotNull() && m_SecondaryMaskGenerator.IsNull();
+
+    typename LabelStatisticsFilterType::Pointer labelStatisticsFilter = LabelStatisticsFilterType::New();
+    labelStatisticsFilter->SetInput(adaptedImage);
+    labelStatisticsFilter->SetLabelInput(maskImage);
+    labelStatisticsFilter->SetDirectionTolerance(0.001);
+    labelStatisticsFilter->SetCoordinateTolerance(0.001);
+    labelStatisticsFilter->SetKeepValueCounts(keepUpdateState);
+    if (m_UseBinSizeOverNBins)
+    {
+      labelStatisticsFilter->SetBinSize(m_binSizeForHistogramStatistics);
+    }
+    else
+    {
+      labelStatisticsFilter->SetNumberOfBins(m_nBinsForHistogramStatistics);
+    }
 
-    while (it != labels.end())
+    try
     {
-      ImageStatisticsContainer::Pointer statisticContainerForLabelImage;
-      auto labelIt = m_StatisticContainers.find(*it);
-      // reset if statisticContainer already exist
-      if (labelIt != m_StatisticContainers.end())
+      labelStatisticsFilter->UpdateLargestPossibleRegion();
+    }
+    catch (const itk::ExceptionObject &e)
+    {
+      mitkThrow() << "Image statistics calculation failed due to following ITK Exception: \n " << e.what();
+    }
+
+    auto voxelVolume = GetVoxelVolume<TPixel, VImageDimension>(image);
+
+    for (auto label : labelStatisticsFilter->GetRelevantLabels())
+    {
+      this->SetLabelStatistics(label, labelStatisticsFilter->GetLabelStatistics(label), voxelVolume,
+        m_InternalImageForStatistics, timeGeometry, timeStep);
+    }
+
+    if (keepUpdateState)
+    {
+      // the mask may be changed in place after this computation, so a copy of the label map is kept
+      typedef itk::ImageDuplicator<typename UpdateStateType::MaskType> DuplicatorType;
+      typename DuplicatorType::Pointer duplicator = DuplicatorType::New();
+      duplicator->SetInputImage(maskImage);
+      duplicator->Update();
+
+      typename UpdateStateType::Pointer labelState = UpdateStateType::New();
+      labelState->m_StatisticsImage = adaptedImage;
+      labelState->m_LabelMap = duplicator->GetOutput();
+      labelState->m_Filter = labelStatisticsFilter;
+
+      IncrementalUpdateState state;
+      state.imageTimeSlice = m_ImageTimeSlice;
+      state.referenceImage = m_InternalImageForStatistics;
+      state.labelStatistics = labelState.GetPointer();
+      m_IncrementalUpdateStates[timeStep] = state;
+    }
+  }
+
+  void ImageStatisticsCalculator::UpdateStatisticsForChangedMaskRegion(const MaskRegionType &changedRegion,
+                                                                       TimeStepType timeStep)
+  {
+    if (m_Image.IsNull())
+    {
+      mitkThrow() << "no image";
+    }
+
+    if (!m_Image->IsInitialized())
+    {
+      mitkThrow() << "Image not initialized!";
+    }
+
+    bool updated = false;
+    auto stateIt = m_IncrementalUpdateStates.find(timeStep);
+    if (m_IncrementalMaskUpdates && m_MaskGenerator.IsNotNull() && m_SecondaryMaskGenerator.IsNull() &&
+        stateIt != m_IncrementalUpdateStates.end())
+    {
+      const auto stateTimeStamp = stateIt->second.labelStatistics->GetMTime();
+      if (this->GetMTime() < stateTimeStamp && m_Image->GetMTime() < stateTimeStamp &&
+          stateIt->second.referenceImage->GetMTime() < stateTimeStamp)
       {
-        statisticContainerForLabelImage = labelIt->second;
+        AccessByItk_3(stateIt->second.imageTimeSlice,
+                      InternalUpdateStatisticsForChangedMaskRegion,
+                      changedRegion,
+                      timeStep,
+                      updated)
       }
-      // create new statisticContainer
-      else
+    }
+
+    if (!updated)
+    {
+      CalculateStatistics();
+    }
+  }
+
+  template <typename TPixel, unsigned int VImageDimension>
+  void ImageStatisticsCalculator::InternalUpdateStatisticsForChangedMaskRegion(
+    typename itk::Image<TPixel, VImageDimension> *image,
+    const MaskRegionType &changedRegion,
+    TimeStepType timeStep,
+    bool &updated)
+  {
+    typedef LabelStatisticsUpdateState<TPixel, VImageDimension> UpdateStateType;
+    typedef typename UpdateStateType::ImageType ImageType;
+    typedef typename UpdateStateType::MaskType MaskType;
+    typedef typename UpdateStateType::FilterType LabelStatisticsFilterType;
+    typedef typename MaskType::PixelType LabelPixelType;
+
+    updated = false;
+
+    const IncrementalUpdateState &state = m_IncrementalUpdateStates[timeStep];
+    auto labelState = dynamic_cast<UpdateStateType *>(state.labelStatistics.GetPointer());
+    if (nullptr == labelState)
+    {
+      return;
+    }
+
+    m_MaskGenerator->SetTimeStep(timeStep);
+    m_MaskGenerator->Modified();
+    m_InternalMask = m_MaskGenerator->GetMask();
+
+    typename MaskType::Pointer maskImage = MaskType::New();
+    try
+    {
+      maskImage = ImageToItkImage<MaskPixelType, VImageDimension>(m_InternalMask);
+    }
+    catch (const itk::ExceptionObject &)
+    {
+      CastToItkImage(m_InternalMask, maskImage);
+    }
+
+    auto &labelStatistics = labelState->m_Filter->GetLabelStatisticsMap();
+
+    typename MaskType::RegionType labelMapRegion = labelState->m_LabelMap->GetLargestPossibleRegion();
+    if (maskImage->GetLargestPossibleRegion() != labelMapRegion)
+    {
+      return;
+    }
+
+    typename MaskType::RegionType region;
+    for (unsigned int i = 0; i < VImageDimension && i < MaskRegionType::ImageDimension; ++i)
+    {
+      region.SetIndex(i, changedRegion.GetIndex(i));
+      region.SetSize(i, changedRegion.GetSize(i));
+    }
+    for (unsigned int i = MaskRegionType::ImageDimension; i < VImageDimension; ++i)
+    {
+      region.SetIndex(i, labelMapRegion.GetIndex(i));
+      region.SetSize(i, labelMapRegion.GetSize(i));
+    }
+
+    std::set<LabelPixelType> changedLabels;
+    std::set<LabelPixelType> labelsWithUnknownExtremaIndices;
+
+    // subtract the changed voxels from their old labels and add them to their new labels
+    if (region.Crop(labelMapRegion))
+    {
+      itk::ImageRegionIteratorWithIndex<MaskType> oldLabelIt(labelState->m_LabelMap, region);
+      itk::ImageRegionConstIterator<MaskType> newLabelIt(maskImage, region);
+      itk::ImageRegionConstIterator<ImageType> valueIt(labelState->m_StatisticsImage, region);
+
+      for (; !oldLabelIt.IsAtEnd(); ++oldLabelIt, ++newLabelIt, ++valueIt)
+      {
+        const LabelPixelType oldLabel = oldLabelIt.Get();
+        const LabelPixelType newLabel = newLabelIt.Get();
+        if (oldLabel == newLabel)
+        {
+          continue;
+        }
+
+        const TPixel value = valueIt.Get();
+        if (!LabelStatisticsFilterType::RemoveValue(
+              labelStatistics[oldLabel], value, oldLabelIt.GetIndex()))
+        {
+          labelsWithUnknownExtremaIndices.insert(oldLabel);
+        }
+        auto &newLabelStats = labelStatistics[newLabel];
+        LabelStatisticsFilterType::AddValue(newLabelStats, value, oldLabelIt.GetIndex());
+        // ties are resolved like in the full pass, which keeps the first voxel in memory order
+        if (value == newLabelStats.m_Minimum && PrecedesInMemoryOrder(oldLabelIt.GetIndex(), newLabelStats.m_MinIndex))
+        {
+          newLabelStats.m_MinIndex = oldLabelIt.GetIndex();
+        }
+        if (value == newLabelStats.m_Maximum && PrecedesInMemoryOrder(oldLabelIt.GetIndex(), newLabelStats.m_MaxIndex))
+        {
+          newLabelStats.m_MaxIndex = oldLabelIt.GetIndex();
+        }
+        oldLabelIt.Set(newLabel);
+
+        changedLabels.insert(oldLabel);
+        changedLabels.insert(newLabel);
+      }
+    }
+
+    for (auto label : changedLabels)
+    {
+      if (labelStatistics[label].m_Count == 0)
       {
-        statisticContainerForLabelImage = ImageStatisticsContainer::New();
-        statisticContainerForLabelImage->SetTimeGeometry(const_cast<mitk::TimeGeometry*>(timeGeometry));
-        // link label (*it) to statisticContainer
-        m_StatisticContainers.emplace(*it, statisticContainerForLabelImage);
+        // a label vanished, its statistics of this time step can only be removed by a complete recomputation
+        return;
       }
+    }
 
-      ImageStatisticsContainer::ImageStatisticsObject statObj;
+    // the extrema of these labels lost their voxel, find the first voxel with the extremal value like the full pass
+    if (!labelsWithUnknownExtremaIndices.empty())
+    {
+      std::map<LabelPixelType, std::pair<bool, bool>> foundExtrema;
+      itk::ImageRegionConstIteratorWithIndex<MaskType> labelIt(labelState->m_LabelMap, labelMapRegion);
+      itk::ImageRegionConstIterator<ImageType> valueIt(labelState->m_StatisticsImage, labelMapRegion);
 
-      // find min, max, minindex and maxindex
-      // make sure to only look in the masked region, use a masker for this
-
-      vnl_vector<int> minIndex, maxIndex;
-      mitk::Point3D worldCoordinateMin;
-      mitk::Point3D worldCoordinateMax;
-      mitk::Point3D indexCoordinateMin;
-      mitk::Point3D indexCoordinateMax;
-      m_InternalImageForStatistics->GetGeometry()->IndexToWorld(minMaxFilter->GetMinIndex(*it), worldCoordinateMin);
-      m_InternalImageForStatistics->GetGeometry()->IndexToWorld(minMaxFilter->GetMaxIndex(*it), worldCoordinateMax);
-      m_Image->GetGeometry()->WorldToIndex(worldCoordinateMin, indexCoordinateMin);
-      m_Image->GetGeometry()->WorldToIndex(worldCoordinateMax, indexCoordinateMax);
-
-      minIndex.set_size(3);
-      maxIndex.set_size(3);
-
-      // for (unsigned int i=0; i < tmpMaxIndex.GetIndexDimension(); i++)
-      for (unsigned int i = 0; i < 3; i++)
+      for (; !labelIt.IsAtEnd(); ++labelIt, ++valueIt)
       {
-        minIndex[i] = indexCoordinateMin[i];
-        maxIndex[i] = indexCoordinateMax[i];
+        const LabelPixelType label = labelIt.Get();
+        if (labelsWithUnknownExtremaIndices.find(label) == labelsWithUnknownExtremaIndices.end())
+        {
+          continue;
+        }
+
+        auto &labelStats = labelStatistics[label];
+        auto &found = foundExtrema[label];
+        if (!found.first && valueIt.Get() == labelStats.m_Minimum)
+        {
+          labelStats.m_MinIndex = labelIt.GetIndex();
+          found.first = true;
+        }
+        if (!found.second && valueIt.Get() == labelStats.m_Maximum)
+        {
+          labelStats.m_MaxIndex = labelIt.GetIndex();
+          found.second = true;
+        }
       }
+    }
+
+    auto voxelVolume = GetVoxelVolume<TPixel, VImageDimension>(image);
+    for (auto label : changedLabels)
+    {
+      auto &labelStats = labelStatistics[label];
+      labelState->m_Filter->ComputeDerivedStatistics(labelStats);
+      this->SetLabelStatistics(
+        label, labelStats, voxelVolume, state.referenceImage, m_Image->GetTimeGeometry(), timeStep);
+    }
 
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUMPOSITION(), minIndex);
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUMPOSITION(), maxIndex);
-
-      assert(std::abs(minMaxFilter->GetMax(*it) - imageStatisticsFilter->GetMaximum(*it)) < mitk::eps);
-      assert(std::abs(minMaxFilter->GetMin(*it) - imageStatisticsFilter->GetMinimum(*it)) < mitk::eps);
-
-      auto voxelVolume = GetVoxelVolume<TPixel, VImageDimension>(image);
-      auto numberOfVoxels =
-        static_cast<unsigned long>(imageStatisticsFilter->GetSum(*it) / (double)imageStatisticsFilter->GetMean(*it));
-      auto volume = static_cast<double>(numberOfVoxels) * voxelVolume;
-      auto rms = std::sqrt(std::pow(imageStatisticsFilter->GetMean(*it), 2.) +
-                           imageStatisticsFilter->GetVariance(*it)); // variance = sigma^2
-      auto variance = imageStatisticsFilter->GetSigma(*it) * imageStatisticsFilter->GetSigma(*it);
-
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::NUMBEROFVOXELS(), numberOfVoxels);
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::VOLUME(), volume);
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::MEAN(), imageStatisticsFilter->GetMean(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUM(), imageStatisticsFilter->GetMinimum(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUM(), imageStatisticsFilter->GetMaximum(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::STANDARDDEVIATION(), imageStatisticsFilter->GetSigma(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::VARIANCE(), variance);
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::SKEWNESS(), imageStatisticsFilter->GetSkewness(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::KURTOSIS(), imageStatisticsFilter->GetKurtosis(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::RMS(), rms);
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::MPP(), imageStatisticsFilter->GetMPP(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::ENTROPY(), imageStatisticsFilter->GetEntropy(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::MEDIAN(), imageStatisticsFilter->GetMedian(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::UNIFORMITY(), imageStatisticsFilter->GetUniformity(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::UPP(), imageStatisticsFilter->GetUPP(*it));
-      statObj.m_Histogram = imageStatisticsFilter->GetHistogram(*it).GetPointer();
-
-      statisticContainerForLabelImage->SetStatisticsForTimeStep(timeStep, statObj);
-      ++it;
+    // the statistics of all labels are up to date with the changed mask now
+    for (auto &container : m_StatisticContainers)
+    {
+      container.second->Modified();
     }
+    labelState->Modified();
 
-    // swap maskGenerators back
-    if (swapMasks)
+    updated = true;
+  }
+
+  template <typename TLabelStatistics>
+  void ImageStatisticsCalculator::SetLabelStatistics(LabelIndex label,
+                                                     const TLabelStatistics &labelStats,
+                                                     double voxelVolume,
+                                                     const mitk::Image *referenceImage,
+                                                     const TimeGeometry *timeGeometry,
+                                                     TimeStepType timeStep)
+  {
+    ImageStatisticsContainer::Pointer statisticContainerForLabelImage;
+    auto labelIt = m_StatisticContainers.find(label);
+    // reset if statisticContainer already exist
+    if (labelIt != m_StatisticContainers.end())
     {
-      m_SecondaryMask = m_InternalMask;
-      m_InternalMask = nullptr;
+      statisticContainerForLabelImage = labelIt->second;
+    }
+    // create new statisticContainer
+    else
+    {
+      statisticContainerForLabelImage = ImageStatisticsContainer::New();
+      statisticContainerForLabelImage->SetTimeGeometry(const_cast<mitk::TimeGeometry*>(timeGeometry));
+      m_StatisticContainers.emplace(label, statisticContainerForLabelImage);
+    }
+
+    ImageStatisticsContainer::ImageStatisticsObject statObj;
+
+    // the indices refer to the image the statistics are computed on, convert them to indices of the input image
+    vnl_vector<int> minIndex, maxIndex;
+    mitk::Point3D worldCoordinateMin;
+    mitk::Point3D worldCoordinateMax;
+    mitk::Point3D indexCoordinateMin;
+    mitk::Point3D indexCoordinateMax;
+    referenceImage->GetGeometry()->IndexToWorld(labelStats.m_MinIndex, worldCoordinateMin);
+    referenceImage->GetGeometry()->IndexToWorld(labelStats.m_MaxIndex, worldCoordinateMax);
+    m_Image->GetGeometry()->WorldToIndex(worldCoordinateMin, indexCoordinateMin);
+    m_Image->GetGeometry()->WorldToIndex(worldCoordinateMax, indexCoordinateMax);
+
+    minIndex.set_size(3);
+    maxIndex.set_size(3);
+
+    for (unsigned int i = 0; i < 3; i++)
+    {
+      minIndex[i] = indexCoordinateMin[i];
+      maxIndex[i] = indexCoordinateMax[i];
     }
+
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUMPOSITION(), minIndex);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUMPOSITION(), maxIndex);
+
+    auto numberOfVoxels = static_cast<ImageStatisticsContainer::VoxelCountType>(labelStats.m_Count);
+    auto volume = static_cast<double>(numberOfVoxels) * voxelVolume;
+    auto rms = std::sqrt(std::pow(labelStats.m_Mean, 2.) + labelStats.m_Variance); // variance = sigma^2
+    auto variance = labelStats.m_Sigma * labelStats.m_Sigma;
+
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::NUMBEROFVOXELS(), numberOfVoxels);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::VOLUME(), volume);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MEAN(), labelStats.m_Mean);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUM(),
+                         static_cast<ImageStatisticsContainer::RealType>(labelStats.m_Minimum));
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUM(),
+                         static_cast<ImageStatisticsContainer::RealType>(labelStats.m_Maximum));
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::STANDARDDEVIATION(), labelStats.m_Sigma);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::VARIANCE(), variance);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::SKEWNESS(), labelStats.m_Skewness);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::KURTOSIS(), labelStats.m_Kurtosis);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::RMS(), rms);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MPP(), labelStats.m_MPP);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::ENTROPY(), labelStats.m_Entropy);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MEDIAN(),
+                         m_UseExactMedian ? labelStats.m_ExactMedian : labelStats.m_Median);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::UNIFORMITY(), labelStats.m_Uniformity);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::UPP(), labelStats.m_UPP);
+    statObj.m_Histogram = labelStats.m_Histogram.GetPointer();
+
+    statisticContainerForLabelImage->SetStatisticsForTimeStep(timeStep, statObj);
   }
 
   bool ImageStatisticsCalculator::IsUpdateRequired(LabelIndex label) const
@@ -76,15 +76,53 @@ namespace mitk
          */
         ImageStatisticsContainer* GetStatistics(LabelIndex label=1);
 
+        /**Documentation
+        @brief If enabled, the median is computed from the voxel values instead of the histogram (where it is the center of the bin
+        containing the median), so it does not depend on the bin count. For an even number of voxels it is the mean of the two
+        middle values. The values are counted during the single pass for images of integer pixel type, otherwise the median is
+        refined with additional passes (see itk::LabelQuantileImageFilter). Default is false.*/
+        itkSetMacro(UseExactMedian, bool);
+        itkGetConstMacro(UseExactMedian, bool);
+        itkBooleanMacro(UseExactMedian);
+
+        /**Documentation
+        @brief Maximum absolute error of the median if UseExactMedian is enabled and the median has to be refined. Default is 0 (exact).*/
+        itkSetMacro(ExactMedianTolerance, double);
+        itkGetConstMacro(ExactMedianTolerance, double);
+
+        typedef itk::ImageRegion<3> MaskRegionType;
+
+        /**Documentation
+        @brief If enabled, the calculator keeps the per voxel label information and the accumulated values of the last computation,
+        so that UpdateStatisticsForChangedMaskRegion() can update the statistics incrementally. Default is false.*/
+        itkSetMacro(IncrementalMaskUpdates, bool);
+        itkGetConstMacro(IncrementalMaskUpdates, bool);
+        itkBooleanMacro(IncrementalMaskUpdates);
+
+        /**Documentation
+        @brief Updates the statistics after the mask (see SetMask()) of time step @a timeStep was only changed within @a changedRegion
+        (index region of the mask image), e.g. while painting a segmentation. Only the changed voxels are subtracted from the statistics
+        of their old label and added to the statistics of their new label.
+        If no incremental update is possible, the statistics are recomputed completely. This is the case, if incremental mask updates
+        are disabled, the statistics have not been computed yet or the inputs have changed otherwise, a secondary mask is set or the
+        image has no integer pixel type.*/
+        void UpdateStatisticsForChangedMaskRegion(const MaskRegionType& changedRegion, TimeStepType timeStep = 0);
+
     protected:
         ImageStatisticsCalculator(){
             m_nBinsForHistogramStatistics = 100;
             m_binSizeForHistogramStatistics = 10;
             m_UseBinSizeOverNBins = false;
+            m_IncrementalMaskUpdates = false;
+            m_UseExactMedian = false;
+            m_ExactMedianTolerance = 0.;
         };
 
 
     private:
+        //Calculates the statistics of all timesteps
+        void CalculateStatistics();
+
         //Calculates statistics for each timestep for image
         template < typename TPixel, unsigned int VImageDimension > void InternalCalculateStatisticsUnmasked(
                 typename itk::Image< TPixel, VImageDimension >* image, const TimeGeometry* timeGeometry, TimeStepType timeStep);
@@ -93,6 +131,23 @@ namespace mitk
                 typename itk::Image< TPixel, VImageDimension >* image, const TimeGeometry* timeGeometry,
                 unsigned int timeStep);
 
+        //Calculates statistics of all labels with a single pass over adaptedImage (the region of image covered by
+        //maskImage); used for images of integer pixel type
+        template < typename TPixel, unsigned int VImageDimension > void InternalCalculateLabelStatisticsSinglePass(
+                typename itk::Image< TPixel, VImageDimension >* image,
+                const typename itk::Image< TPixel, VImageDimension >* adaptedImage,
+                const typename itk::Image< MaskPixelType, VImageDimension >* maskImage,
+                const TimeGeometry* timeGeometry, unsigned int timeStep);
+
+        //Updates the statistics of the labels changed within changedRegion, updated is false if no incremental update is possible
+        template < typename TPixel, unsigned int VImageDimension > void InternalUpdateStatisticsForChangedMaskRegion(
+                typename itk::Image< TPixel, VImageDimension >* image, const MaskRegionType& changedRegion,
+                TimeStepType timeStep, bool& updated);
+
+        //Stores the statistics of a label (see itk::SinglePassLabelStatisticsImageFilter::LabelStatistics)
+        template < typename TLabelStatistics > void SetLabelStatistics(LabelIndex label, const TLabelStatistics& labelStats,
+                double voxelVolume, const mitk::Image* referenceImage, const TimeGeometry* timeGeometry, TimeStepType timeStep);
+
         template < typename TPixel, unsigned int VImageDimension >
         double GetVoxelVolume(typename itk::Image<TPixel, VImageDimension>* image) const;
 
@@ -112,7 +167,22 @@ namespace mitk
         double m_binSizeForHistogramStatistics;
         bool m_UseBinSizeOverNBins;
 
+        bool m_UseExactMedian;
+        double m_ExactMedianTolerance;
+
         std::map<LabelIndex,ImageStatisticsContainer::Pointer> m_StatisticContainers;
+
+        bool m_IncrementalMaskUpdates;
+
+        /** State of the last computation of a time step that is needed for incremental updates.*/
+        struct IncrementalUpdateState
+        {
+          mitk::Image::Pointer imageTimeSlice;
+          mitk::Image::ConstPointer referenceImage;
+          /** Label map, statistics image and accumulated label statistics (type depends on the pixel type).*/
+          itk::Object::Pointer labelStatistics;
+        };
+        std::map<TimeStepType, IncrementalUpdateState> m_IncrementalUpdateStates;
     };
 
 }
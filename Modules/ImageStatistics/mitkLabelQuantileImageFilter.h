@@ -0,0 +1,167 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITK_LABELQUANTILEIMAGEFILTER_H
+#define MITK_LABELQUANTILEIMAGEFILTER_H
+
+#include <map>
+#include <vector>
+
+#include <itkImage.h>
+#include <itkImageToImageFilter.h>
+
+namespace itk
+{
+  /**
+  * \class LabelQuantileImageFilter
+  * \brief Computes quantiles (e.g. the median) of all labels of a label image independent of any histogram binning.
+  *
+  * The quantiles are determined by bucket refinement: After a first pass that determines the number of voxels and
+  * the value range of every label, every further pass sorts the values of the interval that contains the searched
+  * order statistic into a histogram of fixed size and continues with the bin that contains it. As soon as the
+  * searched interval contains at most GetMaximumNumberOfCollectedValues() values, they are collected and the order
+  * statistic is selected exactly. Thus the memory needed per label and quantile does not depend on the number of
+  * voxels. The refinement also stops if the interval is not wider than the tolerance (the quantile is then the center
+  * of the interval) or it only contains one distinct value.
+  * Quantiles are interpolated linearly between the order statistics (like numpy.quantile), e.g. the median of an
+  * even number of values is the mean of the two middle values.
+  * If no label image is set, all voxels belong to label 1.
+  */
+  template <typename TInputImage, typename TLabelImage>
+  class LabelQuantileImageFilter : public ImageToImageFilter<TInputImage, TInputImage>
+  {
+  public:
+    /** Standard Self typedef */
+    typedef LabelQuantileImageFilter                       Self;
+    typedef ImageToImageFilter< TInputImage, TInputImage > Superclass;
+    typedef SmartPointer< Self >                           Pointer;
+    typedef SmartPointer< const Self >                     ConstPointer;
+
+    /** Method for creation through the object factory. */
+    itkNewMacro(Self);
+
+    /** Runtime information support. */
+    itkTypeMacro(LabelQuantileImageFilter, ImageToImageFilter);
+
+    typedef typename TInputImage::RegionType RegionType;
+    typedef typename TInputImage::PixelType  PixelType;
+    typedef typename NumericTraits< PixelType >::RealType RealType;
+    typedef typename TLabelImage::PixelType  LabelPixelType;
+
+    typedef std::vector<double> ProbabilitiesType;
+    typedef std::vector<RealType> QuantilesType;
+
+    /** Set the label image */
+    void SetLabelInput(const TLabelImage *input)
+    {
+      // Process object is not const-correct so the const casting is required.
+      this->SetNthInput( 1, const_cast< TLabelImage * >( input ) );
+    }
+
+    /** Get the label image */
+    const TLabelImage * GetLabelInput() const
+    {
+      return itkDynamicCastInDebugMode< TLabelImage * >(
+        const_cast< DataObject * >( this->ProcessObject::GetInput(1) ) );
+    }
+
+    /** Probabilities (in [0,1]) of the quantiles that should be computed. Default is {0.5} (median).*/
+    void SetProbabilities(const ProbabilitiesType& probabilities);
+    const ProbabilitiesType& GetProbabilities() const
+    {
+      return m_Probabilities;
+    }
+
+    /** Maximum absolute error of the quantiles. Default is 0 (exact quantiles).*/
+    itkSetMacro(Tolerance, double);
+    itkGetConstMacro(Tolerance, double);
+
+    /** Number of bins used per refinement pass. Default is 256.*/
+    itkSetClampMacro(NumberOfBins, unsigned int, 2, NumericTraits<unsigned int>::max());
+    itkGetConstMacro(NumberOfBins, unsigned int);
+
+    /** Number of values up to which the values of the searched interval are collected and the order statistic is
+    * selected exactly. Default is 4096.*/
+    itkSetMacro(MaximumNumberOfCollectedValues, SizeValueType);
+    itkGetConstMacro(MaximumNumberOfCollectedValues, SizeValueType);
+
+    /** Returns all labels that occur in the label image (only valid after Update()).*/
+    std::vector<LabelPixelType> GetRelevantLabels() const;
+
+    bool HasLabel(LabelPixelType label) const
+    {
+      return m_Quantiles.find(label) != m_Quantiles.end();
+    }
+
+    /** Returns the quantiles of a label in the order of GetProbabilities().
+    * @pre the label must occur in the label image (see HasLabel()).*/
+    const QuantilesType& GetQuantiles(LabelPixelType label) const;
+
+    /** Returns the number of passes over the image of the last update.*/
+    itkGetConstMacro(NumberOfPasses, unsigned int);
+
+  protected:
+    LabelQuantileImageFilter();
+    ~LabelQuantileImageFilter() override {}
+
+    void AllocateOutputs() override;
+
+    void GenerateData() override;
+
+    /** Search state of an order statistic of a label.*/
+    struct OrderStatisticSearch
+    {
+      /** rank (0-based) of the searched value among the values of the label*/
+      SizeValueType m_Rank;
+      /** the searched value lies in [m_Lower, m_Upper]*/
+      PixelType m_Lower;
+      PixelType m_Upper;
+      /** number of values of the label below m_Lower*/
+      SizeValueType m_NumberBelow;
+      /** number of values of the label in [m_Lower, m_Upper]*/
+      SizeValueType m_NumberInInterval;
+      /** the values of the interval are collected in the next pass*/
+      bool m_Collect;
+      bool m_Done;
+      RealType m_Value;
+
+      std::vector<SizeValueType> m_BinCounts;
+      std::vector<PixelType> m_BinMinimum;
+      std::vector<PixelType> m_BinMaximum;
+      std::vector<PixelType> m_CollectedValues;
+    };
+
+    /** Returns the bin of a value of the interval of a search (see OrderStatisticSearch).*/
+    unsigned int GetBin(const OrderStatisticSearch& search, PixelType value) const;
+
+    /** Returns the lower edge of a bin of the interval of a search.*/
+    RealType GetBinEdge(const OrderStatisticSearch& search, unsigned int bin) const;
+
+    /** Evaluates a pass for a search and determines the interval for the next pass (or the value).*/
+    void FinishPass(OrderStatisticSearch& search) const;
+
+  private:
+    ProbabilitiesType m_Probabilities;
+    double m_Tolerance;
+    unsigned int m_NumberOfBins;
+    SizeValueType m_MaximumNumberOfCollectedValues;
+    unsigned int m_NumberOfPasses;
+
+    std::map<LabelPixelType, QuantilesType> m_Quantiles;
+  };
+}
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "mitkLabelQuantileImageFilter.hxx"
+#endif
+
+#endif
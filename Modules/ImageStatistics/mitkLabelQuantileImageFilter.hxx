@@ -0,0 +1,373 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITK_LABELQUANTILEIMAGEFILTER_HXX
+#define MITK_LABELQUANTILEIMAGEFILTER_HXX
+
+#include "mitkLabelQuantileImageFilter.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <itkImageRegionConstIterator.h>
+
+namespace itk
+{
+  template< typename TInputImage, typename TLabelImage >
+  LabelQuantileImageFilter< TInputImage, TLabelImage >::LabelQuantileImageFilter()
+    : m_Probabilities(1, 0.5), m_Tolerance(0.), m_NumberOfBins(256), m_MaximumNumberOfCollectedValues(4096),
+      m_NumberOfPasses(0)
+  {
+  }
+
+  template< typename TInputImage, typename TLabelImage >
+  void LabelQuantileImageFilter< TInputImage, TLabelImage >::SetProbabilities(const ProbabilitiesType& probabilities)
+  {
+    for (auto p : probabilities)
+    {
+      if (p < 0. || p > 1.)
+      {
+        itkExceptionMacro(<< "Invalid quantile probability " << p << ". Probabilities must be in [0,1].");
+      }
+    }
+
+    if (probabilities != m_Probabilities)
+    {
+      m_Probabilities = probabilities;
+      this->Modified();
+    }
+  }
+
+  template< typename TInputImage, typename TLabelImage >
+  std::vector<typename LabelQuantileImageFilter< TInputImage, TLabelImage >::LabelPixelType>
+    LabelQuantileImageFilter< TInputImage, TLabelImage >::GetRelevantLabels() const
+  {
+    std::vector<LabelPixelType> labels;
+    for (auto&& it : m_Quantiles)
+    {
+      labels.push_back(it.first);
+    }
+    return labels;
+  }
+
+  template< typename TInputImage, typename TLabelImage >
+  const typename LabelQuantileImageFilter< TInputImage, TLabelImage >::QuantilesType&
+    LabelQuantileImageFilter< TInputImage, TLabelImage >::GetQuantiles(LabelPixelType label) const
+  {
+    auto it = m_Quantiles.find(label);
+    if (it == m_Quantiles.end())
+    {
+      itkExceptionMacro(<< "Label " << static_cast<double>(label) << " does not occur in the label image.");
+    }
+
+    return it->second;
+  }
+
+  template< typename TInputImage, typename TLabelImage >
+  void LabelQuantileImageFilter< TInputImage, TLabelImage >::AllocateOutputs()
+  {
+    // Pass the input through as the output
+    typename TInputImage::Pointer image = const_cast< TInputImage * >( this->GetInput() );
+
+    this->GraftOutput(image);
+
+    // Nothing that needs to be allocated for the remaining outputs
+  }
+
+  template< typename TInputImage, typename TLabelImage >
+  typename LabelQuantileImageFilter< TInputImage, TLabelImage >::RealType
+    LabelQuantileImageFilter< TInputImage, TLabelImage >::GetBinEdge(const OrderStatisticSearch& search,
+                                                                     unsigned int bin) const
+  {
+    const RealType lower = static_cast<RealType>(search.m_Lower);
+    const RealType width = (static_cast<RealType>(search.m_Upper) - lower) / static_cast<RealType>(m_NumberOfBins);
+    return lower + static_cast<RealType>(bin) * width;
+  }
+
+  template< typename TInputImage, typename TLabelImage >
+  unsigned int LabelQuantileImageFilter< TInputImage, TLabelImage >::GetBin(const OrderStatisticSearch& search,
+                                                                            PixelType value) const
+  {
+    const RealType lower = static_cast<RealType>(search.m_Lower);
+    const RealType width = (static_cast<RealType>(search.m_Upper) - lower) / static_cast<RealType>(m_NumberOfBins);
+    const RealType realValue = static_cast<RealType>(value);
+
+    auto bin = static_cast<unsigned int>(
+      std::min(std::floor((realValue - lower) / width), static_cast<RealType>(m_NumberOfBins - 1)));
+
+    // correct rounding errors, the bin of a value is defined by the bin edges
+    while (bin > 0 && realValue < this->GetBinEdge(search, bin))
+    {
+      --bin;
+    }
+    while (bin + 1 < m_NumberOfBins && realValue >= this->GetBinEdge(search, bin + 1))
+    {
+      ++bin;
+    }
+
+    return bin;
+  }
+
+  template< typename TInputImage, typename TLabelImage >
+  void LabelQuantileImageFilter< TInputImage, TLabelImage >::FinishPass(OrderStatisticSearch& search) const
+  {
+    const SizeValueType localRank = search.m_Rank - search.m_NumberBelow;
+
+    if (search.m_Collect)
+    {
+      std::nth_element(search.m_CollectedValues.begin(), search.m_CollectedValues.begin() + localRank,
+                       search.m_CollectedValues.end());
+      search.m_Value = static_cast<RealType>(search.m_CollectedValues[localRank]);
+      search.m_Done = true;
+      std::vector<PixelType>().swap(search.m_CollectedValues);
+      return;
+    }
+
+    // find the bin that contains the searched value
+    SizeValueType cumulative = 0;
+    unsigned int bin = 0;
+    for (; bin + 1 < m_NumberOfBins; ++bin)
+    {
+      if (cumulative + search.m_BinCounts[bin] > localRank)
+      {
+        break;
+      }
+      cumulative += search.m_BinCounts[bin];
+    }
+
+    const PixelType oldLower = search.m_Lower;
+    const PixelType oldUpper = search.m_Upper;
+
+    // continue with the observed value range of the bin, it contains exactly the values of the bin
+    search.m_NumberBelow += cumulative;
+    search.m_NumberInInterval = search.m_BinCounts[bin];
+    search.m_Lower = search.m_BinMinimum[bin];
+    search.m_Upper = search.m_BinMaximum[bin];
+
+    std::vector<SizeValueType>().swap(search.m_BinCounts);
+    std::vector<PixelType>().swap(search.m_BinMinimum);
+    std::vector<PixelType>().swap(search.m_BinMaximum);
+
+    if (search.m_Lower == search.m_Upper)
+    {
+      search.m_Value = static_cast<RealType>(search.m_Lower);
+      search.m_Done = true;
+    }
+    else if (static_cast<RealType>(search.m_Upper) - static_cast<RealType>(search.m_Lower) <= m_Tolerance)
+    {
+      search.m_Value = (static_cast<RealType>(search.m_Lower) + static_cast<RealType>(search.m_Upper)) / 2.;
+      search.m_Done = true;
+    }
+    else
+    {
+      // if the bins cannot split the interval any further (floating point resolution), the values are collected
+      search.m_Collect = search.m_NumberInInterval <= m_MaximumNumberOfCollectedValues ||
+                         (search.m_Lower == oldLower && search.m_Upper == oldUpper);
+    }
+  }
+
+  template< typename TInputImage, typename TLabelImage >
+  void LabelQuantileImageFilter< TInputImage, TLabelImage >::GenerateData()
+  {
+    this->AllocateOutputs();
+
+    m_Quantiles.clear();
+    m_NumberOfPasses = 0;
+
+    const TInputImage* input = this->GetInput();
+    const TLabelImage* labelImage = this->GetLabelInput();
+    const RegionType region = this->GetOutput()->GetRequestedRegion();
+
+    struct LabelRange
+    {
+      SizeValueType m_Count;
+      PixelType m_Minimum;
+      PixelType m_Maximum;
+    };
+
+    typedef std::vector<OrderStatisticSearch> SearchVectorType;
+    typedef std::map<LabelPixelType, SearchVectorType> SearchMapType;
+
+    // calls the passed functor for every voxel with its label
+    auto iterateVoxels = [input, labelImage, &region](auto&& functor)
+    {
+      ImageRegionConstIterator< TInputImage > it(input, region);
+      if (labelImage)
+      {
+        ImageRegionConstIterator< TLabelImage > labelIt(labelImage, region);
+        for (; !it.IsAtEnd(); ++it, ++labelIt)
+        {
+          functor(labelIt.Get(), it.Get());
+        }
+      }
+      else
+      {
+        const LabelPixelType label = NumericTraits<LabelPixelType>::OneValue();
+        for (; !it.IsAtEnd(); ++it)
+        {
+          functor(label, it.Get());
+        }
+      }
+    };
+
+    // first pass: number of values and value range of every label
+    std::map<LabelPixelType, LabelRange> ranges;
+    auto rangeIt = ranges.end();
+    iterateVoxels([&ranges, &rangeIt](LabelPixelType label, PixelType value)
+    {
+      if (rangeIt == ranges.end() || rangeIt->first != label)
+      {
+        rangeIt = ranges.insert(std::make_pair(label, LabelRange{ 0, value, value })).first;
+      }
+
+      LabelRange& range = rangeIt->second;
+      range.m_Count++;
+      range.m_Minimum = std::min(range.m_Minimum, value);
+      range.m_Maximum = std::max(range.m_Maximum, value);
+    });
+    ++m_NumberOfPasses;
+
+    // one search per distinct order statistic needed for the quantiles of a label
+    SearchMapType searches;
+    bool searchesActive = false;
+    for (auto&& range : ranges)
+    {
+      SearchVectorType& labelSearches = searches[range.first];
+      const SizeValueType count = range.second.m_Count;
+
+      std::vector<SizeValueType> ranks;
+      for (auto p : m_Probabilities)
+      {
+        const auto rank = static_cast<SizeValueType>(std::floor(static_cast<double>(count - 1) * p));
+        ranks.push_back(rank);
+        ranks.push_back(std::min(rank + 1, count - 1));
+      }
+      std::sort(ranks.begin(), ranks.end());
+      ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+
+      for (auto rank : ranks)
+      {
+        OrderStatisticSearch search;
+        search.m_Rank = rank;
+        search.m_Lower = range.second.m_Minimum;
+        search.m_Upper = range.second.m_Maximum;
+        search.m_NumberBelow = 0;
+        search.m_NumberInInterval = count;
+        search.m_Collect = count <= m_MaximumNumberOfCollectedValues;
+        search.m_Done = search.m_Lower == search.m_Upper;
+        search.m_Value = static_cast<RealType>(search.m_Lower);
+        searchesActive = searchesActive || !search.m_Done;
+        labelSearches.push_back(search);
+      }
+    }
+
+    // refinement passes
+    while (searchesActive)
+    {
+      for (auto&& labelSearches : searches)
+      {
+        for (auto&& search : labelSearches.second)
+        {
+          if (search.m_Done)
+          {
+            continue;
+          }
+
+          if (search.m_Collect)
+          {
+            search.m_CollectedValues.reserve(search.m_NumberInInterval);
+          }
+          else
+          {
+            search.m_BinCounts.assign(m_NumberOfBins, 0);
+            search.m_BinMinimum.assign(m_NumberOfBins, NumericTraits<PixelType>::max());
+            search.m_BinMaximum.assign(m_NumberOfBins, NumericTraits<PixelType>::NonpositiveMin());
+          }
+        }
+      }
+
+      auto searchIt = searches.end();
+      iterateVoxels([this, &searches, &searchIt](LabelPixelType label, PixelType value)
+      {
+        if (searchIt == searches.end() || searchIt->first != label)
+        {
+          searchIt = searches.find(label);
+        }
+
+        for (auto&& search : searchIt->second)
+        {
+          if (search.m_Done || value < search.m_Lower || value > search.m_Upper)
+          {
+            continue;
+          }
+
+          if (search.m_Collect)
+          {
+            search.m_CollectedValues.push_back(value);
+          }
+          else
+          {
+            const unsigned int bin = this->GetBin(search, value);
+            search.m_BinCounts[bin]++;
+            search.m_BinMinimum[bin] = std::min(search.m_BinMinimum[bin], value);
+            search.m_BinMaximum[bin] = std::max(search.m_BinMaximum[bin], value);
+          }
+        }
+      });
+      ++m_NumberOfPasses;
+
+      searchesActive = false;
+      for (auto&& labelSearches : searches)
+      {
+        for (auto&& search : labelSearches.second)
+        {
+          if (!search.m_Done)
+          {
+            this->FinishPass(search);
+            searchesActive = searchesActive || !search.m_Done;
+          }
+        }
+      }
+    }
+
+    // interpolate the quantiles between the order statistics
+    for (auto&& labelSearches : searches)
+    {
+      const SizeValueType count = ranges[labelSearches.first].m_Count;
+      const SearchVectorType& labelSearchVector = labelSearches.second;
+
+      auto orderStatistic = [&labelSearchVector](SizeValueType rank)
+      {
+        for (auto&& search : labelSearchVector)
+        {
+          if (search.m_Rank == rank)
+          {
+            return search.m_Value;
+          }
+        }
+        return labelSearchVector.front().m_Value;
+      };
+
+      QuantilesType& quantiles = m_Quantiles[labelSearches.first];
+      for (auto p : m_Probabilities)
+      {
+        const double h = static_cast<double>(count - 1) * p;
+        const auto rank = static_cast<SizeValueType>(std::floor(h));
+        const RealType lowerValue = orderStatistic(rank);
+        const RealType upperValue = orderStatistic(std::min(rank + 1, count - 1));
+        quantiles.push_back(lowerValue + static_cast<RealType>(h - std::floor(h)) * (upperValue - lowerValue));
+      }
+    }
+  }
+}
+
+#endif
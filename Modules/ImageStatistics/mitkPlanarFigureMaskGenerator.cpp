@@ -19,25 +19,115 @@ found in the LICENSE file.
 #include <mitkImageTimeSelector.h>
 #include <mitkIOUtil.h>
 
-#include <itkCastImageFilter.h>
-#include <itkVTKImageExport.h>
-#include <itkVTKImageImport.h>
-#include <itkImageDuplicator.h>
 #include <itkExceptionObject.h>
 #include <itkLineIterator.h>
 
-#include <vtkPoints.h>
-#include <vtkImageStencil.h>
-#include <vtkImageImport.h>
-#include <vtkImageExport.h>
-#include <vtkLassoStencilSource.h>
-#include <vtkSmartPointer.h>
+#include <algorithm>
+#include <cmath>
 
+namespace
+{
+  /** Maps the points of a planar figure polyline to continuous index coordinates of the image in one batch */
+  std::vector<mitk::Point3D> MapPolyLineToIndex(const mitk::PlanarFigure::PolyLineType &polyLine,
+                                                const mitk::PlaneGeometry *planeGeometry,
+                                                const mitk::BaseGeometry *imageGeometry)
+  {
+    std::vector<mitk::Point3D> points(polyLine.size());
+    auto pointIter = points.begin();
 
+    for (const auto &point : polyLine)
+      planeGeometry->Map(point, *pointIter++);
+
+    imageGeometry->WorldToIndex(points.data(), points.data(), points.size());
+    return points;
+  }
+}
 
 namespace mitk
 {
 
+void PlanarFigureMaskGenerator::RasterizePolygon(const PolygonType &polygon,
+                                                 itk::Image<unsigned short, 2> *mask,
+                                                 unsigned short value)
+{
+  if (polygon.size() < 3)
+    return;
+
+  // pixel centers that lie on the boundary of the polygon (within this tolerance) belong to the polygon
+  const double tolerance = 1e-6;
+
+  const auto region = mask->GetBufferedRegion();
+  const itk::IndexValueType xMin = region.GetIndex(0);
+  const itk::IndexValueType yMin = region.GetIndex(1);
+  const itk::IndexValueType xMax = xMin + static_cast<itk::IndexValueType>(region.GetSize(0)) - 1;
+  const itk::IndexValueType yMax = yMin + static_cast<itk::IndexValueType>(region.GetSize(1)) - 1;
+  const std::size_t lineLength = region.GetSize(0);
+  unsigned short *buffer = mask->GetBufferPointer();
+
+  auto fillSpan = [&](itk::IndexValueType y, double from, double to) {
+    const auto first = std::max(xMin, static_cast<itk::IndexValueType>(std::ceil(from - tolerance)));
+    const auto last = std::min(xMax, static_cast<itk::IndexValueType>(std::floor(to + tolerance)));
+
+    if (y < yMin || y > yMax || first > last)
+      return;
+
+    unsigned short *line = buffer + (y - yMin) * lineLength;
+    std::fill(line + (first - xMin), line + (last - xMin) + 1, value);
+  };
+
+  double polygonYMin = polygon.front()[1];
+  double polygonYMax = polygon.front()[1];
+
+  for (const auto &point : polygon)
+  {
+    polygonYMin = std::min(polygonYMin, point[1]);
+    polygonYMax = std::max(polygonYMax, point[1]);
+  }
+
+  const auto firstLine = std::max(yMin, static_cast<itk::IndexValueType>(std::ceil(polygonYMin - tolerance)));
+  const auto lastLine = std::min(yMax, static_cast<itk::IndexValueType>(std::floor(polygonYMax + tolerance)));
+
+  // scanline fill of the pixel centers inside of the polygon (even-odd rule)
+  std::vector<double> intersections;
+  const std::size_t numberOfPoints = polygon.size();
+
+  for (auto y = firstLine; y <= lastLine; ++y)
+  {
+    intersections.clear();
+
+    for (std::size_t i = 0; i < numberOfPoints; ++i)
+    {
+      const auto &p = polygon[i];
+      const auto &q = polygon[(i + 1) % numberOfPoints];
+
+      if ((p[1] <= y) != (q[1] <= y))
+        intersections.push_back(p[0] + (y - p[1]) * (q[0] - p[0]) / (q[1] - p[1]));
+    }
+
+    std::sort(intersections.begin(), intersections.end());
+
+    for (std::size_t i = 0; i + 1 < intersections.size(); i += 2)
+      fillSpan(y, intersections[i], intersections[i + 1]);
+  }
+
+  // the scanlines miss centers on horizontal edges and on vertices at the top of the polygon
+  for (std::size_t i = 0; i < numberOfPoints; ++i)
+  {
+    const auto &p = polygon[i];
+    const auto &q = polygon[(i + 1) % numberOfPoints];
+    const double y = std::round(p[1]);
+
+    if (std::abs(p[1] - y) < tolerance && std::abs(q[1] - y) < tolerance)
+    {
+      fillSpan(static_cast<itk::IndexValueType>(y), std::min(p[0], q[0]), std::max(p[0], q[0]));
+    }
+    else if (std::abs(p[1] - y) < tolerance)
+    {
+      fillSpan(static_cast<itk::IndexValueType>(y), p[0], p[0]);
+    }
+  }
+}
+
 void PlanarFigureMaskGenerator::SetPlanarFigure(mitk::PlanarFigure::Pointer planarFigure)
 {
     if ( planarFigure.IsNull() )
@@ -89,11 +179,10 @@ void PlanarFigureMaskGenerator::InternalCalculateMaskFromPlanarFigure(
   maskImage->SetDirection(image->GetDirection());
   maskImage->SetNumberOfComponentsPerPixel(image->GetNumberOfComponentsPerPixel());
   maskImage->Allocate();
-  maskImage->FillBuffer(1);
+  maskImage->FillBuffer(0);
 
-  // all PolylinePoints of the PlanarFigure are stored in a vtkPoints object.
-  // These points are used by the vtkLassoStencilSource to create
-  // a vtkImageStencil.
+  // all PolylinePoints of the PlanarFigure are mapped to the index coordinates of the slice
+  // and rasterized directly into the mask.
   const mitk::PlaneGeometry *planarFigurePlaneGeometry = m_PlanarFigure->GetPlaneGeometry();
   const typename PlanarFigure::PolyLineType planarFigurePolyline = m_PlanarFigure->GetPolyLine( 0 );
   const mitk::BaseGeometry *imageGeometry3D = m_inputImage->GetGeometry( 0 );
@@ -126,38 +215,36 @@ void PlanarFigureMaskGenerator::InternalCalculateMaskFromPlanarFigure(
     break;
   }
 
-  // store the polyline contour as vtkPoints object
-  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
-  for (const auto& point : planarFigurePolyline)
-  {
-    Point3D point3D;
+  // store the polyline contour in 2D index coordinates of the slice
+  PolygonType polygon;
+  double bounds[6] = { itk::NumericTraits<double>::max(), itk::NumericTraits<double>::NonpositiveMin(),
+                       itk::NumericTraits<double>::max(), itk::NumericTraits<double>::NonpositiveMin(),
+                       itk::NumericTraits<double>::max(), itk::NumericTraits<double>::NonpositiveMin() };
 
-    // Convert 2D point back to the local index coordinates of the selected image
-    planarFigurePlaneGeometry->Map(point, point3D);
-    imageGeometry3D->WorldToIndex(point3D, point3D);
+  // Convert 2D points back to the local index coordinates of the selected image
+  for (const auto& point3D : MapPolyLineToIndex(planarFigurePolyline, planarFigurePlaneGeometry, imageGeometry3D))
+  {
+    polygon.push_back({ { point3D[i0], point3D[i1] } });
 
-    points->InsertNextPoint(point3D[i0], point3D[i1], 0);
+    for (int i = 0; i < 3; ++i)
+    {
+      bounds[2 * i] = std::min(bounds[2 * i], point3D[i]);
+      bounds[2 * i + 1] = std::max(bounds[2 * i + 1], point3D[i]);
+    }
   }
 
-  vtkSmartPointer<vtkPoints> holePoints;
+  PolygonType holePolygon;
 
   if (!planarFigureHolePolyline.empty())
   {
-    holePoints = vtkSmartPointer<vtkPoints>::New();
-    Point3D point3D;
-
-    for (const auto& point : planarFigureHolePolyline)
+    for (const auto& point3D : MapPolyLineToIndex(planarFigureHolePolyline, planarFigurePlaneGeometry, imageGeometry3D))
     {
-      planarFigurePlaneGeometry->Map(point, point3D);
-      imageGeometry3D->WorldToIndex(point3D, point3D);
-      holePoints->InsertNextPoint(point3D[i0], point3D[i1], 0);
+      holePolygon.push_back({ { point3D[i0], point3D[i1] } });
     }
   }
 
   // mark a malformed 2D planar figure ( i.e. area = 0 ) as out of bounds
   // this can happen when all control points of a rectangle lie on the same line = two of the three extents are zero
-  double bounds[6] = {0};
-  points->GetBounds(bounds);
   bool extent_x = (fabs(bounds[0] - bounds[1])) < mitk::eps;
   bool extent_y = (fabs(bounds[2] - bounds[3])) < mitk::eps;
   bool extent_z = (fabs(bounds[4] - bounds[5])) < mitk::eps;
@@ -168,69 +255,13 @@ void PlanarFigureMaskGenerator::InternalCalculateMaskFromPlanarFigure(
     mitkThrow() << "Figure has a zero area and cannot be used for masking.";
   }
 
-  // create a vtkLassoStencilSource and set the points of the Polygon
-  vtkSmartPointer<vtkLassoStencilSource> lassoStencil = vtkSmartPointer<vtkLassoStencilSource>::New();
-  lassoStencil->SetShapeToPolygon();
-  lassoStencil->SetPoints(points);
-
-  vtkSmartPointer<vtkLassoStencilSource> holeLassoStencil = nullptr;
-
-  if (holePoints.GetPointer() != nullptr)
-  {
-    holeLassoStencil = vtkSmartPointer<vtkLassoStencilSource>::New();
-    holeLassoStencil->SetShapeToPolygon();
-    holeLassoStencil->SetPoints(holePoints);
-  }
-
-  // Export from ITK to VTK (to use a VTK filter)
-  typedef itk::VTKImageImport< MaskImage2DType > ImageImportType;
-  typedef itk::VTKImageExport< MaskImage2DType > ImageExportType;
-
-  typename ImageExportType::Pointer itkExporter = ImageExportType::New();
-  itkExporter->SetInput( maskImage );
-//  itkExporter->SetInput( castFilter->GetOutput() );
+  RasterizePolygon(polygon, maskImage, 1);
 
-  vtkSmartPointer<vtkImageImport> vtkImporter = vtkSmartPointer<vtkImageImport>::New();
-  this->ConnectPipelines( itkExporter, vtkImporter );
-
-  // Apply the generated image stencil to the input image
-  vtkSmartPointer<vtkImageStencil> imageStencilFilter = vtkSmartPointer<vtkImageStencil>::New();
-  imageStencilFilter->SetInputConnection( vtkImporter->GetOutputPort() );
-  imageStencilFilter->SetStencilConnection(lassoStencil->GetOutputPort());
-  imageStencilFilter->ReverseStencilOff();
-  imageStencilFilter->SetBackgroundValue( 0 );
-  imageStencilFilter->Update();
-
-  vtkSmartPointer<vtkImageStencil> holeStencilFilter = nullptr;
-
-  if (holeLassoStencil.GetPointer() != nullptr)
-  {
-    holeStencilFilter = vtkSmartPointer<vtkImageStencil>::New();
-    holeStencilFilter->SetInputConnection(imageStencilFilter->GetOutputPort());
-    holeStencilFilter->SetStencilConnection(holeLassoStencil->GetOutputPort());
-    holeStencilFilter->ReverseStencilOn();
-    holeStencilFilter->SetBackgroundValue(0);
-    holeStencilFilter->Update();
-  }
-
-  // Export from VTK back to ITK
-  vtkSmartPointer<vtkImageExport> vtkExporter = vtkSmartPointer<vtkImageExport>::New();
-  vtkExporter->SetInputConnection( holeStencilFilter.GetPointer() == nullptr
-    ? imageStencilFilter->GetOutputPort()
-    : holeStencilFilter->GetOutputPort());
-  vtkExporter->Update();
-
-  typename ImageImportType::Pointer itkImporter = ImageImportType::New();
-  this->ConnectPipelines( vtkExporter, itkImporter );
-  itkImporter->Update();
-
-  typedef itk::ImageDuplicator< ImageImportType::OutputImageType > DuplicatorType;
-  DuplicatorType::Pointer duplicator = DuplicatorType::New();
-  duplicator->SetInputImage( itkImporter->GetOutput() );
-  duplicator->Update();
+  if (!holePolygon.empty())
+    RasterizePolygon(holePolygon, maskImage, 0);
 
   // Store mask
-  m_InternalITKImageMask2D = duplicator->GetOutput();
+  m_InternalITKImageMask2D = maskImage;
 }
 
 template < typename TPixel, unsigned int VImageDimension >
@@ -284,13 +315,8 @@ void PlanarFigureMaskGenerator::InternalCalculateMaskFromOpenPlanarFigure(
   {
     // store the polyline contour as vtkPoints object
     IndexVecType pointIndices;
-    for(const auto& point : planarFigurePolyline)
+    for(const auto& point3D : MapPolyLineToIndex(planarFigurePolyline, planarFigurePlaneGeometry, imageGeometry3D))
     {
-      Point3D point3D;
-
-      planarFigurePlaneGeometry->Map(point, point3D);
-      imageGeometry3D->WorldToIndex(point3D, point3D);
-
       IndexType2D index2D;
       index2D[0] = point3D[i0];
       index2D[1] = point3D[i1];
@@ -20,9 +20,9 @@ found in the LICENSE file.
 #include <mitkImage.h>
 #include <mitkMaskGenerator.h>
 #include <mitkPlanarFigure.h>
-#include <vtkImageExport.h>
-#include <vtkImageImport.h>
-#include <vtkSmartPointer.h>
+
+#include <array>
+#include <vector>
 
 namespace mitk
 {
@@ -91,47 +91,14 @@ namespace mitk
     /** Helper function that deduces if the passed vector is equal to one of the primary axis of the geometry.*/
     static bool GetPrincipalAxis(const BaseGeometry *geometry, Vector3D vector, unsigned int &axis);
 
-    /** Connection from ITK to VTK */
-    template <typename ITK_Exporter, typename VTK_Importer>
-    void ConnectPipelines(ITK_Exporter exporter, vtkSmartPointer<VTK_Importer> importer)
-    {
-      importer->SetUpdateInformationCallback(exporter->GetUpdateInformationCallback());
-
-      importer->SetPipelineModifiedCallback(exporter->GetPipelineModifiedCallback());
-      importer->SetWholeExtentCallback(exporter->GetWholeExtentCallback());
-      importer->SetSpacingCallback(exporter->GetSpacingCallback());
-      importer->SetOriginCallback(exporter->GetOriginCallback());
-      importer->SetScalarTypeCallback(exporter->GetScalarTypeCallback());
-
-      importer->SetNumberOfComponentsCallback(exporter->GetNumberOfComponentsCallback());
-
-      importer->SetPropagateUpdateExtentCallback(exporter->GetPropagateUpdateExtentCallback());
-      importer->SetUpdateDataCallback(exporter->GetUpdateDataCallback());
-      importer->SetDataExtentCallback(exporter->GetDataExtentCallback());
-      importer->SetBufferPointerCallback(exporter->GetBufferPointerCallback());
-      importer->SetCallbackUserData(exporter->GetCallbackUserData());
-    }
-
-    /** Connection from VTK to ITK */
-    template <typename VTK_Exporter, typename ITK_Importer>
-    void ConnectPipelines(vtkSmartPointer<VTK_Exporter> exporter, ITK_Importer importer)
-    {
-      importer->SetUpdateInformationCallback(exporter->GetUpdateInformationCallback());
-
-      importer->SetPipelineModifiedCallback(exporter->GetPipelineModifiedCallback());
-      importer->SetWholeExtentCallback(exporter->GetWholeExtentCallback());
-      importer->SetSpacingCallback(exporter->GetSpacingCallback());
-      importer->SetOriginCallback(exporter->GetOriginCallback());
-      importer->SetScalarTypeCallback(exporter->GetScalarTypeCallback());
+    typedef std::vector<std::array<double, 2>> PolygonType;
 
-      importer->SetNumberOfComponentsCallback(exporter->GetNumberOfComponentsCallback());
-
-      importer->SetPropagateUpdateExtentCallback(exporter->GetPropagateUpdateExtentCallback());
-      importer->SetUpdateDataCallback(exporter->GetUpdateDataCallback());
-      importer->SetDataExtentCallback(exporter->GetDataExtentCallback());
-      importer->SetBufferPointerCallback(exporter->GetBufferPointerCallback());
-      importer->SetCallbackUserData(exporter->GetCallbackUserData());
-    }
+    /** \brief Sets all pixels of the 2D mask whose centers lie inside of or on the boundary of the polygon to value.
+     *
+     * The polygon is given in index coordinates of the mask and rasterized line by line (even-odd rule), which
+     * avoids the conversion of the mask to VTK and back that a vtkImageStencil would require.
+     */
+    static void RasterizePolygon(const PolygonType &polygon, itk::Image<unsigned short, 2> *mask, unsigned short value);
 
     bool IsUpdateRequired() const;
 
@@ -0,0 +1,229 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITK_SINGLEPASSLABELSTATISTICSIMAGEFILTER_H
+#define MITK_SINGLEPASSLABELSTATISTICSIMAGEFILTER_H
+
+#include <unordered_map>
+#include <vector>
+
+#include <itkImage.h>
+#include <itkImageToImageFilter.h>
+#include <itkHistogram.h>
+#include "itksys/hash_map.hxx"
+
+namespace itk
+{
+  /**
+  * \class SinglePassLabelStatisticsImageFilter
+  * \brief Computes the statistics of all labels of a label image with a single pass over the image.
+  *
+  * The filter determines per label the same values as the combination of MinMaxLabelImageFilterWithIndex and
+  * ExtendedLabelStatisticsImageFilter (moments, min/max with index, histogram and the histogram based statistics).
+  * Each thread accumulates the values of its region in its own per label accumulators, which are merged after
+  * the threaded pass. As the histogram range of a label is only known after the pass, every accumulator counts the
+  * occurrences of the distinct pixel values and the histograms are built from these counts when merging.
+  * The memory needed therefore grows with the number of distinct pixel values per label, so the filter is
+  * meant for images of integer pixel type.
+  */
+  template <typename TInputImage, typename TLabelImage>
+  class SinglePassLabelStatisticsImageFilter : public ImageToImageFilter<TInputImage, TInputImage>
+  {
+  public:
+    /** Standard Self typedef */
+    typedef SinglePassLabelStatisticsImageFilter            Self;
+    typedef ImageToImageFilter< TInputImage, TInputImage > Superclass;
+    typedef SmartPointer< Self >                           Pointer;
+    typedef SmartPointer< const Self >                     ConstPointer;
+
+    /** Method for creation through the object factory. */
+    itkNewMacro(Self);
+
+    /** Runtime information support. */
+    itkTypeMacro(SinglePassLabelStatisticsImageFilter, ImageToImageFilter);
+
+    typedef typename TInputImage::RegionType RegionType;
+    typedef typename TInputImage::IndexType  IndexType;
+    typedef typename TInputImage::PixelType  PixelType;
+    typedef typename NumericTraits< PixelType >::RealType RealType;
+    typedef typename TLabelImage::PixelType  LabelPixelType;
+    typedef itk::Statistics::Histogram<double> HistogramType;
+
+    /** \class LabelStatistics
+     * \brief Accumulators and results stored per label
+     */
+    class LabelStatistics
+    {
+    public:
+      LabelStatistics()
+        : m_Count(0),
+          m_PositivePixelCount(0),
+          m_Sum(0),
+          m_SumOfPositivePixels(0),
+          m_SumOfSquares(0),
+          m_SumOfCubes(0),
+          m_SumOfQuadruples(0),
+          m_Minimum(NumericTraits<PixelType>::max()),
+          m_Maximum(NumericTraits<PixelType>::NonpositiveMin()),
+          m_Mean(0),
+          m_MPP(0),
+          m_Variance(0),
+          m_Sigma(0),
+          m_Skewness(0),
+          m_Kurtosis(0),
+          m_Median(0),
+          m_ExactMedian(0),
+          m_Uniformity(0),
+          m_UPP(0),
+          m_Entropy(0)
+      {
+        m_MinIndex.Fill(0);
+        m_MaxIndex.Fill(0);
+      }
+
+      SizeValueType m_Count;
+      SizeValueType m_PositivePixelCount;
+      RealType m_Sum;
+      RealType m_SumOfPositivePixels;
+      RealType m_SumOfSquares;
+      RealType m_SumOfCubes;
+      RealType m_SumOfQuadruples;
+      PixelType m_Minimum;
+      PixelType m_Maximum;
+      IndexType m_MinIndex;
+      IndexType m_MaxIndex;
+
+      /** Number of occurrences of every distinct pixel value of the label */
+      std::unordered_map<PixelType, SizeValueType> m_ValueCounts;
+
+      RealType m_Mean;
+      RealType m_MPP;
+      RealType m_Variance;
+      RealType m_Sigma;
+      RealType m_Skewness;
+      RealType m_Kurtosis;
+      /** median of the histogram (center of the bin that contains the median) */
+      RealType m_Median;
+      /** median of the values (mean of the two middle values for an even count) */
+      RealType m_ExactMedian;
+      RealType m_Uniformity;
+      RealType m_UPP;
+      RealType m_Entropy;
+      HistogramType::Pointer m_Histogram;
+    };
+
+    typedef itksys::hash_map<LabelPixelType, LabelStatistics> MapType;
+    typedef typename MapType::iterator                         MapIterator;
+    typedef typename MapType::const_iterator                   MapConstIterator;
+    typedef typename MapType::value_type                       MapValueType;
+
+    /** Set the label image */
+    void SetLabelInput(const TLabelImage *input)
+    {
+      // Process object is not const-correct so the const casting is required.
+      this->SetNthInput( 1, const_cast< TLabelImage * >( input ) );
+    }
+
+    /** Get the label image */
+    const TLabelImage * GetLabelInput() const
+    {
+      return itkDynamicCastInDebugMode< TLabelImage * >(
+        const_cast< DataObject * >( this->ProcessObject::GetInput(1) ) );
+    }
+
+    /** Set the number of histogram bins used for every label. Disables the use of the bin size.*/
+    void SetNumberOfBins(unsigned int nBins);
+    itkGetConstMacro(NumberOfBins, unsigned int);
+
+    /** Set the histogram bin size. The number of bins of a label is then derived from its value range (at least 10
+    * bins). Enables the use of the bin size.*/
+    void SetBinSize(double binSize);
+    itkGetConstMacro(BinSize, double);
+    itkGetConstMacro(UseBinSize, bool);
+
+    /** If set, the counts of the distinct pixel values are kept in the label statistics after the update, so that
+    * the statistics can be updated afterwards (see AddValue(), RemoveValue() and ComputeDerivedStatistics()).
+    * Default is false.*/
+    itkSetMacro(KeepValueCounts, bool);
+    itkGetConstMacro(KeepValueCounts, bool);
+    itkBooleanMacro(KeepValueCounts);
+
+    /** Returns all labels that occur in the label image (only valid after Update()).*/
+    std::vector<LabelPixelType> GetRelevantLabels() const;
+
+    bool HasLabel(LabelPixelType label) const
+    {
+      return m_LabelStatistics.find(label) != m_LabelStatistics.end();
+    }
+
+    /** Returns the statistics of a label.
+    * @pre the label must occur in the label image (see HasLabel()).*/
+    const LabelStatistics& GetLabelStatistics(LabelPixelType label) const;
+
+    /** Returns the statistics of all labels.*/
+    const MapType& GetLabelStatisticsMap() const
+    {
+      return m_LabelStatistics;
+    }
+
+    /** Returns the statistics of all labels for modification, e.g. to update them after the label image changed
+    * (see AddValue() and RemoveValue()).*/
+    MapType& GetLabelStatisticsMap()
+    {
+      return m_LabelStatistics;
+    }
+
+    /** Adds a voxel to the accumulators of a label. The derived statistics are not updated.*/
+    static void AddValue(LabelStatistics& labelStats, PixelType value, const IndexType& index);
+
+    /** Removes a voxel from the accumulators of a label. The derived statistics are not updated.
+    * @pre the value counts of the label were kept (see SetKeepValueCounts()) and contain the value.
+    * @return false if the voxel was the minimum or maximum of the label and the index of the new extremum is
+    * unknown. Its value is already updated, the caller has to determine the index.*/
+    static bool RemoveValue(LabelStatistics& labelStats, PixelType value, const IndexType& index);
+
+    /** Computes the derived statistics (mean, variance, histogram, ...) of a label from its accumulators with the
+    * histogram parameters of the filter.
+    * @pre the value counts of the label are available.*/
+    void ComputeDerivedStatistics(LabelStatistics& labelStats) const;
+
+  protected:
+    SinglePassLabelStatisticsImageFilter();
+    ~SinglePassLabelStatisticsImageFilter() override {}
+
+    void AllocateOutputs() override;
+
+    void BeforeThreadedGenerateData() override;
+
+    void ThreadedGenerateData(const RegionType & outputRegionForThread, ThreadIdType threadId) override;
+
+    void AfterThreadedGenerateData() override;
+
+    /** Number of histogram bins used for a label with the passed value range.*/
+    unsigned int GetNumberOfBinsForLabel(PixelType minimum, PixelType maximum) const;
+
+  private:
+    std::vector<MapType> m_LabelStatisticsPerThread;
+    MapType m_LabelStatistics;
+
+    unsigned int m_NumberOfBins;
+    double m_BinSize;
+    bool m_UseBinSize;
+    bool m_KeepValueCounts;
+  };
+}
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "mitkSinglePassLabelStatisticsImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,375 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITK_SINGLEPASSLABELSTATISTICSIMAGEFILTER_HXX
+#define MITK_SINGLEPASSLABELSTATISTICSIMAGEFILTER_HXX
+
+#include "mitkSinglePassLabelStatisticsImageFilter.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <itkImageRegionConstIteratorWithIndex.h>
+#include <itkImageRegionConstIterator.h>
+#include <mitkHistogramStatisticsCalculator.h>
+
+namespace itk
+{
+  template< typename TInputImage, typename TLabelImage >
+  SinglePassLabelStatisticsImageFilter< TInputImage, TLabelImage >::SinglePassLabelStatisticsImageFilter()
+    : m_NumberOfBins(100), m_BinSize(10.), m_UseBinSize(false), m_KeepValueCounts(false)
+  {
+  }
+
+  template< typename TInputImage, typename TLabelImage >
+  void SinglePassLabelStatisticsImageFilter< TInputImage, TLabelImage >::SetNumberOfBins(unsigned int nBins)
+  {
+    if (nBins != m_NumberOfBins || m_UseBinSize)
+    {
+      m_NumberOfBins = nBins;
+      m_UseBinSize = false;
+      this->Modified();
+    }
+  }
+
+  template< typename TInputImage, typename TLabelImage >
+  void SinglePassLabelStatisticsImageFilter< TInputImage, TLabelImage >::SetBinSize(double binSize)
+  {
+    if (binSize != m_BinSize || !m_UseBinSize)
+    {
+      m_BinSize = binSize;
+      m_UseBinSize = true;
+      this->Modified();
+    }
+  }
+
+  template< typename TInputImage, typename TLabelImage >
+  std::vector<typename SinglePassLabelStatisticsImageFilter< TInputImage, TLabelImage >::LabelPixelType>
+    SinglePassLabelStatisticsImageFilter< TInputImage, TLabelImage >::GetRelevantLabels() const
+  {
+    std::vector<LabelPixelType> labels;
+    for (auto&& it : m_LabelStatistics)
+    {
+      labels.push_back(it.first);
+    }
+    std::sort(labels.begin(), labels.end());
+    return labels;
+  }
+
+  template< typename TInputImage, typename TLabelImage >
+  const typename SinglePassLabelStatisticsImageFilter< TInputImage, TLabelImage >::LabelStatistics&
+    SinglePassLabelStatisticsImageFilter< TInputImage, TLabelImage >::GetLabelStatistics(LabelPixelType label) const
+  {
+    MapConstIterator it = m_LabelStatistics.find(label);
+    if (it == m_LabelStatistics.end())
+    {
+      itkExceptionMacro(<< "Label " << static_cast<double>(label) << " does not occur in the label image.");
+    }
+
+    return (*it).second;
+  }
+
+  template< typename TInputImage, typename TLabelImage >
+  unsigned int SinglePassLabelStatisticsImageFilter< TInputImage, TLabelImage >::GetNumberOfBinsForLabel(
+    PixelType minimum, PixelType maximum) const
+  {
+    if (m_UseBinSize)
+    {
+      // do not allow less than 10 bins
+      return std::max(static_cast<double>(std::ceil(maximum - minimum)) / m_BinSize, 10.);
+    }
+
+    return m_NumberOfBins;
+  }
+
+  template< typename TInputImage, typename TLabelImage >
+  void SinglePassLabelStatisticsImageFilter< TInputImage, TLabelImage >::AllocateOutputs()
+  {
+    // Pass the input through as the output
+    typename TInputImage::Pointer image = const_cast< TInputImage * >( this->GetInput() );
+
+    this->GraftOutput(image);
+
+    // Nothing that needs to be allocated for the remaining outputs
+  }
+
+  template< typename TInputImage, typename TLabelImage >
+  void SinglePassLabelStatisticsImageFilter< TInputImage, TLabelImage >::BeforeThreadedGenerateData()
+  {
+    ThreadIdType numberOfThreads = this->GetNumberOfThreads();
+
+    m_LabelStatisticsPerThread.resize(numberOfThreads);
+    for (ThreadIdType i = 0; i < numberOfThreads; ++i)
+    {
+      m_LabelStatisticsPerThread[i].clear();
+    }
+
+    m_LabelStatistics.clear();
+  }
+
+  template< typename TInputImage, typename TLabelImage >
+  void SinglePassLabelStatisticsImageFilter< TInputImage, TLabelImage >::ThreadedGenerateData(
+    const RegionType & outputRegionForThread, ThreadIdType threadId)
+  {
+    if (outputRegionForThread.GetNumberOfPixels() == 0)
+    {
+      return;
+    }
+
+    MapType& threadStatistics = m_LabelStatisticsPerThread[threadId];
+
+    ImageRegionConstIteratorWithIndex< TInputImage > it(this->GetInput(), outputRegionForThread);
+    ImageRegionConstIterator< TLabelImage > labelIt(this->GetLabelInput(), outputRegionForThread);
+
+    // most voxels share the label of their predecessor, so the map lookup is cached
+    MapIterator mapIt = threadStatistics.end();
+    LabelPixelType currentLabel = NumericTraits<LabelPixelType>::ZeroValue();
+
+    while (!it.IsAtEnd())
+    {
+      const PixelType value = it.Get();
+      const LabelPixelType label = labelIt.Get();
+
+      if (mapIt == threadStatistics.end() || label != currentLabel)
+      {
+        mapIt = threadStatistics.find(label);
+        if (mapIt == threadStatistics.end())
+        {
+          mapIt = threadStatistics.insert(MapValueType(label, LabelStatistics())).first;
+        }
+        currentLabel = label;
+      }
+
+      AddValue((*mapIt).second, value, it.GetIndex());
+
+      ++it;
+      ++labelIt;
+    }
+  }
+
+  template< typename TInputImage, typename TLabelImage >
+  void SinglePassLabelStatisticsImageFilter< TInputImage, TLabelImage >::AfterThreadedGenerateData()
+  {
+    ThreadIdType numberOfThreads = this->GetNumberOfThreads();
+
+    // merge the accumulators of all threads
+    for (ThreadIdType i = 0; i < numberOfThreads; ++i)
+    {
+      for (auto&& threadIt : m_LabelStatisticsPerThread[i])
+      {
+        MapIterator mapIt = m_LabelStatistics.find(threadIt.first);
+        if (mapIt == m_LabelStatistics.end())
+        {
+          m_LabelStatistics.insert(threadIt);
+          continue;
+        }
+
+        LabelStatistics& labelStats = (*mapIt).second;
+        const LabelStatistics& threadStats = threadIt.second;
+
+        labelStats.m_Count += threadStats.m_Count;
+        labelStats.m_PositivePixelCount += threadStats.m_PositivePixelCount;
+        labelStats.m_Sum += threadStats.m_Sum;
+        labelStats.m_SumOfPositivePixels += threadStats.m_SumOfPositivePixels;
+        labelStats.m_SumOfSquares += threadStats.m_SumOfSquares;
+        labelStats.m_SumOfCubes += threadStats.m_SumOfCubes;
+        labelStats.m_SumOfQuadruples += threadStats.m_SumOfQuadruples;
+
+        if (threadStats.m_Minimum < labelStats.m_Minimum)
+        {
+          labelStats.m_Minimum = threadStats.m_Minimum;
+          labelStats.m_MinIndex = threadStats.m_MinIndex;
+        }
+        if (threadStats.m_Maximum > labelStats.m_Maximum)
+        {
+          labelStats.m_Maximum = threadStats.m_Maximum;
+          labelStats.m_MaxIndex = threadStats.m_MaxIndex;
+        }
+
+        for (auto&& valueCount : threadStats.m_ValueCounts)
+        {
+          labelStats.m_ValueCounts[valueCount.first] += valueCount.second;
+        }
+      }
+      m_LabelStatisticsPerThread[i].clear();
+    }
+
+    // compute the remaining statistics and the histograms
+    for (auto&& mapIt : m_LabelStatistics)
+    {
+      this->ComputeDerivedStatistics(mapIt.second);
+      if (!m_KeepValueCounts)
+      {
+        mapIt.second.m_ValueCounts.clear();
+      }
+    }
+  }
+
+  template< typename TInputImage, typename TLabelImage >
+  void SinglePassLabelStatisticsImageFilter< TInputImage, TLabelImage >::AddValue(
+    LabelStatistics& labelStats, PixelType value, const IndexType& index)
+  {
+    if (value < labelStats.m_Minimum)
+    {
+      labelStats.m_Minimum = value;
+      labelStats.m_MinIndex = index;
+    }
+    if (value > labelStats.m_Maximum)
+    {
+      labelStats.m_Maximum = value;
+      labelStats.m_MaxIndex = index;
+    }
+
+    const RealType realValue = static_cast<RealType>(value);
+    const RealType squaredValue = realValue * realValue;
+    labelStats.m_Sum += realValue;
+    labelStats.m_SumOfSquares += squaredValue;
+    labelStats.m_SumOfCubes += squaredValue * realValue;
+    labelStats.m_SumOfQuadruples += squaredValue * squaredValue;
+    labelStats.m_Count++;
+
+    if (value > 0)
+    {
+      labelStats.m_PositivePixelCount++;
+      labelStats.m_SumOfPositivePixels += realValue;
+    }
+
+    labelStats.m_ValueCounts[value]++;
+  }
+
+  template< typename TInputImage, typename TLabelImage >
+  bool SinglePassLabelStatisticsImageFilter< TInputImage, TLabelImage >::RemoveValue(
+    LabelStatistics& labelStats, PixelType value, const IndexType& index)
+  {
+    auto countIt = labelStats.m_ValueCounts.find(value);
+    if (countIt == labelStats.m_ValueCounts.end())
+    {
+      itkGenericExceptionMacro(<< "Cannot remove value " << static_cast<double>(value)
+                               << " from label statistics. The value was not counted.");
+    }
+
+    const RealType realValue = static_cast<RealType>(value);
+    const RealType squaredValue = realValue * realValue;
+    labelStats.m_Sum -= realValue;
+    labelStats.m_SumOfSquares -= squaredValue;
+    labelStats.m_SumOfCubes -= squaredValue * realValue;
+    labelStats.m_SumOfQuadruples -= squaredValue * squaredValue;
+    labelStats.m_Count--;
+
+    if (value > 0)
+    {
+      labelStats.m_PositivePixelCount--;
+      labelStats.m_SumOfPositivePixels -= realValue;
+    }
+
+    if (--(countIt->second) == 0)
+    {
+      labelStats.m_ValueCounts.erase(countIt);
+    }
+
+    bool extremaIndicesKnown = true;
+    if (index == labelStats.m_MinIndex || index == labelStats.m_MaxIndex)
+    {
+      // the extrema are determined from the remaining values, but the indices of their voxels are unknown
+      labelStats.m_Minimum = NumericTraits<PixelType>::max();
+      labelStats.m_Maximum = NumericTraits<PixelType>::NonpositiveMin();
+      for (auto&& valueCount : labelStats.m_ValueCounts)
+      {
+        labelStats.m_Minimum = std::min(labelStats.m_Minimum, valueCount.first);
+        labelStats.m_Maximum = std::max(labelStats.m_Maximum, valueCount.first);
+      }
+      extremaIndicesKnown = false;
+    }
+
+    return extremaIndicesKnown;
+  }
+
+  template< typename TInputImage, typename TLabelImage >
+  void SinglePassLabelStatisticsImageFilter< TInputImage, TLabelImage >::ComputeDerivedStatistics(
+    LabelStatistics& ls) const
+  {
+    typename HistogramType::SizeType hsize(1);
+    typename HistogramType::MeasurementVectorType lb(1);
+    typename HistogramType::MeasurementVectorType ub(1);
+    typename HistogramType::IndexType histogramIndex(1);
+    typename HistogramType::MeasurementVectorType histogramMeasurement(1);
+
+    const RealType count = static_cast<RealType>(ls.m_Count);
+
+    ls.m_Mean = ls.m_Sum / count;
+    ls.m_MPP = ls.m_SumOfPositivePixels / static_cast<RealType>(ls.m_PositivePixelCount);
+    ls.m_Variance = (ls.m_SumOfSquares - ls.m_Sum * ls.m_Sum / count) / count;
+    ls.m_Sigma = std::sqrt(ls.m_Variance);
+
+    RealType secondMoment = ls.m_SumOfSquares / count;
+    RealType thirdMoment = ls.m_SumOfCubes / count;
+    RealType fourthMoment = ls.m_SumOfQuadruples / count;
+
+    // see ExtendedLabelStatisticsImageFilter for the formulas
+    ls.m_Skewness = (thirdMoment - 3. * secondMoment * ls.m_Mean + 2. * std::pow(ls.m_Mean, 3.)) /
+                    std::pow(secondMoment - std::pow(ls.m_Mean, 2.), 1.5);
+    ls.m_Kurtosis = (fourthMoment - 4. * thirdMoment * ls.m_Mean + 6. * secondMoment * std::pow(ls.m_Mean, 2.) -
+                     3. * std::pow(ls.m_Mean, 4.)) / std::pow(secondMoment - std::pow(ls.m_Mean, 2.), 2.);
+
+    // the exact median is derived from the sorted distinct values
+    std::vector<PixelType> values;
+    values.reserve(ls.m_ValueCounts.size());
+    for (auto&& valueCount : ls.m_ValueCounts)
+    {
+      values.push_back(valueCount.first);
+    }
+    std::sort(values.begin(), values.end());
+
+    const SizeValueType lowerMedianRank = (ls.m_Count - 1) / 2;
+    const SizeValueType upperMedianRank = ls.m_Count / 2;
+    SizeValueType cumulativeCount = 0;
+    RealType lowerMedian = 0;
+    for (auto value : values)
+    {
+      const SizeValueType valueCount = ls.m_ValueCounts.find(value)->second;
+      if (cumulativeCount <= lowerMedianRank && lowerMedianRank < cumulativeCount + valueCount)
+      {
+        lowerMedian = static_cast<RealType>(value);
+      }
+      if (cumulativeCount <= upperMedianRank && upperMedianRank < cumulativeCount + valueCount)
+      {
+        ls.m_ExactMedian = (lowerMedian + static_cast<RealType>(value)) / 2.;
+        break;
+      }
+      cumulativeCount += valueCount;
+    }
+
+    ls.m_Histogram = HistogramType::New();
+    ls.m_Histogram->SetMeasurementVectorSize(1);
+    hsize[0] = this->GetNumberOfBinsForLabel(ls.m_Minimum, ls.m_Maximum);
+    lb[0] = ls.m_Minimum;
+    ub[0] = ls.m_Maximum;
+    ls.m_Histogram->Initialize(hsize, lb, ub);
+
+    for (auto&& valueCount : ls.m_ValueCounts)
+    {
+      histogramMeasurement[0] = valueCount.first;
+      ls.m_Histogram->GetIndex(histogramMeasurement, histogramIndex);
+      ls.m_Histogram->IncreaseFrequencyOfIndex(histogramIndex, valueCount.second);
+    }
+
+    mitk::HistogramStatisticsCalculator histStatCalc;
+    histStatCalc.SetHistogram(ls.m_Histogram);
+    histStatCalc.CalculateStatistics();
+    ls.m_Median = histStatCalc.GetMedian();
+    ls.m_Entropy = histStatCalc.GetEntropy();
+    ls.m_Uniformity = histStatCalc.GetUniformity();
+    ls.m_UPP = histStatCalc.GetUPP();
+  }
+}
+
+#endif
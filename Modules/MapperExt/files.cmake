@@ -1,6 +1,7 @@
 file(GLOB_RECURSE H_FILES RELATIVE "${CMAKE_CURRENT_SOURCE_DIR}" "${CMAKE_CURRENT_SOURCE_DIR}/include/*")
 
 set(CPP_FILES
+  mitkAdaptiveSampleDistance.cpp
   mitkEnhancedPointSetVtkMapper3D.cpp
   mitkGPUVolumeMapper3D.cpp
   mitkMeshMapper2D.cpp
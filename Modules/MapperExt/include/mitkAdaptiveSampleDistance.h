@@ -0,0 +1,75 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITKADAPTIVESAMPLEDISTANCE_H
+#define MITKADAPTIVESAMPLEDISTANCE_H
+
+#include "MitkMapperExtExports.h"
+
+namespace mitk
+{
+  class BaseRenderer;
+  class DataNode;
+
+  /**
+    \brief Adapts the sample distances of a volume mapper during interactions to a target frame rate.
+
+    Used by GPUVolumeMapper3D and VolumeMapperVtkSmart3D for the interactive (LOD 0) renderings,
+    see RenderingManager::GetNextLOD(). After each interactive rendering, Update() receives its
+    render time and coarsens or refines the distances, assuming that the render time is inversely
+    proportional to the number of rays (image sample distance squared) and to the number of samples
+    per ray (sample distance). The full quality rendering after the interaction always uses the
+    distances of the mapper; the adapted distances are kept for the next interaction.
+
+    Properties of the node:
+    - \b "volumerendering.uselod": (BoolProperty) enables the interactive rendering
+    - \b "volumerendering.lod.framerate": (FloatProperty, frames per second) target frame rate of
+      the interactive rendering, 0 uses the coarsest distances
+    */
+  class MITKMAPPEREXT_EXPORT AdaptiveSampleDistance
+  {
+  public:
+    /** \brief @a adaptImageSampleDistance is false for mappers that only support the sample distance. */
+    explicit AdaptiveSampleDistance(bool adaptImageSampleDistance = true);
+
+    void SetTargetFrameRate(double frameRate) { m_TargetFrameRate = frameRate; }
+    double GetTargetFrameRate() const { return m_TargetFrameRate; }
+
+    /** \brief Upper limit of the reduction factor, i.e. of the image sample distance. */
+    void SetMaximumFactor(double factor);
+    double GetMaximumFactor() const { return m_MaximumFactor; }
+
+    /** \brief Reads the target frame rate from the properties of @a node. */
+    void UpdateProperties(const DataNode *node, const BaseRenderer *renderer);
+
+    /** \brief Adapts the distances to the time (in milliseconds) of the last interactive rendering. */
+    void Update(double renderTime);
+
+    /** \brief Undoes all adaptations. */
+    void Reset() { m_Factor = 1.0; }
+
+    /** \brief Image sample distance of the interactive rendering, 1 if it is not adapted. */
+    double GetImageSampleDistance() const;
+
+    /** \brief Sample distance of the interactive rendering for a full quality sample distance. */
+    double GetSampleDistance(double fullQualitySampleDistance) const;
+
+  private:
+    bool m_AdaptImageSampleDistance;
+    double m_TargetFrameRate;
+    double m_MaximumFactor;
+    /** \brief Reduction factor, 1 is full quality */
+    double m_Factor;
+  };
+}
+
+#endif // MITKADAPTIVESAMPLEDISTANCE_H
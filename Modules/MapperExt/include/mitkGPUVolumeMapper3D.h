@@ -15,6 +15,7 @@ found in the LICENSE file.
 
 // MITK
 #include "MitkMapperExtExports.h"
+#include "mitkAdaptiveSampleDistance.h"
 #include "mitkBaseRenderer.h"
 #include "mitkCommon.h"
 #include "mitkImage.h"
@@ -38,6 +39,8 @@ namespace mitk
   * - \b "level window": for the level window of the volume data
   * - \b "LookupTable" : for the lookup table of the volume data
   * - \b "TransferFunction" (mitk::TransferFunctionProperty): for the used transfer function of the volume data
+  * - \b "volumerendering.uselod" and "volumerendering.lod.framerate": interactive rendering with sample
+  *   distances adapted to a target frame rate, see mitk::AdaptiveSampleDistance
   ************************************************************************/
 
   //##Documentation
@@ -93,6 +96,10 @@ namespace mitk
 
     void InitVtkMapper(mitk::BaseRenderer *renderer);
 
+    /** \brief Adapts the sample distances to the last interactive rendering of @a renderer.
+      Returns true if the next rendering is an interactive one. */
+    bool UpdateAdaptiveSampleDistance(mitk::BaseRenderer *renderer);
+
     void GenerateDataForRenderer(mitk::BaseRenderer *renderer) override;
 
     void CreateDefaultTransferFunctions();
@@ -131,10 +138,17 @@ namespace mitk
       vtkSmartPointer<vtkGPUVolumeRayCastMapper> m_MapperRAY;
       vtkSmartPointer<vtkVolumeProperty> m_VolumePropertyRAY;
 
+      AdaptiveSampleDistance m_AdaptiveSampleDistance;
+      bool m_LastRenderingInteractive;
+      unsigned long m_LastNumberOfRenders;
+
       LocalStorage()
       {
         m_VtkRenderWindow = nullptr;
 
+        m_LastRenderingInteractive = false;
+        m_LastNumberOfRenders = 0;
+
         m_cpuInitialized = false;
 
         m_gpuInitialized = false;
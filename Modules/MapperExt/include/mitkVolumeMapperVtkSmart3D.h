@@ -15,6 +15,7 @@ found in the LICENSE file.
 
 // MITK
 #include "MitkMapperExtExports.h"
+#include "mitkAdaptiveSampleDistance.h"
 #include "mitkBaseRenderer.h"
 #include "mitkCommon.h"
 #include "mitkImage.h"
@@ -38,6 +39,9 @@ namespace mitk
   //##Documentation
   //## @brief Vtk-based mapper for VolumeData
   //##
+  //## If "volumerendering.uselod" is enabled, interactive renderings use a sample distance
+  //## adapted to the target frame rate "volumerendering.lod.framerate", see AdaptiveSampleDistance.
+  //##
   //## @ingroup Mapper
   class MITKMAPPEREXT_EXPORT VolumeMapperVtkSmart3D : public VtkMapper
   {
@@ -53,6 +57,8 @@ namespace mitk
     void ApplyProperties(vtkActor *actor, mitk::BaseRenderer *renderer) override;
     static void SetDefaultProperties(mitk::DataNode *node, mitk::BaseRenderer *renderer = nullptr, bool overwrite = false);
 
+    bool IsLODEnabled(BaseRenderer *renderer = nullptr) const override;
+
   protected:
     VolumeMapperVtkSmart3D();
     ~VolumeMapperVtkSmart3D() override;
@@ -74,6 +80,12 @@ namespace mitk
 
     void UpdateTransferFunctions(mitk::BaseRenderer *renderer);
     void UpdateRenderMode(mitk::BaseRenderer *renderer);
+    void UpdateSampleDistance(mitk::BaseRenderer *renderer);
+
+    /** \brief vtkSmartVolumeMapper has no image sample distance, only the sample distance is adapted */
+    AdaptiveSampleDistance m_AdaptiveSampleDistance;
+    bool m_LastRenderingInteractive;
+    unsigned long m_LastNumberOfRenders;
   };
 
 } // namespace mitk
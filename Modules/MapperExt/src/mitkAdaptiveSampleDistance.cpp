@@ -0,0 +1,64 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkAdaptiveSampleDistance.h"
+
+#include <mitkDataNode.h>
+
+#include <algorithm>
+#include <cmath>
+
+mitk::AdaptiveSampleDistance::AdaptiveSampleDistance(bool adaptImageSampleDistance)
+  : m_AdaptImageSampleDistance(adaptImageSampleDistance), m_TargetFrameRate(15.0), m_MaximumFactor(8.0), m_Factor(1.0)
+{
+}
+
+void mitk::AdaptiveSampleDistance::SetMaximumFactor(double factor)
+{
+  m_MaximumFactor = std::max(1.0, factor);
+  m_Factor = std::min(m_Factor, m_MaximumFactor);
+}
+
+void mitk::AdaptiveSampleDistance::UpdateProperties(const DataNode *node, const BaseRenderer *renderer)
+{
+  float frameRate = static_cast<float>(m_TargetFrameRate);
+  if (node != nullptr && node->GetFloatProperty("volumerendering.lod.framerate", frameRate, renderer))
+    m_TargetFrameRate = frameRate;
+}
+
+void mitk::AdaptiveSampleDistance::Update(double renderTime)
+{
+  if (m_TargetFrameRate <= 0.0)
+  {
+    m_Factor = m_MaximumFactor;
+    return;
+  }
+
+  if (renderTime <= 0.0)
+    return;
+
+  // the render time is proportional to factor^-exponent. Going only half the way to the estimated
+  // factor avoids oscillations caused by the varying render times during an interaction
+  const double exponent = m_AdaptImageSampleDistance ? 2.5 : 1.0;
+  const double ratio = renderTime * m_TargetFrameRate / 1000.0;
+  m_Factor = std::max(1.0, std::min(m_Factor * std::pow(ratio, 0.5 / exponent), m_MaximumFactor));
+}
+
+double mitk::AdaptiveSampleDistance::GetImageSampleDistance() const
+{
+  return m_AdaptImageSampleDistance ? m_Factor : 1.0;
+}
+
+double mitk::AdaptiveSampleDistance::GetSampleDistance(double fullQualitySampleDistance) const
+{
+  return fullQualitySampleDistance * (m_AdaptImageSampleDistance ? std::sqrt(m_Factor) : m_Factor);
+}
@@ -278,6 +278,24 @@ void mitk::GPUVolumeMapper3D::GenerateDataForRenderer(mitk::BaseRenderer *render
   UpdateTransferFunctions(renderer);
 }
 
+bool mitk::GPUVolumeMapper3D::UpdateAdaptiveSampleDistance(mitk::BaseRenderer *renderer)
+{
+  LocalStorage *ls = m_LSH.GetLocalStorage(renderer);
+  mitk::RenderingManager *renderingManager = mitk::RenderingManager::GetInstance();
+
+  ls->m_AdaptiveSampleDistance.UpdateProperties(GetDataNode(), renderer);
+
+  // adapt to the last interactive rendering, once per rendering of the window
+  const mitk::RenderingManager::RenderWindowStatistics statistics =
+    renderingManager->GetRenderWindowStatistics(renderer->GetRenderWindow());
+  if (ls->m_LastRenderingInteractive && statistics.NumberOfRenders != ls->m_LastNumberOfRenders)
+    ls->m_AdaptiveSampleDistance.Update(statistics.LastRenderTime);
+  ls->m_LastNumberOfRenders = statistics.NumberOfRenders;
+
+  ls->m_LastRenderingInteractive = IsLODEnabled(renderer) && renderingManager->GetNextLOD(renderer) == 0;
+  return ls->m_LastRenderingInteractive;
+}
+
 void mitk::GPUVolumeMapper3D::GenerateDataGPU(mitk::BaseRenderer * /*renderer*/)
 {
 }
@@ -286,12 +304,10 @@ void mitk::GPUVolumeMapper3D::GenerateDataCPU(mitk::BaseRenderer *renderer)
 {
   LocalStorage *ls = m_LSH.GetLocalStorage(renderer);
 
-  int nextLod = mitk::RenderingManager::GetInstance()->GetNextLOD(renderer);
-
-  if (IsLODEnabled(renderer) && nextLod == 0)
+  if (UpdateAdaptiveSampleDistance(renderer))
   {
-    ls->m_MapperCPU->SetImageSampleDistance(3.5);
-    ls->m_MapperCPU->SetSampleDistance(1.25);
+    ls->m_MapperCPU->SetImageSampleDistance(ls->m_AdaptiveSampleDistance.GetImageSampleDistance());
+    ls->m_MapperCPU->SetSampleDistance(ls->m_AdaptiveSampleDistance.GetSampleDistance(1.0));
     ls->m_VolumePropertyCPU->SetInterpolationTypeToNearest();
   }
   else
@@ -421,6 +437,7 @@ void mitk::GPUVolumeMapper3D::SetDefaultProperties(mitk::DataNode *node, mitk::B
   node->AddProperty("volumerendering", mitk::BoolProperty::New(false), renderer, overwrite);
   node->AddProperty("volumerendering.usemip", mitk::BoolProperty::New(false), renderer, overwrite);
   node->AddProperty("volumerendering.uselod", mitk::BoolProperty::New(false), renderer, overwrite);
+  node->AddProperty("volumerendering.lod.framerate", mitk::FloatProperty::New(15.0f), renderer, overwrite);
 
   node->AddProperty("volumerendering.cpu.ambient", mitk::FloatProperty::New(0.10f), renderer, overwrite);
   node->AddProperty("volumerendering.cpu.diffuse", mitk::FloatProperty::New(0.50f), renderer, overwrite);
@@ -553,10 +570,16 @@ void mitk::GPUVolumeMapper3D::GenerateDataRAY(mitk::BaseRenderer *renderer)
 {
   LocalStorage *ls = m_LSH.GetLocalStorage(renderer);
 
-  if (IsLODEnabled(renderer) && mitk::RenderingManager::GetInstance()->GetNextLOD(renderer) == 0)
-    ls->m_MapperRAY->SetImageSampleDistance(4.0);
+  if (UpdateAdaptiveSampleDistance(renderer))
+  {
+    ls->m_MapperRAY->SetImageSampleDistance(ls->m_AdaptiveSampleDistance.GetImageSampleDistance());
+    ls->m_MapperRAY->SetSampleDistance(ls->m_AdaptiveSampleDistance.GetSampleDistance(1.0));
+  }
   else
+  {
     ls->m_MapperRAY->SetImageSampleDistance(1.0);
+    ls->m_MapperRAY->SetSampleDistance(1.0);
+  }
 
   // Check raycasting mode
   if (IsMIPEnabled(renderer))
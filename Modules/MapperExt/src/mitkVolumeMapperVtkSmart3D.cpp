@@ -14,6 +14,7 @@ found in the LICENSE file.
 #include "mitkTransferFunctionProperty.h"
 #include "mitkTransferFunctionInitializer.h"
 #include "mitkLevelWindowProperty.h"
+#include "mitkRenderingManager.h"
 #include <vtkObjectFactory.h>
 #include <vtkRenderingOpenGL2ObjectFactory.h>
 #include <vtkRenderingVolumeOpenGL2ObjectFactory.h>
@@ -36,6 +37,7 @@ void mitk::VolumeMapperVtkSmart3D::GenerateDataForRenderer(mitk::BaseRenderer *r
 
   UpdateTransferFunctions(renderer);
   UpdateRenderMode(renderer);
+  UpdateSampleDistance(renderer);
   this->Modified();
 }
 
@@ -56,12 +58,20 @@ void mitk::VolumeMapperVtkSmart3D::ApplyProperties(vtkActor *, mitk::BaseRendere
 
 }
 
+bool mitk::VolumeMapperVtkSmart3D::IsLODEnabled(mitk::BaseRenderer *renderer) const
+{
+  bool value = false;
+  return GetDataNode()->GetBoolProperty("volumerendering.uselod", value, renderer) && value;
+}
+
 void mitk::VolumeMapperVtkSmart3D::SetDefaultProperties(mitk::DataNode *node, mitk::BaseRenderer *renderer, bool overwrite)
 {
   // GPU_INFO << "SetDefaultProperties";
 
   node->AddProperty("volumerendering", mitk::BoolProperty::New(false), renderer, overwrite);
   node->AddProperty("volumerendering.usemip", mitk::BoolProperty::New(false), renderer, overwrite);
+  node->AddProperty("volumerendering.uselod", mitk::BoolProperty::New(false), renderer, overwrite);
+  node->AddProperty("volumerendering.lod.framerate", mitk::FloatProperty::New(15.0f), renderer, overwrite);
 
   node->AddProperty("volumerendering.cpu.ambient", mitk::FloatProperty::New(0.10f), renderer, overwrite);
   node->AddProperty("volumerendering.cpu.diffuse", mitk::FloatProperty::New(0.50f), renderer, overwrite);
@@ -221,7 +231,26 @@ void mitk::VolumeMapperVtkSmart3D::UpdateRenderMode(mitk::BaseRenderer *renderer
   }
 }
 
+void mitk::VolumeMapperVtkSmart3D::UpdateSampleDistance(mitk::BaseRenderer *renderer)
+{
+  mitk::RenderingManager *renderingManager = mitk::RenderingManager::GetInstance();
+
+  m_AdaptiveSampleDistance.UpdateProperties(GetDataNode(), renderer);
+
+  // adapt to the last interactive rendering, once per rendering of the window
+  const mitk::RenderingManager::RenderWindowStatistics statistics =
+    renderingManager->GetRenderWindowStatistics(renderer->GetRenderWindow());
+  if (m_LastRenderingInteractive && statistics.NumberOfRenders != m_LastNumberOfRenders)
+    m_AdaptiveSampleDistance.Update(statistics.LastRenderTime);
+  m_LastNumberOfRenders = statistics.NumberOfRenders;
+
+  m_LastRenderingInteractive = IsLODEnabled(renderer) && renderingManager->GetNextLOD(renderer) == 0;
+  m_SmartVolumeMapper->SetSampleDistance(m_LastRenderingInteractive ? m_AdaptiveSampleDistance.GetSampleDistance(1.0)
+                                                                     : 1.0);
+}
+
 mitk::VolumeMapperVtkSmart3D::VolumeMapperVtkSmart3D()
+  : m_AdaptiveSampleDistance(false), m_LastRenderingInteractive(false), m_LastNumberOfRenders(0)
 {
   m_RenderingOpenGL2ObjectFactory = vtkSmartPointer<vtkRenderingOpenGL2ObjectFactory>::New();
   m_RenderingVolumeOpenGL2ObjectFactory = vtkSmartPointer<vtkRenderingVolumeOpenGL2ObjectFactory>::New();
@@ -231,6 +260,8 @@ mitk::VolumeMapperVtkSmart3D::VolumeMapperVtkSmart3D()
 
   m_SmartVolumeMapper = vtkSmartPointer<vtkSmartVolumeMapper>::New();
   m_SmartVolumeMapper->SetBlendModeToComposite();
+  // the sample distance is set by UpdateSampleDistance()
+  m_SmartVolumeMapper->AutoAdjustSampleDistancesOff();
   m_ImageChangeInformation = vtkSmartPointer<vtkImageChangeInformation>::New();
   m_VolumeProperty = vtkSmartPointer<vtkVolumeProperty>::New();
   m_Volume = vtkSmartPointer<vtkVolume>::New();
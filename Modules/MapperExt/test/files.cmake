@@ -1,3 +1,4 @@
 set(MODULE_TESTS
+  mitkAdaptiveSampleDistanceTest.cpp
   mitkSplineVtkMapper3DTest.cpp
 )
@@ -0,0 +1,95 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkAdaptiveSampleDistance.h>
+#include <mitkDataNode.h>
+#include <mitkProperties.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+class mitkAdaptiveSampleDistanceTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkAdaptiveSampleDistanceTestSuite);
+  MITK_TEST(Update_SlowRendering_CoarsensUpToMaximum);
+  MITK_TEST(Update_FastRendering_RefinesToFullQuality);
+  MITK_TEST(Update_SampleDistanceOnly_KeepsImageSampleDistance);
+  MITK_TEST(UpdateProperties_ReadsTargetFrameRate);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void Update_SlowRendering_CoarsensUpToMaximum()
+  {
+    mitk::AdaptiveSampleDistance distance;
+    distance.SetTargetFrameRate(10.0);
+    CPPUNIT_ASSERT_EQUAL(1.0, distance.GetImageSampleDistance());
+
+    // 4 fps instead of 10 fps
+    distance.Update(250.0);
+    const double imageSampleDistance = distance.GetImageSampleDistance();
+    CPPUNIT_ASSERT(imageSampleDistance > 1.0);
+    CPPUNIT_ASSERT(distance.GetSampleDistance(1.0) > 1.0);
+
+    // the target frame rate is reached, nothing changes
+    distance.Update(100.0);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(imageSampleDistance, distance.GetImageSampleDistance(), 1e-12);
+
+    for (int i = 0; i < 100; ++i)
+      distance.Update(1000.0);
+    CPPUNIT_ASSERT_EQUAL(distance.GetMaximumFactor(), distance.GetImageSampleDistance());
+  }
+
+  void Update_FastRendering_RefinesToFullQuality()
+  {
+    mitk::AdaptiveSampleDistance distance;
+    distance.SetTargetFrameRate(10.0);
+    for (int i = 0; i < 10; ++i)
+      distance.Update(500.0);
+    CPPUNIT_ASSERT(distance.GetImageSampleDistance() > 1.0);
+
+    for (int i = 0; i < 100; ++i)
+      distance.Update(5.0);
+    CPPUNIT_ASSERT_EQUAL(1.0, distance.GetImageSampleDistance());
+    CPPUNIT_ASSERT_EQUAL(2.0, distance.GetSampleDistance(2.0));
+
+    // no target frame rate: coarsest rendering
+    distance.SetTargetFrameRate(0.0);
+    distance.Update(5.0);
+    CPPUNIT_ASSERT_EQUAL(distance.GetMaximumFactor(), distance.GetImageSampleDistance());
+    distance.Reset();
+    CPPUNIT_ASSERT_EQUAL(1.0, distance.GetImageSampleDistance());
+  }
+
+  void Update_SampleDistanceOnly_KeepsImageSampleDistance()
+  {
+    mitk::AdaptiveSampleDistance distance(false);
+    distance.SetTargetFrameRate(10.0);
+    distance.Update(400.0);
+
+    CPPUNIT_ASSERT_EQUAL(1.0, distance.GetImageSampleDistance());
+    // half way to the four times larger sample distance
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0, distance.GetSampleDistance(1.0), 1e-12);
+  }
+
+  void UpdateProperties_ReadsTargetFrameRate()
+  {
+    auto node = mitk::DataNode::New();
+    mitk::AdaptiveSampleDistance distance;
+    distance.UpdateProperties(node, nullptr);
+    CPPUNIT_ASSERT_EQUAL(15.0, distance.GetTargetFrameRate());
+
+    node->SetFloatProperty("volumerendering.lod.framerate", 25.0f);
+    distance.UpdateProperties(node, nullptr);
+    CPPUNIT_ASSERT_EQUAL(25.0, distance.GetTargetFrameRate());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkAdaptiveSampleDistance)
@@ -21,12 +21,16 @@ found in the LICENSE file.
 #include <mitkGeometry3D.h>
 #include <mitkImageToItk.h>
 #include <mitkImageTimeSelector.h>
+#include <mitkThreadPool.h>
 
 #include "mapRegistration.h"
 
 #include "mitkImageMappingHelper.h"
 #include "mitkRegistrationHelper.h"
 
+#include <algorithm>
+#include <cmath>
+
 template <typename TImage >
 typename ::itk::InterpolateImageFunction< TImage >::Pointer generateInterpolator(mitk::ImageMappingInterpolator::Type interpolatorType)
 {
@@ -218,6 +222,78 @@ void doMITKMap(const ::itk::Image<TPixelType,VImageDimension>* input, mitk::Imag
   mitk::CastToMitkImage<>(spTask->getResultImage(),result);
 }
 
+/** Maps the input by interpolating it at the moving space positions stored in a precomputed inverse field.
+ * This is equivalent to the MatchPoint ImageMappingTask, but skips the evaluation of the registration kernel
+ * and distributes the interpolation over the thread pool.*/
+template <typename TPixelType, unsigned int VImageDimension >
+void doCachedFieldMap(const ::itk::Image<TPixelType,VImageDimension>* input, mitk::ImageMappingHelper::ResultImageType::Pointer& result,
+  const mitk::MAPRegistrationWrapper::InverseFieldType* field, bool throwOnOutOfInputAreaError, const double& paddingValue,
+  bool throwOnMappingError, const double& errorValue, mitk::ImageMappingInterpolator::Type interpolatorType)
+{
+  typedef ::itk::Image<TPixelType,VImageDimension> ImageType;
+  typedef ::itk::InterpolateImageFunction<ImageType> BaseInterpolatorType;
+
+  const std::size_t PixelsPerTask = 4096;
+
+  typename BaseInterpolatorType::Pointer interpolator = generateInterpolator<ImageType>(interpolatorType);
+  assert(interpolator.IsNotNull());
+  interpolator->SetInputImage(input);
+
+  typename ImageType::Pointer resultImage = ImageType::New();
+  resultImage->SetRegions(field->GetLargestPossibleRegion());
+  resultImage->SetOrigin(field->GetOrigin());
+  resultImage->SetSpacing(field->GetSpacing());
+  resultImage->SetDirection(field->GetDirection());
+  resultImage->Allocate();
+
+  const auto* positions = field->GetBufferPointer();
+  auto* values = resultImage->GetBufferPointer();
+  const double minimum = static_cast<double>(::itk::NumericTraits<TPixelType>::NonpositiveMin());
+  const double maximum = static_cast<double>(::itk::NumericTraits<TPixelType>::max());
+
+  auto mapPixels = [&](std::size_t begin, std::size_t end) {
+    typename BaseInterpolatorType::PointType point;
+
+    for (auto i = begin; i < end; ++i)
+    {
+      double value = errorValue;
+
+      if (std::isnan(positions[i][0]))
+      {
+        if (throwOnMappingError)
+        {
+          mitkThrow() << "Cannot map image. Registration kernel could not map the target position of pixel " << i << ".";
+        }
+      }
+      else
+      {
+        for (unsigned int d = 0; d < VImageDimension; ++d)
+          point[d] = positions[i][d];
+
+        if (interpolator->IsInsideBuffer(point))
+        {
+          value = static_cast<double>(interpolator->Evaluate(point));
+        }
+        else if (throwOnOutOfInputAreaError)
+        {
+          mitkThrow() << "Cannot map image. Mapped position of pixel " << i << " is outside of the input image: " << point;
+        }
+        else
+        {
+          value = paddingValue;
+        }
+      }
+
+      values[i] = static_cast<TPixelType>(std::max(minimum, std::min(maximum, value)));
+    }
+  };
+
+  mitk::ThreadPool::GetInstance().ParallelFor(
+    0, resultImage->GetLargestPossibleRegion().GetNumberOfPixels(), mapPixels, PixelsPerTask);
+
+  mitk::CastToMitkImage<>(resultImage.GetPointer(),result);
+}
+
 mitk::ImageMappingHelper::ResultImageType::Pointer
   mitk::ImageMappingHelper::map(const InputImageType* input, const RegistrationType* registration,
   bool throwOnOutOfInputAreaError, const double& paddingValue, const ResultImageGeometryType* resultGeometry,
@@ -274,7 +350,7 @@ mitk::ImageMappingHelper::ResultImageType::Pointer
 mitk::ImageMappingHelper::ResultImageType::Pointer
   mitk::ImageMappingHelper::map(const InputImageType* input, const MITKRegistrationType* registration,
   bool throwOnOutOfInputAreaError, const double& paddingValue, const ResultImageGeometryType* resultGeometry,
-  bool throwOnMappingError, const double& errorValue, mitk::ImageMappingInterpolator::Type)
+  bool throwOnMappingError, const double& errorValue, mitk::ImageMappingInterpolator::Type interpolatorType)
 {
   if (!registration)
   {
@@ -289,7 +365,52 @@ mitk::ImageMappingHelper::ResultImageType::Pointer
     mitkThrow() << "Cannot map image. Passed image pointer is nullptr.";
   }
 
-  ResultImageType::Pointer result = map(input, registration->GetRegistration(), throwOnOutOfInputAreaError, paddingValue, resultGeometry, throwOnMappingError, errorValue);
+  const bool useCachedField = registration->GetCacheInverseFields() && 3 == registration->GetMovingDimensions() &&
+                              3 == registration->GetTargetDimensions() && input->GetDimension() >= 3;
+
+  if (!useCachedField)
+  {
+    return map(input, registration->GetRegistration(), throwOnOutOfInputAreaError, paddingValue, resultGeometry, throwOnMappingError, errorValue, interpolatorType);
+  }
+
+  //the field is shared by all time steps and by all further mappings onto the same geometry.
+  const ResultImageGeometryType* fieldGeometry = nullptr != resultGeometry ? resultGeometry : input->GetGeometry();
+  MAPRegistrationWrapper::InverseFieldType::ConstPointer field = registration->GetInverseField(fieldGeometry);
+
+  ResultImageType::Pointer result;
+
+  if (input->GetTimeSteps() == 1)
+  {
+    AccessFixedDimensionByItk_n(input, doCachedFieldMap, 3, (result, field.GetPointer(), throwOnOutOfInputAreaError, paddingValue, throwOnMappingError, errorValue, interpolatorType));
+  }
+  else
+  {
+    mitk::TimeGeometry::Pointer mappedTimeGeometry = input->GetTimeGeometry()->Clone();
+
+    for (unsigned int i = 0; i < input->GetTimeSteps(); ++i)
+    {
+      ResultImageGeometryType::Pointer mappedGeometry = fieldGeometry->Clone();
+      mappedTimeGeometry->SetTimeStepGeometry(mappedGeometry, i);
+    }
+
+    result = mitk::Image::New();
+    result->Initialize(input->GetPixelType(), *mappedTimeGeometry, 1, input->GetTimeSteps());
+
+    for (unsigned int i = 0; i < input->GetTimeSteps(); ++i)
+    {
+      mitk::ImageTimeSelector::Pointer imageTimeSelector = mitk::ImageTimeSelector::New();
+      imageTimeSelector->SetInput(input);
+      imageTimeSelector->SetTimeNr(i);
+      imageTimeSelector->UpdateLargestPossibleRegion();
+
+      InputImageType::Pointer timeStepInput = imageTimeSelector->GetOutput();
+      ResultImageType::Pointer timeStepResult;
+      AccessFixedDimensionByItk_n(timeStepInput, doCachedFieldMap, 3, (timeStepResult, field.GetPointer(), throwOnOutOfInputAreaError, paddingValue, throwOnMappingError, errorValue, interpolatorType));
+      mitk::ImageReadAccessor readAccess(timeStepResult);
+      result->SetVolume(readAccess.GetData(), i);
+    }
+  }
+
   return result;
 }
 
@@ -18,6 +18,13 @@ found in the LICENSE file.
 
 #include <mitkMaskedAlgorithmHelper.h>
 #include <mitkAlgorithmHelper.h>
+#include <mitkThreadPool.h>
+
+#include <mapMetaPropertyAlgorithmInterface.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 
 mitk::Image::Pointer
 mitk::TimeFramesRegistrationHelper::GetFrameImage(const mitk::Image* image,
@@ -38,69 +45,137 @@ mitk::TimeFramesRegistrationHelper::Generate()
   CheckValidInputs();
 
   //prepare processing
-  mitk::Image::Pointer targetFrame = GetFrameImage(this->m_4DImage, 0);
-
   this->m_Registered4DImage = this->m_4DImage->Clone();
 
-  Image::ConstPointer mask;
-
-  if (m_TargetMask.IsNotNull())
-  {
-    if (m_TargetMask->GetTimeSteps() > 1)
-    {
-      mask = GetFrameImage(m_TargetMask, 0);
-    }
-    else
-    {
-      mask = m_TargetMask;
-    }
-  }
-
   double progressDelta = 1.0 / ((this->m_4DImage->GetTimeSteps() - 1) * 3.0);
   m_Progress = 0.0;
 
-  //process the frames
+  std::vector<mitk::TimeStepType> frames;
+
   for (unsigned int i = 1; i < this->m_4DImage->GetTimeSteps(); ++i)
   {
-    Image::Pointer movingFrame = GetFrameImage(this->m_4DImage, i);
-    Image::Pointer mappedFrame;
-
     IgnoreListType::iterator finding = std::find(m_IgnoreList.begin(), m_IgnoreList.end(), i);
 
-
     if (finding == m_IgnoreList.end())
     {
       //frame should be processed
-      RegistrationPointer reg = DoFrameRegistration(movingFrame, targetFrame, mask);
-
-      m_Progress += progressDelta;
-      this->InvokeEvent(::mitk::FrameRegistrationEvent(nullptr,
-                        "Registred frame #" +::map::core::convert::toStr(i)));
+      frames.push_back(i);
+    }
+    else
+    {
+      m_Progress += 3 * progressDelta;
+      this->InvokeEvent(::itk::ProgressEvent());
+    }
+  }
 
-      mappedFrame = DoFrameMapping(movingFrame, reg, targetFrame);
+  if (frames.empty())
+  {
+    return;
+  }
 
-      m_Progress += progressDelta;
-      this->InvokeEvent(::mitk::FrameMappingEvent(nullptr,
-                        "Mapped frame #" + ::map::core::convert::toStr(i)));
+  //every concurrently processed frame needs its own algorithm instance
+  std::size_t numberOfConcurrentFrames = m_MaximumNumberOfConcurrentFrames;
 
-      mitk::ImageReadAccessor accessor(mappedFrame, mappedFrame->GetVolumeData(0, 0, nullptr,
-                                       mitk::Image::ReferenceMemory));
+  if (0 == numberOfConcurrentFrames)
+  {
+    numberOfConcurrentFrames = mitk::ThreadPool::GetInstance().GetRecommendedNumberOfThreads();
+  }
 
+  std::vector<RegistrationAlgorithmPointer> algorithms(1, m_Algorithm);
 
-      this->m_Registered4DImage->SetVolume(accessor.GetData(), i);
-      this->m_Registered4DImage->GetTimeGeometry()->SetTimeStepGeometry(mappedFrame->GetGeometry(), i);
+  while (algorithms.size() < std::min(numberOfConcurrentFrames, frames.size()))
+  {
+    RegistrationAlgorithmPointer algorithm = CloneAlgorithm();
 
-      m_Progress += progressDelta;
-    }
-    else
+    if (algorithm.IsNull())
     {
-      m_Progress += 3 * progressDelta;
+      MITK_INFO << "Registration algorithm cannot be copied. Frames are registered one after another.";
+      break;
     }
 
-    this->InvokeEvent(::itk::ProgressEvent());
-
+    algorithms.push_back(algorithm);
   }
 
+  //Guards the inputs, the result, the progress and the events. Selecting time steps of the
+  //shared input images updates their pipeline and is therefore not done concurrently.
+  std::mutex mutex;
+  std::atomic<std::size_t> nextFrame(0);
+  std::atomic<bool> failed(false);
+
+  auto processFrames = [&](std::size_t begin, std::size_t end)
+  {
+    for (auto algorithmIndex = begin; algorithmIndex < end; ++algorithmIndex)
+    {
+      Image::Pointer targetFrame;
+      Image::ConstPointer mask;
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        targetFrame = GetFrameImage(this->m_4DImage, 0);
+
+        if (m_TargetMask.IsNotNull())
+        {
+          if (m_TargetMask->GetTimeSteps() > 1)
+          {
+            mask = GetFrameImage(m_TargetMask, 0);
+          }
+          else
+          {
+            mask = m_TargetMask->Clone();
+          }
+        }
+      }
+
+      for (auto frameIndex = nextFrame++; frameIndex < frames.size() && !failed; frameIndex = nextFrame++)
+      {
+        const auto i = frames[frameIndex];
+
+        try
+        {
+          Image::Pointer movingFrame;
+
+          {
+            std::lock_guard<std::mutex> lock(mutex);
+            movingFrame = GetFrameImage(this->m_4DImage, i);
+          }
+
+          RegistrationPointer reg = DoFrameRegistration(algorithms[algorithmIndex], movingFrame, targetFrame, mask);
+
+          {
+            std::lock_guard<std::mutex> lock(mutex);
+            m_Progress += progressDelta;
+            this->InvokeEvent(::mitk::FrameRegistrationEvent(nullptr,
+                              "Registred frame #" +::map::core::convert::toStr(i)));
+          }
+
+          Image::Pointer mappedFrame = DoFrameMapping(movingFrame, reg, targetFrame);
+
+          //stream the mapped frame into the result
+          std::lock_guard<std::mutex> lock(mutex);
+
+          m_Progress += progressDelta;
+          this->InvokeEvent(::mitk::FrameMappingEvent(nullptr,
+                            "Mapped frame #" + ::map::core::convert::toStr(i)));
+
+          mitk::ImageReadAccessor accessor(mappedFrame, mappedFrame->GetVolumeData(0, 0, nullptr,
+                                           mitk::Image::ReferenceMemory));
+
+          this->m_Registered4DImage->SetVolume(accessor.GetData(), i);
+          this->m_Registered4DImage->GetTimeGeometry()->SetTimeStepGeometry(mappedFrame->GetGeometry(), i);
+
+          m_Progress += progressDelta;
+          this->InvokeEvent(::itk::ProgressEvent());
+        }
+        catch (...)
+        {
+          failed = true;
+          throw;
+        }
+      }
+    }
+  };
+
+  mitk::ThreadPool::GetInstance().ParallelFor(0, algorithms.size(), processFrames);
 };
 
 mitk::Image::Pointer
@@ -131,22 +206,59 @@ mitk::TimeFramesRegistrationHelper::ClearIgnoreList()
 
 
 mitk::TimeFramesRegistrationHelper::RegistrationPointer
-mitk::TimeFramesRegistrationHelper::DoFrameRegistration(const mitk::Image* movingFrame,
-    const mitk::Image* targetFrame, const mitk::Image* targetMask) const
+mitk::TimeFramesRegistrationHelper::DoFrameRegistration(RegistrationAlgorithmBaseType* algorithm,
+    const mitk::Image* movingFrame, const mitk::Image* targetFrame, const mitk::Image* targetMask) const
 {
-  mitk::MITKAlgorithmHelper algHelper(m_Algorithm);
+  mitk::MITKAlgorithmHelper algHelper(algorithm);
   algHelper.SetAllowImageCasting(true);
   algHelper.SetData(movingFrame, targetFrame);
 
   if (targetMask)
   {
-    mitk::MaskedAlgorithmHelper maskHelper(m_Algorithm);
+    mitk::MaskedAlgorithmHelper maskHelper(algorithm);
     maskHelper.SetMasks(nullptr, targetMask);
   }
 
   return algHelper.GetRegistration();
 };
 
+mitk::TimeFramesRegistrationHelper::RegistrationAlgorithmPointer
+mitk::TimeFramesRegistrationHelper::CloneAlgorithm() const
+{
+  typedef ::map::algorithm::facet::MetaPropertyAlgorithmInterface MetaInterfaceType;
+
+  MetaInterfaceType* metaInterface = dynamic_cast<MetaInterfaceType*>(m_Algorithm.GetPointer());
+
+  if (!metaInterface)
+  {
+    return nullptr;
+  }
+
+  ::itk::LightObject::Pointer another = m_Algorithm->CreateAnother();
+  RegistrationAlgorithmPointer algorithm = dynamic_cast<RegistrationAlgorithmBaseType*>(another.GetPointer());
+  MetaInterfaceType* anotherMetaInterface = dynamic_cast<MetaInterfaceType*>(algorithm.GetPointer());
+
+  if (!anotherMetaInterface)
+  {
+    return nullptr;
+  }
+
+  for (const auto& info : metaInterface->getPropertyInfos())
+  {
+    if (info->isReadable() && info->isWritable())
+    {
+      MetaInterfaceType::MetaPropertyPointer property = metaInterface->getProperty(info);
+
+      if (!property || !anotherMetaInterface->setProperty(info, property))
+      {
+        return nullptr;
+      }
+    }
+  }
+
+  return algorithm;
+};
+
 mitk::Image::Pointer mitk::TimeFramesRegistrationHelper::DoFrameMapping(
   const mitk::Image* movingFrame, const RegistrationType* reg, const mitk::Image* targetFrame) const
 {
@@ -39,6 +39,12 @@ namespace mitk
    * - mitk::FrameRegistrationEvent: when ever a frame was registered.
    * - mitk::FrameMappingEvent: when ever a frame was mapped registered.
    * - itk::ProgressEvent: when ever a new frame was added to the result image.
+   *
+   * Frames are registered and mapped concurrently on the mitk::ThreadPool. Every concurrently processed frame
+   * needs its own algorithm instance. These are created with CreateAnother() and get the meta properties of the
+   * set algorithm. If the algorithm does not support meta properties, the frames are processed one after another.
+   * Each mapped frame is copied into the result image as soon as it is available. The events may therefore be
+   * invoked from different threads (but never concurrently) and frames may finish in any order.
    */
   class MITKMATCHPOINTREGISTRATION_EXPORT TimeFramesRegistrationHelper : public itk::Object
   {
@@ -78,6 +84,12 @@ namespace mitk
     itkSetMacro(InterpolatorType, mitk::ImageMappingInterpolator::Type);
     itkGetConstMacro(InterpolatorType, mitk::ImageMappingInterpolator::Type);
 
+    /** Maximum number of frames that are processed concurrently. 0 (default) uses the recommended number of threads
+     * of the mitk::ThreadPool. Reduce it for algorithms that use many threads themselves, e.g. multi-threaded
+     * ITK metrics, or 1 to process the frames one after another with the set algorithm instance.*/
+    itkSetMacro(MaximumNumberOfConcurrentFrames, unsigned int);
+    itkGetConstMacro(MaximumNumberOfConcurrentFrames, unsigned int);
+
     /** cleares the ignore list. Therefore all frames will be processed.*/
     void ClearIgnoreList();
     void SetIgnoreList(const IgnoreListType& il);
@@ -110,6 +122,7 @@ namespace mitk
       m_AllowUnregPixels(true),
       m_ErrorValue(0),
       m_InterpolatorType(mitk::ImageMappingInterpolator::Linear),
+      m_MaximumNumberOfConcurrentFrames(0),
       m_Progress(0)
     {
       m_4DImage = nullptr;
@@ -119,7 +132,7 @@ namespace mitk
 
     ~TimeFramesRegistrationHelper() override {};
 
-    RegistrationPointer DoFrameRegistration(const mitk::Image* movingFrame,
+    RegistrationPointer DoFrameRegistration(RegistrationAlgorithmBaseType* algorithm, const mitk::Image* movingFrame,
                                             const mitk::Image* targetFrame, const mitk::Image* targetMask) const;
 
     mitk::Image::Pointer DoFrameMapping(const mitk::Image* movingFrame, const RegistrationType* reg,
@@ -132,6 +145,10 @@ namespace mitk
 
     mitk::Image::Pointer GetFrameImage(const mitk::Image* image, mitk::TimePointType timePoint) const;
 
+    /** Creates another instance of the algorithm with the same meta property values.
+     * Returns nullptr if the algorithm cannot be copied.*/
+    RegistrationAlgorithmPointer CloneAlgorithm() const;
+
     RegistrationAlgorithmPointer m_Algorithm;
 
   private:
@@ -151,6 +168,8 @@ namespace mitk
     double m_ErrorValue;
     /** Type of interpolator. Only relevant for images and if m_doGeometryRefinement is false. */
     mitk::ImageMappingInterpolator::Type m_InterpolatorType;
+    /** Maximum number of frames that are processed concurrently. 0 uses the recommended number of threads.*/
+    unsigned int m_MaximumNumberOfConcurrentFrames;
 
     double m_Progress;
   };
@@ -18,6 +18,7 @@ found in the LICENSE file.
 #include <mitkLookupTableProperty.h>
 #include <mitkPlaneGeometry.h>
 #include <mitkProperties.h>
+#include <mitkRenderingManager.h>
 #include <mitkResliceMethodProperty.h>
 #include <mitkVtkResliceInterpolationProperty.h>
 #include <mitkPixelType.h>
@@ -35,6 +36,7 @@ found in the LICENSE file.
 #include "vtkMitkThickSlicesFilter.h"
 #include "vtkMitkLevelWindowFilter.h"
 #include "vtkNeverTranslucentTexture.h"
+#include "vtkMitkRegEvaluationShaderMapper.h"
 
 //VTK
 #include <vtkProperty.h>
@@ -68,6 +70,20 @@ found in the LICENSE file.
 #include <mitkRegEvaluationObject.h>
 #include <mitkImageMappingHelper.h>
 
+namespace
+{
+  /** True if the evaluation styles are to be composited on the GPU (see vtkMitkRegEvaluationShaderMapper) */
+  bool IsShaderEvaluationEnabled()
+  {
+    mitk::RenderingManager *renderingManager = mitk::RenderingManager::GetInstance();
+    if (renderingManager == nullptr)
+      return false;
+
+    auto *enabled = dynamic_cast<mitk::BoolProperty *>(renderingManager->GetProperty("shader-level-window-rendering"));
+    return enabled != nullptr && enabled->GetValue();
+  }
+}
+
 mitk::RegEvaluationMapper2D::RegEvaluationMapper2D()
 {
 }
@@ -349,7 +365,11 @@ void mitk::RegEvaluationMapper2D::GenerateDataForRenderer( mitk::BaseRenderer *r
   bool isContourOutdated = mitk::PropertyIsOutdated(datanode,mitk::nodeProp_RegEvalTargetContour,localStorage->m_LastUpdateTime);
   bool isPositionOutdated = mitk::PropertyIsOutdated(datanode, mitk::nodeProp_RegEvalCurrentPosition, localStorage->m_LastUpdateTime);
 
+  const bool shaderEvaluation = IsShaderEvaluationEnabled();
+  const bool isModeOutdated = shaderEvaluation != (localStorage->m_Actor->GetMapper() == localStorage->m_ShaderMapper.GetPointer());
+
   if (updated ||
+    isModeOutdated ||
     isStyleOutdated ||
     isBlendOutdated ||
     isCheckerOutdated ||
@@ -360,7 +380,7 @@ void mitk::RegEvaluationMapper2D::GenerateDataForRenderer( mitk::BaseRenderer *r
     mitk::RegEvalStyleProperty::Pointer evalStyleProp = mitk::RegEvalStyleProperty::New();
     datanode->GetProperty(evalStyleProp, mitk::nodeProp_RegEvalStyle);
 
-    switch (evalStyleProp->GetValueAsId())
+    switch (shaderEvaluation ? -1 : evalStyleProp->GetValueAsId())
     {
     case 0 :
       {
@@ -379,17 +399,7 @@ void mitk::RegEvaluationMapper2D::GenerateDataForRenderer( mitk::BaseRenderer *r
       }
     case 3 :
       {
-        const PlaneGeometry *worldGeometry = renderer->GetCurrentWorldPlaneGeometry();
-
-        Point3D currentPos3D;
-        datanode->GetPropertyValue<Point3D>(mitk::nodeProp_RegEvalCurrentPosition, currentPos3D);
-
-        Point2D currentPos2D;
-        worldGeometry->Map(currentPos3D, currentPos2D);
-        Point2D currentIndex2D;
-        worldGeometry->WorldToIndex(currentPos2D, currentIndex2D);
-
-        PrepareWipe(datanode, localStorage, currentIndex2D);
+        PrepareWipe(datanode, localStorage, this->GetWipePosition(renderer, datanode));
         break;
       }
     case 4 :
@@ -402,6 +412,11 @@ void mitk::RegEvaluationMapper2D::GenerateDataForRenderer( mitk::BaseRenderer *r
         PrepareContour(datanode, localStorage);
         break;
       }
+    default :
+      {
+        PrepareShaderStyle(renderer, datanode, localStorage);
+        break;
+      }
     }
     updated = true;
   }
@@ -419,24 +434,37 @@ void mitk::RegEvaluationMapper2D::GenerateDataForRenderer( mitk::BaseRenderer *r
     bool textureInterpolation = false;
     GetDataNode()->GetBoolProperty( "texture interpolation", textureInterpolation, renderer );
 
-    //set the interpolation modus according to the property
-    localStorage->m_Texture->SetInterpolate(textureInterpolation);
-
-    // connect the texture with the output of the levelwindow filter
-    localStorage->m_Texture->SetInputData(localStorage->m_EvaluationImage);
-
     this->TransformActor( renderer );
 
     vtkActor* contourShadowActor = dynamic_cast<vtkActor*> (localStorage->m_Actors->GetParts()->GetItemAsObject(0));
 
-    //Connect the mapper with the input texture. This is the standard case.
     //setup the textured plane
     this->GeneratePlane( renderer, sliceBounds );
-    //set the plane as input for the mapper
-    localStorage->m_Mapper->SetInputConnection(localStorage->m_Plane->GetOutputPort());
-    //set the texture for the actor
 
-    localStorage->m_Actor->SetTexture(localStorage->m_Texture);
+    if (shaderEvaluation)
+    {
+      //the shader mapper samples the level windowed slices itself, no texture is needed
+      localStorage->m_ShaderMapper->SetTextureInterpolation(textureInterpolation);
+      localStorage->m_ShaderMapper->SetInputConnection(localStorage->m_Plane->GetOutputPort());
+      localStorage->m_Actor->SetMapper(localStorage->m_ShaderMapper);
+      localStorage->m_Actor->SetTexture(nullptr);
+    }
+    else
+    {
+      //set the interpolation modus according to the property
+      localStorage->m_Texture->SetInterpolate(textureInterpolation);
+
+      // connect the texture with the output of the levelwindow filter
+      localStorage->m_Texture->SetInputData(localStorage->m_EvaluationImage);
+
+      //Connect the mapper with the input texture. This is the standard case.
+      //set the plane as input for the mapper
+      localStorage->m_Mapper->SetInputConnection(localStorage->m_Plane->GetOutputPort());
+      localStorage->m_Actor->SetMapper(localStorage->m_Mapper);
+      //set the texture for the actor
+      localStorage->m_Actor->SetTexture(localStorage->m_Texture);
+    }
+
     contourShadowActor->SetVisibility( false );
 
     // We have been modified => save this for next Update()
@@ -581,6 +609,54 @@ void mitk::RegEvaluationMapper2D::PrepareBlend( mitk::DataNode* datanode, LocalS
   localStorage->m_EvaluationImage = blendFilter->GetOutput();
 }
 
+void mitk::RegEvaluationMapper2D::PrepareShaderStyle(mitk::BaseRenderer* renderer, mitk::DataNode* datanode, LocalStorage * localStorage)
+{
+  //the level window filters only execute if the slices or the level windows changed
+  localStorage->m_TargetLevelWindowFilter->Update();
+  localStorage->m_MappedLevelWindowFilter->Update();
+
+  vtkMitkRegEvaluationShaderMapper* shaderMapper = localStorage->m_ShaderMapper;
+  shaderMapper->SetTargetSlice(localStorage->m_TargetLevelWindowFilter->GetOutput());
+  shaderMapper->SetMovingSlice(localStorage->m_MappedLevelWindowFilter->GetOutput());
+  shaderMapper->SetSliceSpacing(localStorage->m_mmPerPixel[0], localStorage->m_mmPerPixel[1]);
+
+  mitk::RegEvalStyleProperty::Pointer evalStyleProp = mitk::RegEvalStyleProperty::New();
+  datanode->GetProperty(evalStyleProp, mitk::nodeProp_RegEvalStyle);
+  shaderMapper->SetStyle(evalStyleProp->GetValueAsId());
+
+  int blendfactor = 50;
+  datanode->GetIntProperty(mitk::nodeProp_RegEvalBlendFactor, blendfactor);
+  shaderMapper->SetBlendFactor(blendfactor / 100.f);
+
+  int checkerCount = 5;
+  datanode->GetIntProperty(mitk::nodeProp_RegEvalCheckerCount, checkerCount);
+  shaderMapper->SetCheckerCount(checkerCount);
+
+  bool targetContour = true;
+  datanode->GetBoolProperty(mitk::nodeProp_RegEvalTargetContour, targetContour);
+  shaderMapper->SetTargetContour(targetContour);
+
+  mitk::RegEvalWipeStyleProperty::Pointer evalWipeStyleProp = mitk::RegEvalWipeStyleProperty::New();
+  datanode->GetProperty(evalWipeStyleProp, mitk::nodeProp_RegEvalWipeStyle);
+  const Point2D wipePosition = this->GetWipePosition(renderer, datanode);
+  shaderMapper->SetWipe(evalWipeStyleProp->GetValueAsId(), wipePosition[0], wipePosition[1]);
+}
+
+mitk::Point2D mitk::RegEvaluationMapper2D::GetWipePosition(mitk::BaseRenderer* renderer, mitk::DataNode* datanode)
+{
+  const PlaneGeometry *worldGeometry = renderer->GetCurrentWorldPlaneGeometry();
+
+  Point3D currentPos3D;
+  datanode->GetPropertyValue<Point3D>(mitk::nodeProp_RegEvalCurrentPosition, currentPos3D);
+
+  Point2D currentPos2D;
+  worldGeometry->Map(currentPos3D, currentPos2D);
+  Point2D currentIndex2D;
+  worldGeometry->WorldToIndex(currentPos2D, currentIndex2D);
+
+  return currentIndex2D;
+}
+
 void mitk::RegEvaluationMapper2D::ApplyLevelWindow(mitk::BaseRenderer *renderer, const mitk::DataNode* dataNode, vtkMitkLevelWindowFilter* levelFilter)
 {
   LevelWindow levelWindow;
@@ -808,6 +884,7 @@ mitk::RegEvaluationMapper2D::LocalStorage::LocalStorage()
   m_DefaultLookupTable = vtkSmartPointer<vtkLookupTable>::New();
   m_ColorLookupTable = vtkSmartPointer<vtkLookupTable>::New();
   m_Mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+  m_ShaderMapper = vtkSmartPointer<vtkMitkRegEvaluationShaderMapper>::New();
   m_Actor = vtkSmartPointer<vtkActor>::New();
   m_Actors = vtkSmartPointer<vtkPropAssembly>::New();
   m_Reslicer = mitk::ExtractSliceFilter::New();
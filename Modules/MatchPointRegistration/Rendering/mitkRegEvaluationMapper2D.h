@@ -45,10 +45,16 @@ class vtkMitkThickSlicesFilter;
 class vtkPolyData;
 class vtkMitkApplyLevelWindowToRGBFilter;
 class vtkMitkLevelWindowFilter;
+class vtkMitkRegEvaluationShaderMapper;
 
 namespace mitk {
 
 /** \brief Mapper to resample and display 2D slices of registration evaluation visualization.
+ *
+ * If the RenderingManager property "shader-level-window-rendering" is enabled, the evaluation
+ * styles are composited on the GPU by vtkMitkRegEvaluationShaderMapper. Changing the style or
+ * its parameters (e.g. dragging the wipe) then only updates shader uniforms; the level windowed
+ * target and mapped moving slices are kept until the slice, the data or the level window changes.
  * \ingroup Mapper
  */
 class MITKMATCHPOINTREGISTRATION_EXPORT RegEvaluationMapper2D : public VtkMapper
@@ -95,6 +101,8 @@ public:
     vtkSmartPointer<vtkPropAssembly> m_Actors;
     /** \brief Mapper of a 2D render window. */
     vtkSmartPointer<vtkPolyDataMapper> m_Mapper;
+    /** \brief Mapper compositing the evaluation styles on the GPU, used instead of m_Mapper and m_Texture if enabled. */
+    vtkSmartPointer<vtkMitkRegEvaluationShaderMapper> m_ShaderMapper;
     /** \brief Current slice of a 2D render window.*/
     vtkSmartPointer<vtkImageData> m_EvaluationImage;
 
@@ -206,6 +214,12 @@ protected:
 
   void PrepareBlend( mitk::DataNode* datanode, LocalStorage * localStorage );
 
+  /** \brief Passes the evaluation style and its parameters to the shader mapper instead of compositing on the CPU. */
+  void PrepareShaderStyle(mitk::BaseRenderer* renderer, mitk::DataNode* datanode, LocalStorage * localStorage);
+
+  /** \brief Returns the current wipe position in pixels of the slice of the given renderer. */
+  Point2D GetWipePosition(mitk::BaseRenderer* renderer, mitk::DataNode* datanode);
+
   /** \brief This method uses the vtkCamera clipping range and the layer property
     * to calcualte the depth of the object (e.g. image or contour). The depth is used
     * to keep the correct order for the final VTK rendering.*/
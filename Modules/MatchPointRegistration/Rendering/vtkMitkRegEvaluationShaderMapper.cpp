@@ -0,0 +1,326 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "vtkMitkRegEvaluationShaderMapper.h"
+
+#include <vtkDataArray.h>
+#include <vtkObjectFactory.h>
+#include <vtkOpenGLHelper.h>
+#include <vtkOpenGLRenderWindow.h>
+#include <vtkPointData.h>
+#include <vtkRenderer.h>
+#include <vtkShaderProgram.h>
+#include <vtkTextureObject.h>
+
+#include <algorithm>
+
+namespace
+{
+  const char *VertexShaderDeclarations = "//VTK::TCoord::Dec\n"
+                                         "in vec2 tcoordMC;\n"
+                                         "out vec2 regEvalTCoordVSOutput;\n";
+
+  const char *VertexShaderImplementation = "//VTK::TCoord::Impl\n"
+                                           "regEvalTCoordVSOutput = tcoordMC;\n";
+
+  // The styles reproduce the vtk filters used by RegEvaluationMapper2D on the CPU: vtkImageWeightedSum,
+  // vtkImageAppendComponents, vtkImageCheckerboard, vtkImageRectilinearWipe, vtkImageMathematics and
+  // vtkImageGradientMagnitude. All styles except checkerboard and wipe use the red channel only.
+  const char *FragmentShaderDeclarations =
+    "//VTK::TCoord::Dec\n"
+    "in vec2 regEvalTCoordVSOutput;\n"
+    "uniform sampler2D regEvalTarget;\n"
+    "uniform sampler2D regEvalMoving;\n"
+    "uniform int regEvalStyle;\n"
+    "uniform float regEvalBlendFactor;\n"
+    "uniform int regEvalCheckerCount;\n"
+    "uniform int regEvalWipeStyle;\n"
+    "uniform vec2 regEvalWipePosition;\n"
+    "uniform int regEvalTargetContour;\n"
+    "uniform vec2 regEvalGradientScale;\n"
+    "float regEvalGradientMagnitude(sampler2D slice, ivec2 pixel)\n"
+    "{\n"
+    "  ivec2 last = textureSize(slice, 0) - 1;\n"
+    "  float dx = texelFetch(slice, clamp(pixel - ivec2(1, 0), ivec2(0), last), 0).r -\n"
+    "             texelFetch(slice, clamp(pixel + ivec2(1, 0), ivec2(0), last), 0).r;\n"
+    "  float dy = texelFetch(slice, clamp(pixel - ivec2(0, 1), ivec2(0), last), 0).r -\n"
+    "             texelFetch(slice, clamp(pixel + ivec2(0, 1), ivec2(0), last), 0).r;\n"
+    "  return min(floor(length(vec2(dx, dy) * regEvalGradientScale) * 255.0), 255.0) / 255.0;\n"
+    "}\n";
+
+  const char *FragmentShaderImplementation =
+    "//VTK::TCoord::Impl\n"
+    "ivec2 regEvalSize = textureSize(regEvalTarget, 0);\n"
+    "ivec2 regEvalPixel = clamp(ivec2(floor(regEvalTCoordVSOutput * vec2(regEvalSize))), ivec2(0), regEvalSize - 1);\n"
+    "vec4 regEvalTargetColor = texture(regEvalTarget, regEvalTCoordVSOutput);\n"
+    "vec4 regEvalMovingColor = texture(regEvalMoving, regEvalTCoordVSOutput);\n"
+    "vec4 regEvalColor;\n"
+    "if (regEvalStyle == 0)\n"
+    "{\n"
+    "  regEvalColor = vec4(vec3(mix(regEvalTargetColor.r, regEvalMovingColor.r, regEvalBlendFactor)), 1.0);\n"
+    "}\n"
+    "else if (regEvalStyle == 1)\n"
+    "{\n"
+    "  regEvalColor = vec4(regEvalMovingColor.r, regEvalMovingColor.r, regEvalTargetColor.r, 1.0);\n"
+    "}\n"
+    "else if (regEvalStyle == 2)\n"
+    "{\n"
+    "  ivec2 regEvalCell = regEvalPixel / max(regEvalSize / max(regEvalCheckerCount, 1), ivec2(1));\n"
+    "  regEvalColor = (regEvalCell.x + regEvalCell.y) % 2 == 0 ? regEvalTargetColor : regEvalMovingColor;\n"
+    "}\n"
+    "else if (regEvalStyle == 3)\n"
+    "{\n"
+    "  bvec2 regEvalBelow = lessThan(regEvalPixel, ivec2(regEvalWipePosition));\n"
+    "  bool regEvalUseTarget = regEvalWipeStyle == 1 ? regEvalBelow.x :\n"
+    "                          (regEvalWipeStyle == 2 ? regEvalBelow.y : regEvalBelow.x == regEvalBelow.y);\n"
+    "  regEvalColor = regEvalUseTarget ? regEvalTargetColor : regEvalMovingColor;\n"
+    "}\n"
+    "else if (regEvalStyle == 4)\n"
+    "{\n"
+    "  regEvalColor = vec4(vec3(abs(regEvalTargetColor.r - regEvalMovingColor.r)), 1.0);\n"
+    "}\n"
+    "else\n"
+    "{\n"
+    "  float regEvalEdge = regEvalTargetContour != 0 ? regEvalGradientMagnitude(regEvalTarget, regEvalPixel)\n"
+    "                                                : regEvalGradientMagnitude(regEvalMoving, regEvalPixel);\n"
+    "  float regEvalOther = regEvalTargetContour != 0 ? regEvalMovingColor.r : regEvalTargetColor.r;\n"
+    "  regEvalColor = vec4(regEvalEdge, regEvalEdge, regEvalOther, 1.0);\n"
+    "}\n"
+    "gl_FragData[0] = gl_FragData[0] * regEvalColor;\n";
+}
+
+vtkStandardNewMacro(vtkMitkRegEvaluationShaderMapper);
+
+vtkMitkRegEvaluationShaderMapper::vtkMitkRegEvaluationShaderMapper()
+  : m_TargetTexture(vtkSmartPointer<vtkTextureObject>::New()),
+    m_MovingTexture(vtkSmartPointer<vtkTextureObject>::New()),
+    m_TargetTextureOutdated(true),
+    m_MovingTextureOutdated(true),
+    m_TexturesActive(false),
+    m_Style(Blend),
+    m_BlendFactor(0.5f),
+    m_CheckerCount(3),
+    m_WipeStyle(0),
+    m_TargetContour(true),
+    m_TextureInterpolation(false)
+{
+  m_WipePosition[0] = m_WipePosition[1] = 0.0;
+  m_SliceSpacing[0] = m_SliceSpacing[1] = 1.0;
+
+  // colors are taken from the slices, not from point scalars
+  this->ScalarVisibilityOff();
+}
+
+vtkMitkRegEvaluationShaderMapper::~vtkMitkRegEvaluationShaderMapper()
+{
+}
+
+void vtkMitkRegEvaluationShaderMapper::SetTargetSlice(vtkImageData *slice)
+{
+  if (m_TargetSlice != slice)
+  {
+    m_TargetSlice = slice;
+    m_TargetTextureOutdated = true;
+    this->Modified();
+  }
+}
+
+void vtkMitkRegEvaluationShaderMapper::SetMovingSlice(vtkImageData *slice)
+{
+  if (m_MovingSlice != slice)
+  {
+    m_MovingSlice = slice;
+    m_MovingTextureOutdated = true;
+    this->Modified();
+  }
+}
+
+void vtkMitkRegEvaluationShaderMapper::SetStyle(int style)
+{
+  m_Style = style;
+}
+
+void vtkMitkRegEvaluationShaderMapper::SetBlendFactor(float factor)
+{
+  m_BlendFactor = std::max(0.0f, std::min(1.0f, factor));
+}
+
+void vtkMitkRegEvaluationShaderMapper::SetCheckerCount(int count)
+{
+  m_CheckerCount = count;
+}
+
+void vtkMitkRegEvaluationShaderMapper::SetWipe(int wipeStyle, double positionX, double positionY)
+{
+  m_WipeStyle = wipeStyle;
+  m_WipePosition[0] = positionX;
+  m_WipePosition[1] = positionY;
+}
+
+void vtkMitkRegEvaluationShaderMapper::SetTargetContour(bool targetContour)
+{
+  m_TargetContour = targetContour;
+}
+
+void vtkMitkRegEvaluationShaderMapper::SetSliceSpacing(double spacingX, double spacingY)
+{
+  m_SliceSpacing[0] = spacingX;
+  m_SliceSpacing[1] = spacingY;
+}
+
+void vtkMitkRegEvaluationShaderMapper::SetTextureInterpolation(bool interpolate)
+{
+  m_TextureInterpolation = interpolate;
+}
+
+void vtkMitkRegEvaluationShaderMapper::ReleaseGraphicsResources(vtkWindow *window)
+{
+  m_TargetTexture->ReleaseGraphicsResources(window);
+  m_MovingTexture->ReleaseGraphicsResources(window);
+  m_TargetTextureOutdated = true;
+  m_MovingTextureOutdated = true;
+
+  this->Superclass::ReleaseGraphicsResources(window);
+}
+
+void vtkMitkRegEvaluationShaderMapper::ReplaceShaderValues(std::map<vtkShader::Type, vtkShader *> shaders,
+                                                           vtkRenderer *ren,
+                                                           vtkActor *act)
+{
+  // The actor has no texture, so the superclass leaves the texture coordinate tags alone
+  std::string vertexShader = shaders[vtkShader::Vertex]->GetSource();
+  vtkShaderProgram::Substitute(vertexShader, "//VTK::TCoord::Dec", VertexShaderDeclarations);
+  vtkShaderProgram::Substitute(vertexShader, "//VTK::TCoord::Impl", VertexShaderImplementation);
+  shaders[vtkShader::Vertex]->SetSource(vertexShader);
+
+  std::string fragmentShader = shaders[vtkShader::Fragment]->GetSource();
+  vtkShaderProgram::Substitute(fragmentShader, "//VTK::TCoord::Dec", FragmentShaderDeclarations);
+  vtkShaderProgram::Substitute(fragmentShader, "//VTK::TCoord::Impl", FragmentShaderImplementation);
+  shaders[vtkShader::Fragment]->SetSource(fragmentShader);
+
+  this->Superclass::ReplaceShaderValues(shaders, ren, act);
+}
+
+bool vtkMitkRegEvaluationShaderMapper::UploadSlice(vtkImageData *slice, vtkTextureObject *texture)
+{
+  vtkDataArray *scalars = slice->GetPointData()->GetScalars();
+
+  if (scalars == nullptr || scalars->GetDataType() != VTK_UNSIGNED_CHAR || scalars->GetNumberOfComponents() != 4)
+  {
+    vtkErrorMacro(<< "UploadSlice: Slice is not an RGBA unsigned char image");
+    return false;
+  }
+
+  const int *dimensions = slice->GetDimensions();
+  texture->SetWrapS(vtkTextureObject::ClampToEdge);
+  texture->SetWrapT(vtkTextureObject::ClampToEdge);
+  return texture->Create2DFromRaw(dimensions[0], dimensions[1], 4, VTK_UNSIGNED_CHAR, scalars->GetVoidPointer(0));
+}
+
+bool vtkMitkRegEvaluationShaderMapper::UploadTextures(vtkRenderer *ren)
+{
+  auto *renderWindow = vtkOpenGLRenderWindow::SafeDownCast(ren->GetRenderWindow());
+
+  if (m_TargetTexture->GetContext() != renderWindow)
+  {
+    m_TargetTexture->SetContext(renderWindow);
+    m_MovingTexture->SetContext(renderWindow);
+    m_TargetTextureOutdated = true;
+    m_MovingTextureOutdated = true;
+  }
+
+  if (m_TargetSlice->GetDimensions()[0] != m_MovingSlice->GetDimensions()[0] ||
+      m_TargetSlice->GetDimensions()[1] != m_MovingSlice->GetDimensions()[1])
+  {
+    vtkErrorMacro(<< "UploadTextures: Target and moving slice differ in size");
+    return false;
+  }
+
+  if (m_TargetTextureOutdated || m_TargetSlice->GetMTime() > m_TargetUploadTime)
+  {
+    if (!this->UploadSlice(m_TargetSlice, m_TargetTexture))
+      return false;
+
+    m_TargetTextureOutdated = false;
+    m_TargetUploadTime.Modified();
+  }
+
+  if (m_MovingTextureOutdated || m_MovingSlice->GetMTime() > m_MovingUploadTime)
+  {
+    if (!this->UploadSlice(m_MovingSlice, m_MovingTexture))
+      return false;
+
+    m_MovingTextureOutdated = false;
+    m_MovingUploadTime.Modified();
+  }
+
+  // the filter is only a sampling parameter, switching it does not re-upload the slices
+  const int filter = m_TextureInterpolation ? vtkTextureObject::Linear : vtkTextureObject::Nearest;
+  for (auto *texture : {m_TargetTexture.GetPointer(), m_MovingTexture.GetPointer()})
+  {
+    texture->SetMinificationFilter(filter);
+    texture->SetMagnificationFilter(filter);
+  }
+
+  return true;
+}
+
+void vtkMitkRegEvaluationShaderMapper::RenderPieceStart(vtkRenderer *ren, vtkActor *act)
+{
+  m_TexturesActive = m_TargetSlice != nullptr && m_MovingSlice != nullptr && this->UploadTextures(ren);
+  if (m_TexturesActive)
+  {
+    m_TargetTexture->Activate();
+    m_MovingTexture->Activate();
+  }
+
+  this->Superclass::RenderPieceStart(ren, act);
+}
+
+void vtkMitkRegEvaluationShaderMapper::RenderPieceFinish(vtkRenderer *ren, vtkActor *act)
+{
+  this->Superclass::RenderPieceFinish(ren, act);
+
+  if (m_TexturesActive)
+  {
+    m_MovingTexture->Deactivate();
+    m_TargetTexture->Deactivate();
+    m_TexturesActive = false;
+  }
+}
+
+void vtkMitkRegEvaluationShaderMapper::SetMapperShaderParameters(vtkOpenGLHelper &cellBO,
+                                                                 vtkRenderer *ren,
+                                                                 vtkActor *act)
+{
+  this->Superclass::SetMapperShaderParameters(cellBO, ren, act);
+
+  vtkShaderProgram *program = cellBO.Program;
+  if (!m_TexturesActive)
+    return;
+
+  program->SetUniformi("regEvalTarget", m_TargetTexture->GetTextureUnit());
+  program->SetUniformi("regEvalMoving", m_MovingTexture->GetTextureUnit());
+  program->SetUniformi("regEvalStyle", m_Style);
+  program->SetUniformf("regEvalBlendFactor", m_BlendFactor);
+  program->SetUniformi("regEvalCheckerCount", m_CheckerCount);
+  program->SetUniformi("regEvalWipeStyle", m_WipeStyle);
+  program->SetUniformi("regEvalTargetContour", m_TargetContour ? 1 : 0);
+
+  const float wipePosition[2] = {static_cast<float>(m_WipePosition[0]), static_cast<float>(m_WipePosition[1])};
+  program->SetUniform2f("regEvalWipePosition", wipePosition);
+
+  // central differences as in vtkImageGradientMagnitude
+  const float gradientScale[2] = {static_cast<float>(0.5 / m_SliceSpacing[0]),
+                                  static_cast<float>(0.5 / m_SliceSpacing[1])};
+  program->SetUniform2f("regEvalGradientScale", gradientScale);
+}
@@ -0,0 +1,123 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef vtkMitkRegEvaluationShaderMapper_h
+#define vtkMitkRegEvaluationShaderMapper_h
+
+#include "MitkMatchPointRegistrationExports.h"
+
+#include <vtkImageData.h>
+#include <vtkOpenGLPolyDataMapper.h>
+#include <vtkSmartPointer.h>
+
+class vtkTextureObject;
+
+/** Documentation
+* \brief Renders a textured plane that composites the target slice and the mapped moving slice
+* of a registration evaluation on the GPU.
+*
+* This mapper is the GPU counterpart of the evaluation styles of mitk::RegEvaluationMapper2D
+* (blend, color blend, checkerboard, wipe, difference and contour). Both slices are expected
+* as RGBA output of vtkMitkLevelWindowFilter and are uploaded only when they were modified.
+* The style and its parameters (blend factor, checker count, wipe style and position, contour
+* source) are uniforms, so changing them or dragging the wipe does not execute any filter.
+*
+* The input polydata must carry texture coordinates spanning the slice (e.g. vtkPlaneSource).
+*
+* \ingroup Renderer
+*/
+class MITKMATCHPOINTREGISTRATION_EXPORT vtkMitkRegEvaluationShaderMapper : public vtkOpenGLPolyDataMapper
+{
+public:
+  static vtkMitkRegEvaluationShaderMapper *New();
+  vtkTypeMacro(vtkMitkRegEvaluationShaderMapper, vtkOpenGLPolyDataMapper);
+
+  /** \brief Evaluation styles, the values equal the ids of mitk::RegEvalStyleProperty. */
+  enum Style
+  {
+    Blend = 0,
+    ColorBlend = 1,
+    CheckerBoard = 2,
+    Wipe = 3,
+    Difference = 4,
+    Contour = 5
+  };
+
+  /** \brief Set the level windowed target and mapped moving slice (RGBA, unsigned char, same dimensions). */
+  void SetTargetSlice(vtkImageData *slice);
+  void SetMovingSlice(vtkImageData *slice);
+
+  void SetStyle(int style);
+
+  /** \brief Weight of the moving slice in the blend style (0..1). */
+  void SetBlendFactor(float factor);
+
+  /** \brief Number of checker fields per direction. */
+  void SetCheckerCount(int count);
+
+  /** \brief Wipe style as in mitk::RegEvalWipeStyleProperty (0: quad, 1: horizontal, 2: vertical)
+   * and wipe position in pixels of the slices. */
+  void SetWipe(int wipeStyle, double positionX, double positionY);
+
+  /** \brief If true the contour style draws the edges of the target slice over the moving slice, otherwise vice versa. */
+  void SetTargetContour(bool targetContour);
+
+  /** \brief Spacing of the slices, used for the gradient magnitude of the contour style. */
+  void SetSliceSpacing(double spacingX, double spacingY);
+
+  /** \brief Interpolate the colors of neighboring pixels, as done by vtkTexture::SetInterpolate(). */
+  void SetTextureInterpolation(bool interpolate);
+
+  void ReleaseGraphicsResources(vtkWindow *window) override;
+
+protected:
+  vtkMitkRegEvaluationShaderMapper();
+  ~vtkMitkRegEvaluationShaderMapper() override;
+
+  void ReplaceShaderValues(std::map<vtkShader::Type, vtkShader *> shaders, vtkRenderer *ren, vtkActor *act) override;
+  void SetMapperShaderParameters(vtkOpenGLHelper &cellBO, vtkRenderer *ren, vtkActor *act) override;
+  void RenderPieceStart(vtkRenderer *ren, vtkActor *act) override;
+  void RenderPieceFinish(vtkRenderer *ren, vtkActor *act) override;
+
+private:
+  vtkMitkRegEvaluationShaderMapper(const vtkMitkRegEvaluationShaderMapper &); // Not implemented.
+  void operator=(const vtkMitkRegEvaluationShaderMapper &);                   // Not implemented.
+
+  /** \brief Uploads the slices if they changed since the last upload, false on failure. */
+  bool UploadTextures(vtkRenderer *ren);
+
+  /** \brief Uploads a single slice to the texture, false if the slice is not an RGBA unsigned char slice. */
+  bool UploadSlice(vtkImageData *slice, vtkTextureObject *texture);
+
+  vtkSmartPointer<vtkImageData> m_TargetSlice;
+  vtkSmartPointer<vtkImageData> m_MovingSlice;
+  vtkSmartPointer<vtkTextureObject> m_TargetTexture;
+  vtkSmartPointer<vtkTextureObject> m_MovingTexture;
+  vtkTimeStamp m_TargetUploadTime;
+  vtkTimeStamp m_MovingUploadTime;
+  /** \brief Set if a slice object was exchanged or the textures were released */
+  bool m_TargetTextureOutdated;
+  bool m_MovingTextureOutdated;
+  /** \brief True from RenderPieceStart() to RenderPieceFinish() if both textures are bound */
+  bool m_TexturesActive;
+
+  int m_Style;
+  float m_BlendFactor;
+  int m_CheckerCount;
+  int m_WipeStyle;
+  double m_WipePosition[2];
+  bool m_TargetContour;
+  double m_SliceSpacing[2];
+  bool m_TextureInterpolation;
+};
+
+#endif
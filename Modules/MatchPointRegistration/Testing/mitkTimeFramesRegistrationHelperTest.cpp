@@ -24,6 +24,7 @@ class mitkTimeFramesRegistrationHelperTestSuite : public mitk::TestFixture
   MITK_TEST(SetErrorValue_GetErrorValue);
   MITK_TEST(SetAllowUnregPixels_GetAllowUnregPixels);
   MITK_TEST(SetInterpolatorType_GetInterpolatorType);
+  MITK_TEST(SetMaximumNumberOfConcurrentFrames_GetMaximumNumberOfConcurrentFrames);
   MITK_TEST(Set_Get_Clear_IgnoreList);
   CPPUNIT_TEST_SUITE_END();
 private:
@@ -87,6 +88,15 @@ public:
                                  mitk::ImageMappingInterpolator::NearestNeighbor, frameRegHelper->GetInterpolatorType());
   }
 
+  void SetMaximumNumberOfConcurrentFrames_GetMaximumNumberOfConcurrentFrames()
+  {
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Check getter on default value", 0u,
+                                 frameRegHelper->GetMaximumNumberOfConcurrentFrames());
+    frameRegHelper->SetMaximumNumberOfConcurrentFrames(3);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Check getter on changed value", 3u,
+                                 frameRegHelper->GetMaximumNumberOfConcurrentFrames());
+  }
+
   void Set_Get_Clear_IgnoreList()
   {
     CPPUNIT_ASSERT(frameRegHelper->GetIgnoreList().empty());
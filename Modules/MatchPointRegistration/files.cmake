@@ -15,6 +15,7 @@ set(CPP_FILES
   Rendering/mitkRegistrationWrapperMapper3D.cpp
   Rendering/mitkRegistrationWrapperMapperBase.cpp
   Rendering/mitkRegEvaluationMapper2D.cpp
+  Rendering/vtkMitkRegEvaluationShaderMapper.cpp
   Rendering/mitkRegVisStyleProperty.cpp
   Rendering/mitkRegVisDirectionProperty.cpp
   Rendering/mitkRegVisColorStyleProperty.cpp
@@ -54,6 +55,7 @@ set(H_FILES
   Rendering/mitkRegVisPropertyTags.h
   Rendering/mitkRegVisHelper.h
   Rendering/mitkRegEvaluationMapper2D.h
+  Rendering/vtkMitkRegEvaluationShaderMapper.h
   Rendering/mitkRegEvalStyleProperty.h
   Rendering/mitkRegEvalWipeStyleProperty.h
 )
@@ -12,9 +12,23 @@ found in the LICENSE file.
 
 #include "mitkMAPRegistrationWrapper.h"
 
+#include <mitkThreadPool.h>
+
 #include <mapExceptionObjectMacros.h>
 
+#include <limits>
+
+namespace
+{
+  // Number of cached inverse fields kept per registration; the least recently used field is dropped first.
+  const std::size_t MaximumNumberOfCachedInverseFields = 3;
+
+  // Number of voxels evaluated by one task of the thread pool when computing an inverse field.
+  const std::size_t VoxelsPerTask = 4096;
+}
+
 mitk::MAPRegistrationWrapper::MAPRegistrationWrapper()
+  : m_CacheInverseFields(false)
 {
 }
 
@@ -110,6 +124,151 @@ const map::core::RegistrationBase* mitk::MAPRegistrationWrapper::GetRegistration
 void mitk::MAPRegistrationWrapper::SetRegistration(map::core::RegistrationBase* pReg)
 {
   m_spRegistration = pReg;
+  this->ClearCachedInverseFields();
+}
+
+void mitk::MAPRegistrationWrapper::SetCacheInverseFields(bool cacheInverseFields)
+{
+  m_CacheInverseFields = cacheInverseFields;
+
+  if (!cacheInverseFields)
+  {
+    this->ClearCachedInverseFields();
+  }
+}
+
+bool mitk::MAPRegistrationWrapper::GetCacheInverseFields() const
+{
+  return m_CacheInverseFields;
+}
+
+void mitk::MAPRegistrationWrapper::ClearCachedInverseFields()
+{
+  std::lock_guard<std::mutex> lock(m_CachedInverseFieldsMutex);
+  m_CachedInverseFields.clear();
+}
+
+mitk::MAPRegistrationWrapper::InverseFieldType::ConstPointer
+mitk::MAPRegistrationWrapper::GetInverseField(const BaseGeometry* targetGeometry) const
+{
+  if (nullptr == targetGeometry)
+  {
+    mitkThrow() << "Error. Cannot compute inverse field. Passed target geometry is nullptr.";
+  }
+
+  if (!m_CacheInverseFields)
+  {
+    return this->ComputeInverseField(targetGeometry).GetPointer();
+  }
+
+  // Concurrent requests wait for the field instead of computing it twice.
+  std::lock_guard<std::mutex> lock(m_CachedInverseFieldsMutex);
+
+  for (auto iter = m_CachedInverseFields.begin(); iter != m_CachedInverseFields.end(); ++iter)
+  {
+    if (mitk::Equal(*(iter->Geometry), *targetGeometry, mitk::eps, false))
+    {
+      auto cachedField = *iter;
+      m_CachedInverseFields.erase(iter);
+      m_CachedInverseFields.push_back(cachedField);
+      return cachedField.Field;
+    }
+  }
+
+  CachedInverseField cachedField;
+  cachedField.Geometry = targetGeometry->Clone().GetPointer();
+  cachedField.Field = this->ComputeInverseField(targetGeometry).GetPointer();
+
+  if (m_CachedInverseFields.size() >= MaximumNumberOfCachedInverseFields)
+  {
+    m_CachedInverseFields.erase(m_CachedInverseFields.begin());
+  }
+
+  m_CachedInverseFields.push_back(cachedField);
+  return cachedField.Field;
+}
+
+mitk::MAPRegistrationWrapper::InverseFieldType::Pointer
+mitk::MAPRegistrationWrapper::ComputeInverseField(const BaseGeometry* targetGeometry) const
+{
+  if (this->GetMovingDimensions() != 3 || this->GetTargetDimensions() != 3)
+  {
+    mitkThrow() << "Error. Cannot compute inverse field. Only registrations with 3 moving and 3 target dimensions are supported.";
+  }
+
+  typedef map::core::Registration<3, 3> CastedRegType;
+  const CastedRegType* pCastedReg = dynamic_cast<const CastedRegType*>(m_spRegistration.GetPointer());
+
+  if (!pCastedReg)
+  {
+    mitkThrow() << "Error. Cannot compute inverse field. Registration has invalid dimension.";
+  }
+
+  InverseFieldType::SizeType size;
+  InverseFieldType::SpacingType spacing;
+  InverseFieldType::PointType origin;
+  InverseFieldType::DirectionType direction;
+
+  const auto matrix = targetGeometry->GetIndexToWorldTransform()->GetMatrix();
+  const auto offset = targetGeometry->GetIndexToWorldTransform()->GetOffset();
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    size[i] = static_cast<InverseFieldType::SizeValueType>(targetGeometry->GetExtent(i) + 0.5);
+    spacing[i] = targetGeometry->GetSpacing()[i];
+    origin[i] = targetGeometry->GetOrigin()[i];
+
+    for (unsigned int j = 0; j < 3; ++j)
+      direction[i][j] = matrix[i][j] / targetGeometry->GetSpacing()[j];
+  }
+
+  auto field = InverseFieldType::New();
+  field->SetRegions(size);
+  field->SetSpacing(spacing);
+  field->SetOrigin(origin);
+  field->SetDirection(direction);
+  field->Allocate();
+
+  auto* buffer = field->GetBufferPointer();
+  const std::size_t sizeX = size[0];
+  const std::size_t sizeXY = sizeX * size[1];
+
+  auto mapVoxels = [&](std::size_t begin, std::size_t end) {
+    CastedRegType::TargetPointType targetPoint;
+    CastedRegType::MovingPointType movingPoint;
+
+    for (auto voxel = begin; voxel < end; ++voxel)
+    {
+      const double index[3] = {
+        static_cast<double>(voxel % sizeX),
+        static_cast<double>((voxel % sizeXY) / sizeX),
+        static_cast<double>(voxel / sizeXY) };
+
+      for (unsigned int i = 0; i < 3; ++i)
+        targetPoint[i] = matrix[i][0] * index[0] + matrix[i][1] * index[1] + matrix[i][2] * index[2] + offset[i];
+
+      if (pCastedReg->mapPointInverse(targetPoint, movingPoint))
+      {
+        for (unsigned int i = 0; i < 3; ++i)
+          buffer[voxel][i] = static_cast<float>(movingPoint[i]);
+      }
+      else
+      {
+        buffer[voxel].Fill(std::numeric_limits<float>::quiet_NaN());
+      }
+    }
+  };
+
+  const std::size_t numberOfVoxels = field->GetLargestPossibleRegion().GetNumberOfPixels();
+
+  if (0 == numberOfVoxels)
+    return field;
+
+  // Mapping the first voxel serially lets lazy kernels generate their field before it is shared by the workers.
+  mapVoxels(0, 1);
+  ThreadPool::GetInstance().ParallelFor(1, numberOfVoxels, mapVoxels, VoxelsPerTask);
+
+  return field;
 }
 
 void mitk::MAPRegistrationWrapper::PrintSelf (std::ostream &os, itk::Indent indent) const
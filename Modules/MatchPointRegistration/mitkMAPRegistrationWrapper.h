@@ -18,6 +18,10 @@ found in the LICENSE file.
 #include <mitkBaseData.h>
 #include <mitkGeometry3D.h>
 
+//ITK
+#include <itkImage.h>
+#include <itkVector.h>
+
 //MatchPoint
 #include <mapRegistrationBase.h>
 #include <mapRegistration.h>
@@ -27,6 +31,9 @@ found in the LICENSE file.
 //MITK
 #include "MitkMatchPointRegistrationExports.h"
 
+#include <mutex>
+#include <vector>
+
 namespace mitk
 {
 /*!
@@ -247,6 +254,25 @@ public:
 
   void SetRegistration(::map::core::RegistrationBase* pReg);
 
+  /*! Dense field that stores for every voxel of a target geometry the point it is mapped to in the
+  moving space by the inverse kernel. Voxels that could not be mapped contain NaN.*/
+  typedef ::itk::Image<::itk::Vector<float, 3>, 3> InverseFieldType;
+
+  /*! If set, GetInverseField() keeps the computed fields, so that repeated mappings onto the same
+  target geometry (e.g. all time steps of a dynamic image or several images mapped with one
+  registration) only evaluate the registration kernel once. Default is false.*/
+  void SetCacheInverseFields(bool cacheInverseFields);
+  bool GetCacheInverseFields() const;
+
+  /*! Returns the dense inverse field of the registration for the passed target geometry.
+  The field is computed in parallel. If caching is activated, it is computed only once per geometry.
+  @pre valid registration instance with 3 moving and 3 target dimensions must be set.
+  @pre targetGeometry must not be null.*/
+  InverseFieldType::ConstPointer GetInverseField(const BaseGeometry* targetGeometry) const;
+
+  /*! Releases all cached inverse fields.*/
+  void ClearCachedInverseFields();
+
 protected:
     void PrintSelf (std::ostream &os, itk::Indent indent) const override;
 
@@ -256,6 +282,17 @@ protected:
     ::map::core::RegistrationBase::Pointer m_spRegistration;
 
 private:
+    struct CachedInverseField
+    {
+      BaseGeometry::ConstPointer Geometry;
+      InverseFieldType::ConstPointer Field;
+    };
+
+    InverseFieldType::Pointer ComputeInverseField(const BaseGeometry* targetGeometry) const;
+
+    bool m_CacheInverseFields;
+    mutable std::vector<CachedInverseField> m_CachedInverseFields;
+    mutable std::mutex m_CachedInverseFieldsMutex;
 
     MAPRegistrationWrapper& operator = (const MAPRegistrationWrapper&);
     MAPRegistrationWrapper(const MAPRegistrationWrapper&);
@@ -28,7 +28,6 @@ found in the LICENSE file.
 mitkCommandLineParser::StringContainerType inFilenames;
 std::string outFileName;
 
-std::vector<mitk::Image::Pointer> images;
 std::vector<mitk::TimePointType> timebounds;
 
 void setupParser(mitkCommandLineParser& parser)
@@ -124,25 +123,23 @@ int main(int argc, char* argv[])
     //! [do processing]
     try
     {
-      std::cout << "Load images:" << std::endl;
-
       auto filter = mitk::TemporalJoinImagesFilter::New();
 
-      unsigned int step = 0;
-      for (auto path : inFilenames)
+      // Only the first image is loaded up front. The filter loads the other ones while fusing and copies each
+      // directly into its time step, so the inputs never have to be held in memory all at once.
+      auto loadFrame = [&readerFilterFunctor](unsigned int step)
       {
-        std::cout << "Time step #"<<step<<" @ "<<timebounds[step]<< " ms: " << path << std::endl;
-        auto image = mitk::IOUtil::Load<mitk::Image>(path, &readerFilterFunctor);
-        images.push_back(image);
-        filter->SetInput(step, image);
-        ++step;
-      }
+        std::cout << "Time step #" << step << " @ " << timebounds[step] << " ms: " << inFilenames[step] << std::endl;
+        return mitk::IOUtil::Load<mitk::Image>(inFilenames[step], &readerFilterFunctor);
+      };
+
+      std::cout << "Fuse the images ..." << std::endl;
 
+      filter->SetInput(0, loadFrame(0));
+      filter->SetFrameLoader(loadFrame, static_cast<unsigned int>(inFilenames.size()));
       filter->SetFirstMinTimeBound(timebounds[0]);
       filter->SetMaxTimeBounds({ timebounds.begin() + 1, timebounds.end() });
 
-      std::cout << "Fuse the images ..." << std::endl;
-
       filter->Update();
       auto output = filter->GetOutput();
 
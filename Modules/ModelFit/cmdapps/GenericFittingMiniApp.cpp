@@ -38,6 +38,9 @@ std::string outFileName;
 std::string maskFileName;
 bool verbose(false);
 bool roibased(false);
+unsigned int shardCount(1);
+unsigned int shardIndex(0);
+bool mergeShards(false);
 std::string functionName;
 std::string formular;
 mitk::Image::Pointer image;
@@ -97,6 +100,15 @@ void setupParser(mitkCommandLineParser& parser)
         "roibased", "r", mitkCommandLineParser::Bool, "Roi based fitting", "Will compute a mean intesity signal over the ROI before fitting it. If this mode is used a mask must be specified.");
     parser.addArgument("help", "h", mitkCommandLineParser::Bool, "Help:", "Show this help text");
     parser.endGroup();
+
+    parser.beginGroup("Distributed fitting");
+    parser.addArgument(
+        "shards", "", mitkCommandLineParser::Int, "Number of shards", "Splits the pixel based fit into the given number of shards with (almost) the same number of voxels. Each shard can be fitted by a separate process (e.g. a job of a cluster job array) and stores its results with the suffix \"_shard<index>of<number>\". Afterwards call the app once more with the same settings and --merge to combine the results.", us::Any(1));
+    parser.addArgument(
+        "shard", "", mitkCommandLineParser::Int, "Shard index", "Index (starting with 0) of the shard that should be fitted, e.g. the index of the job in a job array.", us::Any(0));
+    parser.addArgument(
+        "merge", "", mitkCommandLineParser::Bool, "Merge shards", "Does not fit but merges the results of all shards (see --shards) into the output files.");
+    parser.endGroup();
     //! [add arguments]
 }
 
@@ -131,6 +143,34 @@ bool configureApplicationSettings(std::map<std::string, us::Any> parsedArgs)
         roibased = us::any_cast<bool>(parsedArgs["roibased"]);
     }
 
+    if (parsedArgs.count("shards"))
+    {
+        const int shards = us::any_cast<int>(parsedArgs["shards"]);
+        if (shards < 1)
+        {
+            std::cerr << "Error. Number of shards must be at least 1." << std::endl;
+            return false;
+        }
+        shardCount = static_cast<unsigned int>(shards);
+    }
+
+    if (parsedArgs.count("shard"))
+    {
+        const int shard = us::any_cast<int>(parsedArgs["shard"]);
+        if (shard < 0 || static_cast<unsigned int>(shard) >= shardCount)
+        {
+            std::cerr << "Error. Shard index must be in [0, number of shards)." << std::endl;
+            return false;
+        }
+        shardIndex = static_cast<unsigned int>(shard);
+    }
+
+    mergeShards = false;
+    if (parsedArgs.count("merge"))
+    {
+        mergeShards = us::any_cast<bool>(parsedArgs["merge"]);
+    }
+
     if (parsedArgs.count("mask"))
     {
         maskFileName = us::any_cast<std::string>(parsedArgs["mask"]);
@@ -269,14 +309,27 @@ void doFitting()
             }
         }
 
-        if (generator.IsNotNull() )
+        if (generator.IsNotNull() && mergeShards)
+        {
+            std::cout << "Merging results of " << shardCount << " shards..." << std::endl;
+            mitk::mergeModelFitGeneratorShardResults(outFileName, shardCount, generator, fitSession);
+        }
+        else if (generator.IsNotNull() )
         {
             std::cout << "Started fitting process..." << std::endl;
             generator->AddObserver(::itk::AnyEvent(), command);
             generator->Generate();
             std::cout << std::endl << "Finished fitting process" << std::endl;
 
-            mitk::storeModelFitGeneratorResults(outFileName, generator, fitSession);
+            if (shardCount > 1)
+            {
+                mitk::storeModelFitGeneratorResults(
+                    mitk::generateModelFitShardOutputPathTemplate(outFileName, shardCount, shardIndex), generator, fitSession);
+            }
+            else
+            {
+                mitk::storeModelFitGeneratorResults(outFileName, generator, fitSession);
+            }
         }
         else
         {
@@ -325,6 +378,19 @@ int main(int argc, char* argv[])
             mitkThrow() << "Error. Cannot fit. Please specify mask if you select roi based fitting.";
         }
 
+        if (shardCount > 1)
+        {
+            if (roibased)
+            {
+                mitkThrow() << "Error. Cannot fit. ROI based fitting cannot be split into shards.";
+            }
+
+            if (!mergeShards)
+            {
+                mask = mitk::generateModelFitShardMask(image, mask, shardCount, shardIndex);
+            }
+        }
+
         std::cout << "Style: ";
         if (roibased)
         {
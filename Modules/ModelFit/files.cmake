@@ -54,6 +54,7 @@ set(CPP_FILES
   Models/mitkGenericParamModelFactory.cpp
   Models/mitkGenericParamModelParameterizer.cpp
   Models/mitkValueBasedParameterizationDelegate.cpp
+  Models/mitkWarmStartParameterizationDelegate.cpp
   Models/mitkT2DecayModel.cpp
   Models/mitkT2DecayModelFactory.cpp
   Models/mitkT2DecayModelParameterizer.cpp  
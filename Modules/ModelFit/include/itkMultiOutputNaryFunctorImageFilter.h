@@ -96,6 +96,18 @@ public:
   itkSetObjectMacro(Mask, MaskImageType);
   itkGetConstObjectMacro(Mask, MaskImageType);
 
+  /** If a mask is set and this option is on (default), the filter does not split the output region
+   * statically over the threads. Instead it enumerates the masked pixels and the threads fetch chunks of them
+   * until all are processed. Thus threads whose part of the region is mostly outside of the mask do not idle
+   * while others are still busy, and the progress relates to the masked pixels only.*/
+  itkSetMacro(DynamicMaskedScheduling, bool);
+  itkGetConstMacro(DynamicMaskedScheduling, bool);
+  itkBooleanMacro(DynamicMaskedScheduling);
+
+  /** Number of masked pixels a thread fetches at once if DynamicMaskedScheduling is used. Default: 16.*/
+  itkSetClampMacro(ChunkSize, SizeValueType, 1, NumericTraits<SizeValueType>::max());
+  itkGetConstMacro(ChunkSize, SizeValueType);
+
   /** ImageDimension constants */
   itkStaticConstMacro(
     InputImageDimension, unsigned int, TInputImage::ImageDimension);
@@ -127,6 +139,13 @@ protected:
   void ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
                             ThreadIdType threadId) override;
 
+  /** Uses the dynamic scheduling of masked pixels (see SetDynamicMaskedScheduling()) if a mask is set.
+   * Otherwise the default multi threaded implementation with ThreadedGenerateData() is used.*/
+  void GenerateData() override;
+
+  /** Processes the masked pixels of the requested output region with dynamically scheduled threads.*/
+  void DynamicMaskedGenerateData();
+
   /** Methods actualize the output settings of the filter according to the current functor*/
   void ActualizeOutputs();
 
@@ -136,6 +155,8 @@ private:
 
   FunctorType m_Functor;
   MaskImagePointer m_Mask;
+  bool m_DynamicMaskedScheduling;
+  SizeValueType m_ChunkSize;
 };
 } // end namespace itk
 
@@ -14,9 +14,16 @@ found in the LICENSE file.
 #define __itkMultiOutputNaryFunctorImageFilter_hxx
 
 #include "itkMultiOutputNaryFunctorImageFilter.h"
-#include "itkImageRegionIterator.h"
+#include "itkImageScanlineIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkProgressReporter.h"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
 namespace itk
 {
   /**
@@ -24,7 +31,7 @@ namespace itk
   */
   template< class TInputImage, class TOutputImage, class TFunction, class TMaskImage >
   MultiOutputNaryFunctorImageFilter< TInputImage, TOutputImage, TFunction, TMaskImage >
-    ::MultiOutputNaryFunctorImageFilter()
+    ::MultiOutputNaryFunctorImageFilter() : m_DynamicMaskedScheduling(true), m_ChunkSize(16)
   {
     // This number will be incremented each time an image
     // is added over the two minimum required
@@ -51,6 +58,157 @@ namespace itk
     }
   };
 
+  template< class TInputImage, class TOutputImage, class TFunction, class TMaskImage >
+  void
+    MultiOutputNaryFunctorImageFilter< TInputImage, TOutputImage, TFunction, TMaskImage >
+    ::GenerateData()
+  {
+    if (m_Mask.IsNull() || !m_DynamicMaskedScheduling)
+    {
+      Superclass::GenerateData();
+      return;
+    }
+
+    this->AllocateOutputs();
+    this->BeforeThreadedGenerateData();
+    this->DynamicMaskedGenerateData();
+    this->AfterThreadedGenerateData();
+  }
+
+  template< class TInputImage, class TOutputImage, class TFunction, class TMaskImage >
+  void
+    MultiOutputNaryFunctorImageFilter< TInputImage, TOutputImage, TFunction, TMaskImage >
+    ::DynamicMaskedGenerateData()
+  {
+    const OutputImageRegionType region = this->GetOutput()->GetRequestedRegion();
+
+    if (!m_Mask->GetLargestPossibleRegion().IsInside(region))
+    {
+      itkExceptionMacro("Mask of filter is set but does not cover the requested region. Mask region: "<< m_Mask->GetLargestPossibleRegion() <<"Requested region: "<<region)
+    }
+
+    std::vector< const TInputImage * > inputs;
+    for ( unsigned int i = 0; i < this->GetNumberOfIndexedInputs(); ++i )
+    {
+      const TInputImage* inputPtr = dynamic_cast< const TInputImage * >( ProcessObject::GetInput(i) );
+      if ( inputPtr )
+      {
+        inputs.push_back( inputPtr );
+      }
+    }
+
+    std::vector< TOutputImage * > outputs;
+    for ( unsigned int i = 0; i < this->GetNumberOfIndexedOutputs(); ++i )
+    {
+      TOutputImage* outputPtr = dynamic_cast< TOutputImage * >( ProcessObject::GetOutput(i) );
+      if ( outputPtr )
+      {
+        // pixels outside of the mask stay 0
+        outputPtr->FillBuffer( NumericTraits< OutputImagePixelType >::ZeroValue() );
+        outputs.push_back( outputPtr );
+      }
+    }
+
+    if ( inputs.empty() || outputs.empty() )
+    {
+      return;
+    }
+
+    // compact list of the pixels that have to be processed
+    typedef typename OutputImageType::IndexType IndexType;
+    std::vector< IndexType > maskedIndices;
+    for (ImageRegionConstIteratorWithIndex< TMaskImage > maskIt(m_Mask, region); !maskIt.IsAtEnd(); ++maskIt)
+    {
+      if (maskIt.Get() > 0)
+      {
+        maskedIndices.push_back(maskIt.GetIndex());
+      }
+    }
+
+    const SizeValueType numberOfPixels = maskedIndices.size();
+    const SizeValueType chunkSize = m_ChunkSize;
+    std::atomic< SizeValueType > nextPixel(0);
+    std::atomic< SizeValueType > processedPixels(0);
+    std::atomic< bool > stop(false);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    auto process = [&](bool reportProgress) {
+      NaryInputArrayType naryInputArray(inputs.size());
+      NaryOutputArrayType naryOutputArray;
+
+      try
+      {
+        for (SizeValueType begin = nextPixel.fetch_add(chunkSize); begin < numberOfPixels && !stop;
+             begin = nextPixel.fetch_add(chunkSize))
+        {
+          const SizeValueType end = std::min(begin + chunkSize, numberOfPixels);
+          for (SizeValueType pos = begin; pos < end; ++pos)
+          {
+            const IndexType& index = maskedIndices[pos];
+
+            for ( unsigned int i = 0; i < inputs.size(); ++i )
+            {
+              naryInputArray[i] = inputs[i]->GetPixel(index);
+            }
+
+            naryOutputArray = m_Functor(naryInputArray, index);
+
+            if (outputs.size() != naryOutputArray.size())
+            {
+              itkExceptionMacro("Error. Number of valid output images do not equal number of outputs required by functor. Number of valid outputs: "<< outputs.size() << "; needed output number:" << this->m_Functor.GetNumberOfOutputs());
+            }
+
+            for ( unsigned int i = 0; i < outputs.size(); ++i )
+            {
+              outputs[i]->SetPixel(index, naryOutputArray[i]);
+            }
+          }
+
+          processedPixels += end - begin;
+
+          // progress events are only invoked by the calling thread
+          if (reportProgress)
+          {
+            this->UpdateProgress(static_cast< float >(processedPixels) / numberOfPixels);
+            if (this->GetAbortGenerateData())
+            {
+              stop = true;
+            }
+          }
+        }
+      }
+      catch (...)
+      {
+        std::lock_guard< std::mutex > lock(errorMutex);
+        if (!error)
+        {
+          error = std::current_exception();
+        }
+        stop = true;
+      }
+    };
+
+    const SizeValueType numberOfThreads = std::max< SizeValueType >(1,
+      std::min< SizeValueType >(this->GetNumberOfThreads(), (numberOfPixels + chunkSize - 1) / chunkSize));
+
+    std::vector< std::thread > threads;
+    for (SizeValueType i = 1; i < numberOfThreads; ++i)
+    {
+      threads.emplace_back(process, false);
+    }
+    process(true);
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+  }
+
   /**
   * ThreadedGenerateData Performs the pixel-wise addition
   */
@@ -69,162 +227,127 @@ namespace itk
     const unsigned int numberOfOutputImages =
       static_cast< unsigned int >( this->GetNumberOfIndexedOutputs() );
 
-    typedef ImageRegionConstIterator< TInputImage > ImageRegionConstIteratorType;
-    std::vector< ImageRegionConstIteratorType * > inputItrVector;
-    inputItrVector.reserve(numberOfInputImages);
+    // the iterators are held by value and walk the region line by line, so the
+    // index passed to the functor has only to be computed once per line
+    typedef ImageScanlineConstIterator< TInputImage > InputIteratorType;
+    std::vector< InputIteratorType > inputIterators;
+    inputIterators.reserve(numberOfInputImages);
 
-    typedef ImageRegionIterator< TOutputImage > OutputImageRegionIteratorType;
-    std::vector< OutputImageRegionIteratorType * > outputItrVector;
-    outputItrVector.reserve(numberOfOutputImages);
+    typedef ImageScanlineIterator< TOutputImage > OutputIteratorType;
+    std::vector< OutputIteratorType > outputIterators;
+    outputIterators.reserve(numberOfOutputImages);
 
     //check if mask image is set and generate iterator if mask is valid
-    typedef ImageRegionConstIterator< TMaskImage > MaskImageRegionIteratorType;
-    MaskImageRegionIteratorType* pMaskIterator = nullptr;
+    typedef ImageScanlineConstIterator< TMaskImage > MaskIteratorType;
+    MaskIteratorType maskIterator;
+    const bool useMask = m_Mask.IsNotNull();
 
-    if (m_Mask.IsNotNull())
+    if (useMask)
     {
       if (!m_Mask->GetLargestPossibleRegion().IsInside(outputRegionForThread))
       {
         itkExceptionMacro("Mask of filter is set but does not cover region of thread. Mask region: "<< m_Mask->GetLargestPossibleRegion() <<"Thread region: "<<outputRegionForThread)
       }
-      pMaskIterator = new MaskImageRegionIteratorType(m_Mask,outputRegionForThread);
+      maskIterator = MaskIteratorType(m_Mask, outputRegionForThread);
     }
 
     // go through the inputs and add iterators for non-null inputs
     for ( unsigned int i = 0; i < numberOfInputImages; ++i )
     {
-      InputImagePointer inputPtr =
-        dynamic_cast< TInputImage * >( ProcessObject::GetInput(i) );
+      const TInputImage* inputPtr =
+        dynamic_cast< const TInputImage * >( ProcessObject::GetInput(i) );
 
       if ( inputPtr )
       {
-        inputItrVector.push_back( new ImageRegionConstIteratorType(inputPtr, outputRegionForThread) );
+        inputIterators.push_back( InputIteratorType(inputPtr, outputRegionForThread) );
       }
-
     }
 
     // go through the outputs and add iterators for non-null outputs
     for ( unsigned int i = 0; i < numberOfOutputImages; ++i )
     {
-      OutputImagePointer outputPtr =
+      TOutputImage* outputPtr =
         dynamic_cast< TOutputImage * >( ProcessObject::GetOutput(i) );
 
       if ( outputPtr )
       {
-        outputItrVector.push_back( new OutputImageRegionIteratorType(outputPtr, outputRegionForThread) );
+        outputIterators.push_back( OutputIteratorType(outputPtr, outputRegionForThread) );
       }
     }
 
-    typename std::vector< ImageRegionConstIteratorType * >::iterator regionInputIterators;
-    const typename std::vector< ImageRegionConstIteratorType * >::const_iterator regionInputItEnd =
-      inputItrVector.end();
-
-    typename std::vector< OutputImageRegionIteratorType * >::iterator regionOutputIterators;
-    const typename std::vector< OutputImageRegionIteratorType * >::const_iterator regionOutputItEnd =
-      outputItrVector.end();
-
-    const unsigned int numberOfValidInputImages = inputItrVector.size();
-    const unsigned int numberOfValidOutputImages = outputItrVector.size();
+    const unsigned int numberOfValidInputImages = inputIterators.size();
+    const unsigned int numberOfValidOutputImages = outputIterators.size();
 
-    if ( (numberOfValidInputImages != 0) && ( numberOfValidOutputImages != 0))
+    if ( (numberOfValidInputImages == 0) || ( numberOfValidOutputImages == 0))
     {
-      try
-      {
-
-        while ( !(outputItrVector.front()->IsAtEnd()) )
-        {
-          typename NaryInputArrayType::iterator arrayInIt;
-          typename NaryOutputArrayType::iterator arrayOutIt;
-          NaryInputArrayType naryInputArray(numberOfValidInputImages);
-          NaryOutputArrayType naryOutputArray(numberOfValidOutputImages);
+      return;
+    }
 
-          bool isValid = true;
+    // reused for all pixels of the thread
+    NaryInputArrayType naryInputArray(numberOfValidInputImages);
+    NaryOutputArrayType naryOutputArray(numberOfValidOutputImages);
 
-          if (pMaskIterator)
-          {
-            isValid = pMaskIterator->Get() > 0;
-            ++(*pMaskIterator);
-          }
+    typename InputIteratorType::IndexType currentIndex;
 
-          arrayInIt = naryInputArray.begin();
-          regionInputIterators = inputItrVector.begin();
+    while ( !outputIterators.front().IsAtEnd() )
+    {
+      currentIndex = inputIterators.front().GetIndex();
 
-          typename ImageRegionConstIteratorType::IndexType currentIndex;
-          if(regionInputIterators != regionInputItEnd)
-          {
-            currentIndex = ( *regionInputIterators )->GetIndex();
-          }
+      while ( !outputIterators.front().IsAtEndOfLine() )
+      {
+        bool isValid = true;
 
-          while ( regionInputIterators != regionInputItEnd )
-          {
-            *arrayInIt++ = ( *regionInputIterators )->Get();
-            ++( *( *regionInputIterators ) );
-            ++regionInputIterators;
-          }
+        if (useMask)
+        {
+          isValid = maskIterator.Get() > 0;
+          ++maskIterator;
+        }
 
-          if (isValid)
-          {
-            naryOutputArray = m_Functor(naryInputArray, currentIndex);
+        for ( unsigned int i = 0; i < numberOfValidInputImages; ++i )
+        {
+          naryInputArray[i] = inputIterators[i].Get();
+          ++inputIterators[i];
+        }
 
-            if (numberOfValidOutputImages != naryOutputArray.size())
-            {
-              itkExceptionMacro("Error. Number of valid output images do not equal number of outputs required by functor. Number of valid outputs: "<< numberOfValidOutputImages << "; needed output number:" << this->m_Functor.GetNumberOfOutputs());
-            }
-          }
-          else
-          {
-            for (typename NaryOutputArrayType::iterator pos = naryOutputArray.begin(); pos!= naryOutputArray.end(); ++pos)
-            {
-                *pos = 0.0;
-            }
-          }
+        if (isValid)
+        {
+          naryOutputArray = m_Functor(naryInputArray, currentIndex);
 
-          arrayOutIt = naryOutputArray.begin();
-          regionOutputIterators = outputItrVector.begin();
-          while ( regionOutputIterators != regionOutputItEnd )
+          if (numberOfValidOutputImages != naryOutputArray.size())
           {
-            ( *regionOutputIterators )->Set(*arrayOutIt++);
-            ++( *( *regionOutputIterators ) );
-            ++regionOutputIterators;
+            itkExceptionMacro("Error. Number of valid output images do not equal number of outputs required by functor. Number of valid outputs: "<< numberOfValidOutputImages << "; needed output number:" << this->m_Functor.GetNumberOfOutputs());
           }
-
-          progress.CompletedPixel();
         }
-      }
-      catch(...)
-      {
-        // Free memory in case of exceptions
-        regionInputIterators = inputItrVector.begin();
-        while ( regionInputIterators != regionInputItEnd )
+        else
         {
-          delete ( *regionInputIterators++ );
+          std::fill(naryOutputArray.begin(), naryOutputArray.end(), 0.0);
         }
 
-        regionOutputIterators = outputItrVector.begin();
-        while ( regionOutputIterators != regionOutputItEnd )
+        for ( unsigned int i = 0; i < numberOfValidOutputImages; ++i )
         {
-          delete ( *regionOutputIterators++ );
+          outputIterators[i].Set(naryOutputArray[i]);
+          ++outputIterators[i];
         }
 
-        delete pMaskIterator;
-        throw;
+        ++currentIndex[0];
+        progress.CompletedPixel();
       }
-    }
 
-    // Free memory regulary
-    regionInputIterators = inputItrVector.begin();
-    while ( regionInputIterators != regionInputItEnd )
-    {
-      delete ( *regionInputIterators++ );
-    }
+      if (useMask)
+      {
+        maskIterator.NextLine();
+      }
 
-    regionOutputIterators = outputItrVector.begin();
-    while ( regionOutputIterators != regionOutputItEnd )
-    {
-      delete ( *regionOutputIterators++ );
-    }
+      for ( unsigned int i = 0; i < numberOfValidInputImages; ++i )
+      {
+        inputIterators[i].NextLine();
+      }
 
-    delete pMaskIterator;
+      for ( unsigned int i = 0; i < numberOfValidOutputImages; ++i )
+      {
+        outputIterators[i].NextLine();
+      }
+    }
   }
 } // end namespace itk
 
@@ -0,0 +1,66 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef __DYNAMIC_IMAGE_FRAME_CONVERTER_BASE_H
+#define __DYNAMIC_IMAGE_FRAME_CONVERTER_BASE_H
+
+#include <itkObject.h>
+#include <itkImage.h>
+
+#include <mitkImage.h>
+
+#include "MitkModelFitExports.h"
+
+namespace mitk
+{
+  /** Base class for converters that transform the signal values of a dynamic image frame by frame before they are
+   * fitted (e.g. MR signal to contrast agent concentration).
+   * A converter can be passed to PixelBasedParameterFitImageGenerator. The generator then converts the frames
+   * on the fly (and, if a slab thickness is set, only parts of them), so no converted copy of the dynamic image has to
+   * be created.
+   */
+  class MITKMODELFIT_EXPORT DynamicImageFrameConverterBase : public itk::Object
+  {
+  public:
+    typedef DynamicImageFrameConverterBase Self;
+    typedef itk::Object Superclass;
+    typedef itk::SmartPointer< Self >                            Pointer;
+    typedef itk::SmartPointer< const Self >                      ConstPointer;
+
+    itkTypeMacro(DynamicImageFrameConverterBase, itk::Object);
+
+    typedef itk::Image<ScalarType, 3> FrameImageType;
+
+    /** Is called once before the frames of dynamicImage are converted. Converters can use it to determine everything
+     * that depends on the whole image (e.g. a baseline).*/
+    virtual void PrepareConversion(const Image* dynamicImage) = 0;
+
+    /** Converts the signal values of a frame of the dynamic image passed to PrepareConversion().
+     * @param frame Signal values of the frame. The frame may only cover a part of the image (e.g. a slab); its region
+     * (index and size) refers to the voxel grid of the dynamic image.
+     * @param timeStep Time step of the frame.
+     * @return Converted frame; it must have the same region as frame.
+     * @pre PrepareConversion() was called.*/
+    virtual FrameImageType::Pointer ConvertFrame(const FrameImageType* frame, unsigned int timeStep) const = 0;
+
+  protected:
+    DynamicImageFrameConverterBase() = default;
+    ~DynamicImageFrameConverterBase() override = default;
+
+  private:
+    //No copy constructor allowed
+    DynamicImageFrameConverterBase(const Self& source);
+    void operator=(const Self&);  //purposely not implemented
+  };
+}
+
+#endif
@@ -74,6 +74,18 @@ namespace mitk
     typedef double DerivedParameterValueType;
     typedef std::map<ParameterNameType, DerivedParameterValueType> DerivedParameterMapType;
 
+    /** Parameters of a batch of signals in structure of arrays layout: one row per parameter and
+     * one column per signal, i.e. (p, s) is the value of parameter p for signal s.*/
+    typedef itk::Array2D<ParameterValueType> BatchParametersType;
+    /** Signals of a batch: one row per time point and one column per signal, i.e. (t, s) is the value
+     * of signal s at time point t. Thus the values of all signals at one time point are contiguous.*/
+    typedef itk::Array2D<ModelResultType::ValueType> BatchSignalsType;
+
+    /** Derivatives of a signal: one row per parameter and one column per time point, i.e. (p, t) is the derivative
+     * of the signal at time point t with respect to parameter p (layout of
+     * itk::MultipleValuedCostFunction::DerivativeType).*/
+    typedef itk::Array2D<ModelResultType::ValueType> JacobianType;
+
     /**Default implementation returns a scale of 1.0 for every defined parameter.*/
     ParamterScaleMapType GetParameterScales() const override;
 
@@ -168,10 +180,35 @@ namespace mitk
 
     ModelResultType GetSignal(const ParametersType& parameters) const;
 
+    /** Computes the signals of a batch of parameter sets (e.g. of several voxels) at once.
+     * Has the same checks as GetSignal() and uses ComputeModelfunctionBatch().
+     * @param parameters One column per signal (see BatchParametersType).
+     * @param [out] signals Resized to the size of the time grid x the number of signals (see BatchSignalsType).*/
+    void GetSignals(const BatchParametersType& parameters, BatchSignalsType& signals) const;
+
+    /** Indicates if the model computes the derivatives of its signal analytically (see GetJacobian()).
+     * The default implementation returns false; fit cost functions then use numeric derivatives.*/
+    virtual bool HasJacobian() const;
+
+    /** Computes the derivatives of the signal with respect to the parameters.
+     * Has the same checks as GetSignal() and uses ComputeJacobian().
+     * @pre HasJacobian() must return true.*/
+    JacobianType GetJacobian(const ParametersType& parameters) const;
+
   protected:
 
     virtual ModelResultType ComputeModelfunction(const ParametersType& parameters) const = 0;
 
+    /** Computes the signals of a batch. Called by GetSignals() after the parameters and the model were checked,
+     * signals already has the correct size.
+     * The default implementation calls ComputeModelfunction() for every column of parameters. Reimplement it
+     * for models whose computation can loop over the signals in the innermost loop (vectorized kernels).*/
+    virtual void ComputeModelfunctionBatch(const BatchParametersType& parameters, BatchSignalsType& signals) const;
+
+    /** Computes the derivatives of the signal, called by GetJacobian(). Models that return true in HasJacobian()
+     * must reimplement it. The default implementation throws an exception.*/
+    virtual JacobianType ComputeJacobian(const ParametersType& parameters) const;
+
     /** Member is called by GetSignal() before ComputeModelfunction(). It indicates if model is in a valid state and
      * ready to compute the signal. The default implementation checks nothing and always returns true.
      * Reimplement to realize special behavior for derived classes.
@@ -0,0 +1,77 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef __MODEL_FIT_BACKEND_BASE_H
+#define __MODEL_FIT_BACKEND_BASE_H
+
+#include <itkObject.h>
+#include <itkNumericTraits.h>
+
+#include "mitkModelBase.h"
+#include "mitkModelFitFunctorBase.h"
+
+#include "MitkModelFitExports.h"
+
+namespace mitk
+{
+  /** Base class for backends that fit the parameters of many signals at once (e.g. on a GPU).
+   * A backend can be passed to PixelBasedParameterFitImageGenerator. If the backend supports the model and the
+   * fit functor (see CanFit()), the generator passes the signals of all voxels in batches to Fit() and only computes
+   * the remaining outputs of the functor (derived parameters, criteria, evaluation parameters) on the CPU.
+   * All signals of one batch are fitted with the same (globally parameterized) model.
+   */
+  class MITKMODELFIT_EXPORT ModelFitBackendBase : public itk::Object
+  {
+  public:
+    typedef ModelFitBackendBase Self;
+    typedef itk::Object Superclass;
+    typedef itk::SmartPointer< Self >                            Pointer;
+    typedef itk::SmartPointer< const Self >                      ConstPointer;
+
+    itkTypeMacro(ModelFitBackendBase, itk::Object);
+
+    typedef ModelBase::BatchParametersType BatchParametersType;
+    typedef ModelBase::BatchSignalsType BatchSignalsType;
+
+    /** Indicates if the backend can fit the passed model with the settings of the passed fit functor.
+     * Backends must return false if they would yield other results than the functor itself (apart from numerical
+     * differences), e.g. because the functor uses constraints that are not supported by the backend.*/
+    virtual bool CanFit(const ModelBase* model, const ModelFitFunctorBase* fitFunctor) const = 0;
+
+    /** Fits the model to each column of signals.
+     * @param model Parameterized model that should be fitted.
+     * @param fitFunctor Fit functor whose settings (e.g. number of iterations) should be used.
+     * @param signals One row per time point of the model, one column per signal (see ModelBase::BatchSignalsType).
+     * @param [in,out] parameters One row per model parameter, one column per signal. Contains the initial
+     * parameters when called and the fitted parameters afterwards.
+     * @pre CanFit(model, fitFunctor) is true.*/
+    virtual void Fit(const ModelBase* model, const ModelFitFunctorBase* fitFunctor, const BatchSignalsType& signals,
+                     BatchParametersType& parameters) = 0;
+
+    /** Maximum number of signals the generator passes to one call of Fit().*/
+    itkSetClampMacro(BatchSize, unsigned int, 1, itk::NumericTraits<unsigned int>::max());
+    itkGetConstMacro(BatchSize, unsigned int);
+
+  protected:
+    ModelFitBackendBase() : m_BatchSize(65536) {};
+    ~ModelFitBackendBase() override = default;
+
+  private:
+    unsigned int m_BatchSize;
+
+    //No copy constructor allowed
+    ModelFitBackendBase(const Self& source);
+    void operator=(const Self&);  //purposely not implemented
+  };
+}
+
+#endif
@@ -52,5 +52,26 @@ namespace mitk
   /** Helper function that outputs on the std::cout the result images the generator would produces.*/
   MITKMODELFIT_EXPORT void previewModelFitGeneratorResults(const std::string& outputPathTemplate, mitk::ParameterFitImageGeneratorBase* generator);
 
+  /** Helper function that generates the mask of one shard of a distributed pixel based fit.
+  The voxels of the fit (all voxels of the mask, or all voxels of the first time step of the dynamic image if no
+  mask is passed) are ordered by their buffer index and split into shardCount contiguous ranges (slabs) with
+  (almost) the same number of voxels. The returned 3D mask selects the range with the given shardIndex.
+  Each shard can be fitted by a separate process (e.g. one job of a cluster job array); the results can be combined
+  with mergeModelFitGeneratorShardResults().
+  @pre shardIndex < shardCount
+  @pre If a mask is passed, it must have the same geometry as the dynamic image.*/
+  MITKMODELFIT_EXPORT mitk::Image::Pointer generateModelFitShardMask(const mitk::Image* dynamicImage, const mitk::Image* mask, unsigned int shardCount, unsigned int shardIndex);
+
+  /** Helper function that generates the output path template used by the given shard. The output file names of
+  a shard are: <basic file name>_shard<shardIndex>of<shardCount>_<parameterName>.<extension indicated by outputPathTemplate>*/
+  MITKMODELFIT_EXPORT std::string generateModelFitShardOutputPathTemplate(const std::string& outputPathTemplate, unsigned int shardCount, unsigned int shardIndex);
+
+  /** Helper function that loads the results of all shards (stored with the shard output path templates,
+  see generateModelFitShardOutputPathTemplate()), merges them and stores the merged images like
+  storeModelFitGeneratorResults() would do. The generator is only used to determine the names of the results and
+  does not need to be executed. As the shard masks are disjoint and the results are 0 outside of the masks,
+  the merged value of a voxel is the sum of the shard values.*/
+  MITKMODELFIT_EXPORT void mergeModelFitGeneratorShardResults(const std::string& outputPathTemplate, unsigned int shardCount, mitk::ParameterFitImageGeneratorBase* generator, const mitk::modelFit::ModelFitInfo* fitSession);
+
 }
 #endif
@@ -54,6 +54,17 @@ namespace mitk
     OutputPixelArrayType Compute(const InputPixelArrayType& value, const ModelBase* model,
                                  const ModelBase::ParametersType& initialParameters) const;
 
+    /** Returns the same values as Compute(), but for parameters that have already been fitted (e.g. by a
+     * ModelFitBackendBase). So no fit is done, only the derived parameters, criteria and evaluation parameters are
+     * determined.
+     * @remark Debug parameters are generated by the fit itself; therefore this method throws if debug parameter
+     * maps are activated.
+     * @pre model must point to a valid instance.
+     * @pre Size of fittedParameters must be equal to model->GetNumberOfParameters().
+     */
+    OutputPixelArrayType ComputeForFittedParameters(const InputPixelArrayType& value, const ModelBase* model,
+                                                    const ModelBase::ParametersType& fittedParameters) const;
+
     /** Returns the number of outputs the fit functor will return if compute is called.
      * The number depends in parts on the passed model.
      * @exception Exception will be thrown if no valid model is passed.*/
@@ -125,6 +136,12 @@ namespace mitk
 
   private:
 
+    /** Assembles the result of Compute() and ComputeForFittedParameters() for the fitted parameters.*/
+    OutputPixelArrayType ComposeOutputs(const SignalType& sample, const ModelBase* model,
+                                        const ParametersType& fittedParameters,
+                                        const DebugParameterMapType& debugParameters,
+                                        const ParameterNamesType& debugNames) const;
+
     typedef std::map<std::string, SVModelFitCostFunction::Pointer> CostFunctionMapType;
     CostFunctionMapType m_CostFunctionMap;
     bool m_DebugParameterMaps;
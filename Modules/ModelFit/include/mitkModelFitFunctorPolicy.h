@@ -13,6 +13,8 @@ found in the LICENSE file.
 #ifndef MODELFITFUNCTOR_POLICY_H
 #define MODELFITFUNCTOR_POLICY_H
 
+#include <cmath>
+
 #include "itkIndex.h"
 #include "mitkModelFitFunctorBase.h"
 #include "MitkModelFitExports.h"
@@ -34,6 +36,9 @@ namespace mitk
 
     typedef itk::Index<3> IndexType;
 
+    typedef ParameterizerType::ParametersType ParametersType;
+    typedef std::vector<ParametersType> ParametersVectorType;
+
     ModelFitFunctorPolicy()
     {};
 
@@ -72,6 +77,13 @@ namespace mitk
       m_ModelParameterizer = parameterizer;
     }
 
+    /** Additional start parameterizations (multi-start). If set, the model is also fitted starting from each of them
+     and the fit with the lowest (first) criterion is returned.*/
+    void SetAdditionalStartParameterizations(const ParametersVectorType& parameterizations)
+    {
+      m_AdditionalStarts = parameterizations;
+    }
+
     bool operator!=(const ModelFitFunctorPolicy& other) const
     {
       return !(*this == other);
@@ -80,7 +92,8 @@ namespace mitk
     bool operator==(const ModelFitFunctorPolicy& other) const
     {
       return (this->m_Functor == other.m_Functor) &&
-             (this->m_ModelParameterizer == other.m_ModelParameterizer);
+             (this->m_ModelParameterizer == other.m_ModelParameterizer) &&
+             (this->m_AdditionalStarts == other.m_AdditionalStarts);
     }
 
     inline OutputPixelArrayType operator()(const InputPixelArrayType& value,
@@ -102,6 +115,21 @@ namespace mitk
             currentIndex);
       OutputPixelArrayType result = m_Functor->Compute(value, parameterizedModel, initialParams);
 
+      if (!m_AdditionalStarts.empty() && !m_Functor->GetCriterionNames().empty())
+      {
+        const auto criterionPos = parameterizedModel->GetNumberOfParameters() +
+                                  parameterizedModel->GetNumberOfDerivedParameters();
+
+        for (const auto& start : m_AdditionalStarts)
+        {
+          OutputPixelArrayType candidate = m_Functor->Compute(value, parameterizedModel, start);
+          if (std::isnan(result[criterionPos]) || candidate[criterionPos] < result[criterionPos])
+          {
+            result.swap(candidate);
+          }
+        }
+      }
+
       return result;
     }
 
@@ -109,6 +137,7 @@ namespace mitk
 
     FunctorConstPointer m_Functor;
     ParameterizerConstPointer m_ModelParameterizer;
+    ParametersVectorType m_AdditionalStarts;
   };
 
 }
@@ -69,6 +69,7 @@ namespace mitk
 
     /** Possibility to set a custom strategy for defining the initial parameterization via a delegate.*/
     void SetInitialParameterizationDelegate(const InitialParameterizationDelegateBase* delegate);
+    const InitialParameterizationDelegateBase* GetInitialParameterizationDelegate() const;
 
     virtual ModelBasePointer GenerateParameterizedModel(const IndexType& currentPosition) const = 0;
     /** Generate model instance, only with global static parametrization.
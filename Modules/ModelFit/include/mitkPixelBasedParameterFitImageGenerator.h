@@ -19,6 +19,8 @@ found in the LICENSE file.
 
 #include "mitkModelParameterizerBase.h"
 #include "mitkModelFitFunctorBase.h"
+#include "mitkModelFitBackendBase.h"
+#include "mitkDynamicImageFrameConverterBase.h"
 #include "mitkParameterFitImageGeneratorBase.h"
 
 #include "MitkModelFitExports.h"
@@ -36,6 +38,14 @@ namespace mitk
    * - criterion images: Images that encode the criterion value of the fitting strategy for the fitted parameters
    * - evaluation parameter images: Images that encode measures of additional evaluation cost functions defined by the user. (These were not part of the fitting strategy)
    * .
+   * If a fit backend is set (see SetFitBackend()) and it supports the model and the fit functor, the parameters of
+   * all voxels are fitted in batches by the backend (e.g. on the GPU); otherwise the fit functor is used for each
+   * voxel.
+   * If a frame converter is set (see SetFrameConverter()), the signal values are converted on the fly before fitting.
+   * With a slab thickness (see SetSlabThickness()) the dynamic image is converted and fitted slab by slab; only the
+   * signals of one slab are held in memory in addition to the dynamic image and the results.
+   * In the warm start mode (see SetWarmStartGridSpacing()) the voxels of a coarse grid are fitted first (optionally
+   * with several start parameterizations) and all other voxels start from the results of their fitted neighbours.
    */
 class MITKMODELFIT_EXPORT PixelBasedParameterFitImageGenerator: public ParameterFitImageGeneratorBase
 {
@@ -51,10 +61,16 @@ public:
 
     typedef ModelParameterizerBase ParameterizerType;
 
+    typedef ModelFitBackendBase FitBackendType;
+
+    typedef DynamicImageFrameConverterBase FrameConverterType;
+
     typedef ParameterFitImageGeneratorBase::ModelBaseType ModelBaseType;
     typedef ParameterFitImageGeneratorBase::ParameterNameType ParameterNameType;
     typedef ParameterFitImageGeneratorBase::ParameterImageMapType ParameterImageMapType;
 
+    typedef std::vector<ModelBaseType::ParametersType> ParametersVectorType;
+
     itkSetObjectMacro(DynamicImage, Image);
     itkGetConstObjectMacro(DynamicImage, Image);
 
@@ -67,6 +83,35 @@ public:
     itkSetObjectMacro(ModelParameterizer, ParameterizerType);
     itkGetObjectMacro(ModelParameterizer, ParameterizerType);
 
+    /** Optional backend that fits the model parameters of all voxels in batches. It is only used if it supports the
+     model and the fit functor (see ModelFitBackendBase::CanFit()) and the parameterizer defines no local static
+     parameters.*/
+    itkSetObjectMacro(FitBackend, FitBackendType);
+    itkGetObjectMacro(FitBackend, FitBackendType);
+
+    /** Optional converter that is applied to every frame of the dynamic image before fitting (e.g. MR signal to
+     concentration conversion).*/
+    itkSetObjectMacro(FrameConverter, FrameConverterType);
+    itkGetObjectMacro(FrameConverter, FrameConverterType);
+
+    /** Number of slices (along the last spatial dimension) that are converted and fitted at once. 0 (default)
+     processes the whole image at once.*/
+    itkSetMacro(SlabThickness, unsigned int);
+    itkGetConstMacro(SlabThickness, unsigned int);
+
+    /** Spacing (in voxels) of the coarse grid used to warm start the fits. If > 1, every n-th voxel in each direction
+     is fitted first and all other voxels start from the parameters of the nearest fitted grid voxel (see
+     WarmStartParameterizationDelegate); the initial parameterization of the parameterizer is then only used for the
+     grid voxels. 1 fits every voxel with multi-start (see SetMultiStartParameterizations()) and 0 (default)
+     deactivates the warm start mode.*/
+    itkSetMacro(WarmStartGridSpacing, unsigned int);
+    itkGetConstMacro(WarmStartGridSpacing, unsigned int);
+
+    /** Start parameterizations that are tried in addition to the initial parameterization of the parameterizer for
+     the grid voxels of the warm start mode. The fit with the lowest criterion is used.*/
+    void SetMultiStartParameterizations(const ParametersVectorType& parameterizations);
+    ParametersVectorType GetMultiStartParameterizations() const;
+
     itkSetMacro(TimeGridByParameterizer, bool);
     itkGetMacro(TimeGridByParameterizer, bool);
     itkBooleanMacro(TimeGridByParameterizer);
@@ -82,7 +127,8 @@ public:
     ParameterNamesType GetEvaluationParameterNames() const override;
 
 protected:
-  PixelBasedParameterFitImageGenerator() : m_Progress(0), m_TimeGridByParameterizer(false)
+  PixelBasedParameterFitImageGenerator() : m_SlabThickness(0), m_WarmStartGridSpacing(0), m_Progress(0),
+    m_ProgressOffset(0), m_ProgressScale(1), m_TimeGridByParameterizer(false)
   {
     m_InternalMask = nullptr;
     m_Mask = nullptr;
@@ -97,6 +143,29 @@ protected:
     template <typename TPixel, unsigned int VDim>
     void DoPrepareMask(itk::Image<TPixel, VDim>* image);
 
+    /** Fits all (masked) voxels of the passed frames and stores all fit outputs in outputs.*/
+    template <typename TPixel, unsigned int VDim>
+    void DoFrameParameterFit(const std::vector<typename itk::Image<TPixel, VDim>::Pointer>& frames,
+                             std::vector<typename itk::Image<ScalarType, VDim>::ConstPointer>& outputs);
+
+    /** Fits the warm start grid voxels of the passed frames and returns a delegate that uses their results, or
+     * nullptr if no grid voxel has to be fitted.*/
+    template <typename TPixel, unsigned int VDim>
+    InitialParameterizationDelegateBase::Pointer DoWarmStartGridFit(
+      const std::vector<typename itk::Image<TPixel, VDim>::Pointer>& frames);
+
+    /** Extracts (and converts if m_FrameConverter is set) the frames of the passed dynamic image slab by slab,
+     * fits each slab and assembles the results in outputs.*/
+    template <typename TPixel, unsigned int VDim>
+    void DoStreamedParameterFit(const itk::Image<TPixel, VDim>* image,
+                                std::vector<typename itk::Image<ScalarType, VDim-1>::ConstPointer>& outputs);
+
+    /** Fits all (masked) voxels of the passed frames with m_FitBackend and stores all fit outputs in outputs.
+     * Returns false without doing anything if the backend cannot be used for the current configuration.*/
+    template <typename TPixel, unsigned int VDim>
+    bool DoBackendParameterFit(const std::vector<typename itk::Image<TPixel, VDim>::Pointer>& frames,
+                               std::vector<typename itk::Image<ScalarType, VDim>::ConstPointer>& outputs);
+
     void onFitProgressEvent(::itk::Object* caller, const ::itk::EventObject& eventObject);
 
     bool HasOutdatedResult() const override;
@@ -112,6 +181,15 @@ private:
 
     FitFunctorType::Pointer m_FitFunctor;
 
+    FitBackendType::Pointer m_FitBackend;
+
+    FrameConverterType::Pointer m_FrameConverter;
+
+    unsigned int m_SlabThickness;
+
+    unsigned int m_WarmStartGridSpacing;
+    ParametersVectorType m_MultiStartParameterizations;
+
     ParameterizerType::Pointer m_ModelParameterizer;
 
     ParameterImageMapType m_TempResultMap;
@@ -120,6 +198,9 @@ private:
     ParameterImageMapType m_TempCriterionResultMap;
 
     double m_Progress;
+    /** Progress range of the currently fitted slab (offset + scale*fit progress).*/
+    double m_ProgressOffset;
+    double m_ProgressScale;
     /**Indicates if the time grid defined in the parameterizer should be used (True)
     or if the filter should extract the time grid from the input image (False).*/
     bool m_TimeGridByParameterizer;
@@ -44,6 +44,11 @@ public:
 
     unsigned int GetNumberOfParameters (void) const override;
 
+    /** Indicates if GetDerivative() uses the Jacobian of the model (see ModelBase::HasJacobian()) instead of
+     * numeric derivatives. The default implementation returns false. Measures that reimplement
+     * CalcMeasureDerivative() return true if their model has a Jacobian.*/
+    virtual bool HasAnalyticDerivative() const;
+
     itkSetConstObjectMacro(Model, ModelBase);
     itkGetConstObjectMacro(Model, ModelBase);
 
@@ -54,6 +59,12 @@ protected:
 
     virtual MeasureType CalcMeasure(const ParametersType &parameters, const SignalType& signal) const = 0;
 
+    /** Computes the derivative of the measure from the signal and its derivatives (the Jacobian of the model).
+     * Called by GetDerivative() if HasAnalyticDerivative() returns true. The default implementation throws.*/
+    virtual void CalcMeasureDerivative(const ParametersType& parameters, const SignalType& signal,
+                                       const ModelBase::JacobianType& signalDerivative,
+                                       DerivativeType& derivative) const;
+
     SVModelFitCostFunction(): m_DerivativeStepLength(1e-5)
 	{
     }
@@ -36,10 +36,16 @@ public:
 
     typedef Superclass::SignalType SignalType;
 
+    bool HasAnalyticDerivative() const override;
+
 protected:
 
     MeasureType CalcMeasure(const ParametersType &parameters, const SignalType& signal) const override;
 
+    void CalcMeasureDerivative(const ParametersType& parameters, const SignalType& signal,
+                               const ModelBase::JacobianType& signalDerivative,
+                               DerivativeType& derivative) const override;
+
     SumOfSquaredDifferencesFitCostFunction()
     {
     }
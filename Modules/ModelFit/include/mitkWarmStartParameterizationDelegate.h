@@ -0,0 +1,93 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITKWARMSTARTPARAMETERIZATIONDELEGATE_H
+#define MITKWARMSTARTPARAMETERIZATIONDELEGATE_H
+
+#include <vector>
+
+#include <itkImage.h>
+#include <itkNumericTraits.h>
+
+#include "mitkInitialParameterizationDelegateBase.h"
+
+#include "MitkModelFitExports.h"
+
+namespace mitk
+{
+  /** Delegate that warm-starts a fit with the parameters already fitted at the nearest voxel of a coarse grid.
+   * The coarse grid consists of all voxels whose index components are multiples of the grid spacing. For a given
+   * position the delegate returns the fitted parameters of the nearest fitted grid voxel within the surrounding grid
+   * cell. If none of them was fitted (see SetFittedMask()), the fallback delegate (or, if not set, the fallback
+   * parameterization) is used.
+   * PixelBasedParameterFitImageGenerator uses this delegate for its warm start mode (see
+   * PixelBasedParameterFitImageGenerator::SetWarmStartGridSpacing()).
+   */
+  class MITKMODELFIT_EXPORT WarmStartParameterizationDelegate : public InitialParameterizationDelegateBase
+  {
+  public:
+    typedef WarmStartParameterizationDelegate Self;
+    typedef InitialParameterizationDelegateBase Superclass;
+    typedef itk::SmartPointer< Self >                            Pointer;
+    typedef itk::SmartPointer< const Self >                      ConstPointer;
+
+    itkFactorylessNewMacro(Self);
+    itkTypeMacro(WarmStartParameterizationDelegate, InitialParameterizationDelegateBase);
+
+    typedef Superclass::ModelBaseType ModelBaseType;
+    typedef Superclass::ParametersType ParametersType;
+    typedef Superclass::IndexType IndexType;
+
+    typedef itk::Image<ScalarType, 3> ParameterImageType;
+    typedef std::vector<ParameterImageType::ConstPointer> ParameterImageVectorType;
+    typedef itk::Image<unsigned char, 3> MaskImageType;
+
+    ParametersType GetInitialParameterization() const override;
+    ParametersType GetInitialParameterization(const IndexType& currentPosition) const override;
+
+    /** Images with the fitted values of the grid voxels; one image per model parameter.
+     * @pre All images must have the same region.*/
+    void SetFittedParameterImages(const ParameterImageVectorType& images);
+
+    /** Mask of the grid voxels that have been fitted (value > 0).*/
+    itkSetConstObjectMacro(FittedMask, MaskImageType);
+    itkGetConstObjectMacro(FittedMask, MaskImageType);
+
+    itkSetClampMacro(GridSpacing, unsigned int, 1, itk::NumericTraits<unsigned int>::max());
+    itkGetConstMacro(GridSpacing, unsigned int);
+
+    /** Delegate used for positions without a fitted grid voxel. If not set, the fallback parameterization is used.*/
+    itkSetConstObjectMacro(FallbackDelegate, InitialParameterizationDelegateBase);
+    itkGetConstObjectMacro(FallbackDelegate, InitialParameterizationDelegateBase);
+
+    void SetFallbackParameterization(const ParametersType& parameters);
+    ParametersType GetFallbackParameterization() const;
+
+  protected:
+    WarmStartParameterizationDelegate();
+    ~WarmStartParameterizationDelegate() override;
+
+  private:
+    ParameterImageVectorType m_FittedParameterImages;
+    MaskImageType::ConstPointer m_FittedMask;
+    unsigned int m_GridSpacing;
+
+    InitialParameterizationDelegateBase::ConstPointer m_FallbackDelegate;
+    ParametersType m_FallbackParameterization;
+
+    //No copy constructor allowed
+    WarmStartParameterizationDelegate(const Self& source);
+    void operator=(const Self&);  //purposely not implemented
+  };
+}
+
+#endif
@@ -15,6 +15,7 @@ found in the LICENSE file.
 #include "mitkImageTimeSelector.h"
 #include "mitkImageAccessByItk.h"
 #include "mitkImageCast.h"
+#include "mitkTracing.h"
 #include "itkMaskedNaryStatisticsImageFilter.h"
 
 mitk::MaskedDynamicImageStatisticsGenerator::MaskedDynamicImageStatisticsGenerator()
@@ -139,6 +140,7 @@ void mitk::MaskedDynamicImageStatisticsGenerator::DoCalculateStatistics(const it
 
 void mitk::MaskedDynamicImageStatisticsGenerator::Generate()
 {
+  MITK_TRACE_SCOPE("ModelFit", "MaskedDynamicImageStatisticsGenerator::Generate");
   if(this->m_Mask.IsNotNull())
   {
     InternalMaskType::Pointer castedMask;
@@ -12,6 +12,13 @@ found in the LICENSE file.
 
 #include <mitkModelFitCmdAppsHelper.h>
 
+#include <mitkImageCast.h>
+#include <mitkImageTimeSelector.h>
+#include <mitkITKImageImport.h>
+
+#include <itkImageRegionIterator.h>
+#include <itkImageRegionConstIterator.h>
+
 
 std::string sanitizeString(const std::string& path)
 {
@@ -118,3 +125,151 @@ MITKMODELFIT_EXPORT void mitk::previewModelFitGeneratorResults(const std::string
     std::cout << "Preview done." << std::endl;
   }
 }
+
+namespace
+{
+  typedef itk::Image<unsigned char, 3> ShardMaskImageType;
+  typedef itk::Image<mitk::ScalarType, 3> ShardResultImageType;
+
+  mitk::Image::Pointer selectFirstTimeStep(const mitk::Image* image)
+  {
+    mitk::ImageTimeSelector::Pointer selector = mitk::ImageTimeSelector::New();
+    selector->SetInput(image);
+    selector->SetTimeNr(0);
+    selector->UpdateLargestPossibleRegion();
+    return selector->GetOutput();
+  }
+
+  void mergeShardResults(const std::string& outputPathTemplate, unsigned int shardCount,
+    const mitk::ParameterFitImageGeneratorBase::ParameterNamesType& names, mitk::modelFit::Parameter::Type type,
+    const mitk::modelFit::ModelFitInfo* fitSession)
+  {
+    for (const auto& name : names)
+    {
+      ShardResultImageType::Pointer merged;
+
+      for (unsigned int shardIndex = 0; shardIndex < shardCount; ++shardIndex)
+      {
+        const std::string shardPath = mitk::generateModelFitResultImagePath(
+          mitk::generateModelFitShardOutputPathTemplate(outputPathTemplate, shardCount, shardIndex), name);
+        mitk::Image::Pointer shardImage = mitk::IOUtil::Load<mitk::Image>(shardPath);
+
+        ShardResultImageType::Pointer shardResult;
+        mitk::CastToItkImage(shardImage, shardResult);
+
+        if (merged.IsNull())
+        {
+          merged = ShardResultImageType::New();
+          merged->CopyInformation(shardResult);
+          merged->SetRegions(shardResult->GetLargestPossibleRegion());
+          merged->Allocate();
+          merged->FillBuffer(0.0);
+        }
+        else if (merged->GetLargestPossibleRegion() != shardResult->GetLargestPossibleRegion())
+        {
+          mitkThrow() << "Cannot merge shard results. Result of shard " << shardIndex << " has another size then "
+                      << "the result of shard 0. Shard file: " << shardPath;
+        }
+
+        itk::ImageRegionConstIterator<ShardResultImageType> shardIt(shardResult, shardResult->GetLargestPossibleRegion());
+        itk::ImageRegionIterator<ShardResultImageType> mergedIt(merged, merged->GetLargestPossibleRegion());
+        for (; !shardIt.IsAtEnd(); ++shardIt, ++mergedIt)
+        {
+          mergedIt.Value() += shardIt.Get();
+        }
+      }
+
+      if (merged.IsNotNull())
+      {
+        mitk::Image::Pointer mergedImage = mitk::GrabItkImageMemory(merged);
+        mitk::storeModelFitResultImage(outputPathTemplate, name, mergedImage, type, fitSession);
+      }
+    }
+  }
+}
+
+MITKMODELFIT_EXPORT mitk::Image::Pointer mitk::generateModelFitShardMask(const mitk::Image* dynamicImage, const mitk::Image* mask, unsigned int shardCount, unsigned int shardIndex)
+{
+  if (!dynamicImage)
+  {
+    mitkThrow() << "Cannot generate shard mask. No dynamic image passed.";
+  }
+  if (shardIndex >= shardCount)
+  {
+    mitkThrow() << "Cannot generate shard mask. Invalid shard index " << shardIndex << " for " << shardCount << " shards.";
+  }
+
+  // the shard mask is always a new image, the passed mask or dynamic image must not be altered
+  mitk::Image::ConstPointer reference3D = mask ? mask : dynamicImage;
+  if (reference3D->GetTimeSteps() > 1)
+  {
+    reference3D = selectFirstTimeStep(reference3D);
+  }
+
+  ShardMaskImageType::Pointer reference;
+  mitk::CastToItkImage(reference3D, reference);
+
+  ShardMaskImageType::Pointer shardMask = ShardMaskImageType::New();
+  shardMask->CopyInformation(reference);
+  shardMask->SetRegions(reference->GetLargestPossibleRegion());
+  shardMask->Allocate();
+  shardMask->FillBuffer(0);
+
+  // without a mask all voxels are fitted
+  const bool useAllVoxels = !mask;
+
+  itk::SizeValueType numberOfVoxels = 0;
+  for (itk::ImageRegionConstIterator<ShardMaskImageType> it(reference, reference->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    if (useAllVoxels || it.Get() > 0)
+    {
+      ++numberOfVoxels;
+    }
+  }
+
+  const itk::SizeValueType begin = numberOfVoxels * shardIndex / shardCount;
+  const itk::SizeValueType end = numberOfVoxels * (shardIndex + 1) / shardCount;
+
+  itk::SizeValueType voxel = 0;
+  itk::ImageRegionConstIterator<ShardMaskImageType> referenceIt(reference, reference->GetLargestPossibleRegion());
+  itk::ImageRegionIterator<ShardMaskImageType> shardIt(shardMask, shardMask->GetLargestPossibleRegion());
+  for (; !referenceIt.IsAtEnd() && voxel < end; ++referenceIt, ++shardIt)
+  {
+    if (useAllVoxels || referenceIt.Get() > 0)
+    {
+      if (voxel >= begin)
+      {
+        shardIt.Set(1);
+      }
+      ++voxel;
+    }
+  }
+
+  std::cout << "Shard " << shardIndex + 1 << "/" << shardCount << ": " << end - begin << " of " << numberOfVoxels << " voxels" << std::endl;
+
+  return mitk::GrabItkImageMemory(shardMask);
+}
+
+MITKMODELFIT_EXPORT std::string mitk::generateModelFitShardOutputPathTemplate(const std::string& outputPathTemplate, unsigned int shardCount, unsigned int shardIndex)
+{
+  std::string ext = ::itksys::SystemTools::GetFilenameLastExtension(outputPathTemplate);
+
+  std::string dir = itksys::SystemTools::GetFilenamePath(outputPathTemplate);
+
+  std::string rootName = itksys::SystemTools::GetFilenameWithoutLastExtension(outputPathTemplate);
+
+  std::string fileName = rootName + "_shard" + std::to_string(shardIndex) + "of" + std::to_string(shardCount) + ext;
+
+  return dir.empty() ? fileName : dir + "/" + fileName;
+}
+
+MITKMODELFIT_EXPORT void mitk::mergeModelFitGeneratorShardResults(const std::string& outputPathTemplate, unsigned int shardCount, mitk::ParameterFitImageGeneratorBase* generator, const mitk::modelFit::ModelFitInfo* fitSession)
+{
+  if (generator)
+  {
+    mergeShardResults(outputPathTemplate, shardCount, generator->GetParameterNames(), modelFit::Parameter::ParameterType, fitSession);
+    mergeShardResults(outputPathTemplate, shardCount, generator->GetDerivedParameterNames(), modelFit::Parameter::DerivedType, fitSession);
+    mergeShardResults(outputPathTemplate, shardCount, generator->GetCriterionNames(), modelFit::Parameter::CriterionType, fitSession);
+    mergeShardResults(outputPathTemplate, shardCount, generator->GetEvaluationParameterNames(), modelFit::Parameter::EvaluationType, fitSession);
+  }
+}
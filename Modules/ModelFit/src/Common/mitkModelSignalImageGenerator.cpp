@@ -18,6 +18,7 @@ found in the LICENSE file.
 #include "mitkITKImageImport.h"
 #include "mitkModelDataGenerationFunctor.h"
 #include "mitkSimpleFunctorPolicy.h"
+#include "mitkTracing.h"
 
 
 void mitk::ModelSignalImageGenerator::SetParameterInputImage(const ParametersIndexType parameterIndex, ParameterImageType parameterImage)
@@ -71,6 +72,7 @@ void mitk::ModelSignalImageGenerator::SortParameterImages()
 
 void mitk::ModelSignalImageGenerator::Generate()
 {
+    MITK_TRACE_SCOPE("ModelFit", "ModelSignalImageGenerator::Generate");
      SortParameterImages();
 
     if(this->m_Mask.IsNotNull())
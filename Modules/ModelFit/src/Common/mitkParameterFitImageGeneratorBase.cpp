@@ -12,6 +12,8 @@ found in the LICENSE file.
 
 #include "mitkParameterFitImageGeneratorBase.h"
 
+#include <mitkTracing.h>
+
 bool
   mitk::ParameterFitImageGeneratorBase::HasOutdatedResult() const
 {
@@ -41,6 +43,8 @@ void
   ParameterImageMapType criterionImages;
   ParameterImageMapType evaluationImages;
 
+  // the events are named by the class of the generator
+  MITK_TRACE_SCOPE("ModelFit", this->GetNameOfClass());
   DoFitAndGetResults(paramImages, derivedImages, criterionImages, evaluationImages);
 
   m_ParameterImageMap = paramImages;
@@ -10,7 +10,13 @@ found in the LICENSE file.
 
 ============================================================================*/
 
+#include <algorithm>
+
 #include "itkCommand.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkExtractImageFilter.h"
 #include "itkMultiOutputNaryFunctorImageFilter.h"
 
 #include "mitkPixelBasedParameterFitImageGenerator.h"
@@ -18,6 +24,7 @@ found in the LICENSE file.
 #include "mitkImageAccessByItk.h"
 #include "mitkImageCast.h"
 #include "mitkModelFitFunctorPolicy.h"
+#include "mitkWarmStartParameterizationDelegate.h"
 
 #include "mitkExtractTimeGrid.h"
 
@@ -25,13 +32,13 @@ void
   mitk::PixelBasedParameterFitImageGenerator::
   onFitProgressEvent(::itk::Object* caller, const ::itk::EventObject& /*eventObject*/)
 {
-  this->InvokeEvent(::itk::ProgressEvent());
-
   auto* process = dynamic_cast<itk::ProcessObject*>(caller);
   if (process)
   {
-    this->m_Progress = process->GetProgress();
+    this->m_Progress = this->m_ProgressOffset + this->m_ProgressScale * process->GetProgress();
   }
+
+  this->InvokeEvent(::itk::ProgressEvent());
 };
 
 template <typename TPixel, unsigned int VDim>
@@ -55,18 +62,18 @@ void
 }
 
 template<typename TImage>
-mitk::PixelBasedParameterFitImageGenerator::ParameterImageMapType StoreResultImages( mitk::ModelFitFunctorBase::ParameterNamesType &paramNames, itk::ImageSource<TImage>* source, mitk::ModelFitFunctorBase::ParameterNamesType::size_type startPos, mitk::ModelFitFunctorBase::ParameterNamesType::size_type& endPos )
+mitk::PixelBasedParameterFitImageGenerator::ParameterImageMapType StoreResultImages( mitk::ModelFitFunctorBase::ParameterNamesType &paramNames, const std::vector<typename TImage::ConstPointer>& outputs, mitk::ModelFitFunctorBase::ParameterNamesType::size_type startPos, mitk::ModelFitFunctorBase::ParameterNamesType::size_type& endPos )
 {
   mitk::PixelBasedParameterFitImageGenerator::ParameterImageMapType result;
   for (mitk::ModelFitFunctorBase::ParameterNamesType::size_type j = 0; j < paramNames.size(); ++j)
   {
-    if (source->GetNumberOfOutputs() < startPos+j)
+    if (outputs.size() <= startPos+j)
     {
-      mitkThrow() << "Error while generating fitted parameter images. Number of sources is too low and does not match expected parameter number. Output size: "<< source->GetNumberOfOutputs()<<"; number of param names: "<<paramNames.size()<<";source start pos: " << startPos;
+      mitkThrow() << "Error while generating fitted parameter images. Number of sources is too low and does not match expected parameter number. Output size: "<< outputs.size()<<"; number of param names: "<<paramNames.size()<<";source start pos: " << startPos;
     }
 
     mitk::Image::Pointer paramImage = mitk::Image::New();
-    typename TImage::ConstPointer outputImg = source->GetOutput(startPos+j);
+    typename TImage::ConstPointer outputImg = outputs[startPos+j];
     mitk::CastToMitkImage(outputImg, paramImage);
 
     result.insert(std::make_pair(paramNames[j],paramImage));
@@ -77,12 +84,233 @@ mitk::PixelBasedParameterFitImageGenerator::ParameterImageMapType StoreResultIma
   return result;
 }
 
+template <typename TPixel, unsigned int VDim>
+bool
+  mitk::PixelBasedParameterFitImageGenerator::DoBackendParameterFit(const std::vector<typename itk::Image<TPixel, VDim>::Pointer>& frames,
+  std::vector<typename itk::Image<ScalarType, VDim>::ConstPointer>& outputs)
+{
+  using FrameImageType = itk::Image<TPixel, VDim>;
+  using ParameterImageType = itk::Image<ScalarType, VDim>;
+
+  if (this->m_FitBackend.IsNull() || frames.empty())
+  {
+    return false;
+  }
+
+  //all voxels are fitted with the globally parameterized model
+  ModelBaseType::Pointer model = this->m_ModelParameterizer->GenerateParameterizedModel();
+  if (!this->m_FitBackend->CanFit(model, this->m_FitFunctor))
+  {
+    MITK_INFO << "Parameter Fit Generator. Fit backend does not support the model or fit functor. Use fit functor instead.";
+    return false;
+  }
+
+  const typename FrameImageType::RegionType region = frames.front()->GetLargestPossibleRegion();
+  if (this->m_InternalMask.IsNotNull() && !this->m_InternalMask->GetLargestPossibleRegion().IsInside(region))
+  {
+    mitkThrow() << "Cannot do fitting. Mask does not cover the region of the dynamic image. Mask region: " << this->m_InternalMask->GetLargestPossibleRegion() << "; image region: " << region;
+  }
+
+  std::vector<typename FrameImageType::IndexType> indices;
+  for (itk::ImageRegionConstIteratorWithIndex<FrameImageType> pos(frames.front(), region); !pos.IsAtEnd(); ++pos)
+  {
+    const typename FrameImageType::IndexType index = pos.GetIndex();
+    if (this->m_InternalMask.IsNotNull() && this->m_InternalMask->GetPixel(index) == 0)
+    {
+      continue;
+    }
+
+    if (!this->m_ModelParameterizer->GetLocalStaticParameters(index).empty())
+    {
+      MITK_INFO << "Parameter Fit Generator. Model parameterizer defines local static parameters, which are not supported by fit backends. Use fit functor instead.";
+      return false;
+    }
+
+    indices.push_back(index);
+  }
+
+  const unsigned int numberOfOutputs = this->m_FitFunctor->GetNumberOfOutputs(model);
+  std::vector<typename ParameterImageType::Pointer> outputImages;
+  for (unsigned int i = 0; i < numberOfOutputs; ++i)
+  {
+    typename ParameterImageType::Pointer outputImage = ParameterImageType::New();
+    outputImage->CopyInformation(frames.front());
+    outputImage->SetRegions(region);
+    outputImage->Allocate();
+    outputImage->FillBuffer(0.0);
+    outputImages.push_back(outputImage);
+  }
+
+  const unsigned int numberOfTimePoints = frames.size();
+  const unsigned int numberOfParameters = model->GetNumberOfParameters();
+  const std::size_t batchSize = this->m_FitBackend->GetBatchSize();
+
+  FitBackendType::BatchSignalsType signals;
+  FitBackendType::BatchParametersType parameters;
+  FitFunctorType::InputPixelArrayType value(numberOfTimePoints);
+  ModelBaseType::ParametersType fittedParameters(numberOfParameters);
+
+  for (std::size_t batchStart = 0; batchStart < indices.size(); batchStart += batchSize)
+  {
+    const unsigned int batchCount = std::min(batchSize, indices.size() - batchStart);
+    signals.SetSize(numberOfTimePoints, batchCount);
+    parameters.SetSize(numberOfParameters, batchCount);
+
+    for (unsigned int i = 0; i < batchCount; ++i)
+    {
+      const typename FrameImageType::IndexType& index = indices[batchStart + i];
+      for (unsigned int t = 0; t < numberOfTimePoints; ++t)
+      {
+        signals(t, i) = frames[t]->GetPixel(index);
+      }
+
+      const ModelBaseType::ParametersType initialParameters = this->m_ModelParameterizer->GetInitialParameterization(index);
+      if (initialParameters.Size() != numberOfParameters)
+      {
+        mitkThrow() << "Cannot do fitting. Size of initial parameterization does not match the number of model parameters. Initial parameters: " << initialParameters << "; model parameter count: " << numberOfParameters;
+      }
+      for (unsigned int p = 0; p < numberOfParameters; ++p)
+      {
+        parameters(p, i) = initialParameters[p];
+      }
+    }
+
+    this->m_FitBackend->Fit(model, this->m_FitFunctor, signals, parameters);
+
+    //the remaining outputs (derived parameters, criteria, evaluation parameters) are cheap; compute them as usual
+    for (unsigned int i = 0; i < batchCount; ++i)
+    {
+      for (unsigned int t = 0; t < numberOfTimePoints; ++t)
+      {
+        value[t] = signals(t, i);
+      }
+      for (unsigned int p = 0; p < numberOfParameters; ++p)
+      {
+        fittedParameters[p] = parameters(p, i);
+      }
+
+      const FitFunctorType::OutputPixelArrayType result = this->m_FitFunctor->ComputeForFittedParameters(value, model, fittedParameters);
+      const typename FrameImageType::IndexType& index = indices[batchStart + i];
+      for (unsigned int o = 0; o < numberOfOutputs; ++o)
+      {
+        outputImages[o]->SetPixel(index, result[o]);
+      }
+    }
+
+    this->m_Progress = this->m_ProgressOffset + this->m_ProgressScale * (batchStart + batchCount) / indices.size();
+    this->InvokeEvent(::itk::ProgressEvent());
+  }
+
+  outputs.clear();
+  for (const auto& outputImage : outputImages)
+  {
+    outputs.push_back(outputImage.GetPointer());
+  }
+  this->m_Progress = this->m_ProgressOffset + this->m_ProgressScale;
+
+  return true;
+}
+
+namespace
+{
+  /** Restores the initial parameterization delegate of a parameterizer when going out of scope.*/
+  class InitialDelegateRestorer
+  {
+  public:
+    explicit InitialDelegateRestorer(mitk::ModelParameterizerBase* parameterizer) : m_Parameterizer(parameterizer),
+      m_Delegate(parameterizer->GetInitialParameterizationDelegate())
+    {
+    }
+
+    ~InitialDelegateRestorer()
+    {
+      m_Parameterizer->SetInitialParameterizationDelegate(m_Delegate);
+    }
+
+  private:
+    mitk::ModelParameterizerBase* m_Parameterizer;
+    mitk::InitialParameterizationDelegateBase::ConstPointer m_Delegate;
+  };
+}
+
+template <typename TPixel, unsigned int VDim>
+mitk::InitialParameterizationDelegateBase::Pointer
+  mitk::PixelBasedParameterFitImageGenerator::DoWarmStartGridFit(const std::vector<typename itk::Image<TPixel, VDim>::Pointer>& frames)
+{
+  using InputFrameImageType = itk::Image<TPixel, VDim>;
+  using ParameterImageType = itk::Image<ScalarType, VDim>;
+
+  using FitFilterType = itk::MultiOutputNaryFunctorImageFilter<InputFrameImageType, ParameterImageType, ModelFitFunctorPolicy, InternalMaskType>;
+
+  const auto spacing = static_cast<typename InputFrameImageType::IndexValueType>(this->m_WarmStartGridSpacing);
+  const typename InputFrameImageType::RegionType region = frames.front()->GetLargestPossibleRegion();
+
+  InternalMaskType::Pointer gridMask = InternalMaskType::New();
+  gridMask->CopyInformation(frames.front());
+  gridMask->SetRegions(region);
+  gridMask->Allocate();
+
+  bool hasGridVoxels = false;
+  for (itk::ImageRegionIteratorWithIndex<InternalMaskType> pos(gridMask, region); !pos.IsAtEnd(); ++pos)
+  {
+    const typename InputFrameImageType::IndexType index = pos.GetIndex();
+    bool isGridVoxel = true;
+    for (unsigned int d = 0; d < VDim; ++d)
+    {
+      isGridVoxel = isGridVoxel && index[d] % spacing == 0;
+    }
+    if (isGridVoxel && this->m_InternalMask.IsNotNull())
+    {
+      isGridVoxel = this->m_InternalMask->GetLargestPossibleRegion().IsInside(index) && this->m_InternalMask->GetPixel(index) > 0;
+    }
+
+    pos.Set(isGridVoxel ? 1 : 0);
+    hasGridVoxels = hasGridVoxels || isGridVoxel;
+  }
+
+  if (!hasGridVoxels)
+  {
+    return nullptr;
+  }
+
+  typename FitFilterType::Pointer gridFilter = FitFilterType::New();
+  for (unsigned int i = 0; i < frames.size(); ++i)
+  {
+    gridFilter->SetInput(i, frames[i]);
+  }
+
+  ModelFitFunctorPolicy functor;
+  functor.SetModelFitFunctor(this->m_FitFunctor);
+  functor.SetModelParameterizer(this->m_ModelParameterizer);
+  functor.SetAdditionalStartParameterizations(this->m_MultiStartParameterizations);
+  gridFilter->SetFunctor(functor);
+  gridFilter->SetMask(gridMask);
+  gridFilter->Update();
+
+  const ModelBaseType::Pointer refModel = this->m_ModelParameterizer->GenerateParameterizedModel();
+  WarmStartParameterizationDelegate::ParameterImageVectorType gridParameterImages;
+  for (unsigned int i = 0; i < refModel->GetNumberOfParameters(); ++i)
+  {
+    gridParameterImages.push_back(gridFilter->GetOutput(i));
+  }
+
+  WarmStartParameterizationDelegate::Pointer warmStartDelegate = WarmStartParameterizationDelegate::New();
+  warmStartDelegate->SetFittedParameterImages(gridParameterImages);
+  warmStartDelegate->SetFittedMask(gridMask);
+  warmStartDelegate->SetGridSpacing(this->m_WarmStartGridSpacing);
+  warmStartDelegate->SetFallbackDelegate(this->m_ModelParameterizer->GetInitialParameterizationDelegate());
+  warmStartDelegate->SetFallbackParameterization(this->m_ModelParameterizer->GetDefaultInitialParameterization());
+
+  return warmStartDelegate.GetPointer();
+}
+
 template <typename TPixel, unsigned int VDim>
 void
-  mitk::PixelBasedParameterFitImageGenerator::DoParameterFit(itk::Image<TPixel, VDim>* /*image*/)
+  mitk::PixelBasedParameterFitImageGenerator::DoFrameParameterFit(const std::vector<typename itk::Image<TPixel, VDim>::Pointer>& frames,
+  std::vector<typename itk::Image<ScalarType, VDim>::ConstPointer>& outputs)
 {
-  using InputFrameImageType = itk::Image<TPixel, VDim-1>;
-  using ParameterImageType = itk::Image<ScalarType, VDim-1>;
+  using InputFrameImageType = itk::Image<TPixel, VDim>;
+  using ParameterImageType = itk::Image<ScalarType, VDim>;
 
   using FitFilterType = itk::MultiOutputNaryFunctorImageFilter<InputFrameImageType, ParameterImageType, ModelFitFunctorPolicy, InternalMaskType>;
 
@@ -93,21 +321,219 @@ void
   fitFilter->AddObserver(::itk::ProgressEvent(), spProgressCommand);
 
   //add the time frames to the fit filter
-  mitk::ImageTimeSelector::Pointer imageTimeSelector = mitk::ImageTimeSelector::New();
-  imageTimeSelector->SetInput(this->m_DynamicImage);
-  std::vector<Image::Pointer> frameCache;
-  for (unsigned int i = 0; i < this->m_DynamicImage->GetTimeSteps(); ++i)
+  for (unsigned int i = 0; i < frames.size(); ++i)
+  {
+    fitFilter->SetInput(i, frames[i]);
+  }
+
+  //in the warm start mode the grid voxels are fitted first and provide the start parameters of all other voxels
+  InitialDelegateRestorer delegateRestorer(this->m_ModelParameterizer);
+
+  ModelFitFunctorPolicy functor;
+
+  functor.SetModelFitFunctor(this->m_FitFunctor);
+  functor.SetModelParameterizer(this->m_ModelParameterizer);
+  if (this->m_WarmStartGridSpacing == 1)
   {
-    typename InputFrameImageType::Pointer frameImage;
-    imageTimeSelector->SetTimeNr(i);
-    imageTimeSelector->UpdateLargestPossibleRegion();
+    functor.SetAdditionalStartParameterizations(this->m_MultiStartParameterizations);
+  }
+  else if (this->m_WarmStartGridSpacing > 1)
+  {
+    InitialParameterizationDelegateBase::Pointer warmStartDelegate = this->DoWarmStartGridFit<TPixel, VDim>(frames);
+    if (warmStartDelegate.IsNotNull())
+    {
+      this->m_ModelParameterizer->SetInitialParameterizationDelegate(warmStartDelegate);
+    }
+  }
+
+  fitFilter->SetFunctor(functor);
+  if (this->m_InternalMask.IsNotNull())
+  {
+    fitFilter->SetMask(this->m_InternalMask);
+  }
+
+  //generate the fits
+  outputs.clear();
+  //the fit backends do not support multi-start
+  const bool isMultiStartFit = this->m_WarmStartGridSpacing == 1 && !this->m_MultiStartParameterizations.empty();
+  if (isMultiStartFit || !this->DoBackendParameterFit<TPixel, VDim>(frames, outputs))
+  {
+    fitFilter->Update();
+
+    for (unsigned int i = 0; i < fitFilter->GetNumberOfOutputs(); ++i)
+    {
+      outputs.push_back(fitFilter->GetOutput(i));
+    }
+  }
+}
+
+namespace
+{
+  /** Extracts the passed (spatial) region of the given time step of a dynamic itk image.*/
+  template <typename TOutputPixel, typename TPixel, unsigned int VDim>
+  typename itk::Image<TOutputPixel, VDim-1>::Pointer ExtractFrameRegion(const itk::Image<TPixel, VDim>* image,
+    unsigned int timeStep, const typename itk::Image<TOutputPixel, VDim-1>::RegionType& frameRegion)
+  {
+    using ExtractFilterType = itk::ExtractImageFilter<itk::Image<TPixel, VDim>, itk::Image<TOutputPixel, VDim-1> >;
+
+    typename itk::Image<TPixel, VDim>::RegionType extractionRegion = image->GetLargestPossibleRegion();
+    for (unsigned int d = 0; d < VDim - 1; ++d)
+    {
+      extractionRegion.SetIndex(d, frameRegion.GetIndex(d));
+      extractionRegion.SetSize(d, frameRegion.GetSize(d));
+    }
+    extractionRegion.SetIndex(VDim - 1, extractionRegion.GetIndex(VDim - 1) + timeStep);
+    extractionRegion.SetSize(VDim - 1, 0);
+
+    typename ExtractFilterType::Pointer extractFilter = ExtractFilterType::New();
+    extractFilter->SetInput(image);
+    extractFilter->SetExtractionRegion(extractionRegion);
+    extractFilter->SetDirectionCollapseToSubmatrix();
+    extractFilter->Update();
+
+    typename itk::Image<TOutputPixel, VDim-1>::Pointer frame = extractFilter->GetOutput();
+    frame->DisconnectPipeline();
+    return frame;
+  }
+}
+
+template <typename TPixel, unsigned int VDim>
+void
+  mitk::PixelBasedParameterFitImageGenerator::DoStreamedParameterFit(const itk::Image<TPixel, VDim>* image,
+  std::vector<typename itk::Image<ScalarType, VDim-1>::ConstPointer>& outputs)
+{
+  using InputFrameImageType = itk::Image<TPixel, VDim-1>;
+  using ParameterImageType = itk::Image<ScalarType, VDim-1>;
+  using FrameRegionType = typename ParameterImageType::RegionType;
+
+  const typename itk::Image<TPixel, VDim>::RegionType dynamicRegion = image->GetLargestPossibleRegion();
+  const unsigned int numberOfTimeSteps = dynamicRegion.GetSize(VDim - 1);
+
+  FrameRegionType frameRegion;
+  for (unsigned int d = 0; d < VDim - 1; ++d)
+  {
+    frameRegion.SetIndex(d, dynamicRegion.GetIndex(d));
+    frameRegion.SetSize(d, dynamicRegion.GetSize(d));
+  }
+
+  const unsigned int slabDim = VDim - 2;
+  const unsigned int numberOfSlices = frameRegion.GetSize(slabDim);
+  const unsigned int slabThickness = (this->m_SlabThickness == 0 || this->m_SlabThickness > numberOfSlices) ? numberOfSlices : this->m_SlabThickness;
+  const unsigned int numberOfSlabs = (numberOfSlices + slabThickness - 1) / slabThickness;
+
+  if (this->m_InternalMask.IsNotNull() && !this->m_InternalMask->GetLargestPossibleRegion().IsInside(frameRegion))
+  {
+    mitkThrow() << "Cannot do fitting. Mask does not cover the region of the dynamic image. Mask region: " << this->m_InternalMask->GetLargestPossibleRegion() << "; image region: " << frameRegion;
+  }
+
+  if (this->m_FrameConverter.IsNotNull())
+  {
+    this->m_FrameConverter->PrepareConversion(this->m_DynamicImage);
+  }
+
+  ModelBaseType::Pointer refModel = this->m_ModelParameterizer->GenerateParameterizedModel();
+  const unsigned int numberOfOutputs = this->m_FitFunctor->GetNumberOfOutputs(refModel);
+  //extraction keeps the index of the region, so a slice of the dynamic image provides the geometry of the result images
+  FrameRegionType referenceRegion = frameRegion;
+  referenceRegion.SetSize(slabDim, 1);
+  const typename InputFrameImageType::Pointer referenceFrame = ExtractFrameRegion<TPixel>(image, 0, referenceRegion);
+
+  std::vector<typename ParameterImageType::Pointer> outputImages;
+  for (unsigned int o = 0; o < numberOfOutputs; ++o)
+  {
+    typename ParameterImageType::Pointer outputImage = ParameterImageType::New();
+    outputImage->CopyInformation(referenceFrame);
+    outputImage->SetRegions(frameRegion);
+    outputImage->Allocate();
+    outputImage->FillBuffer(0.0);
+    outputImages.push_back(outputImage);
+  }
+
+  //results of skipped slabs (no masked voxels) stay 0, like voxels outside of the mask
+  for (unsigned int slab = 0; slab < numberOfSlabs; ++slab)
+  {
+    FrameRegionType slabRegion = frameRegion;
+    slabRegion.SetIndex(slabDim, frameRegion.GetIndex(slabDim) + slab * slabThickness);
+    slabRegion.SetSize(slabDim, std::min(slabThickness, numberOfSlices - slab * slabThickness));
+
+    this->m_ProgressOffset = static_cast<double>(slab) / numberOfSlabs;
+    this->m_ProgressScale = 1.0 / numberOfSlabs;
 
-    Image::Pointer frameMITKImage = imageTimeSelector->GetOutput();
-    frameCache.push_back(frameMITKImage);
-    mitk::CastToItkImage(frameMITKImage, frameImage);
-    fitFilter->SetInput(i,frameImage);
+    bool hasMaskedVoxels = true;
+    if (this->m_InternalMask.IsNotNull())
+    {
+      hasMaskedVoxels = false;
+      for (itk::ImageRegionConstIterator<InternalMaskType> maskIt(this->m_InternalMask, slabRegion); !hasMaskedVoxels && !maskIt.IsAtEnd(); ++maskIt)
+      {
+        hasMaskedVoxels = maskIt.Get() > 0;
+      }
+    }
+
+    std::vector<typename ParameterImageType::ConstPointer> slabOutputs;
+    if (hasMaskedVoxels)
+    {
+      if (this->m_FrameConverter.IsNotNull())
+      {
+        std::vector<typename ParameterImageType::Pointer> frames;
+        for (unsigned int i = 0; i < numberOfTimeSteps; ++i)
+        {
+          typename ParameterImageType::Pointer signalFrame = ExtractFrameRegion<ScalarType>(image, i, slabRegion);
+          typename ParameterImageType::Pointer frame = this->m_FrameConverter->ConvertFrame(signalFrame, i);
+          if (frame.IsNull() || frame->GetLargestPossibleRegion() != slabRegion)
+          {
+            mitkThrow() << "Cannot do fitting. Frame converter returned an invalid frame. Time step: " << i << "; expected region: " << slabRegion;
+          }
+          frames.push_back(frame);
+        }
+        this->DoFrameParameterFit<ScalarType, VDim-1>(frames, slabOutputs);
+      }
+      else
+      {
+        std::vector<typename InputFrameImageType::Pointer> frames;
+        for (unsigned int i = 0; i < numberOfTimeSteps; ++i)
+        {
+          frames.push_back(ExtractFrameRegion<TPixel>(image, i, slabRegion));
+        }
+        this->DoFrameParameterFit<TPixel, VDim-1>(frames, slabOutputs);
+      }
+
+      if (slabOutputs.size() != numberOfOutputs)
+      {
+        mitkThrow() << "Error while generating fitted parameter images. Fit output size of slab does not match expected output number. Output size: " << slabOutputs.size() << "; expected: " << numberOfOutputs;
+      }
+    }
+
+    for (unsigned int o = 0; o < slabOutputs.size(); ++o)
+    {
+      itk::ImageRegionConstIterator<ParameterImageType> sourceIt(slabOutputs[o], slabRegion);
+      itk::ImageRegionIterator<ParameterImageType> targetIt(outputImages[o], slabRegion);
+      for (; !sourceIt.IsAtEnd(); ++sourceIt, ++targetIt)
+      {
+        targetIt.Set(sourceIt.Get());
+      }
+    }
+
+    this->m_Progress = this->m_ProgressOffset + this->m_ProgressScale;
+    this->InvokeEvent(::itk::ProgressEvent());
   }
 
+  this->m_ProgressOffset = 0;
+  this->m_ProgressScale = 1;
+
+  outputs.clear();
+  for (const auto& outputImage : outputImages)
+  {
+    outputs.push_back(outputImage.GetPointer());
+  }
+}
+
+template <typename TPixel, unsigned int VDim>
+void
+  mitk::PixelBasedParameterFitImageGenerator::DoParameterFit(itk::Image<TPixel, VDim>* image)
+{
+  using InputFrameImageType = itk::Image<TPixel, VDim-1>;
+  using ParameterImageType = itk::Image<ScalarType, VDim-1>;
+
   ModelBaseType::TimeGridType timeGrid = ExtractTimeGrid(m_DynamicImage);
   if (m_TimeGridByParameterizer)
   {
@@ -122,18 +548,32 @@ void
     this->m_ModelParameterizer->SetDefaultTimeGrid(timeGrid);
   }
 
-  ModelFitFunctorPolicy functor;
-
-  functor.SetModelFitFunctor(this->m_FitFunctor);
-  functor.SetModelParameterizer(this->m_ModelParameterizer);
-  fitFilter->SetFunctor(functor);
-  if (this->m_InternalMask.IsNotNull())
+  //generate the fits
+  std::vector<typename ParameterImageType::ConstPointer> outputs;
+  if (this->m_FrameConverter.IsNotNull() || this->m_SlabThickness > 0)
   {
-    fitFilter->SetMask(this->m_InternalMask);
+    this->DoStreamedParameterFit<TPixel, VDim>(image, outputs);
   }
+  else
+  {
+    mitk::ImageTimeSelector::Pointer imageTimeSelector = mitk::ImageTimeSelector::New();
+    imageTimeSelector->SetInput(this->m_DynamicImage);
+    std::vector<Image::Pointer> frameCache;
+    std::vector<typename InputFrameImageType::Pointer> frames;
+    for (unsigned int i = 0; i < this->m_DynamicImage->GetTimeSteps(); ++i)
+    {
+      typename InputFrameImageType::Pointer frameImage;
+      imageTimeSelector->SetTimeNr(i);
+      imageTimeSelector->UpdateLargestPossibleRegion();
+
+      Image::Pointer frameMITKImage = imageTimeSelector->GetOutput();
+      frameCache.push_back(frameMITKImage);
+      mitk::CastToItkImage(frameMITKImage, frameImage);
+      frames.push_back(frameImage);
+    }
 
-  //generate the fits
-  fitFilter->Update();
+    this->DoFrameParameterFit<TPixel, VDim-1>(frames, outputs);
+  }
 
   //convert the outputs into mitk images and fill the parameter image map
   ModelBaseType::Pointer refModel = this->m_ModelParameterizer->GenerateParameterizedModel();
@@ -143,21 +583,34 @@ void
   ModelFitFunctorBase::ParameterNamesType evaluationParamNames = this->m_FitFunctor->GetEvaluationParameterNames();
   ModelFitFunctorBase::ParameterNamesType debugParamNames = this->m_FitFunctor->GetDebugParameterNames();
 
-  if (fitFilter->GetNumberOfOutputs() != (paramNames.size() + derivedParamNames.size() + criterionNames.size() + evaluationParamNames.size() + debugParamNames.size()))
+  if (outputs.size() != (paramNames.size() + derivedParamNames.size() + criterionNames.size() + evaluationParamNames.size() + debugParamNames.size()))
   {
-    mitkThrow() << "Error while generating fitted parameter images. Fit filter output size does not match expected parameter number. Output size: "<< fitFilter->GetNumberOfOutputs();
+    mitkThrow() << "Error while generating fitted parameter images. Fit filter output size does not match expected parameter number. Output size: "<< outputs.size();
   }
 
   ModelFitFunctorBase::ParameterNamesType::size_type resultPos = 0;
-  this->m_TempResultMap = StoreResultImages<ParameterImageType>(paramNames,fitFilter,resultPos, resultPos);
-  this->m_TempDerivedResultMap = StoreResultImages<ParameterImageType>(derivedParamNames,fitFilter,resultPos, resultPos);
-  this->m_TempCriterionResultMap = StoreResultImages<ParameterImageType>(criterionNames,fitFilter,resultPos, resultPos);
-  this->m_TempEvaluationResultMap = StoreResultImages<ParameterImageType>(evaluationParamNames,fitFilter,resultPos, resultPos);
+  this->m_TempResultMap = StoreResultImages<ParameterImageType>(paramNames,outputs,resultPos, resultPos);
+  this->m_TempDerivedResultMap = StoreResultImages<ParameterImageType>(derivedParamNames,outputs,resultPos, resultPos);
+  this->m_TempCriterionResultMap = StoreResultImages<ParameterImageType>(criterionNames,outputs,resultPos, resultPos);
+  this->m_TempEvaluationResultMap = StoreResultImages<ParameterImageType>(evaluationParamNames,outputs,resultPos, resultPos);
   //also add debug params (if generated) to the evaluation result map
-  mitk::PixelBasedParameterFitImageGenerator::ParameterImageMapType debugMap = StoreResultImages<ParameterImageType>(debugParamNames, fitFilter, resultPos, resultPos);
+  mitk::PixelBasedParameterFitImageGenerator::ParameterImageMapType debugMap = StoreResultImages<ParameterImageType>(debugParamNames, outputs, resultPos, resultPos);
   this->m_TempEvaluationResultMap.insert(debugMap.begin(), debugMap.end());
 }
 
+void
+  mitk::PixelBasedParameterFitImageGenerator::SetMultiStartParameterizations(const ParametersVectorType& parameterizations)
+{
+  this->m_MultiStartParameterizations = parameterizations;
+  this->Modified();
+};
+
+mitk::PixelBasedParameterFitImageGenerator::ParametersVectorType
+  mitk::PixelBasedParameterFitImageGenerator::GetMultiStartParameterizations() const
+{
+  return this->m_MultiStartParameterizations;
+};
+
 bool
   mitk::PixelBasedParameterFitImageGenerator::HasOutdatedResult() const
 {
@@ -179,6 +632,14 @@ bool
     }
   }
 
+  if (m_FitBackend.IsNotNull())
+  {
+    if (m_FitBackend->GetMTime() > this->m_GenerationTimeStamp)
+    {
+      result = true;
+    }
+  }
+
   if (m_DynamicImage.IsNotNull())
   {
     if (m_DynamicImage->GetMTime() > this->m_GenerationTimeStamp)
@@ -133,6 +133,8 @@ DoModelFit(const SignalType& value, const ModelBase* model,
   optimizer->SetNumberOfIterations(m_Iterations);
   optimizer->SetScales(scales);
   optimizer->SetInitialPosition(internalInitParam);
+  // use the Jacobian of the model instead of the finite differences of the optimizer if possible
+  optimizer->SetUseCostFunctionGradient(metric->HasAnalyticDerivative());
 
   optimizer->StartOptimization();
 
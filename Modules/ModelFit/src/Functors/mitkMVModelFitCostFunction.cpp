@@ -31,6 +31,24 @@ mitk::MVModelFitCostFunction::MeasureType mitk::MVModelFitCostFunction::GetValue
 
 void mitk::MVModelFitCostFunction::GetDerivative (const ParametersType &parameters, DerivativeType &derivative) const
 {
+  if (this->HasAnalyticDerivative())
+  {
+    SignalType signal = m_Model->GetSignal(parameters);
+
+    if(signal.GetSize() != m_Sample.GetSize()) itkExceptionMacro("Signal size does not matche sample size!");
+    if(signal.GetSize() == 0)  itkExceptionMacro("Signal is empty!");
+
+    const ModelBase::JacobianType signalDerivative = m_Model->GetJacobian(parameters);
+
+    if (signalDerivative.rows() != parameters.Size() || signalDerivative.cols() != signal.GetSize())
+    {
+      itkExceptionMacro("Jacobian of the model does not match the parameters and the signal!");
+    }
+
+    CalcMeasureDerivative(parameters, signal, signalDerivative, derivative);
+    return;
+  }
+
   ParametersType::SizeValueType paramCount = parameters.Size();
   MeasureType::SizeValueType measureCount = GetNumberOfValues();
 
@@ -57,6 +75,18 @@ void mitk::MVModelFitCostFunction::GetDerivative (const ParametersType &paramete
 
 };
 
+bool mitk::MVModelFitCostFunction::HasAnalyticDerivative() const
+{
+  return false;
+}
+
+void mitk::MVModelFitCostFunction::CalcMeasureDerivative(const ParametersType& /*parameters*/,
+  const SignalType& /*signal*/, const ModelBase::JacobianType& /*signalDerivative*/,
+  DerivativeType& /*derivative*/) const
+{
+  itkExceptionMacro("Cost function does not implement an analytic derivative of its measure.");
+}
+
 unsigned int mitk::MVModelFitCostFunction::GetNumberOfParameters() const
 {
   return m_Model->GetNumberOfParameters();
@@ -44,6 +44,45 @@ Compute(const InputPixelArrayType& value, const ModelBase* model,
 
   ParametersType fittedParameters = DoModelFit(sample, model, initialParameters, debugParams);
 
+  return this->ComposeOutputs(sample, model, fittedParameters, debugParams, debugNames);
+};
+
+mitk::ModelFitFunctorBase::OutputPixelArrayType
+mitk::ModelFitFunctorBase::
+ComputeForFittedParameters(const InputPixelArrayType& value, const ModelBase* model,
+                           const ModelBase::ParametersType& fittedParameters) const
+{
+  if (!model)
+  {
+    itkExceptionMacro("Cannot compute fit outputs. Passed model is not defined.");
+  }
+
+  if (model->GetNumberOfParameters() != fittedParameters.Size())
+  {
+    itkExceptionMacro("Cannot compute fit outputs. Parameter count of passed model and passed fitted parameters differ. Model parameter count: "
+                      << model->GetNumberOfParameters() << "; Fitted parameters: " << fittedParameters);
+  }
+
+  if (this->m_DebugParameterMaps)
+  {
+    itkExceptionMacro("Cannot compute fit outputs for already fitted parameters. Debug parameter maps are activated, but debug parameters can only be generated by the fit itself.");
+  }
+
+  SignalType sample(value.size());
+
+  for (SignalType::SizeValueType i = 0; i < sample.Size(); ++i)
+  {
+    sample[i] = value [i];
+  }
+
+  return this->ComposeOutputs(sample, model, fittedParameters, DebugParameterMapType(), ParameterNamesType());
+};
+
+mitk::ModelFitFunctorBase::OutputPixelArrayType
+mitk::ModelFitFunctorBase::
+ComposeOutputs(const SignalType& sample, const ModelBase* model, const ParametersType& fittedParameters,
+               const DebugParameterMapType& debugParams, const ParameterNamesType& debugNames) const
+{
   OutputPixelArrayType derivedParameters = this->GetDerivedParameters(model, fittedParameters);
 
   OutputPixelArrayType criteria = this->GetCriteria(model, fittedParameters, sample);
@@ -24,3 +24,24 @@ mitk::NormalizedSumOfSquaredDifferencesFitCostFunction::MeasureType mitk::Normal
 
   return measure;
 }
+
+bool mitk::NormalizedSumOfSquaredDifferencesFitCostFunction::HasAnalyticDerivative() const
+{
+  return this->GetModel() != nullptr && this->GetModel()->HasJacobian();
+}
+
+void mitk::NormalizedSumOfSquaredDifferencesFitCostFunction::CalcMeasureDerivative(const ParametersType& /*parameters*/,
+  const SignalType& signal, const ModelBase::JacobianType& signalDerivative, DerivativeType& derivative) const
+{
+  derivative.SetSize(signalDerivative.rows());
+  derivative.Fill(0.0);
+
+  for (unsigned int i = 0; i < signalDerivative.rows(); ++i)
+  {
+    for (SignalType::size_type j = 0; j < signal.GetSize(); ++j)
+    {
+      derivative[i] -= 2.0 * (m_Sample[j] - signal[j]) * signalDerivative[i][j];
+    }
+    derivative[i] = derivative[i] / signal.GetSize();
+  }
+}
@@ -24,3 +24,23 @@ mitk::SumOfSquaredDifferencesFitCostFunction::MeasureType mitk::SumOfSquaredDiff
 
   return measure;
 }
+
+bool mitk::SumOfSquaredDifferencesFitCostFunction::HasAnalyticDerivative() const
+{
+  return this->GetModel() != nullptr && this->GetModel()->HasJacobian();
+}
+
+void mitk::SumOfSquaredDifferencesFitCostFunction::CalcMeasureDerivative(const ParametersType& /*parameters*/,
+  const SignalType& signal, const ModelBase::JacobianType& signalDerivative, DerivativeType& derivative) const
+{
+  derivative.SetSize(signalDerivative.rows());
+  derivative.Fill(0.0);
+
+  for (unsigned int i = 0; i < signalDerivative.rows(); ++i)
+  {
+    for (SignalType::size_type j = 0; j < signal.GetSize(); ++j)
+    {
+      derivative[i] -= 2.0 * (m_Sample[j] - signal[j]) * signalDerivative[i][j];
+    }
+  }
+}
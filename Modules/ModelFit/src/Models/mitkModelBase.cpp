@@ -146,6 +146,85 @@ mitk::ModelBase::ModelResultType mitk::ModelBase::GetSignal(const ParametersType
   return signal;
 }
 
+void mitk::ModelBase::GetSignals(const BatchParametersType& parameters, BatchSignalsType& signals) const
+{
+  if (parameters.rows() != this->GetNumberOfParameters())
+  {
+    itkExceptionMacro("Passed parameter batch has wrong number of rows for model. Cannot evaluate model. Required: "
+                      << this->GetNumberOfParameters() << "; passed: " << parameters.rows());
+  }
+
+  std::string error;
+
+  if (!ValidateModel(error))
+  {
+    itkExceptionMacro("Cannot evaluate model and return signals. Model is in an invalid state. Validation error: "
+                      << error);
+  }
+
+  signals.SetSize(m_TimeGrid.GetSize(), parameters.cols());
+
+  if (parameters.cols() > 0)
+  {
+    ComputeModelfunctionBatch(parameters, signals);
+  }
+}
+
+void mitk::ModelBase::ComputeModelfunctionBatch(const BatchParametersType& parameters,
+                                                BatchSignalsType& signals) const
+{
+  ParametersType signalParameters(parameters.rows());
+
+  for (unsigned int signalIndex = 0; signalIndex < parameters.cols(); ++signalIndex)
+  {
+    for (unsigned int parameterIndex = 0; parameterIndex < parameters.rows(); ++parameterIndex)
+    {
+      signalParameters[parameterIndex] = parameters(parameterIndex, signalIndex);
+    }
+
+    const ModelResultType signal = ComputeModelfunction(signalParameters);
+
+    if (signal.GetSize() != signals.rows())
+    {
+      itkExceptionMacro("Model signal does not match the time grid. Signal size: " << signal.GetSize()
+                        << "; time grid size: " << signals.rows());
+    }
+
+    for (unsigned int timeIndex = 0; timeIndex < signal.GetSize(); ++timeIndex)
+    {
+      signals(timeIndex, signalIndex) = signal[timeIndex];
+    }
+  }
+}
+
+bool mitk::ModelBase::HasJacobian() const
+{
+  return false;
+}
+
+mitk::ModelBase::JacobianType mitk::ModelBase::GetJacobian(const ParametersType& parameters) const
+{
+  if (parameters.size() != this->GetNumberOfParameters())
+  {
+    itkExceptionMacro("Passed parameter set has wrong size for model. Cannot compute Jacobian. Required size: "
+                      << this->GetNumberOfParameters() << "; passed parameters: " << parameters);
+  }
+
+  std::string error;
+
+  if (!ValidateModel(error))
+  {
+    itkExceptionMacro("Cannot compute Jacobian. Model is in an invalid state. Validation error: " << error);
+  }
+
+  return ComputeJacobian(parameters);
+}
+
+mitk::ModelBase::JacobianType mitk::ModelBase::ComputeJacobian(const ParametersType& /*parameters*/) const
+{
+  itkExceptionMacro("Model does not implement an analytic Jacobian. Check HasJacobian() before calling GetJacobian().");
+}
+
 bool mitk::ModelBase::ValidateModel(std::string& /*error*/) const
 {
   return true;
@@ -51,3 +51,10 @@ SetInitialParameterizationDelegate(const InitialParameterizationDelegateBase* de
 {
   this->m_InitialDelegate = delegate;
 };
+
+const mitk::InitialParameterizationDelegateBase*
+mitk::ModelParameterizerBase::
+GetInitialParameterizationDelegate() const
+{
+  return this->m_InitialDelegate;
+};
@@ -57,11 +57,31 @@ mitk::T2DecayModel::ComputeModelfunction(const ParametersType& parameters) const
   for (const auto& gridPos : m_TimeGrid)
   {
     *signalPos = parameters[0] * exp(-1.0 * gridPos/ parameters[1]);
+    ++signalPos;
   }
 
   return signal;
 };
 
+void mitk::T2DecayModel::ComputeModelfunctionBatch(const BatchParametersType& parameters,
+                                                   BatchSignalsType& signals) const
+{
+  const unsigned int numberOfSignals = parameters.cols();
+  const double* m0 = parameters[0];
+  const double* t2 = parameters[1];
+
+  for (unsigned int timeIndex = 0; timeIndex < m_TimeGrid.GetSize(); ++timeIndex)
+  {
+    const double gridPos = m_TimeGrid[timeIndex];
+    double* signal = signals[timeIndex];
+
+    for (unsigned int signalIndex = 0; signalIndex < numberOfSignals; ++signalIndex)
+    {
+      signal[signalIndex] = m0[signalIndex] * exp(-1.0 * gridPos / t2[signalIndex]);
+    }
+  }
+}
+
 mitk::T2DecayModel::ParameterNamesType mitk::T2DecayModel::GetStaticParameterNames() const
 {
   ParameterNamesType result;
@@ -0,0 +1,139 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkWarmStartParameterizationDelegate.h"
+
+#include <cmath>
+#include <limits>
+
+#include "mitkExceptionMacro.h"
+
+mitk::WarmStartParameterizationDelegate::WarmStartParameterizationDelegate() : m_GridSpacing(1)
+{
+};
+
+mitk::WarmStartParameterizationDelegate::~WarmStartParameterizationDelegate()
+{
+};
+
+void
+mitk::WarmStartParameterizationDelegate::SetFittedParameterImages(const ParameterImageVectorType& images)
+{
+  for (const auto& image : images)
+  {
+    if (image.IsNull())
+    {
+      mitkThrow() << "Cannot set fitted parameter images. At least one image is null.";
+    }
+    if (image->GetLargestPossibleRegion() != images.front()->GetLargestPossibleRegion())
+    {
+      mitkThrow() << "Cannot set fitted parameter images. Images have different regions.";
+    }
+  }
+
+  this->m_FittedParameterImages = images;
+  this->Modified();
+};
+
+void
+mitk::WarmStartParameterizationDelegate::SetFallbackParameterization(const ParametersType& parameters)
+{
+  this->m_FallbackParameterization = parameters;
+  this->Modified();
+};
+
+mitk::WarmStartParameterizationDelegate::ParametersType
+mitk::WarmStartParameterizationDelegate::GetFallbackParameterization() const
+{
+  return this->m_FallbackParameterization;
+};
+
+mitk::WarmStartParameterizationDelegate::ParametersType
+mitk::WarmStartParameterizationDelegate::GetInitialParameterization() const
+{
+  if (this->m_FallbackDelegate.IsNotNull())
+  {
+    return this->m_FallbackDelegate->GetInitialParameterization();
+  }
+
+  return this->m_FallbackParameterization;
+};
+
+mitk::WarmStartParameterizationDelegate::ParametersType
+mitk::WarmStartParameterizationDelegate::GetInitialParameterization(const IndexType& currentPosition) const
+{
+  if (!this->m_FittedParameterImages.empty() && this->m_FittedMask.IsNotNull())
+  {
+    const ParameterImageType::RegionType region = this->m_FittedParameterImages.front()->GetLargestPossibleRegion();
+    const auto spacing = static_cast<IndexType::IndexValueType>(this->m_GridSpacing);
+
+    //candidates are the corners of the grid cell that contains the position
+    IndexType lower;
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+      IndexType::IndexValueType cell = currentPosition[d] / spacing;
+      if (currentPosition[d] < 0 && currentPosition[d] % spacing != 0)
+      {
+        --cell;
+      }
+      lower[d] = cell * spacing;
+    }
+
+    IndexType nearest;
+    IndexType::IndexValueType nearestDistance = std::numeric_limits<IndexType::IndexValueType>::max();
+
+    for (unsigned int corner = 0; corner < 8; ++corner)
+    {
+      IndexType candidate = lower;
+      IndexType::IndexValueType distance = 0;
+      for (unsigned int d = 0; d < 3; ++d)
+      {
+        if (corner & (1u << d))
+        {
+          candidate[d] += spacing;
+        }
+        distance += (candidate[d] - currentPosition[d]) * (candidate[d] - currentPosition[d]);
+      }
+
+      if (distance < nearestDistance && region.IsInside(candidate)
+          && this->m_FittedMask->GetLargestPossibleRegion().IsInside(candidate)
+          && this->m_FittedMask->GetPixel(candidate) > 0)
+      {
+        nearest = candidate;
+        nearestDistance = distance;
+      }
+    }
+
+    if (nearestDistance != std::numeric_limits<IndexType::IndexValueType>::max())
+    {
+      ParametersType result(this->m_FittedParameterImages.size());
+      bool isValid = true;
+      for (ParametersType::size_type i = 0; i < result.Size(); ++i)
+      {
+        result[i] = this->m_FittedParameterImages[i]->GetPixel(nearest);
+        isValid = isValid && std::isfinite(result[i]);
+      }
+
+      if (isValid)
+      {
+        return result;
+      }
+    }
+  }
+
+  if (this->m_FallbackDelegate.IsNotNull())
+  {
+    return this->m_FallbackDelegate->GetInitialParameterization(currentPosition);
+  }
+
+  return this->m_FallbackParameterization;
+};
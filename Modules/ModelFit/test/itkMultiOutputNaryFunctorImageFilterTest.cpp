@@ -214,5 +214,27 @@ int itkMultiOutputNaryFunctorImageFilterTest(int  /*argc*/, char*[] /*argv[]*/)
   CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #4 index #4 (functor #2)",0 == out4->GetPixel(testIndex4));
   CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #4 index #5 (functor #2)",0 == out4->GetPixel(testIndex5));
 
+
+  //Test masked processing with small chunks and with the static thread regions
+  testFilter->SetNumberOfThreads(4);
+  testFilter->SetChunkSize(1);
+  testFilter->Update();
+
+  out1 = testFilter->GetOutput(0);
+  out3 = testFilter->GetOutput(2);
+  CPPUNIT_ASSERT_MESSAGE("Check progress after masked processing", testFilter->GetProgress() == 1.0f);
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #1 index #1 (chunk size 1)",0 == out1->GetPixel(testIndex1));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #1 index #3 (chunk size 1)",444 == out1->GetPixel(testIndex3));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #3 index #2 (chunk size 1)",2 == out3->GetPixel(testIndex2));
+
+  testFilter->DynamicMaskedSchedulingOff();
+  testFilter->Update();
+
+  out1 = testFilter->GetOutput(0);
+  out3 = testFilter->GetOutput(2);
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #1 index #1 (static regions)",0 == out1->GetPixel(testIndex1));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #1 index #3 (static regions)",444 == out1->GetPixel(testIndex3));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #3 index #2 (static regions)",2 == out3->GetPixel(testIndex2));
+
   MITK_TEST_END()
 }
@@ -0,0 +1,88 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <iostream>
+#include "mitkTestingMacros.h"
+#include "mitkVector.h"
+
+#include "mitkTestModel.h"
+#include "mitkT2DecayModel.h"
+
+namespace
+{
+  /** Compares the batched signals of a model with the signals of the per signal evaluation.*/
+  bool BatchEqualsSingleSignals(const mitk::ModelBase* model, const mitk::ModelBase::BatchParametersType& parameters)
+  {
+    mitk::ModelBase::BatchSignalsType signals;
+    model->GetSignals(parameters, signals);
+
+    if (signals.rows() != model->GetTimeGrid().GetSize() || signals.cols() != parameters.cols())
+    {
+      return false;
+    }
+
+    for (unsigned int signalIndex = 0; signalIndex < parameters.cols(); ++signalIndex)
+    {
+      const mitk::ModelBase::ParametersType signalParameters(parameters.get_column(signalIndex));
+      const mitk::ModelBase::ModelResultType signal = model->GetSignal(signalParameters);
+      for (unsigned int timeIndex = 0; timeIndex < signal.GetSize(); ++timeIndex)
+      {
+        if (!mitk::Equal(signal[timeIndex], signals(timeIndex, signalIndex), 1e-10, true))
+        {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+}
+
+int mitkModelBaseBatchTest(int  /*argc*/, char*[] /*argv[]*/)
+{
+  MITK_TEST_BEGIN("mitkModelBaseBatchTest")
+
+  mitk::ModelBase::TimeGridType grid(15);
+  for (unsigned int i = 0; i < grid.GetSize(); ++i)
+  {
+    grid[i] = 3.0 * i;
+  }
+
+  mitk::ModelBase::BatchParametersType parameters(2, 5);
+  for (unsigned int signalIndex = 0; signalIndex < parameters.cols(); ++signalIndex)
+  {
+    parameters(0, signalIndex) = 100.0 + 20.0 * signalIndex;
+    parameters(1, signalIndex) = 5.0 + 7.0 * signalIndex;
+  }
+
+  // TestModel has no batch kernel and uses the default implementation
+  mitk::TestModel::Pointer testModel = mitk::TestModel::New();
+  testModel->SetTimeGrid(grid);
+  MITK_TEST_CONDITION_REQUIRED(BatchEqualsSingleSignals(testModel, parameters),
+                               "Testing batched signals of the default implementation.");
+
+  mitk::T2DecayModel::Pointer t2Model = mitk::T2DecayModel::New();
+  t2Model->SetTimeGrid(grid);
+  MITK_TEST_CONDITION_REQUIRED(BatchEqualsSingleSignals(t2Model, parameters),
+                               "Testing batched signals of the T2 decay model.");
+
+  mitk::ModelBase::BatchParametersType emptyBatch(2, 0);
+  mitk::ModelBase::BatchSignalsType signals;
+  t2Model->GetSignals(emptyBatch, signals);
+  MITK_TEST_CONDITION_REQUIRED(signals.rows() == grid.GetSize() && signals.cols() == 0,
+                               "Testing empty batch.");
+
+  mitk::ModelBase::BatchParametersType wrongParameters(3, 5);
+  MITK_TEST_FOR_EXCEPTION(itk::ExceptionObject, t2Model->GetSignals(wrongParameters, signals));
+
+  MITK_TEST_END()
+}
@@ -10,8 +10,10 @@ found in the LICENSE file.
 
 ============================================================================*/
 
+#include <algorithm>
 #include <iostream>
 
+#include "itkImageRegionConstIterator.h"
 #include "itkImageRegionIterator.h"
 
 #include "mitkTestingMacros.h"
@@ -25,6 +27,83 @@ found in the LICENSE file.
 
 #include "mitkTestDynamicImageGenerator.h"
 
+namespace
+{
+  /** Fit backend for the linear model that solves the least squares problem directly.*/
+  class TestLinearFitBackend : public mitk::ModelFitBackendBase
+  {
+  public:
+    mitkClassMacro(TestLinearFitBackend, mitk::ModelFitBackendBase);
+    itkFactorylessNewMacro(Self);
+
+    bool CanFit(const mitk::ModelBase* model, const mitk::ModelFitFunctorBase* fitFunctor) const override
+    {
+      return dynamic_cast<const mitk::LinearModel*>(model) != nullptr && !fitFunctor->GetDebugParameterMaps();
+    }
+
+    void Fit(const mitk::ModelBase* model, const mitk::ModelFitFunctorBase* /*fitFunctor*/,
+             const BatchSignalsType& signals, BatchParametersType& parameters) override
+    {
+      ++m_NumberOfCalls;
+
+      const mitk::ModelBase::TimeGridType& grid = model->GetTimeGrid();
+      const double n = grid.GetSize();
+      for (unsigned int i = 0; i < signals.cols(); ++i)
+      {
+        double sumT = 0.0;
+        double sumTT = 0.0;
+        double sumY = 0.0;
+        double sumTY = 0.0;
+        for (unsigned int t = 0; t < grid.GetSize(); ++t)
+        {
+          sumT += grid[t];
+          sumTT += grid[t] * grid[t];
+          sumY += signals(t, i);
+          sumTY += grid[t] * signals(t, i);
+        }
+        parameters(0, i) = (n * sumTY - sumT * sumY) / (n * sumTT - sumT * sumT);
+        parameters(1, i) = (sumY - parameters(0, i) * sumT) / n;
+      }
+    }
+
+    unsigned int m_NumberOfCalls = 0;
+  };
+
+  /** Frame converter that scales the signal and records the largest converted frame.*/
+  class TestScalingFrameConverter : public mitk::DynamicImageFrameConverterBase
+  {
+  public:
+    mitkClassMacro(TestScalingFrameConverter, mitk::DynamicImageFrameConverterBase);
+    itkFactorylessNewMacro(Self);
+
+    void PrepareConversion(const mitk::Image* /*dynamicImage*/) override
+    {
+      ++m_NumberOfPreparations;
+    }
+
+    FrameImageType::Pointer ConvertFrame(const FrameImageType* frame, unsigned int /*timeStep*/) const override
+    {
+      FrameImageType::Pointer result = FrameImageType::New();
+      result->CopyInformation(frame);
+      result->SetRegions(frame->GetLargestPossibleRegion());
+      result->Allocate();
+
+      itk::ImageRegionConstIterator<FrameImageType> sourceIt(frame, frame->GetLargestPossibleRegion());
+      itk::ImageRegionIterator<FrameImageType> targetIt(result, result->GetLargestPossibleRegion());
+      for (; !sourceIt.IsAtEnd(); ++sourceIt, ++targetIt)
+      {
+        targetIt.Set(2.0 * sourceIt.Get());
+      }
+
+      m_MaxFrameSize = std::max<unsigned int>(m_MaxFrameSize, frame->GetLargestPossibleRegion().GetNumberOfPixels());
+      return result;
+    }
+
+    unsigned int m_NumberOfPreparations = 0;
+    mutable unsigned int m_MaxFrameSize = 0;
+  };
+}
+
 int mitkPixelBasedParameterFitImageGeneratorTest(int  /*argc*/, char*[] /*argv[]*/)
 {
   // always start with this!
@@ -151,5 +230,145 @@ int mitkPixelBasedParameterFitImageGeneratorTest(int  /*argc*/, char*[] /*argv[]
     testValue = offsetAccessor2.GetPixelByIndex(testIndex6);
     MITK_TEST_CONDITION_REQUIRED(mitk::Equal(0,testValue, 1e-5, true)==true, "Check param #2 (offset) at index #6");
 
+    //Test with fit backend (and mask)
+    TestLinearFitBackend::Pointer backend = TestLinearFitBackend::New();
+    backend->SetBatchSize(2);
+    generator->SetFitBackend(backend);
+
+    generator->Generate();
+
+    MITK_TEST_CONDITION_REQUIRED(backend->m_NumberOfCalls > 1, "Check if fit backend was used in batches.");
+
+    resultImages = generator->GetParameterImages();
+    derivedResultImages = generator->GetDerivedParameterImages();
+    mitk::PixelBasedParameterFitImageGenerator::ParameterImageMapType criterionImages = generator->GetCriterionImages();
+
+    CPPUNIT_ASSERT_MESSAGE("Check number of parameter images (fit backend)", 2 == resultImages.size());
+    CPPUNIT_ASSERT_MESSAGE("Check number of derived parameter images (fit backend)", 1 == derivedResultImages.size());
+    CPPUNIT_ASSERT_MESSAGE("Check number of criterion images (fit backend)", 1 == criterionImages.size());
+
+    mitk::ImagePixelReadAccessor<mitk::ScalarType,3> slopeAccessor3(resultImages["slope"]);
+    mitk::ImagePixelReadAccessor<mitk::ScalarType,3> offsetAccessor3(resultImages["offset"]);
+
+    testValue = slopeAccessor3.GetPixelByIndex(testIndex2);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(2000,testValue, 1e-4, true)==true, "Check param #1 (slope) at index #2 (fit backend)");
+    testValue = slopeAccessor3.GetPixelByIndex(testIndex3);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(0,testValue, 1e-5, true)==true, "Check param #1 (slope) at index #3 (fit backend)");
+    testValue = slopeAccessor3.GetPixelByIndex(testIndex5);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(4000,testValue, 1e-4, true)==true, "Check param #1 (slope) at index #5 (fit backend)");
+    testValue = offsetAccessor3.GetPixelByIndex(testIndex5);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(10,testValue, 1e-5, true)==true, "Check param #2 (offset) at index #5 (fit backend)");
+
+    //Backend must not be used, if it does not support the functor configuration
+    const unsigned int numberOfCalls = backend->m_NumberOfCalls;
+    testFunctor->SetDebugParameterMaps(true);
+
+    generator->Generate();
+
+    MITK_TEST_CONDITION_REQUIRED(backend->m_NumberOfCalls == numberOfCalls, "Check if unsupported configuration falls back to fit functor.");
+    resultImages = generator->GetParameterImages();
+    mitk::ImagePixelReadAccessor<mitk::ScalarType,3> slopeAccessor4(resultImages["slope"]);
+    testValue = slopeAccessor4.GetPixelByIndex(testIndex5);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(4000,testValue, 1e-4, true)==true, "Check param #1 (slope) at index #5 (fallback)");
+
+    //Test slab wise fitting (with mask)
+    testFunctor->SetDebugParameterMaps(false);
+    mitk::PixelBasedParameterFitImageGenerator::Pointer slabGenerator = mitk::PixelBasedParameterFitImageGenerator::New();
+    slabGenerator->SetDynamicImage(dynamicImage);
+    slabGenerator->SetModelParameterizer(parameterizer);
+    slabGenerator->SetFitFunctor(testFunctor);
+    slabGenerator->SetMask(maskImage);
+    slabGenerator->SetSlabThickness(2);
+
+    slabGenerator->Generate();
+
+    resultImages = slabGenerator->GetParameterImages();
+    derivedResultImages = slabGenerator->GetDerivedParameterImages();
+
+    CPPUNIT_ASSERT_MESSAGE("Check number of parameter images (slabs)", 2 == resultImages.size());
+    CPPUNIT_ASSERT_MESSAGE("Check number of derived parameter images (slabs)", 1 == derivedResultImages.size());
+    MITK_TEST_CONDITION_REQUIRED(resultImages["slope"]->GetGeometry()->GetOrigin() == dynamicImage->GetGeometry()->GetOrigin(), "Check origin of parameter image (slabs)");
+
+    mitk::ImagePixelReadAccessor<mitk::ScalarType,3> slopeAccessor5(resultImages["slope"]);
+    mitk::ImagePixelReadAccessor<mitk::ScalarType,3> offsetAccessor5(resultImages["offset"]);
+
+    testValue = slopeAccessor5.GetPixelByIndex(testIndex2);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(2000,testValue, 1e-4, true)==true, "Check param #1 (slope) at index #2 (slabs)");
+    testValue = slopeAccessor5.GetPixelByIndex(testIndex3);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(0,testValue, 1e-5, true)==true, "Check param #1 (slope) at index #3 (slabs)");
+    testValue = slopeAccessor5.GetPixelByIndex(testIndex4);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(8000,testValue, 1e-4, true)==true, "Check param #1 (slope) at index #4 (slabs)");
+    testValue = slopeAccessor5.GetPixelByIndex(testIndex5);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(4000,testValue, 1e-4, true)==true, "Check param #1 (slope) at index #5 (slabs)");
+    testValue = offsetAccessor5.GetPixelByIndex(testIndex5);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(10,testValue, 1e-5, true)==true, "Check param #2 (offset) at index #5 (slabs)");
+
+    //Test frame conversion on the fly (one slice per slab)
+    TestScalingFrameConverter::Pointer converter = TestScalingFrameConverter::New();
+    slabGenerator->SetFrameConverter(converter);
+    slabGenerator->SetSlabThickness(1);
+
+    slabGenerator->Generate();
+
+    MITK_TEST_CONDITION_REQUIRED(converter->m_NumberOfPreparations == 1, "Check if frame converter was prepared once.");
+    const unsigned int sliceSize = dynamicImage->GetDimension(0) * dynamicImage->GetDimension(1);
+    MITK_TEST_CONDITION_REQUIRED(converter->m_MaxFrameSize == sliceSize, "Check if frame converter only got single slices.");
+
+    resultImages = slabGenerator->GetParameterImages();
+    mitk::ImagePixelReadAccessor<mitk::ScalarType,3> slopeAccessor6(resultImages["slope"]);
+    mitk::ImagePixelReadAccessor<mitk::ScalarType,3> offsetAccessor6(resultImages["offset"]);
+
+    testValue = slopeAccessor6.GetPixelByIndex(testIndex2);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(4000,testValue, 1e-4, true)==true, "Check param #1 (slope) at index #2 (converted)");
+    testValue = slopeAccessor6.GetPixelByIndex(testIndex4);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(16000,testValue, 1e-4, true)==true, "Check param #1 (slope) at index #4 (converted)");
+    testValue = slopeAccessor6.GetPixelByIndex(testIndex6);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(0,testValue, 1e-5, true)==true, "Check param #1 (slope) at index #6 (converted)");
+    testValue = offsetAccessor6.GetPixelByIndex(testIndex5);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(20,testValue, 1e-5, true)==true, "Check param #2 (offset) at index #5 (converted)");
+
+    //Test warm start mode (with mask and multi-start on the grid voxels)
+    mitk::PixelBasedParameterFitImageGenerator::Pointer warmStartGenerator = mitk::PixelBasedParameterFitImageGenerator::New();
+    warmStartGenerator->SetDynamicImage(dynamicImage);
+    warmStartGenerator->SetModelParameterizer(parameterizer);
+    warmStartGenerator->SetFitFunctor(testFunctor);
+    warmStartGenerator->SetMask(maskImage);
+    warmStartGenerator->SetWarmStartGridSpacing(2);
+    mitk::ModelBase::ParametersType multiStart(2);
+    multiStart[0] = 1000;
+    multiStart[1] = 5;
+    warmStartGenerator->SetMultiStartParameterizations(mitk::PixelBasedParameterFitImageGenerator::ParametersVectorType(1, multiStart));
+
+    warmStartGenerator->Generate();
+
+    MITK_TEST_CONDITION_REQUIRED(parameterizer->GetInitialParameterizationDelegate() == nullptr, "Check if warm start restores the initial parameterization delegate.");
+
+    resultImages = warmStartGenerator->GetParameterImages();
+    mitk::ImagePixelReadAccessor<mitk::ScalarType,3> slopeAccessor7(resultImages["slope"]);
+    mitk::ImagePixelReadAccessor<mitk::ScalarType,3> offsetAccessor7(resultImages["offset"]);
+
+    testValue = slopeAccessor7.GetPixelByIndex(testIndex2);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(2000,testValue, 1e-4, true)==true, "Check param #1 (slope) at index #2 (warm start)");
+    testValue = slopeAccessor7.GetPixelByIndex(testIndex3);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(0,testValue, 1e-5, true)==true, "Check param #1 (slope) at index #3 (warm start)");
+    testValue = slopeAccessor7.GetPixelByIndex(testIndex4);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(8000,testValue, 1e-4, true)==true, "Check param #1 (slope) at index #4 (warm start)");
+    testValue = slopeAccessor7.GetPixelByIndex(testIndex5);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(4000,testValue, 1e-4, true)==true, "Check param #1 (slope) at index #5 (warm start)");
+    testValue = offsetAccessor7.GetPixelByIndex(testIndex5);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(10,testValue, 1e-5, true)==true, "Check param #2 (offset) at index #5 (warm start)");
+
+    //Test multi-start for every voxel
+    warmStartGenerator->SetWarmStartGridSpacing(1);
+
+    warmStartGenerator->Generate();
+
+    resultImages = warmStartGenerator->GetParameterImages();
+    mitk::ImagePixelReadAccessor<mitk::ScalarType,3> slopeAccessor8(resultImages["slope"]);
+    testValue = slopeAccessor8.GetPixelByIndex(testIndex4);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(8000,testValue, 1e-4, true)==true, "Check param #1 (slope) at index #4 (multi-start)");
+    testValue = slopeAccessor8.GetPixelByIndex(testIndex6);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(0,testValue, 1e-5, true)==true, "Check param #1 (slope) at index #6 (multi-start)");
+
   MITK_TEST_END()
 }
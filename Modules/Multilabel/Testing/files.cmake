@@ -1,8 +1,11 @@
 set(MODULE_TESTS
     mitkLabelTest.cpp
+    mitkLabelDeltaHistoryTest.cpp
     mitkLabelSetTest.cpp
     mitkLabelSetImageTest.cpp
     mitkLabelSetImageIOTest.cpp
     mitkLabelSetImageSurfaceStampFilterTest.cpp
+    mitkLabelSetImageToSurfaceFilterTest.cpp
+    mitkSparseLabelLayerTest.cpp
 )
 
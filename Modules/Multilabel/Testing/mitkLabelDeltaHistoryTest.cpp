@@ -0,0 +1,147 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkLabelDeltaHistory.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+class mitkLabelDeltaHistoryTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkLabelDeltaHistoryTestSuite);
+  MITK_TEST(AppendChangedRuns_StoresChangedPixelsOnly);
+  MITK_TEST(UndoRedo_RestoresPixels);
+  MITK_TEST(UndoLabel_KeepsOtherLabels);
+  MITK_TEST(Undo_KeepsPixelsOfLaterEdits);
+  MITK_TEST(RemoveLayer_MovesEditsOfHigherLayers);
+  MITK_TEST(SetMaximumMemorySize_DropsOldestEdits);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef mitk::LabelDeltaHistory::PixelType PixelType;
+  typedef mitk::LabelDeltaHistory::Run Run;
+
+  std::vector<PixelType> m_Buffer;
+  std::vector<PixelType> m_Original;
+
+  // records the change of m_Buffer to newValues as edit of the given layer
+  mitk::LabelDeltaHistory::EditId Write(mitk::LabelDeltaHistory &history,
+                                        unsigned int layer,
+                                        const std::vector<PixelType> &newValues)
+  {
+    std::vector<Run> runs;
+    mitk::LabelDeltaHistory::AppendChangedRuns(m_Buffer.data(), newValues.data(), m_Buffer.size(), 0, runs);
+    m_Buffer = newValues;
+    return history.Record(layer, std::move(runs));
+  }
+
+public:
+  void setUp() override
+  {
+    m_Buffer = {0, 0, 3, 3, 3, 0, 1, 2, 2, 0, 0, 0};
+    m_Original = m_Buffer;
+  }
+
+  void tearDown() override
+  {
+    m_Buffer.clear();
+    m_Original.clear();
+  }
+
+  void AppendChangedRuns_StoresChangedPixelsOnly()
+  {
+    const std::vector<PixelType> newValues = {0, 4, 4, 3, 3, 0, 0, 0, 2, 0, 0, 4};
+    std::vector<Run> runs;
+    mitk::LabelDeltaHistory::AppendChangedRuns(m_Buffer.data(), newValues.data(), m_Buffer.size(), 100, runs);
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(5), runs.size());
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(101), runs[0].Offset);
+    CPPUNIT_ASSERT_EQUAL(std::uint32_t(1), runs[0].Length);
+    CPPUNIT_ASSERT_EQUAL(PixelType(0), runs[0].OldValue);
+    CPPUNIT_ASSERT_EQUAL(PixelType(4), runs[0].NewValue);
+    CPPUNIT_ASSERT_EQUAL(PixelType(3), runs[1].OldValue);
+    CPPUNIT_ASSERT_EQUAL(PixelType(4), mitk::LabelDeltaHistory::GetLabel(runs[1]));
+    CPPUNIT_ASSERT_EQUAL(PixelType(1), mitk::LabelDeltaHistory::GetLabel(runs[2]));
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(111), runs[4].Offset);
+  }
+
+  void UndoRedo_RestoresPixels()
+  {
+    mitk::LabelDeltaHistory history;
+    const std::vector<PixelType> edited = {5, 5, 5, 3, 3, 0, 1, 0, 0, 0, 0, 0};
+    const auto edit = this->Write(history, 0, edited);
+    CPPUNIT_ASSERT(history.Contains(edit));
+    CPPUNIT_ASSERT(history.GetMemorySize() > 0);
+
+    CPPUNIT_ASSERT(!history.Undo(edit, m_Buffer.data()).empty());
+    CPPUNIT_ASSERT(m_Buffer == m_Original);
+    CPPUNIT_ASSERT_EQUAL(mitk::LabelDeltaHistory::EditId(0), history.FindLastEdit(0, 5));
+
+    CPPUNIT_ASSERT(!history.Redo(edit, m_Buffer.data()).empty());
+    CPPUNIT_ASSERT(m_Buffer == edited);
+    CPPUNIT_ASSERT_EQUAL(edit, history.FindLastEdit(0, 5));
+  }
+
+  void UndoLabel_KeepsOtherLabels()
+  {
+    mitk::LabelDeltaHistory history;
+    const auto edit = this->Write(history, 0, {5, 5, 3, 3, 3, 0, 1, 6, 6, 0, 0, 0});
+
+    history.UndoLabel(edit, 5, m_Buffer.data());
+    const std::vector<PixelType> expected = {0, 0, 3, 3, 3, 0, 1, 6, 6, 0, 0, 0};
+    CPPUNIT_ASSERT(m_Buffer == expected);
+    CPPUNIT_ASSERT_EQUAL(edit, history.FindLastEdit(0, 6));
+    CPPUNIT_ASSERT_EQUAL(mitk::LabelDeltaHistory::EditId(0), history.FindLastEdit(0, 5));
+
+    history.UndoLabel(edit, 6, m_Buffer.data());
+    CPPUNIT_ASSERT(m_Buffer == m_Original);
+  }
+
+  void Undo_KeepsPixelsOfLaterEdits()
+  {
+    mitk::LabelDeltaHistory history;
+    const auto first = this->Write(history, 0, {5, 5, 5, 5, 3, 0, 1, 2, 2, 0, 0, 0});
+    const auto second = this->Write(history, 0, {5, 7, 7, 5, 3, 0, 1, 2, 2, 0, 0, 0});
+    CPPUNIT_ASSERT(first != second);
+
+    // the pixels overwritten by the second edit are kept
+    history.Undo(first, m_Buffer.data());
+    const std::vector<PixelType> expected = {0, 7, 7, 3, 3, 0, 1, 2, 2, 0, 0, 0};
+    CPPUNIT_ASSERT(m_Buffer == expected);
+  }
+
+  void RemoveLayer_MovesEditsOfHigherLayers()
+  {
+    mitk::LabelDeltaHistory history;
+    const auto first = this->Write(history, 0, {5, 0, 3, 3, 3, 0, 1, 2, 2, 0, 0, 0});
+    const auto second = this->Write(history, 1, {5, 5, 3, 3, 3, 0, 1, 2, 2, 0, 0, 0});
+
+    history.RemoveLayer(0);
+    CPPUNIT_ASSERT(!history.Contains(first));
+    CPPUNIT_ASSERT_EQUAL(0u, history.GetLayer(second));
+    CPPUNIT_ASSERT_THROW(history.GetLayer(first), mitk::Exception);
+  }
+
+  void SetMaximumMemorySize_DropsOldestEdits()
+  {
+    mitk::LabelDeltaHistory history;
+    const auto first = this->Write(history, 0, {5, 0, 3, 3, 3, 0, 1, 2, 2, 0, 0, 0});
+    const auto second = this->Write(history, 0, {5, 0, 3, 3, 3, 0, 1, 2, 2, 0, 0, 8});
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), history.GetNumberOfEdits());
+
+    history.SetMaximumMemorySize(1);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), history.GetNumberOfEdits());
+    CPPUNIT_ASSERT(!history.Contains(first));
+    CPPUNIT_ASSERT(history.Contains(second));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkLabelDeltaHistory)
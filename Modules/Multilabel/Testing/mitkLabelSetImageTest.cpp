@@ -11,6 +11,8 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include <mitkIOUtil.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImagePixelWriteAccessor.h>
 #include <mitkImageStatisticsHolder.h>
 #include <mitkLabelSetImage.h>
 #include <mitkTestFixture.h>
@@ -31,6 +33,8 @@ class mitkLabelSetImageTestSuite : public mitk::TestFixture
   MITK_TEST(TestExistsLabel);
   MITK_TEST(TestExistsLabelSet);
   MITK_TEST(TestSetActiveLayer);
+  MITK_TEST(TestSparseLayerStorage);
+  MITK_TEST(TestLabelStatistics);
   MITK_TEST(TestRemoveLayer);
   MITK_TEST(TestRemoveLabels);
   MITK_TEST(TestMergeLabel);
@@ -332,6 +336,128 @@ public:
                            mitk::Equal(*newlayer, *m_LabelSetImage->GetActiveLabelSet(), 0.00001, true));
   }
 
+  void TestSparseLayerStorage()
+  {
+    typedef mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> WriteAccessorType;
+    typedef mitk::ImagePixelReadAccessor<mitk::Label::PixelType, 3> ReadAccessorType;
+    const itk::Index<3> index0 = {{10, 20, 30}};
+    const itk::Index<3> index1 = {{200, 100, 300}};
+
+    m_LabelSetImage->SetSparseLayerStorage(true);
+    {
+      WriteAccessorType accessor(m_LabelSetImage.GetPointer());
+      accessor.SetPixelByIndex(index0, 1);
+    }
+
+    m_LabelSetImage->AddLayer();
+    CPPUNIT_ASSERT_MESSAGE("Inactive layer is not sparse", m_LabelSetImage->IsLayerSparse(0));
+    {
+      ReadAccessorType accessor(m_LabelSetImage.GetPointer());
+      CPPUNIT_ASSERT_MESSAGE("New layer is not empty", accessor.GetPixelByIndex(index0) == 0);
+    }
+    {
+      WriteAccessorType accessor(m_LabelSetImage.GetPointer());
+      accessor.SetPixelByIndex(index1, 2);
+    }
+
+    m_LabelSetImage->SetActiveLayer(0);
+    CPPUNIT_ASSERT_MESSAGE("Inactive layer is not sparse", m_LabelSetImage->IsLayerSparse(1));
+    {
+      ReadAccessorType accessor(m_LabelSetImage.GetPointer());
+      CPPUNIT_ASSERT_MESSAGE("Wrong pixel value after layer switch", accessor.GetPixelByIndex(index0) == 1);
+      CPPUNIT_ASSERT_MESSAGE("Wrong pixel value after layer switch", accessor.GetPixelByIndex(index1) == 0);
+    }
+
+    // the image of an inactive layer is decoded on demand
+    mitk::Image *layerImage = m_LabelSetImage->GetLayerImage(1);
+    CPPUNIT_ASSERT_MESSAGE("Decoded layer is still sparse", !m_LabelSetImage->IsLayerSparse(1));
+    {
+      ReadAccessorType accessor(layerImage);
+      CPPUNIT_ASSERT_MESSAGE("Wrong pixel value in layer image", accessor.GetPixelByIndex(index1) == 2);
+    }
+
+    mitk::LabelSetImage::Pointer clone = m_LabelSetImage->Clone();
+    MITK_ASSERT_EQUAL(clone, m_LabelSetImage, "Clone of a sparse LabelSetImage differs");
+
+    m_LabelSetImage->SetSparseLayerStorage(false);
+    CPPUNIT_ASSERT_MESSAGE("Layer is sparse without sparse layer storage", !m_LabelSetImage->IsLayerSparse(0));
+    m_LabelSetImage->SetActiveLayer(1);
+    {
+      ReadAccessorType accessor(m_LabelSetImage.GetPointer());
+      CPPUNIT_ASSERT_MESSAGE("Wrong pixel value after layer switch", accessor.GetPixelByIndex(index1) == 2);
+    }
+  }
+
+  void TestLabelStatistics()
+  {
+    typedef mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> WriteAccessorType;
+    const unsigned int layer = m_LabelSetImage->GetActiveLayer();
+    {
+      WriteAccessorType accessor(m_LabelSetImage.GetPointer());
+      for (itk::IndexValueType x = 10; x < 20; ++x)
+      {
+        const itk::Index<3> index = {{x, 5, 7}};
+        accessor.SetPixelByIndex(index, 1);
+      }
+      const itk::Index<3> index = {{100, 50, 70}};
+      accessor.SetPixelByIndex(index, 1);
+    }
+    m_LabelSetImage->Modified();
+
+    mitk::LabelSetImage::LabelStatistics statistics = m_LabelSetImage->GetLabelStatistics(1, layer);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(11), statistics.NumberOfVoxels);
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(10), statistics.LowerIndex[0]);
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(100), statistics.UpperIndex[0]);
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(70), statistics.UpperIndex[2]);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL((145.0 + 100.0) / 11.0, statistics.GetCentroidIndex()[0], 1e-9);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_LabelSetImage->GetLabelStatistics(2, layer).NumberOfVoxels);
+
+    // an update of a region, as done by the segmentation tools for a slice
+    mitk::Image::RegionType region = m_LabelSetImage->GetLargestPossibleRegion();
+    region.SetIndex(2, 70);
+    region.SetSize(2, 1);
+    m_LabelSetImage->BeginLabelStatisticsUpdate(region);
+    {
+      WriteAccessorType accessor(m_LabelSetImage.GetPointer());
+      const itk::Index<3> index = {{100, 50, 70}};
+      accessor.SetPixelByIndex(index, 2);
+    }
+    m_LabelSetImage->RegionModified(region);
+    m_LabelSetImage->EndLabelStatisticsUpdate(region);
+
+    statistics = m_LabelSetImage->GetLabelStatistics(1, layer);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(10), statistics.NumberOfVoxels);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(14.5, statistics.GetCentroidIndex()[0], 1e-9);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), m_LabelSetImage->GetLabelStatistics(2, layer).NumberOfVoxels);
+
+    mitk::Label::Pointer label1 = mitk::Label::New();
+    label1->SetValue(1);
+    mitk::Label::Pointer label2 = mitk::Label::New();
+    label2->SetValue(2);
+    m_LabelSetImage->GetActiveLabelSet()->AddLabel(label1);
+    m_LabelSetImage->GetActiveLabelSet()->AddLabel(label2);
+
+    m_LabelSetImage->MergeLabel(1, 2, layer);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(11), m_LabelSetImage->GetLabelStatistics(1, layer).NumberOfVoxels);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_LabelSetImage->GetLabelStatistics(2, layer).NumberOfVoxels);
+
+    mitk::Image::Pointer mask = m_LabelSetImage->CreateLabelMask(1);
+    {
+      mitk::ImagePixelReadAccessor<mitk::Label::PixelType, 3> accessor(mask);
+      const itk::Index<3> inside = {{100, 50, 70}};
+      const itk::Index<3> outside = {{20, 5, 7}};
+      CPPUNIT_ASSERT_EQUAL(mitk::Label::PixelType(1), accessor.GetPixelByIndex(inside));
+      CPPUNIT_ASSERT_EQUAL(mitk::Label::PixelType(0), accessor.GetPixelByIndex(outside));
+    }
+
+    m_LabelSetImage->EraseLabel(1, layer);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_LabelSetImage->GetLabelStatistics(1, layer).NumberOfVoxels);
+
+    // statistics of inactive layers
+    m_LabelSetImage->AddLayer();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_LabelSetImage->GetLabelStatistics(1, layer).NumberOfVoxels);
+  }
+
   void TestRemoveLayer()
   {
     // Cache active layer
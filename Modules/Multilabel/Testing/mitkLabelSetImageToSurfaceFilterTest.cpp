@@ -0,0 +1,130 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkLabelSetImage.h>
+#include <mitkLabelSetImageToSurfaceFilter.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <vtkPolyData.h>
+
+class mitkLabelSetImageToSurfaceFilterTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkLabelSetImageToSurfaceFilterTestSuite);
+  MITK_TEST(Update_RequestedLabel_GeneratesSurface);
+  MITK_TEST(Update_AllLabels_GeneratesOneOutputPerLabel);
+  MITK_TEST(Update_ModifiedLabel_ReusesSurfacesOfOtherLabels);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::LabelSetImage::Pointer m_LabelSetImage;
+
+  void FillBox(const itk::Index<3> &lower, const itk::Index<3> &upper, mitk::Label::PixelType value)
+  {
+    mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> accessor(m_LabelSetImage.GetPointer());
+    itk::Index<3> index;
+    for (index[2] = lower[2]; index[2] <= upper[2]; ++index[2])
+      for (index[1] = lower[1]; index[1] <= upper[1]; ++index[1])
+        for (index[0] = lower[0]; index[0] <= upper[0]; ++index[0])
+          accessor.SetPixelByIndex(index, value);
+  }
+
+public:
+  void setUp() override
+  {
+    mitk::Image::Pointer regularImage = mitk::Image::New();
+    unsigned int dimensions[3] = {32, 32, 32};
+    regularImage->Initialize(mitk::MakeScalarPixelType<int>(), 3, dimensions);
+
+    m_LabelSetImage = mitk::LabelSetImage::New();
+    m_LabelSetImage->Initialize(regularImage);
+
+    mitk::Color color;
+    color.Set(1.0f, 0.0f, 0.0f);
+    m_LabelSetImage->GetActiveLabelSet()->AddLabel("first", color);
+    color.Set(0.0f, 1.0f, 0.0f);
+    m_LabelSetImage->GetActiveLabelSet()->AddLabel("second", color);
+
+    this->FillBox({{4, 4, 4}}, {{10, 10, 10}}, 1);
+    this->FillBox({{18, 18, 18}}, {{26, 26, 26}}, 2);
+    m_LabelSetImage->Modified();
+  }
+
+  void tearDown() override { m_LabelSetImage = nullptr; }
+
+  void Update_RequestedLabel_GeneratesSurface()
+  {
+    auto filter = mitk::LabelSetImageToSurfaceFilter::New();
+    filter->SetInput(m_LabelSetImage);
+    filter->SetRequestedLabel(2);
+    filter->Update();
+
+    vtkPolyData *polydata = filter->GetOutput()->GetVtkPolyData();
+    CPPUNIT_ASSERT(polydata != nullptr);
+    CPPUNIT_ASSERT(polydata->GetNumberOfPoints() > 0);
+
+    // the surface encloses the box of label 2 only
+    double bounds[6];
+    polydata->GetBounds(bounds);
+    CPPUNIT_ASSERT(bounds[0] > 16.0 && bounds[1] < 28.0);
+  }
+
+  void Update_AllLabels_GeneratesOneOutputPerLabel()
+  {
+    auto filter = mitk::LabelSetImageToSurfaceFilter::New();
+    filter->SetInput(m_LabelSetImage);
+    filter->SetGenerateAllLabels(true);
+    filter->SetNumberOfThreads(2);
+    filter->Update();
+
+    CPPUNIT_ASSERT_EQUAL(2u, filter->GetNumberOfOutputs());
+    CPPUNIT_ASSERT_EQUAL(mitk::LabelSetImage::PixelType(1), filter->GetLabelOfOutput(0));
+    CPPUNIT_ASSERT_EQUAL(mitk::LabelSetImage::PixelType(2), filter->GetLabelOfOutput(1));
+    CPPUNIT_ASSERT_THROW(filter->GetLabelOfOutput(2), mitk::Exception);
+
+    for (unsigned int idx = 0; idx < 2; ++idx)
+      CPPUNIT_ASSERT(filter->GetOutput(idx)->GetVtkPolyData()->GetNumberOfPoints() > 0);
+  }
+
+  void Update_ModifiedLabel_ReusesSurfacesOfOtherLabels()
+  {
+    auto filter = mitk::LabelSetImageToSurfaceFilter::New();
+    filter->SetInput(m_LabelSetImage);
+    filter->SetGenerateAllLabels(true);
+    filter->Update();
+
+    vtkPoints *firstPoints = filter->GetOutput(0)->GetVtkPolyData()->GetPoints();
+    vtkPoints *secondPoints = filter->GetOutput(1)->GetVtkPolyData()->GetPoints();
+    const vtkIdType numberOfSecondPoints = secondPoints->GetNumberOfPoints();
+
+    // grow label 2, label 1 is not touched
+    this->FillBox({{18, 18, 27}}, {{26, 26, 28}}, 2);
+    mitk::Image::RegionType region = m_LabelSetImage->GetLargestPossibleRegion();
+    region.SetIndex(2, 27);
+    region.SetSize(2, 2);
+    m_LabelSetImage->RegionModified(region);
+    filter->Update();
+
+    CPPUNIT_ASSERT_EQUAL(2u, filter->GetNumberOfOutputs());
+    CPPUNIT_ASSERT(filter->GetOutput(0)->GetVtkPolyData()->GetPoints() == firstPoints);
+    CPPUNIT_ASSERT(filter->GetOutput(1)->GetVtkPolyData()->GetPoints() != secondPoints ||
+                   secondPoints->GetNumberOfPoints() != numberOfSecondPoints);
+
+    // a new smoothing setting regenerates all labels
+    filter->SetUseSmoothing(1);
+    filter->Update();
+    CPPUNIT_ASSERT(filter->GetOutput(0)->GetVtkPolyData()->GetPoints() != firstPoints);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkLabelSetImageToSurfaceFilter)
@@ -0,0 +1,121 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkImage.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkSparseLabelLayer.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <algorithm>
+
+class mitkSparseLabelLayerTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkSparseLabelLayerTestSuite);
+  MITK_TEST(Encode_Buffer_StoresRunsOfLabeledPixels);
+  MITK_TEST(Decode_Buffer_RestoresPixels);
+  MITK_TEST(EncodeDecode_Image_RoundTrip);
+  MITK_TEST(Encode_WrongPixelType_Throws);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef mitk::SparseLabelLayer::PixelType PixelType;
+
+  std::vector<PixelType> m_Buffer;
+
+public:
+  void setUp() override { m_Buffer = {0, 0, 3, 3, 3, 0, 1, 2, 2, 0, 0, 0, 5}; }
+
+  void tearDown() override { m_Buffer.clear(); }
+
+  void Encode_Buffer_StoresRunsOfLabeledPixels()
+  {
+    mitk::SparseLabelLayer layer;
+    layer.Encode(m_Buffer.data(), m_Buffer.size());
+
+    CPPUNIT_ASSERT_EQUAL(m_Buffer.size(), layer.GetNumberOfPixels());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(4), layer.GetNumberOfRuns());
+
+    const mitk::SparseLabelLayer::Run &run = layer.GetRuns()[0];
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(2), run.Offset);
+    CPPUNIT_ASSERT_EQUAL(std::uint32_t(3), run.Length);
+    CPPUNIT_ASSERT_EQUAL(PixelType(3), run.Value);
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(12), layer.GetRuns()[3].Offset);
+
+    layer.Clear();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), layer.GetNumberOfRuns());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), layer.GetNumberOfPixels());
+  }
+
+  void Decode_Buffer_RestoresPixels()
+  {
+    mitk::SparseLabelLayer layer;
+    layer.Encode(m_Buffer.data(), m_Buffer.size());
+
+    std::vector<PixelType> decoded(m_Buffer.size(), 7);
+    layer.Decode(decoded.data());
+    CPPUNIT_ASSERT(decoded == m_Buffer);
+  }
+
+  void EncodeDecode_Image_RoundTrip()
+  {
+    const unsigned int dimensions[4] = {16, 8, 4, 2};
+    mitk::Image::Pointer image = mitk::Image::New();
+    image->Initialize(mitk::MakeScalarPixelType<PixelType>(), 4, dimensions);
+    const std::size_t numberOfPixels = 16 * 8 * 4 * 2;
+    {
+      mitk::ImageWriteAccessor accessor(image);
+      auto *pixels = static_cast<PixelType *>(accessor.GetData());
+      std::fill(pixels, pixels + numberOfPixels, PixelType(0));
+      std::fill(pixels + 100, pixels + 300, PixelType(4));
+      pixels[numberOfPixels - 1] = 9;
+    }
+
+    mitk::SparseLabelLayer layer;
+    layer.Encode(image);
+    CPPUNIT_ASSERT_EQUAL(numberOfPixels, layer.GetNumberOfPixels());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), layer.GetNumberOfRuns());
+    CPPUNIT_ASSERT(layer.GetMemorySize() < numberOfPixels * sizeof(PixelType));
+
+    mitk::Image::Pointer decoded = mitk::Image::New();
+    decoded->Initialize(image);
+    layer.Decode(decoded);
+    MITK_ASSERT_EQUAL(image, decoded, "Decoded image differs from the encoded image");
+
+    mitk::SparseLabelLayer empty;
+    empty.Initialize(image);
+    empty.Decode(decoded);
+    CPPUNIT_ASSERT_EQUAL(numberOfPixels, empty.GetNumberOfPixels());
+    {
+      mitk::ImageWriteAccessor accessor(decoded);
+      auto *pixels = static_cast<PixelType *>(accessor.GetData());
+      CPPUNIT_ASSERT(std::all_of(pixels, pixels + numberOfPixels, [](PixelType value) { return value == 0; }));
+    }
+
+    const unsigned int otherDimensions[3] = {16, 8, 4};
+    mitk::Image::Pointer otherImage = mitk::Image::New();
+    otherImage->Initialize(mitk::MakeScalarPixelType<PixelType>(), 3, otherDimensions);
+    CPPUNIT_ASSERT_THROW(layer.Decode(otherImage), mitk::Exception);
+  }
+
+  void Encode_WrongPixelType_Throws()
+  {
+    const unsigned int dimensions[3] = {4, 4, 4};
+    mitk::Image::Pointer image = mitk::Image::New();
+    image->Initialize(mitk::MakeScalarPixelType<float>(), 3, dimensions);
+
+    mitk::SparseLabelLayer layer;
+    CPPUNIT_ASSERT_THROW(layer.Encode(image), mitk::Exception);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkSparseLabelLayer)
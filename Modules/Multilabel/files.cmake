@@ -1,5 +1,8 @@
 set(CPP_FILES
   mitkLabel.cpp
+  mitkLabelDeltaHistory.cpp
+  mitkLabelDeltaOperation.cpp
+  mitkLabelDeltaOperationApplier.cpp
   mitkLabelSet.cpp
   mitkLabelSetImage.cpp
   mitkLabelSetImageConverter.cpp
@@ -9,6 +12,7 @@ set(CPP_FILES
   mitkLabelSetImageToSurfaceThreadedFilter.cpp
   mitkLabelSetImageVtkMapper2D.cpp
   mitkMultilabelObjectFactory.cpp
+  mitkSparseLabelLayer.cpp
   mitkLabelSetIOHelper.cpp
   mitkDICOMSegmentationPropertyHelper.cpp
   mitkDICOMSegmentationConstants.cpp
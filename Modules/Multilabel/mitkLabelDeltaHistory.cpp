@@ -0,0 +1,251 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkLabelDeltaHistory.h"
+
+#include <mitkExceptionMacro.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+  typedef mitk::LabelDeltaHistory::PixelType PixelType;
+  typedef mitk::LabelDeltaHistory::Run Run;
+
+  // Changes the pixels of the runs which still have the value found (redo) or left (undo) by the edit.
+  // The runs of the changed pixels are appended to changedRuns.
+  void ApplyRuns(const std::vector<Run> &runs, bool undo, PixelType *buffer, std::vector<Run> &changedRuns)
+  {
+    for (const auto &run : runs)
+    {
+      const PixelType expectedValue = undo ? run.NewValue : run.OldValue;
+      const PixelType value = undo ? run.OldValue : run.NewValue;
+
+      PixelType *pixel = buffer + run.Offset;
+      PixelType *end = pixel + run.Length;
+      while (pixel != end)
+      {
+        pixel = std::find(pixel, end, expectedValue);
+        if (pixel == end)
+          break;
+
+        PixelType *runEnd =
+          std::find_if(pixel, end, [expectedValue](PixelType other) { return other != expectedValue; });
+        std::fill(pixel, runEnd, value);
+        changedRuns.push_back({static_cast<std::uint64_t>(pixel - buffer),
+                               static_cast<std::uint32_t>(runEnd - pixel),
+                               run.OldValue,
+                               run.NewValue});
+        pixel = runEnd;
+      }
+    }
+  }
+
+  std::size_t GetMemorySize(const std::vector<Run> &runs)
+  {
+    return runs.capacity() * sizeof(Run);
+  }
+}
+
+void mitk::LabelDeltaHistory::AppendChangedRuns(const PixelType *oldValues,
+                                                const PixelType *newValues,
+                                                std::size_t numberOfPixels,
+                                                std::uint64_t offset,
+                                                std::vector<Run> &runs)
+{
+  const std::size_t maximumLength = std::numeric_limits<std::uint32_t>::max();
+
+  std::size_t i = 0;
+  while (i < numberOfPixels)
+  {
+    if (oldValues[i] == newValues[i])
+    {
+      ++i;
+      continue;
+    }
+
+    const PixelType oldValue = oldValues[i];
+    const PixelType newValue = newValues[i];
+    std::size_t end = i + 1;
+    while (end < numberOfPixels && end - i < maximumLength && oldValues[end] == oldValue && newValues[end] == newValue)
+      ++end;
+
+    runs.push_back({offset + i, static_cast<std::uint32_t>(end - i), oldValue, newValue});
+    i = end;
+  }
+}
+
+mitk::LabelDeltaHistory::LabelDeltaHistory() : m_NextEditId(1), m_MaximumMemorySize(0)
+{
+}
+
+mitk::LabelDeltaHistory::EditId mitk::LabelDeltaHistory::Record(unsigned int layer, std::vector<Run> &&runs)
+{
+  if (runs.empty())
+    return 0;
+
+  runs.shrink_to_fit();
+  m_Edits.push_back({m_NextEditId++, layer, std::move(runs), std::vector<Run>()});
+  const EditId edit = m_Edits.back().Id;
+
+  this->DropOldestEdits();
+  return edit;
+}
+
+bool mitk::LabelDeltaHistory::Contains(EditId edit) const
+{
+  return this->FindEdit(edit) != m_Edits.end();
+}
+
+unsigned int mitk::LabelDeltaHistory::GetLayer(EditId edit) const
+{
+  auto it = this->FindEdit(edit);
+  if (it == m_Edits.end())
+    mitkThrow() << "The label history does not contain the edit " << edit;
+
+  return it->Layer;
+}
+
+mitk::LabelDeltaHistory::EditId mitk::LabelDeltaHistory::FindLastEdit(unsigned int layer, PixelType label) const
+{
+  for (auto it = m_Edits.rbegin(); it != m_Edits.rend(); ++it)
+  {
+    if (it->Layer == layer &&
+        std::any_of(it->Applied.begin(), it->Applied.end(), [label](const Run &run) { return GetLabel(run) == label; }))
+    {
+      return it->Id;
+    }
+  }
+  return 0;
+}
+
+std::vector<mitk::LabelDeltaHistory::Run> mitk::LabelDeltaHistory::Undo(EditId edit, PixelType *buffer)
+{
+  std::vector<Run> changedRuns;
+  auto it = this->FindEdit(edit);
+  if (it == m_Edits.end())
+    return changedRuns;
+
+  ApplyRuns(it->Applied, true, buffer, changedRuns);
+  it->Applied.clear();
+  it->Applied.shrink_to_fit();
+  it->Undone.insert(it->Undone.end(), changedRuns.begin(), changedRuns.end());
+
+  this->RemoveIfEmpty(it);
+  return changedRuns;
+}
+
+std::vector<mitk::LabelDeltaHistory::Run> mitk::LabelDeltaHistory::UndoLabel(EditId edit,
+                                                                             PixelType label,
+                                                                             PixelType *buffer)
+{
+  std::vector<Run> changedRuns;
+  auto it = this->FindEdit(edit);
+  if (it == m_Edits.end())
+    return changedRuns;
+
+  std::vector<Run> labelRuns;
+  std::vector<Run> otherRuns;
+  for (const auto &run : it->Applied)
+    (GetLabel(run) == label ? labelRuns : otherRuns).push_back(run);
+
+  ApplyRuns(labelRuns, true, buffer, changedRuns);
+  otherRuns.shrink_to_fit();
+  it->Applied.swap(otherRuns);
+  it->Undone.insert(it->Undone.end(), changedRuns.begin(), changedRuns.end());
+
+  this->RemoveIfEmpty(it);
+  return changedRuns;
+}
+
+std::vector<mitk::LabelDeltaHistory::Run> mitk::LabelDeltaHistory::Redo(EditId edit, PixelType *buffer)
+{
+  std::vector<Run> changedRuns;
+  auto it = this->FindEdit(edit);
+  if (it == m_Edits.end())
+    return changedRuns;
+
+  ApplyRuns(it->Undone, false, buffer, changedRuns);
+  it->Undone.clear();
+  it->Undone.shrink_to_fit();
+  it->Applied.insert(it->Applied.end(), changedRuns.begin(), changedRuns.end());
+
+  this->RemoveIfEmpty(it);
+  return changedRuns;
+}
+
+void mitk::LabelDeltaHistory::RemoveLayer(unsigned int layer)
+{
+  m_Edits.erase(
+    std::remove_if(m_Edits.begin(), m_Edits.end(), [layer](const Edit &edit) { return edit.Layer == layer; }),
+    m_Edits.end());
+
+  for (auto &edit : m_Edits)
+  {
+    if (edit.Layer > layer)
+      --edit.Layer;
+  }
+}
+
+void mitk::LabelDeltaHistory::Clear()
+{
+  m_Edits.clear();
+}
+
+std::size_t mitk::LabelDeltaHistory::GetMemorySize() const
+{
+  std::size_t memorySize = 0;
+  for (const auto &edit : m_Edits)
+    memorySize += ::GetMemorySize(edit.Applied) + ::GetMemorySize(edit.Undone);
+
+  return memorySize;
+}
+
+void mitk::LabelDeltaHistory::SetMaximumMemorySize(std::size_t bytes)
+{
+  m_MaximumMemorySize = bytes;
+  this->DropOldestEdits();
+}
+
+std::deque<mitk::LabelDeltaHistory::Edit>::iterator mitk::LabelDeltaHistory::FindEdit(EditId edit)
+{
+  // the edits are ordered by their ids
+  auto it = std::lower_bound(
+    m_Edits.begin(), m_Edits.end(), edit, [](const Edit &other, EditId id) { return other.Id < id; });
+  return it != m_Edits.end() && it->Id == edit ? it : m_Edits.end();
+}
+
+std::deque<mitk::LabelDeltaHistory::Edit>::const_iterator mitk::LabelDeltaHistory::FindEdit(EditId edit) const
+{
+  return const_cast<LabelDeltaHistory *>(this)->FindEdit(edit);
+}
+
+void mitk::LabelDeltaHistory::RemoveIfEmpty(std::deque<Edit>::iterator edit)
+{
+  if (edit->Applied.empty() && edit->Undone.empty())
+    m_Edits.erase(edit);
+}
+
+void mitk::LabelDeltaHistory::DropOldestEdits()
+{
+  if (m_MaximumMemorySize == 0)
+    return;
+
+  // the most recent edit is kept even if it exceeds the limit on its own
+  std::size_t memorySize = this->GetMemorySize();
+  while (m_Edits.size() > 1 && memorySize > m_MaximumMemorySize)
+  {
+    memorySize -= ::GetMemorySize(m_Edits.front().Applied) + ::GetMemorySize(m_Edits.front().Undone);
+    m_Edits.pop_front();
+  }
+}
@@ -0,0 +1,134 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkLabelDeltaHistory_h
+#define mitkLabelDeltaHistory_h
+
+#include <mitkLabel.h>
+
+#include <MitkMultilabelExports.h>
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace mitk
+{
+  /**
+    \brief Run-length encoded history of the pixel changes of the layers of a LabelSetImage.
+
+    Every edit, e.g. a stroke of a segmentation tool, is stored as runs of pixels with the same old and the
+    same new value, so an edit needs memory proportional to the pixels it changed. Each run is tagged by the
+    layer of its edit and by the label it belongs to (see GetLabel()), so the changes of one label can be
+    undone without touching the pixels of other labels, see UndoLabel().
+
+    Undo() and Redo() only change pixels which still have the value left or found by the edit. Pixels
+    changed again by later edits are kept, so edits can be undone in any order. Runs whose pixels were
+    changed this way are dropped.
+
+    The history works on the pixel buffers of the layers, which LabelSetImage provides, see
+    LabelSetImage::SetLabelHistoryEnabled().
+    */
+  class MITKMULTILABEL_EXPORT LabelDeltaHistory
+  {
+  public:
+    typedef Label::PixelType PixelType;
+    /** \brief Identifies an edit, 0 is no edit */
+    typedef std::uint64_t EditId;
+
+    struct Run
+    {
+      /** \brief Offset of the first pixel of the run in the pixel buffer of the layer, including all time steps */
+      std::uint64_t Offset;
+      std::uint32_t Length;
+      PixelType OldValue;
+      PixelType NewValue;
+    };
+
+    /**
+      \brief Appends the runs of the pixels which differ between @a oldValues and @a newValues.
+      \param offset Offset of the first of the @a numberOfPixels pixels in the pixel buffer of the layer
+      */
+    static void AppendChangedRuns(const PixelType *oldValues,
+                                  const PixelType *newValues,
+                                  std::size_t numberOfPixels,
+                                  std::uint64_t offset,
+                                  std::vector<Run> &runs);
+
+    /** \brief The label a run belongs to: the label written or, if the exterior was written, the label erased. */
+    static PixelType GetLabel(const Run &run) { return run.NewValue != 0 ? run.NewValue : run.OldValue; }
+
+    LabelDeltaHistory();
+
+    /** \brief Stores the runs as a new edit of @a layer and returns its id, 0 if there are no runs. */
+    EditId Record(unsigned int layer, std::vector<Run> &&runs);
+
+    bool Contains(EditId edit) const;
+
+    /** \brief The layer of an edit. Throws if the history does not contain the edit. */
+    unsigned int GetLayer(EditId edit) const;
+
+    /** \brief The most recent edit of @a layer with changes of @a label that are not undone, 0 if there is none. */
+    EditId FindLastEdit(unsigned int layer, PixelType label) const;
+
+    /**
+      \brief Reverts the changes of an edit that are not undone yet in the pixel buffer of its layer.
+      \return The runs of the pixels that were changed.
+      */
+    std::vector<Run> Undo(EditId edit, PixelType *buffer);
+
+    /** \brief Like Undo(), but reverts only the changes of @a label. */
+    std::vector<Run> UndoLabel(EditId edit, PixelType label, PixelType *buffer);
+
+    /** \brief Applies the undone changes of an edit again and returns the runs of the pixels that were changed. */
+    std::vector<Run> Redo(EditId edit, PixelType *buffer);
+
+    /** \brief Removes the edits of a layer and moves the edits of the layers above it one layer down. */
+    void RemoveLayer(unsigned int layer);
+
+    void Clear();
+
+    std::size_t GetNumberOfEdits() const { return m_Edits.size(); }
+
+    /** \brief Memory used by the runs of all edits in bytes. */
+    std::size_t GetMemorySize() const;
+
+    /** \brief The oldest edits are dropped if the runs need more memory. 0 (the default) means no limit. */
+    void SetMaximumMemorySize(std::size_t bytes);
+    std::size_t GetMaximumMemorySize() const { return m_MaximumMemorySize; }
+
+  private:
+    struct Edit
+    {
+      EditId Id;
+      unsigned int Layer;
+      /** \brief Changes currently in effect */
+      std::vector<Run> Applied;
+      /** \brief Changes that were undone */
+      std::vector<Run> Undone;
+    };
+
+    std::deque<Edit>::iterator FindEdit(EditId edit);
+    std::deque<Edit>::const_iterator FindEdit(EditId edit) const;
+
+    /** \brief Removes the edit if nothing of it is left, e.g. after pixels were changed by later edits. */
+    void RemoveIfEmpty(std::deque<Edit>::iterator edit);
+
+    void DropOldestEdits();
+
+    std::deque<Edit> m_Edits;
+    EditId m_NextEditId;
+    std::size_t m_MaximumMemorySize;
+  };
+}
+
+#endif
@@ -0,0 +1,22 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkLabelDeltaOperation.h"
+
+mitk::LabelDeltaOperation::LabelDeltaOperation(LabelSetImage *image, LabelDeltaHistory::EditId edit, bool undo)
+  : Operation(1), m_Image(image), m_Edit(edit), m_Undo(undo)
+{
+}
+
+mitk::LabelDeltaOperation::~LabelDeltaOperation()
+{
+}
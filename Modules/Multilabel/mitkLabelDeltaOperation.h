@@ -0,0 +1,57 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkLabelDeltaOperation_h
+#define mitkLabelDeltaOperation_h
+
+#include <mitkLabelSetImage.h>
+#include <mitkOperation.h>
+#include <mitkWeakPointer.h>
+
+#include <MitkMultilabelExports.h>
+
+namespace mitk
+{
+  /**
+    \brief Undoes or redoes an edit recorded by the label history of a LabelSetImage.
+
+    The operation holds the id of the edit only, the changed pixels are stored by the history of the
+    image, see LabelSetImage::SetLabelHistoryEnabled(). The image is referenced weakly, operations of
+    deleted images do nothing.
+
+    \sa LabelDeltaOperationApplier
+  */
+  class MITKMULTILABEL_EXPORT LabelDeltaOperation : public Operation
+  {
+  public:
+    mitkClassMacro(LabelDeltaOperation, Operation);
+
+    /** \param undo Undo the edit if true, otherwise redo it. */
+    LabelDeltaOperation(LabelSetImage *image, LabelDeltaHistory::EditId edit, bool undo);
+
+    ~LabelDeltaOperation() override;
+
+    /** \brief The image, nullptr if it was deleted. */
+    LabelSetImage::Pointer GetImage() const { return m_Image.Lock(); }
+
+    LabelDeltaHistory::EditId GetEdit() const { return m_Edit; }
+
+    bool IsUndo() const { return m_Undo; }
+
+  private:
+    WeakPointer<LabelSetImage> m_Image;
+    LabelDeltaHistory::EditId m_Edit;
+    bool m_Undo;
+  };
+}
+
+#endif
@@ -0,0 +1,46 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkLabelDeltaOperationApplier.h"
+
+#include "mitkLabelDeltaOperation.h"
+#include "mitkRenderingManager.h"
+
+mitk::LabelDeltaOperationApplier::LabelDeltaOperationApplier()
+{
+}
+
+mitk::LabelDeltaOperationApplier::~LabelDeltaOperationApplier()
+{
+}
+
+void mitk::LabelDeltaOperationApplier::ExecuteOperation(Operation *operation)
+{
+  auto *deltaOperation = dynamic_cast<LabelDeltaOperation *>(operation);
+  if (deltaOperation == nullptr)
+    return;
+
+  LabelSetImage::Pointer image = deltaOperation->GetImage();
+  if (image.IsNull())
+    return;
+
+  const bool changed = deltaOperation->IsUndo() ? image->UndoEdit(deltaOperation->GetEdit())
+                                                : image->RedoEdit(deltaOperation->GetEdit());
+  if (changed)
+    RenderingManager::GetInstance()->RequestUpdateAll();
+}
+
+mitk::LabelDeltaOperationApplier *mitk::LabelDeltaOperationApplier::GetInstance()
+{
+  static auto *s_Instance = new LabelDeltaOperationApplier();
+  return s_Instance;
+}
@@ -0,0 +1,44 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkLabelDeltaOperationApplier_h
+#define mitkLabelDeltaOperationApplier_h
+
+#include <mitkCommon.h>
+#include <mitkOperationActor.h>
+
+#include <MitkMultilabelExports.h>
+
+namespace mitk
+{
+  /** \brief Executes a LabelDeltaOperation.
+    \sa LabelDeltaOperation
+  */
+  class MITKMULTILABEL_EXPORT LabelDeltaOperationApplier : public OperationActor
+  {
+  public:
+    mitkClassMacroNoParent(LabelDeltaOperationApplier)
+
+    /** \brief Returns an instance of the class */
+    static LabelDeltaOperationApplier *GetInstance();
+
+    /** \brief Executes a LabelDeltaOperation, other operations are ignored. */
+    void ExecuteOperation(Operation *operation) override;
+
+  protected:
+    LabelDeltaOperationApplier();
+
+    ~LabelDeltaOperationApplier() override;
+  };
+}
+
+#endif
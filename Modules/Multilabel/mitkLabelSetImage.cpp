@@ -16,6 +16,8 @@ found in the LICENSE file.
 #include "mitkImageCast.h"
 #include "mitkImagePixelReadAccessor.h"
 #include "mitkImagePixelWriteAccessor.h"
+#include "mitkImageReadAccessor.h"
+#include "mitkImageWriteAccessor.h"
 #include "mitkInteractionConst.h"
 #include "mitkLookupTableProperty.h"
 #include "mitkPadImageFilter.h"
@@ -34,34 +36,243 @@ found in the LICENSE file.
 
 #include <itkCommand.h>
 
+#include <algorithm>
+
 template <typename TPixel, unsigned int VDimensions>
 void SetToZero(itk::Image<TPixel, VDimensions> *source)
 {
   source->FillBuffer(0);
 }
 
-template <unsigned int VImageDimension = 3>
-void CreateLabelMaskProcessing(mitk::Image *layerImage, mitk::Image *mask, mitk::LabelSet::PixelType index)
+namespace
 {
-  mitk::ImagePixelReadAccessor<mitk::LabelSet::PixelType, VImageDimension> readAccessor(layerImage);
-  mitk::ImagePixelWriteAccessor<mitk::LabelSet::PixelType, VImageDimension> writeAccessor(mask);
+  typedef mitk::LabelSetImage::LabelStatistics LabelStatistics;
+  typedef mitk::LabelSetImage::LabelStatisticsMapType LabelStatisticsMapType;
+  typedef mitk::LabelSetImage::PixelType LabelPixelType;
+
+  void GetLabelImageDimensions(const mitk::Image *image, itk::IndexValueType dimensions[4])
+  {
+    for (unsigned int i = 0; i < 4; ++i)
+      dimensions[i] = i < image->GetDimension() ? image->GetDimension(i) : 1;
+  }
 
-  std::size_t numberOfPixels = 1;
-  for (int dim = 0; dim < static_cast<int>(VImageDimension); ++dim)
-    numberOfPixels *= static_cast<std::size_t>(readAccessor.GetDimension(dim));
+  std::size_t GetRowOffset(const itk::IndexValueType dimensions[4],
+                           itk::IndexValueType y,
+                           itk::IndexValueType z,
+                           itk::IndexValueType t)
+  {
+    return ((static_cast<std::size_t>(t) * dimensions[2] + z) * dimensions[1] + y) * dimensions[0];
+  }
 
-  auto src = readAccessor.GetData();
-  auto dest = writeAccessor.GetData();
+  // Adds (sign 1) or removes (sign -1) the run [x, end) of row (y, z) with a label value to or from the statistics.
+  void AccumulateRun(LabelPixelType value,
+                     itk::IndexValueType x,
+                     itk::IndexValueType end,
+                     itk::IndexValueType y,
+                     itk::IndexValueType z,
+                     int sign,
+                     LabelStatisticsMapType &statistics)
+  {
+    const auto length = static_cast<std::size_t>(end - x);
+    const double xSum = 0.5 * (x + end - 1) * length;
+    auto label = statistics.find(value);
+    if (sign > 0)
+    {
+      if (label == statistics.end())
+      {
+        label = statistics.emplace(value, LabelStatistics()).first;
+        label->second.LowerIndex = {{x, y, z}};
+        label->second.UpperIndex = {{end - 1, y, z}};
+      }
+      LabelStatistics &labelStatistics = label->second;
+      labelStatistics.LowerIndex[0] = std::min(labelStatistics.LowerIndex[0], x);
+      labelStatistics.LowerIndex[1] = std::min(labelStatistics.LowerIndex[1], y);
+      labelStatistics.LowerIndex[2] = std::min(labelStatistics.LowerIndex[2], z);
+      labelStatistics.UpperIndex[0] = std::max(labelStatistics.UpperIndex[0], end - 1);
+      labelStatistics.UpperIndex[1] = std::max(labelStatistics.UpperIndex[1], y);
+      labelStatistics.UpperIndex[2] = std::max(labelStatistics.UpperIndex[2], z);
+      labelStatistics.NumberOfVoxels += length;
+      labelStatistics.IndexSum[0] += xSum;
+      labelStatistics.IndexSum[1] += static_cast<double>(y) * length;
+      labelStatistics.IndexSum[2] += static_cast<double>(z) * length;
+    }
+    else if (label != statistics.end())
+    {
+      // the bounding box is kept, it still contains all remaining voxels
+      LabelStatistics &labelStatistics = label->second;
+      if (labelStatistics.NumberOfVoxels <= length)
+      {
+        statistics.erase(label);
+      }
+      else
+      {
+        labelStatistics.NumberOfVoxels -= length;
+        labelStatistics.IndexSum[0] -= xSum;
+        labelStatistics.IndexSum[1] -= static_cast<double>(y) * length;
+        labelStatistics.IndexSum[2] -= static_cast<double>(z) * length;
+      }
+    }
+  }
 
-  for (std::size_t i = 0; i < numberOfPixels; ++i)
+  // calls functor(offset, length) for each row of the inclusive box [lower, upper]
+  template <typename TFunctor>
+  void ForEachRowOfRegion(const itk::IndexValueType dimensions[4],
+                          const itk::IndexValueType lower[4],
+                          const itk::IndexValueType upper[4],
+                          TFunctor functor)
   {
-    if (index == *(src + i))
-      *(dest + i) = 1;
+    const auto length = static_cast<std::size_t>(upper[0] - lower[0] + 1);
+    for (itk::IndexValueType t = lower[3]; t <= upper[3]; ++t)
+    {
+      for (itk::IndexValueType z = lower[2]; z <= upper[2]; ++z)
+      {
+        for (itk::IndexValueType y = lower[1]; y <= upper[1]; ++y)
+          functor(GetRowOffset(dimensions, y, z, t) + lower[0], length);
+      }
+    }
   }
+
+  // Adds (sign 1) or removes (sign -1) the voxels of the inclusive box [lower, upper] of a label image
+  // buffer to or from the statistics. Runs of equal values within a row are accumulated at once.
+  void AccumulateLabelStatistics(const LabelPixelType *buffer,
+                                 const itk::IndexValueType dimensions[4],
+                                 const itk::IndexValueType lower[4],
+                                 const itk::IndexValueType upper[4],
+                                 int sign,
+                                 LabelStatisticsMapType &statistics)
+  {
+    for (itk::IndexValueType t = lower[3]; t <= upper[3]; ++t)
+    {
+      for (itk::IndexValueType z = lower[2]; z <= upper[2]; ++z)
+      {
+        for (itk::IndexValueType y = lower[1]; y <= upper[1]; ++y)
+        {
+          const LabelPixelType *row = buffer + GetRowOffset(dimensions, y, z, t);
+          itk::IndexValueType x = lower[0];
+          while (x <= upper[0])
+          {
+            const LabelPixelType value = row[x];
+            itk::IndexValueType end = x + 1;
+            while (end <= upper[0] && row[end] == value)
+              ++end;
+
+            if (value != 0)
+              AccumulateRun(value, x, end, y, z, sign, statistics);
+            x = end;
+          }
+        }
+      }
+    }
+  }
+
+  // index (x, y, z, t) of the first pixel of a run of the label history, runs do not cross rows
+  void GetRunIndex(const itk::IndexValueType dimensions[4],
+                   const mitk::LabelDeltaHistory::Run &run,
+                   itk::IndexValueType index[4])
+  {
+    auto offset = static_cast<itk::IndexValueType>(run.Offset);
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      index[i] = offset % dimensions[i];
+      offset /= dimensions[i];
+    }
+    index[3] = offset;
+  }
+
+  // appends the runs of the pixels with sourceValue within [offset, offset + length) of the buffer
+  void AppendRunsOfValue(const LabelPixelType *buffer,
+                         std::size_t offset,
+                         std::size_t length,
+                         LabelPixelType sourceValue,
+                         LabelPixelType targetValue,
+                         std::vector<mitk::LabelDeltaHistory::Run> &runs)
+  {
+    const LabelPixelType *pixel = buffer + offset;
+    const LabelPixelType *end = pixel + length;
+    while ((pixel = std::find(pixel, end, sourceValue)) != end)
+    {
+      const LabelPixelType *runEnd =
+        std::find_if(pixel, end, [sourceValue](LabelPixelType value) { return value != sourceValue; });
+      runs.push_back({static_cast<std::uint64_t>(pixel - buffer),
+                      static_cast<std::uint32_t>(runEnd - pixel),
+                      sourceValue,
+                      targetValue});
+      pixel = runEnd;
+    }
+  }
+
+  // inclusive bounds of the region cropped to the image, false if nothing remains
+  bool GetRegionBounds(const mitk::Image *image,
+                       mitk::Image::RegionType region,
+                       itk::IndexValueType lower[4],
+                       itk::IndexValueType upper[4])
+  {
+    if (!region.Crop(image->GetLargestPossibleRegion()) || region.GetNumberOfPixels() == 0)
+      return false;
+
+    const mitk::Image::RegionType::IndexType upperIndex = region.GetUpperIndex();
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+      lower[i] = region.GetIndex(i);
+      upper[i] = upperIndex[i];
+    }
+    return true;
+  }
+
+  void ComputeLabelStatistics(const mitk::Image *image, LabelStatisticsMapType &statistics)
+  {
+    statistics.clear();
+
+    itk::IndexValueType dimensions[4];
+    GetLabelImageDimensions(image, dimensions);
+    const itk::IndexValueType lower[4] = {0, 0, 0, 0};
+    const itk::IndexValueType upper[4] = {dimensions[0] - 1, dimensions[1] - 1, dimensions[2] - 1, dimensions[3] - 1};
+
+    mitk::ImageReadAccessor accessor(image);
+    AccumulateLabelStatistics(
+      static_cast<const LabelPixelType *>(accessor.GetData()), dimensions, lower, upper, 1, statistics);
+  }
+
+  // calls functor(offset, length) for each row of the bounding box of a label in all time steps
+  template <typename TFunctor>
+  void ForEachRowOfBoundingBox(const itk::IndexValueType dimensions[4],
+                               const LabelStatistics &statistics,
+                               TFunctor functor)
+  {
+    const auto length = static_cast<std::size_t>(statistics.UpperIndex[0] - statistics.LowerIndex[0] + 1);
+    for (itk::IndexValueType t = 0; t < dimensions[3]; ++t)
+    {
+      for (itk::IndexValueType z = statistics.LowerIndex[2]; z <= statistics.UpperIndex[2]; ++z)
+      {
+        for (itk::IndexValueType y = statistics.LowerIndex[1]; y <= statistics.UpperIndex[1]; ++y)
+          functor(GetRowOffset(dimensions, y, z, t) + statistics.LowerIndex[0], length);
+      }
+    }
+  }
+}
+
+mitk::Point3D mitk::LabelSetImage::LabelStatistics::GetCentroidIndex() const
+{
+  Point3D centroid;
+  centroid.Fill(0.0);
+  if (NumberOfVoxels > 0)
+  {
+    for (unsigned int i = 0; i < 3; ++i)
+      centroid[i] = IndexSum[i] / NumberOfVoxels;
+  }
+  return centroid;
 }
 
 mitk::LabelSetImage::LabelSetImage()
-  : mitk::Image(), m_ActiveLayer(0), m_activeLayerInvalid(false), m_ExteriorLabel(nullptr)
+  : mitk::Image(),
+    m_SparseLayerStorage(false),
+    m_LabelStatisticsTime(0),
+    m_LabelStatisticsUpdatePending(false),
+    m_LabelHistoryCapturePending(false),
+    m_LastRecordedEdit(0),
+    m_ActiveLayer(0),
+    m_activeLayerInvalid(false),
+    m_ExteriorLabel(nullptr)
 {
   // Iniitlaize Background Label
   mitk::Color color;
@@ -79,6 +290,14 @@ mitk::LabelSetImage::LabelSetImage()
 
 mitk::LabelSetImage::LabelSetImage(const mitk::LabelSetImage &other)
   : Image(other),
+    m_SparseLayerContainer(other.m_SparseLayerContainer),
+    m_SparseLayerStorage(other.m_SparseLayerStorage),
+    m_LabelStatistics(other.m_LabelStatistics),
+    m_LabelStatisticsValid(other.m_LabelStatisticsValid),
+    m_LabelStatisticsTime(0),
+    m_LabelStatisticsUpdatePending(false),
+    m_LabelHistoryCapturePending(false),
+    m_LastRecordedEdit(0),
     m_ActiveLayer(other.GetActiveLayer()),
     m_activeLayerInvalid(false),
     m_ExteriorLabel(other.GetExteriorLabel()->Clone())
@@ -93,8 +312,10 @@ mitk::LabelSetImage::LabelSetImage(const mitk::LabelSetImage &other)
     lsClone->AddObserver(itk::ModifiedEvent(), command);
     m_LabelSetContainer.push_back(lsClone);
 
-    // clone layer Image data
-    mitk::Image::Pointer liClone = other.GetLayerImage(i)->Clone();
+    // clone layer Image data, sparse layers have been copied already
+    mitk::Image::Pointer liClone;
+    if (other.m_LayerContainer[i].IsNotNull())
+      liClone = other.m_LayerContainer[i]->Clone();
     m_LayerContainer.push_back(liClone);
   }
 
@@ -104,7 +325,11 @@ mitk::LabelSetImage::LabelSetImage(const mitk::LabelSetImage &other)
 
 void mitk::LabelSetImage::OnLabelSetModified()
 {
+  // changes of the labels do not affect the pixel data
+  const bool labelStatisticsUpToDate = this->AreLabelStatisticsUpToDate();
   Superclass::Modified();
+  if (labelStatisticsUpToDate)
+    this->LabelStatisticsUpdated();
 }
 
 void mitk::LabelSetImage::SetExteriorLabel(mitk::Label *label)
@@ -162,12 +387,70 @@ mitk::LabelSetImage::~LabelSetImage()
 
 mitk::Image *mitk::LabelSetImage::GetLayerImage(unsigned int layer)
 {
+  if (m_LayerContainer[layer].IsNull())
+  {
+    // decode the sparse layer, the dense image replaces it until it is compressed again
+    mitk::Image::Pointer layerImage = this->CreateLayerImage();
+    m_SparseLayerContainer[layer].Decode(layerImage);
+    m_SparseLayerContainer[layer].Clear();
+    m_LayerContainer[layer] = layerImage;
+  }
   return m_LayerContainer[layer];
 }
 
 const mitk::Image *mitk::LabelSetImage::GetLayerImage(unsigned int layer) const
 {
-  return m_LayerContainer[layer];
+  return const_cast<LabelSetImage *>(this)->GetLayerImage(layer);
+}
+
+void mitk::LabelSetImage::SetSparseLayerStorage(bool sparse)
+{
+  if (sparse == m_SparseLayerStorage)
+    return;
+
+  m_SparseLayerStorage = sparse;
+  if (sparse)
+  {
+    this->CompressLayerImages();
+  }
+  else
+  {
+    for (unsigned int layer = 0; layer < m_LayerContainer.size(); ++layer)
+      this->GetLayerImage(layer);
+  }
+}
+
+bool mitk::LabelSetImage::GetSparseLayerStorage() const
+{
+  return m_SparseLayerStorage;
+}
+
+bool mitk::LabelSetImage::IsLayerSparse(unsigned int layer) const
+{
+  return layer < m_LayerContainer.size() && m_LayerContainer[layer].IsNull();
+}
+
+mitk::Image::Pointer mitk::LabelSetImage::CreateLayerImage() const
+{
+  mitk::Image::Pointer newImage = mitk::Image::New();
+  newImage->Initialize(this->GetPixelType(),
+                       this->GetDimension(),
+                       this->GetDimensions(),
+                       this->GetImageDescriptor()->GetNumberOfChannels());
+  newImage->SetTimeGeometry(this->GetTimeGeometry()->Clone());
+  return newImage;
+}
+
+void mitk::LabelSetImage::CompressLayerImages()
+{
+  for (unsigned int layer = 0; layer < m_LayerContainer.size(); ++layer)
+  {
+    if (m_LayerContainer[layer].IsNotNull())
+    {
+      m_SparseLayerContainer[layer].Encode(m_LayerContainer[layer]);
+      m_LayerContainer[layer] = nullptr;
+    }
+  }
 }
 
 unsigned int mitk::LabelSetImage::GetActiveLayer() const
@@ -200,6 +483,11 @@ void mitk::LabelSetImage::RemoveLayer()
   // remove labelset and image data
   m_LabelSetContainer.erase(m_LabelSetContainer.begin() + layerToDelete);
   m_LayerContainer.erase(m_LayerContainer.begin() + layerToDelete);
+  m_SparseLayerContainer.erase(m_SparseLayerContainer.begin() + layerToDelete);
+  m_LabelStatistics.erase(m_LabelStatistics.begin() + layerToDelete);
+  m_LabelStatisticsValid.erase(m_LabelStatisticsValid.begin() + layerToDelete);
+  if (m_LabelHistory)
+    m_LabelHistory->RemoveLayer(layerToDelete);
 
   if (layerToDelete == 0)
   {
@@ -211,20 +499,20 @@ void mitk::LabelSetImage::RemoveLayer()
 
 unsigned int mitk::LabelSetImage::AddLayer(mitk::LabelSet::Pointer lset)
 {
-  mitk::Image::Pointer newImage = mitk::Image::New();
-  newImage->Initialize(this->GetPixelType(),
-                       this->GetDimension(),
-                       this->GetDimensions(),
-                       this->GetImageDescriptor()->GetNumberOfChannels());
-  newImage->SetTimeGeometry(this->GetTimeGeometry()->Clone());
-
-  if (newImage->GetDimension() < 4)
+  // with sparse layer storage the new, empty layer does not need a dense image
+  mitk::Image::Pointer newImage;
+  if (!m_SparseLayerStorage)
   {
-    AccessByItk(newImage, SetToZero);
-  }
-  else
-  {
-    AccessFixedDimensionByItk(newImage, SetToZero, 4);
+    newImage = this->CreateLayerImage();
+
+    if (newImage->GetDimension() < 4)
+    {
+      AccessByItk(newImage, SetToZero);
+    }
+    else
+    {
+      AccessFixedDimensionByItk(newImage, SetToZero, 4);
+    }
   }
 
   unsigned int newLabelSetId = this->AddLayer(newImage, lset);
@@ -253,8 +541,17 @@ unsigned int mitk::LabelSetImage::AddLayer(mitk::Image::Pointer layerImage, mitk
   // Add exterior Label to label set
   // mitk::Label::Pointer exteriorLabel = CreateExteriorLabel();
 
-  // push a new working image for the new layer
+  // push a new working image for the new layer, an empty sparse layer if no image is provided
   m_LayerContainer.push_back(layerImage);
+  m_SparseLayerContainer.emplace_back();
+  if (layerImage.IsNull())
+  {
+    m_SparseLayerContainer.back().Initialize(this);
+  }
+
+  // the statistics of a new, empty layer are known
+  m_LabelStatistics.emplace_back();
+  m_LabelStatisticsValid.push_back(layerImage.IsNull());
 
   // push a new labelset for the new layer
   m_LabelSetContainer.push_back(ls);
@@ -297,6 +594,14 @@ void mitk::LabelSetImage::AddLabelSetToLayer(const unsigned int layerIdx, const
 
 void mitk::LabelSetImage::SetActiveLayer(unsigned int layer)
 {
+  // the label statistics move with the pixel data of the layers
+  const bool changeLayer = (layer != GetActiveLayer() || m_activeLayerInvalid) && (layer < this->GetNumberOfLayers());
+  const bool labelStatisticsUpToDate = this->AreLabelStatisticsUpToDate();
+  if (changeLayer && !m_activeLayerInvalid)
+  {
+    m_LabelStatisticsValid[GetActiveLayer()] = labelStatisticsUpToDate;
+  }
+
   try
   {
     if (4 == this->GetDimension())
@@ -310,12 +615,30 @@ void mitk::LabelSetImage::SetActiveLayer(unsigned int layer)
           // We should not write the invalid layer back to the vector
           m_activeLayerInvalid = false;
         }
+        else if (m_SparseLayerStorage)
+        {
+          m_SparseLayerContainer[GetActiveLayer()].Encode(this);
+          m_LayerContainer[GetActiveLayer()] = nullptr;
+        }
         else
         {
+          // make sure that there is a dense image to copy the active layer into
+          GetLayerImage(GetActiveLayer());
           AccessFixedDimensionByItk_n(this, ImageToLayerContainerProcessing, 4, (GetActiveLayer()));
         }
         m_ActiveLayer = layer; // only at this place m_ActiveLayer should be manipulated!!! Use Getter and Setter
-        AccessFixedDimensionByItk_n(this, LayerContainerToImageProcessing, 4, (GetActiveLayer()));
+        if (m_LayerContainer[layer].IsNull())
+        {
+          m_SparseLayerContainer[layer].Decode(this);
+        }
+        else
+        {
+          AccessFixedDimensionByItk_n(this, LayerContainerToImageProcessing, 4, (GetActiveLayer()));
+        }
+        if (m_SparseLayerStorage)
+        {
+          this->CompressLayerImages();
+        }
 
         AfterChangeLayerEvent.Send();
       }
@@ -331,12 +654,30 @@ void mitk::LabelSetImage::SetActiveLayer(unsigned int layer)
           // We should not write the invalid layer back to the vector
           m_activeLayerInvalid = false;
         }
+        else if (m_SparseLayerStorage)
+        {
+          m_SparseLayerContainer[GetActiveLayer()].Encode(this);
+          m_LayerContainer[GetActiveLayer()] = nullptr;
+        }
         else
         {
+          // make sure that there is a dense image to copy the active layer into
+          GetLayerImage(GetActiveLayer());
           AccessByItk_1(this, ImageToLayerContainerProcessing, GetActiveLayer());
         }
         m_ActiveLayer = layer; // only at this place m_ActiveLayer should be manipulated!!! Use Getter and Setter
-        AccessByItk_1(this, LayerContainerToImageProcessing, GetActiveLayer());
+        if (m_LayerContainer[layer].IsNull())
+        {
+          m_SparseLayerContainer[layer].Decode(this);
+        }
+        else
+        {
+          AccessByItk_1(this, LayerContainerToImageProcessing, GetActiveLayer());
+        }
+        if (m_SparseLayerStorage)
+        {
+          this->CompressLayerImages();
+        }
 
         AfterChangeLayerEvent.Send();
       }
@@ -347,6 +688,11 @@ void mitk::LabelSetImage::SetActiveLayer(unsigned int layer)
     mitkThrow() << e.GetDescription();
   }
   this->Modified();
+
+  if (changeLayer ? m_LabelStatisticsValid[GetActiveLayer()] : labelStatisticsUpToDate)
+  {
+    this->LabelStatisticsUpdated();
+  }
 }
 
 void mitk::LabelSetImage::Concatenate(mitk::LabelSetImage *other)
@@ -416,33 +762,21 @@ bool mitk::LabelSetImage::ExistLabelSet(unsigned int layer) const
 
 void mitk::LabelSetImage::MergeLabel(PixelType pixelValue, PixelType sourcePixelValue, unsigned int layer)
 {
-  try
-  {
-    AccessByItk_2(this, MergeLabelProcessing, pixelValue, sourcePixelValue);
-  }
-  catch (itk::ExceptionObject &e)
-  {
-    mitkThrow() << e.GetDescription();
-  }
+  this->ReplaceLabel(sourcePixelValue, pixelValue);
   GetLabelSet(layer)->SetActiveLabel(pixelValue);
   Modified();
+  this->LabelStatisticsUpdated();
 }
 
 void mitk::LabelSetImage::MergeLabels(PixelType pixelValue, std::vector<PixelType>& vectorOfSourcePixelValues, unsigned int layer)
 {
-  try
+  for (unsigned int idx = 0; idx < vectorOfSourcePixelValues.size(); idx++)
   {
-    for (unsigned int idx = 0; idx < vectorOfSourcePixelValues.size(); idx++)
-    {
-      AccessByItk_2(this, MergeLabelProcessing, pixelValue, vectorOfSourcePixelValues[idx]);
-    }
-  }
-  catch (itk::ExceptionObject &e)
-  {
-    mitkThrow() << e.GetDescription();
+    this->ReplaceLabel(vectorOfSourcePixelValues[idx], pixelValue);
   }
   GetLabelSet(layer)->SetActiveLabel(pixelValue);
   Modified();
+  this->LabelStatisticsUpdated();
 }
 
 void mitk::LabelSetImage::RemoveLabels(std::vector<PixelType> &VectorOfLabelPixelValues, unsigned int layer)
@@ -462,17 +796,57 @@ void mitk::LabelSetImage::EraseLabels(std::vector<PixelType> &VectorOfLabelPixel
   }
 }
 
-void mitk::LabelSetImage::EraseLabel(PixelType pixelValue, unsigned int layer)
+void mitk::LabelSetImage::EraseLabel(PixelType pixelValue, unsigned int /*layer*/)
 {
-  try
+  this->ReplaceLabel(pixelValue, 0);
+  Modified();
+  this->LabelStatisticsUpdated();
+}
+
+void mitk::LabelSetImage::ReplaceLabel(PixelType sourcePixelValue, PixelType targetPixelValue)
+{
+  LabelStatisticsMapType &statistics = this->GetActiveLayerLabelStatistics();
+  auto source = statistics.find(sourcePixelValue);
+  if (source == statistics.end() || sourcePixelValue == targetPixelValue)
+    return;
+
+  itk::IndexValueType dimensions[4];
+  GetLabelImageDimensions(this, dimensions);
   {
-    AccessByItk_2(this, EraseLabelProcessing, pixelValue, layer);
+    ImageWriteAccessor accessor(this);
+    auto *buffer = static_cast<PixelType *>(accessor.GetData());
+    std::vector<LabelDeltaHistory::Run> runs;
+    const bool recordHistory = m_LabelHistory != nullptr;
+    ForEachRowOfBoundingBox(dimensions, source->second, [&](std::size_t offset, std::size_t length) {
+      if (recordHistory)
+        AppendRunsOfValue(buffer, offset, length, sourcePixelValue, targetPixelValue, runs);
+      std::replace(buffer + offset, buffer + offset + length, sourcePixelValue, targetPixelValue);
+    });
+    if (recordHistory)
+      m_LastRecordedEdit = m_LabelHistory->Record(GetActiveLayer(), std::move(runs));
   }
-  catch (itk::ExceptionObject &e)
+
+  if (targetPixelValue != 0)
   {
-    mitkThrow() << e.GetDescription();
+    auto target = statistics.find(targetPixelValue);
+    if (target == statistics.end())
+    {
+      statistics.emplace(targetPixelValue, source->second);
+    }
+    else
+    {
+      LabelStatistics &targetStatistics = target->second;
+      const LabelStatistics &sourceStatistics = source->second;
+      targetStatistics.NumberOfVoxels += sourceStatistics.NumberOfVoxels;
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        targetStatistics.LowerIndex[i] = std::min(targetStatistics.LowerIndex[i], sourceStatistics.LowerIndex[i]);
+        targetStatistics.UpperIndex[i] = std::max(targetStatistics.UpperIndex[i], sourceStatistics.UpperIndex[i]);
+        targetStatistics.IndexSum[i] += sourceStatistics.IndexSum[i];
+      }
+    }
   }
-  Modified();
+  statistics.erase(source);
 }
 
 mitk::Label *mitk::LabelSetImage::GetActiveLabel(unsigned int layer)
@@ -517,14 +891,287 @@ mitk::LabelSet *mitk::LabelSetImage::GetActiveLabelSet()
 
 void mitk::LabelSetImage::UpdateCenterOfMass(PixelType pixelValue, unsigned int layer)
 {
-  if (4 == this->GetDimension())
+  // the pixel data of the active layer, as before
+  mitk::Point3D pos = this->GetLabelStatistics(pixelValue, GetActiveLayer()).GetCentroidIndex();
+
+  GetLabelSet(layer)->GetLabel(pixelValue)->SetCenterOfMassIndex(pos);
+  this->GetSlicedGeometry()->IndexToWorld(pos, pos); // TODO: TimeGeometry?
+  GetLabelSet(layer)->GetLabel(pixelValue)->SetCenterOfMassCoordinates(pos);
+}
+
+mitk::LabelSetImage::LabelStatistics mitk::LabelSetImage::GetLabelStatistics(PixelType pixelValue,
+                                                                              unsigned int layer)
+{
+  if (layer >= this->GetNumberOfLayers())
+    return LabelStatistics();
+
+  if (layer == GetActiveLayer())
   {
-    AccessFixedDimensionByItk_2(this, CalculateCenterOfMassProcessing, 4, pixelValue, layer);
+    const LabelStatisticsMapType &statistics = this->GetActiveLayerLabelStatistics();
+    auto label = statistics.find(pixelValue);
+    return label != statistics.end() ? label->second : LabelStatistics();
   }
-  else
+
+  if (!m_LabelStatisticsValid[layer])
   {
-    AccessByItk_2(this, CalculateCenterOfMassProcessing, pixelValue, layer);
+    LabelStatisticsMapType statistics;
+    ComputeLabelStatistics(this->GetLayerImage(layer), statistics);
+    auto label = statistics.find(pixelValue);
+    return label != statistics.end() ? label->second : LabelStatistics();
   }
+
+  auto label = m_LabelStatistics[layer].find(pixelValue);
+  return label != m_LabelStatistics[layer].end() ? label->second : LabelStatistics();
+}
+
+void mitk::LabelSetImage::BeginLabelStatisticsUpdate(const RegionType &region)
+{
+  itk::IndexValueType lower[4];
+  itk::IndexValueType upper[4];
+  const bool validRegion = GetRegionBounds(this, region, lower, upper);
+  m_LabelStatisticsUpdatePending = validRegion && this->AreLabelStatisticsUpToDate();
+  m_LabelHistoryCapturePending = validRegion && m_LabelHistory != nullptr;
+  m_LastRecordedEdit = 0;
+  if (!m_LabelStatisticsUpdatePending && !m_LabelHistoryCapturePending)
+    return;
+
+  itk::IndexValueType dimensions[4];
+  GetLabelImageDimensions(this, dimensions);
+
+  ImageReadAccessor accessor(this);
+  const auto *buffer = static_cast<const PixelType *>(accessor.GetData());
+
+  if (m_LabelHistoryCapturePending)
+  {
+    // keep the old values to record the changed pixels when the write is finished
+    m_LabelHistoryRegionValues.clear();
+    ForEachRowOfRegion(dimensions, lower, upper, [&](std::size_t offset, std::size_t length) {
+      m_LabelHistoryRegionValues.insert(m_LabelHistoryRegionValues.end(), buffer + offset, buffer + offset + length);
+    });
+  }
+
+  if (m_LabelStatisticsUpdatePending)
+  {
+    // invalid until the update is finished
+    m_LabelStatisticsValid[GetActiveLayer()] = false;
+    AccumulateLabelStatistics(buffer, dimensions, lower, upper, -1, m_LabelStatistics[GetActiveLayer()]);
+  }
+}
+
+void mitk::LabelSetImage::EndLabelStatisticsUpdate(const RegionType &region)
+{
+  itk::IndexValueType lower[4];
+  itk::IndexValueType upper[4];
+  const bool validRegion = GetRegionBounds(this, region, lower, upper);
+  const bool updateStatistics = m_LabelStatisticsUpdatePending && validRegion;
+  const bool recordHistory = m_LabelHistoryCapturePending && validRegion && m_LabelHistory != nullptr;
+  m_LabelStatisticsUpdatePending = false;
+  m_LabelHistoryCapturePending = false;
+  if (!updateStatistics && !recordHistory)
+    return;
+
+  itk::IndexValueType dimensions[4];
+  GetLabelImageDimensions(this, dimensions);
+
+  {
+    ImageReadAccessor accessor(this);
+    const auto *buffer = static_cast<const PixelType *>(accessor.GetData());
+
+    if (recordHistory)
+    {
+      std::vector<LabelDeltaHistory::Run> runs;
+      std::size_t position = 0;
+      ForEachRowOfRegion(dimensions, lower, upper, [&](std::size_t offset, std::size_t length) {
+        if (position + length <= m_LabelHistoryRegionValues.size())
+          LabelDeltaHistory::AppendChangedRuns(
+            m_LabelHistoryRegionValues.data() + position, buffer + offset, length, offset, runs);
+        position += length;
+      });
+      m_LabelHistoryRegionValues.clear();
+      m_LastRecordedEdit = m_LabelHistory->Record(GetActiveLayer(), std::move(runs));
+    }
+
+    if (updateStatistics)
+      AccumulateLabelStatistics(buffer, dimensions, lower, upper, 1, m_LabelStatistics[GetActiveLayer()]);
+  }
+
+  if (updateStatistics)
+    this->LabelStatisticsUpdated();
+}
+
+void mitk::LabelSetImage::SetLabelHistoryEnabled(bool enabled)
+{
+  if (!enabled)
+  {
+    m_LabelHistory.reset();
+    m_LabelHistoryRegionValues.clear();
+    m_LabelHistoryCapturePending = false;
+    m_LastRecordedEdit = 0;
+  }
+  else if (!m_LabelHistory)
+  {
+    m_LabelHistory.reset(new LabelDeltaHistory);
+  }
+}
+
+bool mitk::LabelSetImage::GetLabelHistoryEnabled() const
+{
+  return m_LabelHistory != nullptr;
+}
+
+mitk::LabelDeltaHistory *mitk::LabelSetImage::GetLabelHistory()
+{
+  return m_LabelHistory.get();
+}
+
+mitk::LabelDeltaHistory::EditId mitk::LabelSetImage::GetLastRecordedEdit() const
+{
+  return m_LastRecordedEdit;
+}
+
+bool mitk::LabelSetImage::UndoLabelChange(PixelType pixelValue, unsigned int layer)
+{
+  if (!m_LabelHistory || layer >= this->GetNumberOfLayers())
+    return false;
+
+  const LabelDeltaHistory::EditId edit = m_LabelHistory->FindLastEdit(layer, pixelValue);
+  if (edit == 0)
+    return false;
+
+  return this->ApplyLabelHistory(layer, true, [&](PixelType *buffer) {
+    return m_LabelHistory->UndoLabel(edit, pixelValue, buffer);
+  });
+}
+
+bool mitk::LabelSetImage::UndoEdit(LabelDeltaHistory::EditId edit)
+{
+  if (!m_LabelHistory || !m_LabelHistory->Contains(edit))
+    return false;
+
+  return this->ApplyLabelHistory(
+    m_LabelHistory->GetLayer(edit), true, [&](PixelType *buffer) { return m_LabelHistory->Undo(edit, buffer); });
+}
+
+bool mitk::LabelSetImage::RedoEdit(LabelDeltaHistory::EditId edit)
+{
+  if (!m_LabelHistory || !m_LabelHistory->Contains(edit))
+    return false;
+
+  return this->ApplyLabelHistory(
+    m_LabelHistory->GetLayer(edit), false, [&](PixelType *buffer) { return m_LabelHistory->Redo(edit, buffer); });
+}
+
+bool mitk::LabelSetImage::ApplyLabelHistory(
+  unsigned int layer, bool undo, const std::function<std::vector<LabelDeltaHistory::Run>(PixelType *)> &change)
+{
+  if (layer >= this->GetNumberOfLayers())
+    return false;
+
+  if (layer != GetActiveLayer())
+  {
+    // the statistics of the inactive layer are computed again on the next request
+    Image *layerImage = this->GetLayerImage(layer);
+    std::vector<LabelDeltaHistory::Run> runs;
+    {
+      ImageWriteAccessor accessor(layerImage);
+      runs = change(static_cast<PixelType *>(accessor.GetData()));
+    }
+    if (runs.empty())
+      return false;
+
+    layerImage->Modified();
+    m_LabelStatisticsValid[layer] = false;
+
+    const bool labelStatisticsUpToDate = this->AreLabelStatisticsUpToDate();
+    this->Modified();
+    if (labelStatisticsUpToDate)
+      this->LabelStatisticsUpdated();
+    return true;
+  }
+
+  const bool labelStatisticsUpToDate = this->AreLabelStatisticsUpToDate();
+  std::vector<LabelDeltaHistory::Run> runs;
+  {
+    ImageWriteAccessor accessor(this);
+    runs = change(static_cast<PixelType *>(accessor.GetData()));
+  }
+  if (runs.empty())
+    return false;
+
+  itk::IndexValueType dimensions[4];
+  GetLabelImageDimensions(this, dimensions);
+
+  // update the statistics by the changed runs and mark their bounding box as modified
+  itk::IndexValueType lower[4] = {dimensions[0], dimensions[1], dimensions[2], dimensions[3]};
+  itk::IndexValueType upper[4] = {-1, -1, -1, -1};
+  LabelStatisticsMapType &statistics = m_LabelStatistics[GetActiveLayer()];
+  for (const auto &run : runs)
+  {
+    itk::IndexValueType index[4];
+    GetRunIndex(dimensions, run, index);
+    const itk::IndexValueType end = index[0] + run.Length;
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+      lower[i] = std::min(lower[i], index[i]);
+      upper[i] = std::max(upper[i], i == 0 ? end - 1 : index[i]);
+    }
+
+    if (labelStatisticsUpToDate)
+    {
+      const PixelType previousValue = undo ? run.NewValue : run.OldValue;
+      const PixelType value = undo ? run.OldValue : run.NewValue;
+      if (previousValue != 0)
+        AccumulateRun(previousValue, index[0], end, index[1], index[2], -1, statistics);
+      if (value != 0)
+        AccumulateRun(value, index[0], end, index[1], index[2], 1, statistics);
+    }
+  }
+
+  RegionType region;
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    region.SetIndex(i, lower[i]);
+    region.SetSize(i, static_cast<RegionType::SizeValueType>(upper[i] - lower[i] + 1));
+  }
+  region.SetIndex(4, 0);
+  region.SetSize(4, 1);
+  this->RegionModified(region);
+
+  if (labelStatisticsUpToDate)
+    this->LabelStatisticsUpdated();
+  return true;
+}
+
+mitk::LabelSetImage::LabelStatisticsMapType &mitk::LabelSetImage::GetActiveLayerLabelStatistics()
+{
+  if (m_LabelStatistics.empty())
+    mitkThrow() << "Label statistics requested for an image without layers.";
+
+  if (!this->AreLabelStatisticsUpToDate())
+  {
+    ComputeLabelStatistics(this, m_LabelStatistics[GetActiveLayer()]);
+    this->LabelStatisticsUpdated();
+  }
+  return m_LabelStatistics[GetActiveLayer()];
+}
+
+bool mitk::LabelSetImage::AreLabelStatisticsUpToDate() const
+{
+  if (m_LabelStatisticsTime == 0 || GetActiveLayer() >= m_LabelStatisticsValid.size() ||
+      !m_LabelStatisticsValid[GetActiveLayer()])
+    return false;
+
+  RegionType region;
+  return this->GetModifiedRegion(m_LabelStatisticsTime, region) && region.GetNumberOfPixels() == 0;
+}
+
+void mitk::LabelSetImage::LabelStatisticsUpdated()
+{
+  if (GetActiveLayer() >= m_LabelStatisticsValid.size())
+    return;
+
+  m_LabelStatisticsValid[GetActiveLayer()] = true;
+  m_LabelStatisticsTime = this->GetMTime();
 }
 
 unsigned int mitk::LabelSetImage::GetNumberOfLabels(unsigned int layer) const
@@ -589,17 +1236,28 @@ mitk::Image::Pointer mitk::LabelSetImage::CreateLabelMask(PixelType index, bool
     if (!useActiveLayer)
       this->SetActiveLayer(layer);
 
-    if (4 == this->GetDimension())
-    {
-      ::CreateLabelMaskProcessing<4>(this, mask, index);
-    }
-    else if (3 == this->GetDimension())
-    {
-      ::CreateLabelMaskProcessing(this, mask, index);
-    }
-    else
-    {
+    if (this->GetDimension() < 3)
       mitkThrow();
+
+    // only the bounding box of the label has to be visited
+    const LabelStatisticsMapType &statistics = this->GetActiveLayerLabelStatistics();
+    auto label = statistics.find(index);
+    if (label != statistics.end())
+    {
+      itk::IndexValueType dimensions[4];
+      GetLabelImageDimensions(this, dimensions);
+
+      ImageReadAccessor readAccessor(this);
+      ImageWriteAccessor writeAccessor(mask);
+      auto src = static_cast<const PixelType *>(readAccessor.GetData());
+      auto dest = static_cast<PixelType *>(writeAccessor.GetData());
+      ForEachRowOfBoundingBox(dimensions, label->second, [=](std::size_t offset, std::size_t length) {
+        for (std::size_t i = offset; i < offset + length; ++i)
+        {
+          if (index == src[i])
+            dest[i] = 1;
+        }
+      });
     }
   }
   catch (...)
@@ -740,48 +1398,6 @@ void mitk::LabelSetImage::MaskStampProcessing(ImageType *itkImage, mitk::Image *
   this->Modified();
 }
 
-template <typename ImageType>
-void mitk::LabelSetImage::CalculateCenterOfMassProcessing(ImageType *itkImage, PixelType pixelValue, unsigned int layer)
-{
-  // for now, we just retrieve the voxel in the middle
-  typedef itk::ImageRegionConstIterator<ImageType> IteratorType;
-  IteratorType iter(itkImage, itkImage->GetLargestPossibleRegion());
-  iter.GoToBegin();
-
-  std::vector<typename ImageType::IndexType> indexVector;
-
-  while (!iter.IsAtEnd())
-  {
-    // TODO fix comparison warning more effective
-    if (iter.Get() == pixelValue)
-    {
-      indexVector.push_back(iter.GetIndex());
-    }
-    ++iter;
-  }
-
-  mitk::Point3D pos;
-  pos.Fill(0.0);
-
-  if (!indexVector.empty())
-  {
-    typename itk::ImageRegionConstIteratorWithIndex<ImageType>::IndexType centerIndex;
-    centerIndex = indexVector.at(indexVector.size() / 2);
-    if (centerIndex.GetIndexDimension() == 3)
-    {
-      pos[0] = centerIndex[0];
-      pos[1] = centerIndex[1];
-      pos[2] = centerIndex[2];
-    }
-    else
-      return;
-  }
-
-  GetLabelSet(layer)->GetLabel(pixelValue)->SetCenterOfMassIndex(pos);
-  this->GetSlicedGeometry()->IndexToWorld(pos, pos); // TODO: TimeGeometry?
-  GetLabelSet(layer)->GetLabel(pixelValue)->SetCenterOfMassCoordinates(pos);
-}
-
 template <typename ImageType>
 void mitk::LabelSetImage::ClearBufferProcessing(ImageType *itkImage)
 {
@@ -869,44 +1485,6 @@ void mitk::LabelSetImage::ImageToLayerContainerProcessing(itk::Image<TPixel, VIm
   }
 }
 
-template <typename ImageType>
-void mitk::LabelSetImage::EraseLabelProcessing(ImageType *itkImage, PixelType pixelValue, unsigned int /*layer*/)
-{
-  typedef itk::ImageRegionIterator<ImageType> IteratorType;
-
-  IteratorType iter(itkImage, itkImage->GetLargestPossibleRegion());
-  iter.GoToBegin();
-
-  while (!iter.IsAtEnd())
-  {
-    PixelType value = iter.Get();
-
-    if (value == pixelValue)
-    {
-      iter.Set(0);
-    }
-    ++iter;
-  }
-}
-
-template <typename ImageType>
-void mitk::LabelSetImage::MergeLabelProcessing(ImageType *itkImage, PixelType pixelValue, PixelType index)
-{
-  typedef itk::ImageRegionIterator<ImageType> IteratorType;
-
-  IteratorType iter(itkImage, itkImage->GetLargestPossibleRegion());
-  iter.GoToBegin();
-
-  while (!iter.IsAtEnd())
-  {
-    if (iter.Get() == index)
-    {
-      iter.Set(pixelValue);
-    }
-    ++iter;
-  }
-}
-
 bool mitk::Equal(const mitk::LabelSetImage &leftHandSide,
                  const mitk::LabelSetImage &rightHandSide,
                  ScalarType eps,
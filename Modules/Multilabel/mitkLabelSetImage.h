@@ -14,10 +14,16 @@ found in the LICENSE file.
 #define __mitkLabelSetImage_H_
 
 #include <mitkImage.h>
+#include <mitkLabelDeltaHistory.h>
 #include <mitkLabelSet.h>
+#include <mitkSparseLabelLayer.h>
 
 #include <MitkMultilabelExports.h>
 
+#include <functional>
+#include <map>
+#include <memory>
+
 namespace mitk
 {
   //##Documentation
@@ -34,6 +40,25 @@ namespace mitk
 
       typedef mitk::Label::PixelType PixelType;
 
+    /**
+     * @brief Voxel count, bounding box and centroid of a label in one layer, see GetLabelStatistics()
+     */
+    struct LabelStatistics
+    {
+      std::size_t NumberOfVoxels = 0;
+      /**
+       * @brief Inclusive bounding box in index coordinates over all time steps. It contains all voxels of the
+       *        label, but may be larger than their extent after voxels of the label were overwritten.
+       */
+      itk::Index<3> LowerIndex;
+      itk::Index<3> UpperIndex;
+      /** @brief Sums of the voxel indices, divided by NumberOfVoxels they give the centroid */
+      double IndexSum[3] = {0.0, 0.0, 0.0};
+
+      Point3D GetCentroidIndex() const;
+    };
+    typedef std::map<PixelType, LabelStatistics> LabelStatisticsMapType;
+
     /**
     * \brief BeforeChangeLayerEvent (e.g. used for GUI integration)
     * As soon as active labelset should be changed, the signal emits.
@@ -185,6 +210,64 @@ namespace mitk
       * \brief  */
     mitk::Image::Pointer CreateLabelMask(PixelType index, bool useActiveLayer = true, unsigned int layer = 0);
 
+    /**
+     * @brief Returns the voxel count, bounding box and centroid of a label, NumberOfVoxels is 0 if the layer
+     *        does not contain the label.
+     *
+     * The statistics of all labels of the active layer are computed by one scan of the layer when they are
+     * requested first. Afterwards they are maintained incrementally by the methods of this class that change
+     * the labels (EraseLabel(), MergeLabel(), ...) and by writes that are enclosed by
+     * BeginLabelStatisticsUpdate() and EndLabelStatisticsUpdate(), so that queries like CreateLabelMask() only
+     * visit the bounding box of the label. Any other modification of the image recomputes them on the next
+     * request. The statistics of inactive layers are computed on each request, unless they were up to date
+     * when the layer was deactivated.
+     */
+    LabelStatistics GetLabelStatistics(PixelType pixelValue, unsigned int layer);
+
+    /**
+     * @brief Call before writing into @a region of the active layer, e.g. a slice. Together with
+     *        EndLabelStatisticsUpdate() the label statistics are updated by scanning @a region only.
+     */
+    void BeginLabelStatisticsUpdate(const RegionType &region);
+
+    /**
+     * @brief Call after writing into @a region of the active layer and after marking it as modified
+     *        (see RegionModified()).
+     */
+    void EndLabelStatisticsUpdate(const RegionType &region);
+
+    /**
+     * @brief Records the changes of the layers in a LabelDeltaHistory, so that they can be undone per edit or
+     *        per label. Off by default, disabling clears the history.
+     *
+     * Each write enclosed by BeginLabelStatisticsUpdate() and EndLabelStatisticsUpdate(), e.g. a stroke of a
+     * segmentation tool, and each EraseLabel() or MergeLabel() is recorded as one edit of the active layer,
+     * see GetLastRecordedEdit(). Only the changed pixels are stored, run-length encoded.
+     */
+    void SetLabelHistoryEnabled(bool enabled);
+    bool GetLabelHistoryEnabled() const;
+
+    /** @brief The history of the label changes, nullptr if it is not enabled. */
+    LabelDeltaHistory *GetLabelHistory();
+
+    /** @brief The edit recorded by the last write or label change, 0 if nothing was recorded. */
+    LabelDeltaHistory::EditId GetLastRecordedEdit() const;
+
+    /**
+     * @brief Undoes the changes of @a pixelValue by its most recent edit in @a layer, leaving the changes of
+     *        other labels by the same edit untouched.
+     * @return false if there is no edit of the label to undo
+     */
+    bool UndoLabelChange(PixelType pixelValue, unsigned int layer);
+
+    /**
+     * @brief Undoes or redoes a recorded edit in its layer, which does not need to be the active one. Pixels
+     *        changed by later edits are kept.
+     * @return false if nothing was changed, e.g. because the history does not contain the edit anymore
+     */
+    bool UndoEdit(LabelDeltaHistory::EditId edit);
+    bool RedoEdit(LabelDeltaHistory::EditId edit);
+
     /**
      * @brief Initialize a new mitk::LabelSetImage by an given image.
      * For all distinct pixel values of the parameter image new labels will
@@ -247,6 +330,22 @@ namespace mitk
 
     const mitk::Image *GetLayerImage(unsigned int layer) const;
 
+    /**
+     * @brief Stores the pixel data of the inactive layers run-length encoded (see mitk::SparseLabelLayer)
+     *        instead of as dense images, so that an inactive layer needs memory proportional to its labeled
+     *        pixels. Off by default.
+     *
+     * GetLayerImage() decodes a sparse layer into a dense image on demand, which is encoded again by the
+     * next SetActiveLayer().
+     */
+    void SetSparseLayerStorage(bool sparse);
+    bool GetSparseLayerStorage() const;
+
+    /**
+     * @brief Returns true if the pixel data of the layer is currently only stored run-length encoded.
+     */
+    bool IsLayerSparse(unsigned int layer) const;
+
     void OnLabelSetModified();
 
     /**
@@ -279,21 +378,12 @@ namespace mitk
     template <typename TPixel, unsigned int VImageDimension>
     void ImageToLayerContainerProcessing(itk::Image<TPixel, VImageDimension> *source, unsigned int layer) const;
 
-    template <typename ImageType>
-    void CalculateCenterOfMassProcessing(ImageType *input, PixelType index, unsigned int layer);
-
     template <typename ImageType>
     void ClearBufferProcessing(ImageType *input);
 
-    template <typename ImageType>
-    void EraseLabelProcessing(ImageType *input, PixelType index, unsigned int layer);
-
     //  template < typename ImageType >
     //  void ReorderLabelProcessing( ImageType* input, int index, int layer);
 
-    template <typename ImageType>
-    void MergeLabelProcessing(ImageType *input, PixelType pixelValue, PixelType index);
-
     template <typename ImageType>
     void ConcatenateProcessing(ImageType *input, mitk::LabelSetImage *other);
 
@@ -303,8 +393,51 @@ namespace mitk
     template <typename LabelSetImageType, typename ImageType>
     void InitializeByLabeledImageProcessing(LabelSetImageType *input, ImageType *other);
 
+    /** \brief Replaces a label in the active layer, visiting only its bounding box, and updates the statistics. */
+    void ReplaceLabel(PixelType sourcePixelValue, PixelType targetPixelValue);
+
+    /** \brief Returns the label statistics of the active layer, rescanning the layer if they are outdated. */
+    LabelStatisticsMapType &GetActiveLayerLabelStatistics();
+
+    /** \brief True if the statistics of the active layer cover all modifications of the image. */
+    bool AreLabelStatisticsUpToDate() const;
+
+    /** \brief Marks the statistics of the active layer as up to date with the current image. */
+    void LabelStatisticsUpdated();
+
+    /** \brief Creates an uninitialized layer image of the geometry of this image. */
+    Image::Pointer CreateLayerImage() const;
+
+    /** \brief Encodes all dense layer images and releases them. For the active layer this only
+        replaces the copy in the layer container, its current pixel data is held by this image. */
+    void CompressLayerImages();
+
+    /** \brief Applies a change of the label history to the pixels of a layer and updates its statistics.
+        @a change is called with the pixel buffer of the layer and returns the changed runs. */
+    bool ApplyLabelHistory(unsigned int layer,
+                           bool undo,
+                           const std::function<std::vector<LabelDeltaHistory::Run>(PixelType *)> &change);
+
     std::vector<LabelSet::Pointer> m_LabelSetContainer;
     std::vector<Image::Pointer> m_LayerContainer;
+    /** \brief Pixel data of the layers whose entry in m_LayerContainer is null */
+    std::vector<SparseLabelLayer> m_SparseLayerContainer;
+
+    bool m_SparseLayerStorage;
+
+    /** \brief Label statistics per layer, valid if the corresponding entry of m_LabelStatisticsValid is true */
+    std::vector<LabelStatisticsMapType> m_LabelStatistics;
+    std::vector<bool> m_LabelStatisticsValid;
+    /** \brief Modification time of the image up to which the statistics of the active layer are valid */
+    itk::ModifiedTimeType m_LabelStatisticsTime;
+    bool m_LabelStatisticsUpdatePending;
+
+    /** \brief Not copied by the copy constructor, the edits belong to the undo stack of this image */
+    std::unique_ptr<LabelDeltaHistory> m_LabelHistory;
+    /** \brief Pixels of the region passed to BeginLabelStatisticsUpdate(), if the history is enabled */
+    std::vector<PixelType> m_LabelHistoryRegionValues;
+    bool m_LabelHistoryCapturePending;
+    LabelDeltaHistory::EditId m_LastRecordedEdit;
 
     int m_ActiveLayer;
 
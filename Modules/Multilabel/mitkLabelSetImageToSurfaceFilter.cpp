@@ -12,6 +12,7 @@ found in the LICENSE file.
 
 #include <mitkLabelSetImageToSurfaceFilter.h>
 
+#include <mitkExceptionMacro.h>
 #include <mitkImageAccessByItk.h>
 #include <mitkImageCast.h>
 
@@ -19,23 +20,97 @@ found in the LICENSE file.
 #include <itkAntiAliasBinaryImageFilter.h>
 #include <itkAutoCropLabelMapFilter.h>
 #include <itkBinaryThresholdImageFilter.h>
+#include <itkExtractImageFilter.h>
+#include <itkImageRegionConstIteratorWithIndex.h>
 #include <itkLabelImageToLabelMapFilter.h>
 #include <itkLabelMap.h>
 #include <itkLabelMapToLabelImageFilter.h>
 #include <itkLabelObject.h>
+#include <itkMultiThreader.h>
 #include <itkNumericTraits.h>
 #include <itkSmoothingRecursiveGaussianImageFilter.h>
 
 // vtk
 #include <vtkCleanPolyData.h>
-#include <vtkImageChangeInformation.h>
+#include <vtkFloatArray.h>
 #include <vtkImageData.h>
 #include <vtkLinearTransform.h>
 #include <vtkMarchingCubes.h>
-#include <vtkSmartPointer.h>
+#include <vtkPointData.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+
+namespace
+{
+  typedef mitk::LabelSetImage::LabelStatistics LabelStatistics;
+
+  // tasks distributed dynamically over the threads of an itk::MultiThreader
+  struct ParallelTasks
+  {
+    std::function<void(std::size_t)> Task;
+    std::size_t NumberOfTasks;
+    std::atomic<std::size_t> NextTask;
+  };
+
+  ITK_THREAD_RETURN_TYPE ExecuteParallelTasks(void *arg)
+  {
+    auto *threadInfo = static_cast<itk::MultiThreader::ThreadInfoStruct *>(arg);
+    auto *tasks = static_cast<ParallelTasks *>(threadInfo->UserData);
+    for (std::size_t task = tasks->NextTask++; task < tasks->NumberOfTasks; task = tasks->NextTask++)
+      tasks->Task(task);
+    return ITK_THREAD_RETURN_VALUE;
+  }
+
+  bool IsEqual(const LabelStatistics &left, const LabelStatistics &right)
+  {
+    return left.NumberOfVoxels == right.NumberOfVoxels && left.LowerIndex == right.LowerIndex &&
+           left.UpperIndex == right.UpperIndex && std::equal(left.IndexSum, left.IndexSum + 3, right.IndexSum);
+  }
+
+  // true if the region (time step 0) intersects the bounding box of the label
+  bool Intersects(const mitk::Image::RegionType &region, const LabelStatistics &statistics)
+  {
+    if (region.GetNumberOfPixels() == 0 || region.GetIndex(3) > 0)
+      return false;
+
+    const mitk::Image::RegionType::IndexType upper = region.GetUpperIndex();
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      if (region.GetIndex(i) > statistics.UpperIndex[i] || upper[i] < statistics.LowerIndex[i])
+        return false;
+    }
+    return true;
+  }
+
+  template <unsigned int VDimension>
+  itk::ImageRegion<VDimension> GetBoundingBoxRegion(const LabelStatistics &statistics)
+  {
+    itk::ImageRegion<VDimension> region;
+    typename itk::ImageRegion<VDimension>::IndexType lower;
+    typename itk::ImageRegion<VDimension>::IndexType upper;
+    for (unsigned int i = 0; i < VDimension; ++i)
+    {
+      lower[i] = i < 3 ? statistics.LowerIndex[i] : 0;
+      upper[i] = i < 3 ? statistics.UpperIndex[i] : 0;
+    }
+    region.SetIndex(lower);
+    region.SetUpperIndex(upper);
+    return region;
+  }
+}
 
 mitk::LabelSetImageToSurfaceFilter::LabelSetImageToSurfaceFilter()
-  : m_GenerateAllLabels(false), m_RequestedLabel(1), m_BackgroundLabel(0), m_UseSmoothing(0), m_Sigma(0.1)
+  : m_GenerateAllLabels(false),
+    m_RequestedLabel(1),
+    m_BackgroundLabel(0),
+    m_UseSmoothing(0),
+    m_Sigma(0.1),
+    m_NumberOfThreads(0),
+    m_CachedUseSmoothing(0),
+    m_CachedSigma(0.0),
+    m_CacheTime(0)
 {
 }
 
@@ -64,6 +139,24 @@ const mitk::Image *mitk::LabelSetImageToSurfaceFilter::GetInput(void)
   return static_cast<const mitk::Image *>(this->ProcessObject::GetInput(0));
 }
 
+mitk::LabelSetImageToSurfaceFilter::LabelType mitk::LabelSetImageToSurfaceFilter::GetLabelOfOutput(
+  unsigned int idx) const
+{
+  auto label = m_IndexToLabels.find(idx);
+  if (label == m_IndexToLabels.end())
+    mitkThrow() << "No label surface at output " << idx << ".";
+
+  return label->second;
+}
+
+void mitk::LabelSetImageToSurfaceFilter::ClearCache()
+{
+  m_SurfaceCache.clear();
+  m_CachedInput = nullptr;
+  m_CachedIndexToWorld = nullptr;
+  m_CacheTime = 0;
+}
+
 void mitk::LabelSetImageToSurfaceFilter::GenerateOutputInformation()
 {
   itkDebugMacro(<< "GenerateOutputInformation()");
@@ -79,15 +172,216 @@ void mitk::LabelSetImageToSurfaceFilter::GenerateData()
   if (!outputSurface)
     return;
 
-  AccessFixedDimensionByItk_1(inputImage, InternalProcessing, 3, outputSurface);
+  if (m_GenerateAllLabels)
+  {
+    AccessFixedDimensionByItk(inputImage, GenerateAllLabelsProcessing, 3);
+  }
+  else
+  {
+    AccessFixedDimensionByItk_1(inputImage, InternalProcessing, 3, outputSurface);
+  }
 }
 
 template <typename TPixel, unsigned int VDimension>
 void mitk::LabelSetImageToSurfaceFilter::InternalProcessing(const itk::Image<TPixel, VDimension> *input,
                                                             mitk::Surface * /*surface*/)
+{
+  vtkSmartPointer<vtkMatrix4x4> indexToWorld = vtkSmartPointer<vtkMatrix4x4>::New();
+  this->GetInput()->GetGeometry()->GetVtkTransform()->GetMatrix(indexToWorld);
+
+  // the statistics of a labelset image restrict the processing to the bounding box of the label
+  itk::ImageRegion<VDimension> region = input->GetLargestPossibleRegion();
+  auto *labelSetImage = dynamic_cast<LabelSetImage *>(const_cast<mitk::Image *>(this->GetInput()));
+  if (labelSetImage != nullptr)
+  {
+    const LabelStatistics statistics =
+      labelSetImage->GetLabelStatistics(m_RequestedLabel, labelSetImage->GetActiveLayer());
+    if (statistics.NumberOfVoxels == 0)
+      throw itk::ExceptionObject(__FILE__, __LINE__, "marching cubes has failed.");
+    region = GetBoundingBoxRegion<VDimension>(statistics);
+  }
+
+  vtkSmartPointer<vtkPolyData> polydata = this->GenerateLabelSurface(input, m_RequestedLabel, region, indexToWorld, 0);
+  if (polydata == nullptr)
+    throw itk::ExceptionObject(__FILE__, __LINE__, "marching cubes has failed.");
+
+  mitk::Surface::Pointer output = this->GetOutput(0);
+  output->SetVtkPolyData(polydata, 0);
+}
+
+template <typename TPixel, unsigned int VDimension>
+void mitk::LabelSetImageToSurfaceFilter::GenerateAllLabelsProcessing(const itk::Image<TPixel, VDimension> *input)
+{
+  const mitk::Image *inputImage = this->GetInput();
+
+  vtkSmartPointer<vtkMatrix4x4> indexToWorld = vtkSmartPointer<vtkMatrix4x4>::New();
+  inputImage->GetGeometry()->GetVtkTransform()->GetMatrix(indexToWorld);
+
+  bool cacheValid = inputImage == m_CachedInput && m_CachedIndexToWorld != nullptr &&
+                    m_UseSmoothing == m_CachedUseSmoothing && m_Sigma == m_CachedSigma;
+  for (int i = 0; cacheValid && i < 4; ++i)
+  {
+    for (int j = 0; j < 4; ++j)
+      cacheValid = cacheValid && indexToWorld->GetElement(i, j) == m_CachedIndexToWorld->GetElement(i, j);
+  }
+  if (!cacheValid)
+    this->ClearCache();
+
+  // the statistics of all labels, maintained by a labelset image or computed by one scan
+  std::map<LabelType, LabelStatistics> labels;
+  auto *labelSetImage = dynamic_cast<LabelSetImage *>(const_cast<mitk::Image *>(inputImage));
+  if (labelSetImage != nullptr)
+  {
+    const LabelSet *labelSet = labelSetImage->GetActiveLabelSet();
+    for (auto label = labelSet->IteratorConstBegin(); label != labelSet->IteratorConstEnd(); ++label)
+    {
+      if (label->first == m_BackgroundLabel)
+        continue;
+
+      const LabelStatistics statistics =
+        labelSetImage->GetLabelStatistics(label->first, labelSetImage->GetActiveLayer());
+      if (statistics.NumberOfVoxels > 0)
+        labels[label->first] = statistics;
+    }
+  }
+  else
+  {
+    typedef itk::Image<TPixel, VDimension> ImageType;
+    itk::ImageRegionConstIteratorWithIndex<ImageType> iter(input, input->GetLargestPossibleRegion());
+    for (iter.GoToBegin(); !iter.IsAtEnd(); ++iter)
+    {
+      const auto label = static_cast<LabelType>(iter.Get());
+      if (label == m_BackgroundLabel)
+        continue;
+
+      const typename ImageType::IndexType &index = iter.GetIndex();
+      LabelStatistics &statistics = labels[label];
+      const bool first = statistics.NumberOfVoxels == 0;
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        statistics.LowerIndex[i] = first ? index[i] : std::min(statistics.LowerIndex[i], index[i]);
+        statistics.UpperIndex[i] = first ? index[i] : std::max(statistics.UpperIndex[i], index[i]);
+        statistics.IndexSum[i] += index[i];
+      }
+      ++statistics.NumberOfVoxels;
+    }
+  }
+
+  // regenerate the labels that were modified since the last update
+  mitk::Image::RegionType modifiedRegion;
+  const bool modifiedRegionKnown =
+    !m_SurfaceCache.empty() && inputImage->GetModifiedRegion(m_CacheTime, modifiedRegion);
+
+  std::vector<LabelType> modifiedLabels;
+  for (const auto &label : labels)
+  {
+    auto cached = m_SurfaceCache.find(label.first);
+    if (cached == m_SurfaceCache.end() || !IsEqual(cached->second.Statistics, label.second) ||
+        (modifiedRegionKnown && Intersects(modifiedRegion, label.second)))
+      modifiedLabels.push_back(label.first);
+  }
+
+  std::vector<vtkSmartPointer<vtkPolyData>> surfaces(modifiedLabels.size());
+  unsigned int numberOfThreads =
+    m_NumberOfThreads > 0 ? m_NumberOfThreads : itk::MultiThreader::GetGlobalDefaultNumberOfThreads();
+  numberOfThreads = static_cast<unsigned int>(std::max<std::size_t>(
+    1, std::min<std::size_t>(std::min(numberOfThreads, itk::MultiThreader::GetGlobalMaximumNumberOfThreads()),
+                             modifiedLabels.size())));
+
+  // with one task per thread the filters of each task run single-threaded
+  const int filterThreads = numberOfThreads > 1 ? 1 : 0;
+
+  ParallelTasks tasks;
+  tasks.NumberOfTasks = modifiedLabels.size();
+  tasks.NextTask = 0;
+  tasks.Task = [&](std::size_t task) {
+    const LabelType label = modifiedLabels[task];
+    try
+    {
+      surfaces[task] = this->GenerateLabelSurface(
+        input, label, GetBoundingBoxRegion<VDimension>(labels.at(label)), indexToWorld, filterThreads);
+    }
+    catch (const itk::ExceptionObject &e)
+    {
+      MITK_WARN << "Could not generate the surface of label " << label << ": " << e.GetDescription();
+    }
+    catch (const std::exception &e)
+    {
+      MITK_WARN << "Could not generate the surface of label " << label << ": " << e.what();
+    }
+  };
+
+  if (numberOfThreads > 1)
+  {
+    itk::MultiThreader::Pointer threader = itk::MultiThreader::New();
+    threader->SetNumberOfThreads(numberOfThreads);
+    threader->SetSingleMethod(ExecuteParallelTasks, &tasks);
+    threader->SingleMethodExecute();
+  }
+  else
+  {
+    for (std::size_t task = 0; task < tasks.NumberOfTasks; ++task)
+      tasks.Task(task);
+  }
+
+  // update the cache, labels without voxels or surface are removed
+  for (std::size_t task = 0; task < modifiedLabels.size(); ++task)
+  {
+    if (surfaces[task] == nullptr)
+    {
+      m_SurfaceCache.erase(modifiedLabels[task]);
+    }
+    else
+    {
+      CachedSurface &cached = m_SurfaceCache[modifiedLabels[task]];
+      cached.PolyData = surfaces[task];
+      cached.Statistics = labels[modifiedLabels[task]];
+    }
+  }
+  for (auto cached = m_SurfaceCache.begin(); cached != m_SurfaceCache.end();)
+  {
+    if (labels.find(cached->first) == labels.end())
+      cached = m_SurfaceCache.erase(cached);
+    else
+      ++cached;
+  }
+
+  m_CachedInput = inputImage;
+  m_CachedIndexToWorld = indexToWorld;
+  m_CachedUseSmoothing = m_UseSmoothing;
+  m_CachedSigma = m_Sigma;
+  m_CacheTime = inputImage->GetMTime();
+
+  // one output per label, each sharing the data arrays of the cached surface
+  m_IndexToLabels.clear();
+  this->SetNumberOfIndexedOutputs(std::max<std::size_t>(1, m_SurfaceCache.size()));
+  unsigned int idx = 0;
+  for (const auto &cached : m_SurfaceCache)
+  {
+    if (this->GetOutput(idx) == nullptr)
+      this->SetNthOutput(idx, this->MakeOutput(idx));
+
+    vtkSmartPointer<vtkPolyData> polydata = vtkSmartPointer<vtkPolyData>::New();
+    polydata->ShallowCopy(cached.second.PolyData);
+    this->GetOutput(idx)->SetVtkPolyData(polydata, 0);
+    m_IndexToLabels[idx] = cached.first;
+    ++idx;
+  }
+  if (m_SurfaceCache.empty())
+    this->GetOutput(0)->SetVtkPolyData(vtkSmartPointer<vtkPolyData>::New(), 0);
+}
+
+template <typename TPixel, unsigned int VDimension>
+vtkSmartPointer<vtkPolyData> mitk::LabelSetImageToSurfaceFilter::GenerateLabelSurface(
+  const itk::Image<TPixel, VDimension> *input,
+  LabelType label,
+  const itk::ImageRegion<VDimension> &region,
+  vtkMatrix4x4 *indexToWorld,
+  int numberOfThreads)
 {
   typedef itk::Image<TPixel, VDimension> ImageType;
 
+  typedef itk::ExtractImageFilter<ImageType, ImageType> ExtractFilterType;
   typedef itk::BinaryThresholdImageFilter<ImageType, ImageType> BinaryThresholdFilterType;
   typedef itk::LabelObject<TPixel, VDimension> LabelObjectType;
   typedef itk::LabelMap<LabelObjectType> LabelMapType;
@@ -100,14 +394,19 @@ void mitk::LabelSetImageToSurfaceFilter::InternalProcessing(const itk::Image<TPi
   typedef itk::AntiAliasBinaryImageFilter<ImageType, RealImageType> AntiAliasFilterType;
   typedef itk::SmoothingRecursiveGaussianImageFilter<RealImageType, RealImageType> GaussianFilterType;
 
+  // the extracted region keeps the index of the input
+  typename ExtractFilterType::Pointer extractFilter = ExtractFilterType::New();
+  extractFilter->SetInput(input);
+  extractFilter->SetExtractionRegion(region);
+  extractFilter->SetDirectionCollapseToSubmatrix();
+
   typename BinaryThresholdFilterType::Pointer thresholdFilter = BinaryThresholdFilterType::New();
-  thresholdFilter->SetInput(input);
-  thresholdFilter->SetLowerThreshold(m_RequestedLabel);
-  thresholdFilter->SetUpperThreshold(m_RequestedLabel);
+  thresholdFilter->SetInput(extractFilter->GetOutput());
+  thresholdFilter->SetLowerThreshold(label);
+  thresholdFilter->SetUpperThreshold(label);
   thresholdFilter->SetOutsideValue(0);
   thresholdFilter->SetInsideValue(1);
   //  thresholdFilter->ReleaseDataFlagOn();
-  thresholdFilter->Update();
 
   typename Image2LabelMapType::Pointer image2label = Image2LabelMapType::New();
   image2label->SetInput(thresholdFilter->GetOutput());
@@ -125,8 +424,6 @@ void mitk::LabelSetImageToSurfaceFilter::InternalProcessing(const itk::Image<TPi
   typename LabelMap2ImageType::Pointer label2image = LabelMap2ImageType::New();
   label2image->SetInput(autoCropFilter->GetOutput());
 
-  label2image->Update();
-
   typename AntiAliasFilterType::Pointer antiAliasFilter = AntiAliasFilterType::New();
   antiAliasFilter->SetInput(label2image->GetOutput());
   antiAliasFilter->SetMaximumRMSError(0.001);
@@ -134,15 +431,28 @@ void mitk::LabelSetImageToSurfaceFilter::InternalProcessing(const itk::Image<TPi
   antiAliasFilter->SetUseImageSpacing(false);
   antiAliasFilter->SetNumberOfIterations(40);
 
+  typename GaussianFilterType::Pointer gaussianFilter = GaussianFilterType::New();
+  gaussianFilter->SetSigma(m_Sigma);
+  gaussianFilter->SetInput(antiAliasFilter->GetOutput());
+
+  if (numberOfThreads > 0)
+  {
+    extractFilter->SetNumberOfThreads(numberOfThreads);
+    thresholdFilter->SetNumberOfThreads(numberOfThreads);
+    image2label->SetNumberOfThreads(numberOfThreads);
+    label2image->SetNumberOfThreads(numberOfThreads);
+    antiAliasFilter->SetNumberOfThreads(numberOfThreads);
+    gaussianFilter->SetNumberOfThreads(numberOfThreads);
+  }
+
+  thresholdFilter->Update();
+  label2image->Update();
   antiAliasFilter->Update();
 
   typename RealImageType::Pointer result;
 
   if (m_UseSmoothing)
   {
-    typename GaussianFilterType::Pointer gaussianFilter = GaussianFilterType::New();
-    gaussianFilter->SetSigma(m_Sigma);
-    gaussianFilter->SetInput(antiAliasFilter->GetOutput());
     gaussianFilter->Update();
     result = gaussianFilter->GetOutput();
   }
@@ -158,27 +468,22 @@ void mitk::LabelSetImageToSurfaceFilter::InternalProcessing(const itk::Image<TPi
 
   const typename ImageType::IndexType &cropIndex = cropRegion.GetIndex();
 
-  m_ResultImage = mitk::Image::New();
-  mitk::CastToMitkImage(result, m_ResultImage);
+  // marching cubes in index coordinates of the cropped image, the points are transformed afterwards
+  const typename RealImageType::SizeType &size = result->GetBufferedRegion().GetSize();
+  vtkSmartPointer<vtkFloatArray> scalars = vtkSmartPointer<vtkFloatArray>::New();
+  scalars->SetArray(result->GetBufferPointer(), result->GetBufferedRegion().GetNumberOfPixels(), 1);
 
-  mitk::BaseGeometry *newGeometry = m_ResultImage->GetSlicedGeometry();
-  mitk::Point3D origin;
-  vtk2itk(cropIndex, origin);
-  this->GetInput()->GetGeometry()->IndexToWorld(origin, origin);
-  newGeometry->SetOrigin(origin);
-
-  auto *vtkimage = m_ResultImage->GetVtkImageData(0);
-
-  vtkSmartPointer<vtkImageChangeInformation> indexCoordinatesImageFilter =
-    vtkSmartPointer<vtkImageChangeInformation>::New();
-  indexCoordinatesImageFilter->SetInputData(vtkimage);
-  indexCoordinatesImageFilter->SetOutputOrigin(0.0, 0.0, 0.0);
+  vtkSmartPointer<vtkImageData> vtkimage = vtkSmartPointer<vtkImageData>::New();
+  vtkimage->SetDimensions(size[0], size[1], size[2]);
+  vtkimage->SetOrigin(0.0, 0.0, 0.0);
+  vtkimage->SetSpacing(1.0, 1.0, 1.0);
+  vtkimage->GetPointData()->SetScalars(scalars);
 
   vtkSmartPointer<vtkMarchingCubes> marching = vtkSmartPointer<vtkMarchingCubes>::New();
   marching->ComputeScalarsOff();
   marching->ComputeNormalsOn();
   marching->ComputeGradientsOn();
-  marching->SetInputConnection(indexCoordinatesImageFilter->GetOutputPort());
+  marching->SetInputData(vtkimage);
   marching->SetValue(0, 0.0);
 
   marching->Update();
@@ -186,29 +491,20 @@ void mitk::LabelSetImageToSurfaceFilter::InternalProcessing(const itk::Image<TPi
   vtkPolyData *polydata = marching->GetOutput();
 
   if ((!polydata) || (!polydata->GetNumberOfPoints()))
-    throw itk::ExceptionObject(__FILE__, __LINE__, "marching cubes has failed.");
-
-  mitk::Vector3D spacing = newGeometry->GetSpacing();
+    return nullptr;
 
   vtkPoints *points = polydata->GetPoints();
-  vtkMatrix4x4 *vtkmatrix = vtkMatrix4x4::New();
-  newGeometry->GetVtkTransform()->GetMatrix(vtkmatrix);
-  double(*matrix)[4] = vtkmatrix->Element;
-
-  for (int i = 0; i < 3; ++i)
-    for (int j = 0; j < 3; ++j)
-      matrix[i][j] /= spacing[j];
-
   unsigned int n = points->GetNumberOfPoints();
   double point[3];
 
   for (unsigned int i = 0; i < n; i++)
   {
     points->GetPoint(i, point);
-    mitkVtkLinearTransformPoint(matrix, point, point);
+    for (unsigned int j = 0; j < 3; ++j)
+      point[j] += cropIndex[j];
+    mitkVtkLinearTransformPoint(indexToWorld->Element, point, point);
     points->SetPoint(i, point);
   }
-  vtkmatrix->Delete();
 
   vtkSmartPointer<vtkCleanPolyData> cleanPolyDataFilter = vtkSmartPointer<vtkCleanPolyData>::New();
   cleanPolyDataFilter->SetInputData(polydata);
@@ -219,6 +515,5 @@ void mitk::LabelSetImageToSurfaceFilter::InternalProcessing(const itk::Image<TPi
   cleanPolyDataFilter->PointMergingOn();
   cleanPolyDataFilter->Update();
 
-  mitk::Surface::Pointer output = this->GetOutput(0);
-  output->SetVtkPolyData(cleanPolyDataFilter->GetOutput(), 0);
+  return cleanPolyDataFilter->GetOutput();
 }
@@ -19,6 +19,8 @@ found in the LICENSE file.
 #include <mitkSurfaceSource.h>
 
 #include <vtkMatrix4x4.h>
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
 
 #include <itkImage.h>
 
@@ -30,6 +32,13 @@ namespace mitk
    * Generates surface meshes from a labelset image.
    * If you want to calculate a surface representation for all available labels,
    * you may call GenerateAllLabelsOn().
+   *
+   * With GenerateAllLabelsOn() the filter provides one output per label, see GetLabelOfOutput().
+   * The surfaces are generated in parallel, one task per label, each from the bounding box of
+   * its label only (see LabelSetImage::GetLabelStatistics()). They are cached per label:
+   * a following update regenerates only the labels whose voxels changed, as far as the voxel
+   * count, bounding box and centroid of the label or the modified regions of the image (see
+   * Image::GetModifiedRegion()) tell. A new input, geometry or smoothing setting discards the cache.
    */
   class MITKMULTILABEL_EXPORT LabelSetImageToSurfaceFilter : public SurfaceSource
   {
@@ -105,6 +114,23 @@ namespace mitk
      */
     itkSetMacro(Sigma, float);
 
+    /**
+     * Sets the maximum number of labels processed in parallel if all labels are generated,
+     * 0 (default) uses the global default number of threads of ITK.
+     */
+    itkSetMacro(NumberOfThreads, unsigned int);
+    itkGetMacro(NumberOfThreads, unsigned int);
+
+    /**
+     * Returns the label of the surface at output @a idx if all labels are generated.
+     */
+    LabelType GetLabelOfOutput(unsigned int idx) const;
+
+    /**
+     * Discards the cached surfaces of all labels.
+     */
+    void ClearCache();
+
   protected:
     LabelSetImageToSurfaceFilter();
 
@@ -124,11 +150,30 @@ namespace mitk
       out[2] = z;
     }
 
-    mitk::Image::Pointer m_ResultImage;
-
     template <typename TPixel, unsigned int VImageDimension>
     void InternalProcessing(const itk::Image<TPixel, VImageDimension> *input, mitk::Surface *surface);
 
+    template <typename TPixel, unsigned int VImageDimension>
+    void GenerateAllLabelsProcessing(const itk::Image<TPixel, VImageDimension> *input);
+
+    /**
+    * Generates the surface of @a label from @a region of @a input, returns nullptr if it is empty
+    */
+    template <typename TPixel, unsigned int VImageDimension>
+    vtkSmartPointer<vtkPolyData> GenerateLabelSurface(const itk::Image<TPixel, VImageDimension> *input,
+                                                      LabelType label,
+                                                      const itk::ImageRegion<VImageDimension> &region,
+                                                      vtkMatrix4x4 *indexToWorld,
+                                                      int numberOfThreads);
+
+    struct CachedSurface
+    {
+      vtkSmartPointer<vtkPolyData> PolyData;
+      LabelSetImage::LabelStatistics Statistics;
+    };
+
+    typedef std::map<LabelType, CachedSurface> SurfaceCacheType;
+
     bool m_GenerateAllLabels;
 
     int m_RequestedLabel;
@@ -145,6 +190,17 @@ namespace mitk
 
     mitk::Vector3D m_InputImageSpacing;
 
+    unsigned int m_NumberOfThreads;
+
+    SurfaceCacheType m_SurfaceCache;
+
+    /** Input, geometry, parameters and modification time the cached surfaces were generated for */
+    mitk::Image::ConstPointer m_CachedInput;
+    vtkSmartPointer<vtkMatrix4x4> m_CachedIndexToWorld;
+    int m_CachedUseSmoothing;
+    float m_CachedSigma;
+    itk::ModifiedTimeType m_CacheTime;
+
     void GenerateData() override;
 
     void GenerateOutputInformation() override;
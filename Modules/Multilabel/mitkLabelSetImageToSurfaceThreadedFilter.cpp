@@ -13,11 +13,14 @@ found in the LICENSE file.
 #include "mitkLabelSetImageToSurfaceThreadedFilter.h"
 
 #include "mitkLabelSetImage.h"
-#include "mitkLabelSetImageToSurfaceFilter.h"
+
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
 
 namespace mitk
 {
-  LabelSetImageToSurfaceThreadedFilter::LabelSetImageToSurfaceThreadedFilter() : m_RequestedLabel(1), m_Result(nullptr)
+  LabelSetImageToSurfaceThreadedFilter::LabelSetImageToSurfaceThreadedFilter()
+    : m_RequestedLabel(1), m_GenerateAllLabels(false), m_Result(nullptr)
   {
   }
 
@@ -70,15 +73,28 @@ namespace mitk
       MITK_WARN << "\"RequestedLabel\" parameter was not set: will use the default value (" << m_RequestedLabel << ").";
     }
 
-    mitk::LabelSetImageToSurfaceFilter::Pointer filter = mitk::LabelSetImageToSurfaceFilter::New();
+    try
+    {
+      this->GetParameter("GenerateAllLabels", m_GenerateAllLabels);
+    }
+    catch (std::invalid_argument &)
+    {
+      m_GenerateAllLabels = false;
+    }
+
+    if (m_Filter.IsNull())
+      m_Filter = mitk::LabelSetImageToSurfaceFilter::New();
+
+    mitk::LabelSetImageToSurfaceFilter::Pointer filter = m_Filter;
     filter->SetInput(image);
     //  filter->SetObserver(obsv);
-    filter->SetGenerateAllLabels(false);
+    filter->SetGenerateAllLabels(m_GenerateAllLabels);
     filter->SetRequestedLabel(m_RequestedLabel);
     filter->SetUseSmoothing(useSmoothing);
 
     try
     {
+      filter->Modified();
       filter->Update();
     }
     catch (itk::ExceptionObject &e)
@@ -97,6 +113,25 @@ namespace mitk
       return false;
     }
 
+    if (m_GenerateAllLabels)
+    {
+      // the outputs stay connected to the filter, the results share their data arrays
+      m_LabelResults.clear();
+      for (unsigned int idx = 0; idx < filter->GetNumberOfOutputs(); ++idx)
+      {
+        vtkPolyData *polydata = filter->GetOutput(idx)->GetVtkPolyData();
+        if (polydata == nullptr || polydata->GetNumberOfPoints() == 0)
+          continue;
+
+        vtkSmartPointer<vtkPolyData> copy = vtkSmartPointer<vtkPolyData>::New();
+        copy->ShallowCopy(polydata);
+        Surface::Pointer surface = Surface::New();
+        surface->SetVtkPolyData(copy);
+        m_LabelResults.emplace_back(filter->GetLabelOfOutput(idx), surface);
+      }
+      return !m_LabelResults.empty();
+    }
+
     m_Result = filter->GetOutput();
 
     if (m_Result.IsNull() || !m_Result->GetVtkPolyData())
@@ -112,6 +147,29 @@ namespace mitk
     LabelSetImage::Pointer image;
     this->GetPointerParameter("Input", image);
 
+    if (m_GenerateAllLabels)
+    {
+      for (const auto &result : m_LabelResults)
+      {
+        const mitk::Label *label = image->GetLabel(result.first, image->GetActiveLayer());
+        std::string name = this->GetGroupNode()->GetName() + "-surf";
+        if (label != nullptr)
+          name.append("-" + label->GetName());
+
+        mitk::DataNode::Pointer node = mitk::DataNode::New();
+        node->SetData(result.second);
+        node->SetName(name);
+        if (label != nullptr)
+          node->SetColor(label->GetColor());
+
+        this->InsertBelowGroupNode(node);
+      }
+      m_LabelResults.clear();
+
+      Superclass::ThreadedUpdateSuccessful();
+      return;
+    }
+
     std::string name = this->GetGroupNode()->GetName();
     name.append("-surf");
 
@@ -13,12 +13,21 @@ found in the LICENSE file.
 #ifndef __mitkLabelSetImageToSurfaceThreadedFilter_H_
 #define __mitkLabelSetImageToSurfaceThreadedFilter_H_
 
+#include "mitkLabelSetImageToSurfaceFilter.h"
 #include "mitkSegmentationSink.h"
 #include "mitkSurface.h"
 #include <MitkMultilabelExports.h>
 
+#include <utility>
+#include <vector>
+
 namespace mitk
 {
+  /**
+   * Generates the surface of the label "RequestedLabel" or, if the parameter "GenerateAllLabels" is true,
+   * the surfaces of all labels of the active layer. The latter reuses the surfaces of unchanged labels
+   * generated by previous runs of the same instance.
+   */
   class MITKMULTILABEL_EXPORT LabelSetImageToSurfaceThreadedFilter : public SegmentationSink
   {
   public:
@@ -38,7 +47,12 @@ namespace mitk
 
   private:
     int m_RequestedLabel;
+    bool m_GenerateAllLabels;
     Surface::Pointer m_Result;
+    std::vector<std::pair<LabelSetImage::PixelType, Surface::Pointer>> m_LabelResults;
+
+    /** Kept between runs to reuse its cached label surfaces */
+    LabelSetImageToSurfaceFilter::Pointer m_Filter;
   };
 
 } // namespace
@@ -0,0 +1,105 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkSparseLabelLayer.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkImage.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+  std::size_t GetNumberOfPixels(const mitk::Image *image)
+  {
+    if (image->GetPixelType() != mitk::MakeScalarPixelType<mitk::SparseLabelLayer::PixelType>())
+      mitkThrow() << "Sparse label layers require images of pixel type Label::PixelType.";
+
+    std::size_t numberOfPixels = 1;
+    for (unsigned int i = 0; i < image->GetDimension(); ++i)
+      numberOfPixels *= image->GetDimension(i);
+    return numberOfPixels;
+  }
+}
+
+mitk::SparseLabelLayer::SparseLabelLayer() : m_NumberOfPixels(0)
+{
+}
+
+void mitk::SparseLabelLayer::Initialize(const Image *image)
+{
+  const std::size_t numberOfPixels = ::GetNumberOfPixels(image);
+  this->Clear();
+  m_NumberOfPixels = numberOfPixels;
+}
+
+void mitk::SparseLabelLayer::Encode(const PixelType *buffer, std::size_t numberOfPixels)
+{
+  m_Runs.clear();
+  m_NumberOfPixels = numberOfPixels;
+
+  const std::size_t maximumLength = std::numeric_limits<std::uint32_t>::max();
+  const PixelType *end = buffer + numberOfPixels;
+  const PixelType *pixel = buffer;
+  while (pixel != end)
+  {
+    pixel = std::find_if(pixel, end, [](PixelType value) { return value != 0; });
+    if (pixel == end)
+      break;
+
+    const PixelType value = *pixel;
+    const PixelType *runEnd = std::find_if(pixel, end, [value](PixelType other) { return other != value; });
+    while (pixel != runEnd)
+    {
+      const std::size_t length = std::min(static_cast<std::size_t>(runEnd - pixel), maximumLength);
+      m_Runs.push_back({static_cast<std::uint64_t>(pixel - buffer), static_cast<std::uint32_t>(length), value});
+      pixel += length;
+    }
+  }
+  m_Runs.shrink_to_fit();
+}
+
+void mitk::SparseLabelLayer::Encode(const Image *image)
+{
+  const std::size_t numberOfPixels = ::GetNumberOfPixels(image);
+  ImageReadAccessor accessor(image);
+  this->Encode(static_cast<const PixelType *>(accessor.GetData()), numberOfPixels);
+}
+
+void mitk::SparseLabelLayer::Decode(PixelType *buffer) const
+{
+  PixelType *pixel = buffer;
+  for (const Run &run : m_Runs)
+  {
+    pixel = std::fill_n(pixel, buffer + run.Offset - pixel, PixelType(0));
+    pixel = std::fill_n(pixel, run.Length, run.Value);
+  }
+  std::fill(pixel, buffer + m_NumberOfPixels, PixelType(0));
+}
+
+void mitk::SparseLabelLayer::Decode(Image *image) const
+{
+  if (::GetNumberOfPixels(image) != m_NumberOfPixels)
+    mitkThrow() << "Image size does not match the size of the sparse label layer.";
+
+  ImageWriteAccessor accessor(image);
+  this->Decode(static_cast<PixelType *>(accessor.GetData()));
+}
+
+void mitk::SparseLabelLayer::Clear()
+{
+  std::vector<Run>().swap(m_Runs);
+  m_NumberOfPixels = 0;
+}
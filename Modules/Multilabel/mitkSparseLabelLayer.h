@@ -0,0 +1,78 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkSparseLabelLayer_h
+#define mitkSparseLabelLayer_h
+
+#include <mitkLabel.h>
+
+#include <MitkMultilabelExports.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace mitk
+{
+  class Image;
+
+  /**
+    \brief Run-length encoded pixel data of one layer of a LabelSetImage.
+
+    Only runs of equal, non-exterior (non-zero) pixels are stored, so the memory needed is proportional
+    to the number of labeled pixel runs instead of to the size of the image. LabelSetImage uses it for
+    the inactive layers, see LabelSetImage::SetSparseLayerStorage(). Encode() and Decode() work on the
+    complete pixel buffer of an image of pixel type Label::PixelType, including all time steps.
+    */
+  class MITKMULTILABEL_EXPORT SparseLabelLayer
+  {
+  public:
+    typedef Label::PixelType PixelType;
+
+    struct Run
+    {
+      /** \brief Offset of the first pixel of the run in the pixel buffer */
+      std::uint64_t Offset;
+      std::uint32_t Length;
+      PixelType Value;
+    };
+
+    SparseLabelLayer();
+
+    /** \brief Initializes an empty layer (all pixels exterior) of the size of @a image. */
+    void Initialize(const Image *image);
+
+    /** \brief Encodes a pixel buffer of @a numberOfPixels pixels. */
+    void Encode(const PixelType *buffer, std::size_t numberOfPixels);
+    /** \brief Encodes the pixel data of @a image. Throws if the pixel type is not Label::PixelType. */
+    void Encode(const Image *image);
+
+    /** \brief Writes the layer into a buffer of GetNumberOfPixels() pixels, unlabeled pixels are set to 0. */
+    void Decode(PixelType *buffer) const;
+    /** \brief Writes the layer into the pixel data of @a image, which must have the size of the encoded image. */
+    void Decode(Image *image) const;
+
+    void Clear();
+
+    std::size_t GetNumberOfPixels() const { return m_NumberOfPixels; }
+    std::size_t GetNumberOfRuns() const { return m_Runs.size(); }
+    const std::vector<Run> &GetRuns() const { return m_Runs; }
+
+    /** \brief Memory used by the runs in bytes. */
+    std::size_t GetMemorySize() const { return m_Runs.capacity() * sizeof(Run); }
+
+  private:
+    std::vector<Run> m_Runs;
+    std::size_t m_NumberOfPixels;
+  };
+}
+
+#endif
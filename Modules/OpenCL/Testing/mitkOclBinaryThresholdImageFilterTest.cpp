@@ -29,6 +29,7 @@ class mitkOclBinaryThresholdImageFilterTestSuite : public mitk::TestFixture
   CPPUNIT_TEST_SUITE(mitkOclBinaryThresholdImageFilterTestSuite);
   MITK_TEST(SetInput_2DImage_ThrowsException);
   MITK_TEST(GenerateData_3DImage_CompareToReference);
+  MITK_TEST(GenerateData_ChainedOnGPU_CompareToReference);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -130,6 +131,67 @@ public:
     }
 
   }
+  void GenerateData_ChainedOnGPU_CompareToReference()
+  {
+    us::ServiceReference<OclResourceService> ref = GetModuleContext()->GetServiceReference<OclResourceService>();
+    OclResourceService* resources = GetModuleContext()->GetService<OclResourceService>(ref);
+    resources->GetContext();
+    if(resources->GetMaximumImageSize(2, CL_MEM_OBJECT_IMAGE3D) == 0)
+    {
+      //GPU device does not support 3D images. Skip this test.
+      MITK_INFO << "Skipping test.";
+      return;
+    }
+
+    try{
+      // the second filter inverts the result of the first one, the intermediate image stays on the GPU
+      m_oclBinaryFilter->SetInput( m_Random3DImage );
+      m_oclBinaryFilter->SetLowerThreshold( 60 );
+      m_oclBinaryFilter->SetUpperThreshold( 255 );
+      m_oclBinaryFilter->SetOutsideValue( 0 );
+      m_oclBinaryFilter->SetInsideValue( 100 );
+      m_oclBinaryFilter->SetProfilingEnabled( true );
+      m_oclBinaryFilter->Update();
+
+      mitk::OclBinaryThresholdImageFilter::Pointer secondFilter = mitk::OclBinaryThresholdImageFilter::New();
+      secondFilter->SetInput( m_oclBinaryFilter->GetGPUOutput() );
+      secondFilter->SetLowerThreshold( 0 );
+      secondFilter->SetUpperThreshold( 50 );
+      secondFilter->SetOutsideValue( 0 );
+      secondFilter->SetInsideValue( 200 );
+      secondFilter->Update();
+
+      CPPUNIT_ASSERT_MESSAGE( "Kernel execution time is measured if profiling is enabled.",
+                              m_oclBinaryFilter->GetKernelExecutionTime() >= 0.0 );
+
+      mitk::Image::Pointer outputImage = secondFilter->GetOutput();
+
+      typedef itk::Image< unsigned char, 3> ImageType;
+      typedef itk::BinaryThresholdImageFilter< ImageType, ImageType > ThresholdFilterType;
+
+      ImageType::Pointer itkInputImage = ImageType::New();
+      CastToItkImage( m_Random3DImage, itkInputImage );
+
+      ThresholdFilterType::Pointer refThrFilter = ThresholdFilterType::New();
+      refThrFilter->SetInput( itkInputImage );
+      refThrFilter->SetLowerThreshold( 0 );
+      refThrFilter->SetUpperThreshold( 59 );
+      refThrFilter->SetOutsideValue( 0 );
+      refThrFilter->SetInsideValue( 200 );
+      refThrFilter->Update();
+      mitk::Image::Pointer referenceImage = mitk::Image::New();
+      mitk::CastToMitkImage(refThrFilter->GetOutput(), referenceImage);
+
+      MITK_ASSERT_EQUAL( referenceImage, outputImage,
+                         "Two chained OclBinaryThresholdFilters should be equal to the combined threshold.");
+    }
+    catch(mitk::Exception &e)
+    {
+      std::string errorMessage = "Caught unexpected exception ";
+      errorMessage.append(e.what());
+      CPPUNIT_FAIL(errorMessage.c_str());
+    }
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkOclBinaryThresholdImageFilter)
@@ -18,6 +18,9 @@ found in the LICENSE file.
 #include <usModuleContext.h>
 #include <usGetModuleContext.h>
 
+#include <string>
+#include <vector>
+
 using namespace mitk;
 
 /**
@@ -99,5 +102,21 @@ int mitkOclResourceServiceTest( int /*argc*/, char* /*argv*/[] )
   // the second test program should no more exist in the storage, hence we await an exception
   MITK_TEST_FOR_EXCEPTION( mitk::Exception, resources->GetProgram("test_program_failed"); );
 
+  // building the same source twice, the second build is loaded from the binary cache
+  std::vector<std::string> testSources(1, testProgramSource);
+  cl_program builtProgram = resources->BuildProgram( testSources, "", &err );
+  MITK_TEST_CONDITION_REQUIRED( builtProgram != nullptr && err == CL_SUCCESS, "Test program built by ResourceService.");
+
+  cl_program cachedProgram = resources->BuildProgram( testSources, "", &err );
+  MITK_TEST_CONDITION_REQUIRED( cachedProgram != nullptr && err == CL_SUCCESS, "Test program built again by ResourceService.");
+
+  cl_kernel cachedKernel = clCreateKernel( cachedProgram, "testKernel", &err );
+  MITK_TEST_CONDITION( err == CL_SUCCESS, "Kernel created from the second build.");
+  if( cachedKernel )
+    clReleaseKernel( cachedKernel );
+
+  clReleaseProgram( builtProgram );
+  clReleaseProgram( cachedProgram );
+
   MITK_TEST_END();
 }
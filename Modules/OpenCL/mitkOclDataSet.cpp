@@ -99,6 +99,7 @@ int mitk::OclDataSet::TransferDataToGPU(cl_command_queue gpuComQueue)
 
       CHECK_OCL_ERR(clErr);
       m_gpuModified = true;
+      m_cpuModified = false;
 
       if (clErr != CL_SUCCESS)
         mitkThrow() << "openCL Error when writing Buffer";
@@ -163,10 +164,23 @@ void* mitk::OclDataSet::TransferDataToCPU(cl_command_queue gpuComQueue)
 
 void mitk::OclDataSet::SetBufferSize(size_t size)
 {
+  // a buffer of the old size cannot be reused
+  if (m_gpuBuffer && size != m_bufferSize)
+  {
+    clReleaseMemObject(m_gpuBuffer);
+    m_gpuBuffer = nullptr;
+  }
+
   m_bufferSize = size;
 }
 
 void mitk::OclDataSet::SetBpE(unsigned short BpE)
 {
+  if (m_gpuBuffer && BpE != m_BpE)
+  {
+    clReleaseMemObject(m_gpuBuffer);
+    m_gpuBuffer = nullptr;
+  }
+
   m_BpE = BpE;
 }
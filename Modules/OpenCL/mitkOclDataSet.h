@@ -74,7 +74,12 @@ public:
      */
   void Modified(int _type);
 
-  /** \brief Initialze the OclDataSet with data. */
+  /** \brief Initialze the OclDataSet with data.
+   *
+   * The GPU buffer is kept, so the next TransferDataToGPU() call copies the new data into the existing buffer
+   * as long as the buffer size and the bytes per element do not change. This allows to stream data of the same
+   * size through a filter without allocating graphics memory for each data set.
+   */
   void SetData(void* data)
   {
     this->m_cpuModified = true;
@@ -55,10 +55,13 @@ bool mitk::OclDataSetToDataSetFilter::InitExec(cl_kernel ckKernel, unsigned int*
   // compute work sizes
   this->SetWorkingSize(8, uiDataSetWidth, 8, uiDataSetHeight, 8, uiDataSetDepth);
 
+  this->ResetProfiling();
+
   cl_mem clBuffIn = m_Input->GetGPUBuffer();
   cl_mem clBuffOut = m_Output->GetGPUBuffer();
 
-  if (!clBuffIn)
+  // the input buffer is reused if only the data was changed (see OclDataSet::SetData())
+  if (!clBuffIn || m_Input->IsModified(CPU_DATA))
   {
     if (m_Input->TransferDataToGPU(m_CommandQue) != CL_SUCCESS)
     {
@@ -102,6 +105,8 @@ bool mitk::OclDataSetToDataSetFilter::InitExecNoInput(cl_kernel ckKernel, unsign
   // compute work sizes
   this->SetWorkingSize(8, uiDataSetWidth, 8, uiDataSetHeight, 8, uiDataSetDepth);
 
+  this->ResetProfiling();
+
   cl_mem clBuffOut = m_Output->GetGPUBuffer();
 
   // output DataSet not initialized or output buffer size changed
@@ -38,7 +38,9 @@ mitk::OclFilter::OclFilter()
     m_CommandQue(nullptr),
     m_FilterID("mitkOclFilter"),
     m_Preambel(" "),
-    m_Initialized(false)
+    m_Initialized(false),
+    m_ProfilingEnabled(false),
+    m_KernelExecutionTime(0.0)
 {
 }
 
@@ -48,7 +50,9 @@ mitk::OclFilter::OclFilter(const char* filename)
     m_CommandQue(nullptr),
     m_FilterID(filename),
     m_Preambel(" "),
-    m_Initialized(false)
+    m_Initialized(false),
+    m_ProfilingEnabled(false),
+    m_KernelExecutionTime(0.0)
 {
   m_ClFiles.push_back(filename);
 }
@@ -72,11 +76,16 @@ bool mitk::OclFilter::ExecuteKernel( cl_kernel kernel, unsigned int workSizeDim
 {
   cl_int clErr = 0;
 
+  cl_event event = nullptr;
   clErr = clEnqueueNDRangeKernel( this->m_CommandQue, kernel, workSizeDim,
-                                  nullptr, this->m_GlobalWorkSize, m_LocalWorkSize, 0, nullptr, nullptr);
+                                  nullptr, this->m_GlobalWorkSize, m_LocalWorkSize, 0, nullptr,
+                                  m_ProfilingEnabled ? &event : nullptr);
 
   CHECK_OCL_ERR( clErr );
 
+  if (event)
+    this->AddProfilingEvent(event);
+
   return ( clErr == CL_SUCCESS );
 }
 
@@ -91,8 +100,12 @@ bool mitk::OclFilter::ExecuteKernelChunks( cl_kernel kernel, unsigned int workSi
     {
       for(offset[1] = 0; offset[1] < m_GlobalWorkSize[1]; offset[1] += chunksDim[1])
       {
+        cl_event event = nullptr;
         clErr |= clEnqueueNDRangeKernel(this->m_CommandQue, kernel, workSizeDim,
-          offset, chunksDim, m_LocalWorkSize, 0, nullptr, nullptr);
+          offset, chunksDim, m_LocalWorkSize, 0, nullptr, m_ProfilingEnabled ? &event : nullptr);
+
+        if (event)
+          this->AddProfilingEvent(event);
       }
     }
   }
@@ -104,8 +117,13 @@ bool mitk::OclFilter::ExecuteKernelChunks( cl_kernel kernel, unsigned int workSi
       {
         for(offset[2] = 0; offset[2] < m_GlobalWorkSize[2]; offset[2] += chunksDim[2])
         {
+          cl_event event = nullptr;
           clErr |= clEnqueueNDRangeKernel( this->m_CommandQue, kernel, workSizeDim,
-                                          offset, chunksDim, m_LocalWorkSize, 0, nullptr, nullptr);
+                                          offset, chunksDim, m_LocalWorkSize, 0, nullptr,
+                                          m_ProfilingEnabled ? &event : nullptr);
+
+          if (event)
+            this->AddProfilingEvent(event);
         }
       }
     }
@@ -257,32 +275,37 @@ void mitk::OclFilter::CompileSource()
   us::ServiceReference<OclResourceService> ref = GetModuleContext()->GetServiceReference<OclResourceService>();
   OclResourceService* resources = GetModuleContext()->GetService<OclResourceService>(ref);
 
-  cl_context gpuContext = resources->GetContext();
   // load the program source from file
   LoadSourceFiles(sourceCode, sourceCodeSize);
 
   if ( !sourceCode.empty() )
   {
     // create program from all files in the file list
-    m_ClProgram = clCreateProgramWithSource(gpuContext, sourceCode.size(), &sourceCode[0], &sourceCodeSize[0], &clErr);
-    CHECK_OCL_ERR(clErr);
+    std::vector<std::string> sources;
+    for (size_t i = 0; i < sourceCode.size(); ++i)
+    {
+      sources.emplace_back(sourceCode[i], sourceCodeSize[i]);
+    }
 
-    // build the source code
+    // build the source code, the resource service loads the binary of an earlier build from its cache
     MITK_DEBUG << "Building Program Source";
     std::string compilerOptions = "";
     compilerOptions.append(m_ClCompilerFlags);
 
     MITK_DEBUG("ocl.filter") << "cl compiler flags: " << compilerOptions.c_str();
 
-    clErr = clBuildProgram(m_ClProgram, 0, nullptr, compilerOptions.c_str(), nullptr, nullptr);
+    m_ClProgram = resources->BuildProgram(sources, compilerOptions, &clErr);
     CHECK_OCL_ERR(clErr);
 
     // if OpenCL Source build failed
     if (clErr != CL_SUCCESS)
     {
       MITK_ERROR("ocl.filter") << "Failed to build source";
-      oclLogBuildInfo(m_ClProgram, resources->GetCurrentDevice() );
-      oclLogBinary(m_ClProgram, resources->GetCurrentDevice() );
+      if (m_ClProgram)
+      {
+        oclLogBuildInfo(m_ClProgram, resources->GetCurrentDevice() );
+        oclLogBinary(m_ClProgram, resources->GetCurrentDevice() );
+      }
       m_Initialized = false;
     }
 
@@ -338,6 +361,11 @@ void mitk::OclFilter::SetCompilerFlags(const char* flags)
 }
 
 
+bool mitk::OclFilter::Precompile()
+{
+  return this->OclFilter::Initialize() && m_ClProgram != nullptr;
+}
+
 bool mitk::OclFilter::IsInitialized()
 {
   return m_Initialized;
@@ -349,3 +377,46 @@ unsigned long mitk::OclFilter::GetDeviceMemory()
   auto device = resources->GetCurrentDevice();
   return oclGetGlobalMemSize(device);
 }
+
+void mitk::OclFilter::SetProfilingEnabled(bool enabled)
+{
+  m_ProfilingEnabled = enabled;
+}
+
+bool mitk::OclFilter::GetProfilingEnabled() const
+{
+  return m_ProfilingEnabled;
+}
+
+double mitk::OclFilter::GetKernelExecutionTime() const
+{
+  return m_KernelExecutionTime;
+}
+
+void mitk::OclFilter::ResetProfiling()
+{
+  m_KernelExecutionTime = 0.0;
+}
+
+void mitk::OclFilter::AddProfilingEvent(cl_event event)
+{
+  cl_ulong start = 0;
+  cl_ulong end = 0;
+
+  cl_int clErr = clWaitForEvents(1, &event);
+  if (clErr == CL_SUCCESS)
+    clErr = clGetEventProfilingInfo(event, CL_PROFILING_COMMAND_START, sizeof(cl_ulong), &start, nullptr);
+  if (clErr == CL_SUCCESS)
+    clErr = clGetEventProfilingInfo(event, CL_PROFILING_COMMAND_END, sizeof(cl_ulong), &end, nullptr);
+
+  clReleaseEvent(event);
+
+  if (clErr != CL_SUCCESS)
+  {
+    MITK_WARN("ocl.filter") << "Could not measure the kernel execution time: " << GetOclErrorAsString(clErr);
+    return;
+  }
+
+  // the profiling counters are in nanoseconds
+  m_KernelExecutionTime += (end - start) * 1e-6;
+}
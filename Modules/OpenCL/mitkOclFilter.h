@@ -49,6 +49,16 @@ public:
     */
   void SetCompilerFlags(const char* flags);
 
+  /**
+    * @brief Builds the program of the filter without executing it
+    *
+    * The program is compiled (or loaded from the binary cache of the OclResourceService) and stored
+    * in the resource service, so the first update of any filter using the same program does not
+    * need to build it. This can be called from a background thread.
+    * @return True if the program is available.
+    */
+  bool Precompile();
+
   /**
     * @brief Returns true if the initialization was successfull
     */
@@ -59,6 +69,23 @@ public:
     */
   virtual unsigned long GetDeviceMemory();
 
+  /**
+    * @brief Enables the profiling of the kernels executed by ExecuteKernel() and ExecuteKernelChunks()
+    *
+    * The device time of every kernel is measured with an OpenCL event. Since the filter waits for each
+    * event, profiling should only be enabled for measurements.
+    */
+  void SetProfilingEnabled(bool enabled);
+
+  /** @brief Returns true if the kernel execution times are measured */
+  bool GetProfilingEnabled() const;
+
+  /**
+    * @brief Returns the device time in milliseconds the kernels of the last update of the filter took.
+    *        Only available if profiling is enabled.
+    */
+  double GetKernelExecutionTime() const;
+
   /** @brief Destructor */
   virtual ~OclFilter();
 
@@ -94,6 +121,12 @@ protected:
   /** @brief  status of the filter */
   bool m_Initialized;
 
+  /** @brief True if the kernel execution times are measured */
+  bool m_ProfilingEnabled;
+
+  /** @brief Device time in milliseconds of the kernels executed since the last call of ResetProfiling() */
+  double m_KernelExecutionTime;
+
   /** @brief The local work size fo the filter */
   size_t m_LocalWorkSize[3];
 
@@ -117,6 +150,12 @@ protected:
     * batches of batchSize chunks a time of waitTimems milliseconds
   */
   bool ExecuteKernelChunksInBatches(cl_kernel kernel, unsigned int workSizeDim, size_t* chunksDim, size_t batchSize, int waitTimems);
+
+  /** @brief Resets the measured kernel execution time, called when a filter starts a new execution */
+  void ResetProfiling();
+
+  /** @brief Waits for the event, adds the device time of its command to the kernel execution time and releases it */
+  void AddProfilingEvent(cl_event event);
   /**
       * \brief Initialize all necessary parts of the filter
       *
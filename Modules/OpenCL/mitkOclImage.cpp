@@ -20,7 +20,8 @@ found in the LICENSE file.
 #include <mitkImageReadAccessor.h>
 #include <fstream>
 
-mitk::OclImage::OclImage() : m_gpuImage(nullptr), m_context(nullptr), m_bufferSize(0), m_gpuModified(false), m_cpuModified(false),
+mitk::OclImage::OclImage() : m_gpuImage(nullptr), m_context(nullptr), m_bufferSize(0), m_gpuImageFromBuffer(nullptr),
+  m_gpuImageFromBufferOutdated(false), m_gpuModified(false), m_cpuModified(false),
   m_Image(nullptr), m_dim(0), m_Dims(nullptr), m_BpE(1), m_formatSupported(false)
 {
 }
@@ -31,6 +32,7 @@ mitk::OclImage::~OclImage()
 
   //release GMEM Image buffer
   if (m_gpuImage) clReleaseMemObject(m_gpuImage);
+  if (m_gpuImageFromBuffer) clReleaseMemObject(m_gpuImageFromBuffer);
 }
 
 
@@ -57,6 +59,17 @@ cl_mem mitk::OclImage::CreateGPUImage(unsigned int _wi, unsigned int _he, unsign
 
   cl_context gpuContext = resources->GetContext();
 
+  // release the buffer of a previous size, the image copy of it is recreated on demand
+  if (m_gpuImage)
+  {
+    clReleaseMemObject(m_gpuImage);
+  }
+  if (m_gpuImageFromBuffer)
+  {
+    clReleaseMemObject(m_gpuImageFromBuffer);
+    m_gpuImageFromBuffer = nullptr;
+  }
+
   int clErr;
   m_gpuImage = clCreateBuffer( gpuContext, CL_MEM_READ_WRITE, m_bufferSize * m_BpE, nullptr, &clErr);
 
@@ -100,6 +113,9 @@ void mitk::OclImage::Modified(int _type)
   // defines... GPU: 0, CPU: 1
   m_cpuModified = _type;
   m_gpuModified = !_type;
+
+  if (_type == GPU_DATA)
+    m_gpuImageFromBufferOutdated = true;
 }
 
 int mitk::OclImage::TransferDataToGPU(cl_command_queue gpuComQueue)
@@ -118,7 +134,7 @@ int mitk::OclImage::TransferDataToGPU(cl_command_queue gpuComQueue)
     //check the buffer
     if(m_gpuImage == nullptr)
     {
-      clErr = this->AllocateGPUImage();
+      clErr = this->AllocateGPUImage(&m_gpuImage);
     }
 
     if (m_Image->IsInitialized() &&
@@ -145,7 +161,7 @@ int mitk::OclImage::TransferDataToGPU(cl_command_queue gpuComQueue)
   return clErr;
 }
 
-cl_int mitk::OclImage::AllocateGPUImage()
+cl_int mitk::OclImage::AllocateGPUImage(cl_mem* image)
 {
   cl_int clErr = 0;
 
@@ -190,7 +206,7 @@ cl_int mitk::OclImage::AllocateGPUImage()
     //Create a 2D Image
     imageDescriptor.image_type = CL_MEM_OBJECT_IMAGE2D;
   }
-  m_gpuImage = clCreateImage(gpuContext, CL_MEM_READ_ONLY, &m_supportedFormat, &imageDescriptor, nullptr, &clErr);
+  *image = clCreateImage(gpuContext, CL_MEM_READ_ONLY, &m_supportedFormat, &imageDescriptor, nullptr, &clErr);
 
   CHECK_OCL_ERR(clErr);
 
@@ -200,40 +216,46 @@ cl_int mitk::OclImage::AllocateGPUImage()
 cl_mem mitk::OclImage::GetGPUImage(cl_command_queue gpuComQueue)
 {
   // clGetMemObjectInfo()
-  cl_mem_object_type memInfo;
+  cl_mem_object_type memInfo = 0;
   cl_int clErr = 0;
 
-  // query image object info only if already initialized
-  if( this->m_gpuImage )
+  // no data on the GPU yet
+  if( !this->m_gpuImage )
   {
-    clErr = clGetMemObjectInfo(this->m_gpuImage, CL_MEM_TYPE, sizeof(cl_mem_object_type), &memInfo, nullptr );
-    CHECK_OCL_ERR(clErr);
+    return nullptr;
   }
 
-  MITK_INFO << "Querying info for object, recieving: " << memInfo;
+  // query image object info
+  clErr = clGetMemObjectInfo(this->m_gpuImage, CL_MEM_TYPE, sizeof(cl_mem_object_type), &memInfo, nullptr );
+  CHECK_OCL_ERR(clErr);
 
   // test if m_gpuImage CL_MEM_IMAGE_2/3D
   // if not, copy buffer to image
   if (memInfo == CL_MEM_OBJECT_BUFFER)
   {
-    MITK_WARN << " Passed oclImage is a buffer-object, creating image";
-
-    //hold a copy of the buffer gmem pointer
-    cl_mem tempBuffer = this->m_gpuImage;
-
-    const size_t origin[3] = {0, 0, 0};
-    size_t region[3] = {this->m_Dims[0], this->m_Dims[1], 1};
+    // the image is kept, only its content is updated
+    if (!m_gpuImageFromBuffer)
+    {
+      MITK_DEBUG << "Passed oclImage is a buffer-object, creating image";
+      clErr = this->AllocateGPUImage(&m_gpuImageFromBuffer);
+      CHECK_OCL_ERR(clErr);
+      m_gpuImageFromBufferOutdated = true;
+    }
 
-    clErr = this->AllocateGPUImage();
+    if (m_gpuImageFromBufferOutdated)
+    {
+      const size_t origin[3] = {0, 0, 0};
+      const size_t region[3] = {this->m_Dims[0], this->m_Dims[1], this->m_dim > 2 ? this->m_Dims[2] : 1};
 
-    this->m_dim = 3;
+      //copy last data to the image data, the copy stays on the device
+      clErr = clEnqueueCopyBufferToImage( gpuComQueue, m_gpuImage, m_gpuImageFromBuffer, 0, origin, region,
+                                          0, nullptr, nullptr);
+      CHECK_OCL_ERR(clErr);
 
-    //copy last data to the image data
-    clErr = clEnqueueCopyBufferToImage( gpuComQueue, tempBuffer, m_gpuImage, 0, origin, region, 0, nullptr, nullptr);
-    CHECK_OCL_ERR(clErr);
+      m_gpuImageFromBufferOutdated = false;
+    }
 
-    //release pointer
-    clReleaseMemObject(tempBuffer);
+    return m_gpuImageFromBuffer;
   }
   return m_gpuImage;
 }
@@ -260,10 +282,10 @@ void* mitk::OclImage::TransferDataToCPU(cl_command_queue gpuComQueue)
   // debug info
   oclPrintMemObjectInfo( m_gpuImage );
 
-  clErr = clEnqueueReadBuffer( gpuComQueue, m_gpuImage, CL_FALSE, 0, m_bufferSize * m_BpE, data ,0, nullptr, nullptr);
+  // blocking read, the data is returned to the caller right away
+  clErr = clEnqueueReadBuffer( gpuComQueue, m_gpuImage, CL_TRUE, 0, m_bufferSize * m_BpE, data ,0, nullptr, nullptr);
   CHECK_OCL_ERR(clErr);
 
-  clFlush( gpuComQueue );
   // the cpu data is same as gpu
   this->m_gpuModified = false;
 
@@ -64,7 +64,11 @@ public:
   /*! \brief Checks whether gpuImage is a valid clImage object
 
     when an oclImage gets created by an image to image filter, the output image is created
-    by clCreateBuffer() because it is not in general possible to write to clImage directly
+    by clCreateBuffer() because it is not in general possible to write to clImage directly.
+    In this case the buffer is copied into a separate clImage on the device, which is returned.
+    The buffer stays owned by the filter, so the next filter of a GPU pipeline reads its input
+    without any transfer to the host. The copy is only repeated if the buffer was modified.
+    Returns nullptr if there is no data on the GPU.
     */
   cl_mem GetGPUImage(cl_command_queue);
 
@@ -157,6 +161,12 @@ protected:
   /*! GMEM Buffer Size */
   unsigned int m_bufferSize;
 
+  /*! GMEM Image holding a copy of the buffer m_gpuImage, if m_gpuImage was created by CreateGPUImage() */
+  cl_mem m_gpuImageFromBuffer;
+
+  /*! True if m_gpuImage was modified after it was copied to m_gpuImageFromBuffer */
+  bool m_gpuImageFromBufferOutdated;
+
 private:
 
   cl_image_format ConvertPixelTypeToOCLFormat();
@@ -173,7 +183,7 @@ private:
 
   unsigned short m_BpE;
 
-  cl_int AllocateGPUImage();
+  cl_int AllocateGPUImage(cl_mem* image);
 
   /** Bool flag to signalize if the proposed format is supported on currend HW.
       For value 'false', the transfer kernel has to be called to fit the data to
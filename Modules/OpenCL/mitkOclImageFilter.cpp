@@ -27,6 +27,9 @@ mitk::OclImageFilter::~OclImageFilter()
 void mitk::OclImageFilter::SetInput(mitk::OclImage::Pointer image)
 {
   m_Input = image;
+
+  // the image may be the GPU output of a preceding filter, which has no mitk::Image data
+  this->m_CurrentType = m_Input->GetBytesPerPixel() - 1;
 }
 
 void mitk::OclImageFilter::SetInput(mitk::Image::Pointer image)
@@ -36,6 +36,9 @@ class MITKOPENCL_EXPORT OclImageFilter: public OclFilter
 public:
   /**
    * @brief SetInput SetInput Set the input image (as mitk::OclImage).
+   *
+   * Pass the OclImageToImageFilter::GetGPUOutput() of another filter to chain both filters on the GPU.
+   * The data stays on the device, the preceding filter has to be updated first.
    * @param image The image in mitk::OclImage.
    */
   void SetInput(mitk::OclImage::Pointer image);
@@ -111,9 +111,15 @@ bool mitk::OclImageToImageFilter::InitExec(cl_kernel ckKernel)
   // compute work sizes
   this->SetWorkingSize( 8, uiImageWidth, 8, uiImageHeight , 8, uiImageDepth );
 
+  this->ResetProfiling();
+
+  // the element size of a GPU input is only known after the preceding filter was updated
+  this->m_CurrentType = m_Input->GetBytesPerPixel() - 1;
+
   cl_mem clBuffIn = m_Input->GetGPUImage(this->m_CommandQue);
   cl_mem clBuffOut = m_Output->GetGPUBuffer();
 
+  // only images from the CPU are transferred, the GPU output of a preceding filter is used directly
   if (!clBuffIn)
   {
     if ( m_Input->TransferDataToGPU(m_CommandQue) != CL_SUCCESS )
@@ -122,6 +128,9 @@ bool mitk::OclImageToImageFilter::InitExec(cl_kernel ckKernel)
     }
 
     clBuffIn = m_Input->GetGPUImage(m_CommandQue);
+
+    if (!clBuffIn)
+      mitkThrow() << "Input image has no data. If it is the GPU output of another filter, update that filter first.";
   }
 
   // output image not initialized
@@ -158,9 +167,15 @@ bool mitk::OclImageToImageFilter::InitExec(cl_kernel ckKernel)
   // compute work sizes
   this->SetWorkingSize( 8, uiImageWidth, 8, uiImageHeight , 8, uiImageDepth );
 
+  this->ResetProfiling();
+
+  // the element size of a GPU input is only known after the preceding filter was updated
+  this->m_CurrentType = m_Input->GetBytesPerPixel() - 1;
+
   cl_mem clBuffIn = m_Input->GetGPUImage(this->m_CommandQue);
   cl_mem clBuffOut = m_Output->GetGPUBuffer();
 
+  // only images from the CPU are transferred, the GPU output of a preceding filter is used directly
   if (!clBuffIn)
   {
     if ( m_Input->TransferDataToGPU(m_CommandQue) != CL_SUCCESS )
@@ -169,6 +184,9 @@ bool mitk::OclImageToImageFilter::InitExec(cl_kernel ckKernel)
     }
 
     clBuffIn = m_Input->GetGPUImage(m_CommandQue);
+
+    if (!clBuffIn)
+      mitkThrow() << "Input image has no data. If it is the GPU output of another filter, update that filter first.";
   }
 
   // output image not initialized
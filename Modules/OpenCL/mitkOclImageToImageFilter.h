@@ -22,6 +22,11 @@ class OclImageToImageFilter;
 
 /** @class OclImageToImageFilter
   * @brief The OclImageToImageFilter is the base class for all OpenCL image filter generating images.
+  *
+  * Filters are chained on the GPU by passing GetGPUOutput() to SetInput() of the next filter. All filters
+  * share one in-order command queue, so no synchronization is needed between them. Data is only transferred
+  * at the ends of such a pipeline: the input of the first filter is uploaded in its Update() and
+  * GetOutput() of the last filter downloads the result.
   */
 class MITKOPENCL_EXPORT OclImageToImageFilter: public OclImageFilter
 {
@@ -36,6 +41,7 @@ public:
     *
     * Use this method when executing two and more filters on the GPU for fast access.
     * This method does not copy the data to RAM. It returns only a pointer.
+    * The returned image is updated in place by every Update() of this filter.
     */
   mitk::OclImage::Pointer GetGPUOutput();
 
@@ -17,6 +17,9 @@ found in the LICENSE file.
 
 #include <mitkOpenCL.h>
 
+#include <string>
+#include <vector>
+
 /**
  * @brief Declaration of the OpenCL Resources micro-service
  *
@@ -50,6 +53,21 @@ public:
   */
   virtual void InsertProgram(cl_program program, std::string string, bool flag) = 0;
 
+  /** @brief Builds a program from the given sources for the current device
+   *
+   * Built programs are kept as binaries in an on-disk cache, so the sources are only compiled once per device,
+   * driver version and compiler options. The cache is stored in the directory given by the environment variable
+   * MITK_OPENCL_CACHE_DIR or in the directory "MITK-OpenCL-Cache" in the temporary directory if the variable is
+   * not set. Setting MITK_OPENCL_CACHE_DIR to an empty string disables the cache.
+   *
+   * @param sources The source code of the program.
+   * @param compilerOptions The options passed to the OpenCL compiler.
+   * @param buildStatus Set to CL_SUCCESS or to the error code of the failed build step.
+   * @return The program (also if the build failed, to allow querying the build log) or nullptr.
+   */
+  virtual cl_program BuildProgram(const std::vector<std::string>& sources, const std::string& compilerOptions,
+                                  cl_int* buildStatus) = 0;
+
   /** @brief Get the cl_program by name
    * @param name Text identifier of the program.
    * @throws an mitk::Exception in case the program cannot be found
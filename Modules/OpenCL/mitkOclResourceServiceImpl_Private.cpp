@@ -12,6 +12,135 @@ found in the LICENSE file.
 
 #include "mitkOclResourceServiceImpl_p.h"
 
+#include <mitkIOUtil.h>
+
+#include <itksys/SystemTools.hxx>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+  std::string GetDeviceInfoString(cl_device_id device, cl_device_info info)
+  {
+    size_t size = 0;
+    if (clGetDeviceInfo(device, info, 0, nullptr, &size) != CL_SUCCESS || size == 0)
+      return std::string();
+
+    std::vector<char> value(size);
+    clGetDeviceInfo(device, info, size, value.data(), nullptr);
+    return std::string(value.data());
+  }
+
+  /** 64 bit FNV-1a hash, which unlike std::hash is the same on all platforms and in all sessions */
+  std::uint64_t Hash(const std::string& text, std::uint64_t hash = 14695981039346656037ull)
+  {
+    for (const unsigned char c : text)
+    {
+      hash ^= c;
+      hash *= 1099511628211ull;
+    }
+    return hash;
+  }
+
+  std::string GetCacheDirectory()
+  {
+    const char* cacheDirectory = std::getenv("MITK_OPENCL_CACHE_DIR");
+    if (cacheDirectory != nullptr)
+      return cacheDirectory;
+
+    return mitk::IOUtil::GetTempPath() + "MITK-OpenCL-Cache";
+  }
+
+  /** Loads and builds the cached binary, returns nullptr if there is no valid binary for the header */
+  cl_program LoadCachedProgram(cl_context context, cl_device_id device, const std::string& cacheFile,
+                               const std::string& header, const std::string& compilerOptions)
+  {
+    std::ifstream file(cacheFile.c_str(), std::ios::binary);
+    if (!file)
+      return nullptr;
+
+    const std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (content.size() <= header.size() || content.compare(0, header.size(), header) != 0)
+      return nullptr;
+
+    const size_t binarySize = content.size() - header.size();
+    const unsigned char* binary = reinterpret_cast<const unsigned char*>(content.data() + header.size());
+
+    cl_int binaryStatus = CL_SUCCESS;
+    cl_int clErr = CL_SUCCESS;
+    cl_program program = clCreateProgramWithBinary(context, 1, &device, &binarySize, &binary, &binaryStatus, &clErr);
+
+    if (clErr == CL_SUCCESS && binaryStatus == CL_SUCCESS)
+      clErr = clBuildProgram(program, 1, &device, compilerOptions.c_str(), nullptr, nullptr);
+
+    if (clErr != CL_SUCCESS || binaryStatus != CL_SUCCESS)
+    {
+      MITK_WARN("OpenCL.ResourceService") << "Ignoring invalid cached program " << cacheFile;
+      if (program)
+        clReleaseProgram(program);
+      return nullptr;
+    }
+
+    MITK_DEBUG("OpenCL.ResourceService") << "Loaded cached program " << cacheFile;
+    return program;
+  }
+
+  void StoreProgramBinary(cl_program program, const std::string& cacheDirectory, const std::string& cacheFile,
+                          const std::string& header)
+  {
+    // the context has a single device, so the program has one binary
+    cl_uint numberOfDevices = 0;
+    cl_int clErr = clGetProgramInfo(program, CL_PROGRAM_NUM_DEVICES, sizeof(cl_uint), &numberOfDevices, nullptr);
+    if (clErr != CL_SUCCESS || numberOfDevices != 1)
+      return;
+
+    size_t binarySize = 0;
+    clErr = clGetProgramInfo(program, CL_PROGRAM_BINARY_SIZES, sizeof(size_t), &binarySize, nullptr);
+    if (clErr != CL_SUCCESS || binarySize == 0)
+      return;
+
+    std::vector<unsigned char> binary(binarySize);
+    unsigned char* binaryPointer = binary.data();
+    clErr = clGetProgramInfo(program, CL_PROGRAM_BINARIES, sizeof(unsigned char*), &binaryPointer, nullptr);
+    if (clErr != CL_SUCCESS)
+      return;
+
+    if (!itksys::SystemTools::MakeDirectory(cacheDirectory.c_str()))
+    {
+      MITK_WARN("OpenCL.ResourceService") << "Could not create the program cache directory " << cacheDirectory;
+      return;
+    }
+
+    // write to a unique file first, so concurrent builds of the same program never produce a partial file
+    std::ostringstream temporaryFile;
+    temporaryFile << cacheFile << "." << std::hash<std::thread::id>()(std::this_thread::get_id()) << "."
+                  << std::chrono::steady_clock::now().time_since_epoch().count() << ".tmp";
+
+    {
+      std::ofstream file(temporaryFile.str().c_str(), std::ios::binary);
+      file.write(header.data(), header.size());
+      file.write(reinterpret_cast<const char*>(binary.data()), binary.size());
+      if (!file)
+      {
+        file.close();
+        std::remove(temporaryFile.str().c_str());
+        return;
+      }
+    }
+
+    if (std::rename(temporaryFile.str().c_str(), cacheFile.c_str()) != 0)
+      std::remove(temporaryFile.str().c_str());
+  }
+}
+
 OclResourceService::~OclResourceService()
 {
 }
@@ -39,13 +168,24 @@ OclResourceServiceImpl::~OclResourceServiceImpl()
     delete m_ContextCollection;
 }
 
-cl_context OclResourceServiceImpl::GetContext() const
+void OclResourceServiceImpl::InitializeContextCollection() const
 {
+  std::lock_guard<std::mutex> lock(m_ContextCollectionMutex);
+
   if( m_ContextCollection == nullptr )
   {
     m_ContextCollection = new OclContextCollection();
   }
-  else if( !m_ContextCollection->CanProvideContext() )
+}
+
+cl_context OclResourceServiceImpl::GetContext() const
+{
+  if( m_ContextCollection == nullptr )
+  {
+    this->InitializeContextCollection();
+  }
+
+  if( !m_ContextCollection->CanProvideContext() )
   {
     return nullptr;
   }
@@ -62,7 +202,7 @@ cl_command_queue OclResourceServiceImpl::GetCommandQueue() const
   // if not create one
   if( ! m_ContextCollection )
   {
-    m_ContextCollection = new OclContextCollection();
+    this->InitializeContextCollection();
   }
 
   cl_int clErr = clGetCommandQueueInfo( m_ContextCollection->m_CommandQueue, CL_QUEUE_CONTEXT, sizeof(clQueueContext), &clQueueContext, nullptr );
@@ -128,11 +268,87 @@ void OclResourceServiceImpl::InsertProgram(cl_program _program_in, std::string n
   }
 }
 
+cl_program OclResourceServiceImpl::BuildProgram(const std::vector<std::string>& sources,
+                                                const std::string& compilerOptions, cl_int* buildStatus)
+{
+  cl_context context = this->GetContext();
+  if( context == nullptr )
+  {
+    *buildStatus = CL_INVALID_CONTEXT;
+    return nullptr;
+  }
+
+  cl_device_id device = m_ContextCollection->m_Devices[0];
+
+  // the binary depends on the device, the driver and the complete input of the compiler
+  const std::string key = GetDeviceInfoString(device, CL_DEVICE_VENDOR) + "|" +
+                          GetDeviceInfoString(device, CL_DEVICE_NAME) + "|" +
+                          GetDeviceInfoString(device, CL_DEVICE_VERSION) + "|" +
+                          GetDeviceInfoString(device, CL_DRIVER_VERSION) + "|" + compilerOptions;
+
+  const std::string cacheDirectory = GetCacheDirectory();
+  std::string cacheFile;
+  std::string header;
+
+  if( !cacheDirectory.empty() )
+  {
+    std::uint64_t hash = Hash(key);
+    for( const auto& source : sources )
+    {
+      hash = Hash(source, Hash(std::to_string(source.size()) + ":", hash));
+    }
+
+    std::ostringstream hashString;
+    hashString << std::hex << std::setw(16) << std::setfill('0') << hash;
+
+    cacheFile = cacheDirectory + "/" + hashString.str() + ".bin";
+    header = "MITK OpenCL program\n" + key + "\n" + hashString.str() + "\n";
+
+    cl_program program = LoadCachedProgram(context, device, cacheFile, header, compilerOptions);
+    if( program )
+    {
+      *buildStatus = CL_SUCCESS;
+      return program;
+    }
+  }
+
+  std::vector<const char*> sourcePointers;
+  std::vector<size_t> sourceSizes;
+  for( const auto& source : sources )
+  {
+    sourcePointers.push_back(source.c_str());
+    sourceSizes.push_back(source.size());
+  }
+
+  cl_int clErr = CL_SUCCESS;
+  cl_program program = clCreateProgramWithSource(context, sourcePointers.size(), sourcePointers.data(),
+                                                 sourceSizes.data(), &clErr);
+  CHECK_OCL_ERR(clErr);
+
+  if( clErr == CL_SUCCESS )
+  {
+    clErr = clBuildProgram(program, 0, nullptr, compilerOptions.c_str(), nullptr, nullptr);
+    CHECK_OCL_ERR(clErr);
+
+    if( clErr == CL_SUCCESS && !cacheFile.empty() )
+    {
+      StoreProgramBinary(program, cacheDirectory, cacheFile, header);
+    }
+  }
+
+  *buildStatus = clErr;
+  return program;
+}
+
 cl_program OclResourceServiceImpl::GetProgram(const std::string &name)
 {
+  // programs may be inserted concurrently by a precompiling thread
+  m_ProgramStorageMutex->Lock();
   ProgramMapType::iterator it = m_ProgramStorage.find(name);
+  const bool found = it != m_ProgramStorage.end();
+  m_ProgramStorageMutex->Unlock();
 
-  if( it != m_ProgramStorage.end() )
+  if( found )
   {
     it->second.mutex->Lock();
     // first check if the program was deleted
@@ -14,6 +14,7 @@ found in the LICENSE file.
 #define __mitkOclResourceServiceImpl_h
 
 #include <map>
+#include <mutex>
 
 //Micro Services
 #include <usModuleActivator.h>
@@ -66,8 +67,11 @@ public:
       clErr = clGetContextInfo(m_Context, CL_CONTEXT_DEVICES, szParmDataBytes, m_Devices, nullptr);
       CHECK_OCL_ERR( clErr );
 
-      // create command queue
-      m_CommandQueue = clCreateCommandQueue(m_Context,  m_Devices[0], 0, &clErr);
+      // create command queue, with profiling if the device supports it (see OclFilter::SetProfilingEnabled())
+      cl_command_queue_properties queueProperties = 0;
+      clGetDeviceInfo(m_Devices[0], CL_DEVICE_QUEUE_PROPERTIES, sizeof(queueProperties), &queueProperties, nullptr);
+      m_CommandQueue = clCreateCommandQueue(m_Context,  m_Devices[0],
+                                            queueProperties & CL_QUEUE_PROFILING_ENABLE, &clErr);
       CHECK_OCL_ERR( clErr );
 
       this->PrintContextInfo( );
@@ -151,6 +155,11 @@ private:
   ProgramMapType m_ProgramStorage;
   /** mutex for manipulating the program storage */
   itk::FastMutexLock::Pointer m_ProgramStorageMutex;
+  /** mutex for creating the context collection, which may be requested by a precompiling thread */
+  mutable std::mutex m_ContextCollectionMutex;
+
+  /** @brief Creates the context collection on first use */
+  void InitializeContextCollection() const;
 
 public:
 
@@ -170,6 +179,9 @@ public:
 
   void InsertProgram(cl_program _program_in, std::string name, bool forceOverride=true);
 
+  cl_program BuildProgram(const std::vector<std::string>& sources, const std::string& compilerOptions,
+                          cl_int* buildStatus);
+
   cl_program GetProgram(const std::string&name);
 
   void InvalidateStorage();
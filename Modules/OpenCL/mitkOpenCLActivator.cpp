@@ -11,6 +11,9 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkOpenCLActivator.h"
+#include "mitkOclBinaryThresholdImageFilter.h"
+
+#include <cstdlib>
 
 void OpenCLActivator::Load(us::ModuleContext *context)
 {
@@ -19,10 +22,26 @@ void OpenCLActivator::Load(us::ModuleContext *context)
   us::ServiceProperties props;
 
   context->RegisterService<OclResourceService>(m_ResourceService.get(), props);
+
+  if (std::getenv("MITK_OPENCL_PRECOMPILE") != nullptr)
+  {
+    m_PrecompileThread = std::thread([this]() {
+      if (m_ResourceService->GetContext() == nullptr)
+        return;
+
+      mitk::OclBinaryThresholdImageFilter::Pointer binaryThresholdFilter = mitk::OclBinaryThresholdImageFilter::New();
+      if (binaryThresholdFilter->Precompile())
+        m_PrecompiledFilters.push_back(binaryThresholdFilter.GetPointer());
+    });
+  }
 }
 
 void OpenCLActivator::Unload(us::ModuleContext *)
 {
+  if (m_PrecompileThread.joinable())
+    m_PrecompileThread.join();
+
+  m_PrecompiledFilters.clear();
   m_ResourceService.release();
 }
 
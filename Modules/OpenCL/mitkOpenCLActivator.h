@@ -15,6 +15,8 @@ found in the LICENSE file.
 
 #include "mitkOclResourceServiceImpl_p.h"
 
+#include <itkObject.h>
+
 #include <usModuleActivator.h>
 #include <usModuleContext.h>
 #include <usGetModuleContext.h>
@@ -23,12 +25,18 @@ found in the LICENSE file.
 #include <set>
 #include <algorithm>
 #include <memory>
+#include <thread>
+#include <vector>
 
 /**
  * @class OpenCLActivator
  *
  * @brief Custom activator for the OpenCL Module in order to register
  * and provide the OclResourceService
+ *
+ * If the environment variable MITK_OPENCL_PRECOMPILE is set, the OpenCL context is created and the programs
+ * of the filters of this module are built in a background thread when the module is loaded. The programs
+ * stay in the program storage of the service until the module is unloaded.
  */
 class US_ABI_LOCAL OpenCLActivator : public us::ModuleActivator
 {
@@ -36,6 +44,11 @@ private:
 
   std::unique_ptr<OclResourceServiceImpl> m_ResourceService;
 
+  std::thread m_PrecompileThread;
+
+  /** Filters whose programs were built by the precompile thread */
+  std::vector<itk::Object::Pointer> m_PrecompiledFilters;
+
 public:
   /** @brief Load module context */
   void Load(us::ModuleContext *context);
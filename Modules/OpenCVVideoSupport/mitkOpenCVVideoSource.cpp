@@ -11,6 +11,12 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkOpenCVVideoSource.h"
+#include "mitkOpenCVToMitkImageFilter.h"
+
+#include <mitkImageWriteAccessor.h>
+
+#include <opencv2/imgproc.hpp>
+
 #include <iostream>
 #include <algorithm>
 
@@ -24,7 +30,14 @@ mitk::OpenCVVideoSource::OpenCVVideoSource()
   m_UseCVCAMLib(false),
   m_UndistortImage(false),
   m_FlipXAxisEnabled(false),
-  m_FlipYAxisEnabled(false)
+  m_FlipYAxisEnabled(false),
+  m_BackgroundCapturing(false),
+  m_FrameQueueSize(2),
+  m_ConvertFramesToMitkImage(false),
+  m_StopProducer(false),
+  m_EndOfVideo(false),
+  m_NumberOfGrabbedFrames(0),
+  m_NumberOfDroppedFrames(0)
 {
 }
 
@@ -61,20 +74,24 @@ void mitk::OpenCVVideoSource::SetVideoCameraInput(int cameraindex, bool /*useCVC
 
 double mitk::OpenCVVideoSource::GetVideoCaptureProperty(int property_id)
 {
+  std::lock_guard<std::mutex> lock(m_CaptureMutex);
   return cvGetCaptureProperty(m_VideoCapture, property_id);
 }
 
 int mitk::OpenCVVideoSource::SetVideoCaptureProperty(int property_id, double value)
 {
+  std::lock_guard<std::mutex> lock(m_CaptureMutex);
   return cvSetCaptureProperty(m_VideoCapture, property_id, value);
 }
 
 //method extended for "static video feature" if enabled
 unsigned char* mitk::OpenCVVideoSource::GetVideoTexture()
 { // Fetch Frame and return pointer to opengl texture
+  const unsigned long frameCount = m_FrameCount;
   FetchFrame();
 
-  if (m_FlipXAxisEnabled || m_FlipYAxisEnabled)
+  // with background capturing, the current frame is kept if there is no new one, so it must not be flipped again
+  if ((m_FlipXAxisEnabled || m_FlipYAxisEnabled) && (!m_ProducerThread.joinable() || m_FrameCount != frameCount))
   {
     //rotate the image to get a static video
     m_CurrentImage = this->FlipImage(m_CurrentImage);
@@ -118,7 +135,11 @@ void mitk::OpenCVVideoSource::FetchFrame()
 { // main procedure for updating video data
   if(m_CapturingInProcess)
   {
-    if(m_VideoCapture) // we use highgui
+    if(m_ProducerThread.joinable())
+    {
+      this->FetchQueuedFrame();
+    }
+    else if(m_VideoCapture) // we use highgui
     {
       if(!m_CapturePaused)
       {
@@ -165,6 +186,202 @@ void mitk::OpenCVVideoSource::FetchFrame()
   }
 }
 
+void mitk::OpenCVVideoSource::FetchQueuedFrame()
+{
+  if(m_CapturePaused)
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(m_FrameQueueMutex);
+    if(m_FrameQueue.empty())
+    {
+      if(m_EndOfVideo)
+      {
+        std::ostringstream s;
+        s << "End of video file " << m_VideoFileName;
+        std::logic_error err( s.str() );
+        throw err;
+      }
+
+      // keep the current frame until the producer thread has grabbed the next one
+      return;
+    }
+
+    m_CurrentFrame = m_FrameQueue.front();
+    m_FrameQueue.pop_front();
+  }
+  m_FrameQueueNotFull.notify_one();
+  ++m_FrameCount;
+
+  m_CurrentFrameHeader = m_CurrentFrame.Pixels;
+  m_CurrentImage = &m_CurrentFrameHeader;
+
+  if(m_CaptureWidth == 0 || m_CaptureHeight == 0)
+  {
+    m_CaptureWidth  = m_CurrentImage->width;
+    m_CaptureHeight = m_CurrentImage->height;
+    MITK_INFO << "frame width: " << m_CaptureWidth << ", height: " << m_CaptureHeight;
+    m_CurrentImage->origin = 0;
+  }
+}
+
+void mitk::OpenCVVideoSource::StartProducerThread()
+{
+  m_FrameQueue.clear();
+  m_StopProducer = false;
+  m_EndOfVideo = false;
+  m_NumberOfGrabbedFrames = 0;
+  m_NumberOfDroppedFrames = 0;
+
+  m_ProducerThread = std::thread(&OpenCVVideoSource::ProduceFrames, this, std::max<std::size_t>(m_FrameQueueSize, 1));
+}
+
+void mitk::OpenCVVideoSource::StopProducerThread()
+{
+  if(!m_ProducerThread.joinable())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(m_FrameQueueMutex);
+    m_StopProducer = true;
+  }
+  m_FrameQueueNotFull.notify_all();
+  m_ProducerThread.join();
+
+  m_FrameQueue.clear();
+}
+
+void mitk::OpenCVVideoSource::ProduceFrames(std::size_t queueSize)
+{
+  // a video file is played completely, while a camera drops frames the consumer is too slow for
+  const bool dropFrames = m_VideoFileName.empty();
+
+  while(true)
+  {
+    Frame frame;
+    {
+      std::lock_guard<std::mutex> lock(m_CaptureMutex);
+      IplImage* capturedImage = cvQueryFrame(m_VideoCapture);
+
+      if(capturedImage == nullptr && m_RepeatVideo && cvGetCaptureProperty(m_VideoCapture, CV_CAP_PROP_POS_AVI_RATIO) >= 0.99)
+      {
+        MITK_DEBUG << "Restarting video file playback.";
+        cvSetCaptureProperty(m_VideoCapture, CV_CAP_PROP_POS_AVI_RATIO, 0);
+        capturedImage = cvQueryFrame(m_VideoCapture);
+      }
+
+      if(capturedImage == nullptr)
+      {
+        // FetchFrame() reports the end once the queued frames are consumed
+        std::lock_guard<std::mutex> queueLock(m_FrameQueueMutex);
+        m_EndOfVideo = true;
+        return;
+      }
+
+      frame = this->CreateFrame(capturedImage, m_UndistortImage && m_UndistortCameraImage.IsNotNull());
+    }
+    ++m_NumberOfGrabbedFrames;
+
+    std::unique_lock<std::mutex> lock(m_FrameQueueMutex);
+    if(dropFrames)
+    {
+      while(m_FrameQueue.size() >= queueSize)
+      {
+        m_FrameQueue.pop_front();
+        ++m_NumberOfDroppedFrames;
+      }
+    }
+    else
+    {
+      m_FrameQueueNotFull.wait(lock, [&] { return m_StopProducer || m_FrameQueue.size() < queueSize; });
+    }
+
+    if(m_StopProducer)
+      return;
+
+    m_FrameQueue.push_back(frame);
+  }
+}
+
+mitk::OpenCVVideoSource::Frame mitk::OpenCVVideoSource::CreateFrame(const IplImage* capturedImage, bool undistort)
+{
+  const cv::Mat captured = cv::cvarrToMat(capturedImage, false);
+  const bool isGrayscale = captured.channels() == 1;
+
+  Frame frame;
+
+  // 8 bit frames are written into the buffer of the image directly, other types are left to the filter
+  if(m_ConvertFramesToMitkImage && captured.depth() == CV_8U && (isGrayscale || captured.channels() == 3))
+  {
+    unsigned int dimensions[2] = { static_cast<unsigned int>(captured.cols), static_cast<unsigned int>(captured.rows) };
+    frame.Image = mitk::Image::New();
+    if(isGrayscale)
+      frame.Image->Initialize(mitk::MakeScalarPixelType<unsigned char>(), 2, dimensions);
+    else
+      frame.Image->Initialize(mitk::MakePixelType<RGBPixelImageType>(), 2, dimensions);
+  }
+
+  if(frame.Image.IsNotNull() && isGrayscale)
+  {
+    // the layout of grayscale frames matches the image, so the frame shares the buffer of the image
+    mitk::ImageWriteAccessor accessor(frame.Image);
+    frame.Pixels = cv::Mat(captured.rows, captured.cols, captured.type(), accessor.GetData());
+    captured.copyTo(frame.Pixels);
+  }
+  else
+  {
+    // the capture device reuses its buffer for the next frame
+    frame.Pixels = captured.clone();
+  }
+
+  if(undistort)
+  {
+    IplImage header = frame.Pixels;
+    m_UndistortCameraImage->UndistortImageFast(&header, nullptr);
+  }
+
+  if(frame.Image.IsNotNull() && !isGrayscale)
+  {
+    // OpenCV stores color frames as BGR, they are converted into the RGB buffer of the image in one pass
+    mitk::ImageWriteAccessor accessor(frame.Image);
+    cv::Mat imagePixels(captured.rows, captured.cols, CV_8UC3, accessor.GetData());
+    cv::cvtColor(frame.Pixels, imagePixels, cv::COLOR_BGR2RGB);
+  }
+  else if(frame.Image.IsNull() && m_ConvertFramesToMitkImage)
+  {
+    auto filter = mitk::OpenCVToMitkImageFilter::New();
+    filter->SetOpenCVMat(frame.Pixels);
+    filter->Update();
+    frame.Image = filter->GetOutput();
+  }
+
+  return frame;
+}
+
+mitk::Image::Pointer mitk::OpenCVVideoSource::GetCurrentFrameAsMitkImage()
+{
+  if(m_CurrentImage == &m_CurrentFrameHeader && m_CurrentFrame.Image.IsNotNull())
+    return m_CurrentFrame.Image;
+
+  if(m_CurrentImage == nullptr)
+    return nullptr;
+
+  auto filter = mitk::OpenCVToMitkImageFilter::New();
+  filter->SetOpenCVImage(m_CurrentImage);
+  filter->Update();
+  return filter->GetOutput();
+}
+
+unsigned long mitk::OpenCVVideoSource::GetNumberOfGrabbedFrames() const
+{
+  return m_NumberOfGrabbedFrames;
+}
+
+unsigned long mitk::OpenCVVideoSource::GetNumberOfDroppedFrames() const
+{
+  return m_NumberOfDroppedFrames;
+}
+
 void mitk::OpenCVVideoSource::UpdateVideoTexture()
 {  //write the grabbed frame into an opengl compatible array, that means flip it and swap channel order
   if(!m_CurrentImage)
@@ -209,13 +426,18 @@ void mitk::OpenCVVideoSource::UpdateVideoTexture()
 void mitk::OpenCVVideoSource::StartCapturing()
 {
   if(m_VideoCapture != nullptr)
+  {
     m_CapturingInProcess = true;
+    if(m_BackgroundCapturing && !m_ProducerThread.joinable())
+      this->StartProducerThread();
+  }
   else
     m_CapturingInProcess = false;
 }
 
 void mitk::OpenCVVideoSource::StopCapturing()
 {
+  this->StopProducerThread();
   m_CapturePaused = false;
   m_CapturingInProcess = false;
 }
@@ -249,19 +471,23 @@ void mitk::OpenCVVideoSource::PauseCapturing()
 void mitk::OpenCVVideoSource::EnableOnlineImageUndistortion(mitk::Point3D focal, mitk::Point3D principal, mitk::Point4D distortion)
 {
   // Initialize Undistortion
-  m_UndistortImage = true;
   float kc[4];
   kc[0] = distortion[0]; kc[1] = distortion[1];
   kc[2] = distortion[2]; kc[3] = distortion[3];
   if(m_CaptureWidth == 0 || m_CaptureHeight == 0)
     FetchFrame();
 
-  m_UndistortCameraImage = mitk::UndistortCameraImage::New();
-  m_UndistortCameraImage->SetUndistortImageFastInfo(focal[0], focal[1], principal[0], principal[1],  kc, (float)m_CaptureWidth, (float)m_CaptureHeight);
+  mitk::UndistortCameraImage::Pointer undistortCameraImage = mitk::UndistortCameraImage::New();
+  undistortCameraImage->SetUndistortImageFastInfo(focal[0], focal[1], principal[0], principal[1],  kc, (float)m_CaptureWidth, (float)m_CaptureHeight);
+
+  std::lock_guard<std::mutex> lock(m_CaptureMutex);
+  m_UndistortImage = true;
+  m_UndistortCameraImage = undistortCameraImage;
 }
 
 void mitk::OpenCVVideoSource::DisableOnlineImageUndistortion()
 {
+  std::lock_guard<std::mutex> lock(m_CaptureMutex);
   m_UndistortImage = false;
 }
 
@@ -393,6 +619,7 @@ void mitk::OpenCVVideoSource::Reset()
     cvReleaseCapture(&m_VideoCapture);
   m_VideoCapture = nullptr;
   m_CurrentImage = nullptr;
+  m_CurrentFrame = Frame();
   m_CaptureWidth = 0;
   m_CaptureHeight = 0;
   delete m_CurrentVideoTexture;
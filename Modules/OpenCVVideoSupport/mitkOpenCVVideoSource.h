@@ -27,6 +27,14 @@ found in the LICENSE file.
 #include "itkImageRegionIterator.h"
 #include "mitkOpenCVImageSource.h"
 
+#include <mitkImage.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 namespace mitk
 {
  /**
@@ -135,6 +143,41 @@ namespace mitk
     itkGetMacro( RepeatVideo, bool );
     itkSetMacro( RepeatVideo, bool );
 
+    ////##Documentation
+    ////## @brief Grab, copy and undistort the frames on a producer thread while capturing (default: false).
+    ////## FetchFrame() then takes the next frame from a queue and never waits for the device, it keeps the
+    ////## current frame if no new one is available yet. Takes effect with the next StartCapturing().
+    itkSetMacro( BackgroundCapturing, bool );
+    itkGetConstMacro( BackgroundCapturing, bool );
+    itkBooleanMacro( BackgroundCapturing );
+
+    ////##Documentation
+    ////## @brief Maximum number of frames waiting in the queue of the producer thread (default: 2).
+    ////## If the queue is full, a camera drops its oldest frame, while a video file waits for the consumer.
+    itkSetMacro( FrameQueueSize, unsigned int );
+    itkGetConstMacro( FrameQueueSize, unsigned int );
+
+    ////##Documentation
+    ////## @brief Convert the frames to mitk::Images on the producer thread (default: false), see GetCurrentFrameAsMitkImage().
+    itkSetMacro( ConvertFramesToMitkImage, bool );
+    itkGetConstMacro( ConvertFramesToMitkImage, bool );
+
+    ////##Documentation
+    ////## @brief returns the current frame as an mitk::Image.
+    ////## With background capturing and ConvertFramesToMitkImage, this is the image created on the producer thread:
+    ////## 8 bit grayscale frames share their buffer with the image, 8 bit color frames are converted into the
+    ////## buffer of the image in a single pass. Otherwise the frame is converted by an OpenCVToMitkImageFilter.
+    virtual mitk::Image::Pointer GetCurrentFrameAsMitkImage();
+
+    ////##Documentation
+    ////## @brief returns the number of frames the producer thread grabbed since capturing was started.
+    unsigned long GetNumberOfGrabbedFrames() const;
+
+    ////##Documentation
+    ////## @brief returns the number of frames the producer thread dropped since capturing was started,
+    ////## because the queue was full.
+    unsigned long GetNumberOfDroppedFrames() const;
+
 
   protected:
     OpenCVVideoSource();
@@ -150,6 +193,35 @@ namespace mitk
     ////## so that GetVideoTexture() can be used.
     void UpdateVideoTexture();
 
+    ///
+    /// A frame grabbed by the producer thread, see SetBackgroundCapturing()
+    ///
+    struct Frame
+    {
+      cv::Mat Pixels;
+      /// The frame as mitk::Image if ConvertFramesToMitkImage is on
+      mitk::Image::Pointer Image;
+    };
+
+    void StartProducerThread();
+    void StopProducerThread();
+
+    ///
+    /// Loop of the producer thread: grabs frames and puts them into the frame queue
+    ///
+    void ProduceFrames(std::size_t queueSize);
+
+    ///
+    /// Copies the frame out of the buffer of the capture device, which is reused for the next frame,
+    /// and creates its mitk::Image if ConvertFramesToMitkImage is on
+    ///
+    Frame CreateFrame(const IplImage* capturedImage, bool undistort);
+
+    ///
+    /// Takes the next frame of the queue for FetchFrame(), if there is one
+    ///
+    void FetchQueuedFrame();
+
     // Helper functions
     void sleep(unsigned int ms);
     void RGBtoHSV(float r, float g, float b, float &h, float &s, float &v);
@@ -190,6 +262,31 @@ namespace mitk
     * Flag to enable or disable video flipping by Y Axis.
     **/
     bool m_FlipYAxisEnabled;
+
+    bool m_BackgroundCapturing;
+    unsigned int m_FrameQueueSize;
+    bool m_ConvertFramesToMitkImage;
+
+    ///
+    /// Guards m_VideoCapture and the undistortion settings while the producer thread runs
+    std::mutex m_CaptureMutex;
+
+    ///
+    /// Guards the frame queue and the state of the producer thread
+    std::mutex m_FrameQueueMutex;
+    std::condition_variable m_FrameQueueNotFull;
+    std::deque<Frame> m_FrameQueue;
+    std::thread m_ProducerThread;
+    bool m_StopProducer;
+    bool m_EndOfVideo;
+
+    std::atomic<unsigned long> m_NumberOfGrabbedFrames;
+    std::atomic<unsigned long> m_NumberOfDroppedFrames;
+
+    ///
+    /// The frame taken from the queue by FetchFrame(), m_CurrentImage points to m_CurrentFrameHeader then
+    Frame m_CurrentFrame;
+    IplImage m_CurrentFrameHeader;
   };
 }
 #endif // Header
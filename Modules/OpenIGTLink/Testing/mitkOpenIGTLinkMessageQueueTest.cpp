@@ -0,0 +1,143 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestingMacros.h>
+#include <mitkTestFixture.h>
+
+#include <mitkIGTLMessageQueue.h>
+
+#include <igtlTransformMessage.h>
+
+#include <numeric>
+#include <thread>
+
+class mitkOpenIGTLinkMessageQueueTestSuite : public mitk::TestFixture {
+CPPUNIT_TEST_SUITE(mitkOpenIGTLinkMessageQueueTestSuite);
+MITK_TEST(Test_RingBuffer_KeepsOrder);
+MITK_TEST(Test_RingBuffer_OverwritesOldest);
+MITK_TEST(Test_RingBuffer_DropsNewest);
+MITK_TEST(Test_RingBuffer_ConcurrentPushAndPull);
+CPPUNIT_TEST_SUITE_END();
+
+private:
+
+mitk::IGTLMessageQueue::Pointer m_MessageQueue;
+
+igtl::TransformMessage::Pointer CreateMessage(unsigned int timeStamp)
+{
+igtl::TransformMessage::Pointer message = igtl::TransformMessage::New();
+message->SetTimeStamp(timeStamp, 0);
+return message;
+}
+
+unsigned int GetTimeStamp(igtl::MessageBase *message)
+{
+unsigned int seconds = 0;
+unsigned int nanoseconds = 0;
+message->GetTimeStamp(&seconds, &nanoseconds);
+return seconds;
+}
+
+public:
+
+void setUp() override
+{
+m_MessageQueue = mitk::IGTLMessageQueue::New();
+}
+
+void tearDown() override
+{
+m_MessageQueue = nullptr;
+}
+
+void Test_RingBuffer_KeepsOrder()
+{
+m_MessageQueue->EnableRingBufferMode(8);
+
+for (unsigned int i = 1; i <= 5; ++i)
+m_MessageQueue->PushMessage(this->CreateMessage(i).GetPointer());
+
+CPPUNIT_ASSERT_EQUAL(5, m_MessageQueue->GetSize());
+
+for (unsigned int i = 1; i <= 5; ++i)
+{
+igtl::TransformMessage::Pointer message = m_MessageQueue->PullTransformMessage();
+CPPUNIT_ASSERT_MESSAGE("The queue returned no message", message.IsNotNull());
+CPPUNIT_ASSERT_EQUAL(i, this->GetTimeStamp(message));
+}
+
+CPPUNIT_ASSERT_MESSAGE("The queue is not empty", m_MessageQueue->PullTransformMessage().IsNull());
+
+std::vector<std::uint64_t> histogram = m_MessageQueue->GetLatencyHistogram();
+CPPUNIT_ASSERT_EQUAL(std::uint64_t(5), std::accumulate(histogram.begin(), histogram.end(), std::uint64_t(0)));
+}
+
+void Test_RingBuffer_OverwritesOldest()
+{
+m_MessageQueue->EnableRingBufferMode(4, true);
+
+for (unsigned int i = 1; i <= 10; ++i)
+m_MessageQueue->PushMessage(this->CreateMessage(i).GetPointer());
+
+CPPUNIT_ASSERT_EQUAL(std::uint64_t(6), m_MessageQueue->GetNumberOfDiscardedMessages());
+
+for (unsigned int i = 7; i <= 10; ++i)
+CPPUNIT_ASSERT_EQUAL(i, this->GetTimeStamp(m_MessageQueue->PullTransformMessage()));
+
+CPPUNIT_ASSERT_MESSAGE("The queue is not empty", m_MessageQueue->PullTransformMessage().IsNull());
+}
+
+void Test_RingBuffer_DropsNewest()
+{
+m_MessageQueue->EnableRingBufferMode(4, false);
+
+for (unsigned int i = 1; i <= 10; ++i)
+m_MessageQueue->PushMessage(this->CreateMessage(i).GetPointer());
+
+CPPUNIT_ASSERT_EQUAL(std::uint64_t(6), m_MessageQueue->GetNumberOfDiscardedMessages());
+
+for (unsigned int i = 1; i <= 4; ++i)
+CPPUNIT_ASSERT_EQUAL(i, this->GetTimeStamp(m_MessageQueue->PullTransformMessage()));
+
+CPPUNIT_ASSERT_MESSAGE("The queue is not empty", m_MessageQueue->PullTransformMessage().IsNull());
+}
+
+void Test_RingBuffer_ConcurrentPushAndPull()
+{
+const unsigned int numberOfMessages = 10000;
+m_MessageQueue->EnableRingBufferMode(16, true);
+
+std::thread producer([this, numberOfMessages]() {
+for (unsigned int i = 1; i <= numberOfMessages; ++i)
+m_MessageQueue->PushMessage(this->CreateMessage(i).GetPointer());
+});
+
+unsigned int lastTimeStamp = 0;
+while (lastTimeStamp != numberOfMessages)
+{
+igtl::TransformMessage::Pointer message = m_MessageQueue->PullTransformMessage();
+if (message.IsNull())
+{
+std::this_thread::yield();
+continue;
+}
+
+unsigned int timeStamp = this->GetTimeStamp(message);
+CPPUNIT_ASSERT_MESSAGE("The messages are out of order", timeStamp > lastTimeStamp);
+lastTimeStamp = timeStamp;
+}
+
+producer.join();
+}
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkOpenIGTLinkMessageQueue)
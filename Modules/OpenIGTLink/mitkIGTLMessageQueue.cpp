@@ -11,6 +11,7 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkIGTLMessageQueue.h"
+#include <algorithm>
 #include <string>
 #include "igtlMessageBase.h"
 
@@ -26,6 +27,12 @@ void mitk::IGTLMessageQueue::PushSendMessage(mitk::IGTLMessage::Pointer message)
 
 void mitk::IGTLMessageQueue::PushCommandMessage(igtl::MessageBase::Pointer message)
 {
+  if (this->m_BufferingType == IGTLMessageQueue::RingBuffer)
+  {
+    m_CommandRingBuffer->Push(std::move(message));
+    return;
+  }
+
   this->m_Mutex->Lock();
   if (this->m_BufferingType == IGTLMessageQueue::NoBuffering)
     m_CommandQueue.clear();
@@ -36,6 +43,41 @@ void mitk::IGTLMessageQueue::PushCommandMessage(igtl::MessageBase::Pointer messa
 
 void mitk::IGTLMessageQueue::PushMessage(igtl::MessageBase::Pointer msg)
 {
+  if (this->m_BufferingType == IGTLMessageQueue::RingBuffer)
+  {
+    // only the information getters share the mutex with the receiving thread now
+    this->m_Mutex->Lock();
+    m_Latest_Message = msg;
+    this->m_Mutex->Unlock();
+
+    if (auto *trackingDataMsg = dynamic_cast<igtl::TrackingDataMessage*>(msg.GetPointer()))
+    {
+      m_TrackingDataRingBuffer->Push(igtl::TrackingDataMessage::Pointer(trackingDataMsg));
+    }
+    else if (auto *transformMsg = dynamic_cast<igtl::TransformMessage*>(msg.GetPointer()))
+    {
+      m_TransformRingBuffer->Push(igtl::TransformMessage::Pointer(transformMsg));
+    }
+    else if (auto *stringMsg = dynamic_cast<igtl::StringMessage*>(msg.GetPointer()))
+    {
+      m_StringRingBuffer->Push(igtl::StringMessage::Pointer(stringMsg));
+    }
+    else if (auto *imageMsg = dynamic_cast<igtl::ImageMessage*>(msg.GetPointer()))
+    {
+      int dim[3];
+      imageMsg->GetDimensions(dim);
+      if (dim[2] > 1)
+        m_Image3dRingBuffer->Push(igtl::ImageMessage::Pointer(imageMsg));
+      else
+        m_Image2dRingBuffer->Push(igtl::ImageMessage::Pointer(imageMsg));
+    }
+    else
+    {
+      m_MiscRingBuffer->Push(std::move(msg));
+    }
+    return;
+  }
+
   this->m_Mutex->Lock();
 
   std::stringstream infolog;
@@ -126,6 +168,12 @@ mitk::IGTLMessage::Pointer mitk::IGTLMessageQueue::PullSendMessage()
 igtl::MessageBase::Pointer mitk::IGTLMessageQueue::PullMiscMessage()
 {
   igtl::MessageBase::Pointer ret = nullptr;
+  if (this->m_BufferingType == IGTLMessageQueue::RingBuffer)
+  {
+    m_MiscRingBuffer->Pull(ret);
+    return ret;
+  }
+
   this->m_Mutex->Lock();
   if (this->m_MiscQueue.size() > 0)
   {
@@ -139,6 +187,12 @@ igtl::MessageBase::Pointer mitk::IGTLMessageQueue::PullMiscMessage()
 igtl::ImageMessage::Pointer mitk::IGTLMessageQueue::PullImage2dMessage()
 {
   igtl::ImageMessage::Pointer ret = nullptr;
+  if (this->m_BufferingType == IGTLMessageQueue::RingBuffer)
+  {
+    m_Image2dRingBuffer->Pull(ret);
+    return ret;
+  }
+
   this->m_Mutex->Lock();
   if (this->m_Image2dQueue.size() > 0)
   {
@@ -152,6 +206,12 @@ igtl::ImageMessage::Pointer mitk::IGTLMessageQueue::PullImage2dMessage()
 igtl::ImageMessage::Pointer mitk::IGTLMessageQueue::PullImage3dMessage()
 {
   igtl::ImageMessage::Pointer ret = nullptr;
+  if (this->m_BufferingType == IGTLMessageQueue::RingBuffer)
+  {
+    m_Image3dRingBuffer->Pull(ret);
+    return ret;
+  }
+
   this->m_Mutex->Lock();
   if (this->m_Image3dQueue.size() > 0)
   {
@@ -165,6 +225,12 @@ igtl::ImageMessage::Pointer mitk::IGTLMessageQueue::PullImage3dMessage()
 igtl::TrackingDataMessage::Pointer mitk::IGTLMessageQueue::PullTrackingMessage()
 {
   igtl::TrackingDataMessage::Pointer ret = nullptr;
+  if (this->m_BufferingType == IGTLMessageQueue::RingBuffer)
+  {
+    m_TrackingDataRingBuffer->Pull(ret);
+    return ret;
+  }
+
   this->m_Mutex->Lock();
   if (this->m_TrackingDataQueue.size() > 0)
   {
@@ -178,6 +244,12 @@ igtl::TrackingDataMessage::Pointer mitk::IGTLMessageQueue::PullTrackingMessage()
 igtl::MessageBase::Pointer mitk::IGTLMessageQueue::PullCommandMessage()
 {
   igtl::MessageBase::Pointer ret = nullptr;
+  if (this->m_BufferingType == IGTLMessageQueue::RingBuffer)
+  {
+    m_CommandRingBuffer->Pull(ret);
+    return ret;
+  }
+
   this->m_Mutex->Lock();
   if (this->m_CommandQueue.size() > 0)
   {
@@ -191,6 +263,12 @@ igtl::MessageBase::Pointer mitk::IGTLMessageQueue::PullCommandMessage()
 igtl::StringMessage::Pointer mitk::IGTLMessageQueue::PullStringMessage()
 {
   igtl::StringMessage::Pointer ret = nullptr;
+  if (this->m_BufferingType == IGTLMessageQueue::RingBuffer)
+  {
+    m_StringRingBuffer->Pull(ret);
+    return ret;
+  }
+
   this->m_Mutex->Lock();
   if (this->m_StringQueue.size() > 0)
   {
@@ -204,6 +282,12 @@ igtl::StringMessage::Pointer mitk::IGTLMessageQueue::PullStringMessage()
 igtl::TransformMessage::Pointer mitk::IGTLMessageQueue::PullTransformMessage()
 {
   igtl::TransformMessage::Pointer ret = nullptr;
+  if (this->m_BufferingType == IGTLMessageQueue::RingBuffer)
+  {
+    m_TransformRingBuffer->Pull(ret);
+    return ret;
+  }
+
   this->m_Mutex->Lock();
   if (this->m_TransformQueue.size() > 0)
   {
@@ -282,6 +366,13 @@ std::string mitk::IGTLMessageQueue::GetLatestMsgDeviceType()
 
 int mitk::IGTLMessageQueue::GetSize()
 {
+  if (this->m_BufferingType == IGTLMessageQueue::RingBuffer)
+  {
+    return (m_CommandRingBuffer->GetSize() + m_Image2dRingBuffer->GetSize() + m_Image3dRingBuffer->GetSize()
+      + m_MiscRingBuffer->GetSize() + m_StringRingBuffer->GetSize() + m_TrackingDataRingBuffer->GetSize()
+      + m_TransformRingBuffer->GetSize());
+  }
+
   return (this->m_CommandQueue.size() + this->m_Image2dQueue.size() + this->m_Image3dQueue.size() + this->m_MiscQueue.size()
     + this->m_StringQueue.size() + this->m_TrackingDataQueue.size() + this->m_TransformQueue.size());
 }
@@ -296,6 +387,73 @@ void mitk::IGTLMessageQueue::EnableNoBufferingMode(bool enable)
   this->m_Mutex->Unlock();
 }
 
+void mitk::IGTLMessageQueue::EnableRingBufferMode(unsigned int capacity, bool overwriteOldest)
+{
+  this->m_Mutex->Lock();
+  m_CommandQueue.clear();
+  m_Image2dQueue.clear();
+  m_Image3dQueue.clear();
+  m_TransformQueue.clear();
+  m_TrackingDataQueue.clear();
+  m_StringQueue.clear();
+  m_MiscQueue.clear();
+
+  const std::size_t size = std::max(1u, capacity);
+  m_CommandRingBuffer.reset(new IGTLMessageRingBuffer<igtl::MessageBase::Pointer>(size, overwriteOldest));
+  m_Image2dRingBuffer.reset(new IGTLMessageRingBuffer<igtl::ImageMessage::Pointer>(size, overwriteOldest));
+  m_Image3dRingBuffer.reset(new IGTLMessageRingBuffer<igtl::ImageMessage::Pointer>(size, overwriteOldest));
+  m_TransformRingBuffer.reset(new IGTLMessageRingBuffer<igtl::TransformMessage::Pointer>(size, overwriteOldest));
+  m_TrackingDataRingBuffer.reset(
+    new IGTLMessageRingBuffer<igtl::TrackingDataMessage::Pointer>(size, overwriteOldest));
+  m_StringRingBuffer.reset(new IGTLMessageRingBuffer<igtl::StringMessage::Pointer>(size, overwriteOldest));
+  m_MiscRingBuffer.reset(new IGTLMessageRingBuffer<igtl::MessageBase::Pointer>(size, overwriteOldest));
+
+  this->m_BufferingType = IGTLMessageQueue::RingBuffer;
+  this->m_Mutex->Unlock();
+}
+
+std::vector<std::uint64_t> mitk::IGTLMessageQueue::GetLatencyHistogram() const
+{
+  std::vector<std::uint64_t> histogram;
+  if (m_CommandRingBuffer == nullptr)
+    return histogram;
+
+  histogram.resize(IGTLMessageRingBuffer<igtl::MessageBase::Pointer>::NumberOfLatencyBuckets, 0);
+  m_CommandRingBuffer->AddLatencyHistogramTo(histogram);
+  m_Image2dRingBuffer->AddLatencyHistogramTo(histogram);
+  m_Image3dRingBuffer->AddLatencyHistogramTo(histogram);
+  m_TransformRingBuffer->AddLatencyHistogramTo(histogram);
+  m_TrackingDataRingBuffer->AddLatencyHistogramTo(histogram);
+  m_StringRingBuffer->AddLatencyHistogramTo(histogram);
+  m_MiscRingBuffer->AddLatencyHistogramTo(histogram);
+  return histogram;
+}
+
+void mitk::IGTLMessageQueue::ResetLatencyHistogram()
+{
+  if (m_CommandRingBuffer == nullptr)
+    return;
+
+  m_CommandRingBuffer->ResetLatencyHistogram();
+  m_Image2dRingBuffer->ResetLatencyHistogram();
+  m_Image3dRingBuffer->ResetLatencyHistogram();
+  m_TransformRingBuffer->ResetLatencyHistogram();
+  m_TrackingDataRingBuffer->ResetLatencyHistogram();
+  m_StringRingBuffer->ResetLatencyHistogram();
+  m_MiscRingBuffer->ResetLatencyHistogram();
+}
+
+std::uint64_t mitk::IGTLMessageQueue::GetNumberOfDiscardedMessages() const
+{
+  if (m_CommandRingBuffer == nullptr)
+    return 0;
+
+  return m_CommandRingBuffer->GetNumberOfDiscardedMessages() + m_Image2dRingBuffer->GetNumberOfDiscardedMessages()
+    + m_Image3dRingBuffer->GetNumberOfDiscardedMessages() + m_TransformRingBuffer->GetNumberOfDiscardedMessages()
+    + m_TrackingDataRingBuffer->GetNumberOfDiscardedMessages() + m_StringRingBuffer->GetNumberOfDiscardedMessages()
+    + m_MiscRingBuffer->GetNumberOfDiscardedMessages();
+}
+
 mitk::IGTLMessageQueue::IGTLMessageQueue()
 {
   this->m_Mutex = itk::FastMutexLock::New();
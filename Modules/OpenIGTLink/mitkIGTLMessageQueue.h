@@ -19,8 +19,11 @@ found in the LICENSE file.
 #include "itkFastMutexLock.h"
 #include "mitkCommon.h"
 
+#include <atomic>
 #include <deque>
+#include <memory>
 #include <mitkIGTLMessage.h>
+#include <mitkIGTLMessageRingBuffer.h>
 
 //OpenIGTLink
 #include "igtlMessageBase.h"
@@ -34,6 +37,11 @@ namespace mitk {
   * \class IGTLMessageQueue
   * \brief Thread safe message queue to store OpenIGTLink messages.
   *
+  * In the RingBuffer mode (see EnableRingBufferMode()), the received messages are stored in lock-free
+  * single-producer/single-consumer ring buffers instead of mutex guarded queues. The messages must then be pushed
+  * by a single thread (the receiving thread of the IGTLDevice) and pulled by a single other thread. The send queue
+  * is not affected, since messages may be sent from any thread.
+  *
   * \ingroup OpenIGTLink
   */
   class MITKOPENIGTLINK_EXPORT IGTLMessageQueue : public itk::Object
@@ -47,8 +55,9 @@ namespace mitk {
        * \brief Different buffering types
        * Infinit buffering means that you can push as many messages as you want
        * NoBuffering means that the queue just stores a single message
+       * RingBuffer means that the queue stores up to a fixed number of messages without locking
        */
-    enum BufferingType { Infinit, NoBuffering };
+    enum BufferingType { Infinit, NoBuffering, RingBuffer };
 
     void PushSendMessage(mitk::IGTLMessage::Pointer message);
 
@@ -104,6 +113,29 @@ namespace mitk {
      */
     void EnableNoBufferingMode(bool enable);
 
+    /**
+    * \brief Switches the received messages to lock-free ring buffers with the given capacity per message type
+    *
+    * If overwriteOldest is true, a full buffer overwrites its oldest message, otherwise new messages are dropped.
+    * Messages that are still queued are discarded. Must not be called while messages are pushed or pulled.
+    */
+    void EnableRingBufferMode(unsigned int capacity, bool overwriteOldest = true);
+
+    /**
+    * \brief Returns the latency histogram of the ring buffers, i.e. how long the pulled messages were queued
+    *
+    * Element i counts the messages that were queued for less than 2^i microseconds, the last element counts all
+    * longer latencies. The histogram is empty if the ring buffer mode was never enabled.
+    */
+    std::vector<std::uint64_t> GetLatencyHistogram() const;
+
+    void ResetLatencyHistogram();
+
+    /**
+    * \brief Returns the number of messages that were overwritten or dropped by full ring buffers
+    */
+    std::uint64_t GetNumberOfDiscardedMessages() const;
+
   protected:
     IGTLMessageQueue();
     ~IGTLMessageQueue() override;
@@ -129,10 +161,21 @@ namespace mitk {
 
     igtl::MessageBase::Pointer m_Latest_Message;
 
+    /**
+    * \brief the lock-free buffers of the RingBuffer mode
+    */
+    std::unique_ptr< IGTLMessageRingBuffer< igtl::MessageBase::Pointer > > m_CommandRingBuffer;
+    std::unique_ptr< IGTLMessageRingBuffer< igtl::ImageMessage::Pointer > > m_Image2dRingBuffer;
+    std::unique_ptr< IGTLMessageRingBuffer< igtl::ImageMessage::Pointer > > m_Image3dRingBuffer;
+    std::unique_ptr< IGTLMessageRingBuffer< igtl::TransformMessage::Pointer > > m_TransformRingBuffer;
+    std::unique_ptr< IGTLMessageRingBuffer< igtl::TrackingDataMessage::Pointer > > m_TrackingDataRingBuffer;
+    std::unique_ptr< IGTLMessageRingBuffer< igtl::StringMessage::Pointer > > m_StringRingBuffer;
+    std::unique_ptr< IGTLMessageRingBuffer< igtl::MessageBase::Pointer > > m_MiscRingBuffer;
+
     /**
     * \brief defines the kind of buffering
     */
-    BufferingType m_BufferingType;
+    std::atomic<BufferingType> m_BufferingType;
   };
 }
 
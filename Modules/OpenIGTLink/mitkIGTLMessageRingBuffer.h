@@ -0,0 +1,220 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkIGTLMessageRingBuffer_h
+#define mitkIGTLMessageRingBuffer_h
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace mitk {
+  /**
+  * \class IGTLMessageRingBuffer
+  * \brief Lock-free single-producer/single-consumer ring buffer for OpenIGTLink messages.
+  *
+  * Push() must only be called by one thread (e.g. the receiving thread of an IGTLDevice) and Pull() only by
+  * one other thread. Messages are moved into and out of the buffer, they are never copied or cloned.
+  *
+  * If the buffer is full, Push() either overwrites the oldest message (for streams like tracking data or
+  * ultrasound images, where only recent messages matter) or drops the new one.
+  *
+  * The time each message spent in the buffer is collected in a latency histogram for diagnostics.
+  *
+  * \ingroup OpenIGTLink
+  */
+  template <typename T>
+  class IGTLMessageRingBuffer
+  {
+  public:
+    /**
+    * \brief Number of buckets of the latency histogram. Bucket i counts latencies below 2^i microseconds
+    * (and at least 2^(i-1) microseconds), the last bucket counts all longer latencies.
+    */
+    static const unsigned int NumberOfLatencyBuckets = 22;
+
+    /**
+    * \param capacity the maximum number of messages, rounded up to the next power of two
+    */
+    IGTLMessageRingBuffer(std::size_t capacity, bool overwriteOldest)
+      : m_Slots(GetNextPowerOfTwo(capacity)),
+        m_Head(0),
+        m_Tail(0),
+        m_OverwriteOldest(overwriteOldest),
+        m_NumberOfDiscardedMessages(0)
+    {
+      for (auto &slot : m_Slots)
+        slot.store(nullptr, std::memory_order_relaxed);
+
+      for (auto &bucket : m_LatencyHistogram)
+        bucket.store(0, std::memory_order_relaxed);
+    }
+
+    ~IGTLMessageRingBuffer()
+    {
+      for (auto &slot : m_Slots)
+        delete slot.load(std::memory_order_relaxed);
+    }
+
+    IGTLMessageRingBuffer(const IGTLMessageRingBuffer &) = delete;
+    IGTLMessageRingBuffer &operator=(const IGTLMessageRingBuffer &) = delete;
+
+    /**
+    * \brief Adds the message to the buffer. Must only be called by the producer thread.
+    * \return false if the buffer is full and does not overwrite the oldest message
+    */
+    bool Push(T &&message)
+    {
+      const std::uint64_t sequence = m_Head.load(std::memory_order_relaxed);
+
+      if (!m_OverwriteOldest && sequence - m_Tail.load(std::memory_order_acquire) >= m_Slots.size())
+      {
+        m_NumberOfDiscardedMessages.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+
+      Node *node = new Node{sequence, std::move(message), std::chrono::steady_clock::now()};
+      Node *overwrittenNode = m_Slots[sequence & (m_Slots.size() - 1)].exchange(node, std::memory_order_acq_rel);
+
+      if (overwrittenNode != nullptr)
+      {
+        delete overwrittenNode;
+        m_NumberOfDiscardedMessages.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      m_Head.store(sequence + 1, std::memory_order_release);
+      return true;
+    }
+
+    /**
+    * \brief Moves the oldest message of the buffer into message. Must only be called by the consumer thread.
+    * \return false if the buffer is empty
+    */
+    bool Pull(T &message)
+    {
+      std::uint64_t sequence = m_Tail.load(std::memory_order_relaxed);
+
+      for (;;)
+      {
+        // the last pulled message may have been published to its slot before the head was advanced
+        const std::uint64_t head = m_Head.load(std::memory_order_acquire);
+        if (head <= sequence)
+          return false;
+
+        // the producer has overwritten the messages up to here
+        if (head - sequence > m_Slots.size())
+          sequence = head - m_Slots.size();
+
+        Node *node = m_Slots[sequence & (m_Slots.size() - 1)].exchange(nullptr, std::memory_order_acq_rel);
+
+        if (node == nullptr || node->Sequence < sequence)
+        {
+          // an older message which cannot be returned anymore without breaking the order
+          if (node != nullptr)
+          {
+            delete node;
+            m_NumberOfDiscardedMessages.fetch_add(1, std::memory_order_relaxed);
+          }
+          ++sequence;
+          continue;
+        }
+
+        // a newer message than expected means that all older ones have been overwritten meanwhile
+        sequence = node->Sequence + 1;
+        m_Tail.store(sequence, std::memory_order_release);
+
+        this->AddLatency(std::chrono::steady_clock::now() - node->PushTime);
+        message = std::move(node->Message);
+        delete node;
+        return true;
+      }
+    }
+
+    /**
+    * \brief Returns the number of messages in the buffer. The result is only a snapshot if the buffer is in use.
+    */
+    std::size_t GetSize() const
+    {
+      const std::uint64_t head = m_Head.load(std::memory_order_acquire);
+      const std::uint64_t tail = m_Tail.load(std::memory_order_acquire);
+      return head > tail ? static_cast<std::size_t>(std::min<std::uint64_t>(head - tail, m_Slots.size())) : 0;
+    }
+
+    std::size_t GetCapacity() const { return m_Slots.size(); }
+
+    /**
+    * \brief Returns the number of messages that were overwritten or dropped because the buffer was full.
+    */
+    std::uint64_t GetNumberOfDiscardedMessages() const
+    {
+      return m_NumberOfDiscardedMessages.load(std::memory_order_relaxed);
+    }
+
+    /**
+    * \brief Adds the latency histogram of this buffer to histogram, which must have NumberOfLatencyBuckets elements.
+    */
+    void AddLatencyHistogramTo(std::vector<std::uint64_t> &histogram) const
+    {
+      for (unsigned int i = 0; i < NumberOfLatencyBuckets; ++i)
+        histogram[i] += m_LatencyHistogram[i].load(std::memory_order_relaxed);
+    }
+
+    void ResetLatencyHistogram()
+    {
+      for (auto &bucket : m_LatencyHistogram)
+        bucket.store(0, std::memory_order_relaxed);
+    }
+
+  private:
+    struct Node
+    {
+      std::uint64_t Sequence;
+      T Message;
+      std::chrono::steady_clock::time_point PushTime;
+    };
+
+    static std::size_t GetNextPowerOfTwo(std::size_t value)
+    {
+      std::size_t powerOfTwo = 1;
+      while (powerOfTwo < value)
+        powerOfTwo *= 2;
+      return powerOfTwo;
+    }
+
+    void AddLatency(std::chrono::steady_clock::duration latency)
+    {
+      auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+
+      unsigned int bucket = 0;
+      while (microseconds > 0 && bucket + 1 < NumberOfLatencyBuckets)
+      {
+        microseconds /= 2;
+        ++bucket;
+      }
+
+      m_LatencyHistogram[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::vector<std::atomic<Node *>> m_Slots;
+    std::atomic<std::uint64_t> m_Head;
+    std::atomic<std::uint64_t> m_Tail;
+    const bool m_OverwriteOldest;
+    std::atomic<std::uint64_t> m_NumberOfDiscardedMessages;
+    std::array<std::atomic<std::uint64_t>, NumberOfLatencyBuckets> m_LatencyHistogram;
+  };
+}
+
+#endif
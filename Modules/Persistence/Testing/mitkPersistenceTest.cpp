@@ -96,6 +96,7 @@ public:
 
     std::string testTempFile = mitk::IOUtil::CreateTemporaryFile("XXXXXX.mitk");
     std::string testXmlTempFile = mitk::IOUtil::CreateTemporaryFile("PersistenceTestFileXXXXXX.xml");
+    std::string testBinaryTempFile = mitk::IOUtil::CreateTemporaryFile("PersistenceTestFileXXXXXX.mitkpl");
 
     MITK_INFO << "Testing standard write to scene file/xml file.";
     PersistenceTestClass testClass;
@@ -105,6 +106,7 @@ public:
     testClass.param3 = param3;
     CPPUNIT_ASSERT_MESSAGE("Testing to save a scene file", testClass.Save(testTempFile));
     CPPUNIT_ASSERT_MESSAGE("testing to save an xml file", testClass.Save(testXmlTempFile));
+    CPPUNIT_ASSERT_MESSAGE("testing to save a binary file", testClass.Save(testBinaryTempFile));
 
     CPPUNIT_ASSERT_MESSAGE("Testing read from scene file: persistenceService->RemovePropertyList(testClassId)",
                            persistenceService->RemovePropertyList(testClassId));
@@ -124,6 +126,21 @@ public:
 
     testParams(testClass3, "testClass3");
 
+    // saving changed values again appends them to the binary file
+    testClass3.param1 = param1 + 1;
+    CPPUNIT_ASSERT_MESSAGE("Testing incremental write to binary file", testClass3.Save(testBinaryTempFile));
+    testClass3.param1 = param1;
+    CPPUNIT_ASSERT_MESSAGE("Testing incremental write to binary file", testClass3.Save(testBinaryTempFile));
+
+    CPPUNIT_ASSERT_MESSAGE("Testing read from binary file: persistenceService->RemovePropertyList(testClassId)",
+                           persistenceService->RemovePropertyList(testClassId));
+    PersistenceTestClass testClassBinary;
+    testClassBinary.id = testClassId;
+    CPPUNIT_ASSERT_MESSAGE("Testing read from binary file: testClassBinary.Load(testBinaryTempFile)",
+                           testClassBinary.Load(testBinaryTempFile));
+
+    testParams(testClassBinary, "testClassBinary");
+
     CPPUNIT_ASSERT_MESSAGE(
       "Testing appendChanges functionality with scene load/write: persistenceService->RemovePropertyList(testClassId)",
       persistenceService->RemovePropertyList(testClassId));
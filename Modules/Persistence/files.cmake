@@ -2,4 +2,5 @@ set(CPP_FILES
 mitkPersistenceService.cpp
 mitkPersistenceActivator.cpp
 mitkPropertyListsXmlFileReaderAndWriter.cpp
+mitkPropertyListsBinaryFileReaderAndWriter.cpp
 )
@@ -47,6 +47,20 @@ mitk::PersistenceService::~PersistenceService()
 std::string mitk::PersistenceService::GetDefaultPersistenceFile()
 {
   this->Initialize();
+  // the binary format is updated incrementally, so saving does not rewrite all property lists
+  std::string file = std::string("PersistentData") + PropertyListsBinaryFileReaderAndWriter::GetFileExtension();
+  us::ModuleContext *context = us::GetModuleContext();
+  std::string contextDataFile = context->GetDataFile(file);
+
+  if (!contextDataFile.empty())
+  {
+    file = contextDataFile;
+  }
+  return file;
+}
+
+std::string mitk::PersistenceService::GetLegacyPersistenceFile()
+{
   std::string file = "PersistentData.xml";
   us::ModuleContext *context = us::GetModuleContext();
   std::string contextDataFile = context->GetDataFile(file);
@@ -127,13 +141,17 @@ bool mitk::PersistenceService::Save(const std::string &fileName, bool appendChan
   }
 
   bool xmlFile = false;
-  if (itksys::SystemTools::GetFilenameLastExtension(theFile.c_str()) == ".xml")
+  bool binaryFile = false;
+  const std::string extension = itksys::SystemTools::GetFilenameLastExtension(theFile.c_str());
+  if (extension == ".xml")
     xmlFile = true;
+  else if (extension == PropertyListsBinaryFileReaderAndWriter::GetFileExtension())
+    binaryFile = true;
 
   mitk::DataStorage::Pointer tempDs;
   if (appendChanges)
   {
-    if (xmlFile == false)
+    if (xmlFile == false && binaryFile == false)
     {
       if (itksys::SystemTools::FileExists(theFile.c_str()))
       {
@@ -155,11 +173,16 @@ bool mitk::PersistenceService::Save(const std::string &fileName, bool appendChan
         if (!m_PropertyListsXmlFileReaderAndWriter->ReadLists(theFile, m_PropertyLists))
           return false;
       }
+      else if (binaryFile && appendChanges && itksys::SystemTools::FileLength(theFile.c_str()) > 0)
+      {
+        if (!m_PropertyListsBinaryFileReaderAndWriter->ReadLists(theFile, m_PropertyLists))
+          return false;
+      }
     }
 
     this->RestorePropertyListsFromPersistentDataNodes(tempDs);
   }
-  else if (xmlFile == false)
+  else if (xmlFile == false && binaryFile == false)
   {
     tempDs = mitk::StandaloneDataStorage::New();
   }
@@ -168,6 +191,10 @@ bool mitk::PersistenceService::Save(const std::string &fileName, bool appendChan
   {
     save = m_PropertyListsXmlFileReaderAndWriter->WriteLists(theFile, m_PropertyLists);
   }
+  else if (binaryFile)
+  {
+    save = m_PropertyListsBinaryFileReaderAndWriter->WriteLists(theFile, m_PropertyLists);
+  }
 
   else
   {
@@ -194,16 +221,26 @@ bool mitk::PersistenceService::Load(const std::string &fileName, bool enforceRel
 
   std::string theFile = fileName;
   if (theFile.empty())
+  {
     theFile = PersistenceService::GetDefaultPersistenceFile();
 
+    // the default file was an xml file before, it is converted by the next save
+    if (!itksys::SystemTools::FileExists(theFile.c_str()))
+      theFile = PersistenceService::GetLegacyPersistenceFile();
+  }
+
   MITK_DEBUG << "Load persistence data from file: " << theFile;
 
   if (!itksys::SystemTools::FileExists(theFile.c_str()))
     return false;
 
   bool xmlFile = false;
-  if (itksys::SystemTools::GetFilenameLastExtension(theFile.c_str()) == ".xml")
+  bool binaryFile = false;
+  const std::string extension = itksys::SystemTools::GetFilenameLastExtension(theFile.c_str());
+  if (extension == ".xml")
     xmlFile = true;
+  else if (extension == PropertyListsBinaryFileReaderAndWriter::GetFileExtension())
+    binaryFile = true;
 
   if (enforceReload == false)
   {
@@ -229,6 +266,10 @@ bool mitk::PersistenceService::Load(const std::string &fileName, bool enforceRel
   {
     load = m_PropertyListsXmlFileReaderAndWriter->ReadLists(theFile, m_PropertyLists);
   }
+  else if (binaryFile)
+  {
+    load = m_PropertyListsBinaryFileReaderAndWriter->ReadLists(theFile, m_PropertyLists);
+  }
   else
   {
     if (m_SceneIO.IsNull())
@@ -395,6 +436,7 @@ void mitk::PersistenceService::Initialize()
   m_InInitialized = true;
 
   m_PropertyListsXmlFileReaderAndWriter = PropertyListsXmlFileReaderAndWriter::New();
+  m_PropertyListsBinaryFileReaderAndWriter = PropertyListsBinaryFileReaderAndWriter::New();
 
   // Load Default File in any case
   this->Load();
@@ -13,6 +13,7 @@ found in the LICENSE file.
 #define mitkPersistenceService_h
 
 #include "mitkIPersistenceService.h"
+#include "mitkPropertyListsBinaryFileReaderAndWriter.h"
 #include "mitkPropertyListsXmlFileReaderAndWriter.h"
 #include "mitkSceneIO.h"
 #include <MitkPersistenceExports.h>
@@ -39,6 +40,9 @@ namespace mitk
 
     std::string GetDefaultPersistenceFile() override;
 
+    /// the xml file that was the default persistence file before, it is loaded if the default file does not exist
+    std::string GetLegacyPersistenceFile();
+
     mitk::PropertyList::Pointer GetPropertyList(std::string &id, bool *existed = nullptr) override;
 
     bool RemovePropertyList(std::string &id) override;
@@ -73,6 +77,7 @@ namespace mitk
     std::set<PropertyListReplacedObserver *> m_PropertyListReplacedObserver;
     SceneIO::Pointer m_SceneIO;
     PropertyListsXmlFileReaderAndWriter::Pointer m_PropertyListsXmlFileReaderAndWriter;
+    PropertyListsBinaryFileReaderAndWriter::Pointer m_PropertyListsBinaryFileReaderAndWriter;
     std::map<std::string, long int> m_FileNamesToModifiedTimes;
     bool m_Initialized;
     bool m_InInitialized;
@@ -0,0 +1,507 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkPropertyListsBinaryFileReaderAndWriter.h"
+#include "mitkProperties.h"
+#include "mitkVectorProperty.h"
+#include <itksys/SystemTools.hxx>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+  const char FileHeader[] = "MITKPL01";
+  const std::size_t FileHeaderSize = sizeof(FileHeader) - 1;
+
+  enum RecordType : char
+  {
+    SetPropertyRecord = 1,
+    RemovePropertyRecord = 2,
+    RemoveListRecord = 3
+  };
+
+  enum ValueType : char
+  {
+    BoolValue = 1,
+    StringValue,
+    IntValue,
+    FloatValue,
+    DoubleValue,
+    IntVectorValue,
+    DoubleVectorValue,
+    StringVectorValue
+  };
+
+  template <typename T>
+  void Append(std::string &buffer, const T &value)
+  {
+    buffer.append(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+
+  void AppendString(std::string &buffer, const std::string &value)
+  {
+    Append(buffer, static_cast<std::uint32_t>(value.size()));
+    buffer.append(value);
+  }
+
+  template <typename T>
+  void AppendVector(std::string &buffer, const std::vector<T> &values)
+  {
+    Append(buffer, static_cast<std::uint32_t>(values.size()));
+    for (const auto &value : values)
+      Append(buffer, value);
+  }
+
+  /// Reads the values written by Append() and AppendString(), fails at the end of the data
+  class Reader
+  {
+  public:
+    Reader(const std::string &data, std::size_t position) : m_Data(data), m_Position(position) {}
+
+    template <typename T>
+    bool Read(T &value)
+    {
+      if (m_Data.size() - m_Position < sizeof(T))
+        return false;
+      std::memcpy(&value, m_Data.data() + m_Position, sizeof(T));
+      m_Position += sizeof(T);
+      return true;
+    }
+
+    bool ReadString(std::string &value)
+    {
+      std::uint32_t size = 0;
+      if (!this->Read(size) || m_Data.size() - m_Position < size)
+        return false;
+      value.assign(m_Data, m_Position, size);
+      m_Position += size;
+      return true;
+    }
+
+    template <typename T>
+    bool ReadVector(std::vector<T> &values)
+    {
+      std::uint32_t size = 0;
+      if (!this->Read(size) || (m_Data.size() - m_Position) / sizeof(T) < size)
+        return false;
+      values.resize(size);
+      for (auto &value : values)
+      {
+        if (!this->Read(value))
+          return false;
+      }
+      return true;
+    }
+
+    bool ReadStringVector(std::vector<std::string> &values)
+    {
+      std::uint32_t size = 0;
+      if (!this->Read(size) || (m_Data.size() - m_Position) / sizeof(std::uint32_t) < size)
+        return false;
+      values.resize(size);
+      for (auto &value : values)
+      {
+        if (!this->ReadString(value))
+          return false;
+      }
+      return true;
+    }
+
+    bool AtEnd() const { return m_Position == m_Data.size(); }
+    std::size_t GetPosition() const { return m_Position; }
+
+  private:
+    const std::string &m_Data;
+    std::size_t m_Position;
+  };
+
+  /// Encodes the type and the value of a property, false if the property type is not supported
+  bool SerializeProperty(const mitk::BaseProperty *prop, std::string &value)
+  {
+    value.clear();
+
+    if (auto boolProp = dynamic_cast<const mitk::BoolProperty *>(prop))
+    {
+      Append(value, BoolValue);
+      Append(value, static_cast<char>(boolProp->GetValue() ? 1 : 0));
+    }
+    else if (auto stringProp = dynamic_cast<const mitk::StringProperty *>(prop))
+    {
+      Append(value, StringValue);
+      value.append(stringProp->GetValue());
+    }
+    else if (auto intProp = dynamic_cast<const mitk::IntProperty *>(prop))
+    {
+      Append(value, IntValue);
+      Append(value, static_cast<std::int32_t>(intProp->GetValue()));
+    }
+    else if (auto floatProp = dynamic_cast<const mitk::FloatProperty *>(prop))
+    {
+      Append(value, FloatValue);
+      Append(value, floatProp->GetValue());
+    }
+    else if (auto doubleProp = dynamic_cast<const mitk::DoubleProperty *>(prop))
+    {
+      Append(value, DoubleValue);
+      Append(value, doubleProp->GetValue());
+    }
+    else if (auto intVectorProp = dynamic_cast<const mitk::IntVectorProperty *>(prop))
+    {
+      Append(value, IntVectorValue);
+      AppendVector(value, intVectorProp->GetValue());
+    }
+    else if (auto doubleVectorProp = dynamic_cast<const mitk::DoubleVectorProperty *>(prop))
+    {
+      Append(value, DoubleVectorValue);
+      AppendVector(value, doubleVectorProp->GetValue());
+    }
+    else if (auto stringVectorProp = dynamic_cast<const mitk::VectorProperty<std::string> *>(prop))
+    {
+      Append(value, StringVectorValue);
+      const auto &strings = stringVectorProp->GetValue();
+      Append(value, static_cast<std::uint32_t>(strings.size()));
+      for (const auto &string : strings)
+        AppendString(value, string);
+    }
+    else
+    {
+      return false;
+    }
+
+    return true;
+  }
+
+  mitk::BaseProperty::Pointer DeserializeProperty(const std::string &value)
+  {
+    if (value.empty())
+      return nullptr;
+
+    // the value of a string property is not length-prefixed, it takes the rest of the encoded value
+    if (value[0] == StringValue)
+      return mitk::StringProperty::New(value.substr(1)).GetPointer();
+
+    Reader reader(value, 1);
+    bool read = false;
+    mitk::BaseProperty::Pointer prop;
+
+    switch (value[0])
+    {
+      case BoolValue:
+      {
+        char boolValue = 0;
+        read = reader.Read(boolValue);
+        prop = mitk::BoolProperty::New(boolValue != 0);
+        break;
+      }
+      case IntValue:
+      {
+        std::int32_t intValue = 0;
+        read = reader.Read(intValue);
+        prop = mitk::IntProperty::New(intValue);
+        break;
+      }
+      case FloatValue:
+      {
+        float floatValue = 0;
+        read = reader.Read(floatValue);
+        prop = mitk::FloatProperty::New(floatValue);
+        break;
+      }
+      case DoubleValue:
+      {
+        double doubleValue = 0;
+        read = reader.Read(doubleValue);
+        prop = mitk::DoubleProperty::New(doubleValue);
+        break;
+      }
+      case IntVectorValue:
+      {
+        std::vector<int> intValues;
+        read = reader.ReadVector(intValues);
+        auto vectorProp = mitk::IntVectorProperty::New();
+        vectorProp->SetValue(intValues);
+        prop = vectorProp;
+        break;
+      }
+      case DoubleVectorValue:
+      {
+        std::vector<double> doubleValues;
+        read = reader.ReadVector(doubleValues);
+        auto vectorProp = mitk::DoubleVectorProperty::New();
+        vectorProp->SetValue(doubleValues);
+        prop = vectorProp;
+        break;
+      }
+      case StringVectorValue:
+      {
+        std::vector<std::string> stringValues;
+        read = reader.ReadStringVector(stringValues);
+        auto vectorProp = mitk::VectorProperty<std::string>::New();
+        vectorProp->SetValue(stringValues);
+        prop = vectorProp;
+        break;
+      }
+      default:
+        break;
+    }
+
+    return read && reader.AtEnd() ? prop : nullptr;
+  }
+
+  void AppendSetPropertyRecord(std::string &buffer,
+                               const std::string &listId,
+                               const std::string &name,
+                               const std::string &value)
+  {
+    Append(buffer, SetPropertyRecord);
+    AppendString(buffer, listId);
+    AppendString(buffer, name);
+    AppendString(buffer, value);
+  }
+
+  std::size_t GetSetPropertyRecordSize(const std::string &listId, const std::string &name, const std::string &value)
+  {
+    return 1 + 3 * sizeof(std::uint32_t) + listId.size() + name.size() + value.size();
+  }
+}
+
+namespace mitk
+{
+  const char *PropertyListsBinaryFileReaderAndWriter::GetFileExtension() { return ".mitkpl"; }
+
+  PropertyListsBinaryFileReaderAndWriter::PropertyListsBinaryFileReaderAndWriter() : m_FileSize(0) {}
+  PropertyListsBinaryFileReaderAndWriter::~PropertyListsBinaryFileReaderAndWriter() {}
+
+  bool PropertyListsBinaryFileReaderAndWriter::WriteLists(
+    const std::string &fileName, const std::map<std::string, mitk::PropertyList::Pointer> &_PropertyLists)
+  {
+    // the records are only appended to a file that was not changed since it was read or written here
+    bool incremental = fileName == m_FileName && m_FileSize >= FileHeaderSize &&
+                       itksys::SystemTools::FileExists(fileName.c_str(), true) &&
+                       static_cast<std::size_t>(itksys::SystemTools::FileLength(fileName.c_str())) == m_FileSize;
+    if (!incremental)
+    {
+      m_WrittenLists.clear();
+    }
+
+    std::string records;
+    bool allPropsConverted = true;
+
+    for (auto writtenIt = m_WrittenLists.begin(); writtenIt != m_WrittenLists.end();)
+    {
+      if (_PropertyLists.count(writtenIt->first) == 0)
+      {
+        Append(records, RemoveListRecord);
+        AppendString(records, writtenIt->first);
+        writtenIt = m_WrittenLists.erase(writtenIt);
+      }
+      else
+      {
+        ++writtenIt;
+      }
+    }
+
+    for (const auto &propertyList : _PropertyLists)
+    {
+      const std::string &id = propertyList.first;
+      const PropertyList *propList = propertyList.second;
+      WrittenPropertyList &written = m_WrittenLists[id];
+
+      if (written.List == propList && written.ListMTime == propList->GetMTime())
+        continue;
+
+      std::map<std::string, std::string> properties;
+      for (const auto &prop : *propList->GetMap())
+      {
+        std::string value;
+        if (!SerializeProperty(prop.second, value))
+        {
+          MITK_WARN("PropertyListsBinaryFileReaderAndWriter") << "Base property " << prop.first << " is unknown";
+          allPropsConverted = false;
+          continue;
+        }
+        properties[prop.first] = value;
+      }
+
+      for (const auto &writtenProperty : written.Properties)
+      {
+        if (properties.count(writtenProperty.first) == 0)
+        {
+          Append(records, RemovePropertyRecord);
+          AppendString(records, id);
+          AppendString(records, writtenProperty.first);
+        }
+      }
+
+      for (const auto &property : properties)
+      {
+        auto writtenProperty = written.Properties.find(property.first);
+        if (writtenProperty == written.Properties.end() || writtenProperty->second != property.second)
+          AppendSetPropertyRecord(records, id, property.first, property.second);
+      }
+
+      written.List = propList;
+      written.ListMTime = propList->GetMTime();
+      written.Properties.swap(properties);
+    }
+
+    bool writeOp = true;
+    if (!incremental || m_FileSize + records.size() > 2 * this->GetSizeOfCurrentRecords() + 4096)
+    {
+      writeOp = this->RewriteFile(fileName);
+    }
+    else if (!records.empty())
+    {
+      std::ofstream file(fileName.c_str(), std::ios::binary | std::ios::app);
+      file.write(records.data(), records.size());
+      writeOp = file.good();
+      m_FileSize += records.size();
+    }
+
+    if (!writeOp)
+    {
+      m_FileName.clear();
+      m_WrittenLists.clear();
+    }
+
+    return allPropsConverted && writeOp;
+  }
+
+  bool PropertyListsBinaryFileReaderAndWriter::RewriteFile(const std::string &fileName)
+  {
+    std::string content(FileHeader, FileHeaderSize);
+    for (const auto &written : m_WrittenLists)
+    {
+      for (const auto &property : written.second.Properties)
+        AppendSetPropertyRecord(content, written.first, property.first, property.second);
+    }
+
+    // replace the file only when the new one is complete
+    const std::string tempFileName = fileName + ".tmp";
+    {
+      std::ofstream file(tempFileName.c_str(), std::ios::binary | std::ios::trunc);
+      file.write(content.data(), content.size());
+      if (!file.good())
+        return false;
+    }
+
+    if (!itksys::SystemTools::RenameFile(tempFileName.c_str(), fileName.c_str()))
+    {
+      itksys::SystemTools::RemoveFile(tempFileName);
+      return false;
+    }
+
+    m_FileName = fileName;
+    m_FileSize = content.size();
+    return true;
+  }
+
+  std::size_t PropertyListsBinaryFileReaderAndWriter::GetSizeOfCurrentRecords() const
+  {
+    std::size_t size = FileHeaderSize;
+    for (const auto &written : m_WrittenLists)
+    {
+      for (const auto &property : written.second.Properties)
+        size += GetSetPropertyRecordSize(written.first, property.first, property.second);
+    }
+    return size;
+  }
+
+  bool PropertyListsBinaryFileReaderAndWriter::ReadLists(
+    const std::string &fileName, std::map<std::string, mitk::PropertyList::Pointer> &_PropertyLists)
+  {
+    m_FileName.clear();
+    m_FileSize = 0;
+    m_WrittenLists.clear();
+
+    std::ifstream file(fileName.c_str(), std::ios::binary);
+    const std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    if (data.compare(0, FileHeaderSize, FileHeader) != 0)
+    {
+      MITK_WARN("PropertyListsBinaryFileReaderAndWriter") << fileName << " is not a property lists file";
+      return false;
+    }
+
+    Reader reader(data, FileHeaderSize);
+    std::size_t recordEnd = reader.GetPosition();
+    while (!reader.AtEnd())
+    {
+      char recordType = 0;
+      std::string id;
+      std::string name;
+      std::string value;
+
+      bool readOp = reader.Read(recordType) && reader.ReadString(id);
+      if (readOp && recordType != RemoveListRecord)
+        readOp = reader.ReadString(name);
+      if (readOp && recordType == SetPropertyRecord)
+        readOp = reader.ReadString(value);
+
+      if (!readOp)
+      {
+        // an incomplete record at the end is the remainder of an interrupted write
+        MITK_WARN("PropertyListsBinaryFileReaderAndWriter") << "Ignoring incomplete record at the end of " << fileName;
+        break;
+      }
+
+      if (recordType == SetPropertyRecord)
+      {
+        m_WrittenLists[id].Properties[name] = value;
+      }
+      else if (recordType == RemovePropertyRecord)
+      {
+        m_WrittenLists[id].Properties.erase(name);
+      }
+      else if (recordType == RemoveListRecord)
+      {
+        m_WrittenLists.erase(id);
+      }
+      else
+      {
+        MITK_WARN("PropertyListsBinaryFileReaderAndWriter") << "Unknown record in " << fileName;
+        return false;
+      }
+      recordEnd = reader.GetPosition();
+    }
+
+    bool allPropsRead = true;
+    for (auto &written : m_WrittenLists)
+    {
+      mitk::PropertyList::Pointer propList = mitk::PropertyList::New();
+      for (const auto &property : written.second.Properties)
+      {
+        mitk::BaseProperty::Pointer prop = DeserializeProperty(property.second);
+        if (prop.IsNull())
+        {
+          MITK_WARN("PropertyListsBinaryFileReaderAndWriter") << "Property " << property.first << " cannot be read";
+          allPropsRead = false;
+          continue;
+        }
+        propList->SetProperty(property.first, prop);
+      }
+
+      _PropertyLists[written.first] = propList;
+      written.second.List = propList;
+      written.second.ListMTime = propList->GetMTime();
+    }
+
+    // a later write appends to the records read here
+    m_FileName = fileName;
+    m_FileSize = recordEnd;
+
+    return allPropsRead;
+  }
+}
@@ -0,0 +1,67 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkPropertyListsBinaryFileReaderAndWriter_h
+#define mitkPropertyListsBinaryFileReaderAndWriter_h
+
+#include "mitkDataStorage.h"
+
+namespace mitk
+{
+  /**
+   * \brief Reads and writes property lists from and to a binary file that is updated incrementally.
+   *
+   * The file is a log of records, each of which sets or removes a property or removes a whole property list.
+   * If the file was last read or written by this object, WriteLists() only appends records for the properties
+   * that changed since then; property lists whose modification time did not change are not compared at all.
+   * The file is rewritten completely if it was changed by someone else or if the outdated records take more
+   * space than the current ones.
+   *
+   * Supported are Bool-, String-, Int-, Float- and DoubleProperty as well as the int, double and std::string
+   * VectorProperty.
+   */
+  class PropertyListsBinaryFileReaderAndWriter : public itk::Object
+  {
+  public:
+    static const char *GetFileExtension();
+
+    mitkClassMacroItkParent(PropertyListsBinaryFileReaderAndWriter, itk::Object);
+    itkFactorylessNewMacro(Self);
+    itkCloneMacro(Self);
+
+    bool WriteLists(const std::string &fileName,
+                    const std::map<std::string, mitk::PropertyList::Pointer> &_PropertyLists);
+    bool ReadLists(const std::string &fileName, std::map<std::string, mitk::PropertyList::Pointer> &_PropertyLists);
+
+  protected:
+    PropertyListsBinaryFileReaderAndWriter();
+    ~PropertyListsBinaryFileReaderAndWriter() override;
+
+  private:
+    /// The properties of a list as they are stored in the file
+    struct WrittenPropertyList
+    {
+      const PropertyList *List = nullptr;
+      unsigned long ListMTime = 0;
+      std::map<std::string, std::string> Properties;
+    };
+
+    bool RewriteFile(const std::string &fileName);
+    std::size_t GetSizeOfCurrentRecords() const;
+
+    std::string m_FileName;
+    std::size_t m_FileSize;
+    std::map<std::string, WrittenPropertyList> m_WrittenLists;
+  };
+}
+
+#endif
@@ -48,6 +48,10 @@ found in the LICENSE file.
 #include <mitkThreeStepLinearModelFactory.h>
 #include <mitkModelFactoryBase.h>
 
+#ifdef PHARMACOKINETICS_USE_GPU
+#include <mitkOclModelFitBackend.h>
+#endif
+
 std::string inFilename;
 std::string outFileName;
 std::string maskFileName;
@@ -62,7 +66,11 @@ mitk::Image::Pointer aifMask;
 bool useConstraints(false);
 bool verbose(false);
 bool roibased(false);
+unsigned int shardCount(1);
+unsigned int shardIndex(0);
+bool mergeShards(false);
 bool preview(false);
+bool useGPU(false);
 
 std::string modelName;
 
@@ -138,8 +146,21 @@ void setupParser(mitkCommandLineParser& parser)
       "constraints", "c", mitkCommandLineParser::Bool, "Constraints", "Indicates if constraints should be used for the fitting (if flag is set the default contraints will be used.).", us::Any(false));
     parser.addArgument(
       "preview", "p", mitkCommandLineParser::Bool, "Preview outputs", "The application previews the outputs (filename, type) it would produce with the current settings.");
+#ifdef PHARMACOKINETICS_USE_GPU
+    parser.addArgument(
+      "gpu", "", mitkCommandLineParser::Bool, "GPU fitting", "Fits the pixel based models on the GPU (OpenCL) if the model and the fit settings are supported (e.g. no constraints). Otherwise the CPU is used.");
+#endif
     parser.addArgument("help", "h", mitkCommandLineParser::Bool, "Help:", "Show this help text");
     parser.endGroup();
+
+    parser.beginGroup("Distributed fitting");
+    parser.addArgument(
+        "shards", "", mitkCommandLineParser::Int, "Number of shards", "Splits the pixel based fit into the given number of shards with (almost) the same number of voxels. Each shard can be fitted by a separate process (e.g. a job of a cluster job array) and stores its results with the suffix \"_shard<index>of<number>\". Afterwards call the app once more with the same settings and --merge to combine the results.", us::Any(1));
+    parser.addArgument(
+        "shard", "", mitkCommandLineParser::Int, "Shard index", "Index (starting with 0) of the shard that should be fitted, e.g. the index of the job in a job array.", us::Any(0));
+    parser.addArgument(
+        "merge", "", mitkCommandLineParser::Bool, "Merge shards", "Does not fit but merges the results of all shards (see --shards) into the output files.");
+    parser.endGroup();
     //! [add arguments]
 }
 
@@ -158,6 +179,34 @@ bool configureApplicationSettings(std::map<std::string, us::Any> parsedArgs)
     inFilename = us::any_cast<std::string>(parsedArgs["input"]);
     outFileName = us::any_cast<std::string>(parsedArgs["output"]);
 
+    if (parsedArgs.count("shards"))
+    {
+      const int shards = us::any_cast<int>(parsedArgs["shards"]);
+      if (shards < 1)
+      {
+        std::cerr << "Error. Number of shards must be at least 1." << std::endl;
+        return false;
+      }
+      shardCount = static_cast<unsigned int>(shards);
+    }
+
+    if (parsedArgs.count("shard"))
+    {
+      const int shard = us::any_cast<int>(parsedArgs["shard"]);
+      if (shard < 0 || static_cast<unsigned int>(shard) >= shardCount)
+      {
+        std::cerr << "Error. Shard index must be in [0, number of shards)." << std::endl;
+        return false;
+      }
+      shardIndex = static_cast<unsigned int>(shard);
+    }
+
+    mergeShards = false;
+    if (parsedArgs.count("merge"))
+    {
+      mergeShards = us::any_cast<bool>(parsedArgs["merge"]);
+    }
+
     if (parsedArgs.count("mask"))
     {
       maskFileName = us::any_cast<std::string>(parsedArgs["mask"]);
@@ -185,6 +234,12 @@ bool configureApplicationSettings(std::map<std::string, us::Any> parsedArgs)
       preview = us::any_cast<bool>(parsedArgs["preview"]);
     }
 
+    useGPU = false;
+    if (parsedArgs.count("gpu"))
+    {
+      useGPU = us::any_cast<bool>(parsedArgs["gpu"]);
+    }
+
     roibased = false;
     if (parsedArgs.count("roibased"))
     {
@@ -211,6 +266,18 @@ bool configureApplicationSettings(std::map<std::string, us::Any> parsedArgs)
     return true;
 }
 
+void configureFitBackend(mitk::PixelBasedParameterFitImageGenerator* fitGenerator)
+{
+#ifdef PHARMACOKINETICS_USE_GPU
+  if (useGPU)
+  {
+    fitGenerator->SetFitBackend(mitk::OclModelFitBackend::New());
+  }
+#else
+  (void)fitGenerator;
+#endif
+}
+
 mitk::ModelFitFunctorBase::Pointer createDefaultFitFunctor(
     const mitk::ModelParameterizerBase* parameterizer, const mitk::ModelFactoryBase* modelFactory)
 {
@@ -354,6 +421,7 @@ void generateDescriptiveBrixModel_PixelBased(mitk::modelFit::ModelFitInfo::Point
 
   fitGenerator->SetDynamicImage(image);
   fitGenerator->SetFitFunctor(fitFunctor);
+  configureFitBackend(fitGenerator);
 
   generator = fitGenerator.GetPointer();
 
@@ -449,6 +517,7 @@ void Generate3StepLinearModelFit_PixelBased(mitk::modelFit::ModelFitInfo::Pointe
 
   fitGenerator->SetDynamicImage(image);
   fitGenerator->SetFitFunctor(fitFunctor);
+  configureFitBackend(fitGenerator);
 
   generator = fitGenerator.GetPointer();
 
@@ -546,6 +615,7 @@ void generateAIFbasedModelFit_PixelBased(mitk::modelFit::ModelFitInfo::Pointer&
 
   fitGenerator->SetDynamicImage(image);
   fitGenerator->SetFitFunctor(fitFunctor);
+  configureFitBackend(fitGenerator);
 
   generator = fitGenerator.GetPointer();
 
@@ -737,14 +807,27 @@ void doFitting()
 
         createFitGenerator(fitSession, generator);
 
-        if (generator.IsNotNull() )
+        if (generator.IsNotNull() && mergeShards)
+        {
+            std::cout << "Merging results of " << shardCount << " shards..." << std::endl;
+            mitk::mergeModelFitGeneratorShardResults(outFileName, shardCount, generator, fitSession);
+        }
+        else if (generator.IsNotNull() )
         {
             std::cout << "Started fitting process..." << std::endl;
             generator->AddObserver(::itk::AnyEvent(), command);
             generator->Generate();
             std::cout << std::endl << "Finished fitting process" << std::endl;
 
-            mitk::storeModelFitGeneratorResults(outFileName, generator, fitSession);
+            if (shardCount > 1)
+            {
+                mitk::storeModelFitGeneratorResults(
+                    mitk::generateModelFitShardOutputPathTemplate(outFileName, shardCount, shardIndex), generator, fitSession);
+            }
+            else
+            {
+                mitk::storeModelFitGeneratorResults(outFileName, generator, fitSession);
+            }
         }
         else
         {
@@ -832,6 +915,19 @@ int main(int argc, char* argv[])
             mitkThrow() << "Error. Cannot fit. Please specify mask if you select roi based fitting.";
         }
 
+        if (shardCount > 1)
+        {
+            if (roibased)
+            {
+                mitkThrow() << "Error. Cannot fit. ROI based fitting cannot be split into shards.";
+            }
+
+            if (!mergeShards)
+            {
+                mask = mitk::generateModelFitShardMask(image, mask, shardCount, shardIndex);
+            }
+        }
+
         std::cout << "Style: ";
         if (roibased)
         {
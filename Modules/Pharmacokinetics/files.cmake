@@ -3,6 +3,8 @@ file(GLOB_RECURSE H_FILES RELATIVE "${CMAKE_CURRENT_SOURCE_DIR}" "${CMAKE_CURREN
 set(CPP_FILES
   Common/mitkAterialInputFunctionGenerator.cpp
   Common/mitkAIFParametrizerHelper.cpp
+  Common/mitkPrecomputedAIF.cpp
+  Common/mitkLinearCompartmentIntegrator.cpp
   Common/mitkConcentrationCurveGenerator.cpp
   Common/mitkDescriptionParameterImageGeneratorBase.cpp
   Common/mitkPixelBasedDescriptionParameterImageGenerator.cpp
@@ -51,6 +53,16 @@ set(CPP_FILES
   SimulationFramework/mitkImageGenerationHelper.cpp
 )
 
+if(MITK_USE_OpenCL)
+  list(APPEND CPP_FILES
+    Common/mitkOclModelFitBackend.cpp
+  )
+
+  set(RESOURCE_FILES
+    ModelFitLevenbergMarquardt.cl
+  )
+endif(MITK_USE_OpenCL)
+
 set(HXX_FILES
 mitkDICOMSegmentationConstants.h
 
@@ -15,8 +15,11 @@ found in the LICENSE file.
 
 #include "MitkPharmacokineticsExports.h"
 #include "mitkModelBase.h"
+#include "mitkPrecomputedAIF.h"
 #include "itkArray2D.h"
 
+#include <mutex>
+
 namespace mitk
 {
 
@@ -74,6 +77,11 @@ namespace mitk
      * if currentTimeGrid.Size() = 0 , the Original AIF will be returned*/
     const AterialInputFunctionType GetAterialInputFunction(TimeGridType currentTimeGrid) const;
 
+    /** Returns the Aterial Input function on the time grid of the model, prepared for fast convolutions
+     * (see PrecomputedAIF). It is computed on first use and reused until the model is modified (e.g. by setting
+     * the AIF or one of the time grids), so repeated signal evaluations do not interpolate the AIF again.*/
+    const PrecomputedAIF& GetPrecomputedAterialInputFunction() const;
+
     ParameterNamesType GetStaticParameterNames() const override;
     ParametersSizeType GetNumberOfStaticParameters() const override;
     ParamterUnitMapType GetStaticParameterUnits() const override;
@@ -100,6 +108,10 @@ namespace mitk
     TimeGridType m_AterialInputFunctionTimeGrid;
     AterialInputFunctionType m_AterialInputFunctionValues;
 
+    mutable PrecomputedAIF m_PrecomputedAIF;
+    mutable itk::ModifiedTimeType m_PrecomputedAIFTime;
+    mutable std::mutex m_PrecomputedAIFMutex;
+
 
   private:
 
@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include <itkBinaryFunctorImageFilter.h>
 #include "mitkConvertToConcentrationAbsoluteFunctor.h"
 #include "mitkConvertToConcentrationRelativeFunctor.h"
+#include "mitkDynamicImageFrameConverterBase.h"
 
 #include "MitkPharmacokineticsExports.h"
 
@@ -27,12 +28,15 @@ namespace mitk {
 * From a given 4D image, the Generator takes the 3D image of the first time point as baseline image. It then loops over all time steps, casts
 * the current 3D image to itk and passes it to the ConvertToconcentrationFunctor. The returned 3D image has now values of concentration type and is stored at its timepoint
 * in the return image.
+* The generator can also be used as frame converter of a PixelBasedParameterFitImageGenerator (see
+* DynamicImageFrameConverterBase). Then the frames (or slabs of them) are converted on the fly while fitting and the
+* 4D concentration image is never created.
 */
-class MITKPHARMACOKINETICS_EXPORT ConcentrationCurveGenerator : public itk::Object
+class MITKPHARMACOKINETICS_EXPORT ConcentrationCurveGenerator : public DynamicImageFrameConverterBase
 {
 public:
 
-    mitkClassMacroItkParent(ConcentrationCurveGenerator, itk::Object);
+    mitkClassMacro(ConcentrationCurveGenerator, DynamicImageFrameConverterBase);
     itkNewMacro(Self);
 
     //typedef itk::Image<double,3> ImageType;
@@ -96,12 +100,24 @@ public:
 
     Image::Pointer GetConvertedImage();
 
+    /** Sets the passed image as dynamic image and prepares the baseline image for ConvertFrame().*/
+    void PrepareConversion(const Image* dynamicImage) override;
+
+    /** Converts the signal values of a frame (or a slab of it) with the current settings.*/
+    FrameImageType::Pointer ConvertFrame(const FrameImageType* frame, unsigned int timeStep) const override;
+
 protected:
 
     ConcentrationCurveGenerator();
      ~ConcentrationCurveGenerator() override;
 
 
+     /** Converts the passed frame. Only the region of itkInputImage is converted, so itkBaselineImage (and
+      * itkT10Image, which is only needed if m_UsingT1Map is true) may be larger.*/
+     template<class TPixel_input, class TPixel_baseline>
+     ConvertedImageType::Pointer convertFrameToConcentration(const itk::Image<TPixel_input, 3> *itkInputImage,
+       const itk::Image<TPixel_baseline, 3> *itkBaselineImage, const ConvertedImageType* itkT10Image) const;
+
      template<class TPixel_input, class TPixel_baseline>
      mitk::Image::Pointer convertToConcentration(const itk::Image<TPixel_input, 3> *itkInputImage, const itk::Image<TPixel_baseline, 3> *itkBaselineImage);
 
@@ -127,6 +143,10 @@ private:
     Image::Pointer m_ConvertSignalToConcentrationCurve_OutputImage;
     Image::Pointer m_ConvertedImage;
 
+    /** Baseline and T10 image used by ConvertFrame(); set by PrepareConversion().*/
+    ConvertedImageType::Pointer m_FrameBaselineImage;
+    ConvertedImageType::Pointer m_FrameT10Image;
+
     bool m_isT2weightedImage;
 
     bool m_isTurboFlashSequence;
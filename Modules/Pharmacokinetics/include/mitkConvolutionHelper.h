@@ -13,6 +13,7 @@ found in the LICENSE file.
 #define mitkConvolutionHelper_h
 
 #include "itkArray.h"
+#include "itkArray2D.h"
 #include "mitkAIFBasedModelBase.h"
 #include <iostream>
 #include "MitkPharmacokineticsExports.h"
@@ -128,6 +129,75 @@ inline    itk::Array<double> wrap1d(itk::Array<double> kernel)
   }
 
 
+  /** @brief Computes convoluteAIFWithExponential() and its derivative with respect to lambda.
+   * The derivative is the exact derivative of the iterative formula, so it is consistent with the signal
+   * (and with numeric derivatives of it).*/
+  inline itk::Array<double> convoluteAIFWithExponentialAndDerivative(const mitk::ModelBase::TimeGridType& timeGrid,
+      const mitk::AIFBasedModelBase::AterialInputFunctionType& aif, double lambda, itk::Array<double>& derivative)
+  {
+      typedef itk::Array<double> ConvolutionResultType;
+      ConvolutionResultType convolution(timeGrid.GetSize());
+      convolution.fill(0.0);
+      derivative.SetSize(timeGrid.GetSize());
+      derivative.fill(0.0);
+
+      for(unsigned int i = 0; i + 1 < timeGrid.GetSize(); ++i)
+      {
+          const double t0 = timeGrid(i);
+          const double t1 = timeGrid(i+1);
+          const double dt = t1 - t0;
+          const double m = (aif(i+1) - aif(i))/dt;
+          const double offset = aif(i) - m*t0;
+          const double edt = exp(-lambda *dt);
+          const double dedt = -dt * edt;
+
+          const double g = (lambda * t1 - 1) - edt*(lambda*t0 -1);
+          const double dg = t1 - dedt*(lambda*t0 - 1) - edt*t0;
+
+          convolution(i+1) = edt * convolution(i)
+                           + offset/lambda * (1 - edt )
+                           + m/(lambda * lambda) * g;
+
+          derivative(i+1) = dedt * convolution(i) + edt * derivative(i)
+                          + offset * (-dedt/lambda - (1 - edt)/(lambda * lambda))
+                          + m * (dg/(lambda * lambda) - 2 * g/(lambda * lambda * lambda));
+      }
+      return convolution;
+  }
+
+  /** @brief Batched version of convoluteAIFWithExponential() for several lambdas.
+   * The convolutions have one row per time point and one column per lambda (see ModelBase::BatchSignalsType),
+   * so the inner loop runs over contiguous memory and can be vectorized.*/
+  inline void convoluteAIFWithExponential(const mitk::ModelBase::TimeGridType& timeGrid,
+                                          const mitk::AIFBasedModelBase::AterialInputFunctionType& aif,
+                                          const itk::Array<double>& lambdas,
+                                          itk::Array2D<double>& convolutions)
+  {
+      const unsigned int numberOfLambdas = lambdas.GetSize();
+      convolutions.SetSize(timeGrid.GetSize(), numberOfLambdas);
+      convolutions.Fill(0.0);
+
+      const double* lambda = lambdas.data_block();
+      for(unsigned int i = 0; i + 1 < timeGrid.GetSize(); ++i)
+      {
+          const double dt = timeGrid(i+1) - timeGrid(i);
+          const double m = (aif(i+1) - aif(i))/dt;
+          const double offset = aif(i) - m*timeGrid(i);
+          const double* previous = convolutions[i];
+          double* current = convolutions[i+1];
+
+          for(unsigned int j = 0; j < numberOfLambdas; ++j)
+          {
+              const double l = lambda[j];
+              const double edt = exp(-l *dt);
+
+              current[j] = edt * previous[j]
+                         + offset/l * (1 - edt )
+                         + m/(l * l) * ((l * timeGrid(i+1) - 1) - edt*(l*timeGrid(i) -1));
+          }
+      }
+  }
+
   inline itk::Array<double> convoluteAIFWithConstant(mitk::ModelBase::TimeGridType timeGrid, mitk::AIFBasedModelBase::AterialInputFunctionType aif, double constant)
   {
       /** @brief Iterative Formula to Convolve aif(t) with a constant value by linear interpolation of the Aif between sampling points
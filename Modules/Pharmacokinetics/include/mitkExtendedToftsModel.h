@@ -64,6 +64,8 @@ namespace mitk
     ParameterNamesType GetParameterNames() const override;
     ParametersSizeType  GetNumberOfParameters() const override;
 
+    bool HasJacobian() const override;
+
     ParamterUnitMapType GetParameterUnits() const override;
 
     ParameterNamesType GetDerivedParameterNames() const override;
@@ -84,6 +86,10 @@ namespace mitk
 
     ModelResultType ComputeModelfunction(const ParametersType& parameters) const override;
 
+    JacobianType ComputeJacobian(const ParametersType& parameters) const override;
+
+    void ComputeModelfunctionBatch(const BatchParametersType& parameters, BatchSignalsType& signals) const override;
+
     DerivedParameterMapType ComputeDerivedParameters(const mitk::ModelBase::ParametersType&
         parameters) const override;
 
@@ -0,0 +1,56 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkLinearCompartmentIntegrator_h
+#define mitkLinearCompartmentIntegrator_h
+
+#include "itkArray.h"
+
+#include <vnl/vnl_matrix_fixed.h>
+#include <vnl/vnl_vector_fixed.h>
+
+#include "MitkPharmacokineticsExports.h"
+
+namespace mitk
+{
+  /** \class LinearCompartmentIntegrator
+   * \brief Exact integration of linear two compartment systems driven by an aterial input function.
+   *
+   * Integrates x'(t) = A*x(t) + b*Ca(t) with x(t_0) = 0 on the sample points of the time grid. Ca(t) is the
+   * piecewise linear interpolation of the AIF (as in mitk::convoluteAIFWithExponential()); for this input the solution
+   * of each interval is given by the matrix exponential of the augmented system
+   *
+   *   d/dt [x, u, v] = [[A, b, 0], [0, 0, 1], [0, 0, 0]] * [x, u, v]   with u = Ca(t) and v = dCa/dt,
+   *
+   * so no intermediate steps are needed. The transition matrix only depends on A, b and the interval length; it is
+   * computed once per distinct interval length (i.e. once for uniform time grids) and reused for all intervals.
+   * Compared to a generic ODE stepper this is exact (up to rounding) and independent of a step size.*/
+  class MITKPHARMACOKINETICS_EXPORT LinearCompartmentIntegrator
+  {
+  public:
+    typedef itk::Array<double> ArrayType;
+    typedef vnl_matrix_fixed<double, 2, 2> SystemMatrixType;
+    typedef vnl_vector_fixed<double, 2> InputVectorType;
+
+    /** Returns the concentration of both compartments at each time point of timeGrid.
+     * @pre timeGrid and aif have the same size and timeGrid is strictly increasing.*/
+    static void Integrate(const SystemMatrixType& systemMatrix, const InputVectorType& inputVector,
+                          const ArrayType& timeGrid, const ArrayType& aif,
+                          ArrayType& compartment1, ArrayType& compartment2);
+
+    /** Matrix exponential exp(matrix*t) (scaling and squaring of the Taylor series).*/
+    static vnl_matrix_fixed<double, 4, 4> ComputeMatrixExponential(const vnl_matrix_fixed<double, 4, 4>& matrix,
+                                                                   double t);
+  };
+}
+
+#endif
@@ -27,8 +27,8 @@ namespace mitk
    * ve * dCi(t)/dt = PS * (Cp(t) - Ci(t))
    *
    * with concentration curve Cp(t) of the Blood Plasma p and Ce(t) of the Extracellular Extravascular Space(EES)(interstitial volume). CA(t) is the aterial concentration, i.e. the AIF
-   * Cp(t) and Ce(t) are found numerical via Runge-Kutta methode, implemented in Boosts numeric library ODEINT. Here we use a runge_kutta_cash_karp54 stepper with
-   * adaptive step size and error controll.
+   * Cp(t) and Ce(t) are found numerically. As the equations are linear, they are integrated exactly on the time grid
+   * for the piecewise linear AIF (see LinearCompartmentIntegrator).
    * From the resulting curves Cp(t) and Ce(t) the measured concentration Ctotal(t) is found vial
    *
    * Ctotal(t) = vp * Cp(t) + ve * Ce(t)
@@ -80,6 +80,8 @@ namespace mitk
 
     std::string GetModelType() const override;
 
+    /** The step size is kept for compatibility of stored fits. The integration on the time grid is exact
+     * and does not need it.*/
     itkGetConstReferenceMacro(ODEINTStepSize, double);
     itkSetMacro(ODEINTStepSize, double);
 
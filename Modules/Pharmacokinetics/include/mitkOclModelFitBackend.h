@@ -0,0 +1,88 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkOclModelFitBackend_h
+#define mitkOclModelFitBackend_h
+
+#if defined(PHARMACOKINETICS_USE_GPU) || DOXYGEN
+
+#include <string>
+
+#include "mitkOclFilter.h"
+#include "mitkModelFitBackendBase.h"
+
+#include "MitkPharmacokineticsExports.h"
+
+namespace mitk
+{
+  /** \class OclModelFitBackend
+   * \brief Fit backend (see ModelFitBackendBase) that runs batched Levenberg-Marquardt fits on the GPU via OpenCL.
+   *
+   * Every signal of a batch is fitted by one work item (kernel in ModelFitLevenbergMarquardt.cl). Supported are the
+   * analytic models LinearModel, T2DecayModel, StandardToftsModel, ExtendedToftsModel, OneTissueCompartmentModel,
+   * ExtendedOneTissueCompartmentModel and TwoTissueCompartmentModel fitted with a LevenbergMarquardtModelFitFunctor
+   * without constraint checker, scales and debug parameter maps.
+   * The kernel uses the iterations, tolerances and derivative step length of the functor. Its Jacobian is computed
+   * by forward differences and the fit is computed in double precision if the device supports it (single precision
+   * otherwise), so the results can slightly differ from the CPU fit.*/
+  class MITKPHARMACOKINETICS_EXPORT OclModelFitBackend : public ModelFitBackendBase, public OclFilter
+  {
+  public:
+    mitkClassMacro(OclModelFitBackend, ModelFitBackendBase);
+    itkFactorylessNewMacro(Self);
+
+    /** Model identifiers used by the kernel.*/
+    enum ModelType
+    {
+      LINEAR = 0,
+      T2_DECAY = 1,
+      STANDARD_TOFTS = 2,
+      EXTENDED_TOFTS = 3,
+      ONE_TISSUE_COMPARTMENT = 4,
+      EXTENDED_ONE_TISSUE_COMPARTMENT = 5,
+      TWO_TISSUE_COMPARTMENT = 6,
+      UNSUPPORTED
+    };
+
+    /** Returns the kernel identifier of the passed model or UNSUPPORTED.*/
+    static ModelType GetModelType(const ModelBase* model);
+
+    bool CanFit(const ModelBase* model, const ModelFitFunctorBase* fitFunctor) const override;
+
+    void Fit(const ModelBase* model, const ModelFitFunctorBase* fitFunctor, const BatchSignalsType& signals,
+             BatchParametersType& parameters) override;
+
+  protected:
+    OclModelFitBackend();
+    ~OclModelFitBackend() override;
+
+    /** Compiles the program (if needed) and creates the kernel.*/
+    bool Initialize();
+
+    us::Module* GetModule() override;
+
+    template <typename TReal>
+    void DoFit(ModelType modelType, const ModelBase* model, const ModelFitFunctorBase* fitFunctor,
+               const BatchSignalsType& signals, BatchParametersType& parameters);
+
+  private:
+    cl_kernel m_FitKernel;
+
+    /** Indicates if the device supports double precision (cl_khr_fp64); determined by Initialize().*/
+    bool m_UseDoublePrecision;
+
+    std::string m_SourcePreambel;
+  };
+}
+
+#endif
+#endif
@@ -61,6 +61,8 @@ namespace mitk
     ParameterNamesType GetParameterNames() const override;
     ParametersSizeType  GetNumberOfParameters() const override;
 
+    bool HasJacobian() const override;
+
     ParamterUnitMapType GetParameterUnits() const override;
 
 
@@ -76,6 +78,8 @@ namespace mitk
 
     ModelResultType ComputeModelfunction(const ParametersType& parameters) const override;
 
+    JacobianType ComputeJacobian(const ParametersType& parameters) const override;
+
     void PrintSelf(std::ostream& os, ::itk::Indent indent) const override;
 
   private:
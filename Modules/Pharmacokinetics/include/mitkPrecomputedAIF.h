@@ -0,0 +1,92 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkPrecomputedAIF_h
+#define mitkPrecomputedAIF_h
+
+#include "itkArray.h"
+
+#include <complex>
+#include <vector>
+
+#include "MitkPharmacokineticsExports.h"
+
+namespace mitk
+{
+  /** \class PrecomputedAIF
+   * \brief Aterial input function (AIF) on a fixed time grid, prepared for fast convolutions.
+   *
+   * All AIF based models convolve the AIF with a residue function. The quantities that only depend on the AIF and
+   * the time grid (interval lengths, coefficients of the piecewise linear AIF, its cumulative integral and, for
+   * uniform time grids, the spectrum of the zero padded AIF) are computed once in Initialize() and are reused by
+   * every convolution.
+   * The convolutions do not reallocate the passed result if it already has the right size.
+   *
+   * The class is not thread safe while it is initialized; afterwards all const methods may be used concurrently.*/
+  class MITKPHARMACOKINETICS_EXPORT PrecomputedAIF
+  {
+  public:
+    typedef itk::Array<double> ArrayType;
+
+    /** Residue functions with at least this number of samples are convolved via FFT
+     * by ConvoluteWithResidueFunction().*/
+    static const unsigned int FFT_CONVOLUTION_THRESHOLD;
+
+    PrecomputedAIF();
+    PrecomputedAIF(const ArrayType& timeGrid, const ArrayType& aif);
+
+    /** Computes the representation of the passed AIF (sampled on timeGrid).
+     * @pre timeGrid and aif have the same size and timeGrid is strictly increasing.*/
+    void Initialize(const ArrayType& timeGrid, const ArrayType& aif);
+
+    const ArrayType& GetTimeGrid() const;
+    const ArrayType& GetValues() const;
+
+    /** Integral of the (piecewise linear) AIF from the first time point to each time point of the grid.*/
+    const ArrayType& GetIntegral() const;
+
+    unsigned int GetNumberOfTimePoints() const;
+
+    /** Indicates if all intervals of the time grid have the same length.*/
+    bool IsUniform() const;
+
+    /** Convolves the piecewise linear AIF with the residue function R(t) = exp(-lambda*t).
+     * Yields the same values as mitk::convoluteAIFWithExponential(), but exp() is only reevaluated if the interval
+     * length changes, so it is called once per convolution on uniform time grids.*/
+    void ConvoluteWithExponential(double lambda, ArrayType& convolution) const;
+    ArrayType ConvoluteWithExponential(double lambda) const;
+
+    /** Convolves the AIF with a residue function that is sampled on the same (uniform) time grid:
+     *    convolution(k) = dt * sum_{j=0..k} aif(j) * residue(k-j)
+     * Long time series are convolved via FFT with the precomputed AIF spectrum, short ones directly.
+     * @pre IsUniform() and residue has GetNumberOfTimePoints() elements.*/
+    void ConvoluteWithResidueFunction(const ArrayType& residue, ArrayType& convolution) const;
+
+  private:
+    ArrayType m_TimeGrid;
+    ArrayType m_Values;
+    ArrayType m_Integral;
+
+    /** Length, slope and offset (aif(t) = offset + slope*t) of each interval of the piecewise linear AIF.*/
+    std::vector<double> m_IntervalLengths;
+    std::vector<double> m_Slopes;
+    std::vector<double> m_Offsets;
+
+    bool m_Uniform;
+
+    /** Spectrum of the zero padded AIF, only computed for uniform time grids with at least
+     * FFT_CONVOLUTION_THRESHOLD time points.*/
+    std::vector<std::complex<double> > m_Spectrum;
+  };
+}
+
+#endif
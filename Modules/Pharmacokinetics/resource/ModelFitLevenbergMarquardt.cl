@@ -0,0 +1,379 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+/* Batched Levenberg-Marquardt fit of the analytic models supported by mitk::OclModelFitBackend.
+ * Every work item fits one signal. The model types and parameter orders must match
+ * mitk::OclModelFitBackend::ModelType and the parameter positions of the respective MITK models.*/
+
+#ifdef MODELFIT_USE_DOUBLE
+#pragma OPENCL EXTENSION cl_khr_fp64 : enable
+typedef double real;
+#else
+typedef float real;
+#endif
+
+#define MODEL_LINEAR 0
+#define MODEL_T2_DECAY 1
+#define MODEL_STANDARD_TOFTS 2
+#define MODEL_EXTENDED_TOFTS 3
+#define MODEL_ONE_TISSUE_COMPARTMENT 4
+#define MODEL_EXTENDED_ONE_TISSUE_COMPARTMENT 5
+#define MODEL_TWO_TISSUE_COMPARTMENT 6
+
+#define MAX_PARAMETERS 5
+#define MAX_SETS (MAX_PARAMETERS + 1)
+
+/* All AIF based models are expressed as
+ *   signal(t) = aifWeight * aif(t) + weight1 * (aif * exp(-lambda1 t))(t) + weight2 * (aif * exp(-lambda2 t))(t)
+ * The coefficients only depend on the parameters, so they are computed once per model evaluation.*/
+typedef struct
+{
+  real aifWeight;
+  real weight1;
+  real lambda1;
+  real weight2;
+  real lambda2;
+} ConvolutionCoefficients;
+
+ConvolutionCoefficients computeCoefficients(const uint modelType, const real* p)
+{
+  ConvolutionCoefficients c;
+  c.aifWeight = 0;
+  c.weight1 = 0;
+  c.lambda1 = 1;
+  c.weight2 = 0;
+  c.lambda2 = 1;
+
+  if (modelType == MODEL_STANDARD_TOFTS || modelType == MODEL_EXTENDED_TOFTS)
+  {
+    const real ktrans = p[0] / 6000;
+    c.weight1 = ktrans;
+    c.lambda1 = ktrans / p[1];
+    if (modelType == MODEL_EXTENDED_TOFTS)
+    {
+      c.aifWeight = p[2];
+    }
+  }
+  else if (modelType == MODEL_ONE_TISSUE_COMPARTMENT || modelType == MODEL_EXTENDED_ONE_TISSUE_COMPARTMENT)
+  {
+    const real vb = modelType == MODEL_EXTENDED_ONE_TISSUE_COMPARTMENT ? p[2] : 0;
+    c.aifWeight = vb;
+    c.weight1 = (1 - vb) * p[0] / 60;
+    c.lambda1 = p[1] / 60;
+  }
+  else if (modelType == MODEL_TWO_TISSUE_COMPARTMENT)
+  {
+    const real k1 = p[0] / 60;
+    const real k2 = p[1] / 60;
+    const real k3 = p[2] / 60;
+    const real k4 = p[3] / 60;
+    const real vb = p[4];
+
+    const real sum = k2 + k3 + k4;
+    const real root = sqrt(sum * sum - 4 * k2 * k4);
+    const real alpha1 = 0.5 * (sum - root);
+    const real alpha2 = 0.5 * (sum + root);
+    const real factor = (1 - vb) * k1 / (alpha2 - alpha1);
+
+    c.aifWeight = vb;
+    c.weight1 = factor * (k4 - alpha1 + k3);
+    c.lambda1 = alpha1;
+    c.weight2 = factor * (alpha2 - k4 - k3);
+    c.lambda2 = alpha2;
+  }
+
+  return c;
+}
+
+/* One step of the iterative convolution of the piecewise linear AIF with exp(-lambda t) (see
+ * mitk::convoluteAIFWithExponential()). The interval contribution is evaluated relative to the start of the
+ * interval, which avoids the cancellation of the absolute time formulation in single precision.*/
+real convolutionStep(const real previous, const real lambda, const real dt, const real aifStart, const real slope)
+{
+  const real x = lambda * dt;
+  const real edt = exp(-x);
+  real constantPart;
+  real linearPart;
+  if (fabs(x) < (real)1e-3)
+  {
+    constantPart = dt * (1 - x * (0.5 - x / 6));
+    linearPart = dt * dt * (0.5 - x * ((real)1 / 6 - x / 24));
+  }
+  else
+  {
+    constantPart = (1 - edt) / lambda;
+    linearPart = (dt - constantPart) / lambda;
+  }
+  return edt * previous + aifStart * constantPart + slope * linearPart;
+}
+
+/* Evaluates the model for numberOfSets parameter sets at once and accumulates sum of squared differences and,
+ * if requested, the normal equations of the forward difference Jacobian. Set 0 is the current position, set k+1 the
+ * position with parameter k increased by steps[k].*/
+real evaluate(const uint modelType, const uint numberOfParameters, const uint numberOfSets,
+              real sets[MAX_SETS][MAX_PARAMETERS], const real* steps,
+              __global const real* signals, const uint signalIndex, const uint numberOfSignals,
+              __global const real* timeGrid, __global const real* aif, const uint numberOfTimePoints,
+              real* jtj, real* jtr)
+{
+  ConvolutionCoefficients coefficients[MAX_SETS];
+  real convolution1[MAX_SETS];
+  real convolution2[MAX_SETS];
+  for (uint s = 0; s < numberOfSets; ++s)
+  {
+    coefficients[s] = computeCoefficients(modelType, sets[s]);
+    convolution1[s] = 0;
+    convolution2[s] = 0;
+  }
+
+  const bool computeNormalEquations = numberOfSets > 1;
+  if (computeNormalEquations)
+  {
+    for (uint i = 0; i < numberOfParameters * numberOfParameters; ++i)
+    {
+      jtj[i] = 0;
+    }
+    for (uint i = 0; i < numberOfParameters; ++i)
+    {
+      jtr[i] = 0;
+    }
+  }
+
+  real cost = 0;
+  for (uint t = 0; t < numberOfTimePoints; ++t)
+  {
+    const real time = timeGrid[t];
+    const real aifValue = modelType >= MODEL_STANDARD_TOFTS ? aif[t] : 0;
+
+    real values[MAX_SETS];
+    for (uint s = 0; s < numberOfSets; ++s)
+    {
+      if (modelType == MODEL_LINEAR)
+      {
+        values[s] = sets[s][0] * time + sets[s][1];
+      }
+      else if (modelType == MODEL_T2_DECAY)
+      {
+        values[s] = sets[s][0] * exp(-time / sets[s][1]);
+      }
+      else
+      {
+        values[s] = coefficients[s].aifWeight * aifValue + coefficients[s].weight1 * convolution1[s]
+                    + coefficients[s].weight2 * convolution2[s];
+      }
+    }
+
+    const real residual = values[0] - signals[t * numberOfSignals + signalIndex];
+    cost += residual * residual;
+
+    if (computeNormalEquations)
+    {
+      real jacobian[MAX_PARAMETERS];
+      for (uint k = 0; k < numberOfParameters; ++k)
+      {
+        jacobian[k] = (values[k + 1] - values[0]) / steps[k];
+        jtr[k] += jacobian[k] * residual;
+      }
+      for (uint k = 0; k < numberOfParameters; ++k)
+      {
+        for (uint l = 0; l <= k; ++l)
+        {
+          jtj[k * numberOfParameters + l] += jacobian[k] * jacobian[l];
+        }
+      }
+    }
+
+    if (modelType >= MODEL_STANDARD_TOFTS && t + 1 < numberOfTimePoints)
+    {
+      const real dt = timeGrid[t + 1] - time;
+      const real slope = (aif[t + 1] - aifValue) / dt;
+      for (uint s = 0; s < numberOfSets; ++s)
+      {
+        convolution1[s] = convolutionStep(convolution1[s], coefficients[s].lambda1, dt, aifValue, slope);
+        if (modelType == MODEL_TWO_TISSUE_COMPARTMENT)
+        {
+          convolution2[s] = convolutionStep(convolution2[s], coefficients[s].lambda2, dt, aifValue, slope);
+        }
+      }
+    }
+  }
+
+  return cost;
+}
+
+/* Solves (jtj + damping * diag(jtj)) * delta = -jtr via Cholesky decomposition. Only the lower triangle of jtj is
+ * used. Returns false if the damped matrix is not positive definite.*/
+bool solveDampedSystem(const uint n, const real* jtj, const real* jtr, const real damping, real* delta)
+{
+  real l[MAX_PARAMETERS * MAX_PARAMETERS];
+  for (uint i = 0; i < n; ++i)
+  {
+    for (uint j = 0; j <= i; ++j)
+    {
+      real sum = jtj[i * n + j];
+      if (i == j)
+      {
+        sum += damping * jtj[i * n + i];
+      }
+      for (uint k = 0; k < j; ++k)
+      {
+        sum -= l[i * n + k] * l[j * n + k];
+      }
+
+      if (i == j)
+      {
+        if (!(sum > 0))
+        {
+          return false;
+        }
+        l[i * n + i] = sqrt(sum);
+      }
+      else
+      {
+        l[i * n + j] = sum / l[j * n + j];
+      }
+    }
+  }
+
+  real y[MAX_PARAMETERS];
+  for (uint i = 0; i < n; ++i)
+  {
+    real sum = -jtr[i];
+    for (uint k = 0; k < i; ++k)
+    {
+      sum -= l[i * n + k] * y[k];
+    }
+    y[i] = sum / l[i * n + i];
+  }
+
+  for (int i = (int)n - 1; i >= 0; --i)
+  {
+    real sum = y[i];
+    for (uint k = i + 1; k < n; ++k)
+    {
+      sum -= l[k * n + i] * delta[k];
+    }
+    delta[i] = sum / l[i * n + i];
+  }
+
+  return true;
+}
+
+/* signals:    numberOfTimePoints x numberOfSignals (time major, i.e. signals of one time point are contiguous)
+ * parameters: numberOfParameters x numberOfSignals; initial parameters on input, fitted parameters on output*/
+__kernel void ckLevenbergMarquardtFit(__global const real* signals,
+                                      __global real* parameters,
+                                      __global const real* timeGrid,
+                                      __global const real* aif,
+                                      const uint numberOfSignals,
+                                      const uint numberOfTimePoints,
+                                      const uint numberOfParameters,
+                                      const uint modelType,
+                                      const uint maxIterations,
+                                      const real derivativeStepLength,
+                                      const real valueTolerance,
+                                      const real gradientTolerance)
+{
+  const uint signalIndex = get_global_id(0);
+  if (signalIndex >= numberOfSignals)
+  {
+    return;
+  }
+
+  real sets[MAX_SETS][MAX_PARAMETERS];
+  real steps[MAX_PARAMETERS];
+  real jtj[MAX_PARAMETERS * MAX_PARAMETERS];
+  real jtr[MAX_PARAMETERS];
+  real delta[MAX_PARAMETERS];
+
+  for (uint k = 0; k < numberOfParameters; ++k)
+  {
+    sets[0][k] = parameters[k * numberOfSignals + signalIndex];
+  }
+
+  real damping = 1e-3;
+  real cost = evaluate(modelType, numberOfParameters, 1, sets, steps, signals, signalIndex, numberOfSignals,
+                       timeGrid, aif, numberOfTimePoints, jtj, jtr);
+
+  bool converged = false;
+  for (uint iteration = 0; iteration < maxIterations && !converged && isfinite(cost); ++iteration)
+  {
+    // forward differences relative to the magnitude of the parameters
+    for (uint s = 1; s <= numberOfParameters; ++s)
+    {
+      for (uint k = 0; k < numberOfParameters; ++k)
+      {
+        sets[s][k] = sets[0][k];
+      }
+      steps[s - 1] = derivativeStepLength * fmax(fabs(sets[0][s - 1]), (real)1);
+      sets[s][s - 1] += steps[s - 1];
+    }
+
+    evaluate(modelType, numberOfParameters, numberOfParameters + 1, sets, steps, signals, signalIndex,
+             numberOfSignals, timeGrid, aif, numberOfTimePoints, jtj, jtr);
+
+    // orthogonality of the residuals and the columns of the Jacobian (as the gradient tolerance of MINPACK)
+    bool orthogonal = true;
+    for (uint k = 0; k < numberOfParameters; ++k)
+    {
+      orthogonal = orthogonal && fabs(jtr[k]) <= gradientTolerance * sqrt(jtj[k * numberOfParameters + k] * cost);
+    }
+    if (orthogonal)
+    {
+      break;
+    }
+
+    // increase the damping until a step reduces the cost
+    bool improved = false;
+    while (!improved && damping < 1e10)
+    {
+      if (solveDampedSystem(numberOfParameters, jtj, jtr, damping, delta))
+      {
+        for (uint k = 0; k < numberOfParameters; ++k)
+        {
+          sets[1][k] = sets[0][k] + delta[k];
+        }
+        const real newCost = evaluate(modelType, numberOfParameters, 1, sets + 1, steps, signals, signalIndex,
+                                      numberOfSignals, timeGrid, aif, numberOfTimePoints, jtj, jtr);
+
+        if (isfinite(newCost) && newCost < cost)
+        {
+          improved = true;
+          const real reduction = cost - newCost;
+          for (uint k = 0; k < numberOfParameters; ++k)
+          {
+            sets[0][k] = sets[1][k];
+          }
+          cost = newCost;
+          damping = fmax(damping / 10, (real)1e-12);
+
+          converged = reduction <= valueTolerance * cost;
+        }
+      }
+
+      if (!improved)
+      {
+        damping *= 10;
+      }
+    }
+
+    if (!improved)
+    {
+      break;
+    }
+  }
+
+  for (uint k = 0; k < numberOfParameters; ++k)
+  {
+    parameters[k * numberOfSignals + signalIndex] = sets[0][k];
+  }
+}
@@ -85,6 +85,36 @@ void mitk::ConcentrationCurveGenerator::Convert()
 
 }
 
+void mitk::ConcentrationCurveGenerator::PrepareConversion(const Image* dynamicImage)
+{
+    if (!dynamicImage)
+    {
+        itkExceptionMacro( << "Dynamic Image not set!");
+    }
+
+    this->SetDynamicImage(dynamicImage);
+    PrepareBaselineImage();
+
+    this->m_FrameBaselineImage = nullptr;
+    mitk::CastToItkImage(this->m_BaselineImage, this->m_FrameBaselineImage);
+
+    this->m_FrameT10Image = nullptr;
+    if (this->m_UsingT1Map)
+    {
+        mitk::CastToItkImage(this->m_T10Image, this->m_FrameT10Image);
+    }
+}
+
+mitk::ConcentrationCurveGenerator::FrameImageType::Pointer mitk::ConcentrationCurveGenerator::ConvertFrame(const FrameImageType* frame, unsigned int /*timeStep*/) const
+{
+    if (this->m_FrameBaselineImage.IsNull())
+    {
+        itkExceptionMacro( << "Cannot convert frame. PrepareConversion() was not called.");
+    }
+
+    return this->convertFrameToConcentration(frame, this->m_FrameBaselineImage.GetPointer(), this->m_FrameT10Image.GetPointer());
+}
+
 void mitk::ConcentrationCurveGenerator::PrepareBaselineImage()
 {
 
@@ -207,11 +237,13 @@ mitk::Image::Pointer mitk::ConcentrationCurveGenerator::ConvertSignalToConcentra
 
 
 template<class TPixel_input, class TPixel_baseline>
-mitk::Image::Pointer mitk::ConcentrationCurveGenerator::convertToConcentration(const itk::Image<TPixel_input, 3> *itkInputImage, const itk::Image<TPixel_baseline, 3> *itkBaselineImage)
+mitk::ConcentrationCurveGenerator::ConvertedImageType::Pointer mitk::ConcentrationCurveGenerator::convertFrameToConcentration(const itk::Image<TPixel_input, 3> *itkInputImage, const itk::Image<TPixel_baseline, 3> *itkBaselineImage, const ConvertedImageType* itkT10Image) const
 {
     typedef itk::Image<TPixel_input, 3> InputImageType;
     typedef itk::Image<TPixel_baseline, 3> BaselineImageType;
 
+    ConvertedImageType::Pointer result;
+
 
     if (this->m_isT2weightedImage)
     {
@@ -230,7 +262,7 @@ mitk::Image::Pointer mitk::ConcentrationCurveGenerator::convertToConcentration(c
 
         ConversionT2Filter->Update();
 
-        m_ConvertSignalToConcentrationCurve_OutputImage = mitk::ImportItkImage(ConversionT2Filter->GetOutput())->Clone();
+        result = ConversionT2Filter->GetOutput();
       }
 
     else
@@ -250,15 +282,12 @@ mitk::Image::Pointer mitk::ConcentrationCurveGenerator::convertToConcentration(c
             ConversionTurboFlashFilter->SetInput2(itkBaselineImage);
 
             ConversionTurboFlashFilter->Update();
-            m_ConvertSignalToConcentrationCurve_OutputImage = mitk::ImportItkImage(ConversionTurboFlashFilter->GetOutput())->Clone();
+            result = ConversionTurboFlashFilter->GetOutput();
 
 
         }
         else if(this->m_UsingT1Map)
         {
-            typename ConvertedImageType::Pointer itkT10Image = ConvertedImageType::New();
-            mitk::CastToItkImage(m_T10Image, itkT10Image);
-
             typedef mitk::ConvertToConcentrationViaT1CalcFunctor <TPixel_input, TPixel_baseline, double, double> ConvertToConcentrationViaT1CalcFunctorType;
             typedef itk::TernaryFunctorImageFilter<InputImageType, BaselineImageType, ConvertedImageType, ConvertedImageType, ConvertToConcentrationViaT1CalcFunctorType> FilterT1MapType;
 
@@ -273,7 +302,7 @@ mitk::Image::Pointer mitk::ConcentrationCurveGenerator::convertToConcentration(c
             ConversionT1MapFilter->SetInput3(itkT10Image);
 
             ConversionT1MapFilter->Update();
-            m_ConvertSignalToConcentrationCurve_OutputImage = mitk::ImportItkImage(ConversionT1MapFilter->GetOutput())->Clone();
+            result = ConversionT1MapFilter->GetOutput();
 
 
         }
@@ -294,7 +323,7 @@ mitk::Image::Pointer mitk::ConcentrationCurveGenerator::convertToConcentration(c
 
             ConversionAbsoluteFilter->Update();
 
-            m_ConvertSignalToConcentrationCurve_OutputImage = mitk::ImportItkImage(ConversionAbsoluteFilter->GetOutput())->Clone();
+            result = ConversionAbsoluteFilter->GetOutput();
         }
 
         else if(this->m_RelativeSignalEnhancement)
@@ -313,12 +342,27 @@ mitk::Image::Pointer mitk::ConcentrationCurveGenerator::convertToConcentration(c
 
             ConversionRelativeFilter->Update();
 
-            m_ConvertSignalToConcentrationCurve_OutputImage = mitk::ImportItkImage(ConversionRelativeFilter->GetOutput())->Clone();
+            result = ConversionRelativeFilter->GetOutput();
         }
 
     }
-    return m_ConvertSignalToConcentrationCurve_OutputImage;
+    return result;
 
 }
 
+template<class TPixel_input, class TPixel_baseline>
+mitk::Image::Pointer mitk::ConcentrationCurveGenerator::convertToConcentration(const itk::Image<TPixel_input, 3> *itkInputImage, const itk::Image<TPixel_baseline, 3> *itkBaselineImage)
+{
+    ConvertedImageType::Pointer itkT10Image;
+    if (this->m_UsingT1Map)
+    {
+        mitk::CastToItkImage(m_T10Image, itkT10Image);
+    }
 
+    ConvertedImageType::Pointer concentrationImage = this->convertFrameToConcentration(itkInputImage, itkBaselineImage, itkT10Image.GetPointer());
+    if (concentrationImage.IsNotNull())
+    {
+        m_ConvertSignalToConcentrationCurve_OutputImage = mitk::ImportItkImage(concentrationImage)->Clone();
+    }
+    return m_ConvertSignalToConcentrationCurve_OutputImage;
+}
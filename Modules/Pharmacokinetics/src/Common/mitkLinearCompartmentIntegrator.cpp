@@ -0,0 +1,114 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkLinearCompartmentIntegrator.h"
+
+#include "mitkExceptionMacro.h"
+
+#include <cmath>
+
+vnl_matrix_fixed<double, 4, 4> mitk::LinearCompartmentIntegrator::ComputeMatrixExponential(
+  const vnl_matrix_fixed<double, 4, 4>& matrix, double t)
+{
+  typedef vnl_matrix_fixed<double, 4, 4> MatrixType;
+
+  MatrixType scaled = matrix * t;
+
+  // scale until the norm is small enough for a fast converging Taylor series
+  const double norm = scaled.operator_inf_norm();
+  unsigned int squarings = 0;
+  if (norm > 0.5)
+  {
+    squarings = static_cast<unsigned int>(std::ceil(std::log2(norm / 0.5)));
+    scaled /= std::pow(2.0, static_cast<double>(squarings));
+  }
+
+  MatrixType result;
+  result.set_identity();
+  MatrixType term;
+  term.set_identity();
+
+  // with a norm <= 0.5 the 13th term is below 1e-14 relative to the identity
+  for (unsigned int k = 1; k <= 13; ++k)
+  {
+    term = term * scaled / static_cast<double>(k);
+    result += term;
+  }
+
+  for (unsigned int i = 0; i < squarings; ++i)
+  {
+    result = result * result;
+  }
+
+  return result;
+}
+
+void mitk::LinearCompartmentIntegrator::Integrate(const SystemMatrixType& systemMatrix,
+                                                  const InputVectorType& inputVector,
+                                                  const ArrayType& timeGrid,
+                                                  const ArrayType& aif,
+                                                  ArrayType& compartment1,
+                                                  ArrayType& compartment2)
+{
+  if (timeGrid.GetSize() != aif.GetSize())
+  {
+    mitkThrow() << "Cannot integrate compartment system. Size of AIF (" << aif.GetSize()
+                << ") does not match size of time grid (" << timeGrid.GetSize() << ").";
+  }
+
+  const unsigned int numberOfTimePoints = timeGrid.GetSize();
+  compartment1.SetSize(numberOfTimePoints);
+  compartment2.SetSize(numberOfTimePoints);
+  if (numberOfTimePoints == 0)
+  {
+    return;
+  }
+
+  vnl_matrix_fixed<double, 4, 4> augmented(0.0);
+  augmented(0, 0) = systemMatrix(0, 0);
+  augmented(0, 1) = systemMatrix(0, 1);
+  augmented(1, 0) = systemMatrix(1, 0);
+  augmented(1, 1) = systemMatrix(1, 1);
+  augmented(0, 2) = inputVector(0);
+  augmented(1, 2) = inputVector(1);
+  augmented(2, 3) = 1.0;
+
+  vnl_matrix_fixed<double, 4, 4> transition;
+  double lastDt = -1.0;
+
+  vnl_vector_fixed<double, 4> state(0.0);
+  compartment1(0) = 0.0;
+  compartment2(0) = 0.0;
+
+  for (unsigned int i = 0; i + 1 < numberOfTimePoints; ++i)
+  {
+    const double dt = timeGrid(i + 1) - timeGrid(i);
+    if (dt <= 0.0)
+    {
+      mitkThrow() << "Cannot integrate compartment system. Time grid is not strictly increasing at index " << i << ".";
+    }
+
+    if (dt != lastDt)
+    {
+      transition = ComputeMatrixExponential(augmented, dt);
+      lastDt = dt;
+    }
+
+    // the input of the interval starts at the sampled AIF value with the slope of the interval
+    state(2) = aif(i);
+    state(3) = (aif(i + 1) - aif(i)) / dt;
+    state = transition * state;
+
+    compartment1(i + 1) = state(0);
+    compartment2(i + 1) = state(1);
+  }
+}
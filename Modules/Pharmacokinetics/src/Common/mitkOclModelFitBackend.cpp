@@ -0,0 +1,338 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#if defined(PHARMACOKINETICS_USE_GPU) || DOXYGEN
+
+#include "mitkOclModelFitBackend.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "usServiceReference.h"
+#include <usGetModuleContext.h>
+#include <usModuleContext.h>
+
+#include "mitkOclResourceService.h"
+#include "mitkExceptionMacro.h"
+
+#include "mitkLevenbergMarquardtModelFitFunctor.h"
+#include "mitkAIFBasedModelBase.h"
+
+namespace
+{
+  OclResourceService* GetResourceService()
+  {
+    us::ServiceReference<OclResourceService> ref = us::GetModuleContext()->GetServiceReference<OclResourceService>();
+    return us::GetModuleContext()->GetService<OclResourceService>(ref);
+  }
+
+  /** RAII wrapper, so the buffers are also released if an error is thrown.*/
+  class ScopedBuffer
+  {
+  public:
+    ScopedBuffer(cl_context context, cl_mem_flags flags, size_t size, void* hostData)
+    {
+      cl_int clErr = 0;
+      m_Buffer = clCreateBuffer(context, flags, size, hostData, &clErr);
+      if (clErr != CL_SUCCESS)
+      {
+        mitkThrow() << "Cannot create OpenCL buffer for model fit. Error: " << GetOclErrorAsString(clErr);
+      }
+    }
+
+    ~ScopedBuffer()
+    {
+      clReleaseMemObject(m_Buffer);
+    }
+
+    cl_mem& Get()
+    {
+      return m_Buffer;
+    }
+
+  private:
+    cl_mem m_Buffer;
+  };
+}
+
+mitk::OclModelFitBackend::OclModelFitBackend() : m_FitKernel(nullptr), m_UseDoublePrecision(false)
+{
+  this->AddSourceFile("ModelFitLevenbergMarquardt.cl");
+  this->m_FilterID = "ModelFitLevenbergMarquardt";
+}
+
+mitk::OclModelFitBackend::~OclModelFitBackend()
+{
+  if (this->m_FitKernel)
+  {
+    clReleaseKernel(this->m_FitKernel);
+  }
+}
+
+us::Module* mitk::OclModelFitBackend::GetModule()
+{
+  return us::GetModuleContext()->GetModule();
+}
+
+mitk::OclModelFitBackend::ModelType mitk::OclModelFitBackend::GetModelType(const ModelBase* model)
+{
+  if (!model)
+  {
+    return UNSUPPORTED;
+  }
+
+  // compare the class names, so derived models with another model function are not mistaken for their base
+  const std::string className = model->GetNameOfClass();
+  if (className == "LinearModel")
+  {
+    return LINEAR;
+  }
+  if (className == "T2DecayModel")
+  {
+    return T2_DECAY;
+  }
+  if (className == "StandardToftsModel")
+  {
+    return STANDARD_TOFTS;
+  }
+  if (className == "ExtendedToftsModel")
+  {
+    return EXTENDED_TOFTS;
+  }
+  if (className == "OneTissueCompartmentModel")
+  {
+    return ONE_TISSUE_COMPARTMENT;
+  }
+  if (className == "ExtendedOneTissueCompartmentModel")
+  {
+    return EXTENDED_ONE_TISSUE_COMPARTMENT;
+  }
+  if (className == "TwoTissueCompartmentModel")
+  {
+    return TWO_TISSUE_COMPARTMENT;
+  }
+  return UNSUPPORTED;
+}
+
+bool mitk::OclModelFitBackend::CanFit(const ModelBase* model, const ModelFitFunctorBase* fitFunctor) const
+{
+  const ModelType modelType = GetModelType(model);
+  if (modelType == UNSUPPORTED || model->GetTimeGrid().GetSize() < 2)
+  {
+    return false;
+  }
+
+  if (modelType >= STANDARD_TOFTS)
+  {
+    const auto* aifModel = dynamic_cast<const AIFBasedModelBase*>(model);
+    if (!aifModel ||
+        aifModel->GetPrecomputedAterialInputFunction().GetNumberOfTimePoints() != model->GetTimeGrid().GetSize())
+    {
+      return false;
+    }
+  }
+
+  // the kernel only implements the unconstrained and unscaled least squares fit of the functor
+  const auto* lmFunctor = dynamic_cast<const LevenbergMarquardtModelFitFunctor*>(fitFunctor);
+  if (!lmFunctor || lmFunctor->GetDebugParameterMaps() || lmFunctor->GetConstraintChecker() != nullptr)
+  {
+    return false;
+  }
+
+  const auto scales = const_cast<LevenbergMarquardtModelFitFunctor*>(lmFunctor)->GetScales();
+  for (unsigned int i = 0; i < scales.GetSize(); ++i)
+  {
+    if (scales[i] != 1.0)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool mitk::OclModelFitBackend::Initialize()
+{
+  if (this->m_FitKernel)
+  {
+    return true;
+  }
+
+  OclResourceService* resources = GetResourceService();
+  if (!resources || !resources->GetContext())
+  {
+    MITK_ERROR << "No OpenCL context available. Cannot initialize model fit backend.";
+    return false;
+  }
+
+  size_t extensionsSize = 0;
+  cl_device_id device = resources->GetCurrentDevice();
+  clGetDeviceInfo(device, CL_DEVICE_EXTENSIONS, 0, nullptr, &extensionsSize);
+  std::string extensions(extensionsSize, '\0');
+  clGetDeviceInfo(device, CL_DEVICE_EXTENSIONS, extensionsSize, &extensions[0], nullptr);
+  this->m_UseDoublePrecision = extensions.find("cl_khr_fp64") != std::string::npos;
+
+  // the program is stored by the resource service under the filter id; both precisions must not share an entry
+  if (this->m_UseDoublePrecision)
+  {
+    this->m_SourcePreambel = "#define MODELFIT_USE_DOUBLE";
+    this->m_FilterID = "ModelFitLevenbergMarquardtDouble";
+  }
+  else
+  {
+    this->m_SourcePreambel = " ";
+    this->m_FilterID = "ModelFitLevenbergMarquardtFloat";
+    this->SetCompilerFlags("-cl-single-precision-constant");
+    MITK_INFO << "OpenCL device does not support double precision. Model fits are computed in single precision.";
+  }
+  this->SetSourcePreambel(this->m_SourcePreambel.c_str());
+
+  if (!OclFilter::Initialize() || !OclFilter::IsInitialized())
+  {
+    return false;
+  }
+
+  cl_int clErr = 0;
+  this->m_FitKernel = clCreateKernel(this->m_ClProgram, "ckLevenbergMarquardtFit", &clErr);
+  const bool success = CHECK_OCL_ERR(clErr);
+
+  if (!success)
+  {
+    this->m_FitKernel = nullptr;
+  }
+
+  return success;
+}
+
+void mitk::OclModelFitBackend::Fit(const ModelBase* model, const ModelFitFunctorBase* fitFunctor,
+                                   const BatchSignalsType& signals, BatchParametersType& parameters)
+{
+  if (!this->CanFit(model, fitFunctor))
+  {
+    mitkThrow() << "Cannot fit on GPU. Model or fit functor is not supported by the OpenCL fit backend.";
+  }
+
+  if (signals.rows() != model->GetTimeGrid().GetSize() || parameters.rows() != model->GetNumberOfParameters() ||
+      signals.cols() != parameters.cols())
+  {
+    mitkThrow() << "Cannot fit on GPU. Size of signals (" << signals.rows() << "x" << signals.cols()
+                << ") or parameters (" << parameters.rows() << "x" << parameters.cols()
+                << ") does not match the model.";
+  }
+
+  if (signals.cols() == 0)
+  {
+    return;
+  }
+
+  if (!this->Initialize())
+  {
+    OclResourceService* resources = GetResourceService();
+    if (resources)
+    {
+      resources->InvalidateStorage();
+    }
+    mitkThrow() << "OpenCL fit backend is not initialized. Cannot fit.";
+  }
+
+  const ModelType modelType = GetModelType(model);
+  if (this->m_UseDoublePrecision)
+  {
+    this->DoFit<cl_double>(modelType, model, fitFunctor, signals, parameters);
+  }
+  else
+  {
+    this->DoFit<cl_float>(modelType, model, fitFunctor, signals, parameters);
+  }
+}
+
+template <typename TReal>
+void mitk::OclModelFitBackend::DoFit(ModelType modelType, const ModelBase* model,
+                                     const ModelFitFunctorBase* fitFunctor, const BatchSignalsType& signals,
+                                     BatchParametersType& parameters)
+{
+  const auto* lmFunctor = dynamic_cast<const LevenbergMarquardtModelFitFunctor*>(fitFunctor);
+  auto* functor = const_cast<LevenbergMarquardtModelFitFunctor*>(lmFunctor);
+
+  const cl_uint numberOfTimePoints = signals.rows();
+  const cl_uint numberOfSignals = signals.cols();
+  const cl_uint numberOfParameters = parameters.rows();
+
+  // both batch types are row major with one column per signal, which is the layout of the kernel
+  std::vector<TReal> signalData(signals.data_block(), signals.data_block() + signals.size());
+  std::vector<TReal> parameterData(parameters.data_block(), parameters.data_block() + parameters.size());
+
+  const ModelBase::TimeGridType& timeGrid = model->GetTimeGrid();
+  std::vector<TReal> timeGridData(timeGrid.begin(), timeGrid.end());
+  std::vector<TReal> aifData(numberOfTimePoints, 0);
+  if (modelType >= STANDARD_TOFTS)
+  {
+    const auto* aifModel = dynamic_cast<const AIFBasedModelBase*>(model);
+    const auto& aif = aifModel->GetPrecomputedAterialInputFunction().GetValues();
+    aifData.assign(aif.begin(), aif.end());
+  }
+
+  const cl_context context = GetResourceService()->GetContext();
+  ScopedBuffer signalBuffer(context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, sizeof(TReal) * signalData.size(),
+                            signalData.data());
+  ScopedBuffer parameterBuffer(context, CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR,
+                               sizeof(TReal) * parameterData.size(), parameterData.data());
+  ScopedBuffer timeGridBuffer(context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, sizeof(TReal) * timeGridData.size(),
+                              timeGridData.data());
+  ScopedBuffer aifBuffer(context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, sizeof(TReal) * aifData.size(),
+                         aifData.data());
+
+  const cl_uint clModelType = modelType;
+  const cl_uint iterations = functor->GetIterations();
+  const TReal derivativeStepLength = functor->GetDerivativeStepLength();
+  const TReal valueTolerance = functor->GetValueTolerance();
+  const TReal gradientTolerance = functor->GetGradientTolerance();
+
+  cl_int clErr = 0;
+  clErr = clSetKernelArg(this->m_FitKernel, 0, sizeof(cl_mem), &signalBuffer.Get());
+  clErr |= clSetKernelArg(this->m_FitKernel, 1, sizeof(cl_mem), &parameterBuffer.Get());
+  clErr |= clSetKernelArg(this->m_FitKernel, 2, sizeof(cl_mem), &timeGridBuffer.Get());
+  clErr |= clSetKernelArg(this->m_FitKernel, 3, sizeof(cl_mem), &aifBuffer.Get());
+  clErr |= clSetKernelArg(this->m_FitKernel, 4, sizeof(cl_uint), &numberOfSignals);
+  clErr |= clSetKernelArg(this->m_FitKernel, 5, sizeof(cl_uint), &numberOfTimePoints);
+  clErr |= clSetKernelArg(this->m_FitKernel, 6, sizeof(cl_uint), &numberOfParameters);
+  clErr |= clSetKernelArg(this->m_FitKernel, 7, sizeof(cl_uint), &clModelType);
+  clErr |= clSetKernelArg(this->m_FitKernel, 8, sizeof(cl_uint), &iterations);
+  clErr |= clSetKernelArg(this->m_FitKernel, 9, sizeof(TReal), &derivativeStepLength);
+  clErr |= clSetKernelArg(this->m_FitKernel, 10, sizeof(TReal), &valueTolerance);
+  clErr |= clSetKernelArg(this->m_FitKernel, 11, sizeof(TReal), &gradientTolerance);
+  CHECK_OCL_ERR(clErr);
+
+  if (clErr != CL_SUCCESS)
+  {
+    mitkThrow() << "Cannot set arguments of OpenCL model fit kernel. Error: " << GetOclErrorAsString(clErr);
+  }
+
+  this->SetWorkingSize(64, numberOfSignals);
+  if (!this->ExecuteKernel(this->m_FitKernel, 1))
+  {
+    mitkThrow() << "OpenCL error while executing model fit kernel.";
+  }
+
+  clErr = clEnqueueReadBuffer(this->m_CommandQue, parameterBuffer.Get(), CL_TRUE, 0,
+                              sizeof(TReal) * parameterData.size(), parameterData.data(), 0, nullptr, nullptr);
+  CHECK_OCL_ERR(clErr);
+
+  if (clErr != CL_SUCCESS)
+  {
+    mitkThrow() << "Cannot read fitted parameters from GPU. Error: " << GetOclErrorAsString(clErr);
+  }
+
+  std::copy(parameterData.begin(), parameterData.end(), parameters.data_block());
+}
+
+#endif
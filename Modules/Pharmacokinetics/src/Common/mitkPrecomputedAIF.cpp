@@ -0,0 +1,218 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkPrecomputedAIF.h"
+
+#include "mitkExceptionMacro.h"
+
+#include <vnl/algo/vnl_fft_1d.h>
+
+#include <cmath>
+
+const unsigned int mitk::PrecomputedAIF::FFT_CONVOLUTION_THRESHOLD = 64;
+
+namespace
+{
+  unsigned int GetFFTSize(unsigned int numberOfTimePoints)
+  {
+    // the padding to twice the size avoids the wrap around of the cyclic convolution
+    unsigned int size = 1;
+    while (size < 2 * numberOfTimePoints)
+    {
+      size *= 2;
+    }
+    return size;
+  }
+}
+
+mitk::PrecomputedAIF::PrecomputedAIF() : m_Uniform(false)
+{
+}
+
+mitk::PrecomputedAIF::PrecomputedAIF(const ArrayType& timeGrid, const ArrayType& aif) : m_Uniform(false)
+{
+  this->Initialize(timeGrid, aif);
+}
+
+void mitk::PrecomputedAIF::Initialize(const ArrayType& timeGrid, const ArrayType& aif)
+{
+  if (timeGrid.GetSize() != aif.GetSize())
+  {
+    mitkThrow() << "Cannot precompute AIF. Size of AIF (" << aif.GetSize() << ") does not match size of time grid ("
+                << timeGrid.GetSize() << ").";
+  }
+
+  const unsigned int numberOfTimePoints = timeGrid.GetSize();
+  const unsigned int numberOfIntervals = numberOfTimePoints > 0 ? numberOfTimePoints - 1 : 0;
+
+  m_TimeGrid = timeGrid;
+  m_Values = aif;
+  m_Integral.SetSize(numberOfTimePoints);
+  m_Integral.fill(0.0);
+  m_IntervalLengths.resize(numberOfIntervals);
+  m_Slopes.resize(numberOfIntervals);
+  m_Offsets.resize(numberOfIntervals);
+  m_Spectrum.clear();
+  m_Uniform = numberOfIntervals > 0;
+
+  for (unsigned int i = 0; i < numberOfIntervals; ++i)
+  {
+    const double dt = timeGrid(i + 1) - timeGrid(i);
+    if (dt <= 0.0)
+    {
+      mitkThrow() << "Cannot precompute AIF. Time grid is not strictly increasing at index " << i << ".";
+    }
+
+    m_IntervalLengths[i] = dt;
+    m_Slopes[i] = (aif(i + 1) - aif(i)) / dt;
+    m_Offsets[i] = aif(i) - m_Slopes[i] * timeGrid(i);
+    m_Integral(i + 1) = m_Integral(i) + 0.5 * (aif(i) + aif(i + 1)) * dt;
+
+    m_Uniform = m_Uniform && std::abs(dt - m_IntervalLengths[0]) <= 1e-6 * m_IntervalLengths[0];
+  }
+
+  if (m_Uniform && numberOfTimePoints >= FFT_CONVOLUTION_THRESHOLD)
+  {
+    const unsigned int fftSize = GetFFTSize(numberOfTimePoints);
+    vnl_vector<std::complex<double> > spectrum(fftSize, std::complex<double>(0.0, 0.0));
+    for (unsigned int i = 0; i < numberOfTimePoints; ++i)
+    {
+      spectrum[i] = aif(i);
+    }
+
+    vnl_fft_1d<double> fft(fftSize);
+    fft.fwd_transform(spectrum);
+    m_Spectrum.assign(spectrum.begin(), spectrum.end());
+  }
+}
+
+const mitk::PrecomputedAIF::ArrayType& mitk::PrecomputedAIF::GetTimeGrid() const
+{
+  return m_TimeGrid;
+}
+
+const mitk::PrecomputedAIF::ArrayType& mitk::PrecomputedAIF::GetValues() const
+{
+  return m_Values;
+}
+
+const mitk::PrecomputedAIF::ArrayType& mitk::PrecomputedAIF::GetIntegral() const
+{
+  return m_Integral;
+}
+
+unsigned int mitk::PrecomputedAIF::GetNumberOfTimePoints() const
+{
+  return m_TimeGrid.GetSize();
+}
+
+bool mitk::PrecomputedAIF::IsUniform() const
+{
+  return m_Uniform;
+}
+
+void mitk::PrecomputedAIF::ConvoluteWithExponential(double lambda, ArrayType& convolution) const
+{
+  const unsigned int numberOfTimePoints = m_TimeGrid.GetSize();
+  if (convolution.GetSize() != numberOfTimePoints)
+  {
+    convolution.SetSize(numberOfTimePoints);
+  }
+  if (numberOfTimePoints == 0)
+  {
+    return;
+  }
+
+  convolution(0) = 0;
+
+  double lastDt = -1.0;
+  double edt = 0.0;
+  double previous = 0.0;
+  for (unsigned int i = 0; i < m_IntervalLengths.size(); ++i)
+  {
+    const double dt = m_IntervalLengths[i];
+    if (dt != lastDt)
+    {
+      edt = exp(-lambda * dt);
+      lastDt = dt;
+    }
+
+    const double m = m_Slopes[i];
+    previous = edt * previous
+             + m_Offsets[i] / lambda * (1 - edt)
+             + m / (lambda * lambda) * ((lambda * m_TimeGrid(i + 1) - 1) - edt * (lambda * m_TimeGrid(i) - 1));
+    convolution(i + 1) = previous;
+  }
+}
+
+mitk::PrecomputedAIF::ArrayType mitk::PrecomputedAIF::ConvoluteWithExponential(double lambda) const
+{
+  ArrayType convolution;
+  this->ConvoluteWithExponential(lambda, convolution);
+  return convolution;
+}
+
+void mitk::PrecomputedAIF::ConvoluteWithResidueFunction(const ArrayType& residue, ArrayType& convolution) const
+{
+  const unsigned int numberOfTimePoints = m_TimeGrid.GetSize();
+  if (!m_Uniform)
+  {
+    mitkThrow() << "Cannot convolve AIF with sampled residue function. Time grid is not uniform.";
+  }
+  if (residue.GetSize() != numberOfTimePoints)
+  {
+    mitkThrow() << "Cannot convolve AIF with sampled residue function. Size of residue function ("
+                << residue.GetSize() << ") does not match size of time grid (" << numberOfTimePoints << ").";
+  }
+
+  if (convolution.GetSize() != numberOfTimePoints)
+  {
+    convolution.SetSize(numberOfTimePoints);
+  }
+
+  const double dt = m_IntervalLengths[0];
+
+  if (m_Spectrum.empty())
+  {
+    for (unsigned int k = 0; k < numberOfTimePoints; ++k)
+    {
+      double sum = 0.0;
+      for (unsigned int j = 0; j <= k; ++j)
+      {
+        sum += m_Values(j) * residue(k - j);
+      }
+      convolution(k) = dt * sum;
+    }
+    return;
+  }
+
+  const unsigned int fftSize = m_Spectrum.size();
+  vnl_vector<std::complex<double> > product(fftSize, std::complex<double>(0.0, 0.0));
+  for (unsigned int i = 0; i < numberOfTimePoints; ++i)
+  {
+    product[i] = residue(i);
+  }
+
+  vnl_fft_1d<double> fft(fftSize);
+  fft.fwd_transform(product);
+  for (unsigned int i = 0; i < fftSize; ++i)
+  {
+    product[i] *= m_Spectrum[i];
+  }
+  fft.bwd_transform(product);
+
+  // the backward transformation is not normalized
+  for (unsigned int k = 0; k < numberOfTimePoints; ++k)
+  {
+    convolution(k) = dt * product[k].real() / fftSize;
+  }
+}
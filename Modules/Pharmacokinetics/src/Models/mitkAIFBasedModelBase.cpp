@@ -46,7 +46,7 @@ std::string mitk::AIFBasedModelBase::GetYAxisUnit() const
   return "";
 }
 
-mitk::AIFBasedModelBase::AIFBasedModelBase()
+mitk::AIFBasedModelBase::AIFBasedModelBase() : m_PrecomputedAIFTime(0)
 {
 }
 
@@ -81,6 +81,20 @@ mitk::AIFBasedModelBase::GetAterialInputFunction(TimeGridType CurrentTimeGrid) c
   }
 }
 
+const mitk::PrecomputedAIF&
+mitk::AIFBasedModelBase::GetPrecomputedAterialInputFunction() const
+{
+  std::lock_guard<std::mutex> lock(m_PrecomputedAIFMutex);
+
+  if (m_PrecomputedAIFTime < this->GetMTime())
+  {
+    m_PrecomputedAIF.Initialize(this->m_TimeGrid, this->GetAterialInputFunction(this->m_TimeGrid));
+    m_PrecomputedAIFTime = this->GetMTime();
+  }
+
+  return m_PrecomputedAIF;
+}
+
 mitk::AIFBasedModelBase::ParameterNamesType mitk::AIFBasedModelBase::GetStaticParameterNames() const
 {
   ParameterNamesType result;
@@ -88,8 +88,8 @@ mitk::ExtendedOneTissueCompartmentModel::ModelResultType mitk::ExtendedOneTissue
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
+  const PrecomputedAIF& precomputedAIF = this->GetPrecomputedAterialInputFunction();
+  const AterialInputFunctionType& aterialInputFunction = precomputedAIF.GetValues();
 
 
 
@@ -102,8 +102,7 @@ mitk::ExtendedOneTissueCompartmentModel::ModelResultType mitk::ExtendedOneTissue
 
 
 
-  mitk::ModelBase::ModelResultType convolution = mitk::convoluteAIFWithExponential(this->m_TimeGrid,
-      aterialInputFunction, k2);
+  mitk::ModelBase::ModelResultType convolution = precomputedAIF.ConvoluteWithExponential(k2);
 
   //Signal that will be returned by ComputeModelFunction
   mitk::ModelBase::ModelResultType signal(timeSteps);
@@ -126,6 +125,42 @@ mitk::ExtendedOneTissueCompartmentModel::ModelResultType mitk::ExtendedOneTissue
 
 
 
+bool mitk::ExtendedOneTissueCompartmentModel::HasJacobian() const
+{
+  return true;
+}
+
+mitk::ExtendedOneTissueCompartmentModel::JacobianType mitk::ExtendedOneTissueCompartmentModel::ComputeJacobian(
+  const ParametersType& parameters) const
+{
+  if (this->m_TimeGrid.GetSize() == 0)
+  {
+    itkExceptionMacro("No Time Grid Set! Cannot Calculate Jacobian");
+  }
+
+  const AterialInputFunctionType& aterialInputFunction = this->GetPrecomputedAterialInputFunction().GetValues();
+
+  const double K1 = parameters[POSITION_PARAMETER_k1] / 60.0;
+  const double k2 = parameters[POSITION_PARAMETER_k2] / 60.0;
+  const double VB = parameters[POSITION_PARAMETER_VB];
+
+  itk::Array<double> convolutionDerivative;
+  const itk::Array<double> convolution = mitk::convoluteAIFWithExponentialAndDerivative(this->m_TimeGrid,
+      aterialInputFunction, k2, convolutionDerivative);
+
+  JacobianType jacobian(this->GetNumberOfParameters(), this->m_TimeGrid.GetSize());
+
+  for (unsigned int i = 0; i < this->m_TimeGrid.GetSize(); ++i)
+  {
+    // signal = VB * aif + (1 - VB) * K1 * convolution(k2)
+    jacobian(POSITION_PARAMETER_k1, i) = (1 - VB) * convolution[i] / 60.0;
+    jacobian(POSITION_PARAMETER_k2, i) = (1 - VB) * K1 * convolutionDerivative[i] / 60.0;
+    jacobian(POSITION_PARAMETER_VB, i) = aterialInputFunction[i] - K1 * convolution[i];
+  }
+
+  return jacobian;
+}
+
 itk::LightObject::Pointer mitk::ExtendedOneTissueCompartmentModel::InternalClone() const
 {
   ExtendedOneTissueCompartmentModel::Pointer newClone = ExtendedOneTissueCompartmentModel::New();
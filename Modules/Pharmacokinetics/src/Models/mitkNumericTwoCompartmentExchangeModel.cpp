@@ -13,10 +13,7 @@ found in the LICENSE file.
 #include "mitkNumericTwoCompartmentExchangeModel.h"
 #include "mitkAIFParametrizerHelper.h"
 #include "mitkTimeGridHelper.h"
-#include "mitkTwoCompartmentExchangeModelDifferentialEquations.h"
-#include <vnl/algo/vnl_fft_1d.h>
-#include <boost/numeric/odeint.hpp>
-#include <fstream>
+#include "mitkLinearCompartmentIntegrator.h"
 
 const std::string mitk::NumericTwoCompartmentExchangeModel::MODEL_DISPLAY_NAME =
   "Numeric Two Compartment Exchange Model";
@@ -164,99 +161,46 @@ mitk::NumericTwoCompartmentExchangeModel::ComputeModelfunction(const ParametersT
 const
 {
   typedef itk::Array<double> ConcentrationCurveType;
-  typedef std::vector<double> ConcentrationVectorType;
 
   if (this->m_TimeGrid.GetSize() == 0)
   {
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
+  const AterialInputFunctionType& aterialInputFunction = this->GetPrecomputedAterialInputFunction().GetValues();
 
   unsigned int timeSteps = this->m_TimeGrid.GetSize();
 
-  /** @brief Boost::numeric::odeint works with type std::vector<double> thus, aif and grid are converted to ModelParameters( of type std::vector)
-   */
-  mitk::TwoCompartmentExchangeModelDifferentialEquations::AIFType aif = mitk::convertArrayToParameter(
-        aterialInputFunction);
-  mitk::TwoCompartmentExchangeModelDifferentialEquations::AIFType grid =
-    mitk::convertArrayToParameter(m_TimeGrid);
-
-  mitk::TwoCompartmentExchangeModelDifferentialEquations::AIFType aifODE = aif;
-  aifODE.push_back(aif[timeSteps - 1]);
-  mitk::TwoCompartmentExchangeModelDifferentialEquations::AIFType gridODE = grid;
-  gridODE.push_back(grid[timeSteps - 1] + (grid[timeSteps - 1] - grid[timeSteps - 2]));
-
-
-
   //Model Parameters
   double F = (double) parameters[POSITION_PARAMETER_F] / 6000.0;
   double PS  = (double) parameters[POSITION_PARAMETER_PS] / 6000.0;
   double ve = (double) parameters[POSITION_PARAMETER_ve];
   double vp = (double) parameters[POSITION_PARAMETER_vp];
 
+  /** @brief The mass balance equations are linear in Cp and Ce:
+   *  d/dt [Cp, Ce] = [[-(F+PS)/vp, PS/vp], [PS/ve, -PS/ve]] * [Cp, Ce] + [F/vp, 0] * CA(t)
+   *  thus they are integrated exactly on the time grid (see LinearCompartmentIntegrator).*/
+  LinearCompartmentIntegrator::SystemMatrixType systemMatrix;
+  systemMatrix(0, 0) = -(F + PS) / vp;
+  systemMatrix(0, 1) = PS / vp;
+  systemMatrix(1, 0) = PS / ve;
+  systemMatrix(1, 1) = -PS / ve;
 
-  /** @brief Initialize class TwoCompartmentExchangeModelDifferentialEquations defining the differential equations. AIF and Grid must be set so that at step t the aterial Concentration Ca(t) can be interpolated from AIF*/
-  mitk::TwoCompartmentExchangeModelDifferentialEquations ode;
-  ode.initialize(F, PS, ve, vp);
-  ode.setAIF(aifODE);
-  ode.setAIFTimeGrid(gridODE);
-
-  state_type x(2);
-  x[0] = 0.0;
-  x[1] = 0.0;
-  typedef boost::numeric::odeint::runge_kutta_cash_karp54<state_type> error_stepper_type;
-  //typedef boost::numeric::odeint::runge_kutta4< state_type > stepper_type;
-
-  /** @brief Results of odeeint x[0] and x[1]*/
-  ConcentrationVectorType Cp;
-  ConcentrationVectorType Ce;
-  ConcentrationVectorType odeTimeGrid;
-
-  error_stepper_type stepper;
-
-
-  /** @brief Stepsize. Should be adapted by stepper (runge_kutta_cash_karp54) */
-//  const double dt = 0.05;
-   const double dt = this->m_ODEINTStepSize;
-
-
-  /** @brief perform Step t -> t+dt to calculate approximate value x(t+dt)*/
-  for (double t = 0.0; t < this->m_TimeGrid(this->m_TimeGrid.GetSize() - 1) - 2*dt; t += dt)
-  {
-    stepper.do_step(ode, x, t, dt);
-    Cp.push_back(x[0]);
-    Ce.push_back(x[1]);
-    odeTimeGrid.push_back(t);
-  }
-
-  /** @brief transfom result of Differential equations back to itk::Array and interpolate to m_TimeGrid (they are calculated on a different grid defined by stepsize of odeint)*/
-  ConcentrationCurveType plasmaConcentration = mitk::convertParameterToArray(Cp);
-  ConcentrationCurveType EESConcentration = mitk::convertParameterToArray(Ce);
-  ConcentrationCurveType rungeKuttaTimeGrid = mitk::convertParameterToArray(odeTimeGrid);
-
-  mitk::ModelBase::ModelResultType C_Plasma = mitk::InterpolateSignalToNewTimeGrid(plasmaConcentration, rungeKuttaTimeGrid, m_TimeGrid);
-  mitk::ModelBase::ModelResultType C_EES = mitk::InterpolateSignalToNewTimeGrid(EESConcentration, rungeKuttaTimeGrid, m_TimeGrid);
+  LinearCompartmentIntegrator::InputVectorType inputVector;
+  inputVector(0) = F / vp;
+  inputVector(1) = 0.0;
 
+  ConcentrationCurveType C_Plasma;
+  ConcentrationCurveType C_EES;
+  LinearCompartmentIntegrator::Integrate(systemMatrix, inputVector, this->m_TimeGrid, aterialInputFunction,
+                                         C_Plasma, C_EES);
 
   //Signal that will be returned by ComputeModelFunction
   mitk::ModelBase::ModelResultType signal(timeSteps);
-  signal.fill(0.0);
 
-  mitk::ModelBase::ModelResultType::iterator signalPos = signal.begin();
-  mitk::ModelBase::ModelResultType::const_iterator CePos = C_EES.begin();
-
-  mitk::ModelBase::ModelResultType::const_iterator t = this->m_TimeGrid.begin();
-  mitk::ModelBase::ModelResultType::const_iterator Cin = aterialInputFunction.begin();
-
-
-
-  for (mitk::ModelBase::ModelResultType::const_iterator CpPos = C_Plasma.begin();
-       CpPos != C_Plasma.end(); ++CpPos, ++CePos, ++signalPos, ++t, ++Cin)
+  for (unsigned int i = 0; i < timeSteps; ++i)
   {
-    *signalPos = vp * (*CpPos) + ve * (*CePos);
-
+    signal[i] = vp * C_Plasma[i] + ve * C_EES[i];
   }
 
   return signal;
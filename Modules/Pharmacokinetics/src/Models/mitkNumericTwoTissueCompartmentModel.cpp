@@ -13,10 +13,7 @@ found in the LICENSE file.
 #include "mitkNumericTwoTissueCompartmentModel.h"
 #include "mitkAIFParametrizerHelper.h"
 #include "mitkTimeGridHelper.h"
-#include "mitkTwoTissueCompartmentModelDifferentialEquations.h"
-#include <vnl/algo/vnl_fft_1d.h>
-#include <boost/numeric/odeint.hpp>
-#include <fstream>
+#include "mitkLinearCompartmentIntegrator.h"
 
 const std::string mitk::NumericTwoTissueCompartmentModel::MODEL_DISPLAY_NAME =
   "Numeric Two Tissue Compartment Model";
@@ -101,30 +98,16 @@ mitk::NumericTwoTissueCompartmentModel::ModelResultType
 mitk::NumericTwoTissueCompartmentModel::ComputeModelfunction(const ParametersType& parameters) const
 {
   typedef itk::Array<double> ConcentrationCurveType;
-  typedef std::vector<double> ConcentrationVectorType;
 
   if (this->m_TimeGrid.GetSize() == 0)
   {
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
+  const AterialInputFunctionType& aterialInputFunction = this->GetPrecomputedAterialInputFunction().GetValues();
 
   unsigned int timeSteps = this->m_TimeGrid.GetSize();
 
-  /** @brief Boost::numeric::odeint works with type std::vector<double> thus, aif and grid are converted to ModelParameters( of type std::vector)
-   */
-  mitk::TwoTissueCompartmentModelDifferentialEquations::AIFType aif = mitk::convertArrayToParameter(
-        aterialInputFunction);
-  mitk::TwoTissueCompartmentModelDifferentialEquations::AIFType grid = mitk::convertArrayToParameter(
-        m_TimeGrid);
-
-  mitk::TwoTissueCompartmentModelDifferentialEquations::AIFType aifODE = aif;
-  aifODE.push_back(aif[timeSteps - 1]);
-  mitk::TwoTissueCompartmentModelDifferentialEquations::AIFType gridODE = grid;
-  gridODE.push_back(grid[timeSteps - 1] + (grid[timeSteps - 1] - grid[timeSteps - 2]));
-
   //Model Parameters
   double K1 = (double)parameters[POSITION_PARAMETER_K1] / 60.0;
   double k2 = (double)parameters[POSITION_PARAMETER_k2] / 60.0;
@@ -132,63 +115,30 @@ mitk::NumericTwoTissueCompartmentModel::ComputeModelfunction(const ParametersTyp
   double k4 = (double)parameters[POSITION_PARAMETER_k4] / 60.0;
   double VB = parameters[POSITION_PARAMETER_VB];
 
+  /** @brief The mass balance equations are linear in C1 and C2:
+   *  d/dt [C1, C2] = [[-(k2+k3), k4], [k3, -k4]] * [C1, C2] + [K1, 0] * Ca(t)
+   *  thus they are integrated exactly on the time grid (see LinearCompartmentIntegrator).*/
+  LinearCompartmentIntegrator::SystemMatrixType systemMatrix;
+  systemMatrix(0, 0) = -(k2 + k3);
+  systemMatrix(0, 1) = k4;
+  systemMatrix(1, 0) = k3;
+  systemMatrix(1, 1) = -k4;
 
-  /** @brief Initialize class TwpTissueCompartmentModelDifferentialEquations defining the differential equations. AIF and Grid must be set so that at step t the aterial Concentration Ca(t) can be interpolated from AIF*/
-  mitk::TwoTissueCompartmentModelDifferentialEquations ode;
-  ode.initialize(K1, k2, k3, k4);
-  ode.setAIF(aifODE);
-  ode.setAIFTimeGrid(gridODE);
-
-  state_type x(2);
-  x[0] = 0.0;
-  x[1] = 0.0;
-  typedef boost::numeric::odeint::runge_kutta_cash_karp54<state_type> error_stepper_type;
-  //typedef boost::numeric::odeint::runge_kutta4< state_type > stepper_type;
-
-  /** @brief Results of odeeint x[0] and x[1]*/
-  ConcentrationVectorType C1;
-  ConcentrationVectorType C2;
-  ConcentrationVectorType odeTimeGrid;
-
-  error_stepper_type stepper;
-  /** @brief Stepsize. Should be adapted by stepper (runge_kutta_cash_karp54) */
-  const double dt = 0.1;
-  /** @brief perform Step t -> t+dt to calculate approximate value x(t+dt)*/
-
-  double T = this->m_TimeGrid(timeSteps - 1) + (grid[timeSteps - 1] - grid[timeSteps - 2]);
-
-  for (double t = 0.0; t < T; t += dt)
-  {
-    stepper.do_step(ode, x, t, dt);
-    C1.push_back(x[0]);
-    C2.push_back(x[1]);
-    odeTimeGrid.push_back(t);
-
-  }
-
-  /** @brief transfom result of Differential equations back to itk::Array and interpolate to m_TimeGrid (they are calculated on a different grid defined by stepsize of odeint)*/
-  ConcentrationCurveType ConcentrationCompartment1 = mitk::convertParameterToArray(C1);
-  ConcentrationCurveType ConcentrationCompartment2 = mitk::convertParameterToArray(C2);
-  ConcentrationCurveType rungeKuttaTimeGrid = mitk::convertParameterToArray(odeTimeGrid);
-
-  mitk::ModelBase::ModelResultType C_1 = mitk::InterpolateSignalToNewTimeGrid(
-      ConcentrationCompartment1, rungeKuttaTimeGrid, m_TimeGrid);
-  mitk::ModelBase::ModelResultType C_2 = mitk::InterpolateSignalToNewTimeGrid(
-      ConcentrationCompartment2, rungeKuttaTimeGrid, m_TimeGrid);
+  LinearCompartmentIntegrator::InputVectorType inputVector;
+  inputVector(0) = K1;
+  inputVector(1) = 0.0;
 
+  ConcentrationCurveType C_1;
+  ConcentrationCurveType C_2;
+  LinearCompartmentIntegrator::Integrate(systemMatrix, inputVector, this->m_TimeGrid, aterialInputFunction,
+                                         C_1, C_2);
 
   //Signal that will be returned by ComputeModelFunction
   mitk::ModelBase::ModelResultType signal(timeSteps);
-  signal.fill(0.0);
-  mitk::ModelBase::ModelResultType::iterator signalPos = signal.begin();
-  mitk::ModelBase::ModelResultType::const_iterator C1Pos = C_1.begin();
-  mitk::ModelBase::ModelResultType::const_iterator C2Pos = C_2.begin();
-
 
-  for (AterialInputFunctionType::const_iterator aifpos = aterialInputFunction.begin();
-       aifpos != aterialInputFunction.end(); ++aifpos, ++C1Pos, ++C2Pos, ++signalPos)
+  for (unsigned int i = 0; i < timeSteps; ++i)
   {
-    *signalPos = VB * (*aifpos) + (1 - VB) * (*C1Pos + *C2Pos);
+    signal[i] = VB * aterialInputFunction[i] + (1 - VB) * (C_1[i] + C_2[i]);
   }
 
   return signal;
@@ -84,8 +84,8 @@ mitk::OneTissueCompartmentModel::ModelResultType mitk::OneTissueCompartmentModel
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
+  const PrecomputedAIF& precomputedAIF = this->GetPrecomputedAterialInputFunction();
+  const AterialInputFunctionType& aterialInputFunction = precomputedAIF.GetValues();
 
 
 
@@ -97,8 +97,7 @@ mitk::OneTissueCompartmentModel::ModelResultType mitk::OneTissueCompartmentModel
 
 
 
-  mitk::ModelBase::ModelResultType convolution = mitk::convoluteAIFWithExponential(this->m_TimeGrid,
-      aterialInputFunction, k2);
+  mitk::ModelBase::ModelResultType convolution = precomputedAIF.ConvoluteWithExponential(k2);
 
   //Signal that will be returned by ComputeModelFunction
   mitk::ModelBase::ModelResultType signal(timeSteps);
@@ -120,6 +119,40 @@ mitk::OneTissueCompartmentModel::ModelResultType mitk::OneTissueCompartmentModel
 
 
 
+bool mitk::OneTissueCompartmentModel::HasJacobian() const
+{
+  return true;
+}
+
+mitk::OneTissueCompartmentModel::JacobianType mitk::OneTissueCompartmentModel::ComputeJacobian(
+  const ParametersType& parameters) const
+{
+  if (this->m_TimeGrid.GetSize() == 0)
+  {
+    itkExceptionMacro("No Time Grid Set! Cannot Calculate Jacobian");
+  }
+
+  const AterialInputFunctionType& aterialInputFunction = this->GetPrecomputedAterialInputFunction().GetValues();
+
+  const double K1 = parameters[POSITION_PARAMETER_k1] / 60.0;
+  const double k2 = parameters[POSITION_PARAMETER_k2] / 60.0;
+
+  itk::Array<double> convolutionDerivative;
+  const itk::Array<double> convolution = mitk::convoluteAIFWithExponentialAndDerivative(this->m_TimeGrid,
+      aterialInputFunction, k2, convolutionDerivative);
+
+  JacobianType jacobian(this->GetNumberOfParameters(), this->m_TimeGrid.GetSize());
+
+  for (unsigned int i = 0; i < this->m_TimeGrid.GetSize(); ++i)
+  {
+    // signal = K1 * convolution(k2)
+    jacobian(POSITION_PARAMETER_k1, i) = convolution[i] / 60.0;
+    jacobian(POSITION_PARAMETER_k2, i) = K1 * convolutionDerivative[i] / 60.0;
+  }
+
+  return jacobian;
+}
+
 itk::LightObject::Pointer mitk::OneTissueCompartmentModel::InternalClone() const
 {
   OneTissueCompartmentModel::Pointer newClone = OneTissueCompartmentModel::New();
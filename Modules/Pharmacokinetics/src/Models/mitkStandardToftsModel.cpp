@@ -105,8 +105,8 @@ mitk::StandardToftsModel::ModelResultType mitk::StandardToftsModel::ComputeModel
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
+  const PrecomputedAIF& precomputedAIF = this->GetPrecomputedAterialInputFunction();
+  const AterialInputFunctionType& aterialInputFunction = precomputedAIF.GetValues();
 
 
 
@@ -119,8 +119,7 @@ mitk::StandardToftsModel::ModelResultType mitk::StandardToftsModel::ComputeModel
 
   double lambda =  ktrans / ve;
 
-  mitk::ModelBase::ModelResultType convolution = mitk::convoluteAIFWithExponential(this->m_TimeGrid,
-      aterialInputFunction, lambda);
+  mitk::ModelBase::ModelResultType convolution = precomputedAIF.ConvoluteWithExponential(lambda);
 
   //Signal that will be returned by ComputeModelFunction
   mitk::ModelBase::ModelResultType signal(timeSteps);
@@ -130,7 +129,7 @@ mitk::StandardToftsModel::ModelResultType mitk::StandardToftsModel::ComputeModel
   mitk::ModelBase::ModelResultType::const_iterator res = convolution.begin();
 
 
-  for (AterialInputFunctionType::iterator Cp = aterialInputFunction.begin();
+  for (AterialInputFunctionType::const_iterator Cp = aterialInputFunction.begin();
        Cp != aterialInputFunction.end(); ++res, ++signalPos, ++Cp)
   {
     *signalPos = ktrans * (*res);
@@ -141,6 +140,75 @@ mitk::StandardToftsModel::ModelResultType mitk::StandardToftsModel::ComputeModel
 }
 
 
+void mitk::StandardToftsModel::ComputeModelfunctionBatch(const BatchParametersType& parameters,
+    BatchSignalsType& signals) const
+{
+  if (this->m_TimeGrid.GetSize() == 0)
+  {
+    itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
+  }
+
+  const AterialInputFunctionType& aterialInputFunction = this->GetPrecomputedAterialInputFunction().GetValues();
+
+  const unsigned int numberOfSignals = parameters.cols();
+  const double* ve = parameters[POSITION_PARAMETER_ve];
+
+  itk::Array<double> ktrans(numberOfSignals);
+  itk::Array<double> lambdas(numberOfSignals);
+  for (unsigned int signalIndex = 0; signalIndex < numberOfSignals; ++signalIndex)
+  {
+    ktrans[signalIndex] = parameters(POSITION_PARAMETER_Ktrans, signalIndex) / 6000.0;
+    lambdas[signalIndex] = ktrans[signalIndex] / ve[signalIndex];
+  }
+
+  // the convolutions are computed in place of the signals
+  mitk::convoluteAIFWithExponential(this->m_TimeGrid, aterialInputFunction, lambdas, signals);
+
+  for (unsigned int timeIndex = 0; timeIndex < signals.rows(); ++timeIndex)
+  {
+    double* signal = signals[timeIndex];
+    for (unsigned int signalIndex = 0; signalIndex < numberOfSignals; ++signalIndex)
+    {
+      signal[signalIndex] = ktrans[signalIndex] * signal[signalIndex];
+    }
+  }
+}
+
+bool mitk::StandardToftsModel::HasJacobian() const
+{
+  return true;
+}
+
+mitk::StandardToftsModel::JacobianType mitk::StandardToftsModel::ComputeJacobian(
+  const ParametersType& parameters) const
+{
+  if (this->m_TimeGrid.GetSize() == 0)
+  {
+    itkExceptionMacro("No Time Grid Set! Cannot Calculate Jacobian");
+  }
+
+  const AterialInputFunctionType& aterialInputFunction = this->GetPrecomputedAterialInputFunction().GetValues();
+
+  const double ktrans = parameters[POSITION_PARAMETER_Ktrans] / 6000.0;
+  const double ve = parameters[POSITION_PARAMETER_ve];
+  const double lambda = ktrans / ve;
+
+  itk::Array<double> convolutionDerivative;
+  const itk::Array<double> convolution = mitk::convoluteAIFWithExponentialAndDerivative(this->m_TimeGrid,
+      aterialInputFunction, lambda, convolutionDerivative);
+
+  JacobianType jacobian(this->GetNumberOfParameters(), this->m_TimeGrid.GetSize());
+
+  for (unsigned int i = 0; i < this->m_TimeGrid.GetSize(); ++i)
+  {
+    // signal = ktrans * convolution(lambda) with lambda = ktrans / ve
+    jacobian(POSITION_PARAMETER_Ktrans, i) = (convolution[i] + lambda * convolutionDerivative[i]) / 6000.0;
+    jacobian(POSITION_PARAMETER_ve, i) = -ktrans * lambda / ve * convolutionDerivative[i];
+  }
+
+  return jacobian;
+}
+
 mitk::ModelBase::DerivedParameterMapType mitk::StandardToftsModel::ComputeDerivedParameters(
   const mitk::ModelBase::ParametersType& parameters) const
 {
@@ -1,4 +1,8 @@
 SET(MODULE_TESTS
   mitkDescriptivePharmacokineticBrixModelTest.cpp
+  mitkToftsModelBatchTest.cpp
+  mitkAnalyticJacobianTest.cpp
+  mitkPrecomputedAIFTest.cpp
+  mitkNumericCompartmentModelTest.cpp
   #ConvertToConcentrationTest.cpp
 )
@@ -0,0 +1,146 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestingMacros.h"
+#include "mitkVector.h"
+
+#include "mitkStandardToftsModel.h"
+#include "mitkExtendedToftsModel.h"
+#include "mitkOneTissueCompartmentModel.h"
+#include "mitkExtendedOneTissueCompartmentModel.h"
+#include "mitkSquaredDifferencesFitCostFunction.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  /** Compares the Jacobian of a model with central differences of its signal.*/
+  bool JacobianEqualsNumericDerivatives(const mitk::ModelBase* model, const mitk::ModelBase::ParametersType& parameters)
+  {
+    if (!model->HasJacobian())
+    {
+      return false;
+    }
+
+    const mitk::ModelBase::JacobianType jacobian = model->GetJacobian(parameters);
+    if (jacobian.rows() != parameters.GetSize() || jacobian.cols() != model->GetTimeGrid().GetSize())
+    {
+      return false;
+    }
+
+    for (unsigned int p = 0; p < parameters.GetSize(); ++p)
+    {
+      const double step = 1e-6 * std::max(1.0, std::abs(parameters[p]));
+      mitk::ModelBase::ParametersType lower = parameters;
+      mitk::ModelBase::ParametersType upper = parameters;
+      lower[p] -= step;
+      upper[p] += step;
+
+      const mitk::ModelBase::ModelResultType lowerSignal = model->GetSignal(lower);
+      const mitk::ModelBase::ModelResultType upperSignal = model->GetSignal(upper);
+
+      for (unsigned int t = 0; t < jacobian.cols(); ++t)
+      {
+        const double numeric = (upperSignal[t] - lowerSignal[t]) / (2 * step);
+        if (std::abs(numeric - jacobian(p, t)) > 1e-5 * std::max(1.0, std::abs(numeric)))
+        {
+          MITK_INFO << "Parameter " << p << ", time point " << t << ": analytic " << jacobian(p, t)
+                    << ", numeric " << numeric;
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  template <typename TModel>
+  typename TModel::Pointer CreateModel(const mitk::ModelBase::TimeGridType& grid,
+                                       const mitk::AIFBasedModelBase::AterialInputFunctionType& aif)
+  {
+    typename TModel::Pointer model = TModel::New();
+    model->SetTimeGrid(grid);
+    model->SetAterialInputFunctionValues(aif);
+    model->SetAterialInputFunctionTimeGrid(grid);
+    return model;
+  }
+}
+
+int mitkAnalyticJacobianTest(int  /*argc*/ , char*[] /*argv[]*/)
+{
+  MITK_TEST_BEGIN("AnalyticJacobian")
+
+  mitk::ModelBase::TimeGridType grid(30);
+  mitk::AIFBasedModelBase::AterialInputFunctionType aif(30);
+  for (unsigned int i = 0; i < grid.GetSize(); ++i)
+  {
+    // time grid in seconds, 4s between frames, bolus arrives after 20s
+    grid[i] = 4.0 * i;
+    aif[i] = grid[i] < 20.0 ? 0.0 : 5.0 * (grid[i] - 20.0) * exp(-(grid[i] - 20.0) / 10.0);
+  }
+
+  mitk::ModelBase::ParametersType toftsParameters(3);
+  toftsParameters[0] = 25.0;
+  toftsParameters[1] = 0.3;
+  toftsParameters[2] = 0.05;
+
+  mitk::ExtendedToftsModel::Pointer extendedTofts = CreateModel<mitk::ExtendedToftsModel>(grid, aif);
+  MITK_TEST_CONDITION_REQUIRED(JacobianEqualsNumericDerivatives(extendedTofts, toftsParameters),
+                               "Testing Jacobian of the extended Tofts model.");
+
+  mitk::ModelBase::ParametersType standardToftsParameters(2);
+  standardToftsParameters[0] = toftsParameters[0];
+  standardToftsParameters[1] = toftsParameters[1];
+
+  mitk::StandardToftsModel::Pointer standardTofts = CreateModel<mitk::StandardToftsModel>(grid, aif);
+  MITK_TEST_CONDITION_REQUIRED(JacobianEqualsNumericDerivatives(standardTofts, standardToftsParameters),
+                               "Testing Jacobian of the standard Tofts model.");
+
+  mitk::ModelBase::ParametersType compartmentParameters(3);
+  compartmentParameters[0] = 0.5;
+  compartmentParameters[1] = 0.8;
+  compartmentParameters[2] = 0.1;
+
+  mitk::ExtendedOneTissueCompartmentModel::Pointer extendedCompartment =
+    CreateModel<mitk::ExtendedOneTissueCompartmentModel>(grid, aif);
+  MITK_TEST_CONDITION_REQUIRED(JacobianEqualsNumericDerivatives(extendedCompartment, compartmentParameters),
+                               "Testing Jacobian of the extended one tissue compartment model.");
+
+  const mitk::ModelBase::ParametersType extendedCompartmentParameters = compartmentParameters;
+  compartmentParameters.SetSize(2);
+  compartmentParameters[0] = extendedCompartmentParameters[0];
+  compartmentParameters[1] = extendedCompartmentParameters[1];
+
+  mitk::OneTissueCompartmentModel::Pointer compartment = CreateModel<mitk::OneTissueCompartmentModel>(grid, aif);
+  MITK_TEST_CONDITION_REQUIRED(JacobianEqualsNumericDerivatives(compartment, compartmentParameters),
+                               "Testing Jacobian of the one tissue compartment model.");
+
+  // the cost function uses the Jacobian of the model for its derivative
+  mitk::SquaredDifferencesFitCostFunction::Pointer costFunction = mitk::SquaredDifferencesFitCostFunction::New();
+  costFunction->SetModel(compartment);
+  costFunction->SetSample(aif);
+  MITK_TEST_CONDITION_REQUIRED(costFunction->HasAnalyticDerivative(), "Testing analytic derivative of cost function.");
+
+  mitk::SquaredDifferencesFitCostFunction::DerivativeType derivative;
+  costFunction->GetDerivative(compartmentParameters, derivative);
+  const mitk::ModelBase::ModelResultType signal = compartment->GetSignal(compartmentParameters);
+  const mitk::ModelBase::JacobianType jacobian = compartment->GetJacobian(compartmentParameters);
+  bool derivativeIsCorrect = derivative.rows() == 2 && derivative.cols() == signal.GetSize();
+  for (unsigned int t = 0; derivativeIsCorrect && t < signal.GetSize(); ++t)
+  {
+    derivativeIsCorrect = mitk::Equal(derivative(1, t), -2.0 * (aif[t] - signal[t]) * jacobian(1, t), 1e-10, true);
+  }
+  MITK_TEST_CONDITION_REQUIRED(derivativeIsCorrect, "Testing derivative of cost function.");
+
+  MITK_TEST_END()
+}
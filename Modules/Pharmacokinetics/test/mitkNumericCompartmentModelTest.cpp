@@ -0,0 +1,116 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestingMacros.h"
+#include "mitkVector.h"
+
+#include "mitkLinearCompartmentIntegrator.h"
+#include "mitkNumericTwoCompartmentExchangeModel.h"
+#include "mitkNumericTwoTissueCompartmentModel.h"
+#include "mitkTwoCompartmentExchangeModel.h"
+#include "mitkTwoTissueCompartmentModel.h"
+
+namespace
+{
+  bool SignalsAreEqual(const mitk::ModelBase* model, const mitk::ModelBase* referenceModel,
+                       const mitk::ModelBase::ParametersType& parameters)
+  {
+    const mitk::ModelBase::ModelResultType signal = model->GetSignal(parameters);
+    const mitk::ModelBase::ModelResultType reference = referenceModel->GetSignal(parameters);
+
+    if (signal.GetSize() != reference.GetSize())
+    {
+      return false;
+    }
+
+    for (unsigned int i = 0; i < signal.GetSize(); ++i)
+    {
+      if (!mitk::Equal(signal[i], reference[i], 1e-8 * (1.0 + std::abs(reference[i])), true))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  template <typename TModel>
+  typename TModel::Pointer CreateModel(const mitk::ModelBase::TimeGridType& grid,
+                                       const mitk::AIFBasedModelBase::AterialInputFunctionType& aif)
+  {
+    typename TModel::Pointer model = TModel::New();
+    model->SetTimeGrid(grid);
+    model->SetAterialInputFunctionValues(aif);
+    model->SetAterialInputFunctionTimeGrid(grid);
+    return model;
+  }
+}
+
+int mitkNumericCompartmentModelTest(int  /*argc*/ , char*[] /*argv[]*/)
+{
+  MITK_TEST_BEGIN("NumericCompartmentModel")
+
+  // the matrix exponential of a diagonal matrix is known
+  vnl_matrix_fixed<double, 4, 4> diagonal(0.0);
+  diagonal(0, 0) = -2.0;
+  diagonal(1, 1) = 0.5;
+  diagonal(2, 2) = 3.0;
+  const vnl_matrix_fixed<double, 4, 4> exponential =
+    mitk::LinearCompartmentIntegrator::ComputeMatrixExponential(diagonal, 2.0);
+  MITK_TEST_CONDITION_REQUIRED(mitk::Equal(exponential(0, 0), exp(-4.0), 1e-12, true) &&
+                               mitk::Equal(exponential(1, 1), exp(1.0), 1e-12, true) &&
+                               mitk::Equal(exponential(2, 2), exp(6.0), 1e-9, true) &&
+                               mitk::Equal(exponential(3, 3), 1.0, 1e-12, true) &&
+                               mitk::Equal(exponential(0, 1), 0.0, 1e-12, true),
+                               "Testing matrix exponential.");
+
+  mitk::ModelBase::TimeGridType grid(60);
+  mitk::AIFBasedModelBase::AterialInputFunctionType aif(60);
+  for (unsigned int i = 0; i < grid.GetSize(); ++i)
+  {
+    // time grid in seconds, 3s between frames, the last frames with a coarser sampling
+    grid[i] = i < 40 ? 3.0 * i : 120.0 + 6.0 * (i - 40);
+    aif[i] = grid[i] < 20.0 ? 0.0 : 5.0 * (grid[i] - 20.0) * exp(-(grid[i] - 20.0) / 10.0);
+  }
+
+  // both numeric models describe the same linear system as their analytic counterparts, so with the exact
+  // integration they must yield the same signals
+  mitk::NumericTwoCompartmentExchangeModel::Pointer numeric2CX =
+    CreateModel<mitk::NumericTwoCompartmentExchangeModel>(grid, aif);
+  mitk::TwoCompartmentExchangeModel::Pointer analytic2CX = CreateModel<mitk::TwoCompartmentExchangeModel>(grid, aif);
+
+  mitk::ModelBase::ParametersType parameters2CX(4);
+  parameters2CX[0] = 60.0;
+  parameters2CX[1] = 10.0;
+  parameters2CX[2] = 0.3;
+  parameters2CX[3] = 0.05;
+  MITK_TEST_CONDITION_REQUIRED(SignalsAreEqual(numeric2CX, analytic2CX, parameters2CX),
+                               "Testing numeric two compartment exchange model.");
+
+  parameters2CX[1] = 0.0;
+  MITK_TEST_CONDITION_REQUIRED(SignalsAreEqual(numeric2CX, analytic2CX, parameters2CX),
+                               "Testing numeric two compartment exchange model without exchange (PS = 0).");
+
+  mitk::NumericTwoTissueCompartmentModel::Pointer numeric2TC =
+    CreateModel<mitk::NumericTwoTissueCompartmentModel>(grid, aif);
+  mitk::TwoTissueCompartmentModel::Pointer analytic2TC = CreateModel<mitk::TwoTissueCompartmentModel>(grid, aif);
+
+  mitk::ModelBase::ParametersType parameters2TC(5);
+  parameters2TC[0] = 0.5;
+  parameters2TC[1] = 0.3;
+  parameters2TC[2] = 0.1;
+  parameters2TC[3] = 0.05;
+  parameters2TC[4] = 0.04;
+  MITK_TEST_CONDITION_REQUIRED(SignalsAreEqual(numeric2TC, analytic2TC, parameters2TC),
+                               "Testing numeric two tissue compartment model.");
+
+  MITK_TEST_END()
+}
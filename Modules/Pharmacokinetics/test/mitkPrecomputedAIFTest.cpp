@@ -0,0 +1,138 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestingMacros.h"
+#include "mitkVector.h"
+#include "mitkException.h"
+
+#include "mitkPrecomputedAIF.h"
+#include "mitkConvolutionHelper.h"
+#include "mitkStandardToftsModel.h"
+
+namespace
+{
+  bool ArraysAreEqual(const itk::Array<double>& a, const itk::Array<double>& b, double epsilon)
+  {
+    if (a.GetSize() != b.GetSize())
+    {
+      return false;
+    }
+
+    for (unsigned int i = 0; i < a.GetSize(); ++i)
+    {
+      if (!mitk::Equal(a[i], b[i], epsilon, true))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void GenerateAIF(unsigned int size, double dt, itk::Array<double>& grid, itk::Array<double>& aif)
+  {
+    grid.SetSize(size);
+    aif.SetSize(size);
+    for (unsigned int i = 0; i < size; ++i)
+    {
+      grid[i] = dt * i;
+      aif[i] = grid[i] < 20.0 ? 0.0 : 5.0 * (grid[i] - 20.0) * exp(-(grid[i] - 20.0) / 10.0);
+    }
+  }
+}
+
+int mitkPrecomputedAIFTest(int  /*argc*/ , char*[] /*argv[]*/)
+{
+  MITK_TEST_BEGIN("PrecomputedAIF")
+
+  itk::Array<double> grid;
+  itk::Array<double> aif;
+  GenerateAIF(30, 4.0, grid, aif);
+
+  mitk::PrecomputedAIF precomputed(grid, aif);
+  MITK_TEST_CONDITION_REQUIRED(precomputed.IsUniform(), "Testing uniform time grid detection.");
+
+  for (double lambda : { 0.001, 0.05, 1.0 })
+  {
+    MITK_TEST_CONDITION_REQUIRED(ArraysAreEqual(precomputed.ConvoluteWithExponential(lambda),
+                                                mitk::convoluteAIFWithExponential(grid, aif, lambda), 1e-12),
+                                 "Testing exponential convolution on uniform grid, lambda: " << lambda);
+  }
+
+  // irregular sampling, e.g. a faster sampling during the bolus passage
+  itk::Array<double> irregularGrid(grid);
+  for (unsigned int i = 10; i < irregularGrid.GetSize(); ++i)
+  {
+    irregularGrid[i] += 1.5 * (i - 9);
+  }
+
+  mitk::PrecomputedAIF irregular(irregularGrid, aif);
+  MITK_TEST_CONDITION_REQUIRED(!irregular.IsUniform(), "Testing non uniform time grid detection.");
+  MITK_TEST_CONDITION_REQUIRED(ArraysAreEqual(irregular.ConvoluteWithExponential(0.05),
+                                              mitk::convoluteAIFWithExponential(irregularGrid, aif, 0.05), 1e-12),
+                               "Testing exponential convolution on non uniform grid.");
+
+  double integral = 0.0;
+  for (unsigned int i = 1; i < grid.GetSize(); ++i)
+  {
+    integral += 0.5 * (aif[i - 1] + aif[i]) * (grid[i] - grid[i - 1]);
+  }
+  MITK_TEST_CONDITION_REQUIRED(mitk::Equal(precomputed.GetIntegral()[grid.GetSize() - 1], integral, 1e-10, true),
+                               "Testing cumulative integral of the AIF.");
+
+  // a long series is convolved via FFT, the result must match the direct discrete convolution
+  GenerateAIF(200, 1.0, grid, aif);
+  mitk::PrecomputedAIF longSeries(grid, aif);
+
+  itk::Array<double> residue(grid.GetSize());
+  for (unsigned int i = 0; i < residue.GetSize(); ++i)
+  {
+    residue[i] = grid[i] < 30.0 ? 1.0 : exp(-(grid[i] - 30.0) / 15.0);
+  }
+
+  itk::Array<double> expected(grid.GetSize());
+  for (unsigned int k = 0; k < grid.GetSize(); ++k)
+  {
+    expected[k] = 0.0;
+    for (unsigned int j = 0; j <= k; ++j)
+    {
+      expected[k] += aif[j] * residue[k - j];
+    }
+  }
+
+  itk::Array<double> convolution;
+  longSeries.ConvoluteWithResidueFunction(residue, convolution);
+  MITK_TEST_CONDITION_REQUIRED(ArraysAreEqual(convolution, expected, 1e-8),
+                               "Testing FFT based convolution with sampled residue function.");
+
+  MITK_TEST_FOR_EXCEPTION(mitk::Exception, irregular.ConvoluteWithResidueFunction(residue, convolution));
+
+  // models must not use an outdated representation after the AIF changed
+  mitk::StandardToftsModel::Pointer model = mitk::StandardToftsModel::New();
+  model->SetTimeGrid(grid);
+  model->SetAterialInputFunctionValues(aif);
+  model->SetAterialInputFunctionTimeGrid(grid);
+
+  mitk::ModelBase::ParametersType parameters(2);
+  parameters[0] = 20.0;
+  parameters[1] = 0.3;
+  const mitk::ModelBase::ModelResultType signal = model->GetSignal(parameters);
+
+  itk::Array<double> doubledAIF(aif);
+  doubledAIF *= 2.0;
+  model->SetAterialInputFunctionValues(doubledAIF);
+  itk::Array<double> doubledSignal(signal);
+  doubledSignal *= 2.0;
+  MITK_TEST_CONDITION_REQUIRED(ArraysAreEqual(model->GetSignal(parameters), doubledSignal, 1e-10),
+                               "Testing that a changed AIF is used by the model.");
+
+  MITK_TEST_END()
+}
@@ -0,0 +1,87 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestingMacros.h"
+#include "mitkVector.h"
+
+#include "mitkStandardToftsModel.h"
+#include "mitkExtendedToftsModel.h"
+
+namespace
+{
+  bool BatchEqualsSingleSignals(const mitk::ModelBase* model, const mitk::ModelBase::BatchParametersType& parameters)
+  {
+    mitk::ModelBase::BatchSignalsType signals;
+    model->GetSignals(parameters, signals);
+
+    if (signals.rows() != model->GetTimeGrid().GetSize() || signals.cols() != parameters.cols())
+    {
+      return false;
+    }
+
+    for (unsigned int signalIndex = 0; signalIndex < parameters.cols(); ++signalIndex)
+    {
+      const mitk::ModelBase::ParametersType signalParameters(parameters.get_column(signalIndex));
+      const mitk::ModelBase::ModelResultType signal = model->GetSignal(signalParameters);
+      for (unsigned int timeIndex = 0; timeIndex < signal.GetSize(); ++timeIndex)
+      {
+        if (!mitk::Equal(signal[timeIndex], signals(timeIndex, signalIndex), 1e-10, true))
+        {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+}
+
+int mitkToftsModelBatchTest(int  /*argc*/ , char*[] /*argv[]*/)
+{
+  MITK_TEST_BEGIN("ToftsModelBatch")
+
+  mitk::ModelBase::TimeGridType grid(30);
+  mitk::AIFBasedModelBase::AterialInputFunctionType aif(30);
+  for (unsigned int i = 0; i < grid.GetSize(); ++i)
+  {
+    // time grid in seconds, 4s between frames, bolus arrives after 20s
+    grid[i] = 4.0 * i;
+    aif[i] = grid[i] < 20.0 ? 0.0 : 5.0 * (grid[i] - 20.0) * exp(-(grid[i] - 20.0) / 10.0);
+  }
+
+  mitk::ModelBase::BatchParametersType parameters(3, 7);
+  for (unsigned int signalIndex = 0; signalIndex < parameters.cols(); ++signalIndex)
+  {
+    parameters(0, signalIndex) = 5.0 + 10.0 * signalIndex;
+    parameters(1, signalIndex) = 0.1 + 0.1 * signalIndex;
+    parameters(2, signalIndex) = 0.01 * signalIndex;
+  }
+
+  mitk::ExtendedToftsModel::Pointer extendedModel = mitk::ExtendedToftsModel::New();
+  extendedModel->SetTimeGrid(grid);
+  extendedModel->SetAterialInputFunctionValues(aif);
+  extendedModel->SetAterialInputFunctionTimeGrid(grid);
+  MITK_TEST_CONDITION_REQUIRED(BatchEqualsSingleSignals(extendedModel, parameters),
+                               "Testing batched signals of the extended Tofts model.");
+
+  // the standard model has no vp
+  parameters = parameters.extract(2, parameters.cols());
+
+  mitk::StandardToftsModel::Pointer standardModel = mitk::StandardToftsModel::New();
+  standardModel->SetTimeGrid(grid);
+  standardModel->SetAterialInputFunctionValues(aif);
+  standardModel->SetAterialInputFunctionTimeGrid(grid);
+  MITK_TEST_CONDITION_REQUIRED(BatchEqualsSingleSignals(standardModel, parameters),
+                               "Testing batched signals of the standard Tofts model.");
+
+  MITK_TEST_END()
+}
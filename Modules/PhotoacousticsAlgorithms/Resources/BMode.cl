@@ -0,0 +1,61 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+__kernel void ckBMode(
+  __global float* dSource, // beamformed image
+  __global float* dDest, // output buffer
+  unsigned int hilbertHalfLength, // 0: absolute value instead of envelope detection
+  char useLogFilter,
+  unsigned int inputL,
+  unsigned int inputS,
+  unsigned int Slices,
+  unsigned int cropLeft,
+  unsigned int cropAbove,
+  unsigned int outputL,
+  unsigned int outputS  // parameters
+)
+{
+  // get thread identifier
+  unsigned int globalPosX = get_global_id(0);
+  unsigned int globalPosY = get_global_id(1);
+  unsigned int globalPosZ = get_global_id(2);
+
+  // terminate non-valid threads
+  if ( globalPosX < outputL && globalPosY < outputS && globalPosZ < Slices )
+  {
+    int line = globalPosX + cropLeft;
+    int sample = globalPosY + cropAbove;
+    __global float* column = dSource + globalPosZ * inputL * inputS + line;
+
+    float value = column[sample * inputL];
+    float output = fabs(value);
+
+    if (hilbertHalfLength > 0)
+    {
+      // Hilbert transform along the samples with a Hamming windowed FIR filter; only odd taps are non-zero
+      float hilbert = 0;
+      for (int k = 1; k <= (int)hilbertHalfLength; k += 2)
+      {
+        float tap = 2.0f / (M_PI_F * k) * (0.54f + 0.46f * cos(M_PI_F * k / (float)(hilbertHalfLength + 1)));
+        float before = sample - k >= 0 ? column[(sample - k) * inputL] : 0;
+        float after = sample + k < (int)inputS ? column[(sample + k) * inputL] : 0;
+        hilbert += tap * (before - after);
+      }
+      output = sqrt(value * value + hilbert * hilbert);
+    }
+
+    if (useLogFilter)
+      output = log(output);
+
+    dDest[ globalPosZ * outputL * outputS + globalPosY * outputL + globalPosX ] = output;
+  }
+}
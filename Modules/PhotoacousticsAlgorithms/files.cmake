@@ -19,6 +19,7 @@ list(APPEND CPP_FILES
     source/OpenCLFilter/mitkPhotoacousticOCLBeamformingFilter.cpp
     source/OpenCLFilter/mitkPhotoacousticOCLUsedLinesCalculation.cpp
     source/OpenCLFilter/mitkPhotoacousticOCLDelayCalculation.cpp
+    source/OpenCLFilter/mitkPhotoacousticOCLBModeFilter.cpp
 )
 ENDIF(MITK_USE_OpenCL)
 
@@ -28,4 +29,5 @@ set(RESOURCE_FILES
   DMAS.cl
   DAS.cl
   sDMAS.cl
+  BMode.cl
 )
@@ -0,0 +1,121 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef _MITKPHOTOACOUSTICSOCLBMODEFILTER_H_
+#define _MITKPHOTOACOUSTICSOCLBMODEFILTER_H_
+
+#include <itkObject.h>
+
+#if defined(PHOTOACOUSTICS_USE_GPU) || DOXYGEN
+
+#include "mitkOclDataSetToDataSetFilter.h"
+
+namespace mitk
+{
+  /*!
+  * \brief Class implementing a mitk::OclDataSetToDataSetFilter for B-mode filtering and cropping on GPU
+  *
+  *  The filter is meant to be applied directly to the GPU output of mitk::PhotoacousticOCLBeamformingFilter, so
+  *  beamforming, envelope detection, log compression and cropping run without copying the data to the host in
+  *  between. The envelope is detected with a Hilbert FIR filter along the samples (the second dimension); if the
+  *  Hilbert filter length is 0, the absolute value is used instead.
+  *  The output buffer is kept between updates as long as the size of the output does not change.
+  */
+  class PhotoacousticOCLBModeFilter : public OclDataSetToDataSetFilter, public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(PhotoacousticOCLBModeFilter, itk::Object);
+    itkNewMacro(Self);
+
+    /** \brief The default half length of the Hilbert filter in samples */
+    static const unsigned int DefaultHilbertFilterHalfLength = 31;
+
+    /** \brief Sets the input buffer and its dimensions (lines, samples, slices). The data is expected to be float. */
+    void SetInput(mitk::OclDataSet::Pointer input, const unsigned int* dimensions);
+
+    /** \brief Sets the number of voxels which are cut off at the borders of each slice */
+    void SetCropping(unsigned int above, unsigned int below, unsigned int left, unsigned int right);
+
+    /** \brief Sets whether a logarithm is applied after the envelope detection (log compression) */
+    itkSetMacro(UseLogFilter, bool);
+    itkGetConstMacro(UseLogFilter, bool);
+
+    /** \brief Sets the half length of the Hilbert filter in samples; 0 uses the absolute value instead */
+    itkSetMacro(HilbertFilterHalfLength, unsigned int);
+    itkGetConstMacro(HilbertFilterHalfLength, unsigned int);
+
+    /** \brief Returns the dimensions of the output (lines, samples, slices) */
+    const unsigned int* GetOutputDimensions() const
+    {
+      return m_OutputDim;
+    }
+
+    /** \brief Update the filter */
+    void Update();
+
+  protected:
+    PhotoacousticOCLBModeFilter();
+    virtual ~PhotoacousticOCLBModeFilter();
+
+    /** \brief Initialize the filter */
+    bool Initialize();
+
+    /** \brief Execute the filter */
+    void Execute();
+
+    mitk::PixelType GetOutputType()
+    {
+      return mitk::MakeScalarPixelType<float>();
+    }
+
+    int GetBytesPerElem()
+    {
+      return sizeof(float);
+    }
+
+    virtual us::Module* GetModule();
+
+  private:
+    /** The OpenCL kernel for the filter */
+    cl_kernel m_PixelCalculation;
+
+    unsigned int m_InputDim[3];
+    unsigned int m_OutputDim[3];
+
+    unsigned int m_CropAbove;
+    unsigned int m_CropBelow;
+    unsigned int m_CropLeft;
+    unsigned int m_CropRight;
+
+    bool m_UseLogFilter;
+    unsigned int m_HilbertFilterHalfLength;
+  };
+}
+#else
+namespace mitk
+{
+  class PhotoacousticOCLBModeFilter : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(mitk::PhotoacousticOCLBModeFilter, itk::Object);
+    itkNewMacro(Self);
+
+  protected:
+    /** Constructor */
+    PhotoacousticOCLBModeFilter() {}
+
+    /** Destructor */
+    ~PhotoacousticOCLBModeFilter() override {}
+  };
+}
+#endif
+#endif
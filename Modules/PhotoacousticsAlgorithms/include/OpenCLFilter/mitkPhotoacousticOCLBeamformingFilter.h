@@ -60,6 +60,13 @@ namespace mitk
     /** \brief Update the filter */
     void Update();
 
+    /** \brief Sets a new configuration
+    *
+    *  The delays and used lines stay on the GPU and are only recalculated if the parameters they depend on changed
+    *  (see mitk::BeamformingSettings::GetDelayTableHash()).
+    */
+    void SetConfig(BeamformingSettings::Pointer settings);
+
     /** \brief Set the Apodisation function to apply when beamforming */
     void SetApodisation(const float* apodisation, unsigned short apodArraySize)
     {
@@ -75,7 +82,8 @@ namespace mitk
     /** \brief Initialize the filter */
     bool Initialize();
 
-    /** \brief Updated the used data for beamforming depending on whether the configuration has significantly changed */
+    /** \brief Updates the apodisation, element, used lines and delay buffers; called if the configuration or the
+    * apodisation changed */
     void UpdateDataBuffers();
 
     /** \brief Execute the filter */
@@ -120,6 +128,12 @@ namespace mitk
     cl_mem m_ElementHeightsBuffer;
     cl_mem m_ElementPositionsBuffer;
 
+    /** The configuration and apodisation the buffers were created for */
+    BeamformingSettings::Pointer m_BufferedConf;
+    const float* m_BufferedApodisation;
+    unsigned short m_BufferedApodArraySize;
+    unsigned short m_ApodizationBufferSize;
+
   };
 }
 #else
@@ -34,8 +34,15 @@ namespace mitk
     mitkClassMacroItkParent(OCLDelayCalculation, itk::Object);
     mitkNewMacro1Param(Self, mitk::BeamformingSettings::Pointer);
 
+    /** \brief Calculates the delays, unless they were already calculated for an equivalent configuration */
     void Update();
 
+    /** \brief Sets a new configuration; the delays are only recalculated if their parameters changed */
+    void SetConfig(mitk::BeamformingSettings::Pointer settings)
+    {
+      m_Conf = settings;
+    }
+
     /** \brief Sets the usedLines buffer object to use for the calculation of the delays.
     *
     * @param usedLines An buffer generated as the output of an instance of mitk::OCLUsedLinesCalculation.
@@ -79,6 +86,10 @@ namespace mitk
     float m_DelayMultiplicatorRaw;
     char m_IsPAImage;
     size_t m_ChunkSize[3];
+
+    /** The mitk::BeamformingSettings::GetDelayTableHash() of the configuration the output was calculated for */
+    std::size_t m_ComputedHash;
+    bool m_IsComputed;
   };
 }
 #endif
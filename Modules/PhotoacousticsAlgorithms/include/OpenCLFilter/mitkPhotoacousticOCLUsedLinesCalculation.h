@@ -33,8 +33,12 @@ namespace mitk
     mitkClassMacroItkParent(OCLUsedLinesCalculation, itk::Object);
     mitkNewMacro1Param(Self, mitk::BeamformingSettings::Pointer);
 
+    /** \brief Calculates the used lines, unless they were already calculated for an equivalent configuration */
     void Update();
 
+    /** \brief Sets a new configuration; the used lines are only recalculated if their parameters changed */
+    void SetConfig(mitk::BeamformingSettings::Pointer settings);
+
     void SetElementHeightsBuffer(cl_mem elementHeightsBuffer);
     void SetElementPositionsBuffer(cl_mem elementPositionsBuffer);
 
@@ -74,6 +78,10 @@ namespace mitk
     size_t m_ChunkSize[3];
     cl_mem m_ElementHeightsBuffer;
     cl_mem m_ElementPositionsBuffer;
+
+    /** The mitk::BeamformingSettings::GetDelayTableHash() of the configuration the output was calculated for */
+    std::size_t m_ComputedHash;
+    bool m_IsComputed;
   };
 }
 #endif
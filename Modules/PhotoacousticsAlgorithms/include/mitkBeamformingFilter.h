@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include "mitkImageToImageFilter.h"
 #include <functional>
 #include "./OpenCLFilter/mitkPhotoacousticOCLBeamformingFilter.h"
+#include "./OpenCLFilter/mitkPhotoacousticOCLBModeFilter.h"
 #include "mitkBeamformingSettings.h"
 #include "mitkBeamformingUtils.h"
 #include "MitkPhotoacousticsAlgorithmsExports.h"
@@ -44,6 +45,29 @@ namespace mitk {
     */
     void SetProgressHandle(std::function<void(int, std::string)> progressHandle);
 
+    /** \brief Sets a new configuration
+    *
+    *  When beamforming on the GPU, the delay tables of the previous configuration are reused if the new one does not
+    *  change them, so a filter instance should be kept for consecutive frames instead of creating a new one.
+    */
+    void SetConfig(mitk::BeamformingSettings::Pointer settings);
+
+    /** \brief Runs envelope detection, log compression and cropping on the GPU directly after beamforming
+    *
+    *  Only used if the configuration uses the GPU. The beamformed data stays in graphics memory until the B-mode
+    *  image is complete, so only the final image is transferred to the host. The GPU buffers are kept between
+    *  updates, so a filter instance should be reused for all frames of a stream.
+    *  @param envelopeDetection If false, the absolute value is used instead of the envelope.
+    *  @param above, below, left, right The number of voxels which are cut off at the borders of each slice.
+    */
+    void SetGPUBModeFilter(bool envelopeDetection, bool useLogFilter,
+      unsigned int above = 0, unsigned int below = 0, unsigned int left = 0, unsigned int right = 0);
+
+    /** \brief Disables the GPU B-mode filter, the beamformed image is returned */
+    void DisableGPUBModeFilter();
+
+    itkGetConstMacro(UseGPUBModeFilter, bool);
+
   protected:
     BeamformingFilter(mitk::BeamformingSettings::Pointer settings);
 
@@ -80,6 +104,13 @@ namespace mitk {
     /** \brief Pointer to the GPU beamforming filter class; for performance reasons the filter is initialized within the constructor and kept for all later computations.
     */
     mitk::PhotoacousticOCLBeamformingFilter::Pointer m_BeamformingOclFilter;
+
+    /** \brief The GPU B-mode filter which is applied to the GPU output of m_BeamformingOclFilter
+    */
+    mitk::PhotoacousticOCLBModeFilter::Pointer m_BModeOclFilter;
+
+    bool m_UseGPUBModeFilter;
+    unsigned int m_GPUCropping[4]; // above, below, left, right
   };
 } // namespace mitk
 
@@ -14,6 +14,7 @@ found in the LICENSE file.
 #define MITK_BEAMFORMING_SETTINGS
 
 #include <itkObject.h>
+#include <cstddef>
 #include <itkMacro.h>
 #include <mitkCommon.h>
 #include <MitkPhotoacousticsAlgorithmsExports.h>
@@ -130,6 +131,13 @@ namespace mitk {
 
     unsigned short* GetMinMaxLines();
 
+    /** \brief Returns a hash of all parameters the delays and used lines of the GPU beamforming depend on
+    *
+    * mitk::OCLDelayCalculation and mitk::OCLUsedLinesCalculation only recompute their tables if this hash changes,
+    * so the tables of one configuration are kept on the GPU for all frames.
+    */
+    std::size_t GetDelayTableHash() const;
+
   protected:
 
     /**
@@ -39,6 +39,19 @@ namespace mitk {
     */
     static void sDMASSphericalLine(float* input, float* output, float inputDim[2], float outputDim[2], const short& line, const mitk::BeamformingSettings::Pointer config);
 
+    /** \brief Function to perform beamforming on CPU for a whole slice, using the algorithm of the configuration
+    *
+    * The lines are distributed over a pool of threads. Within a line, the delays of all elements are calculated in
+    * loops which the compiler can vectorize (with OpenMP SIMD directives if MITK is built with OpenMP), and DMAS and
+    * sDMAS sum the products of all element pairs in linear instead of quadratic time.
+    * @param input The raw data of the slice, inputDim[0] elements x inputDim[1] samples.
+    * @param output The beamformed slice, outputDim[0] lines x outputDim[1] samples; it does not need to be zeroed.
+    * @param numberOfThreads The number of threads, 0 uses one thread per hardware thread.
+    */
+    static void BeamformSlice(const float* input, float* output, const unsigned int inputDim[2],
+      const unsigned int outputDim[2], const mitk::BeamformingSettings::Pointer config,
+      unsigned int numberOfThreads = 0);
+
     /** \brief Pointer holding the Von-Hann apodization window for beamforming
     * @param samples the resolution at which the window is created
     */
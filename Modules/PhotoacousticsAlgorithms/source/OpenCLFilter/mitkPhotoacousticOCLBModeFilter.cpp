@@ -0,0 +1,133 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#if defined(PHOTOACOUSTICS_USE_GPU) || DOXYGEN
+
+#include "./OpenCLFilter/mitkPhotoacousticOCLBModeFilter.h"
+#include "usServiceReference.h"
+
+mitk::PhotoacousticOCLBModeFilter::PhotoacousticOCLBModeFilter()
+  : m_PixelCalculation(nullptr),
+  m_CropAbove(0),
+  m_CropBelow(0),
+  m_CropLeft(0),
+  m_CropRight(0),
+  m_UseLogFilter(false),
+  m_HilbertFilterHalfLength(DefaultHilbertFilterHalfLength)
+{
+  this->AddSourceFile("BMode.cl");
+  this->m_FilterID = "BModeFilter";
+
+  m_InputDim[0] = m_InputDim[1] = m_InputDim[2] = 0;
+  m_OutputDim[0] = m_OutputDim[1] = m_OutputDim[2] = 0;
+
+  this->Initialize();
+}
+
+mitk::PhotoacousticOCLBModeFilter::~PhotoacousticOCLBModeFilter()
+{
+  if (this->m_PixelCalculation)
+  {
+    clReleaseKernel(m_PixelCalculation);
+  }
+}
+
+void mitk::PhotoacousticOCLBModeFilter::SetInput(mitk::OclDataSet::Pointer input, const unsigned int* dimensions)
+{
+  OclDataSetToDataSetFilter::SetInput(input);
+  m_InputDim[0] = dimensions[0];
+  m_InputDim[1] = dimensions[1];
+  m_InputDim[2] = dimensions[2];
+}
+
+void mitk::PhotoacousticOCLBModeFilter::SetCropping(unsigned int above, unsigned int below,
+  unsigned int left, unsigned int right)
+{
+  m_CropAbove = above;
+  m_CropBelow = below;
+  m_CropLeft = left;
+  m_CropRight = right;
+}
+
+void mitk::PhotoacousticOCLBModeFilter::Update()
+{
+  //Check if context & program available
+  if (!this->Initialize())
+  {
+    us::ServiceReference<OclResourceService> ref = GetModuleContext()->GetServiceReference<OclResourceService>();
+    OclResourceService* resources = GetModuleContext()->GetService<OclResourceService>(ref);
+
+    // clean-up also the resources
+    resources->InvalidateStorage();
+    mitkThrow() << "Filter is not initialized. Cannot update.";
+  }
+  else {
+    // Execute
+    this->Execute();
+  }
+}
+
+void mitk::PhotoacousticOCLBModeFilter::Execute()
+{
+  if (m_CropLeft + m_CropRight >= m_InputDim[0] || m_CropAbove + m_CropBelow >= m_InputDim[1])
+    mitkThrow() << "Crop area too large for the beamformed image";
+
+  m_OutputDim[0] = m_InputDim[0] - m_CropLeft - m_CropRight;
+  m_OutputDim[1] = m_InputDim[1] - m_CropAbove - m_CropBelow;
+  m_OutputDim[2] = m_InputDim[2];
+
+  // the output buffer is only reallocated if its size changes
+  this->InitExec(this->m_PixelCalculation, m_OutputDim,
+    (size_t)m_OutputDim[0] * (size_t)m_OutputDim[1] * (size_t)m_OutputDim[2], sizeof(float));
+
+  // as openCL does not support bool as a kernel argument, we need to buffer this value in a char...
+  char useLogFilter = m_UseLogFilter;
+
+  cl_int clErr = 0;
+  clErr = clSetKernelArg(this->m_PixelCalculation, 2, sizeof(cl_uint), &(this->m_HilbertFilterHalfLength));
+  clErr |= clSetKernelArg(this->m_PixelCalculation, 3, sizeof(cl_char), &(useLogFilter));
+  clErr |= clSetKernelArg(this->m_PixelCalculation, 4, sizeof(cl_uint), &(m_InputDim[0]));
+  clErr |= clSetKernelArg(this->m_PixelCalculation, 5, sizeof(cl_uint), &(m_InputDim[1]));
+  clErr |= clSetKernelArg(this->m_PixelCalculation, 6, sizeof(cl_uint), &(m_InputDim[2]));
+  clErr |= clSetKernelArg(this->m_PixelCalculation, 7, sizeof(cl_uint), &(m_CropLeft));
+  clErr |= clSetKernelArg(this->m_PixelCalculation, 8, sizeof(cl_uint), &(m_CropAbove));
+  clErr |= clSetKernelArg(this->m_PixelCalculation, 9, sizeof(cl_uint), &(m_OutputDim[0]));
+  clErr |= clSetKernelArg(this->m_PixelCalculation, 10, sizeof(cl_uint), &(m_OutputDim[1]));
+  CHECK_OCL_ERR(clErr);
+
+  // in contrast to beamforming, every work item is cheap, so the whole volume is processed in one NDRange
+  if (!this->ExecuteKernel(m_PixelCalculation, m_OutputDim[2] == 1 ? 2 : 3))
+    mitkThrow() << "openCL Error when executing Kernel";
+
+  // signalize the GPU-side data changed
+  m_Output->Modified(GPU_DATA);
+}
+
+us::Module *mitk::PhotoacousticOCLBModeFilter::GetModule()
+{
+  return us::GetModuleContext()->GetModule();
+}
+
+bool mitk::PhotoacousticOCLBModeFilter::Initialize()
+{
+  bool buildErr = true;
+  cl_int clErr = 0;
+
+  // the kernel is only created once, Update() calls this method for every frame
+  if (OclFilter::Initialize() && this->m_PixelCalculation == nullptr)
+  {
+    this->m_PixelCalculation = clCreateKernel(this->m_ClProgram, "ckBMode", &clErr);
+    buildErr |= CHECK_OCL_ERR(clErr);
+  }
+  return (OclFilter::IsInitialized() && buildErr);
+}
+#endif
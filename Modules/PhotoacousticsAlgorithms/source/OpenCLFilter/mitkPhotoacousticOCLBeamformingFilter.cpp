@@ -14,9 +14,12 @@ found in the LICENSE file.
 
 #include "./OpenCLFilter/mitkPhotoacousticOCLBeamformingFilter.h"
 #include "usServiceReference.h"
+#include "mitkImageReadAccessor.h"
 
 mitk::PhotoacousticOCLBeamformingFilter::PhotoacousticOCLBeamformingFilter(BeamformingSettings::Pointer settings) :
   m_PixelCalculation(NULL),
+  m_Apodisation(nullptr),
+  m_ApodArraySize(0),
   m_inputSlices(1),
   m_Conf(settings),
   m_InputImage(mitk::Image::New()),
@@ -24,7 +27,10 @@ mitk::PhotoacousticOCLBeamformingFilter::PhotoacousticOCLBeamformingFilter(Beamf
   m_DelaysBuffer(nullptr),
   m_UsedLinesBuffer(nullptr),
   m_ElementHeightsBuffer(nullptr),
-  m_ElementPositionsBuffer(nullptr)
+  m_ElementPositionsBuffer(nullptr),
+  m_BufferedApodisation(nullptr),
+  m_BufferedApodArraySize(0),
+  m_ApodizationBufferSize(0)
 {
   MITK_INFO << "Instantiating OCL beamforming Filter...";
   this->AddSourceFile("DAS.cl");
@@ -77,42 +83,49 @@ void mitk::PhotoacousticOCLBeamformingFilter::Update()
   }
 }
 
+void mitk::PhotoacousticOCLBeamformingFilter::SetConfig(BeamformingSettings::Pointer settings)
+{
+  // the kernel depends on the algorithm and the probe geometry
+  if (m_PixelCalculation &&
+    (settings->GetAlgorithm() != m_Conf->GetAlgorithm() || settings->GetGeometry() != m_Conf->GetGeometry()))
+  {
+    clReleaseKernel(m_PixelCalculation);
+    m_PixelCalculation = nullptr;
+  }
+
+  m_Conf = settings;
+  m_UsedLinesCalculation->SetConfig(settings);
+  m_DelayCalculation->SetConfig(settings);
+}
+
 void mitk::PhotoacousticOCLBeamformingFilter::UpdateDataBuffers()
 {
   us::ServiceReference<OclResourceService> ref = GetModuleContext()->GetServiceReference<OclResourceService>();
   OclResourceService* resources = GetModuleContext()->GetService<OclResourceService>(ref);
   cl_context gpuContext = resources->GetContext();
 
-  //Initialize the Output
-  try
-  {
-    size_t outputSize = (size_t)m_Conf->GetReconstructionLines() * (size_t)m_Conf->GetSamplesPerLine() *
-      (size_t)m_inputSlices;
-    m_OutputDim[0] = m_Conf->GetReconstructionLines();
-    m_OutputDim[1] = m_Conf->GetSamplesPerLine();
-    m_OutputDim[2] = m_inputSlices;
-    this->InitExec(this->m_PixelCalculation, m_OutputDim, outputSize, sizeof(float));
-  }
-  catch (const mitk::Exception& e)
-  {
-    MITK_ERROR << "Caught exception while initializing filter: " << e.what();
-    return;
-  }
-
   cl_int clErr = 0;
   MITK_DEBUG << "Updating GPU Buffers for new configuration";
 
+  m_BufferedConf = m_Conf;
+  m_BufferedApodisation = m_Apodisation;
+  m_BufferedApodArraySize = m_ApodArraySize;
+
   // create the apodisation buffer
-  if (m_Apodisation == nullptr)
+  static const float noApodisation[1] = { 1 };
+  const float* apodisation = m_Apodisation;
+  m_ApodizationBufferSize = m_ApodArraySize;
+
+  if (apodisation == nullptr || m_ApodArraySize == 0)
   {
     MITK_INFO << "No apodisation function set; Beamforming will be done without any apodisation.";
-    m_Apodisation = new float[1]{ 1 };
-    m_ApodArraySize = 1;
+    apodisation = noApodisation;
+    m_ApodizationBufferSize = 1;
   }
 
   if (m_ApodizationBuffer) clReleaseMemObject(m_ApodizationBuffer);
 
-  this->m_ApodizationBuffer = clCreateBuffer(gpuContext, CL_MEM_READ_ONLY | CL_MEM_USE_HOST_PTR, sizeof(float) * m_ApodArraySize, const_cast<float*>(m_Apodisation), &clErr);
+  this->m_ApodizationBuffer = clCreateBuffer(gpuContext, CL_MEM_READ_ONLY | CL_MEM_USE_HOST_PTR, sizeof(float) * m_ApodizationBufferSize, const_cast<float*>(apodisation), &clErr);
   CHECK_OCL_ERR(clErr);
 
   if (m_ElementHeightsBuffer) clReleaseMemObject(m_ElementHeightsBuffer);
@@ -138,8 +151,30 @@ void mitk::PhotoacousticOCLBeamformingFilter::UpdateDataBuffers()
 
 void mitk::PhotoacousticOCLBeamformingFilter::Execute()
 {
+  //Initialize the Output; the input and output buffers are only reallocated if their sizes change
+  try
+  {
+    size_t outputSize = (size_t)m_Conf->GetReconstructionLines() * (size_t)m_Conf->GetSamplesPerLine() *
+      (size_t)m_inputSlices;
+    m_OutputDim[0] = m_Conf->GetReconstructionLines();
+    m_OutputDim[1] = m_Conf->GetSamplesPerLine();
+    m_OutputDim[2] = m_inputSlices;
+    this->InitExec(this->m_PixelCalculation, m_OutputDim, outputSize, sizeof(float));
+  }
+  catch (const mitk::Exception& e)
+  {
+    MITK_ERROR << "Caught exception while initializing filter: " << e.what();
+    return;
+  }
+
+  // the used lines and delay calculations skip their kernels if the new configuration does not affect them
+  if (m_ApodizationBuffer == nullptr || m_Conf != m_BufferedConf || m_Apodisation != m_BufferedApodisation ||
+    m_ApodArraySize != m_BufferedApodArraySize)
+  {
+    UpdateDataBuffers();
+  }
+
   cl_int clErr = 0;
-  UpdateDataBuffers();
   if (m_Conf->GetGeometry() == mitk::BeamformingSettings::ProbeGeometry::Linear)
   {
     unsigned int reconstructionLines = this->m_Conf->GetReconstructionLines();
@@ -148,7 +183,7 @@ void mitk::PhotoacousticOCLBeamformingFilter::Execute()
     clErr = clSetKernelArg(this->m_PixelCalculation, 2, sizeof(cl_mem), &(this->m_UsedLinesBuffer));
     clErr |= clSetKernelArg(this->m_PixelCalculation, 3, sizeof(cl_mem), &(this->m_DelaysBuffer));
     clErr |= clSetKernelArg(this->m_PixelCalculation, 4, sizeof(cl_mem), &(this->m_ApodizationBuffer));
-    clErr |= clSetKernelArg(this->m_PixelCalculation, 5, sizeof(cl_ushort), &(this->m_ApodArraySize));
+    clErr |= clSetKernelArg(this->m_PixelCalculation, 5, sizeof(cl_ushort), &(this->m_ApodizationBufferSize));
     clErr |= clSetKernelArg(this->m_PixelCalculation, 6, sizeof(cl_uint), &(this->m_Conf->GetInputDim()[0]));
     clErr |= clSetKernelArg(this->m_PixelCalculation, 7, sizeof(cl_uint), &(this->m_Conf->GetInputDim()[1]));
     clErr |= clSetKernelArg(this->m_PixelCalculation, 8, sizeof(cl_uint), &(m_inputSlices));
@@ -168,7 +203,7 @@ void mitk::PhotoacousticOCLBeamformingFilter::Execute()
     clErr = clSetKernelArg(this->m_PixelCalculation, 2, sizeof(cl_mem), &(this->m_ElementHeightsBuffer));
     clErr |= clSetKernelArg(this->m_PixelCalculation, 3, sizeof(cl_mem), &(this->m_ElementPositionsBuffer));
     clErr |= clSetKernelArg(this->m_PixelCalculation, 4, sizeof(cl_mem), &(this->m_ApodizationBuffer));
-    clErr |= clSetKernelArg(this->m_PixelCalculation, 5, sizeof(cl_ushort), &(this->m_ApodArraySize));
+    clErr |= clSetKernelArg(this->m_PixelCalculation, 5, sizeof(cl_ushort), &(this->m_ApodizationBufferSize));
     clErr |= clSetKernelArg(this->m_PixelCalculation, 6, sizeof(cl_uint), &(this->m_Conf->GetInputDim()[0]));
     clErr |= clSetKernelArg(this->m_PixelCalculation, 7, sizeof(cl_uint), &(this->m_Conf->GetInputDim()[1]));
     clErr |= clSetKernelArg(this->m_PixelCalculation, 8, sizeof(cl_int), &(m_inputSlices));
@@ -206,7 +241,8 @@ bool mitk::PhotoacousticOCLBeamformingFilter::Initialize()
   bool buildErr = true;
   cl_int clErr = 0;
 
-  if (OclFilter::Initialize())
+  // the kernel is only created once, Update() calls this method for every frame
+  if (OclFilter::Initialize() && this->m_PixelCalculation == nullptr)
   {
     if (m_Conf->GetGeometry() == mitk::BeamformingSettings::ProbeGeometry::Linear)
     {
@@ -278,7 +314,16 @@ bool mitk::PhotoacousticOCLBeamformingFilter::Initialize()
 
 void mitk::PhotoacousticOCLBeamformingFilter::SetInput(mitk::Image::Pointer image)
 {
-  OclDataSetToDataSetFilter::SetInput(image);
+  // keep the input data set, so its GPU buffer is reused for all following images of the same size
+  if (m_Input.IsNull())
+    m_Input = mitk::OclDataSet::New();
+
+  mitk::ImageReadAccessor reader(image);
+  m_CurrentSize = (unsigned int)(image->GetPixelType().GetBitsPerComponent() / 8);
+  m_Input->SetBpE(m_CurrentSize);
+  m_Input->SetBufferSize((size_t)image->GetDimension(0) * image->GetDimension(1) * image->GetDimension(2));
+  m_Input->SetData(const_cast<void*>(reader.GetData()));
+
   m_InputImage = image;
   m_inputSlices = image->GetDimension(2);
 }
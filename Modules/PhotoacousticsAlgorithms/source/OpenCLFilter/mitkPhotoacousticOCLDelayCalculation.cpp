@@ -19,7 +19,10 @@ found in the LICENSE file.
 
 mitk::OCLDelayCalculation::OCLDelayCalculation(mitk::BeamformingSettings::Pointer settings)
   : m_PixelCalculation(NULL),
-  m_Conf(settings)
+  m_Conf(settings),
+  m_UsedLines(nullptr),
+  m_ComputedHash(0),
+  m_IsComputed(false)
 {
   this->AddSourceFile("DelayCalculation.cl");
   this->m_FilterID = "DelayCalculation";
@@ -51,7 +54,8 @@ void mitk::OCLDelayCalculation::Update()
     resources->InvalidateStorage();
     mitkThrow() << "Filter is not initialized. Cannot update.";
   }
-  else {
+  else if (!m_IsComputed || m_ComputedHash != m_Conf->GetDelayTableHash() || m_Output->GetGPUBuffer() == nullptr)
+  {
     // Execute
     this->Execute();
   }
@@ -71,6 +75,7 @@ void mitk::OCLDelayCalculation::Execute()
   catch (const mitk::Exception& e)
   {
     MITK_ERROR << "Caught exception while initializing Delay Calculation filter: " << e.what();
+    m_IsComputed = false;
     return;
   }
 
@@ -103,6 +108,9 @@ void mitk::OCLDelayCalculation::Execute()
     mitkThrow() << "openCL Error when executing Kernel";
   // signalize the GPU-side data changed
   m_Output->Modified(GPU_DATA);
+
+  m_ComputedHash = m_Conf->GetDelayTableHash();
+  m_IsComputed = true;
 }
 
 us::Module *mitk::OCLDelayCalculation::GetModule()
@@ -115,7 +123,8 @@ bool mitk::OCLDelayCalculation::Initialize()
   bool buildErr = true;
   cl_int clErr = 0;
 
-  if (OclFilter::Initialize())
+  // the kernel is only created once, Update() calls this method for every configuration
+  if (OclFilter::Initialize() && this->m_PixelCalculation == nullptr)
   {
     this->m_PixelCalculation = clCreateKernel(this->m_ClProgram, "ckDelayCalculationSphe", &clErr);
     buildErr |= CHECK_OCL_ERR(clErr);
@@ -17,7 +17,11 @@ found in the LICENSE file.
 
 mitk::OCLUsedLinesCalculation::OCLUsedLinesCalculation(mitk::BeamformingSettings::Pointer settings)
   : m_PixelCalculation(NULL),
-  m_Conf(settings)
+  m_Conf(settings),
+  m_ElementHeightsBuffer(nullptr),
+  m_ElementPositionsBuffer(nullptr),
+  m_ComputedHash(0),
+  m_IsComputed(false)
 {
   this->AddSourceFile("UsedLinesCalculation.cl");
   this->m_FilterID = "UsedLinesCalculation";
@@ -37,6 +41,18 @@ mitk::OCLUsedLinesCalculation::~OCLUsedLinesCalculation()
   }
 }
 
+void mitk::OCLUsedLinesCalculation::SetConfig(mitk::BeamformingSettings::Pointer settings)
+{
+  // the kernel depends on the probe geometry
+  if (m_PixelCalculation && settings->GetGeometry() != m_Conf->GetGeometry())
+  {
+    clReleaseKernel(m_PixelCalculation);
+    m_PixelCalculation = nullptr;
+  }
+
+  m_Conf = settings;
+}
+
 void mitk::OCLUsedLinesCalculation::SetElementHeightsBuffer(cl_mem elementHeightsBuffer)
 {
   m_ElementHeightsBuffer = elementHeightsBuffer;
@@ -59,7 +75,8 @@ void mitk::OCLUsedLinesCalculation::Update()
     resources->InvalidateStorage();
     mitkThrow() << "Filter is not initialized. Cannot update.";
   }
-  else {
+  else if (!m_IsComputed || m_ComputedHash != m_Conf->GetDelayTableHash() || m_Output->GetGPUBuffer() == nullptr)
+  {
     // Execute
     this->Execute();
   }
@@ -79,6 +96,7 @@ void mitk::OCLUsedLinesCalculation::Execute()
   catch (const mitk::Exception& e)
   {
     MITK_ERROR << "Caught exception while initializing UsedLines filter: " << e.what();
+    m_IsComputed = false;
     return;
   }
 
@@ -131,6 +149,9 @@ void mitk::OCLUsedLinesCalculation::Execute()
 
   // signalize the GPU-side data changed
   m_Output->Modified(GPU_DATA);
+
+  m_ComputedHash = m_Conf->GetDelayTableHash();
+  m_IsComputed = true;
 }
 
 us::Module *mitk::OCLUsedLinesCalculation::GetModule()
@@ -143,7 +164,8 @@ bool mitk::OCLUsedLinesCalculation::Initialize()
   bool buildErr = true;
   cl_int clErr = 0;
 
-  if (OclFilter::Initialize())
+  // the kernel is only created once for each probe geometry
+  if (OclFilter::Initialize() && this->m_PixelCalculation == nullptr)
   {
     if (m_Conf->GetGeometry() == mitk::BeamformingSettings::ProbeGeometry::Linear)
     {
@@ -24,7 +24,8 @@ found in the LICENSE file.
 mitk::BeamformingFilter::BeamformingFilter(mitk::BeamformingSettings::Pointer settings) :
   m_OutputData(nullptr),
   m_InputData(nullptr),
-  m_Conf(settings)
+  m_Conf(settings),
+  m_UseGPUBModeFilter(false)
 {
   MITK_INFO << "Instantiating BeamformingFilter...";
   this->SetNumberOfIndexedInputs(1);
@@ -36,6 +37,8 @@ mitk::BeamformingFilter::BeamformingFilter(mitk::BeamformingSettings::Pointer se
 #else
   m_BeamformingOclFilter = mitk::PhotoacousticOCLBeamformingFilter::New();
 #endif
+  m_BModeOclFilter = mitk::PhotoacousticOCLBModeFilter::New();
+  std::fill(m_GPUCropping, m_GPUCropping + 4, 0);
 
   MITK_INFO << "Instantiating BeamformingFilter...[Done]";
 }
@@ -45,6 +48,43 @@ void mitk::BeamformingFilter::SetProgressHandle(std::function<void(int, std::str
   m_ProgressHandle = progressHandle;
 }
 
+void mitk::BeamformingFilter::SetConfig(mitk::BeamformingSettings::Pointer settings)
+{
+  m_Conf = settings;
+#if defined(PHOTOACOUSTICS_USE_GPU)
+  m_BeamformingOclFilter->SetConfig(settings);
+#endif
+  this->Modified();
+}
+
+void mitk::BeamformingFilter::SetGPUBModeFilter(bool envelopeDetection, bool useLogFilter,
+  unsigned int above, unsigned int below, unsigned int left, unsigned int right)
+{
+#if defined(PHOTOACOUSTICS_USE_GPU)
+  m_BModeOclFilter->SetHilbertFilterHalfLength(
+    envelopeDetection ? mitk::PhotoacousticOCLBModeFilter::DefaultHilbertFilterHalfLength : 0);
+  m_BModeOclFilter->SetUseLogFilter(useLogFilter);
+  m_BModeOclFilter->SetCropping(above, below, left, right);
+#else
+  (void)envelopeDetection;
+  (void)useLogFilter;
+  MITK_WARN << "The B-mode filter can only be applied on the GPU if MITK is built with OpenCL.";
+#endif
+  m_GPUCropping[0] = above;
+  m_GPUCropping[1] = below;
+  m_GPUCropping[2] = left;
+  m_GPUCropping[3] = right;
+  m_UseGPUBModeFilter = true;
+  this->Modified();
+}
+
+void mitk::BeamformingFilter::DisableGPUBModeFilter()
+{
+  std::fill(m_GPUCropping, m_GPUCropping + 4, 0);
+  m_UseGPUBModeFilter = false;
+  this->Modified();
+}
+
 mitk::BeamformingFilter::~BeamformingFilter()
 {
   MITK_INFO << "Destructed BeamformingFilter";
@@ -80,6 +120,17 @@ void mitk::BeamformingFilter::GenerateOutputInformation()
   spacing[2] = 1;
 
   unsigned int dim[] = { m_Conf->GetReconstructionLines(), m_Conf->GetSamplesPerLine(), input->GetDimension(2)};
+
+  // the GPU B-mode filter crops the beamformed image
+  if (m_UseGPUBModeFilter && m_Conf->GetUseGPU())
+  {
+    if (m_GPUCropping[2] + m_GPUCropping[3] >= dim[0] || m_GPUCropping[0] + m_GPUCropping[1] >= dim[1])
+      mitkThrow() << "Crop area too large for the beamformed image";
+
+    dim[0] -= m_GPUCropping[2] + m_GPUCropping[3];
+    dim[1] -= m_GPUCropping[0] + m_GPUCropping[1];
+  }
+
   output->Initialize(mitk::MakeScalarPixelType<float>(), 3, dim);
   output->GetGeometry()->SetSpacing(spacing);
   output->GetGeometry()->Modified();
@@ -110,67 +161,29 @@ void mitk::BeamformingFilter::GenerateData()
     int progInterval = output->GetDimension(2) / 20 > 1 ? output->GetDimension(2) / 20 : 1;
     // the interval at which we update the gui progress bar
 
-    float inputDim[2] = { (float)input->GetDimension(0), (float)input->GetDimension(1) };
-    float outputDim[2] = { (float)output->GetDimension(0), (float)output->GetDimension(1) };
+    unsigned int inputDim[2] = { input->GetDimension(0), input->GetDimension(1) };
+    unsigned int outputDim[2] = { output->GetDimension(0), output->GetDimension(1) };
+
+    m_OutputData = new float[m_Conf->GetReconstructionLines()*m_Conf->GetSamplesPerLine()];
 
     for (unsigned int i = 0; i < output->GetDimension(2); ++i) // seperate Slices should get Beamforming seperately applied
     {
       mitk::ImageReadAccessor inputReadAccessor(input, input->GetSliceData(i));
       m_InputData = (float*)inputReadAccessor.GetData();
 
-      m_OutputData = new float[m_Conf->GetReconstructionLines()*m_Conf->GetSamplesPerLine()];
-
-      // fill the image with zeros
-      for (int l = 0; l < outputDim[0]; ++l)
-      {
-        for (int s = 0; s < outputDim[1]; ++s)
-        {
-          m_OutputData[l*(short)outputDim[1] + s] = 0;
-        }
-      }
-
-      std::thread *threads = new std::thread[(short)outputDim[0]];
-
-      // every line will be beamformed in a seperate thread
-      if (m_Conf->GetAlgorithm() == BeamformingSettings::BeamformingAlgorithm::DAS)
-      {
-        for (short line = 0; line < outputDim[0]; ++line)
-        {
-          threads[line] = std::thread(&BeamformingUtils::DASSphericalLine, m_InputData,
-            m_OutputData, inputDim, outputDim, line, m_Conf);
-        }
-      }
-      else if (m_Conf->GetAlgorithm() == BeamformingSettings::BeamformingAlgorithm::DMAS)
-      {
-        for (short line = 0; line < outputDim[0]; ++line)
-        {
-          threads[line] = std::thread(&BeamformingUtils::DMASSphericalLine, m_InputData,
-            m_OutputData, inputDim, outputDim, line, m_Conf);
-        }
-      }
-      else if (m_Conf->GetAlgorithm() == BeamformingSettings::BeamformingAlgorithm::sDMAS)
-      {
-        for (short line = 0; line < outputDim[0]; ++line)
-        {
-          threads[line] = std::thread(&BeamformingUtils::sDMASSphericalLine, m_InputData,
-            m_OutputData, inputDim, outputDim, line, m_Conf);
-        }
-      }
-      // wait for all lines to finish
-      for (short line = 0; line < outputDim[0]; ++line)
-      {
-        threads[line].join();
-      }
+      // the lines are beamformed in parallel by a pool of threads
+      BeamformingUtils::BeamformSlice(m_InputData, m_OutputData, inputDim, outputDim, m_Conf);
 
       output->SetSlice(m_OutputData, i);
 
       if (i % progInterval == 0)
         m_ProgressHandle((int)((i + 1) / (float)output->GetDimension(2) * 100), "performing reconstruction");
 
-      delete[] m_OutputData;
-      m_OutputData = nullptr;
       m_InputData = nullptr;
     }
+
+    delete[] m_OutputData;
+    m_OutputData = nullptr;
   }
 #if defined(PHOTOACOUSTICS_USE_GPU) || DOXYGEN
   else
@@ -226,21 +239,37 @@ void mitk::BeamformingFilter::GenerateData()
 
         inputBatch->SetSpacing(input->GetGeometry()->GetSpacing());
 
-        inputBatch->SetImportVolume(&(((float*)copy.GetData())[input->GetDimension(0) * input->GetDimension(1) * batchSize * i]));
+        // the batch only references the input, the data is copied once into the (reused) GPU buffer
+        const float* batchData =
+          &(((const float*)copy.GetData())[input->GetDimension(0) * input->GetDimension(1) * batchSize * i]);
+        inputBatch->SetImportVolume(const_cast<float*>(batchData), 0, 0,
+          mitk::Image::ImportMemoryManagementType::ReferenceMemory);
 
         m_BeamformingOclFilter->SetApodisation(m_Conf->GetApodizationFunction(), m_Conf->GetApodizationArraySize());
         m_BeamformingOclFilter->SetInput(inputBatch);
         m_BeamformingOclFilter->Update();
 
-        void* out = m_BeamformingOclFilter->GetOutput();
+        // the beamformed data stays on the GPU if the B-mode filter is applied there, only its output is read back
+        void* out = nullptr;
+        if (m_UseGPUBModeFilter)
+        {
+          unsigned int beamformedDim[] = { m_Conf->GetReconstructionLines(), m_Conf->GetSamplesPerLine(), num_Slices };
+          m_BModeOclFilter->SetInput(m_BeamformingOclFilter->GetGPUOutput(), beamformedDim);
+          m_BModeOclFilter->Update();
+          out = m_BModeOclFilter->GetOutput();
+        }
+        else
+        {
+          out = m_BeamformingOclFilter->GetOutput();
+        }
 
         for (unsigned int slice = 0; slice < num_Slices; ++slice)
         {
           output->SetImportSlice(
-            &(((float*)out)[m_Conf->GetReconstructionLines() * m_Conf->GetSamplesPerLine() * slice]),
+            &(((float*)out)[output->GetDimension(0) * output->GetDimension(1) * slice]),
             batchSize * i + slice, 0, 0, mitk::Image::ImportMemoryManagementType::CopyMemory);
         }
-        free(out);
+        delete[] (char*)out;
       }
     }
     catch (mitk::Exception &e)
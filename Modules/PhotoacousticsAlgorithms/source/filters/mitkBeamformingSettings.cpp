@@ -14,6 +14,17 @@ found in the LICENSE file.
 #include "mitkBeamformingUtils.h"
 #include "itkMutexLock.h"
 
+#include <functional>
+
+namespace
+{
+  template <typename T>
+  void CombineHash(std::size_t &seed, const T &value)
+  {
+    seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  }
+}
+
 mitk::BeamformingSettings::BeamformingSettings(float pitchInMeters,
   float speedOfSound,
   float timeSpacing,
@@ -129,6 +140,25 @@ mitk::BeamformingSettings::~BeamformingSettings()
     delete[] m_MinMaxLines;
 }
 
+std::size_t mitk::BeamformingSettings::GetDelayTableHash() const
+{
+  // the element positions and heights are derived from these parameters as well
+  std::size_t hash = 0;
+  CombineHash(hash, m_PitchInMeters);
+  CombineHash(hash, m_SpeedOfSound);
+  CombineHash(hash, m_TimeSpacing);
+  CombineHash(hash, m_Angle);
+  CombineHash(hash, m_IsPhotoacousticImage);
+  CombineHash(hash, m_SamplesPerLine);
+  CombineHash(hash, m_ReconstructionLines);
+  CombineHash(hash, m_InputDim[0]);
+  CombineHash(hash, m_InputDim[1]);
+  CombineHash(hash, m_ReconstructionDepth);
+  CombineHash(hash, static_cast<int>(m_Geometry));
+  CombineHash(hash, m_ProbeRadius);
+  return hash;
+}
+
 unsigned short* mitk::BeamformingSettings::GetMinMaxLines()
 {
   if (!m_MinMaxLines)
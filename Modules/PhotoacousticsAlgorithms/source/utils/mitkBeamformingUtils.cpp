@@ -14,12 +14,163 @@ found in the LICENSE file.
 #include "mitkImageReadAccessor.h"
 #include <algorithm>
 #include <itkImageIOBase.h>
+#include <atomic>
 #include <chrono>
+#include <cmath>
 #include <thread>
+#include <vector>
 #include <itkImageIOBase.h>
 #include "mitkImageCast.h"
 #include "mitkBeamformingUtils.h"
 
+namespace
+{
+  /** Per thread buffers, so the lines do not allocate memory for every sample */
+  struct LineBuffers
+  {
+    explicit LineBuffers(unsigned int elements)
+      : ElementHeights(elements), ElementDistances(elements), Delays(elements), Values(elements), RawValues(elements)
+    {
+    }
+
+    std::vector<float> ElementHeights; // in samples
+    std::vector<float> ElementDistances; // squared horizontal distance of the elements to the line in samples
+    std::vector<int> Delays;
+    std::vector<float> Values; // apodized
+    std::vector<float> RawValues;
+  };
+
+  void BeamformLine(mitk::BeamformingSettings::BeamformingAlgorithm algorithm,
+                    const float* input, float* output,
+                    unsigned int inputL, unsigned int inputS, unsigned int outputL, unsigned int outputS,
+                    unsigned int line, const mitk::BeamformingSettings* config, const unsigned short* minMaxLines,
+                    LineBuffers& buffers)
+  {
+    const float* apodisation = config->GetApodizationFunction();
+    const float apodArraySize = config->GetApodizationArraySize();
+
+    const float* elementHeights = config->GetElementHeights();
+    const float* elementPositions = config->GetElementPositions();
+
+    const float sampleDistance = config->GetSpeedOfSound() * config->GetTimeSpacing();
+    // ultrasound images also contain the way from the transducer to the reflector
+    const float transmitFactor = 1 - config->GetIsPhotoacousticImage();
+
+    float totalSamples_i = (float)(config->GetReconstructionDepth()) / sampleDistance;
+    totalSamples_i = totalSamples_i <= inputS ? totalSamples_i : inputS;
+
+    const float l_p = (float)line / outputL * config->GetHorizontalExtent();
+
+    float* heights = buffers.ElementHeights.data();
+    float* distances = buffers.ElementDistances.data();
+    int* delays = buffers.Delays.data();
+    float* values = buffers.Values.data();
+    float* rawValues = buffers.RawValues.data();
+
+    // the horizontal part of the delays is the same for all samples of a line
+    for (unsigned int l_s = 0; l_s < inputL; ++l_s)
+    {
+      heights[l_s] = elementHeights[l_s] / sampleDistance;
+      const float horizontal = (l_p - elementPositions[l_s]) / sampleDistance;
+      distances[l_s] = horizontal * horizontal;
+    }
+
+    for (unsigned int sample = 0; sample < outputS; ++sample)
+    {
+      const float s_i = (float)sample / outputS * totalSamples_i;
+
+      const int minLine = minMaxLines[2 * sample * outputL + 2 * line];
+      const int maxLine = minMaxLines[2 * sample * outputL + 2 * line + 1];
+      const int usedLines = maxLine - minLine;
+      const float apod_mult = apodArraySize / (float)usedLines;
+
+      // delay calculation without dependencies between the elements, which the compiler can vectorize
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+      for (int l_s = minLine; l_s < maxLine; ++l_s)
+      {
+        const float vertical = s_i - heights[l_s];
+        delays[l_s] = (int)((float)(int)std::sqrt(vertical * vertical + distances[l_s]) + transmitFactor * s_i);
+      }
+
+      int invalidLines = 0;
+      int invalidLinesWithoutLast = 0;
+      for (int l_s = minLine; l_s < maxLine; ++l_s)
+      {
+        const int delay = delays[l_s];
+        if (delay < (int)inputS && delay >= 0)
+        {
+          rawValues[l_s] = input[l_s + delay * inputL];
+          values[l_s] = rawValues[l_s] * apodisation[(int)((l_s - minLine) * apod_mult)];
+        }
+        else
+        {
+          rawValues[l_s] = 0;
+          values[l_s] = 0;
+          ++invalidLines;
+          if (l_s < maxLine - 1)
+            ++invalidLinesWithoutLast;
+        }
+      }
+
+      float result = 0;
+      if (algorithm == mitk::BeamformingSettings::BeamformingAlgorithm::DAS)
+      {
+        float sum = 0;
+#ifdef _OPENMP
+#pragma omp simd reduction(+:sum)
+#endif
+        for (int l_s = minLine; l_s < maxLine; ++l_s)
+          sum += values[l_s];
+
+        result = sum / (usedLines - invalidLines);
+      }
+      else
+      {
+        // the sum of all products w_i * w_j (i < j) of the signed square roots w of the values is
+        // ((sum w)^2 - sum w^2) / 2, which avoids the quadratic loop over all pairs of elements
+        double sum = 0;
+        double sumOfSquares = 0;
+#ifdef _OPENMP
+#pragma omp simd reduction(+:sum, sumOfSquares)
+#endif
+        for (int l_s = minLine; l_s < maxLine; ++l_s)
+        {
+          const float value = values[l_s];
+          sum += std::sqrt(std::fabs(value)) * ((value > 0) - (value < 0));
+          sumOfSquares += std::fabs(value);
+        }
+
+        // as in the original implementation, an invalid last element is not subtracted from the used lines
+        const float validLines = usedLines - invalidLinesWithoutLast;
+        result = (float)((sum * sum - sumOfSquares) / 2) / (validLines * validLines - (validLines - 1));
+
+        if (algorithm == mitk::BeamformingSettings::BeamformingAlgorithm::sDMAS)
+        {
+          float sign = 0;
+          for (int l_s = minLine; l_s < maxLine - 1; ++l_s)
+            sign += rawValues[l_s];
+
+          result *= (sign > 0) - (sign < 0);
+        }
+      }
+
+      output[sample * outputL + line] = result;
+    }
+  }
+
+  void BeamformSingleLine(mitk::BeamformingSettings::BeamformingAlgorithm algorithm,
+                          float* input, float* output, float inputDim[2], float outputDim[2],
+                          const short& line, const mitk::BeamformingSettings::Pointer config)
+  {
+    LineBuffers buffers((unsigned int)inputDim[0]);
+    BeamformLine(algorithm, input, output, (unsigned int)inputDim[0], (unsigned int)inputDim[1],
+                 (unsigned int)outputDim[0], (unsigned int)outputDim[1], line, config.GetPointer(),
+                 config->GetMinMaxLines(), buffers);
+  }
+}
+
 mitk::BeamformingUtils::BeamformingUtils()
 {
 }
@@ -180,229 +331,58 @@ unsigned short* mitk::BeamformingUtils::MinMaxLines(const mitk::BeamformingSetti
   return dDest;
 }
 
+
 void mitk::BeamformingUtils::DASSphericalLine(
   float* input, float* output, float inputDim[2], float outputDim[2],
   const short& line, const mitk::BeamformingSettings::Pointer config)
 {
-  const float* apodisation = config->GetApodizationFunction();
-  const short apodArraySize = config->GetApodizationArraySize();
-
-  const float* elementHeights = config->GetElementHeights();
-  const float* elementPositions = config->GetElementPositions();
-
-  float& inputS = inputDim[1];
-  float& inputL = inputDim[0];
-
-  float& outputS = outputDim[1];
-  float& outputL = outputDim[0];
-
-  short AddSample = 0;
-  short maxLine = 0;
-  short minLine = 0;
-  float l_p = 0;
-  float s_i = 0;
-
-  float apod_mult = 1;
-
-  short usedLines = (maxLine - minLine);
-
-  float totalSamples_i = (float)(config->GetReconstructionDepth()) / (float)(config->GetSpeedOfSound() * config->GetTimeSpacing());
-  totalSamples_i = totalSamples_i <= inputS ? totalSamples_i : inputS;
-
-  l_p = (float)line / outputL * config->GetHorizontalExtent();
-
-  for (short sample = 0; sample < outputS; ++sample)
-  {
-    s_i = (float)sample / outputS * totalSamples_i;
-
-    minLine = config->GetMinMaxLines()[2*sample*(short)outputL + 2*line];
-    maxLine = config->GetMinMaxLines()[2*sample*(short)outputL + 2*line + 1];
-    usedLines = (maxLine - minLine);
-
-    apod_mult = (float)apodArraySize / (float)usedLines;
-
-    for (short l_s = minLine; l_s < maxLine; ++l_s)
-    {
-      AddSample = (int)sqrt(
-        pow(s_i-elementHeights[l_s]/(config->GetSpeedOfSound()*config->GetTimeSpacing()), 2)
-        +
-        pow((1 / (config->GetTimeSpacing()*config->GetSpeedOfSound())) * (l_p - elementPositions[l_s]), 2)
-      ) + (1 - config->GetIsPhotoacousticImage())*s_i;
-      if (AddSample < inputS && AddSample >= 0)
-        output[sample*(short)outputL + line] += input[l_s + AddSample*(short)inputL] *
-        apodisation[(short)((l_s - minLine)*apod_mult)];
-      else
-        --usedLines;
-    }
-    output[sample*(short)outputL + line] = output[sample*(short)outputL + line] / usedLines;
-  }
+  BeamformSingleLine(BeamformingSettings::BeamformingAlgorithm::DAS, input, output, inputDim, outputDim, line,
+    config);
 }
 
 void mitk::BeamformingUtils::DMASSphericalLine(
   float* input, float* output, float inputDim[2], float outputDim[2],
   const short& line, const mitk::BeamformingSettings::Pointer config)
 {
-  const float* apodisation = config->GetApodizationFunction();
-  const short apodArraySize = config->GetApodizationArraySize();
-
-  const float* elementHeights = config->GetElementHeights();
-  const float* elementPositions = config->GetElementPositions();
-
-  float& inputS = inputDim[1];
-  float& inputL = inputDim[0];
-
-  float& outputS = outputDim[1];
-  float& outputL = outputDim[0];
-
-  short maxLine = 0;
-  short minLine = 0;
-  float l_p = 0;
-  float s_i = 0;
-
-  float apod_mult = 1;
-
-  float mult = 0;
-
-  short usedLines = (maxLine - minLine);
-
-  float totalSamples_i = (float)(config->GetReconstructionDepth()) /
-    (float)(config->GetSpeedOfSound() * config->GetTimeSpacing());
-  totalSamples_i = totalSamples_i <= inputS ? totalSamples_i : inputS;
-
-  l_p = (float)line / outputL * config->GetHorizontalExtent();
-
-  for (short sample = 0; sample < outputS; ++sample)
-  {
-    s_i = (float)sample / outputS * totalSamples_i;
-
-    minLine = config->GetMinMaxLines()[2 * sample*(short)outputL + 2 * line];
-    maxLine = config->GetMinMaxLines()[2 * sample*(short)outputL + 2 * line + 1];
-    usedLines = (maxLine - minLine);
-
-    apod_mult = (float)apodArraySize / (float)usedLines;
-
-    //calculate the AddSamples beforehand to save some time
-    short* AddSample = new short[maxLine - minLine];
-    for (short l_s = 0; l_s < maxLine - minLine; ++l_s)
-    {
-      AddSample[l_s] = (int)sqrt(
-        pow(s_i - elementHeights[l_s + minLine] / (config->GetSpeedOfSound()*config->GetTimeSpacing()), 2)
-        +
-        pow((1 / (config->GetTimeSpacing()*config->GetSpeedOfSound())) * (l_p - elementPositions[l_s + minLine]), 2)
-      ) + (1 - config->GetIsPhotoacousticImage())*s_i;
-    }
-
-    float s_1 = 0;
-    float s_2 = 0;
-
-    for (short l_s1 = minLine; l_s1 < maxLine - 1; ++l_s1)
-    {
-      if (AddSample[l_s1 - minLine] < inputS && AddSample[l_s1 - minLine] >= 0)
-      {
-        for (short l_s2 = l_s1 + 1; l_s2 < maxLine; ++l_s2)
-        {
-          if (AddSample[l_s2 - minLine] < inputS && AddSample[l_s2 - minLine] >= 0)
-          {
-            s_2 = input[l_s2 + AddSample[l_s2 - minLine] * (short)inputL];
-            s_1 = input[l_s1 + AddSample[l_s1 - minLine] * (short)inputL];
-
-            mult = s_2 * apodisation[(int)((l_s2 - minLine)*apod_mult)] * s_1 * apodisation[(int)((l_s1 - minLine)*apod_mult)];
-            output[sample*(short)outputL + line] += sqrt(fabs(mult)) * ((mult > 0) - (mult < 0));
-          }
-        }
-      }
-      else
-        --usedLines;
-    }
-
-    output[sample*(short)outputL + line] = output[sample*(short)outputL + line] / (float)(pow(usedLines, 2) - (usedLines - 1));
-
-    delete[] AddSample;
-  }
+  BeamformSingleLine(BeamformingSettings::BeamformingAlgorithm::DMAS, input, output, inputDim, outputDim, line,
+    config);
 }
 
 void mitk::BeamformingUtils::sDMASSphericalLine(
   float* input, float* output, float inputDim[2], float outputDim[2],
   const short& line, const mitk::BeamformingSettings::Pointer config)
 {
-  const float* apodisation = config->GetApodizationFunction();
-  const short apodArraySize = config->GetApodizationArraySize();
-
-  const float* elementHeights = config->GetElementHeights();
-  const float* elementPositions = config->GetElementPositions();
-
-  float& inputS = inputDim[1];
-  float& inputL = inputDim[0];
-
-  float& outputS = outputDim[1];
-  float& outputL = outputDim[0];
-
-  short maxLine = 0;
-  short minLine = 0;
-  float l_p = 0;
-  float s_i = 0;
-
-  float apod_mult = 1;
-
-  float mult = 0;
-
-  short usedLines = (maxLine - minLine);
-
-  float totalSamples_i = (float)(config->GetReconstructionDepth()) /
-    (float)(config->GetSpeedOfSound() * config->GetTimeSpacing());
-  totalSamples_i = totalSamples_i <= inputS ? totalSamples_i : inputS;
-
-  l_p = (float)line / outputL * config->GetHorizontalExtent();
-
-  for (short sample = 0; sample < outputS; ++sample)
-  {
-    s_i = (float)sample / outputS * totalSamples_i;
-
-    minLine = config->GetMinMaxLines()[2 * sample*(short)outputL + 2 * line];
-    maxLine = config->GetMinMaxLines()[2 * sample*(short)outputL + 2 * line + 1];
-    usedLines = (maxLine - minLine);
+  BeamformSingleLine(BeamformingSettings::BeamformingAlgorithm::sDMAS, input, output, inputDim, outputDim, line,
+    config);
+}
 
-    apod_mult = (float)apodArraySize / (float)usedLines;
+void mitk::BeamformingUtils::BeamformSlice(const float* input, float* output,
+  const unsigned int inputDim[2], const unsigned int outputDim[2],
+  const mitk::BeamformingSettings::Pointer config, unsigned int numberOfThreads)
+{
+  // the used lines are calculated on the first call, which must not happen concurrently in the threads
+  const unsigned short* minMaxLines = config->GetMinMaxLines();
+  const BeamformingSettings::BeamformingAlgorithm algorithm = config->GetAlgorithm();
 
-    //calculate the AddSamples beforehand to save some time
-    short* AddSample = new short[maxLine - minLine];
-    for (short l_s = 0; l_s < maxLine - minLine; ++l_s)
-    {
-      AddSample[l_s] = (int)sqrt(
-        pow(s_i - elementHeights[l_s + minLine] / (config->GetSpeedOfSound()*config->GetTimeSpacing()), 2)
-        +
-        pow((1 / (config->GetTimeSpacing()*config->GetSpeedOfSound())) * (l_p - elementPositions[l_s + minLine]), 2)
-      ) + (1 - config->GetIsPhotoacousticImage())*s_i;
-    }
+  if (numberOfThreads == 0)
+    numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
 
-    float s_1 = 0;
-    float s_2 = 0;
-    float sign = 0;
+  std::atomic<unsigned int> nextLine(0);
 
-    for (short l_s1 = minLine; l_s1 < maxLine - 1; ++l_s1)
+  auto worker = [&]() {
+    LineBuffers buffers(inputDim[0]);
+    for (unsigned int line = nextLine++; line < outputDim[0]; line = nextLine++)
     {
-      if (AddSample[l_s1 - minLine] < inputS && AddSample[l_s1 - minLine] >= 0)
-      {
-        s_1 = input[l_s1 + AddSample[l_s1 - minLine] * (short)inputL];
-        sign += s_1;
-
-        for (short l_s2 = l_s1 + 1; l_s2 < maxLine; ++l_s2)
-        {
-          if (AddSample[l_s2 - minLine] < inputS && AddSample[l_s2 - minLine] >= 0)
-          {
-            s_2 = input[l_s2 + AddSample[l_s2 - minLine] * (short)inputL];
-
-            mult = s_2 * apodisation[(int)((l_s2 - minLine)*apod_mult)] * s_1 * apodisation[(int)((l_s1 - minLine)*apod_mult)];
-            output[sample*(short)outputL + line] += sqrt(fabs(mult)) * ((mult > 0) - (mult < 0));
-          }
-        }
-      }
-      else
-        --usedLines;
+      BeamformLine(algorithm, input, output, inputDim[0], inputDim[1], outputDim[0], outputDim[1], line,
+                   config.GetPointer(), minMaxLines, buffers);
     }
+  };
 
-    output[sample*(short)outputL + line] = output[sample*(short)outputL + line] / (float)(pow(usedLines, 2) - (usedLines - 1)) * ((sign > 0) - (sign < 0));
+  std::vector<std::thread> threads;
+  for (unsigned int i = 1; i < std::min(numberOfThreads, outputDim[0]); ++i)
+    threads.emplace_back(worker);
+  worker();
 
-    delete[] AddSample;
-  }
+  for (auto& thread : threads)
+    thread.join();
 }
@@ -246,12 +246,19 @@ mitk::Image::Pointer mitk::PhotoacousticFilterService::ApplyBeamforming(
     processedImage = inputImage;
   }
 
-  m_BeamformingFilter = mitk::BeamformingFilter::New(config);
+  // the filter is kept, so the GPU delay tables are reused as long as the configuration does not change them
+  if (m_BeamformingFilter.IsNull())
+    m_BeamformingFilter = mitk::BeamformingFilter::New(config);
+  else
+    m_BeamformingFilter->SetConfig(config);
+
   m_BeamformingFilter->SetInput(ConvertToFloat(processedImage));
   m_BeamformingFilter->SetProgressHandle(progressHandle);
   m_BeamformingFilter->UpdateLargestPossibleRegion();
 
   processedImage = m_BeamformingFilter->GetOutput();
+  // the next call must not overwrite the returned image
+  processedImage->DisconnectPipeline();
 
   return processedImage;
 }
@@ -32,6 +32,8 @@ class mitkPAFilterServiceTestSuite : public mitk::TestFixture
 {
   CPPUNIT_TEST_SUITE(mitkPAFilterServiceTestSuite);
   MITK_TEST(testRunning);
+  MITK_TEST(testDelayTableHash);
+  MITK_TEST(testRepeatedBeamforming);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -48,17 +50,17 @@ public:
   void setUp() override
   {
     m_PhotoacousticFilterService = mitk::PhotoacousticFilterService::New();
+    inputDimensions = new unsigned int[length];
+    inputDimensions[0] = yDim;
+    inputDimensions[1] = xDim;
     m_BeamformingSettings = CreateBeamformingSettings();
   }
 
-  mitk::BeamformingSettings::Pointer CreateBeamformingSettings()
+  mitk::BeamformingSettings::Pointer CreateBeamformingSettings(float speedOfSound = 1500)
   {
-    inputDimensions = new unsigned int[length];
-    inputDimensions[0] = yDim;
-    inputDimensions[1] = xDim;
     mitk::BeamformingSettings::Pointer outputSettings = mitk::BeamformingSettings::New(
       (float)(0.3 / 1000),
-      (float)(1500),
+      speedOfSound,
       (float)(0.0125 / 1000000),
       27,
       true,
@@ -110,6 +112,31 @@ public:
     }
   }
 
+  void testDelayTableHash()
+  {
+    auto equalSettings = CreateBeamformingSettings();
+    CPPUNIT_ASSERT_MESSAGE("Equal settings have different delay table hashes",
+      m_BeamformingSettings->GetDelayTableHash() == equalSettings->GetDelayTableHash());
+
+    auto otherSettings = CreateBeamformingSettings(1540);
+    CPPUNIT_ASSERT_MESSAGE("A different speed of sound does not change the delay table hash",
+      m_BeamformingSettings->GetDelayTableHash() != otherSettings->GetDelayTableHash());
+  }
+
+  void testRepeatedBeamforming()
+  {
+    mitk::Image::Pointer testImage = mitk::Image::New();
+    testImage->Initialize(mitk::MakeScalarPixelType<float>(), 2, inputDimensions);
+
+    auto firstOutput = m_PhotoacousticFilterService->ApplyBeamforming(testImage, m_BeamformingSettings);
+    auto secondOutput = m_PhotoacousticFilterService->ApplyBeamforming(testImage, CreateBeamformingSettings());
+
+    CPPUNIT_ASSERT_MESSAGE("A second beamforming call must not reuse the output of the first call",
+      firstOutput.GetPointer() != secondOutput.GetPointer());
+    CPPUNIT_ASSERT_MESSAGE("The first output was changed by the second beamforming call",
+      firstOutput->IsInitialized() && firstOutput->GetDimension(0) == secondOutput->GetDimension(0));
+  }
+
   void tearDown() override
   {
     m_PhotoacousticFilterService = nullptr;
@@ -30,6 +30,8 @@ found in the LICENSE file.
 #include <time.h>
 #include <thread>
 #include <chrono>
+#include <fstream>
+#include <random>
 
 #include <vector>
 #include <iostream>
@@ -47,6 +49,8 @@ found in the LICENSE file.
 #include <mitkPALightSource.h>
 #include <mitkPAMonteCarloThreadHandler.h>
 
+#include <itksys/SystemTools.hxx>
+
 #ifdef _WIN32
 #include <direct.h>
 #else
@@ -220,10 +224,7 @@ public:
       totalNumberOfVoxels = Nx*Ny*Nz;
       if (verbose) std::cout << totalNumberOfVoxels << " = sizeof totalNumberOfVoxels" << std::endl;
 
-      muaVector = (double *)malloc(totalNumberOfVoxels * sizeof(double));  /* tissue structure */
-      musVector = (double *)malloc(totalNumberOfVoxels * sizeof(double));  /* tissue structure */
-      gVector = (double *)malloc(totalNumberOfVoxels * sizeof(double));  /* tissue structure */
-
+      // the tissue structure is read directly from the image data, which is kept alive by m_inputImage
       mitk::ImageReadAccessor readAccess0(m_inputImage, m_inputImage->GetVolumeData(0));
       muaVector = (double *)readAccess0.GetData();
       mitk::ImageReadAccessor readAccess1(m_inputImage, m_inputImage->GetVolumeData(1));
@@ -251,6 +252,9 @@ public:
   std::string myname;
   DetectorVoxel* detectorVoxel;
 
+  /* Seeds of RandomGen() have to be smaller than MSEED */
+  static const long MaximumSeed = 161803398;
+
   ReturnValues()
   {
     detectorVoxel = nullptr;
@@ -258,6 +262,19 @@ public:
     totalFluence = nullptr;
   }
 
+  void FreeMemory()
+  {
+    free(totalFluence);
+    totalFluence = nullptr;
+    if (detectorVoxel != nullptr)
+    {
+      free(detectorVoxel->fluenceContribution);
+      delete detectorVoxel->recordedPhotonRoute;
+      delete detectorVoxel;
+      detectorVoxel = nullptr;
+    }
+  }
+
   /* SUBROUTINES */
 
   /**************************************************************************
@@ -272,7 +289,7 @@ public:
    *      D.E. Knuth, "Seminumerical Algorithms," 2nd edition, vol. 2
    *      of "The Art of Computer Programming", Addison-Wesley, (1981).
    *
-   *      When Type is 0, sets Seed as the seed. Make sure 0<Seed<32000.
+   *      When Type is 0, sets Seed as the seed. Make sure 0<Seed<MaximumSeed.
    *      When Type is 1, returns a random number.
    *      When Type is 2, gets the status of the generator.
    *      When Type is 3, restores the status of the generator.
@@ -610,7 +627,9 @@ public:
 
 /* DECLARE FUNCTIONS */
 
-void runMonteCarlo(InputValues* inputValues, ReturnValues* returnValue, int thread, mitk::pa::MonteCarloThreadHandler::Pointer threadHandler);
+void runMonteCarlo(InputValues* inputValues, ReturnValues* returnValue, int thread, long seed, mitk::pa::MonteCarloThreadHandler::Pointer threadHandler);
+int simulateVolume(const std::string& inputFilename, std::string outputFilename, unsigned int volumeIndex);
+long getThreadSeed(unsigned int volumeIndex, int thread);
 
 int detector_x = -1;
 int detector_z = -1;
@@ -621,9 +640,8 @@ float requestedSimulationTime = 0; // in minutes
 int concurentThreadsSupported = -1;
 float yOffset = 0; // in mm
 bool saveLegacy = false;
+unsigned int baseSeed = 0;
 std::string normalizationFilename;
-std::string inputFilename;
-std::string outputFilename;
 
 mitk::pa::Probe::Pointer m_PhotoacousticProbe;
 
@@ -642,11 +660,11 @@ int main(int argc, char * argv[]) {
   parser.beginGroup("Required I/O parameters");
   parser.addArgument(
     "input", "i", mitkCommandLineParser::File,
-    "Input tissue file", "input tissue file (*.nrrd)",
-    us::Any(), false, false, false, mitkCommandLineParser::Input);
+    "Input tissue file", "input tissue file (*.nrrd), not needed if a batch file is given",
+    us::Any(), true, false, false, mitkCommandLineParser::Input);
   parser.addArgument(
     "output", "o", mitkCommandLineParser::File,
-    "Output fluence file", "where to save the simulated fluence (*.nrrd)",
+    "Output fluence file", "where to save the simulated fluence (*.nrrd), the output directory if a batch file is given",
     us::Any(), false, false, false, mitkCommandLineParser::Output);
   parser.endGroup();
   parser.beginGroup("Optional parameters");
@@ -676,6 +694,10 @@ int main(int argc, char * argv[]) {
     "Xml definition of the probe", "Specifies the absolute path of the location of the xml definition file of the probe design.", us::Any(), true, false, false, mitkCommandLineParser::Input);
   parser.addArgument("normalization-file", "nf", mitkCommandLineParser::File,
     "Input normalization file", "The input normalization file is used for normalization of the number of photons in the PVFC calculations.", us::Any(), true, false, false, mitkCommandLineParser::Input);
+  parser.addArgument("batch-file", "b", mitkCommandLineParser::File,
+    "Batch file", "Text file with one input tissue file per line. All volumes are simulated in one run and the fluence of each volume is saved with the name of its input file to the output directory.", us::Any(), true, false, false, mitkCommandLineParser::Input);
+  parser.addArgument("seed", "s", mitkCommandLineParser::Int,
+    "Random seed", "Seed from which the random number streams of all threads and volumes are derived (default: random). Runs with the same seed, number of jobs and number of photons are reproducible.");
   parser.endGroup();
 
   // parse arguments, this method returns a mapping of long argument names and their values
@@ -683,16 +705,59 @@ int main(int argc, char * argv[]) {
   if (parsedArgs.size() == 0)
     return EXIT_FAILURE;
   // parse, cast and set required arguments
-  inputFilename = us::any_cast<std::string>(parsedArgs["input"]);
-  // strip ending
-  inputFilename = inputFilename.substr(0, inputFilename.find("_H.mci"));
-  inputFilename = inputFilename.substr(0, inputFilename.find("_T.bin"));
+  std::vector<std::string> inputFilenames;
+  std::vector<std::string> outputFilenames;
+  std::string output = us::any_cast<std::string>(parsedArgs["output"]);
 
-  outputFilename = us::any_cast<std::string>(parsedArgs["output"]);
-  // add .nrrd if not there
-  std::string suffix = ".nrrd";
-  if (outputFilename.compare(outputFilename.size() - suffix.size(), suffix.size(), suffix) != 0)
-    outputFilename = outputFilename + suffix;
+  if (parsedArgs.count("batch-file"))
+  {
+    std::string batchFilename = us::any_cast<std::string>(parsedArgs["batch-file"]);
+    std::ifstream batchFile(batchFilename);
+    if (!batchFile)
+    {
+      std::cerr << "Could not open batch file " << batchFilename << ". Simulation failed." << std::endl;
+      return EXIT_FAILURE;
+    }
+    itksys::SystemTools::MakeDirectory(output);
+    std::string line;
+    while (std::getline(batchFile, line))
+    {
+      line = itksys::SystemTools::TrimWhitespace(line);
+      if (line.empty() || line[0] == '#')
+        continue;
+      std::string volumeOutputFilename = output + "/" + itksys::SystemTools::GetFilenameName(line);
+      if (itksys::SystemTools::CollapseFullPath(volumeOutputFilename) == itksys::SystemTools::CollapseFullPath(line))
+      {
+        std::cerr << "The output directory must not contain the input file " << line << ". Simulation failed." << std::endl;
+        return EXIT_FAILURE;
+      }
+      inputFilenames.push_back(line);
+      outputFilenames.push_back(volumeOutputFilename);
+    }
+  }
+  else if (parsedArgs.count("input"))
+  {
+    inputFilenames.push_back(us::any_cast<std::string>(parsedArgs["input"]));
+    outputFilenames.push_back(output);
+  }
+  else
+  {
+    std::cerr << "Either an input tissue file or a batch file is required. Simulation failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  for (unsigned int i = 0; i < inputFilenames.size(); i++)
+  {
+    // strip ending
+    inputFilenames[i] = inputFilenames[i].substr(0, inputFilenames[i].find("_H.mci"));
+    inputFilenames[i] = inputFilenames[i].substr(0, inputFilenames[i].find("_T.bin"));
+
+    // add .nrrd if not there
+    std::string suffix = ".nrrd";
+    if (outputFilenames[i].size() < suffix.size() ||
+        outputFilenames[i].compare(outputFilenames[i].size() - suffix.size(), suffix.size(), suffix) != 0)
+      outputFilenames[i] = outputFilenames[i] + suffix;
+  }
 
   // default values for optional arguments
   // parse, cast and set optional arguments if given
@@ -740,6 +805,15 @@ int main(int argc, char * argv[]) {
   {
     normalizationFilename = us::any_cast<std::string>(parsedArgs["normalization-file"]);
   }
+  if (parsedArgs.count("seed"))
+  {
+    baseSeed = us::any_cast<int>(parsedArgs["seed"]);
+  }
+  else
+  {
+    baseSeed = std::random_device()();
+  }
+  if (verbose) std::cout << "Using random seed " << baseSeed << std::endl;
 
   if (concurentThreadsSupported == 0 || concurentThreadsSupported == -1)
   {
@@ -763,17 +837,27 @@ int main(int argc, char * argv[]) {
       std::cout << "Will not perform PVFC calculation due to x=" << detector_x << " and/or z=" << detector_z << std::endl;
   }
 
+  for (unsigned int i = 0; i < inputFilenames.size(); i++)
+  {
+    if (inputFilenames.size() > 1)
+      std::cout << "Simulating volume " << (i + 1) << " of " << inputFilenames.size() << ": " << inputFilenames[i] << std::endl;
+
+    if (simulateVolume(inputFilenames[i], outputFilenames[i], i) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  exit(EXIT_SUCCESS);
+} /* end of main */
+
+/* Simulates the fluence of one tissue volume and saves it to outputFilename */
+int simulateVolume(const std::string& inputFilename, std::string outputFilename, unsigned int volumeIndex)
+{
   InputValues allInput = InputValues();
   allInput.LoadValues(inputFilename, yOffset, normalizationFilename, simulatePVFC);
 
+  // every thread accumulates the fluence in its own ReturnValues, they are summed up after the simulation
   std::vector<ReturnValues> allValues(concurentThreadsSupported);
-  auto* threads = new std::thread[concurentThreadsSupported];
-
-  for (long i = 0; i < concurentThreadsSupported; i++)
-  {
-    auto* tmp = new ReturnValues();
-    allValues.push_back(*tmp);
-  }
+  std::vector<std::thread> threads(concurentThreadsSupported);
 
   if (verbose) std::cout << "Initializing MonteCarloThreadHandler" << std::endl;
 
@@ -801,7 +885,7 @@ int main(int argc, char * argv[]) {
 
   for (int i = 0; i < concurentThreadsSupported; i++)
   {
-    threads[i] = std::thread(runMonteCarlo, &allInput, &allValues[i], (i + 1), threadHandler);
+    threads[i] = std::thread(runMonteCarlo, &allInput, &allValues[i], (i + 1), getThreadSeed(volumeIndex, i), threadHandler);
   }
 
   for (int i = 0; i < concurentThreadsSupported; i++)
@@ -878,6 +962,8 @@ int main(int argc, char * argv[]) {
     mitk::CoreServices::GetPropertyPersistence()->AddInfo(mitk::PropertyPersistenceInfo::New("y-offset"));
 
     mitk::IOUtil::Save(resultImage, outputFilename);
+    free(finalTotalFluence);
+    delete[] dimensionsOfImage;
 
     if (verbose) std::cout << "[OK]" << std::endl;
 
@@ -968,6 +1054,8 @@ int main(int argc, char * argv[]) {
     mitk::CoreServices::GetPropertyPersistence()->AddInfo(mitk::PropertyPersistenceInfo::New("simulated-photons"));
 
     mitk::IOUtil::Save(pvfcImage, outputFilename);
+    free(detectorFluence);
+    delete[] dimensionsOfPvfcImage;
 
     if (verbose) std::cout << "[OK]" << std::endl;
 
@@ -981,11 +1069,25 @@ int main(int argc, char * argv[]) {
     }
   }
 
-  exit(EXIT_SUCCESS);
-} /* end of main */
+  for (auto& values : allValues)
+  {
+    values.FreeMemory();
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/* Derives an independent seed for each thread and volume from the base seed */
+long getThreadSeed(unsigned int volumeIndex, int thread)
+{
+  std::seed_seq sequence{ baseSeed, volumeIndex, static_cast<unsigned int>(thread) };
+  std::vector<unsigned int> seed(1);
+  sequence.generate(seed.begin(), seed.end());
+  return 1 + seed[0] % (ReturnValues::MaximumSeed - 1);
+}
 
 /* CORE FUNCTION */
-void runMonteCarlo(InputValues* inputValues, ReturnValues* returnValue, int thread, mitk::pa::MonteCarloThreadHandler::Pointer threadHandler)
+void runMonteCarlo(InputValues* inputValues, ReturnValues* returnValue, int thread, long seed, mitk::pa::MonteCarloThreadHandler::Pointer threadHandler)
 {
   if (verbose) std::cout << "Thread " << thread << ": Locking Mutex ..." << std::endl;
   if (verbose) std::cout << "[OK]" << std::endl;
@@ -1039,8 +1141,7 @@ void runMonteCarlo(InputValues* inputValues, ReturnValues* returnValue, int thre
 
   /**** ======================== MAJOR CYCLE ============================ *****/
 
-  auto duration = std::chrono::system_clock::now().time_since_epoch();
-  returnValue->RandomGen(0, (std::chrono::duration_cast<std::chrono::milliseconds>(duration).count() + thread) % 32000, nullptr); /* initiate with seed = 1, or any long integer. */
+  returnValue->RandomGen(0, seed, nullptr); /* every thread has its own random number stream */
   for (j = 0; j < inputValues->totalNumberOfVoxels; j++) returnValue->totalFluence[j] = 0; // ensure F[] starts empty.
 
   /**** RUN Launch N photons, initializing each one before progation. *****/
@@ -92,7 +92,19 @@ namespace mitk {
       Eigen::VectorXf SpectralUnmixingAlgorithm(Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic> endmemberMatrix,
         Eigen::VectorXf inputVector) override;
 
+      /**
+      * \brief All algorithms are linear in the input vector, so the unmixing matrix is their solution for the identity matrix.
+      * The decomposition of the endmember matrix is therefore only computed once per update.
+      * @throws same as SpectralUnmixingAlgorithm
+      */
+      bool CalculateUnmixingMatrix(const Eigen::MatrixXf &endmemberMatrix, Eigen::MatrixXf &unmixingMatrix) override;
+
     private:
+      /**
+      * \brief Solves endmemberMatrix * x = b for every column b of rightHandSide with the algorithm set by "SetAlgorithm".
+      */
+      Eigen::MatrixXf Solve(const Eigen::MatrixXf &endmemberMatrix, const Eigen::MatrixXf &rightHandSide);
+
       AlgortihmType algorithmName;
     };
   }
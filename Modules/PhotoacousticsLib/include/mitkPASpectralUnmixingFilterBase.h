@@ -44,6 +44,10 @@ namespace mitk {
     * sequences. Furthermore it is possible to creat an output image that contains the information about the relative error between unmixing result
     * and the input image.
     *
+    * Algorithms whose result is a linear function of the input pixel (e.g. the least squares solvers) provide the matrix of this
+    * function with CalculateUnmixingMatrix. It is computed once per update and applied to blocks of pixels with matrix products,
+    * using the mitk::ThreadPool for different blocks and sequences. All other algorithms unmix pixel by pixel.
+    *
     * Subclasses:
     * - mitkPASpectralUnmixingFilterVigra
     * - mitkPALinearSpectralUnmixingFilter (uses Eigen algorithms)
@@ -126,6 +130,17 @@ namespace mitk {
       virtual Eigen::VectorXf SpectralUnmixingAlgorithm(Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic> endmemberMatrix,
         Eigen::VectorXf inputVector) = 0;
 
+      /**
+      * \brief Subclasses override the method if the unmixing result is a linear function of the input vector, i.e. if
+      * SpectralUnmixingAlgorithm(endmemberMatrix, inputVector) == unmixingMatrix * inputVector for every input vector.
+      * The default implementation returns false, so every pixel is unmixed by SpectralUnmixingAlgorithm.
+      * @param endmemberMatrix see SpectralUnmixingAlgorithm
+      * @param unmixingMatrix is set to the matrix with number of chromophores rows and number of wavelengths columns
+      * @return whether the unmixing matrix was calculated
+      * @throws if the algorithm cannot be applied to the endmember matrix
+      */
+      virtual bool CalculateUnmixingMatrix(const Eigen::MatrixXf &endmemberMatrix, Eigen::MatrixXf &unmixingMatrix);
+
       bool m_Verbose = false;
       bool m_RelativeError = false;
 
@@ -159,6 +174,15 @@ namespace mitk {
       */
       void GenerateData() override;
 
+      /*
+      * \brief Unmixes all sequences with the matrix of CalculateUnmixingMatrix and writes the results and the relative error
+      * into the output buffers. Blocks of pixels are processed in parallel.
+      * @param numberOfPixels is the number of pixels of one XY-plane
+      */
+      void ApplyUnmixingMatrix(const Eigen::MatrixXf &unmixingMatrix, const Eigen::MatrixXf &endmemberMatrix,
+        const float *inputDataArray, const std::vector<float *> &outputBuffers, std::size_t numberOfPixels,
+        unsigned int totalNumberOfSequences);
+
       /*
       * \brief Creats a Matrix with number of chromophores colums and number of wavelengths rows so matrix element (i,j) contains
       * the absorbtion of chromophore j @ wavelength i. The absorbtion values are taken from the "PropertyElement" method.
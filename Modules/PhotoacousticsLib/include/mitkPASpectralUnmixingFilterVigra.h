@@ -95,6 +95,12 @@ namespace mitk {
       Eigen::VectorXf SpectralUnmixingAlgorithm(Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic> EndmemberMatrix,
         Eigen::VectorXf inputVector) override;
 
+      /**
+      * \brief Only the LS algorithm is linear in the input vector, for it the unmixing matrix is the least squares solution for
+      * the identity matrix. The other algorithms are constrained and unmix pixel by pixel.
+      */
+      bool CalculateUnmixingMatrix(const Eigen::MatrixXf &endmemberMatrix, Eigen::MatrixXf &unmixingMatrix) override;
+
     private:
       std::vector<double> weightsvec;
       SpectralUnmixingFilterVigra::VigraAlgortihmType algorithmName;
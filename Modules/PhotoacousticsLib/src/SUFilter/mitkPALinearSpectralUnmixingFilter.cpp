@@ -35,10 +35,23 @@ void mitk::pa::LinearSpectralUnmixingFilter::SetAlgorithm(mitk::pa::LinearSpectr
 Eigen::VectorXf mitk::pa::LinearSpectralUnmixingFilter::SpectralUnmixingAlgorithm(
   Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic> endmemberMatrix, Eigen::VectorXf inputVector)
 {
-  Eigen::VectorXf resultVector;
+  return Solve(endmemberMatrix, inputVector);
+}
+
+bool mitk::pa::LinearSpectralUnmixingFilter::CalculateUnmixingMatrix(const Eigen::MatrixXf &endmemberMatrix,
+  Eigen::MatrixXf &unmixingMatrix)
+{
+  unmixingMatrix = Solve(endmemberMatrix, Eigen::MatrixXf::Identity(endmemberMatrix.rows(), endmemberMatrix.rows()));
+  return true;
+}
+
+Eigen::MatrixXf mitk::pa::LinearSpectralUnmixingFilter::Solve(const Eigen::MatrixXf &endmemberMatrix,
+  const Eigen::MatrixXf &rightHandSide)
+{
+  Eigen::MatrixXf result;
 
   if (mitk::pa::LinearSpectralUnmixingFilter::AlgortihmType::HOUSEHOLDERQR == algorithmName)
-    resultVector = endmemberMatrix.householderQr().solve(inputVector);
+    result = endmemberMatrix.householderQr().solve(rightHandSide);
 
   else if (mitk::pa::LinearSpectralUnmixingFilter::AlgortihmType::LDLT == algorithmName)
   {
@@ -48,7 +61,7 @@ Eigen::VectorXf mitk::pa::LinearSpectralUnmixingFilter::SpectralUnmixingAlgorith
       mitkThrow() << "Possibly non semi-positive definitie endmembermatrix!";
     }
     else
-      resultVector = endmemberMatrix.ldlt().solve(inputVector);
+      result = endmemberMatrix.ldlt().solve(rightHandSide);
   }
 
   else if (mitk::pa::LinearSpectralUnmixingFilter::AlgortihmType::LLT == algorithmName)
@@ -59,22 +72,22 @@ Eigen::VectorXf mitk::pa::LinearSpectralUnmixingFilter::SpectralUnmixingAlgorith
       mitkThrow() << "Possibly non semi-positive definitie endmembermatrix!";
     }
     else
-      resultVector = endmemberMatrix.llt().solve(inputVector);
+      result = endmemberMatrix.llt().solve(rightHandSide);
   }
 
   else if (mitk::pa::LinearSpectralUnmixingFilter::AlgortihmType::COLPIVHOUSEHOLDERQR == algorithmName)
-    resultVector = endmemberMatrix.colPivHouseholderQr().solve(inputVector);
+    result = endmemberMatrix.colPivHouseholderQr().solve(rightHandSide);
 
   else if (mitk::pa::LinearSpectralUnmixingFilter::AlgortihmType::JACOBISVD == algorithmName)
-    resultVector = endmemberMatrix.jacobiSvd(Eigen::ComputeFullU | Eigen::ComputeFullV).solve(inputVector);
+    result = endmemberMatrix.jacobiSvd(Eigen::ComputeFullU | Eigen::ComputeFullV).solve(rightHandSide);
 
   else if (mitk::pa::LinearSpectralUnmixingFilter::AlgortihmType::FULLPIVLU == algorithmName)
-    resultVector = endmemberMatrix.fullPivLu().solve(inputVector);
+    result = endmemberMatrix.fullPivLu().solve(rightHandSide);
 
   else if (mitk::pa::LinearSpectralUnmixingFilter::AlgortihmType::FULLPIVHOUSEHOLDERQR == algorithmName)
-    resultVector = endmemberMatrix.fullPivHouseholderQr().solve(inputVector);
+    result = endmemberMatrix.fullPivHouseholderQr().solve(rightHandSide);
   else
     mitkThrow() << "404 VIGRA ALGORITHM NOT FOUND";
 
-  return resultVector;
+  return result;
 }
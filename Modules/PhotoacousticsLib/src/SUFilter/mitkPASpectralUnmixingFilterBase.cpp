@@ -20,6 +20,16 @@ found in the LICENSE file.
 #include <mitkImageReadAccessor.h>
 #include <mitkImageWriteAccessor.h>
 
+#include <mitkThreadPool.h>
+
+#include <algorithm>
+
+namespace
+{
+  /** Number of pixels unmixed by one matrix product, small enough to keep the pixel values of all wavelengths in the cache */
+  const std::size_t PixelBlockSize = 4096;
+}
+
 mitk::pa::SpectralUnmixingFilterBase::SpectralUnmixingFilterBase()
 {
   m_PropertyCalculatorEigen = mitk::pa::PropertyCalculator::New();
@@ -110,44 +120,108 @@ void mitk::pa::SpectralUnmixingFilterBase::GenerateData()
     outputCounter -= 1;
   }
 
-  for (unsigned int sequenceCounter = 0; sequenceCounter < totalNumberOfSequences; ++sequenceCounter)
+  Eigen::MatrixXf unmixingMatrix;
+  if (CalculateUnmixingMatrix(endmemberMatrix, unmixingMatrix))
+  {
+    MITK_INFO(m_Verbose) << "UNMIXING WITH PRECOMPUTED MATRIX";
+    ApplyUnmixingMatrix(unmixingMatrix, endmemberMatrix, inputDataArray, writteBufferVector, xDim * yDim, totalNumberOfSequences);
+  }
+  else
   {
-    MITK_INFO(m_Verbose) << "SequenceCounter: " << sequenceCounter;
-    //loop over every pixel in XY-plane
-    for (unsigned int x = 0; x < xDim; x++)
+    for (unsigned int sequenceCounter = 0; sequenceCounter < totalNumberOfSequences; ++sequenceCounter)
     {
-      for (unsigned int y = 0; y < yDim; y++)
+      MITK_INFO(m_Verbose) << "SequenceCounter: " << sequenceCounter;
+      //loop over every pixel in XY-plane
+      for (unsigned int x = 0; x < xDim; x++)
       {
-        Eigen::VectorXf inputVector(sequenceSize);
-        for (unsigned int z = 0; z < sequenceSize; z++)
+        for (unsigned int y = 0; y < yDim; y++)
         {
-          /**
-          * 'sequenceCounter*sequenceSize' has to be added to 'z' to ensure that one accesses the
-          * correct pixel, because the inputDataArray contains the information of all sequences and
-          * not just the one of the current sequence.
-          */
-          unsigned int pixelNumber = (xDim*yDim*(z+sequenceCounter*sequenceSize)) + x * yDim + y;
-          auto pixel = inputDataArray[pixelNumber];
-
-          inputVector[z] = pixel;
+          Eigen::VectorXf inputVector(sequenceSize);
+          for (unsigned int z = 0; z < sequenceSize; z++)
+          {
+            /**
+            * 'sequenceCounter*sequenceSize' has to be added to 'z' to ensure that one accesses the
+            * correct pixel, because the inputDataArray contains the information of all sequences and
+            * not just the one of the current sequence.
+            */
+            unsigned int pixelNumber = (xDim*yDim*(z+sequenceCounter*sequenceSize)) + x * yDim + y;
+            auto pixel = inputDataArray[pixelNumber];
+
+            inputVector[z] = pixel;
+          }
+          Eigen::VectorXf resultVector = SpectralUnmixingAlgorithm(endmemberMatrix, inputVector);
+
+          if (m_RelativeError == true)
+          {
+            float relativeError = CalculateRelativeError(endmemberMatrix, inputVector, resultVector);
+            writteBufferVector[outputCounter][(xDim*yDim * sequenceCounter) + x * yDim + y] = relativeError;
+          }
+
+          for (unsigned int outputIdx = 0; outputIdx < outputCounter; ++outputIdx)
+          {
+            writteBufferVector[outputIdx][(xDim*yDim * sequenceCounter) + x * yDim + y] = resultVector[outputIdx];
+          }
         }
-        Eigen::VectorXf resultVector = SpectralUnmixingAlgorithm(endmemberMatrix, inputVector);
+      }
+    }
+  }
+  MITK_INFO(m_Verbose) << "GENERATING DATA...[DONE]";
+  myfile.close();
+}
 
-        if (m_RelativeError == true)
-        {
-          float relativeError = CalculateRelativeError(endmemberMatrix, inputVector, resultVector);
-          writteBufferVector[outputCounter][(xDim*yDim * sequenceCounter) + x * yDim + y] = relativeError;
-        }
+bool mitk::pa::SpectralUnmixingFilterBase::CalculateUnmixingMatrix(const Eigen::MatrixXf &, Eigen::MatrixXf &)
+{
+  return false;
+}
+
+void mitk::pa::SpectralUnmixingFilterBase::ApplyUnmixingMatrix(const Eigen::MatrixXf &unmixingMatrix,
+  const Eigen::MatrixXf &endmemberMatrix, const float *inputDataArray, const std::vector<float *> &outputBuffers,
+  std::size_t numberOfPixels, unsigned int totalNumberOfSequences)
+{
+  using RowMajorMatrix = Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+  using InputBlock = Eigen::Map<const RowMajorMatrix, Eigen::Unaligned, Eigen::OuterStride<>>;
+
+  const std::size_t sequenceSize = m_Wavelength.size();
+  const std::size_t numberOfChromophores = m_Chromophore.size();
+  const std::size_t blocksPerSequence = (numberOfPixels + PixelBlockSize - 1) / PixelBlockSize;
 
-        for (unsigned int outputIdx = 0; outputIdx < outputCounter; ++outputIdx)
+  mitk::ThreadPool::GetInstance().ParallelFor(0, totalNumberOfSequences * blocksPerSequence,
+    [&](std::size_t begin, std::size_t end)
+  {
+    for (std::size_t blockIdx = begin; blockIdx < end; ++blockIdx)
+    {
+      const std::size_t sequenceCounter = blockIdx / blocksPerSequence;
+      const std::size_t firstPixel = (blockIdx % blocksPerSequence) * PixelBlockSize;
+      const std::size_t blockSize = std::min(PixelBlockSize, numberOfPixels - firstPixel);
+
+      // The images of a sequence are consecutive, so the block is a matrix with one row per wavelength and one column per pixel.
+      InputBlock inputBlock(inputDataArray + sequenceCounter * sequenceSize * numberOfPixels + firstPixel,
+        sequenceSize, blockSize, Eigen::OuterStride<>(numberOfPixels));
+      Eigen::MatrixXf resultBlock = unmixingMatrix * inputBlock;
+
+      const std::size_t outputOffset = sequenceCounter * numberOfPixels + firstPixel;
+      for (std::size_t outputIdx = 0; outputIdx < numberOfChromophores; ++outputIdx)
+        Eigen::Map<Eigen::RowVectorXf>(outputBuffers[outputIdx] + outputOffset, blockSize) = resultBlock.row(outputIdx);
+
+      if (m_RelativeError == true)
+      {
+        // same as CalculateRelativeError for every pixel of the block
+        Eigen::MatrixXf residual = endmemberMatrix * resultBlock - inputBlock;
+        Eigen::RowVectorXf relativeErrors = residual.colwise().norm().cwiseQuotient(inputBlock.colwise().norm());
+        const std::size_t numberOfSettings = std::min<std::size_t>(2, std::min(numberOfChromophores, m_RelativeErrorSettings.size()));
+        float *relativeErrorBuffer = outputBuffers[numberOfChromophores] + outputOffset;
+        for (std::size_t pixel = 0; pixel < blockSize; ++pixel)
         {
-          writteBufferVector[outputIdx][(xDim*yDim * sequenceCounter) + x * yDim + y] = resultVector[outputIdx];
+          relativeErrorBuffer[pixel] = relativeErrors[pixel];
+          for (std::size_t i = 0; i < numberOfSettings; ++i)
+          {
+            if (resultBlock(i, pixel) < m_RelativeErrorSettings[i])
+              relativeErrorBuffer[pixel] = 0;
+          }
         }
       }
     }
-  }
-  MITK_INFO(m_Verbose) << "GENERATING DATA...[DONE]";
-  myfile.close();
+  });
 }
 
 void mitk::pa::SpectralUnmixingFilterBase::CheckPreConditions(mitk::Image::Pointer input)
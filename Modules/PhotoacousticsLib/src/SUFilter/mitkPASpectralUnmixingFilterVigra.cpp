@@ -98,3 +98,32 @@ Eigen::VectorXf mitk::pa::SpectralUnmixingFilterVigra::SpectralUnmixingAlgorithm
 
   return resultVector;
 }
+
+bool mitk::pa::SpectralUnmixingFilterVigra::CalculateUnmixingMatrix(const Eigen::MatrixXf &endmemberMatrix,
+  Eigen::MatrixXf &unmixingMatrix)
+{
+  if (mitk::pa::SpectralUnmixingFilterVigra::VigraAlgortihmType::LS != algorithmName)
+    return false;
+
+  unsigned int numberOfWavelengths = endmemberMatrix.rows();
+  unsigned int numberOfChromophores = endmemberMatrix.cols();
+
+  vigra::Matrix<double> A(vigra::Shape2(numberOfWavelengths, numberOfChromophores));
+  for (unsigned int i = 0; i < numberOfWavelengths; ++i)
+  {
+    for (unsigned int j = 0; j < numberOfChromophores; ++j)
+      A(i, j) = (double)endmemberMatrix(i, j);
+  }
+  vigra::Matrix<double> b(vigra::linalg::identityMatrix<double>(numberOfWavelengths));
+  vigra::Matrix<double> x(vigra::Shape2(numberOfChromophores, numberOfWavelengths));
+
+  linearSolve(A, b, x);
+
+  unmixingMatrix.resize(numberOfChromophores, numberOfWavelengths);
+  for (unsigned int j = 0; j < numberOfChromophores; ++j)
+  {
+    for (unsigned int i = 0; i < numberOfWavelengths; ++i)
+      unmixingMatrix(j, i) = (float)x(j, i);
+  }
+  return true;
+}
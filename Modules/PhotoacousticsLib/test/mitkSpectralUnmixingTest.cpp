@@ -33,6 +33,7 @@ class mitkSpectralUnmixingTestSuite : public mitk::TestFixture
   MITK_TEST(testAddOutput);
   MITK_TEST(testWeightsError);
   MITK_TEST(testOutputs);
+  MITK_TEST(testUnmixingMatrix);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -634,6 +635,65 @@ public:
     }
   }
 
+  // Tests that unmixing with the precomputed matrix (Eigen) matches pixelwise unmixing (Vigra LARS) on several sequences
+  void testUnmixingMatrix()
+  {
+    const unsigned int xDim = 70;
+    const unsigned int yDim = 90;
+    const unsigned int numberOfSequences = 3;
+    const unsigned int numberOfPixels = xDim * yDim;
+
+    auto image = mitk::Image::New();
+    unsigned int dimensions[3] = { xDim, yDim, numberOfSequences * 2 };
+    image->Initialize(mitk::MakeScalarPixelType<float>(), 3, dimensions);
+
+    std::vector<float> data(numberOfPixels * dimensions[2]);
+    for (unsigned int sequence = 0; sequence < numberOfSequences; ++sequence)
+    {
+      for (unsigned int pixel = 0; pixel < numberOfPixels; ++pixel)
+      {
+        float fracHb = 10 + pixel % 100;
+        float fracHbO2 = 50 + pixel % 37 + 10 * sequence;
+        data[(2 * sequence) * numberOfPixels + pixel] = fracHb * 7.52 + fracHbO2 * 2.77;
+        data[(2 * sequence + 1) * numberOfPixels + pixel] = fracHb * 4.08 + fracHbO2 * 4.37;
+      }
+    }
+    image->SetImportVolume(data.data(), mitk::Image::ImportMemoryManagementType::CopyMemory);
+
+    auto eigenFilter = mitk::pa::LinearSpectralUnmixingFilter::New();
+    eigenFilter->SetAlgorithm(mitk::pa::LinearSpectralUnmixingFilter::AlgortihmType::HOUSEHOLDERQR);
+    auto vigraFilter = mitk::pa::SpectralUnmixingFilterVigra::New();
+    vigraFilter->SetAlgorithm(mitk::pa::SpectralUnmixingFilterVigra::VigraAlgortihmType::LARS);
+
+    std::vector<mitk::pa::SpectralUnmixingFilterBase::Pointer> filters = { eigenFilter.GetPointer(), vigraFilter.GetPointer() };
+    for (auto filter : filters)
+    {
+      filter->Verbose(false);
+      filter->RelativeError(true);
+      filter->AddRelativeErrorSettings(0);
+      filter->AddRelativeErrorSettings(0);
+      filter->SetInput(image);
+      filter->AddOutputs(3);
+      for (auto wavelength : m_inputWavelengths)
+        filter->AddWavelength(wavelength);
+      filter->AddChromophore(mitk::pa::PropertyCalculator::ChromophoreType::OXYGENATED);
+      filter->AddChromophore(mitk::pa::PropertyCalculator::ChromophoreType::DEOXYGENATED);
+      filter->Update();
+    }
+
+    for (unsigned int outputIdx = 0; outputIdx < 3; ++outputIdx)
+    {
+      mitk::ImageReadAccessor eigenAccess(eigenFilter->GetOutput(outputIdx));
+      mitk::ImageReadAccessor vigraAccess(vigraFilter->GetOutput(outputIdx));
+      const float* eigenData = (const float*)eigenAccess.GetData();
+      const float* vigraData = (const float*)vigraAccess.GetData();
+
+      CPPUNIT_ASSERT(numberOfSequences == eigenFilter->GetOutput(outputIdx)->GetDimensions()[2]);
+      for (unsigned int pixel = 0; pixel < numberOfPixels * numberOfSequences; ++pixel)
+        CPPUNIT_ASSERT(std::abs(eigenData[pixel] - vigraData[pixel]) < threshold * (1 + std::abs(vigraData[pixel])));
+    }
+  }
+
   // TEST TEMPLATE:
   /*
   // Test exceptions for
@@ -21,6 +21,9 @@ found in the LICENSE file.
 #include "vtkNew.h"
 #include "vtkPen.h"
 
+#include <map>
+#include <vector>
+
 class vtkContext2D;
 
 namespace mitk
@@ -204,35 +207,63 @@ namespace mitk
                     const mitk::PlaneGeometry *rendererGeometry,
                     const mitk::BaseRenderer *renderer);
 
+    /**
+    * \brief Polylines of the figure in display coordinates for one renderer.
+    *
+    * The polylines are only projected again if they, the plane geometry of the
+    * figure, the camera or the viewport size of the renderer changed.
+    */
+    struct ProjectedPolyLines
+    {
+      std::vector<mitk::PlanarFigure::PolyLineType> PolyLines;
+      std::vector<mitk::PlanarFigure::PolyLineType> HelperPolyLines;
+      std::vector<bool> HelperToBePainted;
+      bool Closed = false;
+      itk::ModifiedTimeType PlaneGeometryMTime = 0;
+      vtkMTimeType CameraMTime = 0;
+      int ViewportSize[2] = {0, 0};
+
+      /** Interleaved x and y display coordinates of each polyline */
+      std::vector<std::vector<float>> DisplayPolyLines;
+      std::vector<std::vector<float>> DisplayHelperPolyLines;
+
+      /** Right-most point of the last painted polyline */
+      bool HasAnchorPoint = false;
+      mitk::Point2D AnchorPoint;
+    };
+
+    /**
+    * \brief Updates the projected polylines of the figure for the renderer, if necessary.
+    */
+    const ProjectedPolyLines &UpdateProjectedPolyLines(mitk::PlanarFigure *figure,
+                                                       const PlaneGeometry *planarFigurePlaneGeometry,
+                                                       const mitk::BaseRenderer *renderer);
+
+    /**
+    * \brief Projects the polyline to display coordinates and returns its right-most point.
+    */
+    mitk::Point2D ProjectPolyLine(const mitk::PlanarFigure::PolyLineType &vertices,
+                                  bool closed,
+                                  std::vector<float> &displayPoints,
+                                  const PlaneGeometry *planarFigurePlaneGeometry,
+                                  const mitk::BaseRenderer *renderer);
+
     /**
     * \brief Actually paints the polyline defined by the figure.
     */
-    void PaintPolyLine(const mitk::PlanarFigure::PolyLineType vertices,
-                       bool closed,
-                       Point2D &anchorPoint,
-                       const PlaneGeometry *planarFigurePlaneGeometry,
-                       const PlaneGeometry *rendererPlaneGeometry,
-                       const mitk::BaseRenderer *renderer);
+    void PaintPolyLine(const std::vector<float> &displayPoints);
 
     /**
     * \brief Internally used by RenderLines() to draw the mainlines using
     * PaintPolyLine().
     */
-    void DrawMainLines(mitk::PlanarFigure *figure,
-                       Point2D &anchorPoint,
-                       const PlaneGeometry *planarFigurePlaneGeometry,
-                       const PlaneGeometry *rendererPlaneGeometry,
-                       const mitk::BaseRenderer *renderer);
+    void DrawMainLines(const ProjectedPolyLines &polyLines);
 
     /**
     * \brief Internally used by RenderLines() to draw the helperlines using
     * PaintPolyLine().
     */
-    void DrawHelperLines(mitk::PlanarFigure *figure,
-                         Point2D &anchorPoint,
-                         const PlaneGeometry *planarFigurePlaneGeometry,
-                         const PlaneGeometry *rendererPlaneGeometry,
-                         const mitk::BaseRenderer *renderer);
+    void DrawHelperLines(const ProjectedPolyLines &polyLines);
 
     void InitializeDefaultPlanarFigureProperties();
 
@@ -311,6 +342,8 @@ namespace mitk
 
     vtkNew<vtkContext2D> m_Context;
     vtkSmartPointer<vtkPen> m_Pen;
+
+    std::map<const mitk::BaseRenderer *, ProjectedPolyLines> m_ProjectedPolyLines;
   };
 
 } // namespace mitk
@@ -14,11 +14,13 @@ found in the LICENSE file.
 
 #include "mitkBaseRenderer.h"
 #include "mitkColorProperty.h"
+#include "vtkCamera.h"
 #include "vtkContext2D.h"
 #include "vtkContextDevice2D.h"
 #include "vtkOpenGLContextDevice2D.h"
 #include "mitkPlaneGeometry.h"
 #include "mitkProperties.h"
+#include "vtkRenderer.h"
 #include "vtkTextProperty.h"
 
 #define _USE_MATH_DEFINES
@@ -184,25 +186,98 @@ void mitk::PlanarFigureMapper2D::MitkRender(mitk::BaseRenderer *renderer, mitk::
   this->m_Context->GetDevice()->End();
 }
 
-void mitk::PlanarFigureMapper2D::PaintPolyLine(const mitk::PlanarFigure::PolyLineType vertices,
-                                               bool closed,
-                                               Point2D &anchorPoint,
-                                               const PlaneGeometry *planarFigurePlaneGeometry,
-                                               const PlaneGeometry *rendererPlaneGeometry,
-                                               const mitk::BaseRenderer *renderer)
+const mitk::PlanarFigureMapper2D::ProjectedPolyLines &mitk::PlanarFigureMapper2D::UpdateProjectedPolyLines(
+  mitk::PlanarFigure *figure, const PlaneGeometry *planarFigurePlaneGeometry, const mitk::BaseRenderer *renderer)
+{
+  ProjectedPolyLines &projected = m_ProjectedPolyLines[renderer];
+
+  std::vector<mitk::PlanarFigure::PolyLineType> polyLines;
+  const auto numberOfPolyLines = figure->GetPolyLinesSize();
+  for (auto loop = 0; loop < numberOfPolyLines; ++loop)
+  {
+    polyLines.push_back(figure->GetPolyLine(loop));
+  }
+
+  std::vector<mitk::PlanarFigure::PolyLineType> helperPolyLines;
+  std::vector<bool> helperToBePainted;
+  const auto numberOfHelperPolyLines = figure->GetHelperPolyLinesSize();
+  for (unsigned int loop = 0; loop < numberOfHelperPolyLines; ++loop)
+  {
+    helperPolyLines.push_back(
+      figure->GetHelperPolyLine(loop, renderer->GetScaleFactorMMPerDisplayUnit(), renderer->GetViewportSize()[1]));
+
+    // Check if the current helper objects is to be painted
+    helperToBePainted.push_back(figure->IsHelperToBePainted(loop));
+  }
+
+  const bool closed = figure->IsClosed();
+  const itk::ModifiedTimeType planeGeometryMTime = planarFigurePlaneGeometry->GetMTime();
+  const vtkMTimeType cameraMTime = renderer->GetVtkRenderer()->GetActiveCamera()->GetMTime();
+  const int *viewportSize = renderer->GetViewportSize();
+
+  if (projected.Closed == closed && projected.PlaneGeometryMTime == planeGeometryMTime &&
+      projected.CameraMTime == cameraMTime && projected.ViewportSize[0] == viewportSize[0] &&
+      projected.ViewportSize[1] == viewportSize[1] && projected.PolyLines == polyLines &&
+      projected.HelperPolyLines == helperPolyLines && projected.HelperToBePainted == helperToBePainted)
+  {
+    return projected;
+  }
+
+  projected.DisplayPolyLines.resize(polyLines.size());
+  projected.DisplayHelperPolyLines.resize(helperPolyLines.size());
+  projected.HasAnchorPoint = false;
+
+  for (std::size_t i = 0; i < polyLines.size(); ++i)
+  {
+    projected.AnchorPoint = this->ProjectPolyLine(
+      polyLines[i], closed, projected.DisplayPolyLines[i], planarFigurePlaneGeometry, renderer);
+    projected.HasAnchorPoint = true;
+  }
+
+  for (std::size_t i = 0; i < helperPolyLines.size(); ++i)
+  {
+    projected.DisplayHelperPolyLines[i].clear();
+
+    if (!helperToBePainted[i])
+      continue;
+
+    projected.AnchorPoint = this->ProjectPolyLine(
+      helperPolyLines[i], false, projected.DisplayHelperPolyLines[i], planarFigurePlaneGeometry, renderer);
+    projected.HasAnchorPoint = true;
+  }
+
+  projected.PolyLines = std::move(polyLines);
+  projected.HelperPolyLines = std::move(helperPolyLines);
+  projected.HelperToBePainted = std::move(helperToBePainted);
+  projected.Closed = closed;
+  projected.PlaneGeometryMTime = planeGeometryMTime;
+  projected.CameraMTime = cameraMTime;
+  projected.ViewportSize[0] = viewportSize[0];
+  projected.ViewportSize[1] = viewportSize[1];
+
+  return projected;
+}
+
+mitk::Point2D mitk::PlanarFigureMapper2D::ProjectPolyLine(const mitk::PlanarFigure::PolyLineType &vertices,
+                                                          bool closed,
+                                                          std::vector<float> &displayPoints,
+                                                          const PlaneGeometry *planarFigurePlaneGeometry,
+                                                          const mitk::BaseRenderer *renderer)
 {
   mitk::Point2D rightMostPoint;
   rightMostPoint.Fill(itk::NumericTraits<float>::min());
 
-  // transform all vertices into Point2Ds in display-Coordinates and store them in vector
-  std::vector<mitk::Point2D> pointlist;
+  displayPoints.clear();
+  displayPoints.reserve((vertices.size() + 1) * 2);
+
+  // transform all vertices into Point2Ds in display-Coordinates
   for (auto iter = vertices.cbegin(); iter != vertices.cend(); ++iter)
   {
-    // Draw this 2D point as OpenGL vertex
     mitk::Point2D displayPoint;
-    this->TransformObjectToDisplay(*iter, displayPoint, planarFigurePlaneGeometry, rendererPlaneGeometry, renderer);
+    this->TransformObjectToDisplay(*iter, displayPoint, planarFigurePlaneGeometry, nullptr, renderer);
 
-    pointlist.push_back(displayPoint);
+    displayPoints.push_back(displayPoint[0]);
+    displayPoints.push_back(displayPoint[1]);
 
     if (displayPoint[0] > rightMostPoint[0])
       rightMostPoint = displayPoint;
@@ -211,70 +286,36 @@ void mitk::PlanarFigureMapper2D::PaintPolyLine(const mitk::PlanarFigure::PolyLin
   // If the planarfigure is closed, we add the first control point again.
   // Thus we can always use 'GL_LINE_STRIP' and get rid of strange flickering
   // effect when using the MESA OpenGL library.
-  if (closed)
+  if (closed && !vertices.empty())
   {
-    mitk::Point2D displayPoint;
-    this->TransformObjectToDisplay(
-      vertices.cbegin()[0], displayPoint, planarFigurePlaneGeometry, rendererPlaneGeometry, renderer);
-
-    pointlist.push_back(displayPoint);
+    displayPoints.push_back(displayPoints[0]);
+    displayPoints.push_back(displayPoints[1]);
   }
 
-  // now paint all the points in one run
-
-  std::vector<float> points;
-  points.reserve(pointlist.size() * 2);
-
-  for (unsigned int i = 0 ; i < pointlist.size() ; ++i)
-  {
-    points.push_back(pointlist[i][0]);
-    points.push_back(pointlist[i][1]);
-  }
-
-  if (2 <= pointlist.size())
-    m_Context->DrawPoly(points.data(), pointlist.size());
+  return rightMostPoint;
+}
 
-  anchorPoint = rightMostPoint;
+void mitk::PlanarFigureMapper2D::PaintPolyLine(const std::vector<float> &displayPoints)
+{
+  // now paint all the points in one run
+  if (4 <= displayPoints.size())
+    m_Context->DrawPoly(const_cast<float *>(displayPoints.data()), static_cast<int>(displayPoints.size() / 2));
 }
 
-void mitk::PlanarFigureMapper2D::DrawMainLines(mitk::PlanarFigure *figure,
-                                               Point2D &anchorPoint,
-                                               const PlaneGeometry *planarFigurePlaneGeometry,
-                                               const PlaneGeometry *rendererPlaneGeometry,
-                                               const mitk::BaseRenderer *renderer)
+void mitk::PlanarFigureMapper2D::DrawMainLines(const ProjectedPolyLines &polyLines)
 {
-  const auto numberOfPolyLines = figure->GetPolyLinesSize();
-  for (auto loop = 0; loop < numberOfPolyLines; ++loop)
+  for (const auto &displayPoints : polyLines.DisplayPolyLines)
   {
-    const auto polyline = figure->GetPolyLine(loop);
-
-    this->PaintPolyLine(
-      polyline, figure->IsClosed(), anchorPoint, planarFigurePlaneGeometry, rendererPlaneGeometry, renderer);
+    this->PaintPolyLine(displayPoints);
   }
 }
 
-void mitk::PlanarFigureMapper2D::DrawHelperLines(mitk::PlanarFigure *figure,
-                                                 Point2D &anchorPoint,
-                                                 const PlaneGeometry *planarFigurePlaneGeometry,
-                                                 const PlaneGeometry *rendererPlaneGeometry,
-                                                 const mitk::BaseRenderer *renderer)
+void mitk::PlanarFigureMapper2D::DrawHelperLines(const ProjectedPolyLines &polyLines)
 {
-  const auto numberOfHelperPolyLines = figure->GetHelperPolyLinesSize();
-
   // Draw helper objects
-  for (unsigned int loop = 0; loop < numberOfHelperPolyLines; ++loop)
+  for (const auto &displayPoints : polyLines.DisplayHelperPolyLines)
   {
-    const auto helperPolyLine =
-      figure->GetHelperPolyLine(loop, renderer->GetScaleFactorMMPerDisplayUnit(), renderer->GetViewportSize()[1]);
-
-    // Check if the current helper objects is to be painted
-    if (!figure->IsHelperToBePainted(loop))
-    {
-      continue;
-    }
-
-    // ... and once normally above the shadow.
-    this->PaintPolyLine(helperPolyLine, false, anchorPoint, planarFigurePlaneGeometry, rendererPlaneGeometry, renderer);
+    this->PaintPolyLine(displayPoints);
   }
 }
 
@@ -850,9 +891,15 @@ void mitk::PlanarFigureMapper2D::RenderLines(const PlanarFigureDisplayMode lineD
                                              mitk::PlanarFigure *planarFigure,
                                              mitk::Point2D &anchorPoint,
                                              const mitk::PlaneGeometry *planarFigurePlaneGeometry,
-                                             const mitk::PlaneGeometry *rendererPlaneGeometry,
+                                             const mitk::PlaneGeometry * /*rendererPlaneGeometry*/,
                                              const mitk::BaseRenderer *renderer)
 {
+  // the polylines are projected once and drawn for the outline, shadow and main line
+  const ProjectedPolyLines &polyLines = this->UpdateProjectedPolyLines(planarFigure, planarFigurePlaneGeometry, renderer);
+
+  if (polyLines.HasAnchorPoint)
+    anchorPoint = polyLines.AnchorPoint;
+
   // If we want to draw an outline, we do it here
   if (m_DrawOutline)
   {
@@ -870,7 +917,7 @@ void mitk::PlanarFigureMapper2D::RenderLines(const PlanarFigureDisplayMode lineD
       this->m_Context->GetPen()->SetLineType(vtkPen::SOLID_LINE);
 
     // Draw the outline for all polylines if requested
-    this->DrawMainLines(planarFigure, anchorPoint, planarFigurePlaneGeometry, rendererPlaneGeometry, renderer);
+    this->DrawMainLines(polyLines);
 
     this->m_Context->GetPen()->SetWidth(m_HelperlineWidth);
 
@@ -880,7 +927,7 @@ void mitk::PlanarFigureMapper2D::RenderLines(const PlanarFigureDisplayMode lineD
       this->m_Context->GetPen()->SetLineType(vtkPen::SOLID_LINE);
 
     // Draw the outline for all helper objects if requested
-    this->DrawHelperLines(planarFigure, anchorPoint, planarFigurePlaneGeometry, rendererPlaneGeometry, renderer);
+    this->DrawHelperLines(polyLines);
   }
 
   // If we want to draw a shadow, we do it here
@@ -902,7 +949,7 @@ void mitk::PlanarFigureMapper2D::RenderLines(const PlanarFigureDisplayMode lineD
       this->m_Context->GetPen()->SetLineType(vtkPen::SOLID_LINE);
 
     // Draw the outline for all polylines if requested
-    this->DrawMainLines(planarFigure, anchorPoint, planarFigurePlaneGeometry, rendererPlaneGeometry, renderer);
+    this->DrawMainLines(polyLines);
 
     this->m_Context->GetPen()->SetWidth(m_HelperlineWidth);
 
@@ -912,7 +959,7 @@ void mitk::PlanarFigureMapper2D::RenderLines(const PlanarFigureDisplayMode lineD
       this->m_Context->GetPen()->SetLineType(vtkPen::SOLID_LINE);
 
     // Draw the outline for all helper objects if requested
-    this->DrawHelperLines(planarFigure, anchorPoint, planarFigurePlaneGeometry, rendererPlaneGeometry, renderer);
+    this->DrawHelperLines(polyLines);
   }
 
   // set this in brackets to avoid duplicate variables in the same scope
@@ -931,7 +978,7 @@ void mitk::PlanarFigureMapper2D::RenderLines(const PlanarFigureDisplayMode lineD
       this->m_Context->GetPen()->SetLineType(vtkPen::SOLID_LINE);
 
     // Draw the main line for all polylines
-    this->DrawMainLines(planarFigure, anchorPoint, planarFigurePlaneGeometry, rendererPlaneGeometry, renderer);
+    this->DrawMainLines(polyLines);
 
     const float *helperColor = m_HelperlineColor[lineDisplayMode];
     const float helperOpacity = m_HelperlineOpacity[lineDisplayMode];
@@ -947,7 +994,7 @@ void mitk::PlanarFigureMapper2D::RenderLines(const PlanarFigureDisplayMode lineD
 
 
     // Draw helper objects
-    this->DrawHelperLines(planarFigure, anchorPoint, planarFigurePlaneGeometry, rendererPlaneGeometry, renderer);
+    this->DrawHelperLines(polyLines);
   }
 
   if (m_DrawDashed || m_DrawHelperDashed)
@@ -22,8 +22,13 @@ found in the LICENSE file.
 #include <mitkImageReadAccessor.h>
 #include <mitkImageWriteAccessor.h>
 #include <QFileInfo>
+#include <QAbstractEventDispatcher>
 #include <QCoreApplication>
 #include <itksys/SystemTools.hxx>
+#include <itkCommand.h>
+
+#include <algorithm>
+#include <vector>
 
 #define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
 #include <numpy/arrayobject.h>
@@ -41,6 +46,12 @@ mitk::PythonService::PythonService()
   , m_OpenCVWrappingAvailable( true )
   , m_VtkWrappingAvailable( true )
   , m_ErrorOccured( false )
+  , m_NextJobId( 1 )
+  , m_RunningJobId( 0 )
+  , m_RunningJobCanceled( false )
+  , m_InterpreterThreadId( 0 )
+  , m_StopInterpreterThread( false )
+  , m_GUIThreadState( nullptr )
 {
   bool pythonInitialized = static_cast<bool>( Py_IsInitialized() ); //m_PythonManager.isPythonInitialized() );
 
@@ -84,6 +95,7 @@ mitk::PythonService::PythonService()
 mitk::PythonService::~PythonService()
 {
   MITK_DEBUG("mitk::PythonService") << "destructing PythonService";
+  this->StopInterpreterThread();
 }
 
 void mitk::PythonService::AddRelativeSearchDirs(std::vector< std::string > dirs)
@@ -130,6 +142,290 @@ std::string mitk::PythonService::Execute(const std::string &stdpythonCommand, in
   return result.toString().toStdString();
 }
 
+namespace
+{
+  /// progress callback of the job that is running in the interpreter thread
+  thread_local const mitk::PythonExecutionProgressCallback *CurrentProgressCallback = nullptr;
+  thread_local QObject *CurrentGUIThreadContext = nullptr;
+
+  /// mitk_report_progress(value, message=""): reports the progress of an asynchronously executed script
+  PyObject *ReportProgress(PyObject *, PyObject *args)
+  {
+    double progress = 0.0;
+    const char *message = "";
+    if (!PyArg_ParseTuple(args, "d|s", &progress, &message))
+      return nullptr;
+
+    if (nullptr != CurrentProgressCallback && *CurrentProgressCallback && nullptr != CurrentGUIThreadContext)
+    {
+      auto callback = *CurrentProgressCallback;
+      std::string messageString(message);
+      QMetaObject::invokeMethod(
+        CurrentGUIThreadContext, [callback, progress, messageString]() { callback(progress, messageString); }, Qt::QueuedConnection);
+    }
+
+    Py_RETURN_NONE;
+  }
+
+  PyMethodDef ReportProgressMethod = {
+    "mitk_report_progress", &ReportProgress, METH_VARARGS, "Reports the progress (0..1) of an asynchronously executed script."};
+
+  std::string PythonObjectToString(PyObject *object)
+  {
+    if (nullptr == object)
+      return std::string();
+
+    std::string result;
+    PyObject *string = PyObject_Str(object);
+    if (nullptr != string)
+    {
+      const char *utf8 = PyUnicode_AsUTF8(string);
+      if (nullptr != utf8)
+        result = utf8;
+      Py_DECREF(string);
+    }
+    PyErr_Clear();
+    return result;
+  }
+}
+
+unsigned long mitk::PythonService::ExecuteAsync(const std::string &pythonCommand,
+                                                int commandType,
+                                                PythonExecutionFinishedCallback finished,
+                                                PythonExecutionProgressCallback progress)
+{
+  this->StartInterpreterThread();
+
+  std::lock_guard<std::mutex> lock(m_JobMutex);
+  AsyncJob job;
+  job.m_Id = m_NextJobId++;
+  job.m_Command = pythonCommand;
+  job.m_CommandType = commandType;
+  job.m_Finished = finished;
+  job.m_Progress = progress;
+  m_Jobs.push_back(job);
+  m_JobCondition.notify_one();
+
+  return job.m_Id;
+}
+
+bool mitk::PythonService::CancelExecution(unsigned long jobId)
+{
+  {
+    std::unique_lock<std::mutex> lock(m_JobMutex);
+    for (auto iter = m_Jobs.begin(); iter != m_Jobs.end(); ++iter)
+    {
+      if (iter->m_Id == jobId)
+      {
+        AsyncJob job = *iter;
+        m_Jobs.erase(iter);
+        lock.unlock();
+
+        PythonExecutionResult result;
+        result.m_JobId = jobId;
+        result.m_Canceled = true;
+        this->FinishJob(job, result);
+        return true;
+      }
+    }
+  }
+
+  if (jobId == 0 || m_RunningJobId != jobId)
+    return false;
+
+  // the running job id only changes while the interpreter thread holds the interpreter lock,
+  // so it cannot change while the exception is set
+  const bool gilReleased = nullptr != m_GUIThreadState;
+  if (gilReleased)
+  {
+    PyEval_RestoreThread(m_GUIThreadState);
+    m_GUIThreadState = nullptr;
+  }
+
+  bool canceled = false;
+  if (m_RunningJobId == jobId)
+  {
+    m_RunningJobCanceled = true;
+    canceled = PyThreadState_SetAsyncExc(m_InterpreterThreadId, PyExc_KeyboardInterrupt) > 0;
+  }
+
+  if (gilReleased)
+    m_GUIThreadState = PyEval_SaveThread();
+
+  return canceled;
+}
+
+std::size_t mitk::PythonService::GetNumberOfPendingExecutions() const
+{
+  std::lock_guard<std::mutex> lock(m_JobMutex);
+  return m_Jobs.size() + (m_RunningJobId != 0 ? 1 : 0);
+}
+
+void mitk::PythonService::StartInterpreterThread()
+{
+  if (m_InterpreterThread.joinable())
+    return;
+
+  m_GUIThreadContext.reset(new QObject);
+
+#if PY_VERSION_HEX < 0x03070000
+  PyEval_InitThreads();
+#endif
+
+  PyObject *builtins = PyImport_AddModule("builtins");
+  PyObject *reportProgress = PyCFunction_New(&ReportProgressMethod, nullptr);
+  if (nullptr != builtins && nullptr != reportProgress)
+    PyObject_SetAttrString(builtins, ReportProgressMethod.ml_name, reportProgress);
+  Py_XDECREF(reportProgress);
+
+  // The GUI thread owns the interpreter lock (PythonQt does not release it). It is released while the
+  // event loop waits for events, so the interpreter thread runs while the GUI is idle, and taken back
+  // before any event is processed, so PythonQt, the console and the synchronous calls keep working.
+  auto dispatcher = QAbstractEventDispatcher::instance(QCoreApplication::instance()->thread());
+  if (nullptr != dispatcher)
+  {
+    QObject::connect(dispatcher, &QAbstractEventDispatcher::aboutToBlock, m_GUIThreadContext.get(), [this]() {
+      if (nullptr == m_GUIThreadState && this->GetNumberOfPendingExecutions() > 0)
+        m_GUIThreadState = PyEval_SaveThread();
+    });
+    QObject::connect(dispatcher, &QAbstractEventDispatcher::awake, m_GUIThreadContext.get(), [this]() {
+      if (nullptr != m_GUIThreadState)
+      {
+        PyEval_RestoreThread(m_GUIThreadState);
+        m_GUIThreadState = nullptr;
+      }
+    });
+  }
+
+  m_StopInterpreterThread = false;
+  m_InterpreterThread = std::thread(&PythonService::RunInterpreterThread, this);
+}
+
+void mitk::PythonService::StopInterpreterThread()
+{
+  if (!m_InterpreterThread.joinable())
+    return;
+
+  if (nullptr != m_GUIThreadState)
+  {
+    PyEval_RestoreThread(m_GUIThreadState);
+    m_GUIThreadState = nullptr;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_JobMutex);
+    m_StopInterpreterThread = true;
+    m_Jobs.clear();
+    m_JobCondition.notify_one();
+  }
+
+  if (m_RunningJobId != 0)
+  {
+    m_RunningJobCanceled = true;
+    PyThreadState_SetAsyncExc(m_InterpreterThreadId, PyExc_KeyboardInterrupt);
+  }
+
+  // the interpreter thread needs the interpreter lock to finish its job
+  Py_BEGIN_ALLOW_THREADS
+  m_InterpreterThread.join();
+  Py_END_ALLOW_THREADS
+
+  // drops all callbacks that are still queued to the GUI thread
+  m_GUIThreadContext.reset();
+}
+
+void mitk::PythonService::RunInterpreterThread()
+{
+  while (true)
+  {
+    AsyncJob job;
+    {
+      std::unique_lock<std::mutex> lock(m_JobMutex);
+      m_JobCondition.wait(lock, [this]() { return m_StopInterpreterThread || !m_Jobs.empty(); });
+      if (m_StopInterpreterThread)
+        return;
+
+      job = m_Jobs.front();
+      m_Jobs.pop_front();
+    }
+
+    const PythonExecutionResult result = this->RunJob(job);
+    this->FinishJob(job, result);
+  }
+}
+
+mitk::PythonExecutionResult mitk::PythonService::RunJob(const AsyncJob &job)
+{
+  PythonExecutionResult result;
+  result.m_JobId = job.m_Id;
+
+  int start = Py_file_input;
+  if (job.m_CommandType == IPythonService::SINGLE_LINE_COMMAND)
+    start = Py_single_input;
+  else if (job.m_CommandType == IPythonService::EVAL_COMMAND)
+    start = Py_eval_input;
+
+  PyGILState_STATE gilState = PyGILState_Ensure();
+  m_InterpreterThreadId = PyThreadState_Get()->thread_id;
+  m_RunningJobCanceled = false;
+  m_RunningJobId = job.m_Id;
+  CurrentProgressCallback = &job.m_Progress;
+  CurrentGUIThreadContext = m_GUIThreadContext.get();
+
+  PyObject *mainDict = PyModule_GetDict(PyImport_AddModule("__main__"));
+  PyObject *value = PyRun_String(job.m_Command.c_str(), start, mainDict, mainDict);
+
+  if (nullptr == value)
+  {
+    PyObject *type = nullptr;
+    PyObject *exception = nullptr;
+    PyObject *traceback = nullptr;
+    PyErr_Fetch(&type, &exception, &traceback);
+    PyErr_NormalizeException(&type, &exception, &traceback);
+
+    result.m_Canceled = m_RunningJobCanceled && PyErr_GivenExceptionMatches(type, PyExc_KeyboardInterrupt);
+    result.m_ErrorOccured = !result.m_Canceled;
+    result.m_ErrorMessage = std::string(reinterpret_cast<PyTypeObject *>(type)->tp_name) + ": " + PythonObjectToString(exception);
+
+    Py_XDECREF(type);
+    Py_XDECREF(exception);
+    Py_XDECREF(traceback);
+  }
+  else
+  {
+    if (value != Py_None)
+      result.m_Result = PythonObjectToString(value);
+    Py_DECREF(value);
+  }
+
+  CurrentProgressCallback = nullptr;
+  CurrentGUIThreadContext = nullptr;
+  // a cancellation that came too late must not interrupt the next job
+  PyThreadState_SetAsyncExc(m_InterpreterThreadId, nullptr);
+  m_RunningJobId = 0;
+  PyGILState_Release(gilState);
+
+  return result;
+}
+
+void mitk::PythonService::FinishJob(const AsyncJob &job, const PythonExecutionResult &result)
+{
+  if (nullptr == m_GUIThreadContext)
+    return;
+
+  auto finished = job.m_Finished;
+  auto command = job.m_Command;
+  QMetaObject::invokeMethod(
+    m_GUIThreadContext.get(),
+    [this, finished, command, result]() {
+      if (!result.m_Canceled)
+        this->NotifyObserver(command);
+      if (finished)
+        finished(result);
+    },
+    Qt::QueuedConnection);
+}
+
 void mitk::PythonService::ExecuteScript( const std::string& pythonScript )
 {
   std::ifstream t(pythonScript.c_str());
@@ -414,6 +710,138 @@ bool mitk::PythonService::CopyToPythonAsSimpleItkImage(mitk::Image *image, const
 }
 
 
+namespace
+{
+  const char *const SharedImageDataCapsuleName = "mitk.SharedImageData";
+
+  /// keeps the shared pixel buffer alive as long as the numpy array exists
+  struct SharedImageData
+  {
+    mitk::Image::Pointer Image;
+    mitk::Image::ImageDataItemPointer Data;
+    bool Writable;
+  };
+
+  void ReleaseSharedImageData(PyObject *capsule)
+  {
+    auto *shared = static_cast<SharedImageData *>(PyCapsule_GetPointer(capsule, SharedImageDataCapsuleName));
+    if (nullptr == shared)
+      return;
+
+    // the array may have been written to, so the data of the image has to be considered changed
+    if (shared->Writable)
+      shared->Image->Modified();
+
+    delete shared;
+  }
+
+  int ComponentTypeToNumpyType(int componentType)
+  {
+    switch (componentType)
+    {
+      case itk::ImageIOBase::DOUBLE: return NPY_DOUBLE;
+      case itk::ImageIOBase::FLOAT: return NPY_FLOAT;
+      case itk::ImageIOBase::SHORT: return NPY_SHORT;
+      case itk::ImageIOBase::CHAR: return NPY_BYTE;
+      case itk::ImageIOBase::INT: return NPY_INT;
+      case itk::ImageIOBase::LONG: return NPY_LONG;
+      case itk::ImageIOBase::UCHAR: return NPY_UBYTE;
+      case itk::ImageIOBase::UINT: return NPY_UINT;
+      case itk::ImageIOBase::ULONG: return NPY_ULONG;
+      case itk::ImageIOBase::USHORT: return NPY_USHORT;
+      default: return NPY_NOTYPE;
+    }
+  }
+
+  template <typename TComponent>
+  mitk::PixelType MakeNumpyPixelType(unsigned int numberOfComponents)
+  {
+    if (numberOfComponents == 1)
+      return mitk::MakeScalarPixelType<TComponent>();
+    return mitk::MakePixelType<TComponent, itk::VariableLengthVector<TComponent>>(numberOfComponents);
+  }
+
+  bool NumpyTypeToPixelType(int npyType, unsigned int numberOfComponents, mitk::PixelType &pixelType)
+  {
+    switch (npyType)
+    {
+      case NPY_DOUBLE: pixelType = MakeNumpyPixelType<double>(numberOfComponents); return true;
+      case NPY_FLOAT: pixelType = MakeNumpyPixelType<float>(numberOfComponents); return true;
+      case NPY_SHORT: pixelType = MakeNumpyPixelType<short>(numberOfComponents); return true;
+      case NPY_BYTE: pixelType = MakeNumpyPixelType<char>(numberOfComponents); return true;
+      case NPY_INT: pixelType = MakeNumpyPixelType<int>(numberOfComponents); return true;
+      case NPY_LONG: pixelType = MakeNumpyPixelType<long>(numberOfComponents); return true;
+      case NPY_UBYTE: pixelType = MakeNumpyPixelType<unsigned char>(numberOfComponents); return true;
+      case NPY_UINT: pixelType = MakeNumpyPixelType<unsigned int>(numberOfComponents); return true;
+      case NPY_ULONG: pixelType = MakeNumpyPixelType<unsigned long>(numberOfComponents); return true;
+      case NPY_USHORT: pixelType = MakeNumpyPixelType<unsigned short>(numberOfComponents); return true;
+      default: return false;
+    }
+  }
+
+  /// releases the reference to the numpy array, whose memory was referenced by the deleted image
+  void ReleaseNumpyArray(void *clientData)
+  {
+    auto *array = static_cast<PyObject *>(clientData);
+    if (!Py_IsInitialized())
+      return;
+
+    PyGILState_STATE gilState = PyGILState_Ensure();
+    Py_DECREF(array);
+    PyGILState_Release(gilState);
+  }
+
+  void ReleaseNumpyArrayOnDelete(itk::Object *, const itk::EventObject &, void *clientData)
+  {
+    ReleaseNumpyArray(clientData);
+  }
+
+  /// creates an image that references the memory of the array and holds a reference to the array until it is deleted
+  mitk::Image::Pointer ReferenceNumpyArray(PyArrayObject *array, unsigned int numberOfComponents)
+  {
+    // owns a reference, either to the array itself or to its contiguous copy
+    PyArrayObject *contiguousArray = reinterpret_cast<PyArrayObject *>(PyArray_FROM_OF(
+      reinterpret_cast<PyObject *>(array), NPY_ARRAY_C_CONTIGUOUS | NPY_ARRAY_ALIGNED | NPY_ARRAY_NOTSWAPPED));
+    if (nullptr == contiguousArray)
+    {
+      PyErr_Clear();
+      return nullptr;
+    }
+
+    const int numpyDimensions = PyArray_NDIM(contiguousArray);
+    const int imageDimension = numberOfComponents > 1 ? numpyDimensions - 1 : numpyDimensions;
+    mitk::PixelType pixelType = mitk::MakeScalarPixelType<char>();
+    if (imageDimension < 2 || imageDimension > 4 ||
+        (numberOfComponents > 1 && PyArray_DIMS(contiguousArray)[numpyDimensions - 1] != numberOfComponents) ||
+        !NumpyTypeToPixelType(PyArray_TYPE(contiguousArray), numberOfComponents, pixelType))
+    {
+      MITK_WARN("PythonService") << "Numpy array with " << numpyDimensions << " dimensions and type "
+                                 << PyArray_TYPE(contiguousArray) << " cannot be imported as image with "
+                                 << numberOfComponents << " components.";
+      Py_DECREF(contiguousArray);
+      return nullptr;
+    }
+
+    std::vector<unsigned int> dimensions(imageDimension);
+    // numpy arrays store the dimensions in opposite order
+    for (int i = 0; i < imageDimension; ++i)
+    {
+      dimensions[i] = static_cast<unsigned int>(PyArray_DIMS(contiguousArray)[imageDimension - 1 - i]);
+    }
+
+    auto image = mitk::Image::New();
+    image->Initialize(pixelType, imageDimension, dimensions.data());
+    image->SetImportChannel(PyArray_DATA(contiguousArray), 0, mitk::Image::ReferenceMemory);
+
+    auto command = itk::CStyleCommand::New();
+    command->SetClientData(contiguousArray);
+    command->SetCallback(&ReleaseNumpyArrayOnDelete);
+    image->AddObserver(itk::DeleteEvent(), command);
+
+    return image;
+  }
+}
+
 mitk::PixelType DeterminePixelType(const std::string& pythonPixeltype, unsigned long nrComponents, int dimensions)
 {
   typedef itk::RGBPixel< unsigned char > UCRGBPixelType;
@@ -537,6 +965,7 @@ mitk::Image::Pointer mitk::PythonService::CopySimpleItkImageFromPython(const std
   MITK_DEBUG("PythonService") << "Issuing python command " << command.toStdString();
   this->Execute(command.toStdString(), IPythonService::MULTI_LINE_COMMAND );
 
+  import_array1 (nullptr);
   PyObject* py_dtype = PyDict_GetItemString(pyDict,QString("%1_dtype").arg(varName).toStdString().c_str() );
   std::string dtype = PyString_AsString(py_dtype);
   PyArrayObject* py_data = (PyArrayObject*) PyDict_GetItemString(pyDict,QString("%1_numpy_array").arg(varName).toStdString().c_str() );
@@ -563,10 +992,17 @@ mitk::Image::Pointer mitk::PythonService::CopySimpleItkImageFromPython(const std
     dimensions[i] = PyArray_DIMS(py_data)[nr_dimensions - 1 - i];
   }
 
-  mitkImage->Initialize(pixelType, nr_dimensions, dimensions);
-
-
-  mitkImage->SetChannel(PyArray_DATA(py_data));
+  // the array was already copied by GetArrayFromImage, so the image references it instead of copying it again
+  if (nr_Components == 1)
+  {
+    mitkImage = ReferenceNumpyArray(py_data, nr_Components);
+  }
+  if (mitkImage.IsNull())
+  {
+    mitkImage = mitk::Image::New();
+    mitkImage->Initialize(pixelType, nr_dimensions, dimensions);
+    mitkImage->SetChannel(PyArray_DATA(py_data));
+  }
 
 
   ds = reinterpret_cast<double*>(PyArray_DATA(py_spacing));
@@ -627,6 +1063,89 @@ mitk::Image::Pointer mitk::PythonService::CopySimpleItkImageFromPython(const std
   return mitkImage;
 }
 
+bool mitk::PythonService::ShareWithPythonAsNumpyArray(mitk::Image *image, const std::string &stdvarName, bool writable)
+{
+  if (nullptr == image || !image->IsInitialized())
+    return false;
+
+  const mitk::PixelType pixelType = image->GetPixelType();
+  const int npyType = ComponentTypeToNumpyType(pixelType.GetComponentType());
+  if (npyType == NPY_NOTYPE)
+  {
+    MITK_WARN("PythonService") << "Pixel type " << pixelType.GetPixelTypeAsString() << " cannot be shared with python.";
+    return false;
+  }
+
+  auto *shared = new SharedImageData;
+  shared->Image = image;
+  shared->Data = image->GetChannelData();
+  shared->Writable = writable;
+  // the data item is kept alive by the capsule, the lock would block writers as long as python holds the array
+  mitk::ImageReadAccessor accessor(image, shared->Data, mitk::ImageAccessorBase::IgnoreLock);
+  void *data = const_cast<void *>(accessor.GetData());
+
+  // numpy arrays store the dimensions in opposite order, the components are the innermost axis
+  std::vector<npy_intp> shape;
+  for (int i = static_cast<int>(image->GetDimension()) - 1; i >= 0; --i)
+  {
+    shape.push_back(image->GetDimension(i));
+  }
+  if (pixelType.GetNumberOfComponents() > 1)
+    shape.push_back(pixelType.GetNumberOfComponents());
+
+  import_array1 (false);
+  const int flags = writable ? NPY_ARRAY_CARRAY : NPY_ARRAY_CARRAY_RO;
+  PyObject *npyArray = PyArray_New(&PyArray_Type, static_cast<int>(shape.size()), shape.data(), npyType, nullptr, data, 0, flags, nullptr);
+  if (nullptr == npyArray)
+  {
+    PyErr_Clear();
+    delete shared;
+    return false;
+  }
+
+  PyObject *capsule = PyCapsule_New(shared, SharedImageDataCapsuleName, &ReleaseSharedImageData);
+  if (nullptr == capsule || PyArray_SetBaseObject(reinterpret_cast<PyArrayObject *>(npyArray), capsule) != 0)
+  {
+    // without base object the capsule is released here and frees the shared data
+    PyErr_Clear();
+    Py_XDECREF(capsule);
+    if (nullptr == capsule)
+      delete shared;
+    Py_DECREF(npyArray);
+    return false;
+  }
+
+  PyObject *pyMod = PyImport_AddModule("__main__");
+  PyObject *pyDict = PyModule_GetDict(pyMod);
+  const int status = PyDict_SetItemString(pyDict, stdvarName.c_str(), npyArray);
+  Py_DECREF(npyArray);
+
+  return status == 0;
+}
+
+mitk::Image::Pointer mitk::PythonService::ImportNumpyArrayFromPython(const std::string &stdvarName,
+                                                                     unsigned int numberOfComponents,
+                                                                     const mitk::BaseGeometry *geometry)
+{
+  PyObject *pyMod = PyImport_AddModule("__main__");
+  PyObject *pyDict = PyModule_GetDict(pyMod);
+  PyObject *pyObject = PyDict_GetItemString(pyDict, stdvarName.c_str());
+
+  import_array1 (nullptr);
+  if (nullptr == pyObject || !PyArray_Check(pyObject))
+  {
+    MITK_WARN("PythonService") << "Variable " << stdvarName << " is not a numpy array.";
+    return nullptr;
+  }
+
+  auto image = ReferenceNumpyArray(reinterpret_cast<PyArrayObject *>(pyObject), std::max(numberOfComponents, 1u));
+  if (image.IsNotNull() && nullptr != geometry)
+  {
+    image->SetGeometry(geometry->Clone());
+  }
+  return image;
+}
+
 bool mitk::PythonService::CopyToPythonAsCvImage( mitk::Image* image, const std::string& stdvarName )
 {
   QString varName = QString::fromStdString( stdvarName );
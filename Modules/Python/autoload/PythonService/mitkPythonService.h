@@ -17,6 +17,17 @@ found in the LICENSE file.
 #include <itkLightObject.h>
 #include "mitkSurface.h"
 
+#include <QObject>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+struct _ts;
+
 namespace mitk
 {
   ///
@@ -35,6 +46,17 @@ namespace mitk
       /// \see IPythonService::Execute()
       std::string Execute( const std::string& pythonCommand, int commandType = SINGLE_LINE_COMMAND ) override;
       ///
+      /// \see IPythonService::ExecuteAsync()
+      unsigned long ExecuteAsync( const std::string& pythonCommand, int commandType,
+                                  PythonExecutionFinishedCallback finished,
+                                  PythonExecutionProgressCallback progress = nullptr ) override;
+      ///
+      /// \see IPythonService::CancelExecution()
+      bool CancelExecution( unsigned long jobId ) override;
+      ///
+      /// \see IPythonService::GetNumberOfPendingExecutions()
+      std::size_t GetNumberOfPendingExecutions() const override;
+      ///
       /// \see IPythonService::ExecuteScript()
       void ExecuteScript(const std::string &pathToPythonScript) override;
       ///
@@ -68,6 +90,12 @@ namespace mitk
       /// \see IPythonService::CopyItkImageFromPython()
       mitk::Image::Pointer CopySimpleItkImageFromPython( const std::string& varName ) override;
       ///
+      /// \see IPythonService::ShareWithPythonAsNumpyArray()
+      bool ShareWithPythonAsNumpyArray( mitk::Image* image, const std::string& varName, bool writable = false ) override;
+      ///
+      /// \see IPythonService::ImportNumpyArrayFromPython()
+      mitk::Image::Pointer ImportNumpyArrayFromPython( const std::string& varName, unsigned int numberOfComponents = 1, const mitk::BaseGeometry* geometry = nullptr ) override;
+      ///
       /// \see IPythonService::IsOpenCvPythonWrappingAvailable()
       bool IsOpenCvPythonWrappingAvailable() override;
       ///
@@ -96,12 +124,45 @@ namespace mitk
   protected:
 
   private:
+      struct AsyncJob
+      {
+        unsigned long m_Id;
+        std::string m_Command;
+        int m_CommandType;
+        PythonExecutionFinishedCallback m_Finished;
+        PythonExecutionProgressCallback m_Progress;
+      };
+
+      /// starts the interpreter thread and the release of the global interpreter lock in the idle GUI thread
+      void StartInterpreterThread();
+      void StopInterpreterThread();
+      void RunInterpreterThread();
+      /// executes the job with the global interpreter lock held
+      PythonExecutionResult RunJob(const AsyncJob& job);
+      /// calls the finished callback and the observers in the GUI thread
+      void FinishJob(const AsyncJob& job, const PythonExecutionResult& result);
+
       QList<PythonCommandObserver*> m_Observer;
       ctkAbstractPythonManager m_PythonManager;
       bool m_ItkWrappingAvailable;
       bool m_OpenCVWrappingAvailable;
       bool m_VtkWrappingAvailable;
       bool m_ErrorOccured;
+
+      std::thread m_InterpreterThread;
+      mutable std::mutex m_JobMutex;
+      std::condition_variable m_JobCondition;
+      std::deque<AsyncJob> m_Jobs;
+      unsigned long m_NextJobId;
+      /// id of the running job, only changed by the interpreter thread while it holds the global interpreter lock
+      std::atomic<unsigned long> m_RunningJobId;
+      std::atomic<bool> m_RunningJobCanceled;
+      unsigned long m_InterpreterThreadId;
+      bool m_StopInterpreterThread;
+      /// receives the callbacks that are queued to the GUI thread, they are dropped when the service is destroyed
+      std::unique_ptr<QObject> m_GUIThreadContext;
+      /// thread state of the GUI thread while it released the global interpreter lock
+      _ts* m_GUIThreadState;
   };
 }
 #endif
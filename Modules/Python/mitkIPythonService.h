@@ -18,6 +18,7 @@ found in the LICENSE file.
 //for microservices
 #include <mitkServiceInterface.h>
 #include "mitkSurface.h"
+#include <functional>
 #include <vector>
 
 
@@ -46,6 +47,23 @@ namespace mitk
       virtual void CommandExecuted(const std::string& pythonCommand) = 0;
     };
 
+    ///
+    /// result of a command that was executed by IPythonService::ExecuteAsync()
+    ///
+    struct PythonExecutionResult
+    {
+      unsigned long m_JobId = 0;
+      /// the return value as string (for EVAL_COMMAND)
+      std::string m_Result;
+      bool m_ErrorOccured = false;
+      std::string m_ErrorMessage;
+      /// true if the job was canceled, before or while it was running
+      bool m_Canceled = false;
+    };
+
+    typedef std::function<void(const PythonExecutionResult &)> PythonExecutionFinishedCallback;
+    typedef std::function<void(double progress, const std::string &message)> PythonExecutionProgressCallback;
+
     ///
     /// The central service for issuing Python Code
     /// The class also enables to transfer mitk images to python as itk::Image and vice versa
@@ -72,6 +90,23 @@ namespace mitk
         /// \return A variant containing the return value as string of the python code (if any)
         virtual std::string Execute( const std::string& pythonCommand, int commandType = SINGLE_LINE_COMMAND ) = 0;
         ///
+        /// Queues a python command for execution on the interpreter thread and returns immediately.
+        /// The jobs are executed one after another. Both callbacks are called in the GUI thread.
+        /// Scripts report their progress by calling mitk_report_progress(value, message) with a value in [0, 1].
+        /// The GUI thread only holds the global interpreter lock while it processes events, so synchronous
+        /// calls and the python console stay usable while a job is running.
+        /// \return the id of the job, see CancelExecution()
+        virtual unsigned long ExecuteAsync( const std::string& pythonCommand, int commandType,
+                                            PythonExecutionFinishedCallback finished,
+                                            PythonExecutionProgressCallback progress = nullptr ) = 0;
+        ///
+        /// Removes a queued job or interrupts the running job by raising a KeyboardInterrupt in its script.
+        /// \return false if the job is unknown or already finished
+        virtual bool CancelExecution( unsigned long jobId ) = 0;
+        ///
+        /// \return the number of queued and running jobs
+        virtual std::size_t GetNumberOfPendingExecutions() const = 0;
+        ///
         /// Executes a python script.
         virtual void ExecuteScript( const std::string& pathToPythonScript ) = 0;
         ///
@@ -112,6 +147,20 @@ namespace mitk
         /// \return the image or 0 if copying was not possible
         virtual mitk::Image::Pointer CopySimpleItkImageFromPython( const std::string& varName ) = 0;
 
+        ///
+        /// exposes the pixel buffer of an mitk image as numpy array named "varName" without copying it
+        /// the array has the shape ([t,] [z,] y, x [, components]) and keeps the image data alive as long as it exists
+        /// if writable is false, the array is read-only; otherwise changes are written directly into the image,
+        /// which is marked as modified when the array is released
+        /// \return true if the array was created, else false
+        virtual bool ShareWithPythonAsNumpyArray( mitk::Image* image, const std::string& varName, bool writable = false ) = 0;
+        ///
+        /// creates an mitk image that references the memory of the numpy array named "varName" without copying it
+        /// (the array is copied once if it is not C-contiguous and aligned). The array is kept alive as long as the image exists.
+        /// the last axis holds the components if numberOfComponents is larger than 1, the geometry is taken from geometry if given
+        /// \return the image or nullptr if the array could not be imported
+        virtual mitk::Image::Pointer ImportNumpyArrayFromPython( const std::string& varName, unsigned int numberOfComponents = 1, const mitk::BaseGeometry* geometry = nullptr ) = 0;
+
         ///
         /// \return true, if OpenCv wrapping is available, false otherwise
         virtual bool IsOpenCvPythonWrappingAvailable() = 0;
@@ -26,9 +26,13 @@ found in the LICENSE file.
 
 #include <QList>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 class QmitkDataStorageTreeModelInternalItem;
+class QmitkNodeDescriptor;
+class QTimer;
 
 /** \ingroup QmitkModule
  @warning This class causes invalid point exception when used with invalid QModelIndex instances.
@@ -121,12 +125,21 @@ public:
   ///
   virtual void AddNode(const mitk::DataNode *node);
   ///
+  /// Adds all nodes that were added to the DataStorage during a batch (see mitk::DataStorage::BeginBatch()) in one
+  /// model reset instead of inserting the rows one by one. The following AddNode() calls for these nodes are ignored.
+  ///
+  virtual void AddNodes(const mitk::DataStorage::SetOfObjects *nodes);
+  ///
   /// Removes a node from this model. Also removes any event listener from the node.
   ///
   virtual void RemoveNode(const mitk::DataNode *node);
   ///
   /// Sets a node to modfified. Called by the DataStorage
   ///
+  /// The modified nodes are collected and checked together after a short delay, so that frequent property changes
+  /// (e.g. while dragging the level window) are coalesced. dataChanged is only emitted for the roles whose values
+  /// changed, i.e. not at all for property changes that are not shown by the model.
+  ///
   virtual void SetNodeModified(const mitk::DataNode *node);
 
   ///
@@ -158,6 +171,10 @@ protected:
   ///
   TreeItem *TreeItemFromIndex(const QModelIndex &index) const;
   ///
+  /// Returns the tree item of the node or nullptr if the node is not part of the model (constant time)
+  ///
+  TreeItem *FindTreeItem(const mitk::DataNode *node) const;
+  ///
   /// Gives a ModelIndex for the Tree Item
   ///
   QModelIndex IndexFromTreeItem(TreeItem *) const;
@@ -196,14 +213,42 @@ protected:
   bool m_AllowHierarchyChange;
 
 private:
-  void AddNodeInternal(const mitk::DataNode *);
+  ///
+  /// Adds a node to the tree. If resetting is true, the caller encloses the insertion in a model reset, so no row
+  /// insertion is signalled and the layers are not adjusted.
+  ///
+  void AddNodeInternal(const mitk::DataNode *, bool resetting = false);
   void RemoveNodeInternal(const mitk::DataNode *);
   ///
   /// Checks if dicom properties patient name, study names and series name exists
   ///
   bool DicomPropertiesExists(const mitk::DataNode &) const;
+  ///
+  /// Emits dataChanged for the collected modified nodes with the roles whose values changed
+  ///
+  void UpdateModifiedNodes();
+
+  /// The values of a node shown by the model, to find out which roles changed
+  struct NodeDisplayState
+  {
+    std::string name;
+    bool visible;
+    QmitkNodeDescriptor *descriptor;
+  };
+
+  struct NodeEntry
+  {
+    TreeItem *item;
+    NodeDisplayState state;
+  };
+
+  static NodeDisplayState GetDisplayState(const mitk::DataNode *node);
 
   unsigned long m_DataStorageDeletedTag;
+
+  std::unordered_map<const mitk::DataNode *, NodeEntry> m_NodeEntries;
+  std::unordered_set<const mitk::DataNode *> m_ModifiedNodes;
+  QTimer *m_ModifiedNodesTimer;
 };
 
 #endif /* QMITKDATASTORAGETREEMODEL_H_ */
@@ -112,6 +112,19 @@ public:
 
   using mitk::IOUtil::Load;
 
+  /**
+   * @brief Loads the specified files into the data storage, reading several files concurrently.
+   *
+   * Dialog boxes for further user input are shown before the files are read.
+   * @see mitk::IOUtil::LoadConcurrently()
+   */
+  static mitk::DataStorage::SetOfObjects::Pointer LoadConcurrently(const QStringList &paths,
+                                                                   mitk::DataStorage &storage,
+                                                                   unsigned int numberOfThreads = 0,
+                                                                   QWidget *parent = nullptr);
+
+  using mitk::IOUtil::LoadConcurrently;
+
   static QString Save(const mitk::BaseData *data,
                       const QString &defaultBaseName,
                       const QString &defaultPath = QString(),
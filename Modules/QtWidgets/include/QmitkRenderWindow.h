@@ -24,6 +24,8 @@ found in the LICENSE file.
 #include "mitkBaseRenderer.h"
 #include "mitkInteractionEventConst.h"
 
+#include <memory>
+
 class QDragEnterEvent;
 class QDropEvent;
 class QInputEvent;
@@ -137,6 +139,9 @@ private Q_SLOTS:
 
   void DeferredHideMenu();
 
+  /// \brief Processes the latest of the mouse move events which arrived since the last call.
+  void ProcessPendingMouseMoveEvent();
+
 private:
   // Helper Functions to Convert Qt-Events to Mitk-Events
 
@@ -159,6 +164,8 @@ private:
 
   vtkSmartPointer<vtkGenericOpenGLRenderWindow> m_InternalRenderWindow;
 
+  std::unique_ptr<QMouseEvent> m_PendingMouseMoveEvent;
+
 };
 
 #endif // QMITKRENDERWINDOW_H
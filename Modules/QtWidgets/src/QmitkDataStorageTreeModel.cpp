@@ -34,6 +34,7 @@ found in the LICENSE file.
 #include <QIcon>
 #include <QMimeData>
 #include <QTextStream>
+#include <QTimer>
 
 #include <map>
 
@@ -47,8 +48,14 @@ QmitkDataStorageTreeModel::QmitkDataStorageTreeModel(mitk::DataStorage *_DataSto
     m_PlaceNewNodesOnTop(_PlaceNewNodesOnTop),
     m_Root(nullptr),
     m_BlockDataStorageEvents(false),
-    m_AllowHierarchyChange(false)
+    m_AllowHierarchyChange(false),
+    m_ModifiedNodesTimer(new QTimer(this))
 {
+  // modified nodes are updated at most every 100 ms
+  m_ModifiedNodesTimer->setSingleShot(true);
+  m_ModifiedNodesTimer->setInterval(100);
+  connect(m_ModifiedNodesTimer, &QTimer::timeout, this, &QmitkDataStorageTreeModel::UpdateModifiedNodes);
+
   this->SetDataStorage(_DataStorage);
 }
 
@@ -131,6 +138,13 @@ QmitkDataStorageTreeModel::TreeItem *QmitkDataStorageTreeModel::TreeItemFromInde
   else
     return m_Root;
 }
+
+QmitkDataStorageTreeModel::TreeItem *QmitkDataStorageTreeModel::FindTreeItem(const mitk::DataNode *node) const
+{
+  auto entry = m_NodeEntries.find(node);
+  return entry != m_NodeEntries.end() ? entry->second.item : nullptr;
+}
+
 Qt::DropActions QmitkDataStorageTreeModel::supportedDropActions() const
 {
   return Qt::CopyAction | Qt::MoveAction;
@@ -522,6 +536,10 @@ void QmitkDataStorageTreeModel::SetDataStorage(mitk::DataStorage *_DataStorage)
       dataStorage->RemoveNodeEvent.RemoveListener(
         mitk::MessageDelegate1<QmitkDataStorageTreeModel, const mitk::DataNode *>(
           this, &QmitkDataStorageTreeModel::RemoveNode));
+
+      dataStorage->AddNodesEvent.RemoveListener(
+        mitk::MessageDelegate1<QmitkDataStorageTreeModel, const mitk::DataStorage::SetOfObjects *>(
+          this, &QmitkDataStorageTreeModel::AddNodes));
     }
 
     this->beginResetModel();
@@ -530,6 +548,9 @@ void QmitkDataStorageTreeModel::SetDataStorage(mitk::DataStorage *_DataStorage)
     m_DataStorage = _DataStorage;
 
     // delete the old root (if necessary, create new)
+    m_NodeEntries.clear();
+    m_ModifiedNodes.clear();
+    m_ModifiedNodesTimer->stop();
     if (m_Root)
       m_Root->Delete();
     mitk::DataNode::Pointer rootDataNode = mitk::DataNode::New();
@@ -556,6 +577,10 @@ void QmitkDataStorageTreeModel::SetDataStorage(mitk::DataStorage *_DataStorage)
         mitk::MessageDelegate1<QmitkDataStorageTreeModel, const mitk::DataNode *>(
           this, &QmitkDataStorageTreeModel::RemoveNode));
 
+      dataStorage->AddNodesEvent.AddListener(
+        mitk::MessageDelegate1<QmitkDataStorageTreeModel, const mitk::DataStorage::SetOfObjects *>(
+          this, &QmitkDataStorageTreeModel::AddNodes));
+
       // finally add all nodes to the model
       this->Update();
     }
@@ -569,9 +594,9 @@ void QmitkDataStorageTreeModel::SetDataStorageDeleted()
   this->SetDataStorage(nullptr);
 }
 
-void QmitkDataStorageTreeModel::AddNodeInternal(const mitk::DataNode *node)
+void QmitkDataStorageTreeModel::AddNodeInternal(const mitk::DataNode *node, bool resetting)
 {
-  if (node == nullptr || m_DataStorage.IsExpired() || !m_DataStorage.Lock()->Exists(node) || m_Root->Find(node) != nullptr)
+  if (node == nullptr || m_DataStorage.IsExpired() || !m_DataStorage.Lock()->Exists(node) || this->FindTreeItem(node) != nullptr)
     return;
 
   // find out if we have a root node
@@ -581,11 +606,14 @@ void QmitkDataStorageTreeModel::AddNodeInternal(const mitk::DataNode *node)
 
   if (parentDataNode) // no top level data node
   {
-    parentTreeItem = m_Root->Find(parentDataNode); // find the corresponding tree item
+    parentTreeItem = this->FindTreeItem(parentDataNode); // find the corresponding tree item
     if (!parentTreeItem)
     {
-      this->AddNode(parentDataNode);
-      parentTreeItem = m_Root->Find(parentDataNode);
+      if (resetting)
+        this->AddNodeInternal(parentDataNode, true);
+      else
+        this->AddNode(parentDataNode);
+      parentTreeItem = this->FindTreeItem(parentDataNode);
       if (!parentTreeItem)
         return;
     }
@@ -594,12 +622,16 @@ void QmitkDataStorageTreeModel::AddNodeInternal(const mitk::DataNode *node)
     index = this->createIndex(parentTreeItem->GetIndex(), 0, parentTreeItem);
   }
 
+  auto treeItem = new TreeItem(const_cast<mitk::DataNode *>(node));
+  m_NodeEntries[node] = { treeItem, GetDisplayState(node) };
+
   // add node
   if (m_PlaceNewNodesOnTop)
   {
     // emit beginInsertRows event
-    beginInsertRows(index, 0, 0);
-    parentTreeItem->InsertChild(new TreeItem(const_cast<mitk::DataNode *>(node)), 0);
+    if (!resetting)
+      beginInsertRows(index, 0, 0);
+    parentTreeItem->InsertChild(treeItem, 0);
   }
   else
   {
@@ -619,10 +651,14 @@ void QmitkDataStorageTreeModel::AddNodeInternal(const mitk::DataNode *node)
       }
       ++firstRowWithASiblingBelow;
     }
-    beginInsertRows(index, firstRowWithASiblingBelow, firstRowWithASiblingBelow);
-    parentTreeItem->InsertChild(new TreeItem(const_cast<mitk::DataNode*>(node)), firstRowWithASiblingBelow);
+    if (!resetting)
+      beginInsertRows(index, firstRowWithASiblingBelow, firstRowWithASiblingBelow);
+    parentTreeItem->InsertChild(treeItem, firstRowWithASiblingBelow);
   }
 
+  if (resetting)
+    return;
+
   // emit endInsertRows event
   endInsertRows();
 
@@ -635,12 +671,32 @@ void QmitkDataStorageTreeModel::AddNodeInternal(const mitk::DataNode *node)
 void QmitkDataStorageTreeModel::AddNode(const mitk::DataNode *node)
 {
   if (node == nullptr || m_BlockDataStorageEvents || m_DataStorage.IsExpired() || !m_DataStorage.Lock()->Exists(node) ||
-      m_Root->Find(node) != nullptr)
+      this->FindTreeItem(node) != nullptr)
     return;
 
   this->AddNodeInternal(node);
 }
 
+void QmitkDataStorageTreeModel::AddNodes(const mitk::DataStorage::SetOfObjects *nodes)
+{
+  if (nodes == nullptr || nodes->empty() || m_BlockDataStorageEvents || m_DataStorage.IsExpired())
+    return;
+
+  this->beginResetModel();
+
+  for (const auto &node : *nodes)
+  {
+    this->AddNodeInternal(node, true);
+  }
+
+  if (m_PlaceNewNodesOnTop)
+  {
+    this->AdjustLayerProperty();
+  }
+
+  this->endResetModel();
+}
+
 void QmitkDataStorageTreeModel::SetPlaceNewNodesOnTop(bool _PlaceNewNodesOnTop)
 {
   m_PlaceNewNodesOnTop = _PlaceNewNodesOnTop;
@@ -651,10 +707,13 @@ void QmitkDataStorageTreeModel::RemoveNodeInternal(const mitk::DataNode *node)
   if (!m_Root)
     return;
 
-  TreeItem *treeItem = m_Root->Find(node);
+  TreeItem *treeItem = this->FindTreeItem(node);
   if (!treeItem)
     return; // return because there is no treeitem containing this node
 
+  m_NodeEntries.erase(node);
+  m_ModifiedNodes.erase(node);
+
   TreeItem *parentTreeItem = treeItem->GetParent();
   QModelIndex parentIndex = this->IndexFromTreeItem(parentTreeItem);
 
@@ -694,20 +753,55 @@ void QmitkDataStorageTreeModel::RemoveNode(const mitk::DataNode *node)
 
 void QmitkDataStorageTreeModel::SetNodeModified(const mitk::DataNode *node)
 {
-  TreeItem *treeItem = m_Root->Find(node);
-  if (treeItem)
+  if (m_NodeEntries.find(node) == m_NodeEntries.end())
+    return;
+
+  m_ModifiedNodes.insert(node);
+  if (!m_ModifiedNodesTimer->isActive())
+    m_ModifiedNodesTimer->start();
+}
+
+void QmitkDataStorageTreeModel::UpdateModifiedNodes()
+{
+  auto modifiedNodes = std::move(m_ModifiedNodes);
+  m_ModifiedNodes.clear();
+
+  for (auto node : modifiedNodes)
   {
-    TreeItem *parentTreeItem = treeItem->GetParent();
-    // as the root node should not be removed one should always have a parent item
-    if (!parentTreeItem)
-      return;
-    QModelIndex index = this->createIndex(treeItem->GetIndex(), 0, treeItem);
+    auto entry = m_NodeEntries.find(node);
+    if (entry == m_NodeEntries.end())
+      continue;
+
+    NodeDisplayState state = GetDisplayState(node);
+    NodeDisplayState &oldState = entry->second.state;
 
-    // now emit the dataChanged signal
-    emit dataChanged(index, index);
+    QVector<int> roles;
+    if (state.name != oldState.name)
+      roles << Qt::DisplayRole << Qt::ToolTipRole << Qt::EditRole;
+    if (state.visible != oldState.visible)
+      roles << Qt::CheckStateRole;
+    if (state.descriptor != oldState.descriptor)
+      roles << Qt::DecorationRole;
+
+    oldState = state;
+
+    if (!roles.isEmpty())
+    {
+      QModelIndex index = this->IndexFromTreeItem(entry->second.item);
+      emit dataChanged(index, index, roles);
+    }
   }
 }
 
+QmitkDataStorageTreeModel::NodeDisplayState QmitkDataStorageTreeModel::GetDisplayState(const mitk::DataNode *node)
+{
+  NodeDisplayState state;
+  state.name = node->GetName();
+  state.visible = node->IsVisible(nullptr);
+  state.descriptor = QmitkNodeDescriptorManager::GetInstance()->GetDescriptor(node);
+  return state;
+}
+
 mitk::DataNode *QmitkDataStorageTreeModel::GetParentNode(const mitk::DataNode *node) const
 {
   mitk::DataNode *dataNode = nullptr;
@@ -820,12 +914,10 @@ void QmitkDataStorageTreeModel::TreeToNodeSet(TreeItem *parent, QList<mitk::Data
 
 QModelIndex QmitkDataStorageTreeModel::GetIndex(const mitk::DataNode *node) const
 {
-  if (m_Root)
-  {
-    TreeItem *item = m_Root->Find(node);
-    if (item)
-      return this->IndexFromTreeItem(item);
-  }
+  TreeItem *item = this->FindTreeItem(node);
+  if (item)
+    return this->IndexFromTreeItem(item);
+
   return QModelIndex();
 }
 
@@ -863,9 +955,10 @@ void QmitkDataStorageTreeModel::Update()
     bool newNodesWereToBePlacedOnTop = m_PlaceNewNodesOnTop;
     m_PlaceNewNodesOnTop = false;
 
+    // Update() is called during a model reset, so the single insertions need not be signalled.
     for (const auto& node : *_NodeSet)
     {
-      this->AddNodeInternal(node);
+      this->AddNodeInternal(node, true);
     }
 
     m_PlaceNewNodesOnTop = newNodesWereToBePlacedOnTop;
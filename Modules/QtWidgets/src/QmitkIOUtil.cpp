@@ -195,6 +195,27 @@ mitk::DataStorage::SetOfObjects::Pointer QmitkIOUtil::Load(const QStringList &pa
   return nodeResult;
 }
 
+mitk::DataStorage::SetOfObjects::Pointer QmitkIOUtil::LoadConcurrently(const QStringList &paths,
+                                                                       mitk::DataStorage &storage,
+                                                                       unsigned int numberOfThreads,
+                                                                       QWidget *parent)
+{
+  std::vector<LoadInfo> loadInfos;
+  foreach (const QString &file, paths)
+  {
+    loadInfos.push_back(LoadInfo(file.toLocal8Bit().constData()));
+  }
+
+  mitk::DataStorage::SetOfObjects::Pointer nodeResult = mitk::DataStorage::SetOfObjects::New();
+  Impl::ReaderOptionsDialogFunctor optionsCallback;
+  std::string errMsg = Load(loadInfos, nodeResult, &storage, &optionsCallback, numberOfThreads);
+  if (!errMsg.empty())
+  {
+    QMessageBox::warning(parent, "Error reading files", QString::fromStdString(errMsg));
+  }
+  return nodeResult;
+}
+
 QList<mitk::BaseData::Pointer> QmitkIOUtil::Load(const QString &path, QWidget *parent)
 {
   QStringList paths;
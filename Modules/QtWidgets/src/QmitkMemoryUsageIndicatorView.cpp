@@ -23,6 +23,7 @@ found in the LICENSE file.
 *****************************************************************************/
 
 #include "QmitkMemoryUsageIndicatorView.h"
+#include <mitkMemoryAccounting.h>
 #include <mitkMemoryUtilities.h>
 
 #include <qapplication.h>
@@ -61,6 +62,9 @@ QmitkMemoryUsageIndicatorView::~QmitkMemoryUsageIndicatorView()
 
 void QmitkMemoryUsageIndicatorView::UpdateMemoryUsage()
 {
+  // the periodic update doubles as the idle check of the memory accounting, which is disabled by default
+  mitk::MemoryAccounting::GetInstance().HibernateIdleImages();
+
   size_t processSize = mitk::MemoryUtilities::GetProcessMemoryUsage();
   size_t totalSize = mitk::MemoryUtilities::GetTotalSizeOfPhysicalRam();
   float percentage = ((float)processSize / (float)totalSize) * 100.0;
@@ -200,12 +200,44 @@ void QmitkRenderWindow::mouseMoveEvent(QMouseEvent *me)
   mitk::MouseMoveEvent::Pointer mMoveEvent =
     mitk::MouseMoveEvent::New(m_Renderer, displayPos, GetButtonState(me), GetModifiers(me));
 
+  auto dispatcher = m_Renderer->GetDispatcher();
+
+  if (dispatcher->IsMoveEventCoalescingEnabled())
+  {
+    // Only the latest move event is processed once the event loop is idle again
+    bool isScheduled = dispatcher->HasPendingEvent();
+
+    dispatcher->PostEvent(mMoveEvent.GetPointer());
+    m_PendingMouseMoveEvent.reset(new QMouseEvent(*me));
+
+    if (!isScheduled)
+      QTimer::singleShot(0, this, &QmitkRenderWindow::ProcessPendingMouseMoveEvent);
+
+    return;
+  }
+
   if (!this->HandleEvent(mMoveEvent.GetPointer()))
   {
     QVTKOpenGLWidget::mouseMoveEvent(me);
   }
 }
 
+void QmitkRenderWindow::ProcessPendingMouseMoveEvent()
+{
+  std::unique_ptr<QMouseEvent> me(std::move(m_PendingMouseMoveEvent));
+  auto dispatcher = m_Renderer->GetDispatcher();
+
+  // The pending event may have been processed before a subsequent event already
+  bool isHandled = dispatcher->HasPendingEvent()
+    ? dispatcher->ProcessPendingEvent()
+    : true;
+
+  if (!isHandled && nullptr != me)
+  {
+    QVTKOpenGLWidget::mouseMoveEvent(me.get());
+  }
+}
+
 void QmitkRenderWindow::wheelEvent(QWheelEvent *we)
 {
   mitk::Point2D displayPos = GetMousePosition(we);
@@ -449,6 +449,9 @@ void QmitkRenderWindowMenu::OnTSNumChanged(int num)
                                                                 mitk::ResliceMethodProperty::New(thickSlicesMode));
     m_Renderer->GetCurrentWorldPlaneGeometryNode()->SetProperty("reslice.thickslices.num",
                                                                 mitk::IntProperty::New(num));
+    // the number of slices chosen here replaces a slab thickness in mm
+    m_Renderer->GetCurrentWorldPlaneGeometryNode()->SetProperty("reslice.thickslices.thickness",
+                                                                mitk::FloatProperty::New(0.0f));
 
     m_TSLabel->setText(QString::number(num * 2 + 1));
     m_Renderer->SendUpdateSlice();
@@ -3,4 +3,5 @@ set(CPP_FILES
   mitkRESTServer.cpp
   mitkIRESTManager.cpp
   mitkIRESTObserver.cpp
+  mitkRESTRenderService.cpp
 )
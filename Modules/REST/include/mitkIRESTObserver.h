@@ -34,6 +34,11 @@ namespace mitk
     /**
      * @brief Called if there's an incoming request for the observer, observer implements how to handle request
      *
+     * Requests are handled by the worker threads of the RESTServer, so this method may be called
+     * concurrently and not in the main thread. Large payloads should be returned as a stream body
+     * (web::http::http_response::set_body() with a concurrency::streams::istream), which is sent
+     * in chunks instead of being copied into memory first.
+     *
      * @param data the data of the incoming request
 	 * @param method the http method of the incoming request
      * @return the modified data
@@ -0,0 +1,139 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkRESTRenderService_h
+#define mitkRESTRenderService_h
+
+#include <MitkRESTExports.h>
+#include <mitkDataStorage.h>
+#include <mitkDisplayActionEventBroadcast.h>
+#include <mitkDisplayActionEventHandler.h>
+#include <mitkIRESTObserver.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace mitk
+{
+  /**
+   * @brief Renders views of a data storage offscreen and delivers them to thin clients as JPEG frames
+   *
+   * The service is registered as observer of a URI with IRESTManager::ReceiveRequest(). A client opens a
+   * session, i.e. a view of its own, and receives the rendered frames and sends its interaction via requests
+   * to this URI:
+   *
+   * - POST without parameters opens a session. The optional JSON body
+   *   {"width": 512, "height": 512, "view": "axial"} sets the size and the view ("axial", "sagittal",
+   *   "coronal" or "3d"). The response is {"session": "<id>"}.
+   * - GET ?session=<id> returns the latest frame as image/jpeg with its number in the header X-Frame-Number.
+   * - GET ?session=<id>&stream=mjpeg returns an endless multipart/x-mixed-replace stream of the frames, which
+   *   browsers show in an img element. A frame is skipped for a client which did not read the previous one yet.
+   * - POST ?session=<id> dispatches interaction events to the view. The body is an event or an array of events
+   *   {"type": "mousepress" | "mousemove" | "mouserelease" | "wheel" | "keypress" | "resize", "x": 10, "y": 20,
+   *   "button": "left" | "middle" | "right", "modifiers": ["shift", "ctrl", "alt"], "delta": 120, "key": "a",
+   *   "width": 512, "height": 512} with content type application/json. Positions are pixels of the frame with the
+   *   origin in the top left corner, like in browsers. The pressed buttons are tracked by the service.
+   * - DELETE ?session=<id> closes the session. Sessions without any request for GetSessionTimeout() seconds are
+   *   closed as well.
+   *
+   * Frames rendered because of interaction are encoded with GetInteractiveQuality(). Once no events arrived
+   * for GetRefineDelay() milliseconds, the view is encoded again with GetStillQuality().
+   *
+   * All sessions are rendered by one render thread, which also dispatches their events, so the OpenGL contexts
+   * are only used by this thread. Pan, zoom and scroll are handled by a DisplayActionEventBroadcast of the
+   * service. Since the render thread reads the data storage, the service is meant for render server processes
+   * which do not modify the data while sessions are open. The process has to provide a RenderingManager.
+   */
+  class MITKREST_EXPORT RESTRenderService : public IRESTObserver
+  {
+  public:
+    explicit RESTRenderService(DataStorage *dataStorage);
+
+    /** @brief Closes all sessions and stops the render thread. */
+    ~RESTRenderService() override;
+
+    RESTRenderService(const RESTRenderService &) = delete;
+    RESTRenderService &operator=(const RESTRenderService &) = delete;
+
+    web::http::http_response Notify(const web::uri &uri,
+                                    const web::json::value &data,
+                                    const web::http::method &method,
+                                    const mitk::RESTUtil::ParamMap &headers) override;
+
+    /** @brief Renders all sessions again, e.g. after the data storage was modified. */
+    void RequestUpdateAll();
+
+    /** @brief JPEG quality (1-100) of frames rendered during interaction (default 50) */
+    void SetInteractiveQuality(int quality);
+    int GetInteractiveQuality() const;
+
+    /** @brief JPEG quality (1-100) of frames rendered without interaction (default 90) */
+    void SetStillQuality(int quality);
+    int GetStillQuality() const;
+
+    /** @brief Milliseconds without events after which the view is encoded with the still quality (default 200) */
+    void SetRefineDelay(unsigned int milliseconds);
+    unsigned int GetRefineDelay() const;
+
+    /** @brief Seconds without requests after which a session is closed (default 300) */
+    void SetSessionTimeout(unsigned int seconds);
+    unsigned int GetSessionTimeout() const;
+
+    std::size_t GetNumberOfSessions() const;
+
+  private:
+    struct Session;
+
+    web::http::http_response OpenSession(const web::json::value &options);
+    web::http::http_response GetFrame(const std::shared_ptr<Session> &session, bool stream);
+
+    /** @brief Runs a function on the render thread and waits for it. */
+    void RunOnRenderThread(const std::function<void()> &function);
+
+    void Run();
+
+    /** @brief Called by the render thread. */
+    void InitializeSession(Session &session, const web::json::value &options);
+    void DispatchEvent(Session &session, const web::json::value &event);
+    std::vector<unsigned char> RenderFrame(Session &session, int quality);
+    void CloseSession(Session &session);
+
+    /** @brief Called with the mutex locked. */
+    void PublishFrame(Session &session, std::vector<unsigned char> &&frame);
+
+    DataStorage::Pointer m_DataStorage;
+
+    mutable std::mutex m_Mutex;
+    std::condition_variable m_WorkAvailable;
+    std::map<utility::string_t, std::shared_ptr<Session>> m_Sessions;
+    std::deque<std::function<void()>> m_Tasks;
+    unsigned int m_NextSessionId;
+
+    int m_InteractiveQuality;
+    int m_StillQuality;
+    unsigned int m_RefineDelay;
+    unsigned int m_SessionTimeout;
+
+    DisplayActionEventBroadcast::Pointer m_DisplayActionEventBroadcast;
+    std::unique_ptr<DisplayActionEventHandler> m_DisplayActionEventHandler;
+
+    bool m_Stop;
+    std::thread m_RenderThread;
+  };
+}
+
+#endif
@@ -16,8 +16,20 @@ found in the LICENSE file.
 #include <MitkRESTExports.h>
 #include <cpprest/uri.h>
 
+#include <cstddef>
+#include <memory>
+
 namespace mitk
 {
+  /**
+   * @brief Listens for requests at a URI and passes them to the IRESTManager service
+   *
+   * Incoming requests are queued per endpoint (the path of the request) and handled by a pool of
+   * worker threads, so the threads of the listener are not blocked by the observers and slow requests
+   * to one endpoint do not delay the requests to other endpoints: the workers take the queued requests
+   * of all endpoints in turn. If the number of queued requests reaches GetMaximumNumberOfQueuedRequests(),
+   * further requests are answered with 503 (Service Unavailable) right away.
+   */
   class MITKREST_EXPORT RESTServer
   {
   public:
@@ -31,6 +43,20 @@ namespace mitk
 
     web::uri GetUri();
 
+    /**
+     * @brief Sets the number of requests which are handled at the same time (default 4)
+     *
+     * Takes effect the next time the listener is opened.
+     */
+    void SetNumberOfThreads(unsigned int numberOfThreads);
+    unsigned int GetNumberOfThreads() const;
+
+    /**
+     * @brief Sets the number of requests which may wait for a worker thread (default 64)
+     */
+    void SetMaximumNumberOfQueuedRequests(std::size_t maximumNumberOfQueuedRequests);
+    std::size_t GetMaximumNumberOfQueuedRequests() const;
+
      /**
      * @brief Opens the listener and starts the listening process
      */
@@ -38,14 +64,12 @@ namespace mitk
 
     /**
      * @brief Closes the listener and stops the listening process
+     *
+     * Requests which are still queued are answered with 503 (Service Unavailable), requests which
+     * are being handled are finished before the method returns.
      */
     void CloseListener();
   private:
-    /**
-     * @brief Handle for incoming GET requests
-     *
-     * @param MitkRequest incoming request object
-     */
     class Impl;
     std::unique_ptr<Impl> m_Impl;
   };
@@ -0,0 +1,712 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkRESTRenderService.h>
+
+#include <mitkCameraController.h>
+#include <mitkDisplayActionEventHandlerStd.h>
+#include <mitkExceptionMacro.h>
+#include <mitkInteractionKeyEvent.h>
+#include <mitkLogMacros.h>
+#include <mitkMouseMoveEvent.h>
+#include <mitkMousePressEvent.h>
+#include <mitkMouseReleaseEvent.h>
+#include <mitkMouseWheelEvent.h>
+#include <mitkRESTUtil.h>
+#include <mitkVtkPropRenderer.h>
+#include <vtkMitkRenderProp.h>
+
+#include <cpprest/producerconsumerstream.h>
+
+#include <vtkJPEGWriter.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderer.h>
+#include <vtkSmartPointer.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkWindowToImageFilter.h>
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <sstream>
+
+using http_response = web::http::http_response;
+using methods = web::http::methods;
+using status_codes = web::http::status_codes;
+using stream_buffer = concurrency::streams::producer_consumer_buffer<uint8_t>;
+using clock_type = std::chrono::steady_clock;
+
+namespace
+{
+  /** How long the render thread sleeps at most before it checks for refinement and expired sessions */
+  const std::chrono::milliseconds PollInterval(50);
+
+  const int MinimumSize = 16;
+  const int MaximumSize = 4096;
+
+  http_response CreateErrorResponse(web::http::status_code status, const std::string &message)
+  {
+    web::json::value body;
+    body[U("error")] = web::json::value::string(mitk::RESTUtil::convertToTString(message));
+
+    http_response response(status);
+    response.set_body(body);
+    return response;
+  }
+
+  int GetInteger(const web::json::value &object, const utility::string_t &name, int defaultValue)
+  {
+    return object.has_field(name) && object.at(name).is_number() ? object.at(name).as_integer() : defaultValue;
+  }
+
+  std::string GetString(const web::json::value &object, const utility::string_t &name)
+  {
+    return object.has_field(name) && object.at(name).is_string()
+             ? mitk::RESTUtil::convertToUtf8(object.at(name).as_string())
+             : std::string();
+  }
+
+  int ClampSize(int size) { return std::max(MinimumSize, std::min(size, MaximumSize)); }
+
+  mitk::InteractionEvent::MouseButtons GetButton(const web::json::value &event)
+  {
+    const auto button = GetString(event, U("button"));
+    if (button == "left")
+      return mitk::InteractionEvent::LeftMouseButton;
+    if (button == "middle")
+      return mitk::InteractionEvent::MiddleMouseButton;
+    if (button == "right")
+      return mitk::InteractionEvent::RightMouseButton;
+    mitkThrow() << "Unknown mouse button \"" << button << "\".";
+  }
+
+  mitk::InteractionEvent::ModifierKeys GetModifiers(const web::json::value &event)
+  {
+    auto modifiers = mitk::InteractionEvent::NoKey;
+    if (!event.has_field(U("modifiers")) || !event.at(U("modifiers")).is_array())
+      return modifiers;
+
+    for (const auto &modifier : event.at(U("modifiers")).as_array())
+    {
+      if (!modifier.is_string())
+        continue;
+
+      const auto name = mitk::RESTUtil::convertToUtf8(modifier.as_string());
+      if (name == "shift")
+        modifiers |= mitk::InteractionEvent::ShiftKey;
+      else if (name == "ctrl")
+        modifiers |= mitk::InteractionEvent::ControlKey;
+      else if (name == "alt")
+        modifiers |= mitk::InteractionEvent::AltKey;
+    }
+    return modifiers;
+  }
+
+  mitk::SliceNavigationController::ViewDirection GetViewDirection(const std::string &view)
+  {
+    if (view == "axial")
+      return mitk::SliceNavigationController::Axial;
+    if (view == "sagittal")
+      return mitk::SliceNavigationController::Sagittal;
+    if (view == "coronal")
+      return mitk::SliceNavigationController::Frontal;
+    mitkThrow() << "Unknown view \"" << view << "\".";
+  }
+
+  /**
+   * Appends a frame as part of a multipart/x-mixed-replace stream. A client which did not read the previous
+   * frame yet skips this one, so slow clients do not queue up frames but always get a recent one. Returns
+   * whether the frame was written.
+   */
+  bool WriteStreamPart(stream_buffer &buffer, const std::vector<unsigned char> &frame, unsigned int frameNumber)
+  {
+    if (!buffer.can_write() || buffer.in_avail() > 0)
+      return false;
+
+    std::ostringstream header;
+    header << "--frame\r\nContent-Type: image/jpeg\r\nContent-Length: " << frame.size()
+           << "\r\nX-Frame-Number: " << frameNumber << "\r\n\r\n";
+    const std::string headerString = header.str();
+
+    buffer.putn_nocopy(reinterpret_cast<const uint8_t *>(headerString.data()), headerString.size()).wait();
+    buffer.putn_nocopy(frame.data(), frame.size()).wait();
+    buffer.putn_nocopy(reinterpret_cast<const uint8_t *>("\r\n"), 2).wait();
+    return true;
+  }
+}
+
+struct mitk::RESTRenderService::Session
+{
+  utility::string_t Id;
+
+  // only used by the render thread
+  vtkSmartPointer<vtkRenderWindow> RenderWindow;
+  VtkPropRenderer::Pointer Renderer;
+  vtkSmartPointer<vtkMitkRenderProp> RenderProp;
+  vtkSmartPointer<vtkWindowToImageFilter> WindowToImageFilter;
+  vtkSmartPointer<vtkJPEGWriter> Writer;
+  InteractionEvent::MouseButtons ButtonStates = InteractionEvent::NoButton;
+
+  // guarded by the mutex of the service
+  std::vector<web::json::value> Events;
+  bool UpdateRequested = false;
+  bool RefinePending = false;
+  clock_type::time_point LastEvent;
+  clock_type::time_point LastRequest;
+  std::vector<unsigned char> Frame;
+  unsigned int FrameNumber = 0;
+  std::vector<stream_buffer> Streams;
+};
+
+mitk::RESTRenderService::RESTRenderService(DataStorage *dataStorage)
+  : m_DataStorage(dataStorage),
+    m_NextSessionId(1),
+    m_InteractiveQuality(50),
+    m_StillQuality(90),
+    m_RefineDelay(200),
+    m_SessionTimeout(300),
+    m_Stop(false)
+{
+  if (m_DataStorage.IsNull())
+    mitkThrow() << "RESTRenderService needs a data storage.";
+
+  m_DisplayActionEventBroadcast = DisplayActionEventBroadcast::New();
+  m_DisplayActionEventBroadcast->LoadStateMachine("DisplayInteraction.xml");
+  m_DisplayActionEventBroadcast->SetEventConfig("DisplayConfigPACS.xml");
+
+  m_DisplayActionEventHandler = std::make_unique<DisplayActionEventHandlerStd>();
+  m_DisplayActionEventHandler->SetObservableBroadcast(m_DisplayActionEventBroadcast);
+  m_DisplayActionEventHandler->InitActions();
+
+  m_RenderThread = std::thread(&RESTRenderService::Run, this);
+}
+
+mitk::RESTRenderService::~RESTRenderService()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stop = true;
+  }
+  m_WorkAvailable.notify_one();
+  m_RenderThread.join();
+}
+
+void mitk::RESTRenderService::RequestUpdateAll()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (auto &session : m_Sessions)
+      session.second->UpdateRequested = true;
+  }
+  m_WorkAvailable.notify_one();
+}
+
+void mitk::RESTRenderService::SetInteractiveQuality(int quality)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_InteractiveQuality = std::max(1, std::min(quality, 100));
+}
+
+int mitk::RESTRenderService::GetInteractiveQuality() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_InteractiveQuality;
+}
+
+void mitk::RESTRenderService::SetStillQuality(int quality)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_StillQuality = std::max(1, std::min(quality, 100));
+}
+
+int mitk::RESTRenderService::GetStillQuality() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_StillQuality;
+}
+
+void mitk::RESTRenderService::SetRefineDelay(unsigned int milliseconds)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_RefineDelay = milliseconds;
+}
+
+unsigned int mitk::RESTRenderService::GetRefineDelay() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_RefineDelay;
+}
+
+void mitk::RESTRenderService::SetSessionTimeout(unsigned int seconds)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_SessionTimeout = seconds;
+}
+
+unsigned int mitk::RESTRenderService::GetSessionTimeout() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_SessionTimeout;
+}
+
+std::size_t mitk::RESTRenderService::GetNumberOfSessions() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Sessions.size();
+}
+
+web::http::http_response mitk::RESTRenderService::Notify(const web::uri &uri,
+                                                         const web::json::value &data,
+                                                         const web::http::method &method,
+                                                         const mitk::RESTUtil::ParamMap &)
+{
+  const auto query = web::uri::split_query(uri.query());
+  const auto sessionParameter = query.find(U("session"));
+
+  if (sessionParameter == query.end())
+  {
+    if (method == methods::POST)
+      return this->OpenSession(data);
+
+    return CreateErrorResponse(status_codes::BadRequest, "The parameter session is missing.");
+  }
+
+  std::shared_ptr<Session> session;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto it = m_Sessions.find(sessionParameter->second);
+    if (it != m_Sessions.end())
+      session = it->second;
+  }
+
+  if (!session)
+    return CreateErrorResponse(status_codes::NotFound, "Unknown session.");
+
+  if (method == methods::GET)
+  {
+    const auto streamParameter = query.find(U("stream"));
+    if (streamParameter != query.end() && streamParameter->second != U("mjpeg"))
+      return CreateErrorResponse(status_codes::BadRequest, "Only mjpeg streams are supported.");
+
+    return this->GetFrame(session, streamParameter != query.end());
+  }
+
+  if (method == methods::POST)
+  {
+    std::vector<web::json::value> events;
+    if (data.is_array())
+      events.assign(data.as_array().begin(), data.as_array().end());
+    else
+      events.push_back(data);
+
+    for (const auto &event : events)
+    {
+      if (!event.is_object() || GetString(event, U("type")).empty())
+        return CreateErrorResponse(status_codes::BadRequest, "Events are JSON objects with a type.");
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      session->Events.insert(session->Events.end(), events.begin(), events.end());
+      session->LastEvent = clock_type::now();
+      session->LastRequest = session->LastEvent;
+    }
+    m_WorkAvailable.notify_one();
+
+    return http_response(status_codes::OK);
+  }
+
+  if (method == methods::DEL)
+  {
+    try
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Sessions.erase(session->Id);
+      }
+      this->RunOnRenderThread([this, session]() { this->CloseSession(*session); });
+    }
+    catch (const std::exception &e)
+    {
+      return CreateErrorResponse(status_codes::ServiceUnavailable, e.what());
+    }
+
+    return http_response(status_codes::OK);
+  }
+
+  return CreateErrorResponse(status_codes::MethodNotAllowed, "Use GET, POST or DELETE.");
+}
+
+web::http::http_response mitk::RESTRenderService::OpenSession(const web::json::value &options)
+{
+  if (!options.is_null() && !options.is_object())
+    return CreateErrorResponse(status_codes::BadRequest, "The options of a session are a JSON object.");
+
+  auto session = std::make_shared<Session>();
+
+  try
+  {
+    const int quality = this->GetStillQuality();
+    this->RunOnRenderThread([this, session, &options, quality]() {
+      this->InitializeSession(*session, options);
+      auto frame = this->RenderFrame(*session, quality);
+
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      this->PublishFrame(*session, std::move(frame));
+    });
+  }
+  catch (const std::exception &e)
+  {
+    return CreateErrorResponse(status_codes::BadRequest, e.what());
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    session->Id = utility::conversions::to_string_t(std::to_string(m_NextSessionId++));
+    session->LastRequest = clock_type::now();
+    m_Sessions[session->Id] = session;
+  }
+
+  web::json::value body;
+  body[U("session")] = web::json::value::string(session->Id);
+
+  http_response response(status_codes::Created);
+  response.set_body(body);
+  return response;
+}
+
+web::http::http_response mitk::RESTRenderService::GetFrame(const std::shared_ptr<Session> &session, bool stream)
+{
+  http_response response(status_codes::OK);
+  response.headers().add(U("Cache-Control"), U("no-store"));
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  session->LastRequest = clock_type::now();
+
+  if (stream)
+  {
+    // the body is read by the listener while the render thread appends frames, so the worker thread of the
+    // REST server is not blocked by the stream
+    stream_buffer buffer;
+    WriteStreamPart(buffer, session->Frame, session->FrameNumber);
+    session->Streams.push_back(buffer);
+
+    response.set_body(buffer.create_istream(), U("multipart/x-mixed-replace; boundary=frame"));
+    return response;
+  }
+
+  response.set_body(session->Frame);
+  response.headers().set_content_type(U("image/jpeg"));
+  response.headers().add(U("X-Frame-Number"), session->FrameNumber);
+  return response;
+}
+
+void mitk::RESTRenderService::RunOnRenderThread(const std::function<void()> &function)
+{
+  auto task = std::make_shared<std::packaged_task<void()>>(function);
+  auto result = task->get_future();
+
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_Stop)
+      mitkThrow() << "The render service is stopped.";
+
+    m_Tasks.push_back([task]() { (*task)(); });
+  }
+  m_WorkAvailable.notify_one();
+
+  result.get();
+}
+
+void mitk::RESTRenderService::Run()
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+
+  while (!m_Stop)
+  {
+    while (!m_Tasks.empty())
+    {
+      auto task = std::move(m_Tasks.front());
+      m_Tasks.pop_front();
+
+      lock.unlock();
+      task();
+      lock.lock();
+    }
+
+    const auto now = clock_type::now();
+    const std::chrono::milliseconds refineDelay(m_RefineDelay);
+    const std::chrono::seconds sessionTimeout(m_SessionTimeout);
+
+    std::vector<std::shared_ptr<Session>> sessions;
+    std::vector<std::shared_ptr<Session>> expiredSessions;
+    for (auto it = m_Sessions.begin(); it != m_Sessions.end();)
+    {
+      if (now - it->second->LastRequest > sessionTimeout)
+      {
+        expiredSessions.push_back(it->second);
+        it = m_Sessions.erase(it);
+      }
+      else
+      {
+        sessions.push_back(it->second);
+        ++it;
+      }
+    }
+
+    if (!expiredSessions.empty())
+    {
+      lock.unlock();
+      for (const auto &session : expiredSessions)
+      {
+        MITK_INFO << "Closing expired render session " << RESTUtil::convertToUtf8(session->Id);
+        this->CloseSession(*session);
+      }
+      lock.lock();
+    }
+
+    for (const auto &session : sessions)
+    {
+      if (m_Stop)
+        break;
+
+      std::vector<web::json::value> events;
+      events.swap(session->Events);
+
+      const bool refine = session->RefinePending && now - session->LastEvent >= refineDelay;
+      if (events.empty() && !session->UpdateRequested && !refine)
+        continue;
+
+      // while the user interacts, frames are encoded faster and smaller
+      const bool interactive = now - session->LastEvent < refineDelay;
+      const int quality = interactive ? m_InteractiveQuality : m_StillQuality;
+      session->RefinePending = interactive;
+      session->UpdateRequested = false;
+
+      lock.unlock();
+      for (const auto &event : events)
+      {
+        try
+        {
+          this->DispatchEvent(*session, event);
+        }
+        catch (const std::exception &e)
+        {
+          MITK_WARN << "Cannot dispatch event of render session " << RESTUtil::convertToUtf8(session->Id) << ": "
+                    << e.what();
+        }
+      }
+      auto frame = this->RenderFrame(*session, quality);
+      lock.lock();
+
+      this->PublishFrame(*session, std::move(frame));
+    }
+
+    m_WorkAvailable.wait_for(lock, PollInterval, [this]() {
+      if (m_Stop || !m_Tasks.empty())
+        return true;
+
+      for (const auto &session : m_Sessions)
+      {
+        if (!session.second->Events.empty() || session.second->UpdateRequested)
+          return true;
+      }
+      return false;
+    });
+  }
+
+  // tasks which were not run anymore report a broken promise to their callers
+  m_Tasks.clear();
+
+  std::map<utility::string_t, std::shared_ptr<Session>> sessions;
+  sessions.swap(m_Sessions);
+  lock.unlock();
+
+  for (const auto &session : sessions)
+    this->CloseSession(*session.second);
+}
+
+void mitk::RESTRenderService::InitializeSession(Session &session, const web::json::value &options)
+{
+  const int width = ClampSize(GetInteger(options, U("width"), 512));
+  const int height = ClampSize(GetInteger(options, U("height"), 512));
+  std::string view = GetString(options, U("view"));
+  if (view.empty())
+    view = "axial";
+
+  const bool is3D = view == "3d";
+  const auto viewDirection = is3D ? SliceNavigationController::Original : GetViewDirection(view);
+
+  session.RenderWindow = vtkSmartPointer<vtkRenderWindow>::New();
+  session.RenderWindow->SetOffScreenRendering(1);
+  session.RenderWindow->SetSize(width, height);
+
+  std::ostringstream name;
+  name << "RESTRenderService" << static_cast<const void *>(&session);
+
+  // like RenderWindowBase::Initialize(), but the window is not updated by the RenderingManager
+  session.Renderer = VtkPropRenderer::New(name.str().c_str(), session.RenderWindow);
+  session.Renderer->InitRenderer(session.RenderWindow);
+  BaseRenderer::AddInstance(session.RenderWindow, session.Renderer);
+
+  session.RenderProp = vtkSmartPointer<vtkMitkRenderProp>::New();
+  session.RenderProp->SetPropRenderer(session.Renderer);
+  session.Renderer->GetVtkRenderer()->AddViewProp(session.RenderProp);
+  session.Renderer->InitSize(width, height);
+
+  session.Renderer->SetDataStorage(m_DataStorage);
+  session.Renderer->SetMapperID(is3D ? BaseRenderer::Standard3D : BaseRenderer::Standard2D);
+
+  auto sliceNavigationController = session.Renderer->GetSliceNavigationController();
+  if (!is3D)
+    sliceNavigationController->SetDefaultViewDirection(viewDirection);
+  sliceNavigationController->SetViewDirectionToDefault();
+
+  // see RenderingManager::InternalViewInitialization()
+  auto geometry = m_DataStorage->ComputeBoundingGeometry3D(m_DataStorage->GetAll());
+  if (geometry.IsNotNull() && geometry->GetBoundingBoxInWorld()->GetDiagonalLength2() > eps)
+  {
+    sliceNavigationController->SetInputWorldTimeGeometry(geometry);
+    sliceNavigationController->Update();
+
+    if (!is3D)
+      sliceNavigationController->GetSlice()->SetPos(sliceNavigationController->GetSlice()->GetSteps() / 2);
+
+    session.Renderer->GetCameraController()->SetViewToAnterior();
+    session.Renderer->GetCameraController()->Fit();
+  }
+  else
+  {
+    sliceNavigationController->Update();
+  }
+
+  session.WindowToImageFilter = vtkSmartPointer<vtkWindowToImageFilter>::New();
+  session.WindowToImageFilter->SetInput(session.RenderWindow);
+  session.WindowToImageFilter->SetInputBufferTypeToRGB();
+  session.WindowToImageFilter->ReadFrontBufferOff();
+  session.WindowToImageFilter->ShouldRerenderOff();
+
+  session.Writer = vtkSmartPointer<vtkJPEGWriter>::New();
+  session.Writer->SetInputConnection(session.WindowToImageFilter->GetOutputPort());
+  session.Writer->WriteToMemoryOn();
+}
+
+void mitk::RESTRenderService::DispatchEvent(Session &session, const web::json::value &event)
+{
+  const auto type = GetString(event, U("type"));
+  auto renderer = session.Renderer.GetPointer();
+
+  if (type == "resize")
+  {
+    const int width = ClampSize(GetInteger(event, U("width"), renderer->GetSizeX()));
+    const int height = ClampSize(GetInteger(event, U("height"), renderer->GetSizeY()));
+    session.RenderWindow->SetSize(width, height);
+    renderer->Resize(width, height);
+    return;
+  }
+
+  // browsers count pixels from the top, VTK from the bottom
+  Point2D position;
+  position[0] = GetInteger(event, U("x"), 0);
+  position[1] = renderer->GetSizeY() - GetInteger(event, U("y"), 0);
+
+  const auto modifiers = GetModifiers(event);
+
+  InteractionEvent::Pointer interactionEvent;
+  if (type == "mousepress")
+  {
+    const auto button = GetButton(event);
+    session.ButtonStates |= button;
+    interactionEvent = MousePressEvent::New(renderer, position, session.ButtonStates, modifiers, button).GetPointer();
+  }
+  else if (type == "mousemove")
+  {
+    interactionEvent = MouseMoveEvent::New(renderer, position, session.ButtonStates, modifiers).GetPointer();
+  }
+  else if (type == "mouserelease")
+  {
+    const auto button = GetButton(event);
+    session.ButtonStates = static_cast<InteractionEvent::MouseButtons>(session.ButtonStates & ~button);
+    interactionEvent = MouseReleaseEvent::New(renderer, position, session.ButtonStates, modifiers, button).GetPointer();
+  }
+  else if (type == "wheel")
+  {
+    const int delta = GetInteger(event, U("delta"), 0);
+    interactionEvent = MouseWheelEvent::New(renderer, position, session.ButtonStates, modifiers, delta).GetPointer();
+  }
+  else if (type == "keypress")
+  {
+    interactionEvent = InteractionKeyEvent::New(renderer, GetString(event, U("key")), modifiers).GetPointer();
+  }
+  else
+  {
+    mitkThrow() << "Unknown event type \"" << type << "\".";
+  }
+
+  renderer->GetDispatcher()->ProcessEvent(interactionEvent);
+}
+
+std::vector<unsigned char> mitk::RESTRenderService::RenderFrame(Session &session, int quality)
+{
+  session.Renderer->PrepareRender();
+  session.RenderWindow->Render();
+
+  session.WindowToImageFilter->Modified();
+  session.Writer->SetQuality(quality);
+  session.Writer->Write();
+
+  vtkUnsignedCharArray *result = session.Writer->GetResult();
+  const unsigned char *begin = result->GetPointer(0);
+  return std::vector<unsigned char>(begin, begin + result->GetNumberOfValues());
+}
+
+void mitk::RESTRenderService::CloseSession(Session &session)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (auto &stream : session.Streams)
+      stream.close(std::ios_base::out).wait();
+    session.Streams.clear();
+  }
+
+  if (session.Renderer.IsNull())
+    return;
+
+  session.Writer = nullptr;
+  session.WindowToImageFilter = nullptr;
+  session.Renderer->GetVtkRenderer()->RemoveViewProp(session.RenderProp);
+  BaseRenderer::RemoveInstance(session.RenderWindow);
+  session.RenderProp = nullptr;
+  session.Renderer = nullptr;
+  session.RenderWindow = nullptr;
+}
+
+void mitk::RESTRenderService::PublishFrame(Session &session, std::vector<unsigned char> &&frame)
+{
+  session.Frame = std::move(frame);
+  ++session.FrameNumber;
+
+  for (auto it = session.Streams.begin(); it != session.Streams.end();)
+  {
+    if (!it->can_write())
+    {
+      it = session.Streams.erase(it);
+      continue;
+    }
+
+    // a client reading the stream keeps the session alive
+    if (WriteStreamPart(*it, session.Frame, session.FrameNumber))
+      session.LastRequest = clock_type::now();
+
+    ++it;
+  }
+}
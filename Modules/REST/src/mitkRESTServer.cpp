@@ -12,12 +12,19 @@ found in the LICENSE file.
 
 #include <mitkIRESTManager.h>
 #include <mitkRESTServer.h>
+#include <mitkLogMacros.h>
+#include <mitkThreadPool.h>
 
 #include <usGetModuleContext.h>
 #include <usModuleContext.h>
 
 #include <cpprest/http_listener.h>
 
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <mutex>
+
 using namespace std::placeholders;
 
 using http_listener = web::http::experimental::listener::http_listener;
@@ -34,16 +41,114 @@ namespace mitk
     Impl(const web::uri &uri);
     ~Impl();
 
+    /**
+     * @brief Queues an incoming request at its endpoint and schedules a worker for it
+     */
+    void EnqueueRequest(const http_request &request);
+
+    /**
+     * @brief Takes the next request of the endpoint after the last served one
+     */
+    bool TakeNextRequest(http_request &request);
+
+    /**
+     * @brief Replies 503 to all queued requests
+     */
+    void RejectQueuedRequests();
+
     void HandleRequest(const http_request &request);
 
     web::http::experimental::listener::http_listener listener;
     web::uri uri;
+
+    unsigned int numberOfThreads;
+    std::size_t maximumNumberOfQueuedRequests;
+
+    std::mutex queueMutex;
+    std::map<utility::string_t, std::deque<http_request>> queues;
+    std::size_t numberOfQueuedRequests;
+    utility::string_t lastEndpoint;
+
+    std::unique_ptr<ThreadPool> threadPool;
   };
 
-  RESTServer::Impl::Impl(const web::uri &uri) : uri{uri} {}
+  RESTServer::Impl::Impl(const web::uri &uri)
+    : uri{uri}, numberOfThreads{4}, maximumNumberOfQueuedRequests{64}, numberOfQueuedRequests{0}
+  {
+  }
 
   RESTServer::Impl::~Impl() {}
 
+  void RESTServer::Impl::EnqueueRequest(const http_request &request)
+  {
+    std::lock_guard<std::mutex> lock(this->queueMutex);
+
+    if (nullptr == this->threadPool || this->numberOfQueuedRequests >= this->maximumNumberOfQueuedRequests)
+    {
+      http_response response(status_codes::ServiceUnavailable);
+      response.headers().add(web::http::header_names::retry_after, U("1"));
+      request.reply(response);
+      return;
+    }
+
+    this->queues[request.relative_uri().path()].push_back(request);
+    ++this->numberOfQueuedRequests;
+
+    // a worker handles the next request in turn, which is not necessarily this one
+    this->threadPool->Submit([this]() {
+      http_request next;
+      if (!this->TakeNextRequest(next))
+        return;
+
+      try
+      {
+        this->HandleRequest(next);
+      }
+      catch (const std::exception &e)
+      {
+        MITK_ERROR << "Handling a REST request failed: " << e.what();
+        next.reply(status_codes::InternalError);
+      }
+    });
+  }
+
+  bool RESTServer::Impl::TakeNextRequest(http_request &request)
+  {
+    std::lock_guard<std::mutex> lock(this->queueMutex);
+
+    if (this->queues.empty())
+      return false;
+
+    // endpoints without queued requests are removed, so every entry has a request
+    auto queue = this->queues.upper_bound(this->lastEndpoint);
+    if (queue == this->queues.end())
+      queue = this->queues.begin();
+
+    request = queue->second.front();
+    queue->second.pop_front();
+    --this->numberOfQueuedRequests;
+
+    this->lastEndpoint = queue->first;
+    if (queue->second.empty())
+      this->queues.erase(queue);
+
+    return true;
+  }
+
+  void RESTServer::Impl::RejectQueuedRequests()
+  {
+    std::lock_guard<std::mutex> lock(this->queueMutex);
+
+    for (const auto &queue : this->queues)
+    {
+      for (const auto &request : queue.second)
+        request.reply(status_codes::ServiceUnavailable);
+    }
+
+    this->queues.clear();
+    this->numberOfQueuedRequests = 0;
+  }
+
   void RESTServer::Impl::HandleRequest(const http_request &request)
   {
     web::uri_builder builder(this->listener.uri());
@@ -88,19 +193,58 @@ namespace mitk
 
 mitk::RESTServer::RESTServer(const web::uri &uri) : m_Impl{std::make_unique<Impl>(uri)} {}
 
-mitk::RESTServer::~RESTServer() {}
+mitk::RESTServer::~RESTServer()
+{
+  if (nullptr != m_Impl->threadPool)
+    this->CloseListener();
+}
+
+void mitk::RESTServer::SetNumberOfThreads(unsigned int numberOfThreads)
+{
+  m_Impl->numberOfThreads = std::max(1u, numberOfThreads);
+}
+
+unsigned int mitk::RESTServer::GetNumberOfThreads() const
+{
+  return m_Impl->numberOfThreads;
+}
+
+void mitk::RESTServer::SetMaximumNumberOfQueuedRequests(std::size_t maximumNumberOfQueuedRequests)
+{
+  std::lock_guard<std::mutex> lock(m_Impl->queueMutex);
+  m_Impl->maximumNumberOfQueuedRequests = maximumNumberOfQueuedRequests;
+}
+
+std::size_t mitk::RESTServer::GetMaximumNumberOfQueuedRequests() const
+{
+  return m_Impl->maximumNumberOfQueuedRequests;
+}
 
 void mitk::RESTServer::OpenListener()
 {
+  {
+    std::lock_guard<std::mutex> lock(m_Impl->queueMutex);
+    m_Impl->threadPool = std::make_unique<ThreadPool>(m_Impl->numberOfThreads);
+  }
+
   m_Impl->listener = http_listener(m_Impl->uri);
-  m_Impl->listener.support(std::bind(&Impl::HandleRequest, m_Impl.get(), _1));
-  m_Impl->listener.support(methods::OPTIONS, std::bind(&Impl::HandleRequest, m_Impl.get(), _1));
+  m_Impl->listener.support(std::bind(&Impl::EnqueueRequest, m_Impl.get(), _1));
+  m_Impl->listener.support(methods::OPTIONS, std::bind(&Impl::EnqueueRequest, m_Impl.get(), _1));
   m_Impl->listener.open().wait();
 }
 
 void mitk::RESTServer::CloseListener()
 {
   m_Impl->listener.close().wait();
+  m_Impl->RejectQueuedRequests();
+
+  std::unique_ptr<ThreadPool> threadPool;
+  {
+    std::lock_guard<std::mutex> lock(m_Impl->queueMutex);
+    threadPool = std::move(m_Impl->threadPool);
+  }
+  // joins the workers after the running requests are handled
+  threadPool.reset();
 }
 
 web::uri mitk::RESTServer::GetUri()
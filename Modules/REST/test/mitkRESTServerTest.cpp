@@ -40,6 +40,7 @@ class mitkRESTServerTestSuite : public mitk::TestFixture, mitk::IRESTObserver
   MITK_TEST(OpenListenerGetRequestDifferentPath_ReturnNotFound);
   MITK_TEST(OpenListenerCloseAndReopen_Succeed);
   MITK_TEST(HandleHeader_Succeed);
+  MITK_TEST(ConfigureWorkers_Succeed);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -247,6 +248,19 @@ public:
       }
     });
   }
+
+  void ConfigureWorkers_Succeed()
+  {
+    mitk::RESTServer server(U("http://localhost:8080"));
+    server.SetNumberOfThreads(0);
+    server.SetMaximumNumberOfQueuedRequests(8);
+
+    CPPUNIT_ASSERT_MESSAGE("At least one worker thread", 1 == server.GetNumberOfThreads());
+    CPPUNIT_ASSERT_MESSAGE("Maximum number of queued requests is set", 8 == server.GetMaximumNumberOfQueuedRequests());
+
+    server.OpenListener();
+    server.CloseListener();
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkRESTServer)
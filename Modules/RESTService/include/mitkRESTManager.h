@@ -17,6 +17,8 @@ found in the LICENSE file.
 #include <mitkIRESTManager.h>
 #include <mitkRESTUtil.h>
 
+#include <mutex>
+
 namespace mitk
 {
   /**
@@ -147,6 +149,7 @@ namespace mitk
 
     std::map<int, RESTServer *> m_ServerMap;                                  // Map with port server pairs
     std::map<std::pair<int, utility::string_t>, IRESTObserver *> m_Observers; // Map with all observers
+    std::mutex m_ObserversMutex;                                              // Guards m_Observers against Handle()
   };
 } // namespace mitk
 
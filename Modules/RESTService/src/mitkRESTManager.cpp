@@ -133,10 +133,18 @@ web::http::http_response mitk::RESTManager::Handle(const web::uri &uri,
                                                    const mitk::RESTUtil::ParamMap &headers)
 {
   // Checking if there is an observer for the port and path
-  auto key = std::make_pair(uri.port(), uri.path());
-  if (0 != m_Observers.count(key))
+  IRESTObserver *observer = nullptr;
   {
-    return m_Observers[key]->Notify(uri, body, method, headers);
+    // requests are handled by the worker threads of the servers
+    std::lock_guard<std::mutex> lock(m_ObserversMutex);
+    auto it = m_Observers.find(std::make_pair(uri.port(), uri.path()));
+    if (it != m_Observers.end())
+      observer = it->second;
+  }
+
+  if (nullptr != observer)
+  {
+    return observer->Notify(uri, body, method, headers);
   }
   // No observer under this port, return null which results in status code 404 (s. RESTServer)
   else
@@ -197,6 +205,7 @@ void mitk::RESTManager::AddObserver(const web::uri &uri, IRESTObserver *observer
 {
   // new observer has to be added
   std::pair<int, utility::string_t> key(uri.port(), uri.path());
+  std::lock_guard<std::mutex> lock(m_ObserversMutex);
   m_Observers[key] = observer;
 }
 
@@ -228,7 +237,10 @@ bool mitk::RESTManager::DeleteObserver(std::map<std::pair<int, utility::string_t
 {
   int port = it->first.first;
 
-  it = m_Observers.erase(it);
+  {
+    std::lock_guard<std::mutex> lock(m_ObserversMutex);
+    it = m_Observers.erase(it);
+  }
 
   for (auto observer : m_Observers)
   {
@@ -254,5 +266,6 @@ void mitk::RESTManager::DeleteFromServerMap(const int port)
 
 void mitk::RESTManager::SetObservers(const std::pair<int, utility::string_t> key, IRESTObserver *observer)
 {
+  std::lock_guard<std::mutex> lock(m_ObserversMutex);
   m_Observers[key] = observer;
 }
@@ -12,43 +12,16 @@ found in the LICENSE file.
 
 #include "mitkACVD.h"
 #include <mitkExceptionMacro.h>
+#include <mitkThreadPool.h>
 #include <vtkIdList.h>
 #include <vtkIntArray.h>
 #include <vtkIsotropicDiscreteRemeshing.h>
-#include <vtkMultiThreader.h>
 #include <vtkPolyData.h>
 #include <vtkPolyDataNormals.h>
 #include <vtkSmartPointer.h>
 #include <vtkSurface.h>
 
-struct ClustersQuadrics
-{
-  explicit ClustersQuadrics(int size) : Elements(new double *[size]), Size(size)
-  {
-    for (int i = 0; i < size; ++i)
-    {
-      Elements[i] = new double[9];
-
-      for (int j = 0; j < 9; ++j)
-        Elements[i][j] = 0.0;
-    }
-  }
-
-  ~ClustersQuadrics()
-  {
-    for (int i = 0; i < Size; ++i)
-      delete[] Elements[i];
-
-    delete Elements;
-  }
-
-  double **Elements;
-  int Size;
-
-private:
-  ClustersQuadrics(const ClustersQuadrics &);
-  ClustersQuadrics &operator=(const ClustersQuadrics &);
-};
+#include <numeric>
 
 static void ValidateSurface(mitk::Surface::ConstPointer surface, unsigned int t)
 {
@@ -67,104 +40,141 @@ static void ValidateSurface(mitk::Surface::ConstPointer surface, unsigned int t)
     mitkThrow() << "Input surface has no polygons at time step " << t << "!";
 }
 
-mitk::Surface::Pointer mitk::ACVD::Remesh(mitk::Surface::ConstPointer surface,
-                                          unsigned int t,
-                                          int numVertices,
-                                          double gradation,
-                                          int subsampling,
-                                          double edgeSplitting,
-                                          int optimizationLevel,
-                                          bool forceManifold,
-                                          bool boundaryFixing)
+static vtkSmartPointer<vtkSurface> CreateMesh(vtkPolyData *polyData)
 {
-  ValidateSurface(surface, t);
-
-  MITK_INFO << "Start remeshing...";
-
-  vtkSmartPointer<vtkPolyData> surfacePolyData = vtkSmartPointer<vtkPolyData>::New();
-  surfacePolyData->DeepCopy(const_cast<Surface *>(surface.GetPointer())->GetVtkPolyData(t));
-
   vtkSmartPointer<vtkSurface> mesh = vtkSmartPointer<vtkSurface>::New();
 
-  mesh->CreateFromPolyData(surfacePolyData);
+  mesh->CreateFromPolyData(polyData);
   mesh->GetCellData()->Initialize();
   mesh->GetPointData()->Initialize();
 
-  mesh->DisplayMeshProperties();
+  return mesh;
+}
 
-  if (numVertices == 0)
-    numVertices = surfacePolyData->GetNumberOfPoints();
+static vtkSmartPointer<vtkSurface> PrepareMesh(mitk::Surface::ConstPointer surface, unsigned int t, double edgeSplitting)
+{
+  vtkSmartPointer<vtkPolyData> surfacePolyData = vtkSmartPointer<vtkPolyData>::New();
+  surfacePolyData->DeepCopy(const_cast<mitk::Surface *>(surface.GetPointer())->GetVtkPolyData(t));
+
+  vtkSmartPointer<vtkSurface> mesh = CreateMesh(surfacePolyData);
+
+  mesh->DisplayMeshProperties();
 
   if (edgeSplitting != 0.0)
     mesh->SplitLongEdges(edgeSplitting);
 
-  vtkSmartPointer<vtkIsotropicDiscreteRemeshing> remesher = vtkSmartPointer<vtkIsotropicDiscreteRemeshing>::New();
+  return mesh;
+}
 
-  remesher->GetMetric()->SetGradation(gradation);
-  remesher->SetBoundaryFixing(boundaryFixing);
-  remesher->SetConsoleOutput(1);
-  remesher->SetForceManifold(forceManifold);
-  remesher->SetInput(mesh);
-  remesher->SetNumberOfClusters(numVertices);
-  remesher->SetNumberOfThreads(vtkMultiThreader::GetGlobalDefaultNumberOfThreads());
-  remesher->SetSubsamplingThreshold(subsampling);
+// Moves every vertex of the remeshed surface to the point that minimizes the quadric error of its cluster
+static void OptimizeVertices(vtkIsotropicDiscreteRemeshing *remesher, int numVertices, int optimizationLevel)
+{
+  vtkIntArray *clustering = remesher->GetClustering();
+  vtkSurface *remesherInput = remesher->GetInput();
+  const bool clusteringVertices = remesher->GetClusteringType() != 0;
+  const int numItems = remesher->GetNumberOfItems();
 
-  remesher->Remesh();
+  // Sort the items by cluster so that the quadrics of different clusters can be accumulated in parallel
+  std::vector<int> clusterOffsets(numVertices + 1, 0);
+  int numMisclassifiedItems = 0;
 
-  // Optimization: Minimize distance between input surface and remeshed surface
-  if (optimizationLevel != 0)
+  for (int i = 0; i < numItems; ++i)
   {
-    ClustersQuadrics clustersQuadrics(numVertices);
+    int cluster = clustering->GetValue(i);
+
+    if (cluster >= 0 && cluster < numVertices)
+      ++clusterOffsets[cluster + 1];
+    else
+      ++numMisclassifiedItems;
+  }
 
+  if (numMisclassifiedItems != 0)
+    std::cout << numMisclassifiedItems << " items with wrong cluster association" << std::endl;
+
+  std::partial_sum(clusterOffsets.begin(), clusterOffsets.end(), clusterOffsets.begin());
+
+  std::vector<int> clusterItems(clusterOffsets.back());
+  std::vector<int> insertPositions(clusterOffsets.begin(), clusterOffsets.end() - 1);
+
+  for (int i = 0; i < numItems; ++i)
+  {
+    int cluster = clustering->GetValue(i);
+
+    if (cluster >= 0 && cluster < numVertices)
+      clusterItems[insertPositions[cluster]++] = i;
+  }
+
+  vtkSurface *remesherOutput = remesher->GetOutput();
+  std::vector<double> points(3 * static_cast<std::size_t>(numVertices));
+
+  mitk::ThreadPool::GetInstance().ParallelFor(0, numVertices, [&](std::size_t begin, std::size_t end) {
     vtkSmartPointer<vtkIdList> faceList = vtkSmartPointer<vtkIdList>::New();
-    vtkSmartPointer<vtkIntArray> clustering = remesher->GetClustering();
-    vtkSmartPointer<vtkSurface> remesherInput = remesher->GetInput();
-    int clusteringType = remesher->GetClusteringType();
-    int numItems = remesher->GetNumberOfItems();
-    int numMisclassifiedItems = 0;
+    double quadric[9];
 
-    for (int i = 0; i < numItems; ++i)
+    for (auto cluster = begin; cluster < end; ++cluster)
     {
-      int cluster = clustering->GetValue(i);
+      std::fill(quadric, quadric + 9, 0.0);
 
-      if (cluster >= 0 && cluster < numVertices)
+      for (int j = clusterOffsets[cluster]; j < clusterOffsets[cluster + 1]; ++j)
       {
-        if (clusteringType != 0)
+        if (clusteringVertices)
         {
-          remesherInput->GetVertexNeighbourFaces(i, faceList);
+          remesherInput->GetVertexNeighbourFaces(clusterItems[j], faceList);
           int numIds = static_cast<int>(faceList->GetNumberOfIds());
 
-          for (int j = 0; j < numIds; ++j)
-            vtkQuadricTools::AddTriangleQuadric(
-              clustersQuadrics.Elements[cluster], remesherInput, faceList->GetId(j), false);
+          for (int k = 0; k < numIds; ++k)
+            vtkQuadricTools::AddTriangleQuadric(quadric, remesherInput, faceList->GetId(k), false);
         }
         else
         {
-          vtkQuadricTools::AddTriangleQuadric(clustersQuadrics.Elements[cluster], remesherInput, i, false);
+          vtkQuadricTools::AddTriangleQuadric(quadric, remesherInput, clusterItems[j], false);
         }
       }
-      else
-      {
-        ++numMisclassifiedItems;
-      }
+
+      double *point = &points[3 * cluster];
+      remesherOutput->GetPoint(static_cast<vtkIdType>(cluster), point);
+      vtkQuadricTools::ComputeRepresentativePoint(quadric, point, optimizationLevel);
     }
+  }, 256);
 
-    if (numMisclassifiedItems != 0)
-      std::cout << numMisclassifiedItems << " items with wrong cluster association" << std::endl;
+  for (int i = 0; i < numVertices; ++i)
+    remesherOutput->SetPointCoordinates(i, &points[3 * i]);
 
-    vtkSmartPointer<vtkSurface> remesherOutput = remesher->GetOutput();
-    double point[3];
+  std::cout << "After quadrics post-processing:" << std::endl;
+  remesherOutput->DisplayMeshProperties();
+}
 
-    for (int i = 0; i < numVertices; ++i)
-    {
-      remesherOutput->GetPoint(i, point);
-      vtkQuadricTools::ComputeRepresentativePoint(clustersQuadrics.Elements[i], point, optimizationLevel);
-      remesherOutput->SetPointCoordinates(i, point);
-    }
+// Remeshes the prepared mesh. The input of the returned remesher is the mesh after ACVD's subsampling.
+static vtkSmartPointer<vtkIsotropicDiscreteRemeshing> RemeshMesh(vtkSurface *mesh,
+                                                                 int numVertices,
+                                                                 double gradation,
+                                                                 int subsampling,
+                                                                 bool forceManifold,
+                                                                 bool boundaryFixing)
+{
+  vtkSmartPointer<vtkIsotropicDiscreteRemeshing> remesher = vtkSmartPointer<vtkIsotropicDiscreteRemeshing>::New();
 
-    std::cout << "After quadrics post-processing:" << std::endl;
-    remesherOutput->DisplayMeshProperties();
-  }
+  remesher->GetMetric()->SetGradation(gradation);
+  remesher->SetBoundaryFixing(boundaryFixing);
+  remesher->SetConsoleOutput(1);
+  remesher->SetForceManifold(forceManifold);
+  remesher->SetInput(mesh);
+  remesher->SetNumberOfClusters(numVertices);
+  remesher->SetNumberOfThreads(mitk::ThreadPool::GetInstance().GetNumberOfThreads());
+  remesher->SetSubsamplingThreshold(subsampling);
+
+  remesher->Remesh();
+
+  return remesher;
+}
+
+static mitk::Surface::Pointer CreateRemeshedSurface(vtkIsotropicDiscreteRemeshing *remesher,
+                                                    int numVertices,
+                                                    int optimizationLevel)
+{
+  // Optimization: Minimize distance between input surface and remeshed surface
+  if (optimizationLevel != 0)
+    OptimizeVertices(remesher, numVertices, optimizationLevel);
 
   vtkSmartPointer<vtkPolyDataNormals> normals = vtkSmartPointer<vtkPolyDataNormals>::New();
 
@@ -179,9 +189,36 @@ mitk::Surface::Pointer mitk::ACVD::Remesh(mitk::Surface::ConstPointer surface,
 
   normals->Update();
 
-  Surface::Pointer remeshedSurface = Surface::New();
+  mitk::Surface::Pointer remeshedSurface = mitk::Surface::New();
   remeshedSurface->SetVtkPolyData(normals->GetOutput());
 
+  return remeshedSurface;
+}
+
+mitk::Surface::Pointer mitk::ACVD::Remesh(mitk::Surface::ConstPointer surface,
+                                          unsigned int t,
+                                          int numVertices,
+                                          double gradation,
+                                          int subsampling,
+                                          double edgeSplitting,
+                                          int optimizationLevel,
+                                          bool forceManifold,
+                                          bool boundaryFixing)
+{
+  ValidateSurface(surface, t);
+
+  MITK_INFO << "Start remeshing...";
+
+  vtkSmartPointer<vtkSurface> mesh = PrepareMesh(surface, t, edgeSplitting);
+
+  if (numVertices == 0)
+    numVertices = const_cast<Surface *>(surface.GetPointer())->GetVtkPolyData(t)->GetNumberOfPoints();
+
+  vtkSmartPointer<vtkIsotropicDiscreteRemeshing> remesher =
+    RemeshMesh(mesh, numVertices, gradation, subsampling, forceManifold, boundaryFixing);
+
+  Surface::Pointer remeshedSurface = CreateRemeshedSurface(remesher, numVertices, optimizationLevel);
+
   MITK_INFO << "Finished remeshing";
 
   return remeshedSurface;
@@ -195,7 +232,11 @@ mitk::ACVD::RemeshFilter::RemeshFilter()
     m_EdgeSplitting(0.0),
     m_OptimizationLevel(1),
     m_ForceManifold(false),
-    m_BoundaryFixing(false)
+    m_BoundaryFixing(false),
+    m_PreparedSurface(nullptr),
+    m_PreparedSurfaceMTime(0),
+    m_PreparedTimeStep(0),
+    m_PreparedEdgeSplitting(0.0)
 {
   Surface::Pointer output = Surface::New();
   this->SetNthOutput(0, output);
@@ -207,14 +248,69 @@ mitk::ACVD::RemeshFilter::~RemeshFilter()
 
 void mitk::ACVD::RemeshFilter::GenerateData()
 {
-  Surface::Pointer output = Remesh(this->GetInput(),
-                                   m_TimeStep,
-                                   m_NumVertices,
-                                   m_Gradation,
-                                   m_Subsampling,
-                                   m_EdgeSplitting,
-                                   m_OptimizationLevel,
-                                   m_ForceManifold,
-                                   m_BoundaryFixing);
+  Surface::ConstPointer input = this->GetInput();
+  ValidateSurface(input, m_TimeStep);
+
+  MITK_INFO << "Start remeshing...";
+
+  vtkPolyData *polyData = const_cast<Surface *>(input.GetPointer())->GetVtkPolyData(m_TimeStep);
+  const itk::ModifiedTimeType inputMTime = std::max<itk::ModifiedTimeType>(input->GetMTime(), polyData->GetMTime());
+
+  if (m_PreparedMeshes.empty() || m_PreparedSurface != input || m_PreparedSurfaceMTime != inputMTime ||
+      m_PreparedTimeStep != m_TimeStep || m_PreparedEdgeSplitting != m_EdgeSplitting)
+  {
+    m_PreparedMeshes.clear();
+    m_PreparedMeshes.push_back(PreparedMesh{PrepareMesh(input, m_TimeStep, m_EdgeSplitting), 0});
+
+    m_PreparedSurface = input;
+    m_PreparedSurfaceMTime = inputMTime;
+    m_PreparedTimeStep = m_TimeStep;
+    m_PreparedEdgeSplitting = m_EdgeSplitting;
+  }
+
+  const int numVertices = m_NumVertices != 0 ? m_NumVertices : static_cast<int>(polyData->GetNumberOfPoints());
+
+  // ACVD subdivides its input until it has at least subsampling * numVertices points. A subdivided mesh of an
+  // earlier run is reused if ACVD would create exactly this mesh for the current parameters, too.
+  const vtkIdType requiredNumberOfPoints = static_cast<vtkIdType>(m_Subsampling) * numVertices;
+  const PreparedMesh *mesh = &m_PreparedMeshes.front();
+
+  for (const auto &subsampledMesh : m_PreparedMeshes)
+  {
+    if (subsampledMesh.MinimumRequiredNumberOfPoints <= requiredNumberOfPoints &&
+        requiredNumberOfPoints <= subsampledMesh.Mesh->GetNumberOfPoints())
+    {
+      mesh = &subsampledMesh;
+      break;
+    }
+  }
+
+  if (mesh != &m_PreparedMeshes.front())
+    MITK_INFO << "Reusing subsampled mesh with " << mesh->Mesh->GetNumberOfPoints() << " points";
+
+  vtkSmartPointer<vtkIsotropicDiscreteRemeshing> remesher =
+    RemeshMesh(CreateMesh(mesh->Mesh), numVertices, m_Gradation, m_Subsampling, m_ForceManifold, m_BoundaryFixing);
+
+  if (mesh == &m_PreparedMeshes.front() && requiredNumberOfPoints > mesh->Mesh->GetNumberOfPoints())
+  {
+    vtkSurface *subsampledInput = remesher->GetInput();
+    auto cachedMesh = std::find_if(m_PreparedMeshes.begin() + 1, m_PreparedMeshes.end(), [&](const PreparedMesh &preparedMesh) {
+      return preparedMesh.Mesh->GetNumberOfPoints() == subsampledInput->GetNumberOfPoints();
+    });
+
+    if (cachedMesh != m_PreparedMeshes.end())
+    {
+      cachedMesh->MinimumRequiredNumberOfPoints = std::min(cachedMesh->MinimumRequiredNumberOfPoints, requiredNumberOfPoints);
+    }
+    else
+    {
+      m_PreparedMeshes.push_back(PreparedMesh{CreateMesh(subsampledInput), requiredNumberOfPoints});
+    }
+  }
+
+  Surface::Pointer output = CreateRemeshedSurface(remesher, numVertices, m_OptimizationLevel);
+
+  MITK_INFO << "Finished remeshing";
+
   this->SetNthOutput(0, output);
 }
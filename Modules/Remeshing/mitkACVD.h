@@ -16,6 +16,9 @@ found in the LICENSE file.
 #include <MitkRemeshingExports.h>
 #include <mitkSurface.h>
 #include <mitkSurfaceToSurfaceFilter.h>
+#include <vtkSmartPointer.h>
+
+class vtkSurface;
 
 namespace mitk
 {
@@ -63,6 +66,10 @@ namespace mitk
                                                  bool boundaryFixing = false);
 
     /** \brief Encapsulates mitk::ACVD::Remesh function as filter.
+     *
+     * The filter keeps the prepared input mesh (including split edges) and the subsampled meshes created by %ACVD
+     * as long as input, time step and edge splitting do not change. Updating the filter with another number of
+     * vertices or subsampling therefore only repeats the clustering if the required subsampled mesh is known.
      */
     class MITKREMESHING_EXPORT RemeshFilter : public mitk::SurfaceToSurfaceFilter
     {
@@ -94,6 +101,18 @@ namespace mitk
       int m_OptimizationLevel;
       bool m_ForceManifold;
       bool m_BoundaryFixing;
+
+      struct PreparedMesh
+      {
+        vtkSmartPointer<vtkSurface> Mesh;
+        vtkIdType MinimumRequiredNumberOfPoints; ///< Smallest subsampling * numVertices known to result in Mesh
+      };
+
+      std::vector<PreparedMesh> m_PreparedMeshes;
+      const Surface *m_PreparedSurface;
+      itk::ModifiedTimeType m_PreparedSurfaceMTime;
+      unsigned int m_PreparedTimeStep;
+      double m_PreparedEdgeSplitting;
     };
   }
 }
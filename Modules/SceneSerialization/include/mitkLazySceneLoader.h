@@ -0,0 +1,141 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkLazySceneLoader_h
+#define mitkLazySceneLoader_h
+
+#include <MitkSceneSerializationExports.h>
+
+#include <mitkBaseData.h>
+#include <mitkDataNode.h>
+#include <mitkWeakPointer.h>
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mitk
+{
+  /**
+    \brief Loads the BaseData objects of a scene that was opened with SceneIO::SetLazyLoading(true).
+
+    With lazy loading, SceneIO::LoadScene() creates all nodes with their properties and relations right away, but
+    without their BaseData. The loader keeps the unzipped scene files and reads the data of a node
+
+    - on first access, i.e. when LoadData() is called for the node,
+    - on first visibility, i.e. when the "visible" property of the node is switched on,
+    - in the background after StartBackgroundLoading(), visible nodes first.
+
+    Data read in the background still has to be assigned to its node, which must happen on the main thread since it
+    triggers the events of the node. ApplyLoadedData() does this and should be called regularly on the main thread
+    (e.g. from a timer of the application) while background loading is running.
+
+    The unzipped scene files are removed once the data of all nodes has been loaded, or when the loader is destroyed.
+    Nodes whose data has not been loaded until then keep no data.
+  */
+  class MITKSCENESERIALIZATION_EXPORT LazySceneLoader : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(LazySceneLoader, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    /**
+      \brief Registers a node whose data is read from dataFile when needed. Used by the scene readers.
+      \param dataPropertiesFile the file with the properties of the BaseData object, or an empty string.
+    */
+    void AddNode(DataNode *node, const std::string &dataFile, const std::string &dataPropertiesFile);
+
+    /**
+      \brief Directory containing the unzipped scene, which is removed when it is no longer needed.
+    */
+    void SetTemporaryDirectory(const std::string &directory);
+
+    /**
+      \brief Returns whether the data of the node has not been assigned yet.
+    */
+    bool IsPending(const DataNode *node) const;
+
+    std::size_t GetNumberOfPendingNodes() const;
+
+    /**
+      \brief Reads the data of the node (unless it was already read in the background) and assigns it.
+
+      Blocks until the data has been read. Must be called on the main thread.
+      \return false if the data could not be read. Nodes that do not belong to this loader are ignored (true).
+    */
+    bool LoadData(DataNode *node);
+
+    /**
+      \brief Loads the data of all nodes that are still pending.
+    */
+    void LoadAll();
+
+    /**
+      \brief Starts reading the data of all pending nodes on a background thread, visible nodes first.
+    */
+    void StartBackgroundLoading();
+
+    /**
+      \brief Assigns the data that has been read in the background to the nodes. Must be called on the main thread.
+      \return the number of nodes that got their data.
+    */
+    unsigned int ApplyLoadedData();
+
+  protected:
+    LazySceneLoader();
+    ~LazySceneLoader() override;
+
+  private:
+    enum class LoadState
+    {
+      Pending,
+      Reading,
+      Read,
+      Applied
+    };
+
+    struct Entry
+    {
+      WeakPointer<DataNode> Node;
+      std::string DataFile;
+      std::string DataPropertiesFile;
+      LoadState State;
+      BaseData::Pointer Data;
+      BaseProperty::Pointer VisibleProperty;
+      unsigned long VisibleObserverTag;
+    };
+
+    static BaseData::Pointer ReadData(const std::string &dataFile);
+
+    void BackgroundLoading();
+    void Apply(std::size_t entryIndex);
+    void OnVisibleModified(const itk::Object *caller, const itk::EventObject &event);
+    void StopBackgroundLoading();
+    void RemoveTemporaryDirectory();
+
+    std::vector<Entry> m_Entries;
+    std::map<const DataNode *, std::size_t> m_EntryIndices;
+    std::vector<std::size_t> m_BackgroundLoadOrder;
+    std::size_t m_NumberOfPendingNodes;
+    std::string m_TemporaryDirectory;
+
+    mutable std::mutex m_Mutex;
+    std::condition_variable m_EntryRead;
+    std::thread m_BackgroundThread;
+    bool m_StopBackgroundLoading;
+  };
+}
+
+#endif
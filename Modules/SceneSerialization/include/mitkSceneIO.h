@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include <MitkSceneSerializationExports.h>
 
 #include "mitkDataStorage.h"
+#include "mitkLazySceneLoader.h"
 #include "mitkNodePredicateBase.h"
 
 #include <Poco/Zip/ZipLocalFileHeader.h>
@@ -25,6 +26,7 @@ class TiXmlElement;
 namespace mitk
 {
   class BaseData;
+  class BaseDataSerializer;
   class PropertyList;
 
   class MITKSCENESERIALIZATION_EXPORT SceneIO : public itk::Object
@@ -111,6 +113,43 @@ namespace mitk
      */
     const PropertyList *GetFailedProperties();
 
+    /**
+     * \brief Number of threads that serialize the BaseData objects of a scene concurrently in SaveScene().
+     *
+     * The default of 0 uses one thread per hardware thread. Set it to 1 if a serializer of the saved data types is
+     * not thread-safe.
+     */
+    itkSetMacro(NumberOfThreads, unsigned int);
+    itkGetConstMacro(NumberOfThreads, unsigned int);
+
+    /**
+     * \brief Defines whether files which are already compressed by their writers (e.g. the NRRD files of images or
+     * the VTK XML files of surfaces) are stored in the scene file without compressing them again.
+     *
+     * Compressing these files once more hardly reduces their size but dominates the time to save large scenes.
+     * Enabled by default.
+     */
+    itkSetMacro(StoreCompressedFiles, bool);
+    itkGetConstMacro(StoreCompressedFiles, bool);
+    itkBooleanMacro(StoreCompressedFiles);
+
+    /**
+     * \brief Defines whether LoadScene() and LoadSceneUnzipped() defer reading the BaseData objects.
+     *
+     * If enabled, the nodes are created with their properties and relations, but without their data. The data is
+     * read by the LazySceneLoader of the last loaded scene (see GetLazySceneLoader()) when a node is made visible
+     * or LazySceneLoader::LoadData() is called for it. Since the loader keeps the unzipped scene files until all
+     * data has been read, it has to be kept alive as long as nodes may be loaded. Disabled by default.
+     */
+    itkSetMacro(LazyLoading, bool);
+    itkGetConstMacro(LazyLoading, bool);
+    itkBooleanMacro(LazyLoading);
+
+    /**
+     * \brief Returns the loader of the data of the last scene loaded with lazy loading, or nullptr.
+     */
+    LazySceneLoader *GetLazySceneLoader() const;
+
   protected:
     SceneIO();
     ~SceneIO() override;
@@ -118,6 +157,11 @@ namespace mitk
     std::string CreateEmptyTempDirectory();
 
     TiXmlElement *SaveBaseData(BaseData *data, const std::string &filenamehint, bool &error);
+
+    /**
+     * \brief Returns a serializer for the data that writes into the working directory, or nullptr if there is none.
+     */
+    itk::SmartPointer<BaseDataSerializer> CreateBaseDataSerializer(BaseData *data, const std::string &filenamehint);
     TiXmlElement *SavePropertyList(PropertyList *propertyList, const std::string &filenamehint);
 
     void OnUnzipError(const void *pSender, std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string> &info);
@@ -128,6 +172,12 @@ namespace mitk
 
     std::string m_WorkingDirectory;
     unsigned int m_UnzipErrors;
+
+    unsigned int m_NumberOfThreads;
+    bool m_StoreCompressedFiles;
+
+    bool m_LazyLoading;
+    LazySceneLoader::Pointer m_LazySceneLoader;
   };
 }
 
@@ -17,6 +17,7 @@ found in the LICENSE file.
 #include <itkObjectFactory.h>
 
 #include "mitkDataStorage.h"
+#include "mitkLazySceneLoader.h"
 
 namespace mitk
 {
@@ -28,5 +29,14 @@ namespace mitk
     itkCloneMacro(Self);
 
       virtual bool LoadScene(TiXmlDocument &document, const std::string &workingDirectory, DataStorage *storage);
+
+    /**
+      \brief If a loader is set, the BaseData objects are not read but registered with the loader.
+    */
+    itkSetObjectMacro(LazySceneLoader, LazySceneLoader);
+    itkGetObjectMacro(LazySceneLoader, LazySceneLoader);
+
+  protected:
+    LazySceneLoader::Pointer m_LazySceneLoader;
   };
 }
@@ -0,0 +1,380 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkLazySceneLoader.h"
+
+#include "mitkPropertyListDeserializer.h"
+#include "mitkSceneIOParallelFor.h"
+#include "mitkSceneReaderV1.h"
+
+#include <mitkIOUtil.h>
+#include <mitkLocaleSwitch.h>
+#include <mitkProperties.h>
+
+#include <itkCommand.h>
+
+#include <Poco/File.h>
+
+mitk::LazySceneLoader::LazySceneLoader() : m_NumberOfPendingNodes(0), m_StopBackgroundLoading(false)
+{
+}
+
+mitk::LazySceneLoader::~LazySceneLoader()
+{
+  this->StopBackgroundLoading();
+
+  for (auto &entry : m_Entries)
+  {
+    if (entry.VisibleProperty.IsNotNull())
+      entry.VisibleProperty->RemoveObserver(entry.VisibleObserverTag);
+  }
+
+  this->RemoveTemporaryDirectory();
+}
+
+void mitk::LazySceneLoader::AddNode(DataNode *node, const std::string &dataFile, const std::string &dataPropertiesFile)
+{
+  if (node == nullptr)
+    return;
+
+  Entry entry;
+  entry.Node = node;
+  entry.DataFile = dataFile;
+  entry.DataPropertiesFile = dataPropertiesFile;
+  entry.State = LoadState::Pending;
+  entry.VisibleObserverTag = 0;
+
+  // load the data as soon as the node is made visible
+  entry.VisibleProperty = node->GetProperty("visible", nullptr, false);
+  if (entry.VisibleProperty.IsNotNull())
+  {
+    auto command = itk::MemberCommand<LazySceneLoader>::New();
+    command->SetCallbackFunction(this, &LazySceneLoader::OnVisibleModified);
+    entry.VisibleObserverTag = entry.VisibleProperty->AddObserver(itk::ModifiedEvent(), command);
+  }
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_EntryIndices[node] = m_Entries.size();
+  m_Entries.push_back(entry);
+  ++m_NumberOfPendingNodes;
+}
+
+void mitk::LazySceneLoader::SetTemporaryDirectory(const std::string &directory)
+{
+  m_TemporaryDirectory = directory;
+}
+
+bool mitk::LazySceneLoader::IsPending(const DataNode *node) const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  auto indexIter = m_EntryIndices.find(node);
+  return indexIter != m_EntryIndices.end() && m_Entries[indexIter->second].State != LoadState::Applied;
+}
+
+std::size_t mitk::LazySceneLoader::GetNumberOfPendingNodes() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfPendingNodes;
+}
+
+bool mitk::LazySceneLoader::LoadData(DataNode *node)
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  auto indexIter = m_EntryIndices.find(node);
+  if (indexIter == m_EntryIndices.end())
+    return true;
+
+  const std::size_t entryIndex = indexIter->second;
+  Entry &entry = m_Entries[entryIndex];
+
+  if (entry.State == LoadState::Pending)
+  {
+    entry.State = LoadState::Reading;
+    const std::string dataFile = entry.DataFile;
+    lock.unlock();
+
+    BaseData::Pointer data;
+    {
+      LocaleSwitch localeSwitch("C");
+      data = ReadData(dataFile);
+    }
+
+    lock.lock();
+    entry.Data = data;
+    entry.State = LoadState::Read;
+  }
+  else if (entry.State == LoadState::Reading)
+  {
+    // the background thread is just reading this node
+    m_EntryRead.wait(lock, [&entry]() { return entry.State != LoadState::Reading; });
+  }
+
+  if (entry.State == LoadState::Applied)
+    return node->GetData() != nullptr;
+
+  lock.unlock();
+  this->Apply(entryIndex);
+
+  return node->GetData() != nullptr;
+}
+
+void mitk::LazySceneLoader::LoadAll()
+{
+  this->StopBackgroundLoading();
+
+  std::vector<std::size_t> pendingEntries;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (std::size_t i = 0; i < m_Entries.size(); ++i)
+    {
+      if (m_Entries[i].State == LoadState::Pending)
+      {
+        m_Entries[i].State = LoadState::Reading;
+        pendingEntries.push_back(i);
+      }
+    }
+  }
+
+  {
+    LocaleSwitch localeSwitch("C");
+    SceneIOParallelFor(pendingEntries.size(), 0, [this, &pendingEntries](std::size_t i) {
+      Entry &entry = m_Entries[pendingEntries[i]];
+      BaseData::Pointer data = ReadData(entry.DataFile);
+
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      entry.Data = data;
+      entry.State = LoadState::Read;
+    });
+  }
+
+  this->ApplyLoadedData();
+}
+
+void mitk::LazySceneLoader::StartBackgroundLoading()
+{
+  if (m_BackgroundThread.joinable())
+    return;
+
+  // the nodes that are visible right now are loaded first
+  std::vector<std::size_t> hiddenEntries;
+  m_BackgroundLoadOrder.clear();
+  for (std::size_t i = 0; i < m_Entries.size(); ++i)
+  {
+    DataNode::Pointer node = m_Entries[i].Node.Lock();
+    if (node.IsNull() || m_Entries[i].State != LoadState::Pending)
+      continue;
+
+    if (node->IsVisible(nullptr))
+      m_BackgroundLoadOrder.push_back(i);
+    else
+      hiddenEntries.push_back(i);
+  }
+  m_BackgroundLoadOrder.insert(m_BackgroundLoadOrder.end(), hiddenEntries.begin(), hiddenEntries.end());
+
+  m_StopBackgroundLoading = false;
+  m_BackgroundThread = std::thread(&LazySceneLoader::BackgroundLoading, this);
+}
+
+unsigned int mitk::LazySceneLoader::ApplyLoadedData()
+{
+  std::vector<std::size_t> readEntries;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (std::size_t i = 0; i < m_Entries.size(); ++i)
+    {
+      if (m_Entries[i].State == LoadState::Read)
+        readEntries.push_back(i);
+    }
+  }
+
+  for (auto entryIndex : readEntries)
+    this->Apply(entryIndex);
+
+  // the observers are not removed by Apply(), which may be called by the observers themselves
+  for (auto &entry : m_Entries)
+  {
+    if (entry.State == LoadState::Applied && entry.VisibleProperty.IsNotNull())
+    {
+      entry.VisibleProperty->RemoveObserver(entry.VisibleObserverTag);
+      entry.VisibleProperty = nullptr;
+    }
+  }
+
+  if (this->GetNumberOfPendingNodes() == 0)
+  {
+    this->StopBackgroundLoading();
+    this->RemoveTemporaryDirectory();
+  }
+
+  return static_cast<unsigned int>(readEntries.size());
+}
+
+mitk::BaseData::Pointer mitk::LazySceneLoader::ReadData(const std::string &dataFile)
+{
+  try
+  {
+    std::vector<BaseData::Pointer> baseData = IOUtil::Load(dataFile);
+    if (baseData.size() > 1)
+    {
+      MITK_WARN << "Discarding multiple base data results from " << dataFile << " except the first one.";
+    }
+    if (!baseData.empty() && baseData.front().IsNotNull())
+    {
+      return baseData.front();
+    }
+    MITK_ERROR << "Error during attempt to read '" << dataFile << "'. Factory returned nullptr object.";
+  }
+  catch (std::exception &e)
+  {
+    MITK_ERROR << "Error during attempt to read '" << dataFile << "'. Exception says: " << e.what();
+  }
+  catch (...)
+  {
+    MITK_ERROR << "Error during attempt to read '" << dataFile << "'.";
+  }
+
+  return nullptr;
+}
+
+void mitk::LazySceneLoader::BackgroundLoading()
+{
+  std::size_t position = 0;
+  for (;;)
+  {
+    std::size_t entryIndex = 0;
+    std::string dataFile;
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      while (position < m_BackgroundLoadOrder.size() &&
+             m_Entries[m_BackgroundLoadOrder[position]].State != LoadState::Pending)
+      {
+        ++position;
+      }
+
+      if (m_StopBackgroundLoading || position == m_BackgroundLoadOrder.size())
+        return;
+
+      entryIndex = m_BackgroundLoadOrder[position];
+      m_Entries[entryIndex].State = LoadState::Reading;
+      dataFile = m_Entries[entryIndex].DataFile;
+    }
+
+    BaseData::Pointer data = ReadData(dataFile);
+
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Entries[entryIndex].Data = data;
+      m_Entries[entryIndex].State = LoadState::Read;
+    }
+    m_EntryRead.notify_all();
+  }
+}
+
+void mitk::LazySceneLoader::Apply(std::size_t entryIndex)
+{
+  Entry &entry = m_Entries[entryIndex];
+
+  BaseData::Pointer data;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (entry.State != LoadState::Read)
+      return;
+
+    data = entry.Data;
+    entry.Data = nullptr;
+    entry.State = LoadState::Applied;
+    --m_NumberOfPendingNodes;
+  }
+
+  DataNode::Pointer node = entry.Node.Lock();
+  if (node.IsNull() || data.IsNull())
+    return;
+
+  LocaleSwitch localeSwitch("C");
+
+  if (!entry.DataPropertiesFile.empty())
+  {
+    PropertyListDeserializer::Pointer propertyDeserializer = PropertyListDeserializer::New();
+    propertyDeserializer->SetFilename(entry.DataPropertiesFile);
+    if (propertyDeserializer->Deserialize() && propertyDeserializer->GetOutput().IsNotNull())
+    {
+      data->SetPropertyList(propertyDeserializer->GetOutput());
+    }
+    else
+    {
+      MITK_ERROR << "Could not read the BaseData properties from " << entry.DataPropertiesFile;
+    }
+  }
+
+  // SetData() adds default properties, which were not stored in the scene. Like SceneReaderV1, only keep the
+  // stored properties (and the exceptions of SceneReaderV1::ClearNodePropertyListWithExceptions()).
+  std::map<std::string, PropertyList::Pointer> storedPropertyLists;
+  storedPropertyLists[""] = node->GetPropertyList()->Clone();
+  for (const auto &renderWindowName : node->GetPropertyListNames())
+    storedPropertyLists[renderWindowName] = node->GetPropertyList(renderWindowName)->Clone();
+
+  node->SetData(data);
+
+  for (const auto &storedPropertyList : storedPropertyLists)
+  {
+    PropertyList::Pointer propertyList = node->GetPropertyList(storedPropertyList.first);
+    SceneReaderV1::ClearNodePropertyListWithExceptions(*node, *propertyList);
+    propertyList->ConcatenatePropertyList(storedPropertyList.second, true);
+  }
+}
+
+void mitk::LazySceneLoader::OnVisibleModified(const itk::Object *caller, const itk::EventObject &)
+{
+  const auto *visibleProperty = dynamic_cast<const BoolProperty *>(caller);
+  if (visibleProperty == nullptr || !visibleProperty->GetValue())
+    return;
+
+  for (auto &entry : m_Entries)
+  {
+    if (entry.VisibleProperty.GetPointer() == caller && entry.State != LoadState::Applied)
+    {
+      DataNode::Pointer node = entry.Node.Lock();
+      if (node.IsNotNull())
+        this->LoadData(node);
+      return;
+    }
+  }
+}
+
+void mitk::LazySceneLoader::StopBackgroundLoading()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_StopBackgroundLoading = true;
+  }
+
+  if (m_BackgroundThread.joinable())
+    m_BackgroundThread.join();
+}
+
+void mitk::LazySceneLoader::RemoveTemporaryDirectory()
+{
+  if (m_TemporaryDirectory.empty())
+    return;
+
+  try
+  {
+    Poco::File deleteDir(m_TemporaryDirectory);
+    deleteDir.remove(true); // recursive
+  }
+  catch (...)
+  {
+    MITK_ERROR << "Could not delete temporary directory " << m_TemporaryDirectory;
+  }
+
+  m_TemporaryDirectory.clear();
+}
@@ -19,6 +19,7 @@ found in the LICENSE file.
 #include "mitkBaseDataSerializer.h"
 #include "mitkPropertyListSerializer.h"
 #include "mitkSceneIO.h"
+#include "mitkSceneIOParallelFor.h"
 #include "mitkSceneReader.h"
 
 #include "mitkBaseRenderer.h"
@@ -34,11 +35,33 @@ found in the LICENSE file.
 
 #include <fstream>
 #include <mitkIOUtil.h>
+#include <set>
 #include <sstream>
+#include <vector>
 
 #include "itksys/SystemTools.hxx"
 
-mitk::SceneIO::SceneIO() : m_WorkingDirectory(""), m_UnzipErrors(0)
+namespace
+{
+  /** BaseData object of a node, whose serialization is deferred until all nodes have been visited.*/
+  struct BaseDataSerializationJob
+  {
+    mitk::DataNode *Node;
+    TiXmlElement *Element;
+    mitk::BaseDataSerializer::Pointer Serializer;
+    std::string FileName;
+    bool Error;
+  };
+
+  /** Extensions of files whose writers already compress them.*/
+  std::set<std::string> GetCompressedFileExtensions()
+  {
+    return { "nrrd", "vtp", "vti", "png", "jpg", "jpeg", "gz", "zip" };
+  }
+}
+
+mitk::SceneIO::SceneIO()
+  : m_WorkingDirectory(""), m_UnzipErrors(0), m_NumberOfThreads(0), m_StoreCompressedFiles(true), m_LazyLoading(false)
 {
 }
 
@@ -142,15 +165,23 @@ mitk::DataStorage::Pointer mitk::SceneIO::LoadScene(const std::string &filename,
   auto indexFile = m_WorkingDirectory + mitk::IOUtil::GetDirectorySeparator() + "index.xml";
   storage = LoadSceneUnzipped(indexFile, storage, clearStorageFirst);
 
-  // delete temp directory
-  try
+  if (m_LazySceneLoader.IsNotNull() && m_LazySceneLoader->GetNumberOfPendingNodes() > 0)
   {
-    Poco::File deleteDir(m_WorkingDirectory);
-    deleteDir.remove(true); // recursive
+    // the files are still needed and the loader deletes them once all data has been read
+    m_LazySceneLoader->SetTemporaryDirectory(m_WorkingDirectory);
   }
-  catch (...)
+  else
   {
-    MITK_ERROR << "Could not delete temporary directory " << m_WorkingDirectory;
+    // delete temp directory
+    try
+    {
+      Poco::File deleteDir(m_WorkingDirectory);
+      deleteDir.remove(true); // recursive
+    }
+    catch (...)
+    {
+      MITK_ERROR << "Could not delete temporary directory " << m_WorkingDirectory;
+    }
   }
 
   // return new data storage, even if empty or uncomplete (return as much as possible but notify calling method)
@@ -204,7 +235,12 @@ mitk::DataStorage::Pointer mitk::SceneIO::LoadSceneUnzipped(const std::string &i
     return storage;
   }
 
+  m_LazySceneLoader = nullptr;
+  if (m_LazyLoading)
+    m_LazySceneLoader = LazySceneLoader::New();
+
   SceneReader::Pointer reader = SceneReader::New();
+  reader->SetLazySceneLoader(m_LazySceneLoader);
   if (!reader->LoadScene(document, workingDir, storage))
   {
     MITK_ERROR << "There were errors while loading scene file " << indexfilename << ". Your data may be corrupted";
@@ -214,6 +250,11 @@ mitk::DataStorage::Pointer mitk::SceneIO::LoadSceneUnzipped(const std::string &i
   return storage;
 }
 
+mitk::LazySceneLoader *mitk::SceneIO::GetLazySceneLoader() const
+{
+  return m_LazySceneLoader.GetPointer();
+}
+
 bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes,
                               const DataStorage *storage,
                               const std::string &filename)
@@ -321,6 +362,9 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
         }
       }
 
+      // the files of the BaseData objects are written after visiting all nodes, concurrently
+      std::vector<BaseDataSerializationJob> serializationJobs;
+
       // write out objects, dependencies and properties
       for (auto iter = sceneNodes->begin(); iter != sceneNodes->end(); ++iter)
       {
@@ -358,13 +402,11 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
           // store basedata
           if (BaseData *data = node->GetData())
           {
-            // std::string filenameHint( node->GetName() );
-            bool error(false);
-            TiXmlElement *dataElement(SaveBaseData(data, filenameHint, error)); // returns a reference to a file
-            if (error)
-            {
-              m_FailedNodes->push_back(node);
-            }
+            auto *dataElement = new TiXmlElement("data");
+            dataElement->SetAttribute("type", data->GetNameOfClass());
+            BaseDataSerializationJob job = {
+              node, dataElement, this->CreateBaseDataSerializer(data, filenameHint), std::string(), true};
+            serializationJobs.push_back(job);
 
             // store basedata properties
             PropertyList *propertyList = data->GetPropertyList();
@@ -406,9 +448,41 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
         {
           MITK_WARN << "Ignoring nullptr node during scene serialization.";
         }
-
-        ProgressBar::GetInstance()->Progress();
       } // end for all nodes
+
+      SceneIOParallelFor(serializationJobs.size(), m_NumberOfThreads, [&serializationJobs](std::size_t i) {
+        BaseDataSerializationJob &job = serializationJobs[i];
+        if (job.Serializer.IsNull())
+          return;
+
+        try
+        {
+          job.FileName = job.Serializer->Serialize();
+          job.Error = false;
+        }
+        catch (std::exception &e)
+        {
+          MITK_ERROR << "Serializer " << job.Serializer->GetNameOfClass() << " failed: " << e.what();
+        }
+        catch (...)
+        {
+          MITK_ERROR << "Serializer " << job.Serializer->GetNameOfClass() << " failed.";
+        }
+      });
+
+      for (const auto &job : serializationJobs)
+      {
+        if (job.Error)
+        {
+          m_FailedNodes->push_back(job.Node);
+        }
+        else
+        {
+          job.Element->SetAttribute("file", job.FileName);
+        }
+      }
+
+      ProgressBar::GetInstance()->Progress(sceneNodes->size());
     }   // end if sceneNodes
 
     std::string defaultLocale_WorkingDirectory = Poco::Path::transcode( m_WorkingDirectory );
@@ -439,6 +513,10 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
         else
         {
           Poco::Zip::Compress zipper(file, true);
+          if (m_StoreCompressedFiles)
+          {
+            zipper.setStoreExtensions(GetCompressedFileExtensions());
+          }
           Poco::Path tmpdir(m_WorkingDirectory);
           zipper.addRecursive(tmpdir);
           zipper.close();
@@ -482,6 +560,27 @@ TiXmlElement *mitk::SceneIO::SaveBaseData(BaseData *data, const std::string &fil
   auto *element = new TiXmlElement("data");
   element->SetAttribute("type", data->GetNameOfClass());
 
+  BaseDataSerializer::Pointer serializer = this->CreateBaseDataSerializer(data, filenamehint);
+  if (serializer.IsNotNull())
+  {
+    try
+    {
+      std::string writtenfilename = serializer->Serialize();
+      element->SetAttribute("file", writtenfilename);
+      error = false;
+    }
+    catch (std::exception &e)
+    {
+      MITK_ERROR << "Serializer " << serializer->GetNameOfClass() << " failed: " << e.what();
+    }
+  }
+
+  return element;
+}
+
+mitk::BaseDataSerializer::Pointer mitk::SceneIO::CreateBaseDataSerializer(BaseData *data,
+                                                                          const std::string &filenamehint)
+{
   // construct name of serializer class
   std::string serializername(data->GetNameOfClass());
   serializername += "Serializer";
@@ -503,21 +602,11 @@ TiXmlElement *mitk::SceneIO::SaveBaseData(BaseData *data, const std::string &fil
       serializer->SetFilenameHint(filenamehint);
       std::string defaultLocale_WorkingDirectory = Poco::Path::transcode( m_WorkingDirectory );
       serializer->SetWorkingDirectory(defaultLocale_WorkingDirectory);
-      try
-      {
-        std::string writtenfilename = serializer->Serialize();
-        element->SetAttribute("file", writtenfilename);
-        error = false;
-      }
-      catch (std::exception &e)
-      {
-        MITK_ERROR << "Serializer " << serializer->GetNameOfClass() << " failed: " << e.what();
-      }
-      break;
+      return serializer;
     }
   }
 
-  return element;
+  return nullptr;
 }
 
 TiXmlElement *mitk::SceneIO::SavePropertyList(PropertyList *propertyList, const std::string &filenamehint)
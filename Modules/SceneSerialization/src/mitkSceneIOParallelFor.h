@@ -0,0 +1,61 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkSceneIOParallelFor_h
+#define mitkSceneIOParallelFor_h
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace mitk
+{
+  /**
+    \brief Calls function(i) for all i in [0, count) on up to numberOfThreads threads.
+
+    Used to read and write the independent BaseData objects of a scene concurrently. A numberOfThreads of 0 uses
+    one thread per hardware thread. The function must not throw, since it may run on a worker thread, and must
+    not touch GUI infrastructure like the ProgressBar.
+  */
+  template <typename Function>
+  void SceneIOParallelFor(std::size_t count, unsigned int numberOfThreads, Function function)
+  {
+    if (numberOfThreads == 0)
+      numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    const auto numberOfWorkers = std::min<std::size_t>(numberOfThreads, count);
+    if (numberOfWorkers <= 1)
+    {
+      for (std::size_t i = 0; i < count; ++i)
+        function(i);
+      return;
+    }
+
+    std::atomic<std::size_t> nextIndex(0);
+    auto worker = [&]() {
+      for (std::size_t i = nextIndex++; i < count; i = nextIndex++)
+        function(i);
+    };
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < numberOfWorkers; ++i)
+      threads.emplace_back(worker);
+    worker();
+
+    for (auto &thread : threads)
+      thread.join();
+  }
+}
+
+#endif
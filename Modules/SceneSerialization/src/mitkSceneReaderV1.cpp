@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include "mitkIOUtil.h"
 #include "mitkProgressBar.h"
 #include "mitkPropertyListDeserializer.h"
+#include "mitkSceneIOParallelFor.h"
 #include "mitkSerializerMacros.h"
 #include <mitkRenderingModeProperty.h>
 
@@ -75,13 +76,35 @@ bool mitk::SceneReaderV1::LoadScene(TiXmlDocument &document, const std::string &
 
   ProgressBar::GetInstance()->AddStepsToDo(listSize * 2);
 
+  // the files of the BaseData objects are independent of each other, so they are read concurrently
+  std::vector<TiXmlElement *> dataElements;
   for (TiXmlElement *element = document.FirstChildElement("node"); element != nullptr;
        element = element->NextSiblingElement("node"))
   {
-    DataNodes.push_back(LoadBaseDataFromDataTag(element->FirstChildElement("data"), workingDirectory, error));
-    ProgressBar::GetInstance()->Progress();
+    dataElements.push_back(element->FirstChildElement("data"));
+  }
+
+  // with lazy loading, the files are read later by the LazySceneLoader
+  std::vector<BaseData::Pointer> baseData(dataElements.size());
+  std::vector<char> readErrors(dataElements.size(), 0);
+  if (m_LazySceneLoader.IsNull())
+  {
+    SceneIOParallelFor(dataElements.size(), 0, [&](std::size_t i) {
+      bool readError(false);
+      baseData[i] = ReadBaseDataFromDataTag(dataElements[i], workingDirectory, readError);
+      readErrors[i] = readError;
+    });
   }
 
+  for (std::size_t i = 0; i < dataElements.size(); ++i)
+  {
+    error = error || readErrors[i];
+    DataNodes.push_back(DataNode::New());
+    if (baseData[i].IsNotNull())
+      DataNodes.back()->SetData(baseData[i]);
+  }
+  ProgressBar::GetInstance()->Progress(listSize);
+
   // iterate all nodes
   // first level nodes should be <node> elements
   auto nit = DataNodes.begin();
@@ -99,7 +122,7 @@ bool mitk::SceneReaderV1::LoadScene(TiXmlDocument &document, const std::string &
       {
         DecorateBaseDataWithProperties(node->GetData(), baseDataElement, workingDirectory);
       }
-      else
+      else if (m_LazySceneLoader.IsNull())
       {
         MITK_WARN << "BaseData properties stored in scene file, but BaseData could not be read" << std::endl;
       }
@@ -132,6 +155,20 @@ bool mitk::SceneReaderV1::LoadScene(TiXmlDocument &document, const std::string &
       error = true;
     }
 
+    if (m_LazySceneLoader.IsNotNull() && dataXmlElement)
+    {
+      const char *filename = dataXmlElement->Attribute("file");
+      if (filename && strlen(filename) != 0)
+      {
+        std::string dataPropertiesFile;
+        TiXmlElement *baseDataElement = dataXmlElement->FirstChildElement("properties");
+        if (baseDataElement && baseDataElement->Attribute("file"))
+          dataPropertiesFile = workingDirectory + Poco::Path::separator() + baseDataElement->Attribute("file");
+
+        m_LazySceneLoader->AddNode(node, workingDirectory + Poco::Path::separator() + filename, dataPropertiesFile);
+      }
+    }
+
     // remember node for later adding to DataStorage
     m_OrderedNodePairs.push_back(std::make_pair(node, std::list<std::string>()));
 
@@ -173,6 +210,9 @@ bool mitk::SceneReaderV1::LoadScene(TiXmlDocument &document, const std::string &
     }
   }
 
+  // observers of the storage are notified once about all nodes of the scene
+  storage->BeginBatch();
+
   // repeat the following loop ...
   //   ... for all created nodes
   unsigned int lastMapSize(0);
@@ -234,6 +274,8 @@ bool mitk::SceneReaderV1::LoadScene(TiXmlDocument &document, const std::string &
     error = true;
   }
 
+  storage->EndBatch();
+
   return !error;
 }
 
@@ -241,7 +283,23 @@ mitk::DataNode::Pointer mitk::SceneReaderV1::LoadBaseDataFromDataTag(TiXmlElemen
                                                                      const std::string &workingDirectory,
                                                                      bool &error)
 {
-  DataNode::Pointer node;
+  // in case there was no <data> element we create a new empty node (for appending a propertylist later)
+  DataNode::Pointer node = DataNode::New();
+
+  BaseData::Pointer baseData = ReadBaseDataFromDataTag(dataElement, workingDirectory, error);
+  if (baseData.IsNotNull())
+  {
+    node->SetData(baseData);
+  }
+
+  return node;
+}
+
+mitk::BaseData::Pointer mitk::SceneReaderV1::ReadBaseDataFromDataTag(TiXmlElement *dataElement,
+                                                                    const std::string &workingDirectory,
+                                                                    bool &error)
+{
+  BaseData::Pointer data;
 
   if (dataElement)
   {
@@ -255,8 +313,10 @@ mitk::DataNode::Pointer mitk::SceneReaderV1::LoadBaseDataFromDataTag(TiXmlElemen
         {
           MITK_WARN << "Discarding multiple base data results from " << filename << " except the first one.";
         }
-        node = DataNode::New();
-        node->SetData(baseData.front());
+        if (!baseData.empty())
+        {
+          data = baseData.front();
+        }
       }
       catch (std::exception &e)
       {
@@ -264,7 +324,7 @@ mitk::DataNode::Pointer mitk::SceneReaderV1::LoadBaseDataFromDataTag(TiXmlElemen
         error = true;
       }
 
-      if (node.IsNull())
+      if (data.IsNull())
       {
         MITK_ERROR << "Error during attempt to read '" << filename << "'. Factory returned nullptr object.";
         error = true;
@@ -272,13 +332,7 @@ mitk::DataNode::Pointer mitk::SceneReaderV1::LoadBaseDataFromDataTag(TiXmlElemen
     }
   }
 
-  // in case there was no <data> element we create a new empty node (for appending a propertylist later)
-  if (node.IsNull())
-  {
-    node = DataNode::New();
-  }
-
-  return node;
+  return data;
 }
 
 void mitk::SceneReaderV1::ClearNodePropertyListWithExceptions(DataNode &node, PropertyList &propertyList)
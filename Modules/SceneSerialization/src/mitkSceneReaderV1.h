@@ -25,6 +25,20 @@ namespace mitk
                              const std::string &workingDirectory,
                              DataStorage *storage) override;
 
+    /**
+      \brief Clear a default property list and handle some exceptions.
+
+      Called after assigning a BaseData object to a fresh DataNode via SetData().
+      This call to SetData() would create default properties that have not been
+      there when saving the scene. Since they can produce problems, we clear the
+      list and use only those properties that we read from the scene file.
+
+      This method also handles some exceptions for backwards compatibility.
+      Those exceptions are documented directly in the code of the method.
+      Also used by LazySceneLoader, which calls SetData() after the scene has been loaded.
+    */
+    static void ClearNodePropertyListWithExceptions(DataNode &node, PropertyList &propertyList);
+
   protected:
     /**
       \brief tries to create one DataNode from a given XML <node> element
@@ -34,22 +48,19 @@ namespace mitk
                                               bool &error);
 
     /**
-      \brief reads all the properties from the XML document and recreates them in node
+      \brief reads the BaseData object of a given XML <data> element
+
+      Only reads the file, so it is called concurrently for the <data> elements of all nodes.
+      \return nullptr if there is no <data> element or the file could not be read
     */
-    bool DecorateNodeWithProperties(DataNode *node, TiXmlElement *nodeElement, const std::string &workingDirectory);
+    BaseData::Pointer ReadBaseDataFromDataTag(TiXmlElement *dataElement,
+                                              const std::string &workingDirectory,
+                                              bool &error);
 
     /**
-      \brief Clear a default property list and handle some exceptions.
-
-      Called after assigning a BaseData object to a fresh DataNode via SetData().
-      This call to SetData() would create default properties that have not been
-      there when saving the scene. Since they can produce problems, we clear the
-      list and use only those properties that we read from the scene file.
-
-      This method also handles some exceptions for backwards compatibility.
-      Those exceptions are documented directly in the code of the method.
+      \brief reads all the properties from the XML document and recreates them in node
     */
-    void ClearNodePropertyListWithExceptions(DataNode &node, PropertyList &propertyList);
+    bool DecorateNodeWithProperties(DataNode *node, TiXmlElement *nodeElement, const std::string &workingDirectory);
 
     /**
       \brief reads all properties assigned to a base data element and assigns the list to the base data object
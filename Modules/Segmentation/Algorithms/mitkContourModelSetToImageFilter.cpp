@@ -13,13 +13,122 @@ found in the LICENSE file.
 #include "mitkContourModelSetToImageFilter.h"
 
 #include <mitkContourModelSet.h>
-#include <mitkContourModelUtils.h>
-#include <mitkExtractSliceFilter.h>
 #include <mitkImageWriteAccessor.h>
+#include <mitkPixelTypeMultiplex.h>
 #include <mitkProgressBar.h>
 #include <mitkTimeHelper.h>
 
-#include <mitkVtkImageOverwrite.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  /** \brief The contours of one slice, in continuous index coordinates of the two in-plane axes. */
+  struct SliceContours
+  {
+    unsigned int Axis;
+    int SliceIndex;
+    std::vector<std::vector<mitk::Point2D>> Polygons;
+  };
+
+  /** \brief Fills all pixels whose centers lie inside the polygon (even-odd rule) with value, one row after the
+  other. Like vtkPolyDataToImageStencil, pixels within mitk::eps of the boundary are filled as well.
+  */
+  template <typename TPixel>
+  void ScanlineFill(const std::vector<mitk::Point2D> &polygon,
+                    TPixel *slice,
+                    std::size_t strideU,
+                    std::size_t strideV,
+                    int width,
+                    int height,
+                    TPixel value,
+                    std::vector<double> &crossings)
+  {
+    double minV = polygon.front()[1];
+    double maxV = minV;
+    for (const auto &point : polygon)
+    {
+      minV = std::min(minV, point[1]);
+      maxV = std::max(maxV, point[1]);
+    }
+
+    const int firstRow = std::max(0, static_cast<int>(std::ceil(minV)));
+    const int lastRow = std::min(height - 1, static_cast<int>(std::floor(maxV)));
+
+    for (int row = firstRow; row <= lastRow; ++row)
+    {
+      crossings.clear();
+      for (std::size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++)
+      {
+        const auto &a = polygon[j];
+        const auto &b = polygon[i];
+        if ((a[1] > row) != (b[1] > row))
+          crossings.push_back(a[0] + (row - a[1]) * (b[0] - a[0]) / (b[1] - a[1]));
+      }
+
+      std::sort(crossings.begin(), crossings.end());
+
+      TPixel *line = slice + row * strideV;
+      for (std::size_t i = 0; i + 1 < crossings.size(); i += 2)
+      {
+        const int begin = std::max(0, static_cast<int>(std::ceil(crossings[i] - mitk::eps)));
+        const int end = std::min(width - 1, static_cast<int>(std::floor(crossings[i + 1] + mitk::eps)));
+        for (int u = begin; u <= end; ++u)
+          line[u * strideU] = value;
+      }
+    }
+  }
+
+  /** \brief Rasterizes the contours of all slices into the volume. The slices are distributed over all cores, so
+  they must not intersect each other, i.e. all slices have to be perpendicular to the same axis.
+  */
+  template <typename TPixel>
+  void FillSlices(const mitk::PixelType &,
+                  void *volume,
+                  const std::vector<SliceContours> &slices,
+                  const unsigned int *dimensions)
+  {
+    const std::size_t strides[3] = {1, dimensions[0], static_cast<std::size_t>(dimensions[0]) * dimensions[1]};
+    std::atomic<std::size_t> nextSlice(0);
+
+    auto worker = [&]() {
+      std::vector<double> crossings;
+
+      for (std::size_t i = nextSlice++; i < slices.size(); i = nextSlice++)
+      {
+        const SliceContours &slice = slices[i];
+        const unsigned int axisU = slice.Axis == 0 ? 1 : 0;
+        const unsigned int axisV = slice.Axis == 2 ? 1 : 2;
+        TPixel *sliceData = static_cast<TPixel *>(volume) + slice.SliceIndex * strides[slice.Axis];
+
+        for (const auto &polygon : slice.Polygons)
+        {
+          ScanlineFill<TPixel>(polygon,
+                               sliceData,
+                               strides[axisU],
+                               strides[axisV],
+                               static_cast<int>(dimensions[axisU]),
+                               static_cast<int>(dimensions[axisV]),
+                               static_cast<TPixel>(1),
+                               crossings);
+        }
+      }
+    };
+
+    const std::size_t numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < std::min(numberOfThreads, slices.size()); ++i)
+      threads.emplace_back(worker);
+    worker();
+
+    for (auto &thread : threads)
+      thread.join();
+  }
+}
 
 mitk::ContourModelSetToImageFilter::ContourModelSetToImageFilter()
   : m_MakeOutputBinary(true), m_TimeStep(0), m_ReferenceImage(nullptr)
@@ -133,33 +242,29 @@ void mitk::ContourModelSetToImageFilter::GenerateData()
   }
 
   mitk::BaseGeometry *outputImageGeo = outputImage->GetGeometry(m_TimeStep);
+  const unsigned int dimensions[3] = {
+    outputImage->GetDimension(0), outputImage->GetDimension(1), outputImage->GetDimension(2)};
 
-  // Create mitkVtkImageOverwrite which is needed to write the slice back into the volume
-  vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
-
-  // Create ExtractSliceFilter for extracting the corresponding slices from the volume
-  mitk::ExtractSliceFilter::Pointer extractor = mitk::ExtractSliceFilter::New(reslice);
-  extractor->SetInput(outputImage);
-  extractor->SetTimeStep(m_TimeStep);
-  extractor->SetResliceTransformByGeometry(outputImageGeo);
+  // Sort the contours by the slice they are filled into. The contours are rasterized directly into the volume
+  // in index coordinates, so no slices have to be extracted and written back.
+  const std::size_t noSlice = std::numeric_limits<std::size_t>::max();
+  std::vector<SliceContours> slicesPerAxis[3];
+  std::vector<std::size_t> sliceOfIndex[3];
+  bool unsupportedContourFound = false;
 
-  // Fill each contour of the contourmodelset into the image
   auto it = contourSet->Begin();
   auto end = contourSet->End();
-  while (it != end)
+  for (; it != end; ++it)
   {
     mitk::ContourModel *contour = it->GetPointer();
 
-    // 1. Create slice geometry using the contour points
-    mitk::PlaneGeometry::Pointer plane = mitk::PlaneGeometry::New();
-    mitk::Point3D point3D, tempPoint;
-    mitk::Vector3D normal;
+    if (contour->GetNumberOfVertices() < 1)
+      continue;
 
-    mitk::Image::Pointer slice;
+    mitk::Point3D point3D, tempPoint;
 
     int sliceIndex;
-    bool isFrontside = true;
-    bool isRotated = false;
+    unsigned int axis;
 
     // Determine plane orientation
     point3D = contour->GetVertexAt(0)->Coordinates;
@@ -168,72 +273,91 @@ void mitk::ContourModelSetToImageFilter::GenerateData()
     vec.Normalize();
     outputImageGeo->WorldToIndex(point3D, point3D);
 
-    mitk::PlaneGeometry::PlaneOrientation orientation;
     if (mitk::Equal(vec[0], 0))
     {
-      orientation = mitk::PlaneGeometry::Sagittal;
-      sliceIndex = point3D[0];
+      // sagittal
+      axis = 0;
     }
     else if (mitk::Equal(vec[1], 0))
     {
-      orientation = mitk::PlaneGeometry::Frontal;
-      sliceIndex = point3D[1];
+      // frontal
+      axis = 1;
     }
     else if (mitk::Equal(vec[2], 0))
     {
-      orientation = mitk::PlaneGeometry::Axial;
-      sliceIndex = point3D[2];
+      // axial
+      axis = 2;
     }
     else
     {
       // TODO Maybe rotate geometry to extract slice?
       MITK_ERROR
         << "Cannot detect correct slice number! Only axial, sagittal and frontal oriented contours are supported!";
-      return;
+      unsupportedContourFound = true;
+      break;
     }
 
-    // Initialize plane using the detected orientation
-    plane->InitializeStandardPlane(outputImageGeo, orientation, sliceIndex, isFrontside, isRotated);
-    point3D = plane->GetOrigin();
-    normal = plane->GetNormal();
-    normal.Normalize();
-    point3D += normal * 0.5; // pixelspacing is 1, so half the spacing is 0.5
-    plane->SetOrigin(point3D);
+    sliceIndex = point3D[axis];
 
-    // 2. Extract slice at the given position
-    extractor->SetWorldGeometry(plane);
-    extractor->SetVtkOutputRequest(false);
-    reslice->SetOverwriteMode(false);
+    if (sliceIndex < 0 || static_cast<unsigned int>(sliceIndex) >= dimensions[axis])
+    {
+      mitk::ProgressBar::GetInstance()->Progress();
+      continue;
+    }
 
-    extractor->Modified();
-    extractor->Update();
+    auto &sliceOfIndexForAxis = sliceOfIndex[axis];
+    if (sliceOfIndexForAxis.empty())
+      sliceOfIndexForAxis.resize(dimensions[axis], noSlice);
 
-    slice = extractor->GetOutput();
-    slice->DisconnectPipeline();
+    if (sliceOfIndexForAxis[sliceIndex] == noSlice)
+    {
+      sliceOfIndexForAxis[sliceIndex] = slicesPerAxis[axis].size();
+      slicesPerAxis[axis].push_back(SliceContours{axis, sliceIndex, {}});
+    }
 
-    // 3. Fill contour into slice
-    mitk::ContourModel::Pointer projectedContour =
-      mitk::ContourModelUtils::ProjectContourTo2DSlice(slice, contour, true, false);
-    mitk::ContourModelUtils::FillContourInSlice(projectedContour, slice, outputImage);
+    // project the contour into the slice
+    const unsigned int axisU = axis == 0 ? 1 : 0;
+    const unsigned int axisV = axis == 2 ? 1 : 2;
 
-    // 4. Write slice back into image volume
-    reslice->SetInputSlice(slice->GetVtkImageData());
+    std::vector<mitk::Point2D> polygon;
+    polygon.reserve(contour->GetNumberOfVertices());
+    for (auto vertexIt = contour->Begin(); vertexIt != contour->End(); ++vertexIt)
+    {
+      mitk::Point3D index;
+      outputImageGeo->WorldToIndex((*vertexIt)->Coordinates, index);
 
-    // set overwrite mode to true to write back to the image volume
-    reslice->SetOverwriteMode(true);
-    reslice->Modified();
+      mitk::Point2D projectedPoint;
+      projectedPoint[0] = index[axisU];
+      projectedPoint[1] = index[axisV];
+      polygon.push_back(projectedPoint);
+    }
 
-    extractor->Modified();
-    extractor->Update();
+    slicesPerAxis[axis][sliceOfIndexForAxis[sliceIndex]].Polygons.push_back(std::move(polygon));
+  }
+
+  {
+    mitk::ImageWriteAccessor writeAccess(outputImage, outputImage->GetVolumeData(m_TimeStep));
+    void *volume = writeAccess.GetData();
+    const mitk::PixelType pixelType = outputImage->GetPixelType();
 
-    reslice->SetInputSlice(nullptr);
+    // slices of different orientations intersect, so only the slices of one orientation are filled concurrently
+    for (const auto &slices : slicesPerAxis)
+    {
+      if (slices.empty())
+        continue;
 
-    // Progress
-    mitk::ProgressBar::GetInstance()->Progress();
+      mitkPixelTypeMultiplex3(FillSlices, pixelType, volume, slices, dimensions);
 
-    ++it;
+      unsigned int numberOfContours = 0;
+      for (const auto &slice : slices)
+        numberOfContours += slice.Polygons.size();
+      mitk::ProgressBar::GetInstance()->Progress(numberOfContours);
+    }
   }
 
+  if (unsupportedContourFound)
+    return;
+
   outputImage->Modified();
   outputImage->GetVtkImageData()->Modified();
 }
@@ -32,6 +32,16 @@ mitk::DiffSliceOperation::DiffSliceOperation(mitk::Image *imageVolume,
                                              SlicedGeometry3D *sliceGeometry,
                                              unsigned int timestep,
                                              BaseGeometry *currentWorldGeometry)
+  : DiffSliceOperation(imageVolume, slice, nullptr, sliceGeometry, timestep, currentWorldGeometry)
+{
+}
+
+mitk::DiffSliceOperation::DiffSliceOperation(mitk::Image *imageVolume,
+                                             Image *slice,
+                                             const Image *referenceSlice,
+                                             SlicedGeometry3D *sliceGeometry,
+                                             unsigned int timestep,
+                                             BaseGeometry *currentWorldGeometry)
   : Operation(1)
 
 {
@@ -49,7 +59,9 @@ mitk::DiffSliceOperation::DiffSliceOperation(mitk::Image *imageVolume,
   m_TimeStep = timestep;
 
   m_zlibSliceContainer = CompressedImageContainer::New();
-  m_zlibSliceContainer->SetImage(slice);
+  // keep the compression out of the interaction that created the operation
+  m_zlibSliceContainer->AsynchronousOn();
+  m_zlibSliceContainer->SetImage(slice, referenceSlice);
 
   m_Image = imageVolume;
   m_DeleteObserverTag = 0;
@@ -88,6 +100,22 @@ mitk::Image::Pointer mitk::DiffSliceOperation::GetSlice()
   return image;
 }
 
+mitk::Image::Pointer mitk::DiffSliceOperation::GetSlice(const Image *currentSlice)
+{
+  Image::Pointer image = m_zlibSliceContainer->GetImage(currentSlice);
+  return image;
+}
+
+bool mitk::DiffSliceOperation::IsDelta() const
+{
+  return m_zlibSliceContainer.IsNotNull() && m_zlibSliceContainer->IsDelta();
+}
+
+std::size_t mitk::DiffSliceOperation::GetMemorySize() const
+{
+  return m_zlibSliceContainer.IsNotNull() ? m_zlibSliceContainer->GetCompressedSize() : 0;
+}
+
 bool mitk::DiffSliceOperation::IsValid()
 {
   return m_ImageIsValid && m_zlibSliceContainer.IsNotNull() && (m_WorldGeometry.IsNotNull()); // TODO improve
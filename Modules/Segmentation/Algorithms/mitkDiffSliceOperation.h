@@ -34,6 +34,11 @@ namespace mitk
      currentWorldGeometry   specifies the axis where the slice has to be applied in the volume.
 
     This Operation can be used to realize undo-redo functionality for e.g. segmentation purposes.
+
+    If a reference slice is given, only the pixels of the slice that differ from it are stored. This is
+    the case for the operations created by SegTool2D: the undo operation stores the original slice
+    relative to the edited slice and vice versa, so a stroke costs memory proportional to the pixels it
+    changed only. Applying such an operation requires the slice currently in the volume, see GetSlice(const Image*).
   */
   class MITKSEGMENTATION_EXPORT DiffSliceOperation : public Operation
   {
@@ -57,6 +62,18 @@ namespace mitk
                        unsigned int timestep,
                        BaseGeometry *currentWorldGeometry);
 
+    /** \brief Stores only the pixels of @a slice that differ from @a referenceSlice.
+
+      The volume has to contain @a referenceSlice when the operation is applied. Without
+      @a referenceSlice or if it differs in size or pixel type, the complete slice is stored.
+    */
+    DiffSliceOperation(mitk::Image *imageVolume,
+                       mitk::Image *slice,
+                       const mitk::Image *referenceSlice,
+                       SlicedGeometry3D *sliceGeometry,
+                       unsigned int timestep,
+                       BaseGeometry *currentWorldGeometry);
+
     /** \brief Check if it is a valid operation.*/
     bool IsValid();
 
@@ -66,8 +83,16 @@ namespace mitk
     mitk::Image *GetImage() { return this->m_Image; }
     /** \brief Set thee slice to be applied.*/
     void SetImage(vtkImageData *slice) { this->m_Slice = slice; }
-    /** \brief Get the slice that is applied in the operation.*/
+    /** \brief Get the slice that is applied in the operation. nullptr if only the changed pixels are stored.*/
     Image::Pointer GetSlice();
+    /** \brief Get the slice that is applied in the operation, given the slice currently in the volume.*/
+    Image::Pointer GetSlice(const Image *currentSlice);
+
+    /** \brief True if only the changed pixels relative to a reference slice are stored.*/
+    bool IsDelta() const;
+
+    /** \brief The size of the compressed slice data.*/
+    std::size_t GetMemorySize() const override;
 
     /** \brief Get timeStep.*/
     void SetTimeStep(unsigned int timestep) { this->m_TimeStep = timestep; }
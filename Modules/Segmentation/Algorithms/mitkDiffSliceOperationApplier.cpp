@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include "mitkDiffSliceOperationApplier.h"
 
 #include "mitkDiffSliceOperation.h"
+#include "mitkLabelSetImage.h"
 #include "mitkRenderingManager.h"
 #include "mitkSegTool2D.h"
 #include <mitkExtractSliceFilter.h>
@@ -43,7 +44,38 @@ void mitk::DiffSliceOperationApplier::ExecuteOperation(Operation *operation)
     // the actual overwrite filter (vtk)
     vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
 
-    mitk::Image::Pointer slice = imageOperation->GetSlice();
+    mitk::Image::Pointer slice;
+    if (imageOperation->IsDelta())
+    {
+      // the operation holds the changed pixels only, they are applied to the slice currently in the volume
+      vtkSmartPointer<mitkVtkImageOverwrite> extractReslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+      extractReslice->SetOverwriteMode(false);
+      extractReslice->Modified();
+
+      mitk::ExtractSliceFilter::Pointer sliceExtractor = mitk::ExtractSliceFilter::New(extractReslice);
+      sliceExtractor->SetInput(imageOperation->GetImage());
+      sliceExtractor->SetTimeStep(imageOperation->GetTimeStep());
+      sliceExtractor->SetWorldGeometry(dynamic_cast<PlaneGeometry *>(imageOperation->GetWorldGeometry()));
+      sliceExtractor->SetVtkOutputRequest(false);
+      sliceExtractor->SetResliceTransformByGeometry(
+        imageOperation->GetImage()->GetGeometry(imageOperation->GetTimeStep()));
+      sliceExtractor->Modified();
+      sliceExtractor->Update();
+
+      try
+      {
+        slice = imageOperation->GetSlice(sliceExtractor->GetOutput());
+      }
+      catch (const mitk::Exception &e)
+      {
+        MITK_ERROR << "Cannot apply slice operation: " << e.GetDescription();
+        return;
+      }
+    }
+    else
+    {
+      slice = imageOperation->GetSlice();
+    }
     // Set the slice as 'input'
     reslice->SetInputSlice(slice->GetVtkImageData());
 
@@ -59,12 +91,22 @@ void mitk::DiffSliceOperationApplier::ExecuteOperation(Operation *operation)
     extractor->SetVtkOutputRequest(true);
     extractor->SetResliceTransformByGeometry(imageOperation->GetImage()->GetGeometry(imageOperation->GetTimeStep()));
 
+    // update the label statistics by scanning the overwritten region only
+    const Image::RegionType region = imageOperation->GetImage()->GetRegionOfPlane(
+      dynamic_cast<PlaneGeometry *>(imageOperation->GetWorldGeometry()), imageOperation->GetTimeStep());
+    auto *labelSetImage = dynamic_cast<LabelSetImage *>(imageOperation->GetImage());
+    if (labelSetImage != nullptr)
+      labelSetImage->BeginLabelStatisticsUpdate(region);
+
     extractor->Modified();
     extractor->Update();
 
     // make sure the modification is rendered
     RenderingManager::GetInstance()->RequestUpdateAll();
-    imageOperation->GetImage()->Modified();
+    imageOperation->GetImage()->RegionModified(region);
+
+    if (labelSetImage != nullptr)
+      labelSetImage->EndLabelStatisticsUpdate(region);
 
     mitk::ExtractSliceFilter::Pointer extractor2 = mitk::ExtractSliceFilter::New();
     extractor2->SetInput(imageOperation->GetImage());
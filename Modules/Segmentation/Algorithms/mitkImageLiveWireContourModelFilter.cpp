@@ -18,6 +18,31 @@ found in the LICENSE file.
 
 #include "mitkIOUtil.h"
 
+#include <mutex>
+
+namespace
+{
+  /** The feature images of the last slice. Several filters (the tool and the interactors of its contours) work on
+  the same slice, they share the features as long as the slice and its geometry are not modified.*/
+  struct CostFunctionFeatures
+  {
+    typedef mitk::ImageLiveWireContourModelFilter::CostFunctionType CostFunctionType;
+
+    // only used for comparison, a new image at the same address has a different modified time
+    const mitk::Image *Input = nullptr;
+    itk::ModifiedTimeType InputMTime = 0;
+    itk::ModifiedTimeType GeometryMTime = 0;
+    mitk::ImageLiveWireContourModelFilter::InternalImageType::Pointer InternalImage;
+    CostFunctionType::FloatImageType::ConstPointer GradientMagnitudeImage;
+    CostFunctionType::VectorOutputImageType::ConstPointer GradientImage;
+    CostFunctionType::FloatImageType::ConstPointer EdgeImage;
+    double GradientMaximum = 0.0;
+  };
+
+  std::mutex cachedFeaturesMutex;
+  CostFunctionFeatures cachedFeatures;
+}
+
 mitk::ImageLiveWireContourModelFilter::ImageLiveWireContourModelFilter()
 {
   OutputType::Pointer output = dynamic_cast<OutputType *>(this->MakeOutput(0).GetPointer());
@@ -27,6 +52,9 @@ mitk::ImageLiveWireContourModelFilter::ImageLiveWireContourModelFilter()
   m_CostFunction = CostFunctionType::New();
   m_ShortestPathFilter = ShortestPathImageFilterType::New();
   m_ShortestPathFilter->SetCostFunction(m_CostFunction);
+  // the start point stays the same while the end point follows the mouse, so the shortest paths from the start
+  // point to all pixels are calculated once and each end point is answered by back-tracing
+  m_ShortestPathFilter->SetReuseShortestPathTree(true);
   m_UseDynamicCostMap = false;
   m_TimeStep = 0;
 }
@@ -57,7 +85,33 @@ void mitk::ImageLiveWireContourModelFilter::SetInput(unsigned int idx,
     this->ProcessObject::SetNthInput(idx, const_cast<InputType *>(input));
     this->Modified();
 
-    AccessFixedDimensionByItk(input, ItkPreProcessImage, 2);
+    std::lock_guard<std::mutex> lock(cachedFeaturesMutex);
+    if (cachedFeatures.Input == input && cachedFeatures.InputMTime == input->GetMTime() &&
+        cachedFeatures.GeometryMTime == input->GetGeometry()->GetMTime())
+    {
+      m_InternalImage = cachedFeatures.InternalImage;
+      m_CostFunction->SetImage(m_InternalImage);
+      m_CostFunction->SetFeatureImages(cachedFeatures.GradientMagnitudeImage,
+                                       cachedFeatures.GradientImage,
+                                       cachedFeatures.EdgeImage,
+                                       cachedFeatures.GradientMaximum);
+      m_ShortestPathFilter->SetInput(m_InternalImage);
+    }
+    else
+    {
+      AccessFixedDimensionByItk(input, ItkPreProcessImage, 2);
+
+      // compute the features right away, so following filters on the same slice can reuse them
+      m_CostFunction->ComputeFeatureImages();
+      cachedFeatures.Input = input;
+      cachedFeatures.InputMTime = input->GetMTime();
+      cachedFeatures.GeometryMTime = input->GetGeometry()->GetMTime();
+      cachedFeatures.InternalImage = m_InternalImage;
+      cachedFeatures.GradientMagnitudeImage = m_CostFunction->GetGradientMagnitudeImage();
+      cachedFeatures.GradientImage = m_CostFunction->GetGradientImage();
+      cachedFeatures.EdgeImage = m_CostFunction->GetEdgeImage();
+      cachedFeatures.GradientMaximum = m_CostFunction->GetGradientMaximum();
+    }
   }
 }
 
@@ -173,27 +227,12 @@ void mitk::ImageLiveWireContourModelFilter::UpdateLiveWire()
   endPoint[0] = m_EndPointInIndex[0];
   endPoint[1] = m_EndPointInIndex[1];
 
-  // minimum value in each direction for startRegion
-  InternalImageType::IndexType startRegion;
-  startRegion[0] = startPoint[0] < endPoint[0] ? startPoint[0] : endPoint[0];
-  startRegion[1] = startPoint[1] < endPoint[1] ? startPoint[1] : endPoint[1];
-
-  // maximum value in each direction for size
-  InternalImageType::SizeType size;
-  size[0] = std::abs(startPoint[0] - endPoint[0]) + 1;
-  size[1] = std::abs(startPoint[1] - endPoint[1]) + 1;
-
-  CostFunctionType::RegionType region;
-  region.SetSize(size);
-  region.SetIndex(startRegion);
-
-  // inputImage->SetRequestedRegion(region);
-
   // extracts features from image and calculates costs
   // m_CostFunction->SetImage(m_InternalImage);
+  // no requested region is set: it is not used for the costs, but changing it would modify the cost function and
+  // thus invalidate the shortest path tree on every mouse move
   m_CostFunction->SetStartIndex(startPoint);
   m_CostFunction->SetEndIndex(endPoint);
-  m_CostFunction->SetRequestedRegion(region);
   m_CostFunction->SetUseCostMap(m_UseDynamicCostMap);
 
   // calculate shortest path between start and end point
@@ -11,47 +11,48 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkOtsuSegmentationFilter.h"
-#include "itkOtsuMultipleThresholdsImageFilter.h"
+#include "itkOtsuMultipleThresholdsCalculator.h"
 #include "mitkImageAccessByItk.h"
 #include "mitkImageCast.h"
+#include "mitkThreadPool.h"
 
-struct paramContainer
+namespace
 {
-  paramContainer(unsigned int numThresholds, bool useValley, unsigned int numBins, mitk::Image::Pointer image)
-    : m_NumberOfThresholds(numThresholds), m_ValleyEmphasis(useValley), m_NumberOfBins(numBins), m_Image(image)
+  template <typename TPixel, unsigned int VImageDimension>
+  void AccessItkLabelByThresholds(const itk::Image<TPixel, VImageDimension> *itkImage,
+                                  const std::vector<double> &thresholds,
+                                  mitk::Image::Pointer output)
   {
-  }
+    typedef itk::Image<mitk::OtsuSegmentationFilter::OutputPixelType, VImageDimension> itkOutputImageType;
 
-  unsigned int m_NumberOfThresholds;
-  bool m_ValleyEmphasis;
-  unsigned int m_NumberOfBins;
-  mitk::Image::Pointer m_Image;
-};
+    // compared in the pixel type like itk::ThresholdLabelerImageFilter does
+    std::vector<TPixel> pixelThresholds;
+    for (double threshold : thresholds)
+      pixelThresholds.push_back(static_cast<TPixel>(threshold));
 
-template <typename TPixel, unsigned int VImageDimension>
-void AccessItkOtsuFilter(const itk::Image<TPixel, VImageDimension> *itkImage, paramContainer params)
-{
-  typedef itk::Image<TPixel, VImageDimension> itkInputImageType;
-  typedef itk::Image<mitk::OtsuSegmentationFilter::OutputPixelType, VImageDimension> itkOutputImageType;
-  typedef itk::OtsuMultipleThresholdsImageFilter<itkInputImageType, itkOutputImageType> OtsuFilterType;
+    typename itkOutputImageType::Pointer labels = itkOutputImageType::New();
+    labels->CopyInformation(itkImage);
+    labels->SetRegions(itkImage->GetLargestPossibleRegion());
+    labels->Allocate();
 
-  typename OtsuFilterType::Pointer filter = OtsuFilterType::New();
-  filter->SetNumberOfThresholds(params.m_NumberOfThresholds);
-  filter->SetInput(itkImage);
-  filter->SetValleyEmphasis(params.m_ValleyEmphasis);
-  filter->SetNumberOfHistogramBins(params.m_NumberOfBins);
+    const TPixel *input = itkImage->GetBufferPointer();
+    auto *labelBuffer = labels->GetBufferPointer();
+    mitk::ThreadPool::GetInstance().ParallelFor(
+      0,
+      labels->GetLargestPossibleRegion().GetNumberOfPixels(),
+      [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+          mitk::OtsuSegmentationFilter::OutputPixelType label = 0;
+          while (label < pixelThresholds.size() && input[i] > pixelThresholds[label])
+            ++label;
+          labelBuffer[i] = label;
+        }
+      },
+      1 << 16);
 
-  try
-  {
-    filter->Update();
-  }
-  catch (...)
-  {
-    mitkThrow() << "itkOtsuFilter error.";
+    mitk::GrabItkImageMemory(labels, output.GetPointer());
   }
-
-  mitk::CastToMitkImage<itkOutputImageType>(filter->GetOutput(), params.m_Image);
-  return;
 }
 
 namespace mitk
@@ -59,14 +60,115 @@ namespace mitk
   OtsuSegmentationFilter::OtsuSegmentationFilter()
     : m_NumberOfThresholds(2), m_ValleyEmphasis(false), m_NumberOfBins(128)
   {
+    m_HistogramGenerator = HistogramGenerator::New();
   }
 
   OtsuSegmentationFilter::~OtsuSegmentationFilter() {}
   void OtsuSegmentationFilter::GenerateData()
   {
     mitk::Image::ConstPointer mitkImage = GetInput();
-    AccessByItk_n(mitkImage,
-                  AccessItkOtsuFilter,
-                  (paramContainer(m_NumberOfThresholds, m_ValleyEmphasis, m_NumberOfBins, this->GetOutput())));
+
+    // the generator only computes the histogram again if the input or the number of bins changed
+    m_HistogramGenerator->SetImage(mitkImage);
+    m_HistogramGenerator->SetSize(m_NumberOfBins);
+    try
+    {
+      m_HistogramGenerator->ComputeHistogram();
+    }
+    catch (...)
+    {
+      mitkThrow() << "itkOtsuFilter error.";
+    }
+
+    m_Thresholds = ComputeThresholds(m_HistogramGenerator->GetHistogram(), m_NumberOfThresholds, m_ValleyEmphasis);
+
+    AccessByItk_n(mitkImage, AccessItkLabelByThresholds, (m_Thresholds, this->GetOutput()));
+  }
+
+  std::vector<double> OtsuSegmentationFilter::ComputeThresholds(const HistogramType *histogram,
+                                                                unsigned int numberOfThresholds,
+                                                                bool valleyEmphasis)
+  {
+    const std::size_t numberOfBins = histogram->Size();
+    const std::size_t numberOfClasses = numberOfThresholds + 1;
+    if (numberOfBins < numberOfClasses)
+      mitkThrow() << "The histogram has fewer bins than the number of regions.";
+
+    if (valleyEmphasis)
+    {
+      typedef itk::OtsuMultipleThresholdsCalculator<HistogramType> CalculatorType;
+      CalculatorType::Pointer calculator = CalculatorType::New();
+      calculator->SetInputHistogram(histogram);
+      calculator->SetNumberOfThresholds(numberOfThresholds);
+      calculator->SetValleyEmphasis(true);
+      calculator->Compute();
+      const CalculatorType::OutputType &output = calculator->GetOutput();
+      return std::vector<double>(output.begin(), output.end());
+    }
+
+    // The between-class variance is, up to constants, the sum of sum^2 / weight over the regions, so the
+    // best split of the first j bins into c regions extends a best split of fewer bins into c - 1 regions.
+    std::vector<double> weights(numberOfBins + 1, 0.0);
+    std::vector<double> sums(numberOfBins + 1, 0.0);
+    for (std::size_t j = 0; j < numberOfBins; ++j)
+    {
+      const double frequency = histogram->GetFrequency(j);
+      weights[j + 1] = weights[j] + frequency;
+      sums[j + 1] = sums[j] + frequency * histogram->GetMeasurementVector(j)[0];
+    }
+
+    auto classValue = [&](std::size_t first, std::size_t end) {
+      const double weight = weights[end] - weights[first];
+      if (weight <= 0.0)
+        return 0.0;
+      const double sum = sums[end] - sums[first];
+      return sum * sum / weight;
+    };
+
+    // best[j] is the maximum for the bins [0, j), splits[c][j] the first bin of the last of c + 1 regions
+    std::vector<double> best(numberOfBins + 1, 0.0);
+    std::vector<double> next(numberOfBins + 1, 0.0);
+    std::vector<std::vector<std::size_t>> splits(numberOfClasses, std::vector<std::size_t>(numberOfBins + 1, 0));
+    for (std::size_t j = 1; j <= numberOfBins; ++j)
+      best[j] = classValue(0, j);
+
+    for (std::size_t c = 1; c < numberOfClasses; ++c)
+    {
+      // every region contains at least one bin
+      const std::size_t firstEnd = c + 1;
+      const std::size_t lastEnd = numberOfBins - (numberOfClasses - 1 - c);
+      ThreadPool::GetInstance().ParallelFor(
+        firstEnd,
+        lastEnd + 1,
+        [&](std::size_t begin, std::size_t end) {
+          for (std::size_t j = begin; j < end; ++j)
+          {
+            double maximum = -1.0;
+            std::size_t split = c;
+            for (std::size_t i = c; i < j; ++i)
+            {
+              const double value = best[i] + classValue(i, j);
+              if (value > maximum)
+              {
+                maximum = value;
+                split = i;
+              }
+            }
+            next[j] = maximum;
+            splits[c][j] = split;
+          }
+        },
+        16);
+      std::swap(best, next);
+    }
+
+    std::vector<double> thresholds(numberOfThresholds);
+    std::size_t end = numberOfBins;
+    for (std::size_t c = numberOfClasses - 1; c > 0; --c)
+    {
+      end = splits[c][end];
+      thresholds[c - 1] = histogram->GetBinMax(0, end - 1);
+    }
+    return thresholds;
   }
 }
@@ -14,6 +14,7 @@ found in the LICENSE file.
 #define mitkOtsuSegmentationFilter_h_Included
 
 //#include "MitkSBExports.h"
+#include "mitkHistogramGenerator.h"
 #include "mitkITKImageImport.h"
 #include "mitkImage.h"
 #include "mitkImageToImageFilter.h"
@@ -29,7 +30,13 @@ namespace mitk
 
     This class being an mitk::ImageToImageFilter performs a multiple threshold otsu image segmentation based on the
     image histogram.
-    Internally, the itk::OtsuMultipleThresholdsImageFilter is used.
+
+    The histogram is kept until the input or the number of bins changes, so updates for another number of
+    thresholds only search the thresholds and label the image again. Without valley emphasis the thresholds
+    are found by dynamic programming over the histogram bins in O(thresholds * bins^2); with valley emphasis
+    the objective is not additive over the regions and the exhaustive search of
+    itk::OtsuMultipleThresholdsCalculator is used. Pixels are labeled like itk::OtsuMultipleThresholdsImageFilter
+    does, in parallel on the mitk::ThreadPool.
 
     $Author: somebody$
   */
@@ -39,6 +46,7 @@ namespace mitk
     typedef unsigned char OutputPixelType;
     typedef itk::Image<OutputPixelType, 3> itkOutputImageType;
     typedef mitk::ITKImageImport<itkOutputImageType> ImageConverterType;
+    typedef HistogramGenerator::HistogramType HistogramType;
 
     mitkClassMacro(OtsuSegmentationFilter, ImageToImageFilter);
     itkFactorylessNewMacro(Self);
@@ -52,10 +60,21 @@ namespace mitk
         MITK_WARN << "Tried to set an invalid number of thresholds in the OtsuSegmentationFilter.";
         return;
       }
-      m_NumberOfThresholds = number;
+      if (m_NumberOfThresholds != number)
+      {
+        m_NumberOfThresholds = number;
+        this->Modified();
+      }
     }
 
-    void SetValleyEmphasis(bool useValley) { m_ValleyEmphasis = useValley; }
+    void SetValleyEmphasis(bool useValley)
+    {
+      if (m_ValleyEmphasis != useValley)
+      {
+        m_ValleyEmphasis = useValley;
+        this->Modified();
+      }
+    }
     void SetNumberOfBins(unsigned int number)
     {
       if (number < 1)
@@ -63,9 +82,24 @@ namespace mitk
         MITK_WARN << "Tried to set an invalid number of bins in the OtsuSegmentationFilter.";
         return;
       }
-      m_NumberOfBins = number;
+      if (m_NumberOfBins != number)
+      {
+        m_NumberOfBins = number;
+        this->Modified();
+      }
     }
 
+    /** \brief The thresholds of the last update in ascending order. */
+    const std::vector<double> &GetThresholds() const { return m_Thresholds; }
+
+    /** \brief Computes the thresholds that maximize the between-class variance of the histogram.
+     *
+     * Like itk::OtsuMultipleThresholdsCalculator, a threshold is the upper bound of the last bin of a region.
+     */
+    static std::vector<double> ComputeThresholds(const HistogramType *histogram,
+                                                 unsigned int numberOfThresholds,
+                                                 bool valleyEmphasis);
+
   protected:
     OtsuSegmentationFilter();
     ~OtsuSegmentationFilter() override;
@@ -76,6 +110,10 @@ namespace mitk
     unsigned int m_NumberOfThresholds;
     bool m_ValleyEmphasis;
     unsigned int m_NumberOfBins;
+    std::vector<double> m_Thresholds;
+
+    /// Computes and keeps the histogram of the input
+    HistogramGenerator::Pointer m_HistogramGenerator;
 
   }; // class
 
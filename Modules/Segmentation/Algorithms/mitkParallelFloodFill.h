@@ -0,0 +1,319 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkParallelFloodFill_h_Included
+#define mitkParallelFloodFill_h_Included
+
+#include <itkImage.h>
+#include <itkMultiThreader.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace mitk
+{
+  /**
+    \brief Multi-threaded connected threshold flood fill, a replacement for itk::ConnectedThresholdImageFilter.
+
+    Starting at the seeds, all face connected pixels with a value in [lower, upper] are set to the
+    replace value in the output image, all other pixels are 0. The fill grows wave by wave: the pixels
+    added by one wave form the frontier of the next. Large frontiers are split into chunks which
+    the threads of an itk::MultiThreader take from a shared counter, so busy threads do not hold up
+    idle ones. Small frontiers are processed by the calling thread, where threading does not pay off.
+
+    Two ways to stop early:
+    - SetMaximumNumberOfVoxels(): the fill stops as soon as more pixels were added, which usually
+      means that the region leaked into the surrounding. Result::Leaked is set and the output holds
+      the region grown so far.
+    - SetProgressCallback(): called on the calling thread between two waves with the partially grown
+      output, e.g. to show a preview. Returning false cancels the fill (Result::Canceled).
+
+    Meant to be used by mitk::Tool subclasses on slices or volumes:
+    \code
+    mitk::ParallelFloodFill<InputImageType, OutputImageType> fill;
+    fill.SetInput(itkImage);
+    fill.AddSeed(seedIndex);
+    fill.SetLower(lower);
+    fill.SetUpper(upper);
+    fill.Update();
+    OutputImageType::Pointer result = fill.GetOutput();
+    \endcode
+  */
+  template <typename TInputImage, typename TOutputImage>
+  class ParallelFloodFill
+  {
+  public:
+    typedef typename TInputImage::PixelType InputPixelType;
+    typedef typename TOutputImage::PixelType OutputPixelType;
+    typedef typename TInputImage::IndexType IndexType;
+
+    static const unsigned int ImageDimension = TInputImage::ImageDimension;
+
+    struct Result
+    {
+      std::size_t NumberOfVoxels = 0;
+      bool Leaked = false;
+      bool Canceled = false;
+    };
+
+    /** \brief Called between two waves with the output grown so far, returns false to cancel */
+    typedef std::function<bool(const TOutputImage *output, std::size_t numberOfVoxels)> ProgressCallbackType;
+
+    ParallelFloodFill()
+      : m_Lower(0.0),
+        m_Upper(0.0),
+        m_ReplaceValue(1),
+        m_MaximumNumberOfVoxels(0),
+        m_NumberOfThreads(0),
+        m_ProgressInterval(100000),
+        m_Stop(false)
+    {
+    }
+
+    void SetInput(const TInputImage *input) { m_Input = input; }
+    void AddSeed(const IndexType &seed) { m_Seeds.push_back(seed); }
+    void ClearSeeds() { m_Seeds.clear(); }
+
+    void SetLower(double lower) { m_Lower = lower; }
+    void SetUpper(double upper) { m_Upper = upper; }
+    void SetReplaceValue(OutputPixelType value) { m_ReplaceValue = value; }
+
+    /** \brief Stops the fill if more pixels are added, 0 (default) means no limit */
+    void SetMaximumNumberOfVoxels(std::size_t numberOfVoxels) { m_MaximumNumberOfVoxels = numberOfVoxels; }
+
+    /** \brief 0 (default) uses the global default number of threads of ITK */
+    void SetNumberOfThreads(unsigned int numberOfThreads) { m_NumberOfThreads = numberOfThreads; }
+
+    /** \brief The callback is called whenever at least @a interval pixels were added since its last call */
+    void SetProgressCallback(const ProgressCallbackType &callback, std::size_t interval = 100000)
+    {
+      m_ProgressCallback = callback;
+      m_ProgressInterval = interval;
+    }
+
+    Result Update();
+
+    TOutputImage *GetOutput() { return m_Output; }
+
+  private:
+    /** \brief Frontiers smaller than this are processed by the calling thread */
+    static const std::size_t MinimumParallelFrontierSize = 4096;
+    static const std::size_t ChunkSize = 1024;
+
+    struct Wave
+    {
+      ParallelFloodFill *Fill;
+      const std::vector<std::size_t> *Frontier;
+      std::vector<std::vector<std::size_t>> NextFrontiers;
+      std::atomic<std::size_t> NextChunk;
+    };
+
+    bool Visit(std::size_t offset)
+    {
+      const std::uint32_t bit = 1u << (offset & 31);
+      return (m_Visited[offset >> 5].fetch_or(bit, std::memory_order_relaxed) & bit) == 0;
+    }
+
+    bool IsInside(InputPixelType value) const { return m_Lower <= value && value <= m_Upper; }
+
+    /** \brief Adds the unvisited neighbors of the pixels in [begin, end) of @a frontier within the thresholds */
+    void ProcessPixels(const std::vector<std::size_t> &frontier,
+                       std::size_t begin,
+                       std::size_t end,
+                       std::vector<std::size_t> &nextFrontier);
+
+    void ProcessWave(Wave &wave, unsigned int threadId);
+
+    static ITK_THREAD_RETURN_TYPE ProcessWaveCallback(void *arg);
+
+    typename TInputImage::ConstPointer m_Input;
+    typename TOutputImage::Pointer m_Output;
+    std::vector<IndexType> m_Seeds;
+
+    double m_Lower;
+    double m_Upper;
+    OutputPixelType m_ReplaceValue;
+    std::size_t m_MaximumNumberOfVoxels;
+    unsigned int m_NumberOfThreads;
+    ProgressCallbackType m_ProgressCallback;
+    std::size_t m_ProgressInterval;
+
+    const InputPixelType *m_InputBuffer = nullptr;
+    OutputPixelType *m_OutputBuffer = nullptr;
+    std::size_t m_Size[ImageDimension];
+    std::size_t m_Strides[ImageDimension];
+    std::vector<std::atomic<std::uint32_t>> m_Visited;
+    std::atomic<std::size_t> m_NumberOfVoxels;
+    std::atomic<bool> m_Stop;
+  };
+
+  template <typename TInputImage, typename TOutputImage>
+  typename ParallelFloodFill<TInputImage, TOutputImage>::Result ParallelFloodFill<TInputImage, TOutputImage>::Update()
+  {
+    Result result;
+    if (m_Input.IsNull())
+      return result;
+
+    const typename TInputImage::RegionType region = m_Input->GetBufferedRegion();
+    m_Output = TOutputImage::New();
+    m_Output->CopyInformation(m_Input);
+    m_Output->SetRegions(region);
+    m_Output->Allocate();
+    m_Output->FillBuffer(0);
+
+    m_InputBuffer = m_Input->GetBufferPointer();
+    m_OutputBuffer = m_Output->GetBufferPointer();
+    std::size_t numberOfPixels = 1;
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      m_Size[i] = region.GetSize(i);
+      m_Strides[i] = numberOfPixels;
+      numberOfPixels *= m_Size[i];
+    }
+
+    // one bit per pixel, value-initialized to 0
+    std::vector<std::atomic<std::uint32_t>>((numberOfPixels + 31) / 32).swap(m_Visited);
+    m_NumberOfVoxels = 0;
+    m_Stop = false;
+
+    std::vector<std::size_t> frontier;
+    for (const IndexType &seed : m_Seeds)
+    {
+      if (!region.IsInside(seed))
+        continue;
+
+      std::size_t offset = 0;
+      for (unsigned int i = 0; i < ImageDimension; ++i)
+        offset += (seed[i] - region.GetIndex(i)) * m_Strides[i];
+
+      if (this->Visit(offset) && this->IsInside(m_InputBuffer[offset]))
+      {
+        m_OutputBuffer[offset] = m_ReplaceValue;
+        frontier.push_back(offset);
+        ++m_NumberOfVoxels;
+      }
+    }
+
+    unsigned int numberOfThreads =
+      m_NumberOfThreads > 0 ? m_NumberOfThreads : itk::MultiThreader::GetGlobalDefaultNumberOfThreads();
+    numberOfThreads = std::max(1u, std::min(numberOfThreads, itk::MultiThreader::GetGlobalMaximumNumberOfThreads()));
+
+    itk::MultiThreader::Pointer threader;
+    std::size_t lastProgress = m_NumberOfVoxels;
+
+    while (!frontier.empty() && !m_Stop)
+    {
+      Wave wave;
+      wave.Fill = this;
+      wave.Frontier = &frontier;
+      wave.NextChunk = 0;
+
+      if (numberOfThreads > 1 && frontier.size() >= MinimumParallelFrontierSize)
+      {
+        if (threader.IsNull())
+          threader = itk::MultiThreader::New();
+
+        wave.NextFrontiers.resize(numberOfThreads);
+        threader->SetNumberOfThreads(numberOfThreads);
+        threader->SetSingleMethod(ProcessWaveCallback, &wave);
+        threader->SingleMethodExecute();
+      }
+      else
+      {
+        wave.NextFrontiers.resize(1);
+        this->ProcessWave(wave, 0);
+      }
+
+      frontier.clear();
+      for (auto &nextFrontier : wave.NextFrontiers)
+        frontier.insert(frontier.end(), nextFrontier.begin(), nextFrontier.end());
+
+      if (m_ProgressCallback && !m_Stop && m_NumberOfVoxels - lastProgress >= m_ProgressInterval)
+      {
+        lastProgress = m_NumberOfVoxels;
+        if (!m_ProgressCallback(m_Output, lastProgress))
+        {
+          result.Canceled = true;
+          break;
+        }
+      }
+    }
+
+    result.NumberOfVoxels = m_NumberOfVoxels;
+    result.Leaked = m_MaximumNumberOfVoxels > 0 && result.NumberOfVoxels > m_MaximumNumberOfVoxels;
+
+    std::vector<std::atomic<std::uint32_t>>().swap(m_Visited);
+    m_Output->Modified();
+    return result;
+  }
+
+  template <typename TInputImage, typename TOutputImage>
+  void ParallelFloodFill<TInputImage, TOutputImage>::ProcessPixels(const std::vector<std::size_t> &frontier,
+                                                                    std::size_t begin,
+                                                                    std::size_t end,
+                                                                    std::vector<std::size_t> &nextFrontier)
+  {
+    std::size_t numberOfAddedPixels = 0;
+    for (std::size_t pixel = begin; pixel < end; ++pixel)
+    {
+      const std::size_t offset = frontier[pixel];
+      std::size_t remainder = offset;
+      for (int i = ImageDimension - 1; i >= 0; --i)
+      {
+        const std::size_t index = remainder / m_Strides[i];
+        remainder -= index * m_Strides[i];
+
+        const std::size_t neighbors[2] = {offset - m_Strides[i], offset + m_Strides[i]};
+        const bool valid[2] = {index > 0, index + 1 < m_Size[i]};
+        for (int side = 0; side < 2; ++side)
+        {
+          if (valid[side] && this->Visit(neighbors[side]) && this->IsInside(m_InputBuffer[neighbors[side]]))
+          {
+            m_OutputBuffer[neighbors[side]] = m_ReplaceValue;
+            nextFrontier.push_back(neighbors[side]);
+            ++numberOfAddedPixels;
+          }
+        }
+      }
+    }
+
+    const std::size_t numberOfVoxels = m_NumberOfVoxels.fetch_add(numberOfAddedPixels) + numberOfAddedPixels;
+    if (m_MaximumNumberOfVoxels > 0 && numberOfVoxels > m_MaximumNumberOfVoxels)
+      m_Stop = true;
+  }
+
+  template <typename TInputImage, typename TOutputImage>
+  void ParallelFloodFill<TInputImage, TOutputImage>::ProcessWave(Wave &wave, unsigned int threadId)
+  {
+    const std::size_t frontierSize = wave.Frontier->size();
+    for (std::size_t chunk = wave.NextChunk++; chunk * ChunkSize < frontierSize && !m_Stop; chunk = wave.NextChunk++)
+    {
+      const std::size_t begin = chunk * ChunkSize;
+      this->ProcessPixels(
+        *wave.Frontier, begin, std::min(begin + ChunkSize, frontierSize), wave.NextFrontiers[threadId]);
+    }
+  }
+
+  template <typename TInputImage, typename TOutputImage>
+  ITK_THREAD_RETURN_TYPE ParallelFloodFill<TInputImage, TOutputImage>::ProcessWaveCallback(void *arg)
+  {
+    auto *threadInfo = static_cast<itk::MultiThreader::ThreadInfoStruct *>(arg);
+    auto *wave = static_cast<Wave *>(threadInfo->UserData);
+    wave->Fill->ProcessWave(*wave, threadInfo->ThreadID);
+    return ITK_THREAD_RETURN_VALUE;
+  }
+}
+
+#endif
@@ -28,11 +28,13 @@ found in the LICENSE file.
 
 #include "vtkDataSetAttributes.h"
 #include "vtkGarbageCollector.h"
+#include "vtkHomogeneousTransform.h"
 #include "vtkImageData.h"
 #include "vtkImageStencilData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkMatrix4x4.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTransform.h"
@@ -44,9 +46,11 @@ found in the LICENSE file.
 #undef VTK_USE_UINT64
 #define VTK_USE_UINT64 0
 
+#include <algorithm>
 #include <cfloat>
 #include <climits>
 #include <cmath>
+#include <cstring>
 
 vtkStandardNewMacro(mitkVtkImageOverwrite);
 
@@ -106,6 +110,7 @@ inline int vtkResliceRound(double x)
 mitkVtkImageOverwrite::mitkVtkImageOverwrite()
 {
   m_Overwrite_Mode = false;
+  m_LinearRowsEnabled = true;
   this->GetOutput()->AllocateScalars(VTK_UNSIGNED_INT, 1); // VTK6_TODO where should the image be allocated?
 }
 
@@ -475,6 +480,259 @@ static void vtkGetResliceInterpFunc(mitkVtkImageOverwrite *self,
   }
 }
 
+//----------------------------------------------------------------------------
+// Do nearest-neighbor interpolation for the output voxels idXmin to idXmax of a
+// row whose voxel indices are mapped linearly to input voxel indices, i.e. the
+// input index of voxel idX is rowOrigin + idX * rowStep. If the row runs along
+// the input axis 'rowAxis' (-1 otherwise), the voxels inside of the input are
+// copied as one run instead of being looked up one by one. The results are the
+// same as the ones of vtkNearestNeighborInterpolation for the modes
+// VTK_RESLICE_BACKGROUND and VTK_RESLICE_BORDER.
+template <class T>
+static void vtkImageResliceLinearRow(void *&outPtrV,
+                                     void *inPtrV,
+                                     const int inExt[6],
+                                     const vtkIdType inInc[3],
+                                     int numscalars,
+                                     const double rowOrigin[3],
+                                     const double rowStep[3],
+                                     int rowAxis,
+                                     int idXmin,
+                                     int idXmax,
+                                     const void *backgroundV,
+                                     bool overwrite)
+{
+  T *outPtr = static_cast<T *>(outPtrV);
+  T *inPtr = static_cast<T *>(inPtrV);
+  const T *background = static_cast<const T *>(backgroundV);
+  const int inExtent[3] = {inExt[1] - inExt[0] + 1, inExt[3] - inExt[2] + 1, inExt[5] - inExt[4] + 1};
+  const int n = idXmax - idXmin + 1;
+  if (n <= 0)
+  {
+    return;
+  }
+
+  // the input indices of the first and the last voxel of the row
+  int firstIndex[3];
+  int lastIndex[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    firstIndex[i] = vtkResliceRound(rowOrigin[i] + idXmin * rowStep[i]) - inExt[2 * i];
+    lastIndex[i] = vtkResliceRound(rowOrigin[i] + idXmax * rowStep[i]) - inExt[2 * i];
+  }
+
+  // the indices change monotonously along the row, so if they match a run at both
+  // ends of the row, they match it everywhere
+  const int direction = (rowAxis >= 0 && rowStep[rowAxis] < 0) ? -1 : 1;
+  bool run = rowAxis >= 0;
+  for (int i = 0; run && i < 3; ++i)
+  {
+    run = lastIndex[i] == firstIndex[i] + (i == rowAxis ? direction * (n - 1) : 0);
+  }
+
+  if (!run)
+  {
+    for (int idX = idXmin; idX <= idXmax; ++idX)
+    {
+      int index[3];
+      bool inside = true;
+      for (int i = 0; i < 3; ++i)
+      {
+        index[i] = vtkResliceRound(rowOrigin[i] + idX * rowStep[i]) - inExt[2 * i];
+        inside = inside && index[i] >= 0 && index[i] < inExtent[i];
+      }
+
+      if (!inside)
+      {
+        for (int c = 0; c < numscalars; ++c)
+          *outPtr++ = background[c];
+        continue;
+      }
+
+      T *voxel = inPtr + index[0] * inInc[0] + index[1] * inInc[1] + index[2] * inInc[2];
+      for (int c = 0; c < numscalars; ++c)
+      {
+        if (overwrite)
+          voxel[c] = *outPtr++;
+        else
+          *outPtr++ = voxel[c];
+      }
+    }
+    outPtrV = outPtr;
+    return;
+  }
+
+  // determine the voxels of the row that are inside of the input
+  int first = 0;
+  int count = 0;
+  bool inside = true;
+  for (int i = 0; i < 3; ++i)
+  {
+    if (i != rowAxis)
+      inside = inside && firstIndex[i] >= 0 && firstIndex[i] < inExtent[i];
+  }
+  if (inside)
+  {
+    const int start = firstIndex[rowAxis];
+    const int extent = inExtent[rowAxis];
+    int last = 0;
+    if (direction > 0)
+    {
+      first = std::max(0, -start);
+      last = std::min(n - 1, extent - 1 - start);
+    }
+    else
+    {
+      first = std::max(0, start - (extent - 1));
+      last = std::min(n - 1, start);
+    }
+    count = std::max(0, last - first + 1);
+  }
+  if (count == 0)
+  {
+    first = n;
+  }
+
+  for (int k = 0; k < first; ++k)
+  {
+    for (int c = 0; c < numscalars; ++c)
+      *outPtr++ = background[c];
+  }
+
+  if (count > 0)
+  {
+    int index[3] = {firstIndex[0], firstIndex[1], firstIndex[2]};
+    index[rowAxis] += direction * first;
+    T *voxel = inPtr + index[0] * inInc[0] + index[1] * inInc[1] + index[2] * inInc[2];
+    const vtkIdType stride = direction * inInc[rowAxis];
+
+    if (stride == numscalars)
+    {
+      // the run is contiguous in memory
+      const size_t size = static_cast<size_t>(count) * numscalars * sizeof(T);
+      if (overwrite)
+        memcpy(voxel, outPtr, size);
+      else
+        memcpy(outPtr, voxel, size);
+      outPtr += count * numscalars;
+    }
+    else
+    {
+      for (int k = 0; k < count; ++k, voxel += stride)
+      {
+        for (int c = 0; c < numscalars; ++c)
+        {
+          if (overwrite)
+            voxel[c] = *outPtr++;
+          else
+            *outPtr++ = voxel[c];
+        }
+      }
+    }
+  }
+
+  for (int k = first + count; k < n; ++k)
+  {
+    for (int c = 0; c < numscalars; ++c)
+      *outPtr++ = background[c];
+  }
+
+  outPtrV = outPtr;
+}
+
+typedef void (*vtkImageResliceLinearRowFunc)(void *&outPtr,
+                                             void *inPtr,
+                                             const int inExt[6],
+                                             const vtkIdType inInc[3],
+                                             int numscalars,
+                                             const double rowOrigin[3],
+                                             const double rowStep[3],
+                                             int rowAxis,
+                                             int idXmin,
+                                             int idXmax,
+                                             const void *background,
+                                             bool overwrite);
+
+// get the linear row function according to scalar type
+static void vtkGetResliceLinearRowFunc(mitkVtkImageOverwrite *self, vtkImageResliceLinearRowFunc *linearRow)
+{
+  switch (self->GetOutput()->GetScalarType())
+  {
+    vtkTemplateAliasMacro(*linearRow = &vtkImageResliceLinearRow<VTK_TT>);
+    default:
+      *linearRow = nullptr;
+  }
+}
+
+//----------------------------------------------------------------------------
+// Compute the matrix from output voxel indices to input voxel indices if the
+// reslice axes and the reslice transform are affine. Returns false otherwise.
+static bool vtkImageResliceGetIndexMatrix(mitkVtkImageOverwrite *self,
+                                          vtkImageData *inData,
+                                          vtkImageData *outData,
+                                          double indexMatrix[16])
+{
+  vtkMatrix4x4 *transformMatrix = nullptr;
+  if (vtkAbstractTransform *transform = self->GetResliceTransform())
+  {
+    vtkHomogeneousTransform *homogeneousTransform = vtkHomogeneousTransform::SafeDownCast(transform);
+    if (!homogeneousTransform)
+    {
+      return false;
+    }
+    transformMatrix = homogeneousTransform->GetMatrix();
+  }
+  vtkMatrix4x4 *resliceAxes = self->GetResliceAxes();
+
+  for (vtkMatrix4x4 *matrix : {transformMatrix, resliceAxes})
+  {
+    if (matrix && (matrix->GetElement(3, 0) != 0.0 || matrix->GetElement(3, 1) != 0.0 ||
+                   matrix->GetElement(3, 2) != 0.0 || matrix->GetElement(3, 3) != 1.0))
+    {
+      return false;
+    }
+  }
+
+  const double *inOrigin = inData->GetOrigin();
+  const double *inSpacing = inData->GetSpacing();
+  const double *outOrigin = outData->GetOrigin();
+  const double *outSpacing = outData->GetSpacing();
+
+  // output index to output coordinates
+  double matrix[16];
+  vtkMatrix4x4::Identity(matrix);
+  for (int i = 0; i < 3; ++i)
+  {
+    matrix[4 * i + i] = outSpacing[i];
+    matrix[4 * i + 3] = outOrigin[i];
+  }
+
+  // to input coordinates
+  double product[16];
+  if (resliceAxes)
+  {
+    vtkMatrix4x4::Multiply4x4(*resliceAxes->Element, matrix, product);
+    std::copy(product, product + 16, matrix);
+  }
+  if (transformMatrix)
+  {
+    vtkMatrix4x4::Multiply4x4(*transformMatrix->Element, matrix, product);
+    std::copy(product, product + 16, matrix);
+  }
+
+  // to input index
+  double inverseInputMatrix[16];
+  vtkMatrix4x4::Identity(inverseInputMatrix);
+  for (int i = 0; i < 3; ++i)
+  {
+    inverseInputMatrix[4 * i + i] = 1.0 / inSpacing[i];
+    inverseInputMatrix[4 * i + 3] = -inOrigin[i] / inSpacing[i];
+  }
+  vtkMatrix4x4::Multiply4x4(inverseInputMatrix, matrix, indexMatrix);
+
+  return true;
+}
+
 //----------------------------------------------------------------------------
 // Some helper functions for 'RequestData'
 //----------------------------------------------------------------------------
@@ -769,6 +1027,35 @@ static void vtkImageResliceExecute(mitkVtkImageOverwrite *self,
   // get the stencil
   vtkImageStencilData *stencil = self->GetStencil();
 
+  // For affine mappings the input indices change linearly along each output row,
+  // so the rows can be processed without transforming every voxel. This is always
+  // the case for the plane geometries of mitk::ExtractSliceFilter.
+  double indexMatrix[16] = {0.0};
+  vtkImageResliceLinearRowFunc linearRow = nullptr;
+  int rowAxis = -1;
+  if (self->IsLinearRowsEnabled() && (mode == VTK_RESLICE_BACKGROUND || mode == VTK_RESLICE_BORDER) &&
+      vtkImageResliceGetIndexMatrix(self, inData, outData, indexMatrix))
+  {
+    vtkGetResliceLinearRowFunc(self, &linearRow);
+
+    // the rows of axis aligned planes run along one input axis
+    for (int i = 0; i < 3; ++i)
+    {
+      const double step = indexMatrix[4 * i];
+      if (std::abs(std::abs(step) - 1.0) < 1e-6)
+      {
+        rowAxis = rowAxis == -1 ? i : -2;
+      }
+      else if (std::abs(step) >= 1e-6)
+      {
+        rowAxis = -2;
+      }
+    }
+    rowAxis = std::max(rowAxis, -1);
+  }
+  const double rowStep[3] = {indexMatrix[0], indexMatrix[4], indexMatrix[8]};
+  const bool overwrite = self->IsOverwriteMode();
+
   // Loop through output voxels
   for (idZ = outExt[4]; idZ <= outExt[5]; idZ++)
   {
@@ -787,6 +1074,18 @@ static void vtkImageResliceExecute(mitkVtkImageOverwrite *self,
       while (vtkResliceGetNextExtent(
         stencil, idXmin, idXmax, outExt[0], outExt[1], idY, idZ, outPtr, background, numscalars, setpixels, iter))
       {
+        if (linearRow)
+        {
+          double rowOrigin[3];
+          for (int i = 0; i < 3; ++i)
+          {
+            rowOrigin[i] = indexMatrix[4 * i + 1] * idY + indexMatrix[4 * i + 2] * idZ + indexMatrix[4 * i + 3];
+          }
+          linearRow(outPtr, inPtr, inExt, inInc, numscalars, rowOrigin, rowStep, rowAxis, idXmin, idXmax, background,
+                    overwrite);
+          continue;
+        }
+
         for (idX = idXmin; idX <= idXmax; idX++)
         {
           // convert to data coordinates
@@ -833,6 +1132,15 @@ void mitkVtkImageOverwrite::SetOverwriteMode(bool b)
   m_Overwrite_Mode = b;
 }
 
+void mitkVtkImageOverwrite::SetLinearRowsEnabled(bool enabled)
+{
+  if (m_LinearRowsEnabled != enabled)
+  {
+    m_LinearRowsEnabled = enabled;
+    this->Modified();
+  }
+}
+
 void mitkVtkImageOverwrite::SetInputSlice(vtkImageData *slice)
 {
   // set the output as input
@@ -65,11 +65,19 @@ public:
     */
   void SetInputSlice(vtkImageData *slice);
 
+  /** \brief Process the rows of affine mappings at once instead of looking up every voxel.
+    Both give the same result, disabling it is only meant to compare them.
+    Default: true
+    */
+  void SetLinearRowsEnabled(bool enabled);
+  bool IsLinearRowsEnabled() { return m_LinearRowsEnabled; }
+
 protected:
   mitkVtkImageOverwrite();
   ~mitkVtkImageOverwrite() override;
 
   bool m_Overwrite_Mode;
+  bool m_LinearRowsEnabled;
 
   /** Overridden from vtkImageReslice. \sa vtkImageReslice::ThreadedRequestData */
   void ThreadedRequestData(vtkInformation *vtkNotUsed(request),
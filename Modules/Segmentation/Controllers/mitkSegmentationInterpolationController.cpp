@@ -91,6 +91,8 @@ void mitk::SegmentationInterpolationController::BlockModified(bool block)
 
 void mitk::SegmentationInterpolationController::SetSegmentationVolume(const Image *segmentation)
 {
+  std::unique_lock<std::mutex> lock(m_Mutex);
+
   // clear old information (remove all time steps
   m_SegmentationCountInSlice.clear();
 
@@ -147,6 +149,7 @@ void mitk::SegmentationInterpolationController::SetSegmentationVolume(const Imag
 
   // PrintStatus();
 
+  lock.unlock();
   SetReferenceVolume(m_ReferenceImage);
 
   Modified();
@@ -154,6 +157,8 @@ void mitk::SegmentationInterpolationController::SetSegmentationVolume(const Imag
 
 void mitk::SegmentationInterpolationController::SetReferenceVolume(const Image *referenceImage)
 {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
   m_ReferenceImage = referenceImage;
 
   if (m_ReferenceImage.IsNull())
@@ -188,7 +193,10 @@ void mitk::SegmentationInterpolationController::SetChangedVolume(const Image *sl
   if (sliceDiff->GetDimension() != 3)
     return;
 
-  AccessFixedDimensionByItk_1(sliceDiff, ScanChangedVolume, 3, timeStep);
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    AccessFixedDimensionByItk_1(sliceDiff, ScanChangedVolume, 3, timeStep);
+  }
 
   // PrintStatus();
   Modified();
@@ -203,6 +211,8 @@ void mitk::SegmentationInterpolationController::SetChangedSlice(const Image *sli
     return;
   if (sliceDimension > 2)
     return;
+
+  std::unique_lock<std::mutex> lock(m_Mutex);
   if (timeStep >= m_SegmentationCountInSlice.size())
     return;
   if (sliceIndex >= m_SegmentationCountInSlice[timeStep][sliceDimension].size())
@@ -237,6 +247,8 @@ void mitk::SegmentationInterpolationController::SetChangedSlice(const Image *sli
   AccessFixedDimensionByItk_1(
     sliceDiff, ScanChangedSlice, 2, SetChangedSliceOptions(sliceDimension, sliceIndex, dim0, dim1, timeStep, rawSlice));
 
+  // observers may interpolate again
+  lock.unlock();
   Modified();
 }
 
@@ -434,6 +446,9 @@ mitk::Image::Pointer mitk::SegmentationInterpolationController::Interpolate(unsi
                                                                             const mitk::PlaneGeometry *currentPlane,
                                                                             unsigned int timeStep)
 {
+  // the bookkeeping and the segmentation must not change until the neighboring slices are extracted
+  std::unique_lock<std::mutex> lock(m_Mutex);
+
   if (m_Segmentation.IsNull())
     return nullptr;
 
@@ -563,6 +578,9 @@ mitk::Image::Pointer mitk::SegmentationInterpolationController::Interpolate(unsi
     return nullptr;
   }
 
+  Image::ConstPointer referenceImage = m_ReferenceImage;
+  lock.unlock();
+
   // interpolation algorithm gets some inputs
   //   two segmentations (guaranteed to be of the same data type, but no special data type guaranteed)
   //   orientation (sliceDimension) of the segmentations
@@ -582,5 +600,5 @@ mitk::Image::Pointer mitk::SegmentationInterpolationController::Interpolate(unsi
                                 sliceDimension,
                                 resultImage,
                                 timeStep,
-                                m_ReferenceImage);
+                                referenceImage);
 }
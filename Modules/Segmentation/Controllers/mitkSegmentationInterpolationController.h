@@ -21,6 +21,7 @@ found in the LICENSE file.
 #include <itkObjectFactory.h>
 
 #include <map>
+#include <mutex>
 #include <vector>
 
 namespace mitk
@@ -136,6 +137,9 @@ namespace mitk
       \param sliceIndex Which slice to take, in the direction specified by sliceDimension. Count starts from 0.
 
       \param timeStep Which time step to use
+
+      May be called from worker threads while the segmentation is edited; the slice bookkeeping and
+      the extraction of the neighboring slices are serialized with the updates of the bookkeeping.
     */
     Image::Pointer Interpolate(unsigned int sliceDimension,
                                unsigned int sliceIndex,
@@ -213,6 +217,9 @@ namespace mitk
     Image::ConstPointer m_ReferenceImage;
     bool m_BlockModified;
     bool m_2DInterpolationActivated;
+
+    // guards m_SegmentationCountInSlice and the slice extraction in Interpolate()
+    std::mutex m_Mutex;
   };
 
 } // namespace
@@ -17,10 +17,18 @@ found in the LICENSE file.
 #include "mitkInteractionConst.h"
 #include "mitkRenderingManager.h"
 
-#include "itkOrImageFilter.h"
+#include "mitkCallbackFromGUIThread.h"
 #include "mitkImageCast.h"
 #include "mitkImageTimeSelector.h"
 
+#include <itkImageRegionIterator.h>
+#include <itkRegionOfInterestImageFilter.h>
+#include <itkShrinkImageFilter.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 // us
 #include <usGetModuleContext.h>
 #include <usModule.h>
@@ -32,9 +40,210 @@ namespace mitk
   MITK_TOOL_MACRO(MITKSEGMENTATION_EXPORT, FastMarchingTool3D, "FastMarching3D tool");
 }
 
+struct mitk::FastMarchingTool3D::Computation
+{
+  ThreadPool::CancellationToken Token;
+  std::future<void> Future;
+
+  /// The region of the reference image the pipeline runs on
+  InternalImageType::RegionType Region;
+
+  /// Full resolution result covering Region, set by the worker before Future becomes ready
+  OutputImageType::Pointer Result;
+};
+
+namespace
+{
+  typedef mitk::FastMarchingTool3D::InternalImageType InternalImageType;
+  typedef mitk::FastMarchingTool3D::OutputImageType OutputImageType;
+
+  /// Regions with more voxels get a preview at half the resolution first
+  const itk::SizeValueType CoarsePreviewMinimumNumberOfPixels = 1 << 21;
+
+  struct PipelineParameters
+  {
+    float LowerThreshold;
+    float UpperThreshold;
+    float StoppingValue;
+    float Sigma;
+    float Alpha;
+    float Beta;
+  };
+
+  /** Aborts the observed filter at its next progress event once the token is canceled. */
+  class AbortOnCancelCommand : public itk::Command
+  {
+  public:
+    typedef AbortOnCancelCommand Self;
+    typedef itk::SmartPointer<Self> Pointer;
+    itkFactorylessNewMacro(Self);
+
+    mitk::ThreadPool::CancellationToken m_Token;
+
+    void Execute(itk::Object *caller, const itk::EventObject &) override
+    {
+      if (m_Token.IsCanceled())
+        static_cast<itk::ProcessObject *>(caller)->AbortGenerateDataOn();
+    }
+
+    void Execute(const itk::Object *, const itk::EventObject &) override {}
+  };
+
+  class FunctionCommand : public itk::Command
+  {
+  public:
+    typedef FunctionCommand Self;
+    typedef itk::SmartPointer<Self> Pointer;
+    itkFactorylessNewMacro(Self);
+
+    std::function<void()> m_Callback;
+
+    void Execute(itk::Object *, const itk::EventObject &) override { m_Callback(); }
+    void Execute(const itk::Object *, const itk::EventObject &) override { m_Callback(); }
+  };
+
+  InternalImageType::RegionType ComputeRegionOfInterest(const InternalImageType *image,
+                                                        const std::vector<itk::Index<3>> &seeds,
+                                                        double radius,
+                                                        double sigma)
+  {
+    const InternalImageType::RegionType largestRegion = image->GetLargestPossibleRegion();
+    const InternalImageType::SpacingType spacing = image->GetSpacing();
+
+    itk::Index<3> lower = seeds.front();
+    itk::Index<3> upper = seeds.front();
+    for (const auto &seed : seeds)
+    {
+      for (unsigned int d = 0; d < 3; ++d)
+      {
+        lower[d] = std::min(lower[d], seed[d]);
+        upper[d] = std::max(upper[d], seed[d]);
+      }
+    }
+
+    InternalImageType::RegionType region;
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+      // the smoothing and gradient filters need some support beyond the marched voxels
+      const double margin = std::min<double>(std::ceil((radius + 4.0 * sigma) / spacing[d]) + 3,
+                                             largestRegion.GetSize(d));
+      region.SetIndex(d, lower[d] - static_cast<itk::IndexValueType>(margin));
+      region.SetSize(d, static_cast<itk::SizeValueType>(upper[d] - lower[d] + 1 + 2 * margin));
+    }
+
+    if (!region.Crop(largestRegion))
+      return InternalImageType::RegionType();
+    return region;
+  }
+
+  /** Runs the FastMarching pipeline on \a region of \a image, which is shrunk by \a shrinkFactor.
+    * Returns nullptr if the token was canceled. */
+  OutputImageType::Pointer RunPipeline(const InternalImageType *image,
+                                       const InternalImageType::RegionType &region,
+                                       unsigned int shrinkFactor,
+                                       const std::vector<itk::Index<3>> &seeds,
+                                       const PipelineParameters &parameters,
+                                       const mitk::ThreadPool::CancellationToken &token)
+  {
+    if (token.IsCanceled())
+      return nullptr;
+
+    auto abortCommand = AbortOnCancelCommand::New();
+    abortCommand->m_Token = token;
+    const auto numberOfThreads = mitk::ThreadPool::GetInstance().GetRecommendedNumberOfThreads();
+
+    // the pipeline must not change the requested region of the shared reference image
+    auto input = InternalImageType::New();
+    input->CopyInformation(image);
+    input->SetRegions(image->GetLargestPossibleRegion());
+    input->SetPixelContainer(const_cast<InternalImageType::PixelContainer *>(image->GetPixelContainer()));
+
+    typedef itk::RegionOfInterestImageFilter<InternalImageType, InternalImageType> RegionFilterType;
+    auto regionFilter = RegionFilterType::New();
+    regionFilter->SetInput(input);
+    regionFilter->SetRegionOfInterest(region);
+    InternalImageType::Pointer cropped = regionFilter->GetOutput();
+
+    typedef itk::ShrinkImageFilter<InternalImageType, InternalImageType> ShrinkFilterType;
+    auto shrinkFilter = ShrinkFilterType::New();
+    if (shrinkFactor > 1)
+    {
+      shrinkFilter->SetInput(cropped);
+      shrinkFilter->SetShrinkFactors(shrinkFactor);
+      shrinkFilter->SetNumberOfThreads(numberOfThreads);
+      cropped = shrinkFilter->GetOutput();
+    }
+    cropped->Update();
+
+    auto smoothFilter = mitk::FastMarchingTool3D::SmoothingFilterType::New();
+    smoothFilter->SetInput(cropped);
+    smoothFilter->SetTimeStep(0.05);
+    smoothFilter->SetNumberOfIterations(2);
+    smoothFilter->SetConductanceParameter(9.0);
+
+    auto gradientMagnitudeFilter = mitk::FastMarchingTool3D::GradientFilterType::New();
+    gradientMagnitudeFilter->SetInput(smoothFilter->GetOutput());
+    gradientMagnitudeFilter->SetSigma(parameters.Sigma);
+
+    auto sigmoidFilter = mitk::FastMarchingTool3D::SigmoidFilterType::New();
+    sigmoidFilter->SetInput(gradientMagnitudeFilter->GetOutput());
+    sigmoidFilter->SetAlpha(parameters.Alpha);
+    sigmoidFilter->SetBeta(parameters.Beta);
+    sigmoidFilter->SetOutputMinimum(0.0);
+    sigmoidFilter->SetOutputMaximum(1.0);
+
+    const InternalImageType::RegionType markedRegion = cropped->GetLargestPossibleRegion();
+    auto seedContainer = mitk::FastMarchingTool3D::NodeContainer::New();
+    seedContainer->Initialize();
+    for (const auto &seed : seeds)
+    {
+      itk::Index<3> index;
+      for (unsigned int d = 0; d < 3; ++d)
+        index[d] = markedRegion.GetIndex(d) + (seed[d] - region.GetIndex(d)) / static_cast<int>(shrinkFactor);
+
+      if (!markedRegion.IsInside(index))
+        continue;
+
+      mitk::FastMarchingTool3D::NodeType node;
+      node.SetValue(0.0);
+      node.SetIndex(index);
+      seedContainer->InsertElement(seedContainer->Size(), node);
+    }
+
+    auto fastMarchingFilter = mitk::FastMarchingTool3D::FastMarchingFilterType::New();
+    fastMarchingFilter->SetInput(sigmoidFilter->GetOutput());
+    fastMarchingFilter->SetTrialPoints(seedContainer);
+    fastMarchingFilter->SetStoppingValue(parameters.StoppingValue);
+
+    auto thresholdFilter = mitk::FastMarchingTool3D::ThresholdingFilterType::New();
+    thresholdFilter->SetInput(fastMarchingFilter->GetOutput());
+    thresholdFilter->SetLowerThreshold(parameters.LowerThreshold);
+    thresholdFilter->SetUpperThreshold(parameters.UpperThreshold);
+    thresholdFilter->SetOutsideValue(0);
+    thresholdFilter->SetInsideValue(1.0);
+
+    std::vector<itk::ProcessObject *> filters = {
+      smoothFilter, gradientMagnitudeFilter, sigmoidFilter, fastMarchingFilter, thresholdFilter};
+    for (auto *filter : filters)
+    {
+      filter->SetNumberOfThreads(numberOfThreads);
+      filter->AddObserver(itk::ProgressEvent(), abortCommand);
+    }
+
+    thresholdFilter->Update();
+    if (token.IsCanceled())
+      return nullptr;
+
+    OutputImageType::Pointer result = thresholdFilter->GetOutput();
+    result->DisconnectPipeline();
+    return result;
+  }
+}
+
 mitk::FastMarchingTool3D::FastMarchingTool3D()
   : /*FeedbackContourTool*/ AutoSegmentationTool(),
     m_NeedUpdate(true),
+    m_IsBusy(false),
     m_CurrentTimeStep(0),
     m_LowerThreshold(0),
     m_UpperThreshold(200),
@@ -49,6 +258,7 @@ mitk::FastMarchingTool3D::FastMarchingTool3D()
 
 mitk::FastMarchingTool3D::~FastMarchingTool3D()
 {
+  this->CancelComputation();
 }
 
 bool mitk::FastMarchingTool3D::CanHandle(BaseData *referenceData) const
@@ -87,14 +297,12 @@ const char *mitk::FastMarchingTool3D::GetName() const
 void mitk::FastMarchingTool3D::SetUpperThreshold(double value)
 {
   m_UpperThreshold = value / 10.0;
-  m_ThresholdFilter->SetUpperThreshold(m_UpperThreshold);
   m_NeedUpdate = true;
 }
 
 void mitk::FastMarchingTool3D::SetLowerThreshold(double value)
 {
   m_LowerThreshold = value / 10.0;
-  m_ThresholdFilter->SetLowerThreshold(m_LowerThreshold);
   m_NeedUpdate = true;
 }
 
@@ -103,7 +311,6 @@ void mitk::FastMarchingTool3D::SetBeta(double value)
   if (m_Beta != value)
   {
     m_Beta = value;
-    m_SigmoidFilter->SetBeta(m_Beta);
     m_NeedUpdate = true;
   }
 }
@@ -115,7 +322,6 @@ void mitk::FastMarchingTool3D::SetSigma(double value)
     if (value > 0.0)
     {
       m_Sigma = value;
-      m_GradientMagnitudeFilter->SetSigma(m_Sigma);
       m_NeedUpdate = true;
     }
   }
@@ -126,7 +332,6 @@ void mitk::FastMarchingTool3D::SetAlpha(double value)
   if (m_Alpha != value)
   {
     m_Alpha = value;
-    m_SigmoidFilter->SetAlpha(m_Alpha);
     m_NeedUpdate = true;
   }
 }
@@ -136,7 +341,6 @@ void mitk::FastMarchingTool3D::SetStoppingValue(double value)
   if (m_StoppingValue != value)
   {
     m_StoppingValue = value;
-    m_FastMarchingFilter->SetStoppingValue(m_StoppingValue);
     m_NeedUpdate = true;
   }
 }
@@ -173,43 +377,8 @@ void mitk::FastMarchingTool3D::Activated()
 
   m_ProgressCommand = mitk::ToolCommand::New();
 
-  m_ThresholdFilter = ThresholdingFilterType::New();
-  m_ThresholdFilter->SetLowerThreshold(m_LowerThreshold);
-  m_ThresholdFilter->SetUpperThreshold(m_UpperThreshold);
-  m_ThresholdFilter->SetOutsideValue(0);
-  m_ThresholdFilter->SetInsideValue(1.0);
-
-  m_SmoothFilter = SmoothingFilterType::New();
-  m_SmoothFilter->AddObserver(itk::ProgressEvent(), m_ProgressCommand);
-  m_SmoothFilter->SetTimeStep(0.05);
-  m_SmoothFilter->SetNumberOfIterations(2);
-  m_SmoothFilter->SetConductanceParameter(9.0);
-
-  m_GradientMagnitudeFilter = GradientFilterType::New();
-  m_GradientMagnitudeFilter->AddObserver(itk::ProgressEvent(), m_ProgressCommand);
-  m_GradientMagnitudeFilter->SetSigma(m_Sigma);
-
-  m_SigmoidFilter = SigmoidFilterType::New();
-  m_SigmoidFilter->AddObserver(itk::ProgressEvent(), m_ProgressCommand);
-  m_SigmoidFilter->SetAlpha(m_Alpha);
-  m_SigmoidFilter->SetBeta(m_Beta);
-  m_SigmoidFilter->SetOutputMinimum(0.0);
-  m_SigmoidFilter->SetOutputMaximum(1.0);
-
-  m_FastMarchingFilter = FastMarchingFilterType::New();
-  m_FastMarchingFilter->AddObserver(itk::ProgressEvent(), m_ProgressCommand);
-  m_FastMarchingFilter->SetStoppingValue(m_StoppingValue);
-
   m_SeedContainer = NodeContainer::New();
   m_SeedContainer->Initialize();
-  m_FastMarchingFilter->SetTrialPoints(m_SeedContainer);
-
-  // set up pipeline
-  m_SmoothFilter->SetInput(m_ReferenceImageAsITK);
-  m_GradientMagnitudeFilter->SetInput(m_SmoothFilter->GetOutput());
-  m_SigmoidFilter->SetInput(m_GradientMagnitudeFilter->GetOutput());
-  m_FastMarchingFilter->SetInput(m_SigmoidFilter->GetOutput());
-  m_ThresholdFilter->SetInput(m_FastMarchingFilter->GetOutput());
 
   m_ToolManager->GetDataStorage()->Add(m_SeedsAsPointSetNode, m_ToolManager->GetWorkingData(0));
 
@@ -228,13 +397,13 @@ void mitk::FastMarchingTool3D::Activated()
 
 void mitk::FastMarchingTool3D::Deactivated()
 {
+  this->CancelComputation();
+  m_Computation = nullptr;
+  this->SetBusy(false);
+
   m_ToolManager->GetDataStorage()->Remove(this->m_ResultImageNode);
   m_ToolManager->GetDataStorage()->Remove(this->m_SeedsAsPointSetNode);
   this->ClearSeeds();
-  this->m_SmoothFilter->RemoveAllObservers();
-  this->m_SigmoidFilter->RemoveAllObservers();
-  this->m_GradientMagnitudeFilter->RemoveAllObservers();
-  this->m_FastMarchingFilter->RemoveAllObservers();
   m_ResultImageNode = nullptr;
   mitk::RenderingManager::GetInstance()->RequestUpdateAll();
 
@@ -266,17 +435,31 @@ void mitk::FastMarchingTool3D::Initialize()
     timeSelector->UpdateLargestPossibleRegion();
     m_ReferenceImage = timeSelector->GetOutput();
   }
+
+  // running computations keep reading the former reference image
+  if (m_Computation)
+    m_Computation->Token.Cancel();
+  m_Computation = nullptr;
+
+  m_ReferenceImageAsITK = InternalImageType::New();
   CastToItkImage(m_ReferenceImage, m_ReferenceImageAsITK);
-  m_SmoothFilter->SetInput(m_ReferenceImageAsITK);
   m_NeedUpdate = true;
 }
 
 void mitk::FastMarchingTool3D::ConfirmSegmentation()
 {
+  OutputImageType::Pointer result;
+  if (m_Computation)
+  {
+    if (m_Computation->Future.valid())
+      ThreadPool::GetInstance().Wait(m_Computation->Future);
+    result = m_Computation->Result;
+  }
+
   // combine preview image with current working segmentation
-  if (dynamic_cast<mitk::Image *>(m_ResultImageNode->GetData()))
+  if (result.IsNotNull())
   {
-    // logical or combination of preview and segmentation slice
+    // logical or combination of preview and segmentation volume
     OutputImageType::Pointer segmentationImageInITK = OutputImageType::New();
 
     mitk::Image::Pointer workingImage = dynamic_cast<mitk::Image *>(GetTargetSegmentationNode()->GetData());
@@ -293,16 +476,23 @@ void mitk::FastMarchingTool3D::ConfirmSegmentation()
       CastToItkImage(workingImage, segmentationImageInITK);
     }
 
-    typedef itk::OrImageFilter<OutputImageType, OutputImageType> OrImageFilterType;
-    OrImageFilterType::Pointer orFilter = OrImageFilterType::New();
-
-    orFilter->SetInput(0, m_ThresholdFilter->GetOutput());
-    orFilter->SetInput(1, segmentationImageInITK);
-    orFilter->Update();
-
-    // set image volume in current time step from itk image
-    workingImage->SetVolume((void *)(m_ThresholdFilter->GetOutput()->GetPixelContainer()->GetBufferPointer()),
-                            m_CurrentTimeStep);
+    // the result only covers the region around the seeds
+    const OutputImageType::RegionType &region = m_Computation->Region;
+    if (segmentationImageInITK->GetLargestPossibleRegion().IsInside(region))
+    {
+      itk::ImageRegionIterator<OutputImageType> segmentationIter(segmentationImageInITK, region);
+      itk::ImageRegionConstIterator<OutputImageType> resultIter(result, result->GetLargestPossibleRegion());
+      for (; !segmentationIter.IsAtEnd(); ++segmentationIter, ++resultIter)
+        segmentationIter.Set(segmentationIter.Get() | resultIter.Get());
+
+      // set image volume in current time step from itk image
+      workingImage->SetVolume((void *)(segmentationImageInITK->GetPixelContainer()->GetBufferPointer()),
+                              m_CurrentTimeStep);
+    }
+    else
+    {
+      MITK_WARN << "Segmentation does not cover the FastMarching result, nothing is added.";
+    }
     this->m_ResultImageNode->SetVisibility(false);
     this->ClearSeeds();
     workingImage->Modified();
@@ -329,7 +519,6 @@ void mitk::FastMarchingTool3D::OnAddPoint()
   node.SetValue(seedValue);
   node.SetIndex(seedPosition);
   this->m_SeedContainer->InsertElement(this->m_SeedContainer->Size(), node);
-  m_FastMarchingFilter->Modified();
 
   mitk::RenderingManager::GetInstance()->RequestUpdateAll();
 
@@ -347,7 +536,6 @@ void mitk::FastMarchingTool3D::OnDelete()
   {
     // delete last element of seeds container
     this->m_SeedContainer->pop_back();
-    m_FastMarchingFilter->Modified();
 
     mitk::RenderingManager::GetInstance()->RequestUpdateAll();
 
@@ -359,46 +547,142 @@ void mitk::FastMarchingTool3D::OnDelete()
 
 void mitk::FastMarchingTool3D::Update()
 {
-  const unsigned int progress_steps = 200;
+  if (!m_NeedUpdate || m_ResultImageNode.IsNull())
+    return;
+  m_NeedUpdate = false;
+
+  // the result of the running computation is outdated
+  if (m_Computation)
+    m_Computation->Token.Cancel();
+  m_Computation = nullptr;
 
-  if (m_NeedUpdate)
+  std::vector<itk::Index<3>> seeds;
+  for (auto iter = m_SeedContainer->Begin(); iter != m_SeedContainer->End(); ++iter)
+    seeds.push_back(iter->Value().GetIndex());
+
+  InternalImageType::RegionType region;
+  if (!seeds.empty())
+    region = ComputeRegionOfInterest(
+      m_ReferenceImageAsITK, seeds, std::min(m_StoppingValue, m_UpperThreshold), m_Sigma);
+
+  if (region.GetNumberOfPixels() == 0)
   {
-    m_ProgressCommand->AddStepsToDo(progress_steps);
+    m_ResultImageNode->SetVisibility(false);
+    this->SetBusy(false);
+    mitk::RenderingManager::GetInstance()->RequestUpdateAll();
+    return;
+  }
+
+  auto computation = std::make_shared<Computation>();
+  computation->Region = region;
+  m_Computation = computation;
+
+  PipelineParameters parameters;
+  parameters.LowerThreshold = m_LowerThreshold;
+  parameters.UpperThreshold = m_UpperThreshold;
+  parameters.StoppingValue = m_StoppingValue;
+  parameters.Sigma = m_Sigma;
+  parameters.Alpha = m_Alpha;
+  parameters.Beta = m_Beta;
+
+  const bool async = CallbackFromGUIThread::IsImplementationRegistered();
+  Self::Pointer self = this;
+  InternalImageType::ConstPointer image = m_ReferenceImageAsITK.GetPointer();
+
+  // called on the GUI thread
+  auto showResult = [self, computation](mitk::Image::Pointer preview, bool isFinal, const std::string &error) {
+    if (self->m_Computation != computation)
+      return;
+
+    if (!error.empty())
+    {
+      self->SetBusy(false);
+      self->ErrorMessage.Send(error);
+      return;
+    }
+
+    self->m_ResultImageNode->SetData(preview);
+    self->m_ResultImageNode->SetVisibility(true);
+    if (isFinal)
+      self->SetBusy(false);
+    mitk::RenderingManager::GetInstance()->RequestUpdateAll();
+  };
+
+  auto post = [async, showResult](mitk::Image::Pointer preview, bool isFinal, const std::string &error) {
+    if (!async)
+    {
+      showResult(preview, isFinal, error);
+      return;
+    }
+    auto command = FunctionCommand::New();
+    command->m_Callback = [showResult, preview, isFinal, error]() { showResult(preview, isFinal, error); };
+    CallbackFromGUIThread::GetInstance()->CallThisFromGUIThread(command);
+  };
 
-    // remove interaction with poinset while updating
-    m_SeedPointInteractor->SetDataNode(nullptr);
-    CurrentlyBusy.Send(true);
+  auto task = [computation, image, seeds, parameters, post]() {
     try
     {
-      m_ThresholdFilter->Update();
+      const auto &token = computation->Token;
+      if (computation->Region.GetNumberOfPixels() >= CoarsePreviewMinimumNumberOfPixels)
+      {
+        OutputImageType::Pointer coarse = RunPipeline(image, computation->Region, 2, seeds, parameters, token);
+        if (coarse.IsNull())
+          return;
+
+        mitk::Image::Pointer preview = mitk::Image::New();
+        CastToMitkImage(coarse, preview);
+        post(preview, false, std::string());
+      }
+
+      OutputImageType::Pointer result = RunPipeline(image, computation->Region, 1, seeds, parameters, token);
+      if (result.IsNull())
+        return;
+      computation->Result = result;
+
+      mitk::Image::Pointer preview = mitk::Image::New();
+      CastToMitkImage(result, preview);
+      post(preview, true, std::string());
+    }
+    catch (const itk::ProcessAborted &)
+    {
+      // canceled by a newer computation
     }
-    catch (itk::ExceptionObject &excep)
+    catch (const itk::ExceptionObject &excep)
     {
       MITK_ERROR << "Exception caught: " << excep.GetDescription();
+      post(nullptr, true, excep.GetDescription());
+    }
+  };
+
+  this->SetBusy(true);
+  if (async)
+    computation->Future =
+      ThreadPool::GetInstance().Submit(task, ThreadPool::Priority::Interactive, computation->Token);
+  else
+    task();
+}
 
-      m_ProgressCommand->SetProgress(progress_steps);
-      CurrentlyBusy.Send(false);
+void mitk::FastMarchingTool3D::CancelComputation()
+{
+  if (m_Computation && m_Computation->Future.valid())
+  {
+    m_Computation->Token.Cancel();
+    ThreadPool::GetInstance().Wait(m_Computation->Future);
+  }
+}
 
-      std::string msg = excep.GetDescription();
-      ErrorMessage.Send(msg);
+void mitk::FastMarchingTool3D::SetBusy(bool busy)
+{
+  if (m_IsBusy == busy)
+    return;
+  m_IsBusy = busy;
 
-      return;
-    }
+  const unsigned int progress_steps = 1;
+  if (busy)
+    m_ProgressCommand->AddStepsToDo(progress_steps);
+  else
     m_ProgressCommand->SetProgress(progress_steps);
-    CurrentlyBusy.Send(false);
-
-    // make output visible
-    mitk::Image::Pointer result = mitk::Image::New();
-    CastToMitkImage(m_ThresholdFilter->GetOutput(), result);
-    result->GetGeometry()->SetOrigin(m_ReferenceImage->GetGeometry()->GetOrigin());
-    result->GetGeometry()->SetIndexToWorldTransform(m_ReferenceImage->GetGeometry()->GetIndexToWorldTransform());
-    m_ResultImageNode->SetData(result);
-    m_ResultImageNode->SetVisibility(true);
-    mitk::RenderingManager::GetInstance()->RequestUpdateAll();
-
-    // add interaction with poinset again
-    m_SeedPointInteractor->SetDataNode(m_SeedsAsPointSetNode);
-  }
+  CurrentlyBusy.Send(busy);
 }
 
 void mitk::FastMarchingTool3D::ClearSeeds()
@@ -433,9 +717,6 @@ void mitk::FastMarchingTool3D::ClearSeeds()
     m_PointSetRemoveObserverTag = m_SeedsAsPointSet->AddObserver(mitk::PointSetRemoveEvent(), pointRemovedCommand);
   }
 
-  if (this->m_FastMarchingFilter.IsNotNull())
-    m_FastMarchingFilter->Modified();
-
   this->m_NeedUpdate = true;
 }
 
@@ -31,6 +31,10 @@ found in the LICENSE file.
 #include "itkGradientMagnitudeRecursiveGaussianImageFilter.h"
 #include "itkSigmoidImageFilter.h"
 
+#include <mitkThreadPool.h>
+
+#include <memory>
+
 namespace us
 {
   class ModuleResource;
@@ -47,6 +51,13 @@ namespace mitk
     The resulting binary image is seen as a segmentation of an object.
 
     For detailed documentation see ITK Software Guide section 9.3.1 Fast Marching Segmentation.
+
+    The pipeline runs on the mitk::ThreadPool and only on a region around the seeds: the speed image
+    is at most 1, so voxels whose distance to all seeds exceeds the stopping value (or the upper threshold)
+    are never part of the result. Every call of Update() cancels the computation that is still running,
+    which keeps the preview responsive while parameters are dragged. For large regions a preview at half
+    the resolution is shown before the full resolution result. Without a registered
+    mitk::CallbackFromGUIThread implementation the pipeline runs synchronously.
   */
   class MITKSEGMENTATION_EXPORT FastMarchingTool3D : public AutoSegmentationTool
   {
@@ -105,7 +116,7 @@ namespace mitk
     /// \brief Clear all seed points.
     void ClearSeeds();
 
-    /// \brief Updates the itk pipeline and shows the result of FastMarching.
+    /// \brief Starts the itk pipeline in the background and shows the result of FastMarching when it is ready.
     void Update();
 
   protected:
@@ -125,11 +136,18 @@ namespace mitk
     /// \brief Reset all relevant inputs of the itk pipeline.
     void Reset();
 
+    /// \brief Cancels the running computation and waits until it has stopped.
+    void CancelComputation();
+
+    /// \brief Sends CurrentlyBusy if the state changed.
+    void SetBusy(bool busy);
+
     mitk::ToolCommand::Pointer m_ProgressCommand;
 
     Image::Pointer m_ReferenceImage;
 
     bool m_NeedUpdate;
+    bool m_IsBusy;
 
     int m_CurrentTimeStep;
 
@@ -152,11 +170,11 @@ namespace mitk
     unsigned int m_PointSetAddObserverTag;
     unsigned int m_PointSetRemoveObserverTag;
 
-    ThresholdingFilterType::Pointer m_ThresholdFilter;
-    SmoothingFilterType::Pointer m_SmoothFilter;
-    GradientFilterType::Pointer m_GradientMagnitudeFilter;
-    SigmoidFilterType::Pointer m_SigmoidFilter;
-    FastMarchingFilterType::Pointer m_FastMarchingFilter;
+  private:
+    struct Computation;
+
+    /// The computation started by the last Update(), results of older ones are discarded
+    std::shared_ptr<Computation> m_Computation;
   };
 
 } // namespace
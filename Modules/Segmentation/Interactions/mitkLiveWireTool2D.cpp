@@ -26,7 +26,12 @@ namespace mitk
 }
 
 mitk::LiveWireTool2D::LiveWireTool2D()
-  : SegTool2D("LiveWireTool"), m_CreateAndUseDynamicCosts(false)
+  : SegTool2D("LiveWireTool"),
+    m_WorkingSliceReferenceImage(nullptr),
+    m_WorkingSliceReferenceImageMTime(0),
+    m_WorkingSliceTimeStep(0),
+    m_WorkingSliceDisplayedComponent(0),
+    m_CreateAndUseDynamicCosts(false)
 {
 }
 
@@ -256,13 +261,33 @@ void mitk::LiveWireTool2D::OnInitLiveWire(StateMachineAction *, InteractionEvent
   dataStorage->Add(m_LiveWireContourNode, workingDataNode);
   dataStorage->Add(m_EditingContourNode, workingDataNode);
 
-  // Set current slice as input for ImageToLiveWireContourFilter
-  m_WorkingSlice = this->GetAffectedReferenceSlice(positionEvent);
-
-  auto origin = m_WorkingSlice->GetSlicedGeometry()->GetOrigin();
-  m_WorkingSlice->GetSlicedGeometry()->WorldToIndex(origin, origin);
-  m_WorkingSlice->GetSlicedGeometry()->IndexToWorld(origin, origin);
-  m_WorkingSlice->GetSlicedGeometry()->SetOrigin(origin);
+  // Set current slice as input for ImageToLiveWireContourFilter. The slice is only extracted again if another
+  // slice or the reference image changed, so all live-wire filters on this slice share the precomputed costs.
+  auto referenceNode = m_ToolManager->GetReferenceData(0);
+  auto referenceImage = nullptr != referenceNode ? dynamic_cast<Image *>(referenceNode->GetData()) : nullptr;
+  auto planeGeometry = positionEvent->GetSender()->GetCurrentWorldPlaneGeometry();
+  int displayedComponent = 0;
+  if (nullptr != referenceNode)
+    referenceNode->GetIntProperty("Image.Displayed Component", displayedComponent);
+
+  if (m_WorkingSlice.IsNull() || nullptr == referenceImage || referenceImage != m_WorkingSliceReferenceImage ||
+      referenceImage->GetMTime() != m_WorkingSliceReferenceImageMTime || t != m_WorkingSliceTimeStep ||
+      displayedComponent != m_WorkingSliceDisplayedComponent || m_WorkingSlicePlaneGeometry.IsNull() ||
+      nullptr == planeGeometry || !Equal(*planeGeometry, *m_WorkingSlicePlaneGeometry, eps, false))
+  {
+    m_WorkingSlice = this->GetAffectedReferenceSlice(positionEvent);
+
+    auto origin = m_WorkingSlice->GetSlicedGeometry()->GetOrigin();
+    m_WorkingSlice->GetSlicedGeometry()->WorldToIndex(origin, origin);
+    m_WorkingSlice->GetSlicedGeometry()->IndexToWorld(origin, origin);
+    m_WorkingSlice->GetSlicedGeometry()->SetOrigin(origin);
+
+    m_WorkingSliceReferenceImage = referenceImage;
+    m_WorkingSliceReferenceImageMTime = nullptr != referenceImage ? referenceImage->GetMTime() : 0;
+    m_WorkingSlicePlaneGeometry = nullptr != planeGeometry ? planeGeometry->Clone().GetPointer() : nullptr;
+    m_WorkingSliceTimeStep = t;
+    m_WorkingSliceDisplayedComponent = displayedComponent;
+  }
 
   m_LiveWireFilter = ImageLiveWireContourModelFilter::New();
   m_LiveWireFilter->SetInput(m_WorkingSlice);
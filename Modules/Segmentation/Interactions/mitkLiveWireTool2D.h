@@ -110,6 +110,14 @@ namespace mitk
 
     mitk::Image::Pointer m_WorkingSlice;
 
+    /** \brief The reference image (only for comparison), its modified time, the plane geometry, the time step and
+    the displayed component of m_WorkingSlice. The slice is reused for new contours while they are unchanged.*/
+    const Image *m_WorkingSliceReferenceImage;
+    itk::ModifiedTimeType m_WorkingSliceReferenceImageMTime;
+    PlaneGeometry::ConstPointer m_WorkingSlicePlaneGeometry;
+    TimeStepType m_WorkingSliceTimeStep;
+    int m_WorkingSliceDisplayedComponent;
+
     mitk::ImageLiveWireContourModelFilter::Pointer m_LiveWireFilter;
 
     bool m_CreateAndUseDynamicCosts;
@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include "mitkLabelSetImage.h"
 #include "mitkOtsuSegmentationFilter.h"
 #include "mitkRenderingManager.h"
+#include "mitkThreadPool.h"
 #include "mitkToolManager.h"
 #include <mitkITKImageImport.h>
 #include <mitkImageCast.h>
@@ -25,8 +26,6 @@ found in the LICENSE file.
 #include <mitkSliceNavigationController.h>
 
 // ITK
-#include <itkBinaryThresholdImageFilter.h>
-#include <itkOrImageFilter.h>
 #include <itkOtsuMultipleThresholdsImageFilter.h>
 
 // us
@@ -37,12 +36,14 @@ found in the LICENSE file.
 
 #include <mitkImageStatisticsHolder.h>
 
+#include <algorithm>
+
 namespace mitk
 {
   MITK_TOOL_MACRO(MITKSEGMENTATION_EXPORT, OtsuTool3D, "Otsu Segmentation");
 }
 
-mitk::OtsuTool3D::OtsuTool3D()
+mitk::OtsuTool3D::OtsuTool3D() : m_Image3DTimeStep(0), m_Image3DMTime(0)
 {
 }
 
@@ -82,6 +83,9 @@ void mitk::OtsuTool3D::Activated()
 
 void mitk::OtsuTool3D::Deactivated()
 {
+  m_Image3D = nullptr;
+  m_OtsuFilter = nullptr;
+
   m_ToolManager->GetDataStorage()->Remove(this->m_MultiLabelResultNode);
   m_MultiLabelResultNode = nullptr;
   m_ToolManager->GetDataStorage()->Remove(this->m_BinaryPreviewNode);
@@ -112,17 +116,24 @@ void mitk::OtsuTool3D::RunSegmentation(int regions, bool useValley, int numberOf
 
   unsigned int timestep = mitk::RenderingManager::GetInstance()->GetTimeNavigationController()->GetTime()->GetPos();
 
-  mitk::Image::Pointer image3D = Get3DImage(m_OriginalImage, timestep);
+  // keeping the input and the filter lets the filter reuse its histogram
+  if (m_Image3D.IsNull() || m_Image3DTimeStep != timestep || m_Image3DMTime != m_OriginalImage->GetMTime())
+  {
+    m_Image3D = Get3DImage(m_OriginalImage, timestep);
+    m_Image3DTimeStep = timestep;
+    m_Image3DMTime = m_OriginalImage->GetMTime();
+  }
 
-  mitk::OtsuSegmentationFilter::Pointer otsuFilter = mitk::OtsuSegmentationFilter::New();
-  otsuFilter->SetNumberOfThresholds(numberOfThresholds);
-  otsuFilter->SetValleyEmphasis(useValley);
-  otsuFilter->SetNumberOfBins(numberOfBins);
-  otsuFilter->SetInput(image3D);
+  if (m_OtsuFilter.IsNull())
+    m_OtsuFilter = mitk::OtsuSegmentationFilter::New();
+  m_OtsuFilter->SetNumberOfThresholds(numberOfThresholds);
+  m_OtsuFilter->SetValleyEmphasis(useValley);
+  m_OtsuFilter->SetNumberOfBins(numberOfBins);
+  m_OtsuFilter->SetInput(m_Image3D);
 
   try
   {
-    otsuFilter->Update();
+    m_OtsuFilter->Update();
   }
   catch (...)
   {
@@ -138,7 +149,7 @@ void mitk::OtsuTool3D::RunSegmentation(int regions, bool useValley, int numberOf
   m_MultiLabelResultNode->SetOpacity(1.0);
 
   mitk::LabelSetImage::Pointer resultImage = mitk::LabelSetImage::New();
-  resultImage->InitializeByLabeledImage(otsuFilter->GetOutput());
+  resultImage->InitializeByLabeledImage(m_OtsuFilter->GetOutput());
   this->m_MultiLabelResultNode->SetData(resultImage);
   m_MultiLabelResultNode->SetProperty("binary", mitk::BoolProperty::New(false));
   mitk::RenderingModeProperty::Pointer renderingMode = mitk::RenderingModeProperty::New();
@@ -186,52 +197,31 @@ void mitk::OtsuTool3D::UpdateBinaryPreview(std::vector<int> regionIDs)
 template <typename TPixel, unsigned int VImageDimension>
 void mitk::OtsuTool3D::CalculatePreview(itk::Image<TPixel, VImageDimension> *itkImage, std::vector<int> regionIDs)
 {
-  typedef itk::Image<TPixel, VImageDimension> InputImageType;
   typedef itk::Image<mitk::Tool::DefaultSegmentationDataType, VImageDimension> OutputImageType;
 
-  typedef itk::BinaryThresholdImageFilter<InputImageType, OutputImageType> FilterType;
-
-  typename FilterType::Pointer filter = FilterType::New();
-
-  // InputImageType::Pointer itkImage;
-  typename OutputImageType::Pointer itkBinaryTempImage1;
-  typename OutputImageType::Pointer itkBinaryTempImage2;
-  typename OutputImageType::Pointer itkBinaryResultImage;
+  std::vector<TPixel> labels;
+  for (int regionID : regionIDs)
+    labels.push_back(static_cast<TPixel>(regionID));
+
+  typename OutputImageType::Pointer itkBinaryResultImage = OutputImageType::New();
+  itkBinaryResultImage->CopyInformation(itkImage);
+  itkBinaryResultImage->SetRegions(itkImage->GetLargestPossibleRegion());
+  itkBinaryResultImage->Allocate();
+
+  // the union of all given regions in a single pass
+  const TPixel *input = itkImage->GetBufferPointer();
+  auto *output = itkBinaryResultImage->GetBufferPointer();
+  mitk::ThreadPool::GetInstance().ParallelFor(
+    0,
+    itkBinaryResultImage->GetLargestPossibleRegion().GetNumberOfPixels(),
+    [&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i)
+        output[i] = std::find(labels.begin(), labels.end(), input[i]) != labels.end() ? 1 : 0;
+    },
+    1 << 16);
 
-  // mitk::Image::Pointer multiLabelSegmentation = dynamic_cast<mitk::Image*>(m_MultiLabelResultNode->GetData());
-  // mitk::CastToItkImage(multiLabelSegmentation, itkImage);
-
-  filter->SetInput(itkImage);
-  filter->SetLowerThreshold(regionIDs[0]);
-  filter->SetUpperThreshold(regionIDs[0]);
-  filter->SetInsideValue(1);
-  filter->SetOutsideValue(0);
-  filter->Update();
-  itkBinaryTempImage2 = filter->GetOutput();
-
-  typename itk::OrImageFilter<OutputImageType, OutputImageType>::Pointer orFilter =
-    itk::OrImageFilter<OutputImageType, OutputImageType>::New();
-
-  // if more than one region id is used compute the union of all given binary regions
-  for (auto it = regionIDs.begin(); it != regionIDs.end(); ++it)
-  {
-    filter->SetLowerThreshold(*it);
-    filter->SetUpperThreshold(*it);
-    filter->SetInsideValue(1);
-    filter->SetOutsideValue(0);
-    filter->Update();
-    itkBinaryTempImage1 = filter->GetOutput();
-
-    orFilter->SetInput1(itkBinaryTempImage1);
-    orFilter->SetInput2(itkBinaryTempImage2);
-
-    orFilter->UpdateLargestPossibleRegion();
-    itkBinaryResultImage = orFilter->GetOutput();
-    itkBinaryTempImage2 = itkBinaryResultImage;
-  }
   //----------------------------------------------------------------------------------------------------
-  mitk::Image::Pointer binarySegmentation;
-  mitk::CastToMitkImage(itkBinaryResultImage, binarySegmentation);
+  mitk::Image::Pointer binarySegmentation = mitk::GrabItkImageMemory(itkBinaryResultImage);
   m_BinaryPreviewNode->SetData(binarySegmentation);
   m_BinaryPreviewNode->SetVisibility(true);
   m_BinaryPreviewNode->SetProperty("outline binary", mitk::BoolProperty::New(false));
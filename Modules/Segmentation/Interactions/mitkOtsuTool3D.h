@@ -24,7 +24,14 @@ namespace us
 namespace mitk
 {
   class Image;
+  class OtsuSegmentationFilter;
 
+  /**
+    \brief Multiple threshold Otsu segmentation tool.
+
+    The filter and the extracted time step are kept while the tool is active, so running the segmentation
+    again with another number of regions or valley emphasis reuses the histogram of the image.
+  */
   class MITKSEGMENTATION_EXPORT OtsuTool3D : public AutoSegmentationTool
   {
   public:
@@ -56,6 +63,11 @@ namespace mitk
     void CalculatePreview(itk::Image<TPixel, VImageDimension> *itkImage, std::vector<int> regionIDs);
 
     itk::SmartPointer<Image> m_OriginalImage;
+    // the time step of the original image the filter runs on
+    itk::SmartPointer<Image> m_Image3D;
+    unsigned int m_Image3DTimeStep;
+    unsigned long m_Image3DMTime;
+    itk::SmartPointer<OtsuSegmentationFilter> m_OtsuFilter;
     // holds the user selected binary segmentation
     mitk::DataNode::Pointer m_BinaryPreviewNode;
     // holds the multilabel result as a preview image
@@ -23,6 +23,7 @@ found in the LICENSE file.
 #include "mitkExtractDirectedPlaneImageFilterNew.h"
 #include "mitkLabelSetImage.h"
 #include "mitkOverwriteDirectedPlaneImageFilter.h"
+#include "mitkParallelFloodFill.h"
 
 // us
 #include <usGetModuleContext.h>
@@ -34,7 +35,6 @@ found in the LICENSE file.
 #include "mitkITKImageImport.h"
 #include "mitkImageAccessByItk.h"
 #include <itkConnectedComponentImageFilter.h>
-#include <itkConnectedThresholdImageFilter.h>
 #include <itkImageRegionIteratorWithIndex.h>
 #include <itkNeighborhoodIterator.h>
 
@@ -195,26 +195,24 @@ void mitk::RegionGrowingTool::StartRegionGrowing(itk::Image<TPixel, imageDimensi
   typedef itk::Image<TPixel, imageDimension> InputImageType;
   typedef itk::Image<DefaultSegmentationDataType, imageDimension> OutputImageType;
 
-  typedef itk::ConnectedThresholdImageFilter<InputImageType, OutputImageType> RegionGrowingFilterType;
-  typename RegionGrowingFilterType::Pointer regionGrower = RegionGrowingFilterType::New();
-
   // perform region growing in desired segmented region
-  regionGrower->SetInput(inputImage);
-  regionGrower->AddSeed(seedIndex);
+  ParallelFloodFill<InputImageType, OutputImageType> regionGrower;
+  regionGrower.SetInput(inputImage);
+  regionGrower.AddSeed(seedIndex);
 
-  regionGrower->SetLower(thresholds[0]);
-  regionGrower->SetUpper(thresholds[1]);
+  regionGrower.SetLower(thresholds[0]);
+  regionGrower.SetUpper(thresholds[1]);
 
   try
   {
-    regionGrower->Update();
+    regionGrower.Update();
   }
   catch (...)
   {
     return; // Should we do something?
   }
 
-  typename OutputImageType::Pointer resultImage = regionGrower->GetOutput();
+  typename OutputImageType::Pointer resultImage = regionGrower.GetOutput();
 
   // Smooth result: Every pixel is replaced by the majority of the neighborhood
   typedef itk::NeighborhoodIterator<OutputImageType> NeighborhoodIteratorType;
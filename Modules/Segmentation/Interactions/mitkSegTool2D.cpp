@@ -45,6 +45,8 @@ found in the LICENSE file.
 #include "mitkOperationEvent.h"
 #include "mitkUndoController.h"
 #include <mitkDiffSliceOperationApplier.h>
+#include <mitkLabelDeltaOperation.h>
+#include <mitkLabelDeltaOperationApplier.h>
 
 #include "mitkAbstractTransformGeometry.h"
 #include "mitkImageAccessByItk.h"
@@ -367,16 +369,14 @@ void mitk::SegTool2D::WriteSliceToVolume(const mitk::SegTool2D::SliceInformation
 {
   DataNode *workingNode(m_ToolManager->GetWorkingData(0));
   auto *image = dynamic_cast<Image *>(workingNode->GetData());
+  auto *labelSetImage = dynamic_cast<LabelSetImage *>(image);
+  const bool useLabelHistory = labelSetImage != nullptr && labelSetImage->GetLabelHistoryEnabled();
 
   /*============= BEGIN undo/redo feature block ========================*/
-  // Create undo operation by caching the not yet modified slices
-  mitk::Image::Pointer originalSlice = GetAffectedImageSliceAs2DImage(sliceInfo.plane, image, sliceInfo.timestep);
-  auto *undoOperation =
-    new DiffSliceOperation(image,
-                           originalSlice,
-                           dynamic_cast<SlicedGeometry3D *>(originalSlice->GetGeometry()),
-                           sliceInfo.timestep,
-                           sliceInfo.plane);
+  // Keep the not yet modified slice for the undo operation, the label history records the changes itself
+  mitk::Image::Pointer originalSlice;
+  if (!useLabelHistory)
+    originalSlice = GetAffectedImageSliceAs2DImage(sliceInfo.plane, image, sliceInfo.timestep);
   /*============= END undo/redo feature block ========================*/
 
   // Make sure that for reslicing and overwriting the same alogrithm is used. We can specify the mode of the vtk
@@ -397,18 +397,56 @@ void mitk::SegTool2D::WriteSliceToVolume(const mitk::SegTool2D::SliceInformation
   extractor->SetVtkOutputRequest(false);
   extractor->SetResliceTransformByGeometry(image->GetGeometry(sliceInfo.timestep));
 
+  // update the label statistics by scanning the overwritten region only
+  const Image::RegionType region = image->GetRegionOfPlane(sliceInfo.plane, sliceInfo.timestep);
+  if (labelSetImage != nullptr)
+    labelSetImage->BeginLabelStatisticsUpdate(region);
+
   extractor->Modified();
   extractor->Update();
 
   // the image was modified within the pipeline, but not marked so
-  image->Modified();
+  image->RegionModified(region);
   image->GetVtkImageData()->Modified();
 
+  if (labelSetImage != nullptr)
+    labelSetImage->EndLabelStatisticsUpdate(region);
+
   /*============= BEGIN undo/redo feature block ========================*/
-  // specify the undo operation with the edited slice
+  if (useLabelHistory)
+  {
+    // the operations refer to the run-length encoded changes recorded by the image, which can also be
+    // undone per label, see LabelSetImage::UndoLabelChange()
+    const LabelDeltaHistory::EditId edit = labelSetImage->GetLastRecordedEdit();
+    if (edit != 0)
+    {
+      auto *undoOperation = new LabelDeltaOperation(labelSetImage, edit, true);
+      auto *doOperation = new LabelDeltaOperation(labelSetImage, edit, false);
+      OperationEvent *undoStackItem =
+        new OperationEvent(LabelDeltaOperationApplier::GetInstance(), doOperation, undoOperation, "Segmentation");
+
+      UndoStackItem::IncCurrObjectEventId();
+      UndoStackItem::IncCurrGroupEventId();
+      UndoController::GetCurrentUndoModel()->SetOperationEvent(undoStackItem);
+    }
+    return;
+  }
+
+  // both operations store only the pixels changed by the edit: undo restores them in the edited
+  // slice, redo in the original slice
+  Image::Pointer editedSlice = extractor->GetOutput();
+  auto *undoOperation =
+    new DiffSliceOperation(image,
+                           originalSlice,
+                           editedSlice,
+                           dynamic_cast<SlicedGeometry3D *>(originalSlice->GetGeometry()),
+                           sliceInfo.timestep,
+                           sliceInfo.plane);
+
   auto *doOperation =
     new DiffSliceOperation(image,
-                           extractor->GetOutput(),
+                           editedSlice,
+                           originalSlice,
                            dynamic_cast<SlicedGeometry3D *>(sliceInfo.slice->GetGeometry()),
                            sliceInfo.timestep,
                            sliceInfo.plane);
@@ -17,13 +17,13 @@ found in the LICENSE file.
 #include "mitkBaseRenderer.h"
 #include "mitkImageDataItem.h"
 #include "mitkLabelSetImage.h"
+#include "mitkParallelFloodFill.h"
 
 #include <mitkITKImageImport.h>
 #include <mitkImagePixelReadAccessor.h>
 #include <mitkImageToContourModelFilter.h>
 
 #include <itkBinaryFillholeImageFilter.h>
-#include <itkConnectedThresholdImageFilter.h>
 
 mitk::SetRegionTool::SetRegionTool(int paintingPixelValue)
   : FeedbackContourTool("PressMoveRelease"), m_PaintingPixelValue(paintingPixelValue)
@@ -77,8 +77,7 @@ void mitk::SetRegionTool::OnMousePressed(StateMachineAction *, InteractionEvent
 
   typedef itk::Image<DefaultSegmentationDataType, 2> InputImageType;
   typedef InputImageType::IndexType IndexType;
-  typedef itk::ConnectedThresholdImageFilter<InputImageType, InputImageType> RegionGrowingFilterType;
-  RegionGrowingFilterType::Pointer regionGrower = RegionGrowingFilterType::New();
+  ParallelFloodFill<InputImageType, InputImageType> regionGrower;
 
   // convert world coordinates to image indices
   IndexType seedIndex;
@@ -87,19 +86,20 @@ void mitk::SetRegionTool::OnMousePressed(StateMachineAction *, InteractionEvent
   // perform region growing in desired segmented region
   InputImageType::Pointer itkImage = InputImageType::New();
   CastToItkImage(workingSlice, itkImage);
-  regionGrower->SetInput(itkImage);
-  regionGrower->AddSeed(seedIndex);
+  regionGrower.SetInput(itkImage);
+  regionGrower.AddSeed(seedIndex);
 
   InputImageType::PixelType bound = itkImage->GetPixel(seedIndex);
 
-  regionGrower->SetLower(bound);
-  regionGrower->SetUpper(bound);
-  regionGrower->SetReplaceValue(1);
+  regionGrower.SetLower(bound);
+  regionGrower.SetUpper(bound);
+  regionGrower.SetReplaceValue(1);
+  regionGrower.Update();
 
   itk::BinaryFillholeImageFilter<InputImageType>::Pointer fillHolesFilter =
     itk::BinaryFillholeImageFilter<InputImageType>::New();
 
-  fillHolesFilter->SetInput(regionGrower->GetOutput());
+  fillHolesFilter->SetInput(regionGrower.GetOutput());
   fillHolesFilter->SetForegroundValue(1);
 
   // Store result and preview
@@ -12,6 +12,7 @@ found in the LICENSE file.
 
 #include "mitkWatershedTool.h"
 
+#include "mitkCallbackFromGUIThread.h"
 #include "mitkIOUtil.h"
 #include "mitkITKImageImport.h"
 #include "mitkImage.h"
@@ -45,12 +46,88 @@ namespace mitk
   MITK_TOOL_MACRO(MITKSEGMENTATION_EXPORT, WatershedTool, "Watershed tool");
 }
 
-mitk::WatershedTool::WatershedTool() : m_Threshold(0.0), m_Level(0.0)
+namespace
+{
+  /** Aborts the observed filter at its next progress event once the token is canceled. */
+  class AbortOnCancelCommand : public itk::Command
+  {
+  public:
+    typedef AbortOnCancelCommand Self;
+    typedef itk::SmartPointer<Self> Pointer;
+    itkFactorylessNewMacro(Self);
+
+    mitk::ThreadPool::CancellationToken m_Token;
+
+    void Execute(itk::Object *caller, const itk::EventObject &) override
+    {
+      if (m_Token.IsCanceled())
+        static_cast<itk::ProcessObject *>(caller)->AbortGenerateDataOn();
+    }
+
+    void Execute(const itk::Object *, const itk::EventObject &) override {}
+  };
+
+  class FunctionCommand : public itk::Command
+  {
+  public:
+    typedef FunctionCommand Self;
+    typedef itk::SmartPointer<Self> Pointer;
+    itkFactorylessNewMacro(Self);
+
+    std::function<void()> m_Callback;
+
+    void Execute(itk::Object *, const itk::EventObject &) override { m_Callback(); }
+    void Execute(const itk::Object *, const itk::EventObject &) override { m_Callback(); }
+  };
+
+  template <typename TPixel, unsigned int VImageDimension>
+  void ComputeWatershed(itk::Image<TPixel, VImageDimension> *originalImage,
+                        double threshold,
+                        double level,
+                        itk::Command *observer,
+                        mitk::Image::Pointer &segmentation)
+  {
+    typedef itk::WatershedImageFilter<itk::Image<float, VImageDimension>> WatershedFilter;
+    typedef itk::GradientMagnitudeRecursiveGaussianImageFilter<itk::Image<TPixel, VImageDimension>,
+                                                               itk::Image<float, VImageDimension>>
+      MagnitudeFilter;
+
+    // at first add a gradient magnitude filter
+    typename MagnitudeFilter::Pointer magnitude = MagnitudeFilter::New();
+    magnitude->SetInput(originalImage);
+    magnitude->SetSigma(1.0);
+
+    // then add the watershed filter to the pipeline
+    typename WatershedFilter::Pointer watershed = WatershedFilter::New();
+    watershed->SetInput(magnitude->GetOutput());
+    watershed->SetThreshold(threshold);
+    watershed->SetLevel(level);
+    watershed->AddObserver(itk::ProgressEvent(), observer);
+    watershed->Update();
+
+    // then make sure, that the output has the desired pixel type
+    typedef itk::CastImageFilter<typename WatershedFilter::OutputImageType,
+                                 itk::Image<mitk::Tool::DefaultSegmentationDataType, VImageDimension>>
+      CastFilter;
+    typename CastFilter::Pointer cast = CastFilter::New();
+    cast->SetInput(watershed->GetOutput());
+
+    // start the whole pipeline
+    cast->Update();
+
+    // since we obtain a new image from our pipeline, we have to make sure, that our mitk::Image::Pointer
+    // is responsible for the memory management of the output image
+    segmentation = mitk::GrabItkImageMemory(cast->GetOutput());
+  }
+}
+
+mitk::WatershedTool::WatershedTool() : m_Threshold(0.0), m_Level(0.0), m_ComputationId(0), m_IsComputing(false)
 {
 }
 
 mitk::WatershedTool::~WatershedTool()
 {
+  this->CancelComputation();
 }
 
 void mitk::WatershedTool::Activated()
@@ -60,9 +137,19 @@ void mitk::WatershedTool::Activated()
 
 void mitk::WatershedTool::Deactivated()
 {
+  this->CancelComputation();
+  this->AddSegmentation(++m_ComputationId, nullptr);
+
   Superclass::Deactivated();
 }
 
+void mitk::WatershedTool::CancelComputation()
+{
+  m_CancellationToken.Cancel();
+  if (m_Computation.valid())
+    ThreadPool::GetInstance().Wait(m_Computation);
+}
+
 us::ModuleResource mitk::WatershedTool::GetIconResource() const
 {
   us::Module *module = us::GetModuleContext()->GetModule();
@@ -91,48 +178,109 @@ void mitk::WatershedTool::DoIt()
   unsigned int timestep = mitk::RenderingManager::GetInstance()->GetTimeNavigationController()->GetTime()->GetPos();
   input = Get3DImage(input, timestep);
 
-  mitk::Image::Pointer output;
+  // a computation that is still running uses outdated parameters
+  m_CancellationToken.Cancel();
+  m_CancellationToken = ThreadPool::CancellationToken();
+  const unsigned long computationId = ++m_ComputationId;
 
-  try
+  if (!m_IsComputing)
   {
-    // create and run itk filter pipeline
-    AccessByItk_1(input.GetPointer(), ITKWatershed, output);
-
-    mitk::LabelSetImage::Pointer labelSetOutput = mitk::LabelSetImage::New();
-    labelSetOutput->InitializeByLabeledImage(output);
-
-    // create a new datanode for output
-    mitk::DataNode::Pointer dataNode = mitk::DataNode::New();
-    dataNode->SetData(labelSetOutput);
-
-    // set name of data node
-    std::string name = referenceData->GetName() + "_Watershed";
-    dataNode->SetName(name);
-
-    // look, if there is already a node with this name
-    mitk::DataStorage::SetOfObjects::ConstPointer children =
-      m_ToolManager->GetDataStorage()->GetDerivations(referenceData);
-    mitk::DataStorage::SetOfObjects::ConstIterator currentNode = children->Begin();
-    mitk::DataNode::Pointer removeNode;
-    while (currentNode != children->End())
+    m_IsComputing = true;
+    mitk::ProgressBar::GetInstance()->AddStepsToDo(1);
+  }
+
+  const bool async = CallbackFromGUIThread::IsImplementationRegistered();
+  Self::Pointer self = this;
+  const double threshold = m_Threshold;
+  const double level = m_Level;
+  const ThreadPool::CancellationToken token = m_CancellationToken;
+
+  auto task = [self, async, computationId, input, threshold, level, token]() {
+    mitk::Image::Pointer output;
+    try
+    {
+      auto abortCommand = AbortOnCancelCommand::New();
+      abortCommand->m_Token = token;
+
+      // create and run itk filter pipeline
+      AccessByItk_n(input.GetPointer(), ComputeWatershed, (threshold, level, abortCommand.GetPointer(), output));
+
+      mitk::LabelSetImage::Pointer labelSetOutput = mitk::LabelSetImage::New();
+      labelSetOutput->InitializeByLabeledImage(output);
+      output = labelSetOutput;
+    }
+    catch (const itk::ProcessAborted &)
+    {
+      // canceled by a newer computation
+      return;
+    }
+    catch (itk::ExceptionObject &e)
     {
-      if (dataNode->GetName().compare(currentNode->Value()->GetName()) == 0)
-      {
-        removeNode = currentNode->Value();
-      }
-      currentNode++;
+      MITK_ERROR << "Watershed Filter Error: " << e.GetDescription();
+      output = nullptr;
     }
-    // remove node with same name
-    if (removeNode.IsNotNull())
-      m_ToolManager->GetDataStorage()->Remove(removeNode);
 
-    // add output to the data storage
-    m_ToolManager->GetDataStorage()->Add(dataNode, referenceData);
+    if (!async)
+    {
+      self->AddSegmentation(computationId, output);
+      return;
+    }
+    auto command = FunctionCommand::New();
+    command->m_Callback = [self, computationId, output]() { self->AddSegmentation(computationId, output); };
+    CallbackFromGUIThread::GetInstance()->CallThisFromGUIThread(command);
+  };
+
+  if (async)
+    m_Computation = ThreadPool::GetInstance().Submit(task, ThreadPool::Priority::Visible, token);
+  else
+    task();
+}
+
+void mitk::WatershedTool::AddSegmentation(unsigned long computationId, mitk::Image::Pointer segmentation)
+{
+  if (computationId != m_ComputationId)
+    return;
+
+  if (m_IsComputing)
+  {
+    m_IsComputing = false;
+    mitk::ProgressBar::GetInstance()->Progress(1);
   }
-  catch (itk::ExceptionObject &e)
+
+  if (segmentation.IsNull())
+    return;
+
+  mitk::DataNode::Pointer referenceData = m_ToolManager->GetReferenceData(0);
+  if (referenceData.IsNull())
+    return;
+
+  // create a new datanode for output
+  mitk::DataNode::Pointer dataNode = mitk::DataNode::New();
+  dataNode->SetData(segmentation);
+
+  // set name of data node
+  std::string name = referenceData->GetName() + "_Watershed";
+  dataNode->SetName(name);
+
+  // look, if there is already a node with this name
+  mitk::DataStorage::SetOfObjects::ConstPointer children =
+    m_ToolManager->GetDataStorage()->GetDerivations(referenceData);
+  mitk::DataStorage::SetOfObjects::ConstIterator currentNode = children->Begin();
+  mitk::DataNode::Pointer removeNode;
+  while (currentNode != children->End())
   {
-    MITK_ERROR << "Watershed Filter Error: " << e.GetDescription();
+    if (dataNode->GetName().compare(currentNode->Value()->GetName()) == 0)
+    {
+      removeNode = currentNode->Value();
+    }
+    currentNode++;
   }
+  // remove node with same name
+  if (removeNode.IsNotNull())
+    m_ToolManager->GetDataStorage()->Remove(removeNode);
+
+  // add output to the data storage
+  m_ToolManager->GetDataStorage()->Add(dataNode, referenceData);
 
   RenderingManager::GetInstance()->RequestUpdateAll();
 }
@@ -141,42 +289,12 @@ template <typename TPixel, unsigned int VImageDimension>
 void mitk::WatershedTool::ITKWatershed(itk::Image<TPixel, VImageDimension> *originalImage,
                                        mitk::Image::Pointer &segmentation)
 {
-  typedef itk::WatershedImageFilter<itk::Image<float, VImageDimension>> WatershedFilter;
-  typedef itk::GradientMagnitudeRecursiveGaussianImageFilter<itk::Image<TPixel, VImageDimension>,
-                                                             itk::Image<float, VImageDimension>>
-    MagnitudeFilter;
-
-  // at first add a gradient magnitude filter
-  typename MagnitudeFilter::Pointer magnitude = MagnitudeFilter::New();
-  magnitude->SetInput(originalImage);
-  magnitude->SetSigma(1.0);
-
   // use the progress bar
   mitk::ToolCommand::Pointer command = mitk::ToolCommand::New();
   command->AddStepsToDo(60);
 
-  // then add the watershed filter to the pipeline
-  typename WatershedFilter::Pointer watershed = WatershedFilter::New();
-  watershed->SetInput(magnitude->GetOutput());
-  watershed->SetThreshold(m_Threshold);
-  watershed->SetLevel(m_Level);
-  watershed->AddObserver(itk::ProgressEvent(), command);
-  watershed->Update();
-
-  // then make sure, that the output has the desired pixel type
-  typedef itk::CastImageFilter<typename WatershedFilter::OutputImageType,
-                               itk::Image<Tool::DefaultSegmentationDataType, VImageDimension>>
-    CastFilter;
-  typename CastFilter::Pointer cast = CastFilter::New();
-  cast->SetInput(watershed->GetOutput());
-
-  // start the whole pipeline
-  cast->Update();
+  ComputeWatershed(originalImage, m_Threshold, m_Level, command, segmentation);
 
   // reset the progress bar by setting progress
   command->SetProgress(10);
-
-  // since we obtain a new image from our pipeline, we have to make sure, that our mitk::Image::Pointer
-  // is responsible for the memory management of the output image
-  segmentation = mitk::GrabItkImageMemory(cast->GetOutput());
 }
@@ -15,6 +15,7 @@ found in the LICENSE file.
 
 #include "mitkAutoSegmentationTool.h"
 #include "mitkCommon.h"
+#include "mitkThreadPool.h"
 #include <MitkSegmentationExports.h>
 #include <itkImage.h>
 
@@ -35,6 +36,9 @@ namespace mitk
 
     Wraps ITK Watershed Filter into tool concept of MITK. For more information look into ITK documentation.
 
+    DoIt() runs the filter pipeline on the mitk::ThreadPool and cancels a computation that is still
+    running with former parameters.
+
     \warning Only to be instantiated by mitk::ToolManager.
 
     $Darth Vader$
@@ -54,7 +58,10 @@ namespace mitk
     void SetLevel(double l) { m_Level = l; }
     /** \brief Grabs the tool reference data and creates an ITK pipeline consisting of a GradientMagnitude
       * image filter followed by a Watershed image filter. The output of the filter pipeline is then added
-      * to the data storage. */
+      * to the data storage.
+      *
+      * The pipeline runs in the background if a mitk::CallbackFromGUIThread implementation is registered,
+      * the output is added from the GUI thread then. */
     void DoIt();
 
     /** \brief Creates and runs an ITK filter pipeline consisting of the filters: GradientMagnitude-, Watershed- and
@@ -77,10 +84,22 @@ namespace mitk
     void Activated() override;
     void Deactivated() override;
 
+    /** \brief Cancels the running computation and waits until it has stopped. */
+    void CancelComputation();
+
+    /** \brief Adds the output of the computation with the given id to the data storage. */
+    void AddSegmentation(unsigned long computationId, itk::SmartPointer<mitk::Image> segmentation);
+
     /** \brief Threshold parameter of the ITK Watershed Image Filter. See ITK Documentation for more information. */
     double m_Threshold;
     /** \brief Threshold parameter of the ITK Watershed Image Filter. See ITK Documentation for more information. */
     double m_Level;
+
+    /** \brief Id of the last computation started by DoIt(), outputs of older ones are discarded. */
+    unsigned long m_ComputationId;
+    bool m_IsComputing;
+    ThreadPool::CancellationToken m_CancellationToken;
+    std::future<void> m_Computation;
   };
 
 } // namespace
@@ -0,0 +1,323 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkIOUtil.h>
+#include <mitkInteractionTestHelper.h>
+#include <mitkToolManager.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <vector>
+
+/*
+  Replays an interaction recorded with mitk::EventRecorder (e.g. by the InteractionEventRecorder plugin)
+  against off-screen render windows and reports the latency of every event, i.e. the time to process
+  the event plus the time to render the windows it requested an update of. Latencies are summarized
+  per event class (scrolling, mouse moves of paint strokes or live-wire, crosshair clicks, ...).
+
+  The image is loaded as reference data. If a segmentation tool is given, it is activated on an empty
+  segmentation of the image (or on the given segmentation), so that tool interactions can be measured.
+
+  By default the events are dispatched as fast as possible, which makes the replay deterministic.
+  With --realtime the recorded timestamps are honored and the lag behind the recording is reported, too.
+*/
+
+namespace
+{
+  typedef mitk::InteractionTestHelper::ReplayedEvent ReplayedEvent;
+
+  struct Statistics
+  {
+    std::size_t Count = 0;
+    double Total = 0.0;
+    double Median = 0.0;
+    double P90 = 0.0;
+    double P99 = 0.0;
+    double Max = 0.0;
+  };
+
+  Statistics ComputeStatistics(std::vector<double> values)
+  {
+    Statistics statistics;
+    if (values.empty())
+      return statistics;
+
+    std::sort(values.begin(), values.end());
+    auto percentile = [&values](double p) {
+      return values[std::min(values.size() - 1, static_cast<std::size_t>(p * values.size()))];
+    };
+
+    statistics.Count = values.size();
+    statistics.Total = std::accumulate(values.begin(), values.end(), 0.0);
+    statistics.Median = percentile(0.5);
+    statistics.P90 = percentile(0.9);
+    statistics.P99 = percentile(0.99);
+    statistics.Max = values.back();
+    return statistics;
+  }
+
+  struct Summary
+  {
+    std::string Name;
+    Statistics Latency;
+    Statistics Processing;
+    Statistics Rendering;
+    Statistics Lag;
+  };
+
+  Summary Summarize(const std::string &name, const std::vector<const ReplayedEvent *> &events)
+  {
+    std::vector<double> latency, processing, rendering, lag;
+    for (auto event : events)
+    {
+      latency.push_back(event->ProcessingTime + event->RenderingTime);
+      processing.push_back(event->ProcessingTime);
+      rendering.push_back(event->RenderingTime);
+      lag.push_back(event->Lag);
+    }
+
+    return Summary{name, ComputeStatistics(latency), ComputeStatistics(processing), ComputeStatistics(rendering),
+                   ComputeStatistics(lag)};
+  }
+
+  void WriteText(std::ostream &stream, const std::vector<Summary> &summaries, bool realTime)
+  {
+    stream << std::left << std::setw(28) << "[ms]" << std::right << std::setw(8) << "events" << std::setw(12)
+           << "total" << std::setw(10) << "median" << std::setw(10) << "p90" << std::setw(10) << "p99"
+           << std::setw(10) << "max" << std::setw(14) << "render p50" << std::setw(14) << "render max";
+    if (realTime)
+      stream << std::setw(10) << "lag p99";
+    stream << "\n";
+
+    for (const auto &summary : summaries)
+    {
+      stream << std::left << std::setw(28) << summary.Name << std::right << std::setw(8) << summary.Latency.Count
+             << std::fixed << std::setprecision(2) << std::setw(12) << summary.Latency.Total << std::setw(10)
+             << summary.Latency.Median << std::setw(10) << summary.Latency.P90 << std::setw(10) << summary.Latency.P99
+             << std::setw(10) << summary.Latency.Max << std::setw(14) << summary.Rendering.Median << std::setw(14)
+             << summary.Rendering.Max;
+      if (realTime)
+        stream << std::setw(10) << summary.Lag.P99;
+      stream << "\n";
+    }
+  }
+
+  void WriteStatistics(std::ostream &stream, const std::string &name, const Statistics &statistics)
+  {
+    stream << "\"" << name << "\": {\"total_ms\": " << statistics.Total << ", \"median_ms\": " << statistics.Median
+           << ", \"p90_ms\": " << statistics.P90 << ", \"p99_ms\": " << statistics.P99
+           << ", \"max_ms\": " << statistics.Max << "}";
+  }
+
+  void WriteJSON(std::ostream &stream, const std::vector<Summary> &summaries, const std::vector<ReplayedEvent> &events)
+  {
+    stream << "{\n  \"summaries\": [";
+    for (std::size_t i = 0; i < summaries.size(); ++i)
+    {
+      const auto &summary = summaries[i];
+      stream << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << summary.Name
+             << "\", \"events\": " << summary.Latency.Count << ", ";
+      WriteStatistics(stream, "latency", summary.Latency);
+      stream << ", ";
+      WriteStatistics(stream, "processing", summary.Processing);
+      stream << ", ";
+      WriteStatistics(stream, "rendering", summary.Rendering);
+      stream << ", ";
+      WriteStatistics(stream, "lag", summary.Lag);
+      stream << "}";
+    }
+    stream << "\n  ],\n  \"events\": [";
+    for (std::size_t i = 0; i < events.size(); ++i)
+    {
+      const auto &event = events[i];
+      stream << (i == 0 ? "\n" : ",\n") << "    {\"class\": \"" << event.EventClass
+             << "\", \"recorded_ms\": " << event.RecordedTimestamp << ", \"lag_ms\": " << event.Lag
+             << ", \"processing_ms\": " << event.ProcessingTime << ", \"rendering_ms\": " << event.RenderingTime
+             << "}";
+    }
+    stream << "\n  ]\n}\n";
+  }
+
+  int GetToolIdByName(mitk::ToolManager *toolManager, const std::string &toolName)
+  {
+    const int numberOfTools = static_cast<int>(toolManager->GetTools().size());
+    for (int toolId = 0; toolId < numberOfTools; ++toolId)
+    {
+      if (toolName == toolManager->GetToolById(toolId)->GetNameOfClass())
+        return toolId;
+    }
+    return -1;
+  }
+
+  void PrintUsage(const char *executable)
+  {
+    std::cerr << "Usage: " << executable << " <interaction xml> <image> [options]\n"
+              << "  --tool <name>          segmentation tool class to activate, e.g. DrawPaintbrushTool or LiveWireTool2D\n"
+              << "  --segmentation <file>  working segmentation of the tool (default: empty segmentation)\n"
+              << "  --timestep <n>         time step to replay the interaction in (default 0)\n"
+              << "  --realtime             dispatch the events at their recorded timestamps\n"
+              << "  --format <name>        text or json (default text)\n"
+              << "  --out <file>           write the results to the file instead of the console\n";
+  }
+}
+
+int main(int argc, char **argv)
+{
+  if (argc < 3)
+  {
+    PrintUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  const std::string interactionFile = argv[1];
+  const std::string imageFile = argv[2];
+  std::string toolName;
+  std::string segmentationFile;
+  int timeStep = 0;
+  bool realTime = false;
+  std::string format = "text";
+  std::string outputFile;
+
+  try
+  {
+    for (int arg = 3; arg < argc; ++arg)
+    {
+      const std::string option = argv[arg];
+      if (option == "--realtime")
+      {
+        realTime = true;
+        continue;
+      }
+
+      if (arg + 1 >= argc)
+      {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+      }
+
+      const std::string value = argv[++arg];
+      if (option == "--tool") toolName = value;
+      else if (option == "--segmentation") segmentationFile = value;
+      else if (option == "--timestep") timeStep = std::stoi(value);
+      else if (option == "--format") format = value;
+      else if (option == "--out") outputFile = value;
+      else
+      {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  catch (const std::exception &e)
+  {
+    std::cerr << "Invalid option: " << e.what() << "\n";
+    PrintUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  if (format != "text" && format != "json")
+  {
+    PrintUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  std::vector<ReplayedEvent> events;
+  try
+  {
+    mitk::InteractionTestHelper interactionTestHelper(interactionFile, true);
+    mitk::DataStorage::Pointer dataStorage = interactionTestHelper.GetDataStorage();
+
+    mitk::ToolManager::Pointer toolManager = mitk::ToolManager::New(dataStorage);
+    toolManager->InitializeTools();
+    toolManager->RegisterClient();
+
+    mitk::Image::Pointer image = mitk::IOUtil::Load<mitk::Image>(imageFile);
+    mitk::DataNode::Pointer imageNode = mitk::DataNode::New();
+    imageNode->SetData(image);
+    imageNode->SetName("image");
+    interactionTestHelper.AddNodeToStorage(imageNode);
+
+    int toolId = -1;
+    if (!toolName.empty())
+    {
+      toolId = GetToolIdByName(toolManager, toolName);
+      if (toolId < 0)
+      {
+        std::cerr << "Unknown segmentation tool " << toolName << "\n";
+        return EXIT_FAILURE;
+      }
+
+      mitk::Tool *tool = toolManager->GetToolById(toolId);
+      mitk::Color color;
+      color.Set(1.0f, 0.0f, 0.0f);
+
+      mitk::DataNode::Pointer segmentationNode = segmentationFile.empty()
+        ? tool->CreateEmptySegmentationNode(image, "segmentation", color)
+        : tool->CreateSegmentationNode(mitk::IOUtil::Load<mitk::Image>(segmentationFile), "segmentation", color);
+      interactionTestHelper.AddNodeToStorage(segmentationNode);
+
+      toolManager->SetWorkingData(segmentationNode);
+      toolManager->SetReferenceData(imageNode);
+    }
+
+    interactionTestHelper.SetTimeStep(timeStep);
+
+    if (toolId >= 0)
+      toolManager->ActivateTool(toolId);
+
+    events = interactionTestHelper.ReplayInteraction(realTime);
+
+    toolManager->ActivateTool(-1);
+  }
+  catch (const std::exception &e)
+  {
+    std::cerr << "Replay failed: " << e.what() << "\n";
+    return EXIT_FAILURE;
+  }
+
+  std::map<std::string, std::vector<const ReplayedEvent *>> eventsByClass;
+  std::vector<const ReplayedEvent *> allEvents;
+  for (const auto &event : events)
+  {
+    eventsByClass[event.EventClass].push_back(&event);
+    allEvents.push_back(&event);
+  }
+
+  std::vector<Summary> summaries;
+  for (const auto &eventClass : eventsByClass)
+    summaries.push_back(Summarize(eventClass.first, eventClass.second));
+  summaries.push_back(Summarize("all", allEvents));
+
+  std::ofstream file;
+  if (!outputFile.empty())
+  {
+    file.open(outputFile);
+    if (!file)
+    {
+      std::cerr << "Cannot write " << outputFile << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+  std::ostream &stream = outputFile.empty() ? std::cout : file;
+
+  if (format == "text")
+    WriteText(stream, summaries, realTime);
+  else
+    WriteJSON(stream, summaries, events);
+
+  return events.empty() ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,539 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkCameraController.h>
+#include <mitkITKImageImport.h>
+#include <mitkImageVtkMapper2D.h>
+#include <mitkLabelSetImage.h>
+#include <mitkLabelSetImageVtkMapper2D.h>
+#include <mitkPlanarCircle.h>
+#include <mitkPlanarFigureMapper2D.h>
+#include <mitkPlanarPolygon.h>
+#include <mitkPointSet.h>
+#include <mitkPointSetVtkMapper2D.h>
+#include <mitkRenderingTestHelper.h>
+#include <mitkSurface.h>
+#include <mitkSurfaceVtkMapper3D.h>
+#include <mitkTestNotRunException.h>
+#include <mitkVolumeMapperVtkSmart3D.h>
+
+#include <itkImageRegionIteratorWithIndex.h>
+
+#include <vtkCamera.h>
+#include <vtkRenderWindow.h>
+#include <vtkSphereSource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+/*
+  Renders synthetic standard scenes off-screen along a fixed camera path and reports the time per frame,
+  one scene per mapper:
+    - ImageVtkMapper2D: large CT volume, scrolling through all axial slices
+    - LabelSetImageVtkMapper2D: multi-label segmentation on top of a CT, scrolling
+    - PlanarFigureMapper2D: many planar figures on one slice, zooming and panning
+    - PointSetVtkMapper2D: many point sets on one slice, zooming and panning
+    - SurfaceVtkMapper3D: dense triangle meshes, camera orbit
+    - VolumeMapperVtkSmart3D: volume rendering of the CT, camera orbit
+
+  The scenes are set up with mitk::RenderingTestHelper, so the benchmark runs wherever the rendering tests
+  run. The first frame (upload of the data to the GPU) is reported separately from the following frames.
+*/
+
+namespace
+{
+  typedef std::chrono::steady_clock Clock;
+
+  struct Settings
+  {
+    unsigned int Width = 1024;
+    unsigned int Height = 1024;
+    unsigned int Frames = 100;
+    double Scale = 1.0; ///< scales the size of the synthetic data
+  };
+
+  enum class CameraPath
+  {
+    Scroll,  ///< 2D, steps through all slices
+    ZoomPan, ///< 2D, zooms in and out of the center slice while panning
+    Orbit    ///< 3D, rotates the camera once around the scene
+  };
+
+  struct Scene
+  {
+    std::string Name;
+    CameraPath Path;
+    std::function<void(mitk::RenderingTestHelper &, const Settings &)> Setup;
+  };
+
+  struct Result
+  {
+    std::string Name;
+    double FirstFrame;
+    std::vector<double> Frames; // sorted, ms
+  };
+
+  unsigned int Scaled(unsigned int size, const Settings &settings)
+  {
+    return std::max(8u, static_cast<unsigned int>(size * settings.Scale));
+  }
+
+  // Deterministic noise, so that every run renders the same data
+  class Noise
+  {
+  public:
+    explicit Noise(unsigned int seed) : m_State(seed) {}
+
+    double operator()()
+    {
+      m_State = m_State * 1664525u + 1013904223u;
+      return (m_State >> 8) / static_cast<double>(1u << 24);
+    }
+
+  private:
+    unsigned int m_State;
+  };
+
+  // Ellipsoid body of soft tissue with a few bones in air
+  mitk::Image::Pointer CreateCT(unsigned int x, unsigned int y, unsigned int z)
+  {
+    typedef itk::Image<short, 3> ImageType;
+    ImageType::Pointer image = ImageType::New();
+    ImageType::SizeType size = {{x, y, z}};
+    image->SetRegions(size);
+    ImageType::SpacingType spacing;
+    spacing[0] = spacing[1] = 0.8;
+    spacing[2] = 1.5;
+    image->SetSpacing(spacing);
+    image->Allocate();
+
+    Noise noise(1);
+    itk::ImageRegionIteratorWithIndex<ImageType> iter(image, image->GetLargestPossibleRegion());
+    for (iter.GoToBegin(); !iter.IsAtEnd(); ++iter)
+    {
+      const auto index = iter.GetIndex();
+      const double dx = (index[0] - 0.5 * x) / (0.45 * x);
+      const double dy = (index[1] - 0.5 * y) / (0.35 * y);
+      const double bx = (index[0] - 0.5 * x) / (0.06 * x);
+      const double by = (index[1] - 0.65 * y) / (0.06 * y);
+
+      double value = -1000.0;
+      if (bx * bx + by * by < 1.0)
+        value = 700.0;
+      else if (dx * dx + dy * dy < 1.0)
+        value = 40.0;
+
+      iter.Set(static_cast<short>(value + 40.0 * (noise() - 0.5)));
+    }
+
+    return mitk::GrabItkImageMemory(image);
+  }
+
+  // Spherical labels on a regular grid
+  mitk::LabelSetImage::Pointer CreateLabels(const mitk::Image *reference, unsigned int labelsPerAxis)
+  {
+    typedef itk::Image<unsigned short, 3> ImageType;
+    ImageType::Pointer image = ImageType::New();
+    ImageType::SizeType size = {{reference->GetDimension(0), reference->GetDimension(1), reference->GetDimension(2)}};
+    image->SetRegions(size);
+    image->Allocate();
+
+    const double cell[3] = {static_cast<double>(size[0]) / labelsPerAxis,
+                            static_cast<double>(size[1]) / labelsPerAxis,
+                            static_cast<double>(size[2]) / labelsPerAxis};
+
+    itk::ImageRegionIteratorWithIndex<ImageType> iter(image, image->GetLargestPossibleRegion());
+    for (iter.GoToBegin(); !iter.IsAtEnd(); ++iter)
+    {
+      const auto index = iter.GetIndex();
+      double distance = 0.0;
+      unsigned int label = 0;
+      for (unsigned int d = 0; d < 3; ++d)
+      {
+        const unsigned int cellIndex = static_cast<unsigned int>(index[d] / cell[d]);
+        const double offset = (index[d] - (cellIndex + 0.5) * cell[d]) / (0.4 * cell[d]);
+        distance += offset * offset;
+        label = label * labelsPerAxis + cellIndex;
+      }
+      iter.Set(distance < 1.0 ? static_cast<unsigned short>(label + 1) : 0);
+    }
+
+    mitk::Image::Pointer labelImage = mitk::GrabItkImageMemory(image);
+    labelImage->SetGeometry(reference->GetGeometry()->Clone());
+
+    mitk::LabelSetImage::Pointer labelSetImage = mitk::LabelSetImage::New();
+    labelSetImage->InitializeByLabeledImage(labelImage);
+    return labelSetImage;
+  }
+
+  mitk::DataNode::Pointer CreateNode(mitk::BaseData *data, const std::string &name)
+  {
+    mitk::DataNode::Pointer node = mitk::DataNode::New();
+    node->SetData(data);
+    node->SetName(name);
+    return node;
+  }
+
+  mitk::PlaneGeometry::Pointer CreateCenterPlane(const mitk::Image *image)
+  {
+    mitk::PlaneGeometry::Pointer plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(image->GetGeometry(), mitk::PlaneGeometry::Axial, image->GetDimension(2) / 2);
+    return plane;
+  }
+
+  std::vector<Scene> CreateScenes()
+  {
+    std::vector<Scene> scenes;
+
+    scenes.push_back(Scene{"ImageVtkMapper2D", CameraPath::Scroll, [](mitk::RenderingTestHelper &helper, const Settings &settings) {
+      mitk::Image::Pointer ct = CreateCT(Scaled(512, settings), Scaled(512, settings), Scaled(400, settings));
+      helper.AddNodeToStorage(CreateNode(ct, "CT"));
+    }});
+
+    scenes.push_back(Scene{"LabelSetImageVtkMapper2D", CameraPath::Scroll, [](mitk::RenderingTestHelper &helper, const Settings &settings) {
+      mitk::Image::Pointer ct = CreateCT(Scaled(256, settings), Scaled(256, settings), Scaled(256, settings));
+      helper.AddNodeToStorage(CreateNode(ct, "CT"));
+
+      mitk::DataNode::Pointer segmentationNode = CreateNode(CreateLabels(ct, 4), "segmentation");
+      segmentationNode->SetMapper(mitk::BaseRenderer::Standard2D, mitk::LabelSetImageVtkMapper2D::New());
+      segmentationNode->SetIntProperty("layer", 10);
+      helper.AddNodeToStorage(segmentationNode);
+    }});
+
+    scenes.push_back(Scene{"PlanarFigureMapper2D", CameraPath::ZoomPan, [](mitk::RenderingTestHelper &helper, const Settings &settings) {
+      mitk::Image::Pointer ct = CreateCT(Scaled(256, settings), Scaled(256, settings), 16);
+      helper.AddNodeToStorage(CreateNode(ct, "CT"));
+
+      mitk::PlaneGeometry::Pointer plane = CreateCenterPlane(ct);
+      const double width = plane->GetExtentInMM(0);
+      const double height = plane->GetExtentInMM(1);
+      const unsigned int numberOfFigures = Scaled(500, settings);
+      Noise noise(2);
+
+      for (unsigned int i = 0; i < numberOfFigures; ++i)
+      {
+        mitk::Point2D center;
+        center[0] = width * noise();
+        center[1] = height * noise();
+        const double radius = 2.0 + 10.0 * noise();
+
+        mitk::PlanarFigure::Pointer figure;
+        if (i % 2 == 0)
+        {
+          mitk::PlanarCircle::Pointer circle = mitk::PlanarCircle::New();
+          circle->SetPlaneGeometry(plane->Clone());
+          circle->PlaceFigure(center);
+          mitk::Point2D rim = center;
+          rim[0] += radius;
+          circle->SetCurrentControlPoint(rim);
+          figure = circle;
+        }
+        else
+        {
+          mitk::PlanarPolygon::Pointer polygon = mitk::PlanarPolygon::New();
+          polygon->SetPlaneGeometry(plane->Clone());
+          polygon->PlaceFigure(center);
+          for (unsigned int corner = 1; corner < 8; ++corner)
+          {
+            const double angle = corner * 2.0 * 3.141592653589793 / 8;
+            mitk::Point2D point = center;
+            point[0] += radius * std::cos(angle);
+            point[1] += radius * std::sin(angle);
+            polygon->AddControlPoint(point);
+          }
+          polygon->SetClosed(true);
+          figure = polygon;
+        }
+        figure->GetPropertyList()->SetBoolProperty("initiallyplaced", true);
+
+        mitk::DataNode::Pointer node = CreateNode(figure, "figure " + std::to_string(i));
+        node->SetMapper(mitk::BaseRenderer::Standard2D, mitk::PlanarFigureMapper2D::New());
+        node->SetBoolProperty("includeInBoundingBox", false);
+        helper.AddNodeToStorage(node);
+      }
+    }});
+
+    scenes.push_back(Scene{"PointSetVtkMapper2D", CameraPath::ZoomPan, [](mitk::RenderingTestHelper &helper, const Settings &settings) {
+      mitk::Image::Pointer ct = CreateCT(Scaled(256, settings), Scaled(256, settings), 16);
+      helper.AddNodeToStorage(CreateNode(ct, "CT"));
+
+      const mitk::BaseGeometry *geometry = ct->GetGeometry();
+      const mitk::Point3D origin = geometry->GetOrigin();
+      const double width = geometry->GetExtentInMM(0);
+      const double height = geometry->GetExtentInMM(1);
+      const double z = origin[2] + 0.5 * geometry->GetExtentInMM(2);
+      const unsigned int numberOfPointSets = Scaled(100, settings);
+      Noise noise(3);
+
+      for (unsigned int i = 0; i < numberOfPointSets; ++i)
+      {
+        mitk::PointSet::Pointer pointSet = mitk::PointSet::New();
+        for (int id = 0; id < 200; ++id)
+        {
+          mitk::Point3D point;
+          point[0] = origin[0] + width * noise();
+          point[1] = origin[1] + height * noise();
+          point[2] = z;
+          pointSet->InsertPoint(id, point);
+        }
+
+        mitk::DataNode::Pointer node = CreateNode(pointSet, "point set " + std::to_string(i));
+        node->SetMapper(mitk::BaseRenderer::Standard2D, mitk::PointSetVtkMapper2D::New());
+        node->SetBoolProperty("show contour", i % 2 == 0);
+        helper.AddNodeToStorage(node);
+      }
+    }});
+
+    scenes.push_back(Scene{"SurfaceVtkMapper3D", CameraPath::Orbit, [](mitk::RenderingTestHelper &helper, const Settings &settings) {
+      // four spheres with about 1M triangles each at scale 1
+      const int resolution = static_cast<int>(Scaled(700, settings));
+      for (int i = 0; i < 4; ++i)
+      {
+        vtkSmartPointer<vtkSphereSource> sphere = vtkSmartPointer<vtkSphereSource>::New();
+        sphere->SetThetaResolution(resolution);
+        sphere->SetPhiResolution(resolution);
+        sphere->SetRadius(50.0);
+        sphere->SetCenter(120.0 * (i % 2), 120.0 * (i / 2), 0.0);
+        sphere->Update();
+
+        mitk::Surface::Pointer surface = mitk::Surface::New();
+        surface->SetVtkPolyData(sphere->GetOutput());
+
+        mitk::DataNode::Pointer node = CreateNode(surface, "surface " + std::to_string(i));
+        node->SetMapper(mitk::BaseRenderer::Standard3D, mitk::SurfaceVtkMapper3D::New());
+        helper.AddNodeToStorage(node);
+      }
+    }});
+
+    scenes.push_back(Scene{"VolumeMapperVtkSmart3D", CameraPath::Orbit, [](mitk::RenderingTestHelper &helper, const Settings &settings) {
+      mitk::Image::Pointer ct = CreateCT(Scaled(512, settings), Scaled(512, settings), Scaled(400, settings));
+      mitk::DataNode::Pointer node = CreateNode(ct, "CT");
+      node->SetBoolProperty("volumerendering", true);
+      node->SetMapper(mitk::BaseRenderer::Standard3D, mitk::VolumeMapperVtkSmart3D::New());
+      helper.AddNodeToStorage(node);
+    }});
+
+    return scenes;
+  }
+
+  double RenderFrame(mitk::RenderingTestHelper &helper)
+  {
+    const Clock::time_point start = Clock::now();
+    helper.Render();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+  }
+
+  Result RunScene(const Scene &scene, const Settings &settings)
+  {
+    mitk::RenderingTestHelper helper(settings.Width, settings.Height);
+    helper.GetVtkRenderWindow()->SetOffScreenRendering(1);
+
+    scene.Setup(helper, settings);
+
+    if (scene.Path == CameraPath::Orbit)
+      helper.SetMapperIDToRender3D();
+    else
+      helper.SetViewDirection(mitk::SliceNavigationController::Axial);
+
+    mitk::BaseRenderer *renderer = mitk::BaseRenderer::GetInstance(helper.GetVtkRenderWindow());
+    mitk::Stepper *slice = renderer->GetSliceNavigationController()->GetSlice();
+    const unsigned int numberOfSlices = slice->GetSteps();
+    if (scene.Path != CameraPath::Orbit)
+      slice->SetPos(numberOfSlices / 2);
+
+    Result result{scene.Name, RenderFrame(helper), {}};
+
+    for (unsigned int frame = 0; frame < settings.Frames; ++frame)
+    {
+      if (scene.Path == CameraPath::Orbit)
+      {
+        helper.GetVtkRenderer()->GetActiveCamera()->Azimuth(360.0 / settings.Frames);
+      }
+      else if (scene.Path == CameraPath::Scroll)
+      {
+        slice->SetPos((frame * numberOfSlices) / settings.Frames);
+      }
+      else
+      {
+        // zoom in during the first half of the path and out during the second half, panning all the time
+        mitk::Point2D center;
+        center[0] = 0.5 * renderer->GetCurrentWorldPlaneGeometry()->GetExtentInMM(0);
+        center[1] = 0.5 * renderer->GetCurrentWorldPlaneGeometry()->GetExtentInMM(1);
+        renderer->GetCameraController()->Zoom(frame < settings.Frames / 2 ? 1.02 : 1.0 / 1.02, center);
+
+        mitk::Vector2D move;
+        move[0] = frame % 20 < 10 ? 1.0 : -1.0;
+        move[1] = 0.0;
+        renderer->GetCameraController()->MoveBy(move);
+      }
+
+      result.Frames.push_back(RenderFrame(helper));
+    }
+
+    std::sort(result.Frames.begin(), result.Frames.end());
+    return result;
+  }
+
+  double Percentile(const std::vector<double> &sortedValues, double p)
+  {
+    return sortedValues[std::min(sortedValues.size() - 1, static_cast<std::size_t>(p * sortedValues.size()))];
+  }
+
+  double Mean(const std::vector<double> &values)
+  {
+    return std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+  }
+
+  void WriteText(std::ostream &stream, const std::vector<Result> &results)
+  {
+    stream << std::left << std::setw(28) << "[ms per frame]" << std::right << std::setw(12) << "first" << std::setw(10)
+           << "min" << std::setw(10) << "median" << std::setw(10) << "mean" << std::setw(10) << "p95" << std::setw(10)
+           << "max" << std::setw(10) << "fps" << "\n";
+
+    for (const auto &result : results)
+    {
+      const double mean = Mean(result.Frames);
+      stream << std::left << std::setw(28) << result.Name << std::right << std::fixed << std::setprecision(2)
+             << std::setw(12) << result.FirstFrame << std::setw(10) << result.Frames.front() << std::setw(10)
+             << Percentile(result.Frames, 0.5) << std::setw(10) << mean << std::setw(10)
+             << Percentile(result.Frames, 0.95) << std::setw(10) << result.Frames.back() << std::setw(10)
+             << (mean > 0.0 ? 1000.0 / mean : 0.0) << "\n";
+    }
+  }
+
+  void WriteJSON(std::ostream &stream, const std::vector<Result> &results, const Settings &settings)
+  {
+    stream << "{\n  \"width\": " << settings.Width << ", \"height\": " << settings.Height
+           << ", \"frames\": " << settings.Frames << ", \"scale\": " << settings.Scale << ",\n  \"scenes\": [";
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+      const auto &result = results[i];
+      stream << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << result.Name
+             << "\", \"first_frame_ms\": " << result.FirstFrame << ", \"min_ms\": " << result.Frames.front()
+             << ", \"median_ms\": " << Percentile(result.Frames, 0.5) << ", \"mean_ms\": " << Mean(result.Frames)
+             << ", \"p95_ms\": " << Percentile(result.Frames, 0.95) << ", \"max_ms\": " << result.Frames.back()
+             << "}";
+    }
+    stream << "\n  ]\n}\n";
+  }
+
+  void PrintUsage(const char *executable)
+  {
+    std::cerr << "Usage: " << executable << " [options]\n"
+              << "  --scene <text>       render only scenes whose name contains the text\n"
+              << "  --frames <n>         frames of the camera path (default 100)\n"
+              << "  --size <w> <h>       size of the render window (default 1024 1024)\n"
+              << "  --scale <f>          scale of the synthetic data (default 1.0)\n"
+              << "  --format <name>      text or json (default text)\n"
+              << "  --out <file>         write the results to the file instead of the console\n";
+  }
+}
+
+int main(int argc, char **argv)
+{
+  Settings settings;
+  std::string filter;
+  std::string format = "text";
+  std::string outputFile;
+
+  try
+  {
+    for (int arg = 1; arg < argc; ++arg)
+    {
+      const std::string option = argv[arg];
+      const int numberOfValues = option == "--size" ? 2 : 1;
+      if (arg + numberOfValues >= argc)
+      {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+      }
+
+      const std::string value = argv[++arg];
+      if (option == "--scene") filter = value;
+      else if (option == "--frames") settings.Frames = std::max(1ul, std::stoul(value));
+      else if (option == "--scale") settings.Scale = std::max(0.01, std::stod(value));
+      else if (option == "--format") format = value;
+      else if (option == "--out") outputFile = value;
+      else if (option == "--size")
+      {
+        settings.Width = std::max(1ul, std::stoul(value));
+        settings.Height = std::max(1ul, std::stoul(argv[++arg]));
+      }
+      else
+      {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  catch (const std::exception &e)
+  {
+    std::cerr << "Invalid option: " << e.what() << "\n";
+    PrintUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  if (format != "text" && format != "json")
+  {
+    PrintUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  std::vector<Result> results;
+  for (const auto &scene : CreateScenes())
+  {
+    if (scene.Name.find(filter) == std::string::npos)
+      continue;
+
+    try
+    {
+      results.push_back(RunScene(scene, settings));
+    }
+    catch (const mitk::TestNotRunException &e)
+    {
+      std::cerr << "Rendering not possible: " << e.GetDescription() << "\n";
+      return 77; // reported as skipped by ctest's SKIP_RETURN_CODE
+    }
+    catch (const std::exception &e)
+    {
+      std::cerr << scene.Name << " failed: " << e.what() << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::ofstream file;
+  if (!outputFile.empty())
+  {
+    file.open(outputFile);
+    if (!file)
+    {
+      std::cerr << "Cannot write " << outputFile << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+  std::ostream &stream = outputFile.empty() ? std::cout : file;
+
+  if (format == "text")
+    WriteText(stream, results);
+  else
+    WriteJSON(stream, results, settings);
+
+  return EXIT_SUCCESS;
+}
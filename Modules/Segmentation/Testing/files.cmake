@@ -8,6 +8,9 @@ set(MODULE_TESTS
   mitkSegmentationInterpolationTest.cpp
   mitkOverwriteSliceFilterTest.cpp
   mitkOverwriteSliceFilterObliquePlaneTest.cpp
+  mitkVtkImageOverwriteTest.cpp
+  mitkParallelFloodFillTest.cpp
+  mitkOtsuSegmentationFilterTest.cpp
 #  mitkToolManagerTest.cpp
   mitkToolManagerProviderTest.cpp
   mitkManualSegmentationToSurfaceFilterTest.cpp #new cpp unit style
@@ -0,0 +1,141 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkITKImageImport.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkOtsuSegmentationFilter.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <itkImageRegionIteratorWithIndex.h>
+#include <itkOtsuMultipleThresholdsCalculator.h>
+
+#include <cmath>
+#include <cstring>
+
+class mitkOtsuSegmentationFilterTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkOtsuSegmentationFilterTestSuite);
+  MITK_TEST(ComputeThresholds_WithoutValleyEmphasis_EqualsItkCalculator);
+  MITK_TEST(Update_ThreePlateaus_LabelsPlateaus);
+  MITK_TEST(Update_ChangedNumberOfThresholds_EqualsNewFilter);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef mitk::OtsuSegmentationFilter::HistogramType HistogramType;
+  typedef itk::Image<short, 3> InputImageType;
+
+  mitk::Image::Pointer m_Image;
+
+  static bool Equal(mitk::Image *image1, mitk::Image *image2)
+  {
+    mitk::ImageReadAccessor accessor1(image1);
+    mitk::ImageReadAccessor accessor2(image2);
+    const std::size_t size = image1->GetPixelType().GetSize() * image1->GetDimension(0) * image1->GetDimension(1) *
+                             image1->GetDimension(2);
+    return std::memcmp(accessor1.GetData(), accessor2.GetData(), size) == 0;
+  }
+
+public:
+  void setUp() override
+  {
+    // three plateaus along x
+    InputImageType::SizeType size = {{30, 20, 10}};
+    InputImageType::Pointer itkImage = InputImageType::New();
+    itkImage->SetRegions(size);
+    itkImage->Allocate();
+
+    itk::ImageRegionIteratorWithIndex<InputImageType> iter(itkImage, itkImage->GetLargestPossibleRegion());
+    for (iter.GoToBegin(); !iter.IsAtEnd(); ++iter)
+      iter.Set(static_cast<short>(iter.GetIndex()[0] / 10 * 100));
+
+    m_Image = mitk::GrabItkImageMemory(itkImage);
+  }
+
+  void tearDown() override { m_Image = nullptr; }
+
+  void ComputeThresholds_WithoutValleyEmphasis_EqualsItkCalculator()
+  {
+    // three overlapping peaks
+    HistogramType::Pointer histogram = HistogramType::New();
+    histogram->SetMeasurementVectorSize(1);
+    HistogramType::SizeType size(1);
+    size.Fill(48);
+    HistogramType::MeasurementVectorType lowerBound(1);
+    HistogramType::MeasurementVectorType upperBound(1);
+    lowerBound.Fill(0.0);
+    upperBound.Fill(96.0);
+    histogram->Initialize(size, lowerBound, upperBound);
+    for (unsigned int i = 0; i < 48; ++i)
+    {
+      const double frequency = 1000.0 * std::exp(-(i - 8.0) * (i - 8.0) / 18.0) +
+                               600.0 * std::exp(-(i - 22.0) * (i - 22.0) / 32.0) +
+                               800.0 * std::exp(-(i - 37.0) * (i - 37.0) / 12.0) + (i % 5);
+      histogram->SetFrequency(i, frequency);
+    }
+
+    typedef itk::OtsuMultipleThresholdsCalculator<HistogramType> CalculatorType;
+    for (unsigned int numberOfThresholds = 1; numberOfThresholds <= 3; ++numberOfThresholds)
+    {
+      CalculatorType::Pointer calculator = CalculatorType::New();
+      calculator->SetInputHistogram(histogram);
+      calculator->SetNumberOfThresholds(numberOfThresholds);
+      calculator->Compute();
+      const CalculatorType::OutputType &expected = calculator->GetOutput();
+
+      const std::vector<double> thresholds =
+        mitk::OtsuSegmentationFilter::ComputeThresholds(histogram, numberOfThresholds, false);
+
+      CPPUNIT_ASSERT_EQUAL(expected.size(), thresholds.size());
+      for (std::size_t i = 0; i < thresholds.size(); ++i)
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(expected[i], thresholds[i], 1e-9);
+    }
+  }
+
+  void Update_ThreePlateaus_LabelsPlateaus()
+  {
+    mitk::OtsuSegmentationFilter::Pointer filter = mitk::OtsuSegmentationFilter::New();
+    filter->SetNumberOfThresholds(2);
+    filter->SetNumberOfBins(128);
+    filter->SetInput(m_Image);
+    filter->Update();
+
+    mitk::ImageReadAccessor accessor(filter->GetOutput());
+    const auto *labels = static_cast<const mitk::OtsuSegmentationFilter::OutputPixelType *>(accessor.GetData());
+    for (unsigned int x = 0; x < 30; ++x)
+      CPPUNIT_ASSERT_EQUAL(static_cast<int>(x / 10), static_cast<int>(labels[x]));
+  }
+
+  void Update_ChangedNumberOfThresholds_EqualsNewFilter()
+  {
+    mitk::OtsuSegmentationFilter::Pointer filter = mitk::OtsuSegmentationFilter::New();
+    filter->SetNumberOfThresholds(2);
+    filter->SetNumberOfBins(64);
+    filter->SetInput(m_Image);
+    filter->Update();
+
+    // the filter reuses its histogram
+    filter->SetNumberOfThresholds(1);
+    filter->Update();
+
+    mitk::OtsuSegmentationFilter::Pointer newFilter = mitk::OtsuSegmentationFilter::New();
+    newFilter->SetNumberOfThresholds(1);
+    newFilter->SetNumberOfBins(64);
+    newFilter->SetInput(m_Image);
+    newFilter->Update();
+
+    CPPUNIT_ASSERT(filter->GetThresholds() == newFilter->GetThresholds());
+    CPPUNIT_ASSERT(Equal(filter->GetOutput(), newFilter->GetOutput()));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkOtsuSegmentationFilter)
@@ -0,0 +1,144 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkParallelFloodFill.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <itkConnectedThresholdImageFilter.h>
+#include <itkImageRegionConstIterator.h>
+#include <itkImageRegionIteratorWithIndex.h>
+
+class mitkParallelFloodFillTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkParallelFloodFillTestSuite);
+  MITK_TEST(Update_Volume_EqualsConnectedThresholdFilter);
+  MITK_TEST(Update_MaximumNumberOfVoxels_DetectsLeak);
+  MITK_TEST(Update_ProgressCallback_Cancels);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef itk::Image<short, 3> InputImageType;
+  typedef itk::Image<unsigned short, 3> OutputImageType;
+  typedef mitk::ParallelFloodFill<InputImageType, OutputImageType> FloodFillType;
+
+  InputImageType::Pointer m_Image;
+  InputImageType::IndexType m_Seed;
+
+public:
+  void setUp() override
+  {
+    // a bright ball with a dark wall through it and a bright column connecting both halves
+    InputImageType::SizeType size = {{96, 96, 96}};
+    m_Image = InputImageType::New();
+    m_Image->SetRegions(size);
+    m_Image->Allocate();
+
+    itk::ImageRegionIteratorWithIndex<InputImageType> iter(m_Image, m_Image->GetLargestPossibleRegion());
+    for (iter.GoToBegin(); !iter.IsAtEnd(); ++iter)
+    {
+      const InputImageType::IndexType &index = iter.GetIndex();
+      double distance = 0.0;
+      for (unsigned int i = 0; i < 3; ++i)
+        distance += (index[i] - 48.0) * (index[i] - 48.0);
+
+      short value = distance < 40.0 * 40.0 ? 100 : 0;
+      if (index[0] == 48 && !(index[1] == 20 && index[2] == 48))
+        value = 0;
+      iter.Set(value);
+    }
+
+    m_Seed[0] = 30;
+    m_Seed[1] = 48;
+    m_Seed[2] = 48;
+  }
+
+  void tearDown() override { m_Image = nullptr; }
+
+  void Update_Volume_EqualsConnectedThresholdFilter()
+  {
+    typedef itk::ConnectedThresholdImageFilter<InputImageType, OutputImageType> ConnectedThresholdType;
+    ConnectedThresholdType::Pointer reference = ConnectedThresholdType::New();
+    reference->SetInput(m_Image);
+    reference->AddSeed(m_Seed);
+    reference->SetLower(50);
+    reference->SetUpper(150);
+    reference->Update();
+
+    FloodFillType fill;
+    fill.SetInput(m_Image);
+    fill.AddSeed(m_Seed);
+    fill.SetLower(50);
+    fill.SetUpper(150);
+    fill.SetNumberOfThreads(4);
+    const FloodFillType::Result result = fill.Update();
+
+    CPPUNIT_ASSERT(!result.Leaked);
+    CPPUNIT_ASSERT(!result.Canceled);
+
+    std::size_t numberOfVoxels = 0;
+    itk::ImageRegionConstIterator<OutputImageType> referenceIter(reference->GetOutput(),
+                                                                 reference->GetOutput()->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<OutputImageType> fillIter(fill.GetOutput(),
+                                                            fill.GetOutput()->GetLargestPossibleRegion());
+    for (; !referenceIter.IsAtEnd(); ++referenceIter, ++fillIter)
+    {
+      CPPUNIT_ASSERT_EQUAL(referenceIter.Get(), fillIter.Get());
+      if (fillIter.Get() != 0)
+        ++numberOfVoxels;
+    }
+    CPPUNIT_ASSERT_EQUAL(numberOfVoxels, result.NumberOfVoxels);
+
+    // both halves are connected by the column through the wall
+    InputImageType::IndexType otherHalf = {{70, 48, 48}};
+    CPPUNIT_ASSERT_EQUAL(OutputImageType::PixelType(1), fill.GetOutput()->GetPixel(otherHalf));
+  }
+
+  void Update_MaximumNumberOfVoxels_DetectsLeak()
+  {
+    FloodFillType fill;
+    fill.SetInput(m_Image);
+    fill.AddSeed(m_Seed);
+    fill.SetLower(-10);
+    fill.SetUpper(150);
+    fill.SetMaximumNumberOfVoxels(300000);
+    const FloodFillType::Result result = fill.Update();
+
+    CPPUNIT_ASSERT(result.Leaked);
+    CPPUNIT_ASSERT(result.NumberOfVoxels > 300000);
+    CPPUNIT_ASSERT(result.NumberOfVoxels < 96 * 96 * 96);
+  }
+
+  void Update_ProgressCallback_Cancels()
+  {
+    FloodFillType fill;
+    fill.SetInput(m_Image);
+    fill.AddSeed(m_Seed);
+    fill.SetLower(50);
+    fill.SetUpper(150);
+
+    std::size_t numberOfCalls = 0;
+    fill.SetProgressCallback(
+      [&numberOfCalls](const OutputImageType *output, std::size_t) {
+        ++numberOfCalls;
+        return output != nullptr && numberOfCalls < 2;
+      },
+      1000);
+    const FloodFillType::Result result = fill.Update();
+
+    CPPUNIT_ASSERT(result.Canceled);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), numberOfCalls);
+    CPPUNIT_ASSERT(result.NumberOfVoxels > 0);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkParallelFloodFill)
@@ -0,0 +1,228 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkExtractSliceFilter.h>
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkInteractionConst.h>
+#include <mitkRotationOperation.h>
+#include <mitkVtkImageOverwrite.h>
+
+#include <vtkImageData.h>
+#include <vtkImageStencilData.h>
+#include <vtkSmartPointer.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+  const unsigned int Dimensions[3] = {24, 20, 16};
+
+  std::vector<char> GetScalars(vtkImageData *image)
+  {
+    const auto *begin = static_cast<const char *>(image->GetScalarPointer());
+    const size_t size = image->GetNumberOfPoints() * image->GetNumberOfScalarComponents() * image->GetScalarSize();
+    return std::vector<char>(begin, begin + size);
+  }
+
+  /** The buffers of one extract -> edit -> overwrite round trip */
+  struct RoundTripResult
+  {
+    std::vector<char> ExtractedSlice;
+    std::vector<char> OverwrittenSlice;
+    std::vector<char> Volume;
+  };
+}
+
+/** Compares the row-wise processing of mitkVtkImageOverwrite with the voxel-wise lookup */
+class mitkVtkImageOverwriteTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkVtkImageOverwriteTestSuite);
+  MITK_TEST(AxisAlignedPlane_LinearRows_MatchVoxelwiseLookup);
+  MITK_TEST(FlippedPlane_LinearRows_MatchVoxelwiseLookup);
+  MITK_TEST(ObliquePlane_LinearRows_MatchVoxelwiseLookup);
+  MITK_TEST(PlanePartlyOutside_LinearRows_MatchVoxelwiseLookup);
+  MITK_TEST(Stencil_LinearRows_MatchVoxelwiseLookup);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+
+  mitk::PlaneGeometry::Pointer CreateAxialPlane()
+  {
+    mitk::PlaneGeometry::Pointer plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(m_Image->GetGeometry(), mitk::PlaneGeometry::Axial, 7, true, false);
+
+    // move the plane to the voxel centers, the spacing is 1
+    mitk::Vector3D normal = plane->GetNormal();
+    normal.Normalize();
+    plane->SetOrigin(plane->GetOrigin() + normal * 0.5);
+    return plane;
+  }
+
+  static void Rotate(mitk::PlaneGeometry *plane, mitk::Vector3D axis, double degrees)
+  {
+    axis.Normalize();
+    mitk::RotationOperation op(mitk::OpROTATE, plane->GetCenter(), axis, degrees);
+    plane->ExecuteOperation(&op);
+  }
+
+  RoundTripResult ExtractAndOverwrite(const mitk::PlaneGeometry *plane, bool linearRows, vtkImageStencilData *stencil)
+  {
+    mitk::Image::Pointer volume = m_Image->Clone();
+    RoundTripResult result;
+
+    vtkSmartPointer<mitkVtkImageOverwrite> extractor = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+    extractor->SetLinearRowsEnabled(linearRows);
+    if (stencil != nullptr)
+      extractor->SetStencilData(stencil);
+
+    mitk::ExtractSliceFilter::Pointer slicer = mitk::ExtractSliceFilter::New(extractor);
+    slicer->SetInput(volume);
+    slicer->SetWorldGeometry(plane);
+    slicer->SetVtkOutputRequest(true);
+    slicer->Update();
+
+    vtkSmartPointer<vtkImageData> slice = vtkSmartPointer<vtkImageData>::New();
+    slice->DeepCopy(slicer->GetVtkOutput());
+    result.ExtractedSlice = GetScalars(slice);
+
+    // edit every voxel of the slice
+    auto *pixels = static_cast<unsigned short *>(slice->GetScalarPointer());
+    for (vtkIdType i = 0; i < slice->GetNumberOfPoints(); ++i)
+      pixels[i] = static_cast<unsigned short>(50000 + i);
+
+    vtkSmartPointer<mitkVtkImageOverwrite> overwriter = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+    overwriter->SetLinearRowsEnabled(linearRows);
+    if (stencil != nullptr)
+      overwriter->SetStencilData(stencil);
+    overwriter->SetOverwriteMode(true);
+    overwriter->SetInputSlice(slice);
+
+    mitk::ExtractSliceFilter::Pointer overwriteSlicer = mitk::ExtractSliceFilter::New(overwriter);
+    overwriteSlicer->SetInput(volume);
+    overwriteSlicer->SetWorldGeometry(plane);
+    overwriteSlicer->SetVtkOutputRequest(true);
+    overwriteSlicer->Update();
+
+    result.OverwrittenSlice = GetScalars(slice);
+
+    mitk::ImageReadAccessor readAccess(volume);
+    const auto *data = static_cast<const char *>(readAccess.GetData());
+    result.Volume.assign(data, data + Dimensions[0] * Dimensions[1] * Dimensions[2] * sizeof(unsigned short));
+    return result;
+  }
+
+  void AssertSameRoundTrip(const mitk::PlaneGeometry *plane, vtkImageStencilData *stencil = nullptr)
+  {
+    const RoundTripResult rows = this->ExtractAndOverwrite(plane, true, stencil);
+    const RoundTripResult voxels = this->ExtractAndOverwrite(plane, false, stencil);
+
+    CPPUNIT_ASSERT(!rows.ExtractedSlice.empty());
+    CPPUNIT_ASSERT(rows.ExtractedSlice == voxels.ExtractedSlice);
+    CPPUNIT_ASSERT(rows.OverwrittenSlice == voxels.OverwrittenSlice);
+    CPPUNIT_ASSERT(rows.Volume == voxels.Volume);
+
+    // the volume was written to at all
+    mitk::ImageReadAccessor readAccess(m_Image);
+    const auto *original = static_cast<const char *>(readAccess.GetData());
+    CPPUNIT_ASSERT(!std::equal(rows.Volume.begin(), rows.Volume.end(), original));
+  }
+
+public:
+  void setUp() override
+  {
+    m_Image = mitk::Image::New();
+    m_Image->Initialize(mitk::MakeScalarPixelType<unsigned short>(), 3, Dimensions);
+
+    // distinct values, so that every misplaced voxel shows up
+    mitk::ImagePixelWriteAccessor<unsigned short, 3> writeAccess(m_Image);
+    for (unsigned int i = 0; i < Dimensions[0] * Dimensions[1] * Dimensions[2]; ++i)
+      writeAccess.GetData()[i] = static_cast<unsigned short>(i + 1);
+  }
+
+  void tearDown() override { m_Image = nullptr; }
+
+  void AxisAlignedPlane_LinearRows_MatchVoxelwiseLookup() { this->AssertSameRoundTrip(this->CreateAxialPlane()); }
+
+  void FlippedPlane_LinearRows_MatchVoxelwiseLookup()
+  {
+    // both in-plane axes point against the volume axes, so the rows are walked backwards
+    mitk::PlaneGeometry::Pointer plane = this->CreateAxialPlane();
+    Rotate(plane, plane->GetNormal(), 180.0);
+    this->AssertSameRoundTrip(plane);
+  }
+
+  void ObliquePlane_LinearRows_MatchVoxelwiseLookup()
+  {
+    mitk::PlaneGeometry::Pointer plane = this->CreateAxialPlane();
+    Rotate(plane, plane->GetAxisVector(0), 37.0);
+    this->AssertSameRoundTrip(plane);
+
+    Rotate(plane, plane->GetNormal(), 23.0);
+    this->AssertSameRoundTrip(plane);
+  }
+
+  void PlanePartlyOutside_LinearRows_MatchVoxelwiseLookup()
+  {
+    mitk::PlaneGeometry::Pointer plane = this->CreateAxialPlane();
+    mitk::Vector3D right = plane->GetAxisVector(0);
+    mitk::Vector3D bottom = plane->GetAxisVector(1);
+    right.Normalize();
+    bottom.Normalize();
+    plane->SetOrigin(plane->GetOrigin() + right * 5.3 - bottom * 3.7);
+    this->AssertSameRoundTrip(plane);
+
+    Rotate(plane, plane->GetNormal(), 180.0);
+    this->AssertSameRoundTrip(plane);
+  }
+
+  void Stencil_LinearRows_MatchVoxelwiseLookup()
+  {
+    mitk::PlaneGeometry::Pointer plane = this->CreateAxialPlane();
+
+    // the stencil covers the extent of the extracted slice with two runs per row
+    vtkSmartPointer<mitkVtkImageOverwrite> extractor = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+    mitk::ExtractSliceFilter::Pointer slicer = mitk::ExtractSliceFilter::New(extractor);
+    slicer->SetInput(m_Image);
+    slicer->SetWorldGeometry(plane);
+    slicer->SetVtkOutputRequest(true);
+    slicer->Update();
+    vtkImageData *slice = slicer->GetVtkOutput();
+
+    int extent[6];
+    slice->GetExtent(extent);
+    CPPUNIT_ASSERT(extent[1] - extent[0] >= 15);
+
+    vtkSmartPointer<vtkImageStencilData> stencil = vtkSmartPointer<vtkImageStencilData>::New();
+    stencil->SetExtent(extent);
+    stencil->SetOrigin(slice->GetOrigin());
+    stencil->SetSpacing(slice->GetSpacing());
+    stencil->AllocateExtents();
+    for (int z = extent[4]; z <= extent[5]; ++z)
+    {
+      for (int y = extent[2]; y <= extent[3]; ++y)
+      {
+        stencil->InsertNextExtent(extent[0] + y % 3, extent[0] + 5, y, z);
+        stencil->InsertNextExtent(extent[0] + 9, extent[0] + 9 + y % 7, y, z);
+      }
+    }
+
+    this->AssertSameRoundTrip(plane, stencil);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkVtkImageOverwrite)
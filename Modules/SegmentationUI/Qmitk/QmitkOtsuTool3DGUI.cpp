@@ -46,6 +46,10 @@ void QmitkOtsuTool3DGUI::OnRegionSpinboxChanged(int numberOfRegions)
   int curBinValue = m_Controls.m_BinsSpinBox->value();
   if (curBinValue < numberOfRegions)
     m_Controls.m_BinsSpinBox->setValue(numberOfRegions);
+
+  // the histogram is reused, so the preview follows the number of regions directly
+  if (m_NumberOfRegions > 0)
+    this->OnSpinboxValueAccept();
 }
 
 void QmitkOtsuTool3DGUI::OnRegionSelectionChanged()
@@ -129,19 +133,6 @@ void QmitkOtsuTool3DGUI::OnSpinboxValueAccept()
   {
     try
     {
-      int proceed;
-      QMessageBox *messageBox = new QMessageBox(QMessageBox::Question,
-                                                nullptr,
-                                                "The otsu segmentation computation may take several minutes depending "
-                                                "on the number of Regions you selected. Proceed anyway?",
-                                                QMessageBox::Ok | QMessageBox::Cancel);
-      if (m_Controls.m_Spinbox->value() >= 5)
-      {
-        proceed = messageBox->exec();
-        if (proceed != QMessageBox::Ok)
-          return;
-      }
-
       m_NumberOfRegions = m_Controls.m_Spinbox->value();
       m_UseValleyEmphasis = m_Controls.m_ValleyCheckbox->isChecked();
       m_NumberOfBins = m_Controls.m_BinsSpinBox->value();
@@ -46,6 +46,7 @@ found in the LICENSE file.
 #include <QMenu>
 #include <QMessageBox>
 #include <QPushButton>
+#include <QThread>
 #include <QVBoxLayout>
 
 #include <vtkPolyVertex.h>
@@ -55,6 +56,9 @@ found in the LICENSE file.
 
 float SURFACE_COLOR_RGB[3] = {0.49f, 1.0f, 0.16f};
 
+// number of slices on each side of the current one that are interpolated in background
+const int PREVIEW_NEIGHBORHOOD = 2;
+
 const std::map<QAction *, mitk::SliceNavigationController *> QmitkSlicesInterpolator::createActionToSliceDimension()
 {
   std::map<QAction *, mitk::SliceNavigationController *> actionToSliceDimension;
@@ -77,8 +81,15 @@ QmitkSlicesInterpolator::QmitkSlicesInterpolator(QWidget *parent, const char * /
     m_LastSliceIndex(0),
     m_2DInterpolationEnabled(false),
     m_3DInterpolationEnabled(false),
-    m_FirstRun(true)
+    m_FirstRun(true),
+    m_CurrentPreview(qMakePair(-1, -1), 0),
+    m_PreviewGeneration(0),
+    m_PreviewPosition(0),
+    m_PreviewTimeStep(0)
 {
+  // leave one core to the rendering
+  m_PreviewThreadPool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+
   m_GroupBoxEnableExclusiveInterpolationMode = new QGroupBox("Interpolation", this);
 
   QVBoxLayout *vboxLayout = new QVBoxLayout(m_GroupBoxEnableExclusiveInterpolationMode);
@@ -459,6 +470,8 @@ void QmitkSlicesInterpolator::OnShowMarkers(bool state)
 
 void QmitkSlicesInterpolator::OnToolManagerWorkingDataModified()
 {
+  this->InvalidatePreviews();
+
   if (m_ToolManager->GetWorkingData(0) != nullptr)
   {
     m_Segmentation = dynamic_cast<mitk::Image *>(m_ToolManager->GetWorkingData(0)->GetData());
@@ -542,6 +555,8 @@ bool QmitkSlicesInterpolator::TranslateAndInterpolateChangedSlice(const itk::Eve
       if (slicedGeometry)
       {
         m_LastSNC = slicer;
+        m_PreviewGeometry = slicedGeometry;
+        m_PreviewPosition = event.GetPos();
         mitk::PlaneGeometry *plane =
           dynamic_cast<mitk::PlaneGeometry *>(slicedGeometry->GetPlaneGeometry(event.GetPos()));
         if (plane)
@@ -576,17 +591,157 @@ void QmitkSlicesInterpolator::Interpolate(mitk::PlaneGeometry *plane,
         // calculate real slice position, i.e. slice of the image and not slice of the TimeSlicedGeometry
         mitk::SegTool2D::DetermineAffectedImageSlice(m_Segmentation, plane, clickedSliceDimension, clickedSliceIndex);
 
-        mitk::Image::Pointer interpolation =
-          m_Interpolator->Interpolate(clickedSliceDimension, clickedSliceIndex, plane, timeStep);
-        m_FeedbackNode->SetData(interpolation);
-
         m_LastSNC = slicer;
         m_LastSliceIndex = clickedSliceIndex;
+
+        // the current slice is interpolated in background, too
+        m_PreviewTimeStep = timeStep;
+        this->RequestPreviews();
       }
     }
   }
 }
 
+void QmitkSlicesInterpolator::RequestPreviews()
+{
+  if (m_PreviewGeometry.IsNull() || !m_Segmentation)
+    return;
+
+  // the current slice first, then its neighbors by distance
+  QList<QPair<PreviewKey, mitk::PlaneGeometry::Pointer>> window;
+  for (int distance = 0; distance <= PREVIEW_NEIGHBORHOOD; ++distance)
+  {
+    for (int direction = 1; direction >= -1; direction -= 2)
+    {
+      if (distance == 0 && direction < 0)
+        continue;
+
+      const int position = static_cast<int>(m_PreviewPosition) + direction * distance;
+      if (position < 0 || position >= static_cast<int>(m_PreviewGeometry->GetSlices()))
+        continue;
+
+      mitk::PlaneGeometry *plane = m_PreviewGeometry->GetPlaneGeometry(position);
+      if (!plane)
+        continue;
+
+      int sliceDimension(-1);
+      int sliceIndex(-1);
+      mitk::SegTool2D::DetermineAffectedImageSlice(m_Segmentation, plane, sliceDimension, sliceIndex);
+
+      // the planes are cloned, the sliced geometry may change while the previews are interpolated
+      window.append(qMakePair(PreviewKey(qMakePair(sliceDimension, sliceIndex), m_PreviewTimeStep),
+                              mitk::PlaneGeometry::Pointer(plane->Clone())));
+    }
+  }
+
+  mitk::Image::Pointer interpolation;
+  {
+    QMutexLocker locker(&m_PreviewMutex);
+
+    // queued previews of the slices before are not needed anymore, previews that already run are kept
+    m_PreviewThreadPool.clear();
+    m_QueuedPreviews.clear();
+
+    QSet<PreviewKey> windowKeys;
+    for (const auto &slice : window)
+      windowKeys.insert(slice.first);
+
+    for (auto iter = m_Previews.begin(); iter != m_Previews.end();)
+    {
+      if (windowKeys.contains(iter.key()))
+        ++iter;
+      else
+        iter = m_Previews.erase(iter);
+    }
+
+    m_CurrentPreview = window.empty() ? PreviewKey(qMakePair(-1, -1), 0) : window.front().first;
+    interpolation = m_Previews.value(m_CurrentPreview);
+
+    for (const auto &slice : window)
+    {
+      const PreviewKey &key = slice.first;
+      if (key.first.first < 0 || key.first.second < 0 || m_Previews.contains(key) ||
+          m_QueuedPreviews.contains(key) || m_RunningPreviews.contains(key))
+        continue;
+
+      m_QueuedPreviews.insert(key);
+      QtConcurrent::run(&m_PreviewThreadPool,
+                        [this, key, slice, generation = m_PreviewGeneration]() {
+                          this->InterpolatePreview(key, slice.second, generation);
+                        });
+    }
+  }
+
+  // shows nothing until the current slice is interpolated
+  m_FeedbackNode->SetData(interpolation);
+}
+
+void QmitkSlicesInterpolator::InterpolatePreview(const PreviewKey &key,
+                                                 mitk::PlaneGeometry::Pointer plane,
+                                                 unsigned int generation)
+{
+  {
+    QMutexLocker locker(&m_PreviewMutex);
+    if (generation != m_PreviewGeneration || !m_QueuedPreviews.remove(key))
+      return; // the slice is not near the current one anymore
+    m_RunningPreviews.insert(key);
+  }
+
+  // an interpolation that already runs cannot be interrupted, its result is discarded if it is outdated
+  mitk::Image::Pointer interpolation;
+  try
+  {
+    interpolation = m_Interpolator->Interpolate(key.first.first, key.first.second, plane, key.second);
+  }
+  catch (const std::exception &e)
+  {
+    MITK_ERROR << "Error in background 2D interpolation: " << e.what();
+  }
+
+  {
+    QMutexLocker locker(&m_PreviewMutex);
+    if (generation != m_PreviewGeneration)
+      return;
+
+    m_RunningPreviews.remove(key);
+    m_Previews.insert(key, interpolation);
+
+    if (key != m_CurrentPreview)
+      return;
+  }
+
+  QMetaObject::invokeMethod(this, "OnPreviewInterpolated", Qt::QueuedConnection);
+}
+
+void QmitkSlicesInterpolator::InvalidatePreviews()
+{
+  QMutexLocker locker(&m_PreviewMutex);
+
+  ++m_PreviewGeneration;
+  m_PreviewThreadPool.clear();
+  m_QueuedPreviews.clear();
+  m_RunningPreviews.clear();
+  m_Previews.clear();
+}
+
+void QmitkSlicesInterpolator::OnPreviewInterpolated()
+{
+  mitk::Image::Pointer interpolation;
+  {
+    QMutexLocker locker(&m_PreviewMutex);
+    auto iter = m_Previews.find(m_CurrentPreview);
+    if (iter == m_Previews.end())
+      return;
+    interpolation = iter.value();
+  }
+
+  if (!m_2DInterpolationEnabled || m_FeedbackNode->GetData() == interpolation.GetPointer())
+    return;
+
+  m_FeedbackNode->SetData(interpolation);
+  UpdateVisibleSuggestion();
+}
+
 void QmitkSlicesInterpolator::OnSurfaceInterpolationFinished()
 {
   mitk::Surface::Pointer interpolatedSurface = m_SurfaceInterpolator->GetInterpolationResult();
@@ -633,6 +788,26 @@ void QmitkSlicesInterpolator::OnSurfaceInterpolationFinished()
 
 void QmitkSlicesInterpolator::OnAcceptInterpolationClicked()
 {
+  if (m_Segmentation && !m_FeedbackNode->GetData() && m_LastSNC)
+  {
+    // the current slice may still be interpolated in background
+    PreviewKey currentPreview;
+    bool pending(false);
+    {
+      QMutexLocker locker(&m_PreviewMutex);
+      currentPreview = m_CurrentPreview;
+      pending = m_QueuedPreviews.contains(currentPreview) || m_RunningPreviews.contains(currentPreview);
+    }
+
+    if (pending)
+    {
+      m_FeedbackNode->SetData(m_Interpolator->Interpolate(currentPreview.first.first,
+                                                          currentPreview.first.second,
+                                                          m_LastSNC->GetCurrentPlaneGeometry(),
+                                                          currentPreview.second));
+    }
+  }
+
   if (m_Segmentation && m_FeedbackNode->GetData())
   {
     // Make sure that for reslicing and overwriting the same alogrithm is used. We can specify the mode of the vtk
@@ -1040,6 +1215,7 @@ void QmitkSlicesInterpolator::OnInterpolationActivated(bool on)
 
     if (!on)
     {
+      this->InvalidatePreviews();
       mitk::RenderingManager::GetInstance()->RequestUpdateAll();
       return;
     }
@@ -1204,6 +1380,9 @@ void QmitkSlicesInterpolator::UpdateVisibleSuggestion()
 void QmitkSlicesInterpolator::OnInterpolationInfoChanged(const itk::EventObject & /*e*/)
 {
   // something (e.g. undo) changed the interpolation info, we should refresh our display
+  this->InvalidatePreviews();
+  if (m_2DInterpolationEnabled)
+    this->RequestPreviews();
   UpdateVisibleSuggestion();
 }
 
@@ -1338,6 +1517,9 @@ void QmitkSlicesInterpolator::WaitForFutures()
   {
     m_PlaneWatcher.waitForFinished();
   }
+
+  this->InvalidatePreviews();
+  m_PreviewThreadPool.waitForDone();
 }
 
 void QmitkSlicesInterpolator::NodeRemoved(const mitk::DataNode* node)
@@ -17,6 +17,7 @@ found in the LICENSE file.
 #include "mitkDataStorage.h"
 #include "mitkSegmentationInterpolationController.h"
 #include "mitkSliceNavigationController.h"
+#include "mitkSlicedGeometry3D.h"
 #include "mitkSurfaceInterpolationController.h"
 #include "mitkToolManager.h"
 #include <MitkSegmentationUIExports.h>
@@ -42,6 +43,13 @@ found in the LICENSE file.
 #include <QTimer>
 #include <QtConcurrentRun>
 
+// For interpolating the slices around the current one in background
+#include <QHash>
+#include <QMutex>
+#include <QPair>
+#include <QSet>
+#include <QThreadPool>
+
 namespace mitk
 {
   class PlaneGeometry;
@@ -65,6 +73,10 @@ class QPushButton;
   visible. It triggers generation of interpolation suggestions and also triggers acception of
   suggestions.
 
+  The interpolation of the current slice and of its neighbors is done in background threads, so
+  scrolling through the slices does not wait for the interpolation. Previews of slices close to the
+  current one are kept until the segmentation changes.
+
   \todo show/hide feedback on demand
 
   Last contributor: $Author: maleike $
@@ -193,6 +205,11 @@ protected slots:
 
   void ChangeSurfaceColor();
 
+  /**
+    Shows the preview of the current slice as soon as it was interpolated in background
+  */
+  void OnPreviewInterpolated();
+
 protected:
   const std::map<QAction *, mitk::SliceNavigationController *> createActionToSliceDimension();
   std::map<QAction *, mitk::SliceNavigationController *> ACTION_TO_SLICEDIMENSION;
@@ -232,6 +249,26 @@ private:
   void Show3DInterpolationControls(bool show);
   void CheckSupportedImageDimension();
   void WaitForFutures();
+
+  // (slice dimension, slice index) and time step of an interpolation preview
+  typedef QPair<QPair<int, int>, unsigned int> PreviewKey;
+
+  /**
+    Shows the preview of the current slice if it is already interpolated and queues the missing previews
+    of the current and the neighboring slices in m_PreviewThreadPool. Queued previews of slices that are
+    no longer near the current one are dropped.
+  */
+  void RequestPreviews();
+
+  /**
+    Interpolates a queued preview, runs in m_PreviewThreadPool
+  */
+  void InterpolatePreview(const PreviewKey &key, mitk::PlaneGeometry::Pointer plane, unsigned int generation);
+
+  /**
+    Drops all queued and interpolated previews, e.g. because the segmentation changed
+  */
+  void InvalidatePreviews();
   void NodeRemoved(const mitk::DataNode* node);
 
   mitk::SegmentationInterpolationController::Pointer m_Interpolator;
@@ -286,6 +323,19 @@ private:
   QFutureWatcher<void> m_PlaneWatcher;
 
   bool m_FirstRun;
+
+  QThreadPool m_PreviewThreadPool;
+  // guards m_Previews to m_PreviewGeneration, which are shared with m_PreviewThreadPool
+  QMutex m_PreviewMutex;
+  QHash<PreviewKey, mitk::Image::Pointer> m_Previews; // nullptr if there is nothing to interpolate
+  QSet<PreviewKey> m_QueuedPreviews;
+  QSet<PreviewKey> m_RunningPreviews;
+  PreviewKey m_CurrentPreview;
+  unsigned int m_PreviewGeneration;
+
+  mitk::SlicedGeometry3D::Pointer m_PreviewGeometry;
+  unsigned int m_PreviewPosition;
+  unsigned int m_PreviewTimeStep;
 };
 
 #endif
@@ -13,7 +13,6 @@ found in the LICENSE file.
 #include "QmitkWatershedToolGUI.h"
 
 #include "QmitkNewSegmentationDialog.h"
-#include "mitkProgressBar.h"
 
 #include <qapplication.h>
 #include <qlabel.h>
@@ -134,17 +133,6 @@ void QmitkWatershedToolGUI::OnSliderValueLevelChanged(int value)
 
 void QmitkWatershedToolGUI::OnCreateSegmentation()
 {
-  QApplication::setOverrideCursor(Qt::BusyCursor);
-  m_InformationLabel->setText(QString("Please wait some time for computation..."));
-  m_InformationLabel->repaint();
-  QApplication::processEvents();
-
+  // the tool computes in the background and reports progress itself
   m_WatershedTool->DoIt();
-  m_InformationLabel->setText(QString(""));
-  QApplication::setOverrideCursor(Qt::ArrowCursor);
-
-  for (int i = 0; i < 60; ++i)
-  {
-    mitk::ProgressBar::GetInstance()->Progress();
-  }
 }
@@ -25,6 +25,8 @@ found in the LICENSE file.
 // c++
 #include <algorithm>
 #include <iostream>
+#include <map>
+#include <unordered_map>
 
 namespace
 {
@@ -168,496 +170,356 @@ namespace
 
     return generatedControlPoint;
   }
-}
 
-mitk::SemanticTypes::LesionVector mitk::RelationStorage::GetAllLesionsOfCase(const SemanticTypes::CaseID& caseID)
-{
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  /**
+  * @brief The relations of a case, read once from its property list.
+  *
+  * The queries of the semantic relations views are answered from this index instead of parsing the
+  * vector properties of the case for each query. All changes are still written to the property list
+  * by the functions below; the index is rebuilt at the next query after the property list was modified.
+  */
+  struct CaseIndex
+  {
+    const mitk::PropertyList* PropertyList = nullptr;
+    itk::ModifiedTimeType PropertyListMTime = 0;
+
+    mitk::SemanticTypes::LesionVector Lesions;
+    std::unordered_map<mitk::SemanticTypes::ID, mitk::SemanticTypes::Lesion> LesionsByID;
+    mitk::SemanticTypes::ControlPointVector ControlPoints;
+    std::unordered_map<mitk::SemanticTypes::ID, mitk::SemanticTypes::ControlPoint> ControlPointsByID;
+    mitk::SemanticTypes::ExaminationPeriodVector ExaminationPeriods;
+    mitk::SemanticTypes::InformationTypeVector InformationTypes;
+
+    mitk::SemanticTypes::IDVector ImageIDs;
+    // 0. information type 1. control point ID
+    std::unordered_map<mitk::SemanticTypes::ID, std::pair<mitk::SemanticTypes::InformationType, mitk::SemanticTypes::ID>> Images;
+    std::unordered_map<mitk::SemanticTypes::ID, mitk::SemanticTypes::IDVector> ImageIDsByControlPoint;
+    std::unordered_map<mitk::SemanticTypes::InformationType, mitk::SemanticTypes::IDVector> ImageIDsByInformationType;
+
+    mitk::SemanticTypes::IDVector SegmentationIDs;
+    // 0. image ID 1. lesion ID
+    std::unordered_map<mitk::SemanticTypes::ID, std::pair<mitk::SemanticTypes::ID, mitk::SemanticTypes::ID>> Segmentations;
+    std::unordered_map<mitk::SemanticTypes::ID, mitk::SemanticTypes::IDVector> SegmentationIDsByImage;
+    std::unordered_map<mitk::SemanticTypes::ID, mitk::SemanticTypes::IDVector> SegmentationIDsByLesion;
+  };
+
+  std::vector<std::string> GetStringVector(const mitk::PropertyList* propertyList, const std::string& propertyKey)
   {
-    MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
-    return SemanticTypes::LesionVector();
+    auto* vectorProperty = dynamic_cast<const mitk::VectorProperty<std::string>*>(propertyList->GetConstProperty(propertyKey).GetPointer());
+    if (nullptr == vectorProperty)
+    {
+      return std::vector<std::string>();
+    }
+
+    return vectorProperty->GetValue();
   }
-  // retrieve a vector property that contains the valid lesion-IDs for the current case
-  VectorProperty<std::string>* lesionsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("lesions"));
-  if (nullptr == lesionsVectorProperty)
+
+  void BuildCaseIndex(const mitk::SemanticTypes::CaseID& caseID, const mitk::PropertyList* propertyList, CaseIndex& index)
   {
-    MITK_DEBUG << "Could not find any lesion in the storage.";
-    return SemanticTypes::LesionVector();
+    index = CaseIndex();
+
+    for (const auto& lesionID : GetStringVector(propertyList, "lesions"))
+    {
+      mitk::SemanticTypes::Lesion generatedLesion = GenerateLesion(caseID, lesionID);
+      if (!generatedLesion.UID.empty())
+      {
+        index.Lesions.push_back(generatedLesion);
+        index.LesionsByID[lesionID] = generatedLesion;
+      }
+    }
+
+    for (const auto& controlPointUID : GetStringVector(propertyList, "controlpoints"))
+    {
+      mitk::SemanticTypes::ControlPoint generatedControlPoint = GenerateControlpoint(caseID, controlPointUID);
+      if (!generatedControlPoint.UID.empty())
+      {
+        index.ControlPoints.push_back(generatedControlPoint);
+        index.ControlPointsByID[controlPointUID] = generatedControlPoint;
+      }
+    }
+
+    for (const auto& examinationPeriodID : GetStringVector(propertyList, "examinationperiods"))
+    {
+      // an examination period has an arbitrary number of vector values (name and control point UIDs) (at least one for the name)
+      std::vector<std::string> examinationPeriodValue = GetStringVector(propertyList, examinationPeriodID);
+      if (examinationPeriodValue.empty())
+      {
+        MITK_DEBUG << "Incorrect examination period storage. At least one (1) value for the examination period name has to be stored.";
+        continue;
+      }
+
+      mitk::SemanticTypes::ExaminationPeriod generatedExaminationPeriod;
+      generatedExaminationPeriod.UID = examinationPeriodID;
+      generatedExaminationPeriod.name = examinationPeriodValue[0];
+      generatedExaminationPeriod.controlPointUIDs.assign(examinationPeriodValue.begin() + 1, examinationPeriodValue.end());
+      index.ExaminationPeriods.push_back(generatedExaminationPeriod);
+    }
+
+    index.InformationTypes = GetStringVector(propertyList, "informationtypes");
+
+    index.ImageIDs = GetStringVector(propertyList, "images");
+    for (const auto& imageID : index.ImageIDs)
+    {
+      // an image has to have exactly two values (the information type and the ID of the control point)
+      std::vector<std::string> imageValue = GetStringVector(propertyList, imageID);
+      if (imageValue.size() != 2)
+      {
+        continue;
+      }
+
+      index.Images[imageID] = std::make_pair(imageValue[0], imageValue[1]);
+      index.ImageIDsByInformationType[imageValue[0]].push_back(imageID);
+      index.ImageIDsByControlPoint[imageValue[1]].push_back(imageID);
+    }
+
+    index.SegmentationIDs = GetStringVector(propertyList, "segmentations");
+    for (const auto& segmentationID : index.SegmentationIDs)
+    {
+      // a segmentation has to have exactly two values (the ID of the referenced image and the ID of the referenced lesion)
+      std::vector<std::string> segmentationValue = GetStringVector(propertyList, segmentationID);
+      if (segmentationValue.size() != 2)
+      {
+        continue;
+      }
+
+      index.Segmentations[segmentationID] = std::make_pair(segmentationValue[0], segmentationValue[1]);
+      index.SegmentationIDsByImage[segmentationValue[0]].push_back(segmentationID);
+      index.SegmentationIDsByLesion[segmentationValue[1]].push_back(segmentationID);
+    }
+
+    index.PropertyList = propertyList;
+    // the modification time of a property list includes the modification times of its properties
+    index.PropertyListMTime = propertyList->GetMTime();
   }
 
-  std::vector<std::string> lesionsVectorPropertyValue = lesionsVectorProperty->GetValue();
-  SemanticTypes::LesionVector allLesionsOfCase;
-  for (const auto& lesionID : lesionsVectorPropertyValue)
+  const CaseIndex* GetCaseIndex(const mitk::SemanticTypes::CaseID& caseID)
   {
-    SemanticTypes::Lesion generatedLesion = GenerateLesion(caseID, lesionID);
-    if (!generatedLesion.UID.empty())
+    mitk::PropertyList::Pointer propertyList = GetStorageData(caseID);
+    if (nullptr == propertyList)
     {
-      allLesionsOfCase.push_back(generatedLesion);
+      MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
+      return nullptr;
     }
+
+    static std::map<mitk::SemanticTypes::CaseID, CaseIndex> caseIndices;
+    CaseIndex& index = caseIndices[caseID];
+    if (index.PropertyList != propertyList.GetPointer() || index.PropertyListMTime != propertyList->GetMTime())
+    {
+      BuildCaseIndex(caseID, propertyList, index);
+    }
+
+    return &index;
   }
 
-  return allLesionsOfCase;
+  template <typename TMap>
+  mitk::SemanticTypes::IDVector GetIDs(const TMap& idMap, const typename TMap::key_type& key)
+  {
+    auto ids = idMap.find(key);
+    if (ids == idMap.end())
+    {
+      return mitk::SemanticTypes::IDVector();
+    }
+
+    return ids->second;
+  }
 }
 
-mitk::SemanticTypes::Lesion mitk::RelationStorage::GetLesionOfSegmentation(const SemanticTypes::CaseID& caseID, const SemanticTypes::ID& segmentationID)
+mitk::SemanticTypes::LesionVector mitk::RelationStorage::GetAllLesionsOfCase(const SemanticTypes::CaseID& caseID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  const CaseIndex* index = GetCaseIndex(caseID);
+  if (nullptr == index)
   {
-    MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
-    return SemanticTypes::Lesion();
+    return SemanticTypes::LesionVector();
   }
 
-  // retrieve a vector property that contains the referenced ID of a segmentation (0. image ID 1. lesion ID)
-  VectorProperty<std::string>* segmentationVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(segmentationID));
-  if (nullptr == segmentationVectorProperty)
+  return index->Lesions;
+}
+
+mitk::SemanticTypes::Lesion mitk::RelationStorage::GetLesionOfSegmentation(const SemanticTypes::CaseID& caseID, const SemanticTypes::ID& segmentationID)
+{
+  const CaseIndex* index = GetCaseIndex(caseID);
+  if (nullptr == index)
   {
-    MITK_DEBUG << "Could not find the segmentation " << segmentationID << " in the storage.";
     return SemanticTypes::Lesion();
   }
 
-  std::vector<std::string> segmentationVectorPropertyValue = segmentationVectorProperty->GetValue();
-  // the lesion ID of a segmentation is the second value in the vector
-  if (segmentationVectorPropertyValue.size() != 2)
+  auto segmentation = index->Segmentations.find(segmentationID);
+  if (segmentation == index->Segmentations.end())
   {
-    MITK_DEBUG << "Incorrect segmentation storage. Not two (2) IDs stored.";
+    MITK_DEBUG << "Could not find the segmentation " << segmentationID << " in the storage.";
     return SemanticTypes::Lesion();
   }
 
-  std::string lesionID = segmentationVectorPropertyValue[1];
-  if (lesionID.empty())
+  // the lesion ID of a segmentation is the second value; an empty ID means that the segmentation does not refer to any lesion
+  auto lesion = index->LesionsByID.find(segmentation->second.second);
+  if (lesion == index->LesionsByID.end())
   {
-    // segmentation does not refer to any lesion; return empty lesion
     return SemanticTypes::Lesion();
   }
 
-  return GenerateLesion(caseID, lesionID);
+  return lesion->second;
 }
 
 mitk::SemanticTypes::ControlPointVector mitk::RelationStorage::GetAllControlPointsOfCase(const SemanticTypes::CaseID& caseID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  const CaseIndex* index = GetCaseIndex(caseID);
+  if (nullptr == index)
   {
-    MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return SemanticTypes::ControlPointVector();
   }
 
-  // retrieve a vector property that contains the valid control point-IDs for the current case
-  VectorProperty<std::string>* controlPointsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("controlpoints"));
-  if (nullptr == controlPointsVectorProperty)
-  {
-    MITK_DEBUG << "Could not find any control points in the storage.";
-    return SemanticTypes::ControlPointVector();
-  }
-
-  std::vector<std::string> controlPointsVectorPropertyValue = controlPointsVectorProperty->GetValue();
-  SemanticTypes::ControlPointVector allControlPointsOfCase;
-  for (const auto& controlPointUID : controlPointsVectorPropertyValue)
-  {
-    SemanticTypes::ControlPoint generatedControlPoint = GenerateControlpoint(caseID, controlPointUID);
-    if (!generatedControlPoint.UID.empty())
-    {
-      allControlPointsOfCase.push_back(generatedControlPoint);
-    }
-  }
-
-  return allControlPointsOfCase;
+  return index->ControlPoints;
 }
 
 mitk::SemanticTypes::ControlPoint mitk::RelationStorage::GetControlPointOfImage(const SemanticTypes::CaseID& caseID, const SemanticTypes::ID& imageID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
-  {
-    MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
-    return SemanticTypes::ControlPoint();
-  }
-  // retrieve a vector property that contains the information type and the referenced ID of a control point (0. information type 1. control point ID)
-  VectorProperty<std::string>* imageVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(imageID));
-  if (nullptr == imageVectorProperty)
+  const CaseIndex* index = GetCaseIndex(caseID);
+  if (nullptr == index)
   {
-    MITK_DEBUG << "Could not find the image " << imageID << " in the storage.";
     return SemanticTypes::ControlPoint();
   }
 
-  std::vector<std::string> imageVectorPropertyValue = imageVectorProperty->GetValue();
-  SemanticTypes::ControlPoint controlPoint;
-  // an image has to have exactly two values (the information type and the ID of the control point)
-  if (imageVectorPropertyValue.size() != 2)
+  auto image = index->Images.find(imageID);
+  if (image == index->Images.end())
   {
-    MITK_DEBUG << "Incorrect data storage. Not two (2) values stored.";
-    return SemanticTypes::ControlPoint();
-  }
-
-  // the second value of the image vector is the ID of the referenced control point
-  std::string controlPointID = imageVectorPropertyValue[1];
-  // retrieve a vector property that contains the integer values of the date of a control point (0. year 1. month 2. day)
-  VectorProperty<int>* controlPointVectorProperty = dynamic_cast<VectorProperty<int>*>(propertyList->GetProperty(controlPointID));
-  if (nullptr == controlPointVectorProperty)
-  {
-    MITK_DEBUG << "Could not find the control point " << controlPointID << " in the storage.";
+    MITK_DEBUG << "Could not find the image " << imageID << " in the storage.";
     return SemanticTypes::ControlPoint();
   }
 
-  std::vector<int> controlPointVectorPropertyValue = controlPointVectorProperty->GetValue();
-  // a control point has to have exactly three integer values (year, month and day)
-  if (controlPointVectorPropertyValue.size() != 3)
+  // the second value of an image is the ID of the referenced control point
+  auto controlPoint = index->ControlPointsByID.find(image->second.second);
+  if (controlPoint == index->ControlPointsByID.end())
   {
-    MITK_DEBUG << "Incorrect control point storage. Not three (3) values of the date are stored.";
+    MITK_DEBUG << "Could not find the control point " << image->second.second << " in the storage.";
     return SemanticTypes::ControlPoint();
   }
 
-  // set the values of the control point
-  controlPoint.UID = controlPointID;
-  controlPoint.date = boost::gregorian::date(controlPointVectorPropertyValue[0],
-                                             controlPointVectorPropertyValue[1],
-                                             controlPointVectorPropertyValue[2]);
-
-  return controlPoint;
+  return controlPoint->second;
 }
 
 mitk::SemanticTypes::ExaminationPeriodVector mitk::RelationStorage::GetAllExaminationPeriodsOfCase(const SemanticTypes::CaseID& caseID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
-  {
-    MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
-    return SemanticTypes::ExaminationPeriodVector();
-  }
-
-  // retrieve a vector property that contains the valid examination period UIDs for the current case
-  VectorProperty<std::string>::Pointer examinationPeriodsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("examinationperiods"));
-  if (nullptr == examinationPeriodsVectorProperty)
+  const CaseIndex* index = GetCaseIndex(caseID);
+  if (nullptr == index)
   {
-    MITK_DEBUG << "Could not find any examination periods in the storage.";
     return SemanticTypes::ExaminationPeriodVector();
   }
 
-  std::vector<std::string> examinationPeriodsVectorPropertyValue = examinationPeriodsVectorProperty->GetValue();
-  SemanticTypes::ExaminationPeriodVector allExaminationPeriods;
-  for (const auto& examinationPeriodID : examinationPeriodsVectorPropertyValue)
-  {
-    // retrieve a vector property that contains the represented control point-IDs
-    VectorProperty<std::string>::Pointer examinationPeriodVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(examinationPeriodID));
-    if (nullptr == examinationPeriodVectorProperty)
-    {
-      MITK_DEBUG << "Could not find the examination period " << examinationPeriodID << " in the storage.";
-      continue;
-    }
-
-    std::vector<std::string> examinationPeriodVectorPropertyValue = examinationPeriodVectorProperty->GetValue();
-    // an examination period has an arbitrary number of vector values (name and control point UIDs) (at least one for the name)
-    if (examinationPeriodVectorPropertyValue.empty())
-    {
-      MITK_DEBUG << "Incorrect examination period storage. At least one (1) value for the examination period name has to be stored.";
-      continue;
-    }
-    else
-    {
-      // set the values of the name and the control points
-      SemanticTypes::ExaminationPeriod generatedExaminationPeriod;
-      generatedExaminationPeriod.UID = examinationPeriodID;
-      generatedExaminationPeriod.name = examinationPeriodVectorPropertyValue[0];
-      for (size_t i = 1; i < examinationPeriodVectorPropertyValue.size(); ++i)
-      {
-        generatedExaminationPeriod.controlPointUIDs.push_back(examinationPeriodVectorPropertyValue[i]);
-      }
-
-      allExaminationPeriods.push_back(generatedExaminationPeriod);
-    }
-  }
-  return allExaminationPeriods;
+  return index->ExaminationPeriods;
 }
 
 mitk::SemanticTypes::InformationTypeVector mitk::RelationStorage::GetAllInformationTypesOfCase(const SemanticTypes::CaseID& caseID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  const CaseIndex* index = GetCaseIndex(caseID);
+  if (nullptr == index)
   {
-    MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
-    return SemanticTypes::InformationTypeVector();
-  }
-  // retrieve a vector property that contains the valid information types of the current case
-  VectorProperty<std::string>* informationTypesVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("informationtypes"));
-  if (nullptr == informationTypesVectorProperty)
-  {
-    MITK_DEBUG << "Could not find any information types in the storage.";
     return SemanticTypes::InformationTypeVector();
   }
 
-  return informationTypesVectorProperty->GetValue();
+  return index->InformationTypes;
 }
 
 mitk::SemanticTypes::InformationType mitk::RelationStorage::GetInformationTypeOfImage(const SemanticTypes::CaseID& caseID, const SemanticTypes::ID& imageID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  const CaseIndex* index = GetCaseIndex(caseID);
+  if (nullptr == index)
   {
-    MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
-    return SemanticTypes::InformationType();
-  }
-  // retrieve a vector property that contains the information type and the referenced ID of an image (0. information type 1. control point ID)
-  VectorProperty<std::string>* imageVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(imageID));
-  if (nullptr == imageVectorProperty)
-  {
-    MITK_DEBUG << "Could not find the image " << imageID << " in the storage.";
     return SemanticTypes::InformationType();
   }
 
-  std::vector<std::string> imageVectorPropertyValue = imageVectorProperty->GetValue();
-  // an image has to have exactly two values (the information type and the ID of the control point)
-  if (imageVectorPropertyValue.size() != 2)
+  auto image = index->Images.find(imageID);
+  if (image == index->Images.end())
   {
-    MITK_DEBUG << "Incorrect data storage. Not two (2) values stored.";
+    MITK_DEBUG << "Could not find the image " << imageID << " in the storage.";
     return SemanticTypes::InformationType();
   }
 
-  // the first value of the image vector is the information type
-  return imageVectorPropertyValue[0];
+  // the first value of an image is the information type
+  return image->second.first;
 }
 
 mitk::SemanticTypes::IDVector mitk::RelationStorage::GetAllImageIDsOfCase(const SemanticTypes::CaseID& caseID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  const CaseIndex* index = GetCaseIndex(caseID);
+  if (nullptr == index)
   {
-    MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
-    return SemanticTypes::IDVector();
-  }
-  // retrieve a vector property that contains the valid image-IDs of the current case
-  VectorProperty<std::string>* imagesVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("images"));
-  if (nullptr == imagesVectorProperty)
-  {
-    MITK_DEBUG << "Could not find any image in the storage.";
     return SemanticTypes::IDVector();
   }
 
-  return imagesVectorProperty->GetValue();
+  return index->ImageIDs;
 }
 
 mitk::SemanticTypes::IDVector mitk::RelationStorage::GetAllImageIDsOfControlPoint(const SemanticTypes::CaseID& caseID, const SemanticTypes::ControlPoint& controlPoint)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
-  {
-    MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
-    return SemanticTypes::IDVector();
-  }
-  // retrieve a vector property that contains the valid image-IDs of the current case
-  VectorProperty<std::string>* imagesVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("images"));
-  if (nullptr == imagesVectorProperty)
+  const CaseIndex* index = GetCaseIndex(caseID);
+  if (nullptr == index)
   {
-    MITK_DEBUG << "Could not find any image in the storage.";
     return SemanticTypes::IDVector();
   }
 
-  mitk::SemanticTypes::IDVector allImageIDsOfControlPoint;
-  std::vector<std::string> imagesVectorPropertyValue = imagesVectorProperty->GetValue();
-  for (const auto& imageID : imagesVectorPropertyValue)
-  {
-    // retrieve a vector property that contains the referenced ID of an image (0. information type 1. control point ID)
-    VectorProperty<std::string>* imageVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(imageID));
-    if (nullptr == imageVectorProperty)
-    {
-      continue;
-    }
-
-    std::vector<std::string> imageVectorPropertyValue = imageVectorProperty->GetValue();
-    // an image has to have exactly two values (the information type and the ID of the control point)
-    if (imageVectorPropertyValue.size() != 2)
-    {
-      continue;
-    }
-
-    // the second value of the image vector is the ID of the referenced control point
-    if (imageVectorPropertyValue[1] == controlPoint.UID)
-    {
-      allImageIDsOfControlPoint.push_back(imageID);
-    }
-  }
-
-  return allImageIDsOfControlPoint;
+  return GetIDs(index->ImageIDsByControlPoint, controlPoint.UID);
 }
 
 mitk::SemanticTypes::IDVector mitk::RelationStorage::GetAllImageIDsOfInformationType(const SemanticTypes::CaseID& caseID, const SemanticTypes::InformationType& informationType)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
-  {
-    MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
-    return SemanticTypes::IDVector();
-  }
-  // retrieve a vector property that contains the valid image-IDs of the current case
-  VectorProperty<std::string>* imagesVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("images"));
-  if (nullptr == imagesVectorProperty)
+  const CaseIndex* index = GetCaseIndex(caseID);
+  if (nullptr == index)
   {
-    MITK_DEBUG << "Could not find any image in the storage.";
     return SemanticTypes::IDVector();
   }
 
-  mitk::SemanticTypes::IDVector allImageIDsOfInformationType;
-  std::vector<std::string> imagesVectorPropertyValue = imagesVectorProperty->GetValue();
-  for (const auto& imageID : imagesVectorPropertyValue)
-  {
-    // retrieve a vector property that contains the referenced ID of an image (0. information type 1. control point ID)
-    VectorProperty<std::string>* imageVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(imageID));
-    if (nullptr == imageVectorProperty)
-    {
-      continue;
-    }
-
-    std::vector<std::string> imageVectorPropertyValue = imageVectorProperty->GetValue();
-    // an image has to have exactly two values (the information type and the ID of the control point)
-    if (imageVectorPropertyValue.size() != 2)
-    {
-      continue;
-    }
-
-    // the first value of the image vector is the ID of the referenced information type
-    if (imageVectorPropertyValue[0] == informationType)
-    {
-      allImageIDsOfInformationType.push_back(imageID);
-    }
-  }
-
-  return allImageIDsOfInformationType;
+  return GetIDs(index->ImageIDsByInformationType, informationType);
 }
 
 mitk::SemanticTypes::IDVector mitk::RelationStorage::GetAllSegmentationIDsOfCase(const SemanticTypes::CaseID& caseID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
-  {
-    MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
-    return SemanticTypes::IDVector();
-  }
-  // retrieve a vector property that contains the valid segmentation-IDs for the current case
-  VectorProperty<std::string>* segmentationsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("segmentations"));
-  if (nullptr == segmentationsVectorProperty)
+  const CaseIndex* index = GetCaseIndex(caseID);
+  if (nullptr == index)
   {
-    MITK_DEBUG << "Could not find any segmentation in the storage.";
     return SemanticTypes::IDVector();
   }
 
-  return segmentationsVectorProperty->GetValue();
+  return index->SegmentationIDs;
 }
 
 mitk::SemanticTypes::IDVector mitk::RelationStorage::GetAllSegmentationIDsOfImage(const SemanticTypes::CaseID& caseID, const SemanticTypes::ID& imageID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  const CaseIndex* index = GetCaseIndex(caseID);
+  if (nullptr == index)
   {
-    MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
-    return SemanticTypes::IDVector();
-  }
-  // retrieve a vector property that contains the valid segmentation-IDs for the current case
-  VectorProperty<std::string>* segmentationsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("segmentations"));
-  if (nullptr == segmentationsVectorProperty)
-  {
-    MITK_DEBUG << "Could not find any segmentation in the storage.";
     return SemanticTypes::IDVector();
   }
 
-  mitk::SemanticTypes::IDVector allSegmentationIDsOfImage;
-  std::vector<std::string> segmentationsVectorPropertyValue = segmentationsVectorProperty->GetValue();
-  for (const auto& segmentationID : segmentationsVectorPropertyValue)
-  {
-    // retrieve a vector property that contains the referenced ID of a segmentation (0. image ID 1. lesion ID)
-    VectorProperty<std::string>* segmentationVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(segmentationID));
-    if (nullptr == segmentationVectorProperty)
-    {
-      continue;
-    }
-
-    std::vector<std::string> segmentationVectorPropertyValue = segmentationVectorProperty->GetValue();
-    // a segmentation has to have exactly two values (the ID of the referenced image and the ID of the referenced lesion)
-    if (segmentationVectorPropertyValue.size() != 2)
-    {
-      continue;
-    }
-
-    // the first value of the segmentation vector is the ID of the referenced image
-    if (segmentationVectorPropertyValue[0] == imageID)
-    {
-      allSegmentationIDsOfImage.push_back(segmentationID);
-    }
-  }
-
-  return allSegmentationIDsOfImage;
+  return GetIDs(index->SegmentationIDsByImage, imageID);
 }
 
 mitk::SemanticTypes::IDVector mitk::RelationStorage::GetAllSegmentationIDsOfLesion(const SemanticTypes::CaseID& caseID, const SemanticTypes::Lesion& lesion)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  const CaseIndex* index = GetCaseIndex(caseID);
+  if (nullptr == index)
   {
-    MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return SemanticTypes::IDVector();
   }
-  // retrieve a vector property that contains the valid segmentation-IDs for the current case
-  VectorProperty<std::string>* segmentationsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("segmentations"));
-  if (nullptr == segmentationsVectorProperty)
-  {
-    MITK_DEBUG << "Could not find any segmentation in the storage.";
-    return SemanticTypes::IDVector();
-  }
-
-  mitk::SemanticTypes::IDVector allSegmentationIDsOfLesion;
-  std::vector<std::string> segmentationsVectorPropertyValue = segmentationsVectorProperty->GetValue();
-  for (const auto& segmentationID : segmentationsVectorPropertyValue)
-  {
-    // retrieve a vector property that contains the referenced ID of a segmentation (0. image ID 1. lesion ID)
-    VectorProperty<std::string>* segmentationVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(segmentationID));
-    if (nullptr == segmentationVectorProperty)
-    {
-      continue;
-    }
-
-    std::vector<std::string> segmentationVectorPropertyValue = segmentationVectorProperty->GetValue();
-    // a segmentation has to have exactly two values (the ID of the referenced image and the ID of the referenced lesion)
-    if (segmentationVectorPropertyValue.size() != 2)
-    {
-      continue;
-    }
-
-    // the second value of the segmentation vector is the ID of the referenced lesion
-    if (segmentationVectorPropertyValue[1] == lesion.UID)
-    {
-      allSegmentationIDsOfLesion.push_back(segmentationID);
-    }
-  }
 
-  return allSegmentationIDsOfLesion;
+  return GetIDs(index->SegmentationIDsByLesion, lesion.UID);
 }
 
 mitk::SemanticTypes::ID mitk::RelationStorage::GetImageIDOfSegmentation(const SemanticTypes::CaseID& caseID, const SemanticTypes::ID& segmentationID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  const CaseIndex* index = GetCaseIndex(caseID);
+  if (nullptr == index)
   {
-    MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return SemanticTypes::ID();
   }
 
-  // retrieve a vector property that contains the referenced ID of a segmentation (0. image ID 1. lesion ID)
-  VectorProperty<std::string>* segmentationVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(segmentationID));
-  if (nullptr == segmentationVectorProperty)
+  auto segmentation = index->Segmentations.find(segmentationID);
+  if (segmentation == index->Segmentations.end())
   {
     MITK_DEBUG << "Could not find the segmentation " << segmentationID << " in the storage.";
     return SemanticTypes::ID();
   }
 
-  std::vector<std::string> segmentationVectorPropertyValue = segmentationVectorProperty->GetValue();
-  // the lesion ID of a segmentation is the second value in the vector
-  if (segmentationVectorPropertyValue.size() != 2)
-  {
-    MITK_DEBUG << "Incorrect segmentation storage. Not two (2) IDs stored.";
-    return SemanticTypes::ID();
-  }
-
-  return segmentationVectorPropertyValue[0];
+  return segmentation->second.first;
 }
 
 std::vector<mitk::SemanticTypes::CaseID> mitk::RelationStorage::GetAllCaseIDs()
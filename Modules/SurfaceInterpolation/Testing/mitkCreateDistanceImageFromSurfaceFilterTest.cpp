@@ -17,7 +17,10 @@ found in the LICENSE file.
 #include <mitkTestFixture.h>
 #include <mitkTestingMacros.h>
 
+#include <vtkCellArray.h>
 #include <vtkDebugLeaks.h>
+#include <vtkPolyData.h>
+#include <vtkPolygon.h>
 
 class mitkCreateDistanceImageFromSurfaceFilterTestSuite : public mitk::TestFixture
 {
@@ -25,11 +28,37 @@ class mitkCreateDistanceImageFromSurfaceFilterTestSuite : public mitk::TestFixtu
   vtkDebugLeaks::SetExitError(0);
   MITK_TEST(TestCreateDistanceImageForLiver);
   MITK_TEST(TestCreateDistanceImageForTube);
+  MITK_TEST(TestIncrementalUpdate);
   CPPUNIT_TEST_SUITE_END();
 
 private:
   std::vector<mitk::Surface::Pointer> contourList;
 
+  mitk::Surface::Pointer CreateCircleContour(double z, double radius)
+  {
+    const unsigned int numberOfPoints = 40;
+    vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+    vtkSmartPointer<vtkPolygon> polygon = vtkSmartPointer<vtkPolygon>::New();
+    polygon->GetPointIds()->SetNumberOfIds(numberOfPoints);
+    for (unsigned int i = 0; i < numberOfPoints; ++i)
+    {
+      const double angle = 2.0 * vtkMath::Pi() * i / numberOfPoints;
+      points->InsertNextPoint(20.0 + radius * std::cos(angle), 20.0 + radius * std::sin(angle), z);
+      polygon->GetPointIds()->SetId(i, i);
+    }
+
+    vtkSmartPointer<vtkCellArray> polygons = vtkSmartPointer<vtkCellArray>::New();
+    polygons->InsertNextCell(polygon);
+
+    vtkSmartPointer<vtkPolyData> polyData = vtkSmartPointer<vtkPolyData>::New();
+    polyData->SetPoints(points);
+    polyData->SetPolys(polygons);
+
+    mitk::Surface::Pointer contour = mitk::Surface::New();
+    contour->SetVtkPolyData(polyData);
+    return contour;
+  }
+
 public:
   void setUp() override {}
   template <typename TPixel, unsigned int VImageDimension>
@@ -127,6 +156,46 @@ public:
     CPPUNIT_ASSERT_MESSAGE("HolesDistanceImages are not equal!",
                            mitk::Equal(*(holesDistanceImageReference), *(holeDistanceImage), 0.0001, true));
   }
+
+  // Appending a contour within the bounds of the others extends the equation system of the last update
+  void TestIncrementalUpdate()
+  {
+    contourList.push_back(this->CreateCircleContour(0.0, 10.0));
+    contourList.push_back(this->CreateCircleContour(20.0, 10.0));
+    contourList.push_back(this->CreateCircleContour(10.0, 6.0));
+
+    itk::ImageBase<3>::Pointer referenceImage = itk::ImageBase<3>::New();
+
+    mitk::ComputeContourSetNormalsFilter::Pointer normalsFilter = mitk::ComputeContourSetNormalsFilter::New();
+    mitk::CreateDistanceImageFromSurfaceFilter::Pointer incrementalFilter =
+      mitk::CreateDistanceImageFromSurfaceFilter::New();
+    incrementalFilter->SetReferenceImage(referenceImage);
+
+    for (unsigned int j = 0; j < 2; j++)
+    {
+      normalsFilter->SetInput(j, contourList.at(j));
+      incrementalFilter->SetInput(j, normalsFilter->GetOutput(j));
+    }
+    incrementalFilter->Update();
+    CPPUNIT_ASSERT(!incrementalFilter->GetLastUpdateWasIncremental());
+
+    normalsFilter->SetInput(2, contourList.at(2));
+    incrementalFilter->SetInput(2, normalsFilter->GetOutput(2));
+    incrementalFilter->Update();
+    CPPUNIT_ASSERT(incrementalFilter->GetLastUpdateWasIncremental());
+
+    mitk::CreateDistanceImageFromSurfaceFilter::Pointer fullFilter = mitk::CreateDistanceImageFromSurfaceFilter::New();
+    fullFilter->SetReferenceImage(referenceImage);
+    fullFilter->UseIncrementalUpdateOff();
+    for (unsigned int j = 0; j < contourList.size(); j++)
+      fullFilter->SetInput(j, normalsFilter->GetOutput(j));
+    fullFilter->Update();
+    CPPUNIT_ASSERT(!fullFilter->GetLastUpdateWasIncremental());
+
+    CPPUNIT_ASSERT_MESSAGE(
+      "Incrementally updated distance image differs!",
+      mitk::Equal(*(fullFilter->GetOutput()), *(incrementalFilter->GetOutput()), 0.0001, true));
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkCreateDistanceImageFromSurfaceFilter)
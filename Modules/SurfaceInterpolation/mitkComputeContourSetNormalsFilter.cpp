@@ -46,6 +46,25 @@ void mitk::ComputeContourSetNormalsFilter::GenerateData()
 
     vtkSmartPointer<vtkPoints> existingPoints = polyData->GetPoints();
 
+    // Reuse the normals of the last update if the contour did not change
+    CachedContourNormals currentContour;
+    currentContour.Points.resize(3 * polyData->GetNumberOfPoints());
+    for (vtkIdType id = 0; id < polyData->GetNumberOfPoints(); ++id)
+      existingPoints->GetPoint(id, &currentContour.Points[3 * id]);
+    vtkIdTypeArray *polyIds = existingPolys->GetData();
+    currentContour.Polys.assign(polyIds->GetPointer(0), polyIds->GetPointer(0) + polyIds->GetNumberOfValues());
+
+    if (m_NormalsCache.size() <= i)
+      m_NormalsCache.resize(i + 1);
+
+    CachedContourNormals &cachedContour = m_NormalsCache[i];
+    if (cachedContour.Normals != nullptr && cachedContour.Points == currentContour.Points &&
+        cachedContour.Polys == currentContour.Polys)
+    {
+      this->GetOutput(i)->GetVtkPolyData()->GetCellData()->SetNormals(cachedContour.Normals);
+      continue;
+    }
+
     existingPolys->InitTraversal();
 
     vtkIdType *cell(nullptr);
@@ -238,8 +257,13 @@ void mitk::ComputeContourSetNormalsFilter::GenerateData()
 
     Surface::Pointer surface = this->GetOutput(i);
     surface->GetVtkPolyData()->GetCellData()->SetNormals(normals);
+
+    currentContour.Normals = normals;
+    cachedContour = std::move(currentContour);
   } // end for all inputs
 
+  m_NormalsCache.resize(numberOfInputs);
+
   // Setting progressbar
   if (this->m_UseProgressBar)
     mitk::ProgressBar::GetInstance()->Progress(this->m_ProgressStepSize);
@@ -311,6 +335,8 @@ mitk::Surface::Pointer mitk::ComputeContourSetNormalsFilter::GetNormalsAsSurface
 
 void mitk::ComputeContourSetNormalsFilter::SetMaxSpacing(double maxSpacing)
 {
+  if (m_MaxSpacing != maxSpacing)
+    m_NormalsCache.clear();
   m_MaxSpacing = maxSpacing;
 }
 
@@ -327,6 +353,7 @@ void mitk::ComputeContourSetNormalsFilter::Reset()
   }
   this->SetNumberOfIndexedInputs(0);
   this->SetNumberOfIndexedOutputs(0);
+  m_NormalsCache.clear();
 
   mitk::Surface::Pointer output = mitk::Surface::New();
   this->SetNthOutput(0, output.GetPointer());
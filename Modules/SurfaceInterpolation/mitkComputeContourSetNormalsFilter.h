@@ -28,6 +28,8 @@ found in the LICENSE file.
 
 #include "mitkImage.h"
 
+#include <vector>
+
 namespace mitk
 {
   /**
@@ -45,6 +47,11 @@ namespace mitk
    Note: If a segmentation binary image is provided this filter assures that the computed normals
          do not point into the segmentation image
 
+   The normals of each input are cached. If an input has the same points and polygons as in the last
+   update its normals are reused, so only added or changed contours are processed again. The direction
+   test samples the segmentation in the plane of the contour, which only changes together with the contour.
+   Reset() and SetMaxSpacing() discard the cache.
+
    $Author: fetzer$
 */
   class MITKSURFACEINTERPOLATION_EXPORT ComputeContourSetNormalsFilter : public SurfaceToSurfaceFilter
@@ -86,6 +93,13 @@ namespace mitk
     void GenerateOutputInformation() override;
 
   private:
+    struct CachedContourNormals
+    {
+      std::vector<double> Points;
+      std::vector<vtkIdType> Polys;
+      vtkSmartPointer<vtkDoubleArray> Normals;
+    };
+
     // The segmentation out of which the contours were extracted. Can be used to determine the direction of the normals
     mitk::Image::Pointer m_SegmentationBinaryImage;
     double m_MaxSpacing;
@@ -96,6 +110,8 @@ namespace mitk
     bool m_UseProgressBar;
     unsigned int m_ProgressStepSize;
 
+    std::vector<CachedContourNormals> m_NormalsCache;
+
   }; // class
 
 } // namespace
@@ -20,9 +20,57 @@ found in the LICENSE file.
 #include "vtkSmartPointer.h"
 
 #include "itkImageRegionIteratorWithIndex.h"
-#include "itkNeighborhoodIterator.h"
+#include "itkMultiThreader.h"
 
-#include <queue>
+#include <algorithm>
+#include <functional>
+
+namespace
+{
+  // Below this number of items the work is not distributed over threads
+  const std::size_t MinimumParallelSize = 64;
+
+  struct ParallelRange
+  {
+    std::function<void(std::size_t, std::size_t)> Function;
+    std::size_t Size;
+  };
+
+  ITK_THREAD_RETURN_TYPE ExecuteParallelRange(void *arg)
+  {
+    auto *threadInfo = static_cast<itk::MultiThreader::ThreadInfoStruct *>(arg);
+    auto *range = static_cast<ParallelRange *>(threadInfo->UserData);
+    const std::size_t begin = range->Size * threadInfo->ThreadID / threadInfo->NumberOfThreads;
+    const std::size_t end = range->Size * (threadInfo->ThreadID + 1) / threadInfo->NumberOfThreads;
+    if (begin < end)
+      range->Function(begin, end);
+    return ITK_THREAD_RETURN_VALUE;
+  }
+
+  // Calls the function for equally sized consecutive parts of [0, size) on all threads of the threader
+  void ParallelFor(itk::MultiThreader *threader,
+                   std::size_t size,
+                   const std::function<void(std::size_t, std::size_t)> &function)
+  {
+    if (size < MinimumParallelSize)
+    {
+      function(0, size);
+      return;
+    }
+
+    ParallelRange range = {function, size};
+    threader->SetSingleMethod(ExecuteParallelRange, &range);
+    threader->SingleMethodExecute();
+  }
+
+  Eigen::Matrix3Xd ToMatrix(const mitk::CreateDistanceImageFromSurfaceFilter::CenterList &centers)
+  {
+    Eigen::Matrix3Xd matrix(3, centers.size());
+    for (std::size_t i = 0; i < centers.size(); ++i)
+      matrix.col(i) << centers[i][0], centers[i][1], centers[i][2];
+    return matrix;
+  }
+}
 
 void mitk::CreateDistanceImageFromSurfaceFilter::CreateEmptyDistanceImage()
 {
@@ -105,7 +153,11 @@ void mitk::CreateDistanceImageFromSurfaceFilter::CreateEmptyDistanceImage()
 }
 
 mitk::CreateDistanceImageFromSurfaceFilter::CreateDistanceImageFromSurfaceFilter()
-  : m_DistanceImageSpacing(0.0), m_DistanceImageDefaultBufferValue(0.0)
+  : m_DistanceImageSpacing(0.0),
+    m_DistanceImageDefaultBufferValue(0.0),
+    m_UseIncrementalUpdate(true),
+    m_LastUpdateWasIncremental(false),
+    m_SolvedSpacing(0.0)
 {
   m_DistanceImageVolume = 50000;
   this->m_UseProgressBar = false;
@@ -124,16 +176,25 @@ void mitk::CreateDistanceImageFromSurfaceFilter::GenerateData()
   this->PreprocessContourPoints();
   this->CreateEmptyDistanceImage();
 
-  // First of all we have to build the equation-system from the existing contour-edge-points
-  this->CreateSolutionMatrixAndFunctionValues();
+  m_LastUpdateWasIncremental = m_UseIncrementalUpdate && this->AppendToEquationSystem();
+  if (m_LastUpdateWasIncremental)
+  {
+    if (this->m_UseProgressBar)
+      mitk::ProgressBar::GetInstance()->Progress(3);
+  }
+  else
+  {
+    // First of all we have to build the equation-system from the existing contour-edge-points
+    this->CreateSolutionMatrixAndFunctionValues();
 
-  if (this->m_UseProgressBar)
-    mitk::ProgressBar::GetInstance()->Progress(1);
+    if (this->m_UseProgressBar)
+      mitk::ProgressBar::GetInstance()->Progress(1);
 
-  m_Weights = m_SolutionMatrix.partialPivLu().solve(m_FunctionValues);
+    this->SolveEquationSystem();
 
-  if (this->m_UseProgressBar)
-    mitk::ProgressBar::GetInstance()->Progress(2);
+    if (this->m_UseProgressBar)
+      mitk::ProgressBar::GetInstance()->Progress(2);
+  }
 
   // The last step is to create the distance map with the interpolated distance function
   this->FillDistanceImage();
@@ -268,22 +329,137 @@ void mitk::CreateDistanceImageFromSurfaceFilter::CreateSolutionMatrixAndFunction
 
   m_Weights.resize(numberOfCenters);
 
-  PointType p1;
-  PointType p2;
-  double norm;
+  m_CenterMatrix = ToMatrix(m_Centers);
 
-  for (unsigned int i = 0; i < numberOfCenters; i++)
+  // Calculate the RBF values column by column in parallel. Currently using Phi(r) = r with r is the euclidian
+  // distance between two points
+  itk::MultiThreader::Pointer threader = itk::MultiThreader::New();
+  ParallelFor(threader, numberOfCenters, [this](std::size_t begin, std::size_t end) {
+    for (std::size_t j = begin; j < end; ++j)
+      m_SolutionMatrix.col(j) = (m_CenterMatrix.colwise() - m_CenterMatrix.col(j)).colwise().norm().transpose();
+  });
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::SolveEquationSystem()
+{
+  this->ClearEquationSystem();
+
+  m_Decomposition.compute(m_SolutionMatrix);
+  m_Weights = m_Decomposition.solve(m_FunctionValues);
+
+  // The decomposition holds its own copy of the matrix
+  m_SolutionMatrix.resize(0, 0);
+
+  m_EquationCenters = m_Centers;
+  m_SolvedContourPoints.assign(m_Centers.begin(), m_Centers.begin() + m_Normals.size());
+  m_SolvedNormals = m_Normals;
+  m_SolvedSpacing = m_DistanceImageSpacing;
+}
+
+bool mitk::CreateDistanceImageFromSurfaceFilter::AppendToEquationSystem()
+{
+  // The system can only be extended if the contour points it was created from are the first of the
+  // current contour points and all inner and outer points are at the same positions as before
+  const std::size_t numberOfSolvedPoints = m_SolvedContourPoints.size();
+  if (numberOfSolvedPoints == 0 || m_DistanceImageSpacing != m_SolvedSpacing ||
+      m_Centers.size() < numberOfSolvedPoints ||
+      !std::equal(m_SolvedContourPoints.begin(), m_SolvedContourPoints.end(), m_Centers.begin()) ||
+      !std::equal(m_SolvedNormals.begin(), m_SolvedNormals.end(), m_Normals.begin()))
+  {
+    return false;
+  }
+
+  // Edge, inner and outer points of the appended contours like in CreateSolutionMatrixAndFunctionValues()
+  const std::size_t numberOfAppendedPoints = m_Centers.size() - numberOfSolvedPoints;
+  const Eigen::Index numberOfAppendedCenters = 3 * numberOfAppendedPoints;
+
+  if (numberOfAppendedCenters > 0)
   {
-    for (unsigned int j = 0; j < numberOfCenters; j++)
+    CenterList appendedCenters;
+    appendedCenters.reserve(numberOfAppendedCenters);
+    Eigen::VectorXd appendedFunctionValues = Eigen::VectorXd::Zero(numberOfAppendedCenters);
+
+    for (std::size_t i = numberOfSolvedPoints; i < m_Centers.size(); ++i)
+      appendedCenters.push_back(m_Centers[i]);
+
+    for (std::size_t i = numberOfSolvedPoints; i < m_Centers.size(); ++i)
     {
-      // Calculate the RBF value. Currently using Phi(r) = r with r is the euclidian distance between two points
-      p1 = m_Centers.at(i);
-      p2 = m_Centers.at(j);
-      p1 = p1 - p2;
-      norm = p1.two_norm();
-      m_SolutionMatrix(i, j) = norm;
+      appendedCenters.push_back(m_Centers[i] - m_Normals[i] * m_DistanceImageSpacing);
+      appendedFunctionValues[appendedCenters.size() - 1] = -m_DistanceImageSpacing;
     }
+
+    for (std::size_t i = numberOfSolvedPoints; i < m_Centers.size(); ++i)
+    {
+      appendedCenters.push_back(m_Centers[i] + m_Normals[i] * m_DistanceImageSpacing);
+      appendedFunctionValues[appendedCenters.size() - 1] = m_DistanceImageSpacing;
+    }
+
+    // [A B; B^T C] [w; v] = [f; g] is solved by v = S^-1 (g - B^T A^-1 f) and w = A^-1 f - A^-1 B v with the
+    // Schur complement S = C - B^T A^-1 B. A^-1 f are the current weights, A^-1 B costs O(n^2 k) instead of O(n^3).
+    const Eigen::Index numberOfEquationCenters = m_EquationCenters.size();
+
+    const Eigen::Matrix3Xd equationCenters = ToMatrix(m_EquationCenters);
+    const Eigen::Matrix3Xd appendedCenterMatrix = ToMatrix(appendedCenters);
+
+    BorderBlock block;
+    block.Coupling.resize(numberOfEquationCenters, numberOfAppendedCenters);
+    Eigen::MatrixXd schurComplement(numberOfAppendedCenters, numberOfAppendedCenters);
+    for (Eigen::Index j = 0; j < numberOfAppendedCenters; ++j)
+    {
+      const Eigen::Vector3d center = appendedCenterMatrix.col(j);
+      block.Coupling.col(j) = (equationCenters.colwise() - center).colwise().norm().transpose();
+      schurComplement.col(j) = (appendedCenterMatrix.colwise() - center).colwise().norm().transpose();
+    }
+
+    block.Solution = this->Solve(block.Coupling);
+    schurComplement -= block.Coupling.transpose() * block.Solution;
+    block.SchurComplement.compute(schurComplement);
+
+    const Eigen::VectorXd appendedWeights =
+      block.SchurComplement.solve(appendedFunctionValues - block.Coupling.transpose() * m_Weights);
+    m_Weights -= block.Solution * appendedWeights;
+    m_Weights.conservativeResize(numberOfEquationCenters + numberOfAppendedCenters);
+    m_Weights.tail(numberOfAppendedCenters) = appendedWeights;
+
+    m_BorderBlocks.push_back(block);
+    m_EquationCenters.insert(m_EquationCenters.end(), appendedCenters.begin(), appendedCenters.end());
+    m_SolvedContourPoints = m_Centers;
+    m_SolvedNormals = m_Normals;
+  }
+
+  // The distance values are calculated with the centers in the order of the equation system
+  m_Centers = m_EquationCenters;
+  m_CenterMatrix = ToMatrix(m_Centers);
+  return true;
+}
+
+Eigen::MatrixXd mitk::CreateDistanceImageFromSurfaceFilter::Solve(const Eigen::MatrixXd &rightHandSide) const
+{
+  Eigen::MatrixXd solution = m_Decomposition.solve(rightHandSide.topRows(m_Decomposition.rows()));
+
+  for (const BorderBlock &block : m_BorderBlocks)
+  {
+    const Eigen::Index numberOfRows = solution.rows();
+    const Eigen::Index numberOfAppendedRows = block.Coupling.cols();
+
+    const Eigen::MatrixXd appendedSolution = block.SchurComplement.solve(
+      rightHandSide.middleRows(numberOfRows, numberOfAppendedRows) - block.Coupling.transpose() * solution);
+    solution -= block.Solution * appendedSolution;
+    solution.conservativeResize(numberOfRows + numberOfAppendedRows, Eigen::NoChange);
+    solution.bottomRows(numberOfAppendedRows) = appendedSolution;
   }
+
+  return solution;
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::ClearEquationSystem()
+{
+  m_Decomposition = Eigen::PartialPivLU<Eigen::MatrixXd>();
+  m_BorderBlocks.clear();
+  m_EquationCenters.clear();
+  m_SolvedContourPoints.clear();
+  m_SolvedNormals.clear();
+  m_SolvedSpacing = 0.0;
 }
 
 void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
@@ -300,9 +476,7 @@ void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
   */
 
   typedef itk::ImageRegionIteratorWithIndex<DistanceImageType> ImageIterator;
-  typedef itk::NeighborhoodIterator<DistanceImageType> NeighborhoodImageIterator;
 
-  std::queue<DistanceImageType::IndexType> narrowbandPoints;
   PointType currentPoint = m_Centers.at(0);
   double distance = this->CalculateDistanceValue(currentPoint);
 
@@ -316,49 +490,63 @@ void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
   DistanceImageType::IndexType currentIndex;
   m_DistanceImageITK->TransformPhysicalPointToIndex(currentPointAsPoint, currentIndex);
 
-  assert(
-    m_DistanceImageITK->GetLargestPossibleRegion().IsInside(currentIndex)); // we are quite certain this should hold
+  const DistanceImageType::RegionType region = m_DistanceImageITK->GetLargestPossibleRegion();
+  assert(region.IsInside(currentIndex)); // we are quite certain this should hold
 
-  narrowbandPoints.push(currentIndex);
   m_DistanceImageITK->SetPixel(currentIndex, distance);
 
-  NeighborhoodImageIterator::RadiusType radius;
-  radius.Fill(1);
-  NeighborhoodImageIterator nIt(radius, m_DistanceImageITK, m_DistanceImageITK->GetLargestPossibleRegion());
-  unsigned int relativeNbIdx[] = {4, 10, 12, 14, 16, 22};
+  // The narrow band grows wave by wave: the neighbors of all points added by the last wave are collected first,
+  // then their distances are calculated in parallel. Collected pixels are marked with a value no distance within
+  // the narrow band can have, so each pixel is calculated once per wave.
+  const double collectedPixelValue = -m_DistanceImageDefaultBufferValue;
+  itk::MultiThreader::Pointer threader = itk::MultiThreader::New();
 
-  bool isInBounds = false;
+  std::vector<DistanceImageType::IndexType> narrowbandPoints(1, currentIndex);
+  std::vector<DistanceImageType::IndexType> neighbors;
+  std::vector<double> distances;
   while (!narrowbandPoints.empty())
   {
-    nIt.SetLocation(narrowbandPoints.front());
-    narrowbandPoints.pop();
-
-    unsigned int *relativeNb = &relativeNbIdx[0];
-    for (int i = 0; i < 6; i++)
+    neighbors.clear();
+    for (const DistanceImageType::IndexType &index : narrowbandPoints)
     {
-      nIt.GetPixel(*relativeNb, isInBounds);
-      if (isInBounds && nIt.GetPixel(*relativeNb) == m_DistanceImageDefaultBufferValue)
+      for (unsigned int dim = 0; dim < 3; ++dim)
       {
-        currentIndex = nIt.GetIndex(*relativeNb);
-
-        // Transform the currently checked point from index-coordinates to
-        // world-coordinates
-        m_DistanceImageITK->TransformIndexToPhysicalPoint(currentIndex, currentPointAsPoint);
-
-        // create a vnl_vector
-        currentPoint[0] = currentPointAsPoint[0];
-        currentPoint[1] = currentPointAsPoint[1];
-        currentPoint[2] = currentPointAsPoint[2];
-
-        // and check the distance
-        distance = this->CalculateDistanceValue(currentPoint);
-        if (std::fabs(distance) <= m_DistanceImageSpacing * 2)
+        for (int step = -1; step <= 1; step += 2)
         {
-          nIt.SetPixel(*relativeNb, distance);
-          narrowbandPoints.push(currentIndex);
+          DistanceImageType::IndexType neighbor = index;
+          neighbor[dim] += step;
+          if (region.IsInside(neighbor) && m_DistanceImageITK->GetPixel(neighbor) == m_DistanceImageDefaultBufferValue)
+          {
+            m_DistanceImageITK->SetPixel(neighbor, collectedPixelValue);
+            neighbors.push_back(neighbor);
+          }
         }
       }
-      relativeNb++;
+    }
+
+    distances.resize(neighbors.size());
+    ParallelFor(threader, neighbors.size(), [&](std::size_t begin, std::size_t end) {
+      // Transform the currently checked point from index-coordinates to world-coordinates and check the distance
+      DistanceImageType::PointType point;
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        m_DistanceImageITK->TransformIndexToPhysicalPoint(neighbors[i], point);
+        distances[i] = this->CalculateDistanceValue(PointType(point.GetDataPointer()));
+      }
+    });
+
+    narrowbandPoints.clear();
+    for (std::size_t i = 0; i < neighbors.size(); ++i)
+    {
+      if (std::fabs(distances[i]) <= m_DistanceImageSpacing * 2)
+      {
+        m_DistanceImageITK->SetPixel(neighbors[i], distances[i]);
+        narrowbandPoints.push_back(neighbors[i]);
+      }
+      else
+      {
+        m_DistanceImageITK->SetPixel(neighbors[i], m_DistanceImageDefaultBufferValue);
+      }
     }
   }
 
@@ -419,25 +607,11 @@ void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
   CastToMitkImage(m_DistanceImageITK, resultImage);
 }
 
-double mitk::CreateDistanceImageFromSurfaceFilter::CalculateDistanceValue(PointType p)
+double mitk::CreateDistanceImageFromSurfaceFilter::CalculateDistanceValue(const PointType &p) const
 {
-  double distanceValue(0);
-  PointType p1;
-  PointType p2;
-  double norm;
-
-  CenterList::iterator centerIter;
-
-  unsigned int count(0);
-  for (centerIter = m_Centers.begin(); centerIter != m_Centers.end(); centerIter++)
-  {
-    p1 = *centerIter;
-    p2 = p - p1;
-    norm = p2.two_norm();
-    distanceValue = distanceValue + (norm * m_Weights[count]);
-    ++count;
-  }
-  return distanceValue;
+  // Sum of the weighted RBF values of all centers, vectorized by Eigen
+  const Eigen::Vector3d point(p[0], p[1], p[2]);
+  return (m_CenterMatrix.colwise() - point).colwise().norm().transpose().dot(m_Weights);
 }
 
 void mitk::CreateDistanceImageFromSurfaceFilter::GenerateOutputInformation()
@@ -446,23 +620,24 @@ void mitk::CreateDistanceImageFromSurfaceFilter::GenerateOutputInformation()
 
 void mitk::CreateDistanceImageFromSurfaceFilter::PrintEquationSystem()
 {
+  // The solution matrix itself is not kept after the decomposition, its entries are the distances of the centers
   std::stringstream out;
-  out << "Nummber of rows: " << m_SolutionMatrix.rows() << " ****** Number of columns: " << m_SolutionMatrix.cols()
+  out << "Nummber of rows: " << m_EquationCenters.size() << " ****** Number of columns: " << m_EquationCenters.size()
       << endl;
   out << "[ ";
-  for (int i = 0; i < m_SolutionMatrix.rows(); i++)
+  for (unsigned int i = 0; i < m_EquationCenters.size(); i++)
   {
-    for (int j = 0; j < m_SolutionMatrix.cols(); j++)
+    for (unsigned int j = 0; j < m_EquationCenters.size(); j++)
     {
-      out << m_SolutionMatrix(i, j) << "   ";
+      out << (m_EquationCenters.at(i) - m_EquationCenters.at(j)).two_norm() << "   ";
     }
     out << ";" << endl;
   }
   out << " ]\n\n\n";
 
-  for (unsigned int i = 0; i < m_Centers.size(); i++)
+  for (unsigned int i = 0; i < m_EquationCenters.size(); i++)
   {
-    out << m_Centers.at(i) << ";" << endl;
+    out << m_EquationCenters.at(i) << ";" << endl;
   }
   std::cout << "Equation system: \n\n\n" << out.str();
 }
@@ -519,6 +694,7 @@ void mitk::CreateDistanceImageFromSurfaceFilter::Reset()
   }
   this->SetNumberOfIndexedInputs(0);
   this->SetNumberOfIndexedOutputs(1);
+  this->ClearEquationSystem();
 
   mitk::Image::Pointer output = mitk::Image::New();
   this->SetNthOutput(0, output.GetPointer());
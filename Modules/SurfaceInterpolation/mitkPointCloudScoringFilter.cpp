@@ -12,10 +12,11 @@ found in the LICENSE file.
 
 #include "mitkPointCloudScoringFilter.h"
 
+#include <mitkPointLocator.h>
+
 #include <cmath>
 
 #include <vtkDoubleArray.h>
-#include <vtkKdTree.h>
 #include <vtkPointData.h>
 #include <vtkPoints.h>
 #include <vtkPolyVertex.h>
@@ -57,42 +58,34 @@ void mitk::PointCloudScoringFilter::GenerateData()
   vtkSmartPointer<vtkUnstructuredGrid> edgevtkGrid = edgeGrid->GetVtkUnstructuredGrid();
   vtkSmartPointer<vtkUnstructuredGrid> segmvtkGrid = segmGrid->GetVtkUnstructuredGrid();
 
-  // KdTree from here
-  vtkSmartPointer<vtkPoints> kdPoints = vtkSmartPointer<vtkPoints>::New();
-  vtkSmartPointer<vtkKdTree> kdTree = vtkSmartPointer<vtkKdTree>::New();
+  // the closest points of all points are searched at once, in parallel
+  auto locator = mitk::PointLocator::New();
+  locator->SetPoints(edgevtkGrid);
 
-  for (int i = 0; i < edgevtkGrid->GetNumberOfPoints(); i++)
+  const vtkIdType numberOfPoints = segmvtkGrid->GetNumberOfPoints();
+  std::vector<double> points(3 * numberOfPoints);
+  for (vtkIdType i = 0; i < numberOfPoints; i++)
   {
-    kdPoints->InsertNextPoint(edgevtkGrid->GetPoint(i));
+    segmvtkGrid->GetPoint(i, &points[3 * i]);
   }
 
-  kdTree->BuildLocatorFromPoints(kdPoints);
-  // KdTree until here
-
-  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
-
-  for (int i = 0; i < segmvtkGrid->GetNumberOfPoints(); i++)
-  {
-    points->InsertNextPoint(segmvtkGrid->GetPoint(i));
-  }
+  std::vector<mitk::PointLocator::IdType> closestPointIds(numberOfPoints);
+  std::vector<mitk::PointLocator::DistanceType> distances(numberOfPoints, 0.0);
+  locator->FindClosestPoints(points.data(), numberOfPoints, closestPointIds.data(), distances.data());
 
   std::vector<ScorePair> score;
-  std::vector<double> distances;
 
   double dist_glob = 0.0;
-  double dist = 0.0;
 
-  for (int i = 0; i < points->GetNumberOfPoints(); i++)
+  for (vtkIdType i = 0; i < numberOfPoints; i++)
   {
-    double point[3];
-    points->GetPoint(i, point);
-    kdTree->FindClosestPoint(point[0], point[1], point[2], dist);
+    // squared distance to the closest edge point
+    double dist = distances[i];
     dist_glob += dist;
-    distances.push_back(dist);
     score.push_back(std::make_pair(i, dist));
   }
 
-  double avg = dist_glob / points->GetNumberOfPoints();
+  double avg = dist_glob / numberOfPoints;
 
   double tmpVar = 0.0;
   double highest = 0.0;
@@ -16,12 +16,17 @@ found in the LICENSE file.
 
 #include <itkImage.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+
 #include "opencv2/imgproc.hpp"
 
 mitk::ToFCompositeFilter::ToFCompositeFilter() : m_SegmentationMask(nullptr), m_ImageWidth(0), m_ImageHeight(0), m_ImageSize(0),
 m_IplDistanceImage(nullptr), m_IplOutputImage(nullptr), m_ItkInputImage(nullptr), m_ApplyTemporalMedianFilter(false), m_ApplyAverageFilter(false),
-  m_ApplyMedianFilter(false), m_ApplyThresholdFilter(false), m_ApplyMaskSegmentation(false), m_ApplyBilateralFilter(false), m_DataBuffer(nullptr),
-m_DataBufferCurrentIndex(0), m_DataBufferMaxSize(0), m_TemporalMedianFilterNumOfFrames(10), m_ThresholdFilterMin(1),
+  m_ApplyMedianFilter(false), m_ApplyThresholdFilter(false), m_ApplyMaskSegmentation(false), m_ApplyBilateralFilter(false),
+m_DataBufferCurrentIndex(0), m_DataBufferMaxSize(0), m_DataBufferSize(0), m_DataBufferImageSize(0), m_TemporalMedianFilterNumOfFrames(10), m_ThresholdFilterMin(1),
 m_ThresholdFilterMax(7000), m_BilateralFilterDomainSigma(2), m_BilateralFilterRangeSigma(60), m_BilateralFilterKernelRadius(0)
 {
 }
@@ -30,10 +35,6 @@ mitk::ToFCompositeFilter::~ToFCompositeFilter()
 {
   cvReleaseImage(&(this->m_IplDistanceImage));
   cvReleaseImage(&(this->m_IplOutputImage));
-  if (m_DataBuffer!=nullptr)
-  {
-    delete [] m_DataBuffer;
-  }
 }
 
 void mitk::ToFCompositeFilter::SetInput(  const InputImageType* distanceImage )
@@ -242,75 +243,109 @@ void mitk::ToFCompositeFilter::ProcessStreamedQuickSelectMedianImageFilter(IplIm
   float* data = (float*)inputIplImage->imageData;
 
   int imageSize = inputIplImage->width * inputIplImage->height;
-  float* tmpArray;
 
-  if (this->m_TemporalMedianFilterNumOfFrames == 0)
+  if (this->m_TemporalMedianFilterNumOfFrames <= 0)
   {
     return;
   }
 
-  if (m_TemporalMedianFilterNumOfFrames != this->m_DataBufferMaxSize) // reset
+  // reset if the number of frames or the image size changed
+  if (m_TemporalMedianFilterNumOfFrames != this->m_DataBufferMaxSize || imageSize != this->m_DataBufferImageSize)
   {
-    //delete current buffer
-    for( int i=0; i<this->m_DataBufferMaxSize; i++ ) {
-      delete[] this->m_DataBuffer[i];
-    }
-    if (this->m_DataBuffer != nullptr)
-    {
-      delete[] this->m_DataBuffer;
-    }
-
     this->m_DataBufferMaxSize = m_TemporalMedianFilterNumOfFrames;
+    this->m_DataBufferImageSize = imageSize;
 
     // create new buffer with current size
-    this->m_DataBuffer = new float*[this->m_DataBufferMaxSize];
-    for(int i=0; i<this->m_DataBufferMaxSize; i++)
-    {
-      this->m_DataBuffer[i] = nullptr;
-    }
+    const std::size_t bufferSize = static_cast<std::size_t>(imageSize) * this->m_DataBufferMaxSize;
+    this->m_DataBuffer.assign(bufferSize, 0.0f);
+    this->m_SortedDataBuffer.assign(bufferSize, 0.0f);
+    this->m_DataBufferSums.assign(imageSize, 0.0);
     this->m_DataBufferCurrentIndex = 0;
+    this->m_DataBufferSize = 0;
   }
 
-  int currentBufferSize = this->m_DataBufferMaxSize;
-  tmpArray = new float[this->m_DataBufferMaxSize];
-
-  // copy data to buffer
-  if (this->m_DataBuffer[this->m_DataBufferCurrentIndex] == nullptr)
+  // the oldest value of each pixel is replaced once the buffer is full
+  const bool replaceOldestValue = this->m_DataBufferSize == this->m_DataBufferMaxSize;
+  if (!replaceOldestValue)
   {
-    this->m_DataBuffer[this->m_DataBufferCurrentIndex] = new float[imageSize];
-    currentBufferSize = this->m_DataBufferCurrentIndex + 1;
+    ++this->m_DataBufferSize;
   }
 
-  for(int j=0; j<imageSize; j++)
-  {
-    this->m_DataBuffer[this->m_DataBufferCurrentIndex][j] = data[j];
-  }
+  const int maxSize = this->m_DataBufferMaxSize;
+  const int currentBufferSize = this->m_DataBufferSize;
+  const int currentIndex = this->m_DataBufferCurrentIndex;
+  const bool applyAverageFilter = m_ApplyAverageFilter;
+  const bool applyTemporalMedianFilter = m_ApplyTemporalMedianFilter;
 
-  float tmpValue = 0.0f;
-  for(int i=0; i<imageSize; i++)
-  {
-    if (m_ApplyAverageFilter)
+  auto processPixels = [&](int begin, int end) {
+    for (int i = begin; i < end; i++)
     {
-      tmpValue = 0.0f;
-      for(int j=0; j<currentBufferSize; j++)
+      float* values = &this->m_DataBuffer[static_cast<std::size_t>(i) * maxSize];
+      float* sortedValues = &this->m_SortedDataBuffer[static_cast<std::size_t>(i) * maxSize];
+      const float newValue = data[i];
+
+      int numberOfSortedValues = currentBufferSize - 1;
+      if (replaceOldestValue)
+      {
+        const float oldValue = values[currentIndex];
+        this->m_DataBufferSums[i] -= oldValue;
+
+        // remove the oldest value, compare bitwise so that NaN values are found as well
+        float* sortedEnd = sortedValues + numberOfSortedValues + 1;
+        float* position = std::lower_bound(sortedValues, sortedEnd, oldValue);
+        if (position == sortedEnd || std::memcmp(position, &oldValue, sizeof(float)) != 0)
+        {
+          position = std::find_if(sortedValues, sortedEnd, [&oldValue](const float& value) {
+            return std::memcmp(&value, &oldValue, sizeof(float)) == 0;
+          });
+        }
+        std::copy(position + 1, sortedEnd, position);
+      }
+
+      // insert the new value
+      values[currentIndex] = newValue;
+      this->m_DataBufferSums[i] += newValue;
+
+      float* position = std::upper_bound(sortedValues, sortedValues + numberOfSortedValues, newValue);
+      std::copy_backward(position, sortedValues + numberOfSortedValues, sortedValues + numberOfSortedValues + 1);
+      *position = newValue;
+
+      if (applyAverageFilter)
       {
-          tmpValue+=this->m_DataBuffer[j][i];
+        data[i] = static_cast<float>(this->m_DataBufferSums[i] / currentBufferSize);
       }
-      data[i] = tmpValue/currentBufferSize;
-    }
-    else if (m_ApplyTemporalMedianFilter)
-    {
-      for(int j=0; j<currentBufferSize; j++)
+      else if (applyTemporalMedianFilter)
       {
-        tmpArray[j] = this->m_DataBuffer[j][i];
+        data[i] = sortedValues[(currentBufferSize - 1) / 2];
       }
-      data[i] = quick_select(tmpArray, currentBufferSize);
     }
+  };
+
+  const int pixelsPerTask = 4096;
+  const int numberOfTasks = (imageSize + pixelsPerTask - 1) / pixelsPerTask;
+  std::atomic<int> nextTask(0);
+
+  auto worker = [&]() {
+    for (int task = nextTask++; task < numberOfTasks; task = nextTask++)
+    {
+      processPixels(task * pixelsPerTask, std::min(imageSize, (task + 1) * pixelsPerTask));
+    }
+  };
+
+  std::vector<std::thread> threads;
+  const int numberOfThreads = std::min<int>(std::max(1u, std::thread::hardware_concurrency()), numberOfTasks);
+  for (int i = 1; i < numberOfThreads; i++)
+  {
+    threads.emplace_back(worker);
   }
+  worker();
 
-  this->m_DataBufferCurrentIndex = (this->m_DataBufferCurrentIndex + 1) % this->m_DataBufferMaxSize;
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
 
-  delete[] tmpArray;
+  this->m_DataBufferCurrentIndex = (this->m_DataBufferCurrentIndex + 1) % this->m_DataBufferMaxSize;
 }
 
 #define ELEM_SWAP(a,b) { register float t=(a);(a)=(b);(b)=t; }
@@ -18,6 +18,8 @@ found in the LICENSE file.
 #include <itkBilateralImageFilter.h>
 #include "opencv2/core.hpp"
 
+#include <vector>
+
 typedef itk::Image<float, 2> ItkImageType2D;
 typedef itk::Image<float, 3> ItkImageType3D;
 typedef itk::BilateralImageFilter<ItkImageType2D,ItkImageType2D> BilateralFilterType;
@@ -147,6 +149,9 @@ namespace mitk
     void ProcessCVMedianFilter(IplImage* inputIplImage, IplImage* outputIplImage, int radius = 3);
     /*!
     \brief Performs temporal median filter on an image given the number of frames to be considered
+    The last values of each pixel are kept sorted, so a new frame only replaces the oldest value of each pixel
+    (found by binary search) instead of selecting the median from the whole history again. The temporal average
+    is updated the same way from a running sum. The pixels are processed in parallel.
     */
     void ProcessStreamedQuickSelectMedianImageFilter(IplImage* inputIplImage);
     /*!
@@ -180,9 +185,13 @@ namespace mitk
     bool m_ApplyMaskSegmentation; ///< Flag indicating if a mask segmentation is performed
     bool m_ApplyBilateralFilter; ///< Flag indicating if the bilateral filter is currently active for processing the distance image
 
-    float** m_DataBuffer; ///< Buffer used for calculating the pixel-wise median over the last n (m_TemporalMedianFilterNumOfFrames) number of frames
+    std::vector<float> m_DataBuffer; ///< Ring buffer of the last n (m_TemporalMedianFilterNumOfFrames) values of each pixel, the values of a pixel are stored consecutively
+    std::vector<float> m_SortedDataBuffer; ///< The values of each pixel in m_DataBuffer in ascending order, used for the temporal median
+    std::vector<double> m_DataBufferSums; ///< Sum of the values of each pixel in m_DataBuffer, used for the temporal average
     int m_DataBufferCurrentIndex; ///< Current index in the buffer of the temporal median filter
     int m_DataBufferMaxSize; ///< Maximal size for the buffer of the temporal median filter (m_DataBuffer)
+    int m_DataBufferSize; ///< Number of frames currently contained in m_DataBuffer
+    int m_DataBufferImageSize; ///< Number of pixels of the frames contained in m_DataBuffer
 
     int m_TemporalMedianFilterNumOfFrames; ///< Number of frames to be used in the calculation of the temporal median
     int m_ThresholdFilterMin; ///< Lower threshold of the threshold filter. Pixels with values below will be assigned value 0 when applying the threshold filter
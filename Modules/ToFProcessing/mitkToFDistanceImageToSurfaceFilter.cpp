@@ -25,9 +25,52 @@ found in the LICENSE file.
 #include <vtkSmartPointer.h>
 #include <vtkIdList.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <numeric>
+#include <thread>
 #include <vtkMath.h>
 
+namespace
+{
+  enum PixelCellType : unsigned char
+  {
+    NoCell,
+    TriangleCells,
+    VertexCell
+  };
+
+  /** \brief Calls function(beginRow, endRow) for consecutive ranges of [0, numberOfRows) on a pool of threads. */
+  template <typename TFunction>
+  void ParallelForRows(int numberOfRows, const TFunction& function)
+  {
+    const int rowsPerTask = 8;
+    const int numberOfTasks = (numberOfRows + rowsPerTask - 1) / rowsPerTask;
+    std::atomic<int> nextTask(0);
+
+    auto worker = [&]() {
+      for (int task = nextTask++; task < numberOfTasks; task = nextTask++)
+      {
+        function(task * rowsPerTask, std::min(numberOfRows, (task + 1) * rowsPerTask));
+      }
+    };
+
+    std::vector<std::thread> threads;
+    const int numberOfThreads = std::min<int>(std::max(1u, std::thread::hardware_concurrency()), numberOfTasks);
+    for (int i = 1; i < numberOfThreads; i++)
+    {
+      threads.emplace_back(worker);
+    }
+    worker();
+
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+  }
+}
+
 mitk::ToFDistanceImageToSurfaceFilter::ToFDistanceImageToSurfaceFilter() :
   m_IplScalarImage(nullptr), m_CameraIntrinsics(), m_TextureImageWidth(0), m_TextureImageHeight(0), m_InterPixelDistance(), m_TextureIndex(0),
   m_GenerateTriangularMesh(true), m_TriangulationThreshold(0.0)
@@ -95,27 +138,29 @@ void mitk::ToFDistanceImageToSurfaceFilter::GenerateData()
   int xDimension = input->GetDimension(0);
   int yDimension = input->GetDimension(1);
   unsigned int size = xDimension*yDimension; //size of the image-array
-  std::vector<bool> isPointValid;
-  isPointValid.resize(size);
-  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
-  points->SetDataTypeToDouble();
-  vtkSmartPointer<vtkCellArray> polys = vtkSmartPointer<vtkCellArray>::New();
-  vtkSmartPointer<vtkCellArray> vertices = vtkSmartPointer<vtkCellArray>::New();
-  vtkSmartPointer<vtkFloatArray> scalarArray = vtkSmartPointer<vtkFloatArray>::New();
-  vtkSmartPointer<vtkFloatArray> textureCoords = vtkSmartPointer<vtkFloatArray>::New();
-  textureCoords->SetNumberOfComponents(2);
-  textureCoords->Allocate(size);
-
-  //Make a vtkIdList to save the ID's of the polyData corresponding to the image
-  //pixel ID's. See below for more documentation.
-  m_VertexIdList = vtkSmartPointer<vtkIdList>::New();
-  //Allocate the object once else it would automatically allocate new memory
-  //for every vertex and perform a copy which is expensive.
-  m_VertexIdList->Allocate(size);
-  m_VertexIdList->SetNumberOfIds(size);
-  for(unsigned int i = 0; i < size; ++i)
+
+  if (m_Mesh.GetPointer() == nullptr)
   {
-    m_VertexIdList->SetId(i, 0);
+    m_Points = vtkSmartPointer<vtkPoints>::New();
+    m_Points->SetDataTypeToDouble();
+    m_PolyIds = vtkSmartPointer<vtkIdTypeArray>::New();
+    m_VertexIds = vtkSmartPointer<vtkIdTypeArray>::New();
+    m_Polys = vtkSmartPointer<vtkCellArray>::New();
+    m_Vertices = vtkSmartPointer<vtkCellArray>::New();
+    m_ScalarArray = vtkSmartPointer<vtkFloatArray>::New();
+    m_TextureCoords = vtkSmartPointer<vtkFloatArray>::New();
+    m_TextureCoords->SetNumberOfComponents(2);
+
+    m_Mesh = vtkSmartPointer<vtkPolyData>::New();
+    m_Mesh->SetPoints(m_Points);
+    m_Mesh->SetPolys(m_Polys);
+    m_Mesh->SetVerts(m_Vertices);
+    //Pass the TextureCoords to the polydata anyway (to save them).
+    m_Mesh->GetPointData()->SetTCoords(m_TextureCoords);
+
+    //Make a vtkIdList to save the ID's of the polyData corresponding to the image
+    //pixel ID's. See below for more documentation.
+    m_VertexIdList = vtkSmartPointer<vtkIdList>::New();
   }
 
   float* scalarFloatData = nullptr;
@@ -150,9 +195,8 @@ void mitk::ToFDistanceImageToSurfaceFilter::GenerateData()
   }
   else
   {
-    focalLengthInPixelUnits[0] = 0.0;
-    focalLengthInPixelUnits[1] = 0.0;
-    focalLengthInMm = 0.0;
+    MITK_ERROR << "Incorrect reconstruction mode!";
+    return;
   }
 
   mitk::ToFProcessingCommon::ToFPoint2D principalPoint;
@@ -162,149 +206,258 @@ void mitk::ToFDistanceImageToSurfaceFilter::GenerateData()
   mitk::Point3D origin = input->GetGeometry()->GetOrigin();
   mitk::Vector3D spacing = input->GetGeometry()->GetSpacing();
 
-  for (int j=0; j<yDimension; j++)
+  //Epsilon here, because we may have small float values like 0.00000001 which in fact represents 0.
+  auto isPointValid = [inputFloatData](unsigned int pixelID) { return inputFloatData[pixelID] > mitk::eps; };
+
+  //The points are stored in the order of the valid pixels. Counting the valid pixels of each row first gives the
+  //id of the first point of each row, so all rows can be converted in parallel afterwards.
+  m_RowPointOffsets.resize(yDimension + 1);
+  m_RowPointOffsets[0] = 0;
+  ParallelForRows(yDimension, [&](int beginRow, int endRow) {
+    for (int j = beginRow; j < endRow; j++)
+    {
+      vtkIdType numberOfValidPixels = 0;
+      for (int i = 0; i < xDimension; i++)
+      {
+        if (isPointValid(i + j*xDimension))
+        {
+          numberOfValidPixels++;
+        }
+      }
+      m_RowPointOffsets[j + 1] = numberOfValidPixels;
+    }
+  });
+  std::partial_sum(m_RowPointOffsets.begin(), m_RowPointOffsets.end(), m_RowPointOffsets.begin());
+  const vtkIdType numberOfPoints = m_RowPointOffsets[yDimension];
+
+  //The arrays of the previous frame are overwritten. VTK only reallocates them if they have to grow.
+  m_Points->SetNumberOfPoints(numberOfPoints);
+  double* pointData = static_cast<double*>(m_Points->GetVoidPointer(0));
+  m_TextureCoords->SetNumberOfTuples(numberOfPoints);
+  float* textureCoordsData = m_TextureCoords->GetPointer(0);
+  float* scalarArrayData = nullptr;
+  if (scalarFloatData)
   {
-    for (int i=0; i<xDimension; i++)
+    m_ScalarArray->SetNumberOfTuples(numberOfPoints);
+    scalarArrayData = m_ScalarArray->GetPointer(0);
+  }
+  //VTK would insert empty points into the polydata if we would store the points
+  //at their pixel ID's. Because only the valid pixels are stored, the ID's do not
+  //correspond to the image pixel ID's. Thus, we have to save them in the vertexIdList.
+  m_VertexIdList->SetNumberOfIds(size);
+  vtkIdType* vertexIdData = m_VertexIdList->GetPointer(0);
+
+  ParallelForRows(yDimension, [&](int beginRow, int endRow) {
+    for (int j = beginRow; j < endRow; j++)
     {
-      unsigned int pixelID = i+j*xDimension;
+      vtkIdType pointID = m_RowPointOffsets[j];
+      for (int i = 0; i < xDimension; i++)
+      {
+        unsigned int pixelID = i+j*xDimension;
 
-      mitk::ToFProcessingCommon::ToFScalarType distance = (double)inputFloatData[pixelID];
+        if (!isPointValid(pixelID))
+        {
+          vertexIdData[pixelID] = 0;
+          continue;
+        }
 
-      /** Here we have to incorporate spacing and origin to allow processing of cropped/resampled images
-      * Usually origin will be [0, 0, 0] and spacing will be [1, 1, 1], but just in case the image is moved
-      * due to cropping or the spacing differes due to up- or downsampling.*/
-      unsigned int completeIndexX = i*spacing[0]+origin[0];
-      unsigned int completeIndexY = j*spacing[1]+origin[1];
+        mitk::ToFProcessingCommon::ToFScalarType distance = (double)inputFloatData[pixelID];
 
-      mitk::ToFProcessingCommon::ToFPoint3D cartesianCoordinates;
-      switch (m_ReconstructionMode)
-      {
-      case WithOutInterPixelDistance:
-      {
-        cartesianCoordinates = mitk::ToFProcessingCommon::IndexToCartesianCoordinates(completeIndexX,completeIndexY,distance,focalLengthInPixelUnits,principalPoint);
-        break;
-      }
-      case WithInterPixelDistance:
-      {
-        cartesianCoordinates = mitk::ToFProcessingCommon::IndexToCartesianCoordinatesWithInterpixdist(completeIndexX,completeIndexY,distance,focalLengthInMm,m_InterPixelDistance,principalPoint);
-        break;
-      }
-      case Kinect:
-      {
-        cartesianCoordinates = mitk::ToFProcessingCommon::KinectIndexToCartesianCoordinates(completeIndexX,completeIndexY,distance,focalLengthInPixelUnits,principalPoint);
-        break;
-      }
-      default:
-      {
-        MITK_ERROR << "Incorrect reconstruction mode!";
-      }
-      }
-      //Epsilon here, because we may have small float values like 0.00000001 which in fact represents 0.
-      if (distance<=mitk::eps)
-      {
-        isPointValid[pixelID] = false;
+        /** Here we have to incorporate spacing and origin to allow processing of cropped/resampled images
+        * Usually origin will be [0, 0, 0] and spacing will be [1, 1, 1], but just in case the image is moved
+        * due to cropping or the spacing differes due to up- or downsampling.*/
+        unsigned int completeIndexX = i*spacing[0]+origin[0];
+        unsigned int completeIndexY = j*spacing[1]+origin[1];
+
+        mitk::ToFProcessingCommon::ToFPoint3D cartesianCoordinates;
+        switch (m_ReconstructionMode)
+        {
+        case WithOutInterPixelDistance:
+        {
+          cartesianCoordinates = mitk::ToFProcessingCommon::IndexToCartesianCoordinates(completeIndexX,completeIndexY,distance,focalLengthInPixelUnits,principalPoint);
+          break;
+        }
+        case WithInterPixelDistance:
+        {
+          cartesianCoordinates = mitk::ToFProcessingCommon::IndexToCartesianCoordinatesWithInterpixdist(completeIndexX,completeIndexY,distance,focalLengthInMm,m_InterPixelDistance,principalPoint);
+          break;
+        }
+        default:
+        {
+          cartesianCoordinates = mitk::ToFProcessingCommon::KinectIndexToCartesianCoordinates(completeIndexX,completeIndexY,distance,focalLengthInPixelUnits,principalPoint);
+        }
+        }
+
+        std::copy(cartesianCoordinates.GetDataPointer(), cartesianCoordinates.GetDataPointer() + 3, pointData + 3*pointID);
+        vertexIdData[pixelID] = pointID;
+
+        //Scalar values are necessary for mapping colors/texture onto the surface
+        if (scalarArrayData)
+        {
+          scalarArrayData[pointID] = scalarFloatData[pixelID];
+        }
+        //These Texture Coordinates will map color pixel and vertices 1:1 (e.g. for Kinect).
+        textureCoordsData[2*pointID] = ((float)i)/xDimension;// correct video texture scale for kinect
+        textureCoordsData[2*pointID+1] = ((float)j)/yDimension; //don't flip. we don't need to flip.
+
+        pointID++;
       }
-      else
+    }
+  });
+
+  //The cells are generated in two passes as well: the first one decides which cells are generated at each pixel and
+  //counts them per row, the second one writes them into the connectivity arrays of the cell arrays.
+  m_PixelCells.resize(size);
+  m_RowQuadOffsets.resize(yDimension + 1);
+  m_RowVertexOffsets.resize(yDimension + 1);
+  m_RowQuadOffsets[0] = 0;
+  m_RowVertexOffsets[0] = 0;
+  ParallelForRows(yDimension, [&](int beginRow, int endRow) {
+    for (int j = beginRow; j < endRow; j++)
+    {
+      vtkIdType numberOfQuads = 0;
+      vtkIdType numberOfVertices = 0;
+      for (int i = 0; i < xDimension; i++)
       {
-        isPointValid[pixelID] = true;
-        //VTK would insert empty points into the polydata if we use
-        //points->InsertPoint(pixelID, cartesianCoordinates.GetDataPointer()).
-        //If we use points->InsertNextPoint(...) instead, the ID's do not
-        //correspond to the image pixel ID's. Thus, we have to save them
-        //in the vertexIdList.
-        m_VertexIdList->SetId(pixelID, points->InsertNextPoint(cartesianCoordinates.GetDataPointer()));
-
-        if (m_GenerateTriangularMesh)
+        unsigned int pixelID = i+j*xDimension;
+        m_PixelCells[pixelID] = NoCell;
+
+        if (!isPointValid(pixelID))
+        {
+          continue;
+        }
+
+        if (!m_GenerateTriangularMesh)
+        {
+          //We dont want triangulation, we only want vertices
+          m_PixelCells[pixelID] = VertexCell;
+          numberOfVertices++;
+          continue;
+        }
+
+        //This little piece of art explains the ID's:
+        //
+        // P(x_1y_1)---P(xy_1)
+        // |           |
+        // |           |
+        // |           |
+        // P(x_1y)-----P(xy)
+        //
+        //We can only start triangulation if we are at vertex (1,1),
+        //because we need the other 3 vertices near this one.
+        //To go one pixel line back in the image array, we have to
+        //subtract 1x xDimension.
+        if ((i < 1) || (j < 1))
         {
-          if((i >= 1) && (j >= 1))
+          continue;
+        }
+
+        vtkIdType xy = pixelID;
+        vtkIdType x_1y = pixelID-1;
+        vtkIdType xy_1 = pixelID-xDimension;
+        vtkIdType x_1y_1 = xy_1-1;
+
+        if (isPointValid(x_1y)&&isPointValid(x_1y_1)&&isPointValid(xy_1)) // check if points of cell are valid
+        {
+          //Find the corresponding vertex ID's in the saved vertexIdList:
+          const double* pointXY = pointData + 3*vertexIdData[xy];
+          const double* pointX_1Y = pointData + 3*vertexIdData[x_1y];
+          const double* pointXY_1 = pointData + 3*vertexIdData[xy_1];
+          const double* pointX_1Y_1 = pointData + 3*vertexIdData[x_1y_1];
+
+          if( (mitk::Equal(m_TriangulationThreshold, 0.0)) || ((vtkMath::Distance2BetweenPoints(pointXY, pointX_1Y) <= m_TriangulationThreshold)
+                                                               && (vtkMath::Distance2BetweenPoints(pointXY, pointXY_1) <= m_TriangulationThreshold)
+                                                               && (vtkMath::Distance2BetweenPoints(pointX_1Y, pointX_1Y_1) <= m_TriangulationThreshold)
+                                                               && (vtkMath::Distance2BetweenPoints(pointXY_1, pointX_1Y_1) <= m_TriangulationThreshold)))
+          {
+            m_PixelCells[pixelID] = TriangleCells;
+            numberOfQuads++;
+          }
+          else
           {
-            //This little piece of art explains the ID's:
-            //
-            // P(x_1y_1)---P(xy_1)
-            // |           |
-            // |           |
-            // |           |
-            // P(x_1y)-----P(xy)
-            //
-            //We can only start triangulation if we are at vertex (1,1),
-            //because we need the other 3 vertices near this one.
-            //To go one pixel line back in the image array, we have to
-            //subtract 1x xDimension.
-            vtkIdType xy = pixelID;
-            vtkIdType x_1y = pixelID-1;
-            vtkIdType xy_1 = pixelID-xDimension;
-            vtkIdType x_1y_1 = xy_1-1;
-
-            //Find the corresponding vertex ID's in the saved vertexIdList:
-            vtkIdType xyV = m_VertexIdList->GetId(xy);
-            vtkIdType x_1yV = m_VertexIdList->GetId(x_1y);
-            vtkIdType xy_1V = m_VertexIdList->GetId(xy_1);
-            vtkIdType x_1y_1V = m_VertexIdList->GetId(x_1y_1);
-
-            if (isPointValid[xy]&&isPointValid[x_1y]&&isPointValid[x_1y_1]&&isPointValid[xy_1]) // check if points of cell are valid
-            {
-              double pointXY[3], pointX_1Y[3], pointXY_1[3], pointX_1Y_1[3];
-
-              points->GetPoint(xyV, pointXY);
-              points->GetPoint(x_1yV, pointX_1Y);
-              points->GetPoint(xy_1V, pointXY_1);
-              points->GetPoint(x_1y_1V, pointX_1Y_1);
-
-              if( (mitk::Equal(m_TriangulationThreshold, 0.0)) || ((vtkMath::Distance2BetweenPoints(pointXY, pointX_1Y) <= m_TriangulationThreshold)
-                                                                   && (vtkMath::Distance2BetweenPoints(pointXY, pointXY_1) <= m_TriangulationThreshold)
-                                                                   && (vtkMath::Distance2BetweenPoints(pointX_1Y, pointX_1Y_1) <= m_TriangulationThreshold)
-                                                                   && (vtkMath::Distance2BetweenPoints(pointXY_1, pointX_1Y_1) <= m_TriangulationThreshold)))
-              {
-                polys->InsertNextCell(3);
-                polys->InsertCellPoint(x_1yV);
-                polys->InsertCellPoint(xyV);
-                polys->InsertCellPoint(x_1y_1V);
-
-                polys->InsertNextCell(3);
-                polys->InsertCellPoint(x_1y_1V);
-                polys->InsertCellPoint(xyV);
-                polys->InsertCellPoint(xy_1V);
-              }
-              else
-              {
-                //We dont want triangulation, but we want to keep the vertex
-                vertices->InsertNextCell(1);
-                vertices->InsertCellPoint(xyV);
-              }
-            }
+            //We dont want triangulation, but we want to keep the vertex
+            m_PixelCells[pixelID] = VertexCell;
+            numberOfVertices++;
           }
         }
-        else
+      }
+      m_RowQuadOffsets[j + 1] = numberOfQuads;
+      m_RowVertexOffsets[j + 1] = numberOfVertices;
+    }
+  });
+  std::partial_sum(m_RowQuadOffsets.begin(), m_RowQuadOffsets.end(), m_RowQuadOffsets.begin());
+  std::partial_sum(m_RowVertexOffsets.begin(), m_RowVertexOffsets.end(), m_RowVertexOffsets.begin());
+  const vtkIdType numberOfQuads = m_RowQuadOffsets[yDimension];
+  const vtkIdType numberOfVertices = m_RowVertexOffsets[yDimension];
+
+  //Every quad consists of two triangles with 3 ids each, every vertex of one id. Each cell is preceded by its size.
+  m_PolyIds->SetNumberOfValues(8*numberOfQuads);
+  m_VertexIds->SetNumberOfValues(2*numberOfVertices);
+  vtkIdType* polyIdData = m_PolyIds->GetPointer(0);
+  vtkIdType* vertexCellData = m_VertexIds->GetPointer(0);
+
+  ParallelForRows(yDimension, [&](int beginRow, int endRow) {
+    for (int j = beginRow; j < endRow; j++)
+    {
+      vtkIdType* polyIds = polyIdData + 8*m_RowQuadOffsets[j];
+      vtkIdType* vertexIds = vertexCellData + 2*m_RowVertexOffsets[j];
+      for (int i = 0; i < xDimension; i++)
+      {
+        unsigned int pixelID = i+j*xDimension;
+        if (m_PixelCells[pixelID] == TriangleCells)
         {
-          //We dont want triangulation, we only want vertices
-          vertices->InsertNextCell(1);
-          vertices->InsertCellPoint(m_VertexIdList->GetId(pixelID));
+          vtkIdType xyV = vertexIdData[pixelID];
+          vtkIdType x_1yV = vertexIdData[pixelID-1];
+          vtkIdType xy_1V = vertexIdData[pixelID-xDimension];
+          vtkIdType x_1y_1V = vertexIdData[pixelID-xDimension-1];
+
+          *polyIds++ = 3;
+          *polyIds++ = x_1yV;
+          *polyIds++ = xyV;
+          *polyIds++ = x_1y_1V;
+
+          *polyIds++ = 3;
+          *polyIds++ = x_1y_1V;
+          *polyIds++ = xyV;
+          *polyIds++ = xy_1V;
         }
-        //Scalar values are necessary for mapping colors/texture onto the surface
-        if (scalarFloatData)
+        else if (m_PixelCells[pixelID] == VertexCell)
         {
-          scalarArray->InsertTuple1(m_VertexIdList->GetId(pixelID), scalarFloatData[pixelID]);
+          *vertexIds++ = 1;
+          *vertexIds++ = vertexIdData[pixelID];
         }
-        //These Texture Coordinates will map color pixel and vertices 1:1 (e.g. for Kinect).
-        float xNorm = (((float)i)/xDimension);// correct video texture scale for kinect
-        float yNorm = ((float)j)/yDimension; //don't flip. we don't need to flip.
-        textureCoords->InsertTuple2(m_VertexIdList->GetId(pixelID), xNorm, yNorm);
       }
     }
-  }
+  });
 
-  vtkSmartPointer<vtkPolyData> mesh = vtkSmartPointer<vtkPolyData>::New();
-  mesh->SetPoints(points);
-  mesh->SetPolys(polys);
-  mesh->SetVerts(vertices);
+  m_Polys->SetCells(2*numberOfQuads, m_PolyIds);
+  m_Vertices->SetCells(numberOfVertices, m_VertexIds);
+  m_Points->Modified();
+  m_TextureCoords->Modified();
+  m_VertexIdList->Modified();
   //Pass the scalars to the polydata (if they were set).
-  if (scalarArray->GetNumberOfTuples()>0)
+  if (scalarArrayData && numberOfPoints > 0)
+  {
+    m_ScalarArray->Modified();
+    m_Mesh->GetPointData()->SetScalars(m_ScalarArray);
+  }
+  else
+  {
+    m_Mesh->GetPointData()->SetScalars(nullptr);
+  }
+  //The cell links of the last frame do not match the new cells anymore
+  m_Mesh->DeleteCells();
+  m_Mesh->Modified();
+
+  if (output->GetVtkPolyData() != m_Mesh.GetPointer())
+  {
+    output->SetVtkPolyData(m_Mesh);
+  }
+  else
   {
-    mesh->GetPointData()->SetScalars(scalarArray);
+    output->CalculateBoundingBox();
+    output->Modified();
   }
-  //Pass the TextureCoords to the polydata anyway (to save them).
-  mesh->GetPointData()->SetTCoords(textureCoords);
-  output->SetVtkPolyData(mesh);
 }
 
 void mitk::ToFDistanceImageToSurfaceFilter::CreateOutputsForAllInputs()
@@ -23,6 +23,13 @@ found in the LICENSE file.
 
 #include <vtkSmartPointer.h>
 #include <vtkIdList.h>
+#include <vtkCellArray.h>
+#include <vtkFloatArray.h>
+#include <vtkIdTypeArray.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+
+#include <vector>
 
 namespace mitk
 {
@@ -184,6 +191,25 @@ namespace mitk
 
     double m_TriangulationThreshold;
 
+    /*!
+    \brief The polydata of the output and its arrays, which are kept between the frames. A new frame overwrites
+    the arrays in place (they are only reallocated if a frame has more points or cells than all frames before)
+    and the output surface keeps the same polydata, so streams do not allocate new VTK objects for each frame.
+    */
+    vtkSmartPointer<vtkPolyData> m_Mesh;
+    vtkSmartPointer<vtkPoints> m_Points;
+    vtkSmartPointer<vtkCellArray> m_Polys;
+    vtkSmartPointer<vtkCellArray> m_Vertices;
+    vtkSmartPointer<vtkIdTypeArray> m_PolyIds; ///< Connectivity of m_Polys in the VTK cell array layout (n, id_1, ..., id_n)
+    vtkSmartPointer<vtkIdTypeArray> m_VertexIds; ///< Connectivity of m_Vertices in the VTK cell array layout
+    vtkSmartPointer<vtkFloatArray> m_ScalarArray;
+    vtkSmartPointer<vtkFloatArray> m_TextureCoords;
+
+    std::vector<unsigned char> m_PixelCells; ///< Cells generated at each pixel (none, two triangles or a vertex)
+    std::vector<vtkIdType> m_RowPointOffsets; ///< Id of the first point of each image row
+    std::vector<vtkIdType> m_RowQuadOffsets; ///< Number of triangle pairs generated before each image row
+    std::vector<vtkIdType> m_RowVertexOffsets; ///< Number of vertex cells generated before each image row
+
   };
 } //END mitk namespace
 #endif
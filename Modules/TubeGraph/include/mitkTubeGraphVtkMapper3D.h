@@ -25,6 +25,7 @@ found in the LICENSE file.
 #include <vtkAppendPolyData.h>
 #include <vtkAssembly.h>
 #include <vtkPolyData.h>
+#include <vtkPolyDataMapper.h>
 #include <vtkSmartPointer.h>
 
 namespace mitk
@@ -33,6 +34,11 @@ namespace mitk
   * 3D Mapper for mitk::Graph< TubeGraphVertex, TubeGraphEdge >. This mapper creates tubes
   * around each tubular structure by using vtkTubeFilter.
   *
+  * The geometry of all visible tubes and furcations is merged into one poly data, which is
+  * rendered by a single actor and colored by point scalars. The geometry is only generated new
+  * if the tube graph changes. If only the tube graph property changes (e.g. the selection of a
+  * tube), the colors of the tubes whose color changed are updated in place; the merged poly data
+  * is only assembled new if the visibility of a tube changed.
   */
 
   class MITKTUBEGRAPH_EXPORT TubeGraphVtkMapper3D : public VtkMapper
@@ -72,7 +78,8 @@ namespace mitk
     virtual void GenerateTubeGraphData(mitk::BaseRenderer *renderer);
 
     /**
-    * Render only the visual information like color or visibility new.
+    * Render only the visual information like color or visibility new. Only the tubes whose
+    * color or visibility changed since the last call are updated.
     */
     virtual void RenderTubeGraphPropertyInformation(mitk::BaseRenderer *renderer);
 
@@ -95,17 +102,57 @@ namespace mitk
   private:
     bool ClipStructures();
 
+    /**
+    * Assembles the merged poly data from the visible tubes and the spheres at their ends.
+    */
+    void MergeVisibleStructures(mitk::BaseRenderer *renderer);
+
+    /**
+    * Color of a sphere: the mean color of the visible tubes connected to the vertex.
+    */
+    Color GetColorOfFurcation(const TubeGraph::VertexDescriptorType &vertex, mitk::BaseRenderer *renderer);
+
     class LocalStorage : public mitk::Mapper::BaseLocalStorage
     {
     public:
+      /** Range [first point id, number of points] of a structure in the merged poly data */
+      typedef std::pair<vtkIdType, vtkIdType> PointRangeType;
+
+      struct TubeState
+      {
+        Color color;
+        bool isVisible;
+      };
+
       vtkSmartPointer<vtkAssembly> m_vtkTubeGraphAssembly;
+      vtkSmartPointer<vtkActor> m_vtkMergedActor;
+      vtkSmartPointer<vtkPolyDataMapper> m_vtkMergedMapper;
+      vtkSmartPointer<vtkPolyData> m_vtkMergedPolyData;
+
+      // Generated geometry of the single tubes and furcations; these actors are not rendered
+      // themselves, their poly data are merged
       std::map<TubeGraph::TubeDescriptorType, vtkSmartPointer<vtkActor>> m_vtkTubesActorMap;
       std::map<TubeGraph::VertexDescriptorType, vtkSmartPointer<vtkActor>> m_vtkSpheresActorMap;
+      std::map<TubeGraph::VertexDescriptorType, std::vector<TubeGraph::TubeDescriptorType>> m_TubesOfVertexMap;
+
+      std::map<TubeGraph::TubeDescriptorType, TubeState> m_TubeStateMap;
+      std::map<TubeGraph::TubeDescriptorType, PointRangeType> m_TubePointRangeMap;
+      std::map<TubeGraph::VertexDescriptorType, PointRangeType> m_SpherePointRangeMap;
 
       itk::TimeStamp m_lastGenerateDataTime;
       itk::TimeStamp m_lastRenderDataTime;
 
-      LocalStorage() { m_vtkTubeGraphAssembly = vtkSmartPointer<vtkAssembly>::New(); }
+      LocalStorage()
+      {
+        m_vtkTubeGraphAssembly = vtkSmartPointer<vtkAssembly>::New();
+        m_vtkMergedActor = vtkSmartPointer<vtkActor>::New();
+        m_vtkMergedMapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+        m_vtkMergedPolyData = vtkSmartPointer<vtkPolyData>::New();
+
+        m_vtkMergedMapper->SetInputData(m_vtkMergedPolyData);
+        m_vtkMergedActor->SetMapper(m_vtkMergedMapper);
+        m_vtkTubeGraphAssembly->AddPart(m_vtkMergedActor);
+      }
       ~LocalStorage() override {}
     };
 
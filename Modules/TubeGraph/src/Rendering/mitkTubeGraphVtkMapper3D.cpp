@@ -14,6 +14,8 @@ found in the LICENSE file.
 
 #include <mitkColorProperty.h>
 
+#include <set>
+
 #include <vtkCellArray.h>
 #include <vtkClipPolyData.h>
 #include <vtkContourFilter.h>
@@ -31,6 +33,7 @@ found in the LICENSE file.
 #include <vtkSampleFunction.h>
 #include <vtkSphereSource.h>
 #include <vtkTubeFilter.h>
+#include <vtkUnsignedCharArray.h>
 #include <vtkUnsignedIntArray.h>
 
 mitk::TubeGraphVtkMapper3D::TubeGraphVtkMapper3D()
@@ -53,7 +56,6 @@ vtkProp *mitk::TubeGraphVtkMapper3D::GetVtkProp(mitk::BaseRenderer *renderer)
 
 void mitk::TubeGraphVtkMapper3D::GenerateDataForRenderer(mitk::BaseRenderer *renderer)
 {
-  bool renderTubeGraph(false);
   LocalStorage *ls = m_LSH.GetLocalStorage(renderer);
 
   TubeGraph::Pointer tubeGraph = const_cast<mitk::TubeGraph *>(this->GetInput());
@@ -69,7 +71,7 @@ void mitk::TubeGraphVtkMapper3D::GenerateDataForRenderer(mitk::BaseRenderer *ren
   if (tubeGraph->GetMTime() > ls->m_lastGenerateDataTime)
   {
     this->GenerateTubeGraphData(renderer);
-    renderTubeGraph = true;
+    this->RenderTubeGraphPropertyInformation(renderer);
   }
   else
   {
@@ -78,48 +80,6 @@ void mitk::TubeGraphVtkMapper3D::GenerateDataForRenderer(mitk::BaseRenderer *ren
     if (tubeGraphProperty->GetMTime() > ls->m_lastRenderDataTime)
     {
       this->RenderTubeGraphPropertyInformation(renderer);
-      renderTubeGraph = true;
-    }
-  }
-
-  if (renderTubeGraph)
-  {
-    std::vector<TubeGraph::VertexDescriptorType> alreadyRenderedVertexList;
-    // don't render the sphere which is the root of the graph; so add it to the list before;
-    // TODO check both spheres
-    TubeGraph::VertexDescriptorType root = tubeGraph->GetRootVertex();
-    alreadyRenderedVertexList.push_back(root);
-
-    for (auto itTubes =
-           ls->m_vtkTubesActorMap.begin();
-         itTubes != ls->m_vtkTubesActorMap.end();
-         itTubes++)
-    {
-      if (tubeGraphProperty->IsTubeVisible(itTubes->first))
-      {
-        // add tube actor to assembly
-        ls->m_vtkTubeGraphAssembly->AddPart(itTubes->second);
-
-        // render the clipped spheres as end-cups of a tube and connections between tubes
-        if (std::find(alreadyRenderedVertexList.begin(), alreadyRenderedVertexList.end(), itTubes->first.first) ==
-            alreadyRenderedVertexList.end())
-        {
-          auto itSourceSphere =
-            ls->m_vtkSpheresActorMap.find(itTubes->first.first);
-          if (itSourceSphere != ls->m_vtkSpheresActorMap.end())
-            ls->m_vtkTubeGraphAssembly->AddPart(itSourceSphere->second);
-          alreadyRenderedVertexList.push_back(itSourceSphere->first);
-        }
-        if (std::find(alreadyRenderedVertexList.begin(), alreadyRenderedVertexList.end(), itTubes->first.second) ==
-            alreadyRenderedVertexList.end())
-        {
-          auto itTargetSphere =
-            ls->m_vtkSpheresActorMap.find(itTubes->first.second);
-          if (itTargetSphere != ls->m_vtkSpheresActorMap.end())
-            ls->m_vtkTubeGraphAssembly->AddPart(itTargetSphere->second);
-          alreadyRenderedVertexList.push_back(itTargetSphere->first);
-        }
-      }
     }
   }
 
@@ -127,13 +87,12 @@ void mitk::TubeGraphVtkMapper3D::GenerateDataForRenderer(mitk::BaseRenderer *ren
   //{
   //  float opacity = 1.0f;
   //  if( this->GetDataNode()->GetOpacity(opacity,renderer) )
-  //    ls->m_vtkTubesActor->GetProperty()->SetOpacity( opacity );
+  //    ls->m_vtkMergedActor->GetProperty()->SetOpacity( opacity );
   //}
 }
 
 void mitk::TubeGraphVtkMapper3D::RenderTubeGraphPropertyInformation(mitk::BaseRenderer *renderer)
 {
-  MITK_INFO << "Render tube graph property information!";
   LocalStorage *ls = m_LSH.GetLocalStorage(renderer);
   TubeGraph::ConstPointer tubeGraph = this->GetInput();
   TubeGraphProperty::Pointer tubeGraphProperty =
@@ -145,72 +104,171 @@ void mitk::TubeGraphVtkMapper3D::RenderTubeGraphPropertyInformation(mitk::BaseRe
     return;
   }
 
-  std::vector<TubeGraphVertex> allVertices = tubeGraph->GetVectorOfAllVertices();
-  for (auto vertex = allVertices.begin(); vertex != allVertices.end(); ++vertex)
+  // collect the tubes whose color or visibility changed since the last call
+  bool visibilityChanged = ls->m_TubeStateMap.empty() || ls->m_TubeStateMap.size() != ls->m_vtkTubesActorMap.size();
+  std::vector<TubeGraph::TubeDescriptorType> recoloredTubes;
+  for (auto itTubes = ls->m_vtkTubesActorMap.begin(); itTubes != ls->m_vtkTubesActorMap.end(); ++itTubes)
   {
-    TubeGraph::VertexDescriptorType vertexDesc = tubeGraph->GetVertexDescriptor(*vertex);
+    LocalStorage::TubeState state;
+    state.isVisible = tubeGraphProperty->IsTubeVisible(itTubes->first);
+    state.color = tubeGraphProperty->GetColorOfTube(itTubes->first);
+
+    auto itState = ls->m_TubeStateMap.find(itTubes->first);
+    if (itState == ls->m_TubeStateMap.end())
+    {
+      ls->m_TubeStateMap.insert(std::make_pair(itTubes->first, state));
+      visibilityChanged = true;
+      continue;
+    }
 
-    double sphereColorR = 0;
-    double sphereColorG = 0;
-    double sphereColorB = 0;
+    if (itState->second.isVisible != state.isVisible)
+      visibilityChanged = true;
+    else if (state.isVisible && itState->second.color != state.color)
+      recoloredTubes.push_back(itTubes->first);
 
-    int numberOfVisibleEdges = 0;
-    std::vector<TubeGraphEdge> allEdgesOfVertex = tubeGraph->GetAllEdgesOfAVertex(vertexDesc);
-    for (auto edge = allEdgesOfVertex.begin(); edge != allEdgesOfVertex.end(); ++edge)
+    itState->second = state;
+  }
+
+  if (visibilityChanged)
+  {
+    // the set of merged structures changes, so the merged poly data has to be assembled new
+    this->MergeVisibleStructures(renderer);
+  }
+  else if (!recoloredTubes.empty())
+  {
+    auto colorScalars =
+      vtkUnsignedCharArray::SafeDownCast(ls->m_vtkMergedPolyData->GetPointData()->GetArray("colorScalars"));
+    if (colorScalars != nullptr)
     {
-      // get edge descriptor
-      EdgeDescriptorType edgeDesc = tubeGraph->GetEdgeDescriptor(*edge);
+      auto fillRange = [colorScalars](const LocalStorage::PointRangeType &range, const Color &color) {
+        for (vtkIdType id = range.first; id < range.first + range.second; ++id)
+          colorScalars->SetTuple3(id, color[0], color[1], color[2]);
+      };
 
-      // get source and target vertex descriptor
-      std::pair<TubeGraphVertex, TubeGraphVertex> soureTargetPair = tubeGraph->GetVerticesOfAnEdge(edgeDesc);
-      TubeGraphVertex source = soureTargetPair.first;
-      TubeGraphVertex target = soureTargetPair.second;
+      std::set<TubeGraph::VertexDescriptorType> affectedVertices;
+      for (const auto &tube : recoloredTubes)
+      {
+        auto itRange = ls->m_TubePointRangeMap.find(tube);
+        if (itRange != ls->m_TubePointRangeMap.end())
+          fillRange(itRange->second, ls->m_TubeStateMap[tube].color);
 
-      // build tube descriptor [sourceId,targetId]
-      TubeGraph::TubeDescriptorType tube;
-      tube.first = tubeGraph->GetVertexDescriptor(source);
-      tube.second = tubeGraph->GetVertexDescriptor(target);
+        affectedVertices.insert(tube.first);
+        affectedVertices.insert(tube.second);
+      }
 
-      if (tubeGraphProperty->IsTubeVisible(tube))
+      // the color of a sphere depends on the colors of its tubes
+      for (const auto &vertex : affectedVertices)
       {
-        mitk::Color tubeColor = tubeGraphProperty->GetColorOfTube(tube);
+        auto itRange = ls->m_SpherePointRangeMap.find(vertex);
+        if (itRange != ls->m_SpherePointRangeMap.end())
+          fillRange(itRange->second, this->GetColorOfFurcation(vertex, renderer));
+      }
 
-        vtkSmartPointer<vtkDataArray> scalars =
-          ls->m_vtkTubesActorMap[tube]->GetMapper()->GetInput()->GetPointData()->GetScalars();
-        double color[3];
-        scalars->GetTuple(0, color);
+      colorScalars->Modified();
+    }
+  }
 
-        if (color[0] != tubeColor[0] || color[1] != tubeColor[1] || color[2] != tubeColor[2])
-        {
-          int numberOfPoints = scalars->GetSize();
+  ls->m_lastRenderDataTime.Modified();
+}
 
-          vtkSmartPointer<vtkUnsignedCharArray> colorScalars = vtkSmartPointer<vtkUnsignedCharArray>::New();
-          colorScalars->SetName("colorScalars");
-          colorScalars->SetNumberOfComponents(3);
-          colorScalars->SetNumberOfTuples(numberOfPoints);
-          for (int i = 0; i < numberOfPoints; i++)
-          {
-            scalars->InsertTuple3(i, tubeColor[0], tubeColor[1], tubeColor[2]);
-          }
-          ls->m_vtkTubesActorMap[tube]->GetMapper()->GetInput()->GetPointData()->SetActiveScalars("colorScalars");
-        }
+void mitk::TubeGraphVtkMapper3D::MergeVisibleStructures(mitk::BaseRenderer *renderer)
+{
+  LocalStorage *ls = m_LSH.GetLocalStorage(renderer);
 
-        sphereColorR += tubeColor[0];
-        sphereColorG += tubeColor[1];
-        sphereColorB += tubeColor[2];
-        numberOfVisibleEdges++;
-      }
-    }
-    if (numberOfVisibleEdges > 0)
+  ls->m_TubePointRangeMap.clear();
+  ls->m_SpherePointRangeMap.clear();
+
+  vtkSmartPointer<vtkAppendPolyData> appendPolyData = vtkSmartPointer<vtkAppendPolyData>::New();
+  vtkIdType numberOfPoints = 0;
+
+  // Adds the (clipped) poly data of the actor with a color array of its own, so that the color
+  // scalars are kept by vtkAppendPolyData and can be changed per structure afterwards
+  auto addStructure = [&appendPolyData, &numberOfPoints](vtkActor *actor, const Color &color) {
+    auto mapper = vtkPolyDataMapper::SafeDownCast(actor->GetMapper());
+    if (mapper == nullptr)
+      return LocalStorage::PointRangeType(0, 0);
+
+    mapper->Update();
+    vtkSmartPointer<vtkPolyData> structure = vtkSmartPointer<vtkPolyData>::New();
+    structure->ShallowCopy(mapper->GetInput());
+
+    vtkSmartPointer<vtkUnsignedCharArray> colorScalars = vtkSmartPointer<vtkUnsignedCharArray>::New();
+    colorScalars->SetName("colorScalars");
+    colorScalars->SetNumberOfComponents(3);
+    colorScalars->SetNumberOfTuples(structure->GetNumberOfPoints());
+    for (vtkIdType id = 0; id < structure->GetNumberOfPoints(); ++id)
+      colorScalars->SetTuple3(id, color[0], color[1], color[2]);
+    structure->GetPointData()->AddArray(colorScalars);
+
+    appendPolyData->AddInputData(structure);
+
+    LocalStorage::PointRangeType range(numberOfPoints, structure->GetNumberOfPoints());
+    numberOfPoints += range.second;
+    return range;
+  };
+
+  std::set<TubeGraph::VertexDescriptorType> visibleVertices;
+  for (auto itTubes = ls->m_vtkTubesActorMap.begin(); itTubes != ls->m_vtkTubesActorMap.end(); ++itTubes)
+  {
+    const LocalStorage::TubeState &state = ls->m_TubeStateMap[itTubes->first];
+    if (!state.isVisible)
+      continue;
+
+    ls->m_TubePointRangeMap[itTubes->first] = addStructure(itTubes->second, state.color);
+    visibleVertices.insert(itTubes->first.first);
+    visibleVertices.insert(itTubes->first.second);
+  }
+
+  // render the clipped spheres as end-cups of a tube and connections between tubes, but don't render the sphere
+  // which is the root of the graph
+  // TODO check both spheres
+  visibleVertices.erase(this->GetInput()->GetRootVertex());
+  for (const auto &vertex : visibleVertices)
+  {
+    auto itSphere = ls->m_vtkSpheresActorMap.find(vertex);
+    if (itSphere != ls->m_vtkSpheresActorMap.end())
+      ls->m_SpherePointRangeMap[vertex] = addStructure(itSphere->second, this->GetColorOfFurcation(vertex, renderer));
+  }
+
+  vtkSmartPointer<vtkPolyData> mergedPolyData = vtkSmartPointer<vtkPolyData>::New();
+  if (appendPolyData->GetNumberOfInputConnections(0) > 0)
+  {
+    appendPolyData->Update();
+    mergedPolyData->ShallowCopy(appendPolyData->GetOutput());
+    mergedPolyData->GetPointData()->SetActiveScalars("colorScalars");
+  }
+
+  ls->m_vtkMergedPolyData = mergedPolyData;
+  ls->m_vtkMergedMapper->SetInputData(mergedPolyData);
+}
+
+mitk::Color mitk::TubeGraphVtkMapper3D::GetColorOfFurcation(const TubeGraph::VertexDescriptorType &vertex,
+                                                            mitk::BaseRenderer *renderer)
+{
+  LocalStorage *ls = m_LSH.GetLocalStorage(renderer);
+
+  double sphereColor[3] = {0, 0, 0};
+  int numberOfVisibleEdges = 0;
+
+  auto itTubes = ls->m_TubesOfVertexMap.find(vertex);
+  if (itTubes != ls->m_TubesOfVertexMap.end())
+  {
+    for (const auto &tube : itTubes->second)
     {
-      sphereColorR /= 255 * numberOfVisibleEdges;
-      sphereColorG /= 255 * numberOfVisibleEdges;
-      sphereColorB /= 255 * numberOfVisibleEdges;
-    }
+      const LocalStorage::TubeState &state = ls->m_TubeStateMap[tube];
+      if (!state.isVisible)
+        continue;
 
-    ls->m_vtkSpheresActorMap[vertexDesc]->GetProperty()->SetColor(sphereColorR, sphereColorG, sphereColorB);
+      for (int i = 0; i < 3; ++i)
+        sphereColor[i] += state.color[i];
+      numberOfVisibleEdges++;
+    }
   }
-  ls->m_lastRenderDataTime.Modified();
+
+  Color color;
+  for (int i = 0; i < 3; ++i)
+    color[i] = numberOfVisibleEdges > 0 ? sphereColor[i] / numberOfVisibleEdges : 0;
+  return color;
 }
 
 void mitk::TubeGraphVtkMapper3D::GenerateTubeGraphData(mitk::BaseRenderer *renderer)
@@ -220,6 +278,8 @@ void mitk::TubeGraphVtkMapper3D::GenerateTubeGraphData(mitk::BaseRenderer *rende
 
   ls->m_vtkTubesActorMap.clear();
   ls->m_vtkSpheresActorMap.clear();
+  ls->m_TubesOfVertexMap.clear();
+  ls->m_TubeStateMap.clear();
 
   TubeGraph::Pointer tubeGraph = const_cast<mitk::TubeGraph *>(this->GetInput());
   TubeGraphProperty::Pointer tubeGraphProperty =
@@ -234,6 +294,12 @@ void mitk::TubeGraphVtkMapper3D::GenerateTubeGraphData(mitk::BaseRenderer *rende
     this->GeneratePolyDataForTube(*edge, tubeGraph, tubeGraphProperty, renderer);
   }
 
+  for (auto itTubes = ls->m_vtkTubesActorMap.begin(); itTubes != ls->m_vtkTubesActorMap.end(); ++itTubes)
+  {
+    ls->m_TubesOfVertexMap[itTubes->first.first].push_back(itTubes->first);
+    ls->m_TubesOfVertexMap[itTubes->first.second].push_back(itTubes->first);
+  }
+
   // Generate all vertices as spheres
   std::vector<TubeGraphVertex> allVertices = tubeGraph->GetVectorOfAllVertices();
   for (auto vertex = allVertices.begin(); vertex != allVertices.end(); ++vertex)
@@ -243,9 +309,9 @@ void mitk::TubeGraphVtkMapper3D::GenerateTubeGraphData(mitk::BaseRenderer *rende
     {
       this->ClipPolyData(*vertex, tubeGraph, tubeGraphProperty, renderer);
     }
-
-    ls->m_lastGenerateDataTime.Modified();
   }
+
+  ls->m_lastGenerateDataTime.Modified();
 }
 
 void mitk::TubeGraphVtkMapper3D::GeneratePolyDataForFurcation(mitk::TubeGraphVertex &vertex,
@@ -0,0 +1,110 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkUSImageFramePool.h"
+#include "mitkTestingMacros.h"
+#include "mitkImageReadAccessor.h"
+#include "mitkImageWriteAccessor.h"
+
+#include <algorithm>
+#include <set>
+
+class mitkUSImageFramePoolTestClass
+{
+public:
+
+  static mitk::Image::Pointer CreateFrame(unsigned char value, unsigned int width = 4)
+  {
+    unsigned int dimensions[2] = { width, 3 };
+    mitk::Image::Pointer image = mitk::Image::New();
+    image->Initialize(mitk::MakeScalarPixelType<unsigned char>(), 2, dimensions);
+
+    mitk::ImageWriteAccessor writeAccessor(image);
+    auto* data = static_cast<unsigned char*>(writeAccessor.GetData());
+    std::fill(data, data + width * 3, value);
+    return image;
+  }
+
+  static unsigned char GetFirstPixel(mitk::Image::Pointer image)
+  {
+    mitk::ImageReadAccessor readAccessor(image);
+    return *static_cast<const unsigned char*>(readAccessor.GetData());
+  }
+
+  static void TestAcquireLatest()
+  {
+    mitk::USImageFramePool pool;
+    std::vector<mitk::Image::Pointer> frame;
+    MITK_TEST_CONDITION_REQUIRED(!pool.AcquireLatest(frame), "No frame can be acquired before one was published");
+
+    pool.Publish({ CreateFrame(1) });
+    pool.Publish({ CreateFrame(2) });
+    MITK_TEST_CONDITION_REQUIRED(pool.AcquireLatest(frame) && frame.size() == 1, "The latest frame is acquired");
+    MITK_TEST_CONDITION(GetFirstPixel(frame[0]) == 2, "The acquired frame contains the latest data");
+    MITK_TEST_CONDITION(pool.GetNumberOfDroppedFrames() == 1, "The overwritten frame is counted as dropped");
+    MITK_TEST_CONDITION(!pool.AcquireLatest(frame), "A frame is only acquired once");
+  }
+
+  static void TestAcquiredFrameIsNotOverwritten()
+  {
+    mitk::USImageFramePool pool;
+    std::vector<mitk::Image::Pointer> frame;
+    pool.Publish({ CreateFrame(1) });
+    pool.AcquireLatest(frame);
+
+    for (unsigned char value = 2; value < 20; ++value)
+      pool.Publish({ CreateFrame(value) });
+
+    MITK_TEST_CONDITION(GetFirstPixel(frame[0]) == 1, "The acquired frame is not overwritten by new frames");
+    MITK_TEST_CONDITION(pool.GetNumberOfPublishedFrames() == 19, "All published frames are counted");
+    MITK_TEST_CONDITION(pool.GetNumberOfDroppedFrames() == 17, "All but the latest unacquired frames are dropped");
+
+    pool.AcquireLatest(frame);
+    MITK_TEST_CONDITION(GetFirstPixel(frame[0]) == 19, "The latest frame is acquired after the previous one");
+  }
+
+  static void TestBuffersAreReused()
+  {
+    mitk::USImageFramePool pool;
+    std::vector<mitk::Image::Pointer> frame;
+    std::set<mitk::Image*> buffers;
+
+    for (unsigned char value = 0; value < 10; ++value)
+    {
+      pool.Publish({ CreateFrame(value) });
+      pool.AcquireLatest(frame);
+      buffers.insert(frame[0].GetPointer());
+    }
+    MITK_TEST_CONDITION(buffers.size() <= pool.GetNumberOfBuffers(), "The preallocated buffers are reused");
+
+    pool.Publish({ CreateFrame(5, 8) });
+    pool.AcquireLatest(frame);
+    MITK_TEST_CONDITION(frame[0]->GetDimension(0) == 8, "Buffers are reallocated if the frame size changes");
+
+    pool.ResetCounters();
+    MITK_TEST_CONDITION(pool.GetNumberOfAcquiredFrames() == 0, "Counters are reset");
+  }
+};
+
+/**
+* This function is testing methods of the class USImageFramePool.
+*/
+int mitkUSImageFramePoolTest(int /* argc */, char* /*argv*/[])
+{
+  MITK_TEST_BEGIN("mitkUSImageFramePoolTest");
+
+    mitkUSImageFramePoolTestClass::TestAcquireLatest();
+    mitkUSImageFramePoolTestClass::TestAcquiredFrameIsNotOverwritten();
+    mitkUSImageFramePoolTestClass::TestBuffersAreReused();
+
+  MITK_TEST_END();
+}
@@ -21,6 +21,7 @@ found in the LICENSE file.
 #include <mitkIMimeTypeProvider.h>
 
 #include "mitkImageGenerator.h"
+#include "mitkUSImageStreamReader.h"
 
 #include "itksys/SystemTools.hxx"
 
@@ -36,6 +37,7 @@ class mitkUSImageLoggingFilterTestSuite : public mitk::TestFixture
   MITK_TEST(TestSavingAfterMupltipleUpdateCalls);
   MITK_TEST(TestFilterWithEmptyImages);
   MITK_TEST(TestFilterWithInvalidPath);
+  MITK_TEST(TestStreaming);
   //MITK_TEST(TestJpgFileExtension); //bug 19614
   CPPUNIT_TEST_SUITE_END();
 
@@ -158,6 +160,67 @@ public:
                                mitk::Exception);
   }
 
+  void TestStreaming()
+  {
+  std::string fileName = mitk::IOUtil::CreateTemporaryFile("USImageLoggingFilterTest_XXXXXX.usstream");
+  m_TestFilter->SetInput(m_RandomSingleSliceImage);
+  m_TestFilter->StartStreaming(fileName);
+  CPPUNIT_ASSERT_MESSAGE("Testing if streaming is started", m_TestFilter->GetIsStreaming());
+
+  mitk::NavigationData::Pointer navigationData = mitk::NavigationData::New();
+  navigationData->SetName("probe");
+  for (int i = 0; i < 5; i++)
+    {
+    m_TestFilter->Modified();
+    m_TestFilter->Update();
+    std::stringstream testmessage;
+    testmessage << "testmessage" << i;
+    m_TestFilter->AddMessageToCurrentImage(testmessage.str());
+    mitk::Point3D position;
+    position.Fill(i);
+    navigationData->SetPosition(position);
+    m_TestFilter->AddNavigationData(navigationData);
+    }
+  m_TestFilter->StopStreaming();
+  CPPUNIT_ASSERT_MESSAGE("Testing if streaming is stopped", !m_TestFilter->GetIsStreaming());
+
+  mitk::USImageStreamReader reader(fileName);
+  mitk::USImageStreamReader::Record record;
+  unsigned int numberOfImages = 0, numberOfMessages = 0, numberOfNavigationDatas = 0;
+  while (reader.ReadNextRecord(record))
+    {
+    if (record.Type == mitk::USImageStreamReader::ImageRecord)
+      {
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing if images are streamed in order", numberOfImages, record.Index);
+      CPPUNIT_ASSERT_MESSAGE("Testing if the streamed image equals the input",
+                             mitk::Equal(*m_RandomSingleSliceImage, *record.Image, mitk::eps, false));
+      ++numberOfImages;
+      }
+    else if (record.Type == mitk::USImageStreamReader::MessageRecord)
+      {
+      std::stringstream testmessage;
+      testmessage << "testmessage" << numberOfMessages;
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing if messages are streamed", testmessage.str(), record.Message);
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing if a message belongs to the last image", numberOfImages - 1, record.Index);
+      ++numberOfMessages;
+      }
+    else
+      {
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing if navigation datas are streamed",
+                                   static_cast<double>(numberOfNavigationDatas),
+                                   record.NavigationData->GetPosition()[0]);
+      CPPUNIT_ASSERT_EQUAL(std::string("probe"), std::string(record.NavigationData->GetName()));
+      ++numberOfNavigationDatas;
+      }
+    }
+
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing if all images were streamed", 5u, numberOfImages);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing if all messages were streamed", 5u, numberOfMessages);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing if all navigation datas were streamed", 5u, numberOfNavigationDatas);
+
+  std::remove(fileName.c_str());
+  }
+
   void TestJpgFileExtension()
   {
   CPPUNIT_ASSERT_MESSAGE("Testing setting of jpg extension.",m_TestFilter->SetImageFilesExtension(".jpg"));
@@ -22,12 +22,14 @@ found in the LICENSE file.
 
 
 mitk::USImageLoggingFilter::USImageLoggingFilter() : m_SystemTimeClock(RealTimeClock::New()),
-                                                     m_ImageExtension(".nrrd")
+                                                     m_ImageExtension(".nrrd"),
+                                                     m_NumberOfStreamedImages(0)
 {
 }
 
 mitk::USImageLoggingFilter::~USImageLoggingFilter()
 {
+  // the stream writer closes the file on destruction
 }
 
 void mitk::USImageLoggingFilter::GenerateData()
@@ -41,6 +43,12 @@ void mitk::USImageLoggingFilter::GenerateData()
     return;
     }
 
+  if (m_StreamWriter)
+  {
+    m_StreamWriter->AddImage(inputImage, m_SystemTimeClock->GetCurrentStamp(), m_NumberOfStreamedImages++);
+    return;
+  }
+
   //a clone is needed for a output and to store it.
   mitk::Image::Pointer inputClone = inputImage->Clone();
 
@@ -79,6 +87,12 @@ void mitk::USImageLoggingFilter::GenerateData()
 
 void mitk::USImageLoggingFilter::AddMessageToCurrentImage(std::string message)
 {
+  if (m_StreamWriter)
+  {
+    m_StreamWriter->AddMessage(m_NumberOfStreamedImages - 1, message);
+    return;
+  }
+
   m_LoggedMessages.insert(std::make_pair(static_cast<int>(m_LoggedImages.size()-1),message));
 }
 
@@ -159,3 +173,33 @@ bool mitk::USImageLoggingFilter::SetImageFilesExtension(std::string extension)
   }
   return false;
  }
+
+void mitk::USImageLoggingFilter::StartStreaming(const std::string& fileName)
+{
+  this->StopStreaming();
+
+  std::unique_ptr<USImageStreamWriter> writer(new USImageStreamWriter);
+  writer->Open(fileName);
+  m_StreamWriter = std::move(writer);
+  m_NumberOfStreamedImages = 0;
+}
+
+void mitk::USImageLoggingFilter::StopStreaming()
+{
+  if (!m_StreamWriter)
+    return;
+
+  std::unique_ptr<USImageStreamWriter> writer = std::move(m_StreamWriter);
+  writer->Close();
+}
+
+bool mitk::USImageLoggingFilter::GetIsStreaming() const
+{
+  return m_StreamWriter != nullptr;
+}
+
+void mitk::USImageLoggingFilter::AddNavigationData(const mitk::NavigationData* navigationData, unsigned int toolIndex)
+{
+  if (m_StreamWriter && navigationData != nullptr)
+    m_StreamWriter->AddNavigationData(navigationData, toolIndex, m_SystemTimeClock->GetCurrentStamp());
+}
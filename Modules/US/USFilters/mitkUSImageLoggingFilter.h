@@ -17,6 +17,10 @@ found in the LICENSE file.
 #include <MitkUSExports.h>
 #include <mitkImageToImageFilter.h>
 #include <mitkRealTimeClock.h>
+#include <mitkNavigationData.h>
+#include "mitkUSImageStreamWriter.h"
+
+#include <memory>
 
 
 namespace mitk {
@@ -25,6 +29,10 @@ namespace mitk {
    *  add messages. All data (images, timestamps and messages) is written to the harddisc when
    *  the method SaveImages(...) is called.
    *
+   *  For long recordings, StartStreaming(...) writes every image to a compressed stream file instead while it
+   *  is logged, together with the messages and the navigation data added with AddNavigationData(...). Then the
+   *  images are not kept in memory.
+   *
    *  Caution: only supports logging of one input at the moment, multiple inputs are ignored!
    *
    *  \ingroup US
@@ -72,6 +80,25 @@ namespace mitk {
      */
     bool SetImageFilesExtension(std::string extension);
 
+    /** Starts writing all images which are logged from now on to the given file (see mitk::USImageStreamWriter),
+     *  instead of keeping them in memory until SaveImages(...) is called. The file can be read with
+     *  mitk::USImageStreamReader.
+     *  @throw mitk::Exception Throws an exception if the file cannot be created.
+     */
+    void StartStreaming(const std::string& fileName);
+
+    /** Writes the remaining images and closes the stream file.
+     *  @throw mitk::Exception Throws an exception if writing to the file failed.
+     */
+    void StopStreaming();
+
+    bool GetIsStreaming() const;
+
+    /** Adds navigation data (e.g. of the tracked probe) to the stream file, interleaved with the images by time.
+     *  Does nothing if not streaming.
+     */
+    void AddNavigationData(const mitk::NavigationData* navigationData, unsigned int toolIndex = 0);
+
 
   protected:
     USImageLoggingFilter();
@@ -85,6 +112,9 @@ namespace mitk {
     std::vector<double> m_LoggedMITKSystemTimes; ///< Logged system times for every logged image
     std::string m_ImageExtension; ///< stores the image extension, default is ".nrrd"
 
+    std::unique_ptr<USImageStreamWriter> m_StreamWriter; ///< writes the stream file, null if not streaming
+    unsigned int m_NumberOfStreamedImages; ///< number of images written to the stream file
+
   };
 } // namespace mitk
 #endif /* MITKUSImageSource_H_HEADER_INCLUDED_ */
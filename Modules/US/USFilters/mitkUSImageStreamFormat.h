@@ -0,0 +1,182 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkUSImageStreamFormat_h
+#define mitkUSImageStreamFormat_h
+
+#include <mitkExceptionMacro.h>
+#include <mitkPixelType.h>
+
+#include <itkRGBAPixel.h>
+#include <itkRGBPixel.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace mitk
+{
+  /**
+   * Layout of the ultrasound stream files written by USImageStreamWriter and read by USImageStreamReader.
+   * All values are stored little endian.
+   *
+   * The file starts with an 8 byte magic and an uint32 version. Then records follow, each consisting of an
+   * uint8 record type, an uint32 payload size and the payload:
+   *
+   * - Image: double system time, uint32 frame index, uint8 pixel type, uint32 dimension, uint32 size of each
+   *   dimension, double index to world matrix[9] and offset[3], uint64 size of the pixel data and the zlib
+   *   compressed pixel data.
+   * - NavigationData: double system time, uint32 tool index, double IGT timestamp, double position[3],
+   *   double orientation[4], uint8 data valid, uint32 name length and the name.
+   * - Message: uint32 frame index, uint32 message length and the message.
+   *
+   * Records are appended in the order they were logged, so images and navigation data are interleaved by time.
+   */
+  namespace USImageStreamFormat
+  {
+    const char Magic[8] = {'M', 'I', 'T', 'K', 'U', 'S', 'S', '\0'};
+    const std::uint32_t Version = 1;
+
+    enum RecordType : std::uint8_t
+    {
+      ImageRecord = 1,
+      NavigationDataRecord = 2,
+      MessageRecord = 3
+    };
+
+    enum PixelTypeCode : std::uint8_t
+    {
+      UnsupportedPixelType = 0,
+      UCharPixelType,
+      CharPixelType,
+      UShortPixelType,
+      ShortPixelType,
+      UIntPixelType,
+      IntPixelType,
+      FloatPixelType,
+      DoublePixelType,
+      RGBUCharPixelType,
+      RGBAUCharPixelType
+    };
+
+    inline bool IsLittleEndianHost()
+    {
+      const std::uint16_t one = 1;
+      return *reinterpret_cast<const unsigned char *>(&one) == 1;
+    }
+
+    inline std::uint8_t GetPixelTypeCode(const PixelType &pixelType)
+    {
+      if (pixelType == MakeScalarPixelType<unsigned char>())
+        return UCharPixelType;
+      if (pixelType == MakeScalarPixelType<char>())
+        return CharPixelType;
+      if (pixelType == MakeScalarPixelType<unsigned short>())
+        return UShortPixelType;
+      if (pixelType == MakeScalarPixelType<short>())
+        return ShortPixelType;
+      if (pixelType == MakeScalarPixelType<unsigned int>())
+        return UIntPixelType;
+      if (pixelType == MakeScalarPixelType<int>())
+        return IntPixelType;
+      if (pixelType == MakeScalarPixelType<float>())
+        return FloatPixelType;
+      if (pixelType == MakeScalarPixelType<double>())
+        return DoublePixelType;
+      if (pixelType == MakePixelType<unsigned char, itk::RGBPixel<unsigned char>, 3>())
+        return RGBUCharPixelType;
+      if (pixelType == MakePixelType<unsigned char, itk::RGBAPixel<unsigned char>, 4>())
+        return RGBAUCharPixelType;
+      return UnsupportedPixelType;
+    }
+
+    inline PixelType MakePixelTypeFromCode(std::uint8_t code)
+    {
+      switch (code)
+      {
+        case UCharPixelType:
+          return MakeScalarPixelType<unsigned char>();
+        case CharPixelType:
+          return MakeScalarPixelType<char>();
+        case UShortPixelType:
+          return MakeScalarPixelType<unsigned short>();
+        case ShortPixelType:
+          return MakeScalarPixelType<short>();
+        case UIntPixelType:
+          return MakeScalarPixelType<unsigned int>();
+        case IntPixelType:
+          return MakeScalarPixelType<int>();
+        case FloatPixelType:
+          return MakeScalarPixelType<float>();
+        case DoublePixelType:
+          return MakeScalarPixelType<double>();
+        case RGBUCharPixelType:
+          return MakePixelType<unsigned char, itk::RGBPixel<unsigned char>, 3>();
+        case RGBAUCharPixelType:
+          return MakePixelType<unsigned char, itk::RGBAPixel<unsigned char>, 4>();
+        default:
+          mitkThrow() << "Unknown pixel type " << static_cast<int>(code) << " in ultrasound stream.";
+      }
+    }
+
+    template <typename T>
+    void AppendValue(std::vector<char> &buffer, T value)
+    {
+      const auto *bytes = reinterpret_cast<const char *>(&value);
+      buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    inline void AppendString(std::vector<char> &buffer, const std::string &value)
+    {
+      AppendValue<std::uint32_t>(buffer, static_cast<std::uint32_t>(value.size()));
+      buffer.insert(buffer.end(), value.begin(), value.end());
+    }
+
+    /** Reads sequentially from a record payload and throws if it is shorter than expected. */
+    class PayloadReader
+    {
+    public:
+      PayloadReader(const std::vector<char> &payload) : m_Payload(payload), m_Position(0) {}
+
+      template <typename T>
+      T Read()
+      {
+        T value;
+        std::memcpy(&value, this->Consume(sizeof(T)), sizeof(T));
+        return value;
+      }
+
+      std::string ReadString()
+      {
+        const auto length = this->Read<std::uint32_t>();
+        return std::string(this->Consume(length), length);
+      }
+
+      const char *Consume(std::size_t size)
+      {
+        if (m_Payload.size() - m_Position < size)
+          mitkThrow() << "Corrupt record in ultrasound stream.";
+        const char *data = m_Payload.data() + m_Position;
+        m_Position += size;
+        return data;
+      }
+
+      std::size_t GetRemainingSize() const { return m_Payload.size() - m_Position; }
+
+    private:
+      const std::vector<char> &m_Payload;
+      std::size_t m_Position;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,163 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkUSImageStreamReader.h"
+#include "mitkUSImageStreamFormat.h"
+
+#include <mitkImageWriteAccessor.h>
+
+#include "itk_zlib.h"
+
+mitk::USImageStreamReader::USImageStreamReader(const std::string &fileName) : m_FileName(fileName)
+{
+  if (!USImageStreamFormat::IsLittleEndianHost())
+    mitkThrow() << "Ultrasound streams are not supported on this platform.";
+
+  m_File.open(fileName, std::ios::binary);
+  if (!m_File)
+    mitkThrow() << "Cannot open " << fileName << " for reading.";
+
+  char magic[sizeof(USImageStreamFormat::Magic)];
+  std::uint32_t version = 0;
+  m_File.read(magic, sizeof(magic));
+  m_File.read(reinterpret_cast<char *>(&version), sizeof(version));
+
+  if (!m_File || std::memcmp(magic, USImageStreamFormat::Magic, sizeof(magic)) != 0)
+    mitkThrow() << fileName << " is no ultrasound stream.";
+
+  if (version != USImageStreamFormat::Version)
+    mitkThrow() << "Unsupported version " << version << " of ultrasound stream " << fileName << ".";
+}
+
+bool mitk::USImageStreamReader::ReadNextRecord(Record &record)
+{
+  for (;;)
+  {
+    std::uint8_t type = 0;
+    std::uint32_t size = 0;
+    m_File.read(reinterpret_cast<char *>(&type), sizeof(type));
+    m_File.read(reinterpret_cast<char *>(&size), sizeof(size));
+    if (!m_File)
+      return false;
+
+    m_Payload.resize(size);
+    m_File.read(m_Payload.data(), size);
+    if (!m_File)
+      return false;
+
+    record = Record();
+    switch (type)
+    {
+      case USImageStreamFormat::ImageRecord:
+        this->ReadImage(m_Payload, record);
+        return true;
+      case USImageStreamFormat::NavigationDataRecord:
+        this->ReadNavigationData(m_Payload, record);
+        return true;
+      case USImageStreamFormat::MessageRecord:
+        this->ReadMessage(m_Payload, record);
+        return true;
+      default:
+        // written by a newer version
+        break;
+    }
+  }
+}
+
+void mitk::USImageStreamReader::ReadImage(const std::vector<char> &payload, Record &record)
+{
+  USImageStreamFormat::PayloadReader reader(payload);
+  record.Type = ImageRecord;
+  record.TimeStamp = reader.Read<double>();
+  record.Index = reader.Read<std::uint32_t>();
+
+  const PixelType pixelType = USImageStreamFormat::MakePixelTypeFromCode(reader.Read<std::uint8_t>());
+
+  const auto dimension = reader.Read<std::uint32_t>();
+  if (dimension < 1 || dimension > 3)
+    mitkThrow() << "Unsupported image dimension " << dimension << " in " << m_FileName << ".";
+
+  unsigned int dimensions[3] = {1, 1, 1};
+  std::size_t numberOfPixels = 1;
+  for (unsigned int i = 0; i < dimension; ++i)
+  {
+    dimensions[i] = reader.Read<std::uint32_t>();
+    numberOfPixels *= dimensions[i];
+  }
+
+  auto transform = AffineTransform3D::New();
+  AffineTransform3D::MatrixType matrix;
+  AffineTransform3D::OutputVectorType offset;
+  for (unsigned int row = 0; row < 3; ++row)
+  {
+    for (unsigned int column = 0; column < 3; ++column)
+      matrix[row][column] = reader.Read<double>();
+  }
+  for (unsigned int i = 0; i < 3; ++i)
+    offset[i] = reader.Read<double>();
+  transform->SetMatrix(matrix);
+  transform->SetOffset(offset);
+
+  const auto pixelDataSize = reader.Read<std::uint64_t>();
+  if (pixelDataSize != numberOfPixels * pixelType.GetSize())
+    mitkThrow() << "Corrupt image record in " << m_FileName << ".";
+
+  record.Image = Image::New();
+  record.Image->Initialize(pixelType, dimension, dimensions);
+
+  {
+    mitk::ImageWriteAccessor writeAccessor(record.Image);
+    const std::size_t compressedSize = reader.GetRemainingSize();
+    uLongf uncompressedSize = static_cast<uLongf>(pixelDataSize);
+    const int result = uncompress(static_cast<Bytef *>(writeAccessor.GetData()),
+                                  &uncompressedSize,
+                                  reinterpret_cast<const Bytef *>(reader.Consume(compressedSize)),
+                                  static_cast<uLong>(compressedSize));
+    if (result != Z_OK || uncompressedSize != pixelDataSize)
+      mitkThrow() << "Cannot decompress image " << record.Index << " in " << m_FileName << ".";
+  }
+
+  record.Image->GetGeometry()->SetIndexToWorldTransform(transform);
+}
+
+void mitk::USImageStreamReader::ReadNavigationData(const std::vector<char> &payload, Record &record)
+{
+  USImageStreamFormat::PayloadReader reader(payload);
+  record.Type = NavigationDataRecord;
+  record.TimeStamp = reader.Read<double>();
+  record.Index = reader.Read<std::uint32_t>();
+
+  record.NavigationData = NavigationData::New();
+  record.NavigationData->SetIGTTimeStamp(reader.Read<double>());
+
+  NavigationData::PositionType position;
+  for (unsigned int i = 0; i < 3; ++i)
+    position[i] = reader.Read<double>();
+  record.NavigationData->SetPosition(position);
+
+  NavigationData::OrientationType orientation;
+  for (unsigned int i = 0; i < 4; ++i)
+    orientation[i] = reader.Read<double>();
+  record.NavigationData->SetOrientation(orientation);
+
+  record.NavigationData->SetDataValid(reader.Read<std::uint8_t>() != 0);
+  record.NavigationData->SetName(reader.ReadString());
+}
+
+void mitk::USImageStreamReader::ReadMessage(const std::vector<char> &payload, Record &record)
+{
+  USImageStreamFormat::PayloadReader reader(payload);
+  record.Type = MessageRecord;
+  record.TimeStamp = 0.0;
+  record.Index = reader.Read<std::uint32_t>();
+  record.Message = reader.ReadString();
+}
@@ -0,0 +1,87 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkUSImageStreamReader_h
+#define mitkUSImageStreamReader_h
+
+#include <MitkUSExports.h>
+#include <mitkImage.h>
+#include <mitkNavigationData.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace mitk {
+  /**
+  * \brief Reads the records of an ultrasound stream written by mitk::USImageStreamWriter in their logged order.
+  *
+  * Usage:
+  * \code
+  * mitk::USImageStreamReader reader(fileName);
+  * mitk::USImageStreamReader::Record record;
+  * while (reader.ReadNextRecord(record))
+  * {
+  *   if (record.Type == mitk::USImageStreamReader::ImageRecord)
+  *     ...
+  * }
+  * \endcode
+  *
+  * \ingroup US
+  */
+  class MITKUS_EXPORT USImageStreamReader
+  {
+  public:
+    enum RecordType
+    {
+      ImageRecord = 1,
+      NavigationDataRecord = 2,
+      MessageRecord = 3
+    };
+
+    struct Record
+    {
+      RecordType Type;
+      double TimeStamp;          ///< system time of images and navigation data
+      unsigned int Index;        ///< frame index of images and messages, tool index of navigation data
+      mitk::Image::Pointer Image;
+      mitk::NavigationData::Pointer NavigationData;
+      std::string Message;
+    };
+
+    /**
+    * \throw mitk::Exception if the file cannot be opened or is no ultrasound stream
+    */
+    explicit USImageStreamReader(const std::string &fileName);
+
+    USImageStreamReader(const USImageStreamReader &) = delete;
+    USImageStreamReader &operator=(const USImageStreamReader &) = delete;
+
+    /**
+    * \brief Reads the next record. Unknown record types are skipped.
+    * \return false at the end of the file. An incomplete last record (e.g. after a crash) is ignored.
+    * \throw mitk::Exception if a record is corrupt
+    */
+    bool ReadNextRecord(Record &record);
+
+  private:
+    void ReadImage(const std::vector<char> &payload, Record &record);
+    void ReadNavigationData(const std::vector<char> &payload, Record &record);
+    void ReadMessage(const std::vector<char> &payload, Record &record);
+
+    std::ifstream m_File;
+    std::string m_FileName;
+    std::vector<char> m_Payload;
+  };
+} // namespace mitk
+
+#endif
@@ -0,0 +1,287 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkUSImageStreamWriter.h"
+#include "mitkUSImageStreamFormat.h"
+
+#include <mitkImageReadAccessor.h>
+
+#include "itk_zlib.h"
+
+#include <algorithm>
+
+mitk::USImageStreamWriter::USImageStreamWriter()
+  : m_CompressionLevel(Z_BEST_SPEED),
+    m_MaximumNumberOfPendingImages(16),
+    m_NumberOfPendingImages(0),
+    m_StopWriting(false)
+{
+}
+
+mitk::USImageStreamWriter::~USImageStreamWriter()
+{
+  try
+  {
+    this->Close();
+  }
+  catch (const std::exception &e)
+  {
+    MITK_ERROR << e.what();
+  }
+}
+
+void mitk::USImageStreamWriter::Open(const std::string &fileName)
+{
+  if (this->IsOpen())
+    mitkThrow() << "Cannot open " << fileName << ", " << m_FileName << " is still open.";
+
+  if (!USImageStreamFormat::IsLittleEndianHost())
+    mitkThrow() << "Ultrasound streams are not supported on this platform.";
+
+  m_File.open(fileName, std::ios::binary | std::ios::trunc);
+  if (!m_File)
+    mitkThrow() << "Cannot open " << fileName << " for writing.";
+
+  std::vector<char> header(USImageStreamFormat::Magic, USImageStreamFormat::Magic + sizeof(USImageStreamFormat::Magic));
+  USImageStreamFormat::AppendValue<std::uint32_t>(header, USImageStreamFormat::Version);
+  if (!m_File.write(header.data(), header.size()).flush())
+  {
+    m_File.close();
+    mitkThrow() << "Cannot write the header of " << fileName << ".";
+  }
+
+  m_FileName = fileName;
+  m_NumberOfPendingImages = 0;
+  m_StopWriting = false;
+  m_Error.clear();
+  m_WriterThread = std::thread(&USImageStreamWriter::WriterThread, this);
+}
+
+void mitk::USImageStreamWriter::AddImage(const Image *image, double timeStamp, unsigned int frameIndex)
+{
+  if (!this->IsOpen())
+    mitkThrow() << "Cannot add an image, no ultrasound stream is open.";
+
+  const std::uint8_t pixelTypeCode = USImageStreamFormat::GetPixelTypeCode(image->GetPixelType());
+  if (pixelTypeCode == USImageStreamFormat::UnsupportedPixelType)
+    mitkThrow() << "Images of pixel type " << image->GetPixelType().GetTypeAsString() << " cannot be streamed.";
+
+  Record record;
+  record.Type = USImageStreamFormat::ImageRecord;
+  USImageStreamFormat::AppendValue<double>(record.Payload, timeStamp);
+  USImageStreamFormat::AppendValue<std::uint32_t>(record.Payload, frameIndex);
+  USImageStreamFormat::AppendValue<std::uint8_t>(record.Payload, pixelTypeCode);
+
+  // only the first time step is logged, like SaveImages() does for ultrasound frames
+  std::size_t numberOfPixels = 1;
+  const unsigned int dimension = std::min(image->GetDimension(), 3u);
+  USImageStreamFormat::AppendValue<std::uint32_t>(record.Payload, dimension);
+  for (unsigned int i = 0; i < dimension; ++i)
+  {
+    USImageStreamFormat::AppendValue<std::uint32_t>(record.Payload, image->GetDimension(i));
+    numberOfPixels *= image->GetDimension(i);
+  }
+
+  const auto *transform = image->GetGeometry()->GetIndexToWorldTransform();
+  for (unsigned int row = 0; row < 3; ++row)
+  {
+    for (unsigned int column = 0; column < 3; ++column)
+      USImageStreamFormat::AppendValue<double>(record.Payload, transform->GetMatrix()[row][column]);
+  }
+  for (unsigned int i = 0; i < 3; ++i)
+    USImageStreamFormat::AppendValue<double>(record.Payload, transform->GetOffset()[i]);
+
+  // the input changes with the next frame, so the pixels are copied here and compressed later
+  mitk::ImageReadAccessor readAccessor(image, image->GetVolumeData(0));
+  const auto *pixels = static_cast<const char *>(readAccessor.GetData());
+  record.PixelData.assign(pixels, pixels + numberOfPixels * image->GetPixelType().GetSize());
+
+  this->Enqueue(std::move(record));
+}
+
+void mitk::USImageStreamWriter::AddNavigationData(const NavigationData *navigationData,
+                                                  unsigned int toolIndex,
+                                                  double timeStamp)
+{
+  if (!this->IsOpen())
+    mitkThrow() << "Cannot add navigation data, no ultrasound stream is open.";
+
+  Record record;
+  record.Type = USImageStreamFormat::NavigationDataRecord;
+  USImageStreamFormat::AppendValue<double>(record.Payload, timeStamp);
+  USImageStreamFormat::AppendValue<std::uint32_t>(record.Payload, toolIndex);
+  USImageStreamFormat::AppendValue<double>(record.Payload, navigationData->GetIGTTimeStamp());
+
+  const NavigationData::PositionType position = navigationData->GetPosition();
+  for (unsigned int i = 0; i < 3; ++i)
+    USImageStreamFormat::AppendValue<double>(record.Payload, position[i]);
+
+  const NavigationData::OrientationType orientation = navigationData->GetOrientation();
+  for (unsigned int i = 0; i < 4; ++i)
+    USImageStreamFormat::AppendValue<double>(record.Payload, orientation[i]);
+
+  USImageStreamFormat::AppendValue<std::uint8_t>(record.Payload, navigationData->IsDataValid() ? 1 : 0);
+  USImageStreamFormat::AppendString(record.Payload, navigationData->GetName());
+
+  this->Enqueue(std::move(record));
+}
+
+void mitk::USImageStreamWriter::AddMessage(unsigned int frameIndex, const std::string &message)
+{
+  if (!this->IsOpen())
+    mitkThrow() << "Cannot add a message, no ultrasound stream is open.";
+
+  Record record;
+  record.Type = USImageStreamFormat::MessageRecord;
+  USImageStreamFormat::AppendValue<std::uint32_t>(record.Payload, frameIndex);
+  USImageStreamFormat::AppendString(record.Payload, message);
+
+  this->Enqueue(std::move(record));
+}
+
+void mitk::USImageStreamWriter::Close()
+{
+  if (!this->IsOpen())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_StopWriting = true;
+  }
+  m_RecordAvailable.notify_one();
+  m_WriterThread.join();
+  m_File.close();
+  m_PendingRecords.clear();
+
+  if (!m_Error.empty())
+    mitkThrow() << m_Error;
+}
+
+bool mitk::USImageStreamWriter::IsOpen() const
+{
+  return m_WriterThread.joinable();
+}
+
+void mitk::USImageStreamWriter::SetCompressionLevel(int level)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_CompressionLevel = std::max(0, std::min(level, 9));
+}
+
+int mitk::USImageStreamWriter::GetCompressionLevel() const
+{
+  return m_CompressionLevel;
+}
+
+void mitk::USImageStreamWriter::SetMaximumNumberOfPendingImages(std::size_t numberOfImages)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_MaximumNumberOfPendingImages = std::max<std::size_t>(1, numberOfImages);
+}
+
+std::size_t mitk::USImageStreamWriter::GetMaximumNumberOfPendingImages() const
+{
+  return m_MaximumNumberOfPendingImages;
+}
+
+void mitk::USImageStreamWriter::Enqueue(Record &&record)
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  if (!m_Error.empty())
+    mitkThrow() << m_Error;
+
+  if (record.Type == USImageStreamFormat::ImageRecord)
+  {
+    m_ImageWritten.wait(lock, [this]() {
+      return m_NumberOfPendingImages < m_MaximumNumberOfPendingImages || !m_Error.empty();
+    });
+    ++m_NumberOfPendingImages;
+  }
+
+  m_PendingRecords.push_back(std::move(record));
+  m_RecordAvailable.notify_one();
+}
+
+void mitk::USImageStreamWriter::WriterThread()
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  for (;;)
+  {
+    m_RecordAvailable.wait(lock, [this]() { return !m_PendingRecords.empty() || m_StopWriting; });
+    if (m_PendingRecords.empty())
+      return;
+
+    Record record = std::move(m_PendingRecords.front());
+    m_PendingRecords.pop_front();
+    const int compressionLevel = m_CompressionLevel;
+    const bool flush = m_PendingRecords.empty();
+
+    if (m_Error.empty())
+    {
+      lock.unlock();
+      std::string error;
+      try
+      {
+        this->WriteRecord(record, compressionLevel, flush);
+      }
+      catch (const std::exception &e)
+      {
+        error = e.what();
+      }
+      lock.lock();
+
+      if (!error.empty())
+        m_Error = error;
+    }
+
+    if (record.Type == USImageStreamFormat::ImageRecord)
+    {
+      --m_NumberOfPendingImages;
+      m_ImageWritten.notify_all();
+    }
+  }
+}
+
+void mitk::USImageStreamWriter::WriteRecord(Record &record, int compressionLevel, bool flush)
+{
+  if (record.Type == USImageStreamFormat::ImageRecord)
+  {
+    uLongf compressedSize = compressBound(static_cast<uLong>(record.PixelData.size()));
+    m_CompressionBuffer.resize(compressedSize);
+
+    const int result = compress2(m_CompressionBuffer.data(),
+                                 &compressedSize,
+                                 reinterpret_cast<const Bytef *>(record.PixelData.data()),
+                                 static_cast<uLong>(record.PixelData.size()),
+                                 compressionLevel);
+    if (result != Z_OK)
+      mitkThrow() << "zlib compression failed with error code " << result << ".";
+
+    USImageStreamFormat::AppendValue<std::uint64_t>(record.Payload, record.PixelData.size());
+    record.Payload.insert(
+      record.Payload.end(), m_CompressionBuffer.begin(), m_CompressionBuffer.begin() + compressedSize);
+  }
+
+  std::vector<char> header;
+  USImageStreamFormat::AppendValue<std::uint8_t>(header, record.Type);
+  USImageStreamFormat::AppendValue<std::uint32_t>(header, static_cast<std::uint32_t>(record.Payload.size()));
+
+  m_File.write(header.data(), header.size());
+  m_File.write(record.Payload.data(), record.Payload.size());
+
+  // flushed whenever the queue runs empty, so the file is readable up to the last record if the application crashes
+  if (flush)
+    m_File.flush();
+
+  if (!m_File)
+    mitkThrow() << "Cannot write to " << m_FileName << ".";
+}
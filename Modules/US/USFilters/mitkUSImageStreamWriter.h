@@ -0,0 +1,118 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkUSImageStreamWriter_h
+#define mitkUSImageStreamWriter_h
+
+#include <MitkUSExports.h>
+#include <mitkImage.h>
+#include <mitkNavigationData.h>
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mitk {
+  /**
+  * \brief Appends ultrasound images, navigation data and messages to a stream file while they are logged.
+  *
+  * The pixel data of every image is copied when it is added and compressed losslessly (zlib) and written by a
+  * background thread. So long recordings need no more memory than the images which wait for compression, their
+  * number is limited by SetMaximumNumberOfPendingImages(). If the disk or the compression cannot keep up,
+  * AddImage() waits until an image was written. Nothing is dropped.
+  *
+  * The file format is described in mitkUSImageStreamFormat.h, use mitk::USImageStreamReader to read it.
+  *
+  * \ingroup US
+  */
+  class MITKUS_EXPORT USImageStreamWriter
+  {
+  public:
+    USImageStreamWriter();
+
+    /** Closes the file, see Close(). Errors are only logged. */
+    ~USImageStreamWriter();
+
+    USImageStreamWriter(const USImageStreamWriter &) = delete;
+    USImageStreamWriter &operator=(const USImageStreamWriter &) = delete;
+
+    /**
+    * \brief Creates (or overwrites) the file and starts the writer thread.
+    * \throw mitk::Exception if the file cannot be created or a file is already open
+    */
+    void Open(const std::string &fileName);
+
+    /**
+    * \throw mitk::Exception if the file is not open, the pixel type is not supported or writing failed before
+    */
+    void AddImage(const Image *image, double timeStamp, unsigned int frameIndex);
+
+    /**
+    * \throw mitk::Exception if the file is not open or writing failed before
+    */
+    void AddNavigationData(const NavigationData *navigationData, unsigned int toolIndex, double timeStamp);
+
+    /**
+    * \throw mitk::Exception if the file is not open or writing failed before
+    */
+    void AddMessage(unsigned int frameIndex, const std::string &message);
+
+    /**
+    * \brief Writes all pending records, stops the writer thread and closes the file.
+    * \throw mitk::Exception if writing failed
+    */
+    void Close();
+
+    bool IsOpen() const;
+
+    /** \brief Sets the zlib compression level (0-9), default is 1 which is fast enough for live streams. */
+    void SetCompressionLevel(int level);
+    int GetCompressionLevel() const;
+
+    /** \brief Sets the number of images which may wait for compression, default is 16. */
+    void SetMaximumNumberOfPendingImages(std::size_t numberOfImages);
+    std::size_t GetMaximumNumberOfPendingImages() const;
+
+  private:
+    struct Record
+    {
+      std::uint8_t Type;
+      std::vector<char> Payload;
+      std::vector<char> PixelData; ///< compressed and appended to the payload by the writer thread
+    };
+
+    void Enqueue(Record &&record);
+    void WriterThread();
+    void WriteRecord(Record &record, int compressionLevel, bool flush);
+
+    std::ofstream m_File;
+    std::string m_FileName;
+    int m_CompressionLevel;
+    std::size_t m_MaximumNumberOfPendingImages;
+
+    std::deque<Record> m_PendingRecords;
+    std::size_t m_NumberOfPendingImages;
+    std::mutex m_Mutex;
+    std::condition_variable m_RecordAvailable;
+    std::condition_variable m_ImageWritten;
+    bool m_StopWriting;
+    std::string m_Error;
+    std::thread m_WriterThread;
+    std::vector<unsigned char> m_CompressionBuffer;
+  };
+} // namespace mitk
+
+#endif
@@ -329,6 +329,7 @@ bool mitk::USDevice::Activate()
     m_DeviceState = State_Activated;
 
     m_FreezeBarrier = itk::ConditionVariable::New();
+    m_FramePool.ResetCounters();
 
     // spawn thread for aquire images if us device is active
     if (m_SpawnAcquireThread)
@@ -569,9 +570,23 @@ output->Graft( graft );
 void mitk::USDevice::GrabImage()
 {
   std::vector<mitk::Image::Pointer> image = this->GetUSImageSource()->GetNextImage();
-  m_ImageMutex->Lock();
-  this->SetImageVector(image);
-  m_ImageMutex->Unlock();
+  m_FramePool.Publish(image);
+  this->Modified();
+}
+
+std::uint64_t mitk::USDevice::GetNumberOfGrabbedFrames() const
+{
+  return m_FramePool.GetNumberOfPublishedFrames();
+}
+
+std::uint64_t mitk::USDevice::GetNumberOfDroppedFrames() const
+{
+  return m_FramePool.GetNumberOfDroppedFrames();
+}
+
+void mitk::USDevice::ResetFrameCounters()
+{
+  m_FramePool.ResetCounters();
 }
 
 //########### GETTER & SETTER ##################//
@@ -620,6 +635,13 @@ void mitk::USDevice::GenerateData()
 {
   m_ImageMutex->Lock();
 
+  // the outputs keep the current frame until the acquisition thread provides a new one
+  if (!m_FramePool.AcquireLatest(m_ImageVector))
+  {
+    m_ImageMutex->Unlock();
+    return;
+  }
+
   for (unsigned int i = 0; i < m_ImageVector.size() && i < this->GetNumberOfIndexedOutputs(); ++i)
   {
     auto& image = m_ImageVector[i];
@@ -641,9 +663,9 @@ void mitk::USDevice::GenerateData()
           image->GetDimensions());
       }
 
-      // copy contents of the given image into the member variable
+      // reference the frame, the frame pool does not overwrite it before the next frame is acquired
       mitk::ImageReadAccessor inputReadAccessor(image);
-      output->SetImportVolume(inputReadAccessor.GetData());
+      output->SetImportVolume(const_cast<void*>(inputReadAccessor.GetData()), 0, 0, mitk::Image::ReferenceMemory);
       output->SetGeometry(image->GetGeometry());
     }
   }
@@ -20,6 +20,7 @@ found in the LICENSE file.
 #include "mitkUSProbe.h"
 #include <MitkUSExports.h>
 #include "mitkUSImageSource.h"
+#include "mitkUSImageFramePool.h"
 
 // MitkIGTL
 #include "mitkIGTLMessageProvider.h"
@@ -314,6 +315,19 @@ namespace mitk {
 
     void GrabImage();
 
+    /**
+    * \brief Returns the number of frames grabbed from the image source since the device was activated.
+    */
+    std::uint64_t GetNumberOfGrabbedFrames() const;
+
+    /**
+    * \brief Returns the number of grabbed frames which never reached the outputs, because a newer frame was
+    * grabbed before the device was updated again.
+    */
+    std::uint64_t GetNumberOfDroppedFrames() const;
+
+    void ResetFrameCounters();
+
     /**
     * \brief Returns all probes for this device or an empty vector it no probes were set
     * Returns a std::vector of all probes that exist for this device if there were probes set while creating or modifying this USVideoDevice.
@@ -383,7 +397,13 @@ namespace mitk {
     static ITK_THREAD_RETURN_TYPE Acquire(void* pInfoStruct);
     static ITK_THREAD_RETURN_TYPE ConnectThread(void* pInfoStruct);
 
-    std::vector<mitk::Image::Pointer> m_ImageVector;
+    std::vector<mitk::Image::Pointer> m_ImageVector; ///< the frame in the outputs, owned by m_FramePool
+
+    /**
+    * \brief Preallocated frames handed over from the acquisition thread to GenerateData().
+    * The outputs reference the memory of the acquired frame instead of copying it.
+    */
+    USImageFramePool m_FramePool;
 
     // Variables to determine if spacing was calibrated and needs to be applied to the incoming images
     mitk::Vector3D m_Spacing;
@@ -0,0 +1,158 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkUSImageFramePool.h"
+#include "mitkImageReadAccessor.h"
+
+#include <algorithm>
+
+mitk::USImageFramePool::USImageFramePool(unsigned int numberOfBuffers)
+  : m_Buffers(std::max(2u, numberOfBuffers)),
+    m_NumberOfPublishedFrames(0),
+    m_NumberOfAcquiredFrames(0),
+    m_NumberOfDroppedFrames(0)
+{
+  for (auto &buffer : m_Buffers)
+    buffer.State = Free;
+}
+
+void mitk::USImageFramePool::Publish(const std::vector<Image::Pointer> &frame)
+{
+  Buffer *buffer = nullptr;
+
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    // prefer a free buffer, otherwise overwrite the frame which is waiting for the consumer
+    for (auto &candidate : m_Buffers)
+    {
+      if (candidate.State == Free)
+      {
+        buffer = &candidate;
+        break;
+      }
+    }
+
+    if (buffer == nullptr)
+    {
+      for (auto &candidate : m_Buffers)
+      {
+        if (candidate.State == Ready)
+        {
+          buffer = &candidate;
+          ++m_NumberOfDroppedFrames;
+          break;
+        }
+      }
+    }
+
+    // cannot happen with a single producer, since only one buffer is read at a time
+    if (buffer == nullptr)
+      return;
+
+    buffer->State = Writing;
+  }
+
+  // copy without holding the lock, the consumer never touches a buffer in the writing state
+  buffer->Images.resize(frame.size());
+  for (std::size_t i = 0; i < frame.size(); ++i)
+  {
+    if (frame[i].IsNull() || !frame[i]->IsInitialized())
+      buffer->Images[i] = nullptr;
+    else
+      CopyImage(frame[i], buffer->Images[i]);
+  }
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  for (auto &other : m_Buffers)
+  {
+    if (other.State == Ready)
+    {
+      other.State = Free;
+      ++m_NumberOfDroppedFrames;
+    }
+  }
+  buffer->State = Ready;
+  ++m_NumberOfPublishedFrames;
+}
+
+bool mitk::USImageFramePool::AcquireLatest(std::vector<Image::Pointer> &frame)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  Buffer *latest = nullptr;
+  for (auto &buffer : m_Buffers)
+  {
+    if (buffer.State == Ready)
+      latest = &buffer;
+  }
+
+  if (latest == nullptr)
+    return false;
+
+  for (auto &buffer : m_Buffers)
+  {
+    if (buffer.State == Reading)
+      buffer.State = Free;
+  }
+
+  latest->State = Reading;
+  frame = latest->Images;
+  ++m_NumberOfAcquiredFrames;
+  return true;
+}
+
+unsigned int mitk::USImageFramePool::GetNumberOfBuffers() const
+{
+  return static_cast<unsigned int>(m_Buffers.size());
+}
+
+std::uint64_t mitk::USImageFramePool::GetNumberOfPublishedFrames() const
+{
+  return m_NumberOfPublishedFrames;
+}
+
+std::uint64_t mitk::USImageFramePool::GetNumberOfAcquiredFrames() const
+{
+  return m_NumberOfAcquiredFrames;
+}
+
+std::uint64_t mitk::USImageFramePool::GetNumberOfDroppedFrames() const
+{
+  return m_NumberOfDroppedFrames;
+}
+
+void mitk::USImageFramePool::ResetCounters()
+{
+  m_NumberOfPublishedFrames = 0;
+  m_NumberOfAcquiredFrames = 0;
+  m_NumberOfDroppedFrames = 0;
+}
+
+void mitk::USImageFramePool::CopyImage(const Image *image, Image::Pointer &target)
+{
+  if (target.IsNull() || !target->IsInitialized() ||
+    target->GetDimension() != image->GetDimension() ||
+    target->GetDimension(0) != image->GetDimension(0) ||
+    target->GetDimension(1) != image->GetDimension(1) ||
+    target->GetDimension(2) != image->GetDimension(2) ||
+    target->GetPixelType() != image->GetPixelType())
+  {
+    target = Image::New();
+    target->Initialize(image->GetPixelType(), image->GetDimension(), image->GetDimensions());
+  }
+
+  // copies into the memory of the existing volume, which is only allocated by the first frame of this size
+  mitk::ImageReadAccessor readAccessor(image);
+  target->SetImportVolume(readAccessor.GetData());
+  target->SetGeometry(image->GetGeometry());
+}
@@ -0,0 +1,105 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkUSImageFramePool_h
+#define mitkUSImageFramePool_h
+
+#include <MitkUSExports.h>
+#include <mitkImage.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace mitk {
+  /**
+  * \brief Recycles a fixed number of frame buffers between the acquisition thread of a mitk::USDevice and the
+  * thread updating the device (and rendering its outputs).
+  *
+  * The acquisition thread copies each new frame into a free buffer with Publish(). The consumer takes the latest
+  * published frame with AcquireLatest() and keeps it until it acquires the next one, so the images returned by
+  * AcquireLatest() are never written while they are in use and can be referenced instead of copied. With the
+  * default of three buffers (triple buffering) neither side ever waits for the other one. If the consumer is
+  * slower than the device, frames which were published but never acquired are counted as dropped.
+  *
+  * The buffers are only allocated again if the size or pixel type of the frames changes.
+  *
+  * Publish() must only be called by one thread and AcquireLatest() only by one other thread.
+  *
+  * \ingroup US
+  */
+  class MITKUS_EXPORT USImageFramePool
+  {
+  public:
+    /**
+    * \param numberOfBuffers at least two (double buffering)
+    */
+    explicit USImageFramePool(unsigned int numberOfBuffers = 3);
+
+    USImageFramePool(const USImageFramePool &) = delete;
+    USImageFramePool &operator=(const USImageFramePool &) = delete;
+
+    /**
+    * \brief Copies the images of a new frame (one image per output) into a free buffer and makes it the latest one.
+    * Null or uninitialized images are kept as null images.
+    */
+    void Publish(const std::vector<Image::Pointer> &frame);
+
+    /**
+    * \brief Returns the latest published frame, if there is one that was not acquired before.
+    * The previously acquired frame is released and may be overwritten by following calls of Publish().
+    *
+    * \return false if no new frame was published since the last call, frame is not changed then
+    */
+    bool AcquireLatest(std::vector<Image::Pointer> &frame);
+
+    unsigned int GetNumberOfBuffers() const;
+
+    /** \return Returns the number of frames passed to Publish(). */
+    std::uint64_t GetNumberOfPublishedFrames() const;
+
+    /** \return Returns the number of frames returned by AcquireLatest(). */
+    std::uint64_t GetNumberOfAcquiredFrames() const;
+
+    /** \return Returns the number of frames which were overwritten by a newer frame before they were acquired. */
+    std::uint64_t GetNumberOfDroppedFrames() const;
+
+    void ResetCounters();
+
+  private:
+    enum BufferState
+    {
+      Free,
+      Writing,
+      Ready,
+      Reading
+    };
+
+    struct Buffer
+    {
+      BufferState State;
+      std::vector<Image::Pointer> Images;
+    };
+
+    static void CopyImage(const Image *image, Image::Pointer &target);
+
+    std::vector<Buffer> m_Buffers;
+    std::mutex m_Mutex;
+
+    std::atomic<std::uint64_t> m_NumberOfPublishedFrames;
+    std::atomic<std::uint64_t> m_NumberOfAcquiredFrames;
+    std::atomic<std::uint64_t> m_NumberOfDroppedFrames;
+  };
+} // namespace mitk
+
+#endif
@@ -6,6 +6,7 @@ mitkUSActivator.cpp
 ## Model Classes
 USModel/mitkUSImage.cpp
 USModel/mitkUSImageMetadata.cpp
+USModel/mitkUSImageFramePool.cpp
 USModel/mitkUSDevice.cpp
 USModel/mitkUSIGTLDevice.cpp
 USModel/mitkUSVideoDevice.cpp
@@ -17,6 +18,8 @@ USModel/mitkUSDeviceWriterXML.cpp
 
 ## Filters and Sources
 USFilters/mitkUSImageLoggingFilter.cpp
+USFilters/mitkUSImageStreamWriter.cpp
+USFilters/mitkUSImageStreamReader.cpp
 USFilters/mitkUSImageSource.cpp
 USFilters/mitkUSImageVideoSource.cpp
 USFilters/mitkIGTLMessageToUSImageFilter.cpp
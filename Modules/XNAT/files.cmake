@@ -2,6 +2,7 @@ file(GLOB_RECURSE H_FILES RELATIVE "${CMAKE_CURRENT_SOURCE_DIR}" "${CMAKE_CURREN
 
 set(CPP_FILES
   mitkXnatSessionTracker.cpp
+  mitkXnatFileDownloader.cpp
   QmitkXnatTreeModel.cpp
   QmitkXnatProjectWidget.cpp
   QmitkXnatSubjectWidget.cpp
@@ -14,6 +15,7 @@ set(CPP_FILES
 
 set(MOC_H_FILES
  include/mitkXnatSessionTracker.h
+ include/mitkXnatFileDownloader.h
  include/QmitkXnatTreeModel.h
  include/QmitkXnatProjectWidget.h
  include/QmitkXnatSubjectWidget.h
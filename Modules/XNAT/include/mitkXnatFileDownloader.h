@@ -0,0 +1,99 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITKXNATFILEDOWNLOADER_H
+#define MITKXNATFILEDOWNLOADER_H
+
+#include "MitkXNATExports.h"
+
+#include <QDir>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QStringList>
+
+class ctkXnatFile;
+class ctkXnatObject;
+class ctkXnatSession;
+class QFile;
+class QNetworkAccessManager;
+class QNetworkReply;
+
+namespace mitk
+{
+  /**
+   * \brief Downloads the files of an XNAT resource (e.g. the DICOM folder of a scan) file by file.
+   *
+   * In contrast to ctkXnatObject::download(), which requests the whole resource as one zip archive that
+   * has to be stored and extracted afterwards, every file is requested on its own and written directly
+   * into the target directory. Up to GetMaximumNumberOfConnections() files are transferred at the same time.
+   *
+   * Transfers are resumable: a file is written to "<name>.part" and only renamed when it is complete.
+   * If a download is interrupted, the next download of the resource continues the partial files with
+   * HTTP range requests and skips all files that already exist with the size reported by the server.
+   *
+   * DownloadFiles() blocks in a local event loop until all transfers have finished.
+   */
+  class MITKXNAT_EXPORT XnatFileDownloader : public QObject
+  {
+    Q_OBJECT
+
+  public:
+    explicit XnatFileDownloader(ctkXnatSession *session, QObject *parent = nullptr);
+    ~XnatFileDownloader() override;
+
+    /** \brief Number of files that are transferred in parallel (default 4). */
+    void SetMaximumNumberOfConnections(int maximumNumberOfConnections);
+    int GetMaximumNumberOfConnections() const;
+
+    /**
+     * \brief Downloads all files of the resource into the directory, which is created if necessary.
+     *
+     * \return true if all files are available in the directory afterwards
+     */
+    bool DownloadFiles(ctkXnatObject *resource, const QDir &directory);
+
+    /** \brief Names of the files that could not be downloaded by the last call of DownloadFiles(). */
+    QStringList GetFailedFiles() const;
+
+  signals:
+    void Progress(int finishedFiles, int totalFiles);
+    void Finished();
+
+  private:
+    struct Transfer
+    {
+      ctkXnatFile *File;
+      QString FilePath;
+      QFile *PartFile;
+      qint64 Offset;
+    };
+
+    void StartNextTransfers();
+    void StartTransfer(ctkXnatFile *file);
+    void OnReadyRead(QNetworkReply *reply);
+    void OnTransferFinished(QNetworkReply *reply);
+
+    ctkXnatSession *m_Session;
+    QNetworkAccessManager *m_NetworkAccessManager;
+    int m_MaximumNumberOfConnections;
+
+    QDir m_Directory;
+    QList<ctkXnatFile *> m_PendingFiles;
+    QHash<QNetworkReply *, Transfer> m_Transfers;
+    QStringList m_FailedFiles;
+    int m_FinishedFiles;
+    int m_TotalFiles;
+  };
+}
+
+#endif // MITKXNATFILEDOWNLOADER_H
@@ -0,0 +1,218 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkXnatFileDownloader.h"
+
+#include <mitkLogMacros.h>
+
+#include <ctkXnatFile.h>
+#include <ctkXnatObject.h>
+#include <ctkXnatSession.h>
+
+#include <QEventLoop>
+#include <QFile>
+#include <QFileInfo>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+
+#include <algorithm>
+
+namespace mitk
+{
+  XnatFileDownloader::XnatFileDownloader(ctkXnatSession *session, QObject *parent)
+    : QObject(parent),
+      m_Session(session),
+      m_NetworkAccessManager(new QNetworkAccessManager(this)),
+      m_MaximumNumberOfConnections(4),
+      m_FinishedFiles(0),
+      m_TotalFiles(0)
+  {
+  }
+
+  XnatFileDownloader::~XnatFileDownloader()
+  {
+    for (auto iter = m_Transfers.begin(); iter != m_Transfers.end(); ++iter)
+    {
+      iter.key()->abort();
+      delete iter.value().PartFile;
+    }
+  }
+
+  void XnatFileDownloader::SetMaximumNumberOfConnections(int maximumNumberOfConnections)
+  {
+    m_MaximumNumberOfConnections = std::max(1, maximumNumberOfConnections);
+  }
+
+  int XnatFileDownloader::GetMaximumNumberOfConnections() const
+  {
+    return m_MaximumNumberOfConnections;
+  }
+
+  QStringList XnatFileDownloader::GetFailedFiles() const
+  {
+    return m_FailedFiles;
+  }
+
+  bool XnatFileDownloader::DownloadFiles(ctkXnatObject *resource, const QDir &directory)
+  {
+    m_PendingFiles.clear();
+    m_FailedFiles.clear();
+    m_FinishedFiles = 0;
+    m_TotalFiles = 0;
+    m_Directory = directory;
+
+    if (m_Session == nullptr || resource == nullptr || !m_Directory.mkpath("."))
+      return false;
+
+    if (!resource->isFetched())
+      resource->fetch();
+
+    for (ctkXnatObject *child : resource->children())
+    {
+      auto *file = dynamic_cast<ctkXnatFile *>(child);
+      if (file == nullptr)
+        continue;
+
+      ++m_TotalFiles;
+
+      // Files that are complete from a former download are not transferred again
+      const QFileInfo fileInfo(m_Directory.filePath(file->name()));
+      const QString size = file->property("Size");
+      if (fileInfo.exists() && (size.isEmpty() || fileInfo.size() == size.toLongLong()))
+      {
+        ++m_FinishedFiles;
+        continue;
+      }
+      m_PendingFiles << file;
+    }
+
+    emit Progress(m_FinishedFiles, m_TotalFiles);
+
+    QEventLoop loop;
+    connect(this, &XnatFileDownloader::Finished, &loop, &QEventLoop::quit);
+    this->StartNextTransfers();
+    if (!m_Transfers.isEmpty())
+      loop.exec();
+
+    return m_FailedFiles.isEmpty();
+  }
+
+  void XnatFileDownloader::StartNextTransfers()
+  {
+    while (!m_PendingFiles.isEmpty() && m_Transfers.size() < m_MaximumNumberOfConnections)
+    {
+      this->StartTransfer(m_PendingFiles.takeFirst());
+    }
+
+    if (m_PendingFiles.isEmpty() && m_Transfers.isEmpty())
+      emit Finished();
+  }
+
+  void XnatFileDownloader::StartTransfer(ctkXnatFile *file)
+  {
+    Transfer transfer;
+    transfer.File = file;
+    transfer.FilePath = m_Directory.filePath(file->name());
+    transfer.PartFile = new QFile(transfer.FilePath + ".part");
+
+    if (!transfer.PartFile->open(QIODevice::WriteOnly | QIODevice::Append))
+    {
+      MITK_WARN << "Cannot write " << transfer.PartFile->fileName().toStdString();
+      delete transfer.PartFile;
+      m_FailedFiles << file->name();
+      ++m_FinishedFiles;
+      emit Progress(m_FinishedFiles, m_TotalFiles);
+      return;
+    }
+    transfer.Offset = transfer.PartFile->size();
+
+    const QString size = file->property("Size");
+    if (transfer.Offset > 0 && !size.isEmpty() && transfer.Offset == size.toLongLong())
+    {
+      // The transfer was interrupted after the last byte was written
+      transfer.PartFile->close();
+      QFile::remove(transfer.FilePath);
+      transfer.PartFile->rename(transfer.FilePath);
+      delete transfer.PartFile;
+      ++m_FinishedFiles;
+      emit Progress(m_FinishedFiles, m_TotalFiles);
+      return;
+    }
+
+    QNetworkRequest request(QUrl(m_Session->url().toString() + file->resourceUri()));
+    request.setRawHeader("Cookie", "JSESSIONID=" + m_Session->sessionId().toUtf8());
+    if (transfer.Offset > 0)
+      request.setRawHeader("Range", "bytes=" + QByteArray::number(transfer.Offset) + "-");
+
+    QNetworkReply *reply = m_NetworkAccessManager->get(request);
+    m_Transfers.insert(reply, transfer);
+
+    connect(reply, &QNetworkReply::readyRead, this, [this, reply]() { this->OnReadyRead(reply); });
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() { this->OnTransferFinished(reply); });
+  }
+
+  void XnatFileDownloader::OnReadyRead(QNetworkReply *reply)
+  {
+    auto iter = m_Transfers.find(reply);
+    if (iter == m_Transfers.end())
+      return;
+
+    const int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (statusCode >= 400)
+    {
+      // Error pages are not written into the partial file
+      reply->readAll();
+      return;
+    }
+
+    Transfer &transfer = iter.value();
+    if (transfer.Offset > 0)
+    {
+      // Servers that ignore the range request send the whole file
+      if (statusCode != 206)
+        transfer.PartFile->resize(0);
+      transfer.Offset = 0;
+    }
+    transfer.PartFile->write(reply->readAll());
+  }
+
+  void XnatFileDownloader::OnTransferFinished(QNetworkReply *reply)
+  {
+    this->OnReadyRead(reply);
+
+    Transfer transfer = m_Transfers.take(reply);
+    transfer.PartFile->close();
+
+    if (reply->error() == QNetworkReply::NoError)
+    {
+      QFile::remove(transfer.FilePath);
+      if (!transfer.PartFile->rename(transfer.FilePath))
+        m_FailedFiles << transfer.File->name();
+    }
+    else
+    {
+      // The partial file is kept, the next download continues it
+      MITK_WARN << "Download of " << transfer.File->name().toStdString()
+                << " failed: " << reply->errorString().toStdString();
+      m_FailedFiles << transfer.File->name();
+    }
+
+    delete transfer.PartFile;
+    reply->deleteLater();
+
+    ++m_FinishedFiles;
+    emit Progress(m_FinishedFiles, m_TotalFiles);
+
+    this->StartNextTransfers();
+  }
+}
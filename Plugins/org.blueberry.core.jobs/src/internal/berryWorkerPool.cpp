@@ -18,6 +18,9 @@ found in the LICENSE file.
 #include <Poco/Timestamp.h>
 #include <Poco/Timespan.h>
 
+#include <algorithm>
+#include <thread>
+
 #include <math.h>
 
 namespace berry
@@ -32,6 +35,7 @@ WorkerPool::WorkerPool(JobManager* myJobManager) :
 
 const long WorkerPool::BEST_BEFORE = 60000;
 const int WorkerPool::MIN_THREADS = 1;
+const int WorkerPool::MAX_THREADS = std::max(8, 2 * static_cast<int>(std::thread::hardware_concurrency()));
 
 
 void WorkerPool::Shutdown()
@@ -47,6 +51,7 @@ void WorkerPool::Add(Worker::Pointer worker)
 {
   Poco::Mutex::ScopedLock lock(m_mutexOne);
   m_threads.push_back(worker);
+  ++m_numThreads;
 }
 
 void WorkerPool::DecrementBusyThreads()
@@ -76,7 +81,11 @@ bool WorkerPool::Remove(Worker::Pointer worker)
   auto end = std::remove(m_threads.begin(),
       m_threads.end(), worker);
   bool removed = end != m_threads.end();
-  m_threads.erase(end);
+  if (removed)
+  {
+    m_threads.erase(end, m_threads.end());
+    --m_numThreads;
+  }
 
   return removed;
 }
@@ -185,8 +194,9 @@ void WorkerPool::JobQueued()
     notify();
     return;
   }
-  //create a thread if all threads are busy
-  if (m_busyThreads >= m_numThreads)
+  //create a thread if all threads are busy, unless the pool is full; queued jobs
+  //are then started by the next worker which finishes its job
+  if (m_busyThreads >= m_numThreads && m_numThreads < MAX_THREADS)
   {
     WorkerPool::WeakPtr wp_WorkerPool(WorkerPool::Pointer(this));
     Worker::Pointer sptr_worker(new Worker(wp_WorkerPool));
@@ -97,6 +97,11 @@ private:
    */
   static const int MIN_THREADS;
 
+  /**
+   * There will never be more than MAX_THREADS workers in the pool.
+   */
+  static const int MAX_THREADS;
+
   /**
    * Mutex (mutual exclusion) is a synchronization mechanism used to control access to a shared resource in
    * a concurrent (multithreaded) scenario.
@@ -70,7 +70,7 @@ void org_mitk_core_services_Activator::start(ctkPluginContext* context)
   pluginContext = context;
 
   //initialize logging
-  mitk::LoggingBackend::Register();
+  mitk::LoggingBackend::Register(true);
   QString logFilenamePrefix = "mitk";
   QFileInfo path = context->getDataFile(logFilenamePrefix);
   try
@@ -133,10 +133,30 @@ namespace mitk {
 #endif
 
     // Do the actual work of loading the data into the data storage
-    DataStorage::SetOfObjects::Pointer data;
+    // Scene files need the data storage while reading, all other files are read concurrently
+    QStringList sceneFileNames;
+    QStringList otherFileNames;
+    for (const auto &fileName : fileNames)
+    {
+      if (fileName.endsWith(".mitk", Qt::CaseInsensitive))
+        sceneFileNames << fileName;
+      else
+        otherFileNames << fileName;
+    }
+
+    DataStorage::SetOfObjects::Pointer data = DataStorage::SetOfObjects::New();
     try
     {
-      data = QmitkIOUtil::Load(fileNames, *dataStorage);
+      if (!otherFileNames.empty())
+      {
+        data = QmitkIOUtil::LoadConcurrently(otherFileNames, *dataStorage);
+      }
+      if (!sceneFileNames.empty())
+      {
+        DataStorage::SetOfObjects::Pointer sceneData = QmitkIOUtil::Load(sceneFileNames, *dataStorage);
+        for (const auto &node : *sceneData)
+          data->push_back(node);
+      }
     }
     catch (const mitk::Exception& e)
     {
@@ -66,6 +66,7 @@ found in the LICENSE file.
 #include <mitkIDataStorageReference.h>
 #include <mitkDataStorageEditorInput.h>
 #include <mitkWorkbenchUtil.h>
+#include <mitkTracing.h>
 #include <vtkVersionMacros.h>
 
 // UGLYYY
@@ -77,6 +78,7 @@ found in the LICENSE file.
 #include <QToolButton>
 #include <QMessageBox>
 #include <QMouseEvent>
+#include <QFileDialog>
 #include <QLabel>
 #include <QmitkAboutDialog.h>
 
@@ -724,6 +726,14 @@ void QmitkExtWorkbenchWindowAdvisor::PostWindowCreate()
     helpMenu->addAction("&Open Help Perspective", this, SLOT(onHelpOpenHelpPerspective()));
     helpMenu->addAction("&Context Help",this, SLOT(onHelp()),  QKeySequence("F1"));
     helpMenu->addAction("&About",this, SLOT(onAbout()));
+#ifdef MITK_ENABLE_TRACING
+    helpMenu->addSeparator();
+    QAction* recordTraceAction = helpMenu->addAction("Record &Trace");
+    recordTraceAction->setToolTip("Records the time spent in loading, rendering and interaction for performance analysis");
+    recordTraceAction->setCheckable(true);
+    recordTraceAction->setChecked(mitk::Tracing::IsEnabled());
+    QObject::connect(recordTraceAction, SIGNAL(toggled(bool)), QmitkExtWorkbenchWindowAdvisorHack::undohack, SLOT(onRecordTrace(bool)));
+#endif
     // =====================================================
   }
   else
@@ -1218,6 +1228,31 @@ void QmitkExtWorkbenchWindowAdvisorHack::onAbout()
   aboutDialog->open();
 }
 
+void QmitkExtWorkbenchWindowAdvisorHack::onRecordTrace(bool record)
+{
+  if (record)
+  {
+    mitk::Tracing::SetEnabled(true);
+    return;
+  }
+
+  QString fileName = QFileDialog::getSaveFileName(QApplication::activeWindow(),
+                                                  "Save Trace",
+                                                  QString(),
+                                                  "Chrome trace (*.json)");
+  if (!fileName.isEmpty())
+  {
+    if (!fileName.endsWith(".json", Qt::CaseInsensitive))
+      fileName += ".json";
+
+    if (!mitk::Tracing::WriteChromeTrace(fileName.toStdString()))
+    {
+      QMessageBox::warning(QApplication::activeWindow(), "Save Trace", "The trace could not be written to " + fileName + ".");
+    }
+  }
+  mitk::Tracing::SetEnabled(false);
+}
+
 void QmitkExtWorkbenchWindowAdvisor::HookTitleUpdateListeners(berry::IWorkbenchWindowConfigurer::Pointer configurer)
 {
   // hook up the listeners to update the window title
@@ -46,6 +46,12 @@ class QmitkExtWorkbenchWindowAdvisorHack : public QObject
      */
     void onAbout();
 
+    /**
+     * @brief Starts recording a trace of the hot paths (see mitk::Tracing) if @a record is true, otherwise
+     * stops recording and asks for the file the trace is saved to.
+     */
+    void onRecordTrace(bool record);
+
   public:
 
     QmitkExtWorkbenchWindowAdvisorHack();
@@ -23,8 +23,6 @@ found in the LICENSE file.
 #include <mitkPlaneGeometry.h>
 #include <mitkNodePredicateDataType.h>
 #include <mitkStatusBar.h>
-#include <mitkPixelTypeMultiplex.h>
-#include <mitkImagePixelReadAccessor.h>
 #include <mitkNodePredicateProperty.h>
 
 #include <mitkCompositePixelValueToString.h>
@@ -210,15 +208,15 @@ void QmitkImageNavigatorView::UpdateStatusBar()
 
       if (image3D.IsNotNull() && statusBar != nullptr)
       {
-        itk::Index<3> p;
-        image3D->GetGeometry()->WorldToIndex(position, p);
+        const auto lookup = m_PixelValueLookup.Lookup(image3D, position, globalCurrentTimePoint, component);
+        const auto &p = lookup.Index;
 
         auto pixelType = image3D->GetChannelDescriptor().GetPixelType().GetPixelType();
 
         if (pixelType == itk::ImageIOBase::RGB || pixelType == itk::ImageIOBase::RGBA)
         {
           std::string pixelValue = "Pixel RGB(A) value: ";
-          pixelValue.append(ConvertCompositePixelValueToString(image3D, p));
+          pixelValue.append(lookup.IsInside ? ConvertCompositePixelValueToString(lookup.Components) : "Out of bounds");
           statusBar->DisplayImageInfo(position, p, globalCurrentTimePoint, pixelValue.c_str());
         }
         else if (pixelType == itk::ImageIOBase::DIFFUSIONTENSOR3D || pixelType == itk::ImageIOBase::SYMMETRICSECONDRANKTENSOR)
@@ -226,20 +224,13 @@ void QmitkImageNavigatorView::UpdateStatusBar()
           std::string pixelValue = "See ODF Details view. ";
           statusBar->DisplayImageInfo(position, p, globalCurrentTimePoint, pixelValue.c_str());
         }
+        else if (lookup.IsInside)
+        {
+          statusBar->DisplayImageInfo(position, p, globalCurrentTimePoint, lookup.Value);
+        }
         else
         {
-          itk::Index<3> p;
-          image3D->GetGeometry()->WorldToIndex(position, p);
-          mitk::ScalarType pixelValue;
-          mitkPixelTypeMultiplex5(
-            mitk::FastSinglePixelAccess,
-            image3D->GetChannelDescriptor().GetPixelType(),
-            image3D,
-            image3D->GetVolumeData(image3D->GetTimeGeometry()->TimePointToTimeStep(globalCurrentTimePoint)),
-            p,
-            pixelValue,
-            component);
-          statusBar->DisplayImageInfo(position, p, globalCurrentTimePoint, pixelValue);
+          statusBar->DisplayImageInfoInvalid();
         }
       }
       else
@@ -17,6 +17,7 @@ found in the LICENSE file.
 
 #include <QmitkAbstractView.h>
 #include <mitkIRenderWindowPartListener.h>
+#include <mitkImagePixelValueLookup.h>
 
 #include "ui_QmitkImageNavigatorViewControls.h"
 
@@ -89,6 +90,8 @@ protected:
   QWidget* m_Parent;
 
   mitk::IRenderWindowPart* m_IRenderWindowPart;
+
+  mitk::ImagePixelValueLookup m_PixelValueLookup;
   /**
    * @brief GetDecorationColorOfGeometry helper method to get the color of a helper geometry node.
    * @param renderWindow The renderwindow of the geometry
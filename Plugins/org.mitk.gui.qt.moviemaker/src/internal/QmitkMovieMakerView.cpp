@@ -24,6 +24,7 @@ found in the LICENSE file.
 #include <berryPlatform.h>
 
 #include <mitkGL.h>
+#include <mitkIRenderWindowPart.h>
 
 #include <QmitkFFmpegWriter.h>
 
@@ -32,7 +33,12 @@ found in the LICENSE file.
 #include <QMessageBox>
 #include <QTimer>
 
+#include <vtkImageData.h>
+#include <vtkRenderLargeImage.h>
+#include <vtkRenderer.h>
+
 #include <array>
+#include <cstring>
 
 namespace
 {
@@ -67,6 +73,37 @@ namespace
     renderWindow->MakeCurrent();
     glReadPixels(x, y, width, height, GL_RGB, GL_UNSIGNED_BYTE, frame.get());
   }
+
+  void ReadMagnifiedPixels(std::unique_ptr<unsigned char[]>& frame, vtkRenderLargeImage* magnifier, int width, int height)
+  {
+    // the tiles are rendered into the back buffer, the image is not limited to the screen resolution
+    magnifier->Modified();
+    magnifier->Update();
+
+    auto image = magnifier->GetOutput();
+    const int* dimensions = image->GetDimensions();
+    const int numberOfComponents = image->GetNumberOfScalarComponents();
+    const auto* pixels = static_cast<const unsigned char*>(image->GetScalarPointer());
+
+    if (nullptr == pixels || dimensions[0] < width || dimensions[1] < height || numberOfComponents < 3)
+      return;
+
+    for (int y = 0; y < height; ++y)
+    {
+      const unsigned char* source = pixels + static_cast<size_t>(y) * dimensions[0] * numberOfComponents;
+      unsigned char* target = frame.get() + static_cast<size_t>(y) * width * 3;
+
+      if (3 == numberOfComponents)
+      {
+        std::memcpy(target, source, static_cast<size_t>(width) * 3);
+      }
+      else
+      {
+        for (int x = 0; x < width; ++x)
+          std::memcpy(target + x * 3, source + x * numberOfComponents, 3);
+      }
+    }
+  }
 }
 
 const std::string QmitkMovieMakerView::VIEW_ID = "org.mitk.views.moviemaker";
@@ -317,11 +354,18 @@ void QmitkMovieMakerView::OnRecordButtonClicked()
   if (nullptr == renderWindow)
     return;
 
-  const int border = 3;
+  const int magnification = m_Ui->magnificationSpinBox->value();
+  auto renderer = mitk::BaseRenderer::GetInstance(renderWindow);
+
+  if (magnification > 1 && nullptr == renderer)
+    return;
+
+  // the border of the render window is only excluded when reading the on-screen pixels
+  const int border = magnification > 1 ? 0 : 3;
   const int x = border;
   const int y = border;
-  int width = renderWindow->GetSize()[0] - border * 2;
-  int height = renderWindow->GetSize()[1] - border * 2;
+  int width = renderWindow->GetSize()[0] * magnification - border * 2;
+  int height = renderWindow->GetSize()[1] * magnification - border * 2;
 
   if (width & 1)
     --width;
@@ -345,25 +389,66 @@ void QmitkMovieMakerView::OnRecordButtonClicked()
 
   m_FFmpegWriter->SetOutputPath(saveFileName);
 
+  vtkSmartPointer<vtkRenderLargeImage> magnifier;
+  auto renderWindowPart = this->GetRenderWindowPart();
+  bool doubleBuffering = renderWindow->GetDoubleBuffer();
+
+  if (magnification > 1)
+  {
+    magnifier = vtkSmartPointer<vtkRenderLargeImage>::New();
+    magnifier->SetInput(renderer->GetVtkRenderer());
+    magnifier->SetMagnification(magnification);
+
+    // decorations like the corner annotations cannot be tiled by vtkRenderLargeImage
+    if (nullptr != renderWindowPart)
+      renderWindowPart->EnableDecorations(false);
+
+    renderWindow->DoubleBufferOff();
+  }
+
+  auto restoreRenderWindow = [&]() {
+    if (magnifier.GetPointer() == nullptr)
+      return;
+
+    renderWindow->SetDoubleBuffer(doubleBuffering);
+
+    if (nullptr != renderWindowPart)
+      renderWindowPart->EnableDecorations(true);
+  };
+
   try
   {
-    auto frame = std::make_unique<unsigned char[]>(width * height * 3);
+    auto frame = std::make_unique<unsigned char[]>(static_cast<size_t>(width) * height * 3);
     m_FFmpegWriter->Start();
 
+    // FFmpeg encodes in its own process, so it encodes the previous frame while the next one is rendered
     for (m_CurrentFrame = 0; m_CurrentFrame < m_NumFrames; ++m_CurrentFrame)
     {
       this->RenderCurrentFrame();
-      ReadPixels(frame, renderWindow, x, y, width, height);
+
+      if (magnifier.GetPointer() != nullptr)
+      {
+        ReadMagnifiedPixels(frame, magnifier, width, height);
+      }
+      else
+      {
+        ReadPixels(frame, renderWindow, x, y, width, height);
+      }
+
       m_FFmpegWriter->WriteFrame(frame.get());
     }
 
     m_FFmpegWriter->Stop();
 
+    restoreRenderWindow();
+
     m_CurrentFrame = 0;
     this->RenderCurrentFrame();
   }
   catch (const mitk::Exception& exception)
   {
+    restoreRenderWindow();
+
     m_CurrentFrame = 0;
     this->RenderCurrentFrame();
 
@@ -27,6 +27,8 @@ found in the LICENSE file.
 #include <vtkProperty.h>
 
 QmitkRemeshingView::QmitkRemeshingView()
+  : m_MaxNumberOfVertices(0),
+    m_Remesher(mitk::ACVD::RemeshFilter::New())
 {
 }
 
@@ -65,6 +67,7 @@ void QmitkRemeshingView::OnSelectedSurfaceChanged(const mitk::DataNode *node)
   else
   {
     m_MaxNumberOfVertices = 0;
+    m_Remesher = mitk::ACVD::RemeshFilter::New();
     this->EnableWidgets(false);
   }
 }
@@ -108,7 +111,7 @@ void QmitkRemeshingView::OnRemeshButtonClicked()
 
   bool boundaryFixing = m_Controls.preserveEdgesCheckBox->isChecked();
 
-  mitk::ACVD::RemeshFilter::Pointer remesher = mitk::ACVD::RemeshFilter::New();
+  auto remesher = m_Remesher;
   remesher->SetInput(surface);
   remesher->SetTimeStep(0);
   remesher->SetNumVertices(numVertices);
@@ -118,6 +121,7 @@ void QmitkRemeshingView::OnRemeshButtonClicked()
   remesher->SetOptimizationLevel(1.0);
   remesher->SetForceManifold(false);
   remesher->SetBoundaryFixing(boundaryFixing);
+  remesher->Modified(); // Every click creates a new surface, even with unchanged parameters
 
   try
   {
@@ -14,6 +14,7 @@ found in the LICENSE file.
 #define QmitkRemeshingView_h
 
 #include <QmitkAbstractView.h>
+#include <mitkACVD.h>
 #include <ui_QmitkRemeshingViewControls.h>
 
 class QmitkRemeshingView : public QmitkAbstractView
@@ -37,6 +38,9 @@ private:
 
   Ui::QmitkRemeshingViewControls m_Controls;
   int m_MaxNumberOfVertices;
+
+  /// Kept across remeshing runs, so that remeshing the same surface again reuses its prepared meshes
+  mitk::ACVD::RemeshFilter::Pointer m_Remesher;
 };
 
 #endif
@@ -47,9 +47,7 @@ found in the LICENSE file.
 // MITK
 #include <mitkDataStorage.h>
 #include <QmitkIOUtil.h>
-
-// Poco
-#include <Poco/Zip/Decompress.h>
+#include <mitkXnatFileDownloader.h>
 
 const QString QmitkXnatEditor::EDITOR_ID = "org.mitk.editors.xnat.browser";
 
@@ -407,18 +405,12 @@ void QmitkXnatEditor::InternalFileDownload(const QModelIndex& index)
       {
         ctkXnatObject* parent = file->parent();
 
-        QString filePath = m_DownloadPath + parent->property("label") + ".zip";
-        parent->download(filePath);
-
-        std::ifstream in(filePath.toStdString().c_str(), std::ios::binary);
-        poco_assert(in);
-
-        // decompress to XNAT_DOWNLOAD dir
-        Poco::Zip::Decompress dec(in, Poco::Path(m_DownloadPath.toStdString()));
-        dec.decompressAllFiles();
-
-        in.close();
-        QFile::remove(filePath);
+        // download the files of the series in parallel, without a zip archive
+        mitk::XnatFileDownloader downloader(parent->session());
+        if (!downloader.DownloadFiles(parent, QDir(m_DownloadPath + parent->property("label"))))
+        {
+          MITK_INFO << "Download of " << downloader.GetFailedFiles().join(", ").toStdString() << " failed!";
+        }
       }
       else
       {
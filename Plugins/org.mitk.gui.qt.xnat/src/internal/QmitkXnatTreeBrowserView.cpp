@@ -37,6 +37,7 @@ found in the LICENSE file.
 
 // MITK XNAT
 #include <mitkDataStorage.h>
+#include <mitkXnatFileDownloader.h>
 #include <QmitkIOUtil.h>
 #include <QmitkXnatProjectWidget.h>
 #include <QmitkXnatSubjectWidget.h>
@@ -60,8 +61,6 @@ found in the LICENSE file.
 
 #include <QmitkPreferencesDialog.h>
 
-// Poco
-#include <Poco/Zip/Decompress.h>
 
 const QString QmitkXnatTreeBrowserView::VIEW_ID = "org.mitk.views.xnat.treebrowser";
 
@@ -655,30 +654,22 @@ void QmitkXnatTreeBrowserView::InternalFileDownload(const QModelIndex& index, bo
 
 void QmitkXnatTreeBrowserView::InternalDICOMDownload(ctkXnatObject *obj, QDir &DICOMDirPath)
 {
-
-  QString filePath = m_DownloadPath + obj->property("label") + ".zip";
-
   this->SetStatusInformation("Downloading DICOM series " + obj->parent()->name());
-  // In case of DICOM zip download we do not know the total file size
-  // Because of that the dowload progres cannot be calculated
-  // Because of that we use the busy indicator of the progress bar by setting min and max to 0
   m_Controls.progressBar->setMinimum(0);
   m_Controls.progressBar->setMaximum(0);
   m_Controls.progressBar->show();
-  obj->download(filePath);
-
-  std::ifstream in(filePath.toStdString().c_str(), std::ios::binary);
-  poco_assert(in);
-
-  // decompress to XNAT_DOWNLOAD dir
-  Poco::Zip::Decompress dec(in, Poco::Path(DICOMDirPath.path().toStdString()), true);
-  dec.decompressAllFiles();
 
-  in.close();
-  QFile::remove(filePath);
+  // The files of the series are downloaded in parallel directly into the DICOM folder, so no zip archive
+  // has to be stored and extracted. Files that are complete from an interrupted download are skipped.
+  mitk::XnatFileDownloader downloader(obj->session());
+  connect(&downloader, &mitk::XnatFileDownloader::Progress, this, [this](int finishedFiles, int totalFiles) {
+    m_Controls.progressBar->setMaximum(totalFiles);
+    m_Controls.progressBar->setValue(finishedFiles);
+  });
+  const bool downloaded = downloader.DownloadFiles(obj, DICOMDirPath);
 
   // Checking if the file exists now
-  if (DICOMDirPath.exists())
+  if (downloaded && DICOMDirPath.exists())
   {
     if(!m_SilentMode)
     {
@@ -7,12 +7,14 @@ set(H_FILES
   mbilogBackendBase.h
   mbilogTextBackendBase.h
   mbilogBackendCout.h
+  mbilogBackendAsync.h
 )
 
 set(CPP_FILES
   mbilog.cpp
   mbilogLogMessage.cpp
   mbilogBackendCout.cpp
+  mbilogBackendAsync.cpp
   mbilogBackendBase.cpp
   mbilogTextBackendBase.cpp
 )
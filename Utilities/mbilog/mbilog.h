@@ -205,10 +205,32 @@ namespace mbilog
  * generated
   *        by the compiler.
   */
+#define MBI_FATAL mbilog::PseudoStream(mbilog::Fatal, __FILE__, __LINE__, __FUNCTION__)
+
+/** \brief Messages below MBILOG_MINIMUM_LEVEL (the cmake variable of the same name, or a define before including
+ *         this file) are removed at compile time, including the evaluation of their arguments.
+ */
+#ifndef MBILOG_MINIMUM_LEVEL
+#define MBILOG_MINIMUM_LEVEL 0 // mbilog::Info
+#endif
+
+#if MBILOG_MINIMUM_LEVEL <= 0
 #define MBI_INFO mbilog::PseudoStream(mbilog::Info, __FILE__, __LINE__, __FUNCTION__)
+#else
+#define MBI_INFO true ? mbilog::NullStream() : mbilog::NullStream()
+#endif
+
+#if MBILOG_MINIMUM_LEVEL <= 1
 #define MBI_WARN mbilog::PseudoStream(mbilog::Warn, __FILE__, __LINE__, __FUNCTION__)
+#else
+#define MBI_WARN true ? mbilog::NullStream() : mbilog::NullStream()
+#endif
+
+#if MBILOG_MINIMUM_LEVEL <= 2
 #define MBI_ERROR mbilog::PseudoStream(mbilog::Error, __FILE__, __LINE__, __FUNCTION__)
-#define MBI_FATAL mbilog::PseudoStream(mbilog::Fatal, __FILE__, __LINE__, __FUNCTION__)
+#else
+#define MBI_ERROR true ? mbilog::NullStream() : mbilog::NullStream()
+#endif
 
 /** \brief Macro for the debug messages. The messages are disabled if the cmake variable MBILOG_ENABLE_DEBUG is false.
  */
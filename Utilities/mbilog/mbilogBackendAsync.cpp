@@ -0,0 +1,140 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mbilogBackendAsync.h"
+#include "mbilogLoggingTypes.h"
+
+namespace
+{
+  /** Number of messages the writer thread writes before it reports progress to Flush() */
+  const unsigned int WriteBatchSize = 256;
+}
+
+mbilog::BackendAsync::BackendAsync(BackendBase *backend)
+  : m_Backend(backend),
+    m_Head(nullptr),
+    m_Tail(nullptr),
+    m_NumberOfQueuedMessages(0),
+    m_NumberOfWrittenMessages(0),
+    m_WriterIsIdle(false),
+    m_Stop(false)
+{
+  // the queue always contains a stub node, so pushing never has to touch the tail
+  auto *stub = new Node(LogMessage(Info, "", 0, ""));
+  stub->Message.moduleName = "";
+  m_Head.store(stub);
+  m_Tail = stub;
+
+  m_Writer = std::thread(&BackendAsync::Run, this);
+}
+
+mbilog::BackendAsync::~BackendAsync()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stop = true;
+  }
+  m_MessageQueued.notify_one();
+  m_Writer.join();
+
+  delete m_Tail;
+}
+
+void mbilog::BackendAsync::ProcessMessage(const mbilog::LogMessage &l)
+{
+  this->Push(new Node(l));
+
+  if (l.level == Fatal)
+    this->Flush();
+}
+
+mbilog::OutputType mbilog::BackendAsync::GetOutputType() const
+{
+  return m_Backend->GetOutputType();
+}
+
+void mbilog::BackendAsync::Flush()
+{
+  // the writer thread cannot wait for itself, e.g. if the wrapped backend logs
+  if (std::this_thread::get_id() == m_Writer.get_id())
+    return;
+
+  const std::uint64_t numberOfQueuedMessages = m_NumberOfQueuedMessages.load();
+
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  m_MessagesWritten.wait(lock, [&] { return m_NumberOfWrittenMessages >= numberOfQueuedMessages; });
+}
+
+void mbilog::BackendAsync::Push(Node *node)
+{
+  ++m_NumberOfQueuedMessages;
+
+  Node *previous = m_Head.exchange(node);
+  previous->Next.store(node);
+
+  // the writer announces that it is idle before it checks the queue a last time, so either it finds the
+  // message or it is woken up here
+  if (m_WriterIsIdle.load())
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_MessageQueued.notify_one();
+  }
+}
+
+mbilog::BackendAsync::Node *mbilog::BackendAsync::Pop()
+{
+  Node *tail = m_Tail;
+  Node *next = tail->Next.load();
+
+  // empty, or the next message is not linked yet by its producer
+  if (next == nullptr)
+    return nullptr;
+
+  // the node of the returned message becomes the new stub
+  m_Tail = next;
+  delete tail;
+  return next;
+}
+
+void mbilog::BackendAsync::Run()
+{
+  std::uint64_t numberOfWrittenMessages = 0;
+
+  while (true)
+  {
+    unsigned int batchSize = 0;
+    while (batchSize < WriteBatchSize)
+    {
+      Node *node = this->Pop();
+      if (node == nullptr)
+        break;
+
+      m_Backend->ProcessMessage(node->Message);
+      ++batchSize;
+    }
+    numberOfWrittenMessages += batchSize;
+
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_NumberOfWrittenMessages = numberOfWrittenMessages;
+    m_MessagesWritten.notify_all();
+
+    if (batchSize == WriteBatchSize)
+      continue;
+
+    if (m_Stop && m_Tail->Next.load() == nullptr)
+      break;
+
+    m_WriterIsIdle.store(true);
+    m_MessageQueued.wait(lock, [this] { return m_Stop || m_Tail->Next.load() != nullptr; });
+    m_WriterIsIdle.store(false);
+  }
+}
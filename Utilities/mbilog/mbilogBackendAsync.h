@@ -0,0 +1,97 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef _mbilogBackendAsync_H
+#define _mbilogBackendAsync_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "mbilogBackendBase.h"
+#include "mbilogExports.h"
+#include "mbilogLogMessage.h"
+
+namespace mbilog
+{
+  /**
+   *  \brief Backend that relays the logging messages to another backend on a dedicated writer thread.
+   *
+   *  Registered instead of the wrapped backend, it moves formatting and writing (console, file, log views)
+   *  off the thread that emits the message, e.g. a render or tracking thread. Emitting threads only copy the
+   *  message into a lock-free multiple producer single consumer queue; the writer thread is only woken up via
+   *  a mutex if it is idle. The wrapped backend is only called by the writer thread, so its messages keep
+   *  their order per emitting thread.
+   *
+   *  Fatal messages are written before ProcessMessage returns, since the application is likely to terminate.
+   *  The wrapped backend is not owned and has to outlive this backend.
+   *
+   *  \ingroup mbilog
+   */
+  class MBILOG_EXPORT BackendAsync : public BackendBase
+  {
+  public:
+    explicit BackendAsync(BackendBase *backend);
+
+    /** \brief Writes all pending messages and stops the writer thread. */
+    ~BackendAsync() override;
+
+    BackendAsync(const BackendAsync &) = delete;
+    BackendAsync &operator=(const BackendAsync &) = delete;
+
+    /** \brief Queues a copy of the logging message for the writer thread. */
+    void ProcessMessage(const mbilog::LogMessage &logMessage) override;
+
+    /** \brief Returns the output type of the wrapped backend, so that it is enabled and disabled as before. */
+    OutputType GetOutputType() const override;
+
+    /** \brief Blocks until all messages queued before the call are written by the wrapped backend. */
+    void Flush();
+
+  private:
+    struct Node
+    {
+      explicit Node(const LogMessage &message) : Next(nullptr), Message(message) {}
+
+      std::atomic<Node *> Next;
+      LogMessage Message;
+    };
+
+    void Push(Node *node);
+
+    /** \brief Returns the node holding the oldest message or nullptr, may only be called by the writer thread. */
+    Node *Pop();
+
+    void Run();
+
+    BackendBase *m_Backend;
+
+    /** \brief Most recently pushed node, shared by all emitting threads */
+    std::atomic<Node *> m_Head;
+    /** \brief Stub node preceding the oldest message, only accessed by the writer thread */
+    Node *m_Tail;
+
+    std::atomic<std::uint64_t> m_NumberOfQueuedMessages;
+    std::uint64_t m_NumberOfWrittenMessages;
+    std::atomic<bool> m_WriterIsIdle;
+    bool m_Stop;
+
+    std::mutex m_Mutex;
+    std::condition_variable m_MessageQueued;
+    std::condition_variable m_MessagesWritten;
+    std::thread m_Writer;
+  };
+}
+
+#endif